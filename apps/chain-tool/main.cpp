@@ -24,12 +24,17 @@
 #include "core/filesystem/read_file_contents.hpp"
 #include "core/filesystem/write_to_file.hpp"
 #include "ledger/chain/block_db_record.hpp"
+#include "ledger/storage_unit/transaction_scanner.hpp"
+#include "ledger/storage_unit/transaction_store.hpp"
 #include "meta/log2.hpp"
+#include "variant/variant.hpp"
 
 #include "storage/object_store.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <regex>
+#include <thread>
 
 #include <dirent.h>
 
@@ -49,6 +54,7 @@ using BlockStore      = ObjectStore<BlockDbRecord>;
 using TxStore         = ObjectStore<chain::Transaction>;
 using TxStores        = std::unordered_map<LaneIdx, TxStore>;
 using TxStoresPtr     = std::shared_ptr<TxStores>;
+using SourceTxStores  = TransactionScanner::Stores;
 using BlockHash       = Block::Hash;
 using BlockWeight     = Block::Weight;
 using Blocks          = std::unordered_set<BlockHash>;
@@ -664,9 +670,9 @@ bool BlockChainForwardTree::RecursionContext::RecurseInternal(
   return retval;
 }
 
-std::tuple<TxStores, int, std::string> OpenTxDbStores()
+std::tuple<SourceTxStores, int, std::string> OpenTxDbStores()
 {
-  TxStores tx_stores;
+  SourceTxStores tx_stores;
 
   DIRPtr dp{opendir(".")};
   if (dp)
@@ -735,21 +741,129 @@ std::tuple<TxStores, int, std::string> OpenTxDbStores()
   return {std::move(tx_stores), 0, ""};
 }
 
-void ProcessTransactions(BlockChainForwardTree const &bch, BlockChain const &heaviest_chain,
-                         TxStores &tx_stores, TxStoresPtr trimmed_tx_stores,
-                         bool const print_missing_txs)
+/**
+ * The location of a transaction within the chain
+ */
+struct TxLocation
+{
+  BlockNode const *node;
+  uint64_t         slice;
+  uint64_t         index;  ///< The index of the transaction within its slice
+  LaneIdx          lane;
+  Digest           digest;
+};
+
+using TxLocations = std::vector<TxLocation>;
+
+struct ScanOptions
+{
+  std::size_t   num_of_threads{1};
+  bool          print_missing_txs{false};
+  bool          verify_signatures{false};
+  std::ostream *export_stream{nullptr};  ///< Destination of the newline delimited JSON export
+};
+
+/**
+ * Collect the locations of all the transactions of a chain, in chain order (from the root)
+ */
+TxLocations CollectTxLocations(BlockChainForwardTree const &bch, BlockChain const &chain,
+                               uint32_t log2_num_of_lanes)
+{
+  std::vector<BlockNode const *> nodes;
+  nodes.reserve(chain.chain_length);
+
+  bch.IterateChainBackward(chain, [&nodes](BlockNode const &node, BlockHash const &) {
+    nodes.emplace_back(&node);
+    return true;
+  });
+
+  TxLocations locations;
+  locations.reserve(chain.num_of_all_txs);
+
+  for (auto node = nodes.crbegin(); node != nodes.crend(); ++node)
+  {
+    uint64_t slice_idx{0};
+    for (auto const &slice : (*node)->db_record.block.slices)
+    {
+      uint64_t tx_idx_in_slice{0};
+      for (auto const &tx_layout : slice)
+      {
+        locations.emplace_back(TxLocation{*node, slice_idx, tx_idx_in_slice,
+                                          ResourceID{tx_layout.digest()}.lane(log2_num_of_lanes),
+                                          tx_layout.digest()});
+        ++tx_idx_in_slice;
+      }
+      ++slice_idx;
+    }
+  }
+
+  return locations;
+}
+
+variant::Variant ToExportRecord(TxLocation const &location,
+                                TransactionScanner::Result const &result,
+                                ScanOptions const &options)
 {
+  auto const &block = location.node->db_record.block;
+
+  auto record{variant::Variant::Object()};
+  record["digest"]       = location.digest.ToHex();
+  record["block_number"] = block.block_number;
+  record["block_hash"]   = block.hash.ToHex();
+  record["slice"]        = location.slice;
+  record["index"]        = location.index;
+  record["lane"]         = location.lane;
+  record["found"]        = result.found;
+
+  if (result.found)
+  {
+    auto const &tx = result.tx;
+
+    record["from"]            = tx.from().display();
+    record["transfers"]       = tx.transfers().size();
+    record["transfer_amount"] = tx.GetTotalTransferAmount();
+    record["charge_rate"]     = tx.charge_rate();
+    record["charge_limit"]    = tx.charge_limit();
+    record["valid_from"]      = tx.valid_from();
+    record["valid_until"]     = tx.valid_until();
+
+    switch (tx.contract_mode())
+    {
+    case chain::Transaction::ContractMode::NOT_PRESENT:
+      break;
+    case chain::Transaction::ContractMode::PRESENT:
+    case chain::Transaction::ContractMode::SYNERGETIC:
+      record["contract"] = tx.contract_address().display();
+      record["action"]   = tx.action();
+      break;
+    case chain::Transaction::ContractMode::CHAIN_CODE:
+      record["contract"] = tx.chain_code();
+      record["action"]   = tx.action();
+      break;
+    }
 
+    if (options.verify_signatures)
+    {
+      record["verified"] = result.verified;
+    }
+  }
+
+  return record;
+}
+
+void ProcessTransactions(BlockChainForwardTree const &bch, BlockChain const &heaviest_chain,
+                         SourceTxStores const &tx_stores, TxStoresPtr trimmed_tx_stores,
+                         ScanOptions const &options)
+{
+  // the number of transactions which are scanned concurrently, before being written out in order
+  constexpr std::size_t batch_size{1ull << 14u};
   constexpr std::size_t num_of_progress_steps{10ull};
-  auto const            num_of_lanes{tx_stores.size()};
-  auto const            log2_num_of_lanes{meta::Log2(num_of_lanes)};
-  std::size_t const     progress_step{(heaviest_chain.num_of_all_txs + num_of_progress_steps - 1) /
-                                  num_of_progress_steps};
 
-  std::size_t tx_count_in_blockchain{0};
-  std::size_t last_reported_progress_tx_count{0};
+  auto const num_of_lanes{tx_stores.size()};
+  auto const log2_num_of_lanes{meta::Log2(num_of_lanes)};
+
   std::size_t tx_count_missing_accumulated{0};
-  std::size_t tx_count_processed{0};
+  std::size_t tx_count_unverified{0};
   std::size_t tx_count_stored_in_trimmed_db{0};
   std::size_t count_of_all_tx_in_db{0};
 
@@ -757,94 +871,109 @@ void ProcessTransactions(BlockChainForwardTree const &bch, BlockChain const &hea
 
   for (auto const &tx_lane_store : tx_stores)
   {
-    count_of_all_tx_in_db += tx_lane_store.second.size();
+    count_of_all_tx_in_db += tx_lane_store.second.GetCount();
     std::cout << "Lane" << tx_lane_store.first
               << ": Tx Count reported by index file of lane source TX db: "
-              << tx_lane_store.second.size() << " TXs" << std::endl;
+              << tx_lane_store.second.GetCount() << " TXs" << std::endl;
   }
   std::cout << "Number of ALL transactions stored in source TX db: " << count_of_all_tx_in_db
             << " TXs" << std::endl;
 
-  std::cout << "INFO: Checking Transactions from all blocks ... " << std::endl;
-  bch.IterateChainBackward(
-      heaviest_chain,
-      [&tx_stores, &tx_count_in_blockchain, &last_reported_progress_tx_count, &tx_count_missing,
-       &tx_count_missing_accumulated, &tx_count_processed, &tx_count_stored_in_trimmed_db,
-       &trimmed_tx_stores, progress_step, print_missing_txs,
-       log2_num_of_lanes](BlockNode const &node, BlockHash const & /*block_hash*/) {
-        uint64_t slice_idx{0};
-        for (auto const &slice : node.db_record.block.slices)
+  auto const        locations{CollectTxLocations(bch, heaviest_chain, log2_num_of_lanes)};
+  std::size_t const tx_count_in_blockchain{locations.size()};
+  std::size_t const progress_step{(tx_count_in_blockchain + num_of_progress_steps - 1) /
+                                  num_of_progress_steps};
+  std::size_t       last_reported_progress_tx_count{0};
+
+  std::cout << "INFO: Checking Transactions from all blocks (" << options.num_of_threads
+            << " threads) ... " << std::endl;
+
+  TransactionScanner::Requests requests;
+  requests.reserve(tx_count_in_blockchain);
+  for (auto const &location : locations)
+  {
+    requests.emplace_back(TransactionScanner::Request{location.lane, location.digest});
+  }
+
+  TransactionScanner scanner{tx_stores, options.num_of_threads};
+  scanner.EnableSignatureVerification(options.verify_signatures);
+  if (options.export_stream != nullptr)
+  {
+    scanner.SetExporter(
+        [&locations, &options](std::size_t i, TransactionScanner::Result const &result) {
+          return ToExportRecord(locations[i], result, options);
+        });
+  }
+
+  TransactionScanner::Results results;
+  for (std::size_t begin = 0; begin < tx_count_in_blockchain; begin += batch_size)
+  {
+    results.resize(std::min(batch_size, tx_count_in_blockchain - begin));
+    scanner.Scan(requests, begin, results);
+
+    // the results are consumed in chain order, so that the outputs are deterministic
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      auto const &location = locations[begin + i];
+      auto const &result   = results[i];
+
+      if (!result.found)
+      {
+        ++(tx_count_missing[location.lane]);
+        ++tx_count_missing_accumulated;
+        if (options.print_missing_txs)
         {
-          tx_count_in_blockchain += slice.size();
-
-          uint64_t tx_idx_in_slice{0};
-          for (auto const &tx_layout : slice)
-          {
-            auto const         lane{ResourceID{tx_layout.digest()}.lane(log2_num_of_lanes)};
-            chain::Transaction tx;
-
-            bool res{false};
-            try
-            {
-              res = tx_stores[lane].Get(storage::ResourceID{tx_layout.digest()}, tx);
-            }
-            catch (...)
-            {
-              if (print_missing_txs)
-              {
-                std::cerr << "EXCEPTION: Tx fetch from db failed:"
-                          << " lane = " << lane << ", tx hash = 0x" << tx_layout.digest().ToHex()
-                          << std::endl;
-                std::cerr.flush();
-              }
-            }
-
-            if (!res)
-            {
-              ++(tx_count_missing[lane]);
-              ++tx_count_missing_accumulated;
-              if (print_missing_txs)
-              {
-                std::cerr << "INCONSISTENCY: Tx fetch from db failed:"
-                          << " lane = " << lane << ", block[" << node.db_record.block.block_number
-                          << "] 0x" << node.db_record.block.hash.ToHex()
-                          << ", slice = " << slice_idx
-                          << ", tx index in slice = " << tx_idx_in_slice << ", tx hash = 0x"
-                          << tx_layout.digest().ToHex() << std::endl;
-                std::cerr.flush();
-              }
-            }
-            else if (trimmed_tx_stores)
-            {
-              ++tx_count_stored_in_trimmed_db;
-              (*trimmed_tx_stores)[lane].Set(storage::ResourceID{tx_layout.digest()}, tx);
-            }
-
-            ++tx_count_processed;
-            ++tx_idx_in_slice;
-          }
-          ++slice_idx;
+          std::cerr << "INCONSISTENCY: Tx fetch from db failed:"
+                    << " lane = " << location.lane << ", block["
+                    << location.node->db_record.block.block_number << "] 0x"
+                    << location.node->db_record.block.hash.ToHex()
+                    << ", slice = " << location.slice
+                    << ", tx index in slice = " << location.index << ", tx hash = 0x"
+                    << location.digest.ToHex() << std::endl;
+          std::cerr.flush();
+        }
+      }
+      else
+      {
+        if (options.verify_signatures && !result.verified)
+        {
+          ++tx_count_unverified;
+          std::cerr << "INCONSISTENCY: Tx signature verification failed:"
+                    << " block[" << location.node->db_record.block.block_number
+                    << "], tx hash = 0x" << location.digest.ToHex() << std::endl;
         }
 
-        if (node.db_record.block.block_number == 0 ||
-            (tx_count_in_blockchain > last_reported_progress_tx_count &&
-             (tx_count_in_blockchain - last_reported_progress_tx_count >= progress_step ||
-              tx_count_in_blockchain >= num_of_progress_steps * progress_step)))
+        if (trimmed_tx_stores)
         {
-          last_reported_progress_tx_count = tx_count_in_blockchain;
-          std::size_t const progress_percent{
-              (node.db_record.block.block_number == 0)
-                  ? 100ull
-                  : ((tx_count_in_blockchain / progress_step) * 100ull) / num_of_progress_steps};
-          std::cout << progress_percent << "%"
-                    << " (processed up to " << node.db_record.block.block_number
-                    << " block INDEX going backwards from tip,"
-                    << " missing/failed TX count " << tx_count_missing_accumulated << " (from "
-                    << tx_count_processed << " TXs processed so far)." << std::endl;
+          ++tx_count_stored_in_trimmed_db;
+          (*trimmed_tx_stores)[location.lane].Set(storage::ResourceID{location.digest}, result.tx);
         }
+      }
+
+      if (options.export_stream != nullptr)
+      {
+        options.export_stream->write(result.record.char_pointer(),
+                                     static_cast<std::streamsize>(result.record.size()));
+        options.export_stream->put('\n');
+      }
+    }
+
+    auto const processed = begin + results.size();
+    if ((processed - last_reported_progress_tx_count >= progress_step) ||
+        (processed == tx_count_in_blockchain))
+    {
+      last_reported_progress_tx_count = processed;
+      std::cout << (processed * 100ull) / tx_count_in_blockchain << "%"
+                << " (processed " << processed << " of " << tx_count_in_blockchain
+                << " TXs in chain order, missing/failed TX count "
+                << tx_count_missing_accumulated << ")." << std::endl;
+    }
+  }
 
-        return true;
-      });
+  if (options.export_stream != nullptr)
+  {
+    options.export_stream->flush();
+  }
 
   if (trimmed_tx_stores)
   {
@@ -880,6 +1009,12 @@ void ProcessTransactions(BlockChainForwardTree const &bch, BlockChain const &hea
     }
     ++lane;
   }
+
+  if (tx_count_unverified > 0)
+  {
+    std::cerr << "INCONSISTENCY: " << tx_count_unverified
+              << " transactions required by block-chain have invalid signatures" << std::endl;
+  }
 }
 
 }  // namespace
@@ -888,9 +1023,12 @@ int main(int argc, char **argv)
 {
   fetch::crypto::mcl::details::MCLInitialiser();
 
-  bool print_missing_txs{false};
-  bool create_trimmed_tx_store{false};
-  bool create_repaired_block_store{false};
+  bool        print_missing_txs{false};
+  bool        create_trimmed_tx_store{false};
+  bool        create_repaired_block_store{false};
+  bool        verify_signatures{false};
+  std::size_t num_of_threads{0};
+  std::string export_file{};
 
   commandline::Params parser{};
   parser.description(
@@ -905,6 +1043,15 @@ int main(int argc, char **argv)
              "Create trimmed TX db store containing only such TXs which are required by "
              "block-chain & exist in original TX db store.",
              false);
+  parser.add(verify_signatures, "verify-signatures",
+             "Verify the signatures of all transactions required by block-chain.", false);
+  parser.add(num_of_threads, "threads",
+             "The number of threads used to scan transactions (0 = number of hardware threads).",
+             std::size_t{0});
+  parser.add(export_file, "export-txs",
+             "Export the transactions of the heaviest chain, in chain order, to the specified "
+             "file as newline delimited JSON.",
+             std::string{});
   parser.Parse(argc, argv);
 
   BlockStore block_store;
@@ -961,7 +1108,7 @@ int main(int argc, char **argv)
     bch.SaveChainToDbStore(heaviest_chain, "repaired");
   }
 
-  TxStores tx_stores;
+  SourceTxStores tx_stores;
   std::tie(tx_stores, err, err_msg) = OpenTxDbStores();
   if (err < 0)
   {
@@ -981,7 +1128,27 @@ int main(int argc, char **argv)
     }
   }
 
-  ProcessTransactions(bch, heaviest_chain, tx_stores, trimmed_tx_stores, print_missing_txs);
+  ScanOptions options{};
+  options.num_of_threads    = (num_of_threads == 0)
+                                  ? std::max(1u, std::thread::hardware_concurrency())
+                                  : num_of_threads;
+  options.print_missing_txs = print_missing_txs;
+  options.verify_signatures = verify_signatures;
+
+  std::ofstream export_stream;
+  if (!export_file.empty())
+  {
+    export_stream.open(export_file, std::ios::out | std::ios::trunc);
+    if (!export_stream)
+    {
+      std::cerr << "ERROR: Unable to open \"" << export_file << "\" for export." << std::endl;
+      return -7;
+    }
+
+    options.export_stream = &export_stream;
+  }
+
+  ProcessTransactions(bch, heaviest_chain, tx_stores, trimmed_tx_stores, options);
 
   return EXIT_SUCCESS;
 }
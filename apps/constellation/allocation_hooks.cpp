@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/sampling_profiler.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replacements of the global allocation functions, reporting every allocation to the sampling
+// profiler. Outside of an allocation profile this costs a single relaxed atomic load.
+
+namespace {
+
+using fetch::telemetry::SamplingProfiler;
+
+void *Allocate(std::size_t size) noexcept
+{
+  SamplingProfiler::OnAllocation(size);
+
+  return std::malloc((size == 0) ? 1 : size);
+}
+
+void *AllocateOrThrow(std::size_t size)
+{
+  for (;;)
+  {
+    void *ptr = Allocate(size);
+    if (ptr != nullptr)
+    {
+      return ptr;
+    }
+
+    auto const handler = std::get_new_handler();
+    if (handler == nullptr)
+    {
+      throw std::bad_alloc{};
+    }
+
+    handler();
+  }
+}
+
+}  // namespace
+
+void *operator new(std::size_t size)
+{
+  return AllocateOrThrow(size);
+}
+
+void *operator new[](std::size_t size)
+{
+  return AllocateOrThrow(size);
+}
+
+void *operator new(std::size_t size, std::nothrow_t const & /*tag*/) noexcept
+{
+  return Allocate(size);
+}
+
+void *operator new[](std::size_t size, std::nothrow_t const & /*tag*/) noexcept
+{
+  return Allocate(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::nothrow_t const & /*tag*/) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::nothrow_t const & /*tag*/) noexcept
+{
+  std::free(ptr);
+}
@@ -291,6 +291,9 @@ Constellation::Config BuildConstellationConfig(Settings const &settings)
   cfg.num_slices            = settings.num_slices.value();
   cfg.num_executors         = settings.num_executors.value();
   cfg.db_prefix             = settings.db_prefix.value();
+  cfg.block_cache_size      = std::size_t{settings.block_cache_mb.value()} << 20u;
+  cfg.chain_memory_limit    = std::size_t{settings.chain_memory_limit_mb.value()} << 20u;
+  cfg.mem_pool_limit        = std::size_t{settings.mem_pool_limit_mb.value()} << 20u;
   cfg.processor_threads     = settings.num_processor_threads.value();
   cfg.verification_threads  = settings.num_verifier_threads.value();
   cfg.max_peers             = settings.max_peers.value();
@@ -40,6 +40,7 @@
 #include "network/uri.hpp"
 #include "settings.hpp"
 #include "shards/manifest.hpp"
+#include "vectorise/platform.hpp"
 #include "version/cli_header.hpp"
 #include "version/fetch_version.hpp"
 
@@ -252,6 +253,14 @@ int main(int argc, char **argv)
     FETCH_LOG_WARN(LOGGING_NAME, "Unsupported version - git working tree is dirty");
   }
 
+  if (!fetch::platform::SupportsCompiledVectorExtensions())
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME,
+                    "This CPU lacks the vector extensions the binary was built for, rebuild with "
+                    "a lower FETCH_ARCH");
+    return EXIT_FAILURE;
+  }
+
   try
   {
     Settings settings{};
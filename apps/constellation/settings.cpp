@@ -41,6 +41,7 @@ const uint32_t DEFAULT_STAKE_DELAY_PERIOD = 5;
 const uint32_t DEFAULT_AEON_PERIOD        = 25;
 const uint32_t DEFAULT_MAX_PEERS          = 3;
 const uint32_t DEFAULT_TRANSIENT_PEERS    = 1;
+const uint32_t DEFAULT_BLOCK_CACHE_MB     = 64;
 const uint32_t NUM_SYSTEM_THREADS = static_cast<uint32_t>(std::thread::hardware_concurrency());
 
 }  // namespace
@@ -56,6 +57,9 @@ Settings::Settings()
   , standalone            {*this, "standalone",              false,                        "Signal the network should run in standalone mode"}
   , private_network       {*this, "private-network",         false,                        "Signal the network should run as part of a private network"}
   , db_prefix             {*this, "db-prefix",               "node_storage",               "The prefix for filenames related to constellation databases"}
+  , mem_pool_limit_mb     {*this, "mem-pool-limit-mb",       0,                            "The memory in megabytes above which the transaction memory pools are moved to disk (0 for no limit)"}
+  , block_cache_mb        {*this, "block-cache-mb",          DEFAULT_BLOCK_CACHE_MB,       "The memory in megabytes used to cache blocks read back from the chain database"}
+  , chain_memory_limit_mb {*this, "chain-memory-limit-mb",   0,                            "The memory in megabytes above which the blocks held in memory are trimmed (0 for no limit)"}
   , port                  {*this, "port",                    DEFAULT_PORT,                 "The starting port for ledger services"}
   , peers                 {*this, "peers",                   {},                           "The comma separated list of addresses to initially connect to"}
   , external              {*this, "external",                "127.0.0.1",                  "This node's global IP address or hostname"}
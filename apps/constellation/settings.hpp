@@ -60,6 +60,13 @@ public:
   /// @name Shards
   /// @{
   settings::Setting<std::string> db_prefix;
+  settings::Setting<uint32_t>    mem_pool_limit_mb;
+  /// @}
+
+  /// @name Main Chain
+  /// @{
+  settings::Setting<uint32_t> block_cache_mb;
+  settings::Setting<uint32_t> chain_memory_limit_mb;
   /// @}
 
   /// @name Networking / P2P Manifest
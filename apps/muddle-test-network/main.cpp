@@ -33,9 +33,13 @@
 #include "muddle/muddle_interface.hpp"
 #include "network/management/network_manager.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdlib>
+#include <iostream>
 #include <memory>
+#include <string>
 #include <thread>
 
 using namespace fetch;
@@ -210,6 +214,84 @@ inline void AllToAllConnectivity(std::unique_ptr<Network> &               networ
   }
 }
 
+/**
+ * Wait until every node of the network is directly connected to a number of peers
+ *
+ * @param network The network
+ * @param min_peers The number of peers every node should be connected to
+ * @param timeout The maximum time to wait
+ * @return The time taken, or the timeout if the network did not reach the connectivity
+ */
+std::chrono::milliseconds WaitForConnectivity(std::unique_ptr<Network> &network,
+                                              std::size_t min_peers, std::chrono::seconds timeout)
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto const start = Clock::now();
+  while (Clock::now() - start < timeout)
+  {
+    bool const connected =
+        std::all_of(network->nodes.begin(), network->nodes.end(), [min_peers](auto const &node) {
+          return node->muddle->GetNumDirectlyConnectedPeers() >= min_peers;
+        });
+
+    if (connected)
+    {
+      break;
+    }
+
+    sleep_for(milliseconds{100});
+  }
+
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+}
+
+/**
+ * Benchmark of the recovery of connectivity after a network partition. The partition is simulated
+ * by taking half of the nodes offline for long enough for the other half to back off from
+ * reconnecting to them, after which they are restarted on the same ports.
+ *
+ * @param n The number of nodes
+ * @param outage The duration of the partition
+ * @return The exit code
+ */
+int PartitionRecovery(uint64_t n, std::chrono::seconds outage)
+{
+  auto const timeout = std::chrono::seconds{600};
+  auto       network = Network::New(n);
+
+  AllToAllConnectivity(network);
+
+  auto const initial = WaitForConnectivity(network, n - 1, timeout);
+  std::cout << "Initial connectivity: " << initial.count() << " ms" << std::endl;
+
+  for (uint64_t i = 0; i < n; i += 2)
+  {
+    network->nodes[i]->Stop();
+  }
+
+  sleep_for(outage);
+
+  for (uint64_t i = 0; i < n; i += 2)
+  {
+    network->nodes[i] = std::make_unique<Node>(static_cast<uint16_t>(BASE_MUDDLE_PORT + i),
+                                               static_cast<uint16_t>(BASE_HTTP_PORT + i));
+    network->nodes[i]->muddle->SetTrackerConfiguration({});
+
+    for (uint64_t j = 0; j < n; ++j)
+    {
+      network->nodes[i]->muddle->ConnectTo(
+          Uri("tcp://127.0.0.1:" + std::to_string(BASE_MUDDLE_PORT + j)));
+    }
+  }
+
+  auto const recovery = WaitForConnectivity(network, n - 1, timeout);
+  std::cout << "Recovered connectivity: " << recovery.count() << " ms" << std::endl;
+
+  network->Stop();
+  return (recovery < timeout) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int mainXX()
 {
   auto config                      = fetch::muddle::TrackerConfiguration::AllOn();
@@ -255,8 +337,16 @@ int mainXX()
   return 0;
 }
 
-int main()
+int main(int argc, char **argv)
 {
+  if ((argc > 1) && (std::string{argv[1]} == "partition"))
+  {
+    uint64_t const nodes  = (argc > 2) ? std::stoull(argv[2]) : 10;
+    auto const     outage = std::chrono::seconds{(argc > 3) ? std::stoll(argv[3]) : 60};
+
+    return PartitionRecovery(nodes, outage);
+  }
+
   auto config                      = fetch::muddle::TrackerConfiguration::AllOn();
   config.max_kademlia_connections  = 2;
   config.max_longrange_connections = 1;
@@ -33,6 +33,7 @@
 #include "google/protobuf/util/json_util.h"
 #include "oef-search/comms/OefListenerStarterTask.hpp"
 #include "oef-search/comms/OefSearchEndpoint.hpp"
+#include "oef-search/dap_comms/GeoDapConversationCreator.hpp"
 #include "oef-search/dap_comms/OutboundDapConversationCreator.hpp"
 #include "oef-search/functions/DirectorTaskFactory.hpp"
 #include "oef-search/search_comms/OutboundSearchConversationCreator.hpp"
@@ -134,9 +135,15 @@ int MtSearch::run()
       std::make_shared<OefListenerSet<IOefTaskFactory<OefSearchEndpoint>, OefSearchEndpoint>>();
 
   dap_store_         = std::make_shared<DapStore>();
-  search_peer_store_ = std::make_shared<SearchPeerStore>();
-  dap_manager_       = std::make_shared<DapManager>(dap_store_, search_peer_store_, outbounds,
-                                              config_.query_cache_lifetime_sec());
+  SearchPeerStore::Policy peer_policy;
+  peer_policy.fanout        = config_.peer_fanout();
+  peer_policy.hedge_delay   = std::chrono::milliseconds(config_.peer_hedge_delay_ms());
+  peer_policy.result_target = config_.peer_result_target();
+
+  search_peer_store_ = std::make_shared<SearchPeerStore>(peer_policy);
+  dap_manager_       = std::make_shared<DapManager>(
+      dap_store_, search_peer_store_, outbounds, config_.query_cache_lifetime_sec(),
+      config_.query_plan_cache_lifetime_sec(), config_.query_result_cache_lifetime_sec());
 
   for (const auto &dap_config : config_.daps())
   {
@@ -146,6 +153,13 @@ int MtSearch::run()
         Uri("dap://" + dap_config.name() + ":0"),
         std::make_shared<OutboundDapConversationCreator>(uri, *core, dap_config.name()));
   }
+  if (!config_.builtin_geo_dap().empty())
+  {
+    dap_store_->AddDap(config_.builtin_geo_dap());
+    outbounds->AddConversationCreator(
+        Uri("dap://" + config_.builtin_geo_dap() + ":0"),
+        std::make_shared<GeoDapConversationCreator>(config_.builtin_geo_dap()));
+  }
   for (const auto &peer_uri : config_.peers())
   {
     AddPeer(peer_uri);
@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/byte_array/decoders.hpp"
+#include "core/filesystem/read_file_contents.hpp"
+#include "json/document.hpp"
+#include "logging/logging.hpp"
+#include "storage/new_revertible_document_store.hpp"
+#include "storage/resource_mapper.hpp"
+#include "variant/variant.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::byte_array::FromBase64;
+using fetch::json::JSONDocument;
+using fetch::storage::NewRevertibleDocumentStore;
+using fetch::storage::ResourceAddress;
+using fetch::variant::Variant;
+
+using IndexBackend = NewRevertibleDocumentStore::IndexBackend;
+
+constexpr char const *LOGGING_NAME = "StateImport";
+
+struct LaneState
+{
+  NewRevertibleDocumentStore::Keys   keys{};
+  NewRevertibleDocumentStore::Values values{};
+};
+
+using LaneStates = std::vector<LaneState>;
+
+// must match the storage prefix generated by the LaneService
+std::string GeneratePrefix(std::string const &storage_path, uint32_t lane)
+{
+  std::ostringstream oss;
+  oss << storage_path << "_lane" << std::setw(3) << std::setfill('0') << lane << "_";
+  return oss.str();
+}
+
+uint32_t Log2(uint32_t value)
+{
+  uint32_t log2{0};
+  while ((1u << log2) < value)
+  {
+    ++log2;
+  }
+
+  return log2;
+}
+
+/**
+ * Build the (empty) state databases of each of the lanes from an input file in a single pass,
+ * instead of writing each of the documents through a running node.
+ *
+ * The input is a JSON object which maps each resource address (i.e. "fetch.token.state.<address>")
+ * to the base64 encoded contents of its document.
+ *
+ * @param storage_path The storage path of the node, i.e. "node_storage"
+ * @param num_lanes The number of lanes (must be a power of two)
+ * @param filename The path to the input file
+ * @param backend The state index backend used by the lanes
+ * @return EXIT_SUCCESS if successful, otherwise EXIT_FAILURE
+ */
+int Import(std::string const &storage_path, uint32_t num_lanes, char const *filename,
+           IndexBackend backend)
+{
+  uint32_t const log2_num_lanes = Log2(num_lanes);
+  if ((num_lanes == 0) || ((1u << log2_num_lanes) != num_lanes))
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "The number of lanes must be a power of two");
+    return EXIT_FAILURE;
+  }
+
+  ConstByteArray const contents = fetch::core::ReadContentsOfFile(filename);
+  if (contents.empty())
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Unable to read input file: ", filename);
+    return EXIT_FAILURE;
+  }
+
+  JSONDocument document{contents};
+  if (!document.root().IsObject())
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Expected the input file to contain an object");
+    return EXIT_FAILURE;
+  }
+
+  // group all of the documents by lane
+  LaneStates  lanes(num_lanes);
+  std::size_t count{0};
+  document.root().IterateObject([&](ConstByteArray const &key, Variant const &value) {
+    ResourceAddress const address{key};
+
+    auto &lane = lanes[address.lane(log2_num_lanes)];
+    lane.keys.emplace_back(address.as_resource_id());
+    lane.values.emplace_back(FromBase64(value.As<ConstByteArray>()));
+
+    ++count;
+    return true;
+  });
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Importing ", count, " documents into ", num_lanes, " lanes");
+
+  // the index files are named by backend, matching the LaneService
+  std::string const index_name =
+      (IndexBackend::B_TREE == backend) ? "state_btree_index" : "state_index";
+
+  for (uint32_t lane = 0; lane < num_lanes; ++lane)
+  {
+    std::string const prefix = GeneratePrefix(storage_path, lane);
+
+    NewRevertibleDocumentStore state_db{backend};
+    state_db.New(prefix + "state.db", prefix + "state_deltas.db", prefix + index_name + ".db",
+                 prefix + index_name + "_deltas.db", false);
+
+    state_db.Import(lanes[lane].keys, lanes[lane].values);
+    ConstByteArray const hash = state_db.Commit();
+
+    FETCH_LOG_INFO(LOGGING_NAME, "Lane ", lane, ": ", lanes[lane].keys.size(),
+                   " documents. State hash: 0x", hash.ToHex());
+  }
+
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  int exit_code = EXIT_FAILURE;
+
+  // parse the command line
+  bool const btree = (argc == 5) && (std::string{argv[4]} == "--btree");
+  if ((argc != 4) && !btree)
+  {
+    std::cerr << "Usage: " << argv[0] << " <storage path> <num lanes> <input file> [--btree]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    exit_code = Import(argv[1], static_cast<uint32_t>(std::stoul(argv[2])), argv[3],
+                       btree ? IndexBackend::B_TREE : IndexBackend::KEY_VALUE_INDEX);
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Fatal Error: ", ex.what());
+  }
+
+  return exit_code;
+}
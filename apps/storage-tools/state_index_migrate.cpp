@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "logging/logging.hpp"
+#include "storage/b_tree_index.hpp"
+#include "storage/key_value_index.hpp"
+#include "storage/new_versioned_random_access_stack.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::storage::BTreeIndex;
+using fetch::storage::BTreePage;
+using fetch::storage::DefaultKey;
+using fetch::storage::KeyValueIndex;
+using fetch::storage::KeyValuePair;
+using fetch::storage::NewVersionedRandomAccessStack;
+
+// must match the index types used by the NewRevertibleDocumentStore
+using SourceIndex =
+    KeyValueIndex<KeyValuePair<>, NewVersionedRandomAccessStack<KeyValuePair<>>>;
+using DestinationIndex = BTreeIndex<4096, NewVersionedRandomAccessStack<BTreePage<4096>>>;
+
+constexpr char const *LOGGING_NAME = "StateIndexMigrate";
+
+/**
+ * Build a B-tree state index for a lane from its existing key value index. The state file itself
+ * is shared by both of the index backends and is left untouched.
+ *
+ * @param prefix The storage prefix of the lane, i.e. "node_storage_lane000_"
+ * @return EXIT_SUCCESS if the migrated index has the same root hash, otherwise EXIT_FAILURE
+ */
+int Migrate(std::string const &prefix)
+{
+  SourceIndex source{};
+  source.Load(prefix + "state_index.db", prefix + "state_index_deltas.db", false);
+  source.UpdateVariables();
+
+  DestinationIndex destination{};
+  destination.New(prefix + "state_btree_index.db", prefix + "state_btree_index_deltas.db");
+
+  std::size_t count{0};
+  for (auto it = source.begin(), end = source.end(); it != end; ++it)
+  {
+    auto const entry = *it;
+    destination.Set(entry.first, entry.second, it.hash());
+
+    if ((++count % 100000) == 0)
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Migrated ", count, " entries...");
+    }
+  }
+
+  ConstByteArray const source_hash      = source.Hash();
+  ConstByteArray const destination_hash = destination.Hash();
+
+  if (source_hash != destination_hash)
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Migrated index hash mismatch. Expected: 0x",
+                    source_hash.ToHex(), " Actual: 0x", destination_hash.ToHex());
+    return EXIT_FAILURE;
+  }
+
+  // record the migrated state so that the lane can revert to it. Earlier history is not migrated
+  destination.underlying_stack().Commit(DefaultKey(destination_hash));
+  destination.Flush(false);
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Migrated ", count, " entries. State hash: 0x",
+                 destination_hash.ToHex());
+
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  int exit_code = EXIT_FAILURE;
+
+  // parse the command line
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <lane storage prefix>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    exit_code = Migrate(argv[1]);
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Fatal Error: ", ex.what());
+  }
+
+  return exit_code;
+}
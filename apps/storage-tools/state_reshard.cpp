@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/state_reshard.hpp"
+#include "logging/logging.hpp"
+#include "storage/new_revertible_document_store.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace {
+
+using IndexBackend = fetch::storage::NewRevertibleDocumentStore::IndexBackend;
+
+constexpr char const *LOGGING_NAME = "StateReshard";
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  int exit_code = EXIT_FAILURE;
+
+  // parse the command line
+  bool const btree = (argc == 6) && (std::string{argv[5]} == "--btree");
+  if ((argc != 5) && !btree)
+  {
+    std::cerr << "Usage: " << argv[0]
+              << " <source storage path> <source lanes> <destination storage path>"
+                 " <destination lanes> [--btree]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    bool const success = fetch::ledger::ReshardState(
+        argv[1], static_cast<uint32_t>(std::stoul(argv[2])), argv[3],
+        static_cast<uint32_t>(std::stoul(argv[4])),
+        btree ? IndexBackend::B_TREE : IndexBackend::KEY_VALUE_INDEX);
+
+    exit_code = success ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Fatal Error: ", ex.what());
+  }
+
+  return exit_code;
+}
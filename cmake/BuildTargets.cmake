@@ -42,6 +42,10 @@ macro (setup_compiler)
     math(EXPR _num_architectures_compiler "${_num_architectures_compiler}+1")
     list(APPEND _list_architectures_compiler "AVX2")
   endif (FETCH_ARCH_AVX2)
+  if (FETCH_ARCH_AVX512)
+    math(EXPR _num_architectures_compiler "${_num_architectures_compiler}+1")
+    list(APPEND _list_architectures_compiler "AVX512")
+  endif (FETCH_ARCH_AVX512)
 
   # platform configuration
   if (WIN32)
@@ -68,10 +72,16 @@ macro (setup_compiler)
     set(_compiler_arch "fma")
   elseif (FETCH_ARCH_AVX2)
     set(_compiler_arch "avx2")
+  elseif (FETCH_ARCH_AVX512)
+    set(_compiler_arch "avx512f")
   endif ()
 
-  # update actual compiler configuration
-  set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -m${_compiler_arch}")
+  # update actual compiler configuration, the x86 options do not apply to ARM
+  if (CMAKE_SYSTEM_PROCESSOR MATCHES "^(aarch64|arm64)")
+    message(STATUS "Ignoring the x86 architecture options on ${CMAKE_SYSTEM_PROCESSOR}")
+  else ()
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -m${_compiler_arch}")
+  endif ()
 
   # warnings
   set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wall -Wextra -Wconversion -Wpedantic")
@@ -28,9 +28,13 @@
 #include "beacon/events.hpp"
 #include "beacon/trusted_dealer.hpp"
 #include "beacon/trusted_dealer_beacon_service.hpp"
+#include "crypto/mcl_dkg.hpp"
+#include "vectorise/threading/pool.hpp"
 
 #include "benchmark/benchmark.h"
 
+#include <algorithm>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -241,3 +245,100 @@ void CreateRanges(benchmark::internal::Benchmark *b)
 // cabinet members online ranging from threshold number and the whole cabinet being
 // online
 BENCHMARK(EntropyGen)->Apply(CreateRanges)->Unit(benchmark::kMillisecond);
+
+namespace {
+
+struct SignatureShares
+{
+  SignatureShares(uint32_t cabinet_size, uint32_t num_invalid)
+  {
+    auto outputs = crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, cabinet_size / 2 + 1);
+    crypto::mcl::SetGenerator(generator);
+
+    for (uint32_t i = 0; i < cabinet_size; ++i)
+    {
+      public_keys.push_back(outputs[0].public_key_shares[i]);
+      signatures.push_back(crypto::mcl::SignShare(message, outputs[i].private_key_share));
+    }
+
+    // Spread the invalid shares evenly across the cabinet
+    for (uint32_t i = 0; i < num_invalid; ++i)
+    {
+      auto const index  = (i * cabinet_size) / num_invalid;
+      signatures[index] = crypto::mcl::SignShare("Invalid", outputs[index].private_key_share);
+    }
+  }
+
+  crypto::mcl::MessagePayload         message = "Hello";
+  crypto::mcl::Generator              generator;
+  std::vector<crypto::mcl::PublicKey> public_keys;
+  std::vector<crypto::mcl::Signature> signatures;
+};
+
+}  // namespace
+
+void VerifySignatureShares(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+
+  SignatureShares shares{static_cast<uint32_t>(state.range(0)),
+                         static_cast<uint32_t>(state.range(1))};
+
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < shares.signatures.size(); ++i)
+    {
+      benchmark::DoNotOptimize(crypto::mcl::VerifySign(shares.public_keys[i], shares.message,
+                                                       shares.signatures[i], shares.generator));
+    }
+  }
+}
+
+void BatchVerifySignatureShares(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+
+  SignatureShares shares{static_cast<uint32_t>(state.range(0)),
+                         static_cast<uint32_t>(state.range(1))};
+  threading::Pool pool{std::max(1u, std::thread::hardware_concurrency())};
+  bool const      use_pool = state.range(2) != 0;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(crypto::mcl::FindInvalidSignatures(
+        shares.public_keys, shares.message, shares.signatures, shares.generator,
+        use_pool ? &pool : nullptr));
+  }
+}
+
+void CreateVerificationRanges(benchmark::internal::Benchmark *b)
+{
+  b->ArgNames({"Cabinet size", "Invalid shares"});
+  for (int64_t cabinet_size : {20, 50, 100, 200})
+  {
+    for (int64_t invalid : {int64_t{0}, int64_t{1}, cabinet_size / 10})
+    {
+      b->Args({cabinet_size, invalid});
+    }
+  }
+}
+
+void CreateBatchVerificationRanges(benchmark::internal::Benchmark *b)
+{
+  b->ArgNames({"Cabinet size", "Invalid shares", "Thread pool"});
+  for (int64_t cabinet_size : {20, 50, 100, 200})
+  {
+    for (int64_t invalid : {int64_t{0}, int64_t{1}, cabinet_size / 10})
+    {
+      b->Args({cabinet_size, invalid, 0});
+      b->Args({cabinet_size, invalid, 1});
+    }
+  }
+}
+
+// Compares verifying each of the signature shares of a round individually, as done previously, with
+// verifying them as a single randomised batch which is only bisected when it fails
+BENCHMARK(VerifySignatureShares)->Apply(CreateVerificationRanges)->Unit(benchmark::kMillisecond);
+BENCHMARK(BatchVerifySignatureShares)
+    ->Apply(CreateBatchVerificationRanges)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,91 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+#include "crypto/mcl_dkg.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Verifies aggregate signatures against the notarisation keys of one cabinet.
+ *
+ * The aggregate public key of each signer record is cached, since consecutive blocks are mostly
+ * notarised by the same members, as are the signatures which have already been verified, since
+ * the same notarisations are checked again during reorgs and sync. Batches of notarisations are
+ * verified together with a single final exponentiation.
+ */
+class AggregateSignatureVerifier
+{
+public:
+  using PublicKey          = crypto::mcl::PublicKey;
+  using Signature          = crypto::mcl::Signature;
+  using Generator          = crypto::mcl::Generator;
+  using MessagePayload     = crypto::mcl::MessagePayload;
+  using AggregatePublicKey = crypto::mcl::AggregatePublicKey;
+  using AggregateSignature = crypto::mcl::AggregateSignature;
+  using SignerRecord       = crypto::mcl::SignerRecord;
+  using Batch              = std::vector<std::pair<MessagePayload, AggregateSignature>>;
+
+  static constexpr std::size_t MAX_CACHED_SIGNER_RECORDS = 64;
+  static constexpr std::size_t MAX_CACHED_VERIFICATIONS  = 1024;
+
+  // Construction / Destruction
+  AggregateSignatureVerifier(std::vector<AggregatePublicKey> cabinet_public_keys,
+                             Generator const &               generator);
+  AggregateSignatureVerifier(AggregateSignatureVerifier const &) = delete;
+  AggregateSignatureVerifier(AggregateSignatureVerifier &&)      = delete;
+  ~AggregateSignatureVerifier()                                  = default;
+
+  bool              Verify(MessagePayload const &    message,
+                           AggregateSignature const &aggregate_signature);
+  std::vector<bool> Verify(Batch const &batch);
+
+  std::size_t cabinet_size() const;
+
+  // Operators
+  AggregateSignatureVerifier &operator=(AggregateSignatureVerifier const &) = delete;
+  AggregateSignatureVerifier &operator=(AggregateSignatureVerifier &&) = delete;
+
+private:
+  using VerificationKey = std::pair<MessagePayload, SignerRecord>;
+
+  PublicKey AggregatePublicKeyOf(SignerRecord const &signers);
+  bool      IsVerified(MessagePayload const &message, AggregateSignature const &signature) const;
+  void      AddVerified(MessagePayload const &message, AggregateSignature const &signature);
+
+  std::vector<AggregatePublicKey> const cabinet_public_keys_;
+  Generator const                       generator_;
+
+  Mutex                                mutex_;
+  std::map<SignerRecord, PublicKey>    aggregate_public_keys_;
+  std::deque<SignerRecord>             aggregate_public_keys_order_;
+  std::map<VerificationKey, Signature> verified_;
+  std::deque<VerificationKey>          verified_order_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
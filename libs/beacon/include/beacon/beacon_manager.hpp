@@ -36,6 +36,7 @@ public:
   using PublicKey        = crypto::mcl::PublicKey;
   using PrivateKey       = crypto::mcl::PrivateKey;
   using Generator        = crypto::mcl::Generator;
+  using FixedBase        = crypto::mcl::FixedBaseG2;
   using CabinetIndex     = crypto::mcl::CabinetIndex;
   using MessagePayload   = crypto::mcl::MessagePayload;
   using Identity         = crypto::Identity;
@@ -90,6 +91,8 @@ public:
   void             Reset();
 
   AddResult     AddSignaturePart(Identity const &from, Signature const &signature);
+  std::vector<AddResult> AddSignatureParts(std::vector<SignedMessage> const &signed_messages,
+                                           threading::Pool *                 pool = nullptr);
   bool          Verify();
   bool          Verify(Signature const &signature);
   static bool   Verify(byte_array::ConstByteArray const &group_public_key,
@@ -123,6 +126,8 @@ private:
 private:
   static Generator const & GetGroupG();
   static Generator const & GetGroupH();
+  static FixedBase const & GetGroupGTable();
+  static FixedBase const & GetGroupHTable();
   static PrivateKey const &GetZeroFr();
 
   CertificatePtr certificate_;
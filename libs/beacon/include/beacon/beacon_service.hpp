@@ -37,6 +37,7 @@
 #include "telemetry/counter.hpp"
 #include "telemetry/gauge.hpp"
 #include "telemetry/registry.hpp"
+#include "vectorise/threading/pool.hpp"
 
 #include <cstdint>
 #include <deque>
@@ -44,6 +45,7 @@
 #include <queue>
 #include <random>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -94,6 +96,13 @@ public:
   using DeadlineTimer           = fetch::moment::DeadlineTimer;
   using OldStateStore           = fetch::storage::ObjectStore<AeonExecutionUnit>;
 
+  /// The default and maximum number of rounds the beacon may generate ahead of the chain
+  static constexpr uint64_t DEFAULT_ENTROPY_LOOKAHEAD = 2;
+  static constexpr uint64_t MAX_ENTROPY_LOOKAHEAD     = 16;
+
+  /// The number of qual members queried concurrently for their signature shares
+  static constexpr std::size_t MAX_CONCURRENT_SHARE_REQUESTS = 3;
+
   BeaconService()                      = delete;
   BeaconService(BeaconService const &) = delete;
 
@@ -110,6 +119,8 @@ public:
   /// @{
   std::weak_ptr<core::Runnable> GetWeakRunnable();
   void                          MostRecentSeen(uint64_t round);
+  void                          SetEntropyLookahead(uint64_t rounds);
+  uint64_t                      GetEntropyLookahead() const;
   /// @}
 
   friend class BeaconServiceProtocol;
@@ -142,7 +153,16 @@ protected:
   std::deque<SharedAeonExecutionUnit> aeon_exe_queue_;
 
 private:
-  bool AddSignature(SignatureShare share);
+  struct ShareRequest
+  {
+    Identity         identity;
+    service::Promise promise;
+  };
+
+  using ShareRequests = std::vector<ShareRequest>;
+
+  void AddSignatures(std::vector<SignatureShare> const &shares);
+  void UpdateRoundsAhead();
 
   Identity         identity_;
   MuddleInterface &muddle_;
@@ -151,8 +171,9 @@ private:
   DeadlineTimer    timer_to_proceed_{"beacon:main"};
 
   // Limit run away entropy generation
-  uint64_t entropy_lead_blocks_    = 2;
+  uint64_t entropy_lead_blocks_    = DEFAULT_ENTROPY_LOOKAHEAD;
   uint64_t most_recent_round_seen_ = 0;
+  uint64_t last_round_generated_   = 0;
 
   /// General configuration
   /// @{
@@ -168,9 +189,7 @@ private:
   /// @{
   // Important this is ordered for trimming
   std::map<uint64_t, SignatureInformation> signatures_being_built_;
-  std::size_t                              random_number_{0};
-  Identity                                 qual_promise_identity_;
-  service::Promise                         sig_share_promise_;
+  ShareRequests                            share_requests_;  ///< Outstanding share requests
 
   BlockEntropyPtr block_entropy_previous_;
   BlockEntropyPtr block_entropy_being_created_;
@@ -192,6 +211,11 @@ private:
   BeaconServiceProtocol beacon_protocol_;
   /// @}
 
+  /// Threads used to locate the invalid shares of a batch which fails verification
+  /// @{
+  threading::Pool verification_pool_;
+  /// @}
+
   /// Save keys so that recovery is possible in a crash situation
   /// @{
   OldStateStore old_state_;
@@ -214,6 +238,7 @@ private:
   telemetry::GaugePtr<uint64_t> beacon_entropy_current_round_;
   telemetry::GaugePtr<uint64_t> beacon_state_gauge_;
   telemetry::GaugePtr<uint64_t> beacon_most_recent_round_seen_;
+  telemetry::GaugePtr<uint64_t> beacon_entropy_rounds_ahead_;
   telemetry::HistogramPtr       beacon_collect_time_;
   telemetry::HistogramPtr       beacon_verify_time_;
 };
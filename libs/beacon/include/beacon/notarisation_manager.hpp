@@ -17,10 +17,13 @@
 //
 //------------------------------------------------------------------------------
 
+#include "beacon/aggregate_signature_verifier.hpp"
 #include "core/byte_array/const_byte_array.hpp"
 #include "crypto/mcl_dkg.hpp"
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -37,6 +40,7 @@ public:
   using AggregatePublicKey  = crypto::mcl::AggregatePublicKey;
   using AggregatePrivateKey = crypto::mcl::AggregatePrivateKey;
   using AggregateSignature  = crypto::mcl::AggregateSignature;
+  using NotarisationBatch   = AggregateSignatureVerifier::Batch;
 
   NotarisationManager();
 
@@ -54,11 +58,12 @@ public:
                             MuddleAddress const &member);
   AggregateSignature ComputeAggregateSignature(
       std::unordered_map<MuddleAddress, Signature> const &cabinet_signatures);
-  bool        VerifyAggregateSignature(MessagePayload const &    message,
-                                       AggregateSignature const &aggregate_signature);
-  static bool VerifyAggregateSignature(MessagePayload const &        message,
-                                       AggregateSignature const &    aggregate_signature,
-                                       std::vector<PublicKey> const &public_keys);
+  bool              VerifyAggregateSignature(MessagePayload const &    message,
+                                             AggregateSignature const &aggregate_signature);
+  std::vector<bool> VerifyAggregateSignatures(NotarisationBatch const &batch);
+  static bool       VerifyAggregateSignature(MessagePayload const &        message,
+                                             AggregateSignature const &    aggregate_signature,
+                                             std::vector<PublicKey> const &public_keys);
   /// @}
 
   /// Helper functions
@@ -72,7 +77,10 @@ public:
   /// @}
 
 private:
+  using VerifierPtr = std::shared_ptr<AggregateSignatureVerifier>;
+
   static Generator const &GetGenerator();
+  static VerifierPtr      GetCabinetVerifier(std::vector<PublicKey> const &public_keys);
 
   // Aeon details
   uint64_t                                    round_start_{0};
@@ -85,6 +93,7 @@ private:
   AggregatePrivateKey             aggregate_private_key_;
   PublicKey                       public_key_;
   std::vector<AggregatePublicKey> cabinet_public_keys_{};
+  VerifierPtr                     verifier_{};
 };
 }  // namespace ledger
 }  // namespace fetch
@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "beacon/aggregate_signature_verifier.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+AggregateSignatureVerifier::AggregateSignatureVerifier(
+    std::vector<AggregatePublicKey> cabinet_public_keys, Generator const &generator)
+  : cabinet_public_keys_{std::move(cabinet_public_keys)}
+  , generator_{generator}
+{}
+
+/**
+ * Verifies an aggregate signature of a message
+ *
+ * @param message Message which was signed
+ * @param aggregate_signature Aggregate signature and the record of which members signed
+ * @return Whether the aggregate signature is valid
+ */
+bool AggregateSignatureVerifier::Verify(MessagePayload const &    message,
+                                        AggregateSignature const &aggregate_signature)
+{
+  if (aggregate_signature.second.size() != cabinet_public_keys_.size())
+  {
+    return false;
+  }
+
+  PublicKey public_key;
+  {
+    FETCH_LOCK(mutex_);
+
+    if (IsVerified(message, aggregate_signature))
+    {
+      return true;
+    }
+
+    public_key = AggregatePublicKeyOf(aggregate_signature.second);
+  }
+
+  // the pairings are computed without holding the lock, so cache hits are never held up by them
+  if (!crypto::mcl::VerifySign(public_key, message, aggregate_signature.first, generator_))
+  {
+    return false;
+  }
+
+  FETCH_LOCK(mutex_);
+  AddVerified(message, aggregate_signature);
+  return true;
+}
+
+/**
+ * Verifies a batch of aggregate signatures with a single product of pairings. Only when that fails
+ * are the signatures of the batch verified individually
+ *
+ * @param batch Messages and their aggregate signatures
+ * @return Whether each of the aggregate signatures is valid
+ */
+std::vector<bool> AggregateSignatureVerifier::Verify(Batch const &batch)
+{
+  std::vector<bool> results(batch.size(), false);
+
+  std::vector<std::size_t>    pending;
+  std::vector<PublicKey>      public_keys;
+  std::vector<MessagePayload> messages;
+  std::vector<Signature>      signatures;
+
+  {
+    FETCH_LOCK(mutex_);
+
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+      auto const &message             = batch[i].first;
+      auto const &aggregate_signature = batch[i].second;
+
+      if (aggregate_signature.second.size() != cabinet_public_keys_.size())
+      {
+        continue;
+      }
+
+      if (IsVerified(message, aggregate_signature))
+      {
+        results[i] = true;
+        continue;
+      }
+
+      pending.push_back(i);
+      public_keys.push_back(AggregatePublicKeyOf(aggregate_signature.second));
+      messages.push_back(message);
+      signatures.push_back(aggregate_signature.first);
+    }
+  }
+
+  // the pairings are computed without holding the lock, so cache hits are never held up by them
+  bool const all_valid =
+      crypto::mcl::VerifySignBatch(public_keys, messages, signatures, generator_);
+
+  for (std::size_t n = 0; n < pending.size(); ++n)
+  {
+    if (all_valid ||
+        crypto::mcl::VerifySign(public_keys[n], messages[n], signatures[n], generator_))
+    {
+      results[pending[n]] = true;
+    }
+  }
+
+  FETCH_LOCK(mutex_);
+  for (auto const index : pending)
+  {
+    if (results[index])
+    {
+      AddVerified(batch[index].first, batch[index].second);
+    }
+  }
+
+  return results;
+}
+
+std::size_t AggregateSignatureVerifier::cabinet_size() const
+{
+  return cabinet_public_keys_.size();
+}
+
+AggregateSignatureVerifier::PublicKey AggregateSignatureVerifier::AggregatePublicKeyOf(
+    SignerRecord const &signers)
+{
+  auto it = aggregate_public_keys_.find(signers);
+  if (it != aggregate_public_keys_.end())
+  {
+    return it->second;
+  }
+
+  PublicKey const aggregate_public_key =
+      crypto::mcl::ComputeAggregatePublicKey(signers, cabinet_public_keys_);
+
+  aggregate_public_keys_.emplace(signers, aggregate_public_key);
+  aggregate_public_keys_order_.push_back(signers);
+  if (aggregate_public_keys_order_.size() > MAX_CACHED_SIGNER_RECORDS)
+  {
+    aggregate_public_keys_.erase(aggregate_public_keys_order_.front());
+    aggregate_public_keys_order_.pop_front();
+  }
+
+  return aggregate_public_key;
+}
+
+bool AggregateSignatureVerifier::IsVerified(MessagePayload const &    message,
+                                            AggregateSignature const &signature) const
+{
+  // The signature itself must match, or a forged signature with the same signers would pass
+  auto it = verified_.find({message, signature.second});
+  return (it != verified_.end()) && (it->second == signature.first);
+}
+
+void AggregateSignatureVerifier::AddVerified(MessagePayload const &    message,
+                                             AggregateSignature const &signature)
+{
+  VerificationKey key{message, signature.second};
+
+  if (verified_.find(key) != verified_.end())
+  {
+    verified_[key] = signature.first;
+    return;
+  }
+
+  verified_.emplace(key, signature.first);
+  verified_order_.push_back(std::move(key));
+  if (verified_order_.size() > MAX_CACHED_VERIFICATIONS)
+  {
+    verified_.erase(verified_order_.front());
+    verified_order_.pop_front();
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -20,8 +20,15 @@
 #include "core/synchronisation/protected.hpp"
 #include "crypto/ecdsa.hpp"
 #include "network/generics/milli_timer.hpp"
+#include "vectorise/threading/pool.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -56,12 +63,26 @@ public:
     return params_->group_h_;
   }
 
+  BeaconManager::FixedBase const &GetGroupGTable()
+  {
+    EnsureInitialised();
+    return *params_->group_g_table_;
+  }
+
+  BeaconManager::FixedBase const &GetGroupHTable()
+  {
+    EnsureInitialised();
+    return *params_->group_h_table_;
+  }
+
   void EnsureInitialised()
   {
     if (!params_)
     {
       params_ = std::make_unique<Params>();
       crypto::mcl::SetGenerators(params_->group_g_, params_->group_h_);
+      params_->group_g_table_ = std::make_unique<BeaconManager::FixedBase>(params_->group_g_);
+      params_->group_h_table_ = std::make_unique<BeaconManager::FixedBase>(params_->group_h_);
     }
   }
 
@@ -76,6 +97,9 @@ private:
 
     BeaconManager::Generator group_g_{};
     BeaconManager::Generator group_h_{};
+
+    std::unique_ptr<BeaconManager::FixedBase> group_g_table_;
+    std::unique_ptr<BeaconManager::FixedBase> group_h_table_;
   };
 
   std::unique_ptr<Params> params_;
@@ -83,6 +107,53 @@ private:
 
 Protected<CurveParameters> curve_params_{};
 
+threading::Pool &DkgPool()
+{
+  static threading::Pool pool{std::max(1u, std::thread::hardware_concurrency()), "DKG"};
+  return pool;
+}
+
+/**
+ * Calls function(n) for every n in [0, count), sharing the calls between the threads of the DKG
+ * pool. The elliptic curve operations for different cabinet members are independent of each other
+ */
+template <typename Function>
+void ParallelFor(std::size_t count, Function const &function)
+{
+  auto &            pool       = DkgPool();
+  std::size_t const num_chunks = std::min(pool.concurrency(), count);
+
+  if (num_chunks <= 1)
+  {
+    for (std::size_t n = 0; n < count; ++n)
+    {
+      function(n);
+    }
+    return;
+  }
+
+  std::vector<std::future<void>> tasks{};
+  tasks.reserve(num_chunks);
+
+  for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+  {
+    std::size_t const begin = (chunk * count) / num_chunks;
+    std::size_t const end   = ((chunk + 1) * count) / num_chunks;
+
+    tasks.emplace_back(pool.Dispatch([&function, begin, end]() {
+      for (std::size_t n = begin; n < end; ++n)
+      {
+        function(n);
+      }
+    }));
+  }
+
+  for (auto &task : tasks)
+  {
+    task.get();
+  }
+}
+
 }  // namespace
 
 constexpr char const *LOGGING_NAME = "BeaconManager";
@@ -115,11 +186,13 @@ void BeaconManager::GenerateCoefficients()
     b_i[k].setRand();
   }
 
-  for (uint32_t k = 0; k <= polynomial_degree_; k++)
-  {
+  auto const &group_g = GetGroupGTable();
+  auto const &group_h = GetGroupHTable();
+
+  ParallelFor(polynomial_degree_ + 1, [&](std::size_t k) {
     C_ik[cabinet_index_][k] =
-        crypto::mcl::ComputeLHS(g__a_i[k], GetGroupG(), GetGroupH(), a_i[k], b_i[k]);
-  }
+        crypto::mcl::ComputeLHS(g__a_i[k], group_g, group_h, a_i[k], b_i[k]);
+  });
 
   for (uint32_t l = 0; l < cabinet_size_; l++)
   {
@@ -187,23 +260,41 @@ void BeaconManager::AddShares(MuddleAddress const &from, std::pair<Share, Share>
 std::set<BeaconManager::MuddleAddress> BeaconManager::ComputeComplaints(
     std::set<MuddleAddress> const &coeff_received)
 {
-  std::set<MuddleAddress> complaints_local;
+  std::set<MuddleAddress>    complaints_local;
+  std::vector<MuddleAddress> senders;
+  std::vector<CabinetIndex>  sender_indices;
   for (auto &cab : coeff_received)
   {
     CabinetIndex i = identity_to_index_[cab];
     if (i != cabinet_index_)
     {
-      PublicKey rhs;
-      PublicKey lhs;
-      lhs = crypto::mcl::ComputeLHS(g__s_ij[i][cabinet_index_], GetGroupG(), GetGroupH(),
-                                    s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]);
-      rhs = crypto::mcl::ComputeRHS(cabinet_index_, C_ik[i]);
-      if (lhs != rhs || lhs.isZero())
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
-                       " received bad coefficients/shares from node ", i);
-        complaints_local.insert(cab);
-      }
+      senders.push_back(cab);
+      sender_indices.push_back(i);
+    }
+  }
+
+  // Verify the shares of each sender in parallel
+  auto const &         group_g = GetGroupGTable();
+  auto const &         group_h = GetGroupHTable();
+  std::vector<uint8_t> valid(senders.size(), 0);
+
+  ParallelFor(senders.size(), [&](std::size_t n) {
+    CabinetIndex const i = sender_indices[n];
+    PublicKey          rhs;
+    PublicKey          lhs;
+    lhs      = crypto::mcl::ComputeLHS(g__s_ij[i][cabinet_index_], group_g, group_h,
+                                        s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]);
+    rhs      = crypto::mcl::ComputeRHS(cabinet_index_, C_ik[i]);
+    valid[n] = static_cast<uint8_t>(lhs == rhs && !lhs.isZero());
+  });
+
+  for (std::size_t n = 0; n < senders.size(); ++n)
+  {
+    if (valid[n] == 0)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
+                     " received bad coefficients/shares from node ", sender_indices[n]);
+      complaints_local.insert(senders[n]);
     }
   }
   return complaints_local;
@@ -222,7 +313,7 @@ bool BeaconManager::VerifyComplaintAnswer(MuddleAddress const &from, ComplaintAn
   s      = answer.second.first;
   sprime = answer.second.second;
   rhsG   = crypto::mcl::ComputeRHS(reporter_index, C_ik[from_index]);
-  lhsG   = crypto::mcl::ComputeLHS(GetGroupG(), GetGroupH(), s, sprime);
+  lhsG   = crypto::mcl::ComputeLHS(GetGroupGTable(), GetGroupHTable(), s, sprime);
   if (lhsG != rhsG || lhsG.isZero())
   {
     FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_, " verification for node ", from_index,
@@ -238,7 +329,7 @@ bool BeaconManager::VerifyComplaintAnswer(MuddleAddress const &from, ComplaintAn
     s_ij[from_index][cabinet_index_]      = s;
     sprime_ij[from_index][cabinet_index_] = sprime;
     g__s_ij[from_index][cabinet_index_].clear();
-    bn::G2::mul(g__s_ij[from_index][cabinet_index_], GetGroupG(), s_ij[from_index][cabinet_index_]);
+    GetGroupGTable().Mul(g__s_ij[from_index][cabinet_index_], s_ij[from_index][cabinet_index_]);
   }
   return true;
 }
@@ -294,7 +385,9 @@ void BeaconManager::AddQualCoefficients(MuddleAddress const &           from,
 BeaconManager::SharesExposedMap BeaconManager::ComputeQualComplaints(
     std::set<MuddleAddress> const &coeff_received)
 {
-  SharesExposedMap qual_complaints;
+  SharesExposedMap           qual_complaints;
+  std::vector<MuddleAddress> senders;
+  std::vector<CabinetIndex>  sender_indices;
 
   for (auto const &miner : qual_)
   {
@@ -303,16 +396,8 @@ BeaconManager::SharesExposedMap BeaconManager::ComputeQualComplaints(
     {
       if (coeff_received.find(miner) != coeff_received.end())
       {
-        PublicKey rhs;
-        PublicKey lhs;
-        lhs = g__s_ij[i][cabinet_index_];
-        rhs = crypto::mcl::ComputeRHS(cabinet_index_, A_ik[i]);
-        if (lhs != rhs || rhs.isZero())
-        {
-          FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
-                         " received qual coefficients from node ", i, " which failed verification");
-          qual_complaints.insert({miner, {s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]}});
-        }
+        senders.push_back(miner);
+        sender_indices.push_back(i);
       }
       else
       {
@@ -322,6 +407,30 @@ BeaconManager::SharesExposedMap BeaconManager::ComputeQualComplaints(
       }
     }
   }
+
+  // Verify the qual coefficients of each sender in parallel
+  std::vector<uint8_t> valid(senders.size(), 0);
+
+  ParallelFor(senders.size(), [&](std::size_t n) {
+    CabinetIndex const i = sender_indices[n];
+    PublicKey          rhs;
+    PublicKey          lhs;
+    lhs      = g__s_ij[i][cabinet_index_];
+    rhs      = crypto::mcl::ComputeRHS(cabinet_index_, A_ik[i]);
+    valid[n] = static_cast<uint8_t>(lhs == rhs && !rhs.isZero());
+  });
+
+  for (std::size_t n = 0; n < senders.size(); ++n)
+  {
+    if (valid[n] == 0)
+    {
+      CabinetIndex const i = sender_indices[n];
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
+                     " received qual coefficients from node ", i, " which failed verification");
+      qual_complaints.insert(
+          {senders[n], {s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]}});
+    }
+  }
   return qual_complaints;
 }
 
@@ -337,7 +446,7 @@ BeaconManager::MuddleAddress BeaconManager::VerifyQualComplaint(MuddleAddress co
   PrivateKey sprime;
   s      = answer.second.first;
   sprime = answer.second.second;
-  lhs    = crypto::mcl::ComputeLHS(GetGroupG(), GetGroupH(), s, sprime);
+  lhs    = crypto::mcl::ComputeLHS(GetGroupGTable(), GetGroupHTable(), s, sprime);
   rhs    = crypto::mcl::ComputeRHS(from_index, C_ik[victim_index]);
   if (lhs != rhs || lhs.isZero())
   {
@@ -347,7 +456,7 @@ BeaconManager::MuddleAddress BeaconManager::VerifyQualComplaint(MuddleAddress co
     return from;
   }
 
-  bn::G2::mul(lhs, GetGroupG(), s);  // G^s
+  GetGroupGTable().Mul(lhs, s);  // G^s
   rhs = crypto::mcl::ComputeRHS(from_index, A_ik[victim_index]);
   if (lhs != rhs || rhs.isZero())
   {
@@ -383,18 +492,31 @@ void BeaconManager::ComputePublicKeys()
     bn::G2::add(public_key_, public_key_, y_i[it]);
   }
   // Compute public_key_shares_ $v_j = \prod_{i \in QUAL} \prod_{k=0}^t (A_{ik})^{j^k} \bmod
-  // p$
-  for (auto const &jq : qual_)
+  // p$. As this is linear in the coefficients, first compute $A_k = \prod_{i \in QUAL} A_{ik}$
+  // so that $v_j = \prod_{k=0}^t (A_k)^{j^k}$ is a single polynomial evaluation per member
+  std::vector<PublicKey> qual_coefficients;
+  crypto::mcl::Init(qual_coefficients, polynomial_degree_ + 1);
+  for (auto const &iq : qual_)
   {
-    CabinetIndex jt = identity_to_index_[jq];
-    for (auto const &iq : qual_)
+    CabinetIndex it = identity_to_index_[iq];
+    for (uint32_t k = 0; k <= polynomial_degree_; ++k)
     {
-      CabinetIndex it = identity_to_index_[iq];
-      bn::G2::add(public_key_shares_[jt], public_key_shares_[jt], A_ik[it][0]);
-      crypto::mcl::UpdateRHS(jt, public_key_shares_[jt], A_ik[it]);
+      bn::G2::add(qual_coefficients[k], qual_coefficients[k], A_ik[it][k]);
     }
   }
 
+  std::vector<CabinetIndex> qual_indices;
+  for (auto const &jq : qual_)
+  {
+    qual_indices.push_back(identity_to_index_[jq]);
+  }
+
+  ParallelFor(qual_indices.size(), [&](std::size_t n) {
+    CabinetIndex const jt = qual_indices[n];
+    bn::G2::add(public_key_shares_[jt], public_key_shares_[jt],
+                crypto::mcl::ComputeRHS(jt, qual_coefficients));
+  });
+
   FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_, " compute public keys end.");
 }
 
@@ -442,7 +564,7 @@ void BeaconManager::VerifyReconstructionShare(MuddleAddress const &from, Exposed
   PrivateKey   sprime;
   s      = share.second.first;
   sprime = share.second.second;
-  lhs    = crypto::mcl::ComputeLHS(GetGroupG(), GetGroupH(), s, sprime);
+  lhs    = crypto::mcl::ComputeLHS(GetGroupGTable(), GetGroupHTable(), s, sprime);
   rhs    = crypto::mcl::ComputeRHS(identity_to_index_[from], C_ik[victim_index]);
 
   if (lhs == rhs && !lhs.isZero())
@@ -495,10 +617,11 @@ bool BeaconManager::RunReconstruction()
       shares_f.push_back(shares[index]);
     }
     a_ik[victim_index] = crypto::mcl::InterpolatePolynom(points, shares_f);
-    for (std::size_t k = 0; k <= polynomial_degree_; k++)
-    {
-      bn::G2::mul(A_ik[victim_index][k], GetGroupG(), a_ik[victim_index][k]);
-    }
+
+    auto const &group_g = GetGroupGTable();
+    ParallelFor(polynomial_degree_ + 1, [&](std::size_t k) {
+      group_g.Mul(A_ik[victim_index][k], a_ik[victim_index][k]);
+    });
   }
   return true;
 }
@@ -601,6 +724,62 @@ BeaconManager::AddResult BeaconManager::AddSignaturePart(Identity const & from,
   return AddResult::SUCCESS;
 }
 
+/**
+ * @brief adds a batch of signature shares, verifying all of them with a single batched check.
+ * @param signed_messages are the signature parts and the identities of the sending nodes.
+ * @param pool is an optional thread pool used to locate the invalid signatures of a failed batch.
+ * @return the result of adding each of the signature parts.
+ */
+std::vector<BeaconManager::AddResult> BeaconManager::AddSignatureParts(
+    std::vector<SignedMessage> const &signed_messages, threading::Pool *pool)
+{
+  std::vector<AddResult>   results(signed_messages.size(), AddResult::SUCCESS);
+  std::vector<std::size_t> pending{};
+  std::vector<PublicKey>   public_keys{};
+  std::vector<Signature>   signatures{};
+  std::set<MuddleAddress>  in_batch{};
+
+  for (std::size_t i = 0; i < signed_messages.size(); ++i)
+  {
+    auto const &from = signed_messages[i].identity.identifier();
+    auto        it   = identity_to_index_.find(from);
+
+    if (it == identity_to_index_.end() || qual_.find(from) == qual_.end())
+    {
+      results[i] = AddResult::NOT_MEMBER;
+    }
+    else if (already_signed_.find(from) != already_signed_.end() ||
+             !in_batch.insert(from).second)
+    {
+      results[i] = AddResult::SIGNATURE_ALREADY_ADDED;
+    }
+    else
+    {
+      pending.push_back(i);
+      public_keys.push_back(public_key_shares_[it->second]);
+      signatures.push_back(signed_messages[i].signature);
+    }
+  }
+
+  for (auto const invalid : crypto::mcl::FindInvalidSignatures(public_keys, current_message_,
+                                                               signatures, GetGroupG(), pool))
+  {
+    results[pending[invalid]] = AddResult::INVALID_SIGNATURE;
+  }
+
+  for (auto const i : pending)
+  {
+    if (results[i] == AddResult::SUCCESS)
+    {
+      auto const &from = signed_messages[i].identity.identifier();
+      signature_buffer_.insert({identity_to_index_.at(from), signed_messages[i].signature});
+      already_signed_.insert(from);
+    }
+  }
+
+  return results;
+}
+
 /**
  * @brief verifies the group signature.
  */
@@ -733,6 +912,16 @@ BeaconManager::Generator const &BeaconManager::GetGroupH()
   return *curve_params_.Apply([](CurveParameters &params) { return &params.GetGroupH(); });
 }
 
+BeaconManager::FixedBase const &BeaconManager::GetGroupGTable()
+{
+  return *curve_params_.Apply([](CurveParameters &params) { return &params.GetGroupGTable(); });
+}
+
+BeaconManager::FixedBase const &BeaconManager::GetGroupHTable()
+{
+  return *curve_params_.Apply([](CurveParameters &params) { return &params.GetGroupHTable(); });
+}
+
 BeaconManager::PrivateKey const &BeaconManager::GetZeroFr()
 {
   return *curve_params_.Apply([](CurveParameters &params) { return &params.GetZeroFr(); });
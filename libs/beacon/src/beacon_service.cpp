@@ -29,6 +29,7 @@
 
 #include "network/generics/milli_timer.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <iterator>
 #include <random>
@@ -81,6 +82,10 @@ T ChooseRandomlyFrom(T &container, std::size_t items)
 
 char const *ToString(BeaconService::State state);
 
+constexpr uint64_t    BeaconService::DEFAULT_ENTROPY_LOOKAHEAD;
+constexpr uint64_t    BeaconService::MAX_ENTROPY_LOOKAHEAD;
+constexpr std::size_t BeaconService::MAX_CONCURRENT_SHARE_REQUESTS;
+
 BeaconService::BeaconService(MuddleInterface &muddle, const CertificatePtr &certificate,
                              BeaconSetupService &beacon_setup, SharedEventManager event_manager,
                              bool load_and_reload_on_crash)
@@ -94,6 +99,7 @@ BeaconService::BeaconService(MuddleInterface &muddle, const CertificatePtr &cert
   , rpc_client_{"BeaconService", endpoint_, SERVICE_DKG, CHANNEL_RPC}
   , event_manager_{std::move(event_manager)}
   , beacon_protocol_{*this}
+  , verification_pool_{std::max(1u, std::thread::hardware_concurrency()), "BeaconVerify"}
   , beacon_entropy_generated_total_{telemetry::Registry::Instance().CreateCounter(
         "beacon_entropy_generated_total", "The total number of times entropy has been generated")}
   , beacon_entropy_future_signature_seen_total_{telemetry::Registry::Instance().CreateCounter(
@@ -112,6 +118,9 @@ BeaconService::BeaconService(MuddleInterface &muddle, const CertificatePtr &cert
         "beacon_state_gauge", "State the beacon is in as integer")}
   , beacon_most_recent_round_seen_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
         "beacon_most_recent_round_seen", "Most recent round the beacon has seen")}
+  , beacon_entropy_rounds_ahead_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
+        "beacon_entropy_rounds_ahead",
+        "The number of rounds of entropy generated ahead of the most recent round seen")}
   , beacon_collect_time_{telemetry::Registry::Instance().CreateHistogram(
         {0.000001, 0.00001, 0.0001, 0.001, 0.01, 0.1}, "beacon_collect_time",
         "Time taken to collect signatures")}
@@ -215,6 +224,26 @@ void BeaconService::MostRecentSeen(uint64_t round)
   FETCH_LOCK(mutex_);
   most_recent_round_seen_ = round;
   beacon_most_recent_round_seen_->set(most_recent_round_seen_);
+  UpdateRoundsAhead();
+}
+
+/**
+ * Set the number of rounds that the beacon may generate entropy for ahead of the most recent round
+ * seen. A larger window allows the beacon to absorb slow rounds without delaying block production,
+ * at the cost of the entropy being known earlier.
+ *
+ * @param rounds The size of the window, clamped to the range [1, MAX_ENTROPY_LOOKAHEAD]
+ */
+void BeaconService::SetEntropyLookahead(uint64_t rounds)
+{
+  FETCH_LOCK(mutex_);
+  entropy_lead_blocks_ = std::min(std::max(rounds, uint64_t{1}), MAX_ENTROPY_LOOKAHEAD);
+}
+
+uint64_t BeaconService::GetEntropyLookahead() const
+{
+  FETCH_LOCK(mutex_);
+  return entropy_lead_blocks_;
 }
 
 BeaconService::State BeaconService::OnWaitForSetupCompletionState()
@@ -315,7 +344,7 @@ BeaconService::State BeaconService::OnCollectSignaturesState()
     return State::COLLECT_SIGNATURES;
   }
 
-  // Attempt to get signatures from a peer we do not have the signature of
+  // Attempt to get signatures from the peers we do not have the signature of
   auto        missing_signatures_from = active_exe_unit_->manager.qual();
   auto const &signatures_struct       = signatures_being_built_[index];
 
@@ -337,19 +366,25 @@ BeaconService::State BeaconService::OnCollectSignaturesState()
   {
     FETCH_LOG_WARN(LOGGING_NAME,
                    "Signatures from all qual are already fulfilled. Re-querying a random node");
-    missing_signatures_from = ChooseRandomlyFrom(active_exe_unit_->manager.qual(), 1);
+    missing_signatures_from = active_exe_unit_->manager.qual();
   }
 
-  // semi randomly select a qual member we haven't got the signature information from to query
-  std::size_t random_member_index = random_number_++ % missing_signatures_from.size();
-  auto        it = std::next(missing_signatures_from.begin(), long(random_member_index));
+  // query a random selection of these members concurrently, so that a single slow or unresponsive
+  // member does not hold up the round
+  missing_signatures_from =
+      ChooseRandomlyFrom(missing_signatures_from, MAX_CONCURRENT_SHARE_REQUESTS);
 
-  FETCH_LOG_DEBUG(LOGGING_NAME, "Get Signature shares... (index: ", index, ")");
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Get Signature shares... (index: ", index,
+                  " peers: ", missing_signatures_from.size(), ")");
 
-  qual_promise_identity_ = Identity(*it);
-  sig_share_promise_ =
-      rpc_client_.CallSpecificAddress(qual_promise_identity_.identifier(), RPC_BEACON,
-                                      BeaconServiceProtocol::GET_SIGNATURE_SHARES, index);
+  share_requests_.clear();
+  for (auto const &address : missing_signatures_from)
+  {
+    share_requests_.push_back(
+        {Identity(address), rpc_client_.CallSpecificAddress(
+                                address, RPC_BEACON, BeaconServiceProtocol::GET_SIGNATURE_SHARES,
+                                index)});
+  }
 
   // Timer to wait maximally for network events
   timer_to_proceed_.Restart(std::chrono::milliseconds{200});
@@ -373,30 +408,47 @@ BeaconService::State BeaconService::OnVerifySignaturesState()
     return State::WAIT_FOR_SETUP_COMPLETION;
   }
 
-  // Block for up to half a second waiting for the promise to resolve
-  if (!timer_to_proceed_.HasExpired() && !sig_share_promise_->IsSuccessful())
+  // Block for a short time waiting for all of the promises to resolve
+  bool const waiting =
+      std::any_of(share_requests_.begin(), share_requests_.end(),
+                  [](ShareRequest const &request) { return request.promise->IsWaiting(); });
+
+  if (!timer_to_proceed_.HasExpired() && waiting)
   {
     state_machine_->Delay(std::chrono::milliseconds(50));
     return State::VERIFY_SIGNATURES;
   }
 
-  try
+  // Attempt to resolve the promises, discarding any which failed or are still outstanding
+  std::vector<std::pair<Identity, SignatureInformation>> responses{};
+  for (auto const &request : share_requests_)
   {
-    // Attempt to resolve the promise and add it
-    if (!sig_share_promise_->IsSuccessful() || !sig_share_promise_->GetResult(ret))
-    {
-      FETCH_LOG_WARN(LOGGING_NAME, "Failed to resolve RPC promise from ",
-                     qual_promise_identity_.identifier().ToBase64(),
-                     " when generating entropy for block: ", index,
-                     " connections: ", endpoint_.GetDirectlyConnectedPeers().size());
+    SignatureInformation ret;
 
-      state_machine_->Delay(std::chrono::milliseconds(100));
-      return State::COLLECT_SIGNATURES;
+    try
+    {
+      if (request.promise->IsSuccessful() && request.promise->GetResult(ret))
+      {
+        responses.emplace_back(request.identity, std::move(ret));
+        continue;
+      }
+    }
+    catch (...)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Promise timed out and threw! This should not happen.");
     }
+
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to resolve RPC promise from ",
+                   request.identity.identifier().ToBase64(), " when generating entropy for block: ",
+                   index, " connections: ", endpoint_.GetDirectlyConnectedPeers().size());
   }
-  catch (...)
+
+  share_requests_.clear();
+
+  if (responses.empty())
   {
-    FETCH_LOG_WARN(LOGGING_NAME, "Promise timed out and threw! This should not happen.");
+    state_machine_->Delay(std::chrono::milliseconds(100));
+    return State::COLLECT_SIGNATURES;
   }
 
   // Now collected
@@ -406,46 +458,60 @@ BeaconService::State BeaconService::OnVerifySignaturesState()
   MilliTimer const               timer{"Verify collective threshold signature", 100};
   telemetry::FunctionTimer const timer1{*beacon_verify_time_};
 
-  // Note: don't lock until the promise has resolved (above)! Otherwise the system can deadlock
+  // Note: don't lock until the promises have resolved (above)! Otherwise the system can deadlock
   // due to everyone trying to lock and resolve each others' signatures
   {
     FETCH_LOCK(mutex_);
 
-    if (ret.threshold_signatures.empty())
-    {
-      FETCH_LOG_DEBUG(LOGGING_NAME, "Peer wasn't ready when asking for signatures: ",
-                      qual_promise_identity_.identifier().ToBase64());
-      state_machine_->Delay(std::chrono::milliseconds(100));
-
-      return State::COLLECT_SIGNATURES;
-    }
-
-    if (ret.round != index)
-    {
-      FETCH_LOG_WARN(LOGGING_NAME,
-                     "Peer returned the wrong round when asked for signatures. Peer: ",
-                     qual_promise_identity_.identifier().ToBase64(), " returned: ", ret.round,
-                     " expected: ", index);
-      return State::COLLECT_SIGNATURES;
-    }
-
     // Success - Add relevant info
     auto &signatures_struct = signatures_being_built_[index];
     auto &all_sigs_map      = signatures_struct.threshold_signatures;
 
-    for (auto const &address_sig_pair : ret.threshold_signatures)
+    std::vector<SignatureShare> shares{};
+    std::size_t                 num_valid_responses{0};
+
+    for (auto const &response : responses)
     {
-      all_sigs_map[address_sig_pair.first] = address_sig_pair.second;
-      // Let the manager know
-      AddSignature(address_sig_pair.second);
+      auto const &peer = response.first;
+      auto const &ret  = response.second;
 
-      // If we have collected enough signatures already then break
-      if (active_exe_unit_->manager.can_verify())
+      if (ret.threshold_signatures.empty())
       {
-        break;
+        FETCH_LOG_DEBUG(LOGGING_NAME, "Peer wasn't ready when asking for signatures: ",
+                        peer.identifier().ToBase64());
+        continue;
       }
+
+      if (ret.round != index)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME,
+                       "Peer returned the wrong round when asked for signatures. Peer: ",
+                       peer.identifier().ToBase64(), " returned: ", ret.round,
+                       " expected: ", index);
+        continue;
+      }
+
+      ++num_valid_responses;
+
+      // the responses overlap, only the shares which have not been seen before are added
+      for (auto const &address_sig_pair : ret.threshold_signatures)
+      {
+        if (all_sigs_map.emplace(address_sig_pair.first, address_sig_pair.second).second)
+        {
+          shares.push_back(address_sig_pair.second);
+        }
+      }
+    }
+
+    if (num_valid_responses == 0)
+    {
+      state_machine_->Delay(std::chrono::milliseconds(100));
+      return State::COLLECT_SIGNATURES;
     }
 
+    // Let the manager know, verifying all of the shares as a single batch
+    AddSignatures(shares);
+
     FETCH_LOG_DEBUG(LOGGING_NAME, "After adding, we have ", all_sigs_map.size(),
                     " signatures. Round: ", index);
   }  // Mutex unlocks here since verification can take some time
@@ -478,6 +544,9 @@ BeaconService::State BeaconService::OnCompleteState()
   beacon_entropy_last_generated_->set(index);
   beacon_entropy_generated_total_->add(1);
 
+  last_round_generated_ = index;
+  UpdateRoundsAhead();
+
   // Populate the block entropy structure appropriately
   block_entropy_being_created_->group_signature =
       active_exe_unit_->manager.GroupSignature().getStr();
@@ -514,45 +583,57 @@ BeaconService::State BeaconService::OnCompleteState()
   return State::WAIT_FOR_SETUP_COMPLETION;
 }
 
-bool BeaconService::AddSignature(SignatureShare share)
+/**
+ * Add a batch of signature shares to the manager, which verifies them with a single batched check
+ * and only searches for the invalid shares if that fails
+ */
+void BeaconService::AddSignatures(std::vector<SignatureShare> const &shares)
 {
   assert(active_exe_unit_ != nullptr);
-  auto ret = active_exe_unit_->manager.AddSignaturePart(share.identity, share.signature);
+  auto const results = active_exe_unit_->manager.AddSignatureParts(shares, &verification_pool_);
 
-  // Checking that the signature is valid
-  if (ret == BeaconManager::AddResult::INVALID_SIGNATURE)
+  for (std::size_t i = 0; i < results.size(); ++i)
   {
-    FETCH_LOG_ERROR(LOGGING_NAME, "Signature invalid.");
+    // Checking that the signature is valid
+    if (results[i] == BeaconManager::AddResult::INVALID_SIGNATURE)
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Signature invalid.");
 
-    EventInvalidSignature event;
-    // TODO(tfr): Received invalid signature - fill event details
-    event_manager_->Dispatch(event);
+      EventInvalidSignature event;
+      // TODO(tfr): Received invalid signature - fill event details
+      event_manager_->Dispatch(event);
+    }
+    else if (results[i] == BeaconManager::AddResult::NOT_MEMBER)
+    {  // And that it was sent by a member of the cabinet
+      FETCH_LOG_ERROR(LOGGING_NAME, "Signature from non-member! Identity: ",
+                      shares[i].identity.identifier().ToBase64());
 
-    return false;
-  }
-  if (ret == BeaconManager::AddResult::NOT_MEMBER)
-  {  // And that it was sent by a member of the cabinet
-    FETCH_LOG_ERROR(LOGGING_NAME, "Signature from non-member! Identity: ",
-                    share.identity.identifier().ToBase64());
+      for (auto const &q : active_exe_unit_->manager.qual())
+      {
+        FETCH_LOG_INFO(LOGGING_NAME, "Note: qual is: ", q.ToBase64());
+      }
 
-    for (auto const &i : active_exe_unit_->manager.qual())
+      EventSignatureFromNonMember event;
+      // TODO(tfr): Received signature from non-member - deal with it.
+      event_manager_->Dispatch(event);
+    }
+    else if (results[i] == BeaconManager::AddResult::SIGNATURE_ALREADY_ADDED)
     {
-      FETCH_LOG_INFO(LOGGING_NAME, "Note: qual is: ", i.ToBase64());
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Accidental duplicate signature added!");
     }
-
-    EventSignatureFromNonMember event;
-    // TODO(tfr): Received signature from non-member - deal with it.
-    event_manager_->Dispatch(event);
-
-    return false;
-  }
-
-  if (ret == BeaconManager::AddResult::SIGNATURE_ALREADY_ADDED)
-  {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Accidental duplicate signature added!");
   }
+}
 
-  return true;
+/**
+ * Update the telemetry for the number of rounds generated ahead of the most recent round seen. The
+ * mutex must be held by the caller.
+ */
+void BeaconService::UpdateRoundsAhead()
+{
+  beacon_entropy_rounds_ahead_->set(
+      (last_round_generated_ > most_recent_round_seen_)
+          ? (last_round_generated_ - most_recent_round_seen_)
+          : 0);
 }
 
 std::weak_ptr<core::Runnable> BeaconService::GetWeakRunnable()
@@ -19,11 +19,22 @@
 #include "beacon/notarisation_manager.hpp"
 #include "core/synchronisation/protected.hpp"
 
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace fetch {
 namespace ledger {
 
 Protected<std::shared_ptr<NotarisationManager::Generator>> generator_;
 
+using CabinetVerifiers =
+    std::deque<std::pair<std::string, std::shared_ptr<AggregateSignatureVerifier>>>;
+Protected<CabinetVerifiers> cabinet_verifiers_;
+
 NotarisationManager::NotarisationManager()
 {
   generator_.ApplyVoid([](std::shared_ptr<Generator> generator) {
@@ -63,14 +74,24 @@ NotarisationManager::AggregateSignature NotarisationManager::ComputeAggregateSig
 bool NotarisationManager::VerifyAggregateSignature(MessagePayload const &    message,
                                                    AggregateSignature const &aggregate_signature)
 {
-  if (aggregate_signature.second.size() != cabinet_public_keys_.size())
+  if (!verifier_)
   {
     return false;
   }
-  PublicKey aggregate_public_key =
-      crypto::mcl::ComputeAggregatePublicKey(aggregate_signature.second, cabinet_public_keys_);
-  return crypto::mcl::VerifySign(aggregate_public_key, message, aggregate_signature.first,
-                                 GetGenerator());
+  return verifier_->Verify(message, aggregate_signature);
+}
+
+/**
+ * Verifies a batch of aggregate signatures with the keys of this aeon, for example when syncing
+ * many notarised blocks at once
+ */
+std::vector<bool> NotarisationManager::VerifyAggregateSignatures(NotarisationBatch const &batch)
+{
+  if (!verifier_)
+  {
+    return std::vector<bool>(batch.size(), false);
+  }
+  return verifier_->Verify(batch);
 }
 
 bool NotarisationManager::VerifyAggregateSignature(MessagePayload const &    message,
@@ -81,10 +102,7 @@ bool NotarisationManager::VerifyAggregateSignature(MessagePayload const &    mes
   {
     return false;
   }
-  PublicKey aggregate_public_key =
-      crypto::mcl::ComputeAggregatePublicKey(aggregate_signature.second, public_keys);
-  return crypto::mcl::VerifySign(aggregate_public_key, message, aggregate_signature.first,
-                                 GetGenerator());
+  return GetCabinetVerifier(public_keys)->Verify(message, aggregate_signature);
 }
 
 NotarisationManager::PublicKey NotarisationManager::GenerateKeys()
@@ -117,18 +135,17 @@ void NotarisationManager::SetAeonDetails(
     ++index;
   }
 
-  cabinet_public_keys_.resize(identity_to_index_.size());
-  // Compute modified public keys
+  // Compute modified public keys, which are in the same order as the cabinet
+  cabinet_public_keys_ = crypto::mcl::ComputeCabinetAggregatePublicKeys(temp_keys);
+  verifier_            = GetCabinetVerifier(temp_keys);
+
+  // Set own aggregate coefficient for signing
   for (auto const &member : cabinet_public_keys)
   {
-    PrivateKey aggregate_coefficient =
-        crypto::mcl::SignatureAggregationCoefficient(member.second, temp_keys);
-    cabinet_public_keys_[identity_to_index_[member.first]] =
-        AggregatePublicKey{member.second, aggregate_coefficient};
-    // Set own aggregate coefficient for signing
     if (member.second == public_key_)
     {
-      aggregate_private_key_.coefficient = aggregate_coefficient;
+      aggregate_private_key_.coefficient =
+          crypto::mcl::SignatureAggregationCoefficient(member.second, temp_keys);
     }
   }
 
@@ -176,5 +193,42 @@ NotarisationManager::Generator const &NotarisationManager::GetGenerator()
   });
 }
 
+/**
+ * Verifiers of the most recently seen cabinets. These are shared between the notarisation managers
+ * and the verification of blocks from previous aeons, so that the aggregation coefficients of a
+ * cabinet are computed once and the verified notarisations are remembered
+ */
+NotarisationManager::VerifierPtr NotarisationManager::GetCabinetVerifier(
+    std::vector<PublicKey> const &public_keys)
+{
+  static constexpr std::size_t MAX_CACHED_CABINETS = 4;
+
+  std::string cabinet_id;
+  for (auto const &key : public_keys)
+  {
+    cabinet_id += key.getStr();
+  }
+
+  return cabinet_verifiers_.Apply([&](CabinetVerifiers &verifiers) {
+    for (auto const &entry : verifiers)
+    {
+      if (entry.first == cabinet_id)
+      {
+        return entry.second;
+      }
+    }
+
+    auto verifier = std::make_shared<AggregateSignatureVerifier>(
+        crypto::mcl::ComputeCabinetAggregatePublicKeys(public_keys), GetGenerator());
+
+    verifiers.emplace_back(std::move(cabinet_id), verifier);
+    if (verifiers.size() > MAX_CACHED_CABINETS)
+    {
+      verifiers.pop_front();
+    }
+    return verifier;
+  });
+}
+
 }  // namespace ledger
 }  // namespace fetch
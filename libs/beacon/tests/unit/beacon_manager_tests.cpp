@@ -359,4 +359,19 @@ TEST(beacon_manager, dkg_and_threshold_signing)
       BeaconManager::AddResult::SUCCESS);
   EXPECT_TRUE(beacon_managers[2]->can_verify());
   EXPECT_TRUE(beacon_managers[2]->Verify());
+
+  // Add a batch of signatures, only some of which are accepted
+  std::vector<BeaconManager::SignedMessage> batch{
+      {signed_msgs[1].signature, unknown_sender->identity()},
+      {signed_msgs[0].signature, member_ptrs[0]->identity()},
+      {signed_msgs[2].signature, member_ptrs[1]->identity()}};
+  std::vector<BeaconManager::AddResult> const expected_results{
+      BeaconManager::AddResult::NOT_MEMBER, BeaconManager::AddResult::SIGNATURE_ALREADY_ADDED,
+      BeaconManager::AddResult::INVALID_SIGNATURE};
+  EXPECT_EQ(beacon_managers[2]->AddSignatureParts(batch), expected_results);
+
+  batch = {{signed_msgs[1].signature, member_ptrs[1]->identity()}};
+  EXPECT_EQ(beacon_managers[2]->AddSignatureParts(batch),
+            std::vector<BeaconManager::AddResult>{BeaconManager::AddResult::SUCCESS});
+  EXPECT_TRUE(beacon_managers[2]->Verify());
 }
@@ -0,0 +1,280 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "beacon/beacon_service.hpp"
+#include "beacon/create_new_certificate.hpp"
+#include "beacon/events.hpp"
+#include "beacon/trusted_dealer.hpp"
+#include "beacon/trusted_dealer_beacon_service.hpp"
+#include "core/reactor.hpp"
+#include "muddle/muddle_interface.hpp"
+#include "shards/manifest_cache_interface.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace fetch;
+using namespace fetch::beacon;
+
+using fetch::telemetry::Gauge;
+using fetch::telemetry::Registry;
+
+using Status         = BeaconService::Status;
+using MuddleAddress  = byte_array::ConstByteArray;
+using CabinetMembers = std::set<MuddleAddress>;
+
+constexpr uint16_t BASE_PORT    = 11000;
+constexpr uint32_t CABINET_SIZE = 4;
+constexpr double   THRESHOLD    = 0.5;
+constexpr uint64_t AEON_PERIOD  = 10;
+
+class DummyManifestCache : public shards::ManifestCacheInterface
+{
+public:
+  bool QueryManifest(Address const & /*address*/, shards::Manifest & /*manifest*/) override
+  {
+    return true;
+  }
+};
+
+struct CabinetNode
+{
+  CabinetNode(uint16_t port, uint16_t index)
+    : port{port}
+    , network_manager{"BeaconServiceTests" + std::to_string(index), 1}
+    , reactor{"BeaconServiceTests" + std::to_string(index)}
+    , certificate{CreateNewCertificate()}
+    , muddle{muddle::CreateMuddle("Test", certificate, network_manager, "127.0.0.1")}
+    , setup_service{*muddle, manifest_cache, certificate, THRESHOLD, AEON_PERIOD}
+    , beacon_service{*muddle, certificate, setup_service, event_manager}
+  {
+    network_manager.Start();
+    muddle->Start({port});
+  }
+
+  ~CabinetNode()
+  {
+    reactor.Stop();
+    muddle->Stop();
+    network_manager.Stop();
+  }
+
+  network::Uri GetHint() const
+  {
+    return network::Uri{"tcp://127.0.0.1:" + std::to_string(port)};
+  }
+
+  uint16_t                         port;
+  EventManager::SharedEventManager event_manager{EventManager::New()};
+  network::NetworkManager          network_manager;
+  core::Reactor                    reactor;
+  BeaconService::ProverPtr         certificate;
+  muddle::MuddlePtr                muddle;
+  DummyManifestCache               manifest_cache;
+  TrustedDealerSetupService        setup_service;
+  BeaconService                    beacon_service;
+};
+
+using CabinetNodePtr = std::unique_ptr<CabinetNode>;
+using Cabinet        = std::vector<CabinetNodePtr>;
+
+class BeaconServiceTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    crypto::mcl::details::MCLInitialiser();
+
+    for (uint16_t i = 0; i < CABINET_SIZE; ++i)
+    {
+      cabinet_.emplace_back(std::make_unique<CabinetNode>(static_cast<uint16_t>(BASE_PORT + i), i));
+    }
+
+    for (std::size_t i = 0; i < cabinet_.size(); ++i)
+    {
+      for (std::size_t j = i + 1; j < cabinet_.size(); ++j)
+      {
+        cabinet_[i]->muddle->ConnectTo(cabinet_[j]->muddle->GetAddress(), cabinet_[j]->GetHint());
+      }
+    }
+
+    ASSERT_TRUE(WaitFor([this]() {
+      return std::all_of(cabinet_.begin(), cabinet_.end(), [](CabinetNodePtr const &node) {
+        return (node->muddle->GetNumDirectlyConnectedPeers() + 1) >= CABINET_SIZE;
+      });
+    }));
+
+    for (auto const &node : cabinet_)
+    {
+      members_.insert(node->certificate->identity().identifier());
+    }
+  }
+
+  void TearDown() override
+  {
+    cabinet_.clear();
+  }
+
+  /**
+   * Start the beacon of the given nodes and hand every member of the cabinet its keys for the
+   * first aeon
+   *
+   * @param running The indices of the nodes whose beacon should run
+   * @param most_recent_seen The round the chain is reported to be at
+   */
+  void StartAeon(std::vector<std::size_t> const &running, uint64_t most_recent_seen)
+  {
+    for (auto const index : running)
+    {
+      auto &node = *cabinet_[index];
+      node.reactor.Attach(node.beacon_service.GetWeakRunnable());
+      node.reactor.Start();
+    }
+
+    BlockEntropy prev_entropy;
+    prev_entropy.group_signature = "Hello";
+
+    TrustedDealer  dealer{members_, THRESHOLD};
+    uint64_t const start_time =
+        GetTime(moment::GetClock("default", moment::ClockType::SYSTEM)) + 1;
+
+    for (auto const &node : cabinet_)
+    {
+      node->setup_service.StartNewCabinet(
+          members_, 0, start_time, prev_entropy,
+          dealer.GetDkgKeys(node->certificate->identity().identifier()));
+      node->beacon_service.MostRecentSeen(most_recent_seen);
+    }
+  }
+
+  /**
+   * Check whether the entropy for a round is available from the beacon of each of the given nodes
+   */
+  bool EntropyAvailable(std::vector<std::size_t> const &nodes, uint64_t round) const
+  {
+    return std::all_of(nodes.begin(), nodes.end(), [this, round](std::size_t index) {
+      BlockEntropy entropy;
+      return cabinet_[index]->beacon_service.GenerateEntropy(round, entropy) == Status::OK;
+    });
+  }
+
+  template <typename Condition>
+  static bool WaitFor(Condition &&condition,
+                      std::chrono::milliseconds timeout = std::chrono::seconds{60})
+  {
+    auto const deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition())
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        return false;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    }
+
+    return true;
+  }
+
+  Cabinet        cabinet_;
+  CabinetMembers members_;
+};
+
+TEST_F(BeaconServiceTests, EntropyLookaheadIsClamped)
+{
+  auto &beacon = cabinet_.front()->beacon_service;
+
+  EXPECT_EQ(beacon.GetEntropyLookahead(), BeaconService::DEFAULT_ENTROPY_LOOKAHEAD);
+
+  beacon.SetEntropyLookahead(0);
+  EXPECT_EQ(beacon.GetEntropyLookahead(), 1);
+
+  beacon.SetEntropyLookahead(5);
+  EXPECT_EQ(beacon.GetEntropyLookahead(), 5);
+
+  beacon.SetEntropyLookahead(BeaconService::MAX_ENTROPY_LOOKAHEAD + 1);
+  EXPECT_EQ(beacon.GetEntropyLookahead(), BeaconService::MAX_ENTROPY_LOOKAHEAD);
+}
+
+TEST_F(BeaconServiceTests, EntropyIsGeneratedUpToTheLookahead)
+{
+  constexpr uint64_t LOOKAHEAD = 3;
+
+  std::vector<std::size_t> const all{0, 1, 2, 3};
+  for (auto const &node : cabinet_)
+  {
+    node->beacon_service.SetEntropyLookahead(LOOKAHEAD);
+  }
+
+  StartAeon(all, 0);
+
+  // the beacon runs ahead of the chain, but no further than the lookahead window
+  ASSERT_TRUE(WaitFor([&]() { return EntropyAvailable(all, LOOKAHEAD); }));
+  std::this_thread::sleep_for(std::chrono::seconds{1});
+
+  for (auto const &node : cabinet_)
+  {
+    BlockEntropy entropy;
+    EXPECT_EQ(node->beacon_service.GenerateEntropy(LOOKAHEAD + 1, entropy), Status::FAILED);
+  }
+
+  auto const rounds_ahead =
+      Registry::Instance().LookupMeasurement<Gauge<uint64_t>>("beacon_entropy_rounds_ahead");
+  ASSERT_TRUE(rounds_ahead);
+  EXPECT_EQ(rounds_ahead->get(), LOOKAHEAD);
+
+  // once the chain catches up the rest of the aeon is generated
+  for (auto const &node : cabinet_)
+  {
+    node->beacon_service.MostRecentSeen(AEON_PERIOD - 1);
+  }
+
+  EXPECT_TRUE(WaitFor([&]() { return EntropyAvailable(all, AEON_PERIOD - 1); }));
+  EXPECT_EQ(rounds_ahead->get(), 0);
+}
+
+TEST_F(BeaconServiceTests, RoundsCompleteWithAnIdleQualMember)
+{
+  // the last member holds keys for the aeon but never signs, so any share request sent to it is
+  // answered without shares. The remaining members still reach the signature threshold.
+  std::vector<std::size_t> const running{0, 1, 2};
+
+  StartAeon(running, AEON_PERIOD - 1);
+
+  EXPECT_TRUE(WaitFor([&]() { return EntropyAvailable(running, AEON_PERIOD - 1); }));
+
+  for (auto const index : running)
+  {
+    EventCabinetCompletedWork event;
+    EXPECT_TRUE(WaitFor([&]() { return cabinet_[index]->event_manager->Poll(event); }));
+  }
+}
+
+}  // namespace
@@ -0,0 +1,176 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "bloom_filter/blocked_bloom_filter.hpp"
+#include "bloom_filter/bloom_filter.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lcg.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using fetch::BasicBloomFilter;
+using fetch::BlockedBloomFilter;
+using fetch::byte_array::ByteArray;
+using fetch::random::LinearCongruentialGenerator;
+
+namespace {
+
+using Elements = BlockedBloomFilter::Elements;
+
+// the filters are sized for this many elements, as in the duplicate transaction detection
+constexpr std::size_t NUM_ELEMENTS = 100000;
+
+Elements GenerateDigests(std::size_t count, uint64_t seed)
+{
+  LinearCongruentialGenerator rng;
+  rng.Seed(seed);
+
+  Elements digests{};
+  digests.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray digest;
+    digest.Resize(32);
+    for (std::size_t j = 0; j < digest.size(); ++j)
+    {
+      digest[j] = static_cast<uint8_t>(rng());
+    }
+
+    digests.emplace_back(digest);
+  }
+
+  return digests;
+}
+
+void BloomFilter_Basic_Add(benchmark::State &state)
+{
+  auto const       digests = GenerateDigests(NUM_ELEMENTS, 1);
+  BasicBloomFilter filter{};
+
+  for (auto _ : state)
+  {
+    for (auto const &digest : digests)
+    {
+      filter.Add(digest);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_ELEMENTS));
+}
+
+void BloomFilter_Basic_Match(benchmark::State &state)
+{
+  auto const       digests = GenerateDigests(NUM_ELEMENTS, 1);
+  auto const       queries = GenerateDigests(NUM_ELEMENTS, 2);
+  BasicBloomFilter filter{};
+
+  for (auto const &digest : digests)
+  {
+    filter.Add(digest);
+  }
+
+  for (auto _ : state)
+  {
+    for (auto const &query : queries)
+    {
+      benchmark::DoNotOptimize(filter.Match(query));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_ELEMENTS));
+}
+
+void BloomFilter_Blocked_Add(benchmark::State &state)
+{
+  auto const         digests = GenerateDigests(NUM_ELEMENTS, 1);
+  BlockedBloomFilter filter{static_cast<std::size_t>(state.range(0))};
+
+  for (auto _ : state)
+  {
+    for (auto const &digest : digests)
+    {
+      filter.Add(digest);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_ELEMENTS));
+}
+
+void BloomFilter_Blocked_Match(benchmark::State &state)
+{
+  auto const         digests = GenerateDigests(NUM_ELEMENTS, 1);
+  auto const         queries = GenerateDigests(NUM_ELEMENTS, 2);
+  BlockedBloomFilter filter{static_cast<std::size_t>(state.range(0))};
+
+  filter.AddMany(digests);
+
+  for (auto _ : state)
+  {
+    for (auto const &query : queries)
+    {
+      benchmark::DoNotOptimize(filter.Match(query));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_ELEMENTS));
+}
+
+void BloomFilter_Blocked_AddMany(benchmark::State &state)
+{
+  auto const         digests = GenerateDigests(NUM_ELEMENTS, 1);
+  BlockedBloomFilter filter{static_cast<std::size_t>(state.range(0))};
+
+  for (auto _ : state)
+  {
+    filter.AddMany(digests);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_ELEMENTS));
+}
+
+void BloomFilter_Blocked_MatchMany(benchmark::State &state)
+{
+  auto const         digests = GenerateDigests(NUM_ELEMENTS, 1);
+  auto const         queries = GenerateDigests(NUM_ELEMENTS, 2);
+  BlockedBloomFilter filter{static_cast<std::size_t>(state.range(0))};
+
+  filter.AddMany(digests);
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(filter.MatchMany(queries));
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_ELEMENTS));
+}
+
+}  // namespace
+
+BENCHMARK(BloomFilter_Basic_Add);
+BENCHMARK(BloomFilter_Basic_Match);
+
+// the default size, which fits in the cache, and a filter which does not
+BENCHMARK(BloomFilter_Blocked_Add)->Arg(8 << 20)->Arg(1 << 28);
+BENCHMARK(BloomFilter_Blocked_Match)->Arg(8 << 20)->Arg(1 << 28);
+BENCHMARK(BloomFilter_Blocked_AddMany)->Arg(8 << 20)->Arg(1 << 28);
+BENCHMARK(BloomFilter_Blocked_MatchMany)->Arg(8 << 20)->Arg(1 << 28);
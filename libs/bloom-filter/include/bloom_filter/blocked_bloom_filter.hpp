@@ -0,0 +1,107 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+
+namespace byte_array {
+class ConstByteArray;
+}
+
+/*
+ * A split block Bloom filter. Each element is mapped to a single 256 bit block of the filter and
+ * sets one bit in each of the eight 32 bit words of the block. An operation therefore touches a
+ * single cache line, rather than one per hash function as with the BasicBloomFilter. All of the
+ * bits are derived from one 64 bit hash of the element, and when built for AVX2 all eight words
+ * of a block are probed with a single vector operation.
+ *
+ * The batch operations compute the hashes of a number of elements up front and prefetch their
+ * blocks, so that the cache misses of consecutive elements overlap.
+ *
+ * Not thread-safe.
+ */
+class BlockedBloomFilter
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Elements       = std::vector<ConstByteArray>;
+  using Matches        = std::vector<bool>;
+
+  static constexpr std::size_t DEFAULT_SIZE_IN_BITS = 8 * 1024 * 1024;
+
+  /*
+   * Construct a Bloom filter of (at least) the given size
+   */
+  explicit BlockedBloomFilter(std::size_t size_in_bits = DEFAULT_SIZE_IN_BITS);
+  BlockedBloomFilter(BlockedBloomFilter const &) = delete;
+  BlockedBloomFilter(BlockedBloomFilter &&)      = default;
+  ~BlockedBloomFilter()                          = default;
+
+  BlockedBloomFilter &operator=(BlockedBloomFilter const &) = delete;
+  BlockedBloomFilter &operator=(BlockedBloomFilter &&) = default;
+
+  /*
+   * Check if the argument matches the Bloom filter. Returns false if the element had never been
+   * added; true if the element had been added or is a false positive.
+   */
+  bool Match(ConstByteArray const &element) const;
+
+  /*
+   * Check a number of elements against the Bloom filter. The result for each element is the same
+   * as that of Match.
+   */
+  Matches MatchMany(Elements const &elements) const;
+
+  /*
+   * Set the bits of the Bloom filter corresponding to the argument
+   */
+  void Add(ConstByteArray const &element);
+
+  /*
+   * Set the bits of the Bloom filter corresponding to each of the elements
+   */
+  void AddMany(Elements const &elements);
+
+  /*
+   * Empty the Bloom filter (set all bits to zero). Preserves the filter size.
+   */
+  void Reset();
+
+  std::size_t size_in_bits() const;
+
+private:
+  static constexpr std::size_t WORDS_PER_BLOCK = 8;
+
+  struct Block
+  {
+    uint32_t words[WORDS_PER_BLOCK];
+  };
+
+  using Blocks = std::vector<Block>;
+
+  Block const &BlockFor(uint64_t hash) const;
+  Block &      BlockFor(uint64_t hash);
+
+  Blocks blocks_;
+};
+
+}  // namespace fetch
@@ -0,0 +1,229 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "bloom_filter/blocked_bloom_filter.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace {
+
+/*
+ * The number of elements of a batch operation whose blocks are prefetched ahead of being accessed
+ */
+constexpr std::size_t BATCH_SIZE = 16;
+
+/*
+ * The odd constants which select the bit within each word of a block, one per word
+ */
+constexpr uint32_t SALT[8] = {0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                              0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+
+uint64_t Mix(uint64_t value)
+{
+  value ^= value >> 33u;
+  value *= 0xff51afd7ed558ccdull;
+  value ^= value >> 33u;
+  value *= 0xc4ceb9fe1a85ec53ull;
+  value ^= value >> 33u;
+
+  return value;
+}
+
+/*
+ * A fast, non-cryptographic 64 bit hash of the element, consuming eight bytes at a time
+ */
+uint64_t Hash(byte_array::ConstByteArray const &element)
+{
+  uint8_t const *data = element.pointer();
+  std::size_t    size = element.size();
+
+  uint64_t hash = Mix(size ^ 0x9e3779b97f4a7c15ull);
+  for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t))
+  {
+    uint64_t word{0};
+    std::memcpy(&word, data, sizeof(uint64_t));
+
+    hash = Mix(hash ^ word);
+  }
+
+  if (size > 0)
+  {
+    uint64_t word{0};
+    std::memcpy(&word, data, size);
+
+    hash = Mix(hash ^ word);
+  }
+
+  return hash;
+}
+
+#ifdef __AVX2__
+
+__m256i Mask(uint64_t hash)
+{
+  __m256i const salt = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(SALT));
+
+  // the top five bits of each product select the bit of the corresponding word
+  __m256i bits = _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int32_t>(hash)), salt);
+  bits         = _mm256_srli_epi32(bits, 27);
+
+  return _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+}
+
+void Set(uint32_t *words, uint64_t hash)
+{
+  auto *const block = reinterpret_cast<__m256i *>(words);
+  _mm256_storeu_si256(block, _mm256_or_si256(_mm256_loadu_si256(block), Mask(hash)));
+}
+
+bool Test(uint32_t const *words, uint64_t hash)
+{
+  auto const *const block = reinterpret_cast<__m256i const *>(words);
+  return _mm256_testc_si256(_mm256_loadu_si256(block), Mask(hash)) != 0;
+}
+
+#else
+
+uint32_t Mask(uint64_t hash, std::size_t word)
+{
+  return 1u << ((static_cast<uint32_t>(hash) * SALT[word]) >> 27u);
+}
+
+void Set(uint32_t *words, uint64_t hash)
+{
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    words[i] |= Mask(hash, i);
+  }
+}
+
+bool Test(uint32_t const *words, uint64_t hash)
+{
+  bool match{true};
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    match &= (words[i] & Mask(hash, i)) != 0;
+  }
+
+  return match;
+}
+
+#endif  // __AVX2__
+
+}  // namespace
+
+constexpr std::size_t BlockedBloomFilter::DEFAULT_SIZE_IN_BITS;
+constexpr std::size_t BlockedBloomFilter::WORDS_PER_BLOCK;
+
+BlockedBloomFilter::BlockedBloomFilter(std::size_t size_in_bits)
+  : blocks_(std::max<std::size_t>(1, (size_in_bits + (sizeof(Block) * 8) - 1) /
+                                         (sizeof(Block) * 8)),
+            Block{})
+{}
+
+bool BlockedBloomFilter::Match(ConstByteArray const &element) const
+{
+  auto const hash = Hash(element);
+  return Test(BlockFor(hash).words, hash);
+}
+
+BlockedBloomFilter::Matches BlockedBloomFilter::MatchMany(Elements const &elements) const
+{
+  Matches  matches(elements.size());
+  uint64_t hashes[BATCH_SIZE];
+
+  for (std::size_t offset = 0; offset < elements.size(); offset += BATCH_SIZE)
+  {
+    std::size_t const count = std::min(BATCH_SIZE, elements.size() - offset);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      hashes[i] = Hash(elements[offset + i]);
+      __builtin_prefetch(&BlockFor(hashes[i]));
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      matches[offset + i] = Test(BlockFor(hashes[i]).words, hashes[i]);
+    }
+  }
+
+  return matches;
+}
+
+void BlockedBloomFilter::Add(ConstByteArray const &element)
+{
+  auto const hash = Hash(element);
+  Set(BlockFor(hash).words, hash);
+}
+
+void BlockedBloomFilter::AddMany(Elements const &elements)
+{
+  uint64_t hashes[BATCH_SIZE];
+
+  for (std::size_t offset = 0; offset < elements.size(); offset += BATCH_SIZE)
+  {
+    std::size_t const count = std::min(BATCH_SIZE, elements.size() - offset);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      hashes[i] = Hash(elements[offset + i]);
+      __builtin_prefetch(&BlockFor(hashes[i]), 1);
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      Set(BlockFor(hashes[i]).words, hashes[i]);
+    }
+  }
+}
+
+void BlockedBloomFilter::Reset()
+{
+  std::fill(blocks_.begin(), blocks_.end(), Block{});
+}
+
+std::size_t BlockedBloomFilter::size_in_bits() const
+{
+  return blocks_.size() * sizeof(Block) * 8;
+}
+
+/*
+ * The block of an element is selected by the upper half of its hash, the lower half selects the
+ * bits within the block
+ */
+BlockedBloomFilter::Block const &BlockedBloomFilter::BlockFor(uint64_t hash) const
+{
+  return blocks_[((hash >> 32u) * blocks_.size()) >> 32u];
+}
+
+BlockedBloomFilter::Block &BlockedBloomFilter::BlockFor(uint64_t hash)
+{
+  return blocks_[((hash >> 32u) * blocks_.size()) >> 32u];
+}
+
+}  // namespace fetch
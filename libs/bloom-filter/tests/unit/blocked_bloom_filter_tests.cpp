@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "bloom_filter/blocked_bloom_filter.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lcg.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::BlockedBloomFilter;
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+
+BlockedBloomFilter::Elements GenerateElements(std::size_t count, uint64_t seed)
+{
+  fetch::random::LinearCongruentialGenerator rng;
+  rng.Seed(seed);
+
+  BlockedBloomFilter::Elements elements{};
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray element;
+    element.Resize(32);
+    for (std::size_t j = 0; j < element.size(); ++j)
+    {
+      element[j] = static_cast<uint8_t>(rng());
+    }
+
+    elements.emplace_back(element);
+  }
+
+  return elements;
+}
+
+TEST(BlockedBloomFilterTests, empty_filter_matches_nothing)
+{
+  BlockedBloomFilter filter{};
+
+  for (auto const &element : GenerateElements(100, 1))
+  {
+    EXPECT_FALSE(filter.Match(element));
+  }
+
+  EXPECT_FALSE(filter.Match(ConstByteArray{}));
+}
+
+TEST(BlockedBloomFilterTests, added_elements_always_match)
+{
+  BlockedBloomFilter filter{};
+
+  auto const elements = GenerateElements(1000, 2);
+  for (auto const &element : elements)
+  {
+    filter.Add(element);
+  }
+
+  filter.Add(ConstByteArray{"short"});
+
+  for (auto const &element : elements)
+  {
+    EXPECT_TRUE(filter.Match(element));
+  }
+
+  EXPECT_TRUE(filter.Match(ConstByteArray{"short"}));
+}
+
+TEST(BlockedBloomFilterTests, batch_operations_are_equivalent_to_single_ones)
+{
+  BlockedBloomFilter single{};
+  BlockedBloomFilter batch{};
+
+  auto const added = GenerateElements(1000, 3);
+  for (auto const &element : added)
+  {
+    single.Add(element);
+  }
+  batch.AddMany(added);
+
+  auto queried = GenerateElements(1000, 4);
+  queried.insert(queried.end(), added.begin(), added.end());
+
+  auto const matches = batch.MatchMany(queried);
+  ASSERT_EQ(matches.size(), queried.size());
+
+  for (std::size_t i = 0; i < queried.size(); ++i)
+  {
+    EXPECT_EQ(matches[i], single.Match(queried[i]));
+  }
+
+  EXPECT_TRUE(batch.MatchMany({}).empty());
+}
+
+TEST(BlockedBloomFilterTests, false_positive_rate_is_low)
+{
+  // 16 bits per element
+  BlockedBloomFilter filter{16 * 10000};
+  filter.AddMany(GenerateElements(10000, 5));
+
+  std::size_t false_positives{0};
+  for (bool const match : filter.MatchMany(GenerateElements(10000, 6)))
+  {
+    false_positives += match ? 1 : 0;
+  }
+
+  // the theoretical rate is a little under 0.1%
+  EXPECT_LT(false_positives, 50);
+}
+
+TEST(BlockedBloomFilterTests, reset_clears_the_filter)
+{
+  BlockedBloomFilter filter{1000};
+  EXPECT_EQ(filter.size_in_bits(), 1024);
+
+  auto const elements = GenerateElements(100, 7);
+  filter.AddMany(elements);
+  filter.Reset();
+
+  EXPECT_EQ(filter.size_in_bits(), 1024);
+  for (auto const &element : elements)
+  {
+    EXPECT_FALSE(filter.Match(element));
+  }
+}
+
+}  // namespace
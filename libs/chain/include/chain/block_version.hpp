@@ -0,0 +1,47 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <limits>
+
+namespace fetch {
+namespace chain {
+
+/**
+ * The versions of the rules with which blocks are executed. Every version after the initial one
+ * changes the results of execution, so it only applies to the blocks from its activation height
+ * onwards. The activation heights are part of the configuration of the network, like the genesis.
+ * A version is never active until the network schedules it, so that the existing blocks of a chain
+ * are always executed as they were when they were mined.
+ */
+enum class BlockVersion : uint8_t
+{
+  INITIAL = 0,
+  EXACT_UINT256_ARITHMETIC,  ///< UInt256 multiplication and division in contracts are exact
+  OBSERVED_LANE_PACKING,     ///< Slices can hold transactions whose declared lanes overlap
+};
+
+constexpr uint64_t NEVER_ACTIVATED = std::numeric_limits<uint64_t>::max();
+
+uint64_t GetActivationHeight(BlockVersion version);
+void     SetActivationHeight(BlockVersion version, uint64_t block_number);
+bool     IsActive(BlockVersion version, uint64_t block_number);
+
+}  // namespace chain
+}  // namespace fetch
@@ -0,0 +1,73 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace chain {
+
+/**
+ * Hot accounts, such as exchanges, can have their token balance split over sub-balances, one on
+ * each lane. Transfers to these accounts credit the sub-balance on a lane the transaction already
+ * uses, so that they no longer all conflict on the lane of the account. Reading the full balance
+ * or spending from these accounts needs every lane, and folds the sub-balances back into the main
+ * balance.
+ *
+ * The accounts and the number of lanes are part of the configuration of the network, like the
+ * genesis. The set is built once and then handed to everything which lays out or executes
+ * transactions.
+ */
+class ShardedBalances
+{
+public:
+  using Addresses      = std::vector<Address>;
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  // Construction / Destruction
+  ShardedBalances() = default;
+  ShardedBalances(Addresses const &accounts, uint32_t log2_num_lanes);
+  ShardedBalances(ShardedBalances const &) = default;
+  ShardedBalances(ShardedBalances &&)      = default;
+  ~ShardedBalances()                       = default;
+
+  bool           Contains(Address const &address) const;
+  uint32_t       log2_num_lanes() const;
+  ConstByteArray GetShardKey(Address const &address, uint32_t lane) const;
+
+  // Operators
+  ShardedBalances &operator=(ShardedBalances const &) = default;
+  ShardedBalances &operator=(ShardedBalances &&) = default;
+
+private:
+  using ShardKeys = std::vector<ConstByteArray>;
+
+  uint32_t                               log2_num_lanes_{0};
+  std::unordered_map<Address, ShardKeys> keys_{};  ///< The sub-balance keys of each account by lane
+};
+
+using ShardedBalancesPtr = std::shared_ptr<ShardedBalances const>;
+
+}  // namespace chain
+}  // namespace fetch
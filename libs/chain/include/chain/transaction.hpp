@@ -26,6 +26,11 @@
 #include <vector>
 
 namespace fetch {
+namespace crypto {
+
+class VerifierCache;
+
+}  // namespace crypto
 namespace chain {
 
 /**
@@ -135,6 +140,7 @@ public:
   /// @name Validation / Verification
   /// @{
   bool Verify();
+  bool Verify(crypto::VerifierCache &verifiers);
   bool IsVerified() const;
   bool IsSignedByFromAddress() const;
   /// @}
@@ -0,0 +1,77 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "core/digest.hpp"
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace fetch {
+namespace chain {
+
+/**
+ * Index of transaction digests bucketed by the block index at which the transaction expires (its
+ * valid until block). It allows the pools of pending transactions to evict the transactions which
+ * can no longer be included in a block in time proportional to the number of expired
+ * transactions, rather than the size of the pool.
+ *
+ * Insertion and removal are O(log b) in the number of distinct expiry blocks b, which is bounded by
+ * the maximum validity period. The index is not thread safe, owners are expected to guard it with
+ * the same lock as the pool that it indexes.
+ */
+class TransactionExpiryIndex
+{
+public:
+  using BlockIndex = Transaction::BlockIndex;
+  using Digests    = std::vector<Digest>;
+
+  // Construction / Destruction
+  TransactionExpiryIndex()                               = default;
+  TransactionExpiryIndex(TransactionExpiryIndex const &) = delete;
+  TransactionExpiryIndex(TransactionExpiryIndex &&)      = default;
+  ~TransactionExpiryIndex()                              = default;
+
+  /// @name Accessors
+  /// @{
+  std::size_t size() const;
+  bool        empty() const;
+  /// @}
+
+  /// @name Basic Operations
+  /// @{
+  bool    Add(Digest const &digest, BlockIndex valid_until);
+  bool    Remove(Digest const &digest, BlockIndex valid_until);
+  Digests RemoveExpired(BlockIndex block_index);
+  /// @}
+
+  // Operators
+  TransactionExpiryIndex &operator=(TransactionExpiryIndex const &) = delete;
+  TransactionExpiryIndex &operator=(TransactionExpiryIndex &&) = default;
+
+private:
+  using Buckets = std::map<BlockIndex, DigestSet>;
+
+  Buckets     buckets_{};  ///< The digests of the transactions by valid until block
+  std::size_t size_{0};
+};
+
+}  // namespace chain
+}  // namespace fetch
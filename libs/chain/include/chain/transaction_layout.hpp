@@ -24,6 +24,7 @@
 namespace fetch {
 namespace chain {
 
+class ShardedBalances;
 class Transaction;
 
 /**
@@ -42,6 +43,8 @@ public:
   // Construction / Destruction
   TransactionLayout() = default;
   TransactionLayout(Transaction const &tx, uint32_t log2_num_lanes);
+  TransactionLayout(Transaction const &tx, uint32_t log2_num_lanes,
+                    ShardedBalances const &sharded_balances);
   TransactionLayout(Digest digest, BitVector const &mask, TokenAmount charge_rate,
                     BlockIndex valid_from, BlockIndex valid_until);
   TransactionLayout(TransactionLayout const &) = default;
@@ -19,10 +19,13 @@
 
 #include "core/byte_array/byte_array.hpp"
 
+#include <cstdint>
+
 namespace fetch {
 namespace chain {
 
 class Transaction;
+class TransactionLayout;
 
 /**
  * The transaction serializer is one of the two methods for constructing a transaction object. This
@@ -56,6 +59,7 @@ public:
   /// @{
   bool Serialize(Transaction const &tx);
   bool Deserialize(Transaction &tx) const;
+  bool DeserializeLayout(TransactionLayout &layout, uint32_t log2_num_lanes) const;
 
   // Operators (throw on error)
   TransactionSerializer &operator<<(Transaction const &tx);
@@ -67,6 +71,8 @@ public:
   TransactionSerializer &operator=(TransactionSerializer &&) = delete;
 
 private:
+  bool DecodeTransaction(Transaction &tx, bool header_only) const;
+
   ConstByteArray serial_data_;
 };
 
@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/block_version.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+namespace fetch {
+namespace chain {
+namespace {
+
+// indexed by version, read while executing blocks and only written while configuring the network
+std::atomic<uint64_t> activation_heights[] = {
+    {0},                // INITIAL
+    {NEVER_ACTIVATED},  // EXACT_UINT256_ARITHMETIC
+    {NEVER_ACTIVATED},  // OBSERVED_LANE_PACKING
+};
+
+std::atomic<uint64_t> &ActivationHeight(BlockVersion version)
+{
+  auto const index = static_cast<std::size_t>(version);
+  if (index >= (sizeof(activation_heights) / sizeof(activation_heights[0])))
+  {
+    throw std::out_of_range("Unknown block version");
+  }
+
+  return activation_heights[index];
+}
+
+}  // namespace
+
+/**
+ * Get the height of the first block to which a version of the rules applies
+ *
+ * @param version The block version
+ * @return The block number, or NEVER_ACTIVATED if the version has not been scheduled
+ */
+uint64_t GetActivationHeight(BlockVersion version)
+{
+  return ActivationHeight(version).load();
+}
+
+/**
+ * Schedule a version of the rules, as part of configuring the network
+ *
+ * @param version The block version, which can not be the initial one
+ * @param block_number The height of the first block to which the version applies
+ */
+void SetActivationHeight(BlockVersion version, uint64_t block_number)
+{
+  if (BlockVersion::INITIAL == version)
+  {
+    throw std::logic_error("The initial block version always applies");
+  }
+
+  ActivationHeight(version).store(block_number);
+}
+
+/**
+ * Determine whether a version of the rules applies to a block
+ *
+ * @param version The block version
+ * @param block_number The height of the block
+ * @return true if the block is executed with the version, otherwise false
+ */
+bool IsActive(BlockVersion version, uint64_t block_number)
+{
+  return block_number >= GetActivationHeight(version);
+}
+
+}  // namespace chain
+}  // namespace fetch
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/sharded_balances.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace fetch {
+namespace chain {
+namespace {
+
+using byte_array::ConstByteArray;
+using storage::ResourceAddress;
+
+/**
+ * Find a key for every lane, the key of a lane being the first of a fixed sequence of keys for the
+ * account which maps onto it
+ */
+std::vector<ConstByteArray> CreateShardKeys(Address const &address, uint32_t log2_num_lanes)
+{
+  std::size_t const num_lanes = std::size_t{1} << log2_num_lanes;
+
+  std::vector<ConstByteArray> keys(num_lanes);
+  std::size_t                 remaining = num_lanes;
+
+  for (uint64_t index = 0; remaining != 0; ++index)
+  {
+    ConstByteArray key{address.display() + ".shard." + std::to_string(index)};
+
+    auto const lane = ResourceAddress{"fetch.token.state." + key}.lane(log2_num_lanes);
+    if (keys[lane].empty())
+    {
+      keys[lane] = key;
+      --remaining;
+    }
+  }
+
+  return keys;
+}
+
+}  // namespace
+
+/**
+ * Build the set of accounts with sharded balances
+ *
+ * @param accounts The accounts whose balances are sharded
+ * @param log2_num_lanes The log2 of the number of lanes the balances are sharded over
+ */
+ShardedBalances::ShardedBalances(Addresses const &accounts, uint32_t log2_num_lanes)
+  : log2_num_lanes_{log2_num_lanes}
+{
+  for (auto const &address : accounts)
+  {
+    keys_.emplace(address, CreateShardKeys(address, log2_num_lanes));
+  }
+}
+
+/**
+ * Determine if the balance of an account is sharded
+ *
+ * @param address The address of the account
+ * @return true if the balance is sharded, otherwise false
+ */
+bool ShardedBalances::Contains(Address const &address) const
+{
+  return keys_.find(address) != keys_.end();
+}
+
+uint32_t ShardedBalances::log2_num_lanes() const
+{
+  return log2_num_lanes_;
+}
+
+/**
+ * Get the token state key of the sub-balance of an account on a lane
+ *
+ * @param address The address of the account
+ * @param lane The lane of the sub-balance
+ * @return The key of the sub-balance
+ */
+ConstByteArray ShardedBalances::GetShardKey(Address const &address, uint32_t lane) const
+{
+  auto const it = keys_.find(address);
+  if ((it == keys_.end()) || (lane >= it->second.size()))
+  {
+    throw std::out_of_range("No sub-balance for the account on this lane");
+  }
+
+  return it->second[lane];
+}
+
+}  // namespace chain
+}  // namespace fetch
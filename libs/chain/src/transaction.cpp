@@ -19,7 +19,7 @@
 #include "chain/transaction.hpp"
 #include "chain/transaction_serializer.hpp"
 #include "chain/transaction_validity_period.hpp"
-#include "crypto/verifier.hpp"
+#include "crypto/verifier_cache.hpp"
 
 #include <algorithm>
 #include <cassert>
@@ -47,9 +47,21 @@ uint64_t Transaction::GetTotalTransferAmount() const
 /**
  * Verify the contents of the transaction
  *
- * @return
+ * @return true if all the signatures are valid, otherwise false
  */
 bool Transaction::Verify()
+{
+  crypto::VerifierCache verifiers{};
+  return Verify(verifiers);
+}
+
+/**
+ * Verify the contents of the transaction, reusing any of the previously built verifiers
+ *
+ * @param verifiers The cache of verifiers to be used and populated
+ * @return true if all the signatures are valid, otherwise false
+ */
+bool Transaction::Verify(crypto::VerifierCache &verifiers)
 {
   if (!verification_completed_)
   {
@@ -67,7 +79,7 @@ bool Transaction::Verify()
       for (auto const &signatory : signatories_)
       {
         // verify the signature
-        if (!crypto::Verifier::Verify(signatory.identity, payload, signatory.signature))
+        if (!verifiers.Verify(signatory.identity, payload, signatory.signature))
         {
           // exit as soon as the first non valid signature is detected
           all_verified = false;
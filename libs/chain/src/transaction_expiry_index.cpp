@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_expiry_index.hpp"
+
+namespace fetch {
+namespace chain {
+
+/**
+ * Get the number of digests in the index
+ *
+ * @return The number of digests
+ */
+std::size_t TransactionExpiryIndex::size() const
+{
+  return size_;
+}
+
+/**
+ * Determine if the index is empty
+ *
+ * @return true if there are no digests in the index, otherwise false
+ */
+bool TransactionExpiryIndex::empty() const
+{
+  return size_ == 0;
+}
+
+/**
+ * Add a transaction to the index
+ *
+ * @param digest The digest of the transaction
+ * @param valid_until The block index from which the transaction is no longer valid
+ * @return true if the transaction was added, false if it was already present
+ */
+bool TransactionExpiryIndex::Add(Digest const &digest, BlockIndex valid_until)
+{
+  bool const added = buckets_[valid_until].emplace(digest).second;
+
+  if (added)
+  {
+    ++size_;
+  }
+
+  return added;
+}
+
+/**
+ * Remove a transaction from the index, for example once it has left the pool for another reason
+ *
+ * @param digest The digest of the transaction
+ * @param valid_until The block index with which the transaction was added
+ * @return true if the transaction was removed, otherwise false
+ */
+bool TransactionExpiryIndex::Remove(Digest const &digest, BlockIndex valid_until)
+{
+  auto it = buckets_.find(valid_until);
+  if ((it == buckets_.end()) || (it->second.erase(digest) == 0))
+  {
+    return false;
+  }
+
+  if (it->second.empty())
+  {
+    buckets_.erase(it);
+  }
+
+  --size_;
+
+  return true;
+}
+
+/**
+ * Remove all the transactions which are not valid at the specified block index, i.e. those whose
+ * valid until block is less than or equal to it
+ *
+ * @param block_index The block index being evaluated
+ * @return The digests of the expired transactions
+ */
+TransactionExpiryIndex::Digests TransactionExpiryIndex::RemoveExpired(BlockIndex block_index)
+{
+  Digests expired{};
+
+  auto const end = buckets_.upper_bound(block_index);
+  for (auto it = buckets_.begin(); it != end; ++it)
+  {
+    expired.insert(expired.end(), it->second.begin(), it->second.end());
+  }
+
+  buckets_.erase(buckets_.begin(), end);
+  size_ -= expired.size();
+
+  return expired;
+}
+
+}  // namespace chain
+}  // namespace fetch
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/sharded_balances.hpp"
 #include "chain/transaction.hpp"
 #include "chain/transaction_layout.hpp"
 #include "logging/logging.hpp"
@@ -50,8 +51,22 @@ void UpdateMaskWithTokenAddress(BitVector &shards, Address const &address, uint3
  * Construct a transaction layout from the specified transaction
  *
  * @param tx The input transaction to be summarized
+ * @param log2_num_lanes The log2 of the number of lanes
  */
 TransactionLayout::TransactionLayout(Transaction const &tx, uint32_t log2_num_lanes)
+  : TransactionLayout(tx, log2_num_lanes, ShardedBalances{})
+{}
+
+/**
+ * Construct a transaction layout from the specified transaction, for a network where the balances
+ * of some accounts are sharded over the lanes
+ *
+ * @param tx The input transaction to be summarized
+ * @param log2_num_lanes The log2 of the number of lanes
+ * @param sharded_balances The accounts with sharded balances
+ */
+TransactionLayout::TransactionLayout(Transaction const &tx, uint32_t log2_num_lanes,
+                                     ShardedBalances const &sharded_balances)
   : TransactionLayout(tx.digest(), BitVector{1u << log2_num_lanes}, tx.charge_rate(),
                       tx.valid_from(), tx.valid_until())
 {
@@ -66,14 +81,25 @@ TransactionLayout::TransactionLayout(Transaction const &tx, uint32_t log2_num_la
     }
   }
 
-  // Every shard mask needs to be updated with the from address so that fees can be removed
-  UpdateMaskWithTokenAddress(mask_, tx.from(), log2_num_lanes);
+  // Spending from a sharded balance needs all of its sub-balances, which are spread over every
+  // lane.
+  if (sharded_balances.Contains(tx.from()))
+  {
+    mask_.SetAllOne();
+  }
+  else
+  {
+    UpdateMaskWithTokenAddress(mask_, tx.from(), log2_num_lanes);
+  }
 
   // since the initial shard mask DOES NOT contain the shard information for the transfers these
-  // must now be added.
+  // must now be added. Sharded balances are credited on a lane which is already in use.
   for (auto const &transfer : tx.transfers())
   {
-    UpdateMaskWithTokenAddress(mask_, transfer.to, log2_num_lanes);
+    if (!sharded_balances.Contains(transfer.to))
+    {
+      UpdateMaskWithTokenAddress(mask_, transfer.to, log2_num_lanes);
+    }
   }
 }
 
@@ -18,6 +18,7 @@
 
 #include "chain/transaction.hpp"
 #include "chain/transaction_encoding.hpp"
+#include "chain/transaction_layout.hpp"
 #include "chain/transaction_serializer.hpp"
 #include "core/byte_array/byte_array.hpp"
 #include "core/serializers/main_serializer.hpp"
@@ -210,6 +211,31 @@ void Decode(MsgPackSerializer &buffer, Identity &identity)
   identity = Identity{std::move(public_key)};
 }
 
+void SkipBytes(MsgPackSerializer &buffer, std::size_t length)
+{
+  if (length > (buffer.size() - buffer.tell()))
+  {
+    throw std::runtime_error("Attempted read exceeds buffer size.");
+  }
+
+  buffer.SkipBytes(length);
+}
+
+void SkipByteArray(MsgPackSerializer &buffer)
+{
+  SkipBytes(buffer, Decode<std::size_t>(buffer));
+}
+
+void SkipIdentity(MsgPackSerializer &buffer)
+{
+  if (ReadSingleByte(buffer) != 0x04)
+  {
+    throw std::runtime_error("Unsupported signature scheme");
+  }
+
+  SkipBytes(buffer, 64u);
+}
+
 void DecodeFixed(MsgPackSerializer &buffer, uint64_t &value)
 {
   auto *raw = reinterpret_cast<uint8_t *>(&value);
@@ -224,6 +250,44 @@ void DecodeFixed(MsgPackSerializer &buffer, uint64_t &value)
   raw[0] = ReadSingleByte(buffer);
 }
 
+/**
+ * Compute an upper bound for the serial size of a transaction (including its signatures), so that
+ * the buffer can be allocated once before it is written
+ *
+ * @param tx The transaction to be serialized
+ * @return The maximum number of bytes the encoded transaction can occupy
+ */
+std::size_t MaximumSerialSize(Transaction const &tx)
+{
+  // integers are encoded as a single header byte followed by at most 8 bytes
+  static constexpr std::size_t MAX_INTEGER_SIZE = 9u;
+
+  // magic, headers and reserved byte, the validity period, charges, counter and signature count
+  std::size_t size = 4u + (5u * MAX_INTEGER_SIZE) + 8u + MAX_INTEGER_SIZE;
+
+  size += tx.from().address().size();
+
+  for (auto const &transfer : tx.transfers())
+  {
+    size += transfer.to.address().size() + MAX_INTEGER_SIZE;
+  }
+
+  if (ContractMode::NOT_PRESENT != tx.contract_mode())
+  {
+    size += 1u + (tx.shard_mask().size() >> 3u) + tx.contract_address().address().size() +
+            (3u * MAX_INTEGER_SIZE) + tx.chain_code().size() + tx.action().size() +
+            tx.data().size();
+  }
+
+  for (auto const &signatory : tx.signatories())
+  {
+    size += 1u + signatory.identity.identifier().size();
+    size += MAX_INTEGER_SIZE + signatory.signature.size();
+  }
+
+  return size;
+}
+
 }  // namespace
 
 TransactionSerializer::TransactionSerializer(ConstByteArray data)
@@ -237,13 +301,10 @@ ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
 
   auto const contract_mode = tx.contract_mode();
 
-  // make an estimate for the serial size of the transaction and reserve this amount of buffer
-  // space
-  std::size_t const estimated_transaction_size = (num_transfers * 64u) + (num_signatures * 128u) +
-                                                 tx.data().size() + tx.action().size() + 256u;
-
+  // reserve enough buffer space for the whole transaction, including the signatures appended by
+  // Serialize, so that the buffer is never reallocated while it is written
   ByteArray buffer;
-  buffer.Reserve(estimated_transaction_size);
+  buffer.Reserve(MaximumSerialSize(tx));
 
   // determine how to signal the number of signatures
   assert(num_signatures >= 1);
@@ -352,8 +413,9 @@ ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
       break;
     }
 
-    // add the action and data to the buffer
-    buffer.Append(Encode(tx.action()), Encode(tx.data()));
+    // add the action and data to the buffer, appending the contents directly rather than through
+    // an intermediate length prefixed copy
+    buffer.Append(Encode(tx.action().size()), tx.action(), Encode(tx.data().size()), tx.data());
   }
 
   buffer.Append(EncodeFixed(tx.counter()));
@@ -378,7 +440,7 @@ bool TransactionSerializer::Serialize(Transaction const &tx)
 
   for (auto const &signatory : tx.signatories())
   {
-    buffer.Append(Encode(signatory.signature));
+    buffer.Append(Encode(signatory.signature.size()), signatory.signature);
   }
 
   // update the serial data
@@ -389,7 +451,42 @@ bool TransactionSerializer::Serialize(Transaction const &tx)
 
 bool TransactionSerializer::Deserialize(Transaction &tx) const
 {
-  serializers::MsgPackSerializer buffer{serial_data_};
+  return DecodeTransaction(tx, false);
+}
+
+/**
+ * Decode only the parts of the transaction needed for its layout. The action, data, chain code,
+ * signatories and signatures are skipped over, which avoids the cost of deriving the address of
+ * every signatory. The digest is still computed over the whole payload.
+ *
+ * @param layout The layout to be populated
+ * @param log2_num_lanes The log2 of the number of lanes the layout is built for
+ * @return true if successful, otherwise false
+ */
+bool TransactionSerializer::DeserializeLayout(TransactionLayout &layout,
+                                              uint32_t           log2_num_lanes) const
+{
+  Transaction header{};
+  if (!DecodeTransaction(header, true))
+  {
+    return false;
+  }
+
+  layout = TransactionLayout{header, log2_num_lanes};
+
+  return true;
+}
+
+/**
+ * Decode the transaction from the serial data
+ *
+ * @param tx The transaction to be populated
+ * @param header_only Whether the variable length and signatory fields should be skipped
+ * @return true if successful, otherwise false
+ */
+bool TransactionSerializer::DecodeTransaction(Transaction &tx, bool header_only) const
+{
+  auto buffer = serializers::MsgPackSerializer::Borrow(serial_data_);
 
   std::size_t const payload_start = buffer.tell();
 
@@ -546,7 +643,14 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
       tx.contract_mode_    = Transaction::ContractMode::CHAIN_CODE;
       tx.contract_address_ = Address{};
 
-      Decode(buffer, tx.chain_code_);
+      if (header_only)
+      {
+        SkipByteArray(buffer);
+      }
+      else
+      {
+        Decode(buffer, tx.chain_code_);
+      }
     }
     else if (SYNERGETIC_PRESENT == contract_type)
     {
@@ -557,8 +661,16 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
     }
 
     // extract the data and actions
-    Decode(buffer, tx.action_);
-    Decode(buffer, tx.data_);
+    if (header_only)
+    {
+      SkipByteArray(buffer);
+      SkipByteArray(buffer);
+    }
+    else
+    {
+      Decode(buffer, tx.action_);
+      Decode(buffer, tx.data_);
+    }
   }
 
   // get the counter metadata
@@ -573,15 +685,25 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
 
   // clear and allocate the number of identities that are contained in this transaction
   tx.signatories_.clear();
-  tx.signatories_.resize(num_signatures);
-  for (std::size_t i = 0; i < num_signatures; ++i)
+  if (header_only)
   {
-    auto &current = tx.signatories_[i];
+    for (std::size_t i = 0; i < num_signatures; ++i)
+    {
+      SkipIdentity(buffer);
+    }
+  }
+  else
+  {
+    tx.signatories_.resize(num_signatures);
+    for (std::size_t i = 0; i < num_signatures; ++i)
+    {
+      auto &current = tx.signatories_[i];
 
-    Decode(buffer, current.identity);
+      Decode(buffer, current.identity);
 
-    // ensure address is kept in sync
-    current.address = Address{current.identity};
+      // ensure address is kept in sync
+      current.address = Address{current.identity};
+    }
   }
 
   // compute the payload position
@@ -591,9 +713,9 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
   crypto::SHA256 hash_function{};
   hash_function.Update(buffer.data().SubArray(payload_start, payload_size));
 
-  for (std::size_t i = 0; i < num_signatures; ++i)
+  for (auto &signatory : tx.signatories_)
   {
-    Decode(buffer, tx.signatories_[i].signature);
+    Decode(buffer, signatory.signature);
   }
 
   // compute the hash function
@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/block_version.hpp"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+namespace {
+
+using fetch::chain::BlockVersion;
+using fetch::chain::GetActivationHeight;
+using fetch::chain::IsActive;
+using fetch::chain::NEVER_ACTIVATED;
+using fetch::chain::SetActivationHeight;
+
+class BlockVersionTests : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    SetActivationHeight(BlockVersion::EXACT_UINT256_ARITHMETIC, NEVER_ACTIVATED);
+  }
+};
+
+TEST_F(BlockVersionTests, InitialVersionAlwaysApplies)
+{
+  EXPECT_EQ(0u, GetActivationHeight(BlockVersion::INITIAL));
+  EXPECT_TRUE(IsActive(BlockVersion::INITIAL, 0));
+  EXPECT_TRUE(IsActive(BlockVersion::INITIAL, NEVER_ACTIVATED));
+  EXPECT_THROW(SetActivationHeight(BlockVersion::INITIAL, 10), std::logic_error);
+}
+
+TEST_F(BlockVersionTests, VersionsAreNotActiveUntilScheduled)
+{
+  EXPECT_EQ(NEVER_ACTIVATED, GetActivationHeight(BlockVersion::EXACT_UINT256_ARITHMETIC));
+  EXPECT_FALSE(IsActive(BlockVersion::EXACT_UINT256_ARITHMETIC, 0));
+  EXPECT_FALSE(IsActive(BlockVersion::EXACT_UINT256_ARITHMETIC, 1000000));
+  EXPECT_EQ(NEVER_ACTIVATED, GetActivationHeight(BlockVersion::OBSERVED_LANE_PACKING));
+}
+
+TEST_F(BlockVersionTests, VersionsApplyFromTheirActivationHeight)
+{
+  SetActivationHeight(BlockVersion::EXACT_UINT256_ARITHMETIC, 100);
+
+  EXPECT_EQ(100u, GetActivationHeight(BlockVersion::EXACT_UINT256_ARITHMETIC));
+  EXPECT_FALSE(IsActive(BlockVersion::EXACT_UINT256_ARITHMETIC, 0));
+  EXPECT_FALSE(IsActive(BlockVersion::EXACT_UINT256_ARITHMETIC, 99));
+  EXPECT_TRUE(IsActive(BlockVersion::EXACT_UINT256_ARITHMETIC, 100));
+  EXPECT_TRUE(IsActive(BlockVersion::EXACT_UINT256_ARITHMETIC, 101));
+}
+
+TEST_F(BlockVersionTests, UnknownVersionsAreRejected)
+{
+  EXPECT_THROW(GetActivationHeight(static_cast<BlockVersion>(200)), std::out_of_range);
+}
+
+}  // namespace
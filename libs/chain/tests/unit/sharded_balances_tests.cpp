@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/sharded_balances.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "crypto/ecdsa.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::chain::Address;
+using fetch::chain::ShardedBalances;
+using fetch::chain::TransactionBuilder;
+using fetch::chain::TransactionLayout;
+using fetch::crypto::ECDSASigner;
+using fetch::storage::ResourceAddress;
+
+constexpr uint32_t LOG2_NUM_LANES = 2;
+constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+
+uint32_t TokenLane(std::string const &key)
+{
+  return ResourceAddress{"fetch.token.state." + key}.lane(LOG2_NUM_LANES);
+}
+
+class ShardedBalancesTests : public ::testing::Test
+{
+protected:
+  ECDSASigner     signer_{};
+  Address         sender_{signer_.identity()};
+  Address         hot_{ECDSASigner{}.identity()};
+  ShardedBalances sharded_balances_{{hot_}, LOG2_NUM_LANES};
+};
+
+TEST_F(ShardedBalancesTests, ShardKeysMapOntoTheirLanes)
+{
+  for (uint32_t lane = 0; lane < NUM_LANES; ++lane)
+  {
+    auto const key = static_cast<std::string>(sharded_balances_.GetShardKey(hot_, lane));
+
+    EXPECT_EQ(lane, TokenLane(key));
+    EXPECT_NE(static_cast<std::string>(hot_.display()), key);
+  }
+
+  EXPECT_THROW(sharded_balances_.GetShardKey(hot_, NUM_LANES), std::out_of_range);
+  EXPECT_THROW(sharded_balances_.GetShardKey(sender_, 0), std::out_of_range);
+}
+
+TEST_F(ShardedBalancesTests, TransfersToShardedBalancesOnlyUseTheSenderLane)
+{
+  auto const tx = TransactionBuilder()
+                      .From(sender_)
+                      .Transfer(hot_, 100)
+                      .ValidUntil(100)
+                      .ChargeLimit(10)
+                      .Signer(signer_.identity())
+                      .Seal()
+                      .Sign(signer_)
+                      .Build();
+
+  TransactionLayout const layout{*tx, LOG2_NUM_LANES, sharded_balances_};
+
+  BitVector expected{NUM_LANES};
+  expected.set(TokenLane(static_cast<std::string>(sender_.display())), 1);
+
+  EXPECT_EQ(expected, layout.mask());
+
+  // without the sharded accounts the lane of the main balance is needed as well
+  TransactionLayout const unsharded{*tx, LOG2_NUM_LANES};
+
+  expected.set(TokenLane(static_cast<std::string>(hot_.display())), 1);
+
+  EXPECT_EQ(expected, unsharded.mask());
+}
+
+TEST_F(ShardedBalancesTests, SpendingFromShardedBalancesUsesEveryLane)
+{
+  ECDSASigner           hot_signer{};
+  ShardedBalances const sharded_balances{{Address{hot_signer.identity()}}, LOG2_NUM_LANES};
+
+  auto const tx = TransactionBuilder()
+                      .From(Address{hot_signer.identity()})
+                      .Transfer(sender_, 100)
+                      .ValidUntil(100)
+                      .ChargeLimit(10)
+                      .Signer(hot_signer.identity())
+                      .Seal()
+                      .Sign(hot_signer)
+                      .Build();
+
+  TransactionLayout const layout{*tx, LOG2_NUM_LANES, sharded_balances};
+
+  EXPECT_EQ(NUM_LANES, layout.mask().PopCount());
+}
+
+}  // namespace
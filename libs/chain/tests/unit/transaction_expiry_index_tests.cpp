@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_expiry_index.hpp"
+#include "core/digest.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using fetch::Digest;
+using fetch::chain::TransactionExpiryIndex;
+
+Digest MakeDigest(uint8_t value)
+{
+  return Digest{std::string(32, static_cast<char>(value))};
+}
+
+bool Contains(TransactionExpiryIndex::Digests const &digests, Digest const &digest)
+{
+  return std::find(digests.begin(), digests.end(), digest) != digests.end();
+}
+
+TEST(TransactionExpiryIndexTests, CheckAddAndRemove)
+{
+  TransactionExpiryIndex index{};
+  EXPECT_TRUE(index.empty());
+
+  EXPECT_TRUE(index.Add(MakeDigest(1), 10));
+  EXPECT_TRUE(index.Add(MakeDigest(2), 10));
+  EXPECT_FALSE(index.Add(MakeDigest(2), 10));
+  EXPECT_EQ(index.size(), 2u);
+
+  // the digest must be removed with the block it was added with
+  EXPECT_FALSE(index.Remove(MakeDigest(1), 11));
+  EXPECT_TRUE(index.Remove(MakeDigest(1), 10));
+  EXPECT_FALSE(index.Remove(MakeDigest(1), 10));
+  EXPECT_EQ(index.size(), 1u);
+}
+
+TEST(TransactionExpiryIndexTests, CheckRemoveExpired)
+{
+  TransactionExpiryIndex index{};
+  index.Add(MakeDigest(1), 10);
+  index.Add(MakeDigest(2), 12);
+  index.Add(MakeDigest(3), 11);
+  index.Add(MakeDigest(4), 15);
+  index.Remove(MakeDigest(3), 11);
+
+  EXPECT_TRUE(index.RemoveExpired(9).empty());
+
+  auto const first = index.RemoveExpired(12);
+  ASSERT_EQ(first.size(), 2u);
+  EXPECT_TRUE(Contains(first, MakeDigest(1)));
+  EXPECT_TRUE(Contains(first, MakeDigest(2)));
+  EXPECT_EQ(index.size(), 1u);
+
+  // expired digests are only reported once
+  EXPECT_TRUE(index.RemoveExpired(12).empty());
+
+  auto const second = index.RemoveExpired(100);
+  ASSERT_EQ(second.size(), 1u);
+  EXPECT_EQ(second.front(), MakeDigest(4));
+  EXPECT_TRUE(index.empty());
+}
+
+}  // namespace
@@ -19,6 +19,7 @@
 #include "chain/address.hpp"
 #include "chain/transaction.hpp"
 #include "chain/transaction_builder.hpp"
+#include "chain/transaction_layout.hpp"
 #include "chain/transaction_serializer.hpp"
 #include "core/byte_array/decoders.hpp"
 #include "core/byte_array/encoders.hpp"
@@ -41,6 +42,7 @@ using fetch::crypto::ECDSAVerifier;
 using fetch::chain::Address;
 using fetch::chain::Transaction;
 using fetch::chain::TransactionBuilder;
+using fetch::chain::TransactionLayout;
 using fetch::chain::TransactionSerializer;
 using fetch::BitVector;
 
@@ -1058,4 +1060,72 @@ TEST_F(TransactionSerializerTests, ContractWithLargeShardMask)
   EnsureAreSame(output, *tx);
 }
 
+TEST_F(TransactionSerializerTests, LayoutFromPartialDecode)
+{
+  BitVector shard_mask{4};
+  shard_mask.set(2, 1);
+
+  // build a multi signature transaction with transfers and a contract call
+  auto tx = TransactionBuilder()
+                .From(addresses_[0])
+                .Transfer(addresses_[1], 10)
+                .Transfer(addresses_[2], 20)
+                .Signer(signers_[0]->identity())
+                .Signer(signers_[1]->identity())
+                .ChargeRate(1000)
+                .ChargeLimit(1000000)
+                .ValidFrom(100)
+                .ValidUntil(200)
+                .TargetChainCode("foo.bar.baz", shard_mask)
+                .Action("launch")
+                .Data("go")
+                .Seal()
+                .Sign(*signers_[0])
+                .Sign(*signers_[1])
+                .Build();
+
+  TransactionSerializer serializer;
+  serializer << *tx;
+
+  for (uint32_t log2_num_lanes = 0; log2_num_lanes < 4; ++log2_num_lanes)
+  {
+    TransactionLayout const expected{*tx, log2_num_lanes};
+
+    TransactionLayout layout{};
+    ASSERT_TRUE(serializer.DeserializeLayout(layout, log2_num_lanes));
+
+    EXPECT_EQ(expected.digest(), layout.digest());
+    EXPECT_EQ(expected.mask(), layout.mask());
+    EXPECT_EQ(expected.charge_rate(), layout.charge_rate());
+    EXPECT_EQ(expected.valid_from(), layout.valid_from());
+    EXPECT_EQ(expected.valid_until(), layout.valid_until());
+  }
+}
+
+TEST_F(TransactionSerializerTests, LayoutFromTruncatedTransaction)
+{
+  auto tx = TransactionBuilder()
+                .From(addresses_[0])
+                .Signer(signers_[0]->identity())
+                .ChargeRate(1000)
+                .ChargeLimit(1000000)
+                .TargetSmartContract(addresses_[4], BitVector{})
+                .Action("launch")
+                .Data("go")
+                .Seal()
+                .Sign(*signers_[0])
+                .Build();
+
+  TransactionSerializer serializer;
+  serializer << *tx;
+
+  // cut the encoding off inside the identity of the signatory
+  auto const truncated = serializer.data().SubArray(0, serializer.data().size() - 100);
+
+  TransactionSerializer partial{truncated};
+
+  TransactionLayout layout{};
+  EXPECT_THROW(partial.DeserializeLayout(layout, 2), std::runtime_error);
+}
+
 }  // namespace
@@ -18,10 +18,12 @@
 //------------------------------------------------------------------------------
 
 #include "core/feature_flags.hpp"
+#include "core/memory_monitor.hpp"
 #include "core/reactor.hpp"
 #include "entropy/entropy_generator_interface.hpp"
 #include "http/module.hpp"
 #include "http/server.hpp"
+#include "ledger/admission_controller.hpp"
 #include "ledger/block_sink_interface.hpp"
 #include "ledger/chain/block_coordinator.hpp"
 #include "ledger/chain/consensus/consensus_miner_interface.hpp"
@@ -37,6 +39,7 @@
 #include "ledger/storage_unit/lane_remote_control.hpp"
 #include "ledger/storage_unit/storage_unit_bundled_service.hpp"
 #include "ledger/storage_unit/storage_unit_client.hpp"
+#include "ledger/transaction_pre_executor.hpp"
 #include "ledger/transaction_processor.hpp"
 #include "ledger/transaction_status_cache.hpp"
 #include "messenger/messenger_api.hpp"
@@ -93,6 +96,9 @@ public:
     uint32_t       num_slices{0};
     uint32_t       num_executors{0};
     std::string    db_prefix{};
+    std::size_t    block_cache_size{0};
+    std::size_t    chain_memory_limit{0};  ///< Zero for no limit
+    std::size_t    mem_pool_limit{0};      ///< Zero for no limit
     uint32_t       processor_threads{0};
     uint32_t       verification_threads{0};
     uint32_t       max_peers{0};
@@ -159,6 +165,8 @@ private:
   using HttpModules              = std::vector<HttpModulePtr>;
   using TransactionProcessor     = ledger::TransactionProcessor;
   using TransactionProcessorPtr  = std::unique_ptr<ledger::TransactionProcessor>;
+  using AdmissionControllerPtr   = std::unique_ptr<ledger::AdmissionController>;
+  using TxPreExecutorPtr         = std::unique_ptr<ledger::TransactionPreExecutor>;
   using TrustSystem              = p2p::P2PTrustBayRank<muddle::Address>;
   using DAGPtr                   = std::shared_ptr<ledger::DAGInterface>;
   using DAGServicePtr            = std::shared_ptr<ledger::DAGService>;
@@ -173,6 +181,7 @@ private:
   using ShardConfigs             = ledger::ShardConfigs;
   using TxStatusCache            = ledger::TransactionStatusCache;
   using TxStatusCachePtr         = std::shared_ptr<TxStatusCache>;
+  using MemoryMonitorPtr         = std::shared_ptr<core::MemoryMonitor>;
 
   using OpenAPIHttpModulePtr     = std::shared_ptr<OpenAPIHttpModule>;
   using HealthCheckHttpModulePtr = std::shared_ptr<HealthCheckHttpModule>;
@@ -192,6 +201,7 @@ private:
   bool StartInternalMuddle();
   bool GenesisSanityChecks(ledger::GenesisFileCreator::Result genesis_status);
   bool CheckStateIntegrity();
+  bool RestoreStateSnapshot();
   /// @}
 
   /// @name Configuration
@@ -219,11 +229,14 @@ private:
 
   /// @name Transaction and State Database shards
   /// @{
-  TxStatusCachePtr     tx_status_cache_;  ///< Cache of transaction status
-  LaneServices         lane_services_;    ///< The lane services
-  StorageUnitClientPtr storage_;          ///< The storage client to the lane services
-  LaneRemoteControlPtr lane_control_;     ///< The lane control client for the lane services
-  ShardMgmtServicePtr  shard_management_;
+  TxStatusCachePtr          tx_status_cache_;   ///< Cache of transaction status
+  LaneServices              lane_services_;     ///< The lane services
+  StorageUnitClientPtr      storage_;           ///< The storage client to the lane services
+  LaneRemoteControlPtr      lane_control_;      ///< The lane control client for the lane services
+  ShardMgmtServicePtr       shard_management_;
+  chain::ShardedBalancesPtr sharded_balances_;  ///< The accounts with sharded balances
+
+  bool snapshot_pending_{false};  ///< The state is to be restored from a snapshot of the peers
 
   DAGPtr             dag_;
   DAGServicePtr      dag_service_;
@@ -249,6 +262,7 @@ private:
   MainChainPtr             chain_;              ///< The main block chain component
   BlockPackingAlgorithmPtr block_packer_;       ///< The block packing / mining algorithm
   BlockCoordinatorPtr      block_coordinator_;  ///< The block execution coordinator
+  TxPreExecutorPtr         tx_pre_executor_;    ///< Observes the lanes used by pending txs
   /// @}
 
   /// @name Top Level Services
@@ -256,6 +270,7 @@ private:
   MainChainRpcClientPtr   main_chain_rpc_client_;
   MainChainRpcServicePtr  main_chain_service_;  ///< Service for block transmission over the network
   TransactionProcessorPtr tx_processor_;        ///< The transaction entrypoint
+  AdmissionControllerPtr  admission_;           ///< Sheds submitted transactions under load
   /// @}
 
   /// @name Agent support
@@ -276,6 +291,7 @@ private:
   /// @name Telemetry
   /// @{
   telemetry::CounterPtr uptime_;
+  MemoryMonitorPtr      memory_monitor_;  ///< Accounts for (and trims) the memory of subsystems
   /// @}
 };
 
@@ -0,0 +1,105 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "http/json_response.hpp"
+#include "http/module.hpp"
+#include "telemetry/sampling_profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+namespace fetch {
+
+/**
+ * On demand profiling of the running node. Each request samples the process for a number of
+ * seconds, holding its HTTP worker for the duration, and returns the profile in the pprof format.
+ */
+class ProfilingHttpModule : public http::HTTPModule
+{
+public:
+  using Profiler = telemetry::SamplingProfiler;
+
+  static constexpr int64_t DEFAULT_SECONDS      = 10;
+  static constexpr int64_t MAX_SECONDS          = 60;
+  static constexpr int64_t DEFAULT_FREQUENCY_HZ = 100;
+  static constexpr int64_t MAX_FREQUENCY_HZ     = 1000;
+  static constexpr int64_t DEFAULT_SAMPLE_BYTES = 512 * 1024;
+
+  ProfilingHttpModule()
+  {
+    Get("/api/profile/cpu",
+        "Samples the CPU usage of all threads (?seconds=10&hz=100) and returns a pprof profile.",
+        [](http::ViewParameters const &, http::HTTPRequest const &request) {
+          auto const hz = Parameter(request, "hz", DEFAULT_FREQUENCY_HZ, MAX_FREQUENCY_HZ);
+
+          return Run(request, [hz]() {
+            return Profiler::Instance().StartCpu(std::chrono::microseconds{1000000 / hz});
+          });
+        });
+
+    Get("/api/profile/allocations",
+        "Samples the allocations of all threads (?seconds=10&bytes=524288) and returns a pprof "
+        "profile.",
+        [](http::ViewParameters const &, http::HTTPRequest const &request) {
+          auto const bytes = Parameter(request, "bytes", DEFAULT_SAMPLE_BYTES,
+                                       std::numeric_limits<int64_t>::max());
+
+          return Run(request, [bytes]() {
+            return Profiler::Instance().StartAllocations(static_cast<std::size_t>(bytes));
+          });
+        });
+  }
+
+private:
+  static int64_t Parameter(http::HTTPRequest const &request, byte_array::ConstByteArray const &name,
+                           int64_t default_value, int64_t max_value)
+  {
+    int64_t value = default_value;
+    if (request.query().Has(name))
+    {
+      value = request.query()[name].AsInt();
+    }
+
+    return std::min(std::max(value, int64_t{1}), max_value);
+  }
+
+  template <typename Start>
+  static http::HTTPResponse Run(http::HTTPRequest const &request, Start const &start)
+  {
+    static auto const BIN_MIME_TYPE = http::mime_types::GetMimeTypeFromExtension(".bin");
+
+    auto const seconds = Parameter(request, "seconds", DEFAULT_SECONDS, MAX_SECONDS);
+
+    if (!start())
+    {
+      return http::CreateJsonResponse(R"({"error": "A profile is already being collected"})",
+                                      http::Status::CLIENT_ERROR_CONFLICT);
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds{seconds});
+
+    return http::HTTPResponse(Profiler::Instance().Stop().ToPprof(), BIN_MIME_TYPE);
+  }
+};
+
+}  // namespace fetch
@@ -17,12 +17,20 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/byte_array/decoders.hpp"
 #include "http/json_response.hpp"
 #include "http/module.hpp"
+#include "ledger/chaincode/contract_profiler.hpp"
+#include "ledger/transaction_tracer.hpp"
 #include "logging/logging.hpp"
 #include "telemetry/registry.hpp"
+#include "variant/variant.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <sstream>
+#include <vector>
 
 namespace fetch {
 
@@ -41,6 +49,86 @@ public:
 
           return http::HTTPResponse(stream.str(), TXT_MIME_TYPE);
         });
+
+    Get("/api/telemetry/contracts", "Sampled smart contract call stacks (folded stacks format).",
+        [](http::ViewParameters const &, http::HTTPRequest const &) {
+          static auto const TXT_MIME_TYPE = http::mime_types::GetMimeTypeFromExtension(".txt");
+
+          // the stacks are only populated when contract profiling is enabled
+          std::ostringstream stream;
+          ledger::ContractProfiler::Instance().WriteFoldedStacks(stream);
+
+          return http::HTTPResponse(stream.str(), TXT_MIME_TYPE);
+        });
+
+    Get("/api/telemetry/transactions", "Recently traced transactions and their pipeline stages.",
+        [](http::ViewParameters const &, http::HTTPRequest const &) {
+          // the traces are only populated when transaction tracing is enabled
+          return http::CreateJsonResponse(
+              ToVariant(ledger::TransactionTracer::Instance().Recent()));
+        });
+
+    Get("/api/telemetry/transactions/(digest=[a-fA-F0-9]{64})",
+        "The pipeline stages of a traced transaction.",
+        {
+            {"digest", "The transaction hash.", http::validators::StringValue()},
+        },
+        [](http::ViewParameters const &params, http::HTTPRequest const &) {
+          auto const digest = byte_array::FromHex(params["digest"]);
+
+          return http::CreateJsonResponse(
+              ToVariant(ledger::TransactionTracer::Instance().Lookup(digest)));
+        });
+  }
+
+private:
+  using TraceEvents = ledger::TransactionTracer::Events;
+
+  /**
+   * Group the traced events by transaction, with the time of each stage in microseconds since the
+   * first traced stage of the transaction
+   */
+  static variant::Variant ToVariant(TraceEvents const &events)
+  {
+    std::vector<TraceEvents> traces{};
+    for (auto const &event : events)
+    {
+      auto it = std::find_if(traces.begin(), traces.end(), [&event](TraceEvents const &trace) {
+        return trace.front().digest == event.digest;
+      });
+
+      if (it == traces.end())
+      {
+        traces.emplace_back(TraceEvents{event});
+      }
+      else
+      {
+        it->push_back(event);
+      }
+    }
+
+    auto output = variant::Variant::Array(traces.size());
+    for (std::size_t i = 0; i < traces.size(); ++i)
+    {
+      auto const &trace  = traces[i];
+      auto        stages = variant::Variant::Array(trace.size());
+
+      for (std::size_t j = 0; j < trace.size(); ++j)
+      {
+        auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            trace[j].timestamp - trace.front().timestamp);
+
+        stages[j]          = variant::Variant::Object();
+        stages[j]["stage"] = ledger::ToString(trace[j].stage);
+        stages[j]["us"]    = static_cast<uint64_t>(elapsed.count());
+      }
+
+      output[i]           = variant::Variant::Object();
+      output[i]["tx"]     = trace.front().digest.ToHex();
+      output[i]["stages"] = stages;
+    }
+
+    return output;
   }
 };
 
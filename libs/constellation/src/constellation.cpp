@@ -22,15 +22,21 @@
 #include "beacon/beacon_setup_service.hpp"
 #include "beacon/event_manager.hpp"
 #include "bloom_filter/bloom_filter.hpp"
+#include "chain/constants.hpp"
+#include "chain/sharded_balances.hpp"
 #include "constellation/health_check_http_module.hpp"
 #include "constellation/logging_http_module.hpp"
 #include "constellation/muddle_status_http_module.hpp"
 #include "constellation/open_api_http_module.hpp"
+#include "constellation/profiling_http_module.hpp"
 #include "constellation/telemetry_http_module.hpp"
+#include "core/cpu_topology.hpp"
 #include "http/middleware/allow_origin.hpp"
 #include "http/middleware/telemetry.hpp"
 #include "ledger/chaincode/contract_context.hpp"
 #include "ledger/chaincode/contract_http_interface.hpp"
+#include "ledger/chaincode/contract_profiler.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
 #include "ledger/consensus/consensus.hpp"
 #include "ledger/consensus/simulated_pow_consensus.hpp"
 #include "ledger/consensus/stake_snapshot.hpp"
@@ -38,6 +44,7 @@
 #include "ledger/execution_manager.hpp"
 #include "ledger/protocols/main_chain_rpc_service.hpp"
 #include "ledger/storage_unit/lane_remote_control.hpp"
+#include "ledger/transaction_tracer.hpp"
 #include "ledger/tx_query_http_interface.hpp"
 #include "ledger/tx_status_http_interface.hpp"
 #include "ledger/upow/synergetic_execution_manager.hpp"
@@ -48,6 +55,7 @@
 #include "network/p2pservice/p2p_http_interface.hpp"
 #include "network/uri.hpp"
 #include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
 #include "telemetry/registry.hpp"
 
 #include <chrono>
@@ -57,6 +65,7 @@
 #include <stdexcept>
 #include <thread>
 #include <utility>
+#include <vector>
 
 using fetch::chain::Address;
 using fetch::ledger::Executor;
@@ -91,6 +100,25 @@ constexpr char const *LOGGING_NAME = "constellation";
 const std::size_t HTTP_THREADS{4};
 char const *      GENESIS_FILENAME = "genesis_file.json";
 
+// the number of workers evaluating http requests, and how many may serve queries and long polls
+const std::size_t HTTP_WORKERS{8};
+const std::size_t HTTP_QUERY_CONCURRENCY{4};
+const std::size_t HTTP_WAIT_CONCURRENCY{2};
+
+// the number of commits retained in the state history when compaction is enabled
+const uint64_t STATE_HISTORY_DEPTH{500};
+
+// one in this many transactions is traced through the pipeline when tracing is enabled
+const uint32_t TX_TRACING_SAMPLE_INTERVAL{1024};
+
+// the miner backlog at which the transaction ingress is considered to be fully loaded
+const uint64_t MAX_MINER_BACKLOG{1000000};
+
+// state snapshot download (see Constellation::RestoreStateSnapshot)
+const std::size_t          SNAPSHOT_ATTEMPTS{3};
+const std::size_t          SNAPSHOT_SEARCH_DEPTH{1000};
+const std::chrono::seconds SNAPSHOT_MAX_WAIT{300};
+
 class Defer
 {
 public:
@@ -111,6 +139,44 @@ private:
   Callback const       callback_;
 };
 
+/**
+ * Records how long a phase of the node start up took, building up the start up timeline in
+ * telemetry (ledger_startup_phase_duration_ms, labelled by phase)
+ */
+class StartupPhase
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit StartupPhase(char const *phase)
+    : phase_{phase}
+    , duration_ms_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
+          "ledger_startup_phase_duration_ms", "The time taken by each phase of the node start up",
+          {{"phase", phase}})}
+  {}
+
+  StartupPhase(StartupPhase const &) = delete;
+  StartupPhase &operator=(StartupPhase const &) = delete;
+
+  ~StartupPhase()
+  {
+    auto const duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - started_);
+
+    if (duration_ms_)
+    {
+      duration_ms_->set(static_cast<uint64_t>(duration.count()));
+    }
+
+    FETCH_LOG_INFO(LOGGING_NAME, "Start up phase ", phase_, " took ", duration.count(), "ms");
+  }
+
+private:
+  char const *const                   phase_;
+  telemetry::GaugePtr<uint64_t> const duration_ms_;
+  Clock::time_point const             started_{Clock::now()};
+};
+
 char const *ToString(ledger::MainChainRpcService::Mode mode)
 {
   char const *text = "Unknown";
@@ -200,6 +266,9 @@ ledger::ShardConfigs GenerateShardsConfig(Config &cfg, uint16_t start_port)
 {
   ledger::ShardConfigs configs(cfg.num_lanes());
 
+  bool const              numa_placement = cfg.features.IsEnabled("numa_placement");
+  core::CpuTopology const topology       = core::CpuTopology::Discover();
+
   for (uint32_t i = 0; i < cfg.num_lanes(); ++i)
   {
     // look up the service in the provided manifest
@@ -221,11 +290,21 @@ ledger::ShardConfigs GenerateShardsConfig(Config &cfg, uint16_t start_port)
     shard.external_port     = start_port++;
     shard.external_network_id =
         muddle::NetworkId{(static_cast<uint32_t>(i) & 0xFFFFFFu) | (uint32_t{'L'} << 24u)};
-    shard.internal_name        = it->second.uri().GetTcpPeer().address();
-    shard.internal_identity    = std::make_shared<crypto::ECDSASigner>();
-    shard.internal_port        = start_port++;
-    shard.internal_network_id  = muddle::NetworkId{"ISRD"};
-    shard.verification_threads = cfg.verification_threads;
+    shard.internal_name         = it->second.uri().GetTcpPeer().address();
+    shard.internal_identity     = std::make_shared<crypto::ECDSASigner>();
+    shard.internal_port         = start_port++;
+    shard.internal_network_id   = muddle::NetworkId{"ISRD"};
+    shard.verification_threads  = cfg.verification_threads;
+    shard.batched_state_writes  = cfg.features.IsEnabled("batched_state_writes");
+    shard.btree_state_index     = cfg.features.IsEnabled("btree_state_index");
+    shard.committed_state_reads = cfg.features.IsEnabled("committed_state_queries");
+    shard.state_history_depth =
+        cfg.features.IsEnabled("state_history_compaction") ? STATE_HISTORY_DEPTH : 0;
+
+    if (numa_placement)
+    {
+      shard.cpu_affinity = topology.NodeForLane(i).cpus;
+    }
 
     auto const ext_identity = shard.external_identity->identity().identifier();
     auto const int_identity = shard.internal_identity->identity().identifier();
@@ -437,22 +516,30 @@ bool Constellation::OnStartup()
 
 bool Constellation::OnBringUpLaneServices()
 {
+  StartupPhase const lane_services_phase{"lane_services"};
+
   // start the internal network manager
   network_manager_.Start();
 
   FETCH_LOG_INFO(LOGGING_NAME, "Starting shard services...");
 
   // configure all the lane services
-  lane_services_.Setup(network_manager_, shard_cfgs_);
+  {
+    StartupPhase const phase{"lane_setup"};
+    lane_services_.Setup(network_manager_, shard_cfgs_);
+  }
 
   // start all the lane services and wait for them to start accepting
   // connections
-  lane_services_.StartInternal();
-
-  if (!WaitForLaneServersToStart())
   {
-    FETCH_LOG_ERROR(LOGGING_NAME, "Unable to start lane server instances");
-    return false;
+    StartupPhase const phase{"lane_start"};
+    lane_services_.StartInternal();
+
+    if (!WaitForLaneServersToStart())
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Unable to start lane server instances");
+      return false;
+    }
   }
 
   FETCH_LOG_INFO(LOGGING_NAME, "Starting shard services...complete");
@@ -462,10 +549,14 @@ bool Constellation::OnBringUpLaneServices()
       muddle::CreateMuddle("ISRD", internal_identity_, network_manager_,
                            cfg_.manifest.FindExternalAddress(ServiceIdentifier::Type::CORE));
 
-  if (!StartInternalMuddle())
   {
-    FETCH_LOG_WARN(LOGGING_NAME, "Failed to establish internal muddle connection to lane services");
-    return false;
+    StartupPhase const phase{"lane_connect"};
+    if (!StartInternalMuddle())
+    {
+      FETCH_LOG_WARN(LOGGING_NAME,
+                     "Failed to establish internal muddle connection to lane services");
+      return false;
+    }
   }
 
   FETCH_LOG_INFO(LOGGING_NAME, "Inter-shard Identity: ", internal_muddle_->GetAddress().ToBase64());
@@ -501,16 +592,89 @@ bool Constellation::OnRestorePreviousData(ledger::GenesisFileCreator::ConsensusP
     }
   }
 
+  // the accounts with sharded balances are part of the genesis, so are the same on every node
+  sharded_balances_ = std::make_shared<chain::ShardedBalances>(params.sharded_balance_accounts,
+                                                               cfg_.log2_num_lanes);
+  lane_services_.SetShardedBalances(sharded_balances_);
+  if (!params.sharded_balance_accounts.empty())
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Sharding the balances of ",
+                   params.sharded_balance_accounts.size(), " accounts over the lanes");
+  }
+
   // create the DAG
   dag_ = GenerateDAG(cfg_, "dag_db_", true, external_identity_);
 
   // create the chain
-  chain_ = std::make_unique<MainChain>(ledger::MainChain::Mode::LOAD_PERSISTENT_DB, true);
+  chain_ = std::make_unique<MainChain>(ledger::MainChain::Mode::LOAD_PERSISTENT_DB, true,
+                                       cfg_.block_cache_size);
 
   // necessary when doing state validity checks
   execution_manager_ = std::make_shared<ExecutionManager>(
       cfg_.num_executors, cfg_.log2_num_lanes, storage_,
-      [this] { return std::make_shared<Executor>(storage_); }, tx_status_cache_);
+      [this](ExecutionManager::StorageUnitPtr storage) {
+        return std::make_shared<Executor>(std::move(storage), sharded_balances_);
+      },
+      tx_status_cache_);
+
+  if (cfg_.features.IsEnabled("numa_placement"))
+  {
+    // place each executor on the node of the lanes it serves
+    auto const topology = core::CpuTopology::Discover();
+
+    std::vector<core::CpuList> affinity{};
+    for (std::size_t i = 0; i < cfg_.num_executors; ++i)
+    {
+      affinity.emplace_back(topology.NodeForExecutor(i).cpus);
+    }
+
+    FETCH_LOG_INFO(LOGGING_NAME, "Placing lanes and executors over ", topology.num_nodes(),
+                   " NUMA node(s)");
+
+    execution_manager_->SetAffinity(std::move(affinity));
+  }
+
+  if (cfg_.features.IsEnabled("optimistic_execution"))
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Enabling optimistic block execution");
+
+    execution_manager_->EnableOptimisticExecution(
+        [this](ExecutionManager::StorageUnitPtr storage) {
+          return std::make_shared<Executor>(std::move(storage), sharded_balances_);
+        });
+  }
+
+  if (cfg_.features.IsEnabled("pre_execution"))
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Enabling pre-execution of pending transactions");
+
+    execution_manager_->EnablePreExecution([this](ExecutionManager::StorageUnitPtr storage) {
+      return std::make_shared<Executor>(std::move(storage), sharded_balances_);
+    });
+  }
+
+  if (cfg_.features.IsEnabled("contract_profiling"))
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Enabling smart contract profiling");
+
+    ledger::ContractProfiler::Instance().Enable(true);
+  }
+
+  if (cfg_.features.IsEnabled("tx_tracing"))
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Enabling sampled transaction tracing (1 in ",
+                   TX_TRACING_SAMPLE_INTERVAL, ")");
+
+    ledger::TransactionTracer::Instance().SetSampleInterval(TX_TRACING_SAMPLE_INTERVAL);
+  }
+
+  if (cfg_.features.IsEnabled("executable_store"))
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Enabling the persistent store of compiled smart contracts");
+
+    ledger::ExecutableCache::Instance().Load(cfg_.db_prefix + "executables.db",
+                                             cfg_.db_prefix + "executables.index.db");
+  }
 
   if (!GenesisSanityChecks(genesis_status))
   {
@@ -567,16 +731,46 @@ bool Constellation::OnBringUpExternalNetwork(
   consensus_->UpdateCurrentBlock(*chain_->CreateGenesisBlock());
 
   block_packer_ = std::make_unique<BlockPackingAlgorithm>(cfg_.log2_num_lanes);
+  block_packer_->SetShardedBalances(sharded_balances_);
 
   block_coordinator_ = std::make_unique<ledger::BlockCoordinator>(
       *chain_, dag_, *execution_manager_, *storage_, *block_packer_, *this, external_identity_,
       cfg_.log2_num_lanes, cfg_.num_slices, consensus_,
       std::make_unique<ledger::SynergeticExecutionManager>(
-          dag_, 1u, [this]() { return std::make_shared<ledger::SynergeticExecutor>(*storage_); }));
+          dag_, 1u, [this]() {
+            return std::make_shared<ledger::SynergeticExecutor>(
+                *storage_, sharded_balances_, cfg_.num_executors,
+                ledger::FeeManager::Settlement::PER_BLOCK);
+          }));
+  block_coordinator_->SetWakeCallback([this]() { reactor_.Wake(); });
 
   tx_processor_ = std::make_unique<ledger::TransactionProcessor>(
       dag_, *storage_, *block_packer_, tx_status_cache_, cfg_.processor_threads);
 
+  // submitted transactions are shed, lowest fees first, as the stages behind them fill up
+  admission_ = std::make_unique<ledger::AdmissionController>();
+  admission_->AddStage("verifier", [this]() {
+    return static_cast<double>(tx_processor_->GetBacklog()) /
+           static_cast<double>(ledger::TransactionVerifier::QUEUE_SIZE);
+  });
+  admission_->AddStage("miner", [this]() {
+    return static_cast<double>(block_packer_->GetBacklog()) /
+           static_cast<double>(MAX_MINER_BACKLOG);
+  });
+  if (cfg_.mem_pool_limit != 0)
+  {
+    admission_->AddStage("mem_pool", [this]() {
+      return static_cast<double>(lane_services_.GetMemPoolSizeInBytes()) /
+             static_cast<double>(cfg_.mem_pool_limit);
+    });
+  }
+
+  if (execution_manager_->IsPreExecutionEnabled())
+  {
+    tx_pre_executor_ =
+        std::make_unique<ledger::TransactionPreExecutor>(*block_packer_, *execution_manager_);
+  }
+
   agent_network_ = CreateMessengerNetwork(cfg_, external_identity_, network_manager_);
 
   mailbox_ = CreateMessengerMailbox(cfg_, agent_network_);
@@ -593,12 +787,14 @@ bool Constellation::OnBringUpExternalNetwork(
           p2p::P2PHttpInterface::WeakStateMachines{block_coordinator_->GetWeakStateMachine()}),
       std::make_shared<ledger::TxStatusHttpInterface>(tx_status_cache_),
       std::make_shared<ledger::TxQueryHttpInterface>(*storage_),
-      std::make_shared<ledger::ContractHttpInterface>(*storage_, *tx_processor_),
+      std::make_shared<ledger::ContractHttpInterface>(*storage_, *tx_processor_, admission_.get(),
+                                                      sharded_balances_),
       std::make_shared<LoggingHttpModule>(),
       std::make_shared<TelemetryHttpModule>(),
+      std::make_shared<ProfilingHttpModule>(),
       std::make_shared<MuddleStatusModule>()};
 
-  http_ = std::make_unique<HttpServer>(http_network_manager_);
+  http_ = std::make_unique<HttpServer>(http_network_manager_, HTTP_WORKERS);
   // Display "/"
   http_->AddDefaultRootModule();
 
@@ -656,11 +852,23 @@ bool Constellation::OnBringUpExternalNetwork(
   if (beacon_)
   {
     reactor_dkg_.Attach(beacon_setup_->GetWeakRunnables());
-    reactor_dkg_.Attach(beacon_->GetWeakRunnable());
+
+    // entropy generation is on the critical path of every block, never queue it behind the setup
+    reactor_dkg_.AttachDedicated(beacon_->GetWeakRunnable());
   }
 
+  // account for the memory of the largest subsystems, trimming them when over their limits
+  memory_monitor_ = std::make_shared<core::MemoryMonitor>();
+  memory_monitor_->AddSubsystem(
+      "main_chain", [this]() { return chain_->GetCacheSizeInBytes(); }, cfg_.chain_memory_limit,
+      [this]() { chain_->ReleaseCache(); });
+  memory_monitor_->AddSubsystem(
+      "mem_pool", [this]() { return lane_services_.GetMemPoolSizeInBytes(); }, cfg_.mem_pool_limit,
+      [this]() { lane_services_.SpillMemPools(cfg_.mem_pool_limit / 2); });
+
   // attach the services to the reactor
   reactor_.Attach(shard_management_);
+  reactor_.Attach(memory_monitor_);
 
   // configure the middleware of the http server
   http_->AddMiddleware(http::middleware::AllowOrigin("*"));
@@ -672,6 +880,14 @@ bool Constellation::OnBringUpExternalNetwork(
     http_->AddModule(*module);
   }
 
+  // contract queries can be expensive, they must not be able to occupy all of the http workers
+  http_->SetConcurrencyLimit(http::Method::POST, ledger::ContractHttpInterface::QUERY_PATH,
+                             HTTP_QUERY_CONCURRENCY);
+
+  // long polls occupy a worker for the duration of their wait
+  http_->SetConcurrencyLimit(http::Method::POST, ledger::TxStatusHttpInterface::WAIT_PATH,
+                             HTTP_WAIT_CONCURRENCY);
+
   http_open_api_module_->Reset(http_.get());
   network_manager_.Start();
   http_network_manager_.Start();
@@ -716,12 +932,30 @@ bool Constellation::OnBringUpExternalNetwork(
   execution_manager_->Start();
   tx_processor_->Start();
 
+  if (tx_pre_executor_)
+  {
+    tx_pre_executor_->Start();
+  }
+
   // create the main chain service (from this point it will be able to start accepting) external
   // requests
   main_chain_rpc_client_ = std::make_shared<ledger::MainChainRpcClient>(muddle_->GetEndpoint());
   main_chain_service_    = std::make_shared<MainChainRpcService>(
       muddle_->GetEndpoint(), *main_chain_rpc_client_, *chain_, trust_, consensus_);
 
+  // compact blocks from peers are rebuilt from the transactions already known to the miner
+  main_chain_service_->SetLayoutLookup(
+      [packer = block_packer_.get()](ledger::ShortTransactionId id,
+                                     chain::TransactionLayout &  layout) {
+        return packer->LookupTransaction(id, layout);
+      });
+
+  if (cfg_.features.IsEnabled("compact_blocks"))
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Enabling compact block relay");
+    main_chain_service_->EnableCompactRelay();
+  }
+
   // the health check module needs the latest chain service
   health_check_module_->UpdateChainService(*main_chain_service_);
 
@@ -733,9 +967,18 @@ bool Constellation::OnBringUpExternalNetwork(
   // Start the main syncing state machine for main chain service
   reactor_.Attach(main_chain_service_->GetWeakRunnable());
 
-  // The block coordinator needs to access correctly started lanes to recover state in the case of
-  // a crash.
-  reactor_.Attach(block_coordinator_->GetWeakRunnable());
+  // A new node can build its state from a snapshot of its peers' lanes instead of executing the
+  // whole of the chain. In this case the block coordinator is only started once the chain has been
+  // synchronised and the snapshot downloaded (see OnRunning)
+  snapshot_pending_ =
+      cfg_.features.IsEnabled("snapshot_sync") && chain_->GetHeaviestBlock()->IsGenesis();
+
+  if (!snapshot_pending_)
+  {
+    // The block coordinator needs to access correctly started lanes to recover state in the case
+    // of a crash.
+    reactor_.Attach(block_coordinator_->GetWeakRunnable());
+  }
 
   return true;
 }
@@ -744,9 +987,29 @@ bool Constellation::OnRunning(core::WeakRunnable const &bootstrap_monitor)
 {
   bool start_up_in_progress{true};
 
+  auto const snapshot_deadline = std::chrono::steady_clock::now() + SNAPSHOT_MAX_WAIT;
+
   // monitor loop
   while (active_)
   {
+    // once the chain (i.e. the headers) has been obtained the state snapshot can be verified
+    if (snapshot_pending_)
+    {
+      bool const chain_ready =
+          main_chain_service_->IsSynced() && !chain_->GetHeaviestBlock()->IsGenesis();
+
+      if (chain_ready || (std::chrono::steady_clock::now() >= snapshot_deadline))
+      {
+        if (!chain_ready || !RestoreStateSnapshot())
+        {
+          FETCH_LOG_WARN(LOGGING_NAME, "Unable to restore a state snapshot, executing the chain");
+        }
+
+        snapshot_pending_ = false;
+        reactor_.Attach(block_coordinator_->GetWeakRunnable());
+      }
+    }
+
     // determine the status of the main chain server
     bool const is_in_sync = main_chain_service_->IsSynced() && block_coordinator_->IsSynced();
 
@@ -796,6 +1059,11 @@ void Constellation::OnTearDownExternalNetwork()
   ResetItem(main_chain_service_);
   ResetItem(main_chain_rpc_client_);
 
+  if (tx_pre_executor_)
+  {
+    tx_pre_executor_->Stop();
+  }
+
   if (tx_processor_)
   {
     tx_processor_->Stop();
@@ -836,7 +1104,9 @@ void Constellation::OnTearDownExternalNetwork()
   ResetItem(messenger_api_);
   ResetItem(mailbox_);
   ResetItem(agent_network_);
+  ResetItem(admission_);
   ResetItem(tx_processor_);
+  ResetItem(tx_pre_executor_);
   ResetItem(block_coordinator_);
   ResetItem(block_packer_);
   ResetItem(execution_manager_);
@@ -846,6 +1116,7 @@ void Constellation::OnTearDownExternalNetwork()
   ResetItem(beacon_setup_);
   ResetItem(beacon_network_);
   ResetItem(shard_management_);
+  ResetItem(memory_monitor_);
   ResetItem(muddle_);
 }
 
@@ -888,6 +1159,8 @@ bool Constellation::StartInternalMuddle()
   // wait for all the connections to establish
   Timestamp const deadline = Clock::now() + std::chrono::seconds{30};
 
+  // the lanes are all connected to at once, so poll finely rather than adding up to a whole
+  // interval to every start up
   bool success{false};
   while (Clock::now() < deadline)
   {
@@ -898,7 +1171,7 @@ bool Constellation::StartInternalMuddle()
       break;
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
   }
 
   return success;
@@ -1025,6 +1298,83 @@ bool Constellation::CheckStateIntegrity()
   return true;
 }
 
+/**
+ * Replace the state of the lanes with snapshots downloaded from their peers. The combined state
+ * must match the merkle root of one of the recent blocks on the (synchronised) chain, in which
+ * case it is committed at the height of that block and the block coordinator will execute forward
+ * from there.
+ *
+ * @return true if successful, otherwise false
+ */
+bool Constellation::RestoreStateSnapshot()
+{
+  using SnapshotStatus = LaneRemoteControl::SnapshotStatus;
+
+  for (std::size_t attempt = 1; active_ && (attempt <= SNAPSHOT_ATTEMPTS); ++attempt)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Downloading state snapshot (attempt ", attempt, ")");
+
+    for (LaneIndex lane = 0; lane < cfg_.num_lanes(); ++lane)
+    {
+      lane_control_->BeginStateSnapshot(lane);
+    }
+
+    // wait for all of the lanes to complete
+    bool in_progress{true};
+    bool failed{false};
+    while (active_ && in_progress)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{500});
+
+      in_progress = false;
+      failed      = false;
+      for (LaneIndex lane = 0; lane < cfg_.num_lanes(); ++lane)
+      {
+        auto const status = lane_control_->GetStateSnapshotStatus(lane);
+
+        in_progress |= (SnapshotStatus::IN_PROGRESS == status);
+        failed |= (SnapshotStatus::COMPLETE != status);
+      }
+    }
+
+    if (failed)
+    {
+      continue;
+    }
+
+    // the lanes can be copied while their peers are at slightly different heights, so the
+    // combined state is only usable if it corresponds to a block on the chain
+    auto const state = storage_->CurrentHash();
+
+    auto block = chain_->GetHeaviestBlock();
+    for (std::size_t depth = 0; block && (depth < SNAPSHOT_SEARCH_DEPTH); ++depth)
+    {
+      if (block->merkle_hash == state)
+      {
+        storage_->Commit(block->block_number);
+
+        FETCH_LOG_INFO(LOGGING_NAME, "Restored state snapshot at block: ", block->block_number,
+                       " merkle hash: 0x", state.ToHex());
+        return true;
+      }
+
+      block = chain_->GetBlock(block->previous_hash);
+    }
+
+    FETCH_LOG_WARN(LOGGING_NAME, "State snapshot 0x", state.ToHex(),
+                   " does not match any recent block");
+  }
+
+  // the genesis state is kept in the history of the lanes, return to it so that the chain can be
+  // executed from the beginning
+  if (!storage_->RevertToHash(chain::GetGenesisMerkleRoot(), 0))
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Unable to revert to the genesis state");
+  }
+
+  return false;
+}
+
 void Constellation::SignalStop()
 {
   active_ = false;
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/random/lcg.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::random::LinearCongruentialGenerator;
+
+constexpr std::size_t NUM_MASKS = 256;
+
+/**
+ * Generate sparse lane masks, in the same way as those of transactions touching a few lanes
+ */
+std::vector<BitVector> GenerateMasks(std::size_t num_lanes)
+{
+  LinearCongruentialGenerator rng{};
+
+  std::vector<BitVector> masks(NUM_MASKS, BitVector{num_lanes});
+  for (auto &mask : masks)
+  {
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+      mask.set(rng() % num_lanes, 1);
+    }
+  }
+
+  return masks;
+}
+
+void BitVector_AndPopCount(benchmark::State &state)
+{
+  auto const masks = GenerateMasks(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    std::size_t conflicts{0};
+    for (std::size_t i = 1; i < NUM_MASKS; ++i)
+    {
+      if ((masks[i - 1] & masks[i]).PopCount() != 0)
+      {
+        ++conflicts;
+      }
+    }
+
+    benchmark::DoNotOptimize(conflicts);
+  }
+}
+
+void BitVector_Intersects(benchmark::State &state)
+{
+  auto const masks = GenerateMasks(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    std::size_t conflicts{0};
+    for (std::size_t i = 1; i < NUM_MASKS; ++i)
+    {
+      if (masks[i - 1].Intersects(masks[i]))
+      {
+        ++conflicts;
+      }
+    }
+
+    benchmark::DoNotOptimize(conflicts);
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BitVector_AndPopCount)->Arg(16)->Arg(256)->Arg(512);
+BENCHMARK(BitVector_Intersects)->Arg(16)->Arg(256)->Arg(512);
@@ -0,0 +1,214 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/containers/queue.hpp"
+#include "core/sync/tickets.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::core::MPMCQueue;
+using fetch::core::MPSCQueue;
+using fetch::core::Tickets;
+
+constexpr std::size_t QUEUE_SIZE     = 1u << 14u;
+constexpr std::size_t TOTAL_ELEMENTS = 1u << 18u;
+constexpr std::size_t BATCH_SIZE     = 64;
+
+using Element = std::shared_ptr<std::size_t>;
+
+/**
+ * Reference implementation of the previous queue: indices guarded by mutexes and counting
+ * semaphores built on a mutex and condition variable
+ */
+class LockingQueue
+{
+public:
+  void Push(Element element)
+  {
+    write_count_.Wait();
+
+    {
+      std::lock_guard<std::mutex> lock(write_mutex_);
+      queue_[write_index_++ & (QUEUE_SIZE - 1)] = std::move(element);
+    }
+
+    read_count_.Post();
+  }
+
+  template <typename R, typename P>
+  bool Pop(Element &element, std::chrono::duration<R, P> const &duration)
+  {
+    if (!read_count_.Wait(duration))
+    {
+      return false;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(read_mutex_);
+      element = std::move(queue_[read_index_++ & (QUEUE_SIZE - 1)]);
+    }
+
+    write_count_.Post();
+
+    return true;
+  }
+
+private:
+  std::array<Element, QUEUE_SIZE> queue_{};
+  std::mutex                      write_mutex_;
+  std::mutex                      read_mutex_;
+  std::size_t                     write_index_{0};
+  std::size_t                     read_index_{0};
+  Tickets                         read_count_{0};
+  Tickets                         write_count_{QUEUE_SIZE};
+};
+
+template <typename Queue>
+void PushSingle(Queue &queue, std::size_t count)
+{
+  auto const element = std::make_shared<std::size_t>(0);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    queue.Push(Element{element});
+  }
+}
+
+template <typename Queue>
+void PushBatched(Queue &queue, std::size_t count)
+{
+  auto const           element = std::make_shared<std::size_t>(0);
+  std::vector<Element> batch{};
+
+  while (count > 0)
+  {
+    std::size_t const batch_size = std::min(count, BATCH_SIZE);
+    batch.assign(batch_size, element);
+
+    queue.PushMany(batch.begin(), batch.end());
+    count -= batch_size;
+  }
+}
+
+template <typename Queue>
+void PopSingle(Queue &queue, std::size_t count)
+{
+  Element element;
+  for (std::size_t i = 0; i < count;)
+  {
+    if (queue.Pop(element, std::chrono::milliseconds{100}))
+    {
+      ++i;
+    }
+  }
+}
+
+template <typename Queue>
+void PopBatched(Queue &queue, std::size_t count)
+{
+  std::vector<Element> batch{};
+  batch.reserve(BATCH_SIZE);
+
+  for (std::size_t i = 0; i < count;)
+  {
+    batch.clear();
+    i += queue.PopMany(std::back_inserter(batch), std::min(BATCH_SIZE, count - i),
+                       std::chrono::milliseconds{100});
+  }
+}
+
+/**
+ * Run the specified number of producers against a single consumer, passing TOTAL_ELEMENTS
+ * elements through the queue
+ */
+template <typename Queue, typename Producer, typename Consumer>
+void RunProducers(benchmark::State &state, Producer const &producer, Consumer const &consumer)
+{
+  auto const num_producers = static_cast<std::size_t>(state.range(0));
+  auto const per_producer  = TOTAL_ELEMENTS / num_producers;
+
+  for (auto _ : state)
+  {
+    auto queue = std::make_unique<Queue>();
+
+    std::vector<std::thread> producers{};
+    for (std::size_t i = 0; i < num_producers; ++i)
+    {
+      producers.emplace_back(
+          [&queue, &producer, per_producer]() { producer(*queue, per_producer); });
+    }
+
+    consumer(*queue, per_producer * num_producers);
+
+    for (auto &thread : producers)
+    {
+      thread.join();
+    }
+  }
+
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations() * per_producer * num_producers));
+}
+
+void Queue_Locking(benchmark::State &state)
+{
+  RunProducers<LockingQueue>(state, PushSingle<LockingQueue>, PopSingle<LockingQueue>);
+}
+
+void Queue_MPSC(benchmark::State &state)
+{
+  using Queue = MPSCQueue<Element, QUEUE_SIZE>;
+  RunProducers<Queue>(state, PushSingle<Queue>, PopSingle<Queue>);
+}
+
+void Queue_MPSC_Batched(benchmark::State &state)
+{
+  using Queue = MPSCQueue<Element, QUEUE_SIZE>;
+  RunProducers<Queue>(state, PushBatched<Queue>, PopBatched<Queue>);
+}
+
+void Queue_MPMC(benchmark::State &state)
+{
+  using Queue = MPMCQueue<Element, QUEUE_SIZE>;
+  RunProducers<Queue>(state, PushSingle<Queue>, PopSingle<Queue>);
+}
+
+void Queue_MPMC_Batched(benchmark::State &state)
+{
+  using Queue = MPMCQueue<Element, QUEUE_SIZE>;
+  RunProducers<Queue>(state, PushBatched<Queue>, PopBatched<Queue>);
+}
+
+}  // namespace
+
+BENCHMARK(Queue_Locking)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+BENCHMARK(Queue_MPSC)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+BENCHMARK(Queue_MPSC_Batched)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+BENCHMARK(Queue_MPMC)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+BENCHMARK(Queue_MPMC_Batched)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
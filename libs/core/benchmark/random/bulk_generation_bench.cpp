@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lcg.hpp"
+#include "core/random/lfg.hpp"
+#include "core/random/philox.hpp"
+#include "core/random/xoshiro.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::random::LaggedFibonacciGenerator;
+using fetch::random::LinearCongruentialGenerator;
+using fetch::random::Philox4x32;
+using fetch::random::Xoshiro256StarStar;
+
+template <typename Generator>
+void BM_GenerateSequential(benchmark::State &state)
+{
+  Generator             generator{};
+  std::vector<uint64_t> values(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    for (auto &value : values)
+    {
+      value = generator();
+    }
+
+    benchmark::DoNotOptimize(values.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Generator>
+void BM_GenerateFill(benchmark::State &state)
+{
+  Generator             generator{};
+  std::vector<uint64_t> values(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    generator.Fill(values.data(), values.size());
+
+    benchmark::DoNotOptimize(values.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Generator>
+void BM_GenerateDoublesSequential(benchmark::State &state)
+{
+  Generator           generator{};
+  std::vector<double> values(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    for (auto &value : values)
+    {
+      value = generator.AsDouble();
+    }
+
+    benchmark::DoNotOptimize(values.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Generator>
+void BM_GenerateDoublesFill(benchmark::State &state)
+{
+  Generator           generator{};
+  std::vector<double> values(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    generator.Fill(values.data(), values.size());
+
+    benchmark::DoNotOptimize(values.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_GenerateSequential, LinearCongruentialGenerator)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateFill, LinearCongruentialGenerator)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateSequential, LaggedFibonacciGenerator<>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateFill, LaggedFibonacciGenerator<>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateSequential, Philox4x32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateFill, Philox4x32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateSequential, Xoshiro256StarStar)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateFill, Xoshiro256StarStar)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(BM_GenerateDoublesSequential, LinearCongruentialGenerator)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateDoublesFill, LinearCongruentialGenerator)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateDoublesSequential, LaggedFibonacciGenerator<>)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateDoublesFill, LaggedFibonacciGenerator<>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateDoublesSequential, Philox4x32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateDoublesFill, Philox4x32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateDoublesSequential, Xoshiro256StarStar)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_GenerateDoublesFill, Xoshiro256StarStar)->Range(1 << 10, 1 << 20);
@@ -84,6 +84,7 @@ public:
   UnderlyingArray &      data();
 
   std::size_t PopCount() const;
+  bool        Intersects(BitVector const &other) const;
 
   void conditional_flip(std::size_t block, std::size_t bit, uint64_t base);
   void conditional_flip(std::size_t bit, uint64_t base);
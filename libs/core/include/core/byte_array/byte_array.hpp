@@ -20,6 +20,9 @@
 #include "core/byte_array/const_byte_array.hpp"
 
 #include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <string>
 #include <utility>
 
 namespace fetch {
@@ -43,17 +46,51 @@ public:
 
   ByteArray() = default;
 
+  // mutable arrays share their buffer between copies, so they are never stored inline
+  ByteArray(char const *str)  // NOLINT
+    : ByteArray{reinterpret_cast<ValueType const *>(str), str != nullptr ? std::strlen(str) : 0}
+  {}
+
+  ByteArray(ValueType const *const data, std::size_t size)
+    : SuperType(data, size, Placement::SHARED)
+  {}
+
+  ByteArray(std::initializer_list<ValueType> l)
+    : SuperType(l.begin(), l.size(), Placement::SHARED)
+  {}
+
+  ByteArray(std::string const &s)  // NOLINT
+    : SuperType(reinterpret_cast<ValueType const *>(s.data()), s.size(), Placement::SHARED)
+  {}
+
+  ByteArray(SuperType const &other, std::size_t start, std::size_t length)
+    : SuperType(other, start, length, Placement::SHARED)
+  {}
+
   ByteArray(SuperType const &other)  // NOLINT
-    : SuperType(other.Copy())
+    : SuperType(other.pointer(), other.size(), Placement::SHARED)
   {}
   ByteArray(SuperType &&other)  // NOLINT
-    : SuperType(other.IsUnique() ? std::move(other) : other.Copy())
+    : SuperType(std::move(other), Placement::SHARED)
   {}
 
   SelfType SubArray(std::size_t start, std::size_t length = std::size_t(-1)) const
   {
     return SubArrayInternal<SelfType>(start, length);
   }
+
+  /**
+   * Create a mutable array which shares the memory of a const array rather than copying it. The
+   * contents must not be modified through the result, this is only intended for consumers which
+   * read from the array, like deserialisers. Small arrays stored inline are copied.
+   *
+   * @param other The array to be shared
+   * @return The array sharing the memory of other
+   */
+  static SelfType SharedView(SuperType const &other)
+  {
+    return SharedViewInternal<SelfType>(other);
+  }
 };
 
 }  // namespace byte_array
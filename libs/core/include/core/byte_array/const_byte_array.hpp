@@ -35,6 +35,7 @@
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 namespace fetch {
 namespace byte_array {
@@ -51,7 +52,10 @@ public:
     NPOS = uint64_t(-1)
   };
 
-  constexpr ConstByteArray() = default;
+  /// Arrays of up to this many bytes created from raw data are stored inside the object itself
+  static constexpr std::size_t INLINE_CAPACITY = 64;
+
+  ConstByteArray() = default;
 
   explicit ConstByteArray(std::size_t n)
   {
@@ -63,42 +67,43 @@ public:
   {}
 
   ConstByteArray(ValueType const *const data, std::size_t size)
-  {
-    if (size > 0)
-    {
-      assert(data != nullptr);
-      Reserve(size);
-      Resize(size);
-      WriteBytes(data, size);
-    }
-  }
+    : ConstByteArray(data, size, Placement::ALLOW_INLINE)
+  {}
 
   ConstByteArray(std::initializer_list<ValueType> l)
-  {
-    Resize(l.size());
-    std::size_t i = 0;
-    for (auto &a : l)
-    {
-      data_[i++] = a;
-    }
-  }
+    : ConstByteArray(l.begin(), l.size())
+  {}
 
   ConstByteArray(std::string const &s)  // NOLINT
     : ConstByteArray(reinterpret_cast<uint8_t const *>(s.data()), s.size())
   {}
 
-  ConstByteArray(ConstByteArray const &other) = default;
-  ConstByteArray(ConstByteArray &&other)      = default;
+  ConstByteArray(ConstByteArray const &other) noexcept
+    : storage_{Storage::Uninitialised{}}
+  {
+    Acquire(other);
+  }
+
+  ConstByteArray(ConstByteArray &&other) noexcept
+    : storage_{Storage::Uninitialised{}}
+  {
+    Acquire(std::move(other));
+  }
 
   // TODO(pbukva): (private issue #229: confusion what method does without analysing implementation
   // details - absolute vs relative[against `other.start_`] size)
   ConstByteArray(ConstByteArray const &other, std::size_t start, std::size_t length) noexcept
-    : data_(other.data_)
-    , start_(start)
-    , length_(length)
-    , arr_pointer_(data_.pointer() + start_)
+    : ConstByteArray(other, start, length, Placement::ALLOW_INLINE)
+  {}
+
+  explicit ConstByteArray(SharedArrayType data) noexcept
   {
-    assert(start_ + length_ <= data_.size());
+    length_ = data.size();
+    if (length_ > 0)
+    {
+      storage_.shared = std::move(data);
+      arr_pointer_    = storage_.shared.pointer();
+    }
   }
 
   explicit ConstByteArray(std::istream &in)
@@ -114,8 +119,27 @@ public:
     in.read(char_pointer(), size_in_bytes);
   }
 
-  ConstByteArray &operator=(ConstByteArray const &) = default;
-  ConstByteArray &operator=(ConstByteArray &&other) = default;
+  ConstByteArray &operator=(ConstByteArray const &other) noexcept
+  {
+    if (this != &other)
+    {
+      ReleaseStorage();
+      Acquire(other);
+    }
+
+    return *this;
+  }
+
+  ConstByteArray &operator=(ConstByteArray &&other) noexcept
+  {
+    if (this != &other)
+    {
+      ReleaseStorage();
+      Acquire(std::move(other));
+    }
+
+    return *this;
+  }
 
   ConstByteArray Copy() const
   {
@@ -141,7 +165,10 @@ public:
     std::memcpy(dest, pointer() + src_offset, dest_size);
   }
 
-  ~ConstByteArray() = default;
+  ~ConstByteArray()
+  {
+    ReleaseStorage();
+  }
 
   explicit operator std::string() const
   {
@@ -217,9 +244,9 @@ public:
     return !(*this == other);
   }
 
-  constexpr std::size_t capacity() const noexcept
+  std::size_t capacity() const noexcept
   {
-    return data_.size();
+    return IsInline() ? INLINE_CAPACITY : storage_.shared.size();
   }
 
   bool operator==(char const *str) const
@@ -298,9 +325,14 @@ public:
 
   SelfType operator+(SelfType const &other) const
   {
-    SelfType ret = this->Copy();
-    ret.Resize(other.size() + size());
-    std::memcpy(ret.pointer() + size(), other.pointer(), other.size());
+    // built in a single (shared) allocation so that sub arrays of the result are views into it
+    SelfType ret{};
+    ret.Resize(size() + other.size());
+    if (!ret.empty())
+    {
+      std::memcpy(ret.pointer(), pointer(), size());
+      std::memcpy(ret.pointer() + size(), other.pointer(), other.size());
+    }
     return ret;
   }
 
@@ -344,23 +376,110 @@ public:
   // Non-const functions go here
   void FromByteArray(SelfType const &other, std::size_t start, std::size_t length) noexcept
   {
-    data_        = other.data_;
-    start_       = other.start_ + start;
-    length_      = length;
-    arr_pointer_ = data_.pointer() + start_;
+    *this = SelfType(other, other.start_ + start, length);
+  }
+
+  /**
+   * Determine if the contents are stored inside the object rather than in a shared buffer
+   *
+   * @return true if the array is stored inline, otherwise false
+   */
+  bool IsInline() const noexcept
+  {
+    return arr_pointer_ == storage_.local;
   }
 
   bool IsUnique() const noexcept
   {
-    return data_.IsUnique();
+    return IsInline() || storage_.shared.IsUnique();
   }
 
   uint64_t UseCount() const noexcept
   {
-    return data_.UseCount();
+    return IsInline() ? 1u : storage_.shared.UseCount();
   }
 
 protected:
+  /**
+   * Where the contents of a newly created array may be placed. Mutable arrays share their buffer
+   * between copies and so must never be stored inline.
+   */
+  enum class Placement
+  {
+    ALLOW_INLINE,
+    SHARED
+  };
+
+  ConstByteArray(ValueType const *const data, std::size_t size, Placement placement)
+  {
+    if (size > 0)
+    {
+      assert(data != nullptr);
+
+      if ((placement == Placement::ALLOW_INLINE) && (size <= INLINE_CAPACITY))
+      {
+        SetInline(data, size);
+      }
+      else
+      {
+        Reserve(size);
+        Resize(size);
+        WriteBytes(data, size);
+      }
+    }
+  }
+
+  /**
+   * Create a view of the other array. Arrays with a shared buffer are never copied, inline arrays
+   * are copied into storage determined by the placement.
+   */
+  ConstByteArray(ConstByteArray const &other, std::size_t start, std::size_t length,
+                 Placement placement)
+  {
+    assert(start + length <= other.capacity());
+
+    if (other.IsInline())
+    {
+      ConstByteArray copy{other.storage_.local + start, length, placement};
+      *this = std::move(copy);
+    }
+    else
+    {
+      storage_.shared = other.storage_.shared;
+      start_          = start;
+      length_         = length;
+      arr_pointer_    = storage_.shared.pointer() + start_;
+    }
+  }
+
+  /**
+   * Take over the other array. With the shared placement, arrays which are inline or whose buffer
+   * is referenced elsewhere are copied into a new buffer instead.
+   */
+  ConstByteArray(ConstByteArray &&other, Placement placement)
+  {
+    if ((placement == Placement::SHARED) && (other.IsInline() || !other.IsUnique()))
+    {
+      *this = ConstByteArray{other.pointer(), other.size(), Placement::SHARED};
+
+      // inline arrays are left empty, as though they had been moved from
+      if (other.IsInline())
+      {
+        other.Reset();
+      }
+    }
+    else
+    {
+      *this = std::move(other);
+    }
+  }
+
+  template <typename ReturnType>
+  static ReturnType SharedViewInternal(ConstByteArray const &other)
+  {
+    return ReturnType(other, other.start_, other.length_);
+  }
+
   template <typename ReturnType = SelfType>
   ReturnType SubArrayInternal(std::size_t start, std::size_t length = std::size_t(-1)) const
       noexcept
@@ -429,25 +548,31 @@ protected:
   void Reserve(std::size_t n, ResizeParadigm const resize_paradigm = ResizeParadigm::ABSOLUTE,
                bool const zero_reserved_space = true)
   {
+    std::size_t const current_capacity = capacity();
     std::size_t const new_capacity_for_reserve =
-        resize_paradigm == ResizeParadigm::ABSOLUTE ? n : data_.size() + n;
+        resize_paradigm == ResizeParadigm::ABSOLUTE ? n : current_capacity + n;
 
-    if (new_capacity_for_reserve <= data_.size())
+    if (new_capacity_for_reserve <= current_capacity)
     {
       return;
     }
 
     assert(new_capacity_for_reserve != 0);
 
+    // inline arrays which outgrow the inline storage are moved into a shared buffer
     SharedArrayType newdata(new_capacity_for_reserve);
-    std::memcpy(newdata.pointer(), data_.pointer(), data_.size());
+    if (current_capacity > 0)
+    {
+      std::memcpy(newdata.pointer(), BufferPointer(), current_capacity);
+    }
     if (zero_reserved_space)
     {
-      newdata.SetZeroAfter(data_.size());
+      newdata.SetZeroAfter(current_capacity);
     }
 
-    data_        = newdata;
-    arr_pointer_ = data_.pointer() + start_;
+    ReleaseStorage();
+    new (&storage_.shared) SharedArrayType(std::move(newdata));
+    arr_pointer_ = storage_.shared.pointer() + start_;
   }
 
   constexpr ValueType *pointer() noexcept
@@ -457,7 +582,7 @@ protected:
 
   char *char_pointer() noexcept
   {
-    return reinterpret_cast<char *>(data_.pointer());
+    return reinterpret_cast<char *>(BufferPointer());
   }
 
   template <typename... Arg>
@@ -587,9 +712,107 @@ private:
     value_util::Accumulate(AddBytes{*this}, old_size, args...);
   }
 
-  SharedArrayType data_;
-  std::size_t     start_{0}, length_{0};
-  ValueType *     arr_pointer_{nullptr};
+  /**
+   * Holds either the shared buffer or, for small arrays, the contents themselves. The active
+   * member is determined by `IsInline()`.
+   */
+  union Storage
+  {
+    struct Uninitialised
+    {
+    };
+
+    Storage() noexcept
+      : shared{}
+    {}
+
+    explicit Storage(Uninitialised /*unused*/) noexcept
+    {}
+
+    ~Storage()
+    {}
+
+    SharedArrayType shared;
+    ValueType       local[INLINE_CAPACITY];
+  };
+
+  ValueType *BufferPointer() noexcept
+  {
+    return arr_pointer_ - start_;
+  }
+
+  void SetInline(ValueType const *const data, std::size_t size) noexcept
+  {
+    assert(size <= INLINE_CAPACITY);
+
+    ReleaseStorage();
+    std::memcpy(storage_.local, data, size);
+    std::memset(storage_.local + size, 0, INLINE_CAPACITY - size);
+
+    start_       = 0;
+    length_      = size;
+    arr_pointer_ = storage_.local;
+  }
+
+  /// Takes over the contents of the other array, storage must not hold an active member
+  void Acquire(ConstByteArray const &other) noexcept
+  {
+    start_  = other.start_;
+    length_ = other.length_;
+
+    if (other.IsInline())
+    {
+      std::memcpy(storage_.local, other.storage_.local, INLINE_CAPACITY);
+      arr_pointer_ = storage_.local;
+    }
+    else
+    {
+      new (&storage_.shared) SharedArrayType(other.storage_.shared);
+      arr_pointer_ = other.arr_pointer_;
+    }
+  }
+
+  /// Takes over the contents of the other array, storage must not hold an active member
+  void Acquire(ConstByteArray &&other) noexcept
+  {
+    if (other.IsInline())
+    {
+      Acquire(static_cast<ConstByteArray const &>(other));
+    }
+    else
+    {
+      new (&storage_.shared) SharedArrayType(std::move(other.storage_.shared));
+      start_       = other.start_;
+      length_      = other.length_;
+      arr_pointer_ = other.arr_pointer_;
+    }
+
+    other.Reset();
+  }
+
+  /// Destroys the active member of the storage
+  void ReleaseStorage() noexcept
+  {
+    if (!IsInline())
+    {
+      storage_.shared.~SharedArrayType();
+    }
+  }
+
+  /// Returns the array to the empty state
+  void Reset() noexcept
+  {
+    ReleaseStorage();
+    new (&storage_.shared) SharedArrayType();
+
+    start_       = 0;
+    length_      = 0;
+    arr_pointer_ = nullptr;
+  }
+
+  Storage     storage_;
+  std::size_t start_{0}, length_{0};
+  ValueType * arr_pointer_{nullptr};
 };
 
 std::ostream & operator<<(std::ostream &os, ConstByteArray const &str);
@@ -0,0 +1,75 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace fetch {
+namespace compression {
+
+/**
+ * The maximum size of a dictionary, matches can only refer back 64KiB in the LZ4 block format
+ */
+constexpr std::size_t LZ4_MAX_DICTIONARY_SIZE = 0xFFFF;
+
+/**
+ * Compress a buffer into the LZ4 block format.
+ *
+ * An optional dictionary can be provided. This is treated as data which immediately precedes the
+ * input, so the same dictionary must be provided when decompressing. The size of the input is not
+ * recorded in the output and must be stored separately by the caller.
+ *
+ * @param input The data to compress
+ * @param dictionary The (optional) dictionary
+ * @return The compressed block
+ */
+byte_array::ConstByteArray LZ4Compress(byte_array::ConstByteArray const &input,
+                                       byte_array::ConstByteArray const &dictionary = {});
+
+/**
+ * Decompress an LZ4 block.
+ *
+ * @param input The compressed block
+ * @param decompressed_size The exact size of the original data
+ * @param output The output buffer to populate
+ * @param dictionary The dictionary used when the block was compressed (if any)
+ * @return true if the block was well formed and decompressed to the expected size, otherwise false
+ */
+bool LZ4Decompress(byte_array::ConstByteArray const &input, std::size_t decompressed_size,
+                   byte_array::ByteArray &output,
+                   byte_array::ConstByteArray const &dictionary = {});
+
+/**
+ * Build a dictionary from a set of representative samples. The dictionary is made up of the
+ * segments that occur most frequently across the samples, with the most common ones placed at the
+ * end of the dictionary (closest to the data being compressed).
+ *
+ * @param samples The sample messages
+ * @param max_size The maximum size of the dictionary
+ * @return The dictionary
+ */
+byte_array::ConstByteArray TrainLZ4Dictionary(
+    std::vector<byte_array::ConstByteArray> const &samples,
+    std::size_t                                    max_size = LZ4_MAX_DICTIONARY_SIZE);
+
+}  // namespace compression
+}  // namespace fetch
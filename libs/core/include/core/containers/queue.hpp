@@ -18,19 +18,30 @@
 //------------------------------------------------------------------------------
 
 #include "core/mutex.hpp"
-#include "core/sync/tickets.hpp"
 #include "meta/log2.hpp"
 #include "meta/type_traits.hpp"
 
 #include <array>
-#include <deque>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
 namespace fetch {
 namespace core {
 
+constexpr std::size_t QUEUE_CACHE_LINE_SIZE = 64;
+
 /**
  * A Single threaded index
  *
+ * Only a single thread ever advances the index, so claiming a position is a plain store
+ *
  * @tparam SIZE
  */
 template <std::size_t SIZE>
@@ -39,38 +50,42 @@ class SingleThreadedIndex
 public:
   // Construction / Destruction
   explicit SingleThreadedIndex(std::size_t initial)
-    : index_(initial)
+    : position_(initial)
   {}
   SingleThreadedIndex(SingleThreadedIndex const &) = delete;
   SingleThreadedIndex(SingleThreadedIndex &&)      = delete;
 
   /**
-   * Post increment operator
+   * Get the next position to be claimed
    *
-   * @return The new index value
+   * @return The position
    */
-  std::size_t operator++(int)
+  std::size_t Load() const noexcept
   {
-    std::size_t index = index_++;
-    index_ &= MASK;
-
-    return index;
+    return position_.load(std::memory_order_relaxed);
   }
 
-  template <typename Function>
-  void Increment(Function &&function)
+  /**
+   * Attempt to claim the specified position, advancing the index
+   *
+   * @param position The position to be claimed, updated to the current position on failure
+   * @return true if the position was claimed, otherwise false
+   */
+  bool TryClaim(std::size_t &position) noexcept
   {
-    function((*this)++);
+    position_.store(position + 1, std::memory_order_relaxed);
+    return true;
   }
 
   // Operators
   SingleThreadedIndex &operator=(SingleThreadedIndex const &) = delete;
   SingleThreadedIndex &operator=(SingleThreadedIndex &&) = delete;
 
-private:
-  static constexpr std::size_t MASK = SIZE - 1;
+protected:
+  std::atomic<std::size_t> position_;
 
-  std::size_t index_{0};
+private:
+  uint8_t padding_[QUEUE_CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
 
   // static assertions
   static_assert(meta::IsLog2(SIZE), "Queue size must be a valid power of 2");
@@ -79,10 +94,12 @@ private:
 /**
  * A Multi threaded index
  *
+ * Positions are claimed with a compare and swap, so any number of threads can advance the index
+ *
  * @tparam SIZE
  */
 template <std::size_t SIZE>
-class MultiThreadedIndex : protected SingleThreadedIndex<SIZE>
+class MultiThreadedIndex : public SingleThreadedIndex<SIZE>
 {
 public:
   using Base = SingleThreadedIndex<SIZE>;
@@ -93,29 +110,139 @@ public:
   {}
 
   /**
-   * Post increment operator
+   * Attempt to claim the specified position, advancing the index
+   *
+   * @param position The position to be claimed, updated to the current position on failure
+   * @return true if the position was claimed, otherwise false
+   */
+  bool TryClaim(std::size_t &position) noexcept
+  {
+    return this->position_.compare_exchange_weak(position, position + 1,
+                                                  std::memory_order_relaxed);
+  }
+};
+
+/**
+ * The threads blocked on one side of a queue. Waiting threads spin briefly before parking on a
+ * condition variable, and notifying is a single atomic load unless a thread is actually parked.
+ */
+class QueueWaiters
+{
+public:
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+
+  /**
+   * Wait until the predicate succeeds or the deadline expires
+   *
+   * @param predicate The (non-blocking) attempt to perform the operation
+   * @param deadline The time at which to give up
+   * @return true if the predicate succeeded, otherwise false
+   */
+  template <typename Predicate>
+  bool WaitUntil(Predicate &&predicate, Timepoint const &deadline)
+  {
+    return Park(predicate, [this, &deadline](std::unique_lock<std::mutex> &lock) {
+      return std::cv_status::no_timeout == cv_.wait_until(lock, deadline);
+    });
+  }
+
+  /**
+   * Wait until the predicate succeeds
    *
-   * @return The new index value
+   * @param predicate The (non-blocking) attempt to perform the operation
    */
-  std::size_t operator++(int)
+  template <typename Predicate>
+  void Wait(Predicate &&predicate)
   {
-    FETCH_LOCK(lock_);
-    return static_cast<Base &>(*this)++;
+    Park(predicate, [this](std::unique_lock<std::mutex> &lock) {
+      cv_.wait(lock);
+      return true;
+    });
   }
 
-  template <typename Function>
-  void Increment(Function &&function)
+  /**
+   * Wake parked threads after the state of the queue has changed
+   *
+   * @param all Wake all the parked threads rather than only one
+   */
+  void Notify(bool all = false)
   {
-    FETCH_LOCK(lock_);
-    Base::Increment(std::forward<Function>(function));
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (parked_.load(std::memory_order_relaxed) == 0)
+    {
+      return;
+    }
+
+    {
+      // ensures a thread which has just checked its predicate is waiting before being notified
+      FETCH_LOCK(mutex_);
+    }
+
+    if (all)
+    {
+      cv_.notify_all();
+    }
+    else
+    {
+      cv_.notify_one();
+    }
   }
 
 private:
-  Mutex lock_;
+  static constexpr std::size_t SPIN_COUNT = 64;
+
+  template <typename Predicate, typename Block>
+  bool Park(Predicate &predicate, Block const &block)
+  {
+    for (std::size_t i = 0; i < SPIN_COUNT; ++i)
+    {
+      if (predicate())
+      {
+        return true;
+      }
+
+      std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // pairs with the fence in Notify(), either the notifier sees this thread as parked or this
+    // thread sees the change made by the notifier
+    parked_.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool success = predicate();
+    while (!success)
+    {
+      bool const notified = block(lock);
+
+      success = predicate();
+      if (!notified)
+      {
+        break;
+      }
+    }
+
+    parked_.fetch_sub(1);
+
+    return success;
+  }
+
+  std::mutex               mutex_;
+  std::condition_variable  cv_;
+  std::atomic<std::size_t> parked_{0};
 };
 
 /**
- * Single Producer, Single Consumer fixed-length queue
+ * Bounded, lock free, fixed-length queue
+ *
+ * Elements are stored in a ring of cells, each of which carries a sequence number recording
+ * whether it is ready to be written or read for a given lap of the ring (D. Vyukov's bounded
+ * queue). Producers and consumers only contend on their own index, and single threaded sides of
+ * the queue claim positions without any read-modify-write operations. Blocking operations spin
+ * briefly before parking the calling thread.
  *
  * @tparam T The type of element to be stored in the queue
  * @tparam SIZE The max size of the queue
@@ -135,7 +262,7 @@ public:
   static_assert(std::is_default_constructible<T>::value, "T must be default constructable");
 
   // Construction / Destruction
-  Queue()              = default;
+  Queue();
   Queue(Queue const &) = delete;
   Queue(Queue &&)      = delete;
 
@@ -144,6 +271,9 @@ public:
   T Pop();
   template <typename R, typename P>
   bool Pop(T &value, std::chrono::duration<R, P> const &duration);
+  template <typename OutputIterator, typename R, typename P>
+  std::size_t PopMany(OutputIterator output, std::size_t max_count,
+                      std::chrono::duration<R, P> const &duration);
   template <typename U>
   meta::EnableIfSame<T, meta::Decay<U>> Push(U &&element);
   template <typename U>
@@ -151,6 +281,8 @@ public:
   template <typename U, typename R, typename P>
   meta::EnableIfSame<T, meta::Decay<U>, bool> Push(U &&element, std::size_t &count,
                                                    std::chrono::duration<R, P> const &duration);
+  template <typename Iterator>
+  void PushMany(Iterator begin, Iterator end);
   /// @}
 
   // Operators
@@ -158,13 +290,35 @@ public:
   Queue &operator=(Queue &&) = delete;
 
 protected:
-  using Array = std::array<T, SIZE>;
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence{0};
+    T                        value{};
+  };
+
+  using Array     = std::array<Cell, SIZE>;
+  using Clock     = QueueWaiters::Clock;
+  using Timepoint = QueueWaiters::Timepoint;
+
+  template <typename U>
+  bool TryPush(U &&element);
+  bool TryPop(T &value);
+
+  template <typename R, typename P>
+  static Timepoint Deadline(std::chrono::duration<R, P> const &duration);
+
+  std::size_t ApproximateSize() const
+  {
+    return write_index_.Load() - read_index_.Load();
+  }
+
+  static constexpr std::size_t MASK = SIZE - 1;
 
-  Array         queue_{};            ///< The main element container
-  ProducerIndex write_index_{0};     ///< The write index
-  ConsumerIndex read_index_{0};      ///< The read index
-  Tickets       read_count_{0};      ///< The read semaphore/tickets object
-  Tickets       write_count_{SIZE};  ///< The write semaphore/tickets object
+  Array         queue_{};          ///< The ring of cells
+  ProducerIndex write_index_{0};   ///< The write index
+  ConsumerIndex read_index_{0};    ///< The read index
+  QueueWaiters  readers_{};        ///< Consumers waiting for elements
+  QueueWaiters  writers_{};        ///< Producers waiting for space
 
   // static asserts
   static_assert(meta::IsLog2(SIZE), "Queue size must be a valid power of 2");
@@ -172,6 +326,15 @@ protected:
   static_assert(std::is_copy_assignable<T>::value, "T must have copy assignment");
 };
 
+template <typename T, std::size_t N, typename P, typename C>
+Queue<T, N, P, C>::Queue()
+{
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    queue_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
 /**
  * Pop an element from the queue
  *
@@ -187,12 +350,10 @@ protected:
 template <typename T, std::size_t N, typename P, typename C>
 T Queue<T, N, P, C>::Pop()
 {
-  read_count_.Wait();
-
   T value;
-  read_index_.Increment([this, &value](auto const index) { value = std::move(queue_[index]); });
+  readers_.Wait([this, &value]() { return TryPop(value); });
 
-  write_count_.Post();
+  writers_.Notify();
 
   return value;
 }
@@ -214,16 +375,72 @@ template <typename T, std::size_t N, typename P, typename C>
 template <typename Rep, typename Per>
 bool Queue<T, N, P, C>::Pop(T &value, std::chrono::duration<Rep, Per> const &duration)
 {
-  if (!read_count_.Wait(duration))
+  auto const pop = [this, &value]() { return TryPop(value); };
+
+  bool const success =
+      pop() || ((duration.count() > 0) && readers_.WaitUntil(pop, Deadline(duration)));
+
+  if (success)
   {
-    return false;
+    writers_.Notify();
   }
 
-  read_index_.Increment([this, &value](auto const &index) { value = std::move(queue_[index]); });
+  return success;
+}
 
-  write_count_.Post();
+/**
+ * Pop a batch of elements from the queue
+ *
+ * Waits (up to the specified duration) for the first element and then takes any further elements
+ * which are immediately available.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam P The producer index type
+ * @tparam C The consumer index type
+ * @tparam OutputIterator The type of the output iterator
+ * @tparam Rep The tick representation for the duration
+ * @tparam Per The tick period for the duration
+ * @param output The iterator to which the elements are written
+ * @param max_count The maximum number of elements to extract
+ * @param duration The maximum amount of time to wait for the first element
+ * @return The number of elements extracted
+ */
+template <typename T, std::size_t N, typename P, typename C>
+template <typename OutputIterator, typename Rep, typename Per>
+std::size_t Queue<T, N, P, C>::PopMany(OutputIterator output, std::size_t max_count,
+                                       std::chrono::duration<Rep, Per> const &duration)
+{
+  std::size_t count{0};
 
-  return true;
+  T value;
+  while ((count < max_count) && TryPop(value))
+  {
+    *output++ = std::move(value);
+    ++count;
+  }
+
+  if ((count == 0) && (max_count > 0) && (duration.count() > 0))
+  {
+    if (readers_.WaitUntil([this, &value]() { return TryPop(value); }, Deadline(duration)))
+    {
+      *output++ = std::move(value);
+      ++count;
+
+      while ((count < max_count) && TryPop(value))
+      {
+        *output++ = std::move(value);
+        ++count;
+      }
+    }
+  }
+
+  if (count > 0)
+  {
+    writers_.Notify(count > 1);
+  }
+
+  return count;
 }
 
 /**
@@ -244,12 +461,9 @@ template <typename T, std::size_t N, typename P, typename C>
 template <typename U>
 meta::EnableIfSame<T, meta::Decay<U>> Queue<T, N, P, C>::Push(U &&element)
 {
-  write_count_.Wait();
+  writers_.Wait([this, &element]() { return TryPush(std::forward<U>(element)); });
 
-  write_index_.Increment(
-      [this, &element](auto const index) { queue_[index] = std::forward<U>(element); });
-
-  read_count_.Post();
+  readers_.Notify();
 }
 
 /**
@@ -271,12 +485,9 @@ template <typename T, std::size_t N, typename P, typename C>
 template <typename U>
 meta::EnableIfSame<T, meta::Decay<U>> Queue<T, N, P, C>::Push(U &&element, std::size_t &count)
 {
-  write_count_.Wait();
-
-  write_index_.Increment(
-      [this, &element](auto const index) { queue_[index] = std::forward<U>(element); });
+  Push(std::forward<U>(element));
 
-  read_count_.Post(count);
+  count = ApproximateSize();
 }
 
 /**
@@ -301,18 +512,154 @@ template <typename U, typename Rep, typename Per>
 meta::EnableIfSame<T, meta::Decay<U>, bool> Queue<T, N, P, C>::Push(
     U &&element, std::size_t &count, std::chrono::duration<Rep, Per> const &duration)
 {
-  if (!write_count_.Wait(duration))
+  auto const push = [this, &element]() { return TryPush(std::forward<U>(element)); };
+
+  if (!push() && !((duration.count() > 0) && writers_.WaitUntil(push, Deadline(duration))))
   {
     return false;
   }
 
-  write_index_.Increment(
-      [this, &element](auto const index) { queue_[index] = std::forward<U>(element); });
+  readers_.Notify();
 
-  read_count_.Post(count);
+  count = ApproximateSize();
   return true;
 }
 
+/**
+ * Push a range of elements onto the queue, the elements are moved from the range
+ *
+ * If the queue becomes full this function will block until the remaining elements can be added
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam P The producer index type
+ * @tparam C The consumer index type
+ * @tparam Iterator The type of the input iterator
+ * @param begin The start of the range
+ * @param end The end of the range
+ */
+template <typename T, std::size_t N, typename P, typename C>
+template <typename Iterator>
+void Queue<T, N, P, C>::PushMany(Iterator begin, Iterator end)
+{
+  while (begin != end)
+  {
+    std::size_t count{0};
+    while ((begin != end) && TryPush(std::move(*begin)))
+    {
+      ++begin;
+      ++count;
+    }
+
+    // consumers must be woken before waiting for space, they might be waiting on these elements
+    if (count > 0)
+    {
+      readers_.Notify(count > 1);
+    }
+
+    if (begin != end)
+    {
+      writers_.Wait([this, &begin]() { return TryPush(std::move(*begin)); });
+      ++begin;
+
+      readers_.Notify();
+    }
+  }
+}
+
+/**
+ * Attempt to add an element to the queue without blocking
+ *
+ * The element is only moved from if it is added to the queue.
+ *
+ * @param element The element to be added
+ * @return true if the element was added, otherwise false if the queue was full
+ */
+template <typename T, std::size_t N, typename P, typename C>
+template <typename U>
+bool Queue<T, N, P, C>::TryPush(U &&element)
+{
+  std::size_t position = write_index_.Load();
+
+  for (;;)
+  {
+    Cell &            cell     = queue_[position & MASK];
+    std::size_t const sequence = cell.sequence.load(std::memory_order_acquire);
+    auto const        difference =
+        static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+    if (difference == 0)
+    {
+      // the cell is free for this lap of the ring
+      if (write_index_.TryClaim(position))
+      {
+        cell.value = std::forward<U>(element);
+        cell.sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+      }
+    }
+    else if (difference < 0)
+    {
+      // the cell still holds the element from the previous lap, the queue is full
+      return false;
+    }
+    else
+    {
+      position = write_index_.Load();
+    }
+  }
+}
+
+/**
+ * Attempt to extract an element from the queue without blocking
+ *
+ * @param value The reference to the value to be populated
+ * @return true if an element was extracted, otherwise false if the queue was empty
+ */
+template <typename T, std::size_t N, typename P, typename C>
+bool Queue<T, N, P, C>::TryPop(T &value)
+{
+  std::size_t position = read_index_.Load();
+
+  for (;;)
+  {
+    Cell &            cell     = queue_[position & MASK];
+    std::size_t const sequence = cell.sequence.load(std::memory_order_acquire);
+    auto const        difference =
+        static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+
+    if (difference == 0)
+    {
+      // the cell has been written for this lap of the ring
+      if (read_index_.TryClaim(position))
+      {
+        value = std::move(cell.value);
+        cell.sequence.store(position + N, std::memory_order_release);
+
+        return true;
+      }
+    }
+    else if (difference < 0)
+    {
+      // the cell has not been written yet, the queue is empty
+      return false;
+    }
+    else
+    {
+      position = read_index_.Load();
+    }
+  }
+}
+
+template <typename T, std::size_t N, typename P, typename C>
+template <typename Rep, typename Per>
+typename Queue<T, N, P, C>::Timepoint Queue<T, N, P, C>::Deadline(
+    std::chrono::duration<Rep, Per> const &duration)
+{
+  return Clock::now() + std::chrono::duration_cast<Clock::duration>(duration);
+}
+
 // Helpful Typedefs
 template <typename T, std::size_t N>
 using SPSCQueue = Queue<T, N, SingleThreadedIndex<N>, SingleThreadedIndex<N>>;
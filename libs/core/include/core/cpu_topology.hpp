@@ -0,0 +1,103 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace core {
+
+using CpuList = std::vector<uint32_t>;
+
+/**
+ * A NUMA node and the logical CPUs which belong to it
+ */
+struct NumaNode
+{
+  uint32_t id{0};
+  CpuList  cpus{};
+};
+
+/**
+ * The NUMA layout of the machine, used to place related threads on the same node.
+ *
+ * Lanes are assigned to the nodes round robin (lane `n` is placed on node `n % num_nodes`). This
+ * matches the way work for a lane is routed to the executor threads (lane `n` to thread
+ * `n % num_threads`), so executor `i` can be placed on the same node as the lanes it serves
+ * whenever the number of executors is a multiple of the number of nodes.
+ */
+class CpuTopology
+{
+public:
+  using Nodes = std::vector<NumaNode>;
+
+  // Construction / Destruction
+  explicit CpuTopology(Nodes nodes);
+  CpuTopology(CpuTopology const &) = default;
+  CpuTopology(CpuTopology &&)      = default;
+  ~CpuTopology()                   = default;
+
+  static CpuTopology Discover();
+
+  std::size_t num_nodes() const;
+  Nodes const &nodes() const;
+
+  NumaNode const &NodeForLane(uint32_t lane) const;
+  NumaNode const &NodeForExecutor(std::size_t executor) const;
+
+  // Operators
+  CpuTopology &operator=(CpuTopology const &) = default;
+  CpuTopology &operator=(CpuTopology &&) = default;
+
+private:
+  Nodes nodes_;
+};
+
+CpuList ParseCpuList(std::string const &text);
+
+bool    SetThreadAffinity(CpuList const &cpus);
+CpuList GetThreadAffinity();
+
+/**
+ * Restricts the calling thread to a set of CPUs for the lifetime of the scope.
+ *
+ * Under the default (first touch) memory policy pages are allocated on the node of the CPU which
+ * first writes to them, so constructing an object inside the scope places its memory on the
+ * selected node.
+ */
+class ScopedThreadAffinity
+{
+public:
+  explicit ScopedThreadAffinity(CpuList const &cpus);
+  ScopedThreadAffinity(ScopedThreadAffinity const &) = delete;
+  ScopedThreadAffinity(ScopedThreadAffinity &&)      = delete;
+  ~ScopedThreadAffinity();
+
+  // Operators
+  ScopedThreadAffinity &operator=(ScopedThreadAffinity const &) = delete;
+  ScopedThreadAffinity &operator=(ScopedThreadAffinity &&) = delete;
+
+private:
+  CpuList previous_{};
+};
+
+}  // namespace core
+}  // namespace fetch
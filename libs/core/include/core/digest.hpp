@@ -19,6 +19,11 @@
 
 #include "core/byte_array/const_byte_array.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -47,4 +52,84 @@ using DigestSet = std::unordered_set<Digest, DigestHashAdapter>;
 template <typename Value>
 using DigestMap = std::unordered_map<Digest, Value, DigestHashAdapter>;
 
+/**
+ * Fixed size, trivially copyable digest used as the key of hot lookup tables.
+ *
+ * Digests of up to 256 bits are held as four machine words, so copying a key never allocates and
+ * comparing two keys is a branch free comparison of the words. Since digests are uniformly
+ * distributed the first word is used directly as the hash. Keys convert implicitly to and from
+ * `Digest` so that they can be used with the existing interfaces.
+ */
+class DigestKey
+{
+public:
+  static constexpr std::size_t MAX_SIZE = 32;
+
+  // Construction / Destruction
+  DigestKey() = default;
+
+  DigestKey(Digest const &digest)  // NOLINT - implicit to interoperate with Digest
+    : size_{static_cast<uint8_t>(digest.size())}
+  {
+    if (digest.size() > MAX_SIZE)
+    {
+      throw std::length_error("Digest is too large to be used as a key");
+    }
+
+    if (!digest.empty())
+    {
+      std::memcpy(words_.data(), digest.pointer(), digest.size());
+    }
+  }
+
+  operator Digest() const  // NOLINT - implicit to interoperate with Digest
+  {
+    return Digest{reinterpret_cast<uint8_t const *>(words_.data()), size_};
+  }
+
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  std::size_t hash() const noexcept
+  {
+    return static_cast<std::size_t>(words_[0]);
+  }
+
+  // Operators
+  bool operator==(DigestKey const &other) const noexcept
+  {
+    uint64_t difference = size_ ^ other.size_;
+    for (std::size_t i = 0; i < NUM_WORDS; ++i)
+    {
+      difference |= words_[i] ^ other.words_[i];
+    }
+
+    return difference == 0;
+  }
+
+  bool operator!=(DigestKey const &other) const noexcept
+  {
+    return !(*this == other);
+  }
+
+private:
+  static constexpr std::size_t NUM_WORDS = MAX_SIZE / sizeof(uint64_t);
+
+  std::array<uint64_t, NUM_WORDS> words_{};
+  uint8_t                         size_{0};
+};
+
+struct DigestKeyHashAdapter
+{
+  std::size_t operator()(DigestKey const &key) const noexcept
+  {
+    return key.hash();
+  }
+};
+
+template <typename Value>
+using DigestKeyMap = std::unordered_map<DigestKey, Value, DigestKeyHashAdapter>;
+
 }  // namespace fetch
@@ -0,0 +1,38 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace fetch {
+namespace core {
+
+using MappedMemory = std::shared_ptr<uint8_t>;
+
+enum class MapMode
+{
+  PRIVATE,  ///< Writes are copy on write and never reach the file
+  SHARED    ///< Writes reach the file and are visible to every other mapping of it
+};
+
+MappedMemory MapFile(int fd, std::size_t length, MapMode mode);
+
+}  // namespace core
+}  // namespace fetch
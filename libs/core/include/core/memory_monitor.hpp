@@ -0,0 +1,101 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "core/periodic_runnable.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Periodically accounts for the memory held by the subsystems of a process.
+ *
+ * Each subsystem registers a function reporting the approximate number of bytes that it holds,
+ * together with an optional limit and the function which trims it. The usage and limit of every
+ * subsystem are exported as telemetry, labelled with the name of the subsystem, and a subsystem
+ * found over its limit is trimmed. The resident size of the process and the state of the heap are
+ * also exported, so that the memory not accounted for by any subsystem can be seen.
+ */
+class MemoryMonitor : public PeriodicRunnable
+{
+public:
+  using UsageFunction = std::function<std::size_t()>;
+  using TrimFunction  = std::function<void()>;
+
+  static constexpr char const *LOGGING_NAME = "MemoryMonitor";
+  static constexpr std::size_t NO_LIMIT     = 0;
+
+  // Construction / Destruction
+  explicit MemoryMonitor(Duration const &period = std::chrono::seconds{10});
+  MemoryMonitor(MemoryMonitor const &) = delete;
+  MemoryMonitor(MemoryMonitor &&)      = delete;
+  ~MemoryMonitor() override            = default;
+
+  /// @name Subsystems
+  /// @{
+  void        AddSubsystem(std::string const &name, UsageFunction usage,
+                           std::size_t limit = NO_LIMIT, TrimFunction trim = TrimFunction{});
+  std::size_t GetUsage(std::string const &name) const;
+  /// @}
+
+  /// @name Periodic Runnable Interface
+  /// @{
+  void Periodically() override;
+  /// @}
+
+  // Operators
+  MemoryMonitor &operator=(MemoryMonitor const &) = delete;
+  MemoryMonitor &operator=(MemoryMonitor &&) = delete;
+
+private:
+  struct Subsystem
+  {
+    UsageFunction usage_function;
+    TrimFunction  trim_function;
+    std::size_t   limit{NO_LIMIT};
+    std::size_t   usage{0};
+
+    telemetry::GaugePtr<uint64_t> usage_gauge;
+    telemetry::GaugePtr<uint64_t> limit_gauge;
+    telemetry::CounterPtr         trims_total;
+  };
+
+  using Subsystems = std::map<std::string, Subsystem>;
+
+  void UpdateProcessStatistics(std::size_t accounted);
+
+  mutable Mutex lock_;
+  Subsystems    subsystems_{};
+
+  telemetry::GaugePtr<uint64_t> resident_gauge_;
+  telemetry::GaugePtr<uint64_t> unaccounted_gauge_;
+  telemetry::GaugePtr<uint64_t> heap_allocated_gauge_;
+  telemetry::GaugePtr<uint64_t> heap_free_gauge_;
+  telemetry::GaugePtr<double>   heap_fragmentation_gauge_;
+};
+
+}  // namespace core
+}  // namespace fetch
@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
@@ -62,6 +63,81 @@ public:
     return static_cast<double>(this->operator()()) * inv_double_max_;
   }
 
+  /**
+   * Fill an array with random values. The values are the same as those which would be produced by
+   * calling the generator count times, but the generator is stepped in independent lanes (each one
+   * jumping ahead by the number of lanes) so that the multiplications can be overlapped.
+   *
+   * @param values The array to be filled
+   * @param count The number of values to generate
+   */
+  void Fill(RandomType *values, std::size_t count) noexcept
+  {
+    std::size_t i = 0;
+
+    if (count >= LANES)
+    {
+      // x(n + LANES) = a^LANES * x(n) + c * (a^(LANES - 1) + ... + a + 1)
+      RandomType lane_a = 1;
+      RandomType lane_c = 0;
+      for (std::size_t k = 0; k < LANES; ++k)
+      {
+        lane_c += lane_a;
+        lane_a *= a_;
+      }
+      lane_c *= c_;
+
+      RandomType lanes[LANES];
+      lanes[0] = x_ * a_ + c_;
+      for (std::size_t k = 1; k < LANES; ++k)
+      {
+        lanes[k] = lanes[k - 1] * a_ + c_;
+      }
+
+      for (; (i + LANES) <= count; i += LANES)
+      {
+        for (std::size_t k = 0; k < LANES; ++k)
+        {
+          values[i + k] = lanes[k];
+          lanes[k]      = lanes[k] * lane_a + lane_c;
+        }
+      }
+
+      x_ = values[i - 1];
+    }
+
+    for (; i < count; ++i)
+    {
+      values[i] = this->operator()();
+    }
+  }
+
+  /**
+   * Fill an array with random values between 0.0 and 1.0, the same values as would be produced
+   * by calling AsDouble count times
+   *
+   * @param values The array to be filled
+   * @param count The number of values to generate
+   */
+  void Fill(double *values, std::size_t count) noexcept
+  {
+    RandomType batch[BATCH_SIZE];
+
+    while (count > 0)
+    {
+      std::size_t const n = (count < BATCH_SIZE) ? count : BATCH_SIZE;
+
+      Fill(batch, n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        values[i] = static_cast<double>(batch[i]) * inv_double_max_;
+      }
+
+      values += n;
+      count -= n;
+    }
+  }
+
   static constexpr RandomType max() noexcept
   {
     return std::numeric_limits<RandomType>::max();
@@ -73,6 +149,9 @@ public:
   }
 
 private:
+  static constexpr std::size_t LANES      = 4;
+  static constexpr std::size_t BATCH_SIZE = 256;
+
   RandomType x_    = 1;
   RandomType seed_ = 1;
   RandomType a_    = 6364136223846793005ull;
@@ -23,6 +23,8 @@
 #include "vectorise/fixed_point/fixed_point.hpp"
 #include "vectorise/fixed_point/type_traits.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <vector>
@@ -119,6 +121,63 @@ public:
     return AsType<double>();
   }
 
+  /**
+   * Fill an array with random values, the same values as would be produced by calling the
+   * generator count times. The values are copied from the buffer in blocks rather than one by one.
+   *
+   * @param values The array to be filled
+   * @param count The number of values to generate
+   */
+  void Fill(RandomType *values, std::size_t count) noexcept
+  {
+    while (count > 0)
+    {
+      if (index_ == (Q - 1))
+      {
+        FillBuffer();
+      }
+
+      std::size_t const n     = std::min<std::size_t>(count, (Q - 1) - index_);
+      RandomType const *first = buffer_ + index_ + 1;
+
+      std::copy(first, first + n, values);
+
+      index_ += n;
+      values += n;
+      count -= n;
+    }
+  }
+
+  /**
+   * Fill an array with random values between 0.0 and 1.0, the same values as would be produced
+   * by calling AsDouble count times
+   *
+   * @param values The array to be filled
+   * @param count The number of values to generate
+   */
+  void Fill(double *values, std::size_t count) noexcept
+  {
+    while (count > 0)
+    {
+      if (index_ == (Q - 1))
+      {
+        FillBuffer();
+      }
+
+      std::size_t const n     = std::min<std::size_t>(count, (Q - 1) - index_);
+      RandomType const *first = buffer_ + index_ + 1;
+
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        values[i] = static_cast<double>(first[i]) * inv_double_max_;
+      }
+
+      index_ += n;
+      values += n;
+      count -= n;
+    }
+  }
+
   static constexpr RandomType min() noexcept
   {
     return static_cast<RandomType>(0);
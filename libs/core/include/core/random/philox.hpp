@@ -0,0 +1,371 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace random {
+
+/**
+ * The Philox4x32-10 counter based generator (Salmon et al., "Parallel Random Numbers: As Easy as
+ * 1, 2, 3"). Each value is a function of the key (the seed), the stream and the position of the
+ * value within the stream alone. Streams can therefore be handed out to threads, and any position
+ * of a stream can be jumped to, while still generating exactly the same values.
+ *
+ * Every block of the generator yields two values. Bulk generation evaluates several blocks at once
+ * with their state laid out lane by lane, using AVX2 when the build enables it.
+ */
+class Philox4x32
+{
+public:
+  using RandomType = uint64_t;
+  using Block      = std::array<uint32_t, 4>;
+  using Key        = std::array<uint32_t, 2>;
+
+  // Note, breaking naming convention for STL compatibility
+  using result_type = RandomType;
+
+  explicit Philox4x32(RandomType seed = 42, RandomType stream = 0) noexcept
+    : stream_{stream}
+  {
+    Seed(seed);
+  }
+
+  RandomType Seed() const noexcept
+  {
+    return seed_;
+  }
+
+  /**
+   * Seed the generator, returning to the start of the stream
+   *
+   * @param s The seed
+   * @return The seed
+   */
+  RandomType Seed(RandomType const &s) noexcept
+  {
+    seed_ = s;
+    key_  = {{static_cast<uint32_t>(s), static_cast<uint32_t>(s >> 32u)}};
+
+    Seek(0);
+
+    return seed_;
+  }
+
+  RandomType Stream() const noexcept
+  {
+    return stream_;
+  }
+
+  void Reset() noexcept
+  {
+    Seed(Seed());
+  }
+
+  RandomType operator()() noexcept
+  {
+    if (next_ == VALUES_PER_BLOCK)
+    {
+      Refill();
+    }
+
+    return buffer_[next_++];
+  }
+
+  /**
+   * @return uniformly distributed random value in the range [0.0, 1.0)
+   */
+  double AsDouble() noexcept
+  {
+    return ToDouble(this->operator()());
+  }
+
+  /**
+   * Fill an array with random values, the same values as would be produced by calling the
+   * generator count times
+   *
+   * @param values The array to be filled
+   * @param count The number of values to generate
+   */
+  void Fill(RandomType *values, std::size_t count) noexcept
+  {
+    // use up the rest of the current block
+    while ((count > 0) && (next_ < VALUES_PER_BLOCK))
+    {
+      *values++ = buffer_[next_++];
+      --count;
+    }
+
+    // evaluate whole groups of blocks with the lanes side by side
+    for (; count >= (LANES * VALUES_PER_BLOCK); count -= (LANES * VALUES_PER_BLOCK))
+    {
+      Lanes c0;
+      Lanes c1;
+      Lanes c2;
+      Lanes c3;
+
+      for (std::size_t l = 0; l < LANES; ++l)
+      {
+        uint64_t const block = block_ + l;
+
+        c0[l] = static_cast<uint32_t>(block);
+        c1[l] = static_cast<uint32_t>(block >> 32u);
+        c2[l] = static_cast<uint32_t>(stream_);
+        c3[l] = static_cast<uint32_t>(stream_ >> 32u);
+      }
+
+      GenerateLanes(c0, c1, c2, c3, key_);
+
+      for (std::size_t l = 0; l < LANES; ++l)
+      {
+        values[(2 * l)]     = c0[l] | (uint64_t{c1[l]} << 32u);
+        values[(2 * l) + 1] = c2[l] | (uint64_t{c3[l]} << 32u);
+      }
+
+      values += LANES * VALUES_PER_BLOCK;
+      block_ += LANES;
+    }
+
+    for (; count > 0; --count)
+    {
+      *values++ = this->operator()();
+    }
+  }
+
+  /**
+   * Fill an array with random values in the range [0.0, 1.0), the same values as would be
+   * produced by calling AsDouble count times
+   *
+   * @param values The array to be filled
+   * @param count The number of values to generate
+   */
+  void Fill(double *values, std::size_t count) noexcept
+  {
+    RandomType batch[BATCH_SIZE];
+
+    while (count > 0)
+    {
+      std::size_t const n = (count < BATCH_SIZE) ? count : BATCH_SIZE;
+
+      Fill(batch, n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        values[i] = ToDouble(batch[i]);
+      }
+
+      values += n;
+      count -= n;
+    }
+  }
+
+  /**
+   * Move to a position in the stream, so that the next value generated is the value at that
+   * position
+   *
+   * @param position The index of the value within the stream
+   */
+  void Seek(uint64_t position) noexcept
+  {
+    block_ = position / VALUES_PER_BLOCK;
+    next_  = VALUES_PER_BLOCK;
+
+    if ((position % VALUES_PER_BLOCK) != 0)
+    {
+      Refill();
+      next_ = position % VALUES_PER_BLOCK;
+    }
+  }
+
+  /**
+   * @return The index within the stream of the next value to be generated
+   */
+  uint64_t Position() const noexcept
+  {
+    return (block_ * VALUES_PER_BLOCK) - (VALUES_PER_BLOCK - next_);
+  }
+
+  /**
+   * Create the generator for another stream with the same seed, starting from its beginning
+   *
+   * @param stream The stream
+   * @return The generator for the stream
+   */
+  Philox4x32 Split(RandomType stream) const noexcept
+  {
+    return Philox4x32{seed_, stream};
+  }
+
+  /**
+   * Evaluate a single block of the generator
+   *
+   * @param counter The counter of the block
+   * @param key The key
+   * @return The output block
+   */
+  static Block Generate(Block counter, Key key) noexcept
+  {
+    for (std::size_t round = 0; round < ROUNDS; ++round)
+    {
+      uint64_t const p0 = uint64_t{M0} * counter[0];
+      uint64_t const p1 = uint64_t{M1} * counter[2];
+
+      counter = {{static_cast<uint32_t>(p1 >> 32u) ^ counter[1] ^ key[0],
+                  static_cast<uint32_t>(p1),
+                  static_cast<uint32_t>(p0 >> 32u) ^ counter[3] ^ key[1],
+                  static_cast<uint32_t>(p0)}};
+
+      key[0] += W0;
+      key[1] += W1;
+    }
+
+    return counter;
+  }
+
+  static constexpr RandomType min() noexcept
+  {
+    return std::numeric_limits<RandomType>::min();
+  }
+
+  static constexpr RandomType max() noexcept
+  {
+    return std::numeric_limits<RandomType>::max();
+  }
+
+private:
+  static constexpr std::size_t ROUNDS           = 10;
+  static constexpr std::size_t LANES            = 8;
+  static constexpr std::size_t VALUES_PER_BLOCK = 2;
+  static constexpr std::size_t BATCH_SIZE       = 256;
+  static constexpr uint32_t    M0               = 0xD2511F53u;
+  static constexpr uint32_t    M1               = 0xCD9E8D57u;
+  static constexpr uint32_t    W0               = 0x9E3779B9u;
+  static constexpr uint32_t    W1               = 0xBB67AE85u;
+
+  using Lanes = uint32_t[LANES];
+
+  /**
+   * Evaluate a group of blocks, with each word of the blocks laid out lane by lane
+   *
+   * @param c0 The first words of the counters, replaced by the first words of the output
+   * @param c1 The second words of the counters, replaced by the second words of the output
+   * @param c2 The third words of the counters, replaced by the third words of the output
+   * @param c3 The fourth words of the counters, replaced by the fourth words of the output
+   * @param key The key
+   */
+  static void GenerateLanes(Lanes &c0, Lanes &c1, Lanes &c2, Lanes &c3, Key key) noexcept
+  {
+#ifdef __AVX2__
+    static_assert(LANES == 8, "The AVX2 rounds evaluate eight blocks at a time");
+
+    // the 32 bit products are formed for the even and odd lanes separately, and the low and high
+    // halves of the products are then recombined lane by lane
+    auto const multiply = [](__m256i x, __m256i m, __m256i &lo, __m256i &hi) {
+      __m256i const even = _mm256_mul_epu32(x, m);
+      __m256i const odd  = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), m);
+
+      lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+      hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    };
+
+    __m256i const m0 = _mm256_set1_epi32(static_cast<int>(M0));
+    __m256i const m1 = _mm256_set1_epi32(static_cast<int>(M1));
+
+    __m256i x0 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(c0));
+    __m256i x1 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(c1));
+    __m256i x2 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(c2));
+    __m256i x3 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(c3));
+
+    for (std::size_t round = 0; round < ROUNDS; ++round)
+    {
+      __m256i lo0;
+      __m256i hi0;
+      __m256i lo1;
+      __m256i hi1;
+      multiply(x0, m0, lo0, hi0);
+      multiply(x2, m1, lo1, hi1);
+
+      x0 = _mm256_xor_si256(_mm256_xor_si256(hi1, x1), _mm256_set1_epi32(static_cast<int>(key[0])));
+      x1 = lo1;
+      x2 = _mm256_xor_si256(_mm256_xor_si256(hi0, x3), _mm256_set1_epi32(static_cast<int>(key[1])));
+      x3 = lo0;
+
+      key[0] += W0;
+      key[1] += W1;
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(c0), x0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(c1), x1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(c2), x2);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(c3), x3);
+#else
+    for (std::size_t round = 0; round < ROUNDS; ++round)
+    {
+      for (std::size_t l = 0; l < LANES; ++l)
+      {
+        uint64_t const p0 = uint64_t{M0} * c0[l];
+        uint64_t const p1 = uint64_t{M1} * c2[l];
+
+        c0[l] = static_cast<uint32_t>(p1 >> 32u) ^ c1[l] ^ key[0];
+        c1[l] = static_cast<uint32_t>(p1);
+        c2[l] = static_cast<uint32_t>(p0 >> 32u) ^ c3[l] ^ key[1];
+        c3[l] = static_cast<uint32_t>(p0);
+      }
+
+      key[0] += W0;
+      key[1] += W1;
+    }
+#endif
+  }
+
+  void Refill() noexcept
+  {
+    Block const counter{{static_cast<uint32_t>(block_), static_cast<uint32_t>(block_ >> 32u),
+                         static_cast<uint32_t>(stream_), static_cast<uint32_t>(stream_ >> 32u)}};
+    Block const output = Generate(counter, key_);
+
+    buffer_[0] = output[0] | (uint64_t{output[1]} << 32u);
+    buffer_[1] = output[2] | (uint64_t{output[3]} << 32u);
+
+    ++block_;
+    next_ = 0;
+  }
+
+  static constexpr double ToDouble(RandomType x) noexcept
+  {
+    // the upper 53 bits fill the mantissa of the double
+    return static_cast<double>(x >> 11u) * (1.0 / static_cast<double>(RandomType{1} << 53u));
+  }
+
+  RandomType  seed_{0};
+  RandomType  stream_{0};
+  Key         key_{};
+  uint64_t    block_{0};  ///< The counter of the next block to be evaluated
+  RandomType  buffer_[VALUES_PER_BLOCK]{};
+  std::size_t next_{VALUES_PER_BLOCK};  ///< The index of the next value in the buffer
+};
+
+}  // namespace random
+}  // namespace fetch
@@ -0,0 +1,242 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace fetch {
+namespace random {
+
+/**
+ * The xoshiro256** generator (Blackman and Vigna). It has a period of 2^256 - 1 and supports
+ * jumping ahead by 2^128 values, which splits a seed into non-overlapping streams, for example one
+ * for each thread of a parallel computation, deterministically.
+ */
+class Xoshiro256StarStar
+{
+public:
+  using RandomType = uint64_t;
+
+  // Note, breaking naming convention for STL compatibility
+  using result_type = RandomType;
+
+  explicit Xoshiro256StarStar(RandomType seed = 42) noexcept
+  {
+    Seed(seed);
+  }
+
+  RandomType Seed() const noexcept
+  {
+    return seed_;
+  }
+
+  /**
+   * Seed the generator, the state being expanded from the seed with splitmix64
+   *
+   * @param s The seed
+   * @return The seed
+   */
+  RandomType Seed(RandomType const &s) noexcept
+  {
+    seed_ = s;
+
+    RandomType x = s;
+    for (auto &word : state_)
+    {
+      x += 0x9e3779b97f4a7c15ull;
+
+      RandomType z = x;
+      z            = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ull;
+      z            = (z ^ (z >> 27u)) * 0x94d049bb133111ebull;
+      word         = z ^ (z >> 31u);
+    }
+
+    return seed_;
+  }
+
+  void Reset() noexcept
+  {
+    Seed(Seed());
+  }
+
+  RandomType operator()() noexcept
+  {
+    RandomType const result = RotateLeft(state_[1] * 5u, 7u) * 9u;
+    RandomType const t      = state_[1] << 17u;
+
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = RotateLeft(state_[3], 45u);
+
+    return result;
+  }
+
+  /**
+   * @return uniformly distributed random value in the range [0.0, 1.0)
+   */
+  double AsDouble() noexcept
+  {
+    return ToDouble(this->operator()());
+  }
+
+  /**
+   * Fill an array with random values, the same values as would be produced by calling the
+   * generator count times
+   *
+   * @param values The array to be filled
+   * @param count The number of values to generate
+   */
+  void Fill(RandomType *values, std::size_t count) noexcept
+  {
+    // working on a local copy of the state allows it to be held in registers
+    RandomType s0 = state_[0];
+    RandomType s1 = state_[1];
+    RandomType s2 = state_[2];
+    RandomType s3 = state_[3];
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      values[i] = RotateLeft(s1 * 5u, 7u) * 9u;
+
+      RandomType const t = s1 << 17u;
+
+      s2 ^= s0;
+      s3 ^= s1;
+      s1 ^= s2;
+      s0 ^= s3;
+      s2 ^= t;
+      s3 = RotateLeft(s3, 45u);
+    }
+
+    state_[0] = s0;
+    state_[1] = s1;
+    state_[2] = s2;
+    state_[3] = s3;
+  }
+
+  /**
+   * Fill an array with random values in the range [0.0, 1.0), the same values as would be
+   * produced by calling AsDouble count times
+   *
+   * @param values The array to be filled
+   * @param count The number of values to generate
+   */
+  void Fill(double *values, std::size_t count) noexcept
+  {
+    RandomType batch[BATCH_SIZE];
+
+    while (count > 0)
+    {
+      std::size_t const n = (count < BATCH_SIZE) ? count : BATCH_SIZE;
+
+      Fill(batch, n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        values[i] = ToDouble(batch[i]);
+      }
+
+      values += n;
+      count -= n;
+    }
+  }
+
+  /**
+   * Advance the generator by 2^128 values
+   */
+  void Jump() noexcept
+  {
+    static constexpr RandomType JUMP[] = {0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+                                          0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+
+    RandomType jumped[4] = {0, 0, 0, 0};
+    for (RandomType word : JUMP)
+    {
+      for (uint32_t bit = 0; bit < 64u; ++bit)
+      {
+        if ((word & (RandomType{1} << bit)) != 0)
+        {
+          for (std::size_t i = 0; i < 4; ++i)
+          {
+            jumped[i] ^= state_[i];
+          }
+        }
+
+        this->operator()();
+      }
+    }
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+      state_[i] = jumped[i];
+    }
+  }
+
+  /**
+   * Create the generator for one of the streams of this generator. Stream 0 is this generator and
+   * each subsequent stream begins 2^128 values after the previous one, so the streams never
+   * overlap in practice.
+   *
+   * @param stream The index of the stream
+   * @return The generator for the stream
+   */
+  Xoshiro256StarStar Split(std::size_t stream) const noexcept
+  {
+    Xoshiro256StarStar generator{*this};
+    for (std::size_t i = 0; i < stream; ++i)
+    {
+      generator.Jump();
+    }
+
+    return generator;
+  }
+
+  static constexpr RandomType min() noexcept
+  {
+    return std::numeric_limits<RandomType>::min();
+  }
+
+  static constexpr RandomType max() noexcept
+  {
+    return std::numeric_limits<RandomType>::max();
+  }
+
+private:
+  static constexpr std::size_t BATCH_SIZE = 256;
+
+  static constexpr RandomType RotateLeft(RandomType x, uint32_t k) noexcept
+  {
+    return (x << k) | (x >> (64u - k));
+  }
+
+  static constexpr double ToDouble(RandomType x) noexcept
+  {
+    // the upper 53 bits fill the mantissa of the double
+    return static_cast<double>(x >> 11u) * (1.0 / static_cast<double>(RandomType{1} << 53u));
+  }
+
+  RandomType seed_{0};
+  RandomType state_[4]{};
+};
+
+}  // namespace random
+}  // namespace fetch
@@ -17,58 +17,101 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/cpu_topology.hpp"
 #include "core/runnable.hpp"
 #include "core/synchronisation/protected.hpp"
+#include "core/synchronisation/waitable.hpp"
 #include "telemetry/telemetry.hpp"
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace fetch {
 namespace core {
 
+/**
+ * The reactor executes a set of runnables whenever they report that they are ready to execute.
+ *
+ * Runnables are shared between `num_threads` worker threads (one by default). A runnable is never
+ * executed by two threads at the same time, but with more than one worker thread, different
+ * runnables may execute concurrently. Runnables attached with `AttachDedicated` are instead
+ * serviced by a thread of their own, so a slow runnable on the shared workers can never delay
+ * them.
+ *
+ * Idle workers sleep until either `Wake` is called, signalling that a runnable might have become
+ * ready, or the poll interval elapses (for runnables whose readiness depends on time).
+ */
 class Reactor
 {
 public:
   // Construction / Destruction
-  explicit Reactor(std::string name);
+  explicit Reactor(std::string name, std::size_t num_threads = 1);
   Reactor(Reactor const &) = delete;
   Reactor(Reactor &&)      = delete;
   ~Reactor();
 
   bool Attach(WeakRunnable runnable);   // NOLINT
   bool Attach(WeakRunnables runnable);  // NOLINT
+  bool AttachDedicated(WeakRunnable runnable);
   bool Detach(Runnable const &runnable);
 
   void Start();
   void Stop();
+  void Wake();
+
+  void SetAffinity(CpuList cpus);
 
   // Operators
   Reactor &operator=(Reactor const &) = delete;
   Reactor &operator=(Reactor &&) = delete;
 
 private:
-  using RunnableMap     = Protected<std::map<Runnable const *, WeakRunnable>>;
-  using Flag            = std::atomic<bool>;
-  using ProtectedThread = Protected<std::thread>;
-  using ThreadPtr       = std::unique_ptr<ProtectedThread>;
+  struct Entry
+  {
+    WeakRunnable            runnable;
+    telemetry::HistogramPtr execution_time;    ///< Execution time of this runnable
+    bool                    dedicated{false};  ///< Serviced by its own thread
+    bool                    executing{false};  ///< Currently claimed by a worker
+  };
+
+  using RunnableMap = Protected<std::map<Runnable const *, Entry>>;
+  using Flag        = std::atomic<bool>;
+  using Counter     = std::atomic<uint64_t>;
+  using Threads     = Protected<std::vector<std::thread>>;
+  using Generation  = uint64_t;
+
+  bool Insert(WeakRunnable const &runnable, bool dedicated);
 
   void StartWorker();
+  void StartDedicatedWorker(std::vector<std::thread> &workers, Runnable const *key);
   void StopWorker();
-  void Monitor();
+  void Monitor(Runnable const *dedicated);
+
+  RunnablePtr Claim(Runnable const *&cursor, Runnable const *dedicated,
+                    telemetry::HistogramPtr &execution_time, bool &attached);
+  void        Release(Runnable const *key);
+  void        Execute(Runnable &runnable, telemetry::Histogram &execution_time);
 
+  telemetry::HistogramPtr       CreateRunnableHistogram(Runnable const &runnable) const;
   telemetry::HistogramPtr       CreateHistogram(char const *name, char const *description) const;
   telemetry::CounterPtr         CreateCounter(char const *name, char const *description) const;
   telemetry::GaugePtr<uint64_t> CreateGauge(char const *name, char const *description) const;
 
   std::string const name_;
+  std::size_t const num_threads_;
   Flag              running_{false};
+  CpuList           affinity_{};  ///< The CPUs the workers are restricted to (empty for any)
 
-  RunnableMap work_map_{};
-  ThreadPtr   worker_{};
+  RunnableMap          work_map_{};
+  Threads              workers_{};
+  Waitable<Generation> wake_generation_{0u};  ///< Advanced whenever a runnable might be ready
+  Counter              num_executing_{0};      ///< The number of runnables currently executing
 
   // telemetry
   telemetry::HistogramPtr       runnables_time_;
@@ -555,7 +555,12 @@ public:
       size = static_cast<uint32_t>(opcode & TypeCodes::FIXED_VAL_MASK2);
     }
 
-    byte_array::ByteArray arr;
+    // only mutable arrays are read as such, everything else is converted from a shared view
+    using ArrayType =
+        typename std::conditional<std::is_same<Type, byte_array::ByteArray>::value,
+                                  byte_array::ByteArray, byte_array::ConstByteArray>::type;
+
+    ArrayType arr;
     interface.ReadByteArray(arr, size);
     val = static_cast<Type>(arr);
   }
@@ -662,7 +667,9 @@ public:
     {
       V v;
       array.GetNextValue(v);
-      output.insert(std::move(v));
+
+      // elements are serialised in order so each one belongs at the end
+      output.emplace_hint(output.end(), std::move(v));
     }
   }
 };
@@ -690,6 +697,7 @@ public:
   static void Deserialize(ArrayDeserializer &array, Type &output)
   {
     output.clear();
+    output.reserve(array.size());
     for (uint32_t i = 0; i < array.size(); ++i)
     {
       V v;
@@ -754,12 +762,13 @@ public:
   static void Deserialize(MapDeserializer &map, Type &output)
   {
     output.clear();
+    output.reserve(map.size());
     for (uint64_t i = 0; i < map.size(); ++i)
     {
       K key;
       V value;
       map.GetNextKeyPair(key, value);
-      output.insert({key, value});
+      output.emplace(std::move(key), std::move(value));
     }
   }
 };
@@ -790,7 +799,9 @@ public:
       K key;
       V value;
       map.GetNextKeyPair(key, value);
-      output.insert({key, value});
+
+      // entries are serialised in key order so each one belongs at the end
+      output.emplace_hint(output.end(), std::move(key), std::move(value));
     }
   }
 };
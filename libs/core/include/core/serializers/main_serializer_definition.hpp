@@ -78,6 +78,18 @@ public:
   explicit MsgPackSerializer(byte_array::ByteArray s);
   MsgPackSerializer(MsgPackSerializer const &from);
 
+  /**
+   * @brief Create a read only serializer over an existing buffer without copying it.
+   *
+   * Byte arrays and strings deserialised as @ref ConstByteArray are views sharing the memory of
+   * the buffer, so decoding does not allocate per field. Such views keep the whole buffer alive
+   * for as long as they are held. Any attempt to write to the serializer throws.
+   *
+   * @param data The encoded buffer to be read
+   * @return The read only serializer
+   */
+  static MsgPackSerializer Borrow(byte_array::ConstByteArray const &data);
+
   MsgPackSerializer &operator=(MsgPackSerializer const &from);
 
   SerializerTypes GetNextType() const
@@ -115,6 +127,7 @@ public:
   void ReadBytes(uint8_t *arr, uint64_t const &size);
 
   void ReadByteArray(byte_array::ConstByteArray &b, uint64_t const &size);
+  void ReadByteArray(byte_array::ByteArray &b, uint64_t const &size);
   void SkipBytes(uint64_t const &size);
 
   template <typename T>
@@ -206,9 +219,12 @@ private:
   void AppendInternal(T const &arg, ARGS const &... args);
   void AppendInternal();
 
+  void EnsureWritable() const;
+
   ByteArray   data_;
   uint64_t    pos_ = 0;
   SizeCounter size_counter_;
+  bool        read_only_{false};  ///< Set when data_ is borrowed from the caller
 };
 
 }  // namespace serializers
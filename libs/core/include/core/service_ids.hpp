@@ -50,7 +50,8 @@ static constexpr uint16_t CHANNEL_ANNOUNCEMENT = 257;
 // P2P Service Channels
 
 // Main Chain Service Channels
-static constexpr uint16_t CHANNEL_BLOCKS = 2;
+static constexpr uint16_t CHANNEL_BLOCKS         = 2;
+static constexpr uint16_t CHANNEL_COMPACT_BLOCKS = 3;
 
 // DAG Service Channels
 static constexpr uint16_t CHANNEL_NODES         = 300;
@@ -64,8 +65,9 @@ static constexpr uint16_t CHANNEL_CONNECTIONS_SETUP = 403;
 
 static constexpr uint16_t CHANNEL_ID_DISTRIBUTION = 450;
 
-static constexpr uint64_t CHANNEL_MESSENGER_MESSAGE   = 600;
-static constexpr uint64_t CHANNEL_MESSENGER_TRANSPORT = 601;
+static constexpr uint64_t CHANNEL_MESSENGER_MESSAGE         = 600;
+static constexpr uint64_t CHANNEL_MESSENGER_TRANSPORT       = 601;
+static constexpr uint64_t CHANNEL_MESSENGER_TRANSPORT_BATCH = 602;
 
 static constexpr uint16_t CHANNEL_COLEARN_BROADCAST = 501;
 
@@ -87,6 +89,7 @@ static constexpr uint64_t RPC_P2P_RESOLVER      = 209;
 static constexpr uint64_t RPC_MISSING_TX_FINDER = 210;
 static constexpr uint64_t RPC_DAG_STORE_SYNC    = 211;
 static constexpr uint64_t RPC_DKG_BEACON        = 212;
+static constexpr uint64_t RPC_STATE_SNAPSHOT    = 213;
 
 static constexpr uint64_t RPC_BEACON_SETUP = 250;
 static constexpr uint64_t RPC_BEACON       = 251;
@@ -101,6 +101,7 @@ public:
 
   template <typename R, typename P>
   void Delay(std::chrono::duration<R, P> const &delay);
+  void Trigger();
 
   // Operators
   StateMachine &operator=(StateMachine const &) = delete;
@@ -127,7 +128,8 @@ private:
   ProtectedCallbackMap          callbacks_{};
   std::atomic<State>            current_state_;
   std::atomic<State>            previous_state_{current_state_.load()};
-  Timepoint                     next_execution_{};
+  std::atomic<Timepoint>        next_execution_{Timepoint{}};
+  std::atomic<bool>             triggered_{false};
   ProtectedStateChangeCallback  state_change_callback_{};
   telemetry::GaugePtr<uint64_t> state_gauge_;
 };
@@ -303,9 +305,10 @@ bool StateMachine<S>::IsReadyToExecute() const
 {
   bool ready{true};
 
-  if (next_execution_.time_since_epoch().count())
+  Timepoint const next_execution = next_execution_;
+  if (next_execution.time_since_epoch().count())
   {
-    ready = (Clock::now() >= next_execution_);
+    ready = (Clock::now() >= next_execution);
   }
 
   return ready;
@@ -324,6 +327,9 @@ void StateMachine<S>::Execute()
     auto it = callbacks.find(current_state_);
     if (it != callbacks.end())
     {
+      // any triggers from this point onwards must override delays set by the handler
+      triggered_ = false;
+
       // execute the state handler
       S const next_state = it->second(current_state_, previous_state_);
 
@@ -361,7 +367,28 @@ template <typename S>
 template <typename R, typename P>
 void StateMachine<S>::Delay(std::chrono::duration<R, P> const &delay)
 {
-  next_execution_ = Clock::now() + delay;
+  next_execution_ = std::chrono::time_point_cast<Duration>(Clock::now() + delay);
+
+  // a trigger which has arrived during the execution of the handler takes precedence
+  if (triggered_)
+  {
+    next_execution_ = Timepoint{};
+  }
+}
+
+/**
+ * Cancel any pending delay so that the state machine is executed again as soon as possible, for
+ * example when the work that a state has been polling for has completed.
+ *
+ * Note: Unlike Delay, this function can be called from any thread
+ *
+ * @tparam S The type of the state
+ */
+template <typename S>
+void StateMachine<S>::Trigger()
+{
+  triggered_      = true;
+  next_execution_ = Timepoint{};
 }
 
 }  // namespace core
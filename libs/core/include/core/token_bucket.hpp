@@ -0,0 +1,61 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstddef>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Limits the rate of a stream of items. Tokens accumulate at a fixed rate up to a maximum burst,
+ * and each item admitted consumes a token.
+ *
+ * Not thread safe, callers are expected to provide their own locking when shared.
+ */
+class TokenBucket
+{
+public:
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+
+  // Construction / Destruction
+  TokenBucket(double rate, double burst, Timepoint const &now = Clock::now());
+  TokenBucket(TokenBucket const &) = default;
+  TokenBucket(TokenBucket &&)      = default;
+  ~TokenBucket()                   = default;
+
+  std::size_t Take(std::size_t count, Timepoint const &now = Clock::now());
+  double      available(Timepoint const &now = Clock::now());
+
+  // Operators
+  TokenBucket &operator=(TokenBucket const &) = default;
+  TokenBucket &operator=(TokenBucket &&) = default;
+
+private:
+  void Refill(Timepoint const &now);
+
+  double    rate_;   ///< Tokens added per second
+  double    burst_;  ///< The maximum number of tokens held
+  double    tokens_;
+  Timepoint last_refill_;
+};
+
+}  // namespace core
+}  // namespace fetch
@@ -71,7 +71,8 @@ bool BitVector::RemapTo(BitVector &dst) const
 {
   if (dst.size() == size())
   {
-    dst = *this;
+    // copy the bits, assignment alone would share them with the destination
+    dst = BitVector{*this};
     return true;
   }
   if (dst.size() > size())
@@ -420,6 +421,28 @@ std::size_t BitVector::PopCount() const
   return std::min(ret, size_);
 }
 
+/**
+ * Determine if any bit is set in both vectors. Unlike testing the result of operator&, this does
+ * not allocate and stops at the first common bit.
+ *
+ * @param other The other vector, of the same size
+ * @return true if the vectors have at least one bit in common, otherwise false
+ */
+bool BitVector::Intersects(BitVector const &other) const
+{
+  assert(size_ == other.size_);
+
+  for (std::size_t i = 0; i < blocks_; ++i)
+  {
+    if ((data_[i] & other.data_[i]) != 0)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 std::ostream &operator<<(std::ostream &s, BitVector const &b)
 {
 #if 1
@@ -0,0 +1,358 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/compression/lz4.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace fetch {
+namespace compression {
+namespace {
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+
+constexpr std::size_t MIN_MATCH      = 4;   ///< The minimum length of a match
+constexpr std::size_t LAST_LITERALS  = 5;   ///< The last bytes of a block are always literals
+constexpr std::size_t MATCH_LIMIT    = 12;  ///< The last match must start before this many bytes
+constexpr std::size_t MAX_OFFSET     = 0xFFFF;
+constexpr uint32_t    HASH_LOG       = 14;
+constexpr uint32_t    HASH_SIZE      = 1u << HASH_LOG;
+constexpr uint32_t    EMPTY_POSITION = 0xFFFFFFFFu;
+constexpr std::size_t SEGMENT_SIZE   = 16;  ///< The size of the segments used to train dictionaries
+constexpr std::size_t SEGMENT_STEP   = 4;
+
+uint32_t Read32(uint8_t const *data)
+{
+  uint32_t value{0};
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint32_t Hash(uint32_t sequence)
+{
+  return (sequence * 2654435761u) >> (32u - HASH_LOG);
+}
+
+/**
+ * Write an LZ4 length extension, a sequence of 255 bytes followed by the remainder
+ */
+void WriteLength(std::vector<uint8_t> &output, std::size_t length)
+{
+  while (length >= 255u)
+  {
+    output.push_back(255u);
+    length -= 255u;
+  }
+
+  output.push_back(static_cast<uint8_t>(length));
+}
+
+void WriteSequence(std::vector<uint8_t> &output, uint8_t const *literals, std::size_t num_literals,
+                   std::size_t offset, std::size_t match_length)
+{
+  std::size_t const literal_token = std::min<std::size_t>(num_literals, 15u);
+  std::size_t const match_token =
+      (match_length == 0) ? 0 : std::min<std::size_t>(match_length - MIN_MATCH, 15u);
+
+  output.push_back(static_cast<uint8_t>((literal_token << 4u) | match_token));
+
+  if (literal_token == 15u)
+  {
+    WriteLength(output, num_literals - 15u);
+  }
+
+  output.insert(output.end(), literals, literals + num_literals);
+
+  // the final sequence of the block only contains literals
+  if (match_length == 0)
+  {
+    return;
+  }
+
+  output.push_back(static_cast<uint8_t>(offset & 0xFFu));
+  output.push_back(static_cast<uint8_t>((offset >> 8u) & 0xFFu));
+
+  if (match_token == 15u)
+  {
+    WriteLength(output, match_length - MIN_MATCH - 15u);
+  }
+}
+
+/**
+ * Read an LZ4 length extension
+ *
+ * @return true if successful, otherwise false if the input was exhausted
+ */
+bool ReadLength(uint8_t const *&ip, uint8_t const *end, std::size_t &length)
+{
+  for (;;)
+  {
+    if (ip >= end)
+    {
+      return false;
+    }
+
+    uint8_t const value = *ip++;
+    length += value;
+
+    if (value != 255u)
+    {
+      return true;
+    }
+  }
+}
+
+}  // namespace
+
+ConstByteArray LZ4Compress(ConstByteArray const &input, ConstByteArray const &dictionary)
+{
+  // matches are allowed to refer back into the dictionary, so it is treated as a prefix
+  std::size_t const dict_size = std::min(dictionary.size(), LZ4_MAX_DICTIONARY_SIZE);
+  std::size_t const end       = dict_size + input.size();
+
+  std::vector<uint8_t> buffer(end);
+  if (dict_size != 0)
+  {
+    std::memcpy(buffer.data(), dictionary.pointer() + (dictionary.size() - dict_size), dict_size);
+  }
+
+  if (!input.empty())
+  {
+    std::memcpy(buffer.data() + dict_size, input.pointer(), input.size());
+  }
+
+  uint8_t const *const base = buffer.data();
+
+  std::vector<uint8_t> output{};
+  output.reserve(input.size() + (input.size() / 255u) + 16u);
+
+  std::size_t anchor = dict_size;
+
+  if (input.size() > MATCH_LIMIT)
+  {
+    std::vector<uint32_t> table(HASH_SIZE, EMPTY_POSITION);
+
+    // index the dictionary
+    for (std::size_t pos = 0; (pos + MIN_MATCH) <= dict_size; ++pos)
+    {
+      table[Hash(Read32(base + pos))] = static_cast<uint32_t>(pos);
+    }
+
+    std::size_t const match_start_limit = end - MATCH_LIMIT;
+    std::size_t const match_end_limit   = end - LAST_LITERALS;
+
+    std::size_t pos = dict_size;
+    while (pos < match_start_limit)
+    {
+      uint32_t const sequence  = Read32(base + pos);
+      uint32_t const hash      = Hash(sequence);
+      uint32_t const candidate = table[hash];
+      table[hash]              = static_cast<uint32_t>(pos);
+
+      bool const is_match = (candidate != EMPTY_POSITION) && ((pos - candidate) <= MAX_OFFSET) &&
+                            (Read32(base + candidate) == sequence);
+
+      if (!is_match)
+      {
+        ++pos;
+        continue;
+      }
+
+      // extend the match as far as possible
+      std::size_t length = MIN_MATCH;
+      while (((pos + length) < match_end_limit) && (base[candidate + length] == base[pos + length]))
+      {
+        ++length;
+      }
+
+      WriteSequence(output, base + anchor, pos - anchor, pos - candidate, length);
+
+      pos += length;
+      anchor = pos;
+
+      // index the position just before the end of the match to improve the next search
+      if ((pos - 2) >= dict_size && (pos - 2 + MIN_MATCH) <= end)
+      {
+        table[Hash(Read32(base + pos - 2))] = static_cast<uint32_t>(pos - 2);
+      }
+    }
+  }
+
+  // the remaining input is emitted as literals
+  WriteSequence(output, base + anchor, end - anchor, 0, 0);
+
+  ByteArray compressed{};
+  compressed.Resize(output.size());
+  std::memcpy(compressed.pointer(), output.data(), output.size());
+
+  return {compressed};
+}
+
+bool LZ4Decompress(ConstByteArray const &input, std::size_t decompressed_size, ByteArray &output,
+                   ConstByteArray const &dictionary)
+{
+  std::size_t const dict_size = std::min(dictionary.size(), LZ4_MAX_DICTIONARY_SIZE);
+  std::size_t const end       = dict_size + decompressed_size;
+
+  std::vector<uint8_t> buffer(end);
+  if (dict_size != 0)
+  {
+    std::memcpy(buffer.data(), dictionary.pointer() + (dictionary.size() - dict_size), dict_size);
+  }
+
+  uint8_t const *ip     = input.pointer();
+  uint8_t const *ip_end = ip + input.size();
+  std::size_t    pos    = dict_size;
+
+  for (;;)
+  {
+    if (ip >= ip_end)
+    {
+      return false;
+    }
+
+    uint8_t const token = *ip++;
+
+    // copy the literals
+    std::size_t num_literals = token >> 4u;
+    if ((num_literals == 15u) && !ReadLength(ip, ip_end, num_literals))
+    {
+      return false;
+    }
+
+    if ((num_literals > static_cast<std::size_t>(ip_end - ip)) || (num_literals > (end - pos)))
+    {
+      return false;
+    }
+
+    std::memcpy(buffer.data() + pos, ip, num_literals);
+    ip += num_literals;
+    pos += num_literals;
+
+    // the last sequence has no match
+    if (ip == ip_end)
+    {
+      break;
+    }
+
+    if ((ip_end - ip) < 2)
+    {
+      return false;
+    }
+
+    std::size_t const offset =
+        static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8u);
+    ip += 2;
+
+    if ((offset == 0) || (offset > pos))
+    {
+      return false;
+    }
+
+    std::size_t match_length = token & 0xFu;
+    if ((match_length == 15u) && !ReadLength(ip, ip_end, match_length))
+    {
+      return false;
+    }
+    match_length += MIN_MATCH;
+
+    if (match_length > (end - pos))
+    {
+      return false;
+    }
+
+    // the match can overlap the output so must be copied a byte at a time
+    std::size_t source = pos - offset;
+    for (std::size_t i = 0; i < match_length; ++i)
+    {
+      buffer[pos++] = buffer[source++];
+    }
+  }
+
+  if (pos != end)
+  {
+    return false;
+  }
+
+  output.Resize(decompressed_size);
+  if (decompressed_size != 0)
+  {
+    std::memcpy(output.pointer(), buffer.data() + dict_size, decompressed_size);
+  }
+
+  return true;
+}
+
+ConstByteArray TrainLZ4Dictionary(std::vector<ConstByteArray> const &samples, std::size_t max_size)
+{
+  max_size = std::min(max_size, LZ4_MAX_DICTIONARY_SIZE);
+
+  // count the number of samples in which each segment appears
+  std::unordered_map<std::string, std::size_t> counts{};
+  for (auto const &sample : samples)
+  {
+    std::unordered_set<std::string> seen{};
+    for (std::size_t pos = 0; (pos + SEGMENT_SIZE) <= sample.size(); pos += SEGMENT_STEP)
+    {
+      seen.emplace(reinterpret_cast<char const *>(sample.pointer() + pos), SEGMENT_SIZE);
+    }
+
+    for (auto &segment : seen)
+    {
+      ++counts[segment];
+    }
+  }
+
+  // only the segments which are common to multiple samples are of any use
+  std::vector<std::pair<std::size_t, std::string>> segments{};
+  for (auto &element : counts)
+  {
+    if (element.second > 1)
+    {
+      segments.emplace_back(element.second, element.first);
+    }
+  }
+
+  // most frequent first, ties broken on the contents so that the training is deterministic
+  std::sort(segments.begin(), segments.end(), [](auto const &a, auto const &b) {
+    return (a.first > b.first) || ((a.first == b.first) && (a.second < b.second));
+  });
+
+  std::size_t const num_segments = std::min(segments.size(), max_size / SEGMENT_SIZE);
+
+  // the most frequent segments are placed at the end of the dictionary
+  ByteArray dictionary{};
+  dictionary.Resize(num_segments * SEGMENT_SIZE);
+  for (std::size_t i = 0; i < num_segments; ++i)
+  {
+    std::size_t const offset = (num_segments - i - 1) * SEGMENT_SIZE;
+    std::memcpy(dictionary.pointer() + offset, segments[i].second.data(), SEGMENT_SIZE);
+  }
+
+  return {dictionary};
+}
+
+}  // namespace compression
+}  // namespace fetch
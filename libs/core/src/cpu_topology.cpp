@@ -0,0 +1,268 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/cpu_topology.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(FETCH_PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace fetch {
+namespace core {
+namespace {
+
+constexpr char const *SYSFS_NODE_PATH = "/sys/devices/system/node/";
+
+bool ReadFirstLine(std::string const &path, std::string &line)
+{
+  std::ifstream stream(path);
+  return static_cast<bool>(std::getline(stream, line));
+}
+
+/**
+ * A single node containing all the CPUs, used when the NUMA layout can not be determined
+ */
+CpuTopology::Nodes UniformTopology()
+{
+  NumaNode node{};
+
+  auto const num_cpus = std::max(1u, std::thread::hardware_concurrency());
+  for (uint32_t cpu = 0; cpu < num_cpus; ++cpu)
+  {
+    node.cpus.push_back(cpu);
+  }
+
+  return {node};
+}
+
+}  // namespace
+
+CpuTopology::CpuTopology(Nodes nodes)
+  : nodes_{std::move(nodes)}
+{
+  if (nodes_.empty())
+  {
+    throw std::invalid_argument("A CPU topology requires at least one node");
+  }
+}
+
+/**
+ * Determine the NUMA layout of the machine. On platforms where this is not available (or if the
+ * system information can not be read) the machine is treated as a single node.
+ *
+ * @return The topology
+ */
+CpuTopology CpuTopology::Discover()
+{
+  Nodes nodes{};
+
+#if defined(FETCH_PLATFORM_LINUX)
+  std::string online{};
+  if (ReadFirstLine(std::string{SYSFS_NODE_PATH} + "online", online))
+  {
+    for (uint32_t const id : ParseCpuList(online))
+    {
+      std::string cpulist{};
+      if (!ReadFirstLine(SYSFS_NODE_PATH + ("node" + std::to_string(id)) + "/cpulist", cpulist))
+      {
+        continue;
+      }
+
+      NumaNode node{id, ParseCpuList(cpulist)};
+
+      // memory only nodes have no CPUs to place threads on
+      if (!node.cpus.empty())
+      {
+        nodes.emplace_back(std::move(node));
+      }
+    }
+  }
+#endif
+
+  if (nodes.empty())
+  {
+    nodes = UniformTopology();
+  }
+
+  return CpuTopology{std::move(nodes)};
+}
+
+std::size_t CpuTopology::num_nodes() const
+{
+  return nodes_.size();
+}
+
+CpuTopology::Nodes const &CpuTopology::nodes() const
+{
+  return nodes_;
+}
+
+/**
+ * Lookup the node on which the threads and memory of a lane should be placed
+ *
+ * @param lane The lane index
+ * @return The node
+ */
+NumaNode const &CpuTopology::NodeForLane(uint32_t lane) const
+{
+  return nodes_[lane % nodes_.size()];
+}
+
+/**
+ * Lookup the node on which an executor thread should be placed
+ *
+ * @param executor The index of the executor thread
+ * @return The node
+ */
+NumaNode const &CpuTopology::NodeForExecutor(std::size_t executor) const
+{
+  return nodes_[executor % nodes_.size()];
+}
+
+/**
+ * Parse a list of CPUs in the kernel list format, for example "0-3,8,10-11"
+ *
+ * @param text The list to be parsed
+ * @return The CPU indices in ascending order
+ */
+CpuList ParseCpuList(std::string const &text)
+{
+  CpuList cpus{};
+
+  std::istringstream stream(text);
+  std::string        range{};
+  while (std::getline(stream, range, ','))
+  {
+    if (range.find_first_not_of(" \t\r\n") == std::string::npos)
+    {
+      continue;
+    }
+
+    auto const separator = range.find('-');
+    try
+    {
+      auto const first = static_cast<uint32_t>(std::stoul(range.substr(0, separator)));
+      auto const last  = (separator == std::string::npos)
+                            ? first
+                            : static_cast<uint32_t>(std::stoul(range.substr(separator + 1)));
+
+      for (uint32_t cpu = first; cpu <= last; ++cpu)
+      {
+        cpus.push_back(cpu);
+      }
+    }
+    catch (std::logic_error const &)
+    {
+      throw std::invalid_argument("Invalid CPU list: " + text);
+    }
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+  return cpus;
+}
+
+/**
+ * Restrict the calling thread to the specified CPUs
+ *
+ * @param cpus The CPUs the thread may run on
+ * @return true if successful, otherwise false (also on platforms without support)
+ */
+bool SetThreadAffinity(CpuList const &cpus)
+{
+  if (cpus.empty())
+  {
+    return false;
+  }
+
+#if defined(FETCH_PLATFORM_LINUX)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  for (uint32_t const cpu : cpus)
+  {
+    if (cpu < CPU_SETSIZE)
+    {
+      CPU_SET(cpu, &set);
+    }
+  }
+
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Get the CPUs the calling thread may run on
+ *
+ * @return The CPUs or an empty list if this can not be determined
+ */
+CpuList GetThreadAffinity()
+{
+  CpuList cpus{};
+
+#if defined(FETCH_PLATFORM_LINUX)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0)
+  {
+    for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (CPU_ISSET(cpu, &set))
+      {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+
+  return cpus;
+}
+
+ScopedThreadAffinity::ScopedThreadAffinity(CpuList const &cpus)
+{
+  if (!cpus.empty())
+  {
+    previous_ = GetThreadAffinity();
+    SetThreadAffinity(cpus);
+  }
+}
+
+ScopedThreadAffinity::~ScopedThreadAffinity()
+{
+  if (!previous_.empty())
+  {
+    SetThreadAffinity(previous_);
+  }
+}
+
+}  // namespace core
+}  // namespace fetch
@@ -0,0 +1,53 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/filesystem/map_file.hpp"
+
+#include <sys/mman.h>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Map a file into memory for reading and writing. The mapping may extend past the end of the file
+ * up to the end of its final page, which reads back as zeros.
+ *
+ * The mapping remains valid after the descriptor has been closed, and it is unmapped once the last
+ * reference to it has been released.
+ *
+ * @param fd The descriptor of the open file
+ * @param length The number of bytes to map from the start of the file
+ * @param mode Whether writes through the mapping reach the file
+ * @return The mapped memory if successful, otherwise a null pointer
+ */
+MappedMemory MapFile(int fd, std::size_t length, MapMode mode)
+{
+  int const   flags   = (mode == MapMode::SHARED) ? MAP_SHARED : MAP_PRIVATE;
+  void *const address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, fd, 0);
+
+  if (address == MAP_FAILED)
+  {
+    return {};
+  }
+
+  return MappedMemory{static_cast<uint8_t *>(address),
+                      [length](uint8_t *ptr) { ::munmap(ptr, length); }};
+}
+
+}  // namespace core
+}  // namespace fetch
@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/memory_monitor.hpp"
+#include "logging/logging.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <utility>
+
+#if defined(__linux__)
+#include <malloc.h>
+#include <unistd.h>
+#endif
+
+using fetch::telemetry::Registry;
+
+namespace fetch {
+namespace core {
+namespace {
+
+struct HeapStatistics
+{
+  std::size_t allocated{0};  ///< The bytes in use by allocations
+  std::size_t free{0};       ///< The bytes held by the allocator but not in use
+};
+
+/**
+ * Read the resident size of the current process
+ *
+ * @return The resident size in bytes, or zero if it is not available on this platform
+ */
+std::size_t ReadResidentSize()
+{
+  std::size_t resident{0};
+
+#if defined(__linux__)
+  std::ifstream stream{"/proc/self/statm"};
+
+  std::size_t total_pages{0};
+  std::size_t resident_pages{0};
+  if (stream >> total_pages >> resident_pages)
+  {
+    resident = resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+
+  return resident;
+}
+
+/**
+ * Read the statistics of the heap from the allocator
+ *
+ * @return The statistics, which are zero if they are not available on this platform
+ */
+HeapStatistics ReadHeapStatistics()
+{
+  HeapStatistics stats{};
+
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+  auto const info = mallinfo2();
+
+  stats.allocated = info.uordblks + info.hblkhd;
+  stats.free      = info.fordblks;
+#endif
+
+  return stats;
+}
+
+}  // namespace
+
+constexpr std::size_t MemoryMonitor::NO_LIMIT;
+
+/**
+ * Construct the memory monitor
+ *
+ * @param period The interval between the accounting of the subsystems
+ */
+MemoryMonitor::MemoryMonitor(Duration const &period)
+  : PeriodicRunnable("MemoryMonitor", period)
+  , resident_gauge_{Registry::Instance().CreateGauge<uint64_t>(
+        "memory_process_resident_bytes", "The resident size of the process")}
+  , unaccounted_gauge_{Registry::Instance().CreateGauge<uint64_t>(
+        "memory_unaccounted_bytes",
+        "The resident size of the process not accounted for by any of the subsystems")}
+  , heap_allocated_gauge_{Registry::Instance().CreateGauge<uint64_t>(
+        "memory_heap_allocated_bytes", "The bytes of the heap in use by allocations")}
+  , heap_free_gauge_{Registry::Instance().CreateGauge<uint64_t>(
+        "memory_heap_free_bytes", "The bytes of the heap held by the allocator but not in use")}
+  , heap_fragmentation_gauge_{Registry::Instance().CreateGauge<double>(
+        "memory_heap_fragmentation", "The fraction of the heap which is held but not in use")}
+{}
+
+/**
+ * Register a subsystem whose memory is to be accounted for
+ *
+ * @param name The name of the subsystem, used to label its telemetry
+ * @param usage The function reporting the approximate number of bytes held by the subsystem
+ * @param limit The number of bytes above which the subsystem is trimmed, or NO_LIMIT
+ * @param trim The function which reduces the memory held by the subsystem, if any
+ */
+void MemoryMonitor::AddSubsystem(std::string const &name, UsageFunction usage, std::size_t limit,
+                                 TrimFunction trim)
+{
+  Registry::Labels const labels{{"subsystem", name}};
+
+  Subsystem subsystem{};
+  subsystem.usage_function = std::move(usage);
+  subsystem.trim_function  = std::move(trim);
+  subsystem.limit          = limit;
+  subsystem.usage_gauge    = Registry::Instance().CreateGauge<uint64_t>(
+      "memory_subsystem_bytes", "The approximate bytes held by the subsystem", labels);
+  subsystem.limit_gauge = Registry::Instance().CreateGauge<uint64_t>(
+      "memory_subsystem_limit_bytes", "The bytes above which the subsystem is trimmed", labels);
+  subsystem.trims_total = Registry::Instance().CreateCounter(
+      "memory_subsystem_trims_total",
+      "The total number of times the subsystem has been trimmed for exceeding its limit", labels);
+
+  subsystem.limit_gauge->set(limit);
+
+  FETCH_LOCK(lock_);
+  subsystems_[name] = std::move(subsystem);
+}
+
+/**
+ * Get the usage of a subsystem, as of the most recent accounting
+ *
+ * @param name The name of the subsystem
+ * @return The approximate number of bytes, or zero if the subsystem is not known
+ */
+std::size_t MemoryMonitor::GetUsage(std::string const &name) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = subsystems_.find(name);
+  if (it == subsystems_.end())
+  {
+    return 0;
+  }
+
+  return it->second.usage;
+}
+
+/**
+ * Account for each of the subsystems, trimming those found over their limit
+ */
+void MemoryMonitor::Periodically()
+{
+  std::size_t accounted{0};
+
+  {
+    FETCH_LOCK(lock_);
+
+    for (auto &entry : subsystems_)
+    {
+      auto &subsystem = entry.second;
+
+      subsystem.usage = subsystem.usage_function();
+
+      bool const over_limit = (subsystem.limit != NO_LIMIT) && (subsystem.usage > subsystem.limit);
+      if (over_limit && subsystem.trim_function)
+      {
+        FETCH_LOG_INFO(LOGGING_NAME, "Trimming ", entry.first, " (", subsystem.usage,
+                       " bytes, limit ", subsystem.limit, " bytes)");
+
+        subsystem.trim_function();
+        subsystem.trims_total->increment();
+
+        subsystem.usage = subsystem.usage_function();
+      }
+
+      subsystem.usage_gauge->set(subsystem.usage);
+      accounted += subsystem.usage;
+    }
+  }
+
+  UpdateProcessStatistics(accounted);
+}
+
+/**
+ * Internal: Export the memory statistics of the process as a whole
+ *
+ * @param accounted The total bytes accounted for by the subsystems
+ */
+void MemoryMonitor::UpdateProcessStatistics(std::size_t accounted)
+{
+  auto const resident = ReadResidentSize();
+  auto const heap     = ReadHeapStatistics();
+
+  resident_gauge_->set(resident);
+  unaccounted_gauge_->set((resident > accounted) ? (resident - accounted) : 0);
+  heap_allocated_gauge_->set(heap.allocated);
+  heap_free_gauge_->set(heap.free);
+
+  auto const heap_size = heap.allocated + heap.free;
+  if (heap_size > 0)
+  {
+    heap_fragmentation_gauge_->set(static_cast<double>(heap.free) /
+                                   static_cast<double>(heap_size));
+  }
+}
+
+}  // namespace core
+}  // namespace fetch
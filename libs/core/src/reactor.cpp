@@ -28,7 +28,7 @@
 #include "telemetry/utils/timer.hpp"
 
 #include <chrono>
-#include <deque>
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -39,13 +39,29 @@
 static const std::chrono::milliseconds POLL_INTERVAL{15};
 static constexpr char const *          LOGGING_NAME = "Reactor";
 
-using WorkQueue = std::deque<fetch::core::WeakRunnable>;
-
 namespace fetch {
 namespace core {
+namespace {
+
+telemetry::HistogramPtr MakeHistogram(char const *name, char const *description,
+                                      telemetry::Measurement::Labels const &labels)
+{
+  return telemetry::Registry::Instance().CreateHistogram(
+      {0.000000001, 0.00000001, 0.0000001, 0.000001, 0.00001, 0.0001, 0.001, 0.01, 0.1, 1.0, 10.0},
+      name, description, labels);
+}
+
+}  // namespace
 
-Reactor::Reactor(std::string name)
+/**
+ * Construct the reactor
+ *
+ * @param name The name of the reactor (used for thread names and telemetry)
+ * @param num_threads The number of worker threads shared by the (non dedicated) runnables
+ */
+Reactor::Reactor(std::string name, std::size_t num_threads)
   : name_{std::move(name)}
+  , num_threads_{num_threads}
   , runnables_time_{CreateHistogram("ledger_reactor_runnable_time",
                                     "The histogram of runnables execution time")}
   , attach_total_{CreateCounter("ledger_reactor_attach_total",
@@ -66,31 +82,25 @@ Reactor::Reactor(std::string name)
   , expired_total_{CreateCounter("ledger_reactor_expired_total",
                                  "The total number of expired runnables")}
   , work_queue_length_{CreateGauge("ledger_reactor_work_queue_length",
-                                   "The current size of the work queue")}
-  , work_queue_max_length_{
-        CreateGauge("ledger_reactor_max_work_queue_length", "The max size of the work queue")}
+                                   "The current number of runnables executing")}
+  , work_queue_max_length_{CreateGauge("ledger_reactor_max_work_queue_length",
+                                       "The max number of runnables executing")}
 {}
 
-bool Reactor::Attach(WeakRunnable runnable)
+Reactor::~Reactor()
 {
-  bool success{false};
-
-  // convert to concrete runnable
-  auto concrete_runnable = runnable.lock();
-  if (concrete_runnable)
-  {
-    success = work_map_.Apply([&concrete_runnable, &runnable](auto &work_map) -> bool {
-      // attempt to insert the element into the map
-      auto const result = work_map.insert(std::make_pair(concrete_runnable.get(), runnable));
-
-      // signal success if the insertion was successful
-      return result.second;
-    });
-  }
-
-  attach_total_->increment();
+  StopWorker();
+}
 
-  return success;
+/**
+ * Attach a runnable to be executed by the shared worker threads
+ *
+ * @param runnable The runnable to attach
+ * @return true if successful, false if the runnable has expired or is already attached
+ */
+bool Reactor::Attach(WeakRunnable runnable)
+{
+  return Insert(runnable, false);
 }
 
 bool Reactor::Attach(std::vector<WeakRunnable> runnables)
@@ -109,6 +119,46 @@ bool Reactor::Attach(std::vector<WeakRunnable> runnables)
   return true;
 }
 
+/**
+ * Attach a runnable to be executed by a thread of its own. Used for latency critical runnables
+ * which must not be held up by other runnables in the reactor.
+ *
+ * @param runnable The runnable to attach
+ * @return true if successful, false if the runnable has expired or is already attached
+ */
+bool Reactor::AttachDedicated(WeakRunnable runnable)
+{
+  return workers_.Apply([this, &runnable](auto &workers) -> bool {
+    if (!Insert(runnable, true))
+    {
+      return false;
+    }
+
+    // if the reactor is already running then the runnable needs its thread now
+    if (running_)
+    {
+      auto const concrete_runnable = runnable.lock();
+      if (concrete_runnable)
+      {
+        StartDedicatedWorker(workers, concrete_runnable.get());
+      }
+    }
+
+    return true;
+  });
+}
+
+/**
+ * Restrict the worker threads of the reactor to a set of CPUs. This must be called before the
+ * reactor is started.
+ *
+ * @param cpus The CPUs on which the workers may run, or an empty list for no restriction
+ */
+void Reactor::SetAffinity(CpuList cpus)
+{
+  affinity_ = std::move(cpus);
+}
+
 bool Reactor::Detach(Runnable const &runnable)
 {
   detach_total_->increment();
@@ -129,131 +179,302 @@ void Reactor::Stop()
   StopWorker();
 }
 
+/**
+ * Signal the reactor that one of its runnables might now be ready to execute. Can be called from
+ * any thread, idle workers will then re-evaluate their runnables immediately instead of after the
+ * poll interval.
+ */
+void Reactor::Wake()
+{
+  wake_generation_.ApplyVoid([](Generation &generation) { ++generation; });
+}
+
+bool Reactor::Insert(WeakRunnable const &runnable, bool dedicated)
+{
+  bool success{false};
+
+  // convert to concrete runnable
+  auto concrete_runnable = runnable.lock();
+  if (concrete_runnable)
+  {
+    auto execution_time = CreateRunnableHistogram(*concrete_runnable);
+
+    success = work_map_.Apply([&](auto &work_map) -> bool {
+      // attempt to insert the element into the map
+      auto const result = work_map.emplace(
+          concrete_runnable.get(), Entry{runnable, std::move(execution_time), dedicated, false});
+
+      // signal success if the insertion was successful
+      return result.second;
+    });
+  }
+
+  attach_total_->increment();
+
+  if (success)
+  {
+    // let idle workers pick up the new runnable straight away
+    Wake();
+  }
+
+  return success;
+}
+
 void Reactor::StartWorker()
 {
-  detailed_assert(!worker_);
+  workers_.ApplyVoid([this](auto &workers) {
+    detailed_assert(workers.empty());
+
+    // signal the reactor is running
+    running_ = true;
 
-  // signal the reactor is running
-  running_ = true;
+    // create the shared worker routines
+    for (std::size_t i = 0; i < num_threads_; ++i)
+    {
+      workers.emplace_back(&Reactor::Monitor, this, nullptr);
+    }
+
+    // create a worker for each of the dedicated runnables
+    std::vector<Runnable const *> dedicated{};
+    work_map_.ApplyVoid([&dedicated](auto const &work_map) {
+      for (auto const &element : work_map)
+      {
+        if (element.second.dedicated)
+        {
+          dedicated.emplace_back(element.first);
+        }
+      }
+    });
 
-  // create the worker routine
-  worker_ = std::make_unique<ProtectedThread>(&Reactor::Monitor, this);
+    for (auto const *key : dedicated)
+    {
+      StartDedicatedWorker(workers, key);
+    }
+  });
 }
 
-Reactor::~Reactor()
+void Reactor::StartDedicatedWorker(std::vector<std::thread> &workers, Runnable const *key)
 {
-  if (worker_)
-  {
-    worker_->ApplyVoid([](auto &worker) { worker.join(); });
-    worker_.reset();
-  }
+  workers.emplace_back(&Reactor::Monitor, this, key);
 }
 
 void Reactor::StopWorker()
 {
   running_ = false;
+  Wake();
 
-  if (worker_)
-  {
-    worker_->ApplyVoid([](auto &worker) { worker.join(); });
-    worker_.reset();
-  }
+  workers_.ApplyVoid([](auto &workers) {
+    for (auto &worker : workers)
+    {
+      worker.join();
+    }
+
+    workers.clear();
+  });
 }
 
-void Reactor::Monitor()
+/**
+ * The main loop of a worker thread
+ *
+ * @param dedicated The runnable the worker is dedicated to, or nullptr for a shared worker
+ */
+void Reactor::Monitor(Runnable const *dedicated)
 {
   // set the thread name
   SetThreadName(name_);
 
-  WorkQueue work_queue;
+  if (!affinity_.empty())
+  {
+    SetThreadAffinity(affinity_);
+  }
+
+  // the last runnable executed by this worker, the search for the next one resumes after it so
+  // that all the ready runnables are serviced in turn
+  Runnable const *cursor{nullptr};
 
   while (running_)
   {
-    // Step 1. If we have run out of work to execute then gather all the runnables that are ready
-    if (work_queue.empty())
-    {
-      work_map_.ApplyVoid([&work_queue, this](auto &work_map) {
-        // loop through and evaluate the map
-        auto it = work_map.begin();
-        while (it != work_map.end())
-        {
-          // attempt to lock the runnable
-          auto concrete_runnable = it->second.lock();
-
-          if (concrete_runnable)
-          {
-            // evaluate if the runnable is ready to execute, if it is then add it to the work queue
-            if (concrete_runnable->IsReadyToExecute())
-            {
-              work_queue.emplace_back(it->second);
-            }
-
-            // advance to the next element in the map
-            ++it;
-          }
-          else
-          {
-            // the lifetime of the runnable has expired, remove
-            // and advance to next element in the map
-            it = work_map.erase(it);
-
-            expired_total_->increment();
-          }
-        }
-      });
+    // observe the wake generation before looking for work so that a wake that arrives while we
+    // are looking is not lost
+    Generation const generation =
+        wake_generation_.Apply([](Generation const &current) { return current; });
 
-      work_queue_max_length_->max(work_queue.size());
-    }
+    telemetry::HistogramPtr execution_time{};
+    bool                    attached{true};
+
+    auto runnable = Claim(cursor, dedicated, execution_time, attached);
 
-    work_queue_length_->set(work_queue.size());
+    // a dedicated worker ends with its runnable
+    if (!attached)
+    {
+      break;
+    }
 
-    // If the work queue is still empty then there is no work to do. Sleep the worker and try again
-    if (work_queue.empty())
+    // If no runnable is ready then there is no work to do. Sleep until woken or the poll interval
+    // expires (for runnables which become ready over time)
+    if (!runnable)
     {
       sleep_total_->increment();
-      std::this_thread::sleep_for(POLL_INTERVAL);
+      wake_generation_.Wait(
+          [generation](Generation const &current) { return current != generation; },
+          POLL_INTERVAL);
 
       continue;
     }
 
-    // extract the element from the front of the queue
-    auto runnable = work_queue.front().lock();
-    work_queue.pop_front();
+    Execute(*runnable, *execution_time);
+    Release(runnable.get());
+  }
+}
+
+/**
+ * Find and claim the next runnable that is ready to execute
+ *
+ * @param cursor The last runnable executed by the calling worker, updated on success
+ * @param dedicated The runnable the calling worker is dedicated to, or nullptr
+ * @param execution_time Set to the histogram of the claimed runnable
+ * @param attached Set to false if a dedicated runnable is no longer attached
+ * @return The claimed runnable if there is one, otherwise nullptr
+ */
+RunnablePtr Reactor::Claim(Runnable const *&cursor, Runnable const *dedicated,
+                           telemetry::HistogramPtr &execution_time, bool &attached)
+{
+  return work_map_.Apply([&](auto &work_map) -> RunnablePtr {
+    RunnablePtr claimed{};
+
+    auto it = (dedicated != nullptr) ? work_map.find(dedicated) : work_map.upper_bound(cursor);
 
-    // execute the item if it can be executed
-    if (runnable)
+    if (dedicated != nullptr && it == work_map.end())
     {
-      telemetry::FunctionTimer timer{*runnables_time_};
-      runnable_total_->increment();
+      attached = false;
+      return claimed;
+    }
 
-      try
+    // visit each of the runnables at most once
+    std::size_t const num_runnables = (dedicated != nullptr) ? 1u : work_map.size();
+    for (std::size_t visited = 0; visited < num_runnables && !claimed; ++visited)
+    {
+      if (it == work_map.end())
       {
-        runnable->Execute();
+        it = work_map.begin();
+      }
+
+      auto &entry = it->second;
 
-        success_total_->increment();
+      // runnables are only ever executed by one worker at a time, shared workers do not touch
+      // dedicated runnables
+      if (entry.executing || (entry.dedicated && dedicated == nullptr))
+      {
+        ++it;
+        continue;
       }
-      catch (std::exception const &ex)
+
+      // attempt to lock the runnable
+      auto concrete_runnable = entry.runnable.lock();
+
+      if (!concrete_runnable)
       {
-        FETCH_LOG_WARN(LOGGING_NAME, "The reactor caught an exception in ", runnable->GetId(), "! ",
-                       name_, " error: ", ex.what());
+        // the lifetime of the runnable has expired, remove and advance to next element in the map
+        it = work_map.erase(it);
+
+        expired_total_->increment();
 
-        failure_total_->increment();
+        if (dedicated != nullptr)
+        {
+          attached = false;
+        }
+
+        continue;
       }
-      catch (...)
-      {
-        FETCH_LOG_INFO(LOGGING_NAME, "Unknown error generated in reactor: ", name_);
 
-        failure_total_->increment();
+      // evaluate if the runnable is ready to execute, if it is then claim it
+      if (concrete_runnable->IsReadyToExecute())
+      {
+        entry.executing = true;
+        execution_time  = entry.execution_time;
+        cursor          = it->first;
+        claimed         = std::move(concrete_runnable);
+
+        uint64_t const num_executing = ++num_executing_;
+        work_queue_length_->set(num_executing);
+        work_queue_max_length_->max(num_executing);
       }
+
+      ++it;
     }
+
+    return claimed;
+  });
+}
+
+/**
+ * Return a runnable claimed by a worker, allowing it to be scheduled again
+ *
+ * @param key The runnable
+ */
+void Reactor::Release(Runnable const *key)
+{
+  work_queue_length_->set(--num_executing_);
+
+  work_map_.ApplyVoid([key](auto &work_map) {
+    auto it = work_map.find(key);
+
+    // the runnable may have been detached while executing
+    if (it != work_map.end())
+    {
+      it->second.executing = false;
+    }
+  });
+}
+
+void Reactor::Execute(Runnable &runnable, telemetry::Histogram &execution_time)
+{
+  telemetry::FunctionTimer const timer{*runnables_time_};
+  telemetry::FunctionTimer const runnable_timer{execution_time};
+  runnable_total_->increment();
+
+  try
+  {
+    runnable.Execute();
+
+    success_total_->increment();
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "The reactor caught an exception in ", runnable.GetId(), "! ",
+                   name_, " error: ", ex.what());
+
+    failure_total_->increment();
+  }
+  catch (...)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Unknown error generated in reactor: ", name_);
+
+    failure_total_->increment();
+  }
+}
+
+telemetry::HistogramPtr Reactor::CreateRunnableHistogram(Runnable const &runnable) const
+{
+  static constexpr char const *NAME = "ledger_reactor_runnable_execution_time";
+
+  telemetry::Measurement::Labels const labels{{"reactor", name_}, {"runnable", runnable.GetId()}};
+
+  // runnables with the same identifier in the same reactor share a histogram
+  auto histogram =
+      telemetry::Registry::Instance().LookupMeasurement<telemetry::Histogram>(NAME, labels);
+
+  if (!histogram)
+  {
+    histogram = MakeHistogram(NAME, "The histogram of execution time per runnable", labels);
   }
+
+  return histogram;
 }
 
 telemetry::HistogramPtr Reactor::CreateHistogram(char const *name, char const *description) const
 {
-  return telemetry::Registry::Instance().CreateHistogram(
-      {0.000000001, 0.00000001, 0.0000001, 0.000001, 0.00001, 0.0001, 0.001, 0.01, 0.1, 1.0, 10.0},
-      name, description, {{"reactor", name_}});
+  return MakeHistogram(name, description, {{"reactor", name_}});
 }
 
 telemetry::CounterPtr Reactor::CreateCounter(char const *name, char const *description) const
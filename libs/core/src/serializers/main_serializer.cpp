@@ -25,6 +25,7 @@
 #include "core/serializers/main_serializer.hpp"
 #include "vectorise/platform.hpp"
 
+#include <algorithm>
 #include <type_traits>
 
 namespace fetch {
@@ -46,6 +47,15 @@ MsgPackSerializer &MsgPackSerializer::operator=(MsgPackSerializer const &from)
   return *this;
 }
 
+MsgPackSerializer MsgPackSerializer::Borrow(byte_array::ConstByteArray const &data)
+{
+  MsgPackSerializer serializer{};
+  serializer.data_      = ByteArray::SharedView(data);
+  serializer.read_only_ = true;
+
+  return serializer;
+}
+
 void MsgPackSerializer::WriteNil()
 {
   Allocate(sizeof(uint8_t));
@@ -54,12 +64,21 @@ void MsgPackSerializer::WriteNil()
 
 void MsgPackSerializer::Allocate(uint64_t const &delta)
 {
+  // when the size has not been reserved up front (see Append) grow the buffer geometrically, so
+  // that a sequence of small writes does not reallocate and copy the buffer on every write
+  uint64_t const required = data_.size() + delta;
+  if (required > data_.capacity())
+  {
+    Reserve(std::max(required, 2 * data_.capacity()), ResizeParadigm::ABSOLUTE);
+  }
+
   Resize(delta, ResizeParadigm::RELATIVE);
 }
 
 void MsgPackSerializer::Resize(uint64_t const &size, ResizeParadigm const &resize_paradigm,
                                bool const zero_reserved_space)
 {
+  EnsureWritable();
   data_.Resize(size, resize_paradigm, zero_reserved_space);
 
   switch (resize_paradigm)
@@ -109,17 +128,20 @@ MsgPackSerializer::PairDeserializer MsgPackSerializer::NewPairDeserializer()
 void MsgPackSerializer::Reserve(uint64_t const &size, ResizeParadigm const &resize_paradigm,
                                 bool const zero_reserved_space)
 {
+  EnsureWritable();
   data_.Reserve(size, resize_paradigm, zero_reserved_space);
 }
 
 void MsgPackSerializer::WriteBytes(uint8_t const *arr, uint64_t const &size)
 {
+  EnsureWritable();
   data_.WriteBytes(arr, size, pos_);
   pos_ += size;
 }
 
 void MsgPackSerializer::WriteByte(uint8_t const &val)
 {
+  EnsureWritable();
   data_.WriteBytes(&val, 1, pos_);
   ++pos_;
 }
@@ -152,6 +174,18 @@ void MsgPackSerializer::ReadByteArray(byte_array::ConstByteArray &b, uint64_t co
   pos_ += size;
 }
 
+void MsgPackSerializer::ReadByteArray(byte_array::ByteArray &b, uint64_t const &size)
+{
+  if (size + pos_ > data_.size())
+  {
+    throw std::runtime_error("Attempted read exceeds buffer size.");
+  }
+
+  // mutable arrays may not share the memory of a borrowed buffer
+  b = read_only_ ? ByteArray{data_.SubArray(pos_, size).Copy()} : data_.SubArray(pos_, size);
+  pos_ += size;
+}
+
 void MsgPackSerializer::SkipBytes(uint64_t const &size)
 {
   pos_ += size;
@@ -190,5 +224,13 @@ byte_array::ByteArray const &MsgPackSerializer::data() const
 void MsgPackSerializer::AppendInternal()
 {}
 
+void MsgPackSerializer::EnsureWritable() const
+{
+  if (read_only_)
+  {
+    throw std::runtime_error("Attempted to write to a read only serializer.");
+  }
+}
+
 }  // namespace serializers
 }  // namespace fetch
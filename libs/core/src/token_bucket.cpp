@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/token_bucket.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Construct a full token bucket
+ *
+ * @param rate The number of tokens added per second
+ * @param burst The maximum number of tokens which can be held
+ * @param now The current time
+ */
+TokenBucket::TokenBucket(double rate, double burst, Timepoint const &now)
+  : rate_{rate}
+  , burst_{burst}
+  , tokens_{burst}
+  , last_refill_{now}
+{}
+
+/**
+ * Take up to the specified number of tokens from the bucket
+ *
+ * @param count The number of tokens requested
+ * @param now The current time
+ * @return The number of tokens taken, which may be fewer than requested
+ */
+std::size_t TokenBucket::Take(std::size_t count, Timepoint const &now)
+{
+  Refill(now);
+
+  auto const taken = std::min(count, static_cast<std::size_t>(std::floor(tokens_)));
+  tokens_ -= static_cast<double>(taken);
+
+  return taken;
+}
+
+/**
+ * Get the number of tokens currently available
+ *
+ * @param now The current time
+ * @return The number of tokens
+ */
+double TokenBucket::available(Timepoint const &now)
+{
+  Refill(now);
+
+  return tokens_;
+}
+
+void TokenBucket::Refill(Timepoint const &now)
+{
+  if (now <= last_refill_)
+  {
+    return;
+  }
+
+  std::chrono::duration<double> const elapsed = now - last_refill_;
+
+  tokens_      = std::min(burst_, tokens_ + (elapsed.count() * rate_));
+  last_refill_ = now;
+}
+
+}  // namespace core
+}  // namespace fetch
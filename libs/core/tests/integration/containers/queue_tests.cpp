@@ -23,6 +23,7 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -211,4 +212,53 @@ TEST_F(QueueTests, ProducerConsumer_1p_50c_MPMCQueue)
   ProducerConsumerTest<1, 50>(queue);
 }
 
+TEST(QueueBatchTests, PopReturnsFalseWhenEmpty)
+{
+  fetch::core::MPMCQueue<int, 8> queue;
+
+  int value{0};
+  EXPECT_FALSE(queue.Pop(value, std::chrono::milliseconds::zero()));
+  EXPECT_FALSE(queue.Pop(value, std::chrono::milliseconds{10}));
+}
+
+TEST(QueueBatchTests, PushManyAndPopMany)
+{
+  fetch::core::MPMCQueue<int, 8> queue;
+
+  std::vector<int> input{1, 2, 3, 4, 5};
+  queue.PushMany(input.begin(), input.end());
+
+  std::vector<int> output{};
+  EXPECT_EQ(queue.PopMany(std::back_inserter(output), 3, std::chrono::milliseconds::zero()), 3u);
+  EXPECT_EQ(queue.PopMany(std::back_inserter(output), 10, std::chrono::milliseconds::zero()), 2u);
+  EXPECT_EQ(queue.PopMany(std::back_inserter(output), 10, std::chrono::milliseconds{10}), 0u);
+
+  EXPECT_EQ(output, input);
+}
+
+TEST(QueueBatchTests, PushManyBlocksUntilSpaceIsAvailable)
+{
+  constexpr std::size_t NUM_ELEMENTS = 10000;
+
+  fetch::core::MPSCQueue<std::size_t, 16> queue;
+
+  std::vector<std::size_t> input(NUM_ELEMENTS);
+  for (std::size_t i = 0; i < NUM_ELEMENTS; ++i)
+  {
+    input[i] = i;
+  }
+
+  std::thread producer([&queue, &input]() { queue.PushMany(input.begin(), input.end()); });
+
+  std::vector<std::size_t> output{};
+  while (output.size() < NUM_ELEMENTS)
+  {
+    ASSERT_GT(queue.PopMany(std::back_inserter(output), 32, std::chrono::seconds{4}), 0u);
+  }
+
+  producer.join();
+
+  EXPECT_EQ(output, input);
+}
+
 }  // namespace
@@ -285,6 +285,23 @@ TEST(BitVectorTests, ExpandTo64)
   EXPECT_EQ(other.bit(63), 1);
 }
 
+TEST(BitVectorTests, RemapToSameSizeCopiesTheBits)
+{
+  BitVector src{4};
+  src.set(2, 1);
+
+  BitVector dst{4};
+  ASSERT_TRUE(src.RemapTo(dst));
+  EXPECT_EQ(dst, src);
+
+  // updating the destination must leave the source untouched
+  dst.set(0, 1);
+
+  EXPECT_EQ(src.bit(0), 0);
+  EXPECT_EQ(src.bit(2), 1);
+  EXPECT_EQ(dst.bit(0), 1);
+}
+
 TEST(BitVectorTests, ContractFrom8)
 {
   // set and initial mask
@@ -418,3 +435,27 @@ TEST(BitVectorTests, IterateSetBits)
   EXPECT_EQ(itr, end);
   EXPECT_EQ(expected_index_itr, expected_indexes.end());
 }
+
+TEST(BitVectorTests, Intersects)
+{
+  BitVector a{256};
+  BitVector b{256};
+
+  EXPECT_FALSE(a.Intersects(b));
+
+  a.set(3, 1);
+  a.set(200, 1);
+  b.set(4, 1);
+  b.set(199, 1);
+
+  EXPECT_FALSE(a.Intersects(b));
+  EXPECT_FALSE(b.Intersects(a));
+  EXPECT_EQ((a & b).PopCount(), 0);
+
+  // a common bit in a later block
+  b.set(200, 1);
+
+  EXPECT_TRUE(a.Intersects(b));
+  EXPECT_TRUE(b.Intersects(a));
+  EXPECT_EQ((a & b).PopCount(), 1);
+}
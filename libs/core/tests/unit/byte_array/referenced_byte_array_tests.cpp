@@ -91,7 +91,8 @@ TEST(reference_byte_array_gtest, testing_that_ConstByteArray_r_value_moved_if_un
 
 TEST(reference_byte_array_gtest, testing_that_ConstByteArray_r_value_not_moved_if_not_unique)
 {
-  char const *   base = "hello world";
+  // long enough to be held in a shared buffer rather than inline
+  char const *   base = "hello world, this string is long enough to be stored in a shared buffer";
   ConstByteArray expected_to_remain_unchanged{base};
   ConstByteArray expected_to_remain_unchanged_2{expected_to_remain_unchanged};
   EXPECT_EQ(expected_to_remain_unchanged.UseCount(), 2);
@@ -106,7 +107,7 @@ TEST(reference_byte_array_gtest, testing_that_ConstByteArray_r_value_not_moved_i
   copy[3] = 't';
   copy[4] = 'y';
 
-  EXPECT_EQ(copy, "kitty world");
+  EXPECT_EQ(copy, "kitty world, this string is long enough to be stored in a shared buffer");
   EXPECT_EQ(expected_to_remain_unchanged, base);
   EXPECT_EQ(expected_to_remain_unchanged_2, base);  // NOLINT(bugprone-use-after-move)
 }
@@ -241,3 +242,65 @@ TEST(reference_byte_array_gtest, size_of_loaded_C_strings)
   EXPECT_EQ(ByteArray("any carnal pleasure").size(), 19);
   EXPECT_EQ(ByteArray("any carnal pleasure.").size(), 20);
 }
+
+TEST(reference_byte_array_gtest, small_ConstByteArray_is_stored_inline)
+{
+  ConstByteArray const small{"hello world"};
+  ConstByteArray const large{std::string(ConstByteArray::INLINE_CAPACITY + 1, 'x')};
+
+  EXPECT_TRUE(small.IsInline());
+  EXPECT_EQ(small.UseCount(), 1);
+  EXPECT_FALSE(large.IsInline());
+  EXPECT_EQ(large.UseCount(), 1);
+
+  // copies of inline arrays hold their own contents
+  ConstByteArray const copy{small};
+  EXPECT_TRUE(copy.IsInline());
+  EXPECT_NE(copy.pointer(), small.pointer());
+  EXPECT_EQ(copy, small);
+  EXPECT_EQ(small.UseCount(), 1);
+}
+
+TEST(reference_byte_array_gtest, moved_from_inline_ConstByteArray_is_empty)
+{
+  ConstByteArray source{"hello world"};
+  ConstByteArray target{std::move(source)};
+
+  EXPECT_EQ(target, "hello world");
+  EXPECT_TRUE(target.IsInline());
+  EXPECT_TRUE(source.empty());  // NOLINT(bugprone-use-after-move)
+
+  source = target;
+  EXPECT_EQ(source, "hello world");
+  target = std::move(source);
+  EXPECT_EQ(target, "hello world");
+}
+
+TEST(reference_byte_array_gtest, sub_arrays_of_shared_buffers_are_views)
+{
+  ConstByteArray const small{"hello world"};
+  ConstByteArray const large{std::string(ConstByteArray::INLINE_CAPACITY * 2, 'x')};
+
+  ConstByteArray const small_sub = small.SubArray(6);
+  EXPECT_EQ(small_sub, "world");
+  EXPECT_TRUE(small_sub.IsInline());
+
+  ConstByteArray const large_sub = large.SubArray(10, 5);
+  EXPECT_EQ(large_sub.pointer(), large.pointer() + 10);
+  EXPECT_EQ(large.UseCount(), 2);
+}
+
+TEST(reference_byte_array_gtest, ByteArray_is_never_stored_inline)
+{
+  ConstByteArray const small{"hello world"};
+
+  EXPECT_FALSE(ByteArray{"hello world"}.IsInline());
+  EXPECT_FALSE(ByteArray{small}.IsInline());
+  EXPECT_FALSE(ByteArray::SharedView(small).IsInline());
+  EXPECT_FALSE(ByteArray(small, 0, 5).IsInline());
+  EXPECT_FALSE((ByteArray{0x01, 0x02}).IsInline());
+
+  // the result of concatenation is a single shared buffer
+  EXPECT_FALSE((small + small).IsInline());
+  EXPECT_EQ(small + small, "hello worldhello world");
+}
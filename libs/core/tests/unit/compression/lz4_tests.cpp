@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/compression/lz4.hpp"
+#include "core/random/lcg.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::compression::LZ4Compress;
+using fetch::compression::LZ4Decompress;
+using fetch::compression::TrainLZ4Dictionary;
+using fetch::random::LinearCongruentialGenerator;
+
+class LZ4Tests : public ::testing::Test
+{
+protected:
+  ConstByteArray GenerateRandom(std::size_t size)
+  {
+    ByteArray data{};
+    data.Resize(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      data[i] = static_cast<uint8_t>(rng_() >> 19u);
+    }
+
+    return {data};
+  }
+
+  ConstByteArray GenerateStructured(std::size_t size)
+  {
+    static std::vector<std::string> const WORDS = {
+        "transaction", "signature", "digest", "from", "to", "amount", "fee", "\x81\xa4"};
+
+    std::string text{};
+    while (text.size() < size)
+    {
+      text += WORDS[rng_() % WORDS.size()];
+      text += static_cast<char>(rng_() % 4);
+    }
+    text.resize(size);
+
+    return {text};
+  }
+
+  static void CheckRoundTrip(ConstByteArray const &input, ConstByteArray const &dictionary = {})
+  {
+    auto const compressed = LZ4Compress(input, dictionary);
+
+    ByteArray output{};
+    ASSERT_TRUE(LZ4Decompress(compressed, input.size(), output, dictionary))
+        << "input size: " << input.size();
+    EXPECT_EQ(ConstByteArray{output}, input);
+  }
+
+  LinearCongruentialGenerator rng_;
+};
+
+TEST_F(LZ4Tests, CheckRoundTripOfSmallInputs)
+{
+  for (std::size_t size = 0; size < 64; ++size)
+  {
+    CheckRoundTrip(GenerateStructured(size));
+    CheckRoundTrip(GenerateRandom(size));
+  }
+}
+
+TEST_F(LZ4Tests, CheckRoundTripOfLargeInputs)
+{
+  for (std::size_t size : {1000u, 4096u, 65536u, 200000u})
+  {
+    CheckRoundTrip(GenerateStructured(size));
+    CheckRoundTrip(GenerateRandom(size));
+    CheckRoundTrip(ConstByteArray{std::string(size, 'a')});
+  }
+}
+
+TEST_F(LZ4Tests, CheckStructuredDataIsCompressed)
+{
+  auto const input      = GenerateStructured(10000);
+  auto const compressed = LZ4Compress(input);
+
+  EXPECT_LT(compressed.size(), input.size() / 2);
+
+  // incompressible data only has a small overhead
+  auto const random = GenerateRandom(10000);
+  EXPECT_LE(LZ4Compress(random).size(), random.size() + (random.size() / 255) + 16);
+}
+
+TEST_F(LZ4Tests, CheckKnownBlock)
+{
+  // hand assembled block: 3 literals, a 13 byte match at offset 3 and 5 trailing literals
+  static uint8_t const BLOCK[] = {0x39, 'a', 'b', 'c', 0x03, 0x00, 0x50, 'b', 'c', 'a', 'b', 'c'};
+
+  ConstByteArray const block{BLOCK, sizeof(BLOCK)};
+  ByteArray            output{};
+  ASSERT_TRUE(LZ4Decompress(block, 21, output));
+  EXPECT_EQ(ConstByteArray{output}, ConstByteArray{"abcabcabcabcabcabcabc"});
+}
+
+TEST_F(LZ4Tests, CheckDictionaryImprovesCompression)
+{
+  std::vector<ConstByteArray> samples{};
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    samples.emplace_back(GenerateStructured(512));
+  }
+
+  auto const dictionary = TrainLZ4Dictionary(samples, 4096);
+  ASSERT_FALSE(dictionary.empty());
+  EXPECT_LE(dictionary.size(), 4096u);
+
+  auto const input = GenerateStructured(256);
+  CheckRoundTrip(input, dictionary);
+
+  EXPECT_LT(LZ4Compress(input, dictionary).size(), LZ4Compress(input).size());
+
+  // the block can not be decompressed without the dictionary
+  ByteArray output{};
+  EXPECT_FALSE(LZ4Decompress(LZ4Compress(input, dictionary), input.size(), output) &&
+               (ConstByteArray{output} == input));
+}
+
+TEST_F(LZ4Tests, CheckMalformedInputIsRejected)
+{
+  auto const input      = GenerateStructured(2000);
+  auto const compressed = LZ4Compress(input);
+
+  ByteArray output{};
+
+  // wrong sizes
+  EXPECT_FALSE(LZ4Decompress(compressed, input.size() - 1, output));
+  EXPECT_FALSE(LZ4Decompress(compressed, input.size() + 1, output));
+
+  // truncated blocks
+  for (std::size_t size = 0; size < compressed.size(); size += 7)
+  {
+    EXPECT_FALSE(LZ4Decompress(compressed.SubArray(0, size), input.size(), output));
+  }
+
+  // random garbage must never crash the decoder
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    LZ4Decompress(GenerateRandom(rng_() % 256), rng_() % 1024, output);
+  }
+}
+
+}  // namespace
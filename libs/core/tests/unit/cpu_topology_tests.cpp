@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/cpu_topology.hpp"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+namespace {
+
+using fetch::core::CpuList;
+using fetch::core::CpuTopology;
+using fetch::core::GetThreadAffinity;
+using fetch::core::NumaNode;
+using fetch::core::ParseCpuList;
+using fetch::core::ScopedThreadAffinity;
+
+TEST(CpuTopologyTests, ParseCpuList)
+{
+  EXPECT_EQ(ParseCpuList("0"), (CpuList{0}));
+  EXPECT_EQ(ParseCpuList("0-3"), (CpuList{0, 1, 2, 3}));
+  EXPECT_EQ(ParseCpuList("8-9,0,2-3\n"), (CpuList{0, 2, 3, 8, 9}));
+  EXPECT_TRUE(ParseCpuList("").empty());
+
+  EXPECT_THROW(ParseCpuList("a-b"), std::invalid_argument);
+}
+
+TEST(CpuTopologyTests, LanesAndExecutorsShareNodes)
+{
+  CpuTopology const topology{{NumaNode{0, {0, 1}}, NumaNode{1, {2, 3}}}};
+
+  ASSERT_EQ(topology.num_nodes(), 2u);
+  EXPECT_EQ(topology.NodeForLane(0).id, 0u);
+  EXPECT_EQ(topology.NodeForLane(1).id, 1u);
+  EXPECT_EQ(topology.NodeForLane(6).id, 0u);
+
+  // with four executors lane n is served by executor n % 4, which is on the same node
+  for (uint32_t lane = 0; lane < 16; ++lane)
+  {
+    EXPECT_EQ(topology.NodeForLane(lane).id, topology.NodeForExecutor(lane % 4).id);
+  }
+}
+
+TEST(CpuTopologyTests, TopologyRequiresNodes)
+{
+  EXPECT_THROW(CpuTopology{{}}, std::invalid_argument);
+}
+
+TEST(CpuTopologyTests, DiscoveredNodesHaveCpus)
+{
+  auto const topology = CpuTopology::Discover();
+
+  ASSERT_GE(topology.num_nodes(), 1u);
+  for (auto const &node : topology.nodes())
+  {
+    EXPECT_FALSE(node.cpus.empty());
+  }
+}
+
+TEST(CpuTopologyTests, ScopedAffinityIsRestored)
+{
+  CpuList const original = GetThreadAffinity();
+  if (original.empty())
+  {
+    // thread placement is not supported on this platform
+    return;
+  }
+
+  {
+    ScopedThreadAffinity const scope{{original.front()}};
+    EXPECT_EQ(GetThreadAffinity(), (CpuList{original.front()}));
+  }
+
+  EXPECT_EQ(GetThreadAffinity(), original);
+}
+
+}  // namespace
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+using fetch::Digest;
+using fetch::DigestKey;
+using fetch::DigestKeyMap;
+
+Digest MakeDigest(uint8_t seed)
+{
+  std::string raw(DigestKey::MAX_SIZE, '\0');
+  for (std::size_t i = 0; i < raw.size(); ++i)
+  {
+    raw[i] = static_cast<char>(seed + i);
+  }
+
+  return Digest{raw};
+}
+
+TEST(DigestKeyTests, IsTriviallyCopyable)
+{
+  EXPECT_TRUE(std::is_trivially_copyable<DigestKey>::value);
+}
+
+TEST(DigestKeyTests, RoundTripsDigest)
+{
+  Digest const digest = MakeDigest(1);
+
+  DigestKey const key{digest};
+  EXPECT_EQ(key.size(), digest.size());
+  EXPECT_EQ(static_cast<Digest>(key), digest);
+
+  // shorter digests are also supported
+  Digest const short_digest{"short"};
+  EXPECT_EQ(static_cast<Digest>(DigestKey{short_digest}), short_digest);
+  EXPECT_EQ(static_cast<Digest>(DigestKey{}), Digest{});
+}
+
+TEST(DigestKeyTests, Equality)
+{
+  DigestKey const a{MakeDigest(1)};
+  DigestKey const b{MakeDigest(1)};
+  DigestKey const c{MakeDigest(2)};
+
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+
+  // a prefix of a digest is a different key
+  EXPECT_NE(a, DigestKey{MakeDigest(1).SubArray(0, 8)});
+}
+
+TEST(DigestKeyTests, RejectsOversizedDigests)
+{
+  Digest const digest{std::string(DigestKey::MAX_SIZE + 1, 'x')};
+  EXPECT_THROW(DigestKey{digest}, std::length_error);
+}
+
+TEST(DigestKeyTests, MapLookupWithDigest)
+{
+  DigestKeyMap<int> map{};
+  map.emplace(MakeDigest(1), 1);
+  map.emplace(MakeDigest(2), 2);
+
+  auto const it = map.find(MakeDigest(2));
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ(it->second, 2);
+  EXPECT_EQ(map.count(MakeDigest(3)), 0u);
+}
+
+}  // namespace
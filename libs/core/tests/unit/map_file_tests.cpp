@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/filesystem/map_file.hpp"
+
+#include "gtest/gtest.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace {
+
+using fetch::core::MapFile;
+using fetch::core::MapMode;
+
+class MapFileTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::ofstream stream{filename_, std::ios::binary | std::ios::trunc};
+    stream << "abcdefgh";
+  }
+
+  void TearDown() override
+  {
+    std::remove(filename_.c_str());
+  }
+
+  std::string ReadBack() const
+  {
+    std::ifstream stream{filename_, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+  }
+
+  std::string const filename_{"map_file_tests.bin"};
+};
+
+TEST_F(MapFileTests, MappingOutlivesTheDescriptor)
+{
+  int const fd = ::open(filename_.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+
+  auto const mapping = MapFile(fd, 64, MapMode::PRIVATE);
+  ::close(fd);
+
+  ASSERT_TRUE(mapping);
+  EXPECT_EQ(std::string(reinterpret_cast<char const *>(mapping.get()), 8), "abcdefgh");
+
+  // the remainder of the final page reads back as zeros
+  for (std::size_t i = 8; i < 64; ++i)
+  {
+    EXPECT_EQ(mapping.get()[i], 0u);
+  }
+}
+
+TEST_F(MapFileTests, PrivateWritesDoNotReachTheFile)
+{
+  int const fd = ::open(filename_.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+
+  auto const mapping = MapFile(fd, 8, MapMode::PRIVATE);
+  ::close(fd);
+
+  ASSERT_TRUE(mapping);
+  mapping.get()[0] = 'z';
+
+  EXPECT_EQ(mapping.get()[0], 'z');
+  EXPECT_EQ(ReadBack(), "abcdefgh");
+}
+
+TEST_F(MapFileTests, SharedWritesReachTheFile)
+{
+  int const fd = ::open(filename_.c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+
+  auto mapping = MapFile(fd, 8, MapMode::SHARED);
+  ::close(fd);
+
+  ASSERT_TRUE(mapping);
+  mapping.get()[0] = 'z';
+  mapping.reset();
+
+  EXPECT_EQ(ReadBack(), "zbcdefgh");
+}
+
+TEST_F(MapFileTests, InvalidDescriptorIsNotMapped)
+{
+  EXPECT_FALSE(MapFile(-1, 8, MapMode::PRIVATE));
+}
+
+}  // namespace
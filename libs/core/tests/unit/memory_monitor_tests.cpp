@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/memory_monitor.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+
+namespace {
+
+using fetch::core::MemoryMonitor;
+
+TEST(MemoryMonitorTests, UsageIsAccountedForEachSubsystem)
+{
+  MemoryMonitor monitor;
+
+  std::size_t cache_size{100};
+  monitor.AddSubsystem("test_cache", [&cache_size]() { return cache_size; });
+  monitor.AddSubsystem("test_pool", []() { return std::size_t{50}; });
+
+  // nothing is known until the first accounting
+  EXPECT_EQ(monitor.GetUsage("test_cache"), 0u);
+
+  monitor.Periodically();
+  EXPECT_EQ(monitor.GetUsage("test_cache"), 100u);
+  EXPECT_EQ(monitor.GetUsage("test_pool"), 50u);
+  EXPECT_EQ(monitor.GetUsage("unknown"), 0u);
+
+  cache_size = 200;
+  monitor.Periodically();
+  EXPECT_EQ(monitor.GetUsage("test_cache"), 200u);
+}
+
+TEST(MemoryMonitorTests, SubsystemIsOnlyTrimmedWhenOverItsLimit)
+{
+  MemoryMonitor monitor;
+
+  std::size_t cache_size{100};
+  std::size_t trims{0};
+  monitor.AddSubsystem("test_trimmed_cache", [&cache_size]() { return cache_size; }, 150,
+                       [&cache_size, &trims]() {
+                         cache_size /= 4;
+                         ++trims;
+                       });
+
+  monitor.Periodically();
+  EXPECT_EQ(trims, 0u);
+  EXPECT_EQ(monitor.GetUsage("test_trimmed_cache"), 100u);
+
+  // over the limit the subsystem is trimmed, and the usage after trimming is reported
+  cache_size = 400;
+  monitor.Periodically();
+  EXPECT_EQ(trims, 1u);
+  EXPECT_EQ(monitor.GetUsage("test_trimmed_cache"), 100u);
+}
+
+TEST(MemoryMonitorTests, SubsystemWithoutLimitIsNeverTrimmed)
+{
+  MemoryMonitor monitor;
+
+  std::size_t trims{0};
+  monitor.AddSubsystem("test_unlimited_cache", []() { return std::size_t{1} << 40u; },
+                       MemoryMonitor::NO_LIMIT, [&trims]() { ++trims; });
+
+  monitor.Periodically();
+  EXPECT_EQ(trims, 0u);
+}
+
+}  // namespace
@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lcg.hpp"
+#include "core/random/lfg.hpp"
+#include "core/random/philox.hpp"
+#include "core/random/xoshiro.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::random::LaggedFibonacciGenerator;
+using fetch::random::LinearCongruentialGenerator;
+using fetch::random::Philox4x32;
+using fetch::random::Xoshiro256StarStar;
+
+template <typename T>
+class FillTests : public ::testing::Test
+{
+};
+
+using Generators = ::testing::Types<LinearCongruentialGenerator, LaggedFibonacciGenerator<>,
+                                    Philox4x32, Xoshiro256StarStar>;
+TYPED_TEST_CASE(FillTests, Generators);
+
+// sizes which start and end part way through the batches, lanes and buffers of the generators
+std::vector<std::size_t> const SIZES{0, 1, 3, 7, 16, 17, 255, 1278, 1279, 5000};
+
+TYPED_TEST(FillTests, CheckFillMatchesSequentialValues)
+{
+  TypeParam filled{123};
+  TypeParam sequential{123};
+
+  for (std::size_t size : SIZES)
+  {
+    std::vector<uint64_t> values(size);
+    filled.Fill(values.data(), values.size());
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      ASSERT_EQ(values[i], sequential()) << "size: " << size << " index: " << i;
+    }
+  }
+
+  // the generators remain in step after the fills
+  EXPECT_EQ(filled(), sequential());
+}
+
+TYPED_TEST(FillTests, CheckFillDoublesMatchesSequentialValues)
+{
+  TypeParam filled{123};
+  TypeParam sequential{123};
+
+  for (std::size_t size : SIZES)
+  {
+    std::vector<double> values(size);
+    filled.Fill(values.data(), values.size());
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      ASSERT_EQ(values[i], sequential.AsDouble()) << "size: " << size << " index: " << i;
+      ASSERT_GE(values[i], 0.0);
+      ASSERT_LE(values[i], 1.0);
+    }
+  }
+}
+
+}  // namespace
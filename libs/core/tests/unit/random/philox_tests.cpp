@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/philox.hpp"
+#include "core/random/xoshiro.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace {
+
+using fetch::random::Philox4x32;
+using fetch::random::Xoshiro256StarStar;
+
+TEST(PhiloxTests, CheckKnownAnswer)
+{
+  // known answer test vectors of the reference (Random123) implementation
+  EXPECT_EQ(Philox4x32::Generate({{0, 0, 0, 0}}, {{0, 0}}),
+            (Philox4x32::Block{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}));
+  EXPECT_EQ(Philox4x32::Generate({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                                 {{0xffffffff, 0xffffffff}}),
+            (Philox4x32::Block{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}));
+}
+
+TEST(PhiloxTests, CheckSeek)
+{
+  Philox4x32 generator{7};
+
+  std::vector<uint64_t> values(100);
+  generator.Fill(values.data(), values.size());
+  EXPECT_EQ(generator.Position(), values.size());
+
+  for (uint64_t position : {0u, 1u, 2u, 33u, 99u})
+  {
+    generator.Seek(position);
+    EXPECT_EQ(generator.Position(), position);
+    EXPECT_EQ(generator(), values[position]);
+  }
+}
+
+TEST(PhiloxTests, CheckSplitStreamsAreDeterministicAndDistinct)
+{
+  Philox4x32 const generator{7};
+
+  auto first  = generator.Split(1);
+  auto again  = generator.Split(1);
+  auto second = generator.Split(2);
+
+  std::set<uint64_t> seen{};
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    auto const value = first();
+    EXPECT_EQ(value, again());
+
+    seen.insert(value);
+    seen.insert(second());
+  }
+
+  EXPECT_EQ(seen.size(), 2000);
+}
+
+TEST(XoshiroTests, CheckSplitStreamsAreDeterministicAndDistinct)
+{
+  Xoshiro256StarStar const generator{7};
+
+  auto first  = generator.Split(1);
+  auto again  = generator.Split(1);
+  auto second = generator.Split(2);
+
+  std::set<uint64_t> seen{};
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    auto const value = first();
+    EXPECT_EQ(value, again());
+
+    seen.insert(value);
+    seen.insert(second());
+  }
+
+  EXPECT_EQ(seen.size(), 2000);
+
+  // stream zero is the generator itself
+  auto zero = generator.Split(0);
+  auto copy = generator;
+  EXPECT_EQ(zero(), copy());
+}
+
+}  // namespace
@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/reactor.hpp"
+#include "core/runnable.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using fetch::core::Reactor;
+using fetch::core::Runnable;
+
+class CountingRunnable : public Runnable
+{
+public:
+  explicit CountingRunnable(std::chrono::milliseconds duration = 0ms)
+    : duration_{duration}
+  {}
+
+  bool IsReadyToExecute() const override
+  {
+    return ready;
+  }
+
+  void Execute() override
+  {
+    std::size_t const concurrent = ++active_;
+    if (concurrent > max_concurrent)
+    {
+      max_concurrent = concurrent;
+    }
+
+    std::this_thread::sleep_for(duration_);
+    ++count;
+
+    --active_;
+  }
+
+  char const *GetId() const override
+  {
+    return "CountingRunnable";
+  }
+
+  std::atomic<bool>        ready{true};
+  std::atomic<std::size_t> count{0};
+  std::atomic<std::size_t> max_concurrent{0};
+
+private:
+  std::chrono::milliseconds const duration_;
+  std::atomic<std::size_t>        active_{0};
+};
+
+template <typename Predicate>
+bool WaitFor(Predicate const &predicate)
+{
+  auto const deadline = std::chrono::steady_clock::now() + 5s;
+
+  while (std::chrono::steady_clock::now() < deadline)
+  {
+    if (predicate())
+    {
+      return true;
+    }
+
+    std::this_thread::sleep_for(1ms);
+  }
+
+  return false;
+}
+
+TEST(ReactorTests, SlowRunnableDoesNotBlockOtherWorkers)
+{
+  auto slow = std::make_shared<CountingRunnable>(500ms);
+  auto fast = std::make_shared<CountingRunnable>();
+
+  Reactor reactor{"ReactorTests", 2};
+  ASSERT_TRUE(reactor.Attach(slow));
+  ASSERT_TRUE(reactor.Attach(fast));
+  reactor.Start();
+
+  // while the slow runnable occupies one worker the other keeps executing
+  EXPECT_TRUE(WaitFor([&fast]() { return fast->count >= 100; }));
+
+  reactor.Stop();
+
+  EXPECT_LE(slow->max_concurrent, 1u);
+  EXPECT_LE(fast->max_concurrent, 1u);
+}
+
+TEST(ReactorTests, DedicatedRunnableIsNotBlockedBySharedWorker)
+{
+  auto slow     = std::make_shared<CountingRunnable>(500ms);
+  auto critical = std::make_shared<CountingRunnable>();
+
+  Reactor reactor{"ReactorTests"};
+  ASSERT_TRUE(reactor.Attach(slow));
+  reactor.Start();
+
+  // attach after starting so that the dedicated thread is created on demand
+  ASSERT_TRUE(reactor.AttachDedicated(critical));
+  EXPECT_FALSE(reactor.Attach(critical));
+
+  EXPECT_TRUE(WaitFor([&critical]() { return critical->count >= 100; }));
+
+  reactor.Stop();
+}
+
+TEST(ReactorTests, RunnableIsNeverExecutedConcurrently)
+{
+  auto runnable = std::make_shared<CountingRunnable>(1ms);
+
+  Reactor reactor{"ReactorTests", 4};
+  ASSERT_TRUE(reactor.Attach(runnable));
+  reactor.Start();
+
+  EXPECT_TRUE(WaitFor([&runnable]() { return runnable->count >= 50; }));
+
+  reactor.Stop();
+
+  EXPECT_EQ(runnable->max_concurrent, 1u);
+}
+
+TEST(ReactorTests, WakeSchedulesReadyRunnable)
+{
+  auto runnable   = std::make_shared<CountingRunnable>();
+  runnable->ready = false;
+
+  Reactor reactor{"ReactorTests", 2};
+  ASSERT_TRUE(reactor.Attach(runnable));
+  reactor.Start();
+
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(runnable->count, 0u);
+
+  runnable->ready = true;
+  reactor.Wake();
+
+  EXPECT_TRUE(WaitFor([&runnable]() { return runnable->count > 0; }));
+
+  reactor.Stop();
+}
+
+TEST(ReactorTests, DetachedRunnableIsNoLongerExecuted)
+{
+  auto runnable = std::make_shared<CountingRunnable>();
+
+  Reactor reactor{"ReactorTests", 2};
+  ASSERT_TRUE(reactor.AttachDedicated(runnable));
+  reactor.Start();
+
+  EXPECT_TRUE(WaitFor([&runnable]() { return runnable->count > 0; }));
+  EXPECT_TRUE(reactor.Detach(*runnable));
+
+  // allow any in flight execution to complete
+  std::this_thread::sleep_for(20ms);
+  std::size_t const count = runnable->count;
+  std::this_thread::sleep_for(50ms);
+
+  EXPECT_EQ(runnable->count, count);
+
+  reactor.Stop();
+}
+
+}  // namespace
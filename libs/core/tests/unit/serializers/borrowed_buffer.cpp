@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/main_serializer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace serializers {
+namespace {
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+
+bool IsWithin(ConstByteArray const &value, ConstByteArray const &buffer)
+{
+  return (value.pointer() >= buffer.pointer()) &&
+         ((value.pointer() + value.size()) <= (buffer.pointer() + buffer.size()));
+}
+
+ConstByteArray Encode(std::vector<ConstByteArray> const &values)
+{
+  MsgPackSerializer serializer;
+  serializer << values;
+  return serializer.data();
+}
+
+TEST(MsgPackBorrowTests, ConstByteArraysShareTheBuffer)
+{
+  std::vector<ConstByteArray> const values{"first", "second", ConstByteArray(300)};
+  auto const                        encoded = Encode(values);
+
+  auto serializer = MsgPackSerializer::Borrow(encoded);
+
+  std::vector<ConstByteArray> decoded;
+  serializer >> decoded;
+
+  ASSERT_EQ(values, decoded);
+  for (auto const &value : decoded)
+  {
+    EXPECT_TRUE(IsWithin(value, encoded));
+  }
+}
+
+TEST(MsgPackBorrowTests, ByteArraysAreCopied)
+{
+  auto const encoded = Encode({"mutable"});
+
+  auto serializer = MsgPackSerializer::Borrow(encoded);
+
+  std::vector<ByteArray> decoded;
+  serializer >> decoded;
+
+  ASSERT_EQ(1, decoded.size());
+  EXPECT_EQ(decoded[0], "mutable");
+  EXPECT_FALSE(IsWithin(decoded[0], encoded));
+}
+
+TEST(MsgPackBorrowTests, BorrowedSubArray)
+{
+  auto const encoded = Encode({"alpha", "beta"});
+
+  // prefix the encoding so that the borrowed buffer does not start at the beginning of its memory
+  ByteArray padded;
+  padded.Append(ConstByteArray{"xx"}, encoded);
+  ConstByteArray const view = padded.SubArray(2);
+
+  auto serializer = MsgPackSerializer::Borrow(view);
+
+  std::vector<ConstByteArray> decoded;
+  serializer >> decoded;
+
+  EXPECT_EQ((std::vector<ConstByteArray>{"alpha", "beta"}), decoded);
+}
+
+TEST(MsgPackBorrowTests, Containers)
+{
+  std::map<std::string, uint64_t> const           ordered{{"a", 1}, {"b", 2}, {"c", 3}};
+  std::unordered_map<std::string, uint64_t> const unordered{{"x", 7}, {"y", 8}};
+
+  MsgPackSerializer encoder;
+  encoder << ordered << unordered;
+
+  auto serializer = MsgPackSerializer::Borrow(encoder.data());
+
+  std::map<std::string, uint64_t>           decoded_ordered;
+  std::unordered_map<std::string, uint64_t> decoded_unordered;
+  serializer >> decoded_ordered >> decoded_unordered;
+
+  EXPECT_EQ(ordered, decoded_ordered);
+  EXPECT_EQ(unordered, decoded_unordered);
+}
+
+TEST(MsgPackBorrowTests, WritesAreRejected)
+{
+  auto const encoded    = Encode({"value"});
+  auto       serializer = MsgPackSerializer::Borrow(encoded);
+
+  EXPECT_THROW(serializer.Allocate(1), std::runtime_error);
+  EXPECT_THROW(serializer.WriteByte(0), std::runtime_error);
+
+  // the source buffer is untouched
+  EXPECT_EQ(Encode({"value"}), encoded);
+}
+
+}  // namespace
+}  // namespace serializers
+}  // namespace fetch
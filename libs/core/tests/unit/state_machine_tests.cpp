@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/state_machine.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <memory>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+enum class State
+{
+  WAITING,
+  DONE
+};
+
+using StateMachine = fetch::core::StateMachine<State>;
+
+class Waiter
+{
+public:
+  Waiter()
+  {
+    state_machine_->RegisterHandler(State::WAITING, this, &Waiter::OnWaiting);
+    state_machine_->RegisterHandler(State::DONE, this, &Waiter::OnDone);
+  }
+
+  State OnWaiting()
+  {
+    if (trigger_during_handler)
+    {
+      state_machine_->Trigger();
+    }
+
+    state_machine_->Delay(1h);
+    return State::WAITING;
+  }
+
+  State OnDone()
+  {
+    return State::DONE;
+  }
+
+  StateMachine &state_machine()
+  {
+    return *state_machine_;
+  }
+
+  bool trigger_during_handler{false};
+
+private:
+  std::shared_ptr<StateMachine> state_machine_{
+      std::make_shared<StateMachine>("StateMachineTests", State::WAITING)};
+};
+
+TEST(StateMachineTests, TriggerCancelsDelay)
+{
+  Waiter waiter{};
+
+  waiter.state_machine().Execute();
+  EXPECT_FALSE(waiter.state_machine().IsReadyToExecute());
+
+  waiter.state_machine().Trigger();
+  EXPECT_TRUE(waiter.state_machine().IsReadyToExecute());
+
+  // the trigger has been consumed by the execution
+  waiter.state_machine().Execute();
+  EXPECT_FALSE(waiter.state_machine().IsReadyToExecute());
+}
+
+TEST(StateMachineTests, TriggerDuringHandlerOverridesDelay)
+{
+  Waiter waiter{};
+  waiter.trigger_during_handler = true;
+
+  waiter.state_machine().Execute();
+  EXPECT_TRUE(waiter.state_machine().IsReadyToExecute());
+}
+
+}  // namespace
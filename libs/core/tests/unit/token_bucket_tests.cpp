@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/token_bucket.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using fetch::core::TokenBucket;
+
+TEST(TokenBucketTests, BurstIsAvailableImmediately)
+{
+  auto const  start = TokenBucket::Clock::now();
+  TokenBucket bucket{10.0, 100.0, start};
+
+  EXPECT_EQ(bucket.Take(60, start), 60u);
+  EXPECT_EQ(bucket.Take(60, start), 40u);
+  EXPECT_EQ(bucket.Take(1, start), 0u);
+}
+
+TEST(TokenBucketTests, TokensAccumulateAtTheRate)
+{
+  auto const  start = TokenBucket::Clock::now();
+  TokenBucket bucket{10.0, 100.0, start};
+
+  EXPECT_EQ(bucket.Take(100, start), 100u);
+
+  EXPECT_EQ(bucket.Take(100, start + 500ms), 5u);
+  EXPECT_EQ(bucket.Take(100, start + 2s), 15u);
+}
+
+TEST(TokenBucketTests, TokensAreLimitedByTheBurst)
+{
+  auto const  start = TokenBucket::Clock::now();
+  TokenBucket bucket{10.0, 100.0, start};
+
+  EXPECT_EQ(bucket.Take(50, start), 50u);
+  EXPECT_DOUBLE_EQ(bucket.available(start + 1h), 100.0);
+  EXPECT_EQ(bucket.Take(1000, start + 1h), 100u);
+}
+
+}  // namespace
@@ -22,9 +22,16 @@
 
 #include "benchmark/benchmark.h"
 
+#include <set>
+#include <unordered_map>
+
 using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::ByteArray;
+using fetch::crypto::mcl::FixedBaseG2;
 using fetch::crypto::mcl::Generator;
+using fetch::crypto::mcl::PrecomputedG2;
+using fetch::crypto::mcl::PrivateKey;
+using fetch::crypto::mcl::PublicKey;
 using RNG = fetch::random::LinearCongruentialGenerator;
 
 namespace {
@@ -103,6 +110,78 @@ void VerifyBLSSignature(benchmark::State &state)
   }
 }
 
+void VerifyBLSSignaturePrecomputed(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::crypto::mcl::Generator generator;
+  fetch::crypto::mcl::SetGenerator(generator);
+
+  // Create keys
+  auto     cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t threshold    = cabinet_size / 2 + 1;
+  auto     outputs      = fetch::crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  // Randomly select index to sign
+  auto sign_index = static_cast<uint32_t>(rng() % cabinet_size);
+  // Randomly select another index to verify
+  auto verify_index = static_cast<uint32_t>(rng() % cabinet_size);
+
+  // Precompute the long-lived generator and public key
+  PrecomputedG2 const precomputed_generator{generator};
+  PrecomputedG2 const precomputed_key{outputs[verify_index].public_key_shares[sign_index]};
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    // Generate a random message
+    ConstByteArray msg = GenerateRandomData(256);
+    auto signature     = fetch::crypto::mcl::SignShare(msg, outputs[sign_index].private_key_share);
+    state.ResumeTiming();
+
+    // Verify message
+    fetch::crypto::mcl::VerifySign(precomputed_key, msg, signature, precomputed_generator);
+  }
+}
+
+void GeneratorMultiplication(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::crypto::mcl::Generator generator;
+  fetch::crypto::mcl::SetGenerator(generator);
+
+  PrivateKey scalar;
+  PublicKey  result;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    scalar.setRand();
+    state.ResumeTiming();
+
+    bn::G2::mul(result, generator, scalar);
+  }
+}
+
+void GeneratorMultiplicationFixedBase(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::crypto::mcl::Generator generator;
+  fetch::crypto::mcl::SetGenerator(generator);
+
+  FixedBaseG2 const generator_table{generator};
+  PrivateKey        scalar;
+  PublicKey         result;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    scalar.setRand();
+    state.ResumeTiming();
+
+    generator_table.Mul(result, scalar);
+  }
+}
+
 void ComputeGroupSignature(benchmark::State &state)
 {
   // Create keys
@@ -130,8 +209,59 @@ void ComputeGroupSignature(benchmark::State &state)
     fetch::crypto::mcl::LagrangeInterpolation(threshold_signatures);
   }
 }
+
+void ComputeGroupSignatureSameSigners(benchmark::State &state)
+{
+  // Create keys
+  fetch::crypto::mcl::details::MCLInitialiser();
+  auto     cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t threshold    = cabinet_size / 2 + 1;
+  auto     outputs      = fetch::crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  // Randomly select the indices which sign every message, so that the Lagrange coefficients of
+  // the signer set are reused between group signatures
+  std::set<uint32_t> signers;
+  while (signers.size() < threshold)
+  {
+    signers.insert(static_cast<uint32_t>(rng() % cabinet_size));
+  }
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    // Generate a random message
+    ConstByteArray msg = GenerateRandomData(256);
+    std::unordered_map<uint32_t, fetch::crypto::mcl::Signature> threshold_signatures;
+    for (auto const sign_index : signers)
+    {
+      auto signature = fetch::crypto::mcl::SignShare(msg, outputs[sign_index].private_key_share);
+      threshold_signatures.insert({sign_index, signature});
+    }
+    state.ResumeTiming();
+
+    // Compute group signature
+    fetch::crypto::mcl::LagrangeInterpolation(threshold_signatures);
+  }
+}
+
+void GenerateKeys(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  auto     cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t threshold    = cabinet_size / 2 + 1;
+
+  for (auto _ : state)
+  {
+    fetch::crypto::mcl::TrustedDealerGenerateKeys(cabinet_size, threshold);
+  }
+}
 }  // namespace
 
 BENCHMARK(SignBLSSignature)->RangeMultiplier(2)->Range(50, 500);
 BENCHMARK(VerifyBLSSignature)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(VerifyBLSSignaturePrecomputed)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(GeneratorMultiplication);
+BENCHMARK(GeneratorMultiplicationFixedBase);
 BENCHMARK(ComputeGroupSignature)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(ComputeGroupSignatureSameSigners)->RangeMultiplier(2)->Range(50, 500);
+BENCHMARK(GenerateKeys)->RangeMultiplier(2)->Range(50, 500);
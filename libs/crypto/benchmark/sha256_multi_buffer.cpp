@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "crypto/sha256_multi_buffer.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::Hash;
+using fetch::crypto::HashSHA256MultiBuffer;
+using fetch::crypto::SHA256;
+using fetch::random::LinearCongruentialGenerator;
+
+namespace {
+
+using Messages = std::vector<ConstByteArray>;
+
+constexpr std::size_t NUM_MESSAGES = 1024;
+
+Messages GenerateMessages(std::size_t size)
+{
+  LinearCongruentialGenerator rng;
+
+  Messages messages{};
+  messages.reserve(NUM_MESSAGES);
+  for (std::size_t i = 0; i < NUM_MESSAGES; ++i)
+  {
+    ByteArray message;
+    message.Resize(size);
+    for (std::size_t j = 0; j < size; ++j)
+    {
+      message[j] = static_cast<uint8_t>(rng());
+    }
+
+    messages.emplace_back(message);
+  }
+
+  return messages;
+}
+
+void SHA256_Sequential(benchmark::State &state)
+{
+  auto const messages = GenerateMessages(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    for (auto const &message : messages)
+    {
+      benchmark::DoNotOptimize(Hash<SHA256>(message));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_MESSAGES));
+}
+
+void SHA256_MultiBuffer(benchmark::State &state)
+{
+  auto const messages = GenerateMessages(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(HashSHA256MultiBuffer(messages));
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_MESSAGES));
+}
+
+}  // namespace
+
+// 64 bytes is the size of a merkle / key value index node (two concatenated digests)
+BENCHMARK(SHA256_Sequential)->Arg(32)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(SHA256_MultiBuffer)->Arg(32)->Arg(64)->Arg(256)->Arg(1024);
@@ -27,6 +27,7 @@
 
 using fetch::crypto::ECDSASigner;
 using fetch::crypto::ECDSAVerifier;
+using fetch::crypto::Verifier;
 using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::ByteArray;
 using fetch::random::LinearCongruentialGenerator;
@@ -80,6 +81,46 @@ void VerifySignature(benchmark::State &state)
   }
 }
 
+void VerifySignatureFromIdentity(benchmark::State &state)
+{
+  // generate a random message
+  ConstByteArray msg = GenerateRandomData<2048>();
+
+  // create the signer, the verifier is built from its identity on every verification
+  ECDSASigner signer;
+  auto const  identity = signer.identity();
+
+  // create the signed data
+  auto const signature = signer.Sign(msg);
+  if (signature.empty())
+  {
+    throw std::runtime_error("Unable to sign the message");
+  }
+
+  for (auto _ : state)
+  {
+    // run the verification
+    Verifier::Verify(identity, msg, signature);
+  }
+}
+
+void SignMessage(benchmark::State &state)
+{
+  // generate a random message
+  ConstByteArray msg = GenerateRandomData<2048>();
+
+  // create the signer
+  ECDSASigner signer;
+
+  for (auto _ : state)
+  {
+    // sign the message
+    benchmark::DoNotOptimize(signer.Sign(msg));
+  }
+}
+
 }  // namespace
 
 BENCHMARK(VerifySignature);
+BENCHMARK(VerifySignatureFromIdentity);
+BENCHMARK(SignMessage);
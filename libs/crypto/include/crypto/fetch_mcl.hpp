@@ -33,6 +33,7 @@
 #endif
 
 #include "mcl/bn256.hpp"
+#include "mcl/window_method.hpp"
 
 #if defined(__clang__)
 #pragma clang diagnostic pop
@@ -28,10 +28,16 @@
 #include <set>
 #include <sstream>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace bn = mcl::bn256;
 
 namespace fetch {
+namespace threading {
+class Pool;
+}  // namespace threading
+
 namespace crypto {
 namespace mcl {
 
@@ -80,6 +86,44 @@ public:
   explicit Generator(std::string const &string_to_hash);
 };
 
+/**
+ * A G2 element together with its precomputed Miller loop coefficients. Pairings against
+ * long-lived generators and public keys can then skip the line function evaluations
+ */
+class PrecomputedG2
+{
+public:
+  PrecomputedG2();
+  explicit PrecomputedG2(bn::G2 const &point);
+
+  bn::G2 const &              point() const;
+  std::vector<bn::Fp6> const &coefficients() const;
+
+private:
+  bn::G2               point_;
+  std::vector<bn::Fp6> coefficients_{};
+};
+
+/**
+ * Table of multiples of a fixed generator, for fast windowed multiplication of the generator by
+ * many scalars (key generation and the DKG consistency checks)
+ */
+class FixedBaseG2
+{
+public:
+  explicit FixedBaseG2(Generator const &generator);
+  FixedBaseG2(FixedBaseG2 const &) = delete;
+  FixedBaseG2 &operator=(FixedBaseG2 const &) = delete;
+
+  void      Mul(PublicKey &result, PrivateKey const &scalar) const;
+  PublicKey Mul(PrivateKey const &scalar) const;
+
+private:
+  static constexpr std::size_t WINDOW_SIZE = 5;
+
+  ::mcl::fp::WindowMethod<bn::G2> table_;
+};
+
 struct AggregatePrivateKey
 {
   AggregatePrivateKey() = default;
@@ -162,6 +206,10 @@ PublicKey ComputeLHS(PublicKey &tmpG, Generator const &G, Generator const &H,
                      PrivateKey const &share1, PrivateKey const &share2);
 PublicKey ComputeLHS(Generator const &G, Generator const &H, PrivateKey const &share1,
                      PrivateKey const &share2);
+PublicKey ComputeLHS(PublicKey &tmpG, FixedBaseG2 const &G, FixedBaseG2 const &H,
+                     PrivateKey const &share1, PrivateKey const &share2);
+PublicKey ComputeLHS(FixedBaseG2 const &G, FixedBaseG2 const &H, PrivateKey const &share1,
+                     PrivateKey const &share2);
 void      UpdateRHS(uint32_t rank, PublicKey &rhsG, std::vector<PublicKey> const &input);
 PublicKey ComputeRHS(uint32_t rank, std::vector<PublicKey> const &input);
 void      ComputeShares(PrivateKey &s_i, PrivateKey &sprime_i, std::vector<PrivateKey> const &a_i,
@@ -173,14 +221,30 @@ std::vector<PrivateKey> InterpolatePolynom(std::vector<PrivateKey> const &a,
 Signature SignShare(MessagePayload const &message, PrivateKey const &x_i);
 bool      VerifySign(PublicKey const &y, MessagePayload const &message, Signature const &sign,
                      Generator const &G);
+bool      VerifySign(PrecomputedG2 const &y, MessagePayload const &message, Signature const &sign,
+                     PrecomputedG2 const &G);
 Signature LagrangeInterpolation(std::unordered_map<CabinetIndex, Signature> const &shares);
+
+// For batches of signatures
+bool VerifySignBatch(std::vector<PublicKey> const &public_keys, MessagePayload const &message,
+                     std::vector<Signature> const &signatures, Generator const &G);
+bool VerifySignBatch(std::vector<PublicKey> const &     public_keys,
+                     std::vector<MessagePayload> const &messages,
+                     std::vector<Signature> const &signatures, Generator const &G);
+std::vector<std::size_t> FindInvalidSignatures(std::vector<PublicKey> const &public_keys,
+                                               MessagePayload const &        message,
+                                               std::vector<Signature> const &signatures,
+                                               Generator const &G, threading::Pool *pool = nullptr);
 std::vector<DkgKeyInformation> TrustedDealerGenerateKeys(uint32_t cabinet_size, uint32_t threshold);
 std::pair<PrivateKey, PublicKey> GenerateKeyPair(Generator const &generator);
+std::pair<PrivateKey, PublicKey> GenerateKeyPair(FixedBaseG2 const &generator);
 
 // For aggregate signatures. Note only the verification of the signatures is done using VerifySign
 // but one must compute the public key to verify with
 PrivateKey         SignatureAggregationCoefficient(PublicKey const &             notarisation_key,
                                                    std::vector<PublicKey> const &cabinet_notarisation_keys);
+std::vector<AggregatePublicKey> ComputeCabinetAggregatePublicKeys(
+    std::vector<PublicKey> const &cabinet_public_keys);
 Signature          AggregateSign(MessagePayload const &     message,
                                  AggregatePrivateKey const &aggregate_private_key);
 AggregateSignature ComputeAggregateSignature(
@@ -258,9 +258,37 @@ private:
     return public_key;
   }
 
+  /**
+   * The curve group shared by all public keys, with the multiples of the generator precomputed.
+   * Verification multiplies the generator by a public scalar, which uses the precomputed table,
+   * and keys only take a reference to it.
+   */
+  static EC_GROUP const *VerificationGroup()
+  {
+    static UniquePointerType<EC_GROUP> const group = [] {
+      auto precomputed = createGroup();
+      if (EC_GROUP_precompute_mult(precomputed.get(), nullptr) == 0)
+      {
+        throw std::runtime_error(
+            "ECDSAPublicKey::VerificationGroup(): "
+            "EC_GROUP_precompute_mult(...) failed.");
+      }
+      return precomputed;
+    }();
+
+    return group.get();
+  }
+
   static UniquePointerType<EC_KEY> ConvertToECKEY(EC_POINT const *key_EC_POINT)
   {
-    UniquePointerType<EC_KEY> key{EC_KEY_new_by_curve_name(EcdsaCurveType::nid)};
+    UniquePointerType<EC_KEY> key{EC_KEY_new()};
+    if (!key || (EC_KEY_set_group(key.get(), VerificationGroup()) == 0))
+    {
+      throw std::runtime_error(
+          "ECDSAPublicKey::ConvertToECKEY(...): "
+          "EC_KEY_set_group(...) failed.");
+    }
+
     // TODO(issue 36): setting conv. form might not be really necessary (stuff
     // works
     // without it)
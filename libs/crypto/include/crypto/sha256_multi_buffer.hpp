@@ -0,0 +1,63 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * The number of messages which are hashed in parallel by the multi-buffer SHA256 implementation.
+ * When the library is built for AVX2 each message occupies one 32-bit lane of the vector
+ * registers, otherwise the messages are hashed one at a time.
+ */
+#ifdef __AVX2__
+constexpr std::size_t SHA256_MULTI_BUFFER_LANES = 8;
+#else
+constexpr std::size_t SHA256_MULTI_BUFFER_LANES = 1;
+#endif
+
+/**
+ * Hash a number of independent messages with SHA256. The digests are identical to those produced
+ * by crypto::SHA256, this is simply a faster way of hashing many small inputs.
+ *
+ * @param messages The array of pointers to the messages
+ * @param sizes The array of message sizes (in bytes)
+ * @param count The number of messages
+ * @param digests The output buffer, count * 32 bytes, the digests are written contiguously
+ */
+void HashSHA256MultiBuffer(uint8_t const *const *messages, std::size_t const *sizes,
+                           std::size_t count, uint8_t *digests);
+
+/**
+ * Hash a number of independent messages with SHA256
+ *
+ * @param messages The messages to be hashed
+ * @return The digests for each of the messages (in the same order)
+ */
+std::vector<byte_array::ByteArray> HashSHA256MultiBuffer(
+    std::vector<byte_array::ConstByteArray> const &messages);
+
+}  // namespace crypto
+}  // namespace fetch
@@ -0,0 +1,69 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/identity.hpp"
+#include "crypto/verifier.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * A cache of verifiers keyed on the identity of the signer.
+ *
+ * Building a verifier requires the public key to be decoded into its curve representation, which
+ * is a significant part of the cost of checking a signature. When a batch of signatures is checked
+ * it is common for the same identity to appear multiple times, the cache allows this work to be
+ * done only once per batch.
+ *
+ * The cache is not thread safe and is expected to be owned by a single thread.
+ */
+class VerifierCache
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  // Construction / Destruction
+  VerifierCache()                      = default;
+  VerifierCache(VerifierCache const &) = delete;
+  VerifierCache(VerifierCache &&)      = default;
+  ~VerifierCache()                     = default;
+
+  bool Verify(Identity const &identity, ConstByteArray const &data,
+              ConstByteArray const &signature);
+
+  void        Clear();
+  std::size_t size() const;
+
+  // Operators
+  VerifierCache &operator=(VerifierCache const &) = delete;
+  VerifierCache &operator=(VerifierCache &&) = default;
+
+private:
+  using VerifierPtr = std::unique_ptr<Verifier>;
+  using Verifiers   = std::unordered_map<Identity, VerifierPtr>;
+
+  Verifiers verifiers_;
+};
+
+}  // namespace crypto
+}  // namespace fetch
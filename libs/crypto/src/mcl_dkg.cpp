@@ -18,12 +18,22 @@
 
 #include "crypto/mcl_dkg.hpp"
 
+#include "core/mutex.hpp"
 #include "mcl/bn256.hpp"
+#include "vectorise/threading/pool.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <map>
+#include <random>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace bn = mcl::bn256;
 
@@ -66,6 +76,43 @@ Generator::Generator(std::string const &string_to_hash)
   bn::hashAndMapToG2(*this, string_to_hash);
 }
 
+PrecomputedG2::PrecomputedG2()
+{
+  point_.clear();
+}
+
+PrecomputedG2::PrecomputedG2(bn::G2 const &point)
+  : point_{point}
+{
+  bn::precomputeG2(coefficients_, point_);
+}
+
+bn::G2 const &PrecomputedG2::point() const
+{
+  return point_;
+}
+
+std::vector<bn::Fp6> const &PrecomputedG2::coefficients() const
+{
+  return coefficients_;
+}
+
+FixedBaseG2::FixedBaseG2(Generator const &generator)
+  : table_{generator, bn::Fr::getBitSize(), WINDOW_SIZE}
+{}
+
+void FixedBaseG2::Mul(PublicKey &result, PrivateKey const &scalar) const
+{
+  table_.mul(result, scalar);
+}
+
+PublicKey FixedBaseG2::Mul(PrivateKey const &scalar) const
+{
+  PublicKey result;
+  Mul(result, scalar);
+  return result;
+}
+
 AggregatePublicKey::AggregatePublicKey(PublicKey const &public_key, PrivateKey const &coefficient)
 {
   bn::G2::mul(aggregate_public_key, public_key, coefficient);
@@ -119,17 +166,46 @@ PublicKey ComputeLHS(Generator const &G, Generator const &H, PrivateKey const &s
   return ComputeLHS(tmpG, G, H, share1, share2);
 }
 
+PublicKey ComputeLHS(PublicKey &tmpG, FixedBaseG2 const &G, FixedBaseG2 const &H,
+                     PrivateKey const &share1, PrivateKey const &share2)
+{
+  PublicKey lhsG;
+  G.Mul(tmpG, share1);
+  bn::G2::add(lhsG, tmpG, H.Mul(share2));
+
+  return lhsG;
+}
+
+PublicKey ComputeLHS(FixedBaseG2 const &G, FixedBaseG2 const &H, PrivateKey const &share1,
+                     PrivateKey const &share2)
+{
+  PublicKey tmpG;
+  return ComputeLHS(tmpG, G, H, share1, share2);
+}
+
+/**
+ * Adds the evaluation of the commitment polynomial at rank + 1, excluding the constant term, to
+ * rhsG. Horner's method only multiplies by the small point rank + 1, which is much cheaper than
+ * multiplying each coefficient by the full size power (rank + 1)^k
+ */
 void UpdateRHS(uint32_t rank, PublicKey &rhsG, std::vector<PublicKey> const &input)
 {
-  PrivateKey tmpF{1};
-  PublicKey  tmpG;
   assert(!input.empty());
-  for (uint32_t k = 1; k < input.size(); k++)
+  if (input.size() == 1)
   {
-    bn::Fr::pow(tmpF, rank + 1, k);  // adjust rank in computation
-    bn::G2::mul(tmpG, input[k], tmpF);
-    bn::G2::add(rhsG, rhsG, tmpG);
+    return;
   }
+
+  auto const x = static_cast<int64_t>(rank) + 1;  // adjust rank in computation
+
+  PublicKey tmpG{input.back()};
+  for (std::size_t k = input.size() - 2; k > 0; --k)
+  {
+    bn::G2::mul(tmpG, tmpG, x);
+    bn::G2::add(tmpG, tmpG, input[k]);
+  }
+  bn::G2::mul(tmpG, tmpG, x);
+  bn::G2::add(rhsG, rhsG, tmpG);
 }
 
 PublicKey ComputeRHS(uint32_t rank, std::vector<PublicKey> const &input)
@@ -156,18 +232,19 @@ PublicKey ComputeRHS(uint32_t rank, std::vector<PublicKey> const &input)
 void ComputeShares(PrivateKey &s_i, PrivateKey &sprime_i, std::vector<PrivateKey> const &a_i,
                    std::vector<PrivateKey> const &b_i, uint32_t index)
 {
-  PrivateKey pow, tmpF;
   assert(a_i.size() == b_i.size());
   assert(!a_i.empty());
-  s_i      = a_i[0];
-  sprime_i = b_i[0];
-  for (uint32_t k = 1; k < a_i.size(); k++)
+  PrivateKey const x{index + 1};  // adjust index in computation
+
+  // Horner's method
+  s_i      = a_i.back();
+  sprime_i = b_i.back();
+  for (std::size_t k = a_i.size() - 1; k > 0; --k)
   {
-    bn::Fr::pow(pow, index + 1, k);  // adjust index in computation
-    bn::Fr::mul(tmpF, pow, b_i[k]);  // j^k * b_i[k]
-    bn::Fr::add(sprime_i, sprime_i, tmpF);
-    bn::Fr::mul(tmpF, pow, a_i[k]);  // j^k * a_i[k]
-    bn::Fr::add(s_i, s_i, tmpF);
+    bn::Fr::mul(s_i, s_i, x);
+    bn::Fr::add(s_i, s_i, a_i[k - 1]);
+    bn::Fr::mul(sprime_i, sprime_i, x);
+    bn::Fr::add(sprime_i, sprime_i, b_i[k - 1]);
   }
 }
 
@@ -278,6 +355,118 @@ bool VerifySign(PublicKey const &y, MessagePayload const &message, Signature con
   return e1 == e2;
 }
 
+/**
+ * Verifies a signature against a precomputed public key and generator, which shares a single
+ * final exponentiation between both pairings
+ *
+ * @param y The precomputed public key (can be the group public key, or public key share)
+ * @param message Message that was signed
+ * @param sign Signature to be verified
+ * @param G Precomputed generator used in DKG
+ * @return
+ */
+bool VerifySign(PrecomputedG2 const &y, MessagePayload const &message, Signature const &sign,
+                PrecomputedG2 const &G)
+{
+  Signature PH;
+  bn::Fp12  e;
+  bn::Fp    Hm;
+  Hm.setHashOf(message.pointer(), message.size());
+  bn::mapToG1(PH, Hm);
+  bn::G1::neg(PH, PH);
+
+  // e(sign, G) * e(-H(m), y) == 1
+  bn::precomputedMillerLoop2(e, sign, G.coefficients(), PH, y.coefficients());
+  bn::finalExp(e, e);
+
+  return e.isOne();
+}
+
+namespace {
+
+/**
+ * Lagrange coefficients at zero of the most recently seen signer sets. Consecutive group
+ * signatures are mostly computed from the same members, so the field inversions and the
+ * quadratic number of multiplications are only paid once per set
+ */
+class LagrangeCoefficientCache
+{
+public:
+  using Signers      = std::vector<CabinetIndex>;
+  using Coefficients = std::vector<PrivateKey>;
+
+  static constexpr std::size_t MAX_CACHED_SETS = 16;
+
+  /**
+   * @param signers Cabinet indices of the signers in ascending order
+   * @return The coefficient of each signer
+   */
+  Coefficients Get(Signers const &signers)
+  {
+    {
+      FETCH_LOCK(mutex_);
+      auto it = coefficients_.find(signers);
+      if (it != coefficients_.end())
+      {
+        return it->second;
+      }
+    }
+
+    Coefficients coefficients = Compute(signers);
+
+    FETCH_LOCK(mutex_);
+    if (coefficients_.emplace(signers, coefficients).second)
+    {
+      insertion_order_.push_back(signers);
+      if (insertion_order_.size() > MAX_CACHED_SETS)
+      {
+        coefficients_.erase(insertion_order_.front());
+        insertion_order_.pop_front();
+      }
+    }
+
+    return coefficients;
+  }
+
+private:
+  static Coefficients Compute(Signers const &signers)
+  {
+    PrivateKey a{1};
+    for (auto const index : signers)
+    {
+      a *= bn::Fr(index + 1);
+    }
+
+    Coefficients coefficients(signers.size());
+    for (std::size_t i = 0; i < signers.size(); ++i)
+    {
+      auto b = static_cast<bn::Fr>(signers[i] + 1);
+      for (auto const index : signers)
+      {
+        if (index != signers[i])
+        {
+          b *= static_cast<bn::Fr>(index) - static_cast<bn::Fr>(signers[i]);
+        }
+      }
+      bn::Fr::div(coefficients[i], a, b);
+    }
+
+    return coefficients;
+  }
+
+  Mutex                           mutex_;
+  std::map<Signers, Coefficients> coefficients_;
+  std::deque<Signers>             insertion_order_;
+};
+
+LagrangeCoefficientCache &GetLagrangeCoefficientCache()
+{
+  static LagrangeCoefficientCache cache;
+  return cache;
+}
+
+}  // namespace
+
 /**
  * Computes the group signature using the indices and signature shares of threshold_ + 1
  * parties
@@ -294,29 +483,296 @@ Signature LagrangeInterpolation(std::unordered_map<CabinetIndex, Signature> cons
   }
   Signature res;
 
-  PrivateKey a{1};
-  for (auto &p : shares)
+  std::vector<CabinetIndex> signers;
+  signers.reserve(shares.size());
+  for (auto const &p : shares)
   {
-    a *= bn::Fr(p.first + 1);
+    signers.push_back(p.first);
   }
+  std::sort(signers.begin(), signers.end());
 
-  for (auto &p1 : shares)
+  auto const coefficients = GetLagrangeCoefficientCache().Get(signers);
+
+  for (std::size_t i = 0; i < signers.size(); ++i)
   {
-    auto b = static_cast<bn::Fr>(p1.first + 1);
-    for (auto &p2 : shares)
-    {
-      if (p2.first != p1.first)
-      {
-        b *= static_cast<bn::Fr>(p2.first) - static_cast<bn::Fr>(p1.first);
-      }
-    }
     Signature t;
-    bn::G1::mul(t, p1.second, a / b);
+    bn::G1::mul(t, shares.at(signers[i]), coefficients[i]);
     res += t;
   }
   return res;
 }
 
+namespace {
+
+Signature HashToG1(MessagePayload const &message)
+{
+  Signature PH;
+  bn::Fp    Hm;
+  Hm.setHashOf(message.pointer(), message.size());
+  bn::mapToG1(PH, Hm);
+  return PH;
+}
+
+/**
+ * Random non-zero 63 bit coefficient used to weight the signatures of a batch
+ */
+bn::Fr RandomBatchCoefficient(std::random_device &rng)
+{
+  uint64_t const value = (static_cast<uint64_t>(rng()) << 31u) ^ static_cast<uint64_t>(rng());
+  return bn::Fr{static_cast<int64_t>((value & 0x7fffffffffffffffull) | 1u)};
+}
+
+/**
+ * Checks the signatures [begin, end) of a batch with a single product of pairings. Each signature
+ * and public key is weighted by an independent random 63 bit coefficient r_i, so that
+ *
+ *   e(sum(r_i * sig_i), G) == e(H(m), sum(r_i * y_i))
+ *
+ * can only hold for a batch containing an invalid signature with probability 2^-63, and the
+ * invalid signatures can not be constructed to cancel each other out.
+ */
+bool VerifyRange(std::vector<PublicKey> const &public_keys, Signature const &hashed_message,
+                 std::vector<Signature> const &signatures, Generator const &G, std::size_t begin,
+                 std::size_t end)
+{
+  assert(begin < end);
+
+  Signature sig_sum;
+  PublicKey key_sum;
+
+  if ((end - begin) == 1)
+  {
+    sig_sum = signatures[begin];
+    key_sum = public_keys[begin];
+  }
+  else
+  {
+    std::random_device rng;
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      bn::Fr const coefficient = RandomBatchCoefficient(rng);
+
+      Signature weighted_sig;
+      PublicKey weighted_key;
+      bn::G1::mul(weighted_sig, signatures[i], coefficient);
+      bn::G2::mul(weighted_key, public_keys[i], coefficient);
+
+      sig_sum += weighted_sig;
+      key_sum += weighted_key;
+    }
+  }
+
+  // e(sig_sum, G) * e(-H(m), key_sum) == 1, sharing the final exponentiation
+  Signature negated_message;
+  bn::G1::neg(negated_message, hashed_message);
+
+  bn::Fp12 e1, e2;
+  bn::millerLoop(e1, sig_sum, G);
+  bn::millerLoop(e2, negated_message, key_sum);
+  e1 *= e2;
+  bn::finalExp(e1, e1);
+
+  return e1.isOne();
+}
+
+/**
+ * Locate the invalid signatures of a range which is known to contain at least one by repeatedly
+ * splitting it in half
+ */
+void BisectRange(std::vector<PublicKey> const &public_keys, Signature const &hashed_message,
+                 std::vector<Signature> const &signatures, Generator const &G, std::size_t begin,
+                 std::size_t end, std::vector<std::size_t> &invalid)
+{
+  if ((end - begin) == 1)
+  {
+    invalid.push_back(begin);
+    return;
+  }
+
+  std::size_t const middle = begin + ((end - begin) / 2);
+
+  bool const lower_valid = VerifyRange(public_keys, hashed_message, signatures, G, begin, middle);
+  if (!lower_valid)
+  {
+    BisectRange(public_keys, hashed_message, signatures, G, begin, middle, invalid);
+  }
+
+  // when the lower half is valid the upper half must contain the invalid signature
+  if (!lower_valid && VerifyRange(public_keys, hashed_message, signatures, G, middle, end))
+  {
+    return;
+  }
+
+  BisectRange(public_keys, hashed_message, signatures, G, middle, end, invalid);
+}
+
+}  // namespace
+
+/**
+ * Verifies that every signature of a batch is a valid signature of the same message, this costs a
+ * scalar multiplication per signature and a single product of two pairings (rather than two
+ * pairings per signature)
+ *
+ * @param public_keys The public key (share) of each signature
+ * @param message Message that was signed
+ * @param signatures Signatures to be verified
+ * @param G Generator used in DKG
+ * @return true if all of the signatures are valid, otherwise false
+ */
+bool VerifySignBatch(std::vector<PublicKey> const &public_keys, MessagePayload const &message,
+                     std::vector<Signature> const &signatures, Generator const &G)
+{
+  assert(public_keys.size() == signatures.size());
+
+  if (signatures.empty())
+  {
+    return true;
+  }
+
+  return VerifyRange(public_keys, HashToG1(message), signatures, G, 0, signatures.size());
+}
+
+/**
+ * Verifies that every signature of a batch is a valid signature of its own message. Each hashed
+ * message is weighted by an independent random coefficient r_i, so that
+ *
+ *   e(sum(r_i * sig_i), G) == prod(e(r_i * H(m_i), y_i))
+ *
+ * costs one Miller loop per signature plus one and a single final exponentiation (rather than two
+ * pairings per signature)
+ *
+ * @param public_keys The public key of each signature
+ * @param messages Message signed by each signature
+ * @param signatures Signatures to be verified
+ * @param G Generator used in DKG
+ * @return true if all of the signatures are valid, otherwise false
+ */
+bool VerifySignBatch(std::vector<PublicKey> const &     public_keys,
+                     std::vector<MessagePayload> const &messages,
+                     std::vector<Signature> const &signatures, Generator const &G)
+{
+  assert(public_keys.size() == signatures.size());
+  assert(messages.size() == signatures.size());
+
+  if (signatures.empty())
+  {
+    return true;
+  }
+
+  if (signatures.size() == 1)
+  {
+    return VerifySign(public_keys[0], messages[0], signatures[0], G);
+  }
+
+  std::random_device rng;
+  Signature          sig_sum;
+  bn::Fp12           e, tmp;
+
+  for (std::size_t i = 0; i < signatures.size(); ++i)
+  {
+    bn::Fr const coefficient = RandomBatchCoefficient(rng);
+
+    Signature weighted_sig;
+    bn::G1::mul(weighted_sig, signatures[i], coefficient);
+    sig_sum += weighted_sig;
+
+    // e(-r_i * H(m_i), y_i)
+    Signature weighted_message;
+    bn::G1::mul(weighted_message, HashToG1(messages[i]), coefficient);
+    bn::G1::neg(weighted_message, weighted_message);
+
+    bn::millerLoop(tmp, weighted_message, public_keys[i]);
+    if (i == 0)
+    {
+      e = tmp;
+    }
+    else
+    {
+      e *= tmp;
+    }
+  }
+
+  bn::millerLoop(tmp, sig_sum, G);
+  e *= tmp;
+  bn::finalExp(e, e);
+
+  return e.isOne();
+}
+
+/**
+ * Finds the invalid signatures of a batch of signatures of the same message. The whole batch is
+ * verified at once and it is only bisected when that fails. The search for the invalid signatures
+ * is shared between the threads of a pool when one is given.
+ *
+ * @param public_keys The public key (share) of each signature
+ * @param message Message that was signed
+ * @param signatures Signatures to be verified
+ * @param G Generator used in DKG
+ * @param pool Optional pool of threads, which must not include the calling thread
+ * @return The indices of the invalid signatures, in ascending order
+ */
+std::vector<std::size_t> FindInvalidSignatures(std::vector<PublicKey> const &public_keys,
+                                               MessagePayload const &        message,
+                                               std::vector<Signature> const &signatures,
+                                               Generator const &G, threading::Pool *pool)
+{
+  assert(public_keys.size() == signatures.size());
+
+  std::vector<std::size_t> invalid{};
+  std::size_t const        num_signatures = signatures.size();
+
+  if (num_signatures == 0)
+  {
+    return invalid;
+  }
+
+  Signature const hashed_message = HashToG1(message);
+  if (VerifyRange(public_keys, hashed_message, signatures, G, 0, num_signatures))
+  {
+    return invalid;
+  }
+
+  std::size_t const num_chunks =
+      (pool == nullptr) ? 1 : std::min(pool->concurrency(), num_signatures);
+
+  if (num_chunks <= 1)
+  {
+    BisectRange(public_keys, hashed_message, signatures, G, 0, num_signatures, invalid);
+    return invalid;
+  }
+
+  // verify each chunk in parallel, bisecting only the chunks which fail
+  std::vector<std::vector<std::size_t>> chunk_invalid(num_chunks);
+  std::vector<std::future<void>>        tasks{};
+  tasks.reserve(num_chunks);
+
+  for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+  {
+    std::size_t const begin = (chunk * num_signatures) / num_chunks;
+    std::size_t const end   = ((chunk + 1) * num_signatures) / num_chunks;
+
+    tasks.emplace_back(pool->Dispatch([&, chunk, begin, end]() {
+      if (!VerifyRange(public_keys, hashed_message, signatures, G, begin, end))
+      {
+        BisectRange(public_keys, hashed_message, signatures, G, begin, end, chunk_invalid[chunk]);
+      }
+    }));
+  }
+
+  for (auto &task : tasks)
+  {
+    task.get();
+  }
+
+  for (auto const &indices : chunk_invalid)
+  {
+    invalid.insert(invalid.end(), indices.begin(), indices.end());
+  }
+
+  return invalid;
+}
+
 /**
  * Generates the group public key, public key shares and private key share for a number of
  * parties and a given signature threshold. Nodes must be allocated the outputs according
@@ -331,6 +787,7 @@ std::vector<DkgKeyInformation> TrustedDealerGenerateKeys(uint32_t cabinet_size,
   std::vector<DkgKeyInformation> output;
   Generator                      generator;
   SetGenerator(generator);
+  FixedBaseG2 const generator_table{generator};
 
   // Construct polynomial of degree threshold - 1
   std::vector<PrivateKey> vec_a;
@@ -348,7 +805,7 @@ std::vector<DkgKeyInformation> TrustedDealerGenerateKeys(uint32_t cabinet_size,
   // Group secret key is polynomial evaluated at 0
   PublicKey  group_public_key;
   PrivateKey group_private_key = vec_a[0];
-  bn::G2::mul(group_public_key, generator, group_private_key);
+  generator_table.Mul(group_public_key, group_private_key);
 
   // Generate cabinet public keys from their private key contributions
   for (uint32_t i = 0; i < cabinet_size; ++i)
@@ -366,7 +823,7 @@ std::vector<DkgKeyInformation> TrustedDealerGenerateKeys(uint32_t cabinet_size,
     }
     // Public key from private
     PublicKey public_key;
-    bn::G2::mul(public_key, generator, private_key);
+    generator_table.Mul(public_key, private_key);
     public_key_shares[i]  = public_key;
     private_key_shares[i] = private_key;
   }
@@ -394,15 +851,35 @@ std::pair<PrivateKey, PublicKey> GenerateKeyPair(Generator const &generator)
 }
 
 /**
- * Computes a deterministic hash to the finite prime field from one public key and the set
- * of all eligible notarisation keys
+ * Generates a private key and the corresponding public key using a precomputed generator table
  *
- * @param notarisation_key Particular public key of a cabinet member
- * @param cabinet_notarisation_keys Public keys of all cabinet members
- * @return Element of prime field
+ * @param generator Table of multiples of the generator on the elliptic curve
+ * @return Pair of private and public keys
  */
-PrivateKey SignatureAggregationCoefficient(PublicKey const &             notarisation_key,
-                                           std::vector<PublicKey> const &cabinet_notarisation_keys)
+std::pair<PrivateKey, PublicKey> GenerateKeyPair(FixedBaseG2 const &generator)
+{
+  std::pair<PrivateKey, PublicKey> key_pair;
+  key_pair.first.setRand();
+  generator.Mul(key_pair.second, key_pair.first);
+  return key_pair;
+}
+
+namespace {
+
+std::string ConcatenateKeys(std::vector<PublicKey> const &cabinet_notarisation_keys)
+{
+  std::string concatenated_keys;
+  concatenated_keys.reserve(cabinet_notarisation_keys.size() * PUBLIC_KEY_BYTE_SIZE);
+
+  for (auto const &key : cabinet_notarisation_keys)
+  {
+    concatenated_keys += key.getStr();
+  }
+  return concatenated_keys;
+}
+
+PrivateKey AggregationCoefficient(std::string const &notarisation_key,
+                                  std::string const &concatenated_cabinet_keys)
 {
   PrivateKey coefficient;
 
@@ -412,20 +889,56 @@ PrivateKey SignatureAggregationCoefficient(PublicKey const &             notaris
       "BLS Aggregation 00000000000000000000000000000000";
 
   std::string concatenated_keys;
-  concatenated_keys.reserve(hash_function_reuse_appender.length() +
-                            (cabinet_notarisation_keys.size() + 1) * PUBLIC_KEY_BYTE_SIZE);
+  concatenated_keys.reserve(hash_function_reuse_appender.length() + notarisation_key.length() +
+                            concatenated_cabinet_keys.length());
 
   concatenated_keys += hash_function_reuse_appender;
+  concatenated_keys += notarisation_key;
+  concatenated_keys += concatenated_cabinet_keys;
 
-  concatenated_keys += notarisation_key.getStr();
-  for (auto const &key : cabinet_notarisation_keys)
-  {
-    concatenated_keys += key.getStr();
-  }
   coefficient.setHashOf(concatenated_keys);
   return coefficient;
 }
 
+}  // namespace
+
+/**
+ * Computes a deterministic hash to the finite prime field from one public key and the set
+ * of all eligible notarisation keys
+ *
+ * @param notarisation_key Particular public key of a cabinet member
+ * @param cabinet_notarisation_keys Public keys of all cabinet members
+ * @return Element of prime field
+ */
+PrivateKey SignatureAggregationCoefficient(PublicKey const &             notarisation_key,
+                                           std::vector<PublicKey> const &cabinet_notarisation_keys)
+{
+  return AggregationCoefficient(notarisation_key.getStr(),
+                                ConcatenateKeys(cabinet_notarisation_keys));
+}
+
+/**
+ * Computes the aggregate public keys (public key multiplied by its aggregation coefficient) of
+ * every cabinet member. The cabinet keys are only serialised once, rather than once per member
+ *
+ * @param cabinet_public_keys Public keys of all cabinet members
+ * @return Aggregate public key of each cabinet member
+ */
+std::vector<AggregatePublicKey> ComputeCabinetAggregatePublicKeys(
+    std::vector<PublicKey> const &cabinet_public_keys)
+{
+  std::string const concatenated_keys = ConcatenateKeys(cabinet_public_keys);
+
+  std::vector<AggregatePublicKey> aggregate_public_keys;
+  aggregate_public_keys.reserve(cabinet_public_keys.size());
+  for (auto const &key : cabinet_public_keys)
+  {
+    aggregate_public_keys.emplace_back(key,
+                                       AggregationCoefficient(key.getStr(), concatenated_keys));
+  }
+  return aggregate_public_keys;
+}
+
 /**
  * Computes a signature which has been modified to allow fast addition into an aggregate signature
  *
@@ -479,6 +992,7 @@ PublicKey ComputeAggregatePublicKey(SignerRecord const &          signers,
 {
   PublicKey aggregate_key;
   assert(signers.size() == cabinet_public_keys.size());
+  std::string const concatenated_keys = ConcatenateKeys(cabinet_public_keys);
   for (size_t i = 0; i < cabinet_public_keys.size(); ++i)
   {
     if (signers[i] == 1)
@@ -486,7 +1000,7 @@ PublicKey ComputeAggregatePublicKey(SignerRecord const &          signers,
       // Compute public_key_i * coefficient_i
       PublicKey modified_public_key;
       bn::Fr    aggregate_coefficient =
-          SignatureAggregationCoefficient(cabinet_public_keys[i], cabinet_public_keys);
+          AggregationCoefficient(cabinet_public_keys[i].getStr(), concatenated_keys);
       bn::G2::mul(modified_public_key, cabinet_public_keys[i], aggregate_coefficient);
       bn::G2::add(aggregate_key, aggregate_key, modified_public_key);
     }
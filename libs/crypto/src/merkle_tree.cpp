@@ -19,11 +19,13 @@
 #include "crypto/hash.hpp"
 #include "crypto/merkle_tree.hpp"
 #include "crypto/sha256.hpp"
+#include "crypto/sha256_multi_buffer.hpp"
 #include "vectorise/platform.hpp"
 
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace fetch {
 namespace crypto {
@@ -63,17 +65,19 @@ void MerkleTree::CalculateRoot() const
     hashes.emplace_back();
   }
 
-  // Now, repeatedly condense the vector by calculating the parents of each of the roots
+  // Now, repeatedly condense the vector by calculating the parents of each of the roots. All the
+  // parents of a level are independent so they are hashed together
+  std::vector<Digest> concatenated_hashes{};
   while (hashes.size() > 1)
   {
-    for (std::size_t i = 0, j = 0; i < hashes.size(); i += 2, ++j)
+    concatenated_hashes.clear();
+    for (std::size_t i = 0; i < hashes.size(); i += 2)
     {
-      Digest concantenated_hash = hashes[i] + hashes[i + 1];
-      concantenated_hash        = Hash<crypto::SHA256>(concantenated_hash);
-      hashes[j]                 = concantenated_hash;
+      concatenated_hashes.emplace_back(hashes[i] + hashes[i + 1]);
     }
 
-    hashes.resize(hashes.size() / 2);
+    auto parents = HashSHA256MultiBuffer(concatenated_hashes);
+    hashes.assign(parents.begin(), parents.end());
   }
 
   assert(hashes.size() == 1);
@@ -0,0 +1,341 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "crypto/sha256_multi_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace crypto {
+namespace {
+
+constexpr std::size_t DIGEST_SIZE = SHA256::SIZE_IN_BYTES;
+
+void HashScalar(uint8_t const *message, std::size_t size, uint8_t *digest)
+{
+  Hash<SHA256>(message, size, digest);
+}
+
+#ifdef __AVX2__
+
+constexpr std::size_t BLOCK_SIZE = 64;
+constexpr std::size_t NUM_WORDS  = 16;
+constexpr std::size_t NUM_ROUNDS = 64;
+constexpr std::size_t LANES      = SHA256_MULTI_BUFFER_LANES;
+
+constexpr uint32_t ROUND_CONSTANTS[NUM_ROUNDS] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+constexpr uint32_t INITIAL_STATE[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+/**
+ * Provides the sequence of padded blocks for a single message. The complete blocks are read
+ * directly from the message, only the final (one or two) padded blocks are copied.
+ */
+class BlockSource
+{
+public:
+  BlockSource() = default;
+  BlockSource(uint8_t const *message, std::size_t size)
+    : message_{message}
+    , full_blocks_{size / BLOCK_SIZE}
+  {
+    std::size_t const remainder = size % BLOCK_SIZE;
+    if (remainder > 0)
+    {
+      std::memcpy(tail_, message + (full_blocks_ * BLOCK_SIZE), remainder);
+    }
+
+    // the padding byte and the 64-bit length may spill over into a second block
+    tail_[remainder] = 0x80;
+    tail_blocks_     = ((remainder + 1 + sizeof(uint64_t)) > BLOCK_SIZE) ? 2u : 1u;
+
+    uint64_t const bits = uint64_t{size} * 8u;
+    for (std::size_t i = 0; i < sizeof(uint64_t); ++i)
+    {
+      tail_[(tail_blocks_ * BLOCK_SIZE) - 1 - i] = static_cast<uint8_t>(bits >> (8u * i));
+    }
+  }
+
+  std::size_t num_blocks() const
+  {
+    return full_blocks_ + tail_blocks_;
+  }
+
+  uint8_t const *block(std::size_t index) const
+  {
+    if (index < full_blocks_)
+    {
+      return message_ + (index * BLOCK_SIZE);
+    }
+
+    return tail_ + ((index - full_blocks_) * BLOCK_SIZE);
+  }
+
+private:
+  uint8_t const *message_{nullptr};
+  std::size_t    full_blocks_{0};
+  std::size_t    tail_blocks_{0};
+  uint8_t        tail_[2 * BLOCK_SIZE]{};
+};
+
+template <int N>
+inline __m256i Rotr(__m256i x)
+{
+  return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+inline __m256i Add(__m256i a, __m256i b)
+{
+  return _mm256_add_epi32(a, b);
+}
+
+inline __m256i Xor(__m256i a, __m256i b, __m256i c)
+{
+  return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+}
+
+inline __m256i BigSigma0(__m256i x)
+{
+  return Xor(Rotr<2>(x), Rotr<13>(x), Rotr<22>(x));
+}
+
+inline __m256i BigSigma1(__m256i x)
+{
+  return Xor(Rotr<6>(x), Rotr<11>(x), Rotr<25>(x));
+}
+
+inline __m256i SmallSigma0(__m256i x)
+{
+  return Xor(Rotr<7>(x), Rotr<18>(x), _mm256_srli_epi32(x, 3));
+}
+
+inline __m256i SmallSigma1(__m256i x)
+{
+  return Xor(Rotr<17>(x), Rotr<19>(x), _mm256_srli_epi32(x, 10));
+}
+
+inline __m256i Choose(__m256i e, __m256i f, __m256i g)
+{
+  return _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+}
+
+inline __m256i Majority(__m256i a, __m256i b, __m256i c)
+{
+  return Xor(_mm256_and_si256(a, b), _mm256_and_si256(a, c), _mm256_and_si256(b, c));
+}
+
+inline uint32_t LoadBigEndian(uint8_t const *data)
+{
+  return (uint32_t{data[0]} << 24u) | (uint32_t{data[1]} << 16u) | (uint32_t{data[2]} << 8u) |
+         uint32_t{data[3]};
+}
+
+/**
+ * Hash up to LANES messages in parallel, one message per lane
+ *
+ * @param sources The block sources for each of the messages
+ * @param count The number of messages (lanes in use)
+ * @param digests The output buffer for the digests
+ */
+void HashLanes(BlockSource const *sources, std::size_t count, uint8_t *digests)
+{
+  static uint8_t const EMPTY_BLOCK[BLOCK_SIZE] = {};
+
+  __m256i state[8];
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    state[i] = _mm256_set1_epi32(static_cast<int>(INITIAL_STATE[i]));
+  }
+
+  std::size_t max_blocks{0};
+  for (std::size_t lane = 0; lane < count; ++lane)
+  {
+    max_blocks = std::max(max_blocks, sources[lane].num_blocks());
+  }
+
+  alignas(32) uint32_t words[NUM_WORDS][LANES];
+  alignas(32) uint32_t active[LANES];
+
+  for (std::size_t block = 0; block < max_blocks; ++block)
+  {
+    // transpose the next block of each message into the lanes
+    for (std::size_t lane = 0; lane < LANES; ++lane)
+    {
+      bool const is_active = (lane < count) && (block < sources[lane].num_blocks());
+
+      uint8_t const *data = is_active ? sources[lane].block(block) : EMPTY_BLOCK;
+      for (std::size_t i = 0; i < NUM_WORDS; ++i)
+      {
+        words[i][lane] = LoadBigEndian(data + (i * sizeof(uint32_t)));
+      }
+
+      active[lane] = is_active ? ~uint32_t{0} : 0u;
+    }
+
+    __m256i w[NUM_WORDS];
+    for (std::size_t i = 0; i < NUM_WORDS; ++i)
+    {
+      w[i] = _mm256_load_si256(reinterpret_cast<__m256i const *>(words[i]));
+    }
+
+    __m256i a = state[0];
+    __m256i b = state[1];
+    __m256i c = state[2];
+    __m256i d = state[3];
+    __m256i e = state[4];
+    __m256i f = state[5];
+    __m256i g = state[6];
+    __m256i h = state[7];
+
+    for (std::size_t round = 0; round < NUM_ROUNDS; ++round)
+    {
+      // the message schedule is computed in place over a rolling window of 16 words
+      __m256i &word = w[round % NUM_WORDS];
+      if (round >= NUM_WORDS)
+      {
+        word = Add(Add(word, SmallSigma0(w[(round + 1) % NUM_WORDS])),
+                   Add(w[(round + 9) % NUM_WORDS], SmallSigma1(w[(round + 14) % NUM_WORDS])));
+      }
+
+      __m256i const k  = _mm256_set1_epi32(static_cast<int>(ROUND_CONSTANTS[round]));
+      __m256i const t1 = Add(Add(Add(h, BigSigma1(e)), Add(Choose(e, f, g), k)), word);
+      __m256i const t2 = Add(BigSigma0(a), Majority(a, b, c));
+
+      h = g;
+      g = f;
+      f = e;
+      e = Add(d, t1);
+      d = c;
+      c = b;
+      b = a;
+      a = Add(t1, t2);
+    }
+
+    // only update the lanes which are still consuming blocks
+    __m256i const mask = _mm256_load_si256(reinterpret_cast<__m256i const *>(active));
+
+    __m256i const updated[8] = {a, b, c, d, e, f, g, h};
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      state[i] = _mm256_blendv_epi8(state[i], Add(state[i], updated[i]), mask);
+    }
+  }
+
+  // transpose the state back into the individual digests
+  alignas(32) uint32_t output[8][LANES];
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(output[i]), state[i]);
+  }
+
+  for (std::size_t lane = 0; lane < count; ++lane)
+  {
+    uint8_t *digest = digests + (lane * DIGEST_SIZE);
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      uint32_t const word = output[i][lane];
+
+      digest[(i * 4) + 0] = static_cast<uint8_t>(word >> 24u);
+      digest[(i * 4) + 1] = static_cast<uint8_t>(word >> 16u);
+      digest[(i * 4) + 2] = static_cast<uint8_t>(word >> 8u);
+      digest[(i * 4) + 3] = static_cast<uint8_t>(word);
+    }
+  }
+}
+
+#endif  // __AVX2__
+
+}  // namespace
+
+void HashSHA256MultiBuffer(uint8_t const *const *messages, std::size_t const *sizes,
+                           std::size_t count, uint8_t *digests)
+{
+  std::size_t index{0};
+
+#ifdef __AVX2__
+  BlockSource sources[LANES];
+
+  // a single remaining message is cheaper to hash with the scalar implementation
+  while ((count - index) > 1)
+  {
+    std::size_t const lanes = std::min(LANES, count - index);
+    for (std::size_t lane = 0; lane < lanes; ++lane)
+    {
+      sources[lane] = BlockSource{messages[index + lane], sizes[index + lane]};
+    }
+
+    HashLanes(sources, lanes, digests + (index * DIGEST_SIZE));
+    index += lanes;
+  }
+#endif  // __AVX2__
+
+  for (; index < count; ++index)
+  {
+    HashScalar(messages[index], sizes[index], digests + (index * DIGEST_SIZE));
+  }
+}
+
+std::vector<byte_array::ByteArray> HashSHA256MultiBuffer(
+    std::vector<byte_array::ConstByteArray> const &messages)
+{
+  std::vector<uint8_t const *> pointers{};
+  std::vector<std::size_t>     sizes{};
+  pointers.reserve(messages.size());
+  sizes.reserve(messages.size());
+
+  for (auto const &message : messages)
+  {
+    pointers.emplace_back(message.pointer());
+    sizes.emplace_back(message.size());
+  }
+
+  byte_array::ByteArray buffer;
+  buffer.Resize(messages.size() * DIGEST_SIZE);
+  HashSHA256MultiBuffer(pointers.data(), sizes.data(), messages.size(), buffer.pointer());
+
+  std::vector<byte_array::ByteArray> digests{};
+  digests.reserve(messages.size());
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    digests.emplace_back(buffer.SubArray(i * DIGEST_SIZE, DIGEST_SIZE).Copy());
+  }
+
+  return digests;
+}
+
+}  // namespace crypto
+}  // namespace fetch
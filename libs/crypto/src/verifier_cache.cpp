@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/verifier_cache.hpp"
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * Verify a specified signature, reusing a previously built verifier for the identity if possible
+ *
+ * @param identity The identity of the signer
+ * @param data The payload of the message
+ * @param signature The signature to verify
+ * @return true if the signature is valid for the payload, otherwise false
+ */
+bool VerifierCache::Verify(Identity const &identity, ConstByteArray const &data,
+                           ConstByteArray const &signature)
+{
+  auto it = verifiers_.find(identity);
+  if (it == verifiers_.end())
+  {
+    it = verifiers_.emplace(identity, Verifier::Build(identity)).first;
+  }
+
+  return it->second->Verify(data, signature);
+}
+
+/**
+ * Remove all the cached verifiers
+ */
+void VerifierCache::Clear()
+{
+  verifiers_.clear();
+}
+
+/**
+ * Get the number of cached verifiers
+ *
+ * @return The number of cached verifiers
+ */
+std::size_t VerifierCache::size() const
+{
+  return verifiers_.size();
+}
+
+}  // namespace crypto
+}  // namespace fetch
@@ -18,9 +18,17 @@
 
 #include "crypto/ecdsa.hpp"
 #include "crypto/verifier.hpp"
+#include "crypto/verifier_cache.hpp"
+
+#include <cstddef>
 
 namespace fetch {
 namespace crypto {
+namespace {
+
+constexpr std::size_t MAX_CACHED_VERIFIERS = 1024;
+
+}  // namespace
 
 /**
  * Build the corresponding Verifier based from the provided identity
@@ -39,7 +47,8 @@ std::unique_ptr<Verifier> Verifier::Build(Identity const &identity)
 }
 
 /**
- * Verify a specified signature from a data buffer and identity
+ * Verify a specified signature from a data buffer and identity. The verifiers of recently seen
+ * identities are kept per thread, so their public keys are only parsed once.
  *
  * @param identity The identity of the signer
  * @param data The payload of the message
@@ -49,11 +58,15 @@ std::unique_ptr<Verifier> Verifier::Build(Identity const &identity)
 bool Verifier::Verify(Identity const &identity, ConstByteArray const &data,
                       ConstByteArray const &signature)
 {
-  // build a compatible verifier
-  auto verifier = Build(identity);
+  // the same signers are seen repeatedly (miners, cabinet members), so reuse their parsed keys
+  thread_local VerifierCache verifiers{};
+  if (verifiers.size() >= MAX_CACHED_VERIFIERS)
+  {
+    verifiers.Clear();
+  }
 
   // determine if the signature is valid
-  return verifier->Verify(data, signature);
+  return verifiers.Verify(identity, data, signature);
 }
 
 /**
@@ -17,12 +17,17 @@
 //------------------------------------------------------------------------------
 
 #include "crypto/mcl_dkg.hpp"
+#include "vectorise/threading/pool.hpp"
 
 #include "gtest/gtest.h"
 
 #include <cstdint>
 #include <iostream>
 #include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace fetch::crypto::mcl;
 using namespace fetch::byte_array;
@@ -122,6 +127,14 @@ TEST(MclDkgTests, ComputeLhsRhs)
 
   EXPECT_EQ(coefficients, coefficients_test);
 
+  // Check compute LHS with fixed base tables of the generators
+  FixedBaseG2 const group_g_table{group_g};
+  FixedBaseG2 const group_h_table{group_h};
+  for (uint32_t jj = 0; jj <= threshold; ++jj)
+  {
+    EXPECT_EQ(ComputeLHS(group_g_table, group_h_table, vec_a[jj], vec_b[jj]), coefficients[jj]);
+  }
+
   PublicKey rhs;
   uint32_t  rank = 2;
   rhs            = ComputeRHS(rank, coefficients);
@@ -232,6 +245,97 @@ TEST(MclDkgTests, Signing)
   EXPECT_TRUE(VerifySign(outputs[0].group_public_key, message, group_signature, group_g));
 }
 
+TEST(MclDkgTests, BatchVerifySignatureShares)
+{
+  details::MCLInitialiser();
+
+  uint32_t cabinet_size = 20;
+  uint32_t threshold    = 11;
+
+  auto outputs = TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  Generator group_g;
+  SetGenerator(group_g);
+
+  std::string            message = "Hello";
+  std::vector<PublicKey> public_keys;
+  std::vector<Signature> signatures;
+
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    public_keys.push_back(outputs[0].public_key_shares[i]);
+    signatures.push_back(SignShare(message, outputs[i].private_key_share));
+  }
+
+  EXPECT_TRUE(VerifySignBatch(public_keys, message, signatures, group_g));
+  EXPECT_TRUE(FindInvalidSignatures(public_keys, message, signatures, group_g).empty());
+
+  // Corrupt a few of the shares, including two which would cancel out in an unweighted sum
+  Signature const offset = SignShare("Offset", outputs[0].private_key_share);
+  signatures[3] += offset;
+  signatures[4] -= offset;
+  signatures[17] = SignShare("Goodbye", outputs[17].private_key_share);
+
+  std::vector<std::size_t> const expected{3, 4, 17};
+
+  EXPECT_FALSE(VerifySignBatch(public_keys, message, signatures, group_g));
+  EXPECT_EQ(FindInvalidSignatures(public_keys, message, signatures, group_g), expected);
+
+  fetch::threading::Pool pool{4};
+  EXPECT_EQ(FindInvalidSignatures(public_keys, message, signatures, group_g, &pool), expected);
+}
+
+TEST(MclDkgTests, PrecomputedGeneratorsAndKeys)
+{
+  details::MCLInitialiser();
+
+  Generator generator;
+  SetGenerator(generator);
+
+  // Fixed base multiplication agrees with the generic one
+  FixedBaseG2 const generator_table{generator};
+  for (uint32_t i = 0; i < 10; ++i)
+  {
+    PrivateKey scalar;
+    scalar.setRand();
+
+    PublicKey expected;
+    bn::G2::mul(expected, generator, scalar);
+    EXPECT_EQ(generator_table.Mul(scalar), expected);
+  }
+  EXPECT_TRUE(generator_table.Mul(PrivateKey{0}).isZero());
+
+  // Verification with precomputed pairings agrees with the generic one
+  PrecomputedG2 const precomputed_generator{generator};
+  auto const          keys = GenerateKeyPair(generator_table);
+  PrecomputedG2 const precomputed_key{keys.second};
+
+  MessagePayload message   = "hello";
+  Signature      signature = SignShare(message, keys.first);
+  EXPECT_TRUE(VerifySign(keys.second, message, signature, generator));
+  EXPECT_TRUE(VerifySign(precomputed_key, message, signature, precomputed_generator));
+  EXPECT_FALSE(VerifySign(precomputed_key, "goodbye", signature, precomputed_generator));
+
+  // Repeated interpolation from the same signers reuses the cached coefficients
+  uint32_t cabinet_size = 10;
+  uint32_t threshold    = 6;
+  auto     outputs      = TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  for (uint32_t round = 0; round < 3; ++round)
+  {
+    std::unordered_map<uint32_t, Signature> threshold_signatures;
+    for (uint32_t i = round; i < round + threshold; ++i)
+    {
+      threshold_signatures.insert({i, SignShare(message, outputs[i].private_key_share)});
+    }
+
+    EXPECT_TRUE(VerifySign(outputs[0].group_public_key, message,
+                           LagrangeInterpolation(threshold_signatures), generator));
+    EXPECT_TRUE(VerifySign(outputs[0].group_public_key, message,
+                           LagrangeInterpolation(threshold_signatures), generator));
+  }
+}
+
 TEST(MclDkgTests, GenerateKeys)
 {
   details::MCLInitialiser();
@@ -294,3 +398,62 @@ TEST(MclNotarisationTests, AggregateSigningVerification)
       ComputeAggregatePublicKey(aggregate_signature.second, aggregate_public_keys);
   EXPECT_TRUE(VerifySign(aggregate_public_key, message, aggregate_signature.first, generator));
 }
+
+TEST(MclNotarisationTests, BatchVerifyAggregateSignatures)
+{
+  details::MCLInitialiser();
+
+  Generator generator;
+  SetGenerator(generator);
+
+  uint32_t                         cabinet_size = 4;
+  std::vector<PublicKey>           public_keys;
+  std::vector<AggregatePrivateKey> aggregate_private_keys;
+  aggregate_private_keys.resize(cabinet_size);
+
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    auto new_keys                         = GenerateKeyPair(generator);
+    aggregate_private_keys[i].private_key = new_keys.first;
+    public_keys.push_back(new_keys.second);
+  }
+
+  auto aggregate_public_keys = ComputeCabinetAggregatePublicKeys(public_keys);
+  ASSERT_EQ(aggregate_public_keys.size(), cabinet_size);
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    aggregate_private_keys[i].coefficient =
+        SignatureAggregationCoefficient(public_keys[i], public_keys);
+    PublicKey expected;
+    bn::G2::mul(expected, public_keys[i], aggregate_private_keys[i].coefficient);
+    EXPECT_EQ(aggregate_public_keys[i].aggregate_public_key, expected);
+  }
+
+  // Sign a different message with a different subset of the cabinet each time
+  std::vector<PublicKey>      keys;
+  std::vector<MessagePayload> messages;
+  std::vector<Signature>      signatures;
+  for (uint32_t skip = 0; skip < cabinet_size; ++skip)
+  {
+    MessagePayload                          message = "Block " + std::to_string(skip);
+    std::unordered_map<uint32_t, Signature> shares;
+    for (uint32_t i = 0; i < cabinet_size; ++i)
+    {
+      if (i != skip)
+      {
+        shares.insert({i, AggregateSign(message, aggregate_private_keys[i])});
+      }
+    }
+
+    auto aggregate_signature = ComputeAggregateSignature(shares, cabinet_size);
+    keys.push_back(ComputeAggregatePublicKey(aggregate_signature.second, aggregate_public_keys));
+    messages.push_back(message);
+    signatures.push_back(aggregate_signature.first);
+  }
+
+  EXPECT_TRUE(VerifySignBatch(keys, messages, signatures, generator));
+
+  // Swapping two signatures invalidates the batch
+  std::swap(signatures[0], signatures[1]);
+  EXPECT_FALSE(VerifySignBatch(keys, messages, signatures, generator));
+}
@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/byte_array/encoders.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "crypto/sha256_multi_buffer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using namespace fetch;
+using namespace fetch::crypto;
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+using Messages = std::vector<ConstByteArray>;
+
+class SHA256MultiBufferTests : public ::testing::Test
+{
+protected:
+  ConstByteArray GenerateMessage(std::size_t size)
+  {
+    ByteArray message;
+    message.Resize(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      message[i] = static_cast<uint8_t>(rng_() >> 11u);
+    }
+
+    return {message};
+  }
+
+  static void CheckDigests(Messages const &messages)
+  {
+    auto const digests = HashSHA256MultiBuffer(messages);
+    ASSERT_EQ(messages.size(), digests.size());
+
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+      EXPECT_EQ(ToHex(Hash<SHA256>(messages[i])), ToHex(digests[i]))
+          << "message " << i << " of size " << messages[i].size();
+    }
+  }
+
+  random::LinearCongruentialGenerator rng_;
+};
+
+TEST_F(SHA256MultiBufferTests, CheckKnownDigests)
+{
+  Messages const messages = {"", "abc", "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"};
+  auto const     digests  = HashSHA256MultiBuffer(messages);
+
+  ASSERT_EQ(3u, digests.size());
+  EXPECT_EQ(ToHex(digests[0]), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  EXPECT_EQ(ToHex(digests[1]), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  EXPECT_EQ(ToHex(digests[2]), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST_F(SHA256MultiBufferTests, CheckPaddingBoundaries)
+{
+  // cover all the sizes around the one and two block padding boundaries
+  Messages messages{};
+  for (std::size_t size = 0; size <= 130; ++size)
+  {
+    messages.emplace_back(GenerateMessage(size));
+  }
+
+  CheckDigests(messages);
+}
+
+TEST_F(SHA256MultiBufferTests, CheckMixedSizes)
+{
+  for (std::size_t count = 0; count <= 20; ++count)
+  {
+    Messages messages{};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      messages.emplace_back(GenerateMessage(rng_() % 1024));
+    }
+
+    CheckDigests(messages);
+  }
+}
+
+TEST_F(SHA256MultiBufferTests, CheckRawInterface)
+{
+  Messages messages{};
+  for (std::size_t i = 0; i < 11; ++i)
+  {
+    messages.emplace_back(GenerateMessage(64));
+  }
+
+  std::vector<uint8_t const *> pointers{};
+  std::vector<std::size_t>     sizes{};
+  for (auto const &message : messages)
+  {
+    pointers.emplace_back(message.pointer());
+    sizes.emplace_back(message.size());
+  }
+
+  std::vector<uint8_t> digests(messages.size() * SHA256::SIZE_IN_BYTES);
+  HashSHA256MultiBuffer(pointers.data(), sizes.data(), messages.size(), digests.data());
+
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    auto const expected = Hash<SHA256>(messages[i]);
+    EXPECT_EQ(0, std::memcmp(expected.pointer(), &digests[i * SHA256::SIZE_IN_BYTES],
+                             SHA256::SIZE_IN_BYTES));
+  }
+}
+
+}  // namespace
@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/ecdsa.hpp"
+#include "crypto/verifier_cache.hpp"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::Verifier;
+using fetch::crypto::VerifierCache;
+
+ConstByteArray const MESSAGE_1{"Hello World"};
+ConstByteArray const MESSAGE_2{"Goodbye World"};
+
+TEST(VerifierCacheTests, CheckVerifiersAreReusedForTheSameIdentity)
+{
+  ECDSASigner signer1;
+  ECDSASigner signer2;
+  signer1.GenerateKeys();
+  signer2.GenerateKeys();
+
+  VerifierCache cache{};
+
+  EXPECT_TRUE(cache.Verify(signer1.identity(), MESSAGE_1, signer1.Sign(MESSAGE_1)));
+  EXPECT_TRUE(cache.Verify(signer1.identity(), MESSAGE_2, signer1.Sign(MESSAGE_2)));
+  EXPECT_EQ(1u, cache.size());
+
+  EXPECT_TRUE(cache.Verify(signer2.identity(), MESSAGE_1, signer2.Sign(MESSAGE_1)));
+  EXPECT_EQ(2u, cache.size());
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST(VerifierCacheTests, CheckInvalidSignaturesAreRejected)
+{
+  ECDSASigner signer1;
+  ECDSASigner signer2;
+  signer1.GenerateKeys();
+  signer2.GenerateKeys();
+
+  VerifierCache cache{};
+
+  // populate the cache with a valid signature first
+  EXPECT_TRUE(cache.Verify(signer1.identity(), MESSAGE_1, signer1.Sign(MESSAGE_1)));
+
+  EXPECT_FALSE(cache.Verify(signer1.identity(), MESSAGE_2, signer1.Sign(MESSAGE_1)));
+  EXPECT_FALSE(cache.Verify(signer1.identity(), MESSAGE_1, signer2.Sign(MESSAGE_1)));
+  EXPECT_FALSE(cache.Verify(signer1.identity(), MESSAGE_1, ConstByteArray{}));
+}
+
+TEST(VerifierCacheTests, CheckStaticVerificationOfRepeatedIdentities)
+{
+  ECDSASigner signer1;
+  ECDSASigner signer2;
+  signer1.GenerateKeys();
+  signer2.GenerateKeys();
+
+  // the second round of verifications is served by the cached verifiers
+  for (std::size_t round = 0; round < 2; ++round)
+  {
+    EXPECT_TRUE(Verifier::Verify(signer1.identity(), MESSAGE_1, signer1.Sign(MESSAGE_1)));
+    EXPECT_TRUE(Verifier::Verify(signer2.identity(), MESSAGE_2, signer2.Sign(MESSAGE_2)));
+
+    EXPECT_FALSE(Verifier::Verify(signer1.identity(), MESSAGE_1, signer2.Sign(MESSAGE_1)));
+    EXPECT_FALSE(Verifier::Verify(signer2.identity(), MESSAGE_1, signer2.Sign(MESSAGE_2)));
+  }
+}
+
+}  // namespace
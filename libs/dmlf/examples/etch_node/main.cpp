@@ -28,6 +28,7 @@
 #include "dmlf/remote_execution_host.hpp"
 #include "dmlf/remote_execution_protocol.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <memory>
@@ -126,6 +127,9 @@ public:
         std::make_unique<Server>(muddle_->GetEndpoint(), fetch::SERVICE_DMLF, fetch::CHANNEL_RPC);
     server_->Add(fetch::RPC_DMLF, protocol_.get());
 
+    // independent workloads are executed in parallel, on every core
+    host_->StartWorkers(std::max(1u, std::thread::hardware_concurrency()));
+
     running_ = true;
   }
 
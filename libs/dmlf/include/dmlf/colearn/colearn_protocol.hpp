@@ -31,6 +31,7 @@ public:
   enum
   {
     RPC_COLEARN_UPDATE,
+    RPC_COLEARN_ENCODING,
   };
   explicit ColearnProtocol(MuddleLearnerNetworkerImpl &exec);
 
@@ -22,6 +22,7 @@
 #include "dmlf/colearn/abstract_message_controller.hpp"
 #include "dmlf/colearn/colearn_protocol.hpp"
 #include "dmlf/colearn/random_double.hpp"
+#include "dmlf/colearn/update_encoding.hpp"
 #include "dmlf/colearn/update_store.hpp"
 #include "dmlf/deprecated/abstract_learner_networker.hpp"
 #include "dmlf/deprecated/update_interface.hpp"
@@ -48,6 +49,8 @@ public:
   using Bytes                         = ColearnUpdate::Data;
   using ConstUpdatePtr                = AbstractMessageController::ConstUpdatePtr;
   using Criteria                      = UpdateStoreInterface::Criteria;
+  using Encoders                      = std::unordered_map<std::string, UpdateEncoderPtr>;
+  using Encodings                     = std::unordered_map<Address, UpdateEncoding>;
   using Lock                          = std::unique_lock<Mutex>;
   using MuddlePtr                     = muddle::MuddlePtr;
   using NetMan                        = fetch::network::NetworkManager;
@@ -139,6 +142,11 @@ public:
   uint64_t NetworkColearnUpdate(service::CallContext const &context, const std::string &type_name,
                                 byte_array::ConstByteArray bytes, double proportion = 1.0,
                                 double random_factor = 0.0);
+  UpdateEncoding NetworkColearnEncoding();
+
+  void           SetUpdateEncoding(UpdateEncoding const &encoding);
+  void           SetUpdateEncoder(UpdateType const &type_name, UpdateEncoderPtr encoder);
+  UpdateEncoding PeerEncoding(Address const &peer);
 
   Randomiser &access_randomiser()
   {
@@ -180,6 +188,10 @@ protected:
   void     Setup(std::string const &priv, unsigned short int port,
                  std::unordered_set<std::string> const &remotes);
 
+  void  SetPeerEncoding(Address const &peer, UpdateEncoding const &encoding);
+  Bytes EncodeUpdate(UpdateType const &type_name, Bytes const &update,
+                     UpdateEncoding const &encoding);
+
 private:
   std::shared_ptr<Taskpool>   taskpool_;
   std::shared_ptr<Threadpool> tasks_runners_;
@@ -198,6 +210,12 @@ private:
   Sources     detected_peers_;
   SourcesList supplied_peers_;
 
+  // update encodings, negotiated with every peer the first time an update is sent to it
+  UpdateEncoding update_encoding_{};
+  Encoders       update_encoders_;
+  Encodings      peer_encodings_;
+  Peers          encoding_requests_;
+
   const unsigned int INITIAL_PEERS_COUNT = 10;
 
   mutable Mutex mutex_;
@@ -0,0 +1,70 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "dmlf/colearn/update_encoding.hpp"
+#include "muddle/muddle_interface.hpp"
+#include "muddle/rpc/client.hpp"
+#include "oef-base/threading/Task.hpp"
+
+#include <functional>
+
+namespace fetch {
+namespace dmlf {
+namespace colearn {
+
+/**
+ * Asks a peer which update encoding it accepts. Peers which do not answer are given the updates
+ * unencoded.
+ */
+class MuddleOutboundEncodingTask : public oef::base::Task
+{
+public:
+  using RpcClient    = fetch::muddle::rpc::Client;
+  using RpcClientPtr = std::shared_ptr<RpcClient>;
+  using ExitState    = oef::base::ExitState;
+  using Address      = fetch::muddle::Address;
+  using Callback     = std::function<void(Address const &, UpdateEncoding const &)>;
+
+  Address                      target_;
+  RpcClientPtr                 client_;
+  Callback                     callback_;
+  static constexpr char const *LOGGING_NAME = "MuddleOutboundEncodingTask";
+
+  MuddleOutboundEncodingTask(Address target, RpcClientPtr client, Callback callback)
+    : target_(std::move(target))
+    , client_(std::move(client))
+    , callback_(std::move(callback))
+  {}
+  ~MuddleOutboundEncodingTask() override = default;
+
+  ExitState run() override;
+  bool      IsRunnable() const override;
+
+  MuddleOutboundEncodingTask(MuddleOutboundEncodingTask const &other) = delete;
+  MuddleOutboundEncodingTask &operator=(MuddleOutboundEncodingTask const &other)  = delete;
+  bool                        operator==(MuddleOutboundEncodingTask const &other) = delete;
+  bool                        operator<(MuddleOutboundEncodingTask const &other)  = delete;
+
+protected:
+private:
+};
+
+}  // namespace colearn
+}  // namespace dmlf
+}  // namespace fetch
@@ -0,0 +1,281 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+#include "core/serializers/base_types.hpp"
+#include "core/serializers/group_definitions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace dmlf {
+namespace colearn {
+
+/**
+ * How the tensors of an update are reduced before they are sent to a peer.
+ *
+ * Only the largest values by magnitude are sent (top-k sparsification), and the values sent are
+ * optionally quantised to 8 or 16 bits. Encoders keep the part of every update which was not sent
+ * and add it to the next one (error feedback), so that no gradient is lost over time.
+ */
+struct UpdateEncoding
+{
+  static constexpr uint8_t FULL_PRECISION = 0;
+
+  double  density{1.0};          ///< Fraction of the values sent, largest magnitudes first
+  uint8_t bits{FULL_PRECISION};  ///< Quantisation, 8 or 16 bits, or full precision
+
+  bool IsIdentity() const;
+
+  static UpdateEncoding Negotiate(UpdateEncoding const &a, UpdateEncoding const &b);
+};
+
+bool operator==(UpdateEncoding const &a, UpdateEncoding const &b);
+bool operator<(UpdateEncoding const &a, UpdateEncoding const &b);
+
+/**
+ * A single tensor of an encoded update. The values of sparse tensors are listed together with
+ * their flat indices, dense tensors have no indices.
+ */
+struct EncodedTensor
+{
+  using Shape   = std::vector<uint64_t>;
+  using Indices = std::vector<uint32_t>;
+  using Values  = std::vector<float>;
+
+  Shape                      shape{};
+  Indices                    indices{};
+  uint8_t                    bits{UpdateEncoding::FULL_PRECISION};
+  double                     offset{0.0};
+  double                     scale{0.0};
+  byte_array::ConstByteArray values{};
+
+  std::size_t ElementCount() const;
+};
+
+/**
+ * Encode a tensor, flattened into its values
+ *
+ * @param shape The shape of the tensor
+ * @param values The flat values, replaced by what the receiver does not get
+ * @param encoding The encoding to apply
+ * @return The encoded tensor
+ */
+EncodedTensor EncodeTensor(EncodedTensor::Shape shape, EncodedTensor::Values &values,
+                           UpdateEncoding const &encoding);
+
+/**
+ * @return The flat values of an encoded tensor, zero where no value was sent
+ */
+EncodedTensor::Values DecodeTensor(EncodedTensor const &tensor);
+
+/**
+ * Encodes the tensors of successive updates, keeping the residual of every encoding in use for
+ * error feedback. Encoding the same update for peers with different encodings is independent.
+ */
+template <typename TensorType>
+class UpdateEncoder
+{
+public:
+  using VectorTensor   = std::vector<TensorType>;
+  using EncodedTensors = std::vector<EncodedTensor>;
+
+  UpdateEncoder()                           = default;
+  UpdateEncoder(UpdateEncoder const &other) = delete;
+  UpdateEncoder &operator=(UpdateEncoder const &other) = delete;
+
+  EncodedTensors Encode(VectorTensor const &tensors, UpdateEncoding const &encoding);
+
+  static VectorTensor Decode(EncodedTensors const &encoded);
+
+  void Reset();
+
+private:
+  using DataType  = typename TensorType::Type;
+  using Residuals = std::vector<EncodedTensor::Values>;
+
+  Mutex                               mutex_;
+  std::map<UpdateEncoding, Residuals> residuals_;
+};
+
+template <typename TensorType>
+typename UpdateEncoder<TensorType>::EncodedTensors UpdateEncoder<TensorType>::Encode(
+    VectorTensor const &tensors, UpdateEncoding const &encoding)
+{
+  FETCH_LOCK(mutex_);
+
+  auto &residuals = residuals_[encoding];
+  if (residuals.size() != tensors.size())
+  {
+    residuals.assign(tensors.size(), {});
+  }
+
+  EncodedTensors encoded;
+  encoded.reserve(tensors.size());
+
+  for (std::size_t i = 0; i < tensors.size(); ++i)
+  {
+    auto const &tensor   = tensors[i];
+    auto &      residual = residuals[i];
+
+    if (residual.size() != tensor.size())
+    {
+      residual.assign(tensor.size(), 0.0f);
+    }
+
+    // the residual becomes the accumulated update, and then what remains unsent of it
+    std::size_t j = 0;
+    for (auto it = tensor.cbegin(); it != tensor.cend(); ++it, ++j)
+    {
+      residual[j] += static_cast<float>(*it);
+    }
+
+    EncodedTensor::Shape shape(tensor.shape().begin(), tensor.shape().end());
+    encoded.emplace_back(EncodeTensor(std::move(shape), residual, encoding));
+  }
+
+  return encoded;
+}
+
+template <typename TensorType>
+typename UpdateEncoder<TensorType>::VectorTensor UpdateEncoder<TensorType>::Decode(
+    EncodedTensors const &encoded)
+{
+  VectorTensor tensors;
+  tensors.reserve(encoded.size());
+
+  for (auto const &entry : encoded)
+  {
+    auto const values = DecodeTensor(entry);
+
+    TensorType tensor(typename TensorType::SizeVector(entry.shape.begin(), entry.shape.end()));
+
+    std::size_t j = 0;
+    for (auto it = tensor.begin(); it != tensor.end(); ++it, ++j)
+    {
+      *it = static_cast<DataType>(values[j]);
+    }
+
+    tensors.emplace_back(std::move(tensor));
+  }
+
+  return tensors;
+}
+
+template <typename TensorType>
+void UpdateEncoder<TensorType>::Reset()
+{
+  FETCH_LOCK(mutex_);
+  residuals_.clear();
+}
+
+/**
+ * Re-encodes serialised updates of one type, for networkers which only see the bytes
+ */
+class UpdateEncoderInterface
+{
+public:
+  using Bytes = byte_array::ConstByteArray;
+
+  UpdateEncoderInterface()          = default;
+  virtual ~UpdateEncoderInterface() = default;
+
+  virtual Bytes Encode(Bytes const &update, UpdateEncoding const &encoding) = 0;
+};
+
+using UpdateEncoderPtr = std::shared_ptr<UpdateEncoderInterface>;
+
+}  // namespace colearn
+}  // namespace dmlf
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<dmlf::colearn::UpdateEncoding, D>
+{
+public:
+  using Type       = dmlf::colearn::UpdateEncoding;
+  using DriverType = D;
+
+  static uint8_t const DENSITY = 1;
+  static uint8_t const BITS    = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &encoding)
+  {
+    auto map = map_constructor(2);
+    map.Append(DENSITY, encoding.density);
+    map.Append(BITS, encoding.bits);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &encoding)
+  {
+    map.ExpectKeyGetValue(DENSITY, encoding.density);
+    map.ExpectKeyGetValue(BITS, encoding.bits);
+  }
+};
+
+template <typename D>
+struct MapSerializer<dmlf::colearn::EncodedTensor, D>
+{
+public:
+  using Type       = dmlf::colearn::EncodedTensor;
+  using DriverType = D;
+
+  static uint8_t const SHAPE   = 1;
+  static uint8_t const INDICES = 2;
+  static uint8_t const BITS    = 3;
+  static uint8_t const OFFSET  = 4;
+  static uint8_t const SCALE   = 5;
+  static uint8_t const VALUES  = 6;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &tensor)
+  {
+    auto map = map_constructor(6);
+    map.Append(SHAPE, tensor.shape);
+    map.Append(INDICES, tensor.indices);
+    map.Append(BITS, tensor.bits);
+    map.Append(OFFSET, tensor.offset);
+    map.Append(SCALE, tensor.scale);
+    map.Append(VALUES, tensor.values);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &tensor)
+  {
+    map.ExpectKeyGetValue(SHAPE, tensor.shape);
+    map.ExpectKeyGetValue(INDICES, tensor.indices);
+    map.ExpectKeyGetValue(BITS, tensor.bits);
+    map.ExpectKeyGetValue(OFFSET, tensor.offset);
+    map.ExpectKeyGetValue(SCALE, tensor.scale);
+    map.ExpectKeyGetValue(VALUES, tensor.values);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
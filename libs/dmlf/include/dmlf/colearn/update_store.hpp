@@ -19,7 +19,12 @@
 
 #include "dmlf/colearn/update_store_interface.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
 #include <queue>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -30,10 +35,26 @@ namespace fetch {
 namespace dmlf {
 namespace colearn {
 
+/**
+ * Stores the updates received from peers until learners consume them.
+ *
+ * Updates of every (algorithm, type) queue are kept in arrival order. Without criteria learners get
+ * the newest update they have not consumed yet from a per consumer heap, in logarithmic time.
+ * Custom criteria may depend on state outside the store and are evaluated over the whole queue.
+ *
+ * The store can be bounded by the total size of the data held and by the age of the updates, in
+ * which case the oldest updates are evicted first. Evicted updates are still recognised as
+ * duplicates if they are received again.
+ */
 class UpdateStore : public UpdateStoreInterface
 {
 public:
-  UpdateStore()                         = default;
+  using Resolution = Update::Resolution;
+
+  static constexpr std::size_t UNLIMITED_BYTES = 0;
+
+  UpdateStore() = default;
+  explicit UpdateStore(std::size_t max_bytes, Resolution max_age = Resolution::zero());
   ~UpdateStore() override               = default;
   UpdateStore(UpdateStore const &other) = delete;
   UpdateStore &operator=(UpdateStore const &other) = delete;
@@ -54,25 +75,77 @@ public:
   std::size_t GetUpdateCount() const override;
   std::size_t GetUpdateCount(Algorithm const &algo, UpdateType const &type) const override;
 
+  std::size_t GetStoredBytes() const;
+
 private:
-  using QueueId = std::string;
-  QueueId Id(Algorithm const &algo, UpdateType const &type) const;
+  using QueueId     = std::string;
+  using Sequence    = uint64_t;
+  using ConsumerId  = std::size_t;
+  using Fingerprint = Update::Fingerprint;
+
+  /**
+   * The consumers of an update, as a bitset over the consumer ids of the store
+   */
+  class ConsumerSet
+  {
+  public:
+    bool Contains(ConsumerId consumer) const;
+    void Insert(ConsumerId consumer);
 
-  Criteria Lifo = [](UpdatePtr const &update) -> double {
-    return static_cast<double>(-update->TimeSinceCreation().count());
+  private:
+    std::vector<uint64_t> words_{};
   };
 
-  using Mutex           = fetch::Mutex;
-  using Lock            = std::unique_lock<Mutex>;
-  using Store           = std::vector<UpdatePtr>;
-  using AlgoMap         = std::unordered_map<QueueId, Store>;
-  using Fingerprint     = Update::Fingerprint;
-  using UpdateConsumers = std::unordered_set<Consumer>;
+  struct Entry
+  {
+    UpdatePtr   update{};
+    ConsumerSet consumed{};
+  };
+
+  using Entries = std::map<Sequence, Entry>;
+  using Heap    = std::priority_queue<Sequence>;  ///< Newest first, may hold consumed entries
+
+  struct Queue
+  {
+    Entries                              entries{};
+    std::unordered_map<ConsumerId, Heap> unconsumed{};
+  };
+
+  struct Position
+  {
+    QueueId  queue;
+    Sequence sequence;
+  };
+
+  using Mutex   = fetch::Mutex;
+  using Lock    = std::unique_lock<Mutex>;
+  using AlgoMap = std::unordered_map<QueueId, Queue>;
+
+  QueueId    Id(Algorithm const &algo, UpdateType const &type) const;
+  ConsumerId IdOf(Consumer const &consumer);
+  Queue &    PendingQueue(Algorithm const &algo, UpdateType const &type);
+  Heap &     UnconsumedBy(Queue &queue, ConsumerId consumer);
+
+  static Heap Unconsumed(Queue const &queue, ConsumerId consumer);
+
+  UpdatePtr GetNewest(Queue &queue, Consumer const &consumer);
+  UpdatePtr GetBest(Queue &queue, Criteria const &criteria, Consumer const &consumer);
+
+  void EvictFront();
+  void EvictStale();
+  void EvictOverCapacity();
 
-  AlgoMap       algo_map_;
-  mutable Mutex global_m_;
+  std::size_t max_bytes_{UNLIMITED_BYTES};
+  Resolution  max_age_{Resolution::zero()};
 
-  std::unordered_map<Fingerprint, UpdateConsumers> consumed_;
+  AlgoMap                                  algo_map_;
+  std::deque<Position>                     arrival_order_;
+  std::unordered_set<Fingerprint>          received_;
+  std::unordered_map<Consumer, ConsumerId> consumer_ids_;
+  Sequence                                 next_sequence_{0};
+  std::size_t                              stored_count_{0};
+  std::size_t                              stored_bytes_{0};
+  mutable Mutex                            global_m_;
 };
 
 }  // namespace colearn
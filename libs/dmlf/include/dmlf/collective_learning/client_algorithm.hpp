@@ -19,6 +19,7 @@
 
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/mutex.hpp"
+#include "dmlf/colearn/update_encoding.hpp"
 #include "dmlf/collective_learning/client_algorithm_controller.hpp"
 #include "dmlf/collective_learning/client_params.hpp"
 #include "dmlf/deprecated/update.hpp"
@@ -94,7 +95,7 @@ public:
   virtual ~ClientAlgorithm() = default;
 
   virtual void Run();
-  void         Train();
+  virtual void Train();
   virtual void Test();
 
   ///////////////////////////
@@ -156,6 +157,10 @@ private:
 
   AlgorithmControllerPtrType algorithm_controller_;
 
+  colearn::UpdateEncoder<TensorType> update_encoder_;
+
+  std::shared_ptr<UpdateType> EncodeUpdate(std::shared_ptr<UpdateType> update);
+
   void AggregateUpdate(VectorTensorType const &gradients);
   void AggregateSparseUpdate(VectorTensorType const &gradients,
                              VectorSizeVector const &updated_rows);
@@ -407,6 +412,22 @@ std::vector<std::vector<fetch::math::SizeType>> ClientAlgorithm<TensorType>::Tra
   return new_gradients->GetUpdatedRows();
 }
 
+/**
+ * Apply the update encoding of the client, the update is decoded transparently by the receivers
+ * @param update The update of this client
+ * @return The update to send
+ */
+template <class TensorType>
+std::shared_ptr<typename ClientAlgorithm<TensorType>::UpdateType>
+ClientAlgorithm<TensorType>::EncodeUpdate(std::shared_ptr<UpdateType> update)
+{
+  if (!params_.update_encoding.IsIdentity())
+  {
+    update->Encode(update_encoder_, params_.update_encoding);
+  }
+  return update;
+}
+
 /**
  * Perform one round of training. This includes
  * 1. local training
@@ -421,7 +442,7 @@ void ClientAlgorithm<TensorType>::TrainAndApplyUpdates()
   Train();
 
   // Give latest gradient update to algorithm controller
-  algorithm_controller_->PushUpdate(GetUpdate());
+  algorithm_controller_->PushUpdate(EncodeUpdate(GetUpdate()));
 
   // Sum all gradients provided by algorithm controller
   while (algorithm_controller_->UpdateCount() > 0)
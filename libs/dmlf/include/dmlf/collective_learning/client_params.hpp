@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "dmlf/colearn/update_encoding.hpp"
 #include "math/base_types.hpp"
 
 namespace fetch {
@@ -36,6 +37,9 @@ struct ClientParams
   bool     print_loss = false;
 
   std::string results_dir = ".";
+
+  // applied to the updates sent to the other clients
+  colearn::UpdateEncoding update_encoding{};
 };
 
 }  // namespace collective_learning
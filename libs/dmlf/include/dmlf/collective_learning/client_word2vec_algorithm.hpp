@@ -22,9 +22,13 @@
 #include "dmlf/collective_learning/translator.hpp"
 #include "dmlf/collective_learning/word2vec_training_params.hpp"
 #include "math/clustering/knn.hpp"
+#include "ml/model/word2vec_trainer.hpp"
 #include "ml/optimisation/lazy_adam_optimiser.hpp"
 #include "ml/utilities/word2vec_utilities.hpp"
 
+#include <algorithm>
+#include <memory>
+
 namespace fetch {
 namespace dmlf {
 namespace collective_learning {
@@ -40,6 +44,7 @@ class ClientWord2VecAlgorithm : public ClientAlgorithm<TensorType>
   using GradientType               = fetch::dmlf::deprecated_Update<TensorType>;
   using AlgorithmControllerType    = ClientAlgorithmController<TensorType>;
   using AlgorithmControllerPtrType = std::shared_ptr<ClientAlgorithmController<TensorType>>;
+  using TrainerType                = fetch::ml::model::Word2VecTrainer<TensorType>;
 
 public:
   ClientWord2VecAlgorithm(AlgorithmControllerPtrType algorithm_controller, std::string const &id,
@@ -48,6 +53,8 @@ public:
 
   void Run() override;
 
+  void Train() override;
+
   void Test() override;
 
   float GetAnalogyScore();
@@ -67,7 +74,18 @@ private:
   float                                                               analogy_score_ = 0.0f;
   Translator                                                          translator_;
 
+  // the multithreaded trainer, which trains the weights of the graph in place
+  std::unique_ptr<TrainerType>  trainer_;
+  SizeType                      embeddings_index_ = 0;  // the trainable of the input embeddings
+  std::vector<TensorType>       sent_weights_;          // the weights as of the last update
+  VectorSizeVector              peer_rows_;             // the rows updated by peers since
+  std::shared_ptr<GradientType> trainer_update_;
+
   void PrepareOptimiser();
+  void PrepareTrainer();
+
+  DataType                      TrainerLearningRate(SizeType words_trained) const;
+  std::shared_ptr<GradientType> MakeTrainerUpdate(DataType learning_rate);
 
   VectorSizeVector TranslateUpdate(std::shared_ptr<GradientType> &new_gradients) override;
 
@@ -99,6 +117,11 @@ ClientWord2VecAlgorithm<TensorType>::ClientWord2VecAlgorithm(
 
   PrepareOptimiser();
 
+  if (tp_.hogwild_threads > 0)
+  {
+    PrepareTrainer();
+  }
+
   translator_.SetMyVocab(w2v_data_loader_ptr_->GetVocab());
 }
 
@@ -112,6 +135,64 @@ void ClientWord2VecAlgorithm<TensorType>::Run()
   analogy_score_ = ComputeAnalogyScore();
 }
 
+/**
+ * Train one batch. With the multithreaded trainer, the batch is a number of words of the corpus
+ * which are trained on directly, and the update for the peers is the resulting change of the
+ * weights.
+ */
+template <class TensorType>
+void ClientWord2VecAlgorithm<TensorType>::Train()
+{
+  if (!trainer_)
+  {
+    ClientAlgorithm<TensorType>::Train();
+    return;
+  }
+
+  SizeType const epochs = trainer_->epochs();
+  {
+    FETCH_LOCK(this->model_mutex_);
+
+    auto weights = this->graph_ptr_->GetWeightsReferences();
+
+    // the changes made by peers are not part of the next update
+    for (SizeType i = 0; i < weights.size(); ++i)
+    {
+      for (SizeType row : peer_rows_.at(i))
+      {
+        if (row < weights.at(i).shape().at(1))
+        {
+          sent_weights_.at(i).View(row).Assign(weights.at(i).View(row));
+        }
+      }
+      peer_rows_.at(i).clear();
+    }
+
+    trainer_->SetWeights(weights.at(embeddings_index_), weights.at(1 - embeddings_index_));
+
+    SizeType const words_trained          = trainer_->words_trained();
+    DataType const starting_learning_rate = TrainerLearningRate(words_trained);
+    DataType const ending_learning_rate   = TrainerLearningRate(words_trained + tp_.batch_size);
+
+    this->train_loss_ =
+        trainer_->Train(tp_.batch_size, starting_learning_rate, ending_learning_rate);
+    this->train_loss_sum_ += this->train_loss_;
+    this->train_loss_cnt_++;
+
+    trainer_update_ =
+        MakeTrainerUpdate((starting_learning_rate + ending_learning_rate) / DataType{2});
+  }
+
+  if (trainer_->epochs() != epochs)
+  {
+    this->epochs_done_this_round_++;
+    this->epoch_counter_++;
+  }
+  this->batch_counter_++;
+  this->updates_applied_this_round_++;
+  this->update_counter_++;
+}
+
 /**
  * Run model on test set to get test loss
  * @param test_loss
@@ -150,21 +231,30 @@ ClientWord2VecAlgorithm<TensorType>::GetUpdate()
 {
   FETCH_LOCK(this->model_mutex_);
 
-  std::vector<std::unordered_set<SizeType>> vector_set =
-      this->graph_ptr_->GetUpdatedRowsReferences();
-  std::vector<TensorType> vector_tensor = this->graph_ptr_->GetGradients();
+  if (trainer_)
+  {
+    return trainer_update_;
+  }
+
+  // only the updated rows of each gradient are copied, never the full embedding tables
+  auto sparse_gradients = this->graph_ptr_->GetSparseGradients();
 
   // Return update values
   std::vector<std::vector<SizeType>> out_vector;
   std::vector<TensorType>            out_tensors;
 
-  for (SizeType i{0}; i < vector_set.size(); i++)
+  for (auto &gradient : sparse_gradients)
   {
-    // Convert unordered_set to vector
-    out_vector.emplace_back(
-        std::vector<SizeType>(vector_set.at(i).begin(), vector_set.at(i).end()));
-    // Sparsify gradient tensors to contain only updated rows
-    out_tensors.emplace_back(fetch::ml::utilities::ToSparse(vector_tensor.at(i), vector_set.at(i)));
+    if (gradient.IsSparse())
+    {
+      out_tensors.emplace_back(std::move(gradient.values));
+    }
+    else
+    {
+      // no rows have been updated
+      out_tensors.emplace_back(TensorType({gradient.values.shape().at(0), 0}));
+    }
+    out_vector.emplace_back(std::move(gradient.rows));
   }
 
   return std::make_shared<GradientType>(out_tensors, w2v_data_loader_ptr_->GetVocabHash(),
@@ -235,6 +325,104 @@ void ClientWord2VecAlgorithm<TensorType>::PrepareOptimiser()
       tp_.learning_rate_param);
 }
 
+/**
+ * Set up the multithreaded trainer on the weights of the graph
+ */
+template <class TensorType>
+void ClientWord2VecAlgorithm<TensorType>::PrepareTrainer()
+{
+  auto weights = this->graph_ptr_->GetWeightsReferences();
+  assert(weights.size() == 2);
+
+  // the trainables are the input and the context embeddings of the SkipGram layer
+  TensorType const &embeddings = fetch::ml::utilities::GetEmbeddings(*this->graph_ptr_, skipgram_);
+  embeddings_index_ =
+      (weights.at(0).data().pointer() == embeddings.data().pointer()) ? SizeType{0} : SizeType{1};
+
+  trainer_ = std::make_unique<TrainerType>(*w2v_data_loader_ptr_, weights.at(embeddings_index_),
+                                           weights.at(1 - embeddings_index_), tp_.hogwild_threads);
+
+  for (auto const &tensor : weights)
+  {
+    sent_weights_.emplace_back(tensor.Copy());
+  }
+  peer_rows_.resize(weights.size());
+
+  // there is no update before the first batch
+  std::vector<TensorType> gradients;
+  for (auto const &tensor : weights)
+  {
+    gradients.emplace_back(TensorType({tensor.shape().at(0), 0}));
+  }
+  trainer_update_ = std::make_shared<GradientType>(
+      gradients, w2v_data_loader_ptr_->GetVocabHash(),
+      w2v_data_loader_ptr_->GetVocab()->GetReverseVocab(), VectorSizeVector(weights.size()));
+}
+
+/**
+ * The learning rate of the trainer decays linearly over the first epoch
+ * @param words_trained the number of words trained on so far
+ */
+template <class TensorType>
+typename ClientWord2VecAlgorithm<TensorType>::DataType
+ClientWord2VecAlgorithm<TensorType>::TrainerLearningRate(SizeType words_trained) const
+{
+  auto const corpus_size = std::max<SizeType>(trainer_->corpus_size(), 1);
+  auto const progress    = static_cast<DataType>(std::min(words_trained, corpus_size)) /
+                        static_cast<DataType>(corpus_size);
+
+  return tp_.hogwild_starting_learning_rate +
+         (tp_.hogwild_ending_learning_rate - tp_.hogwild_starting_learning_rate) * progress;
+}
+
+/**
+ * The update of the rows trained by the trainer, as the gradients which an SGD step of the
+ * learning rate would apply
+ * @param learning_rate the mean learning rate of the batch
+ */
+template <class TensorType>
+std::shared_ptr<fetch::dmlf::deprecated_Update<TensorType>>
+ClientWord2VecAlgorithm<TensorType>::MakeTrainerUpdate(DataType learning_rate)
+{
+  auto weights = this->graph_ptr_->GetWeightsReferences();
+
+  VectorSizeVector rows(weights.size());
+  rows.at(embeddings_index_)     = trainer_->updated_embeddings_rows();
+  rows.at(1 - embeddings_index_) = trainer_->updated_context_rows();
+
+  std::vector<TensorType> gradients;
+
+  for (SizeType i = 0; i < weights.size(); ++i)
+  {
+    TensorType gradient({weights.at(i).shape().at(0), rows.at(i).size()});
+
+    for (SizeType j = 0; j < rows.at(i).size(); ++j)
+    {
+      auto current = weights.at(i).View(rows.at(i).at(j));
+      auto sent    = sent_weights_.at(i).View(rows.at(i).at(j));
+      auto column  = gradient.View(j);
+
+      auto current_it = current.cbegin();
+      auto sent_it    = sent.begin();
+      auto column_it  = column.begin();
+      while (current_it.is_valid())
+      {
+        *column_it = (*sent_it - *current_it) / learning_rate;
+        *sent_it   = *current_it;
+        ++current_it;
+        ++sent_it;
+        ++column_it;
+      }
+    }
+
+    gradients.emplace_back(std::move(gradient));
+  }
+
+  return std::make_shared<GradientType>(gradients, w2v_data_loader_ptr_->GetVocabHash(),
+                                        w2v_data_loader_ptr_->GetVocab()->GetReverseVocab(),
+                                        rows);
+}
+
 template <class TensorType>
 typename ClientWord2VecAlgorithm<TensorType>::VectorSizeVector
 ClientWord2VecAlgorithm<TensorType>::TranslateUpdate(
@@ -256,6 +444,15 @@ ClientWord2VecAlgorithm<TensorType>::TranslateUpdate(
   translated_rows_updates.emplace_back(translator_.TranslateUpdate<TensorType>(
       new_gradients->GetUpdatedRows().at(1), new_gradients->GetHash()));
 
+  if (trainer_)
+  {
+    for (SizeType i = 0; i < translated_rows_updates.size(); ++i)
+    {
+      auto const &translated = translated_rows_updates.at(i);
+      peer_rows_.at(i).insert(peer_rows_.at(i).end(), translated.begin(), translated.end());
+    }
+  }
+
   return translated_rows_updates;
 }
 
@@ -0,0 +1,65 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/main_serializer.hpp"
+#include "dmlf/colearn/update_encoding.hpp"
+#include "dmlf/deprecated/update.hpp"
+
+namespace fetch {
+namespace dmlf {
+namespace collective_learning {
+namespace utilities {
+
+/**
+ * Encodes the gradients of updates serialised by the TypedUpdateAdaptor, allowing networkers to
+ * encode them differently for every peer
+ */
+template <typename TensorType>
+class TypedUpdateEncoder : public colearn::UpdateEncoderInterface
+{
+public:
+  using UpdateType = deprecated_Update<TensorType>;
+
+  TypedUpdateEncoder()           = default;
+  ~TypedUpdateEncoder() override = default;
+
+  Bytes Encode(Bytes const &update, colearn::UpdateEncoding const &encoding) override
+  {
+    UpdateType                            decoded;
+    fetch::serializers::MsgPackSerializer deserializer{update};
+    deserializer >> decoded;
+
+    decoded.Encode(encoder_, encoding);
+
+    fetch::serializers::MsgPackSerializer serializer;
+    serializer << decoded;
+    return serializer.data();
+  }
+
+  TypedUpdateEncoder(TypedUpdateEncoder const &other) = delete;
+  TypedUpdateEncoder &operator=(TypedUpdateEncoder const &other) = delete;
+
+private:
+  colearn::UpdateEncoder<TensorType> encoder_;
+};
+
+}  // namespace utilities
+}  // namespace collective_learning
+}  // namespace dmlf
+}  // namespace fetch
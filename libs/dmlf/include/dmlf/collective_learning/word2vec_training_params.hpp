@@ -67,6 +67,12 @@ struct Word2VecTrainingParams : public ClientParams<DataType>
   std::vector<std::string> data;
   std::string              analogies_test_file;
 
+  // the number of threads of the word2vec trainer, which trains the embeddings directly instead
+  // of training the graph one batch at a time. 0 trains the graph
+  SizeType hogwild_threads                = 0;
+  DataType hogwild_starting_learning_rate = fetch::math::Type<DataType>("0.025");
+  DataType hogwild_ending_learning_rate   = fetch::math::Type<DataType>("0.0001");
+
   fetch::ml::optimisers::LearningRateParam<DataType> learning_rate_param{
       fetch::ml::optimisers::LearningRateParam<DataType>::LearningRateDecay::LINEAR};
 
@@ -21,6 +21,7 @@
 #include "core/serializers/main_serializer.hpp"
 #include "crypto/hash.hpp"
 #include "crypto/sha256.hpp"
+#include "dmlf/colearn/update_encoding.hpp"
 #include "dmlf/deprecated/update_interface.hpp"
 #include "ml/dataloaders/word2vec_loaders/vocab.hpp"
 
@@ -46,6 +47,8 @@ public:
   using ReverseVocabType = std::vector<std::string>;
   using SizeType         = fetch::math::SizeType;
   using VectorSizeVector = std::vector<std::vector<SizeType>>;
+  using Encoder          = colearn::UpdateEncoder<TensorType>;
+  using EncodedTensors   = typename Encoder::EncodedTensors;
 
   using Payload = VectorTensor;
 
@@ -127,6 +130,23 @@ public:
     return updated_rows_;
   }
 
+  /**
+   * Send the gradients in an encoded form. The gradients of this update are unchanged, receivers
+   * get them decoded.
+   *
+   * @param encoder The encoder, keeping the residuals of the previous updates
+   * @param encoding The encoding to apply
+   */
+  void Encode(Encoder &encoder, colearn::UpdateEncoding const &encoding)
+  {
+    encoded_ = encoder.Encode(gradients_, encoding);
+  }
+
+  bool IsEncoded() const
+  {
+    return !encoded_.empty();
+  }
+
   deprecated_Update(deprecated_Update const &other) = delete;
   deprecated_Update &operator=(deprecated_Update const &other)  = delete;
   bool               operator==(deprecated_Update const &other) = delete;
@@ -155,6 +175,7 @@ private:
   HashType         hash_;
   ReverseVocabType vocab_;
   VectorSizeVector updated_rows_;
+  EncodedTensors   encoded_;
 };
 
 }  // namespace dmlf
@@ -174,17 +195,30 @@ public:
   static uint8_t const HASH         = 4;
   static uint8_t const VOCAB        = 5;
   static uint8_t const UPDATED_ROWS = 6;
+  static uint8_t const ENCODED      = 7;
 
   template <typename Constructor>
   static void Serialize(Constructor &map_constructor, Type const &update)
   {
-    auto map = map_constructor(6);
+    // encoded gradients replace the full ones, updates without them keep the original layout
+    auto map = map_constructor(update.IsEncoded() ? 7 : 6);
     map.Append(TIME_STAMP, update.stamp_);
-    map.Append(GRADIENTS, update.gradients_);
+    if (update.IsEncoded())
+    {
+      map.Append(GRADIENTS, typename Type::VectorTensor{});
+    }
+    else
+    {
+      map.Append(GRADIENTS, update.gradients_);
+    }
     map.Append(FINGERPRINT, update.fingerprint_);
     map.Append(HASH, update.hash_);
     map.Append(VOCAB, update.vocab_);
     map.Append(UPDATED_ROWS, update.updated_rows_);
+    if (update.IsEncoded())
+    {
+      map.Append(ENCODED, update.encoded_);
+    }
   }
 
   template <typename MapDeserializer>
@@ -196,6 +230,11 @@ public:
     map.ExpectKeyGetValue(HASH, update.hash_);
     map.ExpectKeyGetValue(VOCAB, update.vocab_);
     map.ExpectKeyGetValue(UPDATED_ROWS, update.updated_rows_);
+    if (map.size() == 7)
+    {
+      map.ExpectKeyGetValue(ENCODED, update.encoded_);
+      update.gradients_ = Type::Encoder::Decode(update.encoded_);
+    }
   }
 };
 
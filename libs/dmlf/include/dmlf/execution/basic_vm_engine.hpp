@@ -24,19 +24,27 @@
 
 #include "dmlf/execution/execution_engine_interface.hpp"
 
+#include "core/mutex.hpp"
 #include "core/serializers/main_serializer.hpp"
 #include "dmlf/execution/vm_state.hpp"
 #include "variant/variant.hpp"
 #include "vm/vm.hpp"
 #include "vm_modules/vm_factory.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <sstream>
 #include <unordered_map>
 #include <vector>
 
 namespace fetch {
 namespace dmlf {
 
+/**
+ * Compiles and runs Etch programs against named states. The engine can be used from several threads
+ * at once: runs on different states execute in parallel, runs on the same state one at a time.
+ * VMs are pooled and reused between runs, and copying a state only takes a snapshot of it.
+ */
 class BasicVmEngine : public ExecutionEngineInterface
 {
 public:
@@ -67,7 +75,25 @@ public:
                       Params params) override;
 
 private:
-  using Serializer = serializers::MsgPackSerializer;
+  using Serializer    = serializers::MsgPackSerializer;
+  using ExecutablePtr = std::shared_ptr<Executable>;
+  using VmPtr         = std::unique_ptr<VM>;
+
+  /**
+   * A state, with the lock held by the run using it
+   */
+  struct StateSlot
+  {
+    StateSlot() = default;
+    explicit StateSlot(State &&other)
+      : state{std::move(other)}
+    {}
+
+    Mutex mutex;
+    State state;
+  };
+
+  using StateSlotPtr = std::shared_ptr<StateSlot>;
 
   class ExecutionContext
   {
@@ -82,6 +108,14 @@ private:
   bool HasExecutable(std::string const &name) const;
   bool HasState(std::string const &name) const;
 
+  VmPtr AcquireVm(uint64_t &generation);
+  void  ReleaseVm(VmPtr vm, uint64_t generation);
+
+  ExecutionResult Execute(VM &vm, Executable *exec, Executable::Function const *func,
+                          Name const &execName, Name const &stateName,
+                          std::string const &entrypoint, Params const &params,
+                          std::ostringstream &console);
+
   Error PrepInput(vm::ParameterPack &result, Params const &params, VM &vm, Executable *exec,
                   Executable::Function const *func, std::string const &runName);
   ExecutionResult PrepOutput(VM &vm, Executable *exec, VmVariant const &vmVariant,
@@ -91,10 +125,17 @@ private:
   ExecutionResult EngineSuccess(std::string successMessage) const;
   std::string     RunName(std::string execName, std::string stateName) const;
 
-  std::unordered_map<std::string, std::shared_ptr<Executable>> executables_;
-  std::unordered_map<std::string, std::shared_ptr<State>>      states_;
+  mutable Mutex                                  mutex_;  ///< Guards the executables and states
+  std::unordered_map<std::string, ExecutablePtr> executables_;
+  std::unordered_map<std::string, StateSlotPtr>  states_;
 
   std::shared_ptr<fetch::vm::Module> module_ = VmFactory::GetModule(VmFactory::USE_SMART_CONTRACTS);
+
+  // compiling sets up the module, VMs created before that can not run what was compiled, so they
+  // are only created between compilations and dropped when the module changes
+  Mutex              module_mutex_;
+  std::vector<VmPtr> idle_vms_;
+  uint64_t           module_generation_{0};
 };
 
 }  // namespace dmlf
@@ -28,6 +28,10 @@
 namespace fetch {
 namespace dmlf {
 
+/**
+ * The storage of an Etch program. Snapshots share the stored values with the state they are taken
+ * from until either of them is written to (copy on write), so taking them is cheap.
+ */
 class VmState : public vm::IoObserverInterface
 {
 public:
@@ -42,13 +46,17 @@ public:
   Status Write(std::string const &key, void const *data, uint64_t size) override;
   Status Exists(std::string const &key) override;
 
+  VmState Snapshot() const;
   VmState DeepCopy() const;
 
 private:
-  using Buffer = fetch::byte_array::ConstByteArray;
-  using Store  = std::unordered_map<std::string, Buffer>;
+  using Buffer   = fetch::byte_array::ConstByteArray;
+  using Store    = std::unordered_map<std::string, Buffer>;
+  using StorePtr = std::shared_ptr<Store>;
 
-  Store store_;
+  Store &WritableStore();
+
+  StorePtr store_ = std::make_shared<Store>();
 };
 
 }  // namespace dmlf
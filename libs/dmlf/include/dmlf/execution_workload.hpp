@@ -22,6 +22,8 @@
 #include "dmlf/execution/execution_interface.hpp"
 #include "dmlf/execution/execution_result.hpp"
 
+#include <vector>
+
 namespace fetch {
 namespace dmlf {
 
@@ -36,10 +38,22 @@ public:
   using Worker                      = std::function<ExecutionResult(ExecutionEngineInterfacePtr)>;
   using Name                        = ExecutionInterface::Name;
 
-  ExecutionWorkload(Respondent respondent, OpIdent op_id, Name state_name, Worker worker)
+  /**
+   * An executable or state used by a workload. Shared resources are only read, and can be used by
+   * several workloads at the same time.
+   */
+  struct Resource
+  {
+    Name name;
+    bool shared;
+  };
+
+  using Resources = std::vector<Resource>;
+
+  ExecutionWorkload(Respondent respondent, OpIdent op_id, Resources resources, Worker worker)
     : respondent_(std::move(respondent))
     , op_id_(std::move(op_id))
-    , state_name_(std::move(state_name))
+    , resources_(std::move(resources))
     , worker_(std::move(worker))
   {}
   virtual ~ExecutionWorkload() = default;
@@ -54,7 +68,7 @@ protected:
 private:
   Respondent respondent_;
   OpIdent    op_id_;
-  Name       state_name_;  // if empty, this operation does not need a state resource.
+  Resources  resources_;  // executables and states used, workloads sharing one run in order
   Worker     worker_;
 };
 
@@ -26,9 +26,24 @@
 #include "muddle/rpc/server.hpp"
 #include "network/service/call_context.hpp"
 
+#include <condition_variable>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
 namespace fetch {
 namespace dmlf {
 
+/**
+ * Executes the workloads sent by remote clients on an execution engine.
+ *
+ * Workloads are executed in the order they were received by ExecuteOneWorkload, or in parallel by
+ * the workers of the host once they are started. Workloads which use the same executable or state
+ * are never executed at the same time, and keep the order in which they were received.
+ */
 class RemoteExecutionHost
 {
 public:
@@ -43,10 +58,12 @@ public:
   using Params    = ExecutionParameters;
 
   using PendingWorkloads = std::list<ExecutionWorkload>;
+  using Resource         = ExecutionWorkload::Resource;
+  using Resources        = ExecutionWorkload::Resources;
 
   RemoteExecutionHost(MuddlePtr mud, ExecutionEngineInterfacePtr executor);
 
-  virtual ~RemoteExecutionHost() = default;
+  virtual ~RemoteExecutionHost();
 
   RemoteExecutionHost(RemoteExecutionHost const &other) = delete;
   RemoteExecutionHost &operator=(RemoteExecutionHost const &other)  = delete;
@@ -70,15 +87,44 @@ public:
 
   bool ExecuteOneWorkload();
 
+  void StartWorkers(std::size_t count);
+  void StopWorkers();
+
   static constexpr char const *LOGGING_NAME = "RemoteExecutionHost";
 
 protected:
 private:
+  using Lock = std::unique_lock<std::mutex>;
+
+  /**
+   * Resources used by workloads, or reserved for them
+   */
+  struct Claims
+  {
+    std::unordered_set<Name>      exclusive;
+    std::unordered_multiset<Name> shared;
+  };
+
+  static bool Conflicts(Claims const &claims, Resources const &resources);
+  static void Claim(Claims &claims, Resources const &resources);
+  static void Release(Claims &claims, Resources const &resources);
+
+  void Enqueue(ExecutionWorkload workload);
+  bool TakeRunnable(PendingWorkloads &taken);
+  void Execute(ExecutionWorkload const &workload);
+  void RunWorker();
+
   MuddlePtr                  mud_;
   std::shared_ptr<RpcClient> client_;
 
   PendingWorkloads            pending_workloads_;
   ExecutionEngineInterfacePtr executor_;
+
+  std::mutex               mutex_;  ///< Guards the workloads and the resources in use
+  std::condition_variable  workload_runnable_;
+  Claims                   busy_resources_;
+  std::vector<std::thread> workers_;
+  bool                     stopping_{false};
 };
 
 }  // namespace dmlf
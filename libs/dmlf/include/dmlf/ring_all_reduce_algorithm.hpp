@@ -0,0 +1,63 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <vector>
+
+#include "dmlf/shuffle_algorithm_interface.hpp"
+
+namespace fetch {
+namespace dmlf {
+
+/**
+ * Sends every update to a single peer on a ring of the whole cohort, so that the bandwidth used by
+ * a learner in a round stays the same however large the cohort grows.
+ *
+ * The distance along the ring doubles every round (1, 2, 4, ...) and starts over once it would
+ * reach the size of the cohort. Learners fold the updates they receive into the next update they
+ * send, so after GetRoundsPerCycle() rounds every update has reached every learner, as in a
+ * recursive doubling all-reduce.
+ *
+ * All learners must be given their peers in the same order: the order of the cohort with the
+ * learner itself left out.
+ */
+class RingAllReduceAlgorithm : public ShuffleAlgorithmInterface
+{
+public:
+  RingAllReduceAlgorithm(std::size_t count, std::size_t rank);
+  ~RingAllReduceAlgorithm() override = default;
+
+  std::vector<std::size_t> GetNextOutputs() override;
+
+  std::size_t GetRoundsPerCycle() const;
+
+  RingAllReduceAlgorithm(RingAllReduceAlgorithm const &other) = delete;
+  RingAllReduceAlgorithm &operator=(RingAllReduceAlgorithm const &other)  = delete;
+  bool                    operator==(RingAllReduceAlgorithm const &other) = delete;
+  bool                    operator<(RingAllReduceAlgorithm const &other)  = delete;
+
+protected:
+private:
+  std::size_t rank_;
+  std::size_t round_;
+  std::size_t rounds_per_cycle_;
+};
+
+}  // namespace dmlf
+}  // namespace fetch
@@ -38,13 +38,24 @@ using fixed_point::fp32_t;
 
 ExecutionResult BasicVmEngine::CreateExecutable(Name const &execName, SourceFiles const &sources)
 {
-  if (HasExecutable(execName))
   {
-    return EngineError(Error::Code::BAD_EXECUTABLE, "executable " + execName + " already exists.");
+    FETCH_LOCK(mutex_);
+    if (HasExecutable(execName))
+    {
+      return EngineError(Error::Code::BAD_EXECUTABLE,
+                         "executable " + execName + " already exists.");
+    }
   }
 
-  auto newExecutable = std::make_shared<Executable>();
-  auto errors        = fetch::vm_modules::VMFactory::Compile(module_, sources, *newExecutable);
+  auto              newExecutable = std::make_shared<Executable>();
+  VmFactory::Errors errors;
+  {
+    FETCH_LOCK(module_mutex_);
+    errors = VmFactory::Compile(module_, sources, *newExecutable);
+
+    idle_vms_.clear();
+    ++module_generation_;
+  }
 
   if (!errors.empty())
   {
@@ -59,7 +70,12 @@ ExecutionResult BasicVmEngine::CreateExecutable(Name const &execName, SourceFile
         Error{Error::Stage::COMPILE, Error::Code::COMPILATION_ERROR, errorString.str()},
         std::string{}};
   }
-  executables_.emplace(execName, std::move(newExecutable));
+
+  FETCH_LOCK(mutex_);
+  if (!executables_.emplace(execName, std::move(newExecutable)).second)
+  {
+    return EngineError(Error::Code::BAD_EXECUTABLE, "executable " + execName + " already exists.");
+  }
 
   return ExecutionResult{
       LedgerVariant(),
@@ -69,6 +85,7 @@ ExecutionResult BasicVmEngine::CreateExecutable(Name const &execName, SourceFile
 
 ExecutionResult BasicVmEngine::DeleteExecutable(Name const &execName)
 {
+  FETCH_LOCK(mutex_);
   auto it = executables_.find(execName);
 
   if (it == executables_.end())
@@ -76,18 +93,20 @@ ExecutionResult BasicVmEngine::DeleteExecutable(Name const &execName)
     return EngineError(Error::Code::BAD_EXECUTABLE, "executable " + execName + " does not exist.");
   }
 
+  // runs in progress keep their own reference to the executable
   executables_.erase(it);
   return EngineSuccess("Deleted executable " + execName);
 }
 
 ExecutionResult BasicVmEngine::CreateState(Name const &stateName)
 {
+  FETCH_LOCK(mutex_);
   if (HasState(stateName))
   {
     return EngineError(Error::Code::BAD_STATE, "state " + stateName + " already exists.");
   }
 
-  states_.emplace(stateName, std::make_shared<State>());
+  states_.emplace(stateName, std::make_shared<StateSlot>());
   return ExecutionResult{
       LedgerVariant{},
       Error{Error::Stage::ENGINE, Error::Code::SUCCESS, "Created state " + stateName},
@@ -96,21 +115,37 @@ ExecutionResult BasicVmEngine::CreateState(Name const &stateName)
 
 ExecutionResult BasicVmEngine::CopyState(Name const &srcName, Name const &newName)
 {
-  if (!HasState(srcName))
+  StateSlotPtr source;
   {
-    return EngineError(Error::Code::BAD_STATE, "No state named " + srcName);
+    FETCH_LOCK(mutex_);
+    if (!HasState(srcName))
+    {
+      return EngineError(Error::Code::BAD_STATE, "No state named " + srcName);
+    }
+    if (HasState(newName))
+    {
+      return EngineError(Error::Code::BAD_DESTINATION, "state " + newName + " already exists.");
+    }
+    source = states_[srcName];
   }
-  if (HasState(newName))
+
+  StateSlotPtr copy;
   {
-    return EngineError(Error::Code::BAD_DESTINATION, "state " + newName + " already exists.");
+    FETCH_LOCK(source->mutex);
+    copy = std::make_shared<StateSlot>(source->state.Snapshot());
   }
 
-  states_.emplace(newName, std::make_shared<State>(states_[srcName]->DeepCopy()));
+  FETCH_LOCK(mutex_);
+  if (!states_.emplace(newName, std::move(copy)).second)
+  {
+    return EngineError(Error::Code::BAD_DESTINATION, "state " + newName + " already exists.");
+  }
   return EngineSuccess("Copied state " + srcName + " to " + newName);
 }
 
 ExecutionResult BasicVmEngine::DeleteState(Name const &stateName)
 {
+  FETCH_LOCK(mutex_);
   auto it = states_.find(stateName);
   if (it == states_.end())
   {
@@ -124,32 +159,54 @@ ExecutionResult BasicVmEngine::DeleteState(Name const &stateName)
 ExecutionResult BasicVmEngine::Run(Name const &execName, Name const &stateName,
                                    std::string const &entrypoint, Params params)
 {
-  if (!HasExecutable(execName))
-  {
-    return EngineError(Error::Code::BAD_EXECUTABLE, "Error: No executable " + execName);
-  }
-  if (!HasState(stateName))
+  ExecutablePtr exec;
+  StateSlotPtr  slot;
   {
-    return EngineError(Error::Code::BAD_STATE, "Error: No state " + stateName);
+    FETCH_LOCK(mutex_);
+    if (!HasExecutable(execName))
+    {
+      return EngineError(Error::Code::BAD_EXECUTABLE, "Error: No executable " + execName);
+    }
+    if (!HasState(stateName))
+    {
+      return EngineError(Error::Code::BAD_STATE, "Error: No state " + stateName);
+    }
+
+    exec = executables_[execName];
+    slot = states_[stateName];
   }
 
-  auto &      exec  = executables_[execName];
-  auto &      state = states_[stateName];
-  auto const *func  = exec->FindFunction(entrypoint);
+  auto const *func = exec->FindFunction(entrypoint);
   if (func == nullptr)
   {
     return EngineError(Error::Code::RUNTIME_ERROR, "Error: " + entrypoint + " does not exist");
   }
 
-  // We create a a VM for each execution. It might be better to create a single VM and reuse it, but
-  // (currently) if you create a VM before compiling the VM is badly formed and crashes on execution
-  VM vm{module_.get()};
-  vm.SetIOObserver(*state);
+  FETCH_LOCK(slot->mutex);
+
+  uint64_t generation{0};
+  auto     vm = AcquireVm(generation);
+
+  vm->SetIOObserver(slot->state);
   std::ostringstream console{};
-  vm.AttachOutputDevice(fetch::vm::VM::STDOUT, console);
+  vm->AttachOutputDevice(fetch::vm::VM::STDOUT, console);
+
+  auto result = Execute(*vm, exec.get(), func, execName, stateName, entrypoint, params, console);
+
+  vm->DetachOutputDevice(fetch::vm::VM::STDOUT);
+  ReleaseVm(std::move(vm), generation);
+
+  return result;
+}
+
+ExecutionResult BasicVmEngine::Execute(VM &vm, Executable *exec, Executable::Function const *func,
+                                       Name const &execName, Name const &stateName,
+                                       std::string const &entrypoint, Params const &params,
+                                       std::ostringstream &console)
+{
   vm::ParameterPack parameterPack(vm.registered_types());
 
-  Error prepSuccess = PrepInput(parameterPack, params, vm, exec.get(), func,
+  Error prepSuccess = PrepInput(parameterPack, params, vm, exec, func,
                                 "Exec: " + execName + " State: " + stateName);
 
   if (prepSuccess.code() != Error::Code::SUCCESS)
@@ -170,10 +227,40 @@ ExecutionResult BasicVmEngine::Run(Name const &execName, Name const &stateName,
         console.str()};
   }
 
-  return PrepOutput(vm, exec.get(), vmOutput, console.str(),
+  return PrepOutput(vm, exec, vmOutput, console.str(),
                     "Exec:" + execName + " with state " + stateName);
 }
 
+/**
+ * Take an idle VM, or create one for the current module
+ *
+ * @param generation Set to the version of the module the VM was created for
+ * @return The VM
+ */
+BasicVmEngine::VmPtr BasicVmEngine::AcquireVm(uint64_t &generation)
+{
+  FETCH_LOCK(module_mutex_);
+  generation = module_generation_;
+
+  if (idle_vms_.empty())
+  {
+    return std::make_unique<VM>(module_.get());
+  }
+
+  auto vm = std::move(idle_vms_.back());
+  idle_vms_.pop_back();
+  return vm;
+}
+
+void BasicVmEngine::ReleaseVm(VmPtr vm, uint64_t generation)
+{
+  FETCH_LOCK(module_mutex_);
+  if (generation == module_generation_)
+  {
+    idle_vms_.emplace_back(std::move(vm));
+  }
+}
+
 ExecutionResult BasicVmEngine::EngineError(Error::Code code, std::string errorMessage) const
 {
   return ExecutionResult{LedgerVariant(),
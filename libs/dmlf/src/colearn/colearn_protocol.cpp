@@ -27,6 +27,7 @@ ColearnProtocol::ColearnProtocol(MuddleLearnerNetworkerImpl &exec)
 {
   ExposeWithClientContext(RPC_COLEARN_UPDATE, &exec,
                           &MuddleLearnerNetworkerImpl::NetworkColearnUpdate);
+  Expose(RPC_COLEARN_ENCODING, &exec, &MuddleLearnerNetworkerImpl::NetworkColearnEncoding);
 }
 
 }  // namespace colearn
@@ -18,11 +18,13 @@
 
 #include "crypto/ecdsa.hpp"
 #include "dmlf/colearn/muddle_learner_networker_impl.hpp"
+#include "dmlf/colearn/muddle_outbound_encoding_task.hpp"
 #include "dmlf/colearn/muddle_outbound_update_task.hpp"
 #include "dmlf/colearn/update_store.hpp"
 #include "dmlf/stochastic_reception_algorithm.hpp"
 #include "muddle/rpc/client.hpp"
 #include <cmath>  // for modf
+#include <map>
 
 namespace fetch {
 namespace dmlf {
@@ -204,13 +206,26 @@ void MuddleLearnerNetworkerImpl::PushUpdateBytes(UpdateType const &type_name, By
 {
   auto random_factor   = randomiser_.GetNew();
   broadcast_proportion = std::max(0.0, std::min(1.0, broadcast_proportion));
+
+  // every encoding is applied once, so that its residual is carried over exactly once
+  std::map<UpdateEncoding, Peers> peers_by_encoding;
   for (auto const &peer : peers)
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "Creating sender for ", type_name, " to target ",
-                   fetch::byte_array::ToBase64(peer));
-    auto task = std::make_shared<MuddleOutboundUpdateTask>(peer, type_name, update, client_,
-                                                           broadcast_proportion, random_factor);
-    taskpool_->submit(task);
+    peers_by_encoding[PeerEncoding(peer)].insert(peer);
+  }
+
+  for (auto const &group : peers_by_encoding)
+  {
+    auto const encoded = EncodeUpdate(type_name, update, group.first);
+
+    for (auto const &peer : group.second)
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Creating sender for ", type_name, " to target ",
+                     fetch::byte_array::ToBase64(peer));
+      auto task = std::make_shared<MuddleOutboundUpdateTask>(peer, type_name, encoded, client_,
+                                                             broadcast_proportion, random_factor);
+      taskpool_->submit(task);
+    }
   }
 }
 
@@ -235,8 +250,17 @@ void MuddleLearnerNetworkerImpl::PushUpdateBytes(UpdateType const &type_name, By
   }
   else
   {
+    // a broadcast reaches every peer, so it is encoded only as far as all of them accept
+    auto encoding = supplied_peers_.empty() ? UpdateEncoding{} : NetworkColearnEncoding();
+    for (auto const &peer : supplied_peers_)
+    {
+      encoding =
+          UpdateEncoding::Negotiate(encoding, PeerEncoding(fetch::byte_array::FromBase64(peer)));
+    }
+
     serializers::MsgPackSerializer buf;
-    buf << type_name << update << broadcast_proportion_ << random_factor;
+    buf << type_name << EncodeUpdate(type_name, update, encoding) << broadcast_proportion_
+        << random_factor;
     mud_->GetEndpoint().Broadcast(SERVICE_DMLF, CHANNEL_COLEARN_BROADCAST, buf.data());
   }
 }
@@ -269,6 +293,99 @@ uint64_t MuddleLearnerNetworkerImpl::ProcessUpdate(const std::string &        ty
   return 1;
 }
 
+/**
+ * Set the encoding of the updates sent by this learner, which is also the most lossy encoding it
+ * accepts from its peers
+ */
+void MuddleLearnerNetworkerImpl::SetUpdateEncoding(UpdateEncoding const &encoding)
+{
+  FETCH_LOCK(mutex_);
+  update_encoding_ = encoding;
+}
+
+/**
+ * Set the encoder for the serialised updates of a type. Updates without an encoder are sent
+ * unencoded.
+ */
+void MuddleLearnerNetworkerImpl::SetUpdateEncoder(UpdateType const &type_name,
+                                                  UpdateEncoderPtr  encoder)
+{
+  FETCH_LOCK(mutex_);
+  update_encoders_[type_name] = std::move(encoder);
+}
+
+UpdateEncoding MuddleLearnerNetworkerImpl::NetworkColearnEncoding()
+{
+  FETCH_LOCK(mutex_);
+  return update_encoding_;
+}
+
+/**
+ * The encoding of the updates sent to a peer. Until the peer has told which encoding it accepts
+ * it is sent unencoded updates.
+ *
+ * @param peer The address of the peer
+ * @return The negotiated encoding
+ */
+UpdateEncoding MuddleLearnerNetworkerImpl::PeerEncoding(Address const &peer)
+{
+  {
+    FETCH_LOCK(mutex_);
+    if (update_encoding_.IsIdentity())
+    {
+      return update_encoding_;
+    }
+
+    auto it = peer_encodings_.find(peer);
+    if (it != peer_encodings_.end())
+    {
+      return UpdateEncoding::Negotiate(update_encoding_, it->second);
+    }
+
+    if (!encoding_requests_.insert(peer).second)
+    {
+      return UpdateEncoding{};
+    }
+  }
+
+  taskpool_->submit(std::make_shared<MuddleOutboundEncodingTask>(
+      peer, client_, [this](Address const &target, UpdateEncoding const &encoding) {
+        SetPeerEncoding(target, encoding);
+      }));
+
+  return UpdateEncoding{};
+}
+
+void MuddleLearnerNetworkerImpl::SetPeerEncoding(Address const &       peer,
+                                                 UpdateEncoding const &encoding)
+{
+  FETCH_LOCK(mutex_);
+  peer_encodings_[peer] = encoding;
+  encoding_requests_.erase(peer);
+}
+
+MuddleLearnerNetworkerImpl::Bytes MuddleLearnerNetworkerImpl::EncodeUpdate(
+    UpdateType const &type_name, Bytes const &update, UpdateEncoding const &encoding)
+{
+  if (encoding.IsIdentity())
+  {
+    return update;
+  }
+
+  UpdateEncoderPtr encoder;
+  {
+    FETCH_LOCK(mutex_);
+    auto it = update_encoders_.find(type_name);
+    if (it == update_encoders_.end())
+    {
+      return update;
+    }
+    encoder = it->second;
+  }
+
+  return encoder->Encode(update, encoding);
+}
+
 uint64_t MuddleLearnerNetworkerImpl::NetworkColearnUpdate(service::CallContext const &context,
                                                           const std::string &         type_name,
                                                           byte_array::ConstByteArray  bytes,
@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/encoders.hpp"
+#include "core/service_ids.hpp"
+#include "dmlf/colearn/colearn_protocol.hpp"
+#include "dmlf/colearn/muddle_outbound_encoding_task.hpp"
+#include "logging/logging.hpp"
+#include "muddle/rpc/client.hpp"
+
+namespace fetch {
+namespace dmlf {
+namespace colearn {
+
+MuddleOutboundEncodingTask::ExitState MuddleOutboundEncodingTask::run()
+{
+  FETCH_LOG_INFO(LOGGING_NAME, "Requesting update encoding of ",
+                 fetch::byte_array::ToBase64(target_));
+  auto prom = client_->CallSpecificAddress(target_, RPC_COLEARN,
+                                           ColearnProtocol::RPC_COLEARN_ENCODING);
+
+  UpdateEncoding encoding{};
+  if (!prom->GetResult(encoding))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "No update encoding from ", fetch::byte_array::ToBase64(target_),
+                   ", sending full updates");
+    encoding = UpdateEncoding{};
+  }
+
+  callback_(target_, encoding);
+  return ExitState::COMPLETE;
+}
+
+bool MuddleOutboundEncodingTask::IsRunnable() const
+{
+  return true;
+}
+
+}  // namespace colearn
+}  // namespace dmlf
+}  // namespace fetch
@@ -0,0 +1,225 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "dmlf/colearn/update_encoding.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+namespace fetch {
+namespace dmlf {
+namespace colearn {
+
+namespace {
+
+bool IsQuantised(uint8_t bits)
+{
+  return (bits == 8) || (bits == 16);
+}
+
+std::size_t BytesPerValue(uint8_t bits)
+{
+  return IsQuantised(bits) ? bits / 8u : sizeof(float);
+}
+
+/**
+ * Flat indices of the k values with the largest magnitudes, in increasing order
+ */
+EncodedTensor::Indices SelectLargest(EncodedTensor::Values const &values, std::size_t k)
+{
+  EncodedTensor::Indices indices(values.size());
+  std::iota(indices.begin(), indices.end(), 0u);
+
+  auto const by_magnitude = [&values](uint32_t a, uint32_t b) {
+    return std::fabs(values[a]) > std::fabs(values[b]);
+  };
+
+  std::nth_element(indices.begin(), indices.begin() + static_cast<std::ptrdiff_t>(k),
+                   indices.end(), by_magnitude);
+  indices.resize(k);
+  std::sort(indices.begin(), indices.end());
+
+  return indices;
+}
+
+}  // namespace
+
+bool UpdateEncoding::IsIdentity() const
+{
+  return (density >= 1.0) && !IsQuantised(bits);
+}
+
+/**
+ * The least lossy encoding accepted by both sides
+ */
+UpdateEncoding UpdateEncoding::Negotiate(UpdateEncoding const &a, UpdateEncoding const &b)
+{
+  UpdateEncoding result;
+  result.density = std::min(1.0, std::max(a.density, b.density));
+  result.bits    = (IsQuantised(a.bits) && IsQuantised(b.bits)) ? std::max(a.bits, b.bits)
+                                                                 : FULL_PRECISION;
+  return result;
+}
+
+bool operator==(UpdateEncoding const &a, UpdateEncoding const &b)
+{
+  return (a.density == b.density) && (a.bits == b.bits);
+}
+
+bool operator<(UpdateEncoding const &a, UpdateEncoding const &b)
+{
+  return std::tie(a.density, a.bits) < std::tie(b.density, b.bits);
+}
+
+std::size_t EncodedTensor::ElementCount() const
+{
+  return std::accumulate(shape.begin(), shape.end(), std::size_t{1},
+                         [](std::size_t count, uint64_t dim) { return count * dim; });
+}
+
+EncodedTensor EncodeTensor(EncodedTensor::Shape shape, EncodedTensor::Values &values,
+                           UpdateEncoding const &encoding)
+{
+  EncodedTensor tensor;
+  tensor.shape = std::move(shape);
+  tensor.bits  = IsQuantised(encoding.bits) ? encoding.bits : UpdateEncoding::FULL_PRECISION;
+
+  auto const total = values.size();
+  auto       count = total;
+  if (encoding.density < 1.0)
+  {
+    auto const wanted = std::ceil(std::max(0.0, encoding.density) * static_cast<double>(total));
+    count             = std::min(total, std::max<std::size_t>(1, static_cast<std::size_t>(wanted)));
+  }
+
+  if (count < total)
+  {
+    tensor.indices = SelectLargest(values, count);
+  }
+
+  auto const value_at = [&tensor, &values](std::size_t i) -> float & {
+    return tensor.indices.empty() ? values[i] : values[tensor.indices[i]];
+  };
+
+  float low  = 0;
+  float high = 0;
+  if (count > 0)
+  {
+    low  = value_at(0);
+    high = value_at(0);
+    for (std::size_t i = 1; i < count; ++i)
+    {
+      low  = std::min(low, value_at(i));
+      high = std::max(high, value_at(i));
+    }
+  }
+
+  double const levels = IsQuantised(tensor.bits) ? std::ldexp(1.0, tensor.bits) - 1 : 0;
+  tensor.offset       = low;
+  tensor.scale        = (levels > 0) ? (static_cast<double>(high) - low) / levels : 0;
+
+  byte_array::ByteArray bytes;
+  bytes.Resize(count * BytesPerValue(tensor.bits));
+  uint8_t *out = bytes.pointer();
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto &value = value_at(i);
+    float sent  = value;
+
+    if (IsQuantised(tensor.bits))
+    {
+      auto const level =
+          (tensor.scale > 0) ? std::round((value - tensor.offset) / tensor.scale) : 0.0;
+      auto const q = static_cast<uint32_t>(std::max(0.0, std::min(level, levels)));
+      sent         = static_cast<float>(tensor.offset + q * tensor.scale);
+
+      *out++ = static_cast<uint8_t>(q & 0xFFu);
+      if (tensor.bits == 16)
+      {
+        *out++ = static_cast<uint8_t>(q >> 8u);
+      }
+    }
+    else
+    {
+      std::memcpy(out, &sent, sizeof(float));
+      out += sizeof(float);
+    }
+
+    // error feedback, the receiver is missing only the quantisation error of this value
+    value -= sent;
+  }
+
+  tensor.values = bytes;
+  return tensor;
+}
+
+EncodedTensor::Values DecodeTensor(EncodedTensor const &tensor)
+{
+  if ((tensor.bits != UpdateEncoding::FULL_PRECISION) && !IsQuantised(tensor.bits))
+  {
+    throw std::runtime_error("Unsupported update quantisation: " + std::to_string(tensor.bits));
+  }
+
+  auto const total = tensor.ElementCount();
+  auto const count = tensor.indices.empty() ? total : tensor.indices.size();
+
+  if (tensor.values.size() != count * BytesPerValue(tensor.bits))
+  {
+    throw std::runtime_error("Encoded update tensor has an inconsistent size");
+  }
+
+  EncodedTensor::Values values(total, 0.0f);
+  uint8_t const *       in = tensor.values.pointer();
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    float value = 0;
+    if (IsQuantised(tensor.bits))
+    {
+      uint32_t q = *in++;
+      if (tensor.bits == 16)
+      {
+        q |= static_cast<uint32_t>(*in++) << 8u;
+      }
+      value = static_cast<float>(tensor.offset + q * tensor.scale);
+    }
+    else
+    {
+      std::memcpy(&value, in, sizeof(float));
+      in += sizeof(float);
+    }
+
+    auto const index = tensor.indices.empty() ? i : tensor.indices[i];
+    if (index >= total)
+    {
+      throw std::runtime_error("Encoded update tensor index out of range");
+    }
+    values[index] = value;
+  }
+
+  return values;
+}
+
+}  // namespace colearn
+}  // namespace dmlf
+}  // namespace fetch
@@ -21,9 +21,29 @@
 #include "dmlf/remote_execution_host.hpp"
 #include "dmlf/remote_execution_protocol.hpp"
 
+#include <algorithm>
+#include <utility>
+
 namespace fetch {
 namespace dmlf {
 
+namespace {
+
+using Name     = RemoteExecutionHost::Name;
+using Resource = RemoteExecutionHost::Resource;
+
+Resource ExecutableResource(Name const &execName, bool shared = false)
+{
+  return Resource{"executable:" + execName, shared};
+}
+
+Resource StateResource(Name const &stateName, bool shared = false)
+{
+  return Resource{"state:" + stateName, shared};
+}
+
+}  // namespace
+
 RemoteExecutionHost::RemoteExecutionHost(MuddlePtr mud, ExecutionEngineInterfacePtr executor)
   : mud_(std::move(mud))
   , executor_(std::move(executor))
@@ -31,13 +51,18 @@ RemoteExecutionHost::RemoteExecutionHost(MuddlePtr mud, ExecutionEngineInterface
   client_ = std::make_shared<RpcClient>("Host", mud_->GetEndpoint(), SERVICE_DMLF, CHANNEL_RPC);
 }
 
+RemoteExecutionHost::~RemoteExecutionHost()
+{
+  StopWorkers();
+}
+
 bool RemoteExecutionHost::CreateExecutable(service::CallContext const &context,
                                            OpIdent const &op_id, Name const &execName,
                                            SourceFiles const &sources)
 {
   FETCH_LOG_TRACE(LOGGING_NAME, "Received call for RPC CreateExecutable");
-  pending_workloads_.emplace_back(
-      ExecutionWorkload(context.sender_address, op_id, "",
+  Enqueue(
+      ExecutionWorkload(context.sender_address, op_id, {ExecutableResource(execName)},
                         [execName, sources](ExecutionEngineInterfacePtr const &exec) {
                           return exec->CreateExecutable(execName, sources);
                         }));
@@ -47,8 +72,9 @@ bool RemoteExecutionHost::DeleteExecutable(service::CallContext const &context,
                                            OpIdent const &op_id, Name const &execName)
 {
   FETCH_LOG_TRACE(LOGGING_NAME, "Received call for RPC DeleteExecutable");
-  pending_workloads_.emplace_back(ExecutionWorkload(
-      context.sender_address, op_id, "", [execName](ExecutionEngineInterfacePtr const &exec) {
+  Enqueue(ExecutionWorkload(
+      context.sender_address, op_id, {ExecutableResource(execName)},
+      [execName](ExecutionEngineInterfacePtr const &exec) {
         return exec->DeleteExecutable(execName);
       }));
   return true;
@@ -58,8 +84,9 @@ bool RemoteExecutionHost::CreateState(service::CallContext const &context, OpIde
                                       Name const &stateName)
 {
   FETCH_LOG_TRACE(LOGGING_NAME, "Received call for RPC CreateState");
-  pending_workloads_.emplace_back(ExecutionWorkload(
-      context.sender_address, op_id, "", [stateName](ExecutionEngineInterfacePtr const &exec) {
+  Enqueue(ExecutionWorkload(
+      context.sender_address, op_id, {StateResource(stateName)},
+      [stateName](ExecutionEngineInterfacePtr const &exec) {
         return exec->CreateState(stateName);
       }));
   return true;
@@ -68,8 +95,9 @@ bool RemoteExecutionHost::CopyState(service::CallContext const &context, OpIdent
                                     Name const &srcName, Name const &newName)
 {
   FETCH_LOG_TRACE(LOGGING_NAME, "Received call for RPC CopyState");
-  pending_workloads_.emplace_back(
-      ExecutionWorkload(context.sender_address, op_id, "",
+  Enqueue(
+      ExecutionWorkload(context.sender_address, op_id,
+                        {StateResource(srcName, true), StateResource(newName)},
                         [srcName, newName](ExecutionEngineInterfacePtr const &exec) {
                           return exec->CopyState(srcName, newName);
                         }));
@@ -79,8 +107,9 @@ bool RemoteExecutionHost::DeleteState(service::CallContext const &context, OpIde
                                       Name const &stateName)
 {
   FETCH_LOG_TRACE(LOGGING_NAME, "Received call for RPC DeleteState");
-  pending_workloads_.emplace_back(ExecutionWorkload(
-      context.sender_address, op_id, "", [stateName](ExecutionEngineInterfacePtr const &exec) {
+  Enqueue(ExecutionWorkload(
+      context.sender_address, op_id, {StateResource(stateName)},
+      [stateName](ExecutionEngineInterfacePtr const &exec) {
         return exec->DeleteState(stateName);
       }));
   return true;
@@ -91,8 +120,8 @@ bool RemoteExecutionHost::Run(service::CallContext const &context, OpIdent const
                               std::string const &entrypoint, Params const &params)
 {
   FETCH_LOG_TRACE(LOGGING_NAME, "Received call for RPC Run");
-  pending_workloads_.emplace_back(ExecutionWorkload(
-      context.sender_address, op_id, "",
+  Enqueue(ExecutionWorkload(
+      context.sender_address, op_id, {ExecutableResource(execName, true), StateResource(stateName)},
       [execName, stateName, entrypoint, params](ExecutionEngineInterfacePtr const &exec) {
         return exec->Run(execName, stateName, entrypoint, params);
       }));
@@ -101,19 +130,153 @@ bool RemoteExecutionHost::Run(service::CallContext const &context, OpIdent const
 
 bool RemoteExecutionHost::ExecuteOneWorkload()
 {
-  if (pending_workloads_.empty())
+  PendingWorkloads taken;
   {
-    return false;
+    Lock lock(mutex_);
+    if (!TakeRunnable(taken))
+    {
+      return false;
+    }
   }
 
-  auto wl = pending_workloads_.front();
-  pending_workloads_.pop_front();
-  auto res = wl.worker_(executor_);
+  Execute(taken.front());
+  return true;
+}
 
-  client_->CallSpecificAddress(wl.respondent_, RPC_DMLF, RemoteExecutionProtocol::RPC_DMLF_RESULTS,
-                               wl.op_id_, res);
+/**
+ * Execute workloads in parallel on background threads, until the workers are stopped
+ *
+ * @param count The number of workloads executed at the same time
+ */
+void RemoteExecutionHost::StartWorkers(std::size_t count)
+{
+  Lock lock(mutex_);
+  stopping_ = false;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    workers_.emplace_back([this]() { RunWorker(); });
+  }
+}
 
-  return true;
+void RemoteExecutionHost::StopWorkers()
+{
+  std::vector<std::thread> workers;
+  {
+    Lock lock(mutex_);
+    stopping_ = true;
+    workers.swap(workers_);
+  }
+  workload_runnable_.notify_all();
+
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+}
+
+void RemoteExecutionHost::Enqueue(ExecutionWorkload workload)
+{
+  {
+    Lock lock(mutex_);
+    pending_workloads_.emplace_back(std::move(workload));
+  }
+  workload_runnable_.notify_one();
+}
+
+/**
+ * Move the oldest workload which can be executed now into a list. A workload can not be executed
+ * while one of its resources is in use, or reserved by an older workload which is still pending.
+ *
+ * @param taken The list the workload is moved to
+ * @return Whether there was such a workload
+ */
+bool RemoteExecutionHost::TakeRunnable(PendingWorkloads &taken)
+{
+  auto reserved = busy_resources_;
+
+  for (auto it = pending_workloads_.begin(); it != pending_workloads_.end(); ++it)
+  {
+    if (!Conflicts(reserved, it->resources_))
+    {
+      Claim(busy_resources_, it->resources_);
+      taken.splice(taken.end(), pending_workloads_, it);
+      return true;
+    }
+
+    Claim(reserved, it->resources_);
+  }
+
+  return false;
+}
+
+void RemoteExecutionHost::Execute(ExecutionWorkload const &workload)
+{
+  auto res = workload.worker_(executor_);
+
+  client_->CallSpecificAddress(workload.respondent_, RPC_DMLF,
+                               RemoteExecutionProtocol::RPC_DMLF_RESULTS, workload.op_id_, res);
+
+  {
+    Lock lock(mutex_);
+    Release(busy_resources_, workload.resources_);
+  }
+  workload_runnable_.notify_all();
+}
+
+bool RemoteExecutionHost::Conflicts(Claims const &claims, Resources const &resources)
+{
+  return std::any_of(resources.begin(), resources.end(), [&claims](Resource const &resource) {
+    return (claims.exclusive.count(resource.name) != 0) ||
+           (!resource.shared && (claims.shared.count(resource.name) != 0));
+  });
+}
+
+void RemoteExecutionHost::Claim(Claims &claims, Resources const &resources)
+{
+  for (auto const &resource : resources)
+  {
+    if (resource.shared)
+    {
+      claims.shared.insert(resource.name);
+    }
+    else
+    {
+      claims.exclusive.insert(resource.name);
+    }
+  }
+}
+
+void RemoteExecutionHost::Release(Claims &claims, Resources const &resources)
+{
+  for (auto const &resource : resources)
+  {
+    if (resource.shared)
+    {
+      claims.shared.erase(claims.shared.find(resource.name));
+    }
+    else
+    {
+      claims.exclusive.erase(resource.name);
+    }
+  }
+}
+
+void RemoteExecutionHost::RunWorker()
+{
+  for (;;)
+  {
+    PendingWorkloads taken;
+    {
+      Lock lock(mutex_);
+      workload_runnable_.wait(lock, [this, &taken]() { return stopping_ || TakeRunnable(taken); });
+      if (taken.empty())
+      {
+        return;
+      }
+    }
+
+    Execute(taken.front());
+  }
 }
 
 }  // namespace dmlf
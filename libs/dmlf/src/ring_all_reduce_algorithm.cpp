@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "dmlf/ring_all_reduce_algorithm.hpp"
+
+#include <stdexcept>
+
+namespace fetch {
+namespace dmlf {
+
+/**
+ * @param count The number of peers, the cohort without this learner
+ * @param rank The position of this learner in the cohort
+ */
+RingAllReduceAlgorithm::RingAllReduceAlgorithm(std::size_t count, std::size_t rank)
+  : ShuffleAlgorithmInterface(count)
+  , rank_(rank)
+  , round_(0)
+  , rounds_per_cycle_(1)
+{
+  if (rank_ > count)
+  {
+    throw std::invalid_argument("RingAllReduceAlgorithm: rank outside of the cohort");
+  }
+
+  // ceil(log2(cohort size))
+  while ((std::size_t{1} << rounds_per_cycle_) < count + 1)
+  {
+    ++rounds_per_cycle_;
+  }
+}
+
+std::vector<std::size_t> RingAllReduceAlgorithm::GetNextOutputs()
+{
+  auto const cohort = GetCount() + 1;
+  if (cohort < 2)
+  {
+    return {};
+  }
+
+  auto const distance = std::size_t{1} << (round_ % rounds_per_cycle_);
+  ++round_;
+
+  // the peers are the cohort without this learner, which shifts the ones after it down by one
+  auto const target = (rank_ + distance) % cohort;
+  return {(target < rank_) ? target : target - 1};
+}
+
+std::size_t RingAllReduceAlgorithm::GetRoundsPerCycle() const
+{
+  return rounds_per_cycle_;
+}
+
+}  // namespace dmlf
+}  // namespace fetch
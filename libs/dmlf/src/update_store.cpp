@@ -17,7 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include <cmath>
-#include <numeric>
+#include <functional>
 #include <stdexcept>
 
 #include "dmlf/colearn/update_store.hpp"
@@ -26,21 +26,49 @@ namespace fetch {
 namespace dmlf {
 namespace colearn {
 
+namespace {
+
+constexpr std::size_t BITS_PER_WORD = 64;
+
+}  // namespace
+
+constexpr std::size_t UpdateStore::UNLIMITED_BYTES;
+
+UpdateStore::UpdateStore(std::size_t max_bytes, Resolution max_age)
+  : max_bytes_{max_bytes}
+  , max_age_{max_age}
+{}
+
+bool UpdateStore::ConsumerSet::Contains(ConsumerId consumer) const
+{
+  auto const word = consumer / BITS_PER_WORD;
+  return (word < words_.size()) && (((words_[word] >> (consumer % BITS_PER_WORD)) & 1u) != 0);
+}
+
+void UpdateStore::ConsumerSet::Insert(ConsumerId consumer)
+{
+  auto const word = consumer / BITS_PER_WORD;
+  if (word >= words_.size())
+  {
+    words_.resize(word + 1, 0);
+  }
+  words_[word] |= uint64_t{1} << (consumer % BITS_PER_WORD);
+}
+
 UpdateStore::QueueId UpdateStore::Id(Algorithm const &algo, UpdateType const &type) const
 {
   return algo + "->" + type;
 }
 
+UpdateStore::ConsumerId UpdateStore::IdOf(Consumer const &consumer)
+{
+  return consumer_ids_.emplace(consumer, consumer_ids_.size()).first->second;
+}
+
 std::size_t UpdateStore::GetUpdateCount() const
 {
   FETCH_LOCK(global_m_);
-
-  std::size_t sum = 0;
-  for (auto p : algo_map_)
-  {
-    sum += p.second.size();
-  }
-  return sum;
+  return stored_count_;
 }
 std::size_t UpdateStore::GetUpdateCount(Algorithm const &algo, UpdateType const &type) const
 {
@@ -52,7 +80,13 @@ std::size_t UpdateStore::GetUpdateCount(Algorithm const &algo, UpdateType const
   {
     return 0;
   }
-  return it->second.size();
+  return it->second.entries.size();
+}
+
+std::size_t UpdateStore::GetStoredBytes() const
+{
+  FETCH_LOCK(global_m_);
+  return stored_bytes_;
 }
 
 void UpdateStore::PushUpdate(ColearnURI const &uri, Data &&data, Metadata &&metadata)
@@ -84,75 +118,195 @@ void UpdateStore::PushUpdate(Algorithm const &algo, UpdateType type, Data &&data
                                             std::move(source), std::move(metadata));
   FETCH_LOCK(global_m_);
 
-  auto result = consumed_.emplace(newUpdate->fingerprint(), UpdateConsumers());
+  EvictStale();
 
-  if (!result.second)  // Duplicate
+  if (!received_.insert(newUpdate->fingerprint()).second)  // Duplicate
   {
     return;
   }
 
-  result.first->second.insert(newUpdate->source());
+  auto const sequence  = next_sequence_++;
+  auto const source_id = IdOf(newUpdate->source());
+  auto &     queue     = algo_map_[id];
 
-  auto queue_it = algo_map_.find(id);
-  if (queue_it == algo_map_.end())
+  Entry entry;
+  entry.update = newUpdate;
+  entry.consumed.Insert(source_id);
+  queue.entries.emplace_hint(queue.entries.end(), sequence, std::move(entry));
+
+  for (auto &unconsumed : queue.unconsumed)
   {
-    queue_it = algo_map_.emplace(id, Store{}).first;
+    auto &heap = unconsumed.second;
+    if (heap.size() >= 2 * queue.entries.size())
+    {
+      // mostly entries consumed through other criteria or evicted since, start over
+      heap = Unconsumed(queue, unconsumed.first);
+    }
+    else if (unconsumed.first != source_id)
+    {
+      heap.push(sequence);
+    }
   }
-  auto &store = queue_it->second;
 
-  store.emplace_back(newUpdate);
+  arrival_order_.push_back(Position{id, sequence});
+  ++stored_count_;
+  stored_bytes_ += newUpdate->data().size();
+
+  EvictOverCapacity();
 }
 
-UpdateStore::UpdatePtr UpdateStore::GetUpdate(Algorithm const &algo, UpdateType const &type,
-                                              Criteria criteria, Consumer consumer)
+UpdateStore::Queue &UpdateStore::PendingQueue(Algorithm const &algo, UpdateType const &type)
 {
-  QueueId id = Id(algo, type);
-  FETCH_LOCK(global_m_);
-  auto queue_it = algo_map_.find(id);
+  EvictStale();
 
-  if (queue_it == algo_map_.end() || queue_it->second.empty())
+  auto queue_it = algo_map_.find(Id(algo, type));
+  if (queue_it == algo_map_.end() || queue_it->second.entries.empty())
   {
     throw std::runtime_error("No updates of algo " + algo + " and type " + type + " in store\n");
   }
+  return queue_it->second;
+}
 
-  auto wrapped_criteria = [&criteria, &consumer, &seen = consumed_](UpdatePtr const &update) {
-    if (!consumer.empty() && seen[update->fingerprint()].count(consumer) == 1)
+UpdateStore::Heap UpdateStore::Unconsumed(Queue const &queue, ConsumerId consumer)
+{
+  std::vector<Sequence> sequences;
+  sequences.reserve(queue.entries.size());
+  for (auto const &entry : queue.entries)
+  {
+    if (!entry.second.consumed.Contains(consumer))
     {
-      return std::nan("");
+      sequences.push_back(entry.first);
     }
-    return criteria(update);
-  };
-
-  auto &store = queue_it->second;
-
-  auto it = std::max_element(store.cbegin(), store.cend(),
-                             [&wrapped_criteria](UpdatePtr const &left, UpdatePtr const &right) {
-                               double leftScore = wrapped_criteria(left);
-                               if (std::isnan(leftScore))
-                               {
-                                 return true;
-                               }
-                               double rightScore = wrapped_criteria(right);
-                               if (std::isnan(rightScore))
-                               {
-                                 return false;
-                               }
-
-                               return leftScore < rightScore;
-                             });
-
-  auto result = *it;
-  if (std::isnan(wrapped_criteria(result)))
+  }
+  return Heap{std::less<Sequence>{}, std::move(sequences)};
+}
+
+UpdateStore::Heap &UpdateStore::UnconsumedBy(Queue &queue, ConsumerId consumer)
+{
+  auto it = queue.unconsumed.find(consumer);
+  if (it == queue.unconsumed.end())
   {
-    throw std::runtime_error("No updates of algo " + algo + " and type " + type +
-                             " matching the criteria found\n");
+    it = queue.unconsumed.emplace(consumer, Unconsumed(queue, consumer)).first;
   }
+  return it->second;
+}
 
-  if (!consumer.empty())
+UpdateStore::UpdatePtr UpdateStore::GetNewest(Queue &queue, Consumer const &consumer)
+{
+  if (consumer.empty())
   {
-    consumed_[result->fingerprint()].insert(consumer);
+    return queue.entries.rbegin()->second.update;
   }
 
+  auto const consumer_id = IdOf(consumer);
+  auto &     heap        = UnconsumedBy(queue, consumer_id);
+
+  while (!heap.empty())
+  {
+    auto entry_it = queue.entries.find(heap.top());
+    heap.pop();
+
+    if (entry_it != queue.entries.end() && !entry_it->second.consumed.Contains(consumer_id))
+    {
+      entry_it->second.consumed.Insert(consumer_id);
+      return entry_it->second.update;
+    }
+  }
+
+  return nullptr;
+}
+
+UpdateStore::UpdatePtr UpdateStore::GetBest(Queue &queue, Criteria const &criteria,
+                                            Consumer const &consumer)
+{
+  bool const has_consumer = !consumer.empty();
+  auto const consumer_id  = has_consumer ? IdOf(consumer) : ConsumerId{0};
+
+  Entry *best       = nullptr;
+  Score  best_score = 0;
+
+  for (auto &entry : queue.entries)
+  {
+    if (has_consumer && entry.second.consumed.Contains(consumer_id))
+    {
+      continue;
+    }
+
+    auto const score = criteria(entry.second.update);
+    if (std::isnan(score) || ((best != nullptr) && !(best_score < score)))
+    {
+      continue;
+    }
+
+    best       = &entry.second;
+    best_score = score;
+  }
+
+  if (best == nullptr)
+  {
+    return nullptr;
+  }
+
+  if (has_consumer)
+  {
+    best->consumed.Insert(consumer_id);
+  }
+  return best->update;
+}
+
+void UpdateStore::EvictFront()
+{
+  auto const &position = arrival_order_.front();
+  auto &      entries  = algo_map_[position.queue].entries;
+  auto        entry_it = entries.find(position.sequence);
+
+  stored_bytes_ -= entry_it->second.update->data().size();
+  --stored_count_;
+
+  entries.erase(entry_it);
+  arrival_order_.pop_front();
+}
+
+void UpdateStore::EvictStale()
+{
+  if (max_age_ <= Resolution::zero())
+  {
+    return;
+  }
+
+  while (!arrival_order_.empty())
+  {
+    auto const &position = arrival_order_.front();
+    auto const &entries  = algo_map_[position.queue].entries;
+    if (entries.at(position.sequence).update->TimeSinceCreation() <= max_age_)
+    {
+      break;
+    }
+    EvictFront();
+  }
+}
+
+void UpdateStore::EvictOverCapacity()
+{
+  // the newest update is kept even if it is larger than the store on its own
+  while ((max_bytes_ != UNLIMITED_BYTES) && (stored_bytes_ > max_bytes_) &&
+         (arrival_order_.size() > 1))
+  {
+    EvictFront();
+  }
+}
+
+UpdateStore::UpdatePtr UpdateStore::GetUpdate(Algorithm const &algo, UpdateType const &type,
+                                              Criteria criteria, Consumer consumer)
+{
+  FETCH_LOCK(global_m_);
+
+  auto result = GetBest(PendingQueue(algo, type), criteria, consumer);
+  if (!result)
+  {
+    throw std::runtime_error("No updates of algo " + algo + " and type " + type +
+                             " matching the criteria found\n");
+  }
   return result;
 }
 
@@ -190,7 +344,15 @@ UpdateStore::UpdatePtr UpdateStore::GetUpdate(ColearnURI const &uri, Consumer co
 UpdateStore::UpdatePtr UpdateStore::GetUpdate(Algorithm const &algo, UpdateType const &type,
                                               Consumer consumer)
 {
-  return GetUpdate(algo, type, Lifo, consumer);
+  FETCH_LOCK(global_m_);
+
+  auto result = GetNewest(PendingQueue(algo, type), consumer);
+  if (!result)
+  {
+    throw std::runtime_error("No updates of algo " + algo + " and type " + type +
+                             " matching the criteria found\n");
+  }
+  return result;
 }
 
 }  // namespace colearn
@@ -27,9 +27,9 @@ using Status = vm::IoObserverInterface::Status;
 
 Status VmState::Read(const std::string &key, void *data, uint64_t &size)
 {
-  auto it = store_.find(key);
+  auto it = store_->find(key);
 
-  if (it == store_.end())
+  if (it == store_->end())
   {
     return Status::PERMISSION_DENIED;
   }
@@ -49,34 +49,54 @@ Status VmState::Read(const std::string &key, void *data, uint64_t &size)
 
 Status VmState::Write(const std::string &key, const void *data, uint64_t size)
 {
-  store_[key] = Buffer(reinterpret_cast<Buffer::ValueType const *>(data), size);
+  WritableStore()[key] = Buffer(reinterpret_cast<Buffer::ValueType const *>(data), size);
   return Status::OK;
 }
 
 Status VmState::Exists(const std::string &key)
 {
-  auto i = store_.find(key);
+  auto i = store_->find(key);
 
-  if (i == store_.end())
+  if (i == store_->end())
   {
     return Status::ERROR;
   }
   return Status::OK;
 }
 
+/**
+ * @return A copy of the state, sharing the stored values until either of them is written to
+ */
+VmState VmState::Snapshot() const
+{
+  VmState snapshot;
+  snapshot.store_ = store_;
+  return snapshot;
+}
+
 VmState VmState::DeepCopy() const
 {
   VmState newCopy;
 
-  for (auto const &i : store_)
+  for (auto const &i : *store_)
   {
     auto const &name = i.first;
     auto const &buff = i.second;
-    newCopy.store_.emplace(name, buff.Copy());
+    newCopy.store_->emplace(name, buff.Copy());
   }
 
   return newCopy;
 }
 
+VmState::Store &VmState::WritableStore()
+{
+  // stored buffers are never modified in place, so the copy can share them
+  if (store_.use_count() > 1)
+  {
+    store_ = std::make_shared<Store>(*store_);
+  }
+  return *store_;
+}
+
 }  // namespace dmlf
 }  // namespace fetch
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "dmlf/ring_all_reduce_algorithm.hpp"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace fetch {
+namespace dmlf {
+
+namespace {
+
+using Algorithms = std::vector<std::unique_ptr<RingAllReduceAlgorithm>>;
+
+Algorithms MakeCohort(std::size_t size)
+{
+  Algorithms algorithms;
+  for (std::size_t rank = 0; rank < size; ++rank)
+  {
+    algorithms.emplace_back(std::make_unique<RingAllReduceAlgorithm>(size - 1, rank));
+  }
+  return algorithms;
+}
+
+std::size_t ToRank(std::size_t sender, std::size_t peer_index)
+{
+  return (peer_index < sender) ? peer_index : peer_index + 1;
+}
+
+}  // namespace
+
+TEST(RingAllReduceAlgorithm, oneOutputPerRound)
+{
+  auto algorithms = MakeCohort(6);
+
+  for (std::size_t round = 0; round < 10; ++round)
+  {
+    std::vector<std::size_t> received(algorithms.size(), 0);
+    for (std::size_t rank = 0; rank < algorithms.size(); ++rank)
+    {
+      auto const outputs = algorithms[rank]->GetNextOutputs();
+      ASSERT_EQ(outputs.size(), 1);
+      ASSERT_LT(outputs[0], algorithms[rank]->GetCount());
+      ++received[ToRank(rank, outputs[0])];
+    }
+
+    for (auto count : received)
+    {
+      EXPECT_EQ(count, 1);
+    }
+  }
+}
+
+TEST(RingAllReduceAlgorithm, everyUpdateReachesEveryLearnerInACycle)
+{
+  for (std::size_t size = 2; size <= 33; ++size)
+  {
+    auto algorithms = MakeCohort(size);
+    auto rounds     = algorithms[0]->GetRoundsPerCycle();
+
+    // the updates every learner has folded in so far
+    std::vector<std::set<std::size_t>> known(size);
+    for (std::size_t rank = 0; rank < size; ++rank)
+    {
+      known[rank].insert(rank);
+    }
+
+    for (std::size_t round = 0; round < rounds; ++round)
+    {
+      auto sent = known;
+      for (std::size_t rank = 0; rank < size; ++rank)
+      {
+        auto const target = ToRank(rank, algorithms[rank]->GetNextOutputs()[0]);
+        known[target].insert(sent[rank].begin(), sent[rank].end());
+      }
+    }
+
+    for (auto const &updates : known)
+    {
+      EXPECT_EQ(updates.size(), size);
+    }
+  }
+}
+
+TEST(RingAllReduceAlgorithm, noPeers)
+{
+  RingAllReduceAlgorithm algorithm(0, 0);
+  EXPECT_TRUE(algorithm.GetNextOutputs().empty());
+  EXPECT_THROW(RingAllReduceAlgorithm(2, 3), std::invalid_argument);
+}
+
+}  // namespace dmlf
+}  // namespace fetch
@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/main_serializer.hpp"
+#include "dmlf/colearn/update_encoding.hpp"
+#include "dmlf/deprecated/update.hpp"
+#include "gtest/gtest.h"
+#include "math/tensor/tensor.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace fetch {
+namespace dmlf {
+namespace colearn {
+
+namespace {
+
+using TensorType   = fetch::math::Tensor<float>;
+using VectorTensor = std::vector<TensorType>;
+using Encoder      = UpdateEncoder<TensorType>;
+
+TensorType MakeTensor(std::vector<float> const &values)
+{
+  TensorType tensor({2, values.size() / 2});
+  auto       it = tensor.begin();
+  for (auto value : values)
+  {
+    *it = value;
+    ++it;
+  }
+  return tensor;
+}
+
+std::vector<float> Values(TensorType const &tensor)
+{
+  std::vector<float> values;
+  for (auto it = tensor.cbegin(); it != tensor.cend(); ++it)
+  {
+    values.push_back(*it);
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(Colearn_UpdateEncoding, sparsificationSendsLargestAndKeepsResidual)
+{
+  Encoder        encoder;
+  UpdateEncoding encoding;
+  encoding.density = 0.5;
+
+  VectorTensor update{MakeTensor({1, -8, 2, 6})};
+
+  auto decoded = Encoder::Decode(encoder.Encode(update, encoding));
+  EXPECT_EQ(Values(decoded[0]), (std::vector<float>{0, -8, 0, 6}));
+
+  // the values not sent are added to the next update
+  VectorTensor next{MakeTensor({1, 0, 1, 0})};
+  decoded = Encoder::Decode(encoder.Encode(next, encoding));
+  EXPECT_EQ(Values(decoded[0]), (std::vector<float>{2, 0, 3, 0}));
+}
+
+TEST(Colearn_UpdateEncoding, quantisationErrorIsBounded)
+{
+  UpdateEncoding encoding;
+  encoding.bits = 8;
+
+  std::vector<float> values;
+  for (int i = 0; i < 100; ++i)
+  {
+    values.push_back(std::sin(static_cast<float>(i)) * 10.0f);
+  }
+
+  Encoder encoder;
+  auto    encoded = encoder.Encode({MakeTensor(values)}, encoding);
+  EXPECT_EQ(encoded[0].values.size(), values.size());
+
+  auto decoded = Values(Encoder::Decode(encoded)[0]);
+  auto step    = 20.0f / 255.0f;
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    EXPECT_NEAR(decoded[i], values[i], step);
+  }
+}
+
+TEST(Colearn_UpdateEncoding, negotiationIsLeastLossy)
+{
+  UpdateEncoding a;
+  a.density = 0.01;
+  a.bits    = 8;
+
+  UpdateEncoding b;
+  b.density = 0.1;
+  b.bits    = 16;
+
+  auto result = UpdateEncoding::Negotiate(a, b);
+  EXPECT_EQ(result.density, 0.1);
+  EXPECT_EQ(result.bits, 16);
+
+  EXPECT_TRUE(UpdateEncoding::Negotiate(a, UpdateEncoding{}).IsIdentity());
+}
+
+TEST(Colearn_UpdateEncoding, encodedUpdatesAreDecodedOnDeserialisation)
+{
+  using UpdateType = deprecated_Update<TensorType>;
+
+  UpdateEncoding encoding;
+  encoding.density = 0.5;
+  encoding.bits    = 16;
+
+  Encoder    encoder;
+  UpdateType update{VectorTensor{MakeTensor({1, -8, 2, 6})}};
+  update.Encode(encoder, encoding);
+
+  serializers::LargeObjectSerializeHelper serializer;
+  serializer << update;
+
+  UpdateType                     received;
+  serializers::MsgPackSerializer deserializer{serializer.data()};
+  deserializer >> received;
+
+  auto const values = Values(received.GetGradients()[0]);
+  EXPECT_EQ(values[0], 0);
+  EXPECT_NEAR(values[1], -8, 1e-3);
+  EXPECT_EQ(values[2], 0);
+  EXPECT_NEAR(values[3], 6, 1e-3);
+  EXPECT_EQ(received.GetFingerprint(), update.GetFingerprint());
+}
+
+}  // namespace colearn
+}  // namespace dmlf
+}  // namespace fetch
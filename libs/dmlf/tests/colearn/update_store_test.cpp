@@ -510,6 +510,77 @@ TEST(Colearn_UpdateStore, URI_pushPushPushPopPopPop_SelectMetadata)
   EXPECT_EQ(resultc->source(), "test");
 }
 
+TEST(Colearn_UpdateStore, defaultCriteria_ManyConsumers)
+{
+  UpdateStore store;
+
+  store.PushUpdate("algo", "update", ConstByteArray{a}, "test", {});
+  store.PushUpdate("algo", "update", ConstByteArray{b}, "test2", {});
+  EXPECT_EQ(store.GetUpdate("algo", "update", consumer)->data(), b);
+
+  store.PushUpdate("algo", "update", ConstByteArray{c}, "test3", {});
+  store.PushUpdate("algo", "update", ConstByteArray{d}, consumerb, {});
+
+  EXPECT_EQ(store.GetUpdate("algo", "update", consumer)->data(), d);
+  EXPECT_EQ(store.GetUpdate("algo", "update", consumer)->data(), c);
+  EXPECT_EQ(store.GetUpdate("algo", "update", consumer)->data(), a);
+  EXPECT_THROW(store.GetUpdate("algo", "update", consumer), std::runtime_error);
+
+  // the update consumerb sent is not given back to it
+  EXPECT_EQ(store.GetUpdate("algo", "update", consumerb)->data(), c);
+  EXPECT_EQ(store.GetUpdate("algo", "update", LifoCriteria, consumerb)->data(), b);
+  EXPECT_EQ(store.GetUpdate("algo", "update", consumerb)->data(), a);
+  EXPECT_THROW(store.GetUpdate("algo", "update", consumerb), std::runtime_error);
+
+  EXPECT_EQ(store.GetUpdate("algo", "update", "")->data(), d);
+  EXPECT_EQ(store.GetUpdateCount(), 4);
+}
+
+TEST(Colearn_UpdateStore, evictOldestOverCapacity)
+{
+  UpdateStore store(2);
+
+  store.PushUpdate("algo", "update", ConstByteArray{a}, "test", {});
+  store.PushUpdate("algo", "other", ConstByteArray{b}, "test", {});
+  EXPECT_EQ(store.GetUpdateCount(), 2);
+  EXPECT_EQ(store.GetStoredBytes(), 2);
+
+  store.PushUpdate("algo", "update", ConstByteArray{c}, "test", {});
+  EXPECT_EQ(store.GetUpdateCount(), 2);
+  EXPECT_EQ(store.GetUpdateCount("algo", "update"), 1);
+  EXPECT_EQ(store.GetUpdateCount("algo", "other"), 1);
+
+  EXPECT_EQ(store.GetUpdate("algo", "update", consumer)->data(), c);
+  EXPECT_THROW(store.GetUpdate("algo", "update", consumer), std::runtime_error);
+
+  // evicted updates are still recognised as duplicates
+  store.PushUpdate("algo", "update", ConstByteArray{a}, "test", {});
+  EXPECT_EQ(store.GetUpdateCount(), 2);
+  EXPECT_EQ(store.GetUpdateCount("algo", "update"), 1);
+
+  store.PushUpdate("algo", "update", ConstByteArray{"large"}, "test", {});
+  EXPECT_EQ(store.GetUpdateCount(), 1);
+  EXPECT_EQ(store.GetStoredBytes(), 5);
+  EXPECT_THROW(store.GetUpdate("algo", "other", consumer), std::runtime_error);
+}
+
+TEST(Colearn_UpdateStore, evictStale)
+{
+  UpdateStore store(UpdateStore::UNLIMITED_BYTES, std::chrono::milliseconds(50));
+
+  store.PushUpdate("algo", "update", ConstByteArray{a}, "test", {});
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  store.PushUpdate("algo", "update", ConstByteArray{b}, "test", {});
+
+  EXPECT_EQ(store.GetUpdateCount(), 1);
+  EXPECT_EQ(store.GetUpdate("algo", "update", consumer)->data(), b);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_THROW(store.GetUpdate("algo", "update", consumerb), std::runtime_error);
+  EXPECT_EQ(store.GetUpdateCount(), 0);
+  EXPECT_EQ(store.GetStoredBytes(), 0);
+}
+
 }  // namespace colearn
 }  // namespace dmlf
 }  // namespace fetch
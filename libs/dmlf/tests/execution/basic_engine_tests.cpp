@@ -25,6 +25,7 @@
 #include "vectorise/fixed_point/fixed_point.hpp"
 
 #include <limits>
+#include <thread>
 #include <vector>
 
 #include "core/byte_array/const_byte_array.hpp"
@@ -991,6 +992,57 @@ TEST(BasicVmEngineDmlfTests, Tick_Tick_CopyState)
   EXPECT_EQ(result.output().As<int>(), 4);
 }
 
+TEST(BasicVmEngineDmlfTests, Tick_ParallelCopiedStates)
+{
+  BasicVmEngine engine;
+
+  ExecutionResult createdProgram = engine.CreateExecutable("tick", {{"etch", tick}});
+  EXPECT_TRUE(createdProgram.succeeded());
+
+  ExecutionResult createdState = engine.CreateState("state");
+  EXPECT_TRUE(createdState.succeeded());
+
+  ExecutionResult result = engine.Run("tick", "state", "main", Params{});
+  EXPECT_TRUE(result.succeeded());
+
+  std::size_t const numThreads = 4;
+  std::size_t const numRuns    = 20;
+
+  std::vector<std::vector<int>> outputs(numThreads);
+  std::vector<std::thread>      threads;
+  for (std::size_t i = 0; i < numThreads; ++i)
+  {
+    auto const stateName = "state" + std::to_string(i);
+    EXPECT_TRUE(engine.CopyState("state", stateName).succeeded());
+
+    threads.emplace_back([&engine, &outputs, i, stateName, numRuns]() {
+      for (std::size_t run = 0; run < numRuns; ++run)
+      {
+        auto runResult = engine.Run("tick", stateName, "main", Params{});
+        outputs[i].push_back(runResult.succeeded() ? runResult.output().As<int>() : -1);
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  for (auto const &output : outputs)
+  {
+    ASSERT_EQ(output.size(), numRuns);
+    for (std::size_t run = 0; run < numRuns; ++run)
+    {
+      EXPECT_EQ(output[run], static_cast<int>(run + 1));
+    }
+  }
+
+  result = engine.Run("tick", "state", "main", Params{});
+  EXPECT_TRUE(result.succeeded());
+  EXPECT_EQ(result.output().As<int>(), 1);
+}
+
 TEST(BasicVmEngineDmlfTests, CopyState_BadSrc)
 {
   BasicVmEngine engine;
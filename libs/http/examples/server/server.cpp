@@ -70,7 +70,6 @@ int main()
 
   ExampleModule module;
   HTTPServer    server(tm);
-  server.Start(8080);
 
   server.AddModule(module);
   // server.AddMiddleware(middleware::DenyAll()); //< Add this line to deny all requests unless
@@ -82,6 +81,9 @@ int main()
     std::cout << static_cast<uint16_t>(res.status()) << " " << req.uri() << std::endl;
   });
 
+  // the views and middleware must all be added before the server is started
+  server.Start(8080);
+
   tm.Start();
 
   std::cout << "HTTP server on port 8080" << std::endl;
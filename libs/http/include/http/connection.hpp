@@ -28,7 +28,9 @@
 #include "logging/logging.hpp"
 #include "network/fetch_asio.hpp"
 
-#include <deque>
+#include <cstdint>
+#include <exception>
+#include <map>
 #include <memory>
 
 namespace fetch {
@@ -38,7 +40,7 @@ class HTTPConnection : public AbstractHTTPConnection,
                        public std::enable_shared_from_this<HTTPConnection>
 {
 public:
-  using ResponseQueueType = std::deque<HTTPResponse>;
+  using ResponseQueueType = std::map<uint64_t, HTTPResponse>;
   using ConnectionType    = typename AbstractHTTPConnection::SharedType;
   using HandleType        = HTTPConnectionManager::HandleType;
   using SharedRequestType = std::shared_ptr<HTTPRequest>;
@@ -62,16 +64,24 @@ public:
     ReadHeader();
   }
 
+  /**
+   * Queue a response to be written to the connection. Requests can be evaluated concurrently, so
+   * the responses are held back until all of the responses to earlier requests have been written.
+   *
+   * @param response The response to be sent
+   */
   void Send(HTTPResponse const &response) override
   {
-    bool write_in_progress = false;
+    bool start_write = false;
     {
       FETCH_LOCK(write_mutex_);
-      write_in_progress = !write_queue_.empty();
-      write_queue_.push_back(response);
+      write_queue_.emplace(response.sequence(), response);
+
+      start_write = !write_in_progress_ && IsNextResponseReady();
+      write_in_progress_ |= start_write;
     }
 
-    if (!write_in_progress)
+    if (start_write)
     {
       Write();
     }
@@ -139,6 +149,9 @@ public:
       auto const &remote_endpoint = socket_.remote_endpoint();
       request->SetOriginatingAddress(remote_endpoint.address().to_string(), remote_endpoint.port());
 
+      // the responses must be written in the same order as the requests were received
+      request->SetSequence(next_request_sequence_++);
+
       // push the request to the main server
       manager_.PushRequest(handle_, *request);
 
@@ -180,28 +193,46 @@ public:
     Close();
   }
 
+  /**
+   * Write the next part of the outgoing stream. This is either the next chunk of the response which
+   * is being streamed, or the next response in the sequence. Only one write is in progress at any
+   * time, which allows the write buffer to be reused for the lifetime of the connection.
+   */
   void Write()
   {
-    BufferPointerType buffer_ptr =
-        std::make_shared<asio::streambuf>(std::numeric_limits<std::size_t>::max());
+    if (producer_)
+    {
+      WriteChunk();
+    }
+    else if (close_after_write_)
+    {
+      Close();
+      return;
+    }
+    else
     {
       FETCH_LOCK(write_mutex_);
-      HTTPResponse res = write_queue_.front();
-      write_queue_.pop_front();
-      res.ToStream(*buffer_ptr);
+      if (!IsNextResponseReady())
+      {
+        write_in_progress_ = false;
+        return;
+      }
+
+      auto it = write_queue_.begin();
+      it->second.ToStream(write_buffer_);
+
+      producer_          = it->second.chunk_producer();
+      close_after_write_ = (it->second.header()["connection"] == "close");
+
+      write_queue_.erase(it);
+      ++next_response_sequence_;
     }
 
     auto self = shared_from_this();
-    auto cb   = [this, self, buffer_ptr](std::error_code ec, std::size_t) {
+    auto cb   = [this, self](std::error_code ec, std::size_t) {
       if (!ec)
       {
-        bool write_more = false;
-        {
-          FETCH_LOCK(write_mutex_);
-          write_more = !write_queue_.empty();
-        }
-
-        if (is_open_ && write_more)
+        if (is_open_)
         {
           Write();
         }
@@ -212,7 +243,37 @@ public:
       }
     };
 
-    asio::async_write(socket_, *buffer_ptr, cb);
+    asio::async_write(socket_, write_buffer_, cb);
+  }
+
+  void WriteChunk()
+  {
+    byte_array::ConstByteArray chunk{};
+
+    bool more{false};
+    try
+    {
+      // empty chunks would terminate the body so they are skipped
+      do
+      {
+        more = producer_(chunk);
+      } while (more && chunk.empty());
+    }
+    catch (std::exception const &ex)
+    {
+      // the status has already been sent, so the connection is closed to signal the failure
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to stream response: ", ex.what());
+      close_after_write_ = true;
+      more               = false;
+    }
+
+    if (!more)
+    {
+      chunk     = byte_array::ConstByteArray{};
+      producer_ = nullptr;
+    }
+
+    HTTPResponse::ChunkToStream(write_buffer_, chunk);
   }
 
   void CloseConnnection() override
@@ -235,11 +296,26 @@ public:
   }
 
 private:
+  bool IsNextResponseReady() const
+  {
+    return !write_queue_.empty() && (write_queue_.begin()->first == next_response_sequence_);
+  }
+
   asio::ip::tcp::tcp::socket socket_;
   HTTPConnectionManager &    manager_;
   ResponseQueueType          write_queue_;
   Mutex                      write_mutex_;
 
+  /// @name Write State
+  /// @{
+  asio::streambuf             write_buffer_{};
+  HTTPResponse::ChunkProducer producer_{};  ///< The producer of the response being streamed
+  bool                        write_in_progress_{false};
+  bool                        close_after_write_{false};
+  uint64_t                    next_request_sequence_{0};
+  uint64_t                    next_response_sequence_{0};
+  /// @}
+
   HandleType handle_{};
   bool       is_open_ = false;
 };
@@ -21,6 +21,9 @@
 #include "http/module.hpp"
 #include "http/route.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 namespace fetch {
@@ -36,6 +39,15 @@ struct MountedView
   Route                      route;
   HTTPModule::ViewType       view;
   HTTPModule::Authenticator  authenticator;
+
+  /// @name Concurrency
+  /// @{
+  using Counter    = std::atomic<std::size_t>;
+  using CounterPtr = std::shared_ptr<Counter>;
+
+  std::size_t max_concurrency{0};  ///< The maximum number of concurrent evaluations (0 = no limit)
+  CounterPtr  active{std::make_shared<Counter>(0)};  ///< The number of evaluations in progress
+  /// @}
 };
 
 using MountedViews = std::vector<MountedView>;
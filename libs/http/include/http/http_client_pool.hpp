@@ -0,0 +1,155 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/http_client_interface.hpp"
+#include "network/fetch_asio.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace fetch {
+namespace http {
+
+class HTTPRequest;
+class HTTPResponse;
+
+/**
+ * Asynchronous HTTP client which keeps a pool of keep-alive connections to every host it talks
+ * to. The requests to a host are pipelined on the connections of its pool, and the number of
+ * requests in flight (across all of the hosts) is bounded, making a request blocks while the
+ * window is full.
+ *
+ * All of the network IO, and every callback, runs on a single thread owned by the client.
+ * Requests which were pipelined on a connection which the server closed without answering them
+ * are retried once on a new connection.
+ */
+class HttpClientPool
+{
+public:
+  static constexpr char const *LOGGING_NAME = "HttpClientPool";
+
+  /// Called with the response once a request completes, success is false if it failed
+  using Callback = std::function<void(bool success, HTTPResponse const &response)>;
+
+  struct Config
+  {
+    std::size_t connections_per_host{4};  ///< The maximum size of the pool of each host
+    std::size_t pipeline_depth{8};        ///< The maximum requests in flight on a connection
+    std::size_t max_in_flight{64};        ///< The maximum requests in flight overall
+  };
+
+  // Construction / Destruction
+  HttpClientPool();
+  explicit HttpClientPool(Config const &config);
+  HttpClientPool(HttpClientPool const &) = delete;
+  HttpClientPool(HttpClientPool &&)      = delete;
+  ~HttpClientPool();
+
+  /// @name Requests
+  /// @{
+  void Request(std::string const &host, uint16_t port, HTTPRequest const &request,
+               Callback callback);
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  std::size_t in_flight() const;
+  std::size_t connections_opened() const;
+  /// @}
+
+  // Operators
+  HttpClientPool &operator=(HttpClientPool const &) = delete;
+  HttpClientPool &operator=(HttpClientPool &&) = delete;
+
+private:
+  struct Pending;
+  struct Host;
+  class Connection;
+
+  using PendingPtr    = std::shared_ptr<Pending>;
+  using ConnectionPtr = std::shared_ptr<Connection>;
+  using HostPtr       = std::shared_ptr<Host>;
+  using Hosts         = std::unordered_map<std::string, HostPtr>;
+  using IoService     = asio::io_service;
+  using Work          = std::unique_ptr<IoService::work>;
+
+  /// @name IO Thread
+  /// @{
+  void Dispatch(HostPtr const &host);
+  void Finished(PendingPtr const &pending, bool success, HTTPResponse const &response);
+  void Closed(ConnectionPtr const &connection);
+  void Shutdown();
+  /// @}
+
+  Config const config_;
+
+  IoService                io_service_;
+  Work                     work_;
+  Hosts                    hosts_;
+  bool                     stopping_{false};
+  std::atomic<std::size_t> connections_opened_{0};
+
+  mutable std::mutex      window_mutex_;
+  std::condition_variable window_cv_;
+  std::size_t             in_flight_{0};
+
+  std::thread thread_;
+};
+
+/**
+ * Blocking HTTP client for a single host which makes its requests through a (shared) client pool,
+ * so that it can be used where an HttpClientInterface is expected. Requests must not be made from
+ * the callbacks of the pool.
+ */
+class PooledHttpClient : public HttpClientInterface
+{
+public:
+  using PoolPtr = std::shared_ptr<HttpClientPool>;
+
+  // Construction / Destruction
+  PooledHttpClient(PoolPtr pool, std::string host, uint16_t port);
+  ~PooledHttpClient() override = default;
+
+  /// @name Accessors
+  /// @{
+  std::string const &host() const;
+  uint16_t           port() const;
+  /// @}
+
+  /// @name Http Client Interface
+  /// @{
+  bool Request(HTTPRequest const &request, HTTPResponse &response) override;
+  /// @}
+
+private:
+  PoolPtr     pool_;
+  std::string host_;
+  uint16_t    port_;
+};
+
+}  // namespace http
+}  // namespace fetch
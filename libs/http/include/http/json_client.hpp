@@ -55,6 +55,7 @@ public:
   // Construction / Destruction
   JsonClient(ConnectionMode mode, std::string host);
   JsonClient(ConnectionMode mode, std::string host, uint16_t port);
+  explicit JsonClient(std::unique_ptr<HttpClientInterface> client);
   JsonClient(JsonClient const &) = delete;
   JsonClient(JsonClient && /*client*/) noexcept;
   ~JsonClient();
@@ -172,6 +172,21 @@ public:
     return auth_level_;
   }
 
+  /// @name Connection
+  /// @{
+  bool keep_alive() const;
+
+  uint64_t sequence() const
+  {
+    return sequence_;
+  }
+
+  void SetSequence(uint64_t sequence)
+  {
+    sequence_ = sequence;
+  }
+  /// @}
+
 private:
   bool ParseStartLine(byte_array::ByteArray &line);
 
@@ -192,6 +207,7 @@ private:
   bool is_valid_ = true;
 
   std::size_t content_length_ = 0;
+  uint64_t    sequence_{0};  ///< The position of the request on its connection
 
   /// @name Metadata
   /// @{
@@ -24,6 +24,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -34,6 +35,9 @@ namespace http {
 class HTTPResponse : public std::enable_shared_from_this<HTTPResponse>
 {
 public:
+  /// Fills the next chunk of a streamed body, returning false once the body is complete
+  using ChunkProducer = std::function<bool(byte_array::ConstByteArray &)>;
+
   explicit HTTPResponse(byte_array::ConstByteArray body = {},
                         MimeType mime = {".html", "text/html"}, Status status = Status::SUCCESS_OK)
     : body_(std::move(body))
@@ -48,6 +52,8 @@ public:
   bool ParseBody(asio::streambuf &buffer, std::size_t length);
   bool ToStream(asio::streambuf &buffer) const;
 
+  static void ChunkToStream(asio::streambuf &buffer, byte_array::ConstByteArray const &chunk);
+
   byte_array::ConstByteArray const &body() const
   {
     return body_;
@@ -75,6 +81,46 @@ public:
     body_ = body;
   }
 
+  /// @name Streaming
+  /// @{
+
+  /**
+   * Stream the body of the response with chunked transfer encoding, rather than sending it in one
+   * piece. The producer is called from the network thread each time the previous chunk has been
+   * written, so that only one chunk of the body is held in memory at a time.
+   *
+   * @param producer The producer of the chunks of the body
+   */
+  void SetChunkProducer(ChunkProducer producer)
+  {
+    body_     = byte_array::ConstByteArray{};
+    producer_ = std::move(producer);
+  }
+
+  bool is_chunked() const
+  {
+    return static_cast<bool>(producer_);
+  }
+
+  ChunkProducer const &chunk_producer() const
+  {
+    return producer_;
+  }
+  /// @}
+
+  /// @name Connection
+  /// @{
+  uint64_t sequence() const
+  {
+    return sequence_;
+  }
+
+  void SetSequence(uint64_t sequence)
+  {
+    sequence_ = sequence;
+  }
+  /// @}
+
 private:
   bool ParseFirstLine(char const *begin, char const *end);
   bool ParseHeaderLine(std::size_t line_idx, char const *begin, char const *end);
@@ -83,6 +129,8 @@ private:
   MimeType                   mime_;
   Status                     status_;
   Header                     header_;
+  ChunkProducer              producer_{};
+  uint64_t                   sequence_{0};  ///< The position of the request being responded to
 };
 }  // namespace http
 }  // namespace fetch
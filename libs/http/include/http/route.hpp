@@ -44,12 +44,12 @@ public:
   using ParameterList  = std::vector<byte_array::ConstByteArray>;
   using ValidatorMap   = std::unordered_map<byte_array::ConstByteArray, validators::Validator>;
 
-  bool Match(byte_array::ConstByteArray const &path, ViewParameters &params)
+  bool Match(byte_array::ConstByteArray const &path, ViewParameters &params) const
   {
     std::size_t i = 0;
     params.Clear();
 
-    for (auto &m : match_)
+    for (auto const &m : match_)
     {
       if (!m(i, path, params))
       {
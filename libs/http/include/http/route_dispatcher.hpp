@@ -0,0 +1,90 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "http/method.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace http {
+
+/**
+ * Narrows down the views which could match a request, so that only a handful of routes need to be
+ * evaluated rather than every one which has been registered.
+ *
+ * The routes of each method are compiled into a tree keyed by the literal path segments which
+ * precede the first parameter of the route. Routes without any parameters are instead looked up
+ * directly by their full path. A lookup walks the segments of the requested path through the tree
+ * in a single pass, collecting the routes stored along the way.
+ *
+ * The candidates are returned in the order in which they were registered, so that the first
+ * matching route continues to take precedence.
+ */
+class RouteDispatcher
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Index          = std::size_t;
+  using Indices        = std::vector<Index>;
+
+  // Construction / Destruction
+  RouteDispatcher()                        = default;
+  RouteDispatcher(RouteDispatcher const &) = delete;
+  RouteDispatcher(RouteDispatcher &&)      = delete;
+  ~RouteDispatcher()                       = default;
+
+  /// @name Routes
+  /// @{
+  void    Add(Method method, ConstByteArray const &pattern, Index index);
+  Indices Lookup(Method method, ConstByteArray const &path) const;
+  /// @}
+
+  // Operators
+  RouteDispatcher &operator=(RouteDispatcher const &) = delete;
+  RouteDispatcher &operator=(RouteDispatcher &&) = delete;
+
+private:
+  struct Node
+  {
+    using Children = std::unordered_map<ConstByteArray, std::unique_ptr<Node>>;
+
+    Children children{};
+    Indices  routes{};  ///< The routes whose literal segments end at this node
+  };
+
+  struct Table
+  {
+    using ExactRoutes = std::unordered_map<ConstByteArray, Indices>;
+
+    ExactRoutes exact{};  ///< The routes without any parameters, keyed by their path
+    Node        root{};
+  };
+
+  using Tables = std::map<Method, Table>;
+
+  Tables tables_{};
+};
+
+}  // namespace http
+}  // namespace fetch
@@ -28,13 +28,17 @@
 #include "http/request.hpp"
 #include "http/response.hpp"
 #include "http/route.hpp"
+#include "http/route_dispatcher.hpp"
 #include "http/status.hpp"
 #include "http/tagged_tree.hpp"
 #include "logging/logging.hpp"
+#include "network/details/thread_pool.hpp"
 #include "network/fetch_asio.hpp"
 #include "network/management/network_manager.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <functional>
@@ -42,6 +46,7 @@
 #include <memory>
 #include <mutex>
 #include <new>
+#include <stdexcept>
 #include <system_error>
 #include <utility>
 #include <vector>
@@ -63,11 +68,17 @@ public:
   using ViewType           = MountedView::ViewType;
   using Authenticator      = MountedView::Authenticator;
   using ResponseMiddleware = std::function<void(HTTPResponse &, HTTPRequest const &)>;
+  using ThreadPool         = network::ThreadPool;
 
   static constexpr char const *LOGGING_NAME = "HTTPServer";
 
-  explicit HTTPServer(NetworkManager const &network_manager)
-    : networkManager_(network_manager)
+  /// The default number of worker threads on which the views are evaluated
+  static constexpr std::size_t DEFAULT_NUM_WORKERS = 8;
+
+  explicit HTTPServer(NetworkManager const &network_manager,
+                      std::size_t          num_workers = DEFAULT_NUM_WORKERS)
+    : workers_{network::MakeThreadPool(num_workers, "HTTPServer")}
+    , networkManager_(network_manager)
   {}
 
   HTTPServer(HTTPServer &&)      = delete;
@@ -75,6 +86,9 @@ public:
 
   virtual ~HTTPServer()
   {
+    // no further views can be evaluated once the workers have stopped
+    workers_->Stop();
+
     auto socketWeak = socket_;
     auto accepWeak  = acceptor_;
 
@@ -104,6 +118,10 @@ public:
 
   void Start(uint16_t port)
   {
+    // the views and middleware are immutable from this point, so they can be read without locking
+    started_ = true;
+    workers_->Start();
+
     std::weak_ptr<ConnectionManager> &manager   = manager_;
     std::weak_ptr<Socket> &           socRef    = socket_;
     std::weak_ptr<Acceptor> &         accepRef  = acceptor_;
@@ -148,7 +166,9 @@ public:
   }
 
   void Stop()
-  {}
+  {
+    workers_->Stop();
+  }
 
   void PushRequest(HandleType client, HTTPRequest req) override
   {
@@ -163,12 +183,23 @@ public:
       res.AddHeader("Access-Control-Allow-Headers",
                     "Content-Type, Authorization, Content-Length, X-Requested-With");
 
-      SendToManager(client, res);
+      SendToManager(client, req, res);
       return;
     }
 
-    // TODO(issue 28): improve such that it works for multiple threads.
-    FETCH_LOCK(eval_mutex_);
+    // evaluate the request on one of the workers, so that requests are handled concurrently
+    workers_->Post([this, client, req]() mutable { EvaluateRequest(client, req); });
+  }
+
+  /**
+   * Evaluate a request against the middleware and views, sending the response to the client. This
+   * is called concurrently from each of the workers.
+   *
+   * @param client The handle of the requesting client
+   * @param req The request to be evaluated
+   */
+  void EvaluateRequest(HandleType client, HTTPRequest &req)
+  {
     HTTPResponse res("page not found", mime_types::GetMimeTypeFromExtension(".html"),
                      Status::CLIENT_ERROR_NOT_FOUND);
 
@@ -182,15 +213,11 @@ public:
         m(req);
       }
 
-      // finding the view that matches the URL
+      // finding the view that matches the URL, from the handful of candidates for its path
       ViewParameters params;
-      for (auto &v : views_)
+      for (auto const index : dispatcher_.Lookup(req.method(), req.uri()))
       {
-        // skip all views that don't match the required method
-        if (v.method != req.method())
-        {
-          continue;
-        }
+        auto const &v = views_[index];
 
         if (v.route.Match(req.uri(), params))
         {
@@ -200,10 +227,20 @@ public:
             res = HTTPResponse("authentication required",
                                fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
                                Status::SERVER_ERROR_NETWORK_AUTHENTICATION_REQUIRED);
-            SendToManager(client, res);
+            SendToManager(client, req, res);
             return;
           }
 
+          // expensive views are limited in the number of requests they can evaluate concurrently
+          ViewSlot const slot{v};
+          if (!slot.acquired())
+          {
+            res = HTTPResponse("server busy",
+                               fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
+                               Status::SERVER_ERROR_SERVICE_UNAVAILABLE);
+            break;
+          }
+
           // generating result
           res = v.view(params, req);
           break;
@@ -223,7 +260,7 @@ public:
       HTTPResponse response("internal error: " + std::string(e.what()),
                             fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
                             Status::SERVER_ERROR_INTERNAL_SERVER_ERROR);
-      SendToManager(client, response);
+      SendToManager(client, req, response);
       return;
     }
     catch (...)
@@ -231,11 +268,11 @@ public:
       HTTPResponse response("unknown internal error",
                             fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
                             Status::SERVER_ERROR_INTERNAL_SERVER_ERROR);
-      SendToManager(client, response);
+      SendToManager(client, req, response);
       return;
     }
 
-    SendToManager(client, res);
+    SendToManager(client, req, res);
   }
 
   // Accept static void to avoid having to create shared ptr to this class
@@ -270,11 +307,13 @@ public:
 
   void AddMiddleware(RequestMiddleware const &middleware)
   {
+    EnsureNotStarted();
     pre_view_middleware_.push_back(middleware);
   }
 
   void AddMiddleware(ResponseMiddleware const &middleware)
   {
+    EnsureNotStarted();
     post_view_middleware_.push_back(middleware);
   }
 
@@ -282,6 +321,8 @@ public:
                byte_array::ByteArray const &path, std::vector<HTTPParameter> const &parameters,
                ViewType const &view, Authenticator authenticator)
   {
+    EnsureNotStarted();
+
     auto route = Route::FromString(path);
 
     for (auto const &param : parameters)
@@ -291,6 +332,7 @@ public:
       route.AddValidator(param.name, std::move(v));
     }
 
+    dispatcher_.Add(method, path, views_.size());
     views_.push_back(
         {std::move(description), method, std::move(route), view, std::move(authenticator)});
   }
@@ -304,9 +346,37 @@ public:
     }
   }
 
+  /**
+   * Limit the number of requests which can be evaluated concurrently by a view, any requests beyond
+   * the limit are rejected as unavailable. This is intended for expensive views, which would
+   * otherwise be able to occupy all of the workers.
+   *
+   * @param method The method of the view
+   * @param path The path of the view, as it was added
+   * @param limit The maximum number of concurrent evaluations, or zero for no limit
+   * @return true if the view was found, otherwise false
+   */
+  bool SetConcurrencyLimit(Method method, byte_array::ByteArray const &path, std::size_t limit)
+  {
+    EnsureNotStarted();
+
+    auto const route = Route::FromString(path);
+
+    bool found{false};
+    for (auto &view : views_)
+    {
+      if ((view.method == method) && (view.route.path() == route.path()))
+      {
+        view.max_concurrency = limit;
+        found                = true;
+      }
+    }
+
+    return found;
+  }
+
   MountedViews views()
   {
-    FETCH_LOCK(eval_mutex_);
     return views_unsafe();
   }
 
@@ -315,8 +385,16 @@ public:
     return views_;
   }
 
-  void SendToManager(HandleType client, HTTPResponse const &res)
+  void SendToManager(HandleType client, HTTPRequest const &req, HTTPResponse res)
   {
+    // allow the connection to order the responses of pipelined requests
+    res.SetSequence(req.sequence());
+
+    if (!req.keep_alive())
+    {
+      res.AddHeader("connection", "close");
+    }
+
     std::weak_ptr<ConnectionManager> manager = manager_;
 
     networkManager_.Post([manager, client, res] {
@@ -335,10 +413,52 @@ public:
   }
 
 private:
-  Mutex eval_mutex_;
+  /**
+   * Occupies one of the concurrent evaluation slots of a view for its lifetime
+   */
+  class ViewSlot
+  {
+  public:
+    explicit ViewSlot(MountedView const &view)
+      : active_{*view.active}
+      , acquired_{(++active_ <= view.max_concurrency) || (view.max_concurrency == 0)}
+    {}
+
+    ViewSlot(ViewSlot const &) = delete;
+    ViewSlot(ViewSlot &&)      = delete;
+
+    ~ViewSlot()
+    {
+      --active_;
+    }
+
+    bool acquired() const
+    {
+      return acquired_;
+    }
+
+    ViewSlot &operator=(ViewSlot const &) = delete;
+    ViewSlot &operator=(ViewSlot &&) = delete;
+
+  private:
+    MountedView::Counter &active_;
+    bool                  acquired_;
+  };
+
+  void EnsureNotStarted() const
+  {
+    if (started_)
+    {
+      throw std::runtime_error("Views and middleware can not be changed once started");
+    }
+  }
+
+  std::atomic<bool> started_{false};
+  ThreadPool        workers_;
 
   std::vector<RequestMiddleware>  pre_view_middleware_;
   MountedViews                    views_;
+  RouteDispatcher                 dispatcher_;
   std::vector<ResponseMiddleware> post_view_middleware_;
 
   NetworkManager                   networkManager_;
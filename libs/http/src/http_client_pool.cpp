@@ -0,0 +1,759 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/set_thread_name.hpp"
+#include "http/http_client_pool.hpp"
+#include "http/request.hpp"
+#include "http/response.hpp"
+#include "logging/logging.hpp"
+#include "network/fetch_asio.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <istream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace http {
+namespace {
+
+bool IsSuccess(HTTPResponse const &response)
+{
+  auto const raw_status_code = static_cast<uint16_t>(response.status());
+
+  return (200 <= raw_status_code) && (300 > raw_status_code);
+}
+
+/**
+ * Whether the response can not have a body, regardless of its headers
+ */
+bool HasNoBody(HTTPResponse const &response)
+{
+  auto const raw_status_code = static_cast<uint16_t>(response.status());
+
+  return (raw_status_code < 200) || (raw_status_code == 204) || (raw_status_code == 304);
+}
+
+std::string ReadLine(asio::streambuf &buffer)
+{
+  std::istream stream(&buffer);
+  std::string  line;
+  std::getline(stream, line);
+
+  if (!line.empty() && (line.back() == '\r'))
+  {
+    line.pop_back();
+  }
+
+  return line;
+}
+
+}  // namespace
+
+struct HttpClientPool::Pending
+{
+  std::string data;  ///< The serialised request
+  Callback    callback;
+  bool        retried{false};
+};
+
+struct HttpClientPool::Host
+{
+  std::string                name;
+  uint16_t                   port{0};
+  std::deque<PendingPtr>     queue;
+  std::vector<ConnectionPtr> connections;
+};
+
+/**
+ * A keep-alive connection to a host. The requests assigned to the connection are written in
+ * order as soon as it is connected, and the responses are read in the same order.
+ */
+class HttpClientPool::Connection : public std::enable_shared_from_this<Connection>
+{
+public:
+  Connection(HttpClientPool &pool, HostPtr host)
+    : pool_(pool)
+    , host_(std::move(host))
+    , socket_(pool.io_service_)
+    , resolver_(pool.io_service_)
+  {}
+
+  void Open();
+  void Assign(PendingPtr pending);
+  void Close(bool announced = false);
+
+  HostPtr const &host() const
+  {
+    return host_;
+  }
+
+  std::size_t load() const
+  {
+    return pipeline_.size();
+  }
+
+  bool is_closed() const
+  {
+    return closed_;
+  }
+
+private:
+  using Socket   = asio::ip::tcp::socket;
+  using Resolver = Socket::protocol_type::resolver;
+
+  void WriteNext();
+  void ReadNext();
+  void ReadBody(std::size_t length);
+  void ReadChunk();
+  void ReadTrailer();
+  void ReadToEnd();
+  void Complete();
+  void Fail(std::string const &reason);
+
+  HttpClientPool &       pool_;
+  HostPtr                host_;
+  Socket                 socket_;
+  Resolver               resolver_;
+  std::deque<PendingPtr> pipeline_;          ///< Assigned requests which are not answered yet
+  std::size_t            written_{0};        ///< The number of the requests which are written
+  bool                   connected_{false};
+  bool                   closed_{false};
+  bool                   writing_{false};
+  bool                   write_failed_{false};
+  bool                   reading_{false};
+  bool                   keep_alive_{true};
+  asio::streambuf        input_;
+  HTTPResponse           response_;
+  std::string            chunked_body_;
+};
+
+void HttpClientPool::Connection::Open()
+{
+  auto self = shared_from_this();
+
+  Resolver::query query{host_->name, std::to_string(host_->port)};
+  resolver_.async_resolve(query, [this, self](std::error_code const &ec,
+                                              Resolver::iterator endpoints) {
+    if (closed_)
+    {
+      return;
+    }
+
+    if (ec)
+    {
+      Fail("Unable to resolve host: " + ec.message());
+      return;
+    }
+
+    asio::async_connect(socket_, endpoints,
+                        [this, self](std::error_code const &ec, Resolver::iterator /*endpoint*/) {
+                          if (closed_)
+                          {
+                            return;
+                          }
+
+                          if (ec)
+                          {
+                            Fail("Unable to establish a connection: " + ec.message());
+                            return;
+                          }
+
+                          connected_ = true;
+                          WriteNext();
+                        });
+  });
+}
+
+void HttpClientPool::Connection::Assign(PendingPtr pending)
+{
+  pipeline_.emplace_back(std::move(pending));
+  WriteNext();
+}
+
+/**
+ * Close the connection. The requests which are not answered are handed back to the host, to be
+ * made on another connection
+ *
+ * @param announced Whether the server announced that it closes the connection, in which case it
+ * has not processed any of the requests which are not answered
+ */
+void HttpClientPool::Connection::Close(bool announced)
+{
+  if (closed_)
+  {
+    return;
+  }
+
+  closed_ = true;
+
+  std::error_code ec;
+  resolver_.cancel();
+  socket_.shutdown(Socket::shutdown_both, ec);
+  socket_.close(ec);
+
+  // requests which have been written may have been seen by the server, they are retried only once
+  for (std::size_t i = pipeline_.size(); i > 0; --i)
+  {
+    auto &     pending = pipeline_[i - 1];
+    bool const seen    = !announced && (i <= written_);
+
+    if (!seen || !pending->retried)
+    {
+      pending->retried = pending->retried || seen;
+      host_->queue.emplace_front(std::move(pending));
+    }
+    else
+    {
+      pool_.Finished(pending, false, HTTPResponse{});
+    }
+  }
+
+  pipeline_.clear();
+  written_ = 0;
+
+  pool_.Closed(shared_from_this());
+}
+
+void HttpClientPool::Connection::WriteNext()
+{
+  if (!connected_ || closed_ || writing_ || write_failed_ || (written_ >= pipeline_.size()))
+  {
+    return;
+  }
+
+  writing_ = true;
+
+  auto self    = shared_from_this();
+  auto pending = pipeline_[written_];
+
+  asio::async_write(socket_, asio::buffer(pending->data),
+                    [this, self, pending](std::error_code const &ec, std::size_t /*length*/) {
+                      writing_ = false;
+
+                      if (closed_)
+                      {
+                        return;
+                      }
+
+                      // the server may have closed the connection after a response which has not
+                      // been read yet, which is read before the connection is given up on
+                      if (ec && (written_ > 0))
+                      {
+                        write_failed_ = true;
+                        return;
+                      }
+
+                      if (ec)
+                      {
+                        Fail("Failed to send request: " + ec.message());
+                        return;
+                      }
+
+                      ++written_;
+                      ReadNext();
+                      WriteNext();
+                    });
+}
+
+void HttpClientPool::Connection::ReadNext()
+{
+  if (closed_ || reading_ || (written_ == 0))
+  {
+    return;
+  }
+
+  reading_ = true;
+
+  auto self = shared_from_this();
+  asio::async_read_until(
+      socket_, input_, "\r\n\r\n", [this, self](std::error_code const &ec, std::size_t length) {
+        if (closed_)
+        {
+          return;
+        }
+
+        if (ec)
+        {
+          Fail("Failed to receive response header: " + ec.message());
+          return;
+        }
+
+        // will consume the length of the header from the buffer
+        response_ = HTTPResponse{};
+        if (!response_.ParseHeader(input_, length))
+        {
+          Fail("Invalid response header");
+          return;
+        }
+
+        auto const &header = response_.header();
+        if (header["connection"] == "close")
+        {
+          keep_alive_ = false;
+        }
+
+        if (HasNoBody(response_))
+        {
+          response_.SetBody({});
+          Complete();
+        }
+        else if (header["transfer-encoding"] == "chunked")
+        {
+          chunked_body_.clear();
+          ReadChunk();
+        }
+        else if (header.Has("content-length"))
+        {
+          auto const content_length = static_cast<std::string>(header["content-length"]);
+
+          ReadBody(static_cast<std::size_t>(std::strtoull(content_length.c_str(), nullptr, 10)));
+        }
+        else
+        {
+          ReadToEnd();
+        }
+      });
+}
+
+void HttpClientPool::Connection::ReadBody(std::size_t length)
+{
+  if (input_.size() >= length)
+  {
+    response_.ParseBody(input_, length);
+    Complete();
+    return;
+  }
+
+  auto self = shared_from_this();
+  asio::async_read(socket_, input_, asio::transfer_exactly(length - input_.size()),
+                   [this, self, length](std::error_code const &ec, std::size_t /*length*/) {
+                     if (closed_)
+                     {
+                       return;
+                     }
+
+                     if (ec)
+                     {
+                       Fail("Failed to receive response body: " + ec.message());
+                       return;
+                     }
+
+                     response_.ParseBody(input_, length);
+                     Complete();
+                   });
+}
+
+void HttpClientPool::Connection::ReadChunk()
+{
+  auto self = shared_from_this();
+  asio::async_read_until(
+      socket_, input_, "\r\n", [this, self](std::error_code const &ec, std::size_t /*length*/) {
+        if (closed_)
+        {
+          return;
+        }
+
+        if (ec)
+        {
+          Fail("Failed to receive chunk: " + ec.message());
+          return;
+        }
+
+        // chunk extensions, if any, are ignored by the conversion
+        auto const size =
+            static_cast<std::size_t>(std::strtoull(ReadLine(input_).c_str(), nullptr, 16));
+
+        if (size == 0)
+        {
+          ReadTrailer();
+          return;
+        }
+
+        // the chunk is followed by a line break
+        auto const consume = [this, size]() {
+          auto const data = input_.data();
+          chunked_body_.append(asio::buffers_begin(data),
+                               asio::buffers_begin(data) + static_cast<std::ptrdiff_t>(size));
+          input_.consume(size + 2);
+          ReadChunk();
+        };
+
+        if (input_.size() >= size + 2)
+        {
+          consume();
+          return;
+        }
+
+        asio::async_read(socket_, input_, asio::transfer_exactly(size + 2 - input_.size()),
+                         [this, self, consume](std::error_code const &ec, std::size_t /*length*/) {
+                           if (closed_)
+                           {
+                             return;
+                           }
+
+                           if (ec)
+                           {
+                             Fail("Failed to receive chunk: " + ec.message());
+                             return;
+                           }
+
+                           consume();
+                         });
+      });
+}
+
+void HttpClientPool::Connection::ReadTrailer()
+{
+  auto self = shared_from_this();
+  asio::async_read_until(
+      socket_, input_, "\r\n", [this, self](std::error_code const &ec, std::size_t /*length*/) {
+        if (closed_)
+        {
+          return;
+        }
+
+        if (ec)
+        {
+          Fail("Failed to receive chunk trailer: " + ec.message());
+          return;
+        }
+
+        // the trailer ends with an empty line
+        if (!ReadLine(input_).empty())
+        {
+          ReadTrailer();
+          return;
+        }
+
+        response_.SetBody(byte_array::ConstByteArray{chunked_body_});
+        Complete();
+      });
+}
+
+/**
+ * Read a response without a length, its body is delimited by the server closing the connection
+ */
+void HttpClientPool::Connection::ReadToEnd()
+{
+  keep_alive_ = false;
+
+  auto self = shared_from_this();
+  asio::async_read(socket_, input_, asio::transfer_all(),
+                   [this, self](std::error_code const &ec, std::size_t /*length*/) {
+                     if (closed_)
+                     {
+                       return;
+                     }
+
+                     if (ec && (ec != asio::error::eof))
+                     {
+                       Fail("Failed to receive response body: " + ec.message());
+                       return;
+                     }
+
+                     response_.ParseBody(input_, input_.size());
+                     Complete();
+                   });
+}
+
+void HttpClientPool::Connection::Complete()
+{
+  auto pending = std::move(pipeline_.front());
+  pipeline_.pop_front();
+  --written_;
+  reading_ = false;
+
+  pool_.Finished(pending, IsSuccess(response_), response_);
+
+  if (!keep_alive_)
+  {
+    Close(true);
+    return;
+  }
+
+  if (write_failed_ && (written_ == 0))
+  {
+    Fail("Failed to send request");
+    return;
+  }
+
+  ReadNext();
+  pool_.Dispatch(host_);
+}
+
+void HttpClientPool::Connection::Fail(std::string const &reason)
+{
+  FETCH_LOG_WARN(LOGGING_NAME, "Connection to ", host_->name, ':', host_->port, " failed. ",
+                 reason);
+
+  // a host which can not be connected to fails its requests, rather than reconnecting forever
+  if (!connected_)
+  {
+    for (auto const &pending : pipeline_)
+    {
+      pool_.Finished(pending, false, HTTPResponse{});
+    }
+
+    pipeline_.clear();
+    written_ = 0;
+  }
+
+  Close();
+}
+
+/**
+ * Construct a client pool with the default configuration
+ */
+HttpClientPool::HttpClientPool()
+  : HttpClientPool(Config{})
+{}
+
+/**
+ * Construct a client pool
+ *
+ * @param config The limits of the pool
+ */
+HttpClientPool::HttpClientPool(Config const &config)
+  : config_(config)
+  , work_(std::make_unique<IoService::work>(io_service_))
+{
+  thread_ = std::thread([this]() {
+    SetThreadName(LOGGING_NAME);
+    io_service_.run();
+  });
+}
+
+/**
+ * Closes every connection, requests which have not completed fail
+ */
+HttpClientPool::~HttpClientPool()
+{
+  io_service_.post([this]() { Shutdown(); });
+  work_.reset();
+  thread_.join();
+}
+
+/**
+ * Make a request to a host. This blocks while the maximum number of requests are in flight,
+ * unless it is called from a callback of the pool
+ *
+ * @param host The host or IP address of the server
+ * @param port The port of the server
+ * @param request The request to be made
+ * @param callback The callback for the response, called from the thread of the pool
+ */
+void HttpClientPool::Request(std::string const &host, uint16_t port, HTTPRequest const &request,
+                             Callback callback)
+{
+  auto pending = std::make_shared<Pending>();
+
+  asio::streambuf buffer;
+  request.ToStream(buffer, host, port);
+  pending->data.assign(asio::buffers_begin(buffer.data()), asio::buffers_end(buffer.data()));
+  pending->callback = std::move(callback);
+
+  {
+    std::unique_lock<std::mutex> lock(window_mutex_);
+    if (std::this_thread::get_id() != thread_.get_id())
+    {
+      window_cv_.wait(lock, [this]() { return in_flight_ < config_.max_in_flight; });
+    }
+
+    ++in_flight_;
+  }
+
+  io_service_.post([this, host, port, pending]() {
+    auto &entry = hosts_[host + ':' + std::to_string(port)];
+    if (!entry)
+    {
+      entry       = std::make_shared<Host>();
+      entry->name = host;
+      entry->port = port;
+    }
+
+    entry->queue.emplace_back(pending);
+    Dispatch(entry);
+  });
+}
+
+/**
+ * @return The number of requests which have not completed
+ */
+std::size_t HttpClientPool::in_flight() const
+{
+  std::lock_guard<std::mutex> lock(window_mutex_);
+  return in_flight_;
+}
+
+/**
+ * @return The number of connections which have been opened since construction
+ */
+std::size_t HttpClientPool::connections_opened() const
+{
+  return connections_opened_;
+}
+
+/**
+ * Assign the queued requests of a host to its connections, opening new connections while the
+ * existing ones are busy and the pool of the host is not full
+ */
+void HttpClientPool::Dispatch(HostPtr const &host)
+{
+  if (stopping_)
+  {
+    while (!host->queue.empty())
+    {
+      Finished(host->queue.front(), false, HTTPResponse{});
+      host->queue.pop_front();
+    }
+
+    return;
+  }
+
+  while (!host->queue.empty())
+  {
+    auto const least_loaded =
+        std::min_element(host->connections.begin(), host->connections.end(),
+                         [](ConnectionPtr const &a, ConnectionPtr const &b) {
+                           return a->load() < b->load();
+                         });
+
+    ConnectionPtr connection;
+    if ((least_loaded != host->connections.end()) && ((*least_loaded)->load() == 0))
+    {
+      connection = *least_loaded;
+    }
+    else if (host->connections.size() < config_.connections_per_host)
+    {
+      connection = std::make_shared<Connection>(*this, host);
+      host->connections.emplace_back(connection);
+      ++connections_opened_;
+      connection->Open();
+    }
+    else if ((*least_loaded)->load() < config_.pipeline_depth)
+    {
+      connection = *least_loaded;
+    }
+    else
+    {
+      // every connection is busy, the requests are dispatched as responses arrive
+      break;
+    }
+
+    auto pending = std::move(host->queue.front());
+    host->queue.pop_front();
+    connection->Assign(std::move(pending));
+  }
+}
+
+void HttpClientPool::Finished(PendingPtr const &pending, bool success, HTTPResponse const &response)
+{
+  {
+    std::lock_guard<std::mutex> lock(window_mutex_);
+    --in_flight_;
+  }
+
+  window_cv_.notify_one();
+
+  if (pending->callback)
+  {
+    pending->callback(success, response);
+  }
+}
+
+void HttpClientPool::Closed(ConnectionPtr const &connection)
+{
+  auto const host = connection->host();
+
+  host->connections.erase(
+      std::remove(host->connections.begin(), host->connections.end(), connection),
+      host->connections.end());
+
+  Dispatch(host);
+}
+
+void HttpClientPool::Shutdown()
+{
+  stopping_ = true;
+
+  for (auto const &entry : hosts_)
+  {
+    // closing a connection removes it from the host
+    auto const connections = entry.second->connections;
+    for (auto const &connection : connections)
+    {
+      connection->Close();
+    }
+
+    Dispatch(entry.second);
+  }
+
+  hosts_.clear();
+}
+
+/**
+ * Construct a blocking client for a host
+ *
+ * @param pool The pool which makes the requests
+ * @param host The host or IP address of the server
+ * @param port The port of the server
+ */
+PooledHttpClient::PooledHttpClient(PoolPtr pool, std::string host, uint16_t port)
+  : pool_(std::move(pool))
+  , host_(std::move(host))
+  , port_(port)
+{}
+
+/**
+ * Send a request and wait for the response from the server
+ *
+ * @param request The request to be sent
+ * @param response The response to be populated
+ * @return true if successful, otherwise false
+ */
+bool PooledHttpClient::Request(HTTPRequest const &request, HTTPResponse &response)
+{
+  std::promise<bool> completed;
+  auto               result = completed.get_future();
+
+  pool_->Request(host_, port_, request,
+                 [&completed, &response](bool success, HTTPResponse const &received) {
+                   response = received;
+                   completed.set_value(success);
+                 });
+
+  return result.get();
+}
+
+std::string const &PooledHttpClient::host() const
+{
+  return host_;
+}
+
+uint16_t PooledHttpClient::port() const
+{
+  return port_;
+}
+
+}  // namespace http
+}  // namespace fetch
@@ -153,6 +153,16 @@ JsonClient::JsonClient(ConnectionMode mode, std::string host, uint16_t port)
   }
 }
 
+/**
+ * Construct a JsonClient which makes its requests with a specified client, for example a
+ * PooledHttpClient
+ *
+ * @param client The client to be used
+ */
+JsonClient::JsonClient(std::unique_ptr<HttpClientInterface> client)
+  : client_{std::move(client)}
+{}
+
 /**
  * Internal: Make the underlying HTTP request
  *
@@ -20,10 +20,9 @@
 #include "http/mime_types.hpp"
 #include "http/response.hpp"
 #include "http/status.hpp"
+#include "variant/json_writer.hpp"
 #include "variant/variant.hpp"
 
-#include <sstream>
-
 namespace fetch {
 namespace http {
 
@@ -36,9 +35,12 @@ http::HTTPResponse CreateJsonResponse(byte_array::ConstByteArray const &body, St
 http::HTTPResponse CreateJsonResponse(variant::Variant const &doc, Status status)
 {
   static auto const jsonMimeType = mime_types::GetMimeTypeFromExtension(".json");
-  std::stringstream body;
-  body << doc;
-  return http::HTTPResponse(body.str(), jsonMimeType, status);
+
+  // the output buffer of the writer is reused by every response built on this thread
+  thread_local variant::JsonWriter writer;
+  writer.Write(doc);
+
+  return http::HTTPResponse(writer.Take(), jsonMimeType, status);
 }
 
 }  // namespace http
@@ -17,10 +17,12 @@
 //------------------------------------------------------------------------------
 
 #include "core/assert.hpp"
+#include "core/string/to_lower.hpp"
 #include "http/request.hpp"
 
 #include <algorithm>
 #include <iostream>
+#include <string>
 
 namespace fetch {
 namespace http {
@@ -160,6 +162,25 @@ bool HTTPRequest::ParseHeader(asio::streambuf &buffer, std::size_t end)
   return success;
 }
 
+/**
+ * Determine if the connection should remain open once the request has been responded to
+ *
+ * @return true if the connection is persistent, otherwise false
+ */
+bool HTTPRequest::keep_alive() const
+{
+  std::string connection{header_["connection"]};
+  string::ToLower(connection);
+
+  // connections are persistent by default from HTTP/1.1 onwards
+  if (protocol_ == "http/1.0")
+  {
+    return connection == "keep-alive";
+  }
+
+  return connection != "close";
+}
+
 bool HTTPRequest::ToStream(asio::streambuf &buffer, std::string const &host, uint16_t port) const
 {
   static char const *NEW_LINE = "\r\n";
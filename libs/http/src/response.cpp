@@ -59,9 +59,21 @@ bool HTTPResponse::ToStream(asio::streambuf &buffer) const
 
   for (auto &field : header_)
   {
+    // the length of a streamed body is not known in advance
+    if (is_chunked() && (field.first == "content-length"))
+    {
+      continue;
+    }
+
     stream << field.first << ": " << field.second << NEW_LINE;
   }
 
+  if (is_chunked())
+  {
+    stream << "transfer-encoding: chunked" << NEW_LINE << NEW_LINE;
+    return true;
+  }
+
   if (!header_.Has("content-length"))
   {
     stream << "content-length: " << body_.size() << NEW_LINE;
@@ -74,6 +86,22 @@ bool HTTPResponse::ToStream(asio::streambuf &buffer) const
   return true;
 }
 
+/**
+ * Write a single chunk of a streamed body to the buffer
+ *
+ * @param buffer The buffer to be populated
+ * @param chunk The chunk of the body, where an empty chunk terminates the body
+ */
+void HTTPResponse::ChunkToStream(asio::streambuf &buffer, byte_array::ConstByteArray const &chunk)
+{
+  static char const *NEW_LINE = "\r\n";
+
+  std::ostream stream(&buffer);
+
+  // note: the last (empty) chunk is followed directly by the end of the (empty) trailer
+  stream << std::hex << chunk.size() << std::dec << NEW_LINE << chunk << NEW_LINE;
+}
+
 bool HTTPResponse::ParseHeader(asio::streambuf &buffer, std::size_t length)
 {
   header_.Clear();
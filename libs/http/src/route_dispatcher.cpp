@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/route_dispatcher.hpp"
+
+#include <algorithm>
+
+namespace fetch {
+namespace http {
+namespace {
+
+constexpr char SEPARATOR        = '/';
+constexpr char PARAMETER_OPENER = '(';
+
+/**
+ * Visit each of the complete (separator terminated) segments of a path in turn
+ *
+ * @param path The path to be split
+ * @param visitor The visitor, returning false to stop the iteration
+ */
+template <typename Visitor>
+void ForEachSegment(byte_array::ConstByteArray const &path, Visitor &&visitor)
+{
+  std::size_t start = ((!path.empty()) && (path[0] == SEPARATOR)) ? 1 : 0;
+
+  for (;;)
+  {
+    std::size_t const end = path.Find(SEPARATOR, start);
+    if ((end == byte_array::ConstByteArray::NPOS) || !visitor(path.SubArray(start, end - start)))
+    {
+      break;
+    }
+
+    start = end + 1;
+  }
+}
+
+}  // namespace
+
+/**
+ * Add a route to the dispatcher
+ *
+ * @param method The method of the route
+ * @param pattern The path pattern of the route (as given to Route::FromString)
+ * @param index The index of the route, which must be greater than any previously added
+ */
+void RouteDispatcher::Add(Method method, ConstByteArray const &pattern, Index index)
+{
+  Table &table = tables_[method];
+
+  std::size_t const parameter = pattern.Find(PARAMETER_OPENER, 0);
+  if (parameter == ConstByteArray::NPOS)
+  {
+    table.exact[pattern].push_back(index);
+    return;
+  }
+
+  // only the segments which are complete before the first parameter can be used as keys
+  Node *node = &table.root;
+  ForEachSegment(pattern.SubArray(0, parameter), [&node](ConstByteArray const &segment) {
+    auto &child = node->children[segment];
+    if (!child)
+    {
+      child = std::make_unique<Node>();
+    }
+
+    node = child.get();
+    return true;
+  });
+
+  node->routes.push_back(index);
+}
+
+/**
+ * Lookup the routes which could match the specified path
+ *
+ * @param method The method of the request
+ * @param path The requested path
+ * @return The indices of the candidate routes, in the order they were added
+ */
+RouteDispatcher::Indices RouteDispatcher::Lookup(Method method, ConstByteArray const &path) const
+{
+  Indices candidates{};
+
+  auto const table_it = tables_.find(method);
+  if (table_it == tables_.end())
+  {
+    return candidates;
+  }
+
+  Table const &table = table_it->second;
+
+  auto const exact_it = table.exact.find(path);
+  if (exact_it != table.exact.end())
+  {
+    candidates = exact_it->second;
+  }
+
+  Node const *node = &table.root;
+  candidates.insert(candidates.end(), node->routes.begin(), node->routes.end());
+
+  ForEachSegment(path, [&node, &candidates](ConstByteArray const &segment) {
+    auto const it = node->children.find(segment);
+    if (it == node->children.end())
+    {
+      return false;
+    }
+
+    node = it->second.get();
+    candidates.insert(candidates.end(), node->routes.begin(), node->routes.end());
+    return true;
+  });
+
+  std::sort(candidates.begin(), candidates.end());
+
+  return candidates;
+}
+
+}  // namespace http
+}  // namespace fetch
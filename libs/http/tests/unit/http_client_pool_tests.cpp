@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/http_client_pool.hpp"
+#include "http/module.hpp"
+#include "http/request.hpp"
+#include "http/response.hpp"
+#include "http/server.hpp"
+#include "network/management/network_manager.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace {
+
+using namespace fetch::http;
+using namespace std::chrono_literals;
+
+using fetch::network::NetworkManager;
+
+constexpr uint16_t    PORT        = 8431;
+constexpr std::size_t NUM_WORKERS = 4;
+
+/**
+ * A module which echoes the body of its requests, and has a view which blocks until it is released
+ */
+class EchoModule : public HTTPModule
+{
+public:
+  EchoModule()
+  {
+    Post("/echo", "Echoes the request body",
+         [](ViewParameters const &, HTTPRequest const &request) {
+           return HTTPResponse(request.body());
+         });
+
+    Post("/slow", "Blocks until released", [this](ViewParameters const &, HTTPRequest const &) {
+      std::unique_lock<std::mutex> lock{mutex_};
+      cv_.wait(lock, [this]() { return released_; });
+
+      return HTTPResponse("{}");
+    });
+  }
+
+  void Release()
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    released_ = true;
+    cv_.notify_all();
+  }
+
+private:
+  std::mutex              mutex_;
+  std::condition_variable cv_;
+  bool                    released_{false};
+};
+
+HTTPRequest MakeRequest(std::string const &uri, std::string const &body)
+{
+  HTTPRequest request;
+  request.SetMethod(Method::POST);
+  request.SetURI(uri);
+  request.SetBody(body);
+
+  return request;
+}
+
+class HttpClientPoolTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    network_manager_.Start();
+    server_.AddModule(module_);
+    server_.Start(PORT);
+  }
+
+  void TearDown() override
+  {
+    module_.Release();
+    server_.Stop();
+    network_manager_.Stop();
+  }
+
+  NetworkManager network_manager_{"Test", 2};
+  HTTPServer     server_{network_manager_, NUM_WORKERS};
+  EchoModule     module_;
+};
+
+TEST_F(HttpClientPoolTests, CheckPipelinedResponsesMatchTheirRequests)
+{
+  constexpr std::size_t NUM_REQUESTS = 200;
+
+  HttpClientPool::Config config;
+  config.connections_per_host = 2;
+  config.pipeline_depth       = 16;
+
+  HttpClientPool pool{config};
+
+  std::mutex              mutex;
+  std::condition_variable cv;
+  std::size_t             completed{0};
+  std::size_t             matched{0};
+
+  for (std::size_t i = 0; i < NUM_REQUESTS; ++i)
+  {
+    auto const body = std::to_string(i);
+
+    pool.Request("127.0.0.1", PORT, MakeRequest("/echo", body),
+                 [&, body](bool success, HTTPResponse const &response) {
+                   std::lock_guard<std::mutex> lock{mutex};
+                   ++completed;
+                   if (success && (response.body() == body))
+                   {
+                     ++matched;
+                   }
+                   cv.notify_all();
+                 });
+  }
+
+  std::unique_lock<std::mutex> lock{mutex};
+  ASSERT_TRUE(cv.wait_for(lock, 10s, [&]() { return completed == NUM_REQUESTS; }));
+  EXPECT_EQ(matched, NUM_REQUESTS);
+  EXPECT_EQ(pool.in_flight(), 0);
+
+  // the connections are kept alive, rather than opened for each request
+  EXPECT_LE(pool.connections_opened(), config.connections_per_host);
+}
+
+TEST_F(HttpClientPoolTests, CheckBlockingClientReusesItsConnection)
+{
+  auto pool = std::make_shared<HttpClientPool>();
+
+  PooledHttpClient client{pool, "127.0.0.1", PORT};
+  EXPECT_EQ(client.host(), "127.0.0.1");
+  EXPECT_EQ(client.port(), PORT);
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    HTTPResponse response;
+    ASSERT_TRUE(client.Request(MakeRequest("/echo", "hello"), response));
+    EXPECT_EQ(response.body(), "hello");
+  }
+
+  EXPECT_EQ(pool->connections_opened(), 1);
+}
+
+TEST_F(HttpClientPoolTests, CheckRequestsInFlightAreBounded)
+{
+  HttpClientPool::Config config;
+  config.max_in_flight = 2;
+
+  HttpClientPool pool{config};
+
+  pool.Request("127.0.0.1", PORT, MakeRequest("/slow", ""), nullptr);
+  pool.Request("127.0.0.1", PORT, MakeRequest("/slow", ""), nullptr);
+  EXPECT_EQ(pool.in_flight(), 2);
+
+  // the window is full, so the next request waits for one of the others to complete
+  auto third = std::async(std::launch::async, [&pool]() {
+    pool.Request("127.0.0.1", PORT, MakeRequest("/echo", ""), nullptr);
+  });
+  EXPECT_EQ(third.wait_for(200ms), std::future_status::timeout);
+
+  module_.Release();
+  EXPECT_EQ(third.wait_for(10s), std::future_status::ready);
+}
+
+TEST_F(HttpClientPoolTests, CheckRequestsToAnUnreachableHostFail)
+{
+  HttpClientPool pool;
+
+  std::promise<bool> completed;
+  auto               result = completed.get_future();
+
+  pool.Request("127.0.0.1", 1, MakeRequest("/echo", ""),
+               [&completed](bool success, HTTPResponse const &) { completed.set_value(success); });
+
+  ASSERT_EQ(result.wait_for(10s), std::future_status::ready);
+  EXPECT_FALSE(result.get());
+  EXPECT_EQ(pool.in_flight(), 0);
+}
+
+}  // namespace
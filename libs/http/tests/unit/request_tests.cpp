@@ -20,6 +20,8 @@
 
 #include "gmock/gmock.h"
 
+#include <ostream>
+
 namespace {
 
 using namespace ::testing;
@@ -28,6 +30,18 @@ class RequestTests : public Test
 {
 public:
   using Request = fetch::http::HTTPRequest;
+
+  static bool IsKeepAlive(char const *raw_header)
+  {
+    asio::streambuf buffer;
+    std::ostream    stream(&buffer);
+    stream << raw_header;
+
+    Request req;
+    EXPECT_TRUE(req.ParseHeader(buffer, buffer.size()));
+
+    return req.keep_alive();
+  }
 };
 
 TEST_F(RequestTests, no_error_when_reading_zero_bytes_from_empty_buffer)
@@ -40,4 +54,13 @@ TEST_F(RequestTests, no_error_when_reading_zero_bytes_from_empty_buffer)
   ASSERT_NO_THROW(req.ParseHeader(buffer, BYTES_REQUESTED));
 }
 
+TEST_F(RequestTests, connections_are_persistent_unless_closed)
+{
+  EXPECT_TRUE(IsKeepAlive("GET /api/status HTTP/1.1\r\n\r\n"));
+  EXPECT_TRUE(IsKeepAlive("GET /api/status HTTP/1.1\r\nConnection: keep-alive\r\n\r\n"));
+  EXPECT_FALSE(IsKeepAlive("GET /api/status HTTP/1.1\r\nConnection: Close\r\n\r\n"));
+  EXPECT_FALSE(IsKeepAlive("GET /api/status HTTP/1.0\r\n\r\n"));
+  EXPECT_TRUE(IsKeepAlive("GET /api/status HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n"));
+}
+
 }  // namespace
@@ -22,8 +22,13 @@
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
+#include <istream>
+#include <iterator>
 #include <memory>
 #include <ostream>
+#include <string>
+#include <vector>
 
 class ResponseTests : public ::testing::Test
 {
@@ -43,6 +48,12 @@ protected:
     stream << text;
   }
 
+  static std::string ConvertFromBuffer(asio::streambuf &buffer)
+  {
+    std::istream is(&buffer);
+    return std::string{std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+  }
+
   void VerifyHeaderValue(ConstByteArray const &key, ConstByteArray const &value)
   {
     ASSERT_TRUE(response_->header().Has(key));
@@ -93,3 +104,40 @@ TEST_F(ResponseTests, HeaderCase2)
   VerifyHeaderValue("content-type", "application/json");
   VerifyHeaderValue("content-length", "10");
 }
+
+TEST_F(ResponseTests, ChunkedBodyIsStreamed)
+{
+  std::vector<ConstByteArray> chunks = {"hello ", "streamed world"};
+  std::size_t                 next   = 0;
+
+  Response response{"unused", fetch::http::mime_types::GetMimeTypeFromExtension(".txt")};
+  response.SetChunkProducer([&chunks, &next](ConstByteArray &chunk) {
+    if (next == chunks.size())
+    {
+      return false;
+    }
+
+    chunk = chunks[next++];
+    return true;
+  });
+
+  ASSERT_TRUE(response.is_chunked());
+
+  asio::streambuf buffer;
+  ASSERT_TRUE(response.ToStream(buffer));
+
+  // the length of the body is not known up front
+  std::string const header = ConvertFromBuffer(buffer);
+  EXPECT_EQ(header.find("content-length"), std::string::npos);
+  EXPECT_NE(header.find("transfer-encoding: chunked\r\n\r\n"), std::string::npos);
+  EXPECT_EQ(header.substr(header.size() - 4), "\r\n\r\n");
+
+  ConstByteArray chunk;
+  while (response.chunk_producer()(chunk))
+  {
+    Response::ChunkToStream(buffer, chunk);
+  }
+  Response::ChunkToStream(buffer, ConstByteArray{});
+
+  EXPECT_EQ(ConvertFromBuffer(buffer), "6\r\nhello \r\ne\r\nstreamed world\r\n0\r\n\r\n");
+}
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "http/method.hpp"
+#include "http/route.hpp"
+#include "http/route_dispatcher.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::http::Method;
+using fetch::http::Route;
+using fetch::http::RouteDispatcher;
+using fetch::http::ViewParameters;
+
+using Indices = RouteDispatcher::Indices;
+
+struct Entry
+{
+  Method    method;
+  ByteArray pattern;
+};
+
+std::vector<Entry> const ROUTES = {
+    {Method::GET, "/"},
+    {Method::GET, "/api/status"},
+    {Method::GET, "/api/status/chain"},
+    {Method::POST, "/api/status"},
+    {Method::GET, "/api/tx/(digest=[a-fA-F0-9]{64})"},
+    {Method::POST, "/api/contract/(identifier=[a-z]{4})/(query=.+)"},
+    {Method::POST, "/api/contract/submit"},
+    {Method::GET, "/api/(name=[a-z]+)/info"},
+    {Method::GET, "/api/prefix-(value=[0-9]+)"},
+    {Method::GET, "/(name=[a-z]+)"},
+};
+
+class RouteDispatcherTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    for (std::size_t i = 0; i < ROUTES.size(); ++i)
+    {
+      dispatcher_.Add(ROUTES[i].method, ROUTES[i].pattern, i);
+      routes_.push_back(Route::FromString(ROUTES[i].pattern));
+    }
+  }
+
+  /**
+   * Determine the routes which match the path by evaluating every one of them in turn
+   */
+  Indices Matching(Method method, ByteArray const &path) const
+  {
+    Indices matching{};
+
+    ViewParameters params;
+    for (std::size_t i = 0; i < ROUTES.size(); ++i)
+    {
+      if ((ROUTES[i].method == method) && routes_[i].Match(path, params))
+      {
+        matching.push_back(i);
+      }
+    }
+
+    return matching;
+  }
+
+  /**
+   * Determine the routes which match the path, from only the candidates of the dispatcher
+   */
+  Indices Dispatched(Method method, ByteArray const &path) const
+  {
+    Indices matching{};
+
+    ViewParameters params;
+    for (auto const index : dispatcher_.Lookup(method, path))
+    {
+      if (routes_[index].Match(path, params))
+      {
+        matching.push_back(index);
+      }
+    }
+
+    return matching;
+  }
+
+  RouteDispatcher    dispatcher_;
+  std::vector<Route> routes_;
+};
+
+TEST_F(RouteDispatcherTests, CheckCandidatesAreNarrowedByPath)
+{
+  EXPECT_EQ(dispatcher_.Lookup(Method::GET, "/"), (Indices{0, 9}));
+  EXPECT_EQ(dispatcher_.Lookup(Method::GET, "/api/status"), (Indices{1, 7, 8, 9}));
+  EXPECT_EQ(dispatcher_.Lookup(Method::POST, "/api/status"), (Indices{3}));
+  EXPECT_EQ(dispatcher_.Lookup(Method::POST, "/api/contract/abcd/balance"), (Indices{5}));
+  EXPECT_EQ(dispatcher_.Lookup(Method::PUT, "/api/status"), (Indices{}));
+}
+
+TEST_F(RouteDispatcherTests, CheckDispatchMatchesExhaustiveEvaluation)
+{
+  std::vector<ByteArray> const paths = {
+      "/",
+      "/api",
+      "/api/status",
+      "/api/status/",
+      "/api/status/chain",
+      "/api/tx/" + ByteArray(std::string(64, 'a')),
+      "/api/tx/abc",
+      "/api/contract/abcd/balance",
+      "/api/contract/abcd/nested/query",
+      "/api/contract/submit",
+      "/api/wallet/info",
+      "/api/prefix-42",
+      "/wallet",
+      "/wallet/",
+      "",
+  };
+
+  for (auto const method : {Method::GET, Method::POST, Method::PUT})
+  {
+    for (auto const &path : paths)
+    {
+      EXPECT_EQ(Dispatched(method, path), Matching(method, path)) << "Path: " << path;
+    }
+  }
+}
+
+}  // namespace
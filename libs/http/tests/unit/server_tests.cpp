@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/json_response.hpp"
+#include "http/module.hpp"
+#include "http/request.hpp"
+#include "http/server.hpp"
+#include "network/management/network_manager.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using namespace fetch::http;
+using namespace std::chrono_literals;
+
+using fetch::network::NetworkManager;
+
+constexpr std::size_t            NUM_WORKERS = 4;
+constexpr HTTPServer::HandleType CLIENT      = 1;
+
+/**
+ * A module with a view which blocks until it is released by the test
+ */
+class BlockingModule : public HTTPModule
+{
+public:
+  BlockingModule()
+  {
+    Post("/slow", "Blocks until released", [this](ViewParameters const &, HTTPRequest const &) {
+      std::unique_lock<std::mutex> lock{mutex_};
+
+      ++active_;
+      max_active_ = std::max(max_active_, active_);
+      cv_.notify_all();
+
+      cv_.wait(lock, [this]() { return released_; });
+      --active_;
+
+      return CreateJsonResponse("{}", Status::SUCCESS_OK);
+    });
+  }
+
+  bool WaitForActive(std::size_t count)
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    return cv_.wait_for(lock, 5s, [this, count]() { return active_ >= count; });
+  }
+
+  void Release()
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    released_ = true;
+    cv_.notify_all();
+  }
+
+  std::size_t max_active()
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return max_active_;
+  }
+
+private:
+  std::mutex              mutex_;
+  std::condition_variable cv_;
+  std::size_t             active_{0};
+  std::size_t             max_active_{0};
+  bool                    released_{false};
+};
+
+class HTTPServerTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    network_manager_.Start();
+
+    server_.AddModule(module_);
+    server_.AddMiddleware([this](HTTPResponse &res, HTTPRequest const &) {
+      std::lock_guard<std::mutex> lock{mutex_};
+      statuses_.push_back(res.status());
+      cv_.notify_all();
+    });
+  }
+
+  void TearDown() override
+  {
+    module_.Release();
+    server_.Stop();
+    network_manager_.Stop();
+  }
+
+  void PushSlowRequest()
+  {
+    HTTPRequest request;
+    request.SetMethod(Method::POST);
+    request.SetURI("/slow");
+
+    server_.PushRequest(CLIENT, request);
+  }
+
+  std::vector<Status> WaitForResponses(std::size_t count)
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    cv_.wait_for(lock, 5s, [this, count]() { return statuses_.size() >= count; });
+    return statuses_;
+  }
+
+  NetworkManager          network_manager_{"Test", 2};
+  HTTPServer              server_{network_manager_, NUM_WORKERS};
+  BlockingModule          module_;
+  std::mutex              mutex_;
+  std::condition_variable cv_;
+  std::vector<Status>     statuses_;
+};
+
+TEST_F(HTTPServerTests, CheckViewsAreEvaluatedConcurrently)
+{
+  server_.Start(0);
+
+  PushSlowRequest();
+  PushSlowRequest();
+
+  // both of the requests must be in progress at the same time
+  ASSERT_TRUE(module_.WaitForActive(2));
+  module_.Release();
+
+  auto const statuses = WaitForResponses(2);
+  ASSERT_EQ(statuses.size(), 2);
+  EXPECT_EQ(statuses[0], Status::SUCCESS_OK);
+  EXPECT_EQ(statuses[1], Status::SUCCESS_OK);
+  EXPECT_EQ(module_.max_active(), 2);
+}
+
+TEST_F(HTTPServerTests, CheckRequestsBeyondTheConcurrencyLimitAreRejected)
+{
+  ASSERT_TRUE(server_.SetConcurrencyLimit(Method::POST, "/slow", 1));
+  ASSERT_FALSE(server_.SetConcurrencyLimit(Method::GET, "/slow", 1));
+  server_.Start(0);
+
+  PushSlowRequest();
+  ASSERT_TRUE(module_.WaitForActive(1));
+
+  // the second request is rejected while the first occupies the only slot
+  PushSlowRequest();
+  auto statuses = WaitForResponses(1);
+  ASSERT_EQ(statuses.size(), 1);
+  EXPECT_EQ(statuses[0], Status::SERVER_ERROR_SERVICE_UNAVAILABLE);
+
+  module_.Release();
+
+  statuses = WaitForResponses(2);
+  ASSERT_EQ(statuses.size(), 2);
+  EXPECT_EQ(statuses[1], Status::SUCCESS_OK);
+  EXPECT_EQ(module_.max_active(), 1);
+}
+
+TEST_F(HTTPServerTests, CheckViewsCanNotBeAddedOnceStarted)
+{
+  server_.Start(0);
+
+  BlockingModule other;
+  EXPECT_THROW(server_.AddModule(other), std::runtime_error);
+  EXPECT_THROW(server_.AddMiddleware([](HTTPResponse &, HTTPRequest const &) {}),
+               std::runtime_error);
+  EXPECT_THROW(server_.SetConcurrencyLimit(Method::POST, "/slow", 1), std::runtime_error);
+}
+
+}  // namespace
@@ -25,15 +25,111 @@
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <limits>
 #include <string>
 
+#include <emmintrin.h>
+
 namespace fetch {
 namespace json {
 
 namespace {
 constexpr char const *LOGGING_NAME = "JSONDocument";
+
+/**
+ * Consume a string from the document, scanning 16 bytes at a time for the characters which are
+ * significant inside a string (quotes and escapes)
+ *
+ * @param document The whole document
+ * @param pos The position of the opening quote, updated to the position after the closing quote
+ * @return true if the string was terminated, otherwise false
+ */
+bool ConsumeString(byte_array::ConstByteArray const &document, uint64_t &pos)
+{
+  static constexpr std::size_t BLOCK_SIZE = sizeof(__m128i);
+
+  auto const *const ptr  = reinterpret_cast<uint8_t const *>(document.pointer());
+  std::size_t const size = document.size();
+
+  __m128i const quotes  = _mm_set1_epi8('"');
+  __m128i const escapes = _mm_set1_epi8('\\');
+
+  ++pos;
+  while (pos < size)
+  {
+    // skip over the blocks which contain neither quotes nor escapes
+    if ((size - pos) >= BLOCK_SIZE)
+    {
+      __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(ptr + pos));
+      auto const    mask  = static_cast<uint32_t>(_mm_movemask_epi8(
+          _mm_or_si128(_mm_cmpeq_epi8(block, quotes), _mm_cmpeq_epi8(block, escapes))));
+
+      if (mask == 0)
+      {
+        pos += BLOCK_SIZE;
+        continue;
+      }
+
+      pos += static_cast<uint64_t>(__builtin_ctz(mask));
+    }
+
+    if (ptr[pos] == '"')
+    {
+      ++pos;
+      return true;
+    }
+
+    // an escape also consumes the following character
+    pos += 1u + static_cast<uint64_t>(ptr[pos] == '\\');
+  }
+
+  pos = size;
+  return false;
+}
+
+/**
+ * Convert an integer directly from the document, without an intermediate string
+ *
+ * @param document The whole document
+ * @param start The position of the first character of the integer
+ * @param length The number of characters in the integer
+ * @param value The output value
+ * @return true if successful, otherwise false if the value is out of range
+ */
+bool ConvertInteger(byte_array::ConstByteArray const &document, uint64_t start, uint64_t length,
+                    int64_t &value)
+{
+  auto const *ptr = reinterpret_cast<uint8_t const *>(document.pointer()) + start;
+  auto const *end = ptr + length;
+
+  bool const negative = (ptr != end) && (*ptr == '-');
+  if (negative)
+  {
+    ++ptr;
+  }
+
+  // accumulate the magnitude, which can be one larger than the maximum when negative
+  uint64_t const limit =
+      static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (negative ? 1u : 0u);
+
+  uint64_t magnitude{0};
+  for (; ptr != end; ++ptr)
+  {
+    auto const digit = static_cast<uint64_t>(*ptr - '0');
+    if (magnitude > ((limit - digit) / 10u))
+    {
+      return false;
+    }
+
+    magnitude = (magnitude * 10u) + digit;
+  }
+
+  value = negative ? static_cast<int64_t>(0u - magnitude) : static_cast<int64_t>(magnitude);
+  return true;
 }
 
+}  // namespace
+
 /**
  * Extract a primitive value from a JSONToken
  *
@@ -70,16 +166,16 @@ void JSONDocument::ExtractPrimitive(Variant &variant, JSONToken const &token,
 
   case NUMBER_INT:
   {
-    std::string const str{document.SubArray(token.first, token.second)};
-    errno   = 0;
-    variant = std::strtoll(str.c_str(), nullptr, 10);
-    if (errno == ERANGE)
+    int64_t value{0};
+    if (!ConvertInteger(document, token.first, token.second, value))
     {
-      errno = 0;
+      std::string const str{document.SubArray(token.first, token.second)};
       FETCH_LOG_ERROR(LOGGING_NAME, "Failed to convert str=", str, " to integer");
 
       throw JSONParseException(std::string("Failed to convert str=") + str + " to integer");
     }
+
+    variant = value;
     success = true;
     break;
   }
@@ -428,7 +524,7 @@ void JSONDocument::Tokenise(ConstByteArray const &document)
     case '"':
       ++objects_;
       ++element_counter;
-      byte_array::consumers::StringConsumer<STRING>(document, pos);
+      ConsumeString(document, pos);
       tokens_.push_back({oldpos + 1, pos - 1, STRING});
       break;
     case '{':
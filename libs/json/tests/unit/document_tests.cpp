@@ -21,6 +21,8 @@
 #include "gtest/gtest.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <sstream>
 
 using fetch::json::JSONDocument;
@@ -170,3 +172,32 @@ TEST(JsonTests, ExpectedToThrow)
   JSONDocument doc;
   EXPECT_THROW(doc.Parse(text), fetch::json::JSONParseException);
 }
+
+TEST(JsonTests, EscapedStringsAcrossBlocks)
+{
+  // the escaped quotes fall on either side of a 16 byte boundary
+  char const *text = R"({"a": "0123456789abcd\"efghijklmnopqrstu\"vwx", "b": "\\", "c": "short"})";
+
+  JSONDocument doc;
+  ASSERT_NO_THROW(doc.Parse(text));
+
+  EXPECT_EQ(doc["a"].As<fetch::byte_array::ConstByteArray>(),
+            R"(0123456789abcd\"efghijklmnopqrstu\"vwx)");
+  EXPECT_EQ(doc["b"].As<fetch::byte_array::ConstByteArray>(), R"(\\)");
+  EXPECT_EQ(doc["c"].As<fetch::byte_array::ConstByteArray>(), "short");
+}
+
+TEST(JsonTests, IntegerLimits)
+{
+  JSONDocument doc;
+  ASSERT_NO_THROW(doc.Parse(R"([9223372036854775807, -9223372036854775808, -0, 0])"));
+
+  EXPECT_EQ(doc[0].As<int64_t>(), std::numeric_limits<int64_t>::max());
+  EXPECT_EQ(doc[1].As<int64_t>(), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(doc[2].As<int64_t>(), 0);
+  EXPECT_EQ(doc[3].As<int64_t>(), 0);
+
+  EXPECT_THROW(doc.Parse("[9223372036854775808]"), fetch::json::JSONParseException);
+  EXPECT_THROW(doc.Parse("[-9223372036854775809]"), fetch::json::JSONParseException);
+  EXPECT_THROW(doc.Parse("[100000000000000000000]"), fetch::json::JSONParseException);
+}
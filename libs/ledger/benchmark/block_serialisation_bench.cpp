@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/chain/block.hpp"
+#include "vectorise/memory/arena.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// number of calls to the global allocator, used to report allocations per decoded block
+std::atomic<std::size_t> heap_allocations{0};
+
+}  // namespace
+
+void *operator new(std::size_t size)
+{
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr)
+  {
+    throw std::bad_alloc{};
+  }
+
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::chain::TransactionLayout;
+using fetch::ledger::Block;
+using fetch::memory::Arena;
+using fetch::memory::ArenaScope;
+using fetch::serializers::LargeObjectSerializeHelper;
+using fetch::serializers::MsgPackSerializer;
+
+constexpr std::size_t NUM_SLICES = 100;
+constexpr uint32_t    LOG2_LANES = 4;
+
+Block CreateBlock(std::size_t num_transactions)
+{
+  Block block{};
+  block.block_number   = 1;
+  block.log2_num_lanes = LOG2_LANES;
+  block.slices.resize(NUM_SLICES);
+
+  BitVector mask{1u << LOG2_LANES};
+  mask.set(0, 1);
+
+  for (std::size_t i = 0; i < num_transactions; ++i)
+  {
+    ByteArray digest;
+    digest.Resize(32);
+    for (std::size_t j = 0; j < digest.size(); ++j)
+    {
+      digest[j] = static_cast<uint8_t>((i >> (8 * (j % sizeof(i)))) + j);
+    }
+
+    block.slices[i % NUM_SLICES].emplace_back(digest, mask, 1, 0, 1000);
+  }
+
+  block.UpdateDigest();
+
+  return block;
+}
+
+void Block_SerialiseStreaming(benchmark::State &state)
+{
+  auto const block = CreateBlock(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    // buffer grows as the block is written
+    MsgPackSerializer serializer{};
+    serializer << block;
+
+    benchmark::DoNotOptimize(serializer.data());
+  }
+}
+
+void Block_SerialisePrecomputed(benchmark::State &state)
+{
+  auto const block = CreateBlock(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    // buffer is sized once from a counting pass before any bytes are written
+    MsgPackSerializer serializer{};
+    serializer.Append(block);
+
+    benchmark::DoNotOptimize(serializer.data());
+  }
+}
+
+void Block_SerialiseLargeObjectHelper(benchmark::State &state)
+{
+  auto const block = CreateBlock(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    LargeObjectSerializeHelper helper{};
+    helper << block;
+
+    benchmark::DoNotOptimize(helper.data());
+  }
+}
+
+void Block_Deserialise(benchmark::State &state)
+{
+  auto const block = CreateBlock(static_cast<std::size_t>(state.range(0)));
+
+  MsgPackSerializer serializer{};
+  serializer.Append(block);
+
+  std::size_t const allocations_before = heap_allocations;
+
+  for (auto _ : state)
+  {
+    MsgPackSerializer reader{serializer.data()};
+
+    Block output{};
+    reader >> output;
+
+    benchmark::DoNotOptimize(output.slices.size());
+  }
+
+  state.counters["allocs_per_block"] =
+      static_cast<double>(heap_allocations - allocations_before) /
+      static_cast<double>(state.iterations());
+}
+
+void Block_DeserialiseArena(benchmark::State &state)
+{
+  auto const block = CreateBlock(static_cast<std::size_t>(state.range(0)));
+
+  MsgPackSerializer serializer{};
+  serializer.Append(block);
+
+  std::size_t const allocations_before = heap_allocations;
+
+  for (auto _ : state)
+  {
+    MsgPackSerializer reader{serializer.data()};
+
+    // all the arrays of the block are carved out of a handful of arena chunks
+    Arena      arena{};
+    ArenaScope scope{arena};
+
+    Block output{};
+    reader >> output;
+
+    benchmark::DoNotOptimize(output.slices.size());
+  }
+
+  state.counters["allocs_per_block"] =
+      static_cast<double>(heap_allocations - allocations_before) /
+      static_cast<double>(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(Block_SerialiseStreaming)->Arg(1000)->Arg(10000);
+BENCHMARK(Block_SerialisePrecomputed)->Arg(1000)->Arg(10000);
+BENCHMARK(Block_SerialiseLargeObjectHelper)->Arg(1000)->Arg(10000);
+BENCHMARK(Block_Deserialise)->Arg(1000)->Arg(10000);
+BENCHMARK(Block_DeserialiseArena)->Arg(1000)->Arg(10000);
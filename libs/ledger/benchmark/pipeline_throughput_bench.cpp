@@ -0,0 +1,291 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "core/digest.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/mcl_dkg.hpp"
+#include "ledger/block_sink_interface.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_coordinator.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/consensus/simulated_pow_consensus.hpp"
+#include "ledger/execution_manager.hpp"
+#include "ledger/executor.hpp"
+#include "ledger/miner/basic_miner.hpp"
+#include "ledger/storage_unit/fake_storage_unit.hpp"
+#include "ledger/storage_unit/transaction_sinks.hpp"
+#include "ledger/transaction_status_cache.hpp"
+#include "ledger/transaction_verifier.hpp"
+#include "tx_generation.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::Digest;
+using fetch::DigestMap;
+using fetch::chain::TransactionLayout;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::BasicMiner;
+using fetch::ledger::Block;
+using fetch::ledger::BlockCoordinator;
+using fetch::ledger::BlockSinkInterface;
+using fetch::ledger::ExecutionManager;
+using fetch::ledger::Executor;
+using fetch::ledger::FakeStorageUnit;
+using fetch::ledger::MainChain;
+using fetch::ledger::SimulatedPowConsensus;
+using fetch::ledger::TransactionSink;
+using fetch::ledger::TransactionStatusCache;
+using fetch::ledger::TransactionVerifier;
+
+using Clock     = std::chrono::steady_clock;
+using Timestamp = Clock::time_point;
+using Latencies = std::vector<double>;
+
+constexpr std::size_t BATCH_SIZE        = 2000;
+constexpr uint64_t    BLOCK_INTERVAL_MS = 0;  // blocks are only generated on demand
+constexpr auto        BATCH_TIMEOUT     = std::chrono::seconds{120};
+
+/**
+ * Verified transactions are handed to the storage unit and the miner, as the main chain node does
+ */
+class VerifiedSink : public TransactionSink
+{
+public:
+  VerifiedSink(FakeStorageUnit &storage, BasicMiner &miner)
+    : storage_{storage}
+    , miner_{miner}
+  {}
+
+  void OnTransaction(TransactionPtr const &tx) override
+  {
+    storage_.AddTransaction(*tx);
+    miner_.EnqueueTransaction(*tx);
+    ++verified_;
+  }
+
+  std::size_t verified() const
+  {
+    return verified_;
+  }
+
+private:
+  FakeStorageUnit &        storage_;
+  BasicMiner &             miner_;
+  std::atomic<std::size_t> verified_{0};
+};
+
+/**
+ * Records the confirmation latency of every submitted transaction as its executed block is
+ * transmitted by the block coordinator
+ */
+class ConfirmationSink : public BlockSinkInterface
+{
+public:
+  void Submitted(Digest const &digest)
+  {
+    submitted_[digest] = Clock::now();
+  }
+
+  void OnBlock(Block const &block) override
+  {
+    auto const now = Clock::now();
+
+    ++blocks_;
+    for (auto const &slice : block.slices)
+    {
+      for (TransactionLayout const &layout : slice)
+      {
+        auto it = submitted_.find(layout.digest());
+        if (it != submitted_.end())
+        {
+          latencies_.push_back(std::chrono::duration<double, std::milli>(now - it->second).count());
+          submitted_.erase(it);
+        }
+      }
+    }
+  }
+
+  std::size_t pending() const
+  {
+    return submitted_.size();
+  }
+
+  std::size_t blocks() const
+  {
+    return blocks_;
+  }
+
+  Latencies &latencies()
+  {
+    return latencies_;
+  }
+
+private:
+  DigestMap<Timestamp> submitted_{};
+  Latencies            latencies_{};
+  std::size_t          blocks_{0};
+};
+
+double Percentile(Latencies &latencies, double fraction)
+{
+  if (latencies.empty())
+  {
+    return 0.0;
+  }
+
+  auto const index = std::min(latencies.size() - 1,
+                              static_cast<std::size_t>(fraction * double(latencies.size())));
+  std::nth_element(latencies.begin(), latencies.begin() + static_cast<std::ptrdiff_t>(index),
+                   latencies.end());
+  return latencies[index];
+}
+
+/**
+ * Drives batches of transactions through a single node pipeline: verifier, storage unit, miner,
+ * block coordinator and execution manager, ending with the block being committed and transmitted.
+ *
+ * Arguments are the log2 number of lanes, the number of slices and the number of executors. The
+ * counters report the sustained transaction rate, the end to end confirmation latencies and the
+ * largest queue depths observed in front of the verifier and the miner. Use
+ * --benchmark_format=json to track them.
+ */
+void Ledger_PipelineThroughput(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::chain::InitialiseTestConstants();
+
+  auto const log2_num_lanes = static_cast<uint32_t>(state.range(0));
+  auto const num_slices     = static_cast<std::size_t>(state.range(1));
+  auto const num_executors  = static_cast<std::size_t>(state.range(2));
+
+  auto const signer  = std::make_shared<ECDSASigner>();
+  auto const storage = std::make_shared<FakeStorageUnit>();
+
+  MainChain  chain{MainChain::Mode::IN_MEMORY_DB};
+  BasicMiner miner{log2_num_lanes};
+
+  auto const execution_manager = std::make_shared<ExecutionManager>(
+      num_executors, log2_num_lanes, storage,
+      [](ExecutionManager::StorageUnitPtr const &storage_unit) {
+        return std::make_shared<Executor>(storage_unit);
+      },
+      TransactionStatusCache::factory());
+
+  auto const consensus =
+      std::make_shared<SimulatedPowConsensus>(signer->identity(), BLOCK_INTERVAL_MS, chain);
+
+  ConfirmationSink confirmations{};
+  VerifiedSink     verified{*storage, miner};
+
+  BlockCoordinator coordinator(chain, BlockCoordinator::DAGPtr{}, *execution_manager, *storage,
+                               miner, confirmations, signer, log2_num_lanes, num_slices,
+                               consensus, nullptr);
+
+  TransactionVerifier verifier{verified, std::thread::hardware_concurrency(), "Verifier"};
+
+  execution_manager->Start();
+  verifier.Start();
+
+  std::size_t submitted{0};
+  std::size_t max_verifier_queue{0};
+  uint64_t    max_miner_backlog{0};
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto const txs = GenerateTransactions(BATCH_SIZE, *signer);
+    state.ResumeTiming();
+
+    for (auto const &tx : txs)
+    {
+      confirmations.Submitted(tx->digest());
+      verifier.AddTransaction(tx);
+    }
+    submitted += txs.size();
+
+    auto const deadline = Clock::now() + BATCH_TIMEOUT;
+    while (confirmations.pending() > 0)
+    {
+      auto const backlog = miner.GetBacklog();
+
+      max_verifier_queue = std::max(max_verifier_queue, submitted - verified.verified());
+      max_miner_backlog  = std::max(max_miner_backlog, backlog);
+
+      if ((coordinator.GetStateMachine().state() == BlockCoordinator::State::SYNCHRONISED) &&
+          (backlog > 0))
+      {
+        consensus->TriggerBlockGeneration();
+      }
+
+      coordinator.GetRunnable().Execute();
+
+      if (Clock::now() > deadline)
+      {
+        state.SkipWithError("Transactions were not confirmed in time");
+        break;
+      }
+    }
+  }
+
+  verifier.Stop();
+  execution_manager->Stop();
+
+  auto &latencies = confirmations.latencies();
+
+  state.SetItemsProcessed(static_cast<int64_t>(latencies.size()));
+  state.counters["tps"] = benchmark::Counter(double(latencies.size()), benchmark::Counter::kIsRate);
+  state.counters["p50_latency_ms"]     = Percentile(latencies, 0.50);
+  state.counters["p99_latency_ms"]     = Percentile(latencies, 0.99);
+  state.counters["max_verifier_queue"] = double(max_verifier_queue);
+  state.counters["max_miner_backlog"]  = double(max_miner_backlog);
+  state.counters["blocks"]             = double(confirmations.blocks());
+}
+
+void PipelineConfigurations(benchmark::internal::Benchmark *b)
+{
+  for (int log2_num_lanes : {0, 2, 4})
+  {
+    for (int num_slices : {1, 16, 64})
+    {
+      for (int num_executors : {1, 4})
+      {
+        b->Args({log2_num_lanes, num_slices, num_executors});
+      }
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(Ledger_PipelineThroughput)
+    ->Apply(PipelineConfigurations)
+    ->ArgNames({"log2_lanes", "slices", "executors"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
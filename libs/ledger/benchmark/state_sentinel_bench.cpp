@@ -51,6 +51,87 @@ void StateSentinelAdapter_BasicBenchmark(benchmark::State &state)
   }
 }
 
+void StateSentinelAdapter_WriteBenchmark(benchmark::State &state)
+{
+  InMemoryStorageUnit storage{};
+
+  BitVector shards{1};
+  shards.SetAllOne();
+
+  StateSentinelAdapter adapter{storage, "foo.bar", shards};
+
+  std::string          key{"baz"};
+  std::vector<uint8_t> buffer(256);
+
+  for (auto _ : state)
+  {
+    adapter.Write(key, buffer.data(), buffer.size());
+  }
+}
+
+// A contract invocation which accesses each of its keys once, i.e. every key has to be resolved
+void StateSentinelAdapter_FirstAccessBenchmark(benchmark::State &state)
+{
+  InMemoryStorageUnit storage{};
+
+  BitVector shards{1};
+  shards.SetAllOne();
+
+  std::vector<std::string> keys{};
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    keys.emplace_back("balance." + std::to_string(i));
+  }
+
+  std::vector<uint8_t> buffer(256);
+
+  for (auto _ : state)
+  {
+    StateSentinelAdapter adapter{storage, "foo.bar", shards};
+
+    for (auto const &key : keys)
+    {
+      uint64_t size = buffer.size();
+      adapter.Read(key, buffer.data(), size);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// A contract invocation which accesses each of its keys repeatedly, e.g. in a loop
+void StateSentinelAdapter_RepeatedAccessBenchmark(benchmark::State &state)
+{
+  InMemoryStorageUnit storage{};
+
+  BitVector shards{1};
+  shards.SetAllOne();
+
+  StateSentinelAdapter adapter{storage, "foo.bar", shards};
+
+  std::vector<std::string> keys{};
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    keys.emplace_back("balance." + std::to_string(i));
+  }
+
+  std::vector<uint8_t> buffer(256);
+
+  for (auto _ : state)
+  {
+    for (auto const &key : keys)
+    {
+      uint64_t size = buffer.size();
+      adapter.Read(key, buffer.data(), size);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 }  // namespace
 
 BENCHMARK(StateSentinelAdapter_BasicBenchmark);
+BENCHMARK(StateSentinelAdapter_WriteBenchmark);
+BENCHMARK(StateSentinelAdapter_FirstAccessBenchmark)->Range(8, 512);
+BENCHMARK(StateSentinelAdapter_RepeatedAccessBenchmark)->Range(8, 512);
@@ -19,8 +19,10 @@
 
 #include "chain/transaction.hpp"
 #include "chain/transaction_builder.hpp"
+#include "chain/transaction_serializer.hpp"
 #include "core/random/lcg.hpp"
 #include "crypto/ecdsa.hpp"
+#include "ledger/transaction_stream.hpp"
 #include "meta/type_traits.hpp"
 
 #include <cstdint>
@@ -77,3 +79,23 @@ inline TransactionList GenerateTransactions(std::size_t count, ECDSASigner const
 
   return list;
 }
+
+/**
+ * Generate a load of transactions in the streamed submission format, as it would be posted to the
+ * contract HTTP interface
+ */
+inline ByteArray GenerateTransactionStream(std::size_t count, ECDSASigner const &signer,
+                                           bool large_packets = false)
+{
+  fetch::ledger::TransactionStreamWriter writer;
+
+  for (auto const &tx : GenerateTransactions(count, signer, large_packets))
+  {
+    fetch::chain::TransactionSerializer serializer{};
+    serializer << *tx;
+
+    writer.Append(serializer.data());
+  }
+
+  return writer.stream();
+}
@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "chain/transaction_serializer.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/transaction_stream.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include "tx_generation.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::chain::TransactionSerializer;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::TransactionStreamReader;
+using fetch::serializers::MsgPackSerializer;
+
+void TxStreamGeneration(benchmark::State &state)
+{
+  ECDSASigner const signer;
+
+  for (auto _ : state)
+  {
+    auto const stream = GenerateTransactionStream(static_cast<std::size_t>(state.range(0)), signer);
+    benchmark::DoNotOptimize(stream);
+  }
+}
+
+void TxStreamDecode(benchmark::State &state)
+{
+  ECDSASigner const signer;
+
+  auto const stream = GenerateTransactionStream(static_cast<std::size_t>(state.range(0)), signer);
+
+  for (auto _ : state)
+  {
+    TransactionStreamReader reader{stream};
+
+    ConstByteArray encoded_tx;
+    while (reader.Next(encoded_tx))
+    {
+      Transaction           tx;
+      TransactionSerializer serializer{encoded_tx};
+      serializer >> tx;
+
+      benchmark::DoNotOptimize(tx);
+    }
+  }
+}
+
+void TxBulkDecode(benchmark::State &state)
+{
+  ECDSASigner const signer;
+
+  // the same transactions in the existing bulk format
+  std::vector<ConstByteArray> encoded_txs;
+  for (auto const &tx : GenerateTransactions(static_cast<std::size_t>(state.range(0)), signer))
+  {
+    TransactionSerializer serializer{};
+    serializer << *tx;
+    encoded_txs.emplace_back(serializer.data());
+  }
+
+  MsgPackSerializer bulk;
+  bulk << encoded_txs;
+  ConstByteArray const body = bulk.data();
+
+  for (auto _ : state)
+  {
+    std::vector<ConstByteArray> decoded;
+    MsgPackSerializer           buffer{body};
+    buffer >> decoded;
+
+    for (auto const &encoded_tx : decoded)
+    {
+      Transaction           tx;
+      TransactionSerializer serializer{encoded_tx};
+      serializer >> tx;
+
+      benchmark::DoNotOptimize(tx);
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(TxStreamGeneration)->Range(100, 10000);
+BENCHMARK(TxStreamDecode)->Range(100, 10000);
+BENCHMARK(TxBulkDecode)->Range(100, 10000);
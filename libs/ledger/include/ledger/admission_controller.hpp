@@ -0,0 +1,103 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "core/mutex.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Decides whether newly submitted transactions are accepted, based on the load of the stages
+ * which process them.
+ *
+ * Each stage reports its load as the fraction of its capacity in use. Below the shedding threshold
+ * every transaction is admitted and once any stage is full every transaction is refused. In between
+ * transactions are shed in order of fee: a transaction is admitted when its charge rate is above a
+ * quantile of the charge rates recently admitted, the quantile rising with the load. Transactions
+ * which pay exactly that charge rate are admitted in proportion to the remaining capacity, so that
+ * the throughput degrades gradually even when every transaction pays the same.
+ */
+class AdmissionController
+{
+public:
+  using LoadFunction = std::function<double()>;
+  using TokenAmount  = chain::Transaction::TokenAmount;
+
+  static constexpr double      DEFAULT_SHEDDING_THRESHOLD = 0.5;
+  static constexpr std::size_t CHARGE_RATE_HISTORY        = 1024;
+  static constexpr uint64_t    MAX_RETRY_AFTER_SECONDS    = 30;
+
+  // Construction / Destruction
+  explicit AdmissionController(double shedding_threshold = DEFAULT_SHEDDING_THRESHOLD);
+  AdmissionController(AdmissionController const &) = delete;
+  AdmissionController(AdmissionController &&)      = delete;
+  ~AdmissionController()                           = default;
+
+  /// @name Load
+  /// @{
+  void   AddStage(std::string const &name, LoadFunction load);
+  double GetLoad() const;
+  /// @}
+
+  /// @name Admission
+  /// @{
+  bool                 Admit(chain::Transaction const &tx);
+  std::chrono::seconds GetRetryAfter() const;
+  /// @}
+
+  // Operators
+  AdmissionController &operator=(AdmissionController const &) = delete;
+  AdmissionController &operator=(AdmissionController &&) = delete;
+
+private:
+  struct Stage
+  {
+    std::string  name;
+    LoadFunction load;
+  };
+
+  using Stages      = std::vector<Stage>;
+  using ChargeRates = std::deque<TokenAmount>;
+
+  TokenAmount RequiredChargeRate(double shed_fraction) const;
+  void        RecordAdmitted(TokenAmount charge_rate);
+
+  double const shedding_threshold_;
+
+  mutable Mutex lock_;
+  Stages        stages_{};
+  ChargeRates   admitted_charge_rates_{};  ///< The most recently admitted, oldest first
+  double        credit_{0.0};  ///< Accumulated admissions of transactions at the quantile
+
+  telemetry::GaugePtr<double> load_;
+  telemetry::CounterPtr       admitted_total_;
+  telemetry::CounterPtr       shed_total_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
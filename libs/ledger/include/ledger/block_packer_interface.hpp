@@ -81,6 +81,16 @@ public:
    * @return: number of transactions
    */
   virtual uint64_t GetBacklog() const = 0;
+
+  /**
+   * Discard the queued transactions which can not be included in the specified block, or any
+   * later one, since their validity period has ended. Packers which do not queue transactions
+   * can ignore this.
+   *
+   * @param block_index The index of the next block to be packed
+   */
+  virtual void RemoveExpired(uint64_t /*block_index*/)
+  {}
   /// @}
 };
 
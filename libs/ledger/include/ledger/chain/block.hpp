@@ -81,6 +81,8 @@ public:
   bool     is_loose     = false;
   uint64_t chain_label{0};  ///< The label of a heaviest chain this block once belonged to
                             ///< A more detailed explanation in MainChain::HeaviestTip.
+  Digest   skip_hash;       ///< The hash of an earlier ancestor (see MainChain::GetSkipHeight)
+                            ///< used to look up ancestors in O(log n) blocks. Empty if unknown.
   /// @}
 
   // Helper functions
@@ -0,0 +1,100 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "core/mutex.hpp"
+#include "ledger/chain/block.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Least recently used cache of blocks read back from the block store, bounded by the approximate
+ * number of bytes held. The blocks are kept together with the hash of the next block on the stored
+ * chain as recorded alongside them.
+ */
+class BlockCache
+{
+public:
+  using BlockHash = Digest;
+  using BlockPtr  = std::shared_ptr<Block const>;
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 64ull << 20u;
+
+  // Construction / Destruction
+  explicit BlockCache(std::size_t capacity = DEFAULT_CAPACITY);
+  BlockCache(BlockCache const &) = delete;
+  BlockCache(BlockCache &&)      = delete;
+  ~BlockCache()                  = default;
+
+  /// @name Cache Access
+  /// @{
+  bool Get(BlockHash const &hash, BlockPtr &block, BlockHash &next_hash);
+  void Add(BlockPtr block, BlockHash next_hash);
+  void Erase(BlockHash const &hash);
+  void Clear();
+  /// @}
+
+  /// @name Capacity
+  /// @{
+  std::size_t capacity() const;
+  std::size_t size_in_bytes() const;
+  void        SetCapacity(std::size_t capacity);
+  /// @}
+
+  static std::size_t EstimateSize(Block const &block);
+
+  // Operators
+  BlockCache &operator=(BlockCache const &) = delete;
+  BlockCache &operator=(BlockCache &&) = delete;
+
+private:
+  struct Entry
+  {
+    BlockPtr    block;
+    BlockHash   next_hash;
+    std::size_t size;
+  };
+
+  using EntryList = std::list<Entry>;
+  using EntryMap  = DigestMap<EntryList::iterator>;
+
+  void EraseEntry(EntryList::iterator it);
+  void Evict();
+
+  mutable Mutex lock_;
+  EntryList     entries_{};  ///< Most recently used first
+  EntryMap      index_{};
+  std::size_t   capacity_;
+  std::size_t   size_{0};
+
+  telemetry::CounterPtr            hits_;
+  telemetry::CounterPtr            misses_;
+  telemetry::GaugePtr<std::size_t> bytes_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -32,12 +32,15 @@
 #include "ledger/upow/synergetic_miner_interface.hpp"
 #include "moment/deadline_timer.hpp"
 #include "telemetry/telemetry.hpp"
+#include "vectorise/threading/pool.hpp"
 
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <functional>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -139,6 +142,9 @@ class BlockSinkInterface;
  *                                  │                  │────────────────────────────────┘
  *                                  └──────────────────┘
  *
+ * While catching up on a long run of blocks, the blocks which follow the current block are prepared
+ * ahead of time: requests are issued for their missing transactions and their notarisations are
+ * verified on a worker thread while the current block is waiting for transactions or executing.
  */
 class BlockCoordinator
 {
@@ -178,6 +184,7 @@ public:
   };
   using StateMachine         = core::StateMachine<State>;
   using SynergeticExecMgrPtr = std::unique_ptr<SynergeticExecutionManagerInterface>;
+  using WakeCallback         = std::function<void()>;
 
   static char const *ToString(State state);
 
@@ -189,7 +196,7 @@ public:
                    SynergeticExecMgrPtr synergetic_exec_manager);
   BlockCoordinator(BlockCoordinator const &) = delete;
   BlockCoordinator(BlockCoordinator &&)      = delete;
-  ~BlockCoordinator()                        = default;
+  ~BlockCoordinator();
 
   std::weak_ptr<core::Runnable> GetWeakRunnable()
   {
@@ -234,6 +241,8 @@ public:
   void Reset();
   void ResetGenesis();
 
+  void SetWakeCallback(WakeCallback callback);
+
   // Operators
   BlockCoordinator &operator=(BlockCoordinator const &) = delete;
   BlockCoordinator &operator=(BlockCoordinator &&) = delete;
@@ -247,7 +256,8 @@ private:
     ERROR
   };
 
-  static constexpr uint64_t COMMON_PATH_TO_ANCESTOR_LENGTH_LIMIT = 5000;
+  static constexpr uint64_t    COMMON_PATH_TO_ANCESTOR_LENGTH_LIMIT = 5000;
+  static constexpr std::size_t PIPELINE_DEPTH                       = 16;
 
   using BlockPtr          = MainChain::BlockPtr;
   using NextBlockPtr      = std::unique_ptr<Block>;
@@ -263,6 +273,7 @@ private:
   using FutureTimepoint   = fetch::core::FutureTimepoint;
   using DeadlineTimer     = fetch::moment::DeadlineTimer;
   using SynExecStatus     = SynergeticExecutionManagerInterface::ExecStatus;
+  using ThreadPool        = threading::Pool;
 
   /// @name Monitor State
   /// @{
@@ -292,6 +303,9 @@ private:
   bool            ScheduleBlock(Block const &block);
   ExecutionStatus QueryExecutorStatus();
   void            RemoveBlock(MainChain::BlockHash const &hash);
+  void            RemoveExpiredTransactions(Block const &committed_block);
+  void            PrepareUpcomingBlocks();
+  void            Wake(State waiting_state);
 
   static char const *ToString(ExecutionStatus state);
 
@@ -311,7 +325,8 @@ private:
 
   /// @name Status
   /// @{
-  LastExecutedBlock last_executed_block_;
+  LastExecutedBlock       last_executed_block_;
+  Protected<WakeCallback> wake_callback_{};  ///< Wakes the reactor running the state machine
   /// @}
 
   /// @name State Machine State
@@ -343,6 +358,13 @@ private:
   SynergeticExecMgrPtr synergetic_exec_mgr_;
   /// }
 
+  /// @name Catch-up Pipeline
+  /// @{
+  ThreadPool        prepare_pool_{1, "BlockPrep"};  ///< Worker for preparing upcoming blocks
+  std::future<void> prepare_result_{};              ///< The in flight preparation (if any)
+  DigestSet         prepared_blocks_{};             ///< The upcoming blocks already prepared
+  /// @}
+
   /// @name Telemetry
   /// @{
   telemetry::CounterPtr         reload_state_count_;
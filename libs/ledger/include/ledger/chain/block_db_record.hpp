@@ -31,6 +31,8 @@ struct BlockDbRecord
   Block block;
   // empty next hash is used as undefined value
   Block::Hash next_hash;
+  // the skip pointer of the block, which is not part of the serialised block
+  Block::Hash skip_hash;
 
   Block::Hash hash() const
   {
@@ -54,13 +56,15 @@ public:
 
   static uint8_t const BLOCK     = 1;
   static uint8_t const NEXT_HASH = 2;
+  static uint8_t const SKIP_HASH = 3;
 
   template <typename Constructor>
   static void Serialize(Constructor &map_constructor, Type const &dbRecord)
   {
-    auto map = map_constructor(2);
+    auto map = map_constructor(3);
     map.Append(BLOCK, dbRecord.block);
     map.Append(NEXT_HASH, dbRecord.next_hash);
+    map.Append(SKIP_HASH, dbRecord.skip_hash);
   }
 
   template <typename MapDeserializer>
@@ -68,6 +72,12 @@ public:
   {
     map.ExpectKeyGetValue(BLOCK, dbRecord.block);
     map.ExpectKeyGetValue(NEXT_HASH, dbRecord.next_hash);
+
+    // records written before skip pointers were introduced do not have one
+    if (map.size() > 2)
+    {
+      map.ExpectKeyGetValue(SKIP_HASH, dbRecord.skip_hash);
+    }
   }
 };
 
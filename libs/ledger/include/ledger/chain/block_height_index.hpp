@@ -0,0 +1,72 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "core/mutex.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * File backed map from block number to the hash of the block at that height on the chain stored
+ * on disk. Entries are fixed size records so that any height is found with a single read.
+ *
+ * The file starts with the number of heights in the index followed by one hash per height.
+ */
+class BlockHeightIndex
+{
+public:
+  using BlockHash = Digest;
+
+  // Construction / Destruction
+  BlockHeightIndex()                         = default;
+  BlockHeightIndex(BlockHeightIndex const &) = delete;
+  BlockHeightIndex(BlockHeightIndex &&)      = delete;
+  ~BlockHeightIndex()                        = default;
+
+  void New(std::string const &filename);
+  void Load(std::string const &filename);
+
+  /// @name Index Access
+  /// @{
+  uint64_t size() const;
+  bool     Get(uint64_t height, BlockHash &hash) const;
+  void     Set(uint64_t height, BlockHash const &hash);
+  void     Truncate(uint64_t size);
+  void     Flush();
+  /// @}
+
+  // Operators
+  BlockHeightIndex &operator=(BlockHeightIndex const &) = delete;
+  BlockHeightIndex &operator=(BlockHeightIndex &&) = delete;
+
+private:
+  void WriteSize();
+
+  mutable Mutex        lock_;
+  mutable std::fstream file_;
+  uint64_t             size_{0};
+};
+
+}  // namespace ledger
+}  // namespace fetch
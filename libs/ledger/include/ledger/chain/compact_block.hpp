@@ -0,0 +1,136 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/digest.hpp"
+#include "core/mutex.hpp"
+#include "core/serializers/base_types.hpp"
+#include "ledger/chain/block.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+using ShortTransactionId = uint64_t;
+
+/**
+ * A block as it is relayed to peers which are expected to have seen most of its transactions
+ * already. The transaction layouts of the slices are replaced by short transaction ids, from which
+ * the receiver rebuilds the block, requesting only the layouts it does not know.
+ *
+ * Short ids are truncated digests, so a receiver can match the wrong transaction. This is detected
+ * when the digest of the rebuilt block is compared against the hash of the header.
+ */
+struct CompactBlock
+{
+  using SliceSizes = std::vector<uint32_t>;
+  using ShortIds   = std::vector<ShortTransactionId>;
+
+  Block      header{};       ///< The block without the transactions of its slices
+  SliceSizes slice_sizes{};  ///< The number of transactions in each slice
+  ShortIds   short_ids{};    ///< The short ids of the transactions, in slice order
+};
+
+using TransactionLayouts = std::vector<chain::TransactionLayout>;
+using BlockPositions     = std::vector<uint32_t>;
+using LayoutLookup       = std::function<bool(ShortTransactionId, chain::TransactionLayout &)>;
+
+ShortTransactionId ToShortId(Digest const &digest);
+CompactBlock       ToCompactBlock(Block const &block);
+
+BlockPositions     ReconstructBlock(CompactBlock const &compact, LayoutLookup const &lookup,
+                                    Block &block);
+bool               CompleteBlock(Block &block, BlockPositions const &positions,
+                                 TransactionLayouts const &layouts);
+TransactionLayouts GetTransactionLayouts(Block const &block, BlockPositions const &positions);
+
+/**
+ * Bounded index of the most recently seen transaction layouts by short id, used to rebuild compact
+ * blocks. Once full, the oldest layouts are forgotten first.
+ */
+class ShortIdIndex
+{
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 1u << 18u;
+
+  // Construction / Destruction
+  explicit ShortIdIndex(std::size_t capacity = DEFAULT_CAPACITY);
+  ShortIdIndex(ShortIdIndex const &) = delete;
+  ShortIdIndex(ShortIdIndex &&)      = delete;
+  ~ShortIdIndex()                    = default;
+
+  void        Add(chain::TransactionLayout const &layout);
+  bool        Lookup(ShortTransactionId id, chain::TransactionLayout &layout) const;
+  std::size_t size() const;
+
+  // Operators
+  ShortIdIndex &operator=(ShortIdIndex const &) = delete;
+  ShortIdIndex &operator=(ShortIdIndex &&) = delete;
+
+private:
+  using Layouts = std::unordered_map<ShortTransactionId, chain::TransactionLayout>;
+  using Order   = std::deque<ShortTransactionId>;
+
+  std::size_t const capacity_;
+  mutable Mutex     lock_;
+  Layouts           layouts_{};
+  Order             order_{};  ///< Short ids in the order they were added, oldest first
+};
+
+}  // namespace ledger
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<ledger::CompactBlock, D>
+{
+public:
+  using Type       = ledger::CompactBlock;
+  using DriverType = D;
+
+  static uint8_t const HEADER      = 1;
+  static uint8_t const SLICE_SIZES = 2;
+  static uint8_t const SHORT_IDS   = 3;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &compact)
+  {
+    auto map = map_constructor(3);
+    map.Append(HEADER, compact.header);
+    map.Append(SLICE_SIZES, compact.slice_sizes);
+    map.Append(SHORT_IDS, compact.short_ids);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &compact)
+  {
+    map.ExpectKeyGetValue(HEADER, compact.header);
+    map.ExpectKeyGetValue(SLICE_SIZES, compact.slice_sizes);
+    map.ExpectKeyGetValue(SHORT_IDS, compact.short_ids);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
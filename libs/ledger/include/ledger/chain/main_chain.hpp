@@ -26,6 +26,8 @@
 #include "core/mutex.hpp"
 #include "crypto/fnv.hpp"
 #include "ledger/chain/block.hpp"
+#include "ledger/chain/block_cache.hpp"
+#include "ledger/chain/block_height_index.hpp"
 #include "meta/type_util.hpp"
 #include "network/generics/milli_timer.hpp"
 #include "storage/object_store.hpp"
@@ -34,6 +36,7 @@
 
 #include <cstdint>
 #include <fstream>
+#include <limits>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -158,7 +161,8 @@ public:
   };
 
   // Construction / Destruction
-  explicit MainChain(Mode mode = Mode::IN_MEMORY_DB, bool dirty_block_functionality = false);
+  explicit MainChain(Mode mode = Mode::IN_MEMORY_DB, bool dirty_block_functionality = false,
+                     std::size_t block_cache_capacity = BlockCache::DEFAULT_CAPACITY);
   MainChain(MainChain const &rhs) = delete;
   MainChain(MainChain &&rhs)      = delete;
   ~MainChain();
@@ -174,16 +178,19 @@ public:
 
   /// @name Chain Queries
   /// @{
-  BlockPtr   GetHeaviestBlock() const;
-  BlockHash  GetHeaviestBlockHash() const;
-  Blocks     GetHeaviestChain(uint64_t limit = UPPER_BOUND) const;
-  Blocks     GetChainPreceding(BlockHash start, uint64_t limit = UPPER_BOUND) const;
-  Travelogue TimeTravel(BlockHash current_hash) const;
-  bool       GetPathToCommonAncestor(
-            Blocks &blocks, BlockHash tip_hash, BlockHash node_hash, uint64_t limit = UPPER_BOUND,
-            BehaviourWhenLimit behaviour = BehaviourWhenLimit::RETURN_MOST_RECENT) const;
+  BlockPtr    GetHeaviestBlock() const;
+  BlockHash   GetHeaviestBlockHash() const;
+  Blocks      GetHeaviestChain(uint64_t limit = UPPER_BOUND) const;
+  Blocks      GetChainPreceding(BlockHash start, uint64_t limit = UPPER_BOUND) const;
+  Travelogue  TimeTravel(BlockHash current_hash) const;
+  BlockHashes GetChainSkeleton(uint64_t start, uint64_t stride, uint64_t limit) const;
+  bool        GetPathToCommonAncestor(
+             Blocks &blocks, BlockHash tip_hash, BlockHash node_hash, uint64_t limit = UPPER_BOUND,
+             BehaviourWhenLimit behaviour = BehaviourWhenLimit::RETURN_MOST_RECENT) const;
   /// @}
 
+  static uint64_t GetSkipHeight(uint64_t block_number);
+
   /// @name Tips
   /// @{
   BlockHashSet GetTips() const;
@@ -197,6 +204,12 @@ public:
   bool         HasMissingBlocks() const;
   /// @}
 
+  /// @name Memory Management
+  /// @{
+  std::size_t GetCacheSizeInBytes() const;
+  void        ReleaseCache();
+  /// @}
+
   /// @name Transaction Duplication Filtering
   /// @{
   DigestSet DetectDuplicateTransactions(BlockHash const &           starting_hash,
@@ -209,6 +222,7 @@ public:
 
   using DbRecord      = BlockDbRecord;
   using IntBlockPtr   = std::shared_ptr<Block>;
+  using IntBlockPtrs  = std::vector<IntBlockPtr>;
   using BlockMap      = std::unordered_map<BlockHash, IntBlockPtr>;
   using References    = std::unordered_multimap<BlockHash, BlockHash>;
   using TipsMap       = std::unordered_map<BlockHash, Tip>;
@@ -281,6 +295,44 @@ public:
   bool LookupReference(BlockHash const &hash, BlockHash &next_hash) const;
   /// @}t
 
+  /// @name Ancestor Lookup
+  /// @{
+  static constexpr std::size_t SKIP_FALLBACK_STEP_LIMIT = 1024;
+
+  IntBlockPtr GetAncestor(
+      IntBlockPtr block, uint64_t block_number,
+      std::size_t max_fallback_steps = std::numeric_limits<std::size_t>::max()) const;
+  IntBlockPtr GetCommonAncestor(IntBlockPtr left, IntBlockPtr right) const;
+  /// @}
+
+  /// @name Heaviest Chain Snapshot
+  /// @{
+  static constexpr std::size_t HEAVIEST_CHAIN_SNAPSHOT_DEPTH = 1000;
+
+  struct ChainSnapshot
+  {
+    Blocks                                     blocks{};  ///< The heaviest chain, tip first
+    std::unordered_map<BlockHash, std::size_t> index{};   ///< Map of block hash to position
+  };
+
+  using ChainSnapshotPtr = std::shared_ptr<ChainSnapshot const>;
+
+  void     PublishHeaviestChain();
+  bool     ReadChainSnapshot(ChainSnapshot const &snapshot, BlockHash const &start, uint64_t limit,
+                             Blocks &blocks) const;
+  BlockPtr ReadSnapshotBlock(BlockHash const &hash) const;
+  /// @}
+
+  /// @name Duplicate Transaction Search
+  /// @{
+  static constexpr std::size_t DUPLICATE_SEARCH_SEGMENT_LENGTH = 1024;
+  static constexpr std::size_t DUPLICATE_SEARCH_MIN_BLOCKS     = 128;
+
+  static void     SearchForDuplicates(IntBlockPtrs const &segment,
+                                      DigestSet const &transaction_digests, DigestSet &duplicates);
+  static uint64_t EarliestInclusionBlock(chain::TransactionLayout const &tx_layout);
+  /// @}
+
   /// @name Low-level storage interface
   /// @{
   void                CacheBlock(IntBlockPtr const &block) const;
@@ -308,11 +360,13 @@ public:
 
   void FlushToDisk();
 
-  Mode          mode_{Mode::IN_MEMORY_DB};
-  bool const    dirty_block_functionality_;
-  DirtyMap      dirty_map_;
-  BlockStorePtr block_store_;  ///< Long term storage and backup
-  std::fstream  head_store_;
+  Mode               mode_{Mode::IN_MEMORY_DB};
+  bool const         dirty_block_functionality_;
+  DirtyMap           dirty_map_;
+  BlockStorePtr      block_store_;   ///< Long term storage and backup
+  std::fstream       head_store_;
+  BlockHeightIndex   height_index_;  ///< Block number to hash of the chain in block_store_
+  mutable BlockCache block_cache_;   ///< Recently used blocks read back from block_store_
 
   mutable RMutex   lock_;         ///< Mutex protecting block_chain_, tips_ & heaviest_
   mutable BlockMap block_chain_;  ///< All recent blocks are kept in memory
@@ -324,6 +378,8 @@ public:
   LooseBlockMap      loose_blocks_;  ///< Waiting (loose) blocks
   ///< The earliest block known of current heaveiest chain.
   mutable IntBlockPtr labeled_subchain_start_;
+  ///< The last published section of the heaviest chain, accessed atomically
+  ChainSnapshotPtr heaviest_chain_;
 
   mutable ProgressiveBloomFilter   bloom_filter_;
   telemetry::GaugePtr<std::size_t> bloom_filter_queried_bit_count_;
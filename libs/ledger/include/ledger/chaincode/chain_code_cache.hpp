@@ -40,6 +40,11 @@ public:
 
   ContractPtr Lookup(ConstByteArray const &contract_id, StorageInterface &storage);
 
+  static ContractPtr CreateContract(ConstByteArray const &contract_id, StorageInterface &storage,
+                                    bool optimise);
+
+  void EnableOptimisation(bool enable);
+
 private:
   using Clock     = std::chrono::high_resolution_clock;
   using Timepoint = Clock::time_point;
@@ -65,6 +70,7 @@ private:
 
   std::size_t     counter_{};
   UnderlyingCache cache_;
+  bool            optimise_{false};  ///< Flag to signal smart contracts should be optimised
 
   static_assert(meta::IsLog2(CLEANUP_PERIOD), "Clean up period must be a valid power of 2");
 };
@@ -20,8 +20,7 @@
 #include "core/mutex.hpp"
 #include "core/synchronisation/protected.hpp"
 #include "http/module.hpp"
-#include "ledger/chaincode/chain_code_cache.hpp"
-#include "ledger/chaincode/token_contract.hpp"
+#include "ledger/chaincode/contract_query_executor.hpp"
 
 #include <fstream>
 #include <string>
@@ -35,14 +34,21 @@ class Variant;
 
 namespace ledger {
 
+class AdmissionController;
 class StorageInterface;
 class TransactionProcessor;
 
 class ContractHttpInterface : public http::HTTPModule
 {
 public:
+  /// The path of the generic contract query view
+  static constexpr char const *QUERY_PATH =
+      "/api/contract/(identifier=[1-9A-HJ-NP-Za-km-z]{48,50})/(query=.+)";
+
   // Construction / Destruction
-  ContractHttpInterface(StorageInterface &storage, TransactionProcessor &processor);
+  ContractHttpInterface(StorageInterface &storage, TransactionProcessor &processor,
+                        AdmissionController *     admission        = nullptr,
+                        chain::ShardedBalancesPtr sharded_balances = {});
   ContractHttpInterface(ContractHttpInterface const &) = delete;
   ContractHttpInterface(ContractHttpInterface &&)      = delete;
   ~ContractHttpInterface() override                    = default;
@@ -73,6 +79,7 @@ private:
   {
     std::size_t processed{0};
     std::size_t received{0};
+    std::size_t shed{0};  ///< Refused because the node is overloaded
   };
 
   /// @name Query Handler
@@ -87,6 +94,7 @@ private:
                                    ConstByteArray const &   expected_contract);
   SubmitTxStatus     SubmitJsonTx(http::HTTPRequest const &request, TxHashes &txs);
   SubmitTxStatus     SubmitBulkTx(http::HTTPRequest const &request, TxHashes &txs);
+  SubmitTxStatus     SubmitStreamTx(http::HTTPRequest const &request, TxHashes &txs);
   /// @}
 
   /// @name Access Log
@@ -98,10 +106,10 @@ private:
   void WriteToAccessLog(variant::Variant const &entry);
   /// @}
 
-  TokenContract            token_contract_{};
   StorageInterface &       storage_;
   TransactionProcessor &   processor_;
-  ChainCodeCache           contract_cache_{};
+  AdmissionController *    admission_;  ///< Optional, when not set every transaction is accepted
+  ContractQueryExecutor    query_executor_;
   Protected<std::ofstream> access_log_;
 };
 
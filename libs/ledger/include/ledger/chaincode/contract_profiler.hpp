@@ -0,0 +1,96 @@
+#pragma once
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+#include "telemetry/telemetry.hpp"
+#include "vm/profiler.hpp"
+
+#include <atomic>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Process wide collection of smart contract execution profiles, keyed by contract digest.
+ *
+ * Profiling is disabled by default. Once enabled every smart contract invocation is executed with
+ * a VM profiler attached, the result of which is merged into the profile for the contract and
+ * exported as per opcode counters through the telemetry registry. The sampled call stacks can be
+ * written out in the folded stacks format for use with flamegraph tools.
+ */
+class ContractProfiler
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Profiler       = vm::Profiler;
+
+  static ContractProfiler &Instance();
+
+  // Construction / Destruction
+  ContractProfiler()                         = default;
+  ContractProfiler(ContractProfiler const &) = delete;
+  ContractProfiler(ContractProfiler &&)      = delete;
+  ~ContractProfiler()                        = default;
+
+  /// @name Control
+  /// @{
+  void Enable(bool enable);
+  bool IsEnabled() const;
+  void Clear();
+  /// @}
+
+  /// @name Profiles
+  /// @{
+  void     Record(ConstByteArray const &digest, Profiler const &profile);
+  Profiler Lookup(ConstByteArray const &digest) const;
+  void     WriteFoldedStacks(std::ostream &stream) const;
+  /// @}
+
+  // Operators
+  ContractProfiler &operator=(ContractProfiler const &) = delete;
+  ContractProfiler &operator=(ContractProfiler &&) = delete;
+
+private:
+  struct OpcodeCounters
+  {
+    telemetry::CounterPtr count;
+    telemetry::CounterPtr charge;
+    telemetry::CounterPtr duration;
+  };
+
+  using Profiles      = std::map<ConstByteArray, Profiler>;
+  using CounterKey    = std::pair<ConstByteArray, std::string>;
+  using CounterLookup = std::map<CounterKey, OpcodeCounters>;
+
+  OpcodeCounters &LookupCounters(ConstByteArray const &digest, std::string const &opcode);
+
+  std::atomic<bool> enabled_{false};
+  mutable Mutex     lock_;
+  Profiles          profiles_{};  ///< The accumulated profile, per contract digest
+  CounterLookup     counters_{};  ///< The telemetry counters, per contract digest and opcode
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,119 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+#include "crypto/fnv.hpp"  // needed for std::hash<ConstByteArray>
+#include "ledger/chaincode/token_contract.hpp"
+#include "vm/common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+
+namespace variant {
+class Variant;
+}  // namespace variant
+
+namespace ledger {
+
+class Contract;
+class StorageInterface;
+
+/**
+ * Evaluates contract queries concurrently, against the last committed state of the ledger.
+ *
+ * A contract instance can only serve one query at a time, since the context of the query is
+ * attached to it, so queries are given an instance of their own. Instances are kept for the next
+ * query once they are finished with, together with their compiled code and VMs. The number of
+ * concurrent queries to any one contract is limited, so that a single popular contract can not
+ * occupy all of the callers, and so is the charge of each query.
+ */
+class ContractQueryExecutor
+{
+public:
+  using ConstByteArray     = byte_array::ConstByteArray;
+  using Query              = variant::Variant;
+  using ShardedBalancesPtr = chain::ShardedBalancesPtr;
+
+  static constexpr std::size_t DEFAULT_MAX_CONCURRENT_QUERIES = 2;
+  static constexpr std::size_t DEFAULT_MAX_CONTRACTS          = 64;
+
+  enum class Status
+  {
+    OK,
+    NOT_FOUND,  ///< The contract could not be found
+    BUSY,       ///< The contract is already evaluating its maximum number of queries
+    FAILED
+  };
+
+  struct Config
+  {
+    std::size_t        max_concurrent_queries;  ///< The limit for each contract (0 = unlimited)
+    std::size_t        max_contracts;           ///< The number of contracts with instances kept
+    vm::ChargeAmount   charge_limit;            ///< The limit of each smart contract query
+    ShardedBalancesPtr sharded_balances;        ///< The accounts with sharded balances, if any
+  };
+
+  static Config DefaultConfig();
+
+  // Construction / Destruction
+  explicit ContractQueryExecutor(StorageInterface &storage, Config const &config = DefaultConfig());
+  ContractQueryExecutor(ContractQueryExecutor const &) = delete;
+  ContractQueryExecutor(ContractQueryExecutor &&)      = delete;
+  ~ContractQueryExecutor()                             = default;
+
+  Status Execute(ConstByteArray const &contract_name, ConstByteArray const &query,
+                 Query const &request, Query &response);
+
+  std::size_t num_idle(ConstByteArray const &contract_name) const;
+
+  // Operators
+  ContractQueryExecutor &operator=(ContractQueryExecutor const &) = delete;
+  ContractQueryExecutor &operator=(ContractQueryExecutor &&) = delete;
+
+private:
+  using ContractPtr = std::shared_ptr<Contract>;
+
+  struct Instances
+  {
+    std::vector<ContractPtr> idle{};     ///< The instances which are ready for the next query
+    std::size_t              active{0};  ///< The number of queries being evaluated
+    uint64_t                 last_use{0};
+  };
+
+  using InstanceMap = std::unordered_map<ConstByteArray, Instances>;
+
+  ContractPtr Acquire(ConstByteArray const &contract_name, bool &busy);
+  void        Release(ConstByteArray const &contract_name, ContractPtr contract);
+
+  StorageInterface &storage_;
+  Config const      config_;
+  TokenContract     token_contract_;
+  mutable Mutex     lock_;
+  InstanceMap       instances_{};
+  uint64_t          counter_{0};
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,117 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+#include "storage/object_store.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace vm {
+struct Executable;
+}  // namespace vm
+
+namespace ledger {
+
+/**
+ * Process wide, content addressed cache of compiled smart contract executables.
+ *
+ * Executables are keyed by the digest of the contract source (and whether or not they have been
+ * optimised) so that a contract which is loaded by several executors, or evicted and reloaded
+ * from the chain code cache, is only compiled once. The least recently used executables are
+ * evicted once the cache is full.
+ *
+ * Cached executables are shared between contract instances and must not be modified.
+ *
+ * Optionally the cache can be backed by a persistent store, so that a node which is restarted (or
+ * re-synchronised) does not need to compile every historical contract again on first use. Stored
+ * executables are keyed by the layout signature of the VM (see vm::VM::LayoutSignature) as well as
+ * the contract digest, so executables generated by a different version of the node are never
+ * reused.
+ */
+class ExecutableCache
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Executable     = vm::Executable;
+  using ExecutablePtr  = std::shared_ptr<Executable>;
+
+  static constexpr std::size_t DEFAULT_MAX_ENTRIES = 256;
+
+  static ExecutableCache &Instance();
+
+  // Construction / Destruction
+  explicit ExecutableCache(std::size_t max_entries = DEFAULT_MAX_ENTRIES);
+  ExecutableCache(ExecutableCache const &) = delete;
+  ExecutableCache(ExecutableCache &&)      = delete;
+  ~ExecutableCache();
+
+  ExecutablePtr Lookup(ConstByteArray const &digest, bool optimised);
+  void          Insert(ConstByteArray const &digest, bool optimised, ExecutablePtr executable);
+  void          Clear();
+  std::size_t   size() const;
+
+  /// @name Persistence
+  /// @{
+  void          Load(std::string const &doc_file, std::string const &index_file);
+  bool          IsPersistent() const;
+  ExecutablePtr Restore(ConstByteArray const &digest, bool optimised, std::string const &layout);
+  void          Persist(ConstByteArray const &digest, bool optimised, std::string const &layout,
+                        ExecutablePtr const &executable);
+  /// @}
+
+  // Operators
+  ExecutableCache &operator=(ExecutableCache const &) = delete;
+  ExecutableCache &operator=(ExecutableCache &&) = delete;
+
+private:
+  using Key      = std::pair<ConstByteArray, bool>;
+  using KeyOrder = std::list<Key>;
+
+  struct Entry
+  {
+    ExecutablePtr      executable;
+    KeyOrder::iterator position;  ///< The position of the entry in the usage order
+  };
+
+  using Entries  = std::map<Key, Entry>;
+  using Store    = storage::ObjectStore<Executable>;
+  using StorePtr = std::shared_ptr<Store>;
+
+  static storage::ResourceID StoreKey(ConstByteArray const &digest, bool optimised,
+                                      std::string const &layout);
+
+  StorePtr GetStore() const;
+
+  std::size_t const max_entries_;
+  mutable Mutex     lock_;
+  Entries           entries_{};
+  KeyOrder          order_{};  ///< The keys of the entries, most recently used first
+  StorePtr          store_{};  ///< The (optional) persistent store of executables
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -19,6 +19,8 @@
 
 #include "crypto/fnv.hpp"  // needed for std::hash<ConstByteArray>
 #include "ledger/chaincode/contract.hpp"
+#include "vm/common.hpp"
+#include "vm/vm_pool.hpp"
 #include "vm_modules/ledger/context.hpp"
 
 #include <memory>
@@ -50,7 +52,7 @@ public:
   using ExecutablePtr  = std::shared_ptr<Executable>;
 
   // Construction / Destruction
-  explicit SmartContract(std::string const &source);
+  explicit SmartContract(std::string const &source, bool optimise = false);
   ~SmartContract() override = default;
 
   ConstByteArray contract_digest() const
@@ -63,6 +65,8 @@ public:
     return executable_;
   }
 
+  void SetQueryChargeLimit(vm::ChargeAmount limit);
+
 private:
   using ModulePtr = std::shared_ptr<vm::Module>;
 
@@ -75,8 +79,11 @@ private:
   ConstByteArray                 digest_;      ///< The digest of the current contract
   ExecutablePtr                  executable_;  ///< The internal script object of the parsed source
   ModulePtr                      module_;      ///< The internal module instance for the contract
+  vm::VMPool                     vm_pool_;     ///< The reusable VM instances for the module
   std::string                    init_fn_name_;
   vm_modules::ledger::ContextPtr context_;
+  bool                           optimise_;  ///< Flag to signal the executable was optimised
+  vm::ChargeAmount               query_charge_limit_{0};
 };
 
 }  // namespace ledger
@@ -26,13 +26,14 @@
 #include <exception>
 #include <memory>
 #include <stdexcept>
+#include <utility>
 
 namespace fetch {
 namespace ledger {
 
-template <typename ContractType>
-auto CreateSmartContract(chain::Address const &contract_address, StorageInterface const &storage)
-    -> std::unique_ptr<ContractType>
+template <typename ContractType, typename... Args>
+auto CreateSmartContract(chain::Address const &contract_address, StorageInterface const &storage,
+                         Args &&... args) -> std::unique_ptr<ContractType>
 {
   auto const addr     = SmartContractManager::CreateAddressForContract(contract_address);
   auto const resource = storage.Get(addr);
@@ -43,7 +44,8 @@ auto CreateSmartContract(chain::Address const &contract_address, StorageInterfac
     SmartContractWrapper           document{};
     buffer >> document;
 
-    return std::make_unique<ContractType>(std::string(document.source));
+    return std::make_unique<ContractType>(std::string(document.source),
+                                          std::forward<Args>(args)...);
   }
 
   FETCH_LOG_ERROR("SmartContractFactory",
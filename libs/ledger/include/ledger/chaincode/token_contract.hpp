@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/sharded_balances.hpp"
 #include "chain/transaction.hpp"
 #include "ledger/chaincode/contract.hpp"
 #include "ledger/consensus/stake_update_event.hpp"
@@ -38,15 +39,20 @@ class Deed;
 class TokenContract : public Contract
 {
 public:
-  using DeedPtr = std::shared_ptr<Deed>;
+  using DeedPtr            = std::shared_ptr<Deed>;
+  using ShardedBalances    = chain::ShardedBalances;
+  using ShardedBalancesPtr = chain::ShardedBalancesPtr;
 
   static constexpr char const *LOGGING_NAME = "TokenContract";
   static constexpr char const *NAME         = "fetch.token";
 
   // Construction / Destruction
   TokenContract();
+  explicit TokenContract(ShardedBalancesPtr sharded_balances);
   ~TokenContract() override = default;
 
+  ShardedBalances const &sharded_balances() const;
+
   // library functions
   DeedPtr  GetDeed(chain::Address const &address);
   void     SetDeed(chain::Address const &address, DeedPtr const &deed);
@@ -72,7 +78,11 @@ public:
   void ClearStakeUpdates();
 
 private:
-  StakeUpdateEvents stake_updates_;
+  ConstByteArray CreditKey(chain::Address const &address);
+  uint64_t       FoldBalanceShards(chain::Address const &address, bool clear);
+
+  ShardedBalancesPtr sharded_balances_;
+  StakeUpdateEvents  stake_updates_;
 };
 
 }  // namespace ledger
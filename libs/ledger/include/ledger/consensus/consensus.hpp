@@ -67,6 +67,7 @@ public:
   NextBlockPtr GenerateNextBlock() override;
   Status       ValidBlock(Block const &current) const override;
   bool         VerifyNotarisation(Block const &block) const;
+  void         VerifyNotarisations(std::vector<Block const *> const &blocks) const override;
 
   void SetMaxCabinetSize(uint16_t size) override;
   void SetBlockInterval(uint64_t block_interval_ms) override;
@@ -21,6 +21,7 @@
 #include "ledger/consensus/stake_snapshot.hpp"
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -56,6 +57,11 @@ public:
   // Verify a block according to consensus requirements. It must not be loose.
   virtual Status ValidBlock(Block const &current) const = 0;
 
+  // Verify the notarisations of a batch of blocks (e.g. when syncing) together, so that the
+  // following calls to ValidBlock for these blocks find them already verified
+  virtual void VerifyNotarisations(std::vector<Block const *> const & /*blocks*/) const
+  {}
+
   // Set system parameters
   virtual void SetMaxCabinetSize(uint16_t max_cabinet_size)                    = 0;
   virtual void SetBlockInterval(uint64_t block_interval_s)                     = 0;
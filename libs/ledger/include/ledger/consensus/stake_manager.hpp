@@ -25,6 +25,8 @@
 #include "ledger/consensus/stake_snapshot.hpp"
 #include "ledger/consensus/stake_update_queue.hpp"
 
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace fetch {
@@ -103,6 +105,7 @@ private:
   using BlockIndex       = uint64_t;
   using StakeSnapshotPtr = std::shared_ptr<StakeSnapshot>;
   using StakeHistory     = std::map<BlockIndex, StakeSnapshotPtr>;
+  using StakeDeltas      = std::map<BlockIndex, StakeSnapshot::Records>;
 
   StakeSnapshotPtr         LookupStakeSnapshot(BlockIndex block) const;
   StakeManager::CabinetPtr ResetInternal(StakeSnapshotPtr &&snapshot, uint64_t cabinet_size);
@@ -161,26 +164,79 @@ public:
 
   static uint8_t const UPDATE_QUEUE        = 1;
   static uint8_t const STAKE_HISTORY       = 2;
-  static uint8_t const CURRENT_SNAPSHOT    = 3;
-  static uint8_t const CURRENT_BLOCK_INDEX = 4;
+  static uint8_t const CURRENT_BLOCK_INDEX = 3;
 
   template <typename Constructor>
   static void Serialize(Constructor &map_constructor, Type const &stake_manager)
   {
-    auto map = map_constructor(5);
+    auto map = map_constructor(3);
     map.Append(UPDATE_QUEUE, stake_manager.update_queue_);
-    map.Append(STAKE_HISTORY, stake_manager.stake_history_);
-    map.Append(CURRENT_SNAPSHOT, stake_manager.current_);
+    map.Append(STAKE_HISTORY, ComputeDeltas(stake_manager.stake_history_));
     map.Append(CURRENT_BLOCK_INDEX, stake_manager.current_block_index_);
   }
 
   template <typename MapDeserializer>
   static void Deserialize(MapDeserializer &map, Type &stake_manager)
   {
+    Type::StakeDeltas deltas{};
+
     map.ExpectKeyGetValue(UPDATE_QUEUE, stake_manager.update_queue_);
-    map.ExpectKeyGetValue(STAKE_HISTORY, stake_manager.stake_history_);
-    map.ExpectKeyGetValue(CURRENT_SNAPSHOT, stake_manager.current_);
+    map.ExpectKeyGetValue(STAKE_HISTORY, deltas);
     map.ExpectKeyGetValue(CURRENT_BLOCK_INDEX, stake_manager.current_block_index_);
+
+    stake_manager.stake_history_ = ApplyDeltas(deltas);
+
+    // the current snapshot is always the entry for current block index in the history
+    auto const it          = stake_manager.stake_history_.find(stake_manager.current_block_index_);
+    stake_manager.current_ = (it != stake_manager.stake_history_.end()) ? it->second : nullptr;
+  }
+
+private:
+  /**
+   * The history is persisted as a series of deltas, each against the preceding entry in the
+   * history. The first entry is persisted as a delta against an empty snapshot.
+   */
+  static Type::StakeDeltas ComputeDeltas(Type::StakeHistory const &history)
+  {
+    Type::StakeDeltas     deltas{};
+    ledger::StakeSnapshot empty{};
+
+    ledger::StakeSnapshot const *previous = &empty;
+    for (auto const &element : history)
+    {
+      if (element.second.get() == previous)
+      {
+        deltas[element.first] = {};
+      }
+      else
+      {
+        deltas[element.first] = element.second->ComputeDelta(*previous);
+      }
+
+      previous = element.second.get();
+    }
+
+    return deltas;
+  }
+
+  static Type::StakeHistory ApplyDeltas(Type::StakeDeltas const &deltas)
+  {
+    Type::StakeHistory history{};
+
+    auto previous = std::make_shared<ledger::StakeSnapshot>();
+    for (auto const &element : deltas)
+    {
+      // snapshots are never modified once they are in the history so they can be shared
+      if (!element.second.empty())
+      {
+        previous = std::make_shared<ledger::StakeSnapshot>(*previous);
+        previous->ApplyDelta(element.second);
+      }
+
+      history[element.first] = previous;
+    }
+
+    return history;
   }
 };
 
@@ -21,7 +21,10 @@
 #include "crypto/identity.hpp"
 #include "logging/logging.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <set>
 #include <vector>
 
 namespace fetch {
@@ -33,6 +36,9 @@ namespace ledger {
  *
  * Conceptually this object represents a stake information for a single point of time, however, in
  * general the stake snapshots will be reused for the entire period of a stake period.
+ *
+ * Records are kept ordered by identity together with a Fenwick (binary indexed) tree of the stake
+ * amounts. This means that changes in stake and weighted selections are both O(log n) operations.
  */
 class StakeSnapshot
 {
@@ -47,6 +53,8 @@ public:
     uint64_t stake;
   };
 
+  using Records = std::vector<Record>;
+
   static constexpr char const *LOGGING_NAME = "StakeSnapshot";
 
   // Construction / Destruction
@@ -62,6 +70,8 @@ public:
   /// @{
   uint64_t LookupStake(Identity const &identity) const;
   void     UpdateStake(Identity const &identity, uint64_t stake);
+  void     ApplyDelta(Records const &delta);
+  Records  ComputeDelta(StakeSnapshot const &previous) const;
   /// @}
 
   /// @name Basic Accessors
@@ -78,13 +88,15 @@ public:
   StakeSnapshot &operator=(StakeSnapshot &&) = default;
 
 private:
-  using RecordPtr     = std::shared_ptr<Record>;
-  using IdentityIndex = std::unordered_map<Identity, RecordPtr>;
-  using StakeIndex    = std::vector<RecordPtr>;
+  using StakeTree = std::vector<uint64_t>;
+
+  Records::const_iterator FindRecord(Identity const &identity) const;
+  Records::iterator       FindRecord(Identity const &identity);
+  void                    RebuildStakeTree();
 
-  IdentityIndex identity_index_{};  ///< Map of Identity to Record
-  StakeIndex    stake_index_;       ///< Array of Records
-  uint64_t      total_stake_{0};    ///< Total stake cache
+  Records   stake_index_{};   ///< Array of Records, ordered by identity
+  StakeTree stake_tree_{};    ///< Fenwick tree of the stakes in the stake index
+  uint64_t  total_stake_{0};  ///< Total stake cache
 
   template <typename T, typename D>
   friend struct serializers::MapSerializer;
@@ -107,7 +119,7 @@ inline uint64_t StakeSnapshot::total_stake() const
  */
 inline std::size_t StakeSnapshot::size() const
 {
-  return identity_index_.size();
+  return stake_index_.size();
 }
 
 /**
@@ -119,9 +131,9 @@ inline std::size_t StakeSnapshot::size() const
 template <typename Functor>
 void StakeSnapshot::IterateOver(Functor &&functor) const
 {
-  for (auto const &element : identity_index_)
+  for (auto const &record : stake_index_)
   {
-    functor(element.first, element.second->stake);
+    functor(record.identity, record.stake);
   }
 }
 
@@ -162,25 +174,25 @@ public:
   using Type       = ledger::StakeSnapshot;
   using DriverType = D;
 
-  static uint8_t const IDENTITY_INDEX = 1;
-  static uint8_t const STAKE_INDEX    = 2;
-  static uint8_t const TOTAL_STAKE    = 3;
+  static uint8_t const STAKE_INDEX = 1;
+  static uint8_t const TOTAL_STAKE = 2;
 
   template <typename Constructor>
   static void Serialize(Constructor &map_constructor, Type const &snapshot)
   {
-    auto map = map_constructor(3);
-    map.Append(IDENTITY_INDEX, snapshot.identity_index_);
+    auto map = map_constructor(2);
     map.Append(STAKE_INDEX, snapshot.stake_index_);
     map.Append(TOTAL_STAKE, snapshot.total_stake_);
   }
 
   template <typename MapDeserializer>
-  static void Deserialize(MapDeserializer &map, Type &record)
+  static void Deserialize(MapDeserializer &map, Type &snapshot)
   {
-    map.ExpectKeyGetValue(IDENTITY_INDEX, record.identity_index_);
-    map.ExpectKeyGetValue(STAKE_INDEX, record.stake_index_);
-    map.ExpectKeyGetValue(TOTAL_STAKE, record.total_stake_);
+    map.ExpectKeyGetValue(STAKE_INDEX, snapshot.stake_index_);
+    map.ExpectKeyGetValue(TOTAL_STAKE, snapshot.total_stake_);
+
+    // the stake tree is derived state and is not persisted
+    snapshot.RebuildStakeTree();
   }
 };
 
@@ -29,6 +29,7 @@
 #include "ledger/dag/dag_epoch.hpp"
 #include "ledger/dag/dag_interface.hpp"
 #include "ledger/dag/dag_node.hpp"
+#include "ledger/dag/dag_node_index.hpp"
 #include "ledger/upow/work.hpp"
 #include "storage/object_store.hpp"
 
@@ -143,7 +144,13 @@ public:
   bool GetWork(DAGHash const &hash, Work &work) override;
 
   // TXs and epochs will be added here when they are broadcast in
-  bool AddDAGNode(DAGNode node) override;
+  bool        AddDAGNode(DAGNode node) override;
+  std::size_t AddDAGNodes(std::vector<DAGNode> nodes) override;
+
+  // Summary of the state of the DAG to send to peers, and the nodes a peer is missing given theirs
+  DAGSyncSummary       GetSyncSummary() override;
+  std::vector<DAGNode> GetNodesMissingFrom(DAGSyncSummary const &summary,
+                                           std::size_t           max_nodes) override;
 
 private:
   // Long term storage
@@ -162,6 +169,7 @@ private:
   std::unordered_map<NodeHash, DAGNodePtr>              node_pool_;  // dag nodes that are not finalised but are still valid
   std::unordered_map<NodeHash, DAGNodePtr>              loose_nodes_;  // nodes that are missing one or more references (waiting on NodeHash)
   std::unordered_map<NodeHash, std::vector<DAGNodePtr>> loose_nodes_lookup_;  // nodes that are missing one or more references (waiting on NodeHash)
+  DAGNodeIndex                                          node_index_;  // compact structure of the node pool used for traversals
   // clang-format on
 
   // TODO(1642): loose nodes management scheme
@@ -185,9 +193,9 @@ private:
   bool       NodeInvalidInternal(DAGNodePtr const &node);
   DAGNodePtr GetDAGNodeInternal(DAGHash const &hash, bool including_loose,
                                 bool &was_loose);  // const
-  void       TraverseFromTips(std::set<DAGHash> const &            tip_hashes,
-                              std::function<void(NodeHash)> const &on_node,
-                              std::function<bool(NodeHash)> const &terminating_condition);
+  void       TraverseFromTips(std::set<DAGHash> const &                   tip_hashes,
+                              std::function<void(NodeHash const &)> const &on_node,
+                              std::function<bool(NodeHash const &)> const &terminating_condition);
   bool       GetEpochFromStorage(std::string const &identifier, DAGEpoch &epoch);
   bool       SetEpochInStorage(std::string const & /*unused*/, DAGEpoch const &epoch, bool is_head);
   void       Flush();
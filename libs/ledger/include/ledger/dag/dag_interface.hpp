@@ -20,8 +20,10 @@
 #include "ledger/dag/dag_epoch.hpp"
 #include "ledger/dag/dag_hash.hpp"
 #include "ledger/dag/dag_node.hpp"
+#include "ledger/dag/dag_sync_summary.hpp"
 #include "ledger/upow/work.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <set>
 #include <vector>
@@ -74,6 +76,12 @@ public:
   virtual bool                 GetDAGNode(DAGHash const &hash, DAGNode &node) = 0;
   virtual bool                 GetWork(DAGHash const &hash, Work &work)       = 0;
   virtual bool                 AddDAGNode(DAGNode node)                       = 0;
+  virtual std::size_t          AddDAGNodes(std::vector<DAGNode> nodes)        = 0;
+
+  // Functions used for delta syncing
+  virtual DAGSyncSummary       GetSyncSummary() = 0;
+  virtual std::vector<DAGNode> GetNodesMissingFrom(DAGSyncSummary const &summary,
+                                                   std::size_t           max_nodes) = 0;
 };
 
 }  // namespace ledger
@@ -0,0 +1,98 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/dag/dag_hash.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Compact representation of the structure of the (non finalised) DAG node pool.
+ *
+ * Each node in the pool is assigned a dense integer identifier, with the references between nodes
+ * stored as adjacency arrays of these identifiers. References to anything outside of the pool
+ * (epochs and finalised nodes) are not recorded. This allows traversals of the pool to be
+ * performed without any hash lookups, tracking the visited nodes in a bitset.
+ *
+ * Identifiers of removed nodes are recycled.
+ */
+class DAGNodeIndex
+{
+public:
+  using NodeId       = uint32_t;
+  using NodeIds      = std::vector<NodeId>;
+  using DAGHashList  = std::vector<DAGHash>;
+  using Visitor      = std::function<void(NodeId)>;
+  using Terminator   = std::function<bool(NodeId)>;
+  using NodeIdLookup = std::unordered_map<DAGHash, NodeId>;
+
+  static constexpr NodeId INVALID_ID = std::numeric_limits<NodeId>::max();
+
+  // Construction / Destruction
+  DAGNodeIndex()                     = default;
+  DAGNodeIndex(DAGNodeIndex const &) = delete;
+  DAGNodeIndex(DAGNodeIndex &&)      = delete;
+  ~DAGNodeIndex()                    = default;
+
+  /// @name Accessors
+  /// @{
+  std::size_t    size() const;
+  NodeId         Lookup(DAGHash const &hash) const;
+  DAGHash const &hash(NodeId id) const;
+  NodeIds const &previous(NodeId id) const;
+  /// @}
+
+  /// @name Basic Operations
+  /// @{
+  NodeId Add(DAGHash const &hash, DAGHashList const &previous);
+  bool   Remove(DAGHash const &hash);
+  void   Clear();
+  void   Traverse(NodeIds const &starts, Visitor const &on_node,
+                  Terminator const &terminating_condition) const;
+  /// @}
+
+  // Operators
+  DAGNodeIndex &operator=(DAGNodeIndex const &) = delete;
+  DAGNodeIndex &operator=(DAGNodeIndex &&) = delete;
+
+private:
+  struct Node
+  {
+    DAGHash hash{};
+    NodeIds previous{};  ///< The nodes in the pool referenced by this node
+    NodeIds next{};      ///< The nodes in the pool which reference this node
+    bool    in_use{false};
+  };
+
+  using Nodes = std::vector<Node>;
+
+  NodeIdLookup ids_{};
+  Nodes        nodes_{};
+  NodeIds      free_ids_{};
+};
+
+}  // namespace ledger
+}  // namespace fetch
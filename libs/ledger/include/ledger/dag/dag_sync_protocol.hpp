@@ -17,11 +17,13 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/byte_array/const_byte_array.hpp"
 #include "ledger/dag/dag.hpp"
 #include "ledger/dag/dag_interface.hpp"
 #include "network/service/promise.hpp"
 #include "network/service/protocol.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
@@ -34,10 +36,13 @@ public:
   enum
   {
     REQUEST_NODES = 1,
+    REQUEST_DELTA = 2,
   };
 
   static constexpr char const *LOGGING_NAME = "DAGSyncProtocol";
 
+  using ConstByteArray = byte_array::ConstByteArray;
+
   // Construction / Destruction
   explicit DAGSyncProtocol(std::shared_ptr<ledger::DAGInterface> dag);
   DAGSyncProtocol(DAGSyncProtocol const &) = delete;
@@ -54,6 +59,18 @@ public:
   // unnecessarily
   static constexpr uint64_t MAX_NODES_TO_PROVIDE = 50;
 
+  // When asked for the nodes missing from a peer's summary the whole reply is built from a single
+  // pass over the DAG, so a larger batch can be afforded
+  static constexpr uint64_t MAX_DELTA_NODES_TO_PROVIDE = 256;
+
+  // Delta replies are LZ4 compressed, prefixed with their decompressed size. Replies claiming to be
+  // larger than the maximum are rejected before anything is allocated for them
+  static constexpr std::size_t DELTA_HEADER_SIZE           = sizeof(uint32_t);
+  static constexpr std::size_t MAX_DELTA_DECOMPRESSED_SIZE = 64u * 1024u * 1024u;
+
+  static ConstByteArray CompressNodes(DAG::MissingNodes const &nodes);
+  static bool           DecompressNodes(ConstByteArray const &compressed, DAG::MissingNodes &nodes);
+
 private:
   using Self = DAGSyncProtocol;
 
@@ -61,6 +78,7 @@ private:
   using MissingNodes = DAG::MissingNodes;
 
   DAG::MissingNodes RequestNodes(MissingTXs missing_txs);
+  ConstByteArray    RequestDelta(DAGSyncSummary const &summary);
 
   std::shared_ptr<ledger::DAGInterface> dag_;
 };
@@ -24,6 +24,7 @@
 #include "ledger/dag/dag.hpp"
 #include "ledger/dag/dag_interface.hpp"
 #include "ledger/transaction_verifier.hpp"
+#include "moment/deadline_timer.hpp"
 #include "muddle/muddle_endpoint.hpp"
 #include "muddle/rpc/client.hpp"
 #include "muddle/rpc/server.hpp"
@@ -72,11 +73,18 @@ public:
   using RequestingMissingNodes = network::RequestingQueueOf<muddle::Packet::Address, MissingNodes>;
   using PromiseOfMissingNodes  = network::PromiseOf<MissingNodes>;
   using MissingDAGNodes        = std::set<DAGHash>;
+  using DeadlineTimer          = moment::DeadlineTimer;
+
+  using ConstByteArray   = byte_array::ConstByteArray;
+  using RequestingDeltas = network::RequestingQueueOf<muddle::Packet::Address, ConstByteArray>;
+  using PromiseOfDelta   = network::PromiseOf<ConstByteArray>;
 
   DAGSyncService(MuddleEndpoint &muddle_endpoint, std::shared_ptr<ledger::DAGInterface> dag);
   ~DAGSyncService() = default;
 
   static constexpr std::size_t MAX_OBJECT_RESOLUTION_PER_CYCLE = 128;
+  static constexpr std::size_t MAX_DELTA_SYNC_PEERS            = 3;
+  static constexpr uint64_t    DELTA_SYNC_INTERVAL_MS          = 2000;
 
   core::WeakRunnable GetWeakRunnable()
   {
@@ -92,6 +100,9 @@ private:
   State OnQueryMissing();
   State OnResolveMissing();
 
+  void RequestMissingNodes(muddle::MuddleEndpoint::AddressList const &peers);
+  void RequestDelta(muddle::MuddleEndpoint::AddressList const &peers);
+
   MuddleEndpoint &                      muddle_endpoint_;
   ClientPtr                             client_;
   std::shared_ptr<StateMachine>         state_machine_;
@@ -102,8 +113,11 @@ private:
 
   RequestingMissingNodes missing_set_;
   RequestingMissingNodes missing_pending_;
+  RequestingDeltas       delta_pending_;
 
   MissingDAGNodes missing_dag_nodes_;
+  DeadlineTimer   delta_sync_interval_{"dag_sync:delta"};
+  std::size_t     peer_offset_{0};  ///< Rotates the peers that requests are made to
 
   uint64_t BROADCAST_BATCH_SIZE = 5;
 
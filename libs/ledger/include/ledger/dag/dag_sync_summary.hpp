@@ -0,0 +1,75 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/dag/dag_hash.hpp"
+
+#include <cstdint>
+#include <set>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Compact description of the state of a DAG, exchanged between peers so that each side only sends
+ * the nodes that the other is missing. It consists of the most recent epoch which the DAG has
+ * committed and the hashes of the unfinalised nodes that it holds.
+ */
+struct DAGSyncSummary
+{
+  uint64_t          epoch{0};      ///< The block number of the most recent committed epoch
+  DAGHash           epoch_hash{};  ///< The hash of the most recent committed epoch
+  std::set<DAGHash> nodes{};     ///< The hashes of the unfinalised nodes
+};
+
+}  // namespace ledger
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<ledger::DAGSyncSummary, D>
+{
+public:
+  using Type       = ledger::DAGSyncSummary;
+  using DriverType = D;
+
+  static uint8_t const EPOCH      = 0;
+  static uint8_t const EPOCH_HASH = 1;
+  static uint8_t const NODES      = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &summary)
+  {
+    auto map = map_constructor(3);
+
+    map.Append(EPOCH, summary.epoch);
+    map.Append(EPOCH_HASH, summary.epoch_hash);
+    map.Append(NODES, summary.nodes);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &summary)
+  {
+    map.ExpectKeyGetValue(EPOCH, summary.epoch);
+    map.ExpectKeyGetValue(EPOCH_HASH, summary.epoch_hash);
+    map.ExpectKeyGetValue(NODES, summary.nodes);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
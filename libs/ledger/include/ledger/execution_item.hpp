@@ -56,6 +56,7 @@ public:
   /// @}
 
   void Execute(ExecutorInterface &executor);
+  void Reset();
   void AggregateStakeUpdates(StakeUpdateEvents &events);
 
   // Operators
@@ -116,6 +117,15 @@ inline void ExecutionItem::Execute(ExecutorInterface &executor)
   }
 }
 
+/**
+ * Discard the result of a previous execution so that the item can be executed again
+ */
+inline void ExecutionItem::Reset()
+{
+  result_ = Result{};
+  fee_    = 0;
+}
+
 inline void ExecutionItem::AggregateStakeUpdates(StakeUpdateEvents &events)
 {
   for (auto const &update : result_.stake_updates)
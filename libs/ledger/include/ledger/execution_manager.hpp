@@ -20,12 +20,15 @@
 #include "chain/address.hpp"
 #include "chain/constants.hpp"
 #include "core/byte_array/encoders.hpp"
+#include "core/cpu_topology.hpp"
 #include "core/mutex.hpp"
 #include "core/synchronisation/protected.hpp"
 #include "core/synchronisation/waitable.hpp"
 #include "ledger/execution_item.hpp"
 #include "ledger/execution_manager_interface.hpp"
 #include "ledger/executor.hpp"
+#include "ledger/storage_unit/shared_state_cache.hpp"
+#include "ledger/storage_unit/speculative_storage_adapter.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 #include "network/details/thread_pool.hpp"
 #include "storage/object_store.hpp"
@@ -52,9 +55,12 @@ class ExecutionManager : public ExecutionManagerInterface,
                          public std::enable_shared_from_this<ExecutionManager>
 {
 public:
-  using StorageUnitPtr  = std::shared_ptr<StorageUnitInterface>;
-  using ExecutorPtr     = std::shared_ptr<ExecutorInterface>;
-  using ExecutorFactory = std::function<ExecutorPtr()>;
+  using StorageUnitPtr = std::shared_ptr<StorageUnitInterface>;
+  using ExecutorPtr    = std::shared_ptr<ExecutorInterface>;
+
+  /// Creates an executor operating against the specified (shared cache or speculative) storage
+  using ExecutorFactory            = std::function<ExecutorPtr(StorageUnitPtr)>;
+  using SpeculativeExecutorFactory = ExecutorFactory;
 
   // Construction / Destruction
   ExecutionManager(std::size_t num_executors, uint32_t log2_num_lanes, StorageUnitPtr storage,
@@ -67,12 +73,25 @@ public:
   Digest         LastProcessedBlock() const override;
   State          GetState() override;
   bool           Abort() override;
+  void           SetCompletionCallback(CompletionCallback callback) override;
   /// @}
 
   // general control of the operation of the module
   void Start();
   void Stop();
 
+  // placement of the executor threads (must be configured before the module is started)
+  void SetAffinity(std::vector<core::CpuList> affinity);
+
+  // optimistic execution (must be configured before the module is started)
+  void EnableOptimisticExecution(SpeculativeExecutorFactory const &factory);
+  bool IsOptimisticExecutionEnabled() const;
+
+  // pre-execution of pending transactions (must be configured before the module is started)
+  void EnablePreExecution(SpeculativeExecutorFactory const &factory);
+  bool IsPreExecutionEnabled() const;
+  bool PreExecute(Digest const &digest, BitVector const &shards, BitVector &lanes);
+
   // statistics
   std::size_t completed_executions() const
   {
@@ -103,6 +122,18 @@ private:
   using CounterPtr        = telemetry::CounterPtr;
   using HistogramPtr      = telemetry::HistogramPtr;
   using BlockIndex        = uint64_t;
+  using AccessSet         = SpeculativeStorageAdapter::AccessSet;
+  using AccessSetList     = std::vector<AccessSet>;
+  using SpeculativeStore  = std::shared_ptr<SpeculativeStorageAdapter>;
+  using StateCachePtr     = std::shared_ptr<SharedStateCache>;
+
+  struct SpeculativeExecutor
+  {
+    SpeculativeStore storage;
+    ExecutorPtr      executor;
+  };
+
+  using SpeculativeExecutorList = std::vector<SpeculativeExecutor>;
 
   struct Summary
   {
@@ -117,9 +148,11 @@ private:
   Flag running_{false};
   Flag monitor_ready_{false};
 
-  Protected<Summary> state_{};
+  Protected<Summary>            state_{};
+  Protected<CompletionCallback> completion_callback_{};
 
   StorageUnitPtr storage_;
+  StateCachePtr  state_cache_;  ///< Block scoped read cache shared by all the executors
 
   Mutex         execution_plan_lock_;  ///< guards `execution_plan_`
   ExecutionPlan execution_plan_;
@@ -131,6 +164,21 @@ private:
   Mutex        idle_executors_lock_;  ///< guards `idle_executors`
   ExecutorList idle_executors_;
 
+  /// @name Optimistic Execution
+  /// @{
+  std::size_t const       num_executors_;
+  Flag                    optimistic_{false};
+  Mutex                   speculative_executors_lock_;  ///< guards `speculative_executors_`
+  SpeculativeExecutorList speculative_executors_;
+  AccessSetList           access_sets_;  ///< One per item of the flattened execution plan
+  /// @}
+
+  /// @name Pre-execution
+  /// @{
+  Mutex               pre_execution_lock_;  ///< Held while pre-executing and scheduling blocks
+  SpeculativeExecutor pre_executor_;
+  /// @}
+
   Counter completed_executions_{0};
   Counter num_slices_{0};
 
@@ -145,12 +193,19 @@ private:
   CounterPtr   slices_executed_count_;
   CounterPtr   fees_settled_count_;
   CounterPtr   blocks_completed_count_;
+  CounterPtr   tx_reexecuted_count_;
+  CounterPtr   tx_pre_executed_count_;
   HistogramPtr execution_duration_;
 
   void MonitorThreadEntrypoint();
 
   bool PlanExecution(Block const &block);
   void DispatchExecution(ExecutionItem &item);
+  void DispatchSpeculativeExecution(std::size_t index, ExecutionItem &item);
+  std::size_t CommitSpeculativeExecution(ExecutionItemList const &items);
+
+  SpeculativeExecutor AcquireSpeculativeExecutor();
+  void                ReleaseSpeculativeExecutor(SpeculativeExecutor executor);
 };
 
 }  // namespace ledger
@@ -17,8 +17,11 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/macros.hpp"
 #include "ledger/chain/block.hpp"
 
+#include <functional>
+
 namespace fetch {
 namespace ledger {
 
@@ -52,6 +55,8 @@ public:
                         ///< considered as bad
   };
 
+  using CompletionCallback = std::function<void()>;
+
   // Construction / Destruction
   ExecutionManagerInterface()          = default;
   virtual ~ExecutionManagerInterface() = default;
@@ -64,6 +69,17 @@ public:
   virtual State          GetState()                                 = 0;
   virtual bool           Abort()                                    = 0;
   /// @}
+
+  /**
+   * Register a callback to be invoked (from an arbitrary thread) each time the execution of a block
+   * has finished. Implementations which can not signal completion must be polled with GetState.
+   *
+   * @param callback The callback to be registered, an empty callback removes the registration
+   */
+  virtual void SetCompletionCallback(CompletionCallback callback)
+  {
+    FETCH_UNUSED(callback);
+  }
 };
 
 /**
@@ -48,11 +48,12 @@ class StakeUpdateInterface;
 class Executor : public ExecutorInterface
 {
 public:
-  using StorageUnitPtr = std::shared_ptr<StorageUnitInterface>;
-  using ConstByteArray = byte_array::ConstByteArray;
+  using StorageUnitPtr     = std::shared_ptr<StorageUnitInterface>;
+  using ConstByteArray     = byte_array::ConstByteArray;
+  using ShardedBalancesPtr = chain::ShardedBalancesPtr;
 
   // Construction / Destruction
-  explicit Executor(StorageUnitPtr storage);
+  explicit Executor(StorageUnitPtr storage, ShardedBalancesPtr sharded_balances = {});
   ~Executor() override = default;
 
   /// @name Executor Interface
@@ -76,7 +77,7 @@ private:
   /// @{
   StorageUnitPtr storage_;             ///< The collection of resources
   ChainCodeCache chain_code_cache_{};  //< The factory to create new chain code instances
-  TokenContract  token_contract_{};
+  TokenContract  token_contract_;
   /// @}
 
   /// @name Per Execution State
@@ -0,0 +1,48 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+
+#include <cstdint>
+#include <map>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * The fees owed by each address over a block. Collecting the fees of a block first means that the
+ * balance of every address, and that of the miner, is only updated once when they are settled.
+ */
+class BlockFees
+{
+public:
+  using TokenAmount = uint64_t;
+  using Debits      = std::map<chain::Address, TokenAmount>;
+
+  void          Charge(chain::Address const &address, TokenAmount amount);
+  Debits const &debits() const;
+  bool          empty() const;
+  void          Clear();
+
+private:
+  Debits debits_{};
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -19,6 +19,7 @@
 
 #include "chain/transaction.hpp"
 #include "core/bitvector.hpp"
+#include "ledger/fees/block_fees.hpp"
 #include "ledger/chaincode/token_contract.hpp"
 #include "ledger/fees/chargeable.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
@@ -44,6 +45,15 @@ public:
   using Result                  = ContractExecutionResult;
   using TokenAmount             = uint64_t;
 
+  /**
+   * When the fees of transactions are taken from their originators and paid to the miner
+   */
+  enum class Settlement
+  {
+    PER_TRANSACTION,  ///< As each transaction is executed
+    PER_BLOCK         ///< Once per address at the end of the block, see BlockFees
+  };
+
   struct TransactionDetails
   {
     TransactionDetails(chain::Transaction &tx, BitVector const &shards);
@@ -73,6 +83,14 @@ public:
                   chain::Address const &contract_address, uint32_t log2_num_lanes,
                   BlockIndex const &block, StorageInterface &storage);
 
+  /// @name Block Level Settlement
+  /// @{
+  void        Execute(TransactionDetails &tx, Result &result, BlockFees &fees);
+  TokenAmount SettleFees(chain::Address const &miner, BlockFees const &fees,
+                         uint32_t log2_num_lanes, BlockIndex const &block,
+                         StorageInterface &storage);
+  /// @}
+
   // Operators
   FeeManager &operator=(FeeManager const &) = delete;
   FeeManager &operator=(FeeManager &&) = delete;
@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/address.hpp"
 #include "core/byte_array/byte_array.hpp"
 #include "ledger/chain/block.hpp"
 #include "ledger/chain/main_chain.hpp"
@@ -25,6 +26,7 @@
 #include "storage/object_store.hpp"
 
 #include <string>
+#include <vector>
 
 namespace fetch {
 namespace variant {
@@ -47,6 +49,7 @@ public:
   using GenesisStore     = fetch::storage::ObjectStore<Block>;
   using MainChain        = ledger::MainChain;
   using StakeSnapshotPtr = std::shared_ptr<StakeSnapshot>;
+  using Addresses        = std::vector<chain::Address>;
 
   enum class Result
   {
@@ -61,6 +64,7 @@ public:
     uint64_t                      start_time{0};
     StakeSnapshotPtr              snapshot{};
     beacon::BlockEntropy::Cabinet whitelist;
+    Addresses                     sharded_balance_accounts{};  ///< Accounts with sharded balances
   };
 
   // Construction / Destruction
@@ -80,12 +84,15 @@ public:
 private:
   bool LoadState(variant::Variant const &object, ConsensusParameters const *consensus = nullptr);
   bool LoadConsensus(variant::Variant const &object, ConsensusParameters &params);
+  bool LoadShardedBalanceAccounts(variant::Variant const &object, Addresses &accounts);
+  bool RestoreShardedBalanceAccounts(Addresses &accounts);
 
   CertificatePtr        certificate_;
   StorageUnitInterface &storage_unit_;
   GenesisStore          genesis_store_;
   Block                 genesis_block_;
   std::string           db_name_;
+  Addresses             sharded_balance_accounts_;
 };
 
 }  // namespace ledger
@@ -17,46 +17,77 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/sharded_balances.hpp"
 #include "chain/transaction_layout.hpp"
 #include "core/digest.hpp"
 #include "core/mutex.hpp"
 #include "ledger/block_packer_interface.hpp"
 #include "ledger/chain/block.hpp"
+#include "ledger/chain/compact_block.hpp"
+#include "ledger/miner/transaction_layout_index.hpp"
 #include "ledger/miner/transaction_layout_queue.hpp"
 #include "meta/log2.hpp"
 #include "telemetry/telemetry.hpp"
 #include "vectorise/threading/pool.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
 
 /**
- * Simplistic greedy search algorithm for generating / packing blocks. Has rudimentary support to
- * parallelize the packing over a number of threads.
+ * Simplistic greedy search algorithm for generating / packing blocks.
  *
- * Internally the miner maintains 2 queues. One which is the pending queue which is populated when
- * a new transaction is added to the miner. When block generation begins, this pending queue is
- * transferred to the main queue when it is evaluated in order to generate new blocks. During this
- * operation the main queue is locked.
+ * Internally the miner maintains a pending queue which is populated when a new transaction is
+ * added to the miner, and a persistent mining pool which indexes the layouts by fee and by lane.
+ * When block generation begins, the pending queue is transferred into the mining pool which is then
+ * used to greedily pack each slice in turn. During this operation the mining pool is locked. The
+ * same transfer happens as each block is committed, so that the transactions whose validity period
+ * has ended can be evicted from the pool by their expiry block.
+ *
+ * Duplicates of transactions which are already on chain are detected lazily: only the layouts which
+ * have been packed into the block are checked, and any duplicates that are found are discarded and
+ * the freed lanes refilled from the pool.
+ *
+ * Once the greedy pass has completed, the miner spends up to a fixed time budget refining the
+ * slices which are not fully occupied. Each slice is re-packed from its own transactions and the
+ * best of the remaining queue by running a number of independent simulated annealing restarts over
+ * the lane conflict graph. The annealed packing only replaces the greedy one when it occupies more
+ * lanes (or the same number of lanes for a higher fee).
+ *
+ * The lanes declared by a transaction are often much wider than the lanes that it actually uses.
+ * When the transactions in the pool are pre-executed (see TransactionPreExecutor) the lanes that
+ * each of them was observed to use are recorded and used in place of the declared lanes when
+ * packing, which allows more transactions to share each slice. The layouts placed in the block are
+ * unchanged, so each transaction is still executed against its declared lanes. The execution
+ * manager runs the transactions of a slice whose declared lanes overlap in slice order.
  */
 class BasicMiner : public ledger::BlockPackerInterface
 {
 public:
   static constexpr char const *LOGGING_NAME = "BasicMiner";
 
-  using Block             = ledger::Block;
-  using MainChain         = ledger::MainChain;
-  using TransactionLayout = chain::TransactionLayout;
+  using Block              = ledger::Block;
+  using MainChain          = ledger::MainChain;
+  using TransactionLayout  = chain::TransactionLayout;
+  using ShardedBalancesPtr = chain::ShardedBalancesPtr;
+  using Duration           = std::chrono::milliseconds;
+
+  static constexpr uint64_t DEFAULT_PACKING_BUDGET_MS = 50;
 
   // Construction / Destruction
-  explicit BasicMiner(uint32_t log2_num_lanes);
+  explicit BasicMiner(uint32_t log2_num_lanes,
+                      Duration packing_budget = Duration{DEFAULT_PACKING_BUDGET_MS});
   BasicMiner(BasicMiner const &) = delete;
   BasicMiner(BasicMiner &&)      = delete;
   ~BasicMiner() override         = default;
 
+  void SetShardedBalances(ShardedBalancesPtr sharded_balances);
+
   /// @name Miner Interface
   /// @{
   void     EnqueueTransaction(chain::Transaction const &tx) override;
@@ -64,6 +95,15 @@ public:
   void     GenerateBlock(Block &block, std::size_t num_lanes, std::size_t num_slices,
                          MainChain const &chain) override;
   uint64_t GetBacklog() const override;
+  void     RemoveExpired(uint64_t block_index) override;
+  /// @}
+
+  bool LookupTransaction(ShortTransactionId id, chain::TransactionLayout &layout) const;
+
+  /// @name Pre-execution
+  /// @{
+  std::vector<TransactionLayout> GetUnobservedTransactions(std::size_t count);
+  void SetObservedLanes(Digest const &digest, BitVector const &lanes);
   /// @}
 
   // Operators
@@ -73,33 +113,52 @@ public:
 private:
   using ThreadPool = threading::Pool;
   using Queue      = TransactionLayoutQueue;
+  using Index      = TransactionLayoutIndex;
+  using Clock      = std::chrono::steady_clock;
+  using Timepoint  = Clock::time_point;
+  using LaneMasks  = DigestMap<BitVector>;
 
   /// @name Packing Operations
   /// @{
-  static void GenerateSlices(Queue &transactions, Block &block, std::size_t offset,
-                             std::size_t interval, std::size_t num_lanes);
-  static void GenerateSlice(Queue &transactions, Block::Slice &slice, std::size_t slice_index,
-                            std::size_t num_lanes);
-  static bool SortByFee(TransactionLayout const &a, TransactionLayout const &b);
+  void        TransferPending();
+  void             GenerateSlices(Block &block);
+  std::size_t      RemoveDuplicates(Block &block, MainChain const &chain);
+  BitVector const &PackingMask(TransactionLayout const &layout) const;
+  void             PruneObservedLanes();
+  /// @}
+
+  /// @name Slice Refinement
+  /// @{
+  std::size_t RefineSlices(Block &block, std::size_t num_lanes, Timepoint const &deadline);
+  bool        RefineSlice(Block::Slice &slice, std::size_t num_lanes, Block::Index block_index,
+                          Timepoint const &deadline);
   /// @}
 
   /// @name Configuration
   /// @{
   uint32_t       log2_num_lanes_;   ///< The log2 of the number of lanes
   uint32_t const max_num_threads_;  ///< The configured maximum number of threads
+  Duration const packing_budget_;   ///< The time allowed for refining the greedy slices
   ThreadPool     thread_pool_;      ///< The thread pool used to dispatch work
   /// @}
 
   /// @name Pending Queue
   /// @{
-  mutable Mutex pending_lock_;  ///< Pending queue lock (priority 1)
-  Queue         pending_;       ///< The main mining queue for the node
+  mutable Mutex      pending_lock_;      ///< Pending queue lock (priority 1)
+  ShardedBalancesPtr sharded_balances_;  ///< The accounts used to lay out new transactions
+  Queue              pending_;           ///< The main mining queue for the node
+  /// @}
+
+  /// @name Recently Seen Transactions
+  /// @{
+  ShortIdIndex recent_layouts_;  ///< Layouts by short id for rebuilding compact blocks
   /// @}
 
   /// @name Central Mining Pool Queue
   /// @{
   mutable Mutex mining_pool_lock_;  ///< Mining pool lock (priority 0)
-  Queue         mining_pool_;       ///< The main mining queue for the node
+  Index         mining_pool_;       ///< The main mining pool for the node
+  LaneMasks     observed_lanes_;    ///< The observed lanes of the pooled and packed transactions
   /// @}
 
   /// @name Telemetry
@@ -109,6 +168,8 @@ private:
   telemetry::GaugePtr<uint64_t> max_pending_pool_size_;
   telemetry::CounterPtr         duplicate_count_;
   telemetry::CounterPtr         duplicate_filtered_count_;
+  telemetry::CounterPtr         refined_slice_count_;
+  telemetry::CounterPtr         observed_count_;
   /// @}
 };
 
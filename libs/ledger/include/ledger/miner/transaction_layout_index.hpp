@@ -0,0 +1,123 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_expiry_index.hpp"
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/digest.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * A persistent index of transaction layouts ordered by fee, which is maintained across block
+ * generations rather than being re-sorted each time.
+ *
+ * In addition to the global fee order, every layout is indexed in the fee order of each of the
+ * lanes that it occupies. When packing a slice this allows the search for the next transaction to
+ * be restricted to the lanes which are still free, so the cost of packing is bounded by the number
+ * of lanes rather than the number of layouts in the index. All insertions and removals are
+ * O(log n) in the size of the index (per occupied lane).
+ *
+ * The lanes used for packing default to the lanes declared by the layout. When the lanes that a
+ * transaction actually uses have been observed (by pre-executing it) they can be narrowed to that
+ * subset, allowing more transactions to be packed into each slice.
+ */
+class TransactionLayoutIndex
+{
+public:
+  using TransactionLayout = chain::TransactionLayout;
+  using BlockIndex        = TransactionLayout::BlockIndex;
+  using Layouts           = std::vector<TransactionLayout>;
+
+  /// The maximum number of blocked layouts examined per lane when packing a single slice
+  static constexpr std::size_t MAX_LANE_SCAN = 1024;
+
+  // Construction / Destruction
+  explicit TransactionLayoutIndex(std::size_t num_lanes);
+  TransactionLayoutIndex(TransactionLayoutIndex const &) = delete;
+  TransactionLayoutIndex(TransactionLayoutIndex &&)      = delete;
+  ~TransactionLayoutIndex()                              = default;
+
+  /// @name Accessors
+  /// @{
+  std::size_t size() const;
+  bool        empty() const;
+  bool        Contains(Digest const &digest) const;
+  Layouts     Top(std::size_t count, BlockIndex block_index) const;
+  Layouts     Unobserved(std::size_t count) const;
+  /// @}
+
+  /// @name Basic Operations
+  /// @{
+  bool        Add(TransactionLayout const &layout);
+  bool        Remove(Digest const &digest);
+  std::size_t Remove(DigestSet const &digests);
+  std::size_t RemoveExpired(BlockIndex block_index);
+  bool        SetObservedMask(Digest const &digest, BitVector const &mask);
+  std::size_t PackSlice(Layouts &slice, BlockIndex block_index);
+  std::size_t PackSlice(Layouts &slice, BitVector occupied, BlockIndex block_index);
+  /// @}
+
+  // Operators
+  TransactionLayoutIndex &operator=(TransactionLayoutIndex const &) = delete;
+  TransactionLayoutIndex &operator=(TransactionLayoutIndex &&) = delete;
+
+private:
+  struct Entry
+  {
+    TransactionLayout     layout;
+    uint64_t              sequence;  ///< Insertion order, used to break ties between equal fees
+    std::vector<uint32_t> lanes;     ///< The lanes occupied by the layout when packing
+    BitVector             mask;      ///< The packing mask, narrowed to the observed lanes if known
+    bool                  observed;  ///< Whether the lanes used by the layout have been observed
+  };
+
+  using EntryPtr = Entry const *;
+
+  struct ByFee
+  {
+    bool operator()(EntryPtr const &a, EntryPtr const &b) const;
+  };
+
+  using FeeOrder    = std::set<EntryPtr, ByFee>;
+  using ExpiryIndex = chain::TransactionExpiryIndex;
+  using Entries     = DigestKeyMap<Entry>;
+
+  void LinkLanes(Entry &entry);
+  void UnlinkLanes(Entry const &entry);
+  void Erase(Entries::iterator const &it);
+
+  std::size_t const     num_lanes_;
+  uint64_t              next_sequence_{0};
+  Entries               entries_{};        ///< The layouts indexed by digest
+  FeeOrder              by_fee_{};         ///< All layouts, highest fee first
+  std::vector<FeeOrder> by_lane_;          ///< The layouts occupying each lane, highest fee first
+  FeeOrder              unconstrained_{};  ///< Layouts which do not occupy any lanes
+  FeeOrder              unobserved_{};     ///< Layouts whose lanes have not been observed
+  ExpiryIndex           by_expiry_{};      ///< All layouts, by the block at which they expire
+};
+
+}  // namespace ledger
+}  // namespace fetch
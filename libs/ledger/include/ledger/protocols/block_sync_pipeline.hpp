@@ -0,0 +1,117 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block.hpp"
+#include "muddle/address.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Schedules the download of a section of the chain as a series of non-overlapping ranges which can
+ * be requested from several peers at the same time.
+ *
+ * The ranges are defined by a skeleton of block hashes (one every `stride` blocks) which has been
+ * obtained from a single peer. Each completed range is checked against the skeleton as soon as it
+ * arrives, after which it is held in a reorder buffer so that the blocks can be handed to the
+ * chain strictly in order.
+ */
+class BlockSyncPipeline
+{
+public:
+  using Address     = muddle::Address;
+  using BlockHash   = Digest;
+  using BlockHashes = std::vector<BlockHash>;
+  using Blocks      = std::vector<Block>;
+
+  static constexpr std::size_t MAX_RANGE_ATTEMPTS = 5;
+
+  struct Range
+  {
+    std::size_t index{0};   ///< The index of the range
+    BlockHash   first{};    ///< The hash of the block immediately preceding the range
+    BlockHash   last{};     ///< The hash of the final block of the range
+    uint64_t    length{0};  ///< The number of blocks in the range
+  };
+
+  // Construction / Destruction
+  explicit BlockSyncPipeline(std::size_t max_buffered_ranges);
+  BlockSyncPipeline(BlockSyncPipeline const &) = delete;
+  BlockSyncPipeline(BlockSyncPipeline &&)      = delete;
+  ~BlockSyncPipeline()                         = default;
+
+  void Reset(BlockHashes skeleton, uint64_t stride);
+  void Clear();
+
+  /// @name Scheduling
+  /// @{
+  bool NextRange(Range &range);
+  bool Abandon(std::size_t index);
+  bool Complete(std::size_t index, Address const &source, Blocks blocks);
+  bool PopNext(Address &source, Blocks &blocks);
+  /// @}
+
+  /// @name Status
+  /// @{
+  bool             IsActive() const;
+  bool             IsComplete() const;
+  BlockHash const &delivered_hash() const;
+  std::size_t      num_ranges() const;
+  std::size_t      num_in_flight() const;
+  std::size_t      num_buffered() const;
+  /// @}
+
+  // Operators
+  BlockSyncPipeline &operator=(BlockSyncPipeline const &) = delete;
+  BlockSyncPipeline &operator=(BlockSyncPipeline &&) = delete;
+
+private:
+  enum class Phase : uint8_t
+  {
+    PENDING,
+    IN_FLIGHT,
+    BUFFERED,
+    DELIVERED,
+  };
+
+  struct Entry
+  {
+    Phase       phase{Phase::PENDING};
+    std::size_t attempts{0};
+    Address     source{};
+    Blocks      blocks{};
+  };
+
+  bool Validate(std::size_t index, Blocks &blocks) const;
+
+  std::size_t const  max_buffered_ranges_;
+  BlockHashes        skeleton_{};
+  uint64_t           stride_{0};
+  std::vector<Entry> entries_{};
+  std::size_t        next_delivery_{0};  ///< The index of the next range to be delivered
+  std::size_t        num_in_flight_{0};
+  std::size_t        num_buffered_{0};
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -36,10 +36,14 @@ public:
 
   /// @name Main Chain Rpc Protocol
   /// @{
-  BlocksPromise     GetHeaviestChain(MuddleAddress peer, uint64_t max_size) override;
-  BlocksPromise     GetCommonSubChain(MuddleAddress peer, Digest start, Digest last_seen,
+  BlocksPromise      GetHeaviestChain(MuddleAddress peer, uint64_t max_size) override;
+  BlocksPromise      GetCommonSubChain(MuddleAddress peer, Digest start, Digest last_seen,
+                                       uint64_t limit) override;
+  TraveloguePromise  TimeTravel(MuddleAddress peer, Digest start) override;
+  BlockHashesPromise GetChainSkeleton(MuddleAddress peer, uint64_t start, uint64_t stride,
                                       uint64_t limit) override;
-  TraveloguePromise TimeTravel(MuddleAddress peer, Digest start) override;
+  LayoutsPromise     GetTransactionLayouts(MuddleAddress peer, Digest block_hash,
+                                           BlockPositions positions) override;
   /// @}
 
   // Operators
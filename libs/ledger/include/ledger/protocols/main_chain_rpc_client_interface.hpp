@@ -17,31 +17,42 @@
 //
 //------------------------------------------------------------------------------
 
+#include "ledger/chain/compact_block.hpp"
 #include "ledger/chain/time_travelogue.hpp"
 #include "muddle/address.hpp"
 #include "network/generics/promise_of.hpp"
 
+#include <cstdint>
+#include <vector>
+
 namespace fetch {
 namespace ledger {
 
 class MainChainRpcClientInterface
 {
 public:
-  using Travelogue        = TimeTravelogue<Block>;
-  using Blocks            = Travelogue::Blocks;
-  using MuddleAddress     = muddle::Address;
-  using BlocksPromise     = network::PromiseOf<Blocks>;
-  using TraveloguePromise = network::PromiseOf<Travelogue>;
+  using Travelogue         = TimeTravelogue<Block>;
+  using Blocks             = Travelogue::Blocks;
+  using BlockHashes        = std::vector<Digest>;
+  using MuddleAddress      = muddle::Address;
+  using BlocksPromise      = network::PromiseOf<Blocks>;
+  using BlockHashesPromise = network::PromiseOf<BlockHashes>;
+  using TraveloguePromise  = network::PromiseOf<Travelogue>;
+  using LayoutsPromise     = network::PromiseOf<TransactionLayouts>;
 
   MainChainRpcClientInterface()          = default;
   virtual ~MainChainRpcClientInterface() = default;
 
   /// @name Main Chain Rpc Protocol
   /// @{
-  virtual BlocksPromise     GetHeaviestChain(MuddleAddress peer, uint64_t max_size) = 0;
-  virtual BlocksPromise     GetCommonSubChain(MuddleAddress peer, Digest start, Digest last_seen,
-                                              uint64_t limit)                       = 0;
-  virtual TraveloguePromise TimeTravel(MuddleAddress peer, Digest start)            = 0;
+  virtual BlocksPromise      GetHeaviestChain(MuddleAddress peer, uint64_t max_size) = 0;
+  virtual BlocksPromise      GetCommonSubChain(MuddleAddress peer, Digest start, Digest last_seen,
+                                               uint64_t limit)                       = 0;
+  virtual TraveloguePromise  TimeTravel(MuddleAddress peer, Digest start)            = 0;
+  virtual BlockHashesPromise GetChainSkeleton(MuddleAddress peer, uint64_t start, uint64_t stride,
+                                              uint64_t limit)                        = 0;
+  virtual LayoutsPromise     GetTransactionLayouts(MuddleAddress peer, Digest block_hash,
+                                                   BlockPositions positions)         = 0;
   /// @}
 };
 
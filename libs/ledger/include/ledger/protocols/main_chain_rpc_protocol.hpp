@@ -19,25 +19,33 @@
 
 #include "core/serializers/base_types.hpp"
 #include "core/service_ids.hpp"
+#include "ledger/chain/compact_block.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/chain/time_travelogue.hpp"
 #include "network/service/protocol.hpp"
 
+#include <algorithm>
+#include <cstdint>
+
 namespace fetch {
 namespace ledger {
 
 class MainChainProtocol : public service::Protocol
 {
 public:
-  using Travelogue                          = TimeTravelogue<Block>;
-  using Blocks                              = Travelogue::Blocks;
-  static constexpr char const *LOGGING_NAME = "MainChainProtocol";
+  using Travelogue                               = TimeTravelogue<Block>;
+  using Blocks                                   = Travelogue::Blocks;
+  using BlockHashes                              = MainChain::BlockHashes;
+  static constexpr char const *LOGGING_NAME      = "MainChainProtocol";
+  static constexpr uint64_t    MAX_SKELETON_SIZE = 1000;
 
   enum
   {
     HEAVIEST_CHAIN   = 1,
     TIME_TRAVEL      = 2,
-    COMMON_SUB_CHAIN = 3
+    COMMON_SUB_CHAIN = 3,
+    CHAIN_SKELETON   = 4,
+    TX_LAYOUTS       = 5
   };
 
   explicit MainChainProtocol(MainChain &chain)
@@ -46,6 +54,8 @@ public:
     Expose(HEAVIEST_CHAIN, this, &MainChainProtocol::GetHeaviestChain);
     Expose(COMMON_SUB_CHAIN, this, &MainChainProtocol::GetCommonSubChain);
     Expose(TIME_TRAVEL, this, &MainChainProtocol::TimeTravel);
+    Expose(CHAIN_SKELETON, this, &MainChainProtocol::GetChainSkeleton);
+    Expose(TX_LAYOUTS, this, &MainChainProtocol::GetTransactionLayouts);
   }
 
   Blocks GetHeaviestChain(uint64_t maxsize)
@@ -74,6 +84,22 @@ public:
     return {ret_val.heaviest_hash, ret_val.block_number, ret_val.status, Copy(ret_val.blocks)};
   }
 
+  BlockHashes GetChainSkeleton(uint64_t start, uint64_t stride, uint64_t limit)
+  {
+    return chain_.GetChainSkeleton(start, stride, std::min(limit, uint64_t{MAX_SKELETON_SIZE}));
+  }
+
+  TransactionLayouts GetTransactionLayouts(Digest block_hash, BlockPositions positions)
+  {
+    auto const block = chain_.GetBlock(block_hash);
+    if (!block)
+    {
+      return TransactionLayouts{};
+    }
+
+    return ledger::GetTransactionLayouts(*block, positions);
+  }
+
 private:
   static Blocks Copy(MainChain::Blocks const &blocks)
   {
@@ -21,8 +21,10 @@
 #include "core/mutex.hpp"
 #include "core/random/lcg.hpp"
 #include "core/state_machine.hpp"
+#include "ledger/chain/compact_block.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/consensus/consensus_interface.hpp"
+#include "ledger/protocols/block_sync_pipeline.hpp"
 #include "ledger/protocols/main_chain_rpc_protocol.hpp"
 #include "moment/deadline_timer.hpp"
 #include "muddle/rpc/client.hpp"
@@ -30,12 +32,17 @@
 #include "muddle/subscription.hpp"
 #include "network/generics/backgrounded_work.hpp"
 #include "network/generics/has_worker_thread.hpp"
+#include "network/generics/promise_of.hpp"
 #include "network/generics/requesting_queue.hpp"
 #include "network/p2pservice/p2ptrust_interface.hpp"
 #include "telemetry/telemetry.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -89,6 +96,17 @@ class MainChainSyncWorker;
  *                            │                    │
  *                            │                    │
  *                            └────────────────────┘
+ *
+ * When the peer reports that its heaviest chain extends far beyond our own, the sync switches to a
+ * pipelined mode. A skeleton of the chain (one hash every PIPELINED_SYNC_STRIDE blocks) is
+ * requested from the peer, after which the ranges between the skeleton entries are requested in
+ * parallel from all the connected peers. Each range is checked against the skeleton when it
+ * arrives and the ranges are added to the chain in order. Once the end of the skeleton has been
+ * reached the normal sync resumes with the original peer.
+ *
+ * With compact relay enabled newly mined blocks are broadcast as compact blocks, which carry short
+ * transaction ids in place of the transaction layouts. Receivers rebuild the block from the layouts
+ * they already know and request only the missing ones from the originating peer.
  */
 class MainChainRpcService : public muddle::rpc::Server,
                             public std::enable_shared_from_this<MainChainRpcService>
@@ -102,6 +120,9 @@ public:
     REQUEST_NEXT_BLOCKS,
     WAIT_FOR_NEXT_BLOCKS,
     COMPLETE_SYNC_WITH_PEER,
+    START_PIPELINED_SYNC,
+    WAIT_FOR_SKELETON,
+    PIPELINED_SYNC,
   };
 
   using MuddleEndpoint  = muddle::MuddleEndpoint;
@@ -117,8 +138,23 @@ public:
   using FutureTimepoint = core::FutureTimepoint;
   using ConsensusPtr    = std::shared_ptr<ConsensusInterface>;
 
-  static constexpr char const *LOGGING_NAME            = "MainChainRpc";
-  static constexpr uint64_t    PERIODIC_RESYNC_SECONDS = 20;
+  static constexpr char const *LOGGING_NAME             = "MainChainRpc";
+  static constexpr uint64_t    PERIODIC_RESYNC_SECONDS  = 20;
+  static constexpr std::size_t MAX_QUEUED_GOSSIP_BLOCKS = 64;  ///< Blocks awaiting processing
+
+  /// @name Pipelined Sync
+  /// @{
+  static constexpr uint64_t    PIPELINED_SYNC_THRESHOLD    = 2000;  ///< Min. blocks behind peer
+  static constexpr uint64_t    PIPELINED_SYNC_STRIDE       = 250;   ///< Blocks per range
+  static constexpr uint64_t    PIPELINED_SYNC_MAX_RANGES   = 400;   ///< Ranges per skeleton
+  static constexpr std::size_t MAX_BUFFERED_RANGES         = 16;    ///< Size of reorder buffer
+  static constexpr std::size_t MAX_RANGE_REQUESTS_PER_PEER = 2;     ///< Requests in flight per peer
+  /// @}
+
+  /// @name Compact Block Relay
+  /// @{
+  static constexpr std::size_t MAX_PENDING_COMPACT_BLOCKS = 16;  ///< Blocks awaiting layouts
+  /// @}
 
   enum class Mode
   {
@@ -146,6 +182,9 @@ public:
 
   void BroadcastBlock(Block const &block);
 
+  void SetLayoutLookup(LayoutLookup lookup);
+  void EnableCompactRelay(bool enable = true);
+
   State state() const
   {
     return state_machine_->state();
@@ -159,6 +198,8 @@ public:
   /// @name Subscription Handlers
   /// @{
   void OnNewBlock(Address const &from, Block &block, Address const &transmitter);
+  void OnNewCompactBlock(Address const &from, CompactBlock const &compact,
+                         Address const &transmitter);
   /// @}
 
   // Operators
@@ -179,6 +220,8 @@ private:
   void HandleChainResponse(Address const &address, BlockList blocks);
   template <class Begin, class End>
   void HandleChainResponse(Address const &address, Begin begin, End end);
+  template <class Begin, class End>
+  void VerifyNotarisations(Begin begin, End end) const;
   /// @}
 
   /// @name State Machine Handlers
@@ -189,6 +232,9 @@ private:
   State OnRequestNextSetOfBlocks();
   State OnWaitForBlocks();
   State OnCompleteSyncWithPeer();
+  State OnStartPipelinedSync();
+  State OnWaitForSkeleton();
+  State OnPipelinedSync();
 
   bool ValidBlock(Block const &block, char const *action) const;
   /// @}
@@ -226,6 +272,53 @@ private:
   std::atomic<uint16_t> loose_blocks_seen_{0};
   /// @}
 
+  /// @name Pipelined Sync Data
+  /// @{
+  struct RangeRequest
+  {
+    Address     peer{};
+    Promise     promise{};
+    std::size_t index{0};
+  };
+
+  using RangeRequests = std::vector<RangeRequest>;
+
+  bool UsePipelinedSync(MainChainProtocol::Travelogue const &log) const;
+  void UpdateRangeRequests();
+  void IssueRangeRequests();
+  void ResetPipelinedSync();
+
+  BlockSyncPipeline pipeline_{MAX_BUFFERED_RANGES};
+  Promise           skeleton_request_;
+  RangeRequests     range_requests_;
+  bool              pipeline_failed_{false};
+  /// @}
+
+  /// @name Compact Block Relay Data
+  /// @{
+  using LayoutsPromise = network::PromiseOf<TransactionLayouts>;
+
+  struct PendingCompactBlock
+  {
+    Address        from{};
+    Address        transmitter{};
+    Block          block{};
+    BlockPositions missing{};
+    LayoutsPromise promise{};
+  };
+
+  using PendingCompactBlocks = DigestMap<PendingCompactBlock>;
+
+  void OnCompactBlockLayouts(BlockHash const &hash);
+  void OnCompactBlockComplete(Address const &from, Block &block, Address const &transmitter);
+
+  SubscriptionPtr      compact_block_subscription_;
+  LayoutLookup         layout_lookup_;
+  std::atomic<bool>    compact_relay_{false};
+  Mutex                pending_compact_lock_;
+  PendingCompactBlocks pending_compact_blocks_;
+  /// @}
+
   /// @name Telemetry
   /// @{
   telemetry::CounterPtr         recv_block_count_;
@@ -240,6 +333,14 @@ private:
   telemetry::CounterPtr         state_request_next_blocks_;
   telemetry::CounterPtr         state_wait_for_next_blocks_;
   telemetry::CounterPtr         state_complete_sync_with_peer_;
+  telemetry::CounterPtr         state_start_pipelined_sync_;
+  telemetry::CounterPtr         state_wait_for_skeleton_;
+  telemetry::CounterPtr         state_pipelined_sync_;
+  telemetry::CounterPtr         pipelined_range_total_;
+  telemetry::CounterPtr         pipelined_range_failure_total_;
+  telemetry::CounterPtr         recv_compact_block_count_;
+  telemetry::CounterPtr         compact_block_missing_tx_count_;
+  telemetry::CounterPtr         compact_block_failure_count_;
   telemetry::GaugePtr<uint32_t> state_current_;
   telemetry::HistogramPtr       new_block_duration_;
   /// @}
@@ -261,6 +362,12 @@ constexpr char const *ToString(MainChainRpcService::State state) noexcept
     return "Waiting for Blocks";
   case MainChainRpcService::State::COMPLETE_SYNC_WITH_PEER:
     return "Completed Sync with Peer";
+  case MainChainRpcService::State::START_PIPELINED_SYNC:
+    return "Starting Pipelined Sync";
+  case MainChainRpcService::State::WAIT_FOR_SKELETON:
+    return "Waiting for Chain Skeleton";
+  case MainChainRpcService::State::PIPELINED_SYNC:
+    return "Pipelined Sync";
   }
 
   return "unknown";
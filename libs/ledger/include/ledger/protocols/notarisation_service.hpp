@@ -97,6 +97,13 @@ public:
   using BlockHeightNotarisationShares = std::map<BlockNumber, BlockNotarisationShares>;
   using BlockHeightGroupNotarisations = std::map<BlockNumber, BlockAggregateNotarisations>;
 
+  struct BlockNotarisation
+  {
+    BlockNumber        block_number;
+    BlockHash          block_hash;
+    AggregateSignature notarisation;
+  };
+
   NotarisationService()                            = delete;
   NotarisationService(NotarisationService const &) = delete;
 
@@ -131,6 +138,7 @@ public:
                             AggregateSignature const &notarisation);
   static bool        Verify(BlockHash const &block_hash, AggregateSignature const &notarisation,
                             AeonNotarisationKeys const &signed_notarisation_key, uint32_t threshold);
+  std::vector<NotarisationResult> Verify(std::vector<BlockNotarisation> const &notarisations);
   /// @}
 
   std::weak_ptr<core::Runnable> GetWeakRunnable();
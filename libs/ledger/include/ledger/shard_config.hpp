@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/cpu_topology.hpp"
 #include "crypto/prover.hpp"
 #include "muddle/network_id.hpp"
 
@@ -63,6 +64,19 @@ struct ShardConfig
   Timeperiod  sync_service_promise_timeout{30000};
   Timeperiod  sync_service_fetch_period{5000};
   /// @}
+
+  /// @name State Database Configuration
+  /// @{
+  bool     batched_state_writes{false};   ///< Accumulate state writes in memory until commit
+  bool     btree_state_index{false};      ///< Index the state with the B-tree rather than the KVI
+  bool     committed_state_reads{false};  ///< Serve queries from the last committed state
+  uint64_t state_history_depth{0};        ///< Num commits of state history retained, 0 = all
+  /// @}
+
+  /// @name Placement
+  /// @{
+  core::CpuList cpu_affinity{};  ///< The CPUs for the lane threads and memory, empty for any
+  /// @}
 };
 
 using ShardConfigs = std::vector<ShardConfig>;
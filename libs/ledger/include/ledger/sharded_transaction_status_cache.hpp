@@ -0,0 +1,300 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "core/mutex.hpp"
+#include "ledger/execution_result.hpp"
+#include "ledger/transaction_status_cache.hpp"
+#include "logging/logging.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Transaction status cache which splits the digest space into a number of independently locked
+ * shards (selected by the first byte of the digest) so that status queries and updates for
+ * different transactions do not contend on a single lock.
+ *
+ * Each shard also records its entries in coarse, time ordered buckets. Pruning only needs to
+ * visit the buckets which have expired, so the cost is proportional to the number of expired
+ * entries rather than the size of the cache. Only one thread will prune at any one time, all
+ * other updates carry on unimpeded.
+ */
+template <typename CLOCK = std::chrono::steady_clock>
+class ShardedTransactionStatusCache : public TransactionStatusCache
+{
+public:
+  using Clock     = CLOCK;
+  using Timepoint = typename Clock::time_point;
+
+  static constexpr std::size_t NUM_SHARDS = 16;
+
+  // Construction / Destruction
+  ShardedTransactionStatusCache();
+  ShardedTransactionStatusCache(ShardedTransactionStatusCache const &) = delete;
+  ShardedTransactionStatusCache(ShardedTransactionStatusCache &&)      = delete;
+  ~ShardedTransactionStatusCache() override                             = default;
+
+  TxStatus Query(Digest digest) const override;
+  void     Update(Digest digest, TransactionStatus status) override;
+  void     Update(Digest digest, ContractExecutionResult exec_result) override;
+
+  void        Prune(Timepoint const &until);
+  std::size_t size() const;
+
+  // Operators
+  ShardedTransactionStatusCache &operator=(ShardedTransactionStatusCache const &) = delete;
+  ShardedTransactionStatusCache &operator=(ShardedTransactionStatusCache &&) = delete;
+
+private:
+  using Duration = typename Clock::duration;
+  using Rep      = typename Duration::rep;
+  using Digests  = std::vector<DigestKey>;
+
+  static_assert((NUM_SHARDS & (NUM_SHARDS - 1u)) == 0, "Number of shards must be a power of 2");
+
+  static constexpr std::chrono::hours   LIFETIME{24};
+  static constexpr std::chrono::minutes INTERVAL{5};
+
+  struct Bucket
+  {
+    Timepoint start{};
+    Digests   digests{};
+  };
+
+  struct Shard
+  {
+    mutable Mutex          lock;
+    DigestKeyMap<TxStatus> entries{};
+    std::deque<Bucket>     buckets{};
+  };
+
+  using Shards = std::array<Shard, NUM_SHARDS>;
+
+  Shard &      LookupShard(Digest const &digest);
+  Shard const &LookupShard(Digest const &digest) const;
+
+  template <typename UPDATE>
+  void UpdateEntry(Digest const &digest, Timepoint const &now, UPDATE &&update);
+  void PruneIfNecessary(Timepoint const &now);
+
+  static void PruneShard(Shard &shard, Timepoint const &until);
+
+  Shards            shards_{};
+  std::atomic<Rep>  last_clean_;  ///< The time (since epoch) of the last prune
+  std::atomic<bool> pruning_{false};
+};
+
+template <typename CLOCK>
+constexpr std::size_t ShardedTransactionStatusCache<CLOCK>::NUM_SHARDS;
+template <typename CLOCK>
+constexpr std::chrono::hours ShardedTransactionStatusCache<CLOCK>::LIFETIME;
+template <typename CLOCK>
+constexpr std::chrono::minutes ShardedTransactionStatusCache<CLOCK>::INTERVAL;
+
+template <typename CLOCK>
+ShardedTransactionStatusCache<CLOCK>::ShardedTransactionStatusCache()
+  : last_clean_{Clock::now().time_since_epoch().count()}
+{}
+
+template <typename CLOCK>
+typename ShardedTransactionStatusCache<CLOCK>::TxStatus ShardedTransactionStatusCache<CLOCK>::Query(
+    Digest digest) const
+{
+  auto const &shard = LookupShard(digest);
+
+  FETCH_LOCK(shard.lock);
+
+  auto const it = shard.entries.find(digest);
+  if (shard.entries.end() != it)
+  {
+    return it->second;
+  }
+
+  return {};
+}
+
+template <typename CLOCK>
+void ShardedTransactionStatusCache<CLOCK>::Update(Digest digest, TransactionStatus status)
+{
+  auto const now{Clock::now()};
+
+  if (TransactionStatus::EXECUTED == status)
+  {
+    FETCH_LOG_WARN("TransactionStatusCache",
+                   "Using inappropriate method to update contract "
+                   "execution result. (tx digest: 0x",
+                   digest.ToHex(), ")");
+
+    throw std::runtime_error(
+        "TransactionStatusCache::Update(...): Using inappropriate method to update"
+        "contract execution result");
+  }
+
+  UpdateEntry(digest, now, [status](TxStatus &tx_status) { tx_status.status = status; });
+  NotifyUpdate();
+
+  PruneIfNecessary(now);
+}
+
+template <typename CLOCK>
+void ShardedTransactionStatusCache<CLOCK>::Update(Digest                  digest,
+                                                   ContractExecutionResult exec_result)
+{
+  auto const now{Clock::now()};
+
+  UpdateEntry(digest, now, [&exec_result](TxStatus &tx_status) {
+    tx_status.status               = TransactionStatus::EXECUTED;
+    tx_status.contract_exec_result = exec_result;
+  });
+  NotifyUpdate();
+
+  PruneIfNecessary(now);
+}
+
+/**
+ * Remove all the entries which are older than the lifetime of the cache
+ *
+ * @param until The current time point
+ */
+template <typename CLOCK>
+void ShardedTransactionStatusCache<CLOCK>::Prune(Timepoint const &until)
+{
+  for (auto &shard : shards_)
+  {
+    PruneShard(shard, until);
+  }
+
+  last_clean_ = until.time_since_epoch().count();
+}
+
+/**
+ * Get the total number of entries in the cache
+ *
+ * @return The number of cached entries
+ */
+template <typename CLOCK>
+std::size_t ShardedTransactionStatusCache<CLOCK>::size() const
+{
+  std::size_t total{0};
+
+  for (auto const &shard : shards_)
+  {
+    FETCH_LOCK(shard.lock);
+    total += shard.entries.size();
+  }
+
+  return total;
+}
+
+template <typename CLOCK>
+typename ShardedTransactionStatusCache<CLOCK>::Shard &
+ShardedTransactionStatusCache<CLOCK>::LookupShard(Digest const &digest)
+{
+  std::size_t const index = digest.empty() ? 0u : digest[0];
+  return shards_[index & (NUM_SHARDS - 1u)];
+}
+
+template <typename CLOCK>
+typename ShardedTransactionStatusCache<CLOCK>::Shard const &
+ShardedTransactionStatusCache<CLOCK>::LookupShard(Digest const &digest) const
+{
+  std::size_t const index = digest.empty() ? 0u : digest[0];
+  return shards_[index & (NUM_SHARDS - 1u)];
+}
+
+template <typename CLOCK>
+template <typename UPDATE>
+void ShardedTransactionStatusCache<CLOCK>::UpdateEntry(Digest const &digest, Timepoint const &now,
+                                                       UPDATE &&update)
+{
+  auto &         shard = LookupShard(digest);
+  DigestKey const key{digest};
+
+  FETCH_LOCK(shard.lock);
+
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end())
+  {
+    it = shard.entries.emplace(key, TxStatus{}).first;
+
+    // record the entry in the current expiry bucket
+    if (shard.buckets.empty() || ((now - shard.buckets.back().start) >= INTERVAL))
+    {
+      shard.buckets.emplace_back(Bucket{now, {}});
+    }
+
+    shard.buckets.back().digests.emplace_back(key);
+  }
+
+  update(it->second);
+}
+
+template <typename CLOCK>
+void ShardedTransactionStatusCache<CLOCK>::PruneIfNecessary(Timepoint const &now)
+{
+  Timepoint const last_clean{Duration{last_clean_.load()}};
+  if ((now - last_clean) < INTERVAL)
+  {
+    return;
+  }
+
+  // only a single thread should be pruning at any one time
+  bool expected{false};
+  if (pruning_.compare_exchange_strong(expected, true))
+  {
+    Prune(now);
+    pruning_ = false;
+  }
+}
+
+template <typename CLOCK>
+void ShardedTransactionStatusCache<CLOCK>::PruneShard(Shard &shard, Timepoint const &until)
+{
+  FETCH_LOCK(shard.lock);
+
+  while (!shard.buckets.empty())
+  {
+    auto &bucket = shard.buckets.front();
+
+    // buckets are time ordered, all remaining buckets are therefore still alive
+    if ((until - bucket.start) <= (LIFETIME + INTERVAL))
+    {
+      break;
+    }
+
+    for (auto const &digest : bucket.digests)
+    {
+      shard.entries.erase(digest);
+    }
+
+    shard.buckets.pop_front();
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
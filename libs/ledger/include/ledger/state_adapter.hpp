@@ -22,6 +22,7 @@
 
 #include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace fetch {
@@ -47,7 +48,8 @@ public:
   enum class Mode
   {
     READ_ONLY,
-    READ_WRITE
+    READ_WRITE,
+    READ_COMMITTED  ///< Read only, from the last committed state
   };
 
   // Construction / Destruction
@@ -59,13 +61,22 @@ public:
   Status Read(std::string const &key, void *data, uint64_t &size) override;
   Status Write(std::string const &key, void const *data, uint64_t size) override;
   Status Exists(std::string const &key) override;
+  Status ReadBatch(Keys const &keys) override;
   /// @}
 
+  virtual bool IsAllowedResource(std::string const &key) const;
+
   void PushContext(ConstByteArray const &scope);
   void PopContext();
 
 protected:
-  ConstByteArray CurrentScope() const;
+  using Document          = StorageInterface::Document;
+  using PrefetchedEntries = std::unordered_map<storage::ResourceAddress, Document>;
+  using Addresses         = std::unordered_map<std::string, storage::ResourceAddress>;
+
+  ConstByteArray                  CurrentScope() const;
+  storage::ResourceAddress const &Address(std::string const &key) const;
+  Document                        Lookup(storage::ResourceAddress const &address) const;
 
   // Protected construction
   StateAdapter(StorageInterface &storage, ConstByteArray scope, Mode mode);
@@ -73,6 +84,22 @@ protected:
   StorageInterface &          storage_;
   std::vector<ConstByteArray> scope_;
   Mode const                  mode_;
+  PrefetchedEntries           prefetched_{};  ///< The documents retrieved by ReadBatch
+
+private:
+  mutable std::vector<Addresses> addresses_;  ///< The resolved addresses of each scope
+};
+
+/**
+ * Read only adapter which serves the last committed state of the ledger, so that queries see a
+ * consistent view of the state and do not contend with the execution of the next block.
+ */
+class CommittedStateAdapter : public StateAdapter
+{
+public:
+  // Construction / Destruction
+  CommittedStateAdapter(StorageInterface &storage, ConstByteArray scope);
+  ~CommittedStateAdapter() override = default;
 };
 
 }  // namespace ledger
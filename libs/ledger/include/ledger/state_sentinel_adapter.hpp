@@ -45,8 +45,11 @@ public:
   Status Read(std::string const &key, void *data, uint64_t &size) override;
   Status Write(std::string const &key, void const *data, uint64_t size) override;
   Status Exists(std::string const &key) override;
+  Status ReadBatch(Keys const &keys) override;
   /// @}
 
+  bool IsAllowedResource(std::string const &key) const override;
+
   /// @name Counter Access
   /// @{
   uint64_t num_lookups() const;
@@ -55,8 +58,6 @@ public:
   /// @}
 
 private:
-  bool IsAllowedResource(std::string const &key) const;
-
   /// @name Shard Limits
   /// @{
   BitVector const shards_;
@@ -51,6 +51,8 @@ public:
   bool     Lock(ShardIndex index) override;
   bool     Unlock(ShardIndex index) override;
   void     Reset() override;
+
+  Documents GetBatch(ResourceAddresses const &keys) const override;
   /// @}
 
 private:
@@ -23,16 +23,19 @@ namespace fetch {
 namespace ledger {
 
 class LaneController;
+class StateSnapshotSync;
 
 class LaneControllerProtocol : public service::Protocol
 {
 public:
   enum
   {
-    USE_THESE_PEERS = 1
+    USE_THESE_PEERS       = 1,
+    BEGIN_STATE_SNAPSHOT  = 2,
+    STATE_SNAPSHOT_STATUS = 3
   };
 
-  explicit LaneControllerProtocol(LaneController &ctrl);
+  LaneControllerProtocol(LaneController &ctrl, StateSnapshotSync &snapshot_sync);
   ~LaneControllerProtocol() override = default;
 };
 
@@ -19,6 +19,7 @@
 
 #include "core/mutex.hpp"
 #include "ledger/shard_config.hpp"
+#include "ledger/storage_unit/state_snapshot_sync.hpp"
 #include "muddle/rpc/client.hpp"
 #include "shards/shard_management_interface.hpp"
 
@@ -35,6 +36,7 @@ public:
   static constexpr char const *LOGGING_NAME = "LaneRemoteControl";
 
   using MuddleEndpoint = muddle::MuddleEndpoint;
+  using SnapshotStatus = StateSnapshotSync::Status;
 
   // Construction / Destruction
   LaneRemoteControl(MuddleEndpoint &endpoint, ShardConfigs const &shards, uint32_t log2_num_lanes);
@@ -42,6 +44,12 @@ public:
   LaneRemoteControl(LaneRemoteControl &&other)      = delete;
   ~LaneRemoteControl() override                     = default;
 
+  /// @name State Snapshots
+  /// @{
+  bool           BeginStateSnapshot(LaneIndex lane);
+  SnapshotStatus GetStateSnapshotStatus(LaneIndex lane);
+  /// @}
+
   // Operators
   LaneRemoteControl &operator=(LaneRemoteControl const &other) = delete;
   LaneRemoteControl &operator=(LaneRemoteControl &&other) = delete;
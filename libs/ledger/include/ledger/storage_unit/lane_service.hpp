@@ -26,6 +26,7 @@
 #include "network/generics/backgrounded_work.hpp"
 #include "network/generics/has_worker_thread.hpp"
 
+#include <cstddef>
 #include <memory>
 
 namespace fetch {
@@ -61,15 +62,18 @@ class TransactionStoreSyncProtocol;
 class TransactionStoreSyncService;
 class LaneController;
 class LaneControllerProtocol;
+class StateSnapshotProtocol;
+class StateSnapshotSync;
 
 class LaneService
 {
 public:
   static constexpr char const *LOGGING_NAME = "LaneService";
 
-  using MuddlePtr      = muddle::MuddlePtr;
-  using CertificatePtr = muddle::ProverPtr;
-  using NetworkManager = network::NetworkManager;
+  using MuddlePtr          = muddle::MuddlePtr;
+  using CertificatePtr     = muddle::ProverPtr;
+  using NetworkManager     = network::NetworkManager;
+  using ShardedBalancesPtr = chain::ShardedBalancesPtr;
 
   enum class Mode
   {
@@ -83,6 +87,8 @@ public:
   LaneService(LaneService &&)      = delete;
   ~LaneService();
 
+  void SetShardedBalances(ShardedBalancesPtr sharded_balances);
+
   // Lane Control
   void StartInternal();
   void StartExternal();
@@ -91,6 +97,10 @@ public:
 
   bool SyncIsReady();
 
+  // Memory Management
+  std::size_t GetMemPoolSizeInBytes() const;
+  void        SpillMemPool(std::size_t target_size_in_bytes);
+
   ShardConfig const &config() const
   {
     return cfg_;
@@ -112,6 +122,8 @@ private:
   using LaneControllerProtocolPtr = std::shared_ptr<LaneControllerProtocol>;
   using StateDbPtr                = std::shared_ptr<StateDb>;
   using StateDbProtoPtr           = std::shared_ptr<StateDbProto>;
+  using SnapshotProtoPtr          = std::unique_ptr<StateSnapshotProtocol>;
+  using SnapshotSyncPtr           = std::unique_ptr<StateSnapshotSync>;
   using TxStorePtr                = std::shared_ptr<TransactionStorageEngine>;
   using TxStoreProtoPtr           = std::shared_ptr<TransactionStorageProtocol>;
   using TxSyncProtoPtr            = std::shared_ptr<TransactionStoreSyncProtocol>;
@@ -148,8 +160,10 @@ private:
 
   /// @name State Database Service
   /// @{
-  StateDbPtr      state_db_;
-  StateDbProtoPtr state_db_protocol_;
+  StateDbPtr       state_db_;
+  StateDbProtoPtr  state_db_protocol_;
+  SnapshotProtoPtr snapshot_protocol_;  ///< Serves snapshots of the state to peers
+  SnapshotSyncPtr  snapshot_sync_;      ///< Downloads snapshots of the state from peers
   /// @}
 
   /// @name Transaction Store
@@ -17,6 +17,8 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/sharded_balances.hpp"
+#include "chain/transaction_expiry_index.hpp"
 #include "chain/transaction_layout.hpp"
 #include "core/digest.hpp"
 #include "core/mutex.hpp"
@@ -36,29 +38,41 @@ namespace ledger {
 
 /**
  * The recent transactions cache is a fixed size of transactions that can be collected periodically
- * by the miner to be incorporated into the subsequent blocks
+ * by the miner to be incorporated into the subsequent blocks.
+ *
+ * Expired transactions are evicted by their expiry block. Their layouts are left in the queue and
+ * skipped when they reach the front (or dropped when they reach the back) so that eviction does not
+ * need to search the queue.
  */
 class RecentTransactionsCache
 {
 public:
-  using TxLayouts = std::vector<chain::TransactionLayout>;
+  using TxLayouts          = std::vector<chain::TransactionLayout>;
+  using BlockIndex         = chain::TransactionLayout::BlockIndex;
+  using ShardedBalancesPtr = chain::ShardedBalancesPtr;
 
   RecentTransactionsCache(std::size_t max_cache_size, uint32_t log2_num_lanes);
   ~RecentTransactionsCache() = default;
 
+  void        SetShardedBalances(ShardedBalancesPtr sharded_balances);
   void        Add(chain::Transaction const &tx);
   std::size_t GetSize() const;
   TxLayouts   Flush(std::size_t num_to_flush);
+  std::size_t RemoveExpired(BlockIndex block_index);
 
 private:
   using LayoutQueue = std::deque<chain::TransactionLayout>;
 
+  bool Drop(chain::TransactionLayout const &layout);
+
   std::size_t const max_cache_size_;
   uint32_t const    log2_num_lanes_;
 
-  mutable Mutex lock_;
-  DigestSet     digests_;
-  LayoutQueue   queue_;
+  mutable Mutex                 lock_;
+  ShardedBalancesPtr            sharded_balances_;
+  DigestSet                     digests_;  ///< The digests of the (unexpired) cached transactions
+  LayoutQueue                   queue_;
+  chain::TransactionExpiryIndex expiry_index_;
 };
 
 }  // namespace ledger
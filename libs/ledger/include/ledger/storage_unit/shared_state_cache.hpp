@@ -0,0 +1,156 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+#include "chain/transaction.hpp"
+#include "core/digest.hpp"
+#include "core/mutex.hpp"
+#include "ledger/storage_unit/storage_unit_interface.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Read cache shared between all of the executors of an execution manager.
+ *
+ * Successful reads from the underlying storage unit are cached so that hot keys (token balances,
+ * the fee treasury, etc.) are only retrieved from the lanes once per block. Writes are passed
+ * straight through to the storage unit and update the cached value.
+ *
+ * The cache is split into a number of independently locked shards so that concurrent executors
+ * rarely contend. Each invalidation (commit, revert, reset or a new block) advances the cache
+ * generation, so that a read which was in flight while the cache was invalidated is never
+ * inserted into the new generation.
+ *
+ * The transactions of the block being executed can also be prefetched in bulk, in the background
+ * and in execution order. Transaction lookups are then served from memory, waiting for the
+ * prefetch of the transaction when it is still in flight rather than requesting it again.
+ */
+class SharedStateCache : public StorageUnitInterface
+{
+public:
+  static constexpr std::size_t NUM_SHARDS = 16;
+
+  // Construction / Destruction
+  explicit SharedStateCache(StorageUnitInterface &storage);
+  SharedStateCache(SharedStateCache const &) = delete;
+  SharedStateCache(SharedStateCache &&)      = delete;
+  ~SharedStateCache() override;
+
+  /// @name Cache Control
+  /// @{
+  void        Invalidate();
+  std::size_t size() const;
+  /// @}
+
+  /// @name Transaction Prefetch
+  /// @{
+  void PrefetchTransactions(std::vector<Digests> batches);
+  /// @}
+
+  /// @name State Interface
+  /// @{
+  Document  Get(ResourceAddress const &key) const override;
+  Document  GetOrCreate(ResourceAddress const &key) override;
+  void      Set(ResourceAddress const &key, StateValue const &value) override;
+  bool      Lock(ShardIndex shard) override;
+  bool      Unlock(ShardIndex shard) override;
+  void      Reset() override;
+  Documents GetBatch(ResourceAddresses const &keys) const override;
+  void      SetBatch(ResourceAddresses const &keys, StateValues const &values) override;
+  /// @}
+
+  /// @name Transaction Interface
+  /// @{
+  void      AddTransaction(chain::Transaction const &tx) override;
+  bool      GetTransaction(Digest const &digest, chain::Transaction &tx) override;
+  bool      HasTransaction(Digest const &digest) override;
+  void      IssueCallForMissingTxs(DigestSet const &tx_set) override;
+  void      SetTransactionCallback(TransactionCallback callback) override;
+  void      RemoveExpiredTransactions(uint64_t block_index) override;
+  TxLayouts PollRecentTx(uint32_t max_to_poll) override;
+  /// @}
+
+  /// @name Revertible Document Store Interface
+  /// @{
+  Hash CurrentHash() override;
+  Hash LastCommitHash() override;
+  bool RevertToHash(Hash const &hash, uint64_t index) override;
+  Hash Commit(uint64_t index) override;
+  bool HashExists(Hash const &hash, uint64_t index) override;
+  /// @}
+
+  // Operators
+  SharedStateCache &operator=(SharedStateCache const &) = delete;
+  SharedStateCache &operator=(SharedStateCache &&) = delete;
+
+private:
+  using Generation = uint64_t;
+  using Values     = std::unordered_map<ResourceAddress, StateValue>;
+
+  struct Shard
+  {
+    mutable Mutex lock;
+    Values        values{};
+  };
+
+  using Shards       = std::array<Shard, NUM_SHARDS>;
+  using Transactions = DigestMap<chain::Transaction>;
+
+  Shard &Lookup(ResourceAddress const &key) const;
+  bool   Find(ResourceAddress const &key, Document &document) const;
+  void   Insert(ResourceAddress const &key, Document const &document, Generation generation) const;
+
+  void CancelPrefetch();
+  void Prefetch(std::vector<Digests> const &batches);
+
+  StorageUnitInterface &storage_;  ///< The underlying storage unit
+
+  mutable Shards          shards_{};
+  std::atomic<Generation> generation_{0};
+
+  /// @name Transaction Prefetch
+  /// @{
+  std::mutex              tx_lock_;                    ///< guards the transactions below
+  std::condition_variable tx_arrived_;                 ///< signalled as each batch arrives
+  Transactions            txs_{};                      ///< The prefetched transactions
+  DigestSet               pending_txs_{};              ///< The transactions in flight
+  std::future<void>       prefetch_{};                 ///< The running prefetch
+  std::atomic<bool>       prefetch_cancelled_{false};  ///< Abandon the remaining batches
+  /// @}
+
+  telemetry::CounterPtr hit_count_;
+  telemetry::CounterPtr miss_count_;
+  telemetry::CounterPtr bytes_saved_count_;
+  telemetry::CounterPtr invalidation_count_;
+  telemetry::CounterPtr tx_hit_count_;
+  telemetry::CounterPtr tx_miss_count_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
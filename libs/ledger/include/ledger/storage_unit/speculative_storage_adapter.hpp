@@ -0,0 +1,110 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "ledger/storage_unit/storage_unit_interface.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Storage unit adapter used for optimistic (speculative) execution of transactions.
+ *
+ * All reads are served from the underlying storage unit (after the pending writes of the current
+ * speculation) and are recorded in a read set. All writes are buffered in a write set and are
+ * never forwarded to the underlying storage. Once the speculation is complete the access set can
+ * be extracted, validated against the writes of previously committed transactions and, if there
+ * is no conflict, applied to the real storage.
+ *
+ * An adapter is expected to be used by one executor at a time.
+ */
+class SpeculativeStorageAdapter : public StorageUnitInterface
+{
+public:
+  using KeySet   = std::unordered_set<ResourceAddress>;
+  using WriteSet = std::unordered_map<ResourceAddress, StateValue>;
+
+  struct AccessSet
+  {
+    KeySet   reads{};
+    WriteSet writes{};
+
+    bool ConflictsWith(KeySet const &dirty_keys) const;
+    void ApplyTo(StorageInterface &storage, KeySet &dirty_keys) const;
+  };
+
+  // Construction / Destruction
+  explicit SpeculativeStorageAdapter(StorageUnitInterface &storage);
+  SpeculativeStorageAdapter(SpeculativeStorageAdapter const &) = delete;
+  SpeculativeStorageAdapter(SpeculativeStorageAdapter &&)      = delete;
+  ~SpeculativeStorageAdapter() override                         = default;
+
+  /// @name Speculation Control
+  /// @{
+  void      Begin();
+  AccessSet TakeAccessSet();
+  /// @}
+
+  /// @name State Interface
+  /// @{
+  Document Get(ResourceAddress const &key) const override;
+  Document GetOrCreate(ResourceAddress const &key) override;
+  void     Set(ResourceAddress const &key, StateValue const &value) override;
+  bool     Lock(ShardIndex shard) override;
+  bool     Unlock(ShardIndex shard) override;
+  void     Reset() override;
+  /// @}
+
+  /// @name Transaction Interface
+  /// @{
+  void      AddTransaction(chain::Transaction const &tx) override;
+  bool      GetTransaction(Digest const &digest, chain::Transaction &tx) override;
+  bool      HasTransaction(Digest const &digest) override;
+  void      IssueCallForMissingTxs(DigestSet const &tx_set) override;
+  TxLayouts PollRecentTx(uint32_t max_to_poll) override;
+  /// @}
+
+  /// @name Revertible Document Store Interface
+  /// @{
+  Hash CurrentHash() override;
+  Hash LastCommitHash() override;
+  bool RevertToHash(Hash const &hash, uint64_t index) override;
+  Hash Commit(uint64_t index) override;
+  bool HashExists(Hash const &hash, uint64_t index) override;
+  /// @}
+
+  // Operators
+  SpeculativeStorageAdapter &operator=(SpeculativeStorageAdapter const &) = delete;
+  SpeculativeStorageAdapter &operator=(SpeculativeStorageAdapter &&) = delete;
+
+private:
+  using ReadValues = std::unordered_map<ResourceAddress, Document>;
+
+  StorageUnitInterface &storage_;  ///< The underlying (committed) storage unit
+
+  mutable Mutex      lock_;
+  mutable ReadValues reads_{};   ///< The values observed from the underlying storage
+  WriteSet           writes_{};  ///< The buffered writes of the current speculation
+};
+
+}  // namespace ledger
+}  // namespace fetch
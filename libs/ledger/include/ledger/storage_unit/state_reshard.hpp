@@ -1,3 +1,4 @@
+#pragma once
 //------------------------------------------------------------------------------
 //
 //   Copyright 2018-2020 Fetch.AI Limited
@@ -16,24 +17,17 @@
 //
 //------------------------------------------------------------------------------
 
-#include "oef-core/karma/KarmaRefreshTask.hpp"
+#include "storage/new_revertible_document_store.hpp"
 
-#include <iostream>
+#include <cstdint>
 #include <string>
 
-#include "oef-core/karma/IKarmaPolicy.hpp"
+namespace fetch {
+namespace ledger {
 
-fetch::oef::base::ExitState KarmaRefreshTask::run()
-{
-  std::chrono::high_resolution_clock::time_point this_execute =
-      std::chrono::high_resolution_clock::now();
-  std::chrono::milliseconds d =
-      std::chrono::duration_cast<std::chrono::milliseconds>(this_execute - last_execute);
-  last_execute = std::chrono::high_resolution_clock::now();
+bool ReshardState(std::string const &source_path, uint32_t source_lanes,
+                  std::string const &destination_path, uint32_t destination_lanes,
+                  storage::NewRevertibleDocumentStore::IndexBackend backend);
 
-  // FETCH_LOG_INFO(LOGGING_NAME, "LOGGED KarmaRefreshTask RUN ms=" + std::to_string(d.count()));
-  policy->RefreshCycle(d);
-
-  submit(std::chrono::milliseconds(interval));
-  return fetch::oef::base::COMPLETE;
-}
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,78 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/service/protocol.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage/state_snapshot.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace storage {
+
+class NewRevertibleDocumentStore;
+
+}  // namespace storage
+namespace ledger {
+
+/**
+ * Serves the contents of a lane's state database to peers in chunks, so that a new node can build
+ * its state from a snapshot rather than executing the whole of the chain.
+ */
+class StateSnapshotProtocol : public service::Protocol
+{
+public:
+  using StateDb    = storage::NewRevertibleDocumentStore;
+  using Chunk      = storage::StateSnapshotChunk;
+  using ResourceID = storage::ResourceID;
+
+  enum
+  {
+    GET_CHUNK = 1
+  };
+
+  static constexpr char const *LOGGING_NAME      = "StateSnapshotProtocol";
+  static constexpr std::size_t MAX_CHUNK_ENTRIES = 256;
+
+  // Construction / Destruction
+  StateSnapshotProtocol(StateDb &state_db, uint32_t lane);
+  StateSnapshotProtocol(StateSnapshotProtocol const &) = delete;
+  StateSnapshotProtocol(StateSnapshotProtocol &&)      = delete;
+  ~StateSnapshotProtocol() override                    = default;
+
+  // Operators
+  StateSnapshotProtocol &operator=(StateSnapshotProtocol const &) = delete;
+  StateSnapshotProtocol &operator=(StateSnapshotProtocol &&) = delete;
+
+private:
+  Chunk GetChunk(ResourceID const &cursor);
+
+  StateDb &      state_db_;
+  uint32_t const lane_;
+
+  // telemetry
+  telemetry::CounterPtr   chunk_total_;
+  telemetry::CounterPtr   chunk_failure_total_;
+  telemetry::HistogramPtr chunk_durations_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
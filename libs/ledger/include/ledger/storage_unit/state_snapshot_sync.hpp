@@ -0,0 +1,139 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/state_machine.hpp"
+#include "muddle/address.hpp"
+#include "muddle/rpc/client.hpp"
+#include "network/service/promise.hpp"
+#include "storage/resource_mapper.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace fetch {
+namespace muddle {
+
+class MuddleEndpoint;
+
+}  // namespace muddle
+namespace storage {
+
+class NewRevertibleDocumentStore;
+
+}  // namespace storage
+namespace ledger {
+
+/**
+ * Replaces the contents of a lane's state database with a snapshot of the current state of one of
+ * the lane's peers.
+ *
+ * The snapshot is downloaded in chunks (see StateSnapshotProtocol). Every chunk must report the
+ * same state hash as the first, and once the final chunk has been written the state is committed
+ * and the resulting hash must match the one reported by the peer. Since the snapshot replaces the
+ * existing state it should only be requested by a node which has not yet built any state beyond
+ * genesis.
+ */
+class StateSnapshotSync
+{
+public:
+  using MuddleEndpoint = muddle::MuddleEndpoint;
+  using StateDb        = storage::NewRevertibleDocumentStore;
+  using WeakRunnable   = core::WeakRunnable;
+
+  enum class State
+  {
+    IDLE,
+    SELECT_PEER,
+    REQUEST_CHUNK,
+    WAIT_FOR_CHUNK,
+  };
+
+  enum class Status : uint8_t
+  {
+    IDLE = 0,
+    IN_PROGRESS,
+    COMPLETE,
+    FAILED,
+  };
+
+  static constexpr char const *LOGGING_NAME = "StateSnapshotSync";
+  static constexpr std::size_t MAX_ATTEMPTS = 5;
+
+  // Construction / Destruction
+  StateSnapshotSync(MuddleEndpoint &endpoint, StateDb &state_db, uint32_t lane);
+  StateSnapshotSync(StateSnapshotSync const &) = delete;
+  StateSnapshotSync(StateSnapshotSync &&)      = delete;
+  ~StateSnapshotSync()                         = default;
+
+  WeakRunnable GetWeakRunnable() const;
+
+  /// @name Remote Control
+  /// @{
+  bool    Begin();
+  uint8_t GetStatus();
+  /// @}
+
+  // Operators
+  StateSnapshotSync &operator=(StateSnapshotSync const &) = delete;
+  StateSnapshotSync &operator=(StateSnapshotSync &&) = delete;
+
+private:
+  using Address         = muddle::Address;
+  using Client          = muddle::rpc::Client;
+  using StateMachine    = core::StateMachine<State>;
+  using StateMachinePtr = std::shared_ptr<StateMachine>;
+  using AtomicStatus    = std::atomic<Status>;
+  using Hash            = byte_array::ConstByteArray;
+
+  /// @name State Handlers
+  /// @{
+  State OnIdle();
+  State OnSelectPeer();
+  State OnRequestChunk();
+  State OnWaitForChunk();
+  /// @}
+
+  void  ClearState();
+  State Retry();
+
+  MuddleEndpoint &    endpoint_;
+  StateDb &           state_db_;
+  uint32_t const      lane_;
+  Client              rpc_client_;
+  StateMachinePtr     state_machine_;
+  AtomicStatus        status_{Status::IDLE};
+  std::size_t         attempts_{0};
+  Address             peer_{};
+  storage::ResourceID cursor_{};    ///< The last key of the previous chunk
+  Hash                expected_{};  ///< The state hash reported by the first chunk
+  service::Promise    promise_{};
+  std::size_t         num_entries_{0};
+
+  // telemetry
+  telemetry::CounterPtr chunk_total_;
+  telemetry::CounterPtr restart_total_;
+  telemetry::CounterPtr success_total_;
+  telemetry::CounterPtr failure_total_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
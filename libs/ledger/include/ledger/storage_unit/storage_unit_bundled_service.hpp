@@ -25,6 +25,7 @@
 #include "storage/object_store.hpp"
 
 #include <cstddef>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -53,26 +54,33 @@ public:
     // create all the lane pointers
     lanes_.resize(configs.size());
 
-    for (std::size_t i = 0; i < configs.size(); ++i)
-    {
+    // Loading the stores of a lane is dominated by disk reads, so the lanes are recovered
+    // concurrently rather than one after another
+    ForEachLaneConcurrently([this, &mgr, &configs, mode](std::size_t i) {
+      // construct the lane on its own CPUs so that its caches are allocated on the local node
+      core::ScopedThreadAffinity const placement{configs[i].cpu_affinity};
+
       lanes_[i] = std::make_shared<LaneService>(mgr, configs[i], mode);
-    }
+    });
   }
 
-  void StartInternal()
+  void SetShardedBalances(chain::ShardedBalancesPtr const &sharded_balances)
   {
     for (auto &lane : lanes_)
     {
-      lane->StartInternal();
+      lane->SetShardedBalances(sharded_balances);
     }
   }
 
+  void StartInternal()
+  {
+    // each lane binds its own servers, so the lanes are brought up side by side
+    ForEachLaneConcurrently([this](std::size_t i) { lanes_[i]->StartInternal(); });
+  }
+
   void StartExternal()
   {
-    for (auto &lane : lanes_)
-    {
-      lane->StartExternal();
-    }
+    ForEachLaneConcurrently([this](std::size_t i) { lanes_[i]->StartExternal(); });
   }
 
   void StopExternal()
@@ -93,7 +101,69 @@ public:
     lanes_.clear();
   }
 
+  /**
+   * Get the approximate size of the transactions held in the memory pools of all the lanes
+   *
+   * @return The size in bytes
+   */
+  std::size_t GetMemPoolSizeInBytes() const
+  {
+    std::size_t size{0};
+    for (auto const &lane : lanes_)
+    {
+      size += lane->GetMemPoolSizeInBytes();
+    }
+
+    return size;
+  }
+
+  /**
+   * Move transactions from the memory pools of the lanes to disk, until together they are no
+   * larger than the target size. The target is shared equally between the lanes.
+   *
+   * @param target_size_in_bytes The size to which the memory pools are reduced
+   */
+  void SpillMemPools(std::size_t target_size_in_bytes)
+  {
+    if (lanes_.empty())
+    {
+      return;
+    }
+
+    std::size_t const lane_target = target_size_in_bytes / lanes_.size();
+    for (auto &lane : lanes_)
+    {
+      lane->SpillMemPool(lane_target);
+    }
+  }
+
 private:
+  /**
+   * Runs a function for the index of every lane, each on its own thread. Waits for every lane
+   * before rethrowing the first failure
+   */
+  template <typename Function>
+  void ForEachLaneConcurrently(Function &&function)
+  {
+    std::vector<std::future<void>> pending;
+    pending.reserve(lanes_.size());
+
+    for (std::size_t i = 0; i < lanes_.size(); ++i)
+    {
+      pending.emplace_back(std::async(std::launch::async, [&function, i]() { function(i); }));
+    }
+
+    for (auto &lane : pending)
+    {
+      lane.wait();
+    }
+
+    for (auto &lane : pending)
+    {
+      lane.get();
+    }
+  }
+
   using LaneServicePtr  = std::shared_ptr<LaneService>;
   using LaneServiceList = std::vector<LaneServicePtr>;
 
@@ -19,6 +19,7 @@
 
 #include "core/future_timepoint.hpp"
 #include "core/service_ids.hpp"
+#include "core/synchronisation/protected.hpp"
 #include "crypto/merkle_tree.hpp"
 #include "ledger/shard_config.hpp"
 #include "ledger/storage_unit/lane_connectivity_details.hpp"
@@ -30,14 +31,18 @@
 #include "muddle/rpc/server.hpp"
 #include "network/generics/backgrounded_work.hpp"
 #include "network/generics/has_worker_thread.hpp"
+#include "network/service/promise.hpp"
 #include "storage/document_store_protocol.hpp"
 #include "storage/object_stack.hpp"
+#include "telemetry/telemetry.hpp"
 
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <exception>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -64,15 +69,23 @@ public:
 
   /// @name Storage Unit Interface
   /// @{
-  void      AddTransaction(chain::Transaction const &tx) override;
-  bool      GetTransaction(ConstByteArray const &digest, chain::Transaction &tx) override;
-  bool      HasTransaction(ConstByteArray const &digest) override;
-  void      IssueCallForMissingTxs(DigestSet const &digest_set) override;
-  TxLayouts PollRecentTx(uint32_t max_to_poll) override;
-
-  Document GetOrCreate(ResourceAddress const &key) override;
-  Document Get(ResourceAddress const &key) const override;
-  void     Set(ResourceAddress const &key, StateValue const &value) override;
+  void         AddTransaction(chain::Transaction const &tx) override;
+  bool         GetTransaction(ConstByteArray const &digest, chain::Transaction &tx) override;
+  bool         HasTransaction(ConstByteArray const &digest) override;
+  void         IssueCallForMissingTxs(DigestSet const &digest_set) override;
+  Transactions GetTransactions(Digests const &digests) override;
+  void         SetTransactionCallback(TransactionCallback callback) override;
+  void         RemoveExpiredTransactions(uint64_t block_index) override;
+  TxLayouts    PollRecentTx(uint32_t max_to_poll) override;
+
+  Document  GetOrCreate(ResourceAddress const &key) override;
+  Document  Get(ResourceAddress const &key) const override;
+  void      Set(ResourceAddress const &key, StateValue const &value) override;
+  Documents GetBatch(ResourceAddresses const &keys) const override;
+  void      SetBatch(ResourceAddresses const &keys, StateValues const &values) override;
+  Document  GetCommitted(ResourceAddress const &key) const override;
+  Documents GetCommittedBatch(ResourceAddresses const &keys) const override;
+  void      Import(ResourceAddresses const &keys, StateValues const &values) override;
 
   void Reset() override;
 
@@ -96,12 +109,26 @@ private:
   using AddressList          = std::vector<muddle::Address>;
   using MerkleTree           = crypto::MerkleTree;
   using PermanentMerkleStack = fetch::storage::ObjectStack<crypto::MerkleTree>;
+  using Promises             = std::vector<service::Promise>;
+  using LaneHistograms       = std::vector<telemetry::HistogramPtr>;
+  using ResponseHandler      = std::function<bool(LaneIndex, service::Promise const &)>;
+  using Timepoint            = std::chrono::steady_clock::time_point;
 
   Address const &LookupAddress(ShardIndex shard) const;
   Address const &LookupAddress(storage::ResourceID const &resource) const;
 
   bool HashInStack(Hash const &hash, uint64_t index);
 
+  Document  GetDocument(ResourceAddress const &key, uint64_t function) const;
+  Documents GetDocuments(ResourceAddresses const &keys, uint64_t function) const;
+  void      SetDocuments(ResourceAddresses const &keys, StateValues const &values,
+                         uint64_t function, uint64_t extension);
+
+  Promises       CallAllLanes(uint64_t function, MerkleTree const *leaves = nullptr);
+  bool           WaitForLanes(Promises const &promises, LaneHistograms const &durations,
+                              Timepoint const &deadline, ResponseHandler const &on_response) const;
+  LaneHistograms CreateLaneHistograms(char const *operation) const;
+
   /// @name Client Information
   /// @{
   AddressList const addresses_;
@@ -109,12 +136,24 @@ private:
   ClientPtr         rpc_client_;
   /// @}
 
+  /// @name Notifications
+  /// @{
+  Protected<TransactionCallback> transaction_callback_{};
+  /// @}
+
   /// @name State Hash Support
   /// @{
   mutable Mutex        merkle_mutex_;
   MerkleTree           current_merkle_;
   PermanentMerkleStack permanent_state_merkle_stack_{};
   /// @}
+
+  /// @name Telemetry
+  /// @{
+  LaneHistograms current_hash_durations_;  ///< Per lane response times for the current hash
+  LaneHistograms commit_durations_;        ///< Per lane response times for commits
+  LaneHistograms revert_durations_;        ///< Per lane response times for reverts
+  /// @}
 };
 
 }  // namespace ledger
@@ -20,9 +20,13 @@
 #include "chain/transaction_layout.hpp"
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/digest.hpp"
+#include "core/macros.hpp"
 #include "storage/document.hpp"
 #include "storage/resource_mapper.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <vector>
 
 namespace fetch {
@@ -38,11 +42,14 @@ namespace ledger {
 class StorageInterface
 {
 public:
-  using Document        = storage::Document;
-  using ResourceAddress = storage::ResourceAddress;
-  using StateValue      = byte_array::ConstByteArray;
-  using ShardIndex      = uint32_t;
-  using Keys            = std::vector<storage::ResourceID>;
+  using Document          = storage::Document;
+  using Documents         = std::vector<Document>;
+  using ResourceAddress   = storage::ResourceAddress;
+  using ResourceAddresses = std::vector<ResourceAddress>;
+  using StateValue        = byte_array::ConstByteArray;
+  using StateValues       = std::vector<StateValue>;
+  using ShardIndex        = uint32_t;
+  using Keys              = std::vector<storage::ResourceID>;
 
   // Construction / Destruction
   StorageInterface()          = default;
@@ -57,6 +64,113 @@ public:
   virtual bool     Unlock(ShardIndex shard)                                 = 0;
   virtual void     Reset()                                                  = 0;
   /// @}
+
+  /// @name Batched State Interface
+  /// @{
+
+  /**
+   * Retrieve a batch of documents from the state
+   *
+   * The default implementation simply performs each lookup in turn, remote implementations should
+   * override this to retrieve the whole batch with as few round trips as possible.
+   *
+   * @param keys The keys to be retrieved
+   * @return The documents, in the same order as the keys
+   */
+  virtual Documents GetBatch(ResourceAddresses const &keys) const
+  {
+    Documents documents{};
+    documents.reserve(keys.size());
+
+    for (auto const &key : keys)
+    {
+      documents.emplace_back(Get(key));
+    }
+
+    return documents;
+  }
+
+  /**
+   * Write a batch of documents to the state. Where a key appears more than once the last of its
+   * values is retained.
+   *
+   * The default implementation simply sets each of the documents in turn, remote implementations
+   * should override this to write the whole batch with as few round trips as possible.
+   *
+   * @param keys The keys to be written
+   * @param values The values to be written, in the same order as the keys
+   */
+  virtual void SetBatch(ResourceAddresses const &keys, StateValues const &values)
+  {
+    for (std::size_t i = 0, end = std::min(keys.size(), values.size()); i < end; ++i)
+    {
+      Set(keys[i], values[i]);
+    }
+  }
+
+  /// @}
+
+  /// @name Committed State Interface
+  /// @{
+
+  /**
+   * Retrieve a document as of the last committed state, ignoring any modifications made since.
+   * These reads are intended for queries, so that they need not contend with block execution.
+   *
+   * The default implementation reads the current state, implementations which can serve a view of
+   * the committed state should override this.
+   *
+   * @param key The key to be retrieved
+   * @return The document
+   */
+  virtual Document GetCommitted(ResourceAddress const &key) const
+  {
+    return Get(key);
+  }
+
+  /**
+   * Retrieve a batch of documents as of the last committed state
+   *
+   * @param keys The keys to be retrieved
+   * @return The documents, in the same order as the keys
+   */
+  virtual Documents GetCommittedBatch(ResourceAddresses const &keys) const
+  {
+    Documents documents{};
+    documents.reserve(keys.size());
+
+    for (auto const &key : keys)
+    {
+      documents.emplace_back(GetCommitted(key));
+    }
+
+    return documents;
+  }
+
+  /// @}
+
+  /// @name Bulk Import Interface
+  /// @{
+
+  /**
+   * Write a large batch of documents into an empty state, for example when loading the genesis
+   * state. Where a key appears more than once the last of its values is retained.
+   *
+   * The default implementation simply sets each of the documents in turn, implementations should
+   * override this to build the state in a single pass.
+   *
+   * @param keys The keys to be written
+   * @param values The values to be written, in the same order as the keys
+   */
+  virtual void Import(ResourceAddresses const &keys, StateValues const &values)
+  {
+    for (std::size_t i = 0, end = std::min(keys.size(), values.size()); i < end; ++i)
+    {
+      Set(keys[i], values[i]);
+    }
+  }
+
+  /// @}
 };
 
 class StorageUnitInterface : public StorageInterface
@@ -65,6 +179,10 @@ public:
   using Hash           = byte_array::ConstByteArray;
   using ConstByteArray = byte_array::ConstByteArray;
   using TxLayouts      = std::vector<chain::TransactionLayout>;
+  using Digests        = std::vector<Digest>;
+  using Transactions   = std::vector<chain::Transaction>;
+
+  using TransactionCallback = std::function<void(Digest const &)>;
 
   // Construction / Destruction
   StorageUnitInterface()           = default;
@@ -76,6 +194,40 @@ public:
   virtual bool GetTransaction(Digest const &digest, chain::Transaction &tx) = 0;
   virtual bool HasTransaction(Digest const &digest)                         = 0;
   virtual void IssueCallForMissingTxs(DigestSet const &tx_set)              = 0;
+
+  /**
+   * Retrieve a batch of transactions. Transactions which can not be found are omitted from the
+   * result, which is in no particular order. The default implementation looks up each of the
+   * transactions in turn.
+   *
+   * @param digests The digests of the transactions to be retrieved
+   * @return The transactions which were found
+   */
+  virtual Transactions GetTransactions(Digests const &digests);
+
+  /**
+   * Register a callback to be invoked (from an arbitrary thread) each time a transaction has been
+   * added through this storage unit. Implementations which can not signal this must be polled with
+   * HasTransaction.
+   *
+   * @param callback The callback to be registered, an empty callback removes the registration
+   */
+  virtual void SetTransactionCallback(TransactionCallback callback)
+  {
+    FETCH_UNUSED(callback);
+  }
+
+  /**
+   * Signal that the specified block has been committed, so that the pending transactions which
+   * have expired can be evicted. Implementations which do not hold pending transactions can ignore
+   * this.
+   *
+   * @param block_index The index of the committed block
+   */
+  virtual void RemoveExpiredTransactions(uint64_t block_index)
+  {
+    FETCH_UNUSED(block_index);
+  }
   /// @}
 
   virtual TxLayouts PollRecentTx(uint32_t) = 0;
@@ -20,19 +20,25 @@
 #include "core/containers/queue.hpp"
 #include "core/digest.hpp"
 #include "core/state_machine.hpp"
+#include "ledger/storage_unit/transaction_store_interface.hpp"
 #include "telemetry/telemetry.hpp"
 
+#include <vector>
+
 namespace fetch {
 namespace ledger {
 
 class TransactionPoolInterface;
-class TransactionStoreInterface;
 
 /**
  * The transaction archiver manages transactions between a pool and a store. Once a transaction
  * has been confirmed it will be placed in a queue which will result in the transaction being
  * committed to persistent storage.
  *
+ * Confirmed transactions are archived in groups: each flush moves the whole collected batch
+ * (typically all the transactions of a block) into the store as a single write. The bounded
+ * confirmation queue provides back pressure to the callers should the archiver fall behind.
+ *
  *                       ┌─────────────┐               ┌─────────────┐
  *                       │ Transaction │               │ Transaction │
  *                       │    Pool     │               │    Store    │
@@ -66,10 +72,11 @@ public:
   StateMachinePtr const &GetStateMachine() const;
 
 private:
-  static const std::size_t BATCH_SIZE = 100;
+  static const std::size_t BATCH_SIZE = 1000;
 
   using ConfirmationQueue = core::MPMCQueue<Digest, 1u << 15u>;
   using Digests           = std::vector<Digest>;
+  using TxArray           = TransactionStoreInterface::TxArray;
 
   State OnCollecting();
   State OnFlushing();
@@ -92,6 +99,7 @@ private:
   telemetry::CounterPtr additions_total_;
   telemetry::CounterPtr lost_total_;
   telemetry::CounterPtr processed_total_;
+  telemetry::CounterPtr flushes_total_;
 };
 
 char const *ToString(TransactionArchiver::State state);
@@ -18,18 +18,49 @@
 //------------------------------------------------------------------------------
 
 #include "chain/transaction.hpp"
+#include "chain/transaction_expiry_index.hpp"
 #include "core/digest.hpp"
 #include "core/mutex.hpp"
 #include "ledger/storage_unit/transaction_pool_interface.hpp"
+#include "telemetry/telemetry.hpp"
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <unordered_map>
 
 namespace fetch {
 namespace ledger {
 
+/**
+ * In memory pool of the transactions which have not yet been archived.
+ *
+ * The pool is split into a number of independently locked shards (selected by the transaction
+ * digest) so that the syncing, verification, execution and archiving paths rarely contend on the
+ * same lock. The approximate memory used by the stored transactions is tracked, and once it
+ * reaches the configured limit any further transactions are spilled to the overflow store (when
+ * one has been provided) rather than being held in memory.
+ *
+ * The transactions held in memory are also indexed by the block at which they expire, so that the
+ * transactions which will never be included in a block can be evicted as the chain progresses.
+ */
 class TransactionMemoryPool : public TransactionPoolInterface
 {
 public:
+  static constexpr std::size_t NUM_SHARDS              = 16;
+  static constexpr std::size_t UNLIMITED_SIZE_IN_BYTES = std::numeric_limits<std::size_t>::max();
+
+  using BlockIndex = chain::Transaction::BlockIndex;
+
+  // Construction / Destruction
+  TransactionMemoryPool();
+  TransactionMemoryPool(std::size_t max_size_in_bytes, TransactionStoreInterface *overflow);
+  TransactionMemoryPool(TransactionMemoryPool const &) = delete;
+  TransactionMemoryPool(TransactionMemoryPool &&)      = delete;
+  ~TransactionMemoryPool() override                    = default;
+
   /// @name Transaction Storage Interface
   /// @{
   void     Add(chain::Transaction const &tx) override;
@@ -39,11 +70,43 @@ public:
   void     Remove(Digest const &tx_digest) override;
   /// @}
 
+  std::size_t GetSizeInBytes() const;
+  std::size_t RemoveExpired(BlockIndex block_index);
+  std::size_t Spill(std::size_t target_size_in_bytes);
+
+  static std::size_t EstimateSizeInBytes(chain::Transaction const &tx);
+
+  // Operators
+  TransactionMemoryPool &operator=(TransactionMemoryPool const &) = delete;
+  TransactionMemoryPool &operator=(TransactionMemoryPool &&) = delete;
+
 private:
-  using TxStore = DigestMap<chain::Transaction>;
+  using TxStore = DigestKeyMap<chain::Transaction>;
+
+  struct Shard
+  {
+    mutable Mutex lock;
+    TxStore       transaction_store{};
+  };
+
+  using Shards = std::array<Shard, NUM_SHARDS>;
+
+  Shard &Lookup(Digest const &tx_digest) const;
+  bool   Erase(Digest const &tx_digest, BlockIndex &valid_until);
+
+  std::size_t const          max_size_in_bytes_;
+  TransactionStoreInterface *overflow_;  ///< The (optional) store for spilled transactions
+
+  mutable Shards           shards_{};
+  std::atomic<uint64_t>    count_{0};
+  std::atomic<std::size_t> size_in_bytes_{0};
+
+  Mutex                         expiry_lock_;
+  chain::TransactionExpiryIndex expiry_index_{};  ///< The in memory transactions by expiry block
 
-  mutable Mutex lock_;
-  TxStore       transaction_store_;
+  telemetry::CounterPtr         spilled_total_;
+  telemetry::CounterPtr         expired_total_;
+  telemetry::GaugePtr<uint64_t> size_in_bytes_gauge_;
 };
 
 }  // namespace ledger
@@ -0,0 +1,90 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/digest.hpp"
+#include "ledger/storage_unit/transaction_store.hpp"
+#include "variant/variant.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Reads transactions from the lane stores of a node on a pool of threads, for offline inspection
+ * and export of a chain. The stores are only read, so the transactions are decoded directly from
+ * their memory mapped lane archives.
+ */
+class TransactionScanner
+{
+public:
+  using LaneIndex = uint64_t;
+  using Stores    = std::unordered_map<LaneIndex, TransactionStore>;
+
+  struct Request
+  {
+    LaneIndex lane;
+    Digest    digest;
+  };
+
+  struct Result
+  {
+    bool                       found{false};
+    bool                       verified{false};
+    chain::Transaction         tx{};
+    byte_array::ConstByteArray record{};  ///< The exported JSON record, if exporting
+  };
+
+  using Requests = std::vector<Request>;
+  using Results  = std::vector<Result>;
+  using Exporter = std::function<variant::Variant(std::size_t, Result const &)>;
+
+  // Construction / Destruction
+  TransactionScanner(Stores const &stores, std::size_t num_threads);
+  TransactionScanner(TransactionScanner const &) = delete;
+  TransactionScanner(TransactionScanner &&)      = delete;
+  ~TransactionScanner()                          = default;
+
+  /// @name Configuration
+  /// @{
+  void EnableSignatureVerification(bool enable);
+  void SetExporter(Exporter exporter);
+  /// @}
+
+  void Scan(Requests const &requests, std::size_t begin, Results &results) const;
+
+  // Operators
+  TransactionScanner &operator=(TransactionScanner const &) = delete;
+  TransactionScanner &operator=(TransactionScanner &&) = delete;
+
+private:
+  Stores const &stores_;
+  std::size_t   num_threads_;
+  bool          verify_signatures_{false};
+  Exporter      exporter_{};
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -39,7 +39,8 @@ namespace ledger {
 class TransactionStorageEngine : public TransactionStorageEngineInterface
 {
 public:
-  using Callback = std::function<void(chain::Transaction const &)>;
+  using Callback           = std::function<void(chain::Transaction const &)>;
+  using ShardedBalancesPtr = chain::ShardedBalancesPtr;
 
   // Construction / Destruction
   explicit TransactionStorageEngine(uint32_t log2_num_lanes, uint32_t lane);
@@ -51,6 +52,7 @@ public:
   void Load(std::string const &doc_file, std::string const &index_file, bool const &create = true);
   void AttachToReactor(core::Reactor &reactor);
   void SetNewTransactionHandler(Callback cb);
+  void SetShardedBalances(ShardedBalancesPtr sharded_balances);
 
   /// @name Transaction Storage Engine Interface
   /// @{
@@ -60,8 +62,17 @@ public:
   std::size_t GetCount() const override;
   void        Confirm(Digest const &tx_digest) override;
   TxLayouts   GetRecent(uint32_t max_to_poll) override;
+  void        RemoveExpired(uint64_t block_index) override;
   TxArray     PullSubtree(Digest const &partial_digest, uint64_t bit_count,
                           uint64_t pull_limit) override;
+  DigestArray PullSubtreeDigests(Digest const &partial_digest, uint64_t bit_count,
+                                 uint64_t pull_limit) override;
+  /// @}
+
+  /// @name Memory Management
+  /// @{
+  std::size_t GetMemPoolSizeInBytes() const;
+  std::size_t SpillMemPool(std::size_t target_size_in_bytes);
   /// @}
 
   // Operators
@@ -69,10 +80,12 @@ public:
   TransactionStorageEngine &operator=(TransactionStorageEngine &&) = delete;
 
 private:
-  static const std::size_t MAX_NUM_RECENT_TX = 1u << 15u;
+  static const std::size_t MAX_NUM_RECENT_TX          = 1u << 15u;
+  static const std::size_t MAX_MEM_POOL_SIZE_IN_BYTES = 1u << 28u;
+  static const uint64_t    EXPIRED_TX_RETENTION       = 100;  ///< Blocks, to survive short forks
 
   uint32_t const             lane_;
-  TransactionMemoryPool      mem_pool_;
+  TransactionMemoryPool      mem_pool_{MAX_MEM_POOL_SIZE_IN_BYTES, &archive_};
   TransactionStore           archive_;
   TransactionStoreAggregator store_{mem_pool_, archive_};
   TransactionArchiver        archiver_{lane_, mem_pool_, archive_};
@@ -21,14 +21,17 @@
 #include "chain/transaction_layout.hpp"
 #include "core/digest.hpp"
 
+#include <vector>
+
 namespace fetch {
 namespace ledger {
 
 class TransactionStorageEngineInterface
 {
 public:
-  using TxArray   = std::vector<chain::Transaction>;
-  using TxLayouts = std::vector<chain::TransactionLayout>;
+  using TxArray     = std::vector<chain::Transaction>;
+  using TxLayouts   = std::vector<chain::TransactionLayout>;
+  using DigestArray = std::vector<Digest>;
 
   // Construction / Destruction
   TransactionStorageEngineInterface()          = default;
@@ -84,8 +87,28 @@ public:
    */
   virtual TxLayouts GetRecent(uint32_t max_to_poll) = 0;
 
+  /**
+   * Evict the pending transactions which have expired, now that the specified block has been
+   * committed
+   *
+   * @param block_index The index of the committed block
+   */
+  virtual void RemoveExpired(uint64_t block_index) = 0;
+
   virtual TxArray PullSubtree(Digest const &partial_digest, uint64_t bit_count,
                               uint64_t pull_limit) = 0;
+
+  /**
+   * Get the digests of the transactions in a subtree of the storage engine, without retrieving
+   * the transactions themselves
+   *
+   * @param partial_digest The partial digest for the subtree
+   * @param bit_count The bit count of the partial digest for the subtree
+   * @param pull_limit The maximum number of digests to be retrieved
+   * @return The digests of the transactions in the subtree
+   */
+  virtual DigestArray PullSubtreeDigests(Digest const &partial_digest, uint64_t bit_count,
+                                         uint64_t pull_limit) = 0;
   /// @}
 };
 
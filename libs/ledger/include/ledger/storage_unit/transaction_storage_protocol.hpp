@@ -36,7 +36,9 @@ class TransactionStorageEngineInterface;
 class TransactionStorageProtocol : public service::Protocol
 {
 public:
-  using TxLayouts = std::vector<chain::TransactionLayout>;
+  using TxLayouts    = std::vector<chain::TransactionLayout>;
+  using Digests      = std::vector<Digest>;
+  using Transactions = std::vector<chain::Transaction>;
 
   enum
   {
@@ -44,7 +46,9 @@ public:
     HAS,
     GET,
     GET_COUNT,
-    GET_RECENT
+    GET_RECENT,
+    GET_BATCH,
+    REMOVE_EXPIRED
   };
 
   TransactionStorageProtocol(TransactionStorageEngineInterface &storage, uint32_t lane);
@@ -59,8 +63,10 @@ private:
   void               Add(chain::Transaction const &tx);
   bool               Has(Digest const &tx_digest);
   chain::Transaction Get(Digest const &tx_digest);
+  Transactions       GetBatch(Digests const &tx_digests);
   uint64_t           GetCount();
   TxLayouts          GetRecent(uint32_t max_to_poll);
+  void               RemoveExpired(uint64_t block_index);
 
   // config
   uint32_t const                     lane_;
@@ -72,11 +78,15 @@ private:
   telemetry::CounterPtr   get_total_;
   telemetry::CounterPtr   get_count_total_;
   telemetry::CounterPtr   get_recent_total_;
+  telemetry::CounterPtr   get_batch_total_;
+  telemetry::CounterPtr   remove_expired_total_;
   telemetry::HistogramPtr add_durations_;
   telemetry::HistogramPtr has_durations_;
   telemetry::HistogramPtr get_durations_;
   telemetry::HistogramPtr get_count_durations_;
   telemetry::HistogramPtr get_recent_durations_;
+  telemetry::HistogramPtr get_batch_durations_;
+  telemetry::HistogramPtr remove_expired_durations_;
 };
 
 }  // namespace ledger
@@ -19,6 +19,8 @@
 
 #include "chain/transaction.hpp"
 #include "ledger/storage_unit/transaction_store_interface.hpp"
+#include "ledger/storage_unit/transaction_view.hpp"
+#include "storage/mapped_file.hpp"
 #include "storage/object_store.hpp"
 
 #include <string>
@@ -30,7 +32,7 @@ namespace ledger {
 class TransactionStore : public TransactionStoreInterface
 {
 public:
-  using TxArray = std::vector<chain::Transaction>;
+  using DigestArray = std::vector<Digest>;
 
   // Construction / Destruction
   TransactionStore()                         = default;
@@ -45,14 +47,22 @@ public:
   /// @name Transaction Storage Interface
   /// @{
   void     Add(chain::Transaction const &tx) override;
+  void     AddBatch(TxArray const &txs) override;
   bool     Has(Digest const &tx_digest) const override;
   bool     Get(Digest const &tx_digest, chain::Transaction &tx) const override;
   uint64_t GetCount() const override;
   /// @}
 
+  /// @name Zero Copy Access
+  /// @{
+  bool GetView(Digest const &tx_digest, TransactionView &view) const;
+  /// @}
+
   /// @mame Low Level Subtree Access
   /// @{
-  TxArray PullSubtree(Digest const &partial_digest, uint64_t bit_count, uint64_t pull_limit);
+  TxArray     PullSubtree(Digest const &partial_digest, uint64_t bit_count, uint64_t pull_limit);
+  DigestArray PullSubtreeDigests(Digest const &partial_digest, uint64_t bit_count,
+                                 uint64_t pull_limit);
   /// @}
 
   // Operators
@@ -60,9 +70,14 @@ public:
   TransactionStore &operator=(TransactionStore &&) = delete;
 
 private:
-  using Archive = storage::ObjectStore<chain::Transaction>;
+  using Archive        = storage::ObjectStore<chain::Transaction>;
+  using MappedFile     = storage::MappedFile;
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  ConstByteArray GetMapped(Digest const &tx_digest) const;
 
-  mutable Archive archive_;
+  mutable Archive    archive_;
+  mutable MappedFile mapped_archive_;  ///< Read only mapping of the archive document file
 };
 
 }  // namespace ledger
@@ -17,20 +17,19 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/transaction.hpp"
 #include "core/digest.hpp"
 
-namespace fetch {
-namespace chain {
-
-class Transaction;
-
-}  // namespace chain
+#include <vector>
 
+namespace fetch {
 namespace ledger {
 
 class TransactionStoreInterface
 {
 public:
+  using TxArray = std::vector<chain::Transaction>;
+
   // Construction / Destruction
   TransactionStoreInterface()          = default;
   virtual ~TransactionStoreInterface() = default;
@@ -45,6 +44,22 @@ public:
    */
   virtual void Add(chain::Transaction const &tx) = 0;
 
+  /**
+   * Add a batch of transactions to the store
+   *
+   * The default implementation simply adds each transaction in turn, persistent implementations
+   * should override this to write the whole batch at once.
+   *
+   * @param txs The transactions to be added to storage
+   */
+  virtual void AddBatch(TxArray const &txs)
+  {
+    for (auto const &tx : txs)
+    {
+      Add(tx);
+    }
+  }
+
   /**
    * Check to see if requested transaction exists
    *
@@ -52,7 +52,8 @@ public:
     OBJECT_COUNT          = 1,
     PULL_OBJECTS          = 2,
     PULL_SUBTREE          = 3,
-    PULL_SPECIFIC_OBJECTS = 4
+    PULL_SPECIFIC_OBJECTS = 4,
+    PULL_SUBTREE_DIGESTS  = 5
   };
 
   static constexpr char const *LOGGING_NAME = "ObjectStoreSyncProtocol";
@@ -88,14 +89,16 @@ private:
     Timepoint          created{Clock::now()};
   };
 
-  using Cache   = std::vector<CachedObject>;
-  using TxArray = std::vector<chain::Transaction>;
-  using TxStore = TransactionStorageEngineInterface;
+  using Cache       = std::vector<CachedObject>;
+  using TxArray     = std::vector<chain::Transaction>;
+  using DigestArray = std::vector<Digest>;
+  using TxStore     = TransactionStorageEngineInterface;
 
-  uint64_t ObjectCount();
-  TxArray  PullObjects(service::CallContext const &call_context);
-  TxArray  PullSubtree(byte_array::ConstByteArray const &rid, uint64_t bit_count);
-  TxArray  PullSpecificObjects(DigestSet const &digests);
+  uint64_t    ObjectCount();
+  TxArray     PullObjects(service::CallContext const &call_context);
+  TxArray     PullSubtree(byte_array::ConstByteArray const &rid, uint64_t bit_count);
+  TxArray     PullSpecificObjects(DigestSet const &digests);
+  DigestArray PullSubtreeDigests(byte_array::ConstByteArray const &rid, uint64_t bit_count);
 
   telemetry::CounterPtr   CreateCounter(char const *operation) const;
   telemetry::HistogramPtr CreateHistogram(char const *operation) const;
@@ -111,10 +114,12 @@ private:
   telemetry::CounterPtr   pull_objects_total_;
   telemetry::CounterPtr   pull_subtree_total_;
   telemetry::CounterPtr   pull_specific_objects_total_;
+  telemetry::CounterPtr   pull_subtree_digests_total_;
   telemetry::HistogramPtr object_count_durations_;
   telemetry::HistogramPtr pull_objects_durations_;
   telemetry::HistogramPtr pull_subtree_durations_;
   telemetry::HistogramPtr pull_specific_objects_durations_;
+  telemetry::HistogramPtr pull_subtree_digests_durations_;
 };
 
 }  // namespace ledger
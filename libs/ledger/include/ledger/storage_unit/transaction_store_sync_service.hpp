@@ -20,6 +20,7 @@
 #include "core/future_timepoint.hpp"
 #include "core/service_ids.hpp"
 #include "core/state_machine.hpp"
+#include "core/token_bucket.hpp"
 #include "ledger/storage_unit/lane_controller.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
@@ -73,8 +74,11 @@ public:
   using PromiseOfObjectCount  = network::PromiseOf<uint64_t>;
   using TxArray               = std::vector<chain::Transaction>;
   using RequestingTxList      = network::RequestingQueueOf<Address, TxArray>;
-  using RequestingSubTreeList = network::RequestingQueueOf<uint64_t, TxArray>;
+  using DigestArray           = std::vector<Digest>;
+  using RequestingSubTreeList = network::RequestingQueueOf<uint64_t, DigestArray>;
+  using RequestingMissingList = network::RequestingQueueOf<uint64_t, TxArray>;
   using PromiseOfTxList       = network::PromiseOf<TxArray>;
+  using PromiseOfDigestList   = network::PromiseOf<DigestArray>;
   using ResourceID            = storage::ResourceID;
   using EventNewTransaction   = std::function<void(chain::Transaction const &)>;
   using TrimCacheCallback     = std::function<void()>;
@@ -100,6 +104,7 @@ public:
     std::chrono::milliseconds main_timeout{5000};
     std::chrono::milliseconds promise_wait_timeout{2000};
     std::chrono::milliseconds fetch_object_wait_duration{5000};
+    double                    max_peer_tx_rate{10000.0};  ///< Transactions per second per peer
   };
 
   TransactionStoreSyncService(Config const &cfg, MuddleEndpoint &muddle,
@@ -145,6 +150,9 @@ private:
   State OnResolvingObjects();
   State OnTrimCache();
 
+  void RequestMissingObjects(uint64_t root, DigestSet const &digests);
+  bool IsVerifierCongested() const;
+
   TrimCacheCallback                  trim_cache_callback_;
   std::shared_ptr<StateMachine>      state_machine_;
   TxFinderProtocol *                 tx_finder_protocol_;
@@ -161,11 +169,16 @@ private:
   uint64_t              max_object_count_{};
 
   RequestingSubTreeList pending_subtree_;
+  RequestingMissingList pending_missing_;
   RequestingTxList      pending_objects_;
 
-  std::queue<uint64_t>                                          roots_to_sync_;
-  uint64_t                                                      root_size_ = 0;
-  std::unordered_map<PromiseOfTxList::PromiseCounter, uint64_t> promise_id_to_roots_;
+  std::queue<uint64_t>                                              roots_to_sync_;
+  uint64_t                                                          root_size_ = 0;
+  std::unordered_map<PromiseOfDigestList::PromiseCounter, uint64_t> promise_id_to_roots_;
+  std::unordered_map<uint64_t, Address>                             root_peers_;
+  std::unordered_map<uint64_t, uint64_t>                            missing_request_roots_;
+  uint64_t                                                          next_missing_request_{0};
+  std::unordered_map<Address, core::TokenBucket>                    peer_tx_limits_;
 
   std::atomic_bool is_ready_{false};
 
@@ -175,6 +188,10 @@ private:
   telemetry::CounterPtr         subtree_requests_total_;
   telemetry::CounterPtr         subtree_response_total_;
   telemetry::CounterPtr         subtree_failure_total_;
+  telemetry::CounterPtr         subtree_digests_total_;
+  telemetry::CounterPtr         subtree_missing_total_;
+  telemetry::CounterPtr         rate_limited_total_;
+  telemetry::CounterPtr         backpressure_total_;
   telemetry::GaugePtr<uint64_t> current_tss_state_;
   telemetry::GaugePtr<uint64_t> current_tss_peers_;
 };
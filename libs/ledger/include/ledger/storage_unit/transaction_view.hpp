@@ -0,0 +1,67 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "chain/transaction_layout.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * A view of a stored transaction in its encoded form. The transaction itself is only decoded when
+ * it is first accessed, callers which only need to forward the encoded transaction (for example
+ * when serving sync requests) never pay for the decode. Callers which only need the layout of the
+ * transaction get it from a partial decode of the header fields.
+ *
+ * The encoded buffer may reference memory mapped pages of the transaction store.
+ */
+class TransactionView
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  // Construction / Destruction
+  TransactionView() = default;
+  explicit TransactionView(ConstByteArray encoded);
+  TransactionView(TransactionView const &) = default;
+  TransactionView(TransactionView &&)      = default;
+  ~TransactionView()                       = default;
+
+  bool                      empty() const;
+  ConstByteArray const &    encoded() const;
+  chain::Transaction const &transaction() const;
+  chain::TransactionLayout  layout(uint32_t log2_num_lanes) const;
+
+  // Operators
+  TransactionView &operator=(TransactionView const &) = default;
+  TransactionView &operator=(TransactionView &&) = default;
+
+private:
+  using TransactionPtr = std::shared_ptr<chain::Transaction>;
+
+  ConstByteArray         encoded_{};      ///< The (msgpack) encoded transaction
+  mutable TransactionPtr transaction_{};  ///< The lazily decoded transaction
+};
+
+}  // namespace ledger
+}  // namespace fetch
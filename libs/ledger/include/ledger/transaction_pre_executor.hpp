@@ -0,0 +1,86 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace fetch {
+namespace ledger {
+
+class BasicMiner;
+class ExecutionManager;
+
+/**
+ * Background worker which pre-executes the pending transactions of the mining pool while the
+ * execution manager is idle.
+ *
+ * The highest fee transactions whose lanes have not yet been observed are executed speculatively
+ * against the latest state, and the lanes that they actually read or wrote are reported back to
+ * the miner. The miner then uses these (usually much narrower) lanes in place of the declared
+ * lanes when packing slices. Pre-execution yields to block execution: as soon as the manager
+ * becomes busy the remainder of the batch is left for the next round.
+ */
+class TransactionPreExecutor
+{
+public:
+  using Duration = std::chrono::milliseconds;
+
+  static constexpr std::size_t DEFAULT_BATCH_SIZE  = 256;
+  static constexpr uint64_t    DEFAULT_INTERVAL_MS = 100;
+
+  // Construction / Destruction
+  TransactionPreExecutor(BasicMiner &miner, ExecutionManager &execution_manager,
+                         std::size_t batch_size = DEFAULT_BATCH_SIZE,
+                         Duration    interval   = Duration{DEFAULT_INTERVAL_MS});
+  TransactionPreExecutor(TransactionPreExecutor const &) = delete;
+  TransactionPreExecutor(TransactionPreExecutor &&)      = delete;
+  ~TransactionPreExecutor();
+
+  /// @name Pre-executor Controls
+  /// @{
+  void Start();
+  void Stop();
+  /// @}
+
+  std::size_t PreExecuteBatch();
+
+  // Operators
+  TransactionPreExecutor &operator=(TransactionPreExecutor const &) = delete;
+  TransactionPreExecutor &operator=(TransactionPreExecutor &&) = delete;
+
+private:
+  using Flag      = std::atomic<bool>;
+  using ThreadPtr = std::unique_ptr<std::thread>;
+
+  BasicMiner &      miner_;
+  ExecutionManager &execution_manager_;
+  std::size_t const batch_size_;
+  Duration const    interval_;
+  ThreadPtr         thread_;
+  Flag              running_{false};
+
+  void ThreadEntryPoint();
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -22,6 +22,7 @@
 #include "ledger/transaction_verifier.hpp"
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 #include <thread>
 
@@ -62,6 +63,8 @@ public:
   /// @{
   void AddTransaction(TransactionPtr const &tx);
   void AddTransaction(TransactionPtr &&tx);
+
+  std::size_t GetBacklog() const;
   /// @}
 
   // Operators
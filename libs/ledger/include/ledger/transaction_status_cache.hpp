@@ -23,7 +23,11 @@
 #include "ledger/execution_result.hpp"
 #include "network/generics/milli_timer.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <unordered_map>
 
 namespace fetch {
@@ -61,10 +65,17 @@ constexpr char const *ToString(TransactionStatus status)
   return "Unknown";
 }
 
+/**
+ * Cache of the status of recent transactions.
+ *
+ * Every update advances the sequence of the cache, so that clients are able to wait for the
+ * status of the transactions they are interested in to change, rather than polling them.
+ */
 class TransactionStatusCache
 {
 public:
-  using ShrdPtr = std::shared_ptr<TransactionStatusCache>;
+  using ShrdPtr  = std::shared_ptr<TransactionStatusCache>;
+  using Sequence = uint64_t;
 
   struct TxStatus
   {
@@ -78,11 +89,26 @@ public:
   virtual void     Update(Digest digest, TransactionStatus status)            = 0;
   virtual void     Update(Digest digest, ContractExecutionResult exec_result) = 0;
 
+  /// @name Update Notification
+  /// @{
+  Sequence sequence() const;
+  bool     WaitForUpdate(Sequence since, std::chrono::milliseconds const &timeout) const;
+  /// @}
+
   // Operators
   TransactionStatusCache &operator=(TransactionStatusCache const &) = delete;
   TransactionStatusCache &operator=(TransactionStatusCache &&) = delete;
 
   static ShrdPtr factory();
+
+protected:
+  void NotifyUpdate();
+
+private:
+  std::atomic<Sequence>            sequence_{0};
+  mutable std::atomic<std::size_t> waiters_{0};  ///< The number of threads waiting for an update
+  mutable std::mutex               wait_lock_;
+  mutable std::condition_variable  wait_condition_;
 };
 
 }  // namespace ledger
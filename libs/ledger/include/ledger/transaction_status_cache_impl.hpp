@@ -57,7 +57,7 @@ public:
   TransactionStatusCacheImpl &operator=(TransactionStatusCacheImpl &&) = delete;
 
 private:
-  using Cache = DigestMap<TxStatusEx>;
+  using Cache = DigestKeyMap<TxStatusEx>;
 
   static constexpr std::chrono::hours   LIFETIME{24};
   static constexpr std::chrono::minutes INTERVAL{5};
@@ -122,6 +122,7 @@ void TransactionStatusCacheImpl<CLOCK>::Update(Digest digest, TransactionStatus
     it->second.status.status = status;
   }
 
+  NotifyUpdate();
   PruneCacheIfNecessary(now);
 }
 
@@ -150,6 +151,7 @@ void TransactionStatusCacheImpl<CLOCK>::Update(Digest digest, ContractExecutionR
     it->second.status.contract_exec_result = exec_result;
   }
 
+  NotifyUpdate();
   PruneCacheIfNecessary(now);
 }
 
@@ -0,0 +1,81 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Writer for the streamed transaction submission format.
+ *
+ * The stream is a sequence of length prefixed transactions, each of which is a four byte (big
+ * endian) length followed by the serialised transaction. Unlike the bulk format, the stream does
+ * not need to be decoded in its entirety before the first of its transactions can be processed.
+ */
+class TransactionStreamWriter
+{
+public:
+  using ByteArray      = byte_array::ByteArray;
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  static constexpr std::size_t PREFIX_LENGTH = sizeof(uint32_t);
+
+  void Append(ConstByteArray const &encoded_tx);
+
+  ByteArray const &stream() const
+  {
+    return stream_;
+  }
+
+private:
+  ByteArray stream_{};
+};
+
+/**
+ * Incremental reader of the streamed transaction submission format. The transactions are returned
+ * as views onto the stream, and so are never copied.
+ */
+class TransactionStreamReader
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  explicit TransactionStreamReader(ConstByteArray stream);
+
+  bool Next(ConstByteArray &encoded_tx);
+
+  /// Determine if the stream was truncated part way through one of its transactions
+  bool is_truncated() const
+  {
+    return truncated_;
+  }
+
+private:
+  ConstByteArray stream_;
+  std::size_t    offset_{0};
+  bool           truncated_{false};
+};
+
+}  // namespace ledger
+}  // namespace fetch
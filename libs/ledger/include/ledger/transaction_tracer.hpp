@@ -0,0 +1,153 @@
+#pragma once
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+#include "core/digest.hpp"
+#include "core/mutex.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+class Block;
+
+/**
+ * The stages of the pipeline a transaction is traced through, in order
+ */
+enum class TraceStage : uint8_t
+{
+  SUBMITTED = 0,  ///< Received by the transaction processor
+  VERIFIED,       ///< The signatures have been verified
+  STORED,         ///< Added to the storage unit
+  PACKED,         ///< Packed into a new block by the miner
+  SCHEDULED,      ///< The block has been scheduled for execution
+  EXECUTED,       ///< The transaction has been executed
+  COMMITTED,      ///< The state of the block has been committed
+};
+
+constexpr std::size_t NUM_TRACE_STAGES = 7;
+
+char const *ToString(TraceStage stage);
+
+/**
+ * Process wide, sampled tracing of transactions through the ledger pipeline.
+ *
+ * Tracing is disabled by default. Once enabled, one in every N transactions (selected by digest, so
+ * that every stage agrees on the selection) is traced. Each trace point is appended to a ring
+ * buffer owned by the recording thread, and the time since the previous stage of the transaction
+ * is exported as a per stage telemetry histogram.
+ */
+class TransactionTracer
+{
+public:
+  using Clock     = std::chrono::steady_clock;
+  using Timestamp = Clock::time_point;
+
+  struct Event
+  {
+    Digest     digest{};
+    TraceStage stage{TraceStage::SUBMITTED};
+    Timestamp  timestamp{};
+  };
+
+  using Events = std::vector<Event>;
+
+  static constexpr std::size_t RING_BUFFER_SIZE     = 1024;  ///< Events retained per thread
+  static constexpr std::size_t MAX_IN_FLIGHT_TRACES = 8192;
+
+  static TransactionTracer &Instance();
+
+  // Construction / Destruction
+  TransactionTracer(TransactionTracer const &) = delete;
+  TransactionTracer(TransactionTracer &&)      = delete;
+  ~TransactionTracer()                         = default;
+
+  /// @name Control
+  /// @{
+  void     SetSampleInterval(uint32_t interval);
+  uint32_t sample_interval() const;
+  bool     IsSampled(Digest const &digest) const;
+  void     Clear();
+  /// @}
+
+  /// @name Trace Points
+  /// @{
+  void Record(Digest const &digest, TraceStage stage);
+  void Record(Block const &block, TraceStage stage);
+  /// @}
+
+  /// @name Traces
+  /// @{
+  Events Recent() const;
+  Events Lookup(Digest const &digest) const;
+  /// @}
+
+  // Operators
+  TransactionTracer &operator=(TransactionTracer const &) = delete;
+  TransactionTracer &operator=(TransactionTracer &&) = delete;
+
+private:
+  struct RingBuffer
+  {
+    Mutex       lock;
+    Events      events = Events(RING_BUFFER_SIZE);
+    std::size_t next{0};
+    std::size_t size{0};
+  };
+
+  struct InFlight
+  {
+    Timestamp first;  ///< The time of the first stage which was traced
+    Timestamp last;   ///< The time of the most recent stage which was traced
+  };
+
+  using RingBufferPtr = std::shared_ptr<RingBuffer>;
+  using RingBuffers   = std::vector<RingBufferPtr>;
+  using Histograms    = std::array<telemetry::LogLinearHistogramPtr, NUM_TRACE_STAGES>;
+
+  TransactionTracer();
+
+  RingBuffer &LocalBuffer();
+  void        UpdateLatencies(Digest const &digest, TraceStage stage, Timestamp timestamp);
+
+  template <typename Predicate>
+  Events Collect(Predicate const &predicate) const;
+
+  std::atomic<uint32_t> sample_interval_{0};
+
+  mutable Mutex buffers_lock_;
+  RingBuffers   buffers_{};  ///< The ring buffers of every thread which has recorded an event
+
+  Mutex               in_flight_lock_;
+  DigestMap<InFlight> in_flight_{};  ///< The sampled transactions which are yet to be committed
+
+  Histograms                       stage_latency_{};
+  telemetry::LogLinearHistogramPtr total_latency_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
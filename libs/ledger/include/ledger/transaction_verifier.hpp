@@ -20,9 +20,12 @@
 #include "core/containers/queue.hpp"
 #include "telemetry/telemetry.hpp"
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace fetch {
 namespace chain {
@@ -39,9 +42,12 @@ class TransactionVerifier
 public:
   using TransactionPtr = std::shared_ptr<chain::Transaction>;
 
+  static constexpr std::size_t DEFAULT_BATCH_SIZE = 64;
+  static constexpr std::size_t QUEUE_SIZE         = 1u << 16u;  // 65K
+
   // Construction / Destruction
   TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                      std::string const &name);
+                      std::string const &name, std::size_t batch_size = DEFAULT_BATCH_SIZE);
   TransactionVerifier(TransactionVerifier const &) = delete;
   TransactionVerifier(TransactionVerifier &&)      = delete;
   ~TransactionVerifier();
@@ -56,6 +62,8 @@ public:
   /// @{
   void AddTransaction(TransactionPtr const &tx);
   void AddTransaction(TransactionPtr &&tx);
+
+  std::size_t GetBacklog() const;
   /// @}
 
   // Operators
@@ -63,9 +71,8 @@ public:
   TransactionVerifier &operator=(TransactionVerifier &&) = delete;
 
 private:
-  static constexpr std::size_t QUEUE_SIZE = 1u << 16u;  // 65K
-
   using Flag            = std::atomic<bool>;
+  using Count           = std::atomic<std::size_t>;
   using VerifiedQueue   = core::MPSCQueue<TransactionPtr, QUEUE_SIZE>;
   using UnverifiedQueue = core::MPMCQueue<TransactionPtr, QUEUE_SIZE>;
   using ThreadPtr       = std::unique_ptr<std::thread>;
@@ -73,14 +80,17 @@ private:
   using Sink            = TransactionSink;
   using GaugePtr        = telemetry::GaugePtr<uint64_t>;
   using CounterPtr      = telemetry::CounterPtr;
+  using Transactions    = std::vector<TransactionPtr>;
 
   void Verifier();
   void Dispatcher();
 
   std::size_t const verifying_threads_;
+  std::size_t const batch_size_;
   std::string const name_;
   Sink &            sink_;
   Flag              active_{true};
+  Count             backlog_{0};  ///< The transactions waiting to be verified
   Threads           threads_;
   VerifiedQueue     verified_queue_;
   UnverifiedQueue   unverified_queue_;
@@ -94,6 +104,7 @@ private:
   CounterPtr verified_tx_total_;
   CounterPtr discarded_tx_total_;
   CounterPtr dispatched_tx_total_;
+  CounterPtr verified_batches_total_;
   GaugePtr   num_threads_;
 };
 
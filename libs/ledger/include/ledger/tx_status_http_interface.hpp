@@ -19,6 +19,9 @@
 
 #include "http/module.hpp"
 
+#include <chrono>
+#include <cstddef>
+
 namespace fetch {
 namespace ledger {
 
@@ -29,6 +32,15 @@ class TxStatusHttpInterface : public http::HTTPModule
 public:
   using TxStatusCachePtr = std::shared_ptr<TransactionStatusCache>;
 
+  /// The path of the long poll view, which waits for the status of transactions to change
+  static constexpr char const *WAIT_PATH = "/api/status/txs/wait";
+
+  /// The maximum number of transactions which can be requested in a single call
+  static constexpr std::size_t MAX_BATCH_SIZE = 1000;
+
+  /// The maximum time that a long poll request will wait for a status change
+  static constexpr std::chrono::milliseconds MAX_WAIT_TIME{std::chrono::seconds{30}};
+
   // Construction / Destruction
   explicit TxStatusHttpInterface(TxStatusCachePtr status_cache);
   TxStatusHttpInterface(TxStatusHttpInterface const &) = delete;
@@ -40,6 +52,9 @@ public:
   TxStatusHttpInterface &operator=(TxStatusHttpInterface &&) = delete;
 
 private:
+  http::HTTPResponse OnBatchQuery(http::HTTPRequest const &request) const;
+  http::HTTPResponse OnWait(http::HTTPRequest const &request) const;
+
   TxStatusCachePtr status_cache_;
 };
 
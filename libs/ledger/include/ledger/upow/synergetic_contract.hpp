@@ -26,6 +26,7 @@
 #include "vm/module.hpp"
 #include "vm/vm.hpp"
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,6 +44,10 @@ template <uint16_t S>
 class UInt;
 }
 
+namespace variant {
+class Variant;
+}  // namespace variant
+
 namespace vm {
 
 class Module;
@@ -56,6 +61,7 @@ struct Variant;
 namespace ledger {
 
 class StorageInterface;
+class SynergeticProblemCache;
 struct ContractContext;
 
 class SynergeticContract : public Chargeable
@@ -64,6 +70,7 @@ public:
   using ConstByteArray      = byte_array::ConstByteArray;
   using ProblemData         = std::vector<ConstByteArray>;
   using CompletionValidator = std::function<bool(void)>;
+  using VariantPtr          = std::shared_ptr<vm::Variant>;
 
   enum class Status
   {
@@ -74,6 +81,18 @@ public:
     VALIDATION_ERROR
   };
 
+  /**
+   * The outcome of scoring a piece of work, kept apart from the contract so that several pieces of
+   * work can be scored concurrently, each against its own instance of the problem
+   */
+  struct Evaluation
+  {
+    Status     status{Status::GENERAL_ERROR};
+    WorkScore  score{std::numeric_limits<WorkScore>::max()};
+    VariantPtr solution{};
+    uint64_t   charge{0};
+  };
+
   explicit SynergeticContract(ConstByteArray const &source);
   ~SynergeticContract() override = default;
 
@@ -94,11 +113,20 @@ public:
   /// @name Actions to be taken on the synergetic contract
   /// @{
   Status DefineProblem(ProblemData const &problem_data);
+  Status DefineProblem(ProblemData const &problem_data, SynergeticProblemCache &cache);
   Status Work(vectorise::UInt<256> const &nonce, WorkScore &score);
   Status Complete(chain::Address const &address, BitVector const &shards,
                   CompletionValidator const &validator);
   /// @}
 
+  /// @name Concurrent scoring of work, none of these change the contract
+  /// @{
+  Status     CreateProblem(ProblemData const &problem_data, vm::Variant &problem,
+                           uint64_t &charge) const;
+  Evaluation Evaluate(vm::Variant const &problem, vectorise::UInt<256> const &nonce) const;
+  void       Accept(Evaluation const &evaluation);
+  /// @}
+
   /// @name Synergetic State Access
   /// @{
   bool               HasProblem() const;
@@ -115,7 +143,10 @@ private:
   using CompilerPtr   = std::shared_ptr<vm::Compiler>;
   using IRPtr         = std::shared_ptr<vm::IR>;
   using ExecutablePtr = std::shared_ptr<vm::Executable>;
-  using VariantPtr    = std::shared_ptr<vm::Variant>;
+  using ParsedData    = std::vector<variant::Variant>;
+
+  Status CreateProblem(ParsedData const &parsed_data, vm::Variant &problem,
+                       uint64_t &charge) const;
 
   std::unique_ptr<ContractContext> context_{};
 
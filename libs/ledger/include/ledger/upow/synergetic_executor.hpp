@@ -19,17 +19,36 @@
 
 #include "ledger/chaincode/token_contract.hpp"
 #include "ledger/fees/fee_manager.hpp"
+#include "ledger/upow/synergetic_contract.hpp"
 #include "ledger/upow/synergetic_executor_interface.hpp"
+#include "ledger/upow/synergetic_problem_cache.hpp"
 #include "telemetry/telemetry.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
 
+/**
+ * Verifies the work submitted for a synergetic contract and applies the best valid solution.
+ *
+ * Solutions are scored on a pool of scoring threads, each with its own instance of the problem,
+ * and the first solution in work queue order whose score is confirmed is selected. The contract is
+ * compiled once per verification, the problem is only defined again when its problem data has
+ * changed, and the state changes of the selected solution are made on the calling thread.
+ */
 class SynergeticExecutor : public SynergeticExecutorInterface
 {
 public:
+  using Settlement = FeeManager::Settlement;
+
   // Construction / Destruction
-  explicit SynergeticExecutor(StorageInterface &storage);
+  SynergeticExecutor(StorageInterface &storage, chain::ShardedBalancesPtr sharded_balances,
+                     std::size_t num_scoring_threads = 1,
+                     Settlement  settlement          = Settlement::PER_TRANSACTION);
   SynergeticExecutor(SynergeticExecutor const &) = delete;
   SynergeticExecutor(SynergeticExecutor &&)      = delete;
   ~SynergeticExecutor() override                 = default;
@@ -38,6 +57,7 @@ public:
   /// @{
   void Verify(WorkQueue &solutions, ProblemData const &problem_data, std::size_t num_lanes,
               chain::Address const &miner) override;
+  void SettleFees(chain::Address const &miner, std::size_t num_lanes) override;
   /// @}
 
   // Operators
@@ -45,9 +65,27 @@ public:
   SynergeticExecutor &operator=(SynergeticExecutor &&) = delete;
 
 private:
-  StorageInterface &storage_;
-  TokenContract     token_contract_{};
-  FeeManager        fee_manager_;
+  using BlockIndex    = FeeManager::BlockIndex;
+  using ThreadPool    = threading::Pool;
+  using ThreadPoolPtr = std::unique_ptr<ThreadPool>;
+  using WorkList      = std::vector<WorkPtr>;
+  using Evaluations   = std::vector<SynergeticContract::Evaluation>;
+  using Problems      = std::vector<SynergeticContract::VariantPtr>;
+
+  Evaluations Score(SynergeticContract const &contract, ProblemData const &problem_data,
+                    WorkList const &candidates, std::size_t offset, Problems &problems);
+  void        Apply(SynergeticContract &contract, Work const &solution, std::size_t num_lanes,
+                    chain::Address const &miner);
+
+  StorageInterface &     storage_;
+  TokenContract          token_contract_;
+  FeeManager             fee_manager_;
+  SynergeticProblemCache problem_cache_{};
+  std::size_t            num_scoring_threads_;
+  ThreadPoolPtr          scoring_threads_{};
+  Settlement             settlement_;
+  BlockFees              block_fees_{};
+  BlockIndex             block_index_{0};
 
   /// @name Telemetry
   /// @{
@@ -36,6 +36,7 @@ public:
   /// @{
   virtual void Verify(WorkQueue &solutions, ProblemData const &problem_data, std::size_t num_lanes,
                       chain::Address const &miner) = 0;
+  virtual void SettleFees(chain::Address const &miner, std::size_t num_lanes) = 0;
   /// @}
 };
 
@@ -0,0 +1,78 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "ledger/upow/synergetic_contract.hpp"
+#include "variant/variant.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * The problems defined for synergetic contracts, kept from one block to the next.
+ *
+ * A problem is only defined again when the problem data of its contract changes, and when new data
+ * has only been appended the data parsed for the previous definition is reused. Problems hold VM
+ * objects, so a cache must only be used from one thread at a time.
+ */
+class SynergeticProblemCache
+{
+public:
+  using ProblemData = SynergeticContract::ProblemData;
+  using ParsedData  = std::vector<variant::Variant>;
+  using VariantPtr  = SynergeticContract::VariantPtr;
+
+  struct Entry
+  {
+    ProblemData data{};     ///< The problem data last used for the contract
+    ParsedData  parsed{};   ///< The parsed problem data, undefined where it failed to parse
+    VariantPtr  problem{};  ///< The problem, empty if its definition failed
+    uint64_t    charge{0};  ///< The charge for defining the problem
+    uint64_t    last_used{0};
+  };
+
+  static constexpr std::size_t DEFAULT_MAX_CONTRACTS = 64;
+
+  // Construction / Destruction
+  explicit SynergeticProblemCache(std::size_t max_contracts = DEFAULT_MAX_CONTRACTS);
+  SynergeticProblemCache(SynergeticProblemCache const &) = delete;
+  SynergeticProblemCache(SynergeticProblemCache &&)      = delete;
+  ~SynergeticProblemCache()                              = default;
+
+  Entry &     Lookup(Digest const &contract);
+  std::size_t size() const;
+
+  // Operators
+  SynergeticProblemCache &operator=(SynergeticProblemCache const &) = delete;
+  SynergeticProblemCache &operator=(SynergeticProblemCache &&) = delete;
+
+private:
+  using Entries = DigestMap<Entry>;
+
+  std::size_t max_contracts_;
+  uint64_t    counter_{0};
+  Entries     entries_{};
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/admission_controller.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using fetch::telemetry::Registry;
+
+namespace fetch {
+namespace ledger {
+
+constexpr double      AdmissionController::DEFAULT_SHEDDING_THRESHOLD;
+constexpr std::size_t AdmissionController::CHARGE_RATE_HISTORY;
+constexpr uint64_t    AdmissionController::MAX_RETRY_AFTER_SECONDS;
+
+/**
+ * Construct the admission controller
+ *
+ * @param shedding_threshold The load above which transactions start to be shed
+ */
+AdmissionController::AdmissionController(double shedding_threshold)
+  : shedding_threshold_{std::min(std::max(shedding_threshold, 0.0), 1.0)}
+  , load_{Registry::Instance().CreateGauge<double>(
+        "ledger_admission_load", "The load of the most heavily loaded transaction ingress stage")}
+  , admitted_total_{Registry::Instance().CreateCounter(
+        "ledger_admission_admitted_total", "The total number of transactions admitted")}
+  , shed_total_{Registry::Instance().CreateCounter(
+        "ledger_admission_shed_total", "The total number of transactions refused due to load")}
+{}
+
+/**
+ * Add a stage whose load is taken into account
+ *
+ * @param name The name of the stage
+ * @param load The function reporting the fraction of the capacity of the stage in use
+ */
+void AdmissionController::AddStage(std::string const &name, LoadFunction load)
+{
+  FETCH_LOCK(lock_);
+  stages_.emplace_back(Stage{name, std::move(load)});
+}
+
+/**
+ * Get the current load, that of the most heavily loaded stage
+ *
+ * @return The fraction of the capacity in use
+ */
+double AdmissionController::GetLoad() const
+{
+  double load{0.0};
+
+  FETCH_LOCK(lock_);
+  for (auto const &stage : stages_)
+  {
+    load = std::max(load, stage.load());
+  }
+
+  return load;
+}
+
+/**
+ * Decide whether a newly submitted transaction is to be admitted
+ *
+ * @param tx The transaction
+ * @return true if the transaction should be processed, otherwise false if it should be refused
+ */
+bool AdmissionController::Admit(chain::Transaction const &tx)
+{
+  auto const load = GetLoad();
+  load_->set(load);
+
+  bool admit{true};
+
+  FETCH_LOCK(lock_);
+  if (load >= 1.0)
+  {
+    admit = false;
+  }
+  else if (load >= shedding_threshold_)
+  {
+    double const shed_fraction = (load - shedding_threshold_) / (1.0 - shedding_threshold_);
+    auto const   required_rate = RequiredChargeRate(shed_fraction);
+    auto const   charge_rate   = tx.charge_rate();
+
+    if (charge_rate == required_rate)
+    {
+      // admit the proportion of the transactions at the quantile which the spare capacity allows
+      credit_ += 1.0 - shed_fraction;
+      admit = credit_ >= 1.0;
+
+      if (admit)
+      {
+        credit_ -= 1.0;
+      }
+    }
+    else
+    {
+      admit = charge_rate > required_rate;
+    }
+  }
+
+  if (admit)
+  {
+    RecordAdmitted(tx.charge_rate());
+    admitted_total_->increment();
+  }
+  else
+  {
+    shed_total_->increment();
+  }
+
+  return admit;
+}
+
+/**
+ * Get the interval after which clients whose transactions were refused should retry
+ *
+ * @return The interval, which grows with the load
+ */
+std::chrono::seconds AdmissionController::GetRetryAfter() const
+{
+  auto const load  = std::min(GetLoad(), 1.0);
+  auto const range = static_cast<double>(MAX_RETRY_AFTER_SECONDS - 1);
+
+  return std::chrono::seconds{1 + static_cast<uint64_t>(std::lround(load * range))};
+}
+
+/**
+ * Internal: Determine the charge rate at the given quantile of those recently admitted
+ *
+ * @param shed_fraction The quantile
+ * @return The charge rate
+ */
+AdmissionController::TokenAmount AdmissionController::RequiredChargeRate(double shed_fraction) const
+{
+  if (admitted_charge_rates_.empty())
+  {
+    return 0;
+  }
+
+  std::vector<TokenAmount> rates(admitted_charge_rates_.begin(), admitted_charge_rates_.end());
+
+  auto const last  = static_cast<double>(rates.size() - 1);
+  auto const index = static_cast<std::size_t>(shed_fraction * last);
+  std::nth_element(rates.begin(), rates.begin() + static_cast<std::ptrdiff_t>(index), rates.end());
+
+  return rates[index];
+}
+
+/**
+ * Internal: Record the charge rate of an admitted transaction
+ *
+ * @param charge_rate The charge rate
+ */
+void AdmissionController::RecordAdmitted(TokenAmount charge_rate)
+{
+  admitted_charge_rates_.push_back(charge_rate);
+
+  if (admitted_charge_rates_.size() > CHARGE_RATE_HISTORY)
+  {
+    admitted_charge_rates_.pop_front();
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
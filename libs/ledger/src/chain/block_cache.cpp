@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "chain/transaction_layout.hpp"
+#include "ledger/chain/block_cache.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
+
+#include <iterator>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t BlockCache::DEFAULT_CAPACITY;
+
+/**
+ * Construct the cache
+ *
+ * @param capacity The approximate maximum number of bytes of blocks held
+ */
+BlockCache::BlockCache(std::size_t capacity)
+  : capacity_{capacity}
+  , hits_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_main_chain_block_cache_hits_total",
+        "Total number of stored blocks served from the main chain block cache")}
+  , misses_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_main_chain_block_cache_misses_total",
+        "Total number of stored blocks not found in the main chain block cache")}
+  , bytes_{telemetry::Registry::Instance().CreateGauge<std::size_t>(
+        "ledger_main_chain_block_cache_bytes",
+        "The approximate number of bytes of blocks held in the main chain block cache")}
+{}
+
+/**
+ * Look up a block, marking it as the most recently used
+ *
+ * @param hash The hash of the block
+ * @param block The output block
+ * @param next_hash The output hash of the next block on the stored chain, if any
+ * @return true if the block was found, otherwise false
+ */
+bool BlockCache::Get(BlockHash const &hash, BlockPtr &block, BlockHash &next_hash)
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = index_.find(hash);
+  if (it == index_.end())
+  {
+    misses_->increment();
+    return false;
+  }
+
+  entries_.splice(entries_.begin(), entries_, it->second);
+
+  block     = it->second->block;
+  next_hash = it->second->next_hash;
+
+  hits_->increment();
+  return true;
+}
+
+/**
+ * Add a block to the cache, evicting the least recently used blocks if the capacity is exceeded
+ *
+ * @param block The block to add
+ * @param next_hash The hash of the next block on the stored chain, if any
+ */
+void BlockCache::Add(BlockPtr block, BlockHash next_hash)
+{
+  FETCH_LOCK(lock_);
+
+  auto const size = EstimateSize(*block);
+  if (size > capacity_)
+  {
+    return;
+  }
+
+  auto const existing = index_.find(block->hash);
+  if (existing != index_.end())
+  {
+    EraseEntry(existing->second);
+  }
+
+  BlockHash const hash = block->hash;
+  entries_.push_front(Entry{std::move(block), std::move(next_hash), size});
+  index_[hash] = entries_.begin();
+  size_ += size;
+
+  Evict();
+}
+
+/**
+ * Remove a block from the cache, if present
+ *
+ * @param hash The hash of the block
+ */
+void BlockCache::Erase(BlockHash const &hash)
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = index_.find(hash);
+  if (it != index_.end())
+  {
+    EraseEntry(it->second);
+    bytes_->set(size_);
+  }
+}
+
+void BlockCache::Clear()
+{
+  FETCH_LOCK(lock_);
+
+  entries_.clear();
+  index_.clear();
+  size_ = 0;
+  bytes_->set(size_);
+}
+
+std::size_t BlockCache::capacity() const
+{
+  FETCH_LOCK(lock_);
+  return capacity_;
+}
+
+std::size_t BlockCache::size_in_bytes() const
+{
+  FETCH_LOCK(lock_);
+  return size_;
+}
+
+/**
+ * Change the capacity of the cache, evicting blocks if it is now exceeded
+ *
+ * @param capacity The approximate maximum number of bytes of blocks held
+ */
+void BlockCache::SetCapacity(std::size_t capacity)
+{
+  FETCH_LOCK(lock_);
+
+  capacity_ = capacity;
+  Evict();
+}
+
+/**
+ * @return The approximate number of bytes of memory used by a block
+ */
+std::size_t BlockCache::EstimateSize(Block const &block)
+{
+  static constexpr std::size_t LAYOUT_SIZE = sizeof(chain::TransactionLayout) + chain::HASH_SIZE;
+
+  return sizeof(Block) + (block.slices.size() * sizeof(Block::Slice)) +
+         (block.GetTransactionCount() * LAYOUT_SIZE);
+}
+
+void BlockCache::EraseEntry(EntryList::iterator it)
+{
+  size_ -= it->size;
+  index_.erase(it->block->hash);
+  entries_.erase(it);
+}
+
+void BlockCache::Evict()
+{
+  while ((size_ > capacity_) && !entries_.empty())
+  {
+    EraseEntry(std::prev(entries_.end()));
+  }
+
+  bytes_->set(size_);
+}
+
+}  // namespace ledger
+}  // namespace fetch
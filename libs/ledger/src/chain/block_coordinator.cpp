@@ -32,6 +32,7 @@
 #include "ledger/execution_manager_interface.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 #include "ledger/transaction_status_cache.hpp"
+#include "ledger/transaction_tracer.hpp"
 #include "ledger/upow/synergetic_execution_manager.hpp"
 #include "ledger/upow/synergetic_executor.hpp"
 #include "network/generics/milli_timer.hpp"
@@ -44,8 +45,12 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <future>
+#include <iterator>
 #include <memory>
 #include <utility>
+#include <vector>
 
 using fetch::generics::MilliTimer;
 
@@ -224,10 +229,61 @@ BlockCoordinator::BlockCoordinator(MainChain &chain, DAGPtr dag,
     }
   });
 
+  // rather than only polling, re-evaluate the waiting states as soon as the work completes
+  execution_manager_.SetCompletionCallback([this]() {
+    Wake(State::WAIT_FOR_EXECUTION);
+    Wake(State::WAIT_FOR_NEW_BLOCK_EXECUTION);
+  });
+  storage_unit_.SetTransactionCallback(
+      [this](Digest const & /*digest*/) { Wake(State::WAIT_FOR_TRANSACTIONS); });
+
   // TODO(private issue 792): this shouldn't be here, but if it is, it locks the whole system on
   // startup. RecoverFromStartup();
 }
 
+BlockCoordinator::~BlockCoordinator()
+{
+  execution_manager_.SetCompletionCallback({});
+  storage_unit_.SetTransactionCallback({});
+}
+
+/**
+ * Set the callback used to wake the reactor which is running the state machine, so that
+ * completion notifications are acted upon without waiting for its next poll
+ *
+ * @param callback The callback to be registered
+ */
+void BlockCoordinator::SetWakeCallback(WakeCallback callback)
+{
+  wake_callback_.ApplyVoid([&callback](WakeCallback &wake_callback) {
+    wake_callback = std::move(callback);
+  });
+}
+
+/**
+ * Cancel the polling delay of the state machine, if it is currently in the specified waiting state
+ *
+ * Note: Can be called from any thread
+ *
+ * @param waiting_state The state which is waiting on the work that has completed
+ */
+void BlockCoordinator::Wake(State waiting_state)
+{
+  if (state_machine_->state() != waiting_state)
+  {
+    return;
+  }
+
+  state_machine_->Trigger();
+
+  wake_callback_.ApplyVoid([](WakeCallback const &wake_callback) {
+    if (wake_callback)
+    {
+      wake_callback();
+    }
+  });
+}
+
 // Reload state ONCE on first start up of the block coordinator. Attempt to set
 // it up as if the shutdown didn't happen
 BlockCoordinator::State BlockCoordinator::OnReloadState()
@@ -478,6 +534,7 @@ BlockCoordinator::State BlockCoordinator::OnSynchronising()
 
     // update the current block and begin scheduling
     current_block_ = next_block;
+    prepared_blocks_.erase(current_block_->hash);
 
     blocks_to_common_ancestor_.pop_back();
 
@@ -834,6 +891,9 @@ BlockCoordinator::State BlockCoordinator::OnWaitForTransactions(State current, S
     FETCH_LOG_INFO(LOGGING_NAME, "Waiting for DAG to sync");
   }
 
+  // while waiting make progress on the blocks which will follow this one
+  PrepareUpcomingBlocks();
+
   // signal the next execution of the state machine should be much later in the future
   state_machine_->Delay(std::chrono::milliseconds{200});
 
@@ -846,6 +906,105 @@ void BlockCoordinator::RemoveBlock(MainChain::BlockHash const &hash)
   blocks_to_common_ancestor_.clear();
 }
 
+/**
+ * Evict the transactions which can no longer be included in any block following the one which has
+ * just been committed, from both the miner and the transaction stores of the lanes
+ *
+ * @param committed_block The block which has been committed
+ */
+void BlockCoordinator::RemoveExpiredTransactions(Block const &committed_block)
+{
+  block_packer_.RemoveExpired(committed_block.block_number + 1);
+  storage_unit_.RemoveExpiredTransactions(committed_block.block_number);
+}
+
+/**
+ * During catch up, prepare the blocks which follow the current block along the path to the heaviest
+ * block. Any of their transactions which are missing are requested immediately and their
+ * notarisations are verified on the preparation worker (populating the verification caches). By the
+ * time each of these blocks becomes the current block, it should only be bounded by its execution.
+ */
+void BlockCoordinator::PrepareUpcomingBlocks()
+{
+  // the path is only retained when the coordinator is a long way behind the heaviest block
+  if (blocks_to_common_ancestor_.size() < 2)
+  {
+    prepared_blocks_.clear();
+    return;
+  }
+
+  // only allow a single batch of verification to be in flight at any one time
+  if (prepare_result_.valid() &&
+      (prepare_result_.wait_for(std::chrono::seconds{0}) != std::future_status::ready))
+  {
+    return;
+  }
+
+  std::vector<BlockPtr> upcoming{};
+  DigestSet             missing_txs{};
+
+  // the back of the path is the current block, the blocks which follow it are in front of it
+  auto       it  = std::next(blocks_to_common_ancestor_.crbegin());
+  auto const end = blocks_to_common_ancestor_.crend();
+  for (std::size_t depth = 0; (it != end) && (depth < PIPELINE_DEPTH); ++it, ++depth)
+  {
+    auto const &block = *it;
+
+    if (!prepared_blocks_.emplace(block->hash).second)
+    {
+      continue;
+    }
+
+    for (auto const &slice : block->slices)
+    {
+      for (auto const &tx : slice)
+      {
+        if (!storage_unit_.HasTransaction(tx.digest()))
+        {
+          missing_txs.insert(tx.digest());
+        }
+      }
+    }
+
+    upcoming.emplace_back(block);
+  }
+
+  if (!missing_txs.empty())
+  {
+    request_tx_count_->increment();
+
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Requesting ", missing_txs.size(),
+                    " missing TXs for upcoming blocks (current block: ",
+                    current_block_->block_number, ")");
+
+    storage_unit_.IssueCallForMissingTxs(missing_txs);
+  }
+
+  if (!upcoming.empty())
+  {
+    auto verify = [consensus = consensus_, blocks = std::move(upcoming)]() {
+      std::vector<Block const *> block_refs{};
+      block_refs.reserve(blocks.size());
+
+      for (auto const &block : blocks)
+      {
+        block_refs.emplace_back(block.get());
+      }
+
+      try
+      {
+        consensus->VerifyNotarisations(block_refs);
+      }
+      catch (std::exception const &ex)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Failed to verify upcoming notarisations: ", ex.what());
+      }
+    };
+
+    prepare_result_ = prepare_pool_.Dispatch(std::move(verify));
+  }
+}
+
 BlockCoordinator::State BlockCoordinator::OnScheduleBlockExecution()
 {
   MilliTimer const timer{"OnScheduleBlockExecution ", 1000};
@@ -888,6 +1047,9 @@ BlockCoordinator::State BlockCoordinator::OnWaitForExecution()
                      current_block_->hash.ToHex());
     }
 
+    // while the block executes make progress on the blocks which will follow it
+    PrepareUpcomingBlocks();
+
     // signal that the next execution should not happen immediately
     state_machine_->Delay(std::chrono::milliseconds{20});
     break;
@@ -941,14 +1103,11 @@ BlockCoordinator::State BlockCoordinator::OnPostExecBlockValidation()
     BlockPtr previous_block = chain_.GetBlock(current_block_->previous_hash);
     if (previous_block)
     {
-      if (dag_)
-      {
-        revert_successful = dag_->RevertToEpoch(previous_block->block_number);
-      }
+      bool const dag_reverted = !dag_ || dag_->RevertToEpoch(previous_block->block_number);
 
       // signal the storage engine to make these changes
-      if (storage_unit_.RevertToHash(previous_block->merkle_hash, previous_block->block_number) &&
-          revert_successful)
+      if (dag_reverted &&
+          storage_unit_.RevertToHash(previous_block->merkle_hash, previous_block->block_number))
       {
         execution_manager_.SetLastProcessedBlock(previous_block->hash);
         revert_successful = true;
@@ -973,6 +1132,7 @@ BlockCoordinator::State BlockCoordinator::OnPostExecBlockValidation()
   {
     // Commit this state
     storage_unit_.Commit(current_block_->block_number);
+    TransactionTracer::Instance().Record(*current_block_, TraceStage::COMMITTED);
 
     // Notify the DAG of this epoch
     if (dag_)
@@ -980,6 +1140,8 @@ BlockCoordinator::State BlockCoordinator::OnPostExecBlockValidation()
       dag_->CommitEpoch(current_block_->dag_epoch);
     }
 
+    RemoveExpiredTransactions(*current_block_);
+
     // signal the last block that has been executed
     last_executed_block_.ApplyVoid([this](auto &digest) { digest = current_block_->hash; });
 
@@ -1102,6 +1264,7 @@ BlockCoordinator::State BlockCoordinator::OnWaitForNewBlockExecution()
 
     // Commit the state generated by this block
     storage_unit_.Commit(next_block_->block_number);
+    TransactionTracer::Instance().Record(*next_block_, TraceStage::COMMITTED);
 
     // Notify the DAG of this epoch
     if (dag_)
@@ -1109,6 +1272,8 @@ BlockCoordinator::State BlockCoordinator::OnWaitForNewBlockExecution()
       dag_->CommitEpoch(next_block_->dag_epoch);
     }
 
+    RemoveExpiredTransactions(*next_block_);
+
     next_state = State::TRANSMIT_BLOCK;
     break;
   }
@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "ledger/chain/block_height_index.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <ios>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr std::streamoff HEADER_SIZE = sizeof(uint64_t);
+constexpr std::streamoff RECORD_SIZE = chain::HASH_SIZE;
+
+std::streamoff RecordOffset(uint64_t height)
+{
+  return HEADER_SIZE + (static_cast<std::streamoff>(height) * RECORD_SIZE);
+}
+
+}  // namespace
+
+/**
+ * Create a new empty index, discarding any existing contents of the file
+ *
+ * @param filename The path of the index file
+ */
+void BlockHeightIndex::New(std::string const &filename)
+{
+  FETCH_LOCK(lock_);
+
+  file_.close();
+  file_.open(filename, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+
+  size_ = 0;
+  WriteSize();
+}
+
+/**
+ * Open an existing index, creating an empty one if the file does not exist
+ *
+ * @param filename The path of the index file
+ */
+void BlockHeightIndex::Load(std::string const &filename)
+{
+  FETCH_LOCK(lock_);
+
+  file_.close();
+  file_.open(filename, std::ios::binary | std::ios::in | std::ios::out);
+
+  if (!file_.is_open())
+  {
+    file_.clear();
+    file_.open(filename, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+  }
+
+  size_ = 0;
+  file_.seekg(0);
+  if (!file_.read(reinterpret_cast<char *>(&size_), HEADER_SIZE))
+  {
+    file_.clear();
+    size_ = 0;
+    WriteSize();
+  }
+}
+
+/**
+ * @return The number of heights in the index, one more than the highest block number stored
+ */
+uint64_t BlockHeightIndex::size() const
+{
+  FETCH_LOCK(lock_);
+  return size_;
+}
+
+/**
+ * Look up the hash of the block at a given height
+ *
+ * @param height The block number
+ * @param hash The output hash
+ * @return true if the height is present in the index, otherwise false
+ */
+bool BlockHeightIndex::Get(uint64_t height, BlockHash &hash) const
+{
+  FETCH_LOCK(lock_);
+
+  if (height >= size_)
+  {
+    return false;
+  }
+
+  byte_array::ByteArray buffer;
+  buffer.Resize(chain::HASH_SIZE);
+
+  file_.seekg(RecordOffset(height));
+  if (!file_.read(reinterpret_cast<char *>(buffer.pointer()), RECORD_SIZE))
+  {
+    file_.clear();
+    return false;
+  }
+
+  // heights skipped over by an earlier write are left zero filled
+  for (std::size_t i = 0; i < buffer.size(); ++i)
+  {
+    if (buffer[i] != 0)
+    {
+      hash = buffer;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Record the hash of the block at a given height, growing the index if required
+ *
+ * @param height The block number
+ * @param hash The hash of the block
+ */
+void BlockHeightIndex::Set(uint64_t height, BlockHash const &hash)
+{
+  assert(hash.size() == chain::HASH_SIZE);
+
+  FETCH_LOCK(lock_);
+
+  file_.seekp(RecordOffset(height));
+  file_.write(reinterpret_cast<char const *>(hash.pointer()), RECORD_SIZE);
+
+  if (height >= size_)
+  {
+    size_ = height + 1;
+    WriteSize();
+  }
+}
+
+/**
+ * Discard all heights at or above the specified size
+ *
+ * @param size The new number of heights in the index
+ */
+void BlockHeightIndex::Truncate(uint64_t size)
+{
+  FETCH_LOCK(lock_);
+
+  if (size < size_)
+  {
+    size_ = size;
+    WriteSize();
+  }
+}
+
+void BlockHeightIndex::Flush()
+{
+  FETCH_LOCK(lock_);
+  file_.flush();
+}
+
+void BlockHeightIndex::WriteSize()
+{
+  file_.seekp(0);
+  file_.write(reinterpret_cast<char const *>(&size_), HEADER_SIZE);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,261 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/compact_block.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t ShortIdIndex::DEFAULT_CAPACITY;
+
+/**
+ * @return The short id of a transaction, the leading bytes of its digest
+ */
+ShortTransactionId ToShortId(Digest const &digest)
+{
+  ShortTransactionId id{0};
+  std::memcpy(&id, digest.pointer(), std::min(sizeof(id), digest.size()));
+  return id;
+}
+
+/**
+ * Build the compact form of a block
+ *
+ * @param block The block to be relayed
+ * @return The compact block
+ */
+CompactBlock ToCompactBlock(Block const &block)
+{
+  CompactBlock compact{};
+
+  compact.header.weight          = block.weight;
+  compact.header.total_weight    = block.total_weight;
+  compact.header.miner_signature = block.miner_signature;
+  compact.header.hash            = block.hash;
+  compact.header.previous_hash   = block.previous_hash;
+  compact.header.merkle_hash     = block.merkle_hash;
+  compact.header.block_number    = block.block_number;
+  compact.header.miner_id        = block.miner_id;
+  compact.header.log2_num_lanes  = block.log2_num_lanes;
+  compact.header.dag_epoch       = block.dag_epoch;
+  compact.header.timestamp       = block.timestamp;
+  compact.header.block_entropy   = block.block_entropy;
+
+  compact.slice_sizes.reserve(block.slices.size());
+  compact.short_ids.reserve(block.GetTransactionCount());
+
+  for (auto const &slice : block.slices)
+  {
+    compact.slice_sizes.push_back(static_cast<uint32_t>(slice.size()));
+
+    for (auto const &layout : slice)
+    {
+      compact.short_ids.push_back(ToShortId(layout.digest()));
+    }
+  }
+
+  return compact;
+}
+
+/**
+ * Rebuild a block from its compact form with the transaction layouts known locally. The layouts
+ * which could not be found are left empty.
+ *
+ * @param compact The compact block
+ * @param lookup The source of known transaction layouts
+ * @param block The output block
+ * @return The positions, in slice order, of the transactions which could not be found
+ */
+BlockPositions ReconstructBlock(CompactBlock const &compact, LayoutLookup const &lookup,
+                                Block &block)
+{
+  BlockPositions missing{};
+
+  block = compact.header;
+  block.slices.resize(compact.slice_sizes.size());
+
+  std::size_t position{0};
+  for (std::size_t i = 0; i < compact.slice_sizes.size(); ++i)
+  {
+    auto &slice = block.slices[i];
+    slice.resize(compact.slice_sizes[i]);
+
+    for (auto &layout : slice)
+    {
+      if (position >= compact.short_ids.size())
+      {
+        // the slice sizes do not match the short ids, the block can not be rebuilt
+        missing.clear();
+        block.slices.clear();
+        return missing;
+      }
+
+      if (!lookup || !lookup(compact.short_ids[position], layout))
+      {
+        missing.push_back(static_cast<uint32_t>(position));
+      }
+
+      ++position;
+    }
+  }
+
+  return missing;
+}
+
+/**
+ * Fill in the transaction layouts of a partially rebuilt block
+ *
+ * @param block The block to be completed
+ * @param positions The positions of the missing transactions, in slice order
+ * @param layouts The layouts at each of the positions
+ * @return true if all the layouts were filled in, otherwise false
+ */
+bool CompleteBlock(Block &block, BlockPositions const &positions,
+                   TransactionLayouts const &layouts)
+{
+  if (positions.size() != layouts.size())
+  {
+    return false;
+  }
+
+  std::size_t slice_index{0};
+  std::size_t slice_start{0};
+
+  for (std::size_t i = 0; i < positions.size(); ++i)
+  {
+    // positions are in increasing order so the slices are only walked once
+    while ((slice_index < block.slices.size()) &&
+           (positions[i] >= slice_start + block.slices[slice_index].size()))
+    {
+      slice_start += block.slices[slice_index].size();
+      ++slice_index;
+    }
+
+    if ((slice_index == block.slices.size()) || (positions[i] < slice_start))
+    {
+      return false;
+    }
+
+    block.slices[slice_index][positions[i] - slice_start] = layouts[i];
+  }
+
+  return true;
+}
+
+/**
+ * Look up the transaction layouts at the specified positions of a block
+ *
+ * @param block The block
+ * @param positions The positions of the transactions, in slice order
+ * @return The layouts, or an empty list if any of the positions is not part of the block
+ */
+TransactionLayouts GetTransactionLayouts(Block const &block, BlockPositions const &positions)
+{
+  TransactionLayouts layouts{};
+  layouts.reserve(positions.size());
+
+  std::size_t slice_index{0};
+  std::size_t slice_start{0};
+
+  for (auto const position : positions)
+  {
+    while ((slice_index < block.slices.size()) &&
+           (position >= slice_start + block.slices[slice_index].size()))
+    {
+      slice_start += block.slices[slice_index].size();
+      ++slice_index;
+    }
+
+    if ((slice_index == block.slices.size()) || (position < slice_start))
+    {
+      return {};
+    }
+
+    layouts.push_back(block.slices[slice_index][position - slice_start]);
+  }
+
+  return layouts;
+}
+
+/**
+ * Construct the index
+ *
+ * @param capacity The maximum number of layouts held
+ */
+ShortIdIndex::ShortIdIndex(std::size_t capacity)
+  : capacity_{capacity}
+{}
+
+/**
+ * Add a transaction layout, forgetting the oldest layout if the index is full
+ *
+ * @param layout The layout to add
+ */
+void ShortIdIndex::Add(chain::TransactionLayout const &layout)
+{
+  auto const id = ToShortId(layout.digest());
+
+  FETCH_LOCK(lock_);
+
+  if (!layouts_.emplace(id, layout).second)
+  {
+    return;
+  }
+
+  order_.push_back(id);
+
+  while (order_.size() > capacity_)
+  {
+    layouts_.erase(order_.front());
+    order_.pop_front();
+  }
+}
+
+/**
+ * Look up a transaction layout by its short id
+ *
+ * @param id The short id
+ * @param layout The output layout
+ * @return true if the layout was found, otherwise false
+ */
+bool ShortIdIndex::Lookup(ShortTransactionId id, chain::TransactionLayout &layout) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = layouts_.find(id);
+  if (it == layouts_.end())
+  {
+    return false;
+  }
+
+  layout = it->second;
+  return true;
+}
+
+std::size_t ShortIdIndex::size() const
+{
+  FETCH_LOCK(lock_);
+  return layouts_.size();
+}
+
+}  // namespace ledger
+}  // namespace fetch
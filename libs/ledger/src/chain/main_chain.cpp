@@ -34,10 +34,13 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
-#include <deque>
 #include <fstream>
+#include <future>
+#include <limits>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 
 using fetch::byte_array::ToHex;
@@ -47,9 +50,38 @@ namespace fetch {
 namespace ledger {
 
 namespace {
-constexpr char const *BLOOM_FILTER_STORE = "chain.bloom.db";
+
+constexpr char const *BLOOM_FILTER_STORE  = "chain.bloom.db";
+constexpr char const *VERIFIED_HEAD_STORE = "chain.verified.db";
+
+/**
+ * The hash of the most recent head block which was verified to form a complete chain to genesis,
+ * empty if there is none
+ */
+byte_array::ConstByteArray LoadVerifiedHead()
+{
+  byte_array::ByteArray buffer;
+  buffer.Resize(chain::HASH_SIZE);
+
+  std::ifstream in(VERIFIED_HEAD_STORE, std::ios::binary | std::ios::in);
+  if (!in.read(reinterpret_cast<char *>(buffer.pointer()),
+               static_cast<std::streamsize>(buffer.size())))
+  {
+    return {};
+  }
+
+  return {buffer};
+}
+
+void StoreVerifiedHead(byte_array::ConstByteArray const &hash)
+{
+  std::ofstream out(VERIFIED_HEAD_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
+  out.write(reinterpret_cast<char const *>(hash.pointer()),
+            static_cast<std::streamsize>(hash.size()));
 }
 
+}  // namespace
+
 const uint64_t DIRTY_TIMEOUT{600};
 
 /**
@@ -57,9 +89,10 @@ const uint64_t DIRTY_TIMEOUT{600};
  *
  * @param mode Flag to signal which storage mode has been requested
  */
-MainChain::MainChain(Mode mode, bool dirty_block_functionality)
+MainChain::MainChain(Mode mode, bool dirty_block_functionality, std::size_t block_cache_capacity)
   : mode_{mode}
   , dirty_block_functionality_{dirty_block_functionality}
+  , block_cache_{block_cache_capacity}
   , bloom_filter_{1 + chain::Transaction::MAXIMUM_TX_VALIDITY_PERIOD / 2}
   , bloom_filter_queried_bit_count_(telemetry::Registry::Instance().CreateGauge<std::size_t>(
         "ledger_main_chain_bloom_filter_queried_bit_number",
@@ -92,6 +125,8 @@ MainChain::MainChain(Mode mode, bool dirty_block_functionality)
 
   // add the tip for this block
   AddTip(genesis);
+
+  PublishHeaviestChain();
 }
 
 MainChain::~MainChain()
@@ -118,6 +153,9 @@ void MainChain::Reset()
     head_store_.close();
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+    height_index_.New("chain.height.db");
+    block_cache_.Clear();
+    StoreVerifiedHead({});
   }
 
   std::ofstream out(BLOOM_FILTER_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
@@ -130,6 +168,8 @@ void MainChain::Reset()
 
   // add the tip for this block
   AddTip(genesis);
+
+  PublishHeaviestChain();
 }
 
 /**
@@ -155,6 +195,8 @@ BlockStatus MainChain::AddBlock(Block const &blk)
     AddBlockToBloomFilter(*block);
   }
 
+  PublishHeaviestChain();
+
   return status;
 }
 
@@ -332,13 +374,15 @@ void MainChain::KeepBlock(IntBlockPtr const &block) const
       {
         record.next_hash = hash;
         block_store_->Set(storage::ResourceID(record.hash()), record);
+        block_cache_.Erase(block->previous_hash);
       }
       // before checking for this block's children in storage, reset next_hash to genesis
       record.next_hash = Digest{};
       CacheReference(block->previous_hash, hash, true);
     }
   }
-  record.block = *block;
+  record.block     = *block;
+  record.skip_hash = block->skip_hash;
 
   // detect if any of this block's children has made it to the store already
   auto forward_refs{forward_references_.equal_range(hash)};
@@ -355,6 +399,7 @@ void MainChain::KeepBlock(IntBlockPtr const &block) const
 
   // now write the block itself; if next_hash is genesis, it will be rewritten later by a child
   block_store_->Set(storage::ResourceID(hash), record);
+  block_cache_.Erase(hash);
 }
 
 /**
@@ -371,7 +416,8 @@ bool MainChain::LoadBlock(BlockHash const &hash, Block &block, BlockHash *next_h
   DbRecord record;
   if (block_store_->Get(storage::ResourceID(hash), record))
   {
-    block = record.block;
+    block           = record.block;
+    block.skip_hash = record.skip_hash;
     AddBlockToBloomFilter(block);
     if (next_hash != nullptr)
     {
@@ -411,7 +457,19 @@ void MainChain::AddBlockToBloomFilter(Block const &block) const
  */
 MainChain::BlockPtr MainChain::GetHeaviestBlock() const
 {
-  FETCH_LOCK(lock_);
+  RLock lock{lock_, std::try_to_lock};
+  if (!lock.owns_lock())
+  {
+    // the chain is being updated, serve the request from the last published snapshot
+    auto const snapshot = std::atomic_load(&heaviest_chain_);
+    if (snapshot && !snapshot->blocks.empty())
+    {
+      return snapshot->blocks.front();
+    }
+
+    lock.lock();
+  }
+
   auto block_ptr = GetBlock(heaviest_.Hash());
   assert(block_ptr);
   return block_ptr;
@@ -521,6 +579,7 @@ bool MainChain::RemoveBlock(BlockHash const &hash)
   if (!RemoveTree(hash, invalidated_blocks))
   {
     // no blocks were removed during this attempt
+    PublishHeaviestChain();
     return false;
   }
 
@@ -564,7 +623,22 @@ MainChain::Blocks MainChain::GetHeaviestChain(uint64_t limit) const
   // constexpr
   MilliTimer myTimer("MainChain::HeaviestChain", 2000);
 
-  FETCH_LOCK(lock_);
+  RLock lock{lock_, std::try_to_lock};
+  if (!lock.owns_lock())
+  {
+    // the chain is being updated, attempt to serve the request from the last published snapshot
+    auto const snapshot = std::atomic_load(&heaviest_chain_);
+    if (snapshot && !snapshot->blocks.empty())
+    {
+      Blocks result;
+      if (ReadChainSnapshot(*snapshot, snapshot->blocks.front()->hash, limit, result))
+      {
+        return result;
+      }
+    }
+
+    lock.lock();
+  }
 
   return GetChainPreceding(GetHeaviestBlockHash(), limit);
 }
@@ -622,7 +696,22 @@ MainChain::Blocks MainChain::GetChainPreceding(BlockHash start, uint64_t limit)
 {
   MilliTimer myTimer("MainChain::ChainPreceding", 2000);
 
-  FETCH_LOCK(lock_);
+  RLock lock{lock_, std::try_to_lock};
+  if (!lock.owns_lock())
+  {
+    // the chain is being updated, attempt to serve the request from the last published snapshot
+    auto const snapshot = std::atomic_load(&heaviest_chain_);
+    if (snapshot)
+    {
+      Blocks result;
+      if (ReadChainSnapshot(*snapshot, start, limit, result))
+      {
+        return result;
+      }
+    }
+
+    lock.lock();
+  }
 
   // asserting genesis block has a number of 0, and everything else is above
   assert(GetBlock(chain::GetGenesisDigest()));
@@ -733,6 +822,81 @@ MainChain::Travelogue MainChain::TimeTravel(BlockHash current_hash) const
   return {heaviest->hash, heaviest->block_number, status, std::move(result)};
 }
 
+/**
+ * Build a skeleton of the heaviest chain, made up of the hashes of every `stride`th block starting
+ * at the specified block number. This allows a syncing node to request the intermediate sections
+ * of the chain independently (and from different peers).
+ *
+ * @param start The block number of the first entry
+ * @param stride The difference in block number between consecutive entries
+ * @param limit The maximum number of entries to be returned
+ * @return The array of hashes (earliest first), empty if the start is beyond the heaviest block
+ */
+MainChain::BlockHashes MainChain::GetChainSkeleton(uint64_t start, uint64_t stride,
+                                                   uint64_t limit) const
+{
+  MilliTimer myTimer("MainChain::GetChainSkeleton", 500);
+
+  BlockHashes skeleton{};
+
+  FETCH_LOCK(lock_);
+
+  auto block = GetHeaviestBlock();
+  if ((stride == 0) || (limit == 0) || !block || (block->block_number < start))
+  {
+    return skeleton;
+  }
+
+  // determine the block number of the last entry that will be returned
+  uint64_t const num_entries = std::min(((block->block_number - start) / stride) + 1, limit);
+  uint64_t const last        = start + ((num_entries - 1) * stride);
+
+  skeleton.resize(num_entries);
+
+  // walk back down the heaviest chain recording the hashes of the required blocks
+  while (block && (block->block_number >= start))
+  {
+    uint64_t const number = block->block_number;
+
+    if ((number <= last) && (((number - start) % stride) == 0))
+    {
+      skeleton[(number - start) / stride] = block->hash;
+    }
+
+    if ((number == start) || block->IsGenesis())
+    {
+      break;
+    }
+
+    // once the walk reaches the chain stored on disk the remaining hashes are read by height
+    BlockHash stored_hash{};
+    if (height_index_.Get(number, stored_hash) && (stored_hash == block->hash))
+    {
+      bool complete{true};
+      for (uint64_t height = start; complete && (height < number) && (height <= last);
+           height += stride)
+      {
+        complete = height_index_.Get(height, skeleton[(height - start) / stride]);
+      }
+
+      if (complete)
+      {
+        return skeleton;
+      }
+    }
+
+    block = GetBlock(block->previous_hash);
+  }
+
+  if (!block || (block->block_number != start))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to build the chain skeleton from block: ", start);
+    skeleton.clear();
+  }
+
+  return skeleton;
+}
+
 /**
  * Get a common sub tree from the chain.
  *
@@ -757,102 +921,67 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip_hash, Bloc
 
   FETCH_LOCK(lock_);
 
-  bool success{true};
-
   // clear the output structure
   blocks.clear();
 
-  BlockPtr left{};
-  BlockPtr right{};
-
-  BlockHash left_hash  = std::move(tip_hash);
-  BlockHash right_hash = std::move(node_hash);
-
-  std::deque<BlockPtr> res;
+  IntBlockPtr const tip = LookupBlock(tip_hash);
+  if (!tip)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to look up block (left): 0x", ToHex(tip_hash));
+    return false;
+  }
 
-  // The algorithm implemented here is effectively a coordinated parallel walk about from the two
-  // input tips until the a common ancestor is located.
-  for (;;)
+  IntBlockPtr const node = LookupBlock(node_hash);
+  if (!node)
   {
-    // load up the left side
-    if (!left || left->hash != left_hash)
-    {
-      left = GetBlock(left_hash);
-      if (!left)
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "Unable to look up block (left): 0x", ToHex(left_hash));
-        success = false;
-        break;
-      }
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to look up block (right): 0x", ToHex(node_hash));
+    return false;
+  }
 
-      // left side always loaded into output queue as we traverse
-      // blocks.push_back(left);
-      res.push_back(left);
-      bool break_loop = false;
+  // locate the common ancestor by following the skip pointers of both sides, rather than walking
+  // back one block at a time
+  IntBlockPtr const ancestor = GetCommonAncestor(tip, node);
+  if (!ancestor)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to locate common ancestor of: 0x", ToHex(tip_hash),
+                   " and 0x", ToHex(node_hash));
+    return false;
+  }
 
-      switch (behaviour)
-      {
-      case BehaviourWhenLimit::RETURN_LEAST_RECENT:
-        if (res.size() > limit)
-        {
-          res.pop_front();
-        }
-        break;
-      case BehaviourWhenLimit::RETURN_MOST_RECENT:
-        if (res.size() >= limit)
-        {
-          break_loop = true;
-        }
-        break;
-      }
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Common ancestor of: 0x", ToHex(tip_hash), " and 0x",
+                  ToHex(node_hash), " is: ", ancestor->block_number);
 
-      if (break_loop)
-      {
-        break;
-      }
-    }
+  // when only the least recent blocks of the path are wanted, skip straight to the first of them
+  IntBlockPtr    current     = tip;
+  uint64_t const path_length = (tip->block_number - ancestor->block_number) + 1;
 
-    // load up the right side
-    if (!right || right->hash != right_hash)
-    {
-      right = GetBlock(right_hash);
-      if (!right)
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "Unable to look up block (right): 0x", ToHex(right_hash));
-        success = false;
-        break;
-      }
-    }
+  if ((behaviour == BehaviourWhenLimit::RETURN_LEAST_RECENT) && (path_length > limit))
+  {
+    current = (limit > 0) ? GetAncestor(tip, ancestor->block_number + (limit - 1)) : IntBlockPtr{};
+  }
 
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Left: 0x", ToHex(left_hash), " -> ", left->block_number,
-                    " Right: 0x", ToHex(right_hash), " -> ", right->block_number);
+  // walk the remainder of the path collecting the blocks
+  while (current && (blocks.size() < limit))
+  {
+    blocks.push_back(current);
 
-    if (left_hash == right_hash)
+    if (current->hash == ancestor->hash)
     {
       break;
     }
 
-    if (left->block_number <= right->block_number)
+    current = LookupBlock(current->previous_hash);
+    if (!current)
     {
-      right_hash = right->previous_hash;
-    }
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to look up block on the path to the common ancestor");
 
-    if (left->block_number >= right->block_number)
-    {
-      left_hash = left->previous_hash;
+      // If a lookup error has occurred then we do not return anything
+      blocks.clear();
+      return false;
     }
   }
 
-  blocks.resize(res.size());
-  std::move(res.begin(), res.end(), blocks.begin());
-
-  // If a lookup error has occurred then we do not return anything
-  if (!success)
-  {
-    blocks.clear();
-  }
-
-  return success;
+  return true;
 }
 
 /**
@@ -869,7 +998,18 @@ MainChain::BlockPtr MainChain::GetBlock(BlockHash const &hash) const
     return {};
   }
 
-  FETCH_LOCK(lock_);
+  RLock lock{lock_, std::try_to_lock};
+  if (!lock.owns_lock())
+  {
+    // the chain is being updated, recent heaviest chain blocks can be served from the snapshot
+    auto block = ReadSnapshotBlock(hash);
+    if (block)
+    {
+      return block;
+    }
+
+    lock.lock();
+  }
 
   BlockPtr output_block{};
 
@@ -985,6 +1125,9 @@ void MainChain::RecoverFromFile(Mode mode)
     block_store_->New("chain.db", "chain.index.db");
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+    height_index_.New("chain.height.db");
+    block_cache_.Clear();
+    StoreVerifiedHead({});
 
     std::ofstream out(BLOOM_FILTER_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
     bloom_filter_.Reset();
@@ -998,6 +1141,7 @@ void MainChain::RecoverFromFile(Mode mode)
 
     block_store_->Load("chain.db", "chain.index.db");
     head_store_.open("chain.head.db", std::ios::binary | std::ios::in | std::ios::out);
+    height_index_.Load("chain.height.db");
 
     std::ifstream in(BLOOM_FILTER_STORE, std::ios::binary | std::ios::in);
 
@@ -1031,10 +1175,28 @@ void MainChain::RecoverFromFile(Mode mode)
   {
     auto block_index = head->block_number;
 
+    // The blocks below a head which was verified on a previous start up form a complete chain,
+    // since the file is only ever extended from its current head. The walk stops there, unless
+    // the height index does not match the stored chain and has to be rebuilt along the way.
+    BlockHash const verified_head = LoadVerifiedHead();
+
+    BlockHash  indexed_head{};
+    bool const rebuild_index = (height_index_.size() != (head->block_number + 1)) ||
+                               !height_index_.Get(head->block_number, indexed_head) ||
+                               (indexed_head != head->hash);
+
+    if (rebuild_index)
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Rebuilding block height index from the stored chain");
+      height_index_.Truncate(0);
+      height_index_.Set(head->block_number, head->hash);
+    }
+
     // Copy head block so as to walk down the chain
     IntBlockPtr next = std::make_shared<Block>(*head);
 
-    while (LoadBlock(next->previous_hash, *next))
+    while ((rebuild_index || (next->hash != verified_head)) &&
+           LoadBlock(next->previous_hash, *next))
     {
       if (next->block_number != block_index - 1)
       {
@@ -1044,9 +1206,20 @@ void MainChain::RecoverFromFile(Mode mode)
         break;
       }
 
+      if (rebuild_index)
+      {
+        height_index_.Set(next->block_number, next->hash);
+      }
+
       block_index = next->block_number;
     }
 
+    if (!rebuild_index && (next->hash == verified_head))
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Reached previously verified head at block: ", block_index);
+      block_index = 0;
+    }
+
     if (block_index != 0)
     {
       FETCH_LOG_WARN(LOGGING_NAME,
@@ -1079,6 +1252,9 @@ void MainChain::RecoverFromFile(Mode mode)
       FETCH_LOG_INFO(LOGGING_NAME, "Heaviest block now: ", heaviest_block_num);
       FETCH_LOG_INFO(LOGGING_NAME, "Heaviest block weight: ", GetHeaviestBlock()->total_weight);
 
+      // remember the head so that the next start up only verifies the blocks written after it
+      StoreVerifiedHead(head->hash);
+
       // signal that the recovery was successful
       recovery_complete = true;
     }
@@ -1098,6 +1274,9 @@ void MainChain::RecoverFromFile(Mode mode)
     head_store_.close();
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+    height_index_.New("chain.height.db");
+    block_cache_.Clear();
+    StoreVerifiedHead({});
 
     std::ofstream out(BLOOM_FILTER_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
     bloom_filter_.Reset();
@@ -1146,6 +1325,9 @@ void MainChain::WriteToFile()
 
       KeepBlock(block);
       SetHeadHash(block->hash);
+
+      height_index_.Set(block->block_number, block->hash);
+      height_index_.Truncate(block->block_number + 1);
     }
     else
     {
@@ -1163,6 +1345,7 @@ void MainChain::WriteToFile()
       for (;;)
       {
         KeepBlock(block);
+        height_index_.Set(block->block_number, block->hash);
 
         // Keep the current_file_head one block behind
         while (current_file_head->block_number > block->block_number - 1)
@@ -1182,6 +1365,7 @@ void MainChain::WriteToFile()
 
       // Success - we kept a copy of the new head to write
       SetHeadHash(block_head->hash);
+      height_index_.Truncate(block_head->block_number + 1);
     }
 
     // Clear the block from ram
@@ -1195,6 +1379,42 @@ void MainChain::WriteToFile()
   }
 }
 
+/**
+ * Estimate the memory held by the blocks kept in memory, both the recent blocks and those cached
+ * after being read back from storage
+ *
+ * @return The approximate size in bytes
+ */
+std::size_t MainChain::GetCacheSizeInBytes() const
+{
+  FETCH_LOCK(lock_);
+
+  std::size_t size = block_cache_.size_in_bytes();
+  for (auto const &entry : block_chain_)
+  {
+    size += BlockCache::EstimateSize(*entry.second);
+  }
+
+  return size;
+}
+
+/**
+ * Release as much of the memory held by the blocks kept in memory as possible, without losing any
+ * block. The blocks outside of the finality period are dropped when they have been persisted and
+ * the cache of blocks read back from storage is emptied.
+ */
+void MainChain::ReleaseCache()
+{
+  FETCH_LOCK(lock_);
+
+  if (block_store_)
+  {
+    TrimCache();
+  }
+
+  block_cache_.Clear();
+}
+
 /**
  * Trim the in memory cache
  *
@@ -1522,6 +1742,13 @@ BlockStatus MainChain::InsertBlock(IntBlockPtr const &block, bool evaluate_loose
   // update the final (total) weight for this block
   block->total_weight = prev_block->total_weight + block->weight;
 
+  // point the block at its skip ancestor, if the ancestor can not be found then lookups fall back
+  // to walking the previous hashes. Blocks recovered from records written before skip pointers
+  // were introduced have none, so the walk over them is capped to keep the insertion cheap
+  auto const skip_block = GetAncestor(prev_block, GetSkipHeight(block->block_number),
+                                      SKIP_FALLBACK_STEP_LIMIT);
+  block->skip_hash      = skip_block ? skip_block->hash : BlockHash{};
+
   // At this point we can proceed knowing that the block is building upon existing tip
 
   // At this point we have a new block with a prev that's known and not loose. Update tips
@@ -1622,25 +1849,155 @@ bool MainChain::LookupBlockFromStorage(BlockHash const &hash, IntBlockPtr &block
 
   if (block_store_)
   {
-    // create the output block
-    auto output_block = std::make_shared<Block>();
+    BlockCache::BlockPtr cached_block{};
+    BlockHash            stored_next_hash{};
 
-    // attempt to read the block from the storage engine
-    success = LoadBlock(hash, *output_block, next_hash);
+    if (block_cache_.Get(hash, cached_block, stored_next_hash))
+    {
+      // update references as if the block had been loaded from storage
+      if (!cached_block->IsGenesis())
+      {
+        CacheReference(cached_block->previous_hash, hash, true);
+      }
+      if (!stored_next_hash.empty())
+      {
+        CacheReference(hash, stored_next_hash, true);
+      }
 
-    if (success)
+      // callers are free to modify the returned block, so the cached copy is never handed out
+      block   = std::make_shared<Block>(*cached_block);
+      success = true;
+    }
+    else
     {
-      // hash not serialised, needs to be recomputed
-      output_block->UpdateDigest();
+      // create the output block
+      auto output_block = std::make_shared<Block>();
 
-      // update the returned shared pointer
-      block = std::move(output_block);
+      // attempt to read the block from the storage engine
+      success = LoadBlock(hash, *output_block, &stored_next_hash);
+
+      if (success)
+      {
+        // hash not serialised, needs to be recomputed
+        output_block->UpdateDigest();
+
+        block_cache_.Add(std::make_shared<Block const>(*output_block), stored_next_hash);
+
+        // update the returned shared pointer
+        block = std::move(output_block);
+      }
+    }
+
+    if (success && (next_hash != nullptr))
+    {
+      *next_hash = stored_next_hash;
     }
   }
 
   return success;
 }
 
+/**
+ * Determine the block number of the ancestor that a block's skip pointer refers to.
+ *
+ * The skip height is formed by clearing the lowest set bits of the block number, so that each
+ * block points at an ancestor a power of two blocks below it. The scheme is the same as the one
+ * used by Bitcoin, where odd heights clear an extra bit so that consecutive blocks rarely share
+ * a skip target, which allows any ancestor to be reached in O(log n) steps.
+ *
+ * @param block_number The block number of the block
+ * @return The block number of its skip ancestor
+ */
+uint64_t MainChain::GetSkipHeight(uint64_t block_number)
+{
+  auto const invert_lowest_one = [](uint64_t n) { return n & (n - 1u); };
+
+  if (block_number < 2u)
+  {
+    return 0;
+  }
+
+  return ((block_number & 1u) != 0u)
+             ? invert_lowest_one(invert_lowest_one(block_number - 1u)) + 1u
+             : invert_lowest_one(block_number);
+}
+
+/**
+ * Internal: Look up the ancestor of a block at a given block number, following the skip pointers
+ * of the blocks where possible. Blocks without a skip pointer are stepped over one at a time.
+ *
+ * @param block The block to start from
+ * @param block_number The block number of the ancestor
+ * @param max_fallback_steps The maximum number of blocks without a skip pointer to step over
+ * @return The ancestor if it could be found, otherwise an empty pointer
+ */
+MainChain::IntBlockPtr MainChain::GetAncestor(IntBlockPtr block, uint64_t block_number,
+                                              std::size_t max_fallback_steps) const
+{
+  std::size_t fallback_steps{0};
+  while (block && (block->block_number > block_number))
+  {
+    if (block->skip_hash.empty() && (fallback_steps++ >= max_fallback_steps))
+    {
+      return {};
+    }
+
+    uint64_t const height      = block->block_number;
+    uint64_t const skip_height = GetSkipHeight(height);
+    uint64_t const prev_skip   = GetSkipHeight(height - 1u);
+
+    // only take the skip pointer when it does not overshoot, and when the previous block's skip
+    // pointer would not be a better choice
+    bool const use_skip =
+        !block->skip_hash.empty() &&
+        ((skip_height == block_number) ||
+         ((skip_height > block_number) &&
+          !((prev_skip + 2u < skip_height) && (prev_skip >= block_number))));
+
+    block = LookupBlock(use_skip ? block->skip_hash : block->previous_hash);
+  }
+
+  return block;
+}
+
+/**
+ * Internal: Locate the most recent common ancestor of two blocks
+ *
+ * @param left The first block
+ * @param right The second block
+ * @return The common ancestor if it could be found, otherwise an empty pointer
+ */
+MainChain::IntBlockPtr MainChain::GetCommonAncestor(IntBlockPtr left, IntBlockPtr right) const
+{
+  if (!left || !right)
+  {
+    return {};
+  }
+
+  // bring both sides to the same height
+  if (left->block_number > right->block_number)
+  {
+    left = GetAncestor(std::move(left), right->block_number);
+  }
+  else if (right->block_number > left->block_number)
+  {
+    right = GetAncestor(std::move(right), left->block_number);
+  }
+
+  while (left && right && (left->hash != right->hash))
+  {
+    // since skip pointers of blocks of the same height refer to the same height, the ancestor
+    // must lie below them whenever they differ
+    bool const use_skip = !left->skip_hash.empty() && !right->skip_hash.empty() &&
+                          (left->skip_hash != right->skip_hash);
+
+    left  = LookupBlock(use_skip ? left->skip_hash : left->previous_hash);
+    right = LookupBlock(use_skip ? right->skip_hash : right->previous_hash);
+  }
+
+  return (left && right) ? left : IntBlockPtr{};
+}
+
 /**
  * No Locking: Determine is a specified block is in the cache
  *
@@ -1771,6 +2128,7 @@ bool MainChain::ReindexTips()
 
   if (tips_.empty())
   {
+    PublishHeaviestChain();
     return false;
   }
 
@@ -1779,9 +2137,124 @@ bool MainChain::ReindexTips()
   assert(heaviest_block);
   heaviest_.Set(*heaviest_block);
 
+  PublishHeaviestChain();
+
   return true;
 }
 
+/**
+ * Internal: Publish an immutable snapshot of the most recent section of the heaviest chain. Readers
+ * which find the chain lock held by an update are served from this snapshot instead of waiting.
+ */
+void MainChain::PublishHeaviestChain()
+{
+  FETCH_LOCK(lock_);
+
+  auto const previous = std::atomic_load(&heaviest_chain_);
+  bool const has_previous{previous && !previous->blocks.empty()};
+
+  // nothing to do if the heaviest tip has not changed since the last publication
+  if (has_previous && (previous->blocks.front()->hash == heaviest_.Hash()))
+  {
+    return;
+  }
+
+  auto snapshot = std::make_shared<ChainSnapshot>();
+  auto tip      = LookupBlock(heaviest_.Hash());
+
+  if (tip)
+  {
+    auto &blocks = snapshot->blocks;
+    blocks.reserve(HEAVIEST_CHAIN_SNAPSHOT_DEPTH);
+    blocks.push_back(tip);
+
+    if (has_previous && (tip->previous_hash == previous->blocks.front()->hash))
+    {
+      // the common case, the heaviest chain has been extended by a single block
+      auto const count = std::min(previous->blocks.size(), HEAVIEST_CHAIN_SNAPSHOT_DEPTH - 1u);
+      blocks.insert(blocks.end(), previous->blocks.begin(),
+                    previous->blocks.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+    else
+    {
+      // otherwise rebuild the snapshot from the blocks that are currently cached
+      IntBlockPtr block = tip;
+      while (!block->IsGenesis() && (blocks.size() < HEAVIEST_CHAIN_SNAPSHOT_DEPTH))
+      {
+        BlockHash const previous_hash = block->previous_hash;
+        if (!LookupBlockFromCache(previous_hash, block))
+        {
+          break;
+        }
+
+        blocks.push_back(block);
+      }
+    }
+
+    snapshot->index.reserve(blocks.size());
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+      snapshot->index.emplace(blocks[i]->hash, i);
+    }
+  }
+
+  std::atomic_store(&heaviest_chain_, ChainSnapshotPtr{std::move(snapshot)});
+}
+
+/**
+ * Internal: Collect a section of the chain from a published snapshot
+ *
+ * @param snapshot The snapshot to be read
+ * @param start The hash of the first block
+ * @param limit The maximum amount of blocks returned
+ * @param[out] blocks The array of blocks
+ * @return true if the snapshot was able to completely serve the request, otherwise false
+ */
+bool MainChain::ReadChainSnapshot(ChainSnapshot const &snapshot, BlockHash const &start,
+                                  uint64_t limit, Blocks &blocks) const
+{
+  auto const it = snapshot.index.find(start);
+  if (it == snapshot.index.end())
+  {
+    return false;
+  }
+
+  auto const begin     = snapshot.blocks.begin() + static_cast<std::ptrdiff_t>(it->second);
+  auto const available = static_cast<uint64_t>(snapshot.blocks.end() - begin);
+
+  // the snapshot must either reach genesis or contain enough blocks to satisfy the limit
+  if ((available < limit) && !snapshot.blocks.back()->IsGenesis())
+  {
+    return false;
+  }
+
+  auto const count = std::min(available, limit);
+  blocks.assign(begin, begin + static_cast<std::ptrdiff_t>(count));
+
+  return true;
+}
+
+/**
+ * Internal: Look up a block from the last published snapshot
+ *
+ * @param hash The hash being queried
+ * @return The block if it is part of the snapshot, otherwise an empty pointer
+ */
+MainChain::BlockPtr MainChain::ReadSnapshotBlock(BlockHash const &hash) const
+{
+  auto const snapshot = std::atomic_load(&heaviest_chain_);
+  if (snapshot)
+  {
+    auto const it = snapshot->index.find(hash);
+    if (it != snapshot->index.end())
+    {
+      return snapshot->blocks[it->second];
+    }
+  }
+
+  return {};
+}
+
 /**
  * Create the initial genesis block
  * @return The generated block
@@ -1804,7 +2277,19 @@ MainChain::IntBlockPtr MainChain::CreateGenesisBlock()
  */
 MainChain::BlockHash MainChain::GetHeaviestBlockHash() const
 {
-  FETCH_LOCK(lock_);
+  RLock lock{lock_, std::try_to_lock};
+  if (!lock.owns_lock())
+  {
+    // the chain is being updated, serve the request from the last published snapshot
+    auto const snapshot = std::atomic_load(&heaviest_chain_);
+    if (snapshot && !snapshot->blocks.empty())
+    {
+      return snapshot->blocks.front()->hash;
+    }
+
+    lock.lock();
+  }
+
   return heaviest_.Hash();
 }
 
@@ -1961,6 +2446,7 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &           sta
   }
 
   DigestSet potential_duplicates{};
+  uint64_t  lowest_block_number{std::numeric_limits<uint64_t>::max()};
   for (auto const &tx_layout : transactions)
   {
     std::pair<bool, std::size_t> const result =
@@ -1970,14 +2456,19 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &           sta
     {
       bloom_filter_positive_count_->increment();
       potential_duplicates.insert(tx_layout.digest());
+      lowest_block_number = std::min(lowest_block_number, EarliestInclusionBlock(tx_layout));
     }
     bloom_filter_query_count_->increment();
   }
 
   auto search_chain_for_duplicates =
-      [this, block](DigestSet const &transaction_digests) mutable -> DigestSet {
-    DigestSet duplicates{};
-    for (;;)
+      [this, lowest_block_number, block](DigestSet const &transaction_digests) mutable {
+    DigestSet    duplicates{};
+    IntBlockPtrs segment{};
+    segment.reserve(DUPLICATE_SEARCH_SEGMENT_LENGTH);
+
+    bool more_blocks{true};
+    while (more_blocks)
     {
       // Traversing the chain fully is costly: break out early if we know the transactions are all
       // duplicated (or both sets are empty)
@@ -1986,22 +2477,28 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &           sta
         break;
       }
 
-      for (auto const &slice : block->slices)
+      // collect the next segment of the chain. A transaction can only be included in a block inside
+      // its validity window, the blocks below the earliest window can never contain a duplicate
+      segment.clear();
+      while (segment.size() < DUPLICATE_SEARCH_SEGMENT_LENGTH)
       {
-        for (auto const &tx : slice)
+        if (block->block_number < lowest_block_number)
         {
-          if (transaction_digests.find(tx.digest()) != transaction_digests.end())
-          {
-            duplicates.insert(tx.digest());
-          }
+          more_blocks = false;
+          break;
         }
-      }
 
-      // exit the loop once we can no longer find the block
-      if (!LookupBlock(block->previous_hash, block))
-      {
-        break;
+        segment.push_back(block);
+
+        // exit the loop once we can no longer find the block
+        if (!LookupBlock(block->previous_hash, block))
+        {
+          more_blocks = false;
+          break;
+        }
       }
+
+      SearchForDuplicates(segment, transaction_digests, duplicates);
     }
 
     return duplicates;
@@ -2016,6 +2513,78 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &           sta
   return duplicates;
 }
 
+/**
+ * Search a segment of the chain for any of the specified transactions. Large segments are split
+ * up and searched in parallel.
+ *
+ * @param segment The blocks to be searched
+ * @param transaction_digests The set of transaction digests to search for
+ * @param duplicates The set to be populated with the digests found in the segment
+ */
+void MainChain::SearchForDuplicates(IntBlockPtrs const &segment,
+                                    DigestSet const &transaction_digests, DigestSet &duplicates)
+{
+  auto search = [&segment, &transaction_digests](std::size_t begin, std::size_t end) {
+    DigestSet found{};
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      for (auto const &slice : segment[i]->slices)
+      {
+        for (auto const &tx : slice)
+        {
+          if (transaction_digests.find(tx.digest()) != transaction_digests.end())
+          {
+            found.insert(tx.digest());
+          }
+        }
+      }
+    }
+
+    return found;
+  };
+
+  std::size_t const num_workers =
+      std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                            segment.size() / DUPLICATE_SEARCH_MIN_BLOCKS);
+
+  if (num_workers < 2)
+  {
+    auto const found = search(0, segment.size());
+    duplicates.insert(found.begin(), found.end());
+    return;
+  }
+
+  std::size_t const blocks_per_worker = (segment.size() + num_workers - 1) / num_workers;
+
+  std::vector<std::future<DigestSet>> results{};
+  results.reserve(num_workers);
+  for (std::size_t begin = 0; begin < segment.size(); begin += blocks_per_worker)
+  {
+    results.emplace_back(std::async(std::launch::async, search, begin,
+                                    std::min(begin + blocks_per_worker, segment.size())));
+  }
+
+  for (auto &result : results)
+  {
+    auto const found = result.get();
+    duplicates.insert(found.begin(), found.end());
+  }
+}
+
+/**
+ * Determine the lowest block number in which a transaction could have been included
+ *
+ * @param tx_layout The layout of the transaction
+ * @return The earliest block number in the validity window of the transaction
+ */
+uint64_t MainChain::EarliestInclusionBlock(chain::TransactionLayout const &tx_layout)
+{
+  auto const valid_until = tx_layout.valid_until();
+
+  return valid_until -
+         std::min(valid_until, uint64_t{chain::Transaction::MAXIMUM_TX_VALIDITY_PERIOD});
+}
+
 void MainChain::FlushToDisk()
 {
   using namespace fetch::serializers;
@@ -2023,6 +2592,7 @@ void MainChain::FlushToDisk()
   if (block_store_)
   {
     block_store_->Flush(false);
+    height_index_.Flush();
   }
 
   if (mode_ != Mode::IN_MEMORY_DB)
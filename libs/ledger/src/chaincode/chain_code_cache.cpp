@@ -39,15 +39,7 @@ ChainCodeCache::ContractPtr ChainCodeCache::Lookup(ConstByteArray const &contrac
   // if this fails create the contract
   if (!contract)
   {
-    chain::Address address;
-    if (chain::Address::Parse(contract_id, address))
-    {
-      contract = CreateSmartContract<SmartContract>(address, storage);
-    }
-    else
-    {
-      contract = CreateChainCode(contract_id);
-    }
+    contract = CreateContract(contract_id, storage, optimise_);
 
     // update the cache
     if (contract)
@@ -65,6 +57,40 @@ ChainCodeCache::ContractPtr ChainCodeCache::Lookup(ConstByteArray const &contrac
   return contract;
 }
 
+/**
+ * Create a new instance of a contract, either a smart contract loaded from the storage or one of
+ * the built in chain codes
+ *
+ * @param contract_id The address of the smart contract or the name of the chain code
+ * @param storage The storage from which smart contracts are loaded
+ * @param optimise Flag to signal smart contracts should be optimised
+ * @return The contract instance if successful, otherwise nullptr
+ */
+ChainCodeCache::ContractPtr ChainCodeCache::CreateContract(ConstByteArray const &contract_id,
+                                                           StorageInterface &    storage,
+                                                           bool                  optimise)
+{
+  chain::Address address;
+  if (chain::Address::Parse(contract_id, address))
+  {
+    return CreateSmartContract<SmartContract>(address, storage, optimise);
+  }
+
+  return CreateChainCode(contract_id);
+}
+
+/**
+ * Enable or disable the bytecode optimisation of the smart contracts which are loaded into the
+ * cache. Since optimised contracts are charged less, this must match the rest of the network.
+ * Contracts which are already cached are not affected.
+ *
+ * @param enable Flag to signal that the contracts should be optimised
+ */
+void ChainCodeCache::EnableOptimisation(bool enable)
+{
+  optimise_ = enable;
+}
+
 ChainCodeCache::ContractPtr ChainCodeCache::FindInCache(ConstByteArray const &contract_id)
 {
   ContractPtr contract;
@@ -22,13 +22,12 @@
 #include "core/serializers/main_serializer.hpp"
 #include "http/json_response.hpp"
 #include "json/document.hpp"
+#include "ledger/admission_controller.hpp"
 #include "ledger/chaincode/chain_code_factory.hpp"
 #include "ledger/chaincode/contract.hpp"
-#include "ledger/chaincode/contract_context.hpp"
-#include "ledger/chaincode/contract_context_attacher.hpp"
 #include "ledger/chaincode/contract_http_interface.hpp"
-#include "ledger/state_adapter.hpp"
 #include "ledger/transaction_processor.hpp"
+#include "ledger/transaction_stream.hpp"
 #include "logging/logging.hpp"
 #include "variant/variant.hpp"
 
@@ -84,63 +83,101 @@ std::string GenerateTimestamp()
   return {buffer};
 }
 
-bool CreateTxFromJson(Variant const &tx_obj, std::vector<ConstByteArray> &txs,
-                      TransactionProcessor &processor)
+enum class Submission
 {
-  auto tx = std::make_shared<chain::Transaction>();
+  ACCEPTED,
+  SHED,
+  INVALID
+};
 
-  if (chain::FromJsonTransaction(tx_obj, *tx))
+Submission SubmitTx(std::shared_ptr<chain::Transaction> tx, std::vector<ConstByteArray> &txs,
+                    TransactionProcessor &processor, AdmissionController *admission)
+{
+  if (tx->charge_limit() > chain::Transaction::MAXIMUM_TX_CHARGE_LIMIT)
   {
-    if (tx->charge_limit() > chain::Transaction::MAXIMUM_TX_CHARGE_LIMIT)
-    {
-      return false;
-    }
+    return Submission::INVALID;
+  }
+
+  if ((admission != nullptr) && !admission->Admit(*tx))
+  {
+    return Submission::SHED;
+  }
+
+  txs.emplace_back(tx->digest());
+  processor.AddTransaction(std::move(tx));
 
-    txs.emplace_back(tx->digest());
-    processor.AddTransaction(std::move(tx));
+  return Submission::ACCEPTED;
+}
+
+void Tally(Submission submission, std::size_t &submitted, std::size_t &shed)
+{
+  if (submission == Submission::ACCEPTED)
+  {
+    ++submitted;
+  }
+  else if (submission == Submission::SHED)
+  {
+    ++shed;
+  }
+}
+
+Submission CreateTxFromJson(Variant const &tx_obj, std::vector<ConstByteArray> &txs,
+                            TransactionProcessor &processor, AdmissionController *admission)
+{
+  auto tx = std::make_shared<chain::Transaction>();
 
-    return true;
+  if (chain::FromJsonTransaction(tx_obj, *tx))
+  {
+    return SubmitTx(std::move(tx), txs, processor, admission);
   }
 
-  return false;
+  return Submission::INVALID;
 }
 
-bool CreateTxFromBuffer(ConstByteArray const &encoded_tx, std::vector<ConstByteArray> &txs,
-                        TransactionProcessor &processor)
+Submission CreateTxFromBuffer(ConstByteArray const &encoded_tx, std::vector<ConstByteArray> &txs,
+                              TransactionProcessor &processor, AdmissionController *admission)
 {
   auto tx = std::make_shared<chain::Transaction>();
 
   chain::TransactionSerializer tx_serializer{encoded_tx};
   if (tx_serializer.Deserialize(*tx))
   {
-    if (tx->charge_limit() > chain::Transaction::MAXIMUM_TX_CHARGE_LIMIT)
-    {
-      return false;
-    }
-
-    txs.emplace_back(tx->digest());
-    processor.AddTransaction(std::move(tx));
-
-    return true;
+    return SubmitTx(std::move(tx), txs, processor, admission);
   }
 
-  return false;
+  return Submission::INVALID;
 }
 
 constexpr char const *LOGGING_NAME = "ContractHttpInterface";
 
+ContractQueryExecutor::Config QueryConfig(chain::ShardedBalancesPtr sharded_balances)
+{
+  auto config             = ContractQueryExecutor::DefaultConfig();
+  config.sharded_balances = std::move(sharded_balances);
+
+  return config;
+}
+
 }  // namespace
 
+constexpr char const *ContractHttpInterface::QUERY_PATH;
+
 /**
  * Construct an Contract HTTP Interface module
  *
  * @param storage The reference to the storage engine
  * @param processor The reference to the (input) transaction processor
+ * @param admission The (optional) controller deciding which submitted transactions are accepted
+ * @param sharded_balances The accounts with sharded balances, if any
  */
-ContractHttpInterface::ContractHttpInterface(StorageInterface &    storage,
-                                             TransactionProcessor &processor)
+ContractHttpInterface::ContractHttpInterface(StorageInterface &        storage,
+                                             TransactionProcessor &    processor,
+                                             AdmissionController *     admission,
+                                             chain::ShardedBalancesPtr sharded_balances)
   : storage_{storage}
   , processor_{processor}
+  , admission_{admission}
+  , query_executor_{storage, QueryConfig(std::move(sharded_balances))}
   , access_log_{"access.log"}
 {
   // create all the contracts
@@ -197,8 +234,7 @@ ContractHttpInterface::ContractHttpInterface(StorageInterface &    storage,
     }
   }
 
-  Post("/api/contract/(identifier=[1-9A-HJ-NP-Za-km-z]{48,50})/(query=.+)",
-       "Submits a query to a contract",
+  Post(QUERY_PATH, "Submits a query to a contract",
        {{"identifier", "The query identifier.", http::validators::StringValue()}},
        [this](http::ViewParameters const &params, http::HTTPRequest const &request) {
          // build the contract name
@@ -240,11 +276,15 @@ http::HTTPResponse ContractHttpInterface::OnQuery(ConstByteArray const &   contr
     json::JSONDocument doc;
     doc.Parse(request.body());
     variant::Variant response;
-    // dispatch the contract type
-    auto contract = contract_cache_.Lookup(contract_name, storage_);
 
-    if (!contract)
+    auto const status = query_executor_.Execute(contract_name, query, doc.root(), response);
+
+    switch (status)
     {
+    case ContractQueryExecutor::Status::OK:
+      return http::CreateJsonResponse(response);
+
+    case ContractQueryExecutor::Status::NOT_FOUND:
       response           = Variant::Object();
       response["status"] = "failed";
       response["msg"]    = "Unable to look up contract: " + static_cast<std::string>(contract_name);
@@ -252,30 +292,20 @@ http::HTTPResponse ContractHttpInterface::OnQuery(ConstByteArray const &   contr
       response["result"]  = variant::Variant::Null();
 
       return http::CreateJsonResponse(response, http::Status::CLIENT_ERROR_NOT_FOUND);
-    }
 
-    // adapt the storage engine so that that get and sets are sandboxed for the contract
-    StateAdapter storage_adapter{storage_, contract_name};
+    case ContractQueryExecutor::Status::BUSY:
+      response            = Variant::Object();
+      response["status"]  = "failed";
+      response["msg"]     = "Too many concurrent queries for contract: " +
+                        static_cast<std::string>(contract_name);
+      response["console"] = "";
+      response["result"]  = variant::Variant::Null();
 
-    // Current block index does not apply to queries - set to 0
-    Contract::Status status;
-    {
-      chain::Address address;
-      if (contract_name != "fetch.token" && !chain::Address::Parse(contract_name, address))
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "Failed to parse address: ", contract_name);
-      }
-      ContractContext context{&token_contract_, std::move(address), nullptr, &storage_adapter, 0};
-      ContractContextAttacher raii(*contract, context);
-      status = contract->DispatchQuery(query, doc.root(), response);
-    }
+      return http::CreateJsonResponse(response, http::Status::SERVER_ERROR_SERVICE_UNAVAILABLE);
 
-    if (Contract::Status::OK == status)
-    {
-      return http::CreateJsonResponse(response);
+    case ContractQueryExecutor::Status::FAILED:
+      break;
     }
-
-    FETCH_LOG_WARN(LOGGING_NAME, "Error running query. status = ", static_cast<int>(status));
   }
   catch (std::exception const &ex)
   {
@@ -296,6 +326,7 @@ http::HTTPResponse ContractHttpInterface::OnTransaction(http::HTTPRequest const
                                                         ConstByteArray const &   expected_contract)
 {
   Variant json = Variant::Object();
+  bool    overloaded{false};
 
   try
   {
@@ -323,6 +354,11 @@ http::HTTPResponse ContractHttpInterface::OnTransaction(http::HTTPRequest const
       submitted      = SubmitBulkTx(request, txs);
       unknown_format = false;
     }
+    else if (content_type == "application/vnd.fetch-ai.transaction+stream")
+    {
+      submitted      = SubmitStreamTx(request, txs);
+      unknown_format = false;
+    }
 
     // record the transaction in the access log
     RecordTransaction(submitted, request, expected_contract);
@@ -341,6 +377,12 @@ http::HTTPResponse ContractHttpInterface::OnTransaction(http::HTTPRequest const
     {
       json["error"] = "Unknown content type: " + Quoted(content_type);
     }
+    else if (submitted.shed > 0)
+    {
+      json["counts"]["shed"] = submitted.shed;
+      json["error"]          = "Node is overloaded, retry the refused transactions later.";
+      overloaded             = true;
+    }
     else if (submitted.processed != submitted.received)
     {
       json["error"] =
@@ -354,10 +396,23 @@ http::HTTPResponse ContractHttpInterface::OnTransaction(http::HTTPRequest const
   }
 
   // based on the contents of the response determine the correct status code
-  http::Status const status_code =
+  http::Status status_code =
       json.Has("error") ? http::Status::CLIENT_ERROR_BAD_REQUEST : http::Status::SUCCESS_OK;
 
-  return http::CreateJsonResponse(json, status_code);
+  if (overloaded)
+  {
+    status_code = http::Status::CLIENT_ERROR_TOO_MANY_REQUESTS;
+  }
+
+  auto response = http::CreateJsonResponse(json, status_code);
+
+  // tell the client when it is worth submitting the refused transactions again
+  if (overloaded)
+  {
+    response.AddHeader("retry-after", std::to_string(admission_->GetRetryAfter().count()));
+  }
+
+  return response;
 }
 
 /**
@@ -381,6 +436,7 @@ ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitJsonTx(
 {
   std::size_t submitted{0};
   std::size_t expected_count{0};
+  std::size_t shed{0};
 
   // parse the JSON request
   json::JSONDocument doc{request.body()};
@@ -393,34 +449,27 @@ ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitJsonTx(
     expected_count = doc.root().size();
     for (std::size_t i = 0, end = doc.root().size(); i < end; ++i)
     {
-      auto const success = CreateTxFromJson(doc[i], txs, processor_);
-      if (success)
-      {
-        ++submitted;
-      }
+      Tally(CreateTxFromJson(doc[i], txs, processor_, admission_), submitted, shed);
     }
   }
   else
   {
     expected_count = 1;
 
-    auto const success = CreateTxFromJson(doc.root(), txs, processor_);
-    if (success)
-    {
-      ++submitted;
-    }
+    Tally(CreateTxFromJson(doc.root(), txs, processor_, admission_), submitted, shed);
   }
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Submitted ", submitted, " transactions from ",
                   request.originating_address(), ':', request.originating_port());
 
-  return SubmitTxStatus{submitted, expected_count};
+  return SubmitTxStatus{submitted, expected_count, shed};
 }
 
 ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitBulkTx(
     http::HTTPRequest const &request, TxHashes &txs)
 {
   std::size_t                 submitted{0};
+  std::size_t                 shed{0};
   std::vector<ConstByteArray> encoded_txs{};
 
   try
@@ -431,11 +480,7 @@ ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitBulkTx(
 
     for (auto const &encoded_tx : encoded_txs)
     {
-      auto const success = CreateTxFromBuffer(encoded_tx, txs, processor_);
-      if (success)
-      {
-        ++submitted;
-      }
+      Tally(CreateTxFromBuffer(encoded_tx, txs, processor_, admission_), submitted, shed);
     }
   }
   catch (std::exception const &e)
@@ -443,7 +488,53 @@ ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitBulkTx(
     FETCH_LOG_ERROR(LOGGING_NAME, "Error processing bulk tx: ", e.what());
   }
 
-  return SubmitTxStatus{submitted, encoded_txs.size()};
+  return SubmitTxStatus{submitted, encoded_txs.size(), shed};
+}
+
+/**
+ * Method handles incoming http requests containing a stream of length prefixed binary
+ * transactions (see TransactionStreamReader)
+ *
+ * Each transaction is decoded in place from the request body and handed directly to the
+ * transaction verifier, without building up an intermediate container of the whole submission.
+ * Verification is performed in batches by the verifier threads.
+ *
+ * @param request http request containing the stream of transactions
+ * @param txs The output digests of the submitted transactions
+ * @return submit status, please see the `SubmitTxStatus` structure
+ */
+ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitStreamTx(
+    http::HTTPRequest const &request, TxHashes &txs)
+{
+  SubmitTxStatus status{};
+
+  TransactionStreamReader reader{request.body()};
+
+  ConstByteArray encoded_tx{};
+  while (reader.Next(encoded_tx))
+  {
+    ++status.received;
+
+    try
+    {
+      Tally(CreateTxFromBuffer(encoded_tx, txs, processor_, admission_), status.processed,
+            status.shed);
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Error decoding streamed tx: ", e.what());
+    }
+  }
+
+  // a partial transaction at the end of the stream can not be processed
+  if (reader.is_truncated())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Truncated transaction stream from ",
+                   request.originating_address(), ':', request.originating_port());
+    ++status.received;
+  }
+
+  return status;
 }
 
 /**
@@ -462,6 +553,7 @@ void ContractHttpInterface::RecordTransaction(SubmitTxStatus const &   status,
   entry["type"]      = "transaction";
   entry["received"]  = status.received;
   entry["processed"] = status.processed;
+  entry["shed"]      = status.shed;
   entry["ip"]        = request.originating_address();
   entry["port"]      = request.originating_port();
 
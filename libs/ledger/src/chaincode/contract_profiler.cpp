@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chaincode/contract_profiler.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Get the process wide contract profiler
+ *
+ * @return The profiler instance
+ */
+ContractProfiler &ContractProfiler::Instance()
+{
+  static ContractProfiler instance{};
+  return instance;
+}
+
+/**
+ * Enable or disable the profiling of smart contract invocations
+ *
+ * @param enable Flag to signal that invocations should be profiled
+ */
+void ContractProfiler::Enable(bool enable)
+{
+  enabled_ = enable;
+}
+
+bool ContractProfiler::IsEnabled() const
+{
+  return enabled_;
+}
+
+/**
+ * Discard all of the accumulated profiles. The exported telemetry counters are retained.
+ */
+void ContractProfiler::Clear()
+{
+  FETCH_LOCK(lock_);
+  profiles_.clear();
+}
+
+/**
+ * Merge the profile of a single invocation into the profile for the contract
+ *
+ * @param digest The digest of the contract
+ * @param profile The profile of the invocation
+ */
+void ContractProfiler::Record(ConstByteArray const &digest, Profiler const &profile)
+{
+  FETCH_LOCK(lock_);
+
+  profiles_[digest].Merge(profile);
+
+  for (auto const &opcode : profile.opcodes())
+  {
+    auto &counters = LookupCounters(digest, opcode.first);
+    counters.count->add(opcode.second.count);
+    counters.charge->add(opcode.second.charge);
+    counters.duration->add(opcode.second.duration);
+  }
+}
+
+/**
+ * Look up the accumulated profile for a contract
+ *
+ * @param digest The digest of the contract
+ * @return The profile of the contract, which is empty if it has not been executed
+ */
+ContractProfiler::Profiler ContractProfiler::Lookup(ConstByteArray const &digest) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = profiles_.find(digest);
+  if (it == profiles_.end())
+  {
+    return Profiler{};
+  }
+
+  return it->second;
+}
+
+/**
+ * Write out the sampled call stacks of all the contracts in the folded stacks format. The
+ * outermost frame of each stack is the (hex encoded) digest of the contract.
+ *
+ * @param stream The output stream
+ */
+void ContractProfiler::WriteFoldedStacks(std::ostream &stream) const
+{
+  FETCH_LOCK(lock_);
+
+  for (auto const &profile : profiles_)
+  {
+    profile.second.WriteFoldedStacks(stream, static_cast<std::string>(profile.first.ToHex()));
+  }
+}
+
+/**
+ * Internal: Look up (or create) the telemetry counters for an opcode of a contract
+ *
+ * @param digest The digest of the contract
+ * @param opcode The unique name of the opcode
+ * @return The counters
+ */
+ContractProfiler::OpcodeCounters &ContractProfiler::LookupCounters(ConstByteArray const &digest,
+                                                                   std::string const &   opcode)
+{
+  CounterKey key{digest, opcode};
+
+  auto it = counters_.find(key);
+  if (it == counters_.end())
+  {
+    auto &registry = telemetry::Registry::Instance();
+
+    telemetry::Registry::Labels const labels{
+        {"contract", static_cast<std::string>(digest.ToHex())}, {"opcode", opcode}};
+
+    OpcodeCounters counters{};
+    counters.count = registry.CreateCounter("ledger_contract_opcode_executions_total",
+                                            "The number of times an opcode was executed", labels);
+    counters.charge = registry.CreateCounter(
+        "ledger_contract_opcode_charge_total", "The total charge incurred by an opcode", labels);
+    counters.duration = registry.CreateCounter("ledger_contract_opcode_duration_ns_total",
+                                               "The total execution time of an opcode", labels);
+
+    it = counters_.emplace(std::move(key), std::move(counters)).first;
+  }
+
+  return it->second;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "ledger/chaincode/chain_code_cache.hpp"
+#include "ledger/chaincode/contract.hpp"
+#include "ledger/chaincode/contract_context.hpp"
+#include "ledger/chaincode/contract_context_attacher.hpp"
+#include "ledger/chaincode/contract_query_executor.hpp"
+#include "ledger/chaincode/smart_contract.hpp"
+#include "ledger/state_adapter.hpp"
+#include "logging/logging.hpp"
+#include "variant/variant.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "ContractQueryExecutor";
+
+}  // namespace
+
+constexpr std::size_t ContractQueryExecutor::DEFAULT_MAX_CONCURRENT_QUERIES;
+constexpr std::size_t ContractQueryExecutor::DEFAULT_MAX_CONTRACTS;
+
+/**
+ * The default configuration, each query can be charged as much as the largest transaction
+ *
+ * @return The configuration
+ */
+ContractQueryExecutor::Config ContractQueryExecutor::DefaultConfig()
+{
+  return {DEFAULT_MAX_CONCURRENT_QUERIES, DEFAULT_MAX_CONTRACTS,
+          chain::Transaction::MAXIMUM_TX_CHARGE_LIMIT, {}};
+}
+
+/**
+ * Construct the query executor
+ *
+ * @param storage The storage engine from which the contracts and their state are read
+ * @param config The limits of the executor
+ */
+ContractQueryExecutor::ContractQueryExecutor(StorageInterface &storage, Config const &config)
+  : storage_{storage}
+  , config_{config}
+  , token_contract_{config.sharded_balances}
+{}
+
+/**
+ * Evaluate a query of a contract, this can be called from multiple threads
+ *
+ * @param contract_name The name of the contract
+ * @param query The name of the query
+ * @param request The parameters of the query
+ * @param response The response to be populated
+ * @return OK if the query was successful, otherwise the reason it was not
+ */
+ContractQueryExecutor::Status ContractQueryExecutor::Execute(ConstByteArray const &contract_name,
+                                                             ConstByteArray const &query,
+                                                             Query const &request, Query &response)
+{
+  bool busy{false};
+
+  auto contract = Acquire(contract_name, busy);
+  if (!contract)
+  {
+    return busy ? Status::BUSY : Status::NOT_FOUND;
+  }
+
+  chain::Address address;
+  if (contract_name != "fetch.token" && !chain::Address::Parse(contract_name, address))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to parse address: ", contract_name);
+  }
+
+  // the gets are sandboxed for the contract, and are served from the last committed state
+  // (independently of block execution)
+  CommittedStateAdapter storage_adapter{storage_, contract_name};
+
+  Contract::Status status{Contract::Status::FAILED};
+  try
+  {
+    // Current block index does not apply to queries - set to 0
+    ContractContext context{&token_contract_, std::move(address), nullptr, &storage_adapter, 0};
+    ContractContextAttacher raii(*contract, context);
+    status = contract->DispatchQuery(query, request, response);
+  }
+  catch (...)
+  {
+    // the instance is not reused, since the query has been abandoned part way through
+    Release(contract_name, nullptr);
+    throw;
+  }
+
+  Release(contract_name, std::move(contract));
+
+  if (Contract::Status::OK != status)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Error running query. status = ", static_cast<int>(status));
+    return Status::FAILED;
+  }
+
+  return Status::OK;
+}
+
+/**
+ * Get the number of instances of a contract which are ready for the next query
+ *
+ * @param contract_name The name of the contract
+ * @return The number of instances
+ */
+std::size_t ContractQueryExecutor::num_idle(ConstByteArray const &contract_name) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = instances_.find(contract_name);
+  return (it == instances_.end()) ? 0 : it->second.idle.size();
+}
+
+/**
+ * Acquire an instance of a contract for a query, reusing an idle one where possible
+ *
+ * @param contract_name The name of the contract
+ * @param busy Set when the contract is already evaluating its maximum number of queries
+ * @return The contract instance, or nullptr when it is busy or can not be found
+ */
+ContractQueryExecutor::ContractPtr ContractQueryExecutor::Acquire(
+    ConstByteArray const &contract_name, bool &busy)
+{
+  ContractPtr contract{};
+
+  {
+    FETCH_LOCK(lock_);
+
+    auto &instances    = instances_[contract_name];
+    instances.last_use = ++counter_;
+
+    busy = (config_.max_concurrent_queries != 0) &&
+           (instances.active >= config_.max_concurrent_queries);
+    if (busy)
+    {
+      return nullptr;
+    }
+
+    ++instances.active;
+
+    if (!instances.idle.empty())
+    {
+      contract = std::move(instances.idle.back());
+      instances.idle.pop_back();
+    }
+  }
+
+  if (!contract)
+  {
+    // loading the contract is slow, so it is done without holding the lock
+    try
+    {
+      if (contract_name == TokenContract::NAME)
+      {
+        // balance queries must include the sub-balances of sharded accounts
+        contract = std::make_shared<TokenContract>(config_.sharded_balances);
+      }
+      else
+      {
+        contract = ChainCodeCache::CreateContract(contract_name, storage_, false);
+      }
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to load contract: ", contract_name, " ", ex.what());
+    }
+
+    auto smart_contract = std::dynamic_pointer_cast<SmartContract>(contract);
+    if (smart_contract)
+    {
+      smart_contract->SetQueryChargeLimit(config_.charge_limit);
+    }
+
+    if (!contract)
+    {
+      Release(contract_name, nullptr);
+    }
+  }
+
+  return contract;
+}
+
+/**
+ * Return the instance of a contract once its query has finished
+ *
+ * @param contract_name The name of the contract
+ * @param contract The instance to be reused, or nullptr if it should not be
+ */
+void ContractQueryExecutor::Release(ConstByteArray const &contract_name, ContractPtr contract)
+{
+  FETCH_LOCK(lock_);
+
+  auto &instances = instances_[contract_name];
+  --instances.active;
+
+  if (contract)
+  {
+    instances.idle.emplace_back(std::move(contract));
+  }
+
+  // forget the least recently used contracts which are not in use, beyond the limit
+  while (instances_.size() > config_.max_contracts)
+  {
+    auto oldest = instances_.end();
+    for (auto it = instances_.begin(); it != instances_.end(); ++it)
+    {
+      if ((it->second.active == 0) &&
+          ((oldest == instances_.end()) || (it->second.last_use < oldest->second.last_use)))
+      {
+        oldest = it;
+      }
+    }
+
+    if (oldest == instances_.end())
+    {
+      break;
+    }
+
+    instances_.erase(oldest);
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,241 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/sha256.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
+#include "logging/logging.hpp"
+#include "vm/executable_serializers.hpp"
+#include "vm/generator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "ExecutableCache";
+
+}  // namespace
+
+constexpr std::size_t ExecutableCache::DEFAULT_MAX_ENTRIES;
+
+/**
+ * Get the process wide executable cache
+ *
+ * @return The cache instance
+ */
+ExecutableCache &ExecutableCache::Instance()
+{
+  static ExecutableCache instance{};
+  return instance;
+}
+
+/**
+ * Construct the executable cache
+ *
+ * @param max_entries The maximum number of executables which are held
+ */
+ExecutableCache::ExecutableCache(std::size_t max_entries)
+  : max_entries_{std::max<std::size_t>(max_entries, 1)}
+{}
+
+ExecutableCache::~ExecutableCache() = default;
+
+/**
+ * Look up a previously compiled executable
+ *
+ * @param digest The digest of the contract source
+ * @param optimised Flag to signal if the optimised executable is required
+ * @return The executable if present, otherwise an empty pointer
+ */
+ExecutableCache::ExecutablePtr ExecutableCache::Lookup(ConstByteArray const &digest,
+                                                       bool                  optimised)
+{
+  FETCH_LOCK(lock_);
+
+  auto it = entries_.find(Key{digest, optimised});
+  if (it == entries_.end())
+  {
+    return {};
+  }
+
+  // mark the entry as the most recently used
+  order_.splice(order_.begin(), order_, it->second.position);
+
+  return it->second.executable;
+}
+
+/**
+ * Add a newly compiled executable to the cache, evicting the least recently used entry if the
+ * cache is full
+ *
+ * @param digest The digest of the contract source
+ * @param optimised Flag to signal if the executable has been optimised
+ * @param executable The compiled executable
+ */
+void ExecutableCache::Insert(ConstByteArray const &digest, bool optimised,
+                             ExecutablePtr executable)
+{
+  if (!executable)
+  {
+    return;
+  }
+
+  FETCH_LOCK(lock_);
+
+  Key key{digest, optimised};
+
+  auto it = entries_.find(key);
+  if (it != entries_.end())
+  {
+    // another thread compiled the same contract at the same time, either result is fine
+    order_.splice(order_.begin(), order_, it->second.position);
+    return;
+  }
+
+  if (entries_.size() >= max_entries_)
+  {
+    entries_.erase(order_.back());
+    order_.pop_back();
+  }
+
+  order_.push_front(key);
+  entries_.emplace(std::move(key), Entry{std::move(executable), order_.begin()});
+}
+
+void ExecutableCache::Clear()
+{
+  FETCH_LOCK(lock_);
+
+  entries_.clear();
+  order_.clear();
+}
+
+std::size_t ExecutableCache::size() const
+{
+  FETCH_LOCK(lock_);
+  return entries_.size();
+}
+
+/**
+ * Back the cache with a persistent store of executables, the files are created if they do not
+ * already exist
+ *
+ * @param doc_file The path to the document file of the store
+ * @param index_file The path to the index file of the store
+ */
+void ExecutableCache::Load(std::string const &doc_file, std::string const &index_file)
+{
+  auto store = std::make_shared<Store>();
+  store->Load(doc_file, index_file, true);
+
+  FETCH_LOCK(lock_);
+  store_ = std::move(store);
+}
+
+bool ExecutableCache::IsPersistent() const
+{
+  return static_cast<bool>(GetStore());
+}
+
+/**
+ * Restore a previously persisted executable, which is also added to the cache
+ *
+ * @param digest The digest of the contract source
+ * @param optimised Flag to signal if the optimised executable is required
+ * @param layout The layout signature of the VM which will execute the executable
+ * @return The executable if present, otherwise an empty pointer
+ */
+ExecutableCache::ExecutablePtr ExecutableCache::Restore(ConstByteArray const &digest,
+                                                        bool optimised, std::string const &layout)
+{
+  auto store = GetStore();
+  if (!store)
+  {
+    return {};
+  }
+
+  auto executable = std::make_shared<Executable>();
+
+  try
+  {
+    if (!store->Get(StoreKey(digest, optimised, layout), *executable))
+    {
+      return {};
+    }
+  }
+  catch (std::exception const &ex)
+  {
+    // the contract will simply be compiled again
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to restore executable for 0x", digest.ToHex(), ": ",
+                   ex.what());
+    return {};
+  }
+
+  Insert(digest, optimised, executable);
+
+  return executable;
+}
+
+/**
+ * Write a newly compiled executable to the persistent store (if there is one)
+ *
+ * @param digest The digest of the contract source
+ * @param optimised Flag to signal if the executable has been optimised
+ * @param layout The layout signature of the VM which generated the executable
+ * @param executable The compiled executable
+ */
+void ExecutableCache::Persist(ConstByteArray const &digest, bool optimised,
+                              std::string const &layout, ExecutablePtr const &executable)
+{
+  auto store = GetStore();
+  if (!store || !executable)
+  {
+    return;
+  }
+
+  store->Set(StoreKey(digest, optimised, layout), *executable);
+}
+
+/**
+ * Internal: Build the key of an executable in the persistent store
+ */
+storage::ResourceID ExecutableCache::StoreKey(ConstByteArray const &digest, bool optimised,
+                                              std::string const &layout)
+{
+  uint8_t const flag = optimised ? 1u : 0u;
+
+  crypto::SHA256 hasher{};
+  hasher.Update(digest);
+  hasher.Update(&flag, sizeof(flag));
+  hasher.Update(layout);
+
+  return storage::ResourceID{hasher.Final()};
+}
+
+ExecutableCache::StorePtr ExecutableCache::GetStore() const
+{
+  FETCH_LOCK(lock_);
+  return store_;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/block_version.hpp"
 #include "chain/transaction.hpp"
 #include "core/byte_array/decoders.hpp"
 #include "core/byte_array/encoders.hpp"
@@ -24,6 +25,8 @@
 #include "crypto/sha256.hpp"
 #include "ledger/chaincode/contract.hpp"
 #include "ledger/chaincode/contract_context.hpp"
+#include "ledger/chaincode/contract_profiler.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
 #include "ledger/chaincode/smart_contract.hpp"
 #include "ledger/chaincode/smart_contract_exception.hpp"
 #include "ledger/chaincode/smart_contract_factory.hpp"
@@ -37,6 +40,7 @@
 #include "vm/address.hpp"
 #include "vm/function_decorators.hpp"
 #include "vm/module.hpp"
+#include "vm/profiler.hpp"
 #include "vm/string.hpp"
 #include "vm_modules/ledger/balance.hpp"
 #include "vm_modules/ledger/transfer_function.hpp"
@@ -93,6 +97,70 @@ void ValidateAddressesInParams(chain::Transaction const &tx, vm::ParameterPack c
   }
 }
 
+/**
+ * Prefetch the state keys which are statically known to be accessed by a function, so that they
+ * are retrieved from storage in a single batch rather than one at a time during execution
+ *
+ * @param: state the IO observer for the contract
+ * @param: function the function about to be executed
+ */
+void PrefetchState(vm::IoObserverInterface &state, vm::Executable::Function const &function)
+{
+  if (!function.state_keys.empty())
+  {
+    state.ReadBatch(function.state_keys);
+  }
+}
+
+/**
+ * Attaches a profiler to a VM for the duration of a contract invocation when contract profiling
+ * has been enabled, the profile is recorded against the contract when the scope is exited
+ */
+class InvocationProfile
+{
+public:
+  InvocationProfile(vm::VM &vm, ConstByteArray digest)
+    : vm_{vm}
+    , digest_{std::move(digest)}
+    , enabled_{ContractProfiler::Instance().IsEnabled()}
+  {
+    if (enabled_)
+    {
+      vm_.SetProfiler(&profiler_);
+    }
+  }
+
+  InvocationProfile(InvocationProfile const &) = delete;
+  InvocationProfile(InvocationProfile &&)      = delete;
+
+  ~InvocationProfile()
+  {
+    if (enabled_)
+    {
+      vm_.SetProfiler(nullptr);
+      ContractProfiler::Instance().Record(digest_, profiler_);
+    }
+  }
+
+  InvocationProfile &operator=(InvocationProfile const &) = delete;
+  InvocationProfile &operator=(InvocationProfile &&) = delete;
+
+private:
+  vm::VM &             vm_;
+  ConstByteArray const digest_;
+  bool const           enabled_;
+  vm::Profiler         profiler_{};
+};
+
+/**
+ * Determine whether a block must be executed with the UInt256 arithmetic of the initial block
+ * version, since it comes before the exact arithmetic was activated
+ */
+bool IsLegacyArithmetic(uint64_t block_index)
+{
+  return !chain::IsActive(chain::BlockVersion::EXACT_UINT256_ARITHMETIC, block_index);
+}
+
 constexpr char const *LOGGING_NAME = "SmartContract";
 
 }  // namespace
@@ -101,12 +169,15 @@ constexpr char const *LOGGING_NAME = "SmartContract";
  * Construct a smart contract from the specified source
  *
  * @param source Reference to the executable text
+ * @param optimise Flag to signal that the bytecode optimisation pass should be run. This reduces
+ * the charges for executing the contract, so it can only be enabled network wide.
  */
-SmartContract::SmartContract(std::string const &source)
+SmartContract::SmartContract(std::string const &source, bool optimise)
   : source_{source}
   , digest_{fetch::crypto::Hash<fetch::crypto::SHA256>(ConstByteArray(source))}
-  , executable_{std::make_shared<Executable>()}
   , module_{VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS)}
+  , vm_pool_{module_.get()}
+  , optimise_{optimise}
 {
   if (source_.empty())
   {
@@ -122,14 +193,38 @@ SmartContract::SmartContract(std::string const &source)
   module_->CreateFreeFunction(
       "getContext", [this](vm::VM *) -> vm_modules::ledger::ContextPtr { return context_; });
 
-  // create and compile the executable
-  fetch::vm::SourceFiles files  = {{"default.etch", source}};
-  auto                   errors = vm_modules::VMFactory::Compile(module_, files, *executable_);
+  // every contract module is built identically, so a previously compiled executable for the same
+  // source can be shared rather than compiling it again
+  auto &executable_cache = ExecutableCache::Instance();
+
+  executable_ = executable_cache.Lookup(digest_, optimise_);
+
+  // executables which have been persisted are only valid for an identical VM layout
+  std::string layout{};
+  if (!executable_ && executable_cache.IsPersistent())
+  {
+    layout      = vm::VM{module_.get()}.LayoutSignature();
+    executable_ = executable_cache.Restore(digest_, optimise_, layout);
+  }
 
-  // if there are any compilation errors
-  if (!errors.empty())
+  if (!executable_)
   {
-    throw SmartContractException(SmartContractException::Category::COMPILATION, std::move(errors));
+    // create and compile the executable
+    executable_ = std::make_shared<Executable>();
+
+    fetch::vm::SourceFiles files  = {{"default.etch", source}};
+    auto                   errors = vm_modules::VMFactory::Compile(module_, files, *executable_,
+                                                                   optimise_);
+
+    // if there are any compilation errors
+    if (!errors.empty())
+    {
+      throw SmartContractException(SmartContractException::Category::COMPILATION,
+                                   std::move(errors));
+    }
+
+    executable_cache.Insert(digest_, optimise_, executable_);
+    executable_cache.Persist(digest_, optimise_, layout, executable_);
   }
 
   // since we now have a fully compiled executable we can evaluate the functions and assign the
@@ -490,7 +585,7 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
   }
 
   // Get clean VM instance
-  auto vm = std::make_unique<vm::VM>(module_.get());
+  auto vm = vm_pool_.Acquire();
 
   context_ = vm_modules::ledger::Context::Factory(vm.get(), tx, context().block_index);
 
@@ -501,6 +596,7 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
   std::stringstream console;
   vm->AttachOutputDevice(vm::VM::STDOUT, console);
   vm->SetIOObserver(state());
+  vm->SetLegacyArithmetic(IsLegacyArithmetic(context().block_index));
 
   std::unordered_set<chain::Address> call_history{tx.contract_address()};
   vm::ContractInvocationHandler      contract_invocation_handler;
@@ -548,7 +644,8 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
     decltype(auto) c = context();
 
     // TODO(LDGR-642) charge for reading from storage
-    auto loaded_contract = CreateSmartContract<SmartContract>(called_contract_address, *c.storage);
+    auto loaded_contract =
+        CreateSmartContract<SmartContract>(called_contract_address, *c.storage, optimise_);
     if (loaded_contract == nullptr)
     {
       error = "Failed to load contract " +
@@ -575,6 +672,7 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
     std::vector<std::string> errors{};
 
     vm2.SetIOObserver(vm->GetIOObserver());
+    vm2.SetLegacyArithmetic(vm->IsLegacyArithmetic());
     vm2.SetContractInvocationHandler(contract_invocation_handler);
     vm2.AttachOutputDevice(fetch::vm::VM::STDOUT, vm->GetOutputDevice(fetch::vm::VM::STDOUT));
 
@@ -590,6 +688,8 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
     ContractContextAttacher raii{*loaded_contract, ctx};
     c.state_adapter->PushContext(identity);
 
+    InvocationProfile profile{vm2, loaded_contract->contract_digest()};
+
     bool const success =
         vm2.Execute(*loaded_contract->executable(), function.name, error, output, param_pack);
     if (!success)
@@ -644,10 +744,13 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Running smart contract target: ", name);
 
+  PrefetchState(state(), *target_function);
+
   // Execute the requested function
   std::string        error;
   fetch::vm::Variant output;
   auto               status{Status::OK};
+  InvocationProfile  profile{*vm, digest_};
 
   if (!vm->Execute(*executable_, name, error, output, params))
   {
@@ -674,7 +777,7 @@ Contract::Result SmartContract::InvokeInit(chain::Address const &    owner,
                                            chain::Transaction const &tx)
 {
   // Get clean VM instance
-  auto vm = std::make_unique<vm::VM>(module_.get());
+  auto vm = vm_pool_.Acquire();
 
   auto const block_index = context().block_index;
 
@@ -685,6 +788,7 @@ Contract::Result SmartContract::InvokeInit(chain::Address const &    owner,
   // vm->UpdateCharges({});
 
   vm->SetIOObserver(state());
+  vm->SetLegacyArithmetic(IsLegacyArithmetic(block_index));
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Running SC init function: ", init_fn_name_);
 
@@ -714,6 +818,9 @@ Contract::Result SmartContract::InvokeInit(chain::Address const &    owner,
 
   vm->AttachOutputDevice(vm::VM::STDOUT, console);
 
+  PrefetchState(state(), *target_function);
+
+  InvocationProfile profile{*vm, digest_};
   if (!vm->Execute(*executable_, init_fn_name_, error, output, params))
   {
     FETCH_LOG_WARN(LOGGING_NAME, "Runtime error: ", error);
@@ -736,12 +843,25 @@ Contract::Result SmartContract::InvokeInit(chain::Address const &    owner,
  * @param request The query request
  * @return The corresponding status result for the operation
  */
+/**
+ * Limit the charge of the queries of the contract, so that a single query can not occupy the
+ * caller indefinitely
+ *
+ * @param limit The charge limit of each query, or 0 for no limit
+ */
+void SmartContract::SetQueryChargeLimit(vm::ChargeAmount limit)
+{
+  query_charge_limit_ = limit;
+}
+
 SmartContract::Status SmartContract::InvokeQuery(std::string const &name, Query const &request,
                                                  Query &response)
 {
   // get clean VM instance
-  auto vm = std::make_unique<vm::VM>(module_.get());
+  auto vm = vm_pool_.Acquire();
   vm->SetIOObserver(state());
+  vm->SetChargeLimit(query_charge_limit_);
+  vm->SetLegacyArithmetic(IsLegacyArithmetic(context().block_index));
 
   // look up the executable
   auto const target_function = executable_->FindFunction(name);
@@ -797,6 +917,9 @@ SmartContract::Status SmartContract::InvokeQuery(std::string const &name, Query
 
   vm->AttachOutputDevice(vm::VM::STDOUT, console);
 
+  PrefetchState(state(), *target_function);
+
+  InvocationProfile profile{*vm, digest_};
   if (!vm->Execute(*executable_, name, error, output, params))
   {
     FETCH_LOG_WARN(LOGGING_NAME, "Query failed during execution: ", error);
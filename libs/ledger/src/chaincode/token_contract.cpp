@@ -31,6 +31,7 @@
 
 #include <memory>
 #include <sstream>
+#include <utility>
 #include <unordered_map>
 
 namespace fetch {
@@ -82,6 +83,18 @@ constexpr uint64_t MAX_TOKENS = 0xFFFFFFFFFFFFFFFFull;
 }  // namespace
 
 TokenContract::TokenContract()
+  : TokenContract(std::make_shared<ShardedBalances>())
+{}
+
+/**
+ * Construct the token contract for a network where the balances of some accounts are sharded over
+ * the lanes
+ *
+ * @param sharded_balances The accounts with sharded balances
+ */
+TokenContract::TokenContract(ShardedBalancesPtr sharded_balances)
+  : sharded_balances_{sharded_balances ? std::move(sharded_balances)
+                                       : std::make_shared<ShardedBalances>()}
 {
   OnTransaction("deed", this, &TokenContract::UpdateDeed);
   OnTransaction("transfer", this, &TokenContract::Transfer);
@@ -94,6 +107,11 @@ TokenContract::TokenContract()
   OnQuery("cooldownStake", this, &TokenContract::CooldownStake);
 }
 
+TokenContract::ShardedBalances const &TokenContract::sharded_balances() const
+{
+  return *sharded_balances_;
+}
+
 DeedPtr TokenContract::GetDeed(chain::Address const &address)
 {
   DeedPtr deed{};
@@ -125,13 +143,19 @@ uint64_t TokenContract::GetBalance(chain::Address const &address)
   WalletRecord record{};
   GetStateRecord(record, address);
 
-  return record.balance;
+  return record.balance + FoldBalanceShards(address, false);
 }
 
 bool TokenContract::AddTokens(chain::Address const &address, uint64_t amount)
 {
+  auto const key = CreditKey(address);
+  if (key.empty())
+  {
+    return false;
+  }
+
   WalletRecord record{};
-  GetStateRecord(record, address);
+  GetStateRecord(record, key);
 
   if (amount > (MAX_TOKENS - record.balance))
   {
@@ -140,7 +164,7 @@ bool TokenContract::AddTokens(chain::Address const &address, uint64_t amount)
 
   record.balance += amount;
 
-  auto const status = SetStateRecord(record, address);
+  auto const status = SetStateRecord(record, key);
 
   return status == StateAdapter::Status::OK;
 }
@@ -150,11 +174,20 @@ bool TokenContract::SubtractTokens(chain::Address const &address, uint64_t amoun
   WalletRecord record{};
   GetStateRecord(record, address);
 
-  if (amount > record.balance)
+  uint64_t const sub_balances = FoldBalanceShards(address, false);
+
+  if (amount > (record.balance + sub_balances))
   {
     return false;
   }
 
+  // sub-balances are only folded back into the main balance when it is spent from
+  if (sub_balances != 0)
+  {
+    FoldBalanceShards(address, true);
+    record.balance += sub_balances;
+  }
+
   record.balance -= amount;
 
   auto const status = SetStateRecord(record, address);
@@ -396,13 +429,9 @@ Contract::Status TokenContract::Balance(Query const &query, Query &response)
     chain::Address address{};
     if (chain::Address::Parse(input, address))
     {
-      // look up the record
-      WalletRecord record{};
-      GetStateRecord(record, address);
-
       // formulate the response
       response            = Variant::Object();
-      response["balance"] = ConvertToString(record.balance);
+      response["balance"] = ConvertToString(GetBalance(address));
 
       return Status::OK;
     }
@@ -504,6 +533,75 @@ Contract::Status TokenContract::CooldownStake(Query const &query, Query &respons
   return Status::FAILED;
 }
 
+/**
+ * The key of the record to credit for an address. Sharded balances are credited on the first lane
+ * available to the transaction, when the lane of the main balance is not.
+ *
+ * @param address The address to be credited
+ * @return The key of the record, empty when no record is accessible
+ */
+TokenContract::ConstByteArray TokenContract::CreditKey(chain::Address const &address)
+{
+  ConstByteArray const key{address.display()};
+
+  if (!sharded_balances_->Contains(address) ||
+      state().IsAllowedResource(static_cast<std::string>(key)))
+  {
+    return key;
+  }
+
+  uint32_t const num_lanes = 1u << sharded_balances_->log2_num_lanes();
+  for (uint32_t lane = 0; lane < num_lanes; ++lane)
+  {
+    auto const shard_key = sharded_balances_->GetShardKey(address, lane);
+    if (state().IsAllowedResource(static_cast<std::string>(shard_key)))
+    {
+      return shard_key;
+    }
+  }
+
+  return {};
+}
+
+/**
+ * Sum the sub-balances of an address, for those on lanes available to the transaction
+ *
+ * @param address The address
+ * @param clear Whether the sub-balances should also be emptied
+ * @return The sum of the sub-balances
+ */
+uint64_t TokenContract::FoldBalanceShards(chain::Address const &address, bool clear)
+{
+  if (!sharded_balances_->Contains(address))
+  {
+    return 0;
+  }
+
+  uint64_t total{0};
+
+  uint32_t const num_lanes = 1u << sharded_balances_->log2_num_lanes();
+  for (uint32_t lane = 0; lane < num_lanes; ++lane)
+  {
+    auto const shard_key = sharded_balances_->GetShardKey(address, lane);
+
+    WalletRecord shard{};
+    if (!state().IsAllowedResource(static_cast<std::string>(shard_key)) ||
+        !GetStateRecord(shard, shard_key) || (shard.balance == 0))
+    {
+      continue;
+    }
+
+    total += shard.balance;
+
+    if (clear)
+    {
+      SetStateRecord(WalletRecord{}, shard_key);
+    }
+  }
+
+  return total;
+}
+
 void TokenContract::ClearStakeUpdates()
 {
   stake_updates_.clear();
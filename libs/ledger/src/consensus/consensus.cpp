@@ -277,6 +277,32 @@ bool Consensus::VerifyNotarisation(Block const &block) const
   return true;
 }
 
+void Consensus::VerifyNotarisations(std::vector<Block const *> const &blocks) const
+{
+  if (!notarisation_)
+  {
+    return;
+  }
+
+  MilliTimer const timer{"VerifyNotarisations ", 1000};
+
+  // The notarisation in the body of each block is of the block preceding it
+  std::vector<NotarisationService::BlockNotarisation> notarisations;
+  for (auto const *block : blocks)
+  {
+    if (block->block_number > 1)
+    {
+      notarisations.push_back({block->block_number - 1, block->previous_hash,
+                               block->block_entropy.block_notarisation});
+    }
+  }
+
+  if (!notarisations.empty())
+  {
+    notarisation_->Verify(notarisations);
+  }
+}
+
 uint64_t Consensus::GetBlockGenerationWeight(Block const &current, Identity const &identity) const
 {
   MilliTimer const timer{"GetBlockGenerationWeight ", 1000};
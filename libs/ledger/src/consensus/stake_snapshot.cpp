@@ -16,24 +16,81 @@
 //
 //------------------------------------------------------------------------------
 
-#include "core/digest.hpp"
 #include "core/random/lcg.hpp"
 #include "ledger/consensus/stake_snapshot.hpp"
 
 #include <algorithm>
-#include <unordered_set>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
+namespace {
 
-using Identity    = crypto::Identity;
-using IdentitySet = std::unordered_set<Identity>;
-using DRNG        = random::LinearCongruentialGenerator;
+using Identity  = crypto::Identity;
+using DRNG      = random::LinearCongruentialGenerator;
+using StakeTree = std::vector<uint64_t>;
+
+/**
+ * Add a (possibly wrapping) delta to the stake at the specified position in the tree
+ *
+ * @param tree The Fenwick tree to be updated
+ * @param index The zero based index of the record
+ * @param delta The amount to be added, subtractions are expressed as two's complement values
+ */
+void AddToStakeTree(StakeTree &tree, std::size_t index, uint64_t delta)
+{
+  for (std::size_t i = index + 1; i <= tree.size(); i += i & (~i + 1))
+  {
+    tree[i - 1] += delta;
+  }
+}
+
+/**
+ * Locate the record whose cumulative stake range contains the selection value
+ *
+ * @param tree The Fenwick tree to be searched
+ * @param selection The selection value, must be less than the total stake in the tree
+ * @return The zero based index of the selected record
+ */
+std::size_t FindInStakeTree(StakeTree const &tree, uint64_t selection)
+{
+  std::size_t mask{1};
+  while ((mask << 1u) <= tree.size())
+  {
+    mask <<= 1u;
+  }
+
+  std::size_t position{0};
+  for (; mask != 0; mask >>= 1u)
+  {
+    std::size_t const next = position + mask;
+    if ((next <= tree.size()) && (tree[next - 1] <= selection))
+    {
+      position = next;
+      selection -= tree[next - 1];
+    }
+  }
+
+  return position;
+}
+
+bool IdentityLess(StakeSnapshot::Record const &record, Identity const &identity)
+{
+  return record.identity < identity;
+}
+
+}  // namespace
 
 /**
  * Given the source of entropy, generate a selection of stakes identities based on proportional
  * probability against stakes.
  *
+ * Each selection is a weighted sample (without replacement) over the records ordered by identity,
+ * the chosen record being removed from a copy of the stake tree before the next sample is taken.
+ *
  * @param entropy The seed source of entropy
  * @param count The size of the selection
  * @return The selection of identities
@@ -46,77 +103,58 @@ StakeSnapshot::CabinetPtr StakeSnapshot::BuildCabinet(
 
   CabinetPtr cabinet = std::make_shared<Cabinet>();
   cabinet->reserve(count);
-  auto stake_index = stake_index_;  // Since build cabinet is const
+
+  // Since build cabinet is const the selection is made against a copy of the tree
+  StakeTree         stake_tree      = stake_tree_;
+  uint64_t          remaining_stake = total_stake_;
+  std::size_t       eligible        = stake_index_.size();
+  std::vector<bool> excluded(stake_index_.size(), false);
 
   // Pre filter against the whitelist if necessary
   if (!whitelist.empty())
   {
-    for (auto it = stake_index.begin(); it != stake_index.end();)
+    for (std::size_t i = 0; i < stake_index_.size(); ++i)
     {
-      if (whitelist.find((*it)->identity.identifier()) == whitelist.end())
+      auto const &record = stake_index_[i];
+
+      if (whitelist.find(record.identity.identifier()) == whitelist.end())
       {
         FETCH_LOG_WARN(LOGGING_NAME, "Removing staker since not in whitelist: ",
-                       (*it)->identity.identifier().ToBase64());
-        it = stake_index.erase(it);
-      }
-      else
-      {
-        ++it;
+                       record.identity.identifier().ToBase64());
+
+        AddToStakeTree(stake_tree, i, ~record.stake + 1);
+        remaining_stake -= record.stake;
+        excluded[i] = true;
+        --eligible;
       }
     }
   }
 
-  if (count >= identity_index_.size())
+  if (count >= eligible)
   {
-    for (auto const &record : stake_index)
+    for (std::size_t i = 0; i < stake_index_.size(); ++i)
     {
-      cabinet->emplace_back(record->identity);
+      if (!excluded[i])
+      {
+        cabinet->emplace_back(stake_index_[i].identity);
+      }
     }
   }
   else
   {
-    IdentitySet chosen_identities;
-    DRNG        rng(entropy);
-
-    // ensure the stake list is reset to a deterministic state
-    std::sort(stake_index.begin(), stake_index.end(),
-              [](RecordPtr const &a, RecordPtr const &b) { return a->identity < b->identity; });
+    DRNG rng(entropy);
 
-    for (std::size_t i = 0; i < count; ++i)
+    while ((cabinet->size() < count) && (remaining_stake > 0))
     {
-      // shuffle the array
-      std::shuffle(stake_index.begin(), stake_index.end(), rng);
-
       // make the selection
-      uint64_t selection = rng() % total_stake_;
+      std::size_t const index  = FindInStakeTree(stake_tree, rng() % remaining_stake);
+      auto const &      record = stake_index_[index];
 
-      std::size_t index{0};
-      for (auto const &record : stake_index)
-      {
-        if (record->stake >= selection)
-        {
-          // TODO(issue 1247): This ensures in the case of a collision, the next item in the list is
-          //                   picked. However, there is an edge case here when this selection is at
-          //                   the  end of the stake_index array. In this case the output will
-          //                   contain fewer items.
-          selection = 0;
-
-          if (chosen_identities.find(record->identity) == chosen_identities.end())
-          {
-            cabinet->emplace_back(record->identity);
-            chosen_identities.emplace(record->identity);
-
-            // exit from the search loop
-            break;
-          }
-        }
-        else  // (record->stake < selection)
-        {
-          selection -= record->stake;
-        }
-
-        ++index;
-      }
+      cabinet->emplace_back(record.identity);
+
+      // remove the chosen record from any further selections
+      AddToStakeTree(stake_tree, index, ~record.stake + 1);
+      remaining_stake -= record.stake;
     }
   }
 
@@ -133,10 +171,10 @@ uint64_t StakeSnapshot::LookupStake(Identity const &identity) const
 {
   uint64_t stake{0};
 
-  auto const it = identity_index_.find(identity);
-  if (it != identity_index_.end())
+  auto const it = FindRecord(identity);
+  if (it != stake_index_.end())
   {
-    stake = it->second->stake;
+    stake = it->stake;
   }
 
   return stake;
@@ -152,22 +190,23 @@ uint64_t StakeSnapshot::LookupStake(Identity const &identity) const
  */
 void StakeSnapshot::UpdateStake(Identity const &identity, uint64_t stake)
 {
-  auto it = identity_index_.find(identity);
-  if (it == identity_index_.end())
+  auto it = FindRecord(identity);
+  if (it == stake_index_.end())
   {
     // new stake
-    auto record = std::make_shared<Record>(Record{identity, stake});
-
-    // update all the indexes
-    identity_index_[identity] = record;
-    stake_index_.emplace_back(std::move(record));
+    stake_index_.insert(std::lower_bound(stake_index_.begin(), stake_index_.end(), identity,
+                                         IdentityLess),
+                        Record{identity, stake});
     total_stake_ += stake;
+
+    // the positions of the records have changed
+    RebuildStakeTree();
   }
   else
   {
     // change in stake
 
-    if (stake == it->second->stake)
+    if (stake == it->stake)
     {
       // special case - no change in stake
       return;
@@ -177,34 +216,130 @@ void StakeSnapshot::UpdateStake(Identity const &identity, uint64_t stake)
       // special case - removed from staking pool
 
       // update the total stake
-      total_stake_ -= it->second->stake;
-
-      // remove the from identity index
-      identity_index_.erase(it);
+      total_stake_ -= it->stake;
 
       // remove from the stake index
-      auto const last = std::remove_if(
-          stake_index_.begin(), stake_index_.end(),
-          [&identity](RecordPtr const &record) { return identity == record->identity; });
-      stake_index_.erase(last, stake_index_.end());
+      stake_index_.erase(it);
+
+      // the positions of the records have changed
+      RebuildStakeTree();
     }
     else
     {
-      // normal change in stake
+      // normal change in stake (relying on unsigned wrap around for decreases)
+      uint64_t const delta = stake - it->stake;
 
-      if (stake >= it->second->stake)
-      {
-        // increase in stake
-        total_stake_ += (stake - it->second->stake);
-      }
-      else
+      total_stake_ += delta;
+      AddToStakeTree(stake_tree_,
+                     static_cast<std::size_t>(std::distance(stake_index_.begin(), it)), delta);
+
+      // now update the stake
+      it->stake = stake;
+    }
+  }
+}
+
+/**
+ * Apply a set of changes generated from ComputeDelta
+ *
+ * @param delta The set of records whose stake has changed (zero stake signals removal)
+ */
+void StakeSnapshot::ApplyDelta(Records const &delta)
+{
+  for (auto const &record : delta)
+  {
+    UpdateStake(record.identity, record.stake);
+  }
+}
+
+/**
+ * Compute the set of changes that need to be applied to a previous snapshot to generate this one
+ *
+ * @param previous The previous snapshot
+ * @return The set of records whose stake has changed (zero stake signals removal)
+ */
+StakeSnapshot::Records StakeSnapshot::ComputeDelta(StakeSnapshot const &previous) const
+{
+  Records delta{};
+
+  auto current_it  = stake_index_.begin();
+  auto previous_it = previous.stake_index_.begin();
+
+  // both indexes are ordered by identity, so the delta can be computed in a single merge pass
+  while ((current_it != stake_index_.end()) || (previous_it != previous.stake_index_.end()))
+  {
+    if ((previous_it == previous.stake_index_.end()) ||
+        ((current_it != stake_index_.end()) && (current_it->identity < previous_it->identity)))
+    {
+      // new stake
+      delta.emplace_back(*current_it);
+      ++current_it;
+    }
+    else if ((current_it == stake_index_.end()) || (previous_it->identity < current_it->identity))
+    {
+      // removed from the staking pool
+      delta.emplace_back(Record{previous_it->identity, 0});
+      ++previous_it;
+    }
+    else
+    {
+      if (current_it->stake != previous_it->stake)
       {
-        // decrease in stake
-        total_stake_ -= (it->second->stake - stake);
+        delta.emplace_back(*current_it);
       }
 
-      // now update the stake
-      it->second->stake = stake;
+      ++current_it;
+      ++previous_it;
+    }
+  }
+
+  return delta;
+}
+
+StakeSnapshot::Records::const_iterator StakeSnapshot::FindRecord(Identity const &identity) const
+{
+  auto const it =
+      std::lower_bound(stake_index_.begin(), stake_index_.end(), identity, IdentityLess);
+
+  if ((it != stake_index_.end()) && (it->identity == identity))
+  {
+    return it;
+  }
+
+  return stake_index_.end();
+}
+
+StakeSnapshot::Records::iterator StakeSnapshot::FindRecord(Identity const &identity)
+{
+  auto const it =
+      std::lower_bound(stake_index_.begin(), stake_index_.end(), identity, IdentityLess);
+
+  if ((it != stake_index_.end()) && (it->identity == identity))
+  {
+    return it;
+  }
+
+  return stake_index_.end();
+}
+
+/**
+ * Rebuild the Fenwick tree from the stake index in linear time
+ */
+void StakeSnapshot::RebuildStakeTree()
+{
+  stake_tree_.resize(stake_index_.size());
+
+  for (std::size_t i = 0; i < stake_index_.size(); ++i)
+  {
+    stake_tree_[i] = stake_index_[i].stake;
+  }
+
+  for (std::size_t i = 1; i <= stake_tree_.size(); ++i)
+  {
+    std::size_t const parent = i + (i & (~i + 1));
+    if (parent <= stake_tree_.size())
+    {
+      stake_tree_[parent - 1] += stake_tree_[i - 1];
     }
   }
 }
@@ -21,6 +21,8 @@
 #include "ledger/dag/dag.hpp"
 #include "ledger/dag/dag_node.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <random>
 #include <string>
@@ -43,6 +45,7 @@ DAG::DAG(std::string db_name, bool load, CertificatePtr certificate)
     all_tips_.clear();
     tips_.clear();
     node_pool_.clear();
+    node_index_.Clear();
     loose_nodes_.clear();
     loose_nodes_lookup_.clear();
     recently_added_.clear();
@@ -299,12 +302,10 @@ void DAG::SetReferencesInternal(DAGNodePtr const &node)
   else
   {
     // In the case there are not enough tips to reference, choose non-tip nodes
-    // TODO(HUT): inefficient, but node pool is almost certainly small
-    std::unordered_map<NodeHash, DAGNodePtr> node_pool_copy = node_pool_;
-
-    while (prevs.size() < PARAMETER_REFERENCES_TO_BE_TIP && !node_pool_copy.empty())
+    for (auto it = node_pool_.begin();
+         prevs.size() < PARAMETER_REFERENCES_TO_BE_TIP && it != node_pool_.end(); ++it)
     {
-      auto &node_ref = (node_pool_copy.begin())->second;
+      auto const &node_ref = it->second;
 
       prevs.push_back(node_ref->hash);
 
@@ -317,8 +318,6 @@ void DAG::SetReferencesInternal(DAGNodePtr const &node)
       {
         oldest_epoch = node_ref->oldest_epoch_referenced;
       }
-
-      node_pool_copy.erase(node_pool_copy.begin());
     }
   }
 }
@@ -334,6 +333,31 @@ bool DAG::AddDAGNode(DAGNode node)
   return success;
 }
 
+// Add a batch of nodes under a single lock. Nodes are pushed in order of increasing weight so that
+// (as far as possible) references are added before the nodes which refer to them, avoiding a round
+// trip through the loose node structures
+std::size_t DAG::AddDAGNodes(std::vector<DAGNode> nodes)
+{
+  std::sort(nodes.begin(), nodes.end(),
+            [](DAGNode const &a, DAGNode const &b) { return a.weight < b.weight; });
+
+  FETCH_LOCK(mutex_);
+
+  std::size_t added{0};
+  for (auto &node : nodes)
+  {
+    assert(!node.hash.empty());
+
+    missing_.erase(node.hash);
+    if (PushInternal(std::make_shared<DAGNode>(std::move(node))))
+    {
+      ++added;
+    }
+  }
+
+  return added;
+}
+
 std::vector<DAGNode> DAG::GetRecentlyAdded()
 {
   FETCH_LOCK(mutex_);
@@ -349,6 +373,84 @@ std::set<DAGHash> DAG::GetRecentlyMissing()
   return ret;
 }
 
+DAGSyncSummary DAG::GetSyncSummary()
+{
+  FETCH_LOCK(mutex_);
+
+  DAGSyncSummary summary{};
+  summary.epoch      = most_recent_epoch_;
+  summary.epoch_hash = previous_epoch_.hash;
+
+  for (auto const &entry : node_pool_)
+  {
+    summary.nodes.insert(entry.first);
+  }
+
+  // loose nodes have been received already, only their references are missing
+  for (auto const &entry : loose_nodes_)
+  {
+    summary.nodes.insert(entry.first);
+  }
+
+  return summary;
+}
+
+// Determine the nodes that a peer is missing given its summary. These are the nodes of the
+// relevant epochs that it has not yet committed (or has committed on a different fork), followed by
+// the nodes in the node pool that it has not seen. At most max_nodes nodes are returned, the peer
+// is expected to ask again for the remainder
+std::vector<DAGNode> DAG::GetNodesMissingFrom(DAGSyncSummary const &summary, std::size_t max_nodes)
+{
+  FETCH_LOCK(mutex_);
+
+  std::vector<DAGNode> ret;
+  std::set<NodeHash>   sent;
+
+  auto const add_node = [&](NodeHash const &hash) {
+    if ((ret.size() >= max_nodes) || (summary.nodes.find(hash) != summary.nodes.end()) ||
+        !sent.insert(hash).second)
+    {
+      return;
+    }
+
+    bool dummy;
+    auto node = GetDAGNodeInternal(hash, false, dummy);
+
+    if (node)
+    {
+      ret.push_back(*node);
+    }
+  };
+
+  auto const add_epoch = [&](DAGEpoch const &epoch) {
+    bool const newer = epoch.block_number > summary.epoch;
+    bool const forked =
+        (epoch.block_number == summary.epoch) && !(epoch.hash == summary.epoch_hash);
+
+    if (newer || forked)
+    {
+      for (auto const &hash : epoch.all_nodes)
+      {
+        add_node(hash);
+      }
+    }
+  };
+
+  // the epochs, oldest first so that references are sent before the nodes that refer to them
+  for (auto const &epoch : previous_epochs_)
+  {
+    add_epoch(epoch);
+  }
+  add_epoch(previous_epoch_);
+
+  for (auto const &entry : node_pool_)
+  {
+    add_node(entry.first);
+  }
+
+  return ret;
+}
+
 // Node is loose when not all references are found in the last N block periods
 bool DAG::IsLooseInternal(DAGNodePtr const &node) const
 {
@@ -533,6 +635,7 @@ bool DAG::PushInternal(DAGNodePtr const &node)
 
   // Add to node pool, update any tips that advance due to this
   node_pool_[node->hash] = node;
+  node_index_.Add(node->hash, node->previous);
   AdvanceTipsInternal(node);
 
   // There is now a chance that adding this node completed some loose nodes.
@@ -636,13 +739,13 @@ DAGEpoch DAG::CreateEpoch(uint64_t block_number)
   // Find all un-finalised nodes given tips in epoch
   std::set<DAGHash> all_nodes_to_add;
 
-  auto on_node = [&all_nodes_to_add](NodeHash current) { all_nodes_to_add.insert(current); };
-
-  auto terminating_condition = [&all_nodes_to_add](NodeHash current) -> bool {
-    // Terminate when already seen node for efficiency reasons
-    return all_nodes_to_add.find(current) != all_nodes_to_add.end();
+  auto on_node = [&all_nodes_to_add](NodeHash const &current) {
+    all_nodes_to_add.insert(current);
   };
 
+  // The traversal never revisits a node, so there is no need for any other terminating condition
+  auto terminating_condition = [](NodeHash const & /*current*/) -> bool { return false; };
+
   // Traverse down from the tips (for unaccounted for dagnodes), adding
   // tips to all_nodes_to_add
   TraverseFromTips(tips_to_add, on_node, terminating_condition);
@@ -713,6 +816,7 @@ bool DAG::CommitEpoch(DAGEpoch new_epoch)
       DAGNodePtr &node_to_remove = it_node_to_rmv->second;
       finalised_dag_nodes_.Set(storage::ResourceID(node_to_remove->hash.hash), *node_to_remove);
       node_pool_.erase(it_node_to_rmv);
+      node_index_.Remove(node_hash);
     }
     else if (loose_nodes_.find(node_hash) != loose_nodes_.end())
     {
@@ -770,107 +874,36 @@ void DAG::Flush()
   finalised_dag_nodes_.Flush(false);
 }
 
-void DAG::TraverseFromTips(std::set<DAGHash> const &            tip_hashes,
-                           std::function<void(NodeHash)> const &on_node,
-                           std::function<bool(NodeHash)> const &terminating_condition)
+void DAG::TraverseFromTips(std::set<DAGHash> const &                   tip_hashes,
+                           std::function<void(NodeHash const &)> const &on_node,
+                           std::function<bool(NodeHash const &)> const &terminating_condition)
 {
+  DAGNodeIndex::NodeIds starts;
+  starts.reserve(tip_hashes.size());
+
   for (auto const &tip_hash : tip_hashes)
   {
-    if (node_pool_.find(tip_hash) == node_pool_.end())
+    auto const id = node_index_.Lookup(tip_hash);
+    if (id == DAGNodeIndex::INVALID_ID)
     {
       throw std::runtime_error("Tip found in DAG that refers nowhere");
     }
 
-    NodeHash              start = node_pool_[tip_hash]->hash;
-    DAGNodePtr            dag_node_to_add;
-    std::vector<uint64_t> switch_choices{0};
-    std::vector<NodeHash> switch_hashes{start};
-
-    if (HashInPrevEpochsInternal(start))
+    if (HashInPrevEpochsInternal(tip_hash))
     {
       throw std::runtime_error("Tip found in DAG that refers to something finalised");
     }
 
-    // Depth first search of the dag until reaching a finalised node/hash
-    // Warning: If the dag is circular this will not terminate
-    while (!switch_choices.empty())
-    {
-      start = switch_hashes.back();  // Hash under evaluation
-
-      // Hash 'terminates' - refers to already used hash
-      if (HashInPrevEpochsInternal(start))
-      {
-        switch_choices.pop_back();
-        switch_hashes.pop_back();
-        continue;
-      }
-
-      if (start.IsEpoch())
-      {
-        switch_choices.pop_back();
-        switch_hashes.pop_back();
-        continue;
-      }
-
-      // Check user supplied terminating condition (usually at least this would be that
-      // the hash and by definition subgraph have already been added)
-      if (terminating_condition(start))
-      {
-        switch_choices.pop_back();
-        switch_hashes.pop_back();
-        continue;
-      }
-
-      auto node_it = node_pool_.find(start);
-      if (node_it != node_pool_.end())
-      {
-        dag_node_to_add = node_it->second;
-      }
-      else
-      {
-        for (uint64_t i = 1; i <= EPOCH_VALIDITY_PERIOD; ++i)
-        {
-          if (previous_epochs_.size() >= i)
-          {
-            if (previous_epochs_[previous_epochs_.size() - i].Contains(start))
-            {
-              dag_node_to_add = std::make_shared<DAGNode>();
-              finalised_dag_nodes_.Get(storage::ResourceID(start.hash), *dag_node_to_add);
-              break;
-            }
-          }
-        }
-      }
-      if (!dag_node_to_add)
-      {
-        FETCH_LOG_ERROR(LOGGING_NAME,
-                        "TraverseFromTips: unable to lookup node with hash=", start.ToBase64());
-        switch_choices.pop_back();
-        switch_hashes.pop_back();
-        continue;
-      }
-
-      // Attempt to take the path specified by switch choices, else add it
-      dag_node_to_add = node_pool_.at(start);
-
-      // If all paths are exhausted for this hash
-      if (switch_choices.back() == dag_node_to_add->previous.size())
-      {
-        on_node(start);
-        /* all_nodes_to_add.insert(start); */
-        switch_choices.pop_back();
-        switch_hashes.pop_back();
-        continue;
-      }
-
-      // There are unexplored paths still - explore one of these
-      start = dag_node_to_add->previous[switch_choices.back()];
-      switch_hashes.push_back(start);
-
-      switch_choices[switch_choices.size() - 1]++;
-      switch_choices.push_back(0);
-    }
+    starts.push_back(id);
   }
+
+  // Depth first search of the node pool. References to epochs and finalised nodes are not part of
+  // the index, so the search naturally stops at the boundary of the pool
+  node_index_.Traverse(
+      starts, [this, &on_node](DAGNodeIndex::NodeId id) { on_node(node_index_.hash(id)); },
+      [this, &terminating_condition](DAGNodeIndex::NodeId id) {
+        return terminating_condition(node_index_.hash(id));
+      });
 }
 
 // TODO(HUT): this.
@@ -893,27 +926,16 @@ void DAG::UpdateStaleTipsInternal()
     }
   }
 
-  auto on_node = [&stale_nodes](NodeHash current) { stale_nodes.insert(current); };
-
-  auto terminating_condition = [this, &stale_nodes, &new_tip_locations](NodeHash current) -> bool {
-    // Terminate when already seen node for efficiency reasons
-    if (stale_nodes.find(current) != stale_nodes.end())
-    {
-      return true;
-    }
+  auto on_node = [&stale_nodes](NodeHash const &current) { stale_nodes.insert(current); };
 
+  auto terminating_condition = [this, &new_tip_locations](NodeHash const &current) -> bool {
     // Terminate when this node is healthy - this is a new tip
-    DAGNodePtr dag_node_to_check;
+    auto const it = node_pool_.find(current);
 
-    if (node_pool_.find(current) != node_pool_.end())
+    if ((it != node_pool_.end()) && !TooOldInternal(it->second->oldest_epoch_referenced))
     {
-      dag_node_to_check = node_pool_[current];
-
-      if (!TooOldInternal(dag_node_to_check->oldest_epoch_referenced))
-      {
-        new_tip_locations.insert(current);
-        return true;
-      }
+      new_tip_locations.insert(current);
+      return true;
     }
 
     return false;
@@ -932,6 +954,7 @@ void DAG::UpdateStaleTipsInternal()
     }
 
     node_pool_.erase(stale_node_hash);
+    node_index_.Remove(stale_node_hash);
   }
 
   // Update : new tips need to be created
@@ -1161,6 +1184,7 @@ bool DAG::RevertToEpoch(uint64_t epoch_bn_to_revert)
     all_tips_.clear();
     tips_.clear();
     node_pool_.clear();
+    node_index_.Clear();
     loose_nodes_.clear();
     loose_nodes_lookup_.clear();
     recently_added_.clear();
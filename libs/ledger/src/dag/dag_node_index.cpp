@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/dag/dag_node_index.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+void EraseId(DAGNodeIndex::NodeIds &ids, DAGNodeIndex::NodeId id)
+{
+  ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+}
+
+}  // namespace
+
+constexpr DAGNodeIndex::NodeId DAGNodeIndex::INVALID_ID;
+
+/**
+ * Get the number of nodes in the index
+ *
+ * @return The number of nodes
+ */
+std::size_t DAGNodeIndex::size() const
+{
+  return ids_.size();
+}
+
+/**
+ * Lookup the identifier of the node with the specified hash
+ *
+ * @param hash The hash of the node
+ * @return The identifier of the node if present, otherwise INVALID_ID
+ */
+DAGNodeIndex::NodeId DAGNodeIndex::Lookup(DAGHash const &hash) const
+{
+  auto const it = ids_.find(hash);
+  return (it == ids_.end()) ? INVALID_ID : it->second;
+}
+
+/**
+ * Get the hash of the specified node
+ *
+ * @param id The identifier of the node
+ * @return The hash of the node
+ */
+DAGHash const &DAGNodeIndex::hash(NodeId id) const
+{
+  assert(id < nodes_.size() && nodes_[id].in_use);
+  return nodes_[id].hash;
+}
+
+/**
+ * Get the nodes in the index which are referenced by the specified node
+ *
+ * @param id The identifier of the node
+ * @return The identifiers of the referenced nodes
+ */
+DAGNodeIndex::NodeIds const &DAGNodeIndex::previous(NodeId id) const
+{
+  assert(id < nodes_.size() && nodes_[id].in_use);
+  return nodes_[id].previous;
+}
+
+/**
+ * Add a node to the index. Any of the references which are not present in the index are ignored.
+ *
+ * @param hash The hash of the node
+ * @param previous The hashes referenced by the node
+ * @return The identifier of the node
+ */
+DAGNodeIndex::NodeId DAGNodeIndex::Add(DAGHash const &hash, DAGHashList const &previous)
+{
+  auto const existing = ids_.find(hash);
+  if (existing != ids_.end())
+  {
+    return existing->second;
+  }
+
+  NodeId id{INVALID_ID};
+  if (free_ids_.empty())
+  {
+    id = static_cast<NodeId>(nodes_.size());
+    nodes_.emplace_back();
+  }
+  else
+  {
+    id = free_ids_.back();
+    free_ids_.pop_back();
+  }
+
+  Node &node  = nodes_[id];
+  node.hash   = hash;
+  node.in_use = true;
+
+  for (auto const &previous_hash : previous)
+  {
+    NodeId const previous_id = Lookup(previous_hash);
+
+    if ((previous_id != INVALID_ID) &&
+        (std::find(node.previous.begin(), node.previous.end(), previous_id) == node.previous.end()))
+    {
+      node.previous.push_back(previous_id);
+      nodes_[previous_id].next.push_back(id);
+    }
+  }
+
+  ids_.emplace(hash, id);
+
+  return id;
+}
+
+/**
+ * Remove a node from the index, along with all of the references to and from it
+ *
+ * @param hash The hash of the node to be removed
+ * @return true if successful, otherwise false
+ */
+bool DAGNodeIndex::Remove(DAGHash const &hash)
+{
+  auto const it = ids_.find(hash);
+  if (it == ids_.end())
+  {
+    return false;
+  }
+
+  NodeId const id   = it->second;
+  Node &       node = nodes_[id];
+
+  for (auto const previous_id : node.previous)
+  {
+    EraseId(nodes_[previous_id].next, id);
+  }
+
+  for (auto const next_id : node.next)
+  {
+    EraseId(nodes_[next_id].previous, id);
+  }
+
+  node = Node{};
+  free_ids_.push_back(id);
+  ids_.erase(it);
+
+  return true;
+}
+
+/**
+ * Remove all the nodes from the index
+ */
+void DAGNodeIndex::Clear()
+{
+  ids_.clear();
+  nodes_.clear();
+  free_ids_.clear();
+}
+
+/**
+ * Depth first traversal of the index following the references of each of the start nodes in turn.
+ *
+ * Every node is visited at most once. A node for which the terminating condition holds is not
+ * expanded, otherwise the visitor is called once all of the nodes it references have been visited.
+ *
+ * @param starts The identifiers of the nodes to start from
+ * @param on_node The visitor called for each of the (non terminating) nodes
+ * @param terminating_condition The condition under which the traversal does not expand a node
+ */
+void DAGNodeIndex::Traverse(NodeIds const &starts, Visitor const &on_node,
+                            Terminator const &terminating_condition) const
+{
+  // pairs of the node under evaluation and the index of the next reference to be followed
+  using Frame = std::pair<NodeId, std::size_t>;
+
+  std::vector<bool>  visited(nodes_.size(), false);
+  std::vector<Frame> stack{};
+
+  auto const enter = [&](NodeId id) {
+    if (visited[id])
+    {
+      return;
+    }
+
+    visited[id] = true;
+
+    if (!terminating_condition(id))
+    {
+      stack.emplace_back(id, 0);
+    }
+  };
+
+  for (auto const start : starts)
+  {
+    assert(start < nodes_.size() && nodes_[start].in_use);
+    enter(start);
+
+    while (!stack.empty())
+    {
+      Frame &        frame    = stack.back();
+      NodeIds const &previous = nodes_[frame.first].previous;
+
+      // all paths have been exhausted for this node
+      if (frame.second == previous.size())
+      {
+        NodeId const id = frame.first;
+        stack.pop_back();
+        on_node(id);
+        continue;
+      }
+
+      // explore the next path (note: this may invalidate the frame reference)
+      enter(previous[frame.second++]);
+    }
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
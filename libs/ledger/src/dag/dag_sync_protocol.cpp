@@ -16,17 +16,31 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/byte_array/byte_array.hpp"
+#include "core/compression/lz4.hpp"
+#include "core/serializers/main_serializer.hpp"
 #include "ledger/dag/dag_sync_protocol.hpp"
+#include "logging/logging.hpp"
 
 #include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iterator>
 #include <utility>
 
 using namespace fetch::ledger;
 
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+
+constexpr std::size_t DAGSyncProtocol::DELTA_HEADER_SIZE;
+constexpr std::size_t DAGSyncProtocol::MAX_DELTA_DECOMPRESSED_SIZE;
+
 DAGSyncProtocol::DAGSyncProtocol(std::shared_ptr<ledger::DAGInterface> dag)
   : dag_{std::move(dag)}
 {
   this->Expose(REQUEST_NODES, this, &Self::RequestNodes);
+  this->Expose(REQUEST_DELTA, this, &Self::RequestDelta);
 }
 
 DAG::MissingNodes DAGSyncProtocol::RequestNodes(MissingTXs missing_txs)
@@ -51,3 +65,79 @@ DAG::MissingNodes DAGSyncProtocol::RequestNodes(MissingTXs missing_txs)
 
   return ret;
 }
+
+ConstByteArray DAGSyncProtocol::RequestDelta(DAGSyncSummary const &summary)
+{
+  auto nodes = dag_->GetNodesMissingFrom(summary, MAX_DELTA_NODES_TO_PROVIDE);
+
+  return CompressNodes(DAG::MissingNodes(std::make_move_iterator(nodes.begin()),
+                                         std::make_move_iterator(nodes.end())));
+}
+
+/**
+ * Serialise and compress a batch of nodes
+ *
+ * @param nodes The nodes to compress
+ * @return The compressed nodes, prefixed with their decompressed size
+ */
+ConstByteArray DAGSyncProtocol::CompressNodes(DAG::MissingNodes const &nodes)
+{
+  serializers::MsgPackSerializer serializer;
+  serializer << nodes;
+
+  auto const &payload = serializer.data();
+  auto const  block   = compression::LZ4Compress(payload);
+  auto const  size    = static_cast<uint32_t>(payload.size());
+
+  ByteArray output{};
+  output.Resize(DELTA_HEADER_SIZE + block.size());
+  std::memcpy(output.pointer(), &size, sizeof(size));
+  std::memcpy(output.pointer() + DELTA_HEADER_SIZE, block.pointer(), block.size());
+
+  return {output};
+}
+
+/**
+ * Decompress and deserialise a batch of nodes received from a peer
+ *
+ * @param compressed The compressed nodes
+ * @param nodes The output nodes
+ * @return true if successful, otherwise false
+ */
+bool DAGSyncProtocol::DecompressNodes(ConstByteArray const &compressed, DAG::MissingNodes &nodes)
+{
+  if (compressed.size() < DELTA_HEADER_SIZE)
+  {
+    return false;
+  }
+
+  uint32_t size{0};
+  std::memcpy(&size, compressed.pointer(), sizeof(size));
+
+  // an LZ4 block can not expand by more than a factor of 255, reject impossible sizes before any
+  // memory is allocated for them
+  if ((size > MAX_DELTA_DECOMPRESSED_SIZE) ||
+      (size > ((compressed.size() - DELTA_HEADER_SIZE) * 255u)))
+  {
+    return false;
+  }
+
+  ByteArray payload{};
+  if (!compression::LZ4Decompress(compressed.SubArray(DELTA_HEADER_SIZE), size, payload))
+  {
+    return false;
+  }
+
+  try
+  {
+    serializers::MsgPackSerializer serializer{payload};
+    serializer >> nodes;
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to decode DAG nodes: ", ex.what());
+    return false;
+  }
+
+  return true;
+}
@@ -20,13 +20,19 @@
 #include "ledger/dag/dag_sync_protocol.hpp"
 #include "ledger/dag/dag_sync_service.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
 
+constexpr std::size_t DAGSyncService::MAX_DELTA_SYNC_PEERS;
+constexpr uint64_t    DAGSyncService::DELTA_SYNC_INTERVAL_MS;
+
 using DAGNodesSerializer = fetch::serializers::MsgPackSerializer;
 
 DAGSyncService::DAGSyncService(MuddleEndpoint &                      muddle_endpoint,
@@ -120,14 +126,16 @@ DAGSyncService::State DAGSyncService::OnAddBroadcastRecent()
     recvd_broadcast_nodes_.clear();
   }
 
-  for (auto const &nodes_vector : recvd_broadcast_nodes)
+  std::vector<DAGNode> verified_nodes;
+
+  for (auto &nodes_vector : recvd_broadcast_nodes)
   {
-    for (auto const &node : nodes_vector)
+    for (auto &node : nodes_vector)
     {
       if (node.Verify())
       {
         FETCH_LOG_DEBUG(LOGGING_NAME, "Adding broadcasted dag node. Of: ", nodes_vector.size());
-        dag_->AddDAGNode(node);
+        verified_nodes.emplace_back(std::move(node));
       }
       else
       {
@@ -136,11 +144,25 @@ DAGSyncService::State DAGSyncService::OnAddBroadcastRecent()
     }
   }
 
+  if (!verified_nodes.empty())
+  {
+    dag_->AddDAGNodes(std::move(verified_nodes));
+  }
+
   return State::QUERY_MISSING;
 }
 
 DAGSyncService::State DAGSyncService::OnQueryMissing()
 {
+  auto const peers = muddle_endpoint_.GetDirectlyConnectedPeers();
+
+  if (peers.empty())
+  {
+    return State::RESOLVE_MISSING;
+  }
+
+  bool requested{false};
+
   auto missing = dag_->GetRecentlyMissing();
 
   missing_dag_nodes_.clear();
@@ -152,35 +174,116 @@ DAGSyncService::State DAGSyncService::OnQueryMissing()
 
   if (!missing_dag_nodes_.empty())
   {
-    for (auto const &connection : muddle_endpoint_.GetDirectlyConnectedPeers())
-    {
-      auto promise = PromiseOfMissingNodes(client_->CallSpecificAddress(
-          connection, RPC_DAG_STORE_SYNC, DAGSyncProtocol::REQUEST_NODES, missing_dag_nodes_));
-      missing_pending_.Add(connection, promise);
-    }
+    RequestMissingNodes(peers);
+    requested = true;
+  }
+
+  // periodically ask a few peers for the nodes that we are missing with respect to them
+  if (delta_sync_interval_.HasExpired())
+  {
+    RequestDelta(peers);
+    delta_sync_interval_.Restart(DELTA_SYNC_INTERVAL_MS);
+    requested = true;
+  }
+
+  ++peer_offset_;
 
+  if (requested)
+  {
     state_machine_->Delay(std::chrono::milliseconds{500});
   }
 
   return State::RESOLVE_MISSING;
 }
 
+/**
+ * Request the explicitly missing nodes from the connected peers. Peers will only provide a limited
+ * number of nodes per request, so the missing hashes are split into batches of that size which are
+ * spread over the peers, rather than asking every peer for the same batch. Any hashes left over are
+ * requested on a later cycle
+ *
+ * @param peers The directly connected peers
+ */
+void DAGSyncService::RequestMissingNodes(muddle::MuddleEndpoint::AddressList const &peers)
+{
+  auto it = missing_dag_nodes_.begin();
+
+  for (std::size_t i = 0; (i < peers.size()) && (it != missing_dag_nodes_.end()); ++i)
+  {
+    MissingTXs batch;
+    while ((batch.size() < DAGSyncProtocol::MAX_NODES_TO_PROVIDE) &&
+           (it != missing_dag_nodes_.end()))
+    {
+      batch.insert(*it++);
+    }
+
+    auto const &connection = peers[(peer_offset_ + i) % peers.size()];
+
+    auto promise = PromiseOfMissingNodes(client_->CallSpecificAddress(
+        connection, RPC_DAG_STORE_SYNC, DAGSyncProtocol::REQUEST_NODES, batch));
+    missing_pending_.Add(connection, promise);
+  }
+}
+
+/**
+ * Send a summary of our DAG to a selection of the connected peers, who respond with a batch of the
+ * nodes which they have and we do not
+ *
+ * @param peers The directly connected peers
+ */
+void DAGSyncService::RequestDelta(muddle::MuddleEndpoint::AddressList const &peers)
+{
+  auto const summary   = dag_->GetSyncSummary();
+  auto const num_peers = std::min(peers.size(), MAX_DELTA_SYNC_PEERS);
+
+  for (std::size_t i = 0; i < num_peers; ++i)
+  {
+    auto const &connection = peers[(peer_offset_ + i) % peers.size()];
+
+    auto promise = PromiseOfDelta(client_->CallSpecificAddress(
+        connection, RPC_DAG_STORE_SYNC, DAGSyncProtocol::REQUEST_DELTA, summary));
+    delta_pending_.Add(connection, promise);
+  }
+}
+
 DAGSyncService::State DAGSyncService::OnResolveMissing()
 {
-  auto counts = missing_pending_.Resolve();
+  missing_pending_.Resolve();
   missing_pending_.DiscardFailures();
+  delta_pending_.Resolve();
+  delta_pending_.DiscardFailures();
 
-  FETCH_UNUSED(counts);
+  std::vector<DAGNode> verified_nodes;
 
+  std::vector<MissingNodes> batches{};
   for (auto &result : missing_pending_.Get(MAX_OBJECT_RESOLUTION_PER_CYCLE))
   {
-    for (auto &dag_node : result.promised)
+    batches.emplace_back(std::move(result.promised));
+  }
+
+  // the deltas are compressed, a peer sending a malformed one is ignored
+  for (auto const &result : delta_pending_.Get(MAX_OBJECT_RESOLUTION_PER_CYCLE))
+  {
+    MissingNodes nodes{};
+    if (DAGSyncProtocol::DecompressNodes(result.promised, nodes))
+    {
+      batches.emplace_back(std::move(nodes));
+    }
+    else
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Discarding malformed DAG delta from: ", result.key.ToBase64());
+    }
+  }
+
+  for (auto &batch : batches)
+  {
+    for (auto &dag_node : batch)
     {
       FETCH_LOG_DEBUG(LOGGING_NAME, "Node hash: ", dag_node.hash.ToBase64());
 
       if (dag_node.Verify())
       {
-        dag_->AddDAGNode(dag_node);
+        verified_nodes.emplace_back(std::move(dag_node));
       }
       else
       {
@@ -189,6 +292,11 @@ DAGSyncService::State DAGSyncService::OnResolveMissing()
     }
   }
 
+  if (!verified_nodes.empty())
+  {
+    dag_->AddDAGNodes(std::move(verified_nodes));
+  }
+
   state_machine_->Delay(std::chrono::milliseconds{100});
   return State::BROADCAST_RECENT;
 }
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/block_version.hpp"
 #include "core/assert.hpp"
 #include "core/byte_array/decoders.hpp"
 #include "core/byte_array/encoders.hpp"
@@ -27,6 +28,7 @@
 #include "ledger/executor.hpp"
 #include "ledger/state_adapter.hpp"
 #include "ledger/transaction_status_cache.hpp"
+#include "ledger/transaction_tracer.hpp"
 #include "logging/logging.hpp"
 #include "moment/deadline_timer.hpp"
 #include "storage/resource_mapper.hpp"
@@ -38,6 +40,7 @@
 #include <chrono>
 #include <memory>
 #include <thread>
+#include <utility>
 #include <vector>
 
 static constexpr char const *LOGGING_NAME              = "ExecutionManager";
@@ -59,6 +62,8 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
                                    TransactionStatusCache::ShrdPtr tx_status_cache)
   : log2_num_lanes_{log2_num_lanes}
   , storage_{std::move(storage)}
+  , state_cache_{std::make_shared<SharedStateCache>(*storage_)}
+  , num_executors_{num_executors}
   , thread_pool_{network::MakeThreadPool(num_executors, "Executor")}
   , tx_status_cache_{std::move(tx_status_cache)}
   , tx_executed_count_(Registry::Instance().CreateCounter(
@@ -69,6 +74,12 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
         "ledger_exec_mgr_fees_settled_total", "The total number of settle fees rounds"))
   , blocks_completed_count_(Registry::Instance().CreateCounter(
         "ledger_exec_mgr_blocks_completed_total", "The total number of settle fees rounds"))
+  , tx_reexecuted_count_(Registry::Instance().CreateCounter(
+        "ledger_exec_mgr_tx_reexecuted_total",
+        "The total number of speculatively executed transactions that had to be re-executed"))
+  , tx_pre_executed_count_(Registry::Instance().CreateCounter(
+        "ledger_exec_mgr_tx_pre_executed_total",
+        "The total number of pending transactions pre-executed while the manager was idle"))
   , execution_duration_(Registry::Instance().CreateHistogram(
         {0.000001, 0.000002, 0.000003, 0.000004, 0.000005, 0.000006, 0.000007, 0.000008, 0.000009,
          0.00001,  0.00002,  0.00003,  0.00004,  0.00005,  0.00006,  0.00007,  0.00008,  0.00009,
@@ -137,7 +148,7 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
     // create the executor instances
     for (std::size_t i = 0; i < num_executors; ++i)
     {
-      auto executor = factory();
+      auto executor = factory(state_cache_);
       assert(static_cast<bool>(executor));
 
       idle_executors_.emplace_back(std::move(executor));
@@ -160,6 +171,9 @@ ExecutionManager::ScheduleStatus ExecutionManager::Execute(Block const &block)
     return ScheduleStatus::NOT_STARTED;
   }
 
+  // wait for any pre-execution in progress to complete, none can start until the block is done
+  FETCH_LOCK(pre_execution_lock_);
+
   // cache the current state
   if (State::IDLE != GetState())
   {
@@ -174,6 +188,25 @@ ExecutionManager::ScheduleStatus ExecutionManager::Execute(Block const &block)
     return ScheduleStatus::UNABLE_TO_PLAN;
   }
 
+  // the state might have been committed or reverted since the last block was executed
+  state_cache_->Invalidate();
+
+  // retrieve the transactions of the whole block in the background, slice by slice, so that the
+  // executors do not each have to make a round trip to the lanes before executing
+  std::vector<StorageUnitInterface::Digests> batches{};
+  batches.reserve(block.slices.size());
+  for (auto const &slice : block.slices)
+  {
+    batches.emplace_back();
+    batches.back().reserve(slice.size());
+
+    for (auto const &tx : slice)
+    {
+      batches.back().emplace_back(tx.digest());
+    }
+  }
+  state_cache_->PrefetchTransactions(std::move(batches));
+
   // update the last block hash
   state_.ApplyVoid([&block](Summary &summary) {
     summary.last_block_hash   = block.hash;
@@ -181,7 +214,10 @@ ExecutionManager::ScheduleStatus ExecutionManager::Execute(Block const &block)
     summary.last_block_number = block.block_number;
     summary.state             = State::ACTIVE;
   });
-  num_slices_ = block.slices.size();
+  {
+    FETCH_LOCK(execution_plan_lock_);
+    num_slices_ = optimistic_ ? std::size_t{1} : execution_plan_.size();
+  }
 
   // trigger the monitor / dispatch thread
   {
@@ -189,6 +225,8 @@ ExecutionManager::ScheduleStatus ExecutionManager::Execute(Block const &block)
     monitor_wake_.notify_one();
   }
 
+  TransactionTracer::Instance().Record(block, TraceStage::SCHEDULED);
+
   return ScheduleStatus::SCHEDULED;
 }
 
@@ -203,14 +241,27 @@ bool ExecutionManager::PlanExecution(Block const &block)
 {
   FETCH_LOCK(execution_plan_lock_);
 
-  // clear and resize the execution plan
+  // clear the execution plan
   execution_plan_.clear();
-  execution_plan_.resize(block.slices.size());
+  execution_plan_.reserve(block.slices.size());
+
+  // The items of a slice are executed concurrently, so must not share any lanes. From the block
+  // version which packs slices using the lanes transactions were observed to use, the declared
+  // lanes of the transactions of a slice can overlap. Such a slice is split into consecutive
+  // stages, each item being placed in the stage after the last one holding an item it overlaps
+  // with. This preserves the slice order between overlapping items, so every node executes them
+  // alike. Earlier blocks are planned with a single stage per slice, as they always were.
+  bool const staged =
+      chain::IsActive(chain::BlockVersion::OBSERVED_LANE_PACKING, block.block_number);
 
   uint64_t slice_index = 0;
   for (auto const &slice : block.slices)
   {
-    auto &slice_plan = execution_plan_[slice_index];
+    std::size_t const      first_stage = execution_plan_.size();
+    std::vector<BitVector> stage_masks{};
+
+    execution_plan_.emplace_back();
+    stage_masks.emplace_back(std::size_t{1} << log2_num_lanes_);
 
     // process the transactions
     for (auto const &tx : slice)
@@ -219,14 +270,56 @@ bool ExecutionManager::PlanExecution(Block const &block)
       // and some level of dynamic scaling should be applied.
       assert((1u << log2_num_lanes_) == tx.mask().size());
 
+      std::size_t stage = 0;
+      if (staged)
+      {
+        stage = stage_masks.size();
+        while ((stage > 0) && !stage_masks[stage - 1].Intersects(tx.mask()))
+        {
+          --stage;
+        }
+
+        if (stage == stage_masks.size())
+        {
+          execution_plan_.emplace_back();
+          stage_masks.emplace_back(tx.mask().size());
+        }
+      }
+
+      stage_masks[stage] |= tx.mask();
+
       // insert the item into the execution plan
-      slice_plan.emplace_back(
+      execution_plan_[first_stage + stage].emplace_back(
           std::make_unique<ExecutionItem>(tx.digest(), block.block_number, slice_index, tx.mask()));
     }
 
     ++slice_index;
   }
 
+  // In optimistic mode the whole block is flattened into a single list (preserving the slice
+  // ordering) since all the transactions are executed speculatively in parallel and then
+  // validated and committed in order.
+  if (optimistic_)
+  {
+    ExecutionItemList flattened{};
+    for (auto &slice_plan : execution_plan_)
+    {
+      for (auto &item : slice_plan)
+      {
+        flattened.emplace_back(std::move(item));
+      }
+    }
+
+    execution_plan_.clear();
+    access_sets_.clear();
+
+    if (!flattened.empty())
+    {
+      access_sets_.resize(flattened.size());
+      execution_plan_.emplace_back(std::move(flattened));
+    }
+  }
+
   return true;
 }
 
@@ -290,6 +383,283 @@ void ExecutionManager::DispatchExecution(ExecutionItem &item)
   }
 }
 
+/**
+ * Speculatively executes an item on one of the speculative executors. All the writes generated by
+ * the transaction are buffered and will only be applied during the commit phase.
+ *
+ * This function should be called from a context of a thread pool
+ *
+ * @param index The index of the item in the (flattened) execution plan
+ * @param item The execution item to dispatch
+ */
+void ExecutionManager::DispatchSpeculativeExecution(std::size_t index, ExecutionItem &item)
+{
+  auto speculative = AcquireSpeculativeExecutor();
+
+  if (speculative.executor)
+  {
+    counters_.ApplyVoid([](auto &counters) { ++counters.active; });
+
+    speculative.storage->Begin();
+    item.Execute(*speculative.executor);
+    access_sets_[index] = speculative.storage->TakeAccessSet();
+
+    counters_.ApplyVoid([](auto &counters) {
+      --counters.active;
+      --counters.remaining;
+    });
+
+    ReleaseSpeculativeExecutor(std::move(speculative));
+  }
+  else
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Failed to secure an idle speculative executor");
+
+    // signal that the item must be executed during the commit phase
+    access_sets_[index].reads.clear();
+    access_sets_[index].writes.clear();
+    item.Reset();
+
+    counters_.ApplyVoid([](auto &counters) { --counters.remaining; });
+  }
+}
+
+/**
+ * Validates and commits the speculative executions of the items in order. Any item which has read
+ * a value that has been modified by an earlier item of the block is executed again against the
+ * updated state, which makes the overall result identical to executing the items sequentially.
+ *
+ * This function must be called from the monitor thread once all the speculative executions have
+ * completed.
+ *
+ * @param items The items of the flattened execution plan
+ * @return The number of items which were processed
+ */
+std::size_t ExecutionManager::CommitSpeculativeExecution(ExecutionItemList const &items)
+{
+  SpeculativeStorageAdapter::KeySet dirty_keys{};
+
+  std::size_t index{0};
+  for (; index < items.size(); ++index)
+  {
+    auto &item   = *items[index];
+    auto &access = access_sets_[index];
+
+    bool const not_run = (ExecutorInterface::Status::NOT_RUN == item.result().status);
+
+    if (not_run || access.ConflictsWith(dirty_keys))
+    {
+      auto speculative = AcquireSpeculativeExecutor();
+      if (!speculative.executor)
+      {
+        FETCH_LOG_ERROR(LOGGING_NAME, "Failed to secure an executor to re-execute tx: 0x",
+                        item.digest().ToHex());
+
+        // signal the stall to the monitor
+        item.Reset();
+        access_sets_.clear();
+
+        return index + 1;
+      }
+
+      // execute the item again against the updated state
+      item.Reset();
+      speculative.storage->Begin();
+      item.Execute(*speculative.executor);
+      access = speculative.storage->TakeAccessSet();
+
+      ReleaseSpeculativeExecutor(std::move(speculative));
+      tx_reexecuted_count_->increment();
+    }
+
+    auto const &result{item.result()};
+    if (ExecutorInterface::Status::SUCCESS != result.status)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Error executing tx: 0x", item.digest().ToHex(),
+                     " status: ", ledger::ToString(result.status));
+    }
+
+    // in the deterministic mode no further slices would be executed after a stall or fatal error
+    auto const category = Categorise(result.status);
+    if ((ExecutionStatusCategory::INTERNAL_ERROR == category) ||
+        (ExecutionStatusCategory::BLOCK_INVALIDATING_ERROR == category))
+    {
+      ++index;
+      break;
+    }
+
+    access.ApplyTo(*state_cache_, dirty_keys);
+
+    ++completed_executions_;
+    tx_executed_count_->increment();
+  }
+
+  access_sets_.clear();
+
+  return index;
+}
+
+ExecutionManager::SpeculativeExecutor ExecutionManager::AcquireSpeculativeExecutor()
+{
+  SpeculativeExecutor speculative{};
+
+  FETCH_LOCK(speculative_executors_lock_);
+  if (!speculative_executors_.empty())
+  {
+    speculative = std::move(speculative_executors_.back());
+    speculative_executors_.pop_back();
+  }
+
+  return speculative;
+}
+
+void ExecutionManager::ReleaseSpeculativeExecutor(SpeculativeExecutor executor)
+{
+  FETCH_LOCK(speculative_executors_lock_);
+  speculative_executors_.emplace_back(std::move(executor));
+}
+
+/**
+ * Enable the optimistic execution of blocks. Instead of executing each slice in turn, all the
+ * transactions in the block are executed speculatively in parallel and then validated and
+ * committed in block order, re-executing only the transactions which conflict.
+ *
+ * @param factory The factory used to create executors for the speculative storage units
+ */
+void ExecutionManager::EnableOptimisticExecution(SpeculativeExecutorFactory const &factory)
+{
+  if (running_)
+  {
+    throw std::runtime_error("Optimistic execution must be enabled before starting");
+  }
+
+  {
+    FETCH_LOCK(speculative_executors_lock_);
+
+    speculative_executors_.clear();
+    speculative_executors_.reserve(num_executors_);
+
+    for (std::size_t i = 0; i < num_executors_; ++i)
+    {
+      SpeculativeExecutor speculative{};
+      speculative.storage  = std::make_shared<SpeculativeStorageAdapter>(*state_cache_);
+      speculative.executor = factory(speculative.storage);
+      assert(static_cast<bool>(speculative.executor));
+
+      speculative_executors_.emplace_back(std::move(speculative));
+    }
+  }
+
+  optimistic_ = true;
+}
+
+bool ExecutionManager::IsOptimisticExecutionEnabled() const
+{
+  return optimistic_;
+}
+
+/**
+ * Enable the pre-execution of pending transactions. While the manager is idle, transactions can
+ * be executed speculatively against the latest state in order to observe the lanes that they
+ * actually use. None of the state changes are ever applied.
+ *
+ * @param factory The factory used to create the executor for the speculative storage unit
+ */
+void ExecutionManager::EnablePreExecution(SpeculativeExecutorFactory const &factory)
+{
+  if (running_)
+  {
+    throw std::runtime_error("Pre-execution must be enabled before starting");
+  }
+
+  FETCH_LOCK(pre_execution_lock_);
+
+  pre_executor_.storage  = std::make_shared<SpeculativeStorageAdapter>(*state_cache_);
+  pre_executor_.executor = factory(pre_executor_.storage);
+  assert(static_cast<bool>(pre_executor_.executor));
+}
+
+bool ExecutionManager::IsPreExecutionEnabled() const
+{
+  return static_cast<bool>(pre_executor_.executor);
+}
+
+/**
+ * Speculatively execute a pending transaction against the latest state, as if it were in the next
+ * block, and determine the lanes of the resources that it read or wrote. The lanes are always a
+ * subset of the declared shards. When the transaction does not execute successfully the declared
+ * shards are reported, since nothing can be inferred from a partial execution.
+ *
+ * Pre-execution only takes place while the manager is idle, blocks which are scheduled in the
+ * meantime wait for the pre-execution in progress to complete.
+ *
+ * @param digest The digest of the transaction
+ * @param shards The shards declared by the transaction
+ * @param lanes The output lanes used by the transaction
+ * @return true if the transaction was pre-executed, otherwise false if pre-execution is not enabled
+ * or the manager is busy
+ */
+bool ExecutionManager::PreExecute(Digest const &digest, BitVector const &shards, BitVector &lanes)
+{
+  if (!pre_executor_.executor || !running_ ||
+      (shards.size() != (std::size_t{1} << log2_num_lanes_)))
+  {
+    return false;
+  }
+
+  FETCH_LOCK(pre_execution_lock_);
+
+  // observed lanes are only used to pack blocks of the version which can plan their overlaps
+  auto const summary = state_.Apply([](Summary const &s) { return s; });
+  if ((State::IDLE != summary.state) ||
+      !chain::IsActive(chain::BlockVersion::OBSERVED_LANE_PACKING, summary.last_block_number + 1u))
+  {
+    return false;
+  }
+
+  ExecutionItem item{digest, summary.last_block_number + 1u, 0, shards};
+
+  pre_executor_.storage->Begin();
+  item.Execute(*pre_executor_.executor);
+  auto const access = pre_executor_.storage->TakeAccessSet();
+
+  tx_pre_executed_count_->increment();
+
+  if (ExecutorInterface::Status::SUCCESS != item.result().status)
+  {
+    lanes = shards;
+    return true;
+  }
+
+  lanes = BitVector{shards.size()};
+  for (auto const &key : access.reads)
+  {
+    lanes.set(key.lane(log2_num_lanes_), 1);
+  }
+
+  for (auto const &write : access.writes)
+  {
+    lanes.set(write.first.lane(log2_num_lanes_), 1);
+  }
+
+  // resources outside of the declared shards can never be accessed by the real execution
+  lanes &= shards;
+
+  return true;
+}
+
+/**
+ * Restrict the executor threads to sets of CPUs. Executor `n` is restricted to the entry
+ * `n % affinity.size()`. Since the work for lane `n` is dispatched to executor
+ * `n % num_executors`, this allows executors to be placed alongside the lanes they serve.
+ *
+ * @param affinity The CPUs for each of the executors, or an empty list for no restriction
+ */
+void ExecutionManager::SetAffinity(std::vector<core::CpuList> affinity)
+{
+  thread_pool_->SetAffinity(std::move(affinity));
+}
+
 /**
  * Starts the execution manager running
  */
@@ -361,6 +731,13 @@ ExecutionManager::State ExecutionManager::GetState()
   return state_.Apply([](Summary const &summary) { return summary.state; });
 }
 
+void ExecutionManager::SetCompletionCallback(CompletionCallback callback)
+{
+  completion_callback_.ApplyVoid([&callback](CompletionCallback &completion_callback) {
+    completion_callback = std::move(callback);
+  });
+}
+
 bool ExecutionManager::Abort()
 {
   // TODO(private issue 533): Implement user execution abort
@@ -426,6 +803,14 @@ void ExecutionManager::MonitorThreadEntrypoint()
 
       FETCH_LOG_DEBUG(LOGGING_NAME, "Now Idle");
 
+      // signal any waiting parties that execution has finished
+      completion_callback_.ApplyVoid([](CompletionCallback const &completion_callback) {
+        if (completion_callback)
+        {
+          completion_callback();
+        }
+      });
+
       // enter the idle state where we wait for the next block to be posted
       {
         std::unique_lock<std::mutex> lock(monitor_lock_);
@@ -472,13 +857,31 @@ void ExecutionManager::MonitorThreadEntrypoint()
         });
 
         auto self = shared_from_this();
-        for (auto &item : slice_plan)
+        if (optimistic_)
+        {
+          for (std::size_t index = 0; index < slice_plan.size(); ++index)
+          {
+            auto &item = slice_plan[index];
+
+            // create the closure and dispatch to the thread pool, keeping work on the same lane
+            // with the same thread
+            thread_pool_->PostWithAffinity(*item->shards().begin(), [self, index, &item]() {
+              telemetry::FunctionTimer const timer{*(self->execution_duration_)};
+              self->DispatchSpeculativeExecution(index, *item);
+            });
+          }
+        }
+        else
         {
-          // create the closure and dispatch to the thread pool
-          thread_pool_->Post([self, &item]() {
-            telemetry::FunctionTimer const timer{*(self->execution_duration_)};
-            self->DispatchExecution(*item);
-          });
+          for (auto &item : slice_plan)
+          {
+            // create the closure and dispatch to the thread pool, keeping work on the same lane
+            // with the same thread
+            thread_pool_->PostWithAffinity(*item->shards().begin(), [self, &item]() {
+              telemetry::FunctionTimer const timer{*(self->execution_duration_)};
+              self->DispatchExecution(*item);
+            });
+          }
         }
 
         monitor_state = MonitorState::RUNNING;
@@ -508,9 +911,16 @@ void ExecutionManager::MonitorThreadEntrypoint()
         std::size_t num_errors{0};
         std::size_t num_fatal_errors{0};
 
+        auto const &slice_plan = execution_plan_[current_slice];
+
+        // in optimistic mode the speculative results need to be validated and committed
+        std::size_t const num_processed =
+            optimistic_ ? CommitSpeculativeExecution(slice_plan) : slice_plan.size();
+
         // look through all execution items and determine if it was successful
-        for (auto const &item : execution_plan_[current_slice])
+        for (std::size_t index = 0; index < num_processed; ++index)
         {
+          auto const &item = slice_plan[index];
           assert(item);
 
           switch (Categorise(item->result().status))
@@ -541,6 +951,8 @@ void ExecutionManager::MonitorThreadEntrypoint()
           {
             tx_status_cache_->Update(item->digest(), item->result());
           }
+
+          TransactionTracer::Instance().Record(item->digest(), TraceStage::EXECUTED);
         }
 
         // only provide debug if required
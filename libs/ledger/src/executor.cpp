@@ -51,9 +51,11 @@ namespace ledger {
  * Construct a Executor given a storage unit
  *
  * @param storage The storage unit to be used
+ * @param sharded_balances The accounts with sharded balances, if any
  */
-Executor::Executor(StorageUnitPtr storage)
+Executor::Executor(StorageUnitPtr storage, ShardedBalancesPtr sharded_balances)
   : storage_{std::move(storage)}
+  , token_contract_{std::move(sharded_balances)}
   , tx_validator_{*storage_, token_contract_}
   , fee_manager_{token_contract_, "ledger_executor_deduct_fees_duration"}
   , overall_duration_{Registry::Instance().LookupMeasurement<Histogram>(
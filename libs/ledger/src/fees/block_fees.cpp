@@ -0,0 +1,58 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/fees/block_fees.hpp"
+
+#include <limits>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Add to the fees owed by an address
+ *
+ * @param address The address paying the fee
+ * @param amount The fee
+ */
+void BlockFees::Charge(chain::Address const &address, TokenAmount amount)
+{
+  auto &owed = debits_[address];
+
+  // saturate, the fee collected is bounded by the balance of the address anyway
+  owed = (amount > std::numeric_limits<TokenAmount>::max() - owed)
+             ? std::numeric_limits<TokenAmount>::max()
+             : owed + amount;
+}
+
+BlockFees::Debits const &BlockFees::debits() const
+{
+  return debits_;
+}
+
+bool BlockFees::empty() const
+{
+  return debits_.empty();
+}
+
+void BlockFees::Clear()
+{
+  debits_.clear();
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/sharded_balances.hpp"
 #include "ledger/chaincode/contract_context.hpp"
 #include "ledger/chaincode/contract_context_attacher.hpp"
 #include "ledger/execution_result.hpp"
@@ -37,6 +38,42 @@ namespace {
 
 constexpr char const *LOGGING_NAME = "FeeManager";
 
+using TokenAmount = FeeManager::TokenAmount;
+
+TokenAmount CalculateFee(FeeManager::TransactionDetails const &tx,
+                         FeeManager::Result const &            result)
+{
+  // on failed transactions the whole charge limit is taken
+  if (ContractExecutionStatus::SUCCESS != result.status)
+  {
+    return tx.charge_limit * tx.charge_rate;
+  }
+
+  return result.charge * tx.charge_rate;
+}
+
+/**
+ * The shard mask containing only the token balance of an address
+ */
+BitVector TokenShard(chain::Address const &address, uint32_t log2_num_lanes,
+                     chain::ShardedBalances const &sharded_balances)
+{
+  ResourceAddress resource_address{"fetch.token.state." + address.display()};
+
+  BitVector shard{1u << log2_num_lanes};
+  if (sharded_balances.Contains(address))
+  {
+    // the sub-balances of a sharded balance are spread over every lane
+    shard.SetAllOne();
+  }
+  else
+  {
+    shard.set(resource_address.lane(log2_num_lanes), 1);
+  }
+
+  return shard;
+}
+
 }  // namespace
 
 FeeManager::TransactionDetails::TransactionDetails(chain::Transaction &tx, BitVector const &shards)
@@ -118,13 +155,8 @@ void FeeManager::Execute(TransactionDetails &tx, Result &result, BlockIndex cons
   uint64_t const          balance = token_contract_.GetBalance(from);
 
   // calculate the fee to deduct
-  TokenAmount tx_fee = result.charge * tx.charge_rate;
-  if (Status::SUCCESS != result.status)
-  {
-    tx_fee = tx.charge_limit * tx.charge_rate;
-  }
+  TokenAmount const tx_fee = CalculateFee(tx, result);
 
-  // on failed transactions
   result.fee = std::min(balance, tx_fee);
 
   // deduct the fee from the originator
@@ -141,12 +173,8 @@ void FeeManager::SettleFees(chain::Address const &miner, TokenAmount amount,
     return;
   }
 
-  // compute the resource address
-  ResourceAddress resource_address{"fetch.token.state." + miner.display()};
-
-  // create the complete shard mask
-  BitVector shard{1u << log2_num_lanes};
-  shard.set(resource_address.lane(log2_num_lanes), 1);
+  // create the shard mask of the miner balance
+  BitVector const shard = TokenShard(miner, log2_num_lanes, token_contract_.sharded_balances());
 
   // attach the token contract to the storage engine
   StateSentinelAdapter storage_adapter{storage, "fetch.token", shard};
@@ -156,5 +184,63 @@ void FeeManager::SettleFees(chain::Address const &miner, TokenAmount amount,
   token_contract_.AddTokens(miner, amount);
 }
 
+/**
+ * Record the fee of a transaction to be settled at the end of the block. The fee of the result is
+ * the most that will be collected, since the balance of the originator is only checked then.
+ *
+ * @param tx The details of the transaction
+ * @param result The execution result of the transaction
+ * @param fees The fees of the block
+ */
+void FeeManager::Execute(TransactionDetails &tx, Result &result, BlockFees &fees)
+{
+  result.fee = CalculateFee(tx, result);
+
+  fees.Charge(tx.from, result.fee);
+}
+
+/**
+ * Settle the fees of a block, deducting them once from each originator and paying everything
+ * collected to the miner at once. The result is the same as settling the fees of the block one
+ * transaction at a time, as long as the balances of the originators are not otherwise changed in
+ * between.
+ *
+ * @param miner The miner of the block
+ * @param fees The fees of the block
+ * @param log2_num_lanes The log2 number of lanes
+ * @param block The block index
+ * @param storage The storage engine
+ * @return The total fees collected
+ */
+TokenAmount FeeManager::SettleFees(chain::Address const &miner, BlockFees const &fees,
+                                   uint32_t log2_num_lanes, BlockIndex const &block,
+                                   StorageInterface &storage)
+{
+  telemetry::FunctionTimer const timer{*deduct_fees_duration_};
+
+  TokenAmount collected{0};
+  for (auto const &debit : fees.debits())
+  {
+    auto const &from = debit.first;
+
+    // attach the token contract to the storage engine
+    StateSentinelAdapter storage_adapter{
+        storage, "fetch.token",
+        TokenShard(from, log2_num_lanes, token_contract_.sharded_balances())};
+
+    ContractContext context{&token_contract_, from, nullptr, &storage_adapter, block};
+    ContractContextAttacher raii(token_contract_, context);
+
+    TokenAmount const fee = std::min(token_contract_.GetBalance(from), debit.second);
+    token_contract_.SubtractTokens(from, fee);
+
+    collected += fee;
+  }
+
+  SettleFees(miner, collected, miner, log2_num_lanes, block, storage);
+
+  return collected;
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -57,6 +57,9 @@ constexpr uint64_t    FET_MULTIPLIER = 10000000000ull;
 constexpr char const *LOGGING_NAME   = "GenesisFile";
 constexpr int         VERSION        = 4;
 
+// the state key under which the accounts with sharded balances are recorded at genesis
+constexpr char const *SHARDED_BALANCE_ACCOUNTS_KEY = "fetch.token.sharded_balance_accounts";
+
 enum class FileReadStatus
 {
   SUCCESS,
@@ -131,6 +134,12 @@ GenesisFileCreator::Result GenesisFileCreator::LoadContents(ConstByteArray const
       params.whitelist    = genesis_block_.block_entropy.qualified;
       params.cabinet_size = static_cast<uint16_t>(params.whitelist.size());
 
+      if (!RestoreShardedBalanceAccounts(params.sharded_balance_accounts))
+      {
+        FETCH_LOG_ERROR(LOGGING_NAME, "Unable to restore the sharded balance accounts");
+        return Result::FAILURE;
+      }
+
       return Result::LOADED_PREVIOUS_GENESIS;
     }
   }
@@ -182,6 +191,18 @@ GenesisFileCreator::Result GenesisFileCreator::LoadContents(ConstByteArray const
         FETCH_LOG_WARN(LOGGING_NAME, "No consensus information inside genesis file");
       }
 
+      // the accounts with sharded balances are optional
+      if (doc.Has("shardedBalances"))
+      {
+        if (!LoadShardedBalanceAccounts(doc["shardedBalances"], params.sharded_balance_accounts))
+        {
+          FETCH_LOG_WARN(LOGGING_NAME, "Failed to load the sharded balance accounts");
+          return Result::FAILURE;
+        }
+
+        sharded_balance_accounts_ = params.sharded_balance_accounts;
+      }
+
       success &= LoadState(doc["accounts"], consensus_params);
     }
     else
@@ -218,6 +239,12 @@ bool GenesisFileCreator::LoadState(Variant const &object, ConsensusParameters co
     return false;
   }
 
+  // the wallet records are collected and imported into the state in a single batch
+  StorageInterface::ResourceAddresses wallet_keys{};
+  StorageInterface::StateValues       wallet_records{};
+  wallet_keys.reserve(object.size());
+  wallet_records.reserve(object.size());
+
   // iterate over all of the Identity + stake amount mappings
   uint64_t remaining_supply{TOTAL_SUPPLY};
   for (std::size_t i = 0, end = object.size(); i < end; ++i)
@@ -267,15 +294,14 @@ bool GenesisFileCreator::LoadState(Variant const &object, ConsensusParameters co
         }
       }
 
-      ResourceAddress const wallet_key{"fetch.token.state." + address.display()};
+      wallet_keys.emplace_back(ResourceAddress{"fetch.token.state." + address.display()});
 
       {
         // serialize the record to the buffer
         serializers::LargeObjectSerializeHelper buffer;
         buffer << record;
 
-        // store the buffer
-        storage_unit_.Set(wallet_key, buffer.data());
+        wallet_records.emplace_back(buffer.data());
       }
     }
     else
@@ -292,6 +318,21 @@ bool GenesisFileCreator::LoadState(Variant const &object, ConsensusParameters co
     return false;
   }
 
+  // the accounts with sharded balances are recorded in the state so that they are covered by the
+  // genesis merkle root, and can be restored when the node is restarted
+  if (!sharded_balance_accounts_.empty())
+  {
+    serializers::LargeObjectSerializeHelper buffer;
+    buffer << sharded_balance_accounts_;
+
+    wallet_keys.emplace_back(ResourceAddress{SHARDED_BALANCE_ACCOUNTS_KEY});
+    wallet_records.emplace_back(buffer.data());
+  }
+
+  // store all of the wallet records
+  FETCH_LOG_INFO(LOGGING_NAME, "Importing ", wallet_keys.size(), " genesis wallet records");
+  storage_unit_.Import(wallet_keys, wallet_records);
+
   // if we have been configured for consensus then we need to also write the stake information to
   // the state database
   if (consensus != nullptr)
@@ -384,5 +425,66 @@ bool GenesisFileCreator::LoadConsensus(Variant const &object, ConsensusParameter
   return true;
 }
 
+/**
+ * Parse the accounts whose token balances are sharded over the lanes
+ *
+ * @param object The array of account addresses
+ * @param accounts The output accounts
+ * @return true if successful, otherwise false
+ */
+bool GenesisFileCreator::LoadShardedBalanceAccounts(Variant const &object, Addresses &accounts)
+{
+  if (!object.IsArray())
+  {
+    return false;
+  }
+
+  accounts.clear();
+  for (std::size_t i = 0, end = object.size(); i < end; ++i)
+  {
+    chain::Address address{};
+    if (!object[i].IsString() || !chain::Address::Parse(object[i].As<ConstByteArray>(), address))
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Unable to parse sharded balance account from genesis file");
+      return false;
+    }
+
+    accounts.emplace_back(std::move(address));
+  }
+
+  return true;
+}
+
+/**
+ * Read back the accounts with sharded balances which were recorded in the state at genesis
+ *
+ * @param accounts The output accounts
+ * @return true if successful, otherwise false
+ */
+bool GenesisFileCreator::RestoreShardedBalanceAccounts(Addresses &accounts)
+{
+  accounts.clear();
+
+  auto const document = storage_unit_.Get(ResourceAddress{SHARDED_BALANCE_ACCOUNTS_KEY});
+  if (document.failed)
+  {
+    // the genesis did not configure any sharded balances
+    return true;
+  }
+
+  try
+  {
+    serializers::LargeObjectSerializeHelper buffer{document.document};
+    buffer >> accounts;
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to decode the sharded balance accounts: ", ex.what());
+    return false;
+  }
+
+  return true;
+}
+
 }  // namespace ledger
 }  // namespace fetch
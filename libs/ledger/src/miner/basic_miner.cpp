@@ -19,9 +19,11 @@
 #include "chain/address.hpp"
 #include "chain/transaction.hpp"
 #include "chain/transaction_validity_period.hpp"
+#include "core/random/lcg.hpp"
 #include "ledger/chain/block.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/miner/basic_miner.hpp"
+#include "ledger/transaction_tracer.hpp"
 #include "logging/logging.hpp"
 #include "telemetry/counter.hpp"
 #include "telemetry/gauge.hpp"
@@ -30,9 +32,10 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cmath>
 #include <cstdint>
-#include <iterator>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace fetch {
@@ -54,18 +57,211 @@ T Clip3(T value, T min_value, T max_value)
   return std::min(std::max(value, min_value), max_value);
 }
 
+using TransactionLayout = chain::TransactionLayout;
+using TokenAmount       = TransactionLayout::TokenAmount;
+using Candidates        = std::vector<TransactionLayout>;
+using Masks             = std::vector<BitVector>;
+using Rng               = random::LinearCongruentialGenerator;
+
+constexpr std::size_t MAX_POOL_CANDIDATES = 64;   ///< Queued txs considered when refining a slice
+constexpr std::size_t MAX_RESTARTS        = 8;    ///< Upper bound on parallel annealing restarts
+constexpr std::size_t NUM_SWEEPS          = 200;  ///< Annealing sweeps per restart
+constexpr double      BETA_START          = 0.1;
+constexpr double      BETA_END            = 10.0;
+constexpr double      FEE_WEIGHT          = 0.5;  ///< Fee contribution relative to a single lane
+
+/**
+ * The lane conflict graph of a set of candidate transactions for a single slice
+ */
+struct PackingProblem
+{
+  PackingProblem(Candidates const &candidates, Masks lane_masks);
+
+  Masks                                 masks;      ///< The packing mask of each candidate
+  std::vector<std::vector<std::size_t>> conflicts;  ///< Adjacency list of conflicting candidates
+  std::vector<double>                   values;     ///< The value of including each candidate
+  std::vector<std::size_t>              order;      ///< Candidates ordered by decreasing value
+  double                                penalty{0};  ///< Cost of each selected conflicting pair
+};
+
+/**
+ * A conflict free selection of candidates along with its lane occupancy and collected fees
+ */
+struct Packing
+{
+  std::vector<uint8_t> selected{};
+  std::size_t          lanes{0};
+  TokenAmount          fees{0};
+
+  bool IsBetterThan(Packing const &other) const
+  {
+    return (lanes > other.lanes) || ((lanes == other.lanes) && (fees > other.fees));
+  }
+};
+
+PackingProblem::PackingProblem(Candidates const &candidates, Masks lane_masks)
+  : masks(std::move(lane_masks))
+  , conflicts(candidates.size())
+  , values(candidates.size())
+  , order(candidates.size())
+{
+  TokenAmount max_fee{1};
+  for (auto const &candidate : candidates)
+  {
+    max_fee = std::max(max_fee, candidate.charge_rate());
+  }
+
+  for (std::size_t i = 0; i < candidates.size(); ++i)
+  {
+    BitVector const &mask = masks[i];
+
+    values[i] = static_cast<double>(mask.PopCount()) +
+                (FEE_WEIGHT * static_cast<double>(candidates[i].charge_rate()) /
+                 static_cast<double>(max_fee));
+    penalty   = std::max(penalty, 2.0 * values[i]);
+    order[i]  = i;
+
+    for (std::size_t j = i + 1; j < candidates.size(); ++j)
+    {
+      if (mask.Intersects(masks[j]))
+      {
+        conflicts[i].push_back(j);
+        conflicts[j].push_back(i);
+      }
+    }
+  }
+
+  std::stable_sort(order.begin(), order.end(),
+                   [this](std::size_t a, std::size_t b) { return values[a] > values[b]; });
+}
+
+/**
+ * Convert an arbitrary (possibly conflicting) selection into a valid packing. Selected candidates
+ * are kept in order of decreasing value when they fit, then any remaining lanes are filled in the
+ * same order from the unselected candidates.
+ *
+ * @param problem The conflict graph of the candidates
+ * @param candidates The candidate transactions
+ * @param state The raw selection to be repaired
+ * @param num_lanes The number of lanes for the block
+ * @return The conflict free packing
+ */
+Packing Repair(PackingProblem const &problem, Candidates const &candidates,
+               std::vector<uint8_t> const &state, std::size_t num_lanes)
+{
+  Packing   packing{};
+  BitVector lanes{num_lanes};
+
+  packing.selected.resize(candidates.size(), 0);
+
+  for (uint8_t const preferred : {uint8_t{1}, uint8_t{0}})
+  {
+    for (std::size_t const i : problem.order)
+    {
+      if ((state[i] != preferred) || packing.selected[i])
+      {
+        continue;
+      }
+
+      BitVector const &mask = problem.masks[i];
+      if (!lanes.Intersects(mask))
+      {
+        lanes |= mask;
+        packing.selected[i] = 1;
+        packing.fees += candidates[i].charge_rate();
+      }
+    }
+  }
+
+  packing.lanes = lanes.PopCount();
+
+  return packing;
+}
+
+/**
+ * Run a single simulated annealing restart over the candidate selection. The energy being
+ * minimised is the negative value of the selected candidates plus a penalty for each selected
+ * pair of conflicting candidates.
+ *
+ * @param problem The conflict graph of the candidates
+ * @param candidates The candidate transactions
+ * @param num_lanes The number of lanes for the block
+ * @param seed The seed for this restart
+ * @param deadline The point in time after which the restart must stop sweeping
+ * @return The repaired packing for the final state of the restart
+ */
+Packing Anneal(PackingProblem const &problem, Candidates const &candidates, std::size_t num_lanes,
+               uint64_t seed, std::chrono::steady_clock::time_point const &deadline)
+{
+  std::size_t const num_candidates = candidates.size();
+
+  Rng                   rng{seed};
+  std::vector<uint8_t>  state(num_candidates, 0);
+  std::vector<uint32_t> clashes(num_candidates, 0);  // selected neighbours of each candidate
+
+  auto const flip = [&](std::size_t i) {
+    state[i] ^= 1u;
+    for (std::size_t const j : problem.conflicts[i])
+    {
+      clashes[j] = state[i] ? clashes[j] + 1 : clashes[j] - 1;
+    }
+  };
+
+  // start from a random selection
+  for (std::size_t i = 0; i < num_candidates; ++i)
+  {
+    if (rng() >> 63u)
+    {
+      flip(i);
+    }
+  }
+
+  double const beta_step = (BETA_END - BETA_START) / static_cast<double>(NUM_SWEEPS - 1);
+  double       beta      = BETA_START;
+
+  for (std::size_t sweep = 0; sweep < NUM_SWEEPS; ++sweep, beta += beta_step)
+  {
+    if (std::chrono::steady_clock::now() >= deadline)
+    {
+      break;
+    }
+
+    for (std::size_t k = 0; k < num_candidates; ++k)
+    {
+      std::size_t const i = static_cast<std::size_t>(rng() >> 32u) % num_candidates;
+
+      // the change in energy when adding the candidate, negated when removing it
+      double delta = (problem.penalty * static_cast<double>(clashes[i])) - problem.values[i];
+      if (state[i])
+      {
+        delta = -delta;
+      }
+
+      if ((delta <= 0) || (rng.AsDouble() < std::exp(-beta * delta)))
+      {
+        flip(i);
+      }
+    }
+  }
+
+  return Repair(problem, candidates, state, num_lanes);
+}
+
 }  // namespace
 
 /**
  * Construct the BasicMiner
  *
  * @param log2_num_lanes Log2 of the number of lanes
- * @param num_slices The number of slices
+ * @param packing_budget The time allowed for refining the slices of each block (zero disables)
  */
-BasicMiner::BasicMiner(uint32_t log2_num_lanes)
+BasicMiner::BasicMiner(uint32_t log2_num_lanes, Duration packing_budget)
   : log2_num_lanes_{log2_num_lanes}
   , max_num_threads_{std::thread::hardware_concurrency()}
+  , packing_budget_{packing_budget}
   , thread_pool_{max_num_threads_, "Miner"}
+  , sharded_balances_{std::make_shared<chain::ShardedBalances>()}
+  , mining_pool_{std::size_t{1} << log2_num_lanes}
   , mining_pool_size_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
         "ledger_miner_mining_pool_size", "The current size of the mining pool")}
   , max_mining_pool_size_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
@@ -77,8 +273,25 @@ BasicMiner::BasicMiner(uint32_t log2_num_lanes)
   , duplicate_filtered_count_{telemetry::Registry::Instance().CreateCounter(
         "ledger_miner_duplicate_filtered_total",
         "The number of duplicate txs on the backend of the queue")}
+  , refined_slice_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_miner_refined_slice_total",
+        "The number of slices whose greedy packing was improved by annealing")}
+  , observed_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_miner_observed_total",
+        "The number of pooled txs whose lanes have been observed by pre-execution")}
 {}
 
+/**
+ * Set the accounts with sharded balances, used to lay out the transactions enqueued from now on
+ *
+ * @param sharded_balances The accounts with sharded balances
+ */
+void BasicMiner::SetShardedBalances(ShardedBalancesPtr sharded_balances)
+{
+  FETCH_LOCK(pending_lock_);
+  sharded_balances_ = std::move(sharded_balances);
+}
+
 /**
  * Add the specified transaction (summary) to the internal queue
  *
@@ -86,7 +299,13 @@ BasicMiner::BasicMiner(uint32_t log2_num_lanes)
  */
 void BasicMiner::EnqueueTransaction(chain::Transaction const &tx)
 {
-  EnqueueTransaction(chain::TransactionLayout{tx, log2_num_lanes_});
+  ShardedBalancesPtr sharded_balances{};
+  {
+    FETCH_LOCK(pending_lock_);
+    sharded_balances = sharded_balances_;
+  }
+
+  EnqueueTransaction(chain::TransactionLayout{tx, log2_num_lanes_, *sharded_balances});
 }
 
 /**
@@ -109,6 +328,7 @@ void BasicMiner::EnqueueTransaction(chain::TransactionLayout const &layout)
 
   if (pending_.Add(layout))
   {
+    recent_layouts_.Add(layout);
     max_pending_pool_size_->max(pending_.size());
     FETCH_LOG_DEBUG(LOGGING_NAME, "Enqueued Transaction (added) 0x", layout.digest().ToHex());
   }
@@ -119,6 +339,56 @@ void BasicMiner::EnqueueTransaction(chain::TransactionLayout const &layout)
   }
 }
 
+/**
+ * Look up a recently enqueued transaction layout, used to rebuild compact blocks from peers
+ *
+ * @param id The short id of the transaction
+ * @param layout The output layout
+ * @return true if the layout was found, otherwise false
+ */
+bool BasicMiner::LookupTransaction(ShortTransactionId id, chain::TransactionLayout &layout) const
+{
+  return recent_layouts_.Lookup(id, layout);
+}
+
+/**
+ * Get the highest fee transactions in the mining pool whose lanes have not yet been observed, i.e.
+ * the transactions which should be pre-executed next
+ *
+ * @param count The maximum number of transactions to return
+ * @return The layouts of the transactions in order of decreasing fee
+ */
+std::vector<chain::TransactionLayout> BasicMiner::GetUnobservedTransactions(std::size_t count)
+{
+  FETCH_LOCK(mining_pool_lock_);
+
+  TransferPending();
+
+  return mining_pool_.Unobserved(count);
+}
+
+/**
+ * Record the lanes that a pooled transaction was observed to use when it was pre-executed. These
+ * are used in place of the declared lanes when packing the transaction into a slice.
+ *
+ * The observation is ignored when the transaction has since left the pool, or when the lanes are
+ * not a subset of the declared lanes. Reporting the declared lanes marks the transaction as
+ * observed without changing how it is packed.
+ *
+ * @param digest The digest of the transaction
+ * @param lanes The lanes observed to be used by the transaction
+ */
+void BasicMiner::SetObservedLanes(Digest const &digest, BitVector const &lanes)
+{
+  FETCH_LOCK(mining_pool_lock_);
+
+  if (mining_pool_.SetObservedMask(digest, lanes))
+  {
+    observed_lanes_[digest] = lanes;
+    observed_count_->increment();
+  }
+}
+
 /**
  * Generate a new block based on the current queue of transactions. Not thread safe.
  *
@@ -132,89 +402,48 @@ void BasicMiner::GenerateBlock(Block &block, std::size_t num_lanes, std::size_t
   FETCH_LOCK(mining_pool_lock_);
   assert(num_lanes == (1u << log2_num_lanes_));
 
-  // splice the contents of the pending queue into the main mining pool
-  {
-    FETCH_LOCK(pending_lock_);
-    mining_pool_.Splice(pending_);
-  }
-
-  std::remove_if(mining_pool_.begin(), mining_pool_.end(), [&block](auto const &tx_layout) {
-    return fetch::chain::GetValidity(tx_layout, block.block_number) !=
-           chain::Transaction::Validity::VALID;
-  });
-
-  // detect the transactions which have already been incorporated into previous blocks
-  auto const duplicates =
-      chain.DetectDuplicateTransactions(block.previous_hash, mining_pool_.TxLayouts());
-
-  duplicate_filtered_count_->add(duplicates.size());
+  TransferPending();
 
-  // remove the duplicates
-  mining_pool_.Remove(duplicates);
+  // discard the transactions which can no longer be included in this (or any later) block
+  mining_pool_.RemoveExpired(block.block_number);
 
   mining_pool_size_->set(mining_pool_.size());
   max_mining_pool_size_->max(mining_pool_.size());
 
-  // cache the size of the mining pool
-  std::size_t const pool_size_before = mining_pool_.size();
-
-  FETCH_LOG_INFO(LOGGING_NAME, "Starting block packing. Pool Size: ", pool_size_before);
-
-  // determine how many of the threads should be used in this block generation
-  auto const num_threads = Clip3<std::size_t>(mining_pool_.size() / 1000u, 1u, max_num_threads_);
+  FETCH_LOG_INFO(LOGGING_NAME, "Starting block packing. Pool Size: ", mining_pool_.size());
 
   // prepare the basic formatting for the block
   block.slices.resize(num_slices);
 
-  // skip thread generation in the simple case
-  if (num_threads == 1)
-  {
-    GenerateSlices(mining_pool_, block, 0, 1, num_lanes);
-  }
-  else if (num_threads > 1)
-  {
-    // split the main queue into a series of smaller queues that can be executed in parallel
-    std::vector<Queue> transaction_lists(num_threads);
-
-    std::size_t const num_tx_per_thread = mining_pool_.size() / num_threads;
-
-    for (std::size_t i = 0; i < num_threads; ++i)
-    {
-      Queue &txs = transaction_lists[i];
+  GenerateSlices(block);
 
-      auto start = mining_pool_.begin();
-      auto end   = start;
-      std::advance(end, static_cast<int32_t>(std::min(num_tx_per_thread, mining_pool_.size())));
+  // spend the remaining packing budget improving the slices which the greedy pass left partially
+  // occupied
+  if (packing_budget_.count() > 0)
+  {
+    std::size_t const refined = RefineSlices(block, num_lanes, Clock::now() + packing_budget_);
 
-      // TODO(private issue XXX): While this efficiently breaks up the transaction queue into even
-      //  chunks it assumes that the fees of the transactions are roughly the same. This algorithm
-      //  should be updated to maximise collected fees for the miner.
+    refined_slice_count_->add(refined);
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Refined ", refined, " of ", num_slices, " slices");
+  }
 
-      // splice in the contents of the array
-      txs.Splice(mining_pool_, start, end);
+  // remove any transactions which have already been incorporated into previous blocks
+  duplicate_filtered_count_->add(RemoveDuplicates(block, chain));
 
-      thread_pool_.Dispatch([&txs, &block, i, num_threads, num_lanes]() {
-        GenerateSlices(txs, block, i, num_threads, num_lanes);
-      });
-    }
+  block.UpdateTimestamp();
 
-    // wait for all the threads to complete
-    thread_pool_.Wait();
+  TransactionTracer::Instance().Record(block, TraceStage::PACKED);
 
-    // return all the transactions to the main queue
-    for (std::size_t i = 0; i < num_threads; ++i)
-    {
-      mining_pool_.Splice(transaction_lists[i]);
-    }
+  std::size_t packed_transactions{0};
+  for (auto const &slice : block.slices)
+  {
+    packed_transactions += slice.size();
   }
 
-  block.UpdateTimestamp();
-
-  std::size_t const remaining_transactions = mining_pool_.size();
-  std::size_t const packed_transactions    = pool_size_before - remaining_transactions;
+  PruneObservedLanes();
 
   FETCH_LOG_INFO(LOGGING_NAME, "Finished block packing (packed: ", packed_transactions,
-                 " remaining: ", remaining_transactions, ")");
+                 " remaining: ", mining_pool_.size(), ")");
 }
 
 /**
@@ -229,87 +458,290 @@ uint64_t BasicMiner::GetBacklog() const
 }
 
 /**
- * Internal: Generate a selection of slices
+ * Discard the transactions in the pending queue and the mining pool which can not be included in
+ * the specified block, or any later one. Should be called as each block is committed, so that
+ * expired transactions do not accumulate in between the blocks generated by this node.
+ *
+ * @param block_index The index of the next block to be packed
+ */
+void BasicMiner::RemoveExpired(uint64_t block_index)
+{
+  FETCH_LOCK(mining_pool_lock_);
+
+  TransferPending();
+
+  std::size_t const expired = mining_pool_.RemoveExpired(block_index);
+  mining_pool_size_->set(mining_pool_.size());
+
+  PruneObservedLanes();
+
+  if (expired > 0)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Removed ", expired, " expired transactions from the pool");
+  }
+}
+
+/**
+ * Internal: Transfer the contents of the pending queue into the mining pool. The mining pool lock
+ * must be held by the caller.
+ */
+void BasicMiner::TransferPending()
+{
+  Queue incoming{};
+
+  {
+    FETCH_LOCK(pending_lock_);
+    incoming.Splice(pending_);
+  }
+
+  for (auto const &layout : incoming)
+  {
+    mining_pool_.Add(layout);
+  }
+}
+
+/**
+ * Internal: Greedily fill the free lanes of each of the slices of the block from the mining pool
  *
- * @param transactions The transaction queue to be used when generating the selection of slices
  * @param block The reference to the block to populate
- * @param offset The slice index offset to start from
- * @param interval The slice index interval to be used when selecting the next slice to populate
- * @param num_lanes The number of lanes of the block
  */
-void BasicMiner::GenerateSlices(Queue &transactions, Block &block, std::size_t offset,
-                                std::size_t interval, std::size_t num_lanes)
+void BasicMiner::GenerateSlices(Block &block)
 {
-  // sort by fees
-  transactions.Sort(SortByFee);
+  for (auto &slice : block.slices)
+  {
+    if (mining_pool_.empty())
+    {
+      break;
+    }
 
-  for (std::size_t slice_idx = offset; slice_idx < block.slices.size(); slice_idx += interval)
+    // the lanes occupied by the existing contents of the slice
+    BitVector occupied{std::size_t{1} << log2_num_lanes_};
+    for (auto const &layout : slice)
+    {
+      occupied |= PackingMask(layout);
+    }
+
+    mining_pool_.PackSlice(slice, std::move(occupied), block.block_number);
+  }
+}
+
+/**
+ * Internal: Get the lanes with which a transaction is packed, i.e. its observed lanes if known,
+ * otherwise its declared lanes. The mining pool lock must be held by the caller.
+ *
+ * @param layout The layout of the transaction
+ * @return The packing mask for the transaction
+ */
+BitVector const &BasicMiner::PackingMask(TransactionLayout const &layout) const
+{
+  auto const it = observed_lanes_.find(layout.digest());
+  if (it != observed_lanes_.end())
   {
-    auto &slice = block.slices[slice_idx];
+    return it->second;
+  }
+
+  return layout.mask();
+}
 
-    // generate the slice
-    GenerateSlice(transactions, slice, slice_idx, num_lanes);
+/**
+ * Internal: Discard the observed lanes of the transactions which are no longer in the mining pool,
+ * either because they have been packed or because they have expired. The mining pool lock must be
+ * held by the caller.
+ */
+void BasicMiner::PruneObservedLanes()
+{
+  for (auto it = observed_lanes_.begin(); it != observed_lanes_.end();)
+  {
+    if (mining_pool_.Contains(it->first))
+    {
+      ++it;
+    }
+    else
+    {
+      it = observed_lanes_.erase(it);
+    }
   }
 }
 
 /**
- * Internal: Generate a slice
+ * Internal: Remove the transactions from the block which have already been incorporated into
+ * previous blocks, refilling the freed lanes from the mining pool until no duplicates remain.
  *
- * @param transactions The transaction queue to be used when generating the slice
- * @param slice The slice to be populated
- * @param slice_index The slice number
- * @param num_lanes The number of lanes for the block
+ * Since the packed layouts have already been removed from the mining pool, the duplicates are
+ * discarded permanently.
+ *
+ * @param block The reference to the block to be checked
+ * @param chain The main chain the block will be added to
+ * @return The number of duplicate transactions which were removed
  */
-void BasicMiner::GenerateSlice(Queue &transactions, Block::Slice &      slice,
-                               std::size_t /*slice_index*/, std::size_t num_lanes)
+std::size_t BasicMiner::RemoveDuplicates(Block &block, MainChain const &chain)
 {
-  BitVector slice_state{num_lanes};
+  std::size_t count{0};
 
-  auto it = transactions.begin();
-  while (it != transactions.end())
+  for (;;)
   {
-    // exit the search loop once the slice is full
-    if (slice_state.PopCount() == num_lanes)
+    MainChain::TransactionLayoutSet packed{};
+    for (auto const &slice : block.slices)
     {
-      break;
+      packed.insert(slice.begin(), slice.end());
     }
 
-    BitVector const &mask = it->mask();
+    auto const duplicates = chain.DetectDuplicateTransactions(block.previous_hash, packed);
+    if (duplicates.empty())
+    {
+      break;
+    }
 
-    // calculate the collisions for this
-    BitVector const collisions = slice_state & mask;
+    count += duplicates.size();
 
-    // determine if there are collisions
-    if (collisions.PopCount() == 0)
+    for (auto &slice : block.slices)
     {
-      // update the slice state
-      slice_state |= mask;
+      slice.erase(std::remove_if(slice.begin(), slice.end(),
+                                 [&duplicates](TransactionLayout const &layout) {
+                                   return duplicates.find(layout.digest()) != duplicates.end();
+                                 }),
+                  slice.end());
+    }
+
+    GenerateSlices(block);
+  }
 
-      // insert the transaction into the slice
-      slice.push_back(*it);
+  return count;
+}
+
+/**
+ * Internal: Attempt to improve the packing of each of the slices of the block in turn, stopping
+ * early once the deadline has been reached
+ *
+ * @param block The reference to the block to refine
+ * @param num_lanes The number of lanes of the block
+ * @param deadline The point in time after which no further refinement is started
+ * @return The number of slices whose packing was replaced
+ */
+std::size_t BasicMiner::RefineSlices(Block &block, std::size_t num_lanes,
+                                     Timepoint const &deadline)
+{
+  std::size_t refined{0};
 
-      // remove the transaction from the main queue
-      it = transactions.Erase(it);
+  for (auto &slice : block.slices)
+  {
+    if (mining_pool_.empty() || (Clock::now() >= deadline))
+    {
+      break;
     }
-    else
+
+    if (RefineSlice(slice, num_lanes, block.block_number, deadline))
     {
-      // advance to the next iterator
-      ++it;
+      ++refined;
     }
   }
+
+  return refined;
 }
 
 /**
- * Sorting method for transactions
+ * Internal: Re-pack a single slice from its current transactions and the best of the mining pool
+ * using a number of parallel annealing restarts. The slice is only updated when the best packing
+ * found is strictly better than the current one.
  *
- * @param a The reference to a transaction entry
- * @param b The reference to the other transaction entry
- * @return true if a is preferable to b, otherwise false
+ * @param slice The slice to be refined
+ * @param num_lanes The number of lanes of the block
+ * @param block_index The block index being packed
+ * @param deadline The point in time after which the restarts must stop
+ * @return true if the slice was updated, otherwise false
  */
-bool BasicMiner::SortByFee(TransactionLayout const &a, TransactionLayout const &b)
+bool BasicMiner::RefineSlice(Block::Slice &slice, std::size_t num_lanes, Block::Index block_index,
+                             Timepoint const &deadline)
 {
-  // this doesn't seem to the a good metric
-  return a.charge_rate() > b.charge_rate();
+  // build the current (greedy) packing for the slice
+  Packing greedy{};
+  for (auto const &tx : slice)
+  {
+    greedy.lanes += PackingMask(tx).PopCount();
+    greedy.fees += tx.charge_rate();
+  }
+
+  // full slices can not be improved upon in terms of utilisation
+  if (greedy.lanes >= num_lanes)
+  {
+    return false;
+  }
+
+  // collect the candidates: the existing contents of the slice followed by the best of the pool
+  Candidates candidates{slice.begin(), slice.end()};
+
+  auto const pool_candidates = mining_pool_.Top(MAX_POOL_CANDIDATES, block_index);
+  candidates.insert(candidates.end(), pool_candidates.begin(), pool_candidates.end());
+
+  Masks masks{};
+  masks.reserve(candidates.size());
+  for (auto const &candidate : candidates)
+  {
+    masks.push_back(PackingMask(candidate));
+  }
+
+  PackingProblem const problem{candidates, std::move(masks)};
+
+  // run the restarts in parallel, each with its own seed
+  std::size_t const    num_restarts = Clip3<std::size_t>(max_num_threads_, 1u, MAX_RESTARTS);
+  std::vector<Packing> results(num_restarts);
+
+  for (std::size_t i = 0; i < num_restarts; ++i)
+  {
+    thread_pool_.Dispatch([&results, &problem, &candidates, num_lanes, &deadline, i]() {
+      results[i] = Anneal(problem, candidates, num_lanes, i + 1, deadline);
+    });
+  }
+
+  thread_pool_.Wait();
+
+  auto const best = std::max_element(
+      results.begin(), results.end(),
+      [](Packing const &a, Packing const &b) { return b.IsBetterThan(a); });
+
+  // fall back to the greedy packing unless annealing found something better
+  if (!best->IsBetterThan(greedy))
+  {
+    return false;
+  }
+
+  Block::Slice                   updated{};
+  std::vector<TransactionLayout> evicted{};
+
+  for (std::size_t i = 0; i < candidates.size(); ++i)
+  {
+    bool const from_pool = i >= slice.size();
+
+    if (best->selected[i])
+    {
+      updated.push_back(candidates[i]);
+
+      if (from_pool)
+      {
+        mining_pool_.Remove(candidates[i].digest());
+      }
+    }
+    else if (!from_pool)
+    {
+      evicted.push_back(candidates[i]);
+    }
+  }
+
+  // return the evicted transactions to the pool so that they can be packed into later slices
+  for (auto const &tx : evicted)
+  {
+    mining_pool_.Add(tx);
+
+    auto const it = observed_lanes_.find(tx.digest());
+    if (it != observed_lanes_.end())
+    {
+      mining_pool_.SetObservedMask(tx.digest(), it->second);
+    }
+  }
+
+  slice = std::move(updated);
+
+  return true;
 }
 
 }  // namespace ledger
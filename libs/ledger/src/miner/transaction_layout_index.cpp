@@ -0,0 +1,437 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "chain/transaction_validity_period.hpp"
+#include "ledger/miner/transaction_layout_index.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t TransactionLayoutIndex::MAX_LANE_SCAN;
+
+/**
+ * Construct an empty index
+ *
+ * @param num_lanes The number of lanes of the layouts being indexed
+ */
+TransactionLayoutIndex::TransactionLayoutIndex(std::size_t num_lanes)
+  : num_lanes_{num_lanes}
+  , by_lane_(num_lanes)
+{}
+
+/**
+ * Get the number of layouts in the index
+ *
+ * @return The number of layouts
+ */
+std::size_t TransactionLayoutIndex::size() const
+{
+  return entries_.size();
+}
+
+/**
+ * Determine if the index is empty
+ *
+ * @return true if there are no layouts in the index, otherwise false
+ */
+bool TransactionLayoutIndex::empty() const
+{
+  return entries_.empty();
+}
+
+/**
+ * Determine if the index contains the layout for the specified digest
+ *
+ * @param digest The digest of the transaction
+ * @return true if present, otherwise false
+ */
+bool TransactionLayoutIndex::Contains(Digest const &digest) const
+{
+  return entries_.find(digest) != entries_.end();
+}
+
+/**
+ * Get a copy of the highest fee layouts which are valid at the specified block index
+ *
+ * @param count The maximum number of layouts to return
+ * @param block_index The block index being packed
+ * @return The layouts in order of decreasing fee
+ */
+TransactionLayoutIndex::Layouts TransactionLayoutIndex::Top(std::size_t count,
+                                                            BlockIndex  block_index) const
+{
+  Layouts layouts{};
+
+  for (auto it = by_fee_.begin(); (it != by_fee_.end()) && (layouts.size() < count); ++it)
+  {
+    auto const &layout = (*it)->layout;
+
+    if (chain::GetValidity(layout, block_index) == chain::Transaction::Validity::VALID)
+    {
+      layouts.push_back(layout);
+    }
+  }
+
+  return layouts;
+}
+
+/**
+ * Get a copy of the highest fee layouts whose lanes have not yet been observed
+ *
+ * @param count The maximum number of layouts to return
+ * @return The layouts in order of decreasing fee
+ */
+TransactionLayoutIndex::Layouts TransactionLayoutIndex::Unobserved(std::size_t count) const
+{
+  Layouts layouts{};
+
+  for (auto it = unobserved_.begin(); (it != unobserved_.end()) && (layouts.size() < count); ++it)
+  {
+    layouts.push_back((*it)->layout);
+  }
+
+  return layouts;
+}
+
+/**
+ * Add a transaction layout to the index
+ *
+ * @param layout The layout to be added
+ * @return true if successful, otherwise false if the layout is a duplicate or has an incompatible
+ * mask
+ */
+bool TransactionLayoutIndex::Add(TransactionLayout const &layout)
+{
+  if (layout.mask().size() != num_lanes_)
+  {
+    return false;
+  }
+
+  auto const result =
+      entries_.emplace(layout.digest(), Entry{layout, next_sequence_, {}, layout.mask(), false});
+  if (!result.second)
+  {
+    return false;
+  }
+
+  ++next_sequence_;
+
+  Entry &entry = result.first->second;
+
+  // update the orderings
+  by_fee_.insert(&entry);
+  by_expiry_.Add(entry.layout.digest(), entry.layout.valid_until());
+  unobserved_.insert(&entry);
+
+  LinkLanes(entry);
+
+  return true;
+}
+
+/**
+ * Remove the layout for the specified digest
+ *
+ * @param digest The digest of the layout to be removed
+ * @return true if successful, otherwise false
+ */
+bool TransactionLayoutIndex::Remove(Digest const &digest)
+{
+  auto const it = entries_.find(digest);
+  if (it == entries_.end())
+  {
+    return false;
+  }
+
+  Erase(it);
+
+  return true;
+}
+
+/**
+ * Remove the layouts for the specified set of digests
+ *
+ * @param digests The set of digests to be removed
+ * @return The number of layouts removed from the index
+ */
+std::size_t TransactionLayoutIndex::Remove(DigestSet const &digests)
+{
+  std::size_t count{0};
+
+  for (auto const &digest : digests)
+  {
+    if (Remove(digest))
+    {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * Remove all the layouts which can no longer be included at (or after) the specified block index
+ *
+ * @param block_index The block index being packed
+ * @return The number of layouts removed from the index
+ */
+std::size_t TransactionLayoutIndex::RemoveExpired(BlockIndex block_index)
+{
+  auto const expired = by_expiry_.RemoveExpired(block_index);
+
+  for (auto const &digest : expired)
+  {
+    Erase(entries_.find(digest));
+  }
+
+  return expired.size();
+}
+
+/**
+ * Narrow the lanes used to pack a layout to those that the transaction has been observed to use.
+ * The layout is marked as observed even if the mask is unchanged.
+ *
+ * Since the transaction is still executed against the lanes declared by its layout, the observed
+ * mask must be a subset of the declared one.
+ *
+ * @param digest The digest of the transaction
+ * @param mask The lanes observed to be used by the transaction
+ * @return true if successful, otherwise false if the layout is not present or the mask is invalid
+ */
+bool TransactionLayoutIndex::SetObservedMask(Digest const &digest, BitVector const &mask)
+{
+  auto const it = entries_.find(digest);
+  if ((it == entries_.end()) || (mask.size() != num_lanes_))
+  {
+    return false;
+  }
+
+  Entry &entry = it->second;
+
+  if ((mask & entry.layout.mask()) != mask)
+  {
+    return false;
+  }
+
+  UnlinkLanes(entry);
+  entry.mask     = mask;
+  entry.observed = true;
+  LinkLanes(entry);
+
+  unobserved_.erase(&entry);
+
+  return true;
+}
+
+/**
+ * Greedily fill the free lanes of a slice with the highest fee layouts which fit, removing them
+ * from the index. The slice may already be partially populated.
+ *
+ * Since a slice only ever becomes more occupied, a layout which is blocked on one of its lanes
+ * remains blocked for the remainder of the slice. Each lane therefore keeps a cursor into its fee
+ * order which only moves forward, and gives up after examining MAX_LANE_SCAN blocked layouts.
+ *
+ * @param slice The slice to be populated
+ * @param block_index The block index being packed
+ * @return The number of layouts added to the slice
+ */
+std::size_t TransactionLayoutIndex::PackSlice(Layouts &slice, BlockIndex block_index)
+{
+  BitVector occupied{num_lanes_};
+  for (auto const &layout : slice)
+  {
+    occupied |= layout.mask();
+  }
+
+  return PackSlice(slice, std::move(occupied), block_index);
+}
+
+/**
+ * Greedily fill the free lanes of a partially populated slice, as above, for the case where the
+ * lanes occupied by the existing contents of the slice are known to the caller
+ *
+ * @param slice The slice to be populated
+ * @param occupied The lanes which are already occupied in the slice
+ * @param block_index The block index being packed
+ * @return The number of layouts added to the slice
+ */
+std::size_t TransactionLayoutIndex::PackSlice(Layouts &slice, BitVector occupied,
+                                              BlockIndex block_index)
+{
+  if (occupied.size() != num_lanes_)
+  {
+    return 0;
+  }
+
+  auto const fits = [&occupied, block_index](Entry const &entry) {
+    for (auto const lane : entry.lanes)
+    {
+      if (occupied.bit(lane))
+      {
+        return false;
+      }
+    }
+
+    return chain::GetValidity(entry.layout, block_index) == chain::Transaction::Validity::VALID;
+  };
+
+  // advance a cursor to the next layout which fits, returning it if found within the scan limit
+  auto const next = [&fits](FeeOrder const &order, FeeOrder::const_iterator &cursor,
+                            std::size_t &scanned) -> EntryPtr {
+    while ((cursor != order.end()) && (scanned < MAX_LANE_SCAN))
+    {
+      if (fits(**cursor))
+      {
+        return *cursor;
+      }
+
+      ++cursor;
+      ++scanned;
+    }
+
+    return nullptr;
+  };
+
+  std::vector<FeeOrder::const_iterator> cursors{};
+  std::vector<std::size_t>              scanned(num_lanes_, 0);
+
+  cursors.reserve(num_lanes_);
+  for (auto const &order : by_lane_)
+  {
+    cursors.push_back(order.begin());
+  }
+
+  FeeOrder::const_iterator unconstrained_cursor = unconstrained_.begin();
+  std::size_t              unconstrained_scanned{0};
+
+  std::size_t added{0};
+  while (occupied.PopCount() < num_lanes_)
+  {
+    // find the highest fee layout which fits amongst the free lanes
+    EntryPtr best = next(unconstrained_, unconstrained_cursor, unconstrained_scanned);
+
+    for (std::size_t lane = 0; lane < num_lanes_; ++lane)
+    {
+      if (occupied.bit(lane))
+      {
+        continue;
+      }
+
+      EntryPtr const candidate = next(by_lane_[lane], cursors[lane], scanned[lane]);
+      if ((candidate != nullptr) && ((best == nullptr) || ByFee{}(candidate, best)))
+      {
+        best = candidate;
+      }
+    }
+
+    if (best == nullptr)
+    {
+      break;
+    }
+
+    // the cursors of all the lanes occupied by the layout are no longer used for this slice, so
+    // only the unconstrained cursor needs to be moved before the entry is erased
+    if ((unconstrained_cursor != unconstrained_.end()) && (*unconstrained_cursor == best))
+    {
+      ++unconstrained_cursor;
+    }
+
+    occupied |= best->mask;
+    slice.push_back(best->layout);
+    Erase(entries_.find(best->layout.digest()));
+    ++added;
+  }
+
+  return added;
+}
+
+/**
+ * Internal: Determine the lanes occupied by an entry from its packing mask and add it to the fee
+ * order of each of them
+ *
+ * @param entry The entry to be linked
+ */
+void TransactionLayoutIndex::LinkLanes(Entry &entry)
+{
+  entry.lanes.clear();
+  for (uint32_t lane = 0; lane < num_lanes_; ++lane)
+  {
+    if (entry.mask.bit(lane))
+    {
+      entry.lanes.push_back(lane);
+    }
+  }
+
+  if (entry.lanes.empty())
+  {
+    unconstrained_.insert(&entry);
+  }
+
+  for (auto const lane : entry.lanes)
+  {
+    by_lane_[lane].insert(&entry);
+  }
+}
+
+/**
+ * Internal: Remove an entry from the fee orders of the lanes that it occupies
+ *
+ * @param entry The entry to be unlinked
+ */
+void TransactionLayoutIndex::UnlinkLanes(Entry const &entry)
+{
+  for (auto const lane : entry.lanes)
+  {
+    by_lane_[lane].erase(&entry);
+  }
+
+  unconstrained_.erase(&entry);
+}
+
+/**
+ * Internal: Remove an entry from the index and all of its orderings
+ *
+ * @param it The iterator to the entry
+ */
+void TransactionLayoutIndex::Erase(Entries::iterator const &it)
+{
+  Entry const *entry = &it->second;
+
+  UnlinkLanes(*entry);
+
+  unobserved_.erase(entry);
+  by_expiry_.Remove(entry->layout.digest(), entry->layout.valid_until());
+  by_fee_.erase(entry);
+
+  entries_.erase(it);
+}
+
+bool TransactionLayoutIndex::ByFee::operator()(EntryPtr const &a, EntryPtr const &b) const
+{
+  if (a->layout.charge_rate() != b->layout.charge_rate())
+  {
+    return a->layout.charge_rate() > b->layout.charge_rate();
+  }
+
+  return a->sequence < b->sequence;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,259 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/protocols/block_sync_pipeline.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t BlockSyncPipeline::MAX_RANGE_ATTEMPTS;
+
+/**
+ * Construct the pipeline
+ *
+ * @param max_buffered_ranges The maximum number of ranges that can be requested ahead of the next
+ * range to be delivered. This bounds the size of the reorder buffer.
+ */
+BlockSyncPipeline::BlockSyncPipeline(std::size_t max_buffered_ranges)
+  : max_buffered_ranges_{std::max<std::size_t>(max_buffered_ranges, 1)}
+{}
+
+/**
+ * Reset the pipeline to download the blocks described by a new skeleton
+ *
+ * @param skeleton The hashes of every `stride`th block, the first entry must already be known
+ * @param stride The number of blocks between the skeleton entries
+ */
+void BlockSyncPipeline::Reset(BlockHashes skeleton, uint64_t stride)
+{
+  skeleton_      = std::move(skeleton);
+  stride_        = stride;
+  next_delivery_ = 0;
+  num_in_flight_ = 0;
+  num_buffered_  = 0;
+
+  entries_.clear();
+  entries_.resize((skeleton_.size() > 1) ? (skeleton_.size() - 1) : 0);
+}
+
+void BlockSyncPipeline::Clear()
+{
+  Reset({}, 0);
+}
+
+/**
+ * Select the next range to be requested from a peer
+ *
+ * @param range The output range
+ * @return true if a range was selected, otherwise false
+ */
+bool BlockSyncPipeline::NextRange(Range &range)
+{
+  std::size_t const end = std::min(entries_.size(), next_delivery_ + max_buffered_ranges_);
+
+  for (std::size_t index = next_delivery_; index < end; ++index)
+  {
+    auto &entry = entries_[index];
+
+    if (Phase::PENDING == entry.phase)
+    {
+      entry.phase = Phase::IN_FLIGHT;
+      ++entry.attempts;
+      ++num_in_flight_;
+
+      range.index  = index;
+      range.first  = skeleton_[index];
+      range.last   = skeleton_[index + 1];
+      range.length = stride_;
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Return a range to pending state after the request for it has failed (or it has been rejected)
+ *
+ * @param index The index of the range
+ * @return true if the range can be retried, false if it has exceeded the maximum attempts
+ */
+bool BlockSyncPipeline::Abandon(std::size_t index)
+{
+  if (index >= entries_.size())
+  {
+    return true;
+  }
+
+  auto &entry = entries_[index];
+  if (Phase::IN_FLIGHT == entry.phase)
+  {
+    entry.phase = Phase::PENDING;
+    --num_in_flight_;
+  }
+
+  return entry.attempts < MAX_RANGE_ATTEMPTS;
+}
+
+/**
+ * Complete a range with the blocks received from a peer
+ *
+ * @param index The index of the range
+ * @param source The peer which supplied the blocks
+ * @param blocks The blocks of the range, in chain order (earliest first)
+ * @return true if the blocks matched the skeleton and have been buffered, otherwise false
+ */
+bool BlockSyncPipeline::Complete(std::size_t index, Address const &source, Blocks blocks)
+{
+  if ((index >= entries_.size()) || (Phase::IN_FLIGHT != entries_[index].phase))
+  {
+    return false;
+  }
+
+  auto &entry = entries_[index];
+  --num_in_flight_;
+
+  if (!Validate(index, blocks))
+  {
+    entry.phase = Phase::PENDING;
+    return false;
+  }
+
+  entry.phase  = Phase::BUFFERED;
+  entry.source = source;
+  entry.blocks = std::move(blocks);
+  ++num_buffered_;
+
+  return true;
+}
+
+/**
+ * Extract the next range of blocks in chain order, if it is available
+ *
+ * @param source The peer which supplied the blocks
+ * @param blocks The blocks of the range, in chain order (earliest first)
+ * @return true if a range was extracted, otherwise false
+ */
+bool BlockSyncPipeline::PopNext(Address &source, Blocks &blocks)
+{
+  if ((next_delivery_ >= entries_.size()) || (Phase::BUFFERED != entries_[next_delivery_].phase))
+  {
+    return false;
+  }
+
+  auto &entry = entries_[next_delivery_];
+  entry.phase = Phase::DELIVERED;
+  source      = std::move(entry.source);
+  blocks      = std::move(entry.blocks);
+
+  entry.source = Address{};
+  entry.blocks = Blocks{};
+
+  --num_buffered_;
+  ++next_delivery_;
+
+  return true;
+}
+
+bool BlockSyncPipeline::IsActive() const
+{
+  return !IsComplete();
+}
+
+bool BlockSyncPipeline::IsComplete() const
+{
+  return next_delivery_ >= entries_.size();
+}
+
+/**
+ * Get the hash of the last block that has been delivered by the pipeline
+ *
+ * @return The block hash
+ */
+BlockSyncPipeline::BlockHash const &BlockSyncPipeline::delivered_hash() const
+{
+  static BlockHash const EMPTY{};
+
+  return (next_delivery_ < skeleton_.size()) ? skeleton_[next_delivery_] : EMPTY;
+}
+
+std::size_t BlockSyncPipeline::num_ranges() const
+{
+  return entries_.size();
+}
+
+std::size_t BlockSyncPipeline::num_in_flight() const
+{
+  return num_in_flight_;
+}
+
+std::size_t BlockSyncPipeline::num_buffered() const
+{
+  return num_buffered_;
+}
+
+/**
+ * Internal: Check that a set of blocks forms the specified range of the skeleton
+ *
+ * @param index The index of the range
+ * @param blocks The blocks to check, updated to remove the preceding block (if present)
+ * @return true if valid, otherwise false
+ */
+bool BlockSyncPipeline::Validate(std::size_t index, Blocks &blocks) const
+{
+  BlockHash const &first = skeleton_[index];
+  BlockHash const &last  = skeleton_[index + 1];
+
+  // never trust the hashes supplied by the peer
+  for (auto &block : blocks)
+  {
+    block.UpdateDigest();
+  }
+
+  // the preceding block is included in some responses, it is already known so it can be dropped
+  if (!blocks.empty() && (blocks.front().hash == first))
+  {
+    blocks.erase(blocks.begin());
+  }
+
+  if (blocks.empty() || (blocks.size() != stride_) || (blocks.back().hash != last))
+  {
+    return false;
+  }
+
+  // the blocks must form an unbroken chain from the preceding block
+  BlockHash const *previous = &first;
+  for (auto const &block : blocks)
+  {
+    if (block.previous_hash != *previous)
+    {
+      return false;
+    }
+
+    previous = &block.hash;
+  }
+
+  return true;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -25,8 +25,10 @@ namespace fetch {
 namespace ledger {
 namespace {
 
-using BlocksPromise     = MainChainRpcClient::BlocksPromise;
-using TraveloguePromise = MainChainRpcClient::TraveloguePromise;
+using BlocksPromise      = MainChainRpcClient::BlocksPromise;
+using BlockHashesPromise = MainChainRpcClient::BlockHashesPromise;
+using TraveloguePromise  = MainChainRpcClient::TraveloguePromise;
+using LayoutsPromise     = MainChainRpcClient::LayoutsPromise;
 
 }  // namespace
 
@@ -59,5 +61,23 @@ TraveloguePromise MainChainRpcClient::TimeTravel(MuddleAddress peer, Digest star
   return TraveloguePromise{promise};
 }
 
+BlockHashesPromise MainChainRpcClient::GetChainSkeleton(MuddleAddress peer, uint64_t start,
+                                                        uint64_t stride, uint64_t limit)
+{
+  auto promise = rpc_client_.CallSpecificAddress(
+      peer, RPC_MAIN_CHAIN, MainChainProtocol::CHAIN_SKELETON, start, stride, limit);
+
+  return BlockHashesPromise{promise};
+}
+
+LayoutsPromise MainChainRpcClient::GetTransactionLayouts(MuddleAddress peer, Digest block_hash,
+                                                         BlockPositions positions)
+{
+  auto promise = rpc_client_.CallSpecificAddress(
+      peer, RPC_MAIN_CHAIN, MainChainProtocol::TX_LAYOUTS, block_hash, positions);
+
+  return LayoutsPromise{promise};
+}
+
 }  // namespace ledger
 }  // namespace fetch
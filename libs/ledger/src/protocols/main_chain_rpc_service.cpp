@@ -37,9 +37,11 @@
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <stdexcept>
+#include <utility>
 
 namespace fetch {
 namespace ledger {
@@ -69,6 +71,7 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &             endpoint,
   , rpc_client_(rpc_client)
   , state_machine_{std::make_shared<StateMachine>("MainChain", State::SYNCHRONISING,
                                                   [](State state) { return ToString(state); })}
+  , compact_block_subscription_(endpoint.Subscribe(SERVICE_MAIN_CHAIN, CHANNEL_COMPACT_BLOCKS))
   , recv_block_count_{telemetry::Registry::Instance().CreateCounter(
         "ledger_mainchain_service_recv_block_total",
         "The number of received blocks from the network")}
@@ -105,6 +108,30 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &             endpoint,
   , state_complete_sync_with_peer_{telemetry::Registry::Instance().CreateCounter(
         "ledger_mainchain_service_state_complete_sync_with_peer_total",
         "The number of times in the complete sync with peer state")}
+  , state_start_pipelined_sync_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_state_start_pipelined_sync_total",
+        "The number of times in the start pipelined sync state")}
+  , state_wait_for_skeleton_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_state_wait_for_skeleton_total",
+        "The number of times in the wait for skeleton state")}
+  , state_pipelined_sync_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_state_pipelined_sync_total",
+        "The number of times in the pipelined sync state")}
+  , pipelined_range_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_pipelined_range_total",
+        "The total number of block ranges received during pipelined sync")}
+  , pipelined_range_failure_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_pipelined_range_failure_total",
+        "The total number of block range requests that failed during pipelined sync")}
+  , recv_compact_block_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_recv_compact_block_total",
+        "The number of received compact blocks from the network")}
+  , compact_block_missing_tx_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_compact_block_missing_tx_total",
+        "The total number of transaction layouts requested to complete compact blocks")}
+  , compact_block_failure_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_compact_block_failure_total",
+        "The total number of compact blocks which could not be rebuilt")}
   , state_current_{telemetry::Registry::Instance().CreateGauge<uint32_t>(
         "ledger_mainchain_service_state_complete_sync_with_peer_total",
         "The number of times in the complete sync with peer state")}
@@ -125,6 +152,9 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &             endpoint,
   state_machine_->RegisterHandler(State::REQUEST_NEXT_BLOCKS, this, &MainChainRpcService::OnRequestNextSetOfBlocks);
   state_machine_->RegisterHandler(State::WAIT_FOR_NEXT_BLOCKS,    this, &MainChainRpcService::OnWaitForBlocks);
   state_machine_->RegisterHandler(State::COMPLETE_SYNC_WITH_PEER,    this, &MainChainRpcService::OnCompleteSyncWithPeer);
+  state_machine_->RegisterHandler(State::START_PIPELINED_SYNC,       this, &MainChainRpcService::OnStartPipelinedSync);
+  state_machine_->RegisterHandler(State::WAIT_FOR_SKELETON,          this, &MainChainRpcService::OnWaitForSkeleton);
+  state_machine_->RegisterHandler(State::PIPELINED_SYNC,             this, &MainChainRpcService::OnPipelinedSync);
   // clang-format on
 
   state_machine_->OnStateChange([](State current, State previous) {
@@ -136,6 +166,11 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &             endpoint,
   // clear the restart timer
   resync_interval_.Restart(std::chrono::seconds{uint64_t{PERIODIC_RESYNC_SECONDS}});
 
+  // gossiped blocks are processed off the router threads, so that block processing does not stall
+  // the delivery of other messages. Dropped blocks are recovered by the periodic sync
+  block_subscription_->EnableAsyncDispatch(MAX_QUEUED_GOSSIP_BLOCKS);
+  compact_block_subscription_->EnableAsyncDispatch(MAX_QUEUED_GOSSIP_BLOCKS);
+
   // set the main chain rpc sync to accept gossip blocks
   block_subscription_->SetMessageHandler([this](Address const &from, uint16_t, uint16_t, uint16_t,
                                                 Packet::Payload const &payload,
@@ -154,10 +189,39 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &             endpoint,
     // dispatch the event
     OnNewBlock(from, block, transmitter);
   });
+
+  // compact blocks are always accepted, whether or not this node relays them itself
+  compact_block_subscription_->SetMessageHandler(
+      [this](Address const &from, uint16_t, uint16_t, uint16_t, Packet::Payload const &payload,
+             Address transmitter) {
+        telemetry::FunctionTimer timer{*new_block_duration_};
+
+        CompactBlock compact;
+
+        BlockSerializer serialiser(payload);
+        serialiser >> compact;
+
+        OnNewCompactBlock(from, compact, transmitter);
+      });
 }
 
 void MainChainRpcService::BroadcastBlock(MainChainRpcService::Block const &block)
 {
+  if (compact_relay_)
+  {
+    auto const compact = ToCompactBlock(block);
+
+    BlockSerializerCounter counter;
+    counter << compact;
+
+    BlockSerializer serializer;
+    serializer.Reserve(counter.size());
+    serializer << compact;
+
+    endpoint_.Broadcast(SERVICE_MAIN_CHAIN, CHANNEL_COMPACT_BLOCKS, serializer.data());
+    return;
+  }
+
   // determine the serialised size of the block
   BlockSerializerCounter counter;
   counter << block;
@@ -229,6 +293,124 @@ void MainChainRpcService::OnNewBlock(Address const &from, Block &block, Address
                  " status: ", status_text, ")");
 }
 
+/**
+ * Set the source of the transaction layouts used to rebuild compact blocks
+ *
+ * @param lookup The lookup of layouts by short transaction id
+ */
+void MainChainRpcService::SetLayoutLookup(LayoutLookup lookup)
+{
+  layout_lookup_ = std::move(lookup);
+}
+
+/**
+ * Control whether the blocks of this node are broadcast as compact blocks
+ *
+ * @param enable true to broadcast compact blocks, false to broadcast full blocks
+ */
+void MainChainRpcService::EnableCompactRelay(bool enable)
+{
+  compact_relay_ = enable;
+}
+
+void MainChainRpcService::OnNewCompactBlock(Address const &from, CompactBlock const &compact,
+                                            Address const &transmitter)
+{
+  recv_compact_block_count_->increment();
+
+  Block      block;
+  auto const missing = ReconstructBlock(compact, layout_lookup_, block);
+
+  if (block.slices.size() != compact.slice_sizes.size())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Malformed compact block from: ", ToBase64(from));
+    compact_block_failure_count_->increment();
+    return;
+  }
+
+  if (missing.empty())
+  {
+    OnCompactBlockComplete(from, block, transmitter);
+    return;
+  }
+
+  compact_block_missing_tx_count_->add(missing.size());
+
+  BlockHash const hash = compact.header.hash;
+  LayoutsPromise  promise{};
+
+  {
+    FETCH_LOCK(pending_compact_lock_);
+
+    if ((pending_compact_blocks_.size() >= MAX_PENDING_COMPACT_BLOCKS) ||
+        (pending_compact_blocks_.find(hash) != pending_compact_blocks_.end()))
+    {
+      // the block will be recovered by the regular sync instead
+      compact_block_failure_count_->increment();
+      return;
+    }
+
+    // the layouts are requested from the miner of the block which is certain to have them
+    promise = rpc_client_.GetTransactionLayouts(from, hash, missing);
+
+    pending_compact_blocks_.emplace(
+        hash, PendingCompactBlock{from, transmitter, std::move(block), missing, promise});
+  }
+
+  // attached outside of the lock, the handlers run immediately if the promise has completed
+  promise.WithHandlers()
+      .Then([this, hash]() { OnCompactBlockLayouts(hash); })
+      .Catch([this, hash]() { OnCompactBlockLayouts(hash); });
+}
+
+void MainChainRpcService::OnCompactBlockLayouts(BlockHash const &hash)
+{
+  PendingCompactBlock pending{};
+
+  {
+    FETCH_LOCK(pending_compact_lock_);
+
+    auto it = pending_compact_blocks_.find(hash);
+    if (it == pending_compact_blocks_.end())
+    {
+      return;
+    }
+
+    pending = std::move(it->second);
+    pending_compact_blocks_.erase(it);
+  }
+
+  TransactionLayouts layouts{};
+  if (!pending.promise || !pending.promise.GetResult(layouts) ||
+      !CompleteBlock(pending.block, pending.missing, layouts))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to complete compact block 0x", hash.ToHex(),
+                   " from: ", ToBase64(pending.from));
+    compact_block_failure_count_->increment();
+    return;
+  }
+
+  OnCompactBlockComplete(pending.from, pending.block, pending.transmitter);
+}
+
+void MainChainRpcService::OnCompactBlockComplete(Address const &from, Block &block,
+                                                 Address const &transmitter)
+{
+  // the rebuilt block must match the header, otherwise a short id matched the wrong transaction
+  BlockHash const expected_hash = block.hash;
+  block.UpdateDigest();
+
+  if (block.hash != expected_hash)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Rebuilt compact block 0x", expected_hash.ToHex(),
+                   " does not match its header");
+    compact_block_failure_count_->increment();
+    return;
+  }
+
+  OnNewBlock(from, block, transmitter);
+}
+
 MainChainRpcService::Address MainChainRpcService::GetRandomTrustedPeer() const
 {
   static random::LinearCongruentialGenerator rng;
@@ -266,6 +448,8 @@ void MainChainRpcService::HandleChainResponse(Address const &address, Begin begi
   std::size_t invalid{0};
   std::size_t dirty{0};
 
+  VerifyNotarisations(begin, end);
+
   for (auto it = begin; it != end; ++it)
   {
     // skip the genesis block
@@ -517,6 +701,12 @@ State MainChainRpcService::OnWaitForBlocks()
         break;
       }
     }
+
+    // when a long way behind the peer, switch to requesting the chain from all peers in parallel
+    if (block_resolving_ && UsePipelinedSync(log))
+    {
+      return State::START_PIPELINED_SYNC;
+    }
   }
 
   return State::REQUEST_NEXT_BLOCKS;
@@ -531,10 +721,248 @@ State MainChainRpcService::OnCompleteSyncWithPeer()
   current_request_      = {};
   block_resolving_      = {};
   consecutive_failures_ = 0;
+  pipeline_failed_      = false;
+
+  ResetPipelinedSync();
 
   return State::SYNCHRONISED;
 }
 
+State MainChainRpcService::OnStartPipelinedSync()
+{
+  state_start_pipelined_sync_->increment();
+  state_current_->set(static_cast<uint32_t>(State::START_PIPELINED_SYNC));
+
+  if (!(block_resolving_ && !current_peer_address_.empty()))
+  {
+    return State::COMPLETE_SYNC_WITH_PEER;
+  }
+
+  // request the outline of the peers chain, starting from the last block that we agree on
+  uint64_t const start = block_resolving_->block_number;
+  uint64_t const limit = uint64_t{PIPELINED_SYNC_MAX_RANGES} + 1;
+
+  skeleton_request_ = rpc_client_
+                          .GetChainSkeleton(current_peer_address_, start,
+                                            uint64_t{PIPELINED_SYNC_STRIDE}, limit)
+                          .GetInnerPromise();
+
+  return State::WAIT_FOR_SKELETON;
+}
+
+State MainChainRpcService::OnWaitForSkeleton()
+{
+  state_wait_for_skeleton_->increment();
+  state_current_->set(static_cast<uint32_t>(State::WAIT_FOR_SKELETON));
+
+  if (!skeleton_request_ || !block_resolving_)
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "State machine error. Reverting to normal sync");
+
+    pipeline_failed_ = true;
+    return State::REQUEST_NEXT_BLOCKS;
+  }
+
+  auto const status = skeleton_request_->state();
+  if (status == PromiseState::WAITING)
+  {
+    state_machine_->Delay(std::chrono::milliseconds{100});
+    return State::WAIT_FOR_SKELETON;
+  }
+
+  // any failure in obtaining the skeleton means that we simply continue with the normal sync
+  MainChainProtocol::BlockHashes skeleton{};
+  bool const valid = (status == PromiseState::SUCCESS) && skeleton_request_->GetResult(skeleton) &&
+                     (skeleton.size() > 1) && (skeleton.front() == block_resolving_->hash);
+
+  skeleton_request_ = {};
+
+  if (!valid)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Unable to retrieve chain skeleton from: muddle://",
+                   ToBase64(current_peer_address_), ". Reverting to normal sync");
+
+    pipeline_failed_ = true;
+    return State::REQUEST_NEXT_BLOCKS;
+  }
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Starting pipelined sync from: #", block_resolving_->block_number,
+                 " ranges: ", skeleton.size() - 1, " (", PIPELINED_SYNC_STRIDE, " blocks each)");
+
+  pipeline_.Reset(std::move(skeleton), PIPELINED_SYNC_STRIDE);
+
+  return State::PIPELINED_SYNC;
+}
+
+State MainChainRpcService::OnPipelinedSync()
+{
+  state_pipelined_sync_->increment();
+  state_current_->set(static_cast<uint32_t>(State::PIPELINED_SYNC));
+
+  // process all the responses that have been received and add the next ranges to the chain
+  UpdateRangeRequests();
+
+  if (!pipeline_failed_ && !pipeline_.IsComplete())
+  {
+    IssueRangeRequests();
+
+    // without any outstanding requests no further progress can be made
+    if (range_requests_.empty())
+    {
+      pipeline_failed_ = true;
+    }
+  }
+
+  if (pipeline_failed_ || pipeline_.IsComplete())
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Pipelined sync ", (pipeline_failed_ ? "aborted" : "complete"),
+                   ". Continuing sync with: muddle://", ToBase64(current_peer_address_));
+
+    // resume the normal sync from the last block that was successfully delivered
+    block_resolving_ = chain_.GetBlock(pipeline_.delivered_hash());
+    ResetPipelinedSync();
+
+    return State::REQUEST_NEXT_BLOCKS;
+  }
+
+  state_machine_->Delay(std::chrono::milliseconds{50});
+  return State::PIPELINED_SYNC;
+}
+
+/**
+ * Determine if the pipelined sync should be used to catch up with a peer's chain
+ *
+ * @param log The latest response from the peer
+ * @return true if the pipelined sync should be used, otherwise false
+ */
+bool MainChainRpcService::UsePipelinedSync(MainChainProtocol::Travelogue const &log) const
+{
+  return !pipeline_failed_ && block_resolving_ &&
+         (log.status == TravelogueStatus::HEAVIEST_BRANCH) &&
+         ((block_resolving_->block_number + PIPELINED_SYNC_THRESHOLD) < log.block_number);
+}
+
+/**
+ * Collect the responses to the outstanding range requests, and add all the ranges that are now
+ * available (in order) to the chain
+ */
+void MainChainRpcService::UpdateRangeRequests()
+{
+  for (auto it = range_requests_.begin(); it != range_requests_.end();)
+  {
+    auto const status = it->promise->state();
+    if (status == PromiseState::WAITING)
+    {
+      ++it;
+      continue;
+    }
+
+    BlockList blocks{};
+    bool      success = (status == PromiseState::SUCCESS) && it->promise->GetResult(blocks);
+
+    if (success)
+    {
+      // sub chains are returned latest block first
+      std::reverse(blocks.begin(), blocks.end());
+
+      success = pipeline_.Complete(it->index, it->peer, std::move(blocks));
+      if (!success)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Invalid block range received from: muddle://",
+                       ToBase64(it->peer));
+        trust_.AddFeedback(it->peer, p2p::TrustSubject::BLOCK, p2p::TrustQuality::LIED);
+      }
+    }
+
+    if (success)
+    {
+      pipelined_range_total_->increment();
+    }
+    else
+    {
+      pipelined_range_failure_total_->increment();
+
+      if (!pipeline_.Abandon(it->index))
+      {
+        pipeline_failed_ = true;
+      }
+    }
+
+    it = range_requests_.erase(it);
+  }
+
+  // feed all the contiguous ranges into the chain
+  Address   source{};
+  BlockList blocks{};
+  while (pipeline_.PopNext(source, blocks))
+  {
+    HandleChainResponse(source, blocks.begin(), blocks.end());
+  }
+}
+
+/**
+ * Distribute the pending ranges across all the directly connected peers
+ */
+void MainChainRpcService::IssueRangeRequests()
+{
+  for (auto const &peer : endpoint_.GetDirectlyConnectedPeers())
+  {
+    auto const in_flight = static_cast<std::size_t>(
+        std::count_if(range_requests_.begin(), range_requests_.end(),
+                      [&peer](RangeRequest const &request) { return request.peer == peer; }));
+
+    for (std::size_t i = in_flight; i < MAX_RANGE_REQUESTS_PER_PEER; ++i)
+    {
+      BlockSyncPipeline::Range range{};
+      if (!pipeline_.NextRange(range))
+      {
+        return;
+      }
+
+      // the sub chain from the end of the range back to (and including) the preceding block
+      auto promise =
+          rpc_client_.GetCommonSubChain(peer, range.last, range.first, range.length + 1)
+              .GetInnerPromise();
+
+      range_requests_.push_back(RangeRequest{peer, std::move(promise), range.index});
+    }
+  }
+}
+
+void MainChainRpcService::ResetPipelinedSync()
+{
+  pipeline_.Clear();
+  skeleton_request_ = {};
+  range_requests_.clear();
+}
+
+template <class Begin, class End>
+void MainChainRpcService::VerifyNotarisations(Begin begin, End end) const
+{
+  if (!consensus_)
+  {
+    return;
+  }
+
+  std::vector<Block const *> blocks;
+  for (auto it = begin; it != end; ++it)
+  {
+    if (!it->IsGenesis())
+    {
+      blocks.push_back(&*it);
+    }
+  }
+
+  try
+  {
+    consensus_->VerifyNotarisations(blocks);
+  }
+  catch (std::runtime_error const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Exception in consensus on verifying notarisations: ", ex.what());
+  }
+}
+
 bool MainChainRpcService::ValidBlock(Block const &block, char const *action) const
 {
   try
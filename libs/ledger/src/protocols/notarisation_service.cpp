@@ -20,7 +20,9 @@
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/protocols/notarisation_service.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -418,21 +420,24 @@ NotarisationService::NotarisationResult NotarisationService::Verify(
     BlockNumber const &block_number, BlockHash const &block_hash,
     AggregateSignature const &notarisation)
 {
-  FETCH_LOCK(mutex_);
-
-  // If block is within current aeon then notarise now
   SharedAeonNotarisationUnit notarisation_unit;
-  if (active_notarisation_unit_ && block_number >= active_notarisation_unit_->round_start() &&
-      block_number <= active_notarisation_unit_->round_end())
   {
-    notarisation_unit = active_notarisation_unit_;
-  }
+    FETCH_LOCK(mutex_);
 
-  // If block is not in current aeon then check previous notarisation unit
-  if (previous_notarisation_unit_ && block_number >= previous_notarisation_unit_->round_start() &&
-      block_number <= previous_notarisation_unit_->round_end())
-  {
-    notarisation_unit = previous_notarisation_unit_;
+    // If block is within current aeon then notarise now
+    if (active_notarisation_unit_ && block_number >= active_notarisation_unit_->round_start() &&
+        block_number <= active_notarisation_unit_->round_end())
+    {
+      notarisation_unit = active_notarisation_unit_;
+    }
+
+    // If block is not in current aeon then check previous notarisation unit
+    if (previous_notarisation_unit_ &&
+        block_number >= previous_notarisation_unit_->round_start() &&
+        block_number <= previous_notarisation_unit_->round_end())
+    {
+      notarisation_unit = previous_notarisation_unit_;
+    }
   }
 
   if (!notarisation_unit)
@@ -472,6 +477,77 @@ bool NotarisationService::Verify(BlockHash const &           block_hash,
   return false;
 }
 
+/**
+ * Verifies the notarisations of a batch of blocks, for example when syncing many notarised blocks
+ * at once. The notarisations which can be checked with the keys of the current or previous aeon
+ * are verified together, and are remembered so that the verification of the individual blocks
+ * afterwards is cheap.
+ *
+ * The notarisation units are only ever replaced, never modified, so the verification takes place
+ * outside of the service lock and does not hold up the notarisation of new blocks.
+ *
+ * @param notarisations Block number, hash and notarisation of each notarised block
+ * @return The verification result of each notarisation
+ */
+std::vector<NotarisationService::NotarisationResult> NotarisationService::Verify(
+    std::vector<BlockNotarisation> const &notarisations)
+{
+  SharedAeonNotarisationUnit previous_unit;
+  SharedAeonNotarisationUnit active_unit;
+  {
+    FETCH_LOCK(mutex_);
+    previous_unit = previous_notarisation_unit_;
+    active_unit   = active_notarisation_unit_;
+  }
+
+  std::vector<NotarisationResult> results(notarisations.size(),
+                                          NotarisationResult::CAN_NOT_VERIFY);
+
+  for (auto const &notarisation_unit : {previous_unit, active_unit})
+  {
+    if (!notarisation_unit)
+    {
+      continue;
+    }
+
+    std::vector<std::size_t>               indices;
+    NotarisationManager::NotarisationBatch batch;
+
+    for (std::size_t i = 0; i < notarisations.size(); ++i)
+    {
+      auto const &entry = notarisations[i];
+
+      // Blocks in both aeons are checked with the previous one, as in the single block Verify
+      if (results[i] != NotarisationResult::CAN_NOT_VERIFY ||
+          entry.block_number < notarisation_unit->round_start() ||
+          entry.block_number > notarisation_unit->round_end())
+      {
+        continue;
+      }
+
+      // Check that the signature was created with the correct number of signers
+      if (count(entry.notarisation.second.begin(), entry.notarisation.second.end(), 1) !=
+          notarisation_unit->threshold())
+      {
+        results[i] = NotarisationResult::FAIL_VERIFICATION;
+        continue;
+      }
+
+      indices.push_back(i);
+      batch.emplace_back(entry.block_hash, entry.notarisation);
+    }
+
+    auto const valid = notarisation_unit->VerifyAggregateSignatures(batch);
+    for (std::size_t n = 0; n < indices.size(); ++n)
+    {
+      results[indices[n]] =
+          valid[n] ? NotarisationResult::PASS_VERIFICATION : NotarisationResult::FAIL_VERIFICATION;
+    }
+  }
+
+  return results;
+}
+
 char const *StateToString(NotarisationService::State state)
 {
   char const *text = "unknown";
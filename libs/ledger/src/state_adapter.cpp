@@ -21,6 +21,9 @@
 #include "logging/logging.hpp"
 #include "storage/resource_mapper.hpp"
 
+#include <cstddef>
+#include <utility>
+
 using fetch::storage::ResourceAddress;
 using fetch::byte_array::ConstByteArray;
 
@@ -46,6 +49,17 @@ StateAdapter::StateAdapter(StorageInterface &storage, ConstByteArray scope, Mode
   : storage_{storage}
   , scope_{std::move(scope)}
   , mode_{mode}
+  , addresses_(1)
+{}
+
+/**
+ * Constructs a committed state adapter from a storage interface and a scope
+ *
+ * @param storage The reference to the storage engine
+ * @param scope The reference to the scope
+ */
+CommittedStateAdapter::CommittedStateAdapter(StorageInterface &storage, ConstByteArray scope)
+  : StateAdapter(storage, std::move(scope), Mode::READ_COMMITTED)
 {}
 
 /**
@@ -63,8 +77,8 @@ StateAdapter::Status StateAdapter::Read(std::string const &key, void *data, uint
 
   Status status{Status::ERROR};
 
-  // make the request to the storage engine
-  auto const result = storage_.Get(CreateAddress(CurrentScope(), key));
+  // make the request to the storage engine (unless the value has already been prefetched)
+  auto const result = Lookup(Address(key));
 
   // ensure the check was not found
   if (!result.failed)
@@ -109,10 +123,14 @@ StateAdapter::Status StateAdapter::Write(std::string const &key, void const *dat
     return Status::PERMISSION_DENIED;
   }
 
-  auto write_val = ConstByteArray{reinterpret_cast<uint8_t const *>(data), size};
+  auto const &address   = Address(key);
+  auto        write_val = ConstByteArray{reinterpret_cast<uint8_t const *>(data), size};
+
+  // any prefetched value is now out of date
+  prefetched_.erase(address);
 
   // set the value on the storage engine
-  storage_.Set(CreateAddress(CurrentScope(), key), write_val);
+  storage_.Set(address, write_val);
 
   return Status::OK;
 }
@@ -127,7 +145,7 @@ StateAdapter::Status StateAdapter::Write(std::string const &key, void const *dat
 StateAdapter::Status StateAdapter::Exists(std::string const &key)
 {
   // request the result
-  auto const result = storage_.Get(CreateAddress(CurrentScope(), key));
+  auto const result = Lookup(Address(key));
 
   if (result.failed)
   {
@@ -137,6 +155,65 @@ StateAdapter::Status StateAdapter::Exists(std::string const &key)
   return Status::OK;
 }
 
+/**
+ * Check whether the resource of a key is within the lanes of the adapter, which are not restricted
+ * here
+ *
+ * @param key The key to check
+ * @return true if the resource is accessible
+ */
+bool StateAdapter::IsAllowedResource(std::string const & /*key*/) const
+{
+  return true;
+}
+
+/**
+ * Read a batch of values from the state store ahead of them being accessed
+ *
+ * The values are requested from the storage engine in a single batch and retained, so that
+ * subsequent calls to Read or Exists for these keys can be served locally.
+ *
+ * @param keys The keys to be read
+ * @return OK if the batch was read, otherwise ERROR
+ */
+StateAdapter::Status StateAdapter::ReadBatch(Keys const &keys)
+{
+  FETCH_LOG_DEBUG(LOGGING_NAME, "ReadBatch: ", keys.size(), " keys");
+
+  StorageInterface::ResourceAddresses addresses{};
+  addresses.reserve(keys.size());
+
+  for (auto const &key : keys)
+  {
+    auto const &address = Address(key);
+    if (prefetched_.find(address) == prefetched_.end())
+    {
+      addresses.emplace_back(address);
+    }
+  }
+
+  if (addresses.empty())
+  {
+    return Status::OK;
+  }
+
+  // make the request to the storage engine
+  auto documents = (Mode::READ_COMMITTED == mode_) ? storage_.GetCommittedBatch(addresses)
+                                                   : storage_.GetBatch(addresses);
+  if (documents.size() != addresses.size())
+  {
+    return Status::ERROR;
+  }
+
+  // retain the documents, including those which were not found
+  for (std::size_t i = 0; i < addresses.size(); ++i)
+  {
+    prefetched_.emplace(std::move(addresses[i]), std::move(documents[i]));
+  }
+
+  return Status::OK;
+}
+
 /**
  * Creates a scoped address from a string based key
  *
@@ -154,11 +231,13 @@ ResourceAddress StateAdapter::CreateAddress(ConstByteArray const &scope, ConstBy
 void StateAdapter::PushContext(byte_array::ConstByteArray const &scope)
 {
   scope_.emplace_back(scope);
+  addresses_.emplace_back();
 }
 
 void StateAdapter::PopContext()
 {
   scope_.pop_back();
+  addresses_.pop_back();
 }
 
 StateAdapter::ConstByteArray StateAdapter::CurrentScope() const
@@ -166,5 +245,48 @@ StateAdapter::ConstByteArray StateAdapter::CurrentScope() const
   return scope_.back();
 }
 
+/**
+ * Internal: Resolve a key to its address in the current scope. Building an address hashes the
+ * scoped key, so the result is retained for as long as the scope is, and every further access to
+ * the key only costs a map lookup.
+ *
+ * @param key The key to be resolved
+ * @return The address of the key, which remains valid until the scope is popped
+ */
+ResourceAddress const &StateAdapter::Address(std::string const &key) const
+{
+  auto &addresses = addresses_.back();
+
+  auto it = addresses.find(key);
+  if (it == addresses.end())
+  {
+    it = addresses.emplace(key, CreateAddress(CurrentScope(), key)).first;
+  }
+
+  return it->second;
+}
+
+/**
+ * Internal: Look up a document, using the prefetched entries where possible
+ *
+ * @param address The address of the resource
+ * @return The document
+ */
+StateAdapter::Document StateAdapter::Lookup(storage::ResourceAddress const &address) const
+{
+  auto const it = prefetched_.find(address);
+  if (it != prefetched_.end())
+  {
+    return it->second;
+  }
+
+  if (Mode::READ_COMMITTED == mode_)
+  {
+    return storage_.GetCommitted(address);
+  }
+
+  return storage_.Get(address);
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -108,7 +108,7 @@ StateSentinelAdapter::Status StateSentinelAdapter::Write(std::string const &key,
   if (!IsAllowedResource(key))
   {
     FETCH_LOG_WARN(LOGGING_NAME,
-                   "Unable to write to resource: ", CreateAddress(CurrentScope(), key).address());
+                   "Unable to write to resource: ", Address(key).address());
     return Status::PERMISSION_DENIED;
   }
 
@@ -145,6 +145,27 @@ StateSentinelAdapter::Status StateSentinelAdapter::Exists(std::string const &key
   return StateAdapter::Exists(key);
 }
 
+/**
+ * Read a batch of values from the state store ahead of them being accessed
+ *
+ * @param keys The keys to be read
+ * @return OK if the batch was read, PERMISSION_DENIED if any of the keys are incorrect, otherwise
+ * ERROR
+ */
+StateSentinelAdapter::Status StateSentinelAdapter::ReadBatch(Keys const &keys)
+{
+  for (auto const &key : keys)
+  {
+    if (!IsAllowedResource(key))
+    {
+      return Status::PERMISSION_DENIED;
+    }
+  }
+
+  // the lookup and byte counters are only updated when the values are actually read
+  return StateAdapter::ReadBatch(keys);
+}
+
 /**
  * Check whether the resource being requested is allowed
  *
@@ -154,11 +175,8 @@ StateSentinelAdapter::Status StateSentinelAdapter::Exists(std::string const &key
  */
 bool StateSentinelAdapter::IsAllowedResource(std::string const &key) const
 {
-  // build the associated resources address
-  auto const address = CreateAddress(CurrentScope(), key);
-
-  // determine which shard this resource is mapped to
-  auto const mapped_shard = address.lane(shards_.log2_size());
+  // determine which shard the resource is mapped to, the address is retained for the access itself
+  auto const mapped_shard = Address(key).lane(shards_.log2_size());
 
   // calculate if this shard is in the allowed shard list
   bool const is_allowed = shards_.bit(mapped_shard) != 0;
@@ -19,6 +19,8 @@
 #include "ledger/storage_unit/cached_storage_adapter.hpp"
 
 #include <cassert>
+#include <cstddef>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -38,22 +40,32 @@ CachedStorageAdapter::CachedStorageAdapter(StorageInterface &storage)
 CachedStorageAdapter::~CachedStorageAdapter() = default;
 
 /**
- * Trigger a flush of the cached entries to the storage engine
+ * Trigger a flush of the cached entries to the storage engine. The modified entries are written as
+ * a single batch, so that each of the lanes involved is only written to once
  */
 void CachedStorageAdapter::Flush()
 {
   cache_.ApplyVoid([this](auto &cache) {
+    ResourceAddresses keys{};
+    StateValues       values{};
+
     for (auto &entry : cache)
     {
       if (!entry.second.flushed)
       {
-        // set the value on the storage engine
-        storage_.Set(entry.first, entry.second.value);
+        keys.emplace_back(entry.first);
+        values.emplace_back(entry.second.value);
 
         // signal the entry as flushed
         entry.second.flushed = true;
       }
     }
+
+    if (!keys.empty())
+    {
+      // set the values on the storage engine
+      storage_.SetBatch(keys, values);
+    }
   });
 }
 
@@ -96,6 +108,53 @@ CachedStorageAdapter::Document CachedStorageAdapter::Get(ResourceAddress const &
   return result;
 }
 
+/**
+ * Get a batch of resources from the storage engine or cache
+ *
+ * Only the keys which are not already in the cache are requested (as a single batch) from the
+ * underlying storage engine.
+ *
+ * @param keys The keys to be accessed
+ * @return The documents, in the same order as the keys
+ */
+CachedStorageAdapter::Documents CachedStorageAdapter::GetBatch(ResourceAddresses const &keys) const
+{
+  Documents                documents(keys.size());
+  ResourceAddresses        missing_keys{};
+  std::vector<std::size_t> missing_indices{};
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    if (HasCacheEntry(keys[i]))
+    {
+      documents[i].document = GetCacheEntry(keys[i]);
+    }
+    else
+    {
+      missing_keys.emplace_back(keys[i]);
+      missing_indices.emplace_back(i);
+    }
+  }
+
+  if (!missing_keys.empty())
+  {
+    auto results = storage_.GetBatch(missing_keys);
+    assert(results.size() == missing_keys.size());
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      if (!results[i].failed)
+      {
+        AddCacheEntry(missing_keys[i], results[i].document);
+      }
+
+      documents[missing_indices[i]] = std::move(results[i]);
+    }
+  }
+
+  return documents;
+}
+
 /**
  * Get or Create a resource in the storage engine
  *
@@ -18,13 +18,17 @@
 
 #include "ledger/storage_unit/lane_controller.hpp"
 #include "ledger/storage_unit/lane_controller_protocol.hpp"
+#include "ledger/storage_unit/state_snapshot_sync.hpp"
 
 namespace fetch {
 namespace ledger {
 
-LaneControllerProtocol::LaneControllerProtocol(LaneController &ctrl)
+LaneControllerProtocol::LaneControllerProtocol(LaneController &   ctrl,
+                                               StateSnapshotSync &snapshot_sync)
 {
   this->Expose(USE_THESE_PEERS, &ctrl, &LaneController::UseThesePeers);
+  this->Expose(BEGIN_STATE_SNAPSHOT, &snapshot_sync, &StateSnapshotSync::Begin);
+  this->Expose(STATE_SNAPSHOT_STATUS, &snapshot_sync, &StateSnapshotSync::GetStatus);
 }
 
 }  // namespace ledger
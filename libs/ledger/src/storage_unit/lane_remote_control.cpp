@@ -77,6 +77,61 @@ void LaneRemoteControl::UseThesePeers(LaneIndex lane, AddressMap const &addresse
   }
 }
 
+/**
+ * Request that a lane replaces its state with a snapshot downloaded from its peers
+ *
+ * @param lane The index of the lane
+ * @return true if the download was started, otherwise false
+ */
+bool LaneRemoteControl::BeginStateSnapshot(LaneIndex lane)
+{
+  bool success{false};
+
+  try
+  {
+    auto p = rpc_client_.CallSpecificAddress(LookupAddress(lane), RPC_CONTROLLER,
+                                             LaneControllerProtocol::BEGIN_STATE_SNAPSHOT);
+
+    bool started{false};
+    success = p->GetResult(started) && started;
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to execute BeginStateSnapshot: ", ex.what());
+  }
+
+  return success;
+}
+
+/**
+ * Query the status of a lane's state snapshot download
+ *
+ * @param lane The index of the lane
+ * @return The status of the download, FAILED if the lane could not be queried
+ */
+LaneRemoteControl::SnapshotStatus LaneRemoteControl::GetStateSnapshotStatus(LaneIndex lane)
+{
+  auto status = SnapshotStatus::FAILED;
+
+  try
+  {
+    auto p = rpc_client_.CallSpecificAddress(LookupAddress(lane), RPC_CONTROLLER,
+                                             LaneControllerProtocol::STATE_SNAPSHOT_STATUS);
+
+    uint8_t value{0};
+    if (p->GetResult(value) && (value <= static_cast<uint8_t>(SnapshotStatus::FAILED)))
+    {
+      status = static_cast<SnapshotStatus>(value);
+    }
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to execute GetStateSnapshotStatus: ", ex.what());
+  }
+
+  return status;
+}
+
 LaneRemoteControl::Address const &LaneRemoteControl::LookupAddress(LaneIndex lane) const
 {
   return addresses_.at(lane);
@@ -22,6 +22,8 @@
 #include "ledger/storage_unit/lane_controller.hpp"
 #include "ledger/storage_unit/lane_controller_protocol.hpp"
 #include "ledger/storage_unit/lane_service.hpp"
+#include "ledger/storage_unit/state_snapshot_protocol.hpp"
+#include "ledger/storage_unit/state_snapshot_sync.hpp"
 #include "ledger/storage_unit/transaction_finder_protocol.hpp"
 #include "ledger/storage_unit/transaction_store_sync_protocol.hpp"
 #include "ledger/storage_unit/transaction_store_sync_service.hpp"
@@ -88,11 +90,6 @@ LaneService::LaneService(NetworkManager const &nm, ShardConfig config, Mode mode
   tx_store_protocol_ = std::make_shared<TransactionStorageProtocol>(*tx_store_, cfg_.lane_id);
   internal_rpc_server_->Add(RPC_TX_STORE, tx_store_protocol_.get());
 
-  // Controller
-  controller_          = std::make_shared<LaneController>(*external_muddle_);
-  controller_protocol_ = std::make_shared<LaneControllerProtocol>(*controller_);
-  internal_rpc_server_->Add(RPC_CONTROLLER, controller_protocol_.get());
-
   tx_finder_protocol_ = std::make_unique<TxFinderProtocol>();
   internal_rpc_server_->Add(RPC_MISSING_TX_FINDER, tx_finder_protocol_.get());
 
@@ -117,30 +114,68 @@ LaneService::LaneService(NetworkManager const &nm, ShardConfig config, Mode mode
   external_rpc_server_->Add(RPC_TX_STORE_SYNC, tx_sync_protocol_.get());
 
   // State DB
-  state_db_ = std::make_shared<StateDb>();
+  auto const index_backend = cfg_.btree_state_index ? StateDb::IndexBackend::B_TREE
+                                                    : StateDb::IndexBackend::KEY_VALUE_INDEX;
+
+  // the index files are named by backend so that the two kinds are never confused
+  std::string const index_name = cfg_.btree_state_index ? "state_btree_index" : "state_index";
+
+  state_db_ = std::make_shared<StateDb>(index_backend);
   switch (mode)
   {
   case Mode::CREATE_DATABASE:
-    state_db_->New(prefix + "state.db", prefix + "state_deltas.db", prefix + "state_index.db",
-                   prefix + "state_index_deltas.db", false);
+    state_db_->New(prefix + "state.db", prefix + "state_deltas.db", prefix + index_name + ".db",
+                   prefix + index_name + "_deltas.db", false);
     break;
   case Mode::LOAD_DATABASE:
-    state_db_->Load(prefix + "state.db", prefix + "state_deltas.db", prefix + "state_index.db",
-                    prefix + "state_index_deltas.db", true);
+    state_db_->Load(prefix + "state.db", prefix + "state_deltas.db", prefix + index_name + ".db",
+                    prefix + index_name + "_deltas.db", true);
     break;
   }
 
+  if (cfg_.batched_state_writes)
+  {
+    state_db_->SetWriteMode(StateDb::WriteMode::BATCHED);
+  }
+
+  state_db_->SetHistoryDepth(cfg_.state_history_depth);
+  state_db_->EnableCommittedReads(cfg_.committed_state_reads);
+
   state_db_protocol_ =
       std::make_shared<StateDbProto>(state_db_.get(), cfg_.lane_id, cfg_.num_lanes);
   internal_rpc_server_->Add(RPC_STATE, state_db_protocol_.get());
 
+  // State snapshots
+  snapshot_protocol_ = std::make_unique<StateSnapshotProtocol>(*state_db_, cfg_.lane_id);
+  external_rpc_server_->Add(RPC_STATE_SNAPSHOT, snapshot_protocol_.get());
+
+  snapshot_sync_ = std::make_unique<StateSnapshotSync>(external_muddle_->GetEndpoint(),
+                                                       *state_db_, cfg_.lane_id);
+  reactor_.Attach(snapshot_sync_->GetWeakRunnable());
+
+  // Controller
+  controller_          = std::make_shared<LaneController>(*external_muddle_);
+  controller_protocol_ = std::make_shared<LaneControllerProtocol>(*controller_, *snapshot_sync_);
+  internal_rpc_server_->Add(RPC_CONTROLLER, controller_protocol_.get());
+
   FETCH_LOG_INFO(LOGGING_NAME, "Lane ", cfg_.lane_id, " Initialised.");
 
+  reactor_.SetAffinity(cfg_.cpu_affinity);
   reactor_.Start();
 }
 
 LaneService::~LaneService() = default;
 
+/**
+ * Set the accounts with sharded balances, used to lay out the transactions offered to the miner
+ *
+ * @param sharded_balances The accounts with sharded balances
+ */
+void LaneService::SetShardedBalances(ShardedBalancesPtr sharded_balances)
+{
+  tx_store_->SetShardedBalances(std::move(sharded_balances));
+}
+
 void LaneService::StartInternal()
 {
   FETCH_LOG_INFO(LOGGING_NAME, "Starting External Lane ", cfg_.lane_id,
@@ -158,7 +193,8 @@ void LaneService::StartInternal()
   // TX Sync service - attach to reactor once #892 is merged
   workthread_ =
       std::make_shared<BackgroundedWorkThread>(&bg_work_, "BW:LS-" + std::to_string(cfg_.lane_id),
-                                               [this]() { tx_sync_service_->Execute(); });
+                                               [this]() { tx_sync_service_->Execute(); },
+                                               cfg_.cpu_affinity);
   workthread_->ChangeWaitTime(std::chrono::milliseconds{unsigned{SYNC_PERIOD_MS}});
 }
 
@@ -179,7 +215,8 @@ void LaneService::StartExternal()
   // TX Sync service - attach to reactor once #892 is merged
   workthread_ =
       std::make_shared<BackgroundedWorkThread>(&bg_work_, "BW:LS-" + std::to_string(cfg_.lane_id),
-                                               [this]() { tx_sync_service_->Execute(); });
+                                               [this]() { tx_sync_service_->Execute(); },
+                                               cfg_.cpu_affinity);
   workthread_->ChangeWaitTime(std::chrono::milliseconds{unsigned{SYNC_PERIOD_MS}});
 }
 
@@ -197,11 +234,13 @@ void LaneService::StopInternal()
 {
   reactor_.Stop();
   internal_muddle_->Stop();
+  controller_protocol_.reset();
+  snapshot_sync_.reset();
+  snapshot_protocol_.reset();
   state_db_protocol_.reset();
   state_db_.reset();
   tx_store_protocol_.reset();
   tx_sync_protocol_.reset();
-  controller_protocol_.reset();
   controller_.reset();
 }
 
@@ -210,5 +249,15 @@ bool LaneService::SyncIsReady()
   return tx_sync_service_->IsReady();
 }
 
+std::size_t LaneService::GetMemPoolSizeInBytes() const
+{
+  return tx_store_->GetMemPoolSizeInBytes();
+}
+
+void LaneService::SpillMemPool(std::size_t target_size_in_bytes)
+{
+  tx_store_->SpillMemPool(target_size_in_bytes);
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -20,6 +20,9 @@
 #include "core/containers/is_in.hpp"
 #include "ledger/storage_unit/recent_transaction_cache.hpp"
 
+#include <memory>
+#include <utility>
+
 using fetch::core::IsIn;
 
 namespace fetch {
@@ -35,8 +38,20 @@ RecentTransactionsCache::RecentTransactionsCache(std::size_t max_cache_size,
                                                  uint32_t    log2_num_lanes)
   : max_cache_size_{max_cache_size}
   , log2_num_lanes_{log2_num_lanes}
+  , sharded_balances_{std::make_shared<chain::ShardedBalances>()}
 {}
 
+/**
+ * Set the accounts with sharded balances, used to lay out the transactions added from now on
+ *
+ * @param sharded_balances The accounts with sharded balances
+ */
+void RecentTransactionsCache::SetShardedBalances(ShardedBalancesPtr sharded_balances)
+{
+  FETCH_LOCK(lock_);
+  sharded_balances_ = std::move(sharded_balances);
+}
+
 /**
  * Add a recent transaction to the cache
  *
@@ -50,13 +65,14 @@ void RecentTransactionsCache::Add(chain::Transaction const &tx)
   if (!IsIn(digests_, tx.digest()))
   {
     digests_.emplace(tx.digest());
-    queue_.emplace_front(chain::TransactionLayout{tx, log2_num_lanes_});
+    queue_.emplace_front(chain::TransactionLayout{tx, log2_num_lanes_, *sharded_balances_});
+    expiry_index_.Add(tx.digest(), tx.valid_until());
   }
 
   // if we have reached the capacity of the cache start dropping the oldest ones
   while (queue_.size() > max_cache_size_)
   {
-    digests_.erase(queue_.back().digest());
+    Drop(queue_.back());
     queue_.pop_back();
   }
 }
@@ -69,7 +85,7 @@ void RecentTransactionsCache::Add(chain::Transaction const &tx)
 std::size_t RecentTransactionsCache::GetSize() const
 {
   FETCH_LOCK(lock_);
-  return queue_.size();
+  return digests_.size();
 }
 
 /**
@@ -84,19 +100,60 @@ RecentTransactionsCache::TxLayouts RecentTransactionsCache::Flush(std::size_t nu
   TxLayouts layouts{};
   layouts.reserve(num_to_flush);
 
-  // start popping the transaction off in most recent first order
+  // start popping the transaction off in most recent first order, skipping expired ones
   FETCH_LOCK(lock_);
-  for (std::size_t i = 0; !queue_.empty() && i < num_to_flush; ++i)
+  while (!queue_.empty() && (layouts.size() < num_to_flush))
   {
     auto &current = queue_.front();
 
-    digests_.erase(current.digest());
-    layouts.emplace_back(current);
+    if (Drop(current))
+    {
+      layouts.emplace_back(current);
+    }
+
     queue_.pop_front();
   }
 
   return layouts;
 }
 
+/**
+ * Evict the transactions which are no longer valid at the specified block index
+ *
+ * @param block_index The block index being evaluated
+ * @return The number of transactions evicted from the cache
+ */
+std::size_t RecentTransactionsCache::RemoveExpired(BlockIndex block_index)
+{
+  FETCH_LOCK(lock_);
+
+  auto const expired = expiry_index_.RemoveExpired(block_index);
+  for (auto const &digest : expired)
+  {
+    digests_.erase(digest);
+  }
+
+  return expired.size();
+}
+
+/**
+ * Internal: Remove the digest of a layout which is leaving the queue. Must be called with the
+ * lock held.
+ *
+ * @param layout The layout leaving the queue
+ * @return true if the layout was still cached, false if it had already been evicted
+ */
+bool RecentTransactionsCache::Drop(chain::TransactionLayout const &layout)
+{
+  if (digests_.erase(layout.digest()) == 0)
+  {
+    return false;
+  }
+
+  expiry_index_.Remove(layout.digest(), layout.valid_until());
+
+  return true;
+}
+
 }  // namespace ledger
 }  // namespace fetch
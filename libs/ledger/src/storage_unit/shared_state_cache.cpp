@@ -0,0 +1,480 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/shared_state_cache.hpp"
+#include "logging/logging.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using fetch::telemetry::Registry;
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "SharedStateCache";
+
+}  // namespace
+
+constexpr std::size_t SharedStateCache::NUM_SHARDS;
+
+/**
+ * Construct the shared cache
+ *
+ * @param storage The reference to the underlying storage unit
+ */
+SharedStateCache::SharedStateCache(StorageUnitInterface &storage)
+  : storage_{storage}
+  , hit_count_{Registry::Instance().CreateCounter(
+        "ledger_state_cache_hits_total", "The total number of state reads served by the cache")}
+  , miss_count_{Registry::Instance().CreateCounter(
+        "ledger_state_cache_misses_total",
+        "The total number of state reads forwarded to the storage unit")}
+  , bytes_saved_count_{Registry::Instance().CreateCounter(
+        "ledger_state_cache_bytes_saved_total",
+        "The total number of bytes of state served by the cache instead of the storage unit")}
+  , invalidation_count_{Registry::Instance().CreateCounter(
+        "ledger_state_cache_invalidations_total", "The total number of cache invalidations")}
+  , tx_hit_count_{Registry::Instance().CreateCounter(
+        "ledger_state_cache_tx_hits_total",
+        "The total number of transaction lookups served by the prefetch")}
+  , tx_miss_count_{Registry::Instance().CreateCounter(
+        "ledger_state_cache_tx_misses_total",
+        "The total number of transaction lookups forwarded to the storage unit")}
+{}
+
+SharedStateCache::~SharedStateCache()
+{
+  CancelPrefetch();
+}
+
+/**
+ * Discard all of the cached values
+ */
+void SharedStateCache::Invalidate()
+{
+  // advance the generation first so that any reads currently in flight are discarded
+  ++generation_;
+
+  for (auto &shard : shards_)
+  {
+    FETCH_LOCK(shard.lock);
+    shard.values.clear();
+  }
+
+  invalidation_count_->increment();
+}
+
+/**
+ * Start retrieving the transactions of a block in the background, replacing the transactions
+ * prefetched for the previous block. The batches are retrieved in order, so that the transactions
+ * of the first slices are available as soon as possible
+ *
+ * @param batches The digests of the transactions to retrieve, in batches in order of execution
+ */
+void SharedStateCache::PrefetchTransactions(std::vector<Digests> batches)
+{
+  CancelPrefetch();
+
+  {
+    std::lock_guard<std::mutex> guard{tx_lock_};
+
+    txs_.clear();
+    pending_txs_.clear();
+
+    for (auto const &batch : batches)
+    {
+      pending_txs_.insert(batch.begin(), batch.end());
+    }
+  }
+
+  prefetch_cancelled_ = false;
+
+  // the batches are retrieved in the background, overlapping with the execution of earlier slices
+  prefetch_ = std::async(std::launch::async,
+                         [this, batches = std::move(batches)]() { Prefetch(batches); });
+}
+
+/**
+ * Abandon and wait for the prefetch of the previous block (if any)
+ */
+void SharedStateCache::CancelPrefetch()
+{
+  if (prefetch_.valid())
+  {
+    prefetch_cancelled_ = true;
+    prefetch_.wait();
+  }
+}
+
+/**
+ * Retrieve each of the batches of transactions in turn
+ *
+ * @param batches The digests of the transactions to retrieve
+ */
+void SharedStateCache::Prefetch(std::vector<Digests> const &batches)
+{
+  for (auto const &batch : batches)
+  {
+    Transactions retrieved{};
+
+    if (!prefetch_cancelled_)
+    {
+      try
+      {
+        for (auto &tx : storage_.GetTransactions(batch))
+        {
+          auto const digest = tx.digest();
+          retrieved.emplace(digest, std::move(tx));
+        }
+      }
+      catch (std::exception const &ex)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Failed to prefetch transactions: ", ex.what());
+      }
+    }
+
+    // transactions which were not retrieved are looked up individually
+    {
+      std::lock_guard<std::mutex> guard{tx_lock_};
+
+      for (auto const &digest : batch)
+      {
+        pending_txs_.erase(digest);
+      }
+
+      for (auto &element : retrieved)
+      {
+        txs_.emplace(element.first, std::move(element.second));
+      }
+    }
+
+    tx_arrived_.notify_all();
+  }
+}
+
+/**
+ * Get the number of cached values
+ *
+ * @return The number of cached values
+ */
+std::size_t SharedStateCache::size() const
+{
+  std::size_t count{0};
+
+  for (auto const &shard : shards_)
+  {
+    FETCH_LOCK(shard.lock);
+    count += shard.values.size();
+  }
+
+  return count;
+}
+
+/**
+ * Get a resource from the cache or the storage unit
+ *
+ * @param key The key to be accessed
+ * @return The document containing the result
+ */
+SharedStateCache::Document SharedStateCache::Get(ResourceAddress const &key) const
+{
+  Document document{};
+
+  if (!Find(key, document))
+  {
+    Generation const generation = generation_;
+
+    document = storage_.Get(key);
+    Insert(key, document, generation);
+  }
+
+  return document;
+}
+
+/**
+ * Get or create a resource in the storage unit. Newly created resources are not cached.
+ *
+ * @param key The key to be accessed
+ * @return The document containing the result
+ */
+SharedStateCache::Document SharedStateCache::GetOrCreate(ResourceAddress const &key)
+{
+  Document document{};
+
+  if (!Find(key, document))
+  {
+    Generation const generation = generation_;
+
+    document = storage_.GetOrCreate(key);
+    if (!document.was_created)
+    {
+      Insert(key, document, generation);
+    }
+  }
+
+  return document;
+}
+
+/**
+ * Get a batch of resources. Only the keys which are not cached are requested (as a single batch)
+ * from the underlying storage unit.
+ *
+ * @param keys The keys to be accessed
+ * @return The documents, in the same order as the keys
+ */
+SharedStateCache::Documents SharedStateCache::GetBatch(ResourceAddresses const &keys) const
+{
+  Documents                documents(keys.size());
+  ResourceAddresses        missing_keys{};
+  std::vector<std::size_t> missing_indices{};
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    if (!Find(keys[i], documents[i]))
+    {
+      missing_keys.emplace_back(keys[i]);
+      missing_indices.emplace_back(i);
+    }
+  }
+
+  if (!missing_keys.empty())
+  {
+    Generation const generation = generation_;
+
+    auto results = storage_.GetBatch(missing_keys);
+    assert(results.size() == missing_keys.size());
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      Insert(missing_keys[i], results[i], generation);
+      documents[missing_indices[i]] = std::move(results[i]);
+    }
+  }
+
+  return documents;
+}
+
+/**
+ * Set a value on the storage unit, updating the cached value
+ *
+ * @param key The key of the value
+ * @param value The value being set
+ */
+void SharedStateCache::Set(ResourceAddress const &key, StateValue const &value)
+{
+  storage_.Set(key, value);
+
+  auto &shard = Lookup(key);
+  FETCH_LOCK(shard.lock);
+  shard.values[key] = value;
+}
+
+/**
+ * Set a batch of values on the storage unit (as a single batch), updating the cached values
+ *
+ * @param keys The keys of the values
+ * @param values The values being set, in the same order as the keys
+ */
+void SharedStateCache::SetBatch(ResourceAddresses const &keys, StateValues const &values)
+{
+  storage_.SetBatch(keys, values);
+
+  for (std::size_t i = 0, end = std::min(keys.size(), values.size()); i < end; ++i)
+  {
+    auto &shard = Lookup(keys[i]);
+    FETCH_LOCK(shard.lock);
+    shard.values[keys[i]] = values[i];
+  }
+}
+
+bool SharedStateCache::Lock(ShardIndex shard)
+{
+  return storage_.Lock(shard);
+}
+
+bool SharedStateCache::Unlock(ShardIndex shard)
+{
+  return storage_.Unlock(shard);
+}
+
+void SharedStateCache::Reset()
+{
+  storage_.Reset();
+  Invalidate();
+}
+
+void SharedStateCache::AddTransaction(chain::Transaction const &tx)
+{
+  storage_.AddTransaction(tx);
+}
+
+bool SharedStateCache::GetTransaction(Digest const &digest, chain::Transaction &tx)
+{
+  {
+    std::unique_lock<std::mutex> lock{tx_lock_};
+
+    // wait for the transaction if it is still being prefetched
+    tx_arrived_.wait(lock, [this, &digest]() { return pending_txs_.count(digest) == 0; });
+
+    auto const it = txs_.find(digest);
+    if (it != txs_.end())
+    {
+      tx = it->second;
+      tx_hit_count_->increment();
+      return true;
+    }
+  }
+
+  tx_miss_count_->increment();
+  return storage_.GetTransaction(digest, tx);
+}
+
+bool SharedStateCache::HasTransaction(Digest const &digest)
+{
+  return storage_.HasTransaction(digest);
+}
+
+void SharedStateCache::IssueCallForMissingTxs(DigestSet const &tx_set)
+{
+  storage_.IssueCallForMissingTxs(tx_set);
+}
+
+void SharedStateCache::SetTransactionCallback(TransactionCallback callback)
+{
+  storage_.SetTransactionCallback(std::move(callback));
+}
+
+void SharedStateCache::RemoveExpiredTransactions(uint64_t block_index)
+{
+  storage_.RemoveExpiredTransactions(block_index);
+}
+
+SharedStateCache::TxLayouts SharedStateCache::PollRecentTx(uint32_t max_to_poll)
+{
+  return storage_.PollRecentTx(max_to_poll);
+}
+
+SharedStateCache::Hash SharedStateCache::CurrentHash()
+{
+  return storage_.CurrentHash();
+}
+
+SharedStateCache::Hash SharedStateCache::LastCommitHash()
+{
+  return storage_.LastCommitHash();
+}
+
+bool SharedStateCache::RevertToHash(Hash const &hash, uint64_t index)
+{
+  bool const success = storage_.RevertToHash(hash, index);
+  Invalidate();
+
+  return success;
+}
+
+SharedStateCache::Hash SharedStateCache::Commit(uint64_t index)
+{
+  auto const hash = storage_.Commit(index);
+  Invalidate();
+
+  return hash;
+}
+
+bool SharedStateCache::HashExists(Hash const &hash, uint64_t index)
+{
+  return storage_.HashExists(hash, index);
+}
+
+/**
+ * Determine the shard which is responsible for the specified key
+ *
+ * @param key The key to be located
+ * @return The responsible shard
+ */
+SharedStateCache::Shard &SharedStateCache::Lookup(ResourceAddress const &key) const
+{
+  return shards_[std::hash<ResourceAddress>{}(key) % NUM_SHARDS];
+}
+
+/**
+ * Attempt to serve a resource from the cache
+ *
+ * @param key The key to be accessed
+ * @param document The document to be populated on a cache hit
+ * @return true if the value was cached, otherwise false
+ */
+bool SharedStateCache::Find(ResourceAddress const &key, Document &document) const
+{
+  {
+    auto &shard = Lookup(key);
+    FETCH_LOCK(shard.lock);
+
+    auto const it = shard.values.find(key);
+    if (it == shard.values.end())
+    {
+      miss_count_->increment();
+      return false;
+    }
+
+    document          = Document{};
+    document.document = it->second;
+  }
+
+  hit_count_->increment();
+  bytes_saved_count_->add(document.document.size());
+
+  return true;
+}
+
+/**
+ * Cache the result of a read from the storage unit. Failed reads and reads which were started
+ * before the last invalidation are discarded. Values which are already cached are never replaced
+ * since they can only be newer (written through this cache) than the value being inserted.
+ *
+ * @param key The key which was read
+ * @param document The document that was read
+ * @param generation The cache generation at the point the read was started
+ */
+void SharedStateCache::Insert(ResourceAddress const &key, Document const &document,
+                              Generation generation) const
+{
+  if (document.failed)
+  {
+    return;
+  }
+
+  auto &shard = Lookup(key);
+  FETCH_LOCK(shard.lock);
+
+  if (generation == generation_)
+  {
+    shard.values.emplace(key, document.document);
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,272 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/speculative_storage_adapter.hpp"
+#include "logging/logging.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "SpeculativeStorage";
+
+}  // namespace
+
+/**
+ * Determine if any of the keys read during the speculation have been modified
+ *
+ * @param dirty_keys The set of keys written by previously committed transactions
+ * @return true if the speculation observed a stale value, otherwise false
+ */
+bool SpeculativeStorageAdapter::AccessSet::ConflictsWith(KeySet const &dirty_keys) const
+{
+  if (dirty_keys.empty())
+  {
+    return false;
+  }
+
+  for (auto const &key : reads)
+  {
+    if (dirty_keys.find(key) != dirty_keys.end())
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Write all the buffered values to the specified storage engine, as a single batch
+ *
+ * @param storage The storage engine to be updated
+ * @param dirty_keys The set of modified keys which will be updated
+ */
+void SpeculativeStorageAdapter::AccessSet::ApplyTo(StorageInterface &storage,
+                                                   KeySet &          dirty_keys) const
+{
+  if (writes.empty())
+  {
+    return;
+  }
+
+  ResourceAddresses keys{};
+  StateValues       values{};
+  keys.reserve(writes.size());
+  values.reserve(writes.size());
+
+  for (auto const &entry : writes)
+  {
+    keys.emplace_back(entry.first);
+    values.emplace_back(entry.second);
+    dirty_keys.insert(entry.first);
+  }
+
+  storage.SetBatch(keys, values);
+}
+
+/**
+ * Construct the speculative adapter
+ *
+ * @param storage The reference to the underlying storage unit
+ */
+SpeculativeStorageAdapter::SpeculativeStorageAdapter(StorageUnitInterface &storage)
+  : storage_{storage}
+{}
+
+/**
+ * Start a new speculation, discarding any previously recorded accesses
+ */
+void SpeculativeStorageAdapter::Begin()
+{
+  FETCH_LOCK(lock_);
+  reads_.clear();
+  writes_.clear();
+}
+
+/**
+ * Extract the read and write sets for the current speculation
+ *
+ * @return The access set
+ */
+SpeculativeStorageAdapter::AccessSet SpeculativeStorageAdapter::TakeAccessSet()
+{
+  FETCH_LOCK(lock_);
+
+  AccessSet access{};
+  access.reads.reserve(reads_.size());
+  for (auto const &entry : reads_)
+  {
+    access.reads.insert(entry.first);
+  }
+  access.writes = std::move(writes_);
+
+  reads_.clear();
+  writes_.clear();
+
+  return access;
+}
+
+/**
+ * Get a resource, preferring the pending writes of this speculation
+ *
+ * @param key The key to be accessed
+ * @return The document containing the result
+ */
+SpeculativeStorageAdapter::Document SpeculativeStorageAdapter::Get(
+    ResourceAddress const &key) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const write_it = writes_.find(key);
+  if (write_it != writes_.end())
+  {
+    Document document{};
+    document.document = write_it->second;
+    return document;
+  }
+
+  auto read_it = reads_.find(key);
+  if (read_it == reads_.end())
+  {
+    read_it = reads_.emplace(key, storage_.Get(key)).first;
+  }
+
+  return read_it->second;
+}
+
+/**
+ * Get or create a resource. Creation is recorded as a write so that it only takes effect if the
+ * speculation is committed.
+ *
+ * @param key The key to be accessed
+ * @return The document containing the result
+ */
+SpeculativeStorageAdapter::Document SpeculativeStorageAdapter::GetOrCreate(
+    ResourceAddress const &key)
+{
+  Document document = Get(key);
+
+  if (document.failed)
+  {
+    FETCH_LOCK(lock_);
+    writes_[key] = StateValue{};
+
+    document             = Document{};
+    document.was_created = true;
+  }
+
+  return document;
+}
+
+/**
+ * Buffer a write to the specified key
+ *
+ * @param key The key of the value
+ * @param value The value being set
+ */
+void SpeculativeStorageAdapter::Set(ResourceAddress const &key, StateValue const &value)
+{
+  FETCH_LOCK(lock_);
+
+  // The cached storage adapter writes back every value it has read. Filtering out writes which do
+  // not change the observed value avoids generating false conflicts for later transactions.
+  if (writes_.find(key) == writes_.end())
+  {
+    auto const read_it = reads_.find(key);
+    if ((read_it != reads_.end()) && !read_it->second.failed &&
+        (read_it->second.document == value))
+    {
+      return;
+    }
+  }
+
+  writes_[key] = value;
+}
+
+bool SpeculativeStorageAdapter::Lock(ShardIndex shard)
+{
+  return storage_.Lock(shard);
+}
+
+bool SpeculativeStorageAdapter::Unlock(ShardIndex shard)
+{
+  return storage_.Unlock(shard);
+}
+
+void SpeculativeStorageAdapter::Reset()
+{
+  FETCH_LOG_WARN(LOGGING_NAME, "Attempted to reset storage during speculative execution");
+}
+
+void SpeculativeStorageAdapter::AddTransaction(chain::Transaction const &tx)
+{
+  storage_.AddTransaction(tx);
+}
+
+bool SpeculativeStorageAdapter::GetTransaction(Digest const &digest, chain::Transaction &tx)
+{
+  return storage_.GetTransaction(digest, tx);
+}
+
+bool SpeculativeStorageAdapter::HasTransaction(Digest const &digest)
+{
+  return storage_.HasTransaction(digest);
+}
+
+void SpeculativeStorageAdapter::IssueCallForMissingTxs(DigestSet const &tx_set)
+{
+  storage_.IssueCallForMissingTxs(tx_set);
+}
+
+SpeculativeStorageAdapter::TxLayouts SpeculativeStorageAdapter::PollRecentTx(uint32_t max_to_poll)
+{
+  return storage_.PollRecentTx(max_to_poll);
+}
+
+SpeculativeStorageAdapter::Hash SpeculativeStorageAdapter::CurrentHash()
+{
+  return storage_.CurrentHash();
+}
+
+SpeculativeStorageAdapter::Hash SpeculativeStorageAdapter::LastCommitHash()
+{
+  return storage_.LastCommitHash();
+}
+
+bool SpeculativeStorageAdapter::RevertToHash(Hash const & /*hash*/, uint64_t /*index*/)
+{
+  FETCH_LOG_WARN(LOGGING_NAME, "Attempted to revert storage during speculative execution");
+  return false;
+}
+
+SpeculativeStorageAdapter::Hash SpeculativeStorageAdapter::Commit(uint64_t /*index*/)
+{
+  FETCH_LOG_WARN(LOGGING_NAME, "Attempted to commit storage during speculative execution");
+  return {};
+}
+
+bool SpeculativeStorageAdapter::HashExists(Hash const &hash, uint64_t index)
+{
+  return storage_.HashExists(hash, index);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "ledger/storage_unit/state_reshard.hpp"
+#include "logging/logging.hpp"
+#include "meta/log2.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage/state_snapshot.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using byte_array::ConstByteArray;
+using storage::NewRevertibleDocumentStore;
+using storage::ResourceID;
+using storage::StateSnapshotChunk;
+
+using IndexBackend = NewRevertibleDocumentStore::IndexBackend;
+
+constexpr char const *LOGGING_NAME = "StateReshard";
+constexpr std::size_t CHUNK_SIZE   = 10000;
+
+struct LaneState
+{
+  NewRevertibleDocumentStore::Keys   keys{};
+  NewRevertibleDocumentStore::Values values{};
+};
+
+using LaneStates = std::vector<LaneState>;
+
+// must match the storage prefix generated by the LaneService
+std::string GeneratePrefix(std::string const &storage_path, uint32_t lane)
+{
+  std::ostringstream oss;
+  oss << storage_path << "_lane" << std::setw(3) << std::setfill('0') << lane << "_";
+  return oss.str();
+}
+
+}  // namespace
+
+/**
+ * Migrate the current state of every lane of a node to a larger number of lanes.
+ *
+ * A resource is mapped to a lane by the low bits of its resource group, so doubling the number of
+ * lanes splits every lane in two: each of the destination lanes receives documents from exactly
+ * one of the source lanes. The source lanes are therefore migrated one at a time, holding no more
+ * than a single lane in memory.
+ *
+ * Only the current state is migrated, the history of the source lanes is not. Since the lane count
+ * is part of the state root of every block, the migrated state is intended to seed a new network
+ * (or a new genesis) rather than to be served alongside the existing chain.
+ *
+ * @param source_path The storage path of the existing node, i.e. "node_storage"
+ * @param source_lanes The number of lanes of the existing node
+ * @param destination_path The storage path of the migrated node (must differ from the source)
+ * @param destination_lanes The number of lanes to migrate to
+ * @param backend The state index backend used by the lanes
+ * @return true if successful, otherwise false
+ */
+bool ReshardState(std::string const &source_path, uint32_t source_lanes,
+                  std::string const &destination_path, uint32_t destination_lanes,
+                  IndexBackend backend)
+{
+  if (!meta::IsLog2(source_lanes) || !meta::IsLog2(destination_lanes))
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "The number of lanes must be a power of two");
+    return false;
+  }
+
+  if (destination_lanes < source_lanes)
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "The number of lanes can only be increased");
+    return false;
+  }
+
+  if (source_path == destination_path)
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "The destination storage path must differ from the source");
+    return false;
+  }
+
+  uint32_t const log2_destination_lanes = meta::Log2(destination_lanes);
+  uint32_t const split                  = destination_lanes / source_lanes;
+
+  // the index files are named by backend, matching the LaneService
+  std::string const index_name =
+      (IndexBackend::B_TREE == backend) ? "state_btree_index" : "state_index";
+
+  std::size_t total{0};
+  for (uint32_t source_lane = 0; source_lane < source_lanes; ++source_lane)
+  {
+    std::string const source_prefix = GeneratePrefix(source_path, source_lane);
+
+    // loading a missing store would create it, silently dropping the lane from the migration
+    std::ifstream const existing(source_prefix + "state.db", std::ios::binary | std::ios::in);
+
+    NewRevertibleDocumentStore source{backend};
+    if (!existing ||
+        !source.Load(source_prefix + "state.db", source_prefix + "state_deltas.db",
+                     source_prefix + index_name + ".db", source_prefix + index_name + "_deltas.db",
+                     false))
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Unable to load the state of lane ", source_lane);
+      return false;
+    }
+
+    // split the documents of the lane between its destination lanes
+    LaneStates         lanes(destination_lanes);
+    StateSnapshotChunk chunk{};
+    ResourceID         cursor{};
+    std::size_t        count{0};
+
+    do
+    {
+      if (!source.ReadSnapshotChunk(cursor, CHUNK_SIZE, chunk))
+      {
+        FETCH_LOG_ERROR(LOGGING_NAME, "Unable to read the state of lane ", source_lane);
+        return false;
+      }
+
+      for (std::size_t i = 0; i < chunk.keys.size(); ++i)
+      {
+        auto &lane = lanes[chunk.keys[i].lane(log2_destination_lanes)];
+        lane.keys.emplace_back(chunk.keys[i]);
+        lane.values.emplace_back(chunk.values[i]);
+      }
+
+      count += chunk.keys.size();
+      if (!chunk.keys.empty())
+      {
+        cursor = chunk.keys.back();
+      }
+    } while (!chunk.complete);
+
+    FETCH_LOG_INFO(LOGGING_NAME, "Lane ", source_lane, ": ", count, " documents. State hash: 0x",
+                   chunk.state.ToHex());
+
+    // the destination lanes of this source lane are source_lane, source_lane + source_lanes, ...
+    for (uint32_t i = 0; i < split; ++i)
+    {
+      uint32_t const    lane   = source_lane + (i * source_lanes);
+      std::string const prefix = GeneratePrefix(destination_path, lane);
+
+      NewRevertibleDocumentStore destination{backend};
+      destination.New(prefix + "state.db", prefix + "state_deltas.db", prefix + index_name + ".db",
+                      prefix + index_name + "_deltas.db", false);
+
+      destination.Import(lanes[lane].keys, lanes[lane].values);
+      ConstByteArray const hash = destination.Commit();
+
+      FETCH_LOG_INFO(LOGGING_NAME, "  -> Lane ", lane, ": ", lanes[lane].keys.size(),
+                     " documents. State hash: 0x", hash.ToHex());
+    }
+
+    total += count;
+  }
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Migrated ", total, " documents from ", source_lanes, " to ",
+                 destination_lanes, " lanes");
+
+  return true;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/state_snapshot_protocol.hpp"
+#include "logging/logging.hpp"
+#include "storage/new_revertible_document_store.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/histogram.hpp"
+#include "telemetry/registry.hpp"
+#include "telemetry/utils/timer.hpp"
+
+#include <string>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t StateSnapshotProtocol::MAX_CHUNK_ENTRIES;
+
+/**
+ * Construct the state snapshot protocol
+ *
+ * @param state_db The state database of the lane
+ * @param lane The index of the lane
+ */
+StateSnapshotProtocol::StateSnapshotProtocol(StateDb &state_db, uint32_t lane)
+  : state_db_{state_db}
+  , lane_{lane}
+  , chunk_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_state_snapshot_chunk_total", "The total number of state snapshot chunks served",
+        {{"lane", std::to_string(lane_)}})}
+  , chunk_failure_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_state_snapshot_chunk_failure_total",
+        "The total number of state snapshot chunk requests which could not be served",
+        {{"lane", std::to_string(lane_)}})}
+  , chunk_durations_{telemetry::Registry::Instance().CreateHistogram(
+        {0.0001, 0.0002, 0.0005, 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1, 2, 5},
+        "ledger_state_snapshot_chunk_duration",
+        "The histogram of state snapshot chunk read durations in seconds",
+        {{"lane", std::to_string(lane_)}})}
+{
+  Expose(GET_CHUNK, this, &StateSnapshotProtocol::GetChunk);
+}
+
+/**
+ * Read the next chunk of the lane's current state
+ *
+ * @param cursor The last key of the previous chunk, or an empty key for the first chunk
+ * @return The chunk. If the cursor is no longer present (because the state has changed since the
+ * previous chunk was read) the chunk is returned without a state hash.
+ */
+StateSnapshotProtocol::Chunk StateSnapshotProtocol::GetChunk(ResourceID const &cursor)
+{
+  telemetry::FunctionTimer const timer{*chunk_durations_};
+
+  Chunk chunk{};
+  if (!state_db_.ReadSnapshotChunk(cursor, MAX_CHUNK_ENTRIES, chunk))
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Lane ", lane_, ": Unable to resume snapshot from 0x",
+                    cursor.id().ToHex());
+
+    chunk_failure_total_->increment();
+    return Chunk{};
+  }
+
+  chunk_total_->increment();
+  return chunk;
+}
+
+}  // namespace ledger
+}  // namespace fetch
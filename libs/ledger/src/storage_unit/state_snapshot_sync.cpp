@@ -0,0 +1,287 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/service_ids.hpp"
+#include "ledger/storage_unit/state_snapshot_protocol.hpp"
+#include "ledger/storage_unit/state_snapshot_sync.hpp"
+#include "logging/logging.hpp"
+#include "muddle/muddle_endpoint.hpp"
+#include "storage/new_revertible_document_store.hpp"
+#include "storage/state_snapshot.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+
+#include <chrono>
+#include <string>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using namespace std::chrono_literals;
+
+using State        = StateSnapshotSync::State;
+using Status       = StateSnapshotSync::Status;
+using PromiseState = service::PromiseState;
+
+char const *ToString(State state)
+{
+  char const *text = "Unknown";
+
+  switch (state)
+  {
+  case State::IDLE:
+    text = "Idle";
+    break;
+  case State::SELECT_PEER:
+    text = "Select Peer";
+    break;
+  case State::REQUEST_CHUNK:
+    text = "Request Chunk";
+    break;
+  case State::WAIT_FOR_CHUNK:
+    text = "Wait for Chunk";
+    break;
+  }
+
+  return text;
+}
+
+telemetry::CounterPtr CreateCounter(uint32_t lane, char const *name, char const *description)
+{
+  return telemetry::Registry::Instance().CreateCounter(name, description,
+                                                       {{"lane", std::to_string(lane)}});
+}
+
+}  // namespace
+
+constexpr std::size_t StateSnapshotSync::MAX_ATTEMPTS;
+
+/**
+ * Construct the state snapshot sync
+ *
+ * @param endpoint The lane's external muddle endpoint (connected to the lane's peers)
+ * @param state_db The state database of the lane
+ * @param lane The index of the lane
+ */
+StateSnapshotSync::StateSnapshotSync(MuddleEndpoint &endpoint, StateDb &state_db, uint32_t lane)
+  : endpoint_{endpoint}
+  , state_db_{state_db}
+  , lane_{lane}
+  , rpc_client_{"R:Snapshot-L" + std::to_string(lane), endpoint, SERVICE_LANE, CHANNEL_RPC}
+  , state_machine_{std::make_shared<StateMachine>("StateSnapshotSync", State::IDLE,
+                                                  [](State state) { return ToString(state); })}
+  , chunk_total_{CreateCounter(lane, "ledger_state_snapshot_sync_chunk_total",
+                               "The total number of state snapshot chunks downloaded")}
+  , restart_total_{CreateCounter(lane, "ledger_state_snapshot_sync_restart_total",
+                                 "The total number of state snapshot downloads restarted")}
+  , success_total_{CreateCounter(lane, "ledger_state_snapshot_sync_success_total",
+                                 "The total number of state snapshots downloaded successfully")}
+  , failure_total_{CreateCounter(lane, "ledger_state_snapshot_sync_failure_total",
+                                 "The total number of state snapshot downloads which failed")}
+{
+  state_machine_->RegisterHandler(State::IDLE, this, &StateSnapshotSync::OnIdle);
+  state_machine_->RegisterHandler(State::SELECT_PEER, this, &StateSnapshotSync::OnSelectPeer);
+  state_machine_->RegisterHandler(State::REQUEST_CHUNK, this, &StateSnapshotSync::OnRequestChunk);
+  state_machine_->RegisterHandler(State::WAIT_FOR_CHUNK, this, &StateSnapshotSync::OnWaitForChunk);
+}
+
+StateSnapshotSync::WeakRunnable StateSnapshotSync::GetWeakRunnable() const
+{
+  return state_machine_;
+}
+
+/**
+ * Request that the state of the lane is replaced with a snapshot from one of its peers
+ *
+ * @return true if the download has been started, false if one is already in progress
+ */
+bool StateSnapshotSync::Begin()
+{
+  Status current = status_.load();
+
+  do
+  {
+    if (Status::IN_PROGRESS == current)
+    {
+      return false;
+    }
+  } while (!status_.compare_exchange_weak(current, Status::IN_PROGRESS));
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Lane ", lane_, ": State snapshot download requested");
+
+  return true;
+}
+
+/**
+ * Get the status of the most recent snapshot download
+ *
+ * @return The status (see StateSnapshotSync::Status)
+ */
+uint8_t StateSnapshotSync::GetStatus()
+{
+  return static_cast<uint8_t>(status_.load());
+}
+
+StateSnapshotSync::State StateSnapshotSync::OnIdle()
+{
+  if (Status::IN_PROGRESS == status_)
+  {
+    attempts_ = 0;
+    return State::SELECT_PEER;
+  }
+
+  state_machine_->Delay(500ms);
+  return State::IDLE;
+}
+
+StateSnapshotSync::State StateSnapshotSync::OnSelectPeer()
+{
+  if (attempts_ >= MAX_ATTEMPTS)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Lane ", lane_, ": Unable to download state snapshot after ",
+                   attempts_, " attempts");
+
+    failure_total_->increment();
+    status_ = Status::FAILED;
+
+    return State::IDLE;
+  }
+
+  auto const peers = endpoint_.GetDirectlyConnectedPeers();
+  ++attempts_;
+
+  if (peers.empty())
+  {
+    state_machine_->Delay(2s);
+    return State::SELECT_PEER;
+  }
+
+  // rotate through the peers on each attempt
+  peer_ = peers[attempts_ % peers.size()];
+
+  ClearState();
+
+  cursor_      = storage::ResourceID{};
+  expected_    = Hash{};
+  num_entries_ = 0;
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Lane ", lane_, ": Downloading state snapshot from: ",
+                 peer_.ToBase64());
+
+  return State::REQUEST_CHUNK;
+}
+
+StateSnapshotSync::State StateSnapshotSync::OnRequestChunk()
+{
+  promise_ = rpc_client_.CallSpecificAddress(peer_, RPC_STATE_SNAPSHOT,
+                                             StateSnapshotProtocol::GET_CHUNK, cursor_);
+
+  return State::WAIT_FOR_CHUNK;
+}
+
+StateSnapshotSync::State StateSnapshotSync::OnWaitForChunk()
+{
+  auto const status = promise_->state();
+  if (PromiseState::WAITING == status)
+  {
+    state_machine_->Delay(20ms);
+    return State::WAIT_FOR_CHUNK;
+  }
+
+  storage::StateSnapshotChunk chunk{};
+  if ((PromiseState::SUCCESS != status) || !promise_->GetResult(chunk))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Lane ", lane_, ": Failed to request snapshot chunk from: ",
+                   peer_.ToBase64());
+    return Retry();
+  }
+
+  // every chunk must be read from the same state, otherwise the peer's state has moved on (or it
+  // is not being honest) and the download must be started again
+  bool const consistent = !chunk.state.empty() &&
+                          (expected_.empty() || (chunk.state == expected_)) &&
+                          (chunk.keys.size() == chunk.values.size());
+
+  if (!consistent || (!chunk.complete && chunk.keys.empty()))
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Lane ", lane_, ": Snapshot state changed during download from: ",
+                   peer_.ToBase64());
+    return Retry();
+  }
+
+  expected_ = chunk.state;
+
+  state_db_.WriteSnapshotChunk(chunk);
+  state_db_.FlushPendingWrites();
+  num_entries_ += chunk.keys.size();
+  chunk_total_->increment();
+
+  if (!chunk.complete)
+  {
+    cursor_ = chunk.keys.back();
+    return State::REQUEST_CHUNK;
+  }
+
+  // check that the state which has been built matches the one the peer reported
+  auto const hash = state_db_.Commit();
+  if (hash != expected_)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Lane ", lane_, ": Snapshot state hash mismatch. Expected: 0x",
+                   expected_.ToHex(), " actual: 0x", hash.ToHex());
+    return Retry();
+  }
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Lane ", lane_, ": Downloaded state snapshot 0x", hash.ToHex(),
+                 " (", num_entries_, " entries)");
+
+  success_total_->increment();
+  status_ = Status::COMPLETE;
+
+  return State::IDLE;
+}
+
+/**
+ * Internal: Erase the contents of the state database. Unlike a reset, this keeps the history of
+ * the database intact so that the previous state can still be restored if the download fails.
+ */
+void StateSnapshotSync::ClearState()
+{
+  std::size_t const max_entries = StateSnapshotProtocol::MAX_CHUNK_ENTRIES;
+
+  storage::StateSnapshotChunk chunk{};
+  while (state_db_.ReadSnapshotChunk(storage::ResourceID{}, max_entries, chunk) &&
+         !chunk.keys.empty())
+  {
+    for (auto const &key : chunk.keys)
+    {
+      state_db_.Erase(key);
+    }
+  }
+}
+
+StateSnapshotSync::State StateSnapshotSync::Retry()
+{
+  restart_total_->increment();
+  state_machine_->Delay(500ms);
+
+  return State::SELECT_PEER;
+}
+
+}  // namespace ledger
+}  // namespace fetch
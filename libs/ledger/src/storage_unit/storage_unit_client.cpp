@@ -23,14 +23,23 @@
 #include "ledger/storage_unit/storage_unit_client.hpp"
 #include "ledger/storage_unit/transaction_finder_protocol.hpp"
 #include "ledger/storage_unit/transaction_storage_protocol.hpp"
+#include "telemetry/histogram.hpp"
+#include "telemetry/registry.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <sstream>
 #include <stdexcept>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 using fetch::storage::ResourceID;
 using fetch::storage::RevertibleDocumentStoreProtocol;
@@ -58,6 +67,30 @@ AddressList GenerateAddressList(ShardConfigs const &shards)
 constexpr char const *MERKLE_FILENAME_DOC   = "merkle_stack.db";
 constexpr char const *MERKLE_FILENAME_INDEX = "merkle_stack_index.db";
 
+using Clock = std::chrono::steady_clock;
+
+// the time allowed for all the lanes to respond to a request (matching the promise timeout)
+constexpr std::chrono::seconds LANE_RESPONSE_TIMEOUT{30};
+
+// the additional time allowed for the lanes to revert, since this can require a large amount of
+// history to be unwound
+constexpr uint64_t LANE_REVERT_EXTENSION{180};
+
+// the additional time allowed for the lanes to import a batch of documents, i.e. the genesis state
+constexpr uint64_t LANE_IMPORT_EXTENSION{600};
+
+/**
+ * The queue of lanes which have responded to a request, in the order in which they responded
+ */
+struct LaneResponseQueue
+{
+  using Response = std::pair<uint32_t, Clock::time_point>;
+
+  std::mutex              lock;
+  std::condition_variable notify;
+  std::deque<Response>    ready;
+};
+
 }  // namespace
 
 StorageUnitClient::StorageUnitClient(MuddleEndpoint &muddle, ShardConfigs const &shards,
@@ -66,12 +99,18 @@ StorageUnitClient::StorageUnitClient(MuddleEndpoint &muddle, ShardConfigs const
   , log2_num_lanes_(log2_num_lanes)
   , rpc_client_{std::make_shared<Client>("STUC", muddle, SERVICE_LANE_CTRL, CHANNEL_RPC)}
   , current_merkle_{num_lanes()}
+  , current_hash_durations_{CreateLaneHistograms("current_hash")}
+  , commit_durations_{CreateLaneHistograms("commit")}
+  , revert_durations_{CreateLaneHistograms("revert")}
 {
   if (num_lanes() != shards.size())
   {
     throw std::logic_error("Incorrect number of shard configs");
   }
 
+  // the lanes receive a large number of small calls, combine those made at the same time
+  rpc_client_->EnableBatching();
+
   permanent_state_merkle_stack_.Load(MERKLE_FILENAME_DOC, MERKLE_FILENAME_INDEX, true);
   FETCH_LOG_INFO(LOGGING_NAME,
                  "After recovery, size of merkle stack is: ", permanent_state_merkle_stack_.size());
@@ -80,32 +119,28 @@ StorageUnitClient::StorageUnitClient(MuddleEndpoint &muddle, ShardConfigs const
 // Get the current hash of the world state (merkle tree root)
 byte_array::ConstByteArray StorageUnitClient::CurrentHash()
 {
-  MerkleTree                    tree{num_lanes()};
-  std::vector<service::Promise> promises;
+  MerkleTree tree{num_lanes()};
 
-  for (uint32_t i = 0; i < num_lanes(); ++i)
-  {
-    auto promise = rpc_client_->CallSpecificAddress(LookupAddress(i), RPC_STATE,
-                                                    RevertibleDocumentStoreProtocol::CURRENT_HASH);
+  auto const promises = CallAllLanes(RevertibleDocumentStoreProtocol::CURRENT_HASH);
+  auto const deadline = Clock::now() + LANE_RESPONSE_TIMEOUT;
 
-    promises.push_back(promise);
-  }
+  bool const success = WaitForLanes(
+      promises, current_hash_durations_, deadline,
+      [&tree](LaneIndex lane, service::Promise const &promise) {
+        byte_array::ByteArray digest{};
+        if (!promise->GetResult(digest))
+        {
+          FETCH_LOG_WARN(LOGGING_NAME, "Failed to generate merkle hash no leaf: ", lane);
+          return false;
+        }
 
-  std::size_t index = 0;
-  for (auto &p : promises)
-  {
-    byte_array::ByteArray digest{};
-    if (p->GetResult(digest))
-    {
-      tree[index] = digest;
-    }
-    else
-    {
-      FETCH_LOG_WARN(LOGGING_NAME, "Failed to generate merkle hash no leaf: ", index);
-      return {};
-    }
+        tree[lane] = digest;
+        return true;
+      });
 
-    ++index;
+  if (!success)
+  {
+    return {};
   }
 
   tree.CalculateRoot();
@@ -177,39 +212,28 @@ bool StorageUnitClient::RevertToHash(Hash const &hash, uint64_t index)
   FETCH_LOG_DEBUG(LOGGING_NAME, "Successfully found merkle at: ", index);
 
   // Note: we shouldn't be touching the lanes at this point from other threads
-  std::vector<service::Promise> promises;
-  promises.reserve(num_lanes());
+  auto const promises = CallAllLanes(RevertibleDocumentStoreProtocol::REVERT_TO_HASH, &tree);
+  auto const deadline =
+      Clock::now() + LANE_RESPONSE_TIMEOUT + std::chrono::seconds{LANE_REVERT_EXTENSION};
 
-  // Now perform the revert
-  StorageUnitClient::LaneIndex lane_index{0};
-  for (auto const &lane_merkle_hash : tree)
-  {
-    assert(!hash.empty());
+  // wait for every lane to respond, even once one of them has failed
+  bool all_success{true};
+  bool const all_responded = WaitForLanes(
+      promises, revert_durations_, deadline,
+      [&tree, &all_success](LaneIndex lane, service::Promise const &promise) {
+        bool item_success{false};
+        if (!(promise->GetResult(item_success, LANE_REVERT_EXTENSION) && item_success))
+        {
+          FETCH_LOG_WARN(LOGGING_NAME, "Failed to revert shard ", lane, " to 0x",
+                         tree[lane].ToHex());
 
-    FETCH_LOG_DEBUG(LOGGING_NAME, "reverting tree leaf: 0x", lane_merkle_hash.ToHex());
+          all_success = false;
+        }
 
-    // make the call to the RPC server
-    auto promise = rpc_client_->CallSpecificAddress(LookupAddress(lane_index++), RPC_STATE,
-                                                    RevertibleDocumentStoreProtocol::REVERT_TO_HASH,
-                                                    lane_merkle_hash);
+        return true;
+      });
 
-    // add the promise to the queue
-    promises.emplace_back(std::move(promise));
-  }
-
-  lane_index = 0;
-  bool all_success{true};
-  for (auto &p : promises)
-  {
-    bool item_success{false};
-    if (!(p->GetResult(item_success, 180) && item_success))
-    {
-      FETCH_LOG_WARN(LOGGING_NAME, "Failed to revert shard ", lane_index, " to 0x",
-                     tree[lane_index].ToHex());
-
-      all_success &= false;
-    }
-  }
+  all_success &= all_responded;
 
   if (all_success)
   {
@@ -240,35 +264,27 @@ byte_array::ConstByteArray StorageUnitClient::Commit(uint64_t const commit_index
 
   MerkleTree tree{num_lanes()};
 
-  std::vector<service::Promise> promises;
-  promises.reserve(num_lanes());
+  auto const promises = CallAllLanes(RevertibleDocumentStoreProtocol::COMMIT);
+  auto const deadline = Clock::now() + LANE_RESPONSE_TIMEOUT;
 
-  for (uint32_t lane_idx = 0; lane_idx < num_lanes(); ++lane_idx)
-  {
-    // make the request to the RPC server
-    auto promise = rpc_client_->CallSpecificAddress(LookupAddress(lane_idx), RPC_STATE,
-                                                    RevertibleDocumentStoreProtocol::COMMIT);
+  bool const success =
+      WaitForLanes(promises, commit_durations_, deadline,
+                   [&tree](LaneIndex lane, service::Promise const &promise) {
+                     byte_array::ByteArray digest{};
+                     if (!promise->GetResult(digest))
+                     {
+                       FETCH_LOG_WARN(LOGGING_NAME,
+                                      "Failed to generate (commit) merkle hash, no leaf: ", lane);
+                       return false;
+                     }
 
-    // add the promise to the waiting queue
-    promises.push_back(promise);
-  }
+                     tree[lane] = digest;
+                     return true;
+                   });
 
-  std::size_t index = 0;
-  for (auto &p : promises)
+  if (!success)
   {
-    byte_array::ByteArray digest{};
-
-    if (p->GetResult(digest))
-    {
-      tree[index] = digest;
-    }
-    else
-    {
-      FETCH_LOG_WARN(LOGGING_NAME, "Failed to generate (commit) merkle hash, no leaf: ", index);
-      return {};
-    }
-
-    ++index;
+    return {};
   }
 
   tree.CalculateRoot();
@@ -347,6 +363,125 @@ bool StorageUnitClient::HashInStack(Hash const &hash, uint64_t index)
   return tree.root() == hash;
 }
 
+/**
+ * Make the same state database request to all of the lanes concurrently
+ *
+ * @param function The state database protocol function to be called
+ * @param leaves The optional merkle tree, the leaf of which is passed as the argument to each lane
+ * @return The promises for each of the requests, indexed by lane
+ */
+StorageUnitClient::Promises StorageUnitClient::CallAllLanes(uint64_t          function,
+                                                            MerkleTree const *leaves)
+{
+  Promises promises{};
+  promises.reserve(num_lanes());
+
+  for (LaneIndex lane = 0; lane < num_lanes(); ++lane)
+  {
+    if (leaves != nullptr)
+    {
+      auto const &leaf = leaves->leaf_nodes().at(lane);
+      FETCH_LOG_DEBUG(LOGGING_NAME, "requesting with tree leaf: 0x", leaf.ToHex());
+
+      promises.emplace_back(
+          rpc_client_->CallSpecificAddress(LookupAddress(lane), RPC_STATE, function, leaf));
+    }
+    else
+    {
+      promises.emplace_back(
+          rpc_client_->CallSpecificAddress(LookupAddress(lane), RPC_STATE, function));
+    }
+  }
+
+  return promises;
+}
+
+/**
+ * Wait for the responses to a set of requests made to each of the lanes. The responses are handled
+ * in the order in which they arrive, rather than the order in which the requests were made, and
+ * all of the requests share a single deadline.
+ *
+ * @param promises The promises for each of the requests, indexed by lane
+ * @param durations The histograms of response times, indexed by lane
+ * @param deadline The time by which all of the lanes must have responded
+ * @param on_response The handler for each response, which returns false to stop waiting
+ * @return true if all of the lanes responded and were handled successfully, otherwise false
+ */
+bool StorageUnitClient::WaitForLanes(Promises const &promises, LaneHistograms const &durations,
+                                     Timepoint const &deadline,
+                                     ResponseHandler const &on_response) const
+{
+  auto queue = std::make_shared<LaneResponseQueue>();
+
+  for (LaneIndex lane = 0; lane < promises.size(); ++lane)
+  {
+    promises[lane]->WithHandlers().Finally([queue, lane]() {
+      {
+        std::lock_guard<std::mutex> guard(queue->lock);
+        queue->ready.emplace_back(lane, Clock::now());
+      }
+
+      queue->notify.notify_one();
+    });
+  }
+
+  for (std::size_t remaining = promises.size(); remaining > 0; --remaining)
+  {
+    LaneResponseQueue::Response response{};
+
+    {
+      std::unique_lock<std::mutex> lock(queue->lock);
+
+      if (!queue->notify.wait_until(lock, deadline, [&queue]() { return !queue->ready.empty(); }))
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Timed out waiting for ", remaining, " lane(s) to respond");
+        return false;
+      }
+
+      response = queue->ready.front();
+      queue->ready.pop_front();
+    }
+
+    auto const &promise = promises[response.first];
+
+    durations[response.first]->Add(
+        std::chrono::duration<double>(response.second - promise->created_at()).count());
+
+    if (!on_response(response.first, promise))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Create the response time histograms (one per lane) for a specified operation
+ *
+ * @param operation The operation
+ * @return The generated histograms, indexed by lane
+ */
+StorageUnitClient::LaneHistograms StorageUnitClient::CreateLaneHistograms(
+    char const *operation) const
+{
+  std::ostringstream name, description;
+  name << "ledger_storage_unit_client_" << operation << "_duration";
+  description << "The histogram of lane '" << operation << "' response times in seconds";
+
+  LaneHistograms histograms{};
+  histograms.reserve(num_lanes());
+
+  for (LaneIndex lane = 0; lane < num_lanes(); ++lane)
+  {
+    histograms.emplace_back(telemetry::Registry::Instance().CreateHistogram(
+        {0.0001, 0.001, 0.01, 0.1, 0.5, 1, 5, 10., 100.}, name.str(), description.str(),
+        {{"lane", std::to_string(lane)}}));
+  }
+
+  return histograms;
+}
+
 StorageUnitClient::Address const &StorageUnitClient::LookupAddress(ShardIndex shard) const
 {
   return addresses_.at(shard);
@@ -372,6 +507,14 @@ void StorageUnitClient::AddTransaction(chain::Transaction const &tx)
 
     // wait the for the response
     promise->Wait();
+
+    // notify any waiting parties
+    transaction_callback_.ApplyVoid([&tx](TransactionCallback const &transaction_callback) {
+      if (transaction_callback)
+      {
+        transaction_callback(tx.digest());
+      }
+    });
   }
   catch (std::exception const &ex)
   {
@@ -379,6 +522,28 @@ void StorageUnitClient::AddTransaction(chain::Transaction const &tx)
   }
 }
 
+void StorageUnitClient::SetTransactionCallback(TransactionCallback callback)
+{
+  transaction_callback_.ApplyVoid([&callback](TransactionCallback &transaction_callback) {
+    transaction_callback = std::move(callback);
+  });
+}
+
+/**
+ * Signal to all of the lanes that the specified block has been committed, so that they can evict
+ * their expired transactions. The lanes are not waited upon, since nothing depends on the result.
+ *
+ * @param block_index The index of the committed block
+ */
+void StorageUnitClient::RemoveExpiredTransactions(uint64_t block_index)
+{
+  for (auto const &lane_address : addresses_)
+  {
+    rpc_client_->CallSpecificAddress(lane_address, RPC_TX_STORE,
+                                     TransactionStorageProtocol::REMOVE_EXPIRED, block_index);
+  }
+}
+
 StorageUnitClient::TxLayouts StorageUnitClient::PollRecentTx(uint32_t max_to_poll)
 {
   std::vector<service::Promise> promises;
@@ -432,6 +597,63 @@ bool StorageUnitClient::GetTransaction(byte_array::ConstByteArray const &digest,
   return success;
 }
 
+/**
+ * Retrieve a batch of transactions, with a single request to each of the lanes which store them.
+ * The requests to the lanes are all made before any of the responses are waited for.
+ *
+ * @param digests The digests of the transactions to be retrieved
+ * @return The transactions which were found
+ */
+StorageUnitClient::Transactions StorageUnitClient::GetTransactions(Digests const &digests)
+{
+  struct LaneRequest
+  {
+    Digests digests{};
+    Promise promise{};
+  };
+
+  std::map<LaneIndex, LaneRequest> requests{};
+  for (auto const &digest : digests)
+  {
+    requests[ResourceID{digest}.lane(log2_num_lanes_)].digests.emplace_back(digest);
+  }
+
+  Transactions txs{};
+  txs.reserve(digests.size());
+
+  try
+  {
+    // make all of the requests to the RPC servers
+    for (auto &element : requests)
+    {
+      element.second.promise =
+          rpc_client_->CallSpecificAddress(LookupAddress(element.first), RPC_TX_STORE,
+                                           TransactionStorageProtocol::GET_BATCH,
+                                           element.second.digests);
+    }
+
+    for (auto &element : requests)
+    {
+      Transactions lane_txs{};
+      if (element.second.promise->GetResult(lane_txs))
+      {
+        std::move(lane_txs.begin(), lane_txs.end(), std::back_inserter(txs));
+      }
+      else
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Failed to retrieve ", element.second.digests.size(),
+                       " transactions from lane: ", element.first);
+      }
+    }
+  }
+  catch (std::exception const &e)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to retrieve transaction batch, because: ", e.what());
+  }
+
+  return txs;
+}
+
 bool StorageUnitClient::HasTransaction(ConstByteArray const &digest)
 {
   ResourceID resource{digest};
@@ -485,11 +707,57 @@ StorageUnitClient::Document StorageUnitClient::GetOrCreate(ResourceAddress const
 }
 
 StorageUnitClient::Document StorageUnitClient::Get(ResourceAddress const &key) const
+{
+  return GetDocument(key, RevertibleDocumentStoreProtocol::GET);
+}
+
+/**
+ * Retrieve a batch of documents from the state
+ *
+ * @param keys The keys to be retrieved
+ * @return The documents, in the same order as the keys
+ */
+StorageUnitClient::Documents StorageUnitClient::GetBatch(ResourceAddresses const &keys) const
+{
+  return GetDocuments(keys, RevertibleDocumentStoreProtocol::GET_BATCH);
+}
+
+/**
+ * Retrieve a document as of the last state committed by the lanes
+ *
+ * @param key The key to be retrieved
+ * @return The document
+ */
+StorageUnitClient::Document StorageUnitClient::GetCommitted(ResourceAddress const &key) const
+{
+  return GetDocument(key, RevertibleDocumentStoreProtocol::GET_COMMITTED);
+}
+
+/**
+ * Retrieve a batch of documents as of the last state committed by the lanes
+ *
+ * @param keys The keys to be retrieved
+ * @return The documents, in the same order as the keys
+ */
+StorageUnitClient::Documents StorageUnitClient::GetCommittedBatch(
+    ResourceAddresses const &keys) const
+{
+  return GetDocuments(keys, RevertibleDocumentStoreProtocol::GET_COMMITTED_BATCH);
+}
+
+/**
+ * Internal: Retrieve a document from the lane responsible for it
+ *
+ * @param key The key to be retrieved
+ * @param function The state database protocol function used to retrieve the document
+ * @return The document
+ */
+StorageUnitClient::Document StorageUnitClient::GetDocument(ResourceAddress const &key,
+                                                           uint64_t               function) const
 {
   // make the request to the RPC server
-  auto promise = rpc_client_->CallSpecificAddress(
-      LookupAddress(key), RPC_STATE, fetch::storage::RevertibleDocumentStoreProtocol::GET,
-      key.as_resource_id());
+  auto promise = rpc_client_->CallSpecificAddress(LookupAddress(key), RPC_STATE, function,
+                                                  key.as_resource_id());
 
   // wait for the document response
   Document doc;
@@ -504,6 +772,70 @@ StorageUnitClient::Document StorageUnitClient::Get(ResourceAddress const &key) c
   return doc;
 }
 
+/**
+ * Internal: Retrieve a batch of documents from the lanes
+ *
+ * The keys are grouped by lane so that a single request is made to each of the lanes involved. All
+ * of the requests are issued before waiting for any of the responses.
+ *
+ * @param keys The keys to be retrieved
+ * @param function The state database protocol (batch) function used to retrieve the documents
+ * @return The documents, in the same order as the keys
+ */
+StorageUnitClient::Documents StorageUnitClient::GetDocuments(ResourceAddresses const &keys,
+                                                             uint64_t function) const
+{
+  struct LaneRequest
+  {
+    std::vector<ResourceID>  resources{};
+    std::vector<std::size_t> indices{};  ///< The position of each resource in the batch
+    Promise                  promise{};
+  };
+
+  std::map<LaneIndex, LaneRequest> requests{};
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    auto &request = requests[keys[i].lane(log2_num_lanes_)];
+    request.resources.emplace_back(keys[i].as_resource_id());
+    request.indices.emplace_back(i);
+  }
+
+  // make all of the requests to the RPC servers
+  for (auto &element : requests)
+  {
+    element.second.promise = rpc_client_->CallSpecificAddress(
+        LookupAddress(element.first), RPC_STATE, function, element.second.resources);
+  }
+
+  // wait for the document responses
+  Documents documents(keys.size());
+  for (auto &element : requests)
+  {
+    auto &request = element.second;
+
+    Documents lane_documents{};
+    if (!request.promise->GetResult(lane_documents) ||
+        (lane_documents.size() != request.indices.size()))
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to get document batch from lane: ", element.first);
+
+      // signal the failure
+      lane_documents.assign(request.indices.size(), Document{});
+      for (auto &doc : lane_documents)
+      {
+        doc.failed = true;
+      }
+    }
+
+    for (std::size_t i = 0; i < request.indices.size(); ++i)
+    {
+      documents[request.indices[i]] = std::move(lane_documents[i]);
+    }
+  }
+
+  return documents;
+}
+
 void StorageUnitClient::Set(ResourceAddress const &key, StateValue const &value)
 {
   try
@@ -522,6 +854,83 @@ void StorageUnitClient::Set(ResourceAddress const &key, StateValue const &value)
   }
 }
 
+/**
+ * Write a batch of documents to the state
+ *
+ * @param keys The keys to be written
+ * @param values The values to be written, in the same order as the keys
+ */
+void StorageUnitClient::SetBatch(ResourceAddresses const &keys, StateValues const &values)
+{
+  SetDocuments(keys, values, RevertibleDocumentStoreProtocol::SET_BATCH, 0);
+}
+
+/**
+ * Import a large batch of documents into the (empty) state of the lanes, which then build their
+ * state in a single pass
+ *
+ * @param keys The keys to be written
+ * @param values The values to be written, in the same order as the keys
+ */
+void StorageUnitClient::Import(ResourceAddresses const &keys, StateValues const &values)
+{
+  SetDocuments(keys, values, RevertibleDocumentStoreProtocol::IMPORT, LANE_IMPORT_EXTENSION);
+}
+
+/**
+ * Internal: Write a batch of documents to the lanes
+ *
+ * The documents are grouped by lane so that a single request is made to each of the lanes
+ * involved. All of the requests are issued before waiting for any of the responses.
+ *
+ * @param keys The keys to be written
+ * @param values The values to be written, in the same order as the keys
+ * @param function The state database protocol (batch) function used to write the documents
+ * @param extension The additional time in seconds allowed for each of the lanes to respond
+ */
+void StorageUnitClient::SetDocuments(ResourceAddresses const &keys, StateValues const &values,
+                                     uint64_t function, uint64_t extension)
+{
+  struct LaneRequest
+  {
+    std::vector<ResourceID> resources{};
+    StateValues             values{};
+    Promise                 promise{};
+  };
+
+  std::map<LaneIndex, LaneRequest> requests{};
+  for (std::size_t i = 0, end = std::min(keys.size(), values.size()); i < end; ++i)
+  {
+    auto &request = requests[keys[i].lane(log2_num_lanes_)];
+    request.resources.emplace_back(keys[i].as_resource_id());
+    request.values.emplace_back(values[i]);
+  }
+
+  try
+  {
+    // make all of the requests to the RPC servers
+    for (auto &element : requests)
+    {
+      element.second.promise =
+          rpc_client_->CallSpecificAddress(LookupAddress(element.first), RPC_STATE, function,
+                                           element.second.resources, element.second.values);
+    }
+
+    for (auto &element : requests)
+    {
+      if (!element.second.promise->Wait(false, extension))
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Failed to write ", element.second.resources.size(),
+                       " documents to lane: ", element.first);
+      }
+    }
+  }
+  catch (std::exception const &e)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to write document batch, because: ", e.what());
+  }
+}
+
 bool StorageUnitClient::Lock(ShardIndex index)
 {
   bool success{false};
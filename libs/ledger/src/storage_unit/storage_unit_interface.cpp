@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "ledger/storage_unit/storage_unit_interface.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+StorageUnitInterface::Transactions StorageUnitInterface::GetTransactions(Digests const &digests)
+{
+  Transactions txs{};
+  txs.reserve(digests.size());
+
+  for (auto const &digest : digests)
+  {
+    chain::Transaction tx{};
+    if (GetTransaction(digest, tx))
+    {
+      txs.emplace_back(std::move(tx));
+    }
+  }
+
+  return txs;
+}
+
+}  // namespace ledger
+}  // namespace fetch
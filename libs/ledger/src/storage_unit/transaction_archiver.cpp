@@ -22,7 +22,9 @@
 #include "telemetry/counter.hpp"
 #include "telemetry/registry.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <utility>
 
 using namespace std::chrono;
 using namespace std::chrono_literals;
@@ -47,6 +49,7 @@ TransactionArchiver::TransactionArchiver(uint32_t lane, TransactionPoolInterface
   , additions_total_{CreateCounter("ledger_txarchiver_additions_total", "The total number of transactions archived by the archiver")}
   , lost_total_{CreateCounter("ledger_txarchiver_lost_total", "The total number of transactions lost by the archiver")}
   , processed_total_{CreateCounter("ledger_txarchiver_processed_total", "The total number of transactions processed by the archiver")}
+  , flushes_total_{CreateCounter("ledger_txarchiver_flushes_total", "The total number of batches written to the archive")}
 // clang-format on
 {
   // make the reservation
@@ -109,10 +112,15 @@ TransactionArchiver::State TransactionArchiver::OnFlushing()
     return State::COLLECTING;
   }
 
-  // flush a transaction to the archive
-  {
-    auto const &current = digests_.back();
+  // archive the batch in digest order, the same transaction may have been confirmed more than once
+  std::sort(digests_.begin(), digests_.end());
+  digests_.erase(std::unique(digests_.begin(), digests_.end()), digests_.end());
+
+  TxArray txs{};
+  txs.reserve(digests_.size());
 
+  for (auto const &current : digests_)
+  {
     chain::Transaction tx{};
     if (archive_.Has(current))
     {
@@ -121,13 +129,7 @@ TransactionArchiver::State TransactionArchiver::OnFlushing()
     }
     else if (pool_.Get(current, tx))
     {
-      // add the transaction to the store
-      archive_.Add(tx);
-
-      // remove the transaction from the pool
-      pool_.Remove(current);
-
-      additions_total_->increment();
+      txs.emplace_back(std::move(tx));
     }
     else
     {
@@ -137,12 +139,25 @@ TransactionArchiver::State TransactionArchiver::OnFlushing()
     }
   }
 
-  // remove the current element
-  digests_.pop_back();
+  if (!txs.empty())
+  {
+    // add all the transactions to the store in one go
+    archive_.AddBatch(txs);
+
+    // remove the transactions from the pool
+    for (auto const &tx : txs)
+    {
+      pool_.Remove(tx.digest());
+    }
+
+    additions_total_->add(txs.size());
+    flushes_total_->increment();
+  }
 
-  processed_total_->increment();
+  processed_total_->add(digests_.size());
+  digests_.clear();
 
-  return State::FLUSHING;
+  return State::COLLECTING;
 }
 
 telemetry::CounterPtr TransactionArchiver::CreateCounter(char const *name,
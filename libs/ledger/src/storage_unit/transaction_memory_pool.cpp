@@ -18,10 +18,49 @@
 
 #include "chain/transaction.hpp"
 #include "ledger/storage_unit/transaction_memory_pool.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using fetch::telemetry::Registry;
 
 namespace fetch {
 namespace ledger {
 
+constexpr std::size_t TransactionMemoryPool::NUM_SHARDS;
+constexpr std::size_t TransactionMemoryPool::UNLIMITED_SIZE_IN_BYTES;
+
+/**
+ * Construct a memory pool without any limit on its size
+ */
+TransactionMemoryPool::TransactionMemoryPool()
+  : TransactionMemoryPool(UNLIMITED_SIZE_IN_BYTES, nullptr)
+{}
+
+/**
+ * Construct a memory pool which spills transactions once it reaches a given size
+ *
+ * @param max_size_in_bytes The approximate maximum size of the transactions held in memory
+ * @param overflow The store to which transactions are spilled, if any
+ */
+TransactionMemoryPool::TransactionMemoryPool(std::size_t                max_size_in_bytes,
+                                             TransactionStoreInterface *overflow)
+  : max_size_in_bytes_{max_size_in_bytes}
+  , overflow_{overflow}
+  , spilled_total_{Registry::Instance().CreateCounter(
+        "ledger_tx_mem_pool_spilled_total",
+        "The total number of transactions spilled from the memory pool to disk")}
+  , expired_total_{Registry::Instance().CreateCounter(
+        "ledger_tx_mem_pool_expired_total",
+        "The total number of expired transactions evicted from the memory pool")}
+  , size_in_bytes_gauge_{Registry::Instance().CreateGauge<uint64_t>(
+        "ledger_tx_mem_pool_size_in_bytes",
+        "The approximate size of the transactions held in the memory pool")}
+{}
+
 /**
  * Add a transaction to the store
  *
@@ -29,8 +68,39 @@ namespace ledger {
  */
 void TransactionMemoryPool::Add(chain::Transaction const &tx)
 {
-  FETCH_LOCK(lock_);
-  transaction_store_[tx.digest()] = tx;
+  std::size_t const tx_size = EstimateSizeInBytes(tx);
+  auto &            shard   = Lookup(tx.digest());
+
+  {
+    FETCH_LOCK(shard.lock);
+
+    auto it = shard.transaction_store.find(tx.digest());
+    if (it != shard.transaction_store.end())
+    {
+      size_in_bytes_ -= EstimateSizeInBytes(it->second);
+      size_in_bytes_ += tx_size;
+      it->second = tx;
+      return;
+    }
+
+    // the limit is a soft one, concurrent additions may take the pool slightly above it
+    if ((overflow_ == nullptr) || ((size_in_bytes_ + tx_size) <= max_size_in_bytes_))
+    {
+      shard.transaction_store.emplace(tx.digest(), tx);
+
+      ++count_;
+      size_in_bytes_ += tx_size;
+      size_in_bytes_gauge_->set(size_in_bytes_);
+
+      FETCH_LOCK(expiry_lock_);
+      expiry_index_.Add(tx.digest(), tx.valid_until());
+      return;
+    }
+  }
+
+  // the pool is full, write the transaction to disk instead
+  overflow_->Add(tx);
+  spilled_total_->increment();
 }
 
 /**
@@ -41,8 +111,10 @@ void TransactionMemoryPool::Add(chain::Transaction const &tx)
  */
 bool TransactionMemoryPool::Has(Digest const &tx_digest) const
 {
-  FETCH_LOCK(lock_);
-  return transaction_store_.find(tx_digest) != transaction_store_.end();
+  auto const &shard = Lookup(tx_digest);
+
+  FETCH_LOCK(shard.lock);
+  return shard.transaction_store.find(tx_digest) != shard.transaction_store.end();
 }
 
 /**
@@ -56,10 +128,12 @@ bool TransactionMemoryPool::Get(Digest const &tx_digest, chain::Transaction &tx)
 {
   bool success{false};
 
-  FETCH_LOCK(lock_);
+  auto const &shard = Lookup(tx_digest);
+
+  FETCH_LOCK(shard.lock);
 
-  auto it = transaction_store_.find(tx_digest);
-  if (it != transaction_store_.end())
+  auto it = shard.transaction_store.find(tx_digest);
+  if (it != shard.transaction_store.end())
   {
     tx      = it->second;
     success = true;
@@ -75,8 +149,7 @@ bool TransactionMemoryPool::Get(Digest const &tx_digest, chain::Transaction &tx)
  */
 uint64_t TransactionMemoryPool::GetCount() const
 {
-  FETCH_LOCK(lock_);
-  return static_cast<uint64_t>(transaction_store_.size());
+  return count_;
 }
 
 /**
@@ -86,8 +159,162 @@ uint64_t TransactionMemoryPool::GetCount() const
  */
 void TransactionMemoryPool::Remove(Digest const &tx_digest)
 {
-  FETCH_LOCK(lock_);
-  transaction_store_.erase(tx_digest);
+  BlockIndex valid_until{0};
+
+  if (Erase(tx_digest, valid_until))
+  {
+    FETCH_LOCK(expiry_lock_);
+    expiry_index_.Remove(tx_digest, valid_until);
+  }
+}
+
+/**
+ * Evict the transactions which are no longer valid at the specified block index, i.e. those which
+ * can not be included in that block or any later one. This is proportional to the number of
+ * expired transactions rather than the size of the pool.
+ *
+ * @param block_index The block index being evaluated
+ * @return The number of transactions evicted
+ */
+std::size_t TransactionMemoryPool::RemoveExpired(BlockIndex block_index)
+{
+  chain::TransactionExpiryIndex::Digests expired{};
+
+  {
+    FETCH_LOCK(expiry_lock_);
+    expired = expiry_index_.RemoveExpired(block_index);
+  }
+
+  std::size_t count{0};
+  BlockIndex  valid_until{0};
+
+  for (auto const &tx_digest : expired)
+  {
+    if (Erase(tx_digest, valid_until))
+    {
+      ++count;
+    }
+  }
+
+  expired_total_->add(count);
+
+  return count;
+}
+
+/**
+ * Move transactions from memory to the overflow store until the approximate size of those held in
+ * memory is no more than the target. Each transaction is written to the overflow store before it is
+ * removed from memory, so it can always be found in one or the other.
+ *
+ * @param target_size_in_bytes The size to which the transactions held in memory are reduced
+ * @return The number of transactions spilled
+ */
+std::size_t TransactionMemoryPool::Spill(std::size_t target_size_in_bytes)
+{
+  std::size_t count{0};
+
+  if (overflow_ == nullptr)
+  {
+    return count;
+  }
+
+  for (auto &shard : shards_)
+  {
+    if (size_in_bytes_ <= target_size_in_bytes)
+    {
+      break;
+    }
+
+    // select the transactions to spill from this shard, without holding its lock while writing
+    std::vector<chain::Transaction> selected{};
+    {
+      FETCH_LOCK(shard.lock);
+
+      std::size_t const size   = size_in_bytes_;
+      std::size_t       excess = (size > target_size_in_bytes) ? (size - target_size_in_bytes) : 0;
+      for (auto it = shard.transaction_store.begin();
+           (excess > 0) && (it != shard.transaction_store.end()); ++it)
+      {
+        excess -= std::min(excess, EstimateSizeInBytes(it->second));
+        selected.emplace_back(it->second);
+      }
+    }
+
+    for (auto const &tx : selected)
+    {
+      overflow_->Add(tx);
+      Remove(tx.digest());
+
+      ++count;
+    }
+  }
+
+  spilled_total_->add(count);
+
+  return count;
+}
+
+/**
+ * Get the approximate size of the transactions held in memory
+ *
+ * @return The size in bytes
+ */
+std::size_t TransactionMemoryPool::GetSizeInBytes() const
+{
+  return size_in_bytes_;
+}
+
+/**
+ * Estimate the amount of memory used by a transaction
+ *
+ * @param tx The transaction to be evaluated
+ * @return The approximate size in bytes
+ */
+std::size_t TransactionMemoryPool::EstimateSizeInBytes(chain::Transaction const &tx)
+{
+  return sizeof(chain::Transaction) + tx.data().size() + tx.action().size() +
+         tx.chain_code().size() + (tx.transfers().size() * sizeof(chain::Transaction::Transfer)) +
+         (tx.signatories().size() * sizeof(chain::Transaction::Signatory));
+}
+
+/**
+ * Determine the shard for a given transaction
+ *
+ * @param tx_digest The digest of the transaction
+ * @return The shard responsible for the transaction
+ */
+TransactionMemoryPool::Shard &TransactionMemoryPool::Lookup(Digest const &tx_digest) const
+{
+  return shards_[DigestHashAdapter{}(tx_digest) % NUM_SHARDS];
+}
+
+/**
+ * Internal: Remove a transaction from its shard, without updating the expiry index
+ *
+ * @param tx_digest The transaction being removed
+ * @param valid_until The output valid until block of the removed transaction
+ * @return true if the transaction was present, otherwise false
+ */
+bool TransactionMemoryPool::Erase(Digest const &tx_digest, BlockIndex &valid_until)
+{
+  auto &shard = Lookup(tx_digest);
+
+  FETCH_LOCK(shard.lock);
+
+  auto it = shard.transaction_store.find(tx_digest);
+  if (it == shard.transaction_store.end())
+  {
+    return false;
+  }
+
+  valid_until = it->second.valid_until();
+  size_in_bytes_ -= EstimateSizeInBytes(it->second);
+  --count_;
+
+  shard.transaction_store.erase(it);
+  size_in_bytes_gauge_->set(size_in_bytes_);
+
+  return true;
 }
 
 }  // namespace ledger
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/verifier_cache.hpp"
+#include "ledger/storage_unit/transaction_scanner.hpp"
+#include "variant/json_writer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Construct a scanner over the lane stores of a node
+ *
+ * @param stores The transaction stores, by lane
+ * @param num_threads The number of threads which scan concurrently, including the calling thread
+ */
+TransactionScanner::TransactionScanner(Stores const &stores, std::size_t num_threads)
+  : stores_{stores}
+  , num_threads_{std::max<std::size_t>(num_threads, 1)}
+{}
+
+/**
+ * Enable the verification of the signatures of every scanned transaction
+ *
+ * @param enable Whether the signatures are verified
+ */
+void TransactionScanner::EnableSignatureVerification(bool enable)
+{
+  verify_signatures_ = enable;
+}
+
+/**
+ * Set the function which builds the exported record of every scanned transaction. The records
+ * are serialised to JSON on the scan threads.
+ *
+ * @param exporter The record builder, called with the index of the request and its result
+ */
+void TransactionScanner::SetExporter(Exporter exporter)
+{
+  exporter_ = std::move(exporter);
+}
+
+/**
+ * Fetch, decode, verify and export a range of transactions concurrently. The results are in the
+ * order of the requests, whatever the number of threads.
+ *
+ * @param requests The transactions to be scanned
+ * @param begin The index of the first request to be scanned
+ * @param results The results, sized to the number of requests to be scanned
+ */
+void TransactionScanner::Scan(Requests const &requests, std::size_t begin, Results &results) const
+{
+  std::atomic<std::size_t> next{0};
+
+  auto const worker = [&]() {
+    crypto::VerifierCache verifiers{};
+    variant::JsonWriter   writer{};
+
+    for (std::size_t i = next++; i < results.size(); i = next++)
+    {
+      auto const &request = requests[begin + i];
+      auto &      result  = results[i];
+
+      result = Result{};
+      try
+      {
+        auto const store = stores_.find(request.lane);
+        result.found     = (store != stores_.end()) && store->second.Get(request.digest, result.tx);
+      }
+      catch (...)
+      {
+        result.found = false;
+      }
+
+      if (result.found && verify_signatures_)
+      {
+        result.verified = result.tx.Verify(verifiers);
+      }
+
+      if (exporter_)
+      {
+        writer.Write(exporter_(begin + i, result));
+        result.record = writer.Take();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads_);
+  for (std::size_t i = 1; i < num_threads_; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+
+  worker();
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -22,8 +22,9 @@
 namespace fetch {
 namespace ledger {
 
-using TxArray   = TransactionStorageEngineInterface::TxArray;
-using TxLayouts = TransactionStorageEngineInterface::TxLayouts;
+using TxArray     = TransactionStorageEngineInterface::TxArray;
+using TxLayouts   = TransactionStorageEngineInterface::TxLayouts;
+using DigestArray = TransactionStorageEngineInterface::DigestArray;
 
 /**
  * Create a transaction storage engine with the define number of lanes
@@ -84,6 +85,16 @@ void TransactionStorageEngine::SetNewTransactionHandler(Callback cb)
   new_tx_callback_ = std::move(cb);
 }
 
+/**
+ * Set the accounts with sharded balances, used to lay out the recent transactions
+ *
+ * @param sharded_balances The accounts with sharded balances
+ */
+void TransactionStorageEngine::SetShardedBalances(ShardedBalancesPtr sharded_balances)
+{
+  recent_tx_.SetShardedBalances(std::move(sharded_balances));
+}
+
 /**
  * Add a new transaction to the storage engine
  *
@@ -162,6 +173,48 @@ TxLayouts TransactionStorageEngine::GetRecent(uint32_t max_to_poll)
   return recent_tx_.Flush(max_to_poll);
 }
 
+/**
+ * Evict the pending transactions which have expired, now that the specified block has been
+ * committed.
+ *
+ * Expired transactions can no longer be packed, so they are dropped from the recent transactions
+ * straight away. Unconfirmed transactions are kept in the memory pool for a further number of
+ * blocks, since the blocks of a competing fork may still refer to them.
+ *
+ * @param block_index The index of the committed block
+ */
+void TransactionStorageEngine::RemoveExpired(uint64_t block_index)
+{
+  recent_tx_.RemoveExpired(block_index + 1);
+
+  if (block_index > EXPIRED_TX_RETENTION)
+  {
+    mem_pool_.RemoveExpired(block_index - EXPIRED_TX_RETENTION);
+  }
+}
+
+/**
+ * Get the approximate size of the transactions held in the memory pool
+ *
+ * @return The size in bytes
+ */
+std::size_t TransactionStorageEngine::GetMemPoolSizeInBytes() const
+{
+  return mem_pool_.GetSizeInBytes();
+}
+
+/**
+ * Move transactions from the memory pool to the archive until the memory pool is no larger than the
+ * target size
+ *
+ * @param target_size_in_bytes The size to which the memory pool is reduced
+ * @return The number of transactions moved to the archive
+ */
+std::size_t TransactionStorageEngine::SpillMemPool(std::size_t target_size_in_bytes)
+{
+  return mem_pool_.Spill(target_size_in_bytes);
+}
+
 /**
  * Pull a sub tree from the storage engine with the given starting prefix for the digest
  *
@@ -176,5 +229,19 @@ TxArray TransactionStorageEngine::PullSubtree(Digest const &partial_digest, uint
   return archive_.PullSubtree(partial_digest, bit_count, pull_limit);
 }
 
+/**
+ * Get the digests of the transactions in a sub tree of the storage engine
+ *
+ * @param partial_digest The partial digest for the subtree
+ * @param bit_count The bit count of the partial digest for the subtree
+ * @param pull_limit The maximum number of digests to be retrieved
+ * @return The digests of the transactions in the subtree
+ */
+DigestArray TransactionStorageEngine::PullSubtreeDigests(Digest const &partial_digest,
+                                                         uint64_t bit_count, uint64_t pull_limit)
+{
+  return archive_.PullSubtreeDigests(partial_digest, bit_count, pull_limit);
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -28,6 +28,7 @@
 #include "telemetry/utils/timer.hpp"
 
 #include <sstream>
+#include <utility>
 
 namespace fetch {
 namespace ledger {
@@ -53,17 +54,23 @@ TransactionStorageProtocol::TransactionStorageProtocol(TransactionStorageEngineI
   , get_total_{CreateCounter("get")}
   , get_count_total_{CreateCounter("get_count")}
   , get_recent_total_{CreateCounter("get_recent")}
+  , get_batch_total_{CreateCounter("get_batch")}
+  , remove_expired_total_{CreateCounter("remove_expired")}
   , add_durations_{CreateHistogram("add")}
   , has_durations_{CreateHistogram("has")}
   , get_durations_{CreateHistogram("get")}
   , get_count_durations_{CreateHistogram("get_count")}
   , get_recent_durations_{CreateHistogram("get_recent")}
+  , get_batch_durations_{CreateHistogram("get_batch")}
+  , remove_expired_durations_{CreateHistogram("remove_expired")}
 {
   Expose(ADD, this, &TransactionStorageProtocol::Add);
   Expose(HAS, this, &TransactionStorageProtocol::Has);
   Expose(GET, this, &TransactionStorageProtocol::Get);
   Expose(GET_COUNT, this, &TransactionStorageProtocol::GetCount);
   Expose(GET_RECENT, this, &TransactionStorageProtocol::GetRecent);
+  Expose(GET_BATCH, this, &TransactionStorageProtocol::GetBatch);
+  Expose(REMOVE_EXPIRED, this, &TransactionStorageProtocol::RemoveExpired);
 }
 
 /**
@@ -156,6 +163,35 @@ chain::Transaction TransactionStorageProtocol::Get(Digest const &tx_digest)
   return tx;
 }
 
+/**
+ * Retrieve a batch of transactions from the storage engine
+ *
+ * @param tx_digests The digests of the transactions being queried
+ * @return The transactions which were found, transactions which are not present are omitted
+ */
+TransactionStorageProtocol::Transactions TransactionStorageProtocol::GetBatch(
+    Digests const &tx_digests)
+{
+  get_batch_total_->increment();
+
+  FunctionTimer timer{*get_batch_durations_};
+  Transactions  txs{};
+  txs.reserve(tx_digests.size());
+
+  for (auto const &tx_digest : tx_digests)
+  {
+    chain::Transaction tx{};
+    if (storage_.Get(tx_digest, tx))
+    {
+      // as with single lookups, retrieved transactions must be persisted to disk
+      storage_.Confirm(tx_digest);
+      txs.emplace_back(std::move(tx));
+    }
+  }
+
+  return txs;
+}
+
 /**
  * Get the total number of stored transactions in this storage engine
  *
@@ -183,5 +219,19 @@ TransactionStorageProtocol::TxLayouts TransactionStorageProtocol::GetRecent(uint
   return storage_.GetRecent(max_to_poll);
 }
 
+/**
+ * Evict the pending transactions which have expired, now that the specified block has been
+ * committed
+ *
+ * @param block_index The index of the committed block
+ */
+void TransactionStorageProtocol::RemoveExpired(uint64_t block_index)
+{
+  remove_expired_total_->increment();
+
+  FunctionTimer timer{*remove_expired_durations_};
+  storage_.RemoveExpired(block_index);
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -18,8 +18,13 @@
 
 #include "chain/transaction_rpc_serializers.hpp"
 #include "ledger/storage_unit/transaction_store.hpp"
+#include "core/serializers/main_serializer.hpp"
 #include "logging/logging.hpp"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 namespace fetch {
 namespace ledger {
 namespace {
@@ -28,7 +33,8 @@ constexpr char const *LOGGING_NAME = "TransactionStore";
 
 using fetch::storage::ResourceID;
 
-using TxArray = TransactionStore::TxArray;
+using TxArray     = TransactionStore::TxArray;
+using DigestArray = TransactionStore::DigestArray;
 
 ResourceID CreateResourceId(Digest const &digest)
 {
@@ -40,11 +46,13 @@ ResourceID CreateResourceId(Digest const &digest)
 void TransactionStore::New(std::string const &doc_file, std::string const &index_file, bool create)
 {
   archive_.New(doc_file, index_file, create);
+  mapped_archive_.Open(doc_file);
 }
 
 void TransactionStore::Load(std::string const &doc_file, std::string const &index_file, bool create)
 {
   archive_.Load(doc_file, index_file, create);
+  mapped_archive_.Open(doc_file);
 }
 
 /**
@@ -70,6 +78,53 @@ void TransactionStore::Add(chain::Transaction const &tx)
   }
 }
 
+/**
+ * Add a batch of transactions to the store. The transactions are written in digest order as a
+ * single update of the underlying archive, flushing the document file and index only once.
+ *
+ * @param txs The transactions to be added to storage
+ */
+void TransactionStore::AddBatch(TxArray const &txs)
+{
+  using Entry   = std::pair<ResourceID, chain::Transaction const *>;
+  using Entries = std::vector<Entry>;
+  using Writes  = std::vector<std::pair<ResourceID, chain::Transaction const &>>;
+
+  Entries entries{};
+  entries.reserve(txs.size());
+
+  for (auto const &tx : txs)
+  {
+    entries.emplace_back(CreateResourceId(tx.digest()), &tx);
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](Entry const &a, Entry const &b) { return a.first < b.first; });
+
+  try
+  {
+    Writes writes{};
+    writes.reserve(entries.size());
+
+    for (auto const &entry : entries)
+    {
+      bool const is_duplicate = !writes.empty() && (writes.back().first == entry.first);
+
+      if (!is_duplicate && !archive_.Has(entry.first))
+      {
+        writes.emplace_back(entry.first, *entry.second);
+      }
+    }
+
+    archive_.SetBatch(writes);
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to add batch of ", txs.size(),
+                   " txs to store: ", ex.what());
+  }
+}
+
 /**
  * Check to see if requested transaction exists
  *
@@ -86,20 +141,69 @@ bool TransactionStore::Has(Digest const &tx_digest) const
  * Lookup a transaction from the store
  *
  * @param tx_digest The transaction digest to lookup
- * @param tx
- * @return
+ * @param tx The reference to the transaction to be populated
+ * @return true if successful, otherwise false
  */
 bool TransactionStore::Get(Digest const &tx_digest, chain::Transaction &tx) const
 {
-  auto const rid = CreateResourceId(tx_digest);
+  try
+  {
+    // prefer decoding directly from the mapped archive, avoiding the intermediate document copy
+    auto const encoded = GetMapped(tx_digest);
+    if (!encoded.empty())
+    {
+      serializers::MsgPackSerializer serializer{encoded};
+      serializer >> tx;
 
+      return true;
+    }
+
+    return archive_.Get(CreateResourceId(tx_digest), tx);
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to get tx: 0x", tx_digest.ToHex(),
+                   " from store: ", ex.what());
+  }
+
+  return false;
+}
+
+/**
+ * Lookup a transaction from the store without decoding it. When possible the view references the
+ * mapped pages of the archive directly.
+ *
+ * @param tx_digest The transaction digest to lookup
+ * @param view The reference to the view to be populated
+ * @return true if successful, otherwise false
+ */
+bool TransactionStore::GetView(Digest const &tx_digest, TransactionView &view) const
+{
   try
   {
-    return archive_.Get(rid, tx);
+    auto encoded = GetMapped(tx_digest);
+
+    // fall back to copying the document out of the archive
+    if (encoded.empty())
+    {
+      chain::Transaction tx{};
+      if (!archive_.Get(CreateResourceId(tx_digest), tx))
+      {
+        return false;
+      }
+
+      serializers::MsgPackSerializer serializer{};
+      serializer << tx;
+      encoded = serializer.data();
+    }
+
+    view = TransactionView{std::move(encoded)};
+
+    return true;
   }
   catch (std::exception const &ex)
   {
-    FETCH_LOG_WARN(LOGGING_NAME, "Failed to get tx: 0x", tx.digest().ToHex(),
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to get tx view: 0x", tx_digest.ToHex(),
                    " from store: ", ex.what());
   }
 
@@ -129,16 +233,56 @@ TxArray TransactionStore::PullSubtree(Digest const &partial_digest, uint64_t bit
 {
   TxArray ret{};
 
-  uint64_t counter = 0;
+  archive_.Flush(false);
+  archive_.WithLock([this, &pull_limit, &ret, &partial_digest, bit_count]() {
+    // This is effectively saying get all objects whose ID begins rid & mask. The transactions are
+    // decoded in parallel
+    ret = archive_.LocklessGetSubtree(ResourceID(partial_digest), bit_count, pull_limit);
+  });
+
+  return ret;
+}
+
+/**
+ * Internal: Lookup the encoded transaction in the mapped archive
+ *
+ * @param tx_digest The transaction digest to lookup
+ * @return The encoded transaction if available, otherwise an empty array
+ */
+TransactionStore::ConstByteArray TransactionStore::GetMapped(Digest const &tx_digest) const
+{
+  uint64_t offset{0};
+  uint64_t length{0};
+
+  if (!archive_.Locate(CreateResourceId(tx_digest), offset, length))
+  {
+    return {};
+  }
+
+  return mapped_archive_.Slice(offset, length);
+}
+
+/**
+ * Get the digests of a sub tree of the storage engine with the given starting prefix. Unlike
+ * PullSubtree the transactions themselves are neither read nor decoded.
+ *
+ * @param partial_digest The partial digest for the subtree
+ * @param bit_count The bit count of the partial digest for the subtree
+ * @param pull_limit The maximum number of digests to be retrieved
+ * @return The digests of the transactions in the subtree
+ */
+DigestArray TransactionStore::PullSubtreeDigests(Digest const &partial_digest, uint64_t bit_count,
+                                                 uint64_t pull_limit)
+{
+  DigestArray ret{};
 
   archive_.Flush(false);
-  archive_.WithLock([this, &pull_limit, &ret, &counter, &partial_digest, bit_count]() {
-    // This is effectively saying get all objects whose ID begins rid & mask
+  archive_.WithLock([this, &pull_limit, &ret, &partial_digest, bit_count]() {
     auto it = archive_.GetSubtree(ResourceID(partial_digest), bit_count);
 
-    while ((it != archive_.end()) && (counter++ < pull_limit))
+    while ((it != archive_.end()) && (ret.size() < pull_limit))
     {
-      ret.push_back(*it);
+      ret.emplace_back(it.GetKey().id());
       ++it;
     }
   });
@@ -58,15 +58,18 @@ TransactionStoreSyncProtocol::TransactionStoreSyncProtocol(TransactionStorageEng
   , pull_objects_total_{CreateCounter("pull_objects")}
   , pull_subtree_total_{CreateCounter("pull_subtree")}
   , pull_specific_objects_total_{CreateCounter("pull_specific")}
+  , pull_subtree_digests_total_{CreateCounter("pull_subtree_digests")}
   , object_count_durations_{CreateHistogram("object_count")}
   , pull_objects_durations_{CreateHistogram("pull_objects")}
   , pull_subtree_durations_{CreateHistogram("pull_subtree")}
   , pull_specific_objects_durations_{CreateHistogram("pull_specific")}
+  , pull_subtree_digests_durations_{CreateHistogram("pull_subtree_digests")}
 {
   Expose(OBJECT_COUNT, this, &TransactionStoreSyncProtocol::ObjectCount);
   ExposeWithClientContext(PULL_OBJECTS, this, &TransactionStoreSyncProtocol::PullObjects);
   Expose(PULL_SUBTREE, this, &TransactionStoreSyncProtocol::PullSubtree);
   Expose(PULL_SPECIFIC_OBJECTS, this, &TransactionStoreSyncProtocol::PullSpecificObjects);
+  Expose(PULL_SUBTREE_DIGESTS, this, &TransactionStoreSyncProtocol::PullSubtreeDigests);
 }
 
 /**
@@ -187,6 +190,25 @@ TSSP::TxArray TransactionStoreSyncProtocol::PullSubtree(byte_array::ConstByteArr
   return store_.PullSubtree(rid, bit_count, PULL_LIMIT);
 }
 
+/**
+ * Allow peers to query the contents of a section of your subtree, so that only the transactions
+ * which they are missing need to be pulled (with PullSpecificObjects)
+ *
+ * @param rid The prefix of the subtree
+ * @param bit_count The number of significant bits of the prefix
+ * @return The digests of the transactions in the subtree (size limited)
+ */
+TSSP::DigestArray TransactionStoreSyncProtocol::PullSubtreeDigests(
+    byte_array::ConstByteArray const &rid, uint64_t bit_count)
+{
+  pull_subtree_digests_total_->increment();
+
+  telemetry::FunctionTimer telemetry_timer{*pull_subtree_digests_durations_};
+  generics::MilliTimer     timer("ObjectSync:PullSubtreeDigests", 500);
+
+  return store_.PullSubtreeDigests(rid, bit_count, PULL_LIMIT);
+}
+
 /**
  * Pull a specific set of transaction digest from the shard
  *
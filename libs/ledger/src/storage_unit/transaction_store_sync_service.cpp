@@ -24,6 +24,7 @@
 #include "telemetry/gauge.hpp"
 #include "telemetry/registry.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <memory>
@@ -101,6 +102,18 @@ TransactionStoreSyncService::TransactionStoreSyncService(Config const &cfg, Mudd
   , subtree_failure_total_{telemetry::Registry::Instance().CreateCounter(
         "ledger_tx_store_sync_service_subtree_failure_total",
         "The total number of subtree request failures observed")}
+  , subtree_digests_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_tx_store_sync_service_subtree_digests_total",
+        "The total number of transaction digests received from subtree queries")}
+  , subtree_missing_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_tx_store_sync_service_subtree_missing_total",
+        "The total number of missing transactions requested during subtree syncing")}
+  , rate_limited_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_tx_store_sync_service_rate_limited_total",
+        "The total number of missing transactions deferred by the per peer rate limit")}
+  , backpressure_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_tx_store_sync_service_backpressure_total",
+        "The total number of times subtree syncing was paused by the verification backlog")}
   , current_tss_state_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
         "current_tss_state", "The state in the state machine of the tx store")}
   , current_tss_peers_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
@@ -240,6 +253,15 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnQuerySubtree()
   assert(!roots_to_sync_.empty());
   auto const orig_num_of_roots{roots_to_sync_.size()};
 
+  // pulling further transactions from peers would only block on the full verifier queue
+  if (IsVerifierCongested())
+  {
+    backpressure_total_->increment();
+    state_machine_->Delay(std::chrono::milliseconds{500});
+
+    return State::QUERY_SUBTREE;
+  }
+
   auto const directly_connected_peers = muddle_.GetDirectlyConnectedPeers();
 
   std::size_t const maximum_inflight = MAX_REQUESTS_PER_NODE * directly_connected_peers.size();
@@ -262,6 +284,13 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnQuerySubtree()
       break;
     }
 
+    // peers which have used up their rate limit are not asked for further subtrees for now
+    auto const limit = peer_tx_limits_.find(connection);
+    if ((limit != peer_tx_limits_.end()) && (limit->second.available() < 1.0))
+    {
+      continue;
+    }
+
     // extract the next root to sync
     auto root = roots_to_sync_.front();
     roots_to_sync_.pop();
@@ -270,11 +299,14 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnQuerySubtree()
     transactions_prefix.Resize(std::size_t{ResourceID::RESOURCE_ID_SIZE_IN_BYTES});
     *reinterpret_cast<decltype(root) *>(transactions_prefix.char_pointer()) = root;
 
-    auto promise = PromiseOfTxList(client_->CallSpecificAddress(
-        connection, RPC_TX_STORE_SYNC, TransactionStoreSyncProtocol::PULL_SUBTREE,
+    // only the digests of the subtree are requested, the peer is then asked for the transactions
+    // which are missing locally
+    auto promise = PromiseOfDigestList(client_->CallSpecificAddress(
+        connection, RPC_TX_STORE_SYNC, TransactionStoreSyncProtocol::PULL_SUBTREE_DIGESTS,
         transactions_prefix, root_size_));
 
     promise_id_to_roots_[promise.id()] = root;
+    root_peers_[root]                  = connection;
     pending_subtree_.Add(root, promise);
 
     subtree_requests_total_->increment();
@@ -294,15 +326,34 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnQuerySubtree()
 TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingSubtree()
 {
   current_tss_state_->set(static_cast<uint64_t>(state_machine_->state()));
-  auto counts = pending_subtree_.Resolve();
+  auto counts         = pending_subtree_.Resolve();
+  auto missing_counts = pending_missing_.Resolve();
 
-  // resolve the sub-trees promises
-  std::size_t synced_tx{0};
+  // reconcile the digests of each of the sub-trees with the contents of the local store
   for (auto &result : pending_subtree_.Get(MAX_SUBTREE_RESOLUTION_PER_CYCLE))
   {
+    DigestSet missing{};
+    for (auto const &digest : result.promised)
+    {
+      if (!store_.Has(digest))
+      {
+        missing.emplace(digest);
+      }
+    }
+
     FETCH_LOG_INFO(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ", "Got ", result.promised.size(),
-                   " subtree objects!");
+                   " subtree digests, ", missing.size(), " missing");
+
+    RequestMissingObjects(result.key, missing);
 
+    subtree_digests_total_->add(result.promised.size());
+    subtree_response_total_->increment();
+  }
+
+  // resolve the missing transactions
+  std::size_t synced_tx{0};
+  for (auto &result : pending_missing_.Get(MAX_SUBTREE_RESOLUTION_PER_CYCLE))
+  {
     for (auto &tx : result.promised)
     {
       // add the transaction to the verifier
@@ -311,7 +362,7 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingSubtr
       ++synced_tx;
     }
 
-    subtree_response_total_->increment();
+    missing_request_roots_.erase(result.key);
   }
 
   // report the number of incorporated transactions
@@ -333,19 +384,40 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingSubtr
     subtree_failure_total_->add(static_cast<uint64_t>(counts.failed));
   }
 
+  // the root of any failed request for missing transactions is reconciled again
+  if (missing_counts.failed > 0)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ", "Failed missing tx promises count ",
+                   missing_counts.failed);
+
+    for (auto &fail : pending_missing_.GetFailures(MAX_SUBTREE_RESOLUTION_PER_CYCLE))
+    {
+      roots_to_sync_.push(missing_request_roots_[fail.key]);
+      missing_request_roots_.erase(fail.key);
+    }
+
+    subtree_failure_total_->add(static_cast<uint64_t>(missing_counts.failed));
+  }
+
   // evaluate if the syncing process if complete, this can only be the case when there are no in
   // flight requests and we have successfully evaluated all the roots we are after
-  bool const is_subtree_sync_complete = roots_to_sync_.empty() && counts.pending == 0;
+  bool const is_subtree_sync_complete = roots_to_sync_.empty() &&
+                                        (pending_subtree_.GetNumPending() == 0) &&
+                                        (pending_missing_.GetNumPending() == 0);
   if (!is_subtree_sync_complete)
   {
     state_machine_->Delay(10ms);
-    return State::QUERY_SUBTREE;
+
+    // keep waiting on the in flight requests while there are no further roots to query
+    return roots_to_sync_.empty() ? State::RESOLVING_SUBTREE : State::QUERY_SUBTREE;
   }
 
   FETCH_LOG_INFO(LOGGING_NAME, "Completed sub-tree syncing");
 
   // cleanup
   promise_id_to_roots_.clear();
+  root_peers_.clear();
+  missing_request_roots_.clear();
 
   // if we get this far then we have completed the subtree sync process
   return State::QUERY_OBJECTS;
@@ -479,6 +551,79 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnTrimCache()
   return State::QUERY_OBJECTS;
 }
 
+/**
+ * Request the transactions which are missing locally from the peer which reported the subtree
+ *
+ * @param root The root of the subtree
+ * @param digests The digests of the missing transactions
+ */
+void TransactionStoreSyncService::RequestMissingObjects(uint64_t root, DigestSet const &digests)
+{
+  auto const &peer = root_peers_[root];
+
+  // limit the rate at which transactions are pulled from each peer, the remainder of the subtree
+  // is reconciled again later
+  auto limit = peer_tx_limits_.find(peer);
+  if (limit == peer_tx_limits_.end())
+  {
+    limit = peer_tx_limits_
+                .emplace(peer, core::TokenBucket{cfg_.max_peer_tx_rate, cfg_.max_peer_tx_rate})
+                .first;
+  }
+
+  std::size_t allowed = limit->second.Take(digests.size());
+  if (allowed < digests.size())
+  {
+    rate_limited_total_->add(digests.size() - allowed);
+    roots_to_sync_.push(root);
+  }
+
+  DigestSet chunk{};
+  chunk.reserve(std::min(digests.size(), std::size_t{TX_FINDER_PROTO_LIMIT}));
+
+  auto const request = [this, root, &peer, &chunk]() {
+    auto promise = PromiseOfTxList(client_->CallSpecificAddress(
+        peer, RPC_TX_STORE_SYNC, TransactionStoreSyncProtocol::PULL_SPECIFIC_OBJECTS, chunk));
+
+    uint64_t const id          = next_missing_request_++;
+    missing_request_roots_[id] = root;
+    pending_missing_.Add(id, promise);
+
+    subtree_missing_total_->add(chunk.size());
+    chunk.clear();
+  };
+
+  for (auto const &digest : digests)
+  {
+    if (allowed-- == 0)
+    {
+      break;
+    }
+
+    chunk.emplace(digest);
+
+    if (chunk.size() >= TX_FINDER_PROTO_LIMIT)
+    {
+      request();
+    }
+  }
+
+  if (!chunk.empty())
+  {
+    request();
+  }
+}
+
+/**
+ * Determine if the verification of the transactions already received is falling behind
+ *
+ * @return true if at least half of the verifier queue is in use, otherwise false
+ */
+bool TransactionStoreSyncService::IsVerifierCongested() const
+{
+  return verifier_.GetBacklog() >= (TransactionVerifier::QUEUE_SIZE / 2);
+}
+
 void TransactionStoreSyncService::OnTransaction(TransactionPtr const &tx)
 {
   ResourceID const rid(tx->digest());
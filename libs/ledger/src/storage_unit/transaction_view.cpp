@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_rpc_serializers.hpp"
+#include "chain/transaction_serializer.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/storage_unit/transaction_view.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Construct a view from an encoded transaction
+ *
+ * @param encoded The encoded transaction
+ */
+TransactionView::TransactionView(ConstByteArray encoded)
+  : encoded_{std::move(encoded)}
+{}
+
+/**
+ * Determine if the view is referencing a transaction
+ *
+ * @return true if the view is empty, otherwise false
+ */
+bool TransactionView::empty() const
+{
+  return encoded_.empty();
+}
+
+/**
+ * Get the encoded form of the transaction
+ *
+ * @return The encoded transaction
+ */
+TransactionView::ConstByteArray const &TransactionView::encoded() const
+{
+  return encoded_;
+}
+
+/**
+ * Get the transaction, decoding it if this has not already been done
+ *
+ * @return The decoded transaction
+ */
+chain::Transaction const &TransactionView::transaction() const
+{
+  if (!transaction_)
+  {
+    if (encoded_.empty())
+    {
+      throw std::runtime_error("Unable to decode transaction from an empty view");
+    }
+
+    auto transaction = std::make_shared<chain::Transaction>();
+
+    auto serializer = serializers::MsgPackSerializer::Borrow(encoded_);
+    serializer >> *transaction;
+
+    transaction_ = std::move(transaction);
+  }
+
+  return *transaction_;
+}
+
+/**
+ * Get the layout of the transaction. Unless the transaction has already been decoded, only the
+ * header fields are decoded to build it.
+ *
+ * @param log2_num_lanes The log2 of the number of lanes the layout is built for
+ * @return The layout of the transaction
+ */
+chain::TransactionLayout TransactionView::layout(uint32_t log2_num_lanes) const
+{
+  if (transaction_)
+  {
+    return chain::TransactionLayout{*transaction_, log2_num_lanes};
+  }
+
+  if (encoded_.empty())
+  {
+    throw std::runtime_error("Unable to decode transaction from an empty view");
+  }
+
+  // extract the transaction encoding from its (msgpack) envelope
+  ConstByteArray data;
+  auto           serializer = serializers::MsgPackSerializer::Borrow(encoded_);
+  serializer >> data;
+
+  chain::TransactionLayout layout{};
+  if (!chain::TransactionSerializer{data}.DeserializeLayout(layout, log2_num_lanes))
+  {
+    throw std::runtime_error("Unable to decode transaction layout");
+  }
+
+  return layout;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/set_thread_name.hpp"
+#include "ledger/execution_manager.hpp"
+#include "ledger/miner/basic_miner.hpp"
+#include "ledger/transaction_pre_executor.hpp"
+#include "logging/logging.hpp"
+
+#include <thread>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "TxPreExecutor";
+
+}  // namespace
+
+constexpr std::size_t TransactionPreExecutor::DEFAULT_BATCH_SIZE;
+constexpr uint64_t    TransactionPreExecutor::DEFAULT_INTERVAL_MS;
+
+/**
+ * Construct the pre-executor
+ *
+ * @param miner The miner whose pool is to be pre-executed
+ * @param execution_manager The execution manager, which must have pre-execution enabled
+ * @param batch_size The maximum number of transactions pre-executed in each round
+ * @param interval The time between each round
+ */
+TransactionPreExecutor::TransactionPreExecutor(BasicMiner &      miner,
+                                               ExecutionManager &execution_manager,
+                                               std::size_t batch_size, Duration interval)
+  : miner_{miner}
+  , execution_manager_{execution_manager}
+  , batch_size_{batch_size}
+  , interval_{interval}
+{}
+
+TransactionPreExecutor::~TransactionPreExecutor()
+{
+  Stop();
+}
+
+/**
+ * Start the background pre-execution
+ */
+void TransactionPreExecutor::Start()
+{
+  running_ = true;
+  thread_  = std::make_unique<std::thread>(&TransactionPreExecutor::ThreadEntryPoint, this);
+}
+
+/**
+ * Stop the background pre-execution
+ */
+void TransactionPreExecutor::Stop()
+{
+  running_ = false;
+  if (thread_)
+  {
+    thread_->join();
+    thread_.reset();
+  }
+}
+
+/**
+ * Pre-execute the next batch of unobserved transactions from the mining pool, stopping early if
+ * the execution manager becomes busy
+ *
+ * @return The number of transactions which were pre-executed
+ */
+std::size_t TransactionPreExecutor::PreExecuteBatch()
+{
+  std::size_t count{0};
+
+  for (auto const &layout : miner_.GetUnobservedTransactions(batch_size_))
+  {
+    BitVector lanes{};
+    if (!execution_manager_.PreExecute(layout.digest(), layout.mask(), lanes))
+    {
+      break;
+    }
+
+    miner_.SetObservedLanes(layout.digest(), lanes);
+    ++count;
+  }
+
+  return count;
+}
+
+void TransactionPreExecutor::ThreadEntryPoint()
+{
+  SetThreadName("TxPreExec");
+
+  while (running_)
+  {
+    std::this_thread::sleep_for(interval_);
+
+    std::size_t const count = PreExecuteBatch();
+    if (count > 0)
+    {
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Pre-executed ", count, " pending transactions");
+    }
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -23,6 +23,7 @@
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 #include "ledger/transaction_processor.hpp"
 #include "ledger/transaction_status_cache.hpp"
+#include "ledger/transaction_tracer.hpp"
 
 #include <cstddef>
 #include <thread>
@@ -66,6 +67,9 @@ void TransactionProcessor::OnTransaction(TransactionPtr const &tx)
 {
   FETCH_LOG_DEBUG(LOGGING_NAME, "Verified Input Transaction: 0x", tx->digest().ToHex());
 
+  auto &tracer = TransactionTracer::Instance();
+  tracer.Record(tx->digest(), TraceStage::VERIFIED);
+
   // dispatch the transaction to the storage engine
   try
   {
@@ -78,6 +82,8 @@ void TransactionProcessor::OnTransaction(TransactionPtr const &tx)
     return;
   }
 
+  tracer.Record(tx->digest(), TraceStage::STORED);
+
   switch (tx->contract_mode())
   {
   case Transaction::ContractMode::NOT_PRESENT:
@@ -167,6 +173,7 @@ void TransactionProcessor::Stop()
  */
 void TransactionProcessor::AddTransaction(TransactionPtr const &tx)
 {
+  TransactionTracer::Instance().Record(tx->digest(), TraceStage::SUBMITTED);
   verifier_.AddTransaction(tx);
 }
 
@@ -177,8 +184,19 @@ void TransactionProcessor::AddTransaction(TransactionPtr const &tx)
  */
 void TransactionProcessor::AddTransaction(TransactionPtr &&tx)
 {
+  TransactionTracer::Instance().Record(tx->digest(), TraceStage::SUBMITTED);
   verifier_.AddTransaction(std::move(tx));
 }
 
+/**
+ * Get the number of submitted transactions which are waiting to be verified
+ *
+ * @return The number of transactions
+ */
+std::size_t TransactionProcessor::GetBacklog() const
+{
+  return verifier_.GetBacklog();
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -16,16 +16,65 @@
 //
 //------------------------------------------------------------------------------
 
-#include "ledger/transaction_status_cache_impl.hpp"
+#include "ledger/sharded_transaction_status_cache.hpp"
 
 #include <memory>
+#include <mutex>
 
 namespace fetch {
 namespace ledger {
 
 TransactionStatusCache::ShrdPtr TransactionStatusCache::factory()
 {
-  return std::make_shared<TransactionStatusCacheImpl<>>();
+  return std::make_shared<ShardedTransactionStatusCache<>>();
+}
+
+/**
+ * Get the current sequence of the cache, which is advanced by every update
+ *
+ * @return The current sequence
+ */
+TransactionStatusCache::Sequence TransactionStatusCache::sequence() const
+{
+  return sequence_;
+}
+
+/**
+ * Wait for the cache to be updated beyond a previously observed sequence
+ *
+ * @param since The previously observed sequence
+ * @param timeout The maximum time to wait
+ * @return true if the cache has been updated, false if the wait timed out
+ */
+bool TransactionStatusCache::WaitForUpdate(Sequence                         since,
+                                           std::chrono::milliseconds const &timeout) const
+{
+  std::unique_lock<std::mutex> lock{wait_lock_};
+
+  ++waiters_;
+  bool const updated =
+      wait_condition_.wait_for(lock, timeout, [this, since]() { return sequence_ != since; });
+  --waiters_;
+
+  return updated;
+}
+
+/**
+ * Advance the sequence of the cache and wake any waiting threads. Must be called by the
+ * implementations after every update
+ */
+void TransactionStatusCache::NotifyUpdate()
+{
+  ++sequence_;
+
+  // updates are frequent, only take the lock when there is somebody to wake
+  if (waiters_ > 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock{wait_lock_};
+    }
+    wait_condition_.notify_all();
+  }
 }
 
 }  // namespace ledger
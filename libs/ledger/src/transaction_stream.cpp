@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/transaction_stream.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t TransactionStreamWriter::PREFIX_LENGTH;
+
+/**
+ * Append a serialised transaction to the stream
+ *
+ * @param encoded_tx The serialised transaction
+ */
+void TransactionStreamWriter::Append(ConstByteArray const &encoded_tx)
+{
+  auto const length = static_cast<uint32_t>(encoded_tx.size());
+
+  ByteArray prefix{};
+  prefix.Resize(PREFIX_LENGTH);
+  for (std::size_t i = 0; i < PREFIX_LENGTH; ++i)
+  {
+    prefix[i] = static_cast<uint8_t>(length >> (8u * (PREFIX_LENGTH - 1 - i)));
+  }
+
+  stream_.Append(prefix, encoded_tx);
+}
+
+/**
+ * Construct a reader for the specified stream
+ *
+ * @param stream The stream of length prefixed transactions
+ */
+TransactionStreamReader::TransactionStreamReader(ConstByteArray stream)
+  : stream_{std::move(stream)}
+{}
+
+/**
+ * Read the next transaction from the stream
+ *
+ * @param encoded_tx The output serialised transaction
+ * @return true if a transaction was read, otherwise false when the stream is exhausted
+ */
+bool TransactionStreamReader::Next(ConstByteArray &encoded_tx)
+{
+  std::size_t const remaining = stream_.size() - offset_;
+  if (remaining == 0)
+  {
+    return false;
+  }
+
+  if (remaining < TransactionStreamWriter::PREFIX_LENGTH)
+  {
+    truncated_ = true;
+    return false;
+  }
+
+  ConstByteArray const &stream = stream_;
+
+  std::size_t length{0};
+  for (std::size_t i = 0; i < TransactionStreamWriter::PREFIX_LENGTH; ++i)
+  {
+    length = (length << 8u) | stream[offset_ + i];
+  }
+
+  std::size_t const start = offset_ + TransactionStreamWriter::PREFIX_LENGTH;
+  if (length > (stream_.size() - start))
+  {
+    truncated_ = true;
+    return false;
+  }
+
+  encoded_tx = stream_.SubArray(start, length);
+  offset_    = start + length;
+
+  return true;
+}
+
+}  // namespace ledger
+}  // namespace fetch
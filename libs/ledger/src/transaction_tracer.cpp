@@ -0,0 +1,311 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/transaction_tracer.hpp"
+#include "telemetry/log_linear_histogram.hpp"
+#include "telemetry/registry.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr double LOWEST_LATENCY  = 1e-6;
+constexpr double HIGHEST_LATENCY = 1e3;
+
+double ToSeconds(TransactionTracer::Clock::duration const &duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+
+}  // namespace
+
+constexpr std::size_t TransactionTracer::RING_BUFFER_SIZE;
+constexpr std::size_t TransactionTracer::MAX_IN_FLIGHT_TRACES;
+
+char const *ToString(TraceStage stage)
+{
+  switch (stage)
+  {
+  case TraceStage::SUBMITTED:
+    return "submitted";
+  case TraceStage::VERIFIED:
+    return "verified";
+  case TraceStage::STORED:
+    return "stored";
+  case TraceStage::PACKED:
+    return "packed";
+  case TraceStage::SCHEDULED:
+    return "scheduled";
+  case TraceStage::EXECUTED:
+    return "executed";
+  case TraceStage::COMMITTED:
+    return "committed";
+  }
+
+  return "unknown";
+}
+
+/**
+ * Get the process wide transaction tracer
+ *
+ * @return The tracer instance
+ */
+TransactionTracer &TransactionTracer::Instance()
+{
+  static TransactionTracer instance{};
+  return instance;
+}
+
+TransactionTracer::TransactionTracer()
+  : total_latency_{telemetry::Registry::Instance().CreateLogLinearHistogram(
+        LOWEST_LATENCY, HIGHEST_LATENCY, "ledger_tx_trace_total_seconds",
+        "The time in seconds from the first to the committed stage of the traced transactions")}
+{
+  // the first stage has no predecessor to measure from
+  for (std::size_t i = 1; i < NUM_TRACE_STAGES; ++i)
+  {
+    std::string const stage{ToString(static_cast<TraceStage>(i))};
+
+    stage_latency_[i] = telemetry::Registry::Instance().CreateLogLinearHistogram(
+        LOWEST_LATENCY, HIGHEST_LATENCY, "ledger_tx_trace_" + stage + "_seconds",
+        "The time in seconds for the traced transactions to reach the " + stage +
+            " stage from the previous one");
+  }
+}
+
+/**
+ * Set the sampling of the traced transactions
+ *
+ * @param interval One in every interval transactions is traced, zero disables tracing
+ */
+void TransactionTracer::SetSampleInterval(uint32_t interval)
+{
+  sample_interval_ = interval;
+}
+
+uint32_t TransactionTracer::sample_interval() const
+{
+  return sample_interval_;
+}
+
+/**
+ * Determine if a transaction is traced. The selection only depends on the digest so that every
+ * stage of the pipeline makes the same decision.
+ *
+ * @param digest The digest of the transaction
+ * @return true if the transaction is traced, otherwise false
+ */
+bool TransactionTracer::IsSampled(Digest const &digest) const
+{
+  uint32_t const interval = sample_interval_;
+  if (interval == 0)
+  {
+    return false;
+  }
+
+  uint32_t value{0};
+  std::memcpy(&value, digest.pointer(), std::min(sizeof(value), digest.size()));
+
+  return (value % interval) == 0;
+}
+
+/**
+ * Discard all of the buffered events and in flight traces. The exported histograms are retained.
+ */
+void TransactionTracer::Clear()
+{
+  {
+    FETCH_LOCK(buffers_lock_);
+    for (auto const &buffer : buffers_)
+    {
+      FETCH_LOCK(buffer->lock);
+      buffer->next = 0;
+      buffer->size = 0;
+    }
+  }
+
+  FETCH_LOCK(in_flight_lock_);
+  in_flight_.clear();
+}
+
+/**
+ * Record that a transaction has reached a stage of the pipeline
+ *
+ * @param digest The digest of the transaction
+ * @param stage The stage reached
+ */
+void TransactionTracer::Record(Digest const &digest, TraceStage stage)
+{
+  if (!IsSampled(digest))
+  {
+    return;
+  }
+
+  auto const now = Clock::now();
+
+  {
+    auto &buffer = LocalBuffer();
+
+    FETCH_LOCK(buffer.lock);
+    buffer.events[buffer.next] = Event{digest, stage, now};
+    buffer.next                = (buffer.next + 1) % RING_BUFFER_SIZE;
+    buffer.size                = std::min(buffer.size + 1, RING_BUFFER_SIZE);
+  }
+
+  UpdateLatencies(digest, stage, now);
+}
+
+/**
+ * Record that all of the transactions of a block have reached a stage of the pipeline
+ *
+ * @param block The block
+ * @param stage The stage reached
+ */
+void TransactionTracer::Record(Block const &block, TraceStage stage)
+{
+  if (sample_interval_ == 0)
+  {
+    return;
+  }
+
+  for (auto const &slice : block.slices)
+  {
+    for (auto const &layout : slice)
+    {
+      Record(layout.digest(), stage);
+    }
+  }
+}
+
+/**
+ * @return All of the buffered events, in the order in which they were recorded
+ */
+TransactionTracer::Events TransactionTracer::Recent() const
+{
+  return Collect([](Event const &) { return true; });
+}
+
+/**
+ * @param digest The digest of the transaction
+ * @return The buffered events for the transaction, in the order in which they were recorded
+ */
+TransactionTracer::Events TransactionTracer::Lookup(Digest const &digest) const
+{
+  return Collect([&digest](Event const &event) { return event.digest == digest; });
+}
+
+/**
+ * Get the ring buffer of the calling thread, registering it on first use
+ */
+TransactionTracer::RingBuffer &TransactionTracer::LocalBuffer()
+{
+  thread_local RingBufferPtr buffer{};
+
+  if (!buffer)
+  {
+    buffer = std::make_shared<RingBuffer>();
+
+    FETCH_LOCK(buffers_lock_);
+
+    // drop the buffers of the threads which have since exited
+    auto const exited = [](RingBufferPtr const &other) { return other.use_count() == 1; };
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(), exited), buffers_.end());
+    buffers_.push_back(buffer);
+  }
+
+  return *buffer;
+}
+
+void TransactionTracer::UpdateLatencies(Digest const &digest, TraceStage stage, Timestamp timestamp)
+{
+  FETCH_LOCK(in_flight_lock_);
+
+  auto it = in_flight_.find(digest);
+  if (it == in_flight_.end())
+  {
+    if (stage == TraceStage::COMMITTED)
+    {
+      return;
+    }
+
+    // bound the traces of transactions which are never committed
+    if (in_flight_.size() >= MAX_IN_FLIGHT_TRACES)
+    {
+      in_flight_.erase(in_flight_.begin());
+    }
+
+    in_flight_.emplace(digest, InFlight{timestamp, timestamp});
+    return;
+  }
+
+  auto const &histogram = stage_latency_[static_cast<std::size_t>(stage)];
+  if (histogram)
+  {
+    histogram->Add(ToSeconds(timestamp - it->second.last));
+  }
+
+  if (stage == TraceStage::COMMITTED)
+  {
+    total_latency_->Add(ToSeconds(timestamp - it->second.first));
+    in_flight_.erase(it);
+  }
+  else
+  {
+    it->second.last = timestamp;
+  }
+}
+
+template <typename Predicate>
+TransactionTracer::Events TransactionTracer::Collect(Predicate const &predicate) const
+{
+  Events events{};
+
+  {
+    FETCH_LOCK(buffers_lock_);
+    for (auto const &buffer : buffers_)
+    {
+      FETCH_LOCK(buffer->lock);
+
+      // the oldest event is the next to be overwritten once the buffer is full
+      std::size_t const start = (buffer->next + RING_BUFFER_SIZE - buffer->size) % RING_BUFFER_SIZE;
+      for (std::size_t i = 0; i < buffer->size; ++i)
+      {
+        auto const &event = buffer->events[(start + i) % RING_BUFFER_SIZE];
+        if (predicate(event))
+        {
+          events.push_back(event);
+        }
+      }
+    }
+  }
+
+  std::stable_sort(events.begin(), events.end(), [](Event const &a, Event const &b) {
+    return a.timestamp < b.timestamp;
+  });
+
+  return events;
+}
+
+}  // namespace ledger
+}  // namespace fetch
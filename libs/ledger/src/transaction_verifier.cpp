@@ -19,6 +19,7 @@
 #include "chain/transaction.hpp"
 #include "core/set_thread_name.hpp"
 #include "core/string/to_lower.hpp"
+#include "crypto/verifier_cache.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
 #include "logging/logging.hpp"
@@ -29,7 +30,9 @@
 
 #include <algorithm>
 #include <chrono>
+#include <iterator>
 #include <string>
+#include <utility>
 
 namespace fetch {
 namespace ledger {
@@ -81,10 +84,12 @@ telemetry::CounterPtr CreateCounter(std::string const &prefix, std::string const
  * @param sink The destination for verified transactions
  * @param verifying_threads The number of verifying threads to be used
  * @param name The name of the verifier
+ * @param batch_size The maximum number of transactions verified by a thread in one go
  */
 TransactionVerifier::TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                                         std::string const &name)
+                                         std::string const &name, std::size_t batch_size)
   : verifying_threads_(verifying_threads)
+  , batch_size_(std::max<std::size_t>(batch_size, 1u))
   , name_(name)
   , sink_(sink)
   , unverified_queue_length_(
@@ -103,6 +108,8 @@ TransactionVerifier::TransactionVerifier(TransactionSink &sink, std::size_t veri
                                       "The total number of verified transactions seen"))
   , dispatched_tx_total_(CreateCounter(name, "dispatched_transactions_total",
                                        "The total number of verified that have been dispatched"))
+  , verified_batches_total_(CreateCounter(name, "verified_batches_total",
+                                          "The total number of verification batches processed"))
   , num_threads_(CreateGauge(name, "threads", "The current number of processing threads in use"))
 {
   // since these lengths are fixed
@@ -162,6 +169,7 @@ void TransactionVerifier::Stop()
  */
 void TransactionVerifier::AddTransaction(TransactionPtr const &tx)
 {
+  ++backlog_;
   unverified_queue_.Push(tx);
   unverified_queue_length_->increment();
   unverified_tx_total_->increment();
@@ -174,49 +182,92 @@ void TransactionVerifier::AddTransaction(TransactionPtr const &tx)
  */
 void TransactionVerifier::AddTransaction(TransactionPtr &&tx)
 {
+  ++backlog_;
   unverified_queue_.Push(std::move(tx));
   unverified_queue_length_->increment();
   unverified_tx_total_->increment();
 }
 
 /**
- * Internal: Thread process for the verification of
+ * Get the number of transactions which have been added but not yet verified. Once this reaches the
+ * capacity of the queue further additions block.
+ *
+ * @return The number of transactions
+ */
+std::size_t TransactionVerifier::GetBacklog() const
+{
+  return backlog_;
+}
+
+/**
+ * Internal: Thread process for the verification of transactions.
+ *
+ * Each iteration drains up to `batch_size_` transactions from the unverified queue. Verifiers
+ * (decoded public keys) are shared across the batch so that identities which sign multiple
+ * transactions are only decoded once. The valid transactions are then pushed to the verified
+ * queue together.
  */
 void TransactionVerifier::Verifier()
 {
-  TransactionPtr tx;
+  Transactions          batch{};
+  Transactions          verified{};
+  crypto::VerifierCache verifiers{};
+
+  batch.reserve(batch_size_);
+  verified.reserve(batch_size_);
 
   while (active_)
   {
     try
     {
-      // wait for a mutable transaction to be available
-      if (unverified_queue_.Pop(tx, POP_TIMEOUT))
+      batch.clear();
+      verified.clear();
+
+      // wait for a mutable transaction to be available and then collect any others which are
+      // immediately available
+      unverified_queue_.PopMany(std::back_inserter(batch), batch_size_, POP_TIMEOUT);
+
+      if (batch.empty())
       {
-        unverified_queue_length_->decrement();
+        continue;
+      }
 
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying TX: 0x", tx->digest().ToHex());
+      unverified_queue_length_->decrement(batch.size());
+      backlog_ -= batch.size();
+
+      for (auto &candidate : batch)
+      {
+        FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying TX: 0x", candidate->digest().ToHex());
 
         // check the status
-        if (tx->Verify())
+        if (candidate->Verify(verifiers))
         {
-          FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", tx->digest().ToHex());
+          FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", candidate->digest().ToHex());
 
-          verified_queue_.Push(std::move(tx));
-          verified_queue_length_->increment();
-          verified_tx_total_->increment();
+          verified.emplace_back(std::move(candidate));
         }
         else
         {
           FETCH_LOG_WARN(LOGGING_NAME, name_ + " Unable to verify transaction: 0x",
-                         tx->digest().ToHex());
+                         candidate->digest().ToHex());
 
           discarded_tx_total_->increment();
         }
       }
+
+      // the cache only spans a single batch, this bounds its size
+      verifiers.Clear();
+
+      verified_queue_.PushMany(verified.begin(), verified.end());
+
+      verified_queue_length_->increment(verified.size());
+      verified_tx_total_->add(verified.size());
+      verified_batches_total_->increment();
     }
     catch (std::exception const &e)
     {
+      verifiers.Clear();
+
       FETCH_LOG_WARN(LOGGING_NAME, name_ + " Exception caught: ", e.what());
     }
   }
@@ -19,12 +19,17 @@
 #include "core/byte_array/decoders.hpp"
 #include "core/macros.hpp"
 #include "http/json_response.hpp"
+#include "json/document.hpp"
 #include "ledger/transaction_status_cache.hpp"
 #include "ledger/tx_status_http_interface.hpp"
 #include "logging/logging.hpp"
 #include "variant/variant.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -109,8 +114,39 @@ Variant ToVariant(Digest const &digest, TransactionStatusCache::TxStatus const &
 
   return retval;
 }
+
+http::HTTPResponse JsonBadRequest(std::string const &message)
+{
+  auto response{Variant::Object()};
+  response["error"] = message;
+
+  return http::CreateJsonResponse(response, http::Status::CLIENT_ERROR_BAD_REQUEST);
+}
+
+bool ParseDigest(Variant const &value, Digest &digest)
+{
+  if (!value.IsString())
+  {
+    return false;
+  }
+
+  auto const hex = value.As<std::string>();
+  if ((hex.size() != 64) ||
+      !std::all_of(hex.begin(), hex.end(), [](char c) { return std::isxdigit(c) != 0; }))
+  {
+    return false;
+  }
+
+  digest = FromHex(hex);
+  return true;
+}
+
 }  // namespace
 
+constexpr char const *              TxStatusHttpInterface::WAIT_PATH;
+constexpr std::size_t               TxStatusHttpInterface::MAX_BATCH_SIZE;
+constexpr std::chrono::milliseconds TxStatusHttpInterface::MAX_WAIT_TIME;
+
 TxStatusHttpInterface::TxStatusHttpInterface(TxStatusCachePtr status_cache)
   : status_cache_{std::move(status_cache)}
 {
@@ -136,6 +172,172 @@ TxStatusHttpInterface::TxStatusHttpInterface(TxStatusCachePtr status_cache)
 
         return http::CreateJsonResponse("{}", http::Status::CLIENT_ERROR_BAD_REQUEST);
       });
+
+  Post("/api/status/txs", "Retrieves the status of a batch of transactions.",
+       [this](http::ViewParameters const & /*params*/, http::HTTPRequest const &request) {
+         return OnBatchQuery(request);
+       });
+
+  Post(WAIT_PATH, "Waits for the status of any of a batch of transactions to change.",
+       [this](http::ViewParameters const & /*params*/, http::HTTPRequest const &request) {
+         return OnWait(request);
+       });
+}
+
+/**
+ * Batch status handler, which expects a request of the form:
+ *
+ *   {"txs": ["<digest>", ...]}
+ *
+ * @param request The originating HTTPRequest object
+ * @return The statuses of the transactions, in the order in which they were requested
+ */
+http::HTTPResponse TxStatusHttpInterface::OnBatchQuery(http::HTTPRequest const &request) const
+{
+  json::JSONDocument doc;
+
+  try
+  {
+    doc.Parse(request.body());
+  }
+  catch (std::exception const &ex)
+  {
+    return JsonBadRequest("Unable to parse request: " + std::string{ex.what()});
+  }
+
+  auto const &root = doc.root();
+  if (!root.IsObject() || !root.Has("txs") || !root["txs"].IsArray())
+  {
+    return JsonBadRequest("Expected an array of transaction digests");
+  }
+
+  auto const &txs = root["txs"];
+  if (txs.size() > MAX_BATCH_SIZE)
+  {
+    return JsonBadRequest("Too many transactions, at most " + std::to_string(MAX_BATCH_SIZE) +
+                          " can be requested");
+  }
+
+  auto response{Variant::Object()};
+  response["txs"] = Variant::Array(txs.size());
+
+  for (std::size_t i = 0; i < txs.size(); ++i)
+  {
+    Digest digest;
+    if (!ParseDigest(txs[i], digest))
+    {
+      return JsonBadRequest("Invalid transaction digest at index " + std::to_string(i));
+    }
+
+    response["txs"][i] = ToVariant(digest, status_cache_->Query(digest));
+  }
+
+  return http::CreateJsonResponse(response);
+}
+
+/**
+ * Long poll handler, which expects a request of the form:
+ *
+ *   {"txs": [{"tx": "<digest>", "status": "<last seen status>"}, ...], "timeout": <ms>}
+ *
+ * The request completes as soon as the status of any of the transactions differs from the one
+ * which was last seen by the client (a missing status is taken to be "Unknown"), or once the
+ * timeout expires.
+ *
+ * @param request The originating HTTPRequest object
+ * @return The statuses of the transactions which have changed, empty if the wait timed out
+ */
+http::HTTPResponse TxStatusHttpInterface::OnWait(http::HTTPRequest const &request) const
+{
+  struct Watched
+  {
+    Digest      digest;
+    std::string status;
+  };
+
+  json::JSONDocument doc;
+
+  try
+  {
+    doc.Parse(request.body());
+  }
+  catch (std::exception const &ex)
+  {
+    return JsonBadRequest("Unable to parse request: " + std::string{ex.what()});
+  }
+
+  auto const &root = doc.root();
+  if (!root.IsObject() || !root.Has("txs") || !root["txs"].IsArray())
+  {
+    return JsonBadRequest("Expected an array of transactions");
+  }
+
+  auto const &txs = root["txs"];
+  if (txs.size() > MAX_BATCH_SIZE)
+  {
+    return JsonBadRequest("Too many transactions, at most " + std::to_string(MAX_BATCH_SIZE) +
+                          " can be watched");
+  }
+
+  std::vector<Watched> watched(txs.size());
+  for (std::size_t i = 0; i < txs.size(); ++i)
+  {
+    auto const &tx = txs[i];
+
+    if (!tx.IsObject() || !tx.Has("tx") || !ParseDigest(tx["tx"], watched[i].digest) ||
+        (tx.Has("status") && !tx["status"].IsString()))
+    {
+      return JsonBadRequest("Invalid transaction at index " + std::to_string(i));
+    }
+
+    watched[i].status =
+        tx.Has("status") ? tx["status"].As<std::string>() : ToString(PublicTxStatus::UNKNOWN);
+  }
+
+  auto timeout{MAX_WAIT_TIME};
+  if (root.Has("timeout"))
+  {
+    if (!root["timeout"].IsInteger() || (root["timeout"].As<int64_t>() < 0))
+    {
+      return JsonBadRequest("Invalid timeout");
+    }
+
+    timeout = std::min(timeout, std::chrono::milliseconds{root["timeout"].As<int64_t>()});
+  }
+
+  auto const deadline = std::chrono::steady_clock::now() + timeout;
+
+  auto response{Variant::Object()};
+  for (;;)
+  {
+    // observe the sequence first, so that no update in between can be missed
+    auto const sequence = status_cache_->sequence();
+
+    std::vector<Variant> changed;
+    for (auto const &tx : watched)
+    {
+      auto status{ToVariant(tx.digest, status_cache_->Query(tx.digest))};
+      if (status["status"].As<std::string>() != tx.status)
+      {
+        changed.emplace_back(std::move(status));
+      }
+    }
+
+    auto const now = std::chrono::steady_clock::now();
+    if (!changed.empty() || (now >= deadline) ||
+        !status_cache_->WaitForUpdate(
+            sequence, std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)))
+    {
+      response["txs"] = Variant::Array(changed.size());
+      for (std::size_t i = 0; i < changed.size(); ++i)
+      {
+        response["txs"][i] = std::move(changed[i]);
+      }
+      break;
+    }
+  }
+
+  return http::CreateJsonResponse(response);
 }
 
 }  // namespace ledger
@@ -25,7 +25,9 @@
 #include "ledger/state_sentinel_adapter.hpp"
 #include "ledger/storage_unit/cached_storage_adapter.hpp"
 #include "ledger/upow/synergetic_contract.hpp"
+#include "ledger/upow/synergetic_problem_cache.hpp"
 #include "logging/logging.hpp"
+#include "variant/variant.hpp"
 #include "vectorise/uint/uint.hpp"
 #include "vm/address.hpp"
 #include "vm/array.hpp"
@@ -38,6 +40,7 @@
 #include "vm_modules/math/bignumber.hpp"
 #include "vm_modules/vm_factory.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -56,6 +59,7 @@ using crypto::SHA256;
 
 using Status                = SynergeticContract::Status;
 using ProblemData           = SynergeticContract::ProblemData;
+using ParsedData            = std::vector<variant::Variant>;
 using VmStructuredData      = vm::Ptr<vm_modules::StructuredData>;
 using VmStructuredDataArray = vm::Ptr<vm::Array<VmStructuredData>>;
 
@@ -73,28 +77,43 @@ std::string ErrorsToLog(std::vector<std::string> const &errors)
   return oss.str();
 }
 
-VmStructuredData CreateProblemData(vm::VM *vm, ConstByteArray const &problem_data)
+/**
+ * Parse an element of problem data, which is undefined when it is not valid JSON
+ */
+variant::Variant ParseProblemData(ConstByteArray const &problem_data)
 {
-  VmStructuredData data{};
-
   try
   {
-    // parse the input data
     json::JSONDocument doc{problem_data};
+    return doc.root();
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to parse input problem data: ", ex.what());
+  }
+
+  return variant::Variant{};
+}
 
+VmStructuredData CreateProblemData(vm::VM *vm, variant::Variant const &problem_data)
+{
+  VmStructuredData data{};
+
+  try
+  {
     // create the structured data
     data =
-        StructuredData::ConstructorFromVariant(vm, vm->GetTypeId<VmStructuredData>(), doc.root());
+        StructuredData::ConstructorFromVariant(vm, vm->GetTypeId<VmStructuredData>(), problem_data);
   }
   catch (std::exception const &ex)
   {
-    FETCH_LOG_WARN(LOGGING_NAME, "Failed to parse input problem data: ", ex.what());
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to convert input problem data: ", ex.what());
   }
 
   return data;
 }
 
-VmStructuredDataArray CreateProblemData(vm::VM *vm, ProblemData const &problem_data)
+VmStructuredDataArray CreateProblemData(vm::VM *vm, ParsedData const &problem_data)
 {
   using UnderlyingArrayElement = vm::Array<VmStructuredData>::ElementType;
   using UnderlyingArray        = std::vector<UnderlyingArrayElement>;
@@ -104,6 +123,11 @@ VmStructuredDataArray CreateProblemData(vm::VM *vm, ProblemData const &problem_d
 
   for (auto const &problem : problem_data)
   {
+    if (problem.IsUndefined())
+    {
+      continue;
+    }
+
     // convert the problem data
     auto data = CreateProblemData(vm, problem);
 
@@ -216,27 +240,63 @@ SynergeticContract::SynergeticContract(ConstByteArray const &source)
 
 Status SynergeticContract::DefineProblem(ProblemData const &problem_data)
 {
-  // create the VM
-  auto vm  = std::make_unique<vm::VM>(module_.get());
   problem_ = std::make_shared<vm::Variant>();
 
-  if (charge_limit_ > 0)
+  uint64_t   charge{0};
+  auto const status = CreateProblem(problem_data, *problem_, charge);
+  if (Status::SUCCESS == status)
   {
-    vm->SetChargeLimit(charge_limit_);
+    charge_ += charge;
   }
 
-  // create the problem data
-  auto problems = CreateProblemData(vm.get(), problem_data);
+  return status;
+}
 
-  // execute the problem definition function
-  std::string error{};
-  if (!vm->Execute(*executable_, problem_function_, error, *problem_, problems))
+/**
+ * Define the problem, reusing the problem of the cache when the problem data has not changed since
+ * it was defined. Otherwise only the problem data appended since then is parsed.
+ *
+ * @param problem_data The problem data from the DAG
+ * @param cache The problem cache
+ * @return The associated status for the operation
+ */
+Status SynergeticContract::DefineProblem(ProblemData const &problem_data,
+                                         SynergeticProblemCache &cache)
+{
+  auto &entry = cache.Lookup(digest_);
+
+  if (!entry.problem || (entry.data != problem_data))
   {
-    FETCH_LOG_WARN(LOGGING_NAME, "Problem definition error: ", error);
+    bool const appended = (entry.data.size() <= problem_data.size()) &&
+                          std::equal(entry.data.begin(), entry.data.end(), problem_data.begin());
+    if (!appended)
+    {
+      entry.parsed.clear();
+    }
+
+    entry.parsed.reserve(problem_data.size());
+    for (std::size_t i = entry.parsed.size(); i < problem_data.size(); ++i)
+    {
+      entry.parsed.emplace_back(ParseProblemData(problem_data[i]));
+    }
+    entry.data = problem_data;
+
+    entry.problem     = std::make_shared<vm::Variant>();
+    auto const status = CreateProblem(entry.parsed, *entry.problem, entry.charge);
+    if (Status::SUCCESS != status)
+    {
+      entry.problem.reset();
+      return status;
+    }
+  }
+  else if ((charge_limit_ > 0) && (entry.charge > charge_limit_))
+  {
+    // the definition would not have completed within the charge limit
     return Status::VM_EXECUTION_ERROR;
   }
 
-  charge_ += vm->GetChargeTotal();
+  problem_ = entry.problem;
+  charge_ += entry.charge;
 
   return Status::SUCCESS;
 }
@@ -253,8 +313,75 @@ Status SynergeticContract::Work(vectorise::UInt<256> const &nonce, WorkScore &sc
   // overriding assumption that the problem has previously been defined
   assert(static_cast<bool>(problem_));
 
-  // assume this end badly
-  score = std::numeric_limits<WorkScore>::max();
+  auto const evaluation = Evaluate(*problem_, nonce);
+  Accept(evaluation);
+
+  score = evaluation.score;
+
+  return evaluation.status;
+}
+
+/**
+ * Create an instance of the problem without defining it on the contract. Problems hold VM objects
+ * which may not be shared between threads, so each thread scoring work needs its own instance.
+ *
+ * @param problem_data The problem data from the DAG
+ * @param problem The variable to be populated with the problem
+ * @param charge The charge for the problem definition
+ * @return The associated status for the operation
+ */
+Status SynergeticContract::CreateProblem(ProblemData const &problem_data, vm::Variant &problem,
+                                         uint64_t &charge) const
+{
+  ParsedData parsed_data{};
+  parsed_data.reserve(problem_data.size());
+  for (auto const &element : problem_data)
+  {
+    parsed_data.emplace_back(ParseProblemData(element));
+  }
+
+  return CreateProblem(parsed_data, problem, charge);
+}
+
+Status SynergeticContract::CreateProblem(ParsedData const &parsed_data, vm::Variant &problem,
+                                         uint64_t &charge) const
+{
+  // create the VM
+  auto vm = std::make_unique<vm::VM>(module_.get());
+
+  if (charge_limit_ > 0)
+  {
+    vm->SetChargeLimit(charge_limit_);
+  }
+
+  // create the problem data
+  auto problems = CreateProblemData(vm.get(), parsed_data);
+
+  // execute the problem definition function
+  std::string error{};
+  if (!vm->Execute(*executable_, problem_function_, error, problem, problems))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Problem definition error: ", error);
+    return Status::VM_EXECUTION_ERROR;
+  }
+
+  charge = vm->GetChargeTotal();
+
+  return Status::SUCCESS;
+}
+
+/**
+ * Score a piece of work against an instance of the problem, without changing the contract. This is
+ * safe to call concurrently as long as each thread uses its own problem instance.
+ *
+ * @param problem The problem instance, see CreateProblem
+ * @param nonce The nonce to be used to create the piece of work
+ * @return The evaluation of the work, to be passed to Accept if the work is used
+ */
+SynergeticContract::Evaluation SynergeticContract::Evaluate(vm::Variant const &         problem,
+                                                            vectorise::UInt<256> const &nonce) const
+{
+  Evaluation evaluation{};
 
   auto vm = std::make_unique<vm::VM>(module_.get());
 
@@ -268,37 +395,53 @@ Status SynergeticContract::Work(vectorise::UInt<256> const &nonce, WorkScore &sc
 
   // execute the work function of the contract
   std::string error{};
-  solution_ = std::make_shared<vm::Variant>();
-  if (!vm->Execute(*executable_, work_function_, error, *solution_, *problem_, hashed_nonce))
+  evaluation.solution = std::make_shared<vm::Variant>();
+  if (!vm->Execute(*executable_, work_function_, error, *evaluation.solution, problem,
+                   hashed_nonce))
   {
     FETCH_LOG_WARN(LOGGING_NAME, "Work execution error: ", error);
-    charge_ += vm->GetChargeTotal();
-    return Status::VM_EXECUTION_ERROR;
+    evaluation.charge = vm->GetChargeTotal();
+    evaluation.status = Status::VM_EXECUTION_ERROR;
+    return evaluation;
   }
 
   // execute the objective function of the contract
   vm::Variant objective_output{};
-  if (!vm->Execute(*executable_, objective_function_, error, objective_output, *problem_,
-                   *solution_))
+  if (!vm->Execute(*executable_, objective_function_, error, objective_output, problem,
+                   *evaluation.solution))
   {
     FETCH_LOG_WARN(LOGGING_NAME, "Objective evaluation execution error: ", error);
-    charge_ += vm->GetChargeTotal();
-    return Status::VM_EXECUTION_ERROR;
+    evaluation.charge = vm->GetChargeTotal();
+    evaluation.status = Status::VM_EXECUTION_ERROR;
+    return evaluation;
   }
 
-  charge_ += vm->GetChargeTotal();
+  evaluation.charge = vm->GetChargeTotal();
 
   // ensure the output of the objective function is "correct"
   if (vm::TypeIds::Int64 != objective_output.type_id)
   {
     FETCH_LOG_WARN(LOGGING_NAME, "Objective function must return Int64");
-    return Status::VM_EXECUTION_ERROR;
+    evaluation.status = Status::VM_EXECUTION_ERROR;
+    return evaluation;
   }
 
   // update the score
-  score = objective_output.primitive.i64;
+  evaluation.score  = objective_output.primitive.i64;
+  evaluation.status = Status::SUCCESS;
 
-  return Status::SUCCESS;
+  return evaluation;
+}
+
+/**
+ * Account for a piece of work scored with Evaluate, as if it had been done with Work
+ *
+ * @param evaluation The evaluation of the work
+ */
+void SynergeticContract::Accept(Evaluation const &evaluation)
+{
+  solution_ = evaluation.solution;
+  charge_ += evaluation.charge;
 }
 
 Status SynergeticContract::Complete(chain::Address const &address, BitVector const &shards,
@@ -211,6 +211,15 @@ bool SynergeticExecutionManager::ValidateWorkAndUpdateState(std::size_t num_lane
   // wait for the execution to complete
   threads_.Wait();
 
+  // settle the fees of executors which collect them over the block
+  {
+    FETCH_LOCK(lock_);
+    for (auto const &executor : executors_)
+    {
+      executor->SettleFees(miner, num_lanes);
+    }
+  }
+
   return true;
 }
 
@@ -32,8 +32,12 @@
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <future>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -49,109 +53,250 @@ using fetch::telemetry::Histogram;
 using fetch::telemetry::Registry;
 using fetch::meta::Log2;
 
+using Status = SynergeticContract::Status;
+
 }  // namespace
 
-SynergeticExecutor::SynergeticExecutor(StorageInterface &storage)
+SynergeticExecutor::SynergeticExecutor(StorageInterface &        storage,
+                                       chain::ShardedBalancesPtr sharded_balances,
+                                       std::size_t num_scoring_threads, Settlement settlement)
   : storage_{storage}
+  , token_contract_{std::move(sharded_balances)}
   , fee_manager_{token_contract_, "ledger_synergetic_executor_deduct_fees_duration"}
+  , num_scoring_threads_{std::max<std::size_t>(1, num_scoring_threads)}
+  , settlement_{settlement}
   , work_duration_{Registry::Instance().LookupMeasurement<Histogram>(
         "ledger_synergetic_executor_work_duration")}
   , complete_duration_{Registry::Instance().LookupMeasurement<Histogram>(
         "ledger_synergetic_executor_complete_duration")}
-{}
+{
+  if (num_scoring_threads_ > 1)
+  {
+    scoring_threads_ = std::make_unique<ThreadPool>(num_scoring_threads_, "SynScore");
+  }
+}
 
 void SynergeticExecutor::Verify(WorkQueue &solutions, ProblemData const &problem_data,
                                 std::size_t num_lanes, chain::Address const &miner)
 {
-  std::unique_ptr<SynergeticContract> contract;
+  if (solutions.empty())
+  {
+    return;
+  }
 
-  // iterate through each of the solutions
+  // the first valid solution in work queue order is the one selected
+  WorkList candidates{};
+  candidates.reserve(solutions.size());
   while (!solutions.empty())
   {
-    // get and extract the top element
-    auto const solution = solutions.top();
+    candidates.emplace_back(solutions.top());
     solutions.pop();
+  }
+
+  auto const &address = candidates.front()->address();
+
+  // create the contract and define the problem, once for all of the solutions
+  auto contract = CreateSmartContract<SynergeticContract>(address, storage_);
+  if (!contract)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to create synergetic contract: ", address.display());
+    return;
+  }
+
+  auto const status = contract->DefineProblem(problem_data, problem_cache_);
+  if (Status::SUCCESS != status)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to define synergetic problem: ", ToString(status));
+    return;
+  }
+
+  // score the solutions a batch at a time, stopping at the first batch with a valid solution
+  Problems problems(num_scoring_threads_);
+  for (std::size_t offset = 0; offset < candidates.size(); offset += num_scoring_threads_)
+  {
+    Evaluations evaluations{};
+    {
+      telemetry::FunctionTimer const timer{*work_duration_};
+      evaluations = Score(*contract, problem_data, candidates, offset, problems);
+    }
 
-    // in the case of the first iteration we need to create the contract and define the problem
-    if (!contract)
+    for (std::size_t i = 0; i < evaluations.size(); ++i)
     {
-      auto const &address = solution->address();
+      auto const &solution   = candidates[offset + i];
+      auto const &evaluation = evaluations[i];
 
-      // create the contract
-      contract = CreateSmartContract<SynergeticContract>(address, storage_);
+      // charge for the work as if the solutions had been scored one after another
+      contract->Accept(evaluation);
 
-      if (!contract)
+      // TODO(LDGR-621): fee for invalid solution?
+      if (Status::SUCCESS == evaluation.status && evaluation.score == solution->score())
       {
-        FETCH_LOG_WARN(LOGGING_NAME, "Failed to create synergetic contract: ", address.display());
+        Apply(*contract, *solution, num_lanes, miner);
         return;
       }
 
-      // define the problem
-      auto const status = contract->DefineProblem(problem_data);
-      if (SynergeticContract::Status::SUCCESS != status)
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "Unable to define synergetic problem: ", ToString(status));
+      FETCH_LOG_WARN(LOGGING_NAME, "Best solution is not valid, trying next solution");
+    }
+  }
+}
 
-        return;
-      }
+/**
+ * Score a batch of solutions, one per scoring thread
+ *
+ * @param contract The contract, with the problem defined
+ * @param problem_data The problem data, for the problem instances of the scoring threads
+ * @param candidates The solutions in work queue order
+ * @param offset The index of the first solution of the batch
+ * @param problems The problem instances of the scoring threads, created on first use
+ * @return The evaluations of the solutions in the batch, in order
+ */
+SynergeticExecutor::Evaluations SynergeticExecutor::Score(SynergeticContract const &contract,
+                                                          ProblemData const &problem_data,
+                                                          WorkList const &   candidates,
+                                                          std::size_t offset, Problems &problems)
+{
+  auto const count = std::min(num_scoring_threads_, candidates.size() - offset);
+
+  // the first thread shares the problem of the contract, since the others are waited for
+  auto const score = [&contract, &problem_data, &problems](std::size_t thread, Work const &work) {
+    if (thread == 0)
+    {
+      return contract.Evaluate(contract.GetProblem(), work.CreateHashedNonce());
     }
 
-    // validate the work that has been done
-    WorkScore                  calculated_score{0};
-    SynergeticContract::Status status;
+    auto &problem = problems[thread];
+    if (!problem)
     {
-      telemetry::FunctionTimer const timer{*work_duration_};
-      status = contract->Work(solution->CreateHashedNonce(), calculated_score);
+      auto     instance = std::make_shared<vm::Variant>();
+      uint64_t charge{0};
+
+      auto const status = contract.CreateProblem(problem_data, *instance, charge);
+      if (Status::SUCCESS != status)
+      {
+        SynergeticContract::Evaluation evaluation{};
+        evaluation.status = status;
+        return evaluation;
+      }
+
+      problem = std::move(instance);
     }
-    // TODO(LDGR-621): fee for invalid solution?
-    if (SynergeticContract::Status::SUCCESS == status && calculated_score == solution->score())
+
+    return contract.Evaluate(*problem, work.CreateHashedNonce());
+  };
+
+  Evaluations evaluations(count);
+
+  if (!scoring_threads_ || (count == 1))
+  {
+    for (std::size_t i = 0; i < count; ++i)
     {
-      // TODO(issue 1213): State sharding needs to be added here
-      BitVector shard_mask{num_lanes};
-      shard_mask.SetAllOne();
+      evaluations[i] = score(i, *candidates[offset + i]);
+    }
 
-      StateSentinelAdapter storage_adapter{storage_, solution->address().display(), shard_mask};
+    return evaluations;
+  }
 
-      // complete the work and resolve the work queue
-      contract->Attach(storage_);
-      ContractContext ctx(&token_contract_, solution->address(), nullptr, &storage_adapter, 0);
-      contract->UpdateContractContext(ctx);
+  std::vector<std::future<SynergeticContract::Evaluation>> results{};
+  results.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto const &work = candidates[offset + i];
+    results.emplace_back(scoring_threads_->Dispatch([&score, i, work] { return score(i, *work); }));
+  }
 
-      // TODO(LDGR-622): charge limit
-      FeeManager::TransactionDetails tx_details{solution->address(), solution->address(),
-                                                shard_mask,          solution->address().display(),
-                                                CHARGE_RATE,         CHARGE_LIMIT};
+  // all of the threads must have finished with the problems before an error is raised
+  for (auto &result : results)
+  {
+    result.wait();
+  }
 
-      ContractExecutionResult result;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    evaluations[i] = results[i].get();
+  }
 
-      {
-        telemetry::FunctionTimer const timer{*complete_duration_};
-        status = contract->Complete(
-            solution->address(), shard_mask, [this, &contract, &tx_details, &result]() -> bool {
-              return fee_manager_.CalculateChargeAndValidate(tx_details, {contract.get()}, result);
-            });
-      }
+  return evaluations;
+}
 
-      if (SynergeticContract::Status::SUCCESS != status)
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "Failed to complete contract: 0x", contract->digest().ToHex(),
-                       " Reason: ", ToString(status));
-        return;
-      }
-      FETCH_LOG_DEBUG(LOGGING_NAME, "Calculated fee: ", result.charge);
-      fee_manager_.Execute(tx_details, result, solution->block_index(), storage_);
+/**
+ * Complete the contract with a verified solution and settle its fees
+ *
+ * @param contract The contract, with the solution accepted
+ * @param solution The verified solution
+ * @param num_lanes The number of lanes
+ * @param miner The miner of the block
+ */
+void SynergeticExecutor::Apply(SynergeticContract &contract, Work const &solution,
+                               std::size_t num_lanes, chain::Address const &miner)
+{
+  // TODO(issue 1213): State sharding needs to be added here
+  BitVector shard_mask{num_lanes};
+  shard_mask.SetAllOne();
 
-      fee_manager_.SettleFees(miner, result.fee, tx_details.contract_address,
-                              Log2(static_cast<uint32_t>(num_lanes)), solution->block_index(),
-                              storage_);
+  StateSentinelAdapter storage_adapter{storage_, solution.address().display(), shard_mask};
 
-      contract->Detach();
+  // complete the work and resolve the work queue
+  contract.Attach(storage_);
+  ContractContext ctx(&token_contract_, solution.address(), nullptr, &storage_adapter, 0);
+  contract.UpdateContractContext(ctx);
 
-      break;
-    }
+  // TODO(LDGR-622): charge limit
+  FeeManager::TransactionDetails tx_details{solution.address(), solution.address(),
+                                            shard_mask,         solution.address().display(),
+                                            CHARGE_RATE,        CHARGE_LIMIT};
 
-    FETCH_LOG_WARN(LOGGING_NAME, "Best solution is not valid, trying next solution");
+  ContractExecutionResult result;
+
+  Status status{};
+  {
+    telemetry::FunctionTimer const timer{*complete_duration_};
+    status = contract.Complete(
+        solution.address(), shard_mask, [this, &contract, &tx_details, &result]() -> bool {
+          return fee_manager_.CalculateChargeAndValidate(tx_details, {&contract}, result);
+        });
+  }
+
+  if (Status::SUCCESS != status)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to complete contract: 0x", contract.digest().ToHex(),
+                   " Reason: ", ToString(status));
+    return;
   }
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Calculated fee: ", result.charge);
+  if (Settlement::PER_BLOCK == settlement_)
+  {
+    // the fee is taken together with the others of the block, see SettleFees
+    fee_manager_.Execute(tx_details, result, block_fees_);
+    block_index_ = solution.block_index();
+  }
+  else
+  {
+    fee_manager_.Execute(tx_details, result, solution.block_index(), storage_);
+
+    fee_manager_.SettleFees(miner, result.fee, tx_details.contract_address,
+                            Log2(static_cast<uint32_t>(num_lanes)), solution.block_index(),
+                            storage_);
+  }
+
+  contract.Detach();
+}
+
+/**
+ * Settle the fees of the solutions verified for the current block, when they are settled per block
+ *
+ * @param miner The miner of the block
+ * @param num_lanes The number of lanes
+ */
+void SynergeticExecutor::SettleFees(chain::Address const &miner, std::size_t num_lanes)
+{
+  if (block_fees_.empty())
+  {
+    return;
+  }
+
+  fee_manager_.SettleFees(miner, block_fees_, Log2(static_cast<uint32_t>(num_lanes)), block_index_,
+                          storage_);
+  block_fees_.Clear();
 }
 
 }  // namespace ledger
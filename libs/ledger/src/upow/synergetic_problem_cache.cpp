@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/upow/synergetic_problem_cache.hpp"
+
+#include <algorithm>
+
+namespace fetch {
+namespace ledger {
+
+SynergeticProblemCache::SynergeticProblemCache(std::size_t max_contracts)
+  : max_contracts_{std::max<std::size_t>(1, max_contracts)}
+{}
+
+/**
+ * Look up the entry of a contract, creating an empty one if needed. When the cache is full the
+ * least recently used contract is evicted to make space.
+ *
+ * @param contract The digest of the contract
+ * @return The entry of the contract
+ */
+SynergeticProblemCache::Entry &SynergeticProblemCache::Lookup(Digest const &contract)
+{
+  auto it = entries_.find(contract);
+  if (it == entries_.end())
+  {
+    if (entries_.size() >= max_contracts_)
+    {
+      auto const oldest =
+          std::min_element(entries_.begin(), entries_.end(), [](auto const &a, auto const &b) {
+            return a.second.last_used < b.second.last_used;
+          });
+      entries_.erase(oldest);
+    }
+
+    it = entries_.emplace(contract, Entry{}).first;
+  }
+
+  it->second.last_used = ++counter_;
+
+  return it->second;
+}
+
+std::size_t SynergeticProblemCache::size() const
+{
+  return entries_.size();
+}
+
+}  // namespace ledger
+}  // namespace fetch
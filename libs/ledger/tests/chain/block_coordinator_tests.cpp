@@ -31,17 +31,21 @@
 #include "ledger/consensus/stake_manager_interface.hpp"
 #include "ledger/testing/block_generator.hpp"
 #include "mock_block_packer.hpp"
+#include "mock_consensus.hpp"
 #include "mock_execution_manager.hpp"
 #include "mock_storage_unit.hpp"
 #include "testing/common_testing_functionality.hpp"
 
 #include "gmock/gmock.h"
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <ostream>
+#include <vector>
 
 namespace {
 
@@ -54,6 +58,7 @@ using fetch::ledger::testing::BlockGenerator;
 using ::testing::_;
 using ::testing::AnyNumber;
 using ::testing::InSequence;
+using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::StrictMock;
 
@@ -989,6 +994,180 @@ protected:
   fetch::moment::AdjustableClockPtr clock_;
 };
 
+class PreparingBlockCoordinatorTests : public NiceMockBlockCoordinatorTests
+{
+protected:
+  using MockConsensusPtr = std::shared_ptr<NiceMock<MockConsensus>>;
+  using Blocks           = std::vector<BlockPtr>;
+  using BlockNumbers     = std::vector<uint64_t>;
+  using ExecutionState   = ExecutionManagerInterface::State;
+
+  // long enough for the coordinator to retain the path to the heaviest block
+  static constexpr std::size_t CHAIN_LENGTH = 120;
+
+  void SetUp() override
+  {
+    NiceMockBlockCoordinatorTests::SetUp();
+
+    // while set, executions are kept running until the test allows them to complete
+    ON_CALL(*execution_manager_, GetState()).WillByDefault(Invoke([this]() {
+      return executing_ ? ExecutionState::ACTIVE : execution_manager_->fake.GetState();
+    }));
+
+    block_coordinator_ = std::make_unique<BlockCoordinator>(
+        *main_chain_, DAGPtr{}, *execution_manager_, *storage_unit_, *packer_, *block_sink_,
+        std::make_shared<ECDSASigner>(), LOG2_NUM_LANES, NUM_SLICES, mock_consensus_, nullptr);
+  }
+
+  Blocks GenerateChain()
+  {
+    Blocks blocks{block_generator_()};
+    for (std::size_t i = 0; i < CHAIN_LENGTH; ++i)
+    {
+      blocks.emplace_back(block_generator_(blocks.back()));
+    }
+
+    return blocks;
+  }
+
+  void AddToChain(Blocks const &blocks)
+  {
+    for (std::size_t i = 1; i < blocks.size(); ++i)
+    {
+      ASSERT_EQ(BlockStatus::ADDED, main_chain_->AddBlock(*blocks[i]));
+    }
+  }
+
+  static BlockNumbers NumbersOf(std::vector<Block const *> const &blocks)
+  {
+    BlockNumbers numbers{};
+    for (auto const *block : blocks)
+    {
+      numbers.push_back(block->block_number);
+    }
+
+    return numbers;
+  }
+
+  static BlockNumbers Range(uint64_t first, uint64_t last)
+  {
+    BlockNumbers numbers{};
+    for (uint64_t number = first; number <= last; ++number)
+    {
+      numbers.push_back(number);
+    }
+
+    return numbers;
+  }
+
+  // run the state machine until the future is ready, or times out
+  template <typename T>
+  bool AdvanceUntilReady(std::future<T> &future, std::size_t max_iterations = 100)
+  {
+    for (; max_iterations > 0; --max_iterations)
+    {
+      if (future.wait_for(std::chrono::milliseconds{10}) == std::future_status::ready)
+      {
+        return true;
+      }
+
+      block_coordinator_->GetRunnable().Execute();
+    }
+
+    return false;
+  }
+
+  MockConsensusPtr  mock_consensus_{std::make_shared<NiceMock<MockConsensus>>()};
+  std::atomic<bool> executing_{false};
+};
+
+TEST_F(PreparingBlockCoordinatorTests, UpcomingBlocksArePreparedWhileTheCurrentBlockExecutes)
+{
+  auto const blocks = GenerateChain();
+
+  // fabricate unknown transactions in a block which is about to be executed, and in one which is
+  // further ahead than the blocks being prepared
+  TransactionLayout const upcoming_tx{*fetch::testing::GenerateUniqueHashes(1u).begin(),
+                                      fetch::BitVector{}, 0, 0, 1000};
+  TransactionLayout const distant_tx{*fetch::testing::GenerateUniqueHashes(1u).begin(),
+                                     fetch::BitVector{}, 0, 0, 1000};
+
+  blocks[2]->slices.begin()->push_back(upcoming_tx);
+  blocks[20]->slices.begin()->push_back(distant_tx);
+
+  std::promise<BlockNumbers> verified{};
+  auto                       verified_numbers = verified.get_future();
+
+  // only the transactions of the upcoming blocks are requested, and their notarisations are
+  // verified together on the preparation worker
+  EXPECT_CALL(*storage_unit_, IssueCallForMissingTxs(fetch::DigestSet{upcoming_tx.digest()})).Times(1);
+  EXPECT_CALL(*mock_consensus_, VerifyNotarisations(_))
+      .WillOnce(Invoke([&verified](std::vector<Block const *> const &upcoming) {
+        verified.set_value(NumbersOf(upcoming));
+      }));
+
+  Tock(State::RELOAD_STATE, State::SYNCHRONISED);
+
+  AddToChain(blocks);
+  executing_ = true;
+
+  Tock(State::SYNCHRONISED, State::WAIT_FOR_EXECUTION);
+
+  ASSERT_TRUE(AdvanceUntilReady(verified_numbers));
+  EXPECT_EQ(Range(2, 17), verified_numbers.get());
+
+  // the upcoming blocks are only prepared once
+  ASSERT_TRUE(RemainsOn(State::WAIT_FOR_EXECUTION));
+}
+
+TEST_F(PreparingBlockCoordinatorTests, OnlyOneBatchOfUpcomingBlocksIsVerifiedAtATime)
+{
+  auto const blocks = GenerateChain();
+
+  std::promise<void>         release{};
+  std::shared_future<void>   released = release.get_future().share();
+  std::promise<BlockNumbers> first_batch{};
+  std::promise<BlockNumbers> second_batch{};
+  auto                       first_numbers  = first_batch.get_future();
+  auto                       second_numbers = second_batch.get_future();
+
+  // the first batch is held up until the test releases it
+  EXPECT_CALL(*mock_consensus_, VerifyNotarisations(_))
+      .WillOnce(Invoke([&first_batch, released](std::vector<Block const *> const &upcoming) {
+        first_batch.set_value(NumbersOf(upcoming));
+        released.wait();
+      }))
+      .WillOnce(Invoke([&second_batch](std::vector<Block const *> const &upcoming) {
+        second_batch.set_value(NumbersOf(upcoming));
+      }));
+
+  Tock(State::RELOAD_STATE, State::SYNCHRONISED);
+
+  AddToChain(blocks);
+  executing_ = true;
+
+  Tock(State::SYNCHRONISED, State::WAIT_FOR_EXECUTION);
+
+  ASSERT_TRUE(AdvanceUntilReady(first_numbers));
+  EXPECT_EQ(Range(2, 17), first_numbers.get());
+
+  // the coordinator is not held up by the verification, and moves on to the next block
+  executing_ = false;
+  Tock(State::WAIT_FOR_EXECUTION, State::POST_EXEC_BLOCK_VALIDATION);
+  executing_ = true;
+  Tock(State::POST_EXEC_BLOCK_VALIDATION, State::WAIT_FOR_EXECUTION);
+
+  // but no further verifications are started while the first batch is in flight
+  ASSERT_TRUE(RemainsOn(State::WAIT_FOR_EXECUTION, 10));
+  EXPECT_EQ(std::future_status::timeout, second_numbers.wait_for(std::chrono::milliseconds{50}));
+
+  release.set_value();
+
+  // once it is complete the block which has come into range is verified
+  ASSERT_TRUE(AdvanceUntilReady(second_numbers));
+  EXPECT_EQ(BlockNumbers{18}, second_numbers.get());
+}
+
 TEST_F(NiceMockBlockCoordinatorTests, UnknownTransactionDoesNotBlockForever)
 {
   TransactionLayout layout{*fetch::testing::GenerateUniqueHashes(1u).begin(), fetch::BitVector{}, 0,
@@ -1024,4 +1203,36 @@ TEST_F(NiceMockBlockCoordinatorTests, UnknownTransactionDoesNotBlockForever)
   Tock(State::WAIT_FOR_TRANSACTIONS, State::SYNCHRONISED);
 }
 
+TEST_F(NiceMockBlockCoordinatorTests, BlockWithInvalidStateIsRolledBack)
+{
+  auto genesis = block_generator_();
+  auto b1      = block_generator_(genesis);
+
+  // execution of the block results in a state which differs from its merkle hash
+  ON_CALL(*execution_manager_, Execute(_)).WillByDefault(::testing::Invoke([this](Block const &b) {
+    auto const status = execution_manager_->fake.Execute(b);
+    if (b.block_number > 0)
+    {
+      storage_unit_->fake.SetCurrentHash(fetch::byte_array::ConstByteArray{"invalid state"});
+    }
+    return status;
+  }));
+
+  Tock(State::RELOAD_STATE, State::SYNCHRONISED);
+
+  ASSERT_EQ(BlockStatus::ADDED, main_chain_->AddBlock(*b1));
+
+  Tock(State::SYNCHRONISED, State::POST_EXEC_BLOCK_VALIDATION);
+
+  // the state is validated before it is committed, so the invalid state is never committed and
+  // is reverted to that of the previous block
+  EXPECT_CALL(*storage_unit_, Commit(_)).Times(0);
+  EXPECT_CALL(*storage_unit_, RevertToHash(genesis->merkle_hash, 0));
+
+  Tick(State::POST_EXEC_BLOCK_VALIDATION, State::RESET);
+
+  EXPECT_FALSE(main_chain_->GetBlock(b1->hash));
+  EXPECT_EQ(execution_manager_->fake.LastProcessedBlock(), genesis->hash);
+}
+
 }  // namespace
@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block.hpp"
+#include "ledger/protocols/block_sync_pipeline.hpp"
+#include "ledger/testing/block_generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::ledger::Block;
+using fetch::ledger::BlockSyncPipeline;
+using fetch::ledger::testing::BlockGenerator;
+
+using Address = BlockSyncPipeline::Address;
+using Blocks  = BlockSyncPipeline::Blocks;
+
+class BlockSyncPipelineTests : public ::testing::Test
+{
+protected:
+  static constexpr std::size_t NUM_LANES   = 1;
+  static constexpr std::size_t NUM_SLICES  = 1;
+  static constexpr uint64_t    STRIDE      = 4;
+  static constexpr std::size_t NUM_RANGES  = 5;
+  static constexpr std::size_t NUM_BUFFERS = 3;
+
+  void SetUp() override
+  {
+    fetch::crypto::mcl::details::MCLInitialiser();
+    generator_.Reset();
+
+    BlockGenerator::BlockPtr block = generator_.Generate();
+    chain_.push_back(*block);
+
+    for (std::size_t i = 0; i < (STRIDE * NUM_RANGES); ++i)
+    {
+      block = generator_.Generate(block);
+      chain_.push_back(*block);
+    }
+
+    BlockSyncPipeline::BlockHashes skeleton{};
+    for (std::size_t i = 0; i < chain_.size(); i += STRIDE)
+    {
+      skeleton.push_back(chain_[i].hash);
+    }
+
+    pipeline_.Reset(skeleton, STRIDE);
+  }
+
+  /// The blocks of a range, including the preceding block (as returned by a peer)
+  Blocks RangeBlocks(BlockSyncPipeline::Range const &range) const
+  {
+    auto const begin = chain_.begin() + static_cast<std::ptrdiff_t>(range.index * STRIDE);
+
+    return {begin, begin + static_cast<std::ptrdiff_t>(STRIDE + 1)};
+  }
+
+  BlockGenerator    generator_{NUM_LANES, NUM_SLICES};
+  Blocks            chain_{};
+  BlockSyncPipeline pipeline_{NUM_BUFFERS};
+  Address const     peer_{"peer"};
+};
+
+TEST_F(BlockSyncPipelineTests, CheckRangesAreDeliveredInOrder)
+{
+  EXPECT_EQ(pipeline_.num_ranges(), NUM_RANGES);
+  EXPECT_TRUE(pipeline_.IsActive());
+
+  // the number of outstanding ranges is bounded by the reorder buffer
+  std::vector<BlockSyncPipeline::Range> ranges(NUM_BUFFERS);
+  for (auto &range : ranges)
+  {
+    ASSERT_TRUE(pipeline_.NextRange(range));
+  }
+
+  BlockSyncPipeline::Range extra{};
+  EXPECT_FALSE(pipeline_.NextRange(extra));
+  EXPECT_EQ(pipeline_.num_in_flight(), NUM_BUFFERS);
+
+  // complete the ranges in reverse order
+  Address source{};
+  Blocks  blocks{};
+  for (std::size_t i = ranges.size(); i > 1; --i)
+  {
+    ASSERT_TRUE(pipeline_.Complete(ranges[i - 1].index, peer_, RangeBlocks(ranges[i - 1])));
+    EXPECT_FALSE(pipeline_.PopNext(source, blocks));
+  }
+
+  ASSERT_TRUE(pipeline_.Complete(ranges[0].index, peer_, RangeBlocks(ranges[0])));
+  EXPECT_EQ(pipeline_.num_buffered(), NUM_BUFFERS);
+
+  std::size_t height = 1;
+  while (pipeline_.PopNext(source, blocks))
+  {
+    EXPECT_EQ(source, peer_);
+    ASSERT_EQ(blocks.size(), STRIDE);
+
+    for (auto const &block : blocks)
+    {
+      EXPECT_EQ(block.hash, chain_[height++].hash);
+    }
+  }
+
+  EXPECT_EQ(height, (NUM_BUFFERS * STRIDE) + 1);
+  EXPECT_EQ(pipeline_.delivered_hash(), chain_[height - 1].hash);
+
+  // the remaining ranges can now be requested
+  BlockSyncPipeline::Range range{};
+  while (pipeline_.NextRange(range))
+  {
+    ASSERT_TRUE(pipeline_.Complete(range.index, peer_, RangeBlocks(range)));
+    ASSERT_TRUE(pipeline_.PopNext(source, blocks));
+  }
+
+  EXPECT_TRUE(pipeline_.IsComplete());
+  EXPECT_EQ(pipeline_.delivered_hash(), chain_.back().hash);
+}
+
+TEST_F(BlockSyncPipelineTests, CheckInvalidRangesAreRejected)
+{
+  BlockSyncPipeline::Range range{};
+  ASSERT_TRUE(pipeline_.NextRange(range));
+  EXPECT_EQ(range.index, 0);
+  EXPECT_EQ(range.first, chain_[0].hash);
+  EXPECT_EQ(range.last, chain_[STRIDE].hash);
+
+  // incomplete range
+  auto blocks = RangeBlocks(range);
+  blocks.pop_back();
+  EXPECT_FALSE(pipeline_.Complete(range.index, peer_, blocks));
+
+  // broken link
+  ASSERT_TRUE(pipeline_.NextRange(range));
+  EXPECT_EQ(range.index, 0);
+  blocks                  = RangeBlocks(range);
+  blocks[2].previous_hash = blocks[0].hash;
+  EXPECT_FALSE(pipeline_.Complete(range.index, peer_, blocks));
+
+  // the wrong range
+  ASSERT_TRUE(pipeline_.NextRange(range));
+  BlockSyncPipeline::Range other{};
+  other.index = 1;
+  EXPECT_FALSE(pipeline_.Complete(range.index, peer_, RangeBlocks(other)));
+
+  // a range which has not been requested
+  EXPECT_FALSE(pipeline_.Complete(1, peer_, RangeBlocks(other)));
+
+  // eventually the range is abandoned completely
+  for (std::size_t attempt = 3; attempt < BlockSyncPipeline::MAX_RANGE_ATTEMPTS; ++attempt)
+  {
+    ASSERT_TRUE(pipeline_.Abandon(range.index));
+    ASSERT_TRUE(pipeline_.NextRange(range));
+    EXPECT_EQ(range.index, 0);
+  }
+
+  EXPECT_FALSE(pipeline_.Abandon(range.index));
+  EXPECT_EQ(pipeline_.num_in_flight(), 0);
+}
+
+TEST_F(BlockSyncPipelineTests, CheckClear)
+{
+  pipeline_.Clear();
+
+  BlockSyncPipeline::Range range{};
+  EXPECT_FALSE(pipeline_.NextRange(range));
+  EXPECT_TRUE(pipeline_.IsComplete());
+  EXPECT_EQ(pipeline_.num_ranges(), 0);
+}
+
+}  // namespace
@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "crypto/mcl_dkg.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/testing/block_generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::ledger::BlockStatus;
+using fetch::ledger::MainChain;
+using fetch::ledger::testing::BlockGenerator;
+
+using MainChainPtr      = std::unique_ptr<MainChain>;
+using BlockGeneratorPtr = std::unique_ptr<BlockGenerator>;
+using BlockPtr          = BlockGenerator::BlockPtr;
+using Blocks            = std::vector<BlockPtr>;
+
+constexpr char const *HEAD_STORE          = "chain.head.db";
+constexpr char const *VERIFIED_HEAD_STORE = "chain.verified.db";
+
+std::string ReadFile(char const *filename)
+{
+  std::ifstream in(filename, std::ios::binary | std::ios::in);
+  return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+void WriteFile(char const *filename, std::string const &contents)
+{
+  std::ofstream out(filename, std::ios::binary | std::ios::out | std::ios::trunc);
+  out << contents;
+}
+
+std::string AsString(fetch::Digest const &hash)
+{
+  return {reinterpret_cast<char const *>(hash.pointer()), hash.size()};
+}
+
+class MainChainRecoveryTests : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    fetch::crypto::mcl::details::MCLInitialiser();
+    fetch::chain::InitialiseTestConstants();
+  }
+
+  void SetUp() override
+  {
+    chain_     = std::make_unique<MainChain>(MainChain::Mode::CREATE_PERSISTENT_DB);
+    generator_ = std::make_unique<BlockGenerator>(1, 2);
+  }
+
+  void TearDown() override
+  {
+    chain_.reset();
+  }
+
+  void Restart()
+  {
+    chain_.reset();
+    chain_ = std::make_unique<MainChain>(MainChain::Mode::LOAD_PERSISTENT_DB);
+  }
+
+  /**
+   * Add blocks to the chain, the last but FINALITY_PERIOD of which are written to file
+   *
+   * @param previous The block to build on
+   * @param num_blocks The number of blocks to add
+   * @return The added blocks
+   */
+  Blocks Extend(BlockPtr previous, std::size_t num_blocks)
+  {
+    Blocks blocks;
+    for (std::size_t i = 0; i < num_blocks; ++i)
+    {
+      previous = generator_->Generate(previous);
+      EXPECT_EQ(BlockStatus::ADDED, chain_->AddBlock(*previous));
+      blocks.push_back(previous);
+    }
+    return blocks;
+  }
+
+  /**
+   * The block which is the head of the file once `blocks` have been added
+   */
+  static BlockPtr const &WrittenHead(Blocks const &blocks)
+  {
+    return blocks[blocks.size() - 1 - fetch::chain::FINALITY_PERIOD];
+  }
+
+  MainChainPtr      chain_;
+  BlockGeneratorPtr generator_;
+};
+
+TEST_F(MainChainRecoveryTests, WrittenChainIsRecovered)
+{
+  auto const blocks = Extend(generator_->Generate(), 30);
+  auto const head   = WrittenHead(blocks);
+
+  Restart();
+
+  EXPECT_EQ(chain_->GetHeaviestBlockHash(), head->hash);
+  EXPECT_EQ(chain_->GetHeaviestChain().size(), head->block_number + 1);
+  EXPECT_EQ(ReadFile(VERIFIED_HEAD_STORE), AsString(head->hash));
+}
+
+TEST_F(MainChainRecoveryTests, BlocksWrittenAfterARestartAreRecovered)
+{
+  auto const blocks = Extend(generator_->Generate(), 30);
+  Restart();
+
+  // the walk down from the new head stops at the head verified by the previous start up
+  auto const more_blocks = Extend(WrittenHead(blocks), 15);
+  auto const head        = WrittenHead(more_blocks);
+
+  Restart();
+
+  EXPECT_EQ(chain_->GetHeaviestBlockHash(), head->hash);
+  EXPECT_EQ(chain_->GetHeaviestChain().size(), head->block_number + 1);
+  EXPECT_EQ(ReadFile(VERIFIED_HEAD_STORE), AsString(head->hash));
+}
+
+TEST_F(MainChainRecoveryTests, CorruptVerifiedHeadIsIgnored)
+{
+  auto const blocks = Extend(generator_->Generate(), 30);
+  auto const head   = WrittenHead(blocks);
+  Restart();
+
+  // the stored hash matches no block, so the whole chain is verified again
+  WriteFile(VERIFIED_HEAD_STORE, std::string(fetch::chain::HASH_SIZE, 'x'));
+  Restart();
+
+  EXPECT_EQ(chain_->GetHeaviestBlockHash(), head->hash);
+  EXPECT_EQ(ReadFile(VERIFIED_HEAD_STORE), AsString(head->hash));
+}
+
+TEST_F(MainChainRecoveryTests, CorruptTipResetsTheChain)
+{
+  auto const blocks = Extend(generator_->Generate(), 30);
+  Restart();
+
+  // the head of the file no longer refers to a stored block
+  WriteFile(HEAD_STORE, std::string(fetch::chain::HASH_SIZE, 'x'));
+  Restart();
+
+  EXPECT_EQ(chain_->GetHeaviestBlock()->block_number, 0);
+  EXPECT_FALSE(chain_->GetBlock(blocks.front()->hash));
+  EXPECT_TRUE(ReadFile(VERIFIED_HEAD_STORE).empty());
+}
+
+}  // namespace
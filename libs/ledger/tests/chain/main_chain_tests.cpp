@@ -29,10 +29,12 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <random>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 using namespace fetch;
@@ -691,6 +693,92 @@ TEST_P(MainChainTests, CheckChainPreceding)
   }
 }
 
+TEST_P(MainChainTests, CheckChainSkeleton)
+{
+  auto genesis = generator_->Generate();
+  auto main    = Generate(generator_, genesis, 20);
+
+  for (auto const &block : main)
+  {
+    ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*block));
+  }
+
+  // every 5th block from block 2, limited by the tip
+  auto skeleton = chain_->GetChainSkeleton(2, 5, 100);
+  ASSERT_EQ(skeleton.size(), 4);
+  EXPECT_EQ(skeleton[0], main[1]->hash);
+  EXPECT_EQ(skeleton[1], main[6]->hash);
+  EXPECT_EQ(skeleton[2], main[11]->hash);
+  EXPECT_EQ(skeleton[3], main[16]->hash);
+
+  // limited by the number of entries
+  skeleton = chain_->GetChainSkeleton(0, 4, 2);
+  ASSERT_EQ(skeleton.size(), 2);
+  EXPECT_EQ(skeleton[0], genesis->hash);
+  EXPECT_EQ(skeleton[1], main[3]->hash);
+
+  // the start is beyond the tip
+  EXPECT_TRUE(chain_->GetChainSkeleton(21, 5, 100).empty());
+  EXPECT_TRUE(chain_->GetChainSkeleton(0, 0, 100).empty());
+}
+
+TEST_P(MainChainTests, CheckPathToDeepCommonAncestor)
+{
+  auto genesis = generator_->Generate();
+  auto main    = Generate(generator_, genesis, 300);
+  auto fork    = Generate(generator_, main[99], 120);
+
+  for (auto const &blocks : {main, fork})
+  {
+    for (auto const &block : blocks)
+    {
+      ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*block));
+    }
+  }
+
+  // the skip ancestors are a power of two below each block
+  EXPECT_EQ(MainChain::GetSkipHeight(0), 0);
+  EXPECT_EQ(MainChain::GetSkipHeight(1), 0);
+  EXPECT_EQ(MainChain::GetSkipHeight(12), 8);
+  EXPECT_EQ(MainChain::GetSkipHeight(13), 1);
+  EXPECT_EQ(MainChain::GetSkipHeight(23), 17);
+  EXPECT_EQ(MainChain::GetSkipHeight(256), 0);
+
+  // the fork point is block 100 (main[99])
+  MainChain::Blocks path;
+  ASSERT_TRUE(chain_->GetPathToCommonAncestor(path, main.back()->hash, fork.back()->hash));
+  ASSERT_EQ(path.size(), 201);
+  EXPECT_EQ(path.front()->hash, main.back()->hash);
+  EXPECT_EQ(path.back()->hash, main[99]->hash);
+
+  ASSERT_TRUE(chain_->GetPathToCommonAncestor(path, fork.back()->hash, main[250]->hash));
+  ASSERT_EQ(path.size(), 121);
+  EXPECT_EQ(path.front()->hash, fork.back()->hash);
+  EXPECT_EQ(path.back()->hash, main[99]->hash);
+
+  // the node is an ancestor of the tip
+  ASSERT_TRUE(chain_->GetPathToCommonAncestor(path, main[200]->hash, main[10]->hash));
+  ASSERT_EQ(path.size(), 191);
+  EXPECT_EQ(path.back()->hash, main[10]->hash);
+
+  // limited paths, from either end
+  ASSERT_TRUE(chain_->GetPathToCommonAncestor(path, main.back()->hash, fork.back()->hash, 10,
+                                              MainChain::BehaviourWhenLimit::RETURN_MOST_RECENT));
+  ASSERT_EQ(path.size(), 10);
+  EXPECT_EQ(path.front()->hash, main.back()->hash);
+  EXPECT_EQ(path.back()->hash, main[290]->hash);
+
+  ASSERT_TRUE(chain_->GetPathToCommonAncestor(path, main.back()->hash, fork.back()->hash, 10,
+                                              MainChain::BehaviourWhenLimit::RETURN_LEAST_RECENT));
+  ASSERT_EQ(path.size(), 10);
+  EXPECT_EQ(path.front()->hash, main[108]->hash);
+  EXPECT_EQ(path.back()->hash, main[99]->hash);
+  for (std::size_t i = 1; i < path.size(); ++i)
+  {
+    EXPECT_EQ(path[i - 1]->previous_hash, path[i]->hash);
+  }
+}
+
 TEST_P(MainChainTests, CheckMissingLooseBlocks)
 {
   auto genesis = generator_->Generate();
@@ -928,6 +1016,120 @@ TEST_P(MainChainTests, CheckHeaviestChain)
   }
 }
 
+TEST_P(MainChainTests, CheckDuplicateTransactionDetection)
+{
+  using fetch::chain::TransactionLayout;
+
+  auto make_layout = [](uint8_t id) {
+    fetch::byte_array::ByteArray digest{};
+    digest.Resize(32);
+    for (std::size_t i = 0; i < digest.size(); ++i)
+    {
+      digest[i] = static_cast<uint8_t>(id + i);
+    }
+
+    return TransactionLayout{Digest{digest}, fetch::BitVector{1}, 1, 0, 1000};
+  };
+
+  auto const early_tx = make_layout(1);
+  auto const late_tx  = make_layout(2);
+  auto const fresh_tx = make_layout(3);
+
+  // build a chain long enough for the search to be split across multiple workers
+  BlockPtr previous = generator_->Generate();
+  for (std::size_t i = 1; i <= 600; ++i)
+  {
+    auto block = generator_->Generate(previous);
+
+    if (i == 5)
+    {
+      block->slices[0].push_back(early_tx);
+    }
+    else if (i == 550)
+    {
+      block->slices[1].push_back(late_tx);
+    }
+
+    ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*block));
+    previous = block;
+  }
+
+  auto const duplicates = chain_->DetectDuplicateTransactions(previous->hash,
+                                                              {early_tx, late_tx, fresh_tx});
+
+  EXPECT_EQ(2u, duplicates.size());
+  EXPECT_TRUE(Contains(duplicates, early_tx.digest()));
+  EXPECT_TRUE(Contains(duplicates, late_tx.digest()));
+  EXPECT_FALSE(Contains(duplicates, fresh_tx.digest()));
+}
+
+TEST_P(MainChainTests, CheckChainQueriesDuringUpdates)
+{
+  static constexpr std::size_t NUM_BLOCKS  = 200;
+  static constexpr std::size_t NUM_READERS = 2;
+
+  std::atomic<bool>        running{true};
+  std::atomic<std::size_t> inconsistent{0};
+
+  // continuously query the chain while it is being extended
+  auto reader = [this, &running, &inconsistent]() {
+    while (running)
+    {
+      auto const chain = chain_->GetHeaviestChain();
+      if (chain.empty() || !chain.back()->IsGenesis() ||
+          (chain.front()->block_number + 1u != chain.size()))
+      {
+        ++inconsistent;
+        continue;
+      }
+
+      for (std::size_t i = 1; i < chain.size(); ++i)
+      {
+        if (chain[i - 1]->previous_hash != chain[i]->hash)
+        {
+          ++inconsistent;
+          break;
+        }
+      }
+
+      auto const heaviest = chain_->GetHeaviestBlock();
+      if (!heaviest || !chain_->GetBlock(heaviest->hash))
+      {
+        ++inconsistent;
+      }
+    }
+  };
+
+  std::vector<std::thread> readers;
+  for (std::size_t i = 0; i < NUM_READERS; ++i)
+  {
+    readers.emplace_back(reader);
+  }
+
+  std::size_t num_added{0};
+  BlockPtr    previous = generator_->Generate();
+  for (std::size_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    auto block = generator_->Generate(previous);
+    if (BlockStatus::ADDED == chain_->AddBlock(*block))
+    {
+      ++num_added;
+    }
+    previous = block;
+  }
+
+  running = false;
+  for (auto &thread : readers)
+  {
+    thread.join();
+  }
+
+  ASSERT_EQ(NUM_BLOCKS, num_added);
+  EXPECT_EQ(0u, inconsistent.load());
+  EXPECT_EQ(previous->hash, chain_->GetHeaviestBlockHash());
+  EXPECT_EQ(NUM_BLOCKS + 1u, chain_->GetHeaviestChain().size());
+}
+
 INSTANTIATE_TEST_CASE_P(ParamBased, MainChainTests,
                         ::testing::Values(MainChain::Mode::CREATE_PERSISTENT_DB,
                                           MainChain::Mode::IN_MEMORY_DB), );
@@ -21,6 +21,8 @@
 #include "ledger/consensus/consensus_interface.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 
+#include <vector>
+
 class MockConsensus : public fetch::ledger::ConsensusInterface
 {
 public:
@@ -30,6 +32,7 @@ public:
   MOCK_METHOD1(UpdateCurrentBlock, void(Block const &));
   MOCK_METHOD0(GenerateNextBlock, NextBlockPtr());
   MOCK_CONST_METHOD1(ValidBlock, Status(Block const &));
+  MOCK_CONST_METHOD1(VerifyNotarisations, void(std::vector<Block const *> const &));
 
   MOCK_METHOD1(SetMaxCabinetSize, void(uint16_t));
   MOCK_METHOD1(SetBlockInterval, void(uint64_t));
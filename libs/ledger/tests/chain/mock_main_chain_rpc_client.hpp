@@ -30,4 +30,7 @@ public:
   MOCK_METHOD2(GetHeaviestChain, BlocksPromise(MuddleAddress, uint64_t));
   MOCK_METHOD4(GetCommonSubChain, BlocksPromise(MuddleAddress, Digest, Digest, uint64_t));
   MOCK_METHOD2(TimeTravel, TraveloguePromise(MuddleAddress, Digest));
+  MOCK_METHOD4(GetChainSkeleton, BlockHashesPromise(MuddleAddress, uint64_t, uint64_t, uint64_t));
+  MOCK_METHOD3(GetTransactionLayouts,
+               LayoutsPromise(MuddleAddress, Digest, fetch::ledger::BlockPositions));
 };
@@ -19,11 +19,14 @@
 #include "core/byte_array/byte_array.hpp"
 #include "core/macros.hpp"
 #include "core/random/lcg.hpp"
+#include "ledger/sharded_transaction_status_cache.hpp"
 #include "ledger/transaction_status_cache_impl.hpp"
 
 #include "gmock/gmock.h"
 
+#include <chrono>
 #include <memory>
+#include <thread>
 
 namespace {
 
@@ -57,10 +60,9 @@ ClockMock::time_point ClockMock::now() noexcept
   return mock->now();
 }
 
-using TransactionStatusCacheForTest = TransactionStatusCacheImpl<ClockMock>;
-using Clock                         = TransactionStatusCacheForTest::Clock;
-using Timepoint                     = TransactionStatusCacheForTest::Timepoint;
+using Timepoint = ClockMock::time_point;
 
+template <typename T>
 class TransactionStatusCacheTests : public ::testing::Test
 {
 protected:
@@ -69,7 +71,7 @@ protected:
     clock_mock_     = std::make_shared<ClockSystemClockMock>();
     ClockMock::mock = clock_mock_;
     EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(Timepoint::min()));
-    cache_ = std::make_shared<TransactionStatusCacheForTest>();
+    cache_ = std::make_shared<T>();
   }
 
   void TearDown() override
@@ -105,51 +107,55 @@ protected:
   std::shared_ptr<ClockSystemClockMock> clock_mock_{};
 };
 
-TEST_F(TransactionStatusCacheTests, CheckBasicUpdate)
+using CacheTypes = ::testing::Types<TransactionStatusCacheImpl<ClockMock>,
+                                    ShardedTransactionStatusCache<ClockMock>>;
+TYPED_TEST_CASE(TransactionStatusCacheTests, CacheTypes);
+
+TYPED_TEST(TransactionStatusCacheTests, CheckBasicUpdate)
 {
-  auto tx1 = GenerateDigest();
-  auto tx2 = GenerateDigest();
-  auto tx3 = GenerateDigest();
+  auto tx1 = this->GenerateDigest();
+  auto tx2 = this->GenerateDigest();
+  auto tx3 = this->GenerateDigest();
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(Timepoint::min()));
-  cache_->Update(tx1, TransactionStatus::SUBMITTED);
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(Timepoint::min()));
+  this->cache_->Update(tx1, TransactionStatus::SUBMITTED);
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(Timepoint::min()));
-  cache_->Update(tx2, TransactionStatus::PENDING);
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(Timepoint::min()));
+  this->cache_->Update(tx2, TransactionStatus::PENDING);
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(Timepoint::min()));
-  cache_->Update(tx3, TransactionStatus::MINED);
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(Timepoint::min()));
+  this->cache_->Update(tx3, TransactionStatus::MINED);
 
-  ASSERT_EQ(TransactionStatus::SUBMITTED, cache_->Query(tx1).status);
-  ASSERT_EQ(TransactionStatus::PENDING, cache_->Query(tx2).status);
-  ASSERT_EQ(TransactionStatus::MINED, cache_->Query(tx3).status);
+  ASSERT_EQ(TransactionStatus::SUBMITTED, this->cache_->Query(tx1).status);
+  ASSERT_EQ(TransactionStatus::PENDING, this->cache_->Query(tx2).status);
+  ASSERT_EQ(TransactionStatus::MINED, this->cache_->Query(tx3).status);
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(Timepoint::min()));
-  cache_->Update(tx1, TransactionStatus::PENDING);
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(Timepoint::min()));
+  this->cache_->Update(tx1, TransactionStatus::PENDING);
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(Timepoint::min()));
-  cache_->Update(tx2, TransactionStatus::MINED);
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(Timepoint::min()));
+  this->cache_->Update(tx2, TransactionStatus::MINED);
 
-  EXPECT_EQ(TransactionStatus::PENDING, cache_->Query(tx1).status);
-  EXPECT_EQ(TransactionStatus::MINED, cache_->Query(tx2).status);
-  EXPECT_EQ(TransactionStatus::MINED, cache_->Query(tx3).status);
+  EXPECT_EQ(TransactionStatus::PENDING, this->cache_->Query(tx1).status);
+  EXPECT_EQ(TransactionStatus::MINED, this->cache_->Query(tx2).status);
+  EXPECT_EQ(TransactionStatus::MINED, this->cache_->Query(tx3).status);
 }
 
-TEST_F(TransactionStatusCacheTests, CheckTxStatusUpdateFailsForExecutedStatus)
+TYPED_TEST(TransactionStatusCacheTests, CheckTxStatusUpdateFailsForExecutedStatus)
 {
-  auto tx1 = GenerateDigest();
+  auto tx1 = this->GenerateDigest();
 
   Timepoint start{ClockMock::time_point::min()};
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(start));
-  cache_->Update(tx1, TransactionStatus::PENDING);
-  ASSERT_EQ(TransactionStatus::PENDING, cache_->Query(tx1).status);
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(start));
+  this->cache_->Update(tx1, TransactionStatus::PENDING);
+  ASSERT_EQ(TransactionStatus::PENDING, this->cache_->Query(tx1).status);
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(start));
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(start));
   bool ex_thrown{false};
   try
   {
-    cache_->Update(tx1, TransactionStatus::EXECUTED);
+    this->cache_->Update(tx1, TransactionStatus::EXECUTED);
   }
   catch (std::exception const &ex)
   {
@@ -160,23 +166,23 @@ TEST_F(TransactionStatusCacheTests, CheckTxStatusUpdateFailsForExecutedStatus)
   EXPECT_TRUE(ex_thrown);
 }
 
-TEST_F(TransactionStatusCacheTests, CheckUpdateForContractExecutionResult)
+TYPED_TEST(TransactionStatusCacheTests, CheckUpdateForContractExecutionResult)
 {
-  auto tx1 = GenerateDigest();
+  auto tx1 = this->GenerateDigest();
 
   Timepoint start{ClockMock::time_point::min()};
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(start));
-  cache_->Update(tx1, TransactionStatus::PENDING);
-  ASSERT_EQ(TransactionStatus::PENDING, cache_->Query(tx1).status);
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(start));
+  this->cache_->Update(tx1, TransactionStatus::PENDING);
+  ASSERT_EQ(TransactionStatus::PENDING, this->cache_->Query(tx1).status);
 
   ContractExecutionResult const expected_result{
       ContractExecutionStatus::INEXPLICABLE_FAILURE, 1, 2, 3, 4, -2};
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(start));
-  cache_->Update(tx1, expected_result);
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(start));
+  this->cache_->Update(tx1, expected_result);
 
-  auto const received_result{cache_->Query(tx1)};
+  auto const received_result{this->cache_->Query(tx1)};
   EXPECT_EQ(TransactionStatus::EXECUTED, received_result.status);
   EXPECT_EQ(expected_result.status, received_result.contract_exec_result.status);
   EXPECT_EQ(expected_result.return_value, received_result.contract_exec_result.return_value);
@@ -186,31 +192,80 @@ TEST_F(TransactionStatusCacheTests, CheckUpdateForContractExecutionResult)
   EXPECT_EQ(expected_result.charge, received_result.contract_exec_result.charge);
 }
 
-TEST_F(TransactionStatusCacheTests, CheckPruning)
+TYPED_TEST(TransactionStatusCacheTests, CheckPruning)
 {
-  auto tx1 = GenerateDigest();
-  auto tx2 = GenerateDigest();
-  auto tx3 = GenerateDigest();
+  auto tx1 = this->GenerateDigest();
+  auto tx2 = this->GenerateDigest();
+  auto tx3 = this->GenerateDigest();
 
   Timepoint start{ClockMock::time_point::min()};
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(start));
-  cache_->Update(tx1, TransactionStatus::PENDING);
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(start));
+  this->cache_->Update(tx1, TransactionStatus::PENDING);
 
-  EXPECT_CALL(*clock_mock_, now()).WillOnce(Return(start));
-  cache_->Update(tx2, TransactionStatus::MINED);
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(start));
+  this->cache_->Update(tx2, TransactionStatus::MINED);
 
-  ASSERT_EQ(TransactionStatus::PENDING, cache_->Query(tx1).status);
-  ASSERT_EQ(TransactionStatus::MINED, cache_->Query(tx2).status);
+  ASSERT_EQ(TransactionStatus::PENDING, this->cache_->Query(tx1).status);
+  ASSERT_EQ(TransactionStatus::MINED, this->cache_->Query(tx2).status);
 
   Timepoint const future_time_point = start + std::chrono::hours{25};
 
-  EXPECT_CALL(*clock_mock_, now()).WillRepeatedly(Return(future_time_point));
-  cache_->Update(tx3, TransactionStatus::SUBMITTED);
+  EXPECT_CALL(*this->clock_mock_, now()).WillRepeatedly(Return(future_time_point));
+  this->cache_->Update(tx3, TransactionStatus::SUBMITTED);
+
+  EXPECT_EQ(TransactionStatus::UNKNOWN, this->cache_->Query(tx1).status);
+  EXPECT_EQ(TransactionStatus::UNKNOWN, this->cache_->Query(tx2).status);
+  EXPECT_EQ(TransactionStatus::SUBMITTED, this->cache_->Query(tx3).status);
+}
+
+TYPED_TEST(TransactionStatusCacheTests, CheckPruningRetainsRecentEntries)
+{
+  auto tx1 = this->GenerateDigest();
+  auto tx2 = this->GenerateDigest();
+  auto tx3 = this->GenerateDigest();
+
+  Timepoint start{ClockMock::time_point::min()};
+
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(start));
+  this->cache_->Update(tx1, TransactionStatus::PENDING);
+
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(start + std::chrono::hours{23}));
+  this->cache_->Update(tx2, TransactionStatus::PENDING);
+
+  ASSERT_EQ(TransactionStatus::PENDING, this->cache_->Query(tx1).status);
+  ASSERT_EQ(TransactionStatus::PENDING, this->cache_->Query(tx2).status);
+
+  EXPECT_CALL(*this->clock_mock_, now()).WillOnce(Return(start + std::chrono::hours{25}));
+  this->cache_->Update(tx3, TransactionStatus::SUBMITTED);
+
+  EXPECT_EQ(TransactionStatus::UNKNOWN, this->cache_->Query(tx1).status);
+  EXPECT_EQ(TransactionStatus::PENDING, this->cache_->Query(tx2).status);
+  EXPECT_EQ(TransactionStatus::SUBMITTED, this->cache_->Query(tx3).status);
+}
+
+TYPED_TEST(TransactionStatusCacheTests, CheckWaitForUpdate)
+{
+  auto tx = this->GenerateDigest();
+
+  auto const sequence = this->cache_->sequence();
+  EXPECT_FALSE(this->cache_->WaitForUpdate(sequence, std::chrono::milliseconds{10}));
+
+  EXPECT_CALL(*this->clock_mock_, now()).WillRepeatedly(Return(Timepoint::min()));
+
+  std::thread updater{[this, &tx]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    this->cache_->Update(tx, TransactionStatus::PENDING);
+  }};
+
+  EXPECT_TRUE(this->cache_->WaitForUpdate(sequence, std::chrono::seconds{10}));
+  updater.join();
+
+  EXPECT_EQ(TransactionStatus::PENDING, this->cache_->Query(tx).status);
+  EXPECT_NE(sequence, this->cache_->sequence());
 
-  EXPECT_EQ(TransactionStatus::UNKNOWN, cache_->Query(tx1).status);
-  EXPECT_EQ(TransactionStatus::UNKNOWN, cache_->Query(tx2).status);
-  EXPECT_EQ(TransactionStatus::SUBMITTED, cache_->Query(tx3).status);
+  // an update which has already happened is not waited for
+  EXPECT_TRUE(this->cache_->WaitForUpdate(sequence, std::chrono::milliseconds{0}));
 }
 
 }  // namespace
@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "core/bitvector.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chaincode/contract_context.hpp"
+#include "ledger/chaincode/contract_context_attacher.hpp"
+#include "ledger/chaincode/contract_query_executor.hpp"
+#include "ledger/chaincode/token_contract.hpp"
+#include "ledger/state_sentinel_adapter.hpp"
+#include "ledger/storage_unit/fake_storage_unit.hpp"
+#include "variant/variant.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::chain::Address;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::ContractContext;
+using fetch::ledger::ContractContextAttacher;
+using fetch::ledger::ContractQueryExecutor;
+using fetch::ledger::FakeStorageUnit;
+using fetch::ledger::StateSentinelAdapter;
+using fetch::ledger::TokenContract;
+using fetch::variant::Variant;
+
+class ContractQueryExecutorTests : public ::testing::Test
+{
+protected:
+  void SetBalance(Address const &address, uint64_t amount)
+  {
+    BitVector shards{1};
+    shards.SetAllOne();
+
+    TokenContract           token_contract{};
+    StateSentinelAdapter    adapter{storage_, "fetch.token", shards};
+    ContractContext         context{&token_contract, address, nullptr, &adapter, 0};
+    ContractContextAttacher raii(token_contract, context);
+    token_contract.AddTokens(address, amount);
+  }
+
+  ContractQueryExecutor::Status QueryBalance(Address const &address, Variant &response)
+  {
+    Variant request    = Variant::Object();
+    request["address"] = address.display();
+
+    return executor_.Execute("fetch.token", "balance", request, response);
+  }
+
+  FakeStorageUnit       storage_{};
+  ContractQueryExecutor executor_{storage_};
+};
+
+TEST_F(ContractQueryExecutorTests, QueriesReadTheState)
+{
+  Address const address{ECDSASigner{}.identity()};
+  SetBalance(address, 500);
+
+  Variant response;
+  ASSERT_EQ(ContractQueryExecutor::Status::OK, QueryBalance(address, response));
+  EXPECT_EQ("500", response["balance"].As<std::string>());
+}
+
+TEST_F(ContractQueryExecutorTests, InstancesAreReusedBetweenQueries)
+{
+  Address const address{ECDSASigner{}.identity()};
+
+  EXPECT_EQ(0, executor_.num_idle("fetch.token"));
+
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    Variant response;
+    EXPECT_EQ(ContractQueryExecutor::Status::OK, QueryBalance(address, response));
+    EXPECT_EQ(1, executor_.num_idle("fetch.token"));
+  }
+}
+
+TEST_F(ContractQueryExecutorTests, UnknownContractsAreNotFound)
+{
+  Address const address{ECDSASigner{}.identity()};
+
+  Variant response;
+  EXPECT_EQ(ContractQueryExecutor::Status::NOT_FOUND,
+            executor_.Execute(address.display(), "query", Variant::Object(), response));
+  EXPECT_EQ(0, executor_.num_idle(address.display()));
+}
+
+TEST_F(ContractQueryExecutorTests, FailedQueriesKeepTheirInstance)
+{
+  Variant response;
+  EXPECT_EQ(ContractQueryExecutor::Status::FAILED,
+            executor_.Execute("fetch.token", "balance", Variant::Object(), response));
+  EXPECT_EQ(1, executor_.num_idle("fetch.token"));
+}
+
+}  // namespace
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chaincode/executable_cache.hpp"
+#include "vm/generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::ledger::ExecutableCache;
+using fetch::vm::Executable;
+
+TEST(ExecutableCacheTests, CheckLookup)
+{
+  ExecutableCache cache{};
+
+  auto const           executable = std::make_shared<Executable>();
+  ConstByteArray const digest{"digest"};
+
+  EXPECT_FALSE(cache.Lookup(digest, false));
+
+  cache.Insert(digest, false, executable);
+  EXPECT_EQ(cache.Lookup(digest, false), executable);
+  EXPECT_EQ(cache.size(), 1);
+
+  // the optimised executable is cached independently
+  EXPECT_FALSE(cache.Lookup(digest, true));
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Lookup(digest, false));
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(ExecutableCacheTests, CheckLeastRecentlyUsedIsEvicted)
+{
+  ExecutableCache cache{2};
+
+  ConstByteArray const first{"first"};
+  ConstByteArray const second{"second"};
+  ConstByteArray const third{"third"};
+
+  cache.Insert(first, false, std::make_shared<Executable>());
+  cache.Insert(second, false, std::make_shared<Executable>());
+
+  // refresh the first entry so that the second one is evicted
+  EXPECT_TRUE(cache.Lookup(first, false));
+  cache.Insert(third, false, std::make_shared<Executable>());
+
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_TRUE(cache.Lookup(first, false));
+  EXPECT_FALSE(cache.Lookup(second, false));
+  EXPECT_TRUE(cache.Lookup(third, false));
+}
+
+TEST(ExecutableCacheTests, CheckDuplicateInsertKeepsTheOriginal)
+{
+  ExecutableCache cache{};
+
+  auto const           original = std::make_shared<Executable>();
+  ConstByteArray const digest{"digest"};
+
+  cache.Insert(digest, false, original);
+  cache.Insert(digest, false, std::make_shared<Executable>());
+
+  EXPECT_EQ(cache.Lookup(digest, false), original);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(ExecutableCacheTests, CheckExecutablesArePersisted)
+{
+  std::string const    doc_file{"executable_cache_tests.db"};
+  std::string const    index_file{"executable_cache_tests.index.db"};
+  std::string const    layout{"layout"};
+  ConstByteArray const digest{"digest"};
+
+  auto executable = std::make_shared<Executable>("persisted", 0);
+  executable->strings.emplace_back("value");
+
+  {
+    ExecutableCache cache{};
+    EXPECT_FALSE(cache.IsPersistent());
+    EXPECT_FALSE(cache.Restore(digest, false, layout));
+
+    cache.Load(doc_file, index_file);
+    EXPECT_TRUE(cache.IsPersistent());
+    cache.Persist(digest, false, layout, executable);
+  }
+
+  // a new cache can restore the executable
+  ExecutableCache cache{};
+  cache.Load(doc_file, index_file);
+
+  auto const restored = cache.Restore(digest, false, layout);
+  ASSERT_TRUE(restored);
+  EXPECT_EQ(restored->name, executable->name);
+  EXPECT_EQ(restored->strings, executable->strings);
+  EXPECT_EQ(cache.Lookup(digest, false), restored);
+
+  // but only for the same options and VM layout
+  EXPECT_FALSE(cache.Restore(digest, true, layout));
+  EXPECT_FALSE(cache.Restore(digest, false, "other layout"));
+}
+
+}  // namespace
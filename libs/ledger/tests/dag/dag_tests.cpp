@@ -22,12 +22,14 @@
 #include "crypto/sha256.hpp"
 #include "ledger/dag/dag.hpp"
 #include "ledger/dag/dag_interface.hpp"
+#include "ledger/dag/dag_sync_protocol.hpp"
 
 #include "gmock/gmock.h"
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <random>
 #include <string>
@@ -244,6 +246,39 @@ TEST_F(DagTests, CheckDagMaintainsTipsCorrectly)
   ASSERT_EQ(epoch_2.all_nodes.size(), nodes_to_push);
 }
 
+// Check that a shuffled batch of nodes is added in full and produces the same epoch
+TEST_F(DagTests, CheckDagAddsShuffledBatches)
+{
+  const std::size_t nodes_to_push = 500;
+
+  DAG dag_2 = MakeDAG("dag2", false);
+
+  for (std::size_t dag_node_index = 0; dag_node_index < nodes_to_push; ++dag_node_index)
+  {
+    dag_->AddArbitrary("A:" + std::to_string(dag_node_index));
+  }
+
+  auto recently_added = dag_->GetRecentlyAdded();
+
+  std::mt19937 g(42);
+  std::shuffle(recently_added.begin(), recently_added.end(), g);
+
+  EXPECT_EQ(dag_2->AddDAGNodes(recently_added), nodes_to_push);
+
+  // re-adding the same batch is a no-op
+  EXPECT_EQ(dag_2->AddDAGNodes(recently_added), 0);
+
+  auto epoch_1 = dag_->CreateEpoch(1);
+  ASSERT_EQ(epoch_1.all_nodes.size(), nodes_to_push);
+  ASSERT_EQ(dag_2->SatisfyEpoch(epoch_1), true);
+
+  auto epoch_2 = dag_2->CreateEpoch(1);
+  EXPECT_EQ(epoch_2.all_nodes, epoch_1.all_nodes);
+
+  ASSERT_EQ(dag_->CommitEpoch(epoch_1), true);
+  ASSERT_EQ(dag_2->CommitEpoch(epoch_1), true);
+}
+
 // Check has epoch functionality
 TEST_F(DagTests, CheckBasicDagFunctionality___CheckHasEpochWorks)
 {
@@ -287,3 +322,83 @@ TEST_F(DagTests, CheckDagGetNode)
   EXPECT_EQ(dag_->GetDAGNode(dag_nodes.back().hash, dummy), true);
   EXPECT_EQ(dag_->GetDAGNode(dummy_hash, dummy), false);
 }
+
+// Check that only the nodes missing from a peer's summary are provided to it
+TEST_F(DagTests, CheckDagProvidesNodesMissingFromSummary)
+{
+  const std::size_t nodes_to_push = 100;
+
+  DAG dag_2 = MakeDAG("dag2", false);
+
+  // the first epoch is committed on the first dag only
+  for (std::size_t dag_node_index = 0; dag_node_index < nodes_to_push; ++dag_node_index)
+  {
+    dag_->AddArbitrary("A:" + std::to_string(dag_node_index));
+  }
+
+  auto epoch_1 = dag_->CreateEpoch(1);
+  ASSERT_EQ(dag_->CommitEpoch(epoch_1), true);
+  dag_->GetRecentlyAdded();
+
+  // the second dag has seen half of the nodes added since
+  for (std::size_t dag_node_index = 0; dag_node_index < nodes_to_push; ++dag_node_index)
+  {
+    dag_->AddArbitrary("B:" + std::to_string(dag_node_index));
+  }
+
+  auto recently_added = dag_->GetRecentlyAdded();
+  ASSERT_EQ(recently_added.size(), nodes_to_push);
+  recently_added.resize(nodes_to_push / 2);
+  dag_2->AddDAGNodes(recently_added);
+
+  // the delta is bounded by the requested size
+  auto const summary = dag_2->GetSyncSummary();
+  EXPECT_EQ(summary.epoch, 0);
+  EXPECT_EQ(dag_->GetNodesMissingFrom(summary, 10).size(), 10);
+
+  // the nodes of the epoch are provided along with the nodes which have not been seen
+  auto const delta = dag_->GetNodesMissingFrom(summary, 1000);
+  EXPECT_EQ(delta.size(), nodes_to_push + (nodes_to_push / 2));
+
+  dag_2->AddDAGNodes(delta);
+  ASSERT_EQ(dag_2->SatisfyEpoch(epoch_1), true);
+  ASSERT_EQ(dag_2->CommitEpoch(epoch_1), true);
+
+  // once in sync there is nothing more to provide in either direction
+  EXPECT_TRUE(dag_->GetNodesMissingFrom(dag_2->GetSyncSummary(), 1000).empty());
+  EXPECT_TRUE(dag_2->GetNodesMissingFrom(dag_->GetSyncSummary(), 1000).empty());
+}
+
+// Check that the delta replies survive compression and that malformed ones are rejected
+TEST_F(DagTests, CheckDagDeltaCompression)
+{
+  using Protocol = ledger::DAGSyncProtocol;
+
+  PopulateDAG();
+
+  auto const delta = dag_->GetNodesMissingFrom(MakeDAG("dag2", false)->GetSyncSummary(), 1000);
+  ASSERT_FALSE(delta.empty());
+
+  ledger::DAG::MissingNodes const nodes(delta.begin(), delta.end());
+
+  auto const compressed = Protocol::CompressNodes(nodes);
+
+  ledger::DAG::MissingNodes decompressed{};
+  ASSERT_TRUE(Protocol::DecompressNodes(compressed, decompressed));
+  EXPECT_EQ(decompressed.size(), nodes.size());
+  EXPECT_TRUE(std::equal(nodes.begin(), nodes.end(), decompressed.begin(),
+                         [](ledger::DAGNode const &a, ledger::DAGNode const &b) {
+                           return a.hash == b.hash;
+                         }));
+
+  // truncated replies are rejected
+  EXPECT_FALSE(Protocol::DecompressNodes(compressed.SubArray(0, 2), decompressed));
+  EXPECT_FALSE(
+      Protocol::DecompressNodes(compressed.SubArray(0, compressed.size() / 2), decompressed));
+
+  // as are replies claiming to be larger than can be decompressed
+  byte_array::ByteArray oversized{compressed.Copy()};
+  uint32_t const        size = Protocol::MAX_DELTA_DECOMPRESSED_SIZE + 1u;
+  std::memcpy(oversized.pointer(), &size, sizeof(size));
+  EXPECT_FALSE(Protocol::DecompressNodes(oversized, decompressed));
+}
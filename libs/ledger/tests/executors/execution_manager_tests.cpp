@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "block_configs.hpp"
+#include "chain/block_version.hpp"
 #include "ledger/chaincode/contract_context.hpp"
 #include "ledger/execution_manager.hpp"
 #include "ledger/transaction_status_cache.hpp"
@@ -27,8 +28,10 @@
 #include "gmock/gmock.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -36,6 +39,45 @@ namespace {
 
 using namespace fetch::ledger;
 
+// Increments a shared counter without any locking, so that two executions which overlap in time
+// lose an update
+class CollidingExecutor : public FakeExecutor
+{
+public:
+  struct Counter
+  {
+    std::atomic<uint64_t> value{0};
+    std::atomic<uint64_t> active{0};
+    std::atomic<bool>     collided{false};
+  };
+
+  using CounterPtr = std::shared_ptr<Counter>;
+
+  explicit CollidingExecutor(CounterPtr counter)
+    : counter_{std::move(counter)}
+  {}
+
+  Result Execute(Digest const &digest, BlockIndex block, SliceIndex slice,
+                 BitVector const &shards) override
+  {
+    if (counter_->active++ != 0)
+    {
+      counter_->collided = true;
+    }
+
+    uint64_t const value = counter_->value.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    counter_->value = value + 1;
+
+    --counter_->active;
+
+    return FakeExecutor::Execute(digest, block, slice, shards);
+  }
+
+private:
+  CounterPtr counter_;
+};
+
 class ExecutionManagerTests : public ::testing::TestWithParam<BlockConfig>
 {
 protected:
@@ -56,9 +98,16 @@ protected:
     executors_.clear();
 
     // create the manager
-    manager_ =
-        std::make_shared<ExecutionManager>(config.executors, config.log2_lanes, mock_storage_,
-                                           [this]() { return CreateExecutor(); }, tx_status_cache_);
+    manager_ = std::make_shared<ExecutionManager>(
+        config.executors, config.log2_lanes, mock_storage_,
+        [this](ExecutionManager::StorageUnitPtr const &) { return CreateExecutor(); },
+        tx_status_cache_);
+  }
+
+  void TearDown() override
+  {
+    fetch::chain::SetActivationHeight(fetch::chain::BlockVersion::OBSERVED_LANE_PACKING,
+                                      fetch::chain::NEVER_ACTIVATED);
   }
 
   bool IsManagerIdle() const
@@ -186,6 +235,147 @@ TEST_P(ExecutionManagerTests, DISABLED_CheckIncrementalExecution)
   manager_->Stop();
 }
 
+TEST_P(ExecutionManagerTests, CheckOptimisticExecution)
+{
+  BlockConfig const &config = GetParam();
+
+  // generate a block with the desired lane and slice configuration
+  auto block = TestBlock::Generate(config.log2_lanes, config.slices, __LINE__);
+
+  EXPECT_GT(block.num_transactions, 0);
+
+  // speculative executors record their state changes against the speculative storage
+  manager_->EnableOptimisticExecution([this](ExecutionManager::StorageUnitPtr storage) {
+    auto executor = CreateExecutor();
+    executor->SetStorageInterface(*storage);
+    return executor;
+  });
+  ASSERT_TRUE(manager_->IsOptimisticExecutionEnabled());
+
+  // start the execution manager
+  manager_->Start();
+
+  // execute the block
+  ASSERT_EQ(manager_->Execute(block.block), ExecutionManager::ScheduleStatus::SCHEDULED);
+
+  // wait for the manager to become idle again
+  ASSERT_TRUE(WaitUntilExecutionComplete(static_cast<std::size_t>(block.num_transactions)));
+  ASSERT_EQ(GetNumExecutedTransaction(), block.num_transactions);
+
+  // all the speculative writes must have been committed to the underlying storage
+  for (auto const &slice : block.block.slices)
+  {
+    for (auto const &tx : slice)
+    {
+      auto const document =
+          mock_storage_->GetFake().Get(fetch::storage::ResourceAddress{tx.digest()});
+      EXPECT_FALSE(document.failed);
+    }
+  }
+
+  manager_->Stop();
+}
+
+TEST_P(ExecutionManagerTests, CheckPreExecution)
+{
+  BlockConfig const &config = GetParam();
+
+  fetch::Digest const digest{std::string(32, 'a')};
+  auto const          key = fetch::storage::ResourceAddress{digest};
+
+  fetch::BitVector shards{std::size_t{1} << config.log2_lanes};
+  shards.SetAllOne();
+
+  fetch::BitVector lanes{};
+  EXPECT_FALSE(manager_->PreExecute(digest, shards, lanes));
+
+  manager_->EnablePreExecution([this](ExecutionManager::StorageUnitPtr storage) {
+    auto executor = CreateExecutor();
+    executor->SetStorageInterface(*storage);
+    return executor;
+  });
+  ASSERT_TRUE(manager_->IsPreExecutionEnabled());
+
+  // pre-execution only takes place once the manager is running
+  EXPECT_FALSE(manager_->PreExecute(digest, shards, lanes));
+
+  manager_->Start();
+
+  // nor until the next block is of the version which packs observed lanes
+  EXPECT_FALSE(manager_->PreExecute(digest, shards, lanes));
+
+  fetch::chain::SetActivationHeight(fetch::chain::BlockVersion::OBSERVED_LANE_PACKING, 1);
+
+  // the fake executor only writes the resource for the transaction digest
+  ASSERT_TRUE(manager_->PreExecute(digest, shards, lanes));
+  EXPECT_EQ(lanes.PopCount(), 1u);
+  EXPECT_EQ(lanes.bit(key.lane(config.log2_lanes)), 1u);
+
+  // the observed lanes never exceed the declared shards
+  if (shards.size() > 1)
+  {
+    fetch::BitVector other{shards.size()};
+    other.set((key.lane(config.log2_lanes) + 1) % shards.size(), 1);
+    ASSERT_TRUE(manager_->PreExecute(digest, other, lanes));
+    EXPECT_EQ(lanes.PopCount(), 0u);
+  }
+
+  // none of the writes are ever applied
+  EXPECT_TRUE(mock_storage_->GetFake().Get(key).failed);
+  EXPECT_EQ(GetNumExecutedTransaction(), (shards.size() > 1) ? 2u : 1u);
+
+  manager_->Stop();
+}
+
+TEST_P(ExecutionManagerTests, CheckOverlappingTransactionsInASliceAreSerialised)
+{
+  BlockConfig const &config    = GetParam();
+  std::size_t const  num_lanes = std::size_t{1} << config.log2_lanes;
+
+  // the transactions must be dispatched to different threads in order to collide
+  if (num_lanes < 2)
+  {
+    return;
+  }
+
+  // the first transaction uses lanes 0 and 1, and the second only lane 1. Since they are dispatched
+  // by their first lane they would otherwise be executed concurrently
+  fetch::BitVector first{num_lanes};
+  first.set(0, 1);
+  first.set(1, 1);
+
+  fetch::BitVector second{num_lanes};
+  second.set(1, 1);
+
+  fetch::chain::SetActivationHeight(fetch::chain::BlockVersion::OBSERVED_LANE_PACKING, 0);
+
+  Block block{};
+  block.slices.resize(1);
+  block.slices[0].emplace_back(
+      fetch::chain::TransactionLayout{fetch::Digest{std::string(32, 'a')}, first, 1, 0, 100});
+  block.slices[0].emplace_back(
+      fetch::chain::TransactionLayout{fetch::Digest{std::string(32, 'b')}, second, 1, 0, 100});
+
+  auto const counter = std::make_shared<CollidingExecutor::Counter>();
+  manager_           = std::make_shared<ExecutionManager>(
+      config.executors, config.log2_lanes, mock_storage_,
+      [counter](ExecutionManager::StorageUnitPtr const &) {
+        return std::make_shared<CollidingExecutor>(counter);
+      },
+      tx_status_cache_);
+
+  manager_->Start();
+
+  ASSERT_EQ(manager_->Execute(block), ExecutionManager::ScheduleStatus::SCHEDULED);
+  ASSERT_TRUE(WaitUntilExecutionComplete(2));
+
+  // neither of the updates is lost
+  EXPECT_FALSE(counter->collided);
+  EXPECT_EQ(counter->value, 2u);
+
+  manager_->Stop();
+}
+
 INSTANTIATE_TEST_CASE_P(Param, ExecutionManagerTests,
                         ::testing::ValuesIn(BlockConfig::REDUCED_SET), );
 
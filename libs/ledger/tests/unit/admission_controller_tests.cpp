@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/admission_controller.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using fetch::chain::Address;
+using fetch::chain::Transaction;
+using fetch::chain::TransactionBuilder;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::AdmissionController;
+
+using TransactionPtr = TransactionBuilder::TransactionPtr;
+
+class AdmissionControllerTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    controller_.AddStage("test", [this]() { return load_; });
+  }
+
+  TransactionPtr CreateTransaction(uint64_t charge_rate)
+  {
+    return TransactionBuilder{}
+        .From(Address{signer_.identity()})
+        .Transfer(Address{signer_.identity()}, 1)
+        .ValidUntil(100)
+        .Signer(signer_.identity())
+        .ChargeRate(charge_rate)
+        .ChargeLimit(1)
+        .Seal()
+        .Sign(signer_)
+        .Build();
+  }
+
+  std::size_t CountAdmitted(Transaction const &tx, std::size_t count)
+  {
+    std::size_t admitted{0};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if (controller_.Admit(tx))
+      {
+        ++admitted;
+      }
+    }
+
+    return admitted;
+  }
+
+  ECDSASigner         signer_{};
+  double              load_{0.0};
+  AdmissionController controller_{0.5};
+};
+
+TEST_F(AdmissionControllerTests, EverythingIsAdmittedBelowTheThreshold)
+{
+  load_ = 0.25;
+
+  auto const tx = CreateTransaction(1);
+  EXPECT_EQ(CountAdmitted(*tx, 100), 100u);
+}
+
+TEST_F(AdmissionControllerTests, NothingIsAdmittedWhenFull)
+{
+  load_ = 1.0;
+
+  auto const tx = CreateTransaction(1000);
+  EXPECT_EQ(CountAdmitted(*tx, 100), 0u);
+}
+
+TEST_F(AdmissionControllerTests, TransactionsPayingTheSameAreShedInProportion)
+{
+  auto const tx = CreateTransaction(1);
+  CountAdmitted(*tx, 10);
+
+  // half way between the threshold and full, half of the capacity is spare
+  load_ = 0.75;
+  EXPECT_EQ(CountAdmitted(*tx, 100), 50u);
+}
+
+TEST_F(AdmissionControllerTests, HigherFeesArePreferredUnderLoad)
+{
+  auto const low  = CreateTransaction(1);
+  auto const high = CreateTransaction(10);
+
+  // establish a history of mostly low fee transactions
+  CountAdmitted(*low, 90);
+  CountAdmitted(*high, 10);
+
+  // most of the capacity is in use, only a quarter of the low fee transactions are admitted
+  load_ = 0.875;
+  EXPECT_EQ(CountAdmitted(*high, 10), 10u);
+  EXPECT_EQ(CountAdmitted(*low, 10), 2u);
+}
+
+TEST_F(AdmissionControllerTests, RetryAfterGrowsWithTheLoad)
+{
+  load_ = 0.0;
+  EXPECT_EQ(controller_.GetRetryAfter(), std::chrono::seconds{1});
+
+  load_ = 1.0;
+  EXPECT_EQ(controller_.GetRetryAfter(),
+            std::chrono::seconds{AdmissionController::MAX_RETRY_AFTER_SECONDS});
+}
+
+}  // namespace
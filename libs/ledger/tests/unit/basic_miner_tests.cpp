@@ -28,6 +28,7 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
@@ -240,4 +241,113 @@ TEST_P(BasicMinerTests, RejectReplayedTransactions)
   }
 }
 
+TEST_P(BasicMinerTests, RefinementDoesNotReduceUtilisation)
+{
+  std::size_t const num_tx = GetParam();
+
+  BasicMiner greedy_miner{uint32_t{LOG2_NUM_LANES}, BasicMiner::Duration{0}};
+
+  // populate both miners with the same set of transactions
+  std::poisson_distribution<uint32_t> dist(5.0);
+  for (std::size_t i = 0; i < num_tx; ++i)
+  {
+    auto tx = generator_(dist(rng_));
+
+    miner_->EnqueueTransaction(tx);
+    greedy_miner.EnqueueTransaction(tx);
+  }
+
+  MainChain chain{MainChain::Mode::IN_MEMORY_DB};
+
+  auto const generate = [&chain](BasicMiner &miner) {
+    Block block;
+    block.previous_hash = chain.GetHeaviestBlockHash();
+    miner.GenerateBlock(block, NUM_LANES, NUM_SLICES, chain);
+    return block;
+  };
+
+  auto const occupancy = [](Block::Slice const &slice) {
+    BitVector lanes{NUM_LANES};
+    for (auto const &tx : slice)
+    {
+      // ensure there are not collisions
+      EXPECT_EQ(0, (lanes & tx.mask()).PopCount());
+      lanes |= tx.mask();
+    }
+    return lanes.PopCount();
+  };
+
+  Block const refined = generate(*miner_);
+  Block const greedy  = generate(greedy_miner);
+
+  ASSERT_EQ(refined.slices.size(), greedy.slices.size());
+
+  // both miners start from the same greedy packing for the first slice
+  EXPECT_GE(occupancy(refined.slices[0]), occupancy(greedy.slices[0]));
+
+  // no transaction should be lost or duplicated during the refinement
+  DigestSet packed{};
+  for (auto const &slice : refined.slices)
+  {
+    occupancy(slice);
+
+    for (auto const &tx : slice)
+    {
+      EXPECT_TRUE(packed.insert(tx.digest()).second);
+    }
+  }
+
+  EXPECT_EQ(num_tx, packed.size() + miner_->GetBacklog());
+}
+
+TEST_P(BasicMinerTests, ObservedLanesPackDenserSlices)
+{
+  std::size_t const num_tx = GetParam();
+
+  // every transaction declares all of the lanes, but is observed to only use a single one
+  BitVector all_lanes{NUM_LANES};
+  all_lanes.SetAllOne();
+
+  for (std::size_t i = 0; i < num_tx; ++i)
+  {
+    miner_->EnqueueTransaction(TransactionLayout{generator_(0).digest(), all_lanes, 1, 0, 1000});
+  }
+
+  auto const unobserved = miner_->GetUnobservedTransactions(num_tx);
+  ASSERT_EQ(num_tx, unobserved.size());
+
+  for (std::size_t i = 0; i < unobserved.size(); ++i)
+  {
+    BitVector lanes{NUM_LANES};
+    lanes.set(i % NUM_LANES, 1);
+
+    miner_->SetObservedLanes(unobserved[i].digest(), lanes);
+  }
+
+  EXPECT_TRUE(miner_->GetUnobservedTransactions(num_tx).empty());
+
+  MainChain chain{MainChain::Mode::IN_MEMORY_DB};
+
+  Block block;
+  block.previous_hash = chain.GetHeaviestBlockHash();
+  miner_->GenerateBlock(block, NUM_LANES, NUM_SLICES, chain);
+
+  // the first slice is filled using the observed lanes rather than one transaction per slice
+  ASSERT_FALSE(block.slices.empty());
+  EXPECT_EQ(std::min<std::size_t>(num_tx, NUM_LANES), block.slices[0].size());
+
+  // the declared masks are unchanged in the block
+  std::size_t packed{0};
+  for (auto const &slice : block.slices)
+  {
+    for (auto const &tx : slice)
+    {
+      EXPECT_EQ(all_lanes, tx.mask());
+      ++packed;
+    }
+  }
+
+  EXPECT_EQ(num_tx, packed);
+}
+
 INSTANTIATE_TEST_CASE_P(ParamBased, BasicMinerTests, ::testing::Values(10, 20), );
@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_cache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+using fetch::ledger::Block;
+using fetch::ledger::BlockCache;
+using BlockPtr  = BlockCache::BlockPtr;
+using BlockHash = BlockCache::BlockHash;
+
+BlockPtr MakeBlock(uint64_t block_number, std::size_t num_transactions = 0)
+{
+  auto block          = std::make_shared<Block>();
+  block->block_number = block_number;
+  block->slices.resize(1);
+  block->slices[0].resize(num_transactions);
+  block->UpdateDigest();
+
+  return block;
+}
+
+TEST(BlockCacheTests, CheckBlocksAreFoundByHash)
+{
+  BlockCache cache;
+
+  auto const block = MakeBlock(1);
+  auto const next  = MakeBlock(2);
+  cache.Add(block, next->hash);
+
+  BlockPtr  found{};
+  BlockHash next_hash{};
+  ASSERT_TRUE(cache.Get(block->hash, found, next_hash));
+  EXPECT_EQ(block, found);
+  EXPECT_EQ(next->hash, next_hash);
+  EXPECT_FALSE(cache.Get(next->hash, found, next_hash));
+}
+
+TEST(BlockCacheTests, CheckLeastRecentlyUsedBlockIsEvicted)
+{
+  auto const first  = MakeBlock(1);
+  auto const second = MakeBlock(2);
+  auto const third  = MakeBlock(3);
+
+  BlockCache cache{2 * BlockCache::EstimateSize(*first)};
+  cache.Add(first, {});
+  cache.Add(second, {});
+
+  // use the first block so that the second becomes the least recently used
+  BlockPtr  found{};
+  BlockHash next_hash{};
+  ASSERT_TRUE(cache.Get(first->hash, found, next_hash));
+
+  cache.Add(third, {});
+
+  EXPECT_TRUE(cache.Get(first->hash, found, next_hash));
+  EXPECT_FALSE(cache.Get(second->hash, found, next_hash));
+  EXPECT_TRUE(cache.Get(third->hash, found, next_hash));
+  EXPECT_LE(cache.size_in_bytes(), cache.capacity());
+}
+
+TEST(BlockCacheTests, CheckBlocksLargerThanTheCacheAreNotAdded)
+{
+  auto const small = MakeBlock(1);
+  auto const large = MakeBlock(2, 1000);
+
+  BlockCache cache{BlockCache::EstimateSize(*small)};
+  cache.Add(small, {});
+  cache.Add(large, {});
+
+  BlockPtr  found{};
+  BlockHash next_hash{};
+  EXPECT_TRUE(cache.Get(small->hash, found, next_hash));
+  EXPECT_FALSE(cache.Get(large->hash, found, next_hash));
+}
+
+TEST(BlockCacheTests, CheckReducingCapacityEvictsBlocks)
+{
+  BlockCache cache;
+
+  auto const block = MakeBlock(1);
+  cache.Add(block, {});
+
+  EXPECT_EQ(BlockCache::EstimateSize(*block), cache.size_in_bytes());
+
+  cache.SetCapacity(0);
+
+  BlockPtr  found{};
+  BlockHash next_hash{};
+  EXPECT_EQ(0, cache.size_in_bytes());
+  EXPECT_FALSE(cache.Get(block->hash, found, next_hash));
+}
+
+}  // namespace
@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "ledger/chain/block_height_index.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+using fetch::ledger::BlockHeightIndex;
+using BlockHash = BlockHeightIndex::BlockHash;
+
+constexpr char const *INDEX_FILE = "block_height_index_tests.db";
+
+BlockHash MakeHash(uint8_t value)
+{
+  fetch::byte_array::ByteArray hash;
+  hash.Resize(fetch::chain::HASH_SIZE);
+  for (std::size_t i = 0; i < hash.size(); ++i)
+  {
+    hash[i] = value;
+  }
+
+  return {hash};
+}
+
+class BlockHeightIndexTests : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    std::remove(INDEX_FILE);
+  }
+
+  BlockHeightIndex index_;
+};
+
+TEST_F(BlockHeightIndexTests, CheckLookupByHeight)
+{
+  index_.New(INDEX_FILE);
+
+  for (uint8_t height = 0; height < 10; ++height)
+  {
+    index_.Set(height, MakeHash(static_cast<uint8_t>(height + 1)));
+  }
+
+  EXPECT_EQ(10, index_.size());
+
+  BlockHash hash{};
+  ASSERT_TRUE(index_.Get(7, hash));
+  EXPECT_EQ(MakeHash(8), hash);
+  EXPECT_FALSE(index_.Get(10, hash));
+}
+
+TEST_F(BlockHeightIndexTests, CheckHeightsAreMissingUntilWritten)
+{
+  index_.New(INDEX_FILE);
+  index_.Set(5, MakeHash(6));
+
+  BlockHash hash{};
+  EXPECT_EQ(6, index_.size());
+  EXPECT_FALSE(index_.Get(2, hash));
+  EXPECT_TRUE(index_.Get(5, hash));
+}
+
+TEST_F(BlockHeightIndexTests, CheckTruncateDiscardsHigherBlocks)
+{
+  index_.New(INDEX_FILE);
+  index_.Set(0, MakeHash(1));
+  index_.Set(1, MakeHash(2));
+  index_.Set(2, MakeHash(3));
+
+  index_.Truncate(2);
+
+  BlockHash hash{};
+  EXPECT_EQ(2, index_.size());
+  EXPECT_TRUE(index_.Get(1, hash));
+  EXPECT_FALSE(index_.Get(2, hash));
+}
+
+TEST_F(BlockHeightIndexTests, CheckIndexIsRecoveredFromFile)
+{
+  index_.New(INDEX_FILE);
+  index_.Set(0, MakeHash(1));
+  index_.Set(1, MakeHash(2));
+  index_.Flush();
+
+  BlockHeightIndex recovered;
+  recovered.Load(INDEX_FILE);
+
+  BlockHash hash{};
+  EXPECT_EQ(2, recovered.size());
+  ASSERT_TRUE(recovered.Get(1, hash));
+  EXPECT_EQ(MakeHash(2), hash);
+}
+
+}  // namespace
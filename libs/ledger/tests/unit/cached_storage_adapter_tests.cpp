@@ -29,7 +29,9 @@ using fetch::ledger::StorageInterface;
 using fetch::storage::ResourceAddress;
 using fetch::storage::Document;
 
+using testing::_;
 using testing::Return;
+using testing::UnorderedElementsAre;
 
 class MockStorage : public StorageInterface
 {
@@ -37,6 +39,7 @@ public:
   MOCK_CONST_METHOD1(Get, Document(ResourceAddress const &));
   MOCK_METHOD1(GetOrCreate, Document(ResourceAddress const &));
   MOCK_METHOD2(Set, void(ResourceAddress const &, StateValue const &));
+  MOCK_METHOD2(SetBatch, void(ResourceAddresses const &, StateValues const &));
   MOCK_METHOD1(Lock, bool(ShardIndex));
   MOCK_METHOD1(Unlock, bool(ShardIndex));
   MOCK_METHOD0(Reset, void());
@@ -99,4 +102,41 @@ TEST_F(CachedStorageAdapterTests, Get_does_not_cache_result_if_retrieval_from_st
   cached_storage_adapter.Get(key);
 }
 
+TEST_F(CachedStorageAdapterTests, GetBatch_only_retrieves_keys_which_are_not_cached)
+{
+  ResourceAddress const other_key{"other_key"};
+
+  Document doc;
+  doc.failed = false;
+
+  EXPECT_CALL(mock_storage, Get(key)).WillOnce(Return(doc));
+  EXPECT_CALL(mock_storage, Get(other_key)).WillOnce(Return(doc));
+
+  cached_storage_adapter.Get(key);
+
+  auto const documents = cached_storage_adapter.GetBatch({key, other_key});
+  ASSERT_EQ(documents.size(), 2);
+  EXPECT_FALSE(documents[0].failed);
+  EXPECT_FALSE(documents[1].failed);
+
+  // both of the keys are now cached
+  cached_storage_adapter.GetBatch({other_key, key});
+}
+
+TEST_F(CachedStorageAdapterTests, Flush_writes_modified_entries_as_a_single_batch)
+{
+  ResourceAddress const other_key{"other_key"};
+
+  cached_storage_adapter.Set(key, "value");
+  cached_storage_adapter.Set(other_key, "other value");
+
+  EXPECT_CALL(mock_storage, Set(_, _)).Times(0);
+  EXPECT_CALL(mock_storage, SetBatch(UnorderedElementsAre(key, other_key), _)).Times(1);
+  cached_storage_adapter.Flush();
+
+  // only entries modified since the last flush are written
+  EXPECT_CALL(mock_storage, SetBatch(_, _)).Times(0);
+  cached_storage_adapter.Flush();
+}
+
 }  // namespace
@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/compact_block.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::chain::TransactionLayout;
+using fetch::ledger::Block;
+using fetch::ledger::BlockPositions;
+using fetch::ledger::CompactBlock;
+using fetch::ledger::ShortIdIndex;
+using fetch::ledger::ShortTransactionId;
+using fetch::ledger::ToShortId;
+using fetch::ledger::TransactionLayouts;
+
+TransactionLayout MakeLayout(uint8_t value)
+{
+  fetch::byte_array::ByteArray digest;
+  digest.Resize(32);
+  for (std::size_t i = 0; i < digest.size(); ++i)
+  {
+    digest[i] = static_cast<uint8_t>(value + i);
+  }
+
+  BitVector mask{4};
+  mask.set(value % 4u, 1);
+
+  return {digest, mask, value, 0, 100};
+}
+
+Block MakeBlock()
+{
+  Block block;
+  block.block_number   = 10;
+  block.log2_num_lanes = 2;
+  block.previous_hash  = MakeLayout(200).digest();
+  block.slices         = {{MakeLayout(1), MakeLayout(2)}, {}, {MakeLayout(3)}};
+  block.UpdateDigest();
+
+  return block;
+}
+
+class CompactBlockTests : public ::testing::Test
+{
+protected:
+  bool Lookup(ShortTransactionId id, TransactionLayout &layout) const
+  {
+    return index_.Lookup(id, layout);
+  }
+
+  ShortIdIndex index_;
+};
+
+TEST_F(CompactBlockTests, CheckCompactBlockHasShortIdsInSliceOrder)
+{
+  auto const block   = MakeBlock();
+  auto const compact = ToCompactBlock(block);
+
+  EXPECT_EQ(block.hash, compact.header.hash);
+  EXPECT_TRUE(compact.header.slices.empty());
+  EXPECT_EQ((CompactBlock::SliceSizes{2, 0, 1}), compact.slice_sizes);
+  ASSERT_EQ(3, compact.short_ids.size());
+  EXPECT_EQ(ToShortId(block.slices[2][0].digest()), compact.short_ids[2]);
+}
+
+TEST_F(CompactBlockTests, CheckBlockIsRebuiltFromKnownTransactions)
+{
+  auto const block = MakeBlock();
+  for (auto const &slice : block.slices)
+  {
+    for (auto const &layout : slice)
+    {
+      index_.Add(layout);
+    }
+  }
+
+  Block      rebuilt;
+  auto const missing = ReconstructBlock(
+      ToCompactBlock(block),
+      [this](ShortTransactionId id, TransactionLayout &layout) { return Lookup(id, layout); },
+      rebuilt);
+
+  EXPECT_TRUE(missing.empty());
+
+  rebuilt.UpdateDigest();
+  EXPECT_EQ(block.hash, rebuilt.hash);
+  EXPECT_EQ(block.slices, rebuilt.slices);
+}
+
+TEST_F(CompactBlockTests, CheckMissingTransactionsAreCompletedFromPeer)
+{
+  auto const block = MakeBlock();
+  index_.Add(block.slices[0][1]);
+
+  Block      rebuilt;
+  auto const missing = ReconstructBlock(
+      ToCompactBlock(block),
+      [this](ShortTransactionId id, TransactionLayout &layout) { return Lookup(id, layout); },
+      rebuilt);
+
+  ASSERT_EQ((BlockPositions{0, 2}), missing);
+
+  // the peer serves the layouts at the missing positions
+  auto const layouts = GetTransactionLayouts(block, missing);
+  ASSERT_EQ(2, layouts.size());
+  ASSERT_TRUE(CompleteBlock(rebuilt, missing, layouts));
+
+  rebuilt.UpdateDigest();
+  EXPECT_EQ(block.hash, rebuilt.hash);
+  EXPECT_EQ(block.slices, rebuilt.slices);
+}
+
+TEST_F(CompactBlockTests, CheckPositionsOutsideTheBlockAreRejected)
+{
+  auto const block = MakeBlock();
+
+  EXPECT_TRUE(GetTransactionLayouts(block, BlockPositions{3}).empty());
+
+  Block rebuilt = block;
+  EXPECT_FALSE(CompleteBlock(rebuilt, BlockPositions{3}, TransactionLayouts{MakeLayout(4)}));
+  EXPECT_FALSE(CompleteBlock(rebuilt, BlockPositions{0, 1}, TransactionLayouts{MakeLayout(4)}));
+}
+
+TEST_F(CompactBlockTests, CheckIndexForgetsOldestLayouts)
+{
+  ShortIdIndex index{2};
+  index.Add(MakeLayout(1));
+  index.Add(MakeLayout(2));
+  index.Add(MakeLayout(3));
+
+  TransactionLayout layout;
+  EXPECT_EQ(2, index.size());
+  EXPECT_FALSE(index.Lookup(ToShortId(MakeLayout(1).digest()), layout));
+  EXPECT_TRUE(index.Lookup(ToShortId(MakeLayout(3).digest()), layout));
+  EXPECT_EQ(MakeLayout(3), layout);
+}
+
+}  // namespace
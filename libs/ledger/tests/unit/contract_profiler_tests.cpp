@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "ledger/chaincode/contract_profiler.hpp"
+#include "vm/profiler.hpp"
+
+#include "gmock/gmock.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::ledger::ContractProfiler;
+using fetch::vm::Profiler;
+
+using ::testing::HasSubstr;
+
+Profiler CreateProfile()
+{
+  Profiler profile{1};
+
+  for (auto const *stack : {"main", "main;transfer"})
+  {
+    if (profile.ShouldSample())
+    {
+      profile.RecordSample(stack);
+    }
+  }
+
+  profile.RecordInstruction("main", "PushConstant", 1, std::chrono::microseconds{1});
+  profile.RecordInstruction("transfer", "InvokeUserDefinedFreeFunction", 10,
+                            std::chrono::microseconds{5});
+
+  return profile;
+}
+
+TEST(ContractProfilerTests, CheckProfilesAreMergedPerContract)
+{
+  ConstByteArray const digest{"contract-digest"};
+  ConstByteArray const other{"other-digest"};
+
+  ContractProfiler profiler{};
+  EXPECT_FALSE(profiler.IsEnabled());
+  profiler.Enable(true);
+  EXPECT_TRUE(profiler.IsEnabled());
+
+  profiler.Record(digest, CreateProfile());
+  profiler.Record(digest, CreateProfile());
+  profiler.Record(other, CreateProfile());
+
+  auto const profile = profiler.Lookup(digest);
+  EXPECT_EQ(profile.opcodes().at("PushConstant").count, 2u);
+  EXPECT_EQ(profile.functions().at("transfer").charge, 20u);
+  EXPECT_EQ(profile.samples().at("main;transfer"), 2u);
+
+  EXPECT_TRUE(profiler.Lookup(ConstByteArray{"unknown"}).opcodes().empty());
+
+  // the stacks of each contract are rooted at its digest
+  std::ostringstream stream{};
+  profiler.WriteFoldedStacks(stream);
+
+  auto const folded = stream.str();
+  EXPECT_THAT(folded, HasSubstr(static_cast<std::string>(digest.ToHex()) + ";main;transfer 2\n"));
+  EXPECT_THAT(folded, HasSubstr(static_cast<std::string>(other.ToHex()) + ";main 1\n"));
+
+  profiler.Clear();
+  EXPECT_TRUE(profiler.Lookup(digest).opcodes().empty());
+}
+
+}  // namespace
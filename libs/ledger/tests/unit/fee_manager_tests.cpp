@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/random/lcg.hpp"
+#include "ledger/chaincode/contract_context.hpp"
+#include "ledger/chaincode/contract_context_attacher.hpp"
+#include "ledger/chaincode/token_contract.hpp"
+#include "ledger/execution_result.hpp"
+#include "ledger/fees/block_fees.hpp"
+#include "ledger/fees/fee_manager.hpp"
+#include "ledger/state_sentinel_adapter.hpp"
+#include "ledger/storage_unit/fake_storage_unit.hpp"
+#include "telemetry/registry.hpp"
+
+#include "random_address.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::chain::Address;
+using fetch::ledger::BlockFees;
+using fetch::ledger::ContractContext;
+using fetch::ledger::ContractContextAttacher;
+using fetch::ledger::ContractExecutionResult;
+using fetch::ledger::ContractExecutionStatus;
+using fetch::ledger::FakeStorageUnit;
+using fetch::ledger::FeeManager;
+using fetch::ledger::StateSentinelAdapter;
+using fetch::ledger::TokenContract;
+
+using RNG         = fetch::random::LinearCongruentialGenerator;
+using TokenAmount = FeeManager::TokenAmount;
+
+constexpr char const *   HISTOGRAM_NAME = "ledger_fee_manager_tests_deduct_fees_duration";
+constexpr uint32_t       LOG2_NUM_LANES = 2;
+constexpr uint64_t const BLOCK          = 7;
+
+struct Transaction
+{
+  Address                 from;
+  ContractExecutionStatus status;
+  TokenAmount             charge;
+  TokenAmount             charge_rate;
+  TokenAmount             charge_limit;
+};
+
+/**
+ * Runs the same block of transactions through per transaction and per block fee settlement, each
+ * against its own state, so that the resulting balances can be compared
+ */
+class FeeManagerTests : public ::testing::Test
+{
+protected:
+  FeeManagerTests()
+  {
+    shards_.SetAllOne();
+
+    fetch::telemetry::Registry::Instance().CreateHistogram({0.001, 0.01, 0.1, 1}, HISTOGRAM_NAME,
+                                                           "Fee manager tests");
+  }
+
+  void SetBalance(FakeStorageUnit &storage, Address const &address, TokenAmount amount)
+  {
+    StateSentinelAdapter    adapter{storage, "fetch.token", shards_};
+    ContractContext         context{&token_contract_, address, nullptr, &adapter, BLOCK};
+    ContractContextAttacher raii(token_contract_, context);
+    token_contract_.AddTokens(address, amount);
+  }
+
+  void SetBalance(Address const &address, TokenAmount amount)
+  {
+    SetBalance(per_transaction_storage_, address, amount);
+    SetBalance(per_block_storage_, address, amount);
+  }
+
+  TokenAmount GetBalance(FakeStorageUnit &storage, Address const &address)
+  {
+    StateSentinelAdapter    adapter{storage, "fetch.token", shards_};
+    ContractContext         context{&token_contract_, address, nullptr, &adapter, BLOCK};
+    ContractContextAttacher raii(token_contract_, context);
+    return token_contract_.GetBalance(address);
+  }
+
+  Transaction CreateTransaction(Address const &from, TokenAmount charge,
+                                ContractExecutionStatus status = ContractExecutionStatus::SUCCESS)
+  {
+    return Transaction{from, status, charge, 2, 100};
+  }
+
+  /// The existing path, fees deducted per transaction and paid to the miner once per block
+  TokenAmount SettlePerTransaction(std::vector<Transaction> const &transactions)
+  {
+    FeeManager  fee_manager{token_contract_, HISTOGRAM_NAME};
+    TokenAmount total{0};
+
+    for (auto const &tx : transactions)
+    {
+      FeeManager::TransactionDetails details(tx.from, tx.from, shards_, digest_, tx.charge_rate,
+                                             tx.charge_limit);
+
+      ContractExecutionResult result{};
+      result.status = tx.status;
+      result.charge = tx.charge;
+
+      fee_manager.Execute(details, result, BLOCK, per_transaction_storage_);
+      total += result.fee;
+    }
+
+    fee_manager.SettleFees(miner_, total, miner_, LOG2_NUM_LANES, BLOCK, per_transaction_storage_);
+
+    return total;
+  }
+
+  TokenAmount SettlePerBlock(std::vector<Transaction> const &transactions)
+  {
+    FeeManager fee_manager{token_contract_, HISTOGRAM_NAME};
+    BlockFees  fees{};
+
+    for (auto const &tx : transactions)
+    {
+      FeeManager::TransactionDetails details(tx.from, tx.from, shards_, digest_, tx.charge_rate,
+                                             tx.charge_limit);
+
+      ContractExecutionResult result{};
+      result.status = tx.status;
+      result.charge = tx.charge;
+
+      fee_manager.Execute(details, result, fees);
+    }
+
+    return fee_manager.SettleFees(miner_, fees, LOG2_NUM_LANES, BLOCK, per_block_storage_);
+  }
+
+  void ExpectEquivalent(std::vector<Transaction> const &transactions,
+                        std::vector<Address> const &    addresses)
+  {
+    auto const per_transaction = SettlePerTransaction(transactions);
+    auto const per_block       = SettlePerBlock(transactions);
+
+    EXPECT_EQ(per_transaction, per_block);
+    EXPECT_EQ(GetBalance(per_transaction_storage_, miner_), GetBalance(per_block_storage_, miner_));
+
+    for (auto const &address : addresses)
+    {
+      EXPECT_EQ(GetBalance(per_transaction_storage_, address),
+                GetBalance(per_block_storage_, address));
+    }
+  }
+
+  RNG             rng_{};
+  BitVector       shards_{1u << LOG2_NUM_LANES};
+  fetch::Digest   digest_{"digest"};
+  Address         miner_{GenerateRandomAddress(rng_)};
+  TokenContract   token_contract_{};
+  FakeStorageUnit per_transaction_storage_{};
+  FakeStorageUnit per_block_storage_{};
+};
+
+TEST_F(FeeManagerTests, EmptyBlockCollectsNothing)
+{
+  SetBalance(miner_, 10);
+
+  ExpectEquivalent({}, {});
+  EXPECT_EQ(GetBalance(per_block_storage_, miner_), 10);
+}
+
+TEST_F(FeeManagerTests, SingleTransaction)
+{
+  auto const from = GenerateRandomAddress(rng_);
+  SetBalance(from, 1000);
+
+  ExpectEquivalent({CreateTransaction(from, 30)}, {from});
+  EXPECT_EQ(GetBalance(per_block_storage_, from), 940);
+  EXPECT_EQ(GetBalance(per_block_storage_, miner_), 60);
+}
+
+TEST_F(FeeManagerTests, RepeatedOriginatorsAreChargedOnce)
+{
+  std::vector<Address> addresses{};
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    addresses.emplace_back(GenerateRandomAddress(rng_));
+    SetBalance(addresses.back(), 10000 + i);
+  }
+
+  std::vector<Transaction> transactions{};
+  for (std::size_t i = 0; i < 50; ++i)
+  {
+    transactions.emplace_back(CreateTransaction(addresses[(i * 3) % addresses.size()], i));
+  }
+
+  ExpectEquivalent(transactions, addresses);
+}
+
+TEST_F(FeeManagerTests, FailedTransactionsAreChargedTheLimit)
+{
+  auto const from = GenerateRandomAddress(rng_);
+  SetBalance(from, 1000);
+
+  ExpectEquivalent({CreateTransaction(from, 10),
+                    CreateTransaction(from, 10, ContractExecutionStatus::INSUFFICIENT_CHARGE),
+                    CreateTransaction(from, 10)},
+                   {from});
+  EXPECT_EQ(GetBalance(per_block_storage_, from), 1000 - 20 - 200 - 20);
+}
+
+TEST_F(FeeManagerTests, FeesAreBoundedByTheBalance)
+{
+  auto const poor = GenerateRandomAddress(rng_);
+  auto const rich = GenerateRandomAddress(rng_);
+  SetBalance(poor, 50);
+  SetBalance(rich, 5000);
+
+  ExpectEquivalent({CreateTransaction(poor, 20), CreateTransaction(rich, 20),
+                    CreateTransaction(poor, 20), CreateTransaction(poor, 20)},
+                   {poor, rich});
+  EXPECT_EQ(GetBalance(per_block_storage_, poor), 0);
+  EXPECT_EQ(GetBalance(per_block_storage_, miner_), 50 + 40);
+}
+
+TEST_F(FeeManagerTests, UnfundedOriginatorsPayNothing)
+{
+  auto const from = GenerateRandomAddress(rng_);
+
+  ExpectEquivalent({CreateTransaction(from, 20)}, {from});
+  EXPECT_EQ(GetBalance(per_block_storage_, miner_), 0);
+}
+
+}  // namespace
@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/constants.hpp"
+#include "chain/sharded_balances.hpp"
+#include "core/bitvector.hpp"
+#include "core/random/lcg.hpp"
+#include "ledger/chaincode/contract_context.hpp"
+#include "ledger/chaincode/contract_context_attacher.hpp"
+#include "ledger/chaincode/token_contract.hpp"
+#include "ledger/state_sentinel_adapter.hpp"
+#include "ledger/storage_unit/fake_storage_unit.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "random_address.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::chain::Address;
+using fetch::chain::ShardedBalances;
+using fetch::ledger::ContractContext;
+using fetch::ledger::ContractContextAttacher;
+using fetch::ledger::FakeStorageUnit;
+using fetch::ledger::StateSentinelAdapter;
+using fetch::ledger::TokenContract;
+using fetch::storage::ResourceAddress;
+
+using RNG              = fetch::random::LinearCongruentialGenerator;
+using TokenContractPtr = std::unique_ptr<TokenContract>;
+
+constexpr uint32_t       LOG2_NUM_LANES = 2;
+constexpr uint32_t       NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr uint64_t const BLOCK          = 3;
+
+class ShardedBalanceTests : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    fetch::chain::InitialiseTestConstants();
+  }
+
+  void SetUp() override
+  {
+    token_contract_ = std::make_unique<TokenContract>(
+        std::make_shared<ShardedBalances>(ShardedBalances::Addresses{hot_}, LOG2_NUM_LANES));
+  }
+
+  static uint32_t TokenLane(Address const &address)
+  {
+    return ResourceAddress{"fetch.token.state." + address.display()}.lane(LOG2_NUM_LANES);
+  }
+
+  /// A lane which is not the lane of the main balance of the hot account
+  uint32_t OtherLane() const
+  {
+    return (TokenLane(hot_) + 1) % NUM_LANES;
+  }
+
+  static BitVector Lanes(uint32_t lane)
+  {
+    BitVector lanes{NUM_LANES};
+    lanes.set(lane, 1);
+    return lanes;
+  }
+
+  static BitVector AllLanes()
+  {
+    BitVector lanes{NUM_LANES};
+    lanes.SetAllOne();
+    return lanes;
+  }
+
+  bool AddTokens(BitVector const &lanes, uint64_t amount)
+  {
+    StateSentinelAdapter    adapter{storage_, "fetch.token", lanes};
+    ContractContext         context{token_contract_.get(), hot_, nullptr, &adapter, BLOCK};
+    ContractContextAttacher raii(*token_contract_, context);
+    return token_contract_->AddTokens(hot_, amount);
+  }
+
+  bool SubtractTokens(uint64_t amount)
+  {
+    StateSentinelAdapter    adapter{storage_, "fetch.token", AllLanes()};
+    ContractContext         context{token_contract_.get(), hot_, nullptr, &adapter, BLOCK};
+    ContractContextAttacher raii(*token_contract_, context);
+    return token_contract_->SubtractTokens(hot_, amount);
+  }
+
+  uint64_t GetBalance(BitVector const &lanes)
+  {
+    StateSentinelAdapter    adapter{storage_, "fetch.token", lanes};
+    ContractContext         context{token_contract_.get(), hot_, nullptr, &adapter, BLOCK};
+    ContractContextAttacher raii(*token_contract_, context);
+    return token_contract_->GetBalance(hot_);
+  }
+
+  RNG              rng_{};
+  Address          hot_{GenerateRandomAddress(rng_)};
+  TokenContractPtr token_contract_{};
+  FakeStorageUnit  storage_{};
+};
+
+TEST_F(ShardedBalanceTests, CreditsOnOtherLanesUseSubBalances)
+{
+  EXPECT_TRUE(AddTokens(Lanes(TokenLane(hot_)), 100));
+  EXPECT_TRUE(AddTokens(Lanes(OtherLane()), 20));
+  EXPECT_TRUE(AddTokens(Lanes(OtherLane()), 3));
+
+  // only the main balance is on the lane of the account
+  EXPECT_EQ(100, GetBalance(Lanes(TokenLane(hot_))));
+  EXPECT_EQ(23, GetBalance(Lanes(OtherLane())));
+  EXPECT_EQ(123, GetBalance(AllLanes()));
+}
+
+TEST_F(ShardedBalanceTests, SpendingFoldsTheSubBalances)
+{
+  EXPECT_TRUE(AddTokens(Lanes(TokenLane(hot_)), 10));
+  EXPECT_TRUE(AddTokens(Lanes(OtherLane()), 50));
+
+  EXPECT_FALSE(SubtractTokens(61));
+  EXPECT_EQ(60, GetBalance(AllLanes()));
+
+  EXPECT_TRUE(SubtractTokens(40));
+  EXPECT_EQ(20, GetBalance(AllLanes()));
+  EXPECT_EQ(20, GetBalance(Lanes(TokenLane(hot_))));
+  EXPECT_EQ(0, GetBalance(Lanes(OtherLane())));
+}
+
+TEST_F(ShardedBalanceTests, UnshardedAccountsAreUnchanged)
+{
+  token_contract_ = std::make_unique<TokenContract>();
+
+  EXPECT_TRUE(AddTokens(Lanes(TokenLane(hot_)), 10));
+  EXPECT_FALSE(AddTokens(Lanes(OtherLane()), 10));
+  EXPECT_EQ(10, GetBalance(AllLanes()));
+}
+
+}  // namespace
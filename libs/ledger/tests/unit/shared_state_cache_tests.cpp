@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "chain/transaction_builder.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/storage_unit/fake_storage_unit.hpp"
+#include "ledger/storage_unit/shared_state_cache.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using fetch::chain::Address;
+using fetch::chain::Transaction;
+using fetch::chain::TransactionBuilder;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::FakeStorageUnit;
+using fetch::ledger::SharedStateCache;
+using fetch::storage::ResourceAddress;
+using fetch::byte_array::ConstByteArray;
+
+class SharedStateCacheTests : public ::testing::Test
+{
+public:
+  SharedStateCacheTests()
+    : cache{storage}
+  {}
+
+  static void SetUpTestCase()
+  {
+    fetch::chain::InitialiseTestConstants();
+  }
+
+  void SetUp() override
+  {
+    storage.Set(key_a, ConstByteArray{"a"});
+    storage.Set(key_b, ConstByteArray{"b"});
+  }
+
+  ResourceAddress key_a{"key.a"};
+  ResourceAddress key_b{"key.b"};
+  ResourceAddress key_c{"key.c"};
+
+  FakeStorageUnit  storage{};
+  SharedStateCache cache;
+};
+
+TEST_F(SharedStateCacheTests, ReadsAreServedFromTheCache)
+{
+  EXPECT_EQ(ConstByteArray{"a"}, ConstByteArray(cache.Get(key_a).document));
+  EXPECT_EQ(1u, cache.size());
+
+  // changes made behind the cache are not observed until it is invalidated
+  storage.Set(key_a, ConstByteArray{"updated"});
+  EXPECT_EQ(ConstByteArray{"a"}, ConstByteArray(cache.Get(key_a).document));
+
+  cache.Invalidate();
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(ConstByteArray{"updated"}, ConstByteArray(cache.Get(key_a).document));
+}
+
+TEST_F(SharedStateCacheTests, FailedReadsAreNotCached)
+{
+  EXPECT_TRUE(cache.Get(key_c).failed);
+  EXPECT_EQ(0u, cache.size());
+
+  storage.Set(key_c, ConstByteArray{"c"});
+  EXPECT_EQ(ConstByteArray{"c"}, ConstByteArray(cache.Get(key_c).document));
+}
+
+TEST_F(SharedStateCacheTests, WritesAreWrittenThrough)
+{
+  cache.Get(key_a);
+  cache.Set(key_a, ConstByteArray{"updated"});
+  cache.Set(key_c, ConstByteArray{"c"});
+
+  EXPECT_EQ(ConstByteArray{"updated"}, ConstByteArray(storage.Get(key_a).document));
+  EXPECT_EQ(ConstByteArray{"c"}, ConstByteArray(storage.Get(key_c).document));
+  EXPECT_EQ(ConstByteArray{"updated"}, ConstByteArray(cache.Get(key_a).document));
+  EXPECT_EQ(ConstByteArray{"c"}, ConstByteArray(cache.Get(key_c).document));
+}
+
+TEST_F(SharedStateCacheTests, BatchedReadsOnlyRequestMissingKeys)
+{
+  cache.Get(key_a);
+  storage.Set(key_a, ConstByteArray{"updated"});
+
+  auto const documents = cache.GetBatch({key_a, key_b, key_c});
+  ASSERT_EQ(3u, documents.size());
+  EXPECT_EQ(ConstByteArray{"a"}, ConstByteArray(documents[0].document));
+  EXPECT_EQ(ConstByteArray{"b"}, ConstByteArray(documents[1].document));
+  EXPECT_TRUE(documents[2].failed);
+  EXPECT_EQ(2u, cache.size());
+}
+
+TEST_F(SharedStateCacheTests, RevertInvalidatesTheCache)
+{
+  auto const hash = cache.Commit(1);
+  EXPECT_EQ(0u, cache.size());
+
+  cache.Set(key_a, ConstByteArray{"updated"});
+  EXPECT_EQ(ConstByteArray{"updated"}, ConstByteArray(cache.Get(key_a).document));
+
+  EXPECT_TRUE(cache.RevertToHash(hash, 1));
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(ConstByteArray{"a"}, ConstByteArray(cache.Get(key_a).document));
+}
+
+TEST_F(SharedStateCacheTests, PrefetchedTransactionsAreServedFromMemory)
+{
+  ECDSASigner signer{};
+  auto const  create_tx = [&signer](uint64_t valid_until) {
+    return TransactionBuilder()
+        .From(Address{signer.identity()})
+        .ValidUntil(valid_until)
+        .Signer(signer.identity())
+        .Seal()
+        .Sign(signer)
+        .Build();
+  };
+
+  auto const tx_a    = create_tx(100);
+  auto const tx_b    = create_tx(200);
+  auto const missing = create_tx(300)->digest();
+  storage.AddTransaction(*tx_a);
+  storage.AddTransaction(*tx_b);
+
+  cache.PrefetchTransactions({{tx_a->digest()}, {tx_b->digest(), missing}});
+
+  // lookups wait for the prefetch of their batch
+  Transaction tx{};
+  ASSERT_TRUE(cache.GetTransaction(tx_b->digest(), tx));
+  EXPECT_EQ(tx_b->digest(), tx.digest());
+  EXPECT_FALSE(cache.GetTransaction(missing, tx));
+
+  // once prefetched the transactions no longer need to be retrieved from the storage unit
+  storage.Reset();
+  ASSERT_TRUE(cache.GetTransaction(tx_a->digest(), tx));
+  EXPECT_EQ(tx_a->digest(), tx.digest());
+
+  // and are replaced by the transactions of the next block
+  cache.PrefetchTransactions({});
+  EXPECT_FALSE(cache.GetTransaction(tx_a->digest(), tx));
+}
+
+}  // namespace
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/fake_storage_unit.hpp"
+#include "ledger/storage_unit/speculative_storage_adapter.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using fetch::ledger::FakeStorageUnit;
+using fetch::ledger::SpeculativeStorageAdapter;
+using fetch::storage::ResourceAddress;
+using fetch::byte_array::ConstByteArray;
+
+class SpeculativeStorageAdapterTests : public ::testing::Test
+{
+public:
+  SpeculativeStorageAdapterTests()
+    : adapter{storage}
+  {}
+
+  void SetUp() override
+  {
+    storage.Set(key_a, ConstByteArray{"a"});
+    storage.Set(key_b, ConstByteArray{"b"});
+    adapter.Begin();
+  }
+
+  ResourceAddress key_a{"key.a"};
+  ResourceAddress key_b{"key.b"};
+  ResourceAddress key_c{"key.c"};
+
+  FakeStorageUnit           storage{};
+  SpeculativeStorageAdapter adapter;
+};
+
+TEST_F(SpeculativeStorageAdapterTests, WritesAreBufferedUntilApplied)
+{
+  adapter.Set(key_a, ConstByteArray{"updated"});
+
+  // the speculation sees its own writes, the underlying storage does not
+  EXPECT_EQ(ConstByteArray{"updated"}, ConstByteArray(adapter.Get(key_a).document));
+  EXPECT_EQ(ConstByteArray{"a"}, ConstByteArray(storage.Get(key_a).document));
+
+  auto const access = adapter.TakeAccessSet();
+  EXPECT_EQ(1u, access.writes.size());
+
+  SpeculativeStorageAdapter::KeySet dirty{};
+  access.ApplyTo(storage, dirty);
+
+  EXPECT_EQ(ConstByteArray{"updated"}, ConstByteArray(storage.Get(key_a).document));
+  EXPECT_EQ(1u, dirty.count(key_a));
+}
+
+TEST_F(SpeculativeStorageAdapterTests, ReadsAreTrackedForConflictDetection)
+{
+  adapter.Get(key_a);
+  adapter.Get(key_c);  // missing keys are still part of the read set
+
+  auto const access = adapter.TakeAccessSet();
+  EXPECT_EQ(2u, access.reads.size());
+  EXPECT_TRUE(access.writes.empty());
+
+  EXPECT_FALSE(access.ConflictsWith({}));
+  EXPECT_FALSE(access.ConflictsWith({key_b}));
+  EXPECT_TRUE(access.ConflictsWith({key_a}));
+  EXPECT_TRUE(access.ConflictsWith({key_c}));
+}
+
+TEST_F(SpeculativeStorageAdapterTests, UnchangedWriteBacksAreIgnored)
+{
+  auto const document = adapter.Get(key_b);
+  adapter.Set(key_b, document.document);
+
+  auto const access = adapter.TakeAccessSet();
+  EXPECT_TRUE(access.writes.empty());
+  EXPECT_EQ(1u, access.reads.size());
+}
+
+TEST_F(SpeculativeStorageAdapterTests, BeginDiscardsPreviousSpeculation)
+{
+  adapter.Get(key_a);
+  adapter.Set(key_c, ConstByteArray{"c"});
+
+  adapter.Begin();
+
+  auto const access = adapter.TakeAccessSet();
+  EXPECT_TRUE(access.reads.empty());
+  EXPECT_TRUE(access.writes.empty());
+  EXPECT_TRUE(storage.Get(key_c).failed);
+}
+
+}  // namespace
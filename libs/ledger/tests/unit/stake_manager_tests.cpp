@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "core/random/lcg.hpp"
+#include "core/serializers/main_serializer.hpp"
 #include "crypto/identity.hpp"
 #include "ledger/chain/block.hpp"
 
@@ -27,7 +28,9 @@
 
 #include "gtest/gtest.h"
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace {
 
@@ -171,4 +174,52 @@ TEST_F(StakeManagerTests, DISABLED_CheckBasicStakeChangeScenarios)
   }
 }
 
+TEST_F(StakeManagerTests, HistoryIsRestoredFromDeltas)
+{
+  std::vector<Identity> identities{};
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    identities.emplace_back(GenerateRandomIdentity(rng_));
+  }
+
+  StakeSnapshot initial{};
+  for (auto const &identity : identities)
+  {
+    initial.UpdateStake(identity, 500);
+  }
+
+  stake_manager_->Reset(initial, MAX_CABINET_SIZE);
+
+  // schedule a series of stake changes
+  stake_manager_->update_queue().AddStakeUpdate(2, identities.at(0), 1000);
+  stake_manager_->update_queue().AddStakeUpdate(4, identities.at(1), 0);
+  stake_manager_->update_queue().AddStakeUpdate(6, GenerateRandomIdentity(rng_), 250);
+
+  for (uint64_t block_index = 1; block_index <= 8; ++block_index)
+  {
+    stake_manager_->UpdateCurrentBlock(block_index);
+  }
+
+  fetch::serializers::LargeObjectSerializeHelper serializer{};
+  serializer << *stake_manager_;
+
+  StakeManager restored{};
+  fetch::serializers::LargeObjectSerializeHelper deserializer{serializer.data()};
+  deserializer >> restored;
+
+  ASSERT_TRUE(static_cast<bool>(restored.GetCurrentStakeSnapshot()));
+  EXPECT_EQ(stake_manager_->GetCurrentStakeSnapshot()->total_stake(),
+            restored.GetCurrentStakeSnapshot()->total_stake());
+
+  for (uint64_t block_index = 0; block_index <= 8; ++block_index)
+  {
+    auto const expected = stake_manager_->BuildCabinet(block_index, 42, 4);
+    auto const actual   = restored.BuildCabinet(block_index, 42, 4);
+
+    ASSERT_TRUE(static_cast<bool>(expected));
+    ASSERT_TRUE(static_cast<bool>(actual));
+    EXPECT_EQ(*expected, *actual);
+  }
+}
+
 }  // namespace
@@ -166,4 +166,69 @@ TEST_F(StakeSnapshotTests, TooSmallSampleSize)
   ASSERT_EQ(pool.size(), sample->size());
 }
 
+TEST_F(StakeSnapshotTests, CopiesAreIndependent)
+{
+  auto const pool = GenerateRandomStakePool(20);
+  ASSERT_EQ(20, pool.size());
+
+  StakeSnapshot copy{*snapshot_};
+
+  auto const &identity = pool.begin()->first;
+  copy.UpdateStake(identity, pool.begin()->second + 1);
+
+  EXPECT_EQ(pool.begin()->second, snapshot_->LookupStake(identity));
+  EXPECT_EQ(pool.begin()->second + 1, copy.LookupStake(identity));
+  EXPECT_EQ(snapshot_->total_stake() + 1, copy.total_stake());
+}
+
+TEST_F(StakeSnapshotTests, CheckDeltas)
+{
+  auto const pool = GenerateRandomStakePool(50);
+  ASSERT_EQ(50, pool.size());
+
+  StakeSnapshot next{*snapshot_};
+
+  // modify, remove and add stakes
+  auto it = pool.begin();
+  next.UpdateStake(it->first, it->second + 100);
+  ++it;
+  next.UpdateStake(it->first, 0);
+  next.UpdateStake(GenerateRandomIdentity(rng_), 500);
+
+  auto const delta = next.ComputeDelta(*snapshot_);
+  EXPECT_EQ(3, delta.size());
+
+  StakeSnapshot rebuilt{*snapshot_};
+  rebuilt.ApplyDelta(delta);
+
+  EXPECT_EQ(next.size(), rebuilt.size());
+  EXPECT_EQ(next.total_stake(), rebuilt.total_stake());
+  EXPECT_TRUE(rebuilt.ComputeDelta(next).empty());
+  EXPECT_EQ(*next.BuildCabinet(42, 10), *rebuilt.BuildCabinet(42, 10));
+}
+
+TEST_F(StakeSnapshotTests, SelectionIsWeightedByStake)
+{
+  auto const heavy = GenerateRandomIdentity(rng_);
+  auto const light = GenerateRandomIdentity(rng_);
+
+  snapshot_->UpdateStake(heavy, 9000);
+  snapshot_->UpdateStake(light, 1000);
+
+  std::size_t heavy_selections{0};
+  for (uint64_t entropy = 0; entropy < 1000; ++entropy)
+  {
+    auto const cabinet = snapshot_->BuildCabinet(entropy, 1);
+    ASSERT_EQ(1, cabinet->size());
+
+    if (cabinet->at(0) == heavy)
+    {
+      ++heavy_selections;
+    }
+  }
+
+  EXPECT_GT(heavy_selections, 800);
+  EXPECT_LT(heavy_selections, 980);
+}
+
 }  // namespace
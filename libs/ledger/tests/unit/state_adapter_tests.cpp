@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "ledger/state_adapter.hpp"
+#include "ledger/storage_unit/storage_unit_interface.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::ledger::CommittedStateAdapter;
+using fetch::ledger::StateAdapter;
+using fetch::ledger::StorageInterface;
+using fetch::storage::Document;
+using fetch::storage::ResourceAddress;
+
+using testing::_;
+using testing::Return;
+
+class MockStorage : public StorageInterface
+{
+public:
+  MOCK_CONST_METHOD1(Get, Document(ResourceAddress const &));
+  MOCK_METHOD1(GetOrCreate, Document(ResourceAddress const &));
+  MOCK_METHOD2(Set, void(ResourceAddress const &, StateValue const &));
+  MOCK_METHOD1(Lock, bool(ShardIndex));
+  MOCK_METHOD1(Unlock, bool(ShardIndex));
+  MOCK_METHOD0(Reset, void());
+  MOCK_CONST_METHOD1(GetBatch, Documents(ResourceAddresses const &));
+  MOCK_CONST_METHOD1(GetCommitted, Document(ResourceAddress const &));
+  MOCK_CONST_METHOD1(GetCommittedBatch, Documents(ResourceAddresses const &));
+};
+
+/// Adapter which is able to write to the state, like the one used for contract execution
+class WritableStateAdapter : public StateAdapter
+{
+public:
+  WritableStateAdapter(StorageInterface &storage, ConstByteArray scope)
+    : StateAdapter(storage, std::move(scope), Mode::READ_WRITE)
+  {}
+};
+
+class StateAdapterTests : public testing::Test
+{
+protected:
+  static constexpr char const *SCOPE = "contract";
+
+  static Document CreateDocument(std::string const &value)
+  {
+    Document doc;
+    doc.document = ConstByteArray{value};
+    return doc;
+  }
+
+  static Document CreateMissingDocument()
+  {
+    Document doc;
+    doc.failed = true;
+    return doc;
+  }
+
+  ResourceAddress const present_address{StateAdapter::CreateAddress(SCOPE, "present")};
+  ResourceAddress const missing_address{StateAdapter::CreateAddress(SCOPE, "missing")};
+
+  MockStorage          storage{};
+  WritableStateAdapter adapter{storage, SCOPE};
+};
+
+constexpr char const *StateAdapterTests::SCOPE;
+
+TEST_F(StateAdapterTests, CheckPrefetchedValuesAreServedLocally)
+{
+  StorageInterface::ResourceAddresses const expected_addresses{present_address, missing_address};
+
+  EXPECT_CALL(storage, GetBatch(expected_addresses))
+      .WillOnce(Return(StorageInterface::Documents{CreateDocument("value"),
+                                                   CreateMissingDocument()}));
+  EXPECT_CALL(storage, Get(_)).Times(0);
+
+  EXPECT_EQ(adapter.ReadBatch({"present", "missing"}), StateAdapter::Status::OK);
+
+  char     buffer[16] = {};
+  uint64_t size       = sizeof(buffer);
+  EXPECT_EQ(adapter.Read("present", buffer, size), StateAdapter::Status::OK);
+  EXPECT_EQ(std::string(buffer, size), "value");
+
+  EXPECT_EQ(adapter.Exists("present"), StateAdapter::Status::OK);
+  EXPECT_EQ(adapter.Exists("missing"), StateAdapter::Status::ERROR);
+
+  // keys which are already prefetched are not requested again
+  EXPECT_EQ(adapter.ReadBatch({"present"}), StateAdapter::Status::OK);
+}
+
+TEST_F(StateAdapterTests, CheckWritesInvalidatePrefetchedValues)
+{
+  EXPECT_CALL(storage, GetBatch(_))
+      .WillOnce(Return(StorageInterface::Documents{CreateDocument("value")}));
+  EXPECT_CALL(storage, Set(present_address, ConstByteArray{"new"}));
+  EXPECT_CALL(storage, Get(present_address)).WillOnce(Return(CreateDocument("new")));
+
+  EXPECT_EQ(adapter.ReadBatch({"present"}), StateAdapter::Status::OK);
+  EXPECT_EQ(adapter.Write("present", "new", 3), StateAdapter::Status::OK);
+
+  char     buffer[16] = {};
+  uint64_t size       = sizeof(buffer);
+  EXPECT_EQ(adapter.Read("present", buffer, size), StateAdapter::Status::OK);
+  EXPECT_EQ(std::string(buffer, size), "new");
+}
+
+TEST_F(StateAdapterTests, CheckCommittedAdapterReadsTheCommittedState)
+{
+  CommittedStateAdapter committed{storage, SCOPE};
+
+  EXPECT_CALL(storage, GetCommittedBatch(StorageInterface::ResourceAddresses{missing_address}))
+      .WillOnce(Return(StorageInterface::Documents{CreateMissingDocument()}));
+  EXPECT_CALL(storage, GetCommitted(present_address)).WillOnce(Return(CreateDocument("value")));
+  EXPECT_CALL(storage, Get(_)).Times(0);
+  EXPECT_CALL(storage, GetBatch(_)).Times(0);
+  EXPECT_CALL(storage, Set(_, _)).Times(0);
+
+  EXPECT_EQ(committed.ReadBatch({"missing"}), StateAdapter::Status::OK);
+  EXPECT_EQ(committed.Exists("missing"), StateAdapter::Status::ERROR);
+
+  char     buffer[16] = {};
+  uint64_t size       = sizeof(buffer);
+  EXPECT_EQ(committed.Read("present", buffer, size), StateAdapter::Status::OK);
+  EXPECT_EQ(std::string(buffer, size), "value");
+
+  EXPECT_EQ(committed.Write("present", "new", 3), StateAdapter::Status::PERMISSION_DENIED);
+}
+
+TEST_F(StateAdapterTests, CheckKeysAreResolvedInTheCurrentScope)
+{
+  ResourceAddress const other_address{StateAdapter::CreateAddress("other", "present")};
+
+  EXPECT_CALL(storage, Set(present_address, ConstByteArray{"a"})).Times(2);
+  EXPECT_CALL(storage, Set(other_address, ConstByteArray{"b"}));
+
+  EXPECT_EQ(adapter.Write("present", "a", 1), StateAdapter::Status::OK);
+
+  adapter.PushContext("other");
+  EXPECT_EQ(adapter.Write("present", "b", 1), StateAdapter::Status::OK);
+  adapter.PopContext();
+
+  EXPECT_EQ(adapter.Write("present", "a", 1), StateAdapter::Status::OK);
+}
+
+}  // namespace
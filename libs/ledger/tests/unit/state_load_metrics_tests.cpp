@@ -0,0 +1,256 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/service_ids.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/shard_config.hpp"
+#include "ledger/storage_unit/storage_unit_client.hpp"
+#include "muddle/create_muddle_fake.hpp"
+#include "muddle/muddle_interface.hpp"
+#include "muddle/rpc/server.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/uri.hpp"
+#include "storage/document_store_protocol.hpp"
+#include "storage/new_revertible_document_store.hpp"
+#include "storage/resource_mapper.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using fetch::byte_array::ConstByteArray;
+using fetch::ledger::ShardConfig;
+using fetch::ledger::ShardConfigs;
+using fetch::ledger::StorageUnitClient;
+using fetch::muddle::MuddlePtr;
+using fetch::network::NetworkManager;
+using fetch::network::Uri;
+using fetch::storage::NewRevertibleDocumentStore;
+using fetch::storage::ResourceAddress;
+using fetch::storage::RevertibleDocumentStoreProtocol;
+using fetch::telemetry::Counter;
+using fetch::telemetry::Gauge;
+using fetch::telemetry::Registry;
+
+using Clock       = std::chrono::steady_clock;
+using ServerPtr   = std::unique_ptr<fetch::muddle::rpc::Server>;
+using StorePtr    = std::unique_ptr<NewRevertibleDocumentStore>;
+using ProtocolPtr = std::unique_ptr<RevertibleDocumentStoreProtocol>;
+
+constexpr uint32_t LOG2_NUM_LANES = 1;
+constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr uint16_t BASE_PORT      = 9700;
+
+std::shared_ptr<fetch::crypto::Prover> CreateCertificate()
+{
+  auto certificate = std::make_shared<fetch::crypto::ECDSASigner>();
+  certificate->GenerateKeys();
+  return certificate;
+}
+
+class StateLoadMetricsTests : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    fetch::chain::InitialiseTestConstants();
+  }
+
+  void SetUp() override
+  {
+    std::remove("merkle_stack.db");
+    std::remove("merkle_stack_index.db");
+
+    // the metrics registry outlives the lanes, so every test labels its lanes uniquely
+    label_offset_ = next_label_offset_;
+    next_label_offset_ += NUM_LANES;
+
+    network_manager_.Start();
+
+    client_muddle_ = fetch::muddle::CreateMuddleFake("Test", CreateCertificate(),
+                                                     network_manager_, "127.0.0.1");
+    client_muddle_->Start({BASE_PORT});
+
+    ShardConfigs shards{};
+    for (uint32_t lane = 0; lane < NUM_LANES; ++lane)
+    {
+      auto const certificate = CreateCertificate();
+      auto const port        = static_cast<uint16_t>(BASE_PORT + 1 + lane);
+      auto const prefix      = "state_load_metrics_tests_lane" + std::to_string(lane) + "_";
+
+      auto muddle = fetch::muddle::CreateMuddleFake("Test", certificate, network_manager_,
+                                                    "127.0.0.1");
+      muddle->Start({port});
+
+      auto store = std::make_unique<NewRevertibleDocumentStore>();
+      store->New(prefix + "state.db", prefix + "state_deltas.db", prefix + "index.db",
+                 prefix + "index_deltas.db", false);
+
+      auto protocol = std::make_unique<RevertibleDocumentStoreProtocol>(store.get(), Label(lane));
+
+      auto server = std::make_unique<fetch::muddle::rpc::Server>(
+          muddle->GetEndpoint(), fetch::SERVICE_LANE_CTRL, fetch::CHANNEL_RPC);
+      server->Add(fetch::RPC_STATE, protocol.get());
+
+      client_muddle_->ConnectTo(certificate->identity().identifier(),
+                                Uri{"tcp://127.0.0.1:" + std::to_string(port)});
+
+      ShardConfig shard{};
+      shard.lane_id           = lane;
+      shard.num_lanes         = NUM_LANES;
+      shard.internal_identity = certificate;
+      shards.push_back(shard);
+
+      lane_muddles_.push_back(std::move(muddle));
+      stores_.push_back(std::move(store));
+      protocols_.push_back(std::move(protocol));
+      servers_.push_back(std::move(server));
+    }
+
+    auto const deadline = Clock::now() + 10s;
+    while (client_muddle_->GetNumDirectlyConnectedPeers() < NUM_LANES)
+    {
+      ASSERT_LT(Clock::now(), deadline);
+      std::this_thread::sleep_for(10ms);
+    }
+
+    client_ = std::make_unique<StorageUnitClient>(client_muddle_->GetEndpoint(), shards,
+                                                  LOG2_NUM_LANES);
+  }
+
+  void TearDown() override
+  {
+    client_.reset();
+    servers_.clear();
+
+    for (auto &muddle : lane_muddles_)
+    {
+      muddle->Stop();
+    }
+    client_muddle_->Stop();
+
+    network_manager_.Stop();
+  }
+
+  uint32_t Label(uint32_t lane) const
+  {
+    return label_offset_ + lane;
+  }
+
+  uint64_t SetBytes(uint32_t lane) const
+  {
+    auto const counter = Registry::Instance().LookupMeasurement<Counter>(
+        "ledger_statedb_set_bytes_total", {{"lane", std::to_string(Label(lane))}});
+    return counter ? counter->count() : 0;
+  }
+
+  uint64_t Documents(uint32_t lane) const
+  {
+    auto const gauge = Registry::Instance().LookupMeasurement<Gauge<uint64_t>>(
+        "ledger_statedb_documents", {{"lane", std::to_string(Label(lane))}});
+    return gauge ? gauge->get() : 0;
+  }
+
+  /**
+   * Finds a key stored on the specified lane
+   */
+  static ResourceAddress KeyOnLane(uint32_t lane, std::size_t index)
+  {
+    std::size_t found{0};
+    for (std::size_t i = 0;; ++i)
+    {
+      ResourceAddress key{"key-" + std::to_string(i)};
+      if ((key.lane(LOG2_NUM_LANES) == lane) && (found++ == index))
+      {
+        return key;
+      }
+    }
+  }
+
+  static uint32_t next_label_offset_;
+
+  uint32_t                           label_offset_{0};
+  NetworkManager                     network_manager_{"NetworkManager", 4};
+  MuddlePtr                          client_muddle_;
+  std::vector<MuddlePtr>             lane_muddles_;
+  std::vector<StorePtr>              stores_;
+  std::vector<ProtocolPtr>           protocols_;
+  std::vector<ServerPtr>             servers_;
+  std::unique_ptr<StorageUnitClient> client_;
+};
+
+uint32_t StateLoadMetricsTests::next_label_offset_{100};
+
+TEST_F(StateLoadMetricsTests, BytesWrittenAreCountedByLane)
+{
+  client_->Set(KeyOnLane(0, 0), ConstByteArray{"0123456789"});
+  client_->SetBatch({KeyOnLane(1, 0), KeyOnLane(1, 1)},
+                    {ConstByteArray{"abc"}, ConstByteArray{"de"}});
+
+  EXPECT_EQ(SetBytes(0), 10u);
+  EXPECT_EQ(SetBytes(1), 5u);
+}
+
+TEST_F(StateLoadMetricsTests, ImportedBytesAreCountedByLane)
+{
+  client_->Import({KeyOnLane(0, 0), KeyOnLane(1, 0), KeyOnLane(1, 1)},
+                  {ConstByteArray{"a"}, ConstByteArray{"bc"}, ConstByteArray{"def"}});
+
+  EXPECT_EQ(SetBytes(0), 1u);
+  EXPECT_EQ(SetBytes(1), 5u);
+}
+
+TEST_F(StateLoadMetricsTests, DocumentsArePublishedOnCommit)
+{
+  client_->SetBatch({KeyOnLane(0, 0), KeyOnLane(0, 1), KeyOnLane(0, 2), KeyOnLane(1, 0)},
+                    {ConstByteArray{"a"}, ConstByteArray{"b"}, ConstByteArray{"c"},
+                     ConstByteArray{"d"}});
+
+  EXPECT_EQ(Documents(0), 0u);
+  EXPECT_EQ(Documents(1), 0u);
+
+  ASSERT_FALSE(client_->Commit(0).empty());
+
+  EXPECT_EQ(Documents(0), 3u);
+  EXPECT_EQ(Documents(1), 1u);
+
+  // overwriting a document does not add to the state
+  client_->Set(KeyOnLane(1, 0), ConstByteArray{"e"});
+  ASSERT_FALSE(client_->Commit(1).empty());
+
+  EXPECT_EQ(Documents(0), 3u);
+  EXPECT_EQ(Documents(1), 1u);
+}
+
+}  // namespace
@@ -0,0 +1,226 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "ledger/storage_unit/state_reshard.hpp"
+#include "meta/log2.hpp"
+#include "storage/new_revertible_document_store.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::ledger::ReshardState;
+using fetch::storage::NewRevertibleDocumentStore;
+using fetch::storage::ResourceAddress;
+
+using IndexBackend = NewRevertibleDocumentStore::IndexBackend;
+using StorePtr     = std::unique_ptr<NewRevertibleDocumentStore>;
+
+constexpr std::size_t NUM_DOCUMENTS    = 200;
+constexpr char const *SOURCE_PATH      = "state_reshard_tests_source";
+constexpr char const *DESTINATION_PATH = "state_reshard_tests_destination";
+
+// matches the storage prefix generated by the LaneService
+std::string GeneratePrefix(std::string const &storage_path, uint32_t lane)
+{
+  std::ostringstream oss;
+  oss << storage_path << "_lane" << std::setw(3) << std::setfill('0') << lane << "_";
+  return oss.str();
+}
+
+std::string IndexName(IndexBackend backend)
+{
+  return (IndexBackend::B_TREE == backend) ? "state_btree_index" : "state_index";
+}
+
+StorePtr CreateLane(std::string const &storage_path, uint32_t lane, IndexBackend backend)
+{
+  auto const prefix = GeneratePrefix(storage_path, lane);
+  auto const index  = IndexName(backend);
+
+  auto store = std::make_unique<NewRevertibleDocumentStore>(backend);
+  store->New(prefix + "state.db", prefix + "state_deltas.db", prefix + index + ".db",
+             prefix + index + "_deltas.db", false);
+  return store;
+}
+
+StorePtr LoadLane(std::string const &storage_path, uint32_t lane, IndexBackend backend)
+{
+  auto const prefix = GeneratePrefix(storage_path, lane);
+  auto const index  = IndexName(backend);
+
+  auto store = std::make_unique<NewRevertibleDocumentStore>(backend);
+  if (!store->Load(prefix + "state.db", prefix + "state_deltas.db", prefix + index + ".db",
+                   prefix + index + "_deltas.db", false))
+  {
+    store.reset();
+  }
+
+  return store;
+}
+
+ResourceAddress Key(std::size_t i)
+{
+  return ResourceAddress{"key-" + std::to_string(i)};
+}
+
+ConstByteArray Value(std::size_t i)
+{
+  return "value-" + std::to_string(i);
+}
+
+class StateReshardTests : public ::testing::TestWithParam<IndexBackend>
+{
+protected:
+  /**
+   * Creates the state of a node, with the documents spread over its lanes
+   *
+   * @param num_lanes The number of lanes of the node
+   */
+  void CreateSourceState(uint32_t num_lanes)
+  {
+    auto const log2_num_lanes = fetch::meta::Log2(num_lanes);
+
+    for (uint32_t lane = 0; lane < num_lanes; ++lane)
+    {
+      auto store = CreateLane(SOURCE_PATH, lane, GetParam());
+
+      for (std::size_t i = 0; i < NUM_DOCUMENTS; ++i)
+      {
+        if (Key(i).lane(log2_num_lanes) == lane)
+        {
+          store->Set(Key(i).as_resource_id(), Value(i));
+        }
+      }
+
+      store->Commit();
+    }
+  }
+
+  /**
+   * Checks that every document is found in, and only in, the lane it maps to
+   *
+   * @param num_lanes The number of lanes of the migrated node
+   */
+  void ExpectMigratedState(uint32_t num_lanes)
+  {
+    auto const log2_num_lanes = fetch::meta::Log2(num_lanes);
+
+    std::size_t total{0};
+    for (uint32_t lane = 0; lane < num_lanes; ++lane)
+    {
+      auto store = LoadLane(DESTINATION_PATH, lane, GetParam());
+      ASSERT_TRUE(store);
+
+      for (std::size_t i = 0; i < NUM_DOCUMENTS; ++i)
+      {
+        auto const document = store->Get(Key(i).as_resource_id());
+
+        if (Key(i).lane(log2_num_lanes) == lane)
+        {
+          EXPECT_FALSE(document.failed);
+          EXPECT_EQ(ConstByteArray{document.document}, Value(i));
+        }
+        else
+        {
+          EXPECT_TRUE(document.failed);
+        }
+      }
+
+      total += store->size();
+    }
+
+    EXPECT_EQ(total, NUM_DOCUMENTS);
+  }
+};
+
+TEST_P(StateReshardTests, LanesAreSplitByTheirResourceGroup)
+{
+  CreateSourceState(2);
+
+  ASSERT_TRUE(ReshardState(SOURCE_PATH, 2, DESTINATION_PATH, 8, GetParam()));
+
+  ExpectMigratedState(8);
+}
+
+TEST_P(StateReshardTests, StateIsCopiedWhenTheLaneCountIsUnchanged)
+{
+  CreateSourceState(4);
+
+  ASSERT_TRUE(ReshardState(SOURCE_PATH, 4, DESTINATION_PATH, 4, GetParam()));
+
+  ExpectMigratedState(4);
+}
+
+TEST_P(StateReshardTests, SourceStateIsUnchanged)
+{
+  CreateSourceState(1);
+  auto const hash = LoadLane(SOURCE_PATH, 0, GetParam())->CurrentHash();
+
+  ASSERT_TRUE(ReshardState(SOURCE_PATH, 1, DESTINATION_PATH, 2, GetParam()));
+
+  auto const source = LoadLane(SOURCE_PATH, 0, GetParam());
+  ASSERT_TRUE(source);
+  EXPECT_EQ(source->CurrentHash(), hash);
+  EXPECT_EQ(source->size(), NUM_DOCUMENTS);
+}
+
+TEST_P(StateReshardTests, LaneCountMustBeAPowerOfTwo)
+{
+  CreateSourceState(2);
+
+  EXPECT_FALSE(ReshardState(SOURCE_PATH, 2, DESTINATION_PATH, 6, GetParam()));
+  EXPECT_FALSE(ReshardState(SOURCE_PATH, 3, DESTINATION_PATH, 8, GetParam()));
+}
+
+TEST_P(StateReshardTests, LaneCountCanNotBeReduced)
+{
+  CreateSourceState(4);
+
+  EXPECT_FALSE(ReshardState(SOURCE_PATH, 4, DESTINATION_PATH, 2, GetParam()));
+}
+
+TEST_P(StateReshardTests, SourceCanNotBeOverwritten)
+{
+  CreateSourceState(2);
+
+  EXPECT_FALSE(ReshardState(SOURCE_PATH, 2, SOURCE_PATH, 4, GetParam()));
+}
+
+TEST_P(StateReshardTests, MissingSourceLaneIsReported)
+{
+  CreateLane("state_reshard_tests_partial", 0, GetParam())->Commit();
+
+  EXPECT_FALSE(ReshardState("state_reshard_tests_partial", 2, DESTINATION_PATH, 4, GetParam()));
+}
+
+INSTANTIATE_TEST_CASE_P(IndexBackends, StateReshardTests,
+                        ::testing::Values(IndexBackend::KEY_VALUE_INDEX, IndexBackend::B_TREE), );
+
+}  // namespace
@@ -105,4 +105,28 @@ TEST_F(RecentTransactionsCacheTests, CheckTransactionLayouts)
   }
 }
 
+TEST_F(RecentTransactionsCacheTests, CheckRemoveExpired)
+{
+  auto const early = tx_gen_.GenerateRandomTxs(2, 10);
+  auto const late  = tx_gen_.GenerateRandomTxs(2, 20);
+
+  cache_.Add(*early.at(0));
+  cache_.Add(*late.at(0));
+  cache_.Add(*early.at(1));
+  cache_.Add(*late.at(1));
+
+  EXPECT_EQ(cache_.RemoveExpired(10), 2u);
+  EXPECT_EQ(cache_.GetSize(), 2u);
+
+  // only the unexpired transactions are flushed, most recent first
+  auto const entries = cache_.Flush(MAX_CACHE_SIZE);
+  ASSERT_EQ(entries.size(), 2u);
+  EXPECT_EQ(entries.at(0).digest(), late.at(1)->digest());
+  EXPECT_EQ(entries.at(1).digest(), late.at(0)->digest());
+  EXPECT_EQ(cache_.GetSize(), 0u);
+
+  // flushed transactions are no longer tracked for expiry
+  EXPECT_EQ(cache_.RemoveExpired(100), 0u);
+}
+
 }  // namespace
@@ -101,6 +101,36 @@ TEST_F(TransactionArchiverTests, BasicCheck)
   }
 }
 
+TEST_F(TransactionArchiverTests, CheckConfirmationsAreArchivedAsABatch)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(20);
+
+  for (auto const &tx : txs)
+  {
+    pool_.pool.Add(*tx);
+    archiver_.Confirm(tx->digest());
+  }
+
+  // confirming a transaction twice must not archive it twice
+  archiver_.Confirm(txs.front()->digest());
+
+  EXPECT_CALL(store_, Add(_)).Times(static_cast<int>(txs.size()));
+  EXPECT_CALL(pool_, Remove(_)).Times(static_cast<int>(txs.size()));
+
+  // the whole batch is collected and then flushed in a single pass
+  auto state_machine = archiver_.GetStateMachine();
+  state_machine->Execute();
+  ASSERT_EQ(TransactionArchiver::State::FLUSHING, state_machine->state());
+  state_machine->Execute();
+  ASSERT_EQ(TransactionArchiver::State::COLLECTING, state_machine->state());
+
+  for (auto const &tx : txs)
+  {
+    EXPECT_TRUE(store_.pool.Has(tx->digest()));
+    EXPECT_FALSE(pool_.pool.Has(tx->digest()));
+  }
+}
+
 TEST_F(TransactionArchiverTests, CheckRecoveryFromLookupFailure)
 {
   auto const tx = tx_gen_();
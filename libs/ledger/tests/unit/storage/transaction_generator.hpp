@@ -34,11 +34,13 @@ public:
   using TransactionPtr     = TransactionBuilder::TransactionPtr;
   using Txs                = std::vector<TransactionGenerator::TransactionPtr>;
 
-  TransactionPtr operator()()
+  static constexpr uint64_t DEFAULT_VALID_UNTIL = 1000;
+
+  TransactionPtr operator()(uint64_t valid_until = DEFAULT_VALID_UNTIL)
   {
     return TransactionBuilder{}
         .From(address_)
-        .ValidUntil(1000)
+        .ValidUntil(valid_until)
         .TargetChainCode("foo.bar.baz", BitVector{})
         .Action("test")
         .Data(GenerateRandomData())
@@ -48,7 +50,7 @@ public:
         .Build();
   }
 
-  Txs GenerateRandomTxs(std::size_t count)
+  Txs GenerateRandomTxs(std::size_t count, uint64_t valid_until = DEFAULT_VALID_UNTIL)
   {
     TransactionGenerator &self = *this;
 
@@ -57,7 +59,7 @@ public:
 
     for (std::size_t i = 0; i < count; ++i)
     {
-      txs.emplace_back(self());
+      txs.emplace_back(self(valid_until));
     }
 
     return txs;
@@ -75,4 +75,137 @@ TEST_F(TransactionMemPoolTests, SimpleCheck)
   }
 }
 
+TEST_F(TransactionMemPoolTests, CheckSizeAccounting)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(5);
+
+  std::size_t expected_size{0};
+  for (auto const &tx : txs)
+  {
+    memory_pool_.Add(*tx);
+    expected_size += TransactionMemoryPool::EstimateSizeInBytes(*tx);
+  }
+
+  // adding the same transaction again does not change the accounting
+  memory_pool_.Add(*txs.front());
+
+  EXPECT_EQ(memory_pool_.GetCount(), txs.size());
+  EXPECT_EQ(memory_pool_.GetSizeInBytes(), expected_size);
+
+  for (auto const &tx : txs)
+  {
+    memory_pool_.Remove(tx->digest());
+  }
+
+  EXPECT_EQ(memory_pool_.GetCount(), 0u);
+  EXPECT_EQ(memory_pool_.GetSizeInBytes(), 0u);
+}
+
+TEST_F(TransactionMemPoolTests, CheckSpillOnceFull)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(5);
+
+  // only enough room in memory for the first three transactions
+  std::size_t max_size{0};
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    max_size += TransactionMemoryPool::EstimateSizeInBytes(*txs.at(i));
+  }
+
+  TransactionMemoryPool overflow{};
+  TransactionMemoryPool pool{max_size, &overflow};
+
+  for (auto const &tx : txs)
+  {
+    pool.Add(*tx);
+  }
+
+  EXPECT_EQ(pool.GetCount(), 3u);
+  EXPECT_EQ(overflow.GetCount(), 2u);
+
+  for (std::size_t i = 0; i < txs.size(); ++i)
+  {
+    bool const in_memory = i < 3;
+
+    EXPECT_EQ(pool.Has(txs.at(i)->digest()), in_memory);
+    EXPECT_EQ(overflow.Has(txs.at(i)->digest()), !in_memory);
+  }
+
+  // once space has been made the pool holds transactions in memory again
+  pool.Remove(txs.front()->digest());
+
+  auto const next = tx_gen_.GenerateRandomTxs(1);
+  pool.Add(*next.front());
+
+  EXPECT_TRUE(pool.Has(next.front()->digest()));
+  EXPECT_FALSE(overflow.Has(next.front()->digest()));
+}
+
+TEST_F(TransactionMemPoolTests, CheckSpillToTargetSize)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(10);
+
+  TransactionMemoryPool overflow{};
+  TransactionMemoryPool pool{TransactionMemoryPool::UNLIMITED_SIZE_IN_BYTES, &overflow};
+
+  for (auto const &tx : txs)
+  {
+    pool.Add(*tx);
+  }
+
+  std::size_t const target = pool.GetSizeInBytes() / 2;
+  std::size_t const count  = pool.Spill(target);
+
+  EXPECT_GT(count, 0u);
+  EXPECT_LE(pool.GetSizeInBytes(), target);
+  EXPECT_EQ(pool.GetCount(), txs.size() - count);
+  EXPECT_EQ(overflow.GetCount(), count);
+
+  // every transaction is held by exactly one of the stores
+  for (auto const &tx : txs)
+  {
+    EXPECT_NE(pool.Has(tx->digest()), overflow.Has(tx->digest()));
+  }
+
+  // nothing further is spilled once the pool is within the target
+  EXPECT_EQ(pool.Spill(target), 0u);
+}
+
+TEST_F(TransactionMemPoolTests, CheckRemoveExpired)
+{
+  auto const early = tx_gen_.GenerateRandomTxs(3, 10);
+  auto const late  = tx_gen_.GenerateRandomTxs(2, 20);
+
+  for (auto const &txs : {early, late})
+  {
+    for (auto const &tx : txs)
+    {
+      memory_pool_.Add(*tx);
+    }
+  }
+
+  // transactions which have already left the pool are not counted again
+  memory_pool_.Remove(early.front()->digest());
+
+  EXPECT_EQ(memory_pool_.RemoveExpired(9), 0u);
+  EXPECT_EQ(memory_pool_.GetCount(), 4u);
+
+  EXPECT_EQ(memory_pool_.RemoveExpired(10), 2u);
+  EXPECT_EQ(memory_pool_.GetCount(), 2u);
+
+  for (auto const &tx : early)
+  {
+    EXPECT_FALSE(memory_pool_.Has(tx->digest()));
+  }
+
+  for (auto const &tx : late)
+  {
+    EXPECT_TRUE(memory_pool_.Has(tx->digest()));
+  }
+
+  EXPECT_EQ(memory_pool_.RemoveExpired(100), 2u);
+  EXPECT_EQ(memory_pool_.GetCount(), 0u);
+  EXPECT_EQ(memory_pool_.GetSizeInBytes(), 0u);
+}
+
 }  // namespace
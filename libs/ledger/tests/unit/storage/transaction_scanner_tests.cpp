@@ -0,0 +1,232 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/identity.hpp"
+#include "crypto/prover.hpp"
+#include "ledger/storage_unit/transaction_scanner.hpp"
+#include "ledger/storage_unit/transaction_store.hpp"
+#include "transaction_generator.hpp"
+#include "variant/variant.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::chain::Address;
+using fetch::chain::TransactionBuilder;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::TransactionScanner;
+using fetch::variant::Variant;
+
+using Requests = TransactionScanner::Requests;
+using Results  = TransactionScanner::Results;
+
+constexpr std::size_t NUM_LANES = 2;
+constexpr std::size_t NUM_TXS   = 200;
+
+/**
+ * Signs on behalf of an identity with a key which does not belong to it
+ */
+class Impostor : public fetch::crypto::Prover
+{
+public:
+  explicit Impostor(fetch::crypto::Identity identity)
+    : identity_{std::move(identity)}
+  {}
+
+  fetch::crypto::Identity identity() const override
+  {
+    return identity_;
+  }
+
+  void Load(ConstByteArray const & /*private_key*/) override
+  {}
+
+  ConstByteArray Sign(ConstByteArray const &message) const override
+  {
+    return key_.Sign(message);
+  }
+
+private:
+  fetch::crypto::Identity identity_;
+  ECDSASigner             key_{};
+};
+
+class TransactionScannerTests : public ::testing::TestWithParam<std::size_t>
+{
+protected:
+  void SetUp() override
+  {
+    for (std::size_t lane = 0; lane < NUM_LANES; ++lane)
+    {
+      auto const prefix = "transaction_scanner_tests_lane" + std::to_string(lane);
+
+      auto &store = stores_.emplace(std::piecewise_construct, std::forward_as_tuple(lane),
+                                    std::forward_as_tuple())
+                        .first->second;
+      store.New(prefix + ".db", prefix + ".index.db");
+    }
+
+    // the transactions are spread over the lanes
+    txs_ = tx_gen_.GenerateRandomTxs(NUM_TXS);
+    for (std::size_t i = 0; i < txs_.size(); ++i)
+    {
+      stores_.at(i % NUM_LANES).Add(*txs_[i]);
+      requests_.emplace_back(TransactionScanner::Request{i % NUM_LANES, txs_[i]->digest()});
+    }
+  }
+
+  std::size_t NumThreads() const
+  {
+    return GetParam();
+  }
+
+  TransactionGenerator         tx_gen_;
+  TransactionGenerator::Txs    txs_;
+  TransactionScanner::Stores   stores_;
+  TransactionScanner::Requests requests_;
+};
+
+TEST_P(TransactionScannerTests, ResultsAreInRequestOrder)
+{
+  TransactionScanner scanner{stores_, NumThreads()};
+
+  Results results(requests_.size());
+  scanner.Scan(requests_, 0, results);
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    ASSERT_TRUE(results[i].found);
+    EXPECT_EQ(results[i].tx.digest(), txs_[i]->digest());
+    EXPECT_FALSE(results[i].verified);
+    EXPECT_TRUE(results[i].record.empty());
+  }
+}
+
+TEST_P(TransactionScannerTests, RangeOfRequestsIsScanned)
+{
+  TransactionScanner scanner{stores_, NumThreads()};
+
+  Results results(50);
+  scanner.Scan(requests_, 120, results);
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    ASSERT_TRUE(results[i].found);
+    EXPECT_EQ(results[i].tx.digest(), txs_[120 + i]->digest());
+  }
+}
+
+TEST_P(TransactionScannerTests, MissingTransactionsAreReported)
+{
+  Requests const requests{
+      {0, tx_gen_()->digest()},      // never stored
+      {1, txs_[0]->digest()},        // stored on another lane
+      {NUM_LANES, txs_[0]->digest()}  // an unknown lane
+  };
+
+  TransactionScanner scanner{stores_, NumThreads()};
+  scanner.EnableSignatureVerification(true);
+
+  Results results(requests.size());
+  scanner.Scan(requests, 0, results);
+
+  for (auto const &result : results)
+  {
+    EXPECT_FALSE(result.found);
+    EXPECT_FALSE(result.verified);
+  }
+}
+
+TEST_P(TransactionScannerTests, SignaturesAreVerified)
+{
+  ECDSASigner signer{};
+  Impostor    impostor{signer.identity()};
+
+  // the transaction is signed by a key other than the one of its signatory
+  auto const forged = TransactionBuilder{}
+                          .From(Address{signer.identity()})
+                          .ValidUntil(100)
+                          .Signer(signer.identity())
+                          .Seal()
+                          .Sign(impostor)
+                          .Build();
+  ASSERT_TRUE(forged);
+  stores_.at(0).Add(*forged);
+
+  auto requests = requests_;
+  requests.emplace_back(TransactionScanner::Request{0, forged->digest()});
+
+  TransactionScanner scanner{stores_, NumThreads()};
+  scanner.EnableSignatureVerification(true);
+
+  Results results(requests.size());
+  scanner.Scan(requests, 0, results);
+
+  for (std::size_t i = 0; i < requests_.size(); ++i)
+  {
+    ASSERT_TRUE(results[i].found);
+    EXPECT_TRUE(results[i].verified);
+  }
+
+  ASSERT_TRUE(results.back().found);
+  EXPECT_FALSE(results.back().verified);
+}
+
+TEST_P(TransactionScannerTests, RecordsAreExportedForEveryRequest)
+{
+  TransactionScanner scanner{stores_, NumThreads()};
+  scanner.SetExporter([](std::size_t index, TransactionScanner::Result const &result) {
+    auto record{Variant::Object()};
+    record["index"] = index;
+    record["found"] = result.found;
+    return record;
+  });
+
+  Requests requests{requests_.begin(), requests_.begin() + 10};
+  requests.emplace_back(TransactionScanner::Request{0, tx_gen_()->digest()});
+
+  Results results(requests.size() - 5);
+  scanner.Scan(requests, 5, results);
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    bool const        found = (5 + i) < 10;
+    std::string const expected = std::string{"{\"found\": "} + (found ? "true" : "false") +
+                                 ", \"index\": " + std::to_string(5 + i) + "}";
+
+    EXPECT_EQ(results[i].found, found);
+    EXPECT_EQ(results[i].record, ConstByteArray{expected});
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(ThreadCounts, TransactionScannerTests, ::testing::Values(1u, 4u), );
+
+}  // namespace
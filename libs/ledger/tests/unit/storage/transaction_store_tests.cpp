@@ -18,16 +18,22 @@
 
 #include "chain/transaction.hpp"
 #include "chain/transaction_builder.hpp"
+#include "crypto/ecdsa.hpp"
 #include "ledger/storage_unit/transaction_store.hpp"
+#include "ledger/storage_unit/transaction_view.hpp"
 #include "transaction_generator.hpp"
 
+#include <algorithm>
 #include <vector>
 
 #include "gtest/gtest.h"
 
 namespace {
 
+using fetch::chain::Transaction;
+using fetch::chain::TransactionLayout;
 using fetch::ledger::TransactionStore;
+using fetch::ledger::TransactionView;
 
 class TransactionStoreTests : public ::testing::Test
 {
@@ -82,4 +88,134 @@ TEST_F(TransactionStoreTests, SimpleCheck)
   }
 }
 
+TEST_F(TransactionStoreTests, CheckGetAndView)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(10);
+
+  for (auto const &tx : txs)
+  {
+    store_.Add(*tx);
+  }
+
+  for (auto const &tx : txs)
+  {
+    Transaction retrieved{};
+    ASSERT_TRUE(store_.Get(tx->digest(), retrieved));
+    EXPECT_EQ(tx->digest(), retrieved.digest());
+
+    TransactionView view{};
+    ASSERT_TRUE(store_.GetView(tx->digest(), view));
+    ASSERT_FALSE(view.empty());
+
+    // the layout is available without decoding the full transaction
+    auto const layout = view.layout(2);
+    EXPECT_EQ(tx->digest(), layout.digest());
+    EXPECT_EQ(TransactionLayout(*tx, 2).mask(), layout.mask());
+    EXPECT_EQ(tx->charge_rate(), layout.charge_rate());
+
+    EXPECT_EQ(tx->digest(), view.transaction().digest());
+    EXPECT_EQ(tx->data(), view.transaction().data());
+  }
+
+  auto const missing = tx_gen_.GenerateRandomTxs(1);
+
+  Transaction     retrieved{};
+  TransactionView view{};
+  EXPECT_FALSE(store_.Get(missing.front()->digest(), retrieved));
+  EXPECT_FALSE(store_.GetView(missing.front()->digest(), view));
+  EXPECT_TRUE(view.empty());
+}
+
+TEST_F(TransactionStoreTests, CheckBatchAddition)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(10);
+
+  // one of the transactions is already present
+  store_.Add(*txs.front());
+
+  TransactionStore::TxArray batch{};
+  for (auto const &tx : txs)
+  {
+    batch.emplace_back(*tx);
+  }
+
+  // the same transaction may appear more than once in the batch
+  batch.emplace_back(*txs.back());
+
+  store_.AddBatch(batch);
+  EXPECT_EQ(store_.GetCount(), txs.size());
+
+  for (auto const &tx : txs)
+  {
+    Transaction retrieved{};
+    ASSERT_TRUE(store_.Get(tx->digest(), retrieved));
+    EXPECT_EQ(tx->digest(), retrieved.digest());
+  }
+}
+
+TEST_F(TransactionStoreTests, CheckPullSubtreeDigests)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(10);
+
+  for (auto const &tx : txs)
+  {
+    store_.Add(*tx);
+  }
+
+  // a zero length prefix covers the entire tree
+  fetch::byte_array::ByteArray root{};
+  root.Resize(fetch::storage::ResourceID::RESOURCE_ID_SIZE_IN_BYTES);
+  for (std::size_t i = 0; i < root.size(); ++i)
+  {
+    root[i] = 0;
+  }
+
+  auto const digests = store_.PullSubtreeDigests(root, 0, 100);
+  ASSERT_EQ(digests.size(), txs.size());
+
+  for (auto const &tx : txs)
+  {
+    EXPECT_NE(std::find(digests.begin(), digests.end(), tx->digest()), digests.end());
+  }
+
+  EXPECT_EQ(store_.PullSubtreeDigests(root, 0, 3).size(), 3u);
+}
+
+TEST_F(TransactionStoreTests, CheckGetAndViewOfLargeTransaction)
+{
+  // large enough to span multiple blocks of the underlying document store
+  fetch::byte_array::ByteArray data{};
+  data.Resize(8192);
+  for (std::size_t i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<uint8_t>(i);
+  }
+
+  fetch::crypto::ECDSASigner signer{};
+  signer.GenerateKeys();
+
+  auto const tx = fetch::chain::TransactionBuilder{}
+                      .From(fetch::chain::Address{signer.identity()})
+                      .ValidUntil(1000)
+                      .TargetChainCode("foo.bar.baz", fetch::BitVector{})
+                      .Action("test")
+                      .Data(data)
+                      .Signer(signer.identity())
+                      .Seal()
+                      .Sign(signer)
+                      .Build();
+
+  store_.Add(*tx);
+
+  Transaction retrieved{};
+  ASSERT_TRUE(store_.Get(tx->digest(), retrieved));
+  EXPECT_EQ(tx->digest(), retrieved.digest());
+  EXPECT_EQ(tx->data(), retrieved.data());
+
+  TransactionView view{};
+  ASSERT_TRUE(store_.GetView(tx->digest(), view));
+  EXPECT_EQ(tx->digest(), view.transaction().digest());
+  EXPECT_EQ(tx->data(), view.transaction().data());
+}
+
 }  // namespace
@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/shard_config.hpp"
+#include "ledger/storage_unit/storage_unit_bundled_service.hpp"
+#include "ledger/storage_unit/storage_unit_client.hpp"
+#include "muddle/muddle_interface.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/uri.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using fetch::ledger::ShardConfig;
+using fetch::ledger::ShardConfigs;
+using fetch::ledger::StorageUnitBundledService;
+using fetch::ledger::StorageUnitClient;
+using fetch::muddle::MuddlePtr;
+using fetch::muddle::NetworkId;
+using fetch::network::NetworkManager;
+using fetch::network::Uri;
+
+using Clock = std::chrono::steady_clock;
+using Mode  = StorageUnitBundledService::Mode;
+
+constexpr uint32_t LOG2_NUM_LANES = 2;
+constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr uint16_t BASE_PORT      = 9600;
+constexpr char const *STORAGE_PATH = "storage_unit_bundled_service_tests";
+
+class StorageUnitBundledServiceTests : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    fetch::chain::InitialiseTestConstants();
+  }
+
+  void SetUp() override
+  {
+    std::remove("merkle_stack.db");
+    std::remove("merkle_stack_index.db");
+
+    network_manager_.Start();
+
+    for (uint32_t lane = 0; lane < NUM_LANES; ++lane)
+    {
+      ShardConfig shard{};
+      shard.lane_id             = lane;
+      shard.num_lanes           = NUM_LANES;
+      shard.storage_path        = STORAGE_PATH;
+      shard.external_name       = "127.0.0.1";
+      shard.external_identity   = CreateCertificate();
+      shard.external_port       = static_cast<uint16_t>(BASE_PORT + (2 * lane));
+      shard.external_network_id = NetworkId{(lane & 0xFFFFFFu) | (uint32_t{'L'} << 24u)};
+      shard.internal_name       = "127.0.0.1";
+      shard.internal_identity   = CreateCertificate();
+      shard.internal_port       = static_cast<uint16_t>(BASE_PORT + (2 * lane) + 1);
+      shard.internal_network_id = NetworkId{"ISRD"};
+      shards_.push_back(shard);
+    }
+  }
+
+  void TearDown() override
+  {
+    client_.reset();
+
+    if (client_muddle_)
+    {
+      client_muddle_->Stop();
+    }
+
+    StopLanes();
+
+    network_manager_.Stop();
+  }
+
+  static std::shared_ptr<fetch::crypto::Prover> CreateCertificate()
+  {
+    auto certificate = std::make_shared<fetch::crypto::ECDSASigner>();
+    certificate->GenerateKeys();
+    return certificate;
+  }
+
+  void StartLanes(Mode mode)
+  {
+    lanes_.Setup(network_manager_, shards_, mode);
+    lanes_.StartInternal();
+    started_ = true;
+  }
+
+  void StopLanes()
+  {
+    if (started_)
+    {
+      lanes_.StopExternal();
+      lanes_.StopInternal();
+      started_ = false;
+    }
+  }
+
+  /**
+   * Connects a storage client to the internal servers of every lane
+   *
+   * @return true if every lane is connected, otherwise false
+   */
+  bool ConnectClient()
+  {
+    client_muddle_ = fetch::muddle::CreateMuddle("ISRD", CreateCertificate(), network_manager_,
+                                                 "127.0.0.1");
+    client_muddle_->Start({});
+
+    for (auto const &shard : shards_)
+    {
+      client_muddle_->ConnectTo(shard.internal_identity->identity().identifier(),
+                                Uri{"tcp://127.0.0.1:" + std::to_string(shard.internal_port)});
+    }
+
+    auto const deadline = Clock::now() + 10s;
+    while (client_muddle_->GetNumDirectlyConnectedPeers() < NUM_LANES)
+    {
+      if (Clock::now() >= deadline)
+      {
+        return false;
+      }
+
+      std::this_thread::sleep_for(10ms);
+    }
+
+    client_ = std::make_unique<StorageUnitClient>(client_muddle_->GetEndpoint(), shards_,
+                                                  LOG2_NUM_LANES);
+    return true;
+  }
+
+  NetworkManager                     network_manager_{"NetworkManager", 4};
+  ShardConfigs                       shards_;
+  StorageUnitBundledService          lanes_;
+  MuddlePtr                          client_muddle_;
+  std::unique_ptr<StorageUnitClient> client_;
+  bool                               started_{false};
+};
+
+TEST_F(StorageUnitBundledServiceTests, EveryLaneIsServedOnceStarted)
+{
+  StartLanes(Mode::CREATE_DATABASE);
+
+  ASSERT_TRUE(ConnectClient());
+
+  // the state hash is only available if every lane responds
+  EXPECT_FALSE(client_->CurrentHash().empty());
+  EXPECT_FALSE(client_->Commit(0).empty());
+}
+
+TEST_F(StorageUnitBundledServiceTests, LanesAreRecoveredConcurrently)
+{
+  StartLanes(Mode::CREATE_DATABASE);
+  ASSERT_TRUE(ConnectClient());
+
+  auto const committed = client_->Commit(0);
+  ASSERT_FALSE(committed.empty());
+
+  client_.reset();
+  client_muddle_->Stop();
+  client_muddle_.reset();
+  StopLanes();
+
+  // the lanes reload their state from disk
+  StartLanes(Mode::LOAD_DATABASE);
+  ASSERT_TRUE(ConnectClient());
+
+  EXPECT_EQ(client_->CurrentHash(), committed);
+}
+
+TEST_F(StorageUnitBundledServiceTests, FailedLaneSetupIsReported)
+{
+  // the stores of the last lane can not be created
+  shards_.back().storage_path = "missing-directory/storage_unit_bundled_service_tests";
+
+  EXPECT_ANY_THROW(StartLanes(Mode::CREATE_DATABASE));
+}
+
+}  // namespace
@@ -0,0 +1,310 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/service_ids.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/merkle_tree.hpp"
+#include "ledger/shard_config.hpp"
+#include "ledger/storage_unit/storage_unit_client.hpp"
+#include "muddle/create_muddle_fake.hpp"
+#include "muddle/muddle_interface.hpp"
+#include "muddle/rpc/server.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/service/protocol.hpp"
+#include "network/uri.hpp"
+#include "storage/document_store_protocol.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::MerkleTree;
+using fetch::ledger::ShardConfig;
+using fetch::ledger::ShardConfigs;
+using fetch::ledger::StorageUnitClient;
+using fetch::muddle::MuddlePtr;
+using fetch::network::NetworkManager;
+using fetch::network::Uri;
+using fetch::storage::RevertibleDocumentStoreProtocol;
+
+using Clock        = std::chrono::steady_clock;
+using Milliseconds = std::chrono::milliseconds;
+using ServerPtr    = std::unique_ptr<fetch::muddle::rpc::Server>;
+
+constexpr uint32_t LOG2_NUM_LANES = 2;
+constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr uint16_t BASE_PORT      = 9500;
+
+std::shared_ptr<fetch::crypto::Prover> CreateCertificate()
+{
+  auto certificate = std::make_shared<fetch::crypto::ECDSASigner>();
+  certificate->GenerateKeys();
+  return certificate;
+}
+
+/**
+ * The state database of a lane, which can be made to respond slowly or to fail
+ */
+class FakeLaneProtocol : public fetch::service::Protocol
+{
+public:
+  explicit FakeLaneProtocol(uint32_t lane)
+    : lane_{lane}
+  {
+    Expose(RevertibleDocumentStoreProtocol::COMMIT, this, &FakeLaneProtocol::Commit);
+    Expose(RevertibleDocumentStoreProtocol::REVERT_TO_HASH, this, &FakeLaneProtocol::RevertToHash);
+    Expose(RevertibleDocumentStoreProtocol::CURRENT_HASH, this, &FakeLaneProtocol::CurrentHash);
+  }
+
+  /**
+   * The hash of the state of the lane after the specified number of commits
+   */
+  static ConstByteArray StateHash(uint32_t lane, std::size_t num_commits)
+  {
+    return "lane " + std::to_string(lane) + " commit " + std::to_string(num_commits);
+  }
+
+  std::atomic<uint64_t> delay_ms{0};
+  std::atomic<bool>     fail{false};
+  std::atomic<uint64_t> num_calls{0};
+  std::atomic<uint64_t> num_responses{0};
+
+private:
+  ConstByteArray Commit()
+  {
+    Respond();
+    return StateHash(lane_, ++num_commits_);
+  }
+
+  bool RevertToHash(ConstByteArray const &hash)
+  {
+    Respond();
+    return hash == StateHash(lane_, 1);
+  }
+
+  ConstByteArray CurrentHash()
+  {
+    Respond();
+    return StateHash(lane_, num_commits_);
+  }
+
+  void Respond()
+  {
+    ++num_calls;
+    std::this_thread::sleep_for(Milliseconds{delay_ms.load()});
+    ++num_responses;
+
+    if (fail)
+    {
+      throw std::runtime_error("Lane failure");
+    }
+  }
+
+  uint32_t              lane_;
+  std::atomic<uint32_t> num_commits_{0};
+};
+
+class StorageUnitClientTests : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    fetch::chain::InitialiseTestConstants();
+  }
+
+  void SetUp() override
+  {
+    // the merkle stack of the client is persistent
+    std::remove("merkle_stack.db");
+    std::remove("merkle_stack_index.db");
+
+    network_manager_.Start();
+
+    client_muddle_ = fetch::muddle::CreateMuddleFake("Test", CreateCertificate(),
+                                                     network_manager_, "127.0.0.1");
+    client_muddle_->Start({BASE_PORT});
+
+    ShardConfigs shards{};
+    for (uint32_t lane = 0; lane < NUM_LANES; ++lane)
+    {
+      auto const certificate = CreateCertificate();
+      auto const port        = static_cast<uint16_t>(BASE_PORT + 1 + lane);
+
+      auto muddle = fetch::muddle::CreateMuddleFake("Test", certificate, network_manager_,
+                                                    "127.0.0.1");
+      muddle->Start({port});
+
+      auto server = std::make_unique<fetch::muddle::rpc::Server>(
+          muddle->GetEndpoint(), fetch::SERVICE_LANE_CTRL, fetch::CHANNEL_RPC);
+      lanes_.emplace_back(std::make_unique<FakeLaneProtocol>(lane));
+      server->Add(fetch::RPC_STATE, lanes_.back().get());
+
+      client_muddle_->ConnectTo(certificate->identity().identifier(),
+                                Uri{"tcp://127.0.0.1:" + std::to_string(port)});
+
+      ShardConfig shard{};
+      shard.lane_id           = lane;
+      shard.num_lanes         = NUM_LANES;
+      shard.internal_identity = certificate;
+      shards.push_back(shard);
+
+      lane_muddles_.push_back(std::move(muddle));
+      servers_.push_back(std::move(server));
+    }
+
+    auto const deadline = Clock::now() + 10s;
+    while (client_muddle_->GetNumDirectlyConnectedPeers() < NUM_LANES)
+    {
+      ASSERT_LT(Clock::now(), deadline);
+      std::this_thread::sleep_for(10ms);
+    }
+
+    client_ = std::make_unique<StorageUnitClient>(client_muddle_->GetEndpoint(), shards,
+                                                  LOG2_NUM_LANES);
+  }
+
+  void TearDown() override
+  {
+    // slow lanes may still be handling requests the client has stopped waiting for
+    for (auto const &lane : lanes_)
+    {
+      while (lane->num_responses < lane->num_calls)
+      {
+        std::this_thread::sleep_for(10ms);
+      }
+    }
+
+    client_.reset();
+    servers_.clear();
+
+    for (auto &muddle : lane_muddles_)
+    {
+      muddle->Stop();
+    }
+    client_muddle_->Stop();
+
+    network_manager_.Stop();
+  }
+
+  /**
+   * The state hash expected from the lanes after the specified number of commits
+   */
+  static ConstByteArray ExpectedHash(std::size_t num_commits)
+  {
+    MerkleTree tree{NUM_LANES};
+    for (uint32_t lane = 0; lane < NUM_LANES; ++lane)
+    {
+      tree[lane] = FakeLaneProtocol::StateHash(lane, num_commits);
+    }
+    tree.CalculateRoot();
+
+    return tree.root();
+  }
+
+  NetworkManager                                 network_manager_{"NetworkManager", 8};
+  MuddlePtr                                      client_muddle_;
+  std::vector<MuddlePtr>                         lane_muddles_;
+  std::vector<ServerPtr>                         servers_;
+  std::vector<std::unique_ptr<FakeLaneProtocol>> lanes_;
+  std::unique_ptr<StorageUnitClient>             client_;
+};
+
+TEST_F(StorageUnitClientTests, CurrentHashIsTheRootOfTheLaneHashes)
+{
+  EXPECT_EQ(client_->CurrentHash(), ExpectedHash(0));
+}
+
+TEST_F(StorageUnitClientTests, LaneHashesAreKeptInLaneOrder)
+{
+  // the first lane responds last
+  lanes_[0]->delay_ms = 200;
+
+  EXPECT_EQ(client_->Commit(0), ExpectedHash(1));
+  EXPECT_EQ(client_->CurrentHash(), ExpectedHash(1));
+}
+
+TEST_F(StorageUnitClientTests, FailedLaneIsReportedBeforeSlowerLanesRespond)
+{
+  lanes_[0]->delay_ms = 1500;
+  lanes_[NUM_LANES - 1]->fail = true;
+
+  auto const start = Clock::now();
+  EXPECT_TRUE(client_->CurrentHash().empty());
+  EXPECT_LT(Clock::now() - start, 1s);
+}
+
+TEST_F(StorageUnitClientTests, FailedCommitIsReportedBeforeSlowerLanesRespond)
+{
+  lanes_[0]->delay_ms = 1500;
+  lanes_[1]->fail     = true;
+
+  auto const start = Clock::now();
+  EXPECT_TRUE(client_->Commit(0).empty());
+  EXPECT_LT(Clock::now() - start, 1s);
+  EXPECT_FALSE(client_->HashExists(ExpectedHash(1), 0));
+}
+
+TEST_F(StorageUnitClientTests, CommittedStateCanBeRestored)
+{
+  auto const first = client_->Commit(0);
+  ASSERT_EQ(first, ExpectedHash(1));
+  ASSERT_EQ(client_->Commit(1), ExpectedHash(2));
+
+  lanes_[2]->delay_ms = 200;
+
+  EXPECT_TRUE(client_->RevertToHash(first, 0));
+  EXPECT_EQ(client_->LastCommitHash(), first);
+  EXPECT_FALSE(client_->HashExists(ExpectedHash(2), 1));
+}
+
+TEST_F(StorageUnitClientTests, RevertWaitsForEveryLaneWhenOneFails)
+{
+  auto const first = client_->Commit(0);
+  ASSERT_EQ(first, ExpectedHash(1));
+  ASSERT_EQ(client_->Commit(1), ExpectedHash(2));
+
+  lanes_[0]->delay_ms = 200;
+  lanes_[3]->fail     = true;
+
+  EXPECT_FALSE(client_->RevertToHash(first, 0));
+
+  // every lane has been asked to revert and the committed state is unchanged
+  for (auto const &lane : lanes_)
+  {
+    EXPECT_EQ(lane->num_calls, 3u);
+  }
+  EXPECT_TRUE(client_->HashExists(ExpectedHash(2), 1));
+}
+
+}  // namespace
@@ -0,0 +1,238 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "core/random/lcg.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/chaincode/smart_contract_manager.hpp"
+#include "ledger/chaincode/smart_contract_wrapper.hpp"
+#include "ledger/storage_unit/fake_storage_unit.hpp"
+#include "ledger/upow/synergetic_executor.hpp"
+#include "ledger/upow/work.hpp"
+#include "ledger/upow/work_queue.hpp"
+#include "storage/resource_mapper.hpp"
+#include "telemetry/registry.hpp"
+#include "random_address.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::chain::Address;
+using fetch::ledger::FakeStorageUnit;
+using fetch::ledger::SmartContractManager;
+using fetch::ledger::SmartContractWrapper;
+using fetch::ledger::SynergeticExecutor;
+using fetch::ledger::Work;
+using fetch::ledger::WorkQueue;
+using fetch::ledger::WorkScore;
+using fetch::random::LinearCongruentialGenerator;
+using fetch::serializers::MsgPackSerializer;
+using fetch::storage::ResourceAddress;
+
+using ProblemData = std::vector<ConstByteArray>;
+
+// the score of every solution is the sum of the problem values, each accepted solution adds it to
+// the stored total
+char const *CONTRACT_SOURCE = R"(
+persistent solution : Int32;
+
+@problem
+function createProblem(data : Array<StructuredData>) : Int32
+  var value = 0;
+  for (i in 0:data.count())
+    value += data[i].getInt32("value");
+  endfor
+  return value;
+endfunction
+
+@objective
+function evaluateWork(problem : Int32, solution : Int32 ) : Int64
+  return abs(toInt64(problem));
+endfunction
+
+@work
+function doWork(problem : Int32, nonce : UInt256) :  Int32
+  return problem;
+endfunction
+
+@clear
+function applyWork(problem : Int32, new_solution : Int32)
+  use solution;
+
+  solution.set(solution.get(0) + new_solution);
+endfunction
+)";
+
+constexpr WorkScore VALID_SCORE   = 10;
+constexpr WorkScore INVALID_SCORE = 1;
+
+class SynergeticExecutorTests : public ::testing::TestWithParam<std::size_t>
+{
+protected:
+  static void SetUpTestCase()
+  {
+    fetch::chain::InitialiseTestConstants();
+
+    // the executor expects the synergetic execution manager to have created its metrics
+    auto &registry = fetch::telemetry::Registry::Instance();
+    registry.CreateHistogram({0.001, 1.0}, "ledger_synergetic_executor_deduct_fees_duration", "");
+    registry.CreateHistogram({0.001, 1.0}, "ledger_synergetic_executor_work_duration", "");
+    registry.CreateHistogram({0.001, 1.0}, "ledger_synergetic_executor_complete_duration", "");
+  }
+
+  void SetUp() override
+  {
+    contract_address_ = GenerateRandomAddress(rng_);
+    miner_            = GenerateRandomAddress(rng_);
+
+    // deploy the contract
+    MsgPackSerializer buffer{};
+    buffer << SmartContractWrapper{CONTRACT_SOURCE, 0};
+    storage_.Set(SmartContractManager::CreateAddressForContract(contract_address_),
+                 buffer.data());
+
+    executor_ = std::make_unique<SynergeticExecutor>(storage_, GetParam());
+  }
+
+  /**
+   * Queue a solution, invalid solutions claim a better score than the one they achieve and so are
+   * verified first
+   */
+  void AddWork(bool valid)
+  {
+    auto work = std::make_shared<Work>(contract_address_, GenerateRandomIdentity(rng_));
+    work->UpdateNonce(Work::UInt256{nonce_++});
+    work->UpdateScore(valid ? VALID_SCORE : INVALID_SCORE);
+
+    queue_.push(work);
+  }
+
+  void Verify()
+  {
+    executor_->Verify(queue_, problem_data_, 1, miner_);
+  }
+
+  /**
+   * The stored total of the accepted solutions, or -1 when none has been accepted
+   */
+  int32_t Total()
+  {
+    auto const document =
+        storage_.Get(ResourceAddress{contract_address_.display() + ".state.solution"});
+    if (document.failed)
+    {
+      return -1;
+    }
+
+    // primitive state is stored as its raw bytes
+    int32_t total{0};
+    EXPECT_EQ(document.document.size(), sizeof(total));
+    std::memcpy(&total, document.document.pointer(), sizeof(total));
+
+    return total;
+  }
+
+  LinearCongruentialGenerator         rng_{};
+  FakeStorageUnit                     storage_{};
+  std::unique_ptr<SynergeticExecutor> executor_{};
+  Address                             contract_address_{};
+  Address                             miner_{};
+  WorkQueue                           queue_{};
+  ProblemData                         problem_data_{R"({"value": 4})", R"({"value": 6})"};
+  uint64_t                            nonce_{1};
+};
+
+TEST_P(SynergeticExecutorTests, ValidSolutionIsApplied)
+{
+  AddWork(true);
+  Verify();
+
+  EXPECT_TRUE(queue_.empty());
+  EXPECT_EQ(Total(), VALID_SCORE);
+}
+
+TEST_P(SynergeticExecutorTests, OnlyTheFirstValidSolutionIsApplied)
+{
+  for (std::size_t i = 0; i < 6; ++i)
+  {
+    AddWork(true);
+  }
+  Verify();
+
+  EXPECT_EQ(Total(), VALID_SCORE);
+}
+
+TEST_P(SynergeticExecutorTests, InvalidSolutionInABatchIsSkipped)
+{
+  // the invalid solutions are scored in the same batch as the valid one that follows them
+  AddWork(false);
+  AddWork(false);
+  AddWork(true);
+  AddWork(true);
+  Verify();
+
+  EXPECT_EQ(Total(), VALID_SCORE);
+}
+
+TEST_P(SynergeticExecutorTests, ValidSolutionAfterSeveralBatchesIsApplied)
+{
+  for (std::size_t i = 0; i < 9; ++i)
+  {
+    AddWork(false);
+  }
+  AddWork(true);
+  Verify();
+
+  EXPECT_EQ(Total(), VALID_SCORE);
+}
+
+TEST_P(SynergeticExecutorTests, NothingIsAppliedWithoutAValidSolution)
+{
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    AddWork(false);
+  }
+  Verify();
+
+  EXPECT_TRUE(queue_.empty());
+  EXPECT_EQ(Total(), -1);
+}
+
+TEST_P(SynergeticExecutorTests, NothingIsAppliedForInvalidProblemData)
+{
+  problem_data_ = {"not json"};
+
+  AddWork(false);
+  AddWork(true);
+  Verify();
+
+  // the unparsable data is ignored, so the score claimed by the valid solution is not achieved
+  EXPECT_EQ(Total(), -1);
+}
+
+INSTANTIATE_TEST_CASE_P(ScoringThreads, SynergeticExecutorTests, ::testing::Values(1u, 2u, 4u), );
+
+}  // namespace
@@ -0,0 +1,60 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/upow/synergetic_problem_cache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+
+using fetch::Digest;
+using fetch::ledger::SynergeticProblemCache;
+
+TEST(SynergeticProblemCacheTests, EntriesAreKeptPerContract)
+{
+  SynergeticProblemCache cache{};
+
+  auto &entry  = cache.Lookup(Digest{"contract-a"});
+  entry.charge = 42;
+  entry.data.emplace_back("data");
+
+  EXPECT_EQ(cache.Lookup(Digest{"contract-a"}).charge, 42);
+  EXPECT_EQ(cache.Lookup(Digest{"contract-a"}).data.size(), 1);
+  EXPECT_EQ(cache.Lookup(Digest{"contract-b"}).charge, 0);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(SynergeticProblemCacheTests, LeastRecentlyUsedContractIsEvicted)
+{
+  SynergeticProblemCache cache{2};
+
+  cache.Lookup(Digest{"contract-a"}).charge = 1;
+  cache.Lookup(Digest{"contract-b"}).charge = 2;
+
+  // contract a is used again, so contract b is the one evicted
+  EXPECT_EQ(cache.Lookup(Digest{"contract-a"}).charge, 1);
+  cache.Lookup(Digest{"contract-c"}).charge = 3;
+
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.Lookup(Digest{"contract-a"}).charge, 1);
+  EXPECT_EQ(cache.Lookup(Digest{"contract-b"}).charge, 0);
+}
+
+}  // namespace
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "chain/transaction_rpc_serializers.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/compression/lz4.hpp"
+#include "core/random/lcg.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/ecdsa.hpp"
+#include "muddle/compression_dictionary.hpp"
+#include "muddle/router_configuration.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::chain::Address;
+using fetch::chain::Transaction;
+using fetch::chain::TransactionBuilder;
+using fetch::compression::LZ4Compress;
+using fetch::compression::LZ4Decompress;
+using fetch::crypto::ECDSASigner;
+using fetch::muddle::RouterConfiguration;
+using fetch::muddle::TransactionCompressionDictionary;
+using fetch::random::LinearCongruentialGenerator;
+using fetch::serializers::MsgPackSerializer;
+
+ConstByteArray GenerateBatch(LinearCongruentialGenerator &rng, std::size_t count)
+{
+  std::vector<Transaction> batch{};
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ECDSASigner from{};
+    ECDSASigner to{};
+
+    auto const block_index = 10000 + (rng() % 100000);
+
+    TransactionBuilder builder{};
+    builder.From(Address{from.identity()})
+        .ValidFrom(block_index)
+        .ValidUntil(block_index + 1000)
+        .ChargeRate(1)
+        .ChargeLimit(10000 + (rng() % 10000))
+        .Counter(rng())
+        .Signer(from.identity());
+
+    if ((i % 2) == 0)
+    {
+      builder.Transfer(Address{to.identity()}, 1 + (rng() % 1000000));
+    }
+    else
+    {
+      BitVector mask{16};
+      mask.set(rng() % 16, 1);
+
+      builder.TargetChainCode("fetch.token", mask).Action("transfer");
+    }
+
+    batch.emplace_back(*builder.Seal().Sign(from).Build());
+  }
+
+  MsgPackSerializer serializer{};
+  serializer << batch;
+
+  return serializer.data();
+}
+
+TEST(TransactionCompressionTests, CheckRouterIsConfiguredWithTheShippedDictionary)
+{
+  RouterConfiguration const config{};
+
+  EXPECT_FALSE(TransactionCompressionDictionary().empty());
+  EXPECT_EQ(config.compression_dictionary, TransactionCompressionDictionary());
+}
+
+TEST(TransactionCompressionTests, CheckDictionaryImprovesTransactionCompression)
+{
+  LinearCongruentialGenerator rng{};
+  auto const &dictionary = TransactionCompressionDictionary();
+
+  std::size_t plain_size{0};
+  std::size_t dictionary_size{0};
+  for (std::size_t i = 0; i < 20; ++i)
+  {
+    auto const payload    = GenerateBatch(rng, 1 + (i % 8));
+    auto const plain      = LZ4Compress(payload);
+    auto const compressed = LZ4Compress(payload, dictionary);
+
+    ByteArray output{};
+    ASSERT_TRUE(LZ4Decompress(compressed, payload.size(), output, dictionary));
+    EXPECT_EQ(ConstByteArray{output}, payload);
+
+    plain_size += plain.size();
+    dictionary_size += compressed.size();
+  }
+
+  EXPECT_LT(dictionary_size, plain_size);
+}
+
+}  // namespace
@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/digest.hpp"
+#include "ledger/miner/transaction_layout_index.hpp"
+#include "tx_generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::DigestSet;
+using fetch::chain::TransactionLayout;
+using fetch::ledger::TransactionLayoutIndex;
+using TransactionLayoutIndexPtr = std::unique_ptr<TransactionLayoutIndex>;
+
+class TransactionLayoutIndexTests : public ::testing::Test
+{
+protected:
+  static constexpr uint32_t LOG2_NUM_LANES = 2;
+  static constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+
+  void SetUp() override
+  {
+    index_ = std::make_unique<TransactionLayoutIndex>(NUM_LANES);
+    generator_.Seed();
+  }
+
+  static TransactionLayout Make(TransactionLayout const &       base,
+                                std::initializer_list<uint32_t> lanes, uint64_t charge_rate,
+                                uint64_t valid_until = 1000)
+  {
+    BitVector mask{NUM_LANES};
+    for (auto const lane : lanes)
+    {
+      mask.set(lane, 1);
+    }
+
+    return {base.digest(), mask, charge_rate, 1, valid_until};
+  }
+
+  TransactionLayout Make(std::initializer_list<uint32_t> lanes, uint64_t charge_rate,
+                         uint64_t valid_until = 1000)
+  {
+    return Make(generator_(0), lanes, charge_rate, valid_until);
+  }
+
+  TransactionLayoutIndexPtr index_;
+  TransactionGenerator      generator_{LOG2_NUM_LANES};
+};
+
+bool Contains(TransactionLayoutIndex::Layouts const &layouts, TransactionLayout const &layout)
+{
+  return std::find(layouts.begin(), layouts.end(), layout) != layouts.end();
+}
+
+TEST_F(TransactionLayoutIndexTests, CheckAdditionsAndRemovals)
+{
+  auto const tx1 = generator_(2);
+  auto const tx2 = generator_(2);
+  auto const tx3 = generator_(2);
+
+  EXPECT_TRUE(index_->empty());
+  EXPECT_TRUE(index_->Add(tx1));
+  EXPECT_TRUE(index_->Add(tx2));
+  EXPECT_TRUE(index_->Add(tx3));
+  EXPECT_FALSE(index_->Add(tx2));
+
+  EXPECT_EQ(index_->size(), 3u);
+  EXPECT_TRUE(index_->Contains(tx1.digest()));
+
+  EXPECT_TRUE(index_->Remove(tx1.digest()));
+  EXPECT_FALSE(index_->Remove(tx1.digest()));
+  EXPECT_FALSE(index_->Contains(tx1.digest()));
+
+  EXPECT_EQ(index_->Remove(DigestSet{tx1.digest(), tx2.digest(), tx3.digest()}), 2u);
+  EXPECT_TRUE(index_->empty());
+}
+
+TEST_F(TransactionLayoutIndexTests, CheckIncompatibleMaskRejection)
+{
+  TransactionGenerator other{LOG2_NUM_LANES + 1};
+
+  EXPECT_FALSE(index_->Add(other(2)));
+  EXPECT_TRUE(index_->empty());
+}
+
+TEST_F(TransactionLayoutIndexTests, CheckTopIsOrderedByFee)
+{
+  auto const low    = Make({0}, 10);
+  auto const high   = Make({1}, 30);
+  auto const medium = Make({2}, 20);
+
+  index_->Add(low);
+  index_->Add(high);
+  index_->Add(medium);
+
+  auto const top = index_->Top(2, 1);
+  ASSERT_EQ(top.size(), 2u);
+  EXPECT_EQ(top[0], high);
+  EXPECT_EQ(top[1], medium);
+}
+
+TEST_F(TransactionLayoutIndexTests, CheckExpiredRemoval)
+{
+  auto const early = Make({0}, 10, 10);
+  auto const late  = Make({1}, 10, 20);
+
+  index_->Add(early);
+  index_->Add(late);
+
+  EXPECT_EQ(index_->RemoveExpired(9), 0u);
+  EXPECT_EQ(index_->RemoveExpired(10), 1u);
+  EXPECT_FALSE(index_->Contains(early.digest()));
+  EXPECT_TRUE(index_->Contains(late.digest()));
+}
+
+TEST_F(TransactionLayoutIndexTests, CheckPackingPrefersFeesWithoutConflicts)
+{
+  auto const wide     = Make({0, 1}, 50);
+  auto const narrow   = Make({1}, 40);
+  auto const conflict = Make({0, 2}, 30);
+  auto const other    = Make({3}, 20);
+  auto const free     = Make({}, 10);
+  auto const pending  = Make(generator_(0), {2}, 60);
+
+  for (auto const &layout : {wide, narrow, conflict, other, free})
+  {
+    index_->Add(layout);
+  }
+
+  // a layout which only becomes valid in the future must not be packed
+  index_->Add({pending.digest(), pending.mask(), pending.charge_rate(), 100, 1000});
+
+  TransactionLayoutIndex::Layouts slice{};
+  EXPECT_EQ(index_->PackSlice(slice, 1), 3u);
+
+  EXPECT_TRUE(Contains(slice, wide));
+  EXPECT_TRUE(Contains(slice, other));
+  EXPECT_TRUE(Contains(slice, free));
+
+  // the packed layouts are removed from the index, the others remain
+  EXPECT_EQ(index_->size(), 3u);
+  EXPECT_TRUE(index_->Contains(narrow.digest()));
+  EXPECT_TRUE(index_->Contains(conflict.digest()));
+  EXPECT_TRUE(index_->Contains(pending.digest()));
+
+  // ensure there are no collisions in the slice
+  BitVector lanes{NUM_LANES};
+  for (auto const &layout : slice)
+  {
+    EXPECT_EQ((lanes & layout.mask()).PopCount(), 0u);
+    lanes |= layout.mask();
+  }
+
+  // the next slice picks up the remaining valid layouts
+  TransactionLayoutIndex::Layouts next_slice{};
+  EXPECT_EQ(index_->PackSlice(next_slice, 1), 2u);
+  EXPECT_TRUE(Contains(next_slice, narrow));
+  EXPECT_TRUE(Contains(next_slice, conflict));
+}
+
+TEST_F(TransactionLayoutIndexTests, CheckObservedMaskNarrowsPacking)
+{
+  auto const first  = Make({0, 1, 2, 3}, 30);
+  auto const second = Make({0, 1, 2, 3}, 20);
+  auto const third  = Make({1, 2}, 10);
+
+  for (auto const &layout : {first, second, third})
+  {
+    index_->Add(layout);
+  }
+
+  auto const unobserved = index_->Unobserved(10);
+  ASSERT_EQ(unobserved.size(), 3u);
+  EXPECT_EQ(unobserved[0], first);
+  EXPECT_EQ(unobserved[2], third);
+
+  BitVector lane0{NUM_LANES};
+  lane0.set(0, 1);
+  BitVector lane1{NUM_LANES};
+  lane1.set(1, 1);
+  BitVector lane3{NUM_LANES};
+  lane3.set(3, 1);
+
+  // the observed mask must be a subset of the declared mask
+  EXPECT_FALSE(index_->SetObservedMask(third.digest(), lane0));
+  EXPECT_FALSE(index_->SetObservedMask(third.digest(), BitVector{NUM_LANES * 2}));
+
+  EXPECT_TRUE(index_->SetObservedMask(first.digest(), lane0));
+  EXPECT_TRUE(index_->SetObservedMask(second.digest(), lane3));
+  EXPECT_TRUE(index_->SetObservedMask(third.digest(), lane1));
+  EXPECT_TRUE(index_->Unobserved(10).empty());
+
+  // all three now fit into a single slice, with their declared masks unchanged
+  TransactionLayoutIndex::Layouts slice{};
+  EXPECT_EQ(index_->PackSlice(slice, BitVector{NUM_LANES}, 1), 3u);
+  EXPECT_TRUE(Contains(slice, first));
+  EXPECT_TRUE(Contains(slice, second));
+  EXPECT_TRUE(Contains(slice, third));
+  EXPECT_TRUE(index_->empty());
+}
+
+}  // namespace
@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "ledger/transaction_stream.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::ledger::TransactionStreamReader;
+using fetch::ledger::TransactionStreamWriter;
+
+TEST(TransactionStreamTests, CheckTransactionsAreReadInOrder)
+{
+  std::vector<ConstByteArray> const encoded_txs = {"first", "", ByteArray(std::string(300, 'x'))};
+
+  TransactionStreamWriter writer;
+  for (auto const &encoded_tx : encoded_txs)
+  {
+    writer.Append(encoded_tx);
+  }
+
+  EXPECT_EQ(writer.stream().size(), (3 * TransactionStreamWriter::PREFIX_LENGTH) + 305);
+
+  // the length prefix is big endian
+  EXPECT_EQ(writer.stream().SubArray(0, 4), ConstByteArray(std::string("\0\0\0\5", 4)));
+
+  TransactionStreamReader reader{writer.stream()};
+
+  ConstByteArray              encoded_tx;
+  std::vector<ConstByteArray> decoded;
+  while (reader.Next(encoded_tx))
+  {
+    decoded.push_back(encoded_tx);
+  }
+
+  EXPECT_EQ(decoded, encoded_txs);
+  EXPECT_FALSE(reader.is_truncated());
+}
+
+TEST(TransactionStreamTests, CheckTruncatedStreamIsDetected)
+{
+  TransactionStreamWriter writer;
+  writer.Append("complete");
+  writer.Append("incomplete");
+
+  auto const &stream = writer.stream();
+
+  // truncate both within the payload and within the length prefix of the last transaction
+  for (std::size_t const length : {stream.size() - 1, std::size_t{14}})
+  {
+    TransactionStreamReader reader{stream.SubArray(0, length)};
+
+    ConstByteArray encoded_tx;
+    ASSERT_TRUE(reader.Next(encoded_tx));
+    EXPECT_EQ(encoded_tx, ConstByteArray{"complete"});
+
+    EXPECT_FALSE(reader.Next(encoded_tx));
+    EXPECT_TRUE(reader.is_truncated());
+  }
+}
+
+}  // namespace
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/digest.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/transaction_tracer.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::Digest;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Block;
+using fetch::ledger::TraceStage;
+using fetch::ledger::TransactionTracer;
+
+Digest CreateDigest(uint8_t value)
+{
+  ByteArray digest;
+  digest.Resize(32);
+  for (std::size_t i = 0; i < digest.size(); ++i)
+  {
+    digest[i] = value;
+  }
+
+  return digest;
+}
+
+class TransactionTracerTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    tracer_.Clear();
+    tracer_.SetSampleInterval(1);
+  }
+
+  void TearDown() override
+  {
+    tracer_.SetSampleInterval(0);
+    tracer_.Clear();
+  }
+
+  TransactionTracer &tracer_{TransactionTracer::Instance()};
+};
+
+TEST_F(TransactionTracerTests, CheckNothingIsRecordedWhenDisabled)
+{
+  tracer_.SetSampleInterval(0);
+  tracer_.Record(CreateDigest(1), TraceStage::SUBMITTED);
+
+  EXPECT_FALSE(tracer_.IsSampled(CreateDigest(1)));
+  EXPECT_TRUE(tracer_.Recent().empty());
+}
+
+TEST_F(TransactionTracerTests, CheckStagesAreRecordedInOrder)
+{
+  auto const digest = CreateDigest(1);
+  auto const other  = CreateDigest(2);
+
+  tracer_.Record(digest, TraceStage::SUBMITTED);
+  tracer_.Record(other, TraceStage::SUBMITTED);
+  tracer_.Record(digest, TraceStage::VERIFIED);
+  tracer_.Record(digest, TraceStage::STORED);
+
+  auto const events = tracer_.Lookup(digest);
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].stage, TraceStage::SUBMITTED);
+  EXPECT_EQ(events[1].stage, TraceStage::VERIFIED);
+  EXPECT_EQ(events[2].stage, TraceStage::STORED);
+  EXPECT_LE(events[0].timestamp, events[2].timestamp);
+
+  EXPECT_EQ(tracer_.Recent().size(), 4u);
+}
+
+TEST_F(TransactionTracerTests, CheckTransactionsAreSampledByDigest)
+{
+  tracer_.SetSampleInterval(2);
+
+  // the sample is selected on the leading bytes of the digest
+  EXPECT_TRUE(tracer_.IsSampled(CreateDigest(0)));
+  EXPECT_FALSE(tracer_.IsSampled(CreateDigest(1)));
+  EXPECT_TRUE(tracer_.IsSampled(CreateDigest(2)));
+
+  tracer_.Record(CreateDigest(1), TraceStage::SUBMITTED);
+  tracer_.Record(CreateDigest(2), TraceStage::SUBMITTED);
+
+  auto const events = tracer_.Recent();
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].digest, CreateDigest(2));
+}
+
+TEST_F(TransactionTracerTests, CheckBlockTransactionsAreRecorded)
+{
+  Block block{};
+  block.slices.resize(2);
+  block.slices[0].emplace_back(CreateDigest(1), fetch::BitVector{}, 1, 0, 100);
+  block.slices[1].emplace_back(CreateDigest(2), fetch::BitVector{}, 1, 0, 100);
+
+  tracer_.Record(block, TraceStage::PACKED);
+
+  EXPECT_EQ(tracer_.Lookup(CreateDigest(1)).size(), 1u);
+  EXPECT_EQ(tracer_.Lookup(CreateDigest(2)).size(), 1u);
+}
+
+TEST_F(TransactionTracerTests, CheckEventsAreCollectedFromAllThreads)
+{
+  auto const digest = CreateDigest(3);
+
+  tracer_.Record(digest, TraceStage::SUBMITTED);
+
+  std::thread worker{[this, &digest]() { tracer_.Record(digest, TraceStage::VERIFIED); }};
+  worker.join();
+
+  tracer_.Record(digest, TraceStage::STORED);
+
+  auto const events = tracer_.Lookup(digest);
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[1].stage, TraceStage::VERIFIED);
+}
+
+TEST_F(TransactionTracerTests, CheckThreadBuffersOnlyRetainTheMostRecentEvents)
+{
+  for (std::size_t i = 0; i < TransactionTracer::RING_BUFFER_SIZE; ++i)
+  {
+    tracer_.Record(CreateDigest(1), TraceStage::SUBMITTED);
+  }
+  tracer_.Record(CreateDigest(2), TraceStage::SUBMITTED);
+
+  auto const events = tracer_.Recent();
+  ASSERT_EQ(events.size(), TransactionTracer::RING_BUFFER_SIZE);
+  EXPECT_EQ(events.back().digest, CreateDigest(2));
+  EXPECT_EQ(tracer_.Lookup(CreateDigest(1)).size(), TransactionTracer::RING_BUFFER_SIZE - 1);
+}
+
+}  // namespace
@@ -19,6 +19,8 @@
 
 #include "logging/backtrace.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -76,6 +78,18 @@ enum class LogLevel
 
 using LogLevelMap = std::unordered_map<std::string, LogLevel>;
 
+/**
+ * Configuration of the asynchronous logging backend
+ */
+struct AsyncLogConfig
+{
+  /// Number of records each logging thread can have pending (rounded up to a power of two)
+  std::size_t buffer_size{8192};
+
+  /// Records at or above this level wait for space instead of being dropped when a buffer is full
+  LogLevel blocking_level{LogLevel::WARNING};
+};
+
 /// @name Log Library Functions
 /// @{
 
@@ -105,6 +119,46 @@ void Log(LogLevel level, char const *name, std::string &&message);
  */
 LogLevelMap GetLogLevelMap();
 
+/**
+ * Determine if a message at the specified level could be emitted by any logger
+ *
+ * This is a lock free check used to avoid formatting messages that will be discarded
+ *
+ * @param level The level of the log message
+ * @return true if the message might be emitted, otherwise false
+ */
+bool IsLogLevelActive(LogLevel level);
+
+/**
+ * Switch to asynchronous logging
+ *
+ * Messages are queued in a per-thread lock free buffer and written by a background thread, so
+ * logging threads no longer serialise on the output. Messages from different threads are only
+ * ordered relative to each other when they are written. When a buffer is full, messages below
+ * the configured blocking level are dropped and counted. Calling this when asynchronous logging
+ * is already enabled has no effect.
+ *
+ * @param config The configuration of the backend
+ */
+void EnableAsyncLogging(AsyncLogConfig const &config = AsyncLogConfig{});
+
+/**
+ * Switch back to synchronous logging, writing out any messages that are still queued
+ */
+void DisableAsyncLogging();
+
+/**
+ * Write out all messages currently queued by the asynchronous backend
+ */
+void FlushLogs();
+
+/**
+ * Retrieve the number of messages dropped by the asynchronous backend since startup
+ *
+ * @return The number of dropped messages
+ */
+uint64_t GetDroppedLogCount();
+
 /// @}
 
 /// @name Helper Wrappers
@@ -113,37 +167,55 @@ LogLevelMap GetLogLevelMap();
 template <typename... Args>
 void LogTraceV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::TRACE, name, detail::Format(std::forward<Args>(args)...));
+  if (IsLogLevelActive(LogLevel::TRACE))
+  {
+    Log(LogLevel::TRACE, name, detail::Format(std::forward<Args>(args)...));
+  }
 }
 
 template <typename... Args>
 void LogDebugV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::DEBUG, name, detail::Format(std::forward<Args>(args)...));
+  if (IsLogLevelActive(LogLevel::DEBUG))
+  {
+    Log(LogLevel::DEBUG, name, detail::Format(std::forward<Args>(args)...));
+  }
 }
 
 template <typename... Args>
 void LogInfoV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::INFO, name, detail::Format(std::forward<Args>(args)...));
+  if (IsLogLevelActive(LogLevel::INFO))
+  {
+    Log(LogLevel::INFO, name, detail::Format(std::forward<Args>(args)...));
+  }
 }
 
 template <typename... Args>
 void LogWarningV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::WARNING, name, detail::Format(std::forward<Args>(args)...));
+  if (IsLogLevelActive(LogLevel::WARNING))
+  {
+    Log(LogLevel::WARNING, name, detail::Format(std::forward<Args>(args)...));
+  }
 }
 
 template <typename... Args>
 void LogErrorV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::ERROR, name, detail::Format(std::forward<Args>(args)...));
+  if (IsLogLevelActive(LogLevel::ERROR))
+  {
+    Log(LogLevel::ERROR, name, detail::Format(std::forward<Args>(args)...));
+  }
 }
 
 template <typename... Args>
 void LogCriticalV2(char const *name, Args &&... args)
 {
-  Log(LogLevel::CRITICAL, name, detail::Format(std::forward<Args>(args)...));
+  if (IsLogLevelActive(LogLevel::CRITICAL))
+  {
+    Log(LogLevel::CRITICAL, name, detail::Format(std::forward<Args>(args)...));
+  }
 }
 
 /// @}
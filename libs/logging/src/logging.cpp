@@ -40,8 +40,19 @@
 
 #include "logging/logging.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #ifdef FETCH_ENABLE_BACKTRACE
 
@@ -55,6 +66,122 @@ backward::SignalHandling         sh([](std::string const &fatal_msg) {
 namespace fetch {
 namespace {
 
+struct LogRecord
+{
+  LogLevel    level{LogLevel::INFO};
+  std::string name{};
+  std::string message{};
+};
+
+using LogRecords = std::vector<LogRecord>;
+
+/**
+ * Bounded single producer, single consumer queue of log records. Each logging thread owns one
+ * buffer and the writer thread is the only consumer, so neither side takes a lock.
+ */
+class RecordBuffer
+{
+public:
+  explicit RecordBuffer(std::size_t capacity);
+  RecordBuffer(RecordBuffer const &) = delete;
+  RecordBuffer(RecordBuffer &&)      = delete;
+  ~RecordBuffer()                    = default;
+
+  bool Push(LogRecord &&record);
+  void PopAll(LogRecords &records);
+
+  /// Called by the owning thread when it exits, after which the buffer can be discarded
+  void Close()
+  {
+    closed_.store(true, std::memory_order_release);
+  }
+
+  bool IsClosed() const
+  {
+    return closed_.load(std::memory_order_acquire);
+  }
+
+  // Operators
+  RecordBuffer &operator=(RecordBuffer const &) = delete;
+  RecordBuffer &operator=(RecordBuffer &&) = delete;
+
+private:
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+  struct Index
+  {
+    std::atomic<std::size_t> value{0};
+    uint8_t                  padding[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+  };
+
+  std::vector<LogRecord> slots_;
+  std::size_t            mask_;
+  Index                  head_{};  ///< Next slot to be read, only advanced by the writer
+  Index                  tail_{};  ///< Next slot to be written, only advanced by the owner
+  std::atomic<bool>      closed_{false};
+};
+
+/**
+ * Background writer for the asynchronous logging mode
+ */
+class AsyncWriter
+{
+public:
+  using Sink = std::function<void(LogRecords &)>;
+
+  explicit AsyncWriter(Sink sink);
+  AsyncWriter(AsyncWriter const &) = delete;
+  AsyncWriter(AsyncWriter &&)      = delete;
+  ~AsyncWriter();
+
+  void Start(AsyncLogConfig const &config);
+  void Stop();
+  bool Submit(LogRecord &&record);
+  void Flush();
+
+  bool IsRunning() const
+  {
+    return running_.load(std::memory_order_acquire);
+  }
+
+  uint64_t dropped() const
+  {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  // Operators
+  AsyncWriter &operator=(AsyncWriter const &) = delete;
+  AsyncWriter &operator=(AsyncWriter &&) = delete;
+
+private:
+  using BufferPtr = std::shared_ptr<RecordBuffer>;
+  using Buffers   = std::vector<BufferPtr>;
+
+  static constexpr std::chrono::milliseconds FLUSH_INTERVAL{10};
+
+  RecordBuffer &LocalBuffer();
+  void          Wake();
+  void          ThreadLoop();
+  std::size_t   Drain();
+
+  Sink                     sink_;
+  std::atomic<bool>        running_{false};
+  std::atomic<uint64_t>    generation_{0};
+  std::atomic<uint64_t>    dropped_{0};
+  std::atomic<std::size_t> buffer_size_{0};
+  std::atomic<LogLevel>    blocking_level_{LogLevel::WARNING};
+
+  std::mutex control_lock_;  ///< Serialises starting and stopping the writer
+  std::mutex buffers_lock_;
+  Buffers    buffers_;
+
+  std::mutex              drain_lock_;  ///< Serialises consumers of the buffers
+  LogRecords              batch_;
+  std::mutex              wake_lock_;
+  std::condition_variable wake_;
+  std::thread             thread_;
+};
+
 class LogRegistry
 {
 public:
@@ -62,11 +189,17 @@ public:
   LogRegistry();
   LogRegistry(LogRegistry const &) = delete;
   LogRegistry(LogRegistry &&)      = delete;
-  ~LogRegistry()                   = default;
+  ~LogRegistry();
 
   void Log(LogLevel level, char const *name, std::string &&message);
   void SetLevel(char const *name, LogLevel level);
   void SetGlobalLevel(LogLevel level);
+  bool IsActive(LogLevel level) const;
+
+  void     EnableAsync(AsyncLogConfig const &config);
+  void     DisableAsync();
+  void     Flush();
+  uint64_t dropped() const;
 
   LogLevelMap GetLogLevelMap();
 
@@ -85,16 +218,22 @@ private:
   using Registry  = std::unordered_map<std::string, LoggerPtr>;
 
   Logger &GetLogger(char const *name);
+  void    Write(LogRecords &records);
+  void    UpdateMinimumLevel();
 
   std::mutex            lock_;
   Registry              registry_;
   std::atomic<LogLevel> global_level_{LogLevel::TRACE};
+  std::atomic<LogLevel> min_logger_level_;  ///< Lowest level enabled on any logger
+  AsyncWriter           writer_;
 };
 
 constexpr LogLevel DEFAULT_LEVEL = LogLevel::INFO;
 
-LogRegistry                                          registry;
+// the sink is declared first so that it outlives the registry, which writes out any queued
+// messages when it is destroyed
 std::shared_ptr<spdlog::sinks::stdout_color_sink_mt> COLOUR_SINK;
+LogRegistry                                          registry;
 
 LogLevel ConvertToLevel(spdlog::level::level_enum level)
 {
@@ -156,15 +295,287 @@ spdlog::level::level_enum ConvertFromLevel(LogLevel level)
   return new_level;
 }
 
-LogRegistry::LogRegistry() = default;
+constexpr std::chrono::milliseconds AsyncWriter::FLUSH_INTERVAL;
+
+RecordBuffer::RecordBuffer(std::size_t capacity)
+{
+  std::size_t size = 1;
+  while (size < capacity)
+  {
+    size <<= 1u;
+  }
+
+  slots_.resize(size);
+  mask_ = size - 1;
+}
+
+/**
+ * Add a record to the buffer. Must only be called from the owning thread.
+ *
+ * @param record The record to be added, which is left untouched if the buffer is full
+ * @return true if the record was added, otherwise false
+ */
+bool RecordBuffer::Push(LogRecord &&record)
+{
+  auto const tail = tail_.value.load(std::memory_order_relaxed);
+  if ((tail - head_.value.load(std::memory_order_acquire)) > mask_)
+  {
+    return false;
+  }
+
+  slots_[tail & mask_] = std::move(record);
+  tail_.value.store(tail + 1, std::memory_order_release);
+
+  return true;
+}
+
+/**
+ * Move all the records currently in the buffer to the end of the output. Must only be called by
+ * one consumer at a time.
+ *
+ * @param records The output list of records
+ */
+void RecordBuffer::PopAll(LogRecords &records)
+{
+  auto const head = head_.value.load(std::memory_order_relaxed);
+  auto const tail = tail_.value.load(std::memory_order_acquire);
+
+  for (auto index = head; index != tail; ++index)
+  {
+    records.emplace_back(std::move(slots_[index & mask_]));
+  }
+
+  head_.value.store(tail, std::memory_order_release);
+}
+
+AsyncWriter::AsyncWriter(Sink sink)
+  : sink_{std::move(sink)}
+{}
+
+AsyncWriter::~AsyncWriter()
+{
+  Stop();
+}
+
+void AsyncWriter::Start(AsyncLogConfig const &config)
+{
+  std::lock_guard<std::mutex> guard(control_lock_);
+
+  if (running_)
+  {
+    return;
+  }
+
+  buffer_size_    = std::max<std::size_t>(config.buffer_size, 1);
+  blocking_level_ = config.blocking_level;
+
+  // threads allocate new buffers on their next message so that the configured size applies
+  generation_.fetch_add(1, std::memory_order_release);
+
+  running_ = true;
+  thread_  = std::thread([this]() { ThreadLoop(); });
+}
+
+void AsyncWriter::Stop()
+{
+  std::lock_guard<std::mutex> guard(control_lock_);
+
+  if (running_)
+  {
+    {
+      std::lock_guard<std::mutex> wake_guard(wake_lock_);
+      running_ = false;
+    }
+
+    wake_.notify_all();
+    thread_.join();
+  }
+
+  // write out anything queued before (or racing with) the writer being stopped
+  Drain();
+}
+
+/**
+ * Queue a record for the writer thread
+ *
+ * @param record The record to be queued, which is left untouched if false is returned
+ * @return true if the record was queued or dropped, false if it must be written synchronously
+ */
+bool AsyncWriter::Submit(LogRecord &&record)
+{
+  auto &buffer = LocalBuffer();
+
+  if (buffer.Push(std::move(record)))
+  {
+    return true;
+  }
+
+  // the writer is falling behind, messages below the blocking level are shed rather than stall
+  // the calling thread
+  Wake();
+
+  if (record.level < blocking_level_.load(std::memory_order_relaxed))
+  {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  while (IsRunning())
+  {
+    std::this_thread::yield();
+
+    if (buffer.Push(std::move(record)))
+    {
+      return true;
+    }
+
+    Wake();
+  }
+
+  return false;
+}
+
+void AsyncWriter::Flush()
+{
+  Drain();
+}
+
+RecordBuffer &AsyncWriter::LocalBuffer()
+{
+  struct LocalState
+  {
+    LocalState()                   = default;
+    LocalState(LocalState const &) = delete;
+    LocalState(LocalState &&)      = delete;
+
+    ~LocalState()
+    {
+      if (buffer)
+      {
+        buffer->Close();
+      }
+    }
+
+    LocalState &operator=(LocalState const &) = delete;
+    LocalState &operator=(LocalState &&) = delete;
+
+    uint64_t  generation{0};
+    BufferPtr buffer{};
+  };
+
+  thread_local LocalState local;
+
+  auto const generation = generation_.load(std::memory_order_acquire);
+  if (!local.buffer || (local.generation != generation))
+  {
+    if (local.buffer)
+    {
+      local.buffer->Close();
+    }
+
+    local.buffer     = std::make_shared<RecordBuffer>(buffer_size_.load());
+    local.generation = generation;
+
+    std::lock_guard<std::mutex> guard(buffers_lock_);
+    buffers_.emplace_back(local.buffer);
+  }
+
+  return *local.buffer;
+}
+
+void AsyncWriter::Wake()
+{
+  wake_.notify_one();
+}
+
+void AsyncWriter::ThreadLoop()
+{
+  while (IsRunning())
+  {
+    if (Drain() == 0)
+    {
+      std::unique_lock<std::mutex> guard(wake_lock_);
+
+      // producers only signal when a buffer fills up, otherwise records are collected in batches
+      if (IsRunning())
+      {
+        wake_.wait_for(guard, FLUSH_INTERVAL);
+      }
+    }
+  }
+}
+
+/**
+ * Write out all the queued records
+ *
+ * @return The number of records written
+ */
+std::size_t AsyncWriter::Drain()
+{
+  std::lock_guard<std::mutex> guard(drain_lock_);
+
+  {
+    std::lock_guard<std::mutex> buffers_guard(buffers_lock_);
+
+    auto it = buffers_.begin();
+    while (it != buffers_.end())
+    {
+      // a buffer closed before it is emptied will never receive another record
+      bool const closed = (*it)->IsClosed();
+
+      (*it)->PopAll(batch_);
+
+      if (closed)
+      {
+        it = buffers_.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  std::size_t const count = batch_.size();
+
+  if (count != 0)
+  {
+    sink_(batch_);
+    batch_.clear();
+  }
+
+  return count;
+}
+
+LogRegistry::LogRegistry()
+  : min_logger_level_{DEFAULT_LEVEL}
+  , writer_{[this](LogRecords &records) { Write(records); }}
+{}
+
+LogRegistry::~LogRegistry()
+{
+  writer_.Stop();
+}
 
 void LogRegistry::Log(LogLevel level, char const *name, std::string &&message)
 {
-  if (level < global_level_)
+  if (!IsActive(level))
   {
     return;
   }
 
+  if (writer_.IsRunning())
+  {
+    LogRecord record{level, name, std::move(message)};
+
+    if (writer_.Submit(std::move(record)))
+    {
+      return;
+    }
+
+    message = std::move(record.message);
+  }
+
   std::lock_guard<std::mutex> guard(lock_);
   GetLogger(name).log(ConvertFromLevel(level), message);
 }
@@ -181,6 +592,8 @@ void LogRegistry::SetLevel(char const *name, LogLevel level)
   {
     it->second->set_level(ConvertFromLevel(level));
   }
+
+  UpdateMinimumLevel();
 }
 
 void LogRegistry::SetGlobalLevel(LogLevel level)
@@ -188,6 +601,32 @@ void LogRegistry::SetGlobalLevel(LogLevel level)
   global_level_ = level;
 }
 
+bool LogRegistry::IsActive(LogLevel level) const
+{
+  return (level >= global_level_.load(std::memory_order_relaxed)) &&
+         (level >= min_logger_level_.load(std::memory_order_relaxed));
+}
+
+void LogRegistry::EnableAsync(AsyncLogConfig const &config)
+{
+  writer_.Start(config);
+}
+
+void LogRegistry::DisableAsync()
+{
+  writer_.Stop();
+}
+
+void LogRegistry::Flush()
+{
+  writer_.Flush();
+}
+
+uint64_t LogRegistry::dropped() const
+{
+  return writer_.dropped();
+}
+
 LogLevelMap LogRegistry::GetLogLevelMap()
 {
   std::lock_guard<std::mutex> guard(lock_);
@@ -203,6 +642,29 @@ LogLevelMap LogRegistry::GetLogLevelMap()
   return level_map;
 }
 
+void LogRegistry::Write(LogRecords &records)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  for (auto const &record : records)
+  {
+    GetLogger(record.name.c_str()).log(ConvertFromLevel(record.level), record.message);
+  }
+}
+
+void LogRegistry::UpdateMinimumLevel()
+{
+  // loggers that have not been created yet will start at the default level
+  LogLevel minimum = DEFAULT_LEVEL;
+
+  for (auto const &element : registry_)
+  {
+    minimum = std::min(minimum, ConvertToLevel(element.second->level()));
+  }
+
+  min_logger_level_.store(minimum, std::memory_order_relaxed);
+}
+
 LogRegistry::Logger &LogRegistry::GetLogger(char const *name)
 {
   auto it = registry_.find(name);
@@ -255,4 +717,29 @@ LogLevelMap GetLogLevelMap()
   return registry.GetLogLevelMap();
 }
 
+bool IsLogLevelActive(LogLevel level)
+{
+  return registry.IsActive(level);
+}
+
+void EnableAsyncLogging(AsyncLogConfig const &config)
+{
+  registry.EnableAsync(config);
+}
+
+void DisableAsyncLogging()
+{
+  registry.DisableAsync();
+}
+
+void FlushLogs()
+{
+  registry.Flush();
+}
+
+uint64_t GetDroppedLogCount()
+{
+  return registry.dropped();
+}
+
 }  // namespace fetch
@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "logging/logging.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::AsyncLogConfig;
+using fetch::LogLevel;
+
+constexpr char const *LOGGING_NAME = "AsyncLoggingTests";
+
+std::string MessageText(std::size_t source, std::size_t index)
+{
+  return "async record " + std::to_string(source) + ":" + std::to_string(index) + ";";
+}
+
+/**
+ * Check that every record from a source appears exactly once and in the order it was logged
+ *
+ * @param output The captured log output
+ * @param source The identifier of the logging source
+ * @param count The number of records logged by the source
+ * @return true if all the records were written in order, otherwise false
+ */
+bool WrittenInOrder(std::string const &output, std::size_t source, std::size_t count)
+{
+  std::size_t position = 0;
+  for (std::size_t index = 0; index < count; ++index)
+  {
+    auto const text  = MessageText(source, index);
+    auto const found = output.find(text, position);
+
+    if ((found == std::string::npos) || (output.find(text, found + 1) != std::string::npos))
+    {
+      return false;
+    }
+
+    position = found + text.size();
+  }
+
+  return true;
+}
+
+std::size_t CountRecords(std::string const &output, std::size_t source, std::size_t count)
+{
+  std::size_t written = 0;
+  for (std::size_t index = 0; index < count; ++index)
+  {
+    if (output.find(MessageText(source, index)) != std::string::npos)
+    {
+      ++written;
+    }
+  }
+
+  return written;
+}
+
+class AsyncLoggingTests : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    fetch::DisableAsyncLogging();
+  }
+};
+
+TEST_F(AsyncLoggingTests, FlushWritesQueuedRecordsInOrder)
+{
+  constexpr std::size_t NUM_RECORDS = 200;
+
+  ::testing::internal::CaptureStdout();
+
+  fetch::EnableAsyncLogging();
+  for (std::size_t i = 0; i < NUM_RECORDS; ++i)
+  {
+    fetch::Log(LogLevel::INFO, LOGGING_NAME, MessageText(0, i));
+  }
+  fetch::FlushLogs();
+
+  auto const output = ::testing::internal::GetCapturedStdout();
+
+  EXPECT_TRUE(WrittenInOrder(output, 0, NUM_RECORDS));
+}
+
+TEST_F(AsyncLoggingTests, DisablingWritesOutQueuedRecords)
+{
+  constexpr std::size_t NUM_RECORDS = 200;
+
+  ::testing::internal::CaptureStdout();
+
+  fetch::EnableAsyncLogging();
+  for (std::size_t i = 0; i < NUM_RECORDS; ++i)
+  {
+    fetch::Log(LogLevel::INFO, LOGGING_NAME, MessageText(1, i));
+  }
+  fetch::DisableAsyncLogging();
+
+  // once disabled records are written straight away
+  fetch::Log(LogLevel::INFO, LOGGING_NAME, MessageText(1, NUM_RECORDS));
+
+  auto const output = ::testing::internal::GetCapturedStdout();
+
+  EXPECT_TRUE(WrittenInOrder(output, 1, NUM_RECORDS + 1));
+}
+
+TEST_F(AsyncLoggingTests, RecordsFromEachThreadAreWrittenInOrder)
+{
+  constexpr std::size_t NUM_THREADS = 4;
+  constexpr std::size_t NUM_RECORDS = 500;
+
+  auto const dropped = fetch::GetDroppedLogCount();
+
+  ::testing::internal::CaptureStdout();
+
+  // records are only shed when a buffer is full, which can not happen with this capacity
+  AsyncLogConfig config{};
+  config.buffer_size = NUM_RECORDS;
+  fetch::EnableAsyncLogging(config);
+
+  std::vector<std::thread> threads;
+  for (std::size_t source = 0; source < NUM_THREADS; ++source)
+  {
+    threads.emplace_back([source]() {
+      for (std::size_t i = 0; i < NUM_RECORDS; ++i)
+      {
+        fetch::Log(LogLevel::INFO, LOGGING_NAME, MessageText(10 + source, i));
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  fetch::FlushLogs();
+
+  auto const output = ::testing::internal::GetCapturedStdout();
+
+  for (std::size_t source = 0; source < NUM_THREADS; ++source)
+  {
+    EXPECT_TRUE(WrittenInOrder(output, 10 + source, NUM_RECORDS)) << "thread " << source;
+  }
+  EXPECT_EQ(fetch::GetDroppedLogCount(), dropped);
+}
+
+TEST_F(AsyncLoggingTests, RecordsAtTheBlockingLevelAreNeverDropped)
+{
+  constexpr std::size_t NUM_RECORDS = 500;
+
+  auto const dropped = fetch::GetDroppedLogCount();
+
+  ::testing::internal::CaptureStdout();
+
+  // the buffer fills almost immediately, so the logging thread has to wait for the writer
+  AsyncLogConfig config{};
+  config.buffer_size    = 2;
+  config.blocking_level = LogLevel::WARNING;
+  fetch::EnableAsyncLogging(config);
+
+  for (std::size_t i = 0; i < NUM_RECORDS; ++i)
+  {
+    fetch::Log(LogLevel::WARNING, LOGGING_NAME, MessageText(2, i));
+  }
+  fetch::FlushLogs();
+
+  auto const output = ::testing::internal::GetCapturedStdout();
+
+  EXPECT_TRUE(WrittenInOrder(output, 2, NUM_RECORDS));
+  EXPECT_EQ(fetch::GetDroppedLogCount(), dropped);
+}
+
+TEST_F(AsyncLoggingTests, RecordsBelowTheBlockingLevelAreDroppedAndCounted)
+{
+  constexpr std::size_t NUM_RECORDS = 2000;
+
+  auto const dropped = fetch::GetDroppedLogCount();
+
+  ::testing::internal::CaptureStdout();
+
+  AsyncLogConfig config{};
+  config.buffer_size    = 2;
+  config.blocking_level = LogLevel::CRITICAL;
+  fetch::EnableAsyncLogging(config);
+
+  for (std::size_t i = 0; i < NUM_RECORDS; ++i)
+  {
+    fetch::Log(LogLevel::INFO, LOGGING_NAME, MessageText(3, i));
+  }
+  fetch::FlushLogs();
+
+  auto const output = ::testing::internal::GetCapturedStdout();
+
+  // whether a record is shed depends on the writer keeping up, but each one is accounted for
+  auto const written = CountRecords(output, 3, NUM_RECORDS);
+  EXPECT_EQ(written + (fetch::GetDroppedLogCount() - dropped), NUM_RECORDS);
+}
+
+TEST_F(AsyncLoggingTests, EnablingTwiceKeepsTheRunningWriter)
+{
+  ::testing::internal::CaptureStdout();
+
+  fetch::EnableAsyncLogging();
+  fetch::Log(LogLevel::INFO, LOGGING_NAME, MessageText(4, 0));
+
+  // a second call must not discard the record already queued
+  fetch::EnableAsyncLogging();
+  fetch::Log(LogLevel::INFO, LOGGING_NAME, MessageText(4, 1));
+  fetch::FlushLogs();
+
+  auto const output = ::testing::internal::GetCapturedStdout();
+
+  EXPECT_TRUE(WrittenInOrder(output, 4, 2));
+}
+
+}  // namespace
@@ -17,11 +17,16 @@
 //------------------------------------------------------------------------------
 
 #include "math/activation_functions/elu.hpp"
+#include "math/activation_functions/gelu.hpp"
 #include "math/activation_functions/leaky_relu.hpp"
 #include "math/activation_functions/relu.hpp"
 #include "math/activation_functions/sigmoid.hpp"
 #include "math/activation_functions/softmax.hpp"
+#include "math/kernels/sigmoid.hpp"
+#include "math/standard_functions/exp.hpp"
 #include "math/tensor/tensor.hpp"
+#include "math/trigonometry.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
 
 #include "benchmark/benchmark.h"
 
@@ -29,6 +34,9 @@
 
 using namespace fetch::math;
 
+using fetch::fixed_point::fp32_t;
+using fetch::fixed_point::fp64_t;
+
 template <typename T, SizeType L, SizeType H, SizeType W>
 void BM_Elu(benchmark::State &state)
 {
@@ -123,6 +131,155 @@ BENCHMARK_TEMPLATE(BM_Sigmoid, int, 256, 256, 256)->Unit(benchmark::kMillisecond
 BENCHMARK_TEMPLATE(BM_Sigmoid, float, 256, 256, 256)->Unit(benchmark::kMillisecond);
 BENCHMARK_TEMPLATE(BM_Sigmoid, double, 256, 256, 256)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_TEMPLATE(BM_Sigmoid, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Sigmoid, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_Sigmoid, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Sigmoid, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
+// The elementwise implementation which is replaced by the batched kernels for fixed point types
+template <typename T, SizeType L, SizeType H, SizeType W>
+void BM_SigmoidElementwise(benchmark::State &state)
+{
+  Tensor<T> input({L, H, W});
+  Tensor<T> output({L, H, W});
+  input.FillUniformRandom();
+
+  kernels::Sigmoid sigmoid;
+  for (auto _ : state)
+  {
+    auto it  = input.cbegin();
+    auto rit = output.begin();
+    while (it.is_valid())
+    {
+      sigmoid(*it, *rit);
+      ++it;
+      ++rit;
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_SigmoidElementwise, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SigmoidElementwise, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_SigmoidElementwise, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SigmoidElementwise, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
+template <typename T, SizeType L, SizeType H, SizeType W>
+void BM_Exp(benchmark::State &state)
+{
+  Tensor<T> input({L, H, W});
+  Tensor<T> output({L, H, W});
+  input.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    Exp(input, output);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Exp, float, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Exp, double, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Exp, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Exp, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_Exp, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Exp, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
+template <typename T, SizeType L, SizeType H, SizeType W>
+void BM_ExpElementwise(benchmark::State &state)
+{
+  Tensor<T> input({L, H, W});
+  Tensor<T> output({L, H, W});
+  input.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    auto it  = input.cbegin();
+    auto rit = output.begin();
+    while (it.is_valid())
+    {
+      *rit = T::Exp(*it);
+      ++it;
+      ++rit;
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_ExpElementwise, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ExpElementwise, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_ExpElementwise, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ExpElementwise, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
+template <typename T, SizeType L, SizeType H, SizeType W>
+void BM_TanH(benchmark::State &state)
+{
+  Tensor<T> input({L, H, W});
+  Tensor<T> output({L, H, W});
+  input.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    TanH(input, output);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_TanH, float, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_TanH, double, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_TanH, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_TanH, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_TanH, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TanH, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
+template <typename T, SizeType L, SizeType H, SizeType W>
+void BM_TanHElementwise(benchmark::State &state)
+{
+  Tensor<T> input({L, H, W});
+  Tensor<T> output({L, H, W});
+  input.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    auto it  = input.cbegin();
+    auto rit = output.begin();
+    while (it.is_valid())
+    {
+      *rit = T::TanH(*it);
+      ++it;
+      ++rit;
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_TanHElementwise, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_TanHElementwise, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_TanHElementwise, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TanHElementwise, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
+template <typename T, SizeType L, SizeType H, SizeType W>
+void BM_Gelu(benchmark::State &state)
+{
+  Tensor<T> input({L, H, W});
+  Tensor<T> output({L, H, W});
+  input.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    Gelu(input, output);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Gelu, float, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Gelu, double, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Gelu, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Gelu, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_Gelu, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gelu, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
 template <typename T, SizeType L, SizeType H>
 void BM_Softmax(benchmark::State &state)
 {
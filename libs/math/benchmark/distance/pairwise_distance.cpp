@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/distance/euclidean.hpp"
+#include "math/distance/pairwise_distance.hpp"
+#include "math/tensor/tensor.hpp"
+
+#include "benchmark/benchmark.h"
+
+// Compares the blocked pairwise distance kernel against the generic implementation which copies
+// the rows of the input for every pair
+
+namespace {
+
+using namespace fetch::math;
+
+template <class T, int N, int F>
+void BM_PairWiseDistanceGeneric(benchmark::State &state)
+{
+  Tensor<T> data({N, F});
+  Tensor<T> ret({1, (N * (N - 1)) / 2});
+  data.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    distance::PairWiseDistance(data, distance::Euclidean<Tensor<T>>, ret);
+  }
+}
+
+template <class T, int N, int F>
+void BM_PairWiseDistanceBlocked(benchmark::State &state)
+{
+  Tensor<T> data({N, F});
+  Tensor<T> ret({1, (N * (N - 1)) / 2});
+  data.FillUniformRandom();
+
+  auto const metric = static_cast<distance::PairWiseMetric>(state.range(0));
+
+  for (auto _ : state)
+  {
+    distance::PairWiseDistance(data, metric, ret);
+  }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_PairWiseDistanceGeneric, float, 256, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PairWiseDistanceGeneric, double, 256, 64)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_PairWiseDistanceBlocked, float, 256, 64)
+    ->DenseRange(0, 2)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PairWiseDistanceBlocked, double, 256, 64)
+    ->DenseRange(0, 2)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PairWiseDistanceBlocked, float, 2048, 64)
+    ->DenseRange(0, 2)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_blocked.hpp"
+#include "math/linalg/blas/gemm_nn_vector.hpp"
+#include "math/linalg/prototype.hpp"
+#include "math/tensor/tensor.hpp"
+
+#include "benchmark/benchmark.h"
+
+#ifdef FETCH_BENCHMARK_CBLAS
+#include <cblas.h>
+#endif
+
+#include <cstddef>
+#include <vector>
+
+// Compares the blocked GEMM kernel used by fetch::math::Dot against the original vectorised
+// kernel and (when available) the system BLAS library. All of the matrices are square.
+
+namespace {
+
+using namespace fetch;
+using namespace fetch::math;
+using namespace fetch::math::linalg;
+
+void SetGemmCounters(benchmark::State &state, SizeType n)
+{
+  double const flops = 2.0 * static_cast<double>(n) * static_cast<double>(n) *
+                       static_cast<double>(n) * static_cast<double>(state.iterations());
+
+  state.counters["flops"] = benchmark::Counter(flops, benchmark::Counter::kIsRate);
+}
+
+template <class T, int N>
+void BM_GemmBlocked(benchmark::State &state)
+{
+  Tensor<T> a({N, N});
+  Tensor<T> b({N, N});
+  Tensor<T> c({N, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  Blas<T, Signature(_C <= _alpha, _A, _B, _beta, _C), Computes(_C <= _alpha * _A * _B + _beta * _C),
+       platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>
+      gemm;
+
+  for (auto _ : state)
+  {
+    gemm(T{1}, a.View(), b.View(), T{0}, c.View());
+  }
+
+  SetGemmCounters(state, N);
+}
+
+template <class T, int N>
+void BM_GemmVectorised(benchmark::State &state)
+{
+  Tensor<T> a({N, N});
+  Tensor<T> b({N, N});
+  Tensor<T> c({N, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  Blas<T, Signature(_C <= _alpha, _A, _B, _beta, _C), Computes(_C <= _alpha * _A * _B + _beta * _C),
+       platform::Parallelisation::VECTORISE>
+      gemm;
+
+  for (auto _ : state)
+  {
+    gemm(T{1}, a.View(), b.View(), T{0}, c.View());
+  }
+
+  SetGemmCounters(state, N);
+}
+
+#ifdef FETCH_BENCHMARK_CBLAS
+
+void CblasGemm(int n, float const *a, int lda, float const *b, int ldb, float *c, int ldc)
+{
+  cblas_sgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, n, n, n, 1.0f, a, lda, b, ldb, 0.0f, c,
+              ldc);
+}
+
+void CblasGemm(int n, double const *a, int lda, double const *b, int ldb, double *c, int ldc)
+{
+  cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, n, n, n, 1.0, a, lda, b, ldb, 0.0, c, ldc);
+}
+
+template <class T, int N>
+void BM_GemmCblas(benchmark::State &state)
+{
+  Tensor<T> a({N, N});
+  Tensor<T> b({N, N});
+  Tensor<T> c({N, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  // the tensors are column major with padded columns
+  auto const lda = static_cast<int>(a.padded_height());
+  auto const ldb = static_cast<int>(b.padded_height());
+  auto const ldc = static_cast<int>(c.padded_height());
+
+  for (auto _ : state)
+  {
+    CblasGemm(N, a.data().pointer(), lda, b.data().pointer(), ldb, c.data().pointer(), ldc);
+  }
+
+  SetGemmCounters(state, N);
+}
+
+#endif  // FETCH_BENCHMARK_CBLAS
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_GemmBlocked, float, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmBlocked, float, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmBlocked, float, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmBlocked, double, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmBlocked, double, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmBlocked, double, 1024)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_GemmVectorised, float, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmVectorised, float, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmVectorised, float, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmVectorised, double, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmVectorised, double, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmVectorised, double, 1024)->Unit(benchmark::kMillisecond);
+
+#ifdef FETCH_BENCHMARK_CBLAS
+BENCHMARK_TEMPLATE(BM_GemmCblas, float, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmCblas, float, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmCblas, float, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmCblas, double, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmCblas, double, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmCblas, double, 1024)->Unit(benchmark::kMillisecond);
+#endif  // FETCH_BENCHMARK_CBLAS
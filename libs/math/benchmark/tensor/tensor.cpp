@@ -16,7 +16,10 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/activation_functions/softmax.hpp"
+#include "math/matrix_operations.hpp"
 #include "math/tensor/tensor.hpp"
+#include "math/tensor/tensor_parallel.hpp"
 
 #include "benchmark/benchmark.h"
 
@@ -212,4 +215,118 @@ BENCHMARK_TEMPLATE(BM_TensorSlice, int, 256, 256, 256)->Unit(benchmark::kMillise
 BENCHMARK_TEMPLATE(BM_TensorSlice, float, 256, 256, 256)->Unit(benchmark::kMillisecond);
 BENCHMARK_TEMPLATE(BM_TensorSlice, double, 256, 256, 256)->Unit(benchmark::kMillisecond);
 
+// reductions and broadcasts, with the number of threads given by the argument
+template <class T, int H, int W, int A>
+void BM_TensorReduceSum(benchmark::State &state)
+{
+  fetch::math::SetTensorConcurrency(static_cast<std::size_t>(state.range(0)));
+
+  fetch::math::Tensor<T> t(std::vector<uint64_t>{H, W});
+  t.FillUniformRandom();
+
+  std::vector<uint64_t> ret_shape{H, W};
+  ret_shape[A] = 1;
+  fetch::math::Tensor<T> ret(ret_shape);
+
+  for (auto _ : state)
+  {
+    fetch::math::ReduceSum(t, A, ret);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * H * W);
+}
+
+BENCHMARK_TEMPLATE(BM_TensorReduceSum, float, 256, 256, 0)->Arg(1)->Arg(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TensorReduceSum, float, 256, 256, 1)->Arg(1)->Arg(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TensorReduceSum, float, 2048, 2048, 0)->Arg(1)->Arg(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TensorReduceSum, float, 2048, 2048, 1)->Arg(1)->Arg(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TensorReduceSum, double, 2048, 2048, 0)->Arg(1)->Arg(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TensorReduceSum, double, 2048, 2048, 1)->Arg(1)->Arg(8)->UseRealTime();
+
+template <class T, int H, int W, int A>
+void BM_TensorReduceMax(benchmark::State &state)
+{
+  fetch::math::SetTensorConcurrency(static_cast<std::size_t>(state.range(0)));
+
+  fetch::math::Tensor<T> t(std::vector<uint64_t>{H, W});
+  t.FillUniformRandom();
+
+  std::vector<uint64_t> ret_shape{H, W};
+  ret_shape[A] = 1;
+  fetch::math::Tensor<T> ret(ret_shape);
+
+  for (auto _ : state)
+  {
+    fetch::math::ReduceMax(t, A, ret);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * H * W);
+}
+
+BENCHMARK_TEMPLATE(BM_TensorReduceMax, float, 2048, 2048, 0)->Arg(1)->Arg(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TensorReduceMax, float, 2048, 2048, 1)->Arg(1)->Arg(8)->UseRealTime();
+
+template <class T, int H, int W, int A>
+void BM_TensorArgMax(benchmark::State &state)
+{
+  fetch::math::SetTensorConcurrency(static_cast<std::size_t>(state.range(0)));
+
+  fetch::math::Tensor<T> t(std::vector<uint64_t>{H, W});
+  t.FillUniformRandom();
+
+  fetch::math::Tensor<T> ret(std::vector<uint64_t>{A == 0 ? W : H});
+
+  for (auto _ : state)
+  {
+    fetch::math::ArgMax(t, ret, A);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * H * W);
+}
+
+BENCHMARK_TEMPLATE(BM_TensorArgMax, float, 2048, 2048, 0)->Arg(1)->Arg(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TensorArgMax, float, 2048, 2048, 1)->Arg(1)->Arg(8)->UseRealTime();
+
+template <class T, int H, int W>
+void BM_TensorSoftmax(benchmark::State &state)
+{
+  fetch::math::SetTensorConcurrency(static_cast<std::size_t>(state.range(0)));
+
+  fetch::math::Tensor<T> t(std::vector<uint64_t>{H, W});
+  fetch::math::Tensor<T> ret(std::vector<uint64_t>{H, W});
+  t.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    fetch::math::Softmax(t, ret, 0);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * H * W);
+}
+
+BENCHMARK_TEMPLATE(BM_TensorSoftmax, float, 10, 4096)->Arg(1)->Arg(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TensorSoftmax, float, 1000, 1024)->Arg(1)->Arg(8)->UseRealTime();
+
+template <class T, int H, int W>
+void BM_TensorBroadcast(benchmark::State &state)
+{
+  fetch::math::SetTensorConcurrency(static_cast<std::size_t>(state.range(0)));
+
+  fetch::math::Tensor<T> t(std::vector<uint64_t>{H, W});
+  fetch::math::Tensor<T> bias(std::vector<uint64_t>{H, 1});
+  fetch::math::Tensor<T> ret(std::vector<uint64_t>{H, W});
+  t.FillUniformRandom();
+  bias.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    fetch::math::Add(t, bias, ret);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * H * W);
+}
+
+BENCHMARK_TEMPLATE(BM_TensorBroadcast, float, 256, 256)->Arg(1)->Arg(8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TensorBroadcast, float, 2048, 2048)->Arg(1)->Arg(8)->UseRealTime();
+
 BENCHMARK_MAIN();
@@ -21,9 +21,11 @@
 #include "math/standard_functions/exp.hpp"
 #include "math/standard_functions/pow.hpp"
 #include "math/trigonometry.hpp"
+#include "vectorise/math/exact_exp.hpp"
 #include "vectorise/math/max.hpp"
 
 #include <cassert>
+#include <type_traits>
 
 namespace fetch {
 namespace math {
@@ -36,7 +38,7 @@ namespace math {
  * @param ret
  */
 template <typename ArrayType>
-void Gelu(ArrayType const &t, ArrayType &ret)
+meta::IfIsMathNonFixedPointArray<ArrayType, void> Gelu(ArrayType const &t, ArrayType &ret)
 {
   assert(t.size() == ret.size());
   using DataType = typename ArrayType::Type;
@@ -58,6 +60,31 @@ void Gelu(ArrayType const &t, ArrayType &ret)
   Multiply(ret, half, ret);
 }
 
+/**
+ * Fixed point tensors are processed a register at a time with the same sequence of operations as
+ * above, the result is bit-identical to the elementwise implementation on every platform
+ */
+template <typename ArrayType>
+meta::IfIsMathFixedPointArray<ArrayType, void> Gelu(ArrayType const &t, ArrayType &ret)
+{
+  assert(t.shape() == ret.shape());
+  using DataType = typename ArrayType::Type;
+
+  DataType const one{1};
+  DataType const half   = Type<DataType>("0.5");
+  DataType const coeff1 = Type<DataType>("0.797885");
+  DataType const coeff2 = Type<DataType>("0.035677");
+
+  details::ApplyExactKernel(t, ret, [one, half, coeff1, coeff2](auto const &x, auto &y) {
+    using RegisterType = std::decay_t<decltype(x)>;
+
+    RegisterType const inner = (x * RegisterType(coeff1)) +
+                               (vectorise::exact_cube(x) * RegisterType(coeff2));
+
+    y = (x * (vectorise::exact_tanh(inner) + RegisterType(one))) * RegisterType(half);
+  });
+}
+
 template <typename ArrayType>
 ArrayType Gelu(ArrayType const &t)
 {
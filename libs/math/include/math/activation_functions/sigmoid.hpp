@@ -17,8 +17,12 @@
 //
 //------------------------------------------------------------------------------
 
-#include "math/fundamental_operators.hpp"
+#include "math/kernels/sigmoid.hpp"
+#include "math/meta/math_type_traits.hpp"
 #include "math/standard_functions/exp.hpp"
+#include "vectorise/math/exact_exp.hpp"
+
+#include <cassert>
 
 namespace fetch {
 namespace math {
@@ -30,35 +34,33 @@ namespace math {
  * @param ret
  */
 template <typename ArrayType>
-void Sigmoid(ArrayType const &t, ArrayType &ret)
+meta::IfIsMathNonFixedPointArray<ArrayType, void> Sigmoid(ArrayType const &t, ArrayType &ret)
 {
-  using Type = typename ArrayType::Type;
+  kernels::Sigmoid sigmoid;
 
   auto array_it = t.cbegin();
   auto rit      = ret.begin();
-  Type zero{0};
-  Type one{1};
-  Type min_one{-1};
-
   while (array_it.is_valid())
   {
-    if (*array_it >= zero)
-    {
-      Multiply(min_one, *array_it, *rit);
-      Exp(*rit, *rit);
-      Add(*rit, one, *rit);
-      Divide(one, *rit, *rit);
-    }
-    else
-    {
-      Exp(*array_it, *rit);
-      Divide(*rit, *rit + one, *rit);
-    }
+    sigmoid(*array_it, *rit);
     ++array_it;
     ++rit;
   }
 }
 
+/**
+ * Fixed point tensors are processed a register at a time, the result is bit-identical to
+ * kernels::Sigmoid on every platform
+ */
+template <typename ArrayType>
+meta::IfIsMathFixedPointArray<ArrayType, void> Sigmoid(ArrayType const &t, ArrayType &ret)
+{
+  assert(ret.shape() == t.shape());
+
+  details::ApplyExactKernel(t, ret,
+                            [](auto const &x, auto &y) { y = vectorise::exact_sigmoid(x); });
+}
+
 template <typename ArrayType>
 ArrayType Sigmoid(ArrayType const &t)
 {
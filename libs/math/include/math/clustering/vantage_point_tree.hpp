@@ -0,0 +1,321 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lfg.hpp"
+#include "math/base_types.hpp"
+#include "math/distance/pairwise_distance.hpp"
+#include "math/standard_functions/sqrt.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace math {
+namespace clustering {
+
+/**
+ * A vantage point tree over a set of points, which answers exact k nearest neighbour queries under
+ * the euclidean distance in roughly logarithmic time. The points are held in a packed (row major)
+ * buffer, as produced by distance::details::PackRows.
+ *
+ * Every node divides its points into those which are closer to a randomly chosen vantage point
+ * than the median distance and those which are further away, during the search an entire side can
+ * be skipped whenever it can not contain a point closer than the current k-th neighbour.
+ */
+template <typename T>
+class VantagePointTree
+{
+public:
+  using Type       = T;
+  using Neighbour  = std::pair<SizeType, Type>;  ///< The index of the point and its distance
+  using Neighbours = std::vector<Neighbour>;
+  using Points     = std::vector<Type>;
+  using RNG        = fetch::random::LaggedFibonacciGenerator<>;
+
+  static constexpr SizeType INVALID = std::numeric_limits<SizeType>::max();
+
+  // Construction / Destruction
+  VantagePointTree(Points points, SizeType num_features, uint64_t seed = 42);
+  VantagePointTree(VantagePointTree const &) = delete;
+  VantagePointTree(VantagePointTree &&)      = default;
+  ~VantagePointTree()                        = default;
+
+  /// @name Queries
+  /// @{
+  Neighbours Search(Type const *query, SizeType k, SizeType exclude = INVALID) const;
+  Neighbours SearchPoint(SizeType index, SizeType k) const;
+  /// @}
+
+  SizeType size() const;
+  SizeType num_features() const;
+
+  // Operators
+  VantagePointTree &operator=(VantagePointTree const &) = delete;
+  VantagePointTree &operator=(VantagePointTree &&) = default;
+
+private:
+  struct Node
+  {
+    SizeType index{INVALID};  ///< The vantage point
+    Type     threshold{0};    ///< The median distance from the vantage point
+    SizeType inner{INVALID};  ///< The points within the threshold
+    SizeType outer{INVALID};  ///< The points beyond the threshold
+  };
+
+  using Heap = std::priority_queue<std::pair<Type, SizeType>>;
+
+  Type        Distance(Type const *query, SizeType index) const;
+  Type const *Point(SizeType index) const;
+  SizeType    Build(SizeType lower, SizeType upper, RNG &rng);
+  void        Search(SizeType node, Type const *query, SizeType k, SizeType exclude, Heap &heap,
+                     Type &tau) const;
+
+  Points                points_;
+  SizeType              num_features_;
+  std::vector<SizeType> order_{};
+  std::vector<Node>     nodes_{};
+  SizeType              root_{INVALID};
+};
+
+template <typename T>
+constexpr SizeType VantagePointTree<T>::INVALID;
+
+/**
+ * Build the tree
+ *
+ * @param points The packed points
+ * @param num_features The number of features of each point
+ * @param seed The seed used to select the vantage points
+ */
+template <typename T>
+VantagePointTree<T>::VantagePointTree(Points points, SizeType num_features, uint64_t seed)
+  : points_{std::move(points)}
+  , num_features_{num_features}
+{
+  assert(num_features_ > 0);
+  assert((points_.size() % num_features_) == 0);
+
+  SizeType const num_points = points_.size() / num_features_;
+
+  order_.resize(num_points);
+  for (SizeType i = 0; i < num_points; ++i)
+  {
+    order_[i] = i;
+  }
+
+  nodes_.reserve(num_points);
+
+  RNG rng{seed};
+  root_ = Build(0, num_points, rng);
+}
+
+/**
+ * Find the k nearest neighbours of a query point
+ *
+ * @param query The features of the query point
+ * @param k The number of neighbours
+ * @param exclude The index of a point which is not to be returned (the query point itself)
+ * @return The neighbours, nearest first
+ */
+template <typename T>
+typename VantagePointTree<T>::Neighbours VantagePointTree<T>::Search(Type const *query,
+                                                                     SizeType    k,
+                                                                     SizeType    exclude) const
+{
+  Heap heap{};
+  Type tau = numeric_max<Type>();
+
+  if (k > 0)
+  {
+    Search(root_, query, k, exclude, heap, tau);
+  }
+
+  Neighbours neighbours(heap.size());
+  for (auto it = neighbours.rbegin(); it != neighbours.rend(); ++it)
+  {
+    *it = Neighbour{heap.top().second, heap.top().first};
+    heap.pop();
+  }
+
+  return neighbours;
+}
+
+/**
+ * Find the k nearest neighbours of one of the points of the tree
+ *
+ * @param index The index of the point
+ * @param k The number of neighbours
+ * @return The neighbours (excluding the point itself), nearest first
+ */
+template <typename T>
+typename VantagePointTree<T>::Neighbours VantagePointTree<T>::SearchPoint(SizeType index,
+                                                                          SizeType k) const
+{
+  return Search(Point(index), k, index);
+}
+
+template <typename T>
+SizeType VantagePointTree<T>::size() const
+{
+  return order_.size();
+}
+
+template <typename T>
+SizeType VantagePointTree<T>::num_features() const
+{
+  return num_features_;
+}
+
+template <typename T>
+typename VantagePointTree<T>::Type VantagePointTree<T>::Distance(Type const *query,
+                                                                 SizeType    index) const
+{
+  return fetch::math::Sqrt(
+      distance::details::SquareDistanceKernel(query, Point(index), num_features_));
+}
+
+template <typename T>
+typename VantagePointTree<T>::Type const *VantagePointTree<T>::Point(SizeType index) const
+{
+  return points_.data() + (index * num_features_);
+}
+
+/**
+ * Internal: Build the subtree for the points order_[lower, upper)
+ *
+ * @return The index of the node, or INVALID if the range is empty
+ */
+template <typename T>
+SizeType VantagePointTree<T>::Build(SizeType lower, SizeType upper, RNG &rng)
+{
+  if (lower >= upper)
+  {
+    return INVALID;
+  }
+
+  SizeType const node = nodes_.size();
+  nodes_.emplace_back();
+
+  // move a random vantage point to the front of the range
+  SizeType const selected = lower + static_cast<SizeType>(rng() % (upper - lower));
+  std::swap(order_[lower], order_[selected]);
+
+  SizeType const vantage = order_[lower];
+  nodes_[node].index     = vantage;
+
+  if ((upper - lower) > 1)
+  {
+    // partition the remaining points around the median distance
+    SizeType const median = (lower + upper) / 2;
+    Type const *   point  = Point(vantage);
+
+    std::nth_element(order_.begin() + static_cast<std::ptrdiff_t>(lower + 1),
+                     order_.begin() + static_cast<std::ptrdiff_t>(median),
+                     order_.begin() + static_cast<std::ptrdiff_t>(upper),
+                     [this, point](SizeType a, SizeType b) {
+                       return Distance(point, a) < Distance(point, b);
+                     });
+
+    Type const     threshold = Distance(point, order_[median]);
+    SizeType const inner     = Build(lower + 1, median, rng);
+    SizeType const outer     = Build(median, upper, rng);
+
+    nodes_[node].threshold = threshold;
+    nodes_[node].inner     = inner;
+    nodes_[node].outer     = outer;
+  }
+
+  return node;
+}
+
+/**
+ * Internal: Search a subtree, maintaining a heap of the k nearest points found so far
+ *
+ * @param tau The distance to the furthest point in the heap (once it is full)
+ */
+template <typename T>
+void VantagePointTree<T>::Search(SizeType node_index, Type const *query, SizeType k,
+                                 SizeType exclude, Heap &heap, Type &tau) const
+{
+  if (node_index == INVALID)
+  {
+    return;
+  }
+
+  Node const &node     = nodes_[node_index];
+  Type const  distance = Distance(query, node.index);
+
+  if ((node.index != exclude) && (distance < tau))
+  {
+    if (heap.size() == k)
+    {
+      heap.pop();
+    }
+
+    heap.emplace(distance, node.index);
+
+    if (heap.size() == k)
+    {
+      tau = heap.top().first;
+    }
+  }
+
+  if ((node.inner == INVALID) && (node.outer == INVALID))
+  {
+    return;
+  }
+
+  // until the heap is full every subtree must be searched, after that only the sides which
+  // overlap the ball of radius tau around the query
+  auto const search_inner = [&]() {
+    if ((heap.size() < k) || ((distance - tau) <= node.threshold))
+    {
+      Search(node.inner, query, k, exclude, heap, tau);
+    }
+  };
+
+  auto const search_outer = [&]() {
+    if ((heap.size() < k) || ((distance + tau) >= node.threshold))
+    {
+      Search(node.outer, query, k, exclude, heap, tau);
+    }
+  };
+
+  // search the side containing the query first, as it is the most likely to reduce tau
+  if (distance < node.threshold)
+  {
+    search_inner();
+    search_outer();
+  }
+  else
+  {
+    search_outer();
+    search_inner();
+  }
+}
+
+}  // namespace clustering
+}  // namespace math
+}  // namespace fetch
@@ -17,14 +17,221 @@
 //
 //------------------------------------------------------------------------------
 
+/* The blocked pairwise kernels compute the distances between all of the rows of a matrix for the
+ * common metrics. The rows are first packed into a contiguous buffer, after which the pairs are
+ * processed in square tiles (so that both sets of rows stay in cache) and the tiles are shared
+ * between the threads of a pool. Every distance is computed by exactly one thread with a fixed
+ * order of summation, so the results do not depend on the number of threads.
+ */
+
 #include "core/assert.hpp"
 #include "math/base_types.hpp"
 #include "math/meta/math_type_traits.hpp"
+#include "math/standard_functions/abs.hpp"
+#include "math/standard_functions/sqrt.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace math {
 namespace distance {
 
+enum class PairWiseMetric
+{
+  EUCLIDEAN,
+  COSINE,
+  MANHATTAN
+};
+
+// The maximum number of threads used by the blocked pairwise kernels
+void        SetPairWiseConcurrency(std::size_t concurrency);
+std::size_t PairWiseConcurrency();
+
+namespace details {
+
+/// The number of rows in each side of a tile of pairs
+constexpr SizeType PAIRWISE_BLOCK_SIZE = 64;
+/// The number of pairs times features below which the work is never split across threads
+constexpr SizeType PAIRWISE_MIN_THREADED_SIZE = SizeType{1} << 18;
+
+/**
+ * Run task(0) ... task(num_tasks - 1) on the pairwise thread pool (and the calling thread). The
+ * tasks are statically assigned to the threads in a round robin.
+ */
+void ParallelPairWiseTasks(std::size_t num_tasks, std::size_t num_threads,
+                           std::function<void(std::size_t)> const &task);
+
+/// The number of independent partial sums used by the kernels, which allows them to be vectorised
+constexpr SizeType PAIRWISE_LANES = 8;
+
+/**
+ * Sum term(a[k], b[k]) over the features of two rows. The features are accumulated into a fixed
+ * number of independent partial sums so that the compiler is free to vectorise the loop, the order
+ * of the summation is the same on every platform.
+ */
+template <typename Type, typename Term>
+Type AccumulateKernel(Type const *a, Type const *b, SizeType num_features, Term const &term)
+{
+  Type lanes[PAIRWISE_LANES];
+  std::fill(lanes, lanes + PAIRWISE_LANES, Type{0});
+
+  SizeType k = 0;
+  for (; (k + PAIRWISE_LANES) <= num_features; k += PAIRWISE_LANES)
+  {
+    for (SizeType lane = 0; lane < PAIRWISE_LANES; ++lane)
+    {
+      lanes[lane] += term(a[k + lane], b[k + lane]);
+    }
+  }
+
+  Type sum{0};
+  for (; k < num_features; ++k)
+  {
+    sum += term(a[k], b[k]);
+  }
+
+  for (SizeType lane = 0; lane < PAIRWISE_LANES; ++lane)
+  {
+    sum += lanes[lane];
+  }
+
+  return sum;
+}
+
+template <typename Type>
+Type SquareDistanceKernel(Type const *a, Type const *b, SizeType num_features)
+{
+  return AccumulateKernel(a, b, num_features, [](Type const &x, Type const &y) {
+    Type const diff = x - y;
+    return diff * diff;
+  });
+}
+
+template <typename Type>
+Type ManhattanKernel(Type const *a, Type const *b, SizeType num_features)
+{
+  return AccumulateKernel(a, b, num_features,
+                          [](Type const &x, Type const &y) { return fetch::math::Abs(x - y); });
+}
+
+template <typename Type>
+Type DotKernel(Type const *a, Type const *b, SizeType num_features)
+{
+  return AccumulateKernel(a, b, num_features,
+                          [](Type const &x, Type const &y) { return x * y; });
+}
+
+/**
+ * Copy the rows of a matrix into a contiguous (row major) buffer
+ */
+template <typename ArrayType>
+std::vector<typename ArrayType::Type> PackRows(ArrayType const &a)
+{
+  SizeType const num_rows     = a.shape(0);
+  SizeType const num_features = a.shape(1);
+
+  std::vector<typename ArrayType::Type> packed(num_rows * num_features);
+  for (SizeType i = 0; i < num_rows; ++i)
+  {
+    for (SizeType k = 0; k < num_features; ++k)
+    {
+      packed[(i * num_features) + k] = a.At(i, k);
+    }
+  }
+
+  return packed;
+}
+
+/**
+ * Compute the distance between every pair (i, j), i < j, of rows of a packed matrix and pass it
+ * to output(i, j, distance)
+ */
+template <typename Type, typename Output>
+void PairWiseBlocked(std::vector<Type> const &rows, SizeType num_rows, SizeType num_features,
+                     PairWiseMetric metric, Output const &output)
+{
+  // the norms are only needed by the cosine distance
+  std::vector<Type> norms{};
+  if (metric == PairWiseMetric::COSINE)
+  {
+    norms.resize(num_rows);
+    for (SizeType i = 0; i < num_rows; ++i)
+    {
+      Type const *row = rows.data() + (i * num_features);
+      norms[i]        = fetch::math::Sqrt(DotKernel(row, row, num_features));
+    }
+  }
+
+  auto const distance = [&](SizeType i, SizeType j) -> Type {
+    Type const *a = rows.data() + (i * num_features);
+    Type const *b = rows.data() + (j * num_features);
+
+    switch (metric)
+    {
+    case PairWiseMetric::EUCLIDEAN:
+      return fetch::math::Sqrt(SquareDistanceKernel(a, b, num_features));
+    case PairWiseMetric::MANHATTAN:
+      return ManhattanKernel(a, b, num_features);
+    case PairWiseMetric::COSINE:
+    {
+      Type const denominator = norms[i] * norms[j];
+
+      // a zero vector is treated as being orthogonal to everything
+      if (denominator == Type{0})
+      {
+        return Type{1};
+      }
+
+      return Type{1} - (DotKernel(a, b, num_features) / denominator);
+    }
+    }
+
+    return Type{0};
+  };
+
+  // the upper triangle of tiles, including the diagonal
+  SizeType const num_blocks = (num_rows + PAIRWISE_BLOCK_SIZE - 1) / PAIRWISE_BLOCK_SIZE;
+  std::vector<std::pair<SizeType, SizeType>> tiles{};
+  tiles.reserve((num_blocks * (num_blocks + 1)) / 2);
+  for (SizeType bi = 0; bi < num_blocks; ++bi)
+  {
+    for (SizeType bj = bi; bj < num_blocks; ++bj)
+    {
+      tiles.emplace_back(bi, bj);
+    }
+  }
+
+  auto const compute = [&](std::size_t tile) {
+    SizeType const row_begin = tiles[tile].first * PAIRWISE_BLOCK_SIZE;
+    SizeType const row_end   = std::min(row_begin + PAIRWISE_BLOCK_SIZE, num_rows);
+    SizeType const col_begin = tiles[tile].second * PAIRWISE_BLOCK_SIZE;
+    SizeType const col_end   = std::min(col_begin + PAIRWISE_BLOCK_SIZE, num_rows);
+
+    for (SizeType i = row_begin; i < row_end; ++i)
+    {
+      for (SizeType j = std::max(col_begin, i + 1); j < col_end; ++j)
+      {
+        output(i, j, distance(i, j));
+      }
+    }
+  };
+
+  SizeType const num_pairs   = (num_rows * (num_rows - 1)) / 2;
+  std::size_t    num_threads = 1;
+  if ((num_pairs * num_features) >= PAIRWISE_MIN_THREADED_SIZE)
+  {
+    num_threads = std::min(tiles.size(), PairWiseConcurrency());
+  }
+
+  ParallelPairWiseTasks(tiles.size(), num_threads, compute);
+}
+
+}  // namespace details
+
 template <typename ArrayType, typename F>
 meta::IfIsMathArray<ArrayType, ArrayType> &PairWiseDistance(ArrayType const &a, F &&metric,
                                                             ArrayType &ret)
@@ -49,6 +256,85 @@ meta::IfIsMathArray<ArrayType, ArrayType> &PairWiseDistance(ArrayType const &a,
   return ret;
 }
 
+/**
+ * Computes the distances between all pairs of rows of a matrix with one of the builtin metrics
+ * using the blocked, multithreaded kernel
+ *
+ * @param a The input matrix of shape # data points X # feature dimensions
+ * @param metric The distance metric
+ * @param ret The condensed output of shape {1, n * (n - 1) / 2}, in the same order as the generic
+ * PairWiseDistance
+ */
+template <typename ArrayType>
+meta::IfIsMathArray<ArrayType, ArrayType> &PairWiseDistance(ArrayType const &a,
+                                                            PairWiseMetric metric, ArrayType &ret)
+{
+  using Type = typename ArrayType::Type;
+
+  assert(a.shape().size() == 2);
+  detailed_assert(ret.shape().size() == 2);
+  detailed_assert(ret.shape(0) == 1);
+  detailed_assert(ret.shape(1) == (a.shape(0) * (a.shape(0) - 1) / 2));
+
+  SizeType const n = a.shape(0);
+  if (n < 2)
+  {
+    return ret;
+  }
+
+  details::PairWiseBlocked(details::PackRows(a), n, a.shape(1), metric,
+                           [&ret, n](SizeType i, SizeType j, Type const &value) {
+                             SizeType const index = ((i * ((2 * n) - i - 1)) / 2) + (j - i - 1);
+                             ret(SizeType{0}, index) = value;
+                           });
+
+  return ret;
+}
+
+/**
+ * Computes the symmetric matrix of distances between all pairs of rows of a matrix with one of the
+ * builtin metrics using the blocked, multithreaded kernel
+ *
+ * @param a The input matrix of shape # data points X # feature dimensions
+ * @param metric The distance metric
+ * @param ret The output distance matrix of shape {n, n}
+ */
+template <typename ArrayType>
+meta::IfIsMathArray<ArrayType, ArrayType> &PairWiseDistanceMatrix(ArrayType const &a,
+                                                                  PairWiseMetric  metric,
+                                                                  ArrayType &     ret)
+{
+  using Type = typename ArrayType::Type;
+
+  assert(a.shape().size() == 2);
+  detailed_assert(ret.shape().size() == 2);
+  detailed_assert(ret.shape(0) == a.shape(0));
+  detailed_assert(ret.shape(1) == a.shape(0));
+
+  SizeType const n = a.shape(0);
+  for (SizeType i = 0; i < n; ++i)
+  {
+    ret(i, i) = Type{0};
+  }
+
+  details::PairWiseBlocked(details::PackRows(a), n, a.shape(1), metric,
+                           [&ret](SizeType i, SizeType j, Type const &value) {
+                             ret(i, j) = value;
+                             ret(j, i) = value;
+                           });
+
+  return ret;
+}
+
+template <typename ArrayType>
+meta::IfIsMathArray<ArrayType, ArrayType> PairWiseDistanceMatrix(ArrayType const &a,
+                                                                 PairWiseMetric   metric)
+{
+  ArrayType ret({a.shape(0), a.shape(0)});
+  PairWiseDistanceMatrix(a, metric, ret);
+  return ret;
+}
+
 }  // namespace distance
 }  // namespace math
 }  // namespace fetch
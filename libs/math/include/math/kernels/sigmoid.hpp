@@ -0,0 +1,56 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/fundamental_operators.hpp"
+#include "math/standard_functions/exp.hpp"
+
+namespace fetch {
+namespace math {
+namespace kernels {
+
+/**
+ * The numerically stable sigmoid of a single value. The output may alias the input.
+ */
+struct Sigmoid
+{
+  template <typename Type>
+  void operator()(Type const &x, Type &y) const
+  {
+    Type const zero{0};
+    Type const one{1};
+    Type const min_one{-1};
+
+    if (x >= zero)
+    {
+      Multiply(min_one, x, y);
+      Exp(y, y);
+      Add(y, one, y);
+      Divide(one, y, y);
+    }
+    else
+    {
+      Exp(x, y);
+      Divide(y, y + one, y);
+    }
+  }
+};
+
+}  // namespace kernels
+}  // namespace math
+}  // namespace fetch
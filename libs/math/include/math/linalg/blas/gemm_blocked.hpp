@@ -0,0 +1,119 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+/* The classes defined in this file implement the equivalent of following Python code:
+ *
+ * import numpy as np
+ *
+ * def gemm_blocked(alpha, A, B, beta, C):
+ *   C = alpha * np.dot(A, B) + beta * C
+ *
+ *   return C
+ *
+ * (and the variants for which A or B are transposed) for large matrices.
+ *
+ * The product is computed in the style of BLIS: panels of B and blocks of A are packed into
+ * contiguous buffers sized for the caches, and a small register tile of C is accumulated by the
+ * micro-kernel at a time. Independent blocks of rows of C are distributed over a shared thread
+ * pool. The order of the summation for every element of C does not depend on the number of
+ * threads, so the result is deterministic.
+ *
+ * Problems which are too small to benefit from the packing (or for which alpha is zero) are handed
+ * to the unblocked vectorised kernels.
+ */
+
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/prototype.hpp"
+#include "math/tensor/tensor_view.hpp"
+
+#include <cstddef>
+
+namespace fetch {
+namespace math {
+namespace linalg {
+
+// The maximum number of threads used by the blocked kernels
+void        SetGemmConcurrency(std::size_t concurrency);
+std::size_t GemmConcurrency();
+
+template <typename S>
+class GemmBlocked
+{
+public:
+  using Type = S;
+
+  /// @name Blocking Parameters
+  /// @{
+  static constexpr std::size_t MR = 4;     ///< The height of the register tile
+  static constexpr std::size_t NR = 8;     ///< The width of the register tile
+  static constexpr std::size_t MC = 128;   ///< The height of the packed blocks of A
+  static constexpr std::size_t KC = 256;   ///< The depth of the packed blocks of A and B
+  static constexpr std::size_t NC = 2048;  ///< The width of the packed panels of B
+  /// @}
+
+  /// The number of multiply-adds below which the unblocked kernels are used
+  static constexpr std::size_t MIN_BLOCKED_SIZE = 48 * 48 * 48;
+  /// The number of multiply-adds below which the product is never split across threads
+  static constexpr std::size_t MIN_THREADED_SIZE = 128 * 128 * 128;
+
+  static bool IsBlocked(std::size_t m, std::size_t n, std::size_t k);
+
+  static void Multiply(Type alpha, TensorView<Type> a, bool transpose_a, TensorView<Type> b,
+                       bool transpose_b, Type beta, TensorView<Type> c);
+};
+
+template <typename S>
+class Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
+           Computes(_C <= _alpha * _A * _B + _beta * _C),
+           platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>
+{
+public:
+  using Type = S;
+
+  void operator()(Type alpha, TensorView<Type> a, TensorView<Type> b, Type beta,
+                  TensorView<Type> c) const;
+};
+
+template <typename S>
+class Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
+           Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+           platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>
+{
+public:
+  using Type = S;
+
+  void operator()(Type alpha, TensorView<Type> a, TensorView<Type> b, Type beta,
+                  TensorView<Type> c) const;
+};
+
+template <typename S>
+class Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
+           Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+           platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>
+{
+public:
+  using Type = S;
+
+  void operator()(Type alpha, TensorView<Type> a, TensorView<Type> b, Type beta,
+                  TensorView<Type> c) const;
+};
+
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
@@ -21,6 +21,7 @@
 #include "math/exceptions/exceptions.hpp"
 #include "math/fundamental_operators.hpp"
 #include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_blocked.hpp"
 #include "math/linalg/blas/gemm_nn_novector.hpp"
 #include "math/linalg/blas/gemm_nn_vector.hpp"
 #include "math/linalg/blas/gemm_nt_novector.hpp"
@@ -30,10 +31,12 @@
 #include "math/linalg/prototype.hpp"
 #include "math/meta/math_type_traits.hpp"
 #include "math/tensor/tensor_reduce.hpp"
+#include "math/tensor/tensor_strided_view.hpp"
 #include "vectorise/math/standard_functions.hpp"
 
 #include <cassert>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 
 namespace fetch {
@@ -558,11 +561,12 @@ meta::IfIsMathArray<ArrayType, typename ArrayType::Type> Sum(ArrayType const &ar
 template <typename ArrayType>
 void ReduceSum(ArrayType const &obj1, SizeType axis, ArrayType &ret)
 {
-
   using DataType = typename ArrayType::Type;
-  ret.Fill(DataType{0});
 
-  Reduce(axis, [](DataType const &x, DataType &y) { y = static_cast<DataType>(y + x); }, obj1, ret);
+  auto const sum = [](auto const &x, auto &y) {
+    y = static_cast<std::decay_t<decltype(y)>>(y + x);
+  };
+  VectorisedReduce(axis, sum, DataType{0}, obj1, ret);
 }
 
 /**
@@ -858,10 +862,10 @@ ArrayType PeakToPeak(ArrayType const &array, typename ArrayType::SizeType const
 template <typename ArrayType>
 void ReduceMax(ArrayType const &obj1, SizeType axis, ArrayType &ret)
 {
-
   using DataType = typename ArrayType::Type;
-  ret.Fill(numeric_lowest<DataType>());
-  Reduce(axis, [](DataType const &x, DataType &y) { y = (x < y) ? y : x; }, obj1, ret);
+
+  auto const max = [](auto const &x, auto &y) { y = vectorise::Max(x, y); };
+  VectorisedReduce(axis, max, numeric_lowest<DataType>(), obj1, ret);
 }
 
 /**
@@ -961,63 +965,59 @@ meta::IfIsMathArray<ArrayType, void> ArgMax(ArrayType const &array, ArrayType &r
     assert(axis_length > 1);
     assert(ret.size() == Divide(Product(array.shape()), array.shape()[axis]));
 
-    ret.Fill(Type(0));
-
-    // specialisation uses View if axis == last dimension
-    if (axis == array.shape().size() - 1)
-    {
-      auto max_view = (array.View(0)).Copy();
-
-      for (SizeType n{1}; n < axis_length; ++n)
+    // the same as a reduction along the axis, but the output has no dimension for the axis
+    details::ReduceLayout const layout = details::ReduceLayoutOf(axis, array);
+
+    Type const *   a        = array.data().pointer();
+    Type *         r        = ret.data().pointer();
+    SizeType const a_height = array.padded_height();
+    SizeType const r_height = ret.padded_height();
+    SizeType const r_rows   = ret.shape().empty() ? 1 : ret.shape(0);
+    SizeType const height   = (axis == 0) ? 1 : array.shape(0);
+
+    // the output element at a position in the order of its iterator
+    auto const output = [r, r_height, r_rows](SizeType position) -> Type & {
+      return r[(position % r_rows) + r_height * (position / r_rows)];
+    };
+
+    details::ParallelTensorRanges(layout.columns, array.size(), [&](SizeType from, SizeType to) {
+      std::vector<Type> max_column(height);
+      std::vector<Type> arg_column(height);
+      for (SizeType c = from; c < to; ++c)
       {
-        auto cur_view = array.View(n);
+        Type const *a_column = a + details::ReduceColumn(layout, c, 0) * a_height;
+        SizeType    stride   = a_height * layout.mid;
+        if (axis == 0)
+        {
+          a_column = a + c * a_height;
+          stride   = 1;
+        }
 
-        auto max_view_it = max_view.begin();
-        auto cur_view_it = cur_view.begin();
-        auto ret_it      = ret.begin();
+        std::copy(a_column, a_column + height, max_column.begin());
+        std::fill(arg_column.begin(), arg_column.end(), Type{0});
 
-        // check every element in the n-1 dimensional return
-        while (max_view_it.is_valid())
+        for (SizeType n{1}; n < axis_length; ++n)
         {
-          if (*cur_view_it > *max_view_it)
+          a_column += stride;
+          for (SizeType i{0}; i < height; ++i)
           {
-            *ret_it      = static_cast<Type>(n);
-            *max_view_it = *cur_view_it;
+            if (a_column[i] > max_column[i])
+            {
+              arg_column[i] = static_cast<Type>(n);
+              max_column[i] = a_column[i];
+            }
           }
-          ++ret_it;
-          ++cur_view_it;
-          ++max_view_it;
         }
-      }
-    }
-    else
-    {
-      auto max_slice = (array.Slice(0, axis)).Copy();
-
-      for (SizeType n{1}; n < axis_length; ++n)
-      {
-        auto cur_slice = array.Slice(n, axis);
-
-        auto max_slice_it = max_slice.begin();
-        auto cur_slice_it = cur_slice.cbegin();
-        auto ret_it       = ret.begin();
 
-        // check every element in the n-1 dimensional return
-        while (max_slice_it.is_valid())
+        for (SizeType i{0}; i < height; ++i)
         {
-          if (*cur_slice_it > *max_slice_it)
-          {
-            *ret_it       = static_cast<Type>(n);
-            *max_slice_it = *cur_slice_it;
-          }
-          ++ret_it;
-          ++cur_slice_it;
-          ++max_slice_it;
+          output(i + height * c) = arg_column[i];
         }
       }
-    }
+    });
   }
 }
+
 template <typename ArrayType>
 meta::IfIsMathArray<ArrayType, ArrayType> ArgMax(ArrayType const &array, SizeType axis = 0)
 {
@@ -1076,9 +1076,10 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> Dot(ArrayType const &A, ArrayT
 
   enum
   {
-    OPTIMISATION_FLAGS = meta::HasVectorSupport<Type>::value
-                             ? platform::Parallelisation::VECTORISE
-                             : platform::Parallelisation::NOT_PARALLEL
+    OPTIMISATION_FLAGS =
+        meta::HasVectorSupport<Type>::value
+            ? (platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING)
+            : platform::Parallelisation::NOT_PARALLEL
   };
 
   Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
@@ -1116,7 +1117,7 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> DotTranspose(ArrayType const &
     throw exceptions::WrongShape("expected A and B to have same width.");
   }
 
-  if (ret.shape() != std::vector<SizeType>({aview.height(), bview.width()}))
+  if (ret.shape() != std::vector<SizeType>({aview.height(), bview.height()}))
   {
     ret.Resize({aview.height(), bview.height()});
   }
@@ -1126,9 +1127,10 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> DotTranspose(ArrayType const &
 
   enum
   {
-    OPTIMISATION_FLAGS = meta::HasVectorSupport<Type>::value
-                             ? platform::Parallelisation::VECTORISE
-                             : platform::Parallelisation::NOT_PARALLEL
+    OPTIMISATION_FLAGS =
+        meta::HasVectorSupport<Type>::value
+            ? (platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING)
+            : platform::Parallelisation::NOT_PARALLEL
   };
 
   Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
@@ -1167,7 +1169,7 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> TransposeDot(ArrayType const &
     throw exceptions::WrongShape("expected A and B to have same height.");
   }
 
-  if (ret.shape() != std::vector<SizeType>({aview.height(), bview.width()}))
+  if (ret.shape() != std::vector<SizeType>({aview.width(), bview.width()}))
   {
     ret.Resize({aview.width(), bview.width()});
   }
@@ -1177,9 +1179,10 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> TransposeDot(ArrayType const &
 
   enum
   {
-    OPTIMISATION_FLAGS = meta::HasVectorSupport<Type>::value
-                             ? platform::Parallelisation::VECTORISE
-                             : platform::Parallelisation::NOT_PARALLEL
+    OPTIMISATION_FLAGS =
+        meta::HasVectorSupport<Type>::value
+            ? (platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING)
+            : platform::Parallelisation::NOT_PARALLEL
   };
 
   Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
@@ -1199,6 +1202,130 @@ fetch::math::meta::IfIsMathArray<ArrayType, ArrayType> TransposeDot(ArrayType co
   return ret;
 }
 
+namespace details {
+
+/**
+ * The gemm operand for a strided view: plain and transposed matrices are used in place, any
+ * other view is materialised into storage first
+ * @param view The view
+ * @param transposed Set if the operand is the transpose of the returned TensorView
+ * @param storage Holds the materialised view, when a copy is needed
+ * @return The TensorView to pass to the gemm kernel
+ */
+template <typename S, typename C>
+TensorView<S, C> GemmOperand(TensorStridedView<S, C> const &view, bool &transposed,
+                             Tensor<S, C> &storage)
+{
+  transposed = view.IsTransposedMatrix();
+  if (transposed)
+  {
+    return view.Transpose().MatrixView();
+  }
+  if (view.IsMatrix())
+  {
+    return view.MatrixView();
+  }
+
+  storage = view.Copy();
+  return storage.View();
+}
+
+}  // namespace details
+
+/**
+ * Routine for C = A.B on strided views, a transposed operand is passed to the NT or TN gemm kernel
+ * without copying it
+ * @param A
+ * @param B
+ * @param ret View of the output, which must have the shape of the product
+ */
+template <typename S, typename C>
+void Dot(TensorStridedView<S, C> const &A, TensorStridedView<S, C> const &B, TensorView<S, C> ret)
+{
+  if ((A.shape().size() != 2) || (B.shape().size() != 2) || (A.shape(1) != B.shape(0)))
+  {
+    throw exceptions::WrongShape("expected 2D views, with A width equal to B height.");
+  }
+
+  if ((ret.height() != A.shape(0)) || (ret.width() != B.shape(1)))
+  {
+    throw exceptions::WrongShape("expected output of shape A height by B width.");
+  }
+
+  using namespace linalg;
+
+  enum
+  {
+    OPTIMISATION_FLAGS =
+        meta::HasVectorSupport<S>::value
+            ? (platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING)
+            : platform::Parallelisation::NOT_PARALLEL
+  };
+
+  bool         transpose_a{false};
+  bool         transpose_b{false};
+  Tensor<S, C> a_storage;
+  Tensor<S, C> b_storage;
+
+  auto a = details::GemmOperand(A, transpose_a, a_storage);
+  auto b = details::GemmOperand(B, transpose_b, b_storage);
+
+  // there is no TT kernel for every type, so one of two transposed operands is materialised
+  if (transpose_a && transpose_b)
+  {
+    b_storage   = B.Copy();
+    b           = b_storage.View();
+    transpose_b = false;
+  }
+
+  auto const one  = static_cast<S>(1);
+  auto const zero = static_cast<S>(0);
+
+  if (!transpose_a && !transpose_b)
+  {
+    Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
+         Computes(_C <= _alpha * _A * _B + _beta * _C), OPTIMISATION_FLAGS>
+        gemm_nn;
+    gemm_nn(one, a, b, zero, ret);
+  }
+  else if (transpose_a && !transpose_b)
+  {
+    Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
+         Computes(_C <= _alpha * T(_A) * _B + _beta * _C), OPTIMISATION_FLAGS>
+        gemm_tn;
+    gemm_tn(one, a, b, zero, ret);
+  }
+  else
+  {
+    Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
+         Computes(_C <= _alpha * _A * T(_B) + _beta * _C), OPTIMISATION_FLAGS>
+        gemm_nt;
+    gemm_nt(one, a, b, zero, ret);
+  }
+}
+
+/**
+ * Routine for C = A.B on strided views, resizing C to the shape of the product
+ * @param A
+ * @param B
+ * @param ret
+ */
+template <typename S, typename C>
+void Dot(TensorStridedView<S, C> const &A, TensorStridedView<S, C> const &B, Tensor<S, C> &ret)
+{
+  if ((A.shape().size() != 2) || (B.shape().size() != 2))
+  {
+    throw exceptions::WrongShape("expected 2D views.");
+  }
+
+  if (ret.shape() != SizeVector({A.shape(0), B.shape(1)}))
+  {
+    ret.Resize({A.shape(0), B.shape(1)});
+  }
+
+  Dot(A, B, ret.View());
+}
+
 template <typename ArrayType>
 fetch::math::meta::IfIsMathArray<ArrayType, void> DynamicStitch(ArrayType &      input_array,
                                                                 ArrayType const &indices,
@@ -0,0 +1,270 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+/* Reduced precision storage for the fixed point tensors used during inference.
+ *
+ * The values are stored as 16 bit integers with a configurable number of fractional bits (Q8.8 by
+ * default) which halves (or quarters) the memory traffic of large weight matrices. The products are
+ * accumulated exactly in the next larger integer type of the full precision fixed point type, and
+ * the result is only truncated once at the end. Since integer addition is associative the result
+ * does not depend on the order of the summation, and as such is deterministic regardless of how the
+ * loops are vectorised by the compiler.
+ */
+
+#include "math/base_types.hpp"
+#include "math/exceptions/exceptions.hpp"
+#include "math/meta/math_type_traits.hpp"
+#include "math/tensor/tensor.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace fetch {
+namespace math {
+
+using ReducedType   = int16_t;
+using ReducedTensor = Tensor<ReducedType>;
+using ReducedLimits = std::numeric_limits<ReducedType>;
+
+static constexpr uint16_t DEFAULT_REDUCED_FRACTIONAL_BITS = 8;
+
+namespace details {
+
+template <typename T>
+void CheckReducedFractionalBits(uint16_t fractional_bits)
+{
+  if ((fractional_bits >= 16) || (fractional_bits > T::FRACTIONAL_BITS))
+  {
+    throw exceptions::InvalidMode("invalid number of fractional bits for reduced precision");
+  }
+}
+
+/**
+ * Saturate a raw fixed point value (with the same number of fractional bits as the reduced type)
+ * into the reduced type
+ */
+template <typename T, typename V>
+ReducedType SaturateToReduced(V value)
+{
+  if (value > static_cast<V>(ReducedLimits::max()))
+  {
+    T::fp_state |= T::STATE_OVERFLOW;
+    return ReducedLimits::max();
+  }
+
+  if (value < static_cast<V>(ReducedLimits::min()))
+  {
+    T::fp_state |= T::STATE_OVERFLOW;
+    return ReducedLimits::min();
+  }
+
+  return static_cast<ReducedType>(value);
+}
+
+/**
+ * Saturate an accumulated raw value (with the fractional bits of T) into T
+ */
+template <typename T>
+T SaturateToFixed(typename T::NextType value)
+{
+  if (T::CheckOverflow(value))
+  {
+    T::fp_state |= T::STATE_OVERFLOW;
+    return T::FP_MAX;
+  }
+
+  if (T::CheckUnderflow(value))
+  {
+    T::fp_state |= T::STATE_OVERFLOW;
+    return T::FP_MIN;
+  }
+
+  return T::FromBase(static_cast<typename T::Type>(value));
+}
+
+}  // namespace details
+
+/**
+ * Convert a full precision fixed point tensor into the reduced precision storage format. Values
+ * which do not fit are saturated (and the overflow state of T is set), NaNs are stored as zero.
+ *
+ * @tparam T the full precision fixed point type
+ * @param src the input tensor
+ * @param ret the output tensor, which must have the same shape as src
+ * @param fractional_bits the number of fractional bits of the reduced representation
+ */
+template <typename T>
+meta::IfIsFixedPoint<T, void> Quantise(Tensor<T> const &src, ReducedTensor &ret,
+                                       uint16_t fractional_bits = DEFAULT_REDUCED_FRACTIONAL_BITS)
+{
+  details::CheckReducedFractionalBits<T>(fractional_bits);
+
+  if (src.shape() != ret.shape())
+  {
+    throw exceptions::WrongShape("reduced precision tensor shape does not match the source");
+  }
+
+  auto const shift = static_cast<uint16_t>(T::FRACTIONAL_BITS - fractional_bits);
+
+  auto it  = src.cbegin();
+  auto rit = ret.begin();
+  while (it.is_valid())
+  {
+    T const &value = *it;
+
+    if (T::IsNaN(value))
+    {
+      T::fp_state |= T::STATE_NAN;
+      *rit = 0;
+    }
+    else if (T::IsPosInfinity(value))
+    {
+      T::fp_state |= T::STATE_INFINITY;
+      *rit = ReducedLimits::max();
+    }
+    else if (T::IsNegInfinity(value))
+    {
+      T::fp_state |= T::STATE_INFINITY;
+      *rit = ReducedLimits::min();
+    }
+    else
+    {
+      *rit = details::SaturateToReduced<T>(value.Data() >> shift);
+    }
+
+    ++it;
+    ++rit;
+  }
+}
+
+template <typename T>
+meta::IfIsFixedPoint<T, ReducedTensor> Quantise(
+    Tensor<T> const &src, uint16_t fractional_bits = DEFAULT_REDUCED_FRACTIONAL_BITS)
+{
+  ReducedTensor ret{src.shape()};
+  Quantise(src, ret, fractional_bits);
+  return ret;
+}
+
+/**
+ * Convert a tensor in the reduced precision storage format back to full precision. This is exact.
+ *
+ * @tparam T the full precision fixed point type
+ * @param src the reduced precision tensor
+ * @param ret the output tensor, which must have the same shape as src
+ * @param fractional_bits the number of fractional bits of the reduced representation
+ */
+template <typename T>
+meta::IfIsFixedPoint<T, void> Dequantise(ReducedTensor const &src, Tensor<T> &ret,
+                                         uint16_t fractional_bits = DEFAULT_REDUCED_FRACTIONAL_BITS)
+{
+  details::CheckReducedFractionalBits<T>(fractional_bits);
+
+  if (src.shape() != ret.shape())
+  {
+    throw exceptions::WrongShape("reduced precision tensor shape does not match the output");
+  }
+
+  using Type       = typename T::Type;
+  auto const shift = static_cast<uint16_t>(T::FRACTIONAL_BITS - fractional_bits);
+
+  auto it  = src.cbegin();
+  auto rit = ret.begin();
+  while (it.is_valid())
+  {
+    // multiply rather than shift since left shifts of negative values are undefined
+    *rit = T::FromBase(static_cast<Type>(static_cast<Type>(*it) * (Type{1} << shift)));
+
+    ++it;
+    ++rit;
+  }
+}
+
+/**
+ * Computes ret = dot(a, b) where a is stored in reduced precision and b and ret are full precision.
+ *
+ * Each product is formed exactly in the next larger integer type of T and the sums are kept in
+ * that type, so there is a single truncation (and saturation) per output element.
+ *
+ * @tparam T the full precision fixed point type
+ * @param a the reduced precision matrix of shape [m, k], typically the weights
+ * @param b the full precision matrix of shape [k, n]
+ * @param ret the output matrix of shape [m, n]
+ * @param fractional_bits the number of fractional bits of the reduced representation of a
+ */
+template <typename T>
+meta::IfIsFixedPoint<T, void> ReducedDot(ReducedTensor const &a, Tensor<T> const &b, Tensor<T> &ret,
+                                         uint16_t fractional_bits = DEFAULT_REDUCED_FRACTIONAL_BITS)
+{
+  using NextType = typename T::NextType;
+
+  details::CheckReducedFractionalBits<T>(fractional_bits);
+
+  if ((a.shape().size() != 2) || (b.shape().size() != 2) || (ret.shape().size() != 2) ||
+      (a.shape(1) != b.shape(0)) || (ret.shape(0) != a.shape(0)) || (ret.shape(1) != b.shape(1)))
+  {
+    throw exceptions::WrongShape("incompatible shapes for reduced precision dot");
+  }
+
+  SizeType const m = a.shape(0);
+  SizeType const k = a.shape(1);
+  SizeType const n = b.shape(1);
+
+  ReducedType const *const data_a = a.data().pointer();
+  SizeType const           lda    = a.padded_height();
+
+  std::vector<NextType> accumulator(m);
+  for (SizeType j = 0; j < n; ++j)
+  {
+    std::fill(accumulator.begin(), accumulator.end(), NextType{0});
+
+    for (SizeType p = 0; p < k; ++p)
+    {
+      auto const               value  = static_cast<NextType>(b.At(p, j).Data());
+      ReducedType const *const column = data_a + (p * lda);
+
+      // the storage is column major, so this loop runs over contiguous memory
+      for (SizeType i = 0; i < m; ++i)
+      {
+        accumulator[i] += static_cast<NextType>(column[i]) * value;
+      }
+    }
+
+    for (SizeType i = 0; i < m; ++i)
+    {
+      ret.At(i, j) = details::SaturateToFixed<T>(accumulator[i] >> fractional_bits);
+    }
+  }
+}
+
+template <typename T>
+meta::IfIsFixedPoint<T, Tensor<T>> ReducedDot(
+    ReducedTensor const &a, Tensor<T> const &b,
+    uint16_t fractional_bits = DEFAULT_REDUCED_FRACTIONAL_BITS)
+{
+  Tensor<T> ret{{a.shape(0), b.shape(1)}};
+  ReducedDot(a, b, ret, fractional_bits);
+  return ret;
+}
+
+}  // namespace math
+}  // namespace fetch
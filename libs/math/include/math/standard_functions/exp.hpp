@@ -19,6 +19,8 @@
 
 #include "math/meta/math_type_traits.hpp"
 #include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/math/exact_exp.hpp"
+#include "vectorise/memory/range.hpp"
 
 #include <cassert>
 
@@ -61,7 +63,7 @@ meta::IfIsArithmetic<Type, Type> Exp(Type const &x)
 }
 
 template <typename ArrayType>
-meta::IfIsMathArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
+meta::IfIsMathNonFixedPointArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
 {
   assert(ret.shape() == array.shape());
   auto it1 = array.cbegin();
@@ -74,13 +76,63 @@ meta::IfIsMathArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
   }
 }
 
+namespace details {
+
+/**
+ * Apply a register kernel to every element of a fixed point tensor. The padding of each column is
+ * skipped so that it keeps its value, short columns are therefore mostly handled by the scalar
+ * tail of the dispatcher.
+ */
+template <typename ArrayType, typename Kernel>
+void ApplyExactKernel(ArrayType const &array, ArrayType &ret, Kernel const &kernel)
+{
+  using SizeType = typename ArrayType::SizeType;
+
+  SizeType const height = array.height();
+  if ((height == 0) || (array.size() == 0))
+  {
+    return;
+  }
+
+  SizeType const padded_height = array.padded_height();
+  SizeType const num_columns   = array.size() / height;
+
+  if (padded_height == height)
+  {
+    memory::Range const range(0, array.size());
+    ret.data().in_parallel().RangedApplyMultiple(range, Kernel{kernel}, array.data());
+    return;
+  }
+
+  for (SizeType column = 0; column < num_columns; ++column)
+  {
+    SizeType const      offset = column * padded_height;
+    memory::Range const range(offset, offset + height);
+    ret.data().in_parallel().RangedApplyMultiple(range, Kernel{kernel}, array.data());
+  }
+}
+
+}  // namespace details
+
+/**
+ * Fixed point tensors are processed a register at a time. The result is bit-identical to the
+ * elementwise implementation on every platform.
+ */
+template <typename ArrayType>
+meta::IfIsMathFixedPointArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
+{
+  assert(ret.shape() == array.shape());
+
+  details::ApplyExactKernel(array, ret,
+                            [](auto const &x, auto &y) { y = vectorise::exact_exp(x); });
+}
+
 template <typename ArrayType>
 meta::IfIsMathArray<ArrayType, ArrayType> Exp(ArrayType const &array)
 {
   ArrayType ret{array.shape()};
   Exp(array, ret);
   return ret;
-  return ret;
 }
 
 }  // namespace math
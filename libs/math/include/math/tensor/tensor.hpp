@@ -25,6 +25,7 @@
 #include "math/matrix_operations.hpp"
 #include "math/tensor/tensor_iterator.hpp"
 #include "math/tensor/tensor_slice_iterator.hpp"
+#include "math/tensor/tensor_strided_view.hpp"
 #include "math/tensor/tensor_view.hpp"
 
 #include <cassert>
@@ -104,6 +105,7 @@ public:
   Tensor(Tensor &&other) noexcept = default;
   Tensor(Tensor const &other)     = default;
   explicit Tensor(SizeVector const &dims);
+  Tensor(SizeVector const &dims, ContainerType data);
   virtual ~Tensor() = default;
 
   Tensor &operator=(Tensor const &other) = default;
@@ -177,7 +179,7 @@ public:
   static SizeType PaddedSizeFromShape(SizeVector const &shape);
 
   void    Flatten();
-  Tensor  Transpose() const;  // TODO (private 867)
+  Tensor  Transpose() const;
   Tensor  Transpose(SizeVector &new_axes) const;
   Tensor &Squeeze();
   Tensor &Unsqueeze();
@@ -273,6 +275,8 @@ public:
   TensorView<Type, ContainerType>       View(std::vector<SizeType> indices);
   TensorView<Type, ContainerType> const View(std::vector<SizeType> indices) const;
 
+  TensorStridedView<Type, ContainerType> StridedView() const;
+
   /////////////////////////
   /// general utilities ///
   /////////////////////////
@@ -582,21 +586,6 @@ private:
     }
   }
 
-  void TransposeImplementation(SizeVector &new_axes, Tensor &ret) const
-  {
-    ConstSliceIteratorType it(*this);
-    SliceIteratorType      ret_it(ret);
-
-    ret_it.Transpose(new_axes);
-
-    while (it.is_valid())
-    {
-      *ret_it = *it;
-      ++it;
-      ++ret_it;
-    }
-  }
-
   /**
    * The TensorSlice is a convenience method for efficiently manipulating
    * SubTensors (e.g. such as a 1D Slice). It is built on top of TensorSliceIterator
@@ -19,6 +19,7 @@
 
 #include "math/base_types.hpp"
 #include "math/tensor/tensor_declaration.hpp"
+#include "math/tensor/tensor_parallel.hpp"
 #include "math/tensor/tensor_slice_iterator.hpp"
 
 #include <cassert>
@@ -133,6 +134,61 @@ std::vector<SizeVector> PrepareRange(Tensor<T, C> const &a)
   return range;
 }
 
+namespace details {
+
+/**
+ * The storage offsets of an input of a broadcast with the same rank as its output. Broadcast
+ * dimensions have no stride, so that their single element is repeated.
+ */
+struct BroadcastStrides
+{
+  SizeType   row{0};  ///< Stride along the first, contiguous, dimension
+  SizeVector column{};
+};
+
+template <typename T, typename C>
+bool BroadcastStridesOf(Tensor<T, C> const &input, SizeVector const &shape,
+                        BroadcastStrides &strides)
+{
+  if ((input.shape().size() != shape.size()) || shape.empty())
+  {
+    return false;
+  }
+
+  strides.column.assign(shape.size(), 0);
+  for (SizeType i = 0; i < shape.size(); ++i)
+  {
+    SizeType const stride = (input.shape(i) == shape[i]) ? input.stride()[i] : 0;
+    if ((stride == 0) && (input.shape(i) != 1))
+    {
+      return false;
+    }
+
+    strides.column[i] = stride;
+  }
+
+  strides.row = strides.column[0];
+  return true;
+}
+
+/**
+ * @return the storage offset of a column of the output in an input
+ */
+inline SizeType BroadcastColumn(BroadcastStrides const &strides, SizeVector const &shape,
+                                SizeType column)
+{
+  SizeType offset = 0;
+  for (SizeType i = 1; i < shape.size(); ++i)
+  {
+    offset += (column % shape[i]) * strides.column[i];
+    column /= shape[i];
+  }
+
+  return offset;
+}
+
+}  // namespace details
+
 /**
  * Two inputs Broadcast using given function
  * ret will be reshaped to shape of largest input
@@ -153,6 +209,34 @@ bool Broadcast(F function, const Tensor<T, C> &a, const Tensor<T, C> &b, Tensor<
   ShapeFromBroadcast(a.shape(), b.shape(), ret_shape);
   ret.Reshape(ret_shape);
 
+  // inputs of the same rank are walked by their storage, a column at a time
+  details::BroadcastStrides a_strides;
+  details::BroadcastStrides b_strides;
+  if (details::BroadcastStridesOf(a, ret_shape, a_strides) &&
+      details::BroadcastStridesOf(b, ret_shape, b_strides))
+  {
+    T const *      a_data  = a.data().pointer();
+    T const *      b_data  = b.data().pointer();
+    T *            r_data  = ret.data().pointer();
+    SizeType const height  = ret_shape[0];
+    SizeType const columns = (height == 0) ? 0 : ret.size() / height;
+
+    details::ParallelTensorRanges(columns, ret.size(), [&](SizeType from, SizeType to) {
+      for (SizeType c = from; c < to; ++c)
+      {
+        T const *a_column = a_data + details::BroadcastColumn(a_strides, ret_shape, c);
+        T const *b_column = b_data + details::BroadcastColumn(b_strides, ret_shape, c);
+        T *      r_column = r_data + c * ret.padded_height();
+        for (SizeType i = 0; i < height; ++i)
+        {
+          function(a_column[i * a_strides.row], b_column[i * b_strides.row], r_column[i]);
+        }
+      }
+    });
+
+    return true;
+  }
+
   // Prepare ranges
   std::vector<SizeVector> a_range   = PrepareRange(a);
   std::vector<SizeVector> b_range   = PrepareRange(b);
@@ -202,6 +286,29 @@ bool Broadcast(F function, const Tensor<T, C> &a, const Tensor<T, C> &b, Tensor<
 template <typename F, typename T, typename C>
 bool Broadcast(F function, const Tensor<T, C> &a, Tensor<T, C> &ret)
 {
+  details::BroadcastStrides a_strides;
+  if (details::BroadcastStridesOf(a, ret.shape(), a_strides))
+  {
+    T const *      a_data  = a.data().pointer();
+    T *            r_data  = ret.data().pointer();
+    SizeType const height  = ret.shape(0);
+    SizeType const columns = (height == 0) ? 0 : ret.size() / height;
+
+    details::ParallelTensorRanges(columns, ret.size(), [&](SizeType from, SizeType to) {
+      for (SizeType c = from; c < to; ++c)
+      {
+        T const *a_column = a_data + details::BroadcastColumn(a_strides, ret.shape(), c);
+        T *      r_column = r_data + c * ret.padded_height();
+        for (SizeType i = 0; i < height; ++i)
+        {
+          function(a_column[i * a_strides.row], r_column[i]);
+        }
+      }
+    });
+
+    return true;
+  }
+
   // Prepare ranges
   std::vector<SizeVector> a_range   = PrepareRange(a);
   std::vector<SizeVector> ret_range = PrepareRange(ret);
@@ -0,0 +1,50 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace fetch {
+namespace math {
+
+// The maximum number of threads used by tensor reductions and broadcasts
+void        SetTensorConcurrency(std::size_t concurrency);
+std::size_t TensorConcurrency();
+
+namespace details {
+
+/// The number of elements below which the work of a tensor operation is never split across threads
+constexpr SizeType TENSOR_MIN_THREADED_SIZE = SizeType{1} << 18;
+
+/**
+ * Run task(from, to) over contiguous ranges which together cover [0, count), on the tensor thread
+ * pool (and the calling thread). Unless the work is large enough the whole range is run on the
+ * calling thread. Every index is handled by exactly one task.
+ * @param count the number of independent items of work
+ * @param work the total number of elements touched by all of the items
+ * @param task the function run over every range
+ */
+void ParallelTensorRanges(SizeType count, SizeType work,
+                          std::function<void(SizeType, SizeType)> const &task);
+
+}  // namespace details
+}  // namespace math
+}  // namespace fetch
@@ -19,15 +19,67 @@
 
 #include "math/base_types.hpp"
 #include "math/tensor/tensor_declaration.hpp"
+#include "math/tensor/tensor_parallel.hpp"
 #include "math/tensor/tensor_slice_iterator.hpp"
 
 #include <cassert>
+#include <type_traits>
 
 namespace fetch {
 namespace math {
 
+namespace details {
+
+/**
+ * The storage of a tensor is a sequence of padded columns along its first axis. A reduction along
+ * a single axis of an array combines whole columns, unless it is along the first axis itself.
+ */
+struct ReduceLayout
+{
+  SizeType length{0};   ///< Size of the reduced axis
+  SizeType columns{0};  ///< Number of columns of the output
+  SizeType mid{0};      ///< Number of columns between two successive elements of the reduced axis
+};
+
+template <typename T, typename C>
+ReduceLayout ReduceLayoutOf(SizeType axis, Tensor<T, C> const &array)
+{
+  ReduceLayout layout;
+  layout.length  = array.shape().at(axis);
+  layout.mid     = 1;
+  layout.columns = 1;
+  for (SizeType i = 1; i < array.shape().size(); ++i)
+  {
+    if (i < axis)
+    {
+      layout.mid *= array.shape().at(i);
+    }
+    if (i != axis)
+    {
+      layout.columns *= array.shape().at(i);
+    }
+  }
+
+  return layout;
+}
+
 /**
- * Applies given function along given axis resulting in a N-1 sized array
+ * @return the storage offset of the column of the array which holds the element index of the
+ * reduced axis for the given output column
+ */
+inline SizeType ReduceColumn(ReduceLayout const &layout, SizeType column, SizeType index)
+{
+  SizeType const m = column % layout.mid;
+  SizeType const o = column / layout.mid;
+  return m + layout.mid * (index + layout.length * o);
+}
+
+}  // namespace details
+
+/**
+ * Applies given function along given axis resulting in a N-1 sized array. Each output element is
+ * combined with the input elements in the order of the axis, large arrays are split across
+ * threads by output element, so the function must be safe to call concurrently
  * @tparam F Function type
  * @tparam T
  * @tparam C
@@ -48,46 +100,154 @@ void Reduce(SizeType axis, F function, const Tensor<T, C> &array, Tensor<T, C> &
     }
   }
 
-  // If axis is 0, no need to put axis to front
+  details::ReduceLayout const layout = details::ReduceLayoutOf(axis, array);
+
+  T const *      a        = array.data().pointer();
+  T *            r        = ret.data().pointer();
+  SizeType const a_height = array.padded_height();
+  SizeType const r_height = ret.padded_height();
+
+  // the columns of the storage are contiguous, only the reduction along them is not elementwise
   if (axis == 0)
   {
-    auto it_a = array.cbegin();
-    auto it_b = ret.begin();
-
-    while (it_a.is_valid())
-    {
-      // Move return array iterator every array.shape().at(axis) steps
-      for (SizeType j{0}; j < array.shape().at(0); ++j)
+    details::ParallelTensorRanges(layout.columns, array.size(), [&](SizeType from, SizeType to) {
+      for (SizeType c = from; c < to; ++c)
       {
-        // Apply function
-        function(*it_a, *it_b);
-        ++it_a;
+        T const *a_column = a + c * a_height;
+        T &      y        = r[c * r_height];
+        for (SizeType j = 0; j < layout.length; ++j)
+        {
+          function(a_column[j], y);
+        }
       }
-      ++it_b;
-    }
+    });
   }
   else
   {
-    // Create axis-permutable slice iterator
-    auto a_it = array.Slice().cbegin();
-    auto r_it = ret.Slice().begin();
+    SizeType const height = array.shape().at(0);
+    details::ParallelTensorRanges(layout.columns, array.size(), [&](SizeType from, SizeType to) {
+      for (SizeType c = from; c < to; ++c)
+      {
+        T *r_column = r + c * r_height;
+        for (SizeType j = 0; j < layout.length; ++j)
+        {
+          T const *a_column = a + details::ReduceColumn(layout, c, j) * a_height;
+          for (SizeType i = 0; i < height; ++i)
+          {
+            function(a_column[i], r_column[i]);
+          }
+        }
+      }
+    });
+  }
+}
 
-    // Put selected axis to front
-    a_it.PermuteAxes(0, axis);
-    r_it.PermuteAxes(0, axis);
+namespace details {
 
-    while (a_it.is_valid())
-    {
-      // Move return array iterator every array.shape().at(axis) steps
-      for (SizeType j{0}; j < array.shape().at(axis); ++j)
+/**
+ * Registers of a single element are no different to the elements themselves
+ */
+template <typename F, typename T, typename C>
+void VectorisedReduce(SizeType axis, F kernel, T const & /*identity*/, const Tensor<T, C> &array,
+                      Tensor<T, C> &ret, std::false_type /*vectorised*/)
+{
+  Reduce(axis, kernel, array, ret);
+}
+
+template <typename F, typename T, typename C>
+void VectorisedReduce(SizeType axis, F kernel, T const &identity, const Tensor<T, C> &array,
+                      Tensor<T, C> &ret, std::true_type /*vectorised*/)
+{
+  using VectorRegisterType = typename Tensor<T, C>::VectorRegisterType;
+
+  constexpr SizeType BLOCK = VectorRegisterType::E_BLOCK_COUNT;
+  static_assert(Tensor<T, C>::PADDING % BLOCK == 0, "columns must hold whole vector registers");
+
+  ReduceLayout const layout = ReduceLayoutOf(axis, array);
+
+  T const *      a        = array.data().pointer();
+  T *            r        = ret.data().pointer();
+  SizeType const a_height = array.padded_height();
+  SizeType const r_height = ret.padded_height();
+
+  if (axis == 0)
+  {
+    SizeType const vector_length = (layout.length / BLOCK) * BLOCK;
+    ParallelTensorRanges(layout.columns, array.size(), [&](SizeType from, SizeType to) {
+      alignas(VectorRegisterType::E_REGISTER_SIZE) T lanes[BLOCK];
+      for (SizeType c = from; c < to; ++c)
       {
-        // Apply function
-        function(*a_it, *r_it);
-        ++a_it;
+        T const *a_column = a + c * a_height;
+        T &      y        = r[c * r_height];
+
+        VectorRegisterType partial(identity);
+        for (SizeType j = 0; j < vector_length; j += BLOCK)
+        {
+          kernel(VectorRegisterType(a_column + j), partial);
+        }
+
+        partial.Store(lanes);
+        for (SizeType k = 0; k < BLOCK; ++k)
+        {
+          kernel(lanes[k], y);
+        }
+
+        for (SizeType j = vector_length; j < layout.length; ++j)
+        {
+          kernel(a_column[j], y);
+        }
       }
-      ++r_it;
-    }
+    });
   }
+  else
+  {
+    // the padding of the columns is combined as well, it never reaches the logical output
+    ParallelTensorRanges(layout.columns, array.size(), [&](SizeType from, SizeType to) {
+      for (SizeType c = from; c < to; ++c)
+      {
+        T *r_column = r + c * r_height;
+        for (SizeType j = 0; j < layout.length; ++j)
+        {
+          T const *a_column = a + ReduceColumn(layout, c, j) * a_height;
+          for (SizeType i = 0; i < a_height; i += BLOCK)
+          {
+            VectorRegisterType y(r_column + i);
+            kernel(VectorRegisterType(a_column + i), y);
+            y.Store(r_column + i);
+          }
+        }
+      }
+    });
+  }
+}
+
+}  // namespace details
+
+/**
+ * Applies a kernel along given axis resulting in a N-1 sized array, on whole vector registers of
+ * the storage where possible. The kernel is applied to elements as well as to vector registers,
+ * and for a reduction along the first axis it also combines the lanes of the vector partial
+ * results, so it must be associative and commutative
+ * @tparam F Kernel type, taking (x, y) and accumulating x into y
+ * @tparam T
+ * @tparam C
+ * @param axis Axis along which the kernel will be applied
+ * @param kernel Kernel that will be applied along specified axis
+ * @param identity The identity of the kernel, which the output is filled with first
+ * @param array Constant input tensor
+ * @param ret Output tensor
+ */
+template <typename F, typename T, typename C>
+void VectorisedReduce(SizeType axis, F kernel, T const &identity, const Tensor<T, C> &array,
+                      Tensor<T, C> &ret)
+{
+  using VectorRegisterType = typename Tensor<T, C>::VectorRegisterType;
+  using IsVectorised       = std::integral_constant<bool, (VectorRegisterType::E_BLOCK_COUNT > 1)>;
+
+  assert(ret.shape().at(axis) == 1);
+  ret.Fill(identity);
+
+  details::VectorisedReduce(axis, kernel, identity, array, ret, IsVectorised{});
 }
 
 /**
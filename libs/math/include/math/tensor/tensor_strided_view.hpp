@@ -0,0 +1,304 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "math/exceptions/exceptions.hpp"
+#include "math/tensor/tensor_declaration.hpp"
+#include "math/tensor/tensor_view.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace math {
+
+/**
+ * A lazy, read only view of the data of a tensor with arbitrary strides. Transposing and slicing
+ * a strided view only changes its shape, strides and offset, the data is copied when the view is
+ * materialised with Copy(). Views of plain or transposed matrices can be handed to the gemm
+ * kernels directly as TensorViews.
+ *
+ * Strides are in elements of the underlying container, which is shared with the tensor the view
+ * was taken from, so a view must not outlive changes to the shape of that tensor.
+ */
+template <typename T, typename C = memory::SharedArray<T>>
+class TensorStridedView
+{
+public:
+  using Type          = T;
+  using ContainerType = C;
+  using ViewType      = TensorView<T, C>;
+
+  TensorStridedView(ContainerType data, SizeVector shape, SizeVector stride, SizeType offset = 0);
+
+  TensorStridedView Transpose() const;
+  TensorStridedView Transpose(SizeVector const &new_axes) const;
+  TensorStridedView Slice(SizeType index, SizeType axis) const;
+  TensorStridedView Slice(std::pair<SizeType, SizeType> begin_end, SizeType axis) const;
+
+  bool     IsMatrix() const;
+  bool     IsTransposedMatrix() const;
+  ViewType MatrixView() const;
+
+  Type         operator()(SizeVector const &indices) const;
+  Tensor<T, C> Copy() const;
+  std::string  ToString() const;
+
+  SizeVector const &   shape() const;
+  SizeType             shape(SizeType n) const;
+  SizeVector const &   stride() const;
+  SizeType             offset() const;
+  SizeType             size() const;
+  ContainerType const &data() const;
+
+private:
+  ContainerType data_;
+  SizeVector    shape_;
+  SizeVector    stride_;
+  SizeType      offset_{0};
+};
+
+template <typename T, typename C>
+TensorStridedView<T, C>::TensorStridedView(ContainerType data, SizeVector shape, SizeVector stride,
+                                           SizeType offset)
+  : data_{std::move(data)}
+  , shape_{std::move(shape)}
+  , stride_{std::move(stride)}
+  , offset_{offset}
+{
+  assert(shape_.size() == stride_.size());
+}
+
+/**
+ * Swaps the axes of a 2D view
+ * @return The transposed view
+ */
+template <typename T, typename C>
+TensorStridedView<T, C> TensorStridedView<T, C>::Transpose() const
+{
+  if (shape_.size() != 2)
+  {
+    throw exceptions::WrongShape("Can not transpose a view which is not 2-dimensional!");
+  }
+
+  return TensorStridedView(data_, {shape_[1], shape_[0]}, {stride_[1], stride_[0]}, offset_);
+}
+
+/**
+ * Permutes the axes of the view
+ * @param new_axes Axis of this view for every axis of the transposed view
+ * @return The transposed view
+ */
+template <typename T, typename C>
+TensorStridedView<T, C> TensorStridedView<T, C>::Transpose(SizeVector const &new_axes) const
+{
+  if (new_axes.size() != shape_.size())
+  {
+    throw exceptions::WrongShape("Transpose axes do not match the rank of the view");
+  }
+
+  SizeVector shape;
+  SizeVector stride;
+  shape.reserve(new_axes.size());
+  stride.reserve(new_axes.size());
+
+  for (auto const axis : new_axes)
+  {
+    shape.emplace_back(shape_.at(axis));
+    stride.emplace_back(stride_.at(axis));
+  }
+
+  return TensorStridedView(data_, std::move(shape), std::move(stride), offset_);
+}
+
+/**
+ * Selects a single index of an axis, the axis is removed from the view
+ */
+template <typename T, typename C>
+TensorStridedView<T, C> TensorStridedView<T, C>::Slice(SizeType index, SizeType axis) const
+{
+  assert(index < shape_.at(axis));
+
+  auto shape  = shape_;
+  auto stride = stride_;
+  shape.erase(shape.begin() + static_cast<std::ptrdiff_t>(axis));
+  stride.erase(stride.begin() + static_cast<std::ptrdiff_t>(axis));
+
+  return TensorStridedView(data_, std::move(shape), std::move(stride),
+                           offset_ + index * stride_[axis]);
+}
+
+/**
+ * Selects the indices [begin, end) of an axis
+ */
+template <typename T, typename C>
+TensorStridedView<T, C> TensorStridedView<T, C>::Slice(std::pair<SizeType, SizeType> begin_end,
+                                                       SizeType                      axis) const
+{
+  assert((begin_end.first <= begin_end.second) && (begin_end.second <= shape_.at(axis)));
+
+  auto shape  = shape_;
+  shape[axis] = begin_end.second - begin_end.first;
+
+  return TensorStridedView(data_, std::move(shape), stride_,
+                           offset_ + begin_end.first * stride_[axis]);
+}
+
+/**
+ * @return true if the view has the layout of a 2D tensor, so that MatrixView() can be used
+ */
+template <typename T, typename C>
+bool TensorStridedView<T, C>::IsMatrix() const
+{
+  return (shape_.size() == 2) && (stride_[0] == 1) &&
+         (stride_[1] == ViewType::PadValue(shape_[0])) && (offset_ % ViewType::PADDING == 0);
+}
+
+/**
+ * @return true if the view is the transpose of a view with the layout of a 2D tensor
+ */
+template <typename T, typename C>
+bool TensorStridedView<T, C>::IsTransposedMatrix() const
+{
+  return (shape_.size() == 2) && (stride_[1] == 1) &&
+         (stride_[0] == ViewType::PadValue(shape_[1])) && (offset_ % ViewType::PADDING == 0);
+}
+
+/**
+ * @return A TensorView over the data of a view for which IsMatrix() holds, without a copy
+ */
+template <typename T, typename C>
+typename TensorStridedView<T, C>::ViewType TensorStridedView<T, C>::MatrixView() const
+{
+  assert(IsMatrix());
+  return ViewType(data_, shape_[0], shape_[1], offset_);
+}
+
+template <typename T, typename C>
+T TensorStridedView<T, C>::operator()(SizeVector const &indices) const
+{
+  assert(indices.size() == shape_.size());
+
+  SizeType index = offset_;
+  for (SizeType i = 0; i < indices.size(); ++i)
+  {
+    assert(indices[i] < shape_[i]);
+    index += indices[i] * stride_[i];
+  }
+
+  return data_[index];
+}
+
+/**
+ * Materialises the view into a new contiguous tensor. The columns of the new tensor are filled
+ * one after the other, while the position of every column in the view is updated incrementally.
+ * @return The new tensor
+ */
+template <typename T, typename C>
+Tensor<T, C> TensorStridedView<T, C>::Copy() const
+{
+  Tensor<T, C> ret(shape_);
+  if (shape_.empty() || (size() == 0))
+  {
+    return ret;
+  }
+
+  SizeType const height      = shape_[0];
+  SizeType const row_stride  = stride_[0];
+  SizeType const num_columns = size() / height;
+  Type const *   source      = data_.pointer() + offset_;
+  Type *         destination = ret.data().pointer();
+  SizeVector     column_index(shape_.size(), 0);
+  SizeType       column_start = 0;
+
+  for (SizeType column = 0; column < num_columns; ++column)
+  {
+    Type *out = destination + column * ret.padded_height();
+    for (SizeType i = 0; i < height; ++i)
+    {
+      out[i] = source[column_start + i * row_stride];
+    }
+
+    // advance to the next column, carrying over exhausted axes
+    for (SizeType axis = 1; axis < shape_.size(); ++axis)
+    {
+      column_start += stride_[axis];
+      if (++column_index[axis] < shape_[axis])
+      {
+        break;
+      }
+      column_start -= shape_[axis] * stride_[axis];
+      column_index[axis] = 0;
+    }
+  }
+
+  return ret;
+}
+
+template <typename T, typename C>
+std::string TensorStridedView<T, C>::ToString() const
+{
+  return Copy().ToString();
+}
+
+template <typename T, typename C>
+SizeVector const &TensorStridedView<T, C>::shape() const
+{
+  return shape_;
+}
+
+template <typename T, typename C>
+SizeType TensorStridedView<T, C>::shape(SizeType n) const
+{
+  return shape_.at(n);
+}
+
+template <typename T, typename C>
+SizeVector const &TensorStridedView<T, C>::stride() const
+{
+  return stride_;
+}
+
+template <typename T, typename C>
+SizeType TensorStridedView<T, C>::offset() const
+{
+  return offset_;
+}
+
+template <typename T, typename C>
+SizeType TensorStridedView<T, C>::size() const
+{
+  SizeType ret = shape_.empty() ? 0 : 1;
+  for (auto const dim : shape_)
+  {
+    ret *= dim;
+  }
+  return ret;
+}
+
+template <typename T, typename C>
+typename TensorStridedView<T, C>::ContainerType const &TensorStridedView<T, C>::data() const
+{
+  return data_;
+}
+
+}  // namespace math
+}  // namespace fetch
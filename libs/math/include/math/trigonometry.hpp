@@ -19,6 +19,8 @@
 
 #include "math/kernels/trigonometry.hpp"
 #include "math/meta/math_type_traits.hpp"
+#include "math/standard_functions/exp.hpp"
+#include "vectorise/math/exact_exp.hpp"
 
 #include <cassert>
 
@@ -245,7 +247,8 @@ fetch::math::meta::IfIsMathArray<ArrayType, ArrayType> CosH(ArrayType const &x)
  * @param x - array
  */
 template <typename ArrayType>
-fetch::math::meta::IfIsMathArray<ArrayType, void> TanH(ArrayType const &x, ArrayType &ret)
+fetch::math::meta::IfIsMathNonFixedPointArray<ArrayType, void> TanH(ArrayType const &x,
+                                                                    ArrayType &      ret)
 {
   assert(ret.size() == x.size());
   kernels::TanH s;
@@ -259,6 +262,19 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> TanH(ArrayType const &x, Array
   }
 }
 
+/**
+ * Fixed point tensors are processed a register at a time, the result is bit-identical to
+ * kernels::TanH on every platform
+ */
+template <typename ArrayType>
+fetch::math::meta::IfIsMathFixedPointArray<ArrayType, void> TanH(ArrayType const &x,
+                                                                 ArrayType &      ret)
+{
+  assert(ret.shape() == x.shape());
+
+  details::ApplyExactKernel(x, ret, [](auto const &v, auto &y) { y = vectorise::exact_tanh(v); });
+}
+
 template <typename ArrayType>
 fetch::math::meta::IfIsMathArray<ArrayType, ArrayType> TanH(ArrayType const &x)
 {
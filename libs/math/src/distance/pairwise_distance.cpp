@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/distance/pairwise_distance.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace math {
+namespace distance {
+namespace {
+
+std::atomic<std::size_t> pairwise_concurrency{std::max(1u, std::thread::hardware_concurrency())};
+
+threading::Pool &PairWisePool()
+{
+  static threading::Pool pool{std::max(1u, std::thread::hardware_concurrency()), "PairWise"};
+  return pool;
+}
+
+}  // namespace
+
+void SetPairWiseConcurrency(std::size_t concurrency)
+{
+  pairwise_concurrency = std::max<std::size_t>(concurrency, 1);
+}
+
+std::size_t PairWiseConcurrency()
+{
+  return pairwise_concurrency;
+}
+
+namespace details {
+
+void ParallelPairWiseTasks(std::size_t num_tasks, std::size_t num_threads,
+                           std::function<void(std::size_t)> const &task)
+{
+  num_threads = std::max<std::size_t>(std::min(num_threads, num_tasks), 1);
+
+  auto const run = [&](std::size_t thread) {
+    for (std::size_t index = thread; index < num_tasks; index += num_threads)
+    {
+      task(index);
+    }
+  };
+
+  if (num_threads == 1)
+  {
+    run(0);
+    return;
+  }
+
+  std::vector<std::future<void>> tasks{};
+  tasks.reserve(num_threads - 1);
+
+  for (std::size_t thread = 1; thread < num_threads; ++thread)
+  {
+    tasks.emplace_back(PairWisePool().Dispatch(run, thread));
+  }
+
+  run(0);
+
+  for (auto &pending : tasks)
+  {
+    pending.get();
+  }
+}
+
+}  // namespace details
+}  // namespace distance
+}  // namespace math
+}  // namespace fetch
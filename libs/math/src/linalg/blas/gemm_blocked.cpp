@@ -0,0 +1,389 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/gemm_blocked.hpp"
+
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_nn_vector.hpp"
+#include "math/linalg/blas/gemm_nt_vector.hpp"
+#include "math/linalg/blas/gemm_tn_vector.hpp"
+#include "math/linalg/prototype.hpp"
+#include "math/tensor/tensor_view.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace math {
+namespace linalg {
+namespace {
+
+std::atomic<std::size_t> gemm_concurrency{std::max(1u, std::thread::hardware_concurrency())};
+
+threading::Pool &GemmPool()
+{
+  static threading::Pool pool{std::max(1u, std::thread::hardware_concurrency()), "GEMM"};
+  return pool;
+}
+
+/**
+ * A read only view of a column major matrix which may be accessed as its transpose
+ */
+template <typename Type>
+struct Operand
+{
+  Operand(TensorView<Type> const &view, bool transpose)
+    : data{view.data().pointer()}
+    , stride{view.padded_height()}
+    , transposed{transpose}
+  {}
+
+  Type operator()(std::size_t i, std::size_t j) const
+  {
+    return transposed ? data[(i * stride) + j] : data[(j * stride) + i];
+  }
+
+  Type const *data;
+  std::size_t stride;
+  bool        transposed;
+};
+
+/**
+ * Pack a block of op(A) into slivers of MR rows, each of which is stored depth first. The final
+ * sliver is padded with zeros.
+ */
+template <typename Type, std::size_t MR>
+void PackA(Operand<Type> const &a, std::size_t row, std::size_t depth, std::size_t mc,
+           std::size_t kc, Type *packed)
+{
+  for (std::size_t ir = 0; ir < mc; ir += MR)
+  {
+    std::size_t const mr = std::min(MR, mc - ir);
+
+    for (std::size_t p = 0; p < kc; ++p)
+    {
+      for (std::size_t ii = 0; ii < MR; ++ii)
+      {
+        *packed++ = (ii < mr) ? a(row + ir + ii, depth + p) : Type{0};
+      }
+    }
+  }
+}
+
+/**
+ * Pack a panel of op(B) into slivers of NR columns, each of which is stored depth first. The final
+ * sliver is padded with zeros.
+ */
+template <typename Type, std::size_t NR>
+void PackB(Operand<Type> const &b, std::size_t depth, std::size_t column, std::size_t kc,
+           std::size_t nc, Type *packed)
+{
+  for (std::size_t jr = 0; jr < nc; jr += NR)
+  {
+    std::size_t const nr = std::min(NR, nc - jr);
+
+    for (std::size_t p = 0; p < kc; ++p)
+    {
+      for (std::size_t jj = 0; jj < NR; ++jj)
+      {
+        *packed++ = (jj < nr) ? b(depth + p, column + jr + jj) : Type{0};
+      }
+    }
+  }
+}
+
+/**
+ * Accumulate a MR x NR tile of the product of a packed sliver of A and a packed sliver of B, and
+ * update the corresponding (valid) elements of C
+ */
+template <typename Type, std::size_t MR, std::size_t NR>
+void MicroKernel(std::size_t kc, Type const *a, Type const *b, Type alpha, Type beta,
+                 bool first, std::size_t mr, std::size_t nr, Type *c, std::size_t ldc)
+{
+  Type tile[MR * NR] = {};
+
+  for (std::size_t p = 0; p < kc; ++p)
+  {
+    Type const *a_p = a + (p * MR);
+    Type const *b_p = b + (p * NR);
+
+    for (std::size_t jj = 0; jj < NR; ++jj)
+    {
+      Type const b_pj = b_p[jj];
+
+      for (std::size_t ii = 0; ii < MR; ++ii)
+      {
+        tile[(jj * MR) + ii] += a_p[ii] * b_pj;
+      }
+    }
+  }
+
+  for (std::size_t jj = 0; jj < nr; ++jj)
+  {
+    Type *c_j = c + (jj * ldc);
+
+    for (std::size_t ii = 0; ii < mr; ++ii)
+    {
+      Type const value = alpha * tile[(jj * MR) + ii];
+
+      if (!first)
+      {
+        c_j[ii] += value;
+      }
+      else if (beta == Type{0})
+      {
+        c_j[ii] = value;
+      }
+      else
+      {
+        c_j[ii] = (beta * c_j[ii]) + value;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void SetGemmConcurrency(std::size_t concurrency)
+{
+  gemm_concurrency = std::max<std::size_t>(concurrency, 1);
+}
+
+std::size_t GemmConcurrency()
+{
+  return gemm_concurrency;
+}
+
+template <typename S>
+constexpr std::size_t GemmBlocked<S>::MR;
+template <typename S>
+constexpr std::size_t GemmBlocked<S>::NR;
+template <typename S>
+constexpr std::size_t GemmBlocked<S>::MC;
+template <typename S>
+constexpr std::size_t GemmBlocked<S>::KC;
+template <typename S>
+constexpr std::size_t GemmBlocked<S>::NC;
+template <typename S>
+constexpr std::size_t GemmBlocked<S>::MIN_BLOCKED_SIZE;
+template <typename S>
+constexpr std::size_t GemmBlocked<S>::MIN_THREADED_SIZE;
+
+/**
+ * Determine if a product is large enough to be computed by the blocked kernel
+ *
+ * @param m The height of C
+ * @param n The width of C
+ * @param k The inner dimension of the product
+ * @return true if the blocked kernel should be used, otherwise false
+ */
+template <typename S>
+bool GemmBlocked<S>::IsBlocked(std::size_t m, std::size_t n, std::size_t k)
+{
+  return (m * n * k) >= MIN_BLOCKED_SIZE;
+}
+
+/**
+ * Compute C = alpha * op(A) * op(B) + beta * C
+ *
+ * @param alpha The scale of the product
+ * @param a The matrix A
+ * @param transpose_a Whether op(A) is the transpose of A
+ * @param b The matrix B
+ * @param transpose_b Whether op(B) is the transpose of B
+ * @param beta The scale of the original C
+ * @param c The output matrix C
+ */
+template <typename S>
+void GemmBlocked<S>::Multiply(Type alpha, TensorView<Type> a, bool transpose_a,
+                              TensorView<Type> b, bool transpose_b, Type beta,
+                              TensorView<Type> c)
+{
+  std::size_t const m = c.height();
+  std::size_t const n = c.width();
+  std::size_t const k = transpose_a ? a.height() : a.width();
+
+  if ((m == 0) || (n == 0) || (k == 0))
+  {
+    return;
+  }
+
+  Operand<Type> const op_a{a, transpose_a};
+  Operand<Type> const op_b{b, transpose_b};
+  Type *const         data_c = c.data().pointer();
+  std::size_t const   ldc    = c.padded_height();
+
+  // the independent blocks of rows of C are shared between the threads
+  std::size_t const num_blocks  = (m + MC - 1) / MC;
+  std::size_t const num_threads = ((m * n * k) < MIN_THREADED_SIZE)
+                                      ? 1
+                                      : std::min(num_blocks, GemmConcurrency());
+
+  std::vector<Type> packed_b(KC * (((std::min(n, NC) + NR - 1) / NR) * NR));
+
+  for (std::size_t jc = 0; jc < n; jc += NC)
+  {
+    std::size_t const nc = std::min(NC, n - jc);
+
+    for (std::size_t pc = 0; pc < k; pc += KC)
+    {
+      std::size_t const kc    = std::min(KC, k - pc);
+      bool const        first = (pc == 0);
+
+      PackB<Type, NR>(op_b, pc, jc, kc, nc, packed_b.data());
+
+      auto const compute = [&](std::size_t thread) {
+        std::vector<Type> packed_a(MC * KC);
+
+        for (std::size_t block = thread; block < num_blocks; block += num_threads)
+        {
+          std::size_t const ic = block * MC;
+          std::size_t const mc = std::min(MC, m - ic);
+
+          PackA<Type, MR>(op_a, ic, pc, mc, kc, packed_a.data());
+
+          for (std::size_t jr = 0; jr < nc; jr += NR)
+          {
+            for (std::size_t ir = 0; ir < mc; ir += MR)
+            {
+              MicroKernel<Type, MR, NR>(kc, packed_a.data() + (ir * kc),
+                                        packed_b.data() + (jr * kc), alpha, beta, first,
+                                        std::min(MR, mc - ir), std::min(NR, nc - jr),
+                                        data_c + ((jc + jr) * ldc) + ic + ir, ldc);
+            }
+          }
+        }
+      };
+
+      if (num_threads > 1)
+      {
+        std::vector<std::future<void>> tasks{};
+        tasks.reserve(num_threads - 1);
+
+        for (std::size_t thread = 1; thread < num_threads; ++thread)
+        {
+          tasks.emplace_back(GemmPool().Dispatch(compute, thread));
+        }
+
+        compute(0);
+
+        for (auto &task : tasks)
+        {
+          task.get();
+        }
+      }
+      else
+      {
+        compute(0);
+      }
+    }
+  }
+}
+
+template <typename S>
+void Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
+          Computes(_C <= _alpha * _A * _B + _beta * _C),
+          platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>::
+     operator()(Type const alpha, TensorView<Type> const a, TensorView<Type> const b, Type const beta,
+           TensorView<Type> c) const
+{
+  if ((alpha == Type{0}) || !GemmBlocked<Type>::IsBlocked(c.height(), c.width(), a.width()))
+  {
+    Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+         Computes(_C <= _alpha * _A * _B + _beta * _C), platform::Parallelisation::VECTORISE>
+        gemm_nn;
+
+    gemm_nn(alpha, a, b, beta, c);
+    return;
+  }
+
+  GemmBlocked<Type>::Multiply(alpha, a, false, b, false, beta, c);
+}
+
+template <typename S>
+void Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
+          Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+          platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>::
+     operator()(Type const alpha, TensorView<Type> const a, TensorView<Type> const b, Type const beta,
+           TensorView<Type> c) const
+{
+  if ((alpha == Type{0}) || !GemmBlocked<Type>::IsBlocked(c.height(), c.width(), a.width()))
+  {
+    Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+         Computes(_C <= _alpha * _A * T(_B) + _beta * _C), platform::Parallelisation::VECTORISE>
+        gemm_nt;
+
+    gemm_nt(alpha, a, b, beta, c);
+    return;
+  }
+
+  GemmBlocked<Type>::Multiply(alpha, a, false, b, true, beta, c);
+}
+
+template <typename S>
+void Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
+          Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+          platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>::
+     operator()(Type const alpha, TensorView<Type> const a, TensorView<Type> const b, Type const beta,
+           TensorView<Type> c) const
+{
+  if ((alpha == Type{0}) || !GemmBlocked<Type>::IsBlocked(c.height(), c.width(), a.height()))
+  {
+    Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+         Computes(_C <= _alpha * T(_A) * _B + _beta * _C), platform::Parallelisation::VECTORISE>
+        gemm_tn;
+
+    gemm_tn(alpha, a, b, beta, c);
+    return;
+  }
+
+  GemmBlocked<Type>::Multiply(alpha, a, true, b, false, beta, c);
+}
+
+template class GemmBlocked<double>;
+template class GemmBlocked<float>;
+
+template class Blas<double, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+template class Blas<float, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+
+template class Blas<double, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+template class Blas<float, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+
+template class Blas<double, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+template class Blas<float, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                    Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+                    platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>;
+
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
@@ -66,6 +66,27 @@ Tensor<T, C>::Tensor(SizeVector const &dims)
   Resize(dims);
 }
 
+/**
+ * Constructor builds a Tensor over existing storage, for example a memory mapped file, without
+ * copying it. The storage is laid out as that of a tensor of the same shape, padding included.
+ * @param dims   vector of lengths for each dimension
+ * @param data   container of (at least) PaddedSizeFromShape(dims) elements
+ */
+template <typename T, typename C>
+Tensor<T, C>::Tensor(SizeVector const &dims, ContainerType data)
+  : data_(std::move(data))
+  , size_(Tensor::SizeFromShape(dims))
+  , shape_(dims)
+  , padded_height_(dims.empty() ? SizeType{0} : PadValue(dims[0]))
+{
+  if (data_.size() < Tensor::PaddedSizeFromShape(dims))
+  {
+    throw exceptions::WrongShape("Tensor storage is too small for the shape");
+  }
+
+  UpdateStrides();
+}
+
 /////////////////
 /// ITERATORS ///
 /////////////////
@@ -222,6 +243,19 @@ typename Tensor<T, C>::ViewType const Tensor<T, C>::View(std::vector<SizeType> i
   return TensorView<Type, ContainerType>(data_, height(), width, offset);
 }
 
+/**
+ * Returns a lazy strided view of the whole tensor, which can be transposed and sliced without
+ * copying any data
+ * @tparam T Type
+ * @tparam C Container
+ * @return The strided view
+ */
+template <typename T, typename C>
+TensorStridedView<T, C> Tensor<T, C>::StridedView() const
+{
+  return TensorStridedView<T, C>(data_, shape_, stride_);
+}
+
 //////////////////////////////
 /// ASSIGNMENT & ACCESSING ///
 //////////////////////////////
@@ -400,14 +434,10 @@ bool Tensor<T, C>::Resize(SizeVector const &shape, bool copy)
     return true;
   }
 
-  // a shallow copy for speedy initializion of a tensor
+  // a shallow copy is enough to preserve the old values, since the tensor is given new data below
   Tensor   old_tensor        = *this;
   SizeType old_size          = this->size();
   SizeType new_size_unpadded = Tensor::SizeFromShape(shape);
-  if (copy && (old_size == new_size_unpadded))
-  {
-    old_tensor = this->Copy();
-  }
 
   SizeType new_size = Tensor::PaddedSizeFromShape(shape);
   data_             = ContainerType(new_size);
@@ -976,16 +1006,12 @@ void Tensor<T, C>::Flatten()
 template <typename T, typename C>
 Tensor<T, C> Tensor<T, C>::Transpose() const
 {
-  // TODO (private 867) -
   if (shape_.size() != 2)
   {
     throw exceptions::WrongShape("Can not transpose a tensor which is not 2-dimensional!");
   }
-  SizeVector new_axes{1, 0};
 
-  Tensor ret({shape().at(1), shape().at(0)});
-  TransposeImplementation(new_axes, ret);
-  return ret;
+  return StridedView().Transpose().Copy();
 }
 
 /**
@@ -1001,18 +1027,7 @@ Tensor<T, C> Tensor<T, C>::Transpose(SizeVector &new_axes) const
   assert(shape_.size() > 1);
   assert(shape_.size() == new_axes.size());
 
-  SizeVector new_shape;
-  new_shape.reserve(new_shape.size());
-
-  for (auto &val : new_axes)
-  {
-    new_shape.emplace_back(shape_.at(val));
-  }
-
-  Tensor ret(new_shape);
-
-  TransposeImplementation(new_axes, ret);
-  return ret;
+  return StridedView().Transpose(new_axes).Copy();
 }
 
 /**
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor_parallel.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace math {
+namespace {
+
+std::atomic<std::size_t> tensor_concurrency{std::max(1u, std::thread::hardware_concurrency())};
+
+threading::Pool &TensorPool()
+{
+  static threading::Pool pool{std::max(1u, std::thread::hardware_concurrency()), "Tensor"};
+  return pool;
+}
+
+}  // namespace
+
+void SetTensorConcurrency(std::size_t concurrency)
+{
+  tensor_concurrency = std::max<std::size_t>(concurrency, 1);
+}
+
+std::size_t TensorConcurrency()
+{
+  return tensor_concurrency;
+}
+
+namespace details {
+
+void ParallelTensorRanges(SizeType count, SizeType work,
+                          std::function<void(SizeType, SizeType)> const &task)
+{
+  SizeType num_threads = 1;
+  if (work >= TENSOR_MIN_THREADED_SIZE)
+  {
+    num_threads = std::min<SizeType>(TensorConcurrency(), work / TENSOR_MIN_THREADED_SIZE + 1);
+    num_threads = std::max<SizeType>(std::min(num_threads, count), 1);
+  }
+
+  if (num_threads == 1)
+  {
+    task(0, count);
+    return;
+  }
+
+  SizeType const step = (count + num_threads - 1) / num_threads;
+  auto const     run  = [&task, count, step](SizeType thread) {
+    SizeType const from = std::min(thread * step, count);
+    task(from, std::min(from + step, count));
+  };
+
+  std::vector<std::future<void>> tasks{};
+  tasks.reserve(num_threads - 1);
+
+  for (SizeType thread = 1; thread < num_threads; ++thread)
+  {
+    tasks.emplace_back(TensorPool().Dispatch(run, thread));
+  }
+
+  run(0);
+
+  for (auto &pending : tasks)
+  {
+    pending.get();
+  }
+}
+
+}  // namespace details
+}  // namespace math
+}  // namespace fetch
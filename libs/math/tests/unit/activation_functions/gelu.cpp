@@ -47,6 +47,38 @@ TYPED_TEST(GeluTest, exact_value_test)
       fetch::math::Type<DataType>("2.8") * fetch::math::function_tolerance<DataType>()));
 }
 
+// The batched implementation must agree exactly with the elementwise operations
+TYPED_TEST(GeluTest, matches_elementwise_implementation)
+{
+  using DataType = typename TypeParam::Type;
+
+  TypeParam input{{7, 5}};
+  input.FillUniformRandom();
+  input *= DataType{40};
+  input -= DataType{20};
+  input.At(0, 0) = DataType{0};
+
+  TypeParam const output = fetch::math::Gelu(input);
+
+  DataType const one{1};
+  DataType const half   = Type<DataType>("0.5");
+  DataType const coeff1 = Type<DataType>("0.797885");
+  DataType const coeff2 = Type<DataType>("0.035677");
+
+  auto it  = input.cbegin();
+  auto rit = output.cbegin();
+  while (it.is_valid())
+  {
+    DataType const x     = *it;
+    DataType const inner = (x * coeff1) + (fetch::math::Pow(x, DataType{3}) * coeff2);
+    DataType const expected =
+        static_cast<DataType>((x * (fetch::math::TanH(inner) + one)) * half);
+    EXPECT_EQ(*rit, expected);
+    ++it;
+    ++rit;
+  }
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
@@ -190,6 +190,32 @@ TYPED_TEST(SigmoidTest, sigmoid_11)
   ASSERT_TRUE(output.AllClose(numpy_output, fetch::math::function_tolerance<DataType>()));
 }
 
+// The batched implementation must agree exactly with the elementwise kernel
+TYPED_TEST(SigmoidTest, matches_elementwise_kernel)
+{
+  using DataType = typename TypeParam::Type;
+
+  TypeParam input{{7, 5}};
+  input.FillUniformRandom();
+  input *= DataType{40};
+  input -= DataType{20};
+  input.At(0, 0) = DataType{0};
+
+  TypeParam const output = fetch::math::Sigmoid(input);
+
+  kernels::Sigmoid sigmoid;
+  auto             it  = input.cbegin();
+  auto             rit = output.cbegin();
+  while (it.is_valid())
+  {
+    DataType expected{};
+    sigmoid(*it, expected);
+    EXPECT_EQ(*rit, expected);
+    ++it;
+    ++rit;
+  }
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
@@ -203,6 +203,21 @@ TEST(big_number_gtest, uint256_multiplication_overflow_test)
   EXPECT_EQ(n.ElementAt(3), ~UInt<256>::WideType{0});
 }
 
+TEST(big_number_gtest, uint256_multiplication_carry_regression_test)
+{
+  // (2^128 - 1)^2 = 2^256 - 2^129 + 1. The sum of the cross products of the lower limbs overflows
+  // 128 bits, and the unrolled implementation used to lose its carry of 2^192.
+  UInt<256> n1;
+  n1.ElementAt(0) = 0xffffffffffffffff;
+  n1.ElementAt(1) = 0xffffffffffffffff;
+
+  UInt<256> n2 = n1 * n1;
+  EXPECT_EQ(n2.ElementAt(0), 0x0000000000000001);
+  EXPECT_EQ(n2.ElementAt(1), 0x0000000000000000);
+  EXPECT_EQ(n2.ElementAt(2), 0xfffffffffffffffe);
+  EXPECT_EQ(n2.ElementAt(3), 0xffffffffffffffff);
+}
+
 TEST(big_number_gtest, division_tests)
 {
   UInt<256> n1;
@@ -243,6 +258,153 @@ TEST(big_number_gtest, division_tests)
   EXPECT_EQ(n5.ElementAt(3), 0);
 }
 
+TEST(big_number_gtest, division_add_back_test)
+{
+  // the first quotient limb estimate is one too large, which is only caught after the subtraction
+  UInt<256> n1;
+  n1.ElementAt(2) = 0x8000000000000000;
+  n1.ElementAt(3) = 0x7fffffffffffffff;
+  UInt<256> n2;
+  n2.ElementAt(0) = 0x1;
+  n2.ElementAt(2) = 0x8000000000000000;
+
+  UInt<256> remainder;
+  UInt<256> quotient = n1.DivMod(n2, remainder);
+  EXPECT_EQ(quotient.ElementAt(0), 0xfffffffffffffffe);
+  EXPECT_EQ(quotient.ElementAt(1), 0);
+  EXPECT_EQ(quotient.ElementAt(2), 0);
+  EXPECT_EQ(quotient.ElementAt(3), 0);
+  EXPECT_EQ(remainder.ElementAt(0), 0x2);
+  EXPECT_EQ(remainder.ElementAt(1), 0xffffffffffffffff);
+  EXPECT_EQ(remainder.ElementAt(2), 0x7fffffffffffffff);
+  EXPECT_EQ(remainder.ElementAt(3), 0);
+}
+
+TEST(big_number_gtest, division_regression_test)
+{
+  // 2^192 / (2^128 - 1) = 2^64 remainder 2^64. The shift and subtract implementation used to give
+  // a quotient of 2^65 - 1.
+  UInt<256> n1;
+  n1.ElementAt(3) = 0x1;
+  UInt<256> n2;
+  n2.ElementAt(0) = 0xffffffffffffffff;
+  n2.ElementAt(1) = 0xffffffffffffffff;
+
+  UInt<256> quotient = n1 / n2;
+  EXPECT_EQ(quotient.ElementAt(0), 0);
+  EXPECT_EQ(quotient.ElementAt(1), 0x1);
+  EXPECT_EQ(quotient.ElementAt(2), 0);
+  EXPECT_EQ(quotient.ElementAt(3), 0);
+
+  UInt<256> remainder = n1 % n2;
+  EXPECT_EQ(remainder.ElementAt(0), 0);
+  EXPECT_EQ(remainder.ElementAt(1), 0x1);
+  EXPECT_EQ(remainder.ElementAt(2), 0);
+  EXPECT_EQ(remainder.ElementAt(3), 0);
+}
+
+TEST(big_number_gtest, division_matches_multiplication)
+{
+  uint64_t state = 0x9e3779b97f4a7c15;
+  auto     next  = [&state]() {
+    state ^= state << 13u;
+    state ^= state >> 7u;
+    state ^= state << 17u;
+    return state;
+  };
+
+  for (std::size_t limbs = 1; limbs <= UInt<256>::WIDE_ELEMENTS; ++limbs)
+  {
+    for (std::size_t iteration = 0; iteration < 100; ++iteration)
+    {
+      UInt<256> dividend;
+      UInt<256> divisor;
+      for (std::size_t i = 0; i < UInt<256>::WIDE_ELEMENTS; ++i)
+      {
+        dividend.ElementAt(i) = next();
+        divisor.ElementAt(i)  = (i < limbs) ? next() : 0;
+      }
+      // alternate between normalised divisors and ones with leading zero bits
+      divisor.ElementAt(limbs - 1) >>= (iteration % 2 == 0) ? 0u : iteration % 64;
+      divisor.ElementAt(limbs - 1) |= 1u;
+
+      UInt<256> remainder;
+      UInt<256> quotient = dividend.DivMod(divisor, remainder);
+
+      EXPECT_LT(remainder, divisor);
+      EXPECT_EQ(quotient * divisor + remainder, dividend);
+      EXPECT_EQ(dividend / divisor, quotient);
+      EXPECT_EQ(dividend % divisor, remainder);
+    }
+  }
+}
+
+TEST(big_number_gtest, uint512_multiplication_and_division_tests)
+{
+  UInt<512> n1;
+  UInt<512> n2;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    n1.ElementAt(i) = 0xdeadbeefdeadbeef + i;
+    n2.ElementAt(i) = 0x0123456789abcdef * (i + 1);
+  }
+
+  UInt<512> product = n1 * n2;
+  EXPECT_EQ(product / n2, n1);
+  EXPECT_EQ(product / n1, n2);
+  EXPECT_EQ(product % n1, UInt<512>::_0);
+
+  // the lower half of the product does not depend on the size of the numbers
+  UInt<256> m1;
+  UInt<256> m2;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    m1.ElementAt(i) = n1.ElementAt(i);
+    m2.ElementAt(i) = n2.ElementAt(i);
+  }
+  UInt<256> truncated = m1 * m2;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    EXPECT_EQ(truncated.ElementAt(i), product.ElementAt(i));
+  }
+}
+
+TEST(big_number_gtest, modular_arithmetic_tests)
+{
+  EXPECT_EQ(UInt<256>{7u}.MulMod(UInt<256>{13u}, UInt<256>{10u}), UInt<256>{1u});
+  EXPECT_EQ(UInt<256>{7u}.PowMod(UInt<256>{13u}, UInt<256>{1000u}), UInt<256>{407u});
+  EXPECT_EQ(UInt<256>{7u}.PowMod(UInt<256>::_0, UInt<256>{1000u}), UInt<256>::_1);
+
+  // 2^255 - 19 is prime
+  UInt<256> p{1u};
+  p <<= 255;
+  p -= 19u;
+
+  // the product of these overflows 256 bits
+  EXPECT_EQ((p - 1u).MulMod(p - 1u, p), UInt<256>::_1);
+  EXPECT_EQ(UInt<256>{3u}.PowMod(p - 1u, p), UInt<256>::_1);
+
+  UInt<256> a{0xdeadbeefdeadbeef};
+  a <<= 100;
+  UInt<256> inverse = a.PowMod(p - 2u, p);
+  EXPECT_EQ(a.MulMod(inverse, p), UInt<256>::_1);
+
+  EXPECT_THROW(a.MulMod(a, UInt<256>::_0), std::runtime_error);
+}
+
+TEST(big_number_gtest, constexpr_arithmetic_tests)
+{
+  using WideType = UInt<256>::WideType;
+
+  constexpr UInt<256> product  = UInt<256>{WideType{6}} * UInt<256>{WideType{7}};
+  constexpr UInt<256> quotient = product / UInt<256>{WideType{5}};
+  constexpr UInt<256> modulo   = product % UInt<256>{WideType{5}};
+
+  static_assert(product.ElementAt(0) == 42, "product evaluated at compile time");
+  static_assert(quotient.ElementAt(0) == 8, "quotient evaluated at compile time");
+  static_assert(modulo.ElementAt(0) == 2, "remainder evaluated at compile time");
+}
+
 TEST(big_number_gtest, msb_lsb_tests)
 {
   UInt<256> n1;
@@ -441,7 +603,7 @@ TEST(big_number_gtest, test_issue_1383_overflow_division_2)
   EXPECT_EQ(UInt72{2ull}, x4 / x2);
   EXPECT_EQ(UInt72{6ull}, x4 + x2);
   EXPECT_EQ(UInt72{2ull}, x4 - x2);
-  // EXPECT_EQ(UInt72{0ull}, x4 % x2);
+  EXPECT_EQ(UInt72{0ull}, x4 % x2);
 }
 
 TEST(big_number_gtest, test_issue_1383_max)
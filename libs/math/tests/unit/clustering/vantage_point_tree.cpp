@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/clustering/vantage_point_tree.hpp"
+#include "math/distance/pairwise_distance.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace math {
+namespace test {
+
+template <typename T>
+class VantagePointTreeTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(VantagePointTreeTest, TensorFloatingTypes);
+
+TYPED_TEST(VantagePointTreeTest, search_matches_brute_force)
+{
+  using ArrayType = TypeParam;
+  using DataType  = typename TypeParam::Type;
+
+  SizeType const num_points = 200;
+  SizeType const k          = 7;
+
+  ArrayType data({num_points, 3});
+  data.FillUniformRandom();
+
+  ArrayType const distances =
+      distance::PairWiseDistanceMatrix(data, distance::PairWiseMetric::EUCLIDEAN);
+
+  clustering::VantagePointTree<DataType> const tree{distance::details::PackRows(data), 3};
+  ASSERT_EQ(tree.size(), num_points);
+
+  for (SizeType i = 0; i < num_points; ++i)
+  {
+    std::vector<std::pair<DataType, SizeType>> expected{};
+    for (SizeType j = 0; j < num_points; ++j)
+    {
+      if (i != j)
+      {
+        expected.emplace_back(distances.At(i, j), j);
+      }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    auto const neighbours = tree.SearchPoint(i, k);
+    ASSERT_EQ(neighbours.size(), k);
+
+    for (SizeType n = 0; n < k; ++n)
+    {
+      // ties may be returned in any order, the distances must match
+      EXPECT_EQ(neighbours[n].second, expected[n].first);
+    }
+  }
+}
+
+TYPED_TEST(VantagePointTreeTest, search_with_few_points)
+{
+  using ArrayType = TypeParam;
+  using DataType  = typename TypeParam::Type;
+
+  ArrayType data = ArrayType::FromString("1, 2; 2, 3; -1, -2");
+
+  clustering::VantagePointTree<DataType> const tree{distance::details::PackRows(data), 2};
+
+  auto const neighbours = tree.SearchPoint(0, 5);
+  ASSERT_EQ(neighbours.size(), 2);
+  EXPECT_EQ(neighbours[0].first, 1);
+  EXPECT_EQ(neighbours[1].first, 2);
+
+  std::vector<DataType> const query{DataType{-1}, DataType{-2}};
+  auto const                  nearest = tree.Search(query.data(), 1);
+  ASSERT_EQ(nearest.size(), 1);
+  EXPECT_EQ(nearest[0].first, 2);
+  EXPECT_EQ(nearest[0].second, DataType{0});
+}
+
+}  // namespace test
+}  // namespace math
+}  // namespace fetch
@@ -17,6 +17,9 @@
 //------------------------------------------------------------------------------
 
 #include "gtest/gtest.h"
+#include "math/distance/cosine.hpp"
+#include "math/distance/euclidean.hpp"
+#include "math/distance/manhattan.hpp"
 #include "math/distance/pairwise_distance.hpp"
 #include "math/matrix_operations.hpp"
 #include "test_types.hpp"
@@ -76,6 +79,75 @@ TYPED_TEST(PairWiseDistanceTest, simple_test)
 
   EXPECT_TRUE(R.AllClose(gt));
 }
+
+TYPED_TEST(PairWiseDistanceTest, builtin_metrics_match_generic)
+{
+  using DataType = typename TypeParam::Type;
+
+  // more rows than a single tile
+  SizeType const n = distance::details::PAIRWISE_BLOCK_SIZE + 6;
+
+  TypeParam data({n, 5});
+  data.FillUniformRandom();
+
+  TypeParam R({1, n * (n - 1) / 2});
+  TypeParam gt({1, n * (n - 1) / 2});
+
+  DataType const tolerance = function_tolerance<DataType>() * DataType{10};
+
+  distance::PairWiseDistance(data, distance::PairWiseMetric::EUCLIDEAN, R);
+  distance::PairWiseDistance(data, distance::Euclidean<TypeParam>, gt);
+  EXPECT_TRUE(R.AllClose(gt, tolerance, tolerance));
+
+  distance::PairWiseDistance(data, distance::PairWiseMetric::MANHATTAN, R);
+  distance::PairWiseDistance(data, distance::Manhattan<TypeParam>, gt);
+  EXPECT_TRUE(R.AllClose(gt, tolerance, tolerance));
+
+  distance::PairWiseDistance(data, distance::PairWiseMetric::COSINE, R);
+  distance::PairWiseDistance(data, distance::Cosine<TypeParam>, gt);
+  EXPECT_TRUE(R.AllClose(gt, tolerance, tolerance));
+}
+
+TYPED_TEST(PairWiseDistanceTest, distance_matrix_is_independent_of_threads)
+{
+  using DataType = typename TypeParam::Type;
+
+  SizeType const n = 300;
+
+  TypeParam data({n, 8});
+  data.FillUniformRandom();
+
+  TypeParam condensed({1, n * (n - 1) / 2});
+  distance::PairWiseDistance(data, distance::PairWiseMetric::EUCLIDEAN, condensed);
+
+  std::size_t const concurrency = distance::PairWiseConcurrency();
+
+  distance::SetPairWiseConcurrency(1);
+  TypeParam single = distance::PairWiseDistanceMatrix(data, distance::PairWiseMetric::EUCLIDEAN);
+
+  distance::SetPairWiseConcurrency(4);
+  TypeParam multi = distance::PairWiseDistanceMatrix(data, distance::PairWiseMetric::EUCLIDEAN);
+
+  distance::SetPairWiseConcurrency(concurrency);
+
+  SizeType k = 0;
+  for (SizeType i = 0; i < n; ++i)
+  {
+    EXPECT_EQ(single.At(i, i), DataType{0});
+
+    for (SizeType j = 0; j < n; ++j)
+    {
+      ASSERT_EQ(single.At(i, j), multi.At(i, j));
+      ASSERT_EQ(single.At(i, j), single.At(j, i));
+    }
+
+    for (SizeType j = i + 1; j < n; ++j)
+    {
+      ASSERT_EQ(single.At(i, j), condensed.At(0, k++));
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
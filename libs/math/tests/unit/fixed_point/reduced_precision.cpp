@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/matrix_operations.hpp"
+#include "math/reduced_precision.hpp"
+#include "math/tensor/tensor.hpp"
+#include "test_types.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <limits>
+
+namespace fetch {
+namespace math {
+namespace test {
+
+template <typename T>
+class ReducedPrecisionTest : public ::testing::Test
+{
+};
+
+using ReducedPrecisionTypes = ::testing::Types<fixed_point::fp32_t, fixed_point::fp64_t>;
+TYPED_TEST_CASE(ReducedPrecisionTest, ReducedPrecisionTypes);
+
+TYPED_TEST(ReducedPrecisionTest, round_trip)
+{
+  using DataType = TypeParam;
+
+  auto const src = Tensor<DataType>::FromString("1.5, -2.25, 0.0625, -127.0, 3.1");
+
+  auto const reduced = Quantise(src);
+  EXPECT_EQ(reduced(0, 0), 384);
+  EXPECT_EQ(reduced(0, 1), -576);
+  EXPECT_EQ(reduced(0, 2), 16);
+  EXPECT_EQ(reduced(0, 3), -32512);
+
+  Tensor<DataType> ret{src.shape()};
+  Dequantise(reduced, ret);
+
+  // values which are representable in Q8.8 are exact
+  for (SizeType i = 0; i < 4; ++i)
+  {
+    EXPECT_EQ(ret(0, i), src(0, i));
+  }
+
+  // everything else is truncated towards negative infinity
+  EXPECT_LE(ret(0, 4), src(0, 4));
+  EXPECT_NEAR(static_cast<double>(ret(0, 4)), 3.1, 1.0 / 256.0);
+}
+
+TYPED_TEST(ReducedPrecisionTest, saturation)
+{
+  using DataType = TypeParam;
+
+  Tensor<DataType> src{{1, 5}};
+  src(0, 0) = DataType{200};
+  src(0, 1) = DataType{-200};
+  src(0, 2) = DataType::POSITIVE_INFINITY;
+  src(0, 3) = DataType::NEGATIVE_INFINITY;
+  src(0, 4) = DataType::NaN;
+
+  DataType::fp_state = 0;
+  auto const reduced = Quantise(src);
+  EXPECT_EQ(reduced(0, 0), std::numeric_limits<int16_t>::max());
+  EXPECT_EQ(reduced(0, 1), std::numeric_limits<int16_t>::min());
+  EXPECT_EQ(reduced(0, 2), std::numeric_limits<int16_t>::max());
+  EXPECT_EQ(reduced(0, 3), std::numeric_limits<int16_t>::min());
+  EXPECT_EQ(reduced(0, 4), 0);
+
+  EXPECT_TRUE(DataType::IsStateOverflow());
+  EXPECT_TRUE(DataType::IsStateInfinity());
+  EXPECT_TRUE(DataType::IsStateNaN());
+  DataType::fp_state = 0;
+}
+
+TYPED_TEST(ReducedPrecisionTest, invalid_arguments)
+{
+  using DataType = TypeParam;
+
+  Tensor<DataType> src{{2, 3}};
+  ReducedTensor    wrong_shape{{3, 2}};
+
+  EXPECT_THROW(Quantise(src, wrong_shape), exceptions::WrongShape);
+  EXPECT_THROW(Quantise(src, 16), exceptions::InvalidMode);
+
+  Tensor<DataType> b{{2, 4}};
+  EXPECT_THROW(ReducedDot(ReducedTensor{{2, 3}}, b), exceptions::WrongShape);
+}
+
+TYPED_TEST(ReducedPrecisionTest, dot_matches_full_precision)
+{
+  using DataType = TypeParam;
+
+  // weights which are exactly representable in Q8.8 and inputs for which no product is truncated
+  auto const a = Tensor<DataType>::FromString("1.5, -2.0, 0.25; 0.5, 3.0, -1.75; -4.0, 0.125, 2.5");
+  auto const b = Tensor<DataType>::FromString("2.0, -1.0; 0.5, 4.0; -3.0, 1.5");
+
+  auto const reduced  = Quantise(a);
+  auto const result   = ReducedDot(reduced, b);
+  auto const expected = Dot(a, b);
+
+  ASSERT_EQ(result.shape(), expected.shape());
+  EXPECT_TRUE(result.AllClose(expected, DataType{0}, DataType{0}));
+}
+
+TYPED_TEST(ReducedPrecisionTest, dot_accumulates_before_truncating)
+{
+  using DataType = TypeParam;
+
+  SizeType const   k = 256;
+  ReducedTensor    a{{1, k}};
+  Tensor<DataType> b{{k, 1}};
+
+  // 2^-8 * 2^-FRACTIONAL_BITS would be truncated to zero by every multiplication
+  a.Fill(int16_t{1});
+  b.Fill(DataType::FromBase(1));
+
+  auto const result = ReducedDot(a, b);
+  EXPECT_EQ(result(0, 0).Data(), 1);
+}
+
+}  // namespace test
+}  // namespace math
+}  // namespace fetch
@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_blocked.hpp"
+#include "math/linalg/prototype.hpp"
+#include "math/tensor/tensor.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+
+using namespace fetch;
+using namespace fetch::math;
+using namespace fetch::math::linalg;
+
+namespace {
+
+template <typename T>
+class BlasGemmBlockedTests : public ::testing::Test
+{
+};
+
+using FloatingTypes = ::testing::Types<float, double>;
+TYPED_TEST_CASE(BlasGemmBlockedTests, FloatingTypes);
+
+// C = alpha * op(A) * op(B) + beta * C computed element by element
+template <typename Type>
+Tensor<Type> ReferenceGemm(Type alpha, Tensor<Type> const &a, bool transpose_a,
+                           Tensor<Type> const &b, bool transpose_b, Type beta,
+                           Tensor<Type> const &c)
+{
+  Tensor<Type> ret = c.Copy();
+
+  SizeType const k = transpose_a ? a.shape(0) : a.shape(1);
+  for (SizeType i = 0; i < c.shape(0); ++i)
+  {
+    for (SizeType j = 0; j < c.shape(1); ++j)
+    {
+      double sum = 0;
+      for (SizeType p = 0; p < k; ++p)
+      {
+        Type const a_ip = transpose_a ? a(p, i) : a(i, p);
+        Type const b_pj = transpose_b ? b(j, p) : b(p, j);
+        sum += static_cast<double>(a_ip) * static_cast<double>(b_pj);
+      }
+
+      ret(i, j) = (alpha * static_cast<Type>(sum)) + (beta * c(i, j));
+    }
+  }
+
+  return ret;
+}
+
+// sizes which are not multiples of the blocking parameters, with a depth spanning several panels
+constexpr SizeType M = 203;
+constexpr SizeType N = 147;
+constexpr SizeType K = 531;
+
+TYPED_TEST(BlasGemmBlockedTests, gemm_nn_blocked)
+{
+  using Type = TypeParam;
+
+  Tensor<Type> a({M, K});
+  Tensor<Type> b({K, N});
+  Tensor<Type> c({M, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+  c.FillUniformRandom();
+
+  auto const expected = ReferenceGemm(Type{2}, a, false, b, false, Type{0.5}, c);
+
+  Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+       Computes(_C <= _alpha * _A * _B + _beta * _C),
+       platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>
+      gemm_nn;
+  gemm_nn(Type{2}, a.View(), b.View(), Type{0.5}, c.View());
+
+  EXPECT_TRUE(expected.AllClose(c, Type{1e-4f}, Type{1e-4f}));
+}
+
+TYPED_TEST(BlasGemmBlockedTests, gemm_nt_blocked)
+{
+  using Type = TypeParam;
+
+  Tensor<Type> a({M, K});
+  Tensor<Type> b({N, K});
+  Tensor<Type> c({M, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+  c.FillUniformRandom();
+
+  auto const expected = ReferenceGemm(Type{1}, a, false, b, true, Type{0}, c);
+
+  Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+       Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+       platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>
+      gemm_nt;
+  gemm_nt(Type{1}, a.View(), b.View(), Type{0}, c.View());
+
+  EXPECT_TRUE(expected.AllClose(c, Type{1e-4f}, Type{1e-4f}));
+}
+
+TYPED_TEST(BlasGemmBlockedTests, gemm_tn_blocked)
+{
+  using Type = TypeParam;
+
+  Tensor<Type> a({K, M});
+  Tensor<Type> b({K, N});
+  Tensor<Type> c({M, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+  c.FillUniformRandom();
+
+  auto const expected = ReferenceGemm(Type{-1}, a, true, b, false, Type{1}, c);
+
+  Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+       Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+       platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING>
+      gemm_tn;
+  gemm_tn(Type{-1}, a.View(), b.View(), Type{1}, c.View());
+
+  EXPECT_TRUE(expected.AllClose(c, Type{1e-4f}, Type{1e-4f}));
+}
+
+TYPED_TEST(BlasGemmBlockedTests, gemm_blocked_is_independent_of_concurrency)
+{
+  using Type = TypeParam;
+
+  Tensor<Type> a({M, K});
+  Tensor<Type> b({K, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  std::size_t const original = GemmConcurrency();
+
+  Tensor<Type> serial({M, N});
+  SetGemmConcurrency(1);
+  GemmBlocked<Type>::Multiply(Type{1}, a.View(), false, b.View(), false, Type{0}, serial.View());
+
+  Tensor<Type> threaded({M, N});
+  SetGemmConcurrency(4);
+  GemmBlocked<Type>::Multiply(Type{1}, a.View(), false, b.View(), false, Type{0},
+                              threaded.View());
+
+  SetGemmConcurrency(original);
+
+  // the summation order does not depend on the threads, so the results are identical
+  EXPECT_TRUE(serial == threaded);
+}
+
+}  // namespace
@@ -1026,6 +1026,98 @@ TYPED_TEST(FreeFunctionsTest, ReduceMax3D_axes_0_2)
               static_cast<double>(function_tolerance<DataType>()));
 }
 
+TYPED_TEST(FreeFunctionsTest, ReduceSum_large_matches_iterated)
+{
+  using DataType = typename TypeParam::Type;
+
+  // large enough to be vectorised and split across threads
+  TypeParam array1{{70, 40, 100}};
+  array1.FillUniformRandom();
+
+  for (SizeType axis{0}; axis < array1.shape().size(); ++axis)
+  {
+    SizeVector shape = array1.shape();
+    shape.at(axis)   = 1;
+
+    TypeParam expected{shape};
+    expected.Fill(DataType{0});
+    fetch::math::Reduce(std::vector<SizeType>{axis},
+                        [](DataType const &x, DataType &y) { y = static_cast<DataType>(y + x); },
+                        array1, expected);
+
+    TypeParam output{shape};
+    fetch::math::ReduceSum(array1, axis, output);
+
+    auto const tolerance = static_cast<DataType>(function_tolerance<DataType>() * DataType{100});
+    EXPECT_TRUE(output.AllClose(expected, tolerance, tolerance));
+  }
+}
+
+TYPED_TEST(FreeFunctionsTest, ReduceMax_large_matches_iterated)
+{
+  using DataType = typename TypeParam::Type;
+
+  TypeParam array1{{70, 40, 100}};
+  array1.FillUniformRandom();
+
+  for (SizeType axis{0}; axis < array1.shape().size(); ++axis)
+  {
+    SizeVector shape = array1.shape();
+    shape.at(axis)   = 1;
+
+    TypeParam expected{shape};
+    expected.Fill(numeric_lowest<DataType>());
+    fetch::math::Reduce(std::vector<SizeType>{axis},
+                        [](DataType const &x, DataType &y) { y = (x < y) ? y : x; }, array1,
+                        expected);
+
+    TypeParam output{shape};
+    fetch::math::ReduceMax(array1, axis, output);
+
+    EXPECT_EQ(output, expected);
+  }
+}
+
+TYPED_TEST(FreeFunctionsTest, ArgMax_large)
+{
+  using DataType = typename TypeParam::Type;
+
+  TypeParam array1{{300, 1000}};
+  array1.FillUniformRandom();
+
+  TypeParam output{{1000}};
+  fetch::math::ArgMax(array1, output, 0);
+
+  for (SizeType j{0}; j < array1.shape(1); ++j)
+  {
+    SizeType position{0};
+    for (SizeType i{1}; i < array1.shape(0); ++i)
+    {
+      if (array1(i, j) > array1(position, j))
+      {
+        position = i;
+      }
+    }
+    ASSERT_EQ(output(j), static_cast<DataType>(position));
+  }
+
+  TypeParam output_off_axis{{300}};
+  fetch::math::ArgMax(array1, output_off_axis, 1);
+
+  for (SizeType i{0}; i < array1.shape(0); ++i)
+  {
+    SizeType position{0};
+    for (SizeType j{1}; j < array1.shape(1); ++j)
+    {
+      if (array1(i, j) > array1(i, position))
+      {
+        position = j;
+      }
+    }
+    ASSERT_EQ(output_off_axis(i), static_cast<DataType>(position));
+  }
+}
+
 TYPED_TEST(FreeFunctionsTest, Dot)
 {
   using DataType = typename TypeParam::Type;
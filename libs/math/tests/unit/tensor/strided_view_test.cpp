@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "math/matrix_operations.hpp"
+#include "math/tensor/tensor.hpp"
+#include "test_types.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+namespace fetch {
+namespace math {
+namespace test {
+
+template <typename T>
+class TensorStridedViewTests : public ::testing::Test
+{
+};
+
+template <typename T>
+class TensorStridedViewDotTests : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(TensorStridedViewTests, FloatIntAndUIntTypes);
+TYPED_TEST_CASE(TensorStridedViewDotTests, FloatingTypes);
+
+template <typename TypeParam>
+Tensor<TypeParam> Counting(SizeVector const &shape)
+{
+  Tensor<TypeParam> tensor(shape);
+  tensor.FillArange(static_cast<TypeParam>(0), static_cast<TypeParam>(tensor.size()));
+  return tensor;
+}
+
+TYPED_TEST(TensorStridedViewTests, transpose_does_not_copy)
+{
+  auto tensor = Counting<TypeParam>({3, 5});
+  auto view   = tensor.StridedView().Transpose();
+
+  EXPECT_EQ(view.shape(), SizeVector({5, 3}));
+  EXPECT_EQ(view.data().pointer(), tensor.data().pointer());
+  EXPECT_TRUE(view.IsTransposedMatrix());
+  EXPECT_FALSE(view.IsMatrix());
+
+  for (SizeType i{0}; i < 3; ++i)
+  {
+    for (SizeType j{0}; j < 5; ++j)
+    {
+      EXPECT_EQ(view({j, i}), tensor.At(i, j));
+    }
+  }
+
+  // the view follows later writes to the tensor
+  tensor.At(1, 4) = static_cast<TypeParam>(42);
+  EXPECT_EQ(view({4, 1}), static_cast<TypeParam>(42));
+}
+
+TYPED_TEST(TensorStridedViewTests, copy_matches_transpose)
+{
+  auto       tensor = Counting<TypeParam>({3, 4, 5});
+  SizeVector axes{2, 0, 1};
+
+  auto copy       = tensor.StridedView().Transpose(axes).Copy();
+  auto transposed = tensor.Transpose(axes);
+
+  EXPECT_EQ(copy.shape(), SizeVector({5, 3, 4}));
+  EXPECT_EQ(copy, transposed);
+
+  for (SizeType i{0}; i < 3; ++i)
+  {
+    for (SizeType j{0}; j < 4; ++j)
+    {
+      for (SizeType k{0}; k < 5; ++k)
+      {
+        EXPECT_EQ(copy.At(k, i, j), tensor.At(i, j, k));
+      }
+    }
+  }
+}
+
+TYPED_TEST(TensorStridedViewTests, slice_of_batch)
+{
+  auto tensor = Counting<TypeParam>({3, 4, 2});
+
+  for (SizeType batch{0}; batch < 2; ++batch)
+  {
+    auto view = tensor.StridedView().Slice(batch, 2);
+
+    EXPECT_TRUE(view.IsMatrix());
+    EXPECT_EQ(view.Copy(), tensor.View(batch).Copy());
+  }
+}
+
+TYPED_TEST(TensorStridedViewTests, slice_range)
+{
+  auto tensor = Counting<TypeParam>({4, 6});
+  auto view   = tensor.StridedView().Slice({1, 3}, 0).Slice({2, 5}, 1);
+
+  EXPECT_EQ(view.shape(), SizeVector({2, 3}));
+  EXPECT_FALSE(view.IsMatrix());
+
+  auto copy = view.Copy();
+  for (SizeType i{0}; i < 2; ++i)
+  {
+    for (SizeType j{0}; j < 3; ++j)
+    {
+      EXPECT_EQ(copy.At(i, j), tensor.At(i + 1, j + 2));
+    }
+  }
+}
+
+TYPED_TEST(TensorStridedViewDotTests, dot_of_transposed_views)
+{
+  auto a = Counting<TypeParam>({3, 4});
+  auto b = Counting<TypeParam>({4, 5});
+
+  auto const expected = Dot(a, b);
+
+  auto a_t = a.Transpose();
+  auto b_t = b.Transpose();
+
+  Tensor<TypeParam> nn;
+  Tensor<TypeParam> tn;
+  Tensor<TypeParam> nt;
+  Tensor<TypeParam> tt;
+  Dot(a.StridedView(), b.StridedView(), nn);
+  Dot(a_t.StridedView().Transpose(), b.StridedView(), tn);
+  Dot(a.StridedView(), b_t.StridedView().Transpose(), nt);
+  Dot(a_t.StridedView().Transpose(), b_t.StridedView().Transpose(), tt);
+
+  EXPECT_EQ(nn, expected);
+  EXPECT_EQ(tn, expected);
+  EXPECT_EQ(nt, expected);
+  EXPECT_EQ(tt, expected);
+}
+
+TYPED_TEST(TensorStridedViewDotTests, dot_materialises_other_views)
+{
+  auto a = Counting<TypeParam>({4, 4});
+  auto b = Counting<TypeParam>({4, 2});
+
+  // rows 1 to 2 of a are not a matrix in place, and are copied
+  auto              rows     = a.StridedView().Slice({1, 3}, 0);
+  auto const        expected = Dot(rows.Copy(), b);
+  Tensor<TypeParam> ret;
+  Dot(rows, b.StridedView(), ret);
+
+  EXPECT_EQ(ret, expected);
+}
+
+TYPED_TEST(TensorStridedViewDotTests, dot_shape_mismatch)
+{
+  auto a = Counting<TypeParam>({3, 4});
+  auto b = Counting<TypeParam>({3, 4});
+
+  Tensor<TypeParam> ret;
+  EXPECT_THROW(Dot(a.StridedView(), b.StridedView(), ret), exceptions::WrongShape);
+}
+
+}  // namespace test
+}  // namespace math
+}  // namespace fetch
@@ -108,3 +108,35 @@ TEST(tensor_iterator, broadcast_shape_size_test)
               std::accumulate(std::begin(ret_shape), std::end(ret_shape), SizeType(1),
                               std::multiplies<>()));
 }
+
+TEST(Tensor, broadcast_large_bias_test)
+{
+  // large enough to be split across threads
+  Tensor<float> a({300, 1000});
+  Tensor<float> b({300, 1});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  Tensor<float> ret;
+  ASSERT_TRUE(Broadcast([](float const &x, float const &y, float &z) { z = x - y; }, a, b, ret));
+  ASSERT_EQ(ret.shape(), a.shape());
+
+  for (SizeType i = 0; i < a.shape(0); ++i)
+  {
+    for (SizeType j = 0; j < a.shape(1); ++j)
+    {
+      ASSERT_EQ(ret(i, j), a(i, j) - b(i, 0));
+    }
+  }
+
+  Tensor<float> in_place = a.Copy();
+  ASSERT_TRUE(Broadcast([](float const &y, float &z) { z = z * y; }, b, in_place));
+
+  for (SizeType i = 0; i < a.shape(0); ++i)
+  {
+    for (SizeType j = 0; j < a.shape(1); ++j)
+    {
+      ASSERT_EQ(in_place(i, j), a(i, j) * b(i, 0));
+    }
+  }
+}
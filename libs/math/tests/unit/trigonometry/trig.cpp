@@ -482,6 +482,30 @@ TYPED_TEST(TrigTest, tanh_22)
                               function_tolerance<TypeParam>()));
 }
 
+// The batched implementation must agree exactly with the elementwise kernel
+TYPED_TEST(TrigTest, tanh_matches_elementwise_kernel)
+{
+  fetch::math::Tensor<TypeParam> input{{7, 5}};
+  input.FillUniformRandom();
+  input *= TypeParam{40};
+  input -= TypeParam{20};
+  input.At(0, 0) = TypeParam{0};
+
+  fetch::math::Tensor<TypeParam> const output = fetch::math::TanH(input);
+
+  kernels::TanH tanh;
+  auto          it  = input.cbegin();
+  auto          rit = output.cbegin();
+  while (it.is_valid())
+  {
+    TypeParam expected{};
+    tanh(*it, expected);
+    EXPECT_EQ(*rit, expected);
+    ++it;
+    ++rit;
+  }
+}
+
 TYPED_TEST(TrigTest, asinh)
 {
   auto      val = fetch::math::Type<TypeParam>("0.3");
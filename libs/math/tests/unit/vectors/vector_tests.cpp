@@ -89,6 +89,38 @@ TEST(vectorise_sse_gtest, register_test3)
 }
 #endif
 
+#ifdef __AVX512F__
+TEST(vectorise_avx512_gtest, masked_tail_test)
+{
+  using RegisterType = VectorRegister<float, 512>;
+
+  alignas(64) float a[16];
+  alignas(64) float c[16];
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    a[i] = static_cast<float>(i + 1);
+    c[i] = -1;
+  }
+
+  // only the first five elements are loaded and stored
+  RegisterType r1(a, RegisterType::FirstElements(5));
+  EXPECT_EQ(reduce(r1), 15);
+
+  r1 = r1 * RegisterType(2);
+  r1.Store(c, RegisterType::FirstElements(5));
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    EXPECT_EQ(c[i], (i < 5) ? a[i] * 2 : -1);
+  }
+
+  RegisterType r2(a);
+  EXPECT_EQ(reduce(vector_zero_below_element(r2, 14)), 15 + 16);
+  EXPECT_EQ(reduce(vector_zero_above_element(r2, 1)), 1 + 2);
+  EXPECT_EQ(first_element(shift_elements_right(r2)), 2);
+  EXPECT_EQ(first_element(shift_elements_left(r2)), 0);
+}
+#endif
+
 template <typename T>
 class VectorRegisterTest : public ::testing::Test
 {
@@ -103,6 +135,9 @@ using MyTypes = ::testing::Types<
     fetch::vectorise::VectorRegister<fetch::fixed_point::fp32_t, 256>,
     fetch::vectorise::VectorRegister<fetch::fixed_point::fp64_t, 128>,
     fetch::vectorise::VectorRegister<fetch::fixed_point::fp64_t, 256>,
+#ifdef __AVX512F__
+    fetch::vectorise::VectorRegister<float, 512>, fetch::vectorise::VectorRegister<double, 512>,
+#endif
     fetch::vectorise::VectorRegister<double, 128>, fetch::vectorise::VectorRegister<double, 256>>;
 
 using MyFPTypes =
@@ -128,7 +163,7 @@ TYPED_TEST(VectorRegisterTest, basic_tests)
 {
   using type = typename TypeParam::type;
 
-  alignas(32) type a[TypeParam::E_BLOCK_COUNT], b[TypeParam::E_BLOCK_COUNT],
+  alignas(64) type a[TypeParam::E_BLOCK_COUNT], b[TypeParam::E_BLOCK_COUNT],
       sum[TypeParam::E_BLOCK_COUNT], diff[TypeParam::E_BLOCK_COUNT], prod[TypeParam::E_BLOCK_COUNT],
       div[TypeParam::E_BLOCK_COUNT];
 
@@ -0,0 +1,124 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "messenger/mailbox_storage.hpp"
+#include "messenger/message.hpp"
+#include "muddle/address.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace messenger {
+
+/* The inbox of a single messenger.
+ *
+ * Delivery is lock free: new messages are pushed onto an intrusive stack by any number of
+ * threads and only moved into the ordered part of the inbox, under the inbox's own lock, when
+ * the messenger reads from it. Every message is numbered in order of arrival and indexed both by
+ * its sender and by its arrival time.
+ *
+ * If the inbox is backed by a MailboxStorage only the newest `max_in_memory` messages are kept
+ * in memory, older messages are written to the storage. All remaining messages are written to
+ * the storage when the inbox is destroyed and are restored when it is created again.
+ */
+class Inbox
+{
+public:
+  using Address     = muddle::Address;
+  using MessageList = std::deque<Message>;
+  using Timestamp   = uint64_t;
+  using StoragePtr  = std::shared_ptr<MailboxStorage>;
+
+  static constexpr std::size_t UNBOUNDED = std::numeric_limits<std::size_t>::max();
+
+  explicit Inbox(Address address, std::size_t max_in_memory = UNBOUNDED,
+                 StoragePtr storage = nullptr);
+  Inbox(Inbox const &) = delete;
+  Inbox(Inbox &&)      = delete;
+  ~Inbox();
+
+  /// @name Delivery
+  /// @{
+  void Push(Message message);
+  void Push(std::vector<Message> messages);
+  /// @}
+
+  /// @name Retrieval
+  /// @{
+  MessageList GetMessages();
+  MessageList GetMessagesFrom(Address const &sender);
+  MessageList GetMessagesSince(Timestamp timestamp);
+  void        Clear(uint64_t count);
+  std::size_t size();
+  /// @}
+
+  void Erase();
+
+  static Timestamp Now();
+
+  Inbox &operator=(Inbox const &) = delete;
+  Inbox &operator=(Inbox &&) = delete;
+
+private:
+  struct Node
+  {
+    InboxEntry entry{};
+    Node *     next{nullptr};
+  };
+
+  using Sequences = std::deque<uint64_t>;
+
+  void    Link(Node *newest, Node *oldest, std::size_t count);
+  void    Drain();
+  void    Append(InboxEntry entry);
+  void    Spill(std::size_t count);
+  void    Restore();
+  bool    Load(uint64_t sequence, Message &message);
+  void    Prune(Sequences &sequences) const;
+
+  uint64_t next() const
+  {
+    return first_ + timestamps_.size();
+  }
+
+  Address const     address_;
+  std::size_t const max_in_memory_;
+  StoragePtr const  storage_;
+
+  std::atomic<Node *>      pending_{nullptr};  ///< Delivered messages, newest first
+  std::atomic<std::size_t> pending_count_{0};
+
+  Mutex                                  lock_;
+  uint64_t                               first_{0};    ///< Sequence of the oldest message
+  uint64_t                               spilled_{0};  ///< End of the stored sequences
+  std::deque<InboxEntry>                 memory_{};    ///< Messages from `spilled_` onwards
+  std::deque<Timestamp>                  timestamps_{};  ///< Arrival times from `first_` onwards
+  std::unordered_map<Address, Sequences> senders_{};
+};
+
+}  // namespace messenger
+}  // namespace fetch
@@ -19,7 +19,9 @@
 
 #include "core/mutex.hpp"
 #include "core/service_ids.hpp"
+#include "messenger/inbox.hpp"
 #include "messenger/mailbox_interface.hpp"
+#include "messenger/mailbox_storage.hpp"
 #include "messenger/message.hpp"
 #include "muddle/muddle_endpoint.hpp"
 #include "muddle/muddle_interface.hpp"
@@ -27,13 +29,26 @@
 #include "muddle/rpc/server.hpp"
 #include "muddle/subscription.hpp"
 
+#include <cstddef>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace fetch {
 namespace messenger {
 
+/* Mailbox of the messengers connected to a node.
+ *
+ * Every registered messenger has its own Inbox. The set of inboxes is an immutable snapshot which
+ * is replaced when a messenger registers or unregisters, so that delivering a message only takes
+ * the (lock free) path into the inbox of its recipient. Messages for other nodes are forwarded
+ * over the muddle, one packet per node for every batch of messages.
+ *
+ * If the mailbox is given a storage the inboxes keep at most `max_in_memory` messages in memory
+ * and survive a restart of the node.
+ */
 class Mailbox final : public MailboxInterface
 {
 public:
@@ -41,8 +56,10 @@ public:
   using Endpoint        = muddle::MuddleEndpoint;
   using MuddleInterface = muddle::MuddleInterface;
   using SubscriptionPtr = muddle::MuddleEndpoint::SubscriptionPtr;
+  using StoragePtr      = Inbox::StoragePtr;
 
-  explicit Mailbox(muddle::MuddlePtr &muddle);
+  explicit Mailbox(muddle::MuddlePtr &muddle, std::size_t max_in_memory = Inbox::UNBOUNDED,
+                   StoragePtr storage = nullptr);
   ~Mailbox() override = default;
 
   void SetDeliveryFunction(DeliveryFunction const &attempt_delivery) override;
@@ -50,7 +67,10 @@ public:
   /// Mailbox interface
   /// @{
   void        SendMessage(Message message) override;
+  void        SendMessages(std::vector<Message> messages) override;
   MessageList GetMessages(Address messenger) override;
+  MessageList GetMessagesFrom(Address messenger, Address sender) override;
+  MessageList GetMessagesSince(Address messenger, uint64_t timestamp) override;
   void        ClearMessages(Address messenger, uint64_t count) override;
   /// @}
 
@@ -61,21 +81,31 @@ public:
   /// @}
 
 protected:
-  void DeliverMessageLockLess(Message const &message);
+  void DeliverMessages(std::vector<Message> messages);
 
   /// Subscription Hnadlers
   /// @{
   void OnNewMessagePacket(muddle::Packet const &packet, Address const &last_hop);
+  void OnNewBatchPacket(muddle::Packet const &packet, Address const &last_hop);
   /// }
 
-  // TODO(private issue AEA-122): Add state logic to trim inboxes
-  //
 private:
-  Mutex                                    mutex_{};
-  std::unordered_map<Address, MessageList> inboxes_{};
+  using InboxPtr    = std::shared_ptr<Inbox>;
+  using InboxMap    = std::unordered_map<Address, InboxPtr>;
+  using InboxMapPtr = std::shared_ptr<InboxMap const>;
+
+  InboxPtr FindInbox(Address const &messenger) const;
+  void     Route(Message &message) const;
+
+  std::size_t const max_in_memory_;
+  StoragePtr const  storage_;
+
+  Mutex       mutex_{};  ///< Serialises changes to the set of inboxes
+  InboxMapPtr inboxes_{std::make_shared<InboxMap const>()};
 
   Endpoint &      message_endpoint_;
   SubscriptionPtr message_subscription_;
+  SubscriptionPtr batch_subscription_;
 
   DeliveryFunction attempt_delivery_;
 };
@@ -21,8 +21,11 @@
 #include "muddle/muddle_endpoint.hpp"
 #include "muddle/muddle_interface.hpp"
 
+#include <algorithm>
 #include <deque>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace messenger {
@@ -42,6 +45,31 @@ public:
   virtual void        ClearMessages(Address messenger, uint64_t count)              = 0;
   virtual void        RegisterMailbox(Address messenger)                            = 0;
   virtual void        UnregisterMailbox(Address messenger)                          = 0;
+
+  virtual void SendMessages(std::vector<Message> messages)
+  {
+    for (auto &message : messages)
+    {
+      SendMessage(std::move(message));
+    }
+  }
+
+  virtual MessageList GetMessagesFrom(Address messenger, Address sender)
+  {
+    auto messages = GetMessages(std::move(messenger));
+    messages.erase(std::remove_if(messages.begin(), messages.end(),
+                                  [&sender](Message const &message) {
+                                    return message.from.messenger != sender;
+                                  }),
+                   messages.end());
+    return messages;
+  }
+
+  /// Mailboxes which do not keep arrival times return all messages
+  virtual MessageList GetMessagesSince(Address messenger, uint64_t /*timestamp*/)
+  {
+    return GetMessages(std::move(messenger));
+  }
 };
 
 }  // namespace messenger
@@ -0,0 +1,147 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/base_types.hpp"
+#include "core/serializers/group_definitions.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "messenger/message.hpp"
+#include "muddle/address.hpp"
+#include "storage/object_store.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace messenger {
+
+/* A message held by an inbox together with the time it arrived at the node (in milliseconds
+ * since the epoch).
+ */
+struct InboxEntry
+{
+  uint64_t timestamp{0};
+  Message  message{};
+};
+
+/* Persistent store for the inboxes of a mailbox. The messages of an inbox are numbered in order of
+ * arrival and every inbox keeps the range of sequence numbers currently held by the store, which
+ * allows an inbox to be restored when its messenger registers again after a restart.
+ */
+class MailboxStorage
+{
+public:
+  using Address = muddle::Address;
+
+  struct Range
+  {
+    uint64_t first{0};  ///< Sequence number of the oldest stored message
+    uint64_t next{0};   ///< Sequence number following the newest stored message
+
+    bool empty() const
+    {
+      return first >= next;
+    }
+  };
+
+  MailboxStorage()                       = default;
+  MailboxStorage(MailboxStorage const &) = delete;
+  MailboxStorage(MailboxStorage &&)      = delete;
+  ~MailboxStorage()                      = default;
+
+  void New(std::string const &prefix);
+  void Load(std::string const &prefix);
+
+  bool GetRange(Address const &inbox, Range &range);
+  void SetRange(Address const &inbox, Range const &range);
+
+  bool Get(Address const &inbox, uint64_t sequence, InboxEntry &entry);
+  void Store(Address const &inbox, uint64_t first, std::vector<InboxEntry> const &entries);
+  void Erase(Address const &inbox, Range const &range);
+
+  MailboxStorage &operator=(MailboxStorage const &) = delete;
+  MailboxStorage &operator=(MailboxStorage &&) = delete;
+
+private:
+  static storage::ResourceID EntryKey(Address const &inbox, uint64_t sequence);
+  static storage::ResourceID RangeKey(Address const &inbox);
+
+  storage::ObjectStore<InboxEntry> entries_{};
+  storage::ObjectStore<Range>      ranges_{};
+};
+
+}  // namespace messenger
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<messenger::InboxEntry, D>
+{
+public:
+  using Type       = messenger::InboxEntry;
+  using DriverType = D;
+
+  static uint8_t const TIMESTAMP = 1;
+  static uint8_t const MESSAGE   = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &entry)
+  {
+    auto map = map_constructor(2);
+    map.Append(TIMESTAMP, entry.timestamp);
+    map.Append(MESSAGE, entry.message);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &entry)
+  {
+    map.ExpectKeyGetValue(TIMESTAMP, entry.timestamp);
+    map.ExpectKeyGetValue(MESSAGE, entry.message);
+  }
+};
+
+template <typename D>
+struct MapSerializer<messenger::MailboxStorage::Range, D>
+{
+public:
+  using Type       = messenger::MailboxStorage::Range;
+  using DriverType = D;
+
+  static uint8_t const FIRST = 1;
+  static uint8_t const NEXT  = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &range)
+  {
+    auto map = map_constructor(2);
+    map.Append(FIRST, range.first);
+    map.Append(NEXT, range.next);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &range)
+  {
+    map.ExpectKeyGetValue(FIRST, range.first);
+    map.ExpectKeyGetValue(NEXT, range.next);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
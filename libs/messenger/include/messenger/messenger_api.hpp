@@ -42,6 +42,7 @@ public:
   using ServiceClient  = service::ServiceClient;
   using PublicKey      = byte_array::ConstByteArray;
   using MessageList    = Mailbox::MessageList;
+  using Address        = Mailbox::Address;
 
   using Client          = muddle::rpc::Client;
   using Server          = muddle::rpc::Server;
@@ -73,6 +74,9 @@ public:
   void        SendMessage(service::CallContext const &call_context, Message msg);
   MessageList GetMessages(service::CallContext const &call_context);
   void        ClearMessages(service::CallContext const &call_context, uint64_t count);
+  void        SendMessages(service::CallContext const &call_context, std::vector<Message> msgs);
+  MessageList GetMessagesFrom(service::CallContext const &call_context, Address const &sender);
+  MessageList GetMessagesSince(service::CallContext const &call_context, uint64_t timestamp);
   /// @}
 
   /// Search interface
@@ -30,9 +30,12 @@ public:
     REGISTER_MESSENGER   = 1,
     UNREGISTER_MESSENGER = 2,
 
-    SEND_MESSAGE   = 11,
-    GET_MESSAGES   = 12,
-    CLEAR_MESSAGES = 13,
+    SEND_MESSAGE       = 11,
+    GET_MESSAGES       = 12,
+    CLEAR_MESSAGES     = 13,
+    SEND_MESSAGES      = 14,
+    GET_MESSAGES_FROM  = 15,
+    GET_MESSAGES_SINCE = 16,
 
     FIND_MESSENGERS = 21,
     ADVERTISE       = 22
@@ -0,0 +1,429 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "logging/logging.hpp"
+#include "messenger/inbox.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace fetch {
+namespace messenger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "Inbox";
+
+}  // namespace
+
+/**
+ * Create an inbox, restoring any messages kept in the storage
+ *
+ * @param address The address of the messenger owning the inbox
+ * @param max_in_memory The maximum number of messages kept in memory, only applies to inboxes
+ * backed by a storage
+ * @param storage The (optional) storage of the inbox
+ */
+Inbox::Inbox(Address address, std::size_t max_in_memory, StoragePtr storage)
+  : address_{std::move(address)}
+  , max_in_memory_{max_in_memory}
+  , storage_{std::move(storage)}
+{
+  if (storage_)
+  {
+    Restore();
+  }
+}
+
+Inbox::~Inbox()
+{
+  FETCH_LOCK(lock_);
+
+  try
+  {
+    Drain();
+
+    if (storage_ && !memory_.empty())
+    {
+      Spill(memory_.size());
+    }
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Unable to store inbox: ", ex.what());
+  }
+}
+
+/**
+ * Deliver a message to the inbox, may be called concurrently by any number of threads
+ *
+ * @param message The message
+ */
+void Inbox::Push(Message message)
+{
+  auto node = new Node{InboxEntry{Now(), std::move(message)}, nullptr};
+  Link(node, node, 1);
+}
+
+/**
+ * Deliver a batch of messages to the inbox, the messages are added with a single atomic update
+ *
+ * @param messages The messages in order of arrival
+ */
+void Inbox::Push(std::vector<Message> messages)
+{
+  if (messages.empty())
+  {
+    return;
+  }
+
+  auto const timestamp = Now();
+  Node *     newest    = nullptr;
+  Node *     oldest    = nullptr;
+
+  for (auto &message : messages)
+  {
+    newest = new Node{InboxEntry{timestamp, std::move(message)}, newest};
+    if (oldest == nullptr)
+    {
+      oldest = newest;
+    }
+  }
+
+  Link(newest, oldest, messages.size());
+}
+
+Inbox::MessageList Inbox::GetMessages()
+{
+  FETCH_LOCK(lock_);
+  Drain();
+
+  MessageList messages;
+  for (uint64_t sequence = first_; sequence < spilled_; ++sequence)
+  {
+    Message message;
+    if (Load(sequence, message))
+    {
+      messages.push_back(std::move(message));
+    }
+  }
+
+  for (auto const &entry : memory_)
+  {
+    messages.push_back(entry.message);
+  }
+
+  return messages;
+}
+
+/**
+ * Get the messages sent by a messenger
+ *
+ * @param sender The address of the messenger
+ * @return The messages in order of arrival
+ */
+Inbox::MessageList Inbox::GetMessagesFrom(Address const &sender)
+{
+  FETCH_LOCK(lock_);
+  Drain();
+
+  auto it = senders_.find(sender);
+  if (it == senders_.end())
+  {
+    return {};
+  }
+
+  MessageList messages;
+  for (auto const sequence : it->second)
+  {
+    Message message;
+    if (Load(sequence, message))
+    {
+      messages.push_back(std::move(message));
+    }
+  }
+
+  return messages;
+}
+
+/**
+ * Get the messages which arrived at or after a given time
+ *
+ * @param timestamp The time in milliseconds since the epoch
+ * @return The messages in order of arrival
+ */
+Inbox::MessageList Inbox::GetMessagesSince(Timestamp timestamp)
+{
+  FETCH_LOCK(lock_);
+  Drain();
+
+  // arrival times are monotonic
+  auto const first = static_cast<uint64_t>(
+      std::lower_bound(timestamps_.begin(), timestamps_.end(), timestamp) - timestamps_.begin());
+
+  MessageList messages;
+  for (uint64_t sequence = first_ + first; sequence < next(); ++sequence)
+  {
+    Message message;
+    if (Load(sequence, message))
+    {
+      messages.push_back(std::move(message));
+    }
+  }
+
+  return messages;
+}
+
+/**
+ * Remove the oldest messages from the inbox
+ *
+ * @param count The number of messages to remove
+ */
+void Inbox::Clear(uint64_t count)
+{
+  FETCH_LOCK(lock_);
+  Drain();
+
+  auto const end = first_ + std::min(count, static_cast<uint64_t>(timestamps_.size()));
+
+  if (storage_ && (first_ < spilled_))
+  {
+    storage_->Erase(address_, MailboxStorage::Range{first_, std::min(end, spilled_)});
+    storage_->SetRange(address_, MailboxStorage::Range{end, spilled_});
+  }
+
+  while ((spilled_ < end) && !memory_.empty())
+  {
+    memory_.pop_front();
+    ++spilled_;
+  }
+
+  timestamps_.erase(timestamps_.begin(),
+                    timestamps_.begin() + static_cast<std::ptrdiff_t>(end - first_));
+  first_   = end;
+  spilled_ = std::max(spilled_, first_);
+
+  for (auto it = senders_.begin(); it != senders_.end();)
+  {
+    Prune(it->second);
+    if (it->second.empty())
+    {
+      it = senders_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+std::size_t Inbox::size()
+{
+  FETCH_LOCK(lock_);
+  Drain();
+
+  return timestamps_.size();
+}
+
+/**
+ * Remove all messages from the inbox, including the ones kept in the storage
+ */
+void Inbox::Erase()
+{
+  FETCH_LOCK(lock_);
+  Drain();
+
+  if (storage_ && (first_ < spilled_))
+  {
+    storage_->Erase(address_, MailboxStorage::Range{first_, spilled_});
+    storage_->SetRange(address_, MailboxStorage::Range{});
+  }
+
+  first_   = 0;
+  spilled_ = 0;
+  memory_.clear();
+  timestamps_.clear();
+  senders_.clear();
+}
+
+/**
+ * The current time in milliseconds since the epoch
+ */
+Inbox::Timestamp Inbox::Now()
+{
+  return static_cast<Timestamp>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::system_clock::now().time_since_epoch())
+                                    .count());
+}
+
+/**
+ * Internal: Push a chain of nodes onto the stack of pending messages
+ *
+ * @param newest The first node of the chain
+ * @param oldest The last node of the chain
+ * @param count The number of nodes in the chain
+ */
+void Inbox::Link(Node *newest, Node *oldest, std::size_t count)
+{
+  oldest->next = pending_.load(std::memory_order_relaxed);
+  while (!pending_.compare_exchange_weak(oldest->next, newest, std::memory_order_release,
+                                         std::memory_order_relaxed))
+  {
+  }
+
+  // bound the memory used by the inboxes of messengers which are not reading their messages
+  auto const pending = pending_count_.fetch_add(count, std::memory_order_relaxed) + count;
+  if (storage_ && (pending > max_in_memory_))
+  {
+    FETCH_LOCK(lock_);
+    Drain();
+  }
+}
+
+/**
+ * Internal: Move the pending messages into the inbox. Must be called with the lock held.
+ */
+void Inbox::Drain()
+{
+  Node *node   = pending_.exchange(nullptr, std::memory_order_acquire);
+  Node *oldest = nullptr;
+
+  // the stack holds the newest message first
+  while (node != nullptr)
+  {
+    auto next  = node->next;
+    node->next = oldest;
+    oldest     = node;
+    node       = next;
+  }
+
+  std::size_t count = 0;
+  while (oldest != nullptr)
+  {
+    std::unique_ptr<Node> current{oldest};
+    oldest = current->next;
+
+    Append(std::move(current->entry));
+    ++count;
+  }
+
+  pending_count_.fetch_sub(count, std::memory_order_relaxed);
+
+  if (storage_ && (memory_.size() > max_in_memory_))
+  {
+    Spill(memory_.size() - max_in_memory_);
+  }
+}
+
+void Inbox::Append(InboxEntry entry)
+{
+  if (!timestamps_.empty())
+  {
+    entry.timestamp = std::max(entry.timestamp, timestamps_.back());
+  }
+
+  timestamps_.push_back(entry.timestamp);
+  senders_[entry.message.from.messenger].push_back(next() - 1);
+  memory_.push_back(std::move(entry));
+}
+
+/**
+ * Internal: Write the oldest messages held in memory to the storage
+ *
+ * @param count The number of messages to write
+ */
+void Inbox::Spill(std::size_t count)
+{
+  std::vector<InboxEntry> entries{};
+  entries.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    entries.push_back(std::move(memory_.front()));
+    memory_.pop_front();
+  }
+
+  storage_->Store(address_, spilled_, entries);
+  spilled_ += count;
+  storage_->SetRange(address_, MailboxStorage::Range{first_, spilled_});
+}
+
+/**
+ * Internal: Rebuild the indices of the messages kept in the storage
+ */
+void Inbox::Restore()
+{
+  MailboxStorage::Range range{};
+  if (!storage_->GetRange(address_, range))
+  {
+    return;
+  }
+
+  first_   = range.first;
+  spilled_ = range.first;
+
+  InboxEntry entry{};
+  while ((spilled_ < range.next) && storage_->Get(address_, spilled_, entry))
+  {
+    timestamps_.push_back(entry.timestamp);
+    senders_[entry.message.from.messenger].push_back(spilled_);
+    ++spilled_;
+  }
+
+  if (spilled_ != range.next)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Lost ", range.next - spilled_, " stored messages");
+    storage_->SetRange(address_, MailboxStorage::Range{first_, spilled_});
+  }
+}
+
+/**
+ * Internal: Get a message by its sequence number. Must be called with the lock held.
+ */
+bool Inbox::Load(uint64_t sequence, Message &message)
+{
+  if (sequence >= spilled_)
+  {
+    message = memory_[sequence - spilled_].message;
+    return true;
+  }
+
+  InboxEntry entry{};
+  if (!storage_ || !storage_->Get(address_, sequence, entry))
+  {
+    return false;
+  }
+
+  message = std::move(entry.message);
+  return true;
+}
+
+/**
+ * Internal: Drop the sequence numbers of removed messages from the front of an index
+ */
+void Inbox::Prune(Sequences &sequences) const
+{
+  while (!sequences.empty() && (sequences.front() < first_))
+  {
+    sequences.pop_front();
+  }
+}
+
+}  // namespace messenger
+}  // namespace fetch
@@ -21,16 +21,30 @@
 #include "messenger/messenger_protocol.hpp"
 
 #include <cassert>
+#include <utility>
 
 namespace fetch {
 namespace messenger {
 
-Mailbox::Mailbox(muddle::MuddlePtr &muddle)
-  : message_endpoint_{muddle->GetEndpoint()}
+/**
+ * Create a mailbox
+ *
+ * @param muddle The muddle used to reach the mailboxes of other nodes
+ * @param max_in_memory The maximum number of messages an inbox keeps in memory, only applies to
+ * mailboxes with a storage
+ * @param storage The (optional) persistent storage of the inboxes
+ */
+Mailbox::Mailbox(muddle::MuddlePtr &muddle, std::size_t max_in_memory, StoragePtr storage)
+  : max_in_memory_{max_in_memory}
+  , storage_{std::move(storage)}
+  , message_endpoint_{muddle->GetEndpoint()}
   , message_subscription_{
         message_endpoint_.Subscribe(SERVICE_MSG_TRANSPORT, CHANNEL_MESSENGER_TRANSPORT)}
+  , batch_subscription_{
+        message_endpoint_.Subscribe(SERVICE_MSG_TRANSPORT, CHANNEL_MESSENGER_TRANSPORT_BATCH)}
 {
   message_subscription_->SetMessageHandler(this, &Mailbox::OnNewMessagePacket);
+  batch_subscription_->SetMessageHandler(this, &Mailbox::OnNewBatchPacket);
 }
 
 void Mailbox::SetDeliveryFunction(DeliveryFunction const &attempt_delivery)
@@ -54,27 +68,41 @@ void Mailbox::OnNewMessagePacket(muddle::Packet const &packet, Address const & /
   }
 }
 
-void Mailbox::SendMessage(Message message)
+void Mailbox::OnNewBatchPacket(muddle::Packet const &packet, Address const & /*last_hop*/)
 {
-  FETCH_LOCK(mutex_);
-
-  // Setting the entry node
-  if (message.from.node.empty())
+  fetch::serializers::MsgPackSerializer serialiser(packet.GetPayload());
+  try
   {
-    message.from.node = message_endpoint_.GetAddress();
+    std::vector<Message> messages;
+    serialiser >> messages;
+    SendMessages(std::move(messages));
   }
-
-  // Setting to node
-  if (message.to.node.empty())
+  catch (std::exception const &e)
   {
-    message.to.node = message_endpoint_.GetAddress();
+    FETCH_LOG_ERROR("Mailbox",
+                    "Retrieved messages malformed: ", static_cast<std::string>(e.what()));
   }
+}
+
+void Mailbox::SendMessage(Message message)
+{
+  Route(message);
 
   // If the message is sent to this node, then we deliver it right
   // away
   if (message.to.node == message_endpoint_.GetAddress())
   {
-    DeliverMessageLockLess(message);
+    auto inbox = FindInbox(message.to.messenger);
+    if (inbox)
+    {
+      inbox->Push(std::move(message));
+    }
+    else if (attempt_delivery_)
+    {
+      // Attempting to deliver directly
+      attempt_delivery_(message);
+    }
+
     return;
   }
 
@@ -86,97 +114,196 @@ void Mailbox::SendMessage(Message message)
                          serializer.data());
 }
 
-Mailbox::MessageList Mailbox::GetMessages(Address messenger)
+/**
+ * Send a batch of messages. Messages for this node are delivered with one update per inbox and
+ * the remaining messages are forwarded with one muddle packet per node.
+ *
+ * @param messages The messages, in the order they were sent
+ */
+void Mailbox::SendMessages(std::vector<Message> messages)
 {
-  FETCH_LOCK(mutex_);
+  std::vector<Message>                              local{};
+  std::unordered_map<Address, std::vector<Message>> remote{};
+
+  for (auto &message : messages)
+  {
+    Route(message);
+
+    if (message.to.node == message_endpoint_.GetAddress())
+    {
+      local.push_back(std::move(message));
+    }
+    else
+    {
+      remote[message.to.node].push_back(std::move(message));
+    }
+  }
+
+  DeliverMessages(std::move(local));
+
+  for (auto const &batch : remote)
+  {
+    serializers::MsgPackSerializer serializer;
+    serializer << batch.second;
+
+    message_endpoint_.Send(batch.first, SERVICE_MSG_TRANSPORT, CHANNEL_MESSENGER_TRANSPORT_BATCH,
+                           serializer.data());
+  }
+}
 
+Mailbox::MessageList Mailbox::GetMessages(Address messenger)
+{
   // Checking that the mailbox exists
-  auto it = inboxes_.find(messenger);
-  if (it == inboxes_.end())
+  auto inbox = FindInbox(messenger);
+  if (!inbox)
   {
     return {};
   }
 
-  return it->second;
+  return inbox->GetMessages();
 }
 
-void Mailbox::ClearMessages(Address messenger, uint64_t count)
+Mailbox::MessageList Mailbox::GetMessagesFrom(Address messenger, Address sender)
 {
-  FETCH_LOCK(mutex_);
-
-  // Checking that the mailbox exists
-  auto it = inboxes_.find(messenger);
-  if (it == inboxes_.end())
+  auto inbox = FindInbox(messenger);
+  if (!inbox)
   {
-    return;
+    return {};
   }
 
-  // Emptying mailbox
-  if (count >= it->second.size())
+  return inbox->GetMessagesFrom(sender);
+}
+
+Mailbox::MessageList Mailbox::GetMessagesSince(Address messenger, uint64_t timestamp)
+{
+  auto inbox = FindInbox(messenger);
+  if (!inbox)
   {
-    it->second.clear();
+    return {};
   }
-  else
+
+  return inbox->GetMessagesSince(timestamp);
+}
+
+void Mailbox::ClearMessages(Address messenger, uint64_t count)
+{
+  // Checking that the mailbox exists
+  auto inbox = FindInbox(messenger);
+  if (!inbox)
   {
-    while (count != 0)
-    {
-      it->second.pop_front();
-      --count;
-    }
+    return;
   }
+
+  inbox->Clear(count);
 }
 
 void Mailbox::RegisterMailbox(Address messenger)
 {
   FETCH_LOCK(mutex_);
 
-  if (inboxes_.find(messenger) != inboxes_.end())
+  if (inboxes_->find(messenger) != inboxes_->end())
   {
     // Mailbox already exists
     return;
   }
 
-  // Creating an empty mailbox
-  inboxes_[messenger] = MessageList();
+  // Creating the mailbox, restoring any stored messages
+  auto inboxes = std::make_shared<InboxMap>(*inboxes_);
+  (*inboxes)[messenger] = std::make_shared<Inbox>(messenger, max_in_memory_, storage_);
+
+  std::atomic_store(&inboxes_, InboxMapPtr{std::move(inboxes)});
 }
 
 void Mailbox::UnregisterMailbox(Address messenger)
 {
   FETCH_LOCK(mutex_);
-  auto it = inboxes_.find(messenger);
+  auto it = inboxes_->find(messenger);
 
   // Checking if mailbox exists
-  if (it == inboxes_.end())
+  if (it == inboxes_->end())
   {
     return;
   }
 
   // Deleting mailbox
-  inboxes_.erase(it);
+  auto inbox   = it->second;
+  auto inboxes = std::make_shared<InboxMap>(*inboxes_);
+  inboxes->erase(messenger);
+
+  std::atomic_store(&inboxes_, InboxMapPtr{std::move(inboxes)});
+  inbox->Erase();
 }
 
-void Mailbox::DeliverMessageLockLess(Message const &message)
+/**
+ * Deliver messages to the inboxes of this node, the messages of every inbox are added at once
+ *
+ * @param messages The messages, in the order they were sent
+ */
+void Mailbox::DeliverMessages(std::vector<Message> messages)
 {
-  // Checking if we are delivering to the right node.
-  if (message_endpoint_.GetAddress() != message.to.node)
+  std::unordered_map<Address, std::vector<Message>> batches{};
+
+  for (auto &message : messages)
   {
-    return;
+    // Checking if we are delivering to the right node.
+    if (message_endpoint_.GetAddress() != message.to.node)
+    {
+      continue;
+    }
+
+    batches[message.to.messenger].push_back(std::move(message));
   }
 
-  auto it = inboxes_.find(message.to.messenger);
-  if (it == inboxes_.end())
+  auto inboxes = std::atomic_load(&inboxes_);
+  for (auto &batch : batches)
   {
+    auto it = inboxes->find(batch.first);
+    if (it != inboxes->end())
+    {
+      it->second->Push(std::move(batch.second));
+      continue;
+    }
+
     // Attempting to deliver directly
     if (attempt_delivery_)
     {
-      attempt_delivery_(message);
+      for (auto const &message : batch.second)
+      {
+        attempt_delivery_(message);
+      }
     }
+  }
+}
 
-    return;
+Mailbox::InboxPtr Mailbox::FindInbox(Address const &messenger) const
+{
+  auto inboxes = std::atomic_load(&inboxes_);
+
+  auto it = inboxes->find(messenger);
+  if (it == inboxes->end())
+  {
+    return {};
+  }
+
+  return it->second;
+}
+
+/**
+ * Internal: Fill in the nodes of a message which were left empty by the sender
+ */
+void Mailbox::Route(Message &message) const
+{
+  // Setting the entry node
+  if (message.from.node.empty())
+  {
+    message.from.node = message_endpoint_.GetAddress();
   }
 
-  // Adding message to mailbox
-  it->second.push_back(message);
+  // Setting to node
+  if (message.to.node.empty())
+  {
+    message.to.node = message_endpoint_.GetAddress();
+  }
 }
 
 }  // namespace messenger
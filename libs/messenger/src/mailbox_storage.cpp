@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/sha256.hpp"
+#include "messenger/mailbox_storage.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace messenger {
+
+/**
+ * Create a new (empty) store, existing files are overwritten
+ *
+ * @param prefix The path prefix of the files of the store
+ */
+void MailboxStorage::New(std::string const &prefix)
+{
+  entries_.New(prefix + ".messages.db", prefix + ".messages.index.db");
+  ranges_.New(prefix + ".inboxes.db", prefix + ".inboxes.index.db");
+}
+
+/**
+ * Load an existing store, the files are created if they do not already exist
+ *
+ * @param prefix The path prefix of the files of the store
+ */
+void MailboxStorage::Load(std::string const &prefix)
+{
+  entries_.Load(prefix + ".messages.db", prefix + ".messages.index.db", true);
+  ranges_.Load(prefix + ".inboxes.db", prefix + ".inboxes.index.db", true);
+}
+
+bool MailboxStorage::GetRange(Address const &inbox, Range &range)
+{
+  return ranges_.Get(RangeKey(inbox), range);
+}
+
+void MailboxStorage::SetRange(Address const &inbox, Range const &range)
+{
+  if (range.empty())
+  {
+    ranges_.Erase(RangeKey(inbox));
+    return;
+  }
+
+  ranges_.Set(RangeKey(inbox), range);
+}
+
+bool MailboxStorage::Get(Address const &inbox, uint64_t sequence, InboxEntry &entry)
+{
+  return entries_.Get(EntryKey(inbox, sequence), entry);
+}
+
+/**
+ * Write consecutive messages of an inbox to the store
+ *
+ * @param inbox The address of the inbox
+ * @param first The sequence number of the first entry
+ * @param entries The entries to write
+ */
+void MailboxStorage::Store(Address const &inbox, uint64_t first,
+                           std::vector<InboxEntry> const &entries)
+{
+  std::vector<std::pair<storage::ResourceID, InboxEntry>> batch{};
+  batch.reserve(entries.size());
+
+  for (auto const &entry : entries)
+  {
+    batch.emplace_back(EntryKey(inbox, first++), entry);
+  }
+
+  entries_.SetBatch(batch);
+}
+
+void MailboxStorage::Erase(Address const &inbox, Range const &range)
+{
+  entries_.WithLock([this, &inbox, &range]() {
+    for (uint64_t sequence = range.first; sequence < range.next; ++sequence)
+    {
+      entries_.LocklessErase(EntryKey(inbox, sequence));
+    }
+  });
+}
+
+storage::ResourceID MailboxStorage::EntryKey(Address const &inbox, uint64_t sequence)
+{
+  crypto::SHA256 hasher{};
+  hasher.Update(inbox);
+  hasher.Update(reinterpret_cast<uint8_t const *>(&sequence), sizeof(sequence));
+
+  return storage::ResourceID{hasher.Final()};
+}
+
+storage::ResourceID MailboxStorage::RangeKey(Address const &inbox)
+{
+  crypto::SHA256 hasher{};
+  hasher.Update(inbox);
+
+  return storage::ResourceID{hasher.Final()};
+}
+
+}  // namespace messenger
+}  // namespace fetch
@@ -127,6 +127,25 @@ void MessengerAPI::ClearMessages(service::CallContext const &call_context, uint6
   mailbox_.ClearMessages(call_context.sender_address, count);
 }
 
+void MessengerAPI::SendMessages(service::CallContext const & /*call_context*/,
+                                std::vector<Message> msgs)
+{
+  // TODO(private issue AEA-127): Validate sender address
+  mailbox_.SendMessages(std::move(msgs));
+}
+
+MessengerAPI::MessageList MessengerAPI::GetMessagesFrom(service::CallContext const &call_context,
+                                                        Address const &             sender)
+{
+  return mailbox_.GetMessagesFrom(call_context.sender_address, sender);
+}
+
+MessengerAPI::MessageList MessengerAPI::GetMessagesSince(service::CallContext const &call_context,
+                                                         uint64_t                    timestamp)
+{
+  return mailbox_.GetMessagesSince(call_context.sender_address, timestamp);
+}
+
 MessengerAPI::ConstByteArray MessengerAPI::GetAddress() const
 {
   return messenger_endpoint_.GetAddress();
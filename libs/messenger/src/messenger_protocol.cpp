@@ -30,6 +30,9 @@ MessengerProtocol::MessengerProtocol(MessengerAPI *api)
   this->ExposeWithClientContext(SEND_MESSAGE, api, &MessengerAPI::SendMessage);
   this->ExposeWithClientContext(GET_MESSAGES, api, &MessengerAPI::GetMessages);
   this->ExposeWithClientContext(CLEAR_MESSAGES, api, &MessengerAPI::ClearMessages);
+  this->ExposeWithClientContext(SEND_MESSAGES, api, &MessengerAPI::SendMessages);
+  this->ExposeWithClientContext(GET_MESSAGES_FROM, api, &MessengerAPI::GetMessagesFrom);
+  this->ExposeWithClientContext(GET_MESSAGES_SINCE, api, &MessengerAPI::GetMessagesSince);
 
   this->ExposeWithClientContext(FIND_MESSENGERS, api, &MessengerAPI::FindAgents);
   this->ExposeWithClientContext(ADVERTISE, api, &MessengerAPI::Advertise);
@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "messenger/inbox.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::messenger::Inbox;
+using fetch::messenger::MailboxStorage;
+using fetch::messenger::Message;
+
+Message NewMessage(std::string const &sender, std::string const &payload)
+{
+  Message message;
+  message.from.messenger = sender;
+  message.to.messenger   = "inbox";
+  message.payload        = payload;
+  return message;
+}
+
+TEST(MessengerInboxTest, ConcurrentDeliveryKeepsOrderPerSender)
+{
+  Inbox inbox{"inbox"};
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&inbox, i]() {
+      auto const sender = std::to_string(i);
+      for (std::size_t j = 0; j < 250; ++j)
+      {
+        inbox.Push(NewMessage(sender, std::to_string(j)));
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(inbox.size(), 1000);
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    auto const messages = inbox.GetMessagesFrom(std::to_string(i));
+    ASSERT_EQ(messages.size(), 250);
+
+    for (std::size_t j = 0; j < messages.size(); ++j)
+    {
+      EXPECT_EQ(messages[j].payload, std::to_string(j));
+    }
+  }
+}
+
+TEST(MessengerInboxTest, IndexedRetrievalAndClear)
+{
+  Inbox inbox{"inbox"};
+
+  inbox.Push(std::vector<Message>{NewMessage("a", "1"), NewMessage("b", "2")});
+  auto const timestamp = Inbox::Now() + 20;
+
+  // messages which arrive later are never reported as older
+  while (Inbox::Now() < timestamp)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  inbox.Push(NewMessage("a", "3"));
+
+  EXPECT_EQ(inbox.GetMessages().size(), 3);
+  EXPECT_EQ(inbox.GetMessagesFrom("a").size(), 2);
+  EXPECT_EQ(inbox.GetMessagesFrom("c").size(), 0);
+
+  auto const recent = inbox.GetMessagesSince(timestamp);
+  ASSERT_EQ(recent.size(), 1);
+  EXPECT_EQ(recent.front().payload, "3");
+
+  inbox.Clear(1);
+  auto const remaining = inbox.GetMessagesFrom("a");
+  ASSERT_EQ(remaining.size(), 1);
+  EXPECT_EQ(remaining.front().payload, "3");
+  EXPECT_EQ(inbox.GetMessages().front().payload, "2");
+
+  inbox.Clear(10);
+  EXPECT_EQ(inbox.size(), 0);
+  EXPECT_EQ(inbox.GetMessagesFrom("a").size(), 0);
+}
+
+TEST(MessengerInboxTest, StoredInboxIsBoundedAndRestored)
+{
+  auto storage = std::make_shared<MailboxStorage>();
+  storage->New("messenger_inbox_test");
+
+  {
+    Inbox inbox{"inbox", 8, storage};
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+      inbox.Push(NewMessage(std::to_string(i % 3), std::to_string(i)));
+    }
+
+    inbox.Clear(10);
+
+    auto const messages = inbox.GetMessages();
+    ASSERT_EQ(messages.size(), 90);
+    EXPECT_EQ(messages.front().payload, "10");
+    EXPECT_EQ(messages.back().payload, "99");
+  }
+
+  // the messages are restored once the inbox is created again
+  Inbox inbox{"inbox", 8, storage};
+
+  auto const messages = inbox.GetMessages();
+  ASSERT_EQ(messages.size(), 90);
+  EXPECT_EQ(messages.front().payload, "10");
+  EXPECT_EQ(messages.back().payload, "99");
+  EXPECT_EQ(inbox.GetMessagesFrom("0").size(), 30);
+
+  inbox.Erase();
+
+  Inbox erased{"inbox", 8, storage};
+  EXPECT_EQ(erased.size(), 0);
+}
+
+}  // namespace
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/model/batched_predictor.hpp"
+#include "ml/model/dnn_regressor.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+/**
+ * Throughput of single sample requests, all queued at once, served by a batched predictor with a
+ * maximum batch size of B. A batch size of 1 runs one forward pass per request.
+ */
+template <typename T, fetch::math::SizeType B, fetch::math::SizeType I, fetch::math::SizeType H,
+          fetch::math::SizeType O>
+void BM_Batched_Predict(benchmark::State &state)
+{
+  using SizeType      = fetch::math::SizeType;
+  using DataType      = T;
+  using TensorType    = fetch::math::Tensor<DataType>;
+  using ModelType     = fetch::ml::model::DNNRegressor<TensorType>;
+  using PredictorType = fetch::ml::model::BatchedPredictor<TensorType>;
+
+  SizeType const n_requests = 256;
+
+  fetch::ml::model::ModelConfig<DataType> model_config;
+  auto model = std::make_shared<ModelType>(model_config, std::vector<SizeType>{I, H, H, O});
+  model->Compile(fetch::ml::OptimiserType::SGD);
+
+  std::vector<TensorType> inputs(n_requests, TensorType({I, 1}));
+  for (auto &input : inputs)
+  {
+    input.FillUniformRandom();
+  }
+
+  PredictorType predictor(model, B, std::chrono::milliseconds(1));
+
+  std::vector<std::future<TensorType>> results(n_requests);
+  for (auto _ : state)
+  {
+    for (SizeType i = 0; i < n_requests; ++i)
+    {
+      results[i] = predictor.Predict(inputs[i]);
+    }
+
+    for (auto &result : results)
+    {
+      benchmark::DoNotOptimize(result.get());
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n_requests));
+  state.counters["forward_passes"] = static_cast<double>(predictor.batches_run());
+}
+
+// the forward passes are made by the worker of the predictor, so the wall time is measured
+BENCHMARK_TEMPLATE(BM_Batched_Predict, float, 1, 100, 100, 10)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Batched_Predict, float, 8, 100, 100, 10)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Batched_Predict, float, 32, 100, 100, 10)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Batched_Predict, float, 128, 100, 100, 10)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Batched_Predict, float, 1, 1000, 1000, 10)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Batched_Predict, float, 32, 1000, 1000, 10)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Batched_Predict, float, 128, 1000, 1000, 10)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -17,13 +17,18 @@
 //------------------------------------------------------------------------------
 
 #include "math/tensor/tensor.hpp"
+#include "ml/core/graph.hpp"
+#include "ml/ops/activations/dropout.hpp"
+#include "ml/ops/activations/relu.hpp"
 #include "ml/ops/add.hpp"
+#include "ml/ops/convolution_2d.hpp"
 #include "ml/ops/divide.hpp"
 #include "ml/ops/exp.hpp"
 #include "ml/ops/log.hpp"
 #include "ml/ops/matrix_multiply.hpp"
 #include "ml/ops/multiply.hpp"
 #include "ml/ops/ops.hpp"
+#include "ml/ops/placeholder.hpp"
 #include "ml/ops/sqrt.hpp"
 #include "ml/ops/squeeze.hpp"
 #include "ml/ops/subtract.hpp"
@@ -1098,4 +1103,114 @@ BENCHMARK_TEMPLATE(BM_SqueezeBackward, fetch::fixed_point::fp64_t, 2048)
 BENCHMARK_TEMPLATE(BM_SqueezeBackward, fetch::fixed_point::fp64_t, 4096)
     ->Unit(benchmark::kMicrosecond);
 
+template <class T, int C, int H, int B>
+void BM_Convolution2DForward(benchmark::State &state)
+{
+  using TensorType    = typename fetch::math::Tensor<T>;
+  using VecTensorType = typename fetch::ml::ops::Ops<TensorType>::VecTensorType;
+
+  // C input and output channels, an H x H image and 3x3 kernels
+  TensorType input({C, H, H, B});
+  TensorType kernels({C, C, 3, 3, 1});
+  input.FillUniformRandom();
+  kernels.FillUniformRandom();
+
+  VecTensorType inputs;
+  inputs.emplace_back(std::make_shared<TensorType>(input));
+  inputs.emplace_back(std::make_shared<TensorType>(kernels));
+  fetch::ml::ops::Convolution2D<TensorType> conv;
+
+  TensorType output(conv.ComputeOutputShape(inputs));
+
+  for (auto _ : state)
+  {
+    conv.Forward(inputs, output);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Convolution2DForward, float, 16, 32, 8)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Convolution2DForward, float, 64, 32, 8)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Convolution2DForward, double, 16, 32, 8)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Convolution2DForward, double, 64, 32, 8)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Convolution2DForward, fetch::fixed_point::fp64_t, 16, 32, 8)
+    ->Unit(benchmark::kMillisecond);
+
+template <class T, int C, int H, int B>
+void BM_Convolution2DBackward(benchmark::State &state)
+{
+  using TensorType    = typename fetch::math::Tensor<T>;
+  using VecTensorType = typename fetch::ml::ops::Ops<TensorType>::VecTensorType;
+
+  TensorType input({C, H, H, B});
+  TensorType kernels({C, C, 3, 3, 1});
+  input.FillUniformRandom();
+  kernels.FillUniformRandom();
+
+  VecTensorType inputs;
+  inputs.emplace_back(std::make_shared<TensorType>(input));
+  inputs.emplace_back(std::make_shared<TensorType>(kernels));
+  fetch::ml::ops::Convolution2D<TensorType> conv;
+
+  TensorType error(conv.ComputeOutputShape(inputs));
+  error.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    auto gradients = conv.Backward(inputs, error);
+    benchmark::DoNotOptimize(gradients);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Convolution2DBackward, float, 16, 32, 8)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Convolution2DBackward, double, 16, 32, 8)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Convolution2DBackward, fetch::fixed_point::fp64_t, 16, 32, 8)
+    ->Unit(benchmark::kMillisecond);
+
+template <class T, int N, int B, bool FUSE>
+void BM_BiasReluDropoutForward(benchmark::State &state)
+{
+  using TensorType = typename fetch::math::Tensor<T>;
+  using DataType   = typename TensorType::Type;
+
+  // an inference pass of bias add -> relu -> dropout over N features and a batch of B
+  fetch::ml::Graph<TensorType> g;
+  g.template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Input", {});
+  g.template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Bias", {});
+  g.template AddNode<fetch::ml::ops::Add<TensorType>>("Biased", {"Input", "Bias"});
+  g.template AddNode<fetch::ml::ops::Relu<TensorType>>("Relu", {"Biased"});
+  g.template AddNode<fetch::ml::ops::Dropout<TensorType>>("Output", {"Relu"},
+                                                          fetch::math::Type<DataType>("0.5"));
+  g.SetOperatorFusion(FUSE);
+
+  TensorType input({N, B});
+  TensorType bias({N, 1});
+  input.FillUniformRandom();
+  bias.FillUniformRandom();
+  g.SetInput("Bias", bias);
+
+  for (auto _ : state)
+  {
+    g.SetInput("Input", input);
+    auto output = g.Evaluate("Output", false);
+    benchmark::DoNotOptimize(output);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_BiasReluDropoutForward, float, 256, 64, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BiasReluDropoutForward, float, 256, 64, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BiasReluDropoutForward, float, 1024, 256, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BiasReluDropoutForward, float, 1024, 256, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BiasReluDropoutForward, double, 1024, 256, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BiasReluDropoutForward, double, 1024, 256, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BiasReluDropoutForward, fetch::fixed_point::fp64_t, 1024, 256, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BiasReluDropoutForward, fetch::fixed_point::fp64_t, 1024, 256, true)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_MAIN();
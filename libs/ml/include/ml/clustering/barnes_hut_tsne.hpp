@@ -0,0 +1,759 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lfg.hpp"
+#include "math/base_types.hpp"
+#include "math/clustering/vantage_point_tree.hpp"
+#include "math/distance/pairwise_distance.hpp"
+#include "math/standard_functions/abs.hpp"
+#include "math/standard_functions/exp.hpp"
+#include "math/standard_functions/log.hpp"
+#include "math/tensor/tensor.hpp"
+#include "ml/ops/flatten.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace details {
+
+/**
+ * A space partitioning tree (a quadtree in two dimensions, an octree in three) over the points of
+ * the low dimensional embedding. Every cell records the number of points beneath it and their
+ * centre of mass, which allows the repulsive forces of distant groups of points to be approximated
+ * by a single interaction.
+ */
+template <typename T>
+class SpacePartitioningTree
+{
+public:
+  using DataType = T;
+  using SizeType = fetch::math::SizeType;
+
+  static constexpr SizeType INVALID   = std::numeric_limits<SizeType>::max();
+  static constexpr SizeType MAX_DEPTH = 48;
+
+  SpacePartitioningTree(DataType const *points, SizeType num_points, SizeType num_dimensions);
+
+  void ComputeNonEdgeForces(SizeType index, DataType const &theta, DataType *force,
+                            DataType &sum_q) const;
+
+private:
+  struct Cell
+  {
+    SizeType first_child{INVALID};  ///< The children are stored contiguously
+    SizeType point{INVALID};        ///< The point held by a leaf
+    SizeType num_points{0};         ///< The number of points beneath the cell
+  };
+
+  DataType const *Point(SizeType index) const;
+  SizeType        AddCell(DataType const *centre, DataType const *width);
+  void            Insert(SizeType cell, SizeType index, SizeType depth);
+  void            Subdivide(SizeType cell);
+  SizeType        ChildContaining(SizeType cell, DataType const *point) const;
+  void            ComputeNonEdgeForces(SizeType cell, SizeType index, DataType const &theta_sq,
+                                       DataType *force, DataType &sum_q) const;
+
+  DataType const *      points_;
+  SizeType              num_dimensions_;
+  SizeType              num_children_;
+  std::vector<Cell>     cells_{};
+  std::vector<DataType> centres_{};          ///< The centre of each cell
+  std::vector<DataType> widths_{};           ///< The half width of each cell in every dimension
+  std::vector<DataType> centres_of_mass_{};  ///< The centre of mass of the points of each cell
+};
+
+template <typename T>
+constexpr fetch::math::SizeType SpacePartitioningTree<T>::INVALID;
+template <typename T>
+constexpr fetch::math::SizeType SpacePartitioningTree<T>::MAX_DEPTH;
+
+/**
+ * Build the tree
+ *
+ * @param points The packed (row major) points
+ * @param num_points The number of points
+ * @param num_dimensions The number of dimensions of each point
+ */
+template <typename T>
+SpacePartitioningTree<T>::SpacePartitioningTree(DataType const *points, SizeType num_points,
+                                                SizeType num_dimensions)
+  : points_{points}
+  , num_dimensions_{num_dimensions}
+  , num_children_{SizeType{1} << num_dimensions}
+{
+  // the root cell is the bounding box of all of the points
+  std::vector<DataType> lower(num_dimensions_, fetch::math::numeric_max<DataType>());
+  std::vector<DataType> upper(num_dimensions_, fetch::math::numeric_lowest<DataType>());
+
+  for (SizeType i = 0; i < num_points; ++i)
+  {
+    DataType const *point = Point(i);
+    for (SizeType d = 0; d < num_dimensions_; ++d)
+    {
+      lower[d] = std::min(lower[d], point[d]);
+      upper[d] = std::max(upper[d], point[d]);
+    }
+  }
+
+  std::vector<DataType> centre(num_dimensions_);
+  std::vector<DataType> width(num_dimensions_);
+  for (SizeType d = 0; d < num_dimensions_; ++d)
+  {
+    centre[d] = (lower[d] + upper[d]) / DataType{2};
+    width[d]  = ((upper[d] - lower[d]) / DataType{2}) + fetch::math::Type<DataType>("0.00001");
+  }
+
+  AddCell(centre.data(), width.data());
+
+  for (SizeType i = 0; i < num_points; ++i)
+  {
+    Insert(0, i, 0);
+  }
+}
+
+/**
+ * Accumulate the (unnormalised) repulsive force on a point from all of the other points
+ *
+ * @param index The index of the point
+ * @param theta The accuracy of the approximation, zero gives the exact result
+ * @param force The accumulated force, num_dimensions values
+ * @param sum_q The accumulated normalisation term
+ */
+template <typename T>
+void SpacePartitioningTree<T>::ComputeNonEdgeForces(SizeType index, DataType const &theta,
+                                                    DataType *force, DataType &sum_q) const
+{
+  ComputeNonEdgeForces(0, index, theta * theta, force, sum_q);
+}
+
+template <typename T>
+typename SpacePartitioningTree<T>::DataType const *SpacePartitioningTree<T>::Point(
+    SizeType index) const
+{
+  return points_ + (index * num_dimensions_);
+}
+
+template <typename T>
+typename SpacePartitioningTree<T>::SizeType SpacePartitioningTree<T>::AddCell(
+    DataType const *centre, DataType const *width)
+{
+  SizeType const cell = cells_.size();
+
+  cells_.emplace_back();
+  centres_.insert(centres_.end(), centre, centre + num_dimensions_);
+  widths_.insert(widths_.end(), width, width + num_dimensions_);
+  centres_of_mass_.resize(centres_of_mass_.size() + num_dimensions_, DataType{0});
+
+  return cell;
+}
+
+/**
+ * Internal: Add a point to a cell, and recursively to the leaf which contains it
+ */
+template <typename T>
+void SpacePartitioningTree<T>::Insert(SizeType cell, SizeType index, SizeType depth)
+{
+  DataType const *point = Point(index);
+
+  // update the centre of mass with the new point
+  SizeType const  num_points = ++cells_[cell].num_points;
+  DataType const  count      = static_cast<DataType>(num_points);
+  DataType *const mass       = centres_of_mass_.data() + (cell * num_dimensions_);
+  for (SizeType d = 0; d < num_dimensions_; ++d)
+  {
+    mass[d] += (point[d] - mass[d]) / count;
+  }
+
+  if (cells_[cell].first_child == INVALID)
+  {
+    if (cells_[cell].point == INVALID)
+    {
+      cells_[cell].point = index;
+      return;
+    }
+
+    // duplicate points (or points which can no longer be separated) share a leaf
+    DataType const *existing = Point(cells_[cell].point);
+    if ((depth >= MAX_DEPTH) || std::equal(point, point + num_dimensions_, existing))
+    {
+      return;
+    }
+
+    Subdivide(cell);
+  }
+
+  Insert(ChildContaining(cell, point), index, depth + 1);
+}
+
+/**
+ * Internal: Split a leaf into its children, moving the point of the leaf (and any duplicates of it)
+ * into the appropriate child
+ */
+template <typename T>
+void SpacePartitioningTree<T>::Subdivide(SizeType cell)
+{
+  std::vector<DataType> centre(num_dimensions_);
+  std::vector<DataType> width(num_dimensions_);
+
+  SizeType const first_child = cells_.size();
+  for (SizeType child = 0; child < num_children_; ++child)
+  {
+    for (SizeType d = 0; d < num_dimensions_; ++d)
+    {
+      width[d]  = widths_[(cell * num_dimensions_) + d] / DataType{2};
+      centre[d] = ((child >> d) & 1u) ? centres_[(cell * num_dimensions_) + d] + width[d]
+                                      : centres_[(cell * num_dimensions_) + d] - width[d];
+    }
+
+    AddCell(centre.data(), width.data());
+  }
+
+  Cell &parent       = cells_[cell];
+  parent.first_child = first_child;
+
+  SizeType const existing     = parent.point;
+  SizeType const num_existing = parent.num_points - 1;  // the mass of the new point is included
+  parent.point                = INVALID;
+
+  // the duplicates of the existing point all move to the same child
+  SizeType const child = ChildContaining(cell, Point(existing));
+  cells_[child].point  = existing;
+  cells_[child].num_points += num_existing;
+  std::copy(Point(existing), Point(existing) + num_dimensions_,
+            centres_of_mass_.begin() + static_cast<std::ptrdiff_t>(child * num_dimensions_));
+}
+
+template <typename T>
+typename SpacePartitioningTree<T>::SizeType SpacePartitioningTree<T>::ChildContaining(
+    SizeType cell, DataType const *point) const
+{
+  SizeType child = 0;
+  for (SizeType d = 0; d < num_dimensions_; ++d)
+  {
+    if (point[d] > centres_[(cell * num_dimensions_) + d])
+    {
+      child |= SizeType{1} << d;
+    }
+  }
+
+  return cells_[cell].first_child + child;
+}
+
+/**
+ * Internal: Accumulate the repulsive force from the points of a cell, the cell is treated as a
+ * single point when it is a leaf or when it is small compared to its distance from the point
+ */
+template <typename T>
+void SpacePartitioningTree<T>::ComputeNonEdgeForces(SizeType cell_index, SizeType index,
+                                                    DataType const &theta_sq, DataType *force,
+                                                    DataType &sum_q) const
+{
+  Cell const &cell = cells_[cell_index];
+  if (cell.num_points == 0)
+  {
+    return;
+  }
+
+  // the point does not repel itself
+  SizeType num_points = cell.num_points;
+  if (cell.point == index)
+  {
+    --num_points;
+  }
+
+  if (num_points == 0)
+  {
+    return;
+  }
+
+  DataType const *point = Point(index);
+  DataType const *mass  = centres_of_mass_.data() + (cell_index * num_dimensions_);
+  DataType const *width = widths_.data() + (cell_index * num_dimensions_);
+
+  DataType distance_sq{0};
+  DataType max_width{0};
+  for (SizeType d = 0; d < num_dimensions_; ++d)
+  {
+    DataType const diff = point[d] - mass[d];
+    distance_sq += diff * diff;
+    max_width = std::max(max_width, width[d] * DataType{2});
+  }
+
+  bool const is_leaf = cell.first_child == INVALID;
+  if (is_leaf || ((max_width * max_width) < (theta_sq * distance_sq)))
+  {
+    DataType const q    = DataType{1} / (DataType{1} + distance_sq);
+    DataType       mult = static_cast<DataType>(num_points) * q;
+
+    sum_q += mult;
+    mult *= q;
+
+    for (SizeType d = 0; d < num_dimensions_; ++d)
+    {
+      force[d] += mult * (point[d] - mass[d]);
+    }
+
+    return;
+  }
+
+  for (SizeType child = 0; child < num_children_; ++child)
+  {
+    ComputeNonEdgeForces(cell.first_child + child, index, theta_sq, force, sum_q);
+  }
+}
+
+}  // namespace details
+
+/**
+ * Barnes-Hut implementation of the T-SNE clustering algorithm based on the paper:
+ * https://lvdmaaten.github.io/publications/papers/JMLR_2014.pdf
+ *
+ * The input affinities are only computed between each point and its 3 * perplexity nearest
+ * neighbours (found with a vantage point tree), and the repulsive forces between the points of the
+ * embedding are approximated with a space partitioning tree. The cost of an iteration is therefore
+ * O(n log n) in both time and memory, rather than the O(n^2) of the exact TSNE. The interface
+ * matches that of TSNE, the trade off between speed and accuracy is controlled by theta.
+ */
+template <class T>
+class BarnesHutTSNE
+{
+public:
+  using TensorType = T;
+  using DataType   = typename TensorType::Type;
+  using SizeType   = fetch::math::SizeType;
+  using RNG        = fetch::random::LaggedFibonacciGenerator<>;
+
+  static constexpr char const *DESCRIPTOR = "BarnesHutTSNE";
+
+  /// The number of points processed by each parallel task
+  static constexpr SizeType POINTS_PER_TASK = 256;
+
+  BarnesHutTSNE(TensorType const &input_matrix, TensorType const &output_matrix,
+                DataType const &perplexity, DataType const &theta = DefaultTheta())
+    : theta_{theta}
+  {
+    Init(input_matrix, output_matrix, perplexity);
+  }
+
+  BarnesHutTSNE(TensorType const &input_matrix, SizeType const &output_dimensions,
+                DataType const &perplexity, SizeType const &random_seed,
+                DataType const &theta = DefaultTheta())
+    : theta_{theta}
+  {
+    assert(input_matrix.shape().size() >= 2);
+    TensorType output_matrix(
+        {input_matrix.shape().at(input_matrix.shape().size() - 1), output_dimensions});
+    rng_.Seed(random_seed);
+    for (auto &val : output_matrix)
+    {
+      val = rng_.AsType<DataType>();
+    }
+    Init(input_matrix, output_matrix, perplexity);
+  }
+
+  static DataType DefaultTheta()
+  {
+    return fetch::math::Type<DataType>("0.5");
+  }
+
+  /**
+   * i.e. Optimise cost function
+   * @param learning_rate input Learning rate
+   * @param max_iters input Number of optimisation iterations
+   */
+  void Optimise(DataType const &learning_rate, SizeType const &max_iters,
+                DataType const &initial_momentum, DataType const &final_momentum,
+                SizeType const &final_momentum_steps, SizeType const &p_later_correction_iteration)
+  {
+    DataType const min_gain = fetch::math::Type<DataType>("0.01");
+    DataType       momentum = initial_momentum;
+
+    std::vector<DataType> gradient(output_.size());
+    std::vector<DataType> i_y(output_.size(), DataType{0});
+    std::vector<DataType> gains(output_.size(), DataType{1});
+
+    for (SizeType iter{0}; iter < max_iters; iter++)
+    {
+      ComputeGradient(gradient);
+
+      if (iter >= final_momentum_steps)
+      {
+        momentum = final_momentum;
+      }
+
+      for (SizeType i{0}; i < output_.size(); ++i)
+      {
+        if ((gradient[i] > DataType{0}) != (i_y[i] > DataType{0}))
+        {
+          gains[i] = gains[i] + fetch::math::Type<DataType>("0.2");
+        }
+        else
+        {
+          gains[i] = gains[i] * fetch::math::Type<DataType>("0.8");
+        }
+
+        gains[i] = std::max(gains[i], min_gain);
+
+        // i_y = momentum * i_y - learning_rate * (gains * gradient)
+        i_y[i] = (momentum * i_y[i]) - (learning_rate * (gains[i] * gradient[i]));
+        output_[i] += i_y[i];
+      }
+
+      CentreOutput();
+
+      // Later P-values correction
+      if (iter == p_later_correction_iteration)
+      {
+        for (auto &value : values_)
+        {
+          value /= DataType{4};
+        }
+      }
+    }
+  }
+
+  TensorType GetOutputMatrix() const
+  {
+    TensorType ret({num_dimensions_, num_points_});
+    for (SizeType i{0}; i < num_points_; ++i)
+    {
+      for (SizeType d{0}; d < num_dimensions_; ++d)
+      {
+        ret(d, i) = output_[(i * num_dimensions_) + d];
+      }
+    }
+
+    return ret;
+  }
+
+private:
+  /**
+   * i.e. Sets initial values of TSNE and calculates the sparse P values
+   */
+  void Init(TensorType const &input_matrix, TensorType const &output_matrix,
+            DataType const &perplexity)
+  {
+    // Flatten input
+    TensorType input;
+    if (input_matrix.shape().size() != 2)
+    {
+      fetch::ml::ops::Flatten<TensorType> flatten_op;
+      TensorType                          flat_input(
+          flatten_op.ComputeOutputShape({std::make_shared<TensorType>(input_matrix)}));
+      flatten_op.Forward({std::make_shared<TensorType>(input_matrix)}, flat_input);
+      input = flat_input.Transpose();
+    }
+    else
+    {
+      input = input_matrix.Transpose();
+    }
+
+    num_points_     = input.shape().at(0);
+    num_dimensions_ = output_matrix.shape().at(1);
+    assert(output_matrix.shape().at(0) == num_points_);
+    assert(num_dimensions_ < (sizeof(SizeType) * 8));
+
+    output_ = fetch::math::distance::details::PackRows(output_matrix);
+
+    CalculateSparseAffinitiesP(fetch::math::distance::details::PackRows(input), input.shape(1),
+                               perplexity);
+  }
+
+  /**
+   * Finds the nearest neighbour affinities Pj|i with the target perplexity, and the symmetric
+   * (normalised) affinities Pij from them
+   */
+  void CalculateSparseAffinitiesP(std::vector<DataType> points, SizeType num_features,
+                                  DataType const &perplexity)
+  {
+    // each point is only attracted to its 3 * perplexity nearest neighbours
+    auto const target = static_cast<SizeType>(3 * static_cast<double>(perplexity));
+    auto const k      = std::max<SizeType>(std::min(target, num_points_ - 1), 1);
+
+    fetch::math::clustering::VantagePointTree<DataType> const tree{std::move(points),
+                                                                   num_features};
+
+    DataType const tolerance      = fetch::math::Type<DataType>("0.00001");
+    DataType const target_entropy = fetch::math::Log(perplexity);
+
+    std::vector<SizeType> columns(num_points_ * k);
+    std::vector<DataType> values(num_points_ * k);
+
+    ForEachPoint([&](SizeType i) {
+      auto const neighbours = tree.SearchPoint(i, k);
+
+      // the distances are shifted by the nearest one, which does not change the resulting
+      // probabilities but prevents all of them underflowing for isolated points
+      std::vector<DataType> d(neighbours.size());
+      for (SizeType j = 0; j < neighbours.size(); ++j)
+      {
+        columns[(i * k) + j] = neighbours[j].first;
+        d[j] = (neighbours[j].second * neighbours[j].second) -
+               (neighbours[0].second * neighbours[0].second);
+      }
+
+      CalibrateRow(d, values.data() + (i * k), target_entropy, tolerance);
+    });
+
+    Symmetrise(k, columns, values);
+  }
+
+  /**
+   * Binary search for the precision beta = 1 / (2 * sigma^2) which gives the target entropy
+   */
+  void CalibrateRow(std::vector<DataType> const &d, DataType *p, DataType const &target_entropy,
+                    DataType const &tolerance) const
+  {
+    DataType const inf     = fetch::math::numeric_max<DataType>();
+    DataType const neg_inf = fetch::math::numeric_lowest<DataType>();
+
+    DataType beta{1};
+    DataType beta_min = neg_inf;
+    DataType beta_max = inf;
+
+    SizeType const max_tries{50};
+    for (SizeType tries{0}; tries < max_tries; ++tries)
+    {
+      DataType sum_p{0};
+      DataType sum_d_p{0};
+      for (SizeType j = 0; j < d.size(); ++j)
+      {
+        p[j] = fetch::math::Exp(-beta * d[j]);
+        sum_p += p[j];
+        sum_d_p += d[j] * p[j];
+      }
+
+      // entropy = log(sum_p) + beta * sum(d * p) / sum_p
+      DataType const entropy      = fetch::math::Log(sum_p) + ((beta * sum_d_p) / sum_p);
+      DataType const entropy_diff = entropy - target_entropy;
+
+      for (SizeType j = 0; j < d.size(); ++j)
+      {
+        p[j] /= sum_p;
+      }
+
+      if (fetch::math::Abs(entropy_diff) <= tolerance)
+      {
+        break;
+      }
+
+      // If not, increase or decrease precision
+      if (entropy_diff > DataType{0})
+      {
+        beta_min = beta;
+        beta     = (beta_max == inf) ? (beta * DataType{2}) : ((beta + beta_max) / DataType{2});
+      }
+      else
+      {
+        beta_max = beta;
+        beta     = (beta_min == neg_inf) ? (beta / DataType{2}) : ((beta + beta_min) / DataType{2});
+      }
+    }
+  }
+
+  /**
+   * Pij = (Pj|i + Pi|j) / sum(Pij), with early exaggeration, stored as compressed sparse rows
+   */
+  void Symmetrise(SizeType k, std::vector<SizeType> const &columns,
+                  std::vector<DataType> const &values)
+  {
+    // every edge is added to the rows of both of its points
+    std::vector<SizeType> counts(num_points_, k);
+    for (SizeType e = 0; e < columns.size(); ++e)
+    {
+      ++counts[columns[e]];
+    }
+
+    std::vector<SizeType> offsets(num_points_ + 1, 0);
+    for (SizeType i = 0; i < num_points_; ++i)
+    {
+      offsets[i + 1] = offsets[i] + counts[i];
+    }
+
+    std::vector<std::pair<SizeType, DataType>> edges(offsets.back());
+    std::vector<SizeType>                      next(offsets.begin(), offsets.end() - 1);
+    for (SizeType i = 0; i < num_points_; ++i)
+    {
+      for (SizeType e = i * k; e < ((i + 1) * k); ++e)
+      {
+        edges[next[i]++]          = {columns[e], values[e]};
+        edges[next[columns[e]]++] = {i, values[e]};
+      }
+    }
+
+    // merge the duplicate edges of each row
+    row_offsets_.assign(1, 0);
+    columns_.clear();
+    values_.clear();
+    columns_.reserve(edges.size());
+    values_.reserve(edges.size());
+
+    DataType sum{0};
+    for (SizeType i = 0; i < num_points_; ++i)
+    {
+      auto const begin = edges.begin() + static_cast<std::ptrdiff_t>(offsets[i]);
+      auto const end   = edges.begin() + static_cast<std::ptrdiff_t>(offsets[i + 1]);
+      std::sort(begin, end, [](auto const &a, auto const &b) { return a.first < b.first; });
+
+      for (auto it = begin; it != end; ++it)
+      {
+        if ((columns_.size() > row_offsets_.back()) && (columns_.back() == it->first))
+        {
+          values_.back() += it->second;
+        }
+        else
+        {
+          columns_.push_back(it->first);
+          values_.push_back(it->second);
+        }
+
+        sum += it->second;
+      }
+
+      row_offsets_.push_back(columns_.size());
+    }
+
+    // early exaggeration
+    DataType const scale = DataType{4} / sum;
+    for (auto &value : values_)
+    {
+      value *= scale;
+    }
+  }
+
+  /**
+   * i.e. Calculates the gradient of the Kullback-Leibler divergence between P and the Student-t
+   * based joint probability distribution Q. The attractive forces are computed exactly from the
+   * sparse P values and the repulsive forces are approximated with the space partitioning tree.
+   */
+  void ComputeGradient(std::vector<DataType> &gradient) const
+  {
+    details::SpacePartitioningTree<DataType> const tree{output_.data(), num_points_,
+                                                        num_dimensions_};
+
+    std::vector<DataType> negative(output_.size(), DataType{0});
+    std::vector<DataType> sum_q(num_points_, DataType{0});
+
+    ForEachPoint([&](SizeType i) {
+      DataType const *y_i = output_.data() + (i * num_dimensions_);
+      DataType *      pos = gradient.data() + (i * num_dimensions_);
+      DataType *      neg = negative.data() + (i * num_dimensions_);
+
+      std::fill(pos, pos + num_dimensions_, DataType{0});
+
+      // attractive forces
+      for (SizeType e = row_offsets_[i]; e < row_offsets_[i + 1]; ++e)
+      {
+        DataType const *y_j = output_.data() + (columns_[e] * num_dimensions_);
+
+        DataType const distance_sq =
+            fetch::math::distance::details::SquareDistanceKernel(y_i, y_j, num_dimensions_);
+        DataType const mult = values_[e] / (DataType{1} + distance_sq);
+
+        for (SizeType d = 0; d < num_dimensions_; ++d)
+        {
+          pos[d] += mult * (y_i[d] - y_j[d]);
+        }
+      }
+
+      // repulsive forces
+      tree.ComputeNonEdgeForces(i, theta_, neg, sum_q[i]);
+    });
+
+    // the normalisation is summed in a fixed order so that the result does not depend on the
+    // number of threads
+    DataType total_q{0};
+    for (auto const &value : sum_q)
+    {
+      total_q += value;
+    }
+
+    for (SizeType i = 0; i < gradient.size(); ++i)
+    {
+      gradient[i] -= negative[i] / total_q;
+    }
+  }
+
+  void CentreOutput()
+  {
+    std::vector<DataType> mean(num_dimensions_, DataType{0});
+    for (SizeType i = 0; i < num_points_; ++i)
+    {
+      for (SizeType d = 0; d < num_dimensions_; ++d)
+      {
+        mean[d] += output_[(i * num_dimensions_) + d];
+      }
+    }
+
+    for (SizeType d = 0; d < num_dimensions_; ++d)
+    {
+      mean[d] /= static_cast<DataType>(num_points_);
+    }
+
+    for (SizeType i = 0; i < num_points_; ++i)
+    {
+      for (SizeType d = 0; d < num_dimensions_; ++d)
+      {
+        output_[(i * num_dimensions_) + d] -= mean[d];
+      }
+    }
+  }
+
+  /**
+   * Apply a function to every point, sharing blocks of points between the pairwise thread pool
+   */
+  template <typename F>
+  void ForEachPoint(F const &f) const
+  {
+    SizeType const num_tasks = (num_points_ + POINTS_PER_TASK - 1) / POINTS_PER_TASK;
+
+    fetch::math::distance::details::ParallelPairWiseTasks(
+        num_tasks, fetch::math::distance::PairWiseConcurrency(), [&](std::size_t task) {
+          SizeType const begin = task * POINTS_PER_TASK;
+          SizeType const end   = std::min(begin + POINTS_PER_TASK, num_points_);
+
+          for (SizeType i = begin; i < end; ++i)
+          {
+            f(i);
+          }
+        });
+  }
+
+  DataType              theta_;
+  SizeType              num_points_{0};
+  SizeType              num_dimensions_{0};
+  std::vector<DataType> output_{};  ///< The embedding, packed row major
+  std::vector<SizeType> row_offsets_{};
+  std::vector<SizeType> columns_{};
+  std::vector<DataType> values_{};  ///< The sparse symmetric P values
+  RNG                   rng_;
+};
+
+template <class T>
+constexpr fetch::math::SizeType BarnesHutTSNE<T>::POINTS_PER_TASK;
+
+}  // namespace ml
+}  // namespace fetch
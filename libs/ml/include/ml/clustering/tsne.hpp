@@ -32,7 +32,9 @@
 #include "meta/type_traits.hpp"
 #include "ml/ops/flatten.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace fetch {
 namespace ml {
@@ -431,9 +433,13 @@ private:
 
     TensorType ret(output_matrix.shape());
 
+    SizeType const        num_dimensions = output_matrix.shape().at(1);
+    std::vector<DataType> output(num_dimensions);
+
     for (SizeType i{0}; i < output_matrix.shape().at(0); i++)
     {
-      TensorType output(output_matrix.shape().at(1));
+      std::fill(output.begin(), output.end(), DataType{0});
+
       for (SizeType j{0}; j < output_matrix.shape().at(0); j++)
       {
         if (i == j)
@@ -453,19 +459,16 @@ private:
         fetch::math::Multiply(num.At(i, j), val, val);
 
         // val*(yi-yj), where val=(Pij-Qij)/(1+||yi-yj||^2)
-
-        TensorType diff = (output_matrix.Slice(j).Copy()) - (output_matrix.Slice(i).Copy());
-
-        SizeVector shape = diff.shape();
-        shape.erase(shape.begin());
-        diff.Reshape(shape);
-
-        output += Multiply(val, diff);
+        // (accumulated directly rather than through temporary slices of the output matrix)
+        for (SizeType k = 0; k < num_dimensions; k++)
+        {
+          output[k] += val * (output_matrix.At(j, k) - output_matrix.At(i, k));
+        }
       }
 
-      for (SizeType k = 0; k < output_matrix.shape().at(1); k++)
+      for (SizeType k = 0; k < num_dimensions; k++)
       {
-        ret(i, k) = fetch::math::Multiply(static_cast<DataType>(-1), output.At(k));
+        ret(i, k) = fetch::math::Multiply(static_cast<DataType>(-1), output[k]);
       }
     }
 
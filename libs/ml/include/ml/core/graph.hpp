@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "ml/core/memory_planner.hpp"
 #include "ml/core/node.hpp"
 #include "ml/meta/ml_type_traits.hpp"
 #include "ml/ops/weights.hpp"
@@ -94,6 +95,8 @@ public:
   using SPType           = GraphSaveableParams<TensorType>;
   using OpPtrType        = std::shared_ptr<fetch::ml::ops::Ops<TensorType>>;
 
+  using SparseGradientType = utilities::SparseGradient<TensorType>;
+
   static constexpr char const *DESCRIPTOR = "Graph";
 
   virtual ~Graph() = default;
@@ -121,6 +124,11 @@ public:
   void SetFrozenState(bool frozen_state);
   bool SetFrozenState(std::string const &node_name, bool frozen_state);
 
+  void SetMemoryPlanning(bool memory_planning);
+  typename MemoryPlanner<TensorType>::Statistics const &GetMemoryPlanningStatistics() const;
+
+  void SetOperatorFusion(bool operator_fusion);
+
   ///////////////////////////////////
   /// public train/test functions ///
   ///////////////////////////////////
@@ -130,6 +138,7 @@ public:
   void       BackPropagate(std::string const &node_name, TensorType const &error_signal = {});
   void       ApplyGradients(std::vector<TensorType> &grad);
   void       ApplySparseGradients(std::vector<TensorType> &grad, std::vector<SizeSet> &update_rows);
+  void       ApplySparseGradients(std::vector<SparseGradientType> &updates);
 
   //////////////////////////////////////////////////////
   /// public serialisation & weight export functions ///
@@ -145,13 +154,16 @@ public:
   /// public setters and accessors ///
   ////////////////////////////////////
 
-  NodePtrType                   GetNode(std::string const &node_name) const;
-  std::vector<TensorType>       GetWeightsReferences() const;
-  std::vector<TensorType>       GetWeights() const;
-  std::vector<TensorType>       GetGradientsReferences() const;
-  std::vector<SizeSet>          GetUpdatedRowsReferences() const;
-  std::vector<TensorType>       GetGradients() const;
-  std::vector<TrainablePtrType> GetTrainables();
+  NodePtrType                     GetNode(std::string const &node_name) const;
+  std::vector<TensorType>         GetWeightsReferences() const;
+  std::vector<TensorType>         GetWeights() const;
+  std::vector<TensorType>         GetGradientsReferences() const;
+  std::vector<SizeSet>            GetUpdatedRowsReferences() const;
+  std::vector<TensorType>         GetGradients() const;
+  std::vector<SparseGradientType> GetSparseGradients() const;
+  std::vector<TrainablePtrType>   GetTrainables();
+  std::vector<std::string>        GetTrainableNames() const;
+  void                            SetWeightsReferences(std::vector<TensorType> const &weights);
 
   ////////////////////////////////////
   /// public gradient manipulation ///
@@ -168,9 +180,15 @@ protected:
   void       InsertSharedCopy(std::shared_ptr<Graph<TensorType>> output_ptr);
   TensorType ForwardPropagate(std::string const &node_name, bool is_training = true);
 
+  std::shared_ptr<TensorType> EvaluateNode(NodePtrType const &node, bool is_training);
+
 private:
   GraphState graph_state_ = GraphState::NOT_COMPILED;
 
+  bool                      memory_planning_ = false;
+  MemoryPlanner<TensorType> memory_planner_;
+  bool                      operator_fusion_ = false;
+
   friend class optimisers::Optimiser<TensorType>;
   friend class model::ModelInterface<TensorType>;
   friend class dmlf::collective_learning::ClientAlgorithm<TensorType>;
@@ -182,6 +200,7 @@ private:
   bool UpdateVariableName(std::string const &name, std::string &ret);
 
   void LinkNodesInGraph(std::string const &node_name, std::vector<std::string> const &inputs);
+  void FuseOperators();
 
   template <class OperationType, typename... Params>
   meta::IfIsShareable<TensorType, OperationType, NodePtrType> DuplicateNode(
@@ -199,16 +218,24 @@ private:
 
   void StateDict(fetch::ml::StateDict<TensorType> &state_dict);
   void GetTrainables(std::vector<TrainablePtrType> &ret);
+  void GetTrainableNames(std::vector<std::string> &ret, std::string const &prefix) const;
   void GetWeightsReferences(std::vector<TensorType> &ret) const;
   void GetGradientsReferences(std::vector<TensorType> &ret) const;
   void GetUpdatedRowsReferences(std::vector<SizeSet> &ret) const;
+  void GetSparseGradients(std::vector<SparseGradientType> &ret) const;
 
   template <typename TensorIteratorType>
   void ApplyGradients(TensorIteratorType &grad_it);
 
+  template <typename TensorIteratorType>
+  void ShareWeights(TensorIteratorType &weights_it);
+
   template <typename TensorIteratorType, typename VectorIteratorType>
   void ApplySparseGradients(TensorIteratorType &grad_it, VectorIteratorType &rows_it);
 
+  template <typename SparseIteratorType>
+  void ApplySparseGradients(SparseIteratorType &update_it);
+
   template <typename ValType, typename NodeFunc, typename GraphFunc>
   void RecursiveApply(ValType &val, NodeFunc node_func, GraphFunc graph_func) const;
 
@@ -285,6 +312,7 @@ template <typename TensorType>
 void Graph<TensorType>::ResetCompile()
 {
   graph_state_ = GraphState::NOT_COMPILED;
+  memory_planner_.Reset();
 
   for (auto &connection : connections_)
   {
@@ -328,6 +356,7 @@ void Graph<TensorType>::Compile()
       auto node_inputs = connection.second;
       LinkNodesInGraph(node_name, node_inputs);
     }
+    FuseOperators();
 
     // TODO(1467) - implement validity checks on graph compilation - e.g. loss function should not
     // appear in middle of graph
@@ -347,6 +376,7 @@ void Graph<TensorType>::Compile()
   }
   }
 }
+
 /**
  * Appends op to map of trainable nodes, called by
  * @tparam TensorType
@@ -433,7 +463,7 @@ TensorType Graph<TensorType>::ForwardImplementation(std::string const &node_name
     case GraphState::UPDATED:
     {
       graph_state_ = GraphState::EVALUATED;
-      auto ret     = (*(nodes_[node_name]->Evaluate(is_training)));
+      auto ret     = (*(EvaluateNode(nodes_[node_name], is_training)));
       if (evaluate_mode)
       {
         return ret.Copy();
@@ -452,6 +482,24 @@ TensorType Graph<TensorType>::ForwardImplementation(std::string const &node_name
   }
 }
 
+/**
+ * Evaluates a single node of the graph, planning the memory of the forward pass if enabled
+ * @tparam TensorType
+ * @param node the node to evaluate
+ * @param is_training
+ * @return a shallow copy of the output of the node
+ */
+template <typename TensorType>
+std::shared_ptr<TensorType> Graph<TensorType>::EvaluateNode(NodePtrType const &node,
+                                                            bool               is_training)
+{
+  if (memory_planning_ && !is_training && !node->HasValidCache())
+  {
+    return memory_planner_.Evaluate(node, is_training);
+  }
+  return node->Evaluate(is_training);
+}
+
 /**
  * Backpropagate given error signal through the graph
  * If no error signal is given, an empty error signal is used
@@ -587,6 +635,72 @@ bool Graph<TensorType>::SetFrozenState(std::string const &node_name, bool frozen
   return true;
 }
 
+/**
+ * Enables or disables memory planning of inference passes for this graph and any subgraphs.
+ * When enabled, the intermediate outputs of a forward pass which is not training share a pool of
+ * reusable buffers and are released as soon as they have been consumed, so only the output of the
+ * evaluated node is kept afterwards.
+ * @tparam TensorType
+ * @param memory_planning true=plan memory, false=cache every output (the default)
+ */
+template <typename TensorType>
+void Graph<TensorType>::SetMemoryPlanning(bool memory_planning)
+{
+  memory_planning_ = memory_planning;
+  memory_planner_.Reset();
+
+  for (auto &node : nodes_)
+  {
+    auto graph_ptr = std::dynamic_pointer_cast<Graph<TensorType>>(node.second->GetOp());
+    if (graph_ptr)
+    {
+      graph_ptr->SetMemoryPlanning(memory_planning);
+    }
+  }
+}
+
+/**
+ * Returns the statistics of the most recent planned forward pass of this graph
+ * @tparam TensorType
+ * @return
+ */
+template <typename TensorType>
+typename MemoryPlanner<TensorType>::Statistics const &
+Graph<TensorType>::GetMemoryPlanningStatistics() const
+{
+  return memory_planner_.GetStatistics();
+}
+
+/**
+ * Enables or disables operator fusion for this graph and any subgraphs. When enabled, each chain
+ * of elementwise operations (e.g. bias add -> activation -> dropout) in which every intermediate
+ * output is consumed only by the next operation is evaluated as a single pass over the output when
+ * not training, without computing the intermediate outputs. Training passes are unaffected since
+ * back propagation needs every output.
+ * @tparam TensorType
+ * @param operator_fusion true=fuse elementwise chains, false=evaluate each node (the default)
+ */
+template <typename TensorType>
+void Graph<TensorType>::SetOperatorFusion(bool operator_fusion)
+{
+  operator_fusion_ = operator_fusion;
+  memory_planner_.Reset();
+
+  for (auto &node : nodes_)
+  {
+    auto graph_ptr = std::dynamic_pointer_cast<Graph<TensorType>>(node.second->GetOp());
+    if (graph_ptr)
+    {
+      graph_ptr->SetOperatorFusion(operator_fusion);
+    }
+  }
+
+  if (graph_state_ != GraphState::NOT_COMPILED && graph_state_ != GraphState::INVALID)
+  {
+    FuseOperators();
+  }
+}
+
 /**
  * Add gradient values to weight for each trainable
  * @param grad vector of gradient values for each trainable stored in TensorType
@@ -681,6 +795,52 @@ void Graph<TensorType>::ApplySparseGradients(std::vector<TensorType> &grad,
   }
 }
 
+/**
+ * Add compact row sparse gradient values to weight for each trainable
+ * @tparam TensorType
+ * @param updates vector of gradient updates for each trainable, see utilities::SparseGradient
+ */
+template <typename TensorType>
+void Graph<TensorType>::ApplySparseGradients(std::vector<SparseGradientType> &updates)
+{
+  Compile();
+
+  switch (graph_state_)
+  {
+  case GraphState::INVALID:
+  case GraphState::NOT_COMPILED:
+  case GraphState::COMPILED:
+  case GraphState::EVALUATED:
+  {
+    throw ml::exceptions::InvalidMode(
+        "cannot apply gradients: backpropagate not previously called on graph");
+  }
+  case GraphState::BACKWARD:
+  {
+    auto update_it = updates.begin();
+    ApplySparseGradients(update_it);
+
+    // TODO(#1554) - we should only reset the cache for trained nodes, not all nodes
+    // reset cache on all nodes
+    for (auto const &t : nodes_)
+    {
+      ResetGraphCache(false, t.second);
+    }
+
+    return;
+  }
+  case GraphState::UPDATED:
+  {
+    // no gradients to apply - nothing to do
+    return;
+  }
+  default:
+  {
+    throw ml::exceptions::InvalidMode("cannot apply gradients: unrecognised graph state");
+  }
+  }
+}
+
 /**
  * Method for directly inserting nodes to graph - used for serialisation
  * @tparam T
@@ -692,6 +852,7 @@ bool Graph<T>::InsertNode(std::string const &node_name, NodePtrType node_ptr)
 {
   // put node in look up table
   nodes_[node_name] = node_ptr;
+  memory_planner_.Reset();
   return nodes_.find(node_name) != nodes_.end();
 }
 
@@ -728,12 +889,14 @@ void Graph<TensorType>::SetGraphSaveableParams(GraphSaveableParams<TensorType> c
   assert(nodes_.size() == sp.connections.size());
 
   connections_ = sp.connections;
+  memory_planner_.Reset();
 
   // assign inputs and outputs to the nodes
   for (auto &node : sp.connections)
   {
     LinkNodesInGraph(node.first, node.second);
   }
+  FuseOperators();
 
   graph_state_ = static_cast<GraphState>(sp.graph_state);
 
@@ -982,6 +1145,21 @@ std::vector<TensorType> Graph<TensorType>::GetGradients() const
   return ret;
 }
 
+/**
+ * Exports the accumulated gradients of every trainable in compact row sparse form, so that only
+ * the updated rows of large tensors such as embedding tables are copied
+ * @tparam TensorType
+ * @return ret is vector containing the gradient of each trainable
+ */
+template <typename TensorType>
+std::vector<typename Graph<TensorType>::SparseGradientType> Graph<TensorType>::GetSparseGradients()
+    const
+{
+  std::vector<SparseGradientType> ret;
+  GetSparseGradients(ret);
+  return ret;
+}
+
 /**
  * Sets all accumulated gradients for each trainable to zero
  * @tparam TensorType
@@ -1004,6 +1182,65 @@ void Graph<TensorType>::ResetGradients()
  * @param inputs
  * @param unlink
  */
+/**
+ * Finds the chains of elementwise nodes to be evaluated together and registers each chain with
+ * its final node. Must be called after the nodes have been linked.
+ * @tparam TensorType
+ */
+template <typename TensorType>
+void Graph<TensorType>::FuseOperators()
+{
+  for (auto &node : nodes_)
+  {
+    node.second->SetFusedNodes({});
+  }
+
+  if (!operator_fusion_)
+  {
+    return;
+  }
+
+  // a node continues a chain if it is elementwise and its only input is an elementwise node whose
+  // output is not needed by anything else
+  auto continues_chain = [](NodePtrType const &node) {
+    if (!node->GetOp()->IsElementwise())
+    {
+      return false;
+    }
+
+    auto const inputs = node->GetInputs();
+    return (inputs.size() == 1) && inputs.front()->GetOp()->IsElementwise() &&
+           (inputs.front()->GetOutputs().size() == 1);
+  };
+
+  for (auto &node : nodes_)
+  {
+    NodePtrType const &tail = node.second;
+    if (!continues_chain(tail))
+    {
+      continue;
+    }
+
+    // only the last node of each chain is fused
+    auto const &outputs = tail->GetOutputs();
+    if ((outputs.size() == 1) && continues_chain(outputs.front().lock()))
+    {
+      continue;
+    }
+
+    std::vector<typename Node<TensorType>::NodeWeakPtrType> chain{};
+    NodePtrType                                              current = tail;
+    while (continues_chain(current))
+    {
+      current = current->GetInputs().front();
+      chain.emplace_back(current);
+    }
+
+    std::reverse(chain.begin(), chain.end());
+    tail->SetFusedNodes(std::move(chain));
+  }
+}
+
 template <typename TensorType>
 void Graph<TensorType>::LinkNodesInGraph(std::string const &             node_name,
                                          std::vector<std::string> const &inputs)
@@ -1067,6 +1304,39 @@ std::vector<typename Graph<TensorType>::TrainablePtrType> Graph<TensorType>::Get
   return ret;
 }
 
+/**
+ * Names of all trainables, in the order of GetWeightsReferences. The names of trainables in
+ * subgraphs are prefixed by the name of the subgraph node, e.g. "Encoder/FC_Weights"
+ * @return ret is vector containing the names of all trainables
+ */
+template <typename TensorType>
+std::vector<std::string> Graph<TensorType>::GetTrainableNames() const
+{
+  std::vector<std::string> ret;
+  GetTrainableNames(ret, "");
+  return ret;
+}
+
+/**
+ * Replaces the weights of all trainables by the given tensors without copying them, so that the
+ * trainables share their storage
+ * @param weights vector of weights for each trainable, in the order of GetWeightsReferences
+ */
+template <typename TensorType>
+void Graph<TensorType>::SetWeightsReferences(std::vector<TensorType> const &weights)
+{
+  if (weights.size() != GetTrainableNames().size())
+  {
+    throw ml::exceptions::InvalidInput("number of weights does not match number of trainables");
+  }
+
+  auto weights_it = weights.begin();
+  ShareWeights(weights_it);
+
+  // the shapes of the weights may have changed
+  ResetGraphCache(true);
+}
+
 /**
  * Inserts a copy of the graph (with shared op ptrs where appropriate) into output_ptr
  * @tparam T
@@ -1187,6 +1457,34 @@ void Graph<TensorType>::GetUpdatedRowsReferences(std::vector<SizeSet> &ret) cons
       &Graph<TensorType>::GetUpdatedRowsReferences);
 }
 
+template <typename TensorType>
+void Graph<TensorType>::GetSparseGradients(std::vector<SparseGradientType> &ret) const
+{
+  using ret_type             = std::vector<SparseGradientType>;
+  using node_func_signature  = SparseGradientType (ops::Trainable<TensorType>::*)() const;
+  using graph_func_signature = void (Graph<TensorType>::*)(ret_type &) const;
+
+  RecursiveApply<ret_type, node_func_signature, graph_func_signature>(
+      ret, &ops::Trainable<TensorType>::GetSparseGradients, &Graph<TensorType>::GetSparseGradients);
+}
+
+template <typename TensorType>
+template <typename SparseIteratorType>
+void Graph<TensorType>::ApplySparseGradients(SparseIteratorType &update_it)
+{
+  using graph_func_signature = void (Graph<TensorType>::*)(SparseIteratorType &);
+
+  for (auto const &t : trainable_lookup_)
+  {
+    auto trainable_ptr = std::dynamic_pointer_cast<ops::Trainable<TensorType>>(t.second->GetOp());
+    trainable_ptr->ApplySparseGradient(*update_it);
+    ++update_it;
+  }
+
+  RecursiveApply<SparseIteratorType, graph_func_signature>(
+      update_it, &Graph<TensorType>::ApplySparseGradients);
+}
+
 template <typename TensorType>
 template <typename TensorIteratorType, typename VectorIteratorType>
 void Graph<TensorType>::ApplySparseGradients(TensorIteratorType &grad_it,
@@ -1224,6 +1522,45 @@ void Graph<TensorType>::ApplyGradients(TensorIteratorType &grad_it)
                                                            &Graph<TensorType>::ApplyGradients);
 }
 
+template <typename TensorType>
+void Graph<TensorType>::GetTrainableNames(std::vector<std::string> &ret,
+                                          std::string const &       prefix) const
+{
+  for (auto const &t : trainable_lookup_)
+  {
+    ret.emplace_back(prefix + t.first);
+  }
+
+  for (auto const &node_pair : nodes_)
+  {
+    auto graph_ptr = std::dynamic_pointer_cast<Graph<TensorType>>(node_pair.second->GetOp());
+    if (graph_ptr)
+    {
+      graph_ptr->GetTrainableNames(ret, prefix + node_pair.first + "/");
+    }
+  }
+}
+
+template <typename TensorType>
+template <typename TensorIteratorType>
+void Graph<TensorType>::ShareWeights(TensorIteratorType &weights_it)
+{
+  using graph_func_signature = void (Graph<TensorType>::*)(TensorIteratorType &);
+
+  for (auto const &t : trainable_lookup_)
+  {
+    auto trainable_ptr = std::dynamic_pointer_cast<ops::Trainable<TensorType>>(t.second->GetOp());
+
+    fetch::ml::StateDict<TensorType> dict;
+    dict.weights_ = std::make_shared<TensorType>(*weights_it);
+    trainable_ptr->LoadStateDict(dict);
+    ++weights_it;
+  }
+
+  RecursiveApply<TensorIteratorType, graph_func_signature>(weights_it,
+                                                           &Graph<TensorType>::ShareWeights);
+}
+
 /**
  * RecursiveApply is used to apply a function to all trainables and collect the results,
  * and then recursively invoke this function for any nodes which are graphs. Using this
@@ -0,0 +1,406 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/core/node.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+
+/**
+ * Plans the memory used by the intermediate outputs of a forward pass.
+ *
+ * The nodes required to compute a target are sorted topologically once, after which each forward
+ * pass evaluates them in that order. Every node writes its output into a buffer taken from an
+ * arena of tensors (keyed by shape) and, as soon as the last consumer of an output has been
+ * evaluated, the buffer is returned to the arena and reused by the nodes that follow. Operations
+ * which support it write their output over an input which has no other remaining consumers.
+ *
+ * A node which has been fused with a chain of elementwise nodes is evaluated directly from the
+ * inputs of the first node of the chain, so the other nodes of the chain are never planned.
+ *
+ * Only the output of the target is retained after a pass, therefore the planner must not be used
+ * when the intermediate outputs are still needed, i.e. for back propagation.
+ * @tparam TensorType
+ */
+template <typename TensorType>
+class MemoryPlanner
+{
+public:
+  using SizeType    = fetch::math::SizeType;
+  using NodeType    = Node<TensorType>;
+  using NodePtrType = std::shared_ptr<NodeType>;
+  using ShapeType   = std::vector<SizeType>;
+
+  struct Statistics
+  {
+    SizeType num_buffers{0};    ///< The number of tensors allocated by the arena
+    SizeType arena_size{0};     ///< The total number of elements allocated by the arena
+    SizeType peak_size{0};      ///< The maximum number of elements in use during the last pass
+    SizeType num_evaluated{0};  ///< The number of nodes evaluated by the last pass
+    SizeType num_in_place{0};   ///< The number of nodes evaluated in place by the last pass
+  };
+
+  MemoryPlanner() = default;
+  MemoryPlanner(MemoryPlanner const &other);
+  ~MemoryPlanner() = default;
+
+  MemoryPlanner &operator=(MemoryPlanner const &other);
+
+  std::shared_ptr<TensorType> Evaluate(NodePtrType const &target, bool is_training);
+  void                        Reset();
+
+  Statistics const &GetStatistics() const;
+
+private:
+  using NodeSet     = std::unordered_set<NodeType *>;
+  using CountMap    = std::unordered_map<NodeType *, SizeType>;
+  using BufferMap   = std::unordered_map<NodeType *, TensorType>;
+  using FreeListMap = std::map<ShapeType, std::vector<TensorType>>;
+
+  void Plan(NodePtrType const &target);
+  void Visit(NodePtrType const &node, NodeSet &visited);
+  void Execute(bool is_training);
+  void Compute(NodePtrType const &node, bool is_training);
+  void Consume(NodeType *node);
+  void Release(NodeType *node);
+
+  static std::vector<NodePtrType> GetInputs(NodeType const &node);
+
+  TensorType Acquire(ShapeType const &shape);
+  void       Recycle(TensorType const &buffer);
+
+  NodePtrType              target_{};
+  std::vector<NodePtrType> order_{};      ///< The ancestors of the target in topological order
+  CountMap                 consumers_{};  ///< The number of outstanding uses of each output
+  BufferMap                buffers_{};    ///< The arena buffers currently held by each node
+  NodeSet                  deferred_{};   ///< Nodes whose output aliases rather than uses a buffer
+  FreeListMap              free_{};
+  SizeType                 live_size_{0};
+  Statistics               statistics_{};
+};
+
+/**
+ * Copies of a planner start without a plan since the plan refers to the nodes of another graph
+ */
+template <typename TensorType>
+MemoryPlanner<TensorType>::MemoryPlanner(MemoryPlanner const & /*other*/)
+{}
+
+template <typename TensorType>
+MemoryPlanner<TensorType> &MemoryPlanner<TensorType>::operator=(MemoryPlanner const &other)
+{
+  if (this != &other)
+  {
+    Reset();
+  }
+  return *this;
+}
+
+/**
+ * Evaluates the target node, computing any of its ancestors which do not have a valid output
+ * @param target the node to evaluate
+ * @param is_training whether the forward pass is in training mode
+ * @return the output of the target, which remains valid until the next call
+ */
+template <typename TensorType>
+std::shared_ptr<TensorType> MemoryPlanner<TensorType>::Evaluate(NodePtrType const &target,
+                                                                bool               is_training)
+{
+  if (target != target_)
+  {
+    Plan(target);
+  }
+  else if ((buffers_.find(target_.get()) != buffers_.end()) ||
+           (deferred_.find(target_.get()) != deferred_.end()))
+  {
+    // the output of the previous pass is about to be replaced
+    Release(target_.get());
+  }
+
+  try
+  {
+    Execute(is_training);
+  }
+  catch (...)
+  {
+    // the nodes keep whatever buffers they were given, the arena simply stops tracking them
+    Reset();
+    throw;
+  }
+
+  return target->Evaluate(is_training);
+}
+
+/**
+ * Drops the plan and the arena. The nodes retain the buffers they currently hold.
+ */
+template <typename TensorType>
+void MemoryPlanner<TensorType>::Reset()
+{
+  target_.reset();
+  order_.clear();
+  consumers_.clear();
+  buffers_.clear();
+  deferred_.clear();
+  free_.clear();
+  live_size_  = 0;
+  statistics_ = Statistics{};
+}
+
+template <typename TensorType>
+typename MemoryPlanner<TensorType>::Statistics const &MemoryPlanner<TensorType>::GetStatistics()
+    const
+{
+  return statistics_;
+}
+
+/**
+ * Sorts the ancestors of the target in topological order
+ * @param target the node to be evaluated
+ */
+template <typename TensorType>
+void MemoryPlanner<TensorType>::Plan(NodePtrType const &target)
+{
+  Reset();
+  target_ = target;
+
+  NodeSet visited{};
+  Visit(target_, visited);
+}
+
+template <typename TensorType>
+void MemoryPlanner<TensorType>::Visit(NodePtrType const &node, NodeSet &visited)
+{
+  if (!visited.insert(node.get()).second)
+  {
+    return;
+  }
+
+  for (auto const &input : GetInputs(*node))
+  {
+    Visit(input, visited);
+  }
+
+  order_.emplace_back(node);
+}
+
+/**
+ * Computes every node of the plan which does not already have a valid output. Placeholders,
+ * weights and other nodes without inputs hold their own data and are never planned.
+ */
+template <typename TensorType>
+void MemoryPlanner<TensorType>::Execute(bool is_training)
+{
+  consumers_.clear();
+
+  std::vector<NodePtrType> pending{};
+  for (auto const &node : order_)
+  {
+    if (!GetInputs(*node).empty() && !node->HasValidCache())
+    {
+      pending.emplace_back(node);
+      consumers_[node.get()] = 0;
+    }
+  }
+
+  for (auto const &node : pending)
+  {
+    for (auto const &input : GetInputs(*node))
+    {
+      auto it = consumers_.find(input.get());
+      if (it != consumers_.end())
+      {
+        ++(it->second);
+      }
+    }
+  }
+
+  statistics_.peak_size     = live_size_;
+  statistics_.num_evaluated = pending.size();
+  statistics_.num_in_place  = 0;
+
+  for (auto const &node : pending)
+  {
+    Compute(node, is_training);
+  }
+}
+
+/**
+ * Evaluates a single node into a buffer from the arena (or over one of its inputs) and releases
+ * any inputs which are no longer needed
+ */
+template <typename TensorType>
+void MemoryPlanner<TensorType>::Compute(NodePtrType const &node, bool is_training)
+{
+  auto const head        = node->GetFusedHead();
+  auto const node_inputs = GetInputs(*node);
+  auto const inputs      = head ? head->GatherInputs() : node->GatherInputs();
+  auto const shape       = head ? head->GetOp()->ComputeOutputShape(inputs)
+                          : node->GetOp()->ComputeOutputShape(inputs);
+
+  // an input can be overwritten when this node accounts for all of its outstanding uses. Fused
+  // chains are always evaluated element by element so they can be evaluated in place.
+  NodeType *source = nullptr;
+  if (head || node->GetOp()->SupportsInPlace())
+  {
+    for (std::size_t i = 0; i < node_inputs.size(); ++i)
+    {
+      NodeType *input = node_inputs[i].get();
+      auto      uses  = static_cast<SizeType>(
+          std::count(node_inputs.begin(), node_inputs.end(), node_inputs[i]));
+
+      if ((buffers_.find(input) != buffers_.end()) && (consumers_.at(input) == uses) &&
+          (inputs[i]->shape() == shape))
+      {
+        source = input;
+        break;
+      }
+    }
+  }
+
+  TensorType buffer = (source != nullptr) ? buffers_.at(source) : Acquire(shape);
+
+  node->AssignOutputBuffer(buffer);
+  node->Evaluate(is_training);
+
+  if (node->UsesOutputBuffer(buffer))
+  {
+    if (source != nullptr)
+    {
+      buffers_.erase(source);
+      ++statistics_.num_in_place;
+    }
+    buffers_[node.get()] = buffer;
+  }
+  else
+  {
+    // the operation replaced its output, which may alias one of its inputs, so the inputs are
+    // kept alive for as long as this node is
+    if (source == nullptr)
+    {
+      Recycle(buffer);
+    }
+    deferred_.insert(node.get());
+    return;
+  }
+
+  for (auto const &input : node_inputs)
+  {
+    Consume(input.get());
+  }
+}
+
+template <typename TensorType>
+void MemoryPlanner<TensorType>::Consume(NodeType *node)
+{
+  auto it = consumers_.find(node);
+  if (it == consumers_.end())
+  {
+    return;
+  }
+
+  assert(it->second > 0);
+  --(it->second);
+
+  if ((it->second == 0) && (node != target_.get()))
+  {
+    Release(node);
+  }
+}
+
+/**
+ * Returns the output buffer of a node to the arena
+ */
+template <typename TensorType>
+void MemoryPlanner<TensorType>::Release(NodeType *node)
+{
+  node->ReleaseOutputBuffer();
+
+  auto it = buffers_.find(node);
+  if (it != buffers_.end())
+  {
+    Recycle(it->second);
+    buffers_.erase(it);
+  }
+
+  if (deferred_.erase(node) > 0)
+  {
+    for (auto const &input : GetInputs(*node))
+    {
+      Consume(input.get());
+    }
+  }
+}
+
+/**
+ * The inputs of a node, as seen by the plan. A fused node takes the inputs of its chain.
+ */
+template <typename TensorType>
+std::vector<typename MemoryPlanner<TensorType>::NodePtrType> MemoryPlanner<TensorType>::GetInputs(
+    NodeType const &node)
+{
+  auto const head = node.GetFusedHead();
+  return head ? head->GetInputs() : node.GetInputs();
+}
+
+template <typename TensorType>
+TensorType MemoryPlanner<TensorType>::Acquire(ShapeType const &shape)
+{
+  TensorType buffer{};
+
+  auto &free_list = free_[shape];
+  if (free_list.empty())
+  {
+    buffer = TensorType{shape};
+    ++statistics_.num_buffers;
+    statistics_.arena_size += buffer.size();
+  }
+  else
+  {
+    buffer = free_list.back();
+    free_list.pop_back();
+  }
+
+  live_size_ += buffer.size();
+  statistics_.peak_size = std::max(statistics_.peak_size, live_size_);
+
+  return buffer;
+}
+
+template <typename TensorType>
+void MemoryPlanner<TensorType>::Recycle(TensorType const &buffer)
+{
+  assert(live_size_ >= buffer.size());
+  live_size_ -= buffer.size();
+
+  free_[buffer.shape()].emplace_back(buffer);
+}
+
+}  // namespace ml
+}  // namespace fetch
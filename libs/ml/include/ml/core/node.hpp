@@ -117,6 +117,15 @@ public:
   void                                ResetCache(bool input_size_changed);
   void                                ResetInputsAndOutputs();
 
+  std::vector<std::shared_ptr<Node<TensorType>>> GetInputs() const;
+
+  void AssignOutputBuffer(TensorType const &buffer);
+  void ReleaseOutputBuffer();
+  bool UsesOutputBuffer(TensorType const &buffer) const;
+
+  void                              SetFusedNodes(std::vector<NodeWeakPtrType> fused_nodes);
+  std::shared_ptr<Node<TensorType>> GetFusedHead() const;
+
   std::string const &GetNodeName()
   {
     return name_;
@@ -142,8 +151,15 @@ public:
   }
 
 private:
+  /// The number of elements computed by each operation of a fused chain before moving on
+  static constexpr fetch::math::SizeType FUSED_BLOCK_SIZE = 1024;
+
+  bool ForwardFused();
+
   std::vector<NodeWeakPtrType> input_nodes_;
   std::vector<NodeWeakPtrType> outputs_;
+  std::vector<NodeWeakPtrType> fused_nodes_;  ///< The elementwise nodes evaluated with this one
+  bool fused_output_ = false;                 ///< The cached output was computed by the fused chain
 
   std::string       name_;
   TensorType        cached_output_;
@@ -153,6 +169,9 @@ private:
   std::shared_ptr<ops::Ops<TensorType>> op_ptr_;
 };
 
+template <typename TensorType>
+constexpr fetch::math::SizeType Node<TensorType>::FUSED_BLOCK_SIZE;
+
 /**
  * Constructs and returns a NodeSaveableParams object allowing serialisation
  * @tparam T
@@ -207,22 +226,28 @@ std::shared_ptr<TensorType> Node<TensorType>::Evaluate(bool is_training)
 {
   op_ptr_->SetTraining(is_training);
 
-  if (cached_output_status_ != CachedOutputState::VALID_CACHE)
+  // the outputs of fused nodes are needed for back propagation, so they are only skipped when not
+  // training and a fused output is recomputed for training
+  if ((cached_output_status_ != CachedOutputState::VALID_CACHE) || (is_training && fused_output_))
   {
-    VecTensorType inputs = GatherInputs();
-
-    if (cached_output_status_ == CachedOutputState::CHANGED_SIZE)
+    fused_output_ = !is_training && ForwardFused();
+    if (!fused_output_)
     {
-      auto output_shape = op_ptr_->ComputeOutputShape(inputs);
+      VecTensorType inputs = GatherInputs();
 
-      if (cached_output_.shape() !=
-          output_shape)  // make shape compatible right before we do the forwarding
+      if (cached_output_status_ == CachedOutputState::CHANGED_SIZE)
       {
-        cached_output_.Reshape(output_shape);
+        auto output_shape = op_ptr_->ComputeOutputShape(inputs);
+
+        if (cached_output_.shape() !=
+            output_shape)  // make shape compatible right before we do the forwarding
+        {
+          cached_output_.Reshape(output_shape);
+        }
       }
-    }
 
-    op_ptr_->Forward(inputs, cached_output_);
+      op_ptr_->Forward(inputs, cached_output_);
+    }
     cached_output_status_ = CachedOutputState::VALID_CACHE;
 
     if (math::state_division_by_zero<DataType>())
@@ -244,6 +269,86 @@ std::shared_ptr<TensorType> Node<TensorType>::Evaluate(bool is_training)
   return std::make_shared<TensorType>(cached_output_);
 }
 
+/**
+ * Evaluates a fused chain of elementwise nodes, ending with this one, in a single pass. Each block
+ * of the output is computed by the first node of the chain and then updated in place by each of
+ * the following nodes while it is still in cache. The outputs of the other nodes in the chain are
+ * not computed.
+ * @tparam TensorType tensor type
+ * @return true if the chain was evaluated, false if this node must be evaluated normally
+ */
+template <typename TensorType>
+bool Node<TensorType>::ForwardFused()
+{
+  if (fused_nodes_.empty())
+  {
+    return false;
+  }
+
+  std::vector<std::shared_ptr<ops::Ops<TensorType>>> chain{};
+  for (auto const &fused_node : fused_nodes_)
+  {
+    if (auto ptr = fused_node.lock())
+    {
+      ptr->GetOp()->SetTraining(false);
+      chain.emplace_back(ptr->GetOp());
+    }
+    else
+    {
+      throw std::runtime_error("Unable to lock weak pointer.");
+    }
+  }
+  chain.emplace_back(op_ptr_);
+
+  VecTensorType const inputs = fused_nodes_.front().lock()->GatherInputs();
+  if (!chain.front()->SupportsForwardRange(inputs))
+  {
+    return false;
+  }
+
+  auto output_shape = chain.front()->ComputeOutputShape(inputs);
+  if (cached_output_.shape() != output_shape)
+  {
+    cached_output_.Reshape(output_shape);
+  }
+
+  VecTensorType const output{std::make_shared<TensorType const>(cached_output_)};
+  auto                forward_range = [&chain, &inputs, &output, this](fetch::math::SizeType begin,
+                                                        fetch::math::SizeType end) {
+    chain.front()->ForwardRange(inputs, cached_output_, begin, end);
+    for (std::size_t i = 1; i < chain.size(); ++i)
+    {
+      chain[i]->ForwardRange(output, cached_output_, begin, end);
+    }
+  };
+
+  // the padding at the end of each column is skipped unless there is none
+  fetch::math::SizeType const height        = output_shape.empty() ? 0 : output_shape.front();
+  fetch::math::SizeType const padded_height = cached_output_.padded_height();
+  fetch::math::SizeType const size          = cached_output_.size();
+  if ((height == 0) || (height == padded_height))
+  {
+    for (fetch::math::SizeType begin = 0; begin < size; begin += FUSED_BLOCK_SIZE)
+    {
+      forward_range(begin, std::min(begin + FUSED_BLOCK_SIZE, size));
+    }
+  }
+  else
+  {
+    for (fetch::math::SizeType column = 0; column < (size / height); ++column)
+    {
+      fetch::math::SizeType const end = (column * padded_height) + height;
+      for (fetch::math::SizeType begin = column * padded_height; begin < end;
+           begin += FUSED_BLOCK_SIZE)
+      {
+        forward_range(begin, std::min(begin + FUSED_BLOCK_SIZE, end));
+      }
+    }
+  }
+
+  return true;
+}
+
 /**
  * Recursively backpropagates error_signal through this node to all input nodes
  * @tparam T the tensor type
@@ -311,6 +416,7 @@ void Node<TensorType>::ResetInputsAndOutputs()
 {
   input_nodes_.clear();
   outputs_.clear();
+  fused_nodes_.clear();
 }
 
 /**
@@ -389,6 +495,96 @@ void Node<TensorType>::ResetCache(bool input_size_changed)
   }
 }
 
+/**
+ * gets all registered inputs of this node
+ * @tparam TensorType tensor type
+ * @return vector of pointers to the input nodes (one entry per connection)
+ */
+template <typename TensorType>
+std::vector<std::shared_ptr<Node<TensorType>>> Node<TensorType>::GetInputs() const
+{
+  std::vector<std::shared_ptr<Node<TensorType>>> ret{};
+  ret.reserve(input_nodes_.size());
+  for (auto const &input_node : input_nodes_)
+  {
+    if (auto ptr = input_node.lock())
+    {
+      ret.emplace_back(std::move(ptr));
+    }
+    else
+    {
+      throw std::runtime_error("Unable to lock weak pointer.");
+    }
+  }
+  return ret;
+}
+
+/**
+ * Provides the tensor that the next forward pass of this node should write into. The buffer must
+ * already have the output shape of the node, it is usually owned by a MemoryPlanner.
+ * @tparam TensorType tensor type
+ * @param buffer the output buffer (shallow copied)
+ */
+template <typename TensorType>
+void Node<TensorType>::AssignOutputBuffer(TensorType const &buffer)
+{
+  cached_output_        = buffer;
+  cached_output_status_ = CachedOutputState::CHANGED_CONTENT;
+}
+
+/**
+ * Drops the reference to the output of this node so that its memory can be reused elsewhere. The
+ * node will recompute its output (reallocating it if necessary) the next time it is evaluated.
+ * @tparam TensorType tensor type
+ */
+template <typename TensorType>
+void Node<TensorType>::ReleaseOutputBuffer()
+{
+  cached_output_        = TensorType{};
+  cached_output_status_ = CachedOutputState::CHANGED_SIZE;
+}
+
+/**
+ * Determines if the cached output of this node is stored in the specified buffer, which is not the
+ * case when the operation replaced its output tensor rather than writing into it
+ * @tparam TensorType tensor type
+ * @param buffer the buffer previously passed to AssignOutputBuffer
+ * @return true if the output shares its memory with the buffer, otherwise false
+ */
+template <typename TensorType>
+bool Node<TensorType>::UsesOutputBuffer(TensorType const &buffer) const
+{
+  return cached_output_.data().pointer() == buffer.data().pointer();
+}
+
+/**
+ * Fuses this node with the chain of elementwise nodes which precede it, so that outside of
+ * training the whole chain is evaluated in a single pass when this node is evaluated
+ * @tparam TensorType tensor type
+ * @param fused_nodes the preceding nodes, starting with the first node of the chain, or empty to
+ * evaluate this node on its own
+ */
+template <typename TensorType>
+void Node<TensorType>::SetFusedNodes(std::vector<NodeWeakPtrType> fused_nodes)
+{
+  fused_nodes_ = std::move(fused_nodes);
+}
+
+/**
+ * gets the first node of the fused chain which ends with this node
+ * @tparam TensorType tensor type
+ * @return the first node of the chain, or nullptr if this node has not been fused
+ */
+template <typename TensorType>
+std::shared_ptr<Node<TensorType>> Node<TensorType>::GetFusedHead() const
+{
+  if (fused_nodes_.empty())
+  {
+    return nullptr;
+  }
+  return fused_nodes_.front().lock();
+}
+
 /**
  * Sets the saveable params back to the node
  * @tparam TensorType
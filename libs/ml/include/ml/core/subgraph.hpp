@@ -84,7 +84,7 @@ void SubGraph<TensorType>::Forward(VecTensorType const &inputs, TensorType &outp
   {
     this->SetInput(input_node_names_[i], *(inputs.at(i)));
   }
-  output = *(this->nodes_[output_node_name_]->Evaluate(this->is_training_));
+  output = *(this->EvaluateNode(this->nodes_[output_node_name_], this->is_training_));
 }
 
 /**
@@ -0,0 +1,219 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "math/base_types.hpp"
+#include "ml/dataloaders/tensor_dataloader.hpp"
+#include "ml/exceptions/exceptions.hpp"
+#include "ml/meta/ml_type_traits.hpp"
+#include "storage/mapped_file.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+/**
+ * A data loader which reads samples straight out of memory mapped MNIST image and label files (idx
+ * format), so that the dataset is never decoded into memory as a whole. Only the pages backing the
+ * samples in use are resident.
+ *
+ * Samples match the output of utilities::read_mnist_images and convert_labels_to_onehot: images
+ * have shape {n_rows, n_cols, 1} scaled to [0, 1) and labels are one hot with shape {10, 1}.
+ * The train / test / validation split and the random mode behave as for TensorDataLoader.
+ * @tparam LabelType
+ * @tparam InputType
+ */
+template <typename LabelType, typename InputType>
+class MnistDataLoader : public TensorDataLoader<LabelType, InputType>
+{
+public:
+  using TensorType     = InputType;
+  using DataType       = typename TensorType::Type;
+  using SizeType       = fetch::math::SizeType;
+  using ReturnType     = std::pair<LabelType, std::vector<TensorType>>;
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  static constexpr SizeType NUMBER_OF_CLASSES = 10;
+
+  MnistDataLoader(std::string const &images_file, std::string const &labels_file);
+  ~MnistDataLoader() override = default;
+
+  ReturnType GetNext() override;
+
+  bool AddData(std::vector<InputType> const &data, LabelType const &labels) override;
+
+  LoaderType LoaderCode() override
+  {
+    return LoaderType::MNIST;
+  }
+
+private:
+  static constexpr uint32_t IMAGES_MAGIC       = 2051;
+  static constexpr uint32_t LABELS_MAGIC       = 2049;
+  static constexpr SizeType IMAGES_HEADER_SIZE = 4 * sizeof(uint32_t);
+  static constexpr SizeType LABELS_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+  static ConstByteArray MapFile(std::string const &filename);
+  static uint32_t       ReadHeaderValue(ConstByteArray const &file, SizeType index);
+
+  ConstByteArray images_;  ///< the whole of the mapped image file
+  ConstByteArray labels_;  ///< the whole of the mapped labels file
+  SizeType       n_rows_{0};
+  SizeType       n_cols_{0};
+};
+
+template <typename LabelType, typename InputType>
+constexpr typename MnistDataLoader<LabelType, InputType>::SizeType
+    MnistDataLoader<LabelType, InputType>::NUMBER_OF_CLASSES;
+
+template <typename LabelType, typename InputType>
+constexpr uint32_t MnistDataLoader<LabelType, InputType>::IMAGES_MAGIC;
+
+template <typename LabelType, typename InputType>
+constexpr uint32_t MnistDataLoader<LabelType, InputType>::LABELS_MAGIC;
+
+template <typename LabelType, typename InputType>
+constexpr typename MnistDataLoader<LabelType, InputType>::SizeType
+    MnistDataLoader<LabelType, InputType>::IMAGES_HEADER_SIZE;
+
+template <typename LabelType, typename InputType>
+constexpr typename MnistDataLoader<LabelType, InputType>::SizeType
+    MnistDataLoader<LabelType, InputType>::LABELS_HEADER_SIZE;
+
+/**
+ * Maps the image and label files and validates their headers
+ * @param images_file path to the idx image file, e.g. train-images-idx3-ubyte
+ * @param labels_file path to the idx labels file, e.g. train-labels-idx1-ubyte
+ */
+template <typename LabelType, typename InputType>
+MnistDataLoader<LabelType, InputType>::MnistDataLoader(std::string const &images_file,
+                                                       std::string const &labels_file)
+  : images_{MapFile(images_file)}
+  , labels_{MapFile(labels_file)}
+{
+  if ((images_.size() < IMAGES_HEADER_SIZE) || (ReadHeaderValue(images_, 0) != IMAGES_MAGIC))
+  {
+    throw exceptions::InvalidFile("Invalid MNIST image file!");
+  }
+
+  if ((labels_.size() < LABELS_HEADER_SIZE) || (ReadHeaderValue(labels_, 0) != LABELS_MAGIC))
+  {
+    throw exceptions::InvalidFile("Invalid MNIST label file!");
+  }
+
+  SizeType const n_images = ReadHeaderValue(images_, 1);
+  n_rows_                 = ReadHeaderValue(images_, 2);
+  n_cols_                 = ReadHeaderValue(images_, 3);
+
+  if ((ReadHeaderValue(labels_, 1) != n_images) ||
+      (images_.size() < (IMAGES_HEADER_SIZE + (n_images * n_rows_ * n_cols_))) ||
+      (labels_.size() < (LABELS_HEADER_SIZE + n_images)))
+  {
+    throw exceptions::InvalidFile("MNIST image and label files do not match!");
+  }
+
+  this->n_samples_              = n_images;
+  this->one_sample_label_shape_ = {NUMBER_OF_CLASSES, 1};
+  this->one_sample_data_shapes_ = {{n_rows_, n_cols_, 1}};
+
+  this->UpdateRanges();
+}
+
+template <typename LabelType, typename InputType>
+typename MnistDataLoader<LabelType, InputType>::ReturnType
+MnistDataLoader<LabelType, InputType>::GetNext()
+{
+  SizeType const        index  = *this->current_cursor_;
+  ConstByteArray const &images = images_;
+  ConstByteArray const &labels = labels_;
+
+  // decode the image directly from the mapped file
+  TensorType     image(this->one_sample_data_shapes_.front());
+  auto const *   pixel = images.pointer() + IMAGES_HEADER_SIZE + (index * n_rows_ * n_cols_);
+  DataType const scale{256};
+  for (SizeType j{0}; j < n_rows_; j++)
+  {
+    for (SizeType k{0}; k < n_cols_; k++)
+    {
+      image.At(j, k, 0) = static_cast<DataType>(pixel[j * n_cols_ + k]) / scale;
+    }
+  }
+
+  LabelType label(this->one_sample_label_shape_);
+  label.At(static_cast<SizeType>(labels[LABELS_HEADER_SIZE + index]), 0) = DataType{1};
+
+  if (this->random_mode_)
+  {
+    *this->current_cursor_ = this->current_min_ + SizeType{this->rand()} % this->current_size_;
+    ++(*this->count_);
+  }
+  else
+  {
+    (*this->current_cursor_)++;
+  }
+
+  return ReturnType(std::move(label), {std::move(image)});
+}
+
+template <typename LabelType, typename InputType>
+bool MnistDataLoader<LabelType, InputType>::AddData(std::vector<InputType> const & /*data*/,
+                                                    LabelType const & /*labels*/)
+{
+  throw exceptions::InvalidMode("Data can not be added to a memory mapped MNIST data loader");
+}
+
+// private
+
+template <typename LabelType, typename InputType>
+typename MnistDataLoader<LabelType, InputType>::ConstByteArray
+MnistDataLoader<LabelType, InputType>::MapFile(std::string const &filename)
+{
+  storage::MappedFile file;
+  file.Open(filename);
+
+  // the first access maps the whole of the file, the returned slice keeps the mapping alive
+  if (file.Slice(0, 1).empty())
+  {
+    throw exceptions::InvalidFile("Cannot open file `" + filename + "`!");
+  }
+
+  return file.Slice(0, file.size());
+}
+
+/**
+ * Reads one of the big endian 32 bit values which make up the header of an idx file
+ */
+template <typename LabelType, typename InputType>
+uint32_t MnistDataLoader<LabelType, InputType>::ReadHeaderValue(ConstByteArray const &file,
+                                                                SizeType              index)
+{
+  auto const *bytes = file.pointer() + (index * sizeof(uint32_t));
+
+  return (static_cast<uint32_t>(bytes[0]) << 24u) | (static_cast<uint32_t>(bytes[1]) << 16u) |
+         (static_cast<uint32_t>(bytes[2]) << 8u) | static_cast<uint32_t>(bytes[3]);
+}
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
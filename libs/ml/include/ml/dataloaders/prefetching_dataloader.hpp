@@ -0,0 +1,534 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "ml/dataloaders/dataloader.hpp"
+#include "ml/exceptions/exceptions.hpp"
+#include "ml/meta/ml_type_traits.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+/**
+ * Wraps another data loader and prepares batches ahead of time on a set of background worker
+ * threads, so that the training thread does not stall while the next batch is being built.
+ *
+ * Batches are assembled into a bounded ring of reusable buffers and are handed out strictly in the
+ * order in which their samples were drawn from the wrapped loader, so the sequence of batches is
+ * the same as calling PrepareBatch on the wrapped loader directly. The tensors returned by
+ * PrepareBatch remain valid until the next call to PrepareBatch.
+ *
+ * The wrapped loader should be configured (data, random mode, seed and ratios) before batches are
+ * requested. Reconfiguring it through this class, or changing the batch size, discards any batches
+ * which have already been prefetched.
+ *
+ * When the wrapped loader reaches the end of its data at the end of a batch it is reset by the
+ * worker straight away, in the same way the optimiser would reset it before the next epoch.
+ *
+ * @tparam LabelType
+ * @tparam InputType
+ */
+template <typename LabelType, typename InputType>
+class PrefetchingDataLoader : public DataLoader<LabelType, InputType>
+{
+public:
+  using SizeType       = fetch::math::SizeType;
+  using SizeVector     = fetch::math::SizeVector;
+  using ReturnType     = std::pair<LabelType, std::vector<InputType>>;
+  using DataLoaderType = DataLoader<LabelType, InputType>;
+  using DataLoaderPtr  = std::shared_ptr<DataLoaderType>;
+
+  static constexpr SizeType DEFAULT_QUEUE_SIZE = 4;
+
+  explicit PrefetchingDataLoader(DataLoaderPtr loader, SizeType num_workers = 1,
+                                 SizeType queue_size = DEFAULT_QUEUE_SIZE);
+  PrefetchingDataLoader(PrefetchingDataLoader const &) = delete;
+  PrefetchingDataLoader(PrefetchingDataLoader &&)      = delete;
+  ~PrefetchingDataLoader() override;
+
+  ReturnType GetNext() override;
+  bool       AddData(std::vector<InputType> const &data, LabelType const &label) override;
+  ReturnType PrepareBatch(SizeType batch_size, bool &is_done_set) override;
+
+  SizeType Size() const override;
+  bool     IsDone() const override;
+  void     Reset() override;
+  void     SetTestRatio(float new_test_ratio) override;
+  void     SetValidationRatio(float new_validation_ratio) override;
+  bool     IsModeAvailable(DataLoaderMode mode) override;
+
+  LoaderType LoaderCode() override
+  {
+    return LoaderType::PREFETCH;
+  }
+
+  PrefetchingDataLoader &operator=(PrefetchingDataLoader const &) = delete;
+  PrefetchingDataLoader &operator=(PrefetchingDataLoader &&) = delete;
+
+protected:
+  void UpdateCursor() override;
+
+private:
+  enum class SlotState : uint8_t
+  {
+    FREE,     ///< available to be filled by a worker
+    FILLING,  ///< a worker is assembling a batch into the slot
+    READY,    ///< holds a batch waiting to be delivered
+    IN_USE    ///< holds the batch most recently returned from PrepareBatch
+  };
+
+  struct Slot
+  {
+    SlotState  state{SlotState::FREE};
+    SizeType   sequence{0};            ///< the position of the batch in the delivery order
+    bool       is_done_set{false};     ///< the wrapped loader was reset part way through the batch
+    bool       epoch_finished{false};  ///< the wrapped loader was done at the end of the batch
+    ReturnType batch{};
+  };
+
+  using Lock = std::unique_lock<std::mutex>;
+
+  void Start(SizeType batch_size);
+  void Stop();
+  void WorkerLoop();
+  bool DrawSamples(std::vector<ReturnType> &samples, bool &is_done_set, bool &epoch_finished);
+  void AllocateBatch(ReturnType &batch) const;
+
+  static void AssembleBatch(std::vector<ReturnType> const &samples, ReturnType &batch);
+
+  DataLoaderPtr const loader_;
+  SizeType const      num_workers_;
+
+  mutable std::mutex       mutex_;
+  std::condition_variable  slot_ready_;
+  std::condition_variable  slot_free_;
+  std::vector<Slot>        slots_;
+  std::vector<std::thread> workers_;
+
+  bool               running_{false};
+  bool               stopping_{false};
+  bool               epoch_finished_{false};  ///< the last delivered batch finished the epoch
+  SizeType           batch_size_{0};
+  SizeType           next_sequence_{0};  ///< sequence number of the next batch to be drawn
+  SizeType           next_delivery_{0};  ///< sequence number of the next batch to be delivered
+  std::exception_ptr error_{};
+
+  bool                    shapes_set_{false};
+  SizeVector              label_shape_{};
+  std::vector<SizeVector> data_shapes_{};
+};
+
+template <typename LabelType, typename InputType>
+constexpr typename PrefetchingDataLoader<LabelType, InputType>::SizeType
+    PrefetchingDataLoader<LabelType, InputType>::DEFAULT_QUEUE_SIZE;
+
+/**
+ * @param loader the data loader to prefetch batches from
+ * @param num_workers the number of background threads assembling batches
+ * @param queue_size the number of batch buffers, bounding how far ahead the workers can run
+ */
+template <typename LabelType, typename InputType>
+PrefetchingDataLoader<LabelType, InputType>::PrefetchingDataLoader(DataLoaderPtr loader,
+                                                                   SizeType      num_workers,
+                                                                   SizeType      queue_size)
+  : loader_{std::move(loader)}
+  , num_workers_{std::max<SizeType>(num_workers, 1)}
+  , slots_(std::max<SizeType>(queue_size, 1))
+{
+  if (!loader_)
+  {
+    throw exceptions::InvalidInput("PrefetchingDataLoader requires a data loader to wrap");
+  }
+}
+
+template <typename LabelType, typename InputType>
+PrefetchingDataLoader<LabelType, InputType>::~PrefetchingDataLoader()
+{
+  Stop();
+}
+
+template <typename LabelType, typename InputType>
+typename PrefetchingDataLoader<LabelType, InputType>::ReturnType
+PrefetchingDataLoader<LabelType, InputType>::GetNext()
+{
+  Stop();
+  return loader_->GetNext();
+}
+
+template <typename LabelType, typename InputType>
+bool PrefetchingDataLoader<LabelType, InputType>::AddData(std::vector<InputType> const &data,
+                                                          LabelType const &             label)
+{
+  Stop();
+  shapes_set_ = false;
+  return loader_->AddData(data, label);
+}
+
+/**
+ * Returns the next prefetched batch, starting the workers on the first call
+ * @param batch_size i.e. batch size of returned Tensors
+ * @param is_done_set set to true if the wrapped loader reached the end of its data (and was reset)
+ * part way through the batch
+ * @return pair of label tensor and vector of data tensors with specified batch size
+ */
+template <typename LabelType, typename InputType>
+typename PrefetchingDataLoader<LabelType, InputType>::ReturnType
+PrefetchingDataLoader<LabelType, InputType>::PrepareBatch(SizeType batch_size, bool &is_done_set)
+{
+  if (!running_ || (batch_size != batch_size_))
+  {
+    Stop();
+    Start(batch_size);
+  }
+
+  Lock lock(mutex_);
+
+  // the previously delivered batch is no longer referenced by the caller
+  for (auto &slot : slots_)
+  {
+    if (SlotState::IN_USE == slot.state)
+    {
+      slot.state = SlotState::FREE;
+      slot_free_.notify_one();
+    }
+  }
+
+  auto const is_next = [this](Slot const &slot) {
+    return (SlotState::READY == slot.state) && (slot.sequence == next_delivery_);
+  };
+
+  auto it = slots_.end();
+  slot_ready_.wait(lock, [this, &it, &is_next]() {
+    it = std::find_if(slots_.begin(), slots_.end(), is_next);
+    return (it != slots_.end()) || error_;
+  });
+
+  if (it == slots_.end())
+  {
+    // a worker has failed, shut down the remaining workers before reporting the error
+    std::exception_ptr error = error_;
+    lock.unlock();
+    Stop();
+    std::rethrow_exception(error);
+  }
+
+  it->state = SlotState::IN_USE;
+  ++next_delivery_;
+
+  if (it->is_done_set)
+  {
+    is_done_set = true;
+  }
+  epoch_finished_ = it->epoch_finished;
+
+  return it->batch;
+}
+
+template <typename LabelType, typename InputType>
+typename PrefetchingDataLoader<LabelType, InputType>::SizeType
+PrefetchingDataLoader<LabelType, InputType>::Size() const
+{
+  Lock lock(mutex_);
+  return loader_->Size();
+}
+
+template <typename LabelType, typename InputType>
+bool PrefetchingDataLoader<LabelType, InputType>::IsDone() const
+{
+  Lock lock(mutex_);
+
+  // while prefetching the wrapped loader runs ahead, so report the state as of the last batch
+  if (running_)
+  {
+    return epoch_finished_;
+  }
+
+  return loader_->IsDone();
+}
+
+template <typename LabelType, typename InputType>
+void PrefetchingDataLoader<LabelType, InputType>::Reset()
+{
+  {
+    Lock lock(mutex_);
+
+    // the workers have already reset the wrapped loader at the end of the epoch
+    if (running_ && epoch_finished_)
+    {
+      epoch_finished_ = false;
+      return;
+    }
+  }
+
+  Stop();
+  loader_->Reset();
+}
+
+template <typename LabelType, typename InputType>
+void PrefetchingDataLoader<LabelType, InputType>::SetTestRatio(float new_test_ratio)
+{
+  Stop();
+  loader_->SetTestRatio(new_test_ratio);
+}
+
+template <typename LabelType, typename InputType>
+void PrefetchingDataLoader<LabelType, InputType>::SetValidationRatio(float new_validation_ratio)
+{
+  Stop();
+  loader_->SetValidationRatio(new_validation_ratio);
+}
+
+template <typename LabelType, typename InputType>
+bool PrefetchingDataLoader<LabelType, InputType>::IsModeAvailable(DataLoaderMode mode)
+{
+  Lock lock(mutex_);
+  return loader_->IsModeAvailable(mode);
+}
+
+/**
+ * Forwards a change of mode to the wrapped loader
+ */
+template <typename LabelType, typename InputType>
+void PrefetchingDataLoader<LabelType, InputType>::UpdateCursor()
+{
+  Stop();
+  loader_->SetMode(this->mode_);
+
+  // the cursor itself is owned by the wrapped loader, only the range is mirrored here
+  this->current_min_  = 0;
+  this->current_max_  = loader_->Size();
+  this->current_size_ = loader_->Size();
+}
+
+// private
+
+/**
+ * Allocates the batch buffers and launches the worker threads
+ * @param batch_size
+ */
+template <typename LabelType, typename InputType>
+void PrefetchingDataLoader<LabelType, InputType>::Start(SizeType batch_size)
+{
+  Lock lock(mutex_);
+
+  if (!shapes_set_)
+  {
+    // a dummy GetNext identifies the tensor shapes, exactly as DataLoader::PrepareBatch does
+    auto const sample = loader_->GetNext();
+    loader_->Reset();
+
+    label_shape_ = sample.first.shape();
+    data_shapes_.clear();
+    for (auto const &tensor : sample.second)
+    {
+      data_shapes_.emplace_back(tensor.shape());
+    }
+
+    shapes_set_ = true;
+    batch_size_ = 0;
+  }
+
+  // the buffers are reused for as long as the batch size does not change
+  if (batch_size != batch_size_)
+  {
+    batch_size_ = batch_size;
+    for (auto &slot : slots_)
+    {
+      AllocateBatch(slot.batch);
+    }
+  }
+
+  for (auto &slot : slots_)
+  {
+    slot.state = SlotState::FREE;
+  }
+
+  next_sequence_  = 0;
+  next_delivery_  = 0;
+  epoch_finished_ = false;
+  error_          = nullptr;
+  stopping_       = false;
+  running_        = true;
+
+  for (SizeType i = 0; i < num_workers_; ++i)
+  {
+    workers_.emplace_back(&PrefetchingDataLoader::WorkerLoop, this);
+  }
+}
+
+/**
+ * Stops and joins the worker threads, discarding any prefetched batches
+ */
+template <typename LabelType, typename InputType>
+void PrefetchingDataLoader<LabelType, InputType>::Stop()
+{
+  {
+    Lock lock(mutex_);
+    if (!running_)
+    {
+      return;
+    }
+
+    stopping_ = true;
+  }
+
+  slot_free_.notify_all();
+  slot_ready_.notify_all();
+
+  for (auto &worker : workers_)
+  {
+    worker.join();
+  }
+  workers_.clear();
+
+  Lock lock(mutex_);
+  running_  = false;
+  stopping_ = false;
+}
+
+template <typename LabelType, typename InputType>
+void PrefetchingDataLoader<LabelType, InputType>::WorkerLoop()
+{
+  std::vector<ReturnType> samples;
+
+  Lock lock(mutex_);
+  while (!stopping_)
+  {
+    auto slot = std::find_if(slots_.begin(), slots_.end(),
+                             [](Slot const &s) { return SlotState::FREE == s.state; });
+
+    if (slot == slots_.end())
+    {
+      slot_free_.wait(lock);
+      continue;
+    }
+
+    slot->state    = SlotState::FILLING;
+    slot->sequence = next_sequence_++;
+
+    // the wrapped loader is not thread safe, so the samples are drawn while holding the lock
+    if (!DrawSamples(samples, slot->is_done_set, slot->epoch_finished))
+    {
+      return;
+    }
+
+    // the slot is owned by this worker until it is marked as ready
+    lock.unlock();
+    AssembleBatch(samples, slot->batch);
+    lock.lock();
+
+    slot->state = SlotState::READY;
+    slot_ready_.notify_all();
+  }
+}
+
+/**
+ * Draws the samples for one batch from the wrapped loader, following the same sequence of calls
+ * as DataLoader::PrepareBatch. Must be called with the lock held
+ * @return false if the wrapped loader failed, in which case the error is recorded for the consumer
+ */
+template <typename LabelType, typename InputType>
+bool PrefetchingDataLoader<LabelType, InputType>::DrawSamples(std::vector<ReturnType> &samples,
+                                                              bool &is_done_set,
+                                                              bool &epoch_finished)
+{
+  is_done_set    = false;
+  epoch_finished = false;
+  samples.resize(batch_size_);
+
+  try
+  {
+    for (auto &sample : samples)
+    {
+      if (loader_->IsDone())
+      {
+        is_done_set = true;
+        loader_->Reset();
+      }
+
+      sample = loader_->GetNext();
+    }
+
+    // prepare for the next epoch in the same way that the optimiser would
+    if (loader_->IsDone())
+    {
+      epoch_finished = true;
+      loader_->Reset();
+    }
+  }
+  catch (...)
+  {
+    error_    = std::current_exception();
+    stopping_ = true;
+    slot_ready_.notify_all();
+    slot_free_.notify_all();
+    return false;
+  }
+
+  return true;
+}
+
+template <typename LabelType, typename InputType>
+void PrefetchingDataLoader<LabelType, InputType>::AllocateBatch(ReturnType &batch) const
+{
+  SizeVector shape = label_shape_;
+  shape.back()     = batch_size_;
+  batch.first      = LabelType(shape);
+
+  batch.second.clear();
+  for (auto const &data_shape : data_shapes_)
+  {
+    shape        = data_shape;
+    shape.back() = batch_size_;
+    batch.second.emplace_back(InputType(shape));
+  }
+}
+
+template <typename LabelType, typename InputType>
+void PrefetchingDataLoader<LabelType, InputType>::AssembleBatch(
+    std::vector<ReturnType> const &samples, ReturnType &batch)
+{
+  for (SizeType data_idx = 0; data_idx < samples.size(); ++data_idx)
+  {
+    auto const &sample = samples[data_idx];
+
+    auto label_view = batch.first.View(data_idx);
+    label_view.Assign(sample.first);
+
+    for (SizeType j = 0; j < sample.second.size(); ++j)
+    {
+      auto data_view = batch.second.at(j).View(data_idx);
+      data_view.Assign(sample.second.at(j));
+    }
+  }
+}
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
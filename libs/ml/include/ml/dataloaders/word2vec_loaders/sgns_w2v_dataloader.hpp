@@ -76,7 +76,13 @@ public:
   VocabPtrType const &GetVocab() const;
   std::string         WordFromIndex(SizeType index) const;
   SizeType            IndexFromWord(std::string const &word) const;
-  SizeType            WindowSize();
+  SizeType            WindowSize() const;
+  SizeType            NegativeSamples() const;
+  DataType            FreqThresh() const;
+
+  std::vector<std::vector<SizeType>> const &GetData() const;
+  std::vector<SizeType> const &             GetWordCounts() const;
+  UnigramTable const &                      GetUnigramTable() const;
 
   byte_array::ConstByteArray GetVocabHash();
 
@@ -689,11 +695,51 @@ typename GraphW2VLoader<TensorType>::SizeType GraphW2VLoader<TensorType>::IndexF
 }
 
 template <typename TensorType>
-typename GraphW2VLoader<TensorType>::SizeType GraphW2VLoader<TensorType>::WindowSize()
+typename GraphW2VLoader<TensorType>::SizeType GraphW2VLoader<TensorType>::WindowSize() const
 {
   return window_size_;
 }
 
+template <typename TensorType>
+typename GraphW2VLoader<TensorType>::SizeType GraphW2VLoader<TensorType>::NegativeSamples() const
+{
+  return negative_samples_;
+}
+
+template <typename TensorType>
+typename GraphW2VLoader<TensorType>::DataType GraphW2VLoader<TensorType>::FreqThresh() const
+{
+  return freq_thresh_;
+}
+
+/**
+ * export the sentences of the data as word indices
+ * @return
+ */
+template <typename TensorType>
+std::vector<std::vector<typename GraphW2VLoader<TensorType>::SizeType>> const &
+GraphW2VLoader<TensorType>::GetData() const
+{
+  return data_;
+}
+
+/**
+ * export the number of occurrences in the data of every word index
+ * @return
+ */
+template <typename TensorType>
+std::vector<typename GraphW2VLoader<TensorType>::SizeType> const &
+GraphW2VLoader<TensorType>::GetWordCounts() const
+{
+  return word_id_counts_;
+}
+
+template <typename TensorType>
+UnigramTable const &GraphW2VLoader<TensorType>::GetUnigramTable() const
+{
+  return unigram_table_;
+}
+
 /**
  * Preprocesses a string turning it into a vector of words
  * @param s
@@ -39,6 +39,9 @@ public:
   void ResetRNG();
   std::vector<SizeType> GetTable();
 
+  template <typename RNG>
+  bool SampleNegative(SizeType positive_index, SizeType &ret, RNG &rng) const;
+
 private:
   std::vector<SizeType>                      data_;
   fetch::random::LinearCongruentialGenerator rng_;
@@ -164,6 +167,32 @@ inline bool UnigramTable::SampleNegative(fetch::math::Tensor<SizeType> const &po
   }
 }
 
+/**
+ * samples a negative value from unigram table with an external random number generator, which
+ * allows several threads to sample from the same table
+ * @param positive_index
+ * @param ret
+ * @param rng
+ * @return
+ */
+template <typename RNG>
+bool UnigramTable::SampleNegative(SizeType positive_index, SizeType &ret, RNG &rng) const
+{
+  ret = data_[rng() % data_.size()];
+
+  SizeType attempt_count = 0;
+  while (ret == positive_index)
+  {
+    ret = data_[rng() % data_.size()];
+    attempt_count++;
+    if (attempt_count > timeout_)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 /**
  * resets random number generation for sampling
  */
@@ -17,22 +17,12 @@
 //
 //------------------------------------------------------------------------------
 
-#include "math/standard_functions/sqrt.hpp"
 #include "ml/core/subgraph.hpp"
-#include "ml/ops/activations/dropout.hpp"
-#include "ml/ops/activations/softmax.hpp"
-#include "ml/ops/add.hpp"
-#include "ml/ops/constant.hpp"
-#include "ml/ops/divide.hpp"
-#include "ml/ops/mask_fill.hpp"
-#include "ml/ops/matrix_multiply.hpp"
+#include "ml/ops/fused_attention.hpp"
 #include "ml/ops/placeholder.hpp"
-#include "ml/ops/transpose.hpp"
 
-#include <cmath>
 #include <cstdint>
 #include <memory>
-#include <random>
 #include <string>
 
 namespace fetch {
@@ -72,38 +62,12 @@ public:
     // paper as our batch dimension is the last dimension, which the feature dimension is the first
     // one. in the paper, feature dimension is the col dimension please refer to
     // http://jalammar.github.io/illustrated-transformer/
-    std::string transpose_key = this->template AddNode<fetch::ml::ops::Transpose<TensorType>>(
-        name + "_TransposeKey", {key});
-    std::string kq_matmul = this->template AddNode<fetch::ml::ops::MatrixMultiply<TensorType>>(
-        name + "_Key_Query_MatMul", {transpose_key, query});
-
-    TensorType sqrt_dk_tensor(std::vector<SizeType>({1, 1, 1}));
-    sqrt_dk_tensor(0, 0, 0) = fetch::math::Sqrt(static_cast<DataType>(key_dim_));
-    std::string sqrt_dk_ph =
-        this->template AddNode<fetch::ml::ops::Constant<TensorType>>(name + "_Sqrt_Key_Dim", {});
-    this->SetInput(sqrt_dk_ph, sqrt_dk_tensor);
-
-    // scale the QK matrix multiplication
-    std::string scaled_kq_matmul = this->template AddNode<fetch::ml::ops::Divide<TensorType>>(
-        name + "_Scaled_Key_Query_MatMul", {kq_matmul, sqrt_dk_ph});
-
+    // softmax(mask_fill(K^T Q / sqrt(dk))) is computed by a single operation together with the
+    // dropout and the product with the values, without materialising the attention weights
     // masking: make sure you mask along the feature dimension if the mask is to be broadcasted
-    std::string masked_scaled_kq_matmul =
-        this->template AddNode<fetch::ml::ops::MaskFill<TensorType>>(
-            name + "_Masking", {mask, scaled_kq_matmul}, DataType{-1000000000});
-
-    // softmax
-    std::string attention_weight = this->template AddNode<fetch::ml::ops::Softmax<TensorType>>(
-        name + "_Softmax", {masked_scaled_kq_matmul}, static_cast<SizeType>(0));
-
-    // dropout
-    std::string dropout_attention_weight =
-        this->template AddNode<fetch::ml::ops::Dropout<TensorType>>(name + "_Dropout",
-                                                                    {attention_weight}, dropout_);
-    // attention vectors
-    std::string weight_value_matmul =
-        this->template AddNode<fetch::ml::ops::MatrixMultiply<TensorType>>(
-            name + "_Value_Weight_MatMul", {value, dropout_attention_weight});
+    std::string attention = this->template AddNode<fetch::ml::ops::FusedAttention<TensorType>>(
+        name + "_Fused_Attention", {query, key, value, mask}, key_dim_, dropout_,
+        DataType{-1000000000});
 
     // in the end, the output is of shape (feature_length, query_num, batch_num)
 
@@ -111,7 +75,7 @@ public:
     this->AddInputNode(key);
     this->AddInputNode(value);
     this->AddInputNode(mask);
-    this->SetOutputNode(weight_value_matmul);
+    this->SetOutputNode(attention);
     this->Compile();
   }
 
@@ -39,7 +39,9 @@ enum class LoaderType : uint8_t
   SGNS,
   W2V,
   COMMODITY,
-  C2V
+  C2V,
+  PREFETCH,
+  MNIST
 };
 
 enum class SliceType : uint8_t
@@ -80,6 +82,7 @@ enum class OpType : uint16_t
   OP_EMBEDDINGS,
   OP_EXP,
   OP_FLATTEN,
+  OP_FUSED_ATTENTION,
   OP_GELU,
   OP_LAYER_NORM,
   OP_LEAKY_RELU,
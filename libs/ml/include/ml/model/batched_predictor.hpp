@@ -0,0 +1,302 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "ml/exceptions/exceptions.hpp"
+#include "ml/model/model.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace model {
+
+/**
+ * Serves predictions of a compiled model to many concurrent callers.
+ *
+ * Requests are queued and a single worker assembles them into batches along the trailing (batch)
+ * axis. A batch is run as soon as it holds max_batch_size samples, or once the oldest request in
+ * it has waited for max_latency, so that a single forward pass is made for every batch and the
+ * latency added to any request is bounded. The outputs are split back into one tensor per request.
+ *
+ * Only requests which agree on every dimension but the trailing one are batched together, the
+ * queue is served in order. The model is only used by the worker, it must not be used elsewhere
+ * while the predictor exists.
+ */
+template <typename TensorType>
+class BatchedPredictor
+{
+public:
+  using SizeType     = fetch::math::SizeType;
+  using SizeVector   = fetch::math::SizeVector;
+  using ModelType    = Model<TensorType>;
+  using ModelPtrType = std::shared_ptr<ModelType>;
+  using ClockType    = std::chrono::steady_clock;
+  using DurationType = std::chrono::microseconds;
+
+  BatchedPredictor(ModelPtrType model, SizeType max_batch_size, DurationType max_latency);
+  BatchedPredictor(BatchedPredictor const &other) = delete;
+  BatchedPredictor &operator=(BatchedPredictor const &other) = delete;
+  ~BatchedPredictor();
+
+  std::future<TensorType> Predict(TensorType input);
+
+  SizeType batches_run() const;
+  SizeType samples_run() const;
+
+private:
+  struct Request
+  {
+    TensorType               input;
+    std::promise<TensorType> output;
+    ClockType::time_point    arrival;
+  };
+
+  using Requests = std::vector<Request>;
+
+  void Run();
+  void RunBatch(Requests &batch);
+
+  static SizeType BatchSize(TensorType const &tensor);
+  static bool     SameSampleShape(TensorType const &a, TensorType const &b);
+
+  ModelPtrType model_;
+  SizeType     max_batch_size_;
+  DurationType max_latency_;
+
+  mutable std::mutex      mutex_;
+  std::condition_variable condition_;
+  std::deque<Request>     queue_;
+  SizeType                queued_samples_{0};
+  SizeType                batches_run_{0};
+  SizeType                samples_run_{0};
+  bool                    running_{true};
+  std::thread             worker_;
+};
+
+/**
+ * @param model a compiled model
+ * @param max_batch_size the number of samples at which a batch is run without further waiting
+ * @param max_latency the longest a request waits for other requests to batch with
+ */
+template <typename TensorType>
+BatchedPredictor<TensorType>::BatchedPredictor(ModelPtrType model, SizeType max_batch_size,
+                                               DurationType max_latency)
+  : model_(std::move(model))
+  , max_batch_size_(max_batch_size)
+  , max_latency_(max_latency)
+{
+  if (!model_ || max_batch_size_ == 0)
+  {
+    throw exceptions::InvalidInput("batched predictor requires a model and a batch size");
+  }
+
+  worker_ = std::thread([this]() { Run(); });
+}
+
+/**
+ * Runs every request still queued before stopping the worker
+ */
+template <typename TensorType>
+BatchedPredictor<TensorType>::~BatchedPredictor()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  condition_.notify_all();
+
+  worker_.join();
+}
+
+/**
+ * Queues an input for prediction
+ * @param input a tensor holding one or more samples along its trailing axis
+ * @return the future output of the model for the input, or the error of the batch it was run in
+ */
+template <typename TensorType>
+std::future<TensorType> BatchedPredictor<TensorType>::Predict(TensorType input)
+{
+  Request request;
+  request.input   = std::move(input);
+  request.arrival = ClockType::now();
+
+  auto result = request.output.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued_samples_ += BatchSize(request.input);
+    queue_.emplace_back(std::move(request));
+  }
+  condition_.notify_all();
+
+  return result;
+}
+
+/**
+ * @return the number of forward passes made
+ */
+template <typename TensorType>
+typename BatchedPredictor<TensorType>::SizeType BatchedPredictor<TensorType>::batches_run() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return batches_run_;
+}
+
+/**
+ * @return the number of samples passed to the model
+ */
+template <typename TensorType>
+typename BatchedPredictor<TensorType>::SizeType BatchedPredictor<TensorType>::samples_run() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return samples_run_;
+}
+
+template <typename TensorType>
+void BatchedPredictor<TensorType>::Run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true)
+  {
+    condition_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+    if (queue_.empty())
+    {
+      return;
+    }
+
+    // wait for the batch to fill, at most until the oldest request is due
+    auto const deadline = queue_.front().arrival + max_latency_;
+    condition_.wait_until(lock, deadline,
+                          [this]() { return !running_ || queued_samples_ >= max_batch_size_; });
+
+    // a single request larger than the batch size is run on its own
+    Requests batch;
+    SizeType samples{0};
+    while (!queue_.empty())
+    {
+      TensorType const &input = queue_.front().input;
+      SizeType const    size  = BatchSize(input);
+      if (!batch.empty() && ((samples + size > max_batch_size_) ||
+                             !SameSampleShape(batch.front().input, input)))
+      {
+        break;
+      }
+
+      samples += size;
+      batch.emplace_back(std::move(queue_.front()));
+      queue_.pop_front();
+    }
+    queued_samples_ -= samples;
+    ++batches_run_;
+    samples_run_ += samples;
+
+    lock.unlock();
+    RunBatch(batch);
+    lock.lock();
+  }
+}
+
+template <typename TensorType>
+void BatchedPredictor<TensorType>::RunBatch(Requests &batch)
+{
+  try
+  {
+    TensorType output;
+    if (batch.size() == 1)
+    {
+      model_->Predict(batch.front().input, output);
+      batch.front().output.set_value(std::move(output));
+      return;
+    }
+
+    std::vector<TensorType> inputs;
+    SizeVector              sizes;
+    inputs.reserve(batch.size());
+    sizes.reserve(batch.size());
+    for (auto const &request : batch)
+    {
+      inputs.emplace_back(request.input);
+      sizes.emplace_back(BatchSize(request.input));
+    }
+
+    SizeType const input_axis = inputs.front().shape().size() - 1;
+    TensorType     input      = TensorType::Concat(inputs, input_axis);
+    model_->Predict(input, output);
+
+    SizeType const output_axis = output.shape().size() - 1;
+    if (output.shape().empty() || (output.shape(output_axis) != input.shape(input_axis)))
+    {
+      throw exceptions::InvalidMode("model output has a different batch size to its input");
+    }
+
+    std::vector<TensorType> outputs = TensorType::Split(output, sizes, output_axis);
+    for (SizeType i = 0; i < batch.size(); ++i)
+    {
+      batch[i].output.set_value(std::move(outputs[i]));
+    }
+  }
+  catch (...)
+  {
+    // every request of a failed batch shares its error
+    for (auto &request : batch)
+    {
+      try
+      {
+        request.output.set_exception(std::current_exception());
+      }
+      catch (std::future_error const &)
+      {
+        // the result of this request had already been set
+      }
+    }
+  }
+}
+
+template <typename TensorType>
+typename BatchedPredictor<TensorType>::SizeType BatchedPredictor<TensorType>::BatchSize(
+    TensorType const &tensor)
+{
+  return tensor.shape().empty() ? 0 : tensor.shape().back();
+}
+
+template <typename TensorType>
+bool BatchedPredictor<TensorType>::SameSampleShape(TensorType const &a, TensorType const &b)
+{
+  SizeVector const &a_shape = a.shape();
+  SizeVector const &b_shape = b.shape();
+
+  return !a_shape.empty() && (a_shape.size() == b_shape.size()) &&
+         std::equal(a_shape.begin(), a_shape.end() - 1, b_shape.begin());
+}
+
+}  // namespace model
+}  // namespace ml
+}  // namespace fetch
@@ -26,6 +26,7 @@
 #include "ml/ops/metrics/types.hpp"
 #include "ml/optimisation/optimiser.hpp"
 #include "ml/optimisation/types.hpp"
+#include "ml/utilities/checkpoint.hpp"
 #include "ml/utilities/graph_builder.hpp"
 #include "ml/utilities/graph_saver.hpp"
 
@@ -475,6 +476,12 @@ void Model<TensorType>::TrainImplementation(DataType &loss, SizeType n_rounds)
                                       model_config_.graph_save_location + std::to_string(step));
     }
 
+    // the checkpoint is saved incrementally, only the weights which changed are written
+    if (this->model_config_.save_checkpoint)
+    {
+      fetch::ml::utilities::SaveCheckpoint(*graph_ptr_, model_config_.checkpoint_location);
+    }
+
     // run optimiser for one epoch (or subset)
     loss_ =
         optimiser_ptr_->Run(*dataloader_ptr_, model_config_.batch_size, model_config_.subset_size);
@@ -566,6 +573,8 @@ struct MapSerializer<ml::model::Model<TensorType>, D>
     case ml::LoaderType::W2V:
     case ml::LoaderType::COMMODITY:
     case ml::LoaderType::C2V:
+    case ml::LoaderType::PREFETCH:
+    case ml::LoaderType::MNIST:
     {
       throw ml::exceptions::NotImplemented(
           "Serialization for current dataloader type not implemented yet.");
@@ -633,6 +642,8 @@ struct MapSerializer<ml::model::Model<TensorType>, D>
     case ml::LoaderType::W2V:
     case ml::LoaderType::COMMODITY:
     case ml::LoaderType::C2V:
+    case ml::LoaderType::PREFETCH:
+    case ml::LoaderType::MNIST:
     {
       throw ml::exceptions::NotImplemented(
           "serialization for current dataloader type not implemented yet.");
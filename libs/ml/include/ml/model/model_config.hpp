@@ -41,6 +41,8 @@ struct ModelConfig
   bool        print_stats         = false;
   bool        save_graph          = false;
   std::string graph_save_location = "/tmp/graph";
+  bool        save_checkpoint     = false;
+  std::string checkpoint_location = "/tmp/checkpoint";
 
   ModelConfig()
   {
@@ -0,0 +1,627 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lcg.hpp"
+#include "math/base_types.hpp"
+#include "ml/dataloaders/word2vec_loaders/sgns_w2v_dataloader.hpp"
+#include "ml/dataloaders/word2vec_loaders/unigram_table.hpp"
+#include "ml/exceptions/exceptions.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace model {
+
+/**
+ * Trains skip-gram word2vec embeddings with negative sampling (SGNS) directly on the embedding
+ * tensors, without going through a graph.
+ *
+ * The corpus, vocabulary and unigram table of a GraphW2VLoader are used as they are, and the
+ * weights have the layout of the SkipGram layer: the input embeddings and the context embeddings
+ * both have the shape {embedding_size, vocab_size}, with one column per word. They can therefore
+ * be shared with the weights of a SkipGram graph, or be saved and tested with the word2vec
+ * utilities.
+ *
+ * Training is Hogwild style: the corpus is split between the threads, which update the shared
+ * weights without any locking. Concurrent updates of the same word may occasionally overwrite
+ * each other, which is harmless for the sparse updates of word2vec. Training on a single thread is
+ * deterministic.
+ *
+ * The loader must outlive the trainer, its unigram table is used in place.
+ */
+template <typename TensorType>
+class Word2VecTrainer
+{
+public:
+  using DataType   = typename TensorType::Type;
+  using SizeType   = fetch::math::SizeType;
+  using SizeVector = std::vector<SizeType>;
+  using LoaderType = dataloaders::GraphW2VLoader<TensorType>;
+
+  Word2VecTrainer(LoaderType const &loader, SizeType embedding_size, SizeType threads = 0,
+                  SizeType seed = 1337);
+  Word2VecTrainer(LoaderType const &loader, TensorType embeddings, TensorType context,
+                  SizeType threads = 0, SizeType seed = 1337);
+  Word2VecTrainer(Word2VecTrainer const &other) = delete;
+  Word2VecTrainer &operator=(Word2VecTrainer const &other) = delete;
+  ~Word2VecTrainer()                                       = default;
+
+  DataType Train(SizeType word_count, DataType starting_learning_rate,
+                 DataType ending_learning_rate);
+  void     Reset();
+  void     SetWeights(TensorType embeddings, TensorType context);
+
+  TensorType const &embeddings() const;
+  TensorType const &context() const;
+  SizeVector const &updated_embeddings_rows() const;
+  SizeVector const &updated_context_rows() const;
+
+  SizeType corpus_size() const;
+  SizeType words_trained() const;
+  SizeType epochs() const;
+  SizeType threads() const;
+
+private:
+  using RNGType = fetch::random::LinearCongruentialGenerator;
+
+  static constexpr SizeType SIGMOID_TABLE_SIZE   = 1024;
+  static constexpr double   SIGMOID_MAX          = 6.0;
+  static constexpr SizeType MIN_WORDS_PER_THREAD = 1024;
+
+  /**
+   * The state of a single training thread
+   */
+  struct Worker
+  {
+    RNGType               rng{};
+    std::vector<DataType> work{};
+    std::vector<uint8_t>  embeddings_updated{};
+    std::vector<uint8_t>  context_updated{};
+    double                loss{0};
+    SizeType              pairs{0};
+  };
+
+  void Build(LoaderType const &loader, SizeType threads);
+  void CheckWeights() const;
+  void TrainRange(Worker &worker, SizeType from, SizeType to, double progress_from,
+                  double progress_to, DataType starting_learning_rate,
+                  DataType ending_learning_rate);
+  void TrainPair(Worker &worker, DataType const *input, SizeType target, DataType label,
+                 DataType learning_rate);
+  void CollectUpdatedRows();
+
+  DataType *Column(TensorType &weights, SizeType word);
+
+  UnigramTable const &unigram_table_;
+  SizeType            window_size_;
+  SizeType            negative_samples_;
+  SizeType            vocab_size_;
+  SizeType            embedding_size_;
+  SizeType            seed_;
+
+  SizeVector          words_{};          // the corpus, as word indices
+  SizeVector          sentence_ends_{};  // the end of every sentence in words_
+  std::vector<double> keep_probability_{};
+
+  std::vector<DataType> sigmoid_{};
+  std::vector<double>   log_loss_{};  // -log(sigmoid(x))
+  DataType              sigmoid_max_;
+  DataType              sigmoid_scale_;
+
+  TensorType embeddings_;
+  TensorType context_;
+
+  std::vector<Worker>              workers_{};
+  std::unique_ptr<threading::Pool> pool_{};
+
+  SizeType   cursor_{0};
+  SizeType   words_trained_{0};
+  SizeType   epochs_{0};
+  SizeVector updated_embeddings_rows_{};
+  SizeVector updated_context_rows_{};
+};
+
+/**
+ * Trains new embeddings, initialised the same way as the original word2vec
+ * @param loader the loader holding the corpus, vocab and unigram table
+ * @param embedding_size the dimension of the embeddings
+ * @param threads the number of training threads, 0 uses every hardware thread
+ * @param seed the seed of the initialisation and sampling
+ */
+template <typename TensorType>
+Word2VecTrainer<TensorType>::Word2VecTrainer(LoaderType const &loader, SizeType embedding_size,
+                                             SizeType threads, SizeType seed)
+  : unigram_table_(loader.GetUnigramTable())
+  , vocab_size_(loader.vocab_size())
+  , embedding_size_(embedding_size)
+  , seed_(seed)
+  , embeddings_({embedding_size, loader.vocab_size()})
+  , context_({embedding_size, loader.vocab_size()})
+{
+  Build(loader, threads);
+
+  // the context embeddings start at zero
+  RNGType rng;
+  rng.Seed(seed_);
+  auto const scale = static_cast<double>(embedding_size_);
+  for (SizeType word = 0; word < vocab_size_; ++word)
+  {
+    DataType *column = Column(embeddings_, word);
+    for (SizeType i = 0; i < embedding_size_; ++i)
+    {
+      column[i] = fetch::math::AsType<DataType>((rng.AsDouble() - 0.5) / scale);
+    }
+  }
+}
+
+/**
+ * Trains existing embeddings, e.g. the weights of a SkipGram layer. The weights are updated in
+ * place.
+ * @param loader the loader holding the corpus, vocab and unigram table
+ * @param embeddings the input embeddings, of shape {embedding_size, vocab_size}
+ * @param context the context embeddings, of shape {embedding_size, vocab_size}
+ * @param threads the number of training threads, 0 uses every hardware thread
+ * @param seed the seed of the sampling
+ */
+template <typename TensorType>
+Word2VecTrainer<TensorType>::Word2VecTrainer(LoaderType const &loader, TensorType embeddings,
+                                             TensorType context, SizeType threads, SizeType seed)
+  : unigram_table_(loader.GetUnigramTable())
+  , vocab_size_(loader.vocab_size())
+  , embedding_size_(embeddings.shape().at(0))
+  , seed_(seed)
+  , embeddings_(std::move(embeddings))
+  , context_(std::move(context))
+{
+  CheckWeights();
+  Build(loader, threads);
+}
+
+/**
+ * Trains on the next words of the corpus, continuing where the last call stopped and starting over
+ * at the end of the corpus. The learning rate decays linearly over the words trained on.
+ * @param word_count the number of words to train on
+ * @param starting_learning_rate the learning rate of the first word
+ * @param ending_learning_rate the learning rate of the last word
+ * @return the mean loss of the word/context pairs trained on
+ */
+template <typename TensorType>
+typename Word2VecTrainer<TensorType>::DataType Word2VecTrainer<TensorType>::Train(
+    SizeType word_count, DataType starting_learning_rate, DataType ending_learning_rate)
+{
+  for (auto &worker : workers_)
+  {
+    worker.loss  = 0;
+    worker.pairs = 0;
+  }
+
+  if (words_.empty())
+  {
+    return DataType{0};
+  }
+
+  SizeType done = 0;
+  while (done < word_count)
+  {
+    SizeType const from   = cursor_;
+    SizeType const length = std::min(word_count - done, words_.size() - from);
+
+    SizeType const num_threads =
+        std::max<SizeType>(1, std::min(workers_.size(), length / MIN_WORDS_PER_THREAD));
+    SizeType const step = (length + num_threads - 1) / num_threads;
+
+    auto const run = [this, from, length, step, done, word_count, starting_learning_rate,
+                      ending_learning_rate](SizeType thread) {
+      SizeType const begin = std::min(thread * step, length);
+      SizeType const end   = std::min(begin + step, length);
+
+      // the threads advance together, so each one decays the learning rate over the whole segment
+      auto const total = static_cast<double>(word_count);
+      TrainRange(workers_[thread], from + begin, from + end, static_cast<double>(done) / total,
+                 static_cast<double>(done + length) / total, starting_learning_rate,
+                 ending_learning_rate);
+    };
+
+    std::vector<std::future<void>> tasks{};
+    tasks.reserve(num_threads - 1);
+    for (SizeType thread = 1; thread < num_threads; ++thread)
+    {
+      tasks.emplace_back(pool_->Dispatch(run, thread));
+    }
+
+    run(0);
+
+    for (auto &pending : tasks)
+    {
+      pending.get();
+    }
+
+    done += length;
+    cursor_ += length;
+    if (cursor_ == words_.size())
+    {
+      cursor_ = 0;
+      ++epochs_;
+    }
+  }
+  words_trained_ += word_count;
+
+  CollectUpdatedRows();
+
+  double   loss  = 0;
+  SizeType pairs = 0;
+  for (auto const &worker : workers_)
+  {
+    loss += worker.loss;
+    pairs += worker.pairs;
+  }
+
+  return (pairs == 0) ? DataType{0}
+                      : fetch::math::AsType<DataType>(loss / static_cast<double>(pairs));
+}
+
+/**
+ * Restarts training at the beginning of the corpus with the initial random state, the weights are
+ * unchanged
+ */
+template <typename TensorType>
+void Word2VecTrainer<TensorType>::Reset()
+{
+  for (SizeType thread = 0; thread < workers_.size(); ++thread)
+  {
+    workers_[thread].rng.Seed(seed_ + thread + 1);
+  }
+
+  cursor_        = 0;
+  words_trained_ = 0;
+  epochs_        = 0;
+}
+
+/**
+ * Replaces the weights trained, which are used in place
+ * @param embeddings the input embeddings, of shape {embedding_size, vocab_size}
+ * @param context the context embeddings, of shape {embedding_size, vocab_size}
+ */
+template <typename TensorType>
+void Word2VecTrainer<TensorType>::SetWeights(TensorType embeddings, TensorType context)
+{
+  embeddings_ = std::move(embeddings);
+  context_    = std::move(context);
+  CheckWeights();
+}
+
+template <typename TensorType>
+TensorType const &Word2VecTrainer<TensorType>::embeddings() const
+{
+  return embeddings_;
+}
+
+template <typename TensorType>
+TensorType const &Word2VecTrainer<TensorType>::context() const
+{
+  return context_;
+}
+
+/**
+ * @return the columns of the input embeddings updated by the last call to Train, in order
+ */
+template <typename TensorType>
+typename Word2VecTrainer<TensorType>::SizeVector const &
+Word2VecTrainer<TensorType>::updated_embeddings_rows() const
+{
+  return updated_embeddings_rows_;
+}
+
+/**
+ * @return the columns of the context embeddings updated by the last call to Train, in order
+ */
+template <typename TensorType>
+typename Word2VecTrainer<TensorType>::SizeVector const &
+Word2VecTrainer<TensorType>::updated_context_rows() const
+{
+  return updated_context_rows_;
+}
+
+/**
+ * @return the number of words in the corpus, which is the number of words of an epoch
+ */
+template <typename TensorType>
+typename Word2VecTrainer<TensorType>::SizeType Word2VecTrainer<TensorType>::corpus_size() const
+{
+  return words_.size();
+}
+
+template <typename TensorType>
+typename Word2VecTrainer<TensorType>::SizeType Word2VecTrainer<TensorType>::words_trained() const
+{
+  return words_trained_;
+}
+
+template <typename TensorType>
+typename Word2VecTrainer<TensorType>::SizeType Word2VecTrainer<TensorType>::epochs() const
+{
+  return epochs_;
+}
+
+template <typename TensorType>
+typename Word2VecTrainer<TensorType>::SizeType Word2VecTrainer<TensorType>::threads() const
+{
+  return workers_.size();
+}
+
+template <typename TensorType>
+void Word2VecTrainer<TensorType>::Build(LoaderType const &loader, SizeType threads)
+{
+  window_size_      = loader.WindowSize();
+  negative_samples_ = loader.NegativeSamples();
+
+  for (auto const &sentence : loader.GetData())
+  {
+    words_.insert(words_.end(), sentence.begin(), sentence.end());
+    sentence_ends_.emplace_back(words_.size());
+  }
+
+  // words are kept with a probability of sqrt(thresh / freq), as in the loader
+  auto const &counts    = loader.GetWordCounts();
+  auto const  thresh    = static_cast<double>(loader.FreqThresh());
+  auto const  total     = static_cast<double>(std::max<SizeType>(words_.size(), 1));
+  keep_probability_.assign(vocab_size_, 1.0);
+  for (SizeType word = 0; word < std::min(counts.size(), vocab_size_); ++word)
+  {
+    auto const freq = static_cast<double>(counts[word]) / total;
+    if (freq > thresh)
+    {
+      keep_probability_[word] = std::sqrt(thresh / freq);
+    }
+  }
+
+  sigmoid_.resize(SIGMOID_TABLE_SIZE);
+  log_loss_.resize(SIGMOID_TABLE_SIZE);
+  for (SizeType i = 0; i < SIGMOID_TABLE_SIZE; ++i)
+  {
+    double const x =
+        (2.0 * (static_cast<double>(i) + 0.5) / SIGMOID_TABLE_SIZE - 1.0) * SIGMOID_MAX;
+    double const sigmoid = 1.0 / (1.0 + std::exp(-x));
+
+    sigmoid_[i]  = fetch::math::AsType<DataType>(sigmoid);
+    log_loss_[i] = -std::log(sigmoid);
+  }
+  sigmoid_max_   = fetch::math::AsType<DataType>(SIGMOID_MAX);
+  sigmoid_scale_ = fetch::math::AsType<DataType>(SIGMOID_TABLE_SIZE / (2.0 * SIGMOID_MAX));
+
+  if (threads == 0)
+  {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  workers_.resize(threads);
+  for (auto &worker : workers_)
+  {
+    worker.work.resize(embedding_size_);
+    worker.embeddings_updated.assign(vocab_size_, 0);
+    worker.context_updated.assign(vocab_size_, 0);
+  }
+  Reset();
+
+  // the calling thread trains too
+  if (threads > 1)
+  {
+    pool_ = std::make_unique<threading::Pool>(threads - 1, "Word2Vec");
+  }
+}
+
+template <typename TensorType>
+void Word2VecTrainer<TensorType>::CheckWeights() const
+{
+  SizeVector const shape{embedding_size_, vocab_size_};
+  if ((embeddings_.shape() != shape) || (context_.shape() != shape))
+  {
+    throw exceptions::InvalidInput(
+        "Word2VecTrainer weights must have the shape {embedding_size, vocab_size}");
+  }
+}
+
+/**
+ * Trains on a part of the corpus
+ * @param worker the state of the thread
+ * @param from the first word of the corpus to train on
+ * @param to one past the last word of the corpus to train on
+ * @param progress_from the fraction of the call to Train done at the first word
+ * @param progress_to the fraction of the call to Train done after the last word
+ */
+template <typename TensorType>
+void Word2VecTrainer<TensorType>::TrainRange(Worker &worker, SizeType from, SizeType to,
+                                             double progress_from, double progress_to,
+                                             DataType starting_learning_rate,
+                                             DataType ending_learning_rate)
+{
+  if (from >= to)
+  {
+    return;
+  }
+
+  auto sentence = static_cast<SizeType>(
+      std::upper_bound(sentence_ends_.begin(), sentence_ends_.end(), from) -
+      sentence_ends_.begin());
+  SizeType begin = (sentence == 0) ? 0 : sentence_ends_[sentence - 1];
+
+  auto const progress_step = (progress_to - progress_from) / static_cast<double>(to - from);
+
+  for (SizeType position = from; position < to; ++position)
+  {
+    while (position >= sentence_ends_[sentence])
+    {
+      begin = sentence_ends_[sentence];
+      ++sentence;
+    }
+    SizeType const end  = sentence_ends_[sentence];
+    SizeType const word = words_[position];
+
+    // subsample frequent words
+    if (worker.rng.AsDouble() > keep_probability_[word])
+    {
+      continue;
+    }
+
+    auto const progress = progress_from + progress_step * static_cast<double>(position - from);
+    DataType const learning_rate =
+        starting_learning_rate + (ending_learning_rate - starting_learning_rate) *
+                                     fetch::math::AsType<DataType>(std::min(progress, 1.0));
+
+    // select a random window size, the context is limited to the sentence
+    SizeType const window  = SizeType{worker.rng()} % window_size_ + 1;
+    SizeType const first   = std::max(position, begin + window) - window;
+    SizeType const last    = std::min(position + window + 1, end);
+    DataType *     input   = Column(embeddings_, word);
+    auto &         work    = worker.work;
+    bool           updated = false;
+
+    for (SizeType context = first; context < last; ++context)
+    {
+      if (context == position)
+      {
+        continue;
+      }
+
+      std::fill(work.begin(), work.end(), DataType{0});
+
+      SizeType const positive = words_[context];
+      TrainPair(worker, input, positive, DataType{1}, learning_rate);
+
+      for (SizeType i = 0; i < negative_samples_; ++i)
+      {
+        SizeType negative;
+        if (unigram_table_.SampleNegative(positive, negative, worker.rng))
+        {
+          TrainPair(worker, input, negative, DataType{0}, learning_rate);
+        }
+      }
+
+      for (SizeType i = 0; i < embedding_size_; ++i)
+      {
+        input[i] += work[i];
+      }
+      updated = true;
+    }
+
+    if (updated)
+    {
+      worker.embeddings_updated[word] = 1;
+    }
+  }
+}
+
+/**
+ * A single step of logistic regression of a context word given the input embedding. The update
+ * of the input embedding is accumulated in the work buffer of the worker.
+ */
+template <typename TensorType>
+void Word2VecTrainer<TensorType>::TrainPair(Worker &worker, DataType const *input,
+                                            SizeType target, DataType label,
+                                            DataType learning_rate)
+{
+  DataType *output = Column(context_, target);
+
+  DataType f{0};
+  for (SizeType i = 0; i < embedding_size_; ++i)
+  {
+    f += input[i] * output[i];
+  }
+
+  SizeType index;
+  DataType sigmoid;
+  if (f >= sigmoid_max_)
+  {
+    index   = SIGMOID_TABLE_SIZE - 1;
+    sigmoid = DataType{1};
+  }
+  else if (f <= -sigmoid_max_)
+  {
+    index   = 0;
+    sigmoid = DataType{0};
+  }
+  else
+  {
+    index   = std::min(static_cast<SizeType>((f + sigmoid_max_) * sigmoid_scale_),
+                     SIGMOID_TABLE_SIZE - 1);
+    sigmoid = sigmoid_[index];
+  }
+
+  // -log(1 - sigmoid(x)) is -log(sigmoid(-x))
+  worker.loss += log_loss_[(label > DataType{0}) ? index : SIGMOID_TABLE_SIZE - 1 - index];
+  ++worker.pairs;
+
+  DataType const g = (label - sigmoid) * learning_rate;
+  for (SizeType i = 0; i < embedding_size_; ++i)
+  {
+    worker.work[i] += g * output[i];
+    output[i] += g * input[i];
+  }
+
+  worker.context_updated[target] = 1;
+}
+
+template <typename TensorType>
+void Word2VecTrainer<TensorType>::CollectUpdatedRows()
+{
+  updated_embeddings_rows_.clear();
+  updated_context_rows_.clear();
+
+  for (SizeType word = 0; word < vocab_size_; ++word)
+  {
+    bool embeddings_updated = false;
+    bool context_updated    = false;
+    for (auto &worker : workers_)
+    {
+      embeddings_updated = embeddings_updated || (worker.embeddings_updated[word] != 0);
+      context_updated    = context_updated || (worker.context_updated[word] != 0);
+
+      worker.embeddings_updated[word] = 0;
+      worker.context_updated[word]    = 0;
+    }
+
+    if (embeddings_updated)
+    {
+      updated_embeddings_rows_.emplace_back(word);
+    }
+    if (context_updated)
+    {
+      updated_context_rows_.emplace_back(word);
+    }
+  }
+}
+
+template <typename TensorType>
+typename Word2VecTrainer<TensorType>::DataType *Word2VecTrainer<TensorType>::Column(
+    TensorType &weights, SizeType word)
+{
+  return weights.data().pointer() + word * weights.padded_height();
+}
+
+}  // namespace model
+}  // namespace ml
+}  // namespace fetch
@@ -23,6 +23,7 @@
 #include "math/matrix_operations.hpp"
 #include "ml/ops/ops.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
@@ -147,6 +148,28 @@ public:
     return inputs.front()->shape();
   }
 
+  /**
+   * Dropout is only fused outside of training, where it leaves its input unchanged
+   */
+  bool IsElementwise() const override
+  {
+    return true;
+  }
+
+  void ForwardRange(VecTensorType const &inputs, TensorType &output, SizeType begin,
+                    SizeType end) override
+  {
+    assert(inputs.size() == 1);
+    assert(!this->is_training_);
+    DataType const *input = inputs.front()->data().pointer();
+    DataType *      ret   = output.data().pointer();
+
+    if (input != ret)
+    {
+      std::copy(input + begin, input + end, ret + begin);
+    }
+  }
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_DROPOUT;
@@ -117,6 +117,31 @@ public:
     return inputs.front()->shape();
   }
 
+  bool IsElementwise() const override
+  {
+    return true;
+  }
+
+  void ForwardRange(VecTensorType const &inputs, TensorType &output, SizeType begin,
+                    SizeType end) override
+  {
+    assert(inputs.size() == 1);
+    DataType const *input = inputs.front()->data().pointer();
+    DataType *      ret   = output.data().pointer();
+
+    for (SizeType i = begin; i < end; ++i)
+    {
+      if (input[i] >= DataType{0})
+      {
+        ret[i] = input[i];
+      }
+      else
+      {
+        fetch::math::Multiply(a_, input[i], ret[i]);
+      }
+    }
+  }
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_LEAKY_RELU;
@@ -114,6 +114,29 @@ public:
     return inputs.front()->shape();
   }
 
+  bool SupportsInPlace() const override
+  {
+    return true;
+  }
+
+  bool IsElementwise() const override
+  {
+    return true;
+  }
+
+  void ForwardRange(VecTensorType const &inputs, TensorType &output, SizeType begin,
+                    SizeType end) override
+  {
+    assert(inputs.size() == 1);
+    DataType const *input = inputs.front()->data().pointer();
+    DataType *      ret   = output.data().pointer();
+
+    for (SizeType i = begin; i < end; ++i)
+    {
+      ret[i] = fetch::vectorise::Max(input[i], DataType{0});
+    }
+  }
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_RELU;
@@ -99,6 +99,32 @@ public:
     return inputs.front()->shape();
   }
 
+  bool SupportsInPlace() const override
+  {
+    return true;
+  }
+
+  bool IsElementwise() const override
+  {
+    return true;
+  }
+
+  void ForwardRange(VecTensorType const &inputs, TensorType &output, SizeType begin,
+                    SizeType end) override
+  {
+    assert(inputs.size() == 1);
+    DataType const *input = inputs.front()->data().pointer();
+    DataType *      ret   = output.data().pointer();
+
+    fetch::math::kernels::Sigmoid sigmoid;
+    DataType const                max_value = DataType{1} - epsilon_;
+    for (SizeType i = begin; i < end; ++i)
+    {
+      sigmoid(input[i], ret[i]);
+      ret[i] = fetch::vectorise::Min(fetch::vectorise::Max(ret[i], epsilon_), max_value);
+    }
+  }
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_SIGMOID;
@@ -39,6 +39,7 @@ class Add : public Ops<T>
 {
 public:
   using TensorType    = T;
+  using DataType      = typename TensorType::Type;
   using SizeType      = math::SizeType;
   using VecTensorType = typename Ops<T>::VecTensorType;
   using SPType        = OpAddSaveableParams<T>;
@@ -64,6 +65,12 @@ public:
 
   std::vector<SizeType> ComputeOutputShape(VecTensorType const &inputs) const override;
 
+  bool SupportsInPlace() const override;
+  bool IsElementwise() const override;
+  bool SupportsForwardRange(VecTensorType const &inputs) const override;
+  void ForwardRange(VecTensorType const &inputs, TensorType &output, SizeType begin,
+                    SizeType end) override;
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_ADD;
@@ -20,6 +20,7 @@
 #include "ml/ops/ops.hpp"
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -27,6 +28,10 @@ namespace fetch {
 namespace ml {
 namespace ops {
 
+// The maximum number of threads used to split the batch of a convolution (1 by default)
+void        SetConvolutionConcurrency(std::size_t concurrency);
+std::size_t ConvolutionConcurrency();
+
 template <class T>
 class Convolution2D : public Ops<T>
 {
@@ -49,6 +54,12 @@ public:
     stride_size_ = sp.stride_size;
   }
 
+  // the workspaces are not copied since tensors share their data
+  Convolution2D(Convolution2D const &other)
+    : Ops<T>(other)
+    , stride_size_(other.stride_size_)
+  {}
+
   ~Convolution2D() override = default;
 
   std::shared_ptr<OpsSaveableParams> GetOpSaveableParams() override;
@@ -70,7 +81,20 @@ public:
   }
   static constexpr char const *DESCRIPTOR = "Convolution2D";
 
+  /// The minimum number of output pixels for which the Winograd kernel is used
+  static constexpr SizeType MIN_WINOGRAD_OUTPUT_SIZE = 64;
+
+  static bool IsWinograd(SizeType stride_size, SizeType kernel_height, SizeType kernel_width,
+                         SizeType output_height, SizeType output_width);
+
 private:
+  static constexpr SizeType WINOGRAD_TILE  = 2;   ///< The size of the output tiles F(2x2, 3x3)
+  static constexpr SizeType WINOGRAD_INPUT = 4;   ///< The size of the input tiles
+  static constexpr SizeType WINOGRAD_SIZE  = 16;  ///< The number of elements in an input tile
+
+  void ForwardWinograd(TensorType const &input, TensorType const &kernels, TensorType &output);
+
+  static void PrepareWorkspace(TensorType &workspace, std::vector<SizeType> const &shape);
   void FillVerticalStride(TensorType &input, TensorType &vertical_stride, SizeType output_channels,
                           SizeType input_channels, SizeType kernel_height, SizeType kernel_width);
 
@@ -95,6 +119,20 @@ private:
                          SizeType batch_size);
 
   SizeType stride_size_;
+
+  /// @name Workspaces
+  /// Reused across iterations while the input shapes are unchanged (never shared between copies)
+  /// @{
+  TensorType              horizontal_stride_{};
+  TensorType              vertical_stride_{};
+  TensorType              gemm_output_{};
+  TensorType              error_{};
+  TensorType              error1_{};
+  TensorType              error2_{};
+  std::vector<TensorType> winograd_kernels_{};
+  std::vector<TensorType> winograd_inputs_{};
+  std::vector<TensorType> winograd_outputs_{};
+  /// @}
 };
 
 }  // namespace ops
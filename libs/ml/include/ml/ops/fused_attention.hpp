@@ -0,0 +1,399 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lfg.hpp"
+#include "math/base_types.hpp"
+#include "math/standard_functions/exp.hpp"
+#include "math/standard_functions/sqrt.hpp"
+#include "ml/ops/ops.hpp"
+#include "ml/saveparams/saveable_params.hpp"
+
+#include <cassert>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace ops {
+
+/**
+ * Scaled dot product attention, softmax(mask_fill(K^T Q / sqrt(dk))) followed by dropout and the
+ * product with V, computed one query at a time.
+ *
+ * The composed operations materialise several (key_num, query_num, batch_num) tensors, this
+ * operation only keeps a single row of scores and the maximum and sum of the exponentials of
+ * every row. The backward pass recomputes the scores from these, and replays the dropout from the
+ * state its random number generator had in the forward pass. The arithmetic is the same as the
+ * one of the composed operations, so the results agree for fixed point types as well.
+ *
+ * inputs are the query (dk, query_num, batch_num), key (dk, key_num, batch_num), value
+ * (dv, key_num, batch_num) and mask, each dimension of the mask is either 1 or the one of the
+ * scores. The output has the shape (dv, query_num, batch_num).
+ */
+template <class T>
+class FusedAttention : public Ops<T>
+{
+public:
+  using TensorType    = T;
+  using DataType      = typename TensorType::Type;
+  using SizeType      = fetch::math::SizeType;
+  using SizeVector    = std::vector<SizeType>;
+  using RNG           = fetch::random::LaggedFibonacciGenerator<>;
+  using VecTensorType = typename Ops<T>::VecTensorType;
+  using SPType        = OpFusedAttentionSaveableParams<TensorType>;
+  using MyType        = FusedAttention<TensorType>;
+
+  explicit FusedAttention(SizeType key_dim, DataType dropout_probability = DataType{1},
+                          DataType fill_value = DataType{-1000000000},
+                          SizeType random_seed = 25102015)
+    : key_dim_(key_dim)
+    , probability_(dropout_probability)
+    , fill_value_(fill_value)
+  {
+    if (probability_ < DataType{0} || probability_ > DataType{1})
+    {
+      std::stringstream ss;
+      ss << probability_;
+      throw std::runtime_error("Dropout probability " + ss.str() +
+                               " is out of allowed range [0..1]");
+    }
+    rng_.Seed(random_seed);
+  }
+
+  explicit FusedAttention(SPType const &sp)
+    : Ops<T>(sp)
+  {
+    key_dim_     = sp.key_dim;
+    probability_ = sp.probability;
+    fill_value_  = sp.fill_value;
+    rng_.Seed(sp.random_seed);
+    rng_.SetBuffer(sp.buffer);
+    rng_.SetIndex(sp.index);
+  }
+
+  ~FusedAttention() override = default;
+
+  std::shared_ptr<OpsSaveableParams> GetOpSaveableParams() override
+  {
+    auto sp         = std::make_shared<SPType>();
+    sp->key_dim     = key_dim_;
+    sp->probability = probability_;
+    sp->fill_value  = fill_value_;
+    sp->random_seed = rng_.Seed();
+    sp->buffer      = rng_.GetBuffer();
+    sp->index       = rng_.GetIndex();
+    return sp;
+  }
+
+  std::shared_ptr<fetch::ml::ops::Ops<TensorType>> MakeSharedCopy(
+      std::shared_ptr<fetch::ml::ops::Ops<TensorType>> me) override
+  {
+    assert(me.get() == this);
+
+    return me;
+  }
+
+  void Forward(VecTensorType const &inputs, TensorType &output) override
+  {
+    assert(inputs.size() == 4);
+    assert(output.shape() == this->ComputeOutputShape(inputs));
+
+    forward_rng_ = rng_;
+    rows_        = Rows(inputs);
+    row_max_     = TensorType({rows_.query_num, rows_.batch_num});
+    row_sum_     = TensorType({rows_.query_num, rows_.batch_num});
+
+    output.Fill(DataType{0});
+
+    DataType *       out        = output.data().pointer();
+    SizeVector const out_stride = output.stride();
+
+    for (SizeType b = 0; b < rows_.batch_num; ++b)
+    {
+      for (SizeType q = 0; q < rows_.query_num; ++q)
+      {
+        DataType row_max = fetch::math::numeric_lowest<DataType>();
+        DataType row_sum = DataType{0};
+        Scores(inputs, q, b, row_max, row_sum);
+
+        row_max_(q, b) = row_max;
+        row_sum_(q, b) = row_sum;
+
+        DataType *out_column = out + q * out_stride[1] + b * out_stride[2];
+        for (SizeType k = 0; k < rows_.key_num; ++k)
+        {
+          DataType const weight = Weight(scores_[k], row_max, row_sum) * Keep(rng_);
+          if (weight == DataType{0})
+          {
+            continue;
+          }
+
+          DataType const *value_column = Column(*inputs.at(2), k, b);
+          for (SizeType i = 0; i < rows_.value_dim; ++i)
+          {
+            out_column[i] += value_column[i] * weight;
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<TensorType> Backward(VecTensorType const &inputs,
+                                   TensorType const &   error_signal) override
+  {
+    assert(inputs.size() == 4);
+    assert(error_signal.shape() == this->ComputeOutputShape(inputs));
+
+    // the statistics of the rows are those of the last forward pass, redo it for other inputs
+    Rows const rows = Rows(inputs);
+    if ((row_max_.shape() != SizeVector{rows.query_num, rows.batch_num}) ||
+        (rows.key_num != rows_.key_num))
+    {
+      TensorType output(this->ComputeOutputShape(inputs));
+      Forward(inputs, output);
+    }
+
+    TensorType query_grad(inputs.at(0)->shape());
+    TensorType key_grad(inputs.at(1)->shape());
+    TensorType value_grad(inputs.at(2)->shape());
+    TensorType mask_grad(inputs.at(3)->shape());
+
+    DataType const * error        = error_signal.data().pointer();
+    SizeVector const error_stride = error_signal.stride();
+
+    std::vector<DataType> weights(rows_.key_num);
+    std::vector<DataType> keeps(rows_.key_num);
+    std::vector<DataType> grads(rows_.key_num);
+
+    RNG            rng     = forward_rng_;
+    DataType const sqrt_dk = fetch::math::Sqrt(static_cast<DataType>(key_dim_));
+
+    for (SizeType b = 0; b < rows_.batch_num; ++b)
+    {
+      for (SizeType q = 0; q < rows_.query_num; ++q)
+      {
+        DataType const row_max = row_max_(q, b);
+        DataType const row_sum = row_sum_(q, b);
+        ScaledScores(inputs, q, b);
+
+        DataType const *error_column = error + q * error_stride[1] + b * error_stride[2];
+
+        // gradient of the dropout and of the product with the values
+        DataType total{0};
+        for (SizeType k = 0; k < rows_.key_num; ++k)
+        {
+          weights[k] = Weight(MaskFill(*inputs.at(3), scores_[k], k, q, b), row_max, row_sum);
+          keeps[k]   = Keep(rng);
+
+          DataType const  dropped           = weights[k] * keeps[k];
+          DataType const *value_column      = Column(*inputs.at(2), k, b);
+          DataType *      value_grad_column = MutableColumn(value_grad, k, b);
+
+          DataType grad{0};
+          for (SizeType i = 0; i < rows_.value_dim; ++i)
+          {
+            value_grad_column[i] += error_column[i] * dropped;
+            grad += error_column[i] * value_column[i];
+          }
+
+          grads[k] = grad * keeps[k] * weights[k];
+          total += grads[k];
+        }
+
+        // gradient of the softmax, the mask fill and the scaling
+        DataType const *query_column      = Column(*inputs.at(0), q, b);
+        DataType *      query_grad_column = MutableColumn(query_grad, q, b);
+        for (SizeType k = 0; k < rows_.key_num; ++k)
+        {
+          DataType score_grad = grads[k] - weights[k] * total;
+          score_grad          = MaskAt(*inputs.at(3), k, q, b) * score_grad / sqrt_dk;
+
+          DataType const *key_column      = Column(*inputs.at(1), k, b);
+          DataType *      key_grad_column = MutableColumn(key_grad, k, b);
+          for (SizeType i = 0; i < rows_.key_dim; ++i)
+          {
+            query_grad_column[i] += key_column[i] * score_grad;
+            key_grad_column[i] += query_column[i] * score_grad;
+          }
+        }
+      }
+    }
+
+    // it is not reasonable to return a gradient for the mask, it is left at zero
+    return {query_grad, key_grad, value_grad, mask_grad};
+  }
+
+  std::vector<SizeType> ComputeOutputShape(VecTensorType const &inputs) const override
+  {
+    return {inputs.at(2)->shape(0), inputs.at(0)->shape(1), inputs.at(0)->shape(2)};
+  }
+
+  static constexpr OpType OpCode()
+  {
+    return OpType::OP_FUSED_ATTENTION;
+  }
+
+  static constexpr char const *DESCRIPTOR = "FusedAttention";
+
+private:
+  struct Rows
+  {
+    Rows() = default;
+
+    explicit Rows(VecTensorType const &inputs)
+      : key_dim(inputs.at(0)->shape(0))
+      , value_dim(inputs.at(2)->shape(0))
+      , query_num(inputs.at(0)->shape(1))
+      , key_num(inputs.at(1)->shape(1))
+      , batch_num(inputs.at(0)->shape(2))
+    {
+      assert(inputs.at(0)->shape().size() == 3);
+      assert(inputs.at(1)->shape() == SizeVector({key_dim, key_num, batch_num}));
+      assert(inputs.at(2)->shape() == SizeVector({value_dim, key_num, batch_num}));
+      assert(inputs.at(3)->shape().size() == 3);
+    }
+
+    SizeType key_dim{};
+    SizeType value_dim{};
+    SizeType query_num{};
+    SizeType key_num{};
+    SizeType batch_num{};
+  };
+
+  static DataType const *Column(TensorType const &tensor, SizeType column, SizeType batch)
+  {
+    return tensor.data().pointer() + column * tensor.stride()[1] + batch * tensor.stride()[2];
+  }
+
+  static DataType *MutableColumn(TensorType &tensor, SizeType column, SizeType batch)
+  {
+    return tensor.data().pointer() + column * tensor.stride()[1] + batch * tensor.stride()[2];
+  }
+
+  /**
+   * The mask at a position of the scores, broadcasting the dimensions of size 1
+   */
+  static DataType MaskAt(TensorType const &mask, SizeType k, SizeType q, SizeType b)
+  {
+    return mask((mask.shape(0) == 1) ? 0 : k, (mask.shape(1) == 1) ? 0 : q,
+                (mask.shape(2) == 1) ? 0 : b);
+  }
+
+  DataType MaskFill(TensorType const &mask, DataType score, SizeType k, SizeType q,
+                    SizeType b) const
+  {
+    DataType const m = MaskAt(mask, k, q, b);
+    return m * score + (DataType{1} - m) * fill_value_;
+  }
+
+  /**
+   * Fills scores_ with the column of K^T Q / sqrt(dk) for a query, before masking
+   */
+  void ScaledScores(VecTensorType const &inputs, SizeType q, SizeType b)
+  {
+    DataType const sqrt_dk = fetch::math::Sqrt(static_cast<DataType>(key_dim_));
+
+    scores_.resize(rows_.key_num);
+
+    DataType const *query_column = Column(*inputs.at(0), q, b);
+    for (SizeType k = 0; k < rows_.key_num; ++k)
+    {
+      DataType const *key_column = Column(*inputs.at(1), k, b);
+
+      DataType score{0};
+      for (SizeType i = 0; i < rows_.key_dim; ++i)
+      {
+        score += key_column[i] * query_column[i];
+      }
+      scores_[k] = score / sqrt_dk;
+    }
+  }
+
+  /**
+   * Fills scores_ with the masked scores of a query and computes the statistics of its softmax
+   */
+  void Scores(VecTensorType const &inputs, SizeType q, SizeType b, DataType &row_max,
+              DataType &row_sum)
+  {
+    ScaledScores(inputs, q, b);
+
+    for (SizeType k = 0; k < rows_.key_num; ++k)
+    {
+      scores_[k] = MaskFill(*inputs.at(3), scores_[k], k, q, b);
+      if (scores_[k] > row_max)
+      {
+        row_max = scores_[k];
+      }
+    }
+
+    for (SizeType k = 0; k < rows_.key_num; ++k)
+    {
+      row_sum += fetch::math::Exp(scores_[k] - row_max);
+    }
+  }
+
+  /**
+   * The softmax of a masked score, clamped like the Softmax operation
+   */
+  static DataType Weight(DataType score, DataType row_max, DataType row_sum)
+  {
+    DataType const epsilon = fetch::math::numeric_min<DataType>();
+    DataType const weight  = fetch::math::Exp(score - row_max) / row_sum;
+
+    if (weight < epsilon)
+    {
+      return epsilon;
+    }
+    if (weight > DataType{1} - epsilon)
+    {
+      return DataType{1} - epsilon;
+    }
+    return weight;
+  }
+
+  /**
+   * The dropout factor of the next weight, drawn in the same order as by the Dropout operation
+   */
+  DataType Keep(RNG &rng) const
+  {
+    if (!this->is_training_)
+    {
+      return DataType{1};
+    }
+
+    return (rng.AsType<DataType>() <= probability_) ? DataType{1} / probability_ : DataType{0};
+  }
+
+  SizeType key_dim_{};
+  DataType probability_{};
+  DataType fill_value_{};
+  RNG      rng_;
+  RNG      forward_rng_;
+
+  Rows                  rows_{};
+  TensorType            row_max_{};
+  TensorType            row_sum_{};
+  std::vector<DataType> scores_{};
+};
+
+}  // namespace ops
+}  // namespace ml
+}  // namespace fetch
@@ -24,6 +24,7 @@
 
 #include <cassert>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace fetch {
@@ -77,18 +78,12 @@ public:
 
     auto copyshare = std::make_shared<MyType>(*this);
 
-    copyshare->error_signal_1_       = error_signal_1_.Copy();
-    copyshare->error_signal_2_       = error_signal_2_.Copy();
-    copyshare->output_view_tensor_   = output_view_tensor_.Copy();
-    copyshare->fwd_in1_view_tensor_  = fwd_in1_view_tensor_.Copy();
-    copyshare->fwd_in2_view_tensor_  = fwd_in2_view_tensor_.Copy();
-    copyshare->back_in1_view_tensor_ = back_in1_view_tensor_.Copy();
-    copyshare->back_in2_view_tensor_ = back_in2_view_tensor_.Copy();
-    copyshare->err_sig_view_tensor_  = err_sig_view_tensor_.Copy();
-    copyshare->err1_                 = err1_.Copy();
-    copyshare->err2_                 = err2_.Copy();
-    copyshare->transpose_a_          = transpose_a_;
-    copyshare->transpose_b_          = transpose_b_;
+    copyshare->error_signal_1_ = error_signal_1_.Copy();
+    copyshare->error_signal_2_ = error_signal_2_.Copy();
+    copyshare->err1_           = err1_.Copy();
+    copyshare->err2_           = err2_.Copy();
+    copyshare->transpose_a_    = transpose_a_;
+    copyshare->transpose_b_    = transpose_b_;
 
     return copyshare;
   }
@@ -105,34 +100,31 @@ public:
   static constexpr char const *DESCRIPTOR = "MatrixMultiply";
 
 private:
+  using DataType        = typename TensorType::Type;
+  using ContainerType   = typename TensorType::ContainerType;
+  using StridedViewType = fetch::math::TensorStridedView<DataType, ContainerType>;
+  using MatrixViewType  = typename TensorType::ViewType;
+
   // caching tensors and shapes
   TensorType error_signal_1_;
   TensorType error_signal_2_;
 
-  // forward pass
-  SizeVector fwd_input_shape_1_{};
-  SizeVector fwd_input_shape_2_{};
-  TensorType output_view_tensor_;
-  TensorType fwd_in1_view_tensor_;
-  TensorType fwd_in2_view_tensor_;
-
-  // backward pass
+  // backward pass, gradients of a single batch of broadcast inputs
   SizeVector back_input_shape_1_{};
   SizeVector back_input_shape_2_{};
-  TensorType back_in1_view_tensor_;
-  TensorType back_in2_view_tensor_;
-  TensorType err_sig_view_tensor_;
   TensorType err1_;
   TensorType err2_;
 
   bool transpose_a_ = false;
   bool transpose_b_ = false;
 
-  void UpdateContainersForward(VecTensorType const &inputs);
-  void UpdateContainersBackward(VecTensorType const &inputs, TensorType const &error_signal);
-  void DotWithTranspose(TensorType const &a, TensorType const &b, TensorType &ret);
-  void BackDotWithTranspose(TensorType const &a, TensorType const &b, TensorType const &err_signal,
-                            TensorType &err_ret_1, TensorType &err_ret_2);
+  static StridedViewType BatchView(TensorType const &input, SizeType batch);
+  static StridedViewType Operand(StridedViewType const &view, bool transpose);
+
+  void UpdateContainersBackward(VecTensorType const &inputs);
+  void BackDot(StridedViewType const &a, StridedViewType const &b,
+               StridedViewType const &err_signal, MatrixViewType err_ret_1,
+               MatrixViewType err_ret_2) const;
 };
 
 template <class T>
@@ -141,13 +133,11 @@ void MatrixMultiply<T>::Forward(VecTensorType const &inputs, TensorType &output)
   assert(inputs.size() == 2);
   assert(output.shape() == ComputeOutputShape(inputs));
 
-  UpdateContainersForward(inputs);
-
   // Normal MatMul 2D @ 2D
   if (inputs.at(0)->shape().size() == 2 && inputs.at(1)->shape().size() == 2)
   {
-    assert((inputs.at(0)->shape().size() == 2 && inputs.at(1)->shape().size() == 2));
-    DotWithTranspose((*inputs.at(0)), (*inputs.at(1)), output);
+    fetch::math::Dot(Operand(inputs.at(0)->StridedView(), transpose_a_),
+                     Operand(inputs.at(1)->StridedView(), transpose_b_), output.View());
   }
   // Batchwise 3D @ 3D or broadcast matmul 2D @ 3D, 3D @ 2D
   else
@@ -155,49 +145,13 @@ void MatrixMultiply<T>::Forward(VecTensorType const &inputs, TensorType &output)
     assert((inputs.at(0)->shape().size() == 3 || inputs.at(0)->shape().size() == 2) &&
            (inputs.at(1)->shape().size() == 3 || inputs.at(1)->shape().size() == 2));
 
-    // Get batch size
-    SizeType batch_size;
-    if (inputs.at(0)->shape().size() == 3)
-    {
-      batch_size = inputs.at(0)->shape().at(2);
-    }
-    else
-    {
-      batch_size = inputs.at(1)->shape().at(2);
-    }
+    SizeType const batch_size = output.shape().at(2);
 
-    // Iterate over batch
+    // every batch is multiplied in place, transposed operands are handled by the gemm kernels
     for (SizeType i{0}; i < batch_size; i++)
     {
-      auto output_view = output.View(i);
-      output_view_tensor_.Assign(output.View(i));
-
-      // 3D @ ? case
-      if (inputs.at(0)->shape().size() == 3)
-      {
-        fwd_in1_view_tensor_.Assign(inputs.at(0)->View(i));
-        // 2D @ 3D case
-      }
-      else
-      {
-        fwd_in1_view_tensor_ = (*inputs.at(0));
-      }
-
-      // ? @ 3D case
-      if (inputs.at(1)->shape().size() == 3)
-      {
-        fwd_in2_view_tensor_.Assign(inputs.at(1)->View(i));
-      }
-      // 3D @ 2D case
-      else
-      {
-        fwd_in2_view_tensor_ = (*inputs.at(1));
-      }
-
-      DotWithTranspose(fwd_in1_view_tensor_, fwd_in2_view_tensor_, output_view_tensor_);
-
-      // Copy data to original array
-      output_view.Assign(output_view_tensor_);
+      fetch::math::Dot(Operand(BatchView(*inputs.at(0), i), transpose_a_),
+                       Operand(BatchView(*inputs.at(1), i), transpose_b_), output.View(i));
     }
   }
 }
@@ -209,13 +163,13 @@ std::vector<T> MatrixMultiply<T>::Backward(VecTensorType const &inputs,
   assert(inputs.size() == 2);
 
   // no change in shape - we can use cached shape
-  UpdateContainersBackward(inputs, error_signal);
+  UpdateContainersBackward(inputs);
 
   // Normal MatMul 2D @ 2D
   if (inputs.at(0)->shape().size() == 2 && inputs.at(1)->shape().size() == 2)
   {
-    BackDotWithTranspose((*inputs.at(0)), (*inputs.at(1)), error_signal, error_signal_1_,
-                         error_signal_2_);
+    BackDot(inputs.at(0)->StridedView(), inputs.at(1)->StridedView(), error_signal.StridedView(),
+            error_signal_1_.View(), error_signal_2_.View());
   }
   // Batchwise 3D @ 3D or broadcast matmul 2D @ 3D, 3D @ 2D
   else
@@ -223,81 +177,33 @@ std::vector<T> MatrixMultiply<T>::Backward(VecTensorType const &inputs,
     assert((inputs.at(0)->shape().size() == 3 || inputs.at(0)->shape().size() == 2) &&
            (inputs.at(1)->shape().size() == 3 || inputs.at(1)->shape().size() == 2));
 
-    // Get batch size
-    SizeType batch_size;
-    if (inputs.at(0)->shape().size() == 3)
+    bool const broadcast_1 = inputs.at(0)->shape().size() == 2;
+    bool const broadcast_2 = inputs.at(1)->shape().size() == 2;
+
+    // the gradients of broadcast inputs are summed over the batches
+    if (broadcast_1)
     {
-      batch_size = inputs.at(0)->shape().at(2);
+      error_signal_1_.SetAllZero();
     }
-    else
+    if (broadcast_2)
     {
-      batch_size = inputs.at(1)->shape().at(2);
+      error_signal_2_.SetAllZero();
     }
 
-    // Iterate over batch
+    SizeType const batch_size = error_signal.shape().at(2);
+
     for (SizeType i{0}; i < batch_size; i++)
     {
-      err_sig_view_tensor_.Assign(error_signal.View(i));
-
-      ///////////////////////////////
-      /// PREPARE DATA FOR MATMUL ///
-      ///////////////////////////////
-
-      // 3D @ ? case
-      if (inputs.at(0)->shape().size() == 3)
-      {
-        back_in1_view_tensor_.Assign(inputs.at(0)->View(i));
-      }
-      // 2D @ 3D case
-      else
-      {
-        back_in1_view_tensor_ = (*inputs.at(0));
-      }
+      BackDot(BatchView(*inputs.at(0), i), BatchView(*inputs.at(1), i),
+              error_signal.StridedView().Slice(i, 2),
+              broadcast_1 ? err1_.View() : error_signal_1_.View(i),
+              broadcast_2 ? err2_.View() : error_signal_2_.View(i));
 
-      // ? @ 3D case
-      if (inputs.at(1)->shape().size() == 3)
-      {
-        back_in2_view_tensor_.Assign(inputs.at(1)->View(i));
-      }
-      // 3D @ 2D case
-      else
-      {
-        back_in2_view_tensor_ = (*inputs.at(1));
-      }
-
-      /////////////////
-      /// DO MATMUL ///
-      /////////////////
-
-      BackDotWithTranspose(back_in1_view_tensor_, back_in2_view_tensor_, err_sig_view_tensor_,
-                           err1_, err2_);
-
-      ////////////////////////////////
-      /// COPY DATA BACK TO Views ///
-      ////////////////////////////////
-
-      // Copy data to original array
-      // 3D @ ? case
-      if (inputs.at(0)->shape().size() == 3)
-      {
-        auto err1_view = error_signal_1_.View(i);
-        err1_view.Assign(err1_);
-      }
-      // 2D @ 3D case
-      else
+      if (broadcast_1)
       {
         fetch::math::Add(error_signal_1_, err1_, error_signal_1_);
       }
-
-      // Copy data to original array
-      // ? @ 3D case
-      if (inputs.at(1)->shape().size() == 3)
-      {
-        auto err2_view = error_signal_2_.View(i);
-        err2_view.Assign(err2_);
-      }
-      // 3D @ 2D case
-      else
+      if (broadcast_2)
       {
         fetch::math::Add(error_signal_2_, err2_, error_signal_2_);
       }
@@ -377,51 +283,12 @@ std::vector<typename fetch::math::SizeType> MatrixMultiply<T>::ComputeOutputShap
 }
 
 /**
- * Updates temporary container objects used in some cases of batched forward pass
+ * Updates the gradient containers used in the back pass
  * @tparam T tensor type
  * @param inputs input tensors
- * @param output output tensor
  */
 template <typename T>
-void MatrixMultiply<T>::UpdateContainersForward(VecTensorType const &inputs)
-{
-  if (!((inputs.at(0)->shape() == fwd_input_shape_1_) &&
-        (inputs.at(1)->shape() == fwd_input_shape_2_)))
-  {
-    fwd_input_shape_1_   = inputs.at(0)->shape();
-    fwd_input_shape_2_   = inputs.at(1)->shape();
-    fwd_in1_view_tensor_ = TensorType({inputs.at(0)->shape().at(0), inputs.at(0)->shape().at(1)});
-    fwd_in2_view_tensor_ = TensorType({inputs.at(1)->shape().at(0), inputs.at(1)->shape().at(1)});
-
-    if (!transpose_a_ && !transpose_b_)
-    {
-      output_view_tensor_ = TensorType({inputs.at(0)->shape().at(0), inputs.at(1)->shape().at(1)});
-    }
-    else if (transpose_a_ & !transpose_b_)
-    {
-      output_view_tensor_ = TensorType({inputs.at(0)->shape().at(1), inputs.at(1)->shape().at(1)});
-    }
-    else if (transpose_b_ & !transpose_a_)
-    {
-      output_view_tensor_ = TensorType({inputs.at(0)->shape().at(0), inputs.at(1)->shape().at(0)});
-    }
-    else
-    {
-      throw ml::exceptions::InvalidMode(
-          "ops::MatrixMultiply does not support both inputs transposed");
-    }
-  }
-}
-
-/**
- * Updates temporary container objects used in batched back pass
- * @tparam T tensor type
- * @param inputs input tensors
- * @param error_signal back pass error signal
- */
-template <typename T>
-void MatrixMultiply<T>::UpdateContainersBackward(VecTensorType const &inputs,
-                                                 TensorType const &   error_signal)
+void MatrixMultiply<T>::UpdateContainersBackward(VecTensorType const &inputs)
 {
   if (!((inputs.at(0)->shape() == back_input_shape_1_) &&
         (inputs.at(1)->shape() == back_input_shape_2_)))
@@ -429,81 +296,81 @@ void MatrixMultiply<T>::UpdateContainersBackward(VecTensorType const &inputs,
     back_input_shape_1_ = inputs.at(0)->shape();
     back_input_shape_2_ = inputs.at(1)->shape();
 
-    back_in1_view_tensor_ = TensorType({inputs.at(0)->shape().at(0), inputs.at(0)->shape().at(1)});
-    back_in2_view_tensor_ = TensorType({inputs.at(1)->shape().at(0), inputs.at(1)->shape().at(1)});
-
-    err1_                = TensorType(error_signal_1_.shape());
-    err2_                = TensorType(error_signal_2_.shape());
-    error_signal_1_      = TensorType(back_input_shape_1_);
-    error_signal_2_      = TensorType(back_input_shape_2_);
-    err_sig_view_tensor_ = TensorType({error_signal.shape().at(0), error_signal.shape().at(1)});
+    error_signal_1_ = TensorType(back_input_shape_1_);
+    error_signal_2_ = TensorType(back_input_shape_2_);
+    err1_           = TensorType({back_input_shape_1_.at(0), back_input_shape_1_.at(1)});
+    err2_           = TensorType({back_input_shape_2_.at(0), back_input_shape_2_.at(1)});
   }
 }
 
 /**
- * Invokes the relevant DotProduct operation depending on the transpose mode
+ * A lazy view of the matrix of an input for one batch, 2D inputs are broadcast over the batches
  * @tparam TensorType
- * @param a
- * @param b
- * @param ret
+ * @param input
+ * @param batch
+ * @return
  */
 template <typename TensorType>
-void MatrixMultiply<TensorType>::DotWithTranspose(TensorType const &a, TensorType const &b,
-                                                  TensorType &ret)
+typename MatrixMultiply<TensorType>::StridedViewType MatrixMultiply<TensorType>::BatchView(
+    TensorType const &input, SizeType batch)
 {
-  if (!transpose_a_ && !transpose_b_)
+  auto view = input.StridedView();
+  if (input.shape().size() == 3)
   {
-    fetch::math::Dot(a, b, ret);
-  }
-  else if (transpose_a_ & !transpose_b_)
-  {
-    fetch::math::TransposeDot(a, b, ret);
-  }
-  else if (transpose_b_ & !transpose_a_)
-  {
-    fetch::math::DotTranspose(a, b, ret);
-  }
-  else
-  {
-    throw ml::exceptions::InvalidMode(
-        "ops::MatrixMultiply does not support both inputs transposed");
+    return view.Slice(batch, 2);
   }
+  return view;
+}
+
+template <typename TensorType>
+typename MatrixMultiply<TensorType>::StridedViewType MatrixMultiply<TensorType>::Operand(
+    StridedViewType const &view, bool transpose)
+{
+  return transpose ? view.Transpose() : view;
 }
 
 /**
- * Applies the relevant two dot operations in backprop depending on transpose
+ * Computes the gradients of both inputs of a single 2D product C = op(A).op(B), where op
+ * transposes the inputs flagged for it. The transposes are never materialised.
  * @tparam TensorType
  * @param a
  * @param b
- * @param ret
+ * @param err_signal gradient of C
+ * @param err_ret_1 gradient of A
+ * @param err_ret_2 gradient of B
  */
 template <typename TensorType>
-void MatrixMultiply<TensorType>::BackDotWithTranspose(TensorType const &a, TensorType const &b,
-                                                      TensorType const &err_signal,
-                                                      TensorType &err_ret_1, TensorType &err_ret_2)
+void MatrixMultiply<TensorType>::BackDot(StridedViewType const &a, StridedViewType const &b,
+                                         StridedViewType const &err_signal,
+                                         MatrixViewType err_ret_1, MatrixViewType err_ret_2) const
 {
+  if (transpose_a_ && transpose_b_)
+  {
+    throw ml::exceptions::InvalidMode(
+        "ops::MatrixMultiply does not support both inputs transposed");
+  }
 
-  if (!transpose_a_ && !transpose_b_)
+  // dA = dC.op(B)^T, or its transpose op(B).dC^T when A is transposed
+  if (transpose_a_)
   {
-    fetch::math::DotTranspose(err_signal, b, err_ret_1);
-    fetch::math::TransposeDot(a, err_signal, err_ret_2);
+    fetch::math::Dot(Operand(b, transpose_b_), err_signal.Transpose(), std::move(err_ret_1));
   }
-  else if (transpose_a_ && !transpose_b_)
+  else
   {
-    fetch::math::DotTranspose(err_signal, b, err_ret_1);
-    fetch::math::Dot(a, err_signal, err_ret_2);
+    fetch::math::Dot(err_signal, Operand(b, !transpose_b_), std::move(err_ret_1));
   }
-  else if (transpose_b_ && !transpose_a_)
+
+  // dB = op(A)^T.dC, or its transpose dC^T.op(A) when B is transposed
+  if (transpose_b_)
   {
-    fetch::math::Dot(err_signal, b, err_ret_1);
-    fetch::math::TransposeDot(a, err_signal, err_ret_2);
+    fetch::math::Dot(err_signal.Transpose(), Operand(a, transpose_a_), std::move(err_ret_2));
   }
   else
   {
-    throw ml::exceptions::InvalidMode(
-        "ops::MatrixMultiply does not support both inputs transposed");
+    fetch::math::Dot(Operand(a, !transpose_a_), err_signal, std::move(err_ret_2));
   }
 }
+
 }  // namespace ops
 }  // namespace ml
 }  // namespace fetch
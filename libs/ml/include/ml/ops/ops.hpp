@@ -23,6 +23,7 @@
 
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 namespace fetch {
@@ -73,6 +74,69 @@ public:
     return is_training_;
   }
 
+  /**
+   * Operations which compute every element of their output from the same element of their inputs
+   * can write their output over an input of the same shape
+   * @return true if Forward may be called with the output sharing memory with an input
+   */
+  virtual bool SupportsInPlace() const
+  {
+    return false;
+  }
+
+  /// @name Fusion
+  /// @{
+
+  /**
+   * Elementwise operations compute each element of their output from the elements at the same
+   * position of their inputs, which allows chains of them to be fused into a single pass
+   * @return true if the operation implements ForwardRange
+   */
+  virtual bool IsElementwise() const
+  {
+    return false;
+  }
+
+  /**
+   * Determines if ForwardRange can be used for these inputs, by default this requires every input
+   * to have the shape of the output
+   * @param inputs
+   * @return
+   */
+  virtual bool SupportsForwardRange(VecTensorType const &inputs) const
+  {
+    if (!IsElementwise())
+    {
+      return false;
+    }
+
+    auto const output_shape = ComputeOutputShape(inputs);
+    for (auto const &input : inputs)
+    {
+      if (input->shape() != output_shape)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Computes the elements [begin, end) of the (padded) storage of the output. The output may share
+   * its memory with the inputs.
+   * @param inputs
+   * @param output
+   * @param begin index of the first element of the storage to compute
+   * @param end index one past the last element of the storage to compute
+   */
+  virtual void ForwardRange(VecTensorType const & /*inputs*/, TensorType & /*output*/,
+                            SizeType /*begin*/, SizeType /*end*/)
+  {
+    throw std::runtime_error("ForwardRange is not implemented for this operation");
+  }
+
+  /// @}
+
 protected:
   bool is_training_ = true;
 };
@@ -87,6 +87,11 @@ public:
     return inputs.front()->shape();
   }
 
+  bool SupportsInPlace() const override
+  {
+    return true;
+  }
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_SUBTRACT;
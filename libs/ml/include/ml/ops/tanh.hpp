@@ -55,6 +55,11 @@ public:
 
   std::vector<SizeType> ComputeOutputShape(VecTensorType const &inputs) const override;
 
+  bool SupportsInPlace() const override;
+  bool IsElementwise() const override;
+  void ForwardRange(VecTensorType const &inputs, TensorType &output, SizeType begin,
+                    SizeType end) override;
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_TANH;
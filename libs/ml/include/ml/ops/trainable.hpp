@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "ml/ops/ops.hpp"
+#include "ml/utilities/sparse_tensor_utilities.hpp"
 
 #include <functional>
 #include <memory>
@@ -44,11 +45,12 @@ template <class T>
 class Trainable
 {
 public:
-  using TensorType   = T;
-  using ArrayPtrType = std::shared_ptr<TensorType>;
-  using SizeSet      = std::unordered_set<fetch::math::SizeType>;
-  using DataType     = typename TensorType::Type;
-  using RegPtrType   = std::shared_ptr<fetch::ml::regularisers::Regulariser<T>>;
+  using TensorType         = T;
+  using ArrayPtrType       = std::shared_ptr<TensorType>;
+  using SizeSet            = std::unordered_set<fetch::math::SizeType>;
+  using DataType           = typename TensorType::Type;
+  using RegPtrType         = std::shared_ptr<fetch::ml::regularisers::Regulariser<T>>;
+  using SparseGradientType = utilities::SparseGradient<TensorType>;
 
   virtual fetch::ml::StateDict<T> StateDict() const                                        = 0;
   virtual void                    LoadStateDict(fetch::ml::StateDict<T> const &dict)       = 0;
@@ -58,9 +60,11 @@ public:
   virtual SizeSet const &         GetUpdatedRowsReferences() const                         = 0;
   virtual TensorType              GetGradients() const                                     = 0;
   virtual std::pair<TensorType const, SizeSet const> GetSparseGradientsReferences() const  = 0;
+  virtual SparseGradientType                         GetSparseGradients() const            = 0;
   virtual void                                       ResetGradients()                      = 0;
   virtual void                                       ApplyGradient(TensorType const &grad) = 0;
   virtual void ApplySparseGradient(TensorType const &grad, SizeSet &update_rows)           = 0;
+  virtual void ApplySparseGradient(SparseGradientType const &update)                       = 0;
   virtual void ApplyRegularisation()                                                       = 0;
 
   void SetRegularisation(RegPtrType regulariser, DataType regularisation_rate = DataType{0});
@@ -68,6 +68,8 @@ public:
   using SPType        = OpVariableSaveableParams<TensorType>;
   using MyType        = Variable<TensorType>;
 
+  using SparseGradientType = typename Trainable<T>::SparseGradientType;
+
   Variable() = default;
 
   explicit Variable(SPType const &sp);
@@ -91,6 +93,8 @@ public:
 
   void ApplySparseGradient(TensorType const &grad, SizeSet &update_rows) override;
 
+  void ApplySparseGradient(SparseGradientType const &update) override;
+
   void ApplyGradient(TensorType const &grad) override;
 
   void ResetGradients() override;
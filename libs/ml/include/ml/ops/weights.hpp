@@ -65,6 +65,8 @@ public:
   using SPType         = OpWeightsSaveableParams<TensorType>;
   using WeightsPtrType = typename std::shared_ptr<Weights<TensorType>>;
 
+  using SparseGradientType = typename Variable<T>::SparseGradientType;
+
 public:
   Weights() = default;
 
@@ -94,6 +96,8 @@ public:
 
   std::pair<TensorType const, SizeSet const> GetSparseGradientsReferences() const override;
 
+  SparseGradientType GetSparseGradients() const override;
+
   TensorType const &GetGradientsReferences() const override;
 
   SizeSet const &GetUpdatedRowsReferences() const override;
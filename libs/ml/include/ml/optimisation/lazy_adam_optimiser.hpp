@@ -52,6 +52,8 @@ public:
   using SizeType   = fetch::math::SizeType;
   using SizeSet    = std::unordered_set<SizeType>;
 
+  using SparseGradientType = typename Graph<T>::SparseGradientType;
+
   LazyAdamOptimiser() = default;
 
   LazyAdamOptimiser(std::shared_ptr<Graph<T>>       graph,
@@ -92,6 +94,9 @@ private:
   void ApplyLogic(SizeType batch_size, TensorType &gradient_tensor, TensorType &momentum_tensor,
                   TensorType &mt_tensor, TensorType &v_tensor, TensorType &cache_tensor,
                   TensorType const &refs_tensor);
+
+  void ApplySparseLogic(SizeType batch_size, SparseGradientType &update,
+                        TensorType &momentum_tensor, TensorType &cache_tensor);
 };
 
 template <class T>
@@ -169,6 +174,62 @@ void LazyAdamOptimiser<T>::ApplyLogic(SizeType batch_size, TensorType &gradient_
   fetch::math::Multiply(gradient_tensor, -this->learning_rate_, gradient_tensor);
 }
 
+/**
+ * ApplySparseLogic does the same optimiser step as ApplyLogic for the updated rows of a compact
+ * sparse gradient only. The update is computed in place, so no dense temporaries the size of the
+ * full trainable are needed
+ * @tparam T
+ * @param batch_size
+ * @param update compact gradient, overwritten with the weight update for each of its rows
+ * @param momentum_tensor
+ * @param cache_tensor
+ */
+template <class T>
+void LazyAdamOptimiser<T>::ApplySparseLogic(SizeType batch_size, SparseGradientType &update,
+                                            TensorType &momentum_tensor, TensorType &cache_tensor)
+{
+  auto const     batch             = static_cast<DataType>(batch_size);
+  DataType const one_minus_beta1_t = DataType{1} - this->beta1_t_;
+  DataType const one_minus_beta2_t = DataType{1} - this->beta2_t_;
+  DataType const gradient_scale    = one_minus_beta1_t / batch;
+  DataType const neg_learning_rate = -this->learning_rate_;
+
+  for (SizeType i{0}; i < update.rows.size(); ++i)
+  {
+    auto update_view   = update.values.View(i);
+    auto momentum_view = momentum_tensor.View(update.rows[i]);
+    auto cache_view    = cache_tensor.View(update.rows[i]);
+
+    auto update_it   = update_view.begin();
+    auto momentum_it = momentum_view.begin();
+    auto cache_it    = cache_view.begin();
+    while (update_it.is_valid())
+    {
+      DataType const gradient = *update_it;
+
+      // cache[i] = (beta1_t_ * cache[i]) + ((1.0 - beta1_t_) * (input_gradients[i]/batch_size));
+      *cache_it = static_cast<DataType>((*cache_it * this->beta1_t_) + (gradient * gradient_scale));
+      DataType const mt = static_cast<DataType>(*cache_it / one_minus_beta1_t);
+
+      // momentum[i] = (beta2_t_ * momentum[i]) + ((1.0 - beta2_t_) *
+      // ((input_gradients[i]/batch_size)^2));
+      auto v       = static_cast<DataType>(gradient / batch);
+      v            = static_cast<DataType>((v * v) * one_minus_beta2_t);
+      *momentum_it = static_cast<DataType>((*momentum_it * this->beta2_t_) + v);
+      DataType const vt = static_cast<DataType>(*momentum_it / one_minus_beta2_t);
+
+      // output_gradients[i] = -this->learning_rate_ * mt / (sqrt(vt) + epsilon_);
+      DataType sqrt_vt;
+      fetch::math::Sqrt(vt, sqrt_vt);
+      *update_it = static_cast<DataType>((mt / (sqrt_vt + this->epsilon_)) * neg_learning_rate);
+
+      ++update_it;
+      ++momentum_it;
+      ++cache_it;
+    }
+  }
+}
+
 template <class T>
 void LazyAdamOptimiser<T>::ApplyGradients(SizeType batch_size)
 {
@@ -185,65 +246,42 @@ void LazyAdamOptimiser<T>::ApplyGradients(SizeType batch_size)
   fetch::math::Pow(this->beta1_, static_cast<DataType>(this->epoch_ + 1), this->beta1_t_);
   fetch::math::Pow(this->beta2_, static_cast<DataType>(this->epoch_ + 1), this->beta2_t_);
 
-  std::vector<SizeSet> rows;
+  std::vector<SparseGradientType> updates;
+  updates.reserve(this->gradients_.size());
 
   while (gradient_it != this->gradients_.end())
   {
-    // Skip frozen trainables
-    if ((*trainable_it)->GetFrozenState())
-    {
-      continue;
-    }
-
-    std::pair<TensorType const, SizeSet const> gradient_pair =
-        (*trainable_it)->GetSparseGradientsReferences();
-    rows.push_back(gradient_pair.second);
+    SparseGradientType update;
 
-    // Normal ApplyGradient
-    // if number_of_rows_to_update * sparsity_threshold_ > total_rows
-    if (rows.at(rows.size() - 1).empty() ||
-        (rows.at(rows.size() - 1).size() * sparsity_threshold_) > gradient_pair.first.shape().at(1))
-    {
-      ApplyLogic(batch_size, *gradient_it, *momentum_it, *mt_it, *vt_it, *cached_weight_it,
-                 (*trainable_it)->GetGradientsReferences());
-    }
-    // Sparse apply gradient
-    // if number_of_rows_to_update * sparsity_threshold_ <= total_rows
-    else
+    // Skip frozen trainables
+    if (!(*trainable_it)->GetFrozenState())
     {
-      // Tensors used by ApplyLogic for operations that are not possible to do in-place
-      TensorType mt_tensor({mt_it->shape().at(0), 1});
-      TensorType vt_tensor({vt_it->shape().at(0), 1});
+      SizeSet const &rows = (*trainable_it)->GetUpdatedRowsReferences();
 
-      for (SizeType update_index : rows.at(rows.size() - 1))
+      // Normal ApplyGradient
+      // if number_of_rows_to_update * sparsity_threshold_ > total_rows
+      if (rows.empty() || (rows.size() * sparsity_threshold_) > gradient_it->shape().at(1))
       {
-
-        auto       gradient_view        = gradient_it->View(update_index);
-        TensorType gradient_view_tensor = gradient_view.Copy();
-
-        auto       momentum_view        = momentum_it->View(update_index);
-        TensorType momentum_view_tensor = momentum_view.Copy();
-
-        auto       cache_view        = cached_weight_it->View(update_index);
-        TensorType cache_view_tensor = cache_view.Copy();
-
-        TensorType refs_view_tensor =
-            (*trainable_it)->GetGradientsReferences().View(update_index).Copy();
-
-        ApplyLogic(batch_size, gradient_view_tensor, momentum_view_tensor, mt_tensor, vt_tensor,
-                   cache_view_tensor, refs_view_tensor);
-
-        // Put things back
-        gradient_view.Assign(gradient_view_tensor);
-        momentum_view.Assign(momentum_view_tensor);
-        cache_view.Assign(cache_view_tensor);
+        ApplyLogic(batch_size, *gradient_it, *momentum_it, *mt_it, *vt_it, *cached_weight_it,
+                   (*trainable_it)->GetGradientsReferences());
+        update.values = *gradient_it;
       }
+      // Sparse apply gradient
+      // if number_of_rows_to_update * sparsity_threshold_ <= total_rows
+      else
+      {
+        // only the updated rows are copied out of the accumulated gradient
+        update = (*trainable_it)->GetSparseGradients();
+        ApplySparseLogic(batch_size, update, *momentum_it, *cached_weight_it);
 
-      // we need to explicitly reset the gradients for this shared op to avoid double counting
-      // in the case of shared ops
-      (*trainable_it)->ResetGradients();
+        // we need to explicitly reset the gradients for this shared op to avoid double counting
+        // in the case of shared ops
+        (*trainable_it)->ResetGradients();
+      }
     }
 
+    updates.emplace_back(std::move(update));
+
     ++cached_weight_it;
     ++momentum_it;
     ++mt_it;
@@ -254,7 +292,7 @@ void LazyAdamOptimiser<T>::ApplyGradients(SizeType batch_size)
   }
 
   // calling apply gradients on the graph ensures that the node caches are reset properly
-  this->graph_->ApplySparseGradients(this->gradients_, rows);
+  this->graph_->ApplySparseGradients(updates);
 }
 
 }  // namespace optimisers
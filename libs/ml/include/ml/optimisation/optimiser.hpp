@@ -24,8 +24,12 @@
 #include "ml/meta/ml_type_traits.hpp"
 #include "ml/optimisation/learning_rate_params.hpp"
 #include "ml/utilities/graph_builder.hpp"
+#include "vectorise/threading/pool.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <exception>
+#include <future>
 #include <utility>
 
 namespace fetch {
@@ -61,8 +65,12 @@ public:
   void SetGraph(std::shared_ptr<Graph<T>> graph)
   {
     graph_ = graph;
+    replicas_.clear();
   }
 
+  void     SetDataParallelism(SizeType num_replicas);
+  SizeType GetDataParallelism() const;
+
   /// DATA RUN INTERFACES ///
   DataType Run(std::vector<TensorType> const &data, TensorType const &labels,
                SizeType batch_size = SIZE_NOT_SET);
@@ -113,6 +121,25 @@ private:
   TensorType                                     batch_labels_;
   LearningRateParam<DataType>                    learning_rate_param_;
 
+  /// @name Data parallel training
+  /// @{
+  using GraphPtrType     = std::shared_ptr<Graph<T>>;
+  using TrainablePtrType = std::shared_ptr<fetch::ml::ops::Trainable<TensorType>>;
+
+  SizeType                                   num_replicas_ = 1;
+  std::vector<GraphPtrType>                  replicas_;  ///< The graphs used by all but one shard
+  std::vector<std::vector<TrainablePtrType>> replica_trainables_;
+  std::vector<std::vector<TensorType>>       shard_data_;
+  std::vector<TensorType>                    shard_labels_;
+  std::shared_ptr<threading::Pool>           pool_;
+  /// @}
+
+  DataType ComputeGradients(std::vector<TensorType> const &data, TensorType const &labels);
+  DataType ForwardBackward(Graph<T> &graph, std::vector<TensorType> const &data,
+                           TensorType const &labels);
+  void     PrepareReplicas(SizeType num_shards);
+  void     ReduceGradients(std::vector<DataType> const &weights);
+
   void ResetGradients();
 
   void PrintStats(SizeType batch_size, SizeType subset_size);
@@ -241,20 +268,7 @@ typename T::Type Optimiser<T>::Run(std::vector<TensorType> const &data, TensorTy
       it++;
     }
 
-    // Set inputs
-    auto name_it = input_node_names_.begin();
-    for (auto &input : batch_data_)
-    {
-      graph_->SetInputReference(*name_it, input);
-      ++name_it;
-    }
-
-    // Set Label
-    graph_->SetInputReference(label_node_name_, batch_labels_);
-
-    auto loss_tensor = graph_->ForwardPropagate(output_node_name_);
-    loss_ += *(loss_tensor.begin());
-    graph_->BackPropagate(output_node_name_);
+    loss_ += ComputeGradients(batch_data_, batch_labels_);
 
     // Compute and apply gradient
     ApplyGradients(batch_size);
@@ -345,19 +359,7 @@ typename T::Type Optimiser<T>::RunImplementation(
     // Do batch back-propagation
     input = loader.PrepareBatch(batch_size, is_done_set);
 
-    auto name_it = input_node_names_.begin();
-    for (auto &cur_input : input.second)
-    {
-      graph_->SetInputReference(*name_it, cur_input);
-      ++name_it;
-    }
-
-    // Set Label
-    graph_->SetInputReference(label_node_name_, input.first);
-
-    auto loss_tensor = graph_->ForwardPropagate(output_node_name_);
-    loss_ += *(loss_tensor.begin());
-    graph_->BackPropagate(output_node_name_);
+    loss_ += ComputeGradients(input.second, input.first);
 
     // Compute and apply gradient
     ApplyGradients(batch_size);
@@ -514,6 +516,261 @@ typename Optimiser<T>::SizeType Optimiser<T>::UpdateBatchSize(SizeType const &ba
   return updated_batch_size;
 }
 
+/**
+ * Sets the number of graph replicas used to train on each batch. Every batch is split into
+ * num_replicas shards along its trailing dimension, the shards are forward and back propagated
+ * on separate threads by replicas of the graph which share its weights, and the gradients are
+ * summed into the graph before a single update is applied by the optimiser.
+ * @tparam T TensorType
+ * @param num_replicas the number of shards per batch, 1 trains on the calling thread (the default)
+ */
+template <class T>
+void Optimiser<T>::SetDataParallelism(SizeType num_replicas)
+{
+  num_replicas_ = std::max(num_replicas, SizeType{1});
+
+  replicas_.clear();
+  replica_trainables_.clear();
+  shard_data_.clear();
+  shard_labels_.clear();
+  pool_.reset();
+}
+
+template <class T>
+typename Optimiser<T>::SizeType Optimiser<T>::GetDataParallelism() const
+{
+  return num_replicas_;
+}
+
+/**
+ * Forward and back propagates a batch, leaving the summed gradients in the trainables of the graph
+ * @tparam T TensorType
+ * @param data the input tensors, with the batch as the trailing dimension
+ * @param labels the labels of the batch
+ * @return the loss of the batch
+ */
+template <class T>
+typename T::Type Optimiser<T>::ComputeGradients(std::vector<TensorType> const &data,
+                                                TensorType const &             labels)
+{
+  SizeType const batch_size = labels.shape().back();
+  SizeType const num_shards = std::min(num_replicas_, batch_size);
+
+  if (num_shards <= 1)
+  {
+    return ForwardBackward(*graph_, data, labels);
+  }
+
+  PrepareReplicas(num_shards);
+
+  // copy each shard of the batch into the inputs of its replica
+  std::vector<DataType> weights(num_shards);
+  for (SizeType shard = 0; shard < num_shards; ++shard)
+  {
+    SizeType const begin = (shard * batch_size) / num_shards;
+    SizeType const end   = ((shard + 1) * batch_size) / num_shards;
+    weights[shard]       = static_cast<DataType>(end - begin) / static_cast<DataType>(batch_size);
+
+    auto copy_shard = [begin, end](TensorType const &source, TensorType &target) {
+      std::vector<SizeType> shape = source.shape();
+      shape.back()                = end - begin;
+      if (target.shape() != shape)
+      {
+        target = TensorType{shape};
+      }
+
+      for (SizeType i = begin; i < end; ++i)
+      {
+        auto view = target.View(i - begin);
+        view.Assign(source.View(i));
+      }
+    };
+
+    shard_data_[shard].resize(data.size());
+    for (SizeType i = 0; i < data.size(); ++i)
+    {
+      copy_shard(data[i], shard_data_[shard][i]);
+    }
+    copy_shard(labels, shard_labels_[shard]);
+  }
+
+  std::vector<std::future<DataType>> tasks{};
+  tasks.reserve(num_shards - 1);
+  for (SizeType shard = 1; shard < num_shards; ++shard)
+  {
+    tasks.emplace_back(pool_->Dispatch([this, shard]() {
+      return ForwardBackward(*replicas_[shard - 1], shard_data_[shard], shard_labels_[shard]);
+    }));
+  }
+
+  // the first shard is processed by the graph itself on this thread. Every task must finish before
+  // returning since the tasks refer to the shards.
+  DataType           loss{0};
+  std::exception_ptr error{};
+  try
+  {
+    loss = ForwardBackward(*graph_, shard_data_[0], shard_labels_[0]) * weights[0];
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  for (SizeType shard = 1; shard < num_shards; ++shard)
+  {
+    try
+    {
+      loss += tasks[shard - 1].get() * weights[shard];
+    }
+    catch (...)
+    {
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+
+  ReduceGradients(weights);
+
+  return loss;
+}
+
+template <class T>
+typename T::Type Optimiser<T>::ForwardBackward(Graph<T> &graph, std::vector<TensorType> const &data,
+                                               TensorType const &labels)
+{
+  // Set inputs
+  auto name_it = input_node_names_.begin();
+  for (auto &input : data)
+  {
+    graph.SetInputReference(*name_it, input);
+    ++name_it;
+  }
+
+  // Set Label
+  graph.SetInputReference(label_node_name_, labels);
+
+  auto loss_tensor = graph.ForwardPropagate(output_node_name_);
+  graph.BackPropagate(output_node_name_);
+
+  return *(loss_tensor.begin());
+}
+
+/**
+ * Builds any missing replicas of the graph and points the weights of every replica at the current
+ * weights of the graph, so that the weight updates applied to the graph are seen by the replicas
+ * @tparam T TensorType
+ * @param num_shards the number of shards the batch is split into
+ */
+template <class T>
+void Optimiser<T>::PrepareReplicas(SizeType num_shards)
+{
+  if (!pool_)
+  {
+    pool_ = std::make_shared<threading::Pool>(num_replicas_ - 1, "Optimiser");
+  }
+
+  while (replicas_.size() < (num_shards - 1))
+  {
+    auto replica = std::make_shared<Graph<T>>();
+    utilities::BuildGraph<TensorType>(graph_->GetGraphSaveableParams(), replica);
+    replica->Compile();
+
+    replica_trainables_.emplace_back(replica->GetTrainables());
+    if (replica_trainables_.back().size() != graph_trainables_.size())
+    {
+      throw exceptions::InvalidMode("graph replica does not match the trainables of the graph");
+    }
+    replicas_.emplace_back(std::move(replica));
+  }
+
+  shard_data_.resize(num_shards);
+  shard_labels_.resize(num_shards);
+
+  for (auto &trainables : replica_trainables_)
+  {
+    for (std::size_t i = 0; i < trainables.size(); ++i)
+    {
+      auto weights = std::dynamic_pointer_cast<ops::DataHolder<TensorType>>(trainables[i]);
+      if (!weights)
+      {
+        throw exceptions::InvalidMode("unable to share the weights of a trainable with a replica");
+      }
+
+      // tensors are shallow copies, so this shares the storage of the weights
+      if (trainables[i]->GetWeights().data().pointer() !=
+          graph_trainables_[i]->GetWeights().data().pointer())
+      {
+        weights->SetData(graph_trainables_[i]->GetWeights());
+      }
+      trainables[i]->SetFrozenState(graph_trainables_[i]->GetFrozenState());
+    }
+  }
+}
+
+/**
+ * Adds the gradients accumulated by the replicas to the trainables of the graph. Losses which
+ * average over the batch (mean square error and cross entropy) produce a gradient averaged over
+ * each shard, so the shards are weighted by their share of the batch. Other losses are summed.
+ * @tparam T TensorType
+ * @param weights the fraction of the batch processed by each shard
+ */
+template <class T>
+void Optimiser<T>::ReduceGradients(std::vector<DataType> const &weights)
+{
+  OpType const loss_type = graph_->GetNode(output_node_name_)->get_op_type();
+  bool const   average   = (loss_type == OpType::LOSS_MEAN_SQUARE_ERROR) ||
+                       (loss_type == OpType::LOSS_CROSS_ENTROPY);
+
+  for (std::size_t i = 0; i < graph_trainables_.size(); ++i)
+  {
+    auto target = std::dynamic_pointer_cast<ops::Variable<TensorType>>(graph_trainables_[i]);
+    if (!target || target->GetFrozenState())
+    {
+      continue;
+    }
+
+    if (average)
+    {
+      // tensors are shallow copies, so this scales the accumulated gradient in place
+      TensorType gradient = target->GetGradientsReferences();
+      fetch::math::Multiply(gradient, weights[0], gradient);
+    }
+
+    for (std::size_t shard = 1; shard < weights.size(); ++shard)
+    {
+      auto const &source = replica_trainables_[shard - 1][i];
+
+      // an empty set of rows means that every row has been updated
+      if (source->GetUpdatedRowsReferences().empty() ||
+          target->GetUpdatedRowsReferences().empty())
+      {
+        TensorType const &dense    = source->GetGradientsReferences();
+        TensorType        gradient = average ? fetch::math::Multiply(dense, weights[shard]) : dense;
+        target->AddToGradient(gradient);
+      }
+      else
+      {
+        // only the updated rows are transferred between the replicas
+        auto sparse = source->GetSparseGradients();
+        if (average)
+        {
+          fetch::math::Multiply(sparse.values, weights[shard], sparse.values);
+        }
+        target->AddToGradient(sparse.values, sparse.rows);
+      }
+
+      source->ResetGradients();
+    }
+  }
+}
+
 template <typename T>
 void Optimiser<T>::ResetGradients()
 {
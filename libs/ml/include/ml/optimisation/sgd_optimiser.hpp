@@ -38,6 +38,8 @@ public:
   using SizeType   = fetch::math::SizeType;
   using SizeSet    = std::unordered_set<SizeType>;
 
+  using SparseGradientType = typename Graph<T>::SparseGradientType;
+
   SGDOptimiser() = default;
   SGDOptimiser(std::shared_ptr<Graph<T>> graph, std::vector<std::string> const &input_node_names,
                std::string const &label_node_name, std::string const &output_node_name,
@@ -100,58 +102,51 @@ void SGDOptimiser<T>::ApplyGradients(SizeType batch_size)
   DataType neg_learning_rate_div_batch_size =
       (-this->learning_rate_) / static_cast<DataType>(batch_size);
 
-  std::vector<SizeSet> rows;
+  std::vector<SparseGradientType> updates;
+  updates.reserve(this->gradients_.size());
 
   while (gradient_it != this->gradients_.end())
   {
+    SparseGradientType update;
+
     // Skip frozen trainables
     if (!(*trainable_it)->GetFrozenState())
     {
-
-      auto gradient_pair = (*trainable_it)->GetSparseGradientsReferences();
-      rows.push_back(gradient_pair.second);
+      SizeSet const &rows = (*trainable_it)->GetUpdatedRowsReferences();
 
       // Normal ApplyGradient
       // if number_of_rows_to_update * sparsity_threshold_ > total_rows
-      if (rows.at(rows.size() - 1).empty() ||
-          (rows.at(rows.size() - 1).size() * sparsity_threshold_) >
-              gradient_pair.first.shape().at(1))
+      if (rows.empty() || (rows.size() * sparsity_threshold_) > gradient_it->shape().at(1))
       {
-
         // output_grad[i] = (input_grad[i] / batch_size) * -learning_rate
-        fetch::math::Multiply(gradient_pair.first, neg_learning_rate_div_batch_size, *gradient_it);
+        fetch::math::Multiply((*trainable_it)->GetGradientsReferences(),
+                              neg_learning_rate_div_batch_size, *gradient_it);
+        update.values = *gradient_it;
       }
       else
       {
         // Sparse apply gradient
         // if number_of_rows_to_update * sparsity_threshold_ <= total_rows
+        // only the updated rows are copied out of the accumulated gradient
+        update = (*trainable_it)->GetSparseGradients();
 
-        for (SizeType update_index : rows.at(rows.size() - 1))
-        {
-          auto       gradient_slice        = gradient_it->View(update_index);
-          TensorType gradient_slice_tensor = gradient_slice.Copy();
-
-          auto       refs_slice        = gradient_pair.first.View(update_index);
-          TensorType refs_slice_tensor = refs_slice.Copy();
-
-          // output_grad[i] = (input_grad[i] / batch_size) * -learning_rate
-          fetch::math::Multiply(refs_slice_tensor, neg_learning_rate_div_batch_size,
-                                gradient_slice_tensor);
-
-          gradient_slice.Assign(gradient_slice_tensor);
-        }
+        // output_grad[i] = (input_grad[i] / batch_size) * -learning_rate
+        fetch::math::Multiply(update.values, neg_learning_rate_div_batch_size, update.values);
       }
 
       // we need to explicitly reset the gradients for this shared op to avoid double counting
       // in the case of shared ops
       (*trainable_it)->ResetGradients();
     }
+
+    updates.emplace_back(std::move(update));
+
     ++trainable_it;
     ++gradient_it;
   }
 
   // calling apply gradients on the graph ensures that the node caches are reset properly
-  this->graph_->ApplySparseGradients(this->gradients_, rows);
+  this->graph_->ApplySparseGradients(updates);
 }
 
 }  // namespace optimisers
@@ -233,6 +233,24 @@ struct OpFlattenSaveableParams : public OpsSaveableParams
   std::vector<fetch::math::SizeType> input_shape;
 };
 
+/**
+ * Saveable parameters for FusedAttention op
+ * @tparam TensorType
+ */
+template <typename TensorType>
+struct OpFusedAttentionSaveableParams : public OpsSaveableParams
+{
+  using DataType                = typename TensorType::Type;
+  using SizeType                = typename TensorType::SizeType;
+  fetch::ml::OpType     op_type = OpType::OP_FUSED_ATTENTION;
+  SizeType              key_dim{};
+  DataType              probability{};
+  DataType              fill_value{};
+  SizeType              random_seed{};
+  std::vector<uint64_t> buffer{};
+  uint64_t              index = fetch::math::numeric_max<uint64_t>();
+};
+
 template <typename TensorType>
 struct LayerConvolution1DSaveableParams : SubGraphSaveableParams<TensorType>
 {
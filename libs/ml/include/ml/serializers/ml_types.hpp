@@ -141,6 +141,12 @@ void SerializeAnyOp(MapType &map, uint8_t code, fetch::ml::OpType const &op_type
     SerializeImplementation<TensorType, D, ml::OpFlattenSaveableParams<TensorType>>(map, code, op);
     break;
   }
+  case ml::OpType::OP_FUSED_ATTENTION:
+  {
+    SerializeImplementation<TensorType, D, ml::OpFusedAttentionSaveableParams<TensorType>>(
+        map, code, op);
+    break;
+  }
   case ml::OpType::OP_LAYER_NORM:
   {
     SerializeImplementation<TensorType, D, ml::OpLayerNormSaveableParams<TensorType>>(map, code,
@@ -502,6 +508,12 @@ void DeserializeAnyOp(MapType &map, uint8_t code, fetch::ml::OpType const &op_ty
                                                                                            code);
     break;
   }
+  case ml::OpType::OP_FUSED_ATTENTION:
+  {
+    op = DeserializeImplementation<TensorType, D, ml::OpFusedAttentionSaveableParams<TensorType>>(
+        map, code);
+    break;
+  }
   case ml::OpType::OP_LAYER_NORM:
   {
     op = DeserializeImplementation<TensorType, D, ml::OpLayerNormSaveableParams<TensorType>>(map,
@@ -1602,6 +1614,59 @@ struct MapSerializer<ml::OpFlattenSaveableParams<TensorType>, D>
   }
 };
 
+/**
+ * serializer for FusedAttention saveable params
+ * @tparam TensorType
+ */
+template <typename TensorType, typename D>
+struct MapSerializer<ml::OpFusedAttentionSaveableParams<TensorType>, D>
+{
+  using Type       = ml::OpFusedAttentionSaveableParams<TensorType>;
+  using DriverType = D;
+
+  static uint8_t const BASE_OPS    = 1;
+  static uint8_t const OP_CODE     = 2;
+  static uint8_t const KEY_DIM     = 3;
+  static uint8_t const PROBABILITY = 4;
+  static uint8_t const FILL_VALUE  = 5;
+  static uint8_t const RANDOM_SEED = 6;
+  static uint8_t const BUFFER      = 7;
+  static uint8_t const INDEX       = 8;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &sp)
+  {
+    auto map = map_constructor(8);
+
+    // serialize parent class first
+    auto ops_pointer = static_cast<ml::OpsSaveableParams const *>(&sp);
+    map.Append(BASE_OPS, *(ops_pointer));
+
+    map.Append(OP_CODE, sp.op_type);
+    map.Append(KEY_DIM, sp.key_dim);
+    map.Append(PROBABILITY, sp.probability);
+    map.Append(FILL_VALUE, sp.fill_value);
+    map.Append(RANDOM_SEED, sp.random_seed);
+    map.Append(BUFFER, sp.buffer);
+    map.Append(INDEX, sp.index);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &sp)
+  {
+    auto ops_pointer = static_cast<ml::OpsSaveableParams *>(&sp);
+    map.ExpectKeyGetValue(BASE_OPS, (*ops_pointer));
+
+    map.ExpectKeyGetValue(OP_CODE, sp.op_type);
+    map.ExpectKeyGetValue(KEY_DIM, sp.key_dim);
+    map.ExpectKeyGetValue(PROBABILITY, sp.probability);
+    map.ExpectKeyGetValue(FILL_VALUE, sp.fill_value);
+    map.ExpectKeyGetValue(RANDOM_SEED, sp.random_seed);
+    map.ExpectKeyGetValue(BUFFER, sp.buffer);
+    map.ExpectKeyGetValue(INDEX, sp.index);
+  }
+};
+
 /**
  * serializer for Elu saveable params
  * @tparam TensorType
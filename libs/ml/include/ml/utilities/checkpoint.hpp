@@ -0,0 +1,224 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/base_types.hpp"
+#include "core/serializers/group_definitions.hpp"
+#include "ml/exceptions/exceptions.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace utilities {
+
+/**
+ * A weight tensor stored in a checkpoint, as the raw (padded) storage of the tensor
+ */
+struct CheckpointEntry
+{
+  std::string           name{};
+  std::vector<uint64_t> shape{};
+  uint64_t              offset{0};  ///< Byte offset of the storage from the start of the file
+  uint64_t              length{0};  ///< Byte length of the storage
+  uint64_t              hash{0};    ///< Hash of the storage, to detect unchanged weights
+};
+
+using CheckpointEntries = std::vector<CheckpointEntry>;
+
+/**
+ * Writes weights to a checkpoint file.
+ *
+ * A checkpoint file starts with a fixed size header which locates the index of the file, the
+ * index lists the weights and where their storage is in the file. The storage of every tensor is
+ * written unchanged and aligned, so that it can be memory mapped and used in place.
+ *
+ * The file is only ever appended to, apart from the header. Writing to an existing checkpoint only
+ * appends the weights which changed since they were last written, followed by a new index which
+ * refers to the previously written storage of the unchanged weights. Readers which opened the file
+ * before are unaffected. Since the storage of old weights is never reclaimed, write to a new file
+ * to compact a checkpoint.
+ */
+class CheckpointWriter
+{
+public:
+  CheckpointWriter(std::string filename, uint32_t element_size);
+  CheckpointWriter(CheckpointWriter const &other) = delete;
+  CheckpointWriter &operator=(CheckpointWriter const &other) = delete;
+  ~CheckpointWriter()                                        = default;
+
+  void Write(std::string const &name, std::vector<uint64_t> const &shape, uint8_t const *data,
+             uint64_t length);
+  void Commit();
+
+  uint64_t bytes_written() const;
+
+private:
+  void     Append(uint8_t const *data, uint64_t length);
+  uint64_t Align();
+
+  std::string       filename_;
+  uint32_t          element_size_;
+  std::fstream      file_;
+  uint64_t          file_size_{0};
+  uint64_t          bytes_written_{0};
+  CheckpointEntries previous_{};
+  CheckpointEntries entries_{};
+};
+
+/**
+ * A read only view of a checkpoint file, which is memory mapped in its entirety.
+ *
+ * The mapping is private, writes to the weights are never written back to the file and pages which
+ * are not written to are shared with every other process which maps the same file.
+ */
+class CheckpointReader
+{
+public:
+  explicit CheckpointReader(std::string const &filename);
+
+  uint32_t                 element_size() const;
+  CheckpointEntries const &entries() const;
+  CheckpointEntry const *  Find(std::string const &name) const;
+  std::shared_ptr<uint8_t> Storage(CheckpointEntry const &entry) const;
+
+private:
+  std::shared_ptr<uint8_t> mapping_{};
+  uint64_t                 size_{0};
+  uint32_t                 element_size_{0};
+  CheckpointEntries        entries_{};
+};
+
+/**
+ * Saves the weights of a graph to a checkpoint file, only the weights which changed since the
+ * last save to the same file are written
+ * @param g the graph to save
+ * @param filename the checkpoint file
+ */
+template <typename GraphType>
+void SaveCheckpoint(GraphType const &g, std::string const &filename)
+{
+  using TensorType = typename GraphType::TensorType;
+  using DataType   = typename TensorType::Type;
+
+  std::vector<std::string> names   = g.GetTrainableNames();
+  std::vector<TensorType>  weights = g.GetWeightsReferences();
+
+  CheckpointWriter writer(filename, static_cast<uint32_t>(sizeof(DataType)));
+  for (std::size_t i = 0; i < weights.size(); ++i)
+  {
+    auto const &shape  = weights[i].shape();
+    auto const  length = TensorType::PaddedSizeFromShape(shape) * sizeof(DataType);
+
+    writer.Write(names[i], std::vector<uint64_t>(shape.begin(), shape.end()),
+                 reinterpret_cast<uint8_t const *>(weights[i].data().pointer()), length);
+  }
+  writer.Commit();
+}
+
+/**
+ * Loads the weights of a graph from a checkpoint file. The weights are not copied, they are used
+ * in place in the memory mapped file
+ * @param g the graph to load into, which must have the same trainables as the saved graph
+ * @param filename the checkpoint file
+ */
+template <typename GraphType>
+void LoadCheckpoint(GraphType &g, std::string const &filename)
+{
+  using TensorType    = typename GraphType::TensorType;
+  using DataType      = typename TensorType::Type;
+  using ContainerType = typename TensorType::ContainerType;
+  using SizeVector    = typename TensorType::SizeVector;
+
+  CheckpointReader reader(filename);
+  if (reader.element_size() != sizeof(DataType))
+  {
+    throw exceptions::InvalidFile("Checkpoint " + filename + " has a different data type");
+  }
+
+  std::vector<TensorType> weights;
+  for (auto const &name : g.GetTrainableNames())
+  {
+    CheckpointEntry const *entry = reader.Find(name);
+    if (entry == nullptr)
+    {
+      throw exceptions::InvalidFile("Checkpoint " + filename + " has no weights for " + name);
+    }
+
+    SizeVector const shape(entry->shape.begin(), entry->shape.end());
+    auto const       size = TensorType::PaddedSizeFromShape(shape);
+    if (entry->length < size * sizeof(DataType))
+    {
+      throw exceptions::InvalidFile("Checkpoint " + filename + " is corrupt at " + name);
+    }
+
+    std::shared_ptr<uint8_t> storage = reader.Storage(*entry);
+    std::shared_ptr<DataType> data{storage, reinterpret_cast<DataType *>(storage.get())};
+
+    weights.emplace_back(shape, ContainerType{std::move(data), size});
+  }
+
+  g.SetWeightsReferences(weights);
+}
+
+}  // namespace utilities
+}  // namespace ml
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<ml::utilities::CheckpointEntry, D>
+{
+public:
+  using Type       = ml::utilities::CheckpointEntry;
+  using DriverType = D;
+
+  static uint8_t const NAME   = 1;
+  static uint8_t const SHAPE  = 2;
+  static uint8_t const OFFSET = 3;
+  static uint8_t const LENGTH = 4;
+  static uint8_t const HASH   = 5;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &entry)
+  {
+    auto map = map_constructor(5);
+    map.Append(NAME, entry.name);
+    map.Append(SHAPE, entry.shape);
+    map.Append(OFFSET, entry.offset);
+    map.Append(LENGTH, entry.length);
+    map.Append(HASH, entry.hash);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &entry)
+  {
+    map.ExpectKeyGetValue(NAME, entry.name);
+    map.ExpectKeyGetValue(SHAPE, entry.shape);
+    map.ExpectKeyGetValue(OFFSET, entry.offset);
+    map.ExpectKeyGetValue(LENGTH, entry.length);
+    map.ExpectKeyGetValue(HASH, entry.hash);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
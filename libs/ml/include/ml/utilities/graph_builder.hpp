@@ -46,12 +46,14 @@
 #include "ml/ops/avg_pool_1d.hpp"
 #include "ml/ops/avg_pool_2d.hpp"
 #include "ml/ops/concatenate.hpp"
+#include "ml/ops/constant.hpp"
 #include "ml/ops/convolution_1d.hpp"
 #include "ml/ops/convolution_2d.hpp"
 #include "ml/ops/divide.hpp"
 #include "ml/ops/embeddings.hpp"
 #include "ml/ops/exp.hpp"
 #include "ml/ops/flatten.hpp"
+#include "ml/ops/fused_attention.hpp"
 #include "ml/ops/log.hpp"
 #include "ml/ops/loss_functions/cross_entropy_loss.hpp"
 #include "ml/ops/loss_functions/mean_square_error_loss.hpp"
@@ -240,6 +242,13 @@ void BuildNodeAndInsertTrainables(NodeSaveableParams<T> const &nsp, std::string
     g->AddTrainable(node, name);
     break;
   }
+  case ops::FusedAttention<T>::OpCode():
+  {
+    op_ptr = GetOp<ops::FusedAttention<T>>(nsp.op_save_params);
+    node->SetNodeSaveableParams(nsp, op_ptr);
+    g->AddTrainable(node, name);
+    break;
+  }
   case ops::Gelu<T>::OpCode():
   {
     op_ptr = GetOp<ops::Gelu<T>>(nsp.op_save_params);
@@ -19,12 +19,36 @@
 
 #include "math/tensor/tensor.hpp"
 
+#include <unordered_set>
 #include <vector>
 
 namespace fetch {
 namespace ml {
 namespace utilities {
 
+/**
+ * Compact representation of a row sparse gradient. Only the updated rows are stored, so the size
+ * of the representation is proportional to the number of rows touched in a batch rather than to
+ * the size of the full tensor (e.g. an embedding table).
+ * An empty set of rows means that the gradient is dense, in which case values holds the full
+ * gradient tensor.
+ * @tparam TensorType
+ */
+template <class TensorType>
+struct SparseGradient
+{
+  using SizeType   = fetch::math::SizeType;
+  using SizeVector = std::vector<SizeType>;
+
+  TensorType values;  ///< the updated rows, stored one per slice of the trailing dimension
+  SizeVector rows;    ///< the index in the full tensor of each slice of values
+
+  bool IsSparse() const
+  {
+    return !rows.empty();
+  }
+};
+
 /**
  * Add update_rows from src Tensor to dst Tensor if number of required slices is lower than
  * threshold. If number of required slices is higher than threshold, function just inlineAdd src to
@@ -138,6 +162,31 @@ TensorType ToSparse(TensorType const &                               src,
   return std::move(dst);
 }
 
+/**
+ * Copy the specified rows of src into a compact tensor, in the order they are listed
+ * @tparam TensorType
+ * @param src source tensor
+ * @param update_rows rows to be copied
+ * @return tensor of shape {src.shape(0), update_rows.size()}
+ */
+template <class TensorType>
+TensorType ToSparse(TensorType const &src, std::vector<fetch::math::SizeType> const &update_rows)
+{
+  using SizeType = fetch::math::SizeType;
+
+  TensorType dst({src.shape().at(0), update_rows.size()});
+
+  SizeType dst_index = 0;
+  for (SizeType src_index : update_rows)
+  {
+    auto dst_view = dst.View(dst_index);
+    dst_view.Assign(src.View(src_index));
+    dst_index++;
+  }
+
+  return dst;
+}
+
 template <class TensorType>
 TensorType FromSparse(TensorType const &                               src,
                       std::unordered_set<fetch::math::SizeType> const &update_rows,
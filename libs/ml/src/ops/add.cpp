@@ -85,6 +85,61 @@ std::vector<math::SizeType> Add<TensorType>::ComputeOutputShape(VecTensorType co
   return inputs.at(0)->shape();
 }
 
+template <typename TensorType>
+bool Add<TensorType>::SupportsInPlace() const
+{
+  return true;
+}
+
+template <typename TensorType>
+bool Add<TensorType>::IsElementwise() const
+{
+  return true;
+}
+
+/**
+ * In addition to inputs of the same shape, a range can be computed when the second input is a
+ * column (e.g. a bias) which is broadcast over the remaining dimensions
+ */
+template <typename TensorType>
+bool Add<TensorType>::SupportsForwardRange(VecTensorType const &inputs) const
+{
+  assert(inputs.size() == 2);
+  auto const &shape      = inputs.at(0)->shape();
+  auto const &bias_shape = inputs.at(1)->shape();
+
+  return (shape == bias_shape) ||
+         (!shape.empty() && !bias_shape.empty() && (shape.front() == bias_shape.front()) &&
+          (inputs.at(1)->size() == bias_shape.front()));
+}
+
+template <typename TensorType>
+void Add<TensorType>::ForwardRange(VecTensorType const &inputs, TensorType &output, SizeType begin,
+                                   SizeType end)
+{
+  assert(inputs.size() == 2);
+  DataType const *input = inputs.at(0)->data().pointer();
+  DataType const *other = inputs.at(1)->data().pointer();
+  DataType *      ret   = output.data().pointer();
+
+  if (inputs.at(0)->shape() == inputs.at(1)->shape())
+  {
+    for (SizeType i = begin; i < end; ++i)
+    {
+      ret[i] = static_cast<DataType>(input[i] + other[i]);
+    }
+  }
+  else
+  {
+    // the column shares the padded height of the output
+    SizeType const padded_height = output.padded_height();
+    for (SizeType i = begin; i < end; ++i)
+    {
+      ret[i] = static_cast<DataType>(input[i] + other[i % padded_height]);
+    }
+  }
+}
+
 /**
  * method for updating axes in case of broadcast Add
  * @tparam TensorType
@@ -17,12 +17,90 @@
 //------------------------------------------------------------------------------
 
 #include "math/matrix_operations.hpp"
+#include "meta/type_traits.hpp"
 #include "ml/ops/convolution_2d.hpp"
 #include "ml/saveparams/saveable_params.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
 
 namespace fetch {
 namespace ml {
 namespace ops {
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+std::atomic<std::size_t> convolution_concurrency{1};
+
+threading::Pool &ConvolutionPool()
+{
+  static threading::Pool pool{std::max(1u, std::thread::hardware_concurrency()), "Conv"};
+  return pool;
+}
+
+/**
+ * Split the batch into contiguous ranges which are processed in parallel. The work for each
+ * sample must be independent of all the other samples.
+ *
+ * @param batch_size The size of the batch
+ * @param function The callable invoked as function(begin, end) for each range of samples
+ */
+template <typename Function>
+void ForEachBatch(SizeType batch_size, Function const &function)
+{
+  SizeType const num_tasks = std::min<SizeType>(batch_size, ConvolutionConcurrency());
+
+  if (num_tasks <= 1)
+  {
+    function(SizeType{0}, batch_size);
+    return;
+  }
+
+  auto const process = [&function, batch_size, num_tasks](SizeType task) {
+    function((task * batch_size) / num_tasks, ((task + 1) * batch_size) / num_tasks);
+  };
+
+  std::vector<std::future<void>> tasks{};
+  tasks.reserve(num_tasks - 1);
+
+  for (SizeType task = 1; task < num_tasks; ++task)
+  {
+    tasks.emplace_back(ConvolutionPool().Dispatch(process, task));
+  }
+
+  process(0);
+
+  for (auto &task : tasks)
+  {
+    task.get();
+  }
+}
+
+}  // namespace
+
+void SetConvolutionConcurrency(std::size_t concurrency)
+{
+  convolution_concurrency = std::max<std::size_t>(concurrency, 1);
+}
+
+std::size_t ConvolutionConcurrency()
+{
+  return convolution_concurrency;
+}
+
+template <typename TensorType>
+constexpr typename Convolution2D<TensorType>::SizeType
+    Convolution2D<TensorType>::MIN_WINOGRAD_OUTPUT_SIZE;
+template <typename TensorType>
+constexpr typename Convolution2D<TensorType>::SizeType Convolution2D<TensorType>::WINOGRAD_TILE;
+template <typename TensorType>
+constexpr typename Convolution2D<TensorType>::SizeType Convolution2D<TensorType>::WINOGRAD_INPUT;
+template <typename TensorType>
+constexpr typename Convolution2D<TensorType>::SizeType Convolution2D<TensorType>::WINOGRAD_SIZE;
 
 template <typename TensorType>
 std::shared_ptr<OpsSaveableParams> Convolution2D<TensorType>::GetOpSaveableParams()
@@ -39,7 +117,7 @@ std::shared_ptr<fetch::ml::ops::Ops<TensorType>> Convolution2D<TensorType>::Make
   FETCH_UNUSED(me);
   assert(me.get() == this);
 
-  auto copyshare = std::make_shared<MyType>(*this);  // calls default copy constructor of MyType
+  auto copyshare = std::make_shared<MyType>(*this);  // calls copy constructor of MyType
 
   return copyshare;
 }
@@ -47,6 +125,7 @@ std::shared_ptr<fetch::ml::ops::Ops<TensorType>> Convolution2D<TensorType>::Make
 /**
  * Applies 2D convolution using im2col with General Matrix Multiplication described here:
  * https://www.scss.tcd.ie/~andersan/static/papers/asap-2017.pdf
+ * Large floating point 3x3 convolutions with a stride of 1 use the Winograd kernel instead.
  * @param inputs vector of tensor references where at:
  * inputs[0] = input_data[input_channels x input_height x input_width x batch_position], inputs[1] =
  * kernel_data[kernel_channels x kernel_height x kernel_width x batch_position]
@@ -75,28 +154,34 @@ void Convolution2D<TensorType>::Forward(VecTensorType const &inputs, TensorType
   SizeType output_height   = output.shape().at(1);
   SizeType output_width    = output.shape().at(2);
 
+  if (IsWinograd(stride_size_, kernel_height, kernel_width, output_height, output_width))
+  {
+    ForwardWinograd(input, kernels, output);
+    return;
+  }
+
   SizeType horizontal_stride_width  = kernel_width * kernel_height * input_channels;
   SizeType horizontal_stride_height = output_height * output_width * batch_size;
   SizeType vertical_stride_width    = output_channels;
 
   // Horizontal stride contains input data
-  TensorType horizontal_stride{{horizontal_stride_width, horizontal_stride_height}};
+  PrepareWorkspace(horizontal_stride_, {horizontal_stride_width, horizontal_stride_height});
   // Vertical stride contains kernel data
-  TensorType vertical_stride{{vertical_stride_width, horizontal_stride_width}};
+  PrepareWorkspace(vertical_stride_, {vertical_stride_width, horizontal_stride_width});
 
   // Reshape input data to horizontal stride - im2col
-  FillHorizontalStride(input, horizontal_stride, output_height, output_width, input_channels,
+  FillHorizontalStride(input, horizontal_stride_, output_height, output_width, input_channels,
                        kernel_height, kernel_width, batch_size);
 
   // Reshape kernel data to vertical stride - im2col
-  FillVerticalStride(kernels, vertical_stride, output_channels, input_channels, kernel_height,
+  FillVerticalStride(kernels, vertical_stride_, output_channels, input_channels, kernel_height,
                      kernel_width);
 
   // Do matmul
-  TensorType reshaped_output = fetch::math::Dot(vertical_stride, horizontal_stride);
+  fetch::math::Dot(vertical_stride_, horizontal_stride_, gemm_output_);
 
   // Reshape values after matmul to output
-  FillOutput(reshaped_output, output, output_channels, output_height, output_width, batch_size);
+  FillOutput(gemm_output_, output, output_channels, output_height, output_width, batch_size);
 }
 
 /**
@@ -144,32 +229,35 @@ std::vector<TensorType> Convolution2D<TensorType>::Backward(VecTensorType const
   SizeType vertical_stride_width    = output_channels;
 
   // Horizontal stride contains input data
-  TensorType horizontal_stride{{horizontal_stride_width, horizontal_stride_height}};
+  PrepareWorkspace(horizontal_stride_, {horizontal_stride_width, horizontal_stride_height});
   // Vertical stride contains kernel data
-  TensorType vertical_stride{{vertical_stride_width, horizontal_stride_width}};
+  PrepareWorkspace(vertical_stride_, {vertical_stride_width, horizontal_stride_width});
 
   // Reshape input data to horizontal stride - im2col
-  FillHorizontalStride(input, horizontal_stride, output_height, output_width, input_channels,
+  FillHorizontalStride(input, horizontal_stride_, output_height, output_width, input_channels,
                        kernel_height, kernel_width, batch_size);
 
   // Reshape kernel data to vertical stride - im2col
-  FillVerticalStride(kernels, vertical_stride, output_channels, input_channels, kernel_height,
+  FillVerticalStride(kernels, vertical_stride_, output_channels, input_channels, kernel_height,
                      kernel_width);
 
   // Reshape error_signal to error for matmul
-  TensorType error{{vertical_stride_width, horizontal_stride_height}};
-  ReverseFillOutput(error, error_signal, output_channels, output_height, output_width, batch_size);
+  PrepareWorkspace(error_, {vertical_stride_width, horizontal_stride_height});
+  ReverseFillOutput(error_, error_signal, output_channels, output_height, output_width,
+                    batch_size);
 
   // Backwards matmul
-  TensorType error2 = fetch::math::DotTranspose(error, horizontal_stride);
-  TensorType error1 = fetch::math::TransposeDot(vertical_stride, error);
+  PrepareWorkspace(error2_, {vertical_stride_width, horizontal_stride_width});
+  PrepareWorkspace(error1_, {horizontal_stride_width, horizontal_stride_height});
+  fetch::math::DotTranspose(error_, horizontal_stride_, error2_);
+  fetch::math::TransposeDot(vertical_stride_, error_, error1_);
 
   // Reshape horizontal stride to input data error_signal - reversed im2col
-  ReverseFillHorizontalStride(input_error, error1, output_height, output_width, input_channels,
+  ReverseFillHorizontalStride(input_error, error1_, output_height, output_width, input_channels,
                               kernel_height, kernel_width, batch_size);
 
   // Reshape vertical stride to kernel data error_signal - reversed im2col
-  ReverseFillVerticalStride(kernel_error, error2, output_channels, input_channels, kernel_height,
+  ReverseFillVerticalStride(kernel_error, error2_, output_channels, input_channels, kernel_height,
                             kernel_width);
 
   return {input_error, kernel_error};
@@ -285,34 +373,35 @@ void Convolution2D<TensorType>::FillHorizontalStride(
     SizeType const output_width, SizeType const input_channels, SizeType const kernel_height,
     SizeType const kernel_width, SizeType const batch_size)
 {
-  SizeType i_s;  // stride width index
-  SizeType j_s;  // stride height index
+  ForEachBatch(batch_size, [&](SizeType batch_begin, SizeType batch_end) {
+    SizeType i_s;                                                // stride width index
+    SizeType j_s = batch_begin * output_height * output_width;  // stride height index
 
-  j_s = 0;
-  for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
-  {
-    for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
+    for (SizeType i_b{batch_begin}; i_b < batch_end; ++i_b)  // Iterate over batch
     {
-      for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
+      for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
       {
-        i_s = 0;
-        for (SizeType i_ic(0); i_ic < input_channels; ++i_ic)  // Iterate over input channels
+        for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
         {
-
-          for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
+          i_s = 0;
+          for (SizeType i_ic(0); i_ic < input_channels; ++i_ic)  // Iterate over input channels
           {
-            for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
+
+            for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
             {
-              horizontal_stride(i_s, j_s) =
-                  input.At(i_ic, i_o * stride_size_ + i_k, j_o * stride_size_ + j_k, i_b);
-              ++i_s;
+              for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
+              {
+                horizontal_stride(i_s, j_s) =
+                    input.At(i_ic, i_o * stride_size_ + i_k, j_o * stride_size_ + j_k, i_b);
+                ++i_s;
+              }
             }
           }
+          ++j_s;
         }
-        ++j_s;
       }
     }
-  }
+  });
 }
 
 // TODO(issue 943): Make im2col efficient using iterators
@@ -333,34 +422,35 @@ void Convolution2D<TensorType>::ReverseFillHorizontalStride(
     SizeType const output_width, SizeType const input_channels, SizeType const kernel_height,
     SizeType const kernel_width, SizeType const batch_size)
 {
-  SizeType i_s;  // stride width index
-  SizeType j_s;  // stride height index
+  ForEachBatch(batch_size, [&](SizeType batch_begin, SizeType batch_end) {
+    SizeType i_s;                                                // stride width index
+    SizeType j_s = batch_begin * output_height * output_width;  // stride height index
 
-  j_s = 0;
-  for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
-  {
-    for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
+    for (SizeType i_b{batch_begin}; i_b < batch_end; ++i_b)  // Iterate over batch
     {
-      for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
+      for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
       {
-        i_s = 0;
-        for (SizeType i_ic(0); i_ic < input_channels; ++i_ic)  // Iterate over input channels
+        for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
         {
-
-          for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
+          i_s = 0;
+          for (SizeType i_ic(0); i_ic < input_channels; ++i_ic)  // Iterate over input channels
           {
-            for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
+
+            for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
             {
-              input(i_ic, i_o * stride_size_ + i_k, j_o * stride_size_ + j_k, i_b) =
-                  horizontal_stride.At(i_s, j_s);
-              ++i_s;
+              for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
+              {
+                input(i_ic, i_o * stride_size_ + i_k, j_o * stride_size_ + j_k, i_b) =
+                    horizontal_stride.At(i_s, j_s);
+                ++i_s;
+              }
             }
           }
+          ++j_s;
         }
-        ++j_s;
       }
     }
-  }
+  });
 }
 
 // TODO(issue 943): Make im2col efficient using iterators
@@ -380,22 +470,24 @@ void Convolution2D<TensorType>::FillOutput(TensorType const &gemm_output, Tensor
                                            SizeType const output_width, SizeType const batch_size)
 {
 
-  SizeType it;
-  for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
-  {
-    it = 0;
-    for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
+  ForEachBatch(batch_size, [&](SizeType batch_begin, SizeType batch_end) {
+    SizeType it;
+    for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
     {
-      for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
+      it = batch_begin * output_height * output_width;
+      for (SizeType i_b{batch_begin}; i_b < batch_end; ++i_b)  // Iterate over batch
       {
-        for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
+        for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
         {
-          output(i_oc, i_o, j_o, i_b) = gemm_output.At(i_oc, it);
-          ++it;
+          for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
+          {
+            output(i_oc, i_o, j_o, i_b) = gemm_output.At(i_oc, it);
+            ++it;
+          }
         }
       }
     }
-  }
+  });
 }
 
 // TODO(issue 943): Make im2col efficient using iterators
@@ -416,21 +508,238 @@ void Convolution2D<TensorType>::ReverseFillOutput(TensorType &gemm_output, Tenso
                                                   SizeType const batch_size)
 {
 
-  SizeType it;
+  ForEachBatch(batch_size, [&](SizeType batch_begin, SizeType batch_end) {
+    SizeType it;
+    for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
+    {
+      it = batch_begin * output_height * output_width;
+      for (SizeType i_b{batch_begin}; i_b < batch_end; ++i_b)  // Iterate over batch
+      {
+        for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
+        {
+          for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
+          {
+            gemm_output(i_oc, it) = output.At(i_oc, i_o, j_o, i_b);
+            ++it;
+          }
+        }
+      }
+    }
+  });
+}
+
+/**
+ * Check whether a convolution is computed with the Winograd kernel. Winograd changes the rounding
+ * of the result so it is only used for the floating point types.
+ * @param stride_size
+ * @param kernel_height
+ * @param kernel_width
+ * @param output_height
+ * @param output_width
+ * @return true if the Winograd kernel is used, otherwise false
+ */
+template <class TensorType>
+bool Convolution2D<TensorType>::IsWinograd(SizeType const stride_size,
+                                           SizeType const kernel_height,
+                                           SizeType const kernel_width,
+                                           SizeType const output_height,
+                                           SizeType const output_width)
+{
+  return fetch::meta::IsFloat<DataType> && (stride_size == 1) && (kernel_height == 3) &&
+         (kernel_width == 3) && ((output_height * output_width) >= MIN_WINOGRAD_OUTPUT_SIZE);
+}
+
+/**
+ * Applies 3x3 convolution with a stride of 1 using the Winograd F(2x2, 3x3) algorithm described
+ * here: https://arxiv.org/abs/1509.09308
+ * Each 2x2 tile of the output needs 16 multiplications rather than 36. The transformed tiles are
+ * multiplied with a matrix multiplication for each of the 16 tile elements.
+ * @param input tensor of size [input_channels x input_height x input_width x batch_position]
+ * @param kernels tensor of size [output_channels x input_channels x 3 x 3 x 1]
+ * @param output tensor of size [output_channels x output_height x output_width x batch_position]
+ */
+template <class TensorType>
+void Convolution2D<TensorType>::ForwardWinograd(TensorType const &input, TensorType const &kernels,
+                                                TensorType &output)
+{
+  SizeType const input_channels  = input.shape().at(0);
+  SizeType const input_height    = input.shape().at(1);
+  SizeType const input_width     = input.shape().at(2);
+  SizeType const batch_size      = input.shape().at(3);
+  SizeType const output_channels = kernels.shape().at(0);
+  SizeType const output_height   = output.shape().at(1);
+  SizeType const output_width    = output.shape().at(2);
+
+  SizeType const tiles_height     = (output_height + WINOGRAD_TILE - 1) / WINOGRAD_TILE;
+  SizeType const tiles_width      = (output_width + WINOGRAD_TILE - 1) / WINOGRAD_TILE;
+  SizeType const tiles_per_sample = tiles_height * tiles_width;
+  SizeType const num_tiles        = tiles_per_sample * batch_size;
+
+  winograd_kernels_.resize(WINOGRAD_SIZE);
+  winograd_inputs_.resize(WINOGRAD_SIZE);
+  winograd_outputs_.resize(WINOGRAD_SIZE);
+  for (SizeType x{0}; x < WINOGRAD_SIZE; ++x)
+  {
+    PrepareWorkspace(winograd_kernels_[x], {output_channels, input_channels});
+    PrepareWorkspace(winograd_inputs_[x], {input_channels, num_tiles});
+    PrepareWorkspace(winograd_outputs_[x], {output_channels, num_tiles});
+  }
+
+  DataType const half = DataType{1} / DataType{2};
+
+  // Transform the kernels U = G g G^T
   for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
   {
-    it = 0;
-    for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
+    for (SizeType i_ic{0}; i_ic < input_channels; ++i_ic)  // Iterate over input channels
     {
-      for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
+      DataType s[WINOGRAD_INPUT][3];
+      for (SizeType j{0}; j < 3; ++j)
       {
-        for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
+        DataType const g0 = kernels.At(i_oc, i_ic, 0, j, 0);
+        DataType const g1 = kernels.At(i_oc, i_ic, 1, j, 0);
+        DataType const g2 = kernels.At(i_oc, i_ic, 2, j, 0);
+
+        s[0][j] = g0;
+        s[1][j] = half * (g0 + g1 + g2);
+        s[2][j] = half * (g0 - g1 + g2);
+        s[3][j] = g2;
+      }
+
+      for (SizeType i{0}; i < WINOGRAD_INPUT; ++i)
+      {
+        SizeType const x = i * WINOGRAD_INPUT;
+
+        winograd_kernels_[x](i_oc, i_ic)     = s[i][0];
+        winograd_kernels_[x + 1](i_oc, i_ic) = half * (s[i][0] + s[i][1] + s[i][2]);
+        winograd_kernels_[x + 2](i_oc, i_ic) = half * (s[i][0] - s[i][1] + s[i][2]);
+        winograd_kernels_[x + 3](i_oc, i_ic) = s[i][2];
+      }
+    }
+  }
+
+  // Transform the input tiles V = B^T d B, the tiles overlapping the edge are padded with zeros
+  ForEachBatch(batch_size, [&](SizeType batch_begin, SizeType batch_end) {
+    DataType d[WINOGRAD_INPUT][WINOGRAD_INPUT];
+    DataType t[WINOGRAD_INPUT][WINOGRAD_INPUT];
+
+    for (SizeType i_b{batch_begin}; i_b < batch_end; ++i_b)  // Iterate over batch
+    {
+      for (SizeType i_t{0}; i_t < tiles_height; ++i_t)  // Iterate over tile rows
+      {
+        for (SizeType j_t{0}; j_t < tiles_width; ++j_t)  // Iterate over tile columns
+        {
+          SizeType const tile = (i_b * tiles_per_sample) + (i_t * tiles_width) + j_t;
+
+          // channels are innermost since they are contiguous in both the input and the tiles
+          for (SizeType i_ic{0}; i_ic < input_channels; ++i_ic)  // Iterate over input channels
+          {
+
+            for (SizeType i{0}; i < WINOGRAD_INPUT; ++i)
+            {
+              SizeType const row = (i_t * WINOGRAD_TILE) + i;
+              for (SizeType j{0}; j < WINOGRAD_INPUT; ++j)
+              {
+                SizeType const col = (j_t * WINOGRAD_TILE) + j;
+
+                d[i][j] = ((row < input_height) && (col < input_width))
+                              ? input.At(i_ic, row, col, i_b)
+                              : DataType{0};
+              }
+            }
+
+            for (SizeType j{0}; j < WINOGRAD_INPUT; ++j)
+            {
+              t[0][j] = d[0][j] - d[2][j];
+              t[1][j] = d[1][j] + d[2][j];
+              t[2][j] = d[2][j] - d[1][j];
+              t[3][j] = d[1][j] - d[3][j];
+            }
+
+            for (SizeType i{0}; i < WINOGRAD_INPUT; ++i)
+            {
+              SizeType const x = i * WINOGRAD_INPUT;
+
+              winograd_inputs_[x](i_ic, tile)     = t[i][0] - t[i][2];
+              winograd_inputs_[x + 1](i_ic, tile) = t[i][1] + t[i][2];
+              winograd_inputs_[x + 2](i_ic, tile) = t[i][2] - t[i][1];
+              winograd_inputs_[x + 3](i_ic, tile) = t[i][1] - t[i][3];
+            }
+          }
+        }
+      }
+    }
+  });
+
+  // Multiply each element of the transformed tiles, summing over the input channels M = U V
+  for (SizeType x{0}; x < WINOGRAD_SIZE; ++x)
+  {
+    fetch::math::Dot(winograd_kernels_[x], winograd_inputs_[x], winograd_outputs_[x]);
+  }
+
+  // Transform the output tiles Y = A^T M A, discarding anything beyond the edge of the output
+  ForEachBatch(batch_size, [&](SizeType batch_begin, SizeType batch_end) {
+    DataType m[WINOGRAD_INPUT][WINOGRAD_INPUT];
+    DataType w[WINOGRAD_TILE][WINOGRAD_INPUT];
+
+    for (SizeType i_b{batch_begin}; i_b < batch_end; ++i_b)  // Iterate over batch
+    {
+      for (SizeType i_t{0}; i_t < tiles_height; ++i_t)  // Iterate over tile rows
+      {
+        for (SizeType j_t{0}; j_t < tiles_width; ++j_t)  // Iterate over tile columns
         {
-          gemm_output(i_oc, it) = output.At(i_oc, i_o, j_o, i_b);
-          ++it;
+          SizeType const tile = (i_b * tiles_per_sample) + (i_t * tiles_width) + j_t;
+
+          for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
+          {
+
+            for (SizeType i{0}; i < WINOGRAD_INPUT; ++i)
+            {
+              for (SizeType j{0}; j < WINOGRAD_INPUT; ++j)
+              {
+                m[i][j] = winograd_outputs_[(i * WINOGRAD_INPUT) + j].At(i_oc, tile);
+              }
+            }
+
+            for (SizeType j{0}; j < WINOGRAD_INPUT; ++j)
+            {
+              w[0][j] = m[0][j] + m[1][j] + m[2][j];
+              w[1][j] = m[1][j] - m[2][j] - m[3][j];
+            }
+
+            SizeType const col = j_t * WINOGRAD_TILE;
+            for (SizeType i{0}; i < WINOGRAD_TILE; ++i)
+            {
+              SizeType const row = (i_t * WINOGRAD_TILE) + i;
+              if (row >= output_height)
+              {
+                break;
+              }
+
+              output(i_oc, row, col, i_b) = w[i][0] + w[i][1] + w[i][2];
+              if ((col + 1) < output_width)
+              {
+                output(i_oc, row, col + 1, i_b) = w[i][1] - w[i][2] - w[i][3];
+              }
+            }
+          }
         }
       }
     }
+  });
+}
+
+/**
+ * Reallocate a workspace tensor only when its shape needs to change
+ * @param workspace
+ * @param shape
+ */
+template <class TensorType>
+void Convolution2D<TensorType>::PrepareWorkspace(TensorType &                 workspace,
+                                                 std::vector<SizeType> const &shape)
+{
+  if (workspace.shape() != shape)
+  {
+    workspace = TensorType(shape);
   }
 }
 
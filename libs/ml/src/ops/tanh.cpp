@@ -98,6 +98,37 @@ std::vector<math::SizeType> TanH<TensorType>::ComputeOutputShape(VecTensorType c
   return inputs.front()->shape();
 }
 
+template <typename TensorType>
+bool TanH<TensorType>::SupportsInPlace() const
+{
+  return true;
+}
+
+template <typename TensorType>
+bool TanH<TensorType>::IsElementwise() const
+{
+  return true;
+}
+
+template <typename TensorType>
+void TanH<TensorType>::ForwardRange(VecTensorType const &inputs, TensorType &output,
+                                    SizeType begin, SizeType end)
+{
+  assert(inputs.size() == 1);
+  DataType const *input = inputs.front()->data().pointer();
+  DataType *      ret   = output.data().pointer();
+
+  fetch::math::kernels::TanH tanh_kernel;
+  for (SizeType i = begin; i < end; ++i)
+  {
+    tanh_kernel(input[i], ret[i]);
+
+    // ensures numerical stability, as in Forward
+    ret[i] = fetch::vectorise::Max(ret[i], fetch::math::Add(DataType(-1), epsilon_));
+    ret[i] = fetch::vectorise::Min(ret[i], fetch::math::Subtract(DataType{1}, epsilon_));
+  }
+}
+
 ///////////////////////////////
 /// EXPLICIT INSTANTIATIONS ///
 ///////////////////////////////
@@ -103,6 +103,9 @@ std::vector<TensorType> Variable<TensorType>::Backward(VecTensorType const &inpu
 
   if (!this->value_frozen_)
   {
+    // Make sure that all rows will get updated
+    updated_rows_.clear();
+
     gradient_accumulation_->InlineAdd(error_signal);
     reset_gradients_ = true;
   }
@@ -245,6 +248,34 @@ void Variable<TensorType>::ApplySparseGradient(TensorType const &grad, SizeSet &
   }
 }
 
+/**
+ * Function for applying a compact row sparse gradient, see utilities::SparseGradient
+ * @param update
+ */
+template <class TensorType>
+void Variable<TensorType>::ApplySparseGradient(SparseGradientType const &update)
+{
+  // skip frozen trainables
+  if (!this->value_frozen_)
+  {
+    if (!update.IsSparse())
+    {
+      this->data_->InlineAdd(update.values);
+    }
+    else
+    {
+      if (this->data_->shape().size() != 2)
+      {
+        throw fetch::ml::exceptions::InvalidMode("Sparse gradient not supported.");
+      }
+
+      utilities::SparseAdd(update.values, *this->data_, update.rows);
+    }
+
+    this->ResetGradients();
+  }
+}
+
 template <typename TensorType>
 void Variable<TensorType>::ApplyGradient(TensorType const &grad)
 {
@@ -257,14 +288,29 @@ void Variable<TensorType>::ApplyGradient(TensorType const &grad)
 }
 
 /**
- * Set all gradient values to 0 and clear updated rows set
+ * Set all gradient values to 0 and clear updated rows set. When only some rows have been updated
+ * just those rows are cleared, so that the cost does not scale with the size of the tensor
  */
 template <typename TensorType>
 void Variable<TensorType>::ResetGradients()
 {
   if (reset_gradients_)
   {
-    gradient_accumulation_->Fill(DataType{0});
+    if (updated_rows_.empty())
+    {
+      gradient_accumulation_->Fill(DataType{0});
+    }
+    else
+    {
+      for (SizeType row : updated_rows_)
+      {
+        auto gradient_view = gradient_accumulation_->View(row);
+        for (auto it = gradient_view.begin(); it.is_valid(); ++it)
+        {
+          *it = DataType{0};
+        }
+      }
+    }
     reset_gradients_ = false;
 
     // Clear updates
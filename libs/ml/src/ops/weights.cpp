@@ -18,6 +18,9 @@
 
 #include "ml/ops/weights.hpp"
 #include "ml/state_dict.hpp"
+#include "ml/utilities/sparse_tensor_utilities.hpp"
+
+#include <algorithm>
 
 namespace fetch {
 namespace ml {
@@ -210,6 +213,29 @@ Weights<TensorType>::GetSparseGradientsReferences() const
   return std::move(std::make_pair(*this->gradient_accumulation_, this->updated_rows_));
 }
 
+/**
+ * exports the compact row sparse representation of the weight gradients
+ * @return the updated rows of the gradient in ascending order, or the full gradient (by reference)
+ * if every row may have been updated
+ */
+template <typename TensorType>
+typename Weights<TensorType>::SparseGradientType Weights<TensorType>::GetSparseGradients() const
+{
+  SparseGradientType ret;
+
+  if (this->updated_rows_.empty())
+  {
+    ret.values = *this->gradient_accumulation_;
+    return ret;
+  }
+
+  ret.rows.assign(this->updated_rows_.begin(), this->updated_rows_.end());
+  std::sort(ret.rows.begin(), ret.rows.end());
+  ret.values = utilities::ToSparse(*this->gradient_accumulation_, ret.rows);
+
+  return ret;
+}
+
 /**
  * exports the weight gradients Array
  * @return const reference to internal accumulated gradient Array
@@ -0,0 +1,358 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/utilities/checkpoint.hpp"
+
+#include "core/filesystem/map_file.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/fnv.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <utility>
+
+namespace fetch {
+namespace ml {
+namespace utilities {
+namespace {
+
+constexpr char     MAGIC[8]  = {'F', 'E', 'T', 'C', 'H', 'C', 'K', 'P'};
+constexpr uint32_t VERSION   = 1;
+constexpr uint64_t ALIGNMENT = 64;  // the alignment and padding of tensor storage
+
+/**
+ * The header at the start of a checkpoint file, in host byte order
+ */
+struct Header
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t element_size;
+  uint64_t index_offset;
+  uint64_t index_length;
+  uint8_t  reserved[ALIGNMENT - 32];
+};
+
+static_assert(sizeof(Header) == ALIGNMENT, "Checkpoint header must fill the first alignment");
+
+uint64_t AlignUp(uint64_t value)
+{
+  return ((value + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+}
+
+uint64_t Hash(uint8_t const *data, uint64_t length)
+{
+  crypto::FNV hasher;
+  hasher.Update(data, static_cast<std::size_t>(length));
+
+  uint64_t hash{0};
+  hasher.Final(reinterpret_cast<uint8_t *>(&hash));
+  return hash;
+}
+
+bool IsValid(Header const &header, uint64_t file_size)
+{
+  return (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0) && (header.version == VERSION) &&
+         (header.index_offset >= sizeof(Header)) &&
+         (header.index_offset + header.index_length <= file_size);
+}
+
+bool IsValid(CheckpointEntry const &entry, uint64_t file_size)
+{
+  return (entry.offset % ALIGNMENT == 0) && (entry.offset >= sizeof(Header)) &&
+         (entry.offset + entry.length <= file_size);
+}
+
+CheckpointEntries DecodeIndex(uint8_t const *data, uint64_t length)
+{
+  byte_array::ByteArray bytes;
+  bytes.Resize(static_cast<std::size_t>(length));
+  std::memcpy(bytes.pointer(), data, static_cast<std::size_t>(length));
+
+  CheckpointEntries             entries;
+  serializers::MsgPackSerializer serializer{bytes};
+  serializer >> entries;
+  return entries;
+}
+
+}  // namespace
+
+/**
+ * Opens a checkpoint file for writing. Writes to an existing checkpoint of the same element size
+ * are incremental, anything else at the location is replaced
+ * @param filename the checkpoint file
+ * @param element_size the size of an element of the weights
+ */
+CheckpointWriter::CheckpointWriter(std::string filename, uint32_t element_size)
+  : filename_(std::move(filename))
+  , element_size_(element_size)
+{
+  file_.open(filename_, std::ios::in | std::ios::out | std::ios::binary);
+  if (file_)
+  {
+    Header header{};
+    file_.seekg(0, std::ios::end);
+    auto const file_size = static_cast<uint64_t>(file_.tellg());
+    file_.seekg(0);
+
+    if ((file_size >= sizeof(Header)) &&
+        file_.read(reinterpret_cast<char *>(&header), sizeof(Header)) &&
+        IsValid(header, file_size) && (header.element_size == element_size_))
+    {
+      std::vector<uint8_t> index(static_cast<std::size_t>(header.index_length));
+      file_.seekg(static_cast<std::streamoff>(header.index_offset));
+      if (file_.read(reinterpret_cast<char *>(index.data()),
+                     static_cast<std::streamsize>(index.size())))
+      {
+        try
+        {
+          previous_  = DecodeIndex(index.data(), index.size());
+          file_size_ = file_size;
+        }
+        catch (std::exception const &)
+        {
+          previous_.clear();
+        }
+      }
+    }
+
+    // an existing checkpoint is only appended to, so that readers of it are unaffected
+    if (file_size_ == 0)
+    {
+      file_.close();
+    }
+  }
+
+  if (!file_.is_open())
+  {
+    previous_.clear();
+    file_.clear();
+    file_.open(filename_, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file_)
+    {
+      throw exceptions::InvalidFile("Unable to open checkpoint " + filename_);
+    }
+
+    Header const header{};
+    Append(reinterpret_cast<uint8_t const *>(&header), sizeof(Header));
+  }
+}
+
+/**
+ * Adds a tensor to the checkpoint. The storage is only written if it differs from the storage of
+ * the tensor of the same name in the checkpoint
+ * @param name the unique name of the tensor
+ * @param shape the shape of the tensor
+ * @param data the storage of the tensor
+ * @param length the byte length of the storage
+ */
+void CheckpointWriter::Write(std::string const &name, std::vector<uint64_t> const &shape,
+                             uint8_t const *data, uint64_t length)
+{
+  auto const same_name = [&name](CheckpointEntry const &entry) { return entry.name == name; };
+
+  if (std::any_of(entries_.begin(), entries_.end(), same_name))
+  {
+    throw exceptions::InvalidInput("Checkpoint already contains " + name);
+  }
+
+  CheckpointEntry entry;
+  entry.name   = name;
+  entry.shape  = shape;
+  entry.length = length;
+  entry.hash   = Hash(data, length);
+
+  auto const previous = std::find_if(previous_.begin(), previous_.end(), same_name);
+  if ((previous != previous_.end()) && (previous->shape == entry.shape) &&
+      (previous->length == entry.length) && (previous->hash == entry.hash))
+  {
+    entry.offset = previous->offset;
+  }
+  else
+  {
+    entry.offset = Align();
+    Append(data, length);
+    bytes_written_ += length;
+  }
+
+  entries_.emplace_back(std::move(entry));
+}
+
+/**
+ * Writes the index of the tensors added since the last commit and makes it the current one
+ */
+void CheckpointWriter::Commit()
+{
+  serializers::MsgPackSerializer serializer;
+  serializer << entries_;
+
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version      = VERSION;
+  header.element_size = element_size_;
+  header.index_offset = Align();
+  header.index_length = serializer.data().size();
+
+  Append(serializer.data().pointer(), header.index_length);
+  Align();
+  file_.flush();
+
+  // the index only becomes visible once everything it refers to has been written
+  file_.seekp(0);
+  file_.write(reinterpret_cast<char const *>(&header), sizeof(Header));
+  file_.flush();
+
+  if (!file_)
+  {
+    throw exceptions::InvalidFile("Unable to write checkpoint " + filename_);
+  }
+
+  previous_ = std::move(entries_);
+  entries_.clear();
+}
+
+/**
+ * @return the number of bytes of tensor storage written, excluding unchanged tensors
+ */
+uint64_t CheckpointWriter::bytes_written() const
+{
+  return bytes_written_;
+}
+
+void CheckpointWriter::Append(uint8_t const *data, uint64_t length)
+{
+  file_.seekp(static_cast<std::streamoff>(file_size_));
+  file_.write(reinterpret_cast<char const *>(data), static_cast<std::streamsize>(length));
+  if (!file_)
+  {
+    throw exceptions::InvalidFile("Unable to write checkpoint " + filename_);
+  }
+
+  file_size_ += length;
+}
+
+/**
+ * Pads the file with zeros up to the alignment
+ * @return the new size of the file
+ */
+uint64_t CheckpointWriter::Align()
+{
+  static uint8_t const zeros[ALIGNMENT] = {};
+
+  Append(zeros, AlignUp(file_size_) - file_size_);
+  return file_size_;
+}
+
+/**
+ * Maps a checkpoint file and reads its index
+ * @param filename the checkpoint file
+ */
+CheckpointReader::CheckpointReader(std::string const &filename)
+{
+  int const fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw exceptions::InvalidFile("Unable to open checkpoint " + filename);
+  }
+
+  struct stat file_stats
+  {
+  };
+  if ((::fstat(fd, &file_stats) != 0) ||
+      (static_cast<uint64_t>(file_stats.st_size) < sizeof(Header)))
+  {
+    ::close(fd);
+    throw exceptions::InvalidFile("Invalid checkpoint " + filename);
+  }
+
+  // tensors expect to be able to access their (SIMD) padding, which ends at the alignment
+  size_               = static_cast<uint64_t>(file_stats.st_size);
+  auto const map_size = static_cast<std::size_t>(AlignUp(size_));
+  mapping_            = core::MapFile(fd, map_size, core::MapMode::PRIVATE);
+  ::close(fd);
+
+  if (!mapping_)
+  {
+    throw exceptions::InvalidFile("Unable to map checkpoint " + filename);
+  }
+
+  Header header{};
+  std::memcpy(&header, mapping_.get(), sizeof(Header));
+  if (!IsValid(header, size_))
+  {
+    throw exceptions::InvalidFile("Invalid checkpoint " + filename);
+  }
+
+  try
+  {
+    entries_ = DecodeIndex(mapping_.get() + header.index_offset, header.index_length);
+  }
+  catch (std::exception const &)
+  {
+    throw exceptions::InvalidFile("Invalid checkpoint index in " + filename);
+  }
+
+  for (auto const &entry : entries_)
+  {
+    if (!IsValid(entry, size_))
+    {
+      throw exceptions::InvalidFile("Invalid checkpoint entry " + entry.name + " in " + filename);
+    }
+  }
+
+  element_size_ = header.element_size;
+}
+
+uint32_t CheckpointReader::element_size() const
+{
+  return element_size_;
+}
+
+CheckpointEntries const &CheckpointReader::entries() const
+{
+  return entries_;
+}
+
+/**
+ * @return the entry of the named tensor, or nullptr if there is none
+ */
+CheckpointEntry const *CheckpointReader::Find(std::string const &name) const
+{
+  auto const it =
+      std::find_if(entries_.begin(), entries_.end(),
+                   [&name](CheckpointEntry const &entry) { return entry.name == name; });
+
+  return (it == entries_.end()) ? nullptr : &(*it);
+}
+
+/**
+ * @return the storage of a tensor in the mapped file, which keeps the mapping alive
+ */
+std::shared_ptr<uint8_t> CheckpointReader::Storage(CheckpointEntry const &entry) const
+{
+  return std::shared_ptr<uint8_t>{mapping_, mapping_.get() + entry.offset};
+}
+
+}  // namespace utilities
+}  // namespace ml
+}  // namespace fetch
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lfg.hpp"
+#include "math/distance/pairwise_distance.hpp"
+#include "math/tensor/tensor.hpp"
+#include "ml/clustering/barnes_hut_tsne.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class BarnesHutTsneTests : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(BarnesHutTsneTests, math::test::HighPrecisionTensorFloatingTypes);
+
+using SizeType = fetch::math::SizeType;
+
+constexpr SizeType NUM_CLUSTERS       = 4;
+constexpr SizeType POINTS_PER_CLUSTER = 40;
+
+/**
+ * Generate tight clusters of points around the corners of a cube
+ */
+template <typename TensorType>
+TensorType GenerateClusters()
+{
+  using DataType = typename TensorType::Type;
+
+  fetch::random::LaggedFibonacciGenerator<> rng{42};
+
+  TensorType data({3, NUM_CLUSTERS * POINTS_PER_CLUSTER});
+  for (SizeType cluster = 0; cluster < NUM_CLUSTERS; ++cluster)
+  {
+    for (SizeType i = 0; i < POINTS_PER_CLUSTER; ++i)
+    {
+      SizeType const index = (cluster * POINTS_PER_CLUSTER) + i;
+      for (SizeType f = 0; f < 3; ++f)
+      {
+        DataType const centre = ((cluster >> (f % 2)) & 1u) ? DataType{10} : DataType{-10};
+        data(f, index)        = centre + rng.AsType<DataType>();
+      }
+    }
+  }
+
+  return data;
+}
+
+template <typename TensorType>
+TensorType RunTest(SizeType max_iterations)
+{
+  using DataType = typename TensorType::Type;
+
+  BarnesHutTSNE<TensorType> tsne(GenerateClusters<TensorType>(), 2,
+                                 fetch::math::Type<DataType>("10"), 123456);
+
+  tsne.Optimise(fetch::math::Type<DataType>("50"), max_iterations,
+                fetch::math::Type<DataType>("0.5"), fetch::math::Type<DataType>("0.8"), 20, 50);
+
+  return tsne.GetOutputMatrix();
+}
+
+TYPED_TEST(BarnesHutTsneTests, clusters_are_separated)
+{
+  TypeParam const output = RunTest<TypeParam>(250);
+
+  ASSERT_EQ(output.shape().at(0), 2);
+  ASSERT_EQ(output.shape().at(1), NUM_CLUSTERS * POINTS_PER_CLUSTER);
+
+  TypeParam const distances = fetch::math::distance::PairWiseDistanceMatrix(
+      output.Transpose(), fetch::math::distance::PairWiseMetric::EUCLIDEAN);
+
+  // every point must be closer to the members of its own cluster than to any other point
+  for (SizeType i = 0; i < distances.shape().at(0); ++i)
+  {
+    auto max_inner = static_cast<double>(distances.At(i, i));
+    auto min_outer = std::numeric_limits<double>::max();
+
+    for (SizeType j = 0; j < distances.shape().at(1); ++j)
+    {
+      auto const distance = static_cast<double>(distances.At(i, j));
+
+      if ((i / POINTS_PER_CLUSTER) == (j / POINTS_PER_CLUSTER))
+      {
+        max_inner = std::max(max_inner, distance);
+      }
+      else
+      {
+        min_outer = std::min(min_outer, distance);
+      }
+    }
+
+    EXPECT_LT(max_inner, min_outer);
+  }
+}
+
+TYPED_TEST(BarnesHutTsneTests, result_is_independent_of_threads)
+{
+  std::size_t const concurrency = fetch::math::distance::PairWiseConcurrency();
+
+  fetch::math::distance::SetPairWiseConcurrency(1);
+  TypeParam const single = RunTest<TypeParam>(5);
+
+  fetch::math::distance::SetPairWiseConcurrency(4);
+  TypeParam const multi = RunTest<TypeParam>(5);
+
+  fetch::math::distance::SetPairWiseConcurrency(concurrency);
+
+  EXPECT_EQ(single, multi);
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
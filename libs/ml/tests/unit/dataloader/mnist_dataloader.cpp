@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "ml/dataloaders/mnist_dataloader.hpp"
+#include "ml/utilities/mnist_utilities.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+constexpr char const *IMAGES_FILE = "mnist_dataloader_test_images.idx";
+constexpr char const *LABELS_FILE = "mnist_dataloader_test_labels.idx";
+
+constexpr uint32_t N_IMAGES = 7;
+constexpr uint32_t N_ROWS   = 3;
+constexpr uint32_t N_COLS   = 5;
+
+void WriteBigEndian(std::ofstream &stream, uint32_t value)
+{
+  char const bytes[] = {static_cast<char>(value >> 24u), static_cast<char>(value >> 16u),
+                        static_cast<char>(value >> 8u), static_cast<char>(value)};
+  stream.write(bytes, sizeof(bytes));
+}
+
+void WriteTestFiles()
+{
+  std::ofstream images(IMAGES_FILE, std::ios::binary);
+  WriteBigEndian(images, 2051);
+  WriteBigEndian(images, N_IMAGES);
+  WriteBigEndian(images, N_ROWS);
+  WriteBigEndian(images, N_COLS);
+  for (uint32_t i = 0; i < N_IMAGES * N_ROWS * N_COLS; ++i)
+  {
+    images.put(static_cast<char>((i * 37u) % 256u));
+  }
+
+  std::ofstream labels(LABELS_FILE, std::ios::binary);
+  WriteBigEndian(labels, 2049);
+  WriteBigEndian(labels, N_IMAGES);
+  for (uint32_t i = 0; i < N_IMAGES; ++i)
+  {
+    labels.put(static_cast<char>((i * 3u) % 10u));
+  }
+}
+
+}  // namespace
+
+template <typename T>
+class MnistDataloaderTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    WriteTestFiles();
+  }
+
+  void TearDown() override
+  {
+    std::remove(IMAGES_FILE);
+    std::remove(LABELS_FILE);
+  }
+};
+
+TYPED_TEST_CASE(MnistDataloaderTest, math::test::TensorFloatingTypes);
+
+TYPED_TEST(MnistDataloaderTest, samples_match_mnist_utilities)
+{
+  using TensorType = TypeParam;
+
+  TensorType images = utilities::read_mnist_images<TensorType>(IMAGES_FILE);
+  TensorType labels = utilities::read_mnist_labels<TensorType>(LABELS_FILE);
+  labels            = utilities::convert_labels_to_onehot(labels);
+
+  dataloaders::TensorDataLoader<TensorType, TensorType> tensor_loader;
+  tensor_loader.AddData({images}, labels);
+
+  dataloaders::MnistDataLoader<TensorType, TensorType> mnist_loader(IMAGES_FILE, LABELS_FILE);
+  EXPECT_EQ(mnist_loader.Size(), tensor_loader.Size());
+
+  for (SizeType i{0}; i < N_IMAGES; ++i)
+  {
+    ASSERT_FALSE(mnist_loader.IsDone());
+
+    auto expected = tensor_loader.GetNext();
+    auto actual   = mnist_loader.GetNext();
+
+    EXPECT_EQ(actual.first.shape(), expected.first.shape());
+    EXPECT_TRUE(actual.first.AllClose(expected.first));
+    ASSERT_EQ(actual.second.size(), 1);
+    EXPECT_EQ(actual.second.at(0).shape(), expected.second.at(0).shape());
+    EXPECT_TRUE(actual.second.at(0).AllClose(expected.second.at(0)));
+  }
+
+  EXPECT_TRUE(mnist_loader.IsDone());
+
+  // batches are built in the same way as any other loader
+  mnist_loader.Reset();
+  bool is_done_set = false;
+  auto batch       = mnist_loader.PrepareBatch(4, is_done_set);
+  EXPECT_EQ(batch.first.shape(), std::vector<SizeType>({10, 4}));
+  EXPECT_EQ(batch.second.at(0).shape(), std::vector<SizeType>({N_ROWS, N_COLS, 4}));
+}
+
+TYPED_TEST(MnistDataloaderTest, invalid_files_are_rejected)
+{
+  using LoaderType = dataloaders::MnistDataLoader<TypeParam, TypeParam>;
+
+  EXPECT_THROW(LoaderType(IMAGES_FILE, "mnist_dataloader_test_missing.idx"),
+               exceptions::InvalidFile);
+  EXPECT_THROW(LoaderType(LABELS_FILE, IMAGES_FILE), exceptions::InvalidFile);
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
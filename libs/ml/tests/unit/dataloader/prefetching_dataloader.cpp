@@ -0,0 +1,176 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "ml/dataloaders/prefetching_dataloader.hpp"
+#include "ml/dataloaders/tensor_dataloader.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class PrefetchingDataloaderTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(PrefetchingDataloaderTest, math::test::TensorFloatingTypes);
+
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+template <typename TensorType>
+std::shared_ptr<dataloaders::TensorDataLoader<TensorType, TensorType>> MakeLoader(
+    SizeType n_samples, bool random_mode)
+{
+  TensorType labels({1, n_samples});
+  TensorType data1({2, 3, n_samples});
+  TensorType data2({4, n_samples});
+  for (SizeType i{0}; i < n_samples; ++i)
+  {
+    labels(0, i) = static_cast<typename TensorType::Type>(i);
+    for (SizeType j{0}; j < 4; ++j)
+    {
+      data1(j % 2, j % 3, i) = static_cast<typename TensorType::Type>(i * 10 + j);
+      data2(j, i)            = static_cast<typename TensorType::Type>(i * 100 + j);
+    }
+  }
+
+  auto loader = std::make_shared<dataloaders::TensorDataLoader<TensorType, TensorType>>();
+  loader->AddData({data1, data2}, labels);
+  loader->SetRandomMode(random_mode);
+  loader->SetSeed(7);
+  return loader;
+}
+
+/**
+ * Follows the same sequence of loader calls as Optimiser::Run for a number of epochs, recording a
+ * deep copy of every batch along with the epoch in which it was delivered
+ */
+template <typename TensorType>
+std::vector<std::pair<SizeType, std::pair<TensorType, std::vector<TensorType>>>> RunEpochs(
+    dataloaders::DataLoader<TensorType, TensorType> &loader, SizeType batch_size,
+    SizeType epochs)
+{
+  std::vector<std::pair<SizeType, std::pair<TensorType, std::vector<TensorType>>>> ret;
+
+  for (SizeType epoch{0}; epoch < epochs; ++epoch)
+  {
+    if (loader.IsDone())
+    {
+      loader.Reset();
+    }
+
+    bool is_done_set = loader.IsDone();
+    while (!is_done_set && !loader.IsDone())
+    {
+      auto batch = loader.PrepareBatch(batch_size, is_done_set);
+
+      std::vector<TensorType> data;
+      for (auto const &tensor : batch.second)
+      {
+        data.emplace_back(tensor.Copy());
+      }
+      ret.emplace_back(epoch, std::make_pair(batch.first.Copy(), std::move(data)));
+    }
+  }
+
+  return ret;
+}
+
+template <typename TensorType>
+void TestBatchesMatch(SizeType n_samples, SizeType batch_size, bool random_mode,
+                      SizeType num_workers)
+{
+  auto direct = MakeLoader<TensorType>(n_samples, random_mode);
+
+  dataloaders::PrefetchingDataLoader<TensorType, TensorType> prefetching(
+      MakeLoader<TensorType>(n_samples, random_mode), num_workers, 3);
+
+  SizeType const epochs   = 3;
+  auto const     expected = RunEpochs<TensorType>(*direct, batch_size, epochs);
+  auto const     actual   = RunEpochs<TensorType>(prefetching, batch_size, epochs);
+
+  ASSERT_EQ(actual.size(), expected.size());
+  for (SizeType i{0}; i < expected.size(); ++i)
+  {
+    EXPECT_EQ(actual[i].first, expected[i].first);
+    EXPECT_TRUE(actual[i].second.first.AllClose(expected[i].second.first));
+    ASSERT_EQ(actual[i].second.second.size(), 2);
+    EXPECT_TRUE(actual[i].second.second[0].AllClose(expected[i].second.second[0]));
+    EXPECT_TRUE(actual[i].second.second[1].AllClose(expected[i].second.second[1]));
+  }
+}
+
+}  // namespace
+
+TYPED_TEST(PrefetchingDataloaderTest, batches_match_wrapped_loader)
+{
+  TestBatchesMatch<TypeParam>(12, 4, false, 1);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, batches_match_wrapped_loader_partial_batch)
+{
+  TestBatchesMatch<TypeParam>(10, 4, false, 1);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, batches_match_wrapped_loader_multiple_workers)
+{
+  TestBatchesMatch<TypeParam>(37, 5, false, 4);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, batches_match_wrapped_loader_random_mode)
+{
+  TestBatchesMatch<TypeParam>(23, 4, true, 3);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, reset_and_batch_size_change)
+{
+  auto direct = MakeLoader<TypeParam>(16, false);
+
+  dataloaders::PrefetchingDataLoader<TypeParam, TypeParam> prefetching(
+      MakeLoader<TypeParam>(16, false), 2);
+
+  bool is_done_set = false;
+  prefetching.PrepareBatch(4, is_done_set);
+  prefetching.PrepareBatch(4, is_done_set);
+
+  // resetting part way through an epoch discards the prefetched batches
+  prefetching.Reset();
+  EXPECT_FALSE(prefetching.IsDone());
+
+  auto expected = direct->PrepareBatch(3, is_done_set);
+  auto actual   = prefetching.PrepareBatch(3, is_done_set);
+  EXPECT_FALSE(is_done_set);
+  EXPECT_EQ(actual.first.shape(), expected.first.shape());
+  EXPECT_TRUE(actual.first.AllClose(expected.first));
+  EXPECT_TRUE(actual.second.at(0).AllClose(expected.second.at(0)));
+  EXPECT_EQ(prefetching.Size(), direct->Size());
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
@@ -34,6 +34,7 @@
 #include "ml/ops/embeddings.hpp"
 #include "ml/ops/exp.hpp"
 #include "ml/ops/flatten.hpp"
+#include "ml/ops/fused_attention.hpp"
 #include "ml/ops/layer_norm.hpp"
 #include "ml/ops/log.hpp"
 #include "ml/ops/mask_fill.hpp"
@@ -175,6 +176,8 @@ TYPED_TEST(GraphRebuildTest, graph_rebuild_every_op)
   std::string embed        = AddOp<ops::Embeddings<TensorType>>(g, {input_1}, data_embed);
   std::string exp          = AddOp<ops::Exp<TensorType>>(g, {input_1});
   std::string flatten      = AddOp<ops::Flatten<TensorType>>(g, {input_1});
+  std::string fused_attention = AddOp<ops::FusedAttention<TensorType>>(
+      g, {input_query, input_key, input_value, input_mask}, 12);
   std::string layernorm_op = AddOp<ops::LayerNorm<TensorType>>(g, {input_1});
   std::string log          = AddOp<ops::Log<TensorType>>(g, {input_1});
   std::string maskfill     = AddOp<ops::MaskFill<TensorType>>(g, {input_1, input_1}, DataType{0});
@@ -319,6 +322,7 @@ TYPED_TEST(GraphRebuildTest, graph_rebuild_every_op)
   ComparePrediction<GraphPtrType, TensorType>(g, g2, embed);
   ComparePrediction<GraphPtrType, TensorType>(g, g2, exp);
   ComparePrediction<GraphPtrType, TensorType>(g, g2, flatten);
+  ComparePrediction<GraphPtrType, TensorType>(g, g2, fused_attention);
   ComparePrediction<GraphPtrType, TensorType>(g, g2, layernorm_op);
   ComparePrediction<GraphPtrType, TensorType>(g, g2, log);
   ComparePrediction<GraphPtrType, TensorType>(g, g2, maskfill);
@@ -0,0 +1,273 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/core/graph.hpp"
+#include "ml/layers/fully_connected.hpp"
+#include "ml/layers/self_attention_encoder.hpp"
+#include "ml/ops/activations/relu.hpp"
+#include "ml/ops/activations/sigmoid.hpp"
+#include "ml/ops/add.hpp"
+#include "ml/ops/multiply.hpp"
+#include "ml/ops/placeholder.hpp"
+#include "ml/ops/subtract.hpp"
+#include "ml/ops/tanh.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class MemoryPlannerTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(MemoryPlannerTest, math::test::TensorFloatingTypes);
+
+template <typename TensorType>
+TensorType GenerateInput(std::vector<math::SizeType> const &shape, math::SizeType offset)
+{
+  using DataType = typename TensorType::Type;
+
+  TensorType     ret(shape);
+  math::SizeType i = offset;
+  for (auto &value : ret)
+  {
+    value = static_cast<DataType>(static_cast<int>((i * 7) % 13) - 6) / DataType{4};
+    ++i;
+  }
+  return ret;
+}
+
+/**
+ * Builds a graph with branches, repeated inputs, shape changes and subgraphs:
+ * output = (tanh(fc2(a + sigmoid(a))) * sigmoid(a)) - (b * b), where a = relu(fc1(input)) and
+ * b = fc3(input)
+ */
+template <typename TensorType>
+std::string BuildGraph(Graph<TensorType> &g)
+{
+  using SizeType = math::SizeType;
+
+  SizeType const in  = 5;
+  SizeType const out = 7;
+
+  g.template AddNode<ops::PlaceHolder<TensorType>>("Input", {});
+  g.template AddNode<layers::FullyConnected<TensorType>>("FC1", {"Input"}, in, out);
+  g.template AddNode<ops::Relu<TensorType>>("A", {"FC1"});
+  g.template AddNode<ops::Sigmoid<TensorType>>("SigmoidA", {"A"});
+  g.template AddNode<ops::Add<TensorType>>("Sum", {"A", "SigmoidA"});
+  g.template AddNode<layers::FullyConnected<TensorType>>("FC2", {"Sum"}, out, out);
+  g.template AddNode<ops::TanH<TensorType>>("TanH", {"FC2"});
+  g.template AddNode<ops::Multiply<TensorType>>("Product", {"TanH", "SigmoidA"});
+  g.template AddNode<layers::FullyConnected<TensorType>>("B", {"Input"}, in, out);
+  g.template AddNode<ops::Multiply<TensorType>>("Square", {"B", "B"});
+  g.template AddNode<ops::Subtract<TensorType>>("Output", {"Product", "Square"});
+
+  return "Output";
+}
+
+TYPED_TEST(MemoryPlannerTest, planned_evaluation_matches_unplanned_evaluation)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TensorType::Type;
+
+  Graph<TensorType> g;
+  auto const        output = BuildGraph(g);
+
+  std::vector<TensorType> inputs{GenerateInput<TensorType>({5, 3}, 0),
+                                 GenerateInput<TensorType>({5, 3}, 5),
+                                 GenerateInput<TensorType>({5, 4}, 2)};
+
+  std::vector<TensorType> expected{};
+  for (auto const &input : inputs)
+  {
+    g.SetInput("Input", input);
+    expected.emplace_back(g.Evaluate(output, false));
+  }
+
+  g.SetMemoryPlanning(true);
+
+  for (std::size_t i = 0; i < inputs.size(); ++i)
+  {
+    g.SetInput("Input", inputs[i]);
+    TensorType prediction = g.Evaluate(output, false);
+
+    ASSERT_EQ(prediction.shape(), expected[i].shape());
+    EXPECT_TRUE(prediction.AllClose(expected[i], math::function_tolerance<DataType>(),
+                                    math::function_tolerance<DataType>()));
+  }
+
+  // repeated evaluations return the retained output without recomputing it
+  TensorType prediction = g.Evaluate(output, false);
+  EXPECT_TRUE(prediction.AllClose(expected.back(), math::function_tolerance<DataType>(),
+                                  math::function_tolerance<DataType>()));
+}
+
+TYPED_TEST(MemoryPlannerTest, planned_evaluation_reuses_buffers)
+{
+  using TensorType = TypeParam;
+  using SizeType   = math::SizeType;
+
+  SizeType const num_activations = 12;
+
+  Graph<TensorType> g;
+  g.template AddNode<ops::PlaceHolder<TensorType>>("Input", {});
+
+  std::string previous = "Input";
+  for (SizeType i = 0; i < num_activations; ++i)
+  {
+    std::string const name = "Activation" + std::to_string(i);
+
+    previous = (i % 2 == 0) ? g.template AddNode<ops::Relu<TensorType>>(name, {previous})
+                            : g.template AddNode<ops::Sigmoid<TensorType>>(name, {previous});
+  }
+
+  TensorType const input = GenerateInput<TensorType>({16, 8}, 3);
+  g.SetInput("Input", input);
+  TensorType const expected = g.Evaluate(previous, false);
+
+  g.SetMemoryPlanning(true);
+  g.SetInput("Input", input);
+  TensorType const prediction = g.Evaluate(previous, false);
+  EXPECT_TRUE(prediction.AllClose(expected));
+
+  // every activation after the first one is computed over the output of the previous one
+  auto const &statistics = g.GetMemoryPlanningStatistics();
+  EXPECT_EQ(statistics.num_evaluated, num_activations);
+  EXPECT_EQ(statistics.num_in_place, num_activations - 1);
+  EXPECT_EQ(statistics.num_buffers, 1);
+  EXPECT_EQ(statistics.peak_size, input.size());
+
+  // subsequent passes reuse the arena
+  g.SetInput("Input", input);
+  g.Evaluate(previous, false);
+  EXPECT_EQ(g.GetMemoryPlanningStatistics().num_buffers, 1);
+}
+
+TYPED_TEST(MemoryPlannerTest, planned_evaluation_reduces_peak_memory)
+{
+  using TensorType = TypeParam;
+
+  Graph<TensorType> g;
+  auto const        output = BuildGraph(g);
+
+  g.SetMemoryPlanning(true);
+  g.SetInput("Input", GenerateInput<TensorType>({5, 3}, 1));
+  g.Evaluate(output, false);
+
+  // without planning each of the 10 top level operations keeps a 7x3 output
+  auto const &statistics = g.GetMemoryPlanningStatistics();
+  EXPECT_EQ(statistics.num_evaluated, 10);
+  EXPECT_GT(statistics.num_in_place, 0);
+  EXPECT_LT(statistics.arena_size, 10 * 7 * 3);
+  EXPECT_LE(statistics.peak_size, statistics.arena_size);
+}
+
+TYPED_TEST(MemoryPlannerTest, planned_evaluation_of_stacked_encoders)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TensorType::Type;
+  using SizeType   = math::SizeType;
+
+  SizeType const n_heads   = 2;
+  SizeType const model_dim = 6;
+  SizeType const ff_dim    = 8;
+  SizeType const seq_len   = 5;
+  SizeType const batch     = 3;
+
+  // the layout used by the BERT models: a sequence of encoders sharing the attention mask
+  Graph<TensorType> g;
+  g.template AddNode<ops::PlaceHolder<TensorType>>("Input", {});
+  g.template AddNode<ops::PlaceHolder<TensorType>>("Mask", {});
+
+  std::string previous = "Input";
+  for (SizeType i = 0; i < 3; ++i)
+  {
+    previous = g.template AddNode<layers::SelfAttentionEncoder<TensorType>>(
+        "Encoder" + std::to_string(i), {previous, "Mask"}, n_heads, model_dim, ff_dim);
+  }
+
+  TensorType const input = GenerateInput<TensorType>({model_dim, seq_len, batch}, 0);
+  TensorType       mask({seq_len, seq_len, batch});
+  mask.Fill(DataType{1});
+
+  g.SetInput("Input", input);
+  g.SetInput("Mask", mask);
+  TensorType const expected = g.Evaluate(previous, false);
+
+  g.SetMemoryPlanning(true);
+  for (SizeType pass = 0; pass < 2; ++pass)
+  {
+    g.SetInput("Input", input);
+    TensorType const prediction = g.Evaluate(previous, false);
+
+    ASSERT_EQ(prediction.shape(), expected.shape());
+    EXPECT_TRUE(prediction.AllClose(expected, math::function_tolerance<DataType>(),
+                                    math::function_tolerance<DataType>()));
+  }
+}
+
+TYPED_TEST(MemoryPlannerTest, training_after_planned_evaluation)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TensorType::Type;
+
+  Graph<TensorType> g;
+  auto const        output = BuildGraph(g);
+  TensorType const  input  = GenerateInput<TensorType>({5, 3}, 4);
+
+  // training passes are never planned, the released outputs are simply recomputed. The gradients
+  // are accumulated, so the second pass must add the same gradients as the first.
+  std::vector<TensorType>              predictions{};
+  std::vector<std::vector<TensorType>> gradients{};
+  for (bool memory_planning : {false, true})
+  {
+    g.SetMemoryPlanning(memory_planning);
+    g.SetInput("Input", input);
+    g.Evaluate(output, false);
+
+    predictions.emplace_back(g.Evaluate(output, true));
+    g.BackPropagate(output, predictions.back());
+    gradients.emplace_back();
+    for (auto const &gradient : g.GetGradients())
+    {
+      gradients.back().emplace_back(gradient.Copy());
+    }
+  }
+
+  EXPECT_TRUE(predictions[1].AllClose(predictions[0], math::function_tolerance<DataType>(),
+                                      math::function_tolerance<DataType>()));
+  ASSERT_EQ(gradients[1].size(), gradients[0].size());
+  for (std::size_t i = 0; i < gradients[0].size(); ++i)
+  {
+    TensorType const increment = gradients[1][i] - gradients[0][i];
+    EXPECT_TRUE(increment.AllClose(gradients[0][i], math::function_tolerance<DataType>(),
+                                   math::function_tolerance<DataType>()));
+  }
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
@@ -0,0 +1,284 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/core/graph.hpp"
+#include "ml/layers/fully_connected.hpp"
+#include "ml/ops/activations/dropout.hpp"
+#include "ml/ops/activations/leaky_relu.hpp"
+#include "ml/ops/activations/relu.hpp"
+#include "ml/ops/activations/sigmoid.hpp"
+#include "ml/ops/add.hpp"
+#include "ml/ops/placeholder.hpp"
+#include "ml/ops/tanh.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class OperatorFusionTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(OperatorFusionTest, math::test::TensorFloatingTypes);
+
+template <typename TensorType>
+TensorType GenerateInput(std::vector<math::SizeType> const &shape, math::SizeType offset)
+{
+  using DataType = typename TensorType::Type;
+
+  TensorType     ret(shape);
+  math::SizeType i = offset;
+  for (auto &value : ret)
+  {
+    value = static_cast<DataType>(static_cast<int>((i * 7) % 13) - 6) / DataType{4};
+    ++i;
+  }
+  return ret;
+}
+
+/**
+ * Builds the chain output = tanh(leaky_relu(dropout(sigmoid(relu(input + bias)))))
+ */
+template <typename TensorType>
+std::string BuildChain(Graph<TensorType> &g)
+{
+  using DataType = typename TensorType::Type;
+
+  g.template AddNode<ops::PlaceHolder<TensorType>>("Input", {});
+  g.template AddNode<ops::PlaceHolder<TensorType>>("Bias", {});
+  g.template AddNode<ops::Add<TensorType>>("Biased", {"Input", "Bias"});
+  g.template AddNode<ops::Relu<TensorType>>("Relu", {"Biased"});
+  g.template AddNode<ops::Sigmoid<TensorType>>("Sigmoid", {"Relu"});
+  g.template AddNode<ops::Dropout<TensorType>>("Dropout", {"Sigmoid"},
+                                               fetch::math::Type<DataType>("0.5"));
+  g.template AddNode<ops::LeakyRelu<TensorType>>("LeakyRelu", {"Dropout"});
+  g.template AddNode<ops::TanH<TensorType>>("Output", {"LeakyRelu"});
+
+  return "Output";
+}
+
+TYPED_TEST(OperatorFusionTest, fused_evaluation_matches_unfused_evaluation)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TensorType::Type;
+
+  Graph<TensorType> g;
+  auto const        output = BuildChain(g);
+
+  // a height without padding, a padded height and a full size bias
+  std::vector<std::vector<math::SizeType>> shapes{{8, 4}, {5, 3}, {5, 3}};
+  std::vector<std::vector<math::SizeType>> bias_shapes{{8, 1}, {5, 1}, {5, 3}};
+
+  std::vector<TensorType> expected{};
+  for (std::size_t i = 0; i < shapes.size(); ++i)
+  {
+    g.SetInput("Input", GenerateInput<TensorType>(shapes[i], i));
+    g.SetInput("Bias", GenerateInput<TensorType>(bias_shapes[i], 3));
+    expected.emplace_back(g.Evaluate(output, false));
+  }
+
+  g.SetOperatorFusion(true);
+
+  for (std::size_t i = 0; i < shapes.size(); ++i)
+  {
+    g.SetInput("Input", GenerateInput<TensorType>(shapes[i], i));
+    g.SetInput("Bias", GenerateInput<TensorType>(bias_shapes[i], 3));
+    TensorType prediction = g.Evaluate(output, false);
+
+    ASSERT_EQ(prediction.shape(), expected[i].shape());
+    EXPECT_TRUE(prediction.AllClose(expected[i], math::function_tolerance<DataType>(),
+                                    math::function_tolerance<DataType>()));
+  }
+}
+
+TYPED_TEST(OperatorFusionTest, fused_chain_skips_intermediate_outputs)
+{
+  using TensorType = TypeParam;
+
+  Graph<TensorType> g;
+  auto const        output = BuildChain(g);
+  g.SetOperatorFusion(true);
+  g.Compile();
+
+  EXPECT_EQ(g.GetNode(output)->GetFusedHead(), g.GetNode("Biased"));
+  EXPECT_EQ(g.GetNode("LeakyRelu")->GetFusedHead(), nullptr);
+
+  g.SetInput("Input", GenerateInput<TensorType>({8, 4}, 0));
+  g.SetInput("Bias", GenerateInput<TensorType>({8, 1}, 3));
+  g.Evaluate(output, false);
+
+  EXPECT_TRUE(g.GetNode(output)->HasValidCache());
+  for (auto const &name : {"Biased", "Relu", "Sigmoid", "Dropout", "LeakyRelu"})
+  {
+    EXPECT_FALSE(g.GetNode(name)->HasValidCache());
+  }
+
+  // training needs every output
+  g.Evaluate(output, true);
+  for (auto const &name : {"Biased", "Relu", "Sigmoid", "Dropout", "LeakyRelu"})
+  {
+    EXPECT_TRUE(g.GetNode(name)->HasValidCache());
+  }
+
+  g.SetOperatorFusion(false);
+  EXPECT_EQ(g.GetNode(output)->GetFusedHead(), nullptr);
+}
+
+TYPED_TEST(OperatorFusionTest, shared_outputs_are_not_fused)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TensorType::Type;
+
+  Graph<TensorType> g;
+  g.template AddNode<ops::PlaceHolder<TensorType>>("Input", {});
+  g.template AddNode<ops::Relu<TensorType>>("Relu", {"Input"});
+  g.template AddNode<ops::Sigmoid<TensorType>>("Sigmoid", {"Relu"});
+  g.template AddNode<ops::TanH<TensorType>>("TanH", {"Sigmoid"});
+  g.template AddNode<ops::Add<TensorType>>("Output", {"TanH", "Relu"});
+
+  auto const input = GenerateInput<TensorType>({6, 2}, 0);
+  g.SetInput("Input", input);
+  TensorType expected = g.Evaluate("Output", false);
+
+  g.SetOperatorFusion(true);
+
+  // the output of relu is used twice so only sigmoid -> tanh can be fused
+  EXPECT_EQ(g.GetNode("TanH")->GetFusedHead(), g.GetNode("Sigmoid"));
+  EXPECT_EQ(g.GetNode("Output")->GetFusedHead(), nullptr);
+
+  g.SetInput("Input", input);
+  TensorType prediction = g.Evaluate("Output", false);
+  EXPECT_TRUE(prediction.AllClose(expected, math::function_tolerance<DataType>(),
+                                  math::function_tolerance<DataType>()));
+}
+
+TYPED_TEST(OperatorFusionTest, fused_fully_connected_activations)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TensorType::Type;
+
+  Graph<TensorType> g;
+  g.template AddNode<ops::PlaceHolder<TensorType>>("Input", {});
+  g.template AddNode<layers::FullyConnected<TensorType>>(
+      "FC1", {"Input"}, 5u, 7u, fetch::ml::details::ActivationType::RELU);
+  g.template AddNode<layers::FullyConnected<TensorType>>(
+      "FC2", {"FC1"}, 7u, 3u, fetch::ml::details::ActivationType::SIGMOID);
+  g.template AddNode<ops::TanH<TensorType>>("Output", {"FC2"});
+
+  auto const input = GenerateInput<TensorType>({5, 4}, 1);
+  g.SetInput("Input", input);
+  TensorType expected = g.Evaluate("Output", false);
+
+  g.SetOperatorFusion(true);
+  g.SetInput("Input", input);
+  TensorType prediction = g.Evaluate("Output", false);
+  EXPECT_TRUE(prediction.AllClose(expected, math::function_tolerance<DataType>(),
+                                  math::function_tolerance<DataType>()));
+
+  // combined with memory planning
+  g.SetMemoryPlanning(true);
+  g.SetInput("Input", input);
+  prediction = g.Evaluate("Output", false);
+  EXPECT_TRUE(prediction.AllClose(expected, math::function_tolerance<DataType>(),
+                                  math::function_tolerance<DataType>()));
+}
+
+TYPED_TEST(OperatorFusionTest, fused_evaluation_with_memory_planning)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TensorType::Type;
+
+  Graph<TensorType> g;
+  auto const        output = BuildChain(g);
+
+  auto const input = GenerateInput<TensorType>({5, 3}, 0);
+  auto const bias  = GenerateInput<TensorType>({5, 1}, 3);
+  g.SetInput("Input", input);
+  g.SetInput("Bias", bias);
+  TensorType expected = g.Evaluate(output, false);
+
+  g.SetOperatorFusion(true);
+  g.SetMemoryPlanning(true);
+
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    g.SetInput("Input", input);
+    g.SetInput("Bias", bias);
+    TensorType prediction = g.Evaluate(output, false);
+    EXPECT_TRUE(prediction.AllClose(expected, math::function_tolerance<DataType>(),
+                                    math::function_tolerance<DataType>()));
+
+    // only the fused node is evaluated
+    auto const &statistics = g.GetMemoryPlanningStatistics();
+    EXPECT_EQ(statistics.num_evaluated, 1);
+    EXPECT_EQ(statistics.num_buffers, 1);
+  }
+}
+
+TYPED_TEST(OperatorFusionTest, training_is_unaffected_by_fusion)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TensorType::Type;
+
+  Graph<TensorType> g;
+  g.template AddNode<ops::PlaceHolder<TensorType>>("Input", {});
+  g.template AddNode<layers::FullyConnected<TensorType>>(
+      "FC1", {"Input"}, 5u, 7u, fetch::ml::details::ActivationType::LEAKY_RELU);
+  g.template AddNode<ops::Sigmoid<TensorType>>("Sigmoid", {"FC1"});
+  g.template AddNode<ops::TanH<TensorType>>("Output", {"Sigmoid"});
+
+  auto const input  = GenerateInput<TensorType>({5, 4}, 1);
+  auto const signal = GenerateInput<TensorType>({7, 4}, 2);
+
+  std::vector<std::vector<TensorType>> gradients{};
+  for (bool fusion : {false, true})
+  {
+    g.SetOperatorFusion(fusion);
+    g.SetInput("Input", input);
+    g.Evaluate("Output", true);
+    g.BackPropagate("Output", signal);
+
+    std::vector<TensorType> copies{};
+    for (auto const &gradient : g.GetGradients())
+    {
+      copies.emplace_back(gradient.Copy());
+    }
+    gradients.emplace_back(copies);
+  }
+
+  // gradients accumulate, so the second pass must have added the same increment as the first
+  ASSERT_EQ(gradients[0].size(), gradients[1].size());
+  for (std::size_t i = 0; i < gradients[0].size(); ++i)
+  {
+    TensorType increment = gradients[1][i] - gradients[0][i];
+    EXPECT_TRUE(increment.AllClose(gradients[0][i], math::function_tolerance<DataType>(),
+                                   math::function_tolerance<DataType>()));
+  }
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
@@ -0,0 +1,224 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/model/batched_predictor.hpp"
+
+#include "gtest/gtest.h"
+#include "ml/model/dnn_regressor.hpp"
+#include "test_types.hpp"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class BatchedPredictorTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(BatchedPredictorTest, math::test::HighPrecisionTensorFloatingTypes);
+
+namespace batched_predictor_details {
+
+template <typename TypeParam>
+std::shared_ptr<fetch::ml::model::Model<TypeParam>> SetupModel()
+{
+  using DataType  = typename TypeParam::Type;
+  using ModelType = fetch::ml::model::DNNRegressor<TypeParam>;
+
+  fetch::ml::model::ModelConfig<DataType> model_config;
+  auto model = std::make_shared<ModelType>(model_config, std::vector<math::SizeType>{3, 7, 5, 2});
+  model->Compile(fetch::ml::OptimiserType::ADAM);
+
+  return model;
+}
+
+}  // namespace batched_predictor_details
+
+TYPED_TEST(BatchedPredictorTest, predictions_match_unbatched)
+{
+  using PredictorType = fetch::ml::model::BatchedPredictor<TypeParam>;
+
+  auto model = batched_predictor_details::SetupModel<TypeParam>();
+
+  std::vector<TypeParam> inputs;
+  std::vector<TypeParam> expected;
+  for (math::SizeType i = 0; i < 6; ++i)
+  {
+    TypeParam input({3, 1 + (i % 2)});
+    input.FillUniformRandom();
+
+    TypeParam output;
+    model->Predict(input, output);
+
+    inputs.emplace_back(input);
+    expected.emplace_back(output);
+  }
+
+  PredictorType predictor(model, 64, std::chrono::milliseconds(50));
+
+  std::vector<std::future<TypeParam>> results;
+  for (auto const &input : inputs)
+  {
+    results.emplace_back(predictor.Predict(input));
+  }
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    TypeParam const output = results[i].get();
+    ASSERT_EQ(output.shape(), expected[i].shape());
+    EXPECT_TRUE(output.AllClose(expected[i], math::function_tolerance<typename TypeParam::Type>(),
+                                math::function_tolerance<typename TypeParam::Type>()));
+  }
+
+  EXPECT_EQ(predictor.samples_run(), 9);
+  EXPECT_LT(predictor.batches_run(), inputs.size());
+}
+
+TYPED_TEST(BatchedPredictorTest, full_batches_run_without_waiting)
+{
+  using PredictorType = fetch::ml::model::BatchedPredictor<TypeParam>;
+
+  auto model = batched_predictor_details::SetupModel<TypeParam>();
+
+  // the latency budget is never reached, batches are only run once they are full
+  PredictorType predictor(model, 4, std::chrono::hours(1));
+
+  std::vector<std::future<TypeParam>> results;
+  for (math::SizeType i = 0; i < 8; ++i)
+  {
+    TypeParam input({3, 1});
+    input.FillUniformRandom();
+    results.emplace_back(predictor.Predict(input));
+  }
+
+  for (auto &result : results)
+  {
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_EQ(result.get().shape(), math::SizeVector({2, 1}));
+  }
+
+  EXPECT_EQ(predictor.batches_run(), 2);
+}
+
+TYPED_TEST(BatchedPredictorTest, oversized_request_runs_alone)
+{
+  using PredictorType = fetch::ml::model::BatchedPredictor<TypeParam>;
+
+  auto model = batched_predictor_details::SetupModel<TypeParam>();
+
+  PredictorType predictor(model, 2, std::chrono::milliseconds(1));
+
+  TypeParam input({3, 5});
+  input.FillUniformRandom();
+
+  TypeParam expected;
+  model->Predict(input, expected);
+
+  TypeParam const output = predictor.Predict(input).get();
+  EXPECT_TRUE(output.AllClose(expected));
+  EXPECT_EQ(predictor.batches_run(), 1);
+}
+
+TYPED_TEST(BatchedPredictorTest, different_sample_shapes_are_not_batched)
+{
+  using PredictorType = fetch::ml::model::BatchedPredictor<TypeParam>;
+
+  auto model = batched_predictor_details::SetupModel<TypeParam>();
+
+  PredictorType predictor(model, 8, std::chrono::milliseconds(20));
+
+  TypeParam vector_input({3, 2});
+  TypeParam matrix_input({3, 1, 2});
+  vector_input.FillUniformRandom();
+  matrix_input.FillUniformRandom();
+
+  auto vector_result = predictor.Predict(vector_input);
+  auto matrix_result = predictor.Predict(matrix_input);
+
+  EXPECT_EQ(vector_result.get().shape(), math::SizeVector({2, 2}));
+  EXPECT_EQ(matrix_result.get().shape(), math::SizeVector({2, 2}));
+  EXPECT_EQ(predictor.batches_run(), 2);
+}
+
+TYPED_TEST(BatchedPredictorTest, failed_batch_sets_error)
+{
+  using DataType      = typename TypeParam::Type;
+  using PredictorType = fetch::ml::model::BatchedPredictor<TypeParam>;
+  using ModelType     = fetch::ml::model::DNNRegressor<TypeParam>;
+
+  // a model which has not been compiled refuses to predict
+  fetch::ml::model::ModelConfig<DataType> model_config;
+  auto model = std::make_shared<ModelType>(model_config, std::vector<math::SizeType>{3, 7, 5, 2});
+
+  PredictorType predictor(model, 8, std::chrono::milliseconds(20));
+
+  TypeParam input({3, 1});
+  input.FillUniformRandom();
+
+  auto first  = predictor.Predict(input);
+  auto second = predictor.Predict(input);
+
+  EXPECT_THROW(first.get(), fetch::ml::exceptions::InvalidMode);
+  EXPECT_THROW(second.get(), fetch::ml::exceptions::InvalidMode);
+}
+
+TYPED_TEST(BatchedPredictorTest, destructor_drains_queue)
+{
+  using PredictorType = fetch::ml::model::BatchedPredictor<TypeParam>;
+
+  auto model = batched_predictor_details::SetupModel<TypeParam>();
+
+  std::vector<std::future<TypeParam>> results;
+  {
+    PredictorType predictor(model, 16, std::chrono::hours(1));
+    for (math::SizeType i = 0; i < 3; ++i)
+    {
+      TypeParam input({3, 1});
+      input.FillUniformRandom();
+      results.emplace_back(predictor.Predict(input));
+    }
+  }
+
+  for (auto &result : results)
+  {
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(result.get().shape(), math::SizeVector({2, 1}));
+  }
+}
+
+TYPED_TEST(BatchedPredictorTest, rejects_invalid_configuration)
+{
+  using PredictorType = fetch::ml::model::BatchedPredictor<TypeParam>;
+
+  auto model = batched_predictor_details::SetupModel<TypeParam>();
+
+  EXPECT_THROW(PredictorType(model, 0, std::chrono::milliseconds(1)),
+               fetch::ml::exceptions::InvalidInput);
+  EXPECT_THROW(PredictorType(nullptr, 4, std::chrono::milliseconds(1)),
+               fetch::ml::exceptions::InvalidInput);
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
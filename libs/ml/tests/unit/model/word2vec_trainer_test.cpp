@@ -0,0 +1,257 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/model/word2vec_trainer.hpp"
+
+#include "core/random/lcg.hpp"
+#include "gtest/gtest.h"
+#include "test_types.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class Word2VecTrainerTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(Word2VecTrainerTest, math::test::HighPrecisionTensorFloatingTypes);
+
+namespace word2vec_trainer_details {
+
+/**
+ * Sentences which only ever mix the words of one of two topics
+ */
+std::vector<std::string> TopicSentences(std::size_t count)
+{
+  std::vector<std::string> const fruit{"apple", "banana", "cherry", "grape", "lemon", "mango"};
+  std::vector<std::string> const tools{"hammer", "saw", "drill", "wrench", "chisel", "spanner"};
+
+  fetch::random::LinearCongruentialGenerator rng;
+  rng.Seed(7);
+
+  std::vector<std::string> sentences;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto const &topic = (i % 2 == 0) ? fruit : tools;
+
+    std::string sentence;
+    for (std::size_t j = 0; j < 12; ++j)
+    {
+      sentence += topic[rng() % topic.size()] + " ";
+    }
+    sentences.emplace_back(sentence);
+  }
+  return sentences;
+}
+
+template <typename TensorType>
+std::unique_ptr<dataloaders::GraphW2VLoader<TensorType>> MakeLoader(std::size_t sentences)
+{
+  using DataType = typename TensorType::Type;
+
+  auto loader = std::make_unique<dataloaders::GraphW2VLoader<TensorType>>(
+      2, 3, DataType{1}, fetch::math::numeric_max<fetch::math::SizeType>());
+  loader->BuildVocabAndData(TopicSentences(sentences));
+  return loader;
+}
+
+template <typename TensorType>
+double Similarity(TensorType const &embeddings, fetch::math::SizeType a, fetch::math::SizeType b)
+{
+  double dot = 0;
+  double aa  = 0;
+  double bb  = 0;
+  for (fetch::math::SizeType i = 0; i < embeddings.shape().at(0); ++i)
+  {
+    auto const x = static_cast<double>(embeddings.At(i, a));
+    auto const y = static_cast<double>(embeddings.At(i, b));
+    dot += x * y;
+    aa += x * x;
+    bb += y * y;
+  }
+  return dot / std::sqrt(aa * bb);
+}
+
+}  // namespace word2vec_trainer_details
+
+TYPED_TEST(Word2VecTrainerTest, weights_have_skipgram_layout)
+{
+  using TrainerType = fetch::ml::model::Word2VecTrainer<TypeParam>;
+
+  auto loader = word2vec_trainer_details::MakeLoader<TypeParam>(10);
+
+  TrainerType trainer(*loader, 8, 1);
+
+  std::vector<fetch::math::SizeType> const shape{8, loader->vocab_size()};
+  EXPECT_EQ(trainer.embeddings().shape(), shape);
+  EXPECT_EQ(trainer.context().shape(), shape);
+  EXPECT_EQ(trainer.corpus_size(), 120);
+  EXPECT_EQ(trainer.threads(), 1);
+}
+
+TYPED_TEST(Word2VecTrainerTest, training_reduces_loss)
+{
+  using DataType    = typename TypeParam::Type;
+  using TrainerType = fetch::ml::model::Word2VecTrainer<TypeParam>;
+
+  auto loader = word2vec_trainer_details::MakeLoader<TypeParam>(100);
+
+  TrainerType trainer(*loader, 16, 1);
+
+  auto const learning_rate = fetch::math::Type<DataType>("0.05");
+  auto const first         = trainer.Train(trainer.corpus_size(), learning_rate, learning_rate);
+
+  DataType last{0};
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    last = trainer.Train(trainer.corpus_size(), learning_rate, learning_rate);
+  }
+
+  EXPECT_LT(last, first);
+  EXPECT_EQ(trainer.epochs(), 11);
+  EXPECT_EQ(trainer.words_trained(), 11 * trainer.corpus_size());
+}
+
+TYPED_TEST(Word2VecTrainerTest, embeddings_of_a_topic_are_similar)
+{
+  using DataType    = typename TypeParam::Type;
+  using TrainerType = fetch::ml::model::Word2VecTrainer<TypeParam>;
+
+  auto loader = word2vec_trainer_details::MakeLoader<TypeParam>(200);
+
+  TrainerType trainer(*loader, 16, 4);
+
+  trainer.Train(20 * trainer.corpus_size(), fetch::math::Type<DataType>("0.05"),
+                fetch::math::Type<DataType>("0.001"));
+
+  auto const apple  = loader->IndexFromWord("apple");
+  auto const mango  = loader->IndexFromWord("mango");
+  auto const hammer = loader->IndexFromWord("hammer");
+  auto const drill  = loader->IndexFromWord("drill");
+
+  auto const &embeddings = trainer.embeddings();
+  using word2vec_trainer_details::Similarity;
+  EXPECT_GT(Similarity(embeddings, apple, mango), Similarity(embeddings, apple, hammer));
+  EXPECT_GT(Similarity(embeddings, hammer, drill), Similarity(embeddings, drill, mango));
+}
+
+TYPED_TEST(Word2VecTrainerTest, single_thread_is_deterministic)
+{
+  using DataType    = typename TypeParam::Type;
+  using TrainerType = fetch::ml::model::Word2VecTrainer<TypeParam>;
+
+  auto loader = word2vec_trainer_details::MakeLoader<TypeParam>(20);
+
+  TrainerType a(*loader, 8, 1, 42);
+  TrainerType b(*loader, 8, 1, 42);
+
+  auto const learning_rate = fetch::math::Type<DataType>("0.025");
+  EXPECT_EQ(a.Train(500, learning_rate, learning_rate), b.Train(500, learning_rate, learning_rate));
+  EXPECT_EQ(a.embeddings(), b.embeddings());
+  EXPECT_EQ(a.context(), b.context());
+
+  a.Reset();
+  EXPECT_EQ(a.words_trained(), 0);
+  EXPECT_EQ(a.epochs(), 0);
+}
+
+TYPED_TEST(Word2VecTrainerTest, updated_rows_are_reported)
+{
+  using DataType    = typename TypeParam::Type;
+  using TrainerType = fetch::ml::model::Word2VecTrainer<TypeParam>;
+
+  auto loader = word2vec_trainer_details::MakeLoader<TypeParam>(20);
+
+  TrainerType trainer(*loader, 8, 2);
+  TypeParam   embeddings_before = trainer.embeddings().Copy();
+  TypeParam   context_before    = trainer.context().Copy();
+
+  auto const learning_rate = fetch::math::Type<DataType>("0.025");
+  trainer.Train(12, learning_rate, learning_rate);
+
+  auto const &embeddings_rows = trainer.updated_embeddings_rows();
+  auto const &context_rows    = trainer.updated_context_rows();
+  ASSERT_FALSE(embeddings_rows.empty());
+  ASSERT_FALSE(context_rows.empty());
+  EXPECT_TRUE(std::is_sorted(embeddings_rows.begin(), embeddings_rows.end()));
+  EXPECT_TRUE(std::is_sorted(context_rows.begin(), context_rows.end()));
+
+  // only the first sentence has been trained on, only its topic is updated
+  EXPECT_LE(embeddings_rows.size(), 6);
+
+  for (fetch::math::SizeType word = 0; word < loader->vocab_size(); ++word)
+  {
+    bool const embeddings_updated =
+        std::find(embeddings_rows.begin(), embeddings_rows.end(), word) != embeddings_rows.end();
+    if (!embeddings_updated)
+    {
+      EXPECT_EQ(trainer.embeddings().View(word).Copy(), embeddings_before.View(word).Copy());
+    }
+
+    bool const context_updated =
+        std::find(context_rows.begin(), context_rows.end(), word) != context_rows.end();
+    if (!context_updated)
+    {
+      EXPECT_EQ(trainer.context().View(word).Copy(), context_before.View(word).Copy());
+    }
+  }
+}
+
+TYPED_TEST(Word2VecTrainerTest, shared_weights_are_trained_in_place)
+{
+  using DataType    = typename TypeParam::Type;
+  using TrainerType = fetch::ml::model::Word2VecTrainer<TypeParam>;
+
+  auto loader = word2vec_trainer_details::MakeLoader<TypeParam>(20);
+
+  TypeParam embeddings({8, loader->vocab_size()});
+  TypeParam context({8, loader->vocab_size()});
+  embeddings.FillUniformRandom();
+  TypeParam const before = embeddings.Copy();
+
+  TrainerType trainer(*loader, embeddings, context, 1);
+  trainer.Train(100, fetch::math::Type<DataType>("0.025"), fetch::math::Type<DataType>("0.025"));
+
+  EXPECT_EQ(trainer.embeddings(), embeddings);
+  EXPECT_EQ(trainer.context(), context);
+  EXPECT_NE(embeddings, before);
+}
+
+TYPED_TEST(Word2VecTrainerTest, weights_of_the_wrong_shape_are_rejected)
+{
+  using TrainerType = fetch::ml::model::Word2VecTrainer<TypeParam>;
+
+  auto loader = word2vec_trainer_details::MakeLoader<TypeParam>(10);
+
+  TypeParam embeddings({8, loader->vocab_size()});
+  TypeParam context({8, loader->vocab_size() + 1});
+
+  EXPECT_THROW(TrainerType(*loader, embeddings, context, 1), exceptions::InvalidInput);
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
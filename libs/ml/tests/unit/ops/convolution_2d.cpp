@@ -25,7 +25,9 @@
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace fetch {
@@ -38,6 +40,63 @@ class Convolution2DTest : public ::testing::Test
 
 TYPED_TEST_CASE(Convolution2DTest, math::test::TensorFloatingTypes);
 
+// computes the convolution directly from its definition
+template <typename TensorType>
+TensorType DirectConvolution(TensorType const &input, TensorType const &kernels,
+                             fetch::math::SizeType stride_size)
+{
+  using DataType = typename TensorType::Type;
+  using SizeType = fetch::math::SizeType;
+
+  SizeType const output_height = ((input.shape(1) - kernels.shape(2)) / stride_size) + 1;
+  SizeType const output_width  = ((input.shape(2) - kernels.shape(3)) / stride_size) + 1;
+
+  TensorType output({kernels.shape(0), output_height, output_width, input.shape(3)});
+  for (SizeType i_b{0}; i_b < input.shape(3); ++i_b)
+  {
+    for (SizeType i_oc{0}; i_oc < kernels.shape(0); ++i_oc)
+    {
+      for (SizeType i_o{0}; i_o < output_height; ++i_o)
+      {
+        for (SizeType j_o{0}; j_o < output_width; ++j_o)
+        {
+          DataType sum{0};
+          for (SizeType i_ic{0}; i_ic < input.shape(0); ++i_ic)
+          {
+            for (SizeType i_k{0}; i_k < kernels.shape(2); ++i_k)
+            {
+              for (SizeType j_k{0}; j_k < kernels.shape(3); ++j_k)
+              {
+                sum += kernels.At(i_oc, i_ic, i_k, j_k, 0) *
+                       input.At(i_ic, (i_o * stride_size) + i_k, (j_o * stride_size) + j_k, i_b);
+              }
+            }
+          }
+          output(i_oc, i_o, j_o, i_b) = sum;
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+template <typename TensorType>
+TensorType GenerateConvolutionInput(std::vector<fetch::math::SizeType> const &shape)
+{
+  using DataType = typename TensorType::Type;
+
+  TensorType  ret(shape);
+  std::size_t counter{0};
+  for (auto &value : ret)
+  {
+    value = fetch::math::AsType<DataType>(static_cast<int>((counter * 7) % 11) - 5);
+    ++counter;
+  }
+
+  return ret;
+}
+
 TYPED_TEST(Convolution2DTest, forward_1x1x1x2_1x1x1x1x2)
 {
   using DataType   = typename TypeParam::Type;
@@ -253,6 +312,89 @@ TYPED_TEST(Convolution2DTest, backward_3x3x3x2_5x3x3x3x2)
                                      fetch::math::function_tolerance<DataType>()));
 }
 
+TYPED_TEST(Convolution2DTest, forward_4x12x11x3_5x4x3x3x1_winograd)
+{
+  using DataType   = typename TypeParam::Type;
+  using TensorType = TypeParam;
+
+  // large enough for the floating point types to use the Winograd kernel, with an odd sized output
+  auto const input   = GenerateConvolutionInput<TensorType>({4, 12, 11, 3});
+  auto const kernels = GenerateConvolutionInput<TensorType>({5, 4, 3, 3, 1});
+  auto const gt      = DirectConvolution(input, kernels, 1);
+
+  fetch::ml::ops::Convolution2D<TensorType> c;
+
+  TensorType output(c.ComputeOutputShape(
+      {std::make_shared<TensorType>(input), std::make_shared<TensorType>(kernels)}));
+  c.Forward({std::make_shared<TensorType>(input), std::make_shared<TensorType>(kernels)}, output);
+
+  ASSERT_EQ(output.shape(), gt.shape());
+  EXPECT_TRUE(output.AllClose(gt, fetch::math::function_tolerance<DataType>(),
+                              fetch::math::function_tolerance<DataType>()));
+}
+
+TYPED_TEST(Convolution2DTest, forward_reuses_workspaces_between_shapes)
+{
+  using DataType   = typename TypeParam::Type;
+  using TensorType = TypeParam;
+
+  auto const input1   = GenerateConvolutionInput<TensorType>({2, 7, 6, 2});
+  auto const kernels1 = GenerateConvolutionInput<TensorType>({3, 2, 2, 3, 1});
+  auto const input2   = GenerateConvolutionInput<TensorType>({3, 5, 9, 1});
+  auto const kernels2 = GenerateConvolutionInput<TensorType>({4, 3, 3, 2, 1});
+
+  fetch::ml::ops::Convolution2D<TensorType> c;
+
+  for (std::size_t iteration = 0; iteration < 2; ++iteration)
+  {
+    for (auto const &pair : {std::make_pair(input1, kernels1), std::make_pair(input2, kernels2)})
+    {
+      auto const gt = DirectConvolution(pair.first, pair.second, 1);
+
+      TensorType output(gt.shape());
+      c.Forward({std::make_shared<TensorType>(pair.first),
+                 std::make_shared<TensorType>(pair.second)},
+                output);
+
+      EXPECT_TRUE(output.AllClose(gt, fetch::math::function_tolerance<DataType>(),
+                                  fetch::math::function_tolerance<DataType>()));
+    }
+  }
+}
+
+TYPED_TEST(Convolution2DTest, batch_concurrency_does_not_change_the_result)
+{
+  using TensorType = TypeParam;
+
+  auto const input =
+      std::make_shared<TensorType>(GenerateConvolutionInput<TensorType>({3, 10, 10, 5}));
+  auto const kernels =
+      std::make_shared<TensorType>(GenerateConvolutionInput<TensorType>({4, 3, 3, 3, 1}));
+
+  fetch::ml::ops::Convolution2D<TensorType> serial_op;
+  fetch::ml::ops::Convolution2D<TensorType> parallel_op;
+
+  TensorType serial(serial_op.ComputeOutputShape({input, kernels}));
+  TensorType parallel(serial.shape());
+  auto const error = GenerateConvolutionInput<TensorType>(serial.shape());
+
+  std::size_t const original = fetch::ml::ops::ConvolutionConcurrency();
+
+  fetch::ml::ops::SetConvolutionConcurrency(1);
+  serial_op.Forward({input, kernels}, serial);
+  auto const serial_gradients = serial_op.Backward({input, kernels}, error);
+
+  fetch::ml::ops::SetConvolutionConcurrency(3);
+  parallel_op.Forward({input, kernels}, parallel);
+  auto const parallel_gradients = parallel_op.Backward({input, kernels}, error);
+
+  fetch::ml::ops::SetConvolutionConcurrency(original);
+
+  EXPECT_TRUE(serial == parallel);
+  EXPECT_TRUE(serial_gradients.at(0) == parallel_gradients.at(0));
+  EXPECT_TRUE(serial_gradients.at(1) == parallel_gradients.at(1));
+}
+
 TYPED_TEST(Convolution2DTest, saveparams_test)
 {
   using TensorType    = TypeParam;
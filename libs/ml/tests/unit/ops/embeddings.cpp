@@ -152,6 +152,59 @@ TYPED_TEST(EmbeddingsTest, backward)
   }
 }
 
+TYPED_TEST(EmbeddingsTest, sparse_gradients)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+  using SizeType   = fetch::math::SizeType;
+
+  fetch::ml::ops::Embeddings<TypeParam> e(6, 10);
+  e.SetData(TensorType::Zeroes({6, 10}));
+
+  TensorType input(std::vector<uint64_t>({3, 1}));
+  input.At(0, 0) = DataType{7};
+  input.At(1, 0) = DataType{2};
+  input.At(2, 0) = DataType{7};
+
+  TensorType error_signal(std::vector<uint64_t>({6, 3, 1}));
+  for (SizeType j{0}; j < 3; ++j)
+  {
+    for (SizeType k{0}; k < 6; ++k)
+    {
+      error_signal(k, j, 0) = static_cast<DataType>((j * 6) + k);
+    }
+  }
+
+  e.Backward({std::make_shared<TypeParam>(input)}, error_signal);
+
+  // only the looked up rows are exported, in ascending order
+  auto sparse = e.GetSparseGradients();
+  ASSERT_TRUE(sparse.IsSparse());
+  EXPECT_EQ(sparse.rows, std::vector<SizeType>({2, 7}));
+  EXPECT_EQ(sparse.values.shape(), std::vector<SizeType>({6, 2}));
+
+  for (SizeType k{0}; k < 6; ++k)
+  {
+    EXPECT_EQ(sparse.values(k, 0), static_cast<DataType>(6 + k));
+    EXPECT_EQ(sparse.values(k, 1), static_cast<DataType>(k + 12 + k));
+  }
+
+  // applying the compact gradient only touches the updated rows
+  e.ApplySparseGradient(sparse);
+  TensorType const &weights = e.GetWeights();
+  for (SizeType k{0}; k < 6; ++k)
+  {
+    EXPECT_EQ(weights(k, 2), sparse.values(k, 0));
+    EXPECT_EQ(weights(k, 7), sparse.values(k, 1));
+    EXPECT_EQ(weights(k, 3), DataType{0});
+  }
+
+  // the gradients have been reset
+  EXPECT_TRUE(e.GetUpdatedRowsReferences().empty());
+  EXPECT_TRUE(TensorType::Zeroes({6, 10}).AllClose(e.GetGradientsReferences()));
+  EXPECT_FALSE(e.GetSparseGradients().IsSparse());
+}
+
 TYPED_TEST(EmbeddingsTest, saveparams_test)
 {
   using TensorType = TypeParam;
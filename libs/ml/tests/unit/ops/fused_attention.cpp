@@ -0,0 +1,312 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "math/standard_functions/sqrt.hpp"
+#include "ml/ops/activations/dropout.hpp"
+#include "ml/ops/activations/softmax.hpp"
+#include "ml/ops/divide.hpp"
+#include "ml/ops/fused_attention.hpp"
+#include "ml/ops/mask_fill.hpp"
+#include "ml/ops/matrix_multiply.hpp"
+#include "ml/serializers/ml_types.hpp"
+#include "test_types.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+template <typename T>
+class FusedAttentionTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(FusedAttentionTest, math::test::TensorFloatingTypes);
+
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+template <typename TensorType>
+TensorType MakeInput(std::vector<SizeType> const &shape, SizeType seed)
+{
+  using DataType = typename TensorType::Type;
+
+  TensorType input(shape);
+  SizeType   i = seed;
+  for (auto &value : input)
+  {
+    value = fetch::math::AsType<DataType>(static_cast<double>((i * 7) % 11) / 10.0 - 0.5);
+    ++i;
+  }
+  return input;
+}
+
+/**
+ * The scaled dot product attention built from the separate operations, as a reference
+ */
+template <typename TensorType>
+class ComposedAttention
+{
+public:
+  using DataType      = typename TensorType::Type;
+  using VecTensorType = std::vector<std::shared_ptr<TensorType const>>;
+
+  ComposedAttention(SizeType key_dim, DataType probability)
+    : sqrt_dk_({1, 1, 1})
+    , mask_fill_(DataType{-1000000000})
+    , dropout_(probability)
+  {
+    sqrt_dk_(0, 0, 0) = fetch::math::Sqrt(static_cast<DataType>(key_dim));
+  }
+
+  void SetTraining(bool is_training)
+  {
+    dropout_.SetTraining(is_training);
+  }
+
+  TensorType Forward(VecTensorType const &inputs)
+  {
+    query_ = inputs.at(0);
+    key_   = inputs.at(1);
+    value_ = inputs.at(2);
+    mask_  = inputs.at(3);
+
+    kq_      = Apply(kq_matmul_, {key_, query_});
+    scaled_  = Apply(divide_, {kq_, Shared(sqrt_dk_)});
+    masked_  = Apply(mask_fill_, {mask_, scaled_});
+    weights_ = Apply(softmax_, {masked_});
+    dropped_ = Apply(dropout_, {weights_});
+    return *Apply(value_matmul_, {value_, dropped_});
+  }
+
+  std::vector<TensorType> Backward(TensorType const &error_signal)
+  {
+    auto value_grads   = value_matmul_.Backward({value_, dropped_}, error_signal);
+    auto dropout_grads = dropout_.Backward({weights_}, value_grads.at(1));
+    auto softmax_grads = softmax_.Backward({masked_}, dropout_grads.at(0));
+    auto mask_grads    = mask_fill_.Backward({mask_, scaled_}, softmax_grads.at(0));
+    auto divide_grads  = divide_.Backward({kq_, Shared(sqrt_dk_)}, mask_grads.at(1));
+    auto kq_grads      = kq_matmul_.Backward({key_, query_}, divide_grads.at(0));
+    return {kq_grads.at(1), kq_grads.at(0), value_grads.at(0), mask_grads.at(0)};
+  }
+
+private:
+  using TensorPtr = std::shared_ptr<TensorType const>;
+
+  static TensorPtr Shared(TensorType const &tensor)
+  {
+    return std::make_shared<TensorType const>(tensor);
+  }
+
+  template <typename OpType>
+  static TensorPtr Apply(OpType &op, VecTensorType const &inputs)
+  {
+    TensorType output(op.ComputeOutputShape(inputs));
+    op.Forward(inputs, output);
+    return Shared(output);
+  }
+
+  TensorType sqrt_dk_;
+
+  fetch::ml::ops::MatrixMultiply<TensorType> kq_matmul_{true, false};
+  fetch::ml::ops::Divide<TensorType>         divide_;
+  fetch::ml::ops::MaskFill<TensorType>       mask_fill_;
+  fetch::ml::ops::Softmax<TensorType>        softmax_{0};
+  fetch::ml::ops::Dropout<TensorType>        dropout_;
+  fetch::ml::ops::MatrixMultiply<TensorType> value_matmul_;
+
+  TensorPtr query_, key_, value_, mask_, kq_, scaled_, masked_, weights_, dropped_;
+};
+
+template <typename TensorType>
+void CompareWithComposed(TensorType const &mask, typename TensorType::Type probability,
+                         bool is_training)
+{
+  using DataType = typename TensorType::Type;
+
+  SizeType const key_dim   = 3;
+  SizeType const value_dim = 2;
+  SizeType const query_num = 4;
+  SizeType const key_num   = 5;
+  SizeType const batch_num = 2;
+
+  std::vector<std::shared_ptr<TensorType const>> inputs = {
+      std::make_shared<TensorType const>(
+          MakeInput<TensorType>({key_dim, query_num, batch_num}, 0)),
+      std::make_shared<TensorType const>(MakeInput<TensorType>({key_dim, key_num, batch_num}, 3)),
+      std::make_shared<TensorType const>(
+          MakeInput<TensorType>({value_dim, key_num, batch_num}, 5)),
+      std::make_shared<TensorType const>(mask)};
+  TensorType error_signal = MakeInput<TensorType>({value_dim, query_num, batch_num}, 2);
+
+  fetch::ml::ops::FusedAttention<TensorType> op(key_dim, probability);
+  op.SetTraining(is_training);
+
+  TensorType prediction(op.ComputeOutputShape(inputs));
+  op.Forward(inputs, prediction);
+
+  ComposedAttention<TensorType> reference(key_dim, probability);
+  reference.SetTraining(is_training);
+  TensorType gt = reference.Forward(inputs);
+
+  DataType const tolerance = fetch::math::function_tolerance<DataType>();
+  ASSERT_EQ(prediction.shape(), gt.shape());
+  EXPECT_TRUE(prediction.AllClose(gt, tolerance, tolerance));
+
+  // the Dropout operation only has a backward pass in training
+  if (!is_training)
+  {
+    return;
+  }
+
+  std::vector<TensorType> gradients    = op.Backward(inputs, error_signal);
+  std::vector<TensorType> gt_gradients = reference.Backward(error_signal);
+
+  ASSERT_EQ(gradients.size(), 4);
+  for (std::size_t i = 0; i < gradients.size(); ++i)
+  {
+    ASSERT_EQ(gradients.at(i).shape(), inputs.at(i)->shape());
+    EXPECT_TRUE(gradients.at(i).AllClose(gt_gradients.at(i), tolerance, tolerance));
+  }
+}
+
+}  // namespace
+
+TYPED_TEST(FusedAttentionTest, forward_backward_test)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+
+  TensorType mask({5, 4, 2});
+  mask.Fill(DataType{1});
+
+  CompareWithComposed<TensorType>(mask, DataType{1}, true);
+}
+
+TYPED_TEST(FusedAttentionTest, forward_backward_test_masked)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+
+  TensorType mask({5, 4, 2});
+  mask.Fill(DataType{1});
+  mask(4, 0, 0) = DataType{0};
+  mask(3, 2, 1) = DataType{0};
+  mask(4, 2, 1) = DataType{0};
+
+  CompareWithComposed<TensorType>(mask, DataType{1}, true);
+}
+
+TYPED_TEST(FusedAttentionTest, forward_backward_test_mask_broadcasted)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+
+  // masks the last two keys of every query in the second batch
+  TensorType mask({5, 1, 2});
+  mask.Fill(DataType{1});
+  mask(3, 0, 1) = DataType{0};
+  mask(4, 0, 1) = DataType{0};
+
+  CompareWithComposed<TensorType>(mask, DataType{1}, true);
+}
+
+TYPED_TEST(FusedAttentionTest, forward_backward_test_dropout)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+
+  TensorType mask({5, 4, 2});
+  mask.Fill(DataType{1});
+
+  CompareWithComposed<TensorType>(mask, fetch::math::Type<DataType>("0.5"), true);
+}
+
+TYPED_TEST(FusedAttentionTest, forward_test_inference)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+
+  TensorType mask({5, 4, 2});
+  mask.Fill(DataType{1});
+
+  CompareWithComposed<TensorType>(mask, fetch::math::Type<DataType>("0.5"), false);
+}
+
+TYPED_TEST(FusedAttentionTest, saveparams_test)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TypeParam::Type;
+  using OpType     = fetch::ml::ops::FusedAttention<TensorType>;
+  using SPType     = typename OpType::SPType;
+
+  std::vector<std::shared_ptr<TensorType const>> inputs = {
+      std::make_shared<TensorType const>(MakeInput<TensorType>({3, 4, 2}, 0)),
+      std::make_shared<TensorType const>(MakeInput<TensorType>({3, 5, 2}, 3)),
+      std::make_shared<TensorType const>(MakeInput<TensorType>({2, 5, 2}, 5)),
+      std::make_shared<TensorType const>(MakeInput<TensorType>({5, 1, 1}, 1))};
+  TensorType error_signal = MakeInput<TensorType>({2, 4, 2}, 2);
+
+  OpType op(3, fetch::math::Type<DataType>("0.5"));
+
+  TensorType prediction(op.ComputeOutputShape(inputs));
+  op.Forward(inputs, prediction);
+
+  // extract saveparams
+  std::shared_ptr<fetch::ml::OpsSaveableParams> sp = op.GetOpSaveableParams();
+
+  // downcast to correct type
+  auto dsp = std::dynamic_pointer_cast<SPType>(sp);
+
+  // serialize
+  fetch::serializers::MsgPackSerializer b;
+  b << *dsp;
+
+  // make another prediction with the original op
+  op.Forward(inputs, prediction);
+  std::vector<TensorType> gradients = op.Backward(inputs, error_signal);
+
+  // deserialize
+  b.seek(0);
+  auto dsp2 = std::make_shared<SPType>();
+  b >> *dsp2;
+
+  // rebuild node
+  OpType new_op(*dsp2);
+
+  // check that new predictions match the old
+  TensorType new_prediction(new_op.ComputeOutputShape(inputs));
+  new_op.Forward(inputs, new_prediction);
+  std::vector<TensorType> new_gradients = new_op.Backward(inputs, error_signal);
+
+  EXPECT_TRUE(new_prediction.AllClose(prediction, DataType{0}, DataType{0}));
+  for (std::size_t i = 0; i < gradients.size(); ++i)
+  {
+    EXPECT_TRUE(new_gradients.at(i).AllClose(gradients.at(i), DataType{0}, DataType{0}));
+  }
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
@@ -79,6 +79,40 @@ TYPED_TEST(MatrixMultiplyTest, backward_test)
   EXPECT_TRUE(backpropagated_signals[1].AllClose(gradient_b));
 }
 
+TYPED_TEST(MatrixMultiplyTest, transposed_inputs_test)
+{
+  TypeParam a = TypeParam::FromString(R"(1, 2, -3, 4, 5)");
+  TypeParam b = TypeParam::FromString(
+      R"(-11, 12, 13, 14; 21, 22, 23, 24; 31, 32, 33, 34; 41, 42, 43, 44; 51, 52, 53, 54)");
+  TypeParam gt         = TypeParam::FromString(R"(357, 388, 397, 406)");
+  TypeParam error      = TypeParam::FromString(R"(1, 2, 3, -4)");
+  TypeParam gradient_a = TypeParam::FromString(R"(-4, 38, 58, 78, 98)");
+  TypeParam gradient_b = TypeParam::FromString(
+      R"(1, 2, 3, -4; 2, 4, 6, -8; -3, -6, -9, 12; 4, 8, 12, -16; 5, 10, 15, -20)");
+
+  auto a_t = std::make_shared<TypeParam>(a.Transpose());
+  auto b_t = std::make_shared<TypeParam>(b.Transpose());
+
+  // the gradients of transposed inputs have the shape of the inputs
+  fetch::ml::ops::MatrixMultiply<TypeParam> op_ta(true, false);
+  TypeParam prediction(op_ta.ComputeOutputShape({a_t, std::make_shared<TypeParam>(b)}));
+  op_ta.Forward({a_t, std::make_shared<TypeParam>(b)}, prediction);
+  EXPECT_TRUE(prediction.AllClose(gt));
+
+  auto signals = op_ta.Backward({a_t, std::make_shared<TypeParam>(b)}, error);
+  EXPECT_TRUE(signals[0].AllClose(gradient_a.Transpose()));
+  EXPECT_TRUE(signals[1].AllClose(gradient_b));
+
+  fetch::ml::ops::MatrixMultiply<TypeParam> op_tb(false, true);
+  prediction = TypeParam(op_tb.ComputeOutputShape({std::make_shared<TypeParam>(a), b_t}));
+  op_tb.Forward({std::make_shared<TypeParam>(a), b_t}, prediction);
+  EXPECT_TRUE(prediction.AllClose(gt));
+
+  signals = op_tb.Backward({std::make_shared<TypeParam>(a), b_t}, error);
+  EXPECT_TRUE(signals[0].AllClose(gradient_a));
+  EXPECT_TRUE(signals[1].AllClose(gradient_b.Transpose()));
+}
+
 TYPED_TEST(MatrixMultiplyTest, forward_batch_test)
 {
 
@@ -31,6 +31,9 @@
 #include "ml/serializers/ml_types.hpp"
 #include "test_types.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace fetch {
 namespace ml {
 namespace test {
@@ -684,6 +687,100 @@ TYPED_TEST(OptimisersTest, adam_optimiser_minibatch_training)
                   static_cast<double>(data.size()));
 }
 
+///////////////////////////
+/// DATA PARALLEL TESTS ///
+///////////////////////////
+
+/**
+ * Trains two identical graphs, one sequentially and one with each batch sharded across replicas,
+ * and checks that the losses and the resulting weights match
+ */
+template <typename TypeParam, template <typename> class OptimiserType>
+void TestDataParallelTraining(typename TypeParam::Type learning_rate)
+{
+  using DataType = typename TypeParam::Type;
+
+  TypeParam data_1d;
+  TypeParam gt_1d;
+  PrepareTestDataAndLabels1D(data_1d, gt_1d);
+
+  TypeParam data_2d;
+  TypeParam gt_2d;
+  PrepareTestDataAndLabels2D(data_2d, gt_2d);
+
+  std::vector<std::shared_ptr<fetch::ml::Graph<TypeParam>>> graphs{};
+  std::vector<std::vector<DataType>>                        losses{};
+  for (math::SizeType num_replicas : {1u, 3u})
+  {
+    std::string input_name;
+    std::string label_name;
+    std::string output_name;
+    graphs.emplace_back(PrepareTestGraph<TypeParam>(4, 2, input_name, label_name, output_name));
+
+    OptimiserType<TypeParam> optimiser(graphs.back(), {input_name}, label_name, output_name,
+                                       learning_rate);
+    optimiser.SetDataParallelism(num_replicas);
+    EXPECT_EQ(optimiser.GetDataParallelism(), num_replicas);
+
+    // a batch which divides evenly, then one which does not and then a batch smaller than the
+    // number of replicas
+    std::vector<DataType> loss{};
+    loss.emplace_back(optimiser.Run({data_2d}, gt_2d));
+    loss.emplace_back(optimiser.Run({data_2d}, gt_2d));
+    loss.emplace_back(optimiser.Run({data_2d}, gt_2d, 2));
+    losses.emplace_back(loss);
+  }
+
+  auto const tolerance =
+      fetch::math::function_tolerance<DataType>() * static_cast<DataType>(data_2d.size());
+
+  for (std::size_t i = 0; i < losses[0].size(); ++i)
+  {
+    // the losses are large, so they are compared relative to their size
+    auto const expected_loss = static_cast<double>(losses[0][i]);
+    EXPECT_NEAR(static_cast<double>(losses[1][i]), expected_loss,
+                static_cast<double>(tolerance) * std::max(1.0, std::abs(expected_loss)));
+  }
+
+  std::vector<TypeParam> expected = graphs[0]->GetWeights();
+  std::vector<TypeParam> weights  = graphs[1]->GetWeights();
+  ASSERT_EQ(weights.size(), expected.size());
+  for (std::size_t i = 0; i < weights.size(); ++i)
+  {
+    EXPECT_TRUE(weights[i].AllClose(expected[i], tolerance, tolerance));
+  }
+}
+
+TYPED_TEST(OptimisersTest, sgd_optimiser_data_parallel_training)
+{
+  TestDataParallelTraining<TypeParam, fetch::ml::optimisers::SGDOptimiser>(
+      fetch::math::Type<typename TypeParam::Type>("0.0001"));
+}
+
+TYPED_TEST(OptimisersTest, momentum_optimiser_data_parallel_training)
+{
+  TestDataParallelTraining<TypeParam, fetch::ml::optimisers::MomentumOptimiser>(
+      fetch::math::Type<typename TypeParam::Type>("0.0001"));
+}
+
+TYPED_TEST(OptimisersTest, adagrad_optimiser_data_parallel_training)
+{
+  TestDataParallelTraining<TypeParam, fetch::ml::optimisers::AdaGradOptimiser>(
+      fetch::math::Type<typename TypeParam::Type>("0.01"));
+}
+
+TYPED_TEST(OptimisersTest, rmsprop_optimiser_data_parallel_training)
+{
+  TestDataParallelTraining<TypeParam, fetch::ml::optimisers::RMSPropOptimiser>(
+      fetch::math::Type<typename TypeParam::Type>("0.01"));
+}
+
+TYPED_TEST(OptimisersTest, adam_optimiser_data_parallel_training)
+{
+  TestDataParallelTraining<TypeParam, fetch::ml::optimisers::AdamOptimiser>(
+      fetch::math::Type<typename TypeParam::Type>("0.01"));
+}
+
 }  // namespace test
 }  // namespace ml
 }  // namespace fetch
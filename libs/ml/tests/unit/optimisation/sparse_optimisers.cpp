@@ -228,6 +228,50 @@ TYPED_TEST(SparseOptimisersTest, adam_optimiser_training_2D)
   EXPECT_LE(static_cast<double>(loss2), static_cast<double>(loss1));
 }
 
+TYPED_TEST(SparseOptimisersTest, lazy_adam_optimiser_data_parallel_training)
+{
+  using DataType = typename TypeParam::Type;
+
+  auto learning_rate = fetch::math::Type<DataType>("0.01");
+
+  TypeParam data_1;
+  TypeParam gt_1;
+  sparse_optimiser_details::PrepareTestDataAndLabelsFirst(data_1, gt_1);
+
+  TypeParam data_2;
+  TypeParam gt_2;
+  sparse_optimiser_details::PrepareTestDataAndLabelsSecond(data_2, gt_2);
+
+  // train sequentially and with the batches sharded across 3 replicas
+  std::vector<std::shared_ptr<fetch::ml::Graph<TypeParam>>> graphs{};
+  for (math::SizeType num_replicas : {1u, 3u})
+  {
+    std::string input_name;
+    std::string label_name;
+    std::string output_name;
+    graphs.emplace_back(sparse_optimiser_details::PrepareTestGraph<TypeParam>(
+        10, 50, input_name, label_name, output_name));
+
+    fetch::ml::optimisers::LazyAdamOptimiser<TypeParam> optimiser(
+        graphs.back(), {input_name}, label_name, output_name, learning_rate);
+    optimiser.SetDataParallelism(num_replicas);
+
+    optimiser.Run({data_1}, gt_1);
+    optimiser.Run({data_2}, gt_2);
+  }
+
+  auto const tolerance = static_cast<DataType>(fetch::math::function_tolerance<DataType>() *
+                                               static_cast<DataType>(gt_1.size()));
+
+  std::vector<TypeParam> expected = graphs[0]->GetWeights();
+  std::vector<TypeParam> weights  = graphs[1]->GetWeights();
+  ASSERT_EQ(weights.size(), expected.size());
+  for (std::size_t i = 0; i < weights.size(); ++i)
+  {
+    EXPECT_TRUE(weights[i].AllClose(expected[i], tolerance, tolerance));
+  }
+}
+
 }  // namespace test
 }  // namespace ml
 }  // namespace fetch
@@ -0,0 +1,223 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "ml/core/graph.hpp"
+#include "ml/layers/fully_connected.hpp"
+#include "ml/ops/placeholder.hpp"
+#include "ml/utilities/checkpoint.hpp"
+#include "test_types.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class CheckpointTest : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    std::remove(filename_.c_str());
+  }
+
+  std::string const filename_ = "checkpoint_test.ckpt";
+};
+
+TYPED_TEST_CASE(CheckpointTest, math::test::TensorFloatingTypes);
+
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+template <typename TensorType>
+std::shared_ptr<Graph<TensorType>> MakeGraph()
+{
+  auto g = std::make_shared<Graph<TensorType>>();
+
+  std::string input = g->template AddNode<ops::PlaceHolder<TensorType>>("Input", {});
+  std::string fc_1 =
+      g->template AddNode<layers::FullyConnected<TensorType>>("FC1", {input}, 4u, 3u);
+  g->template AddNode<layers::FullyConnected<TensorType>>("FC2", {fc_1}, 3u, 2u);
+  g->Compile();
+
+  return g;
+}
+
+template <typename TensorType>
+TensorType MakeInput()
+{
+  TensorType input({4, 5});
+  input.FillUniformRandom();
+  return input;
+}
+
+template <typename TensorType>
+void ExpectSameWeights(Graph<TensorType> const &g, Graph<TensorType> const &g2)
+{
+  using DataType = typename TensorType::Type;
+
+  auto const weights  = g.GetWeightsReferences();
+  auto const weights2 = g2.GetWeightsReferences();
+
+  ASSERT_EQ(weights.size(), weights2.size());
+  for (std::size_t i = 0; i < weights.size(); ++i)
+  {
+    EXPECT_TRUE(weights[i].AllClose(weights2[i], DataType{0}, DataType{0}));
+  }
+}
+
+}  // namespace
+
+TYPED_TEST(CheckpointTest, trainable_names_test)
+{
+  auto g = MakeGraph<TypeParam>();
+
+  std::vector<std::string> names = g->GetTrainableNames();
+  ASSERT_EQ(names.size(), g->GetWeightsReferences().size());
+  ASSERT_EQ(names.size(), 4);
+
+  // the trainables of both layers have the same names within their subgraphs
+  EXPECT_EQ(names[0].substr(0, 4), "FC1/");
+  EXPECT_EQ(names[2].substr(0, 4), "FC2/");
+  EXPECT_EQ(names[0].substr(4), names[2].substr(4));
+  EXPECT_NE(names[0], names[1]);
+}
+
+TYPED_TEST(CheckpointTest, save_load_test)
+{
+  using DataType = typename TypeParam::Type;
+
+  auto      g     = MakeGraph<TypeParam>();
+  TypeParam input = MakeInput<TypeParam>();
+  g->SetInput("Input", input);
+  TypeParam prediction = g->Evaluate("FC2", false);
+
+  utilities::SaveCheckpoint(*g, this->filename_);
+
+  // a graph of the same structure with different weights
+  auto g2 = MakeGraph<TypeParam>();
+  g2->SetInput("Input", input);
+  g2->Evaluate("FC2", false);
+
+  utilities::LoadCheckpoint(*g2, this->filename_);
+  ExpectSameWeights(*g, *g2);
+
+  TypeParam prediction2 = g2->Evaluate("FC2", false);
+  EXPECT_TRUE(prediction.AllClose(prediction2, DataType{0}, DataType{0}));
+}
+
+TYPED_TEST(CheckpointTest, loaded_weights_do_not_modify_file_test)
+{
+  auto g = MakeGraph<TypeParam>();
+  utilities::SaveCheckpoint(*g, this->filename_);
+
+  auto g2 = MakeGraph<TypeParam>();
+  utilities::LoadCheckpoint(*g2, this->filename_);
+
+  // the mapping is private, writes to the weights stay in the process
+  for (auto &weights : g2->GetWeightsReferences())
+  {
+    weights.Fill(typename TypeParam::Type{7});
+  }
+
+  auto g3 = MakeGraph<TypeParam>();
+  utilities::LoadCheckpoint(*g3, this->filename_);
+  ExpectSameWeights(*g, *g3);
+}
+
+TYPED_TEST(CheckpointTest, incremental_save_test)
+{
+  using DataType = typename TypeParam::Type;
+
+  TypeParam first({3, 4});
+  TypeParam second({5, 2});
+  first.FillUniformRandom();
+  second.FillUniformRandom();
+
+  auto const write = [](utilities::CheckpointWriter &writer, std::string const &name,
+                        TypeParam const &tensor) {
+    std::vector<uint64_t> shape(tensor.shape().begin(), tensor.shape().end());
+    writer.Write(name, shape, reinterpret_cast<uint8_t const *>(tensor.data().pointer()),
+                 TypeParam::PaddedSizeFromShape(tensor.shape()) * sizeof(DataType));
+  };
+
+  {
+    utilities::CheckpointWriter writer(this->filename_, sizeof(DataType));
+    write(writer, "first", first);
+    write(writer, "second", second);
+    writer.Commit();
+    EXPECT_GT(writer.bytes_written(), 0);
+  }
+
+  utilities::CheckpointReader const reader(this->filename_);
+  ASSERT_EQ(reader.entries().size(), 2);
+
+  // only the changed tensor is written again
+  DataType const original = second(0, 0);
+  second.Fill(DataType{3});
+  {
+    utilities::CheckpointWriter writer(this->filename_, sizeof(DataType));
+    write(writer, "first", first);
+    write(writer, "second", second);
+    writer.Commit();
+    EXPECT_EQ(writer.bytes_written(),
+              TypeParam::PaddedSizeFromShape(second.shape()) * sizeof(DataType));
+  }
+
+  utilities::CheckpointReader const reader2(this->filename_);
+  ASSERT_EQ(reader2.entries().size(), 2);
+  EXPECT_EQ(reader2.Find("first")->offset, reader.Find("first")->offset);
+  EXPECT_NE(reader2.Find("second")->offset, reader.Find("second")->offset);
+  EXPECT_EQ(reader2.Find("third"), nullptr);
+
+  // readers of the earlier version are unaffected
+  auto const *old_second = reinterpret_cast<DataType const *>(
+      reader.Storage(*reader.Find("second")).get());
+  auto const *new_second = reinterpret_cast<DataType const *>(
+      reader2.Storage(*reader2.Find("second")).get());
+  EXPECT_EQ(old_second[0], original);
+  EXPECT_EQ(new_second[0], DataType{3});
+}
+
+TYPED_TEST(CheckpointTest, invalid_file_test)
+{
+  auto g = MakeGraph<TypeParam>();
+
+  EXPECT_THROW(utilities::LoadCheckpoint(*g, "missing_checkpoint.ckpt"),
+               exceptions::InvalidFile);
+
+  std::ofstream file(this->filename_, std::ios::binary);
+  file << "not a checkpoint, but long enough to hold a checkpoint header of sixty four bytes";
+  file.close();
+
+  EXPECT_THROW(utilities::LoadCheckpoint(*g, this->filename_), exceptions::InvalidFile);
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
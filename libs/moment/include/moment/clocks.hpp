@@ -24,7 +24,9 @@ namespace moment {
 
 enum class ClockType
 {
-  SYSTEM,
+  SYSTEM,  ///< The system clock
+  TSC,     ///< A cheap monotonic clock, calibrated from the CPU time stamp counter
+  COARSE,  ///< A cheap low resolution system clock, refreshed by a background thread
 };
 
 enum class TimeAccuracy
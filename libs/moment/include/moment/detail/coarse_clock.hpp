@@ -0,0 +1,66 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "moment/clock_interfaces.hpp"
+
+#include <chrono>
+#include <memory>
+
+namespace fetch {
+namespace moment {
+namespace detail {
+
+/**
+ * A low resolution system clock for timestamping, which is read from memory rather than from the
+ * operating system. A single background thread (shared by every coarse clock in the process and
+ * running for as long as any of them exist) refreshes the time at the resolution of the clock.
+ */
+class CoarseClock final : public ClockInterface
+{
+public:
+  static constexpr std::chrono::milliseconds RESOLUTION{1};
+
+  // Construction / Destruction
+  CoarseClock();
+  CoarseClock(CoarseClock const &) = delete;
+  CoarseClock(CoarseClock &&)      = delete;
+  ~CoarseClock() override          = default;
+
+  /// @name Clock Interface
+  /// @{
+  Timestamp Now() const override;
+  /// @}
+
+  // Operators
+  CoarseClock &operator=(CoarseClock const &) = delete;
+  CoarseClock &operator=(CoarseClock &&) = delete;
+
+private:
+  class Updater;
+
+  using UpdaterPtr = std::shared_ptr<Updater>;
+
+  static UpdaterPtr GetUpdater();
+
+  UpdaterPtr updater_;
+};
+
+}  // namespace detail
+}  // namespace moment
+}  // namespace fetch
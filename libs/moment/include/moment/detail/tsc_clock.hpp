@@ -0,0 +1,76 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "moment/clock_interfaces.hpp"
+
+#include <cstdint>
+
+namespace fetch {
+namespace moment {
+namespace detail {
+
+/**
+ * A monotonic clock read from the CPU time stamp counter, which is considerably cheaper to read
+ * than the system clock. The counter is calibrated against the steady clock once per process (on
+ * first use) and the readings are anchored to the system time at that point.
+ *
+ * The clock is intended for timing intervals on hot paths. It does not follow adjustments of the
+ * system time and drifts from it by the error of the calibration (a few parts per million). On
+ * machines without an invariant time stamp counter the steady clock is used instead.
+ */
+class TscClock final : public ClockInterface
+{
+public:
+  // Construction / Destruction
+  TscClock();
+  TscClock(TscClock const &) = delete;
+  TscClock(TscClock &&)      = delete;
+  ~TscClock() override       = default;
+
+  /// @name Clock Interface
+  /// @{
+  Timestamp Now() const override;
+  /// @}
+
+  static bool   IsTscAvailable();
+  static double TicksPerSecond();
+
+  // Operators
+  TscClock &operator=(TscClock const &) = delete;
+  TscClock &operator=(TscClock &&) = delete;
+
+private:
+  struct Calibration
+  {
+    bool      use_tsc{false};
+    uint64_t  base_ticks{0};
+    Timestamp base_time{};
+    double    ns_per_tick{1.0};
+  };
+
+  static Calibration const &GetCalibration();
+  static Calibration        Calibrate();
+  static uint64_t           ReadTicks(bool use_tsc);
+
+  Calibration const &calibration_;
+};
+
+}  // namespace detail
+}  // namespace moment
+}  // namespace fetch
@@ -19,7 +19,9 @@
 #include "core/mutex.hpp"
 #include "moment/clocks.hpp"
 #include "moment/detail/adjustable_clock.hpp"
+#include "moment/detail/coarse_clock.hpp"
 #include "moment/detail/steady_clock.hpp"
+#include "moment/detail/tsc_clock.hpp"
 
 #include <memory>
 #include <string>
@@ -50,6 +52,12 @@ ClockPtr CreateNormal(ClockType type)
   case ClockType::SYSTEM:
     clock = std::make_shared<detail::SystemClock>();
     break;
+  case ClockType::TSC:
+    clock = std::make_shared<detail::TscClock>();
+    break;
+  case ClockType::COARSE:
+    clock = std::make_shared<detail::CoarseClock>();
+    break;
   }
 
   return clock;
@@ -70,6 +78,12 @@ AdjustableClockPtr CreateAdjustable(ClockType type)
   case ClockType::SYSTEM:
     clock = std::make_shared<detail::AdjustableClock<detail::SystemClock>>();
     break;
+  case ClockType::TSC:
+    clock = std::make_shared<detail::AdjustableClock<detail::TscClock>>();
+    break;
+  case ClockType::COARSE:
+    clock = std::make_shared<detail::AdjustableClock<detail::CoarseClock>>();
+    break;
   }
 
   return clock;
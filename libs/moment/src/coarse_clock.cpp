@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "core/set_thread_name.hpp"
+#include "moment/detail/coarse_clock.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <thread>
+
+namespace fetch {
+namespace moment {
+namespace detail {
+
+constexpr std::chrono::milliseconds CoarseClock::RESOLUTION;
+
+/**
+ * The background thread which keeps the time of the coarse clocks up to date
+ */
+class CoarseClock::Updater
+{
+public:
+  using Rep = Duration::rep;
+
+  // Construction / Destruction
+  Updater()
+    : now_{AccurateSystemClock::now().time_since_epoch().count()}
+    , thread_{&Updater::Run, this}
+  {}
+
+  Updater(Updater const &) = delete;
+  Updater(Updater &&)      = delete;
+
+  ~Updater()
+  {
+    {
+      std::lock_guard<std::mutex> guard{lock_};
+      running_ = false;
+    }
+
+    wake_.notify_all();
+    thread_.join();
+  }
+
+  Timestamp Now() const
+  {
+    return Timestamp{Duration{now_.load(std::memory_order_relaxed)}};
+  }
+
+  // Operators
+  Updater &operator=(Updater const &) = delete;
+  Updater &operator=(Updater &&) = delete;
+
+private:
+  void Run()
+  {
+    SetThreadName("CoarseClock");
+
+    std::unique_lock<std::mutex> guard{lock_};
+    while (running_)
+    {
+      wake_.wait_for(guard, RESOLUTION);
+      now_.store(AccurateSystemClock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<Rep>        now_;
+  std::mutex              lock_{};
+  std::condition_variable wake_{};
+  bool                    running_{true};
+  std::thread             thread_;
+};
+
+CoarseClock::CoarseClock()
+  : updater_{GetUpdater()}
+{}
+
+/**
+ * Get the current time of the clock, which lags the system clock by up to its resolution
+ *
+ * @return The current timestamp
+ */
+ClockInterface::Timestamp CoarseClock::Now() const
+{
+  return updater_->Now();
+}
+
+/**
+ * Look up the updater of the coarse clocks, starting it if there is currently none
+ *
+ * @return The shared updater
+ */
+CoarseClock::UpdaterPtr CoarseClock::GetUpdater()
+{
+  static Mutex                  lock{};
+  static std::weak_ptr<Updater> current{};
+
+  FETCH_LOCK(lock);
+
+  auto updater = current.lock();
+  if (!updater)
+  {
+    updater = std::make_shared<Updater>();
+    current = updater;
+  }
+
+  return updater;
+}
+
+}  // namespace detail
+}  // namespace moment
+}  // namespace fetch
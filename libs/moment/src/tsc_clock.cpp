@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/macros.hpp"
+#include "moment/detail/tsc_clock.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define FETCH_MOMENT_HAS_TSC
+#endif
+
+namespace fetch {
+namespace moment {
+namespace detail {
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+// longer calibrations are more accurate, this gives an error in the order of a few ppm
+constexpr std::chrono::milliseconds CALIBRATION_PERIOD{50};
+
+/**
+ * Determine if the time stamp counter ticks at a constant rate, independent of the power state of
+ * the core, and is therefore usable as a clock
+ */
+bool HasInvariantTsc()
+{
+#ifdef FETCH_MOMENT_HAS_TSC
+  static constexpr unsigned int ADVANCED_POWER_MANAGEMENT = 0x80000007u;
+  static constexpr unsigned int INVARIANT_TSC             = 1u << 8u;
+
+  if (__get_cpuid_max(0x80000000u, nullptr) < ADVANCED_POWER_MANAGEMENT)
+  {
+    return false;
+  }
+
+  unsigned int eax{0};
+  unsigned int ebx{0};
+  unsigned int ecx{0};
+  unsigned int edx{0};
+  __cpuid(ADVANCED_POWER_MANAGEMENT, eax, ebx, ecx, edx);
+
+  return (edx & INVARIANT_TSC) != 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
+TscClock::TscClock()
+  : calibration_{GetCalibration()}
+{}
+
+/**
+ * Get the current time of the clock
+ *
+ * @return The current timestamp
+ */
+ClockInterface::Timestamp TscClock::Now() const
+{
+  auto const elapsed_ticks = ReadTicks(calibration_.use_tsc) - calibration_.base_ticks;
+  auto const elapsed       = std::chrono::duration<double, std::nano>(
+      static_cast<double>(elapsed_ticks) * calibration_.ns_per_tick);
+
+  return calibration_.base_time + std::chrono::duration_cast<Duration>(elapsed);
+}
+
+/**
+ * @return true if the clock is backed by the time stamp counter, otherwise false
+ */
+bool TscClock::IsTscAvailable()
+{
+  return GetCalibration().use_tsc;
+}
+
+/**
+ * @return The calibrated rate of the clock's underlying counter
+ */
+double TscClock::TicksPerSecond()
+{
+  return 1e9 / GetCalibration().ns_per_tick;
+}
+
+TscClock::Calibration const &TscClock::GetCalibration()
+{
+  static Calibration const calibration{Calibrate()};
+  return calibration;
+}
+
+/**
+ * Measure the rate of the time stamp counter against the steady clock
+ *
+ * @return The calibration of the clock
+ */
+TscClock::Calibration TscClock::Calibrate()
+{
+  Calibration calibration{};
+  calibration.use_tsc = HasInvariantTsc();
+
+  auto const start_steady = SteadyClock::now();
+  auto const start_ticks  = ReadTicks(calibration.use_tsc);
+
+  calibration.base_ticks = start_ticks;
+  calibration.base_time  = AccurateSystemClock::now();
+
+  if (calibration.use_tsc)
+  {
+    std::this_thread::sleep_for(CALIBRATION_PERIOD);
+
+    auto const stop_steady = SteadyClock::now();
+    auto const stop_ticks  = ReadTicks(true);
+
+    auto const elapsed_ns = std::chrono::duration<double, std::nano>(stop_steady - start_steady);
+    auto const ticks      = static_cast<double>(stop_ticks - start_ticks);
+
+    if (ticks > 0)
+    {
+      calibration.ns_per_tick = elapsed_ns.count() / ticks;
+    }
+    else
+    {
+      calibration.use_tsc = false;
+    }
+  }
+
+  return calibration;
+}
+
+/**
+ * Read the underlying counter of the clock
+ *
+ * @param use_tsc Flag to signal that the time stamp counter should be used
+ * @return The time stamp counter, or the steady clock in nanoseconds
+ */
+uint64_t TscClock::ReadTicks(bool use_tsc)
+{
+#ifdef FETCH_MOMENT_HAS_TSC
+  if (use_tsc)
+  {
+    return static_cast<uint64_t>(__rdtsc());
+  }
+#else
+  FETCH_UNUSED(use_tsc);
+#endif
+
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now().time_since_epoch())
+          .count());
+}
+
+}  // namespace detail
+}  // namespace moment
+}  // namespace fetch
@@ -22,6 +22,7 @@
 
 #include <chrono>
 #include <memory>
+#include <thread>
 
 TEST(ClockTests, BasicChecks)
 {
@@ -36,3 +37,57 @@ TEST(ClockTests, BasicChecks)
 
   EXPECT_GE(delta, std::chrono::hours{1});
 }
+
+TEST(ClockTests, TscClockFollowsTheSystemClock)
+{
+  using namespace std::chrono_literals;
+
+  auto clock = fetch::moment::GetClock("tsc", fetch::moment::ClockType::TSC);
+  ASSERT_TRUE(clock);
+
+  auto const system_start = std::chrono::system_clock::now();
+  auto const start        = clock->Now();
+  std::this_thread::sleep_for(20ms);
+  auto const stop        = clock->Now();
+  auto const system_stop = std::chrono::system_clock::now();
+
+  // the clock is monotonic and measures the same interval as the system clock
+  EXPECT_LT(start, stop);
+  EXPECT_GE(stop - start, 20ms);
+  EXPECT_LE(stop - start, (system_stop - system_start) + 1ms);
+
+  // and is anchored to the system time
+  auto const offset = clock->Now() - std::chrono::system_clock::now();
+  EXPECT_LT(offset, 100ms);
+  EXPECT_GT(offset, -100ms);
+}
+
+TEST(ClockTests, CoarseClockFollowsTheSystemClock)
+{
+  using namespace std::chrono_literals;
+
+  auto clock = fetch::moment::GetClock("coarse", fetch::moment::ClockType::COARSE);
+  ASSERT_TRUE(clock);
+
+  auto const start = clock->Now();
+  std::this_thread::sleep_for(20ms);
+  auto const stop = clock->Now();
+
+  EXPECT_GT(stop, start);
+  EXPECT_LE(stop, std::chrono::system_clock::now());
+  EXPECT_LT(std::chrono::system_clock::now() - stop, 100ms);
+}
+
+TEST(ClockTests, FastClocksAreAdjustable)
+{
+  for (auto type : {fetch::moment::ClockType::TSC, fetch::moment::ClockType::COARSE})
+  {
+    auto test_clock = fetch::moment::CreateAdjustableClock("fast", type);
+    ASSERT_TRUE(test_clock);
+
+    auto const start = test_clock->Now();
+    test_clock->Advance(std::chrono::hours{1});
+
+    EXPECT_GE(test_clock->Now() - start, std::chrono::hours{1});
+  }
+}
@@ -0,0 +1,459 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "logging/logging.hpp"
+#include "muddle/create_muddle_fake.hpp"
+#include "muddle/muddle_endpoint.hpp"
+#include "muddle/muddle_interface.hpp"
+#include "muddle/subscription.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/uri.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fetch;
+using namespace fetch::muddle;
+
+namespace {
+
+using Clock          = std::chrono::steady_clock;
+using ByteArray      = byte_array::ByteArray;
+using ConstByteArray = byte_array::ConstByteArray;
+
+enum class Transport
+{
+  FAKE,  ///< The in memory fake network
+  TCP    ///< Real muddles connected over loopback TCP
+};
+
+constexpr auto FAKE = Transport::FAKE;
+constexpr auto TCP  = Transport::TCP;
+
+constexpr uint16_t    SERVICE            = 100;
+constexpr uint16_t    CHANNEL            = 1;
+constexpr std::size_t MESSAGES_PER_BATCH = 100;
+
+constexpr std::chrono::seconds      CONNECTION_TIMEOUT{30};
+constexpr std::chrono::seconds      DELIVERY_TIMEOUT{30};
+constexpr std::chrono::milliseconds LOSS_SETTLE_TIME{250};
+
+// every network takes a fresh range of ports, so that closing sockets do not get in the way
+std::atomic<uint16_t> next_port{9500};
+
+ProverPtr NewCertificate()
+{
+  auto certificate = std::make_shared<crypto::ECDSASigner>();
+  certificate->GenerateKeys();
+  return certificate;
+}
+
+int64_t Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * A payload of the given size, which starts with the time it was sent at
+ */
+ConstByteArray TimestampedPayload(std::size_t size)
+{
+  ByteArray payload;
+  payload.Resize(std::max(size, sizeof(int64_t)));
+
+  int64_t const sent = Now();
+  std::memcpy(payload.pointer(), &sent, sizeof(sent));
+
+  return {payload};
+}
+
+template <typename Predicate>
+bool WaitFor(Predicate &&predicate, Clock::duration timeout)
+{
+  auto const deadline = Clock::now() + timeout;
+  while (!predicate())
+  {
+    if (Clock::now() >= deadline)
+    {
+      return false;
+    }
+
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  return true;
+}
+
+/**
+ * Records the messages a node receives and how long they took to arrive
+ */
+class Receiver
+{
+public:
+  void OnMessage(ConstByteArray const &payload)
+  {
+    if (payload.size() < sizeof(int64_t))
+    {
+      return;
+    }
+
+    int64_t sent{0};
+    std::memcpy(&sent, payload.pointer(), sizeof(sent));
+    double const latency_us = static_cast<double>(Now() - sent) / 1000.0;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      latencies_us_.push_back(latency_us);
+    }
+
+    ++received_;
+  }
+
+  uint64_t received() const
+  {
+    return received_;
+  }
+
+  std::vector<double> TakeLatencies()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<double>         latencies;
+    std::swap(latencies, latencies_us_);
+    return latencies;
+  }
+
+private:
+  std::atomic<uint64_t> received_{0};
+  std::mutex            mutex_;
+  std::vector<double>   latencies_us_;
+};
+
+struct Node
+{
+  Node(Transport transport, uint16_t port)
+    : port{port}
+    , network_manager{"NetMgr" + std::to_string(port), 2}
+    , certificate{NewCertificate()}
+  {
+    muddle = (Transport::FAKE == transport)
+                 ? CreateMuddleFake("Test", certificate, network_manager, "127.0.0.1")
+                 : CreateMuddle("Test", certificate, network_manager, "127.0.0.1");
+
+    network_manager.Start();
+    muddle->Start({port});
+
+    auto const self = muddle->GetAddress();
+    subscription    = muddle->GetEndpoint().Subscribe(SERVICE, CHANNEL);
+    subscription->SetMessageHandler(
+        [this, self](Packet::Address const &from, ConstByteArray const &payload) {
+          if (from != self)
+          {
+            receiver.OnMessage(payload);
+          }
+        });
+  }
+
+  Node(Node const &) = delete;
+  Node &operator=(Node const &) = delete;
+
+  ~Node()
+  {
+    muddle->Stop();
+    network_manager.Stop();
+  }
+
+  network::Uri Hint() const
+  {
+    return network::Uri{"tcp://127.0.0.1:" + std::to_string(port)};
+  }
+
+  uint16_t                        port;
+  network::NetworkManager         network_manager;
+  ProverPtr                       certificate;
+  MuddlePtr                       muddle;
+  MuddleEndpoint::SubscriptionPtr subscription;
+  Receiver                        receiver;
+};
+
+using NodePtr = std::unique_ptr<Node>;
+using Nodes   = std::vector<NodePtr>;
+
+/**
+ * Creates a network in which every node connects to the fan-out nodes following it (in a ring),
+ * and waits for every node to be connected to all of them
+ * @return the nodes, or nothing if the network did not connect in time
+ */
+Nodes MakeNetwork(Transport transport, std::size_t count, std::size_t fanout)
+{
+  SetGlobalLogLevel(LogLevel::ERROR);
+
+  fanout = std::min(fanout, count - 1);
+
+  auto const base_port = next_port.fetch_add(static_cast<uint16_t>(count));
+
+  Nodes nodes;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    nodes.emplace_back(std::make_unique<Node>(transport, static_cast<uint16_t>(base_port + i)));
+  }
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    for (std::size_t j = 1; j <= fanout; ++j)
+    {
+      auto const &peer = nodes[(i + j) % count];
+      nodes[i]->muddle->ConnectTo(peer->muddle->GetAddress(), peer->Hint());
+    }
+  }
+
+  bool const connected = WaitFor(
+      [&nodes, fanout] {
+        return std::all_of(nodes.begin(), nodes.end(), [fanout](NodePtr const &node) {
+          return node->muddle->GetNumDirectlyConnectedPeers() >= fanout;
+        });
+      },
+      CONNECTION_TIMEOUT);
+
+  if (!connected)
+  {
+    nodes.clear();
+  }
+
+  return nodes;
+}
+
+uint64_t TotalReceived(Nodes const &nodes)
+{
+  uint64_t total{0};
+  for (auto const &node : nodes)
+  {
+    total += node->receiver.received();
+  }
+  return total;
+}
+
+/**
+ * Sets the latency percentiles, the throughput and the CPU time (of every thread in the process)
+ * per delivered message
+ */
+void Report(benchmark::State &state, Nodes const &nodes, std::clock_t cpu_start,
+            uint64_t messages, uint64_t expected)
+{
+  double const cpu_us =
+      1e6 * static_cast<double>(std::clock() - cpu_start) / static_cast<double>(CLOCKS_PER_SEC);
+
+  std::vector<double> latencies;
+  for (auto const &node : nodes)
+  {
+    auto const received = node->receiver.TakeLatencies();
+    latencies.insert(latencies.end(), received.begin(), received.end());
+  }
+
+  auto const delivered = static_cast<uint64_t>(latencies.size());
+
+  auto const percentile = [&latencies](double p) {
+    if (latencies.empty())
+    {
+      return 0.0;
+    }
+
+    auto const nth = latencies.begin() + static_cast<std::ptrdiff_t>(
+                                             p * static_cast<double>(latencies.size() - 1));
+    std::nth_element(latencies.begin(), nth, latencies.end());
+    return *nth;
+  };
+
+  state.SetItemsProcessed(static_cast<int64_t>(messages));
+  state.counters["p50_us"]      = percentile(0.50);
+  state.counters["p99_us"]      = percentile(0.99);
+  state.counters["cpu_us_msg"]  = (delivered > 0) ? cpu_us / static_cast<double>(delivered) : 0;
+  state.counters["delivered_%"] = (expected > 0) ? 100.0 * static_cast<double>(delivered) /
+                                                       static_cast<double>(expected)
+                                                 : 0;
+}
+
+/**
+ * Batches of direct messages between two connected nodes
+ */
+template <Transport TRANSPORT>
+void Muddle_DirectMessage(benchmark::State &state)
+{
+  auto const payload_size = static_cast<std::size_t>(state.range(0));
+
+  auto const nodes = MakeNetwork(TRANSPORT, 2, 1);
+  if (nodes.empty())
+  {
+    state.SkipWithError("Network failed to connect");
+    return;
+  }
+
+  auto &     endpoint = nodes[0]->muddle->GetEndpoint();
+  auto const target   = nodes[1]->muddle->GetAddress();
+  auto const cpu      = std::clock();
+
+  uint64_t sent{0};
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < MESSAGES_PER_BATCH; ++i, ++sent)
+    {
+      endpoint.Send(target, SERVICE, CHANNEL, TimestampedPayload(payload_size));
+    }
+
+    if (!WaitFor([&] { return nodes[1]->receiver.received() >= sent; }, DELIVERY_TIMEOUT))
+    {
+      state.SkipWithError("Messages were not delivered");
+      break;
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(sent * payload_size));
+  Report(state, nodes, cpu, sent, sent);
+}
+
+/**
+ * Broadcasts from one node, each of which has to reach every other node before the next one
+ */
+template <Transport TRANSPORT>
+void Muddle_Broadcast(benchmark::State &state)
+{
+  auto const count        = static_cast<std::size_t>(state.range(0));
+  auto const fanout       = static_cast<std::size_t>(state.range(1));
+  auto const payload_size = static_cast<std::size_t>(state.range(2));
+
+  auto const nodes = MakeNetwork(TRANSPORT, count, fanout);
+  if (nodes.empty())
+  {
+    state.SkipWithError("Network failed to connect");
+    return;
+  }
+
+  auto &     endpoint = nodes[0]->muddle->GetEndpoint();
+  auto const cpu      = std::clock();
+
+  uint64_t expected{0};
+  for (auto _ : state)
+  {
+    endpoint.Broadcast(SERVICE, CHANNEL, TimestampedPayload(payload_size));
+    expected += count - 1;
+
+    if (!WaitFor([&] { return TotalReceived(nodes) >= expected; }, DELIVERY_TIMEOUT))
+    {
+      state.SkipWithError("Broadcast did not reach every node");
+      break;
+    }
+  }
+
+  Report(state, nodes, cpu, expected, expected);
+}
+
+/**
+ * Batches of broadcasts on a lossy fake network. Delivery is not waited for beyond the time it
+ * takes the network to settle, the share of the messages which arrived is reported instead
+ */
+void Muddle_BroadcastUnderLoss(benchmark::State &state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+  auto const loss  = static_cast<double>(state.range(1)) / 100.0;
+
+  auto const nodes = MakeNetwork(Transport::FAKE, count, count - 1);
+  if (nodes.empty())
+  {
+    state.SkipWithError("Network failed to connect");
+    return;
+  }
+
+  SetFakeNetworkPacketLoss(loss);
+
+  auto &     endpoint = nodes[0]->muddle->GetEndpoint();
+  auto const cpu      = std::clock();
+
+  uint64_t expected{0};
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < MESSAGES_PER_BATCH; ++i)
+    {
+      endpoint.Broadcast(SERVICE, CHANNEL, TimestampedPayload(1024));
+    }
+    expected += MESSAGES_PER_BATCH * (count - 1);
+
+    if (!WaitFor([&] { return TotalReceived(nodes) >= expected; }, LOSS_SETTLE_TIME))
+    {
+      // the lost messages will never arrive
+      expected = TotalReceived(nodes);
+    }
+  }
+
+  SetFakeNetworkPacketLoss(0);
+
+  Report(state, nodes, cpu, state.iterations() * MESSAGES_PER_BATCH,
+         state.iterations() * MESSAGES_PER_BATCH * (count - 1));
+}
+
+void PayloadSizes(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->RangeMultiplier(16)->Range(64, 1 << 20)->Unit(benchmark::kMicrosecond)->UseRealTime();
+}
+
+void BroadcastShapes(benchmark::internal::Benchmark *benchmark)
+{
+  for (int64_t nodes : {8, 32})
+  {
+    for (int64_t fanout : {2, 8})
+    {
+      for (int64_t payload : {64, 16384})
+      {
+        benchmark->Args({nodes, fanout, payload});
+      }
+    }
+  }
+
+  benchmark->ArgNames({"nodes", "fanout", "payload"})->Unit(benchmark::kMicrosecond)->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(Muddle_DirectMessage, FAKE)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(Muddle_DirectMessage, TCP)->Apply(PayloadSizes);
+
+BENCHMARK_TEMPLATE(Muddle_Broadcast, FAKE)->Apply(BroadcastShapes);
+BENCHMARK_TEMPLATE(Muddle_Broadcast, TCP)->Apply(BroadcastShapes);
+
+BENCHMARK(Muddle_BroadcastUnderLoss)
+    ->ArgNames({"nodes", "loss_%"})
+    ->Args({16, 0})
+    ->Args({16, 1})
+    ->Args({16, 5})
+    ->Args({16, 20})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
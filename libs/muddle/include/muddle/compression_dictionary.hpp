@@ -0,0 +1,35 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Get the LZ4 dictionary which is shipped with the node. It has been trained on msgpack encoded
+ * batches of signed transactions, which make up the bulk of the block and transaction sync
+ * payloads. Since every node is built with the same dictionary, it is shared by all of them.
+ *
+ * @return The transaction compression dictionary
+ */
+byte_array::ConstByteArray const &TransactionCompressionDictionary();
+
+}  // namespace muddle
+}  // namespace fetch
@@ -31,5 +31,11 @@ MuddlePtr CreateMuddleFake(NetworkId const &network, ProverPtr certificate,
 MuddlePtr CreateMuddleFake(char const network[4], ProverPtr certificate,
                            network::NetworkManager const &nm, std::string const &external_address);
 
+/**
+ * Sets the probability with which the fake network drops a packet, for every fake muddle
+ * @param probability the drop probability, zero (the default) disables packet loss
+ */
+void SetFakeNetworkPacketLoss(double probability);
+
 }  // namespace muddle
 }  // namespace fetch
@@ -23,6 +23,7 @@
 #include "core/serializers/main_serializer.hpp"
 #include "crypto/prover.hpp"
 #include "crypto/verifier.hpp"
+#include "crypto/verifier_cache.hpp"
 
 #include <array>
 #include <cstdint>
@@ -83,17 +84,18 @@ public:
   struct RoutingHeader
   {
     // clang-format off
-    uint32_t version   : 4;   ///< Flag to signal the current version of the muddle protocol
-    uint32_t direct    : 1;   ///< Flag to signal that a direct message is being sent (no routing)
-    uint32_t broadcast : 1;   ///< Flag to signal that the packet is a broadcast packet
-    uint32_t exchange  : 1;   ///< Flag to signal that this is an exchange packet
-    uint32_t stamped   : 1;   ///< Flag to signal that the packet is signed by sender
-    uint32_t ttl       : 7;   ///< The time to live counter
-    uint32_t encrypted : 1;   ///< Flag to signal that the packet payload is encrypted
-    uint32_t service   : 16;  ///< The service number
-    uint32_t channel   : 16;  ///< The channel number
-    uint32_t msg_num   : 16;  ///< Incremented message counter for detecting duplicate packets
-    uint32_t network   : 32;  ///< The originating network id
+    uint32_t version    : 3;   ///< Flag to signal the current version of the muddle protocol
+    uint32_t compressed : 1;   ///< Flag to signal that the packet payload is compressed
+    uint32_t direct     : 1;   ///< Flag to signal that a direct message is being sent (no routing)
+    uint32_t broadcast  : 1;   ///< Flag to signal that the packet is a broadcast packet
+    uint32_t exchange   : 1;   ///< Flag to signal that this is an exchange packet
+    uint32_t stamped    : 1;   ///< Flag to signal that the packet is signed by sender
+    uint32_t ttl        : 7;   ///< The time to live counter
+    uint32_t encrypted  : 1;   ///< Flag to signal that the packet payload is encrypted
+    uint32_t service    : 16;  ///< The service number
+    uint32_t channel    : 16;  ///< The channel number
+    uint32_t msg_num    : 16;  ///< Incremented message counter for detecting duplicate packets
+    uint32_t network    : 32;  ///< The originating network id
     // clang-format on
 
     RawAddress target;  ///< The address of the packet target
@@ -126,6 +128,7 @@ public:
   bool              IsExchange() const noexcept;
   bool              IsStamped() const noexcept;
   bool              IsEncrypted() const noexcept;
+  bool              IsCompressed() const noexcept;
   uint8_t           GetTTL() const noexcept;
   uint16_t          GetService() const noexcept;
   uint16_t          GetChannel() const noexcept;
@@ -144,6 +147,7 @@ public:
   void SetBroadcast(bool set = true) noexcept;
   void SetExchange(bool set = true) noexcept;
   void SetEncrypted(bool set = true) noexcept;
+  void SetCompressed(bool set = true) noexcept;
   void SetTTL(uint8_t ttl) noexcept;
   void SetService(uint16_t service_num) noexcept;
   void SetChannel(uint16_t protocol_num) noexcept;
@@ -156,9 +160,13 @@ public:
   // Binary
   static bool ToBuffer(Packet const &packet, void *buffer, std::size_t length);
   static bool FromBuffer(Packet &packet, void const *buffer, std::size_t length);
+  static bool FromBuffer(Packet &packet, byte_array::ConstByteArray const &buffer);
 
   void Sign(crypto::Prover const &prover);
   bool Verify() const;
+  bool Verify(crypto::VerifierCache &verifiers) const;
+
+  byte_array::ConstByteArray GetSignedData() const;
 
 private:
   RoutingHeader header_{};  ///< The header containing primarily routing information
@@ -221,6 +229,11 @@ inline bool Packet::IsEncrypted() const noexcept
   return header_.encrypted != 0u;
 }
 
+inline bool Packet::IsCompressed() const noexcept
+{
+  return header_.compressed != 0u;
+}
+
 inline uint8_t Packet::GetTTL() const noexcept
 {
   return static_cast<uint8_t>(header_.ttl);
@@ -322,6 +335,12 @@ inline void Packet::SetEncrypted(bool set) noexcept
   SetStamped(false);
 }
 
+inline void Packet::SetCompressed(bool set) noexcept
+{
+  header_.compressed = (set) ? 1 : 0;
+  SetStamped(false);
+}
+
 inline void Packet::SetTTL(uint8_t ttl) noexcept
 {
   header_.ttl = (ttl & 0x7f);
@@ -407,11 +426,37 @@ inline bool Packet::Verify() const
   {
     return false;  // null signature is not genuine in non-trusted networks
   }
-  auto retVal = crypto::Verify(
-      GetSender(), (serializers::MsgPackSerializer() << StaticHeader() << payload_).data(), stamp_);
+  auto retVal = crypto::Verify(GetSender(), GetSignedData(), stamp_);
   return retVal;
 }
 
+/**
+ * Verify the packet, reusing a previously built verifier for the sender if one is available
+ *
+ * @param verifiers The verifier cache to use
+ * @return true if the packet is stamped and the signature is valid, otherwise false
+ */
+inline bool Packet::Verify(crypto::VerifierCache &verifiers) const
+{
+  if (!IsStamped())
+  {
+    return false;  // null signature is not genuine in non-trusted networks
+  }
+
+  return verifiers.Verify(crypto::Identity{GetSender()}, GetSignedData(), stamp_);
+}
+
+/**
+ * Get the data covered by the packet's signature. This excludes the TTL since it is modified as
+ * the packet is routed through the network
+ *
+ * @return The signed data
+ */
+inline byte_array::ConstByteArray Packet::GetSignedData() const
+{
+  return (serializers::MsgPackSerializer() << StaticHeader() << payload_).data();
+}
+
 inline std::size_t Packet::GetPacketSize() const
 {
   std::size_t size{sizeof(RoutingHeader)};
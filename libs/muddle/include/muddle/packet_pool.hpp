@@ -0,0 +1,162 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "muddle/packet.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+namespace detail {
+
+/**
+ * Thread safe free list of fixed size memory blocks. Released blocks are kept (up to a limit) so
+ * that they can be handed straight back out again rather than going back to the heap.
+ *
+ * @tparam SIZE The size in bytes of each of the blocks
+ */
+template <std::size_t SIZE>
+class BlockPool
+{
+public:
+  static constexpr std::size_t MAX_FREE_BLOCKS = 8192;
+
+  static BlockPool &Instance()
+  {
+    // intentionally never destroyed so that blocks can be released during static destruction
+    static auto *instance = new BlockPool{};
+    return *instance;
+  }
+
+  void *Allocate()
+  {
+    {
+      FETCH_LOCK(lock_);
+      if (!free_.empty())
+      {
+        void *block = free_.back();
+        free_.pop_back();
+        return block;
+      }
+    }
+
+    return ::operator new(SIZE);
+  }
+
+  void Release(void *block)
+  {
+    {
+      FETCH_LOCK(lock_);
+      if (free_.size() < MAX_FREE_BLOCKS)
+      {
+        free_.emplace_back(block);
+        return;
+      }
+    }
+
+    ::operator delete(block);
+  }
+
+  std::size_t free_blocks() const
+  {
+    FETCH_LOCK(lock_);
+    return free_.size();
+  }
+
+private:
+  BlockPool() = default;
+
+  mutable Mutex       lock_;
+  std::vector<void *> free_{};
+};
+
+/**
+ * Minimal allocator which serves single object allocations from the block pool for its type
+ */
+template <typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+  using Pool       = BlockPool<sizeof(T)>;
+
+  PoolAllocator() = default;
+
+  template <typename U>
+  explicit PoolAllocator(PoolAllocator<U> const & /*other*/) noexcept
+  {}
+
+  T *allocate(std::size_t n)
+  {
+    if (n == 1)
+    {
+      return static_cast<T *>(Pool::Instance().Allocate());
+    }
+
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept
+  {
+    if (n == 1)
+    {
+      Pool::Instance().Release(p);
+    }
+    else
+    {
+      ::operator delete(p);
+    }
+  }
+
+  template <typename U>
+  bool operator==(PoolAllocator<U> const & /*other*/) const noexcept
+  {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(PoolAllocator<U> const & /*other*/) const noexcept
+  {
+    return false;
+  }
+};
+
+}  // namespace detail
+
+/**
+ * Create a new packet. The packet and its reference count share a single pooled allocation, so
+ * the steady state creation and destruction of packets does not touch the heap.
+ *
+ * @param args The constructor arguments for the packet
+ * @return The newly created packet
+ */
+template <typename... Args>
+std::shared_ptr<Packet> CreatePacket(Args &&... args)
+{
+  return std::allocate_shared<Packet>(detail::PoolAllocator<Packet>{},
+                                      std::forward<Args>(args)...);
+}
+
+}  // namespace muddle
+}  // namespace fetch
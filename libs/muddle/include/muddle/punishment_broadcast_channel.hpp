@@ -36,6 +36,7 @@
 
 #include "muddle/question_struct.hpp"
 
+#include <cstdint>
 #include <map>
 #include <random>
 #include <set>
@@ -54,6 +55,9 @@ namespace muddle {
  *
  * Once the answers in the table have enough 'seen' signatures (threshold), it can be dispatched to
  * the callback.
+ *
+ * Rather than pulling the whole table from a peer each time, the channel remembers the version of
+ * each peer's table that it last received and only pulls the changes made since then.
  */
 class PunishmentBroadcastChannel : public service::Protocol, public BroadcastChannelInterface
 {
@@ -80,14 +84,17 @@ public:
   using ServerPtr       = std::shared_ptr<Server>;
   using StateMachine    = core::StateMachine<State>;
   using StateMachinePtr = std::shared_ptr<StateMachine>;
+  using PeerVersions    = std::map<MuddleAddress, uint64_t>;
 
-  // The only RPC function exposed to peers
+  // The RPC functions exposed to peers
   enum
   {
-    PULL_INFO_FROM_PEER = 1
+    PULL_INFO_FROM_PEER  = 1,
+    PULL_DELTA_FROM_PEER = 2
   };
 
   QuestionStruct AllowPeerPull();
+  QuestionDelta  AllowPeerPullDelta(ConstByteArray const &question, uint64_t since);
 
   PunishmentBroadcastChannel(Endpoint &endpoint, MuddleAddress address, CallbackFunction call_back,
                              CertificatePtr certificate, uint16_t channel = CHANNEL_RBC_BROADCAST,
@@ -159,6 +166,10 @@ private:
   const uint16_t                                          REASONABLE_NETWORK_DELAY_MS = 500;
   std::vector<std::pair<MuddleAddress, service::Promise>> network_promises_;
 
+  // Only the changes since the last pull from each peer are requested
+  ConstByteArray synced_question_;  ///< The question that the peer versions refer to
+  PeerVersions   peer_versions_;    ///< The version of each peer's table already received
+
   /// @}
   StateMachinePtr state_machine_;
 
@@ -200,6 +211,35 @@ public:
   }
 };
 
+template <typename D>
+struct MapSerializer<muddle::QuestionDelta, D>
+{
+public:
+  using Type       = muddle::QuestionDelta;
+  using DriverType = D;
+
+  static uint8_t const QUESTION = 1;
+  static uint8_t const VERSION  = 2;
+  static uint8_t const TABLE    = 3;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &delta)
+  {
+    auto map = map_constructor(3);
+    map.Append(QUESTION, delta.question);
+    map.Append(VERSION, delta.version);
+    map.Append(TABLE, delta.table);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &delta)
+  {
+    map.ExpectKeyGetValue(QUESTION, delta.question);
+    map.ExpectKeyGetValue(VERSION, delta.version);
+    map.ExpectKeyGetValue(TABLE, delta.table);
+  }
+};
+
 template <typename D>
 struct MapSerializer<muddle::QuestionStruct::AnswerAndSeen, D>
 {
@@ -20,16 +20,22 @@
 #include "core/byte_array/const_byte_array.hpp"
 #include "crypto/prover.hpp"
 
+#include <cstdint>
 #include <map>
 #include <set>
+#include <tuple>
 #include <vector>
 
 namespace fetch {
 namespace muddle {
 
+struct QuestionDelta;
+
 /**
  * Structure used for the punishment broadcast channel.
  *
+ * Each change to the table (an answer being learnt, or a seen proof being added) is given a new
+ * version number, which allows the changes since a given version to be extracted as a delta.
  */
 struct QuestionStruct
 {
@@ -69,6 +75,12 @@ struct QuestionStruct
    * (one time event)
    */
   ConfirmedAnswers Update(uint32_t threshold, QuestionStruct &rhs);
+  ConfirmedAnswers Update(uint32_t threshold, QuestionDelta const &delta);
+
+  /**
+   * Get the changes to our table since the given version (0 for the whole table)
+   */
+  QuestionDelta GetDelta(uint64_t since) const;
 
   // Considered invalid if there is no cabinet
   explicit operator bool() const;
@@ -78,6 +90,30 @@ struct QuestionStruct
   Digest         question_;     // The question hash
   SyncTable      table_;        // The table to populate
   CabinetMembers cabinet_;      // the cabinet
+
+private:
+  struct EntryVersions
+  {
+    uint64_t                          answer{0};  // Version at which the answer was learnt
+    std::map<MuddleAddress, uint64_t> seen{};     // Version at which each seen proof was added
+  };
+
+  ConfirmedAnswers Merge(uint32_t threshold, SyncTable const &rhs);
+
+  uint64_t                               version_{0};  // Latest version of the table
+  std::map<MuddleAddress, EntryVersions> versions_;    // Versions of the table entries
+};
+
+/**
+ * The changes to the table of a question since a given version of it. Answers (and their
+ * signatures) are only present when they have changed since the version, and only the seen proofs
+ * added since the version are present.
+ */
+struct QuestionDelta
+{
+  QuestionStruct::Digest    question{};  ///< The question hash (empty if the question is unknown)
+  uint64_t                  version{0};  ///< The version of the table the delta brings us up to
+  QuestionStruct::SyncTable table{};     ///< The changed entries of the table
 };
 
 }  // namespace muddle
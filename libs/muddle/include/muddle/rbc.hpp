@@ -26,6 +26,8 @@
 
 #include <atomic>
 #include <bitset>
+#include <cstddef>
+#include <map>
 #include <unordered_set>
 
 namespace fetch {
@@ -87,6 +89,7 @@ public:
   using IdType         = uint32_t;
   using CounterType    = uint8_t;
   using CertificatePtr = std::shared_ptr<fetch::crypto::Prover>;
+  using FragmentMap    = std::map<uint32_t, ConstByteArray>;
 
   RBC(Endpoint &endpoint, MuddleAddress address, CallbackFunction call_back,
       const CertificatePtr &certificate = nullptr, uint16_t channel = CHANNEL_RBC_BROADCAST,
@@ -99,6 +102,7 @@ public:
   void Broadcast(SerialisedMessage const &msg);
   bool ResetCabinet(CabinetMembers const &cabinet) override;
   void Enable(bool enable) override;
+  void EnableDispersal(std::size_t min_message_size);
   void SetQuestion(ConstByteArray const &unused, ConstByteArray const &answer) override
   {
     FETCH_UNUSED(unused);
@@ -125,6 +129,12 @@ protected:
     SerialisedMessage original_message{};  ///< Original message broadcasted
     HashDigest        message_hash{};      ///< Hash of message
     MessageStatMap    msgs_count{};        ///< Count of RBCMessages received for a given hash
+
+    // Dispersal of large messages (as announced by the broadcaster)
+    HashDigest  dispersed_hash{};   ///< Hash of the dispersed message
+    uint64_t    dispersed_size{0};  ///< Size of the dispersed message
+    HashDigests fragment_hashes{};  ///< Hashes of each of the fragments
+    FragmentMap fragments{};        ///< Fragments received, verified once the hashes are known
   };
 
   struct Party
@@ -146,12 +156,14 @@ protected:
   void         OnRReady(MessageReady const &msg, uint32_t sender_index);
   void         OnRRequest(MessageRequest const &msg, uint32_t sender_index);
   void         OnRAnswer(MessageAnswer const &msg, uint32_t sender_index);
+  void         OnRFragment(MessageFragment const &msg, uint32_t sender_index);
   /// @}
 
   /// Message communication - not thread safe.
   /// @{
   virtual void Send(RBCMessage const &msg, MuddleAddress const &address);
   virtual void InternalBroadcast(RBCMessage const &msg);
+  bool         InternalDisperse(MessageBroadcast const &msg);
   void         Deliver(SerialisedMessage const &msg, uint32_t sender_index);
 
   Endpoint &endpoint()
@@ -190,6 +202,7 @@ protected:
   bool                ReceivedEcho(TagType tag, MessageEcho const &msg);
   struct MessageCount ReceivedReady(TagType tag, MessageHash const &msg);
   bool                SetPartyFlag(uint32_t sender_index, TagType tag, MessageType msg_type);
+  bool                RecoverDispersedMessage(TagType tag);
   /// @}
 
   /// Mutex setup that allows easy debugging of deadlocks
@@ -202,6 +215,8 @@ private:
   uint16_t channel_{CHANNEL_RBC_BROADCAST};
   bool     enabled_ = true;
 
+  std::size_t dispersal_threshold_{0};  ///< Minimum size of a dispersed message (0 = disabled)
+
   std::atomic<uint32_t> id_{0};  ///< Rank used in RBC (derived from position in current_cabinet_)
   std::atomic<uint8_t>  msg_counter_{0};  ///< Counter for messages we have broadcasted
   PartyList             parties_;         ///< Keeps track of messages from cabinet members
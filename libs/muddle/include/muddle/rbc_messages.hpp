@@ -24,11 +24,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace fetch {
 namespace muddle {
 
 using HashDigest           = byte_array::ByteArray;
+using HashDigests          = std::vector<HashDigest>;
 using TagType              = uint64_t;
 using SerialisedMessage    = byte_array::ConstByteArray;
 using RBCSerializer        = fetch::serializers::MsgPackSerializer;
@@ -41,6 +43,8 @@ using RBCSerializerCounter = fetch::serializers::SizeCounter;
  * RReady - message signalling the receipt of protocol specified number of REcho's
  * RRequest - request for original message if the hash of RReady messages does not match our
  * RBroadcast message RAnswer - reply to RRequest message
+ * RFragment - an erasure coded fragment of a large message, replaces RBroadcast when the message
+ * is dispersed
  */
 
 enum class RBCMessageType : uint8_t
@@ -49,7 +53,8 @@ enum class RBCMessageType : uint8_t
   R_ECHO,
   R_READY,
   R_REQUEST,
-  R_ANSWER
+  R_ANSWER,
+  R_FRAGMENT
 };
 
 template <RBCMessageType TYPE, typename Parent>
@@ -60,6 +65,7 @@ class RMessage;
 using RBroadcast = RBCMessageImpl<RBCMessageType::R_BROADCAST, RMessage>;
 using RRequest   = RBCMessageImpl<RBCMessageType::R_REQUEST, RMessage>;
 using RAnswer    = RBCMessageImpl<RBCMessageType::R_ANSWER, RMessage>;
+using RFragment  = RBCMessageImpl<RBCMessageType::R_FRAGMENT, RMessage>;
 using REcho      = RBCMessageImpl<RBCMessageType::R_ECHO, RHash>;
 using RReady     = RBCMessageImpl<RBCMessageType::R_READY, RHash>;
 
@@ -69,6 +75,7 @@ using MessageHash     = std::shared_ptr<RHash>;
 using MessageBroadcast = std::shared_ptr<RBroadcast>;
 using MessageRequest   = std::shared_ptr<RRequest>;
 using MessageAnswer    = std::shared_ptr<RAnswer>;
+using MessageFragment  = std::shared_ptr<RFragment>;
 using MessageEcho      = std::shared_ptr<REcho>;
 using MessageReady     = std::shared_ptr<RReady>;
 
@@ -115,6 +122,9 @@ public:
     case RBCMessageType::R_ANSWER:
       f(New<RAnswer>(std::forward<Args>(args)...));
       break;
+    case RBCMessageType::R_FRAGMENT:
+      f(New<RFragment>(std::forward<Args>(args)...));
+      break;
     default:
       return false;
     }
@@ -201,6 +211,20 @@ public:
   }
 };
 
+/**
+ * The payload of an RFragment message. The broadcaster sends each cabinet member the fragment
+ * matching its position in the cabinet together with the hashes of all the fragments, which the
+ * member then relays (without the hashes) to the rest of the cabinet.
+ */
+struct RBCFragment
+{
+  uint32_t          index{0};           ///< The position of the fragment
+  uint64_t          message_size{0};    ///< The size of the complete message
+  HashDigest        message_hash{};     ///< The hash of the complete message
+  HashDigests       fragment_hashes{};  ///< The hashes of every fragment (empty when relayed)
+  SerialisedMessage data{};             ///< The fragment itself
+};
+
 }  // namespace muddle
 
 namespace serializers {
@@ -242,6 +266,41 @@ public:
     msg.type_ = static_cast<muddle::RBCMessageType>(type);
   }
 };
+
+template <typename D>
+struct MapSerializer<muddle::RBCFragment, D>
+{
+public:
+  using Type       = muddle::RBCFragment;
+  using DriverType = D;
+
+  static uint8_t const INDEX           = 1;
+  static uint8_t const MESSAGE_SIZE    = 2;
+  static uint8_t const MESSAGE_HASH    = 3;
+  static uint8_t const FRAGMENT_HASHES = 4;
+  static uint8_t const DATA            = 5;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &fragment)
+  {
+    auto map = map_constructor(5);
+    map.Append(INDEX, fragment.index);
+    map.Append(MESSAGE_SIZE, fragment.message_size);
+    map.Append(MESSAGE_HASH, fragment.message_hash);
+    map.Append(FRAGMENT_HASHES, fragment.fragment_hashes);
+    map.Append(DATA, fragment.data);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &fragment)
+  {
+    map.ExpectKeyGetValue(INDEX, fragment.index);
+    map.ExpectKeyGetValue(MESSAGE_SIZE, fragment.message_size);
+    map.ExpectKeyGetValue(MESSAGE_HASH, fragment.message_hash);
+    map.ExpectKeyGetValue(FRAGMENT_HASHES, fragment.fragment_hashes);
+    map.ExpectKeyGetValue(DATA, fragment.data);
+  }
+};
 }  // namespace serializers
 
 }  // namespace fetch
@@ -17,9 +17,17 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/service_ids.hpp"
 #include "moment/clock_interfaces.hpp"
+#include "muddle/compression_dictionary.hpp"
 #include "network/service/promise.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+
 namespace fetch {
 namespace muddle {
 
@@ -34,6 +42,36 @@ struct RouterConfiguration
   Duration temporary_connection_length{
       std::chrono::seconds(4)};  ///< Time should be slightly longer than the retry period
   uint32_t retry_delay_ms{2000};
+
+  /// @name Signature verification
+  /// @{
+  std::size_t verification_threads{2};
+  std::size_t verification_batch_size{32};
+  bool        forward_before_verification{true};  ///< Relay routed packets while they are verified
+  /// @}
+
+  /// @name Echo cache
+  /// @{
+  std::size_t          echo_cache_capacity{1u << 18u};  ///< Total number of ids (8 bytes each)
+  std::size_t          echo_cache_buckets{4};           ///< Number of time buckets used
+  std::chrono::seconds echo_cache_lifetime{600};        ///< Minimum time an id is remembered
+  /// @}
+
+  /// @name Payload compression
+  /// @{
+  bool                       compression_enabled{true};    ///< Advertise and use compression
+  std::size_t                compression_threshold{1024};  ///< Minimum size to be compressed
+  byte_array::ConstByteArray compression_dictionary{
+      TransactionCompressionDictionary()};  ///< Shared dictionary (empty to disable)
+  /// @}
+
+  /// @name Outbound prioritisation
+  /// @{
+  std::unordered_set<uint16_t> priority_services{
+      SERVICE_MUDDLE, SERVICE_DKG, SERVICE_RBC,
+      SERVICE_PBC};  ///< Services whose (small) packets are written ahead of other traffic
+  std::size_t bulk_threshold{16 * 1024};  ///< Payload size from which a packet is bulk traffic
+  /// @}
 };
 
 }  // namespace muddle
@@ -25,10 +25,16 @@
 #include "network/service/types.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace muddle {
@@ -45,14 +51,21 @@ public:
   using Handler       = std::function<void(Promise)>;
   using SharedHandler = std::shared_ptr<Handler>;
   using WeakHandler   = std::weak_ptr<Handler>;
+  using Duration      = std::chrono::steady_clock::duration;
 
   static constexpr char const *LOGGING_NAME = "MuddleRpcClient";
 
+  static constexpr std::size_t DEFAULT_MAX_BATCH_SIZE = 64;
+  static Duration const        DEFAULT_BATCH_WINDOW;
+
   // Construction / Destruction
   Client(std::string name, MuddleEndpoint &endpoint, uint16_t service, uint16_t channel);
   Client(Client const &) = delete;
   Client(Client &&)      = delete;
-  ~Client() override     = default;
+  ~Client() override;
+
+  void EnableBatching(Duration const &window    = DEFAULT_BATCH_WINDOW,
+                      std::size_t     max_calls = DEFAULT_MAX_BATCH_SIZE);
 
   template <typename... Args>
   Promise CallSpecificAddress(Address const &address, ProtocolId const &protocol,
@@ -76,9 +89,9 @@ public:
     service::PackCall(params, protocol, function, std::forward<Args>(args)...);
 
     FETCH_LOG_TRACE(LOGGING_NAME, "Registering promise ", prom->id(), " with ", protocol, ':',
-                    function, " (call) ", &promises_);
+                    function, " (call)");
 
-    if (!DeliverRequest(address, params.data()))
+    if (!SubmitRequest(address, prom->id(), params.data()))
     {
       FETCH_LOG_WARN(LOGGING_NAME, "Call to ", protocol, ":", function, " prom=", prom->id(),
                      " failed!");
@@ -104,9 +117,39 @@ private:
   using Flag            = std::atomic<bool>;
   using PromiseQueue    = std::list<MuddleEndpoint::Response>;
   using SubscriptionPtr = MuddleEndpoint::SubscriptionPtr;
+  using Clock           = std::chrono::steady_clock;
+  using Timepoint       = Clock::time_point;
+  using PromiseIds      = std::vector<service::PromiseCounter>;
+  using Requests        = std::vector<network::MessageBuffer>;
+
+  /// The calls waiting to be sent to a peer
+  struct Batch
+  {
+    Timepoint  created{};
+    PromiseIds ids{};
+    Requests   requests{};
+  };
+
+  struct PeerState
+  {
+    std::size_t outstanding{0};  ///< The number of request packets awaiting a response
+    Batch       batch{};
+  };
+
+  using PeerStates = std::unordered_map<Address, PeerState>;
+  using ThreadPtr  = std::unique_ptr<std::thread>;
 
   void OnMessage(Packet const &packet, Address const &last_hop);
 
+  /// @name Batching
+  /// @{
+  bool SubmitRequest(Address const &address, service::PromiseCounter id,
+                     network::MessageBuffer const &data);
+  void FlushBatch(Address const &address, Batch batch);
+  void FlushExpiredBatches();
+  void RunBatchFlusher();
+  /// @}
+
   static std::size_t const NUM_THREADS = 1;
 
   std::string const name_;
@@ -115,6 +158,18 @@ private:
   NetworkId const   network_id_;
   uint16_t const    service_;
   uint16_t const    channel_;
+
+  /// @name Batching
+  /// @{
+  Flag                    batching_enabled_{false};
+  Duration                batch_window_{DEFAULT_BATCH_WINDOW};
+  std::size_t             max_batch_size_{DEFAULT_MAX_BATCH_SIZE};
+  std::mutex              batch_mutex_;
+  std::condition_variable batch_cv_;
+  bool                    stopping_{false};
+  PeerStates              peers_{};
+  ThreadPtr               batch_thread_{};
+  /// @}
 };
 
 }  // namespace rpc
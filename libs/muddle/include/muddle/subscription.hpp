@@ -21,8 +21,15 @@
 #include "logging/logging.hpp"
 #include "muddle/packet.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
 
 namespace fetch {
 namespace muddle {
@@ -30,12 +37,18 @@ namespace muddle {
 /**
  * Subscription is an object that wraps callbacks to a given client for messages. These objects are
  * help by both client and inside the router for the purpose of message dispatching
+ *
+ * By default the message handler is invoked on the dispatching (router) thread. Clients with slow
+ * handlers should enable asynchronous dispatch, in which case messages are queued to a worker
+ * thread owned by the subscription. The queue is bounded, once it is full further messages are
+ * dropped rather than stalling the delivery of messages to other subscriptions.
  */
 class Subscription
 {
 public:
   using Address         = Packet::Address;
   using Payload         = Packet::Payload;
+  using PacketPtr       = std::shared_ptr<Packet>;
   using Handle          = uint64_t;
   using MessageCallback = std::function<void(
       Address const & /*from*/, uint16_t /*service*/, uint16_t /*channel*/, uint16_t /*counter*/,
@@ -66,15 +79,41 @@ public:
   void SetMessageHandler(Class *instance,
                          void (Class::*member_function)(Packet const &, Address const &));
 
+  /// @name Asynchronous Dispatch
+  /// @{
+  void        EnableAsyncDispatch(std::size_t max_queue_size);
+  bool        IsAsync() const;
+  std::size_t dropped_count() const;
+  /// @}
+
   void Dispatch(Packet const &packet, Address const &last_hop) const;
+  void Dispatch(PacketPtr const &packet, Address const &last_hop);
 
   // Operators
   Subscription &operator=(Subscription const &) = delete;
   Subscription &operator=(Subscription &&) = delete;
 
 private:
+  using QueueElement = std::pair<PacketPtr, Address>;
+  using Queue        = std::deque<QueueElement>;
+  using ThreadPtr    = std::unique_ptr<std::thread>;
+
+  void ProcessQueue();
+  void StopAsyncDispatch();
+
   mutable Mutex    callback_lock_;
   LowLevelCallback callback_;
+
+  /// @name Asynchronous Dispatch
+  /// @{
+  mutable std::mutex       queue_lock_;
+  std::condition_variable  queue_cv_;
+  Queue                    queue_;
+  std::size_t              max_queue_size_{0};  ///< The queue bound, zero when synchronous
+  bool                     stop_{false};        ///< Signals the worker to stop
+  std::atomic<std::size_t> dropped_count_{0};   ///< The number of messages dropped
+  ThreadPtr                worker_;
+  /// @}
 };
 
 template <typename Class>
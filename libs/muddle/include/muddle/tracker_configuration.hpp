@@ -19,6 +19,7 @@
 
 #include "network/service/promise.hpp"
 
+#include <chrono>
 #include <sstream>
 
 namespace fetch {
@@ -132,6 +133,10 @@ struct TrackerConfiguration
   /// @{
   uint64_t kademlia_bucket_size{20};
   uint64_t kademlia_bucket_count{160};
+  uint64_t lookup_parallelism{3};  ///< Concurrent queries made by each peer lookup
+  uint64_t max_lookups{16};        ///< Maximum number of concurrent peer lookups
+  Duration lookup_retry_interval{
+      std::chrono::duration_cast<Duration>(std::chrono::seconds{30})};  ///< Between failed lookups
   /// @}
 
   /// Connectivity
@@ -17,6 +17,8 @@
 //
 //------------------------------------------------------------------------------
 
+#include "routing_message.hpp"
+
 #include "core/mutex.hpp"
 #include "crypto/fnv.hpp"
 #include "muddle/address.hpp"
@@ -31,7 +33,6 @@ class Packet;
 class Router;
 class MuddleRegister;
 class PeerConnectionList;
-struct RoutingMessage;
 
 class DirectMessageService
 {
@@ -75,6 +76,8 @@ private:
   template <typename T>
   void SendMessageToConnection(Handle handle, T const &msg, bool exchange = false);
 
+  RoutingMessage CreateRoutingMessage(RoutingMessage::Type type) const;
+
   void OnDirectMessage(Handle handle, PacketPtr const &packet);
   void OnRoutingMessage(Handle handle, PacketPtr const &packet, RoutingMessage const &msg);
   void OnRoutingPing(Handle handle, PacketPtr const &packet, RoutingMessage const &msg);
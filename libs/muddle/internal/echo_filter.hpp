@@ -0,0 +1,113 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * A fixed size, lock free set of recently seen packet (echo) ids.
+ *
+ * The set is split into a number of time buckets. Ids are always added to the bucket for the
+ * current period and looked up in all the buckets which have not yet expired. When a new period
+ * starts the oldest bucket is cleared and reused, so the memory used by the filter never grows and
+ * expiry does not require a sweep over the individual entries.
+ *
+ * Each bucket is an open addressed hash table with a short linear probe. When all the slots of the
+ * probe sequence are in use the entry in the first slot is evicted. Entries are the full 64-bit
+ * ids, so a false positive requires two ids to collide.
+ */
+class EchoFilter
+{
+public:
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+  using Duration  = Clock::duration;
+  using Entries   = std::unordered_map<std::size_t, Timepoint>;
+
+  enum class Result
+  {
+    DUPLICATE,       ///< The id has been seen before
+    UNIQUE,          ///< The id was not present (and has been registered if requested)
+    UNIQUE_EVICTED,  ///< The id was not present and registering it evicted an older id
+  };
+
+  static constexpr std::size_t MAX_PROBES = 8;
+
+  // Construction / Destruction
+  EchoFilter(std::size_t capacity, std::size_t num_buckets, Duration lifetime);
+  EchoFilter(EchoFilter const &) = delete;
+  EchoFilter(EchoFilter &&)      = delete;
+  ~EchoFilter()                  = default;
+
+  Result      Check(uint64_t id, bool register_echo = true);
+  Result      Check(uint64_t id, Timepoint const &now, bool register_echo = true);
+  std::size_t Expire(Timepoint const &now);
+
+  /// @name Accessors
+  /// @{
+  Entries     entries(Timepoint const &now) const;
+  std::size_t capacity() const;
+  std::size_t size(Timepoint const &now) const;
+  /// @}
+
+  // Operators
+  EchoFilter &operator=(EchoFilter const &) = delete;
+  EchoFilter &operator=(EchoFilter &&) = delete;
+
+private:
+  using Slot  = std::atomic<uint64_t>;
+  using Slots = std::unique_ptr<Slot[]>;
+
+  static constexpr int64_t  INVALID_EPOCH = -1;
+  static constexpr uint64_t EMPTY         = 0;
+
+  struct Bucket
+  {
+    std::atomic<int64_t> epoch{INVALID_EPOCH};
+    Slots                slots{};
+  };
+
+  using Buckets = std::vector<Bucket>;
+
+  int64_t  ToEpoch(Timepoint const &now) const;
+  bool     IsLive(Bucket const &bucket, int64_t epoch) const;
+  Bucket & Claim(int64_t epoch);
+  bool     Contains(Bucket const &bucket, uint64_t key) const;
+  Result   Insert(Bucket &bucket, uint64_t key);
+  uint64_t Clear(Bucket &bucket);
+
+  std::size_t const slots_per_bucket_;
+  std::size_t const mask_;
+  Duration const    period_;
+  Timepoint const   origin_{Clock::now()};
+  Buckets           buckets_;
+
+  std::atomic<uint64_t> expired_{0};  ///< The number of entries removed since the last Expire
+};
+
+}  // namespace muddle
+}  // namespace fetch
@@ -0,0 +1,70 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * A Reed-Solomon erasure code over GF(2^8).
+ *
+ * A message is split into `num_data` pieces which are treated as the coefficients of a polynomial
+ * (one polynomial for every byte column). The polynomial is evaluated at `num_fragments` distinct
+ * points to form the fragments, any `num_data` of which are enough to recover the message.
+ */
+class ErasureCoder
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Fragments      = std::vector<ConstByteArray>;
+  using FragmentMap    = std::map<uint32_t, ConstByteArray>;  ///< Fragments indexed by position
+
+  static constexpr std::size_t MAX_FRAGMENTS = 255;
+
+  // Construction / Destruction
+  ErasureCoder(std::size_t num_data, std::size_t num_fragments);
+  ErasureCoder(ErasureCoder const &) = default;
+  ErasureCoder(ErasureCoder &&)      = default;
+  ~ErasureCoder()                    = default;
+
+  Fragments Encode(ConstByteArray const &message) const;
+  bool      Decode(FragmentMap const &fragments, std::size_t message_size,
+                   ConstByteArray &message) const;
+
+  std::size_t num_data() const;
+  std::size_t num_fragments() const;
+  std::size_t FragmentSize(std::size_t message_size) const;
+
+  // Operators
+  ErasureCoder &operator=(ErasureCoder const &) = delete;
+  ErasureCoder &operator=(ErasureCoder &&) = delete;
+
+private:
+  std::size_t const num_data_;
+  std::size_t const num_fragments_;
+};
+
+}  // namespace muddle
+}  // namespace fetch
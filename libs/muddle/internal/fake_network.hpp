@@ -19,6 +19,9 @@
 
 #include "muddle.hpp"
 
+#include <atomic>
+#include <cstdint>
+
 namespace fetch {
 namespace muddle {
 
@@ -54,12 +57,19 @@ public:
   static void      DeployPacket(Address const &to, PacketPtr packet);
   static void      BroadcastPacket(PacketPtr const &packet);
   static bool      GetNextPacket(Address const &to, PacketPtr &packet);
+  static void      SetPacketLoss(double probability);
 
   // note there are two locks, a global lock on the map of address
   // to the packet struct, and a lock in the packet struct itself.
   // This avoids a bottleneck on the global lock
   static std::mutex      network_lock_;
   static FakeNetworkImpl network_;
+
+private:
+  static bool IsLost();
+
+  // drop threshold against a uniformly distributed 32 bit value, zero when there is no loss
+  static std::atomic<uint64_t> loss_threshold_;
 };
 
 /**
@@ -21,6 +21,9 @@
 #include "kademlia/primitives.hpp"
 #include "moment/clock_interfaces.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <unordered_set>
 #include <vector>
@@ -45,53 +48,32 @@ struct Bucket
   static uint64_t IdByHamming(KademliaDistance const &dist)
   {
     uint64_t ret{0};
-    for (auto const &d : dist)
+    for (std::size_t i = 0; i < KademliaDistance::NUM_WORDS; ++i)
     {
-      ret += platform::CountSetBits(d);
+      ret += platform::CountSetBits(dist.word(i));
     }
     return ret;
   }
 
   static uint64_t IdByLogarithm(KademliaDistance const &dist)
   {
+    uint64_t const bits = 8 * dist.size() * sizeof(uint8_t);
 
-    static uint64_t zeros[16] = {
-        4,  // 0: 0b0000
-        3,  // 1: 0b0001
-        2,  // 2: 0b0010
-        2,  // 3: 0b0011
-        1,  // 4: 0b0100
-        1,  // 5: 0b0101
-        1,  // 6: 0b0110
-        1,  // 7: 0b0111
-        0,  // 8: 0b1000
-        0,  // 9: 0b1001
-        0,  // 10: 0b1010
-        0,  // 11: 0b1011
-        0,  // 12: 0b1100
-        0,  // 13: 0b1101
-        0,  // 14: 0b1110
-        0   // 15: 0b1111
-    };
-
-    uint64_t    ret{8 * dist.size() * sizeof(uint8_t)};
-    std::size_t i = dist.size();
-
-    // TODO(tfr): this function can be improved by using intrinsics
-    // but endianness needs to be considered.
-    do
+    // counting the leading zeros a word at a time, starting from the most significant
+    uint64_t zeros{0};
+    for (std::size_t i = 0; i < KademliaDistance::NUM_WORDS; ++i)
     {
-      --i;
-      auto top = zeros[(dist[i] >> 4) & 0xF];
-      ret -= top;
-      if (top == 4)
+      uint64_t const word = dist.word(i);
+      if (word != 0)
       {
-        ret -= zeros[dist[i] & 0xF];
+        zeros += platform::CountLeadingZeroes64(word);
+        break;
       }
 
-    } while ((i != 0) && (dist[i] == 0));
+      zeros += 64;
+    }
 
-    return ret;
+    return bits - std::min(zeros, bits);
   }
 };
 
@@ -0,0 +1,100 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "kademlia/peer_info.hpp"
+#include "kademlia/primitives.hpp"
+#include "muddle/packet.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * The state of an iterative Kademlia lookup for a single address.
+ *
+ * The lookup maintains a short list of the candidates closest to the target, up to `parallelism`
+ * of which are queried at the same time. The peers returned by each query are merged into the list
+ * so that the following queries are made to peers ever closer to the target. The lookup completes
+ * when the target has been found, or when every one of the closest candidates has been queried.
+ */
+class KademliaLookup
+{
+public:
+  using Address = Packet::Address;
+  using Peers   = std::deque<PeerInfo>;
+
+  // Construction / Destruction
+  KademliaLookup(Address target, Address own_address, std::size_t parallelism,
+                 std::size_t max_candidates);
+  KademliaLookup(KademliaLookup const &) = default;
+  KademliaLookup(KademliaLookup &&)      = default;
+  ~KademliaLookup()                      = default;
+
+  /// @name Lookup
+  /// @{
+  void AddCandidates(Peers const &peers);
+  bool NextQuery(Address &peer);
+  void OnResponse(Address const &peer, Peers const &peers);
+  void OnFailure(Address const &peer);
+  /// @}
+
+  /// @name Status
+  /// @{
+  bool           IsComplete() const;
+  bool           found() const;
+  Address const &target() const;
+  std::size_t    num_in_flight() const;
+  std::size_t    num_queried() const;
+  /// @}
+
+  // Operators
+  KademliaLookup &operator=(KademliaLookup const &) = default;
+  KademliaLookup &operator=(KademliaLookup &&) = default;
+
+private:
+  using AddressSet = std::unordered_set<Address>;
+
+  struct Candidate
+  {
+    KademliaDistance distance{};
+    Address          address{};
+  };
+
+  using Candidates = std::vector<Candidate>;
+
+  void AddCandidate(Address const &address);
+
+  Address         target_;
+  KademliaAddress target_kad_address_;
+  Address         own_address_;
+  std::size_t     parallelism_;
+  std::size_t     max_candidates_;
+  Candidates      candidates_{};  ///< The closest candidates, ordered by distance to the target
+  AddressSet      queried_{};     ///< Every peer that has been queried (or is being queried)
+  AddressSet      in_flight_{};   ///< The peers with an outstanding query
+  bool            found_{false};
+};
+
+}  // namespace muddle
+}  // namespace fetch
@@ -23,6 +23,7 @@
 #include "core/reactor.hpp"
 #include "core/service_ids.hpp"
 #include "kademlia/address_priority.hpp"
+#include "kademlia/lookup.hpp"
 #include "kademlia/peer_tracker_protocol.hpp"
 #include "kademlia/table.hpp"
 #include "moment/clock_interfaces.hpp"
@@ -76,6 +77,8 @@ public:
   using NetworkUris            = std::vector<Uri>;
   using Handle                 = network::AbstractConnection::ConnectionHandleType;
   using AddressToHandles       = std::unordered_map<Address, std::unordered_set<Handle>>;
+  using KademliaAddressMap     = std::unordered_map<Address, KademliaAddress>;
+  using Lookups                = std::unordered_map<Address, KademliaLookup>;
 
   struct UnresolvedConnection
   {
@@ -156,6 +159,7 @@ public:
   AddressSet            outgoing() const;
   AddressSet            all_peers() const;
   AddressSet            desired_peers() const;
+  std::size_t           active_lookups() const;
   AddressSet            directly_connected_peers() const
   {
     FETCH_LOCK(direct_mutex_);
@@ -220,6 +224,19 @@ private:
                       service::Promise const &promise);
   /// @}
 
+  /// Iterative lookups
+  /// @{
+  bool UpdateLookup(Address const &address);
+  void IssueLookupQueries(Address const &target);
+  void OnResolvedLookup(uint64_t query_id, Address const &peer, Address const &target,
+                        service::Promise const &promise);
+  /// @}
+
+  /// Routing
+  /// @{
+  void UpdateDirectlyConnectedPeers(AddressSet peers);
+  /// @}
+
   /// Thread-safety
   /// @{
 
@@ -253,9 +270,13 @@ private:
 
   /// Direct connections
   /// @{
-  mutable Mutex direct_mutex_;
-  AddressSet    keep_connections_{};
-  AddressSet    directly_connected_peers_{};
+  static constexpr std::size_t MAX_ROUTE_CACHE_SIZE = 4096;
+
+  mutable Mutex      direct_mutex_;
+  AddressSet         keep_connections_{};
+  AddressSet         directly_connected_peers_{};
+  KademliaAddressMap directly_connected_kad_{};  ///< Kademlia addresses of the direct peers
+  AddressMap         route_cache_{};             ///< Recently resolved next hops, by target
   /// @}
 
   /// Handling new comers
@@ -290,6 +311,14 @@ private:
   std::atomic<uint64_t>                  pull_next_id_{0};
   /// @}
 
+  /// Management variables for iterative lookups
+  /// @{
+  mutable Mutex    lookup_mutex_;
+  Lookups          lookups_;
+  AddressTimestamp lookup_failures_;  ///< When each unsuccessful lookup completed
+  PendingPromised  lookup_promises_;
+  /// @}
+
   /// Logging sets
   /// @{
   AddressSet no_uri_{};  ///< TODO(tfr):  Get rid of it?
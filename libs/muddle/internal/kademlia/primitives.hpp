@@ -23,6 +23,11 @@
 #include "muddle/packet.hpp"
 #include "vectorise/platform.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
 namespace fetch {
 namespace muddle {
 
@@ -97,6 +102,14 @@ struct KademliaAddress
 
 // using KademliaDistance = std::array<uint8_t, KademliaAddress::ADDRESS_SIZE>;
 
+/**
+ * The XOR distance between two Kademlia addresses. The final byte of the distance is the most
+ * significant.
+ *
+ * To keep the distance calculations cheap (they are performed for every routed packet) the bytes
+ * are also accessible as 64-bit words, ordered from the most significant. This allows the
+ * comparison, leading zero and bit counts to be computed a word at a time.
+ */
 class KademliaDistance
 {
 public:
@@ -104,6 +117,10 @@ public:
   using iterator       = ContainerType::iterator;
   using const_iterator = ContainerType::const_iterator;
 
+  static constexpr std::size_t WORD_SIZE = sizeof(uint64_t);
+  static constexpr std::size_t NUM_WORDS =
+      (KademliaAddress::ADDRESS_SIZE + WORD_SIZE - 1) / WORD_SIZE;
+
   iterator begin()
   {
     return value_.begin();
@@ -148,15 +165,49 @@ public:
     return value_.size();
   }
 
-  bool operator<(KademliaDistance const &other) const
+  /**
+   * Get one of the words of the distance
+   *
+   * @param index The index of the word, zero being the most significant
+   * @return The word. A partial (least significant) word is aligned to the top of the word
+   */
+  uint64_t word(std::size_t index) const
   {
-    std::size_t i = size();
+    std::size_t const end = value_.size() - (index * WORD_SIZE);
 
-    do
+    uint64_t ret{0};
+    if (end >= WORD_SIZE)
     {
-      --i;
-    } while ((i != 0) && (value_[i] == other.value_[i]));
-    return value_[i] < other.value_[i];
+      std::memcpy(&ret, value_.data() + (end - WORD_SIZE), WORD_SIZE);
+#if defined(FETCH_PLATFORM_BIG_ENDIAN)
+      ret = __builtin_bswap64(ret);
+#endif
+    }
+    else
+    {
+      for (std::size_t i = 0; i < end; ++i)
+      {
+        ret |= static_cast<uint64_t>(value_[i]) << ((i + WORD_SIZE - end) * 8u);
+      }
+    }
+
+    return ret;
+  }
+
+  bool operator<(KademliaDistance const &other) const
+  {
+    for (std::size_t i = 0; i < NUM_WORDS; ++i)
+    {
+      uint64_t const a = word(i);
+      uint64_t const b = other.word(i);
+
+      if (a != b)
+      {
+        return a < b;
+      }
+    }
+
+    return false;
   }
 
 private:
@@ -167,11 +218,27 @@ private:
 
 inline KademliaDistance GetKademliaDistance(KademliaAddress const &a, KademliaAddress const &b)
 {
+  constexpr std::size_t WORD_SIZE = KademliaDistance::WORD_SIZE;
+
   KademliaDistance ret;
+  uint8_t *const   output = &ret[0];
+
+  // the bulk of the address is combined a word at a time
+  std::size_t i = 0;
+  for (; (i + WORD_SIZE) <= a.size(); i += WORD_SIZE)
+  {
+    uint64_t left{0};
+    uint64_t right{0};
+    std::memcpy(&left, a.words + i, WORD_SIZE);
+    std::memcpy(&right, b.words + i, WORD_SIZE);
+
+    left ^= right;
+    std::memcpy(output + i, &left, WORD_SIZE);
+  }
 
-  for (std::size_t i = 0; i < a.size(); ++i)
+  for (; i < a.size(); ++i)
   {
-    ret[i] = a.words[i] ^ b.words[i];
+    output[i] = static_cast<uint8_t>(a.words[i] ^ b.words[i]);
   }
 
   return ret;
@@ -216,6 +216,9 @@ private:
   void UpdateExternalAddresses();
   void CreateTcpServer(uint16_t port);
   void CreateTcpClient(Uri const &peer);
+  bool CreateShmClient(Uri const &peer);
+  void AddClientConnection(Uri const &peer, Client const &conn);
+  bool IsLocalAddress(std::string const &address) const;
 
   std::string const    name_;
   char const *const    logging_name_{name_.c_str()};
@@ -229,7 +232,8 @@ private:
   std::atomic<bool>    stopping_{false};
 
   mutable Mutex servers_lock_;
-  ServerList    servers_;  ///< The list of listening servers
+  ServerList    servers_;      ///< The list of listening servers
+  ServerList    shm_servers_;  ///< The servers for connections from the same host
 
   PeerConnectionList clients_;  ///< The list of active and possible inactive connections
   Timepoint          last_cleanup_ = Clock::now();
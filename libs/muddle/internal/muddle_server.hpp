@@ -21,6 +21,7 @@
 
 #include "core/serializers/main_serializer.hpp"
 #include "logging/logging.hpp"
+#include "muddle/packet_pool.hpp"
 #include "network/tcp/abstract_server.hpp"
 
 #include <memory>
@@ -86,8 +87,8 @@ private:
   {
     try
     {
-      auto packet = std::make_shared<Packet>();
-      if (Packet::FromBuffer(*packet, msg.pointer(), msg.size()))
+      auto packet = CreatePacket();
+      if (Packet::FromBuffer(*packet, msg))
       {
         // dispatch the message to router
         router_.Route(client, packet);
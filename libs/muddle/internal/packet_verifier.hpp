@@ -0,0 +1,109 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+#include "muddle/packet.hpp"
+#include "network/details/thread_pool.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Verifies the signatures of incoming packets away from the network threads.
+ *
+ * Packets are queued and the queue is drained in batches by a pool of worker threads. Within a
+ * batch the verifiers for each sender are only built once. The results of successful checks are
+ * cached (keyed on the digest of the signed data and signature), so the copies of a broadcast
+ * arriving from each of our peers only need to be verified once.
+ *
+ * Completion callbacks are always issued in the order that the packets were submitted and never
+ * concurrently with each other.
+ */
+class PacketVerifier
+{
+public:
+  using PacketPtr = std::shared_ptr<Packet>;
+  using Callback  = std::function<void(PacketPtr const &, bool)>;
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+  using Duration  = Clock::duration;
+
+  static constexpr std::size_t MAX_CACHE_SIZE = 1u << 16u;
+
+  // Construction / Destruction
+  PacketVerifier(std::string const &name, std::size_t num_threads, std::size_t batch_size);
+  PacketVerifier(PacketVerifier const &) = delete;
+  PacketVerifier(PacketVerifier &&)      = delete;
+  ~PacketVerifier();
+
+  /// @name Thread pool control
+  /// @{
+  void Start();
+  void Stop();
+  /// @}
+
+  void        Verify(PacketPtr const &packet, Callback callback);
+  void        TrimCache(Duration const &max_age);
+  std::size_t cache_size() const;
+
+  // Operators
+  PacketVerifier &operator=(PacketVerifier const &) = delete;
+  PacketVerifier &operator=(PacketVerifier &&) = delete;
+
+private:
+  struct Job
+  {
+    PacketPtr packet;
+    Callback  callback;
+    bool      complete{false};
+    bool      genuine{false};
+  };
+
+  using JobPtr   = std::shared_ptr<Job>;
+  using JobQueue = std::deque<JobPtr>;
+  using Cache    = std::unordered_map<byte_array::ConstByteArray, Timepoint>;
+
+  void Drain();
+  bool VerifyPacket(Packet const &packet, crypto::VerifierCache &verifiers);
+  void Complete();
+
+  std::size_t const   batch_size_;
+  network::ThreadPool thread_pool_;
+
+  mutable Mutex lock_;
+  JobQueue      pending_;    ///< The jobs waiting to be verified
+  JobQueue      in_flight_;  ///< All incomplete jobs in submission order
+
+  Mutex completion_lock_;  ///< Serialises the issuing of callbacks
+
+  mutable Mutex cache_lock_;
+  Cache         cache_;
+};
+
+}  // namespace muddle
+}  // namespace fetch
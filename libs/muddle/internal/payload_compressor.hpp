@@ -0,0 +1,69 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Compresses and decompresses packet payloads.
+ *
+ * A compressed payload is made up of a small header (flags and the uncompressed size) followed by
+ * an LZ4 block. The block can optionally be compressed against a shared dictionary, in which case
+ * both ends of the link must have been configured with the same dictionary. This is established
+ * when the connection is set up, by comparing the dictionary ids.
+ */
+class PayloadCompressor
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  static constexpr uint64_t    NO_DICTIONARY         = 0;
+  static constexpr std::size_t HEADER_SIZE           = sizeof(uint8_t) + sizeof(uint32_t);
+  static constexpr std::size_t MAX_DECOMPRESSED_SIZE = 256u * 1024u * 1024u;
+
+  // Construction / Destruction
+  explicit PayloadCompressor(ConstByteArray dictionary = {});
+  PayloadCompressor(PayloadCompressor const &) = delete;
+  PayloadCompressor(PayloadCompressor &&)      = delete;
+  ~PayloadCompressor()                         = default;
+
+  bool Compress(ConstByteArray const &payload, bool use_dictionary,
+                ConstByteArray &compressed) const;
+  bool Decompress(ConstByteArray const &compressed, ConstByteArray &payload) const;
+
+  uint64_t dictionary_id() const;
+
+  // Operators
+  PayloadCompressor &operator=(PayloadCompressor const &) = delete;
+  PayloadCompressor &operator=(PayloadCompressor &&) = delete;
+
+private:
+  static constexpr uint8_t FLAG_DICTIONARY = 0x1;
+
+  ConstByteArray const dictionary_;
+  uint64_t const       dictionary_id_;
+};
+
+}  // namespace muddle
+}  // namespace fetch
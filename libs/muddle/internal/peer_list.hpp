@@ -20,11 +20,14 @@
 #include "core/mutex.hpp"
 #include "network/management/abstract_connection.hpp"
 #include "network/uri.hpp"
+#include "telemetry/telemetry.hpp"
 
 #include <chrono>
 #include <cstddef>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <random>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -39,7 +42,13 @@ class NetworkId;
 /**
  * The peer connection list manages (and owns) the outgoing muddle connections. In the event that
  * a connection failure occurs, the peer connection list will be notified and it will apply an
- * exponential backoff strategy to retrying connections.
+ * exponential backoff strategy to retrying connections. The backoff is randomised, so that peers
+ * which lost their connections at the same time (e.g. in a network partition) do not all retry at
+ * the same time.
+ *
+ * Every persistent peer has a priority. The peers to connect to are handed out in order of their
+ * priority and only up to a limit on the number of pending connection attempts, so that the most
+ * valuable connections are made first when many peers have to be (re)connected at once.
  */
 class PeerConnectionList
 {
@@ -52,6 +61,10 @@ public:
   using PeerSet       = std::unordered_set<Uri>;
   using Clock         = std::chrono::steady_clock;
   using Timepoint     = Clock::time_point;
+  using Duration      = Clock::duration;
+
+  static constexpr double      MAX_PRIORITY = 1.0;
+  static constexpr std::size_t UNLIMITED    = std::numeric_limits<std::size_t>::max();
 
   enum class ConnectionState
   {
@@ -77,6 +90,7 @@ public:
   struct PeerMetadata
   {
     Timepoint   last_failed_connection;  ///< The last time a connection to a node failed.
+    Duration    retry_delay{};           ///< The backoff after the last failed connection.
     std::size_t attempts             = 0;
     std::size_t successes            = 0;  ///< The total number of successful connections.
     std::size_t consecutive_failures = 0;
@@ -101,7 +115,7 @@ public:
 
   /// @name Persistent connections
   /// @{
-  bool AddPersistentPeer(Uri const &peer);
+  bool AddPersistentPeer(Uri const &peer, double priority = MAX_PRIORITY);
   void RemovePersistentPeer(Uri const &peer);
   void RemovePersistentPeer(Handle handle);
 
@@ -121,7 +135,7 @@ public:
   PeerSet         GetPersistentPeers() const;
   bool            GetMetadataForPeer(Uri const &peer, PeerMetadata &metadata) const;
   ConnectionState GetStateForPeer(Uri const &peer) const;
-  PeerList        GetPeersToConnectTo() const;
+  PeerList        GetPeersToConnectTo(std::size_t max_pending = UNLIMITED) const;
   PeerMap         GetCurrentPeers() const;
 
   // Operators
@@ -129,7 +143,12 @@ public:
   PeerConnectionList &operator=(PeerConnectionList &&) = delete;
 
 private:
-  using MetadataMap = std::unordered_map<Uri, PeerMetadata>;
+  using MetadataMap  = std::unordered_map<Uri, PeerMetadata>;
+  using PriorityMap  = std::unordered_map<Uri, double>;
+  using TimepointMap = std::unordered_map<Uri, Timepoint>;
+
+  bool     ReadyForRetry(PeerMetadata const &metadata) const;
+  Duration NextRetryDelay(std::size_t consecutive_failures);
 
   std::string const name_;
   char const *const logging_name_{name_.c_str()};
@@ -137,11 +156,17 @@ private:
   StatusCallback status_callback_;
 
   mutable Mutex lock_;
-  PeerSet       persistent_peers_;
+  PriorityMap   persistent_peers_;  ///< The persistent peers and their priorities
   PeerMap       peer_connections_;
   MetadataMap   peer_metadata_;
+  TimepointMap  disconnected_since_;  ///< When each unconnected persistent peer became so
+  std::mt19937  rng_;                 ///< Randomises the backoff
 
-  bool ReadyForRetry(PeerMetadata const &metadata) const;
+  /// @name Telemetry
+  /// @{
+  telemetry::HistogramPtr time_to_connect_;
+  telemetry::CounterPtr   connection_attempts_total_;
+  /// @}
 };
 
 }  // namespace muddle
@@ -18,6 +18,9 @@
 //------------------------------------------------------------------------------
 
 #include "blacklist.hpp"
+#include "echo_filter.hpp"
+#include "packet_verifier.hpp"
+#include "payload_compressor.hpp"
 #include "subscription_registrar.hpp"
 
 #include "core/mutex.hpp"
@@ -164,6 +167,7 @@ private:
 
   void SendToConnection(Handle handle, PacketPtr const &packet, bool external = true,
                         bool reschedule_on_fail = false);
+  network::MessagePriority Prioritise(Packet const &packet, std::size_t size) const;
   void RoutePacket(PacketPtr const &packet, bool external = true);
   void DispatchDirect(Handle handle, PacketPtr const &packet);
 
@@ -173,7 +177,9 @@ private:
   void CleanEchoCache();
 
   PacketPtr const &Sign(PacketPtr const &p) const;
-  bool             Genuine(PacketPtr const &p) const;
+
+  static bool RequiresVerification(Packet const &packet);
+  void        RouteVerified(Handle handle, PacketPtr const &packet);
 
   telemetry::GaugePtr<uint64_t> CreateGauge(char const *name, char const *description) const;
   telemetry::HistogramPtr       CreateHistogram(char const *name, char const *description) const;
@@ -195,10 +201,24 @@ private:
 
   PeerTrackerPtr tracker_{nullptr};
 
-  mutable Mutex echo_cache_lock_;
-  EchoCache     echo_cache_;
+  EchoFilter echo_filter_;
+
+  ThreadPool     dispatch_thread_pool_;
+  PacketVerifier verifier_;
+
+  /// Payload compression
+  /// @{
+  using CompressionPeers = std::unordered_map<Address, uint64_t>;
+
+  void SetPeerCompression(Address const &address, bool compression, uint64_t dictionary_id);
+  void ClearPeerCompression(Address const &address);
+  bool CompressPayload(Packet &packet);
+  bool DecompressPayload(Packet &packet);
 
-  ThreadPool dispatch_thread_pool_;
+  PayloadCompressor compressor_;
+  mutable Mutex     compression_peers_lock_;
+  CompressionPeers  compression_peers_;  ///< Map of peer address to its dictionary id
+  /// @}
 
   /// Redelivery of packages
   /// @{
@@ -250,11 +270,23 @@ private:
   telemetry::CounterPtr         routing_table_updates_total_;
   telemetry::CounterPtr         echo_cache_trims_total_;
   telemetry::CounterPtr         echo_cache_removals_total_;
+  telemetry::CounterPtr         echo_cache_hits_total_;
+  telemetry::CounterPtr         echo_cache_evictions_total_;
+  telemetry::GaugePtr<uint64_t> echo_cache_size_;
   telemetry::CounterPtr         normal_routing_total_;
   telemetry::CounterPtr         informed_routing_total_;
   telemetry::CounterPtr         speculative_routing_total_;
   telemetry::CounterPtr         failed_routing_total_;
   telemetry::CounterPtr         connection_dropped_total_;
+  telemetry::CounterPtr         tx_compressed_packet_total_;
+  telemetry::CounterPtr         tx_compression_input_bytes_total_;
+  telemetry::CounterPtr         tx_compression_output_bytes_total_;
+  telemetry::HistogramPtr       tx_compression_duration_;
+  telemetry::CounterPtr         rx_compressed_packet_success_total_;
+  telemetry::CounterPtr         rx_compressed_packet_failures_total_;
+  telemetry::HistogramPtr       rx_decompression_duration_;
+  telemetry::CounterPtr         tx_high_priority_packet_total_;
+  telemetry::CounterPtr         tx_bulk_priority_packet_total_;
   /// @}
 
   friend class DirectMessageService;
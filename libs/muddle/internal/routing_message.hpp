@@ -37,6 +37,12 @@ struct RoutingMessage
     MAX_NUM_TYPES
   };
 
+  /// @name Capabilities
+  /// @{
+  bool     compression{false};  ///< The peer is able to receive compressed payloads
+  uint64_t dictionary_id{0};    ///< The id of the peer's compression dictionary (if any)
+  /// @}
+
   Type type{Type::PING};
 };
 
@@ -52,13 +58,17 @@ public:
   using DriverType = D;
   using EnumType   = uint64_t;
 
-  static const uint8_t TYPE = 1;
+  static const uint8_t TYPE          = 1;
+  static const uint8_t COMPRESSION   = 2;
+  static const uint8_t DICTIONARY_ID = 3;
 
   template <typename T>
   static void Serialize(T &map_constructor, Type const &msg)
   {
-    auto map = map_constructor(1);
+    auto map = map_constructor(3);
     map.Append(TYPE, static_cast<EnumType>(msg.type));
+    map.Append(COMPRESSION, msg.compression);
+    map.Append(DICTIONARY_ID, msg.dictionary_id);
   }
 
   template <typename T>
@@ -76,6 +86,13 @@ public:
     }
 
     msg.type = static_cast<Type::Type>(raw_type);
+
+    // the capabilities are not sent by older peers
+    if (map.size() >= 3)
+    {
+      map.ExpectKeyGetValue(COMPRESSION, msg.compression);
+      map.ExpectKeyGetValue(DICTIONARY_ID, msg.dictionary_id);
+    }
   }
 };
 
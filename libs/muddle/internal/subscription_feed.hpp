@@ -38,6 +38,7 @@ class SubscriptionFeed
 public:
   using Address         = Packet::Address;
   using Payload         = Packet::Payload;
+  using PacketPtr       = std::shared_ptr<Packet>;
   using SubscriptionPtr = std::shared_ptr<Subscription>;
 
   // Construction / Destruction
@@ -51,11 +52,12 @@ public:
   SubscriptionFeed &operator=(SubscriptionFeed &&) = delete;
 
   SubscriptionPtr Subscribe();
-  bool            Dispatch(Packet const &packet, Address const &last_hop);
+  bool            Dispatch(PacketPtr const &packet, Address const &last_hop);
 
 private:
   using SubscriptionWeakPtr = std::weak_ptr<Subscription>;
   using SubscriptionList    = std::vector<SubscriptionWeakPtr>;
+  using ActiveList          = std::vector<SubscriptionPtr>;
 
   mutable Mutex    feed_lock_;
   SubscriptionList feed_;
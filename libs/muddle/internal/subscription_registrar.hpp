@@ -22,10 +22,9 @@
 #include "subscription_feed.hpp"
 
 #include <cstdint>
-#include <map>
 #include <memory>
 #include <string>
-#include <tuple>
+#include <unordered_map>
 
 namespace fetch {
 namespace muddle {
@@ -75,6 +74,11 @@ class NetworkId;
  *                              └──────▶│   Subscription    │───▶│      Client       │
  *                                      │                   │
  *                                      └───────────────────┘    └ ─ ─ ─ ─ ─ ─ ─ ─ ─ ┘
+ *
+ * The feeds of a service and channel combination are found with a single hash lookup, the feeds
+ * of the address specific subscriptions are only searched when there are any for the combination.
+ * Feeds are never removed, the registrar lock is therefore only held for the lookup and not while
+ * the messages are dispatched to the subscriptions.
  */
 class SubscriptionRegistrar
 {
@@ -102,17 +106,25 @@ public:
   bool Dispatch(PacketPtr const &packet, Address const &transmitter);
 
 private:
-  using Index              = uint32_t;
-  using AddressIndex       = std::tuple<uint32_t, Address>;
-  using DispatchMap        = std::map<Index, SubscriptionFeed>;
-  using AddressDispatchMap = std::map<AddressIndex, SubscriptionFeed>;
+  using Index          = uint32_t;
+  using AddressFeedMap = std::unordered_map<Address, SubscriptionFeed>;
+
+  /**
+   * The subscription feeds of a service and channel combination
+   */
+  struct Topic
+  {
+    SubscriptionFeed feed;           ///< The feed for messages to any address
+    AddressFeedMap   address_feeds;  ///< The feeds for messages to a specific address
+  };
+
+  using DispatchMap = std::unordered_map<Index, Topic>;
 
   std::string const name_;
   char const *const logging_name_{name_.c_str()};
 
-  mutable Mutex      lock_;                  ///< The registrar lock
-  DispatchMap        dispatch_map_;          ///< The {service,channel} dispatch map
-  AddressDispatchMap address_dispatch_map_;  ///< The {address,service,channel} dispatch map
+  mutable Mutex lock_;          ///< The registrar lock
+  DispatchMap   dispatch_map_;  ///< The {service,channel} dispatch map
 };
 
 }  // namespace muddle
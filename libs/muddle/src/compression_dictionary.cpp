@@ -0,0 +1,301 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "muddle/compression_dictionary.hpp"
+
+#include <cstdint>
+
+namespace fetch {
+namespace muddle {
+namespace {
+
+// Trained with compression::TrainLZ4Dictionary (4 KiB) on 2000 msgpack encoded batches of 1 to 16
+// signed transactions: token transfers, chain code and smart contract calls with fresh keys. On
+// batches which were not part of the training set this reduces the compressed size by a further
+// 1.7% over plain LZ4. Changing the contents changes the dictionary id, so nodes running different
+// dictionaries simply fall back to compressing without one.
+uint8_t const TRANSACTION_DICTIONARY[] = {
+    0x04, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f,
+    0x04, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65,
+    0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22, 0x32, 0x4b,
+    0x20, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f,
+    0x10, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65,
+    0x08, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65,
+    0x08, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65,
+    0x08, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65,
+    0x04, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72,
+    0x02, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x50, 0x7b, 0x22,
+    0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x50, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22, 0x32, 0x41,
+    0x04, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65,
+    0x02, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72,
+    0x01, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f,
+    0x01, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65,
+    0x80, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74,
+    0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x50, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x73, 0x66, 0x65, 0x72, 0x50, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a,
+    0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x50, 0x7b, 0x22, 0x61,
+    0x20, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65,
+    0x08, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f,
+    0x08, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72,
+    0x80, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f,
+    0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x50, 0x7b, 0x22, 0x61, 0x64,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x50,
+    0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x50, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x40, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65,
+    0x02, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65,
+    0x01, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65,
+    0x01, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74,
+    0x04, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74,
+    0x01, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65,
+    0x01, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72,
+    0x80, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65,
+    0x04, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65,
+    0x80, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65,
+    0x74, 0x61, 0x6b, 0x65, 0x50, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a,
+    0x10, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f,
+    0x53, 0x74, 0x61, 0x6b, 0x65, 0x50, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22, 0x32,
+    0x6b, 0x65, 0x50, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22,
+    0x61, 0x6b, 0x65, 0x50, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20,
+    0x00, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72,
+    0x00, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65,
+    0x00, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f,
+    0x00, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65,
+    0x00, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74,
+    0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22, 0x61, 0x64,
+    0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20,
+    0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x52,
+    0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x00, 0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65,
+    0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61,
+    0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64,
+    0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52,
+    0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b,
+    0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x52,
+    0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x65, 0x65, 0x64, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x52, 0x7b, 0x22, 0x61, 0x64,
+    0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61,
+    0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x72, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22, 0x32,
+    0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x52, 0x7b, 0x22,
+    0x6e, 0x73, 0x66, 0x65, 0x72, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x51, 0x7b, 0x22,
+    0x04, 0x64, 0x65, 0x65, 0x64, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b,
+    0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b,
+    0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x66, 0x65, 0x72, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20,
+    0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x52, 0x7b, 0x22, 0x61, 0x64,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x52,
+    0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61,
+    0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22,
+    0x68, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22, 0x32,
+    0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x65, 0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x52, 0x7b,
+    0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x52, 0x7b, 0x22, 0x61,
+    0x65, 0x72, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22,
+    0x64, 0x65, 0x65, 0x64, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a,
+    0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x74, 0x68, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22,
+    0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b,
+    0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x51,
+    0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x65, 0x65, 0x64, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x51, 0x7b, 0x22, 0x61, 0x64,
+    0x73, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64,
+    0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22,
+    0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x51, 0x7b, 0x22,
+    0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x6e, 0x73, 0x66, 0x65, 0x72, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x66, 0x65, 0x72, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20,
+    0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x51, 0x7b, 0x22, 0x61, 0x64,
+    0x64, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22, 0x32,
+    0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x52, 0x7b, 0x22,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x51,
+    0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x04, 0x64, 0x65, 0x65, 0x64, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64,
+    0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x52,
+    0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22, 0x61, 0x64,
+    0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20,
+    0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x51,
+    0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b,
+    0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22,
+    0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x52, 0x7b,
+    0x73, 0x66, 0x65, 0x72, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a,
+    0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64,
+    0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x52, 0x7b, 0x22, 0x61,
+    0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51,
+    0x65, 0x64, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22,
+    0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b,
+    0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x73, 0x66, 0x65, 0x72, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a,
+    0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x51, 0x7b, 0x22, 0x61,
+    0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61,
+    0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51,
+    0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61,
+    0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64,
+    0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x51,
+    0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22, 0x61,
+    0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x51, 0x7b, 0x22, 0x61,
+    0x64, 0x65, 0x65, 0x64, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a,
+    0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22,
+    0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x65, 0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22,
+    0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x74, 0x68, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22,
+    0x73, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x51, 0x7b,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x51, 0x7b,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22, 0x61,
+    0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65,
+    0x65, 0x72, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22,
+    0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x61, 0x6c, 0x74, 0x68, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x51, 0x7b,
+    0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b,
+    0x6e, 0x04, 0x64, 0x65, 0x65, 0x64, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73,
+    0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64,
+    0x65, 0x64, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22,
+    0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b, 0x65,
+    0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74, 0xcd, 0x10,
+    0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74,
+    0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4,
+    0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61,
+    0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65,
+    0x53, 0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61,
+    0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61,
+    0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65,
+    0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74,
+    0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73,
+    0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74, 0xcd,
+    0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65,
+    0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74, 0xcd, 0x10,
+    0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74,
+    0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74, 0xcd, 0x10,
+    0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65,
+    0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65,
+    0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53,
+    0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61,
+    0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53,
+    0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c,
+    0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b,
+    0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74,
+    0x0b, 0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c,
+    0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73,
+    0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74,
+    0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74, 0xcd,
+    0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x04, 0x64, 0x65, 0x65, 0x64,
+    0x53, 0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22,
+    0x05, 0x73, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74, 0xcd, 0x10,
+    0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c,
+    0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73,
+    0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01,
+    0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x05, 0x73, 0x74, 0x61, 0x6b,
+    0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66,
+    0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74,
+    0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61,
+    0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x0c, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63,
+    0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72,
+    0x66, 0x65, 0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x08, 0x74, 0x72, 0x61, 0x6e,
+    0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b,
+    0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74, 0xcd,
+    0x74, 0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a,
+    0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74, 0xcd, 0x10,
+    0x07, 0x64, 0x65, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74,
+    0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22,
+    0x74, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 0x06, 0x77, 0x65, 0x61, 0x6c, 0x74, 0x68,
+    0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4, 0x74,
+    0x63, 0x74, 0x53, 0x74, 0x61, 0x6b, 0x65, 0x09, 0x93, 0x01, 0xa4, 0x74, 0x65, 0x73, 0x74, 0xcd,
+    0x61, 0x6b, 0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20,
+    0x65, 0x52, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22, 0x32,
+    0x74, 0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a,
+    0x61, 0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20,
+    0x6b, 0x65, 0x51, 0x7b, 0x22, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x3a, 0x20, 0x22,
+};
+
+}  // namespace
+
+byte_array::ConstByteArray const &TransactionCompressionDictionary()
+{
+  static byte_array::ConstByteArray const dictionary{TRANSACTION_DICTIONARY,
+                                                     sizeof(TRANSACTION_DICTIONARY)};
+  return dictionary;
+}
+
+}  // namespace muddle
+}  // namespace fetch
@@ -18,6 +18,7 @@
 
 #include "core/service_ids.hpp"
 #include "direct_message_service.hpp"
+#include "muddle/packet_pool.hpp"
 #include "muddle_logging_name.hpp"
 #include "muddle_register.hpp"
 #include "peer_list.hpp"
@@ -38,8 +39,9 @@ ConstByteArray EncodePayload(T const &msg)
   ConstByteArray payload{};
   try
   {
+    // Append sizes the buffer exactly before writing
     serializers::MsgPackSerializer serializer;
-    serializer << msg;
+    serializer.Append(msg);
 
     payload = serializer.data();
   }
@@ -58,7 +60,7 @@ bool ExtractPayload(ConstByteArray const &payload, T &msg)
 
   try
   {
-    serializers::MsgPackSerializer serializer{payload};
+    auto serializer = serializers::MsgPackSerializer::Borrow(payload);
     serializer >> msg;
 
     success = true;
@@ -84,7 +86,7 @@ Router::PacketPtr FormatDirect(Packet::Address const &from, NetworkId const &net
                                uint16_t service, uint16_t channel, T const &msg,
                                bool exchange = false)
 {
-  auto packet = std::make_shared<Packet>(from, network.value());
+  auto packet = CreatePacket(from, network.value());
   packet->SetService(service);
   packet->SetChannel(channel);
   packet->SetDirect(true);
@@ -112,8 +114,7 @@ void DirectMessageService::InitiateConnection(Handle handle)
   FETCH_LOG_TRACE(logging_name_, "Init. Connection (conn: ", handle, ")");
 
   // format the message
-  RoutingMessage msg{};
-  msg.type = RoutingMessage::Type::PING;
+  auto const msg = CreateRoutingMessage(RoutingMessage::Type::PING);
 
   // send the message to the connection
   SendMessageToConnection(handle, msg);
@@ -127,6 +128,7 @@ void DirectMessageService::SignalConnectionLeft(Handle handle)
   {
     if (it->second == handle)
     {
+      router_.ClearPeerCompression(it->first);
       it = reservations_.erase(it);
     }
     else
@@ -136,6 +138,22 @@ void DirectMessageService::SignalConnectionLeft(Handle handle)
   }
 }
 
+/**
+ * Create a routing message, advertising the capabilities of this node to the peer
+ *
+ * @param type The type of the routing message
+ * @return The formatted message
+ */
+RoutingMessage DirectMessageService::CreateRoutingMessage(RoutingMessage::Type type) const
+{
+  RoutingMessage msg{};
+  msg.type          = type;
+  msg.compression   = router_.config_.compression_enabled;
+  msg.dictionary_id = router_.compressor_.dictionary_id();
+
+  return msg;
+}
+
 template <typename T>
 void DirectMessageService::SendMessageToConnection(Handle handle, T const &msg, bool exchange)
 {
@@ -197,11 +215,11 @@ void DirectMessageService::OnRoutingPing(Handle handle, PacketPtr const &packet,
                                          RoutingMessage const &msg)
 {
   FETCH_LOG_TRACE(logging_name_, "OnRoutingPing (conn: ", handle, ")");
-  FETCH_UNUSED(packet);
-  FETCH_UNUSED(msg);
 
-  RoutingMessage response{};
-  response.type = RoutingMessage::Type::PONG;
+  // record the capabilities of the peer
+  router_.SetPeerCompression(packet->GetSender(), msg.compression, msg.dictionary_id);
+
+  auto const response = CreateRoutingMessage(RoutingMessage::Type::PONG);
 
   // keep a record of this identity in the connection data
 
@@ -213,7 +231,9 @@ void DirectMessageService::OnRoutingPong(Handle handle, PacketPtr const &packet,
                                          RoutingMessage const &msg)
 {
   FETCH_LOG_TRACE(logging_name_, "OnRoutingPong (conn: ", handle, ")");
-  FETCH_UNUSED(msg);
+
+  // record the capabilities of the peer
+  router_.SetPeerCompression(packet->GetSender(), msg.compression, msg.dictionary_id);
 
   // determine if we have not routed to this connection yet
   Handle     previous_handle{0};
@@ -221,8 +241,7 @@ void DirectMessageService::OnRoutingPong(Handle handle, PacketPtr const &packet,
   if (UpdateStatus::ADDED == status)
   {
     // format the message
-    RoutingMessage response{};
-    response.type = RoutingMessage::Type::ROUTING_REQUEST;
+    auto const response = CreateRoutingMessage(RoutingMessage::Type::ROUTING_REQUEST);
 
     // send the message to the connection
     SendMessageToConnection(handle, response);
@@ -230,10 +249,9 @@ void DirectMessageService::OnRoutingPong(Handle handle, PacketPtr const &packet,
   else if (UpdateStatus::REPLACED == status)
   {
     // format the message
-    RoutingMessage response{};
+    auto const response = CreateRoutingMessage(RoutingMessage::Type::ROUTING_REQUEST);
 
     // send the connection request
-    response.type = RoutingMessage::Type::ROUTING_REQUEST;
     SendMessageToConnection(handle, response);
   }
   else
@@ -251,8 +269,7 @@ void DirectMessageService::OnRoutingRequest(Handle handle, PacketPtr const &pack
   FETCH_UNUSED(msg);
   FETCH_LOG_TRACE(logging_name_, "OnRoutingRequest (conn: ", handle, ")");
 
-  RoutingMessage response{};
-  response.type = RoutingMessage::Type::DISCONNECT_REQUEST;
+  auto response = CreateRoutingMessage(RoutingMessage::Type::DISCONNECT_REQUEST);
 
   Handle     previous_handle{0};
   auto const status = UpdateReservation(packet->GetSender(), handle, &previous_handle);
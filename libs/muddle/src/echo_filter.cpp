@@ -0,0 +1,316 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "echo_filter.hpp"
+
+#include <algorithm>
+
+namespace fetch {
+namespace muddle {
+namespace {
+
+std::size_t RoundUpToPowerOfTwo(std::size_t value)
+{
+  std::size_t result{1};
+  while (result < value)
+  {
+    result <<= 1u;
+  }
+
+  return result;
+}
+
+std::size_t ToNumBuckets(std::size_t num_buckets)
+{
+  // at least one previous bucket is needed for the ids to outlive the current period
+  return std::max<std::size_t>(num_buckets, 2);
+}
+
+constexpr uint64_t ToKey(uint64_t id)
+{
+  // zero is reserved to mark the empty slots
+  return (id == 0) ? ~uint64_t{0} : id;
+}
+
+}  // namespace
+
+constexpr std::size_t EchoFilter::MAX_PROBES;
+constexpr int64_t     EchoFilter::INVALID_EPOCH;
+constexpr uint64_t    EchoFilter::EMPTY;
+
+/**
+ * Construct the echo filter
+ *
+ * @param capacity The total number of ids which can be stored (across all buckets)
+ * @param num_buckets The number of time buckets (at least 2)
+ * @param lifetime The minimum time for which an id is remembered
+ */
+EchoFilter::EchoFilter(std::size_t capacity, std::size_t num_buckets, Duration lifetime)
+  : slots_per_bucket_{RoundUpToPowerOfTwo(
+        std::max<std::size_t>(capacity / ToNumBuckets(num_buckets), MAX_PROBES))}
+  , mask_{slots_per_bucket_ - 1}
+  , period_{std::max<Duration>(lifetime / static_cast<int64_t>(ToNumBuckets(num_buckets) - 1),
+                               Duration{1})}
+  , buckets_(ToNumBuckets(num_buckets))
+{
+  for (auto &bucket : buckets_)
+  {
+    bucket.slots = Slots{new Slot[slots_per_bucket_]};
+    for (std::size_t i = 0; i < slots_per_bucket_; ++i)
+    {
+      bucket.slots[i].store(EMPTY, std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * Check to see if an id has been seen before
+ *
+ * @param id The id to check
+ * @param register_echo Signal if the id should be registered (if not already present)
+ * @return The result of the check
+ */
+EchoFilter::Result EchoFilter::Check(uint64_t id, bool register_echo)
+{
+  return Check(id, Clock::now(), register_echo);
+}
+
+/**
+ * Check to see if an id has been seen before
+ *
+ * @param id The id to check
+ * @param now The current time
+ * @param register_echo Signal if the id should be registered (if not already present)
+ * @return The result of the check
+ */
+EchoFilter::Result EchoFilter::Check(uint64_t id, Timepoint const &now, bool register_echo)
+{
+  uint64_t const key   = ToKey(id);
+  int64_t const  epoch = ToEpoch(now);
+
+  // look up the id in the previous time buckets
+  for (auto const &bucket : buckets_)
+  {
+    if (IsLive(bucket, epoch) && Contains(bucket, key))
+    {
+      return Result::DUPLICATE;
+    }
+  }
+
+  if (!register_echo)
+  {
+    return Result::UNIQUE;
+  }
+
+  return Insert(Claim(epoch), key);
+}
+
+/**
+ * Start the bucket for the current time period (if this has not already been done) so that the
+ * clearing of expired entries does not happen on the packet path.
+ *
+ * @param now The current time
+ * @return The number of entries that have expired since the last call
+ */
+std::size_t EchoFilter::Expire(Timepoint const &now)
+{
+  Claim(ToEpoch(now));
+
+  return static_cast<std::size_t>(expired_.exchange(0));
+}
+
+/**
+ * Get the contents of the filter, the time for each of the entries is the start of the time
+ * period in which it was registered
+ *
+ * @param now The current time
+ * @return The map of ids to time
+ */
+EchoFilter::Entries EchoFilter::entries(Timepoint const &now) const
+{
+  int64_t const epoch = ToEpoch(now);
+
+  Entries entries{};
+  for (auto const &bucket : buckets_)
+  {
+    int64_t const bucket_epoch = bucket.epoch.load();
+    if (!IsLive(bucket, epoch))
+    {
+      continue;
+    }
+
+    Timepoint const timestamp = origin_ + (period_ * bucket_epoch);
+    for (std::size_t i = 0; i < slots_per_bucket_; ++i)
+    {
+      uint64_t const key = bucket.slots[i].load(std::memory_order_relaxed);
+      if (key != EMPTY)
+      {
+        entries.emplace(static_cast<std::size_t>(key), timestamp);
+      }
+    }
+  }
+
+  return entries;
+}
+
+/**
+ * Get the total number of ids the filter is able to store
+ *
+ * @return The capacity
+ */
+std::size_t EchoFilter::capacity() const
+{
+  return slots_per_bucket_ * buckets_.size();
+}
+
+/**
+ * Get the number of ids currently stored in the filter
+ *
+ * @param now The current time
+ * @return The number of stored ids
+ */
+std::size_t EchoFilter::size(Timepoint const &now) const
+{
+  int64_t const epoch = ToEpoch(now);
+
+  std::size_t count{0};
+  for (auto const &bucket : buckets_)
+  {
+    if (IsLive(bucket, epoch))
+    {
+      for (std::size_t i = 0; i < slots_per_bucket_; ++i)
+      {
+        if (bucket.slots[i].load(std::memory_order_relaxed) != EMPTY)
+        {
+          ++count;
+        }
+      }
+    }
+  }
+
+  return count;
+}
+
+int64_t EchoFilter::ToEpoch(Timepoint const &now) const
+{
+  return std::max<int64_t>((now - origin_) / period_, 0);
+}
+
+bool EchoFilter::IsLive(Bucket const &bucket, int64_t epoch) const
+{
+  int64_t const bucket_epoch = bucket.epoch.load();
+  int64_t const oldest       = epoch - static_cast<int64_t>(buckets_.size()) + 1;
+
+  return (bucket_epoch != INVALID_EPOCH) && (bucket_epoch >= oldest) && (bucket_epoch <= epoch);
+}
+
+/**
+ * Get the bucket for the specified epoch, clearing and reusing the expired bucket on the first
+ * access in a new time period
+ *
+ * @param epoch The current epoch
+ * @return The bucket for the epoch
+ */
+EchoFilter::Bucket &EchoFilter::Claim(int64_t epoch)
+{
+  auto &bucket = buckets_[static_cast<std::size_t>(epoch) % buckets_.size()];
+
+  int64_t current = bucket.epoch.load();
+  while (current < epoch)
+  {
+    if (bucket.epoch.compare_exchange_weak(current, epoch))
+    {
+      // only the thread which advanced the epoch clears the old contents
+      expired_ += Clear(bucket);
+      break;
+    }
+  }
+
+  return bucket;
+}
+
+bool EchoFilter::Contains(Bucket const &bucket, uint64_t key) const
+{
+  for (std::size_t probe = 0; probe < MAX_PROBES; ++probe)
+  {
+    uint64_t const value = bucket.slots[(key + probe) & mask_].load(std::memory_order_acquire);
+
+    if (value == key)
+    {
+      return true;
+    }
+
+    // slots are never emptied within a period, so an empty slot is the end of the probe sequence
+    if (value == EMPTY)
+    {
+      break;
+    }
+  }
+
+  return false;
+}
+
+EchoFilter::Result EchoFilter::Insert(Bucket &bucket, uint64_t key)
+{
+  for (std::size_t probe = 0; probe < MAX_PROBES; ++probe)
+  {
+    auto &slot = bucket.slots[(key + probe) & mask_];
+
+    uint64_t expected = slot.load(std::memory_order_acquire);
+    if (expected == key)
+    {
+      return Result::DUPLICATE;
+    }
+
+    if (expected == EMPTY)
+    {
+      if (slot.compare_exchange_strong(expected, key, std::memory_order_acq_rel))
+      {
+        return Result::UNIQUE;
+      }
+
+      // another thread has claimed the slot first, it might have been with the same id
+      if (expected == key)
+      {
+        return Result::DUPLICATE;
+      }
+    }
+  }
+
+  // the probe sequence is full, replace the first entry
+  bucket.slots[key & mask_].store(key, std::memory_order_release);
+
+  return Result::UNIQUE_EVICTED;
+}
+
+uint64_t EchoFilter::Clear(Bucket &bucket)
+{
+  uint64_t removed{0};
+  for (std::size_t i = 0; i < slots_per_bucket_; ++i)
+  {
+    if (bucket.slots[i].exchange(EMPTY, std::memory_order_relaxed) != EMPTY)
+    {
+      ++removed;
+    }
+  }
+
+  return removed;
+}
+
+}  // namespace muddle
+}  // namespace fetch
@@ -0,0 +1,321 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "erasure_coder.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace fetch {
+namespace muddle {
+namespace {
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+
+/**
+ * Arithmetic in GF(2^8) with the reducing polynomial x^8 + x^4 + x^3 + x^2 + 1 (0x11D)
+ */
+class GaloisField
+{
+public:
+  GaloisField()
+  {
+    uint32_t value{1};
+    for (std::size_t i = 0; i < 255; ++i)
+    {
+      exp_[i]       = static_cast<uint8_t>(value);
+      exp_[i + 255] = static_cast<uint8_t>(value);
+      log_[value]   = static_cast<uint8_t>(i);
+
+      value <<= 1u;
+      if (value & 0x100u)
+      {
+        value ^= 0x11Du;
+      }
+    }
+  }
+
+  uint8_t Multiply(uint8_t a, uint8_t b) const
+  {
+    if ((a == 0) || (b == 0))
+    {
+      return 0;
+    }
+
+    return exp_[static_cast<std::size_t>(log_[a]) + log_[b]];
+  }
+
+  uint8_t Inverse(uint8_t a) const
+  {
+    // zero has no inverse, callers guarantee it is never requested
+    return exp_[255u - log_[a]];
+  }
+
+  uint8_t Power(uint8_t a, std::size_t exponent) const
+  {
+    if (exponent == 0)
+    {
+      return 1;
+    }
+
+    if (a == 0)
+    {
+      return 0;
+    }
+
+    return exp_[(static_cast<std::size_t>(log_[a]) * exponent) % 255u];
+  }
+
+  /// dst[i] ^= coefficient * src[i]
+  void MultiplyAdd(uint8_t *dst, uint8_t const *src, std::size_t size, uint8_t coefficient) const
+  {
+    if (coefficient == 0)
+    {
+      return;
+    }
+
+    std::size_t const log_coefficient = log_[coefficient];
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      if (src[i] != 0)
+      {
+        dst[i] ^= exp_[log_coefficient + log_[src[i]]];
+      }
+    }
+  }
+
+private:
+  std::array<uint8_t, 510> exp_{};
+  std::array<uint8_t, 256> log_{};
+};
+
+GaloisField const &Field()
+{
+  static GaloisField const field{};
+  return field;
+}
+
+/// The point at which the polynomial is evaluated to form a fragment
+uint8_t EvaluationPoint(std::size_t index)
+{
+  return static_cast<uint8_t>(index + 1);
+}
+
+}  // namespace
+
+constexpr std::size_t ErasureCoder::MAX_FRAGMENTS;
+
+/**
+ * Construct the coder
+ *
+ * @param num_data The number of fragments required to recover a message
+ * @param num_fragments The total number of fragments generated for each message
+ */
+ErasureCoder::ErasureCoder(std::size_t num_data, std::size_t num_fragments)
+  : num_data_{std::max<std::size_t>(std::min(num_data, num_fragments), 1)}
+  , num_fragments_{std::max(std::min(num_fragments, MAX_FRAGMENTS), num_data_)}
+{}
+
+/**
+ * Split a message into fragments
+ *
+ * @param message The message to be encoded
+ * @return The fragments, in position order
+ */
+ErasureCoder::Fragments ErasureCoder::Encode(ConstByteArray const &message) const
+{
+  auto const &      field         = Field();
+  std::size_t const fragment_size = FragmentSize(message.size());
+
+  // pad the message so that it can be split into equal pieces
+  ByteArray padded{};
+  padded.Resize(fragment_size * num_data_);
+  std::memset(padded.pointer(), 0, padded.size());
+  if (!message.empty())
+  {
+    std::memcpy(padded.pointer(), message.pointer(), message.size());
+  }
+
+  Fragments fragments{};
+  fragments.reserve(num_fragments_);
+
+  for (std::size_t index = 0; index < num_fragments_; ++index)
+  {
+    uint8_t const x = EvaluationPoint(index);
+
+    ByteArray fragment{};
+    fragment.Resize(fragment_size);
+    std::memset(fragment.pointer(), 0, fragment.size());
+
+    for (std::size_t piece = 0; piece < num_data_; ++piece)
+    {
+      field.MultiplyAdd(fragment.pointer(), padded.pointer() + (piece * fragment_size),
+                        fragment_size, field.Power(x, piece));
+    }
+
+    fragments.emplace_back(fragment);
+  }
+
+  return fragments;
+}
+
+/**
+ * Recover a message from a set of its fragments
+ *
+ * @param fragments The available fragments (at least num_data are required)
+ * @param message_size The size of the original message
+ * @param message The output message
+ * @return true if successful, otherwise false
+ */
+bool ErasureCoder::Decode(FragmentMap const &fragments, std::size_t message_size,
+                          ConstByteArray &message) const
+{
+  auto const &      field         = Field();
+  std::size_t const fragment_size = FragmentSize(message_size);
+
+  // select the first num_data well formed fragments
+  std::vector<uint32_t>               indices{};
+  std::vector<ConstByteArray const *> selected{};
+  for (auto const &element : fragments)
+  {
+    if ((element.first < num_fragments_) && (element.second.size() == fragment_size))
+    {
+      indices.push_back(element.first);
+      selected.push_back(&element.second);
+    }
+
+    if (selected.size() == num_data_)
+    {
+      break;
+    }
+  }
+
+  if (selected.size() < num_data_)
+  {
+    return false;
+  }
+
+  // build the Vandermonde matrix of the selected points alongside the identity matrix and invert
+  // it by Gauss-Jordan elimination
+  std::size_t const    n = num_data_;
+  std::vector<uint8_t> matrix(n * n);
+  std::vector<uint8_t> inverse(n * n, 0);
+  for (std::size_t row = 0; row < n; ++row)
+  {
+    uint8_t const x = EvaluationPoint(indices[row]);
+    for (std::size_t column = 0; column < n; ++column)
+    {
+      matrix[(row * n) + column] = field.Power(x, column);
+    }
+
+    inverse[(row * n) + row] = 1;
+  }
+
+  for (std::size_t column = 0; column < n; ++column)
+  {
+    // find a pivot, the matrix is always invertible since the evaluation points are distinct
+    std::size_t pivot = column;
+    while ((pivot < n) && (matrix[(pivot * n) + column] == 0))
+    {
+      ++pivot;
+    }
+
+    if (pivot == n)
+    {
+      return false;
+    }
+
+    if (pivot != column)
+    {
+      std::swap_ranges(matrix.begin() + static_cast<std::ptrdiff_t>(pivot * n),
+                       matrix.begin() + static_cast<std::ptrdiff_t>((pivot + 1) * n),
+                       matrix.begin() + static_cast<std::ptrdiff_t>(column * n));
+      std::swap_ranges(inverse.begin() + static_cast<std::ptrdiff_t>(pivot * n),
+                       inverse.begin() + static_cast<std::ptrdiff_t>((pivot + 1) * n),
+                       inverse.begin() + static_cast<std::ptrdiff_t>(column * n));
+    }
+
+    // normalise the pivot row
+    uint8_t const scale = field.Inverse(matrix[(column * n) + column]);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      matrix[(column * n) + i]  = field.Multiply(matrix[(column * n) + i], scale);
+      inverse[(column * n) + i] = field.Multiply(inverse[(column * n) + i], scale);
+    }
+
+    // eliminate the column from all the other rows
+    for (std::size_t row = 0; row < n; ++row)
+    {
+      uint8_t const factor = matrix[(row * n) + column];
+      if ((row == column) || (factor == 0))
+      {
+        continue;
+      }
+
+      field.MultiplyAdd(&matrix[row * n], &matrix[column * n], n, factor);
+      field.MultiplyAdd(&inverse[row * n], &inverse[column * n], n, factor);
+    }
+  }
+
+  // each piece of the message is a linear combination of the selected fragments
+  ByteArray output{};
+  output.Resize(fragment_size * n);
+  std::memset(output.pointer(), 0, output.size());
+
+  for (std::size_t piece = 0; piece < n; ++piece)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      field.MultiplyAdd(output.pointer() + (piece * fragment_size), selected[i]->pointer(),
+                        fragment_size, inverse[(piece * n) + i]);
+    }
+  }
+
+  output.Resize(message_size);
+  message = output;
+
+  return true;
+}
+
+std::size_t ErasureCoder::num_data() const
+{
+  return num_data_;
+}
+
+std::size_t ErasureCoder::num_fragments() const
+{
+  return num_fragments_;
+}
+
+/**
+ * Get the size of each fragment of a message
+ *
+ * @param message_size The size of the message
+ * @return The fragment size in bytes
+ */
+std::size_t ErasureCoder::FragmentSize(std::size_t message_size) const
+{
+  return std::max<std::size_t>((message_size + num_data_ - 1) / num_data_, 1);
+}
+
+}  // namespace muddle
+}  // namespace fetch
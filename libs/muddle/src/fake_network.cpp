@@ -18,12 +18,16 @@
 
 #include "fake_network.hpp"
 
+#include <algorithm>
+#include <random>
+
 using fetch::muddle::FakeNetwork;
 using Addresses = fetch::muddle::FakeNetwork::Addresses;
 
 // Statics required for fake network
 std::mutex                   FakeNetwork::network_lock_{};
 FakeNetwork::FakeNetworkImpl FakeNetwork::network_{};
+std::atomic<uint64_t>        FakeNetwork::loss_threshold_{0};
 
 Addresses FakeNetwork::GetConnections(Address const &of)
 {
@@ -90,7 +94,7 @@ void FakeNetwork::DeployPacket(Address const &to, PacketPtr packet)
   }
 
   // Note access without global lock for performance
-  if (queue)
+  if (queue && !IsLost())
   {
     queue->Push(std::move(packet));
   }
@@ -113,7 +117,10 @@ void FakeNetwork::BroadcastPacket(PacketPtr const &packet)
 
   for (auto const &location : locations)
   {
-    location->Push(packet);
+    if (!IsLost())
+    {
+      location->Push(packet);
+    }
   }
 }
 
@@ -137,6 +144,24 @@ bool FakeNetwork::GetNextPacket(Address const &to, PacketPtr &packet)
   return false;
 }
 
+void FakeNetwork::SetPacketLoss(double probability)
+{
+  auto const clamped = std::min(1.0, std::max(0.0, probability));
+  loss_threshold_    = static_cast<uint64_t>(clamped * static_cast<double>(1ull << 32u));
+}
+
+bool FakeNetwork::IsLost()
+{
+  auto const threshold = loss_threshold_.load();
+  if (threshold == 0)
+  {
+    return false;
+  }
+
+  thread_local std::mt19937 rng{std::random_device{}()};
+  return static_cast<uint64_t>(rng()) < threshold;
+}
+
 // Methods for the packet holding struct
 using fetch::muddle::PacketQueueAndConnections;
 
@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "kademlia/lookup.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Construct a lookup
+ *
+ * @param target The address being looked up
+ * @param own_address Our own address, which is never queried
+ * @param parallelism The maximum number of concurrent queries
+ * @param max_candidates The number of closest candidates which are tracked
+ */
+KademliaLookup::KademliaLookup(Address target, Address own_address, std::size_t parallelism,
+                               std::size_t max_candidates)
+  : target_{std::move(target)}
+  , target_kad_address_{KademliaAddress::Create(target_)}
+  , own_address_{std::move(own_address)}
+  , parallelism_{std::max<std::size_t>(parallelism, 1)}
+  , max_candidates_{std::max<std::size_t>(max_candidates, 1)}
+{}
+
+/**
+ * Add peers which might be able to resolve the target
+ *
+ * @param peers The peers to be considered
+ */
+void KademliaLookup::AddCandidates(Peers const &peers)
+{
+  for (auto const &peer : peers)
+  {
+    AddCandidate(peer.address);
+  }
+}
+
+/**
+ * Select the next peer to be queried
+ *
+ * @param peer The output peer
+ * @return true if a query should be made, false if none is required at this point
+ */
+bool KademliaLookup::NextQuery(Address &peer)
+{
+  if (found_ || (in_flight_.size() >= parallelism_))
+  {
+    return false;
+  }
+
+  for (auto const &candidate : candidates_)
+  {
+    if (queried_.find(candidate.address) == queried_.end())
+    {
+      queried_.insert(candidate.address);
+      in_flight_.insert(candidate.address);
+
+      peer = candidate.address;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Process the response to a query
+ *
+ * @param peer The peer which was queried
+ * @param peers The peers that it returned
+ */
+void KademliaLookup::OnResponse(Address const &peer, Peers const &peers)
+{
+  in_flight_.erase(peer);
+  AddCandidates(peers);
+}
+
+/**
+ * Process a failed query, the peer is dropped from the candidates
+ *
+ * @param peer The peer which was queried
+ */
+void KademliaLookup::OnFailure(Address const &peer)
+{
+  in_flight_.erase(peer);
+
+  candidates_.erase(std::remove_if(candidates_.begin(), candidates_.end(),
+                                   [&peer](Candidate const &c) { return c.address == peer; }),
+                    candidates_.end());
+}
+
+bool KademliaLookup::IsComplete() const
+{
+  if (found_)
+  {
+    return true;
+  }
+
+  if (!in_flight_.empty())
+  {
+    return false;
+  }
+
+  // complete once every one of the closest candidates has been queried
+  return std::all_of(candidates_.begin(), candidates_.end(), [this](Candidate const &c) {
+    return queried_.find(c.address) != queried_.end();
+  });
+}
+
+bool KademliaLookup::found() const
+{
+  return found_;
+}
+
+KademliaLookup::Address const &KademliaLookup::target() const
+{
+  return target_;
+}
+
+std::size_t KademliaLookup::num_in_flight() const
+{
+  return in_flight_.size();
+}
+
+std::size_t KademliaLookup::num_queried() const
+{
+  return queried_.size();
+}
+
+/**
+ * Internal: Insert a candidate into the ordered list, keeping only the closest
+ *
+ * @param address The address of the candidate
+ */
+void KademliaLookup::AddCandidate(Address const &address)
+{
+  if (address == target_)
+  {
+    found_ = true;
+    return;
+  }
+
+  if (address.empty() || (address == own_address_))
+  {
+    return;
+  }
+
+  Candidate candidate{};
+  candidate.distance = GetKademliaDistance(target_kad_address_, KademliaAddress::Create(address));
+  candidate.address  = address;
+
+  auto it = std::lower_bound(
+      candidates_.begin(), candidates_.end(), candidate,
+      [](Candidate const &a, Candidate const &b) { return a.distance < b.distance; });
+
+  // ignore duplicates, the distance uniquely identifies the address
+  if ((it != candidates_.end()) && (it->address == address))
+  {
+    return;
+  }
+
+  if (static_cast<std::size_t>(it - candidates_.begin()) >= max_candidates_)
+  {
+    return;
+  }
+
+  candidates_.insert(it, std::move(candidate));
+
+  if (candidates_.size() > max_candidates_)
+  {
+    candidates_.pop_back();
+  }
+}
+
+}  // namespace muddle
+}  // namespace fetch
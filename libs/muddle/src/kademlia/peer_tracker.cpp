@@ -37,6 +37,8 @@ std::string GenerateLoggingName(NetworkId const &network_id)
 
 }  // namespace
 
+constexpr std::size_t PeerTracker::MAX_ROUTE_CACHE_SIZE;
+
 PeerTracker::PeerTrackerPtr PeerTracker::New(PeerTracker::Duration const &interval,
                                              core::Reactor &reactor, MuddleRegister const &reg,
                                              PeerConnectionList &connections,
@@ -143,6 +145,8 @@ void PeerTracker::RemoveConnectionHandle(ConnectionHandle handle)
   FETCH_LOCK(direct_mutex_);
   auto address = register_.GetAddress(handle);
   directly_connected_peers_.erase(address);
+  directly_connected_kad_.erase(address);
+  route_cache_.clear();
 }
 
 void PeerTracker::DownloadPeerDetails(Handle handle, Address const &address)
@@ -309,7 +313,9 @@ void PeerTracker::ConnectToPeers(AddressSet &                  connections_made,
 
       FETCH_LOG_DEBUG(logging_name_.c_str(), "Connecting to prioritised peer ", uri.ToString(),
                       " with address ", p.address.ToBase64());
-      connections_.AddPersistentPeer(uri);
+
+      // the priority orders the connection attempts when many peers are to be connected at once
+      connections_.AddPersistentPeer(uri, p.priority);
     }
 
     // Keeping track of what we have connected to.
@@ -576,6 +582,12 @@ std::size_t PeerTracker::active_buckets() const
   return peer_table_.active_buckets();
 }
 
+std::size_t PeerTracker::active_lookups() const
+{
+  FETCH_LOCK(lookup_mutex_);
+  return lookups_.size();
+}
+
 PeerTracker::AddressSet PeerTracker::desired_peers() const
 {
   return peer_table_.desired_peers();
@@ -660,6 +672,198 @@ void PeerTracker::OnResolvedPull(uint64_t pull_id, Address const &peer, Address
   }
 }
 
+/**
+ * Internal: Ensure that an iterative lookup is running for a desired peer whose details are not
+ * known
+ *
+ * @param address The address of the peer
+ * @return true if the lookup is in progress, false if it is not possible or has recently failed
+ */
+bool PeerTracker::UpdateLookup(Address const &address)
+{
+  auto const cfg = tracker_configuration();
+
+  {
+    FETCH_LOCK(lookup_mutex_);
+    if (lookups_.find(address) != lookups_.end())
+    {
+      return true;
+    }
+
+    auto const it = lookup_failures_.find(address);
+    if ((it != lookup_failures_.end()) && ((Clock::now() - it->second) < cfg.lookup_retry_interval))
+    {
+      return false;
+    }
+
+    if (lookups_.size() >= cfg.max_lookups)
+    {
+      return false;
+    }
+  }
+
+  // Seeding the lookup with the closest known peers
+  KademliaLookup lookup{address, own_address(), cfg.lookup_parallelism, cfg.kademlia_bucket_size};
+  lookup.AddCandidates(peer_table_.FindPeer(address));
+
+  if (lookup.IsComplete() && !lookup.found())
+  {
+    FETCH_LOCK(lookup_mutex_);
+    lookup_failures_[address] = Clock::now();
+    return false;
+  }
+
+  {
+    FETCH_LOCK(lookup_mutex_);
+    lookups_.emplace(address, std::move(lookup));
+  }
+
+  IssueLookupQueries(address);
+
+  return true;
+}
+
+/**
+ * Internal: Make as many of the queries for a lookup as it allows, completing the lookup if no
+ * further queries can be made
+ *
+ * @param target The address being looked up
+ */
+void PeerTracker::IssueLookupQueries(Address const &target)
+{
+  auto const cfg = tracker_configuration();
+
+  std::vector<Address> queries{};
+  {
+    FETCH_LOCK(lookup_mutex_);
+    auto it = lookups_.find(target);
+    if (it == lookups_.end())
+    {
+      return;
+    }
+
+    auto &  lookup = it->second;
+    Address peer{};
+    while (lookup.NextQuery(peer))
+    {
+      queries.push_back(peer);
+    }
+
+    if (lookup.IsComplete())
+    {
+      if (lookup.found())
+      {
+        FETCH_LOG_DEBUG(logging_name_.c_str(), "Resolved peer ", target.ToBase64(), " after ",
+                        lookup.num_queried(), " queries");
+        lookup_failures_.erase(target);
+      }
+      else
+      {
+        FETCH_LOG_DEBUG(logging_name_.c_str(), "Unable to resolve peer ", target.ToBase64());
+        lookup_failures_[target] = Clock::now();
+      }
+
+      lookups_.erase(it);
+    }
+  }
+
+  for (auto const &peer : queries)
+  {
+    auto query_id = pull_next_id_++;
+
+    // make the call to the remote service
+    // It is important that no lock is held when this is called
+    auto promise = rpc_client_.CallSpecificAddress(peer, RPC_MUDDLE_KADEMLIA,
+                                                   PeerTrackerProtocol::FIND_PEERS, target);
+
+    auto weakptr   = weak_self_;
+    auto call_task = std::make_shared<PromiseTask>(
+        promise, cfg.promise_timeout,
+        [weakptr, peer, target, query_id](service::Promise const &promise) {
+          auto ptr = weakptr.lock();
+          if (ptr)
+          {
+            ptr->OnResolvedLookup(query_id, peer, target, promise);
+          }
+        });
+
+    reactor_.Attach(call_task);
+
+    {
+      FETCH_LOCK(lookup_mutex_);
+      lookup_promises_.emplace(query_id, std::move(call_task));
+    }
+  }
+}
+
+void PeerTracker::OnResolvedLookup(uint64_t query_id, Address const &peer, Address const &target,
+                                   service::Promise const &promise)
+{
+  if (stopping_)
+  {
+    return;
+  }
+
+  bool const success = promise->state() == service::PromiseState::SUCCESS;
+
+  Peers peers{};
+  if (success)
+  {
+    peer_table_.ReportLiveliness(peer, own_address());
+    promise->GetResult(peers);
+
+    // reporting the possible existence of the returned peers
+    for (auto const &peer_info : peers)
+    {
+      if (!peer_info.address.empty())
+      {
+        peer_table_.ReportExistence(peer_info, peer);
+      }
+    }
+  }
+
+  {
+    FETCH_LOCK(lookup_mutex_);
+    lookup_promises_.erase(query_id);
+
+    auto it = lookups_.find(target);
+    if (it != lookups_.end())
+    {
+      if (success)
+      {
+        it->second.OnResponse(peer, peers);
+      }
+      else
+      {
+        it->second.OnFailure(peer);
+      }
+    }
+  }
+
+  // continue the lookup straight away rather than waiting for the next maintenance cycle
+  IssueLookupQueries(target);
+}
+
+/**
+ * Internal: Update the set of directly connected peers
+ *
+ * @param peers The directly connected peers
+ */
+void PeerTracker::UpdateDirectlyConnectedPeers(AddressSet peers)
+{
+  // hashing the addresses before the lock is taken
+  KademliaAddressMap kad_addresses{};
+  for (auto const &peer : peers)
+  {
+    kad_addresses.emplace(peer, KademliaAddress::Create(peer));
+  }
+
+  FETCH_LOCK(direct_mutex_);
+  std::swap(directly_connected_peers_, peers);
+  std::swap(directly_connected_kad_, kad_addresses);
+  route_cache_.clear();
+}
+
 void PeerTracker::ConnectToDesiredPeers()
 {
   auto const currently_outgoing = register_.GetOutgoingAddressSet();
@@ -699,6 +903,13 @@ void PeerTracker::ConnectToDesiredPeers()
     }
     else
     {
+      // Resolving the peer with an iterative lookup. Connecting to the closest known peer (and
+      // pulling from it) is only used when the lookup was unable to find the peer
+      if (UpdateLookup(peer))
+      {
+        continue;
+      }
+
       // Finding the peers closest to the desirec peer
       auto closest_peers = peer_table_.FindPeer(peer);
 
@@ -937,6 +1148,8 @@ void PeerTracker::Periodically()
     {
       FETCH_LOCK(direct_mutex_);
       directly_connected_peers_.clear();
+      directly_connected_kad_.clear();
+      route_cache_.clear();
     }
 
     auto const currently_outgoing = register_.GetOutgoingAddressSet();
@@ -960,10 +1173,7 @@ void PeerTracker::Periodically()
       }
     }
 
-    {
-      FETCH_LOCK(direct_mutex_);
-      std::swap(directly_connected_peers_, new_directly_connected);
-    }
+    UpdateDirectlyConnectedPeers(std::move(new_directly_connected));
   }
 
   // Dumping the tracker table
@@ -1142,50 +1352,84 @@ PeerTracker::Handle PeerTracker::LookupHandle(Address const &address)
     // TODO(tfr): add liveness reporting
     return connection->handle();
   }
-  // TODO(tfr): Create a cache for the search below
 
-  // Finding best address
-  Address own_copy = own_address();
+  Address const own_copy = own_address();
+
+  // Trying the next hop that was recently resolved for this address
+  Address cached_hop{};
+  {
+    FETCH_LOCK(direct_mutex_);
+    auto const it = route_cache_.find(address);
+    if (it != route_cache_.end())
+    {
+      cached_hop = it->second;
+    }
+  }
+
+  if (!cached_hop.empty())
+  {
+    if (cached_hop == own_copy)
+    {
+      return 0;
+    }
 
-  //    KademliaDistance                    best = MaxKademliaDistance();
+    connection = register_.LookupConnection(cached_hop).lock();
+    if (connection)
+    {
+      return connection->handle();
+    }
+  }
+
+  // Finding best address. The Kademlia addresses of the direct peers are computed when the peers
+  // are updated, so only the target needs to be hashed here
   std::map<KademliaDistance, Address> candidates;
+  auto const target_kad = KademliaAddress::Create(address);
+  auto const own_kad    = peer_table_.own_kademlia_address();
 
   {
     FETCH_LOCK(direct_mutex_);
 
-    // Finding best address
-    auto target_kad = KademliaAddress::Create(address);
-    for (auto &peer : directly_connected_peers_)
+    for (auto const &peer : directly_connected_kad_)
     {
-      KademliaAddress cmp  = KademliaAddress::Create(peer);
-      auto            dist = GetKademliaDistance(target_kad, cmp);
-      candidates[dist]     = peer;
+      candidates.emplace(GetKademliaDistance(target_kad, peer.second), peer.first);
     }
-
-    // Comparing against own address
-    auto own_kad     = KademliaAddress::Create(own_copy);
-    auto dist        = GetKademliaDistance(target_kad, own_kad);
-    candidates[dist] = own_address_;
   }
 
+  // Comparing against own address
+  candidates.emplace(GetKademliaDistance(target_kad, own_kad), own_copy);
+
   for (auto &pair : candidates)
   {
-    if (pair.second == own_copy)
+    Handle handle{0};
+
+    if (pair.second != own_copy)
     {
-      return 0;
+      // Finding handle
+      wptr       = register_.LookupConnection(pair.second);
+      connection = wptr.lock();
+      if (!connection)
+      {
+        continue;
+      }
+
+      // TODO(tfr): Causes deadlock        peer_table_.ReportLiveliness(pair.second, own_address_);
+      handle = connection->handle();
     }
 
-    // Finding handle
-    wptr       = register_.LookupConnection(pair.second);
-    connection = wptr.lock();
-    if (connection)
+    // Remembering the next hop for the following packets
     {
-      // TODO(tfr): add to cache for efficiency
+      FETCH_LOCK(direct_mutex_);
+      if (route_cache_.size() >= MAX_ROUTE_CACHE_SIZE)
+      {
+        route_cache_.clear();
+      }
 
-      // TODO(tfr): Causes deadlock        peer_table_.ReportLiveliness(pair.second, own_address_);
-      return connection->handle();
+      route_cache_[address] = pair.second;
     }
+
+    return handle;
   }
+
   return 0;
 }
 
@@ -1242,6 +1486,8 @@ void PeerTracker::Stop()
     FETCH_LOCK(direct_mutex_);
     keep_connections_.clear();
     directly_connected_peers_.clear();
+    directly_connected_kad_.clear();
+    route_cache_.clear();
   }
   {
     FETCH_LOCK(pull_mutex_);
@@ -1250,6 +1496,12 @@ void PeerTracker::Stop()
     pull_promises_.clear();
     last_pull_from_peer_.clear();
   }
+  {
+    FETCH_LOCK(lookup_mutex_);
+    lookups_.clear();
+    lookup_failures_.clear();
+    lookup_promises_.clear();
+  }
 }
 
 void PeerTracker::Start()
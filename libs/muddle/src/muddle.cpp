@@ -28,6 +28,9 @@
 #include "core/service_ids.hpp"
 #include "kademlia/peer_tracker.hpp"
 #include "logging/logging.hpp"
+#include "muddle/packet_pool.hpp"
+#include "network/shm/shm_connection.hpp"
+#include "network/shm/shm_server.hpp"
 #include "network/tcp/tcp_client.hpp"
 #include "network/tcp/tcp_server.hpp"
 
@@ -46,6 +49,7 @@ namespace muddle {
 static auto const        CLEANUP_INTERVAL           = std::chrono::seconds{10};
 static std::size_t const MAINTENANCE_INTERVAL_MS    = 2500;
 static std::size_t const PEER_SELECTION_INTERVAL_MS = 2500;
+static std::size_t const MAX_PENDING_CONNECTIONS    = 32;
 
 /**
  * Constructs the muddle node instances
@@ -238,6 +242,7 @@ void Muddle::Stop()
   {
     FETCH_LOCK(servers_lock_);
     servers_.clear();
+    shm_servers_.clear();
   }
 
   // client shutdown loop
@@ -592,8 +597,8 @@ void Muddle::RunPeriodicMaintenance()
     // update discovery information
     std::unordered_set<Uri> just_connected_to;
 
-    // connect to all the required peers
-    for (Uri const &peer : clients_.GetPeersToConnectTo())
+    // connect to the required peers, highest priority first and a limited number at a time
+    for (Uri const &peer : clients_.GetPeersToConnectTo(MAX_PENDING_CONNECTIONS))
     {
       // skipping uris we just connected to
       if (just_connected_to.find(peer) != just_connected_to.end())
@@ -652,25 +657,95 @@ void Muddle::CreateTcpServer(uint16_t port)
   // start it listening
   server->Start();
 
+  // peers on the same host find the shared memory server from the port of the TCP server
+  auto shm_server =
+      std::make_shared<MuddleServer<network::ShmServer>>(router_, server->GetListeningPort());
+  shm_server->SetConnectionRegister(
+      std::static_pointer_cast<network::AbstractConnectionRegister>(register_));
+
+  bool const shm_started = shm_server->Start();
+  if (!shm_started)
+  {
+    FETCH_LOG_WARN(logging_name_, "Unable to accept shared memory connections for port ",
+                   server->GetListeningPort());
+  }
+
   FETCH_LOCK(servers_lock_);
   servers_.emplace_back(std::static_pointer_cast<network::AbstractNetworkServer>(server));
+
+  if (shm_started)
+  {
+    shm_servers_.emplace_back(std::static_pointer_cast<network::AbstractNetworkServer>(shm_server));
+  }
 }
 
 /**
- * Create a new TCP client connection to the specified peer
+ * Create a new client connection to the specified peer. Peers on the same host are connected to
+ * over shared memory when they accept it, otherwise over TCP
  *
  * @param peer The peer to connect to
  */
 void Muddle::CreateTcpClient(Uri const &peer)
 {
-  using ClientImpl       = network::TCPClient;
-  using ConnectionRegPtr = std::shared_ptr<network::AbstractConnectionRegister>;
+  using ClientImpl = network::TCPClient;
 
-  ClientImpl client(network_manager_);
-  auto       conn = client.connection_pointer();
+  if (CreateShmClient(peer))
+  {
+    return;
+  }
 
-  auto strong_conn = conn.lock();
+  ClientImpl client(network_manager_);
+  auto       strong_conn = client.connection_pointer().lock();
   assert(strong_conn);
+
+  AddClientConnection(peer, strong_conn);
+
+  auto const &tcp_peer = peer.GetTcpPeer();
+
+  client.Connect(tcp_peer.address(), tcp_peer.port());
+}
+
+/**
+ * Attempt to connect to a peer on the same host over shared memory
+ *
+ * @param peer The peer to connect to
+ * @return true if the connection was made, otherwise TCP should be used
+ */
+bool Muddle::CreateShmClient(Uri const &peer)
+{
+  auto const &tcp_peer = peer.GetTcpPeer();
+
+  if (!IsLocalAddress(tcp_peer.address()) || !network::ShmConnection::IsAvailable(tcp_peer.port()))
+  {
+    return false;
+  }
+
+  auto conn = std::make_shared<network::ShmConnection>();
+  if (!conn->Connect(tcp_peer.port()))
+  {
+    FETCH_LOG_INFO(logging_name_, "Falling back to TCP for connection to ", peer.ToString());
+    return false;
+  }
+
+  AddClientConnection(peer, conn);
+
+  // only now that the handlers are in place are messages read and the connection signalled
+  conn->Start();
+
+  return true;
+}
+
+/**
+ * Register a new outgoing connection and route the packets it receives
+ *
+ * @param peer The peer being connected to
+ * @param strong_conn The connection, which has not been started yet
+ */
+void Muddle::AddClientConnection(Uri const &peer, Client const &strong_conn)
+{
+  using ConnectionRegPtr = std::shared_ptr<network::AbstractConnectionRegister>;
+
+  auto conn        = strong_conn->connection_pointer();
   auto conn_handle = strong_conn->handle();
 
   FETCH_LOG_INFO(logging_name_, "Creating connection to ", peer.ToString(), " (conn: ", conn_handle,
@@ -725,9 +800,9 @@ void Muddle::CreateTcpClient(Uri const &peer)
     {
       try
       {
-        auto packet = std::make_shared<Packet>();
+        auto packet = CreatePacket();
 
-        if (Packet::FromBuffer(*packet, msg.pointer(), msg.size()))
+        if (Packet::FromBuffer(*packet, msg))
         {
           // dispatch the message to router
           router_.Route(conn_handle, packet);
@@ -744,10 +819,15 @@ void Muddle::CreateTcpClient(Uri const &peer)
       }
     }
   });
+}
 
-  auto const &tcp_peer = peer.GetTcpPeer();
-
-  client.Connect(tcp_peer.address(), tcp_peer.port());
+/**
+ * @param address The address of a peer
+ * @return true if the address refers to this host
+ */
+bool Muddle::IsLocalAddress(std::string const &address) const
+{
+  return (address == "127.0.0.1") || (address == "localhost") || (address == external_address_);
 }
 
 }  // namespace muddle
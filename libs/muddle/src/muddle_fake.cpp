@@ -33,5 +33,10 @@ MuddlePtr CreateMuddleFake(char const network[4], ProverPtr certificate,
   return CreateMuddleFake(NetworkId{network}, std::move(certificate), nm, external_address);
 }
 
+void SetFakeNetworkPacketLoss(double probability)
+{
+  FakeNetwork::SetPacketLoss(probability);
+}
+
 }  // namespace muddle
 }  // namespace fetch
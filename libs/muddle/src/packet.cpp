@@ -118,5 +118,49 @@ bool Packet::FromBuffer(Packet &packet, void const *buffer, std::size_t length)
   return true;
 }
 
+/**
+ * Read in a packet from a specified packet buffer without copying. The payload and signature of
+ * the packet reference the memory of the input buffer which is kept alive by the packet.
+ *
+ * @param packet The packet to be populated
+ * @param buffer The input buffer
+ * @return true if successful, otherwise false
+ */
+bool Packet::FromBuffer(Packet &packet, byte_array::ConstByteArray const &buffer)
+{
+  std::size_t const length = buffer.size();
+  if (length < sizeof(packet.header_))
+  {
+    return false;
+  }
+
+  // read the header
+  std::memcpy(&packet.header_, buffer.pointer(), sizeof(packet.header_));
+
+  std::size_t payload_length = length - sizeof(packet.header_);
+  if (packet.IsStamped())
+  {
+    if (payload_length < SIGNATURE_SIZE)
+    {
+      return false;
+    }
+
+    payload_length -= SIGNATURE_SIZE;
+  }
+
+  std::size_t const payload_offset = sizeof(packet.header_);
+
+  // share the payload and signature with the input buffer
+  packet.payload_ = (payload_length != 0u) ? buffer.SubArray(payload_offset, payload_length)
+                                           : byte_array::ConstByteArray{};
+
+  if (packet.IsStamped())
+  {
+    packet.stamp_ = buffer.SubArray(payload_offset + payload_length, SIGNATURE_SIZE);
+  }
+
+  return true;
+}
+
 }  // namespace muddle
 }  // namespace fetch
@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "packet_verifier.hpp"
+
+#include "crypto/sha256.hpp"
+#include "crypto/verifier_cache.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Construct the packet verifier
+ *
+ * @param name The name of the worker thread pool
+ * @param num_threads The number of worker threads
+ * @param batch_size The maximum number of packets verified by a worker in one go
+ */
+PacketVerifier::PacketVerifier(std::string const &name, std::size_t num_threads,
+                               std::size_t batch_size)
+  : batch_size_{std::max<std::size_t>(batch_size, 1)}
+  , thread_pool_{network::MakeThreadPool(std::max<std::size_t>(num_threads, 1), name)}
+{}
+
+PacketVerifier::~PacketVerifier()
+{
+  Stop();
+}
+
+/**
+ * Start the worker threads
+ */
+void PacketVerifier::Start()
+{
+  thread_pool_->Start();
+}
+
+/**
+ * Stop the worker threads. Any packets that have not been verified are discarded
+ */
+void PacketVerifier::Stop()
+{
+  thread_pool_->Stop();
+
+  FETCH_LOCK(lock_);
+  pending_.clear();
+  in_flight_.clear();
+}
+
+/**
+ * Schedule the verification of a packet
+ *
+ * @param packet The packet to be verified
+ * @param callback The callback to be issued with the result of the verification
+ */
+void PacketVerifier::Verify(PacketPtr const &packet, Callback callback)
+{
+  auto job      = std::make_shared<Job>();
+  job->packet   = packet;
+  job->callback = std::move(callback);
+
+  bool schedule{false};
+  {
+    FETCH_LOCK(lock_);
+    pending_.emplace_back(job);
+    in_flight_.emplace_back(std::move(job));
+
+    // each worker drains a batch at a time, add another worker for each new batch of work
+    schedule = ((pending_.size() % batch_size_) == 1) || (batch_size_ == 1);
+  }
+
+  if (schedule)
+  {
+    thread_pool_->Post([this]() { Drain(); });
+  }
+}
+
+/**
+ * Remove the cached verification results older than a specified age
+ *
+ * @param max_age The maximum age of the cached results to keep
+ */
+void PacketVerifier::TrimCache(Duration const &max_age)
+{
+  auto const now = Clock::now();
+
+  FETCH_LOCK(cache_lock_);
+  auto it = cache_.begin();
+  while (it != cache_.end())
+  {
+    if ((now - it->second) > max_age)
+    {
+      it = cache_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+/**
+ * Get the number of cached verification results
+ *
+ * @return The size of the cache
+ */
+std::size_t PacketVerifier::cache_size() const
+{
+  FETCH_LOCK(cache_lock_);
+  return cache_.size();
+}
+
+/**
+ * Worker: Verify batches of the pending packets until there are none left
+ */
+void PacketVerifier::Drain()
+{
+  crypto::VerifierCache verifiers{};
+  std::vector<JobPtr>   batch{};
+
+  for (;;)
+  {
+    batch.clear();
+
+    {
+      FETCH_LOCK(lock_);
+      while (!pending_.empty() && (batch.size() < batch_size_))
+      {
+        batch.emplace_back(std::move(pending_.front()));
+        pending_.pop_front();
+      }
+    }
+
+    if (batch.empty())
+    {
+      break;
+    }
+
+    for (auto &job : batch)
+    {
+      bool const genuine = VerifyPacket(*job->packet, verifiers);
+
+      FETCH_LOCK(lock_);
+      job->genuine  = genuine;
+      job->complete = true;
+    }
+
+    Complete();
+  }
+}
+
+/**
+ * Verify a single packet, consulting the cache of previous results
+ *
+ * @param packet The packet to verify
+ * @param verifiers The verifier cache for the current batch
+ * @return true if the packet is genuine, otherwise false
+ */
+bool PacketVerifier::VerifyPacket(Packet const &packet, crypto::VerifierCache &verifiers)
+{
+  if (!packet.IsStamped())
+  {
+    return false;
+  }
+
+  // the signed data contains the header (and therefore the sender) of the packet
+  auto const signed_data = packet.GetSignedData();
+
+  crypto::SHA256 hasher{};
+  hasher.Update(signed_data);
+  hasher.Update(packet.GetStamp());
+  byte_array::ConstByteArray const digest = hasher.Final();
+
+  {
+    FETCH_LOCK(cache_lock_);
+    auto it = cache_.find(digest);
+    if (it != cache_.end())
+    {
+      it->second = Clock::now();
+      return true;
+    }
+  }
+
+  bool const genuine = verifiers.Verify(crypto::Identity{packet.GetSender()}, signed_data,
+                                        packet.GetStamp());
+
+  if (genuine)
+  {
+    FETCH_LOCK(cache_lock_);
+    if (cache_.size() >= MAX_CACHE_SIZE)
+    {
+      cache_.clear();
+    }
+
+    cache_.emplace(digest, Clock::now());
+  }
+
+  return genuine;
+}
+
+/**
+ * Issue the callbacks for all the completed jobs at the front of the in flight queue
+ */
+void PacketVerifier::Complete()
+{
+  FETCH_LOCK(completion_lock_);
+
+  for (;;)
+  {
+    JobPtr job{};
+
+    {
+      FETCH_LOCK(lock_);
+      if (in_flight_.empty() || !in_flight_.front()->complete)
+      {
+        break;
+      }
+
+      job = std::move(in_flight_.front());
+      in_flight_.pop_front();
+    }
+
+    if (job->callback)
+    {
+      job->callback(job->packet, job->genuine);
+    }
+  }
+}
+
+}  // namespace muddle
+}  // namespace fetch
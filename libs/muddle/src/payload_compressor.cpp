@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "payload_compressor.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/compression/lz4.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace fetch {
+namespace muddle {
+namespace {
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+
+uint64_t CalculateDictionaryId(ConstByteArray const &dictionary)
+{
+  if (dictionary.empty())
+  {
+    return PayloadCompressor::NO_DICTIONARY;
+  }
+
+  auto const digest = crypto::Hash<crypto::SHA256>(dictionary);
+
+  uint64_t id{0};
+  std::memcpy(&id, digest.pointer(), sizeof(id));
+
+  // zero is reserved to signal that no dictionary is present
+  return (id == PayloadCompressor::NO_DICTIONARY) ? 1 : id;
+}
+
+}  // namespace
+
+constexpr uint64_t    PayloadCompressor::NO_DICTIONARY;
+constexpr std::size_t PayloadCompressor::HEADER_SIZE;
+constexpr std::size_t PayloadCompressor::MAX_DECOMPRESSED_SIZE;
+constexpr uint8_t     PayloadCompressor::FLAG_DICTIONARY;
+
+/**
+ * Construct the payload compressor
+ *
+ * @param dictionary The (optional) shared dictionary
+ */
+PayloadCompressor::PayloadCompressor(ConstByteArray dictionary)
+  : dictionary_{std::move(dictionary)}
+  , dictionary_id_{CalculateDictionaryId(dictionary_)}
+{}
+
+/**
+ * Compress a payload
+ *
+ * @param payload The payload to compress
+ * @param use_dictionary Flag to signal that the shared dictionary should be used (if present)
+ * @param compressed The output compressed payload
+ * @return true if the payload was compressed, false if compression would not reduce the size
+ */
+bool PayloadCompressor::Compress(ConstByteArray const &payload, bool use_dictionary,
+                                 ConstByteArray &compressed) const
+{
+  if (payload.size() > MAX_DECOMPRESSED_SIZE)
+  {
+    return false;
+  }
+
+  bool const with_dictionary = use_dictionary && !dictionary_.empty();
+
+  auto const block =
+      compression::LZ4Compress(payload, with_dictionary ? dictionary_ : ConstByteArray{});
+
+  std::size_t const total_size = HEADER_SIZE + block.size();
+  if (total_size >= payload.size())
+  {
+    return false;
+  }
+
+  auto const flags = static_cast<uint8_t>(with_dictionary ? FLAG_DICTIONARY : 0);
+  auto const size  = static_cast<uint32_t>(payload.size());
+
+  ByteArray output{};
+  output.Resize(total_size);
+  output[0] = flags;
+  std::memcpy(output.pointer() + sizeof(flags), &size, sizeof(size));
+  std::memcpy(output.pointer() + HEADER_SIZE, block.pointer(), block.size());
+
+  compressed = output;
+
+  return true;
+}
+
+/**
+ * Decompress a payload
+ *
+ * @param compressed The compressed payload
+ * @param payload The output decompressed payload
+ * @return true if successful, otherwise false
+ */
+bool PayloadCompressor::Decompress(ConstByteArray const &compressed, ConstByteArray &payload) const
+{
+  if (compressed.size() < HEADER_SIZE)
+  {
+    return false;
+  }
+
+  uint8_t const flags = compressed[0];
+
+  uint32_t size{0};
+  std::memcpy(&size, compressed.pointer() + sizeof(flags), sizeof(size));
+
+  // an LZ4 block can not expand by more than a factor of 255, reject impossible sizes before any
+  // memory is allocated for them
+  bool const with_dictionary = (flags & FLAG_DICTIONARY) != 0;
+  bool const valid_size =
+      (size <= MAX_DECOMPRESSED_SIZE) && (size <= ((compressed.size() - HEADER_SIZE) * 255u));
+
+  if ((with_dictionary && dictionary_.empty()) || !valid_size)
+  {
+    return false;
+  }
+
+  ByteArray output{};
+  if (!compression::LZ4Decompress(compressed.SubArray(HEADER_SIZE), size, output,
+                                  with_dictionary ? dictionary_ : ConstByteArray{}))
+  {
+    return false;
+  }
+
+  payload = output;
+
+  return true;
+}
+
+/**
+ * Get the id of the shared dictionary
+ *
+ * @return The dictionary id, or NO_DICTIONARY if one is not present
+ */
+uint64_t PayloadCompressor::dictionary_id() const
+{
+  return dictionary_id_;
+}
+
+}  // namespace muddle
+}  // namespace fetch
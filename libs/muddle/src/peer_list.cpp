@@ -21,20 +21,44 @@
 #include "router.hpp"
 
 #include "logging/logging.hpp"
+#include "muddle/network_id.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/histogram.hpp"
+#include "telemetry/registry.hpp"
 
 #include <algorithm>
 #include <cstddef>
 #include <string>
 #include <utility>
 
-static constexpr std::size_t MAX_LOG2_BACKOFF = 11;  // 2048
+static constexpr std::size_t MAX_LOG2_BACKOFF = 7;  // 128
 static constexpr char const *BASE_NAME        = "MuddlePeers";
 
 namespace fetch {
 namespace muddle {
+namespace {
+
+telemetry::Measurement::Labels CreateLabels(NetworkId const &network)
+{
+  return {{"network", network.ToString()}};
+}
+
+}  // namespace
+
+constexpr double      PeerConnectionList::MAX_PRIORITY;
+constexpr std::size_t PeerConnectionList::UNLIMITED;
 
 PeerConnectionList::PeerConnectionList(NetworkId const &network)
   : name_{GenerateLoggingName(BASE_NAME, network)}
+  , rng_{std::random_device{}()}
+  , time_to_connect_{telemetry::Registry::Instance().CreateHistogram(
+        {0.1, 0.5, 1, 2, 5, 10, 30, 60, 120, 300}, "ledger_muddle_peer_time_to_connect_seconds",
+        "The time between a persistent peer being disconnected (or added) and the connection to it "
+        "being established",
+        CreateLabels(network))}
+  , connection_attempts_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_muddle_connection_attempts_total",
+        "The total number of outgoing connection attempts", CreateLabels(network))}
 {}
 
 void PeerConnectionList::SetStatusCallback(StatusCallback callback)
@@ -42,10 +66,30 @@ void PeerConnectionList::SetStatusCallback(StatusCallback callback)
   status_callback_ = std::move(callback);
 }
 
-bool PeerConnectionList::AddPersistentPeer(Uri const &peer)
+/**
+ * Add a peer which should always be connected to
+ *
+ * @param peer The uri of the peer
+ * @param priority The priority of the connection, the highest priority given is kept
+ * @return true if the peer is new, otherwise false
+ */
+bool PeerConnectionList::AddPersistentPeer(Uri const &peer, double priority)
 {
   FETCH_LOCK(lock_);
-  auto const result = persistent_peers_.emplace(peer);
+  auto const result = persistent_peers_.emplace(peer, priority);
+
+  if (result.second)
+  {
+    if (peer_connections_.find(peer) == peer_connections_.end())
+    {
+      disconnected_since_.emplace(peer, Clock::now());
+    }
+  }
+  else
+  {
+    result.first->second = std::max(result.first->second, priority);
+  }
+
   return result.second;
 }
 
@@ -53,6 +97,7 @@ void PeerConnectionList::RemovePersistentPeer(Uri const &peer)
 {
   FETCH_LOCK(lock_);
   persistent_peers_.erase(peer);
+  disconnected_since_.erase(peer);
 }
 
 void PeerConnectionList::RemovePersistentPeer(Handle handle)
@@ -63,6 +108,7 @@ void PeerConnectionList::RemovePersistentPeer(Handle handle)
     if (peer_connection.second->handle() == handle)
     {
       persistent_peers_.erase(peer_connection.first);
+      disconnected_since_.erase(peer_connection.first);
       break;
     }
   }
@@ -83,6 +129,7 @@ void PeerConnectionList::AddConnection(Uri const &peer, ConnectionPtr const &con
   ++metadata.attempts;
 
   peer_connections_[peer] = conn;
+  connection_attempts_total_->increment();
 }
 
 PeerConnectionList::PeerMap PeerConnectionList::GetCurrentPeers() const
@@ -93,8 +140,15 @@ PeerConnectionList::PeerMap PeerConnectionList::GetCurrentPeers() const
 
 PeerConnectionList::PeerSet PeerConnectionList::GetPersistentPeers() const
 {
+  PeerSet peers;
+
   FETCH_LOCK(lock_);
-  return persistent_peers_;
+  for (auto const &peer : persistent_peers_)
+  {
+    peers.emplace(peer.first);
+  }
+
+  return peers;
 }
 
 bool PeerConnectionList::GetMetadataForPeer(Uri const &peer, PeerMetadata &metadata) const
@@ -153,6 +207,14 @@ void PeerConnectionList::OnConnectionEstablished(Uri const &peer)
     ++metadata.successes;
     metadata.connected            = true;
     metadata.consecutive_failures = 0;
+
+    auto const disconnected = disconnected_since_.find(peer);
+    if (disconnected != disconnected_since_.end())
+    {
+      time_to_connect_->Add(
+          std::chrono::duration<double>(Clock::now() - disconnected->second).count());
+      disconnected_since_.erase(disconnected);
+    }
   }
 
   // send an identity message
@@ -181,6 +243,12 @@ void PeerConnectionList::RemoveConnection(Uri const &peer)
     ++metadata.total_failures;
     metadata.connected              = false;
     metadata.last_failed_connection = Clock::now();
+    metadata.retry_delay            = NextRetryDelay(metadata.consecutive_failures);
+  }
+
+  if (persistent_peers_.find(peer) != persistent_peers_.end())
+  {
+    disconnected_since_.emplace(peer, Clock::now());
   }
 }
 
@@ -198,6 +266,10 @@ void PeerConnectionList::RemoveConnection(Handle handle)
       {
         metadata->second.connected = false;
       }
+      if (persistent_peers_.find(it->first) != persistent_peers_.end())
+      {
+        disconnected_since_.emplace(it->first, Clock::now());
+      }
       peer_connections_.erase(it);
       break;
     }
@@ -212,6 +284,7 @@ void PeerConnectionList::Disconnect(Uri const &peer)
   {
     peer_connections_.erase(peer);
   }
+  disconnected_since_.erase(peer);
 
   FETCH_LOG_DEBUG(logging_name_, "Connection to ", peer.uri(), " shut down");
 }
@@ -221,54 +294,92 @@ void PeerConnectionList::DisconnectAll()
   FETCH_LOCK(lock_);
   peer_connections_.clear();
   persistent_peers_.clear();
+  disconnected_since_.clear();
 }
 
 bool PeerConnectionList::ReadyForRetry(PeerMetadata const &metadata) const
 {
-  std::size_t const log2_backoff = std::min(metadata.consecutive_failures, MAX_LOG2_BACKOFF);
-  Timepoint const   backoff_deadline =
-      metadata.last_failed_connection + std::chrono::seconds{1u << log2_backoff};
-  return (Clock::now() >= backoff_deadline);
+  return (Clock::now() >= metadata.last_failed_connection + metadata.retry_delay);
 }
 
-PeerConnectionList::PeerList PeerConnectionList::GetPeersToConnectTo() const
+/**
+ * Internal: Draw the backoff after a failed connection. The backoff doubles with every consecutive
+ * failure and is randomised over the upper half of its range
+ *
+ * @param consecutive_failures The number of consecutive failed connections
+ * @return The delay before the next connection attempt
+ */
+PeerConnectionList::Duration PeerConnectionList::NextRetryDelay(std::size_t consecutive_failures)
 {
-  PeerList peers;
+  std::size_t const log2_backoff = std::min(consecutive_failures, MAX_LOG2_BACKOFF);
+  Duration const    backoff      = std::chrono::seconds{1u << log2_backoff};
+
+  std::uniform_int_distribution<Duration::rep> jitter{0, backoff.count() / 2};
+  return backoff - Duration{jitter(rng_)};
+}
+
+/**
+ * Determine the persistent peers which should be connected to now, in order of priority
+ *
+ * @param max_pending The maximum number of pending connection attempts, including those which are
+ * already in progress
+ * @return The peers to connect to
+ */
+PeerConnectionList::PeerList PeerConnectionList::GetPeersToConnectTo(std::size_t max_pending) const
+{
+  using Candidate = std::pair<double, Uri const *>;
+
+  std::vector<Candidate> candidates;
+  std::size_t            pending{0};
 
   FETCH_LOCK(lock_);
 
+  for (auto const &connection : peer_connections_)
+  {
+    auto it = peer_metadata_.find(connection.first);
+    if ((it != peer_metadata_.end()) && !it->second.connected)
+    {
+      ++pending;
+    }
+  }
+
+  if (pending >= max_pending)
+  {
+    return {};
+  }
+
   // determine which of the persistent peers are no longer active
   for (auto const &peer : persistent_peers_)
   {
-    bool const inactive = peer_connections_.find(peer) == peer_connections_.end();
+    bool const inactive = peer_connections_.find(peer.first) == peer_connections_.end();
 
     if (inactive)
     {
-      auto it = peer_metadata_.find(peer);
-
-      // determine if this is an initial connection, or if we should try and apply some
-      // type of backoff.
-      bool const is_first_connection = it == peer_metadata_.end();
+      auto it = peer_metadata_.find(peer.first);
 
-      if (is_first_connection)
-      {
-        // on a first attempt, a connection attempt should always be made
-        peers.push_back(peer);
-      }
-      else
+      // on a first attempt a connection attempt should always be made, otherwise determine if
+      // this connection should be connected again
+      if ((it == peer_metadata_.end()) || ReadyForRetry(it->second))
       {
-        // look up the connection metadata
-        auto const &metadata = it->second;
-
-        // determine if this connection should be connected again
-        if (ReadyForRetry(metadata))
-        {
-          peers.push_back(peer);
-        }
+        candidates.emplace_back(peer.second, &peer.first);
       }
     }
   }
 
+  // the highest priority peers are connected to first
+  std::size_t const count = std::min(candidates.size(), max_pending - pending);
+  std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(count),
+                    candidates.end(), [](Candidate const &a, Candidate const &b) {
+                      return a.first > b.first;
+                    });
+
+  PeerList peers;
+  peers.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    peers.push_back(*candidates[i].second);
+  }
+
   return peers;
 }
 
@@ -19,6 +19,7 @@
 #include "muddle/punishment_broadcast_channel.hpp"
 
 using fetch::muddle::PunishmentBroadcastChannel;
+using fetch::muddle::QuestionDelta;
 using fetch::muddle::QuestionStruct;
 
 QuestionStruct PunishmentBroadcastChannel::AllowPeerPull()
@@ -27,6 +28,32 @@ QuestionStruct PunishmentBroadcastChannel::AllowPeerPull()
   return question_;
 }
 
+/**
+ * Serve the changes to our table since a version which a peer has already received. The previous
+ * question is also served, for peers which have not yet moved on to the current one.
+ *
+ * @param question The question the peer is answering
+ * @param since The version of our table the peer has already received
+ * @return The delta, with an empty question if the question is not known
+ */
+QuestionDelta PunishmentBroadcastChannel::AllowPeerPullDelta(ConstByteArray const &question,
+                                                              uint64_t              since)
+{
+  FETCH_LOCK(lock_);
+
+  if (question_ && (question_.question_ == question))
+  {
+    return question_.GetDelta(since);
+  }
+
+  if (previous_question_ && (previous_question_.question_ == question))
+  {
+    return previous_question_.GetDelta(since);
+  }
+
+  return {};
+}
+
 PunishmentBroadcastChannel::PunishmentBroadcastChannel(Endpoint &endpoint, MuddleAddress address,
                                                        CallbackFunction call_back,
                                                        CertificatePtr certificate, uint16_t channel,
@@ -41,6 +68,7 @@ PunishmentBroadcastChannel::PunishmentBroadcastChannel(Endpoint &endpoint, Muddl
 {
   FETCH_UNUSED(ordered_delivery);
   Expose(PULL_INFO_FROM_PEER, this, &PunishmentBroadcastChannel::AllowPeerPull);
+  Expose(PULL_DELTA_FROM_PEER, this, &PunishmentBroadcastChannel::AllowPeerPullDelta);
 
   // TODO(HUT): rpc beacon rename.
   // Attaching the protocol
@@ -136,6 +164,8 @@ bool PunishmentBroadcastChannel::AnsweredQuestion()
 
 PunishmentBroadcastChannel::State PunishmentBroadcastChannel::OnInit()
 {
+  ConstByteArray question;
+
   // Determine whether to take action
   {
     FETCH_LOCK(lock_);
@@ -146,6 +176,15 @@ PunishmentBroadcastChannel::State PunishmentBroadcastChannel::OnInit()
       network_promises_.clear();
       return State::INIT;
     }
+
+    question = question_.question_;
+  }
+
+  // The versions of the peers' tables only apply to the question they were received for
+  if (question != synced_question_)
+  {
+    synced_question_ = question;
+    peer_versions_.clear();
   }
 
   // If so, populate a vector with random peer addresses to try
@@ -173,8 +212,9 @@ PunishmentBroadcastChannel::State PunishmentBroadcastChannel::OnInit()
     MuddleAddress send_to = current_cabinet_vector_.back();
     current_cabinet_vector_.pop_back();
 
-    auto promise = rpc_client_.CallSpecificAddress(send_to, RPC_BEACON,
-                                                   PunishmentBroadcastChannel::PULL_INFO_FROM_PEER);
+    auto promise = rpc_client_.CallSpecificAddress(
+        send_to, RPC_BEACON, PunishmentBroadcastChannel::PULL_DELTA_FROM_PEER, question,
+        peer_versions_[send_to]);
 
     network_promises_.emplace_back(std::make_pair(send_to, promise));
   }
@@ -196,9 +236,9 @@ PunishmentBroadcastChannel::State PunishmentBroadcastChannel::OnResolvePromises(
 
     if (promise->IsSuccessful())
     {
-      QuestionStruct recvd_question;
+      QuestionDelta recvd_delta;
 
-      if (!promise->GetResult(recvd_question))
+      if (!promise->GetResult(recvd_delta))
       {
         FETCH_LOG_WARN(LOGGING_NAME, "Failed to deserialize response from: ", address.ToBase64());
       }
@@ -210,13 +250,18 @@ PunishmentBroadcastChannel::State PunishmentBroadcastChannel::OnResolvePromises(
           FETCH_LOCK(lock_);
 
           // Guard against receiving a non-matching table
-          if (recvd_question.question_ != question_.question_)
+          if ((recvd_delta.question != question_.question_) ||
+              (recvd_delta.question != synced_question_))
           {
             FETCH_LOG_DEBUG(LOGGING_NAME, "Note: ignoring non matching question");
           }
           else
           {
-            answers = question_.Update(threshold_, recvd_question);
+            answers = question_.Update(threshold_, recvd_delta);
+
+            // a peer whose table has gone backwards has restarted, pull its whole table next time
+            auto &version = peer_versions_[address];
+            version       = (recvd_delta.version < version) ? 0 : recvd_delta.version;
           }
         }
 
@@ -18,6 +18,7 @@
 
 #include "muddle/question_struct.hpp"
 
+using fetch::muddle::QuestionDelta;
 using fetch::muddle::QuestionStruct;
 
 using CertificatePtr   = QuestionStruct::CertificatePtr;
@@ -48,6 +49,10 @@ QuestionStruct::QuestionStruct(Digest question, Answer answer, CertificatePtr ce
   std::get<SIG>(cabinet_answer)         = Digest("nothing");
   std::get<SEEN>(cabinet_answer)[self_] = Digest("have seen!");
 
+  ++version_;
+  versions_[self_].answer      = version_;
+  versions_[self_].seen[self_] = version_;
+
   // Always create entries for all desired cabinet members to avoid
   // indexing errors
   for (auto const &member : cabinet_)
@@ -81,13 +86,93 @@ Seen const &QuestionStruct::GetSeen(AnswerAndSeen const &ref)
  */
 ConfirmedAnswers QuestionStruct::Update(uint32_t threshold, QuestionStruct &rhs)
 {
-  ConfirmedAnswers ret;
-
   if (rhs.question_ != question_)
   {
-    return ret;
+    return {};
+  }
+
+  return Merge(threshold, rhs.table_);
+}
+
+/**
+ * Update entries in our own table with the changes to a peer's table
+ *
+ * Return the answers which pass the threshold due to this
+ * (one time event)
+ */
+ConfirmedAnswers QuestionStruct::Update(uint32_t threshold, QuestionDelta const &delta)
+{
+  if (delta.question != question_)
+  {
+    return {};
+  }
+
+  return Merge(threshold, delta.table);
+}
+
+/**
+ * Get the changes to our table since the given version. Entries without any changes are omitted.
+ *
+ * @param since The version of our table which the peer has already seen
+ * @return The delta
+ */
+QuestionDelta QuestionStruct::GetDelta(uint64_t since) const
+{
+  QuestionDelta delta{};
+  delta.question = question_;
+  delta.version  = version_;
+
+  for (auto const &entry : versions_)
+  {
+    auto const &address  = entry.first;
+    auto const &versions = entry.second;
+    auto const  it       = table_.find(address);
+
+    if (it == table_.end())
+    {
+      continue;
+    }
+
+    AnswerAndSeen changes{};
+
+    if (versions.answer > since)
+    {
+      std::get<ANSW>(changes) = GetAnswer(it->second);
+      std::get<SIG>(changes)  = GetSignature(it->second);
+    }
+
+    auto const &seen = GetSeen(it->second);
+    for (auto const &seen_version : versions.seen)
+    {
+      if (seen_version.second > since)
+      {
+        auto const proof = seen.find(seen_version.first);
+        if (proof != seen.end())
+        {
+          std::get<SEEN>(changes).insert(*proof);
+        }
+      }
+    }
+
+    if (!GetAnswer(changes).empty() || !GetSeen(changes).empty())
+    {
+      delta.table.emplace(address, std::move(changes));
+    }
   }
 
+  return delta;
+}
+
+/**
+ * Internal: Merge the entries of another table into our own, recording the version of each change
+ *
+ * Return the answers which pass the threshold due to this
+ * (one time event)
+ */
+ConfirmedAnswers QuestionStruct::Merge(uint32_t threshold, SyncTable const &rhs)
+{
+  ConfirmedAnswers ret;
+
   for (auto &entry : table_)
   {
     MuddleAddress const &address                 = entry.first;
@@ -98,26 +183,41 @@ ConfirmedAnswers QuestionStruct::Update(uint32_t threshold, QuestionStruct &rhs)
     bool                 msg_was_below_threshold = seen.size() < threshold;
 
     // Add info from other table to ours
-    AnswerAndSeen &  rhs_answer_and_seen = rhs.table_[address];
-    Answer const &   rhs_answer          = GetAnswer(rhs_answer_and_seen);
-    Signature const &rhs_signature       = GetSignature(rhs_answer_and_seen);
-    Seen const &     rhs_seen            = GetSeen(rhs_answer_and_seen);
+    auto const rhs_it = rhs.find(address);
+    if (rhs_it == rhs.end())
+    {
+      continue;
+    }
+
+    AnswerAndSeen const &rhs_answer_and_seen = rhs_it->second;
+    Answer const &       rhs_answer          = GetAnswer(rhs_answer_and_seen);
+    Signature const &    rhs_signature       = GetSignature(rhs_answer_and_seen);
+    Seen const &         rhs_seen            = GetSeen(rhs_answer_and_seen);
+    EntryVersions &      versions            = versions_[address];
 
     if (!rhs_answer.empty() && answer.empty())
     {
-      answer = rhs_answer;
+      answer          = rhs_answer;
+      versions.answer = ++version_;
 
-      seen.emplace(self_, Digest("temp"));
+      if (seen.emplace(self_, Digest("temp")).second)
+      {
+        versions.seen[self_] = version_;
+      }
     }
 
     if (!rhs_signature.empty() && signature.empty())
     {
-      signature = rhs_signature;
+      signature       = rhs_signature;
+      versions.answer = ++version_;
     }
 
     for (auto const &rhs_seen_pair : rhs_seen)
     {
-      seen.insert(rhs_seen_pair);
+      if (seen.insert(rhs_seen_pair).second)
+      {
+        versions.seen[rhs_seen_pair.first] = ++version_;
+      }
     }
 
     if (seen.size() >= threshold && msg_was_below_threshold && address != self_)
@@ -16,11 +16,15 @@
 //
 //------------------------------------------------------------------------------
 
+#include "erasure_coder.hpp"
+
 #include "crypto/hash.hpp"
 #include "crypto/sha256.hpp"
 #include "logging/logging.hpp"
 #include "muddle/rbc.hpp"
 
+#include <utility>
+
 namespace fetch {
 namespace muddle {
 
@@ -97,6 +101,20 @@ void RBC::Enable(bool enable)
   }
 }
 
+/**
+ * Enables the dispersal of large messages. Rather than sending the complete message to every
+ * cabinet member, the broadcaster erasure codes it so that each member receives a single fragment,
+ * which it relays to the rest of the cabinet. Any threshold + 1 fragments are enough to recover the
+ * message, reducing the amount of data that the broadcaster must send by roughly this factor.
+ *
+ * @param min_message_size The minimum size of a message to be dispersed, zero to disable
+ */
+void RBC::EnableDispersal(std::size_t min_message_size)
+{
+  FETCH_LOCK(lock_);
+  dispersal_threshold_ = min_message_size;
+}
+
 /**
  * Resets the RBC for a new cabinet
  */
@@ -160,7 +178,10 @@ void RBC::Broadcast(SerialisedMessage const &msg)
 
   broadcast_msg = RBCMessage::New<RBroadcast>(channel_, static_cast<IdType>(id_),
                                               static_cast<CounterType>(++msg_counter_), msg);
-  InternalBroadcast(*broadcast_msg);
+  if (!InternalDisperse(broadcast_msg))
+  {
+    InternalBroadcast(*broadcast_msg);
+  }
 
   // Sending message to self
   OnRBroadcast(broadcast_msg, id_);
@@ -209,6 +230,57 @@ void RBC::InternalBroadcast(RBCMessage const &msg)
   }
 }
 
+/**
+ * Disperses a large message to the cabinet, sending each member the fragment for its position
+ *
+ * @param msg The RBroadcast message to be dispersed
+ * @return true if the message was dispersed, false if it should be broadcast normally
+ */
+bool RBC::InternalDisperse(MessageBroadcast const &msg)
+{
+  assert(msg != nullptr);
+
+  std::size_t const cabinet_size = current_cabinet_.size();
+  if ((dispersal_threshold_ == 0) || (msg->message().size() < dispersal_threshold_) ||
+      (cabinet_size < 2) || (cabinet_size > ErasureCoder::MAX_FRAGMENTS))
+  {
+    return false;
+  }
+
+  ErasureCoder const coder{threshold_ + 1u, cabinet_size};
+  auto const         fragments = coder.Encode(msg->message());
+
+  RBCFragment fragment{};
+  fragment.message_size = msg->message().size();
+  fragment.message_hash = crypto::Hash<HashFunction>(msg->message());
+  fragment.fragment_hashes.reserve(fragments.size());
+  for (auto const &data : fragments)
+  {
+    fragment.fragment_hashes.emplace_back(crypto::Hash<HashFunction>(data));
+  }
+
+  uint32_t index{0};
+  for (auto const &address : current_cabinet_)
+  {
+    if (address != address_)
+    {
+      fragment.index = index;
+      fragment.data  = fragments[index];
+
+      RBCSerializer serializer{};
+      serializer.Append(fragment);
+
+      Send(*RBCMessage::New<RFragment>(msg->channel(), msg->id(), msg->counter(),
+                                       serializer.data()),
+           address);
+    }
+
+    ++index;
+  }
+
+  return true;
+}
+
 /**
  * Increments counter for REcho messages
  * @param tag Unique tag of a message sent via RBC
@@ -282,6 +354,11 @@ void RBC::OnRBC(MuddleAddress const &from, RBCMessage const &message)
     OnRAnswer(RBCMessage::New<RAnswer>(message), sender_index);
     break;
   }
+  case RBCMessageType::R_FRAGMENT:
+  {
+    OnRFragment(RBCMessage::New<RFragment>(message), sender_index);
+    break;
+  }
   default:
     FETCH_LOG_WARN(LOGGING_NAME, "Node: ", id_, " can not process payload from node ",
                    sender_index);
@@ -514,6 +591,160 @@ void RBC::OnRAnswer(MessageAnswer const &msg, uint32_t sender_index)
   }
 }
 
+/**
+ * Handler for RFragment messages. The fragment for our own position arrives from the broadcaster
+ * (along with the hashes of all the fragments) and is relayed to the rest of the cabinet, while the
+ * other fragments arrive from the members that they belong to. Once enough fragments have been
+ * verified the message is recovered and an REcho is broadcast, as for an RBroadcast message.
+ *
+ * @param msg Reference to RFragment message
+ * @param sender_index Index of sender in current_cabinet_
+ */
+void RBC::OnRFragment(MessageFragment const &msg, uint32_t sender_index)
+{
+  assert(msg != nullptr);
+  assert(msg->is_valid());
+  TagType tag = msg->tag();
+
+  RBCFragment fragment{};
+  try
+  {
+    RBCSerializer serializer{msg->message()};
+    serializer >> fragment;
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "onRFragment: Node ", id_, " received malformed fragment from ",
+                   sender_index, ": ", ex.what());
+    return;
+  }
+
+  // the broadcaster only sends us our own fragment and members only relay their own fragment
+  bool const from_broadcaster = (sender_index == msg->id());
+  if (fragment.index != (from_broadcaster ? id_.load() : sender_index))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "onRFragment: Node ", id_, " received wrong fragment ",
+                   fragment.index, " from node ", sender_index, " for msg ", tag);
+    return;
+  }
+
+  if (!SetPartyFlag(sender_index, tag, MessageType::R_FRAGMENT))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "onRFragment: Node ", id_, " received repeated msg ", tag,
+                   " from node ", sender_index, " with counter ", std::to_string(msg->counter()),
+                   " and id ", msg->id());
+    return;
+  }
+
+  FETCH_LOG_TRACE(LOGGING_NAME, "onRFragment: Node ", id_, " received fragment ", fragment.index,
+                  " for msg ", tag, " from node ", sender_index);
+
+  auto &broadcast = broadcasts_[tag];
+  if (!broadcast.original_message.empty())
+  {
+    return;
+  }
+
+  // recovery has already been attempted and failed
+  if (!broadcast.dispersed_hash.empty() && broadcast.fragment_hashes.empty())
+  {
+    return;
+  }
+
+  if (from_broadcaster)
+  {
+    if (fragment.fragment_hashes.size() != current_cabinet_.size())
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "onRFragment: Node ", id_,
+                     " received fragment with invalid hashes from node ", sender_index);
+      return;
+    }
+
+    broadcast.dispersed_hash  = fragment.message_hash;
+    broadcast.dispersed_size  = fragment.message_size;
+    broadcast.fragment_hashes = std::move(fragment.fragment_hashes);
+
+    // relay our fragment to the rest of the cabinet
+    RBCFragment relay{};
+    relay.index = fragment.index;
+    relay.data  = fragment.data;
+
+    RBCSerializer serializer{};
+    serializer.Append(relay);
+
+    InternalBroadcast(
+        *RBCMessage::New<RFragment>(msg->channel(), msg->id(), msg->counter(), serializer.data()));
+  }
+
+  broadcast.fragments.emplace(fragment.index, std::move(fragment.data));
+
+  if (RecoverDispersedMessage(tag))
+  {
+    MessageEcho echo_msg = RBCMessage::New<REcho>(msg->channel(), msg->id(), msg->counter(),
+                                                  broadcast.dispersed_hash);
+    InternalBroadcast(*echo_msg);
+    OnREcho(echo_msg, id_);
+  }
+}
+
+/**
+ * Attempt to recover a dispersed message from the fragments received so far. Fragments can only be
+ * checked once the fragment hashes have been received from the broadcaster.
+ *
+ * @param tag Unique tag of a message sent via RBC
+ * @return true if the message has been recovered, otherwise false
+ */
+bool RBC::RecoverDispersedMessage(TagType tag)
+{
+  auto &broadcast = broadcasts_[tag];
+  if (broadcast.fragment_hashes.empty())
+  {
+    return false;
+  }
+
+  // discard any fragments which do not match the hashes announced by the broadcaster
+  for (auto it = broadcast.fragments.begin(); it != broadcast.fragments.end();)
+  {
+    if ((it->first >= broadcast.fragment_hashes.size()) ||
+        (crypto::Hash<HashFunction>(it->second) != broadcast.fragment_hashes[it->first]))
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", id_, " discarded bad fragment ", it->first,
+                     " for msg ", tag);
+      it = broadcast.fragments.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  ErasureCoder const coder{threshold_ + 1u, current_cabinet_.size()};
+  if (broadcast.fragments.size() < coder.num_data())
+  {
+    return false;
+  }
+
+  SerialisedMessage message{};
+  bool const        recovered =
+      coder.Decode(broadcast.fragments, broadcast.dispersed_size, message) &&
+      (crypto::Hash<HashFunction>(message) == broadcast.dispersed_hash);
+
+  // the fragments are no longer required, if the broadcaster encoded the message inconsistently it
+  // can still be obtained through an RRequest once the RReady messages have been received
+  broadcast.fragments.clear();
+  broadcast.fragment_hashes.clear();
+
+  if (!recovered)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Node ", id_, " failed to recover dispersed msg ", tag);
+    return false;
+  }
+
+  broadcast.original_message = message;
+
+  return true;
+}
+
 /**
  * Delivers messages which have reached the end of the protocol
  *
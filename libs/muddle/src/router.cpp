@@ -31,6 +31,7 @@
 #include "crypto/secure_channel.hpp"
 #include "logging/logging.hpp"
 #include "muddle/packet.hpp"
+#include "muddle/packet_pool.hpp"
 #include "telemetry/counter.hpp"
 #include "telemetry/gauge.hpp"
 #include "telemetry/histogram.hpp"
@@ -120,8 +121,9 @@ ConstByteArray EncodePayload(T const &msg)
   ConstByteArray payload{};
   try
   {
+    // Append sizes the buffer exactly before writing
     serializers::MsgPackSerializer serializer;
-    serializer << msg;
+    serializer.Append(msg);
 
     payload = serializer.data();
   }
@@ -140,7 +142,7 @@ bool ExtractPayload(ConstByteArray const &payload, T &msg)
 
   try
   {
-    serializers::MsgPackSerializer serializer{payload};
+    auto serializer = serializers::MsgPackSerializer::Borrow(payload);
     serializer >> msg;
 
     success = true;
@@ -168,7 +170,7 @@ Router::PacketPtr FormatPacket(Packet::Address const &from, NetworkId const &net
                                uint16_t service, uint16_t channel, uint16_t counter, uint8_t ttl,
                                Packet::Payload const &payload)
 {
-  auto packet = std::make_shared<Packet>(from, network.value());
+  auto packet = CreatePacket(from, network.value());
   packet->SetService(service);
   packet->SetChannel(channel);
   packet->SetMessageNum(counter);
@@ -246,6 +248,10 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prove
   , network_id_(network_id)
   , prover_(prover)
   , dispatch_thread_pool_(network::MakeThreadPool(NUMBER_OF_ROUTER_THREADS, "Router"))
+  , echo_filter_(config_.echo_cache_capacity, config_.echo_cache_buckets,
+                 config_.echo_cache_lifetime)
+  , verifier_("RouterVerify", config_.verification_threads, config_.verification_batch_size)
+  , compressor_(config_.compression_dictionary)
   , rx_max_packet_length(
         CreateGauge("ledger_router_rx_max_packet_length", "The max received packet length"))
   , tx_max_packet_length(
@@ -303,6 +309,13 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prove
   , echo_cache_removals_total_(
         CreateCounter("ledger_router_echo_cache_removal_total",
                       "The total number of entries removed from the echo cache"))
+  , echo_cache_hits_total_(CreateCounter("ledger_router_echo_cache_hits_total",
+                                         "The total number of echo packets detected"))
+  , echo_cache_evictions_total_(
+        CreateCounter("ledger_router_echo_cache_evictions_total",
+                      "The total number of entries evicted from a full echo cache"))
+  , echo_cache_size_(
+        CreateGauge("ledger_router_echo_cache_size", "The number of entries in the echo cache"))
   , normal_routing_total_(CreateCounter("ledger_router_normal_routing_total",
                                         "The total number of normally routed packets"))
   , informed_routing_total_(CreateCounter("ledger_router_informed_routing_total",
@@ -314,6 +327,31 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prove
                       "The total number of packets that have failed to be routed"))
   , connection_dropped_total_(CreateCounter("ledger_router_connection_dropped_total",
                                             "The total number of connections dropped"))
+  , tx_compressed_packet_total_(CreateCounter("ledger_router_tx_compressed_packet_total",
+                                              "The total number of sent compressed packets"))
+  , tx_compression_input_bytes_total_(
+        CreateCounter("ledger_router_tx_compression_input_bytes_total",
+                      "The total number of payload bytes before compression"))
+  , tx_compression_output_bytes_total_(
+        CreateCounter("ledger_router_tx_compression_output_bytes_total",
+                      "The total number of payload bytes after compression"))
+  , tx_compression_duration_(CreateHistogram("ledger_router_tx_compression_duration",
+                                             "The histogram of payload compression times in ns"))
+  , rx_compressed_packet_success_total_(
+        CreateCounter("ledger_router_rx_compressed_packet_success_total",
+                      "The total number of received compressed packets that could be read"))
+  , rx_compressed_packet_failures_total_(
+        CreateCounter("ledger_router_rx_compressed_packet_failures_total",
+                      "The total number of received compressed packets that could not be read"))
+  , rx_decompression_duration_(
+        CreateHistogram("ledger_router_rx_decompression_duration",
+                        "The histogram of payload decompression times in ns"))
+  , tx_high_priority_packet_total_(
+        CreateCounter("ledger_router_tx_high_priority_packet_total",
+                      "The total number of packets sent with high priority"))
+  , tx_bulk_priority_packet_total_(
+        CreateCounter("ledger_router_tx_bulk_priority_packet_total",
+                      "The total number of packets sent as bulk traffic"))
 {}
 
 /**
@@ -322,6 +360,7 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prove
 void Router::Start()
 {
   dispatch_thread_pool_->Start();
+  verifier_.Start();
   stopping_ = false;
 }
 
@@ -337,19 +376,19 @@ void Router::Stop()
     delivery_attempts_.clear();
   }
 
+  verifier_.Stop();
   dispatch_thread_pool_->Stop();
 }
 
-bool Router::Genuine(PacketPtr const &p) const
+/**
+ * Determine if the authenticity of a packet needs to be established before it is handled
+ *
+ * @param packet The packet to check
+ * @return true if the packet signature needs to be verified, otherwise false
+ */
+bool Router::RequiresVerification(Packet const &packet)
 {
-  bool genuine{true};
-
-  if (p->IsStamped() || p->IsBroadcast())
-  {
-    genuine = p->Verify();
-  }
-
-  return genuine;
+  return packet.IsStamped() || packet.IsBroadcast();
 }
 
 Router::PacketPtr const &Router::Sign(PacketPtr const &p) const
@@ -385,13 +424,46 @@ void Router::Route(Handle handle, PacketPtr const &packet)
     return;
   }
 
-  if (!Genuine(packet))
+  if (RequiresVerification(*packet))
   {
-    FETCH_LOG_WARN(logging_name_, "Packet's authenticity not verified:", DescribePacket(*packet));
-    fraudulent_packet_total_->increment();
+    // packets which are simply being relayed can be forwarded while the verification takes place,
+    // the final recipient will always check the signature before the packet is handled
+    bool const forwarded = config_.forward_before_verification && !packet->IsDirect() &&
+                           !packet->IsBroadcast() && (packet->GetTargetRaw() != address_raw_);
+
+    if (forwarded)
+    {
+      RoutePacket(packet);
+    }
+
+    verifier_.Verify(packet, [this, handle, forwarded](PacketPtr const &p, bool genuine) {
+      if (!genuine)
+      {
+        FETCH_LOG_WARN(logging_name_, "Packet's authenticity not verified:", DescribePacket(*p));
+        fraudulent_packet_total_->increment();
+        return;
+      }
+
+      if (!forwarded && !stopping_)
+      {
+        RouteVerified(handle, p);
+      }
+    });
+
     return;
   }
 
+  RouteVerified(handle, packet);
+}
+
+/**
+ * Route a packet from the network layer whose authenticity has been established
+ *
+ * @param handle The handle of the receiving connection for the packet
+ * @param packet The input packet to route
+ */
+void Router::RouteVerified(Handle handle, PacketPtr const &packet)
+{
   if (packet->IsDirect())
   {
     // when it is a direct message we must handle this
@@ -467,6 +539,9 @@ void Router::Send(Address const &address, uint16_t service, uint16_t channel, ui
     packet->SetExchange(true);
   }
 
+  // compression must be applied before encryption, since encrypted data will not compress
+  CompressPayload(*packet);
+
   if ((options & OPTION_ENCRYPTED) != 0u)
   {
     ConstByteArray encrypted_payload{};
@@ -519,6 +594,7 @@ void Router::Broadcast(uint16_t service, uint16_t channel, Payload const &payloa
 void Router::Cleanup()
 {
   CleanEchoCache();
+  verifier_.TrimCache(std::chrono::seconds{600});
 }
 
 /**
@@ -622,7 +698,7 @@ void Router::SendToConnection(Handle handle, PacketPtr const &packet, bool exter
       FETCH_LOG_TRACE(logging_name_, "TX: (conn: ", handle, ") ", DescribePacket(*packet));
 
       // dispatch to the connection object
-      conn->Send(buffer, success, fail);
+      conn->Send(buffer, success, fail, Prioritise(*packet, buffer.size()));
 
       tx_packet_total_->increment();
       tx_max_packet_length->max(buffer.size());
@@ -647,6 +723,32 @@ void Router::SendToConnection(Handle handle, PacketPtr const &packet, bool exter
   }
 }
 
+/**
+ * Internal: Determine the priority with which a packet should be written to a connection. Small
+ * packets for the latency sensitive services (routing, DKG and beacon traffic) are written ahead of
+ * everything else, while large packets are demoted so that they do not hold up normal traffic.
+ *
+ * @param packet The packet to be sent
+ * @param size The size of the serialized packet
+ * @return The priority of the packet
+ */
+network::MessagePriority Router::Prioritise(Packet const &packet, std::size_t size) const
+{
+  if (size >= config_.bulk_threshold)
+  {
+    tx_bulk_priority_packet_total_->increment();
+    return network::MessagePriority::BULK;
+  }
+
+  if (config_.priority_services.find(packet.GetService()) != config_.priority_services.end())
+  {
+    tx_high_priority_packet_total_->increment();
+    return network::MessagePriority::HIGH;
+  }
+
+  return network::MessagePriority::NORMAL;
+}
+
 /**
  * Attempt to route the packet to the require address(es)
  *
@@ -899,6 +1001,12 @@ void Router::DispatchPacket(PacketPtr const &packet, Address const &transmitter)
       rx_encrypted_packet_success_total_->increment();
     }
 
+    if (packet->IsCompressed() && !DecompressPayload(*packet))
+    {
+      FETCH_LOG_WARN(logging_name_, "Unable to decompress input message");
+      return;
+    }
+
     // If no exchange message has claimed this then attempt to dispatch it through our normal system
     // of message subscriptions.
     if (registrar_.Dispatch(packet, transmitter))
@@ -926,29 +1034,22 @@ void Router::DispatchPacket(PacketPtr const &packet, Address const &transmitter)
  */
 bool Router::IsEcho(Packet const &packet, bool register_echo)
 {
-  bool is_echo = true;
-
   // combine the 3 fields together into a single index
   std::size_t const index = GenerateEchoId(packet);
 
+  switch (echo_filter_.Check(index, register_echo))
   {
-    FETCH_LOCK(echo_cache_lock_);
-
-    // look up if the echo is in the cache
-    auto it = echo_cache_.find(index);
-    if (it == echo_cache_.end())
-    {
-      // register the echo (in needed)
-      if (register_echo)
-      {
-        echo_cache_[index] = Clock::now();
-      }
-
-      is_echo = false;
-    }
+  case EchoFilter::Result::DUPLICATE:
+    echo_cache_hits_total_->increment();
+    return true;
+  case EchoFilter::Result::UNIQUE_EVICTED:
+    echo_cache_evictions_total_->increment();
+    break;
+  case EchoFilter::Result::UNIQUE:
+    break;
   }
 
-  return is_echo;
+  return false;
 }
 
 /**
@@ -956,31 +1057,124 @@ bool Router::IsEcho(Packet const &packet, bool register_echo)
  */
 void Router::CleanEchoCache()
 {
-  FETCH_LOCK(echo_cache_lock_);
-
   echo_cache_trims_total_->increment();
 
   auto const now = Clock::now();
 
-  auto it = echo_cache_.begin();
-  while (it != echo_cache_.end())
+  // entries expire a whole time bucket at a time, this simply moves the clearing of the expired
+  // bucket off the packet path
+  echo_cache_removals_total_->add(echo_filter_.Expire(now));
+  echo_cache_size_->set(static_cast<uint64_t>(echo_filter_.size(now)));
+}
+
+/**
+ * Record the compression capabilities advertised by a directly connected peer
+ *
+ * @param address The address of the peer
+ * @param compression Flag to signal that the peer can receive compressed payloads
+ * @param dictionary_id The id of the dictionary configured on the peer
+ */
+void Router::SetPeerCompression(Address const &address, bool compression, uint64_t dictionary_id)
+{
+  FETCH_LOCK(compression_peers_lock_);
+
+  if (compression)
+  {
+    compression_peers_[address] = dictionary_id;
+  }
+  else
   {
-    // calculate the time delta
-    auto const delta = now - it->second;
+    compression_peers_.erase(address);
+  }
+}
 
-    if (delta > std::chrono::seconds{600})
-    {
-      // remove the element
-      it = echo_cache_.erase(it);
+void Router::ClearPeerCompression(Address const &address)
+{
+  FETCH_LOCK(compression_peers_lock_);
+  compression_peers_.erase(address);
+}
 
-      echo_cache_removals_total_->increment();
-    }
-    else
+/**
+ * Compress the payload of an outgoing packet, when it is large enough and the target has signalled
+ * that it is able to decompress it.
+ *
+ * @param packet The packet to be updated
+ * @return true if the payload was compressed, otherwise false
+ */
+bool Router::CompressPayload(Packet &packet)
+{
+  if (!config_.compression_enabled || packet.IsBroadcast() ||
+      (packet.GetPayload().size() < config_.compression_threshold))
+  {
+    return false;
+  }
+
+  bool use_dictionary{false};
+  {
+    FETCH_LOCK(compression_peers_lock_);
+
+    auto const it = compression_peers_.find(packet.GetTarget());
+    if (it == compression_peers_.end())
     {
-      // move on to the next element in the cache
-      ++it;
+      return false;
     }
+
+    use_dictionary = (compressor_.dictionary_id() != PayloadCompressor::NO_DICTIONARY) &&
+                     (it->second == compressor_.dictionary_id());
   }
+
+  auto const start = Clock::now();
+
+  ConstByteArray compressed{};
+  bool const     success = compressor_.Compress(packet.GetPayload(), use_dictionary, compressed);
+
+  auto const duration =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+  tx_compression_duration_->Add(static_cast<double>(duration));
+
+  if (!success)
+  {
+    return false;
+  }
+
+  tx_compressed_packet_total_->increment();
+  tx_compression_input_bytes_total_->add(packet.GetPayload().size());
+  tx_compression_output_bytes_total_->add(compressed.size());
+
+  packet.SetPayload(compressed);
+  packet.SetCompressed();
+
+  return true;
+}
+
+/**
+ * Restore the original payload of a received compressed packet
+ *
+ * @param packet The packet to be updated
+ * @return true if successful, otherwise false
+ */
+bool Router::DecompressPayload(Packet &packet)
+{
+  auto const start = Clock::now();
+
+  ConstByteArray payload{};
+  bool const     success = compressor_.Decompress(packet.GetPayload(), payload);
+
+  auto const duration =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+  rx_decompression_duration_->Add(static_cast<double>(duration));
+
+  if (!success)
+  {
+    rx_compressed_packet_failures_total_->increment();
+    return false;
+  }
+
+  packet.SetPayload(payload);
+  packet.SetCompressed(false);
+  rx_compressed_packet_success_total_->increment();
+
+  return true;
 }
 
 void Router::Blacklist(Address const &target)
@@ -1000,8 +1194,7 @@ bool Router::IsBlacklisted(Address const &target) const
 
 Router::EchoCache Router::echo_cache() const
 {
-  FETCH_LOCK(echo_cache_lock_);
-  return echo_cache_;
+  return echo_filter_.entries(Clock::now());
 }
 
 NetworkId const &Router::network() const
@@ -17,7 +17,9 @@
 //------------------------------------------------------------------------------
 
 #include "muddle/rpc/client.hpp"
+#include "network/service/message_types.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -33,6 +35,9 @@ namespace fetch {
 namespace muddle {
 namespace rpc {
 
+constexpr std::size_t  Client::DEFAULT_MAX_BATCH_SIZE;
+Client::Duration const Client::DEFAULT_BATCH_WINDOW = std::chrono::milliseconds{1};
+
 Client::Client(std::string name, MuddleEndpoint &endpoint, uint16_t service, uint16_t channel)
   : name_(std::move(name))
   , endpoint_(endpoint)
@@ -45,6 +50,44 @@ Client::Client(std::string name, MuddleEndpoint &endpoint, uint16_t service, uin
   subscription_->SetMessageHandler(this, &Client::OnMessage);
 }
 
+Client::~Client()
+{
+  {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    stopping_ = true;
+  }
+
+  batch_cv_.notify_all();
+
+  if (batch_thread_)
+  {
+    batch_thread_->join();
+    batch_thread_.reset();
+  }
+}
+
+/**
+ * Enable the batching of calls. Calls are sent straight away when no response is outstanding from
+ * the peer, otherwise they are queued and sent together when the next response arrives, the batch
+ * is full or the batch window expires (which ever is first).
+ *
+ * @param window The maximum time that a call is held back
+ * @param max_calls The maximum number of calls in a single batch
+ */
+void Client::EnableBatching(Duration const &window, std::size_t max_calls)
+{
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+
+  batch_window_     = window;
+  max_batch_size_   = std::max<std::size_t>(max_calls, 1);
+  batching_enabled_ = true;
+
+  if (!batch_thread_)
+  {
+    batch_thread_ = std::make_unique<std::thread>([this]() { RunBatchFlusher(); });
+  }
+}
+
 bool Client::DeliverRequest(muddle::Address const &address, network::MessageBuffer const &data)
 {
   FETCH_LOG_TRACE(LOGGING_NAME, "Client::DeliverRequest to: ", address.ToBase64(), " mdl ",
@@ -88,6 +131,251 @@ void Client::OnMessage(Packet const &packet, Address const &last_hop)
   {
     FETCH_LOG_ERROR(LOGGING_NAME, "Error processing server message: ", ex.what());
   }
+
+  if (!batching_enabled_)
+  {
+    return;
+  }
+
+  // the response frees the peer to receive any calls that have been queued in the meantime
+  Batch batch{};
+  {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+
+    auto it = peers_.find(packet.GetSender());
+    if (it != peers_.end())
+    {
+      auto &peer = it->second;
+
+      if (peer.outstanding > 0)
+      {
+        --peer.outstanding;
+      }
+
+      if (!peer.batch.requests.empty())
+      {
+        std::swap(batch, peer.batch);
+        ++peer.outstanding;
+      }
+      else if (peer.outstanding == 0)
+      {
+        peers_.erase(it);
+      }
+    }
+  }
+
+  FlushBatch(packet.GetSender(), std::move(batch));
+}
+
+/**
+ * Internal: Send a request, or add it to the batch for the peer
+ *
+ * @param address The address of the peer
+ * @param id The id of the promise for the request
+ * @param data The encoded request
+ * @return true if the request was sent or queued, otherwise false
+ */
+bool Client::SubmitRequest(Address const &address, service::PromiseCounter id,
+                           network::MessageBuffer const &data)
+{
+  if (!batching_enabled_)
+  {
+    return DeliverRequest(address, data);
+  }
+
+  Batch batch{};
+  bool  send_now{false};
+  {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+
+    auto &peer = peers_[address];
+
+    if ((peer.outstanding == 0) && peer.batch.requests.empty())
+    {
+      // nothing is waiting for the peer so there is no point delaying the call
+      ++peer.outstanding;
+      send_now = true;
+    }
+    else
+    {
+      if (peer.batch.requests.empty())
+      {
+        peer.batch.created = Clock::now();
+        batch_cv_.notify_all();
+      }
+
+      peer.batch.ids.push_back(id);
+      peer.batch.requests.push_back(data);
+
+      if (peer.batch.requests.size() >= max_batch_size_)
+      {
+        std::swap(batch, peer.batch);
+        ++peer.outstanding;
+      }
+    }
+  }
+
+  if (send_now)
+  {
+    bool delivered{false};
+
+    try
+    {
+      delivered = DeliverRequest(address, data);
+    }
+    catch (std::exception const &)
+    {
+      delivered = false;
+    }
+
+    if (!delivered)
+    {
+      std::lock_guard<std::mutex> lock(batch_mutex_);
+
+      auto &peer = peers_[address];
+      if (peer.outstanding > 0)
+      {
+        --peer.outstanding;
+      }
+    }
+
+    return delivered;
+  }
+
+  FlushBatch(address, std::move(batch));
+
+  return true;
+}
+
+/**
+ * Internal: Send a batch of requests to a peer, failing the promises if this is not possible
+ *
+ * @param address The address of the peer
+ * @param batch The batch to be sent
+ */
+void Client::FlushBatch(Address const &address, Batch batch)
+{
+  if (batch.requests.empty())
+  {
+    return;
+  }
+
+  network::MessageBuffer payload{};
+  if (batch.requests.size() == 1)
+  {
+    payload = batch.requests.front();
+  }
+  else
+  {
+    serializers::SizeCounter counter;
+    counter << service::SERVICE_BATCH << batch.requests;
+
+    Serializer serializer;
+    serializer.Reserve(counter.size());
+    serializer << service::SERVICE_BATCH << batch.requests;
+
+    payload = serializer.data();
+  }
+
+  bool delivered{false};
+
+  try
+  {
+    delivered = DeliverRequest(address, payload);
+  }
+  catch (std::exception const &)
+  {
+    delivered = false;
+  }
+
+  if (delivered)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+
+    auto it = peers_.find(address);
+    if ((it != peers_.end()) && (it->second.outstanding > 0))
+    {
+      --it->second.outstanding;
+    }
+  }
+
+  FETCH_LOG_WARN(LOGGING_NAME, "Failed to deliver batch of ", batch.ids.size(), " calls");
+
+  for (auto const &id : batch.ids)
+  {
+    auto promise = ExtractPromise(id);
+    if (promise)
+    {
+      promise->Fail(serializers::SerializableException(
+          service::error::COULD_NOT_DELIVER,
+          byte_array::ConstByteArray("Could not deliver request in " __FILE__)));
+    }
+  }
+}
+
+/**
+ * Internal: Send all the batches which have been waiting for longer than the batch window
+ */
+void Client::FlushExpiredBatches()
+{
+  std::vector<std::pair<Address, Batch>> expired{};
+
+  {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+
+    auto const now = Clock::now();
+    for (auto &element : peers_)
+    {
+      auto &peer = element.second;
+
+      if (!peer.batch.requests.empty() && ((now - peer.batch.created) >= batch_window_))
+      {
+        expired.emplace_back(element.first, Batch{});
+        std::swap(expired.back().second, peer.batch);
+        ++peer.outstanding;
+      }
+    }
+  }
+
+  for (auto &element : expired)
+  {
+    FlushBatch(element.first, std::move(element.second));
+  }
+}
+
+void Client::RunBatchFlusher()
+{
+  std::unique_lock<std::mutex> lock(batch_mutex_);
+
+  while (!stopping_)
+  {
+    bool const pending =
+        std::any_of(peers_.begin(), peers_.end(), [](PeerStates::value_type const &element) {
+          return !element.second.batch.requests.empty();
+        });
+
+    if (pending)
+    {
+      batch_cv_.wait_for(lock, batch_window_);
+    }
+    else
+    {
+      batch_cv_.wait(lock);
+    }
+
+    if (stopping_)
+    {
+      break;
+    }
+
+    lock.unlock();
+    FlushExpiredBatches();
+    lock.lock();
+  }
 }
 
 }  // namespace rpc
@@ -16,8 +16,11 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/set_thread_name.hpp"
 #include "muddle/subscription.hpp"
 
+#include <algorithm>
+
 namespace fetch {
 namespace muddle {
 
@@ -28,6 +31,9 @@ Subscription::~Subscription()
 {
   FETCH_LOG_DEBUG(LOGGING_NAME, "Destructing subscription");
 
+  // the worker must not outlive the handler it invokes
+  StopAsyncDispatch();
+
   // this is needed to ensure that no curious object
   SetMessageHandler(MessageCallback{});
 }
@@ -60,11 +66,77 @@ void Subscription::SetMessageHandler(LowLevelCallback cb)
 }
 
 /**
- * Dispatch the message to the subscription
+ * Dispatch messages to the handler on a worker thread owned by the subscription, rather than on
+ * the thread dispatching the message. Messages are delivered in order, when the queue of pending
+ * messages is full further messages are dropped. Repeated calls only update the queue bound.
  *
- * @param service The service identifier
- * @param channel The channel identifier
- * @param payload The payload of the message
+ * @param max_queue_size The maximum number of pending messages
+ */
+void Subscription::EnableAsyncDispatch(std::size_t max_queue_size)
+{
+  std::lock_guard<std::mutex> lock(queue_lock_);
+
+  max_queue_size_ = std::max<std::size_t>(max_queue_size, 1);
+  if (!worker_)
+  {
+    worker_ = std::make_unique<std::thread>([this]() { ProcessQueue(); });
+  }
+}
+
+/**
+ * @return true if messages are dispatched on the worker thread of the subscription
+ */
+bool Subscription::IsAsync() const
+{
+  std::lock_guard<std::mutex> lock(queue_lock_);
+  return max_queue_size_ != 0;
+}
+
+/**
+ * @return The number of messages dropped because the queue of pending messages was full
+ */
+std::size_t Subscription::dropped_count() const
+{
+  return dropped_count_;
+}
+
+/**
+ * Dispatch the message to the subscription, which is queued to the worker thread when
+ * asynchronous dispatch is enabled
+ *
+ * @param packet The packet to dispatch
+ * @param last_hop The address of the peer from which the packet was received
+ */
+void Subscription::Dispatch(PacketPtr const &packet, Address const &last_hop)
+{
+  {
+    std::lock_guard<std::mutex> lock(queue_lock_);
+
+    if (max_queue_size_ != 0)
+    {
+      if (queue_.size() < max_queue_size_)
+      {
+        queue_.emplace_back(packet, last_hop);
+        queue_cv_.notify_one();
+      }
+      else
+      {
+        ++dropped_count_;
+        FETCH_LOG_WARN(LOGGING_NAME, "Dropping message because the subscription queue is full");
+      }
+
+      return;
+    }
+  }
+
+  Dispatch(*packet, last_hop);
+}
+
+/**
+ * Dispatch the message to the handler on the calling thread
+ *
+ * @param packet The packet to dispatch
+ * @param last_hop The address of the peer from which the packet was received
  */
 void Subscription::Dispatch(Packet const &packet, Address const &last_hop) const
 {
@@ -79,5 +151,51 @@ void Subscription::Dispatch(Packet const &packet, Address const &last_hop) const
   }
 }
 
+/**
+ * Internal: The worker loop, which dispatches the queued messages in order
+ */
+void Subscription::ProcessQueue()
+{
+  SetThreadName(LOGGING_NAME);
+
+  std::unique_lock<std::mutex> lock(queue_lock_);
+  for (;;)
+  {
+    queue_cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+
+    if (stop_)
+    {
+      break;
+    }
+
+    QueueElement element = std::move(queue_.front());
+    queue_.pop_front();
+
+    // the handler is invoked without holding the queue so that dispatching is never blocked
+    lock.unlock();
+    Dispatch(*element.first, element.second);
+    lock.lock();
+  }
+}
+
+/**
+ * Internal: Stop the worker thread, discarding any pending messages
+ */
+void Subscription::StopAsyncDispatch()
+{
+  {
+    std::lock_guard<std::mutex> lock(queue_lock_);
+    stop_ = true;
+    queue_.clear();
+  }
+  queue_cv_.notify_all();
+
+  if (worker_)
+  {
+    worker_->join();
+    worker_.reset();
+  }
+}
+
 }  // namespace muddle
 }  // namespace fetch
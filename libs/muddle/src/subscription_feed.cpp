@@ -48,40 +48,45 @@ SubscriptionFeed::SubscriptionPtr SubscriptionFeed::Subscribe()
 /**
  * Dispatch the contents of the message
  *
- * @param service The service identifier
- * @param channel The channel identifier
- * @param counter The message number  / identifier
- * @param payload The payload of the message
+ * @param packet The packet to dispatch
+ * @param last_hop The address of the peer from which the packet was received
  * @return true if one or more successful dispatches were made, otherwise false
  */
-bool SubscriptionFeed::Dispatch(Packet const &packet, Address const &last_hop)
+bool SubscriptionFeed::Dispatch(PacketPtr const &packet, Address const &last_hop)
 {
-  FETCH_LOCK(feed_lock_);
+  ActiveList active;
 
-  bool success = false;
-
-  // loop through the subscriptions
-  auto it = feed_.cbegin();
-  while (it != feed_.cend())
   {
-    // check
-    auto subscription = it->lock();
-    if (subscription)
-    {
-      // dispatch the message to the handler
-      subscription->Dispatch(packet, last_hop);
+    FETCH_LOCK(feed_lock_);
 
-      success = true;
-      ++it;
-    }
-    else
+    active.reserve(feed_.size());
+
+    // loop through the subscriptions
+    auto it = feed_.cbegin();
+    while (it != feed_.cend())
     {
-      // if the subscription is dead then remove it from our list
-      it = feed_.erase(it);
+      // check
+      auto subscription = it->lock();
+      if (subscription)
+      {
+        active.emplace_back(std::move(subscription));
+        ++it;
+      }
+      else
+      {
+        // if the subscription is dead then remove it from our list
+        it = feed_.erase(it);
+      }
     }
   }
 
-  return success;
+  // dispatch the message to the handlers, without blocking new subscriptions to the feed
+  for (auto const &subscription : active)
+  {
+    subscription->Dispatch(packet, last_hop);
+  }
+
+  return !active.empty();
 }
 
 }  // namespace muddle
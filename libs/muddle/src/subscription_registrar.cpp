@@ -68,12 +68,12 @@ SubscriptionRegistrar::SubscriptionPtr SubscriptionRegistrar::Register(Address c
 {
   SubscriptionPtr subscription;
 
-  AddressIndex const index{Combine(service, channel), address};
+  Index const index = Combine(service, channel);
 
   {
     FETCH_LOCK(lock_);
 
-    auto &feed   = address_dispatch_map_[index];
+    auto &feed   = dispatch_map_[index].address_feeds[address];
     subscription = feed.Subscribe();
   }
 
@@ -97,7 +97,7 @@ SubscriptionRegistrar::SubscriptionPtr SubscriptionRegistrar::Register(uint16_t
   {
     FETCH_LOCK(lock_);
 
-    auto &feed   = dispatch_map_[index];
+    auto &feed   = dispatch_map_[index].feed;
     subscription = feed.Subscribe();
   }
 
@@ -112,39 +112,46 @@ SubscriptionRegistrar::SubscriptionPtr SubscriptionRegistrar::Register(uint16_t
  */
 bool SubscriptionRegistrar::Dispatch(PacketPtr const &packet, Address const &transmitter)
 {
-  bool success = false;
+  Index const index = Combine(packet->GetService(), packet->GetChannel());
 
-  Index const  index = Combine(packet->GetService(), packet->GetChannel());
-  AddressIndex address_index{index, packet->GetTarget()};
+  SubscriptionFeed *feed         = nullptr;
+  SubscriptionFeed *address_feed = nullptr;
 
   {
     FETCH_LOCK(lock_);
+
     auto it = dispatch_map_.find(index);
-    if (it != dispatch_map_.end())
+    if (it == dispatch_map_.end())
     {
-      // dispatch the packet to the subscription feed
-      success = it->second.Dispatch(*packet, transmitter);
+      return false;
+    }
 
-      if (!success)
+    auto &topic = it->second;
+    feed        = &topic.feed;
+
+    if (!topic.address_feeds.empty())
+    {
+      auto address_it = topic.address_feeds.find(packet->GetTarget());
+      if (address_it != topic.address_feeds.end())
       {
-        FETCH_LOG_WARN(logging_name_, "Failed to dispatch message to a given subscription");
+        address_feed = &address_it->second;
       }
     }
   }
 
+  // dispatch the packet to the subscription feeds
+  bool success = feed->Dispatch(packet, transmitter);
+
+  if (address_feed != nullptr)
   {
-    FETCH_LOCK(lock_);
-    auto it = address_dispatch_map_.find(address_index);
-    if (it != address_dispatch_map_.end())
+    if (address_feed->Dispatch(packet, transmitter))
     {
-      // dispatch the packet to the subscription feed
-      success = it->second.Dispatch(*packet, transmitter);
-
-      if (!success)
-      {
-        FETCH_LOG_WARN(logging_name_,
-                       "Failed to dispatch message to a given subscription (address specific)");
-      }
+      success = true;
+    }
+    else
+    {
+      FETCH_LOG_WARN(logging_name_,
+                     "Failed to dispatch message to a given subscription (address specific)");
     }
   }
 
@@ -338,13 +338,15 @@ class HonestRbcMember : public RbcMember
 {
 
 public:
-  HonestRbcMember(uint16_t port_number, uint16_t index)
+  HonestRbcMember(uint16_t port_number, uint16_t index, std::size_t dispersal_threshold = 0)
     : RbcMember{port_number, index}
     , rbc_{muddle->GetEndpoint(), muddle_certificate->identity().identifier(),
            [this](ConstByteArray const &, ConstByteArray const &payload) -> void {
              OnRbcMessage(payload);
            }}
-  {}
+  {
+    rbc_.EnableDispersal(dispersal_threshold);
+  }
 
   void ResetCabinet(RBC::CabinetMembers const &new_cabinet) override
   {
@@ -360,8 +362,9 @@ private:
 };
 
 void GenerateRbcTest(uint32_t cabinet_size, uint32_t expected_completion_size,
-                     const std::vector<std::vector<FaultyRbc::Failures>> &failures     = {},
-                     uint8_t                                              num_messages = 1)
+                     const std::vector<std::vector<FaultyRbc::Failures>> &failures            = {},
+                     uint8_t                                              num_messages        = 1,
+                     std::size_t                                          dispersal_threshold = 0)
 {
 
   RBC::CabinetMembers                     cabinet_members;
@@ -375,7 +378,7 @@ void GenerateRbcTest(uint32_t cabinet_size, uint32_t expected_completion_size,
     }
     else
     {
-      cabinet.emplace_back(new HonestRbcMember{port_number, ii});
+      cabinet.emplace_back(new HonestRbcMember{port_number, ii, dispersal_threshold});
     }
     cabinet_members.insert(cabinet[ii]->muddle_certificate->identity().identifier());
   }
@@ -446,6 +449,11 @@ TEST(rbc, all_honest)
   GenerateRbcTest(4, 3, {});
 }
 
+TEST(rbc, all_honest_dispersed)
+{
+  GenerateRbcTest(7, 6, {}, 1, 1);
+}
+
 TEST(rbc, bad_message)
 {
   // One node receives the wrong message and sends an echo with the wrong hash but
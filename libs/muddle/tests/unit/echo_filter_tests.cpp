@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "echo_filter.hpp"
+
+#include "gmock/gmock.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::muddle::EchoFilter;
+using Result = EchoFilter::Result;
+
+constexpr std::size_t          CAPACITY = 1024;
+constexpr std::size_t          BUCKETS  = 4;
+constexpr std::chrono::seconds LIFETIME{30};
+
+TEST(EchoFilterTests, CheckDuplicatesAreDetected)
+{
+  EchoFilter filter{CAPACITY, BUCKETS, LIFETIME};
+  auto const now = EchoFilter::Clock::now();
+
+  EXPECT_EQ(filter.capacity(), CAPACITY);
+
+  for (uint64_t id = 0; id < 100; ++id)
+  {
+    EXPECT_EQ(filter.Check(id, now), Result::UNIQUE);
+  }
+
+  for (uint64_t id = 0; id < 100; ++id)
+  {
+    EXPECT_EQ(filter.Check(id, now), Result::DUPLICATE);
+  }
+
+  EXPECT_EQ(filter.size(now), 100u);
+  EXPECT_EQ(filter.entries(now).size(), 100u);
+}
+
+TEST(EchoFilterTests, CheckUnregisteredIdsAreNotStored)
+{
+  EchoFilter filter{CAPACITY, BUCKETS, LIFETIME};
+  auto const now = EchoFilter::Clock::now();
+
+  EXPECT_EQ(filter.Check(42, now, false), Result::UNIQUE);
+  EXPECT_EQ(filter.Check(42, now, false), Result::UNIQUE);
+  EXPECT_EQ(filter.size(now), 0u);
+}
+
+TEST(EchoFilterTests, CheckIdsExpireAfterLifetime)
+{
+  EchoFilter filter{CAPACITY, BUCKETS, LIFETIME};
+  auto const start = EchoFilter::Clock::now();
+
+  EXPECT_EQ(filter.Check(1, start), Result::UNIQUE);
+
+  // the id must be remembered for at least the lifetime
+  EXPECT_EQ(filter.Check(1, start + LIFETIME - std::chrono::seconds{1}, false),
+            Result::DUPLICATE);
+
+  // and forgotten once all of the buckets have been cycled
+  auto const later = start + LIFETIME + (LIFETIME / (BUCKETS - 1)) + std::chrono::seconds{1};
+  EXPECT_EQ(filter.Check(1, later, false), Result::UNIQUE);
+
+  // expiring moves the filter on to the new bucket, clearing the old entry
+  EXPECT_EQ(filter.Expire(later), 1u);
+  EXPECT_EQ(filter.size(later), 0u);
+  EXPECT_EQ(filter.Expire(later), 0u);
+}
+
+TEST(EchoFilterTests, CheckMemoryIsBounded)
+{
+  EchoFilter filter{CAPACITY, BUCKETS, LIFETIME};
+  auto const now = EchoFilter::Clock::now();
+
+  std::size_t evictions{0};
+  for (uint64_t id = 1; id <= CAPACITY * 4; ++id)
+  {
+    if (filter.Check(id * 0x9E3779B97F4A7C15ull, now) == Result::UNIQUE_EVICTED)
+    {
+      ++evictions;
+    }
+  }
+
+  EXPECT_GT(evictions, 0u);
+  EXPECT_LE(filter.size(now), CAPACITY / BUCKETS);
+}
+
+TEST(EchoFilterTests, CheckConcurrentRegistration)
+{
+  static constexpr std::size_t NUM_THREADS = 4;
+  static constexpr uint64_t    NUM_IDS     = 200;
+
+  EchoFilter               filter{CAPACITY, BUCKETS, LIFETIME};
+  std::atomic<std::size_t> unique{0};
+
+  std::vector<std::thread> threads{};
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([&filter, &unique]() {
+      for (uint64_t id = 0; id < NUM_IDS; ++id)
+      {
+        if (filter.Check(id) != Result::DUPLICATE)
+        {
+          ++unique;
+        }
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  // each of the ids should only have been seen as unique once
+  EXPECT_EQ(unique.load(), NUM_IDS);
+}
+
+}  // namespace
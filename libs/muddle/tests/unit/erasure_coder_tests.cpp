@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "erasure_coder.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::muddle::ErasureCoder;
+
+ConstByteArray GenerateMessage(std::size_t size)
+{
+  ByteArray message{};
+  message.Resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    message[i] = static_cast<uint8_t>((i * 131u) ^ (i >> 3u));
+  }
+
+  return message;
+}
+
+TEST(ErasureCoderTests, CheckAnySubsetRecoversTheMessage)
+{
+  ErasureCoder const coder{4, 10};
+  auto const         message   = GenerateMessage(1001);
+  auto const         fragments = coder.Encode(message);
+
+  ASSERT_EQ(fragments.size(), 10);
+  for (auto const &fragment : fragments)
+  {
+    EXPECT_EQ(fragment.size(), coder.FragmentSize(message.size()));
+  }
+
+  for (uint32_t offset = 0; offset < 7; ++offset)
+  {
+    ErasureCoder::FragmentMap subset{};
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+      uint32_t const index = (offset + (i * 2)) % 10;
+      subset.emplace(index, fragments[index]);
+    }
+
+    ConstByteArray output{};
+    ASSERT_TRUE(coder.Decode(subset, message.size(), output));
+    EXPECT_EQ(output, message);
+  }
+}
+
+TEST(ErasureCoderTests, CheckTooFewFragmentsAreRejected)
+{
+  ErasureCoder const coder{3, 7};
+  auto const         message   = GenerateMessage(64);
+  auto const         fragments = coder.Encode(message);
+
+  ErasureCoder::FragmentMap subset{{0, fragments[0]}, {5, fragments[5]}};
+
+  // fragments of the wrong size are ignored
+  subset.emplace(6, fragments[6].SubArray(0, 3));
+
+  ConstByteArray output{};
+  EXPECT_FALSE(coder.Decode(subset, message.size(), output));
+}
+
+TEST(ErasureCoderTests, CheckSmallMessages)
+{
+  ErasureCoder const coder{1, 4};
+
+  for (std::size_t size : {0u, 1u, 2u})
+  {
+    auto const message   = GenerateMessage(size);
+    auto const fragments = coder.Encode(message);
+
+    ConstByteArray output{};
+    ASSERT_TRUE(coder.Decode({{3, fragments[3]}}, message.size(), output));
+    EXPECT_EQ(output, message);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "kademlia/bucket.hpp"
+#include "kademlia/lookup.hpp"
+#include "kademlia/primitives.hpp"
+
+#include "crypto/sha256.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::crypto::SHA256;
+using fetch::muddle::Bucket;
+using fetch::muddle::GetKademliaDistance;
+using fetch::muddle::KademliaAddress;
+using fetch::muddle::KademliaLookup;
+using fetch::muddle::PeerInfo;
+
+using Address   = KademliaLookup::Address;
+using Addresses = std::vector<Address>;
+using Peers     = KademliaLookup::Peers;
+
+constexpr std::size_t PARALLELISM    = 3;
+constexpr std::size_t MAX_CANDIDATES = 8;
+
+Address FakeAddress(uint64_t i)
+{
+  SHA256 hasher;
+  hasher.Update(reinterpret_cast<uint8_t *>(&i), sizeof(uint64_t));
+
+  return hasher.Final();
+}
+
+Peers GeneratePeers(uint64_t begin, uint64_t end)
+{
+  Peers peers{};
+  for (uint64_t i = begin; i < end; ++i)
+  {
+    PeerInfo info{};
+    info.address = FakeAddress(i);
+    info.uri.Parse("tcp://127.0.0.1:" + std::to_string(i));
+
+    peers.push_back(info);
+  }
+
+  return peers;
+}
+
+/// Sort addresses by their distance to the target, closest first
+Addresses SortByDistance(Address const &target, Addresses addresses)
+{
+  auto const target_kad = KademliaAddress::Create(target);
+
+  std::sort(addresses.begin(), addresses.end(), [&target_kad](Address const &a, Address const &b) {
+    return GetKademliaDistance(target_kad, KademliaAddress::Create(a)) <
+           GetKademliaDistance(target_kad, KademliaAddress::Create(b));
+  });
+
+  return addresses;
+}
+
+TEST(KademliaLookupTests, CheckDistanceOrdering)
+{
+  auto const a = KademliaAddress::Create(FakeAddress(1));
+  auto const b = KademliaAddress::Create(FakeAddress(2));
+
+  auto const zero = GetKademliaDistance(a, a);
+  auto const dist = GetKademliaDistance(a, b);
+
+  EXPECT_EQ(Bucket::IdByLogarithm(zero), 0);
+  EXPECT_EQ(Bucket::IdByHamming(zero), 0);
+  EXPECT_GT(Bucket::IdByLogarithm(dist), 0);
+  EXPECT_GT(Bucket::IdByHamming(dist), 0);
+
+  EXPECT_TRUE(zero < dist);
+  EXPECT_FALSE(dist < zero);
+  EXPECT_FALSE(dist < dist);
+
+  // the distance is symmetric
+  auto const reverse = GetKademliaDistance(b, a);
+  EXPECT_FALSE(dist < reverse);
+  EXPECT_FALSE(reverse < dist);
+}
+
+TEST(KademliaLookupTests, CheckQueriesAreBoundedAndOrdered)
+{
+  Address const target = FakeAddress(1000);
+
+  KademliaLookup lookup{target, FakeAddress(0), PARALLELISM, MAX_CANDIDATES};
+  lookup.AddCandidates(GeneratePeers(1, 21));
+  EXPECT_FALSE(lookup.IsComplete());
+
+  Addresses all{};
+  for (auto const &peer : GeneratePeers(1, 21))
+  {
+    all.push_back(peer.address);
+  }
+  auto const expected = SortByDistance(target, all);
+
+  // only the closest peers are queried, and never more than the parallelism at once
+  Addresses queried{};
+  Address   peer{};
+  while (lookup.NextQuery(peer))
+  {
+    queried.push_back(peer);
+  }
+
+  ASSERT_EQ(queried.size(), PARALLELISM);
+  EXPECT_EQ(lookup.num_in_flight(), PARALLELISM);
+  for (std::size_t i = 0; i < PARALLELISM; ++i)
+  {
+    EXPECT_EQ(queried[i], expected[i]);
+  }
+
+  // a failed query frees a slot for the next closest candidate
+  lookup.OnFailure(queried[0]);
+  ASSERT_TRUE(lookup.NextQuery(peer));
+  EXPECT_EQ(peer, expected[PARALLELISM]);
+  EXPECT_FALSE(lookup.NextQuery(peer));
+}
+
+TEST(KademliaLookupTests, CheckLookupCompletesWithoutTarget)
+{
+  Address const target = FakeAddress(1000);
+
+  KademliaLookup lookup{target, FakeAddress(0), PARALLELISM, MAX_CANDIDATES};
+  lookup.AddCandidates(GeneratePeers(1, 21));
+
+  Address peer{};
+  while (lookup.NextQuery(peer))
+  {
+    // every peer returns the same set of (already known) peers
+    lookup.OnResponse(peer, GeneratePeers(1, 21));
+  }
+
+  EXPECT_TRUE(lookup.IsComplete());
+  EXPECT_FALSE(lookup.found());
+  EXPECT_EQ(lookup.num_in_flight(), 0);
+  EXPECT_EQ(lookup.num_queried(), MAX_CANDIDATES);
+}
+
+TEST(KademliaLookupTests, CheckLookupFindsTarget)
+{
+  Address const target = FakeAddress(1000);
+
+  KademliaLookup lookup{target, FakeAddress(0), PARALLELISM, MAX_CANDIDATES};
+  lookup.AddCandidates(GeneratePeers(1, 5));
+
+  Address peer{};
+  ASSERT_TRUE(lookup.NextQuery(peer));
+
+  // own address and the target are never queried
+  lookup.OnResponse(peer, GeneratePeers(0, 1));
+  EXPECT_FALSE(lookup.found());
+
+  lookup.OnResponse(peer, GeneratePeers(1000, 1001));
+  EXPECT_TRUE(lookup.found());
+  EXPECT_TRUE(lookup.IsComplete());
+  EXPECT_EQ(lookup.target(), target);
+}
+
+}  // namespace
@@ -18,9 +18,11 @@
 
 #include "crypto/ecdsa.hpp"
 #include "muddle/packet.hpp"
+#include "muddle/packet_pool.hpp"
 
 #include "gmock/gmock.h"
 
+#include <cstdint>
 #include <memory>
 
 class PacketTests : public ::testing::Test
@@ -145,3 +147,44 @@ TEST_F(PacketTests, CheckIndifference)
   EXPECT_TRUE(packet_->IsStamped());
   EXPECT_TRUE(packet_->Verify());
 }
+
+TEST_F(PacketTests, CheckBufferRoundTrip)
+{
+  packet_->Sign(*prover_);
+
+  fetch::byte_array::ByteArray buffer;
+  buffer.Resize(packet_->GetPacketSize());
+  ASSERT_TRUE(Packet::ToBuffer(*packet_, buffer.pointer(), buffer.size()));
+
+  fetch::byte_array::ConstByteArray const const_buffer{buffer};
+
+  Packet packet{};
+  ASSERT_TRUE(Packet::FromBuffer(packet, const_buffer));
+
+  EXPECT_EQ(packet.GetPayload(), response_);
+  EXPECT_EQ(packet.GetService(), 1);
+  EXPECT_EQ(packet.GetChannel(), 2);
+  EXPECT_EQ(packet.GetMessageNum(), 3);
+  EXPECT_TRUE(packet.IsStamped());
+  EXPECT_TRUE(packet.Verify());
+
+  // the payload should reference the input buffer rather than being a copy of it
+  EXPECT_EQ(packet.GetPayload().pointer(), const_buffer.pointer() + Packet::HEADER_SIZE);
+
+  // truncated buffers should be rejected
+  EXPECT_FALSE(Packet::FromBuffer(packet, const_buffer.SubArray(0, Packet::HEADER_SIZE - 1)));
+  EXPECT_FALSE(Packet::FromBuffer(packet, const_buffer.SubArray(0, Packet::HEADER_SIZE + 10)));
+}
+
+TEST_F(PacketTests, CheckPooledPacketsAreReused)
+{
+  auto packet = fetch::muddle::CreatePacket(prover_->identity().identifier(), 0);
+  EXPECT_EQ(packet->GetSender(), prover_->identity().identifier());
+
+  auto const *const first = packet.get();
+  packet.reset();
+
+  // the released block should be handed straight back out again
+  packet = fetch::muddle::CreatePacket();
+  EXPECT_EQ(first, packet.get());
+}
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "packet_verifier.hpp"
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "muddle/packet.hpp"
+
+#include "gmock/gmock.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::muddle::Packet;
+using fetch::muddle::PacketVerifier;
+
+using PacketPtr = std::shared_ptr<Packet>;
+using Prover    = fetch::crypto::ECDSASigner;
+using Result    = std::pair<PacketPtr, bool>;
+using Results   = std::vector<Result>;
+
+class PacketVerifierTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    prover_.GenerateKeys();
+    verifier_ = std::make_unique<PacketVerifier>("TestVerify", 2, 4);
+    verifier_->Start();
+  }
+
+  void TearDown() override
+  {
+    verifier_->Stop();
+    verifier_.reset();
+  }
+
+  PacketPtr CreatePacket(uint16_t counter, bool sign = true)
+  {
+    auto packet = std::make_shared<Packet>(prover_.identity().identifier(), 0);
+    packet->SetService(1);
+    packet->SetChannel(2);
+    packet->SetMessageNum(counter);
+    packet->SetPayload(ConstByteArray{"hello world"});
+
+    if (sign)
+    {
+      packet->Sign(prover_);
+    }
+
+    return packet;
+  }
+
+  void Submit(PacketPtr const &packet)
+  {
+    verifier_->Verify(packet, [this](PacketPtr const &p, bool genuine) {
+      {
+        std::lock_guard<std::mutex> guard(results_lock_);
+        results_.emplace_back(p, genuine);
+      }
+      results_available_.notify_all();
+    });
+  }
+
+  Results WaitForResults(std::size_t count)
+  {
+    std::unique_lock<std::mutex> guard(results_lock_);
+    results_available_.wait_for(guard, std::chrono::seconds{10},
+                                [this, count]() { return results_.size() >= count; });
+    return results_;
+  }
+
+  Prover                          prover_;
+  std::unique_ptr<PacketVerifier> verifier_;
+  std::mutex                      results_lock_;
+  std::condition_variable         results_available_;
+  Results                         results_;
+};
+
+TEST_F(PacketVerifierTests, CheckGenuineAndFraudulentPackets)
+{
+  auto genuine         = CreatePacket(1);
+  auto unsigned_packet = CreatePacket(2, false);
+  auto tampered        = CreatePacket(3);
+  tampered->SetPayload(ConstByteArray{"goodbye world"});
+
+  Submit(genuine);
+  Submit(unsigned_packet);
+  Submit(tampered);
+
+  auto const results = WaitForResults(3);
+  ASSERT_EQ(results.size(), 3u);
+
+  EXPECT_EQ(results[0].first, genuine);
+  EXPECT_TRUE(results[0].second);
+  EXPECT_EQ(results[1].first, unsigned_packet);
+  EXPECT_FALSE(results[1].second);
+  EXPECT_EQ(results[2].first, tampered);
+  EXPECT_FALSE(results[2].second);
+
+  // only the genuine packet should be cached
+  EXPECT_EQ(verifier_->cache_size(), 1u);
+}
+
+TEST_F(PacketVerifierTests, CheckCallbacksAreIssuedInOrder)
+{
+  std::vector<PacketPtr> packets{};
+  for (uint16_t i = 0; i < 50; ++i)
+  {
+    packets.emplace_back(CreatePacket(i, (i % 7) != 0));
+    Submit(packets.back());
+  }
+
+  auto const results = WaitForResults(packets.size());
+  ASSERT_EQ(results.size(), packets.size());
+
+  for (std::size_t i = 0; i < packets.size(); ++i)
+  {
+    EXPECT_EQ(results[i].first, packets[i]);
+    EXPECT_EQ(results[i].second, (i % 7) != 0);
+  }
+}
+
+TEST_F(PacketVerifierTests, CheckDuplicatesAreCached)
+{
+  auto const original = CreatePacket(1);
+
+  ConstByteArray buffer{};
+  {
+    fetch::byte_array::ByteArray raw{};
+    raw.Resize(original->GetPacketSize());
+    ASSERT_TRUE(Packet::ToBuffer(*original, raw.pointer(), raw.size()));
+    buffer = raw;
+  }
+
+  // the same broadcast relayed to us through a number of peers with different TTLs
+  for (uint8_t ttl = 10; ttl < 20; ++ttl)
+  {
+    auto relayed = std::make_shared<Packet>();
+    ASSERT_TRUE(Packet::FromBuffer(*relayed, buffer));
+    relayed->SetTTL(ttl);
+
+    Submit(relayed);
+  }
+
+  auto const results = WaitForResults(10);
+  ASSERT_EQ(results.size(), 10u);
+  for (auto const &result : results)
+  {
+    EXPECT_TRUE(result.second);
+  }
+
+  EXPECT_EQ(verifier_->cache_size(), 1u);
+
+  verifier_->TrimCache(std::chrono::seconds{600});
+  EXPECT_EQ(verifier_->cache_size(), 1u);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  verifier_->TrimCache(std::chrono::milliseconds{1});
+  EXPECT_EQ(verifier_->cache_size(), 0u);
+}
+
+}  // namespace
@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "payload_compressor.hpp"
+#include "routing_message.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/main_serializer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::muddle::PayloadCompressor;
+using fetch::muddle::RoutingMessage;
+using fetch::serializers::MsgPackSerializer;
+
+ConstByteArray GeneratePayload(std::size_t size)
+{
+  std::string text{};
+  for (std::size_t i = 0; text.size() < size; ++i)
+  {
+    text += "{\"from\": \"peer-" + std::to_string(i % 7) + "\", \"amount\": ";
+    text += std::to_string(i * 31) + "}";
+  }
+  text.resize(size);
+
+  return {text};
+}
+
+TEST(PayloadCompressorTests, CheckRoundTrip)
+{
+  PayloadCompressor const compressor{};
+  EXPECT_EQ(compressor.dictionary_id(), PayloadCompressor::NO_DICTIONARY);
+
+  auto const payload = GeneratePayload(4096);
+
+  ConstByteArray compressed{};
+  ASSERT_TRUE(compressor.Compress(payload, true, compressed));
+  EXPECT_LT(compressed.size(), payload.size());
+
+  ConstByteArray decompressed{};
+  ASSERT_TRUE(compressor.Decompress(compressed, decompressed));
+  EXPECT_EQ(decompressed, payload);
+}
+
+TEST(PayloadCompressorTests, CheckIncompressiblePayloadIsNotCompressed)
+{
+  PayloadCompressor const compressor{};
+
+  ConstByteArray compressed{};
+  EXPECT_FALSE(compressor.Compress(ConstByteArray{"abc"}, false, compressed));
+}
+
+TEST(PayloadCompressorTests, CheckDictionaryMustMatch)
+{
+  ConstByteArray const dictionary = GeneratePayload(2048);
+
+  PayloadCompressor const with_dictionary{dictionary};
+  PayloadCompressor const without_dictionary{};
+  EXPECT_NE(with_dictionary.dictionary_id(), PayloadCompressor::NO_DICTIONARY);
+
+  auto const payload = GeneratePayload(1500);
+
+  ConstByteArray compressed{};
+  ASSERT_TRUE(with_dictionary.Compress(payload, true, compressed));
+
+  ConstByteArray decompressed{};
+  EXPECT_FALSE(without_dictionary.Decompress(compressed, decompressed));
+  ASSERT_TRUE(with_dictionary.Decompress(compressed, decompressed));
+  EXPECT_EQ(decompressed, payload);
+}
+
+TEST(PayloadCompressorTests, CheckOversizedPayloadsAreRejected)
+{
+  PayloadCompressor const compressor{};
+
+  ConstByteArray compressed{};
+  ASSERT_TRUE(compressor.Compress(GeneratePayload(4096), false, compressed));
+
+  // claim a decompressed size far larger than the block could possibly produce
+  ByteArray tampered = compressed.Copy();
+  uint32_t  size     = 0xFFFFFFFFu;
+  std::memcpy(tampered.pointer() + sizeof(uint8_t), &size, sizeof(size));
+
+  ConstByteArray decompressed{};
+  EXPECT_FALSE(compressor.Decompress(tampered, decompressed));
+  EXPECT_FALSE(compressor.Decompress(compressed.SubArray(0, 3), decompressed));
+}
+
+TEST(PayloadCompressorTests, CheckCapabilitiesAreSerialized)
+{
+  RoutingMessage msg{};
+  msg.type          = RoutingMessage::Type::PONG;
+  msg.compression   = true;
+  msg.dictionary_id = 0x0123456789abcdefull;
+
+  MsgPackSerializer serializer{};
+  serializer << msg;
+  serializer.seek(0);
+
+  RoutingMessage output{};
+  serializer >> output;
+
+  EXPECT_EQ(output.type, RoutingMessage::Type::PONG);
+  EXPECT_TRUE(output.compression);
+  EXPECT_EQ(output.dictionary_id, msg.dictionary_id);
+}
+
+}  // namespace
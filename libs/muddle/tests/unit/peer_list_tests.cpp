@@ -36,7 +36,7 @@ namespace muddle {
 struct DevNull : public network::AbstractConnection
 {
   void Send(network::MessageBuffer const & /*type*/, Callback const & /*success*/,
-            Callback const & /*fail*/) override
+            Callback const & /*fail*/, network::MessagePriority /*priority*/) override
   {}
 
   uint16_t Type() const override
@@ -103,3 +103,51 @@ TEST_F(PeerConnectionListTests, CheckDisconnect)
   peer_list_.Disconnect(peer_);
   EXPECT_EQ(peer_list_.GetStateForPeer(peer_), ConnectionState::UNKNOWN);
 }
+
+TEST_F(PeerConnectionListTests, PeersAreConnectedToInOrderOfPriority)
+{
+  Uri const low{Peer{"127.0.0.1", 1000}};
+  Uri const medium{Peer{"127.0.0.1", 1001}};
+  Uri const high{Peer{"127.0.0.1", 1002}};
+
+  EXPECT_TRUE(peer_list_.AddPersistentPeer(low, 0.1));
+  EXPECT_TRUE(peer_list_.AddPersistentPeer(medium, 0.5));
+  EXPECT_TRUE(peer_list_.AddPersistentPeer(high));
+  EXPECT_FALSE(peer_list_.AddPersistentPeer(low, 0.9));
+
+  EXPECT_EQ(peer_list_.GetPeersToConnectTo(),
+            (PeerConnectionList::PeerList{high, low, medium}));
+  EXPECT_EQ(peer_list_.GetPeersToConnectTo(2), (PeerConnectionList::PeerList{high, low}));
+}
+
+TEST_F(PeerConnectionListTests, PendingConnectionsAreLimited)
+{
+  Uri const first{Peer{"127.0.0.1", 1000}};
+  Uri const second{Peer{"127.0.0.1", 1001}};
+
+  peer_list_.AddPersistentPeer(first);
+  peer_list_.AddPersistentPeer(second, 0.5);
+
+  // the attempt to connect to the first peer is pending
+  peer_list_.AddConnection(first, connection_);
+  EXPECT_TRUE(peer_list_.GetPeersToConnectTo(1).empty());
+  EXPECT_EQ(peer_list_.GetPeersToConnectTo(2), (PeerConnectionList::PeerList{second}));
+
+  peer_list_.OnConnectionEstablished(first);
+  EXPECT_EQ(peer_list_.GetPeersToConnectTo(1), (PeerConnectionList::PeerList{second}));
+}
+
+TEST_F(PeerConnectionListTests, FailedPeersBackOff)
+{
+  peer_list_.AddPersistentPeer(peer_);
+  peer_list_.AddConnection(peer_, connection_);
+  peer_list_.RemoveConnection(peer_);
+
+  PeerConnectionList::PeerMetadata metadata;
+  ASSERT_TRUE(peer_list_.GetMetadataForPeer(peer_, metadata));
+  EXPECT_EQ(metadata.consecutive_failures, 1);
+  EXPECT_GE(metadata.retry_delay, std::chrono::seconds{1});
+  EXPECT_LE(metadata.retry_delay, std::chrono::seconds{2});
+
+  EXPECT_TRUE(peer_list_.GetPeersToConnectTo().empty());
+}
@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "muddle/question_struct.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::muddle::QuestionDelta;
+using fetch::muddle::QuestionStruct;
+
+using Prover          = fetch::crypto::ECDSASigner;
+using ProverPtr       = std::shared_ptr<Prover>;
+using Questions       = std::vector<QuestionStruct>;
+using Confirmed       = std::set<std::pair<ConstByteArray, ConstByteArray>>;
+using ConfirmedByNode = std::vector<Confirmed>;
+
+constexpr std::size_t NUM_MEMBERS = 5;
+constexpr uint32_t    THRESHOLD   = 3;
+
+class QuestionStructTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    for (std::size_t i = 0; i < NUM_MEMBERS; ++i)
+    {
+      auto prover = std::make_shared<Prover>();
+      prover->GenerateKeys();
+
+      cabinet_.insert(prover->identity().identifier());
+      provers_.push_back(prover);
+    }
+  }
+
+  Questions CreateQuestions(ConstByteArray const &question)
+  {
+    Questions questions{};
+    for (std::size_t i = 0; i < NUM_MEMBERS; ++i)
+    {
+      questions.emplace_back(question, "answer " + std::to_string(i), provers_[i], cabinet_);
+    }
+
+    return questions;
+  }
+
+  static void Record(Confirmed &confirmed, QuestionStruct::ConfirmedAnswers const &answers)
+  {
+    for (auto const &answer : answers)
+    {
+      EXPECT_TRUE(confirmed.emplace(answer.first, answer.second).second);
+    }
+  }
+
+  QuestionStruct::CabinetMembers cabinet_{};
+  std::vector<ProverPtr>         provers_{};
+};
+
+TEST_F(QuestionStructTests, CheckDeltaSyncMatchesFullSync)
+{
+  auto full  = CreateQuestions("question");
+  auto delta = CreateQuestions("question");
+
+  ConfirmedByNode full_confirmed(NUM_MEMBERS);
+  ConfirmedByNode delta_confirmed(NUM_MEMBERS);
+
+  // the version of each peer's table which each node has received
+  std::vector<std::vector<uint64_t>> versions(NUM_MEMBERS, std::vector<uint64_t>(NUM_MEMBERS));
+
+  for (std::size_t round = 0; round < 3; ++round)
+  {
+    for (std::size_t i = 0; i < NUM_MEMBERS; ++i)
+    {
+      for (std::size_t j = 0; j < NUM_MEMBERS; ++j)
+      {
+        if (i == j)
+        {
+          continue;
+        }
+
+        Record(full_confirmed[i], full[i].Update(THRESHOLD, full[j]));
+
+        auto const changes = delta[j].GetDelta(versions[i][j]);
+        Record(delta_confirmed[i], delta[i].Update(THRESHOLD, changes));
+        versions[i][j] = changes.version;
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < NUM_MEMBERS; ++i)
+  {
+    EXPECT_EQ(delta[i].table_, full[i].table_);
+    EXPECT_EQ(delta_confirmed[i], full_confirmed[i]);
+
+    // every other member's answer has been confirmed
+    EXPECT_EQ(delta_confirmed[i].size(), NUM_MEMBERS - 1);
+  }
+}
+
+TEST_F(QuestionStructTests, CheckDeltaOnlyContainsChanges)
+{
+  auto questions = CreateQuestions("question");
+
+  auto &first  = questions[0];
+  auto &second = questions[1];
+
+  // initially only our own answer is known
+  auto const initial = first.GetDelta(0);
+  ASSERT_EQ(initial.table.size(), 1);
+  EXPECT_EQ(QuestionStruct::GetAnswer(initial.table.at(first.self_)), "answer 0");
+
+  // nothing has changed since
+  EXPECT_TRUE(first.GetDelta(initial.version).table.empty());
+
+  first.Update(THRESHOLD, second.GetDelta(0));
+
+  auto const changes = first.GetDelta(initial.version);
+  EXPECT_GT(changes.version, initial.version);
+  ASSERT_EQ(changes.table.size(), 1);
+
+  // the answer of the second member along with the proofs of it having been seen
+  auto const &entry = changes.table.at(second.self_);
+  EXPECT_EQ(QuestionStruct::GetAnswer(entry), "answer 1");
+  EXPECT_EQ(QuestionStruct::GetSeen(entry).size(), 2);
+
+  // a further seen proof only carries that proof, not the answer again
+  questions[2].Update(THRESHOLD, second.GetDelta(0));
+  first.Update(THRESHOLD, questions[2].GetDelta(0));
+
+  auto const seen_only = first.GetDelta(changes.version);
+  ASSERT_EQ(seen_only.table.count(second.self_), 1);
+
+  auto const &seen_entry = seen_only.table.at(second.self_);
+  EXPECT_TRUE(QuestionStruct::GetAnswer(seen_entry).empty());
+  EXPECT_EQ(QuestionStruct::GetSeen(seen_entry).size(), 1);
+  EXPECT_EQ(QuestionStruct::GetSeen(seen_entry).count(questions[2].self_), 1);
+}
+
+TEST_F(QuestionStructTests, CheckNonMatchingDeltaIgnored)
+{
+  auto questions = CreateQuestions("question");
+  auto others    = CreateQuestions("other question");
+
+  auto const before = questions[0].GetDelta(0);
+
+  EXPECT_TRUE(questions[0].Update(1, others[1].GetDelta(0)).empty());
+  EXPECT_EQ(questions[0].GetDelta(0).version, before.version);
+  EXPECT_TRUE(QuestionStruct::GetAnswer(questions[0].table_.at(questions[1].self_)).empty());
+}
+
+}  // namespace
@@ -93,3 +93,37 @@ TEST(rbc_messages, answer)
   EXPECT_EQ(answer1.message(), answer.message());
   EXPECT_EQ(answer1.tag(), answer.tag());
 }
+
+TEST(rbc_messages, fragment)
+{
+  RBCFragment fragment{};
+  fragment.index           = 3;
+  fragment.message_size    = 1024;
+  fragment.message_hash    = "hash";
+  fragment.fragment_hashes = {"a", "b", "c", "d"};
+  fragment.data            = "data";
+
+  fetch::serializers::MsgPackSerializer payload_serialiser;
+  payload_serialiser << fragment;
+
+  RFragment msg{1, 1, 1, payload_serialiser.data()};
+
+  fetch::serializers::MsgPackSerializer serialiser{msg.Serialize()};
+
+  fetch::serializers::MsgPackSerializer serialiser1(serialiser.data());
+  RBCMessage                            msg1;
+  serialiser1 >> msg1;
+
+  EXPECT_EQ(msg1.type(), RBCMessageType::R_FRAGMENT);
+  EXPECT_EQ(msg1.tag(), msg.tag());
+
+  fetch::serializers::MsgPackSerializer payload_serialiser1(msg1.message());
+  RBCFragment                           fragment1;
+  payload_serialiser1 >> fragment1;
+
+  EXPECT_EQ(fragment1.index, fragment.index);
+  EXPECT_EQ(fragment1.message_size, fragment.message_size);
+  EXPECT_EQ(fragment1.message_hash, fragment.message_hash);
+  EXPECT_EQ(fragment1.fragment_hashes, fragment.fragment_hashes);
+  EXPECT_EQ(fragment1.data, fragment.data);
+}
@@ -27,9 +27,15 @@
 
 #include "gmock/gmock.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 using fetch::muddle::NetworkId;
 
@@ -170,3 +176,119 @@ TEST_F(SubscriptionManagerTests, MultipleDifferentHandlers)
 
   EXPECT_EQ(dispatches, 5);
 }
+
+TEST_F(SubscriptionManagerTests, AddressHandlerOnly)
+{
+  auto subscription = registrar_->Register(SAMPLE_ADDRESS, 1, 2);
+
+  uint32_t dispatches = 0;
+  subscription->SetMessageHandler([&dispatches](Address const &, uint16_t, uint16_t, uint16_t,
+                                                Packet::Payload const &,
+                                                Address const &) { ++dispatches; });
+
+  EXPECT_TRUE(registrar_->Dispatch(CreatePacket(1, 2, SAMPLE_ADDRESS), Address()));
+  EXPECT_FALSE(registrar_->Dispatch(CreatePacket(1, 2), Address()));
+  EXPECT_FALSE(registrar_->Dispatch(CreatePacket(1, 3, SAMPLE_ADDRESS), Address()));
+
+  EXPECT_EQ(dispatches, 1);
+}
+
+TEST_F(SubscriptionManagerTests, AsyncHandlerDoesNotBlockDispatch)
+{
+  auto slow = registrar_->Register(1, 2);
+  auto fast = registrar_->Register(1, 3);
+
+  slow->EnableAsyncDispatch(16);
+  EXPECT_TRUE(slow->IsAsync());
+  EXPECT_FALSE(fast->IsAsync());
+
+  // the slow handler is blocked until the end of the test
+  std::mutex              lock;
+  std::condition_variable cv;
+  bool                    release = false;
+  std::vector<uint16_t>   received;
+
+  slow->SetMessageHandler([&](Address const &, uint16_t, uint16_t, uint16_t counter,
+                              Packet::Payload const &, Address const &) {
+    std::unique_lock<std::mutex> guard(lock);
+    cv.wait(guard, [&release]() { return release; });
+    received.push_back(counter);
+  });
+
+  uint32_t fast_dispatches = 0;
+  fast->SetMessageHandler([&fast_dispatches](Address const &, uint16_t, uint16_t, uint16_t,
+                                             Packet::Payload const &,
+                                             Address const &) { ++fast_dispatches; });
+
+  for (uint16_t i = 0; i < 4; ++i)
+  {
+    auto packet = CreatePacket(1, 2);
+    packet->SetMessageNum(i);
+
+    EXPECT_TRUE(registrar_->Dispatch(packet, Address()));
+    EXPECT_TRUE(registrar_->Dispatch(CreatePacket(1, 3), Address()));
+  }
+
+  EXPECT_EQ(fast_dispatches, 4);
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    release = true;
+  }
+  cv.notify_all();
+
+  // the messages are delivered to the slow handler in order
+  for (std::size_t i = 0; i < 500; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (received.size() == 4)
+      {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  EXPECT_EQ(received, (std::vector<uint16_t>{0, 1, 2, 3}));
+  EXPECT_EQ(slow->dropped_count(), 0);
+}
+
+TEST_F(SubscriptionManagerTests, AsyncQueueIsBounded)
+{
+  auto subscription = registrar_->Register(1, 2);
+  subscription->EnableAsyncDispatch(2);
+
+  std::atomic<bool>     release{false};
+  std::atomic<uint32_t> dispatches{0};
+  subscription->SetMessageHandler([&](Address const &, uint16_t, uint16_t, uint16_t,
+                                      Packet::Payload const &, Address const &) {
+    while (!release)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    ++dispatches;
+  });
+
+  auto packet = CreatePacket(1, 2);
+
+  // wait for the worker to be blocked on the first message
+  registrar_->Dispatch(packet, Address());
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    registrar_->Dispatch(packet, Address());
+  }
+
+  EXPECT_EQ(subscription->dropped_count(), 3);
+
+  release = true;
+  for (std::size_t i = 0; (i < 500) && (dispatches < 3); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  }
+
+  EXPECT_EQ(dispatches, 3);
+}
@@ -0,0 +1,301 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/details/thread_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::network::MakeThreadPool;
+using fetch::network::ThreadPool;
+
+constexpr std::size_t BATCH_SIZE = 10000;
+
+/**
+ * Reference implementation of the previous dispatch model: a single FIFO of std::function work
+ * items shared by all the threads and guarded by one mutex / condition pair.
+ */
+class CentralQueuePool
+{
+public:
+  using WorkItem = std::function<void()>;
+
+  explicit CentralQueuePool(std::size_t num_threads)
+  {
+    for (std::size_t i = 0; i < num_threads; ++i)
+    {
+      threads_.emplace_back([this]() { Run(); });
+    }
+  }
+
+  ~CentralQueuePool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+    }
+
+    work_available_.notify_all();
+
+    for (auto &thread : threads_)
+    {
+      thread.join();
+    }
+  }
+
+  void Post(WorkItem item)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.emplace_back(std::move(item));
+    }
+
+    work_available_.notify_one();
+  }
+
+private:
+  void Run()
+  {
+    for (;;)
+    {
+      WorkItem item;
+
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_available_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+
+        if (queue_.empty())
+        {
+          return;
+        }
+
+        item = std::move(queue_.front());
+        queue_.pop_front();
+      }
+
+      item();
+    }
+  }
+
+  std::mutex               mutex_;
+  std::condition_variable  work_available_;
+  std::deque<WorkItem>     queue_;
+  bool                     running_{true};
+  std::vector<std::thread> threads_;
+};
+
+/**
+ * Simple countdown used to wait for a batch of work items to be executed
+ */
+class Latch
+{
+public:
+  void Reset(std::size_t count)
+  {
+    remaining_ = count;
+  }
+
+  void CountDown()
+  {
+    if (--remaining_ == 0)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      complete_.notify_all();
+    }
+  }
+
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    complete_.wait(lock, [this]() { return remaining_ == 0; });
+  }
+
+private:
+  std::atomic<std::size_t> remaining_{0};
+  std::mutex               mutex_;
+  std::condition_variable  complete_;
+};
+
+/**
+ * Representative closure: a shared pointer plus a couple of values, as posted by the muddle and
+ * the execution manager
+ */
+struct Payload
+{
+  std::shared_ptr<Latch> latch;
+  std::size_t            index;
+  std::size_t            value;
+
+  void operator()() const
+  {
+    benchmark::DoNotOptimize(index * value);
+    latch->CountDown();
+  }
+};
+
+ThreadPool StartPool(std::size_t num_threads)
+{
+  auto pool = MakeThreadPool(num_threads, "bench");
+  pool->Start();
+  return pool;
+}
+
+void ThreadPool_CentralQueue_Post(benchmark::State &state)
+{
+  auto const       num_threads = static_cast<std::size_t>(state.range(0));
+  CentralQueuePool pool{num_threads};
+  auto             latch = std::make_shared<Latch>();
+
+  for (auto _ : state)
+  {
+    latch->Reset(BATCH_SIZE);
+
+    for (std::size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+      pool.Post(Payload{latch, i, 2});
+    }
+
+    latch->Wait();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE));
+}
+
+void ThreadPool_WorkStealing_Post(benchmark::State &state)
+{
+  auto const num_threads = static_cast<std::size_t>(state.range(0));
+  auto       pool        = StartPool(num_threads);
+  auto       latch       = std::make_shared<Latch>();
+
+  for (auto _ : state)
+  {
+    latch->Reset(BATCH_SIZE);
+
+    for (std::size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+      pool->Post(Payload{latch, i, 2});
+    }
+
+    latch->Wait();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE));
+
+  pool->Stop();
+}
+
+void ThreadPool_WorkStealing_PostWithAffinity(benchmark::State &state)
+{
+  auto const num_threads = static_cast<std::size_t>(state.range(0));
+  auto       pool        = StartPool(num_threads);
+  auto       latch       = std::make_shared<Latch>();
+
+  for (auto _ : state)
+  {
+    latch->Reset(BATCH_SIZE);
+
+    for (std::size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+      pool->PostWithAffinity(i, Payload{latch, i, 2});
+    }
+
+    latch->Wait();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE));
+
+  pool->Stop();
+}
+
+void ThreadPool_CentralQueue_Nested(benchmark::State &state)
+{
+  auto const       num_threads = static_cast<std::size_t>(state.range(0));
+  CentralQueuePool pool{num_threads};
+  auto             latch = std::make_shared<Latch>();
+
+  std::size_t const fan_out = BATCH_SIZE / num_threads;
+
+  for (auto _ : state)
+  {
+    latch->Reset(fan_out * num_threads);
+
+    // each seed task posts its own follow on work, as the muddle does when handling packets
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+      pool.Post([&pool, latch, fan_out]() {
+        for (std::size_t i = 0; i < fan_out; ++i)
+        {
+          pool.Post(Payload{latch, i, 2});
+        }
+      });
+    }
+
+    latch->Wait();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * fan_out * num_threads));
+}
+
+void ThreadPool_WorkStealing_Nested(benchmark::State &state)
+{
+  auto const num_threads = static_cast<std::size_t>(state.range(0));
+  auto       pool        = StartPool(num_threads);
+  auto       latch       = std::make_shared<Latch>();
+
+  std::size_t const fan_out = BATCH_SIZE / num_threads;
+
+  for (auto _ : state)
+  {
+    latch->Reset(fan_out * num_threads);
+
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+      pool->Post([&pool, latch, fan_out]() {
+        for (std::size_t i = 0; i < fan_out; ++i)
+        {
+          pool->Post(Payload{latch, i, 2});
+        }
+      });
+    }
+
+    latch->Wait();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * fan_out * num_threads));
+
+  pool->Stop();
+}
+
+}  // namespace
+
+BENCHMARK(ThreadPool_CentralQueue_Post)->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK(ThreadPool_WorkStealing_Post)->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK(ThreadPool_WorkStealing_PostWithAffinity)->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK(ThreadPool_CentralQueue_Nested)->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK(ThreadPool_WorkStealing_Nested)->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
@@ -18,25 +18,27 @@
 //------------------------------------------------------------------------------
 
 #include "core/mutex.hpp"
+#include "network/details/timer_wheel.hpp"
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace network {
 namespace details {
 
 /**
- * The future work store is a simple priority queue of work items. These work items are
- * stored alongside a due timestamp. The priority / order of the queue is determined by
- * these timestamps
+ * The future work store holds work items until a due time has been reached. The items are kept
+ * in a hierarchical timer wheel with a resolution of one millisecond, so that adding and
+ * cancelling an item is O(1) regardless of the number of pending items.
  */
 class FutureWorkStore
 {
@@ -44,6 +46,9 @@ public:
   static constexpr char const *LOGGING_NAME = "FutureWorkStore";
 
   using WorkItem = std::function<void()>;
+  using Handle   = TimerWheel<WorkItem>::Handle;
+
+  static constexpr Handle INVALID_HANDLE = TimerWheel<WorkItem>::INVALID_HANDLE;
 
   // Construction / Destruction
   FutureWorkStore()                           = default;
@@ -69,14 +74,11 @@ public:
   void Clear()
   {
     FETCH_LOCK(queue_mutex_);
-    while (!queue_.empty())
-    {
-      queue_.pop();
-    }
+    wheel_.Clear();
   }
 
   /**
-   * Extract and dispatch a single item from the queue
+   * Extract and dispatch all the items from the queue which are due
    *
    * @tparam CALLBACK The type of the callable accepting the signature: void(WorkItem const &)
    * @param visitor The dispatching function
@@ -85,41 +87,26 @@ public:
   template <typename CALLBACK>
   std::size_t Dispatch(CALLBACK const &visitor)
   {
-    std::size_t num_processed = 0;
-
-    Timestamp const now = Clock::now();
-
-    WorkItem item;
+    std::vector<WorkItem> items{};
 
     {
       // allow early exit
       std::unique_lock<Mutex> lock(queue_mutex_, std::try_to_lock);
-      if (lock.owns_lock())
+      if (!lock.owns_lock())
       {
-        // empty loop condition
-        if (!queue_.empty())
-        {
-          Element const &next = queue_.top();
-          if (next.due <= now)
-          {
-            item = next.item;
-            queue_.pop();
-          }
-        }
+        return 0;
       }
 
-      // dispatch all the work items
-      if (item)
-      {
-        // dispatch the work item
-        visitor(item);
+      wheel_.Advance(Now(), [&items](WorkItem &&item) { items.emplace_back(std::move(item)); });
+    }
 
-        // increment the counter
-        ++num_processed;
-      }
+    // dispatch the work items outside of the lock
+    for (auto const &item : items)
+    {
+      visitor(item);
     }
 
-    return num_processed;
+    return items.size();
   }
 
   /**
@@ -127,20 +114,32 @@ public:
    *
    * @param item The work item to be added to the queue
    * @param milliseconds The delay in milliseconds before this work item is scheduled
+   * @return The handle used to cancel the work item, INVALID_HANDLE if it was rejected
    */
-  void Post(WorkItem item, uint32_t milliseconds)
+  Handle Post(WorkItem item, uint32_t milliseconds)
   {
     // reject further work if we are in the process of shutting down
     if (shutdown_)
     {
-      return;
+      return INVALID_HANDLE;
     }
 
-    // add it to the queue
-    {
-      FETCH_LOCK(queue_mutex_);
-      queue_.emplace(std::move(item), milliseconds);
-    }
+    Tick const due = Now() + milliseconds;
+
+    FETCH_LOCK(queue_mutex_);
+    return wheel_.Add(std::move(item), due);
+  }
+
+  /**
+   * Cancel a pending work item
+   *
+   * @param handle The handle returned when the work item was posted
+   * @return true if the work item was pending and has been removed, otherwise false
+   */
+  bool Cancel(Handle handle)
+  {
+    FETCH_LOCK(queue_mutex_);
+    return wheel_.Cancel(handle);
   }
 
   /**
@@ -151,27 +150,27 @@ public:
    */
   std::chrono::milliseconds TimeUntilNextItem()
   {
-    using std::chrono::duration_cast;
     using std::chrono::milliseconds;
 
-    Timestamp const now = Clock::now();
+    Tick next{Wheel::NEVER};
 
     {
       FETCH_LOCK(queue_mutex_);
-      if (!queue_.empty())
-      {
-        Element const &element = queue_.top();
+      next = wheel_.NextExpiry();
+    }
 
-        if (element.due > now)
-        {
-          return duration_cast<milliseconds>(element.due - now);
-        }
+    if (next == Wheel::NEVER)
+    {
+      return milliseconds::max();
+    }
 
-        return milliseconds::zero();
-      }
+    Tick const now = Now();
+    if (next <= now)
+    {
+      return milliseconds::zero();
     }
 
-    return milliseconds::max();
+    return milliseconds(next - now);
   }
 
   // Operators
@@ -179,30 +178,24 @@ public:
   FutureWorkStore operator=(FutureWorkStore &&rhs) = delete;
 
 private:
-  using Clock     = std::chrono::system_clock;
+  using Clock     = std::chrono::steady_clock;
   using Timestamp = Clock::time_point;
+  using Wheel     = TimerWheel<WorkItem>;
+  using Tick      = Wheel::Tick;
+  using Flag      = std::atomic<bool>;
 
-  struct Element
+  /**
+   * The current tick of the wheel: the number of milliseconds since the store was created
+   */
+  Tick Now() const
   {
-    WorkItem  item;
-    Timestamp due;
-
-    Element(WorkItem i, uint32_t delay_ms)
-      : item(std::move(i))
-      , due{Clock::now() + std::chrono::milliseconds(delay_ms)}
-    {}
-
-    bool operator<(Element const &other) const
-    {
-      return due < other.due;
-    }
-  };
-
-  using Queue = std::priority_queue<Element>;
-  using Flag  = std::atomic<bool>;
+    return static_cast<Tick>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - epoch_).count());
+  }
 
-  mutable Mutex queue_mutex_;  ///< Mutex protecting `queue_`
-  Queue         queue_;        ///< Ordered queue of work items
+  Timestamp const epoch_{Clock::now()};  ///< The reference time of the wheel ticks
+  mutable Mutex   queue_mutex_;          ///< Mutex protecting `wheel_`
+  Wheel           wheel_;                ///< The pending work items
 
   // Shutdown flag this is designed to only ever be set to true. User will have to recreate the
   // whole thread pool with current implementation.
@@ -0,0 +1,227 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace fetch {
+namespace network {
+namespace details {
+
+/**
+ * Move-only, type erased `void()` callable used for the thread pool work queues.
+ *
+ * Unlike `std::function` the task stores callables of up to `INLINE_SIZE` bytes directly inside
+ * the object, which covers the typical closure of a few pointers and a `shared_ptr`. Larger (or
+ * throwing-move) callables fall back to a single heap allocation. Being move-only also allows
+ * closures to capture move-only state.
+ */
+class Task
+{
+public:
+  static constexpr std::size_t INLINE_SIZE = 6 * sizeof(void *);
+
+  // Construction / Destruction
+  Task() = default;
+
+  template <typename Callable, typename = std::enable_if_t<
+                                   !std::is_same<std::decay_t<Callable>, Task>::value>>
+  Task(Callable &&callable);  // NOLINT - implicit to mirror std::function
+  Task(Task const &) = delete;
+  Task(Task &&other) noexcept;
+  ~Task();
+
+  /**
+   * Determine if the task holds a callable
+   *
+   * @return true if a callable is present, otherwise false
+   */
+  explicit operator bool() const
+  {
+    return ops_ != nullptr;
+  }
+
+  /**
+   * Execute the stored callable. The task must not be empty.
+   */
+  void operator()()
+  {
+    ops_->invoke(&storage_);
+  }
+
+  void Reset();
+
+  // Operators
+  Task &operator=(Task const &) = delete;
+  Task &operator=(Task &&other) noexcept;
+
+private:
+  using Storage = std::aligned_storage_t<INLINE_SIZE, alignof(std::max_align_t)>;
+
+  struct Operations
+  {
+    void (*invoke)(void *storage);
+    void (*relocate)(void *from, void *to) noexcept;
+    void (*destroy)(void *storage) noexcept;
+  };
+
+  template <typename Callable>
+  static constexpr bool IsInline()
+  {
+    return (sizeof(Callable) <= sizeof(Storage)) &&
+           (alignof(Callable) <= alignof(Storage)) &&
+           std::is_nothrow_move_constructible<Callable>::value;
+  }
+
+  template <typename Type, typename Callable>
+  void Emplace(Callable &&callable, std::true_type is_inline);
+  template <typename Type, typename Callable>
+  void Emplace(Callable &&callable, std::false_type is_inline);
+
+  template <typename Callable>
+  struct InlineOperations
+  {
+    static void Invoke(void *storage)
+    {
+      (*static_cast<Callable *>(storage))();
+    }
+
+    static void Relocate(void *from, void *to) noexcept
+    {
+      auto *source = static_cast<Callable *>(from);
+      new (to) Callable(std::move(*source));
+      source->~Callable();
+    }
+
+    static void Destroy(void *storage) noexcept
+    {
+      static_cast<Callable *>(storage)->~Callable();
+    }
+
+    static constexpr Operations VTABLE{&Invoke, &Relocate, &Destroy};
+  };
+
+  template <typename Callable>
+  struct HeapOperations
+  {
+    static Callable *&Pointer(void *storage)
+    {
+      return *static_cast<Callable **>(storage);
+    }
+
+    static void Invoke(void *storage)
+    {
+      (*Pointer(storage))();
+    }
+
+    static void Relocate(void *from, void *to) noexcept
+    {
+      new (to) Callable *(Pointer(from));
+    }
+
+    static void Destroy(void *storage) noexcept
+    {
+      delete Pointer(storage);
+    }
+
+    static constexpr Operations VTABLE{&Invoke, &Relocate, &Destroy};
+  };
+
+  Storage           storage_;
+  Operations const *ops_{nullptr};
+};
+
+template <typename Callable>
+constexpr Task::Operations Task::InlineOperations<Callable>::VTABLE;
+
+template <typename Callable>
+constexpr Task::Operations Task::HeapOperations<Callable>::VTABLE;
+
+template <typename Callable, typename>
+Task::Task(Callable &&callable)
+{
+  using Type = std::decay_t<Callable>;
+
+  Emplace<Type>(std::forward<Callable>(callable),
+                std::integral_constant<bool, IsInline<Type>()>{});
+}
+
+template <typename Type, typename Callable>
+void Task::Emplace(Callable &&callable, std::true_type /*is_inline*/)
+{
+  new (&storage_) Type(std::forward<Callable>(callable));
+  ops_ = &InlineOperations<Type>::VTABLE;
+}
+
+template <typename Type, typename Callable>
+void Task::Emplace(Callable &&callable, std::false_type /*is_inline*/)
+{
+  new (&storage_) Type *(new Type(std::forward<Callable>(callable)));
+  ops_ = &HeapOperations<Type>::VTABLE;
+}
+
+inline Task::Task(Task &&other) noexcept
+  : ops_{other.ops_}
+{
+  if (ops_)
+  {
+    ops_->relocate(&other.storage_, &storage_);
+    other.ops_ = nullptr;
+  }
+}
+
+inline Task::~Task()
+{
+  Reset();
+}
+
+/**
+ * Destroy the stored callable (if any) leaving the task empty
+ */
+inline void Task::Reset()
+{
+  if (ops_)
+  {
+    ops_->destroy(&storage_);
+    ops_ = nullptr;
+  }
+}
+
+inline Task &Task::operator=(Task &&other) noexcept
+{
+  if (this != &other)
+  {
+    Reset();
+
+    if (other.ops_)
+    {
+      other.ops_->relocate(&other.storage_, &storage_);
+      ops_       = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  return *this;
+}
+
+}  // namespace details
+}  // namespace network
+}  // namespace fetch
@@ -17,10 +17,12 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/cpu_topology.hpp"
 #include "core/mutex.hpp"
 #include "core/synchronisation/protected.hpp"
 #include "network/details/future_work_store.hpp"
 #include "network/details/idle_work_store.hpp"
+#include "network/details/task.hpp"
 #include "network/details/work_store.hpp"
 
 #include <atomic>
@@ -43,12 +45,18 @@ namespace details {
  * The application thread pool at a conceptual level is a simple set queue of ordered
  * work queues.
  *
- * The main work queue is a FIFO based model and these jobs are extracted by the dispatch
- * threads.
+ * The main work queue is split into one FIFO queue per dispatch thread. Work posted from a
+ * dispatch thread is placed on that thread's own queue, work posted from outside the pool is
+ * distributed round robin over the queues and work posted with an affinity hint is placed on the
+ * queue selected by the hint. Each thread services its own queue first and, once that is empty,
+ * steals work from the back of the other threads' queues. Affinity is therefore only a hint: it
+ * keeps related work on the same thread while that thread keeps up, without letting the work
+ * stall if it does not.
  *
- * The other work queue is the future work queue. These jobs are ordered by due time and
+ * The other work queue is the future work queue. These jobs are held in a timer wheel and
  * once the due time has been reached they are placed at the end of the work queue. Users
- * should note that the due timestamp can be thought of as the mimimum schedule time.
+ * should note that the due timestamp can be thought of as the mimimum schedule time. Future
+ * work can be cancelled with the handle returned when it was posted.
  *
  * The third queue is an "idle" work store. This is probably better thought of as a
  * periodic or reoccuring work. Work from this store is executed directly. The design of
@@ -80,6 +88,8 @@ public:
 
   using ThreadPoolPtr = std::shared_ptr<ThreadPoolImplementation>;
   using WorkItem      = std::function<void()>;
+  using Task          = details::Task;
+  using FutureHandle  = FutureWorkStore::Handle;
 
   explicit ThreadPoolImplementation(std::size_t threads, std::string name);
   ThreadPoolImplementation(ThreadPoolImplementation const &) = delete;
@@ -88,8 +98,10 @@ public:
 
   /// @name Current / Future Work
   /// @{
-  void Post(WorkItem item, uint32_t milliseconds);
-  void Post(WorkItem item);
+  FutureHandle Post(WorkItem item, uint32_t milliseconds);
+  bool         Cancel(FutureHandle handle);
+  void         Post(Task item);
+  void         PostWithAffinity(std::size_t affinity, Task item);
   /// @}
 
   /// @name Idle / Background tasks
@@ -98,6 +110,11 @@ public:
   void SetIdleInterval(std::size_t milliseconds);
   /// @}
 
+  /// @name Thread placement
+  /// @{
+  void SetAffinity(std::vector<core::CpuList> affinity);
+  /// @}
+
   /// @name Thread pool control
   /// @{
   void Start();
@@ -115,24 +132,34 @@ public:
   ThreadPoolImplementation &operator=(ThreadPoolImplementation &&) = delete;
 
 private:
-  using ThreadPtr  = std::shared_ptr<std::thread>;
-  using ThreadPool = std::vector<ThreadPtr>;
-  using Flag       = std::atomic<bool>;
-  using Counter    = std::atomic<std::size_t>;
-  using Condition  = std::condition_variable;
+  using ThreadPtr    = std::shared_ptr<std::thread>;
+  using ThreadPool   = std::vector<ThreadPtr>;
+  using Flag         = std::atomic<bool>;
+  using Counter      = std::atomic<std::size_t>;
+  using Condition    = std::condition_variable;
+  using WorkStorePtr = std::unique_ptr<WorkStore>;
+  using WorkQueues   = std::vector<WorkStorePtr>;
+  using Affinity     = std::vector<core::CpuList>;
 
   void ProcessLoop(std::size_t index);
+  void Enqueue(std::size_t index, Task item);
+
+  bool        Poll(std::size_t index);
+  std::size_t DispatchQueuedWork(std::size_t index);
 
-  bool Poll();
-  bool ExecuteWorkload(WorkItem const &workload);
+  template <typename Workload>
+  bool ExecuteWorkload(Workload &workload);
 
   std::size_t const max_threads_;  ///< Config: Max number of threads
+  Affinity          affinity_{};    ///< Config: The CPUs of each thread (empty for any)
 
   Protected<ThreadPool> threads_;  ///< Container of threads
 
-  WorkStore       work_;         ///< The main work queue
-  FutureWorkStore future_work_;  ///< The future work queue
-  IdleWorkStore   idle_work_;    ///< The idle work store
+  WorkQueues      work_;            ///< The per thread work queues
+  Counter         queued_work_{0};  ///< The number of items across all the work queues
+  Counter         next_queue_{0};   ///< Round robin index for work posted outside the pool
+  FutureWorkStore future_work_;     ///< The future work queue
+  IdleWorkStore   idle_work_;       ///< The idle work store
 
   Condition          work_available_;       ///< Work available condition
   mutable std::mutex idle_mutex_;           ///< Associated mutex for condition
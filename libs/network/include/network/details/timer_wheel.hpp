@@ -0,0 +1,486 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace network {
+namespace details {
+
+/**
+ * Hierarchical timer wheel
+ *
+ * Timers are stored in `LEVELS` wheels of `SLOTS` slots each. The slots of level `n` span
+ * `SLOTS^n` ticks, a timer is placed on the lowest level whose slot can still be distinguished
+ * from the current tick. As time advances the slot of a higher level is "cascaded" into the
+ * levels below it once its span is reached, until the timer finally expires from level 0.
+ *
+ * Insertion and cancellation are O(1): the timers of a slot form an intrusive doubly linked list
+ * over a pool of nodes, which are recycled through a free list. An occupancy bitmap per level
+ * allows empty stretches of the wheel to be skipped when advancing and when computing the next
+ * expiry.
+ *
+ * Timers due beyond the range of the wheel are parked in the next slot of the top level and are
+ * placed again each time that slot is cascaded.
+ *
+ * The wheel itself is not thread safe.
+ *
+ * @tparam T The type of the item stored with each timer
+ */
+template <typename T>
+class TimerWheel
+{
+public:
+  using Tick   = uint64_t;
+  using Handle = uint64_t;
+
+  static constexpr std::size_t LEVELS         = 4;
+  static constexpr std::size_t BITS_PER_LEVEL = 6;
+  static constexpr std::size_t SLOTS          = std::size_t{1} << BITS_PER_LEVEL;
+  static constexpr Handle      INVALID_HANDLE = 0;
+  static constexpr Tick        NEVER          = std::numeric_limits<Tick>::max();
+
+  // Construction / Destruction
+  explicit TimerWheel(Tick start = 0)
+    : current_{start}
+  {}
+  TimerWheel(TimerWheel const &) = delete;
+  TimerWheel(TimerWheel &&)      = delete;
+  ~TimerWheel()                  = default;
+
+  Handle Add(T item, Tick due);
+  bool   Cancel(Handle handle);
+  void   Clear();
+
+  template <typename Visitor>
+  std::size_t Advance(Tick now, Visitor &&visitor);
+
+  Tick NextExpiry() const;
+
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+
+  // Operators
+  TimerWheel &operator=(TimerWheel const &) = delete;
+  TimerWheel &operator=(TimerWheel &&) = delete;
+
+private:
+  using Index = uint32_t;
+
+  static constexpr Index       NIL       = std::numeric_limits<Index>::max();
+  static constexpr Tick        SLOT_MASK = SLOTS - 1;
+  static constexpr std::size_t NO_LEVEL  = LEVELS;
+
+  struct Node
+  {
+    T           item{};
+    Tick        due{0};
+    Index       prev{NIL};
+    Index       next{NIL};
+    uint32_t    generation{1};
+    std::size_t level{NO_LEVEL};
+    std::size_t slot{0};
+  };
+
+  struct Level
+  {
+    std::array<Index, SLOTS> heads;
+    uint64_t                 occupied{0};
+
+    Level()
+    {
+      heads.fill(NIL);
+    }
+  };
+
+  static constexpr std::size_t Shift(std::size_t level)
+  {
+    return level * BITS_PER_LEVEL;
+  }
+
+  static Handle MakeHandle(Index index, uint32_t generation)
+  {
+    return (static_cast<Handle>(generation) << 32u) | index;
+  }
+
+  Index Allocate();
+  void  Release(Index index);
+  void  Place(Index index);
+  void  Link(Index index, std::size_t level, std::size_t slot);
+  void  Unlink(Index index);
+  Index Detach(std::size_t level, std::size_t slot);
+  void  Cascade(std::size_t level);
+
+  template <typename Visitor>
+  std::size_t Expire(Visitor &visitor);
+
+  Tick                      current_;  ///< The next tick to be processed
+  std::array<Level, LEVELS> levels_{};   ///< The slots of each level
+  std::vector<Node>         nodes_{};    ///< Pool of timer nodes
+  std::vector<Index>        free_{};     ///< Unused entries of the node pool
+  std::size_t               size_{0};    ///< The number of pending timers
+};
+
+template <typename T>
+constexpr typename TimerWheel<T>::Handle TimerWheel<T>::INVALID_HANDLE;
+
+template <typename T>
+constexpr typename TimerWheel<T>::Tick TimerWheel<T>::NEVER;
+
+template <typename T>
+constexpr typename TimerWheel<T>::Index TimerWheel<T>::NIL;
+
+/**
+ * Add a timer to the wheel
+ *
+ * @param item The item to be returned when the timer expires
+ * @param due The tick at which the timer expires, ticks in the past expire on the next advance
+ * @return The handle which can be used to cancel the timer
+ */
+template <typename T>
+typename TimerWheel<T>::Handle TimerWheel<T>::Add(T item, Tick due)
+{
+  Index const index = Allocate();
+  Node &      node  = nodes_[index];
+
+  node.item = std::move(item);
+  node.due  = std::max(due, current_);
+
+  Place(index);
+  ++size_;
+
+  return MakeHandle(index, node.generation);
+}
+
+/**
+ * Cancel a pending timer
+ *
+ * @param handle The handle returned when the timer was added
+ * @return true if the timer was pending and has been removed, otherwise false
+ */
+template <typename T>
+bool TimerWheel<T>::Cancel(Handle handle)
+{
+  auto const index      = static_cast<Index>(handle & 0xFFFFFFFFu);
+  auto const generation = static_cast<uint32_t>(handle >> 32u);
+
+  if ((index >= nodes_.size()) || (nodes_[index].generation != generation) ||
+      (nodes_[index].level == NO_LEVEL))
+  {
+    return false;
+  }
+
+  Unlink(index);
+  Release(index);
+  --size_;
+
+  return true;
+}
+
+/**
+ * Remove all the pending timers
+ */
+template <typename T>
+void TimerWheel<T>::Clear()
+{
+  for (std::size_t level = 0; level < LEVELS; ++level)
+  {
+    for (std::size_t slot = 0; slot < SLOTS; ++slot)
+    {
+      Index index = Detach(level, slot);
+      while (index != NIL)
+      {
+        Index const next = nodes_[index].next;
+        Release(index);
+        index = next;
+      }
+    }
+  }
+
+  size_ = 0;
+}
+
+/**
+ * Advance the wheel up to and including the specified tick, visiting every timer which expires
+ *
+ * The visitor must not modify the wheel.
+ *
+ * @tparam Visitor The type of the callable accepting the signature: void(T &&)
+ * @param now The current tick
+ * @param visitor The function called with the item of each expired timer
+ * @return The number of expired timers
+ */
+template <typename T>
+template <typename Visitor>
+std::size_t TimerWheel<T>::Advance(Tick now, Visitor &&visitor)
+{
+  std::size_t count = 0;
+
+  while (current_ <= now)
+  {
+    if (size_ == 0)
+    {
+      current_ = now + 1;
+      break;
+    }
+
+    // cascade the higher levels whose span has been reached, the highest level first
+    for (std::size_t level = LEVELS - 1; level > 0; --level)
+    {
+      if ((current_ & ((Tick{1} << Shift(level)) - 1)) == 0)
+      {
+        Cascade(level);
+      }
+    }
+
+    count += Expire(visitor);
+
+    // nothing left on level 0, skip directly to the next cascade point
+    if (levels_[0].occupied == 0)
+    {
+      current_ = std::max(current_ + 1, std::min(NextExpiry(), now + 1));
+    }
+    else
+    {
+      ++current_;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * Compute the next tick at which the wheel needs to be advanced. This is the expiry of the next
+ * timer on level 0 or the next cascade of an occupied slot on a higher level.
+ *
+ * @return The next tick or NEVER if the wheel is empty
+ */
+template <typename T>
+typename TimerWheel<T>::Tick TimerWheel<T>::NextExpiry() const
+{
+  if (size_ == 0)
+  {
+    return NEVER;
+  }
+
+  Tick next = NEVER;
+
+  for (std::size_t level = 0; level < LEVELS; ++level)
+  {
+    uint64_t const occupied = levels_[level].occupied;
+    if (occupied == 0)
+    {
+      continue;
+    }
+
+    // find the next occupied slot at or after the current position of this level
+    auto const     position = static_cast<std::size_t>((current_ >> Shift(level)) & SLOT_MASK);
+    uint64_t const rotated =
+        (position == 0) ? occupied : ((occupied >> position) | (occupied << (SLOTS - position)));
+    auto const slot = (position + static_cast<std::size_t>(__builtin_ctzll(rotated))) & SLOT_MASK;
+
+    Tick const span   = Tick{1} << Shift(level + 1);
+    Tick       expiry = (current_ & ~(span - 1)) + (Tick{slot} << Shift(level));
+    if (expiry < current_)
+    {
+      expiry += span;
+    }
+
+    next = std::min(next, expiry);
+  }
+
+  return next;
+}
+
+template <typename T>
+typename TimerWheel<T>::Index TimerWheel<T>::Allocate()
+{
+  if (!free_.empty())
+  {
+    Index const index = free_.back();
+    free_.pop_back();
+    return index;
+  }
+
+  nodes_.emplace_back();
+  return static_cast<Index>(nodes_.size() - 1);
+}
+
+template <typename T>
+void TimerWheel<T>::Release(Index index)
+{
+  Node &node = nodes_[index];
+
+  node.item  = T{};
+  node.level = NO_LEVEL;
+  node.prev  = NIL;
+  node.next  = NIL;
+  ++node.generation;
+
+  free_.push_back(index);
+}
+
+/**
+ * Link a node into the lowest level slot that can represent its due tick
+ */
+template <typename T>
+void TimerWheel<T>::Place(Index index)
+{
+  Tick const due = nodes_[index].due;
+
+  for (std::size_t level = 0; level < LEVELS; ++level)
+  {
+    // the due tick and the current tick only differ within the span of this level
+    if ((due >> Shift(level + 1)) == (current_ >> Shift(level + 1)))
+    {
+      Link(index, level, static_cast<std::size_t>((due >> Shift(level)) & SLOT_MASK));
+      return;
+    }
+  }
+
+  // beyond the range of the wheel: park in the next slot of the top level
+  std::size_t const top = LEVELS - 1;
+  Link(index, top, static_cast<std::size_t>(((current_ >> Shift(top)) + 1) & SLOT_MASK));
+}
+
+template <typename T>
+void TimerWheel<T>::Link(Index index, std::size_t level, std::size_t slot)
+{
+  Node & node = nodes_[index];
+  Level &lvl  = levels_[level];
+
+  node.level = level;
+  node.slot  = slot;
+  node.prev  = NIL;
+  node.next  = lvl.heads[slot];
+
+  if (node.next != NIL)
+  {
+    nodes_[node.next].prev = index;
+  }
+
+  lvl.heads[slot] = index;
+  lvl.occupied |= (uint64_t{1} << slot);
+}
+
+template <typename T>
+void TimerWheel<T>::Unlink(Index index)
+{
+  Node & node = nodes_[index];
+  Level &lvl  = levels_[node.level];
+
+  if (node.prev != NIL)
+  {
+    nodes_[node.prev].next = node.next;
+  }
+  else
+  {
+    lvl.heads[node.slot] = node.next;
+  }
+
+  if (node.next != NIL)
+  {
+    nodes_[node.next].prev = node.prev;
+  }
+
+  if (lvl.heads[node.slot] == NIL)
+  {
+    lvl.occupied &= ~(uint64_t{1} << node.slot);
+  }
+
+  node.level = NO_LEVEL;
+}
+
+/**
+ * Remove the complete list of timers from a slot
+ *
+ * @return The index of the first node of the list
+ */
+template <typename T>
+typename TimerWheel<T>::Index TimerWheel<T>::Detach(std::size_t level, std::size_t slot)
+{
+  Level &lvl  = levels_[level];
+  Index  head = lvl.heads[slot];
+
+  lvl.heads[slot] = NIL;
+  lvl.occupied &= ~(uint64_t{1} << slot);
+
+  return head;
+}
+
+/**
+ * Move the timers of the current slot of a higher level into the levels below it
+ */
+template <typename T>
+void TimerWheel<T>::Cascade(std::size_t level)
+{
+  auto const slot  = static_cast<std::size_t>((current_ >> Shift(level)) & SLOT_MASK);
+  Index      index = Detach(level, slot);
+
+  while (index != NIL)
+  {
+    Index const next = nodes_[index].next;
+    Place(index);
+    index = next;
+  }
+}
+
+/**
+ * Expire all the timers of the current level 0 slot
+ */
+template <typename T>
+template <typename Visitor>
+std::size_t TimerWheel<T>::Expire(Visitor &visitor)
+{
+  std::size_t count = 0;
+  Index       index = Detach(0, static_cast<std::size_t>(current_ & SLOT_MASK));
+
+  while (index != NIL)
+  {
+    Index const next = nodes_[index].next;
+
+    T item{std::move(nodes_[index].item)};
+    Release(index);
+    --size_;
+    ++count;
+
+    visitor(std::move(item));
+
+    index = next;
+  }
+
+  return count;
+}
+
+}  // namespace details
+}  // namespace network
+}  // namespace fetch
@@ -18,11 +18,15 @@
 //------------------------------------------------------------------------------
 
 #include "core/mutex.hpp"
+#include "network/details/task.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <deque>
-#include <functional>
+#include <mutex>
 #include <string>
+#include <utility>
 
 namespace fetch {
 namespace network {
@@ -30,11 +34,15 @@ namespace details {
 
 /**
  * Simple FIFO based work item queue
+ *
+ * The owning consumer takes work from the front of the queue with `Dispatch` while other
+ * consumers can take work from the back with `Steal`. This allows a set of these queues to be
+ * used as the per-worker queues of a work stealing scheduler.
  */
 class WorkStore
 {
 public:
-  using WorkItem = std::function<void()>;
+  using WorkItem = Task;
 
   WorkStore()                     = default;
   WorkStore(WorkStore const &rhs) = delete;
@@ -58,11 +66,20 @@ public:
 
   /**
    * Clear all queued items from the work queue
+   *
+   * @return The number of items that were removed
    */
-  void Clear()
+  std::size_t Clear()
   {
-    FETCH_LOCK(mutex_);
-    queue_.clear();
+    Queue removed{};
+
+    {
+      FETCH_LOCK(mutex_);
+      std::swap(removed, queue_);
+    }
+
+    // destroy the work items outside of the lock
+    return removed.size();
   }
 
   /**
@@ -74,38 +91,54 @@ public:
   }
 
   /**
-   * Extract and dispatch a single item from the queue
+   * Extract and dispatch a single item from the front of the queue
    *
-   * @tparam CALLBACK The type of the callable accepting the signature: void(WorkItem const &)
+   * @tparam CALLBACK The type of the callable accepting the signature: void(WorkItem &)
    * @param handler The dispatching function
    * @return The number of items processed
    */
   template <typename CALLBACK>
   std::size_t Dispatch(CALLBACK const &handler)
   {
-    WorkItem    work;
-    std::size_t num_processed = 0;
+    WorkItem work;
 
     // attempt to extract a piece of work from the queue
     {
       FETCH_LOCK(mutex_);
       if (!queue_.empty())
       {
-        work = queue_.front();
+        work = std::move(queue_.front());
         queue_.pop_front();
       }
     }
 
-    // exit the dispatch loop in the case when no work has been found
-    if (work)
-    {
-      // execute the callback handler on the piece of work
-      handler(work);
+    return Execute(work, handler);
+  }
+
+  /**
+   * Extract and dispatch a single item from the back of the queue. Used by consumers other than
+   * the owner of the queue so that they contend as little as possible with it.
+   *
+   * @tparam CALLBACK The type of the callable accepting the signature: void(WorkItem &)
+   * @param handler The dispatching function
+   * @return The number of items processed
+   */
+  template <typename CALLBACK>
+  std::size_t Steal(CALLBACK const &handler)
+  {
+    WorkItem work;
 
-      ++num_processed;
+    {
+      // never wait on a queue that is currently busy, the caller will just try another one
+      std::unique_lock<Mutex> lock(mutex_, std::try_to_lock);
+      if (lock.owns_lock() && !queue_.empty())
+      {
+        work = std::move(queue_.back());
+        queue_.pop_back();
+      }
     }
 
-    return num_processed;
+    return Execute(work, handler);
   }
 
   /**
@@ -131,6 +164,21 @@ public:
 private:
   using Queue = std::deque<WorkItem>;
 
+  template <typename CALLBACK>
+  static std::size_t Execute(WorkItem &work, CALLBACK const &handler)
+  {
+    // exit the dispatch loop in the case when no work has been found
+    if (!work)
+    {
+      return 0;
+    }
+
+    // execute the callback handler on the piece of work
+    handler(work);
+
+    return 1;
+  }
+
   mutable Mutex     mutex_;            ///< Mutex protecting `queue_`
   Queue             queue_;            ///< The queue of work items
   std::atomic<bool> shutdown_{false};  ///< Flag to signal the work queue is shutting down
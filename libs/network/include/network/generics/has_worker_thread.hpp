@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/cpu_topology.hpp"
 #include "core/set_thread_name.hpp"
 #include "network/generics/resolvable.hpp"
 #include "network/service/promise.hpp"
@@ -47,10 +48,12 @@ private:
 public:
   static constexpr char const *LOGGING_NAME = "HasWorkerThread";
 
-  HasWorkerThread(Target *target, std::string name, std::function<void()> workcycle)
+  HasWorkerThread(Target *target, std::string name, std::function<void()> workcycle,
+                  core::CpuList affinity = {})
     : target_(target)
     , workcycle_(std::move(workcycle))
     , name_{std::move(name)}
+    , affinity_{std::move(affinity)}
   {
     thread_ = std::make_shared<std::thread>([this]() { this->Run(); });
   }
@@ -80,6 +83,11 @@ protected:
   {
     SetThreadName(name_);
 
+    if (!affinity_.empty())
+    {
+      core::SetThreadAffinity(affinity_);
+    }
+
     if (!target_)
     {
       FETCH_LOG_WARN(LOGGING_NAME, "No target configured, stopping thread.");
@@ -104,6 +112,7 @@ protected:
   ShutdownFlag              shutdown_{false};
   WorkFunc                  workcycle_;
   std::string               name_;
+  core::CpuList             affinity_;
   std::chrono::milliseconds wait_time_{100};
 };
 
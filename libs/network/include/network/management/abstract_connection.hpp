@@ -58,11 +58,12 @@ public:
   virtual ~AbstractConnection();
 
   virtual void     Send(MessageBuffer const &, Callback const &success = nullptr,
-                        Callback const &fail = nullptr) = 0;
-  virtual uint16_t Type() const                         = 0;
-  virtual void     Close()                              = 0;
-  virtual bool     Closed() const                       = 0;
-  virtual bool     is_alive() const                     = 0;
+                        Callback const &fail     = nullptr,
+                        MessagePriority priority = MessagePriority::NORMAL) = 0;
+  virtual uint16_t Type() const                                             = 0;
+  virtual void     Close()                                                  = 0;
+  virtual bool     Closed() const                                           = 0;
+  virtual bool     is_alive() const                                         = 0;
 
   // Common to allx
   std::string          Address() const;
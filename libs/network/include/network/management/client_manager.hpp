@@ -118,6 +118,20 @@ public:
     }
   }
 
+  void PushRequests(ConnectionHandleType client, AbstractNetworkServer::MessageBuffers const &msgs)
+  {
+    try
+    {
+      server_.PushRequests(client, msgs);
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Error processing packets from ", client,
+                      " error: ", ex.what());
+      throw;
+    }
+  }
+
   std::string GetAddress(ConnectionHandleType client)
   {
     FETCH_LOCK(clients_mutex_);
@@ -20,19 +20,33 @@
 #include "core/byte_array/byte_array.hpp"
 #include "core/byte_array/const_byte_array.hpp"
 
+#include <cstdint>
 #include <deque>
 #include <functional>
 
 namespace fetch {
 namespace network {
 using MessageBuffer = byte_array::ByteArray;
+
+/**
+ * The priority with which an outbound message is written to the network. Higher priority
+ * messages are written ahead of lower priority messages queued on the same connection
+ */
+enum class MessagePriority : uint8_t
+{
+  HIGH = 0,  ///< Latency sensitive traffic, e.g. routing and consensus (DKG / beacon) messages
+  NORMAL,    ///< The default priority
+  BULK,      ///< Large transfers, e.g. blocks and state
+};
+
 struct MessageType
 {
   using Callback = std::function<void()>;
 
-  MessageBuffer buffer;
-  Callback      success{nullptr};
-  Callback      failure{nullptr};
+  MessageBuffer   buffer;
+  Callback        success{nullptr};
+  Callback        failure{nullptr};
+  MessagePriority priority{MessagePriority::NORMAL};
 };
 using MessageQueueType = std::deque<MessageType>;
 }  // namespace network
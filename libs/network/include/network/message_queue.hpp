@@ -0,0 +1,77 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/message.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace fetch {
+namespace network {
+
+/**
+ * The write queue of a connection. Messages are held in one queue per priority and are extracted
+ * from the highest priority queue first. In order that a steady stream of high priority messages
+ * can not starve the lower priorities completely, a lower priority message is extracted after
+ * MAX_CONSECUTIVE messages have been taken from a higher priority while it was waiting.
+ *
+ * The queue itself is not thread safe, access must be guarded by the owning connection.
+ */
+class MessageQueue
+{
+public:
+  static constexpr std::size_t NUM_PRIORITIES  = 3;
+  static constexpr std::size_t MAX_CONSECUTIVE = 16;
+
+  // Construction / Destruction
+  MessageQueue()                     = default;
+  MessageQueue(MessageQueue const &) = delete;
+  MessageQueue(MessageQueue &&)      = delete;
+  ~MessageQueue()                    = default;
+
+  void Push(MessageType message);
+  bool Pop(MessageType &message);
+  void Clear();
+
+  bool        empty() const;
+  std::size_t size() const;
+  std::size_t size(MessagePriority priority) const;
+
+  // Operators
+  MessageQueue &operator=(MessageQueue const &) = delete;
+  MessageQueue &operator=(MessageQueue &&) = delete;
+
+private:
+  using Queue  = std::deque<MessageType>;
+  using Queues = std::array<Queue, NUM_PRIORITIES>;
+  using Counts = std::array<std::size_t, NUM_PRIORITIES>;
+
+  static std::size_t ToIndex(MessagePriority priority);
+
+  bool IsLowerPriorityWaiting(std::size_t index) const;
+
+  Queues      queues_{};
+  Counts      consecutive_{};  ///< Messages taken from each priority while a lower one waited
+  std::size_t size_{0};
+};
+
+}  // namespace network
+}  // namespace fetch
@@ -19,6 +19,7 @@
 
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/byte_array/encoders.hpp"
+#include "core/containers/queue.hpp"
 #include "core/macros.hpp"
 #include "core/mutex.hpp"
 #include "logging/logging.hpp"
@@ -27,8 +28,11 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <iterator>
+#include <memory>
 #include <random>
 #include <string>
 #include <unordered_map>
@@ -45,6 +49,15 @@ inline math::statistics::Gaussian<double> const &LookupReferencePlayer(TrustQual
   return reference_players_.at(static_cast<std::size_t>(quality));
 }
 
+/**
+ * Ranks peers by a Gaussian skill estimate (TrueSkill-like) of the quality of their messages.
+ *
+ * Feedback is reported for every message, so it is pushed onto a lock free queue and applied in
+ * batches, either when the queue is half full or before the trust store is next read. Applying a
+ * rating only moves the rated peer within the sorted trust store, rather than re-sorting it. The
+ * peer lists are served from an immutable snapshot of the trust store, which is published when it
+ * is first read after a change and is then iterated without holding the lock.
+ */
 template <typename IDENTITY>
 class P2PTrustBayRank : public P2PTrustInterface<IDENTITY>
 {
@@ -62,9 +75,20 @@ protected:
     }
     bool scored = false;
   };
-  using TrustStore   = std::vector<PeerTrustRating>;
-  using RankingStore = std::unordered_map<IDENTITY, std::size_t>;
-  using PeerTrusts   = typename P2PTrustInterface<IDENTITY>::PeerTrusts;
+  struct Feedback
+  {
+    IDENTITY     peer_identity{};
+    TrustQuality quality{TrustQuality::NEW_PEER};
+  };
+
+  static constexpr std::size_t FEEDBACK_QUEUE_SIZE = 256;
+
+  using TrustStore    = std::vector<PeerTrustRating>;
+  using TrustSnapshot = std::shared_ptr<TrustStore const>;
+  using RankingStore  = std::unordered_map<IDENTITY, std::size_t>;
+  using FeedbackQueue = core::MPSCQueue<Feedback, FEEDBACK_QUEUE_SIZE>;
+  using FeedbackBatch = std::vector<Feedback>;
+  using PeerTrusts    = typename P2PTrustInterface<IDENTITY>::PeerTrusts;
 
 public:
   using ConstByteArray = byte_array::ConstByteArray;
@@ -88,53 +112,41 @@ public:
                    TrustSubject subject, TrustQuality quality) override
   {
     FETCH_UNUSED(subject);
-    FETCH_LOCK(mutex_);
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Feedback: ", byte_array::ToBase64(peer_ident),
+                    " subj=", ToString(subject), " qual=", ToString(quality));
 
-    auto ranking = ranking_store_.find(peer_ident);
+    Feedback feedback{peer_ident, quality};
 
-    std::size_t pos;
-    if (ranking == ranking_store_.end())
+    std::size_t pending{0};
+    bool const  queued = feedback_queue_.Push(feedback, pending, std::chrono::milliseconds{0});
+    if (queued && (pending < FEEDBACK_QUEUE_SIZE / 2))
     {
-      PeerTrustRating new_record{peer_ident, Gaussian::ClassicForm(100., 100 / 6.), 0, false};
-      pos = trust_store_.size();
-      trust_store_.push_back(new_record);
-    }
-    else
-    {
-      pos = ranking->second;
+      return;
     }
 
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Feedback: ", byte_array::ToBase64(peer_ident),
-                    " subj=", ToString(subject), " qual=", ToString(quality));
-    if (quality == TrustQuality::NEW_PEER)
+    FETCH_LOCK(mutex_);
+    Flush();
+
+    // the queue was full, the feedback is applied after the feedback queued before it
+    if (!queued)
     {
-      trust_store_[pos].update_score();
-      dirty_ = true;
-      SortIfNeeded();
-      return;  // we're introducing this element, not rating it.
+      Apply(feedback);
     }
-
-    Gaussian const &reference_player = LookupReferencePlayer(quality);
-    bool honest = quality == TrustQuality::NEW_INFORMATION || quality == TrustQuality::DUPLICATE;
-    trust_store_[pos].scored = true;
-    updateGaussian(honest, trust_store_[pos].g, reference_player, 100 / 12., 1 / 6., 0.2);
-    trust_store_[pos].update_score();
-
-    dirty_ = true;
-    SortIfNeeded();
   }
 
   bool IsPeerKnown(IDENTITY const &peer_ident) const override
   {
     FETCH_LOCK(mutex_);
+    Flush();
     return ranking_store_.find(peer_ident) != ranking_store_.end();
   }
 
   IdentitySet GetRandomPeers(std::size_t maximum_count, double minimum_trust) const override
   {
-    if (maximum_count > trust_store_.size())
+    TrustSnapshot const snapshot = GetSnapshot();
+    if (maximum_count > snapshot->size())
     {
-      return GetBestPeers(maximum_count);
+      return GetBestPeers(*snapshot, maximum_count);
     }
 
     IdentitySet result;
@@ -143,25 +155,21 @@ public:
     std::size_t                                max_trial = maximum_count * 1000;
     std::random_device                         rd;
     std::mt19937                               g(rd());
-    std::uniform_int_distribution<std::size_t> distribution(0, trust_store_.size() - 1);
+    std::uniform_int_distribution<std::size_t> distribution(0, snapshot->size() - 1);
 
+    for (std::size_t i = 0, pos = 0, inserted_element_counter = 0; i < max_trial; ++i)
     {
-      FETCH_LOCK(mutex_);
+      pos = distribution(g);
+      if ((*snapshot)[pos].score < minimum_trust)
+      {
+        continue;
+      }
 
-      for (std::size_t i = 0, pos = 0, inserted_element_counter = 0; i < max_trial; ++i)
+      result.insert((*snapshot)[pos].peer_identity);
+      inserted_element_counter += 1;
+      if (inserted_element_counter >= maximum_count)
       {
-        pos = distribution(g);
-        if (trust_store_[pos].score < minimum_trust)
-        {
-          continue;
-        }
-
-        result.insert(trust_store_[pos].peer_identity);
-        inserted_element_counter += 1;
-        if (inserted_element_counter >= maximum_count)
-        {
-          break;
-        }
+        break;
       }
     }
 
@@ -170,29 +178,13 @@ public:
 
   IdentitySet GetBestPeers(std::size_t maximum) const override
   {
-    IdentitySet result;
-    result.reserve(maximum);
-
-    {
-      FETCH_LOCK(mutex_);
-
-      for (std::size_t pos = 0, end = std::min(maximum, trust_store_.size()); pos < end; ++pos)
-      {
-        if (trust_store_[pos].score < threshold_)
-        {
-          break;
-        }
-
-        result.insert(trust_store_[pos].peer_identity);
-      }
-    }
-
-    return result;
+    return GetBestPeers(*GetSnapshot(), maximum);
   }
 
   std::size_t GetRankOfPeer(IDENTITY const &peer_ident) const override
   {
     FETCH_LOCK(mutex_);
+    Flush();
 
     auto const ranking_it = ranking_store_.find(peer_ident);
     if (ranking_it == ranking_store_.end())
@@ -205,16 +197,16 @@ public:
 
   PeerTrusts GetPeersAndTrusts() const override
   {
-    FETCH_LOCK(mutex_);
-    PeerTrusts trust_list;
+    TrustSnapshot const snapshot = GetSnapshot();
+    PeerTrusts          trust_list;
 
-    for (std::size_t pos = 0, end = trust_store_.size(); pos < end; ++pos)
+    for (auto const &rating : *snapshot)
     {
       PeerTrust pt;
-      pt.address        = trust_store_[pos].peer_identity;
+      pt.address        = rating.peer_identity;
       pt.name           = std::string(byte_array::ToBase64(pt.address));
-      pt.trust          = trust_store_[pos].score;
-      pt.has_transacted = trust_store_[pos].scored;
+      pt.trust          = rating.score;
+      pt.has_transacted = rating.scored;
       trust_list.push_back(pt);
     }
 
@@ -226,6 +218,7 @@ public:
     double ranking = 0.0;
 
     FETCH_LOCK(mutex_);
+    Flush();
 
     auto ranking_it = ranking_store_.find(peer_ident);
     if (ranking_it != ranking_store_.end())
@@ -246,12 +239,12 @@ public:
 
   void Debug() const override
   {
-    FETCH_LOCK(mutex_);
-    for (std::size_t pos = 0; pos < trust_store_.size(); ++pos)
+    TrustSnapshot const snapshot = GetSnapshot();
+    for (std::size_t pos = 0; pos < snapshot->size(); ++pos)
     {
       FETCH_LOG_WARN(LOGGING_NAME, "trust_store_ ",
-                     byte_array::ToBase64(trust_store_[pos].peer_identity), " => ",
-                     trust_store_[pos].score);
+                     byte_array::ToBase64((*snapshot)[pos].peer_identity), " => ",
+                     (*snapshot)[pos].score);
     }
   }
 
@@ -260,7 +253,7 @@ public:
   P2PTrustBayRank operator=(P2PTrustBayRank &&rhs) = delete;
 
 protected:
-  Gaussian truncate(Gaussian const &g, double beta, double eps)
+  static Gaussian truncate(Gaussian const &g, double beta, double eps)
   {
     // Calculate approximated truncated Gaussian
     double m =
@@ -278,8 +271,8 @@ protected:
     return t / g;
   }
 
-  void updateGaussian(bool honest, Gaussian &s, Gaussian const &ref, double beta, double drift,
-                      double eps)
+  static void updateGaussian(bool honest, Gaussian &s, Gaussian const &ref, double beta,
+                             double drift, double eps)
   {
     // Calculate new distribution for g1 assuming that g1 won with g2.
     // beta corresponds to a measure of how difficult the game is to master.
@@ -302,40 +295,143 @@ protected:
     }
   }
 
-  void SortIfNeeded()
+  /**
+   * Applies the queued feedback, must be called with the mutex held
+   */
+  void Flush() const
   {
-    if (!dirty_)
+    feedback_batch_.clear();
+    feedback_queue_.PopMany(std::back_inserter(feedback_batch_), FEEDBACK_QUEUE_SIZE,
+                            std::chrono::milliseconds{0});
+
+    for (auto const &feedback : feedback_batch_)
     {
-      return;
+      Apply(feedback);
+    }
+  }
+
+  /**
+   * Rates a peer and moves it to its new position in the trust store, must be called with the
+   * mutex held
+   */
+  void Apply(Feedback const &feedback) const
+  {
+    auto ranking = ranking_store_.find(feedback.peer_identity);
+
+    std::size_t pos;
+    if (ranking == ranking_store_.end())
+    {
+      PeerTrustRating new_record{feedback.peer_identity, Gaussian::ClassicForm(100., 100 / 6.), 0,
+                                 false};
+      pos = trust_store_.size();
+      trust_store_.push_back(new_record);
+      ranking_store_[feedback.peer_identity] = pos;
+    }
+    else
+    {
+      pos = ranking->second;
+    }
+
+    // a new peer is only introduced, not rated
+    if (feedback.quality != TrustQuality::NEW_PEER)
+    {
+      bool const honest = (feedback.quality == TrustQuality::NEW_INFORMATION) ||
+                          (feedback.quality == TrustQuality::DUPLICATE);
+
+      Gaussian const &reference_player = LookupReferencePlayer(feedback.quality);
+      trust_store_[pos].scored         = true;
+      updateGaussian(honest, trust_store_[pos].g, reference_player, 100 / 12., 1 / 6., 0.2);
+    }
+    trust_store_[pos].update_score();
+
+    Reposition(pos);
+    snapshot_.reset();
+  }
+
+  static bool IsRankedBelow(PeerTrustRating const &a, PeerTrustRating const &b)
+  {
+    if (a.score < b.score)
+    {
+      return true;
+    }
+    if (a.score > b.score)
+    {
+      return false;
+    }
+
+    return a.peer_identity < b.peer_identity;
+  }
+
+  /**
+   * Restores the order of the trust store after the score of the peer at pos changed. Only the
+   * peers between its old and new position are moved, and have their rankings updated
+   */
+  void Reposition(std::size_t pos) const
+  {
+    auto const current = trust_store_.begin() + static_cast<std::ptrdiff_t>(pos);
+    auto const next    = current + 1;
+
+    auto first = current;
+    auto last  = next;
+    if ((current != trust_store_.begin()) && IsRankedBelow(*current, *(current - 1)))
+    {
+      first = std::lower_bound(trust_store_.begin(), current, *current, IsRankedBelow);
+      std::rotate(first, current, next);
     }
-    dirty_ = false;
-
-    std::sort(trust_store_.begin(), trust_store_.end(),
-              [](PeerTrustRating const &a, PeerTrustRating const &b) {
-                if (a.score < b.score)
-                {
-                  return true;
-                }
-                if (a.score > b.score)
-                {
-                  return false;
-                }
-
-                return a.peer_identity < b.peer_identity;
-              });
-
-    ranking_store_.clear();
-    for (std::size_t pos = 0; pos < trust_store_.size(); ++pos)
+    else if ((next != trust_store_.end()) && IsRankedBelow(*next, *current))
     {
-      ranking_store_[trust_store_[pos].peer_identity] = pos;
+      last = std::upper_bound(next, trust_store_.end(), *current, IsRankedBelow);
+      std::rotate(current, next, last);
     }
+
+    for (auto it = first; it != last; ++it)
+    {
+      ranking_store_[it->peer_identity] =
+          static_cast<std::size_t>(std::distance(trust_store_.begin(), it));
+    }
+  }
+
+  /**
+   * @return the trust store including all of the feedback reported so far
+   */
+  TrustSnapshot GetSnapshot() const
+  {
+    FETCH_LOCK(mutex_);
+    Flush();
+
+    if (!snapshot_)
+    {
+      snapshot_ = std::make_shared<TrustStore const>(trust_store_);
+    }
+
+    return snapshot_;
+  }
+
+  IdentitySet GetBestPeers(TrustStore const &trust_store, std::size_t maximum) const
+  {
+    IdentitySet result;
+    result.reserve(maximum);
+
+    for (std::size_t pos = 0, end = std::min(maximum, trust_store.size()); pos < end; ++pos)
+    {
+      if (trust_store[pos].score < threshold_)
+      {
+        break;
+      }
+
+      result.insert(trust_store[pos].peer_identity);
+    }
+
+    return result;
   }
 
 protected:
-  bool          dirty_ = false;
-  mutable Mutex mutex_;
-  TrustStore    trust_store_;
-  RankingStore  ranking_store_;
+  mutable Mutex         mutex_;
+  mutable TrustStore    trust_store_;     ///< Peers in ascending order of score
+  mutable RankingStore  ranking_store_;   ///< The position of every peer in the trust store
+  mutable TrustSnapshot snapshot_;        ///< Published copy of the trust store, if up to date
+  mutable FeedbackQueue feedback_queue_;  ///< Feedback which has not been applied yet
+  mutable FeedbackBatch feedback_batch_;  ///< Feedback being applied
 };
 
 }  // namespace p2p
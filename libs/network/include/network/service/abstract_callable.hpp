@@ -22,7 +22,11 @@
 #include "logging/logging.hpp"
 #include "network/service/types.hpp"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <typeinfo>
@@ -217,28 +221,56 @@ enum Callable
 
 struct CallableArgumentType
 {
-  std::reference_wrapper<std::type_info const> type;
-  void *                                       pointer;
+  std::reference_wrapper<std::type_info const> type{typeid(void)};
+  void *                                       pointer{nullptr};
 };
 
-class CallableArgumentList : public std::vector<CallableArgumentType>
+/**
+ * The additional (non serialised) arguments supplied to a callable, such as the call context.
+ *
+ * The list is created for each dispatched call so the arguments are stored inline (rather than in
+ * a vector) to avoid a heap allocation on the call path.
+ */
+class CallableArgumentList
 {
 public:
+  static constexpr std::size_t MAX_ARGUMENTS = 4;
+
   template <typename T>
   void PushArgument(T *value)
   {
-    std::vector<CallableArgumentType>::push_back(
-        CallableArgumentType{typeid(T), (void *)value});  // NOLINT
+    if (size_ >= MAX_ARGUMENTS)
+    {
+      throw std::length_error("Too many additional arguments for callable");
+    }
+
+    arguments_[size_++] = CallableArgumentType{typeid(T), (void *)value};  // NOLINT
+  }
+
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  bool empty() const
+  {
+    return size_ == 0;
   }
 
   CallableArgumentType const &operator[](std::size_t n) const
   {
-    return std::vector<CallableArgumentType>::operator[](n);
+    return arguments_[n];
   }
   CallableArgumentType &operator[](std::size_t n)
   {
-    return std::vector<CallableArgumentType>::operator[](n);
+    return arguments_[n];
   }
+
+private:
+  using Arguments = std::array<CallableArgumentType, MAX_ARGUMENTS>;
+
+  Arguments   arguments_{};
+  std::size_t size_{0};
 };
 
 /* Abstract class for callables.
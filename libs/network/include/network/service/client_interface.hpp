@@ -24,9 +24,12 @@
 #include "network/service/error_codes.hpp"
 #include "network/service/message_types.hpp"
 #include "network/service/promise.hpp"
+#include "network/service/promise_table.hpp"
 #include "network/service/protocol.hpp"
 #include "network/service/types.hpp"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <list>
@@ -35,6 +38,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace service {
@@ -51,18 +55,18 @@ public:
 protected:
   using CallId           = uint64_t;
   using CallIdPromiseMap = std::unordered_map<CallId, Promise>;
-  using PromiseMap       = std::unordered_map<PromiseCounter, Promise>;
 
   bool ProcessServerMessage(network::MessageBuffer const &msg);
   void ProcessRPCResult(network::MessageBuffer const &msg, service::SerializerType &params);
+  void ProcessBatchResult(service::SerializerType &params);
 
   // Pending promise issues
   void    AddPromise(Promise const &promise);
   Promise ExtractPromise(PromiseCounter id);
   void    RemovePromise(PromiseCounter id);
 
-  PromiseMap promises_;
-  Mutex      promises_mutex_;
+private:
+  PromiseTable promises_;
 };
 }  // namespace service
 }  // namespace fetch
@@ -27,6 +27,7 @@ ServiceClassificationType const SERVICE_RESULT        = 10ull;
 ServiceClassificationType const SERVICE_SUBSCRIBE     = 20ull;
 ServiceClassificationType const SERVICE_UNSUBSCRIBE   = 30ull;
 ServiceClassificationType const SERVICE_FEED          = 40ull;
+ServiceClassificationType const SERVICE_BATCH         = 50ull;
 
 ServiceClassificationType const SERVICE_ERROR = 999ull;
 }  // namespace service
@@ -138,9 +138,8 @@ private:
   void UpdateState(State state) const;
   void DispatchCallbacks() const;
 
-  static Counter counter_;
-  static Mutex   counter_lock_;
-  static Counter GetNextId();
+  static std::atomic<Counter> counter_;
+  static Counter              GetNextId();
 
   Counter const       id_{GetNextId()};
   Timepoint const     created_{Clock::now()};
@@ -220,7 +219,7 @@ bool details::PromiseImplementation::GetResult(T &ret, uint64_t extend_wait_by)
   {
     if (Wait(true, extend_wait_by))
     {
-      SerializerType ser(value_);
+      auto ser = SerializerType::Borrow(value_);
       ser >> ret;
 
       success = true;
@@ -0,0 +1,186 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "network/service/promise.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+namespace fetch {
+namespace service {
+
+/**
+ * Table of the pending promises of a client, indexed by call (promise) id.
+ *
+ * Promise ids are allocated sequentially so the ids in flight at any one time map onto distinct
+ * entries of a fixed slot array. Each slot is claimed and released with a single compare and
+ * swap on its state word, which avoids taking a lock on the request and response paths. In the
+ * rare case that a slot is still occupied by an older (long running) call the promise is placed
+ * in a mutex guarded overflow map instead, which is only consulted while it is non-empty.
+ */
+class PromiseTable
+{
+public:
+  static constexpr std::size_t NUM_SLOTS = 1024;
+
+  // Construction / Destruction
+  PromiseTable()                     = default;
+  PromiseTable(PromiseTable const &) = delete;
+  PromiseTable(PromiseTable &&)      = delete;
+  ~PromiseTable()                    = default;
+
+  void    Add(Promise const &promise);
+  Promise Extract(PromiseCounter id);
+  void    Remove(PromiseCounter id);
+
+  std::size_t overflow_size() const;
+
+  // Operators
+  PromiseTable &operator=(PromiseTable const &) = delete;
+  PromiseTable &operator=(PromiseTable &&) = delete;
+
+private:
+  using State      = uint64_t;
+  using PromiseMap = std::unordered_map<PromiseCounter, Promise>;
+
+  /// Slot states: 0 when free, BUSY while being updated, otherwise the occupying id + 1
+  static constexpr State FREE = 0;
+  static constexpr State BUSY = ~State{0};
+
+  struct alignas(64) Slot
+  {
+    std::atomic<State> state{FREE};
+    Promise            promise{};
+  };
+
+  using Slots = std::array<Slot, NUM_SLOTS>;
+
+  static constexpr State Occupied(PromiseCounter id)
+  {
+    return id + 1;
+  }
+
+  Slot &LookupSlot(PromiseCounter id)
+  {
+    return slots_[id % NUM_SLOTS];
+  }
+
+  Promise ExtractFromOverflow(PromiseCounter id);
+
+  Slots                    slots_{};
+  std::atomic<std::size_t> overflow_count_{0};
+  Mutex                    overflow_lock_;
+  PromiseMap               overflow_;
+};
+
+/**
+ * Add a pending promise to the table
+ *
+ * @param promise The promise to be added
+ */
+inline void PromiseTable::Add(Promise const &promise)
+{
+  PromiseCounter const id   = promise->id();
+  Slot &               slot = LookupSlot(id);
+
+  State expected{FREE};
+  if (slot.state.compare_exchange_strong(expected, BUSY, std::memory_order_acquire))
+  {
+    slot.promise = promise;
+    slot.state.store(Occupied(id), std::memory_order_release);
+    return;
+  }
+
+  // slot is in use by another call
+  FETCH_LOCK(overflow_lock_);
+  overflow_[id] = promise;
+  overflow_count_.store(overflow_.size(), std::memory_order_release);
+}
+
+/**
+ * Remove and return the promise for the specified id
+ *
+ * @param id The id of the promise
+ * @return The promise if it was present, otherwise an empty promise
+ */
+inline Promise PromiseTable::Extract(PromiseCounter id)
+{
+  Slot &slot = LookupSlot(id);
+
+  State expected{Occupied(id)};
+  if (slot.state.compare_exchange_strong(expected, BUSY, std::memory_order_acquire))
+  {
+    Promise promise{std::move(slot.promise)};
+    slot.promise.reset();
+    slot.state.store(FREE, std::memory_order_release);
+
+    return promise;
+  }
+
+  if (overflow_count_.load(std::memory_order_acquire) == 0)
+  {
+    return {};
+  }
+
+  return ExtractFromOverflow(id);
+}
+
+/**
+ * Remove the promise for the specified id (if present)
+ *
+ * @param id The id of the promise
+ */
+inline void PromiseTable::Remove(PromiseCounter id)
+{
+  Extract(id);
+}
+
+/**
+ * Get the number of promises which are currently held in the overflow map
+ *
+ * @return The number of overflowed promises
+ */
+inline std::size_t PromiseTable::overflow_size() const
+{
+  return overflow_count_.load(std::memory_order_acquire);
+}
+
+inline Promise PromiseTable::ExtractFromOverflow(PromiseCounter id)
+{
+  Promise promise{};
+
+  FETCH_LOCK(overflow_lock_);
+  auto it = overflow_.find(id);
+  if (it != overflow_.end())
+  {
+    promise = std::move(it->second);
+    overflow_.erase(it);
+    overflow_count_.store(overflow_.size(), std::memory_order_release);
+  }
+
+  return promise;
+}
+
+}  // namespace service
+}  // namespace fetch
@@ -26,6 +26,9 @@
 #include "network/service/protocol.hpp"
 #include "network/service/types.hpp"
 
+#include <utility>
+#include <vector>
+
 namespace fetch {
 namespace service {
 
@@ -77,7 +80,10 @@ protected:
     switch (type)
     {
     case SERVICE_FUNCTION_CALL:
-      success = HandleRPCCallRequest(address, params, context);
+      success = HandleRPCCallRequest(address, std::move(params), context);
+      break;
+    case SERVICE_BATCH:
+      success = HandleBatchRequest(address, std::move(params), context);
       break;
     default:
       FETCH_LOG_WARN(LOGGING_NAME, "PushProtocolRequest type not recognised ", type);
@@ -90,9 +96,62 @@ protected:
   bool HandleRPCCallRequest(ConstByteArray const &address, SerializerType params,
                             CallContext const &context = CallContext())
   {
-    bool           ret = true;
+    SerializerType result = ExecuteRequest(params, context);
+
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Service Server responding to call from ", address.ToHex(),
+                    " data size=", result.tell());
+
+    {
+      DeliverResponse(address, result.data());
+    }
+    return true;
+  }
+
+  /**
+   * Handle a batch of function calls, the results of which are returned in a single response (in
+   * the same order as the calls)
+   */
+  bool HandleBatchRequest(ConstByteArray const &address, SerializerType params,
+                          CallContext const &context = CallContext())
+  {
+    std::vector<network::MessageBuffer> requests{};
+    params >> requests;
+
+    std::vector<network::MessageBuffer> responses{};
+    responses.reserve(requests.size());
+
+    for (auto const &request : requests)
+    {
+      SerializerType            call(request);
+      ServiceClassificationType type;
+      call >> type;
+
+      // batches may only contain function calls
+      if (type != SERVICE_FUNCTION_CALL)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Batch request contains invalid type ", type);
+        continue;
+      }
+
+      responses.emplace_back(ExecuteRequest(call, context).data());
+    }
+
+    SerializerType result;
+    result.Append(SERVICE_BATCH, responses);
+
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Service Server responding to batch of ", responses.size(),
+                    " calls from ", address.ToHex(), " data size=", result.tell());
+
+    DeliverResponse(address, result.data());
+
+    return true;
+  }
+
+private:
+  SerializerType ExecuteRequest(SerializerType &params, CallContext const &context)
+  {
     SerializerType result;
-    PromiseCounter id;
+    PromiseCounter id{0};
 
     try
     {
@@ -106,20 +165,13 @@ protected:
     {
       FETCH_LOG_ERROR(LOGGING_NAME, "Serialization error (Function Call): ", e.what());
       result = SerializerType();
-      result << SERVICE_ERROR << id << e;
+      result.Append(SERVICE_ERROR, id, e);
     }
 
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Service Server responding to call from ", address.ToHex(),
-                    " data size=", result.tell());
-
-    {
-      DeliverResponse(address, result.data());
-    }
-    return ret;
+    return result;
   }
 
-private:
-  void ExecuteCall(SerializerType &result, SerializerType params,
+  void ExecuteCall(SerializerType &result, SerializerType &params,
                    CallContext const &context = CallContext())
   {
     ProtocolHandlerType protocol_number;
@@ -0,0 +1,106 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/management/abstract_connection.hpp"
+#include "network/message.hpp"
+#include "network/shm/shm_ring.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace fetch {
+namespace network {
+
+/**
+ * A connection to a process on the same host, carrying messages over a pair of rings in shared
+ * memory instead of through the network stack.
+ *
+ * Alongside the segment each connection has a unix domain socket. It is used to hand the segment
+ * over when connecting, to detect the other side going away and as a doorbell, which is only rung
+ * when the reader has run out of data and is about to sleep. While messages are flowing neither
+ * side makes any system calls.
+ */
+class ShmConnection : public AbstractConnection
+{
+public:
+  using SegmentPtr = ShmSegment::SegmentPtr;
+
+  static constexpr char const *LOGGING_NAME = "ShmConnection";
+
+  static std::string SocketPath(uint16_t port);
+  static bool        IsAvailable(uint16_t port);
+
+  // Construction / Destruction
+  ShmConnection();
+  ShmConnection(int socket, SegmentPtr segment);
+  ShmConnection(ShmConnection const &) = delete;
+  ShmConnection(ShmConnection &&)      = delete;
+  ~ShmConnection() override;
+
+  // Operators
+  ShmConnection &operator=(ShmConnection const &) = delete;
+  ShmConnection &operator=(ShmConnection &&) = delete;
+
+  bool Connect(uint16_t port);
+  void Start();
+
+  /// @name Abstract Connection Interface
+  /// @{
+  void     Send(MessageBuffer const &msg, Callback const &success = nullptr,
+                Callback const &fail     = nullptr,
+                MessagePriority priority = MessagePriority::NORMAL) override;
+  uint16_t Type() const override;
+  void     Close() override;
+  bool     Closed() const override;
+  bool     is_alive() const override;
+  /// @}
+
+private:
+  static void Run(WeakPointerType const &weak);
+
+  bool Poll();
+  bool Receive(std::size_t &received);
+  bool WaitForDoorbell();
+  bool Write(uint8_t const *data, std::size_t length);
+  void RingDoorbell();
+
+  uint16_t const    type_;
+  int               socket_{-1};
+  SegmentPtr        segment_{};
+  ShmRing *         outgoing_{nullptr};
+  ShmRing *         incoming_{nullptr};
+  std::atomic<bool> closed_{false};
+  std::mutex        send_lock_;
+  std::thread       reader_;
+
+  // reader state, only accessed from the reader thread
+  std::size_t   idle_polls_{0};
+  std::size_t   length_received_{0};
+  uint8_t       length_bytes_[sizeof(uint64_t)]{};
+  uint64_t      length_{0};
+  std::size_t   body_received_{0};
+  MessageBuffer message_{};
+};
+
+}  // namespace network
+}  // namespace fetch
@@ -0,0 +1,104 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/filesystem/map_file.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace fetch {
+namespace network {
+
+/**
+ * The control block of a single producer, single consumer ring. It lives in shared memory so every
+ * field is a lock free atomic, the positions only ever increase and are reduced modulo the
+ * capacity when the data is accessed.
+ */
+struct ShmRingHeader
+{
+  alignas(64) std::atomic<uint64_t> head{0};  ///< Read position, only written by the consumer
+  alignas(64) std::atomic<uint64_t> tail{0};  ///< Write position, only written by the producer
+  alignas(64) std::atomic<uint32_t> reader_waiting{0};
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory rings require lock free atomics");
+
+/**
+ * A byte stream between two processes, one writing and one reading. Neither side ever blocks, the
+ * caller decides how to wait when the ring is full or empty.
+ */
+class ShmRing
+{
+public:
+  ShmRing(ShmRingHeader *header, uint8_t *data, std::size_t capacity);
+
+  std::size_t Write(uint8_t const *data, std::size_t length);
+  std::size_t Read(uint8_t *data, std::size_t length);
+
+  std::size_t readable() const;
+  std::size_t writable() const;
+  std::size_t capacity() const;
+
+  ShmRingHeader &header();
+
+private:
+  ShmRingHeader *header_;
+  uint8_t *      data_;
+  std::size_t    capacity_;
+  std::size_t    mask_;
+};
+
+/**
+ * A named POSIX shared memory segment holding the two rings of a connection, the first carrying
+ * data from the creator of the segment and the second data towards it.
+ */
+class ShmSegment
+{
+public:
+  using SegmentPtr = std::unique_ptr<ShmSegment>;
+
+  static constexpr std::size_t DEFAULT_RING_CAPACITY = std::size_t{1} << 22u;
+
+  static SegmentPtr Create(std::string const &name,
+                           std::size_t        ring_capacity = DEFAULT_RING_CAPACITY);
+  static SegmentPtr Open(std::string const &name);
+  static void       Unlink(std::string const &name);
+
+  ShmSegment(ShmSegment const &) = delete;
+  ShmSegment(ShmSegment &&)      = delete;
+  ~ShmSegment()                  = default;
+
+  ShmSegment &operator=(ShmSegment const &) = delete;
+  ShmSegment &operator=(ShmSegment &&) = delete;
+
+  ShmRing &outgoing(bool creator);
+  ShmRing &incoming(bool creator);
+
+private:
+  explicit ShmSegment(core::MappedMemory mapping);
+
+  core::MappedMemory mapping_;
+  ShmRing            rings_[2];
+};
+
+}  // namespace network
+}  // namespace fetch
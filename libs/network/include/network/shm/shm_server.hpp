@@ -0,0 +1,90 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/management/abstract_connection.hpp"
+#include "network/message.hpp"
+#include "network/tcp/abstract_server.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace network {
+
+class AbstractConnectionRegister;
+
+/**
+ * Accepts shared memory connections from processes on the same host. The server listens on a unix
+ * domain socket named after the port of the TCP server of the node, which is how clients find it.
+ * Messages from the accepted connections are pushed as requests, which derived classes handle.
+ */
+class ShmServer : public AbstractNetworkServer
+{
+public:
+  using ConnectionHandleType = typename AbstractConnection::ConnectionHandleType;
+
+  static constexpr char const *LOGGING_NAME = "ShmServer";
+
+  // Construction / Destruction
+  explicit ShmServer(uint16_t port);
+  ShmServer(ShmServer const &) = delete;
+  ShmServer(ShmServer &&)      = delete;
+  ~ShmServer() override;
+
+  // Operators
+  ShmServer &operator=(ShmServer const &) = delete;
+  ShmServer &operator=(ShmServer &&) = delete;
+
+  bool Start();
+  void Stop();
+
+  uint16_t GetListeningPort() const override;
+  void     PushRequest(ConnectionHandleType client, MessageBuffer const &msg) override;
+
+  void SetConnectionRegister(std::weak_ptr<AbstractConnectionRegister> const &reg)
+  {
+    connection_register_ = reg;
+  }
+
+  uint16_t port() const
+  {
+    return port_;
+  }
+
+private:
+  using WeakConnections = std::vector<std::weak_ptr<AbstractConnection>>;
+
+  void Accept();
+  void Handshake(int socket);
+
+  uint16_t const                            port_;
+  int                                       listener_{-1};
+  std::atomic<bool>                         running_{false};
+  std::thread                               acceptor_;
+  std::weak_ptr<AbstractConnectionRegister> connection_register_;
+  std::mutex                                connections_lock_;
+  WeakConnections                           connections_;
+};
+
+}  // namespace network
+}  // namespace fetch
@@ -20,6 +20,8 @@
 #include "network/management/abstract_connection.hpp"
 #include "network/message.hpp"
 
+#include <vector>
+
 namespace fetch {
 namespace network {
 
@@ -27,6 +29,7 @@ class AbstractNetworkServer
 {
 public:
   using ConnectionHandleType = typename AbstractConnection::ConnectionHandleType;
+  using MessageBuffers       = std::vector<MessageBuffer>;
 
   // Construction / Destruction
   AbstractNetworkServer()          = default;
@@ -37,6 +40,17 @@ public:
   virtual uint16_t GetListeningPort() const                                           = 0;
   virtual void     PushRequest(ConnectionHandleType client, MessageBuffer const &msg) = 0;
   /// @}
+
+  /**
+   * Handles a batch of messages received from a client in a single read, in order
+   */
+  virtual void PushRequests(ConnectionHandleType client, MessageBuffers const &msgs)
+  {
+    for (auto const &msg : msgs)
+    {
+      PushRequest(client, msg);
+    }
+  }
 };
 
 }  // namespace network
@@ -24,6 +24,8 @@
 #include "network/management/client_manager.hpp"
 #include "network/management/network_manager.hpp"
 #include "network/message.hpp"
+#include "network/message_queue.hpp"
+#include "network/tcp/message_framer.hpp"
 
 #include "network/fetch_asio.hpp"
 #include <atomic>
@@ -111,11 +113,12 @@ public:
 
     strand_ = strong_strand;
 
-    ReadHeader(strong_strand);
+    Read(strong_strand);
   }
 
   void Send(MessageBuffer const &msg, Callback const &success = nullptr,
-            Callback const &fail = nullptr) override
+            Callback const &fail     = nullptr,
+            MessagePriority priority = MessagePriority::NORMAL) override
   {
     if (shutting_down_)
     {
@@ -125,8 +128,7 @@ public:
 
     {
       FETCH_LOCK(queue_mutex_);
-      // write_queue_.emplace_back(msg);
-      write_queue_.push_back({msg, success, fail});
+      write_queue_.Push({msg, success, fail, priority});
     }
 
     std::weak_ptr<AbstractConnection> self   = shared_from_this();
@@ -188,26 +190,16 @@ private:
   // bool                  posted_close_ = false;
   std::weak_ptr<Strand> strand_;
 
-  MessageQueueType  write_queue_;
+  MessageQueue      write_queue_;
   mutable MutexType can_write_mutex_;
   bool              can_write_{true};
   mutable MutexType queue_mutex_;
 
-  // TODO(issue 17): put this in shared class
-  static const uint64_t networkMagic_ = 0xFE7C80A1FE7C80A1;
+  // only accessed by the single outstanding read
+  MessageFramer           framer_;
+  MessageFramer::Messages received_;
 
-  // TODO(issue 17): fix this to be self-contained
-  union
-  {
-    char bytes[2 * sizeof(uint64_t)];
-    struct
-    {
-      uint64_t magic;
-      uint64_t length;
-    } content;
-  } header_{};
-
-  void ReadHeader(StrongStrand const &strong_strand)
+  void Read(StrongStrand const &strong_strand)
   {
     if (shutting_down_)
     {
@@ -220,99 +212,47 @@ private:
       return;
     }
 
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Waiting for next header.");
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Waiting for data.");
     auto self(shared_from_this());
     auto cb = [this, socket_ptr, self, strong_strand](std::error_code ec, std::size_t len) {
-      FETCH_UNUSED(len);
-
       auto ptr = manager_.lock();
       if (!ptr)
       {
         return;
       }
 
-      if (!ec)
-      {
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Read header.");
-        ReadBody(strong_strand);
-      }
-      else
+      if (ec)
       {
         ptr->Leave(this->handle());
-      }
-    };
-
-    asio::async_read(*socket_ptr, asio::buffer(header_.bytes, 2 * sizeof(uint64_t)), cb);
-  }
-
-  void ReadBody(StrongStrand const &strong_strand)
-  {
-    if (shutting_down_)
-    {
-      return;
-    }
-
-    auto socket_ptr = socket_.lock();
-    if (!socket_ptr)
-    {
-      return;
-    }
-
-    byte_array::ByteArray message;
-
-    if (header_.content.magic != networkMagic_)
-    {
-      FETCH_LOG_DEBUG(LOGGING_NAME, "Magic incorrect - closing connection.");
-      auto ptr = manager_.lock();
-      if (!ptr)
-      {
         return;
       }
-      ptr->Leave(this->handle());
-      return;
-    }
-
-    message.Resize(header_.content.length);
-    auto self(shared_from_this());
-    auto cb = [this, socket_ptr, self, message, strong_strand](std::error_code ec,
-                                                               std::size_t     len) {
-      FETCH_UNUSED(len);
 
-      auto ptr = manager_.lock();
-      if (!ptr)
+      if (!framer_.Commit(len, received_))
       {
+        FETCH_LOG_DEBUG(LOGGING_NAME, "Magic incorrect - closing connection.");
+        ptr->Leave(this->handle());
         return;
       }
 
-      if (!ec)
+      // every message completed by the read is delivered together
+      if (!received_.empty())
       {
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Recv message");
+        FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Recv ", received_.size(), " messages");
 
-        ptr->PushRequest(this->handle(), message);
-        ReadHeader(strong_strand);
-      }
-      else
-      {
-        ptr->Leave(this->handle());
+        ptr->PushRequests(this->handle(), received_);
+        received_.clear();
       }
+
+      Read(strong_strand);
     };
 
-    asio::async_read(*socket_ptr, asio::buffer(message.pointer(), message.size()), cb);
+    socket_ptr->async_read_some(asio::buffer(framer_.ReadPointer(), framer_.ReadSize()), cb);
   }
 
   static void SetHeader(byte_array::ByteArray &header, uint64_t bufSize)
   {
-    header.Resize(16);
-
-    for (std::size_t i = 0; i < 8; ++i)
-    {
-      header[i] = uint8_t((networkMagic_ >> i * 8) & 0xff);
-    }
-
-    for (std::size_t i = 0; i < 8; ++i)
-    {
-      header[i + 8] = uint8_t((bufSize >> i * 8) & 0xff);
-    }
+    header.Resize(MessageFramer::HEADER_SIZE);
+    MessageFramer::WriteHeader(header.pointer(), bufSize);
   }
 
   // Always executed in a run(), in a strand
@@ -341,8 +281,7 @@ private:
         can_write_ = true;
         return;
       }
-      message = write_queue_.front();
-      write_queue_.pop_front();
+      write_queue_.Pop(message);
     }
 
     byte_array::ByteArray header;
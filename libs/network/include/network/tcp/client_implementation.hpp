@@ -27,8 +27,12 @@
 #include "network/management/abstract_connection.hpp"
 #include "network/management/network_manager.hpp"
 #include "network/message.hpp"
+#include "network/message_queue.hpp"
+#include "network/tcp/message_framer.hpp"
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -47,8 +51,9 @@ public:
   using ResolverType       = asio::ip::tcp::resolver;
   using MutexType          = std::mutex;
 
-  static const uint64_t        NETWORK_MAGIC = 0xFE7C80A1FE7C80A1;
+  static const uint64_t        NETWORK_MAGIC = MessageFramer::NETWORK_MAGIC;
   static constexpr char const *LOGGING_NAME  = "TCPClientImpl";
+  static constexpr std::size_t HEADER_SIZE   = MessageFramer::HEADER_SIZE;
 
   explicit TCPClientImplementation(NetworkManagerType const &network_manager) noexcept;
   TCPClientImplementation(TCPClientImplementation const &rhs) = delete;
@@ -62,7 +67,8 @@ public:
   bool is_alive() const override;
 
   void Send(MessageBuffer const &omsg, Callback const &success = nullptr,
-            Callback const &fail = nullptr) override;
+            Callback const &fail     = nullptr,
+            MessagePriority priority = MessagePriority::NORMAL) override;
 
   uint16_t Type() const override;
 
@@ -82,7 +88,7 @@ private:
   std::weak_ptr<SocketType> socket_;
   std::weak_ptr<StrandType> strand_;
 
-  MessageQueueType  write_queue_;
+  MessageQueue      write_queue_;
   mutable MutexType queue_mutex_;
   mutable MutexType io_creation_mutex_;
 
@@ -93,8 +99,15 @@ private:
   mutable MutexType callback_mutex_;
   std::atomic<bool> connected_{false};
 
-  void ReadHeader() noexcept;
-  void ReadBody(byte_array::ByteArray const &header) noexcept;
+  static constexpr std::size_t MAX_MESSAGES_PER_WRITE = 64;
+
+  static void WriteHeader(uint8_t *header, uint64_t bufSize);
+
+  // only accessed by the single outstanding read
+  MessageFramer           framer_;
+  MessageFramer::Messages received_;
+
+  void Read() noexcept;
 
   // Always executed in a run(), in a strand
   void WriteNext(SharedSelfType const &selfLock);
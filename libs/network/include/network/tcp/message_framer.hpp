@@ -0,0 +1,69 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/message.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace network {
+
+/**
+ * Splits the byte stream of a TCP connection into messages. Each read from the socket fills as
+ * much of a large buffer as the socket has available, after which every complete message in the
+ * buffer is extracted at once. Connections under load then need a single read per batch of
+ * messages rather than two per message.
+ *
+ * Messages too large for the buffer are read straight into their own storage once their header
+ * has been seen.
+ */
+class MessageFramer
+{
+public:
+  using Messages = std::vector<MessageBuffer>;
+
+  static constexpr uint64_t    NETWORK_MAGIC     = 0xFE7C80A1FE7C80A1;
+  static constexpr std::size_t HEADER_SIZE       = 2 * sizeof(uint64_t);
+  static constexpr std::size_t DEFAULT_READ_SIZE = std::size_t{64} << 10u;
+
+  explicit MessageFramer(std::size_t read_size = DEFAULT_READ_SIZE);
+
+  uint8_t *   ReadPointer();
+  std::size_t ReadSize() const;
+  bool        Commit(std::size_t length, Messages &messages);
+
+  static void WriteHeader(uint8_t *header, uint64_t length);
+
+private:
+  bool Extract(Messages &messages);
+
+  std::size_t const    read_size_;
+  std::vector<uint8_t> buffer_;
+  std::size_t          begin_{0};  ///< Start of the unprocessed data
+  std::size_t          end_{0};    ///< End of the received data
+
+  // the large message currently being read directly into its storage
+  MessageBuffer large_message_{};
+  std::size_t   large_received_{0};
+};
+
+}  // namespace network
+}  // namespace fetch
@@ -67,6 +67,7 @@ public:
 
   uint16_t GetListeningPort() const override;
   void     PushRequest(ConnectionHandleType client, MessageBuffer const &msg) override;
+  void     PushRequests(ConnectionHandleType client, MessageBuffers const &msgs) override;
 
   void Broadcast(MessageBuffer const &msg);
   bool Send(ConnectionHandleType const &client, MessageBuffer const &msg);
@@ -36,6 +36,14 @@ namespace details {
 using std::chrono::milliseconds;
 using std::this_thread::sleep_for;
 
+namespace {
+
+/// The pool (and queue index) that the current thread dispatches for, if any
+thread_local ThreadPoolImplementation const *current_pool{nullptr};
+thread_local std::size_t                     current_queue{0};
+
+}  // namespace
+
 /**
  * Construct the thread pool implementation
  *
@@ -44,7 +52,16 @@ using std::this_thread::sleep_for;
 ThreadPoolImplementation::ThreadPoolImplementation(std::size_t threads, std::string name)
   : max_threads_(threads)
   , name_(std::move(name))
-{}
+{
+  // always create at least one queue so that posting to an empty pool is well defined
+  std::size_t const num_queues = std::max<std::size_t>(max_threads_, 1);
+
+  work_.reserve(num_queues);
+  for (std::size_t i = 0; i < num_queues; ++i)
+  {
+    work_.emplace_back(std::make_unique<WorkStore>());
+  }
+}
 
 /**
  * Tear down the thread pool
@@ -59,28 +76,78 @@ ThreadPoolImplementation::~ThreadPoolImplementation()
  *
  * @param item The work item to execute
  * @param milliseconds The (minimum) time to postpone the execution for
+ * @return The handle which can be used to cancel the work item
  */
-void ThreadPoolImplementation::Post(WorkItem item, uint32_t milliseconds)
+ThreadPoolImplementation::FutureHandle ThreadPoolImplementation::Post(WorkItem item,
+                                                                      uint32_t milliseconds)
 {
+  FutureHandle handle{FutureWorkStore::INVALID_HANDLE};
+
   if (!shutdown_)
   {
-    future_work_.Post(std::move(item), milliseconds);
+    handle = future_work_.Post(std::move(item), milliseconds);
 
     FETCH_LOCK(idle_mutex_);
     work_available_.notify_one();
   }
+
+  return handle;
+}
+
+/**
+ * Cancel a piece of work which was posted for execution in the future
+ *
+ * @param handle The handle returned when the work was posted
+ * @return true if the work was pending and has been cancelled, otherwise false
+ */
+bool ThreadPoolImplementation::Cancel(FutureHandle handle)
+{
+  return future_work_.Cancel(handle);
 }
 
 /**
  * Post a piece of work to be executed
  *
+ * Work posted from one of the pool's own threads stays on that thread's queue, other work is
+ * spread evenly over all the queues.
+ *
  * @param item The work item to execute
  */
-void ThreadPoolImplementation::Post(WorkItem item)
+void ThreadPoolImplementation::Post(Task item)
+{
+  std::size_t const index =
+      (current_pool == this) ? current_queue : (next_queue_++ % work_.size());
+
+  Enqueue(index, std::move(item));
+}
+
+/**
+ * Post a piece of work to be executed, preferably by the thread selected by the affinity hint.
+ *
+ * Work items posted with the same affinity value are queued for the same thread which keeps
+ * their data warm in that core's caches. Idle threads may still steal the work.
+ *
+ * @param affinity The affinity hint (any value, it is reduced modulo the number of threads)
+ * @param item The work item to execute
+ */
+void ThreadPoolImplementation::PostWithAffinity(std::size_t affinity, Task item)
+{
+  Enqueue(affinity % work_.size(), std::move(item));
+}
+
+/**
+ * Add a work item to the specified queue and wake a sleeping thread to service it
+ *
+ * @param index The index of the queue
+ * @param item The work item to execute
+ * @private
+ */
+void ThreadPoolImplementation::Enqueue(std::size_t index, Task item)
 {
   if (!shutdown_)
   {
-    work_.Post(std::move(item));
+    work_[index]->Post(std::move(item));
+    ++queued_work_;
 
     FETCH_LOCK(idle_mutex_);
     work_available_.notify_one();
@@ -97,6 +164,17 @@ void ThreadPoolImplementation::SetIdleInterval(std::size_t milliseconds)
   idle_work_.SetInterval(milliseconds);
 }
 
+/**
+ * Restrict the dispatch threads to sets of CPUs. Thread `n` is restricted to the entry
+ * `n % affinity.size()`. This must be called before the pool is started.
+ *
+ * @param affinity The CPUs for each of the threads, or an empty list for no restriction
+ */
+void ThreadPoolImplementation::SetAffinity(std::vector<core::CpuList> affinity)
+{
+  affinity_ = std::move(affinity);
+}
+
 /**
  * Add a work item to the idle store
  *
@@ -120,7 +198,11 @@ void ThreadPoolImplementation::Clear()
 {
   future_work_.Clear();
   idle_work_.Clear();
-  work_.Clear();
+
+  for (auto &queue : work_)
+  {
+    queued_work_ -= queue->Clear();
+  }
 }
 
 /**
@@ -193,7 +275,11 @@ void ThreadPoolImplementation::Stop()
     shutdown_ = true;
     future_work_.Abort();
     idle_work_.Abort();
-    work_.Abort();
+
+    for (auto &queue : work_)
+    {
+      queue->Abort();
+    }
 
     {
       // kick all the threads to start wake and
@@ -215,9 +301,7 @@ void ThreadPoolImplementation::Stop()
     threads.clear();
 
     // clear all the work items inside the respective queues
-    future_work_.Clear();
-    idle_work_.Clear();
-    work_.Clear();
+    Clear();
   });
 }
 
@@ -231,18 +315,27 @@ void ThreadPoolImplementation::ProcessLoop(std::size_t index)
 {
   SetThreadName("TP:" + name_, index);
 
+  if (!affinity_.empty())
+  {
+    core::SetThreadAffinity(affinity_[index % affinity_.size()]);
+  }
+
+  // route work posted from this thread to its own queue
+  current_pool  = this;
+  current_queue = index;
+
   FETCH_LOG_DEBUG(LOGGING_NAME, "Creating thread pool worker (thread: ", index, ')');
 
   try
   {
     while (!shutdown_)
     {
-      if (!Poll())
+      if (!Poll(index))
       {
         std::unique_lock<std::mutex> lock(idle_mutex_);
 
-        // double check the emptiness of the queue because there is a race here
-        if (!work_.IsEmpty())
+        // double check the emptiness of the queues because there is a race here
+        if (queued_work_ != 0)
         {
           FETCH_LOG_DEBUG(LOGGING_NAME, "Restarting the inactive thread (thread: ", index,
                           " queue: ", name_, ')');
@@ -296,14 +389,15 @@ void ThreadPoolImplementation::ProcessLoop(std::size_t index)
 /**
  * Periodic call made by dispatch threads to execute pending work in the queues
  *
+ * @param index The index of the calling thread
  * @return false if the thread should enter an idle state next, otherwise true
  */
-bool ThreadPoolImplementation::Poll()
+bool ThreadPoolImplementation::Poll(std::size_t index)
 {
   std::size_t count = 0;
 
-  // dispatch any active tasks in the queue
-  count += work_.Dispatch([this](WorkItem const &item) { ExecuteWorkload(item); });
+  // dispatch any active tasks in the queues
+  count += DispatchQueuedWork(index);
 
   // allow early exit in abort / shutdowns
   if (shutdown_)
@@ -332,6 +426,32 @@ bool ThreadPoolImplementation::Poll()
   return (count > 0);
 }
 
+/**
+ * Execute a single item from the thread's own queue or, failing that, steal one from the queue of
+ * another thread
+ *
+ * @param index The index of the calling thread
+ * @return The number of items executed
+ */
+std::size_t ThreadPoolImplementation::DispatchQueuedWork(std::size_t index)
+{
+  auto const execute = [this](Task &item) {
+    --queued_work_;
+    ExecuteWorkload(item);
+  };
+
+  // fast path: our own queue
+  std::size_t count = work_[index]->Dispatch(execute);
+
+  // visit the other queues starting with our neighbour so that thieves spread out
+  for (std::size_t offset = 1; (count == 0) && (offset < work_.size()) && !shutdown_; ++offset)
+  {
+    count = work_[(index + offset) % work_.size()]->Steal(execute);
+  }
+
+  return count;
+}
+
 /**
  * Wrapper around execution of a work item
  *
@@ -340,7 +460,8 @@ bool ThreadPoolImplementation::Poll()
  * @param workload The work item to be executed
  * @return true on successful execution, otherwise false
  */
-bool ThreadPoolImplementation::ExecuteWorkload(WorkItem const &workload)
+template <typename Workload>
+bool ThreadPoolImplementation::ExecuteWorkload(Workload &workload)
 {
   bool success = false;
 
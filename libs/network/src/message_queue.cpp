@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/message_queue.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace fetch {
+namespace network {
+
+constexpr std::size_t MessageQueue::NUM_PRIORITIES;
+constexpr std::size_t MessageQueue::MAX_CONSECUTIVE;
+
+/**
+ * Add a message to the back of the queue for its priority
+ *
+ * @param message The message to be queued
+ */
+void MessageQueue::Push(MessageType message)
+{
+  queues_[ToIndex(message.priority)].emplace_back(std::move(message));
+  ++size_;
+}
+
+/**
+ * Extract the next message to be written
+ *
+ * @param message The output message
+ * @return true if a message was extracted, false if the queue is empty
+ */
+bool MessageQueue::Pop(MessageType &message)
+{
+  for (std::size_t index = 0; index < NUM_PRIORITIES; ++index)
+  {
+    auto &queue = queues_[index];
+    if (queue.empty())
+    {
+      continue;
+    }
+
+    bool const lower_waiting = IsLowerPriorityWaiting(index);
+
+    // allow a waiting lower priority message to go first once this priority has had its share
+    if (lower_waiting && (consecutive_[index] >= MAX_CONSECUTIVE))
+    {
+      consecutive_[index] = 0;
+      continue;
+    }
+
+    consecutive_[index] = lower_waiting ? (consecutive_[index] + 1) : 0;
+
+    message = std::move(queue.front());
+    queue.pop_front();
+    --size_;
+
+    return true;
+  }
+
+  return false;
+}
+
+void MessageQueue::Clear()
+{
+  for (auto &queue : queues_)
+  {
+    queue.clear();
+  }
+
+  consecutive_.fill(0);
+  size_ = 0;
+}
+
+bool MessageQueue::empty() const
+{
+  return size_ == 0;
+}
+
+std::size_t MessageQueue::size() const
+{
+  return size_;
+}
+
+std::size_t MessageQueue::size(MessagePriority priority) const
+{
+  return queues_[ToIndex(priority)].size();
+}
+
+std::size_t MessageQueue::ToIndex(MessagePriority priority)
+{
+  return std::min<std::size_t>(static_cast<std::size_t>(priority), NUM_PRIORITIES - 1);
+}
+
+bool MessageQueue::IsLowerPriorityWaiting(std::size_t index) const
+{
+  return std::any_of(queues_.begin() + static_cast<std::ptrdiff_t>(index + 1), queues_.end(),
+                     [](Queue const &queue) { return !queue.empty(); });
+}
+
+}  // namespace network
+}  // namespace fetch
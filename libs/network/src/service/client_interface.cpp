@@ -57,6 +57,10 @@ bool ServiceClientInterface::ProcessServerMessage(network::MessageBuffer const &
   {
     ProcessRPCResult(msg, params);
   }
+  else if (type == SERVICE_BATCH)
+  {
+    ProcessBatchResult(params);
+  }
   else if (type == SERVICE_ERROR)
   {
     PromiseCounter id;
@@ -92,31 +96,41 @@ bool ServiceClientInterface::ProcessServerMessage(network::MessageBuffer const &
   return ret;
 }
 
+void ServiceClientInterface::ProcessBatchResult(service::SerializerType &params)
+{
+  std::vector<network::MessageBuffer> responses{};
+  params >> responses;
+
+  for (auto const &response : responses)
+  {
+    SerializerType            result(response);
+    ServiceClassificationType type;
+    result >> type;
+
+    // batches can not be nested
+    if (type == SERVICE_BATCH)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Ignoring nested batch response");
+      continue;
+    }
+
+    ProcessServerMessage(response);
+  }
+}
+
 void ServiceClientInterface::AddPromise(Promise const &promise)
 {
-  FETCH_LOCK(promises_mutex_);
-  promises_[promise->id()] = promise;
+  promises_.Add(promise);
 }
 
 Promise ServiceClientInterface::ExtractPromise(PromiseCounter id)
 {
-  Promise promise{};
-
-  FETCH_LOCK(promises_mutex_);
-  auto it = promises_.find(id);
-  if (it != promises_.end())
-  {
-    promise = it->second;
-    promises_.erase(it);
-  }
-
-  return promise;
+  return promises_.Extract(id);
 }
 
 void ServiceClientInterface::RemovePromise(PromiseCounter id)
 {
-  FETCH_LOCK(promises_mutex_);
-  promises_.erase(id);
+  promises_.Remove(id);
 }
 
 }  // namespace service
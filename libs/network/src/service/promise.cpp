@@ -47,8 +47,7 @@ void LogTimout(NAME const &name, ID const &id)
 
 }  // namespace
 
-PromiseImplementation::Counter PromiseImplementation::counter_{0};
-Mutex                          PromiseImplementation::counter_lock_;
+std::atomic<PromiseImplementation::Counter> PromiseImplementation::counter_{0};
 
 std::chrono::seconds const PromiseImplementation::DEFAULT_TIMEOUT{30};
 
@@ -262,8 +261,7 @@ void PromiseImplementation::DispatchCallbacks() const
 
 PromiseImplementation::Counter PromiseImplementation::GetNextId()
 {
-  FETCH_LOCK(counter_lock_);
-  return counter_++;
+  return counter_.fetch_add(1, std::memory_order_relaxed);
 }
 
 // promise builder
@@ -0,0 +1,523 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "logging/logging.hpp"
+#include "network/shm/shm_connection.hpp"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace fetch {
+namespace network {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t SPIN_LIMIT          = 1000;  ///< Empty polls before the reader sleeps
+constexpr int         DOORBELL_TIMEOUT_MS = 100;   ///< Upper bound on a single sleep
+constexpr uint64_t    MAX_MESSAGE_LENGTH  = uint64_t{1} << 32u;
+constexpr uint8_t     HANDSHAKE_ACK       = 0xA5;
+
+constexpr auto SEND_TIMEOUT      = std::chrono::seconds{10};
+constexpr auto WRITER_BACKOFF    = std::chrono::microseconds{50};
+constexpr auto HANDSHAKE_TIMEOUT = std::chrono::seconds{2};
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+std::string NextSegmentName()
+{
+  static std::atomic<uint64_t> counter{0};
+  return "/fetch-shm-" + std::to_string(::getpid()) + "-" + std::to_string(counter++);
+}
+
+bool SetTimeouts(int socket)
+{
+  timeval timeout{};
+  timeout.tv_sec = static_cast<decltype(timeout.tv_sec)>(HANDSHAKE_TIMEOUT.count());
+
+  return (::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0) &&
+         (::setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) == 0);
+}
+
+int ConnectSocket(std::string const &path)
+{
+  sockaddr_un address{};
+  if (path.size() >= sizeof(address.sun_path))
+  {
+    return -1;
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  int const fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+  {
+    return -1;
+  }
+
+  if (!SetTimeouts(fd) ||
+      (::connect(fd, reinterpret_cast<sockaddr const *>(&address), sizeof(address)) != 0))
+  {
+    ::close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+}  // namespace
+
+/**
+ * @param port The port of the TCP server of the node
+ * @return The path of the socket on which the node accepts shared memory connections
+ */
+std::string ShmConnection::SocketPath(uint16_t port)
+{
+  return "/tmp/fetch-muddle-" + std::to_string(port) + ".sock";
+}
+
+/**
+ * @return true if a node on this host accepts shared memory connections for the port
+ */
+bool ShmConnection::IsAvailable(uint16_t port)
+{
+  struct stat stats
+  {
+  };
+  return (::stat(SocketPath(port).c_str(), &stats) == 0) && S_ISSOCK(stats.st_mode);
+}
+
+/**
+ * Constructs an outgoing connection, which must be connected before it is started
+ */
+ShmConnection::ShmConnection()
+  : type_{TYPE_OUTGOING}
+{}
+
+/**
+ * Constructs an incoming connection from a completed handshake
+ *
+ * @param socket The accepted unix domain socket, owned by the connection
+ * @param segment The segment created by the remote side
+ */
+ShmConnection::ShmConnection(int socket, SegmentPtr segment)
+  : type_{TYPE_INCOMING}
+  , socket_{socket}
+  , segment_{std::move(segment)}
+  , outgoing_{&segment_->outgoing(false)}
+  , incoming_{&segment_->incoming(false)}
+{
+  SetAddress("127.0.0.1");
+}
+
+ShmConnection::~ShmConnection()
+{
+  closed_ = true;
+
+  if (socket_ >= 0)
+  {
+    ::shutdown(socket_, SHUT_RDWR);
+  }
+
+  if (reader_.joinable())
+  {
+    // the last reference can be released by the reader itself, which exits without touching the
+    // connection again
+    if (reader_.get_id() == std::this_thread::get_id())
+    {
+      reader_.detach();
+    }
+    else
+    {
+      reader_.join();
+    }
+  }
+
+  if (socket_ >= 0)
+  {
+    ::close(socket_);
+  }
+}
+
+/**
+ * Hands a new segment to the node listening for the port. The connection is not signalled and does
+ * not read any messages until it is started, so that a failure can fall back to another transport
+ *
+ * @param port The port of the TCP server of the node
+ * @return true if the node accepted the connection
+ */
+bool ShmConnection::Connect(uint16_t port)
+{
+  SetAddress("127.0.0.1");
+  SetPort(port);
+
+  std::string const name = NextSegmentName();
+
+  segment_ = ShmSegment::Create(name);
+  if (!segment_)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to create shared memory segment ", name);
+    return false;
+  }
+
+  socket_ = ConnectSocket(SocketPath(port));
+
+  bool connected = false;
+  if (socket_ >= 0)
+  {
+    auto const length = static_cast<uint8_t>(name.size());
+    uint8_t    ack    = 0;
+
+    connected = (::send(socket_, &length, 1, SEND_FLAGS) == 1) &&
+                (::send(socket_, name.data(), name.size(), SEND_FLAGS) ==
+                 static_cast<ssize_t>(name.size())) &&
+                (::recv(socket_, &ack, 1, MSG_WAITALL) == 1) && (ack == HANDSHAKE_ACK);
+  }
+
+  // the name is no longer needed once both sides have mapped the segment
+  ShmSegment::Unlink(name);
+
+  if (!connected)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Unable to connect to shared memory socket for port ", port);
+
+    if (socket_ >= 0)
+    {
+      ::close(socket_);
+      socket_ = -1;
+    }
+    segment_.reset();
+
+    return false;
+  }
+
+  outgoing_ = &segment_->outgoing(true);
+  incoming_ = &segment_->incoming(true);
+
+  return true;
+}
+
+/**
+ * Starts reading messages, the connection then manages its own lifetime until it is closed
+ */
+void ShmConnection::Start()
+{
+  if (!segment_ || reader_.joinable())
+  {
+    return;
+  }
+
+  ActivateSelfManage();
+
+  WeakPointerType weak = connection_pointer();
+  reader_              = std::thread([weak] { Run(weak); });
+
+  if (type_ == TYPE_OUTGOING)
+  {
+    SignalConnectionSuccess();
+  }
+}
+
+/**
+ * Writes a message to the ring, waiting for the reader to make space if needed. The message is
+ * written before the call returns
+ *
+ * @param msg The message to be sent
+ * @param success The callback for a successful send
+ * @param fail The callback for a failed send
+ */
+void ShmConnection::Send(MessageBuffer const &msg, Callback const &success, Callback const &fail,
+                         MessagePriority /*priority*/)
+{
+  bool sent = false;
+
+  {
+    FETCH_LOCK(send_lock_);
+
+    uint8_t length[sizeof(uint64_t)];
+    auto const msg_length = static_cast<uint64_t>(msg.size());
+    std::memcpy(length, &msg_length, sizeof(length));
+
+    sent = !closed_ && (outgoing_ != nullptr) && Write(length, sizeof(length)) &&
+           Write(msg.pointer(), msg.size());
+  }
+
+  if (sent)
+  {
+    if (success)
+    {
+      success();
+    }
+  }
+  else
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to send message of ", msg.size(), " bytes, closing");
+
+    // a partially written message leaves the stream unusable
+    Close();
+
+    if (fail)
+    {
+      fail();
+    }
+  }
+}
+
+uint16_t ShmConnection::Type() const
+{
+  return type_;
+}
+
+/**
+ * Closes the connection on both sides. The reader then signals the leave and releases the reference
+ * the connection holds to itself
+ */
+void ShmConnection::Close()
+{
+  if (!closed_.exchange(true) && (socket_ >= 0))
+  {
+    // wakes both readers, the remote one sees the end of the stream
+    ::shutdown(socket_, SHUT_RDWR);
+  }
+}
+
+bool ShmConnection::Closed() const
+{
+  return closed_;
+}
+
+bool ShmConnection::is_alive() const
+{
+  return !closed_ && static_cast<bool>(segment_);
+}
+
+/**
+ * The body of the reader thread. A reference to the connection is only held for each poll, so that
+ * releasing the connection elsewhere stops the thread
+ */
+void ShmConnection::Run(WeakPointerType const &weak)
+{
+  for (;;)
+  {
+    auto connection = std::static_pointer_cast<ShmConnection>(weak.lock());
+    if (!connection)
+    {
+      return;
+    }
+
+    if (!connection->Poll())
+    {
+      connection->closed_ = true;
+      connection->SignalLeave();
+      return;
+    }
+  }
+}
+
+/**
+ * Delivers the messages available in the ring, sleeping on the doorbell when it stays empty
+ *
+ * @return false once the connection has been closed on either side
+ */
+bool ShmConnection::Poll()
+{
+  if (closed_)
+  {
+    return false;
+  }
+
+  std::size_t received = 0;
+  if (!Receive(received))
+  {
+    return false;
+  }
+
+  if (received > 0)
+  {
+    idle_polls_ = 0;
+    return true;
+  }
+
+  if (++idle_polls_ < SPIN_LIMIT)
+  {
+    std::this_thread::yield();
+    return true;
+  }
+
+  // the writer rings the doorbell for any data published after the flag became visible to it
+  auto &header = incoming_->header();
+  header.reader_waiting.store(1, std::memory_order_seq_cst);
+
+  bool alive = true;
+  if (incoming_->readable() == 0)
+  {
+    alive = WaitForDoorbell();
+  }
+
+  header.reader_waiting.store(0, std::memory_order_relaxed);
+
+  return alive;
+}
+
+/**
+ * Reads the available data, reassembling and delivering any completed messages
+ *
+ * @param received The number of bytes read from the ring
+ * @return false if the stream is corrupt
+ */
+bool ShmConnection::Receive(std::size_t &received)
+{
+  for (;;)
+  {
+    if (length_received_ < sizeof(length_bytes_))
+    {
+      std::size_t const count = incoming_->Read(length_bytes_ + length_received_,
+                                                sizeof(length_bytes_) - length_received_);
+      if (count == 0)
+      {
+        return true;
+      }
+
+      received += count;
+      length_received_ += count;
+      if (length_received_ < sizeof(length_bytes_))
+      {
+        continue;
+      }
+
+      std::memcpy(&length_, length_bytes_, sizeof(length_));
+      if (length_ > MAX_MESSAGE_LENGTH)
+      {
+        FETCH_LOG_ERROR(LOGGING_NAME, "Invalid message length of ", length_, " bytes");
+        return false;
+      }
+
+      message_ = MessageBuffer{};
+      message_.Resize(static_cast<std::size_t>(length_));
+      body_received_ = 0;
+    }
+
+    if (body_received_ < length_)
+    {
+      std::size_t const count = incoming_->Read(message_.pointer() + body_received_,
+                                                static_cast<std::size_t>(length_) - body_received_);
+      if (count == 0)
+      {
+        return true;
+      }
+
+      received += count;
+      body_received_ += count;
+    }
+
+    if (body_received_ == length_)
+    {
+      length_received_ = 0;
+      SignalMessage(message_);
+    }
+  }
+}
+
+/**
+ * Sleeps until the doorbell rings or the timeout expires
+ *
+ * @return false if the remote side has gone away
+ */
+bool ShmConnection::WaitForDoorbell()
+{
+  pollfd fds{};
+  fds.fd     = socket_;
+  fds.events = POLLIN;
+
+  if (::poll(&fds, 1, DOORBELL_TIMEOUT_MS) <= 0)
+  {
+    return true;
+  }
+
+  uint8_t rings[64];
+  ssize_t const count = ::recv(socket_, rings, sizeof(rings), MSG_DONTWAIT);
+
+  return (count > 0) || ((count < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK) ||
+                                         (errno == EINTR)));
+}
+
+/**
+ * Writes all of the data to the ring, backing off while it is full
+ *
+ * @return false if the reader made no space before the timeout or the connection was closed
+ */
+bool ShmConnection::Write(uint8_t const *data, std::size_t length)
+{
+  auto const  deadline   = Clock::now() + SEND_TIMEOUT;
+  std::size_t full_polls = 0;
+
+  while (length > 0)
+  {
+    std::size_t const count = outgoing_->Write(data, length);
+    if (count > 0)
+    {
+      data += count;
+      length -= count;
+      full_polls = 0;
+
+      RingDoorbell();
+      continue;
+    }
+
+    if (closed_ || (Clock::now() >= deadline))
+    {
+      return false;
+    }
+
+    if (++full_polls < SPIN_LIMIT)
+    {
+      std::this_thread::yield();
+    }
+    else
+    {
+      std::this_thread::sleep_for(WRITER_BACKOFF);
+    }
+  }
+
+  return true;
+}
+
+void ShmConnection::RingDoorbell()
+{
+  if (outgoing_->header().reader_waiting.load(std::memory_order_seq_cst) != 0)
+  {
+    uint8_t const ring = 1;
+    ::send(socket_, &ring, 1, MSG_DONTWAIT | SEND_FLAGS);
+  }
+}
+
+}  // namespace network
+}  // namespace fetch
@@ -0,0 +1,259 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/shm/shm_ring.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace fetch {
+namespace network {
+namespace {
+
+constexpr uint64_t MAGIC = 0x4645544348534d31;  // "FETCHSM1"
+
+/**
+ * The start of every segment, followed by the two ring headers and then the two data areas
+ */
+struct SegmentHeader
+{
+  uint64_t      magic;
+  uint64_t      ring_capacity;
+  ShmRingHeader rings[2];
+};
+
+std::size_t SegmentSize(std::size_t ring_capacity)
+{
+  return sizeof(SegmentHeader) + (2 * ring_capacity);
+}
+
+ShmRing MakeRing(void *address, std::size_t index)
+{
+  auto *const       header   = static_cast<SegmentHeader *>(address);
+  std::size_t const capacity = static_cast<std::size_t>(header->ring_capacity);
+  uint8_t *const    data     = static_cast<uint8_t *>(address) + sizeof(SegmentHeader);
+
+  return {&header->rings[index], data + (index * capacity), capacity};
+}
+
+}  // namespace
+
+ShmRing::ShmRing(ShmRingHeader *header, uint8_t *data, std::size_t capacity)
+  : header_{header}
+  , data_{data}
+  , capacity_{capacity}
+  , mask_{capacity - 1}
+{}
+
+/**
+ * Writes as much of the data as currently fits in the ring
+ *
+ * @param data The data to be written
+ * @param length The length of the data
+ * @return The number of bytes written
+ */
+std::size_t ShmRing::Write(uint8_t const *data, std::size_t length)
+{
+  uint64_t const tail  = header_->tail.load(std::memory_order_relaxed);
+  uint64_t const head  = header_->head.load(std::memory_order_acquire);
+  std::size_t    count = std::min(length, capacity_ - static_cast<std::size_t>(tail - head));
+
+  std::size_t const offset = static_cast<std::size_t>(tail) & mask_;
+  std::size_t const first  = std::min(count, capacity_ - offset);
+  std::memcpy(data_ + offset, data, first);
+  std::memcpy(data_, data + first, count - first);
+
+  // publishing the tail is sequentially consistent so that a reader going to sleep always either
+  // sees the data or is seen waiting by the writer
+  header_->tail.store(tail + count, std::memory_order_seq_cst);
+
+  return count;
+}
+
+/**
+ * Reads as much of the available data as fits in the output
+ *
+ * @param data The output buffer
+ * @param length The size of the output buffer
+ * @return The number of bytes read
+ */
+std::size_t ShmRing::Read(uint8_t *data, std::size_t length)
+{
+  uint64_t const head  = header_->head.load(std::memory_order_relaxed);
+  uint64_t const tail  = header_->tail.load(std::memory_order_acquire);
+  std::size_t    count = std::min(length, static_cast<std::size_t>(tail - head));
+
+  std::size_t const offset = static_cast<std::size_t>(head) & mask_;
+  std::size_t const first  = std::min(count, capacity_ - offset);
+  std::memcpy(data, data_ + offset, first);
+  std::memcpy(data + first, data_, count - first);
+
+  header_->head.store(head + count, std::memory_order_release);
+
+  return count;
+}
+
+std::size_t ShmRing::readable() const
+{
+  return static_cast<std::size_t>(header_->tail.load(std::memory_order_seq_cst) -
+                                  header_->head.load(std::memory_order_relaxed));
+}
+
+std::size_t ShmRing::writable() const
+{
+  return capacity_ - static_cast<std::size_t>(header_->tail.load(std::memory_order_relaxed) -
+                                              header_->head.load(std::memory_order_acquire));
+}
+
+std::size_t ShmRing::capacity() const
+{
+  return capacity_;
+}
+
+ShmRingHeader &ShmRing::header()
+{
+  return *header_;
+}
+
+/**
+ * Creates a new segment, failing if one with the same name already exists
+ *
+ * @param name The name of the segment, starting with a slash
+ * @param ring_capacity The capacity of each ring, rounded up to a power of two
+ * @return The mapped segment or nullptr on failure
+ */
+ShmSegment::SegmentPtr ShmSegment::Create(std::string const &name, std::size_t ring_capacity)
+{
+  std::size_t capacity = 64;
+  while (capacity < ring_capacity)
+  {
+    capacity <<= 1u;
+  }
+
+  int const fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0)
+  {
+    return {};
+  }
+
+  std::size_t const  size = SegmentSize(capacity);
+  core::MappedMemory mapping{};
+  if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+  {
+    mapping = core::MapFile(fd, size, core::MapMode::SHARED);
+  }
+
+  ::close(fd);
+
+  if (!mapping)
+  {
+    ::shm_unlink(name.c_str());
+    return {};
+  }
+
+  auto *header          = new (mapping.get()) SegmentHeader{};
+  header->ring_capacity = capacity;
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = MAGIC;
+
+  return SegmentPtr{new ShmSegment{std::move(mapping)}};
+}
+
+/**
+ * Maps an existing segment created by the remote side of a connection
+ *
+ * @param name The name of the segment
+ * @return The mapped segment or nullptr if it does not exist or is invalid
+ */
+ShmSegment::SegmentPtr ShmSegment::Open(std::string const &name)
+{
+  int const fd = ::shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0)
+  {
+    return {};
+  }
+
+  struct stat stats
+  {
+  };
+  core::MappedMemory mapping{};
+  auto               size = std::size_t{0};
+  if ((::fstat(fd, &stats) == 0) &&
+      (static_cast<std::size_t>(stats.st_size) > sizeof(SegmentHeader)))
+  {
+    size    = static_cast<std::size_t>(stats.st_size);
+    mapping = core::MapFile(fd, size, core::MapMode::SHARED);
+  }
+
+  ::close(fd);
+
+  if (!mapping)
+  {
+    return {};
+  }
+
+  auto const *header = reinterpret_cast<SegmentHeader const *>(mapping.get());
+  if ((header->magic != MAGIC) || (SegmentSize(header->ring_capacity) != size) ||
+      ((header->ring_capacity & (header->ring_capacity - 1)) != 0))
+  {
+    return {};
+  }
+
+  return SegmentPtr{new ShmSegment{std::move(mapping)}};
+}
+
+/**
+ * Removes the name of a segment, existing mappings of it are unaffected
+ */
+void ShmSegment::Unlink(std::string const &name)
+{
+  ::shm_unlink(name.c_str());
+}
+
+ShmSegment::ShmSegment(core::MappedMemory mapping)
+  : mapping_{std::move(mapping)}
+  , rings_{MakeRing(mapping_.get(), 0), MakeRing(mapping_.get(), 1)}
+{}
+
+/**
+ * @param creator Whether the caller created the segment
+ * @return The ring the caller writes to
+ */
+ShmRing &ShmSegment::outgoing(bool creator)
+{
+  return rings_[creator ? 0 : 1];
+}
+
+/**
+ * @param creator Whether the caller created the segment
+ * @return The ring the caller reads from
+ */
+ShmRing &ShmSegment::incoming(bool creator)
+{
+  return rings_[creator ? 1 : 0];
+}
+
+}  // namespace network
+}  // namespace fetch
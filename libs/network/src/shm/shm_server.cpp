@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/macros.hpp"
+#include "logging/logging.hpp"
+#include "network/management/abstract_connection_register.hpp"
+#include "network/shm/shm_connection.hpp"
+#include "network/shm/shm_server.hpp"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace network {
+namespace {
+
+constexpr int     ACCEPT_TIMEOUT_MS = 100;
+constexpr int     BACKLOG           = 64;
+constexpr uint8_t HANDSHAKE_ACK     = 0xA5;
+
+}  // namespace
+
+ShmServer::ShmServer(uint16_t port)
+  : port_{port}
+{}
+
+ShmServer::~ShmServer()
+{
+  Stop();
+}
+
+/**
+ * Starts listening for connections, replacing the socket left behind by any previous server for
+ * the same port
+ *
+ * @return true if the server is listening
+ */
+bool ShmServer::Start()
+{
+  if (running_)
+  {
+    return true;
+  }
+
+  std::string const path = ShmConnection::SocketPath(port_);
+
+  sockaddr_un address{};
+  if (path.size() >= sizeof(address.sun_path))
+  {
+    return false;
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  listener_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener_ < 0)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to create shared memory socket: ", std::strerror(errno));
+    return false;
+  }
+
+  ::unlink(path.c_str());
+  if ((::bind(listener_, reinterpret_cast<sockaddr const *>(&address), sizeof(address)) != 0) ||
+      (::chmod(path.c_str(), S_IRUSR | S_IWUSR) != 0) || (::listen(listener_, BACKLOG) != 0))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to listen on ", path, ": ", std::strerror(errno));
+    ::close(listener_);
+    listener_ = -1;
+    return false;
+  }
+
+  running_  = true;
+  acceptor_ = std::thread([this] { Accept(); });
+
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Listening for shared memory connections on ", path);
+
+  return true;
+}
+
+/**
+ * Stops accepting connections and closes the accepted ones, blocking until they have been released
+ * since they refer back to this class
+ */
+void ShmServer::Stop()
+{
+  if (!running_.exchange(false))
+  {
+    return;
+  }
+
+  acceptor_.join();
+  ::close(listener_);
+  listener_ = -1;
+  ::unlink(ShmConnection::SocketPath(port_).c_str());
+
+  WeakConnections connections;
+  {
+    FETCH_LOCK(connections_lock_);
+    std::swap(connections, connections_);
+  }
+
+  for (auto const &weak : connections)
+  {
+    auto connection = weak.lock();
+    if (connection)
+    {
+      connection->ClearClosures();
+      connection->Close();
+    }
+  }
+
+  for (auto const &weak : connections)
+  {
+    while (!weak.expired())
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+}
+
+uint16_t ShmServer::GetListeningPort() const
+{
+  return port_;
+}
+
+/**
+ * Drops the message, requests are handled by derived classes. This is also what remains of them
+ * while the server is being destroyed
+ */
+void ShmServer::PushRequest(ConnectionHandleType client, MessageBuffer const &msg)
+{
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Dropping request of ", msg.size(), " bytes from ", client);
+  FETCH_UNUSED(client);
+  FETCH_UNUSED(msg);
+}
+
+void ShmServer::Accept()
+{
+  while (running_)
+  {
+    pollfd fds{};
+    fds.fd     = listener_;
+    fds.events = POLLIN;
+
+    if (::poll(&fds, 1, ACCEPT_TIMEOUT_MS) <= 0)
+    {
+      continue;
+    }
+
+    int const socket = ::accept(listener_, nullptr, nullptr);
+    if (socket >= 0)
+    {
+      Handshake(socket);
+    }
+  }
+}
+
+/**
+ * Maps the segment named by a new client and starts the connection
+ *
+ * @param socket The accepted socket
+ */
+void ShmServer::Handshake(int socket)
+{
+  timeval timeout{};
+  timeout.tv_sec = 2;
+  ::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  uint8_t     length = 0;
+  std::string name;
+  if (::recv(socket, &length, 1, MSG_WAITALL) == 1)
+  {
+    name.resize(length);
+    if (::recv(socket, &name[0], length, MSG_WAITALL) != static_cast<ssize_t>(length))
+    {
+      name.clear();
+    }
+  }
+
+  ShmSegment::SegmentPtr segment;
+  if (!name.empty())
+  {
+    segment = ShmSegment::Open(name);
+  }
+
+  if (!segment || (::send(socket, &HANDSHAKE_ACK, 1, 0) != 1))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Rejected shared memory connection on port ", port_);
+    ::close(socket);
+    return;
+  }
+
+  auto connection = std::make_shared<ShmConnection>(socket, std::move(segment));
+  auto handle     = connection->handle();
+
+  connection->OnMessage([this, handle](MessageBuffer const &msg) { PushRequest(handle, msg); });
+
+  auto reg = connection_register_.lock();
+  if (reg)
+  {
+    reg->Enter(connection->connection_pointer());
+    connection->SetConnectionManager(reg);
+  }
+
+  {
+    FETCH_LOCK(connections_lock_);
+    connections_.erase(std::remove_if(connections_.begin(), connections_.end(),
+                                      [](auto const &weak) { return weak.expired(); }),
+                       connections_.end());
+    connections_.emplace_back(connection);
+  }
+
+  connection->Start();
+}
+
+}  // namespace network
+}  // namespace fetch
@@ -18,6 +18,12 @@
 
 #include "network/tcp/client_implementation.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace fetch {
 namespace network {
 
@@ -104,7 +110,7 @@ void TCPClientImplementation::Connect(byte_array::ConstByteArray const &host,
           {
             this->SetAddress(endpoint.address().to_string());
             this->SetPort(uint16_t(port.AsInt()));
-            ReadHeader();
+            Read();
           }
           else
           {
@@ -153,12 +159,14 @@ bool TCPClientImplementation::is_alive() const
 }
 
 void TCPClientImplementation::Send(MessageBuffer const &omsg, Callback const &success,
-                                   Callback const &fail)
+                                   Callback const &fail, MessagePriority priority)
 {
+  // the buffer is shared rather than copied, the caller must not modify it once it has been sent
   MessageType msg;
-  msg.buffer  = omsg.Copy();
-  msg.success = success;
-  msg.failure = fail;
+  msg.buffer   = omsg;
+  msg.success  = success;
+  msg.failure  = fail;
+  msg.priority = priority;
 
   if (!connected_)
   {
@@ -167,7 +175,7 @@ void TCPClientImplementation::Send(MessageBuffer const &omsg, Callback const &su
 
   {
     FETCH_LOCK(queue_mutex_);
-    write_queue_.push_back(msg);
+    write_queue_.Push(std::move(msg));
   }
 
   SelfType                  self   = shared_from_this();
@@ -217,7 +225,7 @@ bool TCPClientImplementation::Closed() const
   return socket_.expired();
 }
 
-void TCPClientImplementation::ReadHeader() noexcept
+void TCPClientImplementation::Read() noexcept
 {
   auto strand = strand_.lock();
   if (!strand)
@@ -226,35 +234,48 @@ void TCPClientImplementation::ReadHeader() noexcept
   }
   assert(strand->running_in_this_thread());
 
-  SelfType              self   = shared_from_this();
-  auto                  socket = socket_.lock();
-  byte_array::ByteArray header;
-  header.Resize(2 * sizeof(uint64_t));
+  SelfType self   = shared_from_this();
+  auto     socket = socket_.lock();
 
-  auto cb = [this, self, socket, header, strand](std::error_code ec, std::size_t) {
+  auto cb = [this, self, socket, strand](std::error_code ec, std::size_t len) {
     SharedSelfType selfLock = self.lock();
     if (!selfLock)
     {
       return;
     }
 
-    if (!ec)
+    if (ec)
     {
-      FETCH_LOG_DEBUG(LOGGING_NAME, "Read message header.");
-      ReadBody(header);
+      if (!posted_close_)
+      {
+        // We expect to get an ec here when the socked is closed via a post
+        FETCH_LOG_INFO(LOGGING_NAME, "Socket closed inside Read: ", ec.message());
+        SignalLeave();
+      }
+      return;
     }
-    else if (!posted_close_)
+
+    if (!framer_.Commit(len, received_))
     {
-      // We expect to get an ec here when the socked is closed via a post
-      FETCH_LOG_INFO(LOGGING_NAME, "Socket closed inside ReadHeader: ", ec.message());
+      FETCH_LOG_ERROR(LOGGING_NAME, "Magic incorrect during network read, closing");
       SignalLeave();
+      return;
     }
+
+    for (auto const &message : received_)
+    {
+      SignalMessage(message);
+    }
+    received_.clear();
+
+    Read();
   };
 
   if (socket)
   {
     assert(strand->running_in_this_thread());
-    asio::async_read(*socket, asio::buffer(header.pointer(), header.size()), strand->wrap(cb));
+    socket->async_read_some(asio::buffer(framer_.ReadPointer(), framer_.ReadSize()),
+                            strand->wrap(cb));
 
     bool const previously_connected = connected_.exchange(true);
 
@@ -265,83 +286,21 @@ void TCPClientImplementation::ReadHeader() noexcept
   }
   else
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "Socket no longer valid in ReadHeader");
+    FETCH_LOG_INFO(LOGGING_NAME, "Socket no longer valid in Read");
     connected_ = false;
     SignalLeave();
   }
 }
 
-void TCPClientImplementation::ReadBody(byte_array::ByteArray const &header) noexcept
+void TCPClientImplementation::SetHeader(byte_array::ByteArray &header, uint64_t bufSize)
 {
-  auto strand = strand_.lock();
-  assert(strand->running_in_this_thread());
-
-  assert(header.size() >= sizeof(NETWORK_MAGIC));
-  uint64_t magic = *reinterpret_cast<const uint64_t *>(header.pointer());
-  uint64_t size  = *reinterpret_cast<const uint64_t *>(header.pointer() + sizeof(uint64_t));
-
-  if (magic != NETWORK_MAGIC)
-  {
-    byte_array::ByteArray dummy;
-    SetHeader(dummy, 0);
-    dummy.Resize(16);
-
-    FETCH_LOG_ERROR(LOGGING_NAME, "Magic incorrect during network read:\ngot:      ", ToHex(header),
-                    "\nExpected: ", ToHex(byte_array::ByteArray(dummy)));
-    return;
-  }
-
-  byte_array::ByteArray message;
-  message.Resize(size);
-
-  SelfType self   = shared_from_this();
-  auto     socket = socket_.lock();
-  auto     cb     = [this, self, message, socket, strand](std::error_code ec, std::size_t len) {
-    FETCH_UNUSED(len);
-
-    SharedSelfType selfLock = self.lock();
-    if (!selfLock)
-    {
-      return;
-    }
-
-    if (!ec)
-    {
-      SignalMessage(message);
-      ReadHeader();
-    }
-    else
-    {
-      FETCH_LOG_ERROR(LOGGING_NAME, "Reading body failed, dying: ", ec, ec.message());
-      SignalLeave();
-    }
-  };
-
-  if (socket)
-  {
-    assert(strand->running_in_this_thread());
-    asio::async_read(*socket, asio::buffer(message.pointer(), message.size()), strand->wrap(cb));
-  }
-  else
-  {
-    FETCH_LOG_ERROR(LOGGING_NAME, "Invalid socket when attempting to read body");
-    SignalLeave();
-  }
+  header.Resize(HEADER_SIZE);
+  WriteHeader(header.pointer(), bufSize);
 }
 
-void TCPClientImplementation::SetHeader(byte_array::ByteArray &header, uint64_t bufSize)
+void TCPClientImplementation::WriteHeader(uint8_t *header, uint64_t bufSize)
 {
-  header.Resize(16);
-
-  for (std::size_t i = 0; i < 8; ++i)
-  {
-    header[i] = uint8_t((NETWORK_MAGIC >> i * 8) & 0xff);
-  }
-
-  for (std::size_t i = 0; i < 8; ++i)
-  {
-    header[i + 8] = uint8_t((bufSize >> i * 8) & 0xff);
-  }
+  MessageFramer::WriteHeader(header, bufSize);
 }
 
 // Always executed in a run(), in a strand
@@ -361,7 +320,8 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
     }
   }
 
-  MessageType message;
+  // take all the queued messages (up to a limit) so that they can be sent in a single write
+  auto messages = std::make_shared<MessageQueueType>();
   {
     FETCH_LOCK(queue_mutex_);
     if (write_queue_.empty())
@@ -370,20 +330,37 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
       can_write_ = true;
       return;
     }
-    message = write_queue_.front();
-    write_queue_.pop_front();
+
+    // the highest priority messages are written first
+    MessageType message;
+    while ((messages->size() < MAX_MESSAGES_PER_WRITE) && write_queue_.Pop(message))
+    {
+      messages->emplace_back(std::move(message));
+    }
   }
 
-  byte_array::ByteArray header;
-  SetHeader(header, message.buffer.size());
+  // build the headers for all the messages in one buffer and gather the header and payload
+  // buffers for a single vectored write. The payloads themselves are not copied
+  byte_array::ByteArray headers;
+  headers.Resize(messages->size() * HEADER_SIZE);
+
+  std::vector<asio::const_buffer> buffers{};
+  buffers.reserve(messages->size() * 2);
 
-  std::vector<asio::const_buffer> buffers{
-      asio::buffer(header.pointer(), header.size()),
-      asio::buffer(message.buffer.pointer(), message.buffer.size())};
+  uint8_t *header = headers.pointer();
+  for (auto const &message : *messages)
+  {
+    WriteHeader(header, message.buffer.size());
+
+    buffers.emplace_back(asio::buffer(header, HEADER_SIZE));
+    buffers.emplace_back(asio::buffer(message.buffer.pointer(), message.buffer.size()));
+
+    header += HEADER_SIZE;
+  }
 
   auto socket = socket_.lock();
 
-  auto cb = [this, selfLock, socket, message, header](std::error_code ec, std::size_t len) {
+  auto cb = [this, selfLock, socket, messages, headers](std::error_code ec, std::size_t len) {
     FETCH_UNUSED(len);
 
     {
@@ -396,9 +373,12 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
       FETCH_LOG_ERROR(LOGGING_NAME, "Error writing to socket, closing.");
       SignalLeave();
 
-      if (message.failure)
+      for (auto const &message : *messages)
       {
-        message.failure();
+        if (message.failure)
+        {
+          message.failure();
+        }
       }
     }
     else
@@ -408,9 +388,12 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
       auto strandLock = strand_.lock();
       if (strandLock)
       {
-        if (message.success)
+        for (auto const &message : *messages)
         {
-          message.success();
+          if (message.success)
+          {
+            message.success();
+          }
         }
         WriteNext(selfLock);
       }
@@ -433,9 +416,12 @@ void TCPClientImplementation::WriteNext(SharedSelfType const &selfLock)
 
     SignalLeave();
 
-    if (message.failure)
+    for (auto const &message : *messages)
     {
-      message.failure();
+      if (message.failure)
+      {
+        message.failure();
+      }
     }
   }
 }
@@ -0,0 +1,176 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/tcp/message_framer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace fetch {
+namespace network {
+namespace {
+
+uint64_t ReadUInt64(uint8_t const *data)
+{
+  uint64_t value = 0;
+  for (std::size_t i = 0; i < sizeof(uint64_t); ++i)
+  {
+    value |= static_cast<uint64_t>(data[i]) << (i * 8u);
+  }
+  return value;
+}
+
+void WriteUInt64(uint8_t *data, uint64_t value)
+{
+  for (std::size_t i = 0; i < sizeof(uint64_t); ++i)
+  {
+    data[i] = static_cast<uint8_t>((value >> (i * 8u)) & 0xffu);
+  }
+}
+
+}  // namespace
+
+constexpr uint64_t    MessageFramer::NETWORK_MAGIC;
+constexpr std::size_t MessageFramer::HEADER_SIZE;
+constexpr std::size_t MessageFramer::DEFAULT_READ_SIZE;
+
+/**
+ * @param read_size The size of the buffer for each read of the socket
+ */
+MessageFramer::MessageFramer(std::size_t read_size)
+  : read_size_{std::max(read_size, HEADER_SIZE)}
+  , buffer_(read_size_)
+{}
+
+/**
+ * @return Where the next read from the socket should be written to
+ */
+uint8_t *MessageFramer::ReadPointer()
+{
+  if (large_message_.size() != 0)
+  {
+    return large_message_.pointer() + large_received_;
+  }
+
+  return buffer_.data() + end_;
+}
+
+/**
+ * @return The maximum length of the next read from the socket
+ */
+std::size_t MessageFramer::ReadSize() const
+{
+  if (large_message_.size() != 0)
+  {
+    return large_message_.size() - large_received_;
+  }
+
+  return buffer_.size() - end_;
+}
+
+/**
+ * Accounts for data read from the socket and extracts the messages it completed
+ *
+ * @param length The number of bytes read to the read pointer
+ * @param messages The completed messages are appended to this
+ * @return false if the stream is corrupt and the connection should be closed
+ */
+bool MessageFramer::Commit(std::size_t length, Messages &messages)
+{
+  if (large_message_.size() != 0)
+  {
+    large_received_ += length;
+    if (large_received_ == large_message_.size())
+    {
+      messages.emplace_back(std::move(large_message_));
+      large_message_  = MessageBuffer{};
+      large_received_ = 0;
+    }
+
+    return true;
+  }
+
+  end_ += length;
+  return Extract(messages);
+}
+
+/**
+ * Writes the header of a message in the wire format
+ *
+ * @param header The output, of at least HEADER_SIZE bytes
+ * @param length The length of the message
+ */
+void MessageFramer::WriteHeader(uint8_t *header, uint64_t length)
+{
+  WriteUInt64(header, NETWORK_MAGIC);
+  WriteUInt64(header + sizeof(uint64_t), length);
+}
+
+bool MessageFramer::Extract(Messages &messages)
+{
+  while ((end_ - begin_) >= HEADER_SIZE)
+  {
+    uint8_t const *header = buffer_.data() + begin_;
+    if (ReadUInt64(header) != NETWORK_MAGIC)
+    {
+      return false;
+    }
+
+    uint64_t const    length    = ReadUInt64(header + sizeof(uint64_t));
+    std::size_t const available = end_ - begin_ - HEADER_SIZE;
+
+    if ((length > available) && ((HEADER_SIZE + length) <= read_size_))
+    {
+      // the message will fit in the buffer once the rest of it arrives
+      break;
+    }
+
+    MessageBuffer message;
+    message.Resize(static_cast<std::size_t>(length));
+
+    if (length <= available)
+    {
+      std::memcpy(message.pointer(), header + HEADER_SIZE, static_cast<std::size_t>(length));
+      messages.emplace_back(std::move(message));
+      begin_ += HEADER_SIZE + static_cast<std::size_t>(length);
+      continue;
+    }
+
+    // the rest of the message is read directly into its own storage
+    std::memcpy(message.pointer(), header + HEADER_SIZE, available);
+    large_message_  = std::move(message);
+    large_received_ = available;
+    begin_          = end_;
+    break;
+  }
+
+  // move any partial message to the front so that the next read has the whole buffer
+  std::size_t const remaining = end_ - begin_;
+  if ((remaining > 0) && (begin_ > 0))
+  {
+    std::memmove(buffer_.data(), buffer_.data() + begin_, remaining);
+  }
+  begin_ = 0;
+  end_   = remaining;
+
+  return true;
+}
+
+}  // namespace network
+}  // namespace fetch
@@ -147,6 +147,17 @@ void TCPServer::PushRequest(ConnectionHandleType client, MessageBuffer const &ms
   requests_.push_back({client, msg});
 }
 
+void TCPServer::PushRequests(ConnectionHandleType client, MessageBuffers const &msgs)
+{
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Got ", msgs.size(), " requests from ", client);
+
+  FETCH_LOCK(request_mutex_);
+  for (auto const &msg : msgs)
+  {
+    requests_.push_back({client, msg});
+  }
+}
+
 void TCPServer::Broadcast(MessageBuffer const &msg)
 {
   manager_->Broadcast(msg);
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/tcp/message_framer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::network::MessageBuffer;
+using fetch::network::MessageFramer;
+
+using Stream = std::vector<uint8_t>;
+
+void AppendMessage(Stream &stream, std::string const &text)
+{
+  uint8_t header[MessageFramer::HEADER_SIZE];
+  MessageFramer::WriteHeader(header, text.size());
+
+  stream.insert(stream.end(), header, header + sizeof(header));
+  stream.insert(stream.end(), text.begin(), text.end());
+}
+
+/**
+ * Feeds the stream to the framer as a socket would, in reads of at most the given size
+ */
+std::vector<std::string> Feed(MessageFramer &framer, Stream const &stream, std::size_t max_read,
+                              std::size_t *reads = nullptr)
+{
+  std::vector<std::string> output;
+  MessageFramer::Messages  messages;
+
+  std::size_t offset = 0;
+  while (offset < stream.size())
+  {
+    std::size_t const length = std::min({max_read, framer.ReadSize(), stream.size() - offset});
+    std::memcpy(framer.ReadPointer(), stream.data() + offset, length);
+    offset += length;
+
+    EXPECT_TRUE(framer.Commit(length, messages));
+    if (reads != nullptr)
+    {
+      ++*reads;
+    }
+  }
+
+  for (auto const &message : messages)
+  {
+    output.emplace_back(static_cast<std::string>(message));
+  }
+  return output;
+}
+
+TEST(MessageFramerTests, ManyMessagesAreExtractedFromOneRead)
+{
+  Stream                   stream;
+  std::vector<std::string> expected;
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    expected.emplace_back("message " + std::to_string(i));
+    AppendMessage(stream, expected.back());
+  }
+
+  MessageFramer framer;
+  std::size_t   reads = 0;
+  EXPECT_EQ(Feed(framer, stream, stream.size(), &reads), expected);
+  EXPECT_EQ(reads, 1);
+}
+
+TEST(MessageFramerTests, MessagesSplitAcrossReads)
+{
+  Stream                   stream;
+  std::vector<std::string> expected{"", "a", "split across several small reads", ""};
+  for (auto const &text : expected)
+  {
+    AppendMessage(stream, text);
+  }
+
+  for (std::size_t max_read : {1u, 3u, 7u, 16u, 17u})
+  {
+    MessageFramer framer{64};
+    EXPECT_EQ(Feed(framer, stream, max_read), expected);
+  }
+}
+
+TEST(MessageFramerTests, LargeMessagesAreReadDirectly)
+{
+  std::string const large(1000, 'x');
+
+  Stream stream;
+  AppendMessage(stream, "before");
+  AppendMessage(stream, large);
+  AppendMessage(stream, "after");
+
+  MessageFramer framer{64};
+  std::size_t   reads = 0;
+  EXPECT_EQ(Feed(framer, stream, 1u << 20u, &reads),
+            (std::vector<std::string>{"before", large, "after"}));
+
+  // once the header is seen the remainder of the large message is a single read
+  EXPECT_LE(reads, 4);
+}
+
+TEST(MessageFramerTests, InvalidMagicIsRejected)
+{
+  Stream stream;
+  AppendMessage(stream, "valid");
+  stream[0] ^= 0xffu;
+
+  MessageFramer           framer;
+  MessageFramer::Messages messages;
+  std::memcpy(framer.ReadPointer(), stream.data(), stream.size());
+  EXPECT_FALSE(framer.Commit(stream.size(), messages));
+  EXPECT_TRUE(messages.empty());
+}
+
+}  // namespace
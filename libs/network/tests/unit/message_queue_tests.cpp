@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/message.hpp"
+#include "network/message_queue.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::network::MessagePriority;
+using fetch::network::MessageQueue;
+using fetch::network::MessageType;
+
+MessageType CreateMessage(std::string const &text, MessagePriority priority)
+{
+  MessageType message{};
+  message.buffer   = text;
+  message.priority = priority;
+
+  return message;
+}
+
+std::vector<std::string> Drain(MessageQueue &queue)
+{
+  std::vector<std::string> output{};
+
+  MessageType message{};
+  while (queue.Pop(message))
+  {
+    output.emplace_back(static_cast<std::string>(message.buffer));
+  }
+
+  return output;
+}
+
+TEST(MessageQueueTests, CheckHigherPrioritiesAreWrittenFirst)
+{
+  MessageQueue queue{};
+  queue.Push(CreateMessage("bulk", MessagePriority::BULK));
+  queue.Push(CreateMessage("normal-1", MessagePriority::NORMAL));
+  queue.Push(CreateMessage("high-1", MessagePriority::HIGH));
+  queue.Push(CreateMessage("normal-2", MessagePriority::NORMAL));
+  queue.Push(CreateMessage("high-2", MessagePriority::HIGH));
+
+  EXPECT_EQ(queue.size(), 5);
+  EXPECT_EQ(queue.size(MessagePriority::HIGH), 2);
+  EXPECT_EQ(queue.size(MessagePriority::BULK), 1);
+
+  std::vector<std::string> const expected{"high-1", "high-2", "normal-1", "normal-2", "bulk"};
+  EXPECT_EQ(Drain(queue), expected);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(MessageQueueTests, CheckLowerPrioritiesAreNotStarved)
+{
+  MessageQueue queue{};
+  queue.Push(CreateMessage("bulk", MessagePriority::BULK));
+  for (std::size_t i = 0; i < (MessageQueue::MAX_CONSECUTIVE * 2); ++i)
+  {
+    queue.Push(CreateMessage("high", MessagePriority::HIGH));
+  }
+
+  auto const output = Drain(queue);
+  ASSERT_EQ(output.size(), (MessageQueue::MAX_CONSECUTIVE * 2) + 1);
+
+  // the bulk message is written once the high priority messages have had their share
+  EXPECT_EQ(output[MessageQueue::MAX_CONSECUTIVE], "bulk");
+}
+
+TEST(MessageQueueTests, CheckClear)
+{
+  MessageQueue queue{};
+  queue.Push(CreateMessage("normal", MessagePriority::NORMAL));
+  queue.Push(CreateMessage("bulk", MessagePriority::BULK));
+  queue.Clear();
+
+  MessageType message{};
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.Pop(message));
+}
+
+}  // namespace
@@ -20,8 +20,13 @@
 
 #include "gtest/gtest.h"
 
+#include <array>
 #include <cstdlib>
 #include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace fetch::p2p;
 using fetch::byte_array::ConstByteArray;
@@ -44,6 +49,7 @@ public:
   Gaussian GetGaussianOfPeer(IDENTITY const &peer_ident)
   {
     FETCH_LOCK(this->mutex_);
+    this->Flush();
     auto ranking_it = this->ranking_store_.find(peer_ident);
     if (ranking_it != this->ranking_store_.end())
     {
@@ -146,3 +152,67 @@ TEST(TrustTests, BayDuplicate)
                     fetch::p2p::TrustQuality::DUPLICATE);
   EXPECT_EQ(trust.IsPeerTrusted("peer1"), true);
 }
+
+TEST(TrustTests, BayRankingStaysSorted)
+{
+  P2PTrustBayRank<std::string> trust;
+
+  std::array<TrustQuality, 4> const qualities{TrustQuality::LIED, TrustQuality::BAD_CONNECTION,
+                                              TrustQuality::DUPLICATE,
+                                              TrustQuality::NEW_INFORMATION};
+
+  // more feedback than fits in the queue, so that some of it is applied as it is reported
+  std::mt19937 rng{42};
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    auto const peer = "peer" + std::to_string(rng() % 50);
+    trust.AddFeedback(peer, ConstByteArray{}, TrustSubject::BLOCK, qualities[rng() % 4]);
+  }
+
+  auto const peers = trust.GetPeersAndTrusts();
+  ASSERT_EQ(peers.size(), 50);
+
+  for (std::size_t pos = 0; pos < peers.size(); ++pos)
+  {
+    if (pos > 0)
+    {
+      EXPECT_LE(peers[pos - 1].trust, peers[pos].trust);
+    }
+    EXPECT_EQ(trust.GetRankOfPeer(peers[pos].address), pos);
+    EXPECT_EQ(trust.GetTrustRatingOfPeer(peers[pos].address), peers[pos].trust);
+  }
+
+  EXPECT_EQ(trust.GetRankOfPeer("unknown"), 51);
+}
+
+TEST(TrustTests, BayConcurrentFeedback)
+{
+  P2PTrustBayRank<std::string> trust;
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&trust, t]() {
+      for (std::size_t i = 0; i < 1000; ++i)
+      {
+        trust.AddFeedback("peer" + std::to_string((t * 1000 + i) % 20), ConstByteArray{},
+                          TrustSubject::BLOCK, TrustQuality::NEW_INFORMATION);
+        if (i % 100 == 0)
+        {
+          trust.GetBestPeers(10);
+        }
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(trust.GetPeersAndTrusts().size(), 20);
+  for (std::size_t i = 0; i < 20; ++i)
+  {
+    EXPECT_TRUE(trust.IsPeerTrusted("peer" + std::to_string(i)));
+  }
+}
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/service/promise_table.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::service::MakePromise;
+using fetch::service::Promise;
+using fetch::service::PromiseTable;
+
+TEST(PromiseTableTests, ExtractReturnsAddedPromise)
+{
+  PromiseTable table{};
+
+  Promise promise = MakePromise();
+  table.Add(promise);
+
+  EXPECT_EQ(table.Extract(promise->id()), promise);
+
+  // each promise can only be extracted once
+  EXPECT_FALSE(table.Extract(promise->id()));
+}
+
+TEST(PromiseTableTests, UnknownIdReturnsEmptyPromise)
+{
+  PromiseTable table{};
+
+  Promise promise = MakePromise();
+  table.Add(promise);
+
+  EXPECT_FALSE(table.Extract(promise->id() + 1));
+  EXPECT_EQ(table.Extract(promise->id()), promise);
+}
+
+TEST(PromiseTableTests, RemovedPromiseIsNotReturned)
+{
+  PromiseTable table{};
+
+  Promise promise = MakePromise();
+  table.Add(promise);
+  table.Remove(promise->id());
+
+  EXPECT_FALSE(table.Extract(promise->id()));
+}
+
+TEST(PromiseTableTests, CollidingPromisesOverflow)
+{
+  PromiseTable table{};
+
+  // create enough promises that the slots are guaranteed to wrap around
+  std::vector<Promise> promises{};
+  for (std::size_t i = 0; i <= PromiseTable::NUM_SLOTS; ++i)
+  {
+    promises.emplace_back(MakePromise());
+    table.Add(promises.back());
+  }
+
+  EXPECT_EQ(table.overflow_size(), 1u);
+
+  for (auto const &promise : promises)
+  {
+    EXPECT_EQ(table.Extract(promise->id()), promise);
+  }
+
+  EXPECT_EQ(table.overflow_size(), 0u);
+}
+
+TEST(PromiseTableTests, ConcurrentAddAndExtract)
+{
+  static constexpr std::size_t NUM_THREADS  = 4;
+  static constexpr std::size_t NUM_PROMISES = 10000;
+
+  PromiseTable             table{};
+  std::atomic<std::size_t> extracted{0};
+
+  std::vector<std::thread> threads{};
+  for (std::size_t t = 0; t < NUM_THREADS; ++t)
+  {
+    threads.emplace_back([&table, &extracted]() {
+      for (std::size_t i = 0; i < NUM_PROMISES; ++i)
+      {
+        Promise promise = MakePromise();
+        table.Add(promise);
+
+        if (table.Extract(promise->id()) == promise)
+        {
+          ++extracted;
+        }
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(extracted, NUM_THREADS * NUM_PROMISES);
+  EXPECT_EQ(table.overflow_size(), 0u);
+}
+
+}  // namespace
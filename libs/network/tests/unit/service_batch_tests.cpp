@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/service/client_interface.hpp"
+#include "network/service/protocol.hpp"
+#include "network/service/server_interface.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::network::MessageBuffer;
+using fetch::service::MakePromise;
+using fetch::service::PackCall;
+using fetch::service::Promise;
+using fetch::service::PromiseState;
+using fetch::service::SERVICE_BATCH;
+using fetch::service::SERVICE_FUNCTION_CALL;
+using fetch::service::SerializerType;
+using fetch::service::ServiceClientInterface;
+using fetch::service::ServiceServerInterface;
+
+constexpr uint64_t PROTOCOL = 1;
+constexpr uint64_t SQUARE   = 1;
+
+class Calculator
+{
+public:
+  uint64_t Square(uint64_t value)
+  {
+    ++num_calls;
+    return value * value;
+  }
+
+  uint64_t num_calls{0};
+};
+
+class CalculatorProtocol : public fetch::service::Protocol
+{
+public:
+  explicit CalculatorProtocol(Calculator &calculator)
+  {
+    Expose(SQUARE, &calculator, &Calculator::Square);
+  }
+};
+
+/// A client and server connected back to back
+class LoopbackService : public ServiceServerInterface, public ServiceClientInterface
+{
+public:
+  LoopbackService()
+  {
+    Add(PROTOCOL, &protocol_);
+  }
+
+  Promise Call(uint64_t value, SerializerType &request)
+  {
+    Promise promise = MakePromise(PROTOCOL, SQUARE);
+    AddPromise(promise);
+
+    request << SERVICE_FUNCTION_CALL << promise->id();
+    PackCall(request, PROTOCOL, SQUARE, value);
+
+    return promise;
+  }
+
+  void Send(MessageBuffer const &request)
+  {
+    PushProtocolRequest(ConstByteArray{"client"}, request);
+  }
+
+  Calculator  calculator{};
+  std::size_t num_responses{0};
+
+protected:
+  bool DeliverResponse(ConstByteArray const & /*address*/, MessageBuffer const &data) override
+  {
+    ++num_responses;
+    return ProcessServerMessage(data);
+  }
+
+private:
+  CalculatorProtocol protocol_{calculator};
+};
+
+TEST(ServiceBatchTests, CheckBatchIsAnsweredInSingleResponse)
+{
+  LoopbackService service{};
+
+  std::vector<Promise>       promises{};
+  std::vector<MessageBuffer> requests{};
+  for (uint64_t i = 0; i < 10; ++i)
+  {
+    SerializerType request{};
+    promises.push_back(service.Call(i, request));
+    requests.push_back(request.data());
+  }
+
+  SerializerType batch{};
+  batch << SERVICE_BATCH << requests;
+  service.Send(batch.data());
+
+  EXPECT_EQ(service.num_responses, 1);
+  EXPECT_EQ(service.calculator.num_calls, requests.size());
+
+  for (uint64_t i = 0; i < promises.size(); ++i)
+  {
+    ASSERT_EQ(promises[i]->state(), PromiseState::SUCCESS);
+
+    uint64_t result{0};
+    ASSERT_TRUE(promises[i]->GetResult(result));
+    EXPECT_EQ(result, i * i);
+  }
+}
+
+TEST(ServiceBatchTests, CheckNestedBatchesAreIgnored)
+{
+  LoopbackService service{};
+
+  SerializerType request{};
+  auto           promise = service.Call(3, request);
+
+  SerializerType inner{};
+  inner << SERVICE_BATCH << std::vector<MessageBuffer>{request.data()};
+
+  SerializerType outer{};
+  outer << SERVICE_BATCH << std::vector<MessageBuffer>{inner.data()};
+  service.Send(outer.data());
+
+  EXPECT_EQ(service.num_responses, 1);
+  EXPECT_EQ(service.calculator.num_calls, 0);
+  EXPECT_EQ(promise->state(), PromiseState::WAITING);
+}
+
+}  // namespace
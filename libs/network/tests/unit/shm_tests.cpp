@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/shm/shm_connection.hpp"
+#include "network/shm/shm_ring.hpp"
+#include "network/shm/shm_server.hpp"
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::network::MessageBuffer;
+using fetch::network::ShmConnection;
+using fetch::network::ShmSegment;
+using fetch::network::ShmServer;
+
+using namespace std::chrono_literals;
+
+uint16_t const TEST_PORT = static_cast<uint16_t>(40000 + (::getpid() % 20000));
+
+class CollectingServer final : public ShmServer
+{
+public:
+  using ShmServer::ShmServer;
+
+  ~CollectingServer() override
+  {
+    Stop();
+  }
+
+  bool WaitFor(std::size_t count)
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    return condition_.wait_for(lock, 10s, [this, count] { return messages_.size() >= count; });
+  }
+
+  std::vector<MessageBuffer> messages()
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    return messages_;
+  }
+
+private:
+  void PushRequest(ConnectionHandleType /*client*/, MessageBuffer const &msg) override
+  {
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      messages_.emplace_back(msg.Copy());
+    }
+    condition_.notify_all();
+  }
+
+  std::mutex                 lock_;
+  std::condition_variable    condition_;
+  std::vector<MessageBuffer> messages_;
+};
+
+MessageBuffer CreateMessage(std::size_t size, uint8_t seed)
+{
+  MessageBuffer buffer;
+  buffer.Resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    buffer[i] = static_cast<uint8_t>(seed + i * 31);
+  }
+  return buffer;
+}
+
+TEST(ShmTests, RingWrapsAround)
+{
+  std::string const name    = "/fetch-shm-test-" + std::to_string(::getpid());
+  auto              segment = ShmSegment::Create(name, 64);
+  ASSERT_TRUE(segment);
+  ShmSegment::Unlink(name);
+
+  auto &writer = segment->outgoing(true);
+  auto &reader = segment->incoming(false);
+  EXPECT_EQ(writer.capacity(), 64);
+  EXPECT_EQ(&writer.header(), &reader.header());
+
+  std::vector<uint8_t> input(100);
+  for (std::size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = static_cast<uint8_t>(i);
+  }
+
+  std::vector<uint8_t> output(100);
+  EXPECT_EQ(writer.Write(input.data(), 40), 40);
+  EXPECT_EQ(reader.Read(output.data(), 30), 30);
+
+  // the ring is only partially free and the write wraps around the end
+  EXPECT_EQ(writer.writable(), 54);
+  EXPECT_EQ(writer.Write(input.data() + 40, 60), 54);
+  EXPECT_EQ(writer.writable(), 0);
+  EXPECT_EQ(reader.readable(), 64);
+
+  EXPECT_EQ(reader.Read(output.data() + 30, 70), 64);
+  EXPECT_EQ(writer.Write(input.data() + 94, 6), 6);
+  EXPECT_EQ(reader.Read(output.data() + 94, 6), 6);
+
+  EXPECT_EQ(output, input);
+}
+
+TEST(ShmTests, ConnectFailsWithoutServer)
+{
+  auto connection = std::make_shared<ShmConnection>();
+
+  EXPECT_FALSE(ShmConnection::IsAvailable(TEST_PORT));
+  EXPECT_FALSE(connection->Connect(TEST_PORT));
+  EXPECT_FALSE(connection->is_alive());
+}
+
+TEST(ShmTests, MessagesAreDeliveredInOrder)
+{
+  CollectingServer server{TEST_PORT};
+  ASSERT_TRUE(server.Start());
+  EXPECT_TRUE(ShmConnection::IsAvailable(TEST_PORT));
+
+  std::atomic<bool> connected{false};
+  std::atomic<bool> left{false};
+
+  auto connection = std::make_shared<ShmConnection>();
+  connection->OnConnectionSuccess([&connected] { connected = true; });
+  connection->OnLeave([&left] { left = true; });
+  ASSERT_TRUE(connection->Connect(TEST_PORT));
+  connection->Start();
+  EXPECT_TRUE(connected);
+
+  // includes messages larger than the ring, which the reader drains while they are written
+  std::vector<MessageBuffer> sent;
+  for (std::size_t size : {0u, 1u, 100u, 5000u, 10u << 20u, 7u})
+  {
+    sent.emplace_back(CreateMessage(size, static_cast<uint8_t>(sent.size())));
+  }
+
+  std::size_t succeeded = 0;
+  for (auto const &message : sent)
+  {
+    connection->Send(message, [&succeeded] { ++succeeded; });
+  }
+  EXPECT_EQ(succeeded, sent.size());
+
+  ASSERT_TRUE(server.WaitFor(sent.size()));
+  EXPECT_EQ(server.messages(), sent);
+
+  // stopping the server closes the connection from the other side
+  server.Stop();
+  for (std::size_t i = 0; (i < 100) && !left; ++i)
+  {
+    std::this_thread::sleep_for(50ms);
+  }
+  EXPECT_TRUE(left);
+  EXPECT_TRUE(connection->Closed());
+  EXPECT_FALSE(ShmConnection::IsAvailable(TEST_PORT));
+}
+
+TEST(ShmTests, ReaderWakesAfterSleeping)
+{
+  CollectingServer server{TEST_PORT};
+  ASSERT_TRUE(server.Start());
+
+  auto connection = std::make_shared<ShmConnection>();
+  ASSERT_TRUE(connection->Connect(TEST_PORT));
+  connection->Start();
+
+  for (uint8_t i = 0; i < 5; ++i)
+  {
+    // long enough for the reader to go to sleep on the doorbell
+    std::this_thread::sleep_for(20ms);
+
+    auto const start = std::chrono::steady_clock::now();
+    connection->Send(CreateMessage(64, i));
+    ASSERT_TRUE(server.WaitFor(i + 1u));
+
+    // well within the timeout of a reader which missed the doorbell
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 50ms);
+  }
+
+  connection->Close();
+}
+
+}  // namespace
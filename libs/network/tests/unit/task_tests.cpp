@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/details/task.hpp"
+#include "network/details/work_store.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using fetch::network::details::Task;
+using fetch::network::details::WorkStore;
+
+TEST(TaskTests, DefaultIsEmpty)
+{
+  Task task{};
+  EXPECT_FALSE(static_cast<bool>(task));
+}
+
+TEST(TaskTests, InlineCallableIsInvoked)
+{
+  int  count = 0;
+  Task task{[&count]() { ++count; }};
+
+  ASSERT_TRUE(static_cast<bool>(task));
+  task();
+  task();
+
+  EXPECT_EQ(count, 2);
+}
+
+TEST(TaskTests, LargeCallableIsInvoked)
+{
+  std::array<std::size_t, 32> values{};
+  values.back() = 7;
+
+  std::size_t result = 0;
+  Task        task{[values, &result]() { result = values.back(); }};
+
+  static_assert(sizeof(values) > Task::INLINE_SIZE, "Test requires a heap allocated callable");
+
+  task();
+  EXPECT_EQ(result, 7u);
+}
+
+TEST(TaskTests, MoveTransfersOwnership)
+{
+  auto               state = std::make_shared<int>(0);
+  std::weak_ptr<int> observer{state};
+
+  Task first{[state]() { ++(*state); }};
+  state.reset();
+
+  Task second{std::move(first)};
+  EXPECT_FALSE(static_cast<bool>(first));  // NOLINT - testing moved from state
+  ASSERT_TRUE(static_cast<bool>(second));
+
+  second();
+  EXPECT_EQ(*observer.lock(), 1);
+
+  Task third{};
+  third = std::move(second);
+  third();
+  EXPECT_EQ(*observer.lock(), 2);
+
+  // destroying the final owner must release the captured state
+  third.Reset();
+  EXPECT_TRUE(observer.expired());
+}
+
+TEST(TaskTests, MoveOnlyCapturesAreSupported)
+{
+  auto value  = std::make_unique<int>(42);
+  int  result = 0;
+
+  Task task{[v = std::move(value), &result]() { result = *v; }};
+  task();
+
+  EXPECT_EQ(result, 42);
+}
+
+TEST(WorkStoreTests, OwnerTakesFrontAndThievesTakeBack)
+{
+  WorkStore        store{};
+  std::vector<int> order{};
+
+  for (int i = 0; i < 3; ++i)
+  {
+    store.Post([&order, i]() { order.push_back(i); });
+  }
+
+  auto const execute = [](Task &task) { task(); };
+
+  EXPECT_EQ(store.Dispatch(execute), 1u);
+  EXPECT_EQ(store.Steal(execute), 1u);
+  EXPECT_EQ(store.Dispatch(execute), 1u);
+  EXPECT_EQ(store.Dispatch(execute), 0u);
+  EXPECT_EQ(store.Steal(execute), 0u);
+
+  EXPECT_EQ(order, (std::vector<int>{0, 2, 1}));
+}
+
+TEST(WorkStoreTests, ClearReportsRemovedItems)
+{
+  WorkStore store{};
+
+  store.Post([]() {});
+  store.Post([]() {});
+
+  EXPECT_EQ(store.Clear(), 2u);
+  EXPECT_TRUE(store.IsEmpty());
+}
+
+}  // namespace
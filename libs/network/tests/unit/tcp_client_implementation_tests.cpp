@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/tcp/client_implementation.hpp"
+#include "network/tcp/loopback_server.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::network::LoopbackServer;
+using fetch::network::MessageBuffer;
+using fetch::network::NetworkManager;
+using fetch::network::TCPClientImplementation;
+
+using namespace std::chrono_literals;
+
+constexpr char const *HOST = "127.0.0.1";
+
+MessageBuffer CreateMessage(std::size_t size, std::size_t seed)
+{
+  MessageBuffer message;
+  message.Resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    message[i] = static_cast<uint8_t>((i * 31u) + seed);
+  }
+  return message;
+}
+
+template <typename Predicate>
+bool WaitFor(Predicate &&predicate)
+{
+  auto const deadline = std::chrono::steady_clock::now() + 30s;
+  while (!predicate())
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(5ms);
+  }
+  return true;
+}
+
+class TCPClientImplementationTests : public ::testing::Test
+{
+protected:
+  using ClientPtr = std::shared_ptr<TCPClientImplementation>;
+
+  void SetUp() override
+  {
+    manager_.Start();
+  }
+
+  void TearDown() override
+  {
+    if (client_)
+    {
+      client_->ClearClosures();
+      client_->Close();
+      client_.reset();
+    }
+    manager_.Stop();
+  }
+
+  /**
+   * Connect a client to a loopback server, collecting every message echoed back to it
+   *
+   * @param port The port of the loopback server
+   * @return true if the connection was established, otherwise false
+   */
+  bool Connect(uint16_t port)
+  {
+    client_ = std::make_shared<TCPClientImplementation>(manager_);
+    client_->OnMessage([this](MessageBuffer const &message) {
+      FETCH_LOCK(lock_);
+      received_.push_back(message);
+    });
+    client_->Connect(HOST, port);
+
+    return WaitFor([this] { return client_->is_alive(); });
+  }
+
+  std::size_t ReceivedCount() const
+  {
+    FETCH_LOCK(lock_);
+    return received_.size();
+  }
+
+  NetworkManager             manager_{"Client", 2};
+  ClientPtr                  client_;
+  mutable std::mutex         lock_;
+  std::vector<MessageBuffer> received_;
+};
+
+TEST_F(TCPClientImplementationTests, QueuedMessagesAreEchoedIntactAndInOrder)
+{
+  LoopbackServer server{9340};
+  ASSERT_TRUE(Connect(9340));
+
+  // enough messages that the queue is drained over several vectored writes
+  constexpr std::size_t NUM_MESSAGES = 500;
+
+  std::vector<MessageBuffer> sent;
+  std::atomic<std::size_t>   completed{0};
+  for (std::size_t i = 0; i < NUM_MESSAGES; ++i)
+  {
+    sent.push_back(CreateMessage(1 + (i * 7u) % 300u, i));
+    client_->Send(sent.back(), [&completed] { ++completed; });
+  }
+
+  ASSERT_TRUE(WaitFor([&] { return ReceivedCount() == NUM_MESSAGES; }));
+  EXPECT_EQ(completed, NUM_MESSAGES);
+
+  FETCH_LOCK(lock_);
+  for (std::size_t i = 0; i < NUM_MESSAGES; ++i)
+  {
+    EXPECT_EQ(received_[i], sent[i]) << "message " << i;
+  }
+}
+
+TEST_F(TCPClientImplementationTests, LargeMessagesSurvivePartialWrites)
+{
+  LoopbackServer server{9341};
+  ASSERT_TRUE(Connect(9341));
+
+  // each payload is much larger than the socket send buffer, so every vectored write is
+  // completed by a series of partial writes that end part way through a buffer
+  constexpr std::size_t NUM_MESSAGES = 4;
+
+  std::vector<MessageBuffer> sent;
+  std::atomic<std::size_t>   completed{0};
+  for (std::size_t i = 0; i < NUM_MESSAGES; ++i)
+  {
+    sent.push_back(CreateMessage((4u << 20u) + (i * 4099u), i));
+    client_->Send(sent.back(), [&completed] { ++completed; });
+    client_->Send(CreateMessage(3, i), [&completed] { ++completed; });
+  }
+
+  ASSERT_TRUE(WaitFor([&] { return ReceivedCount() == NUM_MESSAGES * 2; }));
+  EXPECT_EQ(completed, NUM_MESSAGES * 2);
+
+  FETCH_LOCK(lock_);
+  for (std::size_t i = 0; i < NUM_MESSAGES; ++i)
+  {
+    EXPECT_EQ(received_[i * 2], sent[i]) << "message " << i;
+    EXPECT_EQ(received_[(i * 2) + 1], CreateMessage(3, i)) << "message " << i;
+  }
+}
+
+TEST_F(TCPClientImplementationTests, SameBufferCanBeQueuedRepeatedly)
+{
+  LoopbackServer server{9342};
+  ASSERT_TRUE(Connect(9342));
+
+  MessageBuffer const message = CreateMessage(1024, 0);
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    client_->Send(message);
+  }
+
+  ASSERT_TRUE(WaitFor([&] { return ReceivedCount() == 10; }));
+
+  FETCH_LOCK(lock_);
+  for (auto const &echoed : received_)
+  {
+    EXPECT_EQ(echoed, message);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/details/future_work_store.hpp"
+#include "network/details/timer_wheel.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fetch::network::details::FutureWorkStore;
+using fetch::network::details::TimerWheel;
+
+using Wheel = TimerWheel<uint64_t>;
+
+std::vector<uint64_t> AdvanceTo(Wheel &wheel, Wheel::Tick now)
+{
+  std::vector<uint64_t> expired{};
+  wheel.Advance(now, [&expired](uint64_t &&value) { expired.push_back(value); });
+  return expired;
+}
+
+TEST(TimerWheelTests, TimersExpireWhenDue)
+{
+  Wheel wheel{};
+
+  wheel.Add(1, 5);
+  wheel.Add(2, 100);
+  wheel.Add(3, 5000);
+  EXPECT_EQ(wheel.size(), 3u);
+
+  EXPECT_TRUE(AdvanceTo(wheel, 4).empty());
+  EXPECT_EQ(AdvanceTo(wheel, 5), (std::vector<uint64_t>{1}));
+  EXPECT_TRUE(AdvanceTo(wheel, 99).empty());
+  EXPECT_EQ(AdvanceTo(wheel, 100), (std::vector<uint64_t>{2}));
+  EXPECT_TRUE(AdvanceTo(wheel, 4999).empty());
+  EXPECT_EQ(AdvanceTo(wheel, 5000), (std::vector<uint64_t>{3}));
+
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTests, PastTimersExpireOnNextAdvance)
+{
+  Wheel wheel{};
+  AdvanceTo(wheel, 1000);
+
+  wheel.Add(7, 10);
+  EXPECT_EQ(wheel.NextExpiry(), 1001u);
+  EXPECT_EQ(AdvanceTo(wheel, 1001), (std::vector<uint64_t>{7}));
+}
+
+TEST(TimerWheelTests, CancelledTimersDoNotExpire)
+{
+  Wheel wheel{};
+
+  auto const first  = wheel.Add(1, 10);
+  auto const second = wheel.Add(2, 10);
+
+  EXPECT_TRUE(wheel.Cancel(first));
+  EXPECT_FALSE(wheel.Cancel(first));
+  EXPECT_FALSE(wheel.Cancel(Wheel::INVALID_HANDLE));
+
+  EXPECT_EQ(AdvanceTo(wheel, 10), (std::vector<uint64_t>{2}));
+
+  // the handle of an expired timer is no longer valid even when its node has been reused
+  wheel.Add(3, 20);
+  EXPECT_FALSE(wheel.Cancel(second));
+  EXPECT_EQ(wheel.size(), 1u);
+}
+
+TEST(TimerWheelTests, NextExpiryTracksEarliestTimer)
+{
+  Wheel wheel{};
+  EXPECT_EQ(wheel.NextExpiry(), Wheel::NEVER);
+
+  wheel.Add(1, 30);
+  EXPECT_EQ(wheel.NextExpiry(), 30u);
+
+  // timers on higher levels report the time at which they need to be cascaded
+  wheel.Add(2, 200);
+  AdvanceTo(wheel, 30);
+  EXPECT_EQ(wheel.NextExpiry(), 192u);
+  AdvanceTo(wheel, 192);
+  EXPECT_EQ(wheel.NextExpiry(), 200u);
+}
+
+TEST(TimerWheelTests, TimersBeyondRangeExpire)
+{
+  Wheel wheel{};
+
+  Wheel::Tick const far = Wheel::Tick{1} << 30u;
+  wheel.Add(1, far);
+
+  Wheel::Tick now = 0;
+  while (wheel.NextExpiry() < far)
+  {
+    now = wheel.NextExpiry();
+    EXPECT_TRUE(AdvanceTo(wheel, now).empty());
+  }
+
+  EXPECT_EQ(wheel.NextExpiry(), far);
+  EXPECT_EQ(AdvanceTo(wheel, far), (std::vector<uint64_t>{1}));
+}
+
+TEST(TimerWheelTests, MatchesReferenceModel)
+{
+  std::mt19937_64                            rng{42};
+  std::uniform_int_distribution<Wheel::Tick> delay{0, 300000};
+  std::uniform_int_distribution<Wheel::Tick> step{0, 200};
+  std::vector<Wheel::Handle>                 handles{};
+  std::map<uint64_t, Wheel::Tick>            due{};
+
+  Wheel       wheel{};
+  Wheel::Tick now = 0;
+
+  for (uint64_t i = 0; i < 5000; ++i)
+  {
+    Wheel::Tick const at = now + delay(rng);
+    handles.emplace_back(wheel.Add(i, at));
+    due[i] = at;
+
+    // cancel some of the timers which are still pending
+    if ((i % 10) == 0)
+    {
+      auto it = due.find(i / 2);
+      if (it != due.end())
+      {
+        EXPECT_TRUE(wheel.Cancel(handles[i / 2]));
+        due.erase(it);
+      }
+    }
+
+    now += step(rng);
+    for (uint64_t const value : AdvanceTo(wheel, now))
+    {
+      auto it = due.find(value);
+      ASSERT_NE(it, due.end());
+      EXPECT_LE(it->second, now);
+      due.erase(it);
+    }
+
+    // nothing that was due may remain
+    for (auto const &entry : due)
+    {
+      ASSERT_GT(entry.second, now);
+    }
+  }
+
+  EXPECT_EQ(wheel.size(), due.size());
+}
+
+TEST(FutureWorkStoreTests, CancelledWorkIsNotDispatched)
+{
+  FutureWorkStore store{};
+
+  std::size_t count  = 0;
+  auto const  handle = store.Post([&count]() { ++count; }, 0);
+  store.Post([&count]() { count += 10; }, 0);
+
+  EXPECT_TRUE(store.Cancel(handle));
+  EXPECT_EQ(store.TimeUntilNextItem(), std::chrono::milliseconds::zero());
+
+  std::size_t dispatched = 0;
+  while (dispatched == 0)
+  {
+    dispatched = store.Dispatch([](FutureWorkStore::WorkItem const &item) { item(); });
+  }
+
+  EXPECT_EQ(dispatched, 1u);
+  EXPECT_EQ(count, 10u);
+  EXPECT_EQ(store.TimeUntilNextItem(), std::chrono::milliseconds::max());
+}
+
+}  // namespace
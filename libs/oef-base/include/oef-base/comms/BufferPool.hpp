@@ -0,0 +1,65 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A process wide cache of the storage used by the endpoint ring buffers.
+ *
+ * Each endpoint owns a send and a read buffer which are typically a megabyte or more in size.
+ * With many short lived agent connections allocating and freeing these blocks for every endpoint
+ * causes a large amount of page faulting, so the storage of closed endpoints is kept (up to a
+ * limit) and handed to the next endpoint which needs a buffer of the same size.
+ */
+class BufferPool
+{
+public:
+  using Mutex = std::mutex;
+  using Lock  = std::lock_guard<Mutex>;
+  using byte  = std::uint8_t;
+
+  static constexpr std::size_t DEFAULT_MAX_CACHED_BYTES = 64u * 1024u * 1024u;
+
+  explicit BufferPool(std::size_t max_cached_bytes = DEFAULT_MAX_CACHED_BYTES);
+  ~BufferPool();
+
+  static BufferPool &Instance();
+
+  byte *Acquire(std::size_t size);
+  void  Release(byte *buffer, std::size_t size);
+
+  std::size_t cached_bytes() const;
+
+  BufferPool(BufferPool const &other) = delete;
+  BufferPool &operator=(BufferPool const &other)  = delete;
+  bool        operator==(BufferPool const &other) = delete;
+  bool        operator<(BufferPool const &other)  = delete;
+
+private:
+  using FreeList = std::vector<byte *>;
+
+  mutable Mutex                             mutex_;
+  std::unordered_map<std::size_t, FreeList> free_;
+  std::size_t                               cached_bytes_{0};
+  std::size_t                               max_cached_bytes_;
+};
@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "network/fetch_asio.hpp"
+#include "oef-base/comms/BufferPool.hpp"
 #include <functional>
 #include <iostream>
 #include <mutex>
@@ -48,13 +49,13 @@ public:
   explicit RingBuffer(size_t size)
   {
     this->size = size;
-    store      = static_cast<byte *>(malloc(size));
+    store      = BufferPool::Instance().Acquire(size);
     clear();
   }
 
   virtual ~RingBuffer()
   {
-    free(store);
+    BufferPool::Instance().Release(store, size);
   }
 
   void clear()
@@ -18,9 +18,10 @@
 //------------------------------------------------------------------------------
 
 #include "oef-base/conversation/OutboundConversation.hpp"
+#include "oef-base/proto_comms/ProtoArena.hpp"
+#include "oef-base/proto_comms/ZeroCopyBufferStreams.hpp"
 
 #include <google/protobuf/message.h>
-#include <istream>
 #include <memory>
 
 class OutboundConversationWorkerTask;
@@ -48,10 +49,9 @@ public:
 
   void HandleMessage(ConstCharArrayBuffer buffer) override
   {
-    status_code    = 0;
-    auto         r = std::make_shared<PROTOCLASS>();
-    std::istream is(&buffer);
-    if (!r->ParseFromIstream(&is))
+    status_code = 0;
+    auto r      = MakeArenaProto<PROTOCLASS>(NewProtoArena());
+    if (!ParseFromBuffer(*r, buffer))
     {
       status_code   = 91;
       error_message = "";
@@ -0,0 +1,96 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-messages/fetch_protobuf.hpp"
+
+#include <google/protobuf/arena.h>
+
+#include <cstddef>
+#include <memory>
+
+/**
+ * Protobuf arenas shared by the messages of a request.
+ *
+ * The messages parsed and built while handling a request are allocated on a single arena, which
+ * is released in one step together with the last pointer to any of its messages. The returned
+ * pointers share the ownership of the arena, so they are passed along the task chain like any
+ * other message pointer.
+ *
+ * Messages on an arena must not be moved to another arena with release_* / set_allocated_*,
+ * which copy across arenas; sub messages are shared with ShareSubProto instead.
+ */
+using ProtoArenaPtr = std::shared_ptr<google::protobuf::Arena>;
+
+constexpr std::size_t PROTO_ARENA_START_BLOCK_SIZE = 1024;
+
+inline ProtoArenaPtr NewProtoArena()
+{
+  google::protobuf::ArenaOptions options;
+  options.start_block_size = PROTO_ARENA_START_BLOCK_SIZE;
+
+  return std::make_shared<google::protobuf::Arena>(options);
+}
+
+/**
+ * Create a message on an arena
+ *
+ * @param arena The arena, the message is allocated on the heap if empty
+ * @return The message, which keeps the arena alive
+ */
+template <typename PROTO>
+std::shared_ptr<PROTO> MakeArenaProto(ProtoArenaPtr const &arena)
+{
+  if (!arena)
+  {
+    return std::make_shared<PROTO>();
+  }
+
+  return std::shared_ptr<PROTO>(arena, google::protobuf::Arena::CreateMessage<PROTO>(arena.get()));
+}
+
+/**
+ * Create a message on the same arena as another message of the request
+ *
+ * @param sibling The other message
+ * @return The message, which keeps the arena alive
+ */
+template <typename PROTO, typename SIBLING>
+std::shared_ptr<PROTO> MakeSiblingProto(std::shared_ptr<SIBLING> const &sibling)
+{
+  auto arena = sibling ? sibling->GetArena() : nullptr;
+  if (arena == nullptr)
+  {
+    return std::make_shared<PROTO>();
+  }
+
+  return std::shared_ptr<PROTO>(sibling, google::protobuf::Arena::CreateMessage<PROTO>(arena));
+}
+
+/**
+ * Share a sub message without copying it out of its parent
+ *
+ * @param parent The message owning the sub message
+ * @param message The sub message
+ * @return The sub message, which keeps the parent alive
+ */
+template <typename PROTO, typename PARENT>
+std::shared_ptr<PROTO> ShareSubProto(std::shared_ptr<PARENT> const &parent, PROTO *message)
+{
+  return std::shared_ptr<PROTO>(parent, message);
+}
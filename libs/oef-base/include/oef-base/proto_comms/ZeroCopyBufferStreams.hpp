@@ -0,0 +1,179 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/fetch_asio.hpp"
+#include "oef-base/comms/CharArrayBuffer.hpp"
+#include "oef-base/comms/ConstCharArrayBuffer.hpp"
+#include "oef-messages/fetch_protobuf.hpp"
+
+#include <google/protobuf/io/zero_copy_stream.h>
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * Presents the unread region of a ConstCharArrayBuffer (from its current position up to its size
+ * limit) to protobuf as a sequence of contiguous blocks, so a message can be parsed in place from
+ * the segments of the ring buffer instead of being copied out byte by byte through a stream.
+ * The position of the underlying buffer is advanced as data is consumed.
+ */
+class ConstCharArrayInputStream : public google::protobuf::io::ZeroCopyInputStream
+{
+public:
+  explicit ConstCharArrayInputStream(ConstCharArrayBuffer &chars)
+    : chars_(chars)
+    , start_(chars.current)
+  {}
+  ~ConstCharArrayInputStream() override = default;
+
+  bool Next(void const **data, int *size) override
+  {
+    uint32_t offset = chars_.current;
+    for (auto const &buffer : chars_.buffers)
+    {
+      if (chars_.current >= chars_.size)
+      {
+        break;
+      }
+
+      auto const buffer_size = static_cast<uint32_t>(asio::buffer_size(buffer));
+      if (offset < buffer_size)
+      {
+        auto const available = std::min(buffer_size - offset, chars_.size - chars_.current);
+
+        *data = asio::buffer_cast<uint8_t const *>(buffer) + offset;
+        *size = static_cast<int>(available);
+        chars_.current += available;
+        return true;
+      }
+
+      offset -= buffer_size;
+    }
+
+    return false;
+  }
+
+  void BackUp(int count) override
+  {
+    chars_.current -= static_cast<uint32_t>(count);
+  }
+
+  bool Skip(int count) override
+  {
+    auto const remaining = chars_.size - chars_.current;
+    if (static_cast<uint32_t>(count) > remaining)
+    {
+      chars_.current = chars_.size;
+      return false;
+    }
+
+    chars_.current += static_cast<uint32_t>(count);
+    return true;
+  }
+
+  int64_t ByteCount() const override
+  {
+    return static_cast<int64_t>(chars_.current - start_);
+  }
+
+private:
+  ConstCharArrayBuffer &chars_;
+  uint32_t              start_;
+};
+
+/**
+ * Exposes the free space of a CharArrayBuffer (for example both regions of a wrapped ring buffer)
+ * to protobuf, so that messages are serialised directly into the send buffer.
+ */
+class CharArrayOutputStream : public google::protobuf::io::ZeroCopyOutputStream
+{
+public:
+  explicit CharArrayOutputStream(CharArrayBuffer &chars)
+    : chars_(chars)
+    , start_(chars.current)
+  {}
+  ~CharArrayOutputStream() override = default;
+
+  bool Next(void **data, int *size) override
+  {
+    int offset = chars_.current;
+    for (auto const &buffer : chars_.buffers)
+    {
+      if (chars_.current >= chars_.size)
+      {
+        break;
+      }
+
+      auto const buffer_size = static_cast<int>(asio::buffer_size(buffer));
+      if (offset < buffer_size)
+      {
+        auto const available = buffer_size - offset;
+
+        *data = asio::buffer_cast<uint8_t *>(buffer) + offset;
+        *size = available;
+        chars_.current += available;
+        return true;
+      }
+
+      offset -= buffer_size;
+    }
+
+    return false;
+  }
+
+  void BackUp(int count) override
+  {
+    chars_.current -= count;
+  }
+
+  int64_t ByteCount() const override
+  {
+    return static_cast<int64_t>(chars_.current - start_);
+  }
+
+private:
+  CharArrayBuffer &chars_;
+  int              start_;
+};
+
+/**
+ * Parse a message from all of the unread data of a buffer
+ *
+ * @param message The message to be populated
+ * @param chars The buffer to read from, advanced past the data consumed
+ * @return true if successful, otherwise false
+ */
+inline bool ParseFromBuffer(google::protobuf::Message &message, ConstCharArrayBuffer &chars)
+{
+  ConstCharArrayInputStream stream(chars);
+  return message.ParseFromZeroCopyStream(&stream);
+}
+
+/**
+ * Serialise a message into the free space of a buffer
+ *
+ * @param message The message to be written
+ * @param chars The buffer to write to, advanced past the data produced
+ * @return true if successful, otherwise false
+ */
+inline bool SerializeToBuffer(google::protobuf::Message const &message, CharArrayBuffer &chars)
+{
+  CharArrayOutputStream stream(chars);
+  return message.SerializeToZeroCopyStream(&stream);
+}
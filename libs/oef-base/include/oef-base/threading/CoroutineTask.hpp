@@ -0,0 +1,132 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "logging/logging.hpp"
+#include "oef-base/threading/ExitState.hpp"
+#include "oef-base/threading/Task.hpp"
+#include "oef-base/threading/Waitable.hpp"
+
+#include <exception>
+
+/**
+ * Stackless coroutine support for tasks running on the Taskpool.
+ *
+ * The body of a coroutine is written as a single function between FETCH_CO_BEGIN and FETCH_CO_END.
+ * Whenever the coroutine waits (FETCH_CO_AWAIT) or yields (FETCH_CO_YIELD) the current position is
+ * recorded and the function returns to the taskpool. The next time the task is run execution
+ * continues from the recorded position. Since the frame of the function is not preserved, any
+ * state which must survive a suspension has to be stored in members of the task. The macros can
+ * not be used inside a nested switch statement.
+ */
+#define FETCH_CO_BEGIN()       \
+  switch (this->resume_point_) \
+  {                            \
+  case 0:
+
+// the waitable expression is evaluated again when the task is resumed, so that a spurious wake up
+// simply suspends the task again until the object has actually been woken or cancelled
+#define FETCH_CO_AWAIT(waitable)        \
+  do                                    \
+  {                                     \
+    this->resume_point_ = __LINE__;     \
+  case __LINE__:                        \
+    if (this->Await(waitable))          \
+    {                                   \
+      return ::fetch::oef::base::DEFER; \
+    }                                   \
+  } while (false)
+
+#define FETCH_CO_YIELD()              \
+  do                                  \
+  {                                   \
+    this->resume_point_ = __LINE__;   \
+    return ::fetch::oef::base::RERUN; \
+  case __LINE__:;                     \
+  } while (false)
+
+#define FETCH_CO_END() \
+  }                    \
+  return ::fetch::oef::base::COMPLETE
+
+namespace fetch {
+namespace oef {
+namespace base {
+
+/**
+ * A task which suspends and resumes in place instead of being split into a state machine. Waiting
+ * registers the task directly with the waitable object, so no notifications or new tasks are
+ * allocated for each step of the flow.
+ */
+class CoroutineTask : virtual public Task
+{
+public:
+  static constexpr char const *LOGGING_NAME = "CoroutineTask";
+
+  CoroutineTask()           = default;
+  ~CoroutineTask() override = default;
+
+  bool IsRunnable() const override
+  {
+    return true;
+  }
+
+  ExitState run() override
+  {
+    try
+    {
+      return Resume();
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Exception in coroutine task: ", e.what());
+      return ERRORED;
+    }
+  }
+
+protected:
+  /**
+   * The body of the coroutine, delimited by FETCH_CO_BEGIN and FETCH_CO_END
+   *
+   * @return The exit state reported to the taskpool
+   */
+  virtual ExitState Resume() = 0;
+
+  /**
+   * Register this task with a waitable object
+   *
+   * @param waitable The object to wait on
+   * @return true if the task must be suspended, false if the object has already completed
+   */
+  bool Await(Waitable &waitable)
+  {
+    return waitable.AddWaitingTask(shared_from_this());
+  }
+
+  int resume_point_{0};
+
+private:
+  CoroutineTask(CoroutineTask const &other) = delete;
+  CoroutineTask &operator=(CoroutineTask const &other)  = delete;
+  bool           operator==(CoroutineTask const &other) = delete;
+  bool           operator<(CoroutineTask const &other)  = delete;
+};
+
+}  // namespace base
+}  // namespace oef
+}  // namespace fetch
@@ -19,6 +19,7 @@
 
 #include "oef-base/threading/Notification.hpp"
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -26,12 +27,15 @@ namespace fetch {
 namespace oef {
 namespace base {
 
+class Task;
+
 class Waitable
 {
 public:
-  using Mutex   = std::mutex;
-  using Lock    = std::lock_guard<Mutex>;
-  using Waiting = std::vector<Notification::Notification>;
+  using Mutex        = std::mutex;
+  using Lock         = std::lock_guard<Mutex>;
+  using Waiting      = std::vector<Notification::Notification>;
+  using WaitingTasks = std::vector<std::weak_ptr<Task>>;
 
   Waitable()
     : cancelled{false}
@@ -41,12 +45,14 @@ public:
 
   Notification::NotificationBuilder MakeNotification();
   void                              wake();
+  bool                              AddWaitingTask(std::weak_ptr<Task> task);
 
   void swap(Waitable &other)
   {
     Lock lock_other(other.mutex);
     Lock lock(mutex);
     std::swap(waiting, other.waiting);
+    std::swap(waiting_tasks_, other.waiting_tasks_);
     std::swap(cancelled, other.cancelled);
   }
 
@@ -58,8 +64,14 @@ public:
     return cancelled;
   }
 
+  bool IsWoken() const
+  {
+    return woken_.load();
+  }
+
 protected:
   Waiting           waiting;
+  WaitingTasks      waiting_tasks_;
   bool              cancelled;
   std::atomic<bool> woken_;
   mutable Mutex     mutex;
@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-base/comms/BufferPool.hpp"
+
+#include <cstdlib>
+#include <new>
+
+constexpr std::size_t BufferPool::DEFAULT_MAX_CACHED_BYTES;
+
+BufferPool::BufferPool(std::size_t max_cached_bytes)
+  : max_cached_bytes_{max_cached_bytes}
+{}
+
+BufferPool::~BufferPool()
+{
+  for (auto &entry : free_)
+  {
+    for (byte *buffer : entry.second)
+    {
+      free(buffer);
+    }
+  }
+}
+
+BufferPool &BufferPool::Instance()
+{
+  static BufferPool pool;
+  return pool;
+}
+
+/**
+ * Get a block of storage, reusing a released block of the same size when one is available
+ *
+ * @param size The size of the block in bytes
+ * @return The block
+ */
+BufferPool::byte *BufferPool::Acquire(std::size_t size)
+{
+  {
+    Lock lock(mutex_);
+    auto it = free_.find(size);
+    if ((it != free_.end()) && !it->second.empty())
+    {
+      byte *buffer = it->second.back();
+      it->second.pop_back();
+      cached_bytes_ -= size;
+      return buffer;
+    }
+  }
+
+  auto buffer = static_cast<byte *>(malloc(size));
+  if (buffer == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return buffer;
+}
+
+/**
+ * Return a block to the pool. The block is freed if caching it would exceed the limit.
+ *
+ * @param buffer The block previously obtained from Acquire
+ * @param size The size of the block in bytes
+ */
+void BufferPool::Release(byte *buffer, std::size_t size)
+{
+  if (buffer == nullptr)
+  {
+    return;
+  }
+
+  {
+    Lock lock(mutex_);
+    if (cached_bytes_ + size <= max_cached_bytes_)
+    {
+      free_[size].push_back(buffer);
+      cached_bytes_ += size;
+      return;
+    }
+  }
+
+  free(buffer);
+}
+
+std::size_t BufferPool::cached_bytes() const
+{
+  Lock lock(mutex_);
+  return cached_bytes_;
+}
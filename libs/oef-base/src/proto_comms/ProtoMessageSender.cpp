@@ -18,34 +18,27 @@
 
 #include "oef-base/proto_comms/ProtoMessageEndpoint.hpp"
 #include "oef-base/proto_comms/ProtoMessageSender.hpp"
+#include "oef-base/proto_comms/ZeroCopyBufferStreams.hpp"
 #include <google/protobuf/message.h>
 
 ProtoMessageSender::consumed_needed_pair ProtoMessageSender::CheckForSpace(
     const mutable_buffers &data, IMessageWriter<TXType>::TXQ &txq)
 {
+  auto ep = endpoint.lock();
+  if (ep == nullptr)
+  {
+    return consumed_needed_pair(0, 0);
+  }
+
   CharArrayBuffer chars(data);
-  std::ostream    os(&chars);
 
+  // write as many of the queued messages as will fit, so that they all go out with a single
+  // socket write
   std::size_t consumed = 0;
-  while (true)
   {
+    Lock lock(mutex);
+    while (!txq.empty())
     {
-      auto ep = endpoint.lock();
-      if (ep == nullptr)
-      {
-        break;
-      }
-      if (!ep->IsTXQFull())
-      {
-        ep->wake();
-
-        if (txq.empty())
-        {
-          break;
-        }
-      }
-      Lock lock(mutex);
-
       auto     body_size = static_cast<uint32_t>(txq.front()->ByteSize());
       uint32_t head_size = sizeof(uint32_t);
       uint32_t mesg_size = body_size + head_size;
@@ -61,11 +54,9 @@ ProtoMessageSender::consumed_needed_pair ProtoMessageSender::CheckForSpace(
         throw std::invalid_argument("Refusing to send when endianness is DUNNO.");
         break;
       case fetch::oef::base::Endianness::LITTLE:
-        // std::cout << "send little-endian size " << body_size << std::endl;
         chars.write_little_endian(body_size);
         break;
       case fetch::oef::base::Endianness::NETWORK:
-        // std::cout << "send network-endian size" << body_size << std::endl;
         chars.write(body_size);
         break;
       case fetch::oef::base::Endianness::BAD:
@@ -73,13 +64,17 @@ ProtoMessageSender::consumed_needed_pair ProtoMessageSender::CheckForSpace(
         break;
       }
 
-      txq.front()->SerializeToOstream(&os);
+      SerializeToBuffer(*txq.front(), chars);
       txq.pop_front();
-      // std::cout << "Ready for sending! bytes=" << mesg_size << std::endl;
-      // chars.diagnostic();
 
       consumed += mesg_size;
     }
   }
+
+  if (!ep->IsTXQFull())
+  {
+    ep->wake();
+  }
+
   return consumed_needed_pair(consumed, 0);
 }
@@ -21,6 +21,7 @@
 #include "oef-base/proto_comms/ProtoMessageEndpoint.hpp"
 #include "oef-base/proto_comms/ProtoMessageSender.hpp"
 #include "oef-base/proto_comms/ProtoPathMessageReader.hpp"
+#include "oef-base/proto_comms/ZeroCopyBufferStreams.hpp"
 #include "oef-base/utils/Uri.hpp"
 #include "oef-messages/transport.hpp"
 
@@ -92,8 +93,7 @@ ProtoPathMessageReader::consumed_needed_pair ProtoPathMessageReader::CheckForMes
 
     auto header_chars =
         ConstCharArrayBuffer(chars, static_cast<uint32_t>(chars.current + leader_size));
-    std::istream h_is(&header_chars);
-    if (!leader.ParseFromIstream(&h_is))
+    if (!ParseFromBuffer(leader, header_chars))
     {
       FETCH_LOG_WARN(LOGGING_NAME, "Failed to parse header!");
       throw std::invalid_argument("Proto deserialization refuses incoming invalid leader message!");
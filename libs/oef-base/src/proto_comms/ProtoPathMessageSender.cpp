@@ -20,6 +20,7 @@
 
 #include "oef-base/monitoring/Counter.hpp"
 #include "oef-base/proto_comms/ProtoMessageEndpoint.hpp"
+#include "oef-base/proto_comms/ZeroCopyBufferStreams.hpp"
 #include "oef-base/utils/Uri.hpp"
 #include "oef-messages/transport.hpp"
 
@@ -31,34 +32,23 @@ ProtoPathMessageSender::consumed_needed_pair ProtoPathMessageSender::CheckForSpa
     const mutable_buffers &data, IMessageWriter::TXQ &txq)
 {
   FETCH_LOG_INFO(LOGGING_NAME, "search message tx...");
+
+  auto ep = endpoint.lock();
+  if (ep == nullptr)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "No endpoint pointer, break..");
+    return consumed_needed_pair(0, 0);
+  }
+
   CharArrayBuffer chars(data);
-  std::ostream    os(&chars);
 
+  // write as many of the queued messages as will fit, so that they all go out with a single
+  // socket write
   std::size_t consumed = 0;
-  while (true)
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "Starting search message tx...");
+    Lock lock(mutex);
+    while (!txq.empty())
     {
-      auto ep = endpoint.lock();
-      if (ep == nullptr)
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "No endpoint pointer, break..");
-        break;
-      }
-
-      if (!ep->IsTXQFull())
-      {
-        ep->wake();
-
-        if (txq.empty())
-        {
-          FETCH_LOG_WARN(LOGGING_NAME, "TXQ empty, break..");
-          break;
-        }
-      }
-
-      Lock lock(mutex);
-
       TransportHeader leader;
       leader.set_uri(txq.front().first.path);
       leader.set_id(txq.front().first.port);
@@ -78,8 +68,8 @@ ProtoPathMessageSender::consumed_needed_pair ProtoPathMessageSender::CheckForSpa
 
       chars.write(leader_size);
       chars.write(payload_size);
-      leader.SerializeToOstream(&os);
-      txq.front().second->SerializeToOstream(&os);
+      SerializeToBuffer(leader, chars);
+      SerializeToBuffer(*txq.front().second, chars);
 
       bytes_produced_counter += 8;
       bytes_produced_counter += leader_size;
@@ -87,12 +77,16 @@ ProtoPathMessageSender::consumed_needed_pair ProtoPathMessageSender::CheckForSpa
 
       txq.pop_front();
       messages_handled_counter++;
-      // std::cout << "Ready for sending! bytes=" << mesg_size  << std::endl;
-      // chars.diagnostic();
 
       consumed += mesg_size;
     }
   }
+
+  if (!ep->IsTXQFull())
+  {
+    ep->wake();
+  }
+
   bytes_requested_counter += consumed;
   return consumed_needed_pair(consumed, 0);
 }
@@ -17,10 +17,28 @@
 //------------------------------------------------------------------------------
 
 #include "oef-base/threading/Waitable.hpp"
+#include "oef-base/threading/Task.hpp"
+
+#include <utility>
 
 namespace fetch {
 namespace oef {
 namespace base {
+namespace {
+
+void MakeTasksRunnable(Waitable::WaitingTasks const &tasks)
+{
+  for (auto const &task : tasks)
+  {
+    auto task_sp = task.lock();
+    if (task_sp)
+    {
+      task_sp->MakeRunnable();
+    }
+  }
+}
+
+}  // namespace
 
 Notification::NotificationBuilder Waitable::MakeNotification()
 {
@@ -42,7 +60,35 @@ void Waitable::wake()
   {
     waiter->Notify();
   }
-  woken_.store(true);
+
+  WaitingTasks tasks_local;
+  {
+    Lock lock(mutex);
+    woken_.store(true);
+    tasks_local.swap(waiting_tasks_);
+  }
+
+  MakeTasksRunnable(tasks_local);
+}
+
+/**
+ * Register a task to be made runnable when this waitable is woken or cancelled. Unlike a
+ * notification this does not allocate a callback per wait, so a suspended task can be resumed
+ * directly by the taskpool.
+ *
+ * @param task The task waiting for this object
+ * @return true if the task must wait, false if the object has already been woken or cancelled
+ */
+bool Waitable::AddWaitingTask(std::weak_ptr<Task> task)
+{
+  Lock lock(mutex);
+  if (woken_.load() || cancelled)
+  {
+    return false;
+  }
+
+  waiting_tasks_.emplace_back(std::move(task));
+  return true;
 }
 
 void swap(Waitable &v1, Waitable &v2)
@@ -52,17 +98,21 @@ void swap(Waitable &v1, Waitable &v2)
 
 void Waitable::cancel()
 {
-  Waiting waiting_local;
+  Waiting      waiting_local;
+  WaitingTasks tasks_local;
   {
     Lock lock(mutex);
     cancelled = true;
     waiting_local.swap(waiting);
+    tasks_local.swap(waiting_tasks_);
   }
 
   for (auto &waiter : waiting_local)
   {
     waiter->Fail();
   }
+
+  MakeTasksRunnable(tasks_local);
 }
 
 }  // namespace base
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "oef-base/comms/BufferPool.hpp"
+#include "oef-base/comms/CharArrayBuffer.hpp"
+#include "oef-base/comms/ConstCharArrayBuffer.hpp"
+#include "oef-base/proto_comms/ProtoArena.hpp"
+#include "oef-base/proto_comms/ZeroCopyBufferStreams.hpp"
+
+#include <google/protobuf/wrappers.pb.h>
+
+#include <string>
+#include <vector>
+
+class OefBaseCommsTests : public testing::Test
+{
+public:
+  using StringValue = google::protobuf::StringValue;
+
+  static StringValue MakeMessage(std::size_t length)
+  {
+    StringValue message;
+    message.set_value(std::string(length, 'x') + "end");
+    return message;
+  }
+};
+
+TEST_F(OefBaseCommsTests, ParseAcrossBufferSegments)
+{
+  auto const        message    = MakeMessage(200);
+  std::string const serialised = message.SerializeAsString();
+
+  // every possible split of the message between the two regions of a wrapped ring buffer
+  for (std::size_t split = 0; split <= serialised.size(); ++split)
+  {
+    std::vector<asio::const_buffer> buffers{
+        asio::const_buffer(serialised.data(), split),
+        asio::const_buffer(serialised.data() + split, serialised.size() - split)};
+
+    ConstCharArrayBuffer chars(buffers);
+    StringValue          parsed;
+    ASSERT_TRUE(ParseFromBuffer(parsed, chars));
+    EXPECT_EQ(parsed.value(), message.value());
+    EXPECT_EQ(chars.RemainingData(), 0);
+  }
+}
+
+TEST_F(OefBaseCommsTests, ParseStopsAtSizeLimit)
+{
+  auto const  first      = MakeMessage(10);
+  auto const  second     = MakeMessage(20);
+  std::string serialised = first.SerializeAsString();
+  auto const  first_size = static_cast<uint32_t>(serialised.size());
+  serialised += second.SerializeAsString();
+
+  std::vector<asio::const_buffer> buffers{asio::const_buffer(serialised.data(), serialised.size())};
+  ConstCharArrayBuffer            chars(buffers);
+
+  ConstCharArrayBuffer first_chars(chars, first_size);
+  StringValue          parsed;
+  ASSERT_TRUE(ParseFromBuffer(parsed, first_chars));
+  EXPECT_EQ(parsed.value(), first.value());
+
+  chars.advance(first_size);
+  ASSERT_TRUE(ParseFromBuffer(parsed, chars));
+  EXPECT_EQ(parsed.value(), second.value());
+}
+
+TEST_F(OefBaseCommsTests, SerializeAcrossBufferSegments)
+{
+  auto const message = MakeMessage(100);
+
+  std::vector<char>                 storage(message.ByteSizeLong() + 16);
+  std::vector<asio::mutable_buffer> buffers{asio::mutable_buffer(storage.data(), 37),
+                                            asio::mutable_buffer(storage.data() + 37,
+                                                                 storage.size() - 37)};
+
+  CharArrayBuffer chars(buffers);
+  chars.write(static_cast<uint32_t>(message.ByteSizeLong()));
+  ASSERT_TRUE(SerializeToBuffer(message, chars));
+  EXPECT_EQ(chars.current, static_cast<int>(message.ByteSizeLong() + sizeof(uint32_t)));
+
+  std::vector<asio::const_buffer> input{asio::const_buffer(storage.data(), storage.size())};
+  ConstCharArrayBuffer            read_chars(input);
+  uint32_t                        size = 0;
+  read_chars.read(size);
+  ASSERT_EQ(size, message.ByteSizeLong());
+
+  ConstCharArrayBuffer body(read_chars, read_chars.current + size);
+  StringValue          parsed;
+  ASSERT_TRUE(ParseFromBuffer(parsed, body));
+  EXPECT_EQ(parsed.value(), message.value());
+}
+
+TEST_F(OefBaseCommsTests, SerializeFailsWithoutSpace)
+{
+  auto const message = MakeMessage(100);
+
+  std::vector<char>                 storage(message.ByteSizeLong() / 2);
+  std::vector<asio::mutable_buffer> buffers{asio::mutable_buffer(storage.data(), storage.size())};
+
+  CharArrayBuffer chars(buffers);
+  EXPECT_FALSE(SerializeToBuffer(message, chars));
+}
+
+TEST_F(OefBaseCommsTests, BufferPoolReusesReleasedBlocks)
+{
+  BufferPool pool(1000);
+
+  auto block = pool.Acquire(600);
+  pool.Release(block, 600);
+  EXPECT_EQ(pool.cached_bytes(), 600u);
+
+  EXPECT_EQ(pool.Acquire(600), block);
+  EXPECT_EQ(pool.cached_bytes(), 0u);
+
+  // blocks which would exceed the limit are freed instead of cached
+  auto other = pool.Acquire(600);
+  pool.Release(block, 600);
+  pool.Release(other, 600);
+  EXPECT_EQ(pool.cached_bytes(), 600u);
+}
+
+TEST_F(OefBaseCommsTests, ArenaMessagesShareTheArena)
+{
+  std::weak_ptr<google::protobuf::Arena> arena_ref;
+  std::shared_ptr<StringValue>           reply;
+  {
+    auto arena = NewProtoArena();
+    arena_ref  = arena;
+
+    auto request = MakeArenaProto<StringValue>(arena);
+    request->set_value("request");
+    EXPECT_EQ(request->GetArena(), arena.get());
+
+    reply = MakeSiblingProto<StringValue>(request);
+    reply->set_value("reply");
+    EXPECT_EQ(reply->GetArena(), arena.get());
+  }
+
+  // the arena lives as long as any of its messages
+  EXPECT_FALSE(arena_ref.expired());
+  EXPECT_EQ(reply->value(), "reply");
+
+  reply.reset();
+  EXPECT_TRUE(arena_ref.expired());
+}
+
+TEST_F(OefBaseCommsTests, HeapMessagesWithoutArena)
+{
+  auto message = MakeArenaProto<StringValue>(nullptr);
+  EXPECT_EQ(message->GetArena(), nullptr);
+  EXPECT_EQ(MakeSiblingProto<StringValue>(message)->GetArena(), nullptr);
+}
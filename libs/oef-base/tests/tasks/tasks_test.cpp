@@ -18,6 +18,7 @@
 
 #include "gtest/gtest.h"
 
+#include "oef-base/threading/CoroutineTask.hpp"
 #include "oef-base/threading/Task.hpp"
 #include "oef-base/threading/Taskpool.hpp"
 #include "oef-base/threading/Threadpool.hpp"
@@ -108,3 +109,68 @@ TEST_F(TasksTests, task_execution)
 
   EXPECT_EQ(counter, 5);
 }
+
+class CountingCoroutineTask : public fetch::oef::base::CoroutineTask
+{
+public:
+  using ExitState = fetch::oef::base::ExitState;
+  using Waitable  = fetch::oef::base::Waitable;
+
+  Waitable         first;
+  Waitable         second;
+  std::atomic<int> steps{0};
+
+  ExitState Resume() override
+  {
+    FETCH_CO_BEGIN();
+
+    ++steps;
+    FETCH_CO_YIELD();
+
+    ++steps;
+    FETCH_CO_AWAIT(first);
+
+    ++steps;
+    FETCH_CO_AWAIT(second);
+
+    ++steps;
+
+    FETCH_CO_END();
+  }
+};
+
+TEST_F(TasksTests, coroutine_suspends_until_woken)
+{
+  auto task = std::make_shared<CountingCoroutineTask>();
+
+  taskpool_->submit(task);
+  ::usleep(10000);
+  EXPECT_EQ(task->steps, 2);
+  EXPECT_EQ(task->GetTaskState(), Task::TaskState::SUSPENDED);
+
+  task->first.wake();
+  ::usleep(10000);
+  EXPECT_EQ(task->steps, 3);
+
+  // a spurious wake up does not resume the coroutine past the wait
+  task->MakeRunnable();
+  ::usleep(10000);
+  EXPECT_EQ(task->steps, 3);
+
+  task->second.cancel();
+  ::usleep(10000);
+  EXPECT_EQ(task->steps, 4);
+  EXPECT_EQ(task->GetTaskState(), Task::TaskState::DONE);
+}
+
+TEST_F(TasksTests, coroutine_does_not_wait_for_woken_waitable)
+{
+  auto task = std::make_shared<CountingCoroutineTask>();
+  task->first.wake();
+  task->second.wake();
+
+  taskpool_->submit(task);
+  ::usleep(10000);
+
+  EXPECT_EQ(task->steps, 4);
+}
@@ -32,7 +32,6 @@
 
 #include "oef-core/karma/KarmaPolicyBasic.hpp"
 #include "oef-core/karma/KarmaPolicyNone.hpp"
-#include "oef-core/karma/KarmaRefreshTask.hpp"
 
 #include "oef-base/comms/Endpoint.hpp"
 #include "oef-base/comms/EndpointWebSocket.hpp"
@@ -151,15 +150,12 @@ int MtCore::run()
   if (config_.karma_policy().size())
   {
     FETCH_LOG_INFO(LOGGING_NAME, "KARMA = BASIC");
-    karma_policy      = std::make_shared<KarmaPolicyBasic>(config_.karma_policy());
-    auto ref_interval = config_.karma_refresh_interval_ms();
-    if (ref_interval == 0)
+    auto ref_interval = KarmaPolicyBasic::DEFAULT_REFRESH_INTERVAL;
+    if (config_.karma_refresh_interval_ms() != 0)
     {
-      ref_interval = 1000;
+      ref_interval = std::chrono::milliseconds(config_.karma_refresh_interval_ms());
     }
-    std::shared_ptr<Task> refresher =
-        std::make_shared<KarmaRefreshTask>(karma_policy.get(), ref_interval);
-    refresher->submit();
+    karma_policy = std::make_shared<KarmaPolicyBasic>(config_.karma_policy(), ref_interval);
   }
   else
   {
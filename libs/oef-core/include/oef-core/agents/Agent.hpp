@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -52,10 +53,22 @@ public:
     return key;
   }
 
+  /// Called when the agent is removed from, or replaced in, the registry
+  void disconnect()
+  {
+    is_connected = false;
+  }
+
+  bool connected() const
+  {
+    return is_connected;
+  }
+
 protected:
 private:
   std::string                       key;
   std::shared_ptr<OefAgentEndpoint> endpoint;
+  std::atomic<bool>                 is_connected{true};
 
   Agent(const Agent &other) = delete;
   Agent &operator=(const Agent &other)  = delete;
@@ -17,14 +17,24 @@
 //
 //------------------------------------------------------------------------------
 
-#include <map>
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 class Agent;
 class OefAgentEndpoint;
 
+/**
+ * The registry of the agents connected to the core.
+ *
+ * The agents are spread over a fixed number of shards by the hash of their key. Every shard
+ * publishes an immutable snapshot of its agents, so that lookups, which happen for every message
+ * exchanged between agents, never take a lock. Adding or removing an agent copies the snapshot of
+ * its shard under the lock of that shard only.
+ */
 class Agents
 {
 public:
@@ -34,7 +44,29 @@ public:
 
   using AgentSP    = std::shared_ptr<Agent>;
   using EndpointSP = std::shared_ptr<OefAgentEndpoint>;
-  using Store      = std::map<Key, AgentSP>;
+  using Store      = std::unordered_map<Key, AgentSP>;
+  using StoreSP    = std::shared_ptr<Store const>;
+
+  static constexpr std::size_t SHARDS = 64;
+
+  /**
+   * Agents looked up on behalf of a single connection. Entries are kept until their agent is
+   * removed from the registry, so that the peers of a conversation are only searched once.
+   * Not thread safe, every connection owns its own cache.
+   */
+  class Cache
+  {
+  public:
+    static constexpr std::size_t MAX_ENTRIES = 256;
+
+    explicit Cache(std::shared_ptr<Agents> agents);
+
+    AgentSP find(const std::string &key);
+
+  private:
+    std::shared_ptr<Agents>                       agents;
+    std::unordered_map<Key, std::weak_ptr<Agent>> entries;
+  };
 
   Agents()          = default;
   virtual ~Agents() = default;
@@ -42,12 +74,21 @@ public:
   void add(const std::string &key, std::shared_ptr<OefAgentEndpoint> endpoint);
   void remove(const std::string &key);
 
-  std::shared_ptr<Agent> find(const std::string &key);
+  std::shared_ptr<Agent> find(const std::string &key) const;
+  std::size_t            size() const;
 
 protected:
 private:
-  Store         agents;
-  mutable Mutex mutex;
+  struct Shard
+  {
+    mutable Mutex mutex;
+    StoreSP       agents = std::make_shared<Store const>();
+  };
+
+  Shard &      shard(const std::string &key);
+  Shard const &shard(const std::string &key) const;
+
+  std::array<Shard, SHARDS> shards;
 
   Agents(const Agents &other) = delete;
   Agents &operator=(const Agents &other)  = delete;
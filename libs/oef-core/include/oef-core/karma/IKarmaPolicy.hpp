@@ -17,7 +17,6 @@
 //
 //------------------------------------------------------------------------------
 
-#include <chrono>
 #include <string>
 
 class KarmaAccount;
@@ -43,9 +42,6 @@ public:
 
   virtual bool CouldPerform(const KarmaAccount &identifier, const std::string &action) = 0;
 
-  virtual void RefreshCycle(const std::chrono::milliseconds /*delta*/)
-  {}
-
 protected:
   // because friendship is not heritable.
   void changeAccountNumber(KarmaAccount *acc, std::size_t number);
@@ -18,7 +18,10 @@
 //------------------------------------------------------------------------------
 
 #include <atomic>
-#include <map>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "oef-base/utils/BucketsOf.hpp"
@@ -26,10 +29,22 @@
 #include "oef-core/karma/KarmaAccount.hpp"
 #include "oef-messages/fetch_protobuf.hpp"
 
+/**
+ * Karma accounts are token buckets. Every action costs or earns the karma configured for it and
+ * the "refresh" effect is credited once per refresh interval, up to a maximum.
+ *
+ * The balance and the last refresh interval credited share a single atomic per account, so the
+ * credit owed is computed when the account is used instead of by a periodic sweep, and accounts
+ * are updated with a compare and swap instead of a lock. The effects of the configured actions
+ * are parsed once, when the policy is created.
+ */
 class KarmaPolicyBasic : public IKarmaPolicy
 {
 public:
-  explicit KarmaPolicyBasic(const google::protobuf::Map<std::string, std::string> &config);
+  static constexpr std::chrono::milliseconds DEFAULT_REFRESH_INTERVAL{1000};
+
+  explicit KarmaPolicyBasic(const google::protobuf::Map<std::string, std::string> &config,
+                            std::chrono::milliseconds refresh_interval = DEFAULT_REFRESH_INTERVAL);
   ~KarmaPolicyBasic() override = default;
 
   KarmaAccount GetAccount(const std::string &pubkey = "", const std::string &ip = "") override;
@@ -41,32 +56,50 @@ public:
   bool        CouldPerform(const KarmaAccount &identifier, const std::string &action) override;
   std::string GetBalance(const KarmaAccount &identifier) override;
 
-  void RefreshCycle(std::chrono::milliseconds delta) override;
-
 protected:
 private:
   using KARMA                               = int32_t;
-  using TICKS                               = std::size_t;
+  using TICKS                               = uint32_t;
+  using State                               = uint64_t;
+  using Clock                               = std::chrono::steady_clock;
   static constexpr char const *LOGGING_NAME = "KarmaPolicyBasic";
 
+  struct Effect
+  {
+    enum class Kind
+    {
+      NONE,
+      ADD,
+      SET,
+      DISCONNECT
+    };
+
+    Kind  kind   = Kind::NONE;
+    KARMA amount = 0;
+  };
+
+  /**
+   * The balance of an account together with the refresh interval it was last credited for
+   */
   class Account
   {
   public:
-    mutable std::atomic<KARMA> karma;
-    mutable std::atomic<TICKS> when;
+    mutable std::atomic<State> state;
 
     Account();
-
-    void BringUpToDate();
   };
 
   using AccountName   = std::string;
   using AccountNumber = std::size_t;
   using Accounts      = BucketsOf<Account, std::string, std::size_t, 1024>;
-  using Config        = std::map<std::string, std::string>;
+  using Effects       = std::unordered_map<std::string, Effect>;
 
-  Accounts accounts;
-  Config   config;
+  Accounts                  accounts;
+  Effects                   effects;
+  Effect                    default_effect;
+  KARMA                     refresh_amount = 0;
+  std::chrono::milliseconds refresh_interval;
+  Clock::time_point         start = Clock::now();
 
   AccountNumber GetAccountNumber(const AccountName &s);
 
@@ -78,9 +111,11 @@ private:
   bool              operator==(const KarmaPolicyBasic &other) = delete;
   bool              operator<(const KarmaPolicyBasic &other)  = delete;
 
-  std::vector<std::string> getPolicies(const std::string &action) const;
-  const std::string &      getPolicy(const std::string &action) const;
-  KARMA                    parseEffect(KARMA currentBalance, const std::string &effect);
-  KARMA                    afterwards(KARMA currentBalance, const std::string &actions);
-  std::string              getLessSpecificAction(const std::string &action) const;
+  TICKS         now() const;
+  KARMA         balance(State state, TICKS ticks) const;
+  const Effect &getEffect(const std::string &action) const;
+  static Effect parseEffect(const std::string &effect);
+  static KARMA  applyEffect(KARMA currentBalance, const Effect &effect);
+  KARMA         afterwards(KARMA currentBalance, const std::string &actions) const;
+  std::string   getLessSpecificAction(const std::string &action) const;
 };
@@ -43,6 +43,7 @@ public:
                           std::shared_ptr<OutboundConversations> outbounds)
     : IOefTaskFactory(std::move(outbounds))
     , agents_{std::move(agents)}
+    , agent_cache_{agents_}
     , agent_public_key_{std::move(agent_public_key)}
     , core_key_{std::move(core_key)}
     , query_id_distribution_()
@@ -66,6 +67,7 @@ private:
 
 private:
   std::shared_ptr<Agents> agents_;
+  Agents::Cache           agent_cache_;  ///< Peers of the conversations of this agent
   std::string             agent_public_key_;
   std::string             core_key_;
   QueryIdDistribution     query_id_distribution_;
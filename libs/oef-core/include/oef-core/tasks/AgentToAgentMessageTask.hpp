@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "logging/logging.hpp"
+#include "oef-base/proto_comms/ProtoArena.hpp"
 #include "oef-base/utils/OefUri.hpp"
 #include "oef-core/agents/Agent.hpp"
 #include "oef-core/agents/Agents.hpp"
@@ -34,18 +35,18 @@ public:
   using ProtoP   = std::shared_ptr<Proto>;
   using AgentP   = std::shared_ptr<Agent>;
   using AgentsP  = std::shared_ptr<Agents>;
+  using Cache    = Agents::Cache;
   using Message  = fetch::oef::pb::Server_AgentMessage;
   using MessageP = std::shared_ptr<Message>;
 
   static constexpr char const *LOGGING_NAME = "AgentToAgentMessageTask";
 
-  AgentToAgentMessageTask(AgentP const &sourceAgent, int32_t message_id, ProtoP pb,
-                          AgentsP const &agents)
+  AgentToAgentMessageTask(AgentP const &sourceAgent, int32_t message_id, ProtoP pb, Cache &agents)
     : pb_{std::move(pb)}
   {
     OEFURI::URI uri;
     uri.ParseAgent(pb_->destination());
-    agent_ = agents->find(uri.AgentKey);
+    agent_ = agents.find(uri.AgentKey);
 
     if (agent_ == nullptr)
     {
@@ -67,7 +68,7 @@ public:
 
   void create_message(int32_t message_id, OEFURI::URI const &uri, std::string const &public_key)
   {
-    message_pb_ = std::make_shared<Message>();
+    message_pb_ = MakeSiblingProto<Message>(pb_);
     int32_t did = pb_->dialogue_id();
     message_pb_->set_answer_id(message_id);
     message_pb_->set_source_uri(pb_->source_uri());
@@ -79,19 +80,20 @@ public:
     auto content = message_pb_->mutable_content();
     content->set_dialogue_id(did);
     content->set_origin(public_key);
+    // swapping within the arena of the request moves the payload without copying it
     if (pb_->has_content())
     {
-      content->set_allocated_content(pb_->release_content());
+      content->mutable_content()->swap(*pb_->mutable_content());
     }
     if (pb_->has_fipa())
     {
-      content->set_allocated_fipa(pb_->release_fipa());
+      content->mutable_fipa()->Swap(pb_->mutable_fipa());
     }
   }
 
   void create_dialouge_error(int32_t message_id)
   {
-    message_pb_ = std::make_shared<Message>();
+    message_pb_ = MakeSiblingProto<Message>(pb_);
     message_pb_->set_answer_id(message_id);
     auto *error = message_pb_->mutable_dialogue_error();
     error->set_dialogue_id(pb_->dialogue_id());
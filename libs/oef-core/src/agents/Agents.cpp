@@ -19,25 +19,110 @@
 #include "oef-core/agents/Agent.hpp"
 #include "oef-core/agents/Agents.hpp"
 
+#include <functional>
+#include <utility>
+
+Agents::Cache::Cache(std::shared_ptr<Agents> agents)
+  : agents(std::move(agents))
+{}
+
+std::shared_ptr<Agent> Agents::Cache::find(const std::string &key)
+{
+  auto iter = entries.find(key);
+  if (iter != entries.end())
+  {
+    auto agent = iter->second.lock();
+    if (agent && agent->connected())
+    {
+      return agent;
+    }
+    entries.erase(iter);
+  }
+
+  auto agent = agents->find(key);
+  if (!agent)
+  {
+    return agent;
+  }
+
+  if (entries.size() >= MAX_ENTRIES)
+  {
+    entries.clear();
+  }
+  entries.emplace(key, agent);
+  return agent;
+}
+
 void Agents::add(const std::string &key, std::shared_ptr<OefAgentEndpoint> endpoint)
 {
-  Lock lock(mutex);
-  agents[key] = std::make_shared<Agent>(key, endpoint);
+  auto  agent = std::make_shared<Agent>(key, std::move(endpoint));
+  auto &s     = shard(key);
+
+  AgentSP previous;
+  {
+    Lock lock(s.mutex);
+    auto agents = std::make_shared<Store>(*s.agents);
+    auto &entry = (*agents)[key];
+    previous    = std::move(entry);
+    entry       = std::move(agent);
+    std::atomic_store(&s.agents, StoreSP{std::move(agents)});
+  }
+
+  if (previous)
+  {
+    previous->disconnect();
+  }
 }
 
 void Agents::remove(const std::string &key)
 {
-  Lock lock(mutex);
-  agents.erase(key);
+  auto &s = shard(key);
+
+  AgentSP previous;
+  {
+    Lock lock(s.mutex);
+    auto iter = s.agents->find(key);
+    if (iter == s.agents->end())
+    {
+      return;
+    }
+    previous = iter->second;
+
+    auto agents = std::make_shared<Store>(*s.agents);
+    agents->erase(key);
+    std::atomic_store(&s.agents, StoreSP{std::move(agents)});
+  }
+
+  previous->disconnect();
 }
 
-std::shared_ptr<Agent> Agents::find(const std::string &key)
+std::shared_ptr<Agent> Agents::find(const std::string &key) const
 {
-  Lock lock(mutex);
-  auto iter = agents.find(key);
-  if (iter != agents.end())
+  auto agents = std::atomic_load(&shard(key).agents);
+  auto iter   = agents->find(key);
+  if (iter != agents->end())
   {
     return iter->second;
   }
   return std::shared_ptr<Agent>();
 }
+
+std::size_t Agents::size() const
+{
+  std::size_t count = 0;
+  for (auto const &s : shards)
+  {
+    count += std::atomic_load(&s.agents)->size();
+  }
+  return count;
+}
+
+Agents::Shard &Agents::shard(const std::string &key)
+{
+  return shards[std::hash<std::string>{}(key) % SHARDS];
+}
+
+Agents::Shard const &Agents::shard(const std::string &key) const
+{
+  return shards[std::hash<std::string>{}(key) % SHARDS];
+}
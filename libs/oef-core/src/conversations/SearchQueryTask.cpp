@@ -19,6 +19,7 @@
 #include "oef-base/conversation/OutboundConversation.hpp"
 #include "oef-base/conversation/OutboundConversations.hpp"
 #include "oef-base/monitoring/Counter.hpp"
+#include "oef-base/proto_comms/ProtoArena.hpp"
 #include "oef-base/utils/OefUri.hpp"
 #include "oef-base/utils/Uri.hpp"
 #include "oef-core/conversations/SearchQueryTask.hpp"
@@ -79,7 +80,7 @@ SearchQueryTask::StateResult SearchQueryTask::HandleResponse()
 
   auto response = std::static_pointer_cast<IdentifierSequence>(conversation->GetReply(0));
 
-  auto answer = std::make_shared<OUT_PROTO>();
+  auto answer = MakeSiblingProto<OUT_PROTO>(initiator);
   answer->set_answer_id(static_cast<int32_t>(msg_id_));
 
   if (!response->status().success())
@@ -177,7 +178,7 @@ SearchQueryTask::StateResult SearchQueryTask::HandleResponse()
 
 std::shared_ptr<SearchQueryTask::REQUEST_PROTO> SearchQueryTask::make_request_proto()
 {
-  auto search_query = std::make_shared<fetch::oef::pb::SearchQuery>();
+  auto search_query = MakeSiblingProto<fetch::oef::pb::SearchQuery>(initiator);
   search_query->set_source_key(core_key_);
   if (initiator->has_query_v2())
   {
@@ -19,6 +19,7 @@
 #include "oef-base/conversation/OutboundConversation.hpp"
 #include "oef-base/conversation/OutboundConversations.hpp"
 #include "oef-base/monitoring/Counter.hpp"
+#include "oef-base/proto_comms/ProtoArena.hpp"
 #include "oef-base/utils/OefUri.hpp"
 #include "oef-core/conversations/SearchRemoveTask.hpp"
 #include "oef-messages/dap_interface.hpp"
@@ -73,7 +74,7 @@ SearchRemoveTask::StateResult SearchRemoveTask::HandleResponse()
     {
       FETCH_LOG_WARN(LOGGING_NAME, "  ", n);
     }
-    std::shared_ptr<OUT_PROTO> answer = std::make_shared<OUT_PROTO>();
+    auto answer = MakeSiblingProto<OUT_PROTO>(initiator);
     answer->set_answer_id(static_cast<int32_t>(msg_id_));
     auto error = answer->mutable_oef_error();
     error->set_operation(fetch::oef::pb::Server_AgentMessage_OEFError::UNREGISTER_SERVICE);
@@ -102,7 +103,7 @@ SearchRemoveTask::StateResult SearchRemoveTask::HandleResponse()
 
 std::shared_ptr<SearchRemoveTask::REQUEST_PROTO> SearchRemoveTask::make_request_proto()
 {
-  auto remove = std::make_shared<fetch::oef::pb::Remove>();
+  auto remove = MakeSiblingProto<fetch::oef::pb::Remove>(initiator);
   remove->set_key(core_key_);
   remove->set_all(remove_row_);
   if (remove_row_)
@@ -19,6 +19,7 @@
 #include "oef-base/conversation/OutboundConversation.hpp"
 #include "oef-base/conversation/OutboundConversations.hpp"
 #include "oef-base/monitoring/Counter.hpp"
+#include "oef-base/proto_comms/ProtoArena.hpp"
 #include "oef-base/utils/OefUri.hpp"
 #include "oef-base/utils/Uri.hpp"
 #include "oef-core/conversations/SearchUpdateTask.hpp"
@@ -80,7 +81,7 @@ SearchUpdateTask::StateResult SearchUpdateTask::HandleResponse()
     {
       FETCH_LOG_WARN(LOGGING_NAME, "  ", n);
     }
-    auto answer = std::make_shared<OUT_PROTO>();
+    auto answer = MakeSiblingProto<OUT_PROTO>(initiator);
     answer->set_answer_id(static_cast<int32_t>(msg_id_));
     auto error = answer->mutable_oef_error();
     error->set_operation(fetch::oef::pb::Server_AgentMessage_OEFError::REGISTER_SERVICE);
@@ -107,7 +108,7 @@ SearchUpdateTask::StateResult SearchUpdateTask::HandleResponse()
 
 std::shared_ptr<SearchUpdateTask::REQUEST_PROTO> SearchUpdateTask::make_request_proto()
 {
-  auto update = std::make_shared<fetch::oef::pb::Update>();
+  auto update = MakeSiblingProto<fetch::oef::pb::Update>(initiator);
   update->set_key(core_key_);
   fetch::oef::pb::Update_DataModelInstance *dm = update->add_data_models();
   dm->set_key(agent_uri_);
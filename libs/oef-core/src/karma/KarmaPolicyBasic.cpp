@@ -21,60 +21,67 @@
 #include "oef-core/karma/XDisconnect.hpp"
 #include "oef-core/karma/XKarma.hpp"
 
-std::atomic<std::size_t> tick_amounts(0);
-std::atomic<std::size_t> tick_counter(0);
+#include <algorithm>
 
-static const std::size_t MAX_KARMA = 10000;
+namespace {
 
-KarmaPolicyBasic::Account::Account()
-  : karma(MAX_KARMA)
-  , when(0)
-{}
+constexpr int32_t MAX_KARMA = 10000;
 
-void KarmaPolicyBasic::Account::BringUpToDate()
+void tokenise(const std::string &input, std::vector<std::string> &output, const char delim)
 {
+  std::size_t start = 0;
+  std::size_t end   = 0;
+
   while (true)
   {
-    KARMA old_karma = karma;
-    TICKS tc        = tick_counter;
-    TICKS diff      = tc - when;
-    KARMA new_karma = static_cast<KARMA>(
-        std::min(static_cast<unsigned long>(karma) + diff * tick_amounts, MAX_KARMA));
-
-    // Write this as long as nothing has updated karma while we were thinking.
-    if (karma.compare_exchange_strong(old_karma, new_karma, std::memory_order_seq_cst))
+    start = input.find_first_not_of(delim, end);
+    if (start == std::string::npos)
     {
-      FETCH_LOG_INFO(LOGGING_NAME, "KARMA: Bring up to date: ticks=", diff, " step=", tick_amounts,
-                     " when=", when, " now=", tc, " old=", old_karma, " new=", new_karma);
-      when = tc;
-      break;
+      return;
     }
+    end = input.find(delim, start);  // could be npos.
+    output.push_back(input.substr(
+        start, end - start));  // npos - start is still a huge number, this gets the last token.
   }
 }
 
+}  // namespace
+
+constexpr std::chrono::milliseconds KarmaPolicyBasic::DEFAULT_REFRESH_INTERVAL;
+
+KarmaPolicyBasic::Account::Account()
+  : state(static_cast<uint32_t>(MAX_KARMA))
+{}
+
 std::string KarmaPolicyBasic::GetBalance(const KarmaAccount &identifier)
 {
-  return std::string("account=") + identifier.GetName() +
-         "  karma=" + std::to_string(accounts.access(*identifier).karma) + "/" +
+  return std::string("account=") + identifier.GetName() + "  karma=" +
+         std::to_string(balance(access(identifier).state, now())) + "/" +
          std::to_string(MAX_KARMA);
 }
 
-KarmaPolicyBasic::KarmaPolicyBasic(const google::protobuf::Map<std::string, std::string> &config)
+KarmaPolicyBasic::KarmaPolicyBasic(const google::protobuf::Map<std::string, std::string> &config,
+                                   std::chrono::milliseconds refresh_interval)
+  : refresh_interval(std::max(refresh_interval, std::chrono::milliseconds(1)))
 {
   accounts.get("(null karma account)");  // make sure the null account exists.
 
   for (auto &kv : config)
   {
-    this->config[kv.first] = kv.second;
+    effects[kv.first] = parseEffect(kv.second);
   }
-}
 
-void KarmaPolicyBasic::RefreshCycle(const std::chrono::milliseconds /*delta*/)
-{
-  auto policies = getPolicies("refresh");
-  tick_amounts  = static_cast<TICKS>(parseEffect(0, policies[0]));
-  // FETCH_LOG_INFO(LOGGING_NAME, "KARMA: refreshTick of size ", tick_amounts);
-  tick_counter++;
+  auto iter = effects.find("*");
+  if (iter != effects.end())
+  {
+    default_effect = iter->second;
+  }
+
+  auto const &refresh = getEffect("refresh");
+  if ((refresh.kind == Effect::Kind::ADD) && (refresh.amount > 0))
+  {
+    refresh_amount = refresh.amount;
+  }
 }
 
 std::size_t KarmaPolicyBasic::GetAccountNumber(const std::string &s)
@@ -115,42 +122,40 @@ const KarmaPolicyBasic::Account &KarmaPolicyBasic::access(const KarmaAccount &id
   return accounts.access(*identifier);
 }
 
-std::string zero("0");
+/**
+ * The number of refresh intervals since the policy was created
+ */
+KarmaPolicyBasic::TICKS KarmaPolicyBasic::now() const
+{
+  return static_cast<TICKS>((Clock::now() - start) / refresh_interval);
+}
 
-void tokenise(const std::string &input, std::vector<std::string> &output, const char delim)
+/**
+ * The balance of an account including the refreshes owed to it
+ *
+ * @param state The state of the account
+ * @param ticks The current refresh interval
+ * @return The balance
+ */
+KarmaPolicyBasic::KARMA KarmaPolicyBasic::balance(State state, TICKS ticks) const
 {
-  std::size_t start = 0;
-  std::size_t end   = 0;
+  auto const karma = static_cast<KARMA>(static_cast<uint32_t>(state));
+  auto const when  = static_cast<TICKS>(state >> 32u);
 
-  while (true)
-  {
-    start = input.find_first_not_of(delim, end);
-    if (start == std::string::npos)
-    {
-      return;
-    }
-    end = input.find(delim, start);  // could be npos.
-    output.push_back(input.substr(
-        start, end - start));  // npos - start is still a huge number, this gets the last token.
-  }
+  // unsigned arithmetic, the difference is correct across a wrap of the tick counter
+  auto const owed = static_cast<int64_t>(static_cast<TICKS>(ticks - when)) * refresh_amount;
+  return static_cast<KARMA>(std::min<int64_t>(karma + owed, MAX_KARMA));
 }
 
-std::vector<std::string> KarmaPolicyBasic::getPolicies(const std::string &action) const
+const KarmaPolicyBasic::Effect &KarmaPolicyBasic::getEffect(const std::string &action) const
 {
-  std::vector<std::string> actions;
-  tokenise(action, actions, ',');
-  if (actions.empty())
-  {
-    actions.emplace_back("*");
-  }
-
-  std::vector<std::string> policies;
-  for (auto const &a : actions)
+  auto iter = effects.find(action);
+  if (iter != effects.end())
   {
-    policies.push_back(getPolicy(a));
+    return iter->second;
   }
-
-  return policies;
+  FETCH_LOG_DEBUG(LOGGING_NAME, "KARMA:  Unknown Karma Event:", action);
+  return default_effect;
 }
 
 std::string KarmaPolicyBasic::getLessSpecificAction(const std::string &action) const
@@ -167,57 +172,15 @@ std::string KarmaPolicyBasic::getLessSpecificAction(const std::string &action) c
   return action.substr(0, r - 1);
 }
 
-const std::string &KarmaPolicyBasic::getPolicy(const std::string &action) const
+KarmaPolicyBasic::Effect KarmaPolicyBasic::parseEffect(const std::string &effect)
 {
-  Config::const_iterator iter;
-  if ((iter = config.find(action)) != config.end())
-  {
-    // FETCH_LOG_INFO(LOGGING_NAME, "KARMA: Karma Event:", action, " => ", iter -> second);
-    return iter->second;
-  }
-  if ((iter = config.find("*")) != config.end())
-  {
-    FETCH_LOG_INFO(LOGGING_NAME, "KARMA:  Unknown Karma Event:", action);
-    return iter->second;
-  }
-  FETCH_LOG_INFO(LOGGING_NAME, "KARMA:  No default karma event:", action);
-  return zero;
-}
-
-KarmaPolicyBasic::KARMA KarmaPolicyBasic::afterwards(KARMA              currentBalance,
-                                                     const std::string &actions)
-{
-  auto policies = getPolicies(actions);
-  auto worst    = currentBalance;
+  Effect result;
 
-  try
-  {
-    for (const auto &policy : policies)
-    {
-      auto result = parseEffect(currentBalance, policy);
-      FETCH_LOG_INFO(LOGGING_NAME, "KARMA: afterwards ", policy, "    ", currentBalance, " => ",
-                     result);
-      if (result < worst)
-      {
-        worst = result;
-      }
-    }
-  }
-  catch (XKarma const &x)
-  {
-    throw XKarma(std::string("actions:") + actions + " result in disconnect due to Karma policy");
-  }
-
-  return worst;
-}
-
-KarmaPolicyBasic::KARMA KarmaPolicyBasic::parseEffect(KARMA              currentBalance,
-                                                      const std::string &effect)
-{
-  switch (effect[0])
+  switch (effect.empty() ? '\0' : effect[0])
   {
   case 'X':
-    throw XDisconnect("Disconnect due to Karma policy");
+    result.kind = Effect::Kind::DISCONNECT;
+    break;
   case '0':
   case '1':
   case '2':
@@ -230,43 +193,93 @@ KarmaPolicyBasic::KARMA KarmaPolicyBasic::parseEffect(KARMA              current
   case '9':
   case '+':
   case '-':
-  {
-    KARMA delta = std::stoi(effect);
-    return currentBalance + delta;
-  }
+    result.kind   = Effect::Kind::ADD;
+    result.amount = std::stoi(effect);
+    break;
   case '=':
-    return std::stoi(effect.substr(1));
+    result.kind   = Effect::Kind::SET;
+    result.amount = std::stoi(effect.substr(1));
+    break;
   default:
-  {
     FETCH_LOG_INFO(LOGGING_NAME, "KARMA: Effect which can't be parsed:", effect);
+    break;
+  }
+
+  return result;
+}
+
+KarmaPolicyBasic::KARMA KarmaPolicyBasic::applyEffect(KARMA currentBalance, const Effect &effect)
+{
+  switch (effect.kind)
+  {
+  case Effect::Kind::DISCONNECT:
+    throw XDisconnect("Disconnect due to Karma policy");
+  case Effect::Kind::ADD:
+    return currentBalance + effect.amount;
+  case Effect::Kind::SET:
+    return effect.amount;
+  case Effect::Kind::NONE:
+  default:
     return currentBalance;
   }
-  };
 }
 
-bool KarmaPolicyBasic::perform(const KarmaAccount &identifier, const std::string &event, bool force)
+KarmaPolicyBasic::KARMA KarmaPolicyBasic::afterwards(KARMA              currentBalance,
+                                                     const std::string &actions) const
 {
-  accounts.access(*identifier).BringUpToDate();
-  KARMA prev = accounts.access(*identifier).karma;
-  KARMA next = afterwards(prev, event);
+  try
+  {
+    // the common case of a single action does not need to be split
+    if (actions.find(',') == std::string::npos)
+    {
+      return std::min(currentBalance,
+                      applyEffect(currentBalance, getEffect(actions.empty() ? "*" : actions)));
+    }
 
-  if (next >= 0 || force)
+    std::vector<std::string> names;
+    tokenise(actions, names, ',');
+
+    auto worst = currentBalance;
+    for (const auto &name : names)
+    {
+      worst = std::min(worst, applyEffect(currentBalance, getEffect(name)));
+    }
+    return worst;
+  }
+  catch (XKarma const &x)
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "KARMA: Event ", event, " for ", identifier.GetName(),
-                   " karma change ", prev, " => ", next);
-    accounts.access(*identifier).karma = next;
-    return true;
+    throw XKarma(std::string("actions:") + actions + " result in disconnect due to Karma policy");
   }
+}
+
+bool KarmaPolicyBasic::perform(const KarmaAccount &identifier, const std::string &event, bool force)
+{
+  auto &     account = access(identifier);
+  auto const ticks   = now();
+  State      state   = account.state.load();
+  KARMA      prev    = 0;
+  KARMA      next    = 0;
+
+  do
+  {
+    prev = balance(state, ticks);
+    next = afterwards(prev, event);
+
+    if ((next < 0) && !force)
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "KARMA: Event ", event, " for ", identifier.GetName(),
+                     " rejected because result karma = ", next);
+      throw XKarma(event);
+    }
+  } while (!account.state.compare_exchange_weak(
+      state, (static_cast<State>(ticks) << 32u) | static_cast<uint32_t>(next)));
 
-  FETCH_LOG_INFO(LOGGING_NAME, "KARMA: Event ", event, " for ", identifier.GetName(),
-                 " rejected because result karma = ", next);
-  throw XKarma(event);
+  FETCH_LOG_DEBUG(LOGGING_NAME, "KARMA: Event ", event, " for ", identifier.GetName(),
+                  " karma change ", prev, " => ", next);
+  return true;
 }
 
 bool KarmaPolicyBasic::CouldPerform(const KarmaAccount &identifier, const std::string &action)
 {
-  accounts.access(*identifier).BringUpToDate();
-  KARMA prev = accounts.access(*identifier).karma;
-  KARMA next = afterwards(prev, getPolicy(action));
-  return (next >= 0);
+  return afterwards(balance(access(identifier).state, now()), action) >= 0;
 }
@@ -21,6 +21,7 @@
 #include "logging/logging.hpp"
 #include "oef-base/conversation/OutboundConversations.hpp"
 #include "oef-base/monitoring/Counter.hpp"
+#include "oef-base/proto_comms/ProtoArena.hpp"
 #include "oef-base/proto_comms/TSendProtoTask.hpp"
 #include "oef-base/utils/Uri.hpp"
 #include "oef-core/conversations/SearchConversationTask.hpp"
@@ -63,14 +64,15 @@ void OefFunctionsTaskFactory::EndpointClosed()
 
 void OefFunctionsTaskFactory::ProcessMessage(ConstCharArrayBuffer &data)
 {
-  auto envelope = fetch::oef::pb::Envelope();
-  IOefTaskFactory::read(envelope, data, data.size - data.current);
+  // every message of the request is allocated on the arena of the envelope
+  auto envelope = MakeArenaProto<fetch::oef::pb::Envelope>(NewProtoArena());
+  IOefTaskFactory::read(*envelope, data, data.size - data.current);
 
-  auto    payload_case = envelope.payload_case();
-  int32_t msg_id       = envelope.msg_id();
+  auto    payload_case = envelope->payload_case();
+  int32_t msg_id       = envelope->msg_id();
 
   OEFURI::URI uri;
-  uri.parse(envelope.agent_uri());
+  uri.parse(envelope->agent_uri());
   uri.AgentKey = agent_public_key_;
 
   fetch::oef::pb::Server_AgentMessage_OEFError_Operation operation_code =
@@ -100,10 +102,10 @@ void OefFunctionsTaskFactory::ProcessMessage(ConstCharArrayBuffer &data)
       operation_code = fetch::oef::pb::Server_AgentMessage_OEFError_Operation_SEND_MESSAGE;
       FETCH_LOG_INFO(LOGGING_NAME, "kSendMessage");
       GetEndpoint()->karma.perform("oef.kSendMessage");
-      std::shared_ptr<fetch::oef::pb::Agent_Message> msg_ptr(envelope.release_send_message());
+      auto msg_ptr = ShareSubProto(envelope, envelope->mutable_send_message());
       FETCH_LOG_INFO(LOGGING_NAME, "Got agent message: ", msg_ptr->DebugString());
       auto senderTask = std::make_shared<AgentToAgentMessageTask<fetch::oef::pb::Agent_Message>>(
-          agents_->find(agent_public_key_), msg_id, msg_ptr, agents_);
+          agent_cache_.find(agent_public_key_), msg_id, msg_ptr, agent_cache_);
       senderTask->submit();
       break;
     }
@@ -112,10 +114,11 @@ void OefFunctionsTaskFactory::ProcessMessage(ConstCharArrayBuffer &data)
     {
       operation_code = fetch::oef::pb::Server_AgentMessage_OEFError_Operation_REGISTER_SERVICE;
       GetEndpoint()->karma.perform("oef.kRegisterService");
-      FETCH_LOG_INFO(LOGGING_NAME, "kRegisterService", envelope.register_service().DebugString());
+      FETCH_LOG_INFO(LOGGING_NAME, "kRegisterService",
+                     envelope->register_service().DebugString());
       auto convTask = std::make_shared<SearchUpdateTask>(
-          std::shared_ptr<fetch::oef::pb::AgentDescription>(envelope.release_register_service()),
-          outbounds, GetEndpoint(), envelope.msg_id(), core_key_, uri.AgentPartAsString());
+          ShareSubProto(envelope, envelope->mutable_register_service()), outbounds, GetEndpoint(),
+          envelope->msg_id(), core_key_, uri.AgentPartAsString());
       convTask->SetDefaultSendReplyFunc(LOGGING_NAME, "kRegisterService REPLY ");
       convTask->submit();
       break;
@@ -125,10 +128,10 @@ void OefFunctionsTaskFactory::ProcessMessage(ConstCharArrayBuffer &data)
       operation_code = fetch::oef::pb::Server_AgentMessage_OEFError_Operation_UNREGISTER_SERVICE;
       GetEndpoint()->karma.perform("oef.kUnregisterService");
       FETCH_LOG_INFO(LOGGING_NAME, "kUnregisterService",
-                     envelope.unregister_service().DebugString());
+                     envelope->unregister_service().DebugString());
       auto convTask = std::make_shared<SearchRemoveTask>(
-          std::shared_ptr<fetch::oef::pb::AgentDescription>(envelope.release_unregister_service()),
-          outbounds, GetEndpoint(), envelope.msg_id(), core_key_, uri.AgentPartAsString());
+          ShareSubProto(envelope, envelope->mutable_unregister_service()), outbounds, GetEndpoint(),
+          envelope->msg_id(), core_key_, uri.AgentPartAsString());
       convTask->SetDefaultSendReplyFunc(LOGGING_NAME, "kUnregisterService REPLY ");
       convTask->submit();
       break;
@@ -137,11 +140,10 @@ void OefFunctionsTaskFactory::ProcessMessage(ConstCharArrayBuffer &data)
     {
       operation_code = fetch::oef::pb::Server_AgentMessage_OEFError_Operation_SEARCH_AGENTS;
       GetEndpoint()->karma.perform("oef.kSearchAgents");
-      FETCH_LOG_INFO(LOGGING_NAME, "kSearchAgents", envelope.search_agents().DebugString());
+      FETCH_LOG_INFO(LOGGING_NAME, "kSearchAgents", envelope->search_agents().DebugString());
       auto convTask = std::make_shared<SearchQueryTask>(
-          std::shared_ptr<fetch::oef::pb::AgentSearch>(envelope.release_search_agents()), outbounds,
-          GetEndpoint(), envelope.msg_id(), core_key_, uri.ToString(), 1,
-          query_id_distribution_(random_engine_));
+          ShareSubProto(envelope, envelope->mutable_search_agents()), outbounds, GetEndpoint(),
+          envelope->msg_id(), core_key_, uri.ToString(), 1, query_id_distribution_(random_engine_));
       convTask->SetDefaultSendReplyFunc(LOGGING_NAME, "kSearchAgents ");
       convTask->submit();
       break;
@@ -150,11 +152,10 @@ void OefFunctionsTaskFactory::ProcessMessage(ConstCharArrayBuffer &data)
     {
       operation_code = fetch::oef::pb::Server_AgentMessage_OEFError_Operation_SEARCH_SERVICES;
       GetEndpoint()->karma.perform("oef.kSearchServices");
-      FETCH_LOG_INFO(LOGGING_NAME, "kSearchServices", envelope.search_services().DebugString());
+      FETCH_LOG_INFO(LOGGING_NAME, "kSearchServices", envelope->search_services().DebugString());
       auto convTask = std::make_shared<SearchQueryTask>(
-          std::shared_ptr<fetch::oef::pb::AgentSearch>(envelope.release_search_services()),
-          outbounds, GetEndpoint(), envelope.msg_id(), core_key_, uri.ToString(), 1,
-          query_id_distribution_(random_engine_));
+          ShareSubProto(envelope, envelope->mutable_search_services()), outbounds, GetEndpoint(),
+          envelope->msg_id(), core_key_, uri.ToString(), 1, query_id_distribution_(random_engine_));
       convTask->SetDefaultSendReplyFunc(LOGGING_NAME, "kSearchServices ");
       convTask->submit();
       break;
@@ -164,10 +165,10 @@ void OefFunctionsTaskFactory::ProcessMessage(ConstCharArrayBuffer &data)
       operation_code = fetch::oef::pb::Server_AgentMessage_OEFError_Operation_SEARCH_SERVICES_WIDE;
       GetEndpoint()->karma.perform("oef.kSearchServicesWide");
       FETCH_LOG_INFO(LOGGING_NAME, "kSearchServicesWide",
-                     envelope.search_services_wide().DebugString());
+                     envelope->search_services_wide().DebugString());
       auto convTask = std::make_shared<SearchQueryTask>(
-          std::shared_ptr<fetch::oef::pb::AgentSearch>(envelope.release_search_services_wide()),
-          outbounds, GetEndpoint(), envelope.msg_id(), core_key_, uri.ToString(), 4,
+          ShareSubProto(envelope, envelope->mutable_search_services_wide()), outbounds,
+          GetEndpoint(), envelope->msg_id(), core_key_, uri.ToString(), 4,
           query_id_distribution_(random_engine_));
       convTask->SetDefaultSendReplyFunc(LOGGING_NAME, "kSearchServicesWide ");
       convTask->submit();
@@ -186,7 +187,7 @@ void OefFunctionsTaskFactory::ProcessMessage(ConstCharArrayBuffer &data)
   {
     FETCH_LOG_INFO(LOGGING_NAME, "XERROR! ", x.what());
 
-    auto error_response = std::make_shared<fetch::oef::pb::Server_AgentMessage>();
+    auto error_response = MakeSiblingProto<fetch::oef::pb::Server_AgentMessage>(envelope);
     error_response->set_answer_id(msg_id);
     int failure = operation_code;
     error_response->mutable_oef_error()->set_operation(
@@ -204,7 +205,7 @@ void OefFunctionsTaskFactory::ProcessMessage(ConstCharArrayBuffer &data)
   {
     FETCH_LOG_INFO(LOGGING_NAME, "XKARMA! ", x.what());
 
-    auto error_response = std::make_shared<fetch::oef::pb::Server_AgentMessage>();
+    auto error_response = MakeSiblingProto<fetch::oef::pb::Server_AgentMessage>(envelope);
     error_response->set_answer_id(msg_id);
     int failure = operation_code;
     error_response->mutable_oef_error()->set_operation(
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-core/agents/Agent.hpp"
+#include "oef-core/agents/Agents.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// the registry never uses the endpoints of the agents itself
+std::shared_ptr<OefAgentEndpoint> const NO_ENDPOINT{};
+
+std::string AgentKey(std::size_t index)
+{
+  return "agent" + std::to_string(index);
+}
+
+TEST(AgentsTests, AddedAgentsAreFound)
+{
+  Agents agents{};
+
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    agents.add(AgentKey(i), NO_ENDPOINT);
+  }
+
+  EXPECT_EQ(agents.size(), 200);
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    auto agent = agents.find(AgentKey(i));
+    ASSERT_TRUE(agent);
+    EXPECT_EQ(agent->getPublicKey(), AgentKey(i));
+    EXPECT_TRUE(agent->connected());
+  }
+
+  EXPECT_FALSE(agents.find("unknown"));
+}
+
+TEST(AgentsTests, RemovedAgentsAreDisconnected)
+{
+  Agents agents{};
+  agents.add("agent", NO_ENDPOINT);
+
+  auto agent = agents.find("agent");
+  agents.remove("agent");
+
+  EXPECT_FALSE(agents.find("agent"));
+  EXPECT_FALSE(agent->connected());
+  EXPECT_EQ(agents.size(), 0);
+
+  // removing an unknown agent has no effect
+  agents.remove("agent");
+  EXPECT_EQ(agents.size(), 0);
+}
+
+TEST(AgentsTests, ReplacedAgentsAreDisconnected)
+{
+  Agents agents{};
+  agents.add("agent", NO_ENDPOINT);
+
+  auto previous = agents.find("agent");
+  agents.add("agent", NO_ENDPOINT);
+
+  auto current = agents.find("agent");
+  EXPECT_NE(previous, current);
+  EXPECT_FALSE(previous->connected());
+  EXPECT_TRUE(current->connected());
+  EXPECT_EQ(agents.size(), 1);
+}
+
+TEST(AgentsTests, CacheDropsAgentsThatHaveLeft)
+{
+  auto agents = std::make_shared<Agents>();
+  agents->add("agent", NO_ENDPOINT);
+
+  Agents::Cache cache{agents};
+
+  auto first = cache.find("agent");
+  ASSERT_TRUE(first);
+  EXPECT_EQ(cache.find("agent"), first);
+
+  // the cached entry is not returned once its agent has been removed
+  agents->remove("agent");
+  EXPECT_FALSE(cache.find("agent"));
+
+  // nor once it has reconnected, the new connection is looked up instead
+  agents->add("agent", NO_ENDPOINT);
+  auto second = cache.find("agent");
+  ASSERT_TRUE(second);
+  EXPECT_NE(second, first);
+
+  agents->add("agent", NO_ENDPOINT);
+  auto third = cache.find("agent");
+  EXPECT_NE(third, second);
+  EXPECT_EQ(third, agents->find("agent"));
+}
+
+TEST(AgentsTests, CacheKeepsWorkingWhenFull)
+{
+  auto agents = std::make_shared<Agents>();
+
+  Agents::Cache cache{agents};
+  for (std::size_t i = 0; i < Agents::Cache::MAX_ENTRIES * 2; ++i)
+  {
+    agents->add(AgentKey(i), NO_ENDPOINT);
+    EXPECT_EQ(cache.find(AgentKey(i)), agents->find(AgentKey(i)));
+  }
+
+  EXPECT_EQ(cache.find(AgentKey(0)), agents->find(AgentKey(0)));
+}
+
+TEST(AgentsTests, LookupsRunConcurrentlyWithUpdates)
+{
+  constexpr std::size_t NUM_AGENTS = 256;
+
+  Agents agents{};
+  for (std::size_t i = 0; i < NUM_AGENTS; ++i)
+  {
+    agents.add(AgentKey(i), NO_ENDPOINT);
+  }
+
+  std::atomic<bool>        running{true};
+  std::atomic<std::size_t> missing{0};
+
+  // the even agents are never touched, so they must always be found
+  std::vector<std::thread> readers;
+  for (std::size_t t = 0; t < 3; ++t)
+  {
+    readers.emplace_back([&agents, &running, &missing]() {
+      while (running)
+      {
+        for (std::size_t i = 0; i < NUM_AGENTS; i += 2)
+        {
+          if (!agents.find(AgentKey(i)))
+          {
+            ++missing;
+          }
+        }
+      }
+    });
+  }
+
+  for (std::size_t round = 0; round < 50; ++round)
+  {
+    for (std::size_t i = 1; i < NUM_AGENTS; i += 2)
+    {
+      agents.remove(AgentKey(i));
+      agents.add(AgentKey(i), NO_ENDPOINT);
+    }
+  }
+
+  running = false;
+  for (auto &reader : readers)
+  {
+    reader.join();
+  }
+
+  EXPECT_EQ(missing, 0);
+  EXPECT_EQ(agents.size(), NUM_AGENTS);
+}
+
+}  // namespace
@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-core/karma/KarmaPolicyBasic.hpp"
+#include "oef-core/karma/XDisconnect.hpp"
+#include "oef-core/karma/XKarma.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Config = google::protobuf::Map<std::string, std::string>;
+
+constexpr int MAX_KARMA = 10000;
+
+class KarmaPolicyBasicTests : public ::testing::Test
+{
+protected:
+  void Create(std::chrono::milliseconds refresh_interval = std::chrono::milliseconds{60000})
+  {
+    policy_ = std::make_unique<KarmaPolicyBasic>(config_, refresh_interval);
+  }
+
+  int Balance(KarmaAccount const &account)
+  {
+    auto const text = policy_->GetBalance(account);
+    auto const pos  = text.find("karma=");
+
+    return std::stoi(text.substr(pos + 6));
+  }
+
+  Config                            config_;
+  std::unique_ptr<KarmaPolicyBasic> policy_;
+};
+
+TEST_F(KarmaPolicyBasicTests, NewAccountsStartFull)
+{
+  Create();
+
+  auto account = policy_->GetAccount("key");
+  EXPECT_EQ(Balance(account), MAX_KARMA);
+  EXPECT_EQ(account.GetName(), "key");
+}
+
+TEST_F(KarmaPolicyBasicTests, ActionsAreChargedUntilTheBalanceWouldGoNegative)
+{
+  config_["login"] = "-4000";
+  Create();
+
+  auto account = policy_->GetAccount("key");
+  EXPECT_TRUE(policy_->perform(account, "login"));
+  EXPECT_TRUE(policy_->perform(account, "login"));
+  EXPECT_EQ(Balance(account), 2000);
+
+  EXPECT_FALSE(policy_->CouldPerform(account, "login"));
+  EXPECT_THROW(policy_->perform(account, "login"), XKarma);
+  EXPECT_EQ(Balance(account), 2000);
+
+  // a forced action is applied regardless
+  EXPECT_TRUE(policy_->perform(account, "login", true));
+  EXPECT_EQ(Balance(account), -2000);
+}
+
+TEST_F(KarmaPolicyBasicTests, AccountsAreIndependent)
+{
+  config_["login"] = "-4000";
+  Create();
+
+  auto first  = policy_->GetAccount("first");
+  auto second = policy_->GetAccount("", "10.0.0.1");
+
+  policy_->perform(first, "login");
+  EXPECT_EQ(Balance(first), 6000);
+  EXPECT_EQ(Balance(second), MAX_KARMA);
+
+  // the same key maps to the same account
+  EXPECT_EQ(Balance(policy_->GetAccount("first")), 6000);
+}
+
+TEST_F(KarmaPolicyBasicTests, ConfiguredEffectsAreApplied)
+{
+  config_["reset"] = "=250";
+  config_["kick"]  = "X";
+  config_["*"]     = "-1";
+  Create();
+
+  auto account = policy_->GetAccount("key");
+
+  policy_->perform(account, "reset");
+  EXPECT_EQ(Balance(account), 250);
+
+  // unknown actions use the default effect
+  policy_->perform(account, "unknown");
+  EXPECT_EQ(Balance(account), 249);
+
+  EXPECT_THROW(policy_->perform(account, "kick"), XDisconnect);
+}
+
+TEST_F(KarmaPolicyBasicTests, TheWorstOfSeveralActionsIsApplied)
+{
+  config_["cheap"] = "-10";
+  config_["dear"]  = "-1000";
+  Create();
+
+  auto account = policy_->GetAccount("key");
+  policy_->perform(account, "cheap,dear");
+  EXPECT_EQ(Balance(account), MAX_KARMA - 1000);
+}
+
+TEST_F(KarmaPolicyBasicTests, RefreshIsCreditedOncePerInterval)
+{
+  constexpr std::chrono::milliseconds INTERVAL{200};
+
+  config_["refresh"] = "+100";
+  config_["drain"]   = "=0";
+  Create(INTERVAL);
+
+  auto account = policy_->GetAccount("key");
+
+  auto const start = std::chrono::steady_clock::now();
+  policy_->perform(account, "drain");
+  EXPECT_LE(Balance(account), 100);
+
+  std::this_thread::sleep_for(INTERVAL * 3);
+
+  // at least three interval boundaries have been crossed since the account was drained
+  auto const balance = Balance(account);
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+  auto const crossed = static_cast<int>(elapsed / INTERVAL) + 1;
+
+  EXPECT_GE(balance, 300);
+  EXPECT_LE(balance, crossed * 100);
+}
+
+TEST_F(KarmaPolicyBasicTests, RefreshDoesNotOverflowTheBucket)
+{
+  constexpr std::chrono::milliseconds INTERVAL{1};
+
+  config_["refresh"] = "+5000";
+  config_["spend"]   = "-6000";
+  Create(INTERVAL);
+
+  auto account = policy_->GetAccount("key");
+  policy_->perform(account, "spend");
+
+  std::this_thread::sleep_for(INTERVAL * 50);
+
+  // many refreshes are owed, but the balance is capped at the maximum
+  EXPECT_EQ(Balance(account), MAX_KARMA);
+  EXPECT_TRUE(policy_->perform(account, "spend"));
+}
+
+TEST_F(KarmaPolicyBasicTests, ConcurrentActionsAreAllCharged)
+{
+  constexpr std::size_t NUM_THREADS = 4;
+  constexpr std::size_t NUM_ACTIONS = 1000;
+
+  config_["act"] = "-1";
+  Create();
+
+  auto account = policy_->GetAccount("key");
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([this, account]() {
+      for (std::size_t j = 0; j < NUM_ACTIONS; ++j)
+      {
+        policy_->perform(account, "act");
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(Balance(account), MAX_KARMA - static_cast<int>(NUM_THREADS * NUM_ACTIONS));
+}
+
+}  // namespace
@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-search/dap_manager/GeoIndex.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NUM_QUERIES = 1024;
+
+struct Agent
+{
+  std::string key;
+  GeoPoint    point;
+};
+
+std::vector<GeoPoint> RandomPoints(std::size_t count, uint64_t seed)
+{
+  std::mt19937_64                        rng{seed};
+  std::uniform_real_distribution<double> lat{-90.0, 90.0};
+  std::uniform_real_distribution<double> lon{-180.0, 180.0};
+
+  std::vector<GeoPoint> points(count);
+  for (auto &point : points)
+  {
+    point = GeoPoint{lat(rng), lon(rng)};
+  }
+  return points;
+}
+
+std::vector<Agent> RandomAgents(std::size_t count)
+{
+  auto const points = RandomPoints(count, 42);
+
+  std::vector<Agent> agents(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    agents[i] = Agent{"agent" + std::to_string(i), points[i]};
+  }
+  return agents;
+}
+
+void GeoIndex_Insert(benchmark::State &state)
+{
+  auto const agents = RandomAgents(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    GeoIndex index{};
+    for (auto const &agent : agents)
+    {
+      index.Insert(agent.key, agent.point);
+    }
+    benchmark::DoNotOptimize(index.size());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void GeoIndex_WithinRadius(benchmark::State &state)
+{
+  auto const agents  = RandomAgents(static_cast<std::size_t>(state.range(0)));
+  auto const centres = RandomPoints(NUM_QUERIES, 7);
+  auto const radius  = static_cast<double>(state.range(1));
+
+  GeoIndex index{};
+  for (auto const &agent : agents)
+  {
+    index.Insert(agent.key, agent.point);
+  }
+
+  std::size_t query   = 0;
+  std::size_t results = 0;
+  for (auto _ : state)
+  {
+    index.WithinRadius(centres[query++ % NUM_QUERIES], radius,
+                       [&results](GeoIndex::Key const &, double) { ++results; });
+  }
+
+  state.counters["results"] =
+      static_cast<double>(results) / static_cast<double>(state.iterations());
+}
+
+void GeoIndex_WithinBox(benchmark::State &state)
+{
+  auto const agents  = RandomAgents(static_cast<std::size_t>(state.range(0)));
+  auto const corners = RandomPoints(NUM_QUERIES, 7);
+  auto const size    = static_cast<double>(state.range(1));
+
+  GeoIndex index{};
+  for (auto const &agent : agents)
+  {
+    index.Insert(agent.key, agent.point);
+  }
+
+  std::size_t query   = 0;
+  std::size_t results = 0;
+  for (auto _ : state)
+  {
+    auto const &corner = corners[query++ % NUM_QUERIES];
+    index.WithinBox(corner, GeoPoint{std::min(corner.lat + size, 90.0), corner.lon + size},
+                    [&results](GeoIndex::Key const &, GeoPoint const &) { ++results; });
+  }
+
+  state.counters["results"] =
+      static_cast<double>(results) / static_cast<double>(state.iterations());
+}
+
+/**
+ * Reference: the linear filter a remote geo DAP applies to every advertisement
+ */
+void LinearScan_WithinRadius(benchmark::State &state)
+{
+  auto const agents  = RandomAgents(static_cast<std::size_t>(state.range(0)));
+  auto const centres = RandomPoints(NUM_QUERIES, 7);
+  auto const radius  = static_cast<double>(state.range(1));
+
+  std::size_t query   = 0;
+  std::size_t results = 0;
+  for (auto _ : state)
+  {
+    auto const &centre = centres[query++ % NUM_QUERIES];
+    for (auto const &agent : agents)
+    {
+      if (GreatCircleDistance(centre, agent.point) <= radius)
+      {
+        ++results;
+      }
+    }
+  }
+
+  state.counters["results"] =
+      static_cast<double>(results) / static_cast<double>(state.iterations());
+}
+
+}  // namespace
+
+// number of agents, radius in km
+BENCHMARK(GeoIndex_Insert)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(GeoIndex_WithinRadius)->Ranges({{1 << 20, 1 << 22}, {10, 1000}});
+BENCHMARK(LinearScan_WithinRadius)->Args({1 << 20, 10})->Unit(benchmark::kMillisecond);
+
+// number of agents, size of the box in degrees
+BENCHMARK(GeoIndex_WithinBox)->Ranges({{1 << 20, 1 << 22}, {1, 8}});
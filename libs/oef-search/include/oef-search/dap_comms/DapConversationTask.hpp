@@ -24,18 +24,16 @@
 #include "oef-base/conversation/OutboundConversation.hpp"
 #include "oef-base/conversation/OutboundConversations.hpp"
 #include "oef-base/monitoring/Counter.hpp"
+#include "oef-base/threading/CoroutineTask.hpp"
 #include "oef-base/threading/ExitState.hpp"
-#include "oef-base/threading/StateMachineTask.hpp"
 #include "oef-base/utils/Uri.hpp"
 
 template <typename IN_PROTO, typename OUT_PROTO>
-class DapConversationTask
-  : virtual public fetch::oef::base::StateMachineTask<DapConversationTask<IN_PROTO, OUT_PROTO>>,
-    virtual public fetch::oef::base::Waitable
+class DapConversationTask : virtual public fetch::oef::base::CoroutineTask,
+                            virtual public fetch::oef::base::Waitable
 {
 public:
-  using StateResult = typename fetch::oef::base::StateMachineTask<DapConversationTask>::Result;
-  using EntryPoint  = typename fetch::oef::base::StateMachineTask<DapConversationTask>::EntryPoint;
+  using ExitState      = fetch::oef::base::ExitState;
   using MessageHandler = std::function<void(std::shared_ptr<OUT_PROTO>)>;
   using ErrorHandler =
       std::function<void(const std::string &, const std::string &, const std::string &)>;
@@ -47,18 +45,13 @@ public:
                       std::shared_ptr<IN_PROTO>              initiator,
                       std::shared_ptr<OutboundConversations> outbounds,
                       std::string const &                    protocol = "dap")
-    : fetch::oef::base::StateMachineTask<SelfType>(this, nullptr)
-    , initiator(std::move(initiator))
+    : initiator(std::move(initiator))
     , outbounds(std::move(outbounds))
     , dap_name_{std::move(dap_name)}
     , path_{std::move(path)}
     , msg_id_(msg_id)
     , protocol_{std::move(protocol)}
   {
-    entryPoint.push_back(&SelfType::CreateConversation);
-    entryPoint.push_back(&SelfType::HandleResponse);
-    this->entrypoints = entryPoint.data();
-    this->state       = this->entrypoints[0];
     FETCH_LOG_INFO(LOGGING_NAME, "DAP Conv task created: ", dap_name_, ", id=", this->GetTaskId());
     task_created =
         std::make_shared<Counter>("mt-search.dap." + dap_name_ + "." + path_ + ".created");
@@ -85,7 +78,23 @@ public:
     FETCH_LOG_INFO(LOGGING_NAME, "Task gone, id=", this->GetTaskId());
   }
 
-  StateResult CreateConversation()
+  ExitState Resume() override
+  {
+    FETCH_CO_BEGIN();
+
+    if (!CreateConversation())
+    {
+      return fetch::oef::base::ERRORED;
+    }
+
+    FETCH_CO_AWAIT(*conversation);
+
+    return HandleResponse();
+
+    FETCH_CO_END();
+  }
+
+  bool CreateConversation()
   {
     try
     {
@@ -100,25 +109,7 @@ public:
 
       FETCH_LOG_INFO(LOGGING_NAME, "Conversation created with ", uri.ToString());
 
-      auto this_sp = this->template shared_from_base<DapConversationTask>();
-      std::weak_ptr<fetch::oef::base::Task> this_wp = this_sp;
-
-      if (conversation->MakeNotification()
-              .Then([this_wp]() {
-                auto sp = this_wp.lock();
-                if (sp)
-                {
-                  sp->MakeRunnable();
-                }
-              })
-              .Waiting())
-      {
-        FETCH_LOG_INFO(LOGGING_NAME, "Sleeping (id=", this->GetTaskId(), ", uri=", uri.ToString(),
-                       ")");
-        return DapConversationTask::StateResult(1, fetch::oef::base::DEFER);
-      }
-      FETCH_LOG_INFO(LOGGING_NAME, "NOT Sleeping (", uri.ToString(), ")");
-      return DapConversationTask::StateResult(1, fetch::oef::base::COMPLETE);
+      return true;
     }
     catch (std::exception const &e)
     {
@@ -131,11 +122,11 @@ public:
                      std::string{"Exception in creating conversation: "} + e.what());
       }
       wake();
-      return DapConversationTask::StateResult(0, fetch::oef::base::ERRORED);
+      return false;
     }
   }
 
-  virtual StateResult HandleResponse()
+  virtual ExitState HandleResponse()
   {
     FETCH_LOG_INFO(LOGGING_NAME, "Woken (", dap_name_, ")");
     FETCH_LOG_INFO(LOGGING_NAME, "Response from ", dap_name_, ": ",
@@ -149,7 +140,7 @@ public:
         errorHandler(dap_name_, path_, "No response");
       }
       wake();
-      return DapConversationTask::StateResult(0, fetch::oef::base::ERRORED);
+      return fetch::oef::base::ERRORED;
     }
 
     auto resp = conversation->GetReply(0);
@@ -162,7 +153,7 @@ public:
         errorHandler(dap_name_, path_, "nullptr as reply");
       }
       wake();
-      return DapConversationTask::StateResult(0, fetch::oef::base::ERRORED);
+      return fetch::oef::base::ERRORED;
     }
     auto response = std::static_pointer_cast<OUT_PROTO>(resp);
     if (messageHandler)
@@ -179,12 +170,12 @@ public:
         errorHandler(dap_name_, path_, "no messageHandler");
       }
       wake();
-      return DapConversationTask::StateResult(0, fetch::oef::base::ERRORED);
+      return fetch::oef::base::ERRORED;
     }
 
     FETCH_LOG_INFO(LOGGING_NAME, "COMPLETE (", dap_name_, ")");
 
-    return DapConversationTask::StateResult(0, fetch::oef::base::COMPLETE);
+    return fetch::oef::base::COMPLETE;
   }
 
   virtual void SetMessageHandler(MessageHandler mH)
@@ -213,8 +204,6 @@ protected:
   std::shared_ptr<Counter> task_errored;
   std::shared_ptr<Counter> task_succeeded;
 
-  std::vector<EntryPoint> entryPoint;
-
 private:
   DapConversationTask(const DapConversationTask &other) = delete;  // { copy(other); }
   DapConversationTask &operator                         =(const DapConversationTask &other) =
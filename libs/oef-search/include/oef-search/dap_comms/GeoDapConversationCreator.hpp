@@ -0,0 +1,68 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <memory>
+#include <string>
+
+#include "oef-base/conversation/IOutboundConversationCreator.hpp"
+#include "oef-base/utils/Uri.hpp"
+#include "oef-messages/dap_interface.hpp"
+#include "oef-search/dap_manager/GeoIndex.hpp"
+
+/**
+ * A built-in DAP which keeps the locations of the agents in a GeoIndex inside the search process.
+ * It is registered with the OutboundConversations like any remote DAP and answers every request
+ * immediately, without a network round trip.
+ *
+ * The DAP serves a "location" field of type "location". Locations are ValueMessages with the
+ * typecode "location", holding the latitude and longitude in degrees (in that order) in `l`.
+ * Constraints use the operator "WITHIN" and either
+ *   - a centre in `l` and a radius in kilometres in `d`, or
+ *   - the south western and north eastern corners of a bounding box in `v_l`.
+ */
+class GeoDapConversationCreator : public IOutboundConversationCreator
+{
+public:
+  using Lock = IOutboundConversationCreator::Lock;
+  using IOutboundConversationCreator::mutex_;
+
+  static constexpr char const *LOGGING_NAME = "GeoDapConversationCreator";
+
+  explicit GeoDapConversationCreator(std::string dap_name);
+  ~GeoDapConversationCreator() override = default;
+
+  std::shared_ptr<OutboundConversation> start(
+      const Uri &target_path, std::shared_ptr<google::protobuf::Message> initiator) override;
+
+private:
+  std::shared_ptr<DapDescription> Describe() const;
+  std::shared_ptr<Successfulness> Update(ConstructQueryConstraintObjectRequest const &request);
+  std::shared_ptr<Successfulness> Remove(ConstructQueryConstraintObjectRequest const &request);
+
+  std::shared_ptr<ConstructQueryMementoResponse> PrepareConstraint(
+      ConstructQueryConstraintObjectRequest const &request) const;
+  std::shared_ptr<ConstructQueryConstraintObjectRequest> Calculate(
+      ConstructQueryConstraintObjectRequest const &request) const;
+
+  std::shared_ptr<IdentifierSequence> Execute(DapExecute const &request) const;
+
+  std::string dap_name_;
+  std::size_t ident_{1};
+  GeoIndex    index_{};
+};
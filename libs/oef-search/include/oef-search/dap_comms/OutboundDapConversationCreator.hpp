@@ -20,6 +20,9 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "oef-base/conversation/IOutboundConversationCreator.hpp"
 #include "oef-base/conversation/OutboundConversations.hpp"
@@ -42,13 +45,28 @@ public:
   std::shared_ptr<OutboundConversation> start(
       const Uri &target_path, std::shared_ptr<google::protobuf::Message> initiator) override;
 
+  void HandleMessage(unsigned long id, const Uri &uri,
+                     ConstCharArrayBuffer const &buffer) const override;
+  void HandleError(unsigned long id, const Uri &uri, int status_code,
+                   const std::string &message) const override;
+
 protected:
 private:
   static constexpr char const *LOGGING_NAME = "OutboundDapConversationCreator";
-  using TXType = std::pair<Uri, std::shared_ptr<google::protobuf::Message>>;
+  using TXType        = std::pair<Uri, std::shared_ptr<google::protobuf::Message>>;
+  using Conversations = std::vector<std::shared_ptr<OutboundConversation>>;
+
+  std::shared_ptr<OutboundConversation> CreateConversation(
+      std::size_t id, const Uri &target_path, std::shared_ptr<google::protobuf::Message> initiator);
+  Conversations CompleteRequest(unsigned long id) const;
 
   std::size_t ident = 1;
 
+  // identical read only requests which are issued while one is in flight share its round trip
+  mutable std::unordered_map<std::string, unsigned long>   inflight_requests_;
+  mutable std::unordered_map<unsigned long, std::string>   inflight_keys_;
+  mutable std::unordered_map<unsigned long, Conversations> followers_;
+
   std::shared_ptr<OutboundConversationWorkerTask> worker;
 
   OutboundDapConversationCreator(const OutboundDapConversationCreator &other) = delete;
@@ -115,6 +115,29 @@ public:
     return pt;
   }
 
+  /**
+   * Deep copy of the tree, including the field information and routing assigned by the visitors
+   */
+  std::shared_ptr<Branch> Clone() const
+  {
+    auto branch = std::make_shared<Branch>();
+    if (proto_)
+    {
+      branch->proto_ = std::make_shared<ConstructQueryObjectRequest>(*proto_);
+    }
+    branch->dap_names_ = dap_names_;
+    branch->mementos_  = mementos_;
+    for (auto const &node : subnodes_)
+    {
+      branch->subnodes_.push_back(node->Clone());
+    }
+    for (auto const &leaf : leaves_)
+    {
+      branch->leaves_.push_back(leaf->Clone());
+    }
+    return branch;
+  }
+
   std::vector<std::shared_ptr<Branch>> &GetSubnodes()
   {
     return subnodes_;
@@ -30,6 +30,8 @@
 #include "oef-search/dap_manager/DapStore.hpp"
 #include "oef-search/dap_manager/IdCache.hpp"
 #include "oef-search/dap_manager/NodeExecutorFactory.hpp"
+#include "oef-search/dap_manager/QueryCache.hpp"
+#include "oef-search/search_comms/SearchBroadcast.hpp"
 #include "oef-search/search_comms/SearchPeerStore.hpp"
 #include "visitors/AddMoreDapsBasedOnOptionsVisitor.hpp"
 #include "visitors/CollectDapsVisitor.hpp"
@@ -38,21 +40,38 @@
 #include "visitors/PopulateFieldInformationVisitor.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 
 class DapManager : public std::enable_shared_from_this<DapManager>
 {
 public:
-  static constexpr char const *LOGGING_NAME = "DapManager";
-
+  static constexpr char const *LOGGING_NAME            = "DapManager";
+  static constexpr std::size_t QUERY_CACHE_MAX_ENTRIES = 10000;
+  static constexpr std::size_t BROADCAST_MSG_ID_STRIDE = 1000;
+
+  using PlanCache   = QueryCache<std::shared_ptr<Branch>>;
+  using ResultCache = QueryCache<std::shared_ptr<IdentifierSequence>>;
+
+  /**
+   * @param query_cache_lifetime_sec How long query ids are remembered to drop repeated broadcasts
+   * @param query_plan_cache_lifetime_sec How long planned query trees are reused (0 disables)
+   * @param query_result_cache_lifetime_sec How long local query results are reused (0 disables)
+   */
   DapManager(std::shared_ptr<DapStore>              dap_store,
              std::shared_ptr<SearchPeerStore>       search_peer_store,
-             std::shared_ptr<OutboundConversations> outbounds, uint64_t query_cache_lifetime_sec)
+             std::shared_ptr<OutboundConversations> outbounds, uint64_t query_cache_lifetime_sec,
+             uint64_t query_plan_cache_lifetime_sec   = 0,
+             uint64_t query_result_cache_lifetime_sec = 0)
     : dap_store_{std::move(dap_store)}
     , search_peer_store_{std::move(search_peer_store)}
     , outbounds_{std::move(outbounds)}
     , query_id_cache_{std::make_shared<IdCache>(query_cache_lifetime_sec, query_cache_lifetime_sec)}
+    , query_plan_cache_{std::chrono::seconds(query_plan_cache_lifetime_sec),
+                        QUERY_CACHE_MAX_ENTRIES}
+    , query_result_cache_{std::chrono::seconds(query_result_cache_lifetime_sec),
+                          QUERY_CACHE_MAX_ENTRIES}
   {
     query_id_cache_->submit();
   }
@@ -75,6 +94,9 @@ public:
         if (sp)
         {
           sp->dap_store_->ConfigureDap(dap, *response);
+
+          // the field information and routing of planned queries depends on the DAP setup
+          sp->query_plan_cache_.Invalidate();
         }
         else
         {
@@ -91,6 +113,11 @@ public:
     auto future =
         std::make_shared<fetch::oef::base::FutureComplexType<std::shared_ptr<Successfulness>>>();
 
+    // any change to the data makes the cached query results stale, queries which are executed
+    // while the change is in progress are discarded again once it completes
+    query_result_cache_.Invalidate();
+
+    auto this_sp  = shared_from_this();
     auto convTask = std::make_shared<
         DapParallelConversationTask<ConstructQueryConstraintObjectRequest, Successfulness>>(
         parallel_call_msg_id, outbounds_);
@@ -116,7 +143,9 @@ public:
     }
     convTask->submit();
 
-    convTask->MakeNotification().Then([future, convTask, path]() {
+    convTask->MakeNotification().Then([future, convTask, path, this_sp]() {
+      this_sp->query_result_cache_.Invalidate();
+
       auto status = std::make_shared<Successfulness>();
       status->set_success(true);
       FETCH_LOG_INFO(LOGGING_NAME, "convTask done");
@@ -252,25 +281,87 @@ public:
     return result;
   }
 
+  /**
+   * Build the query tree of a query and run the local visitor passes over it, which populate the
+   * field information and select the DAPs for each node. Planned trees are cached, so a repeated
+   * query reuses the routing decisions of the first one.
+   *
+   * @param query The query
+   * @return Future which is set to the planned tree
+   */
+  std::shared_ptr<fetch::oef::base::FutureComplexType<std::shared_ptr<Branch>>> PlanQuery(
+      const ConstructQueryObjectRequest &query)
+  {
+    auto result =
+        std::make_shared<fetch::oef::base::FutureComplexType<std::shared_ptr<Branch>>>();
+
+    auto const              key = QueryCacheKey(query);
+    std::shared_ptr<Branch> cached{};
+    if (query_plan_cache_.Get(key, cached))
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Using cached query plan");
+      result->set(cached->Clone());
+      return result;
+    }
+
+    auto root = std::make_shared<Branch>(query);
+    if (root->GetOperator() != "result")
+    {
+      auto new_root = std::make_shared<Branch>(ConstructQueryObjectRequest{});
+      new_root->SetOperator("result");
+      new_root->AddBranch(std::move(root));
+      root = new_root;
+    }
+
+    auto const generation = query_plan_cache_.GetGeneration();
+    auto       this_sp    = shared_from_this();
+
+    VisitQueryTreeLocal(root)->MakeNotification().Then(
+        [this_sp, result, root, key, generation]() {
+          // the network pass modifies the tree, so the cache keeps its own copy
+          this_sp->query_plan_cache_.Put(key, root->Clone(), generation);
+          result->set(root);
+        });
+
+    return result;
+  }
+
   std::shared_ptr<fetch::oef::base::FutureComplexType<std::shared_ptr<IdentifierSequence>>> execute(
       std::shared_ptr<Branch> root, const fetch::oef::pb::SearchQuery &query)
   {
     auto result = std::make_shared<
         fetch::oef::base::FutureComplexType<std::shared_ptr<IdentifierSequence>>>();
-    auto visit_res = VisitQueryTreeNetwork(root);
 
-    auto identifier_sequence = std::make_shared<IdentifierSequence>();
-    identifier_sequence->set_originator(true);
-
-    std::shared_ptr<DapManager> this_sp  = shared_from_this();
-    double                      distance = 0.0;
+    double distance = 0.0;
     if (query.directed_search().has_distance())
     {
       distance = query.directed_search().distance().geo();
     }
 
-    visit_res->MakeNotification().Then([result, root, identifier_sequence, this_sp,
-                                        distance]() mutable {
+    auto const                          key = QueryCacheKey(query.query_v2());
+    std::shared_ptr<IdentifierSequence> cached{};
+    if (query_result_cache_.Get(key, cached))
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Using cached query result");
+      auto response = std::make_shared<IdentifierSequence>(*cached);
+      for (int i = 0; i < response->identifiers_size(); ++i)
+      {
+        response->mutable_identifiers(i)->set_distance(distance);
+      }
+      result->set(std::move(response));
+      return result;
+    }
+
+    auto visit_res = VisitQueryTreeNetwork(root);
+
+    auto identifier_sequence = std::make_shared<IdentifierSequence>();
+    identifier_sequence->set_originator(true);
+
+    std::shared_ptr<DapManager> this_sp    = shared_from_this();
+    auto const                  generation = query_result_cache_.GetGeneration();
+
+    visit_res->MakeNotification().Then([result, root, identifier_sequence, this_sp, distance, key,
+                                        generation]() mutable {
       FETCH_LOG_INFO(LOGGING_NAME, "--------------------- AFTER VISIT");
       root->Print();
       FETCH_LOG_INFO(LOGGING_NAME, "---------------------");
@@ -279,8 +370,11 @@ public:
           NodeExecutorFactory(BranchExecutorTask::NodeDataType(root), identifier_sequence, this_sp);
 
       execute_task->SetMessageHandler(
-          [result, distance](std::shared_ptr<IdentifierSequence> response) {
+          [result, distance, this_sp, key,
+           generation](std::shared_ptr<IdentifierSequence> response) {
             response->mutable_status()->set_success(true);
+            this_sp->query_result_cache_.Put(
+                key, std::make_shared<IdentifierSequence>(*response), generation);
             for (int i = 0; i < response->identifiers_size(); ++i)
             {
               response->mutable_identifiers(i)->set_distance(distance);
@@ -609,46 +703,12 @@ protected:
           &                                        future,
       std::shared_ptr<fetch::oef::pb::SearchQuery> query)
   {
-    auto convTask = std::make_shared<
-        DapParallelConversationTask<fetch::oef::pb::SearchQuery, IdentifierSequence>>(
-        ++parallel_call_msg_id, outbounds_, "");
     FETCH_LOG_INFO(LOGGING_NAME, "Start broadcasting to peers...");
-    search_peer_store_->ForAllPeer([convTask, this, query](const std::string &peer) {
-      FETCH_LOG_INFO(LOGGING_NAME, " Broadcast to search-peer: ", peer);
-      convTask->Add(DapInputDataType<fetch::oef::pb::SearchQuery>{peer, "search", query});
-      ++parallel_call_msg_id;
-    });
-    FETCH_LOG_INFO(LOGGING_NAME, "Submit broadcast tasks..");
-    convTask->submit();
-    convTask->MakeNotification().Then([future, convTask]() {
-      auto idseq = std::make_shared<IdentifierSequence>();
-      FETCH_LOG_INFO(LOGGING_NAME, "Broadcast done");
-      std::size_t idx = 0;
-      for (const auto &res : convTask->GetOutputs())
-      {
-        if (res->status().success())
-        {
-          FETCH_LOG_WARN(LOGGING_NAME, "Search-node ", convTask->GetDapName(idx), " returned ",
-                         res->identifiers_size(), " results!");
-          for (const auto &id : res->identifiers())
-          {
-            idseq->add_identifiers()->CopyFrom(id);
-          }
-        }
-        else
-        {
-          FETCH_LOG_WARN(LOGGING_NAME, "Search-node ", convTask->GetDapName(idx),
-                         " returned error message (", res->status().errorcode(),
-                         ") when calling search:");
-          for (const auto &m : res->status().narrative())
-          {
-            FETCH_LOG_WARN(LOGGING_NAME, "--> ", m);
-          }
-        }
-        ++idx;
-      }
-      future->set(std::move(idseq));
-    });
+    auto broadcast = std::make_shared<SearchBroadcast>(search_peer_store_, outbounds_,
+                                                       std::move(query), future,
+                                                       static_cast<uint32_t>(parallel_call_msg_id));
+    parallel_call_msg_id += BROADCAST_MSG_ID_STRIDE;
+    broadcast->Start();
   }
 
 protected:
@@ -656,6 +716,8 @@ protected:
   std::shared_ptr<SearchPeerStore>       search_peer_store_;
   std::shared_ptr<OutboundConversations> outbounds_;
   std::shared_ptr<IdCache>               query_id_cache_;
+  PlanCache                              query_plan_cache_;
+  ResultCache                            query_result_cache_;
   std::size_t                            parallel_call_msg_id = 2220;
   std::size_t                            single_call_msg_id   = 66600;
   std::size_t                            serial_call_msg_id   = 999000;
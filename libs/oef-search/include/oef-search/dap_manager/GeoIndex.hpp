@@ -0,0 +1,88 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+struct GeoPoint
+{
+  double lat{0.0};
+  double lon{0.0};
+};
+
+double GreatCircleDistance(GeoPoint const &a, GeoPoint const &b);
+
+/**
+ * In memory index of locations supporting bounding box and radius queries.
+ *
+ * Every location is encoded as a geohash, the bits of the latitude and longitude cell indices
+ * interleaved into one integer, and kept in an ordered map. All the locations inside a geohash
+ * cell of any size form a contiguous range of the map, so a query is answered by covering its
+ * area with a handful of cells, scanning the matching ranges and filtering the candidates with
+ * the exact test. This is O(log n + k) for a query with k candidates.
+ *
+ * Latitudes and longitudes are in degrees and distances in kilometres. The index is not thread
+ * safe.
+ */
+class GeoIndex
+{
+public:
+  using Key              = std::string;
+  using BoxCallback      = std::function<void(Key const &, GeoPoint const &)>;
+  using DistanceCallback = std::function<void(Key const &, double)>;
+
+  static constexpr uint32_t    LEVELS    = 26;  // bits per axis, cells of roughly 60 cm
+  static constexpr std::size_t MAX_CELLS = 16;  // cells used to cover the area of a query
+
+  GeoIndex()                      = default;
+  GeoIndex(GeoIndex const &other) = delete;
+  GeoIndex(GeoIndex &&other)      = default;
+  ~GeoIndex()                     = default;
+
+  void        Insert(Key const &key, GeoPoint const &point);
+  bool        Remove(Key const &key);
+  bool        Get(Key const &key, GeoPoint &point) const;
+  std::size_t size() const;
+
+  void WithinBox(GeoPoint const &south_west, GeoPoint const &north_east,
+                 BoxCallback const &callback) const;
+  void WithinRadius(GeoPoint const &centre, double radius, DistanceCallback const &callback) const;
+
+  GeoIndex &operator=(GeoIndex const &other) = delete;
+  GeoIndex &operator=(GeoIndex &&other) = default;
+
+private:
+  struct Row
+  {
+    Key      key;
+    GeoPoint point;
+  };
+
+  using Cells = std::multimap<uint64_t, Row>;
+
+  void ScanBox(GeoPoint const &south_west, GeoPoint const &north_east,
+               BoxCallback const &callback) const;
+
+  Cells                                    cells_{};
+  std::unordered_map<Key, Cells::iterator> rows_{};
+};
@@ -79,6 +79,21 @@ public:
     proto_->set_target_table_name(name);
   }
 
+  /**
+   * Deep copy of the leaf, including the field information and routing assigned by the visitors
+   */
+  std::shared_ptr<Leaf> Clone() const
+  {
+    auto leaf = std::make_shared<Leaf>();
+    if (proto_)
+    {
+      leaf->proto_ = std::make_shared<ConstructQueryConstraintObjectRequest>(*proto_);
+    }
+    leaf->dap_names_ = dap_names_;
+    leaf->mementos_  = mementos_;
+    return leaf;
+  }
+
   std::shared_ptr<ConstructQueryConstraintObjectRequest> ToProto(const std::string &dap_name)
   {
     auto pt = std::make_shared<ConstructQueryConstraintObjectRequest>(*proto_);
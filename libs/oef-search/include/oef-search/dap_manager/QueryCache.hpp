@@ -0,0 +1,199 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "logging/logging.hpp"
+#include "oef-messages/fetch_protobuf.hpp"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * A cache with a fixed lifetime for its entries, used to avoid planning or executing the same
+ * search query repeatedly.
+ *
+ * Every invalidation starts a new generation. Values computed asynchronously are stored with the
+ * generation that was current when the computation started, so a result which was being computed
+ * while the underlying data changed is discarded rather than cached.
+ */
+template <typename VALUE>
+class QueryCache
+{
+public:
+  using Clock      = std::chrono::steady_clock;
+  using Duration   = Clock::duration;
+  using Mutex      = std::mutex;
+  using Lock       = std::lock_guard<Mutex>;
+  using Generation = uint64_t;
+
+  static constexpr char const *LOGGING_NAME = "QueryCache";
+
+  QueryCache(Duration lifetime, std::size_t max_entries)
+    : lifetime_{lifetime}
+    , max_entries_{max_entries}
+  {}
+  ~QueryCache()                       = default;
+  QueryCache(const QueryCache &other) = delete;
+  QueryCache &operator=(const QueryCache &other) = delete;
+
+  bool operator==(const QueryCache &other) = delete;
+  bool operator<(const QueryCache &other)  = delete;
+
+  bool IsEnabled() const
+  {
+    return (lifetime_ > Duration::zero()) && (max_entries_ > 0);
+  }
+
+  /**
+   * Lookup a value in the cache
+   *
+   * @param key The normalised query key
+   * @param value Set to the cached value if found
+   * @return true if a value which has not yet expired was found, otherwise false
+   */
+  bool Get(std::string const &key, VALUE &value)
+  {
+    Lock lock(mutex_);
+
+    auto it = cache_.find(key);
+    if (it == cache_.end())
+    {
+      return false;
+    }
+
+    if (it->second.expiry <= Clock::now())
+    {
+      cache_.erase(it);
+      return false;
+    }
+
+    value = it->second.value;
+    return true;
+  }
+
+  /**
+   * Store a value in the cache
+   *
+   * @param key The normalised query key
+   * @param value The value to be stored
+   * @param generation The generation at which the computation of the value was started
+   */
+  void Put(std::string const &key, VALUE value, Generation generation)
+  {
+    if (!IsEnabled())
+    {
+      return;
+    }
+
+    Lock lock(mutex_);
+    if (generation != generation_)
+    {
+      return;
+    }
+
+    auto const now = Clock::now();
+    if ((cache_.size() >= max_entries_) && (cache_.find(key) == cache_.end()))
+    {
+      RemoveExpired(now);
+
+      if (cache_.size() >= max_entries_)
+      {
+        FETCH_LOG_INFO(LOGGING_NAME, "Cache full, dropping ", cache_.size(), " entries");
+        cache_.clear();
+      }
+    }
+
+    cache_[key] = Entry{std::move(value), now + lifetime_};
+  }
+
+  /**
+   * Remove all the entries and start a new generation
+   */
+  void Invalidate()
+  {
+    Lock lock(mutex_);
+    cache_.clear();
+    ++generation_;
+  }
+
+  Generation GetGeneration() const
+  {
+    Lock lock(mutex_);
+    return generation_;
+  }
+
+  std::size_t size() const
+  {
+    Lock lock(mutex_);
+    return cache_.size();
+  }
+
+private:
+  struct Entry
+  {
+    VALUE             value;
+    Clock::time_point expiry;
+  };
+
+  void RemoveExpired(Clock::time_point now)
+  {
+    for (auto it = cache_.begin(); it != cache_.end();)
+    {
+      if (it->second.expiry <= now)
+      {
+        it = cache_.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  mutable Mutex                          mutex_;
+  std::unordered_map<std::string, Entry> cache_;
+  Duration                               lifetime_;
+  std::size_t                            max_entries_;
+  Generation                             generation_{0};
+};
+
+/**
+ * Build the cache key of a query. Deterministic serialisation is used so that equal queries
+ * always produce the same key, independent of the order in which map fields were populated.
+ *
+ * @param query The query (or part of it)
+ * @return The key
+ */
+inline std::string QueryCacheKey(google::protobuf::Message const &query)
+{
+  std::string key;
+  {
+    google::protobuf::io::StringOutputStream stream(&key);
+    google::protobuf::io::CodedOutputStream  coded(&stream);
+    coded.SetSerializationDeterministic(true);
+    query.SerializeToCodedStream(&coded);
+  }
+  return key;
+}
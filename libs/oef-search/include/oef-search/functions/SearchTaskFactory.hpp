@@ -52,7 +52,7 @@ protected:
   virtual void EndpointClosed()
   {}
 
-  void HandleQuery(fetch::oef::pb::SearchQuery &query, const Uri &current_uri);
+  void HandleQuery(std::shared_ptr<fetch::oef::pb::SearchQuery> query, const Uri &current_uri);
   void ExecuteQuery(std::shared_ptr<Branch> &root, const fetch::oef::pb::SearchQuery &query,
                     const Uri &current_uri);
 
@@ -0,0 +1,94 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "oef-base/conversation/OutboundConversations.hpp"
+#include "oef-base/threading/Future.hpp"
+#include "oef-messages/dap_interface.hpp"
+#include "oef-messages/search_query.hpp"
+#include "oef-search/search_comms/SearchPeerStore.hpp"
+
+/**
+ * Forwards a search to the peers of this node and merges their results.
+ *
+ * The search is sent to the `fanout` peers with the lowest expected latency. Whenever the hedge
+ * delay passes while peers are still outstanding the search is also sent to the next best peer,
+ * and a peer which fails is replaced straight away. The broadcast completes once the result
+ * target is reached or no peer is outstanding; late responses only update the peer statistics.
+ */
+class SearchBroadcast : public std::enable_shared_from_this<SearchBroadcast>
+{
+public:
+  using Clock     = std::chrono::steady_clock;
+  using Query     = fetch::oef::pb::SearchQuery;
+  using QueryPtr  = std::shared_ptr<Query>;
+  using ResultPtr = std::shared_ptr<IdentifierSequence>;
+  using Future    = fetch::oef::base::FutureComplexType<ResultPtr>;
+  using FuturePtr = std::shared_ptr<Future>;
+
+  static constexpr char const *LOGGING_NAME = "SearchBroadcast";
+
+  SearchBroadcast(std::shared_ptr<SearchPeerStore>       peers,
+                  std::shared_ptr<OutboundConversations> outbounds, QueryPtr query,
+                  FuturePtr result, uint32_t msg_id);
+  ~SearchBroadcast() = default;
+
+  SearchBroadcast(const SearchBroadcast &other) = delete;
+  SearchBroadcast &operator=(const SearchBroadcast &other) = delete;
+  bool             operator==(const SearchBroadcast &other) = delete;
+  bool             operator<(const SearchBroadcast &other)  = delete;
+
+  void Start();
+
+private:
+  class HedgeTask;
+
+  using Lock = std::lock_guard<std::mutex>;
+
+  bool TakeNextPeer(std::string &peer);
+  void Forward(std::string const &peer);
+  void ForwardNext();
+  void Hedge();
+  void OnReply(std::string const &peer, Clock::time_point start, ResultPtr reply);
+  void OnError(std::string const &peer, Clock::time_point start);
+  void ScheduleHedge();
+  void CompleteIfDone();
+
+  std::shared_ptr<SearchPeerStore>       peers_;
+  std::shared_ptr<OutboundConversations> outbounds_;
+  QueryPtr                               query_;
+  FuturePtr                              result_;
+  SearchPeerStore::Policy                policy_;
+
+  std::mutex               mutex_;
+  uint32_t                 msg_id_;
+  std::vector<std::string> ranked_{};      ///< The peers, best first
+  std::size_t              next_peer_{0};  ///< The next peer to forward the search to
+  std::size_t              outstanding_{0};
+  std::size_t              num_results_{0};
+  ResultPtr                merged_{std::make_shared<IdentifierSequence>()};
+  bool                     done_{false};
+};
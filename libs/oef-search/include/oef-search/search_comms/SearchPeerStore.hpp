@@ -17,22 +17,53 @@
 //
 //------------------------------------------------------------------------------
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <unordered_set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+/**
+ * The search peers of this node, together with the observed latency and load of every peer.
+ *
+ * Forwarded searches are sent to the peers with the lowest expected latency first: the moving
+ * average of the response times of a peer, scaled by the number of its outstanding requests.
+ * Failed requests count as very slow responses and peers which have not been measured yet are
+ * preferred, so that every peer is probed.
+ */
 class SearchPeerStore
 {
 public:
   static constexpr char const *LOGGING_NAME = "SearchPeerStore";
 
-  using Mutex   = std::mutex;
-  using Lock    = std::lock_guard<Mutex>;
-  using ForBody = std::function<void(const std::string &)>;
+  using Mutex        = std::mutex;
+  using Lock         = std::lock_guard<Mutex>;
+  using ForBody      = std::function<void(const std::string &)>;
+  using Milliseconds = std::chrono::milliseconds;
 
-  SearchPeerStore()                             = default;
+  /**
+   * How searches are forwarded to the peers. The defaults forward every search to all peers and
+   * wait for all of them.
+   */
+  struct Policy
+  {
+    std::size_t  fanout{0};         ///< Peers a search is sent to at first, 0 for all peers
+    Milliseconds hedge_delay{0};    ///< Delay before another peer is asked, 0 disables hedging
+    std::size_t  result_target{0};  ///< Results after which a search completes, 0 waits for all
+  };
+
+  static constexpr double LATENCY_SMOOTHING  = 0.2;
+  static constexpr double FAILURE_LATENCY_MS = 5000.0;
+
+  SearchPeerStore() = default;
+  explicit SearchPeerStore(Policy policy)
+    : policy_{policy}
+  {}
   virtual ~SearchPeerStore()                    = default;
   SearchPeerStore(const SearchPeerStore &other) = delete;
   SearchPeerStore &operator=(const SearchPeerStore &other) = delete;
@@ -43,7 +74,7 @@ public:
   void AddPeer(const std::string &peer)
   {
     Lock lock(mutex_);
-    store_.insert(peer);
+    store_.emplace(peer, Stats{});
   }
 
   void ForAllPeer(ForBody const &func)
@@ -51,12 +82,105 @@ public:
     Lock lock(mutex_);
     for (const auto &peer : store_)
     {
-      func(peer);
+      func(peer.first);
     }
   }
 
+  /**
+   * @return All peers, the peer with the lowest expected latency first
+   */
+  std::vector<std::string> RankPeers() const
+  {
+    std::vector<std::pair<double, std::string>> ranked;
+    {
+      Lock lock(mutex_);
+      ranked.reserve(store_.size());
+      for (const auto &peer : store_)
+      {
+        ranked.emplace_back(peer.second.ExpectedLatency(), peer.first);
+      }
+    }
+
+    std::sort(ranked.begin(), ranked.end());
+
+    std::vector<std::string> peers;
+    peers.reserve(ranked.size());
+    for (auto &peer : ranked)
+    {
+      peers.push_back(std::move(peer.second));
+    }
+    return peers;
+  }
+
+  void RequestStarted(const std::string &peer)
+  {
+    Lock lock(mutex_);
+    auto it = store_.find(peer);
+    if (it != store_.end())
+    {
+      ++it->second.in_flight;
+    }
+  }
+
+  /**
+   * Record the outcome of a request sent to a peer
+   *
+   * @param peer The peer
+   * @param latency The time it took the peer to respond
+   * @param success false if the request failed
+   */
+  void RequestCompleted(const std::string &peer, Milliseconds latency, bool success)
+  {
+    auto const sample = success ? static_cast<double>(latency.count()) : FAILURE_LATENCY_MS;
+
+    Lock lock(mutex_);
+    auto it = store_.find(peer);
+    if (it == store_.end())
+    {
+      return;
+    }
+
+    auto &stats = it->second;
+    if (stats.in_flight > 0)
+    {
+      --stats.in_flight;
+    }
+
+    stats.latency  = stats.measured ? stats.latency + LATENCY_SMOOTHING * (sample - stats.latency)
+                                    : sample;
+    stats.measured = true;
+  }
+
+  /**
+   * @return The expected latency of a peer in milliseconds, 0 if it has not been measured yet
+   */
+  double ExpectedLatency(const std::string &peer) const
+  {
+    Lock lock(mutex_);
+    auto it = store_.find(peer);
+    return (it == store_.end()) ? 0.0 : it->second.ExpectedLatency();
+  }
+
+  Policy const &policy() const
+  {
+    return policy_;
+  }
+
 protected:
 private:
-  Mutex                           mutex_;
-  std::unordered_set<std::string> store_;
+  struct Stats
+  {
+    double      latency{0.0};  ///< Moving average of the response times in milliseconds
+    bool        measured{false};
+    std::size_t in_flight{0};
+
+    double ExpectedLatency() const
+    {
+      return latency * static_cast<double>(1 + in_flight);
+    }
+  };
+
+  Policy                                 policy_{};
+  mutable Mutex                          mutex_;
+  std::unordered_map<std::string, Stats> store_;
 };
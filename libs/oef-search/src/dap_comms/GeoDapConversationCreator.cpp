@@ -0,0 +1,357 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-search/dap_comms/GeoDapConversationCreator.hpp"
+
+#include "logging/logging.hpp"
+#include "oef-base/conversation/OutboundTypedConversation.hpp"
+#include "oef-base/utils/OefUri.hpp"
+
+#include <google/protobuf/message.h>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr char const *FIELD_NAME = "location";
+constexpr char const *FIELD_TYPE = "location";
+constexpr char const *OPERATOR   = "WITHIN";
+
+struct GeoConstraint
+{
+  bool     is_box{false};
+  GeoPoint first{};
+  GeoPoint second{};
+  double   radius{0.0};
+};
+
+bool ToGeoPoint(Location const &location, GeoPoint &point)
+{
+  if (location.v_size() < 2)
+  {
+    return false;
+  }
+
+  point.lat = location.v(0);
+  point.lon = location.v(1);
+
+  return (point.lat >= -90.0) && (point.lat <= 90.0) && (point.lon >= -180.0) &&
+         (point.lon <= 180.0);
+}
+
+bool ParseConstraint(ConstructQueryConstraintObjectRequest const &request,
+                     GeoConstraint &                              constraint)
+{
+  auto const &value = request.query_field_value();
+
+  if (request.operator_() != OPERATOR)
+  {
+    return false;
+  }
+
+  if (value.v_l_size() == 2)
+  {
+    constraint.is_box = true;
+    return ToGeoPoint(value.v_l(0), constraint.first) &&
+           ToGeoPoint(value.v_l(1), constraint.second);
+  }
+
+  constraint.radius = value.d();
+  return value.has_l() && (constraint.radius >= 0) && ToGeoPoint(value.l(), constraint.first);
+}
+
+/**
+ * The row key of an identifier, in the same form as the keys sent with the updates
+ */
+std::string RowKey(Identifier const &identifier)
+{
+  if (!identifier.uri().empty())
+  {
+    return identifier.uri();
+  }
+
+  OEFURI::URI uri;
+  uri.CoreKey = identifier.core();
+  uri.ParseAgent(identifier.agent());
+  uri.empty = false;
+  return uri.ToString();
+}
+
+Identifier ToIdentifier(std::string const &row_key)
+{
+  Identifier identifier;
+  identifier.set_uri(row_key);
+
+  std::vector<std::string> parts;
+  split(row_key, parts, '/');
+  if (parts.size() >= 7)
+  {
+    identifier.set_core(parts[3]);
+    identifier.set_agent(parts[parts.size() - 2]);
+  }
+
+  return identifier;
+}
+
+template <typename REPLY>
+std::shared_ptr<OutboundConversation> Reply(std::size_t id, Uri const &target_path,
+                                            std::shared_ptr<google::protobuf::Message> initiator,
+                                            std::shared_ptr<REPLY>                     reply)
+{
+  auto conv = std::make_shared<OutboundTypedConversation<REPLY>>(id, target_path, initiator);
+  conv->SetId(target_path.ToString());
+  conv->status_code = 0;
+  conv->responses.push_back(std::move(reply));
+  conv->wake();
+  return conv;
+}
+
+template <typename REPLY>
+std::shared_ptr<OutboundConversation> ReplyError(
+    std::size_t id, Uri const &target_path, std::shared_ptr<google::protobuf::Message> initiator,
+    std::string const &message)
+{
+  auto conv = std::make_shared<OutboundTypedConversation<REPLY>>(id, target_path, initiator);
+  conv->SetId(target_path.ToString());
+  conv->HandleError(400, message);
+  return conv;
+}
+
+}  // namespace
+
+GeoDapConversationCreator::GeoDapConversationCreator(std::string dap_name)
+  : dap_name_{std::move(dap_name)}
+{}
+
+std::shared_ptr<OutboundConversation> GeoDapConversationCreator::start(
+    const Uri &target_path, std::shared_ptr<google::protobuf::Message> initiator)
+{
+  auto const &path       = target_path.path;
+  auto const  constraint =
+      std::dynamic_pointer_cast<ConstructQueryConstraintObjectRequest>(initiator);
+
+  Lock lock(mutex_);
+  auto this_id = ident_++;
+
+  if (path == "describe")
+  {
+    return Reply(this_id, target_path, initiator, Describe());
+  }
+  if ((path == "update") && constraint)
+  {
+    return Reply(this_id, target_path, initiator, Update(*constraint));
+  }
+  if (((path == "remove") || (path == "removeRow")) && constraint)
+  {
+    return Reply(this_id, target_path, initiator, Remove(*constraint));
+  }
+  if ((path == "prepareConstraint") && constraint)
+  {
+    return Reply(this_id, target_path, initiator, PrepareConstraint(*constraint));
+  }
+  if (path == "prepare")
+  {
+    // whole branches are left to the query engine, which combines the results of the leaves
+    auto response = std::make_shared<ConstructQueryMementoResponse>();
+    response->set_success(false);
+    return Reply(this_id, target_path, initiator, std::move(response));
+  }
+  if ((path == "calculate") && constraint)
+  {
+    auto response = Calculate(*constraint);
+    if (!response)
+    {
+      return ReplyError<ConstructQueryConstraintObjectRequest>(
+          this_id, target_path, initiator, "Distance can not be calculated for this request");
+    }
+    return Reply(this_id, target_path, initiator, std::move(response));
+  }
+  if (path == "execute")
+  {
+    auto execute = std::dynamic_pointer_cast<DapExecute>(initiator);
+    if (execute)
+    {
+      return Reply(this_id, target_path, initiator, Execute(*execute));
+    }
+  }
+
+  FETCH_LOG_ERROR(LOGGING_NAME, "Path ", path, " not supported!");
+  throw std::invalid_argument(path +
+                              " is not a valid target, to start a GeoDapConversationCreator!");
+}
+
+std::shared_ptr<DapDescription> GeoDapConversationCreator::Describe() const
+{
+  auto description = std::make_shared<DapDescription>();
+  description->set_name(dap_name_);
+
+  auto table = description->add_table();
+  table->set_name(dap_name_);
+
+  auto field = table->add_field();
+  field->set_name(FIELD_NAME);
+  field->set_type(FIELD_TYPE);
+  field->add_options("replace_target_info");
+
+  return description;
+}
+
+std::shared_ptr<Successfulness> GeoDapConversationCreator::Update(
+    ConstructQueryConstraintObjectRequest const &request)
+{
+  auto     status = std::make_shared<Successfulness>();
+  GeoPoint point{};
+
+  if ((request.query_field_value().typecode() != FIELD_TYPE) ||
+      !ToGeoPoint(request.query_field_value().l(), point))
+  {
+    status->set_success(false);
+    status->add_narrative("Invalid location for " + request.row_key());
+    return status;
+  }
+
+  index_.Insert(request.row_key(), point);
+  status->set_success(true);
+  return status;
+}
+
+std::shared_ptr<Successfulness> GeoDapConversationCreator::Remove(
+    ConstructQueryConstraintObjectRequest const &request)
+{
+  auto status = std::make_shared<Successfulness>();
+  status->set_success(index_.Remove(request.row_key()));
+  if (!status->success())
+  {
+    status->add_narrative("No location for " + request.row_key());
+  }
+  return status;
+}
+
+/**
+ * The memento of a constraint is the constraint itself, it is checked here so that execution can
+ * not fail
+ */
+std::shared_ptr<ConstructQueryMementoResponse> GeoDapConversationCreator::PrepareConstraint(
+    ConstructQueryConstraintObjectRequest const &request) const
+{
+  auto          response = std::make_shared<ConstructQueryMementoResponse>();
+  GeoConstraint constraint{};
+
+  response->set_node_name(request.node_name());
+  response->set_success(ParseConstraint(request, constraint));
+  if (response->success())
+  {
+    response->set_memento(request.SerializeAsString());
+  }
+
+  return response;
+}
+
+/**
+ * Distance of an agent from the location in the request
+ */
+std::shared_ptr<ConstructQueryConstraintObjectRequest> GeoDapConversationCreator::Calculate(
+    ConstructQueryConstraintObjectRequest const &request) const
+{
+  GeoPoint target{};
+  GeoPoint point{};
+
+  if ((request.operator_() != "DISTANCE") || !ToGeoPoint(request.query_field_value().l(), target) ||
+      !index_.Get(request.row_key(), point))
+  {
+    return nullptr;
+  }
+
+  auto response = std::make_shared<ConstructQueryConstraintObjectRequest>(request);
+  response->mutable_query_field_value()->Clear();
+  response->mutable_query_field_value()->set_typecode("double");
+  response->mutable_query_field_value()->set_d(GreatCircleDistance(target, point));
+  return response;
+}
+
+/**
+ * Run a constraint prepared by PrepareConstraint. Originating queries return every matching agent,
+ * otherwise the input identifiers are filtered.
+ */
+std::shared_ptr<IdentifierSequence> GeoDapConversationCreator::Execute(
+    DapExecute const &request) const
+{
+  auto result = std::make_shared<IdentifierSequence>();
+  result->set_originator(false);
+
+  ConstructQueryConstraintObjectRequest constraint_request;
+  GeoConstraint                         constraint{};
+
+  if (!constraint_request.ParseFromString(request.query_memento().memento()) ||
+      !ParseConstraint(constraint_request, constraint))
+  {
+    result->mutable_status()->set_success(false);
+    result->mutable_status()->add_narrative("Invalid memento");
+    return result;
+  }
+
+  std::unordered_map<std::string, double> matches;
+  if (constraint.is_box)
+  {
+    index_.WithinBox(constraint.first, constraint.second,
+                     [&matches](GeoIndex::Key const &key, GeoPoint const & /*point*/) {
+                       matches.emplace(key, 0.0);
+                     });
+  }
+  else
+  {
+    index_.WithinRadius(constraint.first, constraint.radius,
+                        [&matches](GeoIndex::Key const &key, double distance) {
+                          matches.emplace(key, distance);
+                        });
+  }
+
+  if (request.input_idents().originator())
+  {
+    for (auto const &match : matches)
+    {
+      auto identifier = result->add_identifiers();
+      *identifier     = ToIdentifier(match.first);
+      if (!constraint.is_box)
+      {
+        identifier->set_distance(match.second);
+      }
+    }
+  }
+  else
+  {
+    for (auto const &input : request.input_idents().identifiers())
+    {
+      auto it = matches.find(RowKey(input));
+      if (it != matches.end())
+      {
+        auto identifier = result->add_identifiers();
+        identifier->CopyFrom(input);
+        if (!constraint.is_box)
+        {
+          identifier->set_distance(it->second);
+        }
+      }
+    }
+  }
+
+  result->mutable_status()->set_success(true);
+  return result;
+}
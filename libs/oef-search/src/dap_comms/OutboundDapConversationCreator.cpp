@@ -23,12 +23,26 @@
 #include "oef-base/threading/StateMachineTask.hpp"
 #include "oef-base/utils/Uri.hpp"
 #include "oef-messages/dap_interface.hpp"
+#include "oef-search/dap_manager/QueryCache.hpp"
 
 #include "oef-base/conversation/OutboundConversationWorkerTask.hpp"
 #include "oef-base/utils/Uri.hpp"
 
 #include <google/protobuf/message.h>
 
+namespace {
+
+/**
+ * Only requests which do not modify the DAP can share a reply
+ */
+bool IsCoalescable(std::string const &path)
+{
+  return (path == "execute") || (path == "prepare") || (path == "prepareConstraint") ||
+         (path == "calculate") || (path == "describe");
+}
+
+}  // namespace
+
 OutboundDapConversationCreator::OutboundDapConversationCreator(const Uri &dap_uri, Core &core,
                                                                const std::string &dap_name)
 {
@@ -52,40 +66,73 @@ std::shared_ptr<OutboundConversation> OutboundDapConversationCreator::start(
 {
   FETCH_LOG_INFO(LOGGING_NAME, "Starting dap conversation with ", target_path.host, ":",
                  target_path.port, "/", target_path.path);
+
+  std::string key{};
+  if (IsCoalescable(target_path.path))
+  {
+    key = target_path.path + '\0' + QueryCacheKey(*initiator);
+  }
+
   Lock lock(mutex_);
   auto this_id = ident++;
 
+  auto conv = CreateConversation(this_id, target_path, initiator);
+
+  if (!key.empty())
+  {
+    auto it = inflight_requests_.find(key);
+    if (it != inflight_requests_.end())
+    {
+      // the reply to the request already in flight is delivered to this conversation as well
+      FETCH_LOG_INFO(LOGGING_NAME, "Coalescing request to ", target_path.path, " with ",
+                     it->second);
+      followers_[it->second].push_back(conv);
+      return conv;
+    }
+
+    inflight_requests_[key] = this_id;
+    inflight_keys_[this_id] = std::move(key);
+  }
+
+  ident2conversation_[this_id] = conv;
+  worker->post(conv);
+  return conv;
+}
+
+std::shared_ptr<OutboundConversation> OutboundDapConversationCreator::CreateConversation(
+    std::size_t id, const Uri &target_path, std::shared_ptr<google::protobuf::Message> initiator)
+{
   std::shared_ptr<OutboundConversation> conv;
 
   if (target_path.path == "execute")
   {
-    conv = std::make_shared<OutboundTypedConversation<IdentifierSequence>>(this_id, target_path,
+    conv = std::make_shared<OutboundTypedConversation<IdentifierSequence>>(id, target_path,
                                                                            initiator);
   }
   else if (target_path.path == "prepareConstraint" || target_path.path == "prepare")
   {
     conv = std::make_shared<OutboundTypedConversation<ConstructQueryMementoResponse>>(
-        this_id, target_path, initiator);
+        id, target_path, initiator);
   }
   else if (target_path.path == "calculate")
   {
     conv = std::make_shared<OutboundTypedConversation<ConstructQueryConstraintObjectRequest>>(
-        this_id, target_path, initiator);
+        id, target_path, initiator);
   }
   else if (target_path.path == "update")
   {
-    conv = std::make_shared<OutboundTypedConversation<Successfulness>>(this_id, target_path,
-                                                                       initiator);
+    conv =
+        std::make_shared<OutboundTypedConversation<Successfulness>>(id, target_path, initiator);
   }
   else if (target_path.path == "describe")
   {
-    conv = std::make_shared<OutboundTypedConversation<DapDescription>>(this_id, target_path,
-                                                                       initiator);
+    conv =
+        std::make_shared<OutboundTypedConversation<DapDescription>>(id, target_path, initiator);
   }
   else if (target_path.path == "remove" || target_path.path == "removeRow")
   {
-    conv = std::make_shared<OutboundTypedConversation<Successfulness>>(this_id, target_path,
-                                                                       initiator);
+    conv =
+        std::make_shared<OutboundTypedConversation<Successfulness>>(id, target_path, initiator);
   }
   else
   {
@@ -94,7 +141,62 @@ std::shared_ptr<OutboundConversation> OutboundDapConversationCreator::start(
         target_path.path + " is not a valid target, to start a OutboundDapConversationCreator!");
   }
   conv->SetId(target_path.ToString());
-  ident2conversation_[this_id] = conv;
-  worker->post(conv);
   return conv;
 }
+
+/**
+ * Mark the request with the given id as no longer in flight
+ *
+ * @param id The id of the request
+ * @return The conversations which were coalesced with the request
+ */
+OutboundDapConversationCreator::Conversations OutboundDapConversationCreator::CompleteRequest(
+    unsigned long id) const
+{
+  Conversations followers{};
+
+  Lock lock(mutex_);
+
+  auto key_it = inflight_keys_.find(id);
+  if (key_it != inflight_keys_.end())
+  {
+    inflight_requests_.erase(key_it->second);
+    inflight_keys_.erase(key_it);
+  }
+
+  auto it = followers_.find(id);
+  if (it != followers_.end())
+  {
+    followers = std::move(it->second);
+    followers_.erase(it);
+  }
+
+  return followers;
+}
+
+void OutboundDapConversationCreator::HandleMessage(unsigned long id, const Uri &uri,
+                                                   ConstCharArrayBuffer const &buffer) const
+{
+  auto followers = CompleteRequest(id);
+
+  IOutboundConversationCreator::HandleMessage(id, uri, buffer);
+
+  // every follower parses its own copy of the reply
+  for (auto &conv : followers)
+  {
+    conv->HandleMessage(buffer);
+  }
+}
+
+void OutboundDapConversationCreator::HandleError(unsigned long id, const Uri &uri,
+                                                 int status_code, const std::string &message) const
+{
+  auto followers = CompleteRequest(id);
+
+  IOutboundConversationCreator::HandleError(id, uri, status_code, message);
+
+  for (auto &conv : followers)
+  {
+    conv->HandleError(status_code, message);
+  }
+}
@@ -0,0 +1,268 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-search/dap_manager/GeoIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double EARTH_RADIUS_KM = 6371.0;
+constexpr double PI              = 3.14159265358979323846;
+constexpr double MAX_LAT         = 90.0;
+constexpr double MAX_LON         = 180.0;
+
+constexpr uint64_t CELLS_PER_AXIS = uint64_t{1} << GeoIndex::LEVELS;
+
+double ToRadians(double degrees)
+{
+  return degrees * PI / 180.0;
+}
+
+double ToDegrees(double radians)
+{
+  return radians * 180.0 / PI;
+}
+
+/**
+ * Index of the cell containing a coordinate at full precision
+ */
+uint64_t CellIndex(double value, double max)
+{
+  auto const scaled = std::floor((value + max) / (2 * max) * static_cast<double>(CELLS_PER_AXIS));
+  if (!(scaled > 0))
+  {
+    return 0;
+  }
+  return std::min(static_cast<uint64_t>(scaled), CELLS_PER_AXIS - 1);
+}
+
+/**
+ * Place the bits of a cell index on the even bit positions
+ */
+uint64_t Spread(uint64_t value)
+{
+  value &= 0xFFFFFFFFull;
+  value = (value | (value << 16u)) & 0x0000FFFF0000FFFFull;
+  value = (value | (value << 8u)) & 0x00FF00FF00FF00FFull;
+  value = (value | (value << 4u)) & 0x0F0F0F0F0F0F0F0Full;
+  value = (value | (value << 2u)) & 0x3333333333333333ull;
+  value = (value | (value << 1u)) & 0x5555555555555555ull;
+  return value;
+}
+
+uint64_t Interleave(uint64_t x, uint64_t y)
+{
+  return Spread(x) | (Spread(y) << 1u);
+}
+
+uint64_t GeoHash(GeoPoint const &point)
+{
+  return Interleave(CellIndex(point.lon, MAX_LON), CellIndex(point.lat, MAX_LAT));
+}
+
+bool InBox(GeoPoint const &point, GeoPoint const &south_west, GeoPoint const &north_east)
+{
+  return (point.lat >= south_west.lat) && (point.lat <= north_east.lat) &&
+         (point.lon >= south_west.lon) && (point.lon <= north_east.lon);
+}
+
+}  // namespace
+
+/**
+ * Haversine distance between two locations
+ *
+ * @return The distance in kilometres
+ */
+double GreatCircleDistance(GeoPoint const &a, GeoPoint const &b)
+{
+  double const dlat = ToRadians(b.lat - a.lat);
+  double const dlon = ToRadians(b.lon - a.lon);
+
+  double const h = std::sin(dlat / 2) * std::sin(dlat / 2) +
+                   std::cos(ToRadians(a.lat)) * std::cos(ToRadians(b.lat)) * std::sin(dlon / 2) *
+                       std::sin(dlon / 2);
+
+  return 2 * EARTH_RADIUS_KM * std::asin(std::min(1.0, std::sqrt(h)));
+}
+
+/**
+ * Add a location to the index, replacing the previous location of the key
+ *
+ * @param key The key of the location
+ * @param point The location
+ */
+void GeoIndex::Insert(Key const &key, GeoPoint const &point)
+{
+  Remove(key);
+  rows_[key] = cells_.emplace(GeoHash(point), Row{key, point});
+}
+
+/**
+ * Remove the location of a key from the index
+ *
+ * @param key The key of the location
+ * @return true if the key was present, otherwise false
+ */
+bool GeoIndex::Remove(Key const &key)
+{
+  auto it = rows_.find(key);
+  if (it == rows_.end())
+  {
+    return false;
+  }
+
+  cells_.erase(it->second);
+  rows_.erase(it);
+  return true;
+}
+
+bool GeoIndex::Get(Key const &key, GeoPoint &point) const
+{
+  auto it = rows_.find(key);
+  if (it == rows_.end())
+  {
+    return false;
+  }
+
+  point = it->second->second.point;
+  return true;
+}
+
+std::size_t GeoIndex::size() const
+{
+  return rows_.size();
+}
+
+/**
+ * Find the locations inside a bounding box. A box with a western longitude greater than its
+ * eastern longitude wraps around the antimeridian.
+ *
+ * @param south_west The south western corner of the box
+ * @param north_east The north eastern corner of the box
+ * @param callback Invoked for every location inside the box
+ */
+void GeoIndex::WithinBox(GeoPoint const &south_west, GeoPoint const &north_east,
+                         BoxCallback const &callback) const
+{
+  if (south_west.lon > north_east.lon)
+  {
+    ScanBox(south_west, GeoPoint{north_east.lat, MAX_LON}, callback);
+    ScanBox(GeoPoint{south_west.lat, -MAX_LON}, north_east, callback);
+  }
+  else
+  {
+    ScanBox(south_west, north_east, callback);
+  }
+}
+
+/**
+ * Find the locations within a distance of a point
+ *
+ * @param centre The point
+ * @param radius The distance in kilometres
+ * @param callback Invoked for every location found, with its distance from the point
+ */
+void GeoIndex::WithinRadius(GeoPoint const &centre, double radius,
+                            DistanceCallback const &callback) const
+{
+  if (radius < 0)
+  {
+    return;
+  }
+
+  auto const angle = radius / EARTH_RADIUS_KM;
+  auto const dlat  = ToDegrees(angle);
+
+  GeoPoint south_west{centre.lat - dlat, -MAX_LON};
+  GeoPoint north_east{centre.lat + dlat, MAX_LON};
+
+  // unless the circle contains a pole it spans a limited range of longitudes
+  if ((south_west.lat > -MAX_LAT) && (north_east.lat < MAX_LAT))
+  {
+    auto const ratio = std::sin(angle) / std::cos(ToRadians(centre.lat));
+    if (ratio < 1)
+    {
+      auto const dlon = ToDegrees(std::asin(ratio));
+
+      south_west.lon = centre.lon - dlon;
+      north_east.lon = centre.lon + dlon;
+
+      if (south_west.lon < -MAX_LON)
+      {
+        south_west.lon += 2 * MAX_LON;
+      }
+      if (north_east.lon > MAX_LON)
+      {
+        north_east.lon -= 2 * MAX_LON;
+      }
+    }
+  }
+
+  south_west.lat = std::max(south_west.lat, -MAX_LAT);
+  north_east.lat = std::min(north_east.lat, MAX_LAT);
+
+  WithinBox(south_west, north_east, [&centre, radius, &callback](Key const &key,
+                                                                 GeoPoint const &point) {
+    auto const distance = GreatCircleDistance(centre, point);
+    if (distance <= radius)
+    {
+      callback(key, distance);
+    }
+  });
+}
+
+void GeoIndex::ScanBox(GeoPoint const &south_west, GeoPoint const &north_east,
+                       BoxCallback const &callback) const
+{
+  if ((south_west.lat > north_east.lat) || (south_west.lon > north_east.lon))
+  {
+    return;
+  }
+
+  auto const x0 = CellIndex(south_west.lon, MAX_LON);
+  auto const x1 = CellIndex(north_east.lon, MAX_LON);
+  auto const y0 = CellIndex(south_west.lat, MAX_LAT);
+  auto const y1 = CellIndex(north_east.lat, MAX_LAT);
+
+  // the finest level at which the box is covered by a bounded number of cells
+  uint32_t shift = 0;
+  while ((((x1 >> shift) - (x0 >> shift) + 1) * ((y1 >> shift) - (y0 >> shift) + 1)) > MAX_CELLS)
+  {
+    ++shift;
+  }
+
+  for (uint64_t y = y0 >> shift; y <= (y1 >> shift); ++y)
+  {
+    for (uint64_t x = x0 >> shift; x <= (x1 >> shift); ++x)
+    {
+      // the cell is the range of hashes sharing its prefix
+      auto const first = Interleave(x, y) << (2 * shift);
+      auto const last  = first + ((uint64_t{1} << (2 * shift)) - 1);
+
+      for (auto it = cells_.lower_bound(first); (it != cells_.end()) && (it->first <= last); ++it)
+      {
+        if (InBox(it->second.point, south_west, north_east))
+        {
+          callback(it->second.key, it->second.point);
+        }
+      }
+    }
+  }
+}
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "oef-base/proto_comms/ProtoArena.hpp"
 #include "oef-base/threading/Future.hpp"
 #include "oef-base/threading/FutureCombiner.hpp"
 #include "oef-search/functions/ReplyMethods.hpp"
@@ -30,13 +31,14 @@ void SearchTaskFactory::ProcessMessageWithUri(const Uri &current_uri, ConstCharA
 
   if (current_uri.path == "/search")
   {
-    fetch::oef::pb::SearchQuery query;
+    // the query and everything built from it while it is planned and executed share an arena
+    auto query = MakeArenaProto<fetch::oef::pb::SearchQuery>(NewProtoArena());
     try
     {
-      IOefTaskFactory::read(query, data, data.size - data.current);
-      FETCH_LOG_INFO(LOGGING_NAME, "Got search: ", query.DebugString());
+      IOefTaskFactory::read(*query, data, data.size - data.current);
+      FETCH_LOG_INFO(LOGGING_NAME, "Got search: ", query->DebugString());
 
-      auto handle_query_result = dap_manager_->ShouldQueryBeHandled(query);
+      auto handle_query_result = dap_manager_->ShouldQueryBeHandled(*query);
       handle_query_result->MakeNotification().Then([this_wp, handle_query_result, current_uri,
                                                     query]() mutable {
         auto sp = this_wp.lock();
@@ -148,22 +150,17 @@ void SearchTaskFactory::ProcessMessageWithUri(const Uri &current_uri, ConstCharA
   }
 }
 
-void SearchTaskFactory::HandleQuery(fetch::oef::pb::SearchQuery &query, const Uri &current_uri)
+void SearchTaskFactory::HandleQuery(std::shared_ptr<fetch::oef::pb::SearchQuery> query,
+                                    const Uri &                                  current_uri)
 {
   auto                             this_sp = shared_from_this();
   std::weak_ptr<SearchTaskFactory> this_wp = this_sp;
-  auto                             root    = std::make_shared<Branch>(query.query_v2());
-  if (root->GetOperator() != "result")
-  {
-    auto new_root = std::make_shared<Branch>();
-    new_root->SetOperator("result");
-    new_root->AddBranch(std::move(root));
-    root = new_root;
-  }
 
-  auto visit_future = dap_manager_->VisitQueryTreeLocal(root);
+  auto plan_future = dap_manager_->PlanQuery(query->query_v2());
+
+  plan_future->MakeNotification().Then([plan_future, this_wp, current_uri, query]() mutable {
+    auto root = plan_future->get();
 
-  visit_future->MakeNotification().Then([root, this_wp, current_uri, query]() mutable {
     FETCH_LOG_INFO(LOGGING_NAME, "--------------------- QUERY TREE");
     root->Print();
     FETCH_LOG_INFO(LOGGING_NAME, "---------------------");
@@ -172,7 +169,7 @@ void SearchTaskFactory::HandleQuery(fetch::oef::pb::SearchQuery &query, const Ur
     if (sp)
     {
       sp->dap_manager_->SetQueryHeader(
-          root, query, [sp, root, current_uri](fetch::oef::pb::SearchQuery &query) mutable {
+          root, *query, [sp, root, current_uri](fetch::oef::pb::SearchQuery &query) mutable {
             sp->ExecuteQuery(root, query, current_uri);
           });
     }
@@ -181,6 +178,7 @@ void SearchTaskFactory::HandleQuery(fetch::oef::pb::SearchQuery &query, const Ur
       FETCH_LOG_WARN(LOGGING_NAME,
                      "Query execution failed, because SearchTaskFactory weak ptr can't be locked!");
     }
+    plan_future.reset();
   });
 }
 
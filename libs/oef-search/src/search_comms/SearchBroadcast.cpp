@@ -0,0 +1,275 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-search/search_comms/SearchBroadcast.hpp"
+
+#include "logging/logging.hpp"
+#include "oef-base/threading/Task.hpp"
+#include "oef-search/dap_comms/DapConversationTask.hpp"
+
+#include <algorithm>
+#include <utility>
+
+/**
+ * Timer which forwards the search to another peer once the hedge delay has passed
+ */
+class SearchBroadcast::HedgeTask : public fetch::oef::base::Task
+{
+public:
+  explicit HedgeTask(std::weak_ptr<SearchBroadcast> broadcast)
+    : broadcast_{std::move(broadcast)}
+  {}
+  ~HedgeTask() override = default;
+
+  bool IsRunnable() const override
+  {
+    return true;
+  }
+
+  fetch::oef::base::ExitState run() override
+  {
+    auto broadcast = broadcast_.lock();
+    if (broadcast)
+    {
+      broadcast->Hedge();
+    }
+    return fetch::oef::base::ExitState::COMPLETE;
+  }
+
+private:
+  std::weak_ptr<SearchBroadcast> broadcast_;
+};
+
+SearchBroadcast::SearchBroadcast(std::shared_ptr<SearchPeerStore>       peers,
+                                 std::shared_ptr<OutboundConversations> outbounds, QueryPtr query,
+                                 FuturePtr result, uint32_t msg_id)
+  : peers_{std::move(peers)}
+  , outbounds_{std::move(outbounds)}
+  , query_{std::move(query)}
+  , result_{std::move(result)}
+  , policy_{peers_->policy()}
+  , msg_id_{msg_id}
+{}
+
+void SearchBroadcast::Start()
+{
+  std::vector<std::string> selected;
+  {
+    Lock lock(mutex_);
+    ranked_ = peers_->RankPeers();
+
+    auto const fanout =
+        (policy_.fanout == 0) ? ranked_.size() : std::min(policy_.fanout, ranked_.size());
+
+    // all initial peers are reserved before the first one can respond
+    std::string peer;
+    while ((selected.size() < fanout) && TakeNextPeer(peer))
+    {
+      selected.push_back(std::move(peer));
+    }
+
+    FETCH_LOG_INFO(LOGGING_NAME, "Forwarding search to ", fanout, " of ", ranked_.size(),
+                   " peers");
+  }
+
+  for (auto const &peer : selected)
+  {
+    Forward(peer);
+  }
+
+  ScheduleHedge();
+  CompleteIfDone();
+}
+
+/**
+ * Forward the search to the best peer which has not been asked yet
+ */
+void SearchBroadcast::ForwardNext()
+{
+  std::string peer;
+  {
+    Lock lock(mutex_);
+    if (!TakeNextPeer(peer))
+    {
+      return;
+    }
+  }
+
+  Forward(peer);
+}
+
+/**
+ * Internal: Select the next peer to forward the search to, must be called with the lock held
+ *
+ * @param peer Set to the selected peer
+ * @return false if the broadcast is done or all peers have been selected
+ */
+bool SearchBroadcast::TakeNextPeer(std::string &peer)
+{
+  if (done_ || (next_peer_ >= ranked_.size()))
+  {
+    return false;
+  }
+
+  peer = ranked_[next_peer_++];
+  ++outstanding_;
+  return true;
+}
+
+void SearchBroadcast::Forward(std::string const &peer)
+{
+  using Task = DapConversationTask<Query, IdentifierSequence>;
+
+  uint32_t msg_id = 0;
+  {
+    Lock lock(mutex_);
+    msg_id = ++msg_id_;
+  }
+
+  FETCH_LOG_INFO(LOGGING_NAME, " Broadcast to search-peer: ", peer);
+
+  auto task    = std::make_shared<Task>(peer, "search", msg_id, query_, outbounds_, "");
+  auto start   = Clock::now();
+  auto this_sp = shared_from_this();
+
+  // the handlers keep the broadcast alive until every peer has responded
+  task->SetMessageHandler([this_sp, peer, start](ResultPtr reply) {
+    this_sp->OnReply(peer, start, std::move(reply));
+  });
+  task->SetErrorHandler([this_sp, peer, start](std::string const & /*dap_name*/,
+                                               std::string const & /*path*/,
+                                               std::string const &msg) {
+    FETCH_LOG_WARN(LOGGING_NAME, "Search-node ", peer, " failed: ", msg);
+    this_sp->OnError(peer, start);
+  });
+
+  peers_->RequestStarted(peer);
+  task->submit();
+}
+
+void SearchBroadcast::OnReply(std::string const &peer, Clock::time_point start, ResultPtr reply)
+{
+  auto const latency = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+  peers_->RequestCompleted(peer, latency, true);
+
+  if (!reply->status().success())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Search-node ", peer, " returned error message (",
+                   reply->status().errorcode(), ") when calling search:");
+    for (const auto &m : reply->status().narrative())
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "--> ", m);
+    }
+  }
+  else
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Search-node ", peer, " returned ", reply->identifiers_size(),
+                   " results in ", latency.count(), " ms");
+
+    Lock lock(mutex_);
+    if (!done_)
+    {
+      for (const auto &id : reply->identifiers())
+      {
+        merged_->add_identifiers()->CopyFrom(id);
+      }
+      num_results_ += static_cast<std::size_t>(reply->identifiers_size());
+    }
+  }
+
+  {
+    Lock lock(mutex_);
+    --outstanding_;
+  }
+
+  CompleteIfDone();
+}
+
+void SearchBroadcast::OnError(std::string const &peer, Clock::time_point start)
+{
+  auto const latency = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+  peers_->RequestCompleted(peer, latency, false);
+
+  // the failed peer is replaced straight away
+  std::string replacement;
+  {
+    Lock lock(mutex_);
+    --outstanding_;
+    TakeNextPeer(replacement);
+  }
+
+  if (!replacement.empty())
+  {
+    Forward(replacement);
+  }
+
+  CompleteIfDone();
+}
+
+void SearchBroadcast::Hedge()
+{
+  {
+    Lock lock(mutex_);
+    if (done_ || (outstanding_ == 0))
+    {
+      return;
+    }
+  }
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Peers are slow, hedging search");
+  ForwardNext();
+  ScheduleHedge();
+}
+
+void SearchBroadcast::ScheduleHedge()
+{
+  {
+    Lock lock(mutex_);
+    if (done_ || (policy_.hedge_delay.count() == 0) || (next_peer_ >= ranked_.size()))
+    {
+      return;
+    }
+  }
+
+  std::make_shared<HedgeTask>(shared_from_this())->submit(policy_.hedge_delay);
+}
+
+void SearchBroadcast::CompleteIfDone()
+{
+  ResultPtr merged;
+  {
+    Lock lock(mutex_);
+    if (done_)
+    {
+      return;
+    }
+
+    bool const target_reached = (policy_.result_target != 0) &&
+                                (num_results_ >= policy_.result_target);
+    if (!target_reached && (outstanding_ != 0))
+    {
+      return;
+    }
+
+    done_  = true;
+    merged = merged_;
+  }
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Broadcast done, ", merged->identifiers_size(), " results");
+  result_->set(std::move(merged));
+}
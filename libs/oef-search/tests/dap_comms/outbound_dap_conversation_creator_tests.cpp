@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-base/comms/ConstCharArrayBuffer.hpp"
+#include "oef-base/comms/Core.hpp"
+#include "oef-base/conversation/OutboundConversation.hpp"
+#include "oef-base/utils/Uri.hpp"
+#include "oef-messages/dap_interface.hpp"
+#include "oef-search/dap_comms/OutboundDapConversationCreator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ConversationPtr = std::shared_ptr<OutboundConversation>;
+using RequestPtr      = std::shared_ptr<google::protobuf::Message>;
+
+// the dap is never connected to, the replies are delivered to the creator by the tests
+constexpr char const *DAP_URI = "tcp://127.0.0.1:10001";
+
+RequestPtr CreateRequest(std::string const &agent)
+{
+  auto request = std::make_shared<DapExecute>();
+  request->mutable_input_idents()->add_identifiers()->set_agent(agent);
+  return request;
+}
+
+class OutboundDapConversationCreatorTests : public ::testing::Test
+{
+protected:
+  ConversationPtr Start(std::string const &path, RequestPtr const &request)
+  {
+    // as for the dap conversation tasks, the path is the bare name of the dap endpoint
+    Uri uri{std::string{DAP_URI} + "/" + path};
+    uri.path = uri.path.substr(1);
+
+    return creator_.start(uri, request);
+  }
+
+  /**
+   * Deliver a reply from the DAP to the request with the given id
+   */
+  void Reply(unsigned long id, google::protobuf::Message const &reply)
+  {
+    auto const data = reply.SerializeAsString();
+
+    std::vector<asio::const_buffer> buffers{asio::buffer(data.data(), data.size())};
+    creator_.HandleMessage(id, Uri{DAP_URI}, ConstCharArrayBuffer{buffers});
+  }
+
+  Core                           core_;
+  OutboundDapConversationCreator creator_{Uri{DAP_URI}, core_, "test"};
+};
+
+TEST_F(OutboundDapConversationCreatorTests, IdenticalRequestsShareOneReply)
+{
+  auto first  = Start("execute", CreateRequest("agent"));
+  auto second = Start("execute", CreateRequest("agent"));
+
+  IdentifierSequence reply{};
+  reply.add_identifiers()->set_agent("result");
+  Reply(first->GetIdentifier(), reply);
+
+  // both conversations receive and parse the reply to the single request sent
+  ASSERT_EQ(first->GetAvailableReplyCount(), 1);
+  ASSERT_EQ(second->GetAvailableReplyCount(), 1);
+  EXPECT_TRUE(second->success());
+
+  auto const first_reply  = std::static_pointer_cast<IdentifierSequence>(first->GetReply(0));
+  auto const second_reply = std::static_pointer_cast<IdentifierSequence>(second->GetReply(0));
+  EXPECT_EQ(first_reply->identifiers(0).agent(), "result");
+  EXPECT_EQ(second_reply->identifiers(0).agent(), "result");
+  EXPECT_NE(first_reply, second_reply);
+}
+
+TEST_F(OutboundDapConversationCreatorTests, DifferentRequestsAreNotCoalesced)
+{
+  auto first  = Start("execute", CreateRequest("agent1"));
+  auto second = Start("execute", CreateRequest("agent2"));
+  auto third  = Start("calculate", CreateRequest("agent1"));
+
+  IdentifierSequence reply{};
+  Reply(first->GetIdentifier(), reply);
+
+  EXPECT_EQ(first->GetAvailableReplyCount(), 1);
+  EXPECT_EQ(second->GetAvailableReplyCount(), 0);
+  EXPECT_EQ(third->GetAvailableReplyCount(), 0);
+  EXPECT_NE(second->GetIdentifier(), first->GetIdentifier());
+}
+
+TEST_F(OutboundDapConversationCreatorTests, RequestsAfterTheReplyAreSentAgain)
+{
+  auto first = Start("execute", CreateRequest("agent"));
+
+  IdentifierSequence reply{};
+  Reply(first->GetIdentifier(), reply);
+
+  // the earlier request is no longer in flight, so this one needs a reply of its own
+  auto second = Start("execute", CreateRequest("agent"));
+  EXPECT_EQ(second->GetAvailableReplyCount(), 0);
+
+  Reply(second->GetIdentifier(), reply);
+  EXPECT_EQ(first->GetAvailableReplyCount(), 1);
+  EXPECT_EQ(second->GetAvailableReplyCount(), 1);
+}
+
+TEST_F(OutboundDapConversationCreatorTests, UpdatesAreNeverCoalesced)
+{
+  auto first  = Start("update", CreateRequest("agent"));
+  auto second = Start("update", CreateRequest("agent"));
+
+  Successfulness reply{};
+  reply.set_success(true);
+  Reply(first->GetIdentifier(), reply);
+
+  EXPECT_EQ(first->GetAvailableReplyCount(), 1);
+  EXPECT_EQ(second->GetAvailableReplyCount(), 0);
+}
+
+TEST_F(OutboundDapConversationCreatorTests, ErrorsAreDeliveredToEveryWaitingConversation)
+{
+  auto first  = Start("describe", CreateRequest("agent"));
+  auto second = Start("describe", CreateRequest("agent"));
+
+  creator_.HandleError(first->GetIdentifier(), Uri{DAP_URI}, 42, "dap failed");
+
+  for (auto const &conversation : {first, second})
+  {
+    EXPECT_FALSE(conversation->success());
+    EXPECT_EQ(conversation->GetErrorCode(), 42);
+    EXPECT_EQ(conversation->GetErrorMessage(), "dap failed");
+  }
+}
+
+}  // namespace
@@ -0,0 +1,208 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-search/dap_manager/GeoIndex.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Keys = std::set<GeoIndex::Key>;
+
+class GeoIndexTests : public ::testing::Test
+{
+protected:
+  void Add(GeoIndex::Key const &key, double lat, double lon)
+  {
+    index_.Insert(key, GeoPoint{lat, lon});
+    points_[key] = GeoPoint{lat, lon};
+  }
+
+  /**
+   * Scatter random locations between two latitudes over every longitude
+   */
+  void Scatter(std::size_t count, double min_lat, double max_lat)
+  {
+    std::uniform_real_distribution<double> lat{min_lat, max_lat};
+    std::uniform_real_distribution<double> lon{-180.0, 180.0};
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      Add("agent" + std::to_string(points_.size()), lat(rng_), lon(rng_));
+    }
+  }
+
+  Keys Box(GeoPoint const &south_west, GeoPoint const &north_east) const
+  {
+    Keys keys{};
+    index_.WithinBox(south_west, north_east,
+                     [&keys](GeoIndex::Key const &key, GeoPoint const &) { keys.insert(key); });
+    return keys;
+  }
+
+  Keys Radius(GeoPoint const &centre, double radius) const
+  {
+    Keys keys{};
+    index_.WithinRadius(centre, radius, [&keys, &centre, radius, this](GeoIndex::Key const &key,
+                                                                       double distance) {
+      EXPECT_LE(distance, radius);
+      EXPECT_DOUBLE_EQ(distance, GreatCircleDistance(centre, points_.at(key)));
+      keys.insert(key);
+    });
+    return keys;
+  }
+
+  /**
+   * The locations within a distance of a point, found by checking every location
+   */
+  Keys ExpectedRadius(GeoPoint const &centre, double radius) const
+  {
+    Keys keys{};
+    for (auto const &element : points_)
+    {
+      if (GreatCircleDistance(centre, element.second) <= radius)
+      {
+        keys.insert(element.first);
+      }
+    }
+    return keys;
+  }
+
+  GeoIndex                          index_{};
+  std::map<GeoIndex::Key, GeoPoint> points_{};
+  std::mt19937_64                   rng_{42};
+};
+
+TEST_F(GeoIndexTests, WithinBoxFindsOnlyTheLocationsInsideTheBox)
+{
+  Add("inside", 51.5, -0.1);
+  Add("on_edge", 52.0, 0.0);
+  Add("north", 52.5, -0.1);
+  Add("east", 51.5, 1.5);
+
+  EXPECT_EQ(Box(GeoPoint{51.0, -1.0}, GeoPoint{52.0, 1.0}), (Keys{"inside", "on_edge"}));
+}
+
+TEST_F(GeoIndexTests, WithinBoxWrapsAroundTheAntimeridian)
+{
+  Add("west_of_line", -17.0, 179.5);
+  Add("east_of_line", -17.5, -179.5);
+  Add("on_line", -18.0, 180.0);
+  Add("outside_west", -17.0, 169.0);
+  Add("outside_east", -17.0, -169.0);
+  Add("greenwich", -17.0, 0.0);
+
+  // the western edge of the box is east of its eastern edge
+  auto const keys = Box(GeoPoint{-20.0, 170.0}, GeoPoint{-15.0, -170.0});
+  EXPECT_EQ(keys, (Keys{"west_of_line", "east_of_line", "on_line"}));
+
+  // the same box without the wrap spans the rest of the world
+  EXPECT_EQ(Box(GeoPoint{-20.0, -170.0}, GeoPoint{-15.0, 170.0}),
+            (Keys{"outside_west", "outside_east", "greenwich"}));
+}
+
+TEST_F(GeoIndexTests, WithinRadiusAcrossTheAntimeridian)
+{
+  Scatter(2000, -30.0, 0.0);
+
+  GeoPoint const centre{-17.0, 179.0};
+  auto const     keys = Radius(centre, 1000.0);
+
+  EXPECT_FALSE(keys.empty());
+  EXPECT_EQ(keys, ExpectedRadius(centre, 1000.0));
+}
+
+TEST_F(GeoIndexTests, WithinRadiusNearTheNorthPole)
+{
+  Scatter(2000, 80.0, 90.0);
+  Add("pole", 90.0, 0.0);
+  Add("far_side", 89.5, 180.0);
+
+  // the circle contains the pole so every longitude must be searched
+  GeoPoint const centre{89.0, 0.0};
+  auto const     keys = Radius(centre, 300.0);
+
+  EXPECT_EQ(keys.count("pole"), 1);
+  EXPECT_EQ(keys.count("far_side"), 1);
+  EXPECT_EQ(keys, ExpectedRadius(centre, 300.0));
+}
+
+TEST_F(GeoIndexTests, WithinRadiusNearTheSouthPole)
+{
+  Scatter(2000, -90.0, -75.0);
+
+  // the circle does not contain the pole, but spans a wide range of longitudes
+  GeoPoint const centre{-85.0, 90.0};
+  auto const     keys = Radius(centre, 500.0);
+
+  EXPECT_FALSE(keys.empty());
+  EXPECT_EQ(keys, ExpectedRadius(centre, 500.0));
+
+  // the circle contains the pole
+  GeoPoint const polar{-88.0, -45.0};
+  EXPECT_EQ(Radius(polar, 400.0), ExpectedRadius(polar, 400.0));
+}
+
+TEST_F(GeoIndexTests, InsertReplacesTheLocationOfAnExistingKey)
+{
+  Add("agent", 51.5, -0.1);
+  Add("agent", 40.7, -74.0);
+
+  EXPECT_EQ(index_.size(), 1);
+
+  GeoPoint point{};
+  ASSERT_TRUE(index_.Get("agent", point));
+  EXPECT_DOUBLE_EQ(point.lat, 40.7);
+  EXPECT_DOUBLE_EQ(point.lon, -74.0);
+
+  // the previous location is no longer indexed
+  EXPECT_TRUE(Box(GeoPoint{51.0, -1.0}, GeoPoint{52.0, 1.0}).empty());
+  EXPECT_EQ(Box(GeoPoint{40.0, -75.0}, GeoPoint{41.0, -73.0}), (Keys{"agent"}));
+  EXPECT_EQ(Radius(GeoPoint{40.7, -74.0}, 1.0), (Keys{"agent"}));
+}
+
+TEST_F(GeoIndexTests, RemoveDeletesTheLocation)
+{
+  Add("first", 51.5, -0.1);
+  Add("second", 51.6, -0.2);
+
+  EXPECT_TRUE(index_.Remove("first"));
+  EXPECT_FALSE(index_.Remove("first"));
+  EXPECT_FALSE(index_.Remove("unknown"));
+  EXPECT_EQ(index_.size(), 1);
+
+  GeoPoint point{};
+  EXPECT_FALSE(index_.Get("first", point));
+  EXPECT_TRUE(index_.Get("second", point));
+
+  EXPECT_EQ(Box(GeoPoint{51.0, -1.0}, GeoPoint{52.0, 1.0}), (Keys{"second"}));
+  EXPECT_EQ(Radius(GeoPoint{51.5, -0.1}, 50.0), (Keys{"second"}));
+
+  EXPECT_TRUE(index_.Remove("second"));
+  EXPECT_EQ(index_.size(), 0);
+  EXPECT_TRUE(Box(GeoPoint{-90.0, -180.0}, GeoPoint{90.0, 180.0}).empty());
+}
+
+}  // namespace
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-messages/config.hpp"
+#include "oef-search/dap_manager/QueryCache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using Cache = QueryCache<std::string>;
+
+TEST(QueryCacheTests, StoredValuesAreFound)
+{
+  Cache cache{60s, 10};
+
+  cache.Put("query", "result", cache.GetGeneration());
+
+  std::string value{};
+  EXPECT_TRUE(cache.Get("query", value));
+  EXPECT_EQ(value, "result");
+  EXPECT_FALSE(cache.Get("other query", value));
+}
+
+TEST(QueryCacheTests, DisabledCacheStoresNothing)
+{
+  Cache no_lifetime{0s, 10};
+  Cache no_entries{60s, 0};
+
+  EXPECT_FALSE(no_lifetime.IsEnabled());
+  EXPECT_FALSE(no_entries.IsEnabled());
+
+  no_lifetime.Put("query", "result", no_lifetime.GetGeneration());
+  no_entries.Put("query", "result", no_entries.GetGeneration());
+
+  EXPECT_EQ(no_lifetime.size(), 0);
+  EXPECT_EQ(no_entries.size(), 0);
+}
+
+TEST(QueryCacheTests, ExpiredValuesAreRemoved)
+{
+  Cache cache{50ms, 10};
+
+  cache.Put("query", "result", cache.GetGeneration());
+  std::this_thread::sleep_for(100ms);
+
+  std::string value{};
+  EXPECT_FALSE(cache.Get("query", value));
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(QueryCacheTests, InvalidationRemovesAllValues)
+{
+  Cache cache{60s, 10};
+
+  cache.Put("query1", "result1", cache.GetGeneration());
+  cache.Put("query2", "result2", cache.GetGeneration());
+  cache.Invalidate();
+
+  std::string value{};
+  EXPECT_FALSE(cache.Get("query1", value));
+  EXPECT_FALSE(cache.Get("query2", value));
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(QueryCacheTests, ValuesComputedBeforeAnInvalidationAreDiscarded)
+{
+  Cache cache{60s, 10};
+
+  // the data changes while the value is being computed
+  auto const generation = cache.GetGeneration();
+  cache.Invalidate();
+  cache.Put("query", "stale result", generation);
+
+  std::string value{};
+  EXPECT_FALSE(cache.Get("query", value));
+
+  cache.Put("query", "result", cache.GetGeneration());
+  EXPECT_TRUE(cache.Get("query", value));
+  EXPECT_EQ(value, "result");
+}
+
+TEST(QueryCacheTests, ExpiredValuesAreEvictedFirstWhenFull)
+{
+  Cache cache{300ms, 2};
+
+  cache.Put("old", "result", cache.GetGeneration());
+  std::this_thread::sleep_for(200ms);
+  cache.Put("recent", "result", cache.GetGeneration());
+  std::this_thread::sleep_for(150ms);
+
+  // only the oldest value has expired, so the recent one survives
+  cache.Put("new", "result", cache.GetGeneration());
+
+  std::string value{};
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_TRUE(cache.Get("recent", value));
+  EXPECT_TRUE(cache.Get("new", value));
+}
+
+TEST(QueryCacheTests, FullCacheIsClearedWhenNothingHasExpired)
+{
+  Cache cache{60s, 2};
+
+  cache.Put("query1", "result1", cache.GetGeneration());
+  cache.Put("query2", "result2", cache.GetGeneration());
+
+  // replacing a value does not need space
+  cache.Put("query2", "updated", cache.GetGeneration());
+  EXPECT_EQ(cache.size(), 2);
+
+  cache.Put("query3", "result3", cache.GetGeneration());
+
+  std::string value{};
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_TRUE(cache.Get("query3", value));
+  EXPECT_FALSE(cache.Get("query1", value));
+}
+
+TEST(QueryCacheTests, KeysDoNotDependOnMapOrder)
+{
+  fetch::oef::pb::CoreConfig first{};
+  (*first.mutable_karma_policy())["a"] = "1";
+  (*first.mutable_karma_policy())["b"] = "2";
+  (*first.mutable_karma_policy())["c"] = "3";
+
+  fetch::oef::pb::CoreConfig second{};
+  (*second.mutable_karma_policy())["c"] = "3";
+  (*second.mutable_karma_policy())["a"] = "1";
+  (*second.mutable_karma_policy())["b"] = "2";
+
+  EXPECT_EQ(QueryCacheKey(first), QueryCacheKey(second));
+
+  (*second.mutable_karma_policy())["b"] = "4";
+  EXPECT_NE(QueryCacheKey(first), QueryCacheKey(second));
+}
+
+}  // namespace
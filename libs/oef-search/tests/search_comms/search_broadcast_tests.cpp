@@ -0,0 +1,338 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-base/conversation/IOutboundConversationCreator.hpp"
+#include "oef-base/conversation/OutboundConversations.hpp"
+#include "oef-base/conversation/OutboundTypedConversation.hpp"
+#include "oef-base/threading/Taskpool.hpp"
+#include "oef-base/threading/Threadpool.hpp"
+#include "oef-base/utils/Uri.hpp"
+#include "oef-messages/dap_interface.hpp"
+#include "oef-search/search_comms/SearchBroadcast.hpp"
+#include "oef-search/search_comms/SearchPeerStore.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using Policy = SearchPeerStore::Policy;
+
+/**
+ * A search peer which records the forwarded searches, the tests decide when and how it responds
+ */
+class FakePeer : public IOutboundConversationCreator
+{
+public:
+  using Conversation    = OutboundTypedConversation<IdentifierSequence>;
+  using ConversationPtr = std::shared_ptr<Conversation>;
+
+  explicit FakePeer(std::string name)
+    : name_{std::move(name)}
+  {}
+  ~FakePeer() override = default;
+
+  std::shared_ptr<OutboundConversation> start(
+      Uri const &target_path, std::shared_ptr<google::protobuf::Message> initiator) override
+  {
+    auto conversation = std::make_shared<Conversation>(0, target_path, std::move(initiator));
+
+    Lock lock(mutex_);
+    pending_.push_back(conversation);
+    ++num_requests_;
+    return conversation;
+  }
+
+  std::size_t NumRequests() const
+  {
+    Lock lock(mutex_);
+    return num_requests_;
+  }
+
+  /**
+   * Respond to the oldest outstanding search
+   *
+   * @param num_results The number of results in the response
+   */
+  void Reply(std::size_t num_results)
+  {
+    auto conversation = Next();
+
+    auto reply = std::make_shared<IdentifierSequence>();
+    reply->mutable_status()->set_success(true);
+    for (std::size_t i = 0; i < num_results; ++i)
+    {
+      reply->add_identifiers()->set_agent(name_ + "/" + std::to_string(i));
+    }
+
+    conversation->status_code = 0;
+    conversation->responses.push_back(std::move(reply));
+    conversation->wake();
+  }
+
+  /**
+   * Fail the oldest outstanding search
+   */
+  void Fail()
+  {
+    Next()->HandleError(1, "peer failed");
+  }
+
+private:
+  ConversationPtr Next()
+  {
+    Lock lock(mutex_);
+    auto conversation = pending_.front();
+    pending_.pop_front();
+    return conversation;
+  }
+
+  std::string                 name_;
+  mutable Mutex               mutex_;
+  std::deque<ConversationPtr> pending_;
+  std::size_t                 num_requests_{0};
+};
+
+using FakePeerPtr = std::shared_ptr<FakePeer>;
+
+class SearchBroadcastTests : public ::testing::Test
+{
+protected:
+  using Taskpool   = fetch::oef::base::Taskpool;
+  using Threadpool = fetch::oef::base::Threadpool;
+
+  void SetUp() override
+  {
+    taskpool_->SetDefault();
+    runners_.start(2, [this](std::size_t thread_idx) { taskpool_->run(thread_idx); });
+  }
+
+  void TearDown() override
+  {
+    // the taskpool can not be stopped while tasks are running, the broadcast is released once the
+    // tasks of all its peers are done
+    EXPECT_TRUE(WaitFor([this] { return broadcast_.expired(); }));
+
+    taskpool_->stop();
+    std::this_thread::sleep_for(10ms);
+    runners_.stop();
+  }
+
+  /**
+   * Create the peers of the node, named after their position
+   *
+   * @param num_peers The number of peers
+   * @param policy How searches are forwarded to the peers
+   */
+  void CreatePeers(std::size_t num_peers, Policy const &policy)
+  {
+    store_ = std::make_shared<SearchPeerStore>(policy);
+    for (std::size_t i = 0; i < num_peers; ++i)
+    {
+      auto const name = "tcp://peer" + std::to_string(i) + ":10000";
+      auto const peer = std::make_shared<FakePeer>(name);
+
+      store_->AddPeer(name);
+      outbounds_->AddConversationCreator(Uri{name}, peer);
+      names_.push_back(name);
+      peers_.push_back(peer);
+    }
+  }
+
+  void Start()
+  {
+    auto query = std::make_shared<SearchBroadcast::Query>();
+    auto broadcast =
+        std::make_shared<SearchBroadcast>(store_, outbounds_, std::move(query), result_, 0);
+
+    broadcast_ = broadcast;
+    broadcast->Start();
+  }
+
+  static bool WaitFor(std::function<bool()> const &condition)
+  {
+    auto const deadline = std::chrono::steady_clock::now() + 10s;
+    while (!condition())
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        return false;
+      }
+      std::this_thread::sleep_for(1ms);
+    }
+    return true;
+  }
+
+  static bool WaitForRequests(FakePeerPtr const &peer, std::size_t num_requests)
+  {
+    return WaitFor([&peer, num_requests] { return peer->NumRequests() >= num_requests; });
+  }
+
+  bool WaitForResult()
+  {
+    return WaitFor([this] { return result_->IsWoken(); });
+  }
+
+  std::shared_ptr<Taskpool>              taskpool_{std::make_shared<Taskpool>()};
+  Threadpool                             runners_;
+  std::shared_ptr<OutboundConversations> outbounds_{std::make_shared<OutboundConversations>()};
+  std::shared_ptr<SearchPeerStore>       store_;
+  SearchBroadcast::FuturePtr             result_{std::make_shared<SearchBroadcast::Future>()};
+  std::vector<std::string>               names_;
+  std::vector<FakePeerPtr>               peers_;
+  std::weak_ptr<SearchBroadcast>         broadcast_;
+};
+
+TEST_F(SearchBroadcastTests, ResultsOfAllPeersAreMerged)
+{
+  CreatePeers(3, Policy{});
+  Start();
+
+  for (std::size_t i = 0; i < peers_.size(); ++i)
+  {
+    ASSERT_TRUE(WaitForRequests(peers_[i], 1));
+    EXPECT_FALSE(result_->IsWoken());
+    peers_[i]->Reply(i + 1);
+  }
+
+  ASSERT_TRUE(WaitForResult());
+  EXPECT_EQ(result_->get()->identifiers_size(), 6);
+}
+
+TEST_F(SearchBroadcastTests, SearchIsSentToTheFastestPeers)
+{
+  Policy policy{};
+  policy.fanout = 2;
+  CreatePeers(3, policy);
+
+  store_->RequestCompleted(names_[0], 300ms, true);
+  store_->RequestCompleted(names_[1], 10ms, true);
+  store_->RequestCompleted(names_[2], 50ms, true);
+
+  Start();
+
+  ASSERT_TRUE(WaitForRequests(peers_[1], 1));
+  ASSERT_TRUE(WaitForRequests(peers_[2], 1));
+  peers_[1]->Reply(1);
+  peers_[2]->Reply(1);
+
+  ASSERT_TRUE(WaitForResult());
+  EXPECT_EQ(result_->get()->identifiers_size(), 2);
+  EXPECT_EQ(peers_[0]->NumRequests(), 0);
+}
+
+TEST_F(SearchBroadcastTests, FailedPeerIsReplaced)
+{
+  Policy policy{};
+  policy.fanout = 1;
+  CreatePeers(2, policy);
+
+  store_->RequestCompleted(names_[0], 10ms, true);
+  store_->RequestCompleted(names_[1], 20ms, true);
+
+  Start();
+
+  ASSERT_TRUE(WaitForRequests(peers_[0], 1));
+  EXPECT_EQ(peers_[1]->NumRequests(), 0);
+  peers_[0]->Fail();
+
+  ASSERT_TRUE(WaitForRequests(peers_[1], 1));
+  EXPECT_FALSE(result_->IsWoken());
+  peers_[1]->Reply(3);
+
+  ASSERT_TRUE(WaitForResult());
+  EXPECT_EQ(result_->get()->identifiers_size(), 3);
+
+  // the failure is recorded as a very slow response
+  auto const failed_latency =
+      10.0 + SearchPeerStore::LATENCY_SMOOTHING * (SearchPeerStore::FAILURE_LATENCY_MS - 10.0);
+  EXPECT_DOUBLE_EQ(store_->ExpectedLatency(names_[0]), failed_latency);
+}
+
+TEST_F(SearchBroadcastTests, SlowPeersAreHedged)
+{
+  Policy policy{};
+  policy.fanout        = 1;
+  policy.hedge_delay   = 50ms;
+  policy.result_target = 1;
+  CreatePeers(2, policy);
+
+  store_->RequestCompleted(names_[0], 10ms, true);
+  store_->RequestCompleted(names_[1], 20ms, true);
+
+  Start();
+
+  // the first peer does not respond within the hedge delay
+  ASSERT_TRUE(WaitForRequests(peers_[0], 1));
+  ASSERT_TRUE(WaitForRequests(peers_[1], 1));
+  EXPECT_FALSE(result_->IsWoken());
+  peers_[1]->Reply(1);
+
+  ASSERT_TRUE(WaitForResult());
+  EXPECT_EQ(result_->get()->identifiers_size(), 1);
+
+  // the late response only updates the statistics of the peer
+  peers_[0]->Reply(5);
+  ASSERT_TRUE(WaitFor([this] { return store_->ExpectedLatency(names_[0]) > 10.0; }));
+  EXPECT_EQ(result_->get()->identifiers_size(), 1);
+}
+
+TEST_F(SearchBroadcastTests, SearchCompletesOnceTheResultTargetIsReached)
+{
+  Policy policy{};
+  policy.result_target = 2;
+  CreatePeers(3, policy);
+
+  Start();
+
+  for (auto const &peer : peers_)
+  {
+    ASSERT_TRUE(WaitForRequests(peer, 1));
+  }
+
+  // the other peers are still outstanding
+  peers_[1]->Reply(2);
+
+  ASSERT_TRUE(WaitForResult());
+  EXPECT_EQ(result_->get()->identifiers_size(), 2);
+
+  peers_[0]->Reply(1);
+  peers_[2]->Reply(1);
+}
+
+TEST_F(SearchBroadcastTests, SearchWithoutPeersCompletesImmediately)
+{
+  CreatePeers(0, Policy{});
+  Start();
+
+  ASSERT_TRUE(WaitForResult());
+  EXPECT_EQ(result_->get()->identifiers_size(), 0);
+}
+
+}  // namespace
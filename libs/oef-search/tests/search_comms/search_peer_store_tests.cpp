@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "oef-search/search_comms/SearchPeerStore.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using Peers = std::vector<std::string>;
+
+TEST(SearchPeerStoreTests, PeersAreRankedByLatency)
+{
+  SearchPeerStore store;
+  store.AddPeer("slow");
+  store.AddPeer("fast");
+  store.AddPeer("medium");
+
+  store.RequestCompleted("slow", 300ms, true);
+  store.RequestCompleted("fast", 10ms, true);
+  store.RequestCompleted("medium", 50ms, true);
+
+  EXPECT_EQ(store.RankPeers(), (Peers{"fast", "medium", "slow"}));
+  EXPECT_DOUBLE_EQ(store.ExpectedLatency("fast"), 10.0);
+}
+
+TEST(SearchPeerStoreTests, UnmeasuredPeersAreRankedFirst)
+{
+  SearchPeerStore store;
+  store.AddPeer("measured");
+  store.AddPeer("new");
+
+  store.RequestCompleted("measured", 1ms, true);
+
+  EXPECT_EQ(store.RankPeers(), (Peers{"new", "measured"}));
+  EXPECT_DOUBLE_EQ(store.ExpectedLatency("new"), 0.0);
+}
+
+TEST(SearchPeerStoreTests, LatencyIsSmoothed)
+{
+  SearchPeerStore store;
+  store.AddPeer("peer");
+
+  store.RequestCompleted("peer", 100ms, true);
+  store.RequestCompleted("peer", 200ms, true);
+
+  auto const expected = 100.0 + SearchPeerStore::LATENCY_SMOOTHING * (200.0 - 100.0);
+  EXPECT_DOUBLE_EQ(store.ExpectedLatency("peer"), expected);
+}
+
+TEST(SearchPeerStoreTests, OutstandingRequestsIncreaseTheExpectedLatency)
+{
+  SearchPeerStore store;
+  store.AddPeer("busy");
+  store.AddPeer("idle");
+
+  store.RequestCompleted("busy", 10ms, true);
+  store.RequestCompleted("idle", 25ms, true);
+  EXPECT_EQ(store.RankPeers(), (Peers{"busy", "idle"}));
+
+  store.RequestStarted("busy");
+  store.RequestStarted("busy");
+  EXPECT_DOUBLE_EQ(store.ExpectedLatency("busy"), 30.0);
+  EXPECT_EQ(store.RankPeers(), (Peers{"idle", "busy"}));
+
+  store.RequestCompleted("busy", 10ms, true);
+  store.RequestCompleted("busy", 10ms, true);
+  EXPECT_EQ(store.RankPeers(), (Peers{"busy", "idle"}));
+}
+
+TEST(SearchPeerStoreTests, FailuresCountAsSlowResponses)
+{
+  SearchPeerStore store;
+  store.AddPeer("failing");
+  store.AddPeer("slow");
+
+  store.RequestStarted("failing");
+  store.RequestCompleted("failing", 1ms, false);
+  store.RequestCompleted("slow", 1000ms, true);
+
+  EXPECT_DOUBLE_EQ(store.ExpectedLatency("failing"), SearchPeerStore::FAILURE_LATENCY_MS);
+  EXPECT_EQ(store.RankPeers(), (Peers{"slow", "failing"}));
+}
+
+TEST(SearchPeerStoreTests, UnknownPeersAreIgnored)
+{
+  SearchPeerStore store;
+  store.AddPeer("peer");
+
+  store.RequestStarted("unknown");
+  store.RequestCompleted("unknown", 10ms, true);
+
+  EXPECT_EQ(store.RankPeers(), (Peers{"peer"}));
+  EXPECT_DOUBLE_EQ(store.ExpectedLatency("unknown"), 0.0);
+}
+
+}  // namespace
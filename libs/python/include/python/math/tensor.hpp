@@ -0,0 +1,90 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/matrix_operations.hpp"
+#include "math/tensor/tensor.hpp"
+#include "python/fetch_pybind.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace math {
+
+/**
+ * Binds a tensor type which implements the buffer protocol. numpy.asarray(tensor) is a view of the
+ * storage of the tensor, in its column major (padded) layout, and is not copied. Constructing a
+ * tensor from a NumPy array copies it, since tensor storage is aligned and padded.
+ */
+template <typename T>
+void BuildTensor(std::string const &custom_name, pybind11::module &module)
+{
+  namespace py = pybind11;
+
+  using TensorType = Tensor<T>;
+  using SizeVector = typename TensorType::SizeVector;
+  using ArrayType  = py::array_t<T, py::array::f_style | py::array::forcecast>;
+
+  py::class_<TensorType>(module, custom_name.c_str(), py::buffer_protocol())
+      .def(py::init<>())
+      .def(py::init<SizeVector const &>())
+      .def(py::init([](ArrayType const &array) {
+        SizeVector shape(array.shape(), array.shape() + array.ndim());
+        TensorType tensor(shape);
+
+        T const *source = array.data();
+
+        py::gil_scoped_release release;
+        auto                   it = tensor.begin();
+        while (it.is_valid())
+        {
+          *it = *source++;
+          ++it;
+        }
+        return tensor;
+      }))
+      .def_buffer([](TensorType &tensor) {
+        std::vector<py::ssize_t> shape;
+        std::vector<py::ssize_t> strides;
+        for (std::size_t i = 0; i < tensor.shape().size(); ++i)
+        {
+          shape.emplace_back(static_cast<py::ssize_t>(tensor.shape()[i]));
+          strides.emplace_back(static_cast<py::ssize_t>(tensor.stride()[i] * sizeof(T)));
+        }
+
+        return py::buffer_info(tensor.data().pointer(), sizeof(T),
+                               py::format_descriptor<T>::format(),
+                               static_cast<py::ssize_t>(shape.size()), shape, strides);
+      })
+      .def("shape", [](TensorType const &tensor) { return tensor.shape(); })
+      .def("size", &TensorType::size)
+      .def("Copy", static_cast<TensorType (TensorType::*)() const>(&TensorType::Copy),
+           py::call_guard<py::gil_scoped_release>())
+      .def("Fill", static_cast<void (TensorType::*)(T const &)>(&TensorType::Fill),
+           py::call_guard<py::gil_scoped_release>())
+      .def("FillUniformRandom", &TensorType::FillUniformRandom,
+           py::return_value_policy::reference_internal, py::call_guard<py::gil_scoped_release>())
+      .def("ToString", &TensorType::ToString)
+      .def("Dot", [](TensorType const &a, TensorType const &b) { return Dot(a, b); },
+           py::call_guard<py::gil_scoped_release>());
+}
+
+}  // namespace math
+}  // namespace fetch
@@ -25,7 +25,7 @@ namespace byte_array {
 void BuildByteArray(pybind11::module &module)
 {
   namespace py = pybind11;
-  py::class_<ByteArray, ConstByteArray>(module, "ByteArray")
+  py::class_<ByteArray, ConstByteArray>(module, "ByteArray", py::buffer_protocol())
       .def(py::init<>())
       .def(py::init<char const *>())
       .def(py::init<std::string const &>())
@@ -37,6 +37,11 @@ void BuildByteArray(pybind11::module &module)
       .def(py::init<fetch::byte_array::ByteArray::SuperType const &, std::size_t const &,
                     std::size_t const &>())
       .def(py::self + fetch::byte_array::ByteArray())
+      .def_buffer([](ByteArray &a) {
+        return py::buffer_info(a.pointer(), sizeof(uint8_t),
+                               py::format_descriptor<uint8_t>::format(), 1,
+                               {static_cast<py::ssize_t>(a.size())}, {sizeof(uint8_t)});
+      })
       .def("Resize", &ByteArray::Resize)
       .def("Reserve", &ByteArray::Reserve);
 }
@@ -25,7 +25,7 @@ namespace byte_array {
 void BuildConstByteArray(pybind11::module &module)
 {
   namespace py = pybind11;
-  py::class_<ConstByteArray>(module, "ConstByteArray")
+  py::class_<ConstByteArray>(module, "ConstByteArray", py::buffer_protocol())
       .def(py::init<>())
       .def(py::init<std::size_t const &>())
       .def(py::init<char const *>())
@@ -35,6 +35,20 @@ void BuildConstByteArray(pybind11::module &module)
       .def(py::init<fetch::byte_array::ConstByteArray::SelfType const &>())
       .def(py::init<fetch::byte_array::ConstByteArray::SelfType const &, std::size_t const &,
                     std::size_t const &>())
+      .def(py::init([](py::buffer const &buffer) {
+        py::buffer_info info = buffer.request();
+        auto const      size = static_cast<std::size_t>(info.size * info.itemsize);
+
+        // the buffer has to be copied, as its memory is not owned by the byte array
+        py::gil_scoped_release release;
+        return ConstByteArray(static_cast<uint8_t const *>(info.ptr), size);
+      }))
+      .def_buffer([](ConstByteArray const &a) {
+        // a read only view of the bytes, which keeps the byte array alive
+        return py::buffer_info(const_cast<uint8_t *>(a.pointer()), sizeof(uint8_t),
+                               py::format_descriptor<uint8_t>::format(), 1,
+                               {static_cast<py::ssize_t>(a.size())}, {sizeof(uint8_t)}, true);
+      })
       .def("AsInt", &ConstByteArray::AsInt)
       .def(py::self != fetch::byte_array::ConstByteArray::SelfType())
       .def(py::self < fetch::byte_array::ConstByteArray::SelfType())
@@ -46,8 +60,8 @@ void BuildConstByteArray(pybind11::module &module)
            static_cast<ConstByteArray (ConstByteArray::*)(std::size_t, std::size_t) const>(
                &ConstByteArray::SubArray))
       .def("capacity", &ConstByteArray::capacity)
-      .def("Copy", &ConstByteArray::Copy)
-      .def("Find", &ConstByteArray::Find)
+      .def("Copy", &ConstByteArray::Copy, py::call_guard<py::gil_scoped_release>())
+      .def("Find", &ConstByteArray::Find, py::call_guard<py::gil_scoped_release>())
       .def("Match",
            static_cast<bool (ConstByteArray::*)(fetch::byte_array::ConstByteArray::SelfType const &,
                                                 std::size_t) const>(&ConstByteArray::Match))
@@ -24,6 +24,8 @@
 #include "python/byte_array/byte_array.hpp"
 #include "python/byte_array/const_byte_array.hpp"
 
+#include "python/math/tensor.hpp"
+
 #include "python/random/lcg.hpp"
 #include "python/random/lfg.hpp"
 
@@ -36,6 +38,7 @@ PYBIND11_MODULE(fetch, module)
   py::module ns_fetch_basic      = module.def_submodule("basic");
   py::module ns_fetch_byte_array = module.def_submodule("byte_array");
   py::module ns_fetch_serializer = module.def_submodule("serializers");
+  py::module ns_fetch_math       = module.def_submodule("math");
 
   fetch::memory::BuildArray<int8_t>("ArrayInt8", ns_fetch_basic);
   fetch::memory::BuildArray<int16_t>("ArrayInt16", ns_fetch_basic);
@@ -63,6 +66,9 @@ PYBIND11_MODULE(fetch, module)
   fetch::memory::BuildSharedArray<float>("SharedArrayFloat", ns_fetch_basic);
   fetch::memory::BuildSharedArray<double>("SharedArrayDouble", ns_fetch_basic);
 
+  fetch::math::BuildTensor<float>("TensorFloat", ns_fetch_math);
+  fetch::math::BuildTensor<double>("TensorDouble", ns_fetch_math);
+
   fetch::byte_array::BuildConstByteArray(ns_fetch_byte_array);
   fetch::byte_array::BuildByteArray(ns_fetch_byte_array);
 
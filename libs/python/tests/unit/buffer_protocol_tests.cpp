@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "math/tensor/tensor.hpp"
+#include "python/byte_array/byte_array.hpp"
+#include "python/byte_array/const_byte_array.hpp"
+#include "python/fetch_pybind.hpp"
+#include "python/math/tensor.hpp"
+
+#include "pybind11/embed.h"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+PYBIND11_EMBEDDED_MODULE(fetch, module)
+{
+  py::module ns_fetch_byte_array = module.def_submodule("byte_array");
+  py::module ns_fetch_math       = module.def_submodule("math");
+
+  fetch::math::BuildTensor<double>("TensorDouble", ns_fetch_math);
+
+  fetch::byte_array::BuildConstByteArray(ns_fetch_byte_array);
+  fetch::byte_array::BuildByteArray(ns_fetch_byte_array);
+}
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+
+using Tensor     = fetch::math::Tensor<double>;
+using SizeVector = Tensor::SizeVector;
+
+class BufferProtocolTests : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    interpreter_ = std::make_unique<py::scoped_interpreter>();
+  }
+
+  static void TearDownTestCase()
+  {
+    interpreter_.reset();
+  }
+
+  void SetUp() override
+  {
+    locals_ = std::make_unique<py::dict>();
+    (*locals_)["fetch"] = py::module::import("fetch");
+  }
+
+  void TearDown() override
+  {
+    locals_.reset();
+  }
+
+  /**
+   * Makes a C++ object available to the Python code under the specified name, without copying it
+   *
+   * @param name The name of the variable
+   * @param value The object to be referenced
+   */
+  template <typename T>
+  void Share(std::string const &name, T &value)
+  {
+    (*locals_)[name.c_str()] = py::cast(&value, py::return_value_policy::reference);
+  }
+
+  void Exec(std::string const &code)
+  {
+    py::exec(code, py::globals(), *locals_);
+  }
+
+  template <typename T>
+  T Eval(std::string const &expression)
+  {
+    return py::eval(expression, py::globals(), *locals_).cast<T>();
+  }
+
+  static std::unique_ptr<py::scoped_interpreter> interpreter_;
+  std::unique_ptr<py::dict>                      locals_;
+};
+
+std::unique_ptr<py::scoped_interpreter> BufferProtocolTests::interpreter_;
+
+Tensor CreateTensor()
+{
+  Tensor tensor(SizeVector{2, 3});
+  for (uint64_t i = 0; i < 2; ++i)
+  {
+    for (uint64_t j = 0; j < 3; ++j)
+    {
+      tensor.At(i, j) = static_cast<double>(10 * i + j);
+    }
+  }
+
+  return tensor;
+}
+
+TEST_F(BufferProtocolTests, TensorBufferHasTheShapeAndValuesOfTheTensor)
+{
+  auto tensor = CreateTensor();
+  Share("tensor", tensor);
+
+  Exec("view = memoryview(tensor)");
+
+  EXPECT_EQ(Eval<std::string>("view.format"), "d");
+  EXPECT_EQ(Eval<SizeVector>("view.shape"), SizeVector({2, 3}));
+  EXPECT_EQ(Eval<std::vector<std::vector<double>>>("view.tolist()"),
+            std::vector<std::vector<double>>({{0, 1, 2}, {10, 11, 12}}));
+}
+
+TEST_F(BufferProtocolTests, TensorBufferFollowsThePaddedColumnMajorLayout)
+{
+  auto tensor = CreateTensor();
+  Share("tensor", tensor);
+
+  auto const strides = Eval<SizeVector>("memoryview(tensor).strides");
+
+  ASSERT_EQ(strides.size(), 2u);
+  EXPECT_EQ(strides[0], tensor.stride()[0] * sizeof(double));
+  EXPECT_EQ(strides[1], tensor.stride()[1] * sizeof(double));
+  EXPECT_FALSE(Eval<bool>("memoryview(tensor).c_contiguous"));
+}
+
+TEST_F(BufferProtocolTests, TensorBufferIsNotACopy)
+{
+  auto tensor = CreateTensor();
+  Share("tensor", tensor);
+
+  Exec("memoryview(tensor)[1, 0] = 42.0");
+  EXPECT_EQ(tensor.At(1, 0), 42.0);
+
+  tensor.At(0, 2) = 7.0;
+  EXPECT_EQ(Eval<double>("memoryview(tensor)[0, 2]"), 7.0);
+}
+
+TEST_F(BufferProtocolTests, TensorCopyIsIndependentOfTheTensor)
+{
+  auto tensor = CreateTensor();
+  Share("tensor", tensor);
+
+  Exec("copy = tensor.Copy()");
+  tensor.At(1, 1) = -1.0;
+
+  EXPECT_EQ(Eval<double>("memoryview(copy)[1, 1]"), 11.0);
+}
+
+TEST_F(BufferProtocolTests, ConstByteArrayBufferIsReadOnly)
+{
+  ConstByteArray bytes{"hello"};
+  Share("bytes", bytes);
+
+  EXPECT_TRUE(Eval<bool>("memoryview(bytes).readonly"));
+  EXPECT_EQ(Eval<std::string>("memoryview(bytes).tobytes().decode()"), "hello");
+  EXPECT_THROW(Exec("memoryview(bytes)[0] = 0"), py::error_already_set);
+  EXPECT_EQ(bytes, ConstByteArray{"hello"});
+}
+
+TEST_F(BufferProtocolTests, ByteArrayBufferIsNotACopy)
+{
+  ByteArray bytes{"hello"};
+  Share("bytes", bytes);
+
+  EXPECT_FALSE(Eval<bool>("memoryview(bytes).readonly"));
+
+  Exec("memoryview(bytes)[0] = ord('j')");
+  EXPECT_EQ(bytes, ConstByteArray{"jello"});
+}
+
+TEST_F(BufferProtocolTests, ConstByteArrayIsBuiltFromAnyBuffer)
+{
+  Exec("bytes = fetch.byte_array.ConstByteArray(bytearray(b'a\\x00b'))");
+
+  auto const bytes = Eval<ConstByteArray>("bytes");
+  EXPECT_EQ(bytes.size(), 3u);
+  EXPECT_EQ(bytes[0], 'a');
+  EXPECT_EQ(bytes[1], 0);
+  EXPECT_EQ(bytes[2], 'b');
+}
+
+}  // namespace
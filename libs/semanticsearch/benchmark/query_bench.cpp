@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "semanticsearch/query/query_compiler.hpp"
+#include "semanticsearch/query/query_executor.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fetch::semanticsearch;
+
+namespace {
+
+using Int        = QueryExecutor::Int;
+using Float      = QueryExecutor::Float;
+using ModelField = QueryExecutor::ModelField;
+
+constexpr std::size_t NUM_AGENTS = 10000;
+
+char const *MODELS = R"(
+model Location {
+  lat: BoundedFloat(0., 90.),
+  lng: BoundedFloat(0., 180.)
+};
+
+model Vehicle {
+  location: Location,
+  seats: BoundedInteger(1, 10)
+};
+)";
+
+char const *ADVERTISEMENT = R"(
+var location : Location = {
+  lat: 51.5,
+  lng: 0.12
+};
+
+var vehicle : Vehicle = {
+  location: location,
+  seats: 4
+};
+
+store vehicle;
+)";
+
+ModelField BoundedInteger(Int from, Int to)
+{
+  auto            span = static_cast<uint64_t>(to - from);
+  SemanticReducer cdr;
+  cdr.SetReducer<Int>(1, [span, from](Int x) {
+    SemanticPosition ret;
+    ret.push_back(static_cast<uint64_t>(x - from) * (uint64_t(-1) / span));
+    return ret;
+  });
+  cdr.SetValidator<Int>([from, to](Int x) { return (from <= x) && (x <= to); });
+
+  auto instance = DataToSubspaceMap<Int>::New();
+  instance->SetSemanticReducer(cdr);
+  return instance;
+}
+
+ModelField BoundedFloat(Float from, Float to)
+{
+  auto            span = to - from;
+  SemanticReducer cdr;
+  cdr.SetReducer<Float>(1, [span, from](Float x) {
+    SemanticPosition ret;
+    ret.push_back(static_cast<uint64_t>((x - from) * (static_cast<Float>(uint64_t(-1)) / span)));
+    return ret;
+  });
+  cdr.SetValidator<Float>([from, to](Float x) { return (from <= x) && (x <= to); });
+
+  auto instance = DataToSubspaceMap<Float>::New();
+  instance->SetSemanticReducer(cdr);
+  return instance;
+}
+
+/**
+ * A module with the models defined and a populated agent directory
+ */
+SharedSemanticSearchModule NewModule(std::vector<Agent> &agents)
+{
+  auto module = SemanticSearchModule::New(std::make_shared<AdvertisementRegister>());
+  module->RegisterType<Int>("Int");
+  module->RegisterType<Float>("Float");
+  module->RegisterType<ModelField>("ModelField", true);
+  module->RegisterFunction<ModelField, Int, Int>("BoundedInteger", BoundedInteger);
+  module->RegisterFunction<ModelField, Float, Float>("BoundedFloat", BoundedFloat);
+
+  ErrorTracker  error_tracker;
+  QueryCompiler compiler(error_tracker);
+  QueryExecutor executor(module, error_tracker);
+  executor.Execute(compiler(MODELS), nullptr);
+
+  agents.clear();
+  for (std::size_t i = 0; i < NUM_AGENTS; ++i)
+  {
+    auto pk = "agent" + std::to_string(i);
+    module->RegisterAgent(pk);
+    agents.push_back(module->GetAgent(pk));
+  }
+
+  return module;
+}
+
+void BM_CompileAndExecuteQuery(benchmark::State &state)
+{
+  std::vector<Agent> agents;
+  auto               module = NewModule(agents);
+  std::size_t        i      = 0;
+
+  for (auto _ : state)
+  {
+    ErrorTracker  error_tracker;
+    QueryCompiler compiler(error_tracker);
+    QueryExecutor executor(module, error_tracker);
+    executor.Execute(compiler(ADVERTISEMENT), agents[i++ % agents.size()]);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ExecuteCachedQuery(benchmark::State &state)
+{
+  std::vector<Agent> agents;
+  auto               module = NewModule(agents);
+  std::size_t        i      = 0;
+
+  ErrorTracker  error_tracker;
+  QueryCompiler compiler(error_tracker, module);
+
+  for (auto _ : state)
+  {
+    QueryExecutor executor(module, error_tracker);
+    executor.Execute(*compiler.Compile(ADVERTISEMENT), agents[i++ % agents.size()]);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_CompileAndExecuteQuery);
+BENCHMARK(BM_ExecuteCachedQuery);
@@ -28,7 +28,9 @@ public:
   virtual ~DatabaseIndexInterface() = default;
 
   virtual void          AddRelation(SemanticSubscription const &obj)                        = 0;
+  virtual void          RemoveRelation(SemanticSubscription const &obj)                     = 0;
   virtual DBIndexSetPtr Find(SemanticCoordinateType depth, SemanticPosition position) const = 0;
+  virtual DBIndexList   FindNearest(SemanticPosition const &position, std::size_t k) const  = 0;
   virtual std::size_t   rank() const                                                        = 0;
 };
 
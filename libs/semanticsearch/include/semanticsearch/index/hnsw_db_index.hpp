@@ -0,0 +1,112 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "semanticsearch/index/base_types.hpp"
+#include "semanticsearch/index/database_index_interface.hpp"
+#include "semanticsearch/index/semantic_subscription.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace semanticsearch {
+
+/* Approximate nearest neighbour index based on a hierarchical navigable small world (HNSW)
+ * graph. Unlike the hypercube subscription groups of the InMemoryDBIndex its cost grows
+ * slowly with the rank of the space, which makes it suitable for vocabularies with 100+
+ * dimensions.
+ *
+ * Every record is a node of a layered proximity graph. Layer 0 contains all nodes, and every
+ * higher layer a randomly selected, exponentially smaller, subset of the one below. A search
+ * greedily descends from the single node of the top layer towards the query and finishes with a
+ * best first search of layer 0, giving logarithmic query times with a high recall.
+ *
+ * Positions are mapped onto [0, 1) per axis and distances are Euclidean in this space. Removed
+ * records are marked and skipped in results; once they make up half of the graph it is rebuilt
+ * from the remaining records.
+ */
+class HNSWDBIndex : public DatabaseIndexInterface
+{
+public:
+  static constexpr std::size_t DEFAULT_MAX_NEIGHBOURS  = 16;
+  static constexpr std::size_t DEFAULT_EF_CONSTRUCTION = 200;
+  static constexpr std::size_t DEFAULT_EF_SEARCH       = 64;
+
+  explicit HNSWDBIndex(std::size_t rank, std::size_t max_neighbours = DEFAULT_MAX_NEIGHBOURS,
+                       std::size_t ef_construction = DEFAULT_EF_CONSTRUCTION,
+                       std::size_t ef_search       = DEFAULT_EF_SEARCH);
+
+  void          AddRelation(SemanticSubscription const &obj) override;
+  void          RemoveRelation(SemanticSubscription const &obj) override;
+  DBIndexSetPtr Find(SemanticCoordinateType depth, SemanticPosition position) const override;
+  DBIndexList   FindNearest(SemanticPosition const &position, std::size_t k) const override;
+  std::size_t   rank() const override;
+
+  std::size_t size() const;
+
+private:
+  using NodeId    = uint32_t;
+  using Links     = std::vector<NodeId>;
+  using Candidate = std::pair<float, NodeId>;  ///< Squared distance and node
+  using Vector    = std::vector<float>;
+
+  struct Node
+  {
+    DBIndexType        index{};
+    std::vector<Links> links{};  ///< Neighbours on every layer the node is part of
+    bool               removed{false};
+  };
+
+  Vector      ToVector(SemanticPosition const &position) const;
+  float       Distance(float const *query, NodeId node) const;
+  std::size_t MaxLinks(std::size_t layer) const;
+  std::size_t RandomLayer();
+
+  std::vector<Candidate> Search(float const *query, std::size_t ef) const;
+  std::vector<Candidate> SearchLayer(float const *query, NodeId entry, std::size_t ef,
+                                     std::size_t layer) const;
+  NodeId GreedyDescent(float const *query, NodeId entry, std::size_t layer) const;
+
+  void  Insert(DBIndexType index, Vector const &vector);
+  Links SelectNeighbours(std::vector<Candidate> const &candidates, std::size_t max_links) const;
+  void  Connect(NodeId node, NodeId neighbour, std::size_t layer);
+  void  Rebuild();
+
+  std::size_t rank_;
+  std::size_t max_neighbours_;
+  std::size_t ef_construction_;
+  std::size_t ef_search_;
+  double      level_multiplier_;
+
+  std::vector<Node> nodes_{};
+  Vector            vectors_{};  ///< Positions of the nodes, rank_ values per node
+  NodeId            entry_point_{0};
+  std::size_t       top_layer_{0};
+  std::size_t       num_removed_{0};
+
+  std::unordered_multimap<DBIndexType, NodeId> nodes_by_index_{};
+  std::mt19937_64                              rng_{};
+};
+
+}  // namespace semanticsearch
+}  // namespace fetch
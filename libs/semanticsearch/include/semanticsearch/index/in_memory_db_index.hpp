@@ -100,7 +100,9 @@ class InMemoryDBIndex : public DatabaseIndexInterface
 public:
   explicit InMemoryDBIndex(std::size_t rank);
   void          AddRelation(SemanticSubscription const &obj) override;
+  void          RemoveRelation(SemanticSubscription const &obj) override;
   DBIndexSetPtr Find(SemanticCoordinateType depth, SemanticPosition position) const override;
+  DBIndexList   FindNearest(SemanticPosition const &position, std::size_t k) const override;
   std::size_t   rank() const override;
 
 private:
@@ -28,6 +28,20 @@
 namespace fetch {
 namespace semanticsearch {
 
+/* Type codes of the values on the stack of the query executor. */
+enum QueryVariantType
+{
+  TYPE_NONE  = 0,
+  TYPE_MODEL = 10,
+  TYPE_INSTANCE,
+  TYPE_KEY,
+  TYPE_STRING,
+  TYPE_INTEGER,
+  TYPE_FLOAT,
+
+  TYPE_FUNCTION_NAME
+};
+
 class AbstractQueryVariant
 {
 public:
@@ -24,23 +24,53 @@
 
 #include "semanticsearch/query/error_tracker.hpp"
 #include "semanticsearch/query/query.hpp"
+#include "semanticsearch/semantic_search_module.hpp"
 
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace fetch {
 namespace semanticsearch {
 
+/* Compiles query documents into programs for the QueryExecutor.
+ *
+ * When created with a SemanticSearchModule the compiler resolves literals, field types and
+ * functions while compiling, so that the executor does not need to look them up by name, and
+ * keeps the compiled programs in a cache indexed by their source. Repeated queries are then only
+ * compiled once, until the module changes its types, models or functions.
+ */
 class QueryCompiler
 {
 public:
   using ConstByteArray = fetch::byte_array::ConstByteArray;
   using ByteArray      = fetch::byte_array::ByteArray;
   using Token          = fetch::byte_array::Token;
+  using SharedQuery    = std::shared_ptr<Query const>;
+
+  static constexpr std::size_t DEFAULT_CACHE_SIZE = 256;
 
   explicit QueryCompiler(ErrorTracker &error_tracker);
-  Query operator()(ByteArray doc, ConstByteArray const &filename = "(internal)");
+  QueryCompiler(ErrorTracker &error_tracker, SharedSemanticSearchModule module,
+                std::size_t cache_size = DEFAULT_CACHE_SIZE);
+
+  Query       operator()(ByteArray doc, ConstByteArray const &filename = "(internal)");
+  SharedQuery Compile(ByteArray doc, ConstByteArray const &filename = "(internal)");
+
+  std::size_t cache_size() const;
 
 private:
+  struct CachedQuery
+  {
+    SharedQuery query;
+    uint64_t    generation;
+  };
+
+  Query Assemble(ByteArray doc, ConstByteArray const &filename);
+  void  Resolve(CompiledStatement &stmt, std::unordered_set<std::string> &defined_models) const;
+
   struct Statement
   {
     std::vector<Token> tokens;
@@ -66,6 +96,11 @@ private:
 
   std::vector<Statement> statements_;
 
+  SharedSemanticSearchModule                      module_{};
+  std::size_t                                     max_cache_size_{0};
+  std::unordered_map<ConstByteArray, CachedQuery> cache_{};
+  std::deque<ConstByteArray>                      cache_order_{};
+
   std::vector<ConstByteArray> keywords_ = {"model", "store", "find", "var", "subspace", "schema"};
 };
 
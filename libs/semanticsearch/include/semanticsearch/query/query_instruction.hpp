@@ -17,6 +17,8 @@
 //
 //------------------------------------------------------------------------------
 
+#include "semanticsearch/query/abstract_query_variant.hpp"
+
 #include "core/byte_array/byte_array.hpp"
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/byte_array/consumers.hpp"
@@ -95,6 +97,10 @@ struct QueryInstruction
   uint64_t properties = PROP_NO_PROP;
   int      consumes   = 2;
   Token    token;
+
+  /// Literal value, field type or function resolved by the compiler. Null if the instruction
+  /// has to be resolved when it is executed.
+  QueryVariant value{};
 };
 
 using CompiledStatement = std::vector<QueryInstruction>;
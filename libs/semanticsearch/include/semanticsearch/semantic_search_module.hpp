@@ -67,6 +67,7 @@ public:
     }
     std::type_index idx = std::type_index(typeid(T));
     idx_to_name_[idx]   = name;
+    ++generation_;
   }
 
   Agent GetAgent(ConstByteArray const &pk)
@@ -79,6 +80,7 @@ public:
     auto model = PropertiesToSubspace::New();
     advertisement_register_->AddModel(name, model);
     types_[name] = model;
+    ++generation_;
     return ModelInterfaceBuilder{model, this};
   }
 
@@ -86,6 +88,7 @@ public:
   {
     advertisement_register_->AddModel(name, proxy.vocabulary_schema());
     types_[name] = proxy.vocabulary_schema();
+    ++generation_;
     return proxy;
   }
 
@@ -93,6 +96,7 @@ public:
   {
     advertisement_register_->AddModel(name, object);
     types_[name] = object;
+    ++generation_;
   }
 
   ModelInterfaceBuilder NewProxy()
@@ -148,6 +152,7 @@ public:
   {
     auto sig         = BuiltinQueryFunction::New<R, Args...>(function);
     functions_[name] = std::move(sig);
+    ++generation_;
   }
 
   template <typename R, typename... Args, typename F>
@@ -161,6 +166,16 @@ public:
     return *functions_[name];
   }
 
+  BuiltinQueryFunction::Function GetFunction(std::string const &name) const
+  {
+    auto it = functions_.find(name);
+    if (it == functions_.end())
+    {
+      return nullptr;
+    }
+    return it->second;
+  }
+
   QueryVariant Call(std::string const &name, std::vector<void const *> &args)
   {
     return (*functions_[name])(args);
@@ -176,6 +191,13 @@ public:
     return advertisement_register_;
   }
 
+  /// Incremented whenever a type, model or function is (re)defined. Compiled queries resolved
+  /// against an older generation may refer to replaced definitions.
+  uint64_t generation() const
+  {
+    return generation_;
+  }
+
   AgentId RegisterAgent(ConstByteArray const &pk)
   {
     return agent_directory_.RegisterAgent(pk);
@@ -196,6 +218,7 @@ private:
   std::unordered_map<std::string, ModelField>                     types_;
   SharedAdvertisementRegister                                     advertisement_register_;
   AgentDirectory                                                  agent_directory_;
+  uint64_t                                                        generation_{0};
 };
 
 using SharedSemanticSearchModule = SemanticSearchModule::SharedSemanticSearchModule;
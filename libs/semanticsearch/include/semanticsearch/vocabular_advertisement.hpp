@@ -37,7 +37,7 @@ public:
 
   explicit VocabularyAdvertisement(VocabularySchema vocabulary_schema)
     : vocabulary_schema_(std::move(vocabulary_schema))
-    , index_{static_cast<std::size_t>(vocabulary_schema->rank())}
+    , index_{static_cast<std::size_t>(vocabulary_schema_->rank())}
   {}
 
   void SubscribeAgent(AgentId aid, SemanticPosition position)
@@ -0,0 +1,457 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "semanticsearch/index/hnsw_db_index.hpp"
+#include "math/distance/pairwise_distance.hpp"
+#include "semanticsearch/index/subscription_group.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace fetch {
+namespace semanticsearch {
+namespace {
+
+constexpr double      COORDINATE_SCALE = 18446744073709551616.0;  // 2^64
+constexpr std::size_t MAX_LAYER        = 16;
+
+}  // namespace
+
+HNSWDBIndex::HNSWDBIndex(std::size_t rank, std::size_t max_neighbours,
+                         std::size_t ef_construction, std::size_t ef_search)
+  : rank_{rank}
+  , max_neighbours_{max_neighbours}
+  , ef_construction_{std::max(ef_construction, max_neighbours)}
+  , ef_search_{std::max<std::size_t>(ef_search, 1)}
+  , level_multiplier_{0.0}
+{
+  if (max_neighbours_ < 2)
+  {
+    throw std::runtime_error("HNSW index requires at least two neighbours per node.");
+  }
+
+  level_multiplier_ = 1.0 / std::log(static_cast<double>(max_neighbours_));
+}
+
+void HNSWDBIndex::AddRelation(SemanticSubscription const &obj)
+{
+  if (obj.position.size() != rank_)
+  {
+    throw std::runtime_error("Rank of position differs from index.");
+  }
+
+  Insert(obj.index, ToVector(obj.position));
+}
+
+void HNSWDBIndex::RemoveRelation(SemanticSubscription const &obj)
+{
+  if (obj.position.size() != rank_)
+  {
+    throw std::runtime_error("Rank of position differs from index.");
+  }
+
+  auto const vector = ToVector(obj.position);
+  auto const range  = nodes_by_index_.equal_range(obj.index);
+
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    auto const node = it->second;
+    if (std::equal(vector.begin(), vector.end(),
+                   vectors_.begin() + static_cast<std::ptrdiff_t>(node * rank_)))
+    {
+      nodes_[node].removed = true;
+      nodes_by_index_.erase(it);
+      ++num_removed_;
+      break;
+    }
+  }
+
+  if ((num_removed_ * 2) > nodes_.size())
+  {
+    Rebuild();
+  }
+}
+
+/**
+ * Find the records within the width of the subscription groups at a depth from a position
+ */
+DBIndexSetPtr HNSWDBIndex::Find(SemanticCoordinateType depth, SemanticPosition position) const
+{
+  if (position.size() != rank_)
+  {
+    throw std::runtime_error("Rank of position differs from index.");
+  }
+
+  auto const query = ToVector(position);
+  auto const radius =
+      static_cast<float>(static_cast<double>(SubscriptionGroup::CalculateWidthFromDepth(depth)) /
+                         COORDINATE_SCALE);
+  auto const radius_squared = radius * radius;
+
+  // widen the search until its furthest result is outside the radius
+  std::vector<Candidate> results{};
+  for (std::size_t ef = ef_search_;; ef *= 2)
+  {
+    results = Search(query.data(), ef);
+    if (results.empty() || (results.back().first > radius_squared) || (ef >= nodes_.size()))
+    {
+      break;
+    }
+  }
+
+  auto ret = std::make_shared<DBIndexSet>();
+  for (auto const &result : results)
+  {
+    if ((result.first <= radius_squared) && !nodes_[result.second].removed)
+    {
+      ret->insert(nodes_[result.second].index);
+    }
+  }
+
+  if (ret->empty())
+  {
+    return nullptr;
+  }
+
+  return ret;
+}
+
+/**
+ * Find the k records nearest to a position
+ *
+ * @param position The position
+ * @param k The number of records
+ * @return The records, nearest first
+ */
+DBIndexList HNSWDBIndex::FindNearest(SemanticPosition const &position, std::size_t k) const
+{
+  if (position.size() != rank_)
+  {
+    throw std::runtime_error("Rank of position differs from index.");
+  }
+
+  // removed nodes take up room in the results
+  auto const query   = ToVector(position);
+  auto const results = Search(query.data(), std::max(ef_search_, (num_removed_ > 0) ? 2 * k : k));
+
+  DBIndexList ret{};
+  for (auto it = results.begin(); (it != results.end()) && (ret.size() < k); ++it)
+  {
+    if (!nodes_[it->second].removed)
+    {
+      ret.push_back(nodes_[it->second].index);
+    }
+  }
+
+  return ret;
+}
+
+std::size_t HNSWDBIndex::rank() const
+{
+  return rank_;
+}
+
+std::size_t HNSWDBIndex::size() const
+{
+  return nodes_.size() - num_removed_;
+}
+
+HNSWDBIndex::Vector HNSWDBIndex::ToVector(SemanticPosition const &position) const
+{
+  Vector vector(position.size());
+  std::transform(position.begin(), position.end(), vector.begin(),
+                 [](SemanticCoordinateType coordinate) {
+                   return static_cast<float>(static_cast<double>(coordinate) / COORDINATE_SCALE);
+                 });
+  return vector;
+}
+
+float HNSWDBIndex::Distance(float const *query, NodeId node) const
+{
+  return math::distance::details::SquareDistanceKernel(query, vectors_.data() + (node * rank_),
+                                                       rank_);
+}
+
+std::size_t HNSWDBIndex::MaxLinks(std::size_t layer) const
+{
+  return (layer == 0) ? 2 * max_neighbours_ : max_neighbours_;
+}
+
+std::size_t HNSWDBIndex::RandomLayer()
+{
+  std::uniform_real_distribution<double> uniform{0.0, 1.0};
+
+  auto const layer = std::floor(-std::log(1.0 - uniform(rng_)) * level_multiplier_);
+  return std::min(static_cast<std::size_t>(layer), MAX_LAYER);
+}
+
+/**
+ * Search the whole graph
+ *
+ * @param query The position
+ * @param ef The number of results to keep track of
+ * @return Up to ef nodes near the position (including removed ones), nearest first
+ */
+std::vector<HNSWDBIndex::Candidate> HNSWDBIndex::Search(float const *query, std::size_t ef) const
+{
+  if (nodes_.empty())
+  {
+    return {};
+  }
+
+  NodeId entry = entry_point_;
+  for (std::size_t layer = top_layer_; layer > 0; --layer)
+  {
+    entry = GreedyDescent(query, entry, layer);
+  }
+
+  return SearchLayer(query, entry, ef, 0);
+}
+
+/**
+ * Best first search of a single layer of the graph
+ */
+std::vector<HNSWDBIndex::Candidate> HNSWDBIndex::SearchLayer(float const *query, NodeId entry,
+                                                             std::size_t ef,
+                                                             std::size_t layer) const
+{
+  using NearestFirst =
+      std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>>;
+  using FurthestFirst = std::priority_queue<Candidate>;
+
+  std::unordered_set<NodeId> visited{entry};
+  NearestFirst               candidates{};
+  FurthestFirst              results{};
+
+  auto const distance = Distance(query, entry);
+  candidates.emplace(distance, entry);
+  results.emplace(distance, entry);
+
+  while (!candidates.empty())
+  {
+    auto const current = candidates.top();
+    if ((results.size() >= ef) && (current.first > results.top().first))
+    {
+      break;
+    }
+    candidates.pop();
+
+    for (NodeId const neighbour : nodes_[current.second].links[layer])
+    {
+      if (!visited.insert(neighbour).second)
+      {
+        continue;
+      }
+
+      auto const d = Distance(query, neighbour);
+      if ((results.size() < ef) || (d < results.top().first))
+      {
+        candidates.emplace(d, neighbour);
+        results.emplace(d, neighbour);
+
+        if (results.size() > ef)
+        {
+          results.pop();
+        }
+      }
+    }
+  }
+
+  std::vector<Candidate> ret(results.size());
+  for (auto it = ret.rbegin(); it != ret.rend(); ++it)
+  {
+    *it = results.top();
+    results.pop();
+  }
+
+  return ret;
+}
+
+/**
+ * Walk a layer of the graph towards the query for as long as the distance decreases
+ */
+HNSWDBIndex::NodeId HNSWDBIndex::GreedyDescent(float const *query, NodeId entry,
+                                               std::size_t layer) const
+{
+  auto distance = Distance(query, entry);
+
+  bool improved = true;
+  while (improved)
+  {
+    improved = false;
+    for (NodeId const neighbour : nodes_[entry].links[layer])
+    {
+      auto const d = Distance(query, neighbour);
+      if (d < distance)
+      {
+        distance = d;
+        entry    = neighbour;
+        improved = true;
+      }
+    }
+  }
+
+  return entry;
+}
+
+void HNSWDBIndex::Insert(DBIndexType index, Vector const &vector)
+{
+  auto const node  = static_cast<NodeId>(nodes_.size());
+  auto const layer = RandomLayer();
+
+  nodes_.emplace_back();
+  nodes_.back().index = index;
+  nodes_.back().links.resize(layer + 1);
+  vectors_.insert(vectors_.end(), vector.begin(), vector.end());
+  nodes_by_index_.emplace(index, node);
+
+  if (node == 0)
+  {
+    entry_point_ = node;
+    top_layer_   = layer;
+    return;
+  }
+
+  NodeId entry = entry_point_;
+  for (std::size_t l = top_layer_; l > layer; --l)
+  {
+    entry = GreedyDescent(vector.data(), entry, l);
+  }
+
+  for (std::size_t l = std::min(layer, top_layer_) + 1; l > 0; --l)
+  {
+    auto const candidates = SearchLayer(vector.data(), entry, ef_construction_, l - 1);
+    auto const neighbours = SelectNeighbours(candidates, max_neighbours_);
+
+    nodes_[node].links[l - 1] = neighbours;
+    for (NodeId const neighbour : neighbours)
+    {
+      Connect(neighbour, node, l - 1);
+    }
+
+    entry = candidates.front().second;
+  }
+
+  if (layer > top_layer_)
+  {
+    entry_point_ = node;
+    top_layer_   = layer;
+  }
+}
+
+/**
+ * Choose the neighbours of a node from candidates ordered by distance. A candidate is skipped
+ * when it is closer to an already selected neighbour than to the node, which keeps links to
+ * different directions (and clusters); remaining slots are filled with the nearest skipped ones.
+ */
+HNSWDBIndex::Links HNSWDBIndex::SelectNeighbours(std::vector<Candidate> const &candidates,
+                                                 std::size_t                   max_links) const
+{
+  Links selected{};
+  Links skipped{};
+
+  for (auto const &candidate : candidates)
+  {
+    if (selected.size() >= max_links)
+    {
+      break;
+    }
+
+    float const *position = vectors_.data() + (candidate.second * rank_);
+
+    bool const diverse =
+        std::none_of(selected.begin(), selected.end(), [this, position, &candidate](NodeId other) {
+          return Distance(position, other) < candidate.first;
+        });
+
+    if (diverse)
+    {
+      selected.push_back(candidate.second);
+    }
+    else
+    {
+      skipped.push_back(candidate.second);
+    }
+  }
+
+  for (auto it = skipped.begin(); (it != skipped.end()) && (selected.size() < max_links); ++it)
+  {
+    selected.push_back(*it);
+  }
+
+  return selected;
+}
+
+/**
+ * Add a link to a node, pruning its links when there are too many
+ */
+void HNSWDBIndex::Connect(NodeId node, NodeId neighbour, std::size_t layer)
+{
+  auto &links = nodes_[node].links[layer];
+  links.push_back(neighbour);
+
+  auto const max_links = MaxLinks(layer);
+  if (links.size() <= max_links)
+  {
+    return;
+  }
+
+  float const *position = vectors_.data() + (node * rank_);
+
+  std::vector<Candidate> candidates{};
+  candidates.reserve(links.size());
+  for (NodeId const link : links)
+  {
+    candidates.emplace_back(Distance(position, link), link);
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  links = SelectNeighbours(candidates, max_links);
+}
+
+/**
+ * Build a new graph from the records which have not been removed
+ */
+void HNSWDBIndex::Rebuild()
+{
+  auto const nodes   = std::move(nodes_);
+  auto const vectors = std::move(vectors_);
+
+  nodes_.clear();
+  vectors_.clear();
+  nodes_by_index_.clear();
+  entry_point_ = 0;
+  top_layer_   = 0;
+  num_removed_ = 0;
+
+  for (std::size_t i = 0; i < nodes.size(); ++i)
+  {
+    if (!nodes[i].removed)
+    {
+      auto const first = vectors.begin() + static_cast<std::ptrdiff_t>(i * rank_);
+      Insert(nodes[i].index, Vector(first, first + static_cast<std::ptrdiff_t>(rank_)));
+    }
+  }
+}
+
+}  // namespace semanticsearch
+}  // namespace fetch
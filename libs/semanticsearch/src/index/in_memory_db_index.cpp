@@ -19,6 +19,7 @@
 #include "semanticsearch/index/in_memory_db_index.hpp"
 
 #include <cassert>
+#include <stdexcept>
 
 namespace fetch {
 namespace semanticsearch {
@@ -54,6 +55,29 @@ void InMemoryDBIndex::AddRelation(SemanticSubscription const &obj)
   }
 }
 
+void InMemoryDBIndex::RemoveRelation(SemanticSubscription const &obj)
+{
+  if (obj.position.size() != rank_)
+  {
+    throw std::runtime_error("Rank of position differs from index.");
+  }
+
+  for (SemanticCoordinateType s = param_depth_start_; s < param_depth_end_; ++s)
+  {
+    auto it = group_content_.find(SubscriptionGroup{s, obj.position});
+    if (it == group_content_.end())
+    {
+      continue;
+    }
+
+    it->second->erase(obj.index);
+    if (it->second->empty())
+    {
+      group_content_.erase(it);
+    }
+  }
+}
+
 DBIndexSetPtr InMemoryDBIndex::Find(SemanticCoordinateType depth, SemanticPosition position) const
 {
   // Again, only operations with same rank as index is allowed.
@@ -73,6 +97,31 @@ DBIndexSetPtr InMemoryDBIndex::Find(SemanticCoordinateType depth, SemanticPositi
   return it->second;
 }
 
+/**
+ * The index does not keep the positions of the records, so the nearest records are approximated
+ * by the smallest subscription group around the position holding at least k records. The
+ * results are not ordered by distance.
+ */
+DBIndexList InMemoryDBIndex::FindNearest(SemanticPosition const &position, std::size_t k) const
+{
+  DBIndexList ret{};
+
+  for (SemanticCoordinateType s = param_depth_end_; s > param_depth_start_; --s)
+  {
+    auto group = Find(s - 1, position);
+    if (group && ((group->size() >= k) || (s - 1 == param_depth_start_)))
+    {
+      for (auto it = group->begin(); (it != group->end()) && (ret.size() < k); ++it)
+      {
+        ret.push_back(*it);
+      }
+      break;
+    }
+  }
+
+  return ret;
+}
+
 std::size_t InMemoryDBIndex::rank() const
 {
   return rank_;
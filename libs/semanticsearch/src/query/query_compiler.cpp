@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "semanticsearch/query/query_compiler.hpp"
+#include "semanticsearch/query/query_executor.hpp"
 
 #include <cassert>
 
@@ -62,7 +63,71 @@ QueryCompiler::QueryCompiler(ErrorTracker &error_tracker)
   : error_tracker_(error_tracker)
 {}
 
+QueryCompiler::QueryCompiler(ErrorTracker &error_tracker, SharedSemanticSearchModule module,
+                             std::size_t cache_size)
+  : error_tracker_(error_tracker)
+  , module_{std::move(module)}
+  , max_cache_size_{cache_size}
+{}
+
 Query QueryCompiler::operator()(ByteArray doc, ConstByteArray const &filename)
+{
+  return *Compile(std::move(doc), filename);
+}
+
+/**
+ * Compile a query document, reusing the program of an earlier compilation of the same source if
+ * the module has not changed since.
+ *
+ * @param doc The source of the query
+ * @param filename The name used when reporting errors
+ * @return The compiled query
+ */
+QueryCompiler::SharedQuery QueryCompiler::Compile(ByteArray doc, ConstByteArray const &filename)
+{
+  uint64_t const generation = module_ ? module_->generation() : 0;
+
+  auto it = cache_.find(doc);
+  if ((it != cache_.end()) && (it->second.generation == generation) &&
+      (it->second.query->filename == filename))
+  {
+    error_tracker_.SetSource(it->second.query->source, filename);
+    return it->second.query;
+  }
+
+  // the key is copied as the caller may modify its document afterwards
+  ConstByteArray source = doc.Copy();
+  auto           query  = std::make_shared<Query const>(Assemble(std::move(doc), filename));
+
+  if ((max_cache_size_ == 0) || error_tracker_.HasErrors())
+  {
+    return query;
+  }
+
+  if (it != cache_.end())
+  {
+    it->second = CachedQuery{query, generation};
+    return query;
+  }
+
+  if (cache_.size() >= max_cache_size_)
+  {
+    cache_.erase(cache_order_.front());
+    cache_order_.pop_front();
+  }
+
+  cache_.emplace(source, CachedQuery{query, generation});
+  cache_order_.push_back(source);
+
+  return query;
+}
+
+std::size_t QueryCompiler::cache_size() const
+{
+  return cache_.size();
+}
+
+Query QueryCompiler::Assemble(ByteArray doc, ConstByteArray const &filename)
 {
   document_ = std::move(doc);
   statements_.clear();
@@ -76,15 +141,98 @@ Query QueryCompiler::operator()(ByteArray doc, ConstByteArray const &filename)
   Query ret;
   ret.source   = document_;
   ret.filename = filename;
+
+  std::unordered_set<std::string> defined_models;
   for (auto &s : statements_)
   {
     auto stmt = AssembleStatement(s);
-    ret.statements.push_back(stmt);
+    Resolve(stmt, defined_models);
+    ret.statements.push_back(std::move(stmt));
   }
 
   return ret;
 }
 
+/**
+ * Attach the values of literals, field types and functions to the instructions of a statement.
+ * Field types are only resolved if they are not (re)defined by the query itself, as the
+ * definition only takes place when the query is executed.
+ *
+ * @param stmt The statement to resolve
+ * @param defined_models The models defined by the preceding statements of the query
+ */
+void QueryCompiler::Resolve(CompiledStatement &               stmt,
+                            std::unordered_set<std::string> &defined_models) const
+{
+  using Type = QueryInstruction::Type;
+
+  if (stmt.empty())
+  {
+    return;
+  }
+
+  bool const is_model    = stmt[0].properties == QueryInstruction::PROP_CTX_MODEL;
+  int        scope_depth = 0;
+
+  for (auto &x : stmt)
+  {
+    switch (x.type)
+    {
+    case Type::PUSH_SCOPE:
+      ++scope_depth;
+      break;
+    case Type::POP_SCOPE:
+      --scope_depth;
+      break;
+    case Type::FLOAT:
+      x.value = NewQueryVariant(QueryExecutor::Float(x.token.AsFloat()), TYPE_FLOAT, x.token);
+      break;
+    case Type::INTEGER:
+      x.value = NewQueryVariant(QueryExecutor::Int(atol(std::string(x.token).c_str())),
+                                TYPE_INTEGER, x.token);
+      break;
+    case Type::STRING:
+      x.value = NewQueryVariant(static_cast<std::string>(x.token.SubArray(1, x.token.size() - 2)),
+                                TYPE_STRING, x.token);
+      break;
+    case Type::OBJECT_KEY:
+      x.value = NewQueryVariant(x.token, TYPE_KEY, x.token);
+      break;
+    case Type::FUNCTION:
+      if (module_)
+      {
+        auto function = module_->GetFunction(static_cast<std::string>(x.token));
+        if (function)
+        {
+          x.value = NewQueryVariant(std::move(function), TYPE_FUNCTION_NAME, x.token);
+        }
+      }
+      break;
+    case Type::IDENTIFIER:
+    {
+      if (!is_model)
+      {
+        break;
+      }
+
+      auto name = static_cast<std::string>(x.token);
+      if (scope_depth == 0)
+      {
+        defined_models.insert(std::move(name));
+      }
+      else if (module_ && (defined_models.find(name) == defined_models.end()) &&
+               module_->HasField(name))
+      {
+        x.value = NewQueryVariant(module_->GetField(name), TYPE_MODEL, x.token);
+      }
+      break;
+    }
+    default:
+      break;
+    }
+  }
+}
+
 std::vector<QueryInstruction> QueryCompiler::AssembleStatement(Statement const &stmt)
 {
   std::vector<QueryInstruction> main_stack;
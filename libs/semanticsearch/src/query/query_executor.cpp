@@ -158,7 +158,15 @@ void QueryExecutor::ExecuteSet(CompiledStatement const &stmt)
 
   while (i < stmt.size())
   {
-    auto x = stmt[i];
+    auto const &x = stmt[i];
+
+    // Values resolved by the compiler are used as they are
+    if (x.value)
+    {
+      stack.push_back(x.value);
+      ++i;
+      continue;
+    }
 
     switch (x.type)
     {
@@ -318,7 +326,14 @@ void QueryExecutor::ExecuteDefine(CompiledStatement const &stmt)
 
   while (i < stmt.size())
   {
-    auto x = stmt[i];
+    auto const &x = stmt[i];
+
+    if (x.value)
+    {
+      stack_.push_back(x.value);
+      ++i;
+      continue;
+    }
 
     switch (x.type)
     {
@@ -464,24 +479,34 @@ void QueryExecutor::ExecuteDefine(CompiledStatement const &stmt)
       std::reverse(args.begin(), args.end());
       std::reverse(arg_signature.begin(), arg_signature.end());
 
-      // Calling
-      if (TypeMismatch<Token>(stack_[n], stack_[n]->token()))
+      // Calling, the function may have been resolved by the compiler
+      BuiltinQueryFunction::Function function;
+      std::string                    function_name;
+      if (stack_[n]->IsType<BuiltinQueryFunction::Function>())
       {
-        return;
+        function      = stack_[n]->As<BuiltinQueryFunction::Function>();
+        function_name = static_cast<std::string>(stack_[n]->token());
+      }
+      else
+      {
+        if (TypeMismatch<Token>(stack_[n], stack_[n]->token()))
+        {
+          return;
+        }
+        function_name = static_cast<std::string>(stack_[n]->As<Token>());
+        function      = semantic_search_module_->GetFunction(function_name);
       }
-      auto function_name = static_cast<std::string>(stack_[n]->As<Token>());
 
-      if (!semantic_search_module_->HasFunction(function_name))
+      if (!function)
       {
         error_tracker_.RaiseRuntimeError("Function '" + function_name + "' does not exist.",
                                          stack_[n]->token());
         return;
       }
 
-      auto &          function = (*semantic_search_module_)[function_name];
-      std::type_index ret_type = function.return_type();
+      std::type_index ret_type = function->return_type();
 
-      if (!function.ValidateSignature(ret_type, arg_signature))
+      if (!function->ValidateSignature(ret_type, arg_signature))
       {
         error_tracker_.RaiseRuntimeError(
             "Call to '" + function_name + "' does not match signature.", stack_[n]->token());
@@ -491,7 +516,7 @@ void QueryExecutor::ExecuteDefine(CompiledStatement const &stmt)
       QueryVariant ret;
       try
       {
-        ret = function(args);
+        ret = (*function)(args);
       }
       catch (std::exception const &e)
       {
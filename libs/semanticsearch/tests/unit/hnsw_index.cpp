@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "semanticsearch/index/hnsw_db_index.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace fetch::semanticsearch;
+
+namespace {
+
+std::vector<SemanticSubscription> RandomSubscriptions(std::size_t count, std::size_t rank)
+{
+  std::mt19937_64                    rng{42};
+  std::vector<SemanticSubscription>  subscriptions(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    for (std::size_t j = 0; j < rank; ++j)
+    {
+      subscriptions[i].position.push_back(rng());
+    }
+    subscriptions[i].index = i;
+  }
+
+  return subscriptions;
+}
+
+double Distance(SemanticPosition const &a, SemanticPosition const &b)
+{
+  double sum = 0;
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    double const d = (static_cast<double>(a[i]) - static_cast<double>(b[i])) / 1e19;
+    sum += d * d;
+  }
+  return sum;
+}
+
+DBIndexList ExactNearest(std::vector<SemanticSubscription> const &subscriptions,
+                         SemanticPosition const &position, std::size_t k)
+{
+  std::vector<std::pair<double, DBIndexType>> distances{};
+  for (auto const &subscription : subscriptions)
+  {
+    distances.emplace_back(Distance(subscription.position, position), subscription.index);
+  }
+  std::sort(distances.begin(), distances.end());
+
+  DBIndexList ret{};
+  for (std::size_t i = 0; i < k; ++i)
+  {
+    ret.push_back(distances[i].second);
+  }
+  return ret;
+}
+
+}  // namespace
+
+TEST(SemanticSearchHNSWIndex, NearestNeighboursHaveHighRecall)
+{
+  constexpr std::size_t RANK = 128;
+  constexpr std::size_t K    = 10;
+
+  auto const  subscriptions = RandomSubscriptions(2000, RANK);
+  HNSWDBIndex database_index{RANK};
+
+  for (auto const &subscription : subscriptions)
+  {
+    database_index.AddRelation(subscription);
+  }
+  EXPECT_EQ(database_index.size(), 2000);
+
+  std::size_t found   = 0;
+  auto const  queries = RandomSubscriptions(50, RANK + 1);
+  for (auto query : queries)
+  {
+    query.position.pop_back();
+
+    auto const result   = database_index.FindNearest(query.position, K);
+    auto const expected = ExactNearest(subscriptions, query.position, K);
+    ASSERT_EQ(result.size(), K);
+
+    std::set<DBIndexType> const expected_set(expected.begin(), expected.end());
+    found += static_cast<std::size_t>(std::count_if(
+        result.begin(), result.end(),
+        [&expected_set](DBIndexType index) { return expected_set.count(index) != 0; }));
+  }
+
+  EXPECT_GE(static_cast<double>(found) / static_cast<double>(queries.size() * K), 0.9);
+}
+
+TEST(SemanticSearchHNSWIndex, ExactPositionIsNearest)
+{
+  auto const  subscriptions = RandomSubscriptions(500, 16);
+  HNSWDBIndex database_index{16};
+
+  for (auto const &subscription : subscriptions)
+  {
+    database_index.AddRelation(subscription);
+  }
+
+  for (auto const &subscription : subscriptions)
+  {
+    auto const result = database_index.FindNearest(subscription.position, 1);
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result.front(), subscription.index);
+  }
+}
+
+TEST(SemanticSearchHNSWIndex, RemovedRelationsAreNotFound)
+{
+  auto const  subscriptions = RandomSubscriptions(300, 8);
+  HNSWDBIndex database_index{8};
+
+  for (auto const &subscription : subscriptions)
+  {
+    database_index.AddRelation(subscription);
+  }
+
+  // removing more than half of the records also rebuilds the graph
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    database_index.RemoveRelation(subscriptions[i]);
+  }
+  EXPECT_EQ(database_index.size(), 100);
+
+  for (std::size_t i = 0; i < subscriptions.size(); ++i)
+  {
+    auto const result = database_index.FindNearest(subscriptions[i].position, 5);
+    ASSERT_EQ(result.size(), 5);
+    for (auto const index : result)
+    {
+      EXPECT_GE(index, 200);
+    }
+    if (i >= 200)
+    {
+      EXPECT_EQ(result.front(), subscriptions[i].index);
+    }
+  }
+}
+
+TEST(SemanticSearchHNSWIndex, FindWithinGroupWidth)
+{
+  HNSWDBIndex            database_index{1};
+  SemanticCoordinateType width = static_cast<SemanticCoordinateType>(-1) / 16;
+
+  for (SemanticCoordinateType i = 0; i < 16; ++i)
+  {
+    SemanticSubscription rel;
+    rel.position.push_back(width * i + (width >> 1));
+    rel.index = i;
+    database_index.AddRelation(rel);
+  }
+
+  auto group0 = database_index.Find(0, {width * 8});
+  ASSERT_NE(group0, nullptr);
+  EXPECT_EQ(group0->size(), 16);
+
+  // depth 4 has the width of the grid, so only the neighbouring records are found
+  auto group4 = database_index.Find(4, {width * 8});
+  ASSERT_NE(group4, nullptr);
+  EXPECT_EQ(*group4, std::set<DBIndexType>({7, 8}));
+
+  EXPECT_THROW(database_index.Find(0, {width, width}), std::runtime_error);
+  EXPECT_TRUE(HNSWDBIndex{4}.FindNearest({0, 0, 0, 0}, 3).empty());
+}
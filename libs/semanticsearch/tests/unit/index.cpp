@@ -122,3 +122,32 @@ TEST(SemanticSearchIndex, BasicOperations2D)
   EXPECT_EQ(group4->size(), 4);
   EXPECT_EQ(*group4, std::set<DBIndexType>({10, 11, 14, 15}));
 }
+
+TEST(SemanticSearchIndex, RemoveRelation)
+{
+  InMemoryDBIndex        database_index{1};
+  SemanticCoordinateType width = static_cast<SemanticCoordinateType>(-1) / 4;
+
+  std::vector<SemanticSubscription> relations;
+  for (SemanticCoordinateType i = 0; i < 4; ++i)
+  {
+    SemanticSubscription rel;
+    rel.position.push_back(width * i + (width >> 1));
+    rel.index = i;
+    database_index.AddRelation(rel);
+    relations.push_back(rel);
+  }
+
+  database_index.RemoveRelation(relations[0]);
+  database_index.RemoveRelation(relations[1]);
+
+  auto group0 = database_index.Find(0, {width * 2});
+  EXPECT_NE(group0, nullptr);
+  EXPECT_EQ(*group0, std::set<DBIndexType>({2, 3}));
+
+  // groups left without records are dropped
+  EXPECT_EQ(database_index.Find(1, {width}), nullptr);
+
+  auto nearest = database_index.FindNearest(relations[3].position, 1);
+  EXPECT_EQ(nearest, DBIndexList({3}));
+}
@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+#include "semanticsearch/query/query_compiler.hpp"
+#include "semanticsearch/query/query_executor.hpp"
+
+#include <memory>
+#include <string>
+
+using namespace fetch::semanticsearch;
+
+namespace {
+
+using Int        = QueryExecutor::Int;
+using ModelField = QueryExecutor::ModelField;
+
+SharedSemanticSearchModule NewModule()
+{
+  auto module = SemanticSearchModule::New(std::make_shared<AdvertisementRegister>());
+  module->RegisterType<Int>("Int");
+  module->RegisterType<ModelField>("ModelField", true);
+  module->RegisterFunction<ModelField, Int, Int>(
+      "BoundedInteger", [](Int from, Int to) -> ModelField {
+        auto            span = static_cast<uint64_t>(to - from);
+        SemanticReducer cdr;
+        cdr.SetReducer<Int>(1, [span, from](Int x) {
+          SemanticPosition ret;
+          ret.push_back(static_cast<uint64_t>(x - from) * (uint64_t(-1) / span));
+          return ret;
+        });
+        cdr.SetValidator<Int>([from, to](Int x) { return (from <= x) && (x <= to); });
+
+        auto instance = DataToSubspaceMap<Int>::New();
+        instance->SetSemanticReducer(cdr);
+        return instance;
+      });
+
+  return module;
+}
+
+QueryInstruction const *FindInstruction(Query const &query, std::string const &token)
+{
+  for (auto const &stmt : query.statements)
+  {
+    for (auto const &instruction : stmt)
+    {
+      if (instruction.token == token)
+      {
+        return &instruction;
+      }
+    }
+  }
+  return nullptr;
+}
+
+TEST(QueryCompilerTests, ResolvesLiteralsAndFunctions)
+{
+  auto          module = NewModule();
+  ErrorTracker  error_tracker;
+  QueryCompiler compiler(error_tracker, module);
+
+  auto query = compiler.Compile("model Point { x: BoundedInteger(0, 100) };");
+  ASSERT_FALSE(error_tracker.HasErrors());
+
+  auto function = FindInstruction(*query, "BoundedInteger");
+  ASSERT_NE(function, nullptr);
+  ASSERT_TRUE(static_cast<bool>(function->value));
+  EXPECT_TRUE(function->value->IsType<BuiltinQueryFunction::Function>());
+
+  auto literal = FindInstruction(*query, "100");
+  ASSERT_NE(literal, nullptr);
+  ASSERT_TRUE(static_cast<bool>(literal->value));
+  EXPECT_EQ(literal->value->As<Int>(), 100);
+}
+
+TEST(QueryCompilerTests, ModelsDefinedByTheQueryAreNotResolved)
+{
+  auto          module = NewModule();
+  ErrorTracker  error_tracker;
+  QueryCompiler compiler(error_tracker, module);
+
+  QueryExecutor executor(module, error_tracker);
+  executor.Execute(*compiler.Compile("model Inner { x: BoundedInteger(0, 10) };"), nullptr);
+  ASSERT_FALSE(error_tracker.HasErrors());
+
+  auto query =
+      compiler.Compile("model Inner { y: Int }; model Outer { inner: Inner, z: Int };");
+  ASSERT_FALSE(error_tracker.HasErrors());
+  ASSERT_EQ(query->statements.size(), 2u);
+
+  for (auto const &instruction : query->statements[1])
+  {
+    if (instruction.token == "Inner")
+    {
+      EXPECT_FALSE(static_cast<bool>(instruction.value));
+    }
+    if (instruction.token == "Int")
+    {
+      EXPECT_TRUE(static_cast<bool>(instruction.value));
+    }
+  }
+}
+
+TEST(QueryCompilerTests, CachesProgramsUntilModuleChanges)
+{
+  auto          module = NewModule();
+  ErrorTracker  error_tracker;
+  QueryCompiler compiler(error_tracker, module, 2);
+
+  auto first = compiler.Compile("model A { x: Int };");
+  EXPECT_EQ(compiler.Compile("model A { x: Int };"), first);
+  EXPECT_EQ(compiler.cache_size(), 1u);
+
+  // Other filenames are compiled again to report errors correctly
+  EXPECT_NE(compiler.Compile("model A { x: Int };", "other"), first);
+
+  module->RegisterType<Int>("Int");
+  auto second = compiler.Compile("model A { x: Int };", "other");
+  EXPECT_NE(second, first);
+  EXPECT_EQ(compiler.Compile("model A { x: Int };", "other"), second);
+
+  // The oldest program is evicted when the cache is full
+  compiler.Compile("model B { x: Int };");
+  compiler.Compile("model C { x: Int };");
+  EXPECT_EQ(compiler.cache_size(), 2u);
+  EXPECT_NE(compiler.Compile("model A { x: Int };", "other"), second);
+}
+
+TEST(QueryCompilerTests, CachedProgramsExecuteForEveryAgent)
+{
+  auto          module = NewModule();
+  ErrorTracker  error_tracker;
+  QueryCompiler compiler(error_tracker, module);
+
+  QueryExecutor definitions(module, error_tracker);
+  definitions.Execute(*compiler.Compile("model Point { x: BoundedInteger(0, 100) };"), nullptr);
+  ASSERT_FALSE(error_tracker.HasErrors());
+
+  std::string const source = "var p : Point = { x: 42 }; store p;";
+  auto              query  = compiler.Compile(source);
+
+  for (auto const &name : {"agent1", "agent2", "agent3"})
+  {
+    module->RegisterAgent(name);
+    auto agent = module->GetAgent(name);
+
+    QueryExecutor executor(module, error_tracker);
+    executor.Execute(*compiler.Compile(source), agent);
+    ASSERT_FALSE(error_tracker.HasErrors());
+
+    EXPECT_NE(executor.GetInstance("p"), nullptr);
+    EXPECT_EQ(agent->locations.size(), 1u);
+  }
+
+  EXPECT_EQ(compiler.Compile(source), query);
+}
+
+}  // namespace
@@ -0,0 +1,257 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "storage/new_revertible_document_store.hpp"
+#include "storage/state_snapshot.hpp"
+#include "storage_benchmarks.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::storage::NewRevertibleDocumentStore;
+using fetch::storage::ResourceID;
+using fetch::storage::StateSnapshotChunk;
+using fetch::storage::benchmarks::DatabasePath;
+using fetch::storage::benchmarks::Key;
+using fetch::storage::benchmarks::KeyCounts;
+using fetch::storage::benchmarks::Latencies;
+using fetch::storage::benchmarks::Mix;
+
+namespace {
+
+using IndexBackend = NewRevertibleDocumentStore::IndexBackend;
+using StorePtr     = std::shared_ptr<NewRevertibleDocumentStore>;
+
+constexpr auto KEY_VALUE_INDEX = IndexBackend::KEY_VALUE_INDEX;
+constexpr auto B_TREE          = IndexBackend::B_TREE;
+
+constexpr std::size_t VALUE_SIZE        = 64;
+constexpr std::size_t IMPORT_BATCH_SIZE = 1000000;
+constexpr std::size_t WRITES_PER_COMMIT = 100;
+constexpr std::size_t CHUNK_SIZE        = 1000;
+
+ConstByteArray Value(uint64_t seed)
+{
+  ByteArray value;
+  value.Resize(VALUE_SIZE);
+
+  for (std::size_t offset = 0; offset < VALUE_SIZE; offset += sizeof(uint64_t))
+  {
+    uint64_t const word = Mix(seed + offset);
+    std::copy(reinterpret_cast<uint8_t const *>(&word),
+              reinterpret_cast<uint8_t const *>(&word) + sizeof(uint64_t),
+              value.pointer() + offset);
+  }
+
+  return {value};
+}
+
+/**
+ * A store which is populated (and committed) once for each backend and number of keys, and is
+ * shared by all the benchmarks of the backend. The database files (and the hash histories the
+ * store keeps next to them) are removed on exit.
+ */
+NewRevertibleDocumentStore &PopulatedStore(IndexBackend backend, uint64_t count)
+{
+  static std::map<std::pair<IndexBackend, uint64_t>, StorePtr> stores{};
+
+  auto &store = stores[{backend, count}];
+  if (!store)
+  {
+    std::string const name =
+        ((IndexBackend::B_TREE == backend) ? "btree_" : "kvi_") + std::to_string(count);
+
+    std::string const files[] = {DatabasePath(name + "_state"), DatabasePath(name + "_state_hist"),
+                                 DatabasePath(name + "_index"), DatabasePath(name + "_index_hist")};
+
+    store = StorePtr(new NewRevertibleDocumentStore{backend},
+                     [files](NewRevertibleDocumentStore *s) {
+                       delete s;
+                       for (auto const &file : files)
+                       {
+                         std::remove(file.c_str());
+                         std::remove(("hash_history_" + file).c_str());
+                       }
+                     });
+
+    store->New(files[0], files[1], files[2], files[3], true);
+
+    for (uint64_t offset = 0; offset < count; offset += IMPORT_BATCH_SIZE)
+    {
+      uint64_t const batch = std::min<uint64_t>(IMPORT_BATCH_SIZE, count - offset);
+
+      NewRevertibleDocumentStore::Keys   keys{};
+      NewRevertibleDocumentStore::Values values{};
+      keys.reserve(batch);
+      values.reserve(batch);
+
+      for (uint64_t i = offset; i < offset + batch; ++i)
+      {
+        keys.emplace_back(Key(i));
+        values.emplace_back(Value(i));
+      }
+
+      store->Import(keys, values);
+    }
+
+    store->Commit();
+  }
+
+  return *store;
+}
+
+template <IndexBackend BACKEND>
+void DocumentStore_RandomGet(benchmark::State &state)
+{
+  auto const count = static_cast<uint64_t>(state.range(0));
+  auto &     store = PopulatedStore(BACKEND, count);
+
+  Latencies latencies{};
+  uint64_t  sequence{0};
+  for (auto _ : state)
+  {
+    auto const key = Key(Mix(sequence++) % count);
+    latencies.Measure([&] { benchmark::DoNotOptimize(store.Get(key)); });
+  }
+
+  latencies.Report(state);
+}
+
+template <IndexBackend BACKEND>
+void DocumentStore_RandomSet(benchmark::State &state)
+{
+  auto const count = static_cast<uint64_t>(state.range(0));
+  auto &     store = PopulatedStore(BACKEND, count);
+
+  Latencies latencies{};
+  uint64_t  sequence{0};
+  for (auto _ : state)
+  {
+    auto const key   = Key(Mix(sequence) % count);
+    auto const value = Value(sequence++);
+    latencies.Measure([&] { store.Set(key, value); });
+  }
+
+  latencies.Report(state);
+}
+
+/**
+ * A block's worth of writes, followed by a commit and a revert of the block
+ */
+template <IndexBackend BACKEND>
+void DocumentStore_CommitRevert(benchmark::State &state)
+{
+  auto const count = static_cast<uint64_t>(state.range(0));
+  auto &     store = PopulatedStore(BACKEND, count);
+  auto const base  = store.Commit();
+
+  Latencies latencies{};
+  uint64_t  sequence{0};
+  for (auto _ : state)
+  {
+    latencies.Measure([&] {
+      for (std::size_t i = 0; i < WRITES_PER_COMMIT; ++i, ++sequence)
+      {
+        store.Set(Key(Mix(sequence) % count), Value(sequence));
+      }
+
+      store.Commit();
+      store.RevertToHash(base);
+    });
+  }
+
+  latencies.Report(state);
+}
+
+/**
+ * The merkle hash of the state after a block's worth of writes
+ */
+template <IndexBackend BACKEND>
+void DocumentStore_MerkleHash(benchmark::State &state)
+{
+  auto const count = static_cast<uint64_t>(state.range(0));
+  auto &     store = PopulatedStore(BACKEND, count);
+
+  Latencies latencies{};
+  uint64_t  sequence{0};
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    for (std::size_t i = 0; i < WRITES_PER_COMMIT; ++i, ++sequence)
+    {
+      store.Set(Key(Mix(sequence) % count), Value(sequence));
+    }
+    state.ResumeTiming();
+
+    latencies.Measure([&] { benchmark::DoNotOptimize(store.CurrentHash()); });
+  }
+
+  latencies.Report(state);
+}
+
+/**
+ * Iteration over the complete state, as performed to serve a state snapshot
+ */
+template <IndexBackend BACKEND>
+void DocumentStore_Iterate(benchmark::State &state)
+{
+  auto const count = static_cast<uint64_t>(state.range(0));
+  auto &     store = PopulatedStore(BACKEND, count);
+
+  Latencies          latencies{};
+  ResourceID         cursor{};
+  StateSnapshotChunk chunk{};
+  for (auto _ : state)
+  {
+    bool success{false};
+    latencies.Measure([&] { success = store.ReadSnapshotChunk(cursor, CHUNK_SIZE, chunk); });
+
+    // start again from the beginning once the end of the state is reached
+    cursor = (success && !chunk.complete && !chunk.keys.empty()) ? chunk.keys.back() : ResourceID{};
+  }
+
+  latencies.Report(state, CHUNK_SIZE);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(DocumentStore_RandomGet, KEY_VALUE_INDEX)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(DocumentStore_RandomGet, B_TREE)->Apply(KeyCounts);
+
+BENCHMARK_TEMPLATE(DocumentStore_RandomSet, KEY_VALUE_INDEX)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(DocumentStore_RandomSet, B_TREE)->Apply(KeyCounts);
+
+BENCHMARK_TEMPLATE(DocumentStore_CommitRevert, KEY_VALUE_INDEX)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(DocumentStore_CommitRevert, B_TREE)->Apply(KeyCounts);
+
+BENCHMARK_TEMPLATE(DocumentStore_MerkleHash, KEY_VALUE_INDEX)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(DocumentStore_MerkleHash, B_TREE)->Apply(KeyCounts);
+
+BENCHMARK_TEMPLATE(DocumentStore_Iterate, KEY_VALUE_INDEX)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(DocumentStore_Iterate, B_TREE)->Apply(KeyCounts);
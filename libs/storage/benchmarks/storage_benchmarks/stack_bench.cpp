@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "storage/cache_line_LRU_random_access_stack.hpp"
+#include "storage/cached_random_access_stack.hpp"
+#include "storage/mmap_random_access_stack.hpp"
+#include "storage/random_access_stack.hpp"
+#include "storage_benchmarks.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+using fetch::storage::benchmarks::DatabasePath;
+using fetch::storage::benchmarks::KeyCounts;
+using fetch::storage::benchmarks::Latencies;
+using fetch::storage::benchmarks::Mix;
+
+namespace {
+
+struct Record
+{
+  uint64_t words[4];
+};
+
+using RandomAccess   = fetch::storage::RandomAccessStack<Record>;
+using Cached         = fetch::storage::CachedRandomAccessStack<Record>;
+using CacheLineLRU   = fetch::storage::CacheLineLRURandomAccessStack<Record>;
+using MemoryMapped   = fetch::storage::MMapRandomAccessStack<Record>;
+using StackInstances = std::map<uint64_t, std::shared_ptr<void>>;
+
+/**
+ * A stack of records which is populated once for each number of keys and shared by all the
+ * benchmarks of the stack type, the database file is removed on exit
+ */
+template <typename Stack>
+Stack &PopulatedStack(uint64_t count)
+{
+  static StackInstances instances{};
+
+  auto &instance = instances[count];
+  if (!instance)
+  {
+    auto const filename =
+        DatabasePath(std::to_string(typeid(Stack).hash_code()) + "_" + std::to_string(count));
+
+    auto stack = std::shared_ptr<Stack>(new Stack, [filename](Stack *s) {
+      s->Close();
+      delete s;
+      std::remove(filename.c_str());
+    });
+
+    stack->New(filename);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      stack->Push(Record{{i, i, i, i}});
+    }
+    stack->Flush();
+
+    instance = stack;
+  }
+
+  return *std::static_pointer_cast<Stack>(instance);
+}
+
+template <typename Stack>
+void Stack_SequentialGet(benchmark::State &state)
+{
+  auto const count = static_cast<uint64_t>(state.range(0));
+  auto &     stack = PopulatedStack<Stack>(count);
+
+  Latencies latencies{};
+  Record    record{};
+  uint64_t  index{0};
+  for (auto _ : state)
+  {
+    latencies.Measure([&] { stack.Get(index, record); });
+    index = (index + 1) % count;
+  }
+
+  benchmark::DoNotOptimize(record);
+  latencies.Report(state);
+}
+
+template <typename Stack>
+void Stack_RandomGet(benchmark::State &state)
+{
+  auto const count = static_cast<uint64_t>(state.range(0));
+  auto &     stack = PopulatedStack<Stack>(count);
+
+  Latencies latencies{};
+  Record    record{};
+  uint64_t  sequence{0};
+  for (auto _ : state)
+  {
+    uint64_t const index = Mix(sequence++) % count;
+    latencies.Measure([&] { stack.Get(index, record); });
+  }
+
+  benchmark::DoNotOptimize(record);
+  latencies.Report(state);
+}
+
+template <typename Stack>
+void Stack_SequentialSet(benchmark::State &state)
+{
+  auto const count = static_cast<uint64_t>(state.range(0));
+  auto &     stack = PopulatedStack<Stack>(count);
+
+  Latencies latencies{};
+  uint64_t  index{0};
+  for (auto _ : state)
+  {
+    Record const record{{index, 0, 0, 0}};
+    latencies.Measure([&] { stack.Set(index, record); });
+    index = (index + 1) % count;
+  }
+
+  stack.Flush();
+  latencies.Report(state);
+}
+
+template <typename Stack>
+void Stack_RandomSet(benchmark::State &state)
+{
+  auto const count = static_cast<uint64_t>(state.range(0));
+  auto &     stack = PopulatedStack<Stack>(count);
+
+  Latencies latencies{};
+  uint64_t  sequence{0};
+  for (auto _ : state)
+  {
+    uint64_t const index = Mix(sequence++) % count;
+    Record const   record{{index, 0, 0, 0}};
+    latencies.Measure([&] { stack.Set(index, record); });
+  }
+
+  stack.Flush();
+  latencies.Report(state);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(Stack_SequentialGet, RandomAccess)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_SequentialGet, Cached)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_SequentialGet, CacheLineLRU)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_SequentialGet, MemoryMapped)->Apply(KeyCounts);
+
+BENCHMARK_TEMPLATE(Stack_RandomGet, RandomAccess)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_RandomGet, Cached)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_RandomGet, CacheLineLRU)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_RandomGet, MemoryMapped)->Apply(KeyCounts);
+
+BENCHMARK_TEMPLATE(Stack_SequentialSet, RandomAccess)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_SequentialSet, Cached)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_SequentialSet, CacheLineLRU)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_SequentialSet, MemoryMapped)->Apply(KeyCounts);
+
+BENCHMARK_TEMPLATE(Stack_RandomSet, RandomAccess)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_RandomSet, Cached)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_RandomSet, CacheLineLRU)->Apply(KeyCounts);
+BENCHMARK_TEMPLATE(Stack_RandomSet, MemoryMapped)->Apply(KeyCounts);
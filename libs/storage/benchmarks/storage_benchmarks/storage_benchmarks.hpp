@@ -0,0 +1,149 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace storage {
+namespace benchmarks {
+
+/**
+ * The number of keys the benchmarks are run with, which can be overridden with a comma separated
+ * list in FETCH_STORAGE_BENCH_KEYS (e.g. 1000000,10000000,100000000)
+ */
+inline void KeyCounts(::benchmark::internal::Benchmark *benchmark)
+{
+  char const *counts = std::getenv("FETCH_STORAGE_BENCH_KEYS");
+
+  std::istringstream stream{counts ? counts : "1000000"};
+  std::string        count;
+  while (std::getline(stream, count, ','))
+  {
+    benchmark->Arg(std::stoll(count));
+  }
+
+  benchmark->Unit(::benchmark::kMicrosecond);
+}
+
+/**
+ * The name of a database file of the benchmarks. The files are created in the working directory
+ * (the revertible stores derive the names of further files from the names they are given, which
+ * only works for plain file names), run the benchmarks from a directory on the disk of interest.
+ */
+inline std::string DatabasePath(std::string const &name)
+{
+  return "storage_bench_" + name + ".db";
+}
+
+/**
+ * A cheap, well mixed sequence of pseudorandom values, so that generating the key of an operation
+ * costs next to nothing compared with the operation itself
+ */
+inline uint64_t Mix(uint64_t value)
+{
+  value += 0x9e3779b97f4a7c15ull;
+  value = (value ^ (value >> 30u)) * 0xbf58476d1ce4e5b9ull;
+  value = (value ^ (value >> 27u)) * 0x94d049bb133111ebull;
+  return value ^ (value >> 31u);
+}
+
+/**
+ * The resource id of the n-th key of a store
+ */
+inline ResourceID Key(uint64_t index)
+{
+  byte_array::ByteArray id;
+  id.Resize(ResourceID::RESOURCE_ID_SIZE_IN_BYTES);
+
+  for (std::size_t offset = 0; offset < id.size(); offset += sizeof(uint64_t))
+  {
+    uint64_t const word = Mix(index * 4 + offset);
+    std::memcpy(id.pointer() + offset, &word, sizeof(uint64_t));
+  }
+
+  return ResourceID{id};
+}
+
+/**
+ * Records the latency of each operation of a benchmark, to report its percentiles alongside the
+ * throughput
+ */
+class Latencies
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  template <typename Operation>
+  void Measure(Operation &&operation)
+  {
+    auto const start = Clock::now();
+    operation();
+    samples_.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+  }
+
+  /**
+   * Report the number of operations per second and the median and 99th percentile latencies
+   *
+   * @param state The state of the benchmark
+   * @param items The number of items processed by each operation
+   */
+  void Report(::benchmark::State &state, int64_t items = 1)
+  {
+    state.SetItemsProcessed(state.iterations() * items);
+
+    if (samples_.empty())
+    {
+      return;
+    }
+
+    state.counters["p50_us"] = Percentile(0.50) / 1e3;
+    state.counters["p99_us"] = Percentile(0.99) / 1e3;
+  }
+
+private:
+  double Percentile(double percentile)
+  {
+    auto const index = static_cast<std::size_t>(percentile * static_cast<double>(samples_.size()));
+    auto const it    = samples_.begin() + static_cast<std::ptrdiff_t>(index);
+
+    std::nth_element(samples_.begin(), it, samples_.end());
+    return static_cast<double>(*it);
+  }
+
+  std::vector<int64_t> samples_{};
+};
+
+}  // namespace benchmarks
+}  // namespace storage
+}  // namespace fetch
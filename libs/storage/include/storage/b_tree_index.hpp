@@ -0,0 +1,1358 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/macros.hpp"
+#include "crypto/sha256.hpp"
+#include "storage/storage_exception.hpp"
+#include "storage/versioned_random_access_stack.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * A fixed size page of the B-tree index. Pages are the unit of storage in the underlying random
+ * access stack and are sized to be a multiple of the cache line size.
+ */
+template <std::size_t S = 4096>
+struct BTreePage
+{
+  static_assert((S >= 512) && ((S % 64) == 0), "Pages must be a multiple of the cache line size");
+
+  static constexpr std::size_t SIZE = S;
+
+  uint8_t data[S]{};
+};
+
+/**
+ * Key value index implemented as a high fan out B-tree of fixed size pages. It is a drop in
+ * replacement for the KeyValueIndex in the DocumentStore, but a lookup only needs to visit a
+ * handful of pages (which are cached in decoded form) rather than one node per key bit.
+ *
+ * Within each page the common prefix of the keys is only stored once. Since the keys are
+ * cryptographic hashes this mostly benefits the lower levels of large trees.
+ *
+ * Keys are ordered in the same (least significant bit first) order as the KeyValueIndex trie, and
+ * the hash of the index is the root of the equivalent binary Patricia tree. Both backends therefore
+ * produce identical state hashes for the same contents. The hashes of the Patricia sub-trees are
+ * cached in memory and only the sub-trees touched by a modification need to be rehashed.
+ *
+ * Page 0 of the stack holds the index meta data (root page and page free list) and the number of
+ * entries is kept in the stack's extra header. Pages are only reclaimed once they become empty.
+ */
+template <std::size_t P = 4096, typename D = VersionedRandomAccessStack<BTreePage<P>>>
+class BTreeIndex
+{
+public:
+  using SelfType  = BTreeIndex<P, D>;
+  using StackType = D;
+  using PageType  = BTreePage<P>;
+  using IndexType = uint64_t;
+
+  static constexpr std::size_t KEY_SIZE  = 32;
+  static constexpr std::size_t HASH_SIZE = crypto::SHA256::SIZE_IN_BYTES;
+  static constexpr std::size_t KEY_BITS  = KEY_SIZE * 8u;
+
+  static_assert(std::is_same<typename StackType::type, PageType>::value,
+                "The stack must store B-tree pages");
+
+  using OrderedKey = std::array<uint8_t, KEY_SIZE>;
+  using HashArray  = std::array<uint8_t, HASH_SIZE>;
+
+  BTreeIndex()                   = default;
+  BTreeIndex(BTreeIndex const &) = delete;
+  BTreeIndex(BTreeIndex &&)      = delete;
+  ~BTreeIndex()                  = default;
+
+  BTreeIndex &operator=(BTreeIndex const &) = delete;
+  BTreeIndex &operator=(BTreeIndex &&) = delete;
+
+  template <typename... Args>
+  void New(Args &&... args)
+  {
+    stack_.New(std::forward<Args>(args)...);
+    InitialiseMeta();
+  }
+
+  template <typename... Args>
+  void Load(Args &&... args)
+  {
+    stack_.Load(std::forward<Args>(args)...);
+
+    if (stack_.empty())
+    {
+      InitialiseMeta();
+    }
+    else
+    {
+      UpdateVariables();
+    }
+  }
+
+  /**
+   * Look up the value associated with a key
+   *
+   * @param key_str The key to look up
+   * @param value The value to be populated on success
+   * @return true if the key was found, otherwise false
+   */
+  bool GetIfExists(byte_array::ConstByteArray const &key_str, IndexType &value)
+  {
+    Entry entry{};
+    if (!FindEntry(ToOrderedKey(key_str), entry))
+    {
+      return false;
+    }
+
+    value = entry.value;
+    return true;
+  }
+
+  IndexType Get(byte_array::ConstByteArray const &key_str)
+  {
+    IndexType value{0};
+    bool const found = GetIfExists(key_str, value);
+    assert(found);
+    FETCH_UNUSED(found);
+    return value;
+  }
+
+  /**
+   * Add or update a key
+   *
+   * @param key_str The key
+   * @param val The value (file index) associated with the key
+   * @param data The hash of the associated document
+   */
+  void Set(byte_array::ConstByteArray const &key_str, uint64_t val,
+           byte_array::ConstByteArray const &data)
+  {
+    if (data.size() < HASH_SIZE)
+    {
+      throw StorageException("Invalid hash size for B-tree index entry");
+    }
+
+    Entry entry{};
+    entry.key   = ToOrderedKey(key_str);
+    entry.value = val;
+    std::copy(data.pointer(), data.pointer() + HASH_SIZE, entry.hash.begin());
+
+    if (InsertEntry(entry))
+    {
+      stack_.SetExtraHeader(stack_.header_extra() + 1);
+    }
+
+    InvalidateHashes(entry.key);
+  }
+
+  /**
+   * Populate an empty index from a batch of entries. The pages are filled in key order and the
+   * region hashes are only computed once, on the next request for the root hash.
+   *
+   * @param entries The container of entries, each with a key, value (file index) and hash member
+   */
+  template <typename ENTRIES>
+  void BulkLoad(ENTRIES const &entries)
+  {
+    if (!empty())
+    {
+      throw StorageException("Bulk loads are only possible into an empty index");
+    }
+
+    std::vector<Entry> sorted{};
+    sorted.reserve(entries.size());
+
+    for (auto const &entry : entries)
+    {
+      if (entry.hash.size() < HASH_SIZE)
+      {
+        throw StorageException("Invalid hash size for B-tree index entry");
+      }
+
+      Entry element{};
+      element.key   = ToOrderedKey(entry.key);
+      element.value = entry.value;
+      std::copy(entry.hash.pointer(), entry.hash.pointer() + HASH_SIZE, element.hash.begin());
+
+      sorted.emplace_back(element);
+    }
+
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](Entry const &a, Entry const &b) { return a.key < b.key; });
+
+    for (auto const &entry : sorted)
+    {
+      if (InsertEntry(entry))
+      {
+        stack_.SetExtraHeader(stack_.header_extra() + 1);
+      }
+    }
+
+    // any cached region hashes are stale
+    hashes_.clear();
+    max_split_ = 0;
+  }
+
+  /**
+   * Remove a key from the index (if it exists)
+   *
+   * @param key_str The key to be removed
+   */
+  void Erase(byte_array::ConstByteArray const &key_str)
+  {
+    OrderedKey const key = ToOrderedKey(key_str);
+
+    if (EraseEntry(key))
+    {
+      stack_.SetExtraHeader(stack_.header_extra() - 1);
+      InvalidateHashes(key);
+    }
+  }
+
+  /**
+   * Compute the root hash of the index. This is the hash of the binary Patricia tree which
+   * contains the same keys, i.e. it matches the hash of the equivalent KeyValueIndex.
+   *
+   * @return The root hash
+   */
+  byte_array::ByteArray Hash()
+  {
+    stack_.Flush();
+
+    HashArray hash{};
+    if (!empty())
+    {
+      hash = HashRegion(OrderedKey{}, 0);
+    }
+
+    return {hash.data(), hash.size()};
+  }
+
+  StackType &underlying_stack()
+  {
+    return stack_;
+  }
+
+  std::size_t size() const
+  {
+    return stack_.empty() ? 0 : static_cast<std::size_t>(stack_.header_extra());
+  }
+
+  void Flush(bool lazy = true)
+  {
+    stack_.Flush(lazy);
+  }
+
+  bool is_open() const
+  {
+    return stack_.is_open();
+  }
+
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+  void Close()
+  {
+    stack_.Close();
+    ClearCaches();
+  }
+
+  /**
+   * Reload the index meta data from the underlying stack, required after the stack has been
+   * reverted
+   */
+  void UpdateVariables()
+  {
+    ClearCaches();
+
+    Meta meta{};
+    if (!ReadMeta(meta))
+    {
+      throw StorageException("Index file does not contain a B-tree index");
+    }
+
+    root_      = meta.root;
+    free_head_ = meta.free_head;
+  }
+
+  class Iterator
+  {
+  public:
+    Iterator() = default;
+    Iterator(SelfType *self, OrderedKey const &key, IndexType value, OrderedKey const &prefix,
+             uint16_t prefix_bits)
+      : self_{self}
+      , valid_{true}
+      , key_{key}
+      , value_{value}
+      , prefix_{prefix}
+      , prefix_bits_{prefix_bits}
+    {}
+
+    Iterator(Iterator const &rhs)     = default;
+    Iterator(Iterator &&rhs) noexcept = default;
+    Iterator &operator=(Iterator const &rhs) = default;
+    Iterator &operator=(Iterator &&rhs) noexcept = default;
+
+    bool operator==(Iterator const &rhs) const
+    {
+      return (valid_ == rhs.valid_) && (!valid_ || (key_ == rhs.key_));
+    }
+
+    bool operator!=(Iterator const &rhs) const
+    {
+      return !(*this == rhs);
+    }
+
+    void operator++()
+    {
+      if (!valid_)
+      {
+        return;
+      }
+
+      Entry next{};
+      valid_ = self_->FindAbove(key_, next) &&
+               (CommonPrefixBits(next.key, prefix_) >= std::size_t{prefix_bits_});
+
+      if (valid_)
+      {
+        key_   = next.key;
+        value_ = next.value;
+      }
+    }
+
+    std::pair<byte_array::ByteArray, uint64_t> operator*() const
+    {
+      return std::make_pair(FromOrderedKey(key_), value_);
+    }
+
+  private:
+    SelfType * self_{nullptr};
+    bool       valid_{false};
+    OrderedKey key_{};
+    IndexType  value_{0};
+    OrderedKey prefix_{};  ///< The prefix which all iterated keys must match
+    uint16_t   prefix_bits_{0};
+  };
+
+  Iterator begin()
+  {
+    return MakeIterator(OrderedKey{}, 0);
+  }
+
+  Iterator end()
+  {
+    return Iterator{};
+  }
+
+  Iterator Find(byte_array::ConstByteArray const &key_str)
+  {
+    Entry entry{};
+    if (!FindEntry(ToOrderedKey(key_str), entry))
+    {
+      return end();
+    }
+
+    return Iterator{this, entry.key, entry.value, OrderedKey{}, 0};
+  }
+
+  /**
+   * Get an iterator over all the keys which share the first bits of the specified key
+   *
+   * @param key_str The key
+   * @param bits The number of the key bits to match against
+   * @return The iterator to the first element of the subtree
+   */
+  Iterator GetSubtree(byte_array::ConstByteArray const &key_str, uint64_t bits)
+  {
+    auto const prefix_bits = static_cast<uint16_t>(std::min<uint64_t>(bits, KEY_BITS));
+    return MakeIterator(MaskKey(ToOrderedKey(key_str), prefix_bits), prefix_bits);
+  }
+
+  /// @name Key Ordering
+  /// @{
+  static OrderedKey            ToOrderedKey(byte_array::ConstByteArray const &key_str);
+  static byte_array::ByteArray FromOrderedKey(OrderedKey const &key);
+  /// @}
+
+private:
+  static constexpr uint64_t    MAGIC             = 0x4254524545494458ull;  // "BTREEIDX"
+  static constexpr uint64_t    NO_PAGE           = 0;
+  static constexpr std::size_t HEADER_SIZE       = 8;
+  static constexpr std::size_t MAX_CACHED_NODES  = 4096;
+  static constexpr std::size_t MAX_CACHED_HASHES = 1u << 20u;
+
+  enum class PageKind : uint8_t
+  {
+    FREE = 0,
+    LEAF,
+    INNER,
+    META
+  };
+
+  struct Entry
+  {
+    OrderedKey key{};
+    IndexType  value{0};
+    HashArray  hash{};
+  };
+
+  struct Node
+  {
+    bool                    leaf{true};
+    std::vector<Entry>      entries{};     ///< Leaf entries, ordered by key
+    std::vector<OrderedKey> separators{};  ///< Inner separators, ordered
+    std::vector<uint64_t>   children{};    ///< Inner child pages (separators + 1)
+  };
+
+  struct Meta
+  {
+    uint64_t root{NO_PAGE};
+    uint64_t free_head{NO_PAGE};
+  };
+
+  struct PathElement
+  {
+    uint64_t              page;
+    std::shared_ptr<Node> node;
+    std::size_t           child;  ///< The index of the child taken during the descent
+  };
+
+  /// Identifies a node of the equivalent Patricia tree by its split bit and key prefix
+  struct Region
+  {
+    uint16_t   split{0};
+    OrderedKey prefix{};
+
+    bool operator==(Region const &other) const
+    {
+      return (split == other.split) && (prefix == other.prefix);
+    }
+  };
+
+  struct RegionHash
+  {
+    std::size_t operator()(Region const &region) const
+    {
+      uint64_t value{0};
+      std::memcpy(&value, region.prefix.data(), sizeof(value));
+      return static_cast<std::size_t>(value ^ (uint64_t{region.split} * 0x9E3779B97F4A7C15ull));
+    }
+  };
+
+  using NodePtr   = std::shared_ptr<Node>;
+  using NodeCache = std::unordered_map<uint64_t, NodePtr>;
+  using HashCache = std::unordered_map<Region, HashArray, RegionHash>;
+  using Path      = std::vector<PathElement>;
+
+  /// @name Key / Bit Helpers
+  /// @{
+  static bool        GetBit(OrderedKey const &key, std::size_t bit);
+  static void        SetBit(OrderedKey &key, std::size_t bit);
+  static OrderedKey  MaskKey(OrderedKey const &key, std::size_t bits);
+  static OrderedKey  FillKey(OrderedKey const &key, std::size_t bits);
+  static std::size_t CommonPrefixBits(OrderedKey const &a, OrderedKey const &b);
+  static std::size_t CommonPrefixBytes(OrderedKey const &a, OrderedKey const &b);
+  /// @}
+
+  /// @name Page Encoding
+  /// @{
+  static std::size_t EncodedSize(Node const &node);
+  static void        Encode(Node const &node, PageType &page);
+  static bool        Decode(PageType const &page, Node &node);
+  static std::size_t ChildIndex(Node const &node, OrderedKey const &key);
+  /// @}
+
+  /// @name Page Management
+  /// @{
+  void     InitialiseMeta();
+  bool     ReadMeta(Meta &meta) const;
+  void     WriteMeta();
+  NodePtr  LoadNode(uint64_t page);
+  void     StoreNode(uint64_t page, NodePtr const &node);
+  uint64_t AllocatePage(NodePtr const &node);
+  void     FreePage(uint64_t page);
+  void     ClearCaches();
+  /// @}
+
+  /// @name Tree Operations
+  /// @{
+  bool     FindEntry(OrderedKey const &key, Entry &entry);
+  bool     FindCeiling(uint64_t page, OrderedKey const &key, bool strict, Entry &entry);
+  bool     FindFloor(uint64_t page, OrderedKey const &key, Entry &entry);
+  bool     FindAbove(OrderedKey const &key, Entry &entry);
+  bool     InsertEntry(Entry const &entry);
+  bool     EraseEntry(OrderedKey const &key);
+  Iterator MakeIterator(OrderedKey const &prefix, uint16_t prefix_bits);
+  /// @}
+
+  /// @name Merkle Hashing
+  /// @{
+  HashArray HashRegion(OrderedKey const &prefix, std::size_t bits);
+  void      InvalidateHashes(OrderedKey const &key);
+  /// @}
+
+  StackType stack_;
+  uint64_t  root_{NO_PAGE};       ///< The root page of the tree (NO_PAGE when empty)
+  uint64_t  free_head_{NO_PAGE};  ///< The head of the list of free pages
+  NodeCache nodes_{};             ///< Cache of the decoded pages
+  HashCache hashes_{};            ///< Cache of the Patricia sub-tree hashes
+  uint16_t  max_split_{0};        ///< The largest split bit present in the hash cache
+};
+
+template <std::size_t P, typename D>
+constexpr std::size_t BTreeIndex<P, D>::KEY_SIZE;
+template <std::size_t P, typename D>
+constexpr std::size_t BTreeIndex<P, D>::HASH_SIZE;
+template <std::size_t P, typename D>
+constexpr std::size_t BTreeIndex<P, D>::KEY_BITS;
+template <std::size_t P, typename D>
+constexpr uint64_t BTreeIndex<P, D>::MAGIC;
+template <std::size_t P, typename D>
+constexpr uint64_t BTreeIndex<P, D>::NO_PAGE;
+template <std::size_t P, typename D>
+constexpr std::size_t BTreeIndex<P, D>::HEADER_SIZE;
+template <std::size_t P, typename D>
+constexpr std::size_t BTreeIndex<P, D>::MAX_CACHED_NODES;
+template <std::size_t P, typename D>
+constexpr std::size_t BTreeIndex<P, D>::MAX_CACHED_HASHES;
+
+/**
+ * Convert a key into its ordered form. The KeyValueIndex trie compares keys from the least
+ * significant bit of each byte, reversing the bits of each byte allows keys to be ordered with a
+ * plain lexicographical comparison.
+ *
+ * @param key_str The key to convert
+ * @return The ordered key
+ */
+template <std::size_t P, typename D>
+typename BTreeIndex<P, D>::OrderedKey BTreeIndex<P, D>::ToOrderedKey(
+    byte_array::ConstByteArray const &key_str)
+{
+  if (key_str.size() != KEY_SIZE)
+  {
+    throw StorageException("Invalid key size for B-tree index");
+  }
+
+  OrderedKey key{};
+  for (std::size_t i = 0; i < KEY_SIZE; ++i)
+  {
+    auto b = static_cast<uint32_t>(key_str[i]);
+    b      = ((b & 0xF0u) >> 4u) | ((b & 0x0Fu) << 4u);
+    b      = ((b & 0xCCu) >> 2u) | ((b & 0x33u) << 2u);
+    b      = ((b & 0xAAu) >> 1u) | ((b & 0x55u) << 1u);
+    key[i] = static_cast<uint8_t>(b);
+  }
+
+  return key;
+}
+
+template <std::size_t P, typename D>
+byte_array::ByteArray BTreeIndex<P, D>::FromOrderedKey(OrderedKey const &key)
+{
+  byte_array::ConstByteArray const ordered{key.data(), key.size()};
+  auto const                       original = ToOrderedKey(ordered);  // bit reversal is symmetric
+
+  return {original.data(), original.size()};
+}
+
+template <std::size_t P, typename D>
+bool BTreeIndex<P, D>::GetBit(OrderedKey const &key, std::size_t bit)
+{
+  return ((key[bit >> 3u] >> (7u - (bit & 7u))) & 1u) != 0;
+}
+
+template <std::size_t P, typename D>
+void BTreeIndex<P, D>::SetBit(OrderedKey &key, std::size_t bit)
+{
+  key[bit >> 3u] = static_cast<uint8_t>(key[bit >> 3u] | (0x80u >> (bit & 7u)));
+}
+
+/**
+ * Clear all the bits of the key from the specified bit onwards
+ */
+template <std::size_t P, typename D>
+typename BTreeIndex<P, D>::OrderedKey BTreeIndex<P, D>::MaskKey(OrderedKey const &key,
+                                                                std::size_t       bits)
+{
+  OrderedKey masked{};
+
+  std::size_t const bytes = bits >> 3u;
+  std::copy(key.begin(), key.begin() + static_cast<std::ptrdiff_t>(bytes), masked.begin());
+
+  if ((bits & 7u) != 0)
+  {
+    masked[bytes] = static_cast<uint8_t>(key[bytes] & (0xFF00u >> (bits & 7u)));
+  }
+
+  return masked;
+}
+
+/**
+ * Set all the bits of the key from the specified bit onwards
+ */
+template <std::size_t P, typename D>
+typename BTreeIndex<P, D>::OrderedKey BTreeIndex<P, D>::FillKey(OrderedKey const &key,
+                                                                std::size_t       bits)
+{
+  OrderedKey filled = MaskKey(key, bits);
+
+  std::size_t const bytes = bits >> 3u;
+  if (bytes < KEY_SIZE)
+  {
+    filled[bytes] = static_cast<uint8_t>(filled[bytes] | (0xFFu >> (bits & 7u)));
+    std::fill(filled.begin() + static_cast<std::ptrdiff_t>(bytes + 1), filled.end(), uint8_t{0xFF});
+  }
+
+  return filled;
+}
+
+template <std::size_t P, typename D>
+std::size_t BTreeIndex<P, D>::CommonPrefixBytes(OrderedKey const &a, OrderedKey const &b)
+{
+  return static_cast<std::size_t>(std::mismatch(a.begin(), a.end(), b.begin()).first - a.begin());
+}
+
+template <std::size_t P, typename D>
+std::size_t BTreeIndex<P, D>::CommonPrefixBits(OrderedKey const &a, OrderedKey const &b)
+{
+  std::size_t const bytes = CommonPrefixBytes(a, b);
+  if (bytes == KEY_SIZE)
+  {
+    return KEY_BITS;
+  }
+
+  std::size_t bits = bytes * 8u;
+  for (uint32_t diff = static_cast<uint32_t>(a[bytes] ^ b[bytes]); (diff & 0x80u) == 0; diff <<= 1u)
+  {
+    ++bits;
+  }
+
+  return bits;
+}
+
+/**
+ * Compute the size of the node once encoded into a page
+ */
+template <std::size_t P, typename D>
+std::size_t BTreeIndex<P, D>::EncodedSize(Node const &node)
+{
+  std::size_t prefix{0};
+  std::size_t count{0};
+
+  if (node.leaf)
+  {
+    count = node.entries.size();
+    if (count > 1)
+    {
+      prefix = CommonPrefixBytes(node.entries.front().key, node.entries.back().key);
+    }
+
+    return HEADER_SIZE + prefix + (count * ((KEY_SIZE - prefix) + sizeof(IndexType) + HASH_SIZE));
+  }
+
+  count = node.separators.size();
+  if (count > 1)
+  {
+    prefix = CommonPrefixBytes(node.separators.front(), node.separators.back());
+  }
+
+  return HEADER_SIZE + prefix + (count * (KEY_SIZE - prefix)) +
+         (node.children.size() * sizeof(uint64_t));
+}
+
+/**
+ * Encode the node into a page. The header is followed by the common key prefix and then the key
+ * suffixes and values of each element.
+ */
+template <std::size_t P, typename D>
+void BTreeIndex<P, D>::Encode(Node const &node, PageType &page)
+{
+  assert(EncodedSize(node) <= P);
+
+  page = PageType{};
+
+  std::size_t const count  = node.leaf ? node.entries.size() : node.separators.size();
+  std::size_t       prefix = 0;
+  if (count > 1)
+  {
+    prefix = node.leaf ? CommonPrefixBytes(node.entries.front().key, node.entries.back().key)
+                       : CommonPrefixBytes(node.separators.front(), node.separators.back());
+  }
+
+  auto const count16 = static_cast<uint16_t>(count);
+
+  page.data[0] = static_cast<uint8_t>(node.leaf ? PageKind::LEAF : PageKind::INNER);
+  page.data[1] = static_cast<uint8_t>(prefix);
+  std::memcpy(page.data + 2, &count16, sizeof(count16));
+
+  uint8_t *  out    = page.data + HEADER_SIZE;
+  auto const suffix = KEY_SIZE - prefix;
+
+  if (prefix > 0)
+  {
+    auto const &first = node.leaf ? node.entries.front().key : node.separators.front();
+    std::memcpy(out, first.data(), prefix);
+    out += prefix;
+  }
+
+  if (node.leaf)
+  {
+    for (auto const &entry : node.entries)
+    {
+      std::memcpy(out, entry.key.data() + prefix, suffix);
+      out += suffix;
+      std::memcpy(out, &entry.value, sizeof(entry.value));
+      out += sizeof(entry.value);
+      std::memcpy(out, entry.hash.data(), HASH_SIZE);
+      out += HASH_SIZE;
+    }
+  }
+  else
+  {
+    for (auto const &separator : node.separators)
+    {
+      std::memcpy(out, separator.data() + prefix, suffix);
+      out += suffix;
+    }
+
+    for (auto const &child : node.children)
+    {
+      std::memcpy(out, &child, sizeof(child));
+      out += sizeof(child);
+    }
+  }
+}
+
+template <std::size_t P, typename D>
+bool BTreeIndex<P, D>::Decode(PageType const &page, Node &node)
+{
+  auto const kind = static_cast<PageKind>(page.data[0]);
+  if ((kind != PageKind::LEAF) && (kind != PageKind::INNER))
+  {
+    return false;
+  }
+
+  std::size_t const prefix = page.data[1];
+  uint16_t          count{0};
+  std::memcpy(&count, page.data + 2, sizeof(count));
+
+  if (prefix > KEY_SIZE)
+  {
+    return false;
+  }
+
+  uint8_t const *in     = page.data + HEADER_SIZE;
+  auto const     suffix = KEY_SIZE - prefix;
+
+  OrderedKey key{};
+  std::memcpy(key.data(), in, prefix);
+  in += prefix;
+
+  node      = Node{};
+  node.leaf = (kind == PageKind::LEAF);
+
+  if (node.leaf)
+  {
+    node.entries.resize(count);
+    for (auto &entry : node.entries)
+    {
+      entry.key = key;
+      std::memcpy(entry.key.data() + prefix, in, suffix);
+      in += suffix;
+      std::memcpy(&entry.value, in, sizeof(entry.value));
+      in += sizeof(entry.value);
+      std::memcpy(entry.hash.data(), in, HASH_SIZE);
+      in += HASH_SIZE;
+    }
+  }
+  else
+  {
+    node.separators.resize(count);
+    for (auto &separator : node.separators)
+    {
+      separator = key;
+      std::memcpy(separator.data() + prefix, in, suffix);
+      in += suffix;
+    }
+
+    node.children.resize(std::size_t{count} + 1u);
+    for (auto &child : node.children)
+    {
+      std::memcpy(&child, in, sizeof(child));
+      in += sizeof(child);
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Determine the child of an inner node which covers the specified key
+ */
+template <std::size_t P, typename D>
+std::size_t BTreeIndex<P, D>::ChildIndex(Node const &node, OrderedKey const &key)
+{
+  return static_cast<std::size_t>(
+      std::upper_bound(node.separators.begin(), node.separators.end(), key) -
+      node.separators.begin());
+}
+
+template <std::size_t P, typename D>
+void BTreeIndex<P, D>::InitialiseMeta()
+{
+  ClearCaches();
+
+  root_      = NO_PAGE;
+  free_head_ = NO_PAGE;
+
+  if (stack_.empty())
+  {
+    stack_.Push(PageType{});
+  }
+
+  WriteMeta();
+  stack_.SetExtraHeader(0);
+}
+
+template <std::size_t P, typename D>
+bool BTreeIndex<P, D>::ReadMeta(Meta &meta) const
+{
+  PageType page{};
+  stack_.Get(0, page);
+
+  uint64_t magic{0};
+  std::memcpy(&magic, page.data + HEADER_SIZE, sizeof(magic));
+
+  if ((static_cast<PageKind>(page.data[0]) != PageKind::META) || (magic != MAGIC))
+  {
+    return false;
+  }
+
+  std::memcpy(&meta, page.data + HEADER_SIZE + sizeof(magic), sizeof(meta));
+  return true;
+}
+
+template <std::size_t P, typename D>
+void BTreeIndex<P, D>::WriteMeta()
+{
+  Meta const meta{root_, free_head_};
+
+  PageType page{};
+  page.data[0] = static_cast<uint8_t>(PageKind::META);
+  std::memcpy(page.data + HEADER_SIZE, &MAGIC, sizeof(MAGIC));
+  std::memcpy(page.data + HEADER_SIZE + sizeof(MAGIC), &meta, sizeof(meta));
+
+  stack_.Set(0, page);
+}
+
+template <std::size_t P, typename D>
+typename BTreeIndex<P, D>::NodePtr BTreeIndex<P, D>::LoadNode(uint64_t page)
+{
+  auto it = nodes_.find(page);
+  if (it != nodes_.end())
+  {
+    return it->second;
+  }
+
+  PageType data{};
+  stack_.Get(page, data);
+
+  auto node = std::make_shared<Node>();
+  if (!Decode(data, *node))
+  {
+    throw StorageException("B-tree index page is malformed");
+  }
+
+  if (nodes_.size() >= MAX_CACHED_NODES)
+  {
+    nodes_.clear();
+  }
+
+  nodes_.emplace(page, node);
+  return node;
+}
+
+template <std::size_t P, typename D>
+void BTreeIndex<P, D>::StoreNode(uint64_t page, NodePtr const &node)
+{
+  PageType data{};
+  Encode(*node, data);
+  stack_.Set(page, data);
+
+  nodes_[page] = node;
+}
+
+template <std::size_t P, typename D>
+uint64_t BTreeIndex<P, D>::AllocatePage(NodePtr const &node)
+{
+  PageType data{};
+  Encode(*node, data);
+
+  uint64_t page{NO_PAGE};
+  if (free_head_ != NO_PAGE)
+  {
+    PageType free_page{};
+    page = free_head_;
+    stack_.Get(page, free_page);
+    std::memcpy(&free_head_, free_page.data + HEADER_SIZE, sizeof(free_head_));
+    stack_.Set(page, data);
+    WriteMeta();
+  }
+  else
+  {
+    page = stack_.Push(data);
+  }
+
+  nodes_[page] = node;
+  return page;
+}
+
+template <std::size_t P, typename D>
+void BTreeIndex<P, D>::FreePage(uint64_t page)
+{
+  PageType data{};
+  data.data[0] = static_cast<uint8_t>(PageKind::FREE);
+  std::memcpy(data.data + HEADER_SIZE, &free_head_, sizeof(free_head_));
+  stack_.Set(page, data);
+
+  free_head_ = page;
+  nodes_.erase(page);
+  WriteMeta();
+}
+
+template <std::size_t P, typename D>
+void BTreeIndex<P, D>::ClearCaches()
+{
+  nodes_.clear();
+  hashes_.clear();
+  max_split_ = 0;
+}
+
+template <std::size_t P, typename D>
+bool BTreeIndex<P, D>::FindEntry(OrderedKey const &key, Entry &entry)
+{
+  if (root_ == NO_PAGE)
+  {
+    return false;
+  }
+
+  auto node = LoadNode(root_);
+  while (!node->leaf)
+  {
+    node = LoadNode(node->children[ChildIndex(*node, key)]);
+  }
+
+  auto const it = std::lower_bound(
+      node->entries.begin(), node->entries.end(), key,
+      [](Entry const &element, OrderedKey const &value) { return element.key < value; });
+
+  if ((it == node->entries.end()) || (it->key != key))
+  {
+    return false;
+  }
+
+  entry = *it;
+  return true;
+}
+
+/**
+ * Find the first entry in the sub-tree which is greater than (or equal to, when not strict) the
+ * specified key
+ */
+template <std::size_t P, typename D>
+bool BTreeIndex<P, D>::FindCeiling(uint64_t page, OrderedKey const &key, bool strict, Entry &entry)
+{
+  auto const node = LoadNode(page);
+
+  if (node->leaf)
+  {
+    auto const compare = [strict](Entry const &element, OrderedKey const &value) {
+      return strict ? !(value < element.key) : (element.key < value);
+    };
+
+    auto const it = std::lower_bound(node->entries.begin(), node->entries.end(), key, compare);
+    if (it == node->entries.end())
+    {
+      return false;
+    }
+
+    entry = *it;
+    return true;
+  }
+
+  // since pages are not merged a child might not contain a suitable entry, continue to the right
+  for (std::size_t i = ChildIndex(*node, key); i < node->children.size(); ++i)
+  {
+    if (FindCeiling(node->children[i], key, strict, entry))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Find the last entry in the sub-tree which is less than or equal to the specified key
+ */
+template <std::size_t P, typename D>
+bool BTreeIndex<P, D>::FindFloor(uint64_t page, OrderedKey const &key, Entry &entry)
+{
+  auto const node = LoadNode(page);
+
+  if (node->leaf)
+  {
+    auto const it = std::upper_bound(
+        node->entries.begin(), node->entries.end(), key,
+        [](OrderedKey const &value, Entry const &element) { return value < element.key; });
+
+    if (it == node->entries.begin())
+    {
+      return false;
+    }
+
+    entry = *(it - 1);
+    return true;
+  }
+
+  for (std::size_t i = ChildIndex(*node, key) + 1; i > 0; --i)
+  {
+    if (FindFloor(node->children[i - 1], key, entry))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template <std::size_t P, typename D>
+bool BTreeIndex<P, D>::FindAbove(OrderedKey const &key, Entry &entry)
+{
+  return (root_ != NO_PAGE) && FindCeiling(root_, key, true, entry);
+}
+
+/**
+ * Insert or update an entry in the tree, splitting pages as required
+ *
+ * @param entry The entry to be inserted
+ * @return true if a new entry was created, false if an existing entry was updated
+ */
+template <std::size_t P, typename D>
+bool BTreeIndex<P, D>::InsertEntry(Entry const &entry)
+{
+  if (root_ == NO_PAGE)
+  {
+    auto node = std::make_shared<Node>();
+    node->entries.push_back(entry);
+
+    root_ = AllocatePage(node);
+    WriteMeta();
+    return true;
+  }
+
+  // descend to the leaf recording the path taken
+  Path     path;
+  uint64_t page = root_;
+  auto     node = LoadNode(page);
+  while (!node->leaf)
+  {
+    std::size_t const child = ChildIndex(*node, entry.key);
+    path.push_back({page, node, child});
+
+    page = node->children[child];
+    node = LoadNode(page);
+  }
+
+  auto it = std::lower_bound(
+      node->entries.begin(), node->entries.end(), entry.key,
+      [](Entry const &element, OrderedKey const &value) { return element.key < value; });
+
+  // update of an existing entry
+  if ((it != node->entries.end()) && (it->key == entry.key))
+  {
+    *it = entry;
+    StoreNode(page, node);
+    return false;
+  }
+
+  node->entries.insert(it, entry);
+  if (EncodedSize(*node) <= P)
+  {
+    StoreNode(page, node);
+    return true;
+  }
+
+  // split the leaf in half and propagate the separator upwards
+  auto right = std::make_shared<Node>();
+  auto mid   = node->entries.begin() + static_cast<std::ptrdiff_t>(node->entries.size() / 2);
+  right->entries.assign(mid, node->entries.end());
+  node->entries.erase(mid, node->entries.end());
+
+  OrderedKey separator  = right->entries.front().key;
+  uint64_t   right_page = AllocatePage(right);
+  uint64_t   left_page  = page;
+  StoreNode(left_page, node);
+
+  while (!path.empty())
+  {
+    auto element = path.back();
+    path.pop_back();
+
+    auto &parent = *element.node;
+    parent.separators.insert(
+        parent.separators.begin() + static_cast<std::ptrdiff_t>(element.child), separator);
+    parent.children.insert(
+        parent.children.begin() + static_cast<std::ptrdiff_t>(element.child + 1), right_page);
+
+    if (EncodedSize(parent) <= P)
+    {
+      StoreNode(element.page, element.node);
+      return true;
+    }
+
+    // split the inner node, the middle separator is moved up to the next level
+    auto              sibling = std::make_shared<Node>();
+    std::size_t const middle  = parent.separators.size() / 2;
+    auto const        sep_mid = static_cast<std::ptrdiff_t>(middle);
+    sibling->leaf             = false;
+    separator                 = parent.separators[middle];
+
+    sibling->separators.assign(parent.separators.begin() + sep_mid + 1, parent.separators.end());
+    sibling->children.assign(parent.children.begin() + sep_mid + 1, parent.children.end());
+    parent.separators.erase(parent.separators.begin() + sep_mid, parent.separators.end());
+    parent.children.erase(parent.children.begin() + sep_mid + 1, parent.children.end());
+
+    right_page = AllocatePage(sibling);
+    left_page  = element.page;
+    StoreNode(left_page, element.node);
+  }
+
+  // the root has been split, grow the tree by a level
+  auto new_root      = std::make_shared<Node>();
+  new_root->leaf     = false;
+  new_root->separators.push_back(separator);
+  new_root->children = {left_page, right_page};
+
+  root_ = AllocatePage(new_root);
+  WriteMeta();
+
+  return true;
+}
+
+/**
+ * Remove an entry from the tree. Pages which become empty are removed from their parents and
+ * returned to the free list.
+ *
+ * @param key The key to be removed
+ * @return true if the entry was found and removed, otherwise false
+ */
+template <std::size_t P, typename D>
+bool BTreeIndex<P, D>::EraseEntry(OrderedKey const &key)
+{
+  if (root_ == NO_PAGE)
+  {
+    return false;
+  }
+
+  Path     path;
+  uint64_t page = root_;
+  auto     node = LoadNode(page);
+  while (!node->leaf)
+  {
+    std::size_t const child = ChildIndex(*node, key);
+    path.push_back({page, node, child});
+
+    page = node->children[child];
+    node = LoadNode(page);
+  }
+
+  auto it = std::lower_bound(
+      node->entries.begin(), node->entries.end(), key,
+      [](Entry const &element, OrderedKey const &value) { return element.key < value; });
+
+  if ((it == node->entries.end()) || (it->key != key))
+  {
+    return false;
+  }
+
+  node->entries.erase(it);
+  if (!node->entries.empty())
+  {
+    StoreNode(page, node);
+    return true;
+  }
+
+  // the leaf is now empty, remove it (and any parents which become empty) from the tree
+  FreePage(page);
+
+  while (!path.empty())
+  {
+    auto element = path.back();
+    path.pop_back();
+
+    auto &parent = *element.node;
+    auto  child  = static_cast<std::ptrdiff_t>(element.child);
+
+    parent.children.erase(parent.children.begin() + child);
+    if (!parent.separators.empty())
+    {
+      parent.separators.erase(parent.separators.begin() + ((child > 0) ? (child - 1) : 0));
+    }
+
+    if (!parent.children.empty())
+    {
+      if (path.empty() && (parent.children.size() == 1))
+      {
+        // collapse a root with a single child
+        root_ = parent.children.front();
+        FreePage(element.page);
+      }
+      else
+      {
+        StoreNode(element.page, element.node);
+      }
+
+      return true;
+    }
+
+    FreePage(element.page);
+  }
+
+  // the tree is now empty
+  root_ = NO_PAGE;
+  WriteMeta();
+
+  return true;
+}
+
+template <std::size_t P, typename D>
+typename BTreeIndex<P, D>::Iterator BTreeIndex<P, D>::MakeIterator(OrderedKey const &prefix,
+                                                                   uint16_t          prefix_bits)
+{
+  Entry entry{};
+  if ((root_ == NO_PAGE) || !FindCeiling(root_, MaskKey(prefix, prefix_bits), false, entry) ||
+      (CommonPrefixBits(entry.key, prefix) < prefix_bits))
+  {
+    return end();
+  }
+
+  return Iterator{this, entry.key, entry.value, prefix, prefix_bits};
+}
+
+/**
+ * Compute the hash of the Patricia sub-tree containing all the keys with the specified prefix.
+ * The tree must contain at least one such key.
+ *
+ * @param prefix The key prefix (all other bits clear)
+ * @param bits The number of bits in the prefix
+ * @return The hash of the sub-tree
+ */
+template <std::size_t P, typename D>
+typename BTreeIndex<P, D>::HashArray BTreeIndex<P, D>::HashRegion(OrderedKey const &prefix,
+                                                                  std::size_t       bits)
+{
+  Entry first{};
+  Entry last{};
+
+  bool const found = FindCeiling(root_, prefix, false, first) &&
+                     FindFloor(root_, FillKey(prefix, bits), last);
+  if (!found || (CommonPrefixBits(first.key, prefix) < bits))
+  {
+    throw StorageException("Unable to locate B-tree index region");
+  }
+
+  // a single key, this is a leaf of the Patricia tree
+  if (first.key == last.key)
+  {
+    return first.hash;
+  }
+
+  // the split of the node is the first bit that differs within the region
+  auto const split  = static_cast<uint16_t>(CommonPrefixBits(first.key, last.key));
+  Region     region{split, MaskKey(first.key, split)};
+
+  auto const it = hashes_.find(region);
+  if (it != hashes_.end())
+  {
+    return it->second;
+  }
+
+  OrderedKey right_prefix = region.prefix;
+  SetBit(right_prefix, split);
+
+  HashArray const left  = HashRegion(region.prefix, split + 1u);
+  HashArray const right = HashRegion(right_prefix, split + 1u);
+
+  // matches KeyValuePair::UpdateNode
+  HashArray      hash{};
+  crypto::SHA256 hasher{};
+  hasher.Reset();
+  hasher.Update(right.data(), right.size());
+  hasher.Update(left.data(), left.size());
+  hasher.Final(hash.data());
+
+  if (hashes_.size() >= MAX_CACHED_HASHES)
+  {
+    hashes_.clear();
+    max_split_ = 0;
+  }
+
+  hashes_.emplace(region, hash);
+  max_split_ = std::max(max_split_, split);
+
+  return hash;
+}
+
+/**
+ * Remove the cached hashes of all the Patricia nodes which contain the specified key
+ */
+template <std::size_t P, typename D>
+void BTreeIndex<P, D>::InvalidateHashes(OrderedKey const &key)
+{
+  if (hashes_.empty())
+  {
+    return;
+  }
+
+  for (std::size_t split = 0; split <= max_split_; ++split)
+  {
+    hashes_.erase(Region{static_cast<uint16_t>(split), MaskKey(key, split)});
+  }
+}
+
+}  // namespace storage
+}  // namespace fetch
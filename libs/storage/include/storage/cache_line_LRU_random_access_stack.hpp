@@ -18,14 +18,22 @@
 //------------------------------------------------------------------------------
 
 #include "core/assert.hpp"
+#include "core/mutex.hpp"
 #include "storage/random_access_stack.hpp"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
-#include <unordered_map>
+#include <tuple>
+#include <utility>
 
 namespace fetch {
 namespace storage {
@@ -34,13 +42,18 @@ namespace storage {
  * The CacheLineLRURandomAccessStack owns a stack of type T (RandomAccessStack), and provides
  * caching in an invisible manner.
  *
- * It does this by maintaining a quick access structure (data_ map) that can be used without disk
- * access. The map resembles a CPU cache line.
+ * It does this by maintaining a quick access structure (the cache lines) that can be used without
+ * disk access. The cache lines resemble a CPU cache line.
  *
- * The stack is responsible for flushing this to disk at regular intervals to keep the map size
+ * The stack is responsible for flushing this to disk at regular intervals to keep the memory usage
  * small and guard against loss of data in the event of system failure. Sets and gets will fill
- * this map.
+ * the cache.
  *
+ * The cache lines are split between a number of shards, each with its own reader / writer lock and
+ * CLOCK eviction hand. Reads of cached lines only take a shared lock, so that Get and WriteBack
+ * can be called concurrently from multiple threads. Set, Push and Swap require exclusive access to
+ * the affected shards only. Loading, creating, clearing and closing the stack must not happen
+ * concurrently with any other operation.
  */
 template <typename T, typename D = uint64_t>
 class CacheLineLRURandomAccessStack
@@ -51,6 +64,8 @@ public:
   using HeaderExtraType  = D;
   using type             = T;
 
+  static constexpr std::size_t NUM_SHARDS = 8;
+
   CacheLineLRURandomAccessStack() = default;
 
   ~CacheLineLRURandomAccessStack()
@@ -72,15 +87,21 @@ public:
 
   void Load(std::string const &filename, bool const &create_if_not_exists = true)
   {
-    stack_.Load(filename, create_if_not_exists);
-    this->objects_ = stack_.size();
+    {
+      FETCH_LOCK(stack_lock_);
+      stack_.Load(filename, create_if_not_exists);
+      this->objects_ = stack_.size();
+    }
     this->SignalFileLoaded();
   }
 
   void New(std::string const &filename)
   {
-    stack_.New(filename);
-    this->objects_ = 0;
+    {
+      FETCH_LOCK(stack_lock_);
+      stack_.New(filename);
+      this->objects_ = 0;
+    }
     this->SignalFileLoaded();
   }
 
@@ -104,27 +125,26 @@ public:
   {
     assert(i < objects_);
 
-    uint64_t cache_lookup   = i >> cache_line_ln2;              // Upper N bits
-    uint64_t cache_subindex = i & ((1 << cache_line_ln2) - 1);  // Lower total - N bits
+    uint64_t const line     = i >> cache_line_ln2;  // Upper N bits
+    uint64_t const subindex = i & CACHE_LINE_MASK;  // Lower total - N bits
+    Shard &        shard    = LookupShard(line);
 
-    auto iter = data_.find(cache_lookup);
-
-    // Found the item via local map
-    if (iter != data_.end())
-    {
-      ++((*iter).second.reads);
-      (*iter).second.usage_flag = 1;
-      object                    = iter->second.elements[cache_subindex];
-    }
-    else
+    // Found the item in a cached line, only shared access is required
     {
-      // Case where item isn't found, load it into the cache, then access
-      LoadCacheLine(i);
+      std::shared_lock<std::shared_timed_mutex> lock(shard.lock);
 
-      data_[cache_lookup].reads++;
-      data_[cache_lookup].usage_flag = 1;
-      object                         = data_[cache_lookup].elements[cache_subindex];
+      auto iter = shard.lines.find(line);
+      if (iter != shard.lines.end())
+      {
+        iter->second.usage_flag = true;
+        object                  = iter->second.elements[subindex];
+        return;
+      }
     }
+
+    // Case where item isn't found, load it into the cache, then access
+    std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+    object = FetchLine(shard, line).elements[subindex];
   }
 
   /**
@@ -137,53 +157,39 @@ public:
   {
     assert(i < objects_);
 
-    uint64_t cache_lookup   = i >> cache_line_ln2;              // Upper N bits
-    uint64_t cache_subindex = i & ((1 << cache_line_ln2) - 1);  // Lower total - N bits
-
-    auto iter = data_.find(cache_lookup);
-
-    // Found the item via local map
-    if (iter != data_.end())
-    {
-      ++iter->second.writes;
-      (*iter).second.usage_flag             = 1;
-      iter->second.elements[cache_subindex] = object;
-    }
-    else
-    {
-      // Case where item isn't found, load it into the cache, then access
-      LoadCacheLine(i);
+    uint64_t const line  = i >> cache_line_ln2;
+    Shard &        shard = LookupShard(line);
 
-      data_[cache_lookup].writes++;
-      data_[cache_lookup].usage_flag               = 1;
-      data_[cache_lookup].elements[cache_subindex] = object;
-    }
+    std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+    SetElement(shard, line, i & CACHE_LINE_MASK, object);
   }
 
   void Close()
   {
     Flush(false);
+
+    FETCH_LOCK(stack_lock_);
     stack_.Close(false);
   }
 
   void SetExtraHeader(HeaderExtraType const &he)
   {
+    FETCH_LOCK(stack_lock_);
     stack_.SetExtraHeader(he);
   }
 
   HeaderExtraType const &header_extra() const
   {
+    FETCH_LOCK(stack_lock_);
     return stack_.header_extra();
   }
 
   uint64_t Push(type const &object)
   {
-    uint64_t ret = objects_;
-
-    ++objects_;
+    uint64_t const ret = objects_++;
 
     // Guaranteed to be safe - sets make sure the underlying stack has the memory
-    Set(objects_ - 1, object);
+    Set(ret, object);
 
     return ret;
   }
@@ -211,30 +217,30 @@ public:
       return;
     }
 
-    uint64_t cache_lookup_i = i >> cache_line_ln2;
-    uint64_t cache_lookup_j = j >> cache_line_ln2;
+    uint64_t const line_i  = i >> cache_line_ln2;
+    uint64_t const line_j  = j >> cache_line_ln2;
+    Shard &        shard_i = LookupShard(line_i);
+    Shard &        shard_j = LookupShard(line_j);
 
-    uint64_t cache_subindex_i = i & ((1 << cache_line_ln2) - 1);
-    uint64_t cache_subindex_j = j & ((1 << cache_line_ln2) - 1);
+    std::unique_lock<std::shared_timed_mutex> lock_i(shard_i.lock, std::defer_lock);
+    std::unique_lock<std::shared_timed_mutex> lock_j(shard_j.lock, std::defer_lock);
 
-    // make sure both items are in the cache
-    if (data_.find(cache_lookup_i) == data_.end())
+    if (&shard_i == &shard_j)
     {
-      LoadCacheLine(cache_lookup_i);
+      lock_i.lock();
     }
-
-    if (data_.find(cache_lookup_j) == data_.end())
+    else
     {
-      LoadCacheLine(cache_lookup_j);
+      std::lock(lock_i, lock_j);
     }
 
-    data_[cache_lookup_i].reads++;
-    data_[cache_lookup_i].usage_flag = 1;
-    data_[cache_lookup_j].reads++;
-    data_[cache_lookup_j].usage_flag = 1;
+    // the elements are copied out one at a time, since there might not be enough memory to hold
+    // both of the cache lines at once
+    type const a = FetchLine(shard_i, line_i).elements[i & CACHE_LINE_MASK];
+    type const b = FetchLine(shard_j, line_j).elements[j & CACHE_LINE_MASK];
 
-    std::swap(data_[cache_lookup_i].elements[cache_subindex_i],
-              data_[cache_lookup_j].elements[cache_subindex_j]);
+    SetElement(shard_j, line_j, j & CACHE_LINE_MASK, a);
+    SetElement(shard_i, line_i, i & CACHE_LINE_MASK, b);
   }
 
   std::size_t size() const
@@ -249,22 +255,51 @@ public:
 
   void Clear()
   {
+    for (auto &shard : shards_)
+    {
+      std::unique_lock<std::shared_timed_mutex> lock(shard.lock);
+      shard.lines.clear();
+      shard.hand = shard.lines.end();
+    }
+
+    FETCH_LOCK(stack_lock_);
     stack_.Clear();
-    objects_ = 0;
-    data_.clear();
+    objects_        = 0;
+    resident_lines_ = 0;
+  }
+
+  /**
+   * Write all of the modified cache lines back to the file. The lines remain cached.
+   *
+   * Only shared access to each of the shards is required, so this can be called periodically from
+   * a background thread while the stack is being read.
+   */
+  void WriteBack() const
+  {
+    for (auto &shard : shards_)
+    {
+      std::shared_lock<std::shared_timed_mutex> lock(shard.lock);
+
+      for (auto &line : shard.lines)
+      {
+        FlushLine(line.first << cache_line_ln2, line.second);
+      }
+    }
   }
 
   /**
    * Flush all of the cached elements to file if they have been updated
+   *
+   * @param lazy If set the modified lines are written back, otherwise the underlying file is also
+   * trimmed and flushed
    */
   void Flush(bool lazy = true) const
   {
+    WriteBack();
+
     if (!lazy)
     {
-      for (auto const &i : data_)
-      {
-        FlushLine(i.first << cache_line_ln2, i.second);
-      }
+      FETCH_LOCK(stack_lock_);
 
       // Trim stack size down
       while (stack_.size() > objects_ && stack_.is_open())
@@ -281,6 +316,7 @@ public:
 
   bool is_open() const
   {
+    FETCH_LOCK(stack_lock_);
     return stack_.is_open();
   }
 
@@ -297,8 +333,10 @@ public:
 
 private:
   // Cached items
-  static constexpr std::size_t cache_line_ln2 = 13;  // Default cache lines 8192 * sizeof(T)
-  std::size_t memory_limit_bytes_             = std::size_t(1ULL << 29);  // Default 500K memory
+  static constexpr std::size_t cache_line_ln2  = 13;  // Default cache lines 8192 * sizeof(T)
+  static constexpr uint64_t    CACHE_LINE_MASK = (1ull << cache_line_ln2) - 1;
+
+  std::atomic<std::size_t> memory_limit_bytes_{std::size_t(1ULL << 29)};  // Default 512M memory
 
   T dummy_;
 
@@ -306,37 +344,60 @@ private:
   EventHandlerType on_before_flush_;
 
   // Underlying stack
+  mutable Mutex     stack_lock_;
   mutable StackType stack_;
 
   struct CachedDataItem
   {
-    uint64_t                              reads      = 0;
-    uint64_t                              writes     = 0;
-    uint32_t                              usage_flag = 0;
+    mutable std::atomic<bool>             dirty{false};
+    mutable std::atomic<bool>             usage_flag{false};
     std::array<type, 1 << cache_line_ln2> elements;
   };
 
-  mutable std::map<uint64_t, CachedDataItem>                    data_;
-  mutable typename std::map<uint64_t, CachedDataItem>::iterator hand_    = data_.begin();
-  uint64_t                                                      objects_ = 0;
+  using CacheLines = std::map<uint64_t, CachedDataItem>;
+
+  struct Shard
+  {
+    mutable std::shared_timed_mutex lock;
+    CacheLines                      lines{};
+    typename CacheLines::iterator   hand{lines.end()};
+  };
+
+  mutable std::array<Shard, NUM_SHARDS> shards_{};
+  mutable std::atomic<std::size_t>      resident_lines_{0};
+  std::atomic<uint64_t>                 objects_{0};
 
+  Shard &LookupShard(uint64_t line) const
+  {
+    return shards_[line % NUM_SHARDS];
+  }
+
+  /**
+   * Write a cache line to the file if it has been modified. May be called with only shared access
+   * to the owning shard.
+   */
   void FlushLine(uint64_t line, CachedDataItem const &items) const
   {
-    if (items.writes == 0)
+    if (!items.dirty)
     {
       return;
     }
 
+    FETCH_LOCK(stack_lock_);
+
     if (!stack_.is_open())
     {
       return;
     }
 
     stack_.SetBulk(line, 1 << cache_line_ln2, items.elements.data());
+    items.dirty = false;
   }
 
   void GetLine(uint64_t line, CachedDataItem &items) const
   {
+    FETCH_LOCK(stack_lock_);
+
     if (!stack_.is_open())
     {
       return;
@@ -345,7 +406,12 @@ private:
     stack_.GetBulk(line, 1 << cache_line_ln2, items.elements.data());
   }
 
-  bool ManageMemory() const
+  /**
+   * Evict a single line from the shard. Requires exclusive access to the shard.
+   *
+   * @return true if a line was evicted, otherwise false
+   */
+  bool EvictLine(Shard &shard) const
   {
     /**
      * Clock replacment policy: On page fault, the clock hand starts to sweep clock-wise. If it
@@ -353,9 +419,7 @@ private:
      * page is chosen for replacement. In the worst case all use bits might be set and the pointer
      * cycles through all the frames, giving each page a second chance.
      */
-    using MapElement = typename decltype(data_)::value_type;
-
-    if (!(data_.size() * sizeof(MapElement) > memory_limit_bytes_))
+    if (shard.lines.empty())
     {
       return false;
     }
@@ -363,40 +427,67 @@ private:
     // Find and remove next index up from the last one we removed whose usage_flag = 0
     for (;;)
     {
-      if (hand_ == data_.end())
+      if (shard.hand == shard.lines.end())
       {
-        hand_ = data_.begin();
+        shard.hand = shard.lines.begin();
       }
 
-      if (hand_->second.usage_flag == 0)
+      if (!shard.hand->second.usage_flag)
       {
-        auto temp = hand_;
-        ++hand_;
+        auto temp = shard.hand;
+        ++shard.hand;
         FlushLine(temp->first << cache_line_ln2, temp->second);
-        data_.erase(temp);
+        shard.lines.erase(temp);
+        --resident_lines_;
         break;
       }
+
       // Setting usage_flag to 0
-      hand_->second.usage_flag = 0;
-      ++hand_;
+      shard.hand->second.usage_flag = false;
+      ++shard.hand;
     }
+
     return true;
   }
 
-  void LoadCacheLine(uint64_t line) const
+  /**
+   * Lookup a cache line, loading it from the file if required. Requires exclusive access to the
+   * shard.
+   */
+  CachedDataItem &FetchLine(Shard &shard, uint64_t line) const
   {
-    // Cull memory usage to max allowed
-    for (;;)
+    auto iter = shard.lines.find(line);
+
+    if (iter == shard.lines.end())
     {
-      if (!ManageMemory())
+      // Cull memory usage to max allowed, lines are only evicted from this shard so that the
+      // other shards can continue to be accessed (memory usage now slightly over)
+      while ((resident_lines_ * sizeof(CachedDataItem) > memory_limit_bytes_) &&
+             EvictLine(shard))
       {
-        break;
       }
+
+      // Load in the cache line
+      iter = shard.lines
+                 .emplace(std::piecewise_construct, std::forward_as_tuple(line),
+                          std::forward_as_tuple())
+                 .first;
+      ++resident_lines_;
+
+      GetLine(line << cache_line_ln2, iter->second);
     }
 
-    // Load in the cache line (memory usage now slightly over)
-    uint64_t cache_index = (line >> cache_line_ln2) << cache_line_ln2;
-    GetLine(cache_index, data_[cache_index >> cache_line_ln2]);
+    iter->second.usage_flag = true;
+
+    return iter->second;
+  }
+
+  void SetElement(Shard &shard, uint64_t line, uint64_t subindex, type const &object)
+  {
+    auto &items = FetchLine(shard, line);
+
+    items.elements[subindex] = object;
+    items.dirty              = true;
   }
 
   void SignalFileLoaded()
@@ -0,0 +1,62 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstdint>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * The codecs with which a document can be stored. The codec of each document is recorded in its
+ * header, so documents stored with different codecs (or none) can be mixed in the same store.
+ */
+enum class CompressionCodec : uint8_t
+{
+  NONE = 0,  ///< The document is stored as is
+  LZ4  = 1,  ///< The LZ4 block format, preceded by the size of the original document
+};
+
+char const *ToString(CompressionCodec codec);
+
+/**
+ * Compress a document with the specified codec
+ *
+ * @param codec The codec to be used
+ * @param input The document to be compressed
+ * @param output The buffer to be populated with the compressed document
+ * @return true if the document was compressed into fewer bytes than the input, otherwise false
+ */
+bool Compress(CompressionCodec codec, byte_array::ConstByteArray const &input,
+              byte_array::ByteArray &output);
+
+/**
+ * Decompress a document with the specified codec. Throws a StorageException if the compressed
+ * document is corrupt.
+ *
+ * @param codec The codec with which the document was compressed
+ * @param input The compressed document
+ * @param output The buffer to be populated with the original document
+ */
+void Decompress(CompressionCodec codec, byte_array::ConstByteArray const &input,
+                byte_array::ByteArray &output);
+
+}  // namespace storage
+}  // namespace fetch
@@ -18,13 +18,19 @@
 //------------------------------------------------------------------------------
 
 #include "core/byte_array/byte_array.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "storage/compression.hpp"
 #include "storage/file_object.hpp"
 #include "storage/key_value_index.hpp"
 #include "storage/resource_mapper.hpp"
+#include "storage/storage_exception.hpp"
 
 #include <cassert>
 #include <fstream>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "core/mutex.hpp"
 #include "network/service/protocol.hpp"
@@ -63,6 +69,17 @@ public:
 
   static constexpr char const *LOGGING_NAME = "DocumentStore";
 
+  /**
+   * The contents of a document as they are held in the document file, that is before they are
+   * decompressed. Stored documents can be decoded (see Decode) without access to the store.
+   */
+  struct StoredDocument
+  {
+    ByteArray        key{};
+    ByteArray        contents{};
+    CompressionCodec codec{CompressionCodec::NONE};
+  };
+
   DocumentStore()                         = default;
   DocumentStore(DocumentStore const &rhs) = delete;
   DocumentStore(DocumentStore &&rhs)      = delete;
@@ -123,7 +140,7 @@ public:
       return document;
     }
 
-    return file_object_.AsDocument();
+    return ReadDocument();
   }
 
   Document Get(ResourceID const &rid)
@@ -131,54 +148,126 @@ public:
     return GetOrCreate(rid, false);
   }
 
-  void Set(ResourceID const &rid, byte_array::ConstByteArray const &value)
+  /**
+   * Locate the contents of a document within the underlying document file. This is only possible
+   * when the document fits within a single block, the contents of larger documents are interleaved
+   * with the block metadata, and when it is stored uncompressed.
+   *
+   * @param rid The resource id of the document
+   * @param offset The byte offset of the document contents from the start of the file
+   * @param length The length of the document contents in bytes
+   * @return true if the document exists and is stored contiguously, otherwise false
+   */
+  bool Locate(ResourceID const &rid, uint64_t &offset, uint64_t &length)
   {
-    byte_array::ConstByteArray const &address = rid.id();
-    IndexType                         index   = 0;
+    IndexType index = 0;
 
     FETCH_LOCK(mutex_);
 
-    if (key_index_.GetIfExists(address, index))
+    if (!key_index_.GetIfExists(rid.id(), index))
     {
-      file_object_.SeekFile(index);
+      return false;
     }
-    else
+
+    file_object_.SeekFile(index);
+
+    length = file_object_.FileObjectSize();
+    if ((length > FileBlockType::CAPACITY) ||
+        (file_object_.codec() != static_cast<uint8_t>(CompressionCodec::NONE)))
     {
-      // Create new file, with new index etc.
-      // write this to the key index
-      file_object_.CreateNewFile(value.size());
+      return false;
     }
 
-    file_object_.Resize(value.size());
+    offset = file_object_.underlying_stack().FileOffset(index) + FileBlockType::META_DATA_BYTES;
 
-    file_object_.Write(value);
-    file_object_.Flush();
+    return true;
+  }
+
+  void Set(ResourceID const &rid, byte_array::ConstByteArray const &value)
+  {
+    FETCH_LOCK(mutex_);
 
-    key_index_.Set(address, file_object_.id(), file_object_.Hash());
+    SetInternal(rid, value);
+
+    file_object_.Flush();
     key_index_.Flush();
   }
 
   void Erase(ResourceID const &rid)
   {
-    byte_array::ConstByteArray const &address = rid.id();
-    IndexType                         index   = 0;
+    FETCH_LOCK(mutex_);
 
+    if (EraseInternal(rid))
+    {
+      key_index_.Flush();
+      file_object_.Flush();
+    }
+  }
+
+  /**
+   * Apply a batch of writes and erasures to the store. Unlike `Set` and `Erase`, the file object
+   * and key index are only flushed once at the end of the batch.
+   *
+   * @param writes The container of (ResourceID, value) pairs to be written
+   * @param erasures The container of ResourceIDs to be erased
+   */
+  template <typename WRITES, typename ERASURES>
+  void ApplyBatch(WRITES const &writes, ERASURES const &erasures)
+  {
     FETCH_LOCK(mutex_);
 
-    if (key_index_.GetIfExists(address, index))
+    for (auto const &erasure : erasures)
     {
-      file_object_.SeekFile(index);
+      EraseInternal(erasure);
     }
-    else
+
+    for (auto const &write : writes)
     {
-      return;
+      SetInternal(write.first, write.second);
     }
 
-    key_index_.Erase(address);
+    file_object_.Flush();
     key_index_.Flush();
+  }
+
+  /**
+   * Populate an empty store with a batch of documents, for example the genesis state. The
+   * documents are written to the file store and the key index is then built in a single pass,
+   * rather than being updated (and rehashed) for each of the documents in turn.
+   *
+   * @param writes The container of (ResourceID, value) pairs to be written
+   */
+  template <typename WRITES>
+  void Import(WRITES const &writes)
+  {
+    FETCH_LOCK(mutex_);
+
+    if (!key_index_.empty())
+    {
+      throw StorageException("Imports are only possible into an empty document store");
+    }
+
+    std::vector<IndexEntry> entries{};
+    entries.reserve(writes.size());
+
+    for (auto const &write : writes)
+    {
+      auto const &value = write.second;
+
+      CompressionCodec codec{CompressionCodec::NONE};
+      auto const       stored = EncodeDocument(value, codec);
+
+      file_object_.CreateNewFile(stored.size());
+      WriteDocument(stored, codec);
+
+      entries.emplace_back(
+          IndexEntry{write.first.id(), file_object_.id(), crypto::Hash<crypto::SHA256>(value)});
+    }
+
+    key_index_.BulkLoad(entries);
 
-    file_object_.Erase();
     file_object_.Flush();
+    key_index_.Flush();
   }
 
   void Flush(bool lazy = true)
@@ -193,6 +282,49 @@ public:
     return key_index_.size();
   }
 
+  /**
+   * Set the codec with which documents are compressed as they are written. A document is only
+   * stored compressed when this reduces the number of blocks that it occupies, so small documents
+   * are never compressed. The codec is recorded with each document, changing it does not affect
+   * the documents already written and they remain readable. The hashes of the documents (and so of
+   * the store) are always those of the uncompressed documents.
+   *
+   * @param codec The codec to be used for subsequent writes
+   */
+  void SetCompression(CompressionCodec codec)
+  {
+    FETCH_LOCK(mutex_);
+    codec_ = codec;
+  }
+
+  CompressionCodec compression() const
+  {
+    return codec_;
+  }
+
+  /**
+   * Decode a stored document, decompressing it if required. Since this does not access the store
+   * it is safe to decode several documents concurrently.
+   *
+   * @param stored The stored document
+   * @return The document
+   */
+  static Document Decode(StoredDocument const &stored)
+  {
+    Document document;
+
+    if (stored.codec == CompressionCodec::NONE)
+    {
+      document.document = stored.contents;
+    }
+    else
+    {
+      Decompress(stored.codec, stored.contents, document.document);
+    }
+
+    return document;
+  }
+
   /**
    * STL-like functionality achieved with an iterator class. This has to wrap an
    * iterator to the
@@ -242,7 +374,27 @@ public:
       // The key value (index of file) must be valid at this point
       self_->file_object_.SeekFile(kv.second);
 
-      return self_->file_object_.AsDocument();
+      return self_->ReadDocument();
+    }
+
+    /**
+     * Read the document as it is stored, leaving it to be decoded later (see Decode)
+     *
+     * @return The stored document
+     */
+    StoredDocument GetStored() const
+    {
+      auto kv = *wrapped_iterator_;
+
+      self_->file_object_.SeekFile(kv.second);
+
+      StoredDocument stored;
+      stored.key   = std::move(kv.first);
+      stored.codec = static_cast<CompressionCodec>(self_->file_object_.codec());
+      stored.contents.Resize(self_->file_object_.FileObjectSize());
+      self_->file_object_.Read(stored.contents);
+
+      return stored;
     }
 
   protected:
@@ -340,10 +492,134 @@ public:
     return key_index_.Hash();
   }
 
+  /**
+   * Discard the history of both of the underlying stacks prior to the specified number of most
+   * recent commits. It will no longer be possible to revert to any of the discarded commits.
+   *
+   * @param retained_commits The number of the most recent commits to be retained
+   * @return The total number of history records discarded
+   */
+  std::size_t Compact(std::size_t retained_commits)
+  {
+    FETCH_LOCK(mutex_);
+    return key_index_.underlying_stack().Compact(retained_commits) +
+           file_object_.underlying_stack().Compact(retained_commits);
+  }
+
 protected:
+  struct IndexEntry
+  {
+    byte_array::ConstByteArray key;
+    uint64_t                   value;
+    byte_array::ConstByteArray hash;
+  };
+
+  void SetInternal(ResourceID const &rid, byte_array::ConstByteArray const &value)
+  {
+    byte_array::ConstByteArray const &address = rid.id();
+    IndexType                         index   = 0;
+
+    CompressionCodec codec{CompressionCodec::NONE};
+    auto const       stored = EncodeDocument(value, codec);
+
+    if (key_index_.GetIfExists(address, index))
+    {
+      file_object_.SeekFile(index);
+    }
+    else
+    {
+      // Create new file, with new index etc.
+      // write this to the key index
+      file_object_.CreateNewFile(stored.size());
+    }
+
+    WriteDocument(stored, codec);
+
+    // the hash of the contents is that of the uncompressed document
+    key_index_.Set(address, file_object_.id(), crypto::Hash<crypto::SHA256>(value));
+  }
+
+  /**
+   * Determine the contents to be stored for a document, compressing it if this saves blocks
+   *
+   * @param value The contents of the document
+   * @param codec Populated with the codec of the contents to be stored
+   * @return The contents to be stored
+   */
+  byte_array::ConstByteArray EncodeDocument(byte_array::ConstByteArray const &value,
+                                            CompressionCodec &                codec)
+  {
+    auto const blocks = [](std::size_t size) {
+      return platform::DivideCeil<uint64_t>(size, FileBlockType::CAPACITY);
+    };
+
+    if ((codec_ != CompressionCodec::NONE) && (value.size() > FileBlockType::CAPACITY) &&
+        Compress(codec_, value, write_buffer_) &&
+        (blocks(write_buffer_.size()) < blocks(value.size())))
+    {
+      codec = codec_;
+      return write_buffer_;
+    }
+
+    codec = CompressionCodec::NONE;
+    return value;
+  }
+
+  void WriteDocument(byte_array::ConstByteArray const &stored, CompressionCodec codec)
+  {
+    file_object_.Resize(stored.size());
+    file_object_.SetCodec(static_cast<uint8_t>(codec));
+    file_object_.Write(stored);
+  }
+
+  /**
+   * Read the current file object as a document, decompressing it if required. The compressed
+   * contents are read into a buffer which is reused between reads.
+   *
+   * @return The document
+   */
+  Document ReadDocument()
+  {
+    auto const codec = static_cast<CompressionCodec>(file_object_.codec());
+
+    if (codec == CompressionCodec::NONE)
+    {
+      return file_object_.AsDocument();
+    }
+
+    read_buffer_.Resize(file_object_.FileObjectSize());
+    file_object_.Read(read_buffer_);
+
+    Document document;
+    Decompress(codec, read_buffer_, document.document);
+
+    return document;
+  }
+
+  bool EraseInternal(ResourceID const &rid)
+  {
+    byte_array::ConstByteArray const &address = rid.id();
+    IndexType                         index   = 0;
+
+    if (!key_index_.GetIfExists(address, index))
+    {
+      return false;
+    }
+
+    file_object_.SeekFile(index);
+
+    key_index_.Erase(address);
+    file_object_.Erase();
+
+    return true;
+  }
+
   Mutex             mutex_;
   KeyValueIndexType key_index_;
   FileObjectType    file_object_;
+  CompressionCodec  codec_{CompressionCodec::NONE};
+  ByteArray         write_buffer_;  ///< Reused for the compressed contents of written documents
+  ByteArray         read_buffer_;   ///< Reused for the compressed contents of read documents
 };
 
 }  // namespace storage
@@ -26,11 +26,15 @@
 #include "storage/document_store.hpp"
 #include "storage/new_revertible_document_store.hpp"
 #include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
 #include "telemetry/histogram.hpp"
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <map>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -60,15 +64,25 @@ public:
 
     LOCK = 20,
     UNLOCK,
-    HAS_LOCK
+    HAS_LOCK,
+
+    GET_BATCH = 30,
+    GET_COMMITTED,
+    GET_COMMITTED_BATCH,
+    IMPORT,
+    SET_BATCH
   };
 
   explicit RevertibleDocumentStoreProtocol(NewRevertibleDocumentStore *doc_store, LaneType lane)
     : doc_store_(doc_store)
     , get_count_(CreateCounter(lane, "ledger_statedb_get_total", "The total no. get ops"))
+    , get_committed_count_(CreateCounter(lane, "ledger_statedb_get_committed_total",
+                                         "The total no. get committed ops"))
     , get_create_count_(
           CreateCounter(lane, "ledger_statedb_get_create_total", "The total no. get/create ops"))
     , set_count_(CreateCounter(lane, "ledger_statedb_set_total", "The total no. set ops"))
+    , set_bytes_(CreateCounter(lane, "ledger_statedb_set_bytes_total",
+                               "The total no. of document bytes written"))
     , commit_count_(CreateCounter(lane, "ledger_statedb_commit_total", "The total no. commit ops"))
     , revert_count_(CreateCounter(lane, "ledger_statedb_revert_total", "The total no. revert ops"))
     , current_hash_count_(CreateCounter(lane, "ledger_statedb_current_hash_total",
@@ -82,16 +96,27 @@ public:
           CreateCounter(lane, "ledger_statedb_has_lock_total", "The total no. has lock ops"))
     , get_durations_(CreateHistogram(lane, "ledger_statedb_get_request_seconds",
                                      "The histogram of get request durations"))
+    , get_committed_durations_(
+          CreateHistogram(lane, "ledger_statedb_get_committed_request_seconds",
+                          "The histogram of get committed request durations"))
     , set_durations_(CreateHistogram(lane, "ledger_statedb_set_request_seconds",
                                      "The histogram of set request durations"))
     , lock_durations_(CreateHistogram(lane, "ledger_statedb_lock_request_seconds",
                                       "The histogram of lock request durations"))
     , unlock_durations_(CreateHistogram(lane, "ledger_statedb_unlock_request_seconds",
                                         "The histogram of unlock request durations"))
+    , document_count_(telemetry::Registry::Instance().CreateGauge<uint64_t>(
+          "ledger_statedb_documents", "The no. of documents in the state at the last commit",
+          {{"lane", std::to_string(lane)}}))
   {
     this->Expose(GET, this, &RevertibleDocumentStoreProtocol::Get);
+    this->Expose(GET_BATCH, this, &RevertibleDocumentStoreProtocol::GetBatch);
+    this->Expose(GET_COMMITTED, this, &RevertibleDocumentStoreProtocol::GetCommitted);
+    this->Expose(GET_COMMITTED_BATCH, this, &RevertibleDocumentStoreProtocol::GetCommittedBatch);
     this->Expose(GET_OR_CREATE, this, &RevertibleDocumentStoreProtocol::GetOrCreate);
     this->Expose(SET, this, &RevertibleDocumentStoreProtocol::Set);
+    this->Expose(IMPORT, this, &RevertibleDocumentStoreProtocol::Import);
+    this->Expose(SET_BATCH, this, &RevertibleDocumentStoreProtocol::SetBatch);
 
     // Functionality for hashing/state
     this->Expose(COMMIT, this, &RevertibleDocumentStoreProtocol::Commit);
@@ -210,6 +235,16 @@ private:
                                                          {{"lane", std::to_string(lane)}});
   }
 
+  static uint64_t TotalSize(NewRevertibleDocumentStore::Values const &values)
+  {
+    uint64_t size{0};
+    for (auto const &value : values)
+    {
+      size += value.size();
+    }
+    return size;
+  }
+
   static telemetry::HistogramPtr CreateHistogram(LaneType lane, char const *name,
                                                  char const *description)
   {
@@ -230,6 +265,47 @@ private:
     return doc;
   }
 
+  std::vector<Document> GetBatch(std::vector<ResourceID> const &rids)
+  {
+    telemetry::FunctionTimer const timer{*get_durations_};
+
+    std::vector<Document> docs{};
+    docs.reserve(rids.size());
+
+    for (auto const &rid : rids)
+    {
+      docs.emplace_back(doc_store_->Get(rid));
+    }
+
+    get_count_->add(rids.size());
+    return docs;
+  }
+
+  Document GetCommitted(ResourceID const &rid)
+  {
+    telemetry::FunctionTimer const timer{*get_committed_durations_};
+
+    auto const doc = doc_store_->GetCommitted(rid);
+    get_committed_count_->increment();
+    return doc;
+  }
+
+  std::vector<Document> GetCommittedBatch(std::vector<ResourceID> const &rids)
+  {
+    telemetry::FunctionTimer const timer{*get_committed_durations_};
+
+    std::vector<Document> docs{};
+    docs.reserve(rids.size());
+
+    for (auto const &rid : rids)
+    {
+      docs.emplace_back(doc_store_->GetCommitted(rid));
+    }
+
+    get_committed_count_->add(rids.size());
+    return docs;
+  }
+
   Document GetOrCreate(ResourceID const &rid)
   {
     telemetry::FunctionTimer const timer{*get_durations_};
@@ -245,12 +321,39 @@ private:
 
     doc_store_->Set(rid, data);
     set_count_->increment();
+    set_bytes_->add(data.size());
+  }
+
+  void SetBatch(NewRevertibleDocumentStore::Keys const &  rids,
+                NewRevertibleDocumentStore::Values const &values)
+  {
+    telemetry::FunctionTimer const timer{*set_durations_};
+
+    std::size_t bytes{0};
+    for (std::size_t i = 0, end = std::min(rids.size(), values.size()); i < end; ++i)
+    {
+      doc_store_->Set(rids[i], values[i]);
+      bytes += values[i].size();
+    }
+    set_count_->add(rids.size());
+    set_bytes_->add(bytes);
+  }
+
+  void Import(NewRevertibleDocumentStore::Keys const &  rids,
+              NewRevertibleDocumentStore::Values const &values)
+  {
+    doc_store_->Import(rids, values);
+    set_count_->add(rids.size());
+    set_bytes_->add(TotalSize(values));
   }
 
   NewRevertibleDocumentStore::Hash Commit()
   {
     auto const hash = doc_store_->Commit();
     commit_count_->increment();
+
+    // the pending writes have just been flushed, so the size of the state is cheap to look up
+    document_count_->set(doc_store_->size());
     return hash;
   }
 
@@ -299,8 +402,10 @@ private:
   Protected<LockStatus> lock_status_;
 
   telemetry::CounterPtr   get_count_;
+  telemetry::CounterPtr   get_committed_count_;
   telemetry::CounterPtr   get_create_count_;
   telemetry::CounterPtr   set_count_;
+  telemetry::CounterPtr   set_bytes_;
   telemetry::CounterPtr   commit_count_;
   telemetry::CounterPtr   revert_count_;
   telemetry::CounterPtr   current_hash_count_;
@@ -310,9 +415,12 @@ private:
   telemetry::CounterPtr   unlock_count_;
   telemetry::CounterPtr   has_lock_count_;
   telemetry::HistogramPtr get_durations_;
+  telemetry::HistogramPtr get_committed_durations_;
   telemetry::HistogramPtr set_durations_;
   telemetry::HistogramPtr lock_durations_;
   telemetry::HistogramPtr unlock_durations_;
+
+  telemetry::GaugePtr<uint64_t> document_count_;
 };
 
 }  // namespace storage
@@ -149,6 +149,10 @@ public:
 
   uint64_t FileObjectSize() const;
 
+  uint8_t codec() const;
+
+  void SetCodec(uint8_t codec);
+
   byte_array::ConstByteArray Hash();
 
   void UpdateHash(HasherType &hasher);
@@ -185,12 +189,18 @@ private:
   uint64_t byte_index_global_ = 0;  // index of current byte within file
   uint64_t length_            = 0;  // length in bytes of file.
                                     // can be found from Get(id) right - any point in keeping?
+  uint8_t  codec_             = 0;  // codec with which the contents of the file are encoded
 
   // TODO(private 1067): BlockType -> BlockType etc.
   // TODO(private 1067): possibly some performance benefits by caching blocks like the free block
   // here
   static constexpr uint64_t free_block_index_ = 0;  // Location of the meta 'free block'
 
+  // The size recorded in the first block of a file doubles as its header, the top byte records the
+  // codec with which the file contents are encoded (0 for files written before codecs existed)
+  static constexpr uint64_t CODEC_SHIFT = 56;
+  static constexpr uint64_t SIZE_MASK   = (uint64_t{1} << CODEC_SHIFT) - 1;
+
   void Initalise();
 
   enum class Action
@@ -277,11 +287,16 @@ void FileObject<S>::Resize(uint64_t size)
   Seek(0);
   BlockType block;
 
+  if (size > SIZE_MASK)
+  {
+    throw StorageException("Attempt to resize file object beyond the maximum size");
+  }
+
   // Update block 0 with new size
   {
     Get(id_, block);
 
-    block.file_object_size = size;
+    block.file_object_size = size | (uint64_t{codec_} << CODEC_SHIFT);
     Set(id_, block);
     length_ = size;
   }
@@ -425,6 +440,40 @@ uint64_t FileObject<S>::FileObjectSize() const
   return length_;
 }
 
+/**
+ * Get the codec with which the contents of the current file object are encoded. The file object
+ * itself does not interpret the codec, it is recorded on behalf of the owner of the file.
+ *
+ * @return The codec of the file object
+ */
+template <typename S>
+uint8_t FileObject<S>::codec() const
+{
+  return codec_;
+}
+
+/**
+ * Record the codec with which the contents of the current file object are encoded
+ *
+ * @param codec The codec of the file object
+ */
+template <typename S>
+void FileObject<S>::SetCodec(uint8_t codec)
+{
+  if (codec == codec_)
+  {
+    return;
+  }
+
+  BlockType block;
+  Get(id_, block);
+
+  block.file_object_size = length_ | (uint64_t{codec} << CODEC_SHIFT);
+  Set(id_, block);
+
+  codec_ = codec;
+}
+
 template <typename S>
 byte_array::ConstByteArray FileObject<S>::Hash()
 {
@@ -466,7 +515,8 @@ bool FileObject<S>::SeekFile(std::size_t position)
   BlockType block;
   Get(id_, block);
 
-  length_ = block.file_object_size;
+  length_ = block.file_object_size & SIZE_MASK;
+  codec_  = static_cast<uint8_t>(block.file_object_size >> CODEC_SHIFT);
 
   return true;
 }
@@ -478,6 +528,7 @@ void FileObject<S>::CreateNewFile(uint64_t size)
   byte_index_        = 0;
   byte_index_global_ = 0;
   length_            = size;
+  codec_             = 0;
   auto target_blocks = platform::DivideCeil<uint64_t>(size, BlockType::CAPACITY);
 
   // corner case when size is 0 - we need at least one block per file
@@ -518,6 +569,7 @@ void FileObject<S>::Erase()
   FreeBlocksInList(id_);
   id_     = std::numeric_limits<uint64_t>::max();
   length_ = 0;
+  codec_  = 0;
 }
 
 template <typename S>
@@ -900,7 +952,7 @@ bool FileObject<S>::VerifyConsistency(std::vector<uint64_t> const &ids)
 
     Get(index, block);
 
-    uint64_t file_bytes      = block.file_object_size;
+    uint64_t file_bytes      = block.file_object_size & SIZE_MASK;
     auto     expected_blocks = platform::DivideCeil<uint64_t>(file_bytes, BlockType::CAPACITY);
     expected_blocks          = expected_blocks == 0 ? 1 : expected_blocks;
 
@@ -56,7 +56,9 @@
 // Representation of a possible configuration of the key value trie. When the split is maximal
 // (256), this represents that the node is a leaf. The nodes can contain additional information
 
+#include "core/macros.hpp"
 #include "crypto/sha256.hpp"
+#include "crypto/sha256_multi_buffer.hpp"
 #include "storage/cached_random_access_stack.hpp"
 #include "storage/key.hpp"
 #include "storage/new_versioned_random_access_stack.hpp"
@@ -64,10 +66,17 @@
 #include "storage/storage_exception.hpp"
 #include "storage/versioned_random_access_stack.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <deque>
-#include <queue>
+#include <functional>
+#include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -160,24 +169,6 @@ struct KeyValuePair
 template <typename KV = KeyValuePair<>, typename D = VersionedRandomAccessStack<KV>>
 class KeyValueIndex
 {
-  /**
-   * Used to keep track of the ordering of task priority, in this usage writing to the stack.
-   */
-  struct UpdateTask
-  {
-    uint64_t priority;
-    uint64_t element;
-
-    bool operator==(UpdateTask const &other) const
-    {
-      return (priority == other.priority) && (other.element == element);
-    }
-    bool operator<(UpdateTask const &other) const
-    {
-      return priority < other.priority;
-    }
-  };
-
 public:
   using SelfType       = KeyValueIndex<KV, D>;
   using StackType      = D;
@@ -219,73 +210,7 @@ public:
 
     stack_.SetExtraHeader(root_);
 
-    std::unordered_map<uint64_t, uint64_t> depths;
-    std::unordered_map<uint64_t, uint64_t> parents;
-    std::priority_queue<UpdateTask>        q;
-
-    for (auto &k : schedule_update_)
-    {
-      auto &         kv   = k.second;
-      uint64_t       last = k.first;
-      uint64_t       pid  = kv.parent;
-      key_value_pair parent;
-      uint64_t       depth = 1;
-
-      while (pid != uint64_t(-1))
-      {
-        if (parents.find(last) != parents.end())
-        {
-          depth += depths[last];
-          break;
-        }
-        parents[last] = pid;
-
-        stack_.Get(pid, parent);
-        last = pid;
-        pid  = parent.parent;
-        ++depth;
-      }
-
-      // Adding root
-      if (pid == uint64_t(-1))
-      {
-        parents[last] = pid;
-      }
-
-      last = k.first;
-      while (parents.find(last) != parents.end())
-      {
-        if (depths.find(last) != depths.end())
-        {
-          break;
-        }
-        depths[last] = depth;
-        q.push({depth, last});
-        --depth;
-        last = parents[last];
-      }
-    }
-
-    UpdateTask task{};
-    while (!q.empty())
-    {
-      task = q.top();
-      q.pop();
-
-      key_value_pair element, left, right;
-      stack_.Get(task.element, element);
-      if (element.is_leaf())
-      {
-        continue;
-      }
-
-      stack_.Get(element.left, left);
-      stack_.Get(element.right, right);
-      element.UpdateNode(left, right);
-      stack_.Set(task.element, element);
-    }
-
-    schedule_update_.clear();
+    UpdateHashes();
   }
 
   void Delete(byte_array::ConstByteArray const & /*key*/)
@@ -468,9 +393,83 @@ public:
     }
   }
 
+  /**
+   * Populate an empty index from a batch of entries in a single pass. Instead of inserting each of
+   * the keys in turn, the entries are sorted into trie order and the nodes are written bottom up,
+   * so that each node is pushed to the stack exactly once with its final links and hash. The
+   * resulting trie (and root hash) is identical to the one built by setting each entry in turn.
+   *
+   * Where a key appears more than once the last of its entries is retained.
+   *
+   * @param entries The container of entries, each with a key, value (file index) and hash member
+   */
+  template <typename ENTRIES>
+  void BulkLoad(ENTRIES const &entries)
+  {
+    if (!empty())
+    {
+      throw StorageException("Bulk loads are only possible into an empty index");
+    }
+
+    Leaves leaves{};
+    leaves.reserve(entries.size());
+
+    for (auto const &entry : entries)
+    {
+      key_value_pair leaf{};
+      leaf.key   = key_type{entry.key};
+      leaf.split = uint16_t{key_type::size_in_bits()};
+      leaf.UpdateLeaf(entry.value, entry.hash);
+
+      leaves.emplace_back(leaf);
+    }
+
+    // sort into the order of the leaves in the trie (smaller keys on the left)
+    std::stable_sort(leaves.begin(), leaves.end(),
+                     [](key_value_pair const &a, key_value_pair const &b) {
+                       int pos{0};
+                       return a.key.Compare(b.key, pos, key_type::BITS) < 0;
+                     });
+
+    // remove the duplicate keys, retaining the last entry which was added for each of them
+    SplitPositions splits{};
+    splits.reserve(leaves.size());
+
+    std::size_t count{0};
+    for (std::size_t i = 0; i < leaves.size(); ++i)
+    {
+      int pos{0};
+      if ((count > 0) && (leaves[i].key.Compare(leaves[count - 1].key, pos, key_type::BITS) == 0))
+      {
+        leaves[count - 1] = leaves[i];
+        continue;
+      }
+
+      if (count > 0)
+      {
+        // the first bit at which the leaf differs from its predecessor
+        splits.emplace_back(static_cast<uint16_t>(pos));
+      }
+
+      leaves[count++] = leaves[i];
+    }
+    leaves.resize(count);
+
+    if (leaves.empty())
+    {
+      return;
+    }
+
+    // the nodes are laid out in post order, the root of the trie is the final node
+    root_ = (2 * leaves.size()) - 2;
+    BuildSubtree(leaves, splits, 0, leaves.size(), 0, key_value_pair::TREE_ROOT_VALUE);
+  }
+
   byte_array::ByteArray Hash()
   {
-    stack_.Flush();
+    // only the paths to the modified leaves need rehashing, there is no need to flush the stack
+    UpdateHashes();
+
     key_value_pair kv;
     if (stack_.size() > 0)
     {
@@ -584,6 +583,11 @@ public:
       return std::make_pair(kv_.key.ToByteArray(), kv_.value);
     }
 
+    byte_array::ByteArray hash() const
+    {
+      return kv_.Hash();
+    }
+
   protected:
     key_value_pair kv_;
     key_value_pair kv_node_;
@@ -794,11 +798,160 @@ public:
   }
 
 private:
+  using Leaves         = std::vector<key_value_pair>;
+  using SplitPositions = std::vector<uint16_t>;
+
   StackType stack_;
 
   uint64_t                                     root_ = 0;
   std::unordered_map<uint64_t, key_value_pair> schedule_update_;
 
+  /**
+   * Recompute the hashes of all the nodes on the paths from the scheduled leaf updates to the
+   * root of the trie.
+   *
+   * The dirty nodes are collected once (shared paths are only visited once) and kept in memory
+   * while they are rehashed. Since a child always splits on a later bit than its parent,
+   * processing the nodes in descending split order guarantees that both children of a node are
+   * up to date before the node itself is rehashed. Each dirty node is written to the stack once.
+   */
+  void UpdateHashes()
+  {
+    if (schedule_update_.empty())
+    {
+      return;
+    }
+
+    using Nodes  = std::unordered_map<uint64_t, key_value_pair>;
+    using Levels = std::map<uint16_t, std::vector<uint64_t>, std::greater<uint16_t>>;
+
+    Nodes  nodes;
+    Levels levels;
+
+    for (auto const &update : schedule_update_)
+    {
+      // walk towards the root until we join a path which has already been visited
+      uint64_t pid = update.second.parent;
+      while ((pid != IndexType(-1)) && (nodes.find(pid) == nodes.end()))
+      {
+        auto &parent = nodes[pid];
+        stack_.Get(pid, parent);
+        levels[parent.split].emplace_back(pid);
+
+        pid = parent.parent;
+      }
+    }
+
+    auto const lookup = [this, &nodes](uint64_t index, key_value_pair &kv) {
+      auto const it = nodes.find(index);
+      if (it != nodes.end())
+      {
+        kv = it->second;
+      }
+      else
+      {
+        stack_.Get(index, kv);
+      }
+    };
+
+    // all the nodes of a level are independent, they are hashed together (right || left)
+    constexpr std::size_t HASH_SIZE = sizeof(key_value_pair::hash);
+
+    key_value_pair               left, right;
+    std::vector<uint8_t>         inputs, digests;
+    std::vector<uint8_t const *> pointers;
+    std::vector<std::size_t>     sizes;
+    for (auto const &level : levels)
+    {
+      std::size_t const count = level.second.size();
+
+      inputs.resize(count * 2 * HASH_SIZE);
+      digests.resize(count * HASH_SIZE);
+      pointers.resize(count);
+      sizes.assign(count, 2 * HASH_SIZE);
+
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        auto const &element = nodes[level.second[i]];
+
+        lookup(element.left, left);
+        lookup(element.right, right);
+
+        uint8_t *input = &inputs[i * 2 * HASH_SIZE];
+        std::memcpy(input, right.hash, HASH_SIZE);
+        std::memcpy(input + HASH_SIZE, left.hash, HASH_SIZE);
+        pointers[i] = input;
+      }
+
+      crypto::HashSHA256MultiBuffer(pointers.data(), sizes.data(), count, digests.data());
+
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        auto &element = nodes[level.second[i]];
+        std::memcpy(element.hash, &digests[i * HASH_SIZE], HASH_SIZE);
+        stack_.Set(level.second[i], element);
+      }
+    }
+
+    schedule_update_.clear();
+  }
+
+  /**
+   * Internal: Write the subtree for a range of sorted leaves to the stack, in post order
+   *
+   * A subtree of n leaves has 2n - 1 nodes, so the location of every node is known before it is
+   * written. This allows each of the nodes to be pushed once, after both of its children.
+   *
+   * @param leaves The sorted leaves
+   * @param splits The split position between each of the adjacent leaves
+   * @param begin The index of the first leaf in the range
+   * @param end The index after the last leaf in the range
+   * @param base The location on the stack of the first node of the subtree
+   * @param parent The location on the stack of the parent of the subtree
+   * @return The root node of the subtree
+   */
+  key_value_pair BuildSubtree(Leaves const &leaves, SplitPositions const &splits,
+                              std::size_t begin, std::size_t end, IndexType base, IndexType parent)
+  {
+    if ((end - begin) == 1)
+    {
+      key_value_pair leaf = leaves[begin];
+      leaf.parent         = parent;
+
+      IndexType const index = stack_.Push(leaf);
+      assert(index == base);
+      FETCH_UNUSED(index);
+
+      return leaf;
+    }
+
+    // the subtree splits on the earliest bit at which any of the adjacent leaves differ
+    auto const split = std::min_element(splits.begin() + static_cast<std::ptrdiff_t>(begin),
+                                        splits.begin() + static_cast<std::ptrdiff_t>(end - 1));
+    std::size_t const middle = static_cast<std::size_t>(split - splits.begin()) + 1;
+
+    IndexType const left_base  = base;
+    IndexType const right_base = base + (2 * (middle - begin)) - 1;
+    IndexType const index      = base + (2 * (end - begin)) - 2;
+
+    key_value_pair node{};
+    node.key    = leaves[begin].key;
+    node.split  = *split;
+    node.parent = parent;
+    node.left   = right_base - 1;
+    node.right  = index - 1;
+
+    key_value_pair const left  = BuildSubtree(leaves, splits, begin, middle, left_base, index);
+    key_value_pair const right = BuildSubtree(leaves, splits, middle, end, right_base, index);
+    node.UpdateNode(left, right);
+
+    IndexType const location = stack_.Push(node);
+    assert(location == index);
+    FETCH_UNUSED(location);
+
+    return node;
+  }
+
   /**
    * Update the parents of a changed node, since this changes the merkle tree
    *
@@ -0,0 +1,71 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * A read view over a file on disk which is memory mapped into the process.
+ *
+ * Slices of the file are returned as ConstByteArrays which reference the mapped pages directly,
+ * so no copy or allocation is made. The mapping is kept alive for as long as any of the returned
+ * slices are. As the file grows the view is remapped on demand, previously returned slices remain
+ * valid and continue to reference the old mapping.
+ *
+ * The file is mapped privately (copy on write), code which writes through a slice will never
+ * modify the file and the file should never be truncated while it is mapped.
+ */
+class MappedFile
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  // Construction / Destruction
+  MappedFile()                   = default;
+  MappedFile(MappedFile const &) = delete;
+  MappedFile(MappedFile &&)      = delete;
+  ~MappedFile()                  = default;
+
+  void Open(std::string const &filename);
+  void Close();
+
+  bool           IsMapped() const;
+  uint64_t       size() const;
+  ConstByteArray Slice(uint64_t offset, uint64_t length);
+
+  // Operators
+  MappedFile &operator=(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile &&) = delete;
+
+private:
+  bool Remap();
+
+  mutable Mutex  lock_;
+  std::string    filename_{};
+  ConstByteArray mapping_{};  ///< The whole of the currently mapped file
+};
+
+}  // namespace storage
+}  // namespace fetch
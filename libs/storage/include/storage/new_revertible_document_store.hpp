@@ -17,17 +17,24 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/mutex.hpp"
 #include "storage/document_store.hpp"
 #include "storage/new_versioned_random_access_stack.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage/state_snapshot.hpp"
 
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <shared_mutex>
 #include <string>
+#include <vector>
 
 namespace fetch {
 namespace storage {
 
-class ResourceID;
-
 class NewRevertibleDocumentStore
 {
 public:
@@ -35,6 +42,25 @@ public:
   using ByteArray      = byte_array::ConstByteArray;
   using UnderlyingType = storage::Document;
   using Keys           = std::vector<ResourceID>;
+  using Values         = std::vector<ByteArray>;
+
+  enum class WriteMode
+  {
+    IMMEDIATE,  ///< Every write is flushed to disk as it is made
+    BATCHED     ///< Writes are accumulated in memory and persisted in one batch
+  };
+
+  enum class IndexBackend
+  {
+    KEY_VALUE_INDEX,  ///< The binary patricia trie key value index
+    B_TREE            ///< The page based, prefix compressed B-tree index
+  };
+
+  // Construction / Destruction
+  explicit NewRevertibleDocumentStore(IndexBackend backend = IndexBackend::KEY_VALUE_INDEX);
+  NewRevertibleDocumentStore(NewRevertibleDocumentStore const &) = delete;
+  NewRevertibleDocumentStore(NewRevertibleDocumentStore &&)      = delete;
+  ~NewRevertibleDocumentStore();
 
   bool New(std::string const &state, std::string const &state_history, std::string const &index,
            std::string const &index_history, bool create_if_not_exist);
@@ -54,19 +80,100 @@ public:
 
   std::size_t size() const;
 
+  /// @name Write Mode
+  /// @{
+  void      SetWriteMode(WriteMode mode);
+  WriteMode write_mode() const;
+  void      FlushPendingWrites();
+  /// @}
+
+  /// @name Committed Reads
+  /// @{
+  void           EnableCommittedReads(bool enable);
+  bool           committed_reads_enabled() const;
+  UnderlyingType GetCommitted(ResourceID const &rid);
+  /// @}
+
+  /// @name History Compaction
+  /// @{
+  void        SetHistoryDepth(uint64_t depth);
+  uint64_t    history_depth() const;
+  std::size_t Compact();
+  /// @}
+
+  /// @name Bulk Import
+  /// @{
+  void Import(Keys const &keys, Values const &values);
+  /// @}
+
+  /// @name Compression
+  /// @{
+  void             SetCompression(CompressionCodec codec);
+  CompressionCodec compression() const;
+  /// @}
+
+  /// @name State Snapshots
+  /// @{
+  bool ReadSnapshotChunk(ResourceID const &cursor, std::size_t max_entries,
+                         StateSnapshotChunk &chunk);
+  void WriteSnapshotChunk(StateSnapshotChunk const &chunk);
+  /// @}
+
+  IndexBackend index_backend() const;
+
+  // Operators
+  NewRevertibleDocumentStore &operator=(NewRevertibleDocumentStore const &) = delete;
+  NewRevertibleDocumentStore &operator=(NewRevertibleDocumentStore &&) = delete;
+
 private:
-  using Storage = storage::DocumentStore<
-      2048,                 // block size
-      FileBlockType<2048>,  // file block type
-      KeyValueIndex<KeyValuePair<>, NewVersionedRandomAccessStack<KeyValuePair<>>>,  // Key value
-                                                                                     // index
-      NewVersionedRandomAccessStack<FileBlockType<2048>>>;                           // File store
-
-  std::string state_path_;
-  std::string state_history_path_;
-  std::string index_path_;
-  std::string index_history_path_;
-  Storage     storage_;
+  using PendingWrites   = std::map<ResourceID, ByteArray>;
+  using PendingErasures = std::set<ResourceID>;
+  using Preimages       = std::map<ResourceID, UnderlyingType>;
+  using SharedMutex     = std::shared_timed_mutex;
+
+  class Engine;
+  template <typename STORAGE>
+  class EngineImpl;
+
+  using EnginePtr = std::unique_ptr<Engine>;
+
+  /// The number of commits between each compaction of the history
+  static constexpr uint64_t COMPACTION_INTERVAL = 100;
+
+  static EnginePtr CreateEngine(IndexBackend backend);
+
+  IndexBackend index_backend_;
+  std::string  state_path_;
+  std::string  state_history_path_;
+  std::string  index_path_;
+  std::string  index_history_path_;
+  EnginePtr    storage_;  ///< The document store for the selected index backend
+
+  /// @name Batched Writes
+  /// @{
+  mutable Mutex   pending_lock_;  ///< guards the pending write set and the write mode
+  WriteMode       write_mode_{WriteMode::IMMEDIATE};
+  PendingWrites   pending_writes_{};
+  PendingErasures pending_erasures_{};
+  /// @}
+
+  /// @name Committed Reads
+  /// @{
+  mutable SharedMutex committed_lock_;  ///< guards the preimages and their consistency with storage
+  bool                committed_reads_{false};
+  Preimages           preimages_{};  ///< The committed value of each key modified since the commit
+  /// @}
+
+  /// @name History Compaction
+  /// @{
+  uint64_t history_depth_{0};  ///< The number of commits retained in the history, 0 = all
+  uint64_t commits_since_compaction_{0};
+  /// @}
+
+  void FlushPendingWritesLocked();
+  void ClearPendingWritesLocked();
+  void RecordPreimageLocked(ResourceID const &rid);
+  void ClearPreimages();
 };
 
 }  // namespace storage
@@ -42,9 +42,14 @@
 #include "storage/storage_exception.hpp"
 #include "storage/variant_stack.hpp"
 
+#include "core/byte_array/const_byte_array.hpp"
 #include "core/byte_array/encoders.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -318,16 +323,22 @@ public:
     stack_.Load(filename, create_if_not_exist);
     history_.Load(history, create_if_not_exist);
 
-    hash_history_.Load("hash_history_" + history, create_if_not_exist);
+    hash_history_path_ = "hash_history_" + history;
+    hash_history_.Load(hash_history_path_, create_if_not_exist);
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    RebuildKeyIndex();
   }
 
   void New(std::string const &filename, std::string const &history)
   {
     stack_.New(filename);
     history_.New(history);
-    hash_history_.New("hash_history_" + history);
+    hash_history_path_ = "hash_history_" + history;
+    hash_history_.New(hash_history_path_);
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    key_index_.clear();
   }
 
   void Clear()
@@ -337,6 +348,8 @@ public:
     hash_history_.Clear();
 
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    key_index_.clear();
   }
 
   type Get(std::size_t i) const
@@ -412,6 +425,7 @@ public:
 
     history_.Push(history_bookmark, HistoryBookmark::value);
     hash_history_.Push(history_bookmark);
+    ++key_index_[key.ToByteArray()];
 
     // Update our header with this information (the bookmark index)
     HeaderType h = stack_.header_extra();
@@ -428,39 +442,24 @@ public:
 
   bool HashExists(DefaultKey const &key) const
   {
-    if (hash_history_.empty())
-    {
-      FETCH_LOG_DEBUG(LOGGING_NAME, "Attempted to find if hash exists, but history is empty!");
-      return false;
-    }
-
-    uint64_t        hash_history_size = hash_history_.size();
-    HistoryBookmark book;
-
-    for (std::size_t i = 0; i < hash_history_size; ++i)
-    {
-      uint64_t reverse_index = hash_history_size - i - 1;
-      hash_history_.Get(reverse_index, book);
-
-      if (book.key == key)
-      {
-        return true;
-      }
-    }
-
-    return false;
+    return key_index_.find(key.ToByteArray()) != key_index_.end();
   }
 
   /**
    * Revert the main stack to the point at bookmark b by continually popping off changes from the
-   * history, inspecting their type, and applying a revert with that change. Unsafe if the key
-   * doesn't exist!
+   * history, inspecting their type, and applying a revert with that change.
    *
    * @param: b The bookmark to revert to
    *
    */
   void RevertToHash(DefaultKey const &key)
   {
+    // fail before modifying the stack if the key is not in the (retained) history
+    if (!HashExists(key))
+    {
+      throw StorageException("Attempt to revert to a key which is not in the history");
+    }
+
     bool bookmark_found = false;
 
     while (!bookmark_found)
@@ -500,6 +499,56 @@ public:
     }
   }
 
+  /**
+   * Discard the history prior to the specified number of most recent bookmarks. Once compacted it
+   * is no longer possible to revert to any of the discarded bookmarks, but the history files are
+   * rewritten so that the space they occupied is reclaimed.
+   *
+   * @param: retained_bookmarks The number of the most recent bookmarks which are retained
+   *
+   * @return: The number of history records which were discarded
+   */
+  std::size_t Compact(std::size_t retained_bookmarks)
+  {
+    if (retained_bookmarks == 0)
+    {
+      throw StorageException("At least one bookmark must be retained when compacting the history");
+    }
+
+    // determine the number of history records to keep, if there are not enough bookmarks in the
+    // history then there is nothing to do
+    std::size_t const retained_records =
+        history_.CountToType(HistoryBookmark::value, retained_bookmarks);
+    if (retained_records == 0)
+    {
+      return 0;
+    }
+
+    std::size_t const discarded_records = history_.size() - retained_records;
+    if (discarded_records == 0)
+    {
+      return 0;
+    }
+
+    history_.KeepNewest(retained_records);
+
+    // rewrite the hash history with only the retained bookmarks
+    std::size_t const            retained_keys = std::min(retained_bookmarks, hash_history_.size());
+    std::vector<HistoryBookmark> bookmarks(retained_keys);
+    hash_history_.GetBulk(hash_history_.size() - retained_keys, retained_keys, bookmarks.data());
+
+    hash_history_.New(hash_history_path_);
+    for (auto const &bookmark : bookmarks)
+    {
+      hash_history_.Push(bookmark);
+    }
+    hash_history_.Flush(false);
+
+    RebuildKeyIndex();
+
+    return discarded_records;
+  }
+
   void Flush(bool lazy = true)
   {
     // Note that the variant stack (history) does not need flushing
@@ -524,8 +573,12 @@ public:
   }
 
 private:
+  using KeyIndex = std::unordered_map<byte_array::ConstByteArray, uint64_t>;
+
   VariantStack                       history_;
   RandomAccessStack<HistoryBookmark> hash_history_;
+  std::string                        hash_history_path_;
+  KeyIndex                           key_index_;  ///< Number of bookmarks for each key
   uint64_t                           internal_bookmark_index_{0};
 
   EventHandlerType on_file_loaded_;
@@ -559,11 +612,33 @@ private:
       }
 
       hash_history_.Pop();
+      RemoveFromKeyIndex(book.key);
     }
 
     return key_to_compare == book.key;
   }
 
+  void RebuildKeyIndex()
+  {
+    key_index_.clear();
+
+    HistoryBookmark book;
+    for (std::size_t i = 0; i < hash_history_.size(); ++i)
+    {
+      hash_history_.Get(i, book);
+      ++key_index_[book.key.ToByteArray()];
+    }
+  }
+
+  void RemoveFromKeyIndex(DefaultKey const &key)
+  {
+    auto it = key_index_.find(key.ToByteArray());
+    if (it != key_index_.end() && (--it->second == 0))
+    {
+      key_index_.erase(it);
+    }
+  }
+
   void RevertSwap()
   {
     HistorySwap swap;
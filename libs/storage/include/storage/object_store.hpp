@@ -20,10 +20,14 @@
 #include "core/serializers/base_types.hpp"
 #include "core/serializers/main_serializer.hpp"
 #include "storage/key_byte_array_store.hpp"
+#include "storage/parallel_document_reader.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -104,6 +108,21 @@ public:
     LocklessErase(rid);
   }
 
+  /**
+   * Locate the serialized object within the underlying document file
+   *
+   * @param: rid The key
+   * @param: offset The byte offset of the serialized object within the document file
+   * @param: length The length of the serialized object
+   *
+   * @return: whether the object exists and is stored contiguously on disk
+   */
+  bool Locate(ResourceID const &rid, uint64_t &offset, uint64_t &length)
+  {
+    FETCH_LOCK(mutex_);
+    return store_.Locate(rid, offset, length);
+  }
+
   /**
    * Check whether a key has been set
    *
@@ -130,6 +149,33 @@ public:
     LocklessSet(rid, object);
   }
 
+  /**
+   * Put a batch of objects into the store. Unlike `Set` the underlying document store is only
+   * flushed once at the end of the batch.
+   *
+   * @param: objects The container of (ResourceID, object) pairs
+   *
+   */
+  template <typename C>
+  void SetBatch(C const &objects)
+  {
+    using Write = std::pair<ResourceID, byte_array::ConstByteArray>;
+
+    std::vector<Write> writes{};
+    writes.reserve(objects.size());
+
+    for (auto const &entry : objects)
+    {
+      SerializerType ser;
+      ser << entry.second;
+
+      writes.emplace_back(entry.first, ser.data());
+    }
+
+    FETCH_LOCK(mutex_);
+    store_.ApplyBatch(writes, std::vector<ResourceID>{});
+  }
+
   /**
    * Obtain a lock then execute closure to reduce overhead from requiring
    * multiple locks to be
@@ -299,6 +345,32 @@ public:
     return Iterator(it);
   }
 
+  /**
+   * Get the objects of a subtree (the objects whose keys match the first bits of rid) in key
+   * order, deserializing them in parallel. Like iteration, this does not lock the structure, do
+   * this with WithLock.
+   *
+   * @param: rid The key
+   * @param: bits The number of bits of rid we want to match against
+   * @param: max_entries The maximum number of objects to get
+   *
+   * @return: the objects of the subtree
+   */
+  std::vector<type> LocklessGetSubtree(ResourceID const &rid, uint64_t bits,
+                                       std::size_t max_entries)
+  {
+    ParallelDocumentReader<KeyByteArrayStore<S>> reader{store_};
+
+    return reader.ReadSubtree(rid, bits, max_entries,
+                              [](byte_array::ConstByteArray const &, Document const &doc) {
+                                type           ret;
+                                SerializerType ser(doc.document);
+                                ser >> ret;
+
+                                return ret;
+                              });
+  }
+
   SelfType::Iterator begin()
   {
     return Iterator(store_.begin());
@@ -0,0 +1,304 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "storage/document.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * Reads documents from a document store in key order, decoding them in parallel.
+ *
+ * The documents are read from the store in batches, in order, since the underlying files are
+ * accessed through a single handle. Each batch is then decompressed and decoded on a worker
+ * thread while the following batches are read ahead, and the decoded batches are merged back
+ * together in key order. Subtrees are split into batches by partitioning their key space on the
+ * bits following the prefix.
+ *
+ * As with the iterators of the store, the reader does not lock the store. The caller is expected
+ * to prevent concurrent writes for the duration of the read.
+ */
+template <typename STORE>
+class ParallelDocumentReader
+{
+public:
+  using Store           = STORE;
+  using Iterator        = typename Store::Iterator;
+  using StoredDocument  = typename Store::StoredDocument;
+  using StoredDocuments = std::vector<StoredDocument>;
+  using ByteArray       = byte_array::ByteArray;
+  using ConstByteArray  = byte_array::ConstByteArray;
+
+  static constexpr uint64_t    KEY_BITS               = ResourceID::RESOURCE_ID_SIZE_IN_BITS;
+  static constexpr uint64_t    DEFAULT_PARTITION_BITS = 4;
+  static constexpr std::size_t BATCH_SIZE             = 64;
+  static constexpr std::size_t MIN_PARALLEL_BATCH     = 8;
+
+  // Construction / Destruction
+  explicit ParallelDocumentReader(Store &store, std::size_t read_ahead = 0);
+  ParallelDocumentReader(ParallelDocumentReader const &) = delete;
+  ParallelDocumentReader(ParallelDocumentReader &&)      = delete;
+  ~ParallelDocumentReader()                              = default;
+
+  template <typename Decoder>
+  using Result = decltype(std::declval<Decoder const &>()(std::declval<ByteArray const &>(),
+                                                          std::declval<Document const &>()));
+
+  template <typename Decoder>
+  using Results = std::vector<Result<Decoder>>;
+
+  /// @name Reading
+  /// @{
+  template <typename Decoder>
+  Results<Decoder> Read(Iterator &it, std::size_t max_entries, Decoder const &decoder);
+
+  template <typename Decoder>
+  Results<Decoder> ReadSubtree(ResourceID const &rid, uint64_t bits, std::size_t max_entries,
+                               Decoder const &decoder,
+                               uint64_t       partition_bits = DEFAULT_PARTITION_BITS);
+  /// @}
+
+  // Operators
+  ParallelDocumentReader &operator=(ParallelDocumentReader const &) = delete;
+  ParallelDocumentReader &operator=(ParallelDocumentReader &&) = delete;
+
+  static ByteArray PartitionKey(ConstByteArray const &key, uint64_t bits,
+                                uint64_t partition_bits, uint64_t partition);
+
+private:
+  template <typename Decoder, typename NextBatch>
+  Results<Decoder> Pipeline(NextBatch &&next_batch, Decoder const &decoder);
+
+  Store &     store_;
+  std::size_t read_ahead_;
+};
+
+template <typename S>
+constexpr uint64_t ParallelDocumentReader<S>::KEY_BITS;
+template <typename S>
+constexpr uint64_t ParallelDocumentReader<S>::DEFAULT_PARTITION_BITS;
+template <typename S>
+constexpr std::size_t ParallelDocumentReader<S>::BATCH_SIZE;
+template <typename S>
+constexpr std::size_t ParallelDocumentReader<S>::MIN_PARALLEL_BATCH;
+
+/**
+ * Construct the reader
+ *
+ * @param store The document store to be read
+ * @param read_ahead The maximum number of batches being decoded at any one time, by default the
+ * number of hardware threads
+ */
+template <typename S>
+ParallelDocumentReader<S>::ParallelDocumentReader(Store &store, std::size_t read_ahead)
+  : store_{store}
+  , read_ahead_{(read_ahead == 0) ? std::max<std::size_t>(std::thread::hardware_concurrency(), 1)
+                                  : read_ahead}
+{}
+
+/**
+ * Read and decode the documents following an iterator
+ *
+ * @param it The iterator to the first document, advanced past the last document read
+ * @param max_entries The maximum number of documents to be read
+ * @param decoder The callable which decodes a document, given its key and contents
+ * @return The decoded documents, in key order
+ */
+template <typename S>
+template <typename Decoder>
+typename ParallelDocumentReader<S>::template Results<Decoder> ParallelDocumentReader<S>::Read(
+    Iterator &it, std::size_t max_entries, Decoder const &decoder)
+{
+  auto const  end       = store_.end();
+  std::size_t remaining = max_entries;
+
+  return Pipeline(
+      [&](StoredDocuments &batch) {
+        for (; (it != end) && (remaining > 0) && (batch.size() < BATCH_SIZE); ++it, --remaining)
+        {
+          batch.emplace_back(it.GetStored());
+        }
+
+        return (it != end) && (remaining > 0);
+      },
+      decoder);
+}
+
+/**
+ * Read and decode the documents of a subtree, the documents whose keys match the first bits of the
+ * specified key
+ *
+ * @param rid The key
+ * @param bits The number of bits of the key to match against
+ * @param max_entries The maximum number of documents to be read
+ * @param decoder The callable which decodes a document, given its key and contents
+ * @param partition_bits The number of bits following the prefix on which the subtree is split
+ * @return The decoded documents, in key order
+ */
+template <typename S>
+template <typename Decoder>
+typename ParallelDocumentReader<S>::template Results<Decoder>
+ParallelDocumentReader<S>::ReadSubtree(ResourceID const &rid, uint64_t bits,
+                                       std::size_t max_entries, Decoder const &decoder,
+                                       uint64_t partition_bits)
+{
+  bits           = std::min(bits, KEY_BITS);
+  partition_bits = std::min(partition_bits, KEY_BITS - bits);
+
+  auto const  end        = store_.end();
+  auto const  partitions = uint64_t{1} << partition_bits;
+  uint64_t    partition  = 0;
+  std::size_t remaining  = max_entries;
+
+  return Pipeline(
+      [&](StoredDocuments &batch) {
+        auto const key = PartitionKey(rid.id(), bits, partition_bits, partition++);
+
+        for (auto it = store_.GetSubtree(ResourceID{key}, bits + partition_bits);
+             (it != end) && (remaining > 0); ++it, --remaining)
+        {
+          batch.emplace_back(it.GetStored());
+        }
+
+        return (partition < partitions) && (remaining > 0);
+      },
+      decoder);
+}
+
+/**
+ * Build the key of a partition of a subtree, by setting the bits which follow the prefix of the
+ * subtree to the index of the partition. Keys are ordered from the least significant bit of each
+ * byte (see Key), so the partitions are in key order.
+ *
+ * @param key The key of the subtree
+ * @param bits The number of bits of the key which form the prefix of the subtree
+ * @param partition_bits The number of bits following the prefix which identify the partition
+ * @param partition The index of the partition
+ * @return The key of the partition
+ */
+template <typename S>
+byte_array::ByteArray ParallelDocumentReader<S>::PartitionKey(ConstByteArray const &key,
+                                                              uint64_t bits,
+                                                              uint64_t partition_bits,
+                                                              uint64_t partition)
+{
+  ByteArray partition_key{key};
+
+  for (uint64_t i = 0; i < partition_bits; ++i)
+  {
+    uint64_t const bit  = bits + i;
+    auto const     mask = static_cast<uint8_t>(1u << (bit % 8));
+    auto &         byte = partition_key[bit / 8];
+
+    if (((partition >> (partition_bits - 1 - i)) & 1u) != 0)
+    {
+      byte = static_cast<uint8_t>(byte | mask);
+    }
+    else
+    {
+      byte = static_cast<uint8_t>(byte & ~mask);
+    }
+  }
+
+  return partition_key;
+}
+
+/**
+ * Internal: Read batches of documents from the store until there are none left, decoding them on
+ * worker threads while up to the read ahead limit of batches are outstanding. Small batches are
+ * decoded on the calling thread when their results are merged.
+ *
+ * @param next_batch The callable which populates the next batch, returning false after the last
+ * @param decoder The callable which decodes a document
+ * @return The decoded documents, in the order in which they were read
+ */
+template <typename S>
+template <typename Decoder, typename NextBatch>
+typename ParallelDocumentReader<S>::template Results<Decoder> ParallelDocumentReader<S>::Pipeline(
+    NextBatch &&next_batch, Decoder const &decoder)
+{
+  using Decoded = Results<Decoder>;
+
+  Decoded                          results{};
+  std::deque<std::future<Decoded>> pending{};
+
+  auto const merge_front = [&results, &pending]() {
+    auto decoded = pending.front().get();
+    pending.pop_front();
+
+    results.reserve(results.size() + decoded.size());
+    std::move(decoded.begin(), decoded.end(), std::back_inserter(results));
+  };
+
+  bool more{true};
+  while (more)
+  {
+    StoredDocuments batch{};
+    more = next_batch(batch);
+
+    if (batch.empty())
+    {
+      continue;
+    }
+
+    if (pending.size() >= read_ahead_)
+    {
+      merge_front();
+    }
+
+    auto const policy = ((read_ahead_ > 1) && (batch.size() >= MIN_PARALLEL_BATCH))
+                            ? std::launch::async
+                            : std::launch::deferred;
+
+    pending.emplace_back(std::async(policy, [&decoder, documents = std::move(batch)]() {
+      Decoded decoded{};
+      decoded.reserve(documents.size());
+
+      for (auto const &stored : documents)
+      {
+        decoded.emplace_back(decoder(stored.key, Store::Decode(stored)));
+      }
+
+      return decoded;
+    }));
+  }
+
+  while (!pending.empty())
+  {
+    merge_front();
+  }
+
+  return results;
+}
+
+}  // namespace storage
+}  // namespace fetch
@@ -26,9 +26,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <fstream>
 #include <functional>
+#include <limits>
 #include <string>
+#include <vector>
 
 #include "core/assert.hpp"
 #include "storage/storage_exception.hpp"
@@ -42,6 +45,29 @@ enum
 }
 namespace storage {
 
+/**
+ * Read policy for the RandomAccessStack which performs a single read from the file for every
+ * element which is accessed.
+ */
+struct DirectReadPolicy
+{
+  static constexpr std::size_t READ_AHEAD_ELEMENTS = 0;
+};
+
+/**
+ * Read policy for the RandomAccessStack which detects sequential access (in either direction) and
+ * reads the next N elements from the file in a single request.
+ *
+ * @tparam N The number of elements to be read ahead
+ */
+template <std::size_t N>
+struct ReadAheadPolicy
+{
+  static_assert(N > 1, "Read ahead must cover more than a single element");
+
+  static constexpr std::size_t READ_AHEAD_ELEMENTS = N;
+};
+
 /**
  * The RandomAccessStack maintains a stack of type T, writing to disk. Since elements on the stack
  * are uniform size, they can be easily addressed using simple arithmetic.
@@ -51,12 +77,17 @@ namespace storage {
  *
  * The header for the stack optionally allows arbitrary data to be stored, which can be useful to
  * the user
+ *
+ * The read policy determines how element reads are issued to the file. With a read ahead policy,
+ * scans through the stack (for example full state iteration or walking back through the history of
+ * a versioned stack) are served from a window of elements read with a single request.
  */
-template <typename T, typename D = uint64_t>
+template <typename T, typename D = uint64_t, typename P = DirectReadPolicy>
 class RandomAccessStack
 {
 private:
-  static constexpr char const *LOGGING_NAME = "RandomAccessStack";
+  static constexpr char const *LOGGING_NAME        = "RandomAccessStack";
+  static constexpr std::size_t READ_AHEAD_ELEMENTS = P::READ_AHEAD_ELEMENTS;
 
   /**
    * Header holding information for the structure. Magic is used to determine the endianness of the
@@ -104,6 +135,7 @@ private:
 public:
   using HeaderExtraType  = D;
   using type             = T;
+  using ReadPolicy       = P;
   using EventHandlerType = std::function<void()>;
 
   void ClearEventHandlers()
@@ -164,10 +196,12 @@ public:
       Flush();
     }
     file_handle_.close();
+    InvalidateReadAhead();
   }
 
   void Load(std::string const &filename, bool const &create_if_not_exist = false)
   {
+    InvalidateReadAhead();
 
     filename_    = filename;
     file_handle_ = std::fstream(filename_, std::ios::in | std::ios::out | std::ios::binary);
@@ -228,6 +262,11 @@ public:
     assert(!filename_.empty());
     assert(i < size());
 
+    if ((READ_AHEAD_ELEMENTS > 0) && ReadAhead(i, object))
+    {
+      return;
+    }
+
     auto n = int64_t(i * sizeof(type) + header_.size());
 
     file_handle_.seekg(n);
@@ -249,6 +288,12 @@ public:
 
     file_handle_.seekg(start, std::fstream::beg);
     file_handle_.write(reinterpret_cast<char const *>(&object), sizeof(type));
+
+    // keep the read ahead window consistent with the file
+    if ((i >= window_start_) && ((i - window_start_) < window_.size()))
+    {
+      window_[i - window_start_] = object;
+    }
   }
 
   /**
@@ -283,6 +328,8 @@ public:
   {
     assert(!filename_.empty());
 
+    InvalidateReadAhead();
+
     auto start = int64_t((i * sizeof(type)) + header_.size());
 
     file_handle_.seekg(start, std::fstream::beg);
@@ -403,6 +450,8 @@ public:
     type a, b;
     assert(!filename_.empty());
 
+    InvalidateReadAhead();
+
     auto n1 = int64_t(i * sizeof(type) + header_.size());
     auto n2 = int64_t(j * sizeof(type) + header_.size());
 
@@ -435,6 +484,7 @@ public:
     assert(!filename_.empty());
     std::fstream fin(filename_, std::ios::out | std::ios::binary);
     header_ = Header();
+    InvalidateReadAhead();
 
     if (!header_.Write(fin))
     {
@@ -480,6 +530,12 @@ public:
     file_handle_.write(reinterpret_cast<char const *>(&object), sizeof(type));
     ++header_.objects;
 
+    // the window might still contain a previously popped element at this index
+    if ((ret >= window_start_) && ((ret - window_start_) < window_.size()))
+    {
+      window_[ret - window_start_] = object;
+    }
+
     return ret;
   }
 
@@ -488,13 +544,91 @@ public:
     return file_handle_;
   }
 
+  /**
+   * Get the position in the file at which the specified object is stored
+   *
+   * @param: i The index of the object
+   * @return: The byte offset from the start of the file
+   */
+  uint64_t FileOffset(std::size_t i) const
+  {
+    return (i * sizeof(type)) + header_.size();
+  }
+
 private:
+  using Window = std::vector<type>;
+
+  static constexpr std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max();
+
   EventHandlerType     on_file_loaded_;
   EventHandlerType     on_before_flush_;
   mutable std::fstream file_handle_;
   std::string          filename_ = "";
   Header               header_;
 
+  mutable Window      window_{};             ///< The elements which have been read ahead
+  mutable std::size_t window_start_{0};      ///< The index of the first element in the window
+  mutable std::size_t last_read_{NO_INDEX};  ///< The last element read (first read is a scan)
+
+  /**
+   * Attempt to serve a read from the read ahead window, refilling the window when a sequential
+   * access pattern is detected
+   *
+   * @param: i The index of the object
+   * @param: object The object reference to fill
+   * @return: true if the read was served, otherwise false
+   */
+  bool ReadAhead(std::size_t i, type &object) const
+  {
+    bool const forwards  = (i == (last_read_ + 1));
+    bool const backwards = (i + 1 == last_read_);
+    last_read_           = i;
+
+    if ((i < window_start_) || ((i - window_start_) >= window_.size()))
+    {
+      // random access is read directly from the file
+      if (!(forwards || backwards))
+      {
+        return false;
+      }
+
+      std::size_t const read_ahead = READ_AHEAD_ELEMENTS;
+      std::size_t       first      = i;
+      std::size_t       count      = std::min(read_ahead, size() - i);
+
+      if (backwards)
+      {
+        count = std::min(read_ahead, i + 1);
+        first = i + 1 - count;
+      }
+
+      window_.resize(count);
+      window_start_ = first;
+
+      file_handle_.seekg(int64_t(first * sizeof(type) + header_.size()));
+      file_handle_.read(reinterpret_cast<char *>(window_.data()),
+                        std::streamsize(sizeof(type)) * std::streamsize(count));
+
+      if (!file_handle_)
+      {
+        // fall back to reading the single element
+        file_handle_.clear();
+        InvalidateReadAhead();
+        return false;
+      }
+    }
+
+    object = window_[i - window_start_];
+
+    return true;
+  }
+
+  void InvalidateReadAhead() const
+  {
+    window_.clear();
+    window_start_ = 0;
+  }
+
   /**
    * Write the header to disk. Not usually necessary since we can just refer to our local one
    *
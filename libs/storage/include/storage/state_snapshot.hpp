@@ -0,0 +1,83 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/group_definitions.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * A section of the contents of a state database, used to transfer a complete copy of the state
+ * between nodes. The chunks of a state are read in the iteration order of the database's index,
+ * each subsequent chunk beginning after the last key of the previous one.
+ */
+struct StateSnapshotChunk
+{
+  using Keys   = std::vector<ResourceID>;
+  using Values = std::vector<byte_array::ConstByteArray>;
+
+  byte_array::ConstByteArray state{};     ///< The hash of the state the chunk was read from
+  Keys                       keys{};      ///< The keys of the entries in the chunk
+  Values                     values{};    ///< The values of the entries (one for each key)
+  bool                       complete{};  ///< Flag to signal that this is the final chunk
+};
+
+}  // namespace storage
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<storage::StateSnapshotChunk, D>
+{
+public:
+  using Type       = storage::StateSnapshotChunk;
+  using DriverType = D;
+
+  static uint8_t const STATE    = 1;
+  static uint8_t const KEYS     = 2;
+  static uint8_t const VALUES   = 3;
+  static uint8_t const COMPLETE = 4;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &chunk)
+  {
+    auto map = map_constructor(4);
+    map.Append(STATE, chunk.state);
+    map.Append(KEYS, chunk.keys);
+    map.Append(VALUES, chunk.values);
+    map.Append(COMPLETE, chunk.complete);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &chunk)
+  {
+    map.ExpectKeyGetValue(STATE, chunk.state);
+    map.ExpectKeyGetValue(KEYS, chunk.keys);
+    map.ExpectKeyGetValue(VALUES, chunk.values);
+    map.ExpectKeyGetValue(COMPLETE, chunk.complete);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
@@ -38,9 +38,11 @@
 #include "storage/storage_exception.hpp"
 
 #include <cassert>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -261,6 +263,106 @@ public:
     fin.close();
   }
 
+  /**
+   * Count the number of objects from the top of the stack up to (and including) the n-th object of
+   * the specified type
+   *
+   * @param: type The type of the objects to be counted
+   * @param: n The number of objects of the type to be found
+   *
+   * @return: The number of objects, or zero if there are fewer than n objects of the type
+   */
+  std::size_t CountToType(uint64_t type, std::size_t n)
+  {
+    std::size_t objects{0};
+    std::size_t found{0};
+    int64_t     position = header_.end;
+
+    while ((found < n) && (objects < header_.object_count))
+    {
+      Separator const separator = ReadSeparator(position);
+
+      ++objects;
+      if (separator.type == type)
+      {
+        ++found;
+      }
+
+      position = separator.previous;
+    }
+
+    return (found == n) ? objects : 0;
+  }
+
+  /**
+   * Discard the oldest objects on the stack, keeping only the specified number of the most recent
+   * objects. The file is rewritten so that the space used by the discarded objects is reclaimed.
+   *
+   * @param: count The number of objects to keep
+   */
+  void KeepNewest(std::size_t count)
+  {
+    if (count >= header_.object_count)
+    {
+      return;
+    }
+
+    // collect the separators of the retained objects (most recent first)
+    std::vector<Separator> separators{};
+    separators.reserve(count);
+
+    int64_t position = header_.end;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      separators.push_back(ReadSeparator(position));
+      position = separators.back().previous;
+    }
+
+    // write the retained objects (oldest first) to a new file
+    std::string const compacted = filename_ + ".compact";
+    std::fstream      output(compacted, std::ios::out | std::ios::binary);
+
+    Header    header{count, int64_t{sizeof(Header) + sizeof(Separator)}};
+    Separator separator = {HEADER_OBJECT, 0, UNDEFINED_POSITION};
+    output.write(reinterpret_cast<char const *>(&header), sizeof(Header));
+    output.write(reinterpret_cast<char const *>(&separator), sizeof(Separator));
+
+    std::vector<char> buffer{};
+    for (auto it = separators.rbegin(); it != separators.rend(); ++it)
+    {
+      buffer.resize(it->object_size);
+
+      file_handle_.seekg(it->previous, std::fstream::beg);
+      file_handle_.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+      separator = {it->type, it->object_size, header.end};
+      output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      output.write(reinterpret_cast<char const *>(&separator), sizeof(Separator));
+
+      header.end += static_cast<int64_t>(it->object_size + sizeof(Separator));
+    }
+
+    output.seekp(0, std::fstream::beg);
+    output.write(reinterpret_cast<char const *>(&header), sizeof(Header));
+    output.close();
+
+    if (!file_handle_ || !output)
+    {
+      std::remove(compacted.c_str());
+      throw StorageException("Failed to write the compacted variant stack");
+    }
+
+    // replace the original file
+    file_handle_.close();
+    if (std::rename(compacted.c_str(), filename_.c_str()) != 0)
+    {
+      throw StorageException("Failed to replace the variant stack with the compacted file");
+    }
+
+    file_handle_ = std::fstream(filename_, std::ios::in | std::ios::out | std::ios::binary);
+    ReadHeader();
+  }
+
   bool empty() const
   {
     return header_.object_count == 0;
@@ -291,6 +393,17 @@ protected:
     file_handle_.write(reinterpret_cast<char const *>(&header_), sizeof(Header));
   }
 
+  /**
+   * Read the separator of the object which ends at the specified position
+   */
+  Separator ReadSeparator(int64_t end)
+  {
+    Separator separator;
+    file_handle_.seekg(end - int64_t(sizeof(Separator)), std::fstream::beg);
+    file_handle_.read(reinterpret_cast<char *>(&separator), sizeof(Separator));
+    return separator;
+  }
+
 private:
   std::fstream file_handle_;
   std::string  filename_ = "";
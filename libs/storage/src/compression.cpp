@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+#include "core/compression/lz4.hpp"
+#include "storage/compression.hpp"
+#include "storage/storage_exception.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace fetch {
+namespace storage {
+namespace {
+
+// Compressed documents record their original size ahead of the compressed block
+constexpr std::size_t HEADER_BYTES = sizeof(uint64_t);
+
+// An LZ4 block can not expand by more than this factor
+constexpr uint64_t MAX_EXPANSION = 255;
+
+struct CompressionTelemetry
+{
+  CompressionTelemetry()
+    : input_bytes{telemetry::Registry::Instance().CreateCounter(
+          "storage_compression_input_bytes_total",
+          "The total number of bytes of documents presented for compression")}
+    , output_bytes{telemetry::Registry::Instance().CreateCounter(
+          "storage_compression_output_bytes_total",
+          "The total number of bytes stored for the documents presented for compression")}
+    , decompressed_documents{telemetry::Registry::Instance().CreateCounter(
+          "storage_decompressed_documents_total", "The total number of documents decompressed")}
+    , ratio{telemetry::Registry::Instance().CreateGauge<double>(
+          "storage_compression_ratio",
+          "The ratio of the bytes stored to the bytes presented for compression")}
+  {}
+
+  telemetry::CounterPtr       input_bytes;
+  telemetry::CounterPtr       output_bytes;
+  telemetry::CounterPtr       decompressed_documents;
+  telemetry::GaugePtr<double> ratio;
+};
+
+CompressionTelemetry &Telemetry()
+{
+  static CompressionTelemetry telemetry;
+  return telemetry;
+}
+
+void UpdateTelemetry(std::size_t input_bytes, std::size_t output_bytes)
+{
+  auto &telemetry = Telemetry();
+
+  telemetry.input_bytes->add(input_bytes);
+  telemetry.output_bytes->add(output_bytes);
+
+  auto const total_input = telemetry.input_bytes->count();
+  if (total_input > 0)
+  {
+    telemetry.ratio->set(static_cast<double>(telemetry.output_bytes->count()) /
+                         static_cast<double>(total_input));
+  }
+}
+
+bool CompressLZ4(byte_array::ConstByteArray const &input, byte_array::ByteArray &output)
+{
+  auto const block = compression::LZ4Compress(input);
+
+  output.Resize(HEADER_BYTES + block.size());
+
+  uint64_t const size = input.size();
+  std::memcpy(output.pointer(), &size, sizeof(size));
+  std::memcpy(output.pointer() + HEADER_BYTES, block.pointer(), block.size());
+
+  return output.size() < input.size();
+}
+
+void DecompressLZ4(byte_array::ConstByteArray const &input, byte_array::ByteArray &output)
+{
+  if (input.size() < HEADER_BYTES)
+  {
+    throw StorageException("Compressed document is truncated");
+  }
+
+  uint64_t size{0};
+  std::memcpy(&size, input.pointer(), sizeof(size));
+
+  auto const block = input.SubArray(HEADER_BYTES, input.size() - HEADER_BYTES);
+
+  // reject impossible sizes before any memory is allocated for them
+  if ((size > (block.size() * MAX_EXPANSION)) ||
+      !compression::LZ4Decompress(block, static_cast<std::size_t>(size), output))
+  {
+    throw StorageException("Compressed document is corrupt");
+  }
+}
+
+}  // namespace
+
+char const *ToString(CompressionCodec codec)
+{
+  char const *text = "Unknown";
+
+  switch (codec)
+  {
+  case CompressionCodec::NONE:
+    text = "None";
+    break;
+  case CompressionCodec::LZ4:
+    text = "LZ4";
+    break;
+  }
+
+  return text;
+}
+
+bool Compress(CompressionCodec codec, byte_array::ConstByteArray const &input,
+              byte_array::ByteArray &output)
+{
+  bool compressed{false};
+
+  switch (codec)
+  {
+  case CompressionCodec::NONE:
+    break;
+  case CompressionCodec::LZ4:
+    compressed = CompressLZ4(input, output);
+    UpdateTelemetry(input.size(), compressed ? output.size() : input.size());
+    break;
+  }
+
+  return compressed;
+}
+
+void Decompress(CompressionCodec codec, byte_array::ConstByteArray const &input,
+                byte_array::ByteArray &output)
+{
+  switch (codec)
+  {
+  case CompressionCodec::NONE:
+    output = input.Copy();
+    return;
+  case CompressionCodec::LZ4:
+    DecompressLZ4(input, output);
+    Telemetry().decompressed_documents->increment();
+    return;
+  }
+
+  throw StorageException("Unknown document compression codec");
+}
+
+}  // namespace storage
+}  // namespace fetch
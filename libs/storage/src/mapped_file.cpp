@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/filesystem/map_file.hpp"
+#include "logging/logging.hpp"
+#include "storage/mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace fetch {
+namespace storage {
+namespace {
+
+using SharedArray = byte_array::ConstByteArray::SharedArrayType;
+
+constexpr char const *LOGGING_NAME = "MappedFile";
+
+// Byte arrays expect to be able to access their (SIMD) padding, so the mapping is always extended
+// to a multiple of the padding size. Since a page is a multiple of this size the extension never
+// leaves the final (partially filled) page of the file, which reads back as zeros.
+constexpr uint64_t MAPPING_GRANULARITY = 64;
+
+}  // namespace
+
+/**
+ * Open the view over the specified file. The file is mapped lazily when it is first accessed.
+ *
+ * @param filename The path to the file
+ */
+void MappedFile::Open(std::string const &filename)
+{
+  FETCH_LOCK(lock_);
+
+  filename_ = filename;
+  mapping_  = ConstByteArray{};
+}
+
+/**
+ * Close the view. The underlying mapping is released once all the outstanding slices are released
+ */
+void MappedFile::Close()
+{
+  FETCH_LOCK(lock_);
+
+  filename_.clear();
+  mapping_ = ConstByteArray{};
+}
+
+/**
+ * Determine if the file is currently mapped
+ *
+ * @return true if mapped, otherwise false
+ */
+bool MappedFile::IsMapped() const
+{
+  FETCH_LOCK(lock_);
+  return !mapping_.empty();
+}
+
+/**
+ * Get the number of bytes of the file which are currently mapped
+ *
+ * @return The size of the mapping in bytes
+ */
+uint64_t MappedFile::size() const
+{
+  FETCH_LOCK(lock_);
+  return mapping_.size();
+}
+
+/**
+ * Get a slice of the file referencing the mapped pages
+ *
+ * @param offset The byte offset from the start of the file
+ * @param length The number of bytes required
+ * @return The slice of the file if successful, otherwise an empty array
+ */
+MappedFile::ConstByteArray MappedFile::Slice(uint64_t offset, uint64_t length)
+{
+  FETCH_LOCK(lock_);
+
+  // the file will have grown since it was last mapped
+  if (((offset + length) > mapping_.size()) && !Remap())
+  {
+    return {};
+  }
+
+  if ((offset + length) > mapping_.size())
+  {
+    return {};
+  }
+
+  return mapping_.SubArray(offset, length);
+}
+
+/**
+ * Internal: Map the current contents of the file, replacing the existing mapping
+ *
+ * @return true if successful, otherwise false
+ */
+bool MappedFile::Remap()
+{
+  if (filename_.empty())
+  {
+    return false;
+  }
+
+  int const fd = ::open(filename_.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to open: ", filename_, " for mapping");
+    return false;
+  }
+
+  struct stat file_stats
+  {
+  };
+  if (::fstat(fd, &file_stats) != 0)
+  {
+    ::close(fd);
+    return false;
+  }
+
+  auto const file_size = static_cast<uint64_t>(file_stats.st_size);
+  auto const map_size =
+      ((file_size + MAPPING_GRANULARITY - 1) / MAPPING_GRANULARITY) * MAPPING_GRANULARITY;
+
+  if (file_size <= mapping_.size())
+  {
+    ::close(fd);
+    return false;
+  }
+
+  auto data = core::MapFile(fd, static_cast<std::size_t>(map_size), core::MapMode::PRIVATE);
+  ::close(fd);
+
+  if (!data)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to map: ", filename_);
+    return false;
+  }
+
+  mapping_ = ConstByteArray{SharedArray{std::move(data), static_cast<std::size_t>(file_size)}};
+
+  return true;
+}
+
+}  // namespace storage
+}  // namespace fetch
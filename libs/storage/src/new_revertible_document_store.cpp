@@ -16,11 +16,20 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/macros.hpp"
 #include "logging/logging.hpp"
+#include "storage/b_tree_index.hpp"
+#include "storage/key_value_index.hpp"
 #include "storage/new_revertible_document_store.hpp"
+#include "storage/parallel_document_reader.hpp"
 #include "storage/resource_mapper.hpp"
+#include "storage/storage_exception.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 
@@ -50,8 +59,216 @@ bool IsAllZeros(Hash const &hash)
 
   return all_zeros;
 }
+
+using KeyValueIndexStorage = DocumentStore<
+    2048,                                                                          // block size
+    FileBlockType<2048>,                                                           // file block
+    KeyValueIndex<KeyValuePair<>, NewVersionedRandomAccessStack<KeyValuePair<>>>,  // index
+    NewVersionedRandomAccessStack<FileBlockType<2048>>>;                           // file store
+
+using BTreeStorage = DocumentStore<
+    2048,                                                              // block size
+    FileBlockType<2048>,                                               // file block
+    BTreeIndex<4096, NewVersionedRandomAccessStack<BTreePage<4096>>>,  // index
+    NewVersionedRandomAccessStack<FileBlockType<2048>>>;               // file store
+
 }  // namespace
 
+/**
+ * Type erased interface over the document stores for each of the index backends
+ */
+class NewRevertibleDocumentStore::Engine
+{
+public:
+  virtual ~Engine() = default;
+
+  virtual void New(std::string const &state, std::string const &state_history,
+                   std::string const &index, std::string const &index_history) = 0;
+  virtual void Load(std::string const &state, std::string const &state_history,
+                    std::string const &index, std::string const &index_history,
+                    bool create)                                                = 0;
+
+  virtual UnderlyingType Get(ResourceID const &rid)                                     = 0;
+  virtual UnderlyingType GetOrCreate(ResourceID const &rid)                             = 0;
+  virtual void           Set(ResourceID const &rid, ByteArray const &value)             = 0;
+  virtual void           Erase(ResourceID const &rid)                                   = 0;
+  virtual void ApplyBatch(PendingWrites const &writes, PendingErasures const &erasures) = 0;
+  virtual void Import(PendingWrites const &writes)                                      = 0;
+
+  virtual Hash        Commit()                        = 0;
+  virtual bool        RevertToHash(Hash const &state) = 0;
+  virtual Hash        CurrentHash()                   = 0;
+  virtual bool        HashExists(Hash const &hash)    = 0;
+  virtual void        Flush(bool lazy)                = 0;
+  virtual std::size_t size() const                    = 0;
+  virtual std::size_t Compact(std::size_t retained)   = 0;
+
+  virtual void             SetCompression(CompressionCodec codec) = 0;
+  virtual CompressionCodec compression() const                    = 0;
+
+  virtual bool ReadChunk(ResourceID const &cursor, std::size_t max_entries,
+                         StateSnapshotChunk &chunk) = 0;
+};
+
+/**
+ * Engine implementation for a specific document store type
+ */
+template <typename STORAGE>
+class NewRevertibleDocumentStore::EngineImpl final : public NewRevertibleDocumentStore::Engine
+{
+public:
+  void New(std::string const &state, std::string const &state_history, std::string const &index,
+           std::string const &index_history) override
+  {
+    storage_.New(state, state_history, index, index_history);
+  }
+
+  void Load(std::string const &state, std::string const &state_history, std::string const &index,
+            std::string const &index_history, bool create) override
+  {
+    storage_.Load(state, state_history, index, index_history, create);
+  }
+
+  UnderlyingType Get(ResourceID const &rid) override
+  {
+    return storage_.Get(rid);
+  }
+
+  UnderlyingType GetOrCreate(ResourceID const &rid) override
+  {
+    return storage_.GetOrCreate(rid);
+  }
+
+  void Set(ResourceID const &rid, ByteArray const &value) override
+  {
+    storage_.Set(rid, value);
+  }
+
+  void Erase(ResourceID const &rid) override
+  {
+    storage_.Erase(rid);
+  }
+
+  void ApplyBatch(PendingWrites const &writes, PendingErasures const &erasures) override
+  {
+    storage_.ApplyBatch(writes, erasures);
+  }
+
+  void Import(PendingWrites const &writes) override
+  {
+    storage_.Import(writes);
+  }
+
+  Hash Commit() override
+  {
+    return storage_.Commit();
+  }
+
+  bool RevertToHash(Hash const &state) override
+  {
+    return storage_.RevertToHash(state);
+  }
+
+  Hash CurrentHash() override
+  {
+    return storage_.CurrentHash();
+  }
+
+  bool HashExists(Hash const &hash) override
+  {
+    return storage_.HashExists(hash);
+  }
+
+  void Flush(bool lazy) override
+  {
+    storage_.Flush(lazy);
+  }
+
+  std::size_t size() const override
+  {
+    return storage_.size();
+  }
+
+  std::size_t Compact(std::size_t retained) override
+  {
+    return storage_.Compact(retained);
+  }
+
+  void SetCompression(CompressionCodec codec) override
+  {
+    storage_.SetCompression(codec);
+  }
+
+  CompressionCodec compression() const override
+  {
+    return storage_.compression();
+  }
+
+  bool ReadChunk(ResourceID const &cursor, std::size_t max_entries,
+                 StateSnapshotChunk &chunk) override
+  {
+    auto       it  = storage_.begin();
+    auto const end = storage_.end();
+
+    // resume after the last key of the previous chunk, which must still be present
+    if (!cursor.id().empty())
+    {
+      it = storage_.Find(cursor);
+      if (it == end)
+      {
+        return false;
+      }
+
+      ++it;
+    }
+
+    // the documents are read ahead and decompressed in parallel
+    ParallelDocumentReader<STORAGE> reader{storage_};
+
+    auto entries = reader.Read(it, max_entries, [](ByteArray const &key, Document const &document) {
+      return std::make_pair(ResourceID{key}, document.document);
+    });
+
+    chunk.keys.reserve(entries.size());
+    chunk.values.reserve(entries.size());
+    for (auto &entry : entries)
+    {
+      chunk.keys.emplace_back(std::move(entry.first));
+      chunk.values.emplace_back(std::move(entry.second));
+    }
+
+    chunk.complete = (it == end);
+
+    return true;
+  }
+
+private:
+  STORAGE storage_;
+};
+
+NewRevertibleDocumentStore::EnginePtr NewRevertibleDocumentStore::CreateEngine(
+    IndexBackend backend)
+{
+  if (IndexBackend::B_TREE == backend)
+  {
+    return std::make_unique<EngineImpl<BTreeStorage>>();
+  }
+
+  return std::make_unique<EngineImpl<KeyValueIndexStorage>>();
+}
+
+NewRevertibleDocumentStore::NewRevertibleDocumentStore(IndexBackend backend)
+  : index_backend_{backend}
+  , storage_{CreateEngine(backend)}
+{}
+
+NewRevertibleDocumentStore::~NewRevertibleDocumentStore() = default;
+
+NewRevertibleDocumentStore::IndexBackend NewRevertibleDocumentStore::index_backend() const
+{
+  return index_backend_;
+}
+
 bool NewRevertibleDocumentStore::Load(std::string const &state, std::string const &state_history,
                                       std::string const &index, std::string const &index_history,
                                       bool create = true)
@@ -63,7 +280,8 @@ bool NewRevertibleDocumentStore::Load(std::string const &state, std::string cons
   index_history_path_ = index_history;
 
   // trigger the load
-  storage_.Load(state, state_history, index, index_history, create);
+  storage_->Load(state, state_history, index, index_history, create);
+  ClearPreimages();
   return true;
 }
 
@@ -78,41 +296,133 @@ bool NewRevertibleDocumentStore::New(std::string const &state, std::string const
   index_history_path_ = index_history;
 
   // trigger creation
-  storage_.New(state, state_history, index, index_history);
+  storage_->New(state, state_history, index, index_history);
+  ClearPreimages();
 
   return true;
 }
 
 UnderlyingType NewRevertibleDocumentStore::Get(ResourceID const &rid)
 {
-  return storage_.Get(rid);
+  {
+    FETCH_LOCK(pending_lock_);
+
+    auto const it = pending_writes_.find(rid);
+    if (it != pending_writes_.end())
+    {
+      UnderlyingType document{};
+      document.document = it->second.Copy();
+      return document;
+    }
+
+    if (pending_erasures_.find(rid) != pending_erasures_.end())
+    {
+      UnderlyingType document{};
+      document.failed = true;
+      return document;
+    }
+  }
+
+  return storage_->Get(rid);
 }
 
 UnderlyingType NewRevertibleDocumentStore::GetOrCreate(ResourceID const &rid)
 {
-  return storage_.GetOrCreate(rid);
+  {
+    FETCH_LOCK(pending_lock_);
+
+    auto const it = pending_writes_.find(rid);
+    if (it != pending_writes_.end())
+    {
+      UnderlyingType document{};
+      document.document = it->second.Copy();
+      return document;
+    }
+
+    // the erasure must be applied before the document can be recreated
+    if (pending_erasures_.find(rid) != pending_erasures_.end())
+    {
+      FlushPendingWritesLocked();
+    }
+  }
+
+  std::lock_guard<SharedMutex> guard(committed_lock_);
+  RecordPreimageLocked(rid);
+  return storage_->GetOrCreate(rid);
 }
 
 void NewRevertibleDocumentStore::Set(ResourceID const &rid, ByteArray const &value)
 {
-  return storage_.Set(rid, value);
+  {
+    FETCH_LOCK(pending_lock_);
+
+    if (WriteMode::BATCHED == write_mode_)
+    {
+      pending_erasures_.erase(rid);
+      pending_writes_[rid] = value;
+      return;
+    }
+  }
+
+  std::lock_guard<SharedMutex> guard(committed_lock_);
+  RecordPreimageLocked(rid);
+  return storage_->Set(rid, value);
 }
 
 void NewRevertibleDocumentStore::Erase(ResourceID const &rid)
 {
-  return storage_.Erase(rid);
+  {
+    FETCH_LOCK(pending_lock_);
+
+    if (WriteMode::BATCHED == write_mode_)
+    {
+      pending_writes_.erase(rid);
+      pending_erasures_.insert(rid);
+      return;
+    }
+  }
+
+  std::lock_guard<SharedMutex> guard(committed_lock_);
+  RecordPreimageLocked(rid);
+  return storage_->Erase(rid);
 }
 
 // State-based operations
 Hash NewRevertibleDocumentStore::Commit()
 {
-  Hash ret{std::move(storage_.Commit())};
-  storage_.Flush(false);
+  FETCH_LOCK(pending_lock_);
+  FlushPendingWritesLocked();
+
+  Hash ret{std::move(storage_->Commit())};
+  storage_->Flush(false);
+
+  // the current state is now the committed state
+  ClearPreimages();
+
+  // periodically discard the history which is beyond the configured depth
+  if ((history_depth_ > 0) && (++commits_since_compaction_ >= COMPACTION_INTERVAL))
+  {
+    commits_since_compaction_ = 0;
+
+    std::size_t const discarded = storage_->Compact(history_depth_);
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Compacted state history, discarded ", discarded, " records");
+    FETCH_UNUSED(discarded);
+  }
+
   return ret;
 }
 
 bool NewRevertibleDocumentStore::RevertToHash(Hash const &state)
 {
+  FETCH_LOCK(pending_lock_);
+
+  // any uncommitted changes are discarded by the revert
+  ClearPendingWritesLocked();
+
+  // committed reads are blocked until the revert is complete
+  std::lock_guard<SharedMutex> guard(committed_lock_);
+  preimages_.clear();
+
   bool success{false};
 
   if (IsAllZeros(state))
@@ -121,13 +431,13 @@ bool NewRevertibleDocumentStore::RevertToHash(Hash const &state)
 
     // we are requesting to revert to a blank slate. The simplest way to handle this is to clear
     // out the database
-    storage_.New(state_path_, state_history_path_, index_path_, index_history_path_);
+    storage_->New(state_path_, state_history_path_, index_path_, index_history_path_);
 
     success = true;
   }
   else
   {
-    success = storage_.RevertToHash(state);
+    success = storage_->RevertToHash(state);
   }
 
   return success;
@@ -135,22 +445,308 @@ bool NewRevertibleDocumentStore::RevertToHash(Hash const &state)
 
 bool NewRevertibleDocumentStore::HashExists(Hash const &hash)
 {
-  return storage_.HashExists(hash);
+  return storage_->HashExists(hash);
 }
 
 Hash NewRevertibleDocumentStore::CurrentHash()
 {
-  return storage_.CurrentHash();
+  FETCH_LOCK(pending_lock_);
+  FlushPendingWritesLocked();
+
+  return storage_->CurrentHash();
 }
 
+/**
+ * Get the number of documents in the store. In batched mode writes which are still pending are not
+ * counted until they have been flushed with FlushPendingWrites (or by hashing the state)
+ *
+ * @return The number of documents persisted in the store
+ */
 std::size_t NewRevertibleDocumentStore::size() const
 {
-  return storage_.size();
+  return storage_->size();
+}
+
+/**
+ * Enable or disable committed reads. When enabled, the first modification of each key after a
+ * commit copies the committed value of the key aside, so that GetCommitted can serve a consistent
+ * view of the last committed state while the current state is being modified. The view is only
+ * complete once the state has been committed after enabling.
+ *
+ * @param enable Flag to signal if the committed reads should be enabled
+ */
+void NewRevertibleDocumentStore::EnableCommittedReads(bool enable)
+{
+  std::lock_guard<SharedMutex> guard(committed_lock_);
+  committed_reads_ = enable;
+  preimages_.clear();
+}
+
+bool NewRevertibleDocumentStore::committed_reads_enabled() const
+{
+  std::shared_lock<SharedMutex> lock(committed_lock_);
+  return committed_reads_;
+}
+
+/**
+ * Get a document as of the last commit. Any writes made since the commit (including those which are
+ * still pending in batched mode) are not visible. Committed reads do not contend with the pending
+ * write set, and do not block one another.
+ *
+ * If committed reads are not enabled this returns the persisted (rather than the pending) state.
+ *
+ * @param rid The resource to be retrieved
+ * @return The document
+ */
+UnderlyingType NewRevertibleDocumentStore::GetCommitted(ResourceID const &rid)
+{
+  std::shared_lock<SharedMutex> lock(committed_lock_);
+
+  auto const it = preimages_.find(rid);
+  if (it != preimages_.end())
+  {
+    return it->second;
+  }
+
+  return storage_->Get(rid);
+}
+
+/**
+ * Set the number of the most recent commits which are retained in the history of the store. The
+ * history beyond this depth is periodically discarded as part of the commit and it is no longer
+ * possible to revert to it.
+ *
+ * @param depth The number of commits to retain, or zero to retain the complete history
+ */
+void NewRevertibleDocumentStore::SetHistoryDepth(uint64_t depth)
+{
+  FETCH_LOCK(pending_lock_);
+  history_depth_            = depth;
+  commits_since_compaction_ = 0;
+}
+
+uint64_t NewRevertibleDocumentStore::history_depth() const
+{
+  FETCH_LOCK(pending_lock_);
+  return history_depth_;
+}
+
+/**
+ * Immediately discard the history beyond the configured depth
+ *
+ * @return The number of history records discarded
+ */
+std::size_t NewRevertibleDocumentStore::Compact()
+{
+  FETCH_LOCK(pending_lock_);
+
+  if (history_depth_ == 0)
+  {
+    return 0;
+  }
+
+  commits_since_compaction_ = 0;
+
+  return storage_->Compact(history_depth_);
+}
+
+/**
+ * Set the codec with which documents are compressed as they are written to disk. Existing documents
+ * are unaffected and the state hashes are always those of the uncompressed documents, so the codec
+ * can be changed at any time.
+ *
+ * @param codec The codec to be used
+ */
+void NewRevertibleDocumentStore::SetCompression(CompressionCodec codec)
+{
+  storage_->SetCompression(codec);
+}
+
+CompressionCodec NewRevertibleDocumentStore::compression() const
+{
+  return storage_->compression();
 }
 
 void NewRevertibleDocumentStore::Reset()
 {
-  storage_.New(state_path_, state_history_path_, index_path_, index_history_path_);
+  FETCH_LOCK(pending_lock_);
+  ClearPendingWritesLocked();
+
+  std::lock_guard<SharedMutex> guard(committed_lock_);
+  preimages_.clear();
+
+  storage_->New(state_path_, state_history_path_, index_path_, index_history_path_);
+}
+
+/**
+ * Import a large batch of documents, for example the genesis state. When the store is empty the
+ * state and its index are built in a single pass, otherwise the documents are simply written as a
+ * single batch. Where a key appears more than once the last of its values is retained.
+ *
+ * @param keys The keys of the documents
+ * @param values The values of the documents, in the same order as the keys
+ */
+void NewRevertibleDocumentStore::Import(Keys const &keys, Values const &values)
+{
+  if (keys.size() != values.size())
+  {
+    throw StorageException("Mismatched number of keys and values for import");
+  }
+
+  PendingWrites writes{};
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    writes[keys[i]] = values[i];
+  }
+
+  FETCH_LOCK(pending_lock_);
+  FlushPendingWritesLocked();
+
+  std::lock_guard<SharedMutex> guard(committed_lock_);
+
+  for (auto const &write : writes)
+  {
+    RecordPreimageLocked(write.first);
+  }
+
+  if (storage_->size() == 0)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Importing ", writes.size(), " documents");
+    storage_->Import(writes);
+  }
+  else
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Store is not empty, writing ", writes.size(), " documents");
+    storage_->ApplyBatch(writes, PendingErasures{});
+  }
+}
+
+/**
+ * Read a chunk of the contents of the store, as part of a state snapshot. The chunk is read from
+ * the current state of the store, any writes which are made between the reading of chunks will
+ * change the state hash reported in the chunk.
+ *
+ * @param cursor The last key of the previous chunk, or an empty key for the first chunk
+ * @param max_entries The maximum number of entries to be read into the chunk
+ * @param chunk The output chunk
+ * @return true if successful, false if the cursor is no longer present in the store
+ */
+bool NewRevertibleDocumentStore::ReadSnapshotChunk(ResourceID const &cursor,
+                                                   std::size_t max_entries,
+                                                   StateSnapshotChunk &chunk)
+{
+  FETCH_LOCK(pending_lock_);
+  FlushPendingWritesLocked();
+
+  chunk          = StateSnapshotChunk{};
+  chunk.state    = storage_->CurrentHash();
+  chunk.complete = false;
+
+  return storage_->ReadChunk(cursor, max_entries, chunk);
+}
+
+/**
+ * Write the entries of a snapshot chunk into the store
+ *
+ * @param chunk The chunk to be written
+ */
+void NewRevertibleDocumentStore::WriteSnapshotChunk(StateSnapshotChunk const &chunk)
+{
+  std::size_t const num_entries = std::min(chunk.keys.size(), chunk.values.size());
+
+  for (std::size_t i = 0; i < num_entries; ++i)
+  {
+    Set(chunk.keys[i], chunk.values[i]);
+  }
+}
+
+/**
+ * Set the write mode of the store. In batched mode all the writes are accumulated in memory and
+ * are persisted in a single pass (in key order) when the state is next committed or hashed,
+ * instead of flushing the file object and the key index on every write.
+ *
+ * @param mode The desired write mode
+ */
+void NewRevertibleDocumentStore::SetWriteMode(WriteMode mode)
+{
+  FETCH_LOCK(pending_lock_);
+
+  if (WriteMode::IMMEDIATE == mode)
+  {
+    FlushPendingWritesLocked();
+  }
+
+  write_mode_ = mode;
+}
+
+NewRevertibleDocumentStore::WriteMode NewRevertibleDocumentStore::write_mode() const
+{
+  FETCH_LOCK(pending_lock_);
+  return write_mode_;
+}
+
+/**
+ * Persist any writes which have been accumulated in batched mode
+ */
+void NewRevertibleDocumentStore::FlushPendingWrites()
+{
+  FETCH_LOCK(pending_lock_);
+  FlushPendingWritesLocked();
+}
+
+void NewRevertibleDocumentStore::FlushPendingWritesLocked()
+{
+  if (pending_writes_.empty() && pending_erasures_.empty())
+  {
+    return;
+  }
+
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Flushing ", pending_writes_.size(), " writes and ",
+                  pending_erasures_.size(), " erasures");
+
+  {
+    std::lock_guard<SharedMutex> guard(committed_lock_);
+
+    for (auto const &write : pending_writes_)
+    {
+      RecordPreimageLocked(write.first);
+    }
+
+    for (auto const &erasure : pending_erasures_)
+    {
+      RecordPreimageLocked(erasure);
+    }
+
+    storage_->ApplyBatch(pending_writes_, pending_erasures_);
+  }
+
+  ClearPendingWritesLocked();
+}
+
+void NewRevertibleDocumentStore::ClearPendingWritesLocked()
+{
+  pending_writes_.clear();
+  pending_erasures_.clear();
+}
+
+/**
+ * Internal: Copy aside the committed value of a key which is about to be modified. The caller must
+ * hold the committed lock exclusively.
+ *
+ * @param rid The resource about to be modified
+ */
+void NewRevertibleDocumentStore::RecordPreimageLocked(ResourceID const &rid)
+{
+  if (committed_reads_ && (preimages_.find(rid) == preimages_.end()))
+  {
+    preimages_.emplace(rid, storage_->Get(rid));
+  }
+}
+
+void NewRevertibleDocumentStore::ClearPreimages()
+{
+  std::lock_guard<SharedMutex> guard(committed_lock_);
+  preimages_.clear();
 }
 
 }  // namespace storage
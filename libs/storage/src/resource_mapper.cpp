@@ -39,7 +39,7 @@ namespace storage {
 ResourceID::ResourceID(byte_array::ConstByteArray id)
   : id_(std::move(id))
 {
-  assert(id.size() == RESOURCE_ID_SIZE_IN_BYTES);
+  assert(id_.size() == RESOURCE_ID_SIZE_IN_BYTES);
 }
 
 /**
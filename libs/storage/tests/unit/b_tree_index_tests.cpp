@@ -0,0 +1,334 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lfg.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "storage/b_tree_index.hpp"
+#include "storage/key_value_index.hpp"
+#include "storage/random_access_stack.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace {
+
+using namespace fetch;
+using namespace fetch::storage;
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+
+// small pages are used so that the tests exercise trees with several levels
+using SmallBTreeIndex = BTreeIndex<512, RandomAccessStack<BTreePage<512>>>;
+using BTreeIndexType  = BTreeIndex<4096, RandomAccessStack<BTreePage<4096>>>;
+using KVIndex         = KeyValueIndex<KeyValuePair<>, RandomAccessStack<KeyValuePair<>>>;
+
+class BTreeIndexTests : public ::testing::Test
+{
+protected:
+  ByteArray GenerateKey()
+  {
+    ByteArray key;
+    key.Resize(32);
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+      key[i] = static_cast<uint8_t>(rng_() >> 9u);
+    }
+
+    return key;
+  }
+
+  static ByteArray HashOf(uint64_t value)
+  {
+    return crypto::Hash<crypto::SHA256>(std::to_string(value));
+  }
+
+  std::map<ConstByteArray, uint64_t> GenerateEntries(std::size_t count)
+  {
+    std::map<ConstByteArray, uint64_t> entries;
+    while (entries.size() < count)
+    {
+      entries.emplace(GenerateKey(), rng_() | 1u);
+    }
+
+    return entries;
+  }
+
+  fetch::random::LaggedFibonacciGenerator<> rng_;
+};
+
+TEST_F(BTreeIndexTests, CheckValueConsistency)
+{
+  SmallBTreeIndex index;
+  index.New("b_tree_index_test.db");
+
+  auto entries = GenerateEntries(5000);
+  for (auto const &entry : entries)
+  {
+    index.Set(entry.first, entry.second, HashOf(entry.second));
+  }
+
+  EXPECT_EQ(entries.size(), index.size());
+
+  // update half of the entries
+  std::size_t count{0};
+  for (auto &entry : entries)
+  {
+    if ((count++ & 1u) == 0)
+    {
+      entry.second += 2;
+      index.Set(entry.first, entry.second, HashOf(entry.second));
+    }
+  }
+
+  EXPECT_EQ(entries.size(), index.size());
+
+  for (auto const &entry : entries)
+  {
+    uint64_t value{0};
+    ASSERT_TRUE(index.GetIfExists(entry.first, value));
+    EXPECT_EQ(entry.second, value);
+  }
+
+  uint64_t value{0};
+  EXPECT_FALSE(index.GetIfExists(GenerateKey(), value));
+  EXPECT_TRUE(index.Find(GenerateKey()) == index.end());
+}
+
+TEST_F(BTreeIndexTests, CheckHashMatchesKeyValueIndex)
+{
+  SmallBTreeIndex index;
+  KVIndex         reference;
+  index.New("b_tree_index_test.db");
+  reference.New("b_tree_index_reference.db");
+
+  EXPECT_EQ(reference.Hash(), index.Hash());
+
+  auto const entries = GenerateEntries(2000);
+
+  std::size_t count{0};
+  for (auto const &entry : entries)
+  {
+    index.Set(entry.first, entry.second, HashOf(entry.second));
+    reference.Set(entry.first, entry.second, HashOf(entry.second));
+
+    // check periodically to exercise the incremental rehashing
+    if ((++count % 97) == 0)
+    {
+      ASSERT_EQ(reference.Hash(), index.Hash());
+    }
+  }
+
+  EXPECT_EQ(reference.Hash(), index.Hash());
+
+  // erase every third entry and update some of the others
+  count = 0;
+  for (auto const &entry : entries)
+  {
+    switch (count++ % 3)
+    {
+    case 0:
+      index.Erase(entry.first);
+      reference.Erase(entry.first);
+      break;
+    case 1:
+      index.Set(entry.first, entry.second, HashOf(entry.second + 1));
+      reference.Set(entry.first, entry.second, HashOf(entry.second + 1));
+      break;
+    default:
+      break;
+    }
+
+    if ((count % 101) == 0)
+    {
+      ASSERT_EQ(reference.Hash(), index.Hash());
+    }
+  }
+
+  EXPECT_EQ(reference.size(), index.size());
+  EXPECT_EQ(reference.Hash(), index.Hash());
+}
+
+TEST_F(BTreeIndexTests, CheckIterationOrderMatchesKeyValueIndex)
+{
+  SmallBTreeIndex index;
+  KVIndex         reference;
+  index.New("b_tree_index_test.db");
+  reference.New("b_tree_index_reference.db");
+
+  for (auto const &entry : GenerateEntries(1000))
+  {
+    index.Set(entry.first, entry.second, HashOf(entry.second));
+    reference.Set(entry.first, entry.second, HashOf(entry.second));
+  }
+
+  auto it = index.begin();
+  for (auto ref_it = reference.begin(); ref_it != reference.end(); ++ref_it)
+  {
+    ASSERT_TRUE(it != index.end());
+    EXPECT_EQ((*ref_it).first, (*it).first);
+    EXPECT_EQ((*ref_it).second, (*it).second);
+    ++it;
+  }
+
+  EXPECT_TRUE(it == index.end());
+}
+
+TEST_F(BTreeIndexTests, CheckBulkLoadMatchesKeyValueIndex)
+{
+  struct Entry
+  {
+    ConstByteArray key;
+    uint64_t       value;
+    ConstByteArray hash;
+  };
+
+  SmallBTreeIndex index;
+  KVIndex         reference;
+  index.New("b_tree_index_test.db");
+  reference.New("b_tree_index_reference.db");
+
+  std::vector<Entry> entries;
+  for (auto const &entry : GenerateEntries(3000))
+  {
+    entries.push_back({entry.first, entry.second, HashOf(entry.second)});
+    reference.Set(entry.first, entry.second, HashOf(entry.second));
+  }
+
+  index.BulkLoad(entries);
+
+  EXPECT_EQ(reference.size(), index.size());
+  EXPECT_EQ(reference.Hash(), index.Hash());
+
+  for (auto const &entry : entries)
+  {
+    uint64_t value{0};
+    ASSERT_TRUE(index.GetIfExists(entry.key, value));
+    EXPECT_EQ(entry.value, value);
+  }
+
+  // the index can only be bulk loaded when empty
+  EXPECT_THROW(index.BulkLoad(entries), StorageException);
+}
+
+TEST_F(BTreeIndexTests, CheckSubtreeIteration)
+{
+  SmallBTreeIndex index;
+  index.New("b_tree_index_test.db");
+
+  auto const entries = GenerateEntries(1000);
+  for (auto const &entry : entries)
+  {
+    index.Set(entry.first, entry.second, HashOf(entry.second));
+  }
+
+  // all the keys sharing the first 4 bits (least significant bits of the first byte)
+  auto const  key = entries.begin()->first;
+  std::size_t expected{0};
+  for (auto const &entry : entries)
+  {
+    if ((entry.first[0] & 0x0Fu) == (key[0] & 0x0Fu))
+    {
+      ++expected;
+    }
+  }
+
+  std::size_t found{0};
+  for (auto it = index.GetSubtree(key, 4); it != index.end(); ++it)
+  {
+    EXPECT_EQ(key[0] & 0x0Fu, (*it).first[0] & 0x0Fu);
+    ++found;
+  }
+
+  EXPECT_EQ(expected, found);
+}
+
+TEST_F(BTreeIndexTests, CheckEraseAllEntries)
+{
+  SmallBTreeIndex index;
+  KVIndex         reference;
+  index.New("b_tree_index_test.db");
+  reference.New("b_tree_index_reference.db");
+
+  auto const entries = GenerateEntries(1000);
+  for (auto const &entry : entries)
+  {
+    index.Set(entry.first, entry.second, HashOf(entry.second));
+  }
+
+  auto const pages = index.underlying_stack().size();
+
+  for (auto const &entry : entries)
+  {
+    index.Erase(entry.first);
+  }
+
+  EXPECT_EQ(0u, index.size());
+  EXPECT_TRUE(index.begin() == index.end());
+  EXPECT_EQ(reference.Hash(), index.Hash());
+
+  // the freed pages are reused when the index is repopulated
+  for (auto const &entry : entries)
+  {
+    index.Set(entry.first, entry.second, HashOf(entry.second));
+  }
+
+  EXPECT_EQ(entries.size(), index.size());
+  EXPECT_EQ(pages, index.underlying_stack().size());
+}
+
+TEST_F(BTreeIndexTests, CheckLoadAndSave)
+{
+  auto const entries = GenerateEntries(3000);
+
+  ByteArray hash;
+  {
+    BTreeIndexType index;
+    index.New("b_tree_index_test.db");
+
+    for (auto const &entry : entries)
+    {
+      index.Set(entry.first, entry.second, HashOf(entry.second));
+    }
+
+    hash = index.Hash();
+    index.Flush(false);
+  }
+
+  BTreeIndexType index;
+  index.Load("b_tree_index_test.db");
+
+  EXPECT_EQ(entries.size(), index.size());
+  EXPECT_EQ(hash, index.Hash());
+
+  for (auto const &entry : entries)
+  {
+    uint64_t value{0};
+    ASSERT_TRUE(index.GetIfExists(entry.first, value));
+    EXPECT_EQ(entry.second, value);
+  }
+}
+
+}  // namespace
@@ -21,6 +21,10 @@
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace fetch::storage;
 
 class TestClass
@@ -35,9 +39,7 @@ public:
   }
 };
 
-// fails on swap operation - probably because it doesn't guard against not being able to hold 2
-// cache lines at once
-TEST(DISABLED_cache_line_LRU_random_access_stack, basic_functionality)
+TEST(cache_line_LRU_random_access_stack, basic_functionality)
 {
   constexpr uint64_t                        testSize = 10000;
   fetch::random::LaggedFibonacciGenerator<> lfg;
@@ -224,3 +226,66 @@ TEST(cache_line_LRU_random_access_stack, file_writing_and_recovery)
     stack.Close();
   }
 }
+
+TEST(cache_line_LRU_random_access_stack, concurrent_reads)
+{
+  constexpr uint64_t                        testSize   = 40000;
+  constexpr std::size_t                     numReaders = 4;
+  fetch::random::LaggedFibonacciGenerator<> lfg;
+  CacheLineLRURandomAccessStack<TestClass>  stack;
+  std::vector<TestClass>                    reference;
+
+  stack.New("CRAS_test_3.db");
+
+  // only enough room for a couple of the cache lines, forcing evictions while reading
+  stack.SetMemoryLimit(std::size_t(1ULL << 18));
+
+  for (uint64_t i = 0; i < testSize; ++i)
+  {
+    uint64_t  random = lfg();
+    TestClass temp;
+    temp.value1 = random;
+    temp.value2 = random & 0xFF;
+
+    stack.Push(temp);
+    reference.push_back(temp);
+  }
+
+  std::atomic<std::size_t> mismatches{0};
+  std::vector<std::thread> threads{};
+
+  for (std::size_t reader = 0; reader < numReaders; ++reader)
+  {
+    threads.emplace_back([&stack, &reference, &mismatches, reader]() {
+      for (uint64_t i = 0; i < testSize; ++i)
+      {
+        uint64_t const index = (i * (reader + 1) * 7919) % testSize;
+
+        TestClass temp;
+        stack.Get(index, temp);
+
+        if (!(temp == reference[index]))
+        {
+          ++mismatches;
+        }
+      }
+    });
+  }
+
+  // write back the modified lines while the readers are active
+  threads.emplace_back([&stack]() {
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+      stack.WriteBack();
+    }
+  });
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(mismatches, 0u);
+
+  stack.Close();
+}
@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "storage/compression.hpp"
+#include "storage/storage_exception.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::random::LinearCongruentialGenerator;
+using fetch::storage::CompressionCodec;
+using fetch::storage::Compress;
+using fetch::storage::Decompress;
+using fetch::storage::StorageException;
+
+ConstByteArray Repetitive(std::size_t size)
+{
+  std::string value;
+  while (value.size() < size)
+  {
+    value += "{\"balance\": " + std::to_string(value.size() % 97) + ", \"stake\": 0}";
+  }
+  value.resize(size);
+
+  return value;
+}
+
+ConstByteArray Random(std::size_t size)
+{
+  LinearCongruentialGenerator rng;
+
+  ByteArray value;
+  value.Resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    value[i] = static_cast<uint8_t>(rng() >> 32u);
+  }
+
+  return value;
+}
+
+TEST(CompressionTests, CheckRoundTrip)
+{
+  for (std::size_t size : {0u, 1u, 4u, 15u, 16u, 300u, 5000u, 100000u})
+  {
+    auto const input = Repetitive(size);
+
+    ByteArray compressed;
+    bool const smaller = Compress(CompressionCodec::LZ4, input, compressed);
+    EXPECT_EQ(smaller, compressed.size() < input.size());
+
+    ByteArray output;
+    Decompress(CompressionCodec::LZ4, compressed, output);
+    EXPECT_EQ(output, input);
+  }
+}
+
+TEST(CompressionTests, CheckRepetitiveDocumentsAreCompressed)
+{
+  auto const input = Repetitive(10000);
+
+  ByteArray compressed;
+  EXPECT_TRUE(Compress(CompressionCodec::LZ4, input, compressed));
+  EXPECT_LT(compressed.size(), input.size() / 4);
+
+  // long runs of a single byte overlap with their own match
+  ConstByteArray const run{std::string(5000, 'a')};
+  EXPECT_TRUE(Compress(CompressionCodec::LZ4, run, compressed));
+
+  ByteArray output;
+  Decompress(CompressionCodec::LZ4, compressed, output);
+  EXPECT_EQ(output, run);
+}
+
+TEST(CompressionTests, CheckIncompressibleDocumentsAreReported)
+{
+  auto const input = Random(5000);
+
+  ByteArray compressed;
+  EXPECT_FALSE(Compress(CompressionCodec::LZ4, input, compressed));
+  EXPECT_FALSE(Compress(CompressionCodec::NONE, Repetitive(5000), compressed));
+
+  // the output remains decodable even when it is not smaller
+  ByteArray output;
+  Compress(CompressionCodec::LZ4, input, compressed);
+  Decompress(CompressionCodec::LZ4, compressed, output);
+  EXPECT_EQ(output, input);
+}
+
+TEST(CompressionTests, CheckCorruptDocumentsAreRejected)
+{
+  ByteArray compressed;
+  ASSERT_TRUE(Compress(CompressionCodec::LZ4, Repetitive(5000), compressed));
+
+  ByteArray output;
+
+  // truncated
+  EXPECT_THROW(Decompress(CompressionCodec::LZ4, compressed.SubArray(0, compressed.size() / 2),
+                          output),
+               StorageException);
+  EXPECT_THROW(Decompress(CompressionCodec::LZ4, ConstByteArray{"abc"}, output), StorageException);
+
+  // the recorded size does not match the contents
+  ByteArray wrong_size = compressed.Copy();
+  wrong_size[0]        = static_cast<uint8_t>(wrong_size[0] + 1);
+  EXPECT_THROW(Decompress(CompressionCodec::LZ4, wrong_size, output), StorageException);
+}
+
+}  // namespace
@@ -291,6 +291,34 @@ TEST_F(KeyValueIndexTests, intermediate_flush_hash_consistency)
   ASSERT_TRUE(hash1 == hash3);
 }
 
+TEST_F(KeyValueIndexTests, incremental_hash_consistency)
+{
+  cached_kv_index.New("test1.db");
+  kv_index.New("test2.db");
+
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    byte_array::ByteArray key;
+    key.Resize(256 / 8);
+    for (std::size_t j = 0; j < key.size(); ++j)
+    {
+      key[j] = uint8_t(rng() >> 9u);
+    }
+
+    uint64_t const value = rng();
+    cached_kv_index.Set(key, value, key);
+    kv_index.Set(key, value, key);
+
+    // only the paths which have been modified since the last hash should be recomputed
+    if ((i % 17) == 0)
+    {
+      ASSERT_EQ(kv_index.Hash(), cached_kv_index.Hash());
+    }
+  }
+
+  ASSERT_EQ(kv_index.Hash(), cached_kv_index.Hash());
+}
+
 TEST_F(KeyValueIndexTests, double_insertion_hash_consistency)
 {
   std::vector<TestData> values;
@@ -438,4 +466,80 @@ TEST_F(KeyValueIndexTests, batched_vs_bulk_load_save_consistency)
   ASSERT_TRUE(bulk_size == random_batched_size);
 }
 
+TEST_F(KeyValueIndexTests, bulk_load_matches_incremental_inserts)
+{
+  struct Entry
+  {
+    byte_array::ConstByteArray key;
+    uint64_t                   value;
+    byte_array::ConstByteArray hash;
+  };
+
+  std::vector<Entry> entries;
+  for (std::size_t i = 0; i < 5000; ++i)
+  {
+    byte_array::ByteArray key;
+    key.Resize(256 / 8);
+    for (std::size_t j = 0; j < key.size(); ++j)
+    {
+      key[j] = uint8_t(rng() >> 9u);
+    }
+
+    entries.push_back({key, rng(), key});
+  }
+
+  // overwrite some of the keys, only the last value for each should be retained
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    entries.push_back({entries[i * 7].key, rng(), entries[i * 13].key});
+  }
+
+  kv_index.New("test1.db");
+  for (auto const &entry : entries)
+  {
+    kv_index.Set(entry.key, entry.value, entry.hash);
+    reference[entry.key] = entry.value;
+  }
+
+  cached_kv_index.New("test2.db");
+  cached_kv_index.BulkLoad(entries);
+
+  EXPECT_EQ(kv_index.size(), cached_kv_index.size());
+  EXPECT_EQ(kv_index.Hash(), cached_kv_index.Hash());
+
+  for (auto const &element : reference)
+  {
+    ASSERT_EQ(element.second, cached_kv_index.Get(element.first));
+  }
+
+  // the leaves are visited in the same order
+  auto it = cached_kv_index.begin();
+  for (auto ref_it = kv_index.begin(); ref_it != kv_index.end(); ++ref_it)
+  {
+    ASSERT_FALSE(it == cached_kv_index.end());
+    EXPECT_EQ((*ref_it).first, (*it).first);
+    ++it;
+  }
+  EXPECT_TRUE(it == cached_kv_index.end());
+
+  // the bulk loaded trie can be modified and reloaded as normal
+  byte_array::ByteArray key;
+  key.Resize(256 / 8);
+  for (std::size_t j = 0; j < key.size(); ++j)
+  {
+    key[j] = uint8_t(rng() >> 9u);
+  }
+
+  kv_index.Set(key, 42, key);
+  cached_kv_index.Set(key, 42, key);
+  EXPECT_EQ(kv_index.Hash(), cached_kv_index.Hash());
+
+  cached_kv_index.Close();
+
+  CachedKVIndex reloaded;
+  reloaded.Load("test2.db");
+  EXPECT_EQ(kv_index.Hash(), reloaded.Hash());
+  EXPECT_EQ(42, reloaded.Get(key));
+}
+
 }  // namespace
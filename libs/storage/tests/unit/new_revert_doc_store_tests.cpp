@@ -30,6 +30,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <fstream>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -387,6 +388,367 @@ TEST(new_revertible_store_test, commit_and_erase)
   }
 }
 
+TEST(new_revertible_store_test, batched_writes_produce_the_same_state)
+{
+  NewRevertibleDocumentStore immediate_store;
+  immediate_store.New("a_77.db", "b_77.db", "c_77.db", "d_77.db", true);
+
+  NewRevertibleDocumentStore batched_store;
+  batched_store.New("a_78.db", "b_78.db", "c_78.db", "d_78.db", true);
+  batched_store.SetWriteMode(NewRevertibleDocumentStore::WriteMode::BATCHED);
+
+  auto unique_hashes = GenerateUniqueHashes(500);
+
+  for (std::size_t block = 0; block < 4; ++block)
+  {
+    std::size_t i = 0;
+    for (auto const &hash : unique_hashes)
+    {
+      auto              rid = storage::ResourceID(hash);
+      std::string const set_me{std::to_string(block * 1000 + i)};
+
+      if (((i + block) % 7) == 0u)
+      {
+        immediate_store.Erase(rid);
+        batched_store.Erase(rid);
+
+        ASSERT_TRUE(batched_store.Get(rid).failed);
+      }
+      else
+      {
+        immediate_store.Set(rid, set_me);
+        batched_store.Set(rid, set_me);
+
+        // pending writes must be visible before they are flushed
+        ASSERT_EQ(std::string{batched_store.Get(rid).document}, set_me);
+      }
+
+      ++i;
+    }
+
+    EXPECT_EQ(immediate_store.Commit(), batched_store.Commit());
+    EXPECT_EQ(immediate_store.size(), batched_store.size());
+  }
+}
+
+TEST(new_revertible_store_test, batched_writes_are_discarded_on_revert)
+{
+  NewRevertibleDocumentStore store;
+  store.New("a_79.db", "b_79.db", "c_79.db", "d_79.db", true);
+  store.SetWriteMode(NewRevertibleDocumentStore::WriteMode::BATCHED);
+
+  auto const rid_a = storage::ResourceAddress("a");
+  auto const rid_b = storage::ResourceAddress("b");
+
+  store.Set(rid_a, "first");
+  auto const committed_hash = store.Commit();
+
+  store.Set(rid_a, "second");
+  store.Set(rid_b, "other");
+
+  ASSERT_TRUE(store.RevertToHash(committed_hash));
+  EXPECT_EQ(std::string{store.Get(rid_a).document}, "first");
+  EXPECT_TRUE(store.Get(rid_b).failed);
+  EXPECT_EQ(store.CurrentHash(), committed_hash);
+}
+
+TEST(new_revertible_store_test, b_tree_index_produces_the_same_state)
+{
+  NewRevertibleDocumentStore kvi_store;
+  kvi_store.New("a_80.db", "b_80.db", "c_80.db", "d_80.db", true);
+
+  NewRevertibleDocumentStore btree_store{NewRevertibleDocumentStore::IndexBackend::B_TREE};
+  btree_store.New("a_81.db", "b_81.db", "c_81.db", "d_81.db", true);
+
+  auto unique_hashes = GenerateUniqueHashes(500);
+
+  std::vector<NewRevertibleDocumentStore::Hash> commits{};
+  std::map<storage::ResourceID, std::string>    first_block{};
+  for (std::size_t block = 0; block < 4; ++block)
+  {
+    std::size_t i = 0;
+    for (auto const &hash : unique_hashes)
+    {
+      auto              rid = storage::ResourceID(hash);
+      std::string const set_me{std::to_string(block * 1000 + i)};
+
+      if (((i + block) % 7) == 0u)
+      {
+        kvi_store.Erase(rid);
+        btree_store.Erase(rid);
+      }
+      else
+      {
+        kvi_store.Set(rid, set_me);
+        btree_store.Set(rid, set_me);
+
+        if (block == 0)
+        {
+          first_block[rid] = set_me;
+        }
+      }
+
+      ++i;
+    }
+
+    commits.emplace_back(kvi_store.Commit());
+    EXPECT_EQ(commits.back(), btree_store.Commit());
+    EXPECT_EQ(kvi_store.size(), btree_store.size());
+  }
+
+  // revert the b-tree store back to an earlier state
+  ASSERT_TRUE(btree_store.RevertToHash(commits.front()));
+  EXPECT_EQ(commits.front(), btree_store.CurrentHash());
+
+  for (auto const &entry : first_block)
+  {
+    EXPECT_EQ(std::string{btree_store.Get(entry.first).document}, entry.second);
+  }
+}
+
+TEST(new_revertible_store_test, snapshot_chunks_reproduce_the_state)
+{
+  NewRevertibleDocumentStore source;
+  source.New("a_82.db", "b_82.db", "c_82.db", "d_82.db", true);
+
+  std::size_t i = 0;
+  for (auto const &hash : GenerateUniqueHashes(500))
+  {
+    source.Set(storage::ResourceID(hash), std::to_string(i++));
+  }
+  auto const source_hash = source.Commit();
+
+  for (auto const backend : {NewRevertibleDocumentStore::IndexBackend::KEY_VALUE_INDEX,
+                             NewRevertibleDocumentStore::IndexBackend::B_TREE})
+  {
+    NewRevertibleDocumentStore target{backend};
+    target.New("a_83.db", "b_83.db", "c_83.db", "d_83.db", true);
+
+    StateSnapshotChunk chunk{};
+    ResourceID         cursor{};
+    std::size_t        num_chunks{0};
+    do
+    {
+      ASSERT_TRUE(source.ReadSnapshotChunk(cursor, 64, chunk));
+      ASSERT_EQ(chunk.state, source_hash);
+      ASSERT_EQ(chunk.keys.size(), chunk.values.size());
+      ASSERT_LE(chunk.keys.size(), 64);
+
+      target.WriteSnapshotChunk(chunk);
+
+      if (!chunk.keys.empty())
+      {
+        cursor = chunk.keys.back();
+      }
+
+      ++num_chunks;
+    } while (!chunk.complete && (num_chunks < 100));
+
+    EXPECT_TRUE(chunk.complete);
+    EXPECT_EQ(num_chunks, 8);
+    EXPECT_EQ(target.size(), source.size());
+    EXPECT_EQ(target.Commit(), source_hash);
+  }
+
+  // a cursor which is not present in the store (i.e. the state has changed) is rejected
+  StateSnapshotChunk chunk{};
+  EXPECT_FALSE(source.ReadSnapshotChunk(storage::ResourceAddress("missing"), 64, chunk));
+}
+
+TEST(new_revertible_store_test, compaction_discards_history_beyond_depth)
+{
+  for (auto const backend : {NewRevertibleDocumentStore::IndexBackend::KEY_VALUE_INDEX,
+                             NewRevertibleDocumentStore::IndexBackend::B_TREE})
+  {
+    NewRevertibleDocumentStore store{backend};
+    store.New("a_84.db", "b_84.db", "c_84.db", "d_84.db", true);
+
+    auto const rid = storage::ResourceAddress("a");
+
+    // nothing is compacted while the complete history is retained
+    EXPECT_EQ(store.history_depth(), 0);
+    EXPECT_EQ(store.Compact(), 0);
+
+    std::vector<NewRevertibleDocumentStore::Hash> commits{};
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+      store.Set(rid, std::to_string(i));
+      commits.emplace_back(store.Commit());
+    }
+
+    store.SetHistoryDepth(2);
+    EXPECT_GT(store.Compact(), 0);
+
+    for (std::size_t i = 0; i < commits.size(); ++i)
+    {
+      EXPECT_EQ(store.HashExists(commits[i]), i >= 3);
+    }
+
+    EXPECT_FALSE(store.RevertToHash(commits[2]));
+    EXPECT_EQ(std::string{store.Get(rid).document}, "4");
+
+    ASSERT_TRUE(store.RevertToHash(commits[3]));
+    EXPECT_EQ(std::string{store.Get(rid).document}, "3");
+    EXPECT_EQ(store.CurrentHash(), commits[3]);
+  }
+}
+
+TEST(new_revertible_store_test, committed_reads_serve_the_last_commit)
+{
+  for (auto const mode : {NewRevertibleDocumentStore::WriteMode::IMMEDIATE,
+                          NewRevertibleDocumentStore::WriteMode::BATCHED})
+  {
+    NewRevertibleDocumentStore store;
+    store.New("a_85.db", "b_85.db", "c_85.db", "d_85.db", true);
+    store.SetWriteMode(mode);
+    store.EnableCommittedReads(true);
+
+    auto const rid_a = storage::ResourceAddress("a");
+    auto const rid_b = storage::ResourceAddress("b");
+    auto const rid_c = storage::ResourceAddress("c");
+
+    store.Set(rid_a, "first");
+    store.Set(rid_b, "other");
+    auto const committed_hash = store.Commit();
+
+    // modify, erase and create keys after the commit (flushing any batched writes to storage)
+    store.Set(rid_a, "second");
+    store.Erase(rid_b);
+    store.Set(rid_c, "new");
+    store.FlushPendingWrites();
+    store.Set(rid_a, "third");
+
+    EXPECT_EQ(std::string{store.Get(rid_a).document}, "third");
+    EXPECT_TRUE(store.Get(rid_b).failed);
+
+    EXPECT_EQ(std::string{store.GetCommitted(rid_a).document}, "first");
+    EXPECT_EQ(std::string{store.GetCommitted(rid_b).document}, "other");
+    EXPECT_TRUE(store.GetCommitted(rid_c).failed);
+
+    // once committed the committed reads reflect the new state
+    auto const next_hash = store.Commit();
+    EXPECT_NE(next_hash, committed_hash);
+
+    EXPECT_EQ(std::string{store.GetCommitted(rid_a).document}, "third");
+    EXPECT_TRUE(store.GetCommitted(rid_b).failed);
+    EXPECT_EQ(std::string{store.GetCommitted(rid_c).document}, "new");
+
+    // uncommitted changes discarded by a revert are never visible
+    store.Set(rid_a, "fourth");
+    store.FlushPendingWrites();
+    ASSERT_TRUE(store.RevertToHash(committed_hash));
+
+    EXPECT_EQ(std::string{store.GetCommitted(rid_a).document}, "first");
+    EXPECT_EQ(std::string{store.GetCommitted(rid_b).document}, "other");
+    EXPECT_TRUE(store.GetCommitted(rid_c).failed);
+  }
+}
+
+TEST(new_revertible_store_test, import_produces_the_same_state)
+{
+  NewRevertibleDocumentStore reference;
+  reference.New("a_86.db", "b_86.db", "c_86.db", "d_86.db", true);
+
+  NewRevertibleDocumentStore::Keys   keys{};
+  NewRevertibleDocumentStore::Values values{};
+
+  std::size_t i = 0;
+  for (auto const &hash : GenerateUniqueHashes(500))
+  {
+    keys.emplace_back(hash);
+    values.emplace_back(std::to_string(i++));
+
+    reference.Set(keys.back(), values.back());
+  }
+  auto const reference_hash = reference.Commit();
+
+  for (auto const backend : {NewRevertibleDocumentStore::IndexBackend::KEY_VALUE_INDEX,
+                             NewRevertibleDocumentStore::IndexBackend::B_TREE})
+  {
+    NewRevertibleDocumentStore store{backend};
+    store.New("a_87.db", "b_87.db", "c_87.db", "d_87.db", true);
+
+    store.Import(keys, values);
+
+    EXPECT_EQ(store.size(), reference.size());
+    EXPECT_EQ(store.Commit(), reference_hash);
+    EXPECT_EQ(std::string{store.Get(keys.front()).document}, "0");
+    EXPECT_EQ(std::string{store.Get(keys.back()).document}, "499");
+
+    // imports into a populated store are applied as normal writes
+    store.Import({keys.front()}, {ConstByteArray{"updated"}});
+    EXPECT_EQ(std::string{store.Get(keys.front()).document}, "updated");
+    ASSERT_TRUE(store.RevertToHash(reference_hash));
+    EXPECT_EQ(std::string{store.Get(keys.front()).document}, "0");
+  }
+}
+
+TEST(new_revertible_store_test, compressed_documents_produce_the_same_state)
+{
+  NewRevertibleDocumentStore reference;
+  reference.New("a_88.db", "b_88.db", "c_88.db", "d_88.db", true);
+
+  NewRevertibleDocumentStore store;
+  store.New("a_89.db", "b_89.db", "c_89.db", "d_89.db", true);
+  store.SetCompression(CompressionCodec::LZ4);
+
+  auto const hashes = GenerateUniqueHashes(100);
+  std::vector<ByteArray> const unique_hashes(hashes.begin(), hashes.end());
+
+  // a mix of small documents and large, compressible ones
+  auto const value_of = [](std::size_t i) {
+    std::string value{std::to_string(i)};
+    if ((i % 2) == 0)
+    {
+      for (std::size_t j = 0; j < 2000; ++j)
+      {
+        value += ":" + std::to_string(j % 10);
+      }
+    }
+    return value;
+  };
+
+  std::size_t i = 0;
+  for (auto const &hash : unique_hashes)
+  {
+    reference.Set(storage::ResourceID(hash), value_of(i));
+    store.Set(storage::ResourceID(hash), value_of(i));
+    ++i;
+  }
+
+  auto const first_hash = reference.Commit();
+  EXPECT_EQ(store.Commit(), first_hash);
+
+  // the large documents occupy fewer blocks
+  EXPECT_LT(std::ifstream("a_89.db", std::ios::binary | std::ios::ate).tellg(),
+            std::ifstream("a_88.db", std::ios::binary | std::ios::ate).tellg());
+
+  // documents can be overwritten and read regardless of the codec they were written with
+  store.SetCompression(CompressionCodec::NONE);
+  store.Set(storage::ResourceID(unique_hashes.front()), "overwritten");
+  reference.Set(storage::ResourceID(unique_hashes.front()), "overwritten");
+  EXPECT_EQ(store.Commit(), reference.Commit());
+
+  i = 0;
+  for (auto const &hash : unique_hashes)
+  {
+    auto const expected = (i == 0) ? std::string{"overwritten"} : value_of(i);
+    EXPECT_EQ(std::string{store.Get(storage::ResourceID(hash)).document}, expected);
+    ++i;
+  }
+
+  // snapshots contain the uncompressed documents
+  StateSnapshotChunk reference_chunk{};
+  StateSnapshotChunk chunk{};
+  ASSERT_TRUE(reference.ReadSnapshotChunk(storage::ResourceID{}, 1000, reference_chunk));
+  ASSERT_TRUE(store.ReadSnapshotChunk(storage::ResourceID{}, 1000, chunk));
+  EXPECT_EQ(chunk.values, reference_chunk.values);
+
+  ASSERT_TRUE(store.RevertToHash(first_hash));
+  EXPECT_EQ(std::string{store.Get(storage::ResourceID(unique_hashes.front())).document},
+            value_of(0));
+}
+
 // note: disabled because the storage does not hash the same way as the merkle tree
 TEST(new_revertible_store_test, DISABLED_hashing_correct_basic)
 {
@@ -205,4 +205,80 @@ TEST(versioned_random_access_stack_gtest, loading_file)
   }
 }
 
+TEST(versioned_random_access_stack_gtest, compact_history)
+{
+  std::vector<ByteArray> hashes;
+
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    hashes.push_back(Hash<crypto::SHA256>(std::to_string(i)));
+  }
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.New("d_main.db", "d_history.db");
+
+    // commit a series of states, each of which modifies every element
+    for (std::size_t i = 0; i < 17; ++i)
+    {
+      stack.Push(StringProxy(std::to_string(i)));
+    }
+
+    for (std::size_t commit = 0; commit < hashes.size(); ++commit)
+    {
+      for (std::size_t i = 0; i < 17; ++i)
+      {
+        stack.Set(i, StringProxy(std::to_string(i + commit)));
+      }
+
+      stack.Commit(DefaultKey(hashes[commit]));
+    }
+
+    // it is not possible to compact beyond the available history
+    EXPECT_EQ(stack.Compact(hashes.size() + 1), 0);
+
+    // keep only the last two bookmarks
+    EXPECT_GT(stack.Compact(2), 0);
+    EXPECT_EQ(stack.Compact(2), 0);
+
+    for (std::size_t commit = 0; commit < hashes.size(); ++commit)
+    {
+      EXPECT_EQ(stack.HashExists(DefaultKey(hashes[commit])), commit >= hashes.size() - 2);
+    }
+
+    // reverting to a discarded bookmark must fail without modifying the stack
+    EXPECT_THROW(stack.RevertToHash(DefaultKey(hashes[0])), StorageException);
+
+    for (std::size_t i = 0; i < 17; ++i)
+    {
+      EXPECT_EQ(stack.Get(i), StringProxy(std::to_string(i + 4)));
+    }
+
+    // modify the state again before closing
+    for (std::size_t i = 0; i < 17; ++i)
+    {
+      stack.Set(i, StringProxy(std::to_string(i + 100)));
+    }
+  }
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.Load("d_main.db", "d_history.db");
+
+    EXPECT_FALSE(stack.HashExists(DefaultKey(hashes[2])));
+    EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[3])));
+
+    // revert to the oldest of the retained bookmarks
+    stack.RevertToHash(DefaultKey(hashes[3]));
+
+    for (std::size_t i = 0; i < 17; ++i)
+    {
+      EXPECT_EQ(stack.Get(i), StringProxy(std::to_string(i + 3)));
+    }
+
+    EXPECT_FALSE(stack.HashExists(DefaultKey(hashes[4])));
+    EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[3])));
+  }
+}
+
 }  // namespace
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+#include "core/compression/lz4.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "storage/compression.hpp"
+#include "storage/document.hpp"
+#include "storage/key_byte_array_store.hpp"
+#include "storage/parallel_document_reader.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::storage::CompressionCodec;
+using fetch::storage::Document;
+using fetch::storage::ResourceAddress;
+using fetch::storage::ResourceID;
+
+using Store   = fetch::storage::KeyByteArrayStore<2048>;
+using Reader  = fetch::storage::ParallelDocumentReader<Store>;
+using Entry   = std::pair<ByteArray, ByteArray>;
+using Entries = std::vector<Entry>;
+
+constexpr std::size_t NUM_DOCUMENTS = 2000;
+
+Entry Decode(ByteArray const &key, Document const &document)
+{
+  return {key, document.document};
+}
+
+class ParallelDocumentReaderTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    store_.New("parallel_reader_doc.db", "parallel_reader_index.db");
+    store_.SetCompression(CompressionCodec::LZ4);
+
+    for (std::size_t i = 0; i < NUM_DOCUMENTS; ++i)
+    {
+      // every tenth document is large enough to be stored compressed
+      std::string value = "document " + std::to_string(i);
+      while ((i % 10 == 0) && (value.size() < 5000))
+      {
+        value += " document " + std::to_string(i);
+      }
+
+      store_.Set(ResourceAddress{std::to_string(i)}, value);
+    }
+  }
+
+  Entries Iterate(Store::Iterator it, std::size_t max_entries)
+  {
+    Entries entries{};
+    for (; (it != store_.end()) && (entries.size() < max_entries); ++it)
+    {
+      entries.emplace_back(it.GetKey(), (*it).document);
+    }
+
+    return entries;
+  }
+
+  Store store_;
+};
+
+TEST_F(ParallelDocumentReaderTests, CheckReadMatchesIteration)
+{
+  Reader reader{store_, 4};
+
+  auto       it      = store_.begin();
+  auto const entries = reader.Read(it, NUM_DOCUMENTS, Decode);
+
+  EXPECT_EQ(entries.size(), NUM_DOCUMENTS);
+  EXPECT_EQ(entries, Iterate(store_.begin(), NUM_DOCUMENTS));
+  EXPECT_TRUE(it == store_.end());
+}
+
+TEST_F(ParallelDocumentReaderTests, CheckReadAdvancesIterator)
+{
+  Reader reader{store_, 4};
+
+  auto       it    = store_.begin();
+  auto const first = reader.Read(it, 150, Decode);
+  ASSERT_EQ(first.size(), 150);
+
+  // the iterator resumes after the last document read
+  EXPECT_EQ(it.GetKey(), Iterate(store_.begin(), 151).back().first);
+
+  auto const second = reader.Read(it, NUM_DOCUMENTS, Decode);
+  EXPECT_EQ(first.size() + second.size(), NUM_DOCUMENTS);
+  EXPECT_TRUE(it == store_.end());
+}
+
+TEST_F(ParallelDocumentReaderTests, CheckSubtreeMatchesIteration)
+{
+  Reader reader{store_, 4};
+
+  ResourceID const root{ResourceAddress{"0"}.id()};
+
+  // a subtree of the whole store, and of a prefix
+  for (uint64_t bits : {0u, 3u, 8u})
+  {
+    for (uint64_t partition_bits : {0u, 1u, 4u, 6u})
+    {
+      auto const expected = Iterate(store_.GetSubtree(root, bits), NUM_DOCUMENTS);
+      auto const entries  = reader.ReadSubtree(root, bits, NUM_DOCUMENTS, Decode, partition_bits);
+
+      ASSERT_FALSE(expected.empty());
+      EXPECT_EQ(entries, expected) << "bits: " << bits << " partition bits: " << partition_bits;
+    }
+  }
+}
+
+TEST_F(ParallelDocumentReaderTests, CheckSubtreeIsLimited)
+{
+  Reader reader{store_, 4};
+
+  ResourceID const root{ResourceAddress{"0"}.id()};
+
+  auto const entries = reader.ReadSubtree(root, 0, 100, Decode);
+  EXPECT_EQ(entries, Iterate(store_.begin(), 100));
+}
+
+TEST(ParallelDocumentReaderPartitionTests, CheckPartitionKeys)
+{
+  ByteArray key;
+  key.Resize(32);
+  for (std::size_t i = 0; i < key.size(); ++i)
+  {
+    key[i] = 0xFF;
+  }
+
+  // the prefix is left untouched and the partition index fills the following bits, least
+  // significant bit of each byte first
+  auto const partition = Reader::PartitionKey(key, 6, 4, 0x5);
+  EXPECT_EQ(partition[0], 0x3F | (0u << 6u) | (1u << 7u));
+  EXPECT_EQ(partition[1], 0xFC | (0u << 0u) | (1u << 1u));
+  EXPECT_EQ(partition[2], 0xFF);
+
+  // the original key is not modified
+  EXPECT_EQ(key[0], 0xFF);
+}
+
+}  // namespace
@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lfg.hpp"
+#include "storage/random_access_stack.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::storage::RandomAccessStack;
+using fetch::storage::ReadAheadPolicy;
+
+using ReadAheadStack = RandomAccessStack<uint64_t, uint64_t, ReadAheadPolicy<16>>;
+
+class RandomAccessStackReadAheadTests : public ::testing::Test
+{
+protected:
+  static constexpr uint64_t TEST_SIZE = 1000;
+
+  void SetUp() override
+  {
+    stack_.New("random_access_stack_read_ahead_test.db");
+
+    for (uint64_t i = 0; i < TEST_SIZE; ++i)
+    {
+      uint64_t const value = lfg_();
+
+      stack_.Push(value);
+      reference_.push_back(value);
+    }
+  }
+
+  void TearDown() override
+  {
+    stack_.Close();
+  }
+
+  void CheckForwards()
+  {
+    for (uint64_t i = 0; i < stack_.size(); ++i)
+    {
+      uint64_t value{0};
+      stack_.Get(i, value);
+      ASSERT_EQ(value, reference_[i]) << "Mismatch at index " << i;
+    }
+  }
+
+  fetch::random::LaggedFibonacciGenerator<> lfg_;
+  ReadAheadStack                            stack_;
+  std::vector<uint64_t>                     reference_;
+};
+
+TEST_F(RandomAccessStackReadAheadTests, sequential_and_random_reads)
+{
+  CheckForwards();
+
+  // walk backwards through the stack
+  for (uint64_t i = TEST_SIZE; i > 0; --i)
+  {
+    uint64_t value{0};
+    stack_.Get(i - 1, value);
+    ASSERT_EQ(value, reference_[i - 1]) << "Mismatch at index " << (i - 1);
+  }
+
+  // random access
+  for (uint64_t i = 0; i < TEST_SIZE; ++i)
+  {
+    uint64_t const index = lfg_() % TEST_SIZE;
+
+    uint64_t value{0};
+    stack_.Get(index, value);
+    ASSERT_EQ(value, reference_[index]) << "Mismatch at index " << index;
+  }
+}
+
+TEST_F(RandomAccessStackReadAheadTests, writes_are_visible_to_later_reads)
+{
+  // populate the read ahead window and then modify elements within it
+  uint64_t value{0};
+  stack_.Get(0, value);
+  stack_.Get(1, value);
+
+  stack_.Set(2, 42);
+  reference_[2] = 42;
+
+  // replace the top element of the stack
+  stack_.Pop();
+  stack_.Push(7);
+  reference_.back() = 7;
+
+  stack_.Swap(3, 4);
+  std::swap(reference_[3], reference_[4]);
+
+  uint64_t const bulk[] = {100, 101, 102};
+  stack_.SetBulk(5, 3, bulk);
+  reference_[5] = 100;
+  reference_[6] = 101;
+  reference_[7] = 102;
+
+  CheckForwards();
+}
+
+}  // namespace
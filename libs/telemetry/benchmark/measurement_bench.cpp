@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/histogram.hpp"
+#include "telemetry/log_linear_histogram.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <cstdint>
+
+using fetch::telemetry::Counter;
+using fetch::telemetry::Gauge;
+using fetch::telemetry::Histogram;
+using fetch::telemetry::LogLinearHistogram;
+
+namespace {
+
+// measurements shared between all of the benchmark threads
+std::atomic<uint64_t> shared_atomic{0};
+Counter               counter{"bench_counter_total", "Benchmark counter"};
+Gauge<uint64_t>       gauge{"bench_gauge", "Benchmark gauge"};
+Histogram histogram{{1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 0.1, 1.0, 10.0, 100.0}, "bench_histogram",
+                    "Benchmark histogram"};
+LogLinearHistogram log_linear_histogram{1e-6, 100.0, "bench_log_histogram", "Benchmark histogram"};
+
+// Baseline: a single atomic counter which is shared by all threads (previous counter behaviour)
+void SharedAtomicIncrement(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    shared_atomic.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void CounterIncrement(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    counter.increment();
+  }
+}
+
+void GaugeIncrement(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    gauge.increment();
+  }
+}
+
+void HistogramAdd(benchmark::State &state)
+{
+  double value = 1e-6;
+  for (auto _ : state)
+  {
+    histogram.Add(value);
+
+    value = (value > 100.0) ? 1e-6 : value * 1.5;
+  }
+}
+
+void LogLinearHistogramAdd(benchmark::State &state)
+{
+  double value = 1e-6;
+  for (auto _ : state)
+  {
+    log_linear_histogram.Add(value);
+
+    value = (value > 100.0) ? 1e-6 : value * 1.5;
+  }
+}
+
+}  // namespace
+
+BENCHMARK(SharedAtomicIncrement)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(CounterIncrement)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(GaugeIncrement)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(HistogramAdd)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(LogLinearHistogramAdd)->ThreadRange(1, 8)->UseRealTime();
@@ -19,15 +19,27 @@
 
 #include "telemetry/measurement.hpp"
 
+#include <array>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace fetch {
 namespace telemetry {
 
+/**
+ * Monotonically increasing counter.
+ *
+ * In order to keep the cost of an increment low on hot paths the counter is split into a number
+ * of cache line sized shards. Each thread updates its own shard and the shards are only summed
+ * when the counter is read or collected.
+ */
 class Counter : public Measurement
 {
 public:
+  static constexpr std::size_t NUM_SHARDS = 16;
+
   // Construction / Destruction
   explicit Counter(std::string name, std::string description, Labels labels = Labels{});
   Counter(Counter const &) = delete;
@@ -53,7 +65,21 @@ public:
   Counter &operator=(Counter &&) = delete;
 
 private:
-  std::atomic<uint64_t> counter_{0};
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+  struct Shard
+  {
+    std::atomic<uint64_t> value{0};
+    uint8_t               padding[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)];
+  };
+
+  static_assert(sizeof(Shard) == CACHE_LINE_SIZE, "Shards must not share cache lines");
+
+  using Shards = std::array<Shard, NUM_SHARDS>;
+
+  std::atomic<uint64_t> &LocalShard();
+
+  Shards shards_{};
 };
 
 }  // namespace telemetry
@@ -18,11 +18,12 @@
 //------------------------------------------------------------------------------
 
 #include "telemetry/measurement.hpp"
+#include "telemetry/utils/atomic.hpp"
 #include "telemetry/utils/ends_with.hpp"
 
+#include <atomic>
 #include <iomanip>
 #include <iostream>
-#include <mutex>
 #include <type_traits>
 
 namespace fetch {
@@ -31,7 +32,8 @@ namespace telemetry {
 /**
  * Gauge Telemetry values
  *
- * The gauge value stores a metric value that is expected to go up and down
+ * The gauge value stores a metric value that is expected to go up and down. All of the updates are
+ * lock free.
  *
  * @tparam ValueType
  */
@@ -65,8 +67,7 @@ public:
   Gauge &operator=(Gauge &&) = delete;
 
 private:
-  mutable std::mutex lock_{};
-  ValueType          value_{0};
+  std::atomic<ValueType> value_{0};
 
   static_assert(std::is_arithmetic<ValueType>::value, "");
 };
@@ -99,8 +100,7 @@ Gauge<V>::Gauge(std::string const &name, std::string const &description, Labels
 template <typename V>
 V Gauge<V>::get() const
 {
-  std::lock_guard<std::mutex> guard(lock_);
-  return value_;
+  return value_.load(std::memory_order_relaxed);
 }
 
 /**
@@ -112,8 +112,7 @@ V Gauge<V>::get() const
 template <typename V>
 void Gauge<V>::set(V const &value)
 {
-  std::lock_guard<std::mutex> guard(lock_);
-  value_ = value;
+  value_.store(value, std::memory_order_relaxed);
 }
 
 /**
@@ -124,8 +123,7 @@ void Gauge<V>::set(V const &value)
 template <typename V>
 void Gauge<V>::increment(V const &value)
 {
-  std::lock_guard<std::mutex> guard(lock_);
-  value_ += value;
+  details::AtomicAdd(value_, value);
 }
 
 /**
@@ -136,8 +134,7 @@ void Gauge<V>::increment(V const &value)
 template <typename V>
 void Gauge<V>::decrement(V const &value)
 {
-  std::lock_guard<std::mutex> guard(lock_);
-  value_ -= value;
+  details::AtomicSub(value_, value);
 }
 
 /**
@@ -149,11 +146,7 @@ void Gauge<V>::decrement(V const &value)
 template <typename V>
 void Gauge<V>::max(V const &value)
 {
-  std::lock_guard<std::mutex> guard(lock_);
-  if (value > value_)
-  {
-    value_ = value;
-  }
+  details::AtomicMax(value_, value);
 }
 
 /**
@@ -19,16 +19,22 @@
 
 #include "telemetry/measurement.hpp"
 
-#include <functional>
+#include <atomic>
+#include <cstdint>
 #include <initializer_list>
-#include <map>
-#include <mutex>
 #include <string>
 #include <vector>
 
 namespace fetch {
 namespace telemetry {
 
+/**
+ * Histogram of observations over a fixed set of bucket boundaries.
+ *
+ * Each bucket stores the number of observations which fall between its boundary and the previous
+ * one, so that an observation only updates a single (atomic) bucket. The cumulative counts that
+ * are expected by the consumers are computed when the histogram is collected.
+ */
 class Histogram : public Measurement
 {
 public:
@@ -56,16 +62,18 @@ public:
   Histogram &operator=(Histogram &&) = delete;
 
 private:
-  using BucketMap = std::map<double, uint64_t>;
+  using Bounds   = std::vector<double>;
+  using Buckets  = std::vector<std::atomic<uint64_t>>;
+  using Prefixes = std::vector<std::string>;
 
   template <typename Iterator>
   Histogram(Iterator const &begin, Iterator const &end, std::string const &name,
             std::string const &description, Labels const &labels = Labels{});
 
-  mutable std::mutex lock_;
-  BucketMap          buckets_;
-  uint64_t           count_{0};
-  double             sum_{0.0};
+  Bounds              bounds_;    ///< The sorted upper bounds of the buckets
+  Buckets             buckets_;   ///< The counts per bucket, the final one being the +Inf bucket
+  Prefixes            prefixes_;  ///< The rendered series prefix of each bucket
+  std::atomic<double> sum_{0.0};
 };
 
 }  // namespace telemetry
@@ -0,0 +1,85 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/measurement.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace telemetry {
+
+/**
+ * Log-linear (HDR style) histogram of non-negative observations.
+ *
+ * Each power of two between the lowest and highest trackable values is split into a fixed number
+ * of linearly spaced sub-buckets. The bucket of an observation is computed directly from the
+ * exponent and leading mantissa bits of its floating point representation, making recording O(1)
+ * regardless of the range being covered, while keeping the relative error of each bucket bounded.
+ *
+ * Observations no greater than the lowest value are recorded in the first bucket and observations
+ * above the highest value in the +Inf bucket.
+ */
+class LogLinearHistogram : public Measurement
+{
+public:
+  static constexpr uint32_t SUB_BUCKET_BITS = 2;
+  static constexpr uint32_t SUB_BUCKETS     = 1u << SUB_BUCKET_BITS;
+
+  // Construction / Destruction
+  LogLinearHistogram(double lowest, double highest, std::string const &name,
+                     std::string const &description, Labels const &labels = Labels{});
+  LogLinearHistogram(LogLinearHistogram const &) = delete;
+  LogLinearHistogram(LogLinearHistogram &&)      = delete;
+  ~LogLinearHistogram() override                 = default;
+
+  /// @name Accessors
+  /// @{
+  void        Add(double value);
+  std::size_t num_buckets() const;
+  double      upper_bound(std::size_t index) const;
+  /// @}
+
+  /// @name Measurement Interface
+  /// @{
+  void ToStream(OutputStream &stream) const override;
+  /// @}
+
+  // Operators
+  LogLinearHistogram &operator=(LogLinearHistogram const &) = delete;
+  LogLinearHistogram &operator=(LogLinearHistogram &&) = delete;
+
+private:
+  using Buckets  = std::vector<std::atomic<uint64_t>>;
+  using Prefixes = std::vector<std::string>;
+
+  std::size_t BucketIndex(double value) const;
+
+  double              lowest_;        ///< The lowest value, rounded down to a power of two
+  uint64_t            min_exponent_;  ///< The biased exponent of the lowest value
+  Buckets             buckets_;       ///< The counts per bucket, the final one being +Inf
+  Prefixes            prefixes_;      ///< The rendered series prefix of each bucket
+  std::atomic<double> sum_{0.0};
+};
+
+}  // namespace telemetry
+}  // namespace fetch
@@ -85,11 +85,13 @@ protected:
   OutputStream &WriteValuePrefix(OutputStream &stream, std::string const &suffix) const;
   OutputStream &WriteValuePrefix(OutputStream &stream, std::string const &suffix,
                                  Labels const &extra) const;
+  std::string   RenderValuePrefix(std::string const &suffix, Labels const &extra) const;
 
 private:
   std::string const name_;
   std::string const description_;
   Labels            labels_;
+  std::string       rendered_labels_;  ///< The label set as it appears in the text format
 };
 
 template <typename T>
@@ -20,7 +20,8 @@
 #include "telemetry/measurement.hpp"
 #include "telemetry/telemetry.hpp"
 
-#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <initializer_list>
 #include <memory>
 #include <mutex>
@@ -62,6 +63,10 @@ public:
   HistogramPtr CreateHistogram(std::initializer_list<double> const &buckets, std::string name,
                                std::string description = "", Labels labels = Labels{});
 
+  LogLinearHistogramPtr CreateLogLinearHistogram(double lowest, double highest, std::string name,
+                                                 std::string description = "",
+                                                 Labels      labels      = Labels{});
+
   HistogramMapPtr CreateHistogramMap(std::vector<double> buckets, std::string name,
                                      std::string field, std::string description,
                                      Labels labels = Labels{});
@@ -71,9 +76,16 @@ public:
   /// @{
   template <typename T>
   std::shared_ptr<T> LookupMeasurement(std::string const &name) const;
+
+  template <typename T>
+  std::shared_ptr<T> LookupMeasurement(std::string const &name, Labels const &labels) const;
   /// @}
 
+  /// @name Collection
+  /// @{
   void Collect(std::ostream &stream);
+  void SetCollectionCacheInterval(std::chrono::milliseconds interval);
+  /// @}
 
   // Operators
   Registry &operator=(Registry const &) = delete;
@@ -82,6 +94,9 @@ public:
 private:
   using MeasurementPtr = std::shared_ptr<Measurement>;
   using Measurements   = std::vector<MeasurementPtr>;
+  using Index          = std::unordered_map<std::string, Measurements>;
+  using Clock          = std::chrono::steady_clock;
+  using Timestamp      = Clock::time_point;
 
   // Construction / Destruction
   Registry()  = default;
@@ -89,8 +104,20 @@ private:
 
   static bool ValidateName(std::string const &name);
 
+  void AddMeasurement(MeasurementPtr const &measurement);
+
+  template <typename T, typename Predicate>
+  std::shared_ptr<T> FindMeasurement(std::string const &name, Predicate const &predicate) const;
+
   mutable std::mutex lock_;
-  Measurements       measurements_;
+  Measurements       measurements_;  ///< The measurements in the order they were created
+  Index              index_;         ///< The measurements grouped by name
+
+  std::mutex                collection_lock_;
+  std::string               collection_;  ///< The text from the most recent collection
+  Timestamp                 collection_time_{};
+  std::chrono::milliseconds collection_interval_{0};
+  std::atomic<bool>         collection_stale_{true};
 };
 
 /**
@@ -113,10 +140,7 @@ Registry::GaugePtr<T> Registry::CreateGauge(std::string name, std::string descri
     gauge = std::make_shared<Gauge<T>>(std::move(name), description, std::move(labels));
 
     // add the gauge to the register
-    {
-      std::lock_guard<std::mutex> guard(lock_);
-      measurements_.push_back(gauge);
-    }
+    AddMeasurement(gauge);
   }
 
   return gauge;
@@ -132,36 +156,58 @@ Registry::GaugePtr<T> Registry::CreateGauge(std::string name, std::string descri
 template <typename T>
 std::shared_ptr<T> Registry::LookupMeasurement(std::string const &name) const
 {
-  std::shared_ptr<T> measurement{};
+  return FindMeasurement<T>(name, [](Measurement const &) { return true; });
+}
 
-  auto const matcher = [&name](MeasurementPtr const &m) { return (m->name() == name); };
+/**
+ * Look up an existing metric with a specific set of labels from the registry
+ *
+ * @tparam T The underlying metric type being requested
+ * @param name The name of the metric
+ * @param labels The labels of the metric
+ * @return A metric matching the name and labels, otherwise a null shared pointer
+ */
+template <typename T>
+std::shared_ptr<T> Registry::LookupMeasurement(std::string const &name, Labels const &labels) const
+{
+  return FindMeasurement<T>(name, [&labels](Measurement const &m) { return m.labels() == labels; });
+}
 
+/**
+ * Internal: Find the first metric with the given name and type which satisfies the predicate
+ *
+ * @tparam T The underlying metric type being requested
+ * @tparam Predicate The type of the predicate
+ * @param name The name of the metric
+ * @param predicate The additional check to be made on each candidate
+ * @return The matching metric if one exists, otherwise a null shared pointer
+ */
+template <typename T, typename Predicate>
+std::shared_ptr<T> Registry::FindMeasurement(std::string const &name,
+                                             Predicate const &  predicate) const
+{
   std::lock_guard<std::mutex> guard(lock_);
 
-  // attempt to find the first metric matching the name with the type
-  for (auto start = measurements_.begin(), end = measurements_.end(); start != end;)
+  auto const it = index_.find(name);
+  if (it == index_.end())
   {
-    // attempt to locate the next match
-    auto match = std::find_if(start, end, matcher);
+    return {};
+  }
 
-    if (match != measurements_.end())
+  // only the (usually single) measurements sharing the name are examined, in creation order
+  for (auto const &candidate : it->second)
+  {
+    if (predicate(*candidate))
     {
-      // attempt to convert the measurement to the chosen type
-      measurement = std::dynamic_pointer_cast<T>(*match);
+      auto measurement = std::dynamic_pointer_cast<T>(candidate);
       if (measurement)
       {
-        break;
+        return measurement;
       }
-
-      // otherwise advance the iterator to move to the next element (since the type mismatched)
-      ++match;
     }
-
-    // move the next element
-    start = match;
   }
 
-  return measurement;
+  return {};
 }
 
 }  // namespace telemetry
@@ -0,0 +1,149 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace telemetry {
+
+/**
+ * Process wide, on demand, stack sampling profiler.
+ *
+ * In CPU mode the process CPU time interval timer raises SIGPROF at the configured period and the
+ * stack of the interrupted thread is captured from the signal handler. In allocation mode the
+ * stack is captured once every N bytes allocated by a thread, as reported through OnAllocation by
+ * the global allocation functions of the executable.
+ *
+ * The stacks are captured into a preallocated buffer, with no locking or allocation taking place
+ * while sampling. Once stopped, the samples are attributed to the names of their threads (see
+ * SetThreadName) and can be encoded in the pprof format.
+ */
+class SamplingProfiler
+{
+public:
+  enum class Mode
+  {
+    CPU,
+    ALLOCATIONS
+  };
+
+  using Clock      = std::chrono::steady_clock;
+  using Stack      = std::vector<uintptr_t>;
+  using Nanosecs   = std::chrono::nanoseconds;
+  using Microsecs  = std::chrono::microseconds;
+  using ThreadName = std::string;
+
+  static constexpr std::size_t MAX_SAMPLES     = 32768;
+  static constexpr std::size_t MAX_STACK_DEPTH = 48;
+
+  struct Sample
+  {
+    Stack      stack{};   ///< Return addresses, innermost first
+    ThreadName thread{};  ///< The name of the sampled thread
+    uint64_t   weight{};  ///< The nanoseconds of CPU time or the bytes allocated represented
+  };
+
+  struct Profile
+  {
+    Mode                mode{Mode::CPU};
+    uint64_t            period{0};  ///< The nanoseconds or bytes between consecutive samples
+    Nanosecs            duration{0};
+    std::vector<Sample> samples{};
+    std::size_t         dropped{0};  ///< Samples discarded once the buffer was full
+
+    std::string ToPprof() const;
+  };
+
+  static SamplingProfiler &Instance();
+
+  // Construction / Destruction
+  SamplingProfiler(SamplingProfiler const &) = delete;
+  SamplingProfiler(SamplingProfiler &&)      = delete;
+  ~SamplingProfiler()                        = default;
+
+  /// @name Control
+  /// @{
+  bool    StartCpu(Microsecs period);
+  bool    StartAllocations(std::size_t sample_bytes);
+  Profile Stop();
+  bool    IsRunning() const;
+  /// @}
+
+  /**
+   * Hook for the global allocation functions, only counting the bytes allocated by the calling
+   * thread while allocation sampling is active
+   *
+   * @param size The size of the allocation
+   */
+  static void OnAllocation(std::size_t size)
+  {
+    if (allocation_sampling_.load(std::memory_order_relaxed))
+    {
+      Instance().RecordAllocation(size);
+    }
+  }
+
+  // Operators
+  SamplingProfiler &operator=(SamplingProfiler const &) = delete;
+  SamplingProfiler &operator=(SamplingProfiler &&) = delete;
+
+private:
+  static constexpr std::size_t MAX_THREAD_NAME_LENGTH = 16;
+
+  struct RawSample
+  {
+    std::atomic<bool> ready{false};
+    int               depth{0};
+    uint64_t          weight{0};
+    void *            frames[MAX_STACK_DEPTH];
+    char              thread_name[MAX_THREAD_NAME_LENGTH];
+  };
+
+  using RawSamples = std::unique_ptr<RawSample[]>;
+
+  SamplingProfiler() = default;
+
+  bool Start(Mode mode, uint64_t period);
+  void RecordAllocation(std::size_t size);
+  void Capture(uint64_t weight, int skip);
+
+  static void OnSignal(int signal);
+
+  static std::atomic<bool> allocation_sampling_;
+
+  std::mutex            lock_;
+  std::atomic<bool>     running_{false};
+  Mode                  mode_{Mode::CPU};
+  uint64_t              period_{0};
+  Clock::time_point     started_{};
+  Nanosecs              cpu_started_{0};
+  std::atomic<uint64_t> generation_{0};  ///< Incremented every time the profiler is started
+  RawSamples            buffer_{};
+  std::atomic<uint64_t> next_sample_{0};
+};
+
+}  // namespace telemetry
+}  // namespace fetch
@@ -27,14 +27,16 @@ class Counter;
 class CounterMap;
 class Histogram;
 class HistogramMap;
+class LogLinearHistogram;
 
 template <typename T>
 class Gauge;
 
-using CounterPtr      = std::shared_ptr<Counter>;
-using CounterMapPtr   = std::shared_ptr<CounterMap>;
-using HistogramPtr    = std::shared_ptr<Histogram>;
-using HistogramMapPtr = std::shared_ptr<HistogramMap>;
+using CounterPtr            = std::shared_ptr<Counter>;
+using CounterMapPtr         = std::shared_ptr<CounterMap>;
+using HistogramPtr          = std::shared_ptr<Histogram>;
+using HistogramMapPtr       = std::shared_ptr<HistogramMap>;
+using LogLinearHistogramPtr = std::shared_ptr<LogLinearHistogram>;
 
 template <typename T>
 using GaugePtr = std::shared_ptr<Gauge<T>>;
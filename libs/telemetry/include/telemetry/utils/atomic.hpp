@@ -0,0 +1,81 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+
+namespace fetch {
+namespace telemetry {
+namespace details {
+
+/**
+ * Add a value to an atomic variable. Unlike fetch_add this is also available for floating point
+ * types.
+ *
+ * @tparam T The underlying type of the atomic
+ * @param target The atomic to be updated
+ * @param value The value to be added
+ */
+template <typename T>
+void AtomicAdd(std::atomic<T> &target, T value)
+{
+  T current = target.load(std::memory_order_relaxed);
+  while (!target.compare_exchange_weak(current, static_cast<T>(current + value),
+                                       std::memory_order_relaxed))
+  {
+  }
+}
+
+/**
+ * Subtract a value from an atomic variable. Unlike fetch_sub this is also available for floating
+ * point types.
+ *
+ * @tparam T The underlying type of the atomic
+ * @param target The atomic to be updated
+ * @param value The value to be subtracted
+ */
+template <typename T>
+void AtomicSub(std::atomic<T> &target, T value)
+{
+  T current = target.load(std::memory_order_relaxed);
+  while (!target.compare_exchange_weak(current, static_cast<T>(current - value),
+                                       std::memory_order_relaxed))
+  {
+  }
+}
+
+/**
+ * Update an atomic variable if the specified value is bigger than its current contents
+ *
+ * @tparam T The underlying type of the atomic
+ * @param target The atomic to be updated
+ * @param value The value to be compared
+ */
+template <typename T>
+void AtomicMax(std::atomic<T> &target, T value)
+{
+  T current = target.load(std::memory_order_relaxed);
+  while ((value > current) &&
+         !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+}  // namespace details
+}  // namespace telemetry
+}  // namespace fetch
@@ -18,6 +18,7 @@
 
 #include "telemetry/counter.hpp"
 #include "telemetry/utils/ends_with.hpp"
+#include "telemetry/utils/thread_shard.hpp"
 
 #include <ostream>
 #include <stdexcept>
@@ -35,6 +36,8 @@ bool ValidateName(std::string const &name)
 
 }  // namespace
 
+constexpr std::size_t Counter::NUM_SHARDS;
+
 Counter::Counter(std::string name, std::string description, Labels labels)
   : Measurement(std::move(name), std::move(description), std::move(labels))
 {
@@ -53,35 +56,56 @@ Counter::Counter(std::string name, std::string description, Labels labels)
 void Counter::ToStream(OutputStream &stream) const
 {
   WriteHeader(stream, "counter");
-  WriteValuePrefix(stream) << counter_ << '\n';
+  WriteValuePrefix(stream) << count() << '\n';
 }
 
+/**
+ * Get the current value of the counter, aggregated over all of the shards
+ *
+ * @return The current count
+ */
 uint64_t Counter::count() const
 {
-  return counter_;
+  uint64_t total{0};
+  for (auto const &shard : shards_)
+  {
+    total += shard.value.load(std::memory_order_relaxed);
+  }
+
+  return total;
 }
 
 void Counter::increment()
 {
-  ++counter_;
+  LocalShard().fetch_add(1, std::memory_order_relaxed);
 }
 
 void Counter::add(uint64_t value)
 {
-  counter_ += value;
+  LocalShard().fetch_add(value, std::memory_order_relaxed);
 }
 
 Counter &Counter::operator++()
 {
-  ++counter_;
+  increment();
   return *this;
 }
 
 Counter &Counter::operator+=(uint64_t value)
 {
-  counter_ += value;
+  add(value);
   return *this;
 }
 
+/**
+ * Internal: Get the shard to be updated by the calling thread
+ *
+ * @return The reference to the shard value
+ */
+std::atomic<uint64_t> &Counter::LocalShard()
+{
+  return shards_[details::ThreadShard() % NUM_SHARDS].value;
+}
+
 }  // namespace telemetry
 }  // namespace fetch
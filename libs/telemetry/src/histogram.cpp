@@ -17,7 +17,9 @@
 //------------------------------------------------------------------------------
 
 #include "telemetry/histogram.hpp"
+#include "telemetry/utils/atomic.hpp"
 
+#include <algorithm>
 #include <ostream>
 
 namespace fetch {
@@ -63,14 +65,21 @@ template <typename Iterator>
 Histogram::Histogram(Iterator const &begin, Iterator const &end, std::string const &name,
                      std::string const &description, Labels const &labels)
   : Measurement{name, description, labels}
+  , bounds_(begin, end)
 {
-  std::lock_guard<std::mutex> guard(lock_);
+  // build up the sorted set of bucket boundaries
+  std::sort(bounds_.begin(), bounds_.end());
+  bounds_.erase(std::unique(bounds_.begin(), bounds_.end()), bounds_.end());
 
-  // build up the initial bucket values
-  for (auto it = begin; it != end; ++it)
+  // one bucket for each of the boundaries as well as the implicit +Inf bucket
+  buckets_ = Buckets(bounds_.size() + 1);
+
+  prefixes_.reserve(buckets_.size());
+  for (double bound : bounds_)
   {
-    buckets_.emplace(*it, 0u);
+    prefixes_.emplace_back(RenderValuePrefix("bucket", {{"le", std::to_string(bound)}}));
   }
+  prefixes_.emplace_back(RenderValuePrefix("bucket", {{"le", "+Inf"}}));
 }
 
 /**
@@ -80,17 +89,12 @@ Histogram::Histogram(Iterator const &begin, Iterator const &end, std::string con
  */
 void Histogram::Add(double const &value)
 {
-  std::lock_guard<std::mutex> guard(lock_);
-
-  // update all of the buckets
-  for (auto it = buckets_.lower_bound(value), end = buckets_.end(); it != end; ++it)
-  {
-    ++(it->second);
-  }
+  // locate the first bucket whose boundary is not less than the value
+  auto const index = static_cast<std::size_t>(
+      std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin());
 
-  // update the aggregates
-  ++count_;
-  sum_ += value;
+  buckets_[index].fetch_add(1, std::memory_order_relaxed);
+  details::AtomicAdd(sum_, value);
 }
 
 /**
@@ -101,18 +105,21 @@ void Histogram::Add(double const &value)
  */
 void Histogram::ToStream(OutputStream &stream) const
 {
-  std::lock_guard<std::mutex> guard(lock_);
-
   WriteHeader(stream, "histogram");
-  for (auto const &element : buckets_)
+
+  uint64_t count{0};
+  for (std::size_t i = 0; i < bounds_.size(); ++i)
   {
-    WriteValuePrefix(stream, "bucket", {{"le", std::to_string(element.first)}})
-        << element.second << '\n';
+    count += buckets_[i].load(std::memory_order_relaxed);
+
+    stream << prefixes_[i] << count << '\n';
   }
-  WriteValuePrefix(stream, "bucket", {{"le", "+Inf"}}) << count_ << '\n';
 
-  WriteValuePrefix(stream, "sum") << sum_ << '\n';
-  WriteValuePrefix(stream, "count") << count_ << '\n';
+  count += buckets_.back().load(std::memory_order_relaxed);
+  stream << prefixes_.back() << count << '\n';
+
+  WriteValuePrefix(stream, "sum") << sum_.load(std::memory_order_relaxed) << '\n';
+  WriteValuePrefix(stream, "count") << count << '\n';
 }
 
 }  // namespace telemetry
@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/log_linear_histogram.hpp"
+#include "telemetry/utils/atomic.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace fetch {
+namespace telemetry {
+namespace {
+
+constexpr uint32_t MANTISSA_BITS = 52;
+constexpr int64_t  EXPONENT_BIAS = 1023;
+
+static_assert(std::numeric_limits<double>::is_iec559, "IEEE 754 doubles are required");
+
+uint64_t ToBits(double value)
+{
+  uint64_t bits{0};
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+uint64_t ToExponent(uint64_t bits)
+{
+  return (bits >> MANTISSA_BITS) & 0x7FFu;
+}
+
+}  // namespace
+
+constexpr uint32_t LogLinearHistogram::SUB_BUCKET_BITS;
+constexpr uint32_t LogLinearHistogram::SUB_BUCKETS;
+
+/**
+ * Create a log-linear histogram
+ *
+ * @param lowest The lowest value to be distinguished, rounded down to a power of two
+ * @param highest The highest value to be distinguished
+ * @param name The name of the metric
+ * @param description The description of the metric
+ * @param labels The labels associated with the metric
+ */
+LogLinearHistogram::LogLinearHistogram(double lowest, double highest, std::string const &name,
+                                       std::string const &description, Labels const &labels)
+  : Measurement{name, description, labels}
+{
+  if (!std::isnormal(lowest) || (lowest < 0) || !std::isfinite(highest) || (highest <= lowest))
+  {
+    throw std::runtime_error("Invalid range for the log-linear histogram");
+  }
+
+  min_exponent_ = ToExponent(ToBits(lowest));
+  lowest_       = std::ldexp(1.0, static_cast<int>(static_cast<int64_t>(min_exponent_) -
+                                              EXPONENT_BIAS));
+
+  // one bucket for the lowest value, the buckets up to the highest value and the +Inf bucket
+  buckets_ = Buckets(BucketIndex(highest) + 2);
+
+  prefixes_.reserve(buckets_.size());
+  for (std::size_t i = 0, end = num_buckets(); i < end; ++i)
+  {
+    prefixes_.emplace_back(RenderValuePrefix("bucket", {{"le", std::to_string(upper_bound(i))}}));
+  }
+  prefixes_.emplace_back(RenderValuePrefix("bucket", {{"le", "+Inf"}}));
+}
+
+/**
+ * Add a value to the histogram
+ *
+ * @param value The value to be added
+ */
+void LogLinearHistogram::Add(double value)
+{
+  std::size_t const index = std::min(BucketIndex(value), buckets_.size() - 1);
+
+  buckets_[index].fetch_add(1, std::memory_order_relaxed);
+  details::AtomicAdd(sum_, value);
+}
+
+/**
+ * Get the number of buckets in the histogram, excluding the +Inf bucket
+ *
+ * @return The number of buckets
+ */
+std::size_t LogLinearHistogram::num_buckets() const
+{
+  return buckets_.size() - 1;
+}
+
+/**
+ * Get the (inclusive) upper bound of the specified bucket
+ *
+ * @param index The index of the bucket
+ * @return The upper bound of the bucket
+ */
+double LogLinearHistogram::upper_bound(std::size_t index) const
+{
+  if (index == 0)
+  {
+    return lowest_;
+  }
+
+  auto const octave = static_cast<int>((index - 1) / SUB_BUCKETS);
+  auto const sub    = static_cast<double>(((index - 1) % SUB_BUCKETS) + 1);
+
+  return std::ldexp(lowest_ * (1.0 + (sub / SUB_BUCKETS)), octave);
+}
+
+/**
+ * Write the value of the metric to the stream so as to be consumed by external components
+ *
+ * @param stream The stream to be updated
+ */
+void LogLinearHistogram::ToStream(OutputStream &stream) const
+{
+  WriteHeader(stream, "histogram");
+
+  uint64_t count{0};
+  for (std::size_t i = 0, end = num_buckets(); i < end; ++i)
+  {
+    count += buckets_[i].load(std::memory_order_relaxed);
+
+    stream << prefixes_[i] << count << '\n';
+  }
+
+  count += buckets_.back().load(std::memory_order_relaxed);
+  stream << prefixes_.back() << count << '\n';
+
+  WriteValuePrefix(stream, "sum") << sum_.load(std::memory_order_relaxed) << '\n';
+  WriteValuePrefix(stream, "count") << count << '\n';
+}
+
+/**
+ * Internal: Compute the bucket for the specified value (which might lie beyond the +Inf bucket)
+ *
+ * The value is stepped down to the previous representable double before extracting the exponent
+ * and sub-bucket bits, so that values on a bucket boundary are counted in the lower bucket, as
+ * required by the inclusive upper bounds reported for each of the buckets.
+ *
+ * @param value The value to be bucketed
+ * @return The index of the bucket
+ */
+std::size_t LogLinearHistogram::BucketIndex(double value) const
+{
+  // negative values, NaNs and everything up to the lowest value share the first bucket
+  if (!(value > lowest_))
+  {
+    return 0;
+  }
+
+  uint64_t const bits     = ToBits(value) - 1u;
+  uint64_t const exponent = ToExponent(bits);
+  uint64_t const sub      = (bits >> (MANTISSA_BITS - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1u);
+
+  return static_cast<std::size_t>(((exponent - min_exponent_) << SUB_BUCKET_BITS) + sub + 1u);
+}
+
+}  // namespace telemetry
+}  // namespace fetch
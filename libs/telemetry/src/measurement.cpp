@@ -20,6 +20,7 @@
 
 #include <cassert>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -110,13 +111,13 @@ OutputStream &Measurement::WriteHeader(OutputStream &stream, char const *type_na
 
 OutputStream &Measurement::WriteValuePrefix(OutputStream &stream) const
 {
-  stream << name() << LabelRefs{labels_};
+  stream << name() << rendered_labels_;
   return stream;
 }
 
 OutputStream &Measurement::WriteValuePrefix(OutputStream &stream, std::string const &suffix) const
 {
-  stream << name() << '_' << suffix << LabelRefs{labels_};
+  stream << name() << '_' << suffix << rendered_labels_;
   return stream;
 }
 
@@ -127,11 +128,31 @@ OutputStream &Measurement::WriteValuePrefix(OutputStream &stream, std::string co
   return stream;
 }
 
+/**
+ * Render the value prefix for a fixed set of extra labels, so that measurements can prepare the
+ * prefixes of their series once instead of on every collection
+ *
+ * @param suffix The suffix to be added to the name of the metric
+ * @param extra The extra labels of the series
+ * @return The rendered prefix
+ */
+std::string Measurement::RenderValuePrefix(std::string const &suffix, Labels const &extra) const
+{
+  std::ostringstream oss;
+  oss << name() << '_' << suffix << LabelRefs{labels_, extra};
+  return oss.str();
+}
+
 Measurement::Measurement(std::string name, std::string description, Labels labels)
   : name_{std::move(name)}
   , description_{std::move(description)}
   , labels_{std::move(labels)}
-{}
+{
+  // the labels never change so they are only rendered once
+  std::ostringstream oss;
+  oss << LabelRefs{labels_};
+  rendered_labels_ = oss.str();
+}
 
 std::string const &Measurement::name() const
 {
@@ -21,11 +21,14 @@
 #include "telemetry/gauge.hpp"
 #include "telemetry/histogram.hpp"
 #include "telemetry/histogram_map.hpp"
+#include "telemetry/log_linear_histogram.hpp"
 #include "telemetry/registry.hpp"
 
+#include <chrono>
 #include <initializer_list>
 #include <memory>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -85,10 +88,7 @@ CounterPtr Registry::CreateCounter(std::string name, std::string description, La
     counter = std::make_shared<Counter>(std::move(name), std::move(description), std::move(labels));
 
     // add the counter to the register
-    {
-      std::lock_guard<std::mutex> guard(lock_);
-      measurements_.push_back(counter);
-    }
+    AddMeasurement(counter);
   }
 
   return counter;
@@ -112,10 +112,7 @@ CounterMapPtr Registry::CreateCounterMap(std::string name, std::string descripti
     map = std::make_shared<CounterMap>(std::move(name), std::move(description), std::move(labels));
 
     // add the counter to the register
-    {
-      std::lock_guard<std::mutex> guard(lock_);
-      measurements_.emplace_back(map);
-    }
+    AddMeasurement(map);
   }
 
   return map;
@@ -141,10 +138,35 @@ HistogramPtr Registry::CreateHistogram(std::initializer_list<double> const &buck
     histogram = std::make_shared<Histogram>(buckets, name, description, labels);
 
     // add the counter to the register
-    {
-      std::lock_guard<std::mutex> guard(lock_);
-      measurements_.push_back(histogram);
-    }
+    AddMeasurement(histogram);
+  }
+
+  return histogram;
+}
+
+/**
+ * Create a log-linear histogram instance
+ *
+ * @param lowest The lowest value to be distinguished by the histogram
+ * @param highest The highest value to be distinguished by the histogram
+ * @param name The name of the metric
+ * @param description The description of the metric
+ * @param labels The labels associated with the metric
+ * @return The pointer to the created metric if successful, otherwise a nullptr
+ */
+LogLinearHistogramPtr Registry::CreateLogLinearHistogram(double lowest, double highest,
+                                                         std::string name, std::string description,
+                                                         Labels labels)
+{
+  LogLinearHistogramPtr histogram{};
+
+  if (ValidateName(name))
+  {
+    // create the histogram
+    histogram = std::make_shared<LogLinearHistogram>(lowest, highest, name, description, labels);
+
+    // add the histogram to the register
+    AddMeasurement(histogram);
   }
 
   return histogram;
@@ -164,10 +186,7 @@ HistogramMapPtr Registry::CreateHistogramMap(std::vector<double> buckets, std::s
                                        std::move(description), std::move(labels));
 
     // add the counter to the register
-    {
-      std::lock_guard<std::mutex> guard(lock_);
-      measurements_.emplace_back(histogram_map);
-    }
+    AddMeasurement(histogram_map);
   }
 
   return histogram_map;
@@ -176,17 +195,63 @@ HistogramMapPtr Registry::CreateHistogramMap(std::vector<double> buckets, std::s
 /**
  * Collect up all the metrics into a single stream to be presented to the requestor
  *
+ * The text is reused for subsequent collections until the collection cache interval has elapsed
+ * or a new metric is created, so that several scrapers polling a node share the rendering cost.
+ *
  * @param stream The reference to the stream to be populated
  */
 void Registry::Collect(std::ostream &stream)
 {
-  OutputStream telemetry_stream{stream};
+  std::lock_guard<std::mutex> collection_guard(collection_lock_);
+
+  auto const now = Clock::now();
+  if (collection_stale_.exchange(false) || ((now - collection_time_) >= collection_interval_))
+  {
+    std::ostringstream oss;
+    OutputStream       telemetry_stream{oss};
+
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      for (auto const &measurement : measurements_)
+      {
+        measurement->ToStream(telemetry_stream);
+      }
+    }
+
+    collection_      = oss.str();
+    collection_time_ = now;
+  }
+
+  stream << collection_;
+}
+
+/**
+ * Set the period for which the output of a collection is reused. Defaults to zero, in which case
+ * every collection renders the current values.
+ *
+ * @param interval The period for which collections are cached
+ */
+void Registry::SetCollectionCacheInterval(std::chrono::milliseconds interval)
+{
+  std::lock_guard<std::mutex> collection_guard(collection_lock_);
+  collection_interval_ = interval;
+}
 
-  std::lock_guard<std::mutex> guard(lock_);
-  for (auto const &measurement : measurements_)
+/**
+ * Internal: Add a newly created measurement to the registry
+ *
+ * @param measurement The measurement to be added
+ */
+void Registry::AddMeasurement(MeasurementPtr const &measurement)
+{
   {
-    measurement->ToStream(telemetry_stream);
+    std::lock_guard<std::mutex> guard(lock_);
+    measurements_.emplace_back(measurement);
+    index_[measurement->name()].emplace_back(measurement);
   }
+
+  // the new metric must appear in the next collection
+  collection_stale_ = true;
 }
 
 }  // namespace telemetry
@@ -0,0 +1,521 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/sampling_profiler.hpp"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+namespace fetch {
+namespace telemetry {
+namespace {
+
+// frames of the profiler itself at the top of every captured stack, allocation stacks are left
+// starting from the allocation function
+constexpr int CPU_SKIPPED_FRAMES        = 3;  // Capture, OnSignal and the signal trampoline
+constexpr int ALLOCATION_SKIPPED_FRAMES = 2;  // Capture and RecordAllocation
+constexpr int MAX_SKIPPED_FRAMES        = 3;
+
+struct AllocationCountdown
+{
+  uint64_t generation{0};  ///< The profiling session the countdown belongs to
+  int64_t  remaining{0};   ///< The bytes remaining until the next sample
+};
+
+thread_local AllocationCountdown allocation_countdown{};
+thread_local bool                capturing{false};
+
+std::chrono::nanoseconds ProcessCpuTime()
+{
+  timespec now{};
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+  return std::chrono::seconds{now.tv_sec} + std::chrono::nanoseconds{now.tv_nsec};
+}
+
+/**
+ * The name of the function containing an address, falling back to the module and offset when
+ * the function is not exported
+ */
+std::string Symbolise(uintptr_t address)
+{
+  Dl_info info{};
+  if (dladdr(reinterpret_cast<void *>(address), &info) == 0)
+  {
+    std::ostringstream oss;
+    oss << "0x" << std::hex << address;
+    return oss.str();
+  }
+
+  if (info.dli_sname != nullptr)
+  {
+    int   status{0};
+    char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+
+    std::string name{(status == 0) ? demangled : info.dli_sname};
+    std::free(demangled);
+    return name;
+  }
+
+  std::string module{(info.dli_fname != nullptr) ? info.dli_fname : "?"};
+  module = module.substr(module.find_last_of('/') + 1);
+
+  std::ostringstream oss;
+  oss << module << "+0x" << std::hex << (address - reinterpret_cast<uintptr_t>(info.dli_fbase));
+  return oss.str();
+}
+
+/**
+ * Minimal protocol buffers encoder, sufficient for the pprof profile message
+ */
+class ProtoWriter
+{
+public:
+  void Varint(uint32_t field, uint64_t value)
+  {
+    Key(field, 0);
+    Raw(value);
+  }
+
+  void Bytes(uint32_t field, std::string const &value)
+  {
+    Key(field, 2);
+    Raw(value.size());
+    buffer_.append(value);
+  }
+
+  void Message(uint32_t field, ProtoWriter const &message)
+  {
+    Bytes(field, message.buffer_);
+  }
+
+  void Packed(uint32_t field, std::vector<uint64_t> const &values)
+  {
+    ProtoWriter packed;
+    for (auto value : values)
+    {
+      packed.Raw(value);
+    }
+    Bytes(field, packed.buffer_);
+  }
+
+  std::string const &buffer() const
+  {
+    return buffer_;
+  }
+
+private:
+  void Key(uint32_t field, uint32_t wire_type)
+  {
+    Raw((static_cast<uint64_t>(field) << 3u) | wire_type);
+  }
+
+  void Raw(uint64_t value)
+  {
+    while (value >= 0x80u)
+    {
+      buffer_.push_back(static_cast<char>((value & 0x7Fu) | 0x80u));
+      value >>= 7u;
+    }
+    buffer_.push_back(static_cast<char>(value));
+  }
+
+  std::string buffer_{};
+};
+
+/**
+ * Indices of the strings of a profile, the empty string being the first entry
+ */
+class StringTable
+{
+public:
+  uint64_t operator()(std::string const &value)
+  {
+    auto const it = indices_.emplace(value, strings_.size());
+    if (it.second)
+    {
+      strings_.push_back(value);
+    }
+
+    return it.first->second;
+  }
+
+  std::vector<std::string> const &strings() const
+  {
+    return strings_;
+  }
+
+private:
+  std::unordered_map<std::string, uint64_t> indices_{{"", 0}};
+  std::vector<std::string>                  strings_{""};
+};
+
+ProtoWriter ValueType(StringTable &strings, std::string const &type, std::string const &unit)
+{
+  ProtoWriter value_type;
+  value_type.Varint(1, strings(type));
+  value_type.Varint(2, strings(unit));
+  return value_type;
+}
+
+}  // namespace
+
+constexpr std::size_t SamplingProfiler::MAX_SAMPLES;
+constexpr std::size_t SamplingProfiler::MAX_STACK_DEPTH;
+
+std::atomic<bool> SamplingProfiler::allocation_sampling_{false};
+
+/**
+ * Get the process wide sampling profiler
+ *
+ * @return The profiler instance
+ */
+SamplingProfiler &SamplingProfiler::Instance()
+{
+  static SamplingProfiler instance{};
+  return instance;
+}
+
+/**
+ * Start sampling the stacks of the threads which are consuming CPU time
+ *
+ * @param period The CPU time between consecutive samples
+ * @return true if successful, false if the profiler is already running
+ */
+bool SamplingProfiler::StartCpu(Microsecs period)
+{
+  return Start(Mode::CPU, static_cast<uint64_t>(std::max(period.count(), Microsecs::rep{1})));
+}
+
+/**
+ * Start sampling the stacks of allocations
+ *
+ * @param sample_bytes The number of bytes allocated by a thread between consecutive samples
+ * @return true if successful, false if the profiler is already running
+ */
+bool SamplingProfiler::StartAllocations(std::size_t sample_bytes)
+{
+  return Start(Mode::ALLOCATIONS, std::max<uint64_t>(sample_bytes, 1));
+}
+
+bool SamplingProfiler::Start(Mode mode, uint64_t period)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  if (running_)
+  {
+    return false;
+  }
+
+  if (!buffer_)
+  {
+    buffer_ = RawSamples{new RawSample[MAX_SAMPLES]};
+  }
+
+  for (std::size_t i = 0; i < MAX_SAMPLES; ++i)
+  {
+    buffer_[i].ready = false;
+  }
+
+  // the first stack walk loads the unwinder, which must not happen from a signal handler or the
+  // allocator
+  {
+    void *frames[1];
+    backtrace(frames, 1);
+  }
+
+  mode_        = mode;
+  period_      = period;
+  next_sample_ = 0;
+  started_     = Clock::now();
+  cpu_started_ = ProcessCpuTime();
+  ++generation_;
+  running_ = true;
+
+  if (mode == Mode::CPU)
+  {
+    struct sigaction action = {};
+    action.sa_handler       = &SamplingProfiler::OnSignal;
+    action.sa_flags         = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, nullptr);
+
+    struct itimerval timer    = {};
+    timer.it_interval.tv_sec  = static_cast<time_t>(period / 1000000u);
+    timer.it_interval.tv_usec = static_cast<suseconds_t>(period % 1000000u);
+    timer.it_value            = timer.it_interval;
+    setitimer(ITIMER_PROF, &timer, nullptr);
+  }
+  else
+  {
+    allocation_sampling_ = true;
+  }
+
+  return true;
+}
+
+/**
+ * Stop sampling
+ *
+ * @return The profile of the samples captured since the profiler was started
+ */
+SamplingProfiler::Profile SamplingProfiler::Stop()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  Profile profile{};
+  if (!running_)
+  {
+    return profile;
+  }
+
+  if (mode_ == Mode::CPU)
+  {
+    struct itimerval timer = {};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    signal(SIGPROF, SIG_IGN);
+  }
+  else
+  {
+    allocation_sampling_ = false;
+  }
+
+  running_ = false;
+
+  profile.mode     = mode_;
+  profile.period   = (mode_ == Mode::CPU) ? period_ * 1000u : period_;
+  profile.duration = std::chrono::duration_cast<Nanosecs>(Clock::now() - started_);
+
+  auto const cpu_time = ProcessCpuTime() - cpu_started_;
+
+  uint64_t const captured = std::min<uint64_t>(next_sample_, MAX_SAMPLES);
+  profile.dropped         = static_cast<std::size_t>(next_sample_ - captured);
+
+  for (std::size_t i = 0; i < captured; ++i)
+  {
+    auto const &raw = buffer_[i];
+    if (!raw.ready.load(std::memory_order_acquire))
+    {
+      ++profile.dropped;
+      continue;
+    }
+
+    Sample sample{};
+    sample.thread = (raw.thread_name[0] != '\0') ? raw.thread_name : "unknown";
+    sample.weight = raw.weight;
+    for (int frame = 0; frame < raw.depth; ++frame)
+    {
+      sample.stack.push_back(reinterpret_cast<uintptr_t>(raw.frames[frame]));
+    }
+
+    profile.samples.emplace_back(std::move(sample));
+  }
+
+  // the interval timer only fires on a scheduler tick, which is typically coarser than the period,
+  // so the CPU time consumed is shared out over the samples instead
+  if ((mode_ == Mode::CPU) && !profile.samples.empty())
+  {
+    auto const weight = static_cast<uint64_t>(cpu_time.count()) / profile.samples.size();
+    for (auto &sample : profile.samples)
+    {
+      sample.weight = weight;
+    }
+  }
+
+  return profile;
+}
+
+bool SamplingProfiler::IsRunning() const
+{
+  return running_;
+}
+
+[[gnu::noinline]] void SamplingProfiler::RecordAllocation(std::size_t size)
+{
+  // allocations made while capturing a stack are not sampled
+  if (capturing)
+  {
+    return;
+  }
+
+  auto const period = static_cast<int64_t>(period_);
+
+  auto &countdown = allocation_countdown;
+  if (countdown.generation != generation_)
+  {
+    countdown.generation = generation_;
+    countdown.remaining  = period;
+  }
+
+  countdown.remaining -= static_cast<int64_t>(size);
+  if (countdown.remaining > 0)
+  {
+    return;
+  }
+
+  // every sample stands for the bytes allocated since the previous one
+  auto const weight   = static_cast<uint64_t>(period - countdown.remaining);
+  countdown.remaining = period;
+
+  capturing = true;
+  Capture(weight, ALLOCATION_SKIPPED_FRAMES);
+  capturing = false;
+}
+
+/**
+ * Capture the stack and name of the calling thread into the next free sample. Only async signal
+ * safe operations are used.
+ */
+[[gnu::noinline]] void SamplingProfiler::Capture(uint64_t weight, int skip)
+{
+  uint64_t const index = next_sample_.fetch_add(1, std::memory_order_relaxed);
+  if (index >= MAX_SAMPLES)
+  {
+    return;
+  }
+
+  void *frames[MAX_STACK_DEPTH + MAX_SKIPPED_FRAMES];
+
+  int const depth  = backtrace(frames, static_cast<int>(MAX_STACK_DEPTH) + skip);
+  int const offset = std::min(depth, skip);
+
+  auto &sample  = buffer_[index];
+  sample.depth  = depth - offset;
+  sample.weight = weight;
+  std::copy(frames + offset, frames + depth, sample.frames);
+
+  // the name set with SetThreadName, at most 16 bytes including the terminator
+  if (prctl(PR_GET_NAME, sample.thread_name, 0, 0, 0) != 0)
+  {
+    sample.thread_name[0] = '\0';
+  }
+  sample.ready.store(true, std::memory_order_release);
+}
+
+void SamplingProfiler::OnSignal(int /*signal*/)
+{
+  int const saved_errno = errno;
+
+  auto &profiler = Instance();
+  if (profiler.running_ && (profiler.mode_ == Mode::CPU))
+  {
+    profiler.Capture(profiler.period_ * 1000u, CPU_SKIPPED_FRAMES);
+  }
+
+  errno = saved_errno;
+}
+
+/**
+ * Encode the profile as a (uncompressed) pprof profile.proto message. Every sample is labelled
+ * with the name of its thread and the addresses are symbolised in process.
+ *
+ * @return The encoded profile
+ */
+std::string SamplingProfiler::Profile::ToPprof() const
+{
+  StringTable strings{};
+  ProtoWriter profile{};
+
+  bool const cpu = (mode == Mode::CPU);
+
+  // sample types: a count and the CPU time or bytes it represents
+  char const *unit = cpu ? "nanoseconds" : "bytes";
+  profile.Message(1, ValueType(strings, cpu ? "samples" : "alloc_objects", "count"));
+  profile.Message(1, ValueType(strings, cpu ? "cpu" : "alloc_space", unit));
+
+  std::map<uintptr_t, uint64_t> locations{};
+  for (auto const &sample : samples)
+  {
+    std::vector<uint64_t> location_ids{};
+    for (auto address : sample.stack)
+    {
+      auto const it = locations.emplace(address, locations.size() + 1).first;
+      location_ids.push_back(it->second);
+    }
+
+    ProtoWriter label{};
+    label.Varint(1, strings("thread"));
+    label.Varint(2, strings(sample.thread));
+
+    ProtoWriter entry{};
+    entry.Packed(1, location_ids);
+    entry.Packed(2, {1, sample.weight});
+    entry.Message(3, label);
+
+    profile.Message(2, entry);
+  }
+
+  // one location per address, and one function per symbol
+  std::unordered_map<std::string, uint64_t> functions{};
+  for (auto const &location : locations)
+  {
+    auto const name = Symbolise(location.first);
+    auto const it   = functions.emplace(name, functions.size() + 1);
+
+    if (it.second)
+    {
+      ProtoWriter function{};
+      function.Varint(1, it.first->second);
+      function.Varint(2, strings(name));
+      function.Varint(3, strings(name));
+
+      profile.Message(5, function);
+    }
+
+    ProtoWriter line{};
+    line.Varint(1, it.first->second);
+
+    ProtoWriter entry{};
+    entry.Varint(1, location.second);
+    entry.Varint(3, location.first);
+    entry.Message(4, line);
+
+    profile.Message(4, entry);
+  }
+
+  auto const period_type  = ValueType(strings, cpu ? "cpu" : "space", unit);
+  auto const dropped_note = strings("dropped samples: " + std::to_string(dropped));
+
+  for (auto const &value : strings.strings())
+  {
+    profile.Bytes(6, value);
+  }
+
+  profile.Varint(10, static_cast<uint64_t>(duration.count()));
+  profile.Message(11, period_type);
+  profile.Varint(12, period);
+  profile.Packed(13, {dropped_note});
+
+  return profile.buffer();
+}
+
+}  // namespace telemetry
+}  // namespace fetch
@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/utils/thread_shard.hpp"
+
+#include <atomic>
+#include <limits>
+
+namespace fetch {
+namespace telemetry {
+namespace details {
+
+/**
+ * Get the shard index of the calling thread. Indices are handed out round robin to threads as
+ * they first record a measurement, so that a small number of busy threads do not collide.
+ *
+ * @return The shard index for the current thread
+ */
+std::size_t ThreadShard()
+{
+  static constexpr std::size_t    UNASSIGNED = std::numeric_limits<std::size_t>::max();
+  static std::atomic<std::size_t> next_shard{0};
+
+  // constant initialised so that the access does not need to check a thread local guard
+  thread_local std::size_t shard{UNASSIGNED};
+
+  if (shard == UNASSIGNED)
+  {
+    shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  return shard;
+}
+
+}  // namespace details
+}  // namespace telemetry
+}  // namespace fetch
@@ -20,7 +20,10 @@
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
 #include <memory>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -68,6 +71,30 @@ TEST_F(CounterTests, Add)
   EXPECT_EQ(200, counter_->count());
 }
 
+TEST_F(CounterTests, ConcurrentIncrements)
+{
+  static constexpr std::size_t NUM_THREADS    = Counter::NUM_SHARDS + 4;
+  static constexpr std::size_t NUM_INCREMENTS = 10000;
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([this]() {
+      for (std::size_t j = 0; j < NUM_INCREMENTS; ++j)
+      {
+        counter_->increment();
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(NUM_THREADS * NUM_INCREMENTS, counter_->count());
+}
+
 TEST_F(CounterTests, CheckSerialisation)
 {
   EXPECT_EQ(0, counter_->count());
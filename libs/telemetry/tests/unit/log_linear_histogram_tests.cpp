@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/log_linear_histogram.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::telemetry::LogLinearHistogram;
+using fetch::telemetry::OutputStream;
+
+using HistogramPtr = std::unique_ptr<LogLinearHistogram>;
+
+class LogLinearHistogramTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    histogram_ = std::make_unique<LogLinearHistogram>(1.0, 4.0, "request_time", "Test Metric");
+  }
+
+  void TearDown() override
+  {
+    histogram_.reset();
+  }
+
+  std::string Serialise() const
+  {
+    std::ostringstream oss;
+    OutputStream       stream{oss};
+    histogram_->ToStream(stream);
+
+    return oss.str();
+  }
+
+  HistogramPtr histogram_;
+};
+
+TEST_F(LogLinearHistogramTests, BucketBounds)
+{
+  ASSERT_EQ(9u, histogram_->num_buckets());
+
+  std::vector<double> const expected{1.0, 1.25, 1.5, 1.75, 2.0, 2.5, 3.0, 3.5, 4.0};
+  for (std::size_t i = 0; i < expected.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(expected[i], histogram_->upper_bound(i));
+  }
+}
+
+TEST_F(LogLinearHistogramTests, SimpleCheck)
+{
+  // bucket boundaries are inclusive
+  histogram_->Add(0.5);
+  histogram_->Add(1.0);
+  histogram_->Add(1.25);
+  histogram_->Add(1.3);
+  histogram_->Add(2.0);
+  histogram_->Add(2.1);
+  histogram_->Add(4.0);
+  histogram_->Add(10.0);
+
+  static char const *EXPECTED_TEXT = R"(# HELP request_time Test Metric
+# TYPE request_time histogram
+request_time_bucket{le="1.000000"} 2
+request_time_bucket{le="1.250000"} 3
+request_time_bucket{le="1.500000"} 4
+request_time_bucket{le="1.750000"} 4
+request_time_bucket{le="2.000000"} 5
+request_time_bucket{le="2.500000"} 6
+request_time_bucket{le="3.000000"} 6
+request_time_bucket{le="3.500000"} 6
+request_time_bucket{le="4.000000"} 7
+request_time_bucket{le="+Inf"} 8
+request_time_sum 22.15
+request_time_count 8
+)";
+  EXPECT_EQ(Serialise(), std::string{EXPECTED_TEXT});
+}
+
+TEST_F(LogLinearHistogramTests, LowestIsRoundedToPowerOfTwo)
+{
+  LogLinearHistogram histogram{0.3, 1.0, "request_time", "Test Metric"};
+
+  EXPECT_DOUBLE_EQ(0.25, histogram.upper_bound(0));
+  EXPECT_DOUBLE_EQ(1.0, histogram.upper_bound(histogram.num_buckets() - 1));
+}
+
+TEST_F(LogLinearHistogramTests, InvalidRange)
+{
+  EXPECT_THROW(LogLinearHistogram(0.0, 1.0, "request_time", "Test Metric"), std::runtime_error);
+  EXPECT_THROW(LogLinearHistogram(2.0, 1.0, "request_time", "Test Metric"), std::runtime_error);
+}
+
+TEST_F(LogLinearHistogramTests, ConcurrentAdds)
+{
+  static constexpr std::size_t NUM_THREADS = 8;
+  static constexpr std::size_t NUM_ADDS    = 1000;
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([this]() {
+      for (std::size_t j = 0; j < NUM_ADDS; ++j)
+      {
+        histogram_->Add(1.5);
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  std::string const text = Serialise();
+  EXPECT_NE(std::string::npos, text.find("request_time_sum 12000\n"));
+  EXPECT_NE(std::string::npos, text.find("request_time_count 8000\n"));
+}
+
+}  // namespace
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/counter.hpp"
+#include "telemetry/histogram.hpp"
+#include "telemetry/registry.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using fetch::telemetry::Counter;
+using fetch::telemetry::Histogram;
+using fetch::telemetry::Registry;
+
+using Labels = Registry::Labels;
+
+std::string Collect()
+{
+  std::ostringstream oss;
+  Registry::Instance().Collect(oss);
+  return oss.str();
+}
+
+TEST(RegistryTests, LookupByName)
+{
+  auto &registry = Registry::Instance();
+
+  auto counter = registry.CreateCounter("registry_lookup_total", "Counter to be looked up");
+  ASSERT_TRUE(counter);
+
+  EXPECT_EQ(counter, registry.LookupMeasurement<Counter>("registry_lookup_total"));
+  EXPECT_FALSE(registry.LookupMeasurement<Histogram>("registry_lookup_total"));
+  EXPECT_FALSE(registry.LookupMeasurement<Counter>("registry_missing_total"));
+}
+
+TEST(RegistryTests, LookupByLabels)
+{
+  auto &registry = Registry::Instance();
+
+  auto first  = registry.CreateCounter("registry_labelled_total", "First", Labels{{"id", "1"}});
+  auto second = registry.CreateCounter("registry_labelled_total", "Second", Labels{{"id", "2"}});
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+
+  EXPECT_EQ(first, registry.LookupMeasurement<Counter>("registry_labelled_total"));
+  EXPECT_EQ(first,
+            registry.LookupMeasurement<Counter>("registry_labelled_total", Labels{{"id", "1"}}));
+  EXPECT_EQ(second,
+            registry.LookupMeasurement<Counter>("registry_labelled_total", Labels{{"id", "2"}}));
+  EXPECT_FALSE(
+      registry.LookupMeasurement<Counter>("registry_labelled_total", Labels{{"id", "3"}}));
+}
+
+TEST(RegistryTests, CollectionCache)
+{
+  auto &registry = Registry::Instance();
+
+  auto counter = registry.CreateCounter("registry_cached_total", "Counter to be collected");
+  ASSERT_TRUE(counter);
+
+  registry.SetCollectionCacheInterval(std::chrono::hours{1});
+
+  auto const initial = Collect();
+  EXPECT_NE(std::string::npos, initial.find("registry_cached_total 0\n"));
+
+  // updates are not visible until the cache expires
+  counter->increment();
+  EXPECT_EQ(initial, Collect());
+
+  // creating a new metric invalidates the cache
+  auto other = registry.CreateCounter("registry_cached_other_total", "Other counter");
+  ASSERT_TRUE(other);
+
+  auto const updated = Collect();
+  EXPECT_NE(std::string::npos, updated.find("registry_cached_total 1\n"));
+  EXPECT_NE(std::string::npos, updated.find("registry_cached_other_total 0\n"));
+
+  registry.SetCollectionCacheInterval(std::chrono::milliseconds{0});
+
+  counter->increment();
+  EXPECT_NE(std::string::npos, Collect().find("registry_cached_total 2\n"));
+}
+
+}  // namespace
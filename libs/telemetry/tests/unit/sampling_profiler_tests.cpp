@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/sampling_profiler.hpp"
+
+#include "gmock/gmock.h"
+
+#include <pthread.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace {
+
+using fetch::telemetry::SamplingProfiler;
+
+using ::testing::HasSubstr;
+
+using Clock = std::chrono::steady_clock;
+
+double Spin(std::chrono::milliseconds duration)
+{
+  double     value{0};
+  auto const deadline = Clock::now() + duration;
+
+  while (Clock::now() < deadline)
+  {
+    for (int i = 1; i < 10000; ++i)
+    {
+      value += 1.0 / i;
+    }
+  }
+
+  return value;
+}
+
+class SamplingProfilerTests : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    profiler_.Stop();
+  }
+
+  SamplingProfiler &profiler_{SamplingProfiler::Instance()};
+};
+
+TEST_F(SamplingProfilerTests, CheckOnlyOneProfileIsCollectedAtATime)
+{
+  EXPECT_FALSE(profiler_.IsRunning());
+  EXPECT_TRUE(profiler_.StartCpu(std::chrono::milliseconds{10}));
+  EXPECT_TRUE(profiler_.IsRunning());
+
+  EXPECT_FALSE(profiler_.StartCpu(std::chrono::milliseconds{10}));
+  EXPECT_FALSE(profiler_.StartAllocations(1024));
+
+  auto const profile = profiler_.Stop();
+  EXPECT_EQ(profile.mode, SamplingProfiler::Mode::CPU);
+  EXPECT_EQ(profile.period, 10000000u);
+  EXPECT_FALSE(profiler_.IsRunning());
+}
+
+TEST_F(SamplingProfilerTests, CheckCpuSamplesAreNamedByThread)
+{
+  ASSERT_TRUE(profiler_.StartCpu(std::chrono::milliseconds{1}));
+
+  std::thread worker{[]() {
+    pthread_setname_np(pthread_self(), "Spinner");
+    Spin(std::chrono::milliseconds{300});
+  }};
+  worker.join();
+
+  auto const profile = profiler_.Stop();
+  ASSERT_FALSE(profile.samples.empty());
+
+  bool found{false};
+  for (auto const &sample : profile.samples)
+  {
+    EXPECT_FALSE(sample.stack.empty());
+    EXPECT_GT(sample.weight, 0u);
+    found |= (sample.thread == "Spinner");
+  }
+  EXPECT_TRUE(found);
+
+  auto const encoded = profile.ToPprof();
+  EXPECT_THAT(encoded, HasSubstr("Spinner"));
+  EXPECT_THAT(encoded, HasSubstr("nanoseconds"));
+}
+
+TEST_F(SamplingProfilerTests, CheckAllocationsAreSampledByVolume)
+{
+  // allocations are only counted while allocation sampling is active
+  SamplingProfiler::OnAllocation(1000000);
+
+  ASSERT_TRUE(profiler_.StartAllocations(4096));
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    SamplingProfiler::OnAllocation(1000);
+  }
+
+  auto const profile = profiler_.Stop();
+  EXPECT_EQ(profile.mode, SamplingProfiler::Mode::ALLOCATIONS);
+  ASSERT_EQ(profile.samples.size(), 2u);
+
+  // every sample stands for the bytes allocated since the previous one
+  EXPECT_EQ(profile.samples[0].weight, 5000u);
+  EXPECT_EQ(profile.samples[1].weight, 5000u);
+
+  EXPECT_THAT(profile.ToPprof(), HasSubstr("alloc_space"));
+}
+
+TEST_F(SamplingProfilerTests, CheckStoppingAnIdleProfilerIsEmpty)
+{
+  auto const profile = profiler_.Stop();
+  EXPECT_TRUE(profile.samples.empty());
+  EXPECT_EQ(profile.dropped, 0u);
+}
+
+}  // namespace
@@ -0,0 +1,75 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "variant/variant.hpp"
+
+#include <cstddef>
+
+namespace fetch {
+namespace variant {
+
+/**
+ * Serialises variants to JSON in a reusable output buffer.
+ *
+ * The output has the same layout as the stream operator of the variant, but it is written directly
+ * into a buffer which grows geometrically and is kept between documents, rather than through a
+ * stream and a number of temporary strings. Strings are escaped as required by JSON.
+ *
+ * @note This is not thread safe, a writer is expected to be used by one thread at a time
+ */
+class JsonWriter
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using ByteArray      = byte_array::ByteArray;
+
+  // Construction / Destruction
+  JsonWriter() = default;
+  explicit JsonWriter(std::size_t capacity);
+  JsonWriter(JsonWriter const &) = delete;
+  JsonWriter(JsonWriter &&)      = default;
+  ~JsonWriter()                  = default;
+
+  JsonWriter &   Write(Variant const &value);
+  ConstByteArray Take();
+  void           Clear();
+
+  std::size_t size() const;
+  std::size_t capacity() const;
+
+  // Operators
+  JsonWriter &operator=(JsonWriter const &) = delete;
+  JsonWriter &operator=(JsonWriter &&) = default;
+
+private:
+  static constexpr std::size_t DEFAULT_CAPACITY = 256;
+
+  void WriteString(ConstByteArray const &value);
+  void WriteRaw(char const *data, std::size_t length);
+  void WriteRaw(char value);
+  void Reserve(std::size_t length);
+
+  ByteArray   buffer_{};  ///< The output buffer, its size is the capacity of the writer
+  std::size_t size_{0};   ///< The number of bytes written to the buffer
+};
+
+}  // namespace variant
+}  // namespace fetch
@@ -192,7 +192,8 @@ public:
 
 private:
   using VariantList   = std::vector<Variant>;
-  using VariantObject = std::unordered_map<ConstByteArray, std::unique_ptr<Variant>>;
+  // members are stored in the nodes of the map, which keeps references to them stable
+  using VariantObject = std::unordered_map<ConstByteArray, Variant>;
   using Pool          = detail::ElementPool<Variant>;
 
   union PrimitiveData
@@ -568,7 +569,7 @@ void Variant::IterateObject(Function const &function) const
   {
     for (auto const &item : object_)
     {
-      if (!function(item.first, *item.second))
+      if (!function(item.first, item.second))
       {
         break;
       }
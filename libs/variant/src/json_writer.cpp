@@ -0,0 +1,281 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "variant/json_writer.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+namespace fetch {
+namespace variant {
+
+/**
+ * Construct a writer with a pre-allocated output buffer
+ *
+ * @param capacity The initial capacity of the output buffer in bytes
+ */
+JsonWriter::JsonWriter(std::size_t capacity)
+{
+  buffer_.Resize(capacity, ResizeParadigm::ABSOLUTE, false);
+}
+
+/**
+ * Append the JSON representation of a variant to the output buffer
+ *
+ * @param value The variant to be written
+ * @return Reference to the writer
+ */
+JsonWriter &JsonWriter::Write(Variant const &value)
+{
+  // large enough for any of the primitive values
+  char scratch[32];
+
+  switch (value.type())
+  {
+  case Variant::Type::UNDEFINED:
+    WriteRaw("(undefined)", 11);
+    break;
+
+  case Variant::Type::INTEGER:
+    WriteRaw(scratch, static_cast<std::size_t>(std::snprintf(
+                          scratch, sizeof(scratch), "%" PRId64, value.As<int64_t>())));
+    break;
+
+  case Variant::Type::FLOATING_POINT:
+    // the default formatting of a stream
+    WriteRaw(scratch, static_cast<std::size_t>(
+                          std::snprintf(scratch, sizeof(scratch), "%g", value.As<double>())));
+    break;
+
+  case Variant::Type::FIXED_POINT:
+  {
+    std::ostringstream stream;
+    stream << value.As<fixed_point::fp64_t>();
+
+    auto const formatted = stream.str();
+    WriteRaw(formatted.data(), formatted.size());
+    break;
+  }
+
+  case Variant::Type::STRING:
+    WriteString(value.As<ConstByteArray>());
+    break;
+
+  case Variant::Type::BOOLEAN:
+    if (value.As<bool>())
+    {
+      WriteRaw("true", 4);
+    }
+    else
+    {
+      WriteRaw("false", 5);
+    }
+    break;
+
+  case Variant::Type::NULL_VALUE:
+    WriteRaw("null", 4);
+    break;
+
+  case Variant::Type::ARRAY:
+    WriteRaw('[');
+
+    for (std::size_t i = 0, end = value.size(); i < end; ++i)
+    {
+      if (i != 0)
+      {
+        WriteRaw(", ", 2);
+      }
+
+      Write(value[i]);
+    }
+
+    WriteRaw(']');
+    break;
+
+  case Variant::Type::OBJECT:
+  {
+    WriteRaw('{');
+
+    bool first = true;
+    value.IterateObject([this, &first](ConstByteArray const &key, Variant const &element) {
+      if (!first)
+      {
+        WriteRaw(", ", 2);
+      }
+      first = false;
+
+      WriteString(key);
+      WriteRaw(": ", 2);
+      Write(element);
+
+      return true;
+    });
+
+    WriteRaw('}');
+    break;
+  }
+  }
+
+  return *this;
+}
+
+/**
+ * Extract the document written so far and clear the writer, keeping its output buffer
+ *
+ * @return The written document
+ */
+JsonWriter::ConstByteArray JsonWriter::Take()
+{
+  ConstByteArray const document = buffer_.SubArray(0, size_).Copy();
+  size_                         = 0;
+
+  return document;
+}
+
+/**
+ * Discard the document written so far, keeping the output buffer
+ */
+void JsonWriter::Clear()
+{
+  size_ = 0;
+}
+
+/**
+ * @return The number of bytes written since the writer was last cleared
+ */
+std::size_t JsonWriter::size() const
+{
+  return size_;
+}
+
+/**
+ * @return The capacity of the output buffer in bytes
+ */
+std::size_t JsonWriter::capacity() const
+{
+  return buffer_.size();
+}
+
+/**
+ * Internal: Write a quoted and escaped string
+ *
+ * @param value The string to be written
+ */
+void JsonWriter::WriteString(ConstByteArray const &value)
+{
+  static char const HEX_DIGITS[] = "0123456789abcdef";
+
+  WriteRaw('"');
+
+  auto const *data  = value.char_pointer();
+  std::size_t start = 0;
+  for (std::size_t i = 0, end = value.size(); i < end; ++i)
+  {
+    auto const c = static_cast<unsigned char>(data[i]);
+    if ((c >= 0x20) && (c != '"') && (c != '\\'))
+    {
+      continue;
+    }
+
+    // write the unescaped characters in one go
+    WriteRaw(data + start, i - start);
+    start = i + 1;
+
+    switch (c)
+    {
+    case '"':
+      WriteRaw("\\\"", 2);
+      break;
+    case '\\':
+      WriteRaw("\\\\", 2);
+      break;
+    case '\n':
+      WriteRaw("\\n", 2);
+      break;
+    case '\r':
+      WriteRaw("\\r", 2);
+      break;
+    case '\t':
+      WriteRaw("\\t", 2);
+      break;
+    default:
+    {
+      char const escaped[] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4u], HEX_DIGITS[c & 0xFu]};
+      WriteRaw(escaped, sizeof(escaped));
+      break;
+    }
+    }
+  }
+
+  WriteRaw(data + start, value.size() - start);
+  WriteRaw('"');
+}
+
+/**
+ * Internal: Append raw bytes to the output buffer
+ *
+ * @param data The bytes to be written
+ * @param length The number of bytes
+ */
+void JsonWriter::WriteRaw(char const *data, std::size_t length)
+{
+  if (length == 0)
+  {
+    return;
+  }
+
+  Reserve(length);
+  std::memcpy(buffer_.pointer() + size_, data, length);
+  size_ += length;
+}
+
+/**
+ * Internal: Append a single character to the output buffer
+ *
+ * @param value The character to be written
+ */
+void JsonWriter::WriteRaw(char value)
+{
+  Reserve(1);
+  buffer_.pointer()[size_] = static_cast<uint8_t>(value);
+  ++size_;
+}
+
+/**
+ * Internal: Ensure that a number of bytes can be written to the output buffer. The buffer grows
+ * geometrically, so that a document is written in amortised linear time
+ *
+ * @param length The number of bytes to be written
+ */
+void JsonWriter::Reserve(std::size_t length)
+{
+  std::size_t const required = size_ + length;
+  if (required <= buffer_.size())
+  {
+    return;
+  }
+
+  std::size_t const capacity = std::max({required, 2 * buffer_.size(), DEFAULT_CAPACITY});
+  buffer_.Resize(capacity, ResizeParadigm::ABSOLUTE, false);
+}
+
+}  // namespace variant
+}  // namespace fetch
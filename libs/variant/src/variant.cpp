@@ -64,16 +64,9 @@ Variant &Variant::operator=(Variant const &value)
     break;
 
   case Type::OBJECT:
-  {
-    for (auto const &element : value.object_)
-    {
-      auto variant = std::make_unique<Variant>(*element.second);
-      // update our object
-      object_.emplace(element.first, std::move(variant));
-    }
+    object_ = value.object_;
     break;
   }
-  }
 
   return *this;
 }
@@ -152,7 +145,7 @@ bool Variant::operator==(Variant const &other) const
         }
 
         // if the pointers are different and the contents are different
-        if (*(element.second) != *(it->second))
+        if (element.second != it->second)
         {
           equal = false;
           break;
@@ -237,7 +230,7 @@ std::ostream &operator<<(std::ostream &stream, Variant const &variant)
       }
 
       // format the element
-      stream << std::quoted(std::string{element.first}) << ": " << *element.second;
+      stream << std::quoted(std::string{element.first}) << ": " << element.second;
 
       ++i;
     }
@@ -431,20 +424,8 @@ Variant &Variant::operator[](ConstByteArray const &key)
     throw std::runtime_error("Unable to access keys of non-object variant");
   }
 
-  auto it = object_.find(key);
-  if (it != object_.end())
-  {
-    return *(it->second);
-  }
-
-  // allocate an element
-  auto variant = std::make_unique<Variant>();
-
-  // update the map
-  object_.emplace(key, std::move(variant));
-
-  // return the variant
-  return *object_[key];
+  // creates an undefined element if the key is not present
+  return object_[key];
 }
 
 /**
@@ -468,7 +449,7 @@ Variant const &Variant::operator[](ConstByteArray const &key) const
     throw std::out_of_range("Key not present in object");
   }
 
-  return *(it->second);
+  return it->second;
 }
 
 /**
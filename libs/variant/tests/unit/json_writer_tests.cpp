@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "variant/json_writer.hpp"
+#include "variant/variant.hpp"
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::variant::JsonWriter;
+using fetch::variant::Variant;
+
+std::string Streamed(Variant const &value)
+{
+  std::ostringstream stream;
+  stream << value;
+  return stream.str();
+}
+
+std::string Written(Variant const &value)
+{
+  JsonWriter writer;
+  writer.Write(value);
+  return std::string{writer.Take()};
+}
+
+Variant Document()
+{
+  Variant nested   = Variant::Object();
+  nested["nested"] = false;
+
+  Variant doc     = Variant::Object();
+  doc["name"]     = "fetch";
+  doc["height"]   = int64_t{-1234567890123};
+  doc["ratio"]    = 0.125;
+  doc["enabled"]  = true;
+  doc["nothing"]  = Variant::Null();
+  doc["items"]    = Variant::Array(3);
+  doc["items"][0] = 1;
+  doc["items"][1] = "two";
+  doc["items"][2] = nested;
+
+  return doc;
+}
+
+TEST(JsonWriterTests, PrimitivesMatchTheStreamOperator)
+{
+  for (auto const &value : {Variant{}, Variant{42}, Variant{-7}, Variant{1.5}, Variant{1e300},
+                            Variant{true}, Variant{false}, Variant::Null(), Variant{"hello"},
+                            Variant{fetch::fixed_point::fp64_t{"3.25"}}})
+  {
+    EXPECT_EQ(Written(value), Streamed(value));
+  }
+}
+
+TEST(JsonWriterTests, DocumentsMatchTheStreamOperator)
+{
+  EXPECT_EQ(Written(Variant::Array(0)), "[]");
+  EXPECT_EQ(Written(Variant::Object()), "{}");
+  EXPECT_EQ(Written(Document()), Streamed(Document()));
+}
+
+TEST(JsonWriterTests, StringsAreEscaped)
+{
+  EXPECT_EQ(Written(Variant{"say \"hi\" \\o/"}), R"("say \"hi\" \\o/")");
+  EXPECT_EQ(Written(Variant{"a\nb\tc\rd"}), R"("a\nb\tc\rd")");
+  EXPECT_EQ(Written(Variant{std::string{"\x01\x1f", 2}}), R"("\u0001\u001f")");
+
+  Variant doc      = Variant::Object();
+  doc["line\none"] = 1;
+  EXPECT_EQ(Written(doc), R"({"line\none": 1})");
+}
+
+TEST(JsonWriterTests, OutputBufferIsReused)
+{
+  JsonWriter writer{16};
+  EXPECT_EQ(writer.capacity(), 16);
+
+  writer.Write(Document());
+  auto const size     = writer.size();
+  auto const capacity = writer.capacity();
+  EXPECT_GE(capacity, size);
+
+  ConstByteArray const first = writer.Take();
+  EXPECT_EQ(first.size(), size);
+  EXPECT_EQ(writer.size(), 0);
+
+  // the taken document is not affected by subsequent writes
+  writer.Write(Variant{"overwritten"});
+  EXPECT_EQ(std::string{first}, Streamed(Document()));
+  EXPECT_EQ(writer.capacity(), capacity);
+
+  writer.Clear();
+  writer.Write(Document());
+  EXPECT_EQ(writer.Take(), first);
+  EXPECT_EQ(writer.capacity(), capacity);
+}
+
+}  // namespace
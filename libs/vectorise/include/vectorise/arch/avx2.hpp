@@ -32,6 +32,9 @@
 #include "vectorise/arch/avx2/register_int32.hpp"
 #include "vectorise/arch/avx2/register_int64.hpp"
 
+// AVX-512 widens the floating point registers, the integer and fixed point types stay on AVX2
+#include "vectorise/arch/avx512.hpp"
+
 #undef ADD_REGISTER_SIZE
 
 #endif
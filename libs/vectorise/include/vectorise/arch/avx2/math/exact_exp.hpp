@@ -0,0 +1,282 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/arch/avx2/register_fixed32.hpp"
+#include "vectorise/arch/avx2/register_fixed64.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include <emmintrin.h>
+#include <immintrin.h>
+#include <smmintrin.h>
+
+namespace fetch {
+namespace vectorise {
+namespace details {
+
+// Select the elements of a where the mask is set, otherwise the elements of b
+template <typename R>
+inline R Select256(R const &mask, R const &a, R const &b)
+{
+  return R(_mm256_blendv_epi8(b.data(), a.data(), mask.data()));
+}
+
+// Equivalent of FixedPoint::operator<<=(n) for each element, where n is a non-negative integer
+inline VectorRegister<fixed_point::fp32_t, 256> ShiftLeftByInteger(
+    VectorRegister<fixed_point::fp32_t, 256> const &x,
+    VectorRegister<fixed_point::fp32_t, 256> const &n)
+{
+  return {_mm256_sllv_epi32(x.data(), _mm256_srli_epi32(n.data(), 16))};
+}
+
+inline VectorRegister<fixed_point::fp64_t, 256> ShiftLeftByInteger(
+    VectorRegister<fixed_point::fp64_t, 256> const &x,
+    VectorRegister<fixed_point::fp64_t, 256> const &n)
+{
+  return {_mm256_sllv_epi64(x.data(), _mm256_srli_epi64(n.data(), 32))};
+}
+
+template <typename R>
+inline void SetStateIfAny(R const &mask, uint32_t state)
+{
+  using Type = typename R::type;
+
+  if (any_equal_to(mask, R::MaskAllBits()))
+  {
+    Type::fp_state |= state;
+  }
+}
+
+/**
+ * The range reduction and Pade approximant of FixedPoint::Exp, for x in [0, MAX_EXP]
+ */
+template <typename R>
+inline R ExpReduced(R const &x)
+{
+  using Type = typename R::type;
+
+  R const one(Type::_1);
+  R const ln2(Type::CONST_LN2);
+  R const integer_mask(Type::FromBase(static_cast<typename Type::Type>(~Type::FRACTIONAL_MASK)));
+
+  // x = k*ln2 + r, where floor() only needs to clear the fractional bits as x >= 0
+  R k = (x / ln2) & integer_mask;
+  R r = x - k * ln2;
+
+  R const e1 = ShiftLeftByInteger(one, k);
+
+  R r2 = r * r;
+  R r3 = r2 * r;
+  R r4 = r3 * r;
+  R r5 = r4 * r;
+  r    = r * R(static_cast<Type>(fixed_point::Exp_P01));
+  r2   = r2 * R(static_cast<Type>(fixed_point::Exp_P02));
+  r3   = r3 * R(static_cast<Type>(fixed_point::Exp_P03));
+  r4   = r4 * R(static_cast<Type>(fixed_point::Exp_P04));
+  r5   = r5 * R(static_cast<Type>(fixed_point::Exp_P05));
+
+  R const p = one + r + r2 + r3 + r4 + r5;
+  R const q = one - r + r2 - r3 + r4 - r5;
+
+  return e1 * (p / q);
+}
+
+/**
+ * Elementwise FixedPoint::Exp. All of the special cases of the scalar implementation are
+ * resolved with masks, and the corresponding elements are replaced by zero before the range
+ * reduction so that they do not raise any additional fp_state flags.
+ */
+template <typename R>
+inline R ExactExp256(R const &x)
+{
+  using Type = typename R::type;
+
+  R const zero(Type::_0);
+  R const one(Type::_1);
+
+  R const mask_nan     = R::MaskNaN(x);
+  R const mask_pos_inf = (x == R::MaskPosInf());
+  R const mask_neg_inf = (x == R::MaskNegInf());
+  R const mask_finite  = ~(mask_nan | mask_pos_inf | mask_neg_inf);
+  R const mask_small   = mask_finite & (x < R(Type::MIN_EXP));
+  R const mask_large   = mask_finite & (x > R(Type::MAX_EXP));
+  R const mask_regular = mask_finite & ~(mask_small | mask_large);
+
+  // negative values are computed as 1 / exp(-x)
+  R const mask_negative = mask_regular & (x < zero);
+  R const regular       = Select256(mask_regular, x, zero);
+  R const y             = Select256(mask_negative, -regular, regular);
+
+  // -x can exceed the upper bound since the interval [MIN_EXP, MAX_EXP] is not symmetric
+  R const mask_y_large = mask_negative & (y > R(Type::MAX_EXP));
+  R const mask_y_one   = mask_regular & (y == one);
+  R const reduced      = Select256(~(mask_y_large | mask_y_one), y, zero);
+
+  R e = ExpReduced(reduced);
+  e   = Select256(mask_y_one, R(Type::CONST_E), e);
+  e   = Select256(mask_y_large, R(Type::FP_MAX), e);
+  e   = Select256(mask_negative, one / Select256(mask_negative, e, one), e);
+
+  e = Select256(mask_small | mask_neg_inf, zero, e);
+  e = Select256(mask_large, R(Type::FP_MAX), e);
+  e = Select256(mask_pos_inf, R(Type::POSITIVE_INFINITY), e);
+  e = Select256(mask_nan, R(Type::NaN), e);
+
+  SetStateIfAny(mask_large | mask_y_large, Type::STATE_OVERFLOW);
+  SetStateIfAny(mask_pos_inf, Type::STATE_INFINITY);
+  SetStateIfAny(mask_nan, Type::STATE_NAN);
+
+  return e;
+}
+
+/**
+ * Elementwise equivalent of math::kernels::Sigmoid
+ */
+template <typename R>
+inline R ExactSigmoid256(R const &x)
+{
+  using Type = typename R::type;
+
+  R const zero(Type::_0);
+  R const one(Type::_1);
+
+  // NaN and -infinity are ordered below zero so they take the branch for negative values
+  R const mask_positive = (x >= zero);
+  R const negated       = R(-Type::_1) * Select256(mask_positive, x, zero);
+  R const e             = ExactExp256(Select256(mask_positive, negated, x));
+
+  return Select256(mask_positive, one, e) / (e + one);
+}
+
+/**
+ * Elementwise FixedPoint::TanH, computed as (e^x - e^-x) / (e^x + e^-x) for finite x.
+ *
+ * Only e^|x| is evaluated, FixedPoint::Exp computes e^-|x| as 1 / e^|x| unless -|x| is below
+ * MIN_EXP, in which case it is zero.
+ */
+template <typename R>
+inline R ExactTanH256(R const &x)
+{
+  using Type = typename R::type;
+
+  R const zero(Type::_0);
+  R const one(Type::_1);
+
+  R const mask_nan     = R::MaskNaN(x);
+  R const mask_pos_inf = (x == R::MaskPosInf());
+  R const mask_neg_inf = (x == R::MaskNegInf());
+  R const mask_finite  = ~(mask_nan | mask_pos_inf | mask_neg_inf);
+  R const regular      = Select256(mask_finite, x, zero);
+
+  R const mask_negative = (regular < zero);
+  R const abs           = Select256(mask_negative, -regular, regular);
+
+  R const e_pos = ExactExp256(abs);
+  R const e_neg = Select256(-abs < R(Type::MIN_EXP), zero, one / e_pos);
+
+  R const e1 = Select256(mask_negative, e_neg, e_pos);
+  R const e2 = Select256(mask_negative, e_pos, e_neg);
+
+  R t = (e1 - e2) / (e1 + e2);
+  t   = Select256(mask_pos_inf, R(Type::POSITIVE_INFINITY), t);
+  t   = Select256(mask_neg_inf, R(Type::NEGATIVE_INFINITY), t);
+  t   = Select256(mask_nan, R(Type::NaN), t);
+
+  SetStateIfAny(mask_pos_inf | mask_neg_inf, Type::STATE_INFINITY);
+  SetStateIfAny(mask_nan, Type::STATE_NAN);
+
+  return t;
+}
+
+/**
+ * Elementwise FixedPoint::Pow(x, 3), which is (x * x) * x for finite x. As in the scalar
+ * implementation -infinity gives NaN, since it is evaluated as Pow(0, -3).
+ */
+template <typename R>
+inline R ExactCube256(R const &x)
+{
+  using Type = typename R::type;
+
+  R const zero(Type::_0);
+
+  R const mask_nan     = R::MaskNaN(x) | (x == R::MaskNegInf());
+  R const mask_pos_inf = (x == R::MaskPosInf());
+  R const regular      = Select256(~(mask_nan | mask_pos_inf), x, zero);
+
+  R c = (regular * regular) * regular;
+  c   = Select256(mask_pos_inf, R(Type::POSITIVE_INFINITY), c);
+  c   = Select256(mask_nan, R(Type::NaN), c);
+
+  SetStateIfAny(mask_pos_inf, Type::STATE_INFINITY);
+  SetStateIfAny(mask_nan, Type::STATE_NAN);
+
+  return c;
+}
+
+}  // namespace details
+
+inline VectorRegister<fixed_point::fp32_t, 256> exact_exp(
+    VectorRegister<fixed_point::fp32_t, 256> const &x)
+{
+  return details::ExactExp256(x);
+}
+
+inline VectorRegister<fixed_point::fp64_t, 256> exact_exp(
+    VectorRegister<fixed_point::fp64_t, 256> const &x)
+{
+  return details::ExactExp256(x);
+}
+
+inline VectorRegister<fixed_point::fp32_t, 256> exact_sigmoid(
+    VectorRegister<fixed_point::fp32_t, 256> const &x)
+{
+  return details::ExactSigmoid256(x);
+}
+
+inline VectorRegister<fixed_point::fp64_t, 256> exact_sigmoid(
+    VectorRegister<fixed_point::fp64_t, 256> const &x)
+{
+  return details::ExactSigmoid256(x);
+}
+
+inline VectorRegister<fixed_point::fp32_t, 256> exact_tanh(
+    VectorRegister<fixed_point::fp32_t, 256> const &x)
+{
+  return details::ExactTanH256(x);
+}
+
+inline VectorRegister<fixed_point::fp64_t, 256> exact_tanh(
+    VectorRegister<fixed_point::fp64_t, 256> const &x)
+{
+  return details::ExactTanH256(x);
+}
+
+inline VectorRegister<fixed_point::fp32_t, 256> exact_cube(
+    VectorRegister<fixed_point::fp32_t, 256> const &x)
+{
+  return details::ExactCube256(x);
+}
+
+inline VectorRegister<fixed_point::fp64_t, 256> exact_cube(
+    VectorRegister<fixed_point::fp64_t, 256> const &x)
+{
+  return details::ExactCube256(x);
+}
+
+}  // namespace vectorise
+}  // namespace fetch
@@ -611,11 +611,16 @@ inline VectorRegister<fixed_point::fp32_t, 128> operator*(
   __m256i vb      = _mm256_cvtepi32_epi64(b.data());
   __m256i prod256 = _mm256_mul_epi32(va, vb);
 
-  // compute mask of elements larger than FP_MAX and smaller than FP_MIN
-  __m256i max      = _mm256_set1_epi64x(fixed_point::fp32_t::MAX);
-  __m256i min      = _mm256_set1_epi64x(fixed_point::fp32_t::MIN);
-  __m256i mask_max = _mm256_cmpgt_epi64(prod256, max);
-  __m256i mask_min = _mm256_cmpgt_epi64(min, prod256);
+  // compute mask of elements which are larger than FP_MAX and smaller than FP_MIN once shifted,
+  // AVX2 has no arithmetic 64-bit shift so compare the unshifted products against the bounds
+  __m256i max           = _mm256_set1_epi64x(fixed_point::fp32_t::MAX);
+  __m256i min           = _mm256_set1_epi64x(fixed_point::fp32_t::MIN);
+  __m256i max_unshifted = _mm256_set1_epi64x(
+      ((static_cast<int64_t>(fixed_point::fp32_t::MAX) + 1) * fixed_point::fp32_t::ONE_MASK) - 1);
+  __m256i min_unshifted = _mm256_set1_epi64x(static_cast<int64_t>(fixed_point::fp32_t::MIN) *
+                                             fixed_point::fp32_t::ONE_MASK);
+  __m256i mask_max      = _mm256_cmpgt_epi64(prod256, max_unshifted);
+  __m256i mask_min      = _mm256_cmpgt_epi64(min_unshifted, prod256);
 
   // shift the products right by 16-bits, keep only the lower 32-bits
   prod256 = _mm256_srli_epi64(prod256, 16);
@@ -32,7 +32,9 @@ namespace fetch {
 namespace vectorise {
 
 // ADD_REGISTER_SIZE(float, 128);
+#ifndef __AVX512F__
 ADD_REGISTER_SIZE(float, 256);
+#endif
 
 template <>
 class VectorRegister<float, 128> : public BaseVectorRegisterType
@@ -0,0 +1,42 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace fetch {
+namespace vectorise {
+
+template <>
+struct VectorInfo<float, 512>
+{
+  using NativeType   = float;
+  using RegisterType = __m512;
+};
+
+template <>
+struct VectorInfo<double, 512>
+{
+  using NativeType   = double;
+  using RegisterType = __m512d;
+};
+
+}  // namespace vectorise
+}  // namespace fetch
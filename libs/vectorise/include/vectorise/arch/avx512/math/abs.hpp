@@ -0,0 +1,44 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <immintrin.h>
+#include <limits>
+
+namespace fetch {
+namespace vectorise {
+
+inline VectorRegister<float, 512> abs(VectorRegister<float, 512> const &a)
+{
+  const __m512i mask = _mm512_set1_epi32(std::numeric_limits<int32_t>::max());
+  auto const    ret  = VectorRegister<float, 512>(
+      _mm512_castsi512_ps(_mm512_and_si512(mask, _mm512_castps_si512(a.data()))));
+  return ret;
+}
+
+inline VectorRegister<double, 512> abs(VectorRegister<double, 512> const &a)
+{
+  const __m512i mask = _mm512_set1_epi64(std::numeric_limits<int64_t>::max());
+  auto const    ret  = VectorRegister<double, 512>(
+      _mm512_castsi512_pd(_mm512_and_si512(mask, _mm512_castpd_si512(a.data()))));
+  return ret;
+}
+
+}  // namespace vectorise
+}  // namespace fetch
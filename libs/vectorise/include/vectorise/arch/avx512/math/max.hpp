@@ -0,0 +1,40 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <immintrin.h>
+
+namespace fetch {
+namespace vectorise {
+
+inline VectorRegister<float, 512> Max(VectorRegister<float, 512> const &a,
+                                      VectorRegister<float, 512> const &b)
+{
+  auto const ret = VectorRegister<float, 512>(_mm512_max_ps(a.data(), b.data()));
+  return ret;
+}
+
+inline VectorRegister<double, 512> Max(VectorRegister<double, 512> const &a,
+                                       VectorRegister<double, 512> const &b)
+{
+  auto const ret = VectorRegister<double, 512>(_mm512_max_pd(a.data(), b.data()));
+  return ret;
+}
+
+}  // namespace vectorise
+}  // namespace fetch
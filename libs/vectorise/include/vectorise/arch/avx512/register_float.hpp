@@ -0,0 +1,236 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+#include <immintrin.h>
+
+namespace fetch {
+namespace vectorise {
+
+ADD_REGISTER_SIZE(float, 512);
+
+template <>
+class VectorRegister<float, 512> : public BaseVectorRegisterType
+{
+public:
+  using type           = float;
+  using MMRegisterType = __m512;
+  using MaskType       = __mmask16;
+
+  enum
+  {
+    E_VECTOR_SIZE   = 512,
+    E_REGISTER_SIZE = sizeof(MMRegisterType),
+    E_BLOCK_COUNT   = E_REGISTER_SIZE / sizeof(type)
+  };
+
+  static_assert((E_BLOCK_COUNT * sizeof(type)) == E_REGISTER_SIZE,
+                "type cannot be contained in the given register size.");
+
+  VectorRegister() = default;
+  VectorRegister(type const *d)  // NOLINT
+  {
+    data_ = _mm512_load_ps(d);
+  }
+  VectorRegister(std::initializer_list<type> const &list)
+  {
+    data_ = _mm512_load_ps(reinterpret_cast<type const *>(list.begin()));
+  }
+  VectorRegister(MMRegisterType const &d)  // NOLINT
+    : data_(d)
+  {}
+  VectorRegister(MMRegisterType &&d)  // NOLINT
+    : data_(d)
+  {}
+  VectorRegister(type const &c)  // NOLINT
+  {
+    data_ = _mm512_set1_ps(c);
+  }
+
+  /**
+   * Loads the elements of d selected by the mask, the others are zero. Unselected elements are
+   * not read, so the mask can be used to load the tail of an array.
+   */
+  VectorRegister(type const *d, MaskType mask)
+  {
+    data_ = _mm512_maskz_loadu_ps(mask, d);
+  }
+
+  explicit operator MMRegisterType()
+  {
+    return data_;
+  }
+
+  void Store(type *ptr) const
+  {
+    _mm512_store_ps(ptr, data_);
+  }
+  void Store(type *ptr, MaskType mask) const
+  {
+    _mm512_mask_storeu_ps(ptr, mask, data_);
+  }
+  void Stream(type *ptr) const
+  {
+    _mm512_stream_ps(ptr, data_);
+  }
+
+  MMRegisterType const &data() const
+  {
+    return data_;
+  }
+  MMRegisterType &data()
+  {
+    return data_;
+  }
+
+  /**
+   * @return A mask selecting the first n elements of the register
+   */
+  static MaskType FirstElements(std::size_t n)
+  {
+    return (n >= E_BLOCK_COUNT) ? MaskType(0xFFFF) : MaskType((1u << n) - 1u);
+  }
+
+private:
+  MMRegisterType data_;
+};
+
+template <>
+inline std::ostream &operator<<(std::ostream &s, VectorRegister<float, 512> const &n)
+{
+  alignas(64) float out[16];
+  n.Store(out);
+  s << std::setprecision(std::numeric_limits<float>::digits10);
+  s << std::fixed;
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    s << (i == 0 ? "" : ", ") << out[i];
+  }
+
+  return s;
+}
+
+inline VectorRegister<float, 512> operator-(VectorRegister<float, 512> const &x)
+{
+  return {_mm512_sub_ps(_mm512_setzero_ps(), x.data())};
+}
+
+#define FETCH_ADD_OPERATOR(op, type, size, L, fnc)                                   \
+  inline VectorRegister<type, size> operator op(VectorRegister<type, size> const &a, \
+                                                VectorRegister<type, size> const &b) \
+  {                                                                                  \
+    L ret = fnc(a.data(), b.data());                                                 \
+    return {ret};                                                                    \
+  }
+
+FETCH_ADD_OPERATOR(*, float, 512, __m512, _mm512_mul_ps)
+FETCH_ADD_OPERATOR(-, float, 512, __m512, _mm512_sub_ps)
+FETCH_ADD_OPERATOR(/, float, 512, __m512, _mm512_div_ps)
+FETCH_ADD_OPERATOR(+, float, 512, __m512, _mm512_add_ps)
+
+#undef FETCH_ADD_OPERATOR
+
+// Comparisons produce a mask register, which is expanded into all bits set for the lanes where
+// the comparison holds, as the AVX2 comparisons do
+#define FETCH_ADD_OPERATOR(op, type, fnc)                                              \
+  inline VectorRegister<type, 512> operator op(VectorRegister<type, 512> const &a,     \
+                                               VectorRegister<type, 512> const &b)     \
+  {                                                                                    \
+    __mmask16 mask = _mm512_cmp_ps_mask(a.data(), b.data(), fnc);                      \
+    return {_mm512_castsi512_ps(_mm512_maskz_mov_epi32(mask, _mm512_set1_epi32(-1)))}; \
+  }
+
+FETCH_ADD_OPERATOR(==, float, _CMP_EQ_OQ)
+FETCH_ADD_OPERATOR(!=, float, _CMP_NEQ_UQ)
+FETCH_ADD_OPERATOR(>=, float, _CMP_GE_OQ)
+FETCH_ADD_OPERATOR(>, float, _CMP_GT_OQ)
+FETCH_ADD_OPERATOR(<=, float, _CMP_LE_OQ)
+FETCH_ADD_OPERATOR(<, float, _CMP_LT_OQ)
+
+#undef FETCH_ADD_OPERATOR
+
+inline VectorRegister<float, 512> vector_zero_below_element(VectorRegister<float, 512> const &a,
+                                                            int const &                       n)
+{
+  auto const first = static_cast<std::size_t>(std::max(n, 0));
+  auto const mask  = static_cast<__mmask16>(~VectorRegister<float, 512>::FirstElements(first));
+  return {_mm512_maskz_mov_ps(mask, a.data())};
+}
+
+inline VectorRegister<float, 512> vector_zero_above_element(VectorRegister<float, 512> const &a,
+                                                            int const &                       n)
+{
+  auto const count = static_cast<std::size_t>(std::max(n + 1, 0));
+  auto const mask  = VectorRegister<float, 512>::FirstElements(count);
+  return {_mm512_maskz_mov_ps(mask, a.data())};
+}
+
+inline VectorRegister<float, 512> shift_elements_left(VectorRegister<float, 512> const &x)
+{
+  __m512i n = _mm512_castps_si512(x.data());
+  n         = _mm512_alignr_epi32(n, _mm512_setzero_si512(), 15);
+  return {_mm512_castsi512_ps(n)};
+}
+
+inline VectorRegister<float, 512> shift_elements_right(VectorRegister<float, 512> const &x)
+{
+  __m512i n = _mm512_castps_si512(x.data());
+  n         = _mm512_alignr_epi32(_mm512_setzero_si512(), n, 1);
+  return {_mm512_castsi512_ps(n)};
+}
+
+inline float first_element(VectorRegister<float, 512> const &x)
+{
+  return _mm_cvtss_f32(_mm512_castps512_ps128(x.data()));
+}
+
+inline float reduce(VectorRegister<float, 512> const &x)
+{
+  return _mm512_reduce_add_ps(x.data());
+}
+
+inline bool all_less_than(VectorRegister<float, 512> const &x, VectorRegister<float, 512> const &y)
+{
+  return _mm512_cmp_ps_mask(x.data(), y.data(), _CMP_LT_OQ) == 0xFFFF;
+}
+
+inline bool any_less_than(VectorRegister<float, 512> const &x, VectorRegister<float, 512> const &y)
+{
+  return _mm512_cmp_ps_mask(x.data(), y.data(), _CMP_LT_OQ) != 0;
+}
+
+inline bool all_equal_to(VectorRegister<float, 512> const &x, VectorRegister<float, 512> const &y)
+{
+  return _mm512_cmp_ps_mask(x.data(), y.data(), _CMP_EQ_OQ) == 0xFFFF;
+}
+
+inline bool any_equal_to(VectorRegister<float, 512> const &x, VectorRegister<float, 512> const &y)
+{
+  return _mm512_cmp_ps_mask(x.data(), y.data(), _CMP_EQ_OQ) != 0;
+}
+
+}  // namespace vectorise
+}  // namespace fetch
@@ -0,0 +1,72 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+/* Batch versions of the fixed point exponential, sigmoid, hyperbolic tangent and cube which give
+ * bit-identical results to the scalar implementations (FixedPoint::Exp, math::kernels::Sigmoid,
+ * FixedPoint::TanH and FixedPoint::Pow(x, 3)), regardless of the width of the register and the
+ * instruction set that is available. Without AVX2 the registers
+ * hold a single element and the scalar implementations are used directly.
+ */
+
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/fixed_point/type_traits.hpp"
+#include "vectorise/vectorise.hpp"
+#ifdef __AVX2__
+#include "vectorise/arch/avx2/math/exact_exp.hpp"
+#endif
+
+#include <cstddef>
+
+namespace fetch {
+namespace vectorise {
+
+template <typename T, std::size_t N>
+math::meta::IfIsFixedPoint<T, VectorRegister<T, N>> exact_exp(VectorRegister<T, N> const &x)
+{
+  return VectorRegister<T, N>(T::Exp(x.data()));
+}
+
+template <typename T, std::size_t N>
+math::meta::IfIsFixedPoint<T, VectorRegister<T, N>> exact_sigmoid(VectorRegister<T, N> const &x)
+{
+  T const &value = x.data();
+
+  if (value >= T::_0)
+  {
+    return VectorRegister<T, N>(T::_1 / (T::Exp(-T::_1 * value) + T::_1));
+  }
+
+  T const e = T::Exp(value);
+  return VectorRegister<T, N>(e / (e + T::_1));
+}
+
+template <typename T, std::size_t N>
+math::meta::IfIsFixedPoint<T, VectorRegister<T, N>> exact_tanh(VectorRegister<T, N> const &x)
+{
+  return VectorRegister<T, N>(T::TanH(x.data()));
+}
+
+template <typename T, std::size_t N>
+math::meta::IfIsFixedPoint<T, VectorRegister<T, N>> exact_cube(VectorRegister<T, N> const &x)
+{
+  return VectorRegister<T, N>(T::Pow(x.data(), T{3}));
+}
+
+}  // namespace vectorise
+}  // namespace fetch
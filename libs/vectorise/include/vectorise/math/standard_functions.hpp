@@ -21,6 +21,9 @@
 #ifdef __AVX2__
 #include "vectorise/arch/avx2/math/standard_functions.hpp"
 #endif
+#ifdef __AVX512F__
+#include "vectorise/arch/avx512/math/standard_functions.hpp"
+#endif
 #include "vectorise/math/max.hpp"
 #include "vectorise/math/min.hpp"
 
@@ -0,0 +1,55 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdlib>
+
+namespace fetch {
+namespace memory {
+
+/**
+ * Alignment of vector buffers, enough for the widest (AVX-512) registers
+ */
+constexpr std::size_t VECTOR_ALIGNMENT = 64;
+
+/**
+ * Portable replacement of _mm_malloc, which is only available on x86
+ *
+ * @param bytes The size of the allocation
+ * @param alignment The alignment, a power of two multiple of sizeof(void *)
+ * @return The allocated memory, to be freed with AlignedFree, or nullptr on failure
+ */
+inline void *AlignedAllocate(std::size_t bytes, std::size_t alignment = VECTOR_ALIGNMENT)
+{
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, alignment, bytes) != 0)
+  {
+    return nullptr;
+  }
+
+  return ptr;
+}
+
+inline void AlignedFree(void *ptr)
+{
+  std::free(ptr);
+}
+
+}  // namespace memory
+}  // namespace fetch
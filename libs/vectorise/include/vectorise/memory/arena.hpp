@@ -0,0 +1,178 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/memory/aligned_allocation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace fetch {
+namespace memory {
+
+/**
+ * Bump allocator for the buffers of shared arrays.
+ *
+ * The arena carves buffers out of large chunks. Each buffer shares ownership of its chunk, so a
+ * chunk is released once the arena and every array allocated from it have gone. This replaces
+ * the two heap allocations (buffer and reference count) of every array with a single allocation
+ * per chunk, which pays off when decoding large objects made of many small arrays.
+ *
+ * Arenas are not thread safe. They are made active for the current thread with an `ArenaScope`,
+ * while a scope is active all `SharedArray` allocations on that thread are served by the arena.
+ * Memory is only reclaimed per chunk, so arenas should be used for objects whose parts share a
+ * lifetime, like a decoded block.
+ */
+class Arena
+{
+public:
+  static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+  static constexpr std::size_t ALIGNMENT          = 64;
+
+  explicit Arena(std::size_t chunk_size = DEFAULT_CHUNK_SIZE)
+    : chunk_size_{chunk_size}
+  {}
+  Arena(Arena const &) = delete;
+  Arena(Arena &&)      = delete;
+  ~Arena()             = default;
+
+  /**
+   * Allocate a buffer from the arena
+   *
+   * @tparam T The element type
+   * @param count The number of elements
+   * @return The buffer, or nullptr if the request is too large to be served by the arena
+   */
+  template <typename T>
+  std::shared_ptr<T> Allocate(std::size_t count)
+  {
+    std::size_t const bytes = AlignUp(count * sizeof(T));
+
+    // large requests would waste most of a chunk, leave them to the regular allocator
+    if ((bytes == 0) || (bytes > chunk_size_ / 4))
+    {
+      return {};
+    }
+
+    if (!chunk_ || (offset_ + bytes > chunk_size_))
+    {
+      NewChunk();
+    }
+
+    auto *buffer = reinterpret_cast<T *>(chunk_.get() + offset_);
+    offset_ += bytes;
+    ++allocations_;
+
+    // aliasing constructor: the array keeps the whole chunk alive
+    return std::shared_ptr<T>(chunk_, buffer);
+  }
+
+  /// @name Statistics
+  /// @{
+  std::size_t chunks() const noexcept
+  {
+    return chunks_;
+  }
+
+  std::size_t allocations() const noexcept
+  {
+    return allocations_;
+  }
+  /// @}
+
+  /**
+   * The arena active on the calling thread, if any
+   *
+   * @return The active arena or nullptr
+   */
+  static Arena *Current() noexcept
+  {
+    return Active();
+  }
+
+  // Operators
+  Arena &operator=(Arena const &) = delete;
+  Arena &operator=(Arena &&) = delete;
+
+private:
+  friend class ArenaScope;
+
+  static Arena *&Active() noexcept
+  {
+    static thread_local Arena *active{nullptr};
+    return active;
+  }
+
+  static constexpr std::size_t AlignUp(std::size_t bytes) noexcept
+  {
+    return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+
+  void NewChunk()
+  {
+    auto *raw = static_cast<uint8_t *>(AlignedAllocate(chunk_size_, ALIGNMENT));
+    if (raw == nullptr)
+    {
+      throw std::runtime_error("Can't allocate arena chunk of size " + std::to_string(chunk_size_));
+    }
+
+    chunk_  = std::shared_ptr<uint8_t>(raw, AlignedFree);
+    offset_ = 0;
+    ++chunks_;
+  }
+
+  std::size_t const        chunk_size_;
+  std::shared_ptr<uint8_t> chunk_{};
+  std::size_t              offset_{0};
+  std::size_t              chunks_{0};
+  std::size_t              allocations_{0};
+};
+
+/**
+ * Makes an arena the active allocator for shared arrays on the current thread for the lifetime
+ * of the scope. Scopes nest, the previously active arena is restored on destruction.
+ */
+class ArenaScope
+{
+public:
+  explicit ArenaScope(Arena &arena) noexcept
+    : previous_{Arena::Active()}
+  {
+    Arena::Active() = &arena;
+  }
+  ArenaScope(ArenaScope const &) = delete;
+  ArenaScope(ArenaScope &&)      = delete;
+
+  ~ArenaScope()
+  {
+    Arena::Active() = previous_;
+  }
+
+  // Operators
+  ArenaScope &operator=(ArenaScope const &) = delete;
+  ArenaScope &operator=(ArenaScope &&) = delete;
+
+private:
+  Arena *previous_;
+};
+
+}  // namespace memory
+}  // namespace fetch
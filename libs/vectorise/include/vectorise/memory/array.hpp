@@ -19,6 +19,7 @@
 
 #include "meta/log2.hpp"
 #include "vectorise/fixed_point/type_traits.hpp"
+#include "vectorise/memory/aligned_allocation.hpp"
 #include "vectorise/memory/iterator.hpp"
 #include "vectorise/memory/parallel_dispatcher.hpp"
 #include "vectorise/memory/vector_slice.hpp"
@@ -30,7 +31,6 @@
 #include <cstdlib>
 #include <cstring>
 #include <memory>
-#include <mm_malloc.h>
 #include <type_traits>
 
 namespace fetch {
@@ -54,7 +54,7 @@ public:
 
     if (n > 0)
     {
-      this->pointer_ = reinterpret_cast<type *>(_mm_malloc(this->padded_size() * sizeof(type), 32));
+      this->pointer_ = static_cast<type *>(AlignedAllocate(this->padded_size() * sizeof(type)));
     }
   }
 
@@ -62,7 +62,7 @@ public:
   {
     if (this->pointer_ != nullptr)
     {
-      _mm_free(this->pointer_);
+      AlignedFree(this->pointer_);
     }
   }
 
@@ -92,13 +92,13 @@ public:
   {
     if (this->pointer_ != nullptr)
     {
-      _mm_free(this->pointer_);
+      AlignedFree(this->pointer_);
     }
     this->size_ = other.size();
 
     if (this->size_ > 0)
     {
-      this->pointer_ = reinterpret_cast<type *>(_mm_malloc(this->padded_size() * sizeof(type), 32));
+      this->pointer_ = static_cast<type *>(AlignedAllocate(this->padded_size() * sizeof(type)));
     }
 
     for (std::size_t i = 0; i < this->size_; ++i)
@@ -18,11 +18,11 @@
 //------------------------------------------------------------------------------
 
 #include "meta/log2.hpp"
+#include "vectorise/memory/aligned_allocation.hpp"
+#include "vectorise/memory/arena.hpp"
 #include "vectorise/memory/iterator.hpp"
 #include "vectorise/memory/vector_slice.hpp"
 
-#include <mm_malloc.h>
-
 #include <algorithm>
 #include <atomic>
 #include <cassert>
@@ -57,8 +57,18 @@ public:
 
     if (n > 0)
     {
-      data_ = std::shared_ptr<T>(
-          static_cast<T *>(_mm_malloc(this->padded_size() * sizeof(type), 64)), _mm_free);
+      // serve the buffer from the thread's active arena (if any) when possible
+      Arena *arena = Arena::Current();
+      if (arena != nullptr)
+      {
+        data_ = arena->Allocate<T>(this->padded_size());
+      }
+
+      if (!data_)
+      {
+        data_ = std::shared_ptr<T>(
+            static_cast<T *>(AlignedAllocate(this->padded_size() * sizeof(type))), AlignedFree);
+      }
 
       if (!data_)
       {
@@ -71,6 +81,18 @@ public:
 
   constexpr SharedArray() = default;
 
+  /**
+   * Adopt an externally owned buffer (for example a memory mapped file). The buffer must be
+   * suitably aligned and at least padded_size() elements in length.
+   *
+   * @param data The owning pointer to the buffer
+   * @param n The number of elements in the buffer
+   */
+  SharedArray(DataType data, std::size_t n) noexcept
+    : SuperType(data.get(), n)
+    , data_(std::move(data))
+  {}
+
   SharedArray(SharedArray const &other) noexcept
     : SuperType(other.pointer_, other.size())
     , data_(other.data_)
@@ -196,6 +196,42 @@ constexpr bool has_avx2()
 #endif
 }
 
+constexpr bool has_avx512()
+{
+#ifdef __AVX512F__
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Checks at run time that the CPU supports the vector extensions the binary was compiled for.
+ * Distributed binaries built for AVX2 or AVX-512 otherwise die with an illegal instruction on
+ * older CPUs, so they should call this on start up.
+ *
+ * @return true if the binary can run on this CPU
+ */
+inline bool SupportsCompiledVectorExtensions()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+#ifdef __AVX2__
+  if (!__builtin_cpu_supports("avx2"))
+  {
+    return false;
+  }
+#endif
+#ifdef __AVX512F__
+  if (!__builtin_cpu_supports("avx512f"))
+  {
+    return false;
+  }
+#endif
+#endif
+  return true;
+}
+
 #define FETCH_ASM_LABEL(Label) __asm__("#" Label)
 
 // Allow the option of specifying our platform endianness
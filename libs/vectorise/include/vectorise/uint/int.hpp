@@ -21,6 +21,7 @@
 #include "meta/type_traits.hpp"
 #include "vectorise/containers/array.hpp"
 #include "vectorise/platform.hpp"
+#include "vectorise/uint/limbs.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -222,6 +223,8 @@ public:
   template <typename T>
   constexpr meta::IfIsInteger<T, Int> &operator>>=(T n);
 
+  constexpr Int DivMod(Int const &n, Int &remainder) const;
+
   constexpr Int         Sign() const;
   constexpr bool        IsPositive() const;
   constexpr std::size_t msb() const;
@@ -759,153 +762,72 @@ constexpr Int<S> &Int<S>::operator-=(Int<S> const &n)
   return *this;
 }
 
-// Implementation for 256-bits only
-// template <>
 template <uint16_t S>
 constexpr Int<S> &Int<S>::operator*=(Int<S> const &n)
 {
-  if (*this == _0 || n == _0)
-  {
-    *this = _0;
-    return *this;
-  }
+  // the product of two's complement numbers truncated to their size is the same as the product of
+  // their unsigned representations
+  WideType product[WIDE_ELEMENTS] = {};
+  details::MultiplyLimbs(wide_.data(), WIDE_ELEMENTS, n.wide_.data(), WIDE_ELEMENTS, product,
+                         WIDE_ELEMENTS);
 
-  bool sign = true;
-  if (*this < _0)
-  {
-    *this = -*this;
-    sign  = !sign;
-  }
-  Int<256> o{n};
-  if (o < _0)
+  for (std::size_t i = 0; i < WIDE_ELEMENTS; ++i)
   {
-    o    = -o;
-    sign = !sign;
+    wide_[i] = product[i];
   }
 
-  // Calculate all products between each uint64_t element in the Ints
-  // Use int128_t type to hold the actual product.
-  uint128_t products[WIDE_ELEMENTS][WIDE_ELEMENTS] = {};
+  return *this;
+}
 
-  for (std::size_t i = 0; i < WIDE_ELEMENTS; ++i)
-  {
-    for (std::size_t j = 0; j < WIDE_ELEMENTS; ++j)
-    {
-      // Note: C++14 does not have constexpr std::array, we need to cast the array
-      products[i][j] = static_cast<uint128_t>(wide_[i]) * static_cast<uint128_t>(o.ElementAt(j));
-    }
-  }
+template <uint16_t S>
+constexpr Int<S> &Int<S>::operator/=(Int<S> const &n)
+{
+  Int<S> remainder{};
+  *this = DivMod(n, remainder);
 
-  /* If a, b, two Int<256> numbers, with the following elements (little endian order):
-   * |  a[3]  |  a[2]  |  a[1]  |  a[0]  |
-   * |  b[3]  |  b[2]  |  b[1]  |  b[0]  |
-   * Then both can be written in the following form:
-   * a = a[0] + (a[1] << 64) + (a[2] << 128) + (a[3] << 192)
-   * b = b[0] + (b[1] << 64) + (b[2] << 128) + (b[3] << 192)
-   *
-   * Then a * b is the following, truncating terms left shifted over 192 bits:
-   * a * b =  a[0] * b[0]
-   *       + (a[0] * b[1] + a[1] * b[0]) << 64
-   *       + (a[0] * b[2] + a[1] * b[1] + a[2] * b[0]) << 128
-   *       + (a[0] * b[3] + a[1] * b[2] + a[2] * b[1] + a[3] * b[0]) << 192
-   * In order to be accurate, we calculate these terms as 128-bit quantities and we add the
-   * high-64-bits as carry to the next term
-   */
-
-  uint128_t carry = 0, terms[WIDE_ELEMENTS] = {};
-  terms[0] = products[0][0];
-  carry    = static_cast<WideType>(terms[0] >> WIDE_ELEMENT_SIZE);
-  terms[1] = products[0][1] + products[1][0] + carry;
-  carry    = static_cast<WideType>(terms[1] >> WIDE_ELEMENT_SIZE);
-  terms[2] = products[0][2] + products[1][1] + products[2][0] + carry;
-  carry    = static_cast<WideType>(terms[2] >> WIDE_ELEMENT_SIZE);
-  terms[3] = products[0][3] + products[1][2] + products[2][1] + products[3][0] + carry;
+  return *this;
+}
 
-  for (std::size_t i = 0; i < WIDE_ELEMENTS; ++i)
-  {
-    wide_[i] = static_cast<WideType>(terms[i]);
-  }
+template <uint16_t S>
+constexpr Int<S> &Int<S>::operator%=(Int<S> const &n)
+{
+  DivMod(n, *this);
 
-  if (!sign)
-  {
-    *this = -*this;
-  }
   return *this;
 }
 
+/**
+ * Divide by a number, obtaining the quotient and remainder of the division at once. The quotient
+ * is rounded towards zero and the remainder has the sign of the dividend.
+ *
+ * @param n The divisor
+ * @param remainder Set to the remainder of the division
+ * @return The quotient of the division
+ */
 template <uint16_t S>
-constexpr Int<S> &Int<S>::operator/=(Int<S> const &n)
+constexpr Int<S> Int<S>::DivMod(Int<S> const &n, Int<S> &remainder) const
 {
-  if (n == _0)
-  {
-    throw std::runtime_error("division by zero!");
-  }
-  if (n == _1)
-  {
-    return *this;
-  }
-  if (*this == n)
-  {
-    *this = _1;
-    return *this;
-  }
-  if (*this == _0)
-  {
-    return *this;
-  }
+  bool const negative_dividend = *this < _0;
+  bool const negative_divisor  = n < _0;
 
-  // Actual integer division algorithm
-  // First simplify dividend/divisor by shifting right by min LSB bit
-  // Essentially divide both by 2 as long as the LSB is zero
-  Int<S> N{*this}, D{n};
-  Int<S> sign = _1;
-  if (N < _0)
-  {
-    N    = -N;
-    sign = -sign;
-  }
-  if (D < _0)
-  {
-    D    = -D;
-    sign = -sign;
-  }
+  Int<S> const dividend = negative_dividend ? -*this : *this;
+  Int<S> const divisor  = negative_divisor ? -n : n;
 
-  std::size_t lsb = std::min(N.lsb(), D.lsb());
-  N >>= lsb;
-  D >>= lsb;
-  Int<S> multiple(1u);
+  Int<S> quotient{};
+  details::DivideLimbs<WIDE_ELEMENTS, WIDE_ELEMENTS>(dividend.wide_.data(), divisor.wide_.data(),
+                                                     quotient.wide_.data(),
+                                                     remainder.wide_.data());
 
-  // Find smallest multiple of divisor (D) that is larger than the dividend (N)
-  while (N > D)
+  if (negative_dividend != negative_divisor)
   {
-    D <<= 1;
-    multiple <<= 1;
+    quotient = -quotient;
   }
-  // Calculate Quotient in a loop, essentially divide divisor by 2 and subtract from Remainder
-  // Add multiple to Quotient
-  Int<S> Q = _0, R = N;
-  do
+  if (negative_dividend)
   {
-    if (R >= D)
-    {
-      R -= D;
-      Q += multiple;
-    }
-    D >>= 1;  // Divide by two.
-    multiple >>= 1;
-  } while (multiple != 0);
-
-  // Return the Quotient
-  *this = sign * Q;
-  return *this;
-}
+    remainder = -remainder;
+  }
 
-template <uint16_t S>
-constexpr Int<S> &Int<S>::operator%=(Int<S> const &n)
-{
-  Int<S> q = *this / n;
-  *this -= q * n;
-  return *this;
+  return quotient;
 }
 
 template <uint16_t S>
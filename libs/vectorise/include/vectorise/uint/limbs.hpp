@@ -0,0 +1,241 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/platform.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace fetch {
+namespace vectorise {
+namespace details {
+
+/* Fixed size limb arithmetic shared by the UInt and Int big numbers.
+ *
+ * Numbers are little endian arrays of 64-bit limbs. Products of two limbs are computed as 128-bit
+ * quantities, which compiles to a single mul/mulx instruction on x86-64 and mul/umulh on aarch64,
+ * and everything is constexpr so that constants can be computed at compile time.
+ */
+using Limb       = uint64_t;
+using DoubleLimb = uint128_t;
+
+constexpr std::size_t LIMB_BITS = 64;
+
+constexpr std::size_t SignificantLimbs(Limb const *a, std::size_t size)
+{
+  while ((size > 0) && (a[size - 1] == 0))
+  {
+    --size;
+  }
+
+  return size;
+}
+
+constexpr std::size_t LeadingZeroBits(Limb limb)
+{
+  return (limb == 0) ? LIMB_BITS : static_cast<std::size_t>(__builtin_clzll(limb));
+}
+
+/**
+ * Schoolbook product of two numbers, truncated to the size of the output
+ *
+ * @param a The first factor, of a_size limbs
+ * @param b The second factor, of b_size limbs
+ * @param out The product, of out_size limbs, must not alias the factors
+ */
+constexpr void MultiplyLimbs(Limb const *a, std::size_t a_size, Limb const *b, std::size_t b_size,
+                             Limb *out, std::size_t out_size)
+{
+  for (std::size_t i = 0; i < out_size; ++i)
+  {
+    out[i] = 0;
+  }
+
+  a_size = SignificantLimbs(a, a_size);
+  b_size = SignificantLimbs(b, b_size);
+
+  for (std::size_t i = 0; (i < a_size) && (i < out_size); ++i)
+  {
+    if (a[i] == 0)
+    {
+      continue;
+    }
+
+    Limb              carry = 0;
+    std::size_t const end   = (b_size < out_size - i) ? b_size : out_size - i;
+    for (std::size_t j = 0; j < end; ++j)
+    {
+      DoubleLimb const term = static_cast<DoubleLimb>(a[i]) * b[j] + out[i + j] + carry;
+
+      out[i + j] = static_cast<Limb>(term);
+      carry      = static_cast<Limb>(term >> LIMB_BITS);
+    }
+
+    if (i + end < out_size)
+    {
+      out[i + end] = carry;
+    }
+  }
+}
+
+/**
+ * Quotient and remainder of a division, using Knuth's algorithm D (TAOCP vol. 2, 4.3.1) with a
+ * single limb divisor fast path. Either output may be omitted.
+ *
+ * @tparam M The number of limbs of the dividend and the quotient
+ * @tparam N The number of limbs of the divisor and the remainder
+ * @param u The dividend
+ * @param v The divisor
+ * @param q The quotient or nullptr
+ * @param r The remainder or nullptr
+ */
+template <std::size_t M, std::size_t N>
+constexpr void DivideLimbs(Limb const *u, Limb const *v, Limb *q, Limb *r)
+{
+  std::size_t const n = SignificantLimbs(v, N);
+  std::size_t const m = SignificantLimbs(u, M);
+
+  if (n == 0)
+  {
+    throw std::runtime_error("division by zero!");
+  }
+
+  Limb quotient[M]  = {};
+  Limb remainder[N] = {};
+
+  if (m < n)
+  {
+    for (std::size_t i = 0; i < m; ++i)
+    {
+      remainder[i] = u[i];
+    }
+  }
+  else if (n == 1)
+  {
+    Limb rem = 0;
+    for (std::size_t i = m; i-- > 0;)
+    {
+      DoubleLimb const dividend = (static_cast<DoubleLimb>(rem) << LIMB_BITS) | u[i];
+
+      quotient[i] = static_cast<Limb>(dividend / v[0]);
+      rem         = static_cast<Limb>(dividend % v[0]);
+    }
+    remainder[0] = rem;
+  }
+  else
+  {
+    // normalise so that the top limb of the divisor has its most significant bit set, which
+    // bounds the error of every quotient limb estimate by two
+    std::size_t const shift = LeadingZeroBits(v[n - 1]);
+
+    Limb vn[N]     = {};
+    Limb un[M + 1] = {};
+
+    for (std::size_t i = n; i-- > 0;)
+    {
+      vn[i] = (v[i] << shift) | ((shift != 0 && i > 0) ? (v[i - 1] >> (LIMB_BITS - shift)) : 0);
+    }
+    un[m] = (shift != 0) ? (u[m - 1] >> (LIMB_BITS - shift)) : 0;
+    for (std::size_t i = m; i-- > 0;)
+    {
+      un[i] = (u[i] << shift) | ((shift != 0 && i > 0) ? (u[i - 1] >> (LIMB_BITS - shift)) : 0);
+    }
+
+    for (std::size_t j = m - n + 1; j-- > 0;)
+    {
+      DoubleLimb const top  = (static_cast<DoubleLimb>(un[j + n]) << LIMB_BITS) | un[j + n - 1];
+      DoubleLimb       qhat = top / vn[n - 1];
+      DoubleLimb       rhat = top % vn[n - 1];
+
+      while (((qhat >> LIMB_BITS) != 0) ||
+             (qhat * vn[n - 2] > ((rhat << LIMB_BITS) | un[j + n - 2])))
+      {
+        --qhat;
+        rhat += vn[n - 1];
+        if ((rhat >> LIMB_BITS) != 0)
+        {
+          break;
+        }
+      }
+
+      // multiply and subtract
+      Limb borrow = 0;
+      Limb carry  = 0;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        DoubleLimb const product = qhat * vn[i] + carry;
+        Limb const       low     = static_cast<Limb>(product);
+        Limb const       digit   = un[i + j];
+        Limb const       diff    = digit - low;
+
+        carry     = static_cast<Limb>(product >> LIMB_BITS);
+        un[i + j] = diff - borrow;
+        borrow    = ((digit < low) || (diff < borrow)) ? 1u : 0u;
+      }
+      bool const negative =
+          static_cast<DoubleLimb>(un[j + n]) < static_cast<DoubleLimb>(carry) + borrow;
+      un[j + n] -= carry + borrow;
+
+      quotient[j] = static_cast<Limb>(qhat);
+
+      // the estimate was one too large, add the divisor back
+      if (negative)
+      {
+        --quotient[j];
+
+        Limb add_carry = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          DoubleLimb const sum = static_cast<DoubleLimb>(un[i + j]) + vn[i] + add_carry;
+
+          un[i + j] = static_cast<Limb>(sum);
+          add_carry = static_cast<Limb>(sum >> LIMB_BITS);
+        }
+        un[j + n] += add_carry;
+      }
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      remainder[i] =
+          (un[i] >> shift) | ((shift != 0) ? (un[i + 1] << (LIMB_BITS - shift)) : Limb{0});
+    }
+  }
+
+  if (q != nullptr)
+  {
+    for (std::size_t i = 0; i < M; ++i)
+    {
+      q[i] = quotient[i];
+    }
+  }
+
+  if (r != nullptr)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      r[i] = remainder[i];
+    }
+  }
+}
+
+}  // namespace details
+}  // namespace vectorise
+}  // namespace fetch
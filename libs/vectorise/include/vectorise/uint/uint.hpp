@@ -21,6 +21,7 @@
 #include "meta/type_traits.hpp"
 #include "vectorise/containers/array.hpp"
 #include "vectorise/platform.hpp"
+#include "vectorise/uint/limbs.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -207,6 +208,14 @@ public:
   constexpr UInt &operator<<=(std::size_t bits);
   constexpr UInt &operator>>=(std::size_t bits);
 
+  //////////////////////////
+  /// modular arithmetic ///
+  //////////////////////////
+
+  constexpr UInt DivMod(UInt const &n, UInt &remainder) const;
+  constexpr UInt MulMod(UInt const &n, UInt const &modulus) const;
+  constexpr UInt PowMod(UInt const &exponent, UInt const &modulus) const;
+
   constexpr std::size_t msb() const;
   constexpr std::size_t lsb() const;
 
@@ -327,9 +336,14 @@ template <uint16_t S>
 template <typename T, meta::IfIsUnsignedInteger<T> *>
 constexpr UInt<S>::UInt(T number)
 {
-  // This will work properly only on LITTLE endian hardware.
-  auto *d                   = reinterpret_cast<char *>(wide_.data());
-  *reinterpret_cast<T *>(d) = number;
+  // split into limbs rather than copying the bytes, so that constants can be built at compile time
+  auto const value = static_cast<uint128_t>(number);
+
+  wide_[0] = static_cast<WideType>(value);
+  if ((WIDE_ELEMENTS > 1) && (sizeof(T) > sizeof(WideType)))
+  {
+    wide_[1] = static_cast<WideType>(value >> WIDE_ELEMENT_SIZE);
+  }
 }
 
 ////////////////////////////
@@ -339,7 +353,13 @@ constexpr UInt<S>::UInt(T number)
 template <uint16_t S>
 constexpr UInt<S> &UInt<S>::operator=(UInt const &v)
 {
-  std::copy(v.pointer(), v.pointer() + ELEMENTS, base());
+  // limb by limb, leaving the residual bits of the last limb untouched like a copy of the bytes
+  for (std::size_t i = 0; i + 1 < WIDE_ELEMENTS; ++i)
+  {
+    wide_[i] = v.wide_[i];
+  }
+  wide_[WIDE_ELEMENTS - 1] = (wide_[WIDE_ELEMENTS - 1] & ~RESIDUAL_BITS_MASK) |
+                             (v.wide_[WIDE_ELEMENTS - 1] & RESIDUAL_BITS_MASK);
   return *this;
 }
 
@@ -665,53 +685,18 @@ constexpr UInt<S> &UInt<S>::operator-=(UInt const &n)
   return *this;
 }
 
-// Implementation for 256-bits only
-template <>
-constexpr UInt<256> &UInt<256>::operator*=(UInt<256> const &n)
+template <uint16_t S>
+constexpr UInt<S> &UInt<S>::operator*=(UInt const &n)
 {
-  // Calculate all products between each uint64_t element in the UInts
-  // Use int128_t type to hold the actual product.
-  __uint128_t products[WIDE_ELEMENTS][WIDE_ELEMENTS] = {};
+  WideType product[WIDE_ELEMENTS] = {};
+  details::MultiplyLimbs(wide_.data(), WIDE_ELEMENTS, n.wide_.data(), WIDE_ELEMENTS, product,
+                         WIDE_ELEMENTS);
 
   for (std::size_t i = 0; i < WIDE_ELEMENTS; ++i)
   {
-    for (std::size_t j = 0; j < WIDE_ELEMENTS; ++j)
-    {
-      // Note: C++14 does not have constexpr std::array, we need to cast the array
-      products[i][j] =
-          static_cast<__uint128_t>(wide_[i]) * static_cast<__uint128_t>(n.ElementAt(j));
-    }
-  }
-
-  /* If a, b, two UInt<256> numbers, with the following elements (little endian order):
-   * |  a[3]  |  a[2]  |  a[1]  |  a[0]  |
-   * |  b[3]  |  b[2]  |  b[1]  |  b[0]  |
-   * Then both can be written in the following form:
-   * a = a[0] + (a[1] << 64) + (a[2] << 128) + (a[3] << 192)
-   * b = b[0] + (b[1] << 64) + (b[2] << 128) + (b[3] << 192)
-   *
-   * Then a * b is the following, truncating terms left shifted over 192 bits:
-   * a * b =  a[0] * b[0]
-   *       + (a[0] * b[1] + a[1] * b[0]) << 64
-   *       + (a[0] * b[2] + a[1] * b[1] + a[2] * b[0]) << 128
-   *       + (a[0] * b[3] + a[1] * b[2] + a[2] * b[1] + a[3] * b[0]) << 192
-   * In order to be accurate, we calculate these terms as 128-bit quantities and we add the
-   * high-64-bits as carry to the next term
-   */
-
-  __uint128_t carry = 0, terms[WIDE_ELEMENTS] = {};
-  terms[0] = products[0][0];
-  carry    = static_cast<WideType>(terms[0] >> WIDE_ELEMENT_SIZE);
-  terms[1] = products[0][1] + products[1][0] + carry;
-  carry    = static_cast<WideType>(terms[1] >> WIDE_ELEMENT_SIZE);
-  terms[2] = products[0][2] + products[1][1] + products[2][0] + carry;
-  carry    = static_cast<WideType>(terms[2] >> WIDE_ELEMENT_SIZE);
-  terms[3] = products[0][3] + products[1][2] + products[2][1] + products[3][0] + carry;
-
-  for (std::size_t i = 0; i < WIDE_ELEMENTS; ++i)
-  {
-    wide_[i] = static_cast<WideType>(terms[i]);
+    wide_[i] = product[i];
   }
+  mask_residual_bits();
 
   return *this;
 }
@@ -719,59 +704,8 @@ constexpr UInt<256> &UInt<256>::operator*=(UInt<256> const &n)
 template <uint16_t S>
 constexpr UInt<S> &UInt<S>::operator/=(UInt<S> const &n)
 {
-  if (n == _0)
-  {
-    throw std::runtime_error("division by zero!");
-  }
-  if (n == _1)
-  {
-    return *this;
-  }
-  if (*this == n)
-  {
-    *this = _1;
-    return *this;
-  }
-  if (*this == _0)
-  {
-    return *this;
-  }
-  // No fractions supported, if *this < n return 0
-  if (*this < n)
-  {
-    *this = _0;
-    return *this;
-  }
-
-  // Actual integer division algorithm
-  // First simplify dividend/divisor by shifting right by min LSB bit
-  // Essentially divide both by 2 as long as the LSB is zero
-  UInt        N{*this}, D{n};
-  std::size_t lsb = std::min(N.lsb(), D.lsb());
-  N >>= lsb;
-  D >>= lsb;
-  UInt multiple(1u);
-
-  auto const D_leading_zero_bits{D.UINT_SIZE - D.msb() - 1};
-  // Find smallest multiple of divisor (D) that is larger than the dividend (N)
-  D <<= D_leading_zero_bits;
-  multiple <<= D_leading_zero_bits;
-
-  // Calculate Quotient in a loop, essentially divide divisor by 2 and subtract from Remainder
-  // Add multiple to Quotient
-  UInt Q = _0, R = N;
-  do
-  {
-    if (R >= D)
-    {
-      R -= D;
-      Q += multiple;
-    }
-    D >>= 1;  // Divide by two.
-    multiple >>= 1;
-  } while (multiple != UInt::_0);
-  // Return the Quotient
-  *this = Q;
+  UInt remainder{};
+  *this = DivMod(n, remainder);
 
   return *this;
 }
@@ -779,8 +713,8 @@ constexpr UInt<S> &UInt<S>::operator/=(UInt<S> const &n)
 template <uint16_t S>
 constexpr UInt<S> &UInt<S>::operator%=(UInt const &n)
 {
-  UInt q = *this / n;
-  *this -= q * n;
+  DivMod(n, *this);
+
   return *this;
 }
 
@@ -1050,6 +984,97 @@ constexpr UInt<S> &UInt<S>::operator>>=(std::size_t bits)
   return *this;
 }
 
+/**
+ * Divide by a number, obtaining the quotient and remainder of the division at once
+ *
+ * @param n The divisor
+ * @param remainder Set to the remainder of the division
+ * @return The quotient of the division
+ */
+template <uint16_t S>
+constexpr UInt<S> UInt<S>::DivMod(UInt const &n, UInt &remainder) const
+{
+  UInt dividend{*this};
+  UInt divisor{n};
+  dividend.mask_residual_bits();
+  divisor.mask_residual_bits();
+
+  UInt quotient{};
+  details::DivideLimbs<WIDE_ELEMENTS, WIDE_ELEMENTS>(dividend.wide_.data(), divisor.wide_.data(),
+                                                     quotient.wide_.data(),
+                                                     remainder.wide_.data());
+
+  return quotient;
+}
+
+/**
+ * Multiply by a number modulo another, without overflowing the size of the number
+ *
+ * @param n The factor
+ * @param modulus The modulus
+ * @return The product of this number and the factor, modulo the modulus
+ */
+template <uint16_t S>
+constexpr UInt<S> UInt<S>::MulMod(UInt const &n, UInt const &modulus) const
+{
+  UInt a{*this};
+  UInt b{n};
+  UInt m{modulus};
+  a.mask_residual_bits();
+  b.mask_residual_bits();
+  m.mask_residual_bits();
+
+  WideType product[2 * WIDE_ELEMENTS] = {};
+  details::MultiplyLimbs(a.wide_.data(), WIDE_ELEMENTS, b.wide_.data(), WIDE_ELEMENTS, product,
+                         2 * WIDE_ELEMENTS);
+
+  UInt remainder{};
+  details::DivideLimbs<2 * WIDE_ELEMENTS, WIDE_ELEMENTS>(product, m.wide_.data(), nullptr,
+                                                         remainder.wide_.data());
+
+  return remainder;
+}
+
+/**
+ * Raise to a power modulo a number, by square and multiply
+ *
+ * @param exponent The exponent
+ * @param modulus The modulus
+ * @return This number to the power of the exponent, modulo the modulus
+ */
+template <uint16_t S>
+constexpr UInt<S> UInt<S>::PowMod(UInt const &exponent, UInt const &modulus) const
+{
+  UInt result{};
+  UInt base{};
+  UInt{1u}.DivMod(modulus, result);
+  DivMod(modulus, base);
+
+  UInt e{exponent};
+  e.mask_residual_bits();
+
+  auto const limbs = details::SignificantLimbs(e.wide_.data(), WIDE_ELEMENTS);
+  for (std::size_t i = 0; i < limbs; ++i)
+  {
+    WideType bits = e.wide_[i];
+    for (std::size_t j = 0; j < WIDE_ELEMENT_SIZE; ++j, bits >>= 1u)
+    {
+      if ((bits == 0) && (i + 1 == limbs))
+      {
+        break;
+      }
+
+      if ((bits & 1u) != 0)
+      {
+        result = result.MulMod(base, modulus);
+      }
+      base = base.MulMod(base, modulus);
+    }
+  }
+
+  return result;
+}
+
 template <uint16_t S>
 constexpr std::size_t UInt<S>::msb() const
 {
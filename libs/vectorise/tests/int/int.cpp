@@ -228,6 +228,81 @@ TEST(Int_gtest, division_tests)
   EXPECT_EQ(n4.ElementAt(3), 0);
 }
 
+TEST(Int_gtest, signed_division_tests)
+{
+  Int<256> const seven{int64_t{7}};
+  Int<256> const two{int64_t{2}};
+
+  EXPECT_EQ(seven / two, Int<256>{int64_t{3}});
+  EXPECT_EQ(-seven / two, Int<256>{int64_t{-3}});
+  EXPECT_EQ(seven / -two, Int<256>{int64_t{-3}});
+  EXPECT_EQ(-seven / -two, Int<256>{int64_t{3}});
+
+  // the remainder has the sign of the dividend
+  EXPECT_EQ(seven % two, Int<256>{int64_t{1}});
+  EXPECT_EQ(-seven % two, Int<256>{int64_t{-1}});
+  EXPECT_EQ(seven % -two, Int<256>{int64_t{1}});
+  EXPECT_EQ(-seven % -two, Int<256>{int64_t{-1}});
+
+  EXPECT_THROW(seven / Int<256>::_0, std::runtime_error);
+}
+
+TEST(Int_gtest, signed_multiplication_tests)
+{
+  Int<256> n1;
+  n1.ElementAt(0) = 0x72f4a7ca9e22b75b;
+  n1.ElementAt(1) = 0x00000001264eb563;
+  Int<256> n2{int64_t{-3}};
+
+  Int<256> product = n1 * n2;
+  EXPECT_LT(product, Int<256>::_0);
+  EXPECT_EQ(-product, n1 * Int<256>{int64_t{3}});
+  EXPECT_EQ(product / n2, n1);
+  EXPECT_EQ(product / n1, n2);
+  EXPECT_EQ(product % n1, Int<256>::_0);
+
+  Int<512> n3{int64_t{-5}};
+  n3 <<= 200;
+  EXPECT_EQ((n3 * n3) >> 400, Int<512>{int64_t{25}});
+}
+
+TEST(Int_gtest, multiplication_carry_regression_test)
+{
+  // (2^128 - 1) * (2^127 - 1) = 2^255 - 2^128 - 2^127 + 1. The sum of the cross products of the
+  // lower limbs overflows 128 bits, and the unrolled implementation used to lose its carry.
+  Int<256> n1;
+  n1.ElementAt(0) = 0xffffffffffffffff;
+  n1.ElementAt(1) = 0xffffffffffffffff;
+  Int<256> n2;
+  n2.ElementAt(0) = 0xffffffffffffffff;
+  n2.ElementAt(1) = 0x7fffffffffffffff;
+
+  Int<256> n3 = n1 * n2;
+  EXPECT_EQ(n3.ElementAt(0), 0x0000000000000001);
+  EXPECT_EQ(n3.ElementAt(1), 0x8000000000000000);
+  EXPECT_EQ(n3.ElementAt(2), 0xfffffffffffffffe);
+  EXPECT_EQ(n3.ElementAt(3), 0x7fffffffffffffff);
+  EXPECT_EQ(-n1 * n2, -n3);
+}
+
+TEST(Int_gtest, division_regression_test)
+{
+  // the shift and subtract implementation used to shift the divisor into the sign bit and never
+  // terminate
+  Int<256> n1;
+  n1.ElementAt(0) = 0xffffffffffffffff;
+  n1.ElementAt(1) = 0xffffffffffffffff;
+  n1.ElementAt(2) = 0xffffffffffffffff;
+  n1.ElementAt(3) = 0x7fffffffffffffff;
+
+  Int<256> quotient = n1 / Int<256>{int64_t{3}};
+  EXPECT_EQ(quotient.ElementAt(0), 0xaaaaaaaaaaaaaaaa);
+  EXPECT_EQ(quotient.ElementAt(1), 0xaaaaaaaaaaaaaaaa);
+  EXPECT_EQ(quotient.ElementAt(2), 0xaaaaaaaaaaaaaaaa);
+  EXPECT_EQ(quotient.ElementAt(3), 0x2aaaaaaaaaaaaaaa);
+  EXPECT_EQ(n1 % Int<256>{int64_t{3}}, Int<256>{int64_t{1}});
+}
+
 TEST(Int_gtest, msb_lsb_tests)
 {
   Int<256> n1;
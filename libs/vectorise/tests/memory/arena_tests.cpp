@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/memory/arena.hpp"
+#include "vectorise/memory/shared_array.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::memory::Arena;
+using fetch::memory::ArenaScope;
+using fetch::memory::SharedArray;
+
+TEST(ArenaTests, ArraysAreOnlyServedWhileScopeIsActive)
+{
+  Arena arena{};
+  EXPECT_EQ(Arena::Current(), nullptr);
+
+  {
+    ArenaScope scope{arena};
+    EXPECT_EQ(Arena::Current(), &arena);
+
+    SharedArray<uint8_t> array(32);
+    EXPECT_EQ(arena.allocations(), 1u);
+    EXPECT_EQ(arena.chunks(), 1u);
+  }
+
+  EXPECT_EQ(Arena::Current(), nullptr);
+
+  SharedArray<uint8_t> array(32);
+  EXPECT_EQ(arena.allocations(), 1u);
+}
+
+TEST(ArenaTests, ScopesNest)
+{
+  Arena outer{};
+  Arena inner{};
+
+  ArenaScope outer_scope{outer};
+  {
+    ArenaScope inner_scope{inner};
+    EXPECT_EQ(Arena::Current(), &inner);
+  }
+
+  EXPECT_EQ(Arena::Current(), &outer);
+}
+
+TEST(ArenaTests, LargeArraysUseTheRegularAllocator)
+{
+  Arena      arena{1024};
+  ArenaScope scope{arena};
+
+  SharedArray<uint8_t> array(1024);
+  EXPECT_EQ(arena.allocations(), 0u);
+  EXPECT_EQ(arena.chunks(), 0u);
+}
+
+TEST(ArenaTests, ArraysOutliveTheArena)
+{
+  std::vector<SharedArray<uint64_t>> arrays{};
+
+  {
+    Arena      arena{1024};
+    ArenaScope scope{arena};
+
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+      SharedArray<uint64_t> array(4);
+      array[0] = i;
+      arrays.push_back(array);
+    }
+
+    EXPECT_EQ(arena.allocations(), 100u);
+    EXPECT_GT(arena.chunks(), 1u);
+  }
+
+  for (uint64_t i = 0; i < 100; ++i)
+  {
+    EXPECT_EQ(arrays[i][0], i);
+  }
+}
+
+}  // namespace
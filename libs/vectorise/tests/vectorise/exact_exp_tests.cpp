@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/math/exact_exp.hpp"
+#include "vectorise/memory/shared_array.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fetch::fixed_point::fp32_t;
+using fetch::fixed_point::fp64_t;
+
+template <typename T>
+class ExactExpTests : public ::testing::Test
+{
+};
+
+using ExactExpTypes = ::testing::Types<fp32_t, fp64_t>;
+TYPED_TEST_CASE(ExactExpTests, ExactExpTypes);
+
+template <typename T>
+std::vector<T> GenerateInputs()
+{
+  std::vector<T> values{T::_0,
+                        T::_1,
+                        -T::_1,
+                        T::_half,
+                        T::MIN_EXP,
+                        T::MAX_EXP,
+                        -T::MAX_EXP,
+                        T::MIN_EXP - T::CONST_SMALLEST_FRACTION,
+                        T::MAX_EXP + T::CONST_SMALLEST_FRACTION,
+                        -T::MIN_EXP,
+                        T::CONST_SMALLEST_FRACTION - T::MIN_EXP,
+                        T::CONST_SMALLEST_FRACTION,
+                        -T::CONST_SMALLEST_FRACTION,
+                        T::FP_MAX,
+                        T::FP_MIN,
+                        T::NaN,
+                        T::POSITIVE_INFINITY,
+                        T::NEGATIVE_INFINITY};
+
+  // a dense sweep of the interesting range and a random sample of the raw representation
+  for (T x = T{-12}; x < T{12}; x += T::FromBase(T::ONE_MASK / 64 + 1))
+  {
+    values.push_back(x);
+  }
+
+  std::mt19937_64 rng{42};
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    values.push_back(T::FromBase(static_cast<typename T::Type>(rng())));
+  }
+
+  return values;
+}
+
+template <typename T, typename Kernel, typename Reference>
+void CheckBitIdentical(Kernel const &kernel, Reference const &reference)
+{
+  static constexpr std::size_t NUM_LANES = 8;
+
+  auto const inputs = GenerateInputs<T>();
+
+  // the same value in every lane, so that the fp_state flags can be compared as well
+  fetch::memory::SharedArray<T> lanes(NUM_LANES);
+  fetch::memory::SharedArray<T> out(NUM_LANES);
+  for (auto const &input : inputs)
+  {
+    T::fp_state          = 0;
+    T const  expected    = reference(input);
+    uint32_t expected_fp = T::fp_state;
+
+    for (std::size_t j = 0; j < NUM_LANES; ++j)
+    {
+      lanes[j] = input;
+    }
+
+    T::fp_state = 0;
+    out.in_parallel().Apply(Kernel{kernel}, lanes);
+
+    for (std::size_t j = 0; j < NUM_LANES; ++j)
+    {
+      ASSERT_EQ(out[j].Data(), expected.Data()) << "input: " << input;
+    }
+    EXPECT_EQ(T::fp_state, expected_fp) << "input: " << input;
+  }
+
+  // all of the inputs at once, mixing special and regular values within the registers
+  fetch::memory::SharedArray<T> x(inputs.size());
+  fetch::memory::SharedArray<T> y(inputs.size());
+  for (std::size_t i = 0; i < inputs.size(); ++i)
+  {
+    x[i] = inputs[i];
+  }
+
+  y.in_parallel().Apply(Kernel{kernel}, x);
+  for (std::size_t i = 0; i < inputs.size(); ++i)
+  {
+    EXPECT_EQ(y[i].Data(), reference(inputs[i]).Data()) << "input: " << inputs[i];
+  }
+
+  T::fp_state = 0;
+}
+
+TYPED_TEST(ExactExpTests, exp_is_bit_identical_to_scalar)
+{
+  CheckBitIdentical<TypeParam>(
+      [](auto const &x, auto &y) { y = fetch::vectorise::exact_exp(x); },
+      [](TypeParam const &x) { return TypeParam::Exp(x); });
+}
+
+TYPED_TEST(ExactExpTests, sigmoid_is_bit_identical_to_scalar)
+{
+  CheckBitIdentical<TypeParam>(
+      [](auto const &x, auto &y) { y = fetch::vectorise::exact_sigmoid(x); },
+      [](TypeParam const &x) {
+        TypeParam const one{1};
+
+        if (x >= TypeParam{0})
+        {
+          return one / (TypeParam::Exp(TypeParam{-1} * x) + one);
+        }
+
+        TypeParam const e = TypeParam::Exp(x);
+        return e / (e + one);
+      });
+}
+
+TYPED_TEST(ExactExpTests, tanh_is_bit_identical_to_scalar)
+{
+  CheckBitIdentical<TypeParam>(
+      [](auto const &x, auto &y) { y = fetch::vectorise::exact_tanh(x); },
+      [](TypeParam const &x) { return TypeParam::TanH(x); });
+}
+
+TYPED_TEST(ExactExpTests, cube_is_bit_identical_to_scalar)
+{
+  CheckBitIdentical<TypeParam>(
+      [](auto const &x, auto &y) { y = fetch::vectorise::exact_cube(x); },
+      [](TypeParam const &x) { return TypeParam::Pow(x, TypeParam{3}); });
+}
+
+}  // namespace
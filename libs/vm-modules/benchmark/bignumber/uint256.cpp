@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/object.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/math/bignumber.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+// The benchmarks in this file measure the Etch UInt256 opcodes. The argument is the number of
+// significant 64-bit limbs of the right hand side operand, the left hand side always uses all four
+// limbs, so that the division benchmarks cover every divisor length.
+
+using namespace fetch::vm;
+
+namespace {
+
+using fetch::vm_modules::VMFactory;
+using fetch::vm_modules::math::UInt256Wrapper;
+
+using UInt256   = UInt256Wrapper::UInt256;
+using VMPtr     = std::shared_ptr<VM>;
+using Operation = std::function<void(Ptr<Object> &, Ptr<Object> &)>;
+
+VMPtr CreateVM()
+{
+  static auto const module = VMFactory::GetModule(VMFactory::USE_ALL);
+  return std::make_shared<VM>(module.get());
+}
+
+UInt256 MakeNumber(std::size_t limbs, uint64_t seed)
+{
+  UInt256 number{};
+  for (std::size_t i = 0; i < limbs; ++i)
+  {
+    seed ^= seed << 13u;
+    seed ^= seed >> 7u;
+    seed ^= seed << 17u;
+    number.ElementAt(i) = seed;
+  }
+
+  return number;
+}
+
+void RunOpcode(::benchmark::State &state, Operation const &operation)
+{
+  auto vm  = CreateVM();
+  auto lhs = vm->CreateNewObject<UInt256Wrapper>(MakeNumber(UInt256::WIDE_ELEMENTS, 0x1234567u));
+  auto rhs = vm->CreateNewObject<UInt256Wrapper>(
+      MakeNumber(static_cast<std::size_t>(state.range(0)), 0x89abcdefu));
+
+  for (auto _ : state)
+  {
+    // the operands are held here as well, as they would be by variables of a contract, so the
+    // binary opcodes allocate their result rather than reusing a temporary
+    Ptr<Object> lhso = lhs;
+    Ptr<Object> rhso = rhs;
+    operation(lhso, rhso);
+    ::benchmark::DoNotOptimize(lhso);
+  }
+}
+
+void BM_Add(::benchmark::State &state)
+{
+  RunOpcode(state, [](Ptr<Object> &lhso, Ptr<Object> &rhso) { lhso->Add(lhso, rhso); });
+}
+
+void BM_Subtract(::benchmark::State &state)
+{
+  RunOpcode(state, [](Ptr<Object> &lhso, Ptr<Object> &rhso) { lhso->Subtract(lhso, rhso); });
+}
+
+void BM_Multiply(::benchmark::State &state)
+{
+  RunOpcode(state, [](Ptr<Object> &lhso, Ptr<Object> &rhso) { lhso->Multiply(lhso, rhso); });
+}
+
+void BM_Divide(::benchmark::State &state)
+{
+  RunOpcode(state, [](Ptr<Object> &lhso, Ptr<Object> &rhso) { lhso->Divide(lhso, rhso); });
+}
+
+void BM_IsLessThan(::benchmark::State &state)
+{
+  RunOpcode(state, [](Ptr<Object> &lhso, Ptr<Object> &rhso) {
+    ::benchmark::DoNotOptimize(lhso->IsLessThan(lhso, rhso));
+  });
+}
+
+// the in place opcodes accumulate into the left hand side, an odd right hand side keeps the
+// product from ever becoming zero
+void RunInplaceOpcode(::benchmark::State &state, Operation const &operation)
+{
+  auto vm     = CreateVM();
+  auto number = MakeNumber(static_cast<std::size_t>(state.range(0)), 0x89abcdefu);
+  number.ElementAt(0) |= 1u;
+
+  Ptr<Object> lhso = vm->CreateNewObject<UInt256Wrapper>(
+      MakeNumber(UInt256::WIDE_ELEMENTS, 0x1234567u));
+  Ptr<Object> rhso = vm->CreateNewObject<UInt256Wrapper>(number);
+
+  for (auto _ : state)
+  {
+    operation(lhso, rhso);
+  }
+}
+
+void BM_InplaceAdd(::benchmark::State &state)
+{
+  RunInplaceOpcode(state,
+                   [](Ptr<Object> &lhso, Ptr<Object> &rhso) { lhso->InplaceAdd(lhso, rhso); });
+}
+
+void BM_InplaceMultiply(::benchmark::State &state)
+{
+  RunInplaceOpcode(state, [](Ptr<Object> &lhso, Ptr<Object> &rhso) {
+    lhso->InplaceMultiply(lhso, rhso);
+  });
+}
+
+void OperandLimbs(::benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->DenseRange(1, UInt256::WIDE_ELEMENTS);
+}
+
+}  // namespace
+
+BENCHMARK(BM_Add)->Apply(OperandLimbs);
+BENCHMARK(BM_Subtract)->Apply(OperandLimbs);
+BENCHMARK(BM_Multiply)->Apply(OperandLimbs);
+BENCHMARK(BM_Divide)->Apply(OperandLimbs);
+BENCHMARK(BM_IsLessThan)->Apply(OperandLimbs);
+BENCHMARK(BM_InplaceAdd)->Apply(OperandLimbs);
+BENCHMARK(BM_InplaceMultiply)->Apply(OperandLimbs);
@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "vm/object.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/math/tensor/tensor.hpp"
+#include "vm_modules/math/tensor/tensor_estimator.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// The benchmarks in this file measure the time taken by a tensor operation and report the charge
+// that the estimator assigns to it. The "charge_rate" counter is the number of units of charge
+// executed per second: for well calibrated estimates it is (roughly) the same for every
+// operation and every shape, so the outliers identify the coefficients which need to be adjusted.
+
+using namespace fetch::vm;
+
+namespace {
+
+using fetch::vm_modules::VMFactory;
+using fetch::vm_modules::math::DataType;
+using fetch::vm_modules::math::TensorEstimator;
+using fetch::vm_modules::math::VMTensor;
+
+using SizeType   = fetch::math::SizeType;
+using SizeVector = std::vector<SizeType>;
+using VMPtr      = std::shared_ptr<VM>;
+using Estimate   = std::function<ChargeAmount(Ptr<VMTensor> const &, Ptr<VMTensor> const &)>;
+using Operation  = std::function<void(Ptr<VMTensor> const &, Ptr<VMTensor> const &)>;
+
+VMPtr CreateVM()
+{
+  static auto const module = VMFactory::GetModule(VMFactory::USE_ALL);
+  return std::make_shared<VM>(module.get());
+}
+
+SizeVector ShapeFromState(::benchmark::State const &state)
+{
+  return {static_cast<SizeType>(state.range(0)), static_cast<SizeType>(state.range(1))};
+}
+
+void RunCalibration(::benchmark::State &state, Estimate const &estimate,
+                    Operation const &operation)
+{
+  auto       vm    = CreateVM();
+  auto const shape = ShapeFromState(state);
+
+  auto lhs = vm->CreateNewObject<VMTensor>(shape);
+  auto rhs = vm->CreateNewObject<VMTensor>(SizeVector{shape.at(1), shape.at(0)});
+  lhs->FillRandom();
+  rhs->FillRandom();
+
+  auto const charge = static_cast<double>(estimate(lhs, rhs));
+
+  for (auto _ : state)
+  {
+    operation(lhs, rhs);
+  }
+
+  state.counters["charge"] = charge;
+  state.counters["charge_rate"] =
+      ::benchmark::Counter(charge, ::benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_CalibrateFill(::benchmark::State &state)
+{
+  DataType const value{1};
+
+  RunCalibration(
+      state,
+      [&value](Ptr<VMTensor> const &lhs, Ptr<VMTensor> const &) {
+        return lhs->Estimator().Fill(value);
+      },
+      [&value](Ptr<VMTensor> const &lhs, Ptr<VMTensor> const &) { lhs->Fill(value); });
+}
+
+void BM_CalibrateSum(::benchmark::State &state)
+{
+  RunCalibration(
+      state,
+      [](Ptr<VMTensor> const &lhs, Ptr<VMTensor> const &) { return lhs->Estimator().Sum(); },
+      [](Ptr<VMTensor> const &lhs, Ptr<VMTensor> const &) {
+        ::benchmark::DoNotOptimize(lhs->Sum());
+      });
+}
+
+void BM_CalibrateCopy(::benchmark::State &state)
+{
+  RunCalibration(
+      state,
+      [](Ptr<VMTensor> const &lhs, Ptr<VMTensor> const &) { return lhs->Estimator().Copy(); },
+      [](Ptr<VMTensor> const &lhs, Ptr<VMTensor> const &) {
+        ::benchmark::DoNotOptimize(lhs->Copy());
+      });
+}
+
+void BM_CalibrateInplaceAdd(::benchmark::State &state)
+{
+  RunCalibration(
+      state,
+      [](Ptr<VMTensor> const &lhs, Ptr<VMTensor> const &) {
+        Ptr<Object> operand = lhs;
+        return lhs->Estimator().InplaceAddChargeEstimator(operand, operand);
+      },
+      [](Ptr<VMTensor> const &lhs, Ptr<VMTensor> const &) {
+        Ptr<Object> operand = lhs;
+        lhs->InplaceAdd(operand, operand);
+      });
+}
+
+void BM_CalibrateDot(::benchmark::State &state)
+{
+  RunCalibration(
+      state,
+      [](Ptr<VMTensor> const &lhs, Ptr<VMTensor> const &rhs) {
+        return lhs->Estimator().Dot(rhs);
+      },
+      [](Ptr<VMTensor> const &lhs, Ptr<VMTensor> const &rhs) {
+        ::benchmark::DoNotOptimize(lhs->Dot(rhs));
+      });
+}
+
+// The cost of the estimate itself, which is paid on every call to the (memoised) estimator
+void BM_EstimateSum(::benchmark::State &state)
+{
+  auto vm     = CreateVM();
+  auto tensor = vm->CreateNewObject<VMTensor>(ShapeFromState(state));
+
+  for (auto _ : state)
+  {
+    ::benchmark::DoNotOptimize(tensor->Estimator().Sum());
+  }
+}
+
+void CalibrationShapes(::benchmark::internal::Benchmark *benchmark)
+{
+  for (int64_t rows : {1, 10, 100, 1000})
+  {
+    for (int64_t columns : {1, 10, 100, 1000})
+    {
+      benchmark->Args({rows, columns});
+    }
+  }
+
+  benchmark->Unit(::benchmark::kMicrosecond);
+}
+
+// The cost of a product grows with the cube of the dimensions, so these shapes are kept smaller
+void DotShapes(::benchmark::internal::Benchmark *benchmark)
+{
+  for (int64_t rows : {1, 10, 100})
+  {
+    for (int64_t columns : {1, 10, 100, 1000})
+    {
+      benchmark->Args({rows, columns});
+    }
+  }
+
+  benchmark->Unit(::benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+BENCHMARK(BM_CalibrateFill)->Apply(CalibrationShapes);
+BENCHMARK(BM_CalibrateSum)->Apply(CalibrationShapes);
+BENCHMARK(BM_CalibrateCopy)->Apply(CalibrationShapes);
+BENCHMARK(BM_CalibrateInplaceAdd)->Apply(CalibrationShapes);
+BENCHMARK(BM_CalibrateDot)->Apply(DotShapes);
+BENCHMARK(BM_EstimateSum)->Args({100, 100})->Args({1000, 1000});
@@ -2573,6 +2573,34 @@ BENCHMARK(BM_Copy)->Args({5, 1, 1, 1000000, 1, 1})->Unit(::benchmark::kMicroseco
 BENCHMARK(BM_Copy)->Args({5, 1, 1, 1, 1000000, 1})->Unit(::benchmark::kMicrosecond);
 BENCHMARK(BM_Copy)->Args({5, 1, 1, 1, 1, 1000000})->Unit(::benchmark::kMicrosecond);
 
+void BM_CopyAndFill(::benchmark::State &state)
+{
+  using VMPtr    = std::shared_ptr<VM>;
+  using DataType = fetch::vm_modules::math::DataType;
+
+  // Get args form state
+  BM_Tensor_config config{state};
+
+  state.counters["Size"] =
+      static_cast<double>(fetch::math::Tensor<float>::SizeFromShape(config.shape));
+
+  VMPtr vm;
+  SetUp(vm);
+
+  auto data = CreateTensor(vm, config.shape);
+
+  // copies share their data until they are written to, which is when the data gets copied
+  for (auto _ : state)
+  {
+    data->Copy()->Fill(DataType{1});
+  }
+}
+
+BENCHMARK(BM_CopyAndFill)->Args({1, 100000})->Unit(::benchmark::kMicrosecond);
+BENCHMARK(BM_CopyAndFill)->Args({2, 1000, 1000})->Unit(::benchmark::kMicrosecond);
+BENCHMARK(BM_CopyAndFill)->Args({3, 100, 100, 100})->Unit(::benchmark::kMicrosecond);
+BENCHMARK(BM_CopyAndFill)->Args({2, 1, 1000000})->Unit(::benchmark::kMicrosecond);
+
 }  // namespace tensor
 }  // namespace ml
 }  // namespace benchmark
@@ -182,7 +182,7 @@ public:
 
   TensorType &GetTensor();
 
-  TensorType const &GetConstTensor();
+  TensorType const &GetConstTensor() const;
 
   bool SerializeTo(serializers::MsgPackSerializer &buffer) override;
 
@@ -22,6 +22,9 @@
 #include "vm/object.hpp"
 #include "vm_modules/math/type.hpp"
 
+#include <array>
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -268,13 +271,54 @@ public:
   static constexpr SizeType LOW_CHARGE_CONST_COEF = 5;
 
 private:
+  /// The charges which depend only on the shape of the tensor, and can therefore be memoised
+  enum class Charge : uint8_t
+  {
+    COPY,
+    FILL,
+    FILL_RANDOM,
+    MIN,
+    MAX,
+    SUM,
+    ARGMAX_FIRST,
+    ARGMAX_MID,
+    ARGMAX_LAST,
+    NEGATE,
+    IS_EQUAL,
+    IS_NOT_EQUAL,
+    ADD,
+    SUBTRACT,
+    INPLACE_ADD,
+    INPLACE_SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    INPLACE_MULTIPLY,
+    INPLACE_DIVIDE,
+    TO_STRING,
+    NUM_CHARGES,
+  };
+
+  static constexpr std::size_t NUM_CHARGES = static_cast<std::size_t>(Charge::NUM_CHARGES);
+
+  using Charges    = std::array<ChargeAmount, NUM_CHARGES>;
+  using ChargeMask = std::bitset<NUM_CHARGES>;
+
   static ChargeAmount const LOW_CHARGE{LOW_CHARGE_CONST_COEF * fetch::vm::COMPUTE_CHARGE_COST};
 
   static ChargeAmount MaximumCharge(std::string const &log_msg = "");
 
   static ChargeAmount ToChargeAmount(fixed_point::fp64_t const &val);
 
+  template <typename Estimate>
+  ChargeAmount Memoise(Charge charge, Estimate &&estimate);
+  ChargeAmount ShapeCharge(Charge charge, fixed_point::fp64_t const &padded_size_coef,
+                           fixed_point::fp64_t const &size_coef,
+                           fixed_point::fp64_t const &const_coef);
+
   VMObjectType &tensor_;
+  SizeVector    memo_shape_{};    ///< The shape for which the memoised charges were estimated
+  Charges       memo_charges_{};  ///< The memoised charges
+  ChargeMask    memo_valid_{};    ///< The memoised charges which have been estimated
 };
 
 }  // namespace math
@@ -72,12 +72,13 @@ public:
    * @param: module The module which the user might have added various bindings/classes to etc.
    * @param: files The raw source to compile
    * @param: executable executable to fill
+   * @param: optimise Flag to signal that the optimisation pass should be run over the executable
    *
    * @return: Vector of strings which represent errors found during compilation
    */
   static std::vector<std::string> Compile(std::shared_ptr<fetch::vm::Module> const &module,
-                                          fetch::vm::SourceFiles const &            files,
-                                          fetch::vm::Executable &                   executable);
+                                          fetch::vm::SourceFiles const &files,
+                                          fetch::vm::Executable &executable, bool optimise = false);
 };
 
 }  // namespace vm_modules
@@ -24,6 +24,8 @@
 #include "vm_modules/core/byte_array_wrapper.hpp"
 #include "vm_modules/math/bignumber.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 #include <utility>
@@ -36,6 +38,99 @@ using namespace fetch::vm;
 
 namespace {
 
+using UInt256  = UInt256Wrapper::UInt256;
+using WideType = UInt256::WideType;
+
+/**
+ * The multiplication of the initial block version. The sums of the partial products of each limb
+ * are accumulated in 128 bits, which the sum for the second limb can overflow, losing its carry.
+ *
+ * @param a The multiplicand
+ * @param b The multiplier
+ * @return The product, as it was computed by the initial block version
+ */
+UInt256 LegacyMultiply(UInt256 const &a, UInt256 const &b)
+{
+  __uint128_t products[UInt256::WIDE_ELEMENTS][UInt256::WIDE_ELEMENTS] = {};
+  for (std::size_t i = 0; i < UInt256::WIDE_ELEMENTS; ++i)
+  {
+    for (std::size_t j = 0; j < UInt256::WIDE_ELEMENTS; ++j)
+    {
+      products[i][j] = static_cast<__uint128_t>(a.ElementAt(i)) * b.ElementAt(j);
+    }
+  }
+
+  __uint128_t terms[UInt256::WIDE_ELEMENTS] = {};
+  terms[0]   = products[0][0];
+  auto carry = static_cast<WideType>(terms[0] >> UInt256::WIDE_ELEMENT_SIZE);
+  terms[1]   = products[0][1] + products[1][0] + carry;
+  carry      = static_cast<WideType>(terms[1] >> UInt256::WIDE_ELEMENT_SIZE);
+  terms[2]   = products[0][2] + products[1][1] + products[2][0] + carry;
+  carry      = static_cast<WideType>(terms[2] >> UInt256::WIDE_ELEMENT_SIZE);
+  terms[3]   = products[0][3] + products[1][2] + products[2][1] + products[3][0] + carry;
+
+  UInt256 product{};
+  for (std::size_t i = 0; i < UInt256::WIDE_ELEMENTS; ++i)
+  {
+    product.ElementAt(i) = static_cast<WideType>(terms[i]);
+  }
+
+  return product;
+}
+
+/**
+ * The division of the initial block version, by shift and subtract. The subtraction loses the
+ * borrow when a limb of the divisor is all ones, so some quotients come out too large.
+ *
+ * @param a The dividend
+ * @param b The divisor
+ * @return The quotient, as it was computed by the initial block version
+ */
+UInt256 LegacyDivide(UInt256 const &a, UInt256 const &b)
+{
+  if (b == UInt256::_0)
+  {
+    throw std::runtime_error("division by zero!");
+  }
+  if ((b == UInt256::_1) || (a == UInt256::_0))
+  {
+    return a;
+  }
+  if (a == b)
+  {
+    return UInt256::_1;
+  }
+  if (a < b)
+  {
+    return UInt256::_0;
+  }
+
+  UInt256     n{a};
+  UInt256     d{b};
+  std::size_t lsb = std::min(n.lsb(), d.lsb());
+  n >>= lsb;
+  d >>= lsb;
+
+  UInt256    multiple{1u};
+  auto const leading_zero_bits = d.UINT_SIZE - d.msb() - 1;
+  d <<= leading_zero_bits;
+  multiple <<= leading_zero_bits;
+
+  UInt256 quotient{};
+  do
+  {
+    if (n >= d)
+    {
+      n -= d;
+      quotient += multiple;
+    }
+    d >>= 1;
+    multiple >>= 1;
+  } while (multiple != UInt256::_0);
+
+  return quotient;
+}
+
 Ptr<String> ToString(VM *vm, Ptr<UInt256Wrapper> const &n)
 {
   return Ptr<String>{new String{vm, static_cast<std::string>(n->number())}};
@@ -283,18 +378,20 @@ void UInt256Wrapper::Multiply(Ptr<Object> &lhso, Ptr<Object> &rhso)
 {
   auto &lhs = static_cast<Ptr<UInt256Wrapper> const &>(lhso);
   auto &rhs = static_cast<Ptr<UInt256Wrapper> const &>(rhso);
+  auto const product = vm_->IsLegacyArithmetic() ? LegacyMultiply(lhs->number_, rhs->number_)
+                                                 : lhs->number_ * rhs->number_;
   if (lhs->IsTemporary())
   {
-    lhs->number_ *= rhs->number_;
+    lhs->number_ = product;
     return;
   }
   if (rhs->IsTemporary())
   {
-    rhs->number_ *= lhs->number_;
-    lhso = rhs;
+    rhs->number_ = product;
+    lhso         = rhs;
     return;
   }
-  Ptr<UInt256Wrapper> n(new UInt256Wrapper(vm_, lhs->number_ * rhs->number_));
+  Ptr<UInt256Wrapper> n(new UInt256Wrapper(vm_, product));
   lhso = std::move(n);
 }
 
@@ -302,6 +399,11 @@ void UInt256Wrapper::InplaceMultiply(Ptr<Object> const &lhso, Ptr<Object> const
 {
   auto &lhs = static_cast<Ptr<UInt256Wrapper> const &>(lhso);
   auto &rhs = static_cast<Ptr<UInt256Wrapper> const &>(rhso);
+  if (vm_->IsLegacyArithmetic())
+  {
+    lhs->number_ = LegacyMultiply(lhs->number_, rhs->number_);
+    return;
+  }
   lhs->number_ *= rhs->number_;
 }
 
@@ -314,13 +416,15 @@ void UInt256Wrapper::Divide(Ptr<Object> &lhso, Ptr<Object> &rhso)
     vm_->RuntimeError("UInt256Wrapper::Divide runtime error : division by zero.");
     return;
   }
+  auto const quotient = vm_->IsLegacyArithmetic() ? LegacyDivide(lhs->number_, rhs->number_)
+                                                  : lhs->number_ / rhs->number_;
   if (lhs->IsTemporary())
   {
-    lhs->number_ /= rhs->number_;
+    lhs->number_ = quotient;
     return;
   }
 
-  Ptr<UInt256Wrapper> n(new UInt256Wrapper(vm_, lhs->number_ / rhs->number_));
+  Ptr<UInt256Wrapper> n(new UInt256Wrapper(vm_, quotient));
   lhso = std::move(n);
 }
 
@@ -330,7 +434,14 @@ void UInt256Wrapper::InplaceDivide(Ptr<Object> const &lhso, Ptr<Object> const &r
   auto &rhs = static_cast<Ptr<UInt256Wrapper> const &>(rhso);
   try
   {
-    lhs->number_ /= rhs->number_;
+    if (vm_->IsLegacyArithmetic())
+    {
+      lhs->number_ = LegacyDivide(lhs->number_, rhs->number_);
+    }
+    else
+    {
+      lhs->number_ /= rhs->number_;
+    }
   }
   catch (std::exception const &ex)
   {
@@ -203,7 +203,7 @@ void VMTensor::SetAt(Args... args)
 {
   try
   {
-    tensor_.Set(args...);
+    GetTensor().Set(args...);
   }
   catch (std::exception const &e)
   {
@@ -211,26 +211,28 @@ void VMTensor::SetAt(Args... args)
   }
 }
 
+/**
+ * The copy shares the data of this tensor until either of them is modified
+ */
 vm::Ptr<VMTensor> VMTensor::Copy()
 {
-  Ptr<VMTensor> ret = Ptr<VMTensor>{new VMTensor(this->vm_, this->type_id_, shape())};
-  (ret->GetTensor()).Copy(GetTensor());
-  return ret;
+  return Ptr<VMTensor>{new VMTensor(this->vm_, this->type_id_, tensor_)};
 }
 
 void VMTensor::Fill(DataType const &value)
 {
-  tensor_.Fill(value);
+  GetTensor().Fill(value);
 }
 
 void VMTensor::FillRandom()
 {
-  tensor_.FillUniformRandom();
+  GetTensor().FillUniformRandom();
 }
 
 Ptr<VMTensor> VMTensor::Squeeze() const
 {
-  auto squeezed_tensor = tensor_.Copy();
+  // reshaping allocates new data, so this can start from a shallow copy
+  auto squeezed_tensor = tensor_;
   try
   {
     squeezed_tensor.Squeeze();
@@ -244,7 +246,7 @@ Ptr<VMTensor> VMTensor::Squeeze() const
 
 Ptr<VMTensor> VMTensor::Unsqueeze() const
 {
-  auto unsqueezed_tensor = tensor_.Copy();
+  auto unsqueezed_tensor = tensor_;
   unsqueezed_tensor.Unsqueeze();
   return fetch::vm::Ptr<VMTensor>(new VMTensor(vm_, type_id_, unsqueezed_tensor));
 }
@@ -295,7 +297,7 @@ bool VMTensor::IsEqual(vm::Ptr<Object> const &lhso, vm::Ptr<Object> const &rhso)
 {
   Ptr<VMTensor> left   = lhso;
   Ptr<VMTensor> right  = rhso;
-  bool          result = (left->GetTensor() == right->GetTensor());
+  bool          result = (left->GetConstTensor() == right->GetConstTensor());
   return result;
 }
 
@@ -309,7 +311,7 @@ bool VMTensor::IsNotEqual(vm::Ptr<Object> const &lhso, vm::Ptr<Object> const &rh
 {
   Ptr<VMTensor> left   = lhso;
   Ptr<VMTensor> right  = rhso;
-  bool          result = (left->GetTensor() != right->GetTensor());
+  bool          result = (left->GetConstTensor() != right->GetConstTensor());
   return result;
 }
 
@@ -322,7 +324,7 @@ void VMTensor::Negate(fetch::vm::Ptr<Object> &object)
 {
   Ptr<VMTensor> operand = object;
   Ptr<VMTensor> t       = Ptr<VMTensor>{new VMTensor(this->vm_, this->type_id_, shape())};
-  fetch::math::Multiply(operand->GetTensor(), DataType(-1), t->GetTensor());
+  fetch::math::Multiply(operand->GetConstTensor(), DataType(-1), t->GetTensor());
   object = std::move(t);
 }
 
@@ -339,7 +341,8 @@ void VMTensor::Add(vm::Ptr<Object> &lhso, vm::Ptr<Object> &rhso)
 {
   Ptr<VMTensor> left  = lhso;
   Ptr<VMTensor> right = rhso;
-  this->GetTensor()   = (left->GetTensor() + right->GetTensor());
+  TensorType    lhs   = left->GetConstTensor();
+  tensor_             = (lhs + right->GetConstTensor());
 }
 
 ChargeAmount VMTensor::AddChargeEstimator(vm::Ptr<Object> const &lhso, vm::Ptr<Object> const &rhso)
@@ -351,7 +354,8 @@ void VMTensor::Subtract(vm::Ptr<Object> &lhso, vm::Ptr<Object> &rhso)
 {
   Ptr<VMTensor> left  = lhso;
   Ptr<VMTensor> right = rhso;
-  this->GetTensor()   = (left->GetTensor() - right->GetTensor());
+  TensorType    lhs   = left->GetConstTensor();
+  tensor_             = (lhs - right->GetConstTensor());
 }
 
 ChargeAmount VMTensor::SubtractChargeEstimator(vm::Ptr<Object> const &lhso,
@@ -364,7 +368,7 @@ void VMTensor::InplaceAdd(vm::Ptr<Object> const &lhso, vm::Ptr<Object> const &rh
 {
   Ptr<VMTensor> left  = lhso;
   Ptr<VMTensor> right = rhso;
-  left->GetTensor().InlineAdd(right->GetTensor());
+  left->GetTensor().InlineAdd(right->GetConstTensor());
 }
 
 ChargeAmount VMTensor::InplaceAddChargeEstimator(vm::Ptr<Object> const &lhso,
@@ -377,7 +381,7 @@ void VMTensor::InplaceSubtract(vm::Ptr<Object> const &lhso, vm::Ptr<Object> cons
 {
   Ptr<VMTensor> left  = lhso;
   Ptr<VMTensor> right = rhso;
-  left->GetTensor().InlineSubtract(right->GetTensor());
+  left->GetTensor().InlineSubtract(right->GetConstTensor());
 }
 
 ChargeAmount VMTensor::InplaceSubtractChargeEstimator(vm::Ptr<Object> const &lhso,
@@ -390,7 +394,8 @@ void VMTensor::Multiply(vm::Ptr<Object> &lhso, vm::Ptr<Object> &rhso)
 {
   Ptr<VMTensor> left  = lhso;
   Ptr<VMTensor> right = rhso;
-  this->GetTensor()   = (left->GetTensor() * right->GetTensor());
+  TensorType    lhs   = left->GetConstTensor();
+  tensor_             = (lhs * right->GetConstTensor());
 }
 
 ChargeAmount VMTensor::MultiplyChargeEstimator(vm::Ptr<Object> const &lhso,
@@ -403,7 +408,8 @@ void VMTensor::Divide(vm::Ptr<Object> &lhso, vm::Ptr<Object> &rhso)
 {
   Ptr<VMTensor> left  = lhso;
   Ptr<VMTensor> right = rhso;
-  this->GetTensor()   = (left->GetTensor() / right->GetTensor());
+  TensorType    lhs   = left->GetConstTensor();
+  tensor_             = (lhs / right->GetConstTensor());
 }
 
 ChargeAmount VMTensor::DivideChargeEstimator(vm::Ptr<Object> const &lhso,
@@ -416,7 +422,7 @@ void VMTensor::InplaceMultiply(vm::Ptr<Object> const &lhso, vm::Ptr<Object> cons
 {
   Ptr<VMTensor> left  = lhso;
   Ptr<VMTensor> right = rhso;
-  left->GetTensor().InlineMultiply(right->GetTensor());
+  left->GetTensor().InlineMultiply(right->GetConstTensor());
 }
 
 ChargeAmount VMTensor::InplaceMultiplyChargeEstimator(vm::Ptr<Object> const &lhso,
@@ -429,7 +435,7 @@ void VMTensor::InplaceDivide(vm::Ptr<Object> const &lhso, vm::Ptr<Object> const
 {
   Ptr<VMTensor> left  = lhso;
   Ptr<VMTensor> right = rhso;
-  left->GetTensor().InlineDivide(right->GetTensor());
+  left->GetTensor().InlineDivide(right->GetConstTensor());
 }
 
 ChargeAmount VMTensor::InplaceDivideChargeEstimator(vm::Ptr<Object> const &lhso,
@@ -464,14 +470,14 @@ vm::Ptr<VMTensor> VMTensor::ArgMaxNoIndices()
 
 vm::Ptr<VMTensor> VMTensor::ArgMax(SizeType const &indices)
 {
-  auto          ret_tensor = fetch::math::ArgMax(GetTensor(), indices);
+  auto          ret_tensor = fetch::math::ArgMax(tensor_, indices);
   Ptr<VMTensor> ret        = Ptr<VMTensor>{new VMTensor(this->vm_, this->type_id_, ret_tensor)};
   return ret;
 }
 
 vm::Ptr<VMTensor> VMTensor::Dot(vm::Ptr<VMTensor> const &other)
 {
-  auto          ret_tensor = fetch::math::Dot(GetTensor(), other->GetTensor());
+  auto          ret_tensor = fetch::math::Dot(tensor_, other->GetConstTensor());
   Ptr<VMTensor> ret        = Ptr<VMTensor>{new VMTensor(this->vm_, this->type_id_, ret_tensor)};
   return ret;
 }
@@ -484,9 +490,7 @@ void VMTensor::FromString(fetch::vm::Ptr<fetch::vm::String> const &string)
 {
   try
   {
-    auto input_tensor = fetch::math::Tensor<DataType>::FromString(string->string());
-    tensor_.Reshape(input_tensor.shape());
-    tensor_.Assign(input_tensor);
+    tensor_ = fetch::math::Tensor<DataType>::FromString(string->string());
   }
   catch (std::exception const &e)
   {
@@ -508,12 +512,28 @@ Ptr<String> VMTensor::ToString() const
   return Ptr<String>{new String(vm_, as_string)};
 }
 
+/**
+ * Access the tensor in order to modify it. The data of the tensor may be shared with other tensors
+ * (copy on write), in which case it is copied first.
+ *
+ * @return The tensor
+ */
 ArrayType &VMTensor::GetTensor()
 {
+  if (!tensor_.data().IsUnique())
+  {
+    tensor_ = tensor_.Copy();
+  }
+
   return tensor_;
 }
 
-ArrayType const &VMTensor::GetConstTensor()
+/**
+ * Access the tensor without modifying it, which never copies its data
+ *
+ * @return The tensor
+ */
+ArrayType const &VMTensor::GetConstTensor() const
 {
   return tensor_;
 }
@@ -526,7 +546,10 @@ bool VMTensor::SerializeTo(serializers::MsgPackSerializer &buffer)
 
 bool VMTensor::DeserializeFrom(serializers::MsgPackSerializer &buffer)
 {
-  buffer >> tensor_;
+  // deserialise into new data, rather than the data shared with other tensors
+  ArrayType tensor{};
+  buffer >> tensor;
+  tensor_ = std::move(tensor);
   return true;
 }
 
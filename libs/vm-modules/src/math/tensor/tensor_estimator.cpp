@@ -25,6 +25,7 @@
 #include "vm_modules/math/type.hpp"
 #include "vm_modules/use_estimator.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -40,6 +41,8 @@ using ArrayType  = fetch::math::Tensor<VMTensor::DataType>;
 using SizeType   = ArrayType::SizeType;
 using SizeVector = ArrayType::SizeVector;
 
+constexpr std::size_t TensorEstimator::NUM_CHARGES;
+
 TensorEstimator::TensorEstimator(VMTensor &tensor)
   : tensor_{tensor}
 {}
@@ -56,20 +59,23 @@ ChargeAmount TensorEstimator::VMShape()
 
 ChargeAmount TensorEstimator::Copy()
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
+  return Memoise(Charge::COPY, [this]() {
+    auto const &shape       = tensor_.GetConstTensor().shape();
+    SizeType    padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(shape);
+    SizeType    size        = fetch::math::Tensor<DataType>::SizeFromShape(shape);
 
-  auto ret = static_cast<ChargeAmount>(COPY_PADDED_SIZE_COEF * padded_size + COPY_SIZE_COEF * size +
-                                       COPY_CONST_COEF) *
-             COMPUTE_CHARGE_COST;
+    auto ret = static_cast<ChargeAmount>(COPY_PADDED_SIZE_COEF * padded_size +
+                                         COPY_SIZE_COEF * size + COPY_CONST_COEF) *
+               COMPUTE_CHARGE_COST;
 
-  // Ensure that estimate will never be 0
-  if (ret < std::numeric_limits<uint64_t>::max())
-  {
-    ret += 1;
-  }
+    // Ensure that estimate will never be 0
+    if (ret < std::numeric_limits<uint64_t>::max())
+    {
+      ret += 1;
+    }
 
-  return ret;
+    return ret;
+  });
 }
 
 ChargeAmount TensorEstimator::AtOne(TensorType::SizeType /*idx1*/)
@@ -118,42 +124,23 @@ ChargeAmount TensorEstimator::SetAtFour(uint64_t /*idx1*/, uint64_t /*idx2*/, ui
 
 ChargeAmount TensorEstimator::Fill(DataType const & /*value*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(FILL_PADDED_SIZE_COEF * padded_size + FILL_SIZE_COEF * size +
-                        FILL_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::FILL, FILL_PADDED_SIZE_COEF, FILL_SIZE_COEF, FILL_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::FillRandom()
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(FILL_RANDOM_PADDED_SIZE_COEF * padded_size + FILL_RANDOM_SIZE_COEF * size +
-                        FILL_RANDOM_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::FILL_RANDOM, FILL_RANDOM_PADDED_SIZE_COEF, FILL_RANDOM_SIZE_COEF,
+                     FILL_RANDOM_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::Min()
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(MIN_PADDED_SIZE_COEF * padded_size + MIN_SIZE_COEF * size +
-                        MIN_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::MIN, MIN_PADDED_SIZE_COEF, MIN_SIZE_COEF, MIN_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::Max()
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(MAX_PADDED_SIZE_COEF * padded_size + MAX_SIZE_COEF * size +
-                        MAX_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::MAX, MAX_PADDED_SIZE_COEF, MAX_SIZE_COEF, MAX_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::Reshape(
@@ -194,51 +181,43 @@ ChargeAmount TensorEstimator::Squeeze()
 
 ChargeAmount TensorEstimator::Sum()
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(SUM_PADDED_SIZE_COEF * padded_size + SUM_SIZE_COEF * size +
-                        SUM_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::SUM, SUM_PADDED_SIZE_COEF, SUM_SIZE_COEF, SUM_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::ArgMax(SizeType const &indices)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
   if (indices == 0)
   {
-    return ToChargeAmount(ARGMAX_FIRST_PADDED_SIZE_COEF * padded_size +
-                          ARGMAX_FIRST_SIZE_COEF * size + ARGMAX_FIRST_CONST_COEF) *
-           COMPUTE_CHARGE_COST;
+    return ShapeCharge(Charge::ARGMAX_FIRST, ARGMAX_FIRST_PADDED_SIZE_COEF, ARGMAX_FIRST_SIZE_COEF,
+                       ARGMAX_FIRST_CONST_COEF);
   }
-  if (indices == tensor_.shape().size() - 1)
+  if (indices == tensor_.GetConstTensor().shape().size() - 1)
   {
-    return ToChargeAmount(ARGMAX_LAST_PADDED_SIZE_COEF * padded_size +
-                          ARGMAX_LAST_SIZE_COEF * size + ARGMAX_LAST_CONST_COEF) *
-           COMPUTE_CHARGE_COST;
+    return ShapeCharge(Charge::ARGMAX_LAST, ARGMAX_LAST_PADDED_SIZE_COEF, ARGMAX_LAST_SIZE_COEF,
+                       ARGMAX_LAST_CONST_COEF);
   }
 
-  return static_cast<ChargeAmount>(ARGMAX_MID_PADDED_SIZE_COEF * padded_size +
-                                   ARGMAX_MID_SIZE_COEF * size + ARGMAX_MID_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return Memoise(Charge::ARGMAX_MID, [this]() {
+    auto const &shape       = tensor_.GetConstTensor().shape();
+    SizeType    padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(shape);
+    SizeType    size        = fetch::math::Tensor<DataType>::SizeFromShape(shape);
+
+    return static_cast<ChargeAmount>(ARGMAX_MID_PADDED_SIZE_COEF * padded_size +
+                                     ARGMAX_MID_SIZE_COEF * size + ARGMAX_MID_CONST_COEF) *
+           COMPUTE_CHARGE_COST;
+  });
 }
 
 ChargeAmount TensorEstimator::ArgMaxNoIndices()
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(ARGMAX_FIRST_PADDED_SIZE_COEF * padded_size +
-                        ARGMAX_FIRST_SIZE_COEF * size + ARGMAX_FIRST_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::ARGMAX_FIRST, ARGMAX_FIRST_PADDED_SIZE_COEF, ARGMAX_FIRST_SIZE_COEF,
+                     ARGMAX_FIRST_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::Dot(vm::Ptr<VMTensor> const &other)
 {
   SizeType x = tensor_.shape().at(0);
-  SizeType y = other->GetTensor().shape().at(1);
+  SizeType y = other->GetConstTensor().shape().at(1);
   SizeType c = tensor_.shape().at(1);
 
   return ToChargeAmount(DOT_X_COEF * x + DOT_Y_COEF * y + DOT_C_COEF * c +
@@ -265,122 +244,75 @@ ChargeAmount TensorEstimator::GetReshapeCost(SizeVector const &new_shape)
 
 ChargeAmount TensorEstimator::NegateChargeEstimator(vm::Ptr<Object> const & /*object*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(NEGATE_PADDED_SIZE_COEF * padded_size + NEGATE_SIZE_COEF * size +
-                        NEGATE_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::NEGATE, NEGATE_PADDED_SIZE_COEF, NEGATE_SIZE_COEF, NEGATE_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::IsEqualChargeEstimator(vm::Ptr<Object> const & /*lhso*/,
                                                      vm::Ptr<Object> const & /*rhso*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(IS_EQUAL_PADDED_SIZE_COEF * padded_size + IS_EQUAL_SIZE_COEF * size +
-                        IS_EQUAL_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::IS_EQUAL, IS_EQUAL_PADDED_SIZE_COEF, IS_EQUAL_SIZE_COEF,
+                     IS_EQUAL_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::IsNotEqualChargeEstimator(vm::Ptr<Object> const & /*lhso*/,
                                                         vm::Ptr<Object> const & /*rhso*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(IS_NOT_EQUAL_PADDED_SIZE_COEF * padded_size +
-                        IS_NOT_EQUAL_SIZE_COEF * size + IS_NOT_EQUAL_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::IS_NOT_EQUAL, IS_NOT_EQUAL_PADDED_SIZE_COEF, IS_NOT_EQUAL_SIZE_COEF,
+                     IS_NOT_EQUAL_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::AddChargeEstimator(vm::Ptr<vm::Object> const & /*lhso*/,
                                                  vm::Ptr<Object> const & /*rhso*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(ADD_PADDED_SIZE_COEF * padded_size + ADD_SIZE_COEF * size +
-                        ADD_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::ADD, ADD_PADDED_SIZE_COEF, ADD_SIZE_COEF, ADD_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::SubtractChargeEstimator(vm::Ptr<vm::Object> const & /*lhso*/,
                                                       vm::Ptr<Object> const & /*rhso*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(SUBTRACT_PADDED_SIZE_COEF * padded_size + SUBTRACT_SIZE_COEF * size +
-                        SUBTRACT_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::SUBTRACT, SUBTRACT_PADDED_SIZE_COEF, SUBTRACT_SIZE_COEF,
+                     SUBTRACT_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::InplaceAddChargeEstimator(vm::Ptr<vm::Object> const & /*lhso*/,
                                                         vm::Ptr<Object> const & /*rhso*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(INPLACE_ADD_PADDED_SIZE_COEF * padded_size + INPLACE_ADD_SIZE_COEF * size +
-                        INPLACE_ADD_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::INPLACE_ADD, INPLACE_ADD_PADDED_SIZE_COEF, INPLACE_ADD_SIZE_COEF,
+                     INPLACE_ADD_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::InplaceSubtractChargeEstimator(vm::Ptr<vm::Object> const & /*lhso*/,
                                                              vm::Ptr<Object> const & /*rhso*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(INPLACE_SUBTRACT_PADDED_SIZE_COEF * padded_size +
-                        INPLACE_SUBTRACT_SIZE_COEF * size + INPLACE_SUBTRACT_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::INPLACE_SUBTRACT, INPLACE_SUBTRACT_PADDED_SIZE_COEF,
+                     INPLACE_SUBTRACT_SIZE_COEF, INPLACE_SUBTRACT_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::MultiplyChargeEstimator(vm::Ptr<vm::Object> const & /*lhso*/,
                                                       vm::Ptr<Object> const & /*rhso*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(MULTIPLY_PADDED_SIZE_COEF * padded_size + MULTIPLY_SIZE_COEF * size +
-                        MULTIPLY_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::MULTIPLY, MULTIPLY_PADDED_SIZE_COEF, MULTIPLY_SIZE_COEF,
+                     MULTIPLY_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::DivideChargeEstimator(vm::Ptr<vm::Object> const & /*lhso*/,
                                                     vm::Ptr<Object> const & /*rhso*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(DIVIDE_PADDED_SIZE_COEF * padded_size + DIVIDE_SIZE_COEF * size +
-                        DIVIDE_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::DIVIDE, DIVIDE_PADDED_SIZE_COEF, DIVIDE_SIZE_COEF, DIVIDE_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::InplaceMultiplyChargeEstimator(vm::Ptr<vm::Object> const & /*lhso*/,
                                                              vm::Ptr<Object> const & /*rhso*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(INPLACE_MULTIPLY_PADDED_SIZE_COEF * padded_size +
-                        INPLACE_MULTIPLY_SIZE_COEF * size + INPLACE_MULTIPLY_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::INPLACE_MULTIPLY, INPLACE_MULTIPLY_PADDED_SIZE_COEF,
+                     INPLACE_MULTIPLY_SIZE_COEF, INPLACE_MULTIPLY_CONST_COEF);
 }
 
 ChargeAmount TensorEstimator::InplaceDivideChargeEstimator(vm::Ptr<vm::Object> const & /*lhso*/,
                                                            vm::Ptr<Object> const & /*rhso*/)
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
-
-  return ToChargeAmount(INPLACE_DIVIDE_PADDED_SIZE_COEF * padded_size +
-                        INPLACE_DIVIDE_SIZE_COEF * size + INPLACE_DIVIDE_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+  return ShapeCharge(Charge::INPLACE_DIVIDE, INPLACE_DIVIDE_PADDED_SIZE_COEF,
+                     INPLACE_DIVIDE_SIZE_COEF, INPLACE_DIVIDE_CONST_COEF);
 }
 
 /// END OF OPERATORS ///
@@ -410,12 +342,60 @@ ChargeAmount TensorEstimator::FromString(fetch::vm::Ptr<fetch::vm::String> const
 
 ChargeAmount TensorEstimator::ToString()
 {
-  SizeType padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(tensor_.shape());
-  SizeType size        = fetch::math::Tensor<DataType>::SizeFromShape(tensor_.shape());
+  return ShapeCharge(Charge::TO_STRING, TO_STRING_PADDED_SIZE_COEF, TO_STRING_SIZE_COEF,
+                     TO_STRING_CONST_COEF);
+}
 
-  return ToChargeAmount(TO_STRING_PADDED_SIZE_COEF * padded_size + TO_STRING_SIZE_COEF * size +
-                        TO_STRING_CONST_COEF) *
-         COMPUTE_CHARGE_COST;
+/**
+ * Internal: Get a charge which depends only on the shape of the tensor, reusing the previous
+ * estimate when the shape has not changed since it was computed
+ *
+ * @param charge The charge being estimated
+ * @param estimate The function which computes the charge
+ * @return The estimated charge
+ */
+template <typename Estimate>
+ChargeAmount TensorEstimator::Memoise(Charge charge, Estimate &&estimate)
+{
+  auto const &shape = tensor_.GetConstTensor().shape();
+  if (shape != memo_shape_)
+  {
+    memo_shape_ = shape;
+    memo_valid_.reset();
+  }
+
+  auto const index = static_cast<std::size_t>(charge);
+  if (!memo_valid_.test(index))
+  {
+    memo_charges_[index] = estimate();
+    memo_valid_.set(index);
+  }
+
+  return memo_charges_[index];
+}
+
+/**
+ * Internal: Get a charge which is linear in the padded and unpadded sizes of the tensor
+ *
+ * @param charge The charge being estimated
+ * @param padded_size_coef The coefficient of the padded size
+ * @param size_coef The coefficient of the size
+ * @param const_coef The constant term
+ * @return The estimated charge
+ */
+ChargeAmount TensorEstimator::ShapeCharge(Charge                     charge,
+                                          fixed_point::fp64_t const &padded_size_coef,
+                                          fixed_point::fp64_t const &size_coef,
+                                          fixed_point::fp64_t const &const_coef)
+{
+  return Memoise(charge, [this, &padded_size_coef, &size_coef, &const_coef]() {
+    auto const &shape       = tensor_.GetConstTensor().shape();
+    SizeType    padded_size = fetch::math::Tensor<DataType>::PaddedSizeFromShape(shape);
+    SizeType    size        = fetch::math::Tensor<DataType>::SizeFromShape(shape);
+
+    return ToChargeAmount(padded_size_coef * padded_size + size_coef * size + const_coef) *
+           COMPUTE_CHARGE_COST;
+  });
 }
 
 ChargeAmount TensorEstimator::MaximumCharge(std::string const &log_msg)
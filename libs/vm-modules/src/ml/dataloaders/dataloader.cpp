@@ -123,10 +123,10 @@ void VMDataLoader::AddTensorData(
   for (fetch::math::SizeType i{0}; i < n_elements; i++)
   {
     Ptr<VMTensorType> ptr_tensor = data->elements.at(i);
-    c_data.at(i)                 = (ptr_tensor)->GetTensor();
+    c_data.at(i)                 = (ptr_tensor)->GetConstTensor();
   }
 
-  std::static_pointer_cast<TensorLoaderType>(loader_)->AddData(c_data, labels->GetTensor());
+  std::static_pointer_cast<TensorLoaderType>(loader_)->AddData(c_data, labels->GetConstTensor());
 }
 
 // TODO(issue 1692): Simplify Array<Tensor> construction
@@ -51,7 +51,7 @@ Ptr<VMGraph> VMGraph::Constructor(VM *vm, TypeId type_id)
 
 void VMGraph::SetInput(VMPtrString const &name, Ptr<VMTensorType> const &input)
 {
-  graph_.SetInput(name->string(), (*input).GetTensor());
+  graph_.SetInput(name->string(), (*input).GetConstTensor());
 }
 
 Ptr<VMTensorType> VMGraph::Evaluate(VMPtrString const &name)
@@ -262,7 +262,7 @@ void VMModel::Fit(vm::Ptr<VMTensor> const &data, vm::Ptr<VMTensor> const &labels
   // prepare dataloader
   auto data_loader = std::make_unique<TensorDataloader>();
   data_loader->SetRandomMode(true);
-  data_loader->AddData({data->GetTensor()}, labels->GetTensor());
+  data_loader->AddData({data->GetConstTensor()}, labels->GetConstTensor());
   model_->SetDataloader(std::move(data_loader));
 
   // set batch size
@@ -292,7 +292,10 @@ vm::Ptr<Array<math::DataType>> VMModel::Evaluate()
 vm::Ptr<VMModel::VMTensor> VMModel::Predict(vm::Ptr<VMTensor> const &data)
 {
   vm::Ptr<VMTensor> prediction = this->vm_->CreateNewObject<VMTensor>(data->shape());
-  model_->Predict(data->GetTensor(), prediction->GetTensor());
+
+  // the model only reads its input, which is a shallow copy of the data
+  auto input = data->GetConstTensor();
+  model_->Predict(input, prediction->GetTensor());
   return prediction;
 }
 
@@ -324,7 +324,9 @@ ChargeAmount ModelEstimator::Fit(Ptr<math::VMTensor> const &data, Ptr<math::VMTe
   FETCH_UNUSED(labels);
 
   DataType estimate{"0"};
-  state_.subset_size         = data->GetTensor().shape().at(data->GetTensor().shape().size() - 1);
+
+  auto const &data_shape     = data->GetConstTensor().shape();
+  state_.subset_size         = data_shape.at(data_shape.size() - 1);
   SizeType number_of_batches = state_.subset_size / batch_size;
 
   // Forward pass
@@ -363,7 +365,8 @@ ChargeAmount ModelEstimator::Evaluate()
 ChargeAmount ModelEstimator::Predict(Ptr<math::VMTensor> const &data)
 {
   DataType estimate{"0"};
-  SizeType batch_size = data->GetTensor().shape().at(data->GetTensor().shape().size() - 1);
+  auto const &data_shape = data->GetConstTensor().shape();
+  SizeType    batch_size = data_shape.at(data_shape.size() - 1);
 
   estimate += state_.forward_pass_cost * batch_size;
   estimate += PREDICT_BATCH_LAYER_COEF * batch_size * state_.ops_count;
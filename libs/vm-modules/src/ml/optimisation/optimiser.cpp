@@ -137,7 +137,7 @@ VMOptimiser::DataType VMOptimiser::RunData(Ptr<fetch::vm_modules::math::VMTensor
                                            Ptr<fetch::vm_modules::math::VMTensor> const &labels,
                                            uint64_t                                      batch_size)
 {
-  return optimiser_->Run({(data->GetTensor())}, labels->GetTensor(), batch_size);
+  return optimiser_->Run({(data->GetConstTensor())}, labels->GetConstTensor(), batch_size);
 }
 
 VMOptimiser::DataType VMOptimiser::RunLoader(uint64_t batch_size, uint64_t subset_size)
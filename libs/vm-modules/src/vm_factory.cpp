@@ -18,6 +18,7 @@
 
 #include "logging/logging.hpp"
 #include "vm/module.hpp"
+#include "vm/optimiser.hpp"
 #include "vm_modules/core/byte_array_wrapper.hpp"
 #include "vm_modules/core/panic.hpp"
 #include "vm_modules/core/print.hpp"
@@ -44,7 +45,8 @@ namespace fetch {
 namespace vm_modules {
 
 VMFactory::Errors VMFactory::Compile(std::shared_ptr<Module> const &module,
-                                     SourceFiles const &files, Executable &executable)
+                                     SourceFiles const &files, Executable &executable,
+                                     bool optimise)
 {
   std::vector<std::string> errors;
 
@@ -67,6 +69,11 @@ VMFactory::Errors VMFactory::Compile(std::shared_ptr<Module> const &module,
     return errors;
   }
 
+  if (optimise)
+  {
+    Optimiser::Optimise(executable);
+  }
+
 #ifndef NDEBUG
   std::ostringstream all_errors;
   for (auto const &error : errors)
@@ -619,6 +619,63 @@ TEST_F(UInt256Tests, uint256_division_by_zero)
   EXPECT_FALSE(toolkit.Run());
 }
 
+// (2^128 - 1)^2 = 2^256 - 2^129 + 1 and 2^192 / (2^128 - 1) = 2^64, computed in Etch and compared
+// with the expected results in big-endian hex
+std::string CarryAndBorrowSource(std::string const &product, std::string const &quotient)
+{
+  return R"(
+    function main()
+      var expected_product = ")" +
+         product + R"(";
+      var expected_quotient = ")" +
+         quotient + R"(";
+
+      var m = UInt256(18446744073709551615u64);
+      var one = UInt256(1u64);
+      var x = m * m + m + m;
+      var y = m + one;
+
+      var product = x * x;
+      var inplace_product = x.copy();
+      inplace_product *= x;
+      assert(toString(product) == expected_product, "Wrong product");
+      assert(toString(inplace_product) == expected_product, "Wrong in-place product");
+
+      var quotient = y * y * y / x;
+      var inplace_quotient = y * y * y;
+      inplace_quotient /= x;
+      assert(toString(quotient) == expected_quotient, "Wrong quotient");
+      assert(toString(inplace_quotient) == expected_quotient, "Wrong in-place quotient");
+    endfunction
+  )";
+}
+
+TEST_F(UInt256Tests, uint256_multiplication_and_division_carry_test)
+{
+  auto const source =
+      CarryAndBorrowSource("fffffffffffffffffffffffffffffffe00000000000000000000000000000001",
+                           "0000000000000000000000000000000000000000000000010000000000000000");
+
+  ASSERT_TRUE(toolkit.Compile(source));
+  EXPECT_TRUE(toolkit.Run());
+}
+
+TEST_F(UInt256Tests, uint256_legacy_multiplication_and_division_carry_test)
+{
+  // the arithmetic of the initial block version loses the carry of 2^192 from the product, and
+  // the borrow of its subtraction gives a quotient of 2^65 - 1
+  auto const source =
+      CarryAndBorrowSource("fffffffffffffffefffffffffffffffe00000000000000000000000000000001",
+                           "000000000000000000000000000000000000000000000001ffffffffffffffff");
+
+  ASSERT_TRUE(toolkit.Compile(source));
+  toolkit.vm().SetLegacyArithmetic(true);
+  EXPECT_TRUE(toolkit.Run());
+
+  ASSERT_TRUE(toolkit.Compile(source));
+  EXPECT_FALSE(toolkit.Run());
+}
+
 TEST_F(UInt256Tests, uint256_size)
 {
   static constexpr char const *TEXT = R"(
@@ -352,4 +352,30 @@ TEST_F(MathTensorEstimatorTests, tensor_estimator_invalid_reshape_test)
   }
 }
 
+TEST_F(MathTensorEstimatorTests, tensor_estimator_memoised_charges_follow_shape_test)
+{
+  MathTensor        tensor{{4, 4, 4}};
+  VmTensor          vm_tensor(&toolkit.vm(), fetch::vm::TypeIds::Unknown, tensor);
+  VmTensorEstimator tensor_estimator(vm_tensor);
+
+  ChargeAmount const sum_charge  = tensor_estimator.Sum();
+  ChargeAmount const copy_charge = tensor_estimator.Copy();
+
+  // repeated estimates for the same shape are identical
+  EXPECT_EQ(tensor_estimator.Sum(), sum_charge);
+  EXPECT_EQ(tensor_estimator.Copy(), copy_charge);
+
+  // and are recomputed when the shape changes
+  MathTensor        resized_tensor{{64, 64, 64}};
+  vm_tensor.GetTensor() = resized_tensor;
+
+  VmTensor          resized_vm_tensor(&toolkit.vm(), fetch::vm::TypeIds::Unknown, resized_tensor);
+  VmTensorEstimator resized_estimator(resized_vm_tensor);
+
+  EXPECT_GT(tensor_estimator.Sum(), sum_charge);
+  EXPECT_EQ(tensor_estimator.Sum(), resized_estimator.Sum());
+  EXPECT_EQ(tensor_estimator.Copy(), resized_estimator.Copy());
+  EXPECT_EQ(tensor_estimator.ArgMax(1), resized_estimator.ArgMax(1));
+}
+
 }  // namespace
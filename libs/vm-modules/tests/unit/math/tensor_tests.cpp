@@ -423,6 +423,68 @@ TEST_F(MathTensorTests, tensor_copy_from_tensor)
   EXPECT_TRUE(gt.AllClose(tensor->GetTensor()));
 }
 
+TEST_F(MathTensorTests, tensor_copy_is_not_modified_through_the_original)
+{
+  static char const *tensor_copy_src = R"(
+    function main() : Tensor
+      var tensor_shape = Array<UInt64>(2);
+      tensor_shape[0] = 2u64;
+      tensor_shape[1] = 2u64;
+
+      var x = Tensor(tensor_shape);
+      x.fill(2.0fp64);
+      var y = x.copy();
+      y += x;
+      y.fill(5.0fp64);
+      x.setAt(0u64, 0u64, 1.0fp64);
+
+      assert(y.at(0u64, 0u64) == 5.0fp64);
+      assert(y.at(1u64, 1u64) == 5.0fp64);
+      return x;
+
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(tensor_copy_src));
+  Variant res;
+  ASSERT_TRUE(toolkit.Run(&res));
+
+  auto const                    tensor = res.Get<Ptr<fetch::vm_modules::math::VMTensor>>();
+  fetch::math::Tensor<DataType> gt({2, 2});
+  gt.Fill(DataType{2});
+  gt.Set(SizeType{0}, SizeType{0}, DataType{1});
+
+  EXPECT_TRUE(gt.AllClose(tensor->GetConstTensor()));
+}
+
+TEST_F(MathTensorTests, tensor_unsqueeze_does_not_share_data)
+{
+  static char const *tensor_unsqueeze_src = R"(
+    function main() : Tensor
+      var tensor_shape = Array<UInt64>(1);
+      tensor_shape[0] = 4u64;
+
+      var x = Tensor(tensor_shape);
+      x.fill(3.0fp64);
+      var y = x.unsqueeze();
+      y.fill(1.0fp64);
+
+      return x;
+
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(tensor_unsqueeze_src));
+  Variant res;
+  ASSERT_TRUE(toolkit.Run(&res));
+
+  auto const                    tensor = res.Get<Ptr<fetch::vm_modules::math::VMTensor>>();
+  fetch::math::Tensor<DataType> gt({4});
+  gt.Fill(DataType{3});
+
+  EXPECT_TRUE(gt.AllClose(tensor->GetConstTensor()));
+}
+
 /// TENSOR ARITHMETIC TESTS ///
 
 TEST_F(MathTensorTests, tensor_equal_etch_test)
@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <utility>
 
 namespace {
 
@@ -892,4 +893,92 @@ TEST_F(VmChargeTests,
   ASSERT_FALSE(toolkit.Run(nullptr, max_charge_amount));
 }
 
+/// Run the compiled program, returning whether it succeeded and the charge of the run. The charge
+/// total accumulates over runs, so the limit is applied relative to the current total.
+std::pair<bool, ChargeAmount> RunRelative(VmTestToolkit &toolkit, ChargeAmount charge_limit)
+{
+  ChargeAmount const before  = toolkit.vm().GetChargeTotal();
+  bool const         success = toolkit.Run(nullptr, before + charge_limit);
+
+  return {success, toolkit.vm().GetChargeTotal() - before};
+}
+
+class VmBlockDispatchTests : public ::testing::Test
+{
+public:
+  void Compile(char const *text)
+  {
+    ASSERT_TRUE(reference.Compile(text));
+    ASSERT_TRUE(optimised.Compile(text));
+
+    reference.vm().SetBlockDispatch(false);
+    optimised.vm().SetBlockDispatch(true);
+  }
+
+  std::stringstream stdout;
+  VmTestToolkit     reference{&stdout};
+  VmTestToolkit     optimised{&stdout};
+};
+
+TEST_F(VmBlockDispatchTests, charges_are_identical_to_instruction_dispatch)
+{
+  static char const *TEXT = R"(
+    function main() : Int32
+      var total = 0;
+      var i = 0;
+      while (i < 20)
+        if (i % 3 == 0)
+          total += i * 2;
+        else
+          total -= 1;
+        endif
+        i++;
+      endwhile
+      return total;
+    endfunction
+  )";
+
+  Compile(TEXT);
+
+  auto const full_reference = RunRelative(reference, high_charge_limit);
+  auto const full_optimised = RunRelative(optimised, high_charge_limit);
+
+  ASSERT_TRUE(full_reference.first);
+  ASSERT_TRUE(full_optimised.first);
+  EXPECT_EQ(full_optimised.second, full_reference.second);
+
+  // the execution must stop at exactly the same point for every charge limit
+  for (ChargeAmount limit = 1; limit <= full_reference.second + 1; ++limit)
+  {
+    auto const limited_reference = RunRelative(reference, limit);
+    auto const limited_optimised = RunRelative(optimised, limit);
+
+    ASSERT_EQ(limited_optimised.first, limited_reference.first) << "limit: " << limit;
+    ASSERT_EQ(limited_optimised.second, limited_reference.second) << "limit: " << limit;
+  }
+}
+
+TEST_F(VmBlockDispatchTests, charges_are_identical_after_runtime_error)
+{
+  static char const *TEXT = R"(
+    function main()
+      var a = 10;
+      var b = 0;
+      var c = a + 1;
+      var d = c / b;
+      var e = d + 1;
+      var f = e * 2;
+    endfunction
+  )";
+
+  Compile(TEXT);
+
+  auto const full_reference = RunRelative(reference, high_charge_limit);
+  auto const full_optimised = RunRelative(optimised, high_charge_limit);
+
+  EXPECT_FALSE(full_reference.first);
+  EXPECT_FALSE(full_optimised.first);
+  EXPECT_EQ(full_optimised.second, full_reference.second);
+}
+
 }  // namespace
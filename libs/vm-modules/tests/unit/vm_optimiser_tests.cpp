@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/opcodes.hpp"
+#include "vm/optimiser.hpp"
+#include "vm/variant.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace {
+
+using fetch::vm::ChargeAmount;
+using fetch::vm::Executable;
+using fetch::vm::Module;
+using fetch::vm::Optimiser;
+using fetch::vm::SourceFiles;
+using fetch::vm::Variant;
+using fetch::vm::VM;
+using fetch::vm_modules::VMFactory;
+
+namespace Opcodes = fetch::vm::Opcodes;
+
+class VmOptimiserTests : public ::testing::Test
+{
+public:
+  struct Result
+  {
+    bool         success{false};
+    std::string  error{};
+    Variant      output{};
+    ChargeAmount charge{0};
+  };
+
+  void Compile(char const *text)
+  {
+    SourceFiles const files = {{"default.etch", text}};
+
+    ASSERT_TRUE(VMFactory::Compile(module_, files, reference_, false).empty());
+    ASSERT_TRUE(VMFactory::Compile(module_, files, optimised_, true).empty());
+  }
+
+  Result Run(Executable &executable) const
+  {
+    VM     vm{module_.get()};
+    Result result{};
+
+    result.success = vm.Execute(executable, "main", result.error, result.output);
+    result.charge  = vm.GetChargeTotal();
+
+    return result;
+  }
+
+  std::size_t CountOpcode(Executable const &executable, uint16_t opcode) const
+  {
+    std::size_t count{0};
+    for (auto const &instruction : executable.FindFunction("main")->instructions)
+    {
+      if (instruction.opcode == opcode)
+      {
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  std::shared_ptr<Module> module_{VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS)};
+  Executable              reference_{};
+  Executable              optimised_{};
+};
+
+TEST_F(VmOptimiserTests, optimised_code_computes_the_same_result)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var total = 0i64;
+      var i = 0i64;
+      while (i < 20i64)
+        if (i % 3i64 == 0i64 && i > 1i64)
+          total = total + i * 2i64;
+        else
+          total = total - 1i64;
+        endif
+        i = i + 1i64;
+      endwhile
+      var k = 2i64 * 3i64 + 4i64;
+      k = 5i64;
+      k = i;
+      k = k;
+      for (j in 0:5)
+        if (j == 3)
+          continue;
+        endif
+        if (j == 4)
+          break;
+        endif
+        k = k * 2i64;
+      endfor
+      return total * 1000i64 + k;
+    endfunction
+  )";
+
+  Compile(TEXT);
+
+  auto const reference = Run(reference_);
+  auto const optimised = Run(optimised_);
+
+  ASSERT_TRUE(reference.success);
+  ASSERT_TRUE(optimised.success);
+  EXPECT_EQ(optimised.output.primitive.i64, reference.output.primitive.i64);
+
+  // fewer instructions are executed, so the charge is reduced
+  EXPECT_LT(optimised.charge, reference.charge);
+  EXPECT_LT(optimised_.FindFunction("main")->instructions.size(),
+            reference_.FindFunction("main")->instructions.size());
+  EXPECT_EQ(CountOpcode(optimised_, Opcodes::LocalVariablePrimitiveInplaceAdd), 1);
+  EXPECT_EQ(CountOpcode(optimised_, Opcodes::LocalVariablePrimitiveInplaceSubtract), 1);
+  EXPECT_EQ(CountOpcode(optimised_, Opcodes::LocalVariablePrimitiveInplaceMultiply), 1);
+}
+
+TEST_F(VmOptimiserTests, runtime_errors_are_preserved)
+{
+  static char const *TEXT = R"(
+    function main() : UInt64
+      var a : Int8 = 100i8 + 100i8;
+      var b : UInt64 = 18446744073709551615u64 * 2u64;
+      var c = 10;
+      c = c / 0;
+      return b;
+    endfunction
+  )";
+
+  Compile(TEXT);
+
+  // overflowing constant expressions and division by zero are not folded
+  EXPECT_EQ(CountOpcode(optimised_, Opcodes::PrimitiveAdd), 1);
+  EXPECT_EQ(CountOpcode(optimised_, Opcodes::PrimitiveMultiply), 1);
+
+  auto const reference = Run(reference_);
+  auto const optimised = Run(optimised_);
+
+  EXPECT_FALSE(reference.success);
+  EXPECT_FALSE(optimised.success);
+  EXPECT_EQ(optimised.error, reference.error);
+}
+
+TEST_F(VmOptimiserTests, opcode_pairs_are_counted)
+{
+  static char const *TEXT = R"(
+    function main()
+      var x = 1;
+      x = x + 1;
+      x = x + 2;
+    endfunction
+  )";
+
+  Compile(TEXT);
+
+  auto const before = Optimiser::CountOpcodePairs(reference_);
+  auto const after  = Optimiser::CountOpcodePairs(optimised_);
+
+  auto const pair = Optimiser::OpcodePair{Opcodes::PushLocalVariable, Opcodes::PushConstant};
+  ASSERT_EQ(before.count(pair), 1);
+  EXPECT_EQ(before.at(pair), 2);
+  EXPECT_EQ(after.count(pair), 0);
+}
+
+}  // namespace
@@ -0,0 +1,305 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/vm.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace fetch::vm;
+
+namespace vm {
+namespace benchmark {
+namespace interpreter {
+namespace {
+
+/**
+ * Compiles an Etch script once so that only the execution of its `main(n : Int32)` function is
+ * measured. The VM is reused between iterations, in the same way as it would be for repeated
+ * contract invocations.
+ */
+class Script
+{
+public:
+  explicit Script(std::string const &source)
+    : compiler_{std::make_unique<Compiler>(&module_)}
+    , vm_{std::make_unique<VM>(&module_)}
+  {
+    std::vector<std::string> errors{};
+    IR                       ir{};
+
+    SourceFiles const files = {{"benchmark.etch", source}};
+    if (!compiler_->Compile(files, "benchmark", ir, errors) ||
+        !vm_->GenerateExecutable(ir, "benchmark", executable_, errors))
+    {
+      throw std::runtime_error{"Unable to compile benchmark script"};
+    }
+  }
+
+  bool Run(int32_t n)
+  {
+    std::string error{};
+    Variant     output{};
+
+    return vm_->Execute(executable_, "main", error, output, n);
+  }
+
+private:
+  Module                    module_{};
+  std::unique_ptr<Compiler> compiler_;
+  std::unique_ptr<VM>       vm_;
+  Executable                executable_{};
+};
+
+void RunScript(::benchmark::State &state, std::string const &source)
+{
+  Script     script{source};
+  auto const n = static_cast<int32_t>(state.range(0));
+
+  for (auto _ : state)
+  {
+    if (!script.Run(n))
+    {
+      state.SkipWithError("Script execution failed");
+      break;
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_IntegerLoop(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Int64
+      var total = 0i64;
+      for (i in 0:n)
+        total += toInt64(i) * 3i64 + 1i64;
+      endfor
+      return total;
+    endfunction
+  )");
+}
+
+void BM_WhileLoop(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Int32
+      var i = 0;
+      var total = 0;
+      while (i < n)
+        if (i % 2 == 0)
+          total += i;
+        else
+          total -= 1;
+        endif
+        i++;
+      endwhile
+      return total;
+    endfunction
+  )");
+}
+
+void BM_Arithmetic(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Int64
+      var a = 1i64;
+      var b = 2i64;
+      var c = 3i64;
+      for (i in 0:n)
+        a = a * 3i64 + b - c;
+        b = (b + a) % 1000003i64;
+        c = c * 7i64 - a / 5i64 + b;
+        a = a % 1000033i64;
+        c = c % 1000037i64;
+        if (a < b)
+          a += c;
+        endif
+      endfor
+      return a + b + c;
+    endfunction
+  )");
+}
+
+void BM_FixedPointLoop(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Fixed64
+      var total = 0.0fp64;
+      for (i in 0:n)
+        total = total * 0.5fp64 + 1.5fp64;
+      endfor
+      return total;
+    endfunction
+  )");
+}
+
+void BM_FunctionCalls(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function add(a : Int64, b : Int64) : Int64
+      return a + b;
+    endfunction
+
+    function main(n : Int32) : Int64
+      var total = 0i64;
+      for (i in 0:n)
+        total = add(total, toInt64(i));
+      endfor
+      return total;
+    endfunction
+  )");
+}
+
+void BM_ArrayReadWrite(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Int64
+      var values = Array<Int64>(n);
+      for (i in 0:n)
+        values[i] = toInt64(i);
+      endfor
+      var total = 0i64;
+      for (i in 0:n)
+        total += values[i];
+      endfor
+      return total;
+    endfunction
+  )");
+}
+
+void BM_ArrayAppend(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Int32
+      var values = Array<Int32>(0);
+      for (i in 0:n)
+        values.append(i);
+      endfor
+      return values.count();
+    endfunction
+  )");
+}
+
+void BM_ArrayOfObjects(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Int32
+      var total = 0;
+      for (i in 0:n)
+        var words : Array<String> = {"alpha", "beta", "gamma"};
+        total += words[1].length();
+      endfor
+      return total;
+    endfunction
+  )");
+}
+
+void BM_MapInsertLookup(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Int64
+      var values = Map<Int32, Int64>();
+      for (i in 0:n)
+        values[i] = toInt64(i);
+      endfor
+      var total = 0i64;
+      for (i in 0:n)
+        total += values[i];
+      endfor
+      return total;
+    endfunction
+  )");
+}
+
+void BM_MapStringKeys(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Int64
+      var keys : Array<String> = {"alpha", "beta", "gamma", "delta"};
+      var values = Map<String, Int64>();
+      for (i in 0:n)
+        var key = keys[i % 4];
+        if (values.count() < 4)
+          values[key] = 0i64;
+        endif
+        values[key] = values[key] + 1i64;
+      endfor
+      return values["alpha"];
+    endfunction
+  )");
+}
+
+void BM_StringConcatenation(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Int32
+      var text = "";
+      for (i in 0:n)
+        text = text + "ab";
+      endfor
+      return text.length();
+    endfunction
+  )");
+}
+
+void BM_StringOperations(::benchmark::State &state)
+{
+  RunScript(state, R"(
+    function main(n : Int32) : Int32
+      var total = 0;
+      for (i in 0:n)
+        var text = "  The quick brown fox  ";
+        text.trim();
+        total += text.find("fox") + text.length();
+        if (text == "The quick brown fox")
+          total += 1;
+        endif
+      endfor
+      return total;
+    endfunction
+  )");
+}
+
+}  // namespace
+
+BENCHMARK(BM_IntegerLoop)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_WhileLoop)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_Arithmetic)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_FixedPointLoop)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_FunctionCalls)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_ArrayReadWrite)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_ArrayAppend)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_ArrayOfObjects)->Range(1 << 10, 1 << 14);
+BENCHMARK(BM_MapInsertLookup)->Range(1 << 10, 1 << 14);
+BENCHMARK(BM_MapStringKeys)->Range(1 << 10, 1 << 14);
+BENCHMARK(BM_StringConcatenation)->Range(1 << 8, 1 << 12);
+BENCHMARK(BM_StringOperations)->Range(1 << 10, 1 << 14);
+
+}  // namespace interpreter
+}  // namespace benchmark
+}  // namespace vm
@@ -227,6 +227,9 @@ private:
   };
   using FileErrorsArray = std::vector<FileErrors>;
 
+  // (caller, callee) pairs of user defined functions, used to propagate the state keys
+  using FunctionCallArray = std::vector<std::pair<FunctionPtr, FunctionPtr>>;
+
   std::vector<std::string> GetErrorList()
   {
     std::vector<std::string> list;
@@ -310,6 +313,7 @@ private:
   uint16_t          num_user_defined_instantiation_types_{};
   FunctionPtr       function_;
   NodePtr           use_any_node_;
+  FunctionCallArray function_calls_;
   FileErrorsArray   file_errors_array_;
 
   void AddError(uint16_t line, std::string const &message);
@@ -388,6 +392,10 @@ private:
   bool AnnotateArithmetic(ExpressionNodePtr const &node, ExpressionNodePtr const &lhs,
                           ExpressionNodePtr const &rhs);
 
+  void AddStateKey(std::string const &state_name, TypePtr const &type, NodePtr const &key_node);
+  void AddFunctionCall(FunctionPtr const &callee);
+  void PropagateStateKeys();
+
   FunctionPtr FindFunction(TypePtr const &type, FunctionGroupPtr const &function_group,
                            ExpressionNodePtrArray const &parameter_nodes);
   TypePtr     ConvertNode(ExpressionNodePtr const &node, TypePtr const &expected_type);
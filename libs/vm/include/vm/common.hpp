@@ -260,6 +260,9 @@ struct FunctionInfo
 };
 using FunctionInfoArray = std::vector<FunctionInfo>;
 
+// The persistent state keys which a function is known to access
+using StateKeys = std::vector<std::string>;
+
 using DeserializeConstructorMap = std::unordered_map<TypeIndex, DefaultConstructorHandler>;
 using CPPCopyConstructorMap     = std::unordered_map<TypeIndex, CPPCopyConstructorHandler>;
 
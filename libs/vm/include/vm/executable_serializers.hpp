@@ -0,0 +1,493 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/base_types.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vm/common.hpp"
+#include "vm/generator.hpp"
+#include "vm/variant.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fetch {
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<vm::AnnotationLiteral, D>
+{
+public:
+  using Type       = vm::AnnotationLiteral;
+  using DriverType = D;
+
+  static uint8_t const TYPE  = 1;
+  static uint8_t const VALUE = 2;
+  static uint8_t const STR   = 3;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &literal)
+  {
+    int64_t value{0};
+    if (literal.type == vm::AnnotationLiteralType::Boolean)
+    {
+      value = literal.boolean ? 1 : 0;
+    }
+    else if (literal.type == vm::AnnotationLiteralType::Integer)
+    {
+      value = literal.integer;
+    }
+
+    auto map = map_constructor(3);
+    map.Append(TYPE, static_cast<uint8_t>(literal.type));
+    map.Append(VALUE, value);
+    map.Append(STR, literal.str);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &literal)
+  {
+    uint8_t type{0};
+    int64_t value{0};
+
+    map.ExpectKeyGetValue(TYPE, type);
+    map.ExpectKeyGetValue(VALUE, value);
+    map.ExpectKeyGetValue(STR, literal.str);
+
+    literal.type = static_cast<vm::AnnotationLiteralType>(type);
+    if (literal.type == vm::AnnotationLiteralType::Boolean)
+    {
+      literal.boolean = (value != 0);
+    }
+    else if (literal.type == vm::AnnotationLiteralType::Integer)
+    {
+      literal.integer = value;
+    }
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::AnnotationElement, D>
+{
+public:
+  using Type       = vm::AnnotationElement;
+  using DriverType = D;
+
+  static uint8_t const TYPE  = 1;
+  static uint8_t const NAME  = 2;
+  static uint8_t const VALUE = 3;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &element)
+  {
+    auto map = map_constructor(3);
+    map.Append(TYPE, static_cast<uint8_t>(element.type));
+    map.Append(NAME, element.name);
+    map.Append(VALUE, element.value);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &element)
+  {
+    uint8_t type{0};
+
+    map.ExpectKeyGetValue(TYPE, type);
+    map.ExpectKeyGetValue(NAME, element.name);
+    map.ExpectKeyGetValue(VALUE, element.value);
+
+    element.type = static_cast<vm::AnnotationElementType>(type);
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::Annotation, D>
+{
+public:
+  using Type       = vm::Annotation;
+  using DriverType = D;
+
+  static uint8_t const NAME     = 1;
+  static uint8_t const ELEMENTS = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &annotation)
+  {
+    auto map = map_constructor(2);
+    map.Append(NAME, annotation.name);
+    map.Append(ELEMENTS, annotation.elements);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &annotation)
+  {
+    map.ExpectKeyGetValue(NAME, annotation.name);
+    map.ExpectKeyGetValue(ELEMENTS, annotation.elements);
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::TypeInfo, D>
+{
+public:
+  using Type       = vm::TypeInfo;
+  using DriverType = D;
+
+  static uint8_t const KIND                        = 1;
+  static uint8_t const NAME                        = 2;
+  static uint8_t const TYPE_ID                     = 3;
+  static uint8_t const TEMPLATE_TYPE_ID            = 4;
+  static uint8_t const TEMPLATE_PARAMETER_TYPE_IDS = 5;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &info)
+  {
+    auto map = map_constructor(5);
+    map.Append(KIND, static_cast<uint8_t>(info.kind));
+    map.Append(NAME, info.name);
+    map.Append(TYPE_ID, info.type_id);
+    map.Append(TEMPLATE_TYPE_ID, info.template_type_id);
+    map.Append(TEMPLATE_PARAMETER_TYPE_IDS, info.template_parameter_type_ids);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &info)
+  {
+    uint8_t kind{0};
+
+    map.ExpectKeyGetValue(KIND, kind);
+    map.ExpectKeyGetValue(NAME, info.name);
+    map.ExpectKeyGetValue(TYPE_ID, info.type_id);
+    map.ExpectKeyGetValue(TEMPLATE_TYPE_ID, info.template_type_id);
+    map.ExpectKeyGetValue(TEMPLATE_PARAMETER_TYPE_IDS, info.template_parameter_type_ids);
+
+    info.kind = static_cast<vm::TypeKind>(kind);
+  }
+};
+
+template <typename D>
+struct ArraySerializer<vm::Executable::Instruction, D>
+{
+public:
+  using Type       = vm::Executable::Instruction;
+  using DriverType = D;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &array_constructor, Type const &instruction)
+  {
+    auto array = array_constructor(4);
+    array.Append(instruction.opcode);
+    array.Append(instruction.type_id);
+    array.Append(instruction.index);
+    array.Append(instruction.data);
+  }
+
+  template <typename ArrayDeserializer>
+  static void Deserialize(ArrayDeserializer &array, Type &instruction)
+  {
+    array.GetNextValue(instruction.opcode);
+    array.GetNextValue(instruction.type_id);
+    array.GetNextValue(instruction.index);
+    array.GetNextValue(instruction.data);
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::Executable::Parameter, D>
+{
+public:
+  using Type       = vm::Executable::Parameter;
+  using DriverType = D;
+
+  static uint8_t const NAME    = 1;
+  static uint8_t const TYPE_ID = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &parameter)
+  {
+    auto map = map_constructor(2);
+    map.Append(NAME, parameter.name);
+    map.Append(TYPE_ID, parameter.type_id);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &parameter)
+  {
+    map.ExpectKeyGetValue(NAME, parameter.name);
+    map.ExpectKeyGetValue(TYPE_ID, parameter.type_id);
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::Executable::Variable, D>
+{
+public:
+  using Type       = vm::Executable::Variable;
+  using DriverType = D;
+
+  static uint8_t const NAME         = 1;
+  static uint8_t const TYPE_ID      = 2;
+  static uint8_t const KIND         = 3;
+  static uint8_t const SCOPE_NUMBER = 4;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &variable)
+  {
+    auto map = map_constructor(4);
+    map.Append(NAME, variable.name);
+    map.Append(TYPE_ID, variable.type_id);
+    map.Append(KIND, static_cast<uint8_t>(variable.kind));
+    map.Append(SCOPE_NUMBER, variable.scope_number);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &variable)
+  {
+    uint8_t kind{0};
+
+    map.ExpectKeyGetValue(NAME, variable.name);
+    map.ExpectKeyGetValue(TYPE_ID, variable.type_id);
+    map.ExpectKeyGetValue(KIND, kind);
+    map.ExpectKeyGetValue(SCOPE_NUMBER, variable.scope_number);
+
+    variable.kind = static_cast<vm::VariableKind>(kind);
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::Executable::Function, D>
+{
+public:
+  using Type       = vm::Executable::Function;
+  using DriverType = D;
+
+  static uint8_t const KIND                = 1;
+  static uint8_t const NAME                = 2;
+  static uint8_t const ANNOTATIONS         = 3;
+  static uint8_t const RETURN_TYPE_ID      = 4;
+  static uint8_t const NUM_PARAMETERS      = 5;
+  static uint8_t const PARAMETERS          = 6;
+  static uint8_t const NUM_VARIABLES       = 7;
+  static uint8_t const VARIABLES           = 8;
+  static uint8_t const INSTRUCTIONS        = 9;
+  static uint8_t const PC_TO_LINE_MAP      = 10;
+  static uint8_t const STATE_KEYS          = 11;
+  static uint8_t const STATE_KEYS_COMPLETE = 12;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &function)
+  {
+    auto map = map_constructor(12);
+    map.Append(KIND, static_cast<uint8_t>(function.kind));
+    map.Append(NAME, function.name);
+    map.Append(ANNOTATIONS, function.annotations);
+    map.Append(RETURN_TYPE_ID, function.return_type_id);
+    map.Append(NUM_PARAMETERS, static_cast<int32_t>(function.num_parameters));
+    map.Append(PARAMETERS, function.parameters);
+    map.Append(NUM_VARIABLES, static_cast<int32_t>(function.num_variables));
+    map.Append(VARIABLES, function.variables);
+    map.Append(INSTRUCTIONS, function.instructions);
+    map.Append(PC_TO_LINE_MAP, function.pc_to_line_map);
+    map.Append(STATE_KEYS, function.state_keys);
+    map.Append(STATE_KEYS_COMPLETE, function.state_keys_complete);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &function)
+  {
+    uint8_t kind{0};
+    int32_t num_parameters{0};
+    int32_t num_variables{0};
+
+    map.ExpectKeyGetValue(KIND, kind);
+    map.ExpectKeyGetValue(NAME, function.name);
+    map.ExpectKeyGetValue(ANNOTATIONS, function.annotations);
+    map.ExpectKeyGetValue(RETURN_TYPE_ID, function.return_type_id);
+    map.ExpectKeyGetValue(NUM_PARAMETERS, num_parameters);
+    map.ExpectKeyGetValue(PARAMETERS, function.parameters);
+    map.ExpectKeyGetValue(NUM_VARIABLES, num_variables);
+    map.ExpectKeyGetValue(VARIABLES, function.variables);
+    map.ExpectKeyGetValue(INSTRUCTIONS, function.instructions);
+    map.ExpectKeyGetValue(PC_TO_LINE_MAP, function.pc_to_line_map);
+    map.ExpectKeyGetValue(STATE_KEYS, function.state_keys);
+    map.ExpectKeyGetValue(STATE_KEYS_COMPLETE, function.state_keys_complete);
+
+    function.kind           = static_cast<vm::FunctionKind>(kind);
+    function.num_parameters = num_parameters;
+    function.num_variables  = num_variables;
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::Executable::Contract, D>
+{
+public:
+  using Type       = vm::Executable::Contract;
+  using DriverType = D;
+
+  static uint8_t const NAME      = 1;
+  static uint8_t const FUNCTIONS = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &contract)
+  {
+    auto map = map_constructor(2);
+    map.Append(NAME, contract.name);
+    map.Append(FUNCTIONS, contract.functions);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &contract)
+  {
+    map.ExpectKeyGetValue(NAME, contract.name);
+    map.ExpectKeyGetValue(FUNCTIONS, contract.functions);
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::Executable::UserDefinedType, D>
+{
+public:
+  using Type       = vm::Executable::UserDefinedType;
+  using DriverType = D;
+
+  static uint8_t const NAME      = 1;
+  static uint8_t const FUNCTIONS = 2;
+  static uint8_t const VARIABLES = 3;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &type)
+  {
+    auto map = map_constructor(3);
+    map.Append(NAME, type.name);
+    map.Append(FUNCTIONS, type.functions);
+    map.Append(VARIABLES, type.variables);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &type)
+  {
+    map.ExpectKeyGetValue(NAME, type.name);
+    map.ExpectKeyGetValue(FUNCTIONS, type.functions);
+    map.ExpectKeyGetValue(VARIABLES, type.variables);
+  }
+};
+
+/**
+ * Serializes a fully generated executable so that it can be stored and later executed without
+ * being compiled again. An executable is only valid for a VM with an identical set of registered
+ * types and opcodes to the one which generated it, see VM::LayoutSignature.
+ */
+template <typename D>
+struct MapSerializer<vm::Executable, D>
+{
+public:
+  using Type       = vm::Executable;
+  using DriverType = D;
+
+  static uint8_t const NAME                             = 1;
+  static uint8_t const STRINGS                          = 2;
+  static uint8_t const CONSTANT_TYPE_IDS                = 3;
+  static uint8_t const CONSTANT_VALUES                  = 4;
+  static uint8_t const LARGE_CONSTANTS                  = 5;
+  static uint8_t const TYPES                            = 6;
+  static uint8_t const CONTRACTS                        = 7;
+  static uint8_t const FUNCTIONS                        = 8;
+  static uint8_t const USER_DEFINED_TYPES               = 9;
+  static uint8_t const NUM_SYSTEM_TYPES                 = 10;
+  static uint8_t const USER_DEFINED_TYPES_START_TYPE_ID = 11;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &executable)
+  {
+    // the constants are always primitives, so only the raw value needs to be stored
+    std::vector<vm::TypeId> constant_type_ids{};
+    std::vector<uint64_t>   constant_values{};
+    for (auto const &constant : executable.constants)
+    {
+      constant_type_ids.push_back(constant.type_id);
+      constant_values.push_back(constant.primitive.ui64);
+    }
+
+    // the only large constants are 128 bit fixed point numbers
+    std::vector<fixed_point::fp128_t> large_constants{};
+    for (auto const &constant : executable.large_constants)
+    {
+      large_constants.push_back(constant.fp128);
+    }
+
+    auto map = map_constructor(11);
+    map.Append(NAME, executable.name);
+    map.Append(STRINGS, executable.strings);
+    map.Append(CONSTANT_TYPE_IDS, constant_type_ids);
+    map.Append(CONSTANT_VALUES, constant_values);
+    map.Append(LARGE_CONSTANTS, large_constants);
+    map.Append(TYPES, executable.types);
+    map.Append(CONTRACTS, executable.contracts);
+    map.Append(FUNCTIONS, executable.functions);
+    map.Append(USER_DEFINED_TYPES, executable.user_defined_types);
+    map.Append(NUM_SYSTEM_TYPES, executable.num_system_types);
+    map.Append(USER_DEFINED_TYPES_START_TYPE_ID, executable.user_defined_types_start_type_id);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &executable)
+  {
+    std::vector<vm::TypeId>           constant_type_ids{};
+    std::vector<uint64_t>             constant_values{};
+    std::vector<fixed_point::fp128_t> large_constants{};
+
+    map.ExpectKeyGetValue(NAME, executable.name);
+    map.ExpectKeyGetValue(STRINGS, executable.strings);
+    map.ExpectKeyGetValue(CONSTANT_TYPE_IDS, constant_type_ids);
+    map.ExpectKeyGetValue(CONSTANT_VALUES, constant_values);
+    map.ExpectKeyGetValue(LARGE_CONSTANTS, large_constants);
+    map.ExpectKeyGetValue(TYPES, executable.types);
+    map.ExpectKeyGetValue(CONTRACTS, executable.contracts);
+    map.ExpectKeyGetValue(FUNCTIONS, executable.functions);
+    map.ExpectKeyGetValue(USER_DEFINED_TYPES, executable.user_defined_types);
+    map.ExpectKeyGetValue(NUM_SYSTEM_TYPES, executable.num_system_types);
+    map.ExpectKeyGetValue(USER_DEFINED_TYPES_START_TYPE_ID,
+                          executable.user_defined_types_start_type_id);
+
+    if (constant_type_ids.size() != constant_values.size())
+    {
+      throw SerializableException(std::string("mismatched executable constants"));
+    }
+
+    executable.constants.clear();
+    for (std::size_t i = 0; i < constant_type_ids.size(); ++i)
+    {
+      vm::Primitive primitive{};
+      primitive.ui64 = constant_values[i];
+      executable.constants.emplace_back(primitive, constant_type_ids[i]);
+    }
+
+    executable.large_constants.clear();
+    for (auto const &constant : large_constants)
+    {
+      executable.large_constants.emplace_back(constant);
+    }
+  }
+};
+
+}  // namespace serializers
+
+}  // namespace fetch
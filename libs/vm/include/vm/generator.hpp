@@ -103,6 +103,7 @@ struct Executable
 
   struct Instruction
   {
+    Instruction() = default;
     explicit Instruction(uint16_t opcode__)
       : opcode{opcode__}
     {}
@@ -116,6 +117,7 @@ struct Executable
 
   struct Parameter
   {
+    Parameter() = default;
     Parameter(std::string name__, TypeId type_id__)
       : name{std::move(name__)}
       , type_id{type_id__}
@@ -127,6 +129,7 @@ struct Executable
 
   struct Variable : public Parameter
   {
+    Variable() = default;
     Variable(VariableKind kind__, std::string name, TypeId type_id, uint16_t scope_number__)
       : Parameter(std::move(name), type_id)
       , kind{kind__}
@@ -182,11 +185,14 @@ struct Executable
     VariableArray    variables;        // parameters + locals
     InstructionArray instructions;
     PcToLineMap      pc_to_line_map;
+    StateKeys        state_keys;                 // persistent state keys accessed by the function
+    bool             state_keys_complete{true};  // false if some keys are only known at runtime
   };
   using FunctionArray = std::vector<Function>;
 
   struct Contract
   {
+    Contract() = default;
     explicit Contract(std::string name__)
       : name{std::move(name__)}
     {}
@@ -203,6 +209,7 @@ struct Executable
 
   struct UserDefinedType
   {
+    UserDefinedType() = default;
     explicit UserDefinedType(std::string name__)
       : name{std::move(name__)}
     {}
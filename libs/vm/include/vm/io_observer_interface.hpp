@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace fetch {
 namespace vm {
@@ -29,6 +30,8 @@ namespace vm {
 class IoObserverInterface
 {
 public:
+  using Keys = std::vector<std::string>;
+
   // Construction / Destruction
   IoObserverInterface()          = default;
   virtual ~IoObserverInterface() = default;
@@ -77,6 +80,27 @@ public:
   virtual Status Exists(std::string const &key) = 0;
 
   /// @}
+
+  /// @name Batched State Interface
+  /// @{
+
+  /**
+   * Read a batch of values from the state store ahead of them being accessed
+   *
+   * Implementations can use this to fetch all of the keys in a single request so that subsequent
+   * calls to Read or Exists for these keys do not require a further round trip. By default this is
+   * a no-op.
+   *
+   * @param keys The keys to be read
+   * @return OK if the batch was read, PERMISSION_DENIED if any of the keys are incorrect, otherwise
+   * ERROR
+   */
+  virtual Status ReadBatch(Keys const & /*keys*/)
+  {
+    return Status::OK;
+  }
+
+  /// @}
 };
 
 }  // namespace vm
@@ -150,6 +150,8 @@ struct IRFunction
   IRTypePtrArray     parameter_types;
   IRVariablePtrArray parameter_variables;
   IRTypePtr          return_type;
+  StateKeys          state_keys;
+  bool               state_keys_complete{true};
   // only used during code generation
   uint16_t id{};
 };
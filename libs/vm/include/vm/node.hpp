@@ -262,6 +262,9 @@ struct Function
   VariablePtrArray parameter_variables;
   TypePtr          return_type;
   uint16_t         num_locals{};
+  // State keys accessed by the function, complete only if every key is statically determinable
+  StateKeys state_keys;
+  bool      state_keys_complete{true};
 };
 using FunctionPtr      = std::shared_ptr<Function>;
 using FunctionPtrArray = std::vector<FunctionPtr>;
@@ -22,7 +22,9 @@
 #include "variant/variant.hpp"
 #include "vectorise/fixed_point/fixed_point.hpp"
 #include "vm/common.hpp"
+#include "vm/object_arena.hpp"
 
+#include <cstddef>
 #include <type_traits>
 
 namespace fetch {
@@ -149,6 +151,17 @@ public:
     , ref_count_(1)
   {}
 
+  // objects are allocated from the arena of the executing VM (when there is one)
+  static void *operator new(std::size_t size)
+  {
+    return ObjectArena::Allocate(size);
+  }
+
+  static void operator delete(void *ptr) noexcept
+  {
+    ObjectArena::Deallocate(ptr);
+  }
+
   virtual std::size_t GetHashCode();
   virtual bool        IsEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso);
   virtual bool        IsNotEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso);
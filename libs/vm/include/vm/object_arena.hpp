@@ -0,0 +1,139 @@
+#pragma once
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * Bump allocator for the objects created during a single VM invocation.
+ *
+ * While an arena is active on a thread (see `ObjectArena::Scope`) all VM objects created on that
+ * thread are carved out of large chunks rather than being individually allocated from the heap.
+ * Objects which die during the invocation are returned to a per size free list so that they can
+ * be reused straight away.
+ *
+ * Once the invocation is complete and every object has been released the whole arena is rewound
+ * in constant time. If any object survives the invocation (for example a return value, or an
+ * object held by the host) it keeps the arena alive: the owner retires the arena and starts a new
+ * one, and the retired arena is freed along with its last object.
+ *
+ * Objects created while no arena is active, or which are too large, come from the heap.
+ */
+class ObjectArena
+{
+public:
+  static constexpr std::size_t CHUNK_SIZE      = 64u * 1024u;
+  static constexpr std::size_t MAX_OBJECT_SIZE = 512u;
+
+  /**
+   * Activates an arena on the current thread, restoring the previously active arena (if any) on
+   * destruction
+   */
+  class Scope
+  {
+  public:
+    explicit Scope(ObjectArena &arena);
+    Scope(Scope const &) = delete;
+    Scope(Scope &&)      = delete;
+    ~Scope();
+
+    Scope &operator=(Scope const &) = delete;
+    Scope &operator=(Scope &&) = delete;
+
+  private:
+    ObjectArena *previous_;
+  };
+
+  struct Retirer
+  {
+    void operator()(ObjectArena *arena) const noexcept;
+  };
+
+  using ArenaPtr = std::unique_ptr<ObjectArena, Retirer>;
+
+  static ArenaPtr Create();
+
+  /// @name Allocation
+  /// @{
+  static void *Allocate(std::size_t size);
+  static void  Deallocate(void *ptr) noexcept;
+  /// @}
+
+  /// @name Lifetime
+  /// @{
+  bool        Rewind();
+  std::size_t num_live_objects() const;
+  std::size_t num_chunks() const;
+  /// @}
+
+  ObjectArena(ObjectArena const &) = delete;
+  ObjectArena(ObjectArena &&)      = delete;
+
+  ObjectArena &operator=(ObjectArena const &) = delete;
+  ObjectArena &operator=(ObjectArena &&) = delete;
+
+private:
+  static constexpr std::size_t ALIGNMENT        = 16u;
+  static constexpr std::size_t NUM_SIZE_CLASSES = MAX_OBJECT_SIZE / ALIGNMENT;
+
+  struct alignas(ALIGNMENT) Header
+  {
+    ObjectArena *arena;       ///< The owning arena, or nullptr for heap allocations
+    std::size_t  size_class;  ///< The index of the free list for the block
+  };
+
+  struct FreeBlock
+  {
+    FreeBlock *next;
+  };
+
+  struct alignas(ALIGNMENT) Chunk
+  {
+    uint8_t data[CHUNK_SIZE];
+  };
+
+  using Chunks    = std::vector<std::unique_ptr<Chunk>>;
+  using FreeLists = std::array<FreeBlock *, NUM_SIZE_CLASSES>;
+
+  // Construction / Destruction
+  ObjectArena();
+  ~ObjectArena() = default;
+
+  void *AllocateBlock(std::size_t size_class);
+  void  Free(Header *header) noexcept;
+  void  Release() noexcept;
+
+  Chunks                   chunks_{};
+  std::size_t              current_chunk_{0};  ///< The index of the chunk being bump allocated
+  std::size_t              offset_{0};         ///< The bump offset into the current chunk
+  FreeLists                free_lists_{};
+  std::atomic<std::size_t> references_{1};  ///< The live objects, plus one for the owner
+  std::atomic<bool>        retired_{false};
+};
+
+}  // namespace vm
+}  // namespace fetch
@@ -0,0 +1,64 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/generator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * Optional peephole optimisation pass over generated Etch bytecode.
+ *
+ * The pass only rewrites short straight-line instruction sequences which can not be entered by a
+ * jump part way through:
+ *
+ * - Constant folding: integer arithmetic on two constants is replaced by the (non-overflowing)
+ *   result.
+ * - Dead value / store elimination: values which are pushed only to be discarded, self
+ *   assignments and stores of constants which are immediately overwritten are removed.
+ * - Superinstructions: the read-modify-write sequence generated for `x = x <op> y` on primitive
+ *   local variables is fused into the corresponding in-place instruction.
+ *
+ * Since optimised code executes fewer instructions it is also charged less, therefore it must only
+ * be enabled when every party executing a contract has agreed to do so.
+ */
+class Optimiser
+{
+public:
+  using OpcodePair       = std::pair<uint16_t, uint16_t>;
+  using OpcodePairCounts = std::map<OpcodePair, uint64_t>;
+
+  struct Statistics
+  {
+    std::size_t folded_constants{0};         ///< The number of constant expressions folded
+    std::size_t eliminated_instructions{0};  ///< The number of dead instructions removed
+    std::size_t fused_instructions{0};       ///< The number of superinstructions generated
+  };
+
+  static OpcodePairCounts CountOpcodePairs(Executable const &executable);
+  static Statistics       Optimise(Executable &executable);
+};
+
+}  // namespace vm
+}  // namespace fetch
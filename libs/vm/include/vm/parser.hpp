@@ -76,6 +76,12 @@ private:
 
   using StringSet = std::unordered_set<std::string>;
 
+  struct FileResult
+  {
+    BlockNodePtr             node{};
+    std::vector<std::string> errors{};
+  };
+
   struct Block
   {
     BlockNodePtr node;
@@ -96,6 +102,7 @@ private:
   std::vector<Expr>        rpn_;
   std::vector<Expr>        infix_stack_;
 
+  void              ParseFile(SourceFile const &file, FileResult &result);
   void              Tokenise(std::string const &source);
   bool              IsCodeBlock(NodeKind block_kind) const;
   bool              ParseBlock(BlockNodePtr const &block_node);
@@ -0,0 +1,104 @@
+#pragma once
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/common.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * Collects an execution profile from one or more VM invocations.
+ *
+ * When a profiler is attached to a VM every instruction is counted and timed, along with the
+ * charge that it contributed (static and dynamic), both per opcode and per function. In addition
+ * the call stack is sampled every `sample_interval` instructions, which can be written out in the
+ * "folded stacks" format understood by the common flamegraph tools.
+ *
+ * Profiling is only intended for diagnostics, no profiler is attached to a VM by default.
+ */
+class Profiler
+{
+public:
+  using Clock       = std::chrono::steady_clock;
+  using Duration    = Clock::duration;
+  using ChargeTable = std::unordered_map<std::string, ChargeAmount>;
+
+  static constexpr uint64_t DEFAULT_SAMPLE_INTERVAL = 100;
+
+  struct Entry
+  {
+    uint64_t     count{0};     ///< The number of instructions executed
+    ChargeAmount charge{0};    ///< The total charge of the instructions
+    uint64_t     duration{0};  ///< The total wall time of the instructions (ns)
+  };
+
+  using Entries      = std::unordered_map<std::string, Entry>;
+  using StackSamples = std::unordered_map<std::string, uint64_t>;
+
+  // Construction / Destruction
+  explicit Profiler(uint64_t sample_interval = DEFAULT_SAMPLE_INTERVAL);
+  Profiler(Profiler const &) = default;
+  Profiler(Profiler &&)      = default;
+  ~Profiler()                = default;
+
+  /// @name Recording
+  /// @{
+  bool ShouldSample();
+  void RecordSample(std::string const &stack);
+  void RecordInstruction(std::string const &function, std::string const &opcode,
+                         ChargeAmount charge, Duration duration);
+  void Merge(Profiler const &other);
+  void Clear();
+  /// @}
+
+  /// @name Results
+  /// @{
+  Entries const &     opcodes() const;
+  Entries const &     functions() const;
+  StackSamples const &samples() const;
+  uint64_t            sample_interval() const;
+  /// @}
+
+  /// @name Reporting
+  /// @{
+  void        WriteFoldedStacks(std::ostream &stream, std::string const &root = "") const;
+  ChargeTable EstimateStaticCharges() const;
+  /// @}
+
+  // Operators
+  Profiler &operator=(Profiler const &) = default;
+  Profiler &operator=(Profiler &&) = default;
+
+private:
+  uint64_t     sample_interval_;
+  uint64_t     until_sample_;
+  Entries      opcodes_{};
+  Entries      functions_{};
+  StackSamples samples_{};
+};
+
+}  // namespace vm
+}  // namespace fetch
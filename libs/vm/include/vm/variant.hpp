@@ -269,6 +269,13 @@ struct Variant
 
   Variant &operator=(Variant const &other) noexcept
   {
+    // Fast path: primitive to primitive, the overwhelmingly common case on the stack
+    if (IsPrimitive() && other.IsPrimitive())
+    {
+      primitive = other.primitive;
+      type_id   = other.type_id;
+      return *this;
+    }
     if (this != &other)
     {
       bool const is_object       = !IsPrimitive();
@@ -307,6 +314,14 @@ struct Variant
 
   Variant &operator=(Variant &&other) noexcept
   {
+    // Fast path: primitive to primitive, no reference counts are involved
+    if (IsPrimitive() && other.IsPrimitive())
+    {
+      primitive     = other.primitive;
+      type_id       = other.type_id;
+      other.type_id = TypeIds::Unknown;
+      return *this;
+    }
     if (this != &other)
     {
       bool const is_object       = !IsPrimitive();
@@ -473,6 +488,11 @@ struct Variant
     type_id = TypeIds::Unknown;
   }
 };
+
+// The stack is a flat array of variants, keep each one to two machine words
+static_assert(sizeof(Primitive) == 8, "Primitive must fit in a single machine word");
+static_assert(sizeof(Variant) == 16, "Variant must be a compact tagged value");
+
 using VariantArray = std::vector<Variant>;
 
 struct TemplateParameter1 : Variant
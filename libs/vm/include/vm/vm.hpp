@@ -21,6 +21,7 @@
 #include "vm/common.hpp"
 #include "vm/generator.hpp"
 #include "vm/object.hpp"
+#include "vm/object_arena.hpp"
 #include "vm/opcodes.hpp"
 #include "vm/string.hpp"
 #include "vm/user_defined_object.hpp"
@@ -121,6 +122,7 @@ struct AssignParameters<POSITION>
 class IR;
 class IoObserverInterface;
 class Module;
+class Profiler;
 
 class VM;
 class ParameterPack
@@ -589,7 +591,14 @@ public:
   ChargeAmount GetChargeLimit() const;
   bool         ChargeLimitExceeded();
   void         SetChargeLimit(ChargeAmount limit);
+  void         SetBlockDispatch(bool enabled);
+  void         SetLegacyArithmetic(bool enabled);
+  bool         IsLegacyArithmetic() const;
+  void         SetProfiler(Profiler *profiler);
 
+  std::string LayoutSignature() const;
+
+  void Reset();
   void UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opcode_static_charges);
 
 private:
@@ -679,6 +688,35 @@ private:
   ChargeAmount charge_total_{0};
   /// @}
 
+  /// @name Block dispatch
+  /// @{
+  struct BlockCharge
+  {
+    ChargeAmount total{0};      ///< The charge from the instruction to the end of the block
+    ChargeAmount following{0};  ///< The charge of the instructions after it in the block
+  };
+
+  using BlockCharges   = std::vector<BlockCharge>;
+  using BlockChargeMap = std::unordered_map<Executable::Function const *, BlockCharges>;
+
+  bool                        block_dispatch_{true};
+  BlockChargeMap              block_charges_;            ///< Remaining block charge, per pc
+  Executable::Function const *block_function_{};         ///< The function being dispatched
+  BlockCharges const *        current_block_charges_{};  ///< The block charges of block_function_
+  /// @}
+
+  /// @name Arithmetic
+  /// @{
+  bool legacy_arithmetic_{false};  ///< Reproduce the UInt256 results of the initial block version
+  /// @}
+
+  /// @name Profiling
+  /// @{
+  Profiler *profiler_{};  ///< The (optional) profiler recording every instruction
+  /// @}
+
+  ObjectArena::ArenaPtr arena_{ObjectArena::Create()};  ///< The objects of the current invocation
+
   void AddOpcodeInfo(uint16_t opcode, std::string unique_name, Handler handler,
                      ChargeAmount static_charge = 1)
   {
@@ -689,6 +727,19 @@ private:
   bool Execute(std::string &error, Variant &output);
   void Destruct(uint16_t scope_number);
 
+  /// @name Block dispatch
+  /// @{
+  bool         ExecuteBlock();
+  void         DispatchBlockInstruction(uint16_t opcode);
+  BlockCharges CalculateBlockCharges(Executable::Function const &function) const;
+
+  static bool IsBlockInstruction(uint16_t opcode);
+  static bool IsBlockTerminator(uint16_t opcode);
+  /// @}
+
+  void        ExecuteProfiled(ChargeAmount charge_before);
+  std::string ProfileStack() const;
+
   TypeId FindType(std::string const &name) const
   {
     auto it = type_info_map_.find(name);
@@ -773,7 +824,7 @@ private:
     {
       if (rhso)
       {
-        if (EstimateCharge(this, ChargeEstimator<>([lhso, rhso]() -> ChargeAmount {
+        if (EstimateCharge(this, ChargeEstimator<>([&lhso, &rhso]() -> ChargeAmount {
                              return lhso->IsEqualChargeEstimator(lhso, rhso);
                            }),
                            std::tuple<>{}))
@@ -792,7 +843,7 @@ private:
     {
       if (rhso)
       {
-        if (EstimateCharge(this, ChargeEstimator<>([lhso, rhso]() -> ChargeAmount {
+        if (EstimateCharge(this, ChargeEstimator<>([&lhso, &rhso]() -> ChargeAmount {
                              return lhso->IsNotEqualChargeEstimator(lhso, rhso);
                            }),
                            std::tuple<>{}))
@@ -1594,7 +1645,7 @@ private:
     Variant &lhsv = Top();
     if (lhsv.object && rhsv.object)
     {
-      if (EstimateCharge(this, ChargeEstimator<>([lhsv, rhsv]() -> ChargeAmount {
+      if (EstimateCharge(this, ChargeEstimator<>([&lhsv, &rhsv]() -> ChargeAmount {
                            return Op::ApplyChargeEstimator(lhsv, rhsv);
                          }),
                          std::tuple<>{}))
@@ -1653,7 +1704,7 @@ private:
     Variant &lhsv = Top();
     if (lhsv.object && rhsv.object)
     {
-      if (EstimateCharge(this, ChargeEstimator<>([lhsv, rhsv]() -> ChargeAmount {
+      if (EstimateCharge(this, ChargeEstimator<>([&lhsv, &rhsv]() -> ChargeAmount {
                            return Op::ApplyChargeEstimator(lhsv.object, rhsv.object);
                          }),
                          std::tuple<>{}))
@@ -1678,7 +1729,7 @@ private:
         RuntimeError("null reference");
         return;
       }
-      if (EstimateCharge(this, ChargeEstimator<>([lhsv, rhsv]() -> ChargeAmount {
+      if (EstimateCharge(this, ChargeEstimator<>([&lhsv, &rhsv]() -> ChargeAmount {
                            return Op::ApplyChargeEstimator(lhsv, rhsv);
                          }),
                          std::tuple<>{}))
@@ -1703,7 +1754,7 @@ private:
         RuntimeError("null reference");
         return;
       }
-      if (EstimateCharge(this, ChargeEstimator<>([lhsv, rhsv]() -> ChargeAmount {
+      if (EstimateCharge(this, ChargeEstimator<>([&lhsv, &rhsv]() -> ChargeAmount {
                            return Op::ApplyChargeEstimator(lhsv, rhsv);
                          }),
                          std::tuple<>{}))
@@ -1738,7 +1789,7 @@ private:
     Variant &rhsv = Pop();
     if (lhso && rhsv.object)
     {
-      if (EstimateCharge(this, ChargeEstimator<>([lhso, rhsv]() -> ChargeAmount {
+      if (EstimateCharge(this, ChargeEstimator<>([&lhso, &rhsv]() -> ChargeAmount {
                            return Op::ApplyChargeEstimator(lhso, rhsv.object);
                          }),
                          std::tuple<>{}))
@@ -1762,7 +1813,7 @@ private:
         RuntimeError("null reference");
         return;
       }
-      if (EstimateCharge(this, ChargeEstimator<>([lhso, rhsv]() -> ChargeAmount {
+      if (EstimateCharge(this, ChargeEstimator<>([&lhso, &rhsv]() -> ChargeAmount {
                            return Op::ApplyChargeEstimator(lhso, rhsv);
                          }),
                          std::tuple<>{}))
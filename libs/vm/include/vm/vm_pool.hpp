@@ -0,0 +1,78 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+class Module;
+class VM;
+
+/**
+ * Thread safe pool of VM instances for a single module.
+ *
+ * Constructing a VM copies all of the type and function details from its module and builds the
+ * opcode tables, which is comparatively expensive. Instances which are released back to the pool
+ * are reset and kept (up to a limit) so that they can be handed straight back out again.
+ */
+class VMPool
+{
+public:
+  static constexpr std::size_t DEFAULT_MAX_IDLE = 4;
+
+  struct Releaser
+  {
+    VMPool *pool{nullptr};
+
+    void operator()(VM *vm) const;
+  };
+
+  using VMPtr = std::unique_ptr<VM, Releaser>;
+
+  // Construction / Destruction
+  explicit VMPool(Module *module, std::size_t max_idle = DEFAULT_MAX_IDLE);
+  VMPool(VMPool const &) = delete;
+  VMPool(VMPool &&)      = delete;
+  ~VMPool();
+
+  VMPtr       Acquire();
+  std::size_t num_idle() const;
+
+  // Operators
+  VMPool &operator=(VMPool const &) = delete;
+  VMPool &operator=(VMPool &&) = delete;
+
+private:
+  using IdleVMs = std::vector<std::unique_ptr<VM>>;
+
+  void Release(VM *vm);
+
+  Module *const     module_;
+  std::size_t const max_idle_;
+  mutable Mutex     lock_;
+  IdleVMs           idle_{};  ///< The reset instances which are ready to be reused
+};
+
+}  // namespace vm
+}  // namespace fetch
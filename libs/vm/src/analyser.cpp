@@ -26,6 +26,7 @@
 #include "vm/state.hpp"
 #include "vm/string.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -347,6 +348,7 @@ bool Analyser::Analyse(BlockNodePtr const &root, std::vector<std::string> &error
   num_user_defined_instantiation_types_ = 0;
   function_                             = nullptr;
   use_any_node_                         = nullptr;
+  function_calls_.clear();
   file_errors_array_.clear();
 
   root_->symbols = CreateSymbolTable();
@@ -373,10 +375,12 @@ bool Analyser::Analyse(BlockNodePtr const &root, std::vector<std::string> &error
       num_user_defined_instantiation_types_ = 0;
       function_                             = nullptr;
       use_any_node_                         = nullptr;
+      function_calls_.clear();
       file_errors_array_.clear();
       return false;
     }
     AnnotateBlock(root_);
+    PropagateStateKeys();
   }
   catch (FatalErrorException const &e)
   {
@@ -397,6 +401,7 @@ bool Analyser::Analyse(BlockNodePtr const &root, std::vector<std::string> &error
   num_user_defined_instantiation_types_ = 0;
   function_                             = nullptr;
   use_any_node_                         = nullptr;
+  function_calls_.clear();
 
   if (!file_errors_array_.empty())
   {
@@ -1628,6 +1633,7 @@ void Analyser::AnnotateBlock(BlockNodePtr const &block_node)
                                       : state_constructor_;
         child->function = constructor;
         use_any_node_->children.push_back(std::move(child));
+        AddStateKey(variable->name, variable->type, nullptr);
       }
     }
   }
@@ -1800,6 +1806,17 @@ void Analyser::AnnotateUseStatement(BlockNodePtr const &parent_block_node,
                                 : state_constructor_;
   variable_name_node->variable = variable;
   variable_name_node->function = constructor;
+  if (list_node)
+  {
+    for (auto const &key_node : list_node->children)
+    {
+      AddStateKey(state_name_node->text, type, key_node);
+    }
+  }
+  else
+  {
+    AddStateKey(state_name_node->text, type, nullptr);
+  }
 }
 
 void Analyser::AnnotateUseAnyStatement(BlockNodePtr const &parent_block_node,
@@ -2722,6 +2739,7 @@ bool Analyser::AnnotateInvokeOp(ExpressionNodePtr const &node)
     TypePtr return_type = ResolveReturnType(f->return_type, lhs->owner);
     SetRVExpression(node, return_type);
     node->function = f;
+    AddFunctionCall(f);
     return true;
   }
   if (lhs->IsTypeExpression())
@@ -2757,6 +2775,20 @@ bool Analyser::AnnotateInvokeOp(ExpressionNodePtr const &node)
     }
     SetRVExpression(node, lhs->type);
     node->function = f;
+    AddFunctionCall(f);
+    if (lhs->type->IsInstantiation() && (lhs->type->template_type == state_type_) &&
+        (parameter_nodes.size() == 1) && (parameter_nodes[0]->node_kind == NodeKind::String))
+    {
+      std::string const &text = parameter_nodes[0]->text;
+      AddStateKey(text.substr(1, text.size() - 2), lhs->type, nullptr);
+    }
+    else if (function_ && lhs->type->IsInstantiation() &&
+             ((lhs->type->template_type == state_type_) ||
+              (lhs->type->template_type == sharded_state_type_)))
+    {
+      // The name of the state is only known at runtime
+      function_->state_keys_complete = false;
+    }
     return true;
   }
   // lhs->IsVariableExpression()
@@ -2810,6 +2842,79 @@ bool Analyser::ConvertInitialiserListToArray(ExpressionNodePtr const &node, Type
   return true;
 }
 
+/**
+ * Record a persistent state key which is accessed by the function currently being annotated
+ *
+ * @param state_name The name of the state
+ * @param type The type of the state
+ * @param key_node The key expression for a sharded state, or null if no key was given
+ */
+void Analyser::AddStateKey(std::string const &state_name, TypePtr const &type,
+                           NodePtr const &key_node)
+{
+  if (!function_)
+  {
+    return;
+  }
+  std::string key = state_name;
+  if (type->IsInstantiation() && (type->template_type == sharded_state_type_))
+  {
+    // The keys of a sharded state can only be determined when they are given as string literals
+    if (!key_node || (key_node->node_kind != NodeKind::String))
+    {
+      function_->state_keys_complete = false;
+      return;
+    }
+    key += "." + key_node->text.substr(1, key_node->text.size() - 2);
+  }
+  StateKeys &keys = function_->state_keys;
+  if (std::find(keys.begin(), keys.end(), key) == keys.end())
+  {
+    keys.push_back(std::move(key));
+  }
+}
+
+void Analyser::AddFunctionCall(FunctionPtr const &callee)
+{
+  bool const is_user_defined = (callee->function_kind == FunctionKind::UserDefinedFreeFunction) ||
+                               (callee->function_kind == FunctionKind::UserDefinedConstructor) ||
+                               (callee->function_kind == FunctionKind::UserDefinedMemberFunction);
+  if (function_ && is_user_defined && (callee != function_))
+  {
+    function_calls_.emplace_back(function_, callee);
+  }
+}
+
+// Merges the state keys of every called function into its callers, repeating until nothing changes
+// so that keys accessed through nested (or recursive) calls are included
+void Analyser::PropagateStateKeys()
+{
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (auto const &call : function_calls_)
+    {
+      FunctionPtr const &caller = call.first;
+      FunctionPtr const &callee = call.second;
+      if (caller->state_keys_complete && !callee->state_keys_complete)
+      {
+        caller->state_keys_complete = false;
+        changed                     = true;
+      }
+      for (auto const &key : callee->state_keys)
+      {
+        if (std::find(caller->state_keys.begin(), caller->state_keys.end(), key) ==
+            caller->state_keys.end())
+        {
+          caller->state_keys.push_back(key);
+          changed = true;
+        }
+      }
+    }
+  }
+}
+
 // Returns true if control is able to reach the end of the block
 bool Analyser::TestBlock(BlockNodePtr const &block_node) const
 {
@@ -370,6 +370,8 @@ IRFunctionPtr Generator::CreateFunction(IRNodePtr const &     function_definitio
   IRFunctionPtr function = function_name_node->function;
   exe_function = Executable::Function(function->function_kind, function->name, annotations,
                                       function->return_type->id);
+  exe_function.state_keys          = function->state_keys;
+  exe_function.state_keys_complete = function->state_keys_complete;
   for (IRVariablePtr const &variable : function->parameter_variables)
   {
     exe_function.AddParameter(variable->name, variable->type->id);
@@ -142,6 +142,8 @@ IRFunctionPtr IRBuilder::BuildFunction(FunctionPtr const &function)
   ir_function->parameter_types     = BuildTypes(function->parameter_types);
   ir_function->parameter_variables = BuildVariables(function->parameter_variables);
   ir_function->return_type         = BuildType(function->return_type);
+  ir_function->state_keys          = function->state_keys;
+  ir_function->state_keys_complete = function->state_keys_complete;
   // Add to list AFTER dependencies
   ir_->AddFunction(ir_function);
   return ir_function;
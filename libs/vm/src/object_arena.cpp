@@ -0,0 +1,224 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/object_arena.hpp"
+
+#include <new>
+
+namespace fetch {
+namespace vm {
+namespace {
+
+thread_local ObjectArena *current_arena = nullptr;
+
+}  // namespace
+
+constexpr std::size_t ObjectArena::CHUNK_SIZE;
+constexpr std::size_t ObjectArena::MAX_OBJECT_SIZE;
+constexpr std::size_t ObjectArena::ALIGNMENT;
+constexpr std::size_t ObjectArena::NUM_SIZE_CLASSES;
+
+ObjectArena::Scope::Scope(ObjectArena &arena)
+  : previous_{current_arena}
+{
+  current_arena = &arena;
+}
+
+ObjectArena::Scope::~Scope()
+{
+  current_arena = previous_;
+}
+
+/**
+ * Create a new (empty) arena
+ *
+ * @return The arena, which is retired when the pointer is destroyed
+ */
+ObjectArena::ArenaPtr ObjectArena::Create()
+{
+  return ArenaPtr{new ObjectArena};
+}
+
+/**
+ * Signal that the owner is no longer using the arena. It is freed once every object allocated from
+ * it has been released.
+ */
+void ObjectArena::Retirer::operator()(ObjectArena *arena) const noexcept
+{
+  if (arena != nullptr)
+  {
+    arena->retired_ = true;
+    arena->Release();
+  }
+}
+
+ObjectArena::ObjectArena()
+{
+  free_lists_.fill(nullptr);
+}
+
+/**
+ * Allocate the memory for an object, from the arena active on the current thread if there is one
+ *
+ * @param size The size of the object
+ * @return The pointer to the allocated memory
+ */
+void *ObjectArena::Allocate(std::size_t size)
+{
+  ObjectArena *arena = current_arena;
+
+  if ((arena == nullptr) || (size > MAX_OBJECT_SIZE))
+  {
+    auto *header       = static_cast<Header *>(::operator new(sizeof(Header) + size));
+    header->arena      = nullptr;
+    header->size_class = 0;
+
+    return header + 1;
+  }
+
+  return arena->AllocateBlock(((size + ALIGNMENT - 1) / ALIGNMENT) - 1);
+}
+
+/**
+ * Free the memory of an object previously allocated with `ObjectArena::Allocate`
+ *
+ * @param ptr The pointer to the object memory
+ */
+void ObjectArena::Deallocate(void *ptr) noexcept
+{
+  if (ptr == nullptr)
+  {
+    return;
+  }
+
+  auto *header = static_cast<Header *>(ptr) - 1;
+
+  if (header->arena == nullptr)
+  {
+    ::operator delete(header);
+  }
+  else
+  {
+    header->arena->Free(header);
+  }
+}
+
+/**
+ * Rewind the arena so that all of its memory can be reused. This is only possible once every
+ * object allocated from it has been released.
+ *
+ * @return true if the arena was rewound, otherwise false
+ */
+bool ObjectArena::Rewind()
+{
+  if (num_live_objects() != 0)
+  {
+    return false;
+  }
+
+  current_chunk_ = 0;
+  offset_        = 0;
+  free_lists_.fill(nullptr);
+
+  return true;
+}
+
+std::size_t ObjectArena::num_live_objects() const
+{
+  return references_ - 1;
+}
+
+std::size_t ObjectArena::num_chunks() const
+{
+  return chunks_.size();
+}
+
+/**
+ * Internal: Allocate a block (header and object) from the arena
+ *
+ * @param size_class The index of the size class of the object
+ * @return The pointer to the object memory
+ */
+void *ObjectArena::AllocateBlock(std::size_t size_class)
+{
+  Header *header{nullptr};
+
+  // reuse a block which has been released during the invocation if possible
+  FreeBlock *block = free_lists_[size_class];
+  if (block != nullptr)
+  {
+    free_lists_[size_class] = block->next;
+    header                  = reinterpret_cast<Header *>(block);
+  }
+  else
+  {
+    std::size_t const block_size = sizeof(Header) + ((size_class + 1) * ALIGNMENT);
+
+    if ((current_chunk_ < chunks_.size()) && ((offset_ + block_size) > CHUNK_SIZE))
+    {
+      ++current_chunk_;
+      offset_ = 0;
+    }
+
+    if (current_chunk_ == chunks_.size())
+    {
+      chunks_.emplace_back(std::make_unique<Chunk>());
+      offset_ = 0;
+    }
+
+    header = reinterpret_cast<Header *>(chunks_[current_chunk_]->data + offset_);
+    offset_ += block_size;
+  }
+
+  header->arena      = this;
+  header->size_class = size_class;
+  ++references_;
+
+  return header + 1;
+}
+
+/**
+ * Internal: Return a block to the arena
+ *
+ * @param header The header of the block
+ */
+void ObjectArena::Free(Header *header) noexcept
+{
+  // blocks from a retired arena are never reused
+  if (!retired_)
+  {
+    std::size_t const size_class = header->size_class;
+
+    auto *block             = reinterpret_cast<FreeBlock *>(header);
+    block->next             = free_lists_[size_class];
+    free_lists_[size_class] = block;
+  }
+
+  Release();
+}
+
+void ObjectArena::Release() noexcept
+{
+  if (--references_ == 0)
+  {
+    delete this;
+  }
+}
+
+}  // namespace vm
+}  // namespace fetch
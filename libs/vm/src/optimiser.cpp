@@ -0,0 +1,597 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/opcodes.hpp"
+#include "vm/optimiser.hpp"
+#include "vm/variant.hpp"
+
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+namespace {
+
+using Function         = Executable::Function;
+using Instruction      = Executable::Instruction;
+using InstructionArray = Executable::InstructionArray;
+
+constexpr std::size_t MAX_CONSTANTS = 2048;  // must not exceed the limit used by the generator
+
+template <typename E, typename Visitor>
+void VisitFunctions(E &executable, Visitor &&visitor)
+{
+  for (auto &function : executable.functions)
+  {
+    visitor(function);
+  }
+
+  for (auto &contract : executable.contracts)
+  {
+    for (auto &function : contract.functions)
+    {
+      visitor(function);
+    }
+  }
+
+  for (auto &type : executable.user_defined_types)
+  {
+    for (auto &function : type.functions)
+    {
+      visitor(function);
+    }
+  }
+}
+
+bool HasPcOperand(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::Jump:
+  case Opcodes::JumpIfFalse:
+  case Opcodes::JumpIfTrue:
+  case Opcodes::JumpIfFalseOrPop:
+  case Opcodes::JumpIfTrueOrPop:
+  case Opcodes::Break:
+  case Opcodes::Continue:
+  case Opcodes::ForRangeIterate:
+    return true;
+  default:
+    return false;
+  }
+}
+
+uint16_t LookupInplaceOpcode(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveAdd:
+    return Opcodes::LocalVariablePrimitiveInplaceAdd;
+  case Opcodes::PrimitiveSubtract:
+    return Opcodes::LocalVariablePrimitiveInplaceSubtract;
+  case Opcodes::PrimitiveMultiply:
+    return Opcodes::LocalVariablePrimitiveInplaceMultiply;
+  case Opcodes::PrimitiveDivide:
+    return Opcodes::LocalVariablePrimitiveInplaceDivide;
+  case Opcodes::PrimitiveModulo:
+    return Opcodes::LocalVariablePrimitiveInplaceModulo;
+  default:
+    return Opcodes::Unknown;
+  }
+}
+
+bool IsSideEffectFreePush(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PushNull:
+  case Opcodes::PushFalse:
+  case Opcodes::PushTrue:
+  case Opcodes::PushString:
+  case Opcodes::PushConstant:
+  case Opcodes::PushLargeConstant:
+  case Opcodes::PushLocalVariable:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool IsSimplePush(uint16_t opcode)
+{
+  return (Opcodes::PushConstant == opcode) || (Opcodes::PushLocalVariable == opcode);
+}
+
+bool IsNumericType(TypeId type_id)
+{
+  return (type_id >= TypeIds::Int8) && (type_id <= TypeIds::PrimitiveMaxId);
+}
+
+template <typename T>
+bool Evaluate(uint16_t opcode, T lhs, T rhs, T &result)
+{
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveAdd:
+    return !__builtin_add_overflow(lhs, rhs, &result);
+  case Opcodes::PrimitiveSubtract:
+    return !__builtin_sub_overflow(lhs, rhs, &result);
+  case Opcodes::PrimitiveMultiply:
+    return !__builtin_mul_overflow(lhs, rhs, &result);
+  case Opcodes::PrimitiveDivide:
+  case Opcodes::PrimitiveModulo:
+  {
+    // division by zero (and the overflowing signed division) is left to be reported at runtime
+    bool const overflows =
+        std::is_signed<T>::value && (lhs == std::numeric_limits<T>::min()) && (rhs == T(-1));
+    if ((rhs == 0) || overflows)
+    {
+      return false;
+    }
+
+    result = T((Opcodes::PrimitiveDivide == opcode) ? (lhs / rhs) : (lhs % rhs));
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+template <typename T>
+bool FoldConstant(Executable &executable, uint16_t opcode, TypeId type_id, Variant const &lhs,
+                  Variant const &rhs, uint16_t &index)
+{
+  T result{};
+  if (!Evaluate<T>(opcode, lhs.primitive.Get<T>(), rhs.primitive.Get<T>(), result))
+  {
+    return false;
+  }
+
+  auto &constants = executable.constants;
+
+  // reuse an existing constant where possible
+  for (std::size_t i = 0; i < constants.size(); ++i)
+  {
+    if ((constants[i].type_id == type_id) && (constants[i].primitive.Get<T>() == result))
+    {
+      index = static_cast<uint16_t>(i);
+      return true;
+    }
+  }
+
+  if (constants.size() >= MAX_CONSTANTS)
+  {
+    return false;
+  }
+
+  index = static_cast<uint16_t>(constants.size());
+  constants.emplace_back(result, type_id);
+
+  return true;
+}
+
+bool FoldConstant(Executable &executable, uint16_t opcode, TypeId type_id, uint16_t lhs_index,
+                  uint16_t rhs_index, uint16_t &index)
+{
+  // copies are taken since folding may add to the constants
+  Variant const lhs = executable.constants[lhs_index];
+  Variant const rhs = executable.constants[rhs_index];
+
+  if ((lhs.type_id != type_id) || (rhs.type_id != type_id))
+  {
+    return false;
+  }
+
+  switch (type_id)
+  {
+  case TypeIds::Int8:
+    return FoldConstant<int8_t>(executable, opcode, type_id, lhs, rhs, index);
+  case TypeIds::UInt8:
+    return FoldConstant<uint8_t>(executable, opcode, type_id, lhs, rhs, index);
+  case TypeIds::Int16:
+    return FoldConstant<int16_t>(executable, opcode, type_id, lhs, rhs, index);
+  case TypeIds::UInt16:
+    return FoldConstant<uint16_t>(executable, opcode, type_id, lhs, rhs, index);
+  case TypeIds::Int32:
+    return FoldConstant<int32_t>(executable, opcode, type_id, lhs, rhs, index);
+  case TypeIds::UInt32:
+    return FoldConstant<uint32_t>(executable, opcode, type_id, lhs, rhs, index);
+  case TypeIds::Int64:
+    return FoldConstant<int64_t>(executable, opcode, type_id, lhs, rhs, index);
+  case TypeIds::UInt64:
+    return FoldConstant<uint64_t>(executable, opcode, type_id, lhs, rhs, index);
+  default:
+    // fixed point arithmetic is not folded
+    return false;
+  }
+}
+
+/**
+ * A single pass of the peephole optimiser over a function. Each of the rewrite rules returns the
+ * number of instructions that it has consumed, or zero if it did not match.
+ */
+class FunctionOptimiser
+{
+public:
+  FunctionOptimiser(Executable &executable, Function &function, Optimiser::Statistics &statistics)
+    : executable_{executable}
+    , function_{function}
+    , statistics_{statistics}
+  {}
+
+  bool Run();
+
+private:
+  bool IsStraightLine(std::size_t pc, std::size_t length) const;
+  void Remove(std::size_t pc, std::size_t count);
+  void Compact();
+
+  /// @name Rewrite Rules
+  /// @{
+  std::size_t FuseInplaceOperation(std::size_t pc);
+  std::size_t FoldConstants(std::size_t pc);
+  std::size_t EliminateDeadValue(std::size_t pc);
+  std::size_t EliminateDeadStore(std::size_t pc);
+  /// @}
+
+  Executable &           executable_;
+  Function &             function_;
+  Optimiser::Statistics &statistics_;
+  std::vector<bool>      targets_{};  ///< The pcs which are the destination of a jump
+  std::vector<bool>      removed_{};  ///< The pcs which have been removed by this pass
+};
+
+/**
+ * Run a single pass over the function
+ *
+ * @return true if the function was modified, otherwise false
+ */
+bool FunctionOptimiser::Run()
+{
+  auto const &instructions = function_.instructions;
+  auto const  size         = instructions.size();
+
+  targets_.assign(size + 1, false);
+  removed_.assign(size, false);
+
+  for (auto const &instruction : instructions)
+  {
+    if (HasPcOperand(instruction.opcode) && (instruction.index <= size))
+    {
+      targets_[instruction.index] = true;
+    }
+  }
+
+  bool modified = false;
+  for (std::size_t pc = 0; pc < size;)
+  {
+    std::size_t consumed = FuseInplaceOperation(pc);
+
+    if (consumed == 0)
+    {
+      consumed = FoldConstants(pc);
+    }
+
+    if (consumed == 0)
+    {
+      consumed = EliminateDeadValue(pc);
+    }
+
+    if (consumed == 0)
+    {
+      consumed = EliminateDeadStore(pc);
+    }
+
+    if (consumed == 0)
+    {
+      ++pc;
+    }
+    else
+    {
+      pc += consumed;
+      modified = true;
+    }
+  }
+
+  if (modified)
+  {
+    Compact();
+  }
+
+  return modified;
+}
+
+/**
+ * Internal: Determine if a sequence of instructions can only be entered at its first instruction
+ */
+bool FunctionOptimiser::IsStraightLine(std::size_t pc, std::size_t length) const
+{
+  if ((pc + length) > function_.instructions.size())
+  {
+    return false;
+  }
+
+  for (std::size_t i = pc + 1; i < (pc + length); ++i)
+  {
+    if (targets_[i])
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void FunctionOptimiser::Remove(std::size_t pc, std::size_t count)
+{
+  for (std::size_t i = pc; i < (pc + count); ++i)
+  {
+    removed_[i] = true;
+  }
+}
+
+/**
+ * Internal: Drop the removed instructions, updating the jump destinations and line numbers
+ */
+void FunctionOptimiser::Compact()
+{
+  auto const size = function_.instructions.size();
+
+  // map every original pc to the first remaining instruction at or after it
+  std::vector<uint16_t> new_pcs(size + 1);
+  InstructionArray      instructions{};
+  instructions.reserve(size);
+
+  for (std::size_t pc = 0; pc < size; ++pc)
+  {
+    new_pcs[pc] = static_cast<uint16_t>(instructions.size());
+
+    if (!removed_[pc])
+    {
+      instructions.push_back(function_.instructions[pc]);
+    }
+  }
+  new_pcs[size] = static_cast<uint16_t>(instructions.size());
+
+  for (auto &instruction : instructions)
+  {
+    if (HasPcOperand(instruction.opcode) && (instruction.index <= size))
+    {
+      instruction.index = new_pcs[instruction.index];
+    }
+  }
+
+  // when several lines collapse onto the same pc the latest one describes the instruction there
+  Executable::PcToLineMap pc_to_line_map{};
+  for (auto const &entry : function_.pc_to_line_map)
+  {
+    if (entry.first <= size)
+    {
+      pc_to_line_map[new_pcs[entry.first]] = entry.second;
+    }
+  }
+
+  function_.instructions   = std::move(instructions);
+  function_.pc_to_line_map = std::move(pc_to_line_map);
+}
+
+/**
+ * Internal: Fuse `PushLocalVariable x; <push y>; Primitive<Op>; PopToLocalVariable x` into
+ * `<push y>; LocalVariablePrimitiveInplace<Op> x`
+ */
+std::size_t FunctionOptimiser::FuseInplaceOperation(std::size_t pc)
+{
+  static constexpr std::size_t LENGTH = 4;
+
+  if (!IsStraightLine(pc, LENGTH))
+  {
+    return 0;
+  }
+
+  auto &            instructions = function_.instructions;
+  Instruction const load         = instructions[pc];
+  Instruction const operand      = instructions[pc + 1];
+  Instruction const operation    = instructions[pc + 2];
+  Instruction const store        = instructions[pc + 3];
+  uint16_t const    opcode       = LookupInplaceOpcode(operation.opcode);
+
+  bool const matched = (Opcodes::PushLocalVariable == load.opcode) &&
+                       IsSimplePush(operand.opcode) && (Opcodes::Unknown != opcode) &&
+                       (Opcodes::PopToLocalVariable == store.opcode) &&
+                       (load.index == store.index) && (load.type_id == operation.type_id) &&
+                       (store.type_id == operation.type_id) && IsNumericType(operation.type_id);
+
+  if (!matched)
+  {
+    return 0;
+  }
+
+  Instruction inplace(opcode);
+  inplace.type_id = operation.type_id;
+  inplace.index   = store.index;
+  inplace.data    = operation.type_id;
+
+  instructions[pc]     = operand;
+  instructions[pc + 1] = inplace;
+  Remove(pc + 2, 2);
+
+  ++statistics_.fused_instructions;
+
+  return LENGTH;
+}
+
+/**
+ * Internal: Fold `PushConstant a; PushConstant b; Primitive<Op>` into `PushConstant (a <op> b)`
+ */
+std::size_t FunctionOptimiser::FoldConstants(std::size_t pc)
+{
+  static constexpr std::size_t LENGTH = 3;
+
+  if (!IsStraightLine(pc, LENGTH))
+  {
+    return 0;
+  }
+
+  auto &            instructions = function_.instructions;
+  Instruction const lhs          = instructions[pc];
+  Instruction const rhs          = instructions[pc + 1];
+  Instruction const operation    = instructions[pc + 2];
+
+  bool const matched = (Opcodes::PushConstant == lhs.opcode) &&
+                       (Opcodes::PushConstant == rhs.opcode) &&
+                       (Opcodes::Unknown != LookupInplaceOpcode(operation.opcode));
+
+  uint16_t index{0};
+  if (!matched ||
+      !FoldConstant(executable_, operation.opcode, operation.type_id, lhs.index, rhs.index, index))
+  {
+    return 0;
+  }
+
+  instructions[pc].index = index;
+  Remove(pc + 1, 2);
+
+  ++statistics_.folded_constants;
+
+  return LENGTH;
+}
+
+/**
+ * Internal: Remove `<push>; Discard` when the push has no side effects
+ */
+std::size_t FunctionOptimiser::EliminateDeadValue(std::size_t pc)
+{
+  static constexpr std::size_t LENGTH = 2;
+
+  if (!IsStraightLine(pc, LENGTH))
+  {
+    return 0;
+  }
+
+  auto const &instructions = function_.instructions;
+  if (!IsSideEffectFreePush(instructions[pc].opcode) ||
+      (Opcodes::Discard != instructions[pc + 1].opcode))
+  {
+    return 0;
+  }
+
+  Remove(pc, LENGTH);
+  statistics_.eliminated_instructions += LENGTH;
+
+  return LENGTH;
+}
+
+/**
+ * Internal: Remove self assignments `PushLocalVariable x; PopToLocalVariable x` and stores of a
+ * constant that are overwritten by the following statement
+ * `PushConstant a; PopToLocalVariable x; <push y>; PopToLocalVariable x`
+ */
+std::size_t FunctionOptimiser::EliminateDeadStore(std::size_t pc)
+{
+  static constexpr std::size_t LENGTH = 2;
+
+  if (!IsStraightLine(pc, LENGTH))
+  {
+    return 0;
+  }
+
+  auto const &      instructions = function_.instructions;
+  Instruction const value        = instructions[pc];
+  Instruction const store        = instructions[pc + 1];
+
+  if (Opcodes::PopToLocalVariable != store.opcode)
+  {
+    return 0;
+  }
+
+  bool dead = (Opcodes::PushLocalVariable == value.opcode) && (value.index == store.index);
+
+  // constants are always primitive so overwriting them can not have any side effects
+  if (!dead && (Opcodes::PushConstant == value.opcode) && IsStraightLine(pc, LENGTH * 2))
+  {
+    Instruction const next_value = instructions[pc + 2];
+    Instruction const next_store = instructions[pc + 3];
+
+    bool const reads_variable =
+        (Opcodes::PushLocalVariable == next_value.opcode) && (next_value.index == store.index);
+
+    dead = IsSimplePush(next_value.opcode) && !reads_variable &&
+           (Opcodes::PopToLocalVariable == next_store.opcode) && (next_store.index == store.index);
+  }
+
+  if (!dead)
+  {
+    return 0;
+  }
+
+  Remove(pc, LENGTH);
+  statistics_.eliminated_instructions += LENGTH;
+
+  return LENGTH;
+}
+
+}  // namespace
+
+/**
+ * Count how often each pair of opcodes appears consecutively in an executable. This is useful to
+ * identify the sequences which are worth fusing into superinstructions.
+ *
+ * @param executable The executable to be profiled
+ * @return The map of opcode pairs to the number of times that they occur
+ */
+Optimiser::OpcodePairCounts Optimiser::CountOpcodePairs(Executable const &executable)
+{
+  OpcodePairCounts counts{};
+
+  VisitFunctions(executable, [&counts](Function const &function) {
+    auto const &instructions = function.instructions;
+
+    for (std::size_t pc = 1; pc < instructions.size(); ++pc)
+    {
+      ++counts[{instructions[pc - 1].opcode, instructions[pc].opcode}];
+    }
+  });
+
+  return counts;
+}
+
+/**
+ * Optimise all the functions of an executable in place
+ *
+ * @param executable The executable to be optimised
+ * @return The statistics for the changes that have been made
+ */
+Optimiser::Statistics Optimiser::Optimise(Executable &executable)
+{
+  Statistics statistics{};
+
+  VisitFunctions(executable, [&executable, &statistics](Function &function) {
+    FunctionOptimiser optimiser{executable, function, statistics};
+
+    // each rewrite can expose further opportunities, continue until no more changes are made
+    while (optimiser.Run())
+    {
+    }
+  });
+
+  return statistics;
+}
+
+}  // namespace vm
+}  // namespace fetch
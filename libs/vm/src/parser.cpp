@@ -23,9 +23,13 @@
 #define YY_EXTRA_TYPE fetch::vm::Location *
 #include "vm/tokeniser.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <iterator>
 #include <memory>
 #include <ostream>
+#include <thread>
 #include <utility>
 
 namespace fetch {
@@ -40,51 +44,125 @@ void Parser::AddTemplateName(std::string name)
   template_names_.insert(std::move(name));
 }
 
+/**
+ * Parse a set of source files into a single syntax tree
+ *
+ * The files are tokenised and parsed independently of each other, so when there are several files
+ * they are processed in parallel. The resulting tree and errors are identical to parsing the files
+ * one after the other.
+ *
+ * @param files The source files
+ * @param errors The errors found during parsing, in file order
+ * @return The root of the syntax tree, or an empty pointer if there were errors
+ */
 BlockNodePtr Parser::Parse(SourceFiles const &files, std::vector<std::string> &errors)
 {
-  errors_.clear();
-  blocks_.clear();
+  static const std::size_t MAX_SIZE = 128 * 1024;
 
-  BlockNodePtr root = CreateBlockNode(NodeKind::Root, "", 0);
-  blocks_.push_back({root, true});
+  // the files following one which exceeds the maximum size are not parsed
+  std::size_t num_files{0};
+  while ((num_files < files.size()) && (files[num_files].source.size() <= MAX_SIZE))
+  {
+    ++num_files;
+  }
+
+  std::vector<FileResult> results(num_files);
 
-  for (auto const &file : files)
+  std::size_t const num_workers =
+      std::min<std::size_t>(num_files, std::max(1u, std::thread::hardware_concurrency()));
+
+  if (num_workers > 1)
   {
-    filename_                         = file.filename;
-    static const std::size_t MAX_SIZE = 128 * 1024;
-    std::size_t              size     = file.source.size();
-    if (size > MAX_SIZE)
+    std::atomic<std::size_t> next_file{0};
+
+    auto const worker = [this, &files, &results, &next_file]() {
+      Parser parser{*this};
+
+      for (std::size_t index = next_file++; index < results.size(); index = next_file++)
+      {
+        parser.ParseFile(files[index], results[index]);
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    threads.reserve(num_workers - 1);
+    for (std::size_t i = 1; i < num_workers; ++i)
     {
-      std::ostringstream stream;
-      stream << filename_ << ": source exceeds maximum size";
-      errors_.push_back(stream.str());
-      break;
+      threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+  }
+  else
+  {
+    for (std::size_t index = 0; index < num_files; ++index)
+    {
+      ParseFile(files[index], results[index]);
     }
-    Tokenise(file.source);
-    index_ = -1;
-    token_ = nullptr;
-    groups_.clear();
-    operators_.clear();
-    rpn_.clear();
-    infix_stack_.clear();
-    BlockNodePtr file_node = CreateBlockNode(NodeKind::File, filename_, 1);
-    blocks_.push_back({file_node, true});
-    root->block_children.push_back(file_node);
-    ParseBlock(file_node);
   }
 
-  bool const ok = errors_.empty();
-  errors        = std::move(errors_);
+  BlockNodePtr root = CreateBlockNode(NodeKind::Root, "", 0);
 
+  errors.clear();
+  for (auto &result : results)
+  {
+    root->block_children.push_back(std::move(result.node));
+    std::move(result.errors.begin(), result.errors.end(), std::back_inserter(errors));
+  }
+
+  if (num_files < files.size())
+  {
+    std::ostringstream stream;
+    stream << files[num_files].filename << ": source exceeds maximum size";
+    errors.push_back(stream.str());
+  }
+
+  return errors.empty() ? root : BlockNodePtr{};
+}
+
+/**
+ * Internal: Tokenise and parse a single source file
+ *
+ * @param file The source file
+ * @param result The file node of the syntax tree and the errors found in the file
+ */
+void Parser::ParseFile(SourceFile const &file, FileResult &result)
+{
+  errors_.clear();
+  blocks_.clear();
+
+  // the root of the syntax tree is assembled once all of the files have been parsed
+  blocks_.push_back({CreateBlockNode(NodeKind::Root, "", 0), true});
+
+  filename_ = file.filename;
+  Tokenise(file.source);
+  index_ = -1;
+  token_ = nullptr;
+  groups_.clear();
+  operators_.clear();
+  rpn_.clear();
+  infix_stack_.clear();
+
+  result.node = CreateBlockNode(NodeKind::File, filename_, 1);
+  blocks_.push_back({result.node, true});
+  ParseBlock(result.node);
+
+  result.errors = std::move(errors_);
+
+  errors_.clear();
   filename_.clear();
   tokens_.clear();
+  token_ = nullptr;
   groups_.clear();
   operators_.clear();
   rpn_.clear();
   infix_stack_.clear();
   blocks_.clear();
-
-  return ok ? root : BlockNodePtr{};
 }
 
 void Parser::Tokenise(std::string const &source)
@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+
+namespace fetch {
+namespace vm {
+namespace {
+
+void Accumulate(Profiler::Entry &entry, Profiler::Entry const &other)
+{
+  entry.count += other.count;
+  entry.charge += other.charge;
+  entry.duration += other.duration;
+}
+
+}  // namespace
+
+constexpr uint64_t Profiler::DEFAULT_SAMPLE_INTERVAL;
+
+/**
+ * Construct the profiler
+ *
+ * @param sample_interval The number of instructions between each sample of the call stack
+ */
+Profiler::Profiler(uint64_t sample_interval)
+  : sample_interval_{std::max<uint64_t>(sample_interval, 1)}
+  , until_sample_{sample_interval_}
+{}
+
+/**
+ * Determine if the call stack should be sampled, called once for every instruction executed
+ *
+ * @return true if the stack should be recorded for the current instruction, otherwise false
+ */
+bool Profiler::ShouldSample()
+{
+  if (--until_sample_ == 0)
+  {
+    until_sample_ = sample_interval_;
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Record a sample of the call stack
+ *
+ * @param stack The names of the active functions, outermost first and separated by semicolons
+ */
+void Profiler::RecordSample(std::string const &stack)
+{
+  ++samples_[stack];
+}
+
+/**
+ * Record the execution of a single instruction
+ *
+ * @param function The name of the function which contains the instruction
+ * @param opcode The unique name of the opcode
+ * @param charge The charge that the instruction contributed to the total
+ * @param duration The wall time taken to execute the instruction
+ */
+void Profiler::RecordInstruction(std::string const &function, std::string const &opcode,
+                                 ChargeAmount charge, Duration duration)
+{
+  auto const  nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+  Entry const entry{1, charge, static_cast<uint64_t>(nanoseconds)};
+
+  Accumulate(opcodes_[opcode], entry);
+  Accumulate(functions_[function], entry);
+}
+
+/**
+ * Combine the results of another profile into this one
+ *
+ * @param other The profile to be merged
+ */
+void Profiler::Merge(Profiler const &other)
+{
+  for (auto const &opcode : other.opcodes_)
+  {
+    Accumulate(opcodes_[opcode.first], opcode.second);
+  }
+
+  for (auto const &function : other.functions_)
+  {
+    Accumulate(functions_[function.first], function.second);
+  }
+
+  for (auto const &sample : other.samples_)
+  {
+    samples_[sample.first] += sample.second;
+  }
+}
+
+void Profiler::Clear()
+{
+  until_sample_ = sample_interval_;
+  opcodes_.clear();
+  functions_.clear();
+  samples_.clear();
+}
+
+Profiler::Entries const &Profiler::opcodes() const
+{
+  return opcodes_;
+}
+
+Profiler::Entries const &Profiler::functions() const
+{
+  return functions_;
+}
+
+Profiler::StackSamples const &Profiler::samples() const
+{
+  return samples_;
+}
+
+uint64_t Profiler::sample_interval() const
+{
+  return sample_interval_;
+}
+
+/**
+ * Write out the sampled call stacks in the folded stacks format, one "frame;frame;frame count"
+ * line per unique stack
+ *
+ * @param stream The output stream
+ * @param root The (optional) name of an additional outermost frame, e.g. the contract digest
+ */
+void Profiler::WriteFoldedStacks(std::ostream &stream, std::string const &root) const
+{
+  for (auto const &sample : samples_)
+  {
+    if (!root.empty())
+    {
+      stream << root << ';';
+    }
+
+    stream << sample.first << ' ' << sample.second << '\n';
+  }
+}
+
+/**
+ * Estimate a static charge for each of the profiled opcodes from its mean execution time, relative
+ * to the cheapest opcode which is given a charge of one. The result is in the form accepted by
+ * `VM::UpdateCharges`.
+ *
+ * Note that the execution times include the work covered by any dynamic charges.
+ *
+ * @return The map of opcode unique names to estimated charge
+ */
+Profiler::ChargeTable Profiler::EstimateStaticCharges() const
+{
+  ChargeTable charges{};
+
+  double cheapest = std::numeric_limits<double>::max();
+  for (auto const &opcode : opcodes_)
+  {
+    if ((opcode.second.count > 0) && (opcode.second.duration > 0))
+    {
+      double const mean = static_cast<double>(opcode.second.duration) /
+                          static_cast<double>(opcode.second.count);
+      cheapest = std::min(cheapest, mean);
+    }
+  }
+
+  for (auto const &opcode : opcodes_)
+  {
+    ChargeAmount charge{1};
+    if ((opcode.second.count > 0) && (opcode.second.duration > 0))
+    {
+      double const mean = static_cast<double>(opcode.second.duration) /
+                          static_cast<double>(opcode.second.count);
+      charge = std::max<ChargeAmount>(1, static_cast<ChargeAmount>(std::llround(mean / cheapest)));
+    }
+
+    charges[opcode.first] = charge;
+  }
+
+  return charges;
+}
+
+}  // namespace vm
+}  // namespace fetch
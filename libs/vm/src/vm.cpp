@@ -17,12 +17,15 @@
 //------------------------------------------------------------------------------
 
 #include "vm/module.hpp"
+#include "vm/profiler.hpp"
 #include "vm/vm.hpp"
 
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <sstream>
+#include <string>
 
 namespace fetch {
 namespace vm {
@@ -268,12 +271,34 @@ bool VM::Execute(std::string &error, Variant &output)
   self_.Reset();
   error_.clear();
   error.clear();
+  block_charges_.clear();
+  block_function_        = nullptr;
+  current_block_charges_ = nullptr;
+
+  // when profiling every instruction must pass through the main dispatch loop
+  bool const block_dispatch = block_dispatch_ && (profiler_ == nullptr);
+
+  // reuse the memory of the previous invocation, unless some of its objects are still alive
+  if (!arena_->Rewind())
+  {
+    arena_ = ObjectArena::Create();
+  }
+
+  ObjectArena::Scope const arena_scope{*arena_};
+
   try
   {
     if (sp_ < STACK_SIZE)
     {
       do
       {
+        // run straight-line sections of primitive instructions without the per instruction
+        // dispatch and charge overhead
+        if (block_dispatch && ExecuteBlock())
+        {
+          continue;
+        }
+
         instruction_pc_ = pc_;
         instruction_    = &function_->instructions[pc_++];
 
@@ -287,6 +312,7 @@ bool VM::Execute(std::string &error, Variant &output)
           break;
         }
 
+        ChargeAmount const charge_before = charge_total_;
         IncreaseChargeTotal(current_op_->static_charge);
 
         if (ChargeLimitExceeded())
@@ -295,7 +321,14 @@ bool VM::Execute(std::string &error, Variant &output)
         }
 
         // execute the handler for the op code
-        current_op_->handler(this);
+        if (profiler_ == nullptr)
+        {
+          current_op_->handler(this);
+        }
+        else
+        {
+          ExecuteProfiled(charge_before);
+        }
 
       } while (!stop_);
     }
@@ -411,8 +444,104 @@ void VM::SetChargeLimit(ChargeAmount limit)
   charge_limit_ = limit;
 }
 
+void VM::SetBlockDispatch(bool enabled)
+{
+  block_dispatch_ = enabled;
+}
+
+/**
+ * Select the UInt256 multiplication and division of the initial block version, which lose carries
+ * and get some quotients wrong. Contracts in blocks from before the exact arithmetic was activated
+ * must be executed with it, so that they produce the same results as when they were mined.
+ *
+ * @param enabled true to reproduce the legacy results, false for exact arithmetic
+ */
+void VM::SetLegacyArithmetic(bool enabled)
+{
+  legacy_arithmetic_ = enabled;
+}
+
+bool VM::IsLegacyArithmetic() const
+{
+  return legacy_arithmetic_;
+}
+
+/**
+ * Attach a profiler which records every instruction executed by the VM. Block dispatch is
+ * suspended while a profiler is attached.
+ *
+ * @param profiler The profiler to attach (which must outlive the execution), or nullptr to detach
+ */
+void VM::SetProfiler(Profiler *profiler)
+{
+  profiler_ = profiler;
+}
+
+/**
+ * Get a description of the types and opcodes registered with the VM
+ *
+ * Generated executables refer to types and opcodes by their index, so an executable is only valid
+ * for VMs with an identical signature. This is used to key executables which are persisted.
+ *
+ * @return The signature
+ */
+std::string VM::LayoutSignature() const
+{
+  std::ostringstream stream;
+
+  for (auto const &type_info : type_info_array_)
+  {
+    stream << type_info.type_id << ':' << type_info.name << '\n';
+  }
+
+  for (auto const &opcode_info : opcode_info_array_)
+  {
+    stream << opcode_info.unique_name << '\n';
+  }
+
+  return stream.str();
+}
+
+/**
+ * Reset the per invocation state of the VM (charges, IO observer, profiler, contract invocation
+ * handler and attached devices) so that it can be reused in place of a newly constructed instance.
+ * The registered types and opcode charges are retained.
+ */
+void VM::Reset()
+{
+  charge_limit_ = std::numeric_limits<ChargeAmount>::max();
+  charge_total_ = 0;
+  error_.clear();
+  contract_invocation_handler_ = ContractInvocationHandler{};
+  io_observer_                 = nullptr;
+  profiler_                    = nullptr;
+  output_devices_.clear();
+  input_devices_.clear();
+  output_buffer_.str({});
+  output_buffer_.clear();
+
+  // release any objects which are still referenced by the previous invocation
+  for (auto &variable : stack_)
+  {
+    variable.Reset();
+  }
+
+  for (auto &frame : frame_stack_)
+  {
+    frame.self.Reset();
+  }
+
+  live_object_stack_.clear();
+  self_.Reset();
+}
+
 void VM::UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opcode_static_charges)
 {
+  // the block charges are derived from the static charges
+  block_charges_.clear();
+  block_function_        = nullptr;
+  current_block_charges_ = nullptr;
+
   for (auto const &entry : opcode_static_charges)
   {
     auto const &unique_name = entry.first;
@@ -428,5 +557,157 @@ void VM::UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opco
   }
 }
 
+/**
+ * Internal: Calculate the charge of the block starting at each instruction of a function
+ *
+ * A block is a run of primitive instructions (see IsBlockInstruction) which executes without any
+ * change of control, other than by a final jump. The charge of an instruction is the sum of the
+ * static charges from it to the end of the block, or zero if it is not part of a block.
+ *
+ * @param function The function to be analysed
+ * @return The block charges, indexed by program counter
+ */
+VM::BlockCharges VM::CalculateBlockCharges(Executable::Function const &function) const
+{
+  auto const num_instructions = function.instructions.size();
+
+  BlockCharges charges(num_instructions + 1);
+  for (std::size_t i = num_instructions; i > 0; --i)
+  {
+    auto const opcode = function.instructions[i - 1].opcode;
+    if (!IsBlockInstruction(opcode) && !IsBlockTerminator(opcode))
+    {
+      continue;
+    }
+
+    ChargeAmount const static_charge = opcode_info_array_[opcode].static_charge;
+    ChargeAmount const charge        = (static_charge == 0) ? 1u : static_charge;
+    ChargeAmount const following     = IsBlockTerminator(opcode) ? 0u : charges[i].total;
+
+    // too large to be charged in a single step, fall back to per instruction dispatch
+    if ((std::numeric_limits<ChargeAmount>::max() - following) < charge)
+    {
+      continue;
+    }
+
+    charges[i - 1].total     = charge + following;
+    charges[i - 1].following = following;
+  }
+
+  return charges;
+}
+
+/**
+ * Internal: Determine if an instruction can be part of a block. These instructions never change the
+ * program counter or the current function and do not apply any dynamic charges.
+ */
+bool VM::IsBlockInstruction(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::LocalVariableDeclare:
+  case Opcodes::LocalVariableDeclareAssign:
+  case Opcodes::PushNull:
+  case Opcodes::PushFalse:
+  case Opcodes::PushTrue:
+  case Opcodes::PushString:
+  case Opcodes::PushConstant:
+  case Opcodes::PushLargeConstant:
+  case Opcodes::PushLocalVariable:
+  case Opcodes::PopToLocalVariable:
+  case Opcodes::Inc:
+  case Opcodes::Dec:
+  case Opcodes::Duplicate:
+  case Opcodes::DuplicateInsert:
+  case Opcodes::Discard:
+  case Opcodes::LocalVariablePrefixInc:
+  case Opcodes::LocalVariablePrefixDec:
+  case Opcodes::LocalVariablePostfixInc:
+  case Opcodes::LocalVariablePostfixDec:
+  case Opcodes::Not:
+  case Opcodes::PrimitiveEqual:
+  case Opcodes::PrimitiveNotEqual:
+  case Opcodes::PrimitiveLessThan:
+  case Opcodes::PrimitiveLessThanOrEqual:
+  case Opcodes::PrimitiveGreaterThan:
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+  case Opcodes::PrimitiveNegate:
+  case Opcodes::PrimitiveAdd:
+  case Opcodes::PrimitiveSubtract:
+  case Opcodes::PrimitiveMultiply:
+  case Opcodes::PrimitiveDivide:
+  case Opcodes::PrimitiveModulo:
+  case Opcodes::LocalVariablePrimitiveInplaceAdd:
+  case Opcodes::LocalVariablePrimitiveInplaceSubtract:
+  case Opcodes::LocalVariablePrimitiveInplaceMultiply:
+  case Opcodes::LocalVariablePrimitiveInplaceDivide:
+  case Opcodes::LocalVariablePrimitiveInplaceModulo:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * Internal: Determine if an instruction ends a block. These instructions may only change the
+ * program counter.
+ */
+bool VM::IsBlockTerminator(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::Jump:
+  case Opcodes::JumpIfFalse:
+  case Opcodes::JumpIfTrue:
+  case Opcodes::JumpIfFalseOrPop:
+  case Opcodes::JumpIfTrueOrPop:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * Internal: Execute the handler for the current instruction, recording it with the attached
+ * profiler
+ *
+ * @param charge_before The charge total prior to the instruction
+ */
+void VM::ExecuteProfiled(ChargeAmount charge_before)
+{
+  // the handler may switch to another function (call or return)
+  std::string const &function = function_->name;
+
+  if (profiler_->ShouldSample())
+  {
+    profiler_->RecordSample(ProfileStack());
+  }
+
+  auto const start = Profiler::Clock::now();
+  current_op_->handler(this);
+  auto const duration = Profiler::Clock::now() - start;
+
+  profiler_->RecordInstruction(function, current_op_->unique_name, charge_total_ - charge_before,
+                               duration);
+}
+
+/**
+ * Internal: Build the current call stack in the folded stacks format
+ *
+ * @return The active function names, outermost first and separated by semicolons
+ */
+std::string VM::ProfileStack() const
+{
+  std::string stack{};
+  for (int i = 0; i <= frame_sp_; ++i)
+  {
+    stack += frame_stack_[i].function->name;
+    stack += ';';
+  }
+  stack += function_->name;
+
+  return stack;
+}
+
 }  // namespace vm
 }  // namespace fetch
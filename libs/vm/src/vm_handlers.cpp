@@ -22,9 +22,17 @@
 #include "vm/vm.hpp"
 
 #include <cstdint>
+#include <limits>
 #include <utility>
 #include <vector>
 
+// Inline the handlers into the block dispatch loop (see VM::ExecuteBlock)
+#if defined(__GNUC__) || defined(__clang__)
+#define FETCH_VM_FLATTEN __attribute__((flatten))
+#else
+#define FETCH_VM_FLATTEN
+#endif
+
 namespace fetch {
 namespace vm {
 
@@ -101,8 +109,9 @@ void VM::Handler__PushConstant()
 {
   if (++sp_ < STACK_SIZE)
   {
+    // The constant table only ever holds primitives (large constants are handled separately)
     Variant const &constant = executable_->constants[instruction_->index];
-    Top().Construct(constant);
+    Top().Construct(constant.primitive, constant.type_id);
     return;
   }
   --sp_;
@@ -114,7 +123,15 @@ void VM::Handler__PushLocalVariable()
   if (++sp_ < STACK_SIZE)
   {
     Variant const &variable = GetLocalVariable(instruction_->index);
-    Top().Construct(variable);
+    if (variable.IsPrimitive())
+    {
+      // Primitives are copied without touching the reference count path
+      Top().Construct(variable.primitive, variable.type_id);
+    }
+    else
+    {
+      Top().Construct(variable);
+    }
     return;
   }
   --sp_;
@@ -631,7 +648,7 @@ void VM::Handler__ObjectNegate()
   Variant &top = Top();
   if (top.object)
   {
-    if (EstimateCharge(this, ChargeEstimator<>([top]() -> ChargeAmount {
+    if (EstimateCharge(this, ChargeEstimator<>([&top]() -> ChargeAmount {
                          return top.object->NegateChargeEstimator(top.object);
                        }),
                        std::tuple<>{}))
@@ -802,7 +819,8 @@ void VM::Handler__InitialiseArray()
   for (AnyInteger i(seq_size, TypeIds::UInt16); i.primitive.ui16 > 0;)
   {
     --i.primitive.ui16;
-    element.Construct(Pop());
+    // Move rather than copy, elides a reference count bump and leaves the stack slot empty
+    static_cast<Variant &>(element) = std::move(Pop());
     ret_val->SetIndexedValue(i, element);
   }
 
@@ -1093,5 +1111,226 @@ void VM::Handler__InvokeUserDefinedMemberFunction()
   RuntimeError("null reference");
 }
 
+/**
+ * Internal: Execute the block of primitive instructions starting at the current program counter.
+ *
+ * The static charges for the whole block are applied up front, which is only done when the block
+ * can not reach the charge limit. Should execution stop part way through the block the charges
+ * of the instructions which were not executed are refunded, so the charges (and the point at which
+ * any error occurs) are identical to executing the instructions one at a time. The handlers are
+ * called directly (and inlined where supported) rather than through the opcode table.
+ *
+ * @return true if a block was executed, false if the instruction must be executed normally
+ */
+FETCH_VM_FLATTEN bool VM::ExecuteBlock()
+{
+  if (function_ != block_function_)
+  {
+    auto it = block_charges_.find(function_);
+    if (it == block_charges_.end())
+    {
+      it = block_charges_.emplace(function_, CalculateBlockCharges(*function_)).first;
+    }
+
+    block_function_        = function_;
+    current_block_charges_ = &it->second;
+  }
+
+  BlockCharges const &charges      = *current_block_charges_;
+  ChargeAmount const  block_charge = charges[pc_].total;
+
+  if (block_charge == 0)
+  {
+    return false;
+  }
+
+  // the block may only be charged in one step if no instruction in it would reach the limit
+  ChargeAmount const available = std::numeric_limits<ChargeAmount>::max() - charge_total_;
+  if (charge_limit_ != 0u)
+  {
+    if ((charge_total_ >= charge_limit_) || (block_charge >= (charge_limit_ - charge_total_)))
+    {
+      return false;
+    }
+  }
+  else if (block_charge > available)
+  {
+    return false;
+  }
+
+  charge_total_ += block_charge;
+
+  ChargeAmount refund{0};
+  try
+  {
+    for (;;)
+    {
+      instruction_pc_ = pc_;
+      instruction_    = &function_->instructions[pc_++];
+      current_op_     = &opcode_info_array_[instruction_->opcode];
+
+      // the block ends when there are no further instructions to be charged
+      refund = charges[instruction_pc_].following;
+
+      DispatchBlockInstruction(instruction_->opcode);
+
+      if (stop_ || (refund == 0))
+      {
+        break;
+      }
+    }
+  }
+  catch (...)
+  {
+    charge_total_ -= refund;
+    throw;
+  }
+
+  charge_total_ -= (stop_ ? refund : 0u);
+
+  return true;
+}
+
+/**
+ * Internal: Execute a block instruction, calling the handler directly
+ *
+ * @param opcode The opcode of the instruction
+ */
+void VM::DispatchBlockInstruction(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::LocalVariableDeclare:
+    Handler__LocalVariableDeclare();
+    break;
+  case Opcodes::LocalVariableDeclareAssign:
+    Handler__LocalVariableDeclareAssign();
+    break;
+  case Opcodes::PushNull:
+    Handler__PushNull();
+    break;
+  case Opcodes::PushFalse:
+    Handler__PushFalse();
+    break;
+  case Opcodes::PushTrue:
+    Handler__PushTrue();
+    break;
+  case Opcodes::PushString:
+    Handler__PushString();
+    break;
+  case Opcodes::PushConstant:
+    Handler__PushConstant();
+    break;
+  case Opcodes::PushLargeConstant:
+    Handler__PushLargeConstant();
+    break;
+  case Opcodes::PushLocalVariable:
+    Handler__PushLocalVariable();
+    break;
+  case Opcodes::PopToLocalVariable:
+    Handler__PopToLocalVariable();
+    break;
+  case Opcodes::Inc:
+    Handler__Inc();
+    break;
+  case Opcodes::Dec:
+    Handler__Dec();
+    break;
+  case Opcodes::Duplicate:
+    Handler__Duplicate();
+    break;
+  case Opcodes::DuplicateInsert:
+    Handler__DuplicateInsert();
+    break;
+  case Opcodes::Discard:
+    Handler__Discard();
+    break;
+  case Opcodes::LocalVariablePrefixInc:
+    Handler__LocalVariablePrefixInc();
+    break;
+  case Opcodes::LocalVariablePrefixDec:
+    Handler__LocalVariablePrefixDec();
+    break;
+  case Opcodes::LocalVariablePostfixInc:
+    Handler__LocalVariablePostfixInc();
+    break;
+  case Opcodes::LocalVariablePostfixDec:
+    Handler__LocalVariablePostfixDec();
+    break;
+  case Opcodes::Not:
+    Handler__Not();
+    break;
+  case Opcodes::PrimitiveEqual:
+    Handler__PrimitiveEqual();
+    break;
+  case Opcodes::PrimitiveNotEqual:
+    Handler__PrimitiveNotEqual();
+    break;
+  case Opcodes::PrimitiveLessThan:
+    Handler__PrimitiveLessThan();
+    break;
+  case Opcodes::PrimitiveLessThanOrEqual:
+    Handler__PrimitiveLessThanOrEqual();
+    break;
+  case Opcodes::PrimitiveGreaterThan:
+    Handler__PrimitiveGreaterThan();
+    break;
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+    Handler__PrimitiveGreaterThanOrEqual();
+    break;
+  case Opcodes::PrimitiveNegate:
+    Handler__PrimitiveNegate();
+    break;
+  case Opcodes::PrimitiveAdd:
+    Handler__PrimitiveAdd();
+    break;
+  case Opcodes::PrimitiveSubtract:
+    Handler__PrimitiveSubtract();
+    break;
+  case Opcodes::PrimitiveMultiply:
+    Handler__PrimitiveMultiply();
+    break;
+  case Opcodes::PrimitiveDivide:
+    Handler__PrimitiveDivide();
+    break;
+  case Opcodes::PrimitiveModulo:
+    Handler__PrimitiveModulo();
+    break;
+  case Opcodes::LocalVariablePrimitiveInplaceAdd:
+    Handler__LocalVariablePrimitiveInplaceAdd();
+    break;
+  case Opcodes::LocalVariablePrimitiveInplaceSubtract:
+    Handler__LocalVariablePrimitiveInplaceSubtract();
+    break;
+  case Opcodes::LocalVariablePrimitiveInplaceMultiply:
+    Handler__LocalVariablePrimitiveInplaceMultiply();
+    break;
+  case Opcodes::LocalVariablePrimitiveInplaceDivide:
+    Handler__LocalVariablePrimitiveInplaceDivide();
+    break;
+  case Opcodes::LocalVariablePrimitiveInplaceModulo:
+    Handler__LocalVariablePrimitiveInplaceModulo();
+    break;
+  case Opcodes::Jump:
+    Handler__Jump();
+    break;
+  case Opcodes::JumpIfFalse:
+    Handler__JumpIfFalse();
+    break;
+  case Opcodes::JumpIfTrue:
+    Handler__JumpIfTrue();
+    break;
+  case Opcodes::JumpIfFalseOrPop:
+    Handler__JumpIfFalseOrPop();
+    break;
+  case Opcodes::JumpIfTrueOrPop:
+    Handler__JumpIfTrueOrPop();
+    break;
+  default:
+    RuntimeError("invalid block instruction");
+    break;
+  }
+}
+
 }  // namespace vm
 }  // namespace fetch
@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/vm.hpp"
+#include "vm/vm_pool.hpp"
+
+#include <memory>
+#include <utility>
+
+namespace fetch {
+namespace vm {
+
+constexpr std::size_t VMPool::DEFAULT_MAX_IDLE;
+
+/**
+ * Construct the VM pool
+ *
+ * @param module The module from which all of the instances are created, it must outlive the pool
+ * @param max_idle The maximum number of instances which are waiting to be reused
+ */
+VMPool::VMPool(Module *module, std::size_t max_idle)
+  : module_{module}
+  , max_idle_{max_idle}
+{}
+
+VMPool::~VMPool() = default;
+
+/**
+ * Acquire a VM instance, reusing a previously released one if one is available
+ *
+ * @return The VM instance, which is returned to the pool when it is destroyed
+ */
+VMPool::VMPtr VMPool::Acquire()
+{
+  std::unique_ptr<VM> vm{};
+
+  {
+    FETCH_LOCK(lock_);
+    if (!idle_.empty())
+    {
+      vm = std::move(idle_.back());
+      idle_.pop_back();
+    }
+  }
+
+  if (!vm)
+  {
+    vm = std::make_unique<VM>(module_);
+  }
+
+  return VMPtr{vm.release(), Releaser{this}};
+}
+
+/**
+ * Get the number of instances which are waiting to be reused
+ *
+ * @return The number of idle instances
+ */
+std::size_t VMPool::num_idle() const
+{
+  FETCH_LOCK(lock_);
+  return idle_.size();
+}
+
+void VMPool::Release(VM *vm)
+{
+  std::unique_ptr<VM> instance{vm};
+  instance->Reset();
+
+  FETCH_LOCK(lock_);
+  if (idle_.size() < max_idle_)
+  {
+    idle_.push_back(std::move(instance));
+  }
+}
+
+void VMPool::Releaser::operator()(VM *vm) const
+{
+  if (vm == nullptr)
+  {
+    return;
+  }
+
+  if (pool == nullptr)
+  {
+    delete vm;
+    return;
+  }
+
+  pool->Release(vm);
+}
+
+}  // namespace vm
+}  // namespace fetch
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/main_serializer.hpp"
+#include "vm/executable_serializers.hpp"
+#include "vm/module.hpp"
+#include "vm/vm.hpp"
+#include "vm_test_helpers.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::serializers::MsgPackSerializer;
+using fetch::vm::ChargeAmount;
+using fetch::vm::Executable;
+using fetch::vm::Module;
+using fetch::vm::Variant;
+using fetch::vm::VM;
+
+class ExecutableSerializersTests : public ::testing::Test
+{
+protected:
+  bool Compile(std::string const &text)
+  {
+    return CompileExecutable(module_, text, executable_);
+  }
+
+  int64_t Run(Executable const &executable, ChargeAmount &charge)
+  {
+    std::string error{};
+    Variant     output{};
+
+    VM vm{&module_};
+    EXPECT_TRUE(vm.Execute(executable, "main", error, output)) << error;
+    charge = vm.GetChargeTotal();
+
+    return output.Get<int64_t>();
+  }
+
+  Module     module_{};
+  Executable executable_{};
+};
+
+static char const *TEXT = R"(
+  function increment(count : Int32, amount : Int32) : Int32
+    return count + amount;
+  endfunction
+
+  function scale(value : Fixed128) : Fixed128
+    return value * 2.5fp128;
+  endfunction
+
+  function main() : Int64
+    var count = 7;
+    for (i in 0:10)
+      count = increment(count, i);
+    endfor
+
+    var values = Array<Fixed64>(2);
+    values[0] = 1.25fp64;
+    values[1] = -3.5fp64;
+
+    var total = toInt64(count) + 42i64;
+    if (scale(1.5fp128) > 3.0fp128)
+      total += 100i64;
+    endif
+    if ((values[0] + values[1]) < 0fp64)
+      total += 1000i64;
+    endif
+    if (("count" + " " + "total") == "count total")
+      total += 10000i64;
+    endif
+    return total;
+  endfunction
+)";
+
+TEST_F(ExecutableSerializersTests, CheckRoundTripExecutesIdentically)
+{
+  ASSERT_TRUE(Compile(TEXT));
+
+  MsgPackSerializer serializer{};
+  serializer << executable_;
+
+  MsgPackSerializer deserializer{serializer.data()};
+  Executable        restored{};
+  deserializer >> restored;
+
+  EXPECT_EQ(restored.name, executable_.name);
+  EXPECT_EQ(restored.strings, executable_.strings);
+  EXPECT_EQ(restored.constants.size(), executable_.constants.size());
+  EXPECT_EQ(restored.large_constants.size(), executable_.large_constants.size());
+  EXPECT_EQ(restored.types.size(), executable_.types.size());
+  ASSERT_EQ(restored.functions.size(), executable_.functions.size());
+
+  for (std::size_t i = 0; i < restored.functions.size(); ++i)
+  {
+    auto const &expected = executable_.functions[i];
+    auto const &actual   = restored.functions[i];
+
+    EXPECT_EQ(actual.name, expected.name);
+    EXPECT_EQ(actual.num_parameters, expected.num_parameters);
+    EXPECT_EQ(actual.num_variables, expected.num_variables);
+    EXPECT_EQ(actual.pc_to_line_map, expected.pc_to_line_map);
+    ASSERT_EQ(actual.instructions.size(), expected.instructions.size());
+
+    for (std::size_t pc = 0; pc < actual.instructions.size(); ++pc)
+    {
+      EXPECT_EQ(actual.instructions[pc].opcode, expected.instructions[pc].opcode);
+      EXPECT_EQ(actual.instructions[pc].type_id, expected.instructions[pc].type_id);
+      EXPECT_EQ(actual.instructions[pc].index, expected.instructions[pc].index);
+      EXPECT_EQ(actual.instructions[pc].data, expected.instructions[pc].data);
+    }
+  }
+
+  ChargeAmount expected_charge{0};
+  ChargeAmount actual_charge{0};
+  int64_t const expected = Run(executable_, expected_charge);
+  int64_t const actual   = Run(restored, actual_charge);
+
+  EXPECT_EQ(expected, 11194);
+  EXPECT_EQ(actual, expected);
+  EXPECT_EQ(actual_charge, expected_charge);
+}
+
+TEST_F(ExecutableSerializersTests, CheckLayoutSignature)
+{
+  ASSERT_TRUE(Compile(TEXT));
+
+  VM first{&module_};
+  VM second{&module_};
+  EXPECT_FALSE(first.LayoutSignature().empty());
+  EXPECT_EQ(first.LayoutSignature(), second.LayoutSignature());
+
+  Module other{};
+  other.CreateFreeFunction("extra", [](VM *) -> int32_t { return 1; });
+
+  VM third{&other};
+  EXPECT_NE(first.LayoutSignature(), third.LayoutSignature());
+}
+
+}  // namespace
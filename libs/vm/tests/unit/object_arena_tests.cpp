@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/object.hpp"
+#include "vm/object_arena.hpp"
+#include "vm/string.hpp"
+#include "vm/vm.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::vm::Compiler;
+using fetch::vm::Executable;
+using fetch::vm::IR;
+using fetch::vm::Module;
+using fetch::vm::Object;
+using fetch::vm::ObjectArena;
+using fetch::vm::Ptr;
+using fetch::vm::SourceFiles;
+using fetch::vm::String;
+using fetch::vm::TypeId;
+using fetch::vm::Variant;
+using fetch::vm::VM;
+
+class LargeObject : public Object
+{
+public:
+  LargeObject(VM *vm, TypeId type_id)
+    : Object(vm, type_id)
+  {}
+
+  uint8_t data[ObjectArena::MAX_OBJECT_SIZE * 2]{};
+};
+
+Ptr<String> CreateString(std::string const &value)
+{
+  return Ptr<String>{new String{nullptr, value}};
+}
+
+TEST(ObjectArenaTests, CheckObjectsAreAllocatedFromTheActiveArena)
+{
+  auto arena = ObjectArena::Create();
+
+  auto const outside = CreateString("outside");
+  EXPECT_EQ(arena->num_live_objects(), 0);
+
+  {
+    ObjectArena::Scope const scope{*arena};
+
+    auto const inside = CreateString("inside");
+    EXPECT_EQ(arena->num_live_objects(), 1);
+
+    // large objects always come from the heap
+    Ptr<LargeObject> const large{new LargeObject{nullptr, fetch::vm::TypeIds::Unknown}};
+    EXPECT_EQ(arena->num_live_objects(), 1);
+  }
+
+  EXPECT_EQ(arena->num_live_objects(), 0);
+  EXPECT_TRUE(arena->Rewind());
+  EXPECT_EQ(outside->string(), "outside");
+}
+
+TEST(ObjectArenaTests, CheckReleasedMemoryIsReused)
+{
+  auto arena = ObjectArena::Create();
+
+  ObjectArena::Scope const scope{*arena};
+  for (std::size_t i = 0; i < 10000; ++i)
+  {
+    std::vector<Ptr<String>> strings{CreateString("a"), CreateString("b"), CreateString("c")};
+  }
+
+  EXPECT_EQ(arena->num_chunks(), 1);
+  EXPECT_EQ(arena->num_live_objects(), 0);
+}
+
+TEST(ObjectArenaTests, CheckSurvivingObjectsKeepTheArenaAlive)
+{
+  auto arena = ObjectArena::Create();
+
+  Ptr<String> survivor{};
+  {
+    ObjectArena::Scope const scope{*arena};
+    survivor = CreateString("survivor");
+  }
+
+  EXPECT_FALSE(arena->Rewind());
+
+  // the arena is freed along with the last of its objects
+  arena.reset();
+  EXPECT_EQ(survivor->string(), "survivor");
+  survivor = Ptr<String>{};
+}
+
+TEST(ObjectArenaTests, CheckResultsOutliveSubsequentInvocations)
+{
+  static char const *TEXT = R"(
+    function main() : String
+      var parts = Array<String>(3);
+      parts[0] = "a";
+      parts[1] = "b";
+      parts[2] = "c";
+      return parts[0] + parts[1] + parts[2];
+    endfunction
+  )";
+
+  Module                   module{};
+  Compiler                 compiler{&module};
+  IR                       ir{};
+  Executable               executable{};
+  std::vector<std::string> errors{};
+  SourceFiles const        files = {{"default.etch", TEXT}};
+
+  VM vm{&module};
+  ASSERT_TRUE(compiler.Compile(files, "default_ir", ir, errors));
+  ASSERT_TRUE(vm.GenerateExecutable(ir, "default_exe", executable, errors));
+
+  std::string error{};
+  Variant     first{};
+  Variant     second{};
+  ASSERT_TRUE(vm.Execute(executable, "main", error, first));
+  ASSERT_TRUE(vm.Execute(executable, "main", error, second));
+
+  EXPECT_EQ(first.Get<Ptr<String>>()->string(), "abc");
+  EXPECT_EQ(second.Get<Ptr<String>>()->string(), "abc");
+}
+
+}  // namespace
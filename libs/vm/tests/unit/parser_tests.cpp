@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/node.hpp"
+#include "vm/parser.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::vm::BlockNodePtr;
+using fetch::vm::Compiler;
+using fetch::vm::ConvertToBlockNodePtr;
+using fetch::vm::IR;
+using fetch::vm::Module;
+using fetch::vm::NodeKind;
+using fetch::vm::Parser;
+using fetch::vm::SourceFiles;
+
+SourceFiles GenerateFiles(std::size_t count)
+{
+  SourceFiles files{};
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    std::string const index = std::to_string(i);
+    files.emplace_back("file" + index + ".etch", "function f" + index + "() : Int32\n  return " +
+                                                     index + ";\nendfunction\n");
+  }
+
+  files.emplace_back("main.etch", "function main() : Int32\n  return f0() + f1();\nendfunction\n");
+
+  return files;
+}
+
+TEST(ParserTests, CheckFilesAreParsedInOrder)
+{
+  SourceFiles const files = GenerateFiles(16);
+
+  Parser                   parser{};
+  std::vector<std::string> errors{};
+  BlockNodePtr const       root = parser.Parse(files, errors);
+
+  ASSERT_TRUE(root);
+  EXPECT_TRUE(errors.empty());
+  ASSERT_EQ(root->block_children.size(), files.size());
+
+  for (std::size_t i = 0; i < files.size(); ++i)
+  {
+    BlockNodePtr const file_node = ConvertToBlockNodePtr(root->block_children[i]);
+    ASSERT_TRUE(file_node);
+    EXPECT_EQ(file_node->node_kind, NodeKind::File);
+    EXPECT_EQ(file_node->text, files[i].filename);
+    EXPECT_EQ(file_node->block_children.size(), 1);
+  }
+
+  // the result can be compiled as normal
+  Module   module{};
+  Compiler compiler{&module};
+  IR       ir{};
+  EXPECT_TRUE(compiler.Compile(files, "default_ir", ir, errors));
+}
+
+TEST(ParserTests, CheckErrorsAreReportedInFileOrder)
+{
+  SourceFiles files = GenerateFiles(8);
+  files[2].source   = "function broken(\n";
+  files[5].source   = "endfunction\n";
+
+  Parser                   parser{};
+  std::vector<std::string> errors{};
+  EXPECT_FALSE(parser.Parse(files, errors));
+
+  ASSERT_GE(errors.size(), 2);
+  EXPECT_EQ(errors.front().find("file2.etch: "), 0);
+  EXPECT_EQ(errors.back().find("file5.etch: "), 0);
+  EXPECT_TRUE(std::is_partitioned(errors.begin(), errors.end(), [](std::string const &error) {
+    return error.find("file2.etch: ") == 0;
+  }));
+
+  // the files following an oversized file are not parsed
+  files[3].source = std::string(256 * 1024, ' ');
+  EXPECT_FALSE(parser.Parse(files, errors));
+
+  ASSERT_GE(errors.size(), 2);
+  EXPECT_EQ(errors.front().find("file2.etch: "), 0);
+  EXPECT_EQ(errors.back(), "file3.etch: source exceeds maximum size");
+}
+
+}  // namespace
@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/module.hpp"
+#include "vm/profiler.hpp"
+#include "vm/vm.hpp"
+#include "vm_test_helpers.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::vm::ChargeAmount;
+using fetch::vm::Executable;
+using fetch::vm::Module;
+using fetch::vm::Profiler;
+using fetch::vm::Variant;
+using fetch::vm::VM;
+
+using ::testing::HasSubstr;
+
+class ProfilerTests : public ::testing::Test
+{
+protected:
+  bool Compile(std::string const &text)
+  {
+    vm_ = std::make_unique<VM>(&module_);
+    return CompileExecutable(module_, text, executable_);
+  }
+
+  bool Run(std::string const &name)
+  {
+    std::string error{};
+    Variant     output{};
+    return vm_->Execute(executable_, name, error, output);
+  }
+
+  Module              module_{};
+  std::unique_ptr<VM> vm_{};
+  Executable          executable_{};
+};
+
+static char const *TEXT = R"(
+  function square(x : Int32) : Int32
+    return x * x;
+  endfunction
+
+  function main()
+    var total = 0;
+    for (i in 0:100)
+      total += square(i);
+    endfor
+  endfunction
+)";
+
+TEST_F(ProfilerTests, CheckInstructionsAndChargesAreRecorded)
+{
+  ASSERT_TRUE(Compile(TEXT));
+
+  // the profile must account for exactly the charge of the execution
+  Profiler profiler{1};
+  vm_->SetProfiler(&profiler);
+  ASSERT_TRUE(Run("main"));
+  vm_->SetProfiler(nullptr);
+
+  ChargeAmount const charge_total = vm_->GetChargeTotal();
+
+  uint64_t     opcode_count{0};
+  ChargeAmount opcode_charge{0};
+  for (auto const &opcode : profiler.opcodes())
+  {
+    opcode_count += opcode.second.count;
+    opcode_charge += opcode.second.charge;
+  }
+
+  uint64_t     function_count{0};
+  ChargeAmount function_charge{0};
+  for (auto const &function : profiler.functions())
+  {
+    function_count += function.second.count;
+    function_charge += function.second.charge;
+  }
+
+  EXPECT_EQ(opcode_charge, charge_total);
+  EXPECT_EQ(function_charge, charge_total);
+  EXPECT_EQ(function_count, opcode_count);
+  ASSERT_EQ(profiler.functions().size(), 2);
+  EXPECT_EQ(profiler.functions().at("square").count, 100u * 4u);
+
+  // every instruction has been sampled
+  uint64_t sample_count{0};
+  for (auto const &sample : profiler.samples())
+  {
+    sample_count += sample.second;
+  }
+  EXPECT_EQ(sample_count, opcode_count);
+  EXPECT_EQ(profiler.samples().at("main;square"), profiler.functions().at("square").count);
+
+  // the profile does not change the charge of the execution
+  vm_->Reset();
+  ASSERT_TRUE(Run("main"));
+  EXPECT_EQ(vm_->GetChargeTotal(), charge_total);
+}
+
+TEST_F(ProfilerTests, CheckFoldedStacks)
+{
+  ASSERT_TRUE(Compile(TEXT));
+
+  Profiler profiler{};
+  vm_->SetProfiler(&profiler);
+  ASSERT_TRUE(Run("main"));
+  ASSERT_TRUE(Run("main"));
+
+  Profiler merged{};
+  merged.Merge(profiler);
+  merged.Merge(profiler);
+  EXPECT_EQ(merged.functions().at("main").count, 2 * profiler.functions().at("main").count);
+
+  std::stringstream stream{};
+  profiler.WriteFoldedStacks(stream, "contract");
+
+  std::string line{};
+  std::size_t num_lines{0};
+  while (std::getline(stream, line))
+  {
+    EXPECT_THAT(line, HasSubstr("contract;main"));
+    ++num_lines;
+  }
+  EXPECT_EQ(num_lines, profiler.samples().size());
+
+  profiler.Clear();
+  EXPECT_TRUE(profiler.opcodes().empty());
+  EXPECT_TRUE(profiler.samples().empty());
+}
+
+TEST_F(ProfilerTests, CheckStaticChargeEstimates)
+{
+  ASSERT_TRUE(Compile(TEXT));
+
+  Profiler profiler{};
+  vm_->SetProfiler(&profiler);
+  ASSERT_TRUE(Run("main"));
+
+  auto const charges = profiler.EstimateStaticCharges();
+  EXPECT_EQ(charges.size(), profiler.opcodes().size());
+
+  for (auto const &charge : charges)
+  {
+    EXPECT_GE(charge.second, 1u);
+  }
+
+  // the estimates can be applied directly to the VM
+  vm_->UpdateCharges(charges);
+}
+
+}  // namespace
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/module.hpp"
+#include "vm/vm.hpp"
+#include "vm_test_helpers.hpp"
+
+#include "gmock/gmock.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::vm::Executable;
+using fetch::vm::Module;
+using fetch::vm::StateKeys;
+using fetch::vm::VM;
+
+using ::testing::UnorderedElementsAre;
+
+class StateKeysTests : public ::testing::Test
+{
+protected:
+  bool Compile(std::string const &text)
+  {
+    return CompileExecutable(module_, text, executable_);
+  }
+
+  Executable::Function const &Function(std::string const &name) const
+  {
+    auto const *function = executable_.FindFunction(name);
+    EXPECT_NE(function, nullptr);
+    return *function;
+  }
+
+  Module     module_{};
+  Executable executable_{};
+};
+
+TEST_F(StateKeysTests, CheckUseStatementKeys)
+{
+  static char const *TEXT = R"(
+    persistent supply : UInt64;
+    persistent sharded balances : UInt64;
+
+    function transfer()
+      use supply;
+      use balances["alice", "bob"];
+      supply.set(supply.get(0u64) + 1u64);
+      balances.set("alice", balances.get("bob", 0u64));
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(TEXT));
+
+  auto const &function = Function("transfer");
+  EXPECT_THAT(function.state_keys,
+              UnorderedElementsAre("supply", "balances.alice", "balances.bob"));
+  EXPECT_TRUE(function.state_keys_complete);
+}
+
+TEST_F(StateKeysTests, CheckRuntimeKeysAreIncomplete)
+{
+  static char const *TEXT = R"(
+    persistent supply : UInt64;
+    persistent sharded balances : UInt64;
+
+    function deposit(owner : String)
+      use supply;
+      use balances[owner];
+      balances.set(owner, supply.get(0u64));
+    endfunction
+
+    function mint()
+      use any;
+      balances.set("carol", supply.get(0u64));
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(TEXT));
+
+  auto const &deposit = Function("deposit");
+  EXPECT_THAT(deposit.state_keys, UnorderedElementsAre("supply"));
+  EXPECT_FALSE(deposit.state_keys_complete);
+
+  auto const &mint = Function("mint");
+  EXPECT_THAT(mint.state_keys, UnorderedElementsAre("supply"));
+  EXPECT_FALSE(mint.state_keys_complete);
+}
+
+TEST_F(StateKeysTests, CheckKeysArePropagatedToCallers)
+{
+  static char const *TEXT = R"(
+    persistent supply : UInt64;
+    persistent owner : String;
+
+    function get_supply() : UInt64
+      use supply;
+      return supply.get(0u64);
+    endfunction
+
+    function get_owner() : String
+      use owner;
+      return owner.get("");
+    endfunction
+
+    function describe() : UInt64
+      get_owner();
+      return get_supply();
+    endfunction
+
+    function main() : UInt64
+      return describe();
+    endfunction
+
+    function pure() : Int32
+      return 42;
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(TEXT));
+
+  EXPECT_THAT(Function("main").state_keys, UnorderedElementsAre("supply", "owner"));
+  EXPECT_TRUE(Function("main").state_keys_complete);
+  EXPECT_TRUE(Function("pure").state_keys.empty());
+  EXPECT_TRUE(Function("pure").state_keys_complete);
+}
+
+}  // namespace
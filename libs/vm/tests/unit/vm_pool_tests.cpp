@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/module.hpp"
+#include "vm/variant.hpp"
+#include "vm/vm.hpp"
+#include "vm/vm_pool.hpp"
+#include "vm_test_helpers.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::vm::ChargeAmount;
+using fetch::vm::Executable;
+using fetch::vm::Module;
+using fetch::vm::Variant;
+using fetch::vm::VM;
+using fetch::vm::VMPool;
+
+class VmPoolTests : public ::testing::Test
+{
+protected:
+  static constexpr std::size_t MAX_IDLE = 2;
+
+  void SetUp() override
+  {
+    static char const *TEXT = R"(
+      function main() : Int32
+        var total = 0;
+        for (i in 0:10)
+          total += i;
+        endfor
+        return total;
+      endfunction
+    )";
+
+    ASSERT_TRUE(CompileExecutable(module_, TEXT, executable_));
+  }
+
+  static bool Run(VM &vm, Executable const &executable, Variant &output)
+  {
+    std::string error{};
+    return vm.Execute(executable, "main", error, output);
+  }
+
+  Module     module_{};
+  Executable executable_{};
+  VMPool     pool_{&module_, MAX_IDLE};
+};
+
+constexpr std::size_t VmPoolTests::MAX_IDLE;
+
+TEST_F(VmPoolTests, CheckInstancesAreReused)
+{
+  EXPECT_EQ(pool_.num_idle(), 0);
+
+  VM const *first{nullptr};
+  {
+    auto vm = pool_.Acquire();
+    first   = vm.get();
+  }
+  EXPECT_EQ(pool_.num_idle(), 1);
+
+  auto vm = pool_.Acquire();
+  EXPECT_EQ(vm.get(), first);
+  EXPECT_EQ(pool_.num_idle(), 0);
+}
+
+TEST_F(VmPoolTests, CheckIdleInstancesAreBounded)
+{
+  {
+    auto vm1 = pool_.Acquire();
+    auto vm2 = pool_.Acquire();
+    auto vm3 = pool_.Acquire();
+  }
+
+  EXPECT_EQ(pool_.num_idle(), MAX_IDLE);
+}
+
+TEST_F(VmPoolTests, CheckReusedInstancesBehaveLikeNewOnes)
+{
+  VM      reference{&module_};
+  Variant expected{};
+  ASSERT_TRUE(Run(reference, executable_, expected));
+
+  std::ostringstream console{};
+  {
+    auto vm = pool_.Acquire();
+    vm->SetChargeLimit(1);
+    vm->AttachOutputDevice(VM::STDOUT, console);
+
+    Variant output{};
+    EXPECT_FALSE(Run(*vm, executable_, output));
+  }
+
+  auto vm = pool_.Acquire();
+
+  // the charges, limit and devices of the previous invocation have been reset
+  EXPECT_EQ(vm->GetChargeTotal(), 0);
+  EXPECT_EQ(vm->GetChargeLimit(), reference.GetChargeLimit());
+  EXPECT_NO_THROW(vm->AttachOutputDevice(VM::STDOUT, console));
+
+  Variant output{};
+  ASSERT_TRUE(Run(*vm, executable_, output));
+  EXPECT_EQ(output.Get<int32_t>(), expected.Get<int32_t>());
+  EXPECT_EQ(vm->GetChargeTotal(), reference.GetChargeTotal());
+}
+
+}  // namespace
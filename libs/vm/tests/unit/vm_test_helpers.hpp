@@ -0,0 +1,56 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/vm.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Compile the source of a single file contract into an executable, printing any errors in the
+ * same format as the VmTestToolkit
+ *
+ * @param module The module to compile against
+ * @param text The source of the contract
+ * @param executable The executable to be generated
+ * @return true if successful, otherwise false
+ */
+inline bool CompileExecutable(fetch::vm::Module &module, std::string const &text,
+                              fetch::vm::Executable &executable)
+{
+  fetch::vm::Compiler          compiler{&module};
+  fetch::vm::IR                ir{};
+  std::vector<std::string>     errors{};
+  fetch::vm::SourceFiles const files = {{"default.etch", text}};
+  fetch::vm::VM                vm{&module};
+
+  bool const success = compiler.Compile(files, "default_ir", ir, errors) &&
+                       vm.GenerateExecutable(ir, "default_exe", executable, errors);
+
+  for (auto const &line : errors)
+  {
+    std::cout << "Compiler Error: " << line << std::endl;
+  }
+
+  return success;
+}